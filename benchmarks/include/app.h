@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#include <functional>
+#include <memory>
+
+
+class App
+{
+public:
+    /* Public functions */
+     App();
+    ~App();
+
+    void init();
+    void run ();
+
+private:
+    /* Private functions */
+    App           (const App&);
+    App& operator=(const App&);
+
+    void deinit           ();
+    void init_buffers     ();
+    void init_dsgs        ();
+    void init_framebuffer ();
+    void init_gfx_pipeline();
+    void init_shaders     ();
+    void init_window      ();
+    void init_vulkan      ();
+
+    Anvil::GraphicsPipelineCreateInfoUniquePtr create_gfx_pipeline_create_info() const;
+
+    void benchmark_command_recording        ();
+    void benchmark_compute_primitives       ();
+    void benchmark_draw_allocations         ();
+    void benchmark_descriptor_set_updates   ();
+    void benchmark_graphics_pipeline_baking ();
+    void benchmark_memory_allocator_baking  ();
+    void benchmark_msaa_resolves            ();
+    void benchmark_queue_submissions        ();
+    void benchmark_shader_module_cache      ();
+    void run_benchmarks                     ();
+
+    void measure      (const char*                  in_name,
+                       uint32_t                     in_n_iterations,
+                       uint32_t                     in_n_ops_per_iteration,
+                       const std::function<void()>& in_func);
+    void print_results(const char*                  in_name,
+                       uint64_t                     in_n_total_nsec,
+                       uint64_t                     in_n_ops);
+
+    void print_host_memory_usage() const;
+
+    void on_validation_callback(Anvil::DebugMessageSeverityFlags in_severity,
+                                const char*                      in_message_ptr);
+
+
+    /* Private variables */
+    Anvil::TrackingHostAllocatorUniquePtr m_host_allocator_ptr;
+
+    Anvil::BaseDeviceUniquePtr   m_device_ptr;
+    Anvil::InstanceUniquePtr     m_instance_ptr;
+    const Anvil::PhysicalDevice* m_physical_device_ptr;
+    Anvil::Time                  m_time;
+    Anvil::WindowUniquePtr       m_window_ptr;
+
+    Anvil::ImageUniquePtr                               m_color_image_ptr;
+    Anvil::ImageViewUniquePtr                           m_color_image_view_ptr;
+    Anvil::BufferUniquePtr                              m_dst_buffer_ptr;
+    Anvil::DescriptorSetGroupUniquePtr                  m_dsg_ptr;
+    Anvil::FramebufferUniquePtr                         m_framebuffer_ptr;
+    std::unique_ptr<Anvil::ShaderModuleStageEntryPoint> m_fs_ptr;
+    Anvil::PipelineID                                   m_pipeline_id;
+    Anvil::RenderPassUniquePtr                          m_renderpass_ptr;
+    Anvil::SubPassID                                    m_subpass_id;
+    Anvil::BufferUniquePtr                              m_ub_buffer_ptrs[2];
+    std::unique_ptr<Anvil::ShaderModuleStageEntryPoint> m_vs_ptr;
+};
@@ -0,0 +1,1401 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/* Micro-benchmarks for Anvil's hot paths.
+ *
+ * The app runs fully off-screen. A dummy window drives a single "frame", during which all benchmarks
+ * are executed and their results printed to stdout. Run the app on the same machine before and after
+ * a change to catch regressions.
+ */
+
+/* Uncomment the #define below to enable validation */
+// #define ENABLE_VALIDATION
+
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include "config.h"
+#include "misc/buffer_create_info.h"
+#include "misc/compute_primitives.h"
+#include "misc/descriptor_set_create_info.h"
+#include "misc/fence_create_info.h"
+#include "misc/framebuffer_create_info.h"
+#include "misc/glsl_to_spirv.h"
+#include "misc/graphics_pipeline_create_info.h"
+#include "misc/host_allocator.h"
+#include "misc/image_create_info.h"
+#include "misc/image_view_create_info.h"
+#include "misc/instance_create_info.h"
+#include "misc/memory_allocator.h"
+#include "misc/object_tracker.h"
+#include "misc/render_pass_create_info.h"
+#include "misc/shader_module_cache.h"
+#include "misc/time.h"
+#include "misc/window_factory.h"
+#include "wrappers/buffer.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/command_pool.h"
+#include "wrappers/compute_pipeline_manager.h"
+#include "wrappers/descriptor_set.h"
+#include "wrappers/descriptor_set_group.h"
+#include "wrappers/device.h"
+#include "wrappers/fence.h"
+#include "wrappers/framebuffer.h"
+#include "wrappers/graphics_pipeline_manager.h"
+#include "wrappers/image.h"
+#include "wrappers/image_view.h"
+#include "wrappers/instance.h"
+#include "wrappers/physical_device.h"
+#include "wrappers/queue.h"
+#include "wrappers/render_pass.h"
+#include "wrappers/shader_module.h"
+#include "app.h"
+
+
+/* Low-level #defines follow.. */
+#define APP_NAME                        "Anvil micro-benchmarks"
+#define N_BUFFERS_PER_ALLOCATOR_BAKE    (256)
+#define N_COMMANDS_PER_COMMAND_BUFFER   (1024)
+#define N_DRAWS_PER_COMMAND_BUFFER      (256)
+#define N_ITERATIONS_COMMAND_RECORDING  (256)
+#define N_ITERATIONS_DRAW_ALLOCATIONS   (4)
+#define N_ITERATIONS_DS_UPDATE          (16384)
+#define N_ITERATIONS_MEMORY_ALLOCATOR   (64)
+#define N_ITERATIONS_MSAA_RESOLVE       (64)
+#define N_ITERATIONS_PIPELINE_BAKE      (64)
+#define N_ITERATIONS_QUEUE_SUBMIT       (1024)
+#define N_ITERATIONS_SHADER_MODULE_LOOKUP (65536)
+#define N_ITERATIONS_SORT               (8)
+#define N_KEYS_SORT                     (1 << 20)
+#define RT_HEIGHT                       (720)
+#define RT_WIDTH                        (1280)
+
+
+/* Number of heap allocations made by the process so far. Used to verify that hot paths do not touch the heap. */
+static std::atomic<uint64_t> g_n_heap_allocations(0);
+
+void* operator new(size_t in_size)
+{
+    void* result_ptr = malloc((in_size > 0) ? in_size : 1);
+
+    ++g_n_heap_allocations;
+
+    if (result_ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return result_ptr;
+}
+
+void operator delete(void* in_ptr) noexcept
+{
+    free(in_ptr);
+}
+
+
+static const char* g_glsl_frag =
+    "#version 430\n"
+    "\n"
+    "layout(location = 0) out vec4 result;\n"
+    "\n"
+    "layout(set = 0, binding = 0) uniform dataUB\n"
+    "{\n"
+    "    vec4 color;\n"
+    "};\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "    result = color;\n"
+    "}\n";
+
+static const char* g_glsl_vert =
+    "#version 430\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = vec4(float(gl_VertexIndex & 1), float(gl_VertexIndex >> 1), 0.0, 1.0);\n"
+    "}\n";
+
+
+App::App()
+    :m_physical_device_ptr(nullptr),
+     m_pipeline_id        (UINT32_MAX),
+     m_subpass_id         (UINT32_MAX)
+{
+    /* Stub */
+}
+
+App::~App()
+{
+    deinit();
+}
+
+void App::benchmark_command_recording()
+{
+    auto       cmd_buffer_ptr = m_device_ptr->get_command_pool_for_queue_family_index(m_device_ptr->get_universal_queue(0)->get_queue_family_index() )->alloc_primary_level_command_buffer();
+    VkRect2D   scissor;
+    VkViewport viewport;
+
+    scissor.extent.height = RT_HEIGHT;
+    scissor.extent.width  = RT_WIDTH;
+    scissor.offset.x      = 0;
+    scissor.offset.y      = 0;
+
+    viewport.height   = static_cast<float>(RT_HEIGHT);
+    viewport.maxDepth = 1.0f;
+    viewport.minDepth = 0.0f;
+    viewport.width    = static_cast<float>(RT_WIDTH);
+    viewport.x        = 0.0f;
+    viewport.y        = 0.0f;
+
+    auto record_func = [&]()
+    {
+        cmd_buffer_ptr->reset(false); /* in_should_release_resources */
+
+        cmd_buffer_ptr->start_recording(true,   /* in_one_time_submit          */
+                                        false); /* in_simultaneous_use_allowed */
+        {
+            for (uint32_t n_command = 0;
+                          n_command < N_COMMANDS_PER_COMMAND_BUFFER / 4;
+                        ++n_command)
+            {
+                cmd_buffer_ptr->record_set_viewport  (0, /* in_first_viewport */
+                                                      1, /* in_viewport_count */
+                                                     &viewport);
+                cmd_buffer_ptr->record_set_scissor   (0, /* in_first_scissor */
+                                                      1, /* in_scissor_count */
+                                                     &scissor);
+                cmd_buffer_ptr->record_set_line_width(1.0f);
+                cmd_buffer_ptr->record_fill_buffer   (m_dst_buffer_ptr.get(),
+                                                      0,              /* in_dst_offset */
+                                                      sizeof(uint32_t),
+                                                      n_command);     /* in_data       */
+            }
+        }
+        cmd_buffer_ptr->stop_recording();
+    };
+
+    /* Stashing can only be disabled once, so the stashed variant must run first. */
+    #ifdef STORE_COMMAND_BUFFER_COMMANDS
+    {
+        measure("Command recording, stashing on  [per record_*() call]",
+                N_ITERATIONS_COMMAND_RECORDING,
+                N_COMMANDS_PER_COMMAND_BUFFER,
+                record_func);
+
+        Anvil::CommandBufferBase::disable_comand_stashing();
+    }
+    #endif
+
+    measure("Command recording, stashing off [per record_*() call]",
+            N_ITERATIONS_COMMAND_RECORDING,
+            N_COMMANDS_PER_COMMAND_BUFFER,
+            record_func);
+}
+
+void App::benchmark_compute_primitives()
+{
+    auto                   allocator_ptr      = Anvil::MemoryAllocator::create_oneshot(m_device_ptr.get() );
+    auto                   cmd_buffer_ptr     = m_device_ptr->get_command_pool_for_queue_family_index(m_device_ptr->get_universal_queue(0)->get_queue_family_index() )->alloc_primary_level_command_buffer();
+    const char*            device_name        = m_physical_device_ptr->get_device_properties().core_vk1_0_properties_ptr->device_name;
+    auto                   fence_ptr          = Anvil::Fence::create(Anvil::FenceCreateInfo::create(m_device_ptr.get(),
+                                                                                                    false) ); /* in_create_signalled */
+    Anvil::Fence*          fence_raw_ptr      = fence_ptr.get();
+    Anvil::BufferUniquePtr key_buffer_ptr;
+    auto                   primitives_ptr     = Anvil::ComputePrimitives::create(m_device_ptr.get() );
+    Anvil::Queue*          queue_ptr          = m_device_ptr->get_universal_queue(0);
+    Anvil::BufferUniquePtr scratch_buffer_ptr;
+    Anvil::BufferUniquePtr value_buffer_ptr;
+
+    if (primitives_ptr == nullptr)
+    {
+        printf("ComputePrimitives: skipped, the primitives could not be created\n");
+
+        return;
+    }
+
+    {
+        const VkDeviceSize scratch_size = std::max(primitives_ptr->get_sort_scratch_buffer_size(Anvil::ComputePrimitives::KeyType::UINT64,
+                                                                                                N_KEYS_SORT,
+                                                                                                true), /* in_has_values */
+                                                   primitives_ptr->get_scan_scratch_buffer_size(N_KEYS_SORT) );
+        const struct
+        {
+            Anvil::BufferUniquePtr* buffer_ptr_ptr;
+            VkDeviceSize            size;
+        } buffers[] =
+        {
+            {&key_buffer_ptr,     sizeof(uint64_t) * N_KEYS_SORT},
+            {&scratch_buffer_ptr, scratch_size},
+            {&value_buffer_ptr,   sizeof(uint32_t) * N_KEYS_SORT},
+        };
+
+        for (const auto& current_buffer : buffers)
+        {
+            auto create_info_ptr = Anvil::BufferCreateInfo::create_no_alloc(m_device_ptr.get(),
+                                                                            current_buffer.size,
+                                                                            Anvil::QueueFamilyFlagBits::COMPUTE_BIT,
+                                                                            Anvil::SharingMode::EXCLUSIVE,
+                                                                            Anvil::BufferCreateFlagBits::NONE,
+                                                                            Anvil::BufferUsageFlagBits::STORAGE_BUFFER_BIT | Anvil::BufferUsageFlagBits::TRANSFER_DST_BIT);
+
+            *current_buffer.buffer_ptr_ptr = Anvil::Buffer::create(std::move(create_info_ptr) );
+
+            allocator_ptr->add_buffer(current_buffer.buffer_ptr_ptr->get(),
+                                      Anvil::MemoryFeatureFlagBits::DEVICE_LOCAL_BIT); /* in_required_memory_features */
+        }
+
+        allocator_ptr->bake();
+    }
+
+    /* Pseudo-random keys. LSD radix sort performs the same amount of work regardless of the key order, so
+     * re-sorting the already sorted keys in subsequent iterations does not skew the results. */
+    {
+        std::vector<uint32_t> data(N_KEYS_SORT * 2);
+        uint32_t              seed = 0x12345678;
+
+        for (auto& current_item : data)
+        {
+            seed         = seed * 1664525 + 1013904223;
+            current_item = seed;
+        }
+
+        key_buffer_ptr->write  (0, /* in_start_offset */
+                                sizeof(uint64_t) * N_KEYS_SORT,
+                                data.data() );
+        value_buffer_ptr->write(0, /* in_start_offset */
+                                sizeof(uint32_t) * N_KEYS_SORT,
+                                data.data() );
+    }
+
+    for (uint32_t n_variant = 0;
+                  n_variant < 3;
+                ++n_variant)
+    {
+        const bool is_64bit = (n_variant == 1);
+        const bool is_scan  = (n_variant == 2);
+        char       name[128];
+        uint64_t   n_nsec   = 0;
+
+        cmd_buffer_ptr->start_recording(true,   /* in_one_time_submit          */
+                                        false); /* in_simultaneous_use_allowed */
+        {
+            for (uint32_t n_iteration = 0;
+                          n_iteration < N_ITERATIONS_SORT;
+                        ++n_iteration)
+            {
+                if (is_scan)
+                {
+                    Anvil::ComputePrimitives::ScanInfo scan_info;
+
+                    scan_info.input_buffer_ptr   = value_buffer_ptr.get();
+                    scan_info.n_elements         = N_KEYS_SORT;
+                    scan_info.output_buffer_ptr  = key_buffer_ptr.get();
+                    scan_info.scratch_buffer_ptr = scratch_buffer_ptr.get();
+
+                    primitives_ptr->record_scan(cmd_buffer_ptr.get(),
+                                                scan_info);
+                }
+                else
+                {
+                    Anvil::ComputePrimitives::SortInfo sort_info;
+
+                    sort_info.key_buffer_ptr     = key_buffer_ptr.get();
+                    sort_info.key_type           = (is_64bit) ? Anvil::ComputePrimitives::KeyType::UINT64
+                                                              : Anvil::ComputePrimitives::KeyType::UINT32;
+                    sort_info.n_elements         = N_KEYS_SORT;
+                    sort_info.scratch_buffer_ptr = scratch_buffer_ptr.get();
+                    sort_info.value_buffer_ptr   = value_buffer_ptr.get();
+
+                    primitives_ptr->record_sort(cmd_buffer_ptr.get(),
+                                                sort_info);
+                }
+
+                /* Consecutive iterations touch the same buffers */
+                {
+                    const Anvil::MemoryBarrier barrier(Anvil::AccessFlagBits::SHADER_READ_BIT | Anvil::AccessFlagBits::SHADER_WRITE_BIT, /* in_destination_access_mask */
+                                                       Anvil::AccessFlagBits::SHADER_READ_BIT | Anvil::AccessFlagBits::SHADER_WRITE_BIT);
+
+                    cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::COMPUTE_SHADER_BIT,
+                                                            Anvil::PipelineStageFlagBits::COMPUTE_SHADER_BIT,
+                                                            Anvil::DependencyFlagBits::NONE,
+                                                            1,       /* in_memory_barrier_count        */
+                                                           &barrier,
+                                                            0,       /* in_buffer_memory_barrier_count */
+                                                            nullptr, /* in_buffer_memory_barrier_ptrs  */
+                                                            0,       /* in_image_memory_barrier_count  */
+                                                            nullptr);
+                }
+            }
+        }
+        cmd_buffer_ptr->stop_recording();
+
+        /* Measures submission to completion, so the figures include the submission & fence wait latency */
+        {
+            const uint64_t start_time = m_time.get_time_in_nsec();
+
+            queue_ptr->submit(
+                Anvil::SubmitInfo::create_execute(cmd_buffer_ptr.get(),
+                                                  false, /* in_should_block */
+                                                  fence_raw_ptr)
+            );
+
+            Anvil::Fence::wait_fences(1, /* in_n_fences */
+                                     &fence_raw_ptr);
+
+            n_nsec = m_time.get_time_in_nsec() - start_time;
+        }
+
+        fence_ptr->reset();
+
+        snprintf(name,
+                 sizeof(name),
+                 "ComputePrimitives::%s [%s]",
+                 (is_scan)  ? "record_scan()"             :
+                 (is_64bit) ? "record_sort() [64-bit kv]" :
+                              "record_sort() [32-bit kv]",
+                 device_name);
+
+        printf("%-60s %12.1f Mkeys/s\n",
+               name,
+               static_cast<double>(N_KEYS_SORT) * N_ITERATIONS_SORT * 1000.0 / static_cast<double>(n_nsec) );
+    }
+}
+
+void App::benchmark_draw_allocations()
+{
+    auto                        cmd_buffer_ptr       = m_device_ptr->get_command_pool_for_queue_family_index(m_device_ptr->get_universal_queue(0)->get_queue_family_index() )->alloc_primary_level_command_buffer();
+    VkClearValue                clear_value;
+    const Anvil::DescriptorSet* ds_ptr               = m_dsg_ptr->get_descriptor_set(0);
+    uint64_t                    n_barrier_allocs     = 0;
+    uint64_t                    n_draw_allocs        = 0;
+    Anvil::PipelineLayout*      pipeline_layout_ptr  = m_device_ptr->get_graphics_pipeline_manager()->get_pipeline_layout(m_pipeline_id);
+    VkRect2D                    render_area;
+    Anvil::Buffer*              vertex_buffer_ptr    = m_dst_buffer_ptr.get();
+    const VkDeviceSize          vertex_buffer_offset = 0;
+
+    clear_value.color.float32[0] = 0.0f;
+    clear_value.color.float32[1] = 0.0f;
+    clear_value.color.float32[2] = 0.0f;
+    clear_value.color.float32[3] = 0.0f;
+
+    render_area.extent.height = RT_HEIGHT;
+    render_area.extent.width  = RT_WIDTH;
+    render_area.offset.x      = 0;
+    render_area.offset.y      = 0;
+
+    /* The first iteration grows internal state caches, so it is excluded from the totals */
+    for (uint32_t n_iteration = 0;
+                  n_iteration < N_ITERATIONS_DRAW_ALLOCATIONS + 1;
+                ++n_iteration)
+    {
+        uint64_t n_allocs_at_start = 0;
+
+        cmd_buffer_ptr->reset(false); /* in_should_release_resources */
+
+        cmd_buffer_ptr->start_recording(true,   /* in_one_time_submit          */
+                                        false); /* in_simultaneous_use_allowed */
+        {
+            const Anvil::BufferBarrier barrier(Anvil::AccessFlagBits::TRANSFER_WRITE_BIT,
+                                               Anvil::AccessFlagBits::VERTEX_ATTRIBUTE_READ_BIT,
+                                               VK_QUEUE_FAMILY_IGNORED,
+                                               VK_QUEUE_FAMILY_IGNORED,
+                                               m_dst_buffer_ptr.get(),
+                                               0, /* in_offset */
+                                               VK_WHOLE_SIZE);
+
+            n_allocs_at_start = g_n_heap_allocations;
+            {
+                cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                        Anvil::PipelineStageFlagBits::VERTEX_INPUT_BIT,
+                                                        Anvil::DependencyFlagBits::NONE,
+                                                        0,        /* in_memory_barrier_count        */
+                                                        nullptr,  /* in_memory_barriers_ptr         */
+                                                        1,        /* in_buffer_memory_barrier_count */
+                                                       &barrier,
+                                                        0,        /* in_image_memory_barrier_count  */
+                                                        nullptr); /* in_image_memory_barriers_ptr   */
+            }
+            if (n_iteration > 0)
+            {
+                n_barrier_allocs += g_n_heap_allocations - n_allocs_at_start;
+            }
+
+            cmd_buffer_ptr->record_begin_render_pass(1, /* in_n_clear_values */
+                                                    &clear_value,
+                                                     m_framebuffer_ptr.get(),
+                                                     render_area,
+                                                     m_renderpass_ptr.get(),
+                                                     Anvil::SubpassContents::INLINE);
+            {
+                n_allocs_at_start = g_n_heap_allocations;
+                {
+                    for (uint32_t n_draw = 0;
+                                  n_draw < N_DRAWS_PER_COMMAND_BUFFER;
+                                ++n_draw)
+                    {
+                        cmd_buffer_ptr->record_bind_pipeline       (Anvil::PipelineBindPoint::GRAPHICS,
+                                                                    m_pipeline_id);
+                        cmd_buffer_ptr->record_bind_descriptor_sets(Anvil::PipelineBindPoint::GRAPHICS,
+                                                                    pipeline_layout_ptr,
+                                                                    0, /* in_first_set */
+                                                                    1, /* in_set_count */
+                                                                   &ds_ptr,
+                                                                    0,        /* in_dynamic_offset_count */
+                                                                    nullptr); /* in_dynamic_offset_ptrs  */
+                        cmd_buffer_ptr->record_bind_vertex_buffers (0, /* in_start_binding */
+                                                                    1, /* in_binding_count */
+                                                                   &vertex_buffer_ptr,
+                                                                   &vertex_buffer_offset);
+                        cmd_buffer_ptr->record_draw                (3,  /* in_vertex_count   */
+                                                                    1,  /* in_instance_count */
+                                                                    0,  /* in_first_vertex   */
+                                                                    0); /* in_first_instance */
+                    }
+                }
+                if (n_iteration > 0)
+                {
+                    n_draw_allocs += g_n_heap_allocations - n_allocs_at_start;
+                }
+            }
+            cmd_buffer_ptr->record_end_render_pass();
+        }
+        cmd_buffer_ptr->stop_recording();
+    }
+
+    printf("%-60s %12.2f allocs/op\n",
+           "Heap allocations per recorded draw",
+           static_cast<double>(n_draw_allocs) / static_cast<double>(N_ITERATIONS_DRAW_ALLOCATIONS * N_DRAWS_PER_COMMAND_BUFFER) );
+    printf("%-60s %12.2f allocs/op\n",
+           "Heap allocations per recorded pipeline barrier",
+           static_cast<double>(n_barrier_allocs) / static_cast<double>(N_ITERATIONS_DRAW_ALLOCATIONS) );
+
+    if (n_draw_allocs    != 0 ||
+        n_barrier_allocs != 0)
+    {
+        fprintf(stderr,
+                "[!] Recording draws or barriers touched the heap.\n");
+
+        anvil_assert_fail();
+    }
+}
+
+void App::benchmark_descriptor_set_updates()
+{
+    Anvil::DescriptorSet*                   ds_ptr         = m_dsg_ptr->get_descriptor_set(0);
+    uint32_t                                n_update       = 0;
+    const Anvil::DescriptorSetUpdateMethod  update_methods[] =
+    {
+        Anvil::DescriptorSetUpdateMethod::CORE,
+        Anvil::DescriptorSetUpdateMethod::TEMPLATE
+    };
+
+    for (const auto& current_update_method : update_methods)
+    {
+        const bool is_template = (current_update_method == Anvil::DescriptorSetUpdateMethod::TEMPLATE);
+
+        if (is_template                                                          &&
+           !m_device_ptr->get_extension_info()->khr_descriptor_update_template() )
+        {
+            printf("DescriptorSet::update() [template]: skipped, VK_KHR_descriptor_update_template is not supported\n");
+
+            continue;
+        }
+
+        /* Alternate between two buffers, so that every update has a dirty binding to flush */
+        measure((is_template) ? "DescriptorSet::update() [template]"
+                              : "DescriptorSet::update() [core]",
+                N_ITERATIONS_DS_UPDATE,
+                1, /* in_n_ops_per_iteration */
+                [&]()
+                {
+                    ds_ptr->set_binding_item(0, /* in_binding_index */
+                                             Anvil::DescriptorSet::UniformBufferBindingElement(m_ub_buffer_ptrs[(n_update++) % 2].get() ));
+                    ds_ptr->update          (current_update_method);
+                });
+    }
+}
+
+void App::benchmark_graphics_pipeline_baking()
+{
+    for (uint32_t n_variant = 0;
+                  n_variant < 2;
+                ++n_variant)
+    {
+        const bool use_pipeline_cache       = (n_variant == 1);
+        auto       gfx_pipeline_manager_ptr = Anvil::GraphicsPipelineManager::create(m_device_ptr.get(),
+                                                                                     false, /* in_mt_safe */
+                                                                                     use_pipeline_cache);
+        uint64_t   n_total_nsec             = 0;
+
+        for (uint32_t n_iteration = 0;
+                      n_iteration < N_ITERATIONS_PIPELINE_BAKE;
+                    ++n_iteration)
+        {
+            Anvil::PipelineID pipeline_id = UINT32_MAX;
+            uint64_t          start_time  = 0;
+
+            gfx_pipeline_manager_ptr->add_pipeline(create_gfx_pipeline_create_info(),
+                                                  &pipeline_id);
+
+            start_time = m_time.get_time_in_nsec();
+            {
+                gfx_pipeline_manager_ptr->bake();
+            }
+            n_total_nsec += m_time.get_time_in_nsec() - start_time;
+
+            gfx_pipeline_manager_ptr->delete_pipeline(pipeline_id);
+        }
+
+        print_results((use_pipeline_cache) ? "GraphicsPipelineManager::bake() [pipeline cache]"
+                                            : "GraphicsPipelineManager::bake() [no pipeline cache]",
+                      n_total_nsec,
+                      N_ITERATIONS_PIPELINE_BAKE);
+    }
+}
+
+void App::benchmark_memory_allocator_baking()
+{
+    for (uint32_t n_variant = 0;
+                  n_variant < 2;
+                ++n_variant)
+    {
+        const bool use_vma      = (n_variant == 1);
+        uint64_t   n_total_nsec = 0;
+
+        for (uint32_t n_iteration = 0;
+                      n_iteration < N_ITERATIONS_MEMORY_ALLOCATOR;
+                    ++n_iteration)
+        {
+            auto                                allocator_ptr = (use_vma) ? Anvil::MemoryAllocator::create_vma    (m_device_ptr.get() )
+                                                                          : Anvil::MemoryAllocator::create_oneshot(m_device_ptr.get() );
+            std::vector<Anvil::BufferUniquePtr> buffers;
+            uint64_t                            start_time    = 0;
+
+            buffers.reserve(N_BUFFERS_PER_ALLOCATOR_BAKE);
+
+            for (uint32_t n_buffer = 0;
+                          n_buffer < N_BUFFERS_PER_ALLOCATOR_BAKE;
+                        ++n_buffer)
+            {
+                auto create_info_ptr = Anvil::BufferCreateInfo::create_no_alloc(m_device_ptr.get(),
+                                                                                1024 * (1 + n_buffer % 16),
+                                                                                Anvil::QueueFamilyFlagBits::GRAPHICS_BIT,
+                                                                                Anvil::SharingMode::EXCLUSIVE,
+                                                                                Anvil::BufferCreateFlagBits::NONE,
+                                                                                Anvil::BufferUsageFlagBits::UNIFORM_BUFFER_BIT);
+
+                buffers.push_back(Anvil::Buffer::create(std::move(create_info_ptr) ));
+
+                allocator_ptr->add_buffer(buffers.back().get(),
+                                          Anvil::MemoryFeatureFlagBits::NONE); /* in_required_memory_features */
+            }
+
+            start_time = m_time.get_time_in_nsec();
+            {
+                allocator_ptr->bake();
+            }
+            n_total_nsec += m_time.get_time_in_nsec() - start_time;
+        }
+
+        print_results((use_vma) ? "MemoryAllocator::bake() [VMA, per buffer]"
+                                : "MemoryAllocator::bake() [oneshot, per buffer]",
+                      n_total_nsec,
+                      N_ITERATIONS_MEMORY_ALLOCATOR * N_BUFFERS_PER_ALLOCATOR_BAKE);
+    }
+}
+
+void App::benchmark_msaa_resolves()
+{
+    auto                      allocator_ptr           = Anvil::MemoryAllocator::create_oneshot(m_device_ptr.get() );
+    auto                      cmd_buffer_ptr          = m_device_ptr->get_command_pool_for_queue_family_index(m_device_ptr->get_universal_queue(0)->get_queue_family_index() )->alloc_primary_level_command_buffer();
+    const char*               device_name             = m_physical_device_ptr->get_device_properties().core_vk1_0_properties_ptr->device_name;
+    auto                      fence_ptr               = Anvil::Fence::create(Anvil::FenceCreateInfo::create(m_device_ptr.get(),
+                                                                                                            false) ); /* in_create_signalled */
+    Anvil::Fence*             fence_raw_ptr           = fence_ptr.get();
+    Anvil::ImageUniquePtr     ms_image_ptr;
+    Anvil::ImageViewUniquePtr ms_image_view_ptr;
+    Anvil::Queue*             queue_ptr               = m_device_ptr->get_universal_queue(0);
+    Anvil::ImageUniquePtr     resolved_image_ptr;
+    Anvil::ImageViewUniquePtr resolved_image_view_ptr;
+
+    {
+        const struct
+        {
+            Anvil::ImageUniquePtr*     image_ptr_ptr;
+            Anvil::ImageViewUniquePtr* image_view_ptr_ptr;
+            Anvil::SampleCountFlagBits sample_count;
+            Anvil::ImageUsageFlags     usage;
+        } images[] =
+        {
+            {&ms_image_ptr,       &ms_image_view_ptr,       Anvil::SampleCountFlagBits::_4_BIT, Anvil::ImageUsageFlagBits::COLOR_ATTACHMENT_BIT | Anvil::ImageUsageFlagBits::TRANSFER_SRC_BIT},
+            {&resolved_image_ptr, &resolved_image_view_ptr, Anvil::SampleCountFlagBits::_1_BIT, Anvil::ImageUsageFlagBits::COLOR_ATTACHMENT_BIT | Anvil::ImageUsageFlagBits::TRANSFER_DST_BIT},
+        };
+
+        for (const auto& current_image : images)
+        {
+            auto create_info_ptr = Anvil::ImageCreateInfo::create_no_alloc(m_device_ptr.get(),
+                                                                           Anvil::ImageType::_2D,
+                                                                           Anvil::Format::R8G8B8A8_UNORM,
+                                                                           Anvil::ImageTiling::OPTIMAL,
+                                                                           current_image.usage,
+                                                                           RT_WIDTH,
+                                                                           RT_HEIGHT,
+                                                                           1, /* in_base_mipmap_depth */
+                                                                           1, /* in_n_layers          */
+                                                                           current_image.sample_count,
+                                                                           Anvil::QueueFamilyFlagBits::GRAPHICS_BIT,
+                                                                           Anvil::SharingMode::EXCLUSIVE,
+                                                                           false, /* in_use_full_mipmap_chain */
+                                                                           Anvil::ImageCreateFlagBits::NONE);
+
+            *current_image.image_ptr_ptr = Anvil::Image::create(std::move(create_info_ptr) );
+
+            allocator_ptr->add_image_whole(current_image.image_ptr_ptr->get(),
+                                           Anvil::MemoryFeatureFlagBits::DEVICE_LOCAL_BIT); /* in_required_memory_features */
+        }
+
+        allocator_ptr->bake();
+
+        for (const auto& current_image : images)
+        {
+            auto create_info_ptr = Anvil::ImageViewCreateInfo::create_2D(m_device_ptr.get(),
+                                                                         current_image.image_ptr_ptr->get(),
+                                                                         0, /* n_base_layer        */
+                                                                         0, /* n_base_mipmap_level */
+                                                                         1, /* n_mipmaps           */
+                                                                         Anvil::ImageAspectFlagBits::COLOR_BIT,
+                                                                         Anvil::Format::R8G8B8A8_UNORM,
+                                                                         Anvil::ComponentSwizzle::IDENTITY,
+                                                                         Anvil::ComponentSwizzle::IDENTITY,
+                                                                         Anvil::ComponentSwizzle::IDENTITY,
+                                                                         Anvil::ComponentSwizzle::IDENTITY);
+
+            *current_image.image_view_ptr_ptr = Anvil::ImageView::create(std::move(create_info_ptr) );
+        }
+    }
+
+    /* Variant 0 stores the multisample attachment and resolves it with vkCmdResolveImage() after the render pass.
+     * Variant 1 resolves it at the end of the subpass, and never stores the multisample data. No geometry is drawn,
+     * so the figures isolate the cost of the resolve itself. */
+    for (uint32_t n_variant = 0;
+                  n_variant < 2;
+                ++n_variant)
+    {
+        const VkClearValue            clear_value      = {{{0.25f, 0.5f, 0.75f, 1.0f}}};
+        Anvil::FramebufferUniquePtr   framebuffer_ptr;
+        const bool                    is_in_subpass    = (n_variant == 1);
+        Anvil::RenderPassAttachmentID ms_attachment_id = UINT32_MAX;
+        char                          name[128];
+        uint64_t                      n_nsec           = 0;
+        VkRect2D                      render_area;
+        Anvil::RenderPassUniquePtr    render_pass_ptr;
+        Anvil::SubPassID              subpass_id       = UINT32_MAX;
+
+        {
+            Anvil::RenderPassCreateInfoUniquePtr render_pass_create_info_ptr(new Anvil::RenderPassCreateInfo(m_device_ptr.get() ) );
+
+            render_pass_create_info_ptr->add_color_attachment(Anvil::Format::R8G8B8A8_UNORM,
+                                                              Anvil::SampleCountFlagBits::_4_BIT,
+                                                              Anvil::AttachmentLoadOp::CLEAR,
+                                                              (is_in_subpass) ? Anvil::AttachmentStoreOp::DONT_CARE
+                                                                              : Anvil::AttachmentStoreOp::STORE,
+                                                              Anvil::ImageLayout::UNDEFINED,
+                                                              (is_in_subpass) ? Anvil::ImageLayout::COLOR_ATTACHMENT_OPTIMAL
+                                                                              : Anvil::ImageLayout::TRANSFER_SRC_OPTIMAL,
+                                                              false, /* in_may_alias */
+                                                             &ms_attachment_id);
+            render_pass_create_info_ptr->add_subpass         (&subpass_id);
+
+            if (is_in_subpass)
+            {
+                render_pass_create_info_ptr->add_subpass_color_attachment_with_resolve(subpass_id,
+                                                                                       Anvil::ImageLayout::COLOR_ATTACHMENT_OPTIMAL,
+                                                                                       ms_attachment_id,
+                                                                                       0, /* in_location */
+                                                                                       Anvil::ImageLayout::COLOR_ATTACHMENT_OPTIMAL);
+
+                /* Consecutive iterations write the same attachments */
+                render_pass_create_info_ptr->add_external_to_subpass_dependency(subpass_id,
+                                                                                Anvil::PipelineStageFlagBits::COLOR_ATTACHMENT_OUTPUT_BIT,
+                                                                                Anvil::PipelineStageFlagBits::COLOR_ATTACHMENT_OUTPUT_BIT,
+                                                                                Anvil::AccessFlagBits::COLOR_ATTACHMENT_WRITE_BIT,
+                                                                                Anvil::AccessFlagBits::COLOR_ATTACHMENT_WRITE_BIT,
+                                                                                Anvil::DependencyFlagBits::NONE);
+            }
+            else
+            {
+                render_pass_create_info_ptr->add_subpass_color_attachment(subpass_id,
+                                                                          Anvil::ImageLayout::COLOR_ATTACHMENT_OPTIMAL,
+                                                                          ms_attachment_id,
+                                                                          0); /* in_location */
+
+                /* The previous iteration's resolve must finish reading the attachment before it is cleared again */
+                render_pass_create_info_ptr->add_external_to_subpass_dependency(subpass_id,
+                                                                                Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                                                Anvil::PipelineStageFlagBits::COLOR_ATTACHMENT_OUTPUT_BIT,
+                                                                                Anvil::AccessFlagBits::NONE,
+                                                                                Anvil::AccessFlagBits::COLOR_ATTACHMENT_WRITE_BIT,
+                                                                                Anvil::DependencyFlagBits::NONE);
+                render_pass_create_info_ptr->add_subpass_to_external_dependency(subpass_id,
+                                                                                Anvil::PipelineStageFlagBits::COLOR_ATTACHMENT_OUTPUT_BIT,
+                                                                                Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                                                Anvil::AccessFlagBits::COLOR_ATTACHMENT_WRITE_BIT,
+                                                                                Anvil::AccessFlagBits::TRANSFER_READ_BIT,
+                                                                                Anvil::DependencyFlagBits::NONE);
+            }
+
+            render_pass_ptr = Anvil::RenderPass::create(std::move(render_pass_create_info_ptr),
+                                                        nullptr); /* in_opt_swapchain_ptr */
+        }
+
+        {
+            auto create_info_ptr = Anvil::FramebufferCreateInfo::create(m_device_ptr.get(),
+                                                                        RT_WIDTH,
+                                                                        RT_HEIGHT,
+                                                                        1); /* n_layers */
+
+            create_info_ptr->add_attachment(ms_image_view_ptr.get(),
+                                            nullptr); /* out_opt_attachment_id_ptr */
+
+            if (is_in_subpass)
+            {
+                create_info_ptr->add_attachment(resolved_image_view_ptr.get(),
+                                                nullptr); /* out_opt_attachment_id_ptr */
+            }
+
+            framebuffer_ptr = Anvil::Framebuffer::create(std::move(create_info_ptr) );
+        }
+
+        render_area.extent.height = RT_HEIGHT;
+        render_area.extent.width  = RT_WIDTH;
+        render_area.offset.x      = 0;
+        render_area.offset.y      = 0;
+
+        cmd_buffer_ptr->start_recording(false,  /* in_one_time_submit          */
+                                        false); /* in_simultaneous_use_allowed */
+        {
+            for (uint32_t n_iteration = 0;
+                          n_iteration < N_ITERATIONS_MSAA_RESOLVE;
+                        ++n_iteration)
+            {
+                cmd_buffer_ptr->record_begin_render_pass(1, /* in_n_clear_values */
+                                                        &clear_value,
+                                                         framebuffer_ptr.get(),
+                                                         render_area,
+                                                         render_pass_ptr.get(),
+                                                         Anvil::SubpassContents::INLINE);
+                cmd_buffer_ptr->record_end_render_pass  ();
+
+                if (!is_in_subpass)
+                {
+                    const Anvil::ImageBarrier barrier(Anvil::AccessFlagBits::TRANSFER_WRITE_BIT, /* in_source_access_mask      */
+                                                      Anvil::AccessFlagBits::TRANSFER_WRITE_BIT, /* in_destination_access_mask */
+                                                      Anvil::ImageLayout::UNDEFINED,
+                                                      Anvil::ImageLayout::TRANSFER_DST_OPTIMAL,
+                                                      VK_QUEUE_FAMILY_IGNORED,
+                                                      VK_QUEUE_FAMILY_IGNORED,
+                                                      resolved_image_ptr.get(),
+                                                      resolved_image_ptr->get_subresource_range() );
+                    Anvil::ImageResolve       region;
+
+                    region.dst_offset.x                     = 0;
+                    region.dst_offset.y                     = 0;
+                    region.dst_offset.z                     = 0;
+                    region.dst_subresource.aspect_mask      = Anvil::ImageAspectFlagBits::COLOR_BIT;
+                    region.dst_subresource.base_array_layer = 0;
+                    region.dst_subresource.layer_count      = 1;
+                    region.dst_subresource.mip_level        = 0;
+                    region.extent.depth                     = 1;
+                    region.extent.height                    = RT_HEIGHT;
+                    region.extent.width                     = RT_WIDTH;
+                    region.src_offset                       = region.dst_offset;
+                    region.src_subresource                  = region.dst_subresource;
+
+                    cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                            Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                            Anvil::DependencyFlagBits::NONE,
+                                                            0,       /* in_memory_barrier_count        */
+                                                            nullptr, /* in_memory_barriers_ptr         */
+                                                            0,       /* in_buffer_memory_barrier_count */
+                                                            nullptr, /* in_buffer_memory_barrier_ptrs  */
+                                                            1,       /* in_image_memory_barrier_count  */
+                                                           &barrier);
+                    cmd_buffer_ptr->record_resolve_image   (ms_image_ptr.get(),
+                                                            Anvil::ImageLayout::TRANSFER_SRC_OPTIMAL,
+                                                            resolved_image_ptr.get(),
+                                                            Anvil::ImageLayout::TRANSFER_DST_OPTIMAL,
+                                                            1, /* in_region_count */
+                                                           &region);
+                }
+            }
+        }
+        cmd_buffer_ptr->stop_recording();
+
+        /* The first submission warms up the driver. Only the second one is measured. As with the compute primitives,
+         * the figures include the submission & fence wait latency. */
+        for (uint32_t n_submission = 0;
+                      n_submission < 2;
+                    ++n_submission)
+        {
+            const uint64_t start_time = m_time.get_time_in_nsec();
+
+            queue_ptr->submit(
+                Anvil::SubmitInfo::create_execute(cmd_buffer_ptr.get(),
+                                                  false, /* in_should_block */
+                                                  fence_raw_ptr)
+            );
+
+            Anvil::Fence::wait_fences(1, /* in_n_fences */
+                                     &fence_raw_ptr);
+
+            n_nsec = m_time.get_time_in_nsec() - start_time;
+
+            fence_ptr->reset();
+        }
+
+        snprintf(name,
+                 sizeof(name),
+                 "4x MSAA %ux%u resolve [%s] [%s]",
+                 RT_WIDTH,
+                 RT_HEIGHT,
+                 (is_in_subpass) ? "subpass resolve attachment"
+                                 : "record_resolve_image()",
+                 device_name);
+
+        print_results(name,
+                      n_nsec,
+                      N_ITERATIONS_MSAA_RESOLVE);
+    }
+}
+
+void App::benchmark_queue_submissions()
+{
+    auto          cmd_buffer_ptr = m_device_ptr->get_command_pool_for_queue_family_index(m_device_ptr->get_universal_queue(0)->get_queue_family_index() )->alloc_primary_level_command_buffer();
+    auto          fence_ptr      = Anvil::Fence::create(Anvil::FenceCreateInfo::create(m_device_ptr.get(),
+                                                                                       false) ); /* in_create_signalled */
+    Anvil::Fence* fence_raw_ptr  = fence_ptr.get();
+    uint64_t      n_total_nsec   = 0;
+    Anvil::Queue* queue_ptr      = m_device_ptr->get_universal_queue(0);
+
+    cmd_buffer_ptr->start_recording(false, /* in_one_time_submit          */
+                                    true); /* in_simultaneous_use_allowed */
+    cmd_buffer_ptr->stop_recording ();
+
+    /* Only the submit() call is timed. Waiting for the GPU to pick the work up is not. */
+    for (uint32_t n_iteration = 0;
+                  n_iteration < N_ITERATIONS_QUEUE_SUBMIT;
+                ++n_iteration)
+    {
+        const uint64_t start_time = m_time.get_time_in_nsec();
+        {
+            queue_ptr->submit(
+                Anvil::SubmitInfo::create_execute(cmd_buffer_ptr.get(),
+                                                  false, /* in_should_block */
+                                                  fence_raw_ptr)
+            );
+        }
+        n_total_nsec += m_time.get_time_in_nsec() - start_time;
+
+        Anvil::Fence::wait_fences(1, /* in_n_fences */
+                                 &fence_raw_ptr);
+
+        fence_ptr->reset();
+    }
+
+    print_results("Queue::submit()",
+                  n_total_nsec,
+                  N_ITERATIONS_QUEUE_SUBMIT);
+}
+
+void App::benchmark_shader_module_cache()
+{
+    auto        shader_module_cache_ptr = m_device_ptr->get_shader_module_cache();
+    const auto& spirv_blob              = m_vs_ptr->shader_module_ptr->get_spirv_blob();
+
+    if (shader_module_cache_ptr == nullptr)
+    {
+        printf("ShaderModuleCache lookup: skipped, shader module cache is disabled\n");
+
+        return;
+    }
+
+    /* The vertex shader module has been created at init time, so all lookups are hits */
+    measure("ShaderModuleCache lookup [hit]",
+            N_ITERATIONS_SHADER_MODULE_LOOKUP,
+            1, /* in_n_ops_per_iteration */
+            [&]()
+            {
+                shader_module_cache_ptr->lock();
+                {
+                    auto shader_module_ptr = shader_module_cache_ptr->get_cached_shader_module(m_device_ptr.get(),
+                                                                                               reinterpret_cast<const char*>(&spirv_blob.at(0) ),
+                                                                                               static_cast<uint32_t>(spirv_blob.size() * sizeof(spirv_blob.at(0) )),
+                                                                                               "",      /* in_cs_entrypoint_name */
+                                                                                               "",      /* in_fs_entrypoint_name */
+                                                                                               "",      /* in_gs_entrypoint_name */
+                                                                                               "",      /* in_tc_entrypoint_name */
+                                                                                               "",      /* in_te_entrypoint_name */
+                                                                                               "main"); /* in_vs_entrypoint_name */
+
+                    anvil_assert(shader_module_ptr != nullptr);
+                }
+                shader_module_cache_ptr->unlock();
+            });
+}
+
+Anvil::GraphicsPipelineCreateInfoUniquePtr App::create_gfx_pipeline_create_info() const
+{
+    auto result_ptr = Anvil::GraphicsPipelineCreateInfo::create(Anvil::PipelineCreateFlagBits::NONE,
+                                                                m_renderpass_ptr.get(),
+                                                                m_subpass_id,
+                                                               *m_fs_ptr,
+                                                                Anvil::ShaderModuleStageEntryPoint(), /* in_geometry_shader        */
+                                                                Anvil::ShaderModuleStageEntryPoint(), /* in_tess_control_shader    */
+                                                                Anvil::ShaderModuleStageEntryPoint(), /* in_tess_evaluation_shader */
+                                                               *m_vs_ptr);
+
+    /* There is no swapchain to derive the viewport & scissor box from */
+    result_ptr->set_descriptor_set_create_info(m_dsg_ptr->get_descriptor_set_create_info() );
+    result_ptr->set_scissor_box_properties    (0, /* in_n_scissor_box */
+                                               0, /* in_x             */
+                                               0, /* in_y             */
+                                               RT_WIDTH,
+                                               RT_HEIGHT);
+    result_ptr->set_viewport_properties       (0,    /* in_n_viewport */
+                                               0.0f, /* in_origin_x   */
+                                               0.0f, /* in_origin_y   */
+                                               static_cast<float>(RT_WIDTH),
+                                               static_cast<float>(RT_HEIGHT),
+                                               0.0f,  /* in_min_depth */
+                                               1.0f); /* in_max_depth */
+
+    return result_ptr;
+}
+
+void App::deinit()
+{
+    if (m_device_ptr != nullptr)
+    {
+        m_device_ptr->wait_idle();
+
+        if (m_pipeline_id != UINT32_MAX)
+        {
+            m_device_ptr->get_graphics_pipeline_manager()->delete_pipeline(m_pipeline_id);
+
+            m_pipeline_id = UINT32_MAX;
+        }
+    }
+
+    m_framebuffer_ptr.reset     ();
+    m_color_image_view_ptr.reset();
+    m_color_image_ptr.reset     ();
+
+    m_dsg_ptr.reset       ();
+    m_dst_buffer_ptr.reset();
+    m_fs_ptr.reset        ();
+    m_renderpass_ptr.reset();
+    m_vs_ptr.reset        ();
+
+    for (auto& current_ub_buffer_ptr : m_ub_buffer_ptrs)
+    {
+        current_ub_buffer_ptr.reset();
+    }
+
+    m_device_ptr.reset  ();
+    m_instance_ptr.reset();
+    m_window_ptr.reset  ();
+
+    m_host_allocator_ptr.reset();
+}
+
+void App::init()
+{
+    init_vulkan ();
+    init_window ();
+
+    init_buffers     ();
+    init_dsgs        ();
+    init_shaders     ();
+    init_framebuffer ();
+    init_gfx_pipeline();
+}
+
+void App::init_buffers()
+{
+    auto allocator_ptr = Anvil::MemoryAllocator::create_oneshot(m_device_ptr.get() );
+
+    {
+        auto create_info_ptr = Anvil::BufferCreateInfo::create_no_alloc(m_device_ptr.get(),
+                                                                        sizeof(uint32_t) * 4,
+                                                                        Anvil::QueueFamilyFlagBits::GRAPHICS_BIT,
+                                                                        Anvil::SharingMode::EXCLUSIVE,
+                                                                        Anvil::BufferCreateFlagBits::NONE,
+                                                                        Anvil::BufferUsageFlagBits::TRANSFER_DST_BIT | Anvil::BufferUsageFlagBits::VERTEX_BUFFER_BIT);
+
+        m_dst_buffer_ptr = Anvil::Buffer::create(std::move(create_info_ptr) );
+
+        allocator_ptr->add_buffer(m_dst_buffer_ptr.get(),
+                                  Anvil::MemoryFeatureFlagBits::NONE); /* in_required_memory_features */
+    }
+
+    for (auto& current_ub_buffer_ptr : m_ub_buffer_ptrs)
+    {
+        auto create_info_ptr = Anvil::BufferCreateInfo::create_no_alloc(m_device_ptr.get(),
+                                                                        sizeof(float) * 4,
+                                                                        Anvil::QueueFamilyFlagBits::GRAPHICS_BIT,
+                                                                        Anvil::SharingMode::EXCLUSIVE,
+                                                                        Anvil::BufferCreateFlagBits::NONE,
+                                                                        Anvil::BufferUsageFlagBits::UNIFORM_BUFFER_BIT);
+
+        current_ub_buffer_ptr = Anvil::Buffer::create(std::move(create_info_ptr) );
+
+        allocator_ptr->add_buffer(current_ub_buffer_ptr.get(),
+                                  Anvil::MemoryFeatureFlagBits::NONE); /* in_required_memory_features */
+    }
+
+    allocator_ptr->bake();
+}
+
+void App::init_dsgs()
+{
+    auto dsg_create_info_ptrs = std::vector<Anvil::DescriptorSetCreateInfoUniquePtr>(1);
+
+    dsg_create_info_ptrs[0] = Anvil::DescriptorSetCreateInfo::create();
+
+    dsg_create_info_ptrs[0]->add_binding(0, /* n_binding */
+                                         Anvil::DescriptorType::UNIFORM_BUFFER,
+                                         1, /* n_elements */
+                                         Anvil::ShaderStageFlagBits::FRAGMENT_BIT);
+
+    m_dsg_ptr = Anvil::DescriptorSetGroup::create(m_device_ptr.get(),
+                                                  dsg_create_info_ptrs);
+
+    m_dsg_ptr->set_binding_item(0, /* n_set     */
+                                0, /* n_binding */
+                                Anvil::DescriptorSet::UniformBufferBindingElement(m_ub_buffer_ptrs[0].get() ));
+}
+
+void App::init_framebuffer()
+{
+    {
+        auto create_info_ptr = Anvil::ImageCreateInfo::create_alloc(m_device_ptr.get(),
+                                                                    Anvil::ImageType::_2D,
+                                                                    Anvil::Format::R8G8B8A8_UNORM,
+                                                                    Anvil::ImageTiling::OPTIMAL,
+                                                                    Anvil::ImageUsageFlagBits::COLOR_ATTACHMENT_BIT,
+                                                                    RT_WIDTH,
+                                                                    RT_HEIGHT,
+                                                                    1, /* base_mipmap_depth */
+                                                                    1, /* n_layers          */
+                                                                    Anvil::SampleCountFlagBits::_1_BIT,
+                                                                    Anvil::QueueFamilyFlagBits::GRAPHICS_BIT,
+                                                                    Anvil::SharingMode::EXCLUSIVE,
+                                                                    false, /* in_use_full_mipmap_chain */
+                                                                    Anvil::MemoryFeatureFlagBits::NONE,
+                                                                    Anvil::ImageCreateFlagBits::NONE,
+                                                                    Anvil::ImageLayout::COLOR_ATTACHMENT_OPTIMAL, /* in_final_image_layout */
+                                                                    nullptr);                                     /* in_mipmaps_ptr        */
+
+        m_color_image_ptr = Anvil::Image::create(std::move(create_info_ptr) );
+    }
+
+    {
+        auto create_info_ptr = Anvil::ImageViewCreateInfo::create_2D(m_device_ptr.get(),
+                                                                     m_color_image_ptr.get(),
+                                                                     0, /* n_base_layer        */
+                                                                     0, /* n_base_mipmap_level */
+                                                                     1, /* n_mipmaps           */
+                                                                     Anvil::ImageAspectFlagBits::COLOR_BIT,
+                                                                     m_color_image_ptr->get_create_info_ptr()->get_format(),
+                                                                     Anvil::ComponentSwizzle::IDENTITY,
+                                                                     Anvil::ComponentSwizzle::IDENTITY,
+                                                                     Anvil::ComponentSwizzle::IDENTITY,
+                                                                     Anvil::ComponentSwizzle::IDENTITY);
+
+        m_color_image_view_ptr = Anvil::ImageView::create(std::move(create_info_ptr) );
+    }
+
+    {
+        auto create_info_ptr = Anvil::FramebufferCreateInfo::create(m_device_ptr.get(),
+                                                                    RT_WIDTH,
+                                                                    RT_HEIGHT,
+                                                                    1); /* n_layers */
+
+        create_info_ptr->add_attachment(m_color_image_view_ptr.get(),
+                                        nullptr); /* out_opt_attachment_id_ptr */
+
+        m_framebuffer_ptr = Anvil::Framebuffer::create(std::move(create_info_ptr) );
+    }
+}
+
+void App::init_gfx_pipeline()
+{
+    auto gfx_pipeline_manager_ptr = m_device_ptr->get_graphics_pipeline_manager();
+
+    gfx_pipeline_manager_ptr->add_pipeline(create_gfx_pipeline_create_info(),
+                                          &m_pipeline_id);
+    gfx_pipeline_manager_ptr->bake        ();
+}
+
+void App::init_shaders()
+{
+    Anvil::GLSLShaderToSPIRVGeneratorUniquePtr fragment_shader_ptr;
+    Anvil::ShaderModuleUniquePtr               fragment_shader_module_ptr;
+    Anvil::GLSLShaderToSPIRVGeneratorUniquePtr vertex_shader_ptr;
+    Anvil::ShaderModuleUniquePtr               vertex_shader_module_ptr;
+
+    fragment_shader_ptr = Anvil::GLSLShaderToSPIRVGenerator::create(m_device_ptr.get(),
+                                                                    Anvil::GLSLShaderToSPIRVGenerator::MODE_USE_SPECIFIED_SOURCE,
+                                                                    g_glsl_frag,
+                                                                    Anvil::ShaderStage::FRAGMENT);
+    vertex_shader_ptr   = Anvil::GLSLShaderToSPIRVGenerator::create(m_device_ptr.get(),
+                                                                    Anvil::GLSLShaderToSPIRVGenerator::MODE_USE_SPECIFIED_SOURCE,
+                                                                    g_glsl_vert,
+                                                                    Anvil::ShaderStage::VERTEX);
+
+    fragment_shader_module_ptr = Anvil::ShaderModule::create_from_spirv_generator(m_device_ptr.get       (),
+                                                                                  fragment_shader_ptr.get() );
+    vertex_shader_module_ptr   = Anvil::ShaderModule::create_from_spirv_generator(m_device_ptr.get       (),
+                                                                                  vertex_shader_ptr.get  () );
+
+    m_fs_ptr.reset(
+        new Anvil::ShaderModuleStageEntryPoint("main",
+                                               std::move(fragment_shader_module_ptr),
+                                               Anvil::ShaderStage::FRAGMENT)
+    );
+    m_vs_ptr.reset(
+        new Anvil::ShaderModuleStageEntryPoint("main",
+                                               std::move(vertex_shader_module_ptr),
+                                               Anvil::ShaderStage::VERTEX)
+    );
+
+    /* Pipelines are baked against an off-screen render pass */
+    {
+        Anvil::RenderPassAttachmentID        color_attachment_id;
+        Anvil::RenderPassCreateInfoUniquePtr render_pass_create_info_ptr(new Anvil::RenderPassCreateInfo(m_device_ptr.get() ) );
+
+        render_pass_create_info_ptr->add_color_attachment(Anvil::Format::R8G8B8A8_UNORM,
+                                                          Anvil::SampleCountFlagBits::_1_BIT,
+                                                          Anvil::AttachmentLoadOp::CLEAR,
+                                                          Anvil::AttachmentStoreOp::STORE,
+                                                          Anvil::ImageLayout::COLOR_ATTACHMENT_OPTIMAL,
+                                                          Anvil::ImageLayout::COLOR_ATTACHMENT_OPTIMAL,
+                                                          false, /* may_alias */
+                                                         &color_attachment_id);
+
+        render_pass_create_info_ptr->add_subpass                 (&m_subpass_id);
+        render_pass_create_info_ptr->add_subpass_color_attachment(m_subpass_id,
+                                                                  Anvil::ImageLayout::COLOR_ATTACHMENT_OPTIMAL,
+                                                                  color_attachment_id,
+                                                                  0,        /* location                      */
+                                                                  nullptr); /* opt_attachment_resolve_id_ptr */
+
+        m_renderpass_ptr = Anvil::RenderPass::create(std::move(render_pass_create_info_ptr),
+                                                     nullptr); /* in_opt_swapchain_ptr */
+    }
+}
+
+void App::init_window()
+{
+    /* The dummy window never presents anything. It only drives run_benchmarks() from its present call-back. */
+    m_window_ptr = Anvil::WindowFactory::create_window(Anvil::WINDOW_PLATFORM_DUMMY,
+                                                       APP_NAME,
+                                                       RT_WIDTH,
+                                                       RT_HEIGHT,
+                                                       true, /* in_closable */
+                                                       std::bind(&App::run_benchmarks,
+                                                                 this)
+    );
+}
+
+void App::init_vulkan()
+{
+    /* Route driver host allocations through a tracking allocator, so that their footprint can be reported. */
+    m_host_allocator_ptr = Anvil::TrackingHostAllocator::create();
+
+    /* Create a Vulkan instance */
+    {
+        auto create_info_ptr = Anvil::InstanceCreateInfo::create(APP_NAME,  /* in_app_name    */
+                                                                 APP_NAME,  /* in_engine_name */
+#ifdef ENABLE_VALIDATION
+                                                                 std::bind(&App::on_validation_callback,
+                                                                           this,
+                                                                           std::placeholders::_1,
+                                                                           std::placeholders::_2),
+#else
+                                                                 Anvil::DebugCallbackFunction(),
+#endif
+                                                                 false); /* in_mt_safe */
+
+        create_info_ptr->set_host_allocator(m_host_allocator_ptr.get() );
+
+        m_instance_ptr = Anvil::Instance::create(std::move(create_info_ptr) );
+    }
+
+    m_physical_device_ptr = m_instance_ptr->get_physical_device(0);
+
+    /* Create a Vulkan device. Command buffers are reset between iterations, so the pools must allow it. */
+    {
+        auto create_info_ptr = Anvil::DeviceCreateInfo::create_sgpu(m_physical_device_ptr,
+                                                                    true,                       /* in_enable_shader_module_cache */
+                                                                    Anvil::DeviceExtensionConfiguration(),
+                                                                    std::vector<std::string>(), /* in_layers */
+                                                                    Anvil::CommandPoolCreateFlagBits::CREATE_RESET_COMMAND_BUFFER_BIT,
+                                                                    false);                     /* in_mt_safe */
+
+        m_device_ptr = Anvil::SGPUDevice::create(std::move(create_info_ptr) );
+    }
+}
+
+void App::measure(const char*                  in_name,
+                  uint32_t                     in_n_iterations,
+                  uint32_t                     in_n_ops_per_iteration,
+                  const std::function<void()>& in_func)
+{
+    uint64_t start_time = 0;
+
+    /* Warm up caches & lazily created objects first */
+    in_func();
+
+    start_time = m_time.get_time_in_nsec();
+    {
+        for (uint32_t n_iteration = 0;
+                      n_iteration < in_n_iterations;
+                    ++n_iteration)
+        {
+            in_func();
+        }
+    }
+
+    print_results(in_name,
+                  m_time.get_time_in_nsec() - start_time,
+                  static_cast<uint64_t>(in_n_iterations) * in_n_ops_per_iteration);
+}
+
+void App::on_validation_callback(Anvil::DebugMessageSeverityFlags in_severity,
+                                 const char*                      in_message_ptr)
+{
+    if ((in_severity & Anvil::DebugMessageSeverityFlagBits::ERROR_BIT) != 0)
+    {
+        fprintf(stderr,
+                "[!] %s\n",
+                in_message_ptr);
+    }
+}
+
+void App::print_host_memory_usage() const
+{
+    static const struct
+    {
+        const char*                  name;
+        Anvil::SystemAllocationScope scope;
+    } scopes[] =
+    {
+        {"command",  Anvil::SystemAllocationScope::COMMAND},
+        {"object",   Anvil::SystemAllocationScope::OBJECT},
+        {"cache",    Anvil::SystemAllocationScope::CACHE},
+        {"device",   Anvil::SystemAllocationScope::DEVICE},
+        {"instance", Anvil::SystemAllocationScope::INSTANCE},
+    };
+
+    for (const auto& current_scope : scopes)
+    {
+        char name[64];
+
+        snprintf(name,
+                 sizeof(name),
+                 "Driver host memory (%s scope)",
+                 current_scope.name);
+
+        printf("%-60s %12" PRIu64 " bytes (%" PRIu64 " allocs, %" PRIu64 " internal bytes)\n",
+               name,
+               m_host_allocator_ptr->get_n_allocated_bytes         (current_scope.scope),
+               m_host_allocator_ptr->get_n_allocations             (current_scope.scope),
+               m_host_allocator_ptr->get_n_internal_allocated_bytes(current_scope.scope) );
+    }
+
+    printf("%-60s %12" PRIu64 " bytes\n",
+           "Driver host memory (peak)",
+           m_host_allocator_ptr->get_n_peak_allocated_bytes() );
+}
+
+void App::print_results(const char* in_name,
+                        uint64_t    in_n_total_nsec,
+                        uint64_t    in_n_ops)
+{
+    printf("%-60s %12.1f ns/op (%" PRIu64 " ops)\n",
+           in_name,
+           static_cast<double>(in_n_total_nsec) / static_cast<double>(in_n_ops),
+           in_n_ops);
+}
+
+void App::run()
+{
+    m_window_ptr->run();
+}
+
+void App::run_benchmarks()
+{
+    benchmark_command_recording       ();
+    benchmark_compute_primitives      ();
+    benchmark_draw_allocations        ();
+    benchmark_queue_submissions       ();
+    benchmark_descriptor_set_updates  ();
+    benchmark_graphics_pipeline_baking();
+    benchmark_memory_allocator_baking ();
+    benchmark_msaa_resolves           ();
+    benchmark_shader_module_cache     ();
+
+    print_host_memory_usage();
+
+    m_window_ptr->close();
+}
+
+
+int main(int argc, char *argv[])
+{
+    std::unique_ptr<App> app_ptr(new App() );
+
+    ANVIL_REDUNDANT_ARGUMENT(argc);
+    ANVIL_REDUNDANT_ARGUMENT(argv);
+
+    app_ptr->init();
+    app_ptr->run();
+
+    #ifdef _DEBUG
+    {
+        app_ptr.reset();
+
+        Anvil::ObjectTracker::get()->check_for_leaks();
+    }
+    #endif
+
+    return 0;
+}
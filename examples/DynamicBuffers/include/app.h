@@ -31,7 +31,7 @@ public:
      App();
     ~App();
 
-    void init();
+    void init(uint32_t in_n_bench_frames);
     void run ();
 
 private:
@@ -64,6 +64,9 @@ private:
                                    uint32_t* out_opt_offset_data_offset_ptr = nullptr);
 
     /* Private variables */
+    std::unique_ptr<BenchHarness> m_bench_harness_ptr;
+    uint32_t                      m_n_bench_frames;
+
     Anvil::BaseDeviceUniquePtr        m_device_ptr;
     Anvil::InstanceUniquePtr          m_instance_ptr;
     const Anvil::PhysicalDevice*      m_physical_device_ptr;
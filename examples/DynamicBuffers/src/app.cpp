@@ -66,6 +66,7 @@
 #include "wrappers/semaphore.h"
 #include "wrappers/shader_module.h"
 #include "wrappers/swapchain.h"
+#include "bench_harness.h"
 #include "app.h"
 
 /* Sanity checks */
@@ -191,6 +192,7 @@ static const char* g_glsl_producer_comp =
 
 App::App()
     :m_consumer_pipeline_id (UINT32_MAX),
+     m_n_bench_frames       (0),
      m_n_last_semaphore_used(0),
      m_n_swapchain_images   (N_SWAPCHAIN_IMAGES),
      m_producer_pipeline_id (UINT32_MAX)
@@ -210,6 +212,8 @@ void App::deinit()
 
     Anvil::Vulkan::vkDeviceWaitIdle(m_device_ptr->get_device_vk() );
 
+    m_bench_harness_ptr.reset();
+
     if (m_consumer_pipeline_id != UINT32_MAX)
     {
         gfx_pipeline_manager_ptr->delete_pipeline(m_consumer_pipeline_id);
@@ -284,6 +288,11 @@ void App::draw_frame()
     Anvil::Semaphore*               present_wait_semaphore_ptr      = nullptr;
     const Anvil::PipelineStageFlags wait_stage_mask                 = Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT;
 
+    if (m_bench_harness_ptr != nullptr)
+    {
+        m_bench_harness_ptr->on_frame_started();
+    }
+
     /* Determine the signal + wait semaphores to use for drawing this frame */
     m_n_last_semaphore_used = (m_n_last_semaphore_used + 1) % m_n_swapchain_images;
 
@@ -335,6 +344,14 @@ void App::draw_frame()
 
     ++n_frames_rendered;
 
+    if (m_bench_harness_ptr != nullptr)
+    {
+        if (m_bench_harness_ptr->on_frame_finished() )
+        {
+            m_window_ptr->close();
+        }
+    }
+
     #if defined(ENABLE_OFFSCREEN_RENDERING)
     {
         if (n_frames_rendered >= N_FRAMES_TO_RENDER)
@@ -345,8 +362,10 @@ void App::draw_frame()
     #endif
 }
 
-void App::init()
+void App::init(uint32_t in_n_bench_frames)
 {
+    m_n_bench_frames = in_n_bench_frames;
+
     init_vulkan   ();
     init_window   ();
     init_swapchain();
@@ -361,6 +380,16 @@ void App::init()
     init_framebuffers     ();
     init_gfx_pipelines    ();
     init_command_buffers  ();
+
+    if (m_n_bench_frames > 0)
+    {
+        m_bench_harness_ptr = BenchHarness::create(APP_NAME,
+                                                   m_device_ptr.get(),
+                                                   m_device_ptr->get_universal_queue(0),
+                                                   m_n_bench_frames);
+
+        anvil_assert(m_bench_harness_ptr != nullptr);
+    }
 }
 
 void App::get_buffer_memory_offsets(uint32_t  n_sine_pair,
@@ -1228,15 +1257,21 @@ void App::init_swapchain()
 void App::init_window()
 {
     #ifdef ENABLE_OFFSCREEN_RENDERING
-        const Anvil::WindowPlatform platform = Anvil::WINDOW_PLATFORM_DUMMY_WITH_PNG_SNAPSHOTS;
+        Anvil::WindowPlatform platform = Anvil::WINDOW_PLATFORM_DUMMY_WITH_PNG_SNAPSHOTS;
     #else
         #ifdef _WIN32
-            const Anvil::WindowPlatform platform = Anvil::WINDOW_PLATFORM_SYSTEM;
+            Anvil::WindowPlatform platform = Anvil::WINDOW_PLATFORM_SYSTEM;
         #else
-            const Anvil::WindowPlatform platform = Anvil::WINDOW_PLATFORM_XCB;
+            Anvil::WindowPlatform platform = Anvil::WINDOW_PLATFORM_XCB;
         #endif
     #endif
 
+    if (m_n_bench_frames > 0)
+    {
+        /* Benchmark mode renders offscreen, so that WSI does not skew the results. */
+        platform = Anvil::WINDOW_PLATFORM_DUMMY;
+    }
+
     /* Create a window */
     m_window_ptr = Anvil::WindowFactory::create_window(platform,
                                                        APP_NAME,
@@ -1296,14 +1331,27 @@ void App::on_validation_callback(Anvil::DebugMessageSeverityFlags in_severity,
 void App::run()
 {
     m_window_ptr->run();
+
+    if (m_bench_harness_ptr != nullptr)
+    {
+        m_bench_harness_ptr->report();
+    }
 }
 
 
 int main(int argc, char *argv[])
 {
-    std::unique_ptr<App> app_ptr(new App() );
+    std::unique_ptr<App> app_ptr       (new App() );
+    uint32_t             n_bench_frames(0);
+
+    if (!BenchHarness::parse_command_line(argc,
+                                          argv,
+                                         &n_bench_frames) )
+    {
+        return 1;
+    }
 
-    app_ptr->init();
+    app_ptr->init(n_bench_frames);
     app_ptr->run();
 
     #ifdef _DEBUG
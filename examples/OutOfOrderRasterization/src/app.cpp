@@ -120,6 +120,7 @@
 #include "wrappers/shader_module.h"
 #include "wrappers/swapchain.h"
 #include "teapot_data.h"
+#include "bench_harness.h"
 #include "app.h"
 
 /* Sanity checks */
@@ -283,6 +284,7 @@ static const char* vs_body =
 
 App::App()
     :m_general_pipeline_id        (-1),
+     m_n_bench_frames             (0),
      m_n_frames_drawn             ( 0),
      m_n_indices                  ( 0),
      m_n_last_semaphore_used      (-1),
@@ -331,6 +333,8 @@ void App::deinit()
 {
     Anvil::Vulkan::vkDeviceWaitIdle(m_device_ptr->get_device_vk() );
 
+    m_bench_harness_ptr.reset();
+
     const Anvil::PipelineID gfx_pipeline_ids[] =
     {
         m_general_pipeline_id,
@@ -410,6 +414,11 @@ void App::draw_frame()
     Anvil::PrimaryCommandBuffer*           render_cmdbuffer_ptr                = nullptr;
     const Anvil::PipelineStageFlags        wait_stage_mask                     = Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT;
 
+    if (m_bench_harness_ptr != nullptr)
+    {
+        m_bench_harness_ptr->on_frame_started();
+    }
+
     switch (device_type)
     {
         case Anvil::DeviceType::MULTI_GPU:
@@ -785,6 +794,14 @@ void App::draw_frame()
 
     m_frame_drawn_status[n_swapchain_image] = true;
 
+    if (m_bench_harness_ptr != nullptr)
+    {
+        if (m_bench_harness_ptr->on_frame_finished() )
+        {
+            m_window_ptr->close();
+        }
+    }
+
     #if defined(ENABLE_OFFSCREEN_RENDERING)
     {
         if (m_n_frames_drawn >= N_FRAMES_TO_RENDER)
@@ -892,8 +909,10 @@ std::vector<VkRect2D> App::get_render_areas(uint32_t in_afr_render_index) const
 
 #endif
 
-void App::init()
+void App::init(uint32_t in_n_bench_frames)
 {
+    m_n_bench_frames = in_n_bench_frames;
+
     init_vulkan   ();
     init_window   ();
     init_swapchain();
@@ -908,6 +927,16 @@ void App::init()
     init_renderpasses   ();
     init_gfx_pipelines  ();
     init_command_buffers();
+
+    if (m_n_bench_frames > 0)
+    {
+        m_bench_harness_ptr = BenchHarness::create("OutOfOrderRasterization example",
+                                                   m_device_ptr.get(),
+                                                   m_present_queue_ptr,
+                                                   m_n_bench_frames);
+
+        anvil_assert(m_bench_harness_ptr != nullptr);
+    }
 }
 
 void App::init_buffers()
@@ -2123,15 +2152,21 @@ void App::init_swapchain()
 void App::init_window()
 {
     #ifdef ENABLE_OFFSCREEN_RENDERING
-        const Anvil::WindowPlatform platform = Anvil::WINDOW_PLATFORM_DUMMY_WITH_PNG_SNAPSHOTS;
+        Anvil::WindowPlatform platform = Anvil::WINDOW_PLATFORM_DUMMY_WITH_PNG_SNAPSHOTS;
     #else
         #ifdef _WIN32
-            const Anvil::WindowPlatform platform = Anvil::WINDOW_PLATFORM_SYSTEM;
+            Anvil::WindowPlatform platform = Anvil::WINDOW_PLATFORM_SYSTEM;
         #else
-            const Anvil::WindowPlatform platform = Anvil::WINDOW_PLATFORM_XCB;
+            Anvil::WindowPlatform platform = Anvil::WINDOW_PLATFORM_XCB;
         #endif
     #endif
 
+    if (m_n_bench_frames > 0)
+    {
+        /* Benchmark mode renders offscreen, so that WSI does not skew the results. */
+        platform = Anvil::WINDOW_PLATFORM_DUMMY;
+    }
+
     /* Create a window */
     m_window_ptr = Anvil::WindowFactory::create_window(platform,
                                                        "OutOfOrderRasterization example",
@@ -2251,6 +2286,7 @@ void App::on_validation_callback(Anvil::DebugMessageSeverityFlags in_severity,
 void App::run()
 {
     #ifndef ENABLE_OFFSCREEN_RENDERING
+    if (m_bench_harness_ptr == nullptr)
     {
         printf("While focused on the window, press:\n"
                "\n"
@@ -2261,12 +2297,25 @@ void App::run()
     #endif
 
     m_window_ptr->run();
+
+    if (m_bench_harness_ptr != nullptr)
+    {
+        m_bench_harness_ptr->report();
+    }
 }
 
 void App::update_fps()
 {
     uint64_t average_delta = 0;
 
+    if (m_bench_harness_ptr != nullptr)
+    {
+        /* Benchmark mode prints its own results. Keep stdout machine-readable. */
+        m_timestamp_deltas.clear();
+
+        return;
+    }
+
     /* Compute average delta from all the samples we have cached so far */
     for (uint64_t delta : m_timestamp_deltas)
     {
@@ -2359,9 +2408,17 @@ void App::update_teapot_props(uint32_t n_current_swapchain_image)
 
 int main(int argc, char *argv[])
 {
-    std::unique_ptr<App> app_ptr(new App() );
+    std::unique_ptr<App> app_ptr       (new App() );
+    uint32_t             n_bench_frames(0);
+
+    if (!BenchHarness::parse_command_line(argc,
+                                          argv,
+                                         &n_bench_frames) )
+    {
+        return 1;
+    }
 
-    app_ptr->init();
+    app_ptr->init(n_bench_frames);
 
 
     app_ptr->run();
@@ -65,6 +65,7 @@
 #include "wrappers/semaphore.h"
 #include "wrappers/shader_module.h"
 #include "wrappers/swapchain.h"
+#include "bench_harness.h"
 #include "app.h"
 
 
@@ -207,7 +208,8 @@ static const uint32_t g_mesh_data_position_stride       = sizeof(float) * 7;
 
 
 App::App()
-    :m_n_last_semaphore_used           (0),
+    :m_n_bench_frames                  (0),
+     m_n_last_semaphore_used           (0),
      m_n_swapchain_images              (N_SWAPCHAIN_IMAGES),
      m_ub_data_size_per_swapchain_image(0)
 {
@@ -225,6 +227,8 @@ void App::deinit()
 
     Anvil::Vulkan::vkDeviceWaitIdle(m_device_ptr->get_device_vk() );
 
+    m_bench_harness_ptr.reset();
+
     if (m_pipeline_id != UINT32_MAX)
     {
         gfx_pipeline_manager_ptr->delete_pipeline(m_pipeline_id);
@@ -269,6 +273,11 @@ void App::draw_frame()
     Anvil::Semaphore*               present_wait_semaphore_ptr      = nullptr;
     const Anvil::PipelineStageFlags wait_stage_mask                 = Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT;
 
+    if (m_bench_harness_ptr != nullptr)
+    {
+        m_bench_harness_ptr->on_frame_started();
+    }
+
     /* Determine the signal + wait semaphores to use for drawing this frame */
     m_n_last_semaphore_used = (m_n_last_semaphore_used + 1) % m_n_swapchain_images;
 
@@ -315,6 +324,14 @@ void App::draw_frame()
 
     ++n_frames_rendered;
 
+    if (m_bench_harness_ptr != nullptr)
+    {
+        if (m_bench_harness_ptr->on_frame_finished() )
+        {
+            m_window_ptr->close();
+        }
+    }
+
     #if defined(ENABLE_OFFSCREEN_RENDERING)
     {
         if (n_frames_rendered >= N_FRAMES_TO_RENDER)
@@ -397,8 +414,10 @@ uint32_t App::get_mesh_n_vertices() const
     return g_mesh_data_n_vertices;
 }
 
-void App::init()
+void App::init(uint32_t in_n_bench_frames)
 {
+    m_n_bench_frames = in_n_bench_frames;
+
     init_vulkan   ();
     init_window   ();
     init_swapchain();
@@ -411,6 +430,16 @@ void App::init()
 
     init_gfx_pipelines  ();
     init_command_buffers();
+
+    if (m_n_bench_frames > 0)
+    {
+        m_bench_harness_ptr = BenchHarness::create(APP_NAME,
+                                                   m_device_ptr.get(),
+                                                   m_device_ptr->get_universal_queue(0),
+                                                   m_n_bench_frames);
+
+        anvil_assert(m_bench_harness_ptr != nullptr);
+    }
 }
 
 void App::init_buffers()
@@ -890,15 +919,21 @@ void App::init_swapchain()
 void App::init_window()
 {
     #ifdef ENABLE_OFFSCREEN_RENDERING
-        const Anvil::WindowPlatform platform = Anvil::WINDOW_PLATFORM_DUMMY_WITH_PNG_SNAPSHOTS;
+        Anvil::WindowPlatform platform = Anvil::WINDOW_PLATFORM_DUMMY_WITH_PNG_SNAPSHOTS;
     #else
         #ifdef _WIN32
-            const Anvil::WindowPlatform platform = Anvil::WINDOW_PLATFORM_SYSTEM;
+            Anvil::WindowPlatform platform = Anvil::WINDOW_PLATFORM_SYSTEM;
         #else
-            const Anvil::WindowPlatform platform = Anvil::WINDOW_PLATFORM_XCB;
+            Anvil::WindowPlatform platform = Anvil::WINDOW_PLATFORM_XCB;
         #endif
     #endif
 
+    if (m_n_bench_frames > 0)
+    {
+        /* Benchmark mode renders offscreen, so that WSI does not skew the results. */
+        platform = Anvil::WINDOW_PLATFORM_DUMMY;
+    }
+
     /* Create a window */
     m_window_ptr = Anvil::WindowFactory::create_window(platform,
                                                        APP_NAME,
@@ -958,6 +993,11 @@ void App::on_validation_callback(Anvil::DebugMessageSeverityFlags in_severity,
 void App::run()
 {
     m_window_ptr->run();
+
+    if (m_bench_harness_ptr != nullptr)
+    {
+        m_bench_harness_ptr->report();
+    }
 }
 
 /** Updates the buffer memory, which holds position, rotation and size data for all triangles. */
@@ -1001,9 +1041,17 @@ void App::update_data_ub_contents(uint32_t in_n_swapchain_image)
 
 int main(int argc, char *argv[])
 {
-    std::unique_ptr<App> app_ptr(new App() );
+    std::unique_ptr<App> app_ptr       (new App() );
+    uint32_t             n_bench_frames(0);
+
+    if (!BenchHarness::parse_command_line(argc,
+                                          argv,
+                                         &n_bench_frames) )
+    {
+        return 1;
+    }
 
-    app_ptr->init();
+    app_ptr->init(n_bench_frames);
     app_ptr->run();
 
     #ifdef _DEBUG
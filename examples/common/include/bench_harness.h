@@ -0,0 +1,147 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements the headless benchmark mode shared by all examples.
+ *
+ *  When an example is started with "--bench N", it renders N frames to a dummy window (no WSI involved) and
+ *  prints a single line of JSON to stdout before leaving. The line holds:
+ *
+ *  - CPU frame times: time spent in the app's draw_frame(), from the start of the frame to its last submission.
+ *  - GPU frame times: time between two timestamps written before and after the frame's submissions, on the
+ *                     queue the app submits to. Reported as null if the queue does not support timestamps.
+ *  - Per-frame Anvil::PerfCounters deltas: queue submissions, descriptor set updates, pipeline binds and bytes
+ *                     uploaded by the host. The harness' own timestamp submissions are not included.
+ *
+ *  Frame times are reported in milliseconds as min, mean, median, 95th percentile and max.
+ *
+ *  Apps call on_frame_started() at the very beginning of each frame, and on_frame_finished() after the frame's
+ *  last submission. The latter returns true once the requested number of frames has been rendered, at which point
+ *  the app should close its window, and call report() after the window's run() returns.
+ *
+ *  BenchHarness is NOT thread-safe.
+ */
+#ifndef EXAMPLES_BENCH_HARNESS_H
+#define EXAMPLES_BENCH_HARNESS_H
+
+#include "misc/perf_counters.h"
+#include "misc/time.h"
+#include "misc/types.h"
+#include <memory>
+#include <vector>
+
+
+class BenchHarness
+{
+public:
+    /* Public functions */
+
+    /** Creates a new benchmark harness instance.
+     *
+     *  @param in_app_name     Name of the app, included in the report.
+     *  @param in_device_ptr   Device the app renders with. Must not be null.
+     *  @param in_queue_ptr    Queue the app submits its frames to. Must not be null.
+     *  @param in_n_frames     Number of frames to render. Must not be 0.
+     *
+     *  @return New instance if successful, null otherwise.
+     */
+    static std::unique_ptr<BenchHarness> create(const char*              in_app_name,
+                                                const Anvil::BaseDevice* in_device_ptr,
+                                                Anvil::Queue*            in_queue_ptr,
+                                                uint32_t                 in_n_frames);
+
+    /** Looks for "--bench N" in the command line.
+     *
+     *  @param argc                   Number of command line arguments, as passed to main().
+     *  @param argv                   Command line arguments, as passed to main().
+     *  @param out_n_bench_frames_ptr Deref will be set to N if "--bench N" has been specified, or to 0 otherwise.
+     *                                Must not be null.
+     *
+     *  @return false if the command line is malformed, true otherwise.
+     */
+    static bool parse_command_line(int       argc,
+                                   char*     argv[],
+                                   uint32_t* out_n_bench_frames_ptr);
+
+    /** Destructor. Waits until all frames in flight have been executed. */
+    ~BenchHarness();
+
+    /** Marks the end of a frame. Must be called after the frame's last submission.
+     *
+     *  @return true if all requested frames have been rendered, false otherwise.
+     */
+    bool on_frame_finished();
+
+    /** Marks the start of a frame. Must be called before the frame's first submission. */
+    void on_frame_started();
+
+    /** Waits until all frames have been executed and prints the results to stdout, as a single line of JSON. */
+    void report();
+
+private:
+    /* Private type definitions */
+    typedef struct FrameSlot
+    {
+        Anvil::PrimaryCommandBufferUniquePtr begin_cmd_buffer_ptr;
+        Anvil::PrimaryCommandBufferUniquePtr end_cmd_buffer_ptr;
+        Anvil::FenceUniquePtr                fence_ptr;
+        bool                                 is_pending;
+
+        FrameSlot()
+            :is_pending(false)
+        {
+            /* Stub */
+        }
+    } FrameSlot;
+
+    /* Private functions */
+    BenchHarness(const char*              in_app_name,
+                 const Anvil::BaseDevice* in_device_ptr,
+                 Anvil::Queue*            in_queue_ptr,
+                 uint32_t                 in_n_frames);
+
+    BenchHarness           (const BenchHarness&);
+    BenchHarness& operator=(const BenchHarness&);
+
+    bool init             ();
+    void retire_frame_slot(FrameSlot* in_frame_slot_ptr);
+
+    static void print_frame_times(const char*            in_name,
+                                  std::vector<uint64_t>* in_frame_times_nsec_ptr);
+
+    /* Private variables */
+    const char*                 m_app_name;
+    Anvil::PerfCountersSnapshot m_counters;
+    std::vector<uint64_t>       m_cpu_frame_times_nsec;
+    uint64_t                    m_current_frame_start_time;
+    const Anvil::BaseDevice*    m_device_ptr;
+    std::vector<FrameSlot>      m_frame_slots;
+    std::vector<uint64_t>       m_gpu_frame_times_nsec;
+    uint32_t                    m_n_frames;
+    uint32_t                    m_n_frames_started;
+    Anvil::QueryPoolUniquePtr   m_query_pool_ptr;
+    Anvil::Queue*               m_queue_ptr;
+    Anvil::Time                 m_time;
+    double                      m_timestamp_period;
+};
+
+#endif /* EXAMPLES_BENCH_HARNESS_H */
@@ -0,0 +1,380 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "misc/debug.h"
+#include "misc/fence_create_info.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/command_pool.h"
+#include "wrappers/device.h"
+#include "wrappers/fence.h"
+#include "wrappers/physical_device.h"
+#include "wrappers/query_pool.h"
+#include "wrappers/queue.h"
+#include "bench_harness.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/* Number of frames whose GPU timestamps can be in flight at any given time. */
+static const uint32_t g_n_frame_slots = 3;
+
+
+/** Please see header for specification */
+BenchHarness::BenchHarness(const char*              in_app_name,
+                           const Anvil::BaseDevice* in_device_ptr,
+                           Anvil::Queue*            in_queue_ptr,
+                           uint32_t                 in_n_frames)
+    :m_app_name                (in_app_name),
+     m_current_frame_start_time(0),
+     m_device_ptr              (in_device_ptr),
+     m_n_frames                (in_n_frames),
+     m_n_frames_started        (0),
+     m_queue_ptr               (in_queue_ptr),
+     m_timestamp_period        (1.0)
+{
+    m_cpu_frame_times_nsec.reserve(in_n_frames);
+    m_gpu_frame_times_nsec.reserve(in_n_frames);
+}
+
+/** Please see header for specification */
+BenchHarness::~BenchHarness()
+{
+    for (auto& current_frame_slot : m_frame_slots)
+    {
+        if (current_frame_slot.is_pending)
+        {
+            retire_frame_slot(&current_frame_slot);
+        }
+    }
+}
+
+/** Please see header for specification */
+std::unique_ptr<BenchHarness> BenchHarness::create(const char*              in_app_name,
+                                                   const Anvil::BaseDevice* in_device_ptr,
+                                                   Anvil::Queue*            in_queue_ptr,
+                                                   uint32_t                 in_n_frames)
+{
+    std::unique_ptr<BenchHarness> result_ptr;
+
+    anvil_assert(in_device_ptr != nullptr);
+    anvil_assert(in_n_frames   != 0);
+    anvil_assert(in_queue_ptr  != nullptr);
+
+    result_ptr.reset(
+        new BenchHarness(in_app_name,
+                         in_device_ptr,
+                         in_queue_ptr,
+                         in_n_frames)
+    );
+
+    if (!result_ptr->init() )
+    {
+        result_ptr.reset();
+    }
+
+    return result_ptr;
+}
+
+/** Prerecords the command buffers which write the per-frame timestamps, if the device supports
+ *  timestamp queries on graphics & compute queues.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool BenchHarness::init()
+{
+    Anvil::CommandPool* cmd_pool_ptr = m_device_ptr->get_command_pool_for_queue_family_index(m_queue_ptr->get_queue_family_index() );
+    const auto&         limits       = m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits;
+    bool                result       = false;
+
+    if (!limits.timestamp_compute_and_graphics)
+    {
+        /* GPU frame times are going to be reported as null. */
+        result = true;
+
+        goto end;
+    }
+
+    m_query_pool_ptr = Anvil::QueryPool::create_non_ps_query_pool(m_device_ptr,
+                                                                  VK_QUERY_TYPE_TIMESTAMP,
+                                                                  g_n_frame_slots * 2);
+
+    if (m_query_pool_ptr == nullptr)
+    {
+        anvil_assert(m_query_pool_ptr != nullptr);
+
+        goto end;
+    }
+
+    m_frame_slots.resize(g_n_frame_slots);
+    m_timestamp_period = static_cast<double>(limits.timestamp_period);
+
+    for (uint32_t n_frame_slot = 0;
+                  n_frame_slot < g_n_frame_slots;
+                ++n_frame_slot)
+    {
+        auto&                   current_frame_slot = m_frame_slots.at(n_frame_slot);
+        const Anvil::QueryIndex start_query_index  = n_frame_slot * 2;
+
+        current_frame_slot.begin_cmd_buffer_ptr = cmd_pool_ptr->alloc_primary_level_command_buffer();
+        current_frame_slot.end_cmd_buffer_ptr   = cmd_pool_ptr->alloc_primary_level_command_buffer();
+        current_frame_slot.fence_ptr            = Anvil::Fence::create(Anvil::FenceCreateInfo::create(m_device_ptr,
+                                                                                                      false) ); /* in_create_signalled */
+
+        if (current_frame_slot.begin_cmd_buffer_ptr == nullptr ||
+            current_frame_slot.end_cmd_buffer_ptr   == nullptr ||
+            current_frame_slot.fence_ptr            == nullptr)
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        current_frame_slot.begin_cmd_buffer_ptr->start_recording(false,  /* one_time_submit          */
+                                                                 false); /* simultaneous_use_allowed */
+        {
+            current_frame_slot.begin_cmd_buffer_ptr->record_reset_query_pool(m_query_pool_ptr.get(),
+                                                                             start_query_index,
+                                                                             2); /* in_query_count */
+            current_frame_slot.begin_cmd_buffer_ptr->record_write_timestamp (Anvil::PipelineStageFlagBits::TOP_OF_PIPE_BIT,
+                                                                             m_query_pool_ptr.get(),
+                                                                             start_query_index);
+        }
+        current_frame_slot.begin_cmd_buffer_ptr->stop_recording();
+
+        current_frame_slot.end_cmd_buffer_ptr->start_recording(false,  /* one_time_submit          */
+                                                               false); /* simultaneous_use_allowed */
+        {
+            current_frame_slot.end_cmd_buffer_ptr->record_write_timestamp(Anvil::PipelineStageFlagBits::BOTTOM_OF_PIPE_BIT,
+                                                                          m_query_pool_ptr.get(),
+                                                                          start_query_index + 1);
+        }
+        current_frame_slot.end_cmd_buffer_ptr->stop_recording();
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool BenchHarness::on_frame_finished()
+{
+    const uint64_t current_frame_end_time = Anvil::Time::get_raw_host_timestamp();
+    const auto     frame_counters         = Anvil::PerfCounters::get_snapshot(true); /* in_should_reset */
+
+    m_cpu_frame_times_nsec.push_back(m_time.convert_raw_host_timestamp_to_nsec(current_frame_end_time) -
+                                     m_time.convert_raw_host_timestamp_to_nsec(m_current_frame_start_time) );
+
+    m_counters.n_descriptor_set_updates += frame_counters.n_descriptor_set_updates;
+    m_counters.n_pipeline_binds         += frame_counters.n_pipeline_binds;
+    m_counters.n_queue_submissions      += frame_counters.n_queue_submissions;
+    m_counters.n_uploaded_bytes         += frame_counters.n_uploaded_bytes;
+
+    if (!m_frame_slots.empty() )
+    {
+        auto& current_frame_slot = m_frame_slots.at((m_n_frames_started - 1) % g_n_frame_slots);
+
+        m_queue_ptr->submit(
+            Anvil::SubmitInfo::create_execute(current_frame_slot.end_cmd_buffer_ptr.get(),
+                                              false, /* should_block */
+                                              current_frame_slot.fence_ptr.get() )
+        );
+
+        current_frame_slot.is_pending = true;
+    }
+
+    return (m_n_frames_started >= m_n_frames);
+}
+
+/** Please see header for specification */
+void BenchHarness::on_frame_started()
+{
+    if (!m_frame_slots.empty() )
+    {
+        auto& current_frame_slot = m_frame_slots.at(m_n_frames_started % g_n_frame_slots);
+
+        /* Throttles the app to g_n_frame_slots frames in flight, which is what the swapchain would have
+         * done, had the app been rendering to a window. */
+        if (current_frame_slot.is_pending)
+        {
+            retire_frame_slot(&current_frame_slot);
+        }
+
+        m_queue_ptr->submit(
+            Anvil::SubmitInfo::create_execute(current_frame_slot.begin_cmd_buffer_ptr.get(),
+                                              false) /* should_block */
+        );
+    }
+
+    /* Drop whatever has been counted in-between frames, including the submission above. */
+    Anvil::PerfCounters::get_snapshot(true); /* in_should_reset */
+
+    m_current_frame_start_time = Anvil::Time::get_raw_host_timestamp();
+
+    ++m_n_frames_started;
+}
+
+/** Please see header for specification */
+bool BenchHarness::parse_command_line(int       argc,
+                                      char*     argv[],
+                                      uint32_t* out_n_bench_frames_ptr)
+{
+    bool result = true;
+
+    *out_n_bench_frames_ptr = 0;
+
+    for (int n_arg = 1;
+             n_arg < argc;
+           ++n_arg)
+    {
+        if (strcmp(argv[n_arg],
+                   "--bench") != 0)
+        {
+            continue;
+        }
+
+        if (n_arg + 1 >= argc           ||
+            atoi(argv[n_arg + 1]) <= 0)
+        {
+            fprintf(stderr,
+                    "Usage: %s [--bench <number of frames to render>]\n",
+                    argv[0]);
+
+            result = false;
+            goto end;
+        }
+
+        *out_n_bench_frames_ptr = static_cast<uint32_t>(atoi(argv[n_arg + 1]) );
+        ++n_arg;
+    }
+
+end:
+    return result;
+}
+
+/** Prints min, mean, median, 95th percentile and max of the specified frame times, as a JSON object
+ *  with values expressed in milliseconds. Sorts the frame times in the process. */
+void BenchHarness::print_frame_times(const char*            in_name,
+                                     std::vector<uint64_t>* in_frame_times_nsec_ptr)
+{
+    const size_t n_frame_times = in_frame_times_nsec_ptr->size();
+    uint64_t     sum_nsec      = 0;
+
+    if (n_frame_times == 0)
+    {
+        printf(",\"%s\":null",
+               in_name);
+
+        return;
+    }
+
+    std::sort(in_frame_times_nsec_ptr->begin(),
+              in_frame_times_nsec_ptr->end  () );
+
+    for (const auto& current_frame_time_nsec : *in_frame_times_nsec_ptr)
+    {
+        sum_nsec += current_frame_time_nsec;
+    }
+
+    printf(",\"%s\":{\"min\":%.4f,\"mean\":%.4f,\"median\":%.4f,\"p95\":%.4f,\"max\":%.4f}",
+           in_name,
+           double(in_frame_times_nsec_ptr->front() )                            / 1e6,
+           double(sum_nsec) / double(n_frame_times)                             / 1e6,
+           double(in_frame_times_nsec_ptr->at(n_frame_times / 2) )              / 1e6,
+           double(in_frame_times_nsec_ptr->at((n_frame_times - 1) * 95 / 100) ) / 1e6,
+           double(in_frame_times_nsec_ptr->back() )                             / 1e6);
+}
+
+/** Please see header for specification */
+void BenchHarness::report()
+{
+    const uint32_t n_frames_rendered = static_cast<uint32_t>(m_cpu_frame_times_nsec.size() );
+    const double   n_frames_divisor  = (n_frames_rendered > 0) ? double(n_frames_rendered)
+                                                               : 1.0;
+
+    for (auto& current_frame_slot : m_frame_slots)
+    {
+        if (current_frame_slot.is_pending)
+        {
+            retire_frame_slot(&current_frame_slot);
+        }
+    }
+
+    printf("{\"app\":\"%s\",\"device\":\"%s\",\"n_frames\":%u",
+           m_app_name,
+           m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->device_name,
+           n_frames_rendered);
+
+    print_frame_times("cpu_frame_time_ms",
+                     &m_cpu_frame_times_nsec);
+    print_frame_times("gpu_frame_time_ms",
+                     &m_gpu_frame_times_nsec);
+
+    printf(",\"n_queue_submissions\":%" PRIu64 ",\"n_queue_submissions_per_frame\":%.2f"
+           ",\"n_descriptor_set_updates_per_frame\":%.2f"
+           ",\"n_pipeline_binds_per_frame\":%.2f"
+           ",\"n_uploaded_bytes_per_frame\":%.1f}\n",
+           m_counters.n_queue_submissions,
+           double(m_counters.n_queue_submissions)      / n_frames_divisor,
+           double(m_counters.n_descriptor_set_updates) / n_frames_divisor,
+           double(m_counters.n_pipeline_binds)         / n_frames_divisor,
+           double(m_counters.n_uploaded_bytes)         / n_frames_divisor);
+
+    fflush(stdout);
+}
+
+/** Waits until the frame which last used @param in_frame_slot_ptr has been executed, and stores its GPU frame time.
+ *
+ *  @param in_frame_slot_ptr Frame slot to retire. Must be pending. Must not be null.
+ */
+void BenchHarness::retire_frame_slot(FrameSlot* in_frame_slot_ptr)
+{
+    Anvil::Fence*           fence_ptr             = in_frame_slot_ptr->fence_ptr.get();
+    const Anvil::QueryIndex start_query_index     = static_cast<Anvil::QueryIndex>(in_frame_slot_ptr - &m_frame_slots.at(0) ) * 2;
+    bool                    all_results_retrieved = false;
+    uint64_t                timestamps[2]         = {0, 0};
+
+    anvil_assert(in_frame_slot_ptr->is_pending);
+
+    Anvil::Fence::wait_fences(1, /* in_n_fences */
+                             &fence_ptr);
+
+    fence_ptr->reset();
+
+    if (m_query_pool_ptr->get_query_pool_results(start_query_index,
+                                                 2, /* in_n_queries */
+                                                 Anvil::QueryResultFlagBits::WAIT_BIT,
+                                                 timestamps,
+                                                &all_results_retrieved) &&
+        all_results_retrieved)
+    {
+        const uint64_t n_ticks = (timestamps[1] > timestamps[0]) ? timestamps[1] - timestamps[0]
+                                                                 : 0;
+
+        m_gpu_frame_times_nsec.push_back(static_cast<uint64_t>(static_cast<double>(n_ticks) * m_timestamp_period) );
+    }
+
+    in_frame_slot_ptr->is_pending = false;
+}
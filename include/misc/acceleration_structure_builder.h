@@ -0,0 +1,228 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a builder which records many acceleration structure builds with as few
+ *  vkCmdBuildAccelerationStructuresKHR() calls as possible, and optionally compacts the results.
+ *
+ *  Builds are registered with add_build(). Each call queries the build sizes and creates the destination
+ *  acceleration structure right away, so that its device address can be used (for instance, to fill top-level
+ *  instance data) before any commands are recorded.
+ *
+ *  record_builds() records all pending builds. Bottom-level builds are recorded before top-level ones. Builds are
+ *  packed greedily into batches whose total scratch size fits in the scratch budget. Each batch is issued with
+ *  a single vkCmdBuildAccelerationStructuresKHR() call, with every build of a batch using a separate region of
+ *  a single pooled scratch buffer. Batches are separated by acceleration structure build barriers, so that the
+ *  scratch buffer can be reused, and so that top-level builds can see the bottom-level structures.
+ *
+ *  Builds which specify BuildAccelerationStructureFlagBits::ALLOW_COMPACTION_BIT have their compacted sizes
+ *  written to a query pool at the end of record_builds(). Once the command buffer has been submitted,
+ *  record_compaction() reads the sizes back, creates smaller acceleration structures and records
+ *  compacting copies into them. The originals are retired, and must be released with release_retired_resources()
+ *  after the GPU has finished executing the copies. Since compaction changes the acceleration structure handle
+ *  and its device address, top-level builds referencing compacted bottom-level structures should only be added
+ *  after record_compaction() has been called.
+ *
+ *  All acceleration structures and scratch buffers take their memory from the memory allocator specified at
+ *  creation time.
+ *
+ *  Requires VK_KHR_acceleration_structure and VK_KHR_buffer_device_address extensions.
+ *
+ *  Acceleration structure builder is NOT thread-safe, unless created with @param in_mt_safe set to true.
+ */
+#ifndef MISC_ACCELERATION_STRUCTURE_BUILDER_H
+#define MISC_ACCELERATION_STRUCTURE_BUILDER_H
+
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class AccelerationStructureBuilder : public MTSafetySupportProvider
+    {
+    public:
+        /* Public type definitions */
+        typedef uint32_t BuildID;
+
+        /* Public functions */
+
+        /** Creates a new acceleration structure builder instance.
+         *
+         *  @param in_device_ptr             Device to create the builder for. Must not be null.
+         *  @param in_memory_allocator_ptr   Memory allocator to take acceleration structure and scratch memory
+         *                                   from. Must not be null.
+         *  @param in_max_batch_scratch_size Maximum number of scratch bytes a single batch of builds may use.
+         *                                   Builds which need more scratch memory on their own are recorded
+         *                                   in a separate batch.
+         *  @param in_mt_safe                True if the instance should be thread-safe.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::AccelerationStructureBuilderUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
+                                                                   Anvil::MemoryAllocator*  in_memory_allocator_ptr,
+                                                                   VkDeviceSize             in_max_batch_scratch_size = 64 * 1024 * 1024,
+                                                                   bool                     in_mt_safe                = false);
+
+        /** Destructor. The caller must make sure none of the acceleration structures or scratch buffers is still
+         *  accessed by the GPU. */
+        ~AccelerationStructureBuilder();
+
+        /** Registers a new build and creates the acceleration structure it is going to write to.
+         *
+         *  Geometry descriptors and build ranges are copied, but any device memory they refer to must stay valid
+         *  until the build has been executed by the GPU.
+         *
+         *  @param in_type             Type of the acceleration structure to build.
+         *  @param in_n_geometries     Number of geometries. Must not be 0.
+         *  @param in_geometries_ptr   Array of @param in_n_geometries geometry descriptors.
+         *  @param in_build_ranges_ptr Array of @param in_n_geometries build ranges, one per geometry.
+         *  @param in_flags            Build flags. Specify ALLOW_COMPACTION_BIT to make the build eligible for
+         *                             compaction.
+         *  @param out_build_id_ptr    Deref will be set to the ID of the build if the call succeeds. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool add_build(Anvil::AccelerationStructureType                in_type,
+                       uint32_t                                        in_n_geometries,
+                       const VkAccelerationStructureGeometryKHR*       in_geometries_ptr,
+                       const VkAccelerationStructureBuildRangeInfoKHR* in_build_ranges_ptr,
+                       Anvil::BuildAccelerationStructureFlags          in_flags,
+                       BuildID*                                        out_build_id_ptr);
+
+        /** Returns the acceleration structure a build writes to, or null if the ID is invalid or the structure has
+         *  been released with release_acceleration_structure().
+         *
+         *  The returned pointer changes when the build is compacted.
+         */
+        Anvil::AccelerationStructure* get_acceleration_structure(BuildID in_build_id) const;
+
+        /** Returns the size of the pooled scratch buffer, or 0 if it has not been created yet. */
+        VkDeviceSize get_scratch_buffer_size() const;
+
+        /** Records all pending builds, followed by a barrier which makes the results visible to all subsequent
+         *  commands. If any of the builds allows compaction, commands which write compacted sizes to a query pool
+         *  are also recorded.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the commands to. Must be in the recording state and
+         *                           must not have a renderpass active.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_builds(Anvil::CommandBufferBase* in_cmd_buffer_ptr);
+
+        /** Records compacting copies for all builds whose compacted sizes have been queried by record_builds().
+         *
+         *  Must only be called after the command buffer record_builds() was recorded to has been submitted. The call
+         *  blocks until the compacted sizes become available. Builds whose compacted size is not smaller than their
+         *  original size are left intact.
+         *
+         *  @param in_cmd_buffer_ptr          Command buffer to record the commands to. Must be in the recording state
+         *                                    and must not have a renderpass active.
+         *  @param out_opt_n_bytes_saved_ptr  If not null, deref will be set to the number of acceleration structure
+         *                                    bytes the compaction is going to free.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_compaction(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                               VkDeviceSize*             out_opt_n_bytes_saved_ptr = nullptr);
+
+        /** Transfers ownership of a build's acceleration structure to the caller. The build ID becomes invalid.
+         *
+         *  The build must not be pending, and must not be awaiting compaction.
+         */
+        Anvil::AccelerationStructureUniquePtr release_acceleration_structure(BuildID in_build_id);
+
+        /** Releases acceleration structures replaced by compacted copies, as well as scratch buffers which have
+         *  been replaced by larger ones. The caller must make sure the GPU is no longer accessing any of them.
+         */
+        void release_retired_resources();
+
+    private:
+        /* Private type definitions */
+        enum class BuildState
+        {
+            PENDING,
+            COMPACTION_PENDING,
+            BUILT,
+            RELEASED
+        };
+
+        typedef struct Build
+        {
+            Anvil::AccelerationStructureUniquePtr                 acceleration_structure_ptr;
+            Anvil::BuildAccelerationStructureFlags                flags;
+            std::vector<VkAccelerationStructureGeometryKHR>       geometries;
+            uint32_t                                              n_query_pool;
+            Anvil::QueryIndex                                     query_index;
+            std::vector<VkAccelerationStructureBuildRangeInfoKHR> ranges;
+            VkDeviceSize                                          scratch_size;
+            BuildState                                            state;
+            Anvil::AccelerationStructureType                      type;
+
+            Build()
+                :acceleration_structure_ptr(nullptr,
+                                            std::default_delete<Anvil::AccelerationStructure>() ),
+                 n_query_pool              (UINT32_MAX),
+                 query_index               (UINT32_MAX),
+                 scratch_size              (0),
+                 state                     (BuildState::PENDING),
+                 type                      (Anvil::AccelerationStructureType::UNKNOWN)
+            {
+                /* Stub */
+            }
+        } Build;
+
+        /* Private functions */
+        AccelerationStructureBuilder(const Anvil::BaseDevice* in_device_ptr,
+                                     Anvil::MemoryAllocator*  in_memory_allocator_ptr,
+                                     VkDeviceSize             in_max_batch_scratch_size,
+                                     bool                     in_mt_safe);
+
+        Anvil::AccelerationStructureUniquePtr create_acceleration_structure(Anvil::AccelerationStructureType in_type,
+                                                                            VkDeviceSize                     in_size) const;
+        bool                                  ensure_scratch_buffer_size   (VkDeviceSize                     in_size);
+        uint32_t                              get_query_pool               (uint32_t                         in_n_queries);
+        bool                                  record_batch                 (Anvil::CommandBufferBase*        in_cmd_buffer_ptr,
+                                                                            const std::vector<Build*>&       in_builds);
+        bool                                  record_barrier               (Anvil::CommandBufferBase*        in_cmd_buffer_ptr,
+                                                                            Anvil::PipelineStageFlags        in_dst_stage_mask,
+                                                                            Anvil::AccessFlags               in_dst_access_mask) const;
+
+        /* Private variables */
+        std::vector<std::unique_ptr<Build> >               m_builds;
+        const Anvil::BaseDevice*                           m_device_ptr;
+        const VkDeviceSize                                 m_max_batch_scratch_size;
+        Anvil::MemoryAllocator*                            m_memory_allocator_ptr;
+        std::vector<Anvil::QueryPoolUniquePtr>             m_query_pools;
+        std::vector<uint32_t>                              m_query_pools_n_used_queries;
+        std::vector<Anvil::AccelerationStructureUniquePtr> m_retired_acceleration_structures;
+        std::vector<Anvil::BufferUniquePtr>                m_retired_scratch_buffers;
+        Anvil::BufferUniquePtr                             m_scratch_buffer_ptr;
+        bool                                               m_scratch_buffer_used;
+        VkDeviceSize                                       m_scratch_buffer_size;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(AccelerationStructureBuilder);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(AccelerationStructureBuilder);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_ACCELERATION_STRUCTURE_BUILDER_H */
@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef MISC_ACCELERATION_STRUCTURE_CREATE_INFO_H
+#define MISC_ACCELERATION_STRUCTURE_CREATE_INFO_H
+
+#include "misc/types.h"
+
+namespace Anvil
+{
+    class AccelerationStructureCreateInfo
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new create info structure for an acceleration structure of the specified type.
+         *
+         *  The acceleration structure is backed by a dedicated storage buffer of @param in_size bytes. Memory for
+         *  the buffer is allocated from @param in_memory_allocator_ptr.
+         *
+         *  NOTE: Unless specified later with a corresponding set_..() invocation, the following parameters are assumed by default:
+         *
+         * - MT safety: Anvil::MTSafety::INHERIT_FROM_PARENT_DEVICE
+         */
+        static Anvil::AccelerationStructureCreateInfoUniquePtr create(const Anvil::BaseDevice*         in_device_ptr,
+                                                                      Anvil::AccelerationStructureType in_type,
+                                                                      VkDeviceSize                     in_size,
+                                                                      Anvil::MemoryAllocator*          in_memory_allocator_ptr);
+
+        const Anvil::BaseDevice* get_device() const
+        {
+            return m_device_ptr;
+        }
+
+        Anvil::MemoryAllocator* get_memory_allocator() const
+        {
+            return m_memory_allocator_ptr;
+        }
+
+        const MTSafety& get_mt_safety() const
+        {
+            return m_mt_safety;
+        }
+
+        const VkDeviceSize& get_size() const
+        {
+            return m_size;
+        }
+
+        const Anvil::AccelerationStructureType& get_type() const
+        {
+            return m_type;
+        }
+
+        void set_mt_safety(const MTSafety& in_mt_safety)
+        {
+            m_mt_safety = in_mt_safety;
+        }
+
+    private:
+        /* Private functions */
+        AccelerationStructureCreateInfo(const Anvil::BaseDevice*         in_device_ptr,
+                                        Anvil::AccelerationStructureType in_type,
+                                        VkDeviceSize                     in_size,
+                                        Anvil::MemoryAllocator*          in_memory_allocator_ptr,
+                                        MTSafety                         in_mt_safety);
+
+        /* Private variables */
+        const Anvil::BaseDevice*         m_device_ptr;
+        Anvil::MemoryAllocator*          m_memory_allocator_ptr;
+        Anvil::MTSafety                  m_mt_safety;
+        VkDeviceSize                     m_size;
+        Anvil::AccelerationStructureType m_type;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(AccelerationStructureCreateInfo);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(AccelerationStructureCreateInfo);
+    };
+
+}; /* namespace Anvil */
+
+#endif /* MISC_ACCELERATION_STRUCTURE_CREATE_INFO_H */
@@ -0,0 +1,141 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a small pool of I/O threads which load files in the background.
+ *
+ *  read_file() and map_file() enqueue a request and return immediately. The request is picked up by the first
+ *  idle I/O thread, so that many files can be loaded in parallel, and the result is handed back to the caller
+ *  with a std::future. Requests are served in enqueue order.
+ *
+ *  Mapping a file with prefetching enabled pages the whole file in on the I/O thread. This is the preferred way
+ *  of loading large assets, as the data is not copied by the process. Without prefetching, pages are brought in
+ *  lazily on first access.
+ *
+ *  Async file reader is thread-safe.
+ */
+#ifndef MISC_ASYNC_FILE_READER_H
+#define MISC_ASYNC_FILE_READER_H
+
+#include "misc/io.h"
+#include "misc/types.h"
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+
+
+namespace Anvil
+{
+    class AsyncFileReader
+    {
+    public:
+        /* Public type definitions */
+
+        /** Result of a read_file() request. */
+        typedef struct ReadResult
+        {
+            /* File contents. Null if the request failed. */
+            std::unique_ptr<char[]> data_ptr;
+
+            /* Number of bytes exposed under data_ptr */
+            size_t size;
+
+            ReadResult()
+                :size(0)
+            {
+                /* Stub */
+            }
+
+            ReadResult(ReadResult&& in_result)
+                :data_ptr(std::move(in_result.data_ptr) ),
+                 size    (in_result.size)
+            {
+                /* Stub */
+            }
+        } ReadResult;
+
+        /* Public functions */
+
+        /** Creates a new async file reader instance and spawns its I/O threads.
+         *
+         *  @param in_n_threads Number of I/O threads to use. If 0, the number is derived from the number of
+         *                      available hardware threads, and capped at 4.
+         *
+         *  @return New instance.
+         */
+        static Anvil::AsyncFileReaderUniquePtr create(uint32_t in_n_threads = 0);
+
+        /** Destructor. Serves all pending requests and joins the I/O threads. */
+        ~AsyncFileReader();
+
+        /** Returns the number of I/O threads used by the reader. */
+        uint32_t get_n_threads() const
+        {
+            return static_cast<uint32_t>(m_threads.size() );
+        }
+
+        /** Enqueues a request to map the specified file.
+         *
+         *  @param in_should_prefetch True if the I/O thread should page the whole file in before completing
+         *                            the request. See MappedFile::prefetch().
+         *
+         *  @return Future which is going to hold the mapping, or null if the file could not be mapped.
+         */
+        std::future<Anvil::MappedFileUniquePtr> map_file(const std::string& in_filename,
+                                                         bool               in_should_prefetch = true);
+
+        /** Enqueues a request to read contents of the specified file into a new buffer.
+         *
+         *  Arguments are as per IO::read_file().
+         *
+         *  @return Future which is going to hold the read data.
+         */
+        std::future<ReadResult> read_file(const std::string& in_filename,
+                                          bool               in_is_text_file);
+
+        /** Blocks until all requests enqueued prior to this call have been served. */
+        void wait_idle();
+
+    private:
+        /* Private functions */
+        AsyncFileReader(uint32_t in_n_threads);
+
+        void enqueue    (std::function<void()> in_request);
+        void thread_main();
+
+        /* Private variables */
+        uint32_t                           m_n_busy_threads;
+        std::deque<std::function<void()> > m_requests;
+        bool                               m_should_quit;
+        std::vector<std::thread>           m_threads;
+
+        std::condition_variable            m_idle_cv;
+        std::mutex                         m_mutex;
+        std::condition_variable            m_wake_cv;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(AsyncFileReader);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(AsyncFileReader);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_ASYNC_FILE_READER_H */
@@ -0,0 +1,143 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements a device-level scheduler for frame-budgeted background work.
+ *
+ *  Work which is not time-critical, eg. incremental defragmentation, pipeline compilation, deferred deletion or
+ *  cache flushing, registers with the scheduler as a resumable micro-task: a function which performs a small step
+ *  of the work each time it is called and tells whether there is more to do. The application calls run() once
+ *  per frame (usually through BaseDevice::run_background_work() ) with the time budget it can spare. Tasks are
+ *  stepped in round-robin order until the budget is used up, so no single long-running task can starve the others,
+ *  and no frame ever spends more than one step's worth of time over the budget.
+ *
+ *  Each step is passed the time left in the budget, so tasks which can size their work (eg.
+ *  MemoryAllocator::defragment() ) should aim to finish within it.
+ *
+ *  Time is measured with Anvil::Time.
+ *
+ *  Tasks may be added and cancelled from any thread, including from within a step. run() must not be called
+ *  from more than one thread at a time, and must not be called from within a step.
+ *
+ *  This object should ONLY be instantiated by Anvil::BaseDevice.
+ */
+#ifndef MISC_BACKGROUND_WORK_SCHEDULER_H
+#define MISC_BACKGROUND_WORK_SCHEDULER_H
+
+#include "misc/time.h"
+#include "misc/types.h"
+#include <deque>
+#include <mutex>
+
+
+namespace Anvil
+{
+    class BackgroundWorkScheduler
+    {
+    public:
+        /* Public type definitions */
+
+        /** Micro-task prototype.
+         *
+         *  @param in_time_left_nsec Time left in the current budget, in nanoseconds. Always larger than 0.
+         *
+         *  @return true if the task has more work to do and should be stepped again, false if it has finished.
+         */
+        typedef std::function<bool(uint64_t in_time_left_nsec)> MicroTask;
+
+        /* Public functions */
+
+        /** Creates a new background work scheduler instance. */
+        static Anvil::BackgroundWorkSchedulerUniquePtr create();
+
+        /** Destructor. Tasks which are still pending are dropped without being stepped. */
+        ~BackgroundWorkScheduler();
+
+        /** Registers a new micro-task. The task is stepped for the first time during the next run() call.
+         *
+         *  @param in_task Task to register. Must not be null.
+         *  @param in_name Name of the task, used for debugging purposes. May be empty.
+         *
+         *  @return ID which can be passed to cancel().
+         */
+        uint64_t add_task(const MicroTask&   in_task,
+                          const std::string& in_name = std::string() );
+
+        /** Unregisters a pending task. The task is not going to be stepped again. If the task is being stepped
+         *  at call time, the step is allowed to finish.
+         *
+         *  @return true if the task was pending, false if it has already finished or the ID is unknown.
+         */
+        bool cancel(const uint64_t& in_task_id);
+
+        /** Returns the number of tasks which have not finished yet. */
+        uint32_t get_n_pending_tasks() const;
+
+        /** Returns names of pending tasks, in the order they are going to be stepped in. */
+        std::vector<std::string> get_pending_task_names() const;
+
+        /** Steps pending tasks in round-robin order until @param in_budget_usec microseconds pass or all tasks
+         *  finish. A step is never interrupted, so the call may exceed the budget by the duration of the last step.
+         *
+         *  @param in_budget_usec     Time budget, in microseconds. If 0, the function returns immediately.
+         *  @param out_opt_report_ptr If not null, deref will be filled with information about the work done
+         *                            and the backlog left.
+         */
+        void run(const uint64_t&              in_budget_usec,
+                 Anvil::BackgroundWorkReport* out_opt_report_ptr = nullptr);
+
+    private:
+        /* Private type definitions */
+        typedef struct Task
+        {
+            uint64_t    id;
+            uint64_t    n_last_stepped_run;
+            std::string name;
+            uint32_t    n_runs_deferred;
+            MicroTask   task;
+
+            Task()
+            {
+                id                 = 0;
+                n_last_stepped_run = 0;
+                n_runs_deferred    = 0;
+            }
+        } Task;
+
+        /* Private functions */
+        BackgroundWorkScheduler();
+
+        /* Private variables */
+        uint64_t           m_active_task_id;
+        bool               m_is_active_task_cancelled;
+        mutable std::mutex m_mutex;
+        uint64_t           m_n_current_run;
+        uint64_t           m_next_task_id;
+        std::deque<Task>   m_tasks;
+        Anvil::Time        m_time;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(BackgroundWorkScheduler);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(BackgroundWorkScheduler);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_BACKGROUND_WORK_SCHEDULER_H */
@@ -39,6 +39,13 @@ namespace Anvil
             return (m_create_flags & Anvil::PipelineCreateFlagBits::ALLOW_DERIVATIVES_BIT) != 0;
         }
 
+        /** Tells whether the driver should capture executable statistics for the pipeline. Please see
+         *  BasePipelineManager::get_pipeline_executable_properties() for more details. */
+        bool captures_statistics() const
+        {
+            return (m_create_flags & Anvil::PipelineCreateFlagBits::CAPTURE_STATISTICS_BIT_KHR) != 0;
+        }
+
         bool attach_push_constant_range(uint32_t                in_offset,
                                         uint32_t                in_size,
                                         Anvil::ShaderStageFlags in_stages);
@@ -87,6 +94,14 @@ namespace Anvil
             return m_is_proxy;
         }
 
+        /** Makes all shader stages which use @param in_old_shader_module_ptr use @param in_new_shader_module_ptr
+         *  instead. Entry-point names are left intact.
+         *
+         *  @return true if at least one shader stage has been updated, false otherwise.
+         */
+        bool replace_shader_module(const Anvil::ShaderModule* in_old_shader_module_ptr,
+                                   Anvil::ShaderModule*       in_new_shader_module_ptr);
+
         void set_descriptor_set_create_info(const std::vector<const Anvil::DescriptorSetCreateInfo*>* in_ds_create_info_vec_ptr);
 
         void set_name(const std::string& in_name)
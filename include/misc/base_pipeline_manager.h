@@ -26,7 +26,14 @@
  *  - relies on PipelineLayoutManager to automatically re-use pipeline layout objects
  *    if the same layout is used for more than one pipeline object.
  *  - tracks life-time of baked Vulkan pipeline objects.
+ *  - serves get_pipeline() and get_pipeline_layout() requests for baked pipelines without taking a lock.
  *  - optionally defers the process of baking these objects until they're needed.
+ *  - optionally compiles these objects on a background thread. Please see set_async_compilation_enabled()
+ *    for more details.
+ *  - rebuilds pipelines whose shader modules have been replaced, for instance by ShaderHotReloader. Please see
+ *    replace_shader_module() for more details.
+ *  - reports how long it took to create each pipeline and whether the pipeline cache has been hit, if
+ *    VK_EXT_pipeline_creation_feedback is enabled. Please see get_pipeline_creation_feedback() for more details.
  *
  *  Any number of push constant ranges, as well as specialization constants can be assigned
  *  to the created pipeline objects.
@@ -42,7 +49,12 @@
 #include "misc/debug.h"
 #include "misc/mt_safety.h"
 #include "misc/types.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <memory>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace Anvil
@@ -57,6 +69,17 @@ namespace Anvil
          */
         BASE_PIPELINE_MANAGER_CALLBACK_ID_ON_NEW_PIPELINE_CREATED,
 
+        /* Call-back issued from the compiler thread whenever it finishes compiling a pipeline which has been
+         * added with async compilation enabled, whether successfully or not. Pipelines which fail to compile
+         * are dropped by the manager, unless they have been re-queued by replace_shader_module(), in which case
+         * they continue to use their previous Vulkan pipeline objects.
+         *
+         * Call-back is issued with the manager locked.
+         *
+         * callback_arg: OnPipelineCompiledCallbackData instance.
+         */
+        BASE_PIPELINE_MANAGER_CALLBACK_ID_ON_PIPELINE_COMPILED,
+
         /* Always last */
         BASE_PIPELINE_MANAGER_CALLBACK_ID_COUNT
     };
@@ -65,17 +88,145 @@ namespace Anvil
                                 public MTSafetySupportProvider
     {
     public:
+       /* Public type definitions */
+
+       /** Creation feedback reported by the driver for a pipeline or one of its shader stages. */
+       typedef struct CreationFeedback
+       {
+           uint64_t duration_nsec;
+           bool     is_application_pipeline_cache_hit;
+           bool     is_base_pipeline_acceleration;
+           bool     is_valid;
+
+           CreationFeedback()
+               :duration_nsec                    (0),
+                is_application_pipeline_cache_hit(false),
+                is_base_pipeline_acceleration    (false),
+                is_valid                         (false)
+           {
+               /* Stub */
+           }
+       } CreationFeedback;
+
+       /** Creation feedback of a single pipeline. @param stages only holds stages the driver has provided
+        *  valid feedback for. */
+       typedef struct PipelineCreationFeedback
+       {
+           CreationFeedback                               pipeline;
+           std::map<Anvil::ShaderStage, CreationFeedback> stages;
+       } PipelineCreationFeedback;
+
+       /** Creation feedback aggregated over all pipelines baked by the manager since the report has last been reset.
+        *  Only pipelines the driver has provided valid feedback for are accounted for. */
+       typedef struct PipelineCreationFeedbackReport
+       {
+           uint32_t                               n_application_pipeline_cache_hits;
+           uint32_t                               n_pipelines;
+           std::map<Anvil::ShaderStage, uint64_t> stage_duration_nsec;
+           uint64_t                               total_duration_nsec;
+
+           PipelineCreationFeedbackReport()
+               :n_application_pipeline_cache_hits(0),
+                n_pipelines                      (0),
+                total_duration_nsec              (0)
+           {
+               /* Stub */
+           }
+       } PipelineCreationFeedbackReport;
+
+       /** A single statistic the driver has reported for a pipeline executable. */
+       typedef struct PipelineExecutableStatistic
+       {
+           std::string                            description;
+           VkPipelineExecutableStatisticFormatKHR format;
+           std::string                            name;
+           VkPipelineExecutableStatisticValueKHR  value;
+
+           PipelineExecutableStatistic()
+               :format(VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_UINT64_KHR)
+           {
+               value.u64 = 0;
+           }
+
+           /** Returns the value converted to a double, regardless of the format. */
+           double get_value_as_double() const
+           {
+               switch (format)
+               {
+                   case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_BOOL32_KHR:  return (value.b32 == VK_TRUE) ? 1.0 : 0.0;
+                   case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_INT64_KHR:   return static_cast<double>(value.i64);
+                   case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_UINT64_KHR:  return static_cast<double>(value.u64);
+                   case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_FLOAT64_KHR: return value.f64;
+
+                   default:
+                   {
+                       anvil_assert_fail();
+
+                       return 0.0;
+                   }
+               }
+           }
+       } PipelineExecutableStatistic;
+
+       /** Properties and statistics of a single pipeline executable, as reported by VK_KHR_pipeline_executable_properties.
+        *  A pipeline executable usually corresponds to a single shader stage, but drivers are free to merge stages. */
+       typedef struct PipelineExecutableProperties
+       {
+           std::string                              description;
+           std::string                              name;
+           Anvil::ShaderStageFlags                  stages;
+           std::vector<PipelineExecutableStatistic> statistics;
+           uint32_t                                 subgroup_size;
+
+           PipelineExecutableProperties()
+               :subgroup_size(0)
+           {
+               /* Stub */
+           }
+       } PipelineExecutableProperties;
+
+       /** Bind statistics gathered for a single pipeline while usage profiling is enabled. */
+       typedef struct PipelineUsage
+       {
+           uint32_t n_binds;
+           uint32_t n_first_bind_frame; /* UINT32_MAX if the pipeline has never been bound */
+
+           PipelineUsage()
+               :n_binds           (0),
+                n_first_bind_frame(UINT32_MAX)
+           {
+               /* Stub */
+           }
+       } PipelineUsage;
+
        /* Public functions */
 
        /** Destructor. Releases internally managed objects. */
        virtual ~BasePipelineManager();
 
-        /** TODO */
+        /** Adds a new pipeline to the manager.
+         *
+         *  With async compilation enabled, non-proxy pipelines are queued for compilation on the compiler thread.
+         *  Otherwise, they are baked the next time bake() is called, or when one of the baked pipelines is requested.
+         *
+         *  @param in_pipeline_create_info_ptr  Create info of the pipeline. Must not be null.
+         *  @param out_pipeline_id_ptr          Deref will be set to the ID of the new pipeline. Must not be null.
+         *  @param in_opt_fallback_pipeline_id  Only used with async compilation enabled. If not UINT32_MAX,
+         *                                      get_pipeline() returns the specified pipeline in place of the new one,
+         *                                      until the latter finishes compiling.
+         *
+         *  @return true if successful, false otherwise.
+         **/
         bool add_pipeline(Anvil::BasePipelineCreateInfoUniquePtr in_pipeline_create_info_ptr,
-                          PipelineID*                            out_pipeline_id_ptr);
+                          PipelineID*                            out_pipeline_id_ptr,
+                          PipelineID                             in_opt_fallback_pipeline_id = UINT32_MAX);
 
-       /** TODO */
-       virtual bool bake() = 0;
+       /** Bakes all outstanding pipelines on the calling thread. Pipelines queued for async compilation are not
+        *  affected.
+        *
+        *  @return true if successful, false otherwise.
+        **/
+       bool bake();
 
        /** Deletes an existing pipeline.
         *
@@ -85,11 +236,23 @@ namespace Anvil
         **/
        bool delete_pipeline(PipelineID in_pipeline_id);
 
+       /** Bakes all outstanding pipelines and returns IDs of all non-proxy pipelines which have a Vulkan pipeline
+        *  object assigned, in ascending order. Pipelines still queued for async compilation are not included.
+        *
+        *  @param out_result_ptr Deref will be filled with the pipeline IDs. Must not be null.
+        **/
+       void get_baked_pipeline_ids(std::vector<PipelineID>* out_result_ptr);
+
        /** Retrieves a VkPipeline instance associated with the specified pipeline ID.
         *
         *  The function will bake a pipeline object (and, possibly, a pipeline layout object, too) if
         *  the specified pipeline is marked as dirty.
         *
+        *  Requests for baked pipelines are served with a single indexed load and do not lock the manager.
+        *
+        *  If the pipeline is still being compiled asynchronously, the function does not block. The fallback
+        *  pipeline specified at add_pipeline() time is returned instead, or VK_NULL_HANDLE if none was specified.
+        *
         *  @param in_pipeline_id ID of the pipeline to return the raw Vulkan pipeline handle for. Must not
         *                        describe a proxy pipeline.
         *
@@ -97,13 +260,62 @@ namespace Anvil
         **/
        VkPipeline get_pipeline(PipelineID in_pipeline_id);
 
+       /** Returns the maximum number of threads bake() is allowed to use. Please see set_n_bake_threads()
+        *  for more details.
+        **/
+       uint32_t get_n_bake_threads() const
+       {
+           return m_n_bake_threads;
+       }
+
        const Anvil::BasePipelineCreateInfo* get_pipeline_create_info(PipelineID in_pipeline_id) const;
 
+       /** Retrieves creation feedback the driver has reported for the specified pipeline.
+        *
+        *  Feedback is only requested if VK_EXT_pipeline_creation_feedback has been enabled for the device.
+        *  It becomes available once the pipeline has been baked, and is refreshed whenever the pipeline is
+        *  re-baked.
+        *
+        *  @param in_pipeline_id  ID of the pipeline to return the feedback for.
+        *  @param out_result_ptr  Deref will be set to the feedback. Must not be null.
+        *
+        *  @return true if valid feedback is available for the pipeline, false otherwise.
+        **/
+       bool get_pipeline_creation_feedback(PipelineID                in_pipeline_id,
+                                           PipelineCreationFeedback* out_result_ptr) const;
+
+       /** Returns creation feedback aggregated over all pipelines baked since the manager has been created,
+        *  or since reset_pipeline_creation_feedback_report() has last been called.
+        *
+        *  Please see get_pipeline_creation_feedback() for more details.
+        **/
+       PipelineCreationFeedbackReport get_pipeline_creation_feedback_report() const;
+
+       /** Returns properties of all executables the driver has compiled the specified pipeline into, along with
+        *  the statistics it reports for each of them.
+        *
+        *  Requires VK_KHR_pipeline_executable_properties to have been enabled for the device, along with its
+        *  pipelineExecutableInfo feature. Statistics are only reported for pipelines created with
+        *  Anvil::PipelineCreateFlagBits::CAPTURE_STATISTICS_BIT_KHR. For other pipelines, statistics vectors are
+        *  left empty.
+        *
+        *  The pipeline is baked if needed.
+        *
+        *  @param in_pipeline_id  ID of the pipeline to return the properties for. Must not describe a proxy pipeline.
+        *  @param out_result_ptr  Deref will be filled with one item per pipeline executable. Must not be null.
+        *
+        *  @return true if successful, false otherwise.
+        **/
+       bool get_pipeline_executable_properties(PipelineID                                 in_pipeline_id,
+                                               std::vector<PipelineExecutableProperties>* out_result_ptr);
+
        /** Retrieves a PipelineLayout instance associated with the specified pipeline ID.
         *
         *  The function will bake a pipeline object (and, possibly, a pipeline layout object, too) if
         *  the specified pipeline is marked as dirty.
         *
+        *  Once the layout has been retrieved, subsequent requests do not lock the manager.
+        *
         *  @param in_pipeline_id ID of the pipeline to return the wrapper instance for.
         *                        Must not describe a proxy pipeline.
         *
@@ -111,6 +323,17 @@ namespace Anvil
         **/
        Anvil::PipelineLayout* get_pipeline_layout(PipelineID in_pipeline_id);
 
+       /** Retrieves bind statistics gathered for the specified pipeline. Please see set_usage_profiling_enabled()
+        *  for more details.
+        *
+        *  @param in_pipeline_id ID of the pipeline to return the statistics for.
+        *  @param out_result_ptr Deref will be set to the statistics. Must not be null.
+        *
+        *  @return true if the pipeline has been bound at least once while profiling was enabled, false otherwise.
+        **/
+       bool get_pipeline_usage(PipelineID     in_pipeline_id,
+                               PipelineUsage* out_result_ptr) const;
+
        /** Returns various post-compile information about compute and graphics pipeline shaders like
         *  compiled binary or optionally shader disassembly.
         *  Requires support for VK_AMD_shader_info extension.
@@ -146,6 +369,135 @@ namespace Anvil
                                   Anvil::ShaderStage         in_shader_stage,
                                   VkShaderStatisticsInfoAMD* out_shader_statistics_ptr);
 
+       /** Tells whether async compilation is enabled. Please see set_async_compilation_enabled() for more details. */
+       bool is_async_compilation_enabled() const
+       {
+           return m_is_async_compilation_enabled;
+       }
+
+       /** Tells whether usage profiling is enabled. Please see set_usage_profiling_enabled() for more details. */
+       bool is_usage_profiling_enabled() const
+       {
+           return m_is_usage_profiling_enabled.load(std::memory_order_relaxed);
+       }
+
+       /** Releases all Vulkan pipeline objects which have been superseded by pipelines rebuilt after
+        *  a replace_shader_module() call.
+        *
+        *  The caller must make sure none of the retired pipelines is still accessed by the GPU.
+        **/
+       void release_retired_pipelines();
+
+       /** Rebuilds all pipelines which use @param in_old_shader_module_ptr, so that they use
+        *  @param in_new_shader_module_ptr instead. Pipeline IDs are preserved.
+        *
+        *  Pipelines which have not been baked yet simply start using the new shader module. Baked pipelines are
+        *  re-queued: with async compilation enabled, they are re-baked on the compiler thread. Otherwise, they are
+        *  re-baked the next time bake() is called. Until a pipeline has been re-baked, get_pipeline() continues to
+        *  return its previous Vulkan pipeline object. Once the new object is ready, it is swapped in atomically,
+        *  and the previous one is retired. Retired objects are released by release_retired_pipelines().
+        *
+        *  If a pipeline fails to re-bake, the previous Vulkan pipeline object continues to be used.
+        *
+        *  Pipeline layouts are not re-created, so the new shader module must be compatible with the layouts of
+        *  the pipelines which use the old one.
+        *
+        *  Must not be called with the manager locked, or from within the call-back. With async compilation
+        *  enabled, the function waits until the compiler thread is done with any pipeline which uses the old
+        *  shader module.
+        *
+        *  @param in_old_shader_module_ptr          Shader module to replace. Must not be null.
+        *  @param in_new_shader_module_ptr          Shader module to use instead. Must not be null.
+        *  @param out_opt_rebuilt_pipeline_ids_ptr  If not null, deref will be filled with IDs of all pipelines
+        *                                           which have been updated.
+        **/
+       void replace_shader_module(const Anvil::ShaderModule* in_old_shader_module_ptr,
+                                  Anvil::ShaderModule*       in_new_shader_module_ptr,
+                                  std::vector<PipelineID>*   out_opt_rebuilt_pipeline_ids_ptr = nullptr);
+
+       /** Resets the report returned by get_pipeline_creation_feedback_report(). Feedback of individual pipelines
+        *  is not affected.
+        **/
+       void reset_pipeline_creation_feedback_report();
+
+       /** Enables or disables async compilation. Async compilation is disabled by default.
+        *
+        *  With async compilation enabled, the manager owns a compiler thread. add_pipeline() queues new non-proxy
+        *  pipelines for compilation on that thread, and get_pipeline() returns the fallback pipelines specified at
+        *  add_pipeline() time until the requested pipelines are ready, instead of baking them on the calling thread.
+        *  Once a pipeline finishes compiling, BASE_PIPELINE_MANAGER_CALLBACK_ID_ON_PIPELINE_COMPILED call-back
+        *  is issued.
+        *
+        *  The manager's lock is not held while the Vulkan pipelines are being created, so other threads are
+        *  never blocked on a compile. The compiler thread honours the number of bake threads.
+        *
+        *  Base pipelines of derivative pipelines compiled asynchronously must either have been baked already,
+        *  or be compiled asynchronously, too.
+        *
+        *  Disabling async compilation waits until the compiler thread finishes compiling the current batch of
+        *  pipelines. Pipelines which are still queued after that are going to be baked synchronously, as
+        *  outstanding pipelines.
+        *
+        *  Requires the manager to have been created with MT safety enabled. Must not be called with the manager
+        *  locked, or from within the call-back.
+        *
+        *  @param in_enabled true to enable async compilation, false to disable it.
+        *
+        *  @return true if successful, false otherwise.
+        **/
+       bool set_async_compilation_enabled(bool in_enabled);
+
+       /** Sets the maximum number of threads bake() is allowed to use to create pipeline objects.
+        *
+        *  If more than one thread is allowed, outstanding pipelines are partitioned into contiguous chunks, each
+        *  of which is baked by a separate task against a task-local pipeline cache. Tasks are run on the device's
+        *  task scheduler (see BaseDevice::get_task_scheduler() ). Once all tasks finish, task caches are merged into
+        *  the manager's pipeline cache.
+        *
+        *  Batches which include derivative pipelines referring to their base pipeline by index are always baked
+        *  on the calling thread.
+        *
+        *  @param in_n_bake_threads Maximum number of threads to use. 0 is interpreted as the number of task
+        *                           scheduler workers plus the calling thread. Default value is 1, meaning
+        *                           pipelines are baked on the calling thread.
+        **/
+       void set_n_bake_threads(uint32_t in_n_bake_threads);
+
+       /** Enables or disables usage profiling. Usage profiling is disabled by default.
+        *
+        *  With profiling enabled, every CommandBufferBase::record_bind_pipeline() call made for a pipeline owned
+        *  by the manager increments the pipeline's bind counter, and the first such call stamps the pipeline with
+        *  the current frame index (see set_usage_profiling_frame() ). Both are updated without locking the manager.
+        *
+        *  Statistics are retrieved with get_pipeline_usage(). PipelineManifest captures them, so that the pipelines
+        *  an application needs first and most often can be compiled ahead of the rest.
+        *
+        *  @param in_enabled true to enable usage profiling, false to disable it.
+        **/
+       void set_usage_profiling_enabled(bool in_enabled)
+       {
+           m_is_usage_profiling_enabled.store(in_enabled,
+                                              std::memory_order_relaxed);
+       }
+
+       /** Sets the frame index pipelines bound for the first time are going to be stamped with. Applications
+        *  profiling pipeline usage should call this function at the start of each frame. Default value is 0.
+        *
+        *  @param in_n_frame Index of the current frame.
+        **/
+       void set_usage_profiling_frame(uint32_t in_n_frame)
+       {
+           m_usage_profiling_frame.store(in_n_frame,
+                                         std::memory_order_relaxed);
+       }
+
+       /** Blocks until all pipelines queued for async compilation have been compiled. Returns immediately
+        *  if async compilation is disabled.
+        *
+        *  Must not be called with the manager locked, or from within the call-back.
+        **/
+       void wait_for_async_compilation();
+
     protected:
        /* Protected type declarations */
 
@@ -153,6 +505,7 @@ namespace Anvil
        typedef struct Pipeline : public MTSafetySupportProvider
        {
            VkPipeline                             baked_pipeline;
+           PipelineCreationFeedback               creation_feedback;
            const BaseDevice*                      device_ptr;
            Anvil::PipelineLayoutUniquePtr         layout_ptr;
            Anvil::BasePipelineCreateInfoUniquePtr pipeline_create_info_ptr;
@@ -182,8 +535,45 @@ namespace Anvil
 
        typedef std::map<PipelineID, std::unique_ptr<Pipeline> > Pipelines;
 
+       /** Holds the VK_EXT_pipeline_creation_feedback structures the driver writes feedback of a single pipeline to.
+        *  Must stay alive until the vkCreate*Pipelines() call consuming the pipeline's create info returns. */
+       typedef struct CreationFeedbackStorage
+       {
+           VkPipelineCreationFeedbackCreateInfoEXT    create_info;
+           VkPipelineCreationFeedbackEXT              pipeline_feedback;
+           std::vector<VkPipelineCreationFeedbackEXT> stage_feedbacks;
+           std::vector<Anvil::ShaderStage>            stages;
+       } CreationFeedbackStorage;
+
+       /** Function prototype used by create_pipelines() to issue a vkCreate*Pipelines() call.
+        *
+        *  @param in_pipeline_cache    Pipeline cache to use for the call.
+        *  @param in_n_first_pipeline  Index of the first create info item to consume.
+        *  @param in_n_pipelines       Number of create info items to consume.
+        *  @param out_pipelines_ptr    Array of @param in_n_pipelines items to store the created pipelines in.
+        *
+        *  @return Result of the Vulkan call.
+        **/
+       typedef std::function<VkResult(VkPipelineCache in_pipeline_cache,
+                                      uint32_t        in_n_first_pipeline,
+                                      uint32_t        in_n_pipelines,
+                                      VkPipeline*     out_pipelines_ptr)> CreatePipelinesFunction;
+
        /* Protected functions */
 
+       /** Creates Vulkan pipeline objects for all pipelines held by @param inout_pipelines_ptr. If successful,
+        *  the pipelines are moved to m_baked_pipelines.
+        *
+        *  Locks the manager. When called from the compiler thread, the lock is released by create_pipelines()
+        *  while the Vulkan objects are being created.
+        *
+        *  @param inout_pipelines_ptr Pipelines to bake. Must not be null.
+        *
+        *  @return true if successful, false otherwise. In the latter case, @param inout_pipelines_ptr is
+        *          left intact.
+        **/
+       virtual bool bake_pipelines(Pipelines* inout_pipelines_ptr) = 0;
+
        /** Constructor. Initializes base layer of a pipeline manager.
         *
         *  @param in_device_ptr                  Device to use.
@@ -200,20 +590,74 @@ namespace Anvil
                                     bool                     in_use_pipeline_cache,
                                     Anvil::PipelineCache*    in_pipeline_cache_to_reuse_ptr);
 
-       /** Fills & returns a VkSpecializationInfo descriptor. Any sub-descriptors, to which the baked descriptor
-        *  is going to point at, are stored in a vector provided by the caller. It is caller's responsibility to
-        *  ensure the vector is not released before pipeline baking occurs.
+       /** Returns a VkSpecializationInfo descriptor for the specified set of specialization constants.
+        *
+        *  Descriptors are cached per unique set of constant IDs, sizes and values, so that all pipelines which
+        *  specialize their shaders the same way share a single descriptor. Map entries and constant data of
+        *  cached descriptors are stored in an arena owned by the manager. The returned descriptor stays valid
+        *  until the manager is released.
+        *
+        *  Must be called with the manager locked.
+        *
+        *  @param in_specialization_constants         Vector of internal specialization constant descriptors, which should be
+        *                                             baked into the Vulkan descriptor. Must not be empty.
+        *  @param in_specialization_constant_data_ptr Buffer which holds specialization constant data.
+        *
+        *  @return Ptr to the descriptor.
+        **/
+       const VkSpecializationInfo* bake_specialization_info_vk(const SpecializationConstants& in_specialization_constants,
+                                                               const unsigned char*           in_specialization_constant_data_ptr) const;
+
+       /** Prepends a VkPipelineCreationFeedbackCreateInfoEXT struct to a pipeline create info's chain, so that
+        *  the driver reports creation feedback for the pipeline.
+        *
+        *  @param in_n_stages           Number of shader stages the pipeline is going to be created with.
+        *  @param in_stages_ptr         Array of @param in_n_stages stage create info items the pipeline is going to be
+        *                               created with.
+        *  @param inout_next_ptr_ptr    Pointer to the pNext field of the pipeline create info. Must not be null.
+        *
+        *  @return Storage the feedback is going to be written to, or null if VK_EXT_pipeline_creation_feedback
+        *          is not enabled for the device, in which case the chain is left intact. Must be passed to
+        *          store_creation_feedback() once the pipeline has been created.
+        **/
+       std::unique_ptr<CreationFeedbackStorage> chain_creation_feedback(uint32_t                               in_n_stages,
+                                                                        const VkPipelineShaderStageCreateInfo* in_stages_ptr,
+                                                                        const void**                           inout_next_ptr_ptr) const;
+
+       /** Creates @param in_n_pipelines pipeline objects by calling @param in_create_func.
+        *
+        *  If the manager has been configured to bake on more than one thread and @param in_can_be_split is true,
+        *  the work is distributed across worker threads which use worker-local pipeline caches. These are merged
+        *  into the manager's pipeline cache before the function returns. Otherwise, a single call is made on the
+        *  calling thread with the manager's pipeline cache locked.
+        *
+        *  When called from the compiler thread, the manager must be locked exactly once. The lock is released
+        *  for the duration of the function.
         *
-        *  @param in_specialization_constants            Vector of internal specialization constant descriptors, which should be
-        *                                                baked into the Vulkan descriptor.
-        *  @param in_specialization_constant_data_ptr    Buffer which holds specialization constant data.
-        *  @param out_specialization_map_entry_vk_vector As per description. Must not be nullptr.
-        *  @param out_specialization_info_ptr            Deref will be set to the baked Vulkan descriptor. Must not be nullptr.
+        *  @param in_n_pipelines    Number of pipelines to create.
+        *  @param in_can_be_split   False if create info items refer to each other and must be consumed by a single call.
+        *  @param in_create_func    Function to issue the Vulkan call with. Must be safe to call from multiple threads.
+        *  @param out_pipelines_ptr Array of @param in_n_pipelines items to store the created pipelines in.
+        *                           Must not be nullptr.
+        *
+        *  @return true if all pipelines have been created successfully, false otherwise. In the latter case, any
+        *          pipelines which have been created are released and the array is filled with VK_NULL_HANDLEs.
         **/
-       void bake_specialization_info_vk(const SpecializationConstants&         in_specialization_constants,
-                                        const unsigned char*                   in_specialization_constant_data_ptr,
-                                        std::vector<VkSpecializationMapEntry>* out_specialization_map_entry_vk_vector,
-                                        VkSpecializationInfo*                  out_specialization_info_ptr) const;
+       bool create_pipelines(uint32_t                       in_n_pipelines,
+                             bool                           in_can_be_split,
+                             const CreatePipelinesFunction& in_create_func,
+                             VkPipeline*                    out_pipelines_ptr);
+
+       /** Converts feedback written by the driver to a storage returned by chain_creation_feedback(), assigns it to
+        *  the specified pipeline and accounts for it in the report returned by get_pipeline_creation_feedback_report().
+        *
+        *  Must be called with the manager locked.
+        *
+        *  @param in_opt_storage_ptr Storage to read the feedback from. If null, the function is a nop.
+        *  @param in_pipeline_ptr    Pipeline to assign the feedback to. Must not be null.
+        **/
+       void store_creation_feedback(const CreationFeedbackStorage* in_opt_storage_ptr,
+                                    Pipeline*                      in_pipeline_ptr);
 
        /* Protected members */
        const Anvil::BaseDevice* m_device_ptr;
@@ -222,15 +666,92 @@ namespace Anvil
        Pipelines                             m_baked_pipelines;
        Pipelines                             m_outstanding_pipelines;
 
+       uint32_t               m_n_bake_threads;
        Anvil::PipelineCache*  m_pipeline_cache_ptr;
        PipelineCacheUniquePtr m_pipeline_cache_owned_ptr;
        PipelineLayoutManager* m_pipeline_layout_manager_ptr;
        bool                   m_use_pipeline_cache;
 
 private:
+       /* Private type definitions */
+
+       /* Lock-free view of a single pipeline's baked objects, for the lookups issued at draw time.
+        *
+        * Pipeline IDs are handed out by a monotonically increasing counter and are never reused, so the ID
+        * serves as the slot index and a non-null value can only ever refer to the pipeline the slot has been
+        * created for. Slots are allocated in chunks, which are never released or moved until the manager
+        * is destroyed. Slots are only written to with the manager locked. */
+       typedef struct PipelineSlot
+       {
+           std::atomic<VkPipeline>             baked_pipeline;
+           std::atomic<Anvil::PipelineLayout*> layout_ptr;
+
+           /* Usage profiling. Updated without locking the manager. */
+           mutable std::atomic<uint32_t> n_binds;
+           mutable std::atomic<uint32_t> n_first_bind_frame;
+
+           PipelineSlot()
+               :baked_pipeline    (VK_NULL_HANDLE),
+                layout_ptr        (nullptr),
+                n_binds           (0),
+                n_first_bind_frame(UINT32_MAX)
+           {
+               /* Stub */
+           }
+       } PipelineSlot;
+
+       /* A cached VkSpecializationInfo descriptor. The key holds the ID and size of each constant, followed by
+        * the constant data. */
+       typedef struct SpecializationInfoCacheEntry
+       {
+           VkSpecializationInfo       info;
+           std::vector<unsigned char> key;
+       } SpecializationInfoCacheEntry;
+
+       typedef std::unordered_map<uint64_t, std::vector<std::unique_ptr<SpecializationInfoCacheEntry> > > SpecializationInfoCache;
+
+       static const uint32_t N_MAX_PIPELINE_SLOT_CHUNKS           = 4096;
+       static const uint32_t N_PIPELINE_SLOTS_PER_CHUNK           = 1024;
+       static const uint32_t SPECIALIZATION_INFO_ARENA_BLOCK_SIZE = 64 * 1024;
+
        /* Private functions */
        BasePipelineManager& operator=(const BasePipelineManager&);
        BasePipelineManager           (const BasePipelineManager&);
+
+       void*               alloc_specialization_info_arena_memory(uint32_t in_n_bytes) const;
+       void                compiler_thread_main();
+       Pipeline*           find_pipeline              (PipelineID      in_pipeline_id) const;
+       PipelineSlot*       get_or_create_pipeline_slot(PipelineID      in_pipeline_id);
+       const PipelineSlot* get_pipeline_slot          (PipelineID      in_pipeline_id) const;
+       void                on_pipeline_bound          (PipelineID      in_pipeline_id);
+       void                publish_pipeline           (PipelineID      in_pipeline_id,
+                                                       const Pipeline* in_opt_pipeline_ptr);
+       void                restore_rebuilt_pipelines  (Pipelines*      inout_pipelines_ptr);
+       void                retire_previous_pipeline   (PipelineID      in_pipeline_id);
+
+       /* Private variables */
+       Pipelines                        m_async_pipelines;
+       Pipelines                        m_compiling_pipelines;
+       std::thread                      m_compiler_thread;
+       std::condition_variable_any      m_compiler_thread_cv;
+       std::thread::id                  m_compiler_thread_id;
+       bool                             m_compiler_thread_should_quit;
+       PipelineCreationFeedbackReport   m_creation_feedback_report;
+       std::map<PipelineID, PipelineID> m_fallback_pipeline_ids;
+       bool                             m_is_async_compilation_enabled;
+       std::atomic<bool>                m_is_usage_profiling_enabled;
+       std::atomic<PipelineSlot*>       m_pipeline_slot_chunks[N_MAX_PIPELINE_SLOT_CHUNKS];
+       std::vector<PipelineID>          m_pipelines_to_delete;
+       std::map<PipelineID, VkPipeline> m_rebuilt_pipeline_previous_handles;
+       std::vector<VkPipeline>          m_retired_pipelines;
+       std::atomic<uint32_t>            m_usage_profiling_frame;
+
+       mutable std::vector<std::unique_ptr<unsigned char[]> > m_specialization_info_arena_blocks;
+       mutable uint32_t                                       m_specialization_info_arena_block_offset;
+       mutable SpecializationInfoCache                        m_specialization_info_cache;
+       mutable std::vector<unsigned char>                     m_specialization_info_scratch_key;
+
+       friend class Anvil::CommandBufferBase;
     };
 }; /* Vulkan namespace */
 
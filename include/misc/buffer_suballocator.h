@@ -0,0 +1,182 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a general-purpose sub-allocator, which packs many small, long-lived logical buffers into a handful
+ *  of large Anvil::Buffer instances.
+ *
+ *  Each block buffer is split into regions using a first-fit free list. Freed regions are coalesced with their
+ *  neighbours, so they can be reused by later allocations of any size. When no block can accommodate a request,
+ *  a new block is created. Requests larger than the block size get a dedicated block.
+ *
+ *  Allocations are returned as {buffer, offset, size} handles, which can be passed directly to the functions
+ *  which take a buffer and an offset, such as CommandBufferBase::record_bind_vertex_buffers(),
+ *  CommandBufferBase::record_bind_index_buffer(), CommandBufferBase::record_copy_buffer() or
+ *  DescriptorSet::BufferBindingElement.
+ *
+ *  If the allocator is created with MemoryFeatureFlagBits::MAPPABLE_BIT, block buffers are kept mapped
+ *  throughout their lifetime and each allocation exposes its host pointer.
+ *
+ *  It is the caller's responsibility to make sure the GPU is no longer accessing a region before it is freed.
+ *
+ *  Buffer sub-allocator is NOT thread-safe, unless created with @param in_mt_safe set to true.
+ */
+#ifndef MISC_BUFFER_SUBALLOCATOR_H
+#define MISC_BUFFER_SUBALLOCATOR_H
+
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+#include <map>
+
+
+namespace Anvil
+{
+    class BufferSuballocator : public MTSafetySupportProvider
+    {
+    public:
+        /* Public type definitions */
+        typedef struct Allocation
+        {
+            Anvil::Buffer* buffer_ptr;
+            void*          mapped_ptr;
+            uint32_t       n_block;
+            VkDeviceSize   offset;
+            VkDeviceSize   size;
+
+            Allocation()
+                :buffer_ptr(nullptr),
+                 mapped_ptr(nullptr),
+                 n_block   (UINT32_MAX),
+                 offset    (0),
+                 size      (0)
+            {
+                /* Stub */
+            }
+        } Allocation;
+
+        /* Public functions */
+
+        /** Creates a new buffer sub-allocator instance.
+         *
+         *  @param in_device_ptr      Device to create the allocator for. Must not be null.
+         *  @param in_block_size      Size of block buffers to create. Must not be 0.
+         *  @param in_usage_flags     Usage flags to create block buffers with.
+         *  @param in_memory_features Memory features block buffers' memory must support. If MAPPABLE_BIT
+         *                            is specified, blocks are persistently mapped.
+         *  @param in_mt_safe         True if the instance should be thread-safe.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::BufferSuballocatorUniquePtr create(const Anvil::BaseDevice*   in_device_ptr,
+                                                         VkDeviceSize               in_block_size      = 16 * 1024 * 1024,
+                                                         Anvil::BufferUsageFlags    in_usage_flags     = Anvil::BufferUsageFlagBits::INDEX_BUFFER_BIT   |
+                                                                                                         Anvil::BufferUsageFlagBits::TRANSFER_DST_BIT   |
+                                                                                                         Anvil::BufferUsageFlagBits::TRANSFER_SRC_BIT   |
+                                                                                                         Anvil::BufferUsageFlagBits::UNIFORM_BUFFER_BIT |
+                                                                                                         Anvil::BufferUsageFlagBits::VERTEX_BUFFER_BIT,
+                                                         Anvil::MemoryFeatureFlags  in_memory_features = Anvil::MemoryFeatureFlagBits::DEVICE_LOCAL_BIT,
+                                                         bool                       in_mt_safe         = false);
+
+        /** Destructor. The caller must make sure none of the blocks is still accessed by the GPU. */
+        ~BufferSuballocator();
+
+        /** Sub-allocates a region.
+         *
+         *  The region's start offset is aligned to the larger of the allocator's alignment and @param in_alignment.
+         *  The region stays valid until it is released with free(), or the allocator is destroyed.
+         *
+         *  @param in_size        Number of bytes to allocate. Must not be 0.
+         *  @param in_alignment   Additional alignment requirement for the region's start offset. Must be 0 or a power
+         *                        of two.
+         *  @param out_result_ptr Deref will be set to the allocation details if the call succeeds. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool allocate(VkDeviceSize in_size,
+                      VkDeviceSize in_alignment,
+                      Allocation*  out_result_ptr);
+
+        /** Returns a region to the block it was carved out of.
+         *
+         *  @param in_allocation Allocation returned by an earlier allocate() call.
+         */
+        void free(const Allocation& in_allocation);
+
+        /** Returns the alignment all allocations are rounded up to, unless a larger one is requested. */
+        VkDeviceSize get_alignment() const
+        {
+            return m_alignment;
+        }
+
+        /** Returns the number of bytes currently handed out, including alignment padding. */
+        VkDeviceSize get_n_allocated_bytes() const;
+
+        /** Returns the number of block buffers created so far. */
+        uint32_t get_n_blocks() const;
+
+    private:
+        /* Private type definitions */
+        typedef struct Block
+        {
+            Anvil::BufferUniquePtr               buffer_ptr;
+            std::map<VkDeviceSize, VkDeviceSize> free_ranges; /* offset -> size */
+            unsigned char*                       mapped_ptr;
+            VkDeviceSize                         size;
+
+            Block(Anvil::BufferUniquePtr in_buffer_ptr,
+                  unsigned char*         in_mapped_ptr,
+                  VkDeviceSize           in_size)
+                :buffer_ptr(std::move(in_buffer_ptr) ),
+                 mapped_ptr(in_mapped_ptr),
+                 size      (in_size)
+            {
+                free_ranges[0] = in_size;
+            }
+        } Block;
+
+        /* Private functions */
+        BufferSuballocator(const Anvil::BaseDevice*  in_device_ptr,
+                           VkDeviceSize              in_block_size,
+                           Anvil::BufferUsageFlags   in_usage_flags,
+                           Anvil::MemoryFeatureFlags in_memory_features,
+                           bool                      in_mt_safe);
+
+        bool allocate_from_block(uint32_t     in_n_block,
+                                 VkDeviceSize in_size,
+                                 VkDeviceSize in_alignment,
+                                 Allocation*  out_result_ptr);
+        bool create_block       (VkDeviceSize in_size);
+
+        /* Private variables */
+        VkDeviceSize              m_alignment;
+        const VkDeviceSize        m_block_size;
+        std::vector<Block>        m_blocks;
+        const Anvil::BaseDevice*  m_device_ptr;
+        Anvil::MemoryFeatureFlags m_memory_features;
+        VkDeviceSize              m_n_allocated_bytes;
+        Anvil::BufferUsageFlags   m_usage_flags;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(BufferSuballocator);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(BufferSuballocator);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_BUFFER_SUBALLOCATOR_H */
@@ -40,6 +40,8 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 
 namespace Anvil
 {
@@ -100,6 +102,22 @@ namespace Anvil
         bool                result;
     } IsImageMemoryAllocPendingQueryCallbackArgument;
 
+    typedef struct OnBufferMemoryMovedCallbackArgument : public Anvil::CallbackArgument
+    {
+        explicit OnBufferMemoryMovedCallbackArgument(Anvil::Buffer* in_buffer_ptr,
+                                                     VkBuffer       in_old_buffer_vk)
+            :buffer_ptr   (in_buffer_ptr),
+             old_buffer_vk(in_old_buffer_vk)
+        {
+            /* Stub */
+        }
+
+        OnBufferMemoryMovedCallbackArgument& operator=(const OnBufferMemoryMovedCallbackArgument&) = delete;
+
+        Anvil::Buffer* buffer_ptr;
+        VkBuffer       old_buffer_vk;
+    } OnBufferMemoryMovedCallbackArgument;
+
     typedef struct OnDescriptorPoolResetCallbackArgument : public Anvil::CallbackArgument
     {
         const DescriptorPool* descriptor_pool_ptr;
@@ -223,6 +241,25 @@ namespace Anvil
         }
     } OnPipelineBarrierCommandRecordedCallbackData;
 
+    typedef struct OnPipelineCompiledCallbackData : public Anvil::CallbackArgument
+    {
+        PipelineID pipeline_id;
+        bool       succeeded;
+
+        /** Constructor.
+         *
+         *  @param in_pipeline_id ID of the pipeline which has been compiled.
+         *  @param in_succeeded   true if the pipeline has been compiled successfully, false otherwise.
+         **/
+        explicit OnPipelineCompiledCallbackData(PipelineID in_pipeline_id,
+                                                bool       in_succeeded)
+            :pipeline_id(in_pipeline_id),
+             succeeded  (in_succeeded)
+        {
+            /* Stub */
+        }
+    } OnPipelineCompiledCallbackData;
+
     typedef struct OnPresentRequestIssuedCallbackArgument : public Anvil::CallbackArgument
     {
         const Swapchain* swapchain_ptr;
@@ -290,8 +327,17 @@ namespace Anvil
             anvil_assert(in_callback_id_count > 0);
 
             m_callback_id_count = in_callback_id_count;
-            m_callbacks         = new Callbacks[static_cast<uintptr_t>(in_callback_id_count)];
-            m_callbacks_locked  = false;
+            m_callbacks         = new std::atomic<const Callbacks*>[static_cast<uintptr_t>(in_callback_id_count)];
+
+            m_n_active_readers.store(0);
+            m_n_drain_waiters.store (0);
+
+            for (CallbackID current_callback_id = 0;
+                            current_callback_id < in_callback_id_count;
+                          ++current_callback_id)
+            {
+                m_callbacks[current_callback_id].store(nullptr);
+            }
         }
 
         /** Destructor.
@@ -301,6 +347,20 @@ namespace Anvil
          **/
         virtual ~CallbacksSupportProvider()
         {
+            anvil_assert(m_n_active_readers.load() == 0);
+
+            for (CallbackID current_callback_id = 0;
+                            current_callback_id < m_callback_id_count;
+                          ++current_callback_id)
+            {
+                delete m_callbacks[current_callback_id].load();
+            }
+
+            for (auto& current_retired_callbacks_ptr : m_retired_callbacks)
+            {
+                delete current_retired_callbacks_ptr;
+            }
+
             delete [] m_callbacks;
 
             m_callbacks = nullptr;
@@ -326,10 +386,14 @@ namespace Anvil
 
             anvil_assert(in_callback_id < m_callback_id_count);
 
-            return std::find(m_callbacks[in_callback_id].begin(),
-                             m_callbacks[in_callback_id].end(),
-                             Callback(in_callback_function,
-                                      in_callback_function_owner_ptr) ) != m_callbacks[in_callback_id].end();
+            /* Snapshots are only ever replaced with the mutex held, so no reader registration is needed here. */
+            const Callbacks* callbacks_ptr = m_callbacks[in_callback_id].load();
+
+            return (callbacks_ptr != nullptr)                                             &&
+                   (std::find(callbacks_ptr->begin(),
+                              callbacks_ptr->end  (),
+                              Callback(in_callback_function,
+                                       in_callback_function_owner_ptr) ) != callbacks_ptr->end() );
         }
 
         /** Registers a new call-back client.
@@ -337,6 +401,9 @@ namespace Anvil
          *  Note that the function does NOT check if the specified callback func ptr + user argument
          *  has not already been registered.
          *
+         *  Can be called from within a callback handler. The new subscriber is not going to be called
+         *  back by callback() invocations which are already in flight.
+         *
          *  @param in_callback_id        ID of the call-back slot the caller intends to sign up to. The
          *                               value must not exceed the maximum callback ID allowed by the
          *                               inheriting class.
@@ -355,7 +422,6 @@ namespace Anvil
             anvil_assert(in_callback_id        <  m_callback_id_count);
             anvil_assert(in_callback_function  != nullptr);
             anvil_assert(in_callback_owner_ptr != nullptr);
-            anvil_assert(!m_callbacks_locked);
 
             #ifdef _DEBUG
             {
@@ -365,10 +431,17 @@ namespace Anvil
             }
             #endif
 
-            m_callbacks[in_callback_id].push_back(
+            const Callbacks* current_callbacks_ptr = m_callbacks[in_callback_id].load();
+            Callbacks*       new_callbacks_ptr     = (current_callbacks_ptr != nullptr) ? new Callbacks(*current_callbacks_ptr)
+                                                                                        : new Callbacks();
+
+            new_callbacks_ptr->push_back(
                 Callback(in_callback_function,
                          in_callback_owner_ptr)
             );
+
+            publish_callbacks(in_callback_id,
+                              new_callbacks_ptr);
         }
 
         /** Unregisters the client from the specified call-back slot.
@@ -377,6 +450,16 @@ namespace Anvil
          *  a preceding register_for_callbacks() call, or which has already been unregistered.
          *  Doing so will result in an assertion failure.
          *
+         *  Once the function returns, the subscriber is guaranteed not to be called back, so it can be released
+         *  right away. If callback() invocations running on other threads may still call the subscriber back,
+         *  the function blocks until they finish iterating over the subscriber list.
+         *
+         *  Can be called from within a callback handler. Since waiting would deadlock in that case, the function
+         *  does not wait if the calling thread is dispatching a callback from this object. The caller is then
+         *  responsible for making sure no other thread is calling the subscriber back at the same time, and
+         *  must not release the subscriber before its own callback() invocations return. Debug builds assert
+         *  that all readers of the old subscriber list are callback() invocations of the calling thread.
+         *
          *  @param in_callback_id                 ID of the call-back slot the caller wants to sign out from.
          *                                        The value must not exceed the maximum callback ID allowed by
          *                                        the inheriting class.
@@ -392,17 +475,76 @@ namespace Anvil
 
             anvil_assert(in_callback_id       <  m_callback_id_count);
             anvil_assert(in_callback_function != nullptr);
-            anvil_assert(!m_callbacks_locked);
 
-            auto callback_iterator = std::find(m_callbacks[in_callback_id].begin(),
-                                               m_callbacks[in_callback_id].end(),
+            const Callbacks* current_callbacks_ptr = m_callbacks[in_callback_id].load();
+
+            anvil_assert(current_callbacks_ptr != nullptr);
+            if (current_callbacks_ptr == nullptr)
+            {
+                return;
+            }
+
+            /* Keeps the old snapshot alive until the grace period below is over. */
+            m_n_active_readers.fetch_add(1);
+
+            auto callback_iterator = std::find(current_callbacks_ptr->begin(),
+                                               current_callbacks_ptr->end  (),
                                                Callback(in_callback_function,
                                                         in_callback_function_owner_ptr) );
 
-            anvil_assert(callback_iterator != m_callbacks[in_callback_id].end() );
-            if (callback_iterator != m_callbacks[in_callback_id].end() )
+            anvil_assert(callback_iterator != current_callbacks_ptr->end() );
+            if (callback_iterator != current_callbacks_ptr->end() )
             {
-                m_callbacks[in_callback_id].erase(callback_iterator);
+                Callbacks* new_callbacks_ptr = nullptr;
+
+                /* An empty slot is represented by a null snapshot, so that callback() can bail out after a single load. */
+                if (current_callbacks_ptr->size() > 1)
+                {
+                    new_callbacks_ptr = new Callbacks();
+
+                    new_callbacks_ptr->reserve(current_callbacks_ptr->size() - 1);
+
+                    for (auto current_iterator  = current_callbacks_ptr->begin();
+                              current_iterator != current_callbacks_ptr->end();
+                            ++current_iterator)
+                    {
+                        if (current_iterator != callback_iterator)
+                        {
+                            new_callbacks_ptr->push_back(*current_iterator);
+                        }
+                    }
+                }
+
+                publish_callbacks(in_callback_id,
+                                  new_callbacks_ptr);
+            }
+
+            mutex_lock.unlock();
+
+            /* Wait for callback() invocations, which may still hold the old snapshot, to drain. New invocations
+             * are going to use the new snapshot. The mutex must not be held at this point, as the subscribers
+             * being called back may (un)register for callbacks themselves. */
+            if (!is_dispatching_callbacks() )
+            {
+                wait_for_callbacks_to_drain(current_callbacks_ptr);
+            }
+            #ifdef _DEBUG
+            else
+            {
+                /* Only our own dispatches, further up the call stack, may still be iterating over the old list. */
+                const auto& dispatching_provider_ptrs = get_dispatching_providers();
+
+                anvil_assert(current_callbacks_ptr->n_readers.load() <= static_cast<uint32_t>(std::count(dispatching_provider_ptrs.begin(),
+                                                                                                         dispatching_provider_ptrs.end  (),
+                                                                                                         this) ));
+            }
+            #endif
+
+            mutex_lock.lock();
+
+            if (m_n_active_readers.fetch_sub(1) == 1)
+            {
+                release_retired_callbacks();
             }
         }
 
@@ -414,8 +556,9 @@ namespace Anvil
          *  The clients are called one after another from the thread, in which the call has
          *  been invoked.
          *
-         *  This implementation assumes that the invoked functions will NOT alter the
-         *  callback array. If that is the case, use (slower) callback_safe() instead.
+         *  The function iterates over an immutable snapshot of the subscriber list and never takes a lock.
+         *  Subscriptions changed by the invoked functions take effect for subsequent calls. If subscribers
+         *  added that way need to be called back too, use (slower) callback_safe() instead.
          *
          *  @param in_callback_id      ID of the call-back slot to use.
          *  @param in_callback_arg_ptr Call-back argument to use.
@@ -423,23 +566,30 @@ namespace Anvil
         void callback(CallbackID        in_callback_id,
                       CallbackArgument* in_callback_arg_ptr) const
         {
-            std::unique_lock<std::recursive_mutex> mutex_lock(m_mutex);
-
             anvil_assert(in_callback_id < m_callback_id_count);
-            anvil_assert(!m_callbacks_locked);
 
-            m_callbacks_locked = true;
+            if (m_callbacks[in_callback_id].load(std::memory_order_relaxed) == nullptr)
+            {
+                return;
+            }
+
+            m_n_active_readers.fetch_add(1);
+            get_dispatching_providers().push_back(this);
             {
-                for (auto callback_iterator  = m_callbacks[in_callback_id].begin();
-                          callback_iterator != m_callbacks[in_callback_id].end();
-                        ++callback_iterator)
+                const Callbacks* callbacks_ptr = acquire_callbacks(in_callback_id);
+
+                if (callbacks_ptr != nullptr)
                 {
-                    const auto& current_callback = *callback_iterator;
+                    for (const auto& current_callback : *callbacks_ptr)
+                    {
+                        current_callback.function(in_callback_arg_ptr);
+                    }
 
-                    current_callback.function(in_callback_arg_ptr);
+                    release_callbacks(callbacks_ptr);
                 }
             }
-            m_callbacks_locked = false;
+            get_dispatching_providers().pop_back();
+            m_n_active_readers.fetch_sub(1);
         }
 
         /** Calls back all subscribers which have signed up for the specified callback slot.
@@ -452,9 +602,8 @@ namespace Anvil
          *  called more than once, and will take note of any new callback subscriptions that
          *  may have been added by the called back functions.
          *
-         *  This implementation is NOT MT-safe.
-         *
-         *  This function can potentially take a long time to execute.
+         *  This function can potentially take a long time to execute. It returns without touching
+         *  the subscriber list if nobody has subscribed to the slot.
          *
          *
          *  @param in_callback_id  ID of the call-back slot to use.
@@ -463,47 +612,56 @@ namespace Anvil
         void callback_safe(CallbackID        in_callback_id,
                            CallbackArgument* in_callback_arg_ptr)
         {
-            std::unique_lock<std::recursive_mutex> mutex_lock(m_mutex);
-
             anvil_assert(in_callback_id < m_callback_id_count);
-            anvil_assert(!m_callbacks_locked);
 
-            bool                  another_iteration_needed = true;
-            bool                  first_iteration          = true;
-            std::vector<Callback> invoked_callbacks;
-
-            while (another_iteration_needed                &&
-                   m_callbacks[in_callback_id].size() > 0)
+            if (m_callbacks[in_callback_id].load(std::memory_order_relaxed) == nullptr)
             {
-                const std::vector<Callback> cached_callbacks = m_callbacks[in_callback_id];
+                return;
+            }
 
-                another_iteration_needed = false;
+            m_n_active_readers.fetch_add(1);
+            get_dispatching_providers().push_back(this);
+            {
+                const Callbacks*      callbacks_ptr   = acquire_callbacks(in_callback_id);
+                bool                  first_iteration = true;
+                std::vector<Callback> invoked_callbacks;
 
-                for (uint32_t n_current_callback = 0;
-                              n_current_callback < static_cast<uint32_t>(cached_callbacks.size() );
-                            ++n_current_callback)
+                /* Snapshots cannot be released while we are registered as a reader, so a snapshot address
+                 * which is still current after the iteration means no subscription has changed meanwhile. */
+                while (callbacks_ptr != nullptr)
                 {
-                    const auto& current_callback = cached_callbacks[n_current_callback];
+                    const Callbacks* new_callbacks_ptr = nullptr;
 
-                    if (first_iteration                                        ||
-                        std::find(invoked_callbacks.begin(),
-                                  invoked_callbacks.end(),
-                                  current_callback) == invoked_callbacks.end() )
+                    for (const auto& current_callback : *callbacks_ptr)
                     {
-                        current_callback.function(in_callback_arg_ptr);
+                        if (first_iteration                                        ||
+                            std::find(invoked_callbacks.begin(),
+                                      invoked_callbacks.end(),
+                                      current_callback) == invoked_callbacks.end() )
+                        {
+                            current_callback.function(in_callback_arg_ptr);
+
+                            invoked_callbacks.push_back(current_callback);
+                        }
+                    }
+
+                    new_callbacks_ptr = m_callbacks[in_callback_id].load();
 
-                        invoked_callbacks.push_back(current_callback);
+                    if (new_callbacks_ptr == callbacks_ptr)
+                    {
+                        release_callbacks(callbacks_ptr);
+
+                        break;
                     }
-                }
 
-                /* Has m_callbacks[in_callback_id] changed as a result of the callback above? */
-                if (!(m_callbacks[in_callback_id] == invoked_callbacks) )
-                {
-                    another_iteration_needed = true;
-                }
+                    release_callbacks(callbacks_ptr);
 
-                first_iteration = false;
+                    callbacks_ptr   = acquire_callbacks(in_callback_id);
+                    first_iteration = false;
+                }
             }
+            get_dispatching_providers().pop_back();
+            m_n_active_readers.fetch_sub(1);
         }
 
         /** Tells how many subscribers have registered for the specified callback */
@@ -511,11 +669,19 @@ namespace Anvil
         {
             uint32_t result = 0;
 
-            if (in_callback_id < m_callback_id_count)
+            if ((in_callback_id                                               <  m_callback_id_count) &&
+                (m_callbacks[in_callback_id].load(std::memory_order_relaxed) != nullptr) )
             {
-                std::unique_lock<std::recursive_mutex> mutex_lock(m_mutex);
+                m_n_active_readers.fetch_add(1);
+                {
+                    const Callbacks* callbacks_ptr = m_callbacks[in_callback_id].load();
 
-                result = static_cast<uint32_t>(m_callbacks[in_callback_id].size() );
+                    if (callbacks_ptr != nullptr)
+                    {
+                        result = static_cast<uint32_t>(callbacks_ptr->size() );
+                    }
+                }
+                m_n_active_readers.fetch_sub(1);
             }
 
             return result;
@@ -549,13 +715,168 @@ namespace Anvil
             }
         } Callback;
 
-        typedef std::vector<Callback> Callbacks;
+        /* Immutable snapshot of the subscriber list of a single slot, together with the number of callback()
+         * invocations which are iterating over it. */
+        struct Callbacks : public std::vector<Callback>
+        {
+            mutable std::atomic<uint32_t> n_readers;
+
+            Callbacks()
+                :n_readers(0)
+            {
+                /* Stub */
+            }
+
+            Callbacks(const Callbacks& in_callbacks)
+                :std::vector<Callback>(in_callbacks),
+                 n_readers            (0)
+            {
+                /* Stub */
+            }
+        };
+
+        /* Private functions */
+
+        /** Loads the current snapshot for the specified slot and registers the caller as its reader. The caller
+         *  must be registered in m_n_active_readers, and must decrement the snapshot's n_readers when done.
+         *
+         *  The slot is re-read after the reader count is bumped. This way, unregister_from_callbacks() either
+         *  sees the new reader when it waits for the old snapshot to drain, or the reader picks up the new snapshot.
+         *
+         *  @param in_callback_id ID of the call-back slot to use.
+         *
+         *  @return Registered snapshot, or null if the slot has no subscribers.
+         **/
+        const Callbacks* acquire_callbacks(CallbackID in_callback_id) const
+        {
+            const Callbacks* result_ptr = m_callbacks[in_callback_id].load();
+
+            while (result_ptr != nullptr)
+            {
+                const Callbacks* current_callbacks_ptr = nullptr;
+
+                result_ptr->n_readers.fetch_add(1);
+
+                current_callbacks_ptr = m_callbacks[in_callback_id].load();
+
+                if (current_callbacks_ptr == result_ptr)
+                {
+                    break;
+                }
+
+                release_callbacks(result_ptr);
+                result_ptr = current_callbacks_ptr;
+            }
+
+            return result_ptr;
+        }
+
+        /** Returns a list of providers, for which the calling thread is currently dispatching callbacks. */
+        static std::vector<const CallbacksSupportProvider*>& get_dispatching_providers()
+        {
+            static thread_local std::vector<const CallbacksSupportProvider*> t_dispatching_provider_ptrs;
+
+            return t_dispatching_provider_ptrs;
+        }
+
+        /** Tells whether the calling thread is dispatching callbacks for this object. */
+        bool is_dispatching_callbacks() const
+        {
+            const auto& dispatching_provider_ptrs = get_dispatching_providers();
+
+            return std::find(dispatching_provider_ptrs.begin(),
+                             dispatching_provider_ptrs.end  (),
+                             this) != dispatching_provider_ptrs.end();
+        }
+
+        /** Unregisters the caller as a reader of the specified snapshot. If this was the last reader and
+         *  unregister_from_callbacks() is waiting for a snapshot to drain, wakes it up.
+         *
+         *  @param in_callbacks_ptr Snapshot, as returned by acquire_callbacks(). Must not be null.
+         **/
+        void release_callbacks(const Callbacks* in_callbacks_ptr) const
+        {
+            /* Both counters use seq_cst accesses. Either we see the waiter here, or the waiter sees the
+             * snapshot drained before it goes to sleep. */
+            if (in_callbacks_ptr->n_readers.fetch_sub(1) == 1 &&
+                m_n_drain_waiters.load()                 != 0)
+            {
+                std::unique_lock<std::mutex> lock(m_drain_mutex);
+
+                m_drain_cv.notify_all();
+            }
+        }
+
+        /** Blocks until no callback() invocation is iterating over the specified snapshot. Must be called
+         *  with m_mutex released, and the caller registered in m_n_active_readers so that the snapshot is
+         *  not released in the meantime.
+         *
+         *  @param in_callbacks_ptr Snapshot to wait for. Must not be null.
+         **/
+        void wait_for_callbacks_to_drain(const Callbacks* in_callbacks_ptr) const
+        {
+            m_n_drain_waiters.fetch_add(1);
+            {
+                std::unique_lock<std::mutex> lock(m_drain_mutex);
+
+                m_drain_cv.wait(lock,
+                                [in_callbacks_ptr]()
+                                {
+                                    return in_callbacks_ptr->n_readers.load() == 0;
+                                });
+            }
+            m_n_drain_waiters.fetch_sub(1);
+        }
+
+        /** Releases all retired snapshots. Must be called with m_mutex held, when no reader is registered. */
+        void release_retired_callbacks()
+        {
+            for (auto& current_retired_callbacks_ptr : m_retired_callbacks)
+            {
+                delete current_retired_callbacks_ptr;
+            }
+
+            m_retired_callbacks.clear();
+        }
+
+        /** Makes @param in_new_callbacks_ptr the current snapshot for the specified slot. Must be called with
+         *  m_mutex held.
+         *
+         *  The previous snapshot may still be iterated over by callback() invocations running on other threads
+         *  (or higher up the call stack), so it is retired rather than released. Retired snapshots are released
+         *  as soon as no callback() invocation is in flight.
+         *
+         *  @param in_callback_id       ID of the call-back slot to update.
+         *  @param in_new_callbacks_ptr New snapshot to use. Ownership is transferred. May be null if the slot
+         *                              has no subscribers.
+         **/
+        void publish_callbacks(CallbackID in_callback_id,
+                               Callbacks* in_new_callbacks_ptr)
+        {
+            const Callbacks* old_callbacks_ptr = m_callbacks[in_callback_id].exchange(in_new_callbacks_ptr);
+
+            if (old_callbacks_ptr != nullptr)
+            {
+                m_retired_callbacks.push_back(old_callbacks_ptr);
+            }
+
+            /* Readers register before loading a snapshot. If none is registered now, any reader which
+             * registers later is going to load the new snapshot. */
+            if (m_n_active_readers.load() == 0)
+            {
+                release_retired_callbacks();
+            }
+        }
 
         /* Private variables */
-        CallbackID                   m_callback_id_count;
-        Callbacks*                   m_callbacks;
-        mutable volatile bool        m_callbacks_locked;
-        mutable std::recursive_mutex m_mutex;
+        CallbackID                      m_callback_id_count;
+        std::atomic<const Callbacks*>*  m_callbacks;
+        mutable std::condition_variable m_drain_cv;
+        mutable std::mutex              m_drain_mutex;
+        mutable std::atomic<uint32_t>   m_n_active_readers;
+        mutable std::atomic<uint32_t>   m_n_drain_waiters;
+        mutable std::recursive_mutex    m_mutex;
+        std::vector<const Callbacks*>   m_retired_callbacks;
     };
 } /* namespace Anvil */
 
@@ -0,0 +1,179 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements a linear allocator used by command buffers to stash recorded commands.
+ *
+ *  Memory is carved out of fixed-size chunks. Individual allocations are never released. Instead,
+ *  the whole arena is rewound by a reset() call, after which all chunks allocated so far are reused.
+ *  This means that, once a command buffer has been recorded for the first time, re-recording the
+ *  same set of commands does not touch the heap.
+ *
+ *  Objects constructed in the arena are NOT destroyed by the arena. It is the owner's responsibility
+ *  to call their destructors before rewinding the arena.
+ *
+ *  Command arena is NOT thread-safe.
+ */
+#ifndef MISC_COMMAND_ARENA_H
+#define MISC_COMMAND_ARENA_H
+
+#include "misc/types.h"
+#include <new>
+
+
+namespace Anvil
+{
+    class CommandArena
+    {
+    public:
+        /* Public functions */
+
+        /** Constructor.
+         *
+         *  @param in_chunk_size Size of a single chunk. Allocations larger than this value are
+         *                       served from dedicated chunks. Must not be 0.
+         **/
+        explicit CommandArena(size_t in_chunk_size = 16384);
+
+        /** Destructor. Releases all chunks back to the heap. */
+        ~CommandArena();
+
+        /** Allocates a region of the arena.
+         *
+         *  @param in_size      Number of bytes to allocate.
+         *  @param in_alignment Required alignment of the region. Must be a power of two.
+         *
+         *  @return Pointer to the allocated region. Never null.
+         */
+        void* allocate(size_t in_size,
+                       size_t in_alignment);
+
+        /** Constructs a new object of type T in the arena.
+         *
+         *  @param in_args Arguments to pass to T's constructor.
+         *
+         *  @return Pointer to the new object. Never null.
+         */
+        template<typename T, typename... Args>
+        T* create(Args&&... in_args)
+        {
+            return new (allocate(sizeof(T),
+                                 alignof(T) ))
+                T(std::forward<Args>(in_args)...);
+        }
+
+        /** Rewinds the arena. All regions allocated so far become invalid, but the chunks backing them
+         *  are retained and reused by subsequent allocations. */
+        void reset();
+
+    private:
+        /* Private type definitions */
+        typedef struct Chunk
+        {
+            std::unique_ptr<unsigned char[]> data_ptr;
+            size_t                           size;
+
+            Chunk(size_t in_size)
+                :data_ptr(new unsigned char[in_size]),
+                 size    (in_size)
+            {
+                /* Stub */
+            }
+        } Chunk;
+
+        /* Private variables */
+        size_t             m_chunk_size;
+        std::vector<Chunk> m_chunks;
+        size_t             m_current_chunk_offset;
+        uint32_t           m_n_current_chunk;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(CommandArena);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(CommandArena);
+    };
+
+    /** STL allocator which serves allocations from a CommandArena instance.
+     *
+     *  Deallocation is a no-op. Storage is reclaimed when the arena is reset.
+     */
+    template<typename T>
+    class CommandArenaAllocator
+    {
+    public:
+        /* Public type definitions */
+        typedef T value_type;
+
+        /* Public functions */
+        explicit CommandArenaAllocator(Anvil::CommandArena* in_arena_ptr)
+            :m_arena_ptr(in_arena_ptr)
+        {
+            /* Stub */
+        }
+
+        template<typename U>
+        CommandArenaAllocator(const CommandArenaAllocator<U>& in)
+            :m_arena_ptr(in.get_arena() )
+        {
+            /* Stub */
+        }
+
+        T* allocate(size_t in_n)
+        {
+            return static_cast<T*>(m_arena_ptr->allocate(sizeof(T) * in_n,
+                                                         alignof(T) ));
+        }
+
+        void deallocate(T*     in_ptr,
+                        size_t in_n)
+        {
+            ANVIL_REDUNDANT_ARGUMENT(in_ptr);
+            ANVIL_REDUNDANT_ARGUMENT(in_n);
+        }
+
+        Anvil::CommandArena* get_arena() const
+        {
+            return m_arena_ptr;
+        }
+
+        template<typename U>
+        bool operator==(const CommandArenaAllocator<U>& in) const
+        {
+            return m_arena_ptr == in.get_arena();
+        }
+
+        template<typename U>
+        bool operator!=(const CommandArenaAllocator<U>& in) const
+        {
+            return m_arena_ptr != in.get_arena();
+        }
+
+    private:
+        /* Private variables */
+        Anvil::CommandArena* m_arena_ptr;
+    };
+
+    /** Vector whose storage lives in a CommandArena instance. */
+    template<typename T>
+    using CommandArenaVector = std::vector<T, Anvil::CommandArenaAllocator<T> >;
+
+}; /* namespace Anvil */
+
+#endif /* MISC_COMMAND_ARENA_H */
@@ -0,0 +1,156 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a ring of per-frame command pools ("N frames in flight").
+ *
+ *  Each frame slot owns a transient command pool, the command buffers allocated from it so far and
+ *  a fence. Rather than returning command buffers one by one, begin_frame() waits until the fence of
+ *  the slot it is about to reuse has been signalled, and then resets the slot's command pool in one go.
+ *  Command buffer wrappers allocated for earlier frames are retained and handed out again, so once the
+ *  ring is warm, per-frame command buffer acquisition does not allocate.
+ *
+ *  Command buffers handed out by the ring are owned by the ring. They stay valid until the slot they
+ *  were allocated for is reused, at which point they are back in the initial state.
+ *
+ *  Command buffer frame ring is NOT thread-safe, unless created with @param in_mt_safe set to true.
+ */
+#ifndef MISC_COMMAND_BUFFER_FRAME_RING_H
+#define MISC_COMMAND_BUFFER_FRAME_RING_H
+
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class CommandBufferFrameRing : public MTSafetySupportProvider
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new command buffer frame ring instance.
+         *
+         *  @param in_device_ptr          Device to create the ring for. Must not be null.
+         *  @param in_queue_family_index  Index of the queue family command buffers are going to be submitted to.
+         *  @param in_n_frames_in_flight  Number of frames which can be in flight at any given time. Must not be 0.
+         *  @param in_mt_safe             True if the instance should be thread-safe.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::CommandBufferFrameRingUniquePtr create(Anvil::BaseDevice* in_device_ptr,
+                                                             uint32_t           in_queue_family_index,
+                                                             uint32_t           in_n_frames_in_flight,
+                                                             bool               in_mt_safe = false);
+
+        /** Destructor. Waits for all frames in flight to finish executing. */
+        ~CommandBufferFrameRing();
+
+        /** Moves to the next frame slot.
+         *
+         *  If the slot's fence has been requested with get_fence() when the slot was last used, the call blocks
+         *  until the fence is signalled. The slot's command pool is then reset, which recycles all command buffers
+         *  allocated for the slot at once.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool begin_frame();
+
+        /** Returns the fence associated with the current frame.
+         *
+         *  The fence is reset. Once requested, it MUST be passed to a submission, which executes after all other
+         *  submissions using the frame's command buffers. The next begin_frame() call which reuses the slot
+         *  will wait on it.
+         *
+         *  If the fence is never requested for a frame, the caller must ensure the frame's command buffers have
+         *  finished executing before the slot is reused.
+         */
+        Anvil::Fence* get_fence();
+
+        /** Returns the index of the current frame slot. */
+        uint32_t get_n_current_frame() const
+        {
+            return m_n_current_frame;
+        }
+
+        /** Returns the number of frame slots the ring has been created with. */
+        uint32_t get_n_frames_in_flight() const
+        {
+            return static_cast<uint32_t>(m_frames.size() );
+        }
+
+        /** Returns a primary command buffer in the initial state, which can be used for the current frame.
+         *
+         *  Command buffers allocated for the frame slot in earlier frames are reused if available.
+         *
+         *  @return Requested command buffer or null, if the call failed. The ring retains ownership.
+         */
+        Anvil::PrimaryCommandBuffer* get_primary_command_buffer();
+
+        /** Returns a secondary command buffer in the initial state, which can be used for the current frame.
+         *
+         *  Command buffers allocated for the frame slot in earlier frames are reused if available.
+         *
+         *  @return Requested command buffer or null, if the call failed. The ring retains ownership.
+         */
+        Anvil::SecondaryCommandBuffer* get_secondary_command_buffer();
+
+    private:
+        /* Private type definitions */
+        typedef struct Frame
+        {
+            Anvil::CommandPoolUniquePtr                         command_pool_ptr;
+            Anvil::FenceUniquePtr                               fence_ptr;
+            bool                                                is_fence_pending;
+            uint32_t                                            n_used_primary_command_buffers;
+            uint32_t                                            n_used_secondary_command_buffers;
+            std::vector<Anvil::PrimaryCommandBufferUniquePtr>   primary_command_buffers;
+            std::vector<Anvil::SecondaryCommandBufferUniquePtr> secondary_command_buffers;
+
+            Frame()
+                :is_fence_pending                (false),
+                 n_used_primary_command_buffers  (0),
+                 n_used_secondary_command_buffers(0)
+            {
+                /* Stub */
+            }
+        } Frame;
+
+        /* Private functions */
+        CommandBufferFrameRing(Anvil::BaseDevice* in_device_ptr,
+                               uint32_t           in_queue_family_index,
+                               bool               in_mt_safe);
+
+        bool init          (uint32_t in_n_frames_in_flight);
+        bool wait_for_frame(Frame*   in_frame_ptr);
+
+        /* Private variables */
+        Anvil::BaseDevice* m_device_ptr;
+        std::vector<Frame> m_frames;
+        uint32_t           m_n_current_frame;
+        const uint32_t     m_queue_family_index;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(CommandBufferFrameRing);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(CommandBufferFrameRing);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_COMMAND_BUFFER_FRAME_RING_H */
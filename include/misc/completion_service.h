@@ -0,0 +1,223 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements a device-wide GPU completion call-back service.
+ *
+ *  Subsystems register a call-back together with a fence, or a timeline semaphore & value. A dedicated watcher
+ *  thread waits until the fence becomes signalled, or the semaphore's counter reaches the value, and then hands
+ *  the call-back over to the executor chosen at registration time. This replaces per-frame polling of
+ *  Fence::is_set() scattered across subsystems with a single wait.
+ *
+ *  The watcher thread waits on all registered fences at once with any-semantics. Vulkan offers no way to wake
+ *  up a vkWaitForFences() call from the host, so while fences are being watched, the wait times out every
+ *  get_fence_wait_timeout() nanoseconds to pick up new registrations. If VK_KHR_timeline_semaphore is
+ *  enabled and only timeline semaphores are being watched, the thread blocks without a timeout. New
+ *  registrations wake it up by signalling an internal timeline semaphore.
+ *
+ *  Executors are std::function instances which are passed a call-back and decide where to run it. A null
+ *  executor runs call-backs on the watcher thread, in which case they should be short. get_deferred_executor()
+ *  returns an executor which queues call-backs until run_deferred_callbacks() is called, eg. by the main thread
+ *  at the beginning of each frame.
+ *
+ *  Call-backs whose wait conditions are satisfied at the same time are dispatched in registration order.
+ *
+ *  Fences and semaphores must stay alive, and fences must not be reset, until their call-backs have been
+ *  dispatched. Call-backs still pending when the service is destroyed are dropped without being invoked.
+ *
+ *  If a wait fails (eg. because the device has been lost), the watcher thread stops. All pending call-backs,
+ *  as well as those registered afterward, are then dropped without being invoked. has_failed() tells whether
+ *  this has happened.
+ *
+ *  This object should ONLY be instantiated by Anvil::BaseDevice.
+ *
+ *  Completion service is thread-safe.
+ */
+#ifndef MISC_COMPLETION_SERVICE_H
+#define MISC_COMPLETION_SERVICE_H
+
+#include "misc/types.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+
+namespace Anvil
+{
+    class CompletionService
+    {
+    public:
+        /* Public type definitions */
+        typedef std::function<void()> Callback;
+
+        /** Executor prototype. Implementations must eventually invoke the call-back they are passed, on a thread
+         *  of their choice. */
+        typedef std::function<void(const Callback& in_callback)> Executor;
+
+        /* Public functions */
+
+        /** Creates a new completion service instance and spawns the watcher thread.
+         *
+         *  @param in_device_ptr Device to create the service for. Must not be null.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::CompletionServiceUniquePtr create(const Anvil::BaseDevice* in_device_ptr);
+
+        /** Destructor. Joins the watcher thread. Pending call-backs are dropped. */
+        ~CompletionService();
+
+        /** Registers @param in_callback to be dispatched once @param in_fence_ptr becomes signalled.
+         *
+         *  @param in_fence_ptr     Fence to watch. Must not be null.
+         *  @param in_callback      Call-back to dispatch. Must not be null.
+         *  @param in_opt_executor  Executor to hand the call-back over to. If null, the call-back is invoked
+         *                          on the watcher thread.
+         *
+         *  @return ID of the registration, which can be passed to cancel(). IDs are never 0.
+         */
+        uint64_t add_fence_callback(Anvil::Fence*   in_fence_ptr,
+                                    const Callback& in_callback,
+                                    const Executor& in_opt_executor = Executor() );
+
+        /** Registers @param in_callback to be dispatched once the counter of @param in_semaphore_ptr reaches
+         *  @param in_value.
+         *
+         *  Requires VK_KHR_timeline_semaphore.
+         *
+         *  @param in_semaphore_ptr Timeline semaphore to watch. Must not be null.
+         *  @param in_value         Value to wait for.
+         *  @param in_callback      Call-back to dispatch. Must not be null.
+         *  @param in_opt_executor  Please see add_fence_callback() for more details.
+         *
+         *  @return ID of the registration, which can be passed to cancel(). IDs are never 0.
+         */
+        uint64_t add_timeline_callback(Anvil::Semaphore* in_semaphore_ptr,
+                                       uint64_t          in_value,
+                                       const Callback&   in_callback,
+                                       const Executor&   in_opt_executor = Executor() );
+
+        /** Cancels a registration, so that its call-back is never dispatched.
+         *
+         *  If the watcher thread is waiting on the registration's fence or semaphore, the function wakes it up
+         *  and waits until the wait returns, so that the object can be released as soon as the function
+         *  returns true. Must not be called from a call-back running on the watcher thread.
+         *
+         *  @return true if the registration has been cancelled, false if its call-back has already been
+         *          dispatched (or is being dispatched), or if the ID is unknown.
+         */
+        bool cancel(uint64_t in_id);
+
+        /** Returns an executor which queues call-backs until run_deferred_callbacks() is called. The executor
+         *  must not outlive the service. */
+        Executor get_deferred_executor();
+
+        /** Returns the timeout used for fence waits, expressed in nanoseconds. */
+        uint64_t get_fence_wait_timeout() const
+        {
+            return m_fence_wait_timeout_ns;
+        }
+
+        /** Returns the number of registrations whose call-backs have not been dispatched yet. */
+        uint32_t get_n_pending_callbacks() const;
+
+        /** Tells whether the watcher thread has stopped because a wait failed. */
+        bool has_failed() const;
+
+        /** Invokes all call-backs queued by the deferred executor on the calling thread, in the order they have
+         *  been queued in.
+         *
+         *  @return Number of call-backs invoked.
+         */
+        uint32_t run_deferred_callbacks();
+
+        /** Sets the timeout used for fence waits. Shorter timeouts make the service pick up new fence registrations
+         *  sooner, at the expense of waking up the watcher thread more often. Default value is 1 ms.
+         *
+         *  @param in_timeout_ns Timeout, expressed in nanoseconds. Must not be 0.
+         */
+        void set_fence_wait_timeout(uint64_t in_timeout_ns);
+
+        /** Blocks until all call-backs registered prior to this call have been handed over to their executors.
+         *  Call-backs queued by the deferred executor are not invoked.
+         *
+         *  Must not be called from a call-back running on the watcher thread.
+         */
+        void wait_idle();
+
+    private:
+        /* Private type definitions */
+        typedef struct Watch
+        {
+            Callback          callback;
+            Executor          executor;
+            Anvil::Fence*     fence_ptr;
+            uint64_t          id;
+            Anvil::Semaphore* semaphore_ptr;
+            uint64_t          semaphore_value;
+
+            Watch()
+                :fence_ptr      (nullptr),
+                 id             (0),
+                 semaphore_ptr  (nullptr),
+                 semaphore_value(0)
+            {
+                /* Stub */
+            }
+        } Watch;
+
+        /* Private functions */
+        explicit CompletionService(const Anvil::BaseDevice* in_device_ptr);
+
+        uint64_t add_watch  (const Watch& in_watch);
+        bool     init       ();
+        void     thread_main();
+        void     wake_up    ();
+
+        /* Private variables */
+        std::deque<Callback>           m_deferred_callbacks;
+        std::mutex                     m_deferred_callbacks_mutex;
+        const Anvil::BaseDevice*       m_device_ptr;
+        std::atomic<uint64_t>          m_fence_wait_timeout_ns;
+        bool                           m_has_failed;
+        bool                           m_is_waiting;
+        uint32_t                       m_n_watches_being_dispatched;
+        uint64_t                       m_next_watch_id;
+        bool                           m_should_quit;
+        std::thread                    m_thread;
+        uint64_t                       m_wait_generation;
+        Anvil::SemaphoreUniquePtr      m_wake_semaphore_ptr;
+        uint64_t                       m_wake_semaphore_value;
+        std::deque<Watch>              m_watches;  /* Sorted by ID */
+
+        std::condition_variable        m_dispatched_cv;
+        mutable std::mutex             m_mutex;
+        std::condition_variable        m_wake_cv;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(CompletionService);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(CompletionService);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_COMPLETION_SERVICE_H */
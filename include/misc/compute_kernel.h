@@ -0,0 +1,212 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements a dispatch helper for compute pipelines.
+ *
+ *  The kernel reflects the compute shader of a pipeline registered with the device's compute pipeline manager, and
+ *  reads its local workgroup size. If any of the size components is driven by a specialization constant, the value
+ *  assigned to the constant in the pipeline create info is used, or the constant's default value, if the pipeline
+ *  does not specialize it. record_dispatch() then converts a problem size, expressed in invocations, to workgroup
+ *  counts.
+ *
+ *  Many small dispatches of the same kernel can also be merged into a single indirect dispatch. Each dispatch added
+ *  with add_batched_dispatch() is assigned a contiguous range of workgroups. bake_batch() lays out the following data
+ *  in a transient buffer region:
+ *
+ *  - VkDispatchIndirectCommand, with groupCountX set to the total number of workgroups, at offset 0.
+ *  - uint32 holding the number of dispatches in the batch, at offset 12.
+ *  - For each dispatch, a pair of uint32s holding the index of its first workgroup and the number of invocations
+ *    it has been given, starting at offset 16.
+ *
+ *  When bound as a storage buffer, the region matches the following std430 block:
+ *
+ *      layout(std430) readonly buffer Batch
+ *      {
+ *          uvec3 dispatch_command;
+ *          uint  n_dispatches;
+ *          uvec2 dispatches[]; // first workgroup, number of invocations
+ *      };
+ *
+ *  The batched dispatch is one-dimensional, so a shader used with batches must find the dispatch its workgroup
+ *  belongs to (eg. with a binary search over dispatches[].x for gl_WorkGroupID.x), and address invocations with
+ *  gl_LocalInvocationIndex. Invocations whose index is equal to or larger than the dispatch's invocation count
+ *  must return early.
+ *
+ *  Compute kernel is NOT thread-safe.
+ */
+#ifndef MISC_COMPUTE_KERNEL_H
+#define MISC_COMPUTE_KERNEL_H
+
+#include "misc/transient_buffer_allocator.h"
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class ComputeKernel
+    {
+    public:
+        /* Public type definitions */
+
+        /** Describes a baked batch of dispatches. */
+        typedef struct Batch
+        {
+            /* Region holding the dispatch arguments and the dispatch table */
+            Anvil::TransientBufferAllocator::Allocation allocation;
+
+            uint32_t                                    n_dispatches;
+            uint32_t                                    n_workgroups;
+
+            Batch()
+                :n_dispatches(0),
+                 n_workgroups(0)
+            {
+                /* Stub */
+            }
+        } Batch;
+
+        /* Public functions */
+
+        /** Creates a new compute kernel instance.
+         *
+         *  @param in_device_ptr  Device to use. Must not be null.
+         *  @param in_pipeline_id ID of a compute pipeline, registered with the device's compute pipeline manager.
+         *
+         *  @return New instance if successful, null if the pipeline could not be found or its compute shader could
+         *          not be reflected.
+         */
+        static Anvil::ComputeKernelUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
+                                                    PipelineID               in_pipeline_id);
+
+        /** Destructor. */
+        ~ComputeKernel();
+
+        /** Appends a dispatch to the pending batch.
+         *
+         *  @param in_n_invocations Number of invocations the dispatch needs. Must not be 0. The dispatch is given enough
+         *                          workgroups to cover that many invocations.
+         *
+         *  @return Index of the dispatch within the batch.
+         */
+        uint32_t add_batched_dispatch(uint32_t in_n_invocations);
+
+        /** Writes the pending batch to a transient buffer region and resets it, so that a new batch can be built.
+         *
+         *  @param in_allocator_ptr Allocator to sub-allocate the region from. Must not be null. Must have been created
+         *                          with INDIRECT_BUFFER usage, as well as STORAGE_BUFFER usage if the dispatch table
+         *                          is going to be accessed by the shader.
+         *  @param out_batch_ptr    Deref will be set to the baked batch's details. Must not be null.
+         *
+         *  @return true if successful, false if the batch is empty, if it needs more workgroups than the device can
+         *          dispatch in a single call, or if the region could not be allocated.
+         */
+        bool bake_batch(Anvil::TransientBufferAllocator* in_allocator_ptr,
+                        Batch*                           out_batch_ptr);
+
+        /** Returns the local workgroup size of the kernel. */
+        const std::array<uint32_t, 3>& get_local_workgroup_size() const
+        {
+            return m_local_workgroup_size;
+        }
+
+        /** Returns the number of dispatches added to the pending batch so far. */
+        uint32_t get_n_batched_dispatches() const
+        {
+            return static_cast<uint32_t>(m_batched_dispatches.size() );
+        }
+
+        /** Returns the number of workgroups needed to cover the specified problem size.
+         *
+         *  @param in_x             Number of invocations needed along the X axis.
+         *  @param in_y             Number of invocations needed along the Y axis.
+         *  @param in_z             Number of invocations needed along the Z axis.
+         *  @param out_n_groups_ptr Deref will be set to the workgroup counts. Must not be null.
+         *
+         *  @return true if successful, false if any of the counts exceeds the device's limits.
+         */
+        bool get_n_workgroups(uint32_t                 in_x,
+                              uint32_t                 in_y,
+                              uint32_t                 in_z,
+                              std::array<uint32_t, 3>* out_n_groups_ptr) const;
+
+        /** Returns ID of the pipeline the kernel has been created for. */
+        PipelineID get_pipeline_id() const
+        {
+            return m_pipeline_id;
+        }
+
+        /** Records an indirect dispatch which executes a batch baked earlier.
+         *
+         *  The kernel's pipeline, as well as any descriptor sets it needs, must have been bound to the command buffer.
+         *  The batch's region must not have been recycled by the allocator.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the dispatch in. Must not be null.
+         *  @param in_batch          Batch to dispatch.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_batch(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                          const Batch&              in_batch) const;
+
+        /** Records a dispatch which covers the specified problem size.
+         *
+         *  The kernel's pipeline, as well as any descriptor sets it needs, must have been bound to the command buffer.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the dispatch in. Must not be null.
+         *  @param in_x              Number of invocations needed along the X axis.
+         *  @param in_y              Number of invocations needed along the Y axis.
+         *  @param in_z              Number of invocations needed along the Z axis.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_dispatch(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                             uint32_t                  in_x,
+                             uint32_t                  in_y = 1,
+                             uint32_t                  in_z = 1) const;
+
+        /** Drops all dispatches added to the pending batch. */
+        void reset_batch()
+        {
+            m_batched_dispatches.clear();
+            m_n_batched_workgroups = 0;
+        }
+
+    private:
+        /* Private functions */
+        ComputeKernel(const Anvil::BaseDevice*       in_device_ptr,
+                      PipelineID                     in_pipeline_id,
+                      const std::array<uint32_t, 3>& in_local_workgroup_size);
+
+        /* Private variables */
+        std::vector<uint32_t>    m_batched_dispatches; /* first workgroup, number of invocations */
+        const Anvil::BaseDevice* m_device_ptr;
+        std::array<uint32_t, 3>  m_local_workgroup_size;
+        uint64_t                 m_n_batched_workgroups;
+        PipelineID               m_pipeline_id;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(ComputeKernel);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(ComputeKernel);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_COMPUTE_KERNEL_H */
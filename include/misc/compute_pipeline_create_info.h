@@ -56,10 +56,76 @@ namespace Anvil
                                                                        in_data_ptr);
         }
 
+        /** Returns the subgroup size the compute stage is required to use, or 0 if no requirement has been specified. */
+        uint32_t get_required_subgroup_size() const
+        {
+            return m_required_subgroup_size;
+        }
+
+        /** Tells whether the compute stage must be launched with full subgroups only. */
+        bool get_require_full_subgroups() const
+        {
+            return m_require_full_subgroups;
+        }
+
+        /** Tells whether the subgroup size is allowed to vary throughout the compute stage. */
+        bool is_varying_subgroup_size_allowed() const
+        {
+            return m_allow_varying_subgroup_size;
+        }
+
+        /** Allows the implementation to use any subgroup size between min_subgroup_size and max_subgroup_size, as reported by
+         *  EXTSubgroupSizeControlProperties, when running the compute stage.
+         *
+         *  Requires VK_EXT_subgroup_size_control and the subgroup_size_control feature to be enabled. The setting is ignored at
+         *  bake time otherwise.
+         *
+         *  Not allowed by default.
+         **/
+        void set_allow_varying_subgroup_size(bool in_allow_varying_subgroup_size)
+        {
+            m_allow_varying_subgroup_size = in_allow_varying_subgroup_size;
+        }
+
+        /** Requires all subgroups of the compute stage to be fully populated. The workgroup's X dimension must be a multiple of
+         *  the subgroup size the pipeline runs with.
+         *
+         *  Requires VK_EXT_subgroup_size_control and the compute_full_subgroups feature to be enabled. The setting is ignored at
+         *  bake time otherwise.
+         *
+         *  Not required by default.
+         **/
+        void set_require_full_subgroups(bool in_require_full_subgroups)
+        {
+            m_require_full_subgroups = in_require_full_subgroups;
+        }
+
+        /** Requests the compute stage to be run with a specific subgroup size, eg. to pick between wave32 and wave64 execution on
+         *  hardware which supports both.
+         *
+         *  Requires VK_EXT_subgroup_size_control with the subgroup_size_control feature enabled, and the compute stage to be
+         *  reported in EXTSubgroupSizeControlProperties::required_subgroup_size_stages. The requirement is ignored at bake
+         *  time otherwise.
+         *
+         *  @param in_subgroup_size                  Power of two between min_subgroup_size and max_subgroup_size, as reported by
+         *                                           EXTSubgroupSizeControlProperties. 0 removes a previously set requirement.
+         *  @param in_opt_specialization_constant_id If not UINT32_MAX, the subgroup size is also assigned, as a uint32, to the
+         *                                           specialization constant of the specified ID. This lets the shader size its
+         *                                           shared memory and loops for the subgroup size it is going to run with.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool set_required_subgroup_size(uint32_t in_subgroup_size,
+                                        uint32_t in_opt_specialization_constant_id = UINT32_MAX);
+
         ~ComputePipelineCreateInfo();
 
     private:
         ComputePipelineCreateInfo();
+
+        bool     m_allow_varying_subgroup_size;
+        bool     m_require_full_subgroups;
+        uint32_t m_required_subgroup_size;
     };
 };
 
@@ -0,0 +1,361 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements GPU-side parallel primitives operating on Anvil::Buffer regions:
+ *
+ *  - inclusive and exclusive prefix sums (scans) of uint32 elements.
+ *  - stream compaction, which copies the uint32 elements whose flags are non-zero to a tightly packed output, and
+ *    writes the number of elements kept.
+ *  - stable LSD radix sort of uint32 or uint64 keys, optionally carrying a uint32 value per key. Keys are sorted
+ *    as unsigned integers, so signed or floating-point keys need to be remapped by the app beforehand.
+ *
+ *  Each primitive is recorded as a sequence of compute dispatches, separated by compute-to-compute memory barriers.
+ *  Scans handle 4 elements per invocation. Inputs which need more than one workgroup are scanned in blocks, the block
+ *  sums are scanned recursively, and the results are added back. Radix sort processes 4 bits per pass. Each pass
+ *  builds per-workgroup digit histograms, scans them, and scatters keys to their final positions after sorting them
+ *  locally with a stable split per bit.
+ *
+ *  Kernels are specialized at creation time. If the device supports subgroup arithmetic in compute shaders, workgroup
+ *  reductions use subgroup operations, and the workgroup size and subgroup size are passed to the kernels as
+ *  specialization constants 0 and 1. Otherwise, a shared memory implementation is used.
+ *
+ *  Primitives need caller-provided scratch memory, whose size is reported by get_*_scratch_buffer_size(). All buffers
+ *  must have been created with STORAGE_BUFFER usage, and all offsets must be multiples of the device's
+ *  minStorageBufferOffsetAlignment limit. Input and output ranges must not overlap, unless stated otherwise.
+ *
+ *  The caller is responsible for making earlier writes to input buffers available to compute shaders, and for
+ *  synchronizing later accesses to the results, which are written by compute shaders.
+ *
+ *  Shaders are compiled at creation time with GLSLShaderToSPIRVGenerator, so the primitives require Anvil to be built
+ *  with ANVIL_LINK_WITH_GLSLANG defined.
+ *
+ *  Compute primitives are NOT thread-safe.
+ */
+#ifndef MISC_COMPUTE_PRIMITIVES_H
+#define MISC_COMPUTE_PRIMITIVES_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class ComputePrimitives
+    {
+    public:
+        /* Public type definitions */
+        enum class KeyType
+        {
+            UINT32,
+            UINT64
+        };
+
+        enum class ScanType
+        {
+            EXCLUSIVE,
+            INCLUSIVE
+        };
+
+        /** Describes a single stream compaction. */
+        typedef struct CompactionInfo
+        {
+            /* Buffer to store the number of kept elements in, as a single uint32. */
+            Anvil::Buffer* count_buffer_ptr;
+            VkDeviceSize   count_buffer_offset;
+
+            /* Buffer holding n_elements uint32 flags. Elements whose flags are non-zero are kept. */
+            Anvil::Buffer* flag_buffer_ptr;
+            VkDeviceSize   flag_buffer_offset;
+
+            /* Buffer holding n_elements uint32 input elements. */
+            Anvil::Buffer* input_buffer_ptr;
+            VkDeviceSize   input_buffer_offset;
+
+            /* Buffer to store the kept elements in, in their original order. Must have space for n_elements items. */
+            Anvil::Buffer* output_buffer_ptr;
+            VkDeviceSize   output_buffer_offset;
+
+            /* Scratch memory. Must hold at least get_compaction_scratch_buffer_size(n_elements) bytes. */
+            Anvil::Buffer* scratch_buffer_ptr;
+            VkDeviceSize   scratch_buffer_offset;
+
+            uint32_t       n_elements;
+
+            CompactionInfo()
+                :count_buffer_ptr     (nullptr),
+                 count_buffer_offset  (0),
+                 flag_buffer_ptr      (nullptr),
+                 flag_buffer_offset   (0),
+                 input_buffer_ptr     (nullptr),
+                 input_buffer_offset  (0),
+                 output_buffer_ptr    (nullptr),
+                 output_buffer_offset (0),
+                 scratch_buffer_ptr   (nullptr),
+                 scratch_buffer_offset(0),
+                 n_elements           (0)
+            {
+                /* Stub */
+            }
+        } CompactionInfo;
+
+        /** Describes a single scan. */
+        typedef struct ScanInfo
+        {
+            /* Buffer holding n_elements uint32 input elements. */
+            Anvil::Buffer* input_buffer_ptr;
+            VkDeviceSize   input_buffer_offset;
+
+            /* Buffer to store n_elements uint32 prefix sums in. May be the same range as the input, in which case
+             * the scan is performed in place. */
+            Anvil::Buffer* output_buffer_ptr;
+            VkDeviceSize   output_buffer_offset;
+
+            /* Scratch memory. Must hold at least get_scan_scratch_buffer_size(n_elements) bytes, which may be 0. */
+            Anvil::Buffer* scratch_buffer_ptr;
+            VkDeviceSize   scratch_buffer_offset;
+
+            uint32_t       n_elements;
+            ScanType       type;
+
+            ScanInfo()
+                :input_buffer_ptr     (nullptr),
+                 input_buffer_offset  (0),
+                 output_buffer_ptr    (nullptr),
+                 output_buffer_offset (0),
+                 scratch_buffer_ptr   (nullptr),
+                 scratch_buffer_offset(0),
+                 n_elements           (0),
+                 type                 (ScanType::EXCLUSIVE)
+            {
+                /* Stub */
+            }
+        } ScanInfo;
+
+        /** Describes a single radix sort. Keys and values are sorted in place. */
+        typedef struct SortInfo
+        {
+            /* Buffer holding n_elements keys, either uint32 or uint64, as specified by key_type. */
+            Anvil::Buffer* key_buffer_ptr;
+            VkDeviceSize   key_buffer_offset;
+            KeyType        key_type;
+
+            /* Number of least significant key bits to sort by. Higher bits are assumed to be 0. 0 means all bits. */
+            uint32_t       n_key_bits;
+
+            /* Scratch memory. Must hold at least get_sort_scratch_buffer_size() bytes. */
+            Anvil::Buffer* scratch_buffer_ptr;
+            VkDeviceSize   scratch_buffer_offset;
+
+            /* Optional buffer holding n_elements uint32 values, which are reordered along with the keys. */
+            Anvil::Buffer* value_buffer_ptr;
+            VkDeviceSize   value_buffer_offset;
+
+            uint32_t       n_elements;
+
+            SortInfo()
+                :key_buffer_ptr       (nullptr),
+                 key_buffer_offset    (0),
+                 key_type             (KeyType::UINT32),
+                 n_key_bits           (0),
+                 scratch_buffer_ptr   (nullptr),
+                 scratch_buffer_offset(0),
+                 value_buffer_ptr     (nullptr),
+                 value_buffer_offset  (0),
+                 n_elements           (0)
+            {
+                /* Stub */
+            }
+        } SortInfo;
+
+        /* Public functions */
+
+        /** Creates a new compute primitives instance. Compiles the kernels and bakes the compute pipelines.
+         *
+         *  @param in_device_ptr Device to create the primitives for. Must not be null.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::ComputePrimitivesUniquePtr create(const Anvil::BaseDevice* in_device_ptr);
+
+        /** Destructor. The caller must make sure none of the recorded primitives is still executed by the GPU. */
+        ~ComputePrimitives();
+
+        /** Returns the number of scratch bytes a compaction of the specified number of elements needs. */
+        VkDeviceSize get_compaction_scratch_buffer_size(uint32_t in_n_elements) const;
+
+        /** Returns the number of scratch bytes a scan of the specified number of elements needs. */
+        VkDeviceSize get_scan_scratch_buffer_size(uint32_t in_n_elements) const;
+
+        /** Returns the number of scratch bytes a sort of the specified number of elements needs.
+         *
+         *  @param in_key_type   Type of the keys.
+         *  @param in_n_elements Number of keys.
+         *  @param in_has_values true if values are going to be sorted along with the keys, false otherwise.
+         */
+        VkDeviceSize get_sort_scratch_buffer_size(KeyType  in_key_type,
+                                                  uint32_t in_n_elements,
+                                                  bool     in_has_values) const;
+
+        /** Returns the subgroup size the kernels have been specialized for, or 0 if subgroup operations are not used. */
+        uint32_t get_subgroup_size() const
+        {
+            return m_subgroup_size;
+        }
+
+        /** Returns the number of invocations in each workgroup of the kernels. */
+        uint32_t get_workgroup_size() const
+        {
+            return m_workgroup_size;
+        }
+
+        /** Records a stream compaction. Must be called outside a renderpass.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the commands to. Must be in recording state and must
+         *                           support compute operations.
+         *  @param in_info           Compaction description.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_compaction(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                               const CompactionInfo&     in_info);
+
+        /** Records a scan. Must be called outside a renderpass.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the commands to. Must be in recording state and must
+         *                           support compute operations.
+         *  @param in_info           Scan description.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_scan(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                         const ScanInfo&           in_info);
+
+        /** Records a radix sort. Must be called outside a renderpass.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the commands to. Must be in recording state and must
+         *                           support compute operations.
+         *  @param in_info           Sort description.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_sort(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                         const SortInfo&           in_info);
+
+    private:
+        /* Private type definitions */
+        enum
+        {
+            KERNEL_ADD_BLOCK_OFFSETS,
+            KERNEL_COMPACT,
+            KERNEL_RADIX_HISTOGRAM_32,
+            KERNEL_RADIX_HISTOGRAM_64,
+            KERNEL_RADIX_SCATTER_32,
+            KERNEL_RADIX_SCATTER_64,
+            KERNEL_SCAN,
+
+            KERNEL_COUNT
+        };
+
+        /* Matches the kernels' push constant block */
+        typedef struct PushConstants
+        {
+            uint32_t n_elements;
+            uint32_t n_blocks;
+            uint32_t flags;
+            uint32_t shift;
+
+            PushConstants()
+                :n_elements(0),
+                 n_blocks  (0),
+                 flags     (0),
+                 shift     (0)
+            {
+                /* Stub */
+            }
+        } PushConstants;
+
+        typedef struct Kernel
+        {
+            Anvil::DescriptorSetLayoutUniquePtr                 ds_layout_ptr;
+            std::unique_ptr<Anvil::ShaderModuleStageEntryPoint> entrypoint_ptr;
+            uint32_t                                            n_bindings;
+            Anvil::PipelineID                                   pipeline_id;
+            Anvil::ShaderModuleUniquePtr                        shader_module_ptr;
+
+            Kernel()
+                :n_bindings (0),
+                 pipeline_id(UINT32_MAX)
+            {
+                /* Stub */
+            }
+        } Kernel;
+
+        typedef struct BufferRange
+        {
+            Anvil::Buffer* buffer_ptr;
+            VkDeviceSize   offset;
+            VkDeviceSize   size;
+
+            BufferRange(Anvil::Buffer* in_buffer_ptr,
+                        VkDeviceSize   in_offset,
+                        VkDeviceSize   in_size)
+                :buffer_ptr(in_buffer_ptr),
+                 offset    (in_offset),
+                 size      (in_size)
+            {
+                /* Stub */
+            }
+        } BufferRange;
+
+        /* Private functions */
+        ComputePrimitives(const Anvil::BaseDevice* in_device_ptr);
+
+        VkDeviceSize align_scratch_size  (VkDeviceSize in_size) const;
+        uint32_t     get_n_scan_blocks   (uint32_t     in_n_elements) const;
+        bool         init                ();
+        bool         init_kernel         (uint32_t     in_n_kernel);
+        bool         record_barrier      (Anvil::CommandBufferBase* in_cmd_buffer_ptr) const;
+        bool         record_kernel       (Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                          uint32_t                  in_n_kernel,
+                                          const PushConstants&      in_push_constants,
+                                          const BufferRange*        in_buffer_ranges);
+        bool         record_scan_level   (Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                          const BufferRange&        in_input_range,
+                                          const BufferRange&        in_output_range,
+                                          Anvil::Buffer*            in_scratch_buffer_ptr,
+                                          VkDeviceSize              in_scratch_buffer_offset,
+                                          uint32_t                  in_n_elements,
+                                          uint32_t                  in_flags);
+
+        /* Private variables */
+        const Anvil::BaseDevice*           m_device_ptr;
+        Anvil::DescriptorSetCacheUniquePtr m_ds_cache_ptr;
+        Kernel                             m_kernels[KERNEL_COUNT];
+        uint32_t                           m_subgroup_size;
+        uint32_t                           m_workgroup_size;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(ComputePrimitives);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(ComputePrimitives);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_COMPUTE_PRIMITIVES_H */
@@ -143,8 +143,15 @@ namespace Anvil
      *  Vulkan handles. set_*() function invocations will automatically update corresponding information
      *  for all associated Vulkan handles.
      *
+     *  Workers, which hold the name & tag storage, are only allocated at the first set_name() or set_tag() call.
+     *  Objects which are never named only store their Vulkan handles.
+     *
      *  If VK_EXT_debug_marker extension is enabled, relevant API calls will share the information with
-     *  the implementation(s).
+     *  the implementation(s). If VK_EXT_debug_utils is used instead, the information is only forwarded while
+     *  a debug messenger is alive for the parent instance.
+     *
+     *  If Anvil is built with ANVIL_STRIP_DEBUG_NAMES, the class only holds the device pointer and all set_*() calls
+     *  are no-ops.
      */
     template<class Wrapper>
     class DebugMarkerSupportProvider
@@ -163,22 +170,23 @@ namespace Anvil
         DebugMarkerSupportProvider(const Anvil::BaseDevice* in_device_ptr,
                                    const Anvil::ObjectType& in_object_type,
                                    bool                     in_use_delegate_workers = false)
+        #if !defined(ANVIL_STRIP_DEBUG_NAMES)
+            :m_device_ptr          (in_device_ptr),
+             m_use_delegate_workers(in_use_delegate_workers),
+             m_vk_object_type      (in_object_type),
+             m_vk_object_handle    (VK_NULL_HANDLE)
+        #else
+            :m_device_ptr          (in_device_ptr)
+        #endif
         {
             anvil_assert(in_device_ptr != nullptr);
 
-            m_device_ptr = in_device_ptr;
-
-            if (!in_use_delegate_workers)
+            #if defined(ANVIL_STRIP_DEBUG_NAMES)
             {
-                m_worker_ptr.reset(
-                    new DebugMarkerSupportProviderWorker(in_device_ptr,
-                                                         in_object_type)
-                );
-            }
-            else
-            {
-                m_vk_object_type = in_object_type;
+                ANVIL_REDUNDANT_ARGUMENT_CONST(in_object_type);
+                ANVIL_REDUNDANT_ARGUMENT_CONST(in_use_delegate_workers);
             }
+            #endif
         }
 
         /** Destructor */
@@ -198,56 +206,49 @@ namespace Anvil
          */
         void add_delegate(uint64_t in_vk_object_handle)
         {
-            Anvil::DebugMarkerSupportProviderWorker* new_delegate_raw_ptr = nullptr;
-
+            #if !defined(ANVIL_STRIP_DEBUG_NAMES)
             {
-                std::unique_ptr<Anvil::DebugMarkerSupportProviderWorker> new_delegate_ptr;
-
-                anvil_assert(m_worker_ptr == nullptr);
+                anvil_assert(m_use_delegate_workers);
 
                 #ifdef _DEBUG
                 {
-                    for (auto& delegate_ptr : m_delegate_workers)
+                    for (const auto& current_vk_object_handle : m_delegate_vk_object_handles)
                     {
-                        anvil_assert(delegate_ptr->get_vk_handle_internal() != in_vk_object_handle);
+                        anvil_assert(current_vk_object_handle != in_vk_object_handle);
                     }
                 }
                 #endif
 
-                new_delegate_ptr.reset(
-                    new Anvil::DebugMarkerSupportProviderWorker(m_device_ptr,
-                                                                m_vk_object_type)
-                );
-
-                new_delegate_ptr->set_vk_handle_internal(in_vk_object_handle);
-
-                new_delegate_raw_ptr = new_delegate_ptr.get();
+                m_delegate_vk_object_handles.push_back(in_vk_object_handle);
 
-                m_delegate_workers.push_back(
-                    std::move(new_delegate_ptr)
-                );
-            }
-
-            if (m_delegate_workers.size() > 1)
-            {
-                /* Make sure to copy already assigned name & tag to the new delegate */
-                auto&                    existing_delegate_worker_ptr          = m_delegate_workers.at(0);
-                auto                     existing_delegate_worker_name         = existing_delegate_worker_ptr->get_name();
-                const std::vector<char>* existing_delegate_worker_tag_data_ptr = nullptr; 
-                uint64_t                 existing_delegate_worker_tag_name     = 0;
+                if (m_delegate_workers.size() > 0)
+                {
+                    /* The object has already been named or tagged. Make sure to copy already assigned name & tag
+                     * to the new delegate */
+                    auto&                    existing_delegate_worker_ptr          = m_delegate_workers.at(0);
+                    auto                     existing_delegate_worker_name         = existing_delegate_worker_ptr->get_name();
+                    const std::vector<char>* existing_delegate_worker_tag_data_ptr = nullptr;
+                    uint64_t                 existing_delegate_worker_tag_name     = 0;
+                    auto                     new_delegate_raw_ptr                  = create_worker(in_vk_object_handle);
 
-                existing_delegate_worker_ptr->get_tag(&existing_delegate_worker_tag_data_ptr,
-                                                      &existing_delegate_worker_tag_name);
+                    existing_delegate_worker_ptr->get_tag(&existing_delegate_worker_tag_data_ptr,
+                                                          &existing_delegate_worker_tag_name);
 
-                new_delegate_raw_ptr->set_name_internal(existing_delegate_worker_name.c_str() );
+                    new_delegate_raw_ptr->set_name_internal(existing_delegate_worker_name.c_str() );
 
-                if (existing_delegate_worker_tag_data_ptr->size() > 0)
-                {
-                    new_delegate_raw_ptr->set_tag_internal (existing_delegate_worker_tag_name,
-                                                            existing_delegate_worker_tag_data_ptr->size(),
-                                                           &existing_delegate_worker_tag_data_ptr->at(0) );
+                    if (existing_delegate_worker_tag_data_ptr->size() > 0)
+                    {
+                        new_delegate_raw_ptr->set_tag_internal (existing_delegate_worker_tag_name,
+                                                                existing_delegate_worker_tag_data_ptr->size(),
+                                                               &existing_delegate_worker_tag_data_ptr->at(0) );
+                    }
                 }
             }
+            #else
+            {
+                ANVIL_REDUNDANT_ARGUMENT(in_vk_object_handle);
+            }
+            #endif
         }
 
         template<class T>
@@ -258,6 +259,28 @@ namespace Anvil
             add_delegate(handle_uint64);
         }
 
+        /** Returns the name assigned to the object with a set_name() call, or an empty string if the object
+         *  has not been named.
+         */
+        std::string get_name() const
+        {
+            #if !defined(ANVIL_STRIP_DEBUG_NAMES)
+            {
+                if (m_worker_ptr != nullptr)
+                {
+                    return m_worker_ptr->get_name();
+                }
+
+                if (m_delegate_workers.size() > 0)
+                {
+                    return m_delegate_workers.at(0)->get_name();
+                }
+            }
+            #endif
+
+            return std::string();
+        }
+
         /** Drops a Vulkan object handle previously registered with an add_delegate() call.
          *
          *  Must not be called if the provider instance was created with @param in_use_delegate_workers arg
@@ -267,24 +290,36 @@ namespace Anvil
          */
         void remove_delegate(uint64_t in_vk_object_handle)
         {
-            std::vector<std::unique_ptr<DebugMarkerSupportProviderWorker> >::iterator worker_iterator;
+            #if !defined(ANVIL_STRIP_DEBUG_NAMES)
+            {
+                uint32_t n_delegate = 0;
 
-            anvil_assert(m_worker_ptr == nullptr);
+                anvil_assert(m_use_delegate_workers);
 
-            for (worker_iterator  = m_delegate_workers.begin();
-                 worker_iterator != m_delegate_workers.end();
-               ++worker_iterator)
-            {
-                auto& current_worker_ptr = *worker_iterator;
+                for (n_delegate = 0;
+                     n_delegate < static_cast<uint32_t>(m_delegate_vk_object_handles.size() );
+                   ++n_delegate)
+                {
+                    if (m_delegate_vk_object_handles.at(n_delegate) == in_vk_object_handle)
+                    {
+                        break;
+                    }
+                }
 
-                if (current_worker_ptr->get_vk_handle_internal() == in_vk_object_handle)
+                anvil_assert(n_delegate < static_cast<uint32_t>(m_delegate_vk_object_handles.size() ));
+
+                m_delegate_vk_object_handles.erase(m_delegate_vk_object_handles.begin() + n_delegate);
+
+                if (m_delegate_workers.size() > 0)
                 {
-                    break;
+                    m_delegate_workers.erase(m_delegate_workers.begin() + n_delegate);
                 }
             }
-
-            anvil_assert(worker_iterator != m_delegate_workers.end() );
-            m_delegate_workers.erase(worker_iterator);
+            #else
+            {
+                ANVIL_REDUNDANT_ARGUMENT(in_vk_object_handle);
+            }
+            #endif
         }
 
         template<class T>
@@ -306,17 +341,27 @@ namespace Anvil
          */
         void set_name(const std::string& in_object_name)
         {
-            if (m_worker_ptr != nullptr)
-            {
-                m_worker_ptr->set_name_internal(in_object_name);
-            }
-            else
+            #if !defined(ANVIL_STRIP_DEBUG_NAMES)
             {
-                for (auto& worker_ptr : m_delegate_workers)
+                init_workers();
+
+                if (m_worker_ptr != nullptr)
+                {
+                    m_worker_ptr->set_name_internal(in_object_name);
+                }
+                else
                 {
-                    worker_ptr->set_name_internal(in_object_name);
+                    for (auto& worker_ptr : m_delegate_workers)
+                    {
+                        worker_ptr->set_name_internal(in_object_name);
+                    }
                 }
             }
+            #else
+            {
+                ANVIL_REDUNDANT_ARGUMENT_CONST(in_object_name);
+            }
+            #endif
         }
 
         /** Forms a name using info passed via a variable number of arguments (just like *printf() )
@@ -329,30 +374,28 @@ namespace Anvil
         void set_name_formatted(const char* in_format,
                                 ...)
         {
-            char    buffer[1024];
-            va_list list;
-
-            va_start(list,
-                     in_format);
+            #if !defined(ANVIL_STRIP_DEBUG_NAMES)
             {
-                vsnprintf(buffer,
-                          sizeof(buffer),
-                          in_format,
-                          list);
-            }
-            va_end(list);
+                char    buffer[1024];
+                va_list list;
 
-            if (m_worker_ptr != nullptr)
-            {
-                m_worker_ptr->set_name_internal(buffer);
-            }
-            else
-            {
-                for (auto& worker_ptr : m_delegate_workers)
+                va_start(list,
+                         in_format);
                 {
-                    worker_ptr->set_name_internal(buffer);
+                    vsnprintf(buffer,
+                              sizeof(buffer),
+                              in_format,
+                              list);
                 }
+                va_end(list);
+
+                set_name(buffer);
+            }
+            #else
+            {
+                ANVIL_REDUNDANT_ARGUMENT(in_format);
             }
+            #endif
         }
 
         /** Associates a user-specified tag data to with all maintained Vulkan object handles.
@@ -368,26 +411,86 @@ namespace Anvil
                      size_t         in_tag_size,
                      const void*    in_tag_ptr)
         {
-            if (m_worker_ptr != nullptr)
+            #if !defined(ANVIL_STRIP_DEBUG_NAMES)
             {
-                m_worker_ptr->set_tag_internal(in_tag_name,
-                                               in_tag_size,
-                                               in_tag_ptr);
-            }
-            else
-            {
-                for (auto& worker_ptr : m_delegate_workers)
+                init_workers();
+
+                if (m_worker_ptr != nullptr)
                 {
-                    worker_ptr->set_tag_internal(in_tag_name,
-                                                 in_tag_size,
-                                                 in_tag_ptr);
+                    m_worker_ptr->set_tag_internal(in_tag_name,
+                                                   in_tag_size,
+                                                   in_tag_ptr);
+                }
+                else
+                {
+                    for (auto& worker_ptr : m_delegate_workers)
+                    {
+                        worker_ptr->set_tag_internal(in_tag_name,
+                                                     in_tag_size,
+                                                     in_tag_ptr);
+                    }
                 }
             }
+            #else
+            {
+                ANVIL_REDUNDANT_ARGUMENT_CONST(in_tag_name);
+                ANVIL_REDUNDANT_ARGUMENT      (in_tag_size);
+                ANVIL_REDUNDANT_ARGUMENT      (in_tag_ptr);
+            }
+            #endif
         }
 
     private:
         /* Private functions */
 
+        #if !defined(ANVIL_STRIP_DEBUG_NAMES)
+            /** Creates a new delegate worker for @param in_vk_object_handle and appends it to m_delegate_workers. */
+            Anvil::DebugMarkerSupportProviderWorker* create_worker(uint64_t in_vk_object_handle)
+            {
+                std::unique_ptr<Anvil::DebugMarkerSupportProviderWorker> new_worker_ptr(
+                    new Anvil::DebugMarkerSupportProviderWorker(m_device_ptr,
+                                                                m_vk_object_type)
+                );
+                auto new_worker_raw_ptr = new_worker_ptr.get();
+
+                new_worker_ptr->set_vk_handle_internal(in_vk_object_handle);
+
+                m_delegate_workers.push_back(
+                    std::move(new_worker_ptr)
+                );
+
+                return new_worker_raw_ptr;
+            }
+
+            /** Allocates workers for all associated Vulkan handles, unless this has already been done. */
+            void init_workers()
+            {
+                if (!m_use_delegate_workers)
+                {
+                    if (m_worker_ptr == nullptr)
+                    {
+                        m_worker_ptr.reset(
+                            new DebugMarkerSupportProviderWorker(m_device_ptr,
+                                                                 m_vk_object_type)
+                        );
+
+                        if (m_vk_object_handle != VK_NULL_HANDLE)
+                        {
+                            m_worker_ptr->set_vk_handle_internal(m_vk_object_handle);
+                        }
+                    }
+                }
+                else
+                if (m_delegate_workers.size() == 0)
+                {
+                    for (const auto& current_vk_object_handle : m_delegate_vk_object_handles)
+                    {
+                        create_worker(current_vk_object_handle);
+                    }
+                }
+            }
+        #endif
+
         /** Associates a new Vulkan handle with the provider instance. Must only be used for
          *  providers instantiated without delegate worker support.
          *
@@ -396,9 +499,22 @@ namespace Anvil
          */
         void set_vk_handle(uint64_t in_vk_object_handle)
         {
-            anvil_assert(m_worker_ptr != nullptr);
+            #if !defined(ANVIL_STRIP_DEBUG_NAMES)
+            {
+                anvil_assert(!m_use_delegate_workers);
 
-            m_worker_ptr->set_vk_handle_internal(in_vk_object_handle);
+                m_vk_object_handle = in_vk_object_handle;
+
+                if (m_worker_ptr != nullptr)
+                {
+                    m_worker_ptr->set_vk_handle_internal(in_vk_object_handle);
+                }
+            }
+            #else
+            {
+                ANVIL_REDUNDANT_ARGUMENT(in_vk_object_handle);
+            }
+            #endif
         }
 
         template<class T>
@@ -410,20 +526,26 @@ namespace Anvil
         }
 
         /* Private variables */
+        const Anvil::BaseDevice* m_device_ptr;
 
-        /* Only used if delegate workers have been requested at creation time: ==> */
-        std::vector<std::unique_ptr<DebugMarkerSupportProviderWorker> > m_delegate_workers;
-        const Anvil::BaseDevice*                                        m_device_ptr;
-        Anvil::ObjectType                                               m_vk_object_type;
+        #if !defined(ANVIL_STRIP_DEBUG_NAMES)
+            bool              m_use_delegate_workers;
+            Anvil::ObjectType m_vk_object_type;
 
-        /* <== */
+            /* Only used if delegate workers have been requested at creation time. Workers are only allocated
+             * after the object is named or tagged for the first time: ==> */
+            std::vector<uint64_t>                                           m_delegate_vk_object_handles;
+            std::vector<std::unique_ptr<DebugMarkerSupportProviderWorker> > m_delegate_workers;
+            /* <== */
 
-        /* Otherwise: ==> */
-        std::unique_ptr<DebugMarkerSupportProviderWorker> m_worker_ptr;
-        /* <== */
+            /* Otherwise: ==> */
+            uint64_t                                          m_vk_object_handle;
+            std::unique_ptr<DebugMarkerSupportProviderWorker> m_worker_ptr;
+            /* <== */
+        #endif
 
         friend Wrapper;
     };
 };
 
-#endif /* MISC_DEBUG_MARKER_H */
\ No newline at end of file
+#endif /* MISC_DEBUG_MARKER_H */
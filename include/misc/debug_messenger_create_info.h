@@ -24,6 +24,7 @@
 #define MISC_DEBUG_MESSENGER_CREATE_INFO_H
 
 #include "misc/types.h"
+#include <algorithm>
 
 namespace Anvil
 {
@@ -52,6 +53,12 @@ namespace Anvil
                                                         const Anvil::DebugMessageTypeFlags&     in_debug_message_type_flags,
                                                         Anvil::DebugMessengerCallbackFunction   in_callback_function);
 
+        /** Returns the number of ring slots used for asynchronous delivery. Please see set_async_delivery(). */
+        uint32_t get_async_delivery_ring_size() const
+        {
+            return m_async_delivery_ring_size;
+        }
+
         const Anvil::DebugMessengerCallbackFunction& get_callback_function() const
         {
             return m_callback_function;
@@ -67,11 +74,88 @@ namespace Anvil
             return m_debug_message_type_flags;
         }
 
+        /** Returns IDs of messages which are dropped before the callback is invoked. Please see
+         *  set_filtered_message_ids(). */
+        const std::vector<int32_t>& get_filtered_message_ids() const
+        {
+            return m_filtered_message_ids;
+        }
+
         Anvil::Instance* get_instance_ptr() const
         {
             return m_instance_ptr;
         }
 
+        /** Returns rate limit settings. Please see set_rate_limit(). */
+        void get_rate_limit(uint32_t* out_max_messages_per_id_ptr,
+                            uint32_t* out_period_msec_ptr) const
+        {
+            *out_max_messages_per_id_ptr = m_rate_limit_max_messages_per_id;
+            *out_period_msec_ptr         = m_rate_limit_period_msec;
+        }
+
+        /** Tells if messages are delivered from a background thread. Please see set_async_delivery(). */
+        bool is_async_delivery_enabled() const
+        {
+            return m_async_delivery_enabled;
+        }
+
+        /** Enables or disables asynchronous delivery.
+         *
+         *  When enabled, the messenger copies incoming messages into a bounded, lock-free ring and returns to
+         *  the implementation straight away. The callback is invoked from a background thread instead of the
+         *  thread which triggered the message. Messages which do not fit in the ring are dropped.
+         *
+         *  Disabled by default.
+         *
+         *  @param in_enable      True to enable asynchronous delivery, false to disable it.
+         *  @param in_n_ring_size Number of messages the ring can hold. Must be a power of two.
+         */
+        void set_async_delivery(bool     in_enable,
+                                uint32_t in_n_ring_size = 256)
+        {
+            anvil_assert(in_n_ring_size                        >  0 &&
+                         (in_n_ring_size & (in_n_ring_size - 1)) == 0);
+
+            m_async_delivery_enabled   = in_enable;
+            m_async_delivery_ring_size = in_n_ring_size;
+        }
+
+        /** Specifies IDs of messages which should be dropped before the callback is invoked. The check happens
+         *  before any message data is gathered, so it is cheap compared to filtering in the callback.
+         *
+         *  Only severity and type flags narrow the set of messages reported by the implementation. IDs are
+         *  checked by the messenger.
+         */
+        void set_filtered_message_ids(const std::vector<int32_t>& in_message_ids)
+        {
+            m_filtered_message_ids = in_message_ids;
+
+            std::sort(m_filtered_message_ids.begin(),
+                      m_filtered_message_ids.end  () );
+        }
+
+        /** Limits how many messages with the same ID reach the callback.
+         *
+         *  At most @param in_max_messages_per_id messages with the same ID are delivered within each period of
+         *  @param in_period_msec milliseconds. Remaining messages are dropped. Message IDs are hashed into
+         *  a fixed-size table, so IDs which share a table entry also share the limit.
+         *
+         *  @param in_max_messages_per_id Maximum number of messages per ID per period. 0 disables rate limiting,
+         *                                which is the default.
+         *  @param in_period_msec         Length of the period, in milliseconds. Must not be 0 if rate limiting is
+         *                                enabled.
+         */
+        void set_rate_limit(uint32_t in_max_messages_per_id,
+                            uint32_t in_period_msec)
+        {
+            anvil_assert(in_max_messages_per_id == 0 ||
+                         in_period_msec         >  0);
+
+            m_rate_limit_max_messages_per_id = in_max_messages_per_id;
+            m_rate_limit_period_msec         = in_period_msec;
+        }
+
     private:
         /* Please see create() documentation for more details */
 
@@ -82,10 +166,15 @@ namespace Anvil
 
         /* Private variables */
 
+        bool                                  m_async_delivery_enabled;
+        uint32_t                              m_async_delivery_ring_size;
         Anvil::DebugMessengerCallbackFunction m_callback_function;
         Anvil::DebugMessageSeverityFlags      m_debug_message_severity_flags;
         Anvil::DebugMessageTypeFlags          m_debug_message_type_flags;
+        std::vector<int32_t>                  m_filtered_message_ids;
         Anvil::Instance*                      m_instance_ptr;
+        uint32_t                              m_rate_limit_max_messages_per_id;
+        uint32_t                              m_rate_limit_period_msec;
 
         ANVIL_DISABLE_ASSIGNMENT_OPERATOR(DebugMessengerCreateInfo);
     };
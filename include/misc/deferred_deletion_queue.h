@@ -0,0 +1,198 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a device-wide deferred deletion queue.
+ *
+ *  Wrapper instances which may still be referenced by GPU work in flight (buffers, images, descriptor sets,
+ *  framebuffers, etc.) can be handed over to the queue instead of being released straight away. Each object
+ *  is tagged with the index of the current frame. Apps end a frame by calling end_frame() with a fence, or
+ *  a timeline semaphore value, which is signalled once the GPU has finished executing all work submitted
+ *  for that frame. collect() releases all objects whose frames have completed.
+ *
+ *  Objects can be enqueued explicitly with enqueue(), or implicitly by wrapping their unique pointers with
+ *  make_deferred(). In the latter case, the pointer's deleter hands the object over to the queue.
+ *
+ *  Objects which are still pending when the queue is destroyed are released at that time. The queue is
+ *  destroyed by the device, after it has waited for the device to become idle.
+ *
+ *  This object should ONLY be instantiated by Anvil::BaseDevice.
+ *
+ *  Deferred deletion queue is thread-safe.
+ */
+#ifndef MISC_DEFERRED_DELETION_QUEUE_H
+#define MISC_DEFERRED_DELETION_QUEUE_H
+
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+#include <deque>
+
+
+namespace Anvil
+{
+    class DeferredDeletionQueue : public MTSafetySupportProvider
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new deferred deletion queue instance.
+         *
+         *  @param in_device_ptr Device to create the queue for. Must not be null.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::DeferredDeletionQueueUniquePtr create(const Anvil::BaseDevice* in_device_ptr);
+
+        /** Destructor. Releases all pending objects, regardless of whether their frames have completed. */
+        ~DeferredDeletionQueue();
+
+        /** Releases all objects whose frames have completed. Does not block.
+         *
+         *  Objects are released in the order they were enqueued in.
+         *
+         *  @return Number of objects released.
+         */
+        uint32_t collect();
+
+        /** Ends the current frame. Objects enqueued so far are released by collect() once @param in_fence_ptr
+         *  becomes signalled.
+         *
+         *  @param in_fence_ptr Fence used by the last submission of the frame. Must not be null. The fence must
+         *                      stay alive until the frame's objects are released.
+         */
+        void end_frame(Anvil::Fence* in_fence_ptr);
+
+        /** Ends the current frame. Objects enqueued so far are released by collect() once the counter of
+         *  @param in_timeline_semaphore_ptr reaches @param in_value.
+         *
+         *  @param in_timeline_semaphore_ptr Timeline semaphore signalled by the last submission of the frame.
+         *                                   Must not be null. The semaphore must stay alive until the frame's
+         *                                   objects are released.
+         *  @param in_value                  Value the last submission of the frame signals.
+         */
+        void end_frame(Anvil::Semaphore* in_timeline_semaphore_ptr,
+                       uint64_t          in_value);
+
+        /** Hands @param in_object_ptr over to the queue. The object is released with its original deleter by
+         *  the first collect() call made after the current frame completes.
+         */
+        template<typename ObjectType>
+        void enqueue(std::unique_ptr<ObjectType, std::function<void(ObjectType*)> > in_object_ptr)
+        {
+            if (in_object_ptr == nullptr)
+            {
+                return;
+            }
+
+            std::function<void(ObjectType*)> deleter   (in_object_ptr.get_deleter() );
+            ObjectType*                      object_ptr(in_object_ptr.release() );
+
+            enqueue_release_func(
+                [deleter, object_ptr]()
+                {
+                    deleter(object_ptr);
+                }
+            );
+        }
+
+        /** Returns index of the current frame. */
+        uint64_t get_current_frame() const;
+
+        /** Returns the number of objects which have not been released yet. */
+        uint32_t get_n_pending_objects() const;
+
+        /** Replaces the deleter of @param in_object_ptr, so that releasing the returned pointer enqueues the
+         *  object instead of destroying it straight away.
+         *
+         *  The queue must outlive the returned pointer.
+         */
+        template<typename ObjectType>
+        std::unique_ptr<ObjectType, std::function<void(ObjectType*)> > make_deferred(std::unique_ptr<ObjectType, std::function<void(ObjectType*)> > in_object_ptr)
+        {
+            std::function<void(ObjectType*)> deleter  (in_object_ptr.get_deleter() );
+            Anvil::DeferredDeletionQueue*    queue_ptr(this);
+
+            return std::unique_ptr<ObjectType, std::function<void(ObjectType*)> >(
+                in_object_ptr.release(),
+                [deleter, queue_ptr](ObjectType* in_ptr)
+                {
+                    queue_ptr->enqueue(
+                        std::unique_ptr<ObjectType, std::function<void(ObjectType*)> >(in_ptr,
+                                                                                      deleter)
+                    );
+                }
+            );
+        }
+
+    private:
+        /* Private type definitions */
+        typedef struct Frame
+        {
+            Anvil::Fence*     fence_ptr;
+            uint64_t          n_frame;
+            Anvil::Semaphore* semaphore_ptr;
+            uint64_t          semaphore_value;
+
+            Frame(uint64_t          in_n_frame,
+                  Anvil::Fence*     in_fence_ptr,
+                  Anvil::Semaphore* in_semaphore_ptr,
+                  uint64_t          in_semaphore_value)
+                :fence_ptr      (in_fence_ptr),
+                 n_frame        (in_n_frame),
+                 semaphore_ptr  (in_semaphore_ptr),
+                 semaphore_value(in_semaphore_value)
+            {
+                /* Stub */
+            }
+        } Frame;
+
+        typedef struct Item
+        {
+            uint64_t              n_frame;
+            std::function<void()> release_func;
+
+            Item(uint64_t              in_n_frame,
+                 std::function<void()> in_release_func)
+                :n_frame     (in_n_frame),
+                 release_func(std::move(in_release_func) )
+            {
+                /* Stub */
+            }
+        } Item;
+
+        /* Private functions */
+        DeferredDeletionQueue(const Anvil::BaseDevice* in_device_ptr);
+
+        void enqueue_release_func(std::function<void()> in_release_func);
+        bool is_frame_complete   (const Frame&          in_frame) const;
+
+        /* Private variables */
+        const Anvil::BaseDevice* m_device_ptr;
+        std::deque<Frame>        m_frames;
+        std::deque<Item>         m_items;
+        uint64_t                 m_n_current_frame;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(DeferredDeletionQueue);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(DeferredDeletionQueue);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_DEFERRED_DELETION_QUEUE_H */
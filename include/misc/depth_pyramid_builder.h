@@ -0,0 +1,177 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Builds a hierarchical depth (Hi-Z) pyramid out of a depth buffer, for use as the occlusion culling input of
+ *  IndirectDrawCuller.
+ *
+ *  The pyramid is a single-channel R32_SFLOAT image with a full mip chain. Mip 0 has the largest power-of-two size
+ *  which does not exceed the size of the depth buffer the builder is created for, and each texel holds the farthest
+ *  (maximum) depth of the region it covers. Mip 0 is reduced conservatively from the depth buffer, so the depth
+ *  buffer does not need to have a power-of-two size.
+ *
+ *  Mips are reduced by a compute shader, which processes up to five mips per dispatch: each workgroup reduces
+ *  a 16x16 tile of the first mip of a batch, and then keeps reducing the tile in shared memory down to a single
+ *  texel. A 4096x4096 pyramid therefore takes three dispatches instead of thirteen.
+ *
+ *  If VK_EXT_sampler_filter_minmax is enabled and the device supports min/max filtering of single-component formats,
+ *  the first mip of each batch (except mip 0) is reduced with a single bilinear fetch from a MAX reduction sampler.
+ *  Otherwise, the shader falls back to four texel fetches.
+ *
+ *  Shaders are compiled at creation time with GLSLShaderToSPIRVGenerator, so the builder requires Anvil to be built
+ *  with ANVIL_LINK_WITH_GLSLANG defined.
+ *
+ *  Depth pyramid builder is NOT thread-safe.
+ */
+#ifndef MISC_DEPTH_PYRAMID_BUILDER_H
+#define MISC_DEPTH_PYRAMID_BUILDER_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class DepthPyramidBuilder
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new depth pyramid builder instance. Creates the pyramid image, compiles the reduction shader and
+         *  bakes the compute pipeline.
+         *
+         *  @param in_device_ptr    Device to create the builder for. Must not be null.
+         *  @param in_depth_width   Width of the depth buffers the pyramid is going to be built from. Must not be 0.
+         *  @param in_depth_height  Height of the depth buffers the pyramid is going to be built from. Must not be 0.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::DepthPyramidBuilderUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
+                                                          uint32_t                 in_depth_width,
+                                                          uint32_t                 in_depth_height);
+
+        /** Destructor. The caller must make sure none of the recorded builds is still executed by the GPU. */
+        ~DepthPyramidBuilder();
+
+        /** Returns the height of the pyramid's mip 0. To be used as IndirectDrawCuller::CullInfo::depth_pyramid_height. */
+        uint32_t get_height() const
+        {
+            return m_height;
+        }
+
+        /** Returns the pyramid image. */
+        Anvil::Image* get_image() const
+        {
+            return m_image_ptr.get();
+        }
+
+        /** Returns a view of the pyramid's full mip chain. To be used as
+         *  IndirectDrawCuller::CullInfo::depth_pyramid_image_view_ptr.
+         */
+        Anvil::ImageView* get_image_view() const
+        {
+            return m_image_view_ptr.get();
+        }
+
+        /** Returns the number of mips the pyramid holds. */
+        uint32_t get_n_mips() const
+        {
+            return static_cast<uint32_t>(m_mip_image_view_ptrs.size() );
+        }
+
+        /** Returns the width of the pyramid's mip 0. To be used as IndirectDrawCuller::CullInfo::depth_pyramid_width. */
+        uint32_t get_width() const
+        {
+            return m_width;
+        }
+
+        /** Tells whether mips are reduced with a VK_EXT_sampler_filter_minmax reduction sampler. */
+        bool is_reduction_sampler_used() const
+        {
+            return (m_reduction_sampler_ptr != nullptr);
+        }
+
+        /** Records commands which rebuild the whole pyramid from the specified depth buffer.
+         *
+         *  Previous contents of the pyramid are discarded. Once the commands execute, the pyramid is left in
+         *  SHADER_READ_ONLY_OPTIMAL layout, with its contents made visible to compute shaders.
+         *
+         *  The caller is responsible for making earlier depth writes available to compute shaders, and for
+         *  transitioning the depth buffer to @param in_depth_image_layout. Must be called outside a renderpass.
+         *
+         *  @param in_cmd_buffer_ptr       Command buffer to record the commands to. Must be in recording state and must
+         *                                 support compute operations. Must not be null.
+         *  @param in_depth_image_view_ptr 2D view of the depth aspect of the depth buffer. Must have been created for an
+         *                                 image with SAMPLED usage. Must not be null.
+         *  @param in_depth_image_layout   Layout the depth buffer is going to be in when the commands execute. Must be
+         *                                 either SHADER_READ_ONLY_OPTIMAL, DEPTH_STENCIL_READ_ONLY_OPTIMAL or GENERAL.
+         *  @param in_opt_profiler_ptr     If not null, the build is wrapped in a "Depth pyramid" profiler region.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_build(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                          Anvil::ImageView*         in_depth_image_view_ptr,
+                          Anvil::ImageLayout        in_depth_image_layout,
+                          Anvil::GPUProfiler*       in_opt_profiler_ptr = nullptr);
+
+    private:
+        /* Private type definitions */
+
+        /* Matches the reduction shader's push constant block */
+        typedef struct PushConstants
+        {
+            int32_t  src_size[2];
+            int32_t  dst_size[2];
+            uint32_t n_mips;
+            uint32_t is_src_depth;
+        } PushConstants;
+
+        /* Private functions */
+        DepthPyramidBuilder(const Anvil::BaseDevice* in_device_ptr,
+                            uint32_t                 in_width,
+                            uint32_t                 in_height);
+
+        bool init         ();
+        bool init_image   ();
+        bool init_pipeline();
+        bool init_samplers();
+
+        /* Private variables */
+        const Anvil::BaseDevice*                            m_device_ptr;
+        Anvil::DescriptorSetCacheUniquePtr                  m_ds_cache_ptr;
+        Anvil::DescriptorSetLayoutUniquePtr                 m_ds_layout_ptr;
+        std::unique_ptr<Anvil::ShaderModuleStageEntryPoint> m_entrypoint_ptr;
+        const uint32_t                                      m_height;
+        Anvil::ImageUniquePtr                               m_image_ptr;
+        Anvil::ImageViewUniquePtr                           m_image_view_ptr;
+        std::vector<Anvil::ImageViewUniquePtr>              m_mip_image_view_ptrs;
+        Anvil::SamplerUniquePtr                             m_nearest_sampler_ptr;
+        Anvil::PipelineID                                   m_pipeline_id;
+        Anvil::SamplerUniquePtr                             m_reduction_sampler_ptr;
+        Anvil::ShaderModuleUniquePtr                        m_shader_module_ptr;
+        const uint32_t                                      m_width;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(DepthPyramidBuilder);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(DepthPyramidBuilder);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_DEPTH_PYRAMID_BUILDER_H */
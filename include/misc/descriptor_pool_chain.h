@@ -0,0 +1,113 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a growable chain of descriptor pools, which sets are linearly allocated from.
+ *
+ *  Sets are carved out of the current pool of the chain. Once the pool runs out of space, the next pool
+ *  retained by the chain is used, or a new one is created. Pools are only destroyed together with the chain.
+ *  reset() resets all pools used so far at once, which releases all sets allocated from the chain.
+ *
+ *  If a sizing profile key is specified, the first pool of the chain is sized to fit the usage recorded
+ *  for the key in the device's DescriptorPoolSizingProfile, as long as adaptive sizing is enabled on the
+ *  profile. All other pools use the sizes specified at creation time.
+ *
+ *  Pools are created without the UPDATE_AFTER_BIND and FREE_DESCRIPTOR_SET flags, and do not reserve space
+ *  for inline uniform blocks.
+ *
+ *  Descriptor pool chain is NOT thread-safe.
+ */
+#ifndef MISC_DESCRIPTOR_POOL_CHAIN_H
+#define MISC_DESCRIPTOR_POOL_CHAIN_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class DescriptorPoolChain
+    {
+    public:
+        /* Public functions */
+
+        /** Constructor. No pool is created until the first allocation.
+         *
+         *  @param in_device_ptr                   Device to create the pools on. Must not be null.
+         *  @param in_n_sets_per_pool              Maximum number of sets each pool can hold. Must not be 0.
+         *  @param in_n_descriptors_per_type_pool  Number of descriptors of each type each pool can hold. Must not be 0.
+         *  @param in_opt_sizing_profile_key_ptr   If not null, key to look up the learned usage for when sizing the
+         *                                         first pool of the chain.
+         */
+        DescriptorPoolChain(const Anvil::BaseDevice* in_device_ptr,
+                            uint32_t                 in_n_sets_per_pool,
+                            uint32_t                 in_n_descriptors_per_type_pool,
+                            const uint64_t*          in_opt_sizing_profile_key_ptr = nullptr);
+
+        /** Destructor. All sets allocated from the chain must have been released by the time it is called. */
+        ~DescriptorPoolChain();
+
+        /** Allocates a descriptor set from the current pool, moving to the next pool (or creating a new one)
+         *  if the current pool runs out of space.
+         *
+         *  @param in_ds_allocation Layout (and, if needed, the variable descriptor count) to allocate the set with.
+         *  @param out_ds_ptr       Deref will be set to the new set if successful. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool alloc_descriptor_set(const Anvil::DescriptorSetAllocation& in_ds_allocation,
+                                  Anvil::DescriptorSetUniquePtr*        out_ds_ptr);
+
+        /** Returns the number of pools created so far. */
+        uint32_t get_n_pools() const
+        {
+            return static_cast<uint32_t>(m_pools.size() );
+        }
+
+        /** Returns the total usage of all pools used since the last reset() call. */
+        Anvil::DescriptorPoolUsage get_usage() const;
+
+        /** Resets all pools used since the last reset() call. The caller must release all sets allocated
+         *  from the chain beforehand.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool reset();
+
+    private:
+        /* Private functions */
+        bool create_pool();
+
+        /* Private variables */
+        const Anvil::BaseDevice*                    m_device_ptr;
+        bool                                        m_has_sizing_profile_key;
+        bool                                        m_is_first_pool_profiled;
+        uint32_t                                    m_n_current_pool;
+        const uint32_t                              m_n_descriptors_per_type_pool;
+        const uint32_t                              m_n_sets_per_pool;
+        std::vector<Anvil::DescriptorPoolUniquePtr> m_pools;
+        uint64_t                                    m_sizing_profile_key;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(DescriptorPoolChain);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(DescriptorPoolChain);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_DESCRIPTOR_POOL_CHAIN_H */
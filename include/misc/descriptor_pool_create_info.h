@@ -88,6 +88,11 @@ namespace Anvil
             return m_n_max_sets;
         }
 
+        const bool& get_should_recycle_released_sets() const
+        {
+            return m_should_recycle_released_sets;
+        }
+
         void set_create_flags(const Anvil::DescriptorPoolCreateFlags& in_create_flags)
         {
             m_create_flags = in_create_flags;
@@ -119,6 +124,18 @@ namespace Anvil
             m_n_max_sets = in_n_maximum_sets;
         }
 
+        /* Enables the free-list mode. In this mode, DescriptorPool::release_descriptor_sets() keeps released sets in
+         * per-layout free lists, and alloc_descriptor_sets() hands them out again for allocations of the same layout,
+         * without any vkFreeDescriptorSets() or vkAllocateDescriptorSets() calls. This avoids the fragmentation that
+         * freeing individual sets from a FREE_DESCRIPTOR_SET_BIT pool causes, so the flag is not needed in this mode.
+         *
+         * Disabled by default.
+         */
+        void set_should_recycle_released_sets(const bool& in_should_recycle_released_sets)
+        {
+            m_should_recycle_released_sets = in_should_recycle_released_sets;
+        }
+
     private:
 
         /* Private functions */
@@ -139,6 +156,7 @@ namespace Anvil
         Anvil::MTSafety                                                                              m_mt_safety;
         uint32_t                                                                                     m_n_max_inline_uniform_block_bindings;
         uint32_t                                                                                     m_n_max_sets;
+        bool                                                                                         m_should_recycle_released_sets;
     };
 
 }; /* namespace Anvil */
@@ -0,0 +1,161 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a device-wide record of how much descriptor pool space has actually been requested, used to size
+ *  new descriptor pools adaptively.
+ *
+ *  Descriptor pool owners report their usage under a key, which identifies the "shape" of the pool:
+ *
+ *  - DescriptorSetGroup reports the peak usage of its pool when it is released. The key is derived from the
+ *    layouts of all sets in the group and the pool create flags.
+ *  - TransientDescriptorSetAllocator reports the total usage of each thread's pool chain for a frame slot, every
+ *    time the slot is recycled. The key is derived from the allocator's pool size configuration.
+ *
+ *  Usage includes allocation requests which have failed, so a pool which has run out of space is reported as
+ *  needing more than it had. Recorded values follow increases immediately and decay slowly when usage drops.
+ *
+ *  Once adaptive sizing is enabled with set_adaptive_sizing_enabled(), new pools use the recorded usage instead
+ *  of the sizes requested by the caller:
+ *
+ *  - DescriptorSetGroup sizes its pool to the larger of what its layouts require and the recorded usage. Overhead
+ *    allocations specified at creation time are ignored for keys with recorded usage.
+ *  - TransientDescriptorSetAllocator sizes the first pool of each chain so that it fits a whole frame worth
+ *    of allocations, with some headroom. Further pools, if ever needed, use the sizes specified at creation time.
+ *
+ *  Keys only depend on data which is stable across runs, so the recorded usage can be persisted with store_to_file()
+ *  and loaded in a subsequent run with load_from_file().
+ *
+ *  This object should ONLY be instantiated by Anvil::BaseDevice.
+ *
+ *  Descriptor pool sizing profile is thread-safe.
+ */
+#ifndef MISC_DESCRIPTOR_POOL_SIZING_PROFILE_H
+#define MISC_DESCRIPTOR_POOL_SIZING_PROFILE_H
+
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+#include <unordered_map>
+
+
+namespace Anvil
+{
+    class DescriptorPoolSizingProfile : public MTSafetySupportProvider
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new, empty descriptor pool sizing profile instance. Adaptive sizing is disabled. */
+        static Anvil::DescriptorPoolSizingProfileUniquePtr create();
+
+        /** Destructor. */
+        ~DescriptorPoolSizingProfile();
+
+        /** Adds the descriptors consumed by a single descriptor set to @param inout_usage_ptr.
+         *
+         *  @param in_ds_create_info_ptr     Layout of the set. Must not be null.
+         *  @param in_n_variable_descriptors Number of descriptors to use for the variable descriptor count binding,
+         *                                   if the layout defines one.
+         *  @param inout_usage_ptr           Usage to update. Must not be null.
+         */
+        static void add_descriptor_set_usage(const Anvil::DescriptorSetCreateInfo* in_ds_create_info_ptr,
+                                             uint32_t                              in_n_variable_descriptors,
+                                             Anvil::DescriptorPoolUsage*           inout_usage_ptr);
+
+        /** Removes all recorded usage. */
+        void clear();
+
+        /** Returns a key identifying a descriptor set layout, which stays the same across runs. Unlike
+         *  DescriptorSetCreateInfo::get_hash(), the key does not depend on immutable sampler addresses.
+         *
+         *  @param in_ds_create_info_ptr Layout to return the key for. Must not be null.
+         */
+        static uint64_t get_descriptor_set_key(const Anvil::DescriptorSetCreateInfo* in_ds_create_info_ptr);
+
+        /** Returns the number of keys with recorded usage. */
+        uint32_t get_n_keys() const;
+
+        /** Retrieves the usage recorded for the specified key.
+         *
+         *  @param in_key        Key to use.
+         *  @param out_usage_ptr Deref will be set to the recorded usage. Must not be null.
+         *
+         *  @return true if any usage has been recorded for the key, false otherwise.
+         */
+        bool get_usage(uint64_t                    in_key,
+                       Anvil::DescriptorPoolUsage* out_usage_ptr) const;
+
+        /** Tells whether new descriptor pools should be sized using the recorded usage. */
+        bool is_adaptive_sizing_enabled() const
+        {
+            return m_adaptive_sizing_enabled;
+        }
+
+        /** Merges usage stored in a file written by an earlier store_to_file() call into the profile.
+         *
+         *  For keys recorded both in the file and in the profile, the larger values are kept.
+         *
+         *  @param in_filename Name of the file to load.
+         *
+         *  @return true if successful, false if the file could not be read or is malformed. The profile is
+         *          not modified in the latter case.
+         */
+        bool load_from_file(const std::string& in_filename);
+
+        /** Records usage observed for a descriptor pool.
+         *
+         *  Values larger than the ones recorded so far replace them. Smaller values pull the recorded values
+         *  down by a quarter of the difference, so that a single quiet frame does not shrink future pools.
+         *
+         *  @param in_key   Key of the pool.
+         *  @param in_usage Usage to record.
+         */
+        void record_usage(uint64_t                          in_key,
+                          const Anvil::DescriptorPoolUsage& in_usage);
+
+        /** Enables or disables adaptive sizing of new descriptor pools. Usage is recorded either way. */
+        void set_adaptive_sizing_enabled(bool in_enabled)
+        {
+            m_adaptive_sizing_enabled = in_enabled;
+        }
+
+        /** Writes all recorded usage to a binary file.
+         *
+         *  @param in_filename Name of the file to write. Existing contents are discarded.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool store_to_file(const std::string& in_filename) const;
+
+    private:
+        /* Private functions */
+        DescriptorPoolSizingProfile();
+
+        /* Private variables */
+        std::atomic<bool>                                        m_adaptive_sizing_enabled;
+        std::unordered_map<uint64_t, Anvil::DescriptorPoolUsage> m_usage;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(DescriptorPoolSizingProfile);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(DescriptorPoolSizingProfile);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_DESCRIPTOR_POOL_SIZING_PROFILE_H */
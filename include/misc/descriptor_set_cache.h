@@ -0,0 +1,233 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a content-addressed cache of baked descriptor sets.
+ *
+ *  Apps describe the descriptors they need with a DescriptorSetCache::Contents instance, using the same binding
+ *  element types as DescriptorSet::set_binding_array_items(). get_descriptor_set() then returns a set which has
+ *  been baked with identical contents and layout earlier on, or allocates, fills and bakes a new one if no such
+ *  set exists. This way, objects which end up with byte-identical descriptors, such as material instances, share
+ *  a single descriptor set.
+ *
+ *  Sets returned by the cache are owned by the cache and MUST NOT be modified by the app.
+ *
+ *  The cache identifies objects by their wrapper addresses and does not track their lifetime. Call clear()
+ *  before releasing any of the objects referenced by the cached sets.
+ *
+ *  Sets are allocated from a DescriptorPoolChain owned by the cache. The pools do not reserve space for inline uniform blocks,
+ *  and layouts with variable descriptor count bindings are not supported.
+ *
+ *  Descriptor set cache is NOT thread-safe, unless created with @param in_mt_safe set to true.
+ */
+#ifndef MISC_DESCRIPTOR_SET_CACHE_H
+#define MISC_DESCRIPTOR_SET_CACHE_H
+
+#include "misc/descriptor_pool_chain.h"
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+#include "wrappers/descriptor_set.h"
+#include <unordered_map>
+
+
+namespace Anvil
+{
+    class DescriptorSetCache : public MTSafetySupportProvider
+    {
+    public:
+        /* Public type definitions */
+
+        /** Describes the contents of a descriptor set. Used as a cache key. */
+        class Contents
+        {
+        public:
+            /* Public functions */
+
+            /** Constructor. */
+            Contents()
+            {
+                /* Stub */
+            }
+
+            /** Forgets all descriptors assigned to the instance, so that it can be reused to describe another set. */
+            void clear()
+            {
+                m_elements.clear();
+                m_setters.clear ();
+            }
+
+            /** Assigns descriptors to a range of binding array elements.
+             *
+             *  Arguments and requirements are as per DescriptorSet::set_binding_array_items(). Assigning descriptors
+             *  to elements which have already been assigned earlier replaces them.
+             **/
+            template<typename BindingElementType>
+            void set_binding_array_items(BindingIndex              in_binding_index,
+                                         BindingElementArrayRange  in_element_range,
+                                         const BindingElementType* in_elements_ptr)
+            {
+                std::vector<BindingElementType> elements;
+
+                anvil_assert(in_element_range.second >  0);
+                anvil_assert(in_elements_ptr         != nullptr);
+
+                elements.reserve(in_element_range.second);
+
+                for (uint32_t n_element = 0;
+                              n_element < in_element_range.second;
+                            ++n_element)
+                {
+                    elements.push_back(in_elements_ptr[n_element]);
+
+                    m_elements[ElementLocation(in_binding_index, in_element_range.first + n_element)] = get_element_key(in_elements_ptr[n_element]);
+                }
+
+                m_setters.push_back(
+                    [=](Anvil::DescriptorSet* in_ds_ptr)
+                    {
+                        return in_ds_ptr->set_binding_array_items(in_binding_index,
+                                                                  in_element_range,
+                                                                 &elements.at(0) );
+                    }
+                );
+            }
+
+            /** Assigns a descriptor to the zeroth element of the specified binding. */
+            template<typename BindingElementType>
+            void set_binding_item(BindingIndex              in_binding_index,
+                                  const BindingElementType& in_element)
+            {
+                set_binding_array_items(in_binding_index,
+                                        BindingElementArrayRange(0,  /* StartBindingElementIndex */
+                                                                 1), /* NumberOfBindingElements  */
+                                       &in_element);
+            }
+
+        private:
+            /* Private type definitions */
+            typedef std::array<uint64_t, 5>                              ElementKey; /* type, 2 object handles, offset or layout, size */
+            typedef std::pair<BindingIndex, uint32_t>                    ElementLocation;
+            typedef std::function<bool(Anvil::DescriptorSet* in_ds_ptr)> Setter;
+
+            /* Private functions */
+            static ElementKey get_element_key(const Anvil::DescriptorSet::BufferBindingElement&               in_element);
+            static ElementKey get_element_key(const Anvil::DescriptorSet::CombinedImageSamplerBindingElement& in_element);
+            static ElementKey get_element_key(const Anvil::DescriptorSet::ImageBindingElement&                in_element);
+            static ElementKey get_element_key(const Anvil::DescriptorSet::SamplerBindingElement&              in_element);
+            static ElementKey get_element_key(const Anvil::DescriptorSet::TexelBufferBindingElement&          in_element);
+
+            void get_key(const Anvil::DescriptorSetLayout* in_ds_layout_ptr,
+                         std::vector<uint64_t>*            out_key_ptr) const;
+
+            /* Private variables */
+            std::map<ElementLocation, ElementKey> m_elements;
+            std::vector<Setter>                   m_setters;
+
+            friend class DescriptorSetCache;
+        };
+
+        /* Public functions */
+
+        /** Creates a new descriptor set cache instance.
+         *
+         *  @param in_device_ptr                  Device to create the cache for. Must not be null.
+         *  @param in_n_sets_per_pool             Maximum number of sets each pool can hold. Must not be 0.
+         *  @param in_n_descriptors_per_type_pool Number of descriptors of each type each pool can hold. Must not be 0.
+         *  @param in_mt_safe                     True if the instance should be thread-safe.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::DescriptorSetCacheUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
+                                                         uint32_t                 in_n_sets_per_pool             = 256,
+                                                         uint32_t                 in_n_descriptors_per_type_pool = 1024,
+                                                         bool                     in_mt_safe                     = false);
+
+        /** Destructor. The caller must make sure none of the sets is still accessed by the GPU. */
+        ~DescriptorSetCache();
+
+        /** Releases all cached sets and resets the pools. The caller must make sure none of the sets is still
+         *  accessed by the GPU. */
+        void clear();
+
+        /** Returns a baked descriptor set using layout @param in_ds_layout_ptr, whose contents matches
+         *  @param in_contents. If no such set has been cached, a new one is created.
+         *
+         *  @param in_ds_layout_ptr Layout to use. Must not be null. Must not contain a variable descriptor count binding.
+         *  @param in_contents      Contents of the set.
+         *
+         *  @return Descriptor set if successful, null otherwise.
+         */
+        Anvil::DescriptorSet* get_descriptor_set(const Anvil::DescriptorSetLayout* in_ds_layout_ptr,
+                                                 const Contents&                   in_contents);
+
+        /** Returns the number of get_descriptor_set() calls which have been served with an existing set. */
+        uint32_t get_n_cache_hits() const
+        {
+            return m_n_cache_hits;
+        }
+
+        /** Returns the number of get_descriptor_set() calls which required a new set to be created. */
+        uint32_t get_n_cache_misses() const
+        {
+            return m_n_cache_misses;
+        }
+
+        /** Returns the number of sets held by the cache. */
+        uint32_t get_n_cached_sets() const;
+
+    private:
+        /* Private type definitions */
+        typedef struct CacheEntry
+        {
+            Anvil::DescriptorSetUniquePtr ds_ptr;
+            std::vector<uint64_t>         key;
+
+            CacheEntry(std::vector<uint64_t>         in_key,
+                       Anvil::DescriptorSetUniquePtr in_ds_ptr)
+                :ds_ptr(std::move(in_ds_ptr) ),
+                 key   (std::move(in_key) )
+            {
+                /* Stub */
+            }
+        } CacheEntry;
+
+        /* Private functions */
+        DescriptorSetCache(const Anvil::BaseDevice* in_device_ptr,
+                           uint32_t                 in_n_sets_per_pool,
+                           uint32_t                 in_n_descriptors_per_type_pool,
+                           bool                     in_mt_safe);
+
+        Anvil::DescriptorSetUniquePtr alloc_descriptor_set(const Anvil::DescriptorSetLayout* in_ds_layout_ptr);
+
+        /* Private variables */
+        std::unordered_map<uint64_t, std::vector<CacheEntry> > m_cache;
+        const Anvil::BaseDevice*                               m_device_ptr;
+        uint32_t                                               m_n_cache_hits;
+        uint32_t                                               m_n_cache_misses;
+        Anvil::DescriptorPoolChain                             m_pool_chain;
+        std::vector<uint64_t>                                  m_scratch_key;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(DescriptorSetCache);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(DescriptorSetCache);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_DESCRIPTOR_SET_CACHE_H */
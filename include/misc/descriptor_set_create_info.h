@@ -68,7 +68,9 @@ namespace Anvil
          *  @param in_flags                         Please see documentation of Anvil::DescriptorBindingFlags for more details.
          *  @param in_opt_immutable_sampler_ptr_ptr If not nullptr, an array of @param in_descriptor_array_size samplers should
          *                                          be passed. The binding will then be considered immutable, as per spec language.
-         *                                          May be nullptr.
+         *                                          Descriptor set updates do not write immutable samplers, so the samplers
+         *                                          specified for combined image+sampler binding elements are ignored.
+         *                                          Please also see promote_uniform_samplers(). May be nullptr.
          *
          *  @return true if successful, false otherwise.
          **/
@@ -111,6 +113,12 @@ namespace Anvil
          **/
         std::unique_ptr<DescriptorSetLayoutCreateInfoContainer> create_descriptor_set_layout_create_info(const Anvil::BaseDevice* in_device_ptr) const;
 
+        /** Returns layout create flags, as specified with set_create_flags(). */
+        const Anvil::DescriptorSetLayoutCreateFlags& get_create_flags() const
+        {
+            return m_create_flags;
+        }
+
         /** Retrieves properties of a binding at a given index number.
          *
          *  @param in_n_binding                           Index number of the binding to retrieve properties of.
@@ -164,12 +172,34 @@ namespace Anvil
                                                     bool*                          out_opt_immutable_samplers_enabled_ptr = nullptr,
                                                     Anvil::DescriptorBindingFlags* out_opt_flags_ptr                      = nullptr) const;
 
+        /** Returns a structural hash of the create info. Create info instances which compare equal return the same hash. */
+        uint64_t get_hash() const;
+
         /** Returns the number of bindings defined for the layout. */
         uint32_t get_n_bindings() const
         {
             return static_cast<uint32_t>(m_bindings.size() );
         }
 
+        /** Converts sampler & combined image+sampler bindings to use immutable samplers, if every descriptor set in
+         *  @param in_ds_ptrs has only ever been written the same sampler for that binding. Distinct sampler instances
+         *  created with equal create info structures are considered the same sampler.
+         *
+         *  Bindings which already use immutable samplers, variable descriptor count bindings and bindings which have
+         *  not been written to in any of the sets are left intact.
+         *
+         *  Promotion changes the layout, so it should happen before the create info is used to create a layout. Sets
+         *  and pipeline layouts created for the original layout are NOT compatible with the promoted one. The promoted
+         *  samplers must stay alive for as long as any layout created from this create info is in use.
+         *
+         *  @param in_n_sets  Number of descriptor sets available under @param in_ds_ptrs. Must not be 0.
+         *  @param in_ds_ptrs Descriptor sets whose sampler usage should be inspected. Must not be nullptr.
+         *
+         *  @return Number of bindings which have been promoted.
+         */
+        uint32_t promote_uniform_samplers(uint32_t                           in_n_sets,
+                                          const Anvil::DescriptorSet* const* in_ds_ptrs);
+
         /* Sets the number of descriptors to be used for a variable descriptor count binding.
          *
          * A variable descriptor count binding must have been added to this DS info instance before this function
@@ -177,6 +207,16 @@ namespace Anvil
          */
         bool set_binding_variable_descriptor_count(const uint32_t& in_count);
 
+        /** Specifies layout create flags. Please see documentation of Anvil::DescriptorSetLayoutCreateFlagBits for more details.
+         *
+         *  Layouts created with PUSH_DESCRIPTOR_BIT_KHR must not include dynamic buffer, inline uniform block or update-after-bind
+         *  bindings.
+         */
+        void set_create_flags(const Anvil::DescriptorSetLayoutCreateFlags& in_create_flags)
+        {
+            m_create_flags = in_create_flags;
+        }
+
         bool operator==(const Anvil::DescriptorSetCreateInfo& in_ds) const;
 
     private:
@@ -243,7 +283,8 @@ namespace Anvil
         DescriptorSetCreateInfo();
 
         /* Private variables */
-        BindingIndexToBindingMap m_bindings;
+        BindingIndexToBindingMap              m_bindings;
+        Anvil::DescriptorSetLayoutCreateFlags m_create_flags;
 
         uint32_t                 m_n_variable_descriptor_count_binding;
         uint32_t                 m_variable_descriptor_count_binding_size;
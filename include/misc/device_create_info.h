@@ -88,6 +88,11 @@ namespace Anvil
             return m_helper_command_pool_create_flags;
         }
 
+        Anvil::HostAllocator* get_host_allocator() const
+        {
+            return m_host_allocator_ptr;
+        }
+
         const std::vector<std::string>& get_layers_to_enable() const
         {
             return m_layers_to_enable;
@@ -165,6 +170,60 @@ namespace Anvil
             return result;
         }
 
+        const std::vector<ImageFormatPropertiesQuery>& get_format_capability_cache_prewarm_queries() const
+        {
+            return m_format_capability_cache_prewarm_queries;
+        }
+
+        const VkDeviceSize& get_staging_ring_size() const
+        {
+            return m_staging_ring_size;
+        }
+
+        Anvil::TaskScheduler* get_task_scheduler() const
+        {
+            return m_task_scheduler_ptr;
+        }
+
+        /* Requests device-level extension entry-points to be retrieved the first time any of them is needed, instead of
+         * at device creation time. This shortens device creation for applications which enable many extensions but only
+         * use some of them on start-up.
+         *
+         * By default, entry-points are retrieved at device creation time.
+         */
+        void set_extension_entrypoint_resolution_deferred(const bool& in_should_defer)
+        {
+            m_should_defer_extension_entrypoint_resolution = in_should_defer;
+        }
+
+        /* Requests the format capability memo tables of all physical devices the device is created from to be filled
+         * at device creation time. Please see PhysicalDevice::prewarm_format_capability_cache() for more details.
+         *
+         * By default, the tables are filled lazily.
+         *
+         * @param in_should_prewarm          True to fill the tables at device creation time; false to fill them lazily.
+         * @param in_opt_image_format_queries Image format properties queries to run at device creation time, in addition to
+         *                                    format properties being retrieved for all core formats.
+         */
+        void set_format_capability_cache_prewarm(const bool&                             in_should_prewarm,
+                                                 std::vector<ImageFormatPropertiesQuery> in_opt_image_format_queries = std::vector<ImageFormatPropertiesQuery>() )
+        {
+            m_format_capability_cache_prewarm_queries = std::move(in_opt_image_format_queries);
+            m_should_prewarm_format_capability_cache  = in_should_prewarm;
+        }
+
+        /* Specifies a host allocator to route host memory allocations, which the driver makes for the device and
+         * all device-level objects created by Anvil, to. Please see misc/host_allocator.h for more details.
+         *
+         * By default, the instance's host allocator is used.
+         *
+         * @param in_host_allocator_ptr Allocator to use. Must outlive the device. May be null.
+         **/
+        void set_host_allocator(Anvil::HostAllocator* in_host_allocator_ptr)
+        {
+            m_host_allocator_ptr = in_host_allocator_ptr;
+        }
+
         /* Sets memory overallocation behavior to request at device creation time.
          *
          * NOTE: Requires VK_AMD_memory_overallocation_behavior.
@@ -180,6 +239,11 @@ namespace Anvil
          *
          * NOTE: Requires VK_EXT_global_queue_priority.
          *
+         * NOTE: Vulkan applies global priorities to whole queue families. If queues of the same family are assigned different
+         *       global priorities, all of them will be created with the highest one. If the implementation refuses a priority
+         *       because of insufficient privileges, queues fall back to MEDIUM_EXT. Queue::get_queue_global_priority() reports
+         *       the priority which was actually granted.
+         *
          * @param in_queue_family_index    Index of the queue family to use for the association.
          * @param in_queue_index           Index of the queue belonging to queue family with index @param in_queue_family_index
          *                                 to use for the association.
@@ -234,16 +298,76 @@ namespace Anvil
             m_queue_properties[in_queue_family_index][in_queue_index].is_protected_capable = in_should_enable;
         }
 
+        /* Specifies the size of the device-wide staging ring, which buffers & images use to transfer data to and from
+         * non-mappable memory.
+         *
+         * When enabled, Buffer::write() and Image::upload_mipmaps() no longer block until the transfer finishes GPU-side.
+         * Subsequent work submitted to the queue used for the transfer is correctly ordered against it. Work submitted
+         * to other queues must be synchronized by the app.
+         *
+         * Transfers which do not fit in the ring fall back to dedicated staging buffers. The ring is only used by single-GPU devices.
+         *
+         * By default, the staging ring is disabled (size of 0).
+         *
+         * @param in_size Size of the ring in bytes, or 0 to disable the ring.
+         */
+        void set_staging_ring_size(const VkDeviceSize& in_size)
+        {
+            m_staging_ring_size = in_size;
+        }
+
+        /* Requests narrow-type storage & arithmetic features to be enabled, if supported, and exposed to shaders.
+         *
+         * The following extensions are enabled if available, even if the extension configuration specified at creation
+         * time ignores them: VK_KHR_16bit_storage, VK_KHR_8bit_storage, VK_KHR_shader_float16_int8,
+         * VK_EXT_scalar_block_layout and their dependency VK_KHR_storage_buffer_storage_class. Anvil enables all features
+         * an enabled extension reports as supported.
+         *
+         * Every GLSLShaderToSPIRVGenerator created for the device then receives a "#define <name> 1" line for each
+         * enabled feature. Please see BaseDevice::get_storage_feature_shader_definitions() for the list of names.
+         * Shaders are expected to enable the matching GLSL extensions under these guards.
+         *
+         * Disabled by default.
+         */
+        void set_storage_feature_probe(const bool& in_should_probe);
+
+        /* Specifies a task scheduler to run all CPU-parallel work Anvil performs for the device on, eg. parallel
+         * pipeline baking. Please see misc/task_scheduler.h for more details.
+         *
+         * By default, the device creates its own WorkStealingTaskScheduler when it first needs one.
+         *
+         * @param in_task_scheduler_ptr Scheduler to use. Must outlive the device. May be null.
+         **/
+        void set_task_scheduler(Anvil::TaskScheduler* in_task_scheduler_ptr)
+        {
+            m_task_scheduler_ptr = in_task_scheduler_ptr;
+        }
+
         const bool& should_be_mt_safe() const
         {
             return m_mt_safe;
         }
 
+        const bool& should_defer_extension_entrypoint_resolution() const
+        {
+            return m_should_defer_extension_entrypoint_resolution;
+        }
+
         const bool& should_enable_shader_module_cache() const
         {
             return m_should_enable_shader_module_cache;
         }
 
+        const bool& should_prewarm_format_capability_cache() const
+        {
+            return m_should_prewarm_format_capability_cache;
+        }
+
+        const bool& should_probe_storage_features() const
+        {
+            return m_should_probe_storage_features;
+        }
+
     private:
         /* Private type definitions */
         typedef struct QueueProperties
@@ -271,14 +395,21 @@ namespace Anvil
 
         /* Private variables */
         DeviceExtensionConfiguration                                                 m_extension_configuration;
+        std::vector<ImageFormatPropertiesQuery>                                      m_format_capability_cache_prewarm_queries;
         Anvil::CommandPoolCreateFlags                                                m_helper_command_pool_create_flags;
+        Anvil::HostAllocator*                                                        m_host_allocator_ptr;
         std::vector<std::string>                                                     m_layers_to_enable;
         Anvil::MemoryOverallocationBehavior                                          m_memory_overallocation_behavior;
         bool                                                                         m_mt_safe;
         std::vector<const Anvil::PhysicalDevice*>                                    m_physical_device_ptrs;
         Anvil::PipelineCacheUniquePtr                                                m_pipeline_cache_ptr;
         std::unordered_map<uint32_t, std::unordered_map<uint32_t, QueueProperties> > m_queue_properties;
+        bool                                                                         m_should_defer_extension_entrypoint_resolution;
         bool                                                                         m_should_enable_shader_module_cache;
+        bool                                                                         m_should_prewarm_format_capability_cache;
+        bool                                                                         m_should_probe_storage_features;
+        VkDeviceSize                                                                 m_staging_ring_size;
+        Anvil::TaskScheduler*                                                        m_task_scheduler_ptr;
 
         ANVIL_DISABLE_ASSIGNMENT_OPERATOR(DeviceCreateInfo);
         ANVIL_DISABLE_COPY_CONSTRUCTOR(DeviceCreateInfo);
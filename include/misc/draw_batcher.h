@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements CPU-side batching of indexed draws into multi-draw indirect calls.
+ *
+ *  Renderers often issue thousands of indexed draws which share the pipeline and bindings, and only differ in
+ *  draw arguments. Recording each of these as a separate vkCmdDrawIndexed() call is CPU-bound. The draw batcher
+ *  collects such draws in buckets, identified by an application-defined 64-bit key which should uniquely describe
+ *  the state the draws need (pipeline, descriptor sets, index & vertex buffers, etc.). At record time, each
+ *  bucket's VkDrawIndexedIndirectCommand items are written to memory sub-allocated from a TransientBufferAllocator,
+ *  and the bucket is drawn with a single vkCmdDrawIndexedIndirect() call.
+ *
+ *  If the multiDrawIndirect feature is not enabled, a separate indirect call is recorded for each draw. Buckets
+ *  holding more than maxDrawIndirectCount draws are split into multiple calls.
+ *
+ *  Usage:
+ *
+ *  1. Create a TransientBufferAllocator with INDIRECT_BUFFER usage, and call its begin_frame() once per frame,
+ *     as usual.
+ *  2. Call add_draw_indexed() for each draw.
+ *  3. For each key returned by get_bucket_keys(), bind the state the key stands for and call record_bucket().
+ *     Alternatively, call record_buckets() with a function which binds the state.
+ *  4. Call reset() before collecting draws for the next frame. Allocated bucket storage is retained.
+ *
+ *  Draws which use a non-zero first instance index require the drawIndirectFirstInstance feature.
+ *
+ *  Draw batcher is NOT thread-safe.
+ */
+#ifndef MISC_DRAW_BATCHER_H
+#define MISC_DRAW_BATCHER_H
+
+#include "misc/types.h"
+#include <unordered_map>
+
+
+namespace Anvil
+{
+    class DrawBatcher
+    {
+    public:
+        /* Public type definitions */
+
+        /** Function which binds the state a bucket key stands for. Should return false if the bucket should be skipped. */
+        typedef std::function<bool(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                   uint64_t                  in_bucket_key)> BindStateFunction;
+
+        /* Public functions */
+
+        /** Creates a new draw batcher instance.
+         *
+         *  @param in_device_ptr              Device to create the batcher for. Must not be null.
+         *  @param in_transient_allocator_ptr Allocator to store indirect draw commands in. Must not be null, and must have
+         *                                    been created with INDIRECT_BUFFER usage. Must outlive the batcher.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::DrawBatcherUniquePtr create(const Anvil::BaseDevice*         in_device_ptr,
+                                                  Anvil::TransientBufferAllocator* in_transient_allocator_ptr);
+
+        /** Destructor */
+        ~DrawBatcher();
+
+        /** Queues an indexed draw in the bucket identified by @param in_bucket_key. Arguments match those
+         *  of vkCmdDrawIndexed().
+         *
+         *  Buckets are created on first use, and are reported by get_bucket_keys() in that order.
+         */
+        void add_draw_indexed(uint64_t in_bucket_key,
+                              uint32_t in_index_count,
+                              uint32_t in_instance_count,
+                              uint32_t in_first_index,
+                              int32_t  in_vertex_offset,
+                              uint32_t in_first_instance);
+
+        /** Returns keys of all buckets which hold draws, in order of first use since the last reset() call. */
+        const std::vector<uint64_t>& get_bucket_keys() const
+        {
+            return m_active_bucket_keys;
+        }
+
+        /** Returns the number of draws queued in the specified bucket. */
+        uint32_t get_n_draws(uint64_t in_bucket_key) const;
+
+        /** Returns the number of indirect draw calls recorded since the last reset() call. */
+        uint32_t get_n_recorded_draw_calls() const
+        {
+            return m_n_recorded_draw_calls;
+        }
+
+        /** Records the draws queued in the specified bucket. Must be called inside a renderpass, after the state
+         *  the bucket key stands for has been bound.
+         *
+         *  The draws are kept in the bucket until reset() is called, so the bucket can be recorded again, eg. for
+         *  another view.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the commands to. Must be in recording state.
+         *  @param in_bucket_key     Key of the bucket to record. Recording an empty or unknown bucket is a no-op.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_bucket(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                           uint64_t                  in_bucket_key);
+
+        /** Records all buckets, in the order reported by get_bucket_keys(). @param in_bind_state_function is called
+         *  before each bucket is recorded.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_buckets(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                            const BindStateFunction&  in_bind_state_function);
+
+        /** Drops all queued draws. Storage allocated for the buckets is retained for reuse. */
+        void reset();
+
+    private:
+        /* Private type definitions */
+        typedef struct Bucket
+        {
+            std::vector<VkDrawIndexedIndirectCommand> draws;
+        } Bucket;
+
+        /* Private functions */
+        DrawBatcher(const Anvil::BaseDevice*         in_device_ptr,
+                    Anvil::TransientBufferAllocator* in_transient_allocator_ptr);
+
+        /* Private variables */
+        std::vector<uint64_t>                  m_active_bucket_keys;
+        std::unordered_map<uint64_t, Bucket>   m_buckets;
+        const Anvil::BaseDevice*               m_device_ptr;
+        bool                                   m_draw_indirect_first_instance_supported;
+        uint32_t                               m_max_draws_per_call;
+        uint32_t                               m_n_recorded_draw_calls;
+        Anvil::TransientBufferAllocator*       m_transient_allocator_ptr;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(DrawBatcher);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(DrawBatcher);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_DRAW_BATCHER_H */
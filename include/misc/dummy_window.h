@@ -27,7 +27,12 @@
 #ifndef DUMMY_WINDOW_H
 #define DUMMY_WINDOW_H
 
+#include "misc/readback_ring.h"
 #include "misc/window.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 namespace Anvil
 {
@@ -79,17 +84,27 @@ namespace Anvil
     class DummyWindowWithPNGSnapshots : public DummyWindow
     {
     public:
+        /* Public type definitions */
+
+        /** Tells how captured frames should be stored. */
+        enum class SnapshotFormat
+        {
+            /* Frames are compressed to <title>_<n frame>.png files. */
+            PNG,
+
+            /* Frames are stored in <title>_<n frame>.rgba files, holding tightly packed R8G8B8A8_UNORM texels.
+             * Skips compression, so it is considerably cheaper than PNG for long headless runs. */
+            RAW_R8G8B8A8_UNORM,
+        };
+
         /* Public methods */
         static Anvil::WindowUniquePtr create(const std::string&      in_title,
                                              unsigned int            in_width,
                                              unsigned int            in_height,
                                              PresentCallbackFunction in_present_callback_func);
 
-        /** Destructor */
-        virtual ~DummyWindowWithPNGSnapshots()
-        {
-            /* Stub */
-        }
+        /** Destructor. Waits until all snapshots have been stored. */
+        virtual ~DummyWindowWithPNGSnapshots();
 
         /* Returns window's platform */
         WindowPlatform get_platform() const
@@ -97,6 +112,21 @@ namespace Anvil
             return WINDOW_PLATFORM_DUMMY_WITH_PNG_SNAPSHOTS;
         }
 
+        /** Returns format used to store captured frames. */
+        SnapshotFormat get_snapshot_format() const
+        {
+            return m_snapshot_format;
+        }
+
+        /** Captures the swapchain image which has been presented last and writes it to a PNG file, after every
+         *  present, until the window is closed.
+         *
+         *  Captures are asynchronous: each frame is copied to a readback ring and only written out once the copy
+         *  completes, so up to a few frames may be in flight at any time. Frames still in flight when the window
+         *  is closed are written out before the function returns.
+         *
+         *  Encoding and file I/O happen on a small pool of worker threads, so that they do not stall rendering.
+         */
         void run();
 
         /** Assigns a swapchain to the window.
@@ -107,33 +137,105 @@ namespace Anvil
          */
         void set_swapchain(Anvil::Swapchain* in_swapchain_ptr);
 
+        /** Changes format used to store captured frames. Must not be called while run() is executing.
+         *
+         *  The default format is SnapshotFormat::PNG.
+         */
+        void set_snapshot_format(SnapshotFormat in_format)
+        {
+            m_snapshot_format = in_format;
+        }
+
     private:
+        /* Private type definitions */
+        typedef struct PendingFrame
+        {
+            Anvil::PrimaryCommandBufferUniquePtr cmd_buffer_ptr;
+            Anvil::FenceUniquePtr                fence_ptr;
+            uint32_t                             height;
+            uint32_t                             n_frame;
+            Anvil::ReadbackRing::ReadbackID      readback_id;
+            uint32_t                             width;
+
+            PendingFrame()
+                :height     (0),
+                 n_frame    (0),
+                 readback_id(UINT64_MAX),
+                 width      (0)
+            {
+                /* Stub */
+            }
+        } PendingFrame;
+
         /* Private functions */
         DummyWindowWithPNGSnapshots(const std::string&      in_title,
                                     unsigned int            in_width,
                                     unsigned int            in_height,
                                     PresentCallbackFunction in_present_callback_func);
 
-        /** Grabs contents of the specified swapchain image and returns them in a raw R8G8B8A8_UNORM
-         *  format.
+        /** Submits a copy of the last acquired swapchain image, converted to R8G8B8A8_UNORM, to the readback ring.
+         *  Does not wait for the copy to complete.
          *
-         *  NOTE: This solution is temporary. At some point, this function is going to be exposed 
-         *        in Image interface.
+         *  @return true if successful, false otherwise.
+         */
+        bool capture_swapchain_frame();
+
+        /** Appends a request to the encoder queue and wakes up an idle encoder thread. Blocks if the queue is
+         *  full, so that memory usage stays bounded when the encoders cannot keep up with the GPU.
+         */
+        void enqueue_encode_request(std::function<void()> in_request);
+
+        /** Entry-point for the encoder threads. Serves requests until stop_encoder_threads() is called and
+         *  the queue is drained.
+         */
+        void encoder_thread_main();
+
+        /** Records commands which convert @param in_swapchain_image_ptr contents to R8G8B8A8_UNORM and copy them
+         *  to the readback ring.
          *
-         *  @param in_swapchain_image_ptr Swapchain image, whose contents should be extracted.
+         *  @return true if successful, false if the readback ring does not have enough free space.
+         */
+        bool record_capture_commands(Anvil::PrimaryCommandBuffer*     in_command_buffer_ptr,
+                                     Anvil::Image*                    in_swapchain_image_ptr,
+                                     uint32_t                         in_width,
+                                     uint32_t                         in_height,
+                                     Anvil::ReadbackRing::ReadbackID* out_readback_id_ptr);
+
+        /** Spawns the encoder threads, if they are not already running. */
+        void start_encoder_threads();
+
+        /** Serves all pending encode requests and joins the encoder threads. */
+        void stop_encoder_threads();
+
+        /** Hands captured frames over to the encoder threads, in presentation order.
          *
-         *  @return As per summary.
+         *  @param in_n_frames_to_wait_for Number of oldest frames to hand over, even if this requires waiting for
+         *                                 their captures to complete. Frames after these are only handed over if
+         *                                 their captures have already completed.
          */
-        std::unique_ptr<uint8_t[]> get_swapchain_image_raw_r8g8b8a8_unorm_data(Anvil::Image* in_swapchain_image_ptr);
+        void store_pending_frames(uint32_t in_n_frames_to_wait_for);
 
-        /** Grabs fake swapchain image contents and stores it in a PNG file. */
+        /** Hands completed captures over to the encoders and kicks off a capture of the last presented frame. */
         void store_swapchain_frame();
 
         /* Private members */
-        uint32_t    m_height;
-        uint32_t    m_n_frames_presented;
-        std::string m_title;
-        uint32_t    m_width;
+        uint32_t                           m_height;
+        Anvil::ImageUniquePtr              m_intermediate_image_ptr;
+        bool                               m_intermediate_image_used;
+        uint32_t                           m_n_frames_presented;
+        std::deque<PendingFrame>           m_pending_frames;
+        Anvil::ReadbackRingUniquePtr       m_readback_ring_ptr;
+        SnapshotFormat                     m_snapshot_format;
+        std::string                        m_title;
+        uint32_t                           m_width;
+
+        std::deque<std::function<void()> > m_encode_requests;
+        std::condition_variable            m_encoder_idle_cv;
+        std::mutex                         m_encoder_mutex;
+        std::vector<std::thread>           m_encoder_threads;
+        std::condition_variable            m_encoder_wake_cv;
+        uint32_t                           m_n_busy_encoder_threads;
+        bool                               m_should_encoder_threads_quit;
 
         Anvil::Swapchain* m_swapchain_ptr;
     };
@@ -50,18 +50,25 @@ namespace Anvil
             ValueType amd_shader_trinary_minmax;
             ValueType amd_texture_gather_bias_lod;
 
+            ValueType ext_calibrated_timestamps;
+            ValueType ext_conditional_rendering;
             ValueType ext_conservative_rasterization;
             ValueType ext_debug_marker;
             ValueType ext_depth_clip_enable;
             ValueType ext_depth_range_unrestricted;
             ValueType ext_descriptor_indexing;
             ValueType ext_pci_bus_info;
+            ValueType ext_pipeline_creation_feedback;
+            ValueType ext_external_memory_dma_buf;
             ValueType ext_external_memory_host;
             ValueType ext_global_priority;
             ValueType ext_hdr_metadata;
+            ValueType ext_host_image_copy;
+            ValueType ext_host_query_reset;
             ValueType ext_inline_uniform_block;
             ValueType ext_memory_budget;
             ValueType ext_memory_priority;
+            ValueType ext_pageable_device_local_memory;
             ValueType ext_queue_family_foreign;
             ValueType ext_sample_locations;
             ValueType ext_sampler_filter_minmax;
@@ -71,21 +78,27 @@ namespace Anvil
             ValueType ext_shader_subgroup_ballot;
             ValueType ext_shader_subgroup_vote;
             ValueType ext_shader_viewport_index_layer;
+            ValueType ext_subgroup_size_control;
             ValueType ext_swapchain_colorspace;
             ValueType ext_transform_feedback;
             ValueType ext_vertex_attribute_divisor;
             ValueType google_decorate_string;
+            ValueType google_display_timing;
             ValueType google_hlsl_functionality1;
             ValueType khr_16bit_storage;
             ValueType khr_8bit_storage;
+            ValueType khr_acceleration_structure;
             ValueType khr_bind_memory2;
+            ValueType khr_buffer_device_address;
             ValueType khr_create_renderpass2;
             ValueType khr_dedicated_allocation;
+            ValueType khr_deferred_host_operations;
             ValueType khr_depth_stencil_resolve;
             ValueType khr_descriptor_update_template;
             ValueType khr_device_group;
             ValueType khr_draw_indirect_count;
             ValueType khr_driver_properties;
+            ValueType khr_dynamic_rendering;
             ValueType khr_external_fence;
             ValueType khr_external_memory;
             ValueType khr_external_semaphore;
@@ -102,10 +115,13 @@ namespace Anvil
 
             ValueType khr_get_memory_requirements2;
             ValueType khr_image_format_list;
+            ValueType khr_imageless_framebuffer;
             ValueType khr_maintenance1;
             ValueType khr_maintenance2;
             ValueType khr_maintenance3;
             ValueType khr_multiview;
+            ValueType khr_pipeline_executable_properties;
+            ValueType khr_push_descriptor;
             ValueType khr_relaxed_block_layout;
             ValueType khr_sampler_mirror_clamp_to_edge;
             ValueType khr_sampler_ycbcr_conversion;
@@ -116,8 +132,11 @@ namespace Anvil
             ValueType khr_storage_buffer_storage_class;
             ValueType khr_swapchain;
             ValueType khr_swapchain_mutable_format;
+            ValueType khr_timeline_semaphore;
             ValueType khr_variable_pointers;
             ValueType khr_vulkan_memory_model;
+            ValueType nv_mesh_shader;
+            ValueType nv_shading_rate_image;
 
             #if defined(_WIN32)
                 ValueType khr_win32_keyed_mutex;
@@ -162,18 +181,25 @@ namespace Anvil
                     {ExtensionData(VK_AMD_SHADER_INFO_EXTENSION_NAME,                      &amd_shader_info)},
                     {ExtensionData(VK_AMD_SHADER_TRINARY_MINMAX_EXTENSION_NAME,            &amd_shader_trinary_minmax)},
                     {ExtensionData(VK_AMD_TEXTURE_GATHER_BIAS_LOD_EXTENSION_NAME,          &amd_texture_gather_bias_lod)},
+                    {ExtensionData(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME,            &ext_calibrated_timestamps)},
+                    {ExtensionData(VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME,            &ext_conditional_rendering)},
                     {ExtensionData(VK_EXT_CONSERVATIVE_RASTERIZATION_EXTENSION_NAME,       &ext_conservative_rasterization)},
                     {ExtensionData(VK_EXT_DEBUG_MARKER_EXTENSION_NAME,                     &ext_debug_marker)},
                     {ExtensionData(VK_EXT_DEPTH_CLIP_ENABLE_EXTENSION_NAME,                &ext_depth_clip_enable)},
                     {ExtensionData(VK_EXT_DEPTH_RANGE_UNRESTRICTED_EXTENSION_NAME,         &ext_depth_range_unrestricted)},
                     {ExtensionData(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME,              &ext_descriptor_indexing)},
+                    {ExtensionData(VK_EXT_EXTERNAL_MEMORY_DMA_BUF_EXTENSION_NAME,          &ext_external_memory_dma_buf)},
                     {ExtensionData(VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME,             &ext_external_memory_host)},
                     {ExtensionData(VK_EXT_GLOBAL_PRIORITY_EXTENSION_NAME,                  &ext_global_priority)},
                     {ExtensionData(VK_EXT_HDR_METADATA_EXTENSION_NAME,                     &ext_hdr_metadata)},
+                    {ExtensionData(VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME,                  &ext_host_image_copy)},
+                    {ExtensionData(VK_EXT_HOST_QUERY_RESET_EXTENSION_NAME,                 &ext_host_query_reset)},
                     {ExtensionData(VK_EXT_INLINE_UNIFORM_BLOCK_EXTENSION_NAME,             &ext_inline_uniform_block)},
                     {ExtensionData(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,                    &ext_memory_budget)},
                     {ExtensionData(VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME,                  &ext_memory_priority)},
+                    {ExtensionData(VK_EXT_PAGEABLE_DEVICE_LOCAL_MEMORY_EXTENSION_NAME,     &ext_pageable_device_local_memory)},
                     {ExtensionData(VK_EXT_PCI_BUS_INFO_EXTENSION_NAME,                     &ext_pci_bus_info)},
+                    {ExtensionData(VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME,       &ext_pipeline_creation_feedback)},
                     {ExtensionData(VK_EXT_QUEUE_FAMILY_FOREIGN_EXTENSION_NAME,             &ext_queue_family_foreign)},
                     {ExtensionData(VK_EXT_SAMPLE_LOCATIONS_EXTENSION_NAME,                 &ext_sample_locations)},
                     {ExtensionData(VK_EXT_SAMPLER_FILTER_MINMAX_EXTENSION_NAME,            &ext_sampler_filter_minmax)},
@@ -183,21 +209,27 @@ namespace Anvil
                     {ExtensionData(VK_EXT_SHADER_SUBGROUP_BALLOT_EXTENSION_NAME,           &ext_shader_subgroup_ballot)},
                     {ExtensionData(VK_EXT_SHADER_SUBGROUP_VOTE_EXTENSION_NAME,             &ext_shader_subgroup_vote)},
                     {ExtensionData(VK_EXT_SHADER_VIEWPORT_INDEX_LAYER_EXTENSION_NAME,      &ext_shader_viewport_index_layer)},
+                    {ExtensionData(VK_EXT_SUBGROUP_SIZE_CONTROL_EXTENSION_NAME,            &ext_subgroup_size_control)},
                     {ExtensionData(VK_EXT_SWAPCHAIN_COLOR_SPACE_EXTENSION_NAME,            &ext_swapchain_colorspace)},
                     {ExtensionData(VK_EXT_TRANSFORM_FEEDBACK_EXTENSION_NAME,               &ext_transform_feedback)},
                     {ExtensionData(VK_EXT_VERTEX_ATTRIBUTE_DIVISOR_EXTENSION_NAME,         &ext_vertex_attribute_divisor)},
                     {ExtensionData(VK_GOOGLE_DECORATE_STRING_EXTENSION_NAME,               &google_decorate_string)},
+                    {ExtensionData(VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME,                &google_display_timing)},
                     {ExtensionData(VK_GOOGLE_HLSL_FUNCTIONALITY1_EXTENSION_NAME,           &google_hlsl_functionality1)},
                     {ExtensionData(VK_KHR_16BIT_STORAGE_EXTENSION_NAME,                    &khr_16bit_storage)},
                     {ExtensionData(VK_KHR_8BIT_STORAGE_EXTENSION_NAME,                     &khr_8bit_storage)},
+                    {ExtensionData(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME,           &khr_acceleration_structure)},
                     {ExtensionData(VK_KHR_BIND_MEMORY_2_EXTENSION_NAME,                    &khr_bind_memory2)},
+                    {ExtensionData(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME,            &khr_buffer_device_address)},
                     {ExtensionData(VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME,              &khr_create_renderpass2)},
                     {ExtensionData(VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME,             &khr_dedicated_allocation)},
+                    {ExtensionData(VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME,         &khr_deferred_host_operations)},
                     {ExtensionData(VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME,            &khr_depth_stencil_resolve)},
                     {ExtensionData(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME,       &khr_descriptor_update_template)},
                     {ExtensionData(VK_KHR_DEVICE_GROUP_EXTENSION_NAME,                     &khr_device_group)},
                     {ExtensionData(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME,              &khr_draw_indirect_count)},
                     {ExtensionData(VK_KHR_DRIVER_PROPERTIES_EXTENSION_NAME,                &khr_driver_properties)},
+                    {ExtensionData(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME,                &khr_dynamic_rendering)},
                     {ExtensionData(VK_KHR_EXTERNAL_FENCE_EXTENSION_NAME,                   &khr_external_fence)},
                     {ExtensionData(VK_KHR_EXTERNAL_MEMORY_EXTENSION_NAME,                  &khr_external_memory)},
                     {ExtensionData(VK_KHR_EXTERNAL_SEMAPHORE_EXTENSION_NAME,               &khr_external_semaphore)},
@@ -212,10 +244,13 @@ namespace Anvil
                     #endif
                     {ExtensionData(VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME,        &khr_get_memory_requirements2)},
                     {ExtensionData(VK_KHR_IMAGE_FORMAT_LIST_EXTENSION_NAME,                &khr_image_format_list)},
+                    {ExtensionData(VK_KHR_IMAGELESS_FRAMEBUFFER_EXTENSION_NAME,            &khr_imageless_framebuffer)},
                     {ExtensionData(VK_KHR_MAINTENANCE1_EXTENSION_NAME,                     &khr_maintenance1)},
                     {ExtensionData(VK_KHR_MAINTENANCE2_EXTENSION_NAME,                     &khr_maintenance2)},
                     {ExtensionData(VK_KHR_MAINTENANCE3_EXTENSION_NAME,                     &khr_maintenance3)},
                     {ExtensionData(VK_KHR_MULTIVIEW_EXTENSION_NAME,                        &khr_multiview)},
+                    {ExtensionData(VK_KHR_PIPELINE_EXECUTABLE_PROPERTIES_EXTENSION_NAME,   &khr_pipeline_executable_properties)},
+                    {ExtensionData(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME,                  &khr_push_descriptor)},
                     {ExtensionData(VK_KHR_RELAXED_BLOCK_LAYOUT_EXTENSION_NAME,             &khr_relaxed_block_layout)},
                     {ExtensionData(VK_KHR_SAMPLER_MIRROR_CLAMP_TO_EDGE_EXTENSION_NAME,     &khr_sampler_mirror_clamp_to_edge)},
                     {ExtensionData(VK_KHR_SAMPLER_YCBCR_CONVERSION_EXTENSION_NAME,         &khr_sampler_ycbcr_conversion)},
@@ -226,8 +261,11 @@ namespace Anvil
                     {ExtensionData(VK_KHR_STORAGE_BUFFER_STORAGE_CLASS_EXTENSION_NAME,     &khr_storage_buffer_storage_class)},
                     {ExtensionData(VK_KHR_SWAPCHAIN_EXTENSION_NAME,                        &khr_swapchain)},
                     {ExtensionData(VK_KHR_SWAPCHAIN_MUTABLE_FORMAT_EXTENSION_NAME,         &khr_swapchain_mutable_format)},
+                    {ExtensionData(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME,               &khr_timeline_semaphore)},
                     {ExtensionData(VK_KHR_VARIABLE_POINTERS_EXTENSION_NAME,                &khr_variable_pointers)},
                     {ExtensionData(VK_KHR_VULKAN_MEMORY_MODEL_EXTENSION_NAME,              &khr_vulkan_memory_model)},
+                    {ExtensionData(VK_NV_MESH_SHADER_EXTENSION_NAME,                       &nv_mesh_shader)},
+                    {ExtensionData(VK_NV_SHADING_RATE_IMAGE_EXTENSION_NAME,                &nv_shading_rate_image)},
 
                     #if defined(_WIN32)
                         {ExtensionData(VK_KHR_WIN32_KEYED_MUTEX_EXTENSION_NAME, &khr_win32_keyed_mutex)},
@@ -364,18 +402,25 @@ namespace Anvil
         virtual ValueType amd_shader_info                     () const = 0;
         virtual ValueType amd_shader_trinary_minmax           () const = 0;
         virtual ValueType amd_texture_gather_bias_lod         () const = 0;
+        virtual ValueType ext_calibrated_timestamps           () const = 0;
+        virtual ValueType ext_conditional_rendering           () const = 0;
         virtual ValueType ext_conservative_rasterization      () const = 0;
         virtual ValueType ext_debug_marker                    () const = 0;
         virtual ValueType ext_depth_clip_enable               () const = 0;
         virtual ValueType ext_depth_range_unrestricted        () const = 0;
         virtual ValueType ext_descriptor_indexing             () const = 0;
+        virtual ValueType ext_external_memory_dma_buf         () const = 0;
         virtual ValueType ext_external_memory_host            () const = 0;
         virtual ValueType ext_global_priority                 () const = 0;
         virtual ValueType ext_hdr_metadata                    () const = 0;
+        virtual ValueType ext_host_image_copy                 () const = 0;
+        virtual ValueType ext_host_query_reset                () const = 0;
         virtual ValueType ext_inline_uniform_block            () const = 0;
         virtual ValueType ext_memory_budget                   () const = 0;
         virtual ValueType ext_memory_priority                 () const = 0;
+        virtual ValueType ext_pageable_device_local_memory    () const = 0;
         virtual ValueType ext_pci_bus_info                    () const = 0;
+        virtual ValueType ext_pipeline_creation_feedback      () const = 0;
         virtual ValueType ext_queue_family_foreign            () const = 0;
         virtual ValueType ext_sample_locations                () const = 0;
         virtual ValueType ext_sampler_filter_minmax           () const = 0;
@@ -385,21 +430,27 @@ namespace Anvil
         virtual ValueType ext_shader_subgroup_ballot          () const = 0;
         virtual ValueType ext_shader_subgroup_vote            () const = 0;
         virtual ValueType ext_shader_viewport_index_layer     () const = 0;
+        virtual ValueType ext_subgroup_size_control           () const = 0;
         virtual ValueType ext_swapchain_colorspace            () const = 0;
         virtual ValueType ext_transform_feedback              () const = 0;
         virtual ValueType ext_vertex_attribute_divisor        () const = 0;
         virtual ValueType google_decorate_string              () const = 0;
+        virtual ValueType google_display_timing               () const = 0;
         virtual ValueType google_hlsl_functionality1          () const = 0;
         virtual ValueType khr_16bit_storage                   () const = 0;
         virtual ValueType khr_8bit_storage                    () const = 0;
+        virtual ValueType khr_acceleration_structure          () const = 0;
         virtual ValueType khr_bind_memory2                    () const = 0;
+        virtual ValueType khr_buffer_device_address           () const = 0;
         virtual ValueType khr_create_renderpass2              () const = 0;
         virtual ValueType khr_dedicated_allocation            () const = 0;
+        virtual ValueType khr_deferred_host_operations        () const = 0;
         virtual ValueType khr_depth_stencil_resolve           () const = 0;
         virtual ValueType khr_descriptor_update_template      () const = 0;
         virtual ValueType khr_device_group                    () const = 0;
         virtual ValueType khr_draw_indirect_count             () const = 0;
         virtual ValueType khr_driver_properties               () const = 0;
+        virtual ValueType khr_dynamic_rendering               () const = 0;
         virtual ValueType khr_external_fence                  () const = 0;
         virtual ValueType khr_external_memory                 () const = 0;
         virtual ValueType khr_external_semaphore              () const = 0;
@@ -414,10 +465,13 @@ namespace Anvil
         #endif
         virtual ValueType khr_get_memory_requirements2        () const = 0;
         virtual ValueType khr_image_format_list               () const = 0;
+        virtual ValueType khr_imageless_framebuffer           () const = 0;
         virtual ValueType khr_maintenance1                    () const = 0;
         virtual ValueType khr_maintenance2                    () const = 0;
         virtual ValueType khr_maintenance3                    () const = 0;
         virtual ValueType khr_multiview                       () const = 0;
+        virtual ValueType khr_pipeline_executable_properties  () const = 0;
+        virtual ValueType khr_push_descriptor                 () const = 0;
         virtual ValueType khr_relaxed_block_layout            () const = 0;
         virtual ValueType khr_sampler_mirror_clamp_to_edge    () const = 0;
         virtual ValueType khr_sampler_ycbcr_conversion        () const = 0;
@@ -428,8 +482,11 @@ namespace Anvil
         virtual ValueType khr_storage_buffer_storage_class    () const = 0;
         virtual ValueType khr_swapchain                       () const = 0;
         virtual ValueType khr_swapchain_mutable_format        () const = 0;
+        virtual ValueType khr_timeline_semaphore              () const = 0;
         virtual ValueType khr_variable_pointers               () const = 0;
         virtual ValueType khr_vulkan_memory_model             () const = 0;
+        virtual ValueType nv_mesh_shader                      () const = 0;
+        virtual ValueType nv_shading_rate_image               () const = 0;
 
         #if defined(_WIN32)
             virtual ValueType khr_win32_keyed_mutex() const = 0;
@@ -674,6 +731,20 @@ namespace Anvil
             return m_device_extensions_ptr->amd_texture_gather_bias_lod;
         }
 
+        ValueType ext_calibrated_timestamps() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->ext_calibrated_timestamps;
+        }
+
+        ValueType ext_conditional_rendering() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->ext_conditional_rendering;
+        }
+
         ValueType ext_conservative_rasterization() const final
         {
             anvil_assert(m_expose_device_extensions);
@@ -709,6 +780,13 @@ namespace Anvil
             return m_device_extensions_ptr->ext_descriptor_indexing;
         }
 
+        ValueType ext_external_memory_dma_buf() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->ext_external_memory_dma_buf;
+        }
+
         ValueType ext_external_memory_host() const final
         {
             anvil_assert(m_expose_device_extensions);
@@ -730,6 +808,20 @@ namespace Anvil
             return m_device_extensions_ptr->ext_hdr_metadata;
         }
 
+        ValueType ext_host_image_copy() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->ext_host_image_copy;
+        }
+
+        ValueType ext_host_query_reset() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->ext_host_query_reset;
+        }
+
         ValueType ext_inline_uniform_block() const final
         {
             anvil_assert(m_expose_device_extensions);
@@ -737,6 +829,13 @@ namespace Anvil
             return m_device_extensions_ptr->ext_inline_uniform_block;
         }
 
+        ValueType ext_pageable_device_local_memory() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->ext_pageable_device_local_memory;
+        }
+
         ValueType ext_pci_bus_info() const final
         {
             anvil_assert(m_expose_device_extensions);
@@ -744,6 +843,13 @@ namespace Anvil
             return m_device_extensions_ptr->ext_pci_bus_info;
         }
 
+        ValueType ext_pipeline_creation_feedback() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->ext_pipeline_creation_feedback;
+        }
+
         ValueType ext_queue_family_foreign() const final
         {
             anvil_assert(m_expose_device_extensions);
@@ -808,6 +914,13 @@ namespace Anvil
             return m_device_extensions_ptr->ext_shader_viewport_index_layer;
         }
 
+        ValueType ext_subgroup_size_control() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->ext_subgroup_size_control;
+        }
+
         ValueType ext_vertex_attribute_divisor() const final
         {
             anvil_assert(m_expose_device_extensions);
@@ -850,6 +963,13 @@ namespace Anvil
             return m_device_extensions_ptr->google_decorate_string;
         }
 
+        ValueType google_display_timing() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->google_display_timing;
+        }
+
         ValueType google_hlsl_functionality1() const final
         {
             anvil_assert(m_expose_device_extensions);
@@ -871,6 +991,13 @@ namespace Anvil
             return m_device_extensions_ptr->khr_8bit_storage;
         }
 
+        ValueType khr_acceleration_structure() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->khr_acceleration_structure;
+        }
+
         ValueType khr_bind_memory2() const final
         {
             anvil_assert(m_expose_device_extensions);
@@ -878,6 +1005,13 @@ namespace Anvil
             return m_device_extensions_ptr->khr_bind_memory2;
         }
 
+        ValueType khr_buffer_device_address() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->khr_buffer_device_address;
+        }
+
         ValueType khr_create_renderpass2() const final
         {
             anvil_assert(m_expose_device_extensions);
@@ -892,6 +1026,13 @@ namespace Anvil
             return m_device_extensions_ptr->khr_dedicated_allocation;
         }
 
+        ValueType khr_deferred_host_operations() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->khr_deferred_host_operations;
+        }
+
         ValueType khr_depth_stencil_resolve() const final
         {
             anvil_assert(m_expose_device_extensions);
@@ -927,6 +1068,13 @@ namespace Anvil
             return m_device_extensions_ptr->khr_driver_properties;
         }
 
+        ValueType khr_dynamic_rendering() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->khr_dynamic_rendering;
+        }
+
         ValueType khr_external_fence() const final
         {
             anvil_assert(m_expose_device_extensions);
@@ -1010,6 +1158,13 @@ namespace Anvil
             return m_device_extensions_ptr->khr_image_format_list;
         }
 
+        ValueType khr_imageless_framebuffer() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->khr_imageless_framebuffer;
+        }
+
         ValueType khr_maintenance1() const final
         {
             anvil_assert(m_expose_device_extensions);
@@ -1038,6 +1193,20 @@ namespace Anvil
             return m_device_extensions_ptr->khr_multiview;
         }
 
+        ValueType khr_pipeline_executable_properties() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->khr_pipeline_executable_properties;
+        }
+
+        ValueType khr_push_descriptor() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->khr_push_descriptor;
+        }
+
         ValueType khr_relaxed_block_layout() const final
         {
             anvil_assert(m_expose_device_extensions);
@@ -1108,6 +1277,13 @@ namespace Anvil
             return m_device_extensions_ptr->khr_swapchain_mutable_format;
         }
 
+        ValueType khr_timeline_semaphore() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->khr_timeline_semaphore;
+        }
+
         ValueType khr_variable_pointers() const final
         {
             anvil_assert(m_expose_device_extensions);
@@ -1122,6 +1298,20 @@ namespace Anvil
             return m_device_extensions_ptr->khr_vulkan_memory_model;
         }
 
+        ValueType nv_mesh_shader() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->nv_mesh_shader;
+        }
+
+        ValueType nv_shading_rate_image() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->nv_shading_rate_image;
+        }
+
         #if defined(_WIN32)
             ValueType khr_win32_keyed_mutex() const final
             {
@@ -0,0 +1,173 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/** Implements a copy-on-write associative container, which keeps its items sorted by key in a single contiguous
+ *  array.
+ *
+ *  Copying a FlatMap instance does not copy the items. Instead, the copies share the array until one of them
+ *  is modified, at which point the modified instance takes a private copy of the items. This makes it cheap to
+ *  spawn many slightly different copies of a large state block, and to iterate over the items afterward.
+ *
+ *  Lookups are O(log n). Insertions are O(n), which is preferable for the small item counts this container
+ *  is meant for.
+ *
+ *  Not thread-safe. Distinct instances sharing the same array may be used from different threads.
+ **/
+#ifndef MISC_FLAT_MAP_H
+#define MISC_FLAT_MAP_H
+
+#include "misc/types.h"
+#include <algorithm>
+
+namespace Anvil
+{
+    template <typename KeyType, typename ValueType>
+    class FlatMap
+    {
+    public:
+        /* Public type definitions */
+        typedef std::pair<KeyType, ValueType>                   Item;
+        typedef typename std::vector<Item>::const_iterator      const_iterator;
+
+        /* Public functions */
+
+        /** Returns an iterator pointing at the item with the smallest key. */
+        const_iterator begin() const
+        {
+            return get_items().cbegin();
+        }
+
+        /** Removes all items. Other instances sharing the item array are not affected. */
+        void clear()
+        {
+            m_items_ptr.reset();
+        }
+
+        /** Returns an iterator pointing past the item with the largest key. */
+        const_iterator end() const
+        {
+            return get_items().cend();
+        }
+
+        /** Returns an iterator pointing at the item with key @param in_key, or end() if no such item exists. */
+        const_iterator find(const KeyType& in_key) const
+        {
+            const auto& items         = get_items();
+            auto        item_iterator = std::lower_bound(items.cbegin(),
+                                                         items.cend  (),
+                                                         in_key,
+                                                         compare_item_key);
+
+            if (item_iterator         != items.cend() &&
+                item_iterator->first  != in_key)
+            {
+                item_iterator = items.cend();
+            }
+
+            return item_iterator;
+        }
+
+        /** Returns the value associated with key @param in_key. The item must exist. */
+        const ValueType& at(const KeyType& in_key) const
+        {
+            auto item_iterator = find(in_key);
+
+            anvil_assert(item_iterator != end() );
+
+            return item_iterator->second;
+        }
+
+        /** Reserves storage for @param in_n_items items. */
+        void reserve(uint32_t in_n_items)
+        {
+            get_private_items().reserve(in_n_items);
+        }
+
+        /** Returns the number of items stored. */
+        uint32_t size() const
+        {
+            return static_cast<uint32_t>(get_items().size() );
+        }
+
+        /** Returns a modifiable reference to the value associated with key @param in_key. If no such item exists,
+         *  a default-constructed value is inserted first.
+         *
+         *  Takes a private copy of the item array, if it is shared with other instances.
+         **/
+        ValueType& operator[](const KeyType& in_key)
+        {
+            auto& items         = get_private_items();
+            auto  item_iterator = std::lower_bound(items.begin(),
+                                                   items.end  (),
+                                                   in_key,
+                                                   compare_item_key);
+
+            if (item_iterator        == items.end() ||
+                item_iterator->first != in_key)
+            {
+                item_iterator = items.insert(item_iterator,
+                                             Item(in_key, ValueType() ));
+            }
+
+            return item_iterator->second;
+        }
+
+    private:
+        /* Private functions */
+        static bool compare_item_key(const Item&    in_item,
+                                     const KeyType& in_key)
+        {
+            return in_item.first < in_key;
+        }
+
+        const std::vector<Item>& get_items() const
+        {
+            static const std::vector<Item> empty_items;
+
+            return (m_items_ptr != nullptr) ? *m_items_ptr
+                                            : empty_items;
+        }
+
+        std::vector<Item>& get_private_items()
+        {
+            if (m_items_ptr == nullptr)
+            {
+                m_items_ptr.reset(
+                    new std::vector<Item>()
+                );
+            }
+            else
+            if (m_items_ptr.use_count() > 1)
+            {
+                m_items_ptr.reset(
+                    new std::vector<Item>(*m_items_ptr)
+                );
+            }
+
+            return *m_items_ptr;
+        }
+
+        /* Private variables */
+        std::shared_ptr<std::vector<Item> > m_items_ptr;
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_FLAT_MAP_H */
@@ -310,8 +310,15 @@ namespace Anvil
         /** Tells whether @param in_format format is a multiplanar format. */
         static bool is_format_multiplanar(Anvil::Format in_format);
 
-        /** Tells whether @param in_format is a KHR YUV format */
-        static bool is_format_yuv_khr(Anvil::Format in_format);
+        /** Tells whether @param in_format is a KHR YUV format.
+         *
+         *  YUV formats occupy a contiguous range of Anvil::Format values, so this can be evaluated at compile time.
+         */
+        static constexpr bool is_format_yuv_khr(Anvil::Format in_format)
+        {
+            return (static_cast<uint32_t>(in_format) - static_cast<uint32_t>(Anvil::Format::G8B8G8R8_422_UNORM) <=
+                    static_cast<uint32_t>(Anvil::Format::G16_B16_R16_3PLANE_444_UNORM) - static_cast<uint32_t>(Anvil::Format::G8B8G8R8_422_UNORM) );
+        }
 
         /** Tells whether @param in_format is a packed format.
          *
@@ -129,8 +129,75 @@ namespace Anvil
         }
     } float32_t;
 
+    /* Implementations the batch conversion routines can use. */
+    enum class FP16ConversionImplementation
+    {
+        /* Loops over fp16_to_fp32_full() and fp32_to_fp16_full_rtne(). Always available. */
+        SCALAR,
+
+        /* 4 values per iteration. Available on x86 CPUs with SSE2 support. */
+        SSE2,
+
+        /* 8 values per iteration using VCVTPH2PS/VCVTPS2PH. Available on x86 CPUs supporting F16C, with AVX state
+         * enabled by the OS. */
+        F16C,
+
+        /* 4 values per iteration. Available on AArch64 CPUs. */
+        NEON,
+    };
+
     namespace Utils
     {
+        /** Converts @param in_n_values FP16 values to FP32, using the fastest implementation supported by the running CPU.
+         *
+         *  All implementations return bit-identical results for non-NaN input. NaNs are converted to NaNs. Denormals are
+         *  preserved, unless the calling thread has enabled denormals-are-zero mode.
+         *
+         *  @param in_src_ptr     Array of @param in_n_values values to convert. Must not be null if @param in_n_values > 0.
+         *  @param in_n_values    Number of values to convert.
+         *  @param out_result_ptr Array of @param in_n_values items to store the results in. Must not be null if
+         *                        @param in_n_values > 0. Must not overlap with @param in_src_ptr.
+         **/
+        void convert_fp16_to_fp32_n(const float16_t* in_src_ptr,
+                                    uint32_t         in_n_values,
+                                    float32_t*       out_result_ptr);
+
+        /** Same as above, but uses the specified implementation. Useful for benchmarking & validation purposes.
+         *
+         *  @param in_implementation Implementation to use. Must be supported by the running CPU, as reported by
+         *                           is_fp16_conversion_implementation_supported().
+         **/
+        void convert_fp16_to_fp32_n(const float16_t*                    in_src_ptr,
+                                    uint32_t                            in_n_values,
+                                    const FP16ConversionImplementation& in_implementation,
+                                    float32_t*                          out_result_ptr);
+
+        /** Converts @param in_n_values FP32 values to FP16, using the fastest implementation supported by the running CPU.
+         *
+         *  Values are rounded to nearest even. Values too large to be represented are converted to infinity. All
+         *  implementations return bit-identical results for non-NaN input. NaNs are converted to quiet NaNs.
+         *
+         *  Please see convert_fp16_to_fp32_n() for more details.
+         **/
+        void convert_fp32_to_fp16_n(const float32_t* in_src_ptr,
+                                    uint32_t         in_n_values,
+                                    float16_t*       out_result_ptr);
+
+        /** Same as above, but uses the specified implementation. */
+        void convert_fp32_to_fp16_n(const float32_t*                    in_src_ptr,
+                                    uint32_t                            in_n_values,
+                                    const FP16ConversionImplementation& in_implementation,
+                                    float16_t*                          out_result_ptr);
+
+        /** Returns the implementation batch conversion routines use by default on the running CPU.
+         *
+         *  The CPU is only inspected the first time the function is called.
+         **/
+        FP16ConversionImplementation get_preferred_fp16_conversion_implementation();
+
+        /** Tells whether the specified batch conversion implementation can be used on the running CPU. */
+        bool is_fp16_conversion_implementation_supported(const FP16ConversionImplementation& in_implementation);
+
         float32_t fp16_to_fp32_fast      (float16_t in_h);
         float32_t fp16_to_fp32_fast2     (float16_t in_h);
         float32_t fp16_to_fp32_fast3     (float16_t in_h);
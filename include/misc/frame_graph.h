@@ -0,0 +1,581 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a frame graph, which derives synchronization of a frame's GPU work from the resource accesses
+ *  declared by its passes.
+ *
+ *  Apps register the resources used by the frame, and the passes which make up the frame, in execution order.
+ *  Each pass declares which resources it reads and writes, and which pipeline stages, access types and (for
+ *  images) layouts the accesses use. Each pass also provides a function, which records the pass' commands.
+ *
+ *  compile() then:
+ *
+ *  - creates transient resources. Transient resources whose lifetimes (range of passes accessing them) do not
+ *    overlap share memory (see MemoryAllocator::add_aliased_image() ). Transient resources which are not accessed
+ *    by any pass are not created.
+ *  - determines the barriers each pass needs. Barriers are only inserted for read-after-write, write-after-read
+ *    and write-after-write hazards and for layout transitions. Source and destination stage masks only include
+ *    the stages which access the resource, and all barriers needed by a pass are issued with a single
+ *    vkCmdPipelineBarrier() call.
+ *  - inserts queue family ownership transfers for exclusively owned resources accessed by passes which run on
+ *    different queue families.
+ *  - creates render passes and framebuffers for passes which declare attachments (raster passes). A raster pass
+ *    which reads, as an input attachment, an attachment written by the immediately preceding raster pass(es) is
+ *    merged with them into a single render pass, as a separate subpass. Dependencies between the merged passes
+ *    are expressed as BY_REGION subpass dependencies instead of pipeline barriers, and attachments which are not
+ *    used after the render pass are not stored. This lets tiling GPUs keep the intermediate data in tile memory,
+ *    instead of writing it out to and reading it back from device memory. Transient attachments used only within
+ *    a merged render pass should be created with TRANSIENT_ATTACHMENT usage, so that they can use lazily
+ *    allocated memory.
+ *
+ *  Consecutive passes which use the same queue family form a batch. compile() also determines which earlier
+ *  batches each batch depends on. Batches which do not depend on each other, eg. an async compute simulation and
+ *  a shadow map pass, can execute concurrently on different queues.
+ *
+ *  execute() records all batches and submits them to the first queue of each batch's queue family, waiting on
+ *  the batches each batch depends on with semaphores. Timeline semaphores are used if VK_KHR_timeline_semaphore
+ *  is enabled. Passes added with a queue family type, rather than an index, run on dedicated compute or
+ *  transfer queue families if the device exposes them.
+ *
+ *  Apps which submit on their own must record each batch into a separate command buffer with record_batch().
+ *  Batches must be submitted in order, and each batch's submission must wait (at ALL_COMMANDS stage) on
+ *  semaphores signalled by the submissions of the batches reported by get_batch_dependencies(). Waiting on the
+ *  previous batch's submission is also sufficient, but prevents batches from overlapping. Most frames only use
+ *  a single queue family, in which case record() can be used to record the whole frame into one command buffer.
+ *
+ *  Resources are tracked as a whole: all accesses to an image are assumed to touch all of its subresources.
+ *
+ *  Raster passes are recorded within the render pass created for them by compile(): their record functions must
+ *  not begin or end render passes, and must use pipelines compatible with the render pass and subpass reported
+ *  by get_render_pass(). Passes are only merged if all their attachments have the same size and layer count, and
+ *  if they do not access any of the render pass' attachments other than through attachments. Passes which cannot
+ *  be merged, and passes without attachments, execute as before.
+ *
+ *  The graph can be recorded any number of times after it has been compiled. Imported resources are expected to
+ *  be in the state passed at import time whenever the recorded commands start executing.
+ *
+ *  Frame graph is NOT thread-safe.
+ */
+#ifndef MISC_FRAME_GRAPH_H
+#define MISC_FRAME_GRAPH_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class FrameGraph
+    {
+    public:
+        /* Public type definitions */
+        typedef uint32_t PassID;
+        typedef uint32_t ResourceID;
+
+        /** Function which records commands of a pass.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the commands into.
+         *  @param in_pass_id        ID of the pass being recorded.
+         */
+        typedef std::function<void(Anvil::PrimaryCommandBuffer* in_cmd_buffer_ptr,
+                                   PassID                       in_pass_id)> PassRecordFunction;
+
+        /* Public functions */
+
+        /** Creates a new frame graph instance.
+         *
+         *  @param in_device_ptr Device to create the graph for. Must not be null.
+         *
+         *  @return New instance.
+         */
+        static Anvil::FrameGraphUniquePtr create(const Anvil::BaseDevice* in_device_ptr);
+
+        /** Destructor. The caller must make sure none of the transient resources is still accessed by the GPU. */
+        ~FrameGraph();
+
+        /** Declares that a pass reads a buffer.
+         *
+         *  @param in_pass_id     ID of the pass, as returned by add_pass().
+         *  @param in_resource_id ID of a buffer resource.
+         *  @param in_stages      Pipeline stages the buffer is read at.
+         *  @param in_access      Types of reads the pass performs.
+         */
+        void add_buffer_read(PassID                    in_pass_id,
+                             ResourceID                in_resource_id,
+                             Anvil::PipelineStageFlags in_stages,
+                             Anvil::AccessFlags        in_access);
+
+        /** Declares that a pass writes a buffer. Arguments are as per add_buffer_read(). @param in_access may
+         *  also include read access types, if the pass both reads and writes the buffer.
+         */
+        void add_buffer_write(PassID                    in_pass_id,
+                              ResourceID                in_resource_id,
+                              Anvil::PipelineStageFlags in_stages,
+                              Anvil::AccessFlags        in_access);
+
+        /** Declares that a pass renders to a color attachment. The pass becomes a raster pass.
+         *
+         *  @param in_pass_id             ID of the pass, as returned by add_pass().
+         *  @param in_resource_id         ID of a 2D image resource with COLOR_ATTACHMENT usage.
+         *  @param in_location            Fragment shader output location of the attachment.
+         *  @param in_load_op             Load operation to use if this is the first access of the image within
+         *                                the render pass.
+         *  @param in_opt_clear_value_ptr Clear value to use if @param in_load_op is CLEAR. May be null otherwise.
+         */
+        void add_color_attachment(PassID                  in_pass_id,
+                                  ResourceID              in_resource_id,
+                                  uint32_t                in_location,
+                                  Anvil::AttachmentLoadOp in_load_op,
+                                  const VkClearValue*     in_opt_clear_value_ptr = nullptr);
+
+        /** Declares that a pass uses a depth/stencil attachment. Stencil data, if any, uses the same load
+         *  operation as depth data. Arguments are as per add_color_attachment().
+         */
+        void add_depth_stencil_attachment(PassID                  in_pass_id,
+                                          ResourceID              in_resource_id,
+                                          Anvil::AttachmentLoadOp in_load_op,
+                                          const VkClearValue*     in_opt_clear_value_ptr = nullptr);
+
+        /** Declares that a pass reads an image.
+         *
+         *  @param in_pass_id     ID of the pass, as returned by add_pass().
+         *  @param in_resource_id ID of an image resource.
+         *  @param in_stages      Pipeline stages the image is read at.
+         *  @param in_access      Types of reads the pass performs.
+         *  @param in_layout      Layout the image must be in while the pass executes.
+         */
+        void add_image_read(PassID                    in_pass_id,
+                            ResourceID                in_resource_id,
+                            Anvil::PipelineStageFlags in_stages,
+                            Anvil::AccessFlags        in_access,
+                            Anvil::ImageLayout        in_layout);
+
+        /** Declares that a pass writes an image. Arguments are as per add_image_read(). @param in_access may
+         *  also include read access types, if the pass both reads and writes the image.
+         */
+        void add_image_write(PassID                    in_pass_id,
+                             ResourceID                in_resource_id,
+                             Anvil::PipelineStageFlags in_stages,
+                             Anvil::AccessFlags        in_access,
+                             Anvil::ImageLayout        in_layout);
+
+        /** Declares that a pass reads an image as an input attachment. The pass becomes a raster pass.
+         *
+         *  If the image has been rendered to by the preceding raster pass(es), the pass is merged with them
+         *  into a single render pass.
+         *
+         *  @param in_pass_id          ID of the pass, as returned by add_pass().
+         *  @param in_resource_id      ID of a 2D image resource with INPUT_ATTACHMENT usage.
+         *  @param in_attachment_index Input attachment index the fragment shader uses to access the image.
+         */
+        void add_input_attachment(PassID     in_pass_id,
+                                  ResourceID in_resource_id,
+                                  uint32_t   in_attachment_index);
+
+        /** Appends a new pass to the graph. Passes execute in the order they have been added in.
+         *
+         *  @param in_name               Name of the pass. Used to label the pass' commands if VK_EXT_debug_utils
+         *                               is enabled.
+         *  @param in_queue_family_index Index of the queue family the pass is going to be executed on.
+         *  @param in_record_function    Function recording the pass' commands. Must not be null.
+         *
+         *  @return ID of the new pass.
+         */
+        PassID add_pass(const std::string& in_name,
+                        uint32_t           in_queue_family_index,
+                        PassRecordFunction in_record_function);
+
+        /** Appends a new pass to the graph, which is going to be executed on a queue family of the specified type.
+         *
+         *  COMPUTE passes use a compute-only queue family, and TRANSFER passes a transfer-only queue family, if the
+         *  device exposes one. Otherwise, TRANSFER falls back to COMPUTE, and COMPUTE falls back to UNIVERSAL.
+         *
+         *  Other arguments are as per the other add_pass() overload.
+         */
+        PassID add_pass(const std::string&     in_name,
+                        Anvil::QueueFamilyType in_queue_family_type,
+                        PassRecordFunction     in_record_function);
+
+        /** Registers a transient buffer. The buffer is created and assigned memory at compile() time, and is
+         *  only valid within the frame. Its contents are undefined at the first pass which accesses it.
+         *
+         *  @param in_create_info_ptr Create info of the buffer. Must describe a non-sparse NO_ALLOC buffer.
+         *
+         *  @return ID of the new resource.
+         */
+        ResourceID add_transient_buffer(Anvil::BufferCreateInfoUniquePtr in_create_info_ptr);
+
+        /** Registers a transient image. The image is created and assigned memory at compile() time, and is
+         *  only valid within the frame. Its contents are undefined at the first pass which accesses it.
+         *
+         *  @param in_create_info_ptr Create info of the image. Must describe a non-sparse NO_ALLOC image.
+         *
+         *  @return ID of the new resource.
+         */
+        ResourceID add_transient_image(Anvil::ImageCreateInfoUniquePtr in_create_info_ptr);
+
+        /** Creates transient resources and determines the barriers needed by each pass. Must be called after
+         *  all resources and passes have been added, and before the graph is recorded.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool compile();
+
+        /** Records all batches of the compiled graph and submits them. Does not block.
+         *
+         *  Batches are recorded into command buffers owned by the graph, so the GPU must have finished executing the
+         *  previous execute() call's work before the graph is executed again (eg. wait on @param in_opt_fence_ptr).
+         *
+         *  @param in_n_wait_semaphores          Number of semaphores to wait on before any of the batches starts executing.
+         *  @param in_opt_wait_semaphore_ptrs    Binary semaphores to wait on. May be null if @param in_n_wait_semaphores is 0.
+         *  @param in_opt_wait_stage_masks_ptr   Stages at which the waits are performed, one per wait semaphore.
+         *  @param in_n_signal_semaphores        Number of semaphores to signal once all batches finish executing.
+         *  @param in_opt_signal_semaphore_ptrs  Binary semaphores to signal. May be null if @param in_n_signal_semaphores is 0.
+         *  @param in_opt_fence_ptr              If not null, the fence is signalled once all batches finish executing.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool execute(uint32_t                         in_n_wait_semaphores         = 0,
+                     Anvil::Semaphore* const*         in_opt_wait_semaphore_ptrs   = nullptr,
+                     const Anvil::PipelineStageFlags* in_opt_wait_stage_masks_ptr  = nullptr,
+                     uint32_t                         in_n_signal_semaphores       = 0,
+                     Anvil::Semaphore* const*         in_opt_signal_semaphore_ptrs = nullptr,
+                     Anvil::Fence*                    in_opt_fence_ptr             = nullptr);
+
+        /** Returns indices of the earlier batches the specified batch of the compiled graph must wait on. */
+        const std::vector<uint32_t>& get_batch_dependencies(uint32_t in_n_batch) const;
+
+        /** Returns the index of the queue family the specified batch of the compiled graph must be submitted to. */
+        uint32_t get_batch_queue_family_index(uint32_t in_n_batch) const;
+
+        /** Returns the buffer associated with a buffer resource. For transient resources, returns null until
+         *  the graph is compiled.
+         */
+        Anvil::Buffer* get_buffer(ResourceID in_resource_id) const;
+
+        /** Returns the image associated with an image resource. For transient resources, returns null until
+         *  the graph is compiled.
+         */
+        Anvil::Image* get_image(ResourceID in_resource_id) const;
+
+        /** Returns the number of batches the compiled graph consists of. */
+        uint32_t get_n_batches() const
+        {
+            return static_cast<uint32_t>(m_batches.size() );
+        }
+
+        /** Returns the render pass a raster pass of the compiled graph is recorded within. The render pass is
+         *  owned by the graph. Pipelines used by the pass must be compatible with it.
+         *
+         *  @param in_pass_id             ID of the pass.
+         *  @param out_opt_subpass_id_ptr If not null, deref will be set to ID of the subpass the pass executes as.
+         *
+         *  @return Render pass, or null if the pass does not declare any attachments.
+         */
+        Anvil::RenderPass* get_render_pass(PassID           in_pass_id,
+                                           Anvil::SubPassID* out_opt_subpass_id_ptr = nullptr) const;
+
+        /** Registers a buffer created and bound to memory by the app.
+         *
+         *  @param in_buffer_ptr          Buffer to register. Must not be null.
+         *  @param in_src_stages          Pipeline stages which access the buffer before the frame, and which the
+         *                                frame's first access must wait on. May be NONE if the buffer is
+         *                                synchronized some other way, e.g. with a semaphore.
+         *  @param in_src_access          Writes which need to be made available before the frame's first access.
+         *  @param in_queue_family_index  Index of the queue family owning the buffer before the frame. Ignored
+         *                                for buffers using concurrent sharing mode.
+         *
+         *  @return ID of the new resource.
+         */
+        ResourceID import_buffer(Anvil::Buffer*            in_buffer_ptr,
+                                 Anvil::PipelineStageFlags in_src_stages         = Anvil::PipelineStageFlagBits::NONE,
+                                 Anvil::AccessFlags        in_src_access         = Anvil::AccessFlagBits::NONE,
+                                 uint32_t                  in_queue_family_index = VK_QUEUE_FAMILY_IGNORED);
+
+        /** Registers an image created and bound to memory by the app, e.g. a swapchain image.
+         *
+         *  @param in_image_ptr          Image to register. Must not be null.
+         *  @param in_layout             Layout the image is in before the frame.
+         *  @param in_final_layout       Layout to transition the image to after its last access. If UNDEFINED,
+         *                               the image is left in the layout used by its last access.
+         *  @param in_src_stages         As per import_buffer().
+         *  @param in_src_access         As per import_buffer().
+         *  @param in_queue_family_index As per import_buffer().
+         *
+         *  @return ID of the new resource.
+         */
+        ResourceID import_image(Anvil::Image*             in_image_ptr,
+                                Anvil::ImageLayout        in_layout,
+                                Anvil::ImageLayout        in_final_layout       = Anvil::ImageLayout::UNDEFINED,
+                                Anvil::PipelineStageFlags in_src_stages         = Anvil::PipelineStageFlagBits::NONE,
+                                Anvil::AccessFlags        in_src_access         = Anvil::AccessFlagBits::NONE,
+                                uint32_t                  in_queue_family_index = VK_QUEUE_FAMILY_IGNORED);
+
+        /** Records the whole compiled graph into a command buffer. Can only be used if the graph consists of
+         *  a single batch. The command buffer must be in the recording state.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record(Anvil::PrimaryCommandBuffer* in_cmd_buffer_ptr);
+
+        /** Records a single batch of the compiled graph into a command buffer. The command buffer must be in
+         *  the recording state, and must be submitted to a queue of the batch's queue family.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_batch(uint32_t                     in_n_batch,
+                          Anvil::PrimaryCommandBuffer* in_cmd_buffer_ptr);
+
+    private:
+        /* Private type definitions */
+        typedef struct Access
+        {
+            Anvil::AccessFlags        access;
+            bool                      is_write;
+            Anvil::ImageLayout        layout;
+            ResourceID                resource_id;
+            Anvil::PipelineStageFlags stages;
+
+            Access(ResourceID                in_resource_id,
+                   Anvil::PipelineStageFlags in_stages,
+                   Anvil::AccessFlags        in_access,
+                   Anvil::ImageLayout        in_layout,
+                   bool                      in_is_write)
+                :access     (in_access),
+                 is_write   (in_is_write),
+                 layout     (in_layout),
+                 resource_id(in_resource_id),
+                 stages     (in_stages)
+            {
+                /* Stub */
+            }
+        } Access;
+
+        /* Attachment used by a raster pass */
+        typedef struct Attachment
+        {
+            VkClearValue            clear_value;
+            uint32_t                index;       /* Location for color attachments, input attachment index for input attachments */
+            Anvil::ImageLayout      layout;
+            Anvil::AttachmentLoadOp load_op;
+            ResourceID              resource_id;
+            Anvil::AttachmentType   type;
+        } Attachment;
+
+        /* Barriers recorded with a single vkCmdPipelineBarrier() call */
+        typedef struct BarrierSet
+        {
+            std::vector<Anvil::BufferBarrier> buffer_barriers;
+            Anvil::PipelineStageFlags         dst_stages;
+            std::vector<Anvil::ImageBarrier>  image_barriers;
+            Anvil::PipelineStageFlags         src_stages;
+
+            bool is_empty() const
+            {
+                return (buffer_barriers.size() == 0 &&
+                        image_barriers.size () == 0);
+            }
+        } BarrierSet;
+
+        typedef struct Batch
+        {
+            Anvil::PrimaryCommandBufferUniquePtr cmd_buffer_ptr;      /* Used by execute() */
+            std::vector<uint32_t>                dependencies;        /* Earlier batches the batch must wait on */
+            uint32_t                             n_first_pass;
+            uint32_t                             n_passes;
+            uint32_t                             queue_family_index;
+            BarrierSet                           release_barriers;    /* Recorded after the batch's last pass */
+
+            /* Semaphores used by execute(). In timeline mode, signal_semaphore_ptrs holds the batch's own timeline semaphore,
+             * which dependent batches wait on. In binary mode, there is one semaphore per dependency, plus one for the wait on
+             * the app's semaphores (root batches only) and one for the final signal (batches with no dependents only). */
+            Anvil::Semaphore*                    entry_semaphore_ptr;
+            Anvil::Semaphore*                    exit_semaphore_ptr;
+            std::vector<Anvil::Semaphore*>       signal_semaphore_ptrs;
+            std::vector<Anvil::Semaphore*>       wait_semaphore_ptrs;
+
+            Batch()
+                :cmd_buffer_ptr     (nullptr,
+                                     std::default_delete<Anvil::PrimaryCommandBuffer>() ),
+                 entry_semaphore_ptr(nullptr),
+                 exit_semaphore_ptr (nullptr),
+                 n_first_pass       (0),
+                 n_passes           (0),
+                 queue_family_index (VK_QUEUE_FAMILY_IGNORED)
+            {
+                /* Stub */
+            }
+        } Batch;
+
+        typedef struct Pass
+        {
+            std::vector<Access> accesses;
+            std::vector<Attachment> attachments;
+            BarrierSet              barriers;      /* Recorded before the pass */
+            uint32_t                n_batch;
+            uint32_t                n_render_pass; /* UINT32_MAX if the pass does not declare any attachments */
+            std::string             name;
+            uint32_t                queue_family_index;
+            PassRecordFunction      record_function;
+            Anvil::SubPassID        subpass_id;
+        } Pass;
+
+        /* Dependency between two subpasses of a render pass. Subpasses are identified by their passes' indices. */
+        typedef struct SubpassDependency
+        {
+            Anvil::AccessFlags        dst_access;
+            Anvil::PipelineStageFlags dst_stages;
+            uint32_t                  n_dst_pass;
+            uint32_t                  n_src_pass;
+            Anvil::AccessFlags        src_access;
+            Anvil::PipelineStageFlags src_stages;
+        } SubpassDependency;
+
+        /* Consecutive raster passes executed as subpasses of a single render pass */
+        typedef struct RenderPassInstance
+        {
+            std::vector<ResourceID>                attachment_resource_ids; /* In render pass attachment order */
+            std::vector<VkClearValue>              clear_values;            /* One per attachment */
+            std::vector<SubpassDependency>         dependencies;
+            std::vector<Anvil::ImageViewUniquePtr> image_view_ptrs;         /* One per attachment */
+            Anvil::FramebufferUniquePtr            framebuffer_ptr;
+            uint32_t                               n_first_pass;
+            uint32_t                               n_passes;
+            VkRect2D                               render_area;
+            Anvil::RenderPassUniquePtr             render_pass_ptr;
+
+            RenderPassInstance()
+                :n_first_pass(0),
+                 n_passes    (0)
+            {
+                /* Stub */
+            }
+        } RenderPassInstance;
+
+        typedef struct Resource
+        {
+            Anvil::Buffer*                   buffer_ptr;
+            Anvil::BufferCreateInfoUniquePtr buffer_create_info_ptr;
+            Anvil::ImageLayout               final_layout;
+            Anvil::Image*                    image_ptr;
+            Anvil::ImageCreateInfoUniquePtr  image_create_info_ptr;
+            Anvil::ImageLayout               initial_layout;
+            uint32_t                         initial_queue_family_index;
+            Anvil::AccessFlags               initial_src_access;
+            Anvil::PipelineStageFlags        initial_src_stages;
+            bool                             is_transient;
+            uint32_t                         n_first_pass; /* UINT32_MAX if not accessed by any pass */
+            uint32_t                         n_last_pass;
+            Anvil::BufferUniquePtr           transient_buffer_ptr;
+            Anvil::ImageUniquePtr            transient_image_ptr;
+
+            Resource()
+                :buffer_ptr                (nullptr),
+                 final_layout              (Anvil::ImageLayout::UNDEFINED),
+                 image_ptr                 (nullptr),
+                 initial_layout            (Anvil::ImageLayout::UNDEFINED),
+                 initial_queue_family_index(VK_QUEUE_FAMILY_IGNORED),
+                 is_transient              (false),
+                 n_first_pass              (UINT32_MAX),
+                 n_last_pass               (UINT32_MAX)
+            {
+                /* Stub */
+            }
+        } Resource;
+
+        /* State of a resource, as seen by the pass being processed by compile() */
+        typedef struct ResourceState
+        {
+            Anvil::ImageLayout        layout;
+            uint32_t                  n_batch;         /* UINT32_MAX if not accessed by the frame yet */
+            uint32_t                  n_write_batch;   /* Batch of the last write, layout transition or ownership transfer.
+                                                        * UINT32_MAX if there has been none in the frame yet. */
+            uint32_t                  queue_family_index;
+            std::vector<uint32_t>     read_batches;    /* Batches which read the resource since the last write          */
+            Anvil::PipelineStageFlags read_stages;     /* Stages which read the resource since the last write       */
+            Anvil::AccessFlags        visible_access;  /* Access types the last write has been made visible to      */
+            Anvil::PipelineStageFlags visible_stages;  /* Stages the last write has been made visible to            */
+            Anvil::AccessFlags        write_access;
+            Anvil::PipelineStageFlags write_stages;
+        } ResourceState;
+
+        /* Private functions */
+        FrameGraph(const Anvil::BaseDevice* in_device_ptr);
+
+        void add_access              (PassID                       in_pass_id,
+                                      const Access&                in_access);
+        void add_attachment          (PassID                       in_pass_id,
+                                      const Attachment&            in_attachment,
+                                      Anvil::PipelineStageFlags    in_stages,
+                                      Anvil::AccessFlags           in_access,
+                                      bool                         in_is_write);
+        void add_batch_dependencies  (uint32_t                     in_n_batch,
+                                      const ResourceState&         in_state,
+                                      bool                         in_include_readers);
+        void add_barrier             (BarrierSet*                  in_barrier_set_ptr,
+                                      ResourceID                   in_resource_id,
+                                      Anvil::PipelineStageFlags    in_src_stages,
+                                      Anvil::AccessFlags           in_src_access,
+                                      Anvil::PipelineStageFlags    in_dst_stages,
+                                      Anvil::AccessFlags           in_dst_access,
+                                      Anvil::ImageLayout           in_old_layout,
+                                      Anvil::ImageLayout           in_new_layout,
+                                      uint32_t                     in_src_queue_family_index,
+                                      uint32_t                     in_dst_queue_family_index);
+        bool can_merge_pass          (const RenderPassInstance&    in_render_pass,
+                                      uint32_t                     in_n_pass) const;
+        bool create_execution_objects();
+        bool create_render_passes    ();
+        bool create_transient_resources();
+        bool do_resources_alias      (ResourceID                   in_resource_a_id,
+                                      ResourceID                   in_resource_b_id);
+        void group_render_passes     ();
+        bool is_resource_accessed    (ResourceID                   in_resource_id,
+                                      uint32_t                     in_n_first_pass,
+                                      uint32_t                     in_n_passes) const;
+        bool is_resource_exclusive   (ResourceID                   in_resource_id) const;
+        void record_barriers         (const BarrierSet&            in_barrier_set,
+                                      Anvil::PrimaryCommandBuffer* in_cmd_buffer_ptr) const;
+
+        const Attachment*             get_attachment       (uint32_t   in_n_pass,
+                                                            ResourceID in_resource_id) const;
+        const Anvil::ImageCreateInfo* get_image_create_info(ResourceID in_resource_id) const;
+
+        /* Private variables */
+        std::vector<Batch>                              m_batches;
+        std::map<uint32_t, Anvil::CommandPoolUniquePtr> m_command_pools;
+        const Anvil::BaseDevice*                        m_device_ptr;
+        Anvil::SemaphoreUniquePtr                       m_entry_timeline_semaphore_ptr;
+        bool                                            m_is_compiled;
+        Anvil::MemoryAllocatorUniquePtr                 m_memory_allocator_ptr;
+        uint64_t                                        m_n_executions;
+        std::vector<Pass>                               m_passes;
+        std::vector<RenderPassInstance>                 m_render_passes;
+        std::vector<Resource>                           m_resources;
+        std::vector<Anvil::SemaphoreUniquePtr>          m_semaphores;
+        bool                                            m_uses_timeline_semaphores;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(FrameGraph);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(FrameGraph);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_FRAME_GRAPH_H */
@@ -0,0 +1,261 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements opt-in frame pacing & latency instrumentation for a single swapchain.
+ *
+ *  Once attached to a swapchain with Swapchain::set_frame_timing_recorder() and to the queue(s) the app
+ *  submits frame work to with Queue::set_frame_timing_recorder(), the recorder captures host timestamps of:
+ *
+ *  - each image acquisition (both when the acquire call was made, and when it returned),
+ *  - the first and the last submission issued between two consecutive presents,
+ *  - each present request (both when it was made, and when vkQueuePresentKHR() returned).
+ *
+ *  Optionally, GPU timestamps can be written into the app's command buffers with record_gpu_frame_start()
+ *  and record_gpu_frame_end(). If the swapchain's device has VK_GOOGLE_display_timing enabled, present
+ *  requests are also tagged with a present ID, so that the actual display time reported by the presentation
+ *  engine can be attached to the frame.
+ *
+ *  Completed frames are stored in a bounded, lock-free single-producer/single-consumer ring, which the app
+ *  drains by calling drain(). If the app does not drain the ring quickly enough, new frames are dropped
+ *  and accounted for by get_n_dropped_frames().
+ *
+ *  Host timestamps are expressed in nanoseconds, relative to the time the recorder was created. GPU and
+ *  display timestamps are expressed in nanoseconds in the device's and the presentation engine's time
+ *  domains respectively.
+ *
+ *  Acquire & present calls for the swapchain must not be made from more than one thread at a time. Submissions
+ *  and drain() calls may come from any thread, but drain() must not be called concurrently with itself.
+ */
+#ifndef MISC_FRAME_TIMING_RECORDER_H
+#define MISC_FRAME_TIMING_RECORDER_H
+
+#include "misc/time.h"
+#include "misc/types.h"
+#include <atomic>
+
+
+namespace Anvil
+{
+    class FrameTimingRecorder
+    {
+    public:
+        /* Public type definitions */
+        typedef struct FrameTimings
+        {
+            uint64_t                           frame_id;
+            uint32_t                           swapchain_image_index;
+
+            /* Host timestamps. 0 if the corresponding event has not been recorded for the frame. */
+            uint64_t                           acquire_end_time;
+            uint64_t                           acquire_start_time;
+            uint64_t                           first_submit_time;
+            uint64_t                           last_submit_time;
+            uint32_t                           n_submissions;
+            uint64_t                           present_end_time;
+            uint64_t                           present_start_time;
+            Anvil::SwapchainOperationErrorCode present_result;
+
+            /* GPU timestamps. Only valid if has_gpu_times is true. */
+            bool                               has_gpu_times;
+            uint64_t                           gpu_end_time;
+            uint64_t                           gpu_start_time;
+
+            /* VK_GOOGLE_display_timing data. Only valid if has_display_times is true. */
+            bool                               has_display_times;
+            uint64_t                           actual_present_time;
+            uint64_t                           earliest_present_time;
+            uint64_t                           present_margin;
+
+            FrameTimings()
+                :frame_id             (0),
+                 swapchain_image_index(UINT32_MAX),
+                 acquire_end_time     (0),
+                 acquire_start_time   (0),
+                 first_submit_time    (0),
+                 last_submit_time     (0),
+                 n_submissions        (0),
+                 present_end_time     (0),
+                 present_start_time   (0),
+                 present_result       (Anvil::SwapchainOperationErrorCode::SUCCESS),
+                 has_gpu_times        (false),
+                 gpu_end_time         (0),
+                 gpu_start_time       (0),
+                 has_display_times    (false),
+                 actual_present_time  (0),
+                 earliest_present_time(0),
+                 present_margin       (0)
+            {
+                /* Stub */
+            }
+        } FrameTimings;
+
+        /* Public functions */
+
+        /** Creates a new frame timing recorder instance.
+         *
+         *  @param in_swapchain_ptr         Swapchain to record frame timings for. Must not be null.
+         *  @param in_n_ring_slots          Maximum number of frames which can be held by the recorder until they
+         *                                  are drained. Must be a power of two, not smaller than 4.
+         *  @param in_enable_gpu_timestamps True if record_gpu_frame_start() and record_gpu_frame_end() are going
+         *                                  to be used. GPU timestamps are silently disabled if the device does
+         *                                  not support timestamp queries on graphics & compute queues.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::FrameTimingRecorderUniquePtr create(Anvil::Swapchain* in_swapchain_ptr,
+                                                          uint32_t          in_n_ring_slots          = 64,
+                                                          bool              in_enable_gpu_timestamps = true);
+
+        /** Destructor. */
+        ~FrameTimingRecorder();
+
+        /** Moves completed frames out of the recorder, oldest first.
+         *
+         *  A presented frame is held back until its GPU timestamps and display timing data become available,
+         *  unless more than half of the ring's slots are occupied by younger frames, in which case the frame is
+         *  returned without that data.
+         *
+         *  @param in_n_max_frames Maximum number of frames to return.
+         *  @param out_frames_ptr  Deref will be filled with up to @param in_n_max_frames items. Must not
+         *                         be null if @param in_n_max_frames is not 0.
+         *
+         *  @return Number of frames stored under @param out_frames_ptr.
+         */
+        uint32_t drain(uint32_t      in_n_max_frames,
+                       FrameTimings* out_frames_ptr);
+
+        /** Returns the number of frames which have been discarded because the ring was full. */
+        uint64_t get_n_dropped_frames() const
+        {
+            return m_n_dropped_frames.load();
+        }
+
+        /** Retrieves the duration of the display's refresh cycle.
+         *
+         *  Requires VK_GOOGLE_display_timing.
+         *
+         *  @param out_duration_ptr Deref will be set to the duration, expressed in nanoseconds. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool get_refresh_cycle_duration(uint64_t* out_duration_ptr) const;
+
+        /** Returns the swapchain the recorder has been created for. */
+        Anvil::Swapchain* get_swapchain() const
+        {
+            return m_swapchain_ptr;
+        }
+
+        /** Tells whether present requests are tagged with VK_GOOGLE_display_timing present IDs. */
+        bool is_display_timing_enabled() const
+        {
+            return m_is_display_timing_enabled;
+        }
+
+        /** Tells whether GPU timestamps can be recorded. */
+        bool is_gpu_timestamp_recording_enabled() const
+        {
+            return (m_query_pool_ptr != nullptr);
+        }
+
+        /** Records commands which reset the current frame's timestamp queries and write the frame's GPU start
+         *  timestamp into @param in_cmd_buffer_ptr.
+         *
+         *  Must be recorded outside a render pass. The command buffer must be submitted before the frame is
+         *  presented, and must be re-recorded for every frame.
+         *
+         *  @return true if the commands have been recorded, false if GPU timestamps are disabled or the ring
+         *          is full.
+         */
+        bool record_gpu_frame_start(Anvil::CommandBufferBase* in_cmd_buffer_ptr);
+
+        /** Records a command which writes the current frame's GPU end timestamp into @param in_cmd_buffer_ptr.
+         *
+         *  Requires a preceding record_gpu_frame_start() call for the same frame. The same requirements apply.
+         *
+         *  @return true if the command has been recorded, false otherwise.
+         */
+        bool record_gpu_frame_end(Anvil::CommandBufferBase* in_cmd_buffer_ptr);
+
+    private:
+        /* Private type definitions */
+        typedef struct Slot
+        {
+            FrameTimings timings;
+
+            /* Only accessed by the consumer */
+            bool         is_display_time_pending;
+            bool         is_gpu_time_pending;
+        } Slot;
+
+        /* Private functions */
+        FrameTimingRecorder(Anvil::Swapchain* in_swapchain_ptr,
+                            uint32_t          in_n_ring_slots);
+
+        bool     init                         (bool                               in_enable_gpu_timestamps);
+        void     on_image_acquired            (uint64_t                           in_acquire_start_time,
+                                               uint32_t                           in_swapchain_image_index);
+        void     on_present_finished          (Anvil::SwapchainOperationErrorCode in_present_result);
+        uint32_t on_present_started           ();
+        void     on_submission_issued         ();
+        void     update_past_presentation_info();
+
+        uint64_t get_time()
+        {
+            return m_time.get_time_in_nsec();
+        }
+
+        /* Private variables */
+        std::vector<Slot>                           m_ring;
+        const uint64_t                              m_ring_mask;
+        std::atomic<uint64_t>                       m_read_pos;
+        std::atomic<uint64_t>                       m_write_pos;
+
+        /* Data of the frame in progress */
+        std::atomic<uint64_t>                       m_current_acquire_end_time;
+        std::atomic<uint64_t>                       m_current_acquire_start_time;
+        std::atomic<uint64_t>                       m_current_first_submit_time;
+        std::atomic<uint64_t>                       m_current_gpu_end_write_pos;   /* write pos + 1 of the frame whose GPU end timestamp has been recorded */
+        std::atomic<uint64_t>                       m_current_gpu_start_write_pos; /* write pos + 1 of the frame whose GPU start timestamp has been recorded */
+        std::atomic<uint64_t>                       m_current_last_submit_time;
+        std::atomic<uint32_t>                       m_current_n_submissions;
+        std::atomic<uint32_t>                       m_current_swapchain_image_index;
+        FrameTimings                                m_current_present_timings;    /* Only accessed by the presenting thread */
+
+        bool                                        m_is_display_timing_enabled;
+        std::atomic<uint64_t>                       m_n_dropped_frames;
+        uint64_t                                    m_next_frame_id;
+        std::vector<VkPastPresentationTimingGOOGLE> m_past_presentation_timings;  /* Only accessed by the consumer */
+        Anvil::QueryPoolUniquePtr                   m_query_pool_ptr;
+        Anvil::Swapchain*                           m_swapchain_ptr;
+        double                                      m_timestamp_period;
+        Anvil::Time                                 m_time;
+
+        friend class Anvil::Queue;
+        friend class Anvil::Swapchain;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(FrameTimingRecorder);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(FrameTimingRecorder);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_FRAME_TIMING_RECORDER_H */
@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a device-wide cache of framebuffers.
+ *
+ *  Apps which render to many attachment combinations (eg. one per swapchain image, per shadow cascade or per
+ *  post-processing pass) tend to either re-create framebuffers every frame, or to manage a framebuffer per
+ *  combination by hand. get_framebuffer() instead returns an existing framebuffer if one has already been
+ *  created for the same attachment views, size and render pass compatibility class.
+ *
+ *  Render passes are considered to be of the same compatibility class if they define the same number of
+ *  attachments, and the attachments at corresponding indices use matching formats and sample counts. Framebuffers
+ *  returned for such render passes are shared. Note that the framebuffer wrapper still bakes a separate Vulkan
+ *  framebuffer object for each render pass it is used with.
+ *
+ *  Cached framebuffers are owned by the cache. Apps must call release_framebuffers_using() for image views
+ *  which are about to be released (eg. when a swapchain is re-created), or clear() to drop all framebuffers.
+ *  It is the app's responsibility to make sure the GPU no longer uses the released framebuffers at that point.
+ *
+ *  This object should ONLY be instantiated by Anvil::BaseDevice.
+ *
+ *  Framebuffer cache is thread-safe.
+ */
+#ifndef MISC_FRAMEBUFFER_CACHE_H
+#define MISC_FRAMEBUFFER_CACHE_H
+
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+#include <unordered_map>
+
+
+namespace Anvil
+{
+    class FramebufferCache : public MTSafetySupportProvider
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new framebuffer cache instance.
+         *
+         *  @param in_device_ptr Device to create the cache for. Must not be null.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::FramebufferCacheUniquePtr create(const Anvil::BaseDevice* in_device_ptr);
+
+        /** Destructor. Releases all cached framebuffers. */
+        ~FramebufferCache();
+
+        /** Releases all cached framebuffers. */
+        void clear();
+
+        /** Returns a framebuffer which uses @param in_attachment_ptrs as attachments and which can be used with
+         *  @param in_render_pass_ptr, and any other render pass of the same compatibility class. If no such
+         *  framebuffer exists, a new one is created.
+         *
+         *  @param in_render_pass_ptr  Render pass the framebuffer is going to be used with. Must not be null.
+         *  @param in_n_attachments    Number of image views under @param in_attachment_ptrs. Must match the number
+         *                             of attachments defined by the render pass.
+         *  @param in_attachment_ptrs  Image views to use as attachments. Must not be null if @param in_n_attachments
+         *                             is not zero.
+         *  @param in_width            Framebuffer width.
+         *  @param in_height           Framebuffer height.
+         *  @param in_n_layers         Number of framebuffer layers.
+         *
+         *  @return Framebuffer if successful, null otherwise. Do NOT release the returned object.
+         */
+        Anvil::Framebuffer* get_framebuffer(const Anvil::RenderPass* in_render_pass_ptr,
+                                            uint32_t                 in_n_attachments,
+                                            Anvil::ImageView* const* in_attachment_ptrs,
+                                            uint32_t                 in_width,
+                                            uint32_t                 in_height,
+                                            uint32_t                 in_n_layers);
+
+        /** Returns the number of get_framebuffer() calls which have been served with an existing framebuffer. */
+        uint32_t get_n_cache_hits() const
+        {
+            return m_n_cache_hits;
+        }
+
+        /** Returns the number of get_framebuffer() calls which required a new framebuffer to be created. */
+        uint32_t get_n_cache_misses() const
+        {
+            return m_n_cache_misses;
+        }
+
+        /** Returns the number of framebuffers held by the cache. */
+        uint32_t get_n_cached_framebuffers() const;
+
+        /** Releases all cached framebuffers which use @param in_image_view_ptr as one of their attachments.
+         *
+         *  @return Number of framebuffers released.
+         */
+        uint32_t release_framebuffers_using(const Anvil::ImageView* in_image_view_ptr);
+
+    private:
+        /* Private type definitions */
+        typedef struct AttachmentSignature
+        {
+            Anvil::Format              format;
+            Anvil::SampleCountFlagBits sample_count;
+
+            bool operator==(const AttachmentSignature& in_signature) const
+            {
+                return (format       == in_signature.format       &&
+                        sample_count == in_signature.sample_count);
+            }
+        } AttachmentSignature;
+
+        typedef struct Entry
+        {
+            std::vector<Anvil::ImageView*>   attachment_ptrs;
+            Anvil::FramebufferUniquePtr      framebuffer_ptr;
+            uint32_t                         height;
+            uint32_t                         n_layers;
+            std::vector<AttachmentSignature> render_pass_signature;
+            uint32_t                         width;
+
+            Entry();
+        } Entry;
+
+        typedef std::unique_ptr<Entry> EntryUniquePtr;
+
+        /* Private functions */
+        FramebufferCache(const Anvil::BaseDevice* in_device_ptr);
+
+        bool get_render_pass_signature(const Anvil::RenderPass*          in_render_pass_ptr,
+                                       std::vector<AttachmentSignature>* out_signature_ptr) const;
+
+        /* Private variables */
+        const Anvil::BaseDevice*                                     m_device_ptr;
+        std::unordered_map<uint64_t, std::vector<EntryUniquePtr> >   m_entries;
+        std::atomic<uint32_t>                                        m_n_cache_hits;
+        std::atomic<uint32_t>                                        m_n_cache_misses;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(FramebufferCache);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(FramebufferCache);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_FRAMEBUFFER_CACHE_H */
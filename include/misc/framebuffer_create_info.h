@@ -46,6 +46,34 @@ namespace Anvil
         bool add_attachment(ImageView*               in_image_view_ptr,
                             FramebufferAttachmentID*  out_opt_attachment_id_ptr);
 
+        /** Adds an imageless attachment to the framebuffer. Requires VK_KHR_imageless_framebuffer.
+         *
+         *  Imageless attachments only describe the images which are going to be attached at render pass begin time.
+         *  Actual image views are passed to PrimaryCommandBuffer::record_begin_render_pass*() calls, so a single
+         *  framebuffer can be used with any set of image views matching the description.
+         *
+         *  Imageless attachments cannot be mixed with attachments added with add_attachment().
+         *
+         *  @param in_image_create_flags Create flags of the images whose views are going to be used for the attachment.
+         *  @param in_image_usage_flags  Usage flags of the images whose views are going to be used for the attachment.
+         *  @param in_width              Width of the image views which are going to be used for the attachment.
+         *  @param in_height             Height of the image views which are going to be used for the attachment.
+         *  @param in_n_layers           Number of layers of the image views which are going to be used for the attachment.
+         *  @param in_n_view_formats     Number of formats under @param in_view_formats_ptr. Must be at least 1.
+         *  @param in_view_formats_ptr   Formats image views used for the attachment can take. Must not be null.
+         *  @param out_opt_attachment_id_ptr If not null, deref will be set to the new attachment's ID.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool add_imageless_attachment(const Anvil::ImageCreateFlags& in_image_create_flags,
+                                      const Anvil::ImageUsageFlags&  in_image_usage_flags,
+                                      const uint32_t&                in_width,
+                                      const uint32_t&                in_height,
+                                      const uint32_t&                in_n_layers,
+                                      const uint32_t&                in_n_view_formats,
+                                      const Anvil::Format*           in_view_formats_ptr,
+                                      FramebufferAttachmentID*       out_opt_attachment_id_ptr);
+
         /* Returns an attachment at user-specified index */
         bool get_attachment_at_index(uint32_t    in_attachment_index,
                                      ImageView** out_image_view_ptr_ptr) const;
@@ -74,6 +102,18 @@ namespace Anvil
             return m_height;
         }
 
+        /** Retrieves properties of an imageless attachment at user-specified index.
+         *
+         *  @return true if successful (eg. the attachment exists and is imageless), false otherwise.
+         **/
+        bool get_imageless_attachment_properties(uint32_t                          in_attachment_index,
+                                                 Anvil::ImageCreateFlags*          out_opt_image_create_flags_ptr,
+                                                 Anvil::ImageUsageFlags*           out_opt_image_usage_flags_ptr,
+                                                 uint32_t*                         out_opt_width_ptr,
+                                                 uint32_t*                         out_opt_height_ptr,
+                                                 uint32_t*                         out_opt_n_layers_ptr,
+                                                 const std::vector<Anvil::Format>** out_opt_view_formats_ptr_ptr) const;
+
         Anvil::MTSafety get_mt_safety() const
         {
             return m_mt_safety;
@@ -100,6 +140,12 @@ namespace Anvil
             return m_width;
         }
 
+        /** Tells whether the framebuffer has been defined with imageless attachments. */
+        bool is_imageless() const
+        {
+            return m_is_imageless;
+        }
+
         void set_device(const Anvil::BaseDevice* in_device_ptr)
         {
             m_device_ptr = in_device_ptr;
@@ -132,6 +178,14 @@ namespace Anvil
         {
             ImageView* image_view_ptr;
 
+            /* Imageless attachments only: */
+            Anvil::ImageCreateFlags    image_create_flags;
+            Anvil::ImageUsageFlags     image_usage_flags;
+            uint32_t                   height;
+            uint32_t                   n_layers;
+            std::vector<Anvil::Format> view_formats;
+            uint32_t                   width;
+
             /** Constructor. Retains the input image view instance.
              *
              *  @param in_image_view_ptr Image view instance to use for the FB attachment. Must not
@@ -139,6 +193,15 @@ namespace Anvil
              **/
              FramebufferAttachment(ImageView* in_image_view_ptr);
 
+             /** Constructor for imageless attachments. Please see add_imageless_attachment() for more details. */
+             FramebufferAttachment(const Anvil::ImageCreateFlags& in_image_create_flags,
+                                   const Anvil::ImageUsageFlags&  in_image_usage_flags,
+                                   const uint32_t&                in_width,
+                                   const uint32_t&                in_height,
+                                   const uint32_t&                in_n_layers,
+                                   const uint32_t&                in_n_view_formats,
+                                   const Anvil::Format*           in_view_formats_ptr);
+
              /** Destructor. Releases the encapsulated image view instance. */
              ~FramebufferAttachment();
 
@@ -172,6 +235,7 @@ namespace Anvil
 
         const Anvil::BaseDevice* m_device_ptr;
         uint32_t                 m_height;
+        bool                     m_is_imageless;
         MTSafety                 m_mt_safety;
         uint32_t                 m_n_layers;
         uint32_t                 m_width;
@@ -0,0 +1,132 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements an in-memory store of GLSL headers, which GLSLShaderToSPIRVGenerator instances resolve #include
+ *  directives against.
+ *
+ *  Headers can either be registered explicitly with add_header(), or loaded from disk. Files are looked up in
+ *  the directory of the including file (for "quoted" includes only), and then in each of the include directories
+ *  specified at creation time, in order. Each file is loaded at most once. Its contents are then shared by all
+ *  generators which include it, until the header is invalidated.
+ *
+ *  A single instance can be shared by any number of generators. Generators do not own the instance, so it must
+ *  outlive all of them.
+ *
+ *  GLSL header cache is thread-safe.
+ */
+#ifndef MISC_GLSL_HEADER_CACHE_H
+#define MISC_GLSL_HEADER_CACHE_H
+
+#include "misc/types.h"
+#include <map>
+#include <mutex>
+
+
+namespace Anvil
+{
+    class GLSLHeaderCache
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new GLSL header cache instance.
+         *
+         *  @param in_include_directories Directories to search for headers which could not be found relative
+         *                                to the including file. Searched in order.
+         *
+         *  @return New instance.
+         */
+        static Anvil::GLSLHeaderCacheUniquePtr create(const std::vector<std::string>& in_include_directories = std::vector<std::string>() );
+
+        /** Destructor. */
+        ~GLSLHeaderCache();
+
+        /** Registers a header which does not live on disk. Such headers take precedence over files, and are
+         *  matched against the name used by the #include directive, as is.
+         *
+         *  @param in_name     Name of the header.
+         *  @param in_contents GLSL code of the header.
+         *
+         *  @return true if successful, false if a header of the same name has already been registered.
+         */
+        bool add_header(const std::string& in_name,
+                        const std::string& in_contents);
+
+        /** Returns include directories, as specified at creation time. */
+        const std::vector<std::string>& get_include_directories() const
+        {
+            return m_include_directories;
+        }
+
+        /** Resolves an #include directive to a header, loading the header from disk if it has not been loaded yet.
+         *
+         *  @param in_header_name        Name of the header, as used by the #include directive.
+         *  @param in_includer_name      Resolved name of the file which contains the directive. Only used for
+         *                               "quoted" includes. May be empty.
+         *  @param in_is_local           true for "quoted" includes, false for <angled> ones.
+         *  @param out_resolved_name_ptr Deref will be set to the resolved name of the header. For headers loaded
+         *                               from disk, this is the path the header was loaded from. Must not be null.
+         *  @param out_contents_ptr      Deref will be set to the contents of the header. Must not be null.
+         *
+         *  @return true if successful, false if the header could not be found.
+         */
+        bool get_header(const std::string&                  in_header_name,
+                        const std::string&                  in_includer_name,
+                        bool                                in_is_local,
+                        std::string*                        out_resolved_name_ptr,
+                        std::shared_ptr<const std::string>* out_contents_ptr);
+
+        /** Drops the contents of a header loaded from disk, so that the file is re-read the next time it is
+         *  included. Headers registered with add_header() are not affected.
+         *
+         *  Generators which have already been baked are not affected. Use GLSLShaderToSPIRVGenerator::reset_baked_data()
+         *  to re-bake them.
+         *
+         *  @param in_resolved_name Resolved name of the header, as reported by get_header().
+         */
+        void invalidate(const std::string& in_resolved_name);
+
+        /** Drops the contents of all headers loaded from disk. See invalidate() for more details. */
+        void invalidate_all();
+
+    private:
+        /* Private type definitions */
+        typedef std::map<std::string, std::shared_ptr<const std::string> > HeaderNameToContentsMap;
+
+        /* Private functions */
+        GLSLHeaderCache(const std::vector<std::string>& in_include_directories);
+
+        bool get_file_header(const std::string&                  in_filename,
+                             std::shared_ptr<const std::string>* out_contents_ptr);
+
+        /* Private variables */
+        HeaderNameToContentsMap  m_file_headers;
+        std::vector<std::string> m_include_directories;
+        std::mutex               m_mutex;
+        HeaderNameToContentsMap  m_virtual_headers;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(GLSLHeaderCache);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(GLSLHeaderCache);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_GLSL_HEADER_CACHE_H */
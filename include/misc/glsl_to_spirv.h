@@ -24,6 +24,15 @@
  *  to a SPIR-V blob. The blob can then be used to initialize a Anvil::ShaderModule instance.
  *
  *  Optionally, users can inject arbitrary number of #defines (with or without the accompanying value).
+ *
+ *  Optionally, baked SPIR-V blobs can be stored in an on-disk cache, so that subsequent runs do not need
+ *  to recompile shaders whose final GLSL source code has not changed. See set_spirv_cache_directory().
+ *
+ *  Optionally, baked SPIR-V blobs can be run through a number of optimization passes before they are handed over
+ *  to shader modules. See set_optimization_settings().
+ *
+ *  Optionally, #include directives can be resolved against a GLSLHeaderCache instance, which may be shared by
+ *  many generators. See set_header_cache().
  **/
 #ifndef MISC_GLSL_TO_SPIRV_H
 #define MISC_GLSL_TO_SPIRV_H
@@ -121,9 +130,73 @@ namespace Anvil
             MODE_USE_SPECIFIED_SOURCE
         } Mode;
 
+        /** Describes optimization passes to apply to baked SPIR-V blobs. All passes are disabled by default. */
+        typedef struct OptimizationSettings
+        {
+            /* Removes unreachable code, unused functions, variables and constants.
+             *
+             * Requires ANVIL_LINK_WITH_SPIRV_TOOLS. Ignored otherwise. */
+            bool eliminate_dead_code;
+
+            /* Folds constant expressions, including ones which depend on specialization constants frozen by
+             * the freeze_specialization_constants pass, and propagates the results.
+             *
+             * Requires ANVIL_LINK_WITH_SPIRV_TOOLS. Ignored otherwise. */
+            bool fold_constants;
+
+            /* Turns specialization constants into regular constants. Constants are assigned values from
+             * specialization_constant_values, or their default values if they are not specified in the map.
+             * Frozen constants can no longer be specialized at pipeline creation time. */
+            bool freeze_specialization_constants;
+
+            /* Maps specialization constant IDs to values to freeze 32-bit and boolean constants with. */
+            std::map<uint32_t, uint32_t> specialization_constant_values;
+
+            /* Removes debug instructions, such as source code, names and line information. */
+            bool strip_debug_info;
+
+            OptimizationSettings()
+                :eliminate_dead_code            (false),
+                 fold_constants                 (false),
+                 freeze_specialization_constants(false),
+                 strip_debug_info               (false)
+            {
+                /* Stub */
+            }
+
+            /** Tells whether any of the passes is enabled. */
+            bool is_enabled() const
+            {
+                return (eliminate_dead_code             ||
+                        fold_constants                  ||
+                        freeze_specialization_constants ||
+                        strip_debug_info);
+            }
+        } OptimizationSettings;
+
+        /** Describes the results of the optimization stage, as run by the last bake_spirv_blob() call. Blobs loaded
+         *  from the on-disk cache are not optimized again, so all fields are zero for them. */
+        typedef struct OptimizationStats
+        {
+            uint32_t n_optimized_bytes;
+            uint32_t n_unoptimized_bytes;
+            uint64_t optimization_time_nsec;
+
+            OptimizationStats()
+                :n_optimized_bytes     (0),
+                 n_unoptimized_bytes   (0),
+                 optimization_time_nsec(0)
+            {
+                /* Stub */
+            }
+        } OptimizationStats;
+
         /* Public functions */
 
         /** Creates a new GLSLShaderToSPIRVGenerator instance.
+         *
+         *  If @param in_opt_device_ptr is not null, definitions reported by
+         *  BaseDevice::get_storage_feature_shader_definitions() are added to the new instance.
          *
          *  @param in_opt_device_ptr Logical device, whose limit values should be passed to glslang. May be null
          *                           if the object is only intended to be used for forming GLSL source code.
@@ -142,6 +215,21 @@ namespace Anvil
                                                                   ShaderStage              in_shader_stage,
                                                                   SpvVersion               in_spirv_version = SpvVersion::_1_0);
 
+        /** Creates a new GLSLShaderToSPIRVGenerator instance, which uses GLSL source code shared with other instances.
+         *
+         *  Behaves like MODE_USE_SPECIFIED_SOURCE, except that the source code is not copied. The string is only ever
+         *  read from, so any number of generators created from the same string (eg. permutations of an uber-shader
+         *  differing in definitions and placeholder values) can be baked in parallel, eg. with bake_all().
+         *
+         *  @param in_glsl_source_ptr GLSL source code to use. Must not be null.
+         *
+         *  Remaining arguments as per the other create() overload.
+         **/
+         static Anvil::GLSLShaderToSPIRVGeneratorUniquePtr create(const Anvil::BaseDevice*           in_opt_device_ptr,
+                                                                  std::shared_ptr<const std::string> in_glsl_source_ptr,
+                                                                  ShaderStage                        in_shader_stage,
+                                                                  SpvVersion                         in_spirv_version = SpvVersion::_1_0);
+
          /** Destructor. Releases all created Vulkan objects, as well as the SPIR-V blob data. */
          ~GLSLShaderToSPIRVGenerator();
 
@@ -208,6 +296,9 @@ namespace Anvil
                                      ExtensionBehavior in_behavior);
 
          /** Replaces all instances of [placeholder_name] with [value] in the shader source.
+          *
+          *  All placeholders are substituted in a single pass over the source code. If more than one placeholder name
+          *  starts at the same location, the longest one is used. Values are not scanned for placeholder names.
           *
           *  @param in_placeholder_name As specified above.
           *  @param in_value            As specified above.
@@ -246,6 +337,26 @@ namespace Anvil
          bool add_pragma(std::string in_pragma_name,
                          std::string in_opt_value = "");
 
+         /** Bakes SPIR-V blobs for multiple generators at once, distributing the work across worker threads.
+          *
+          *  Generators whose SPIR-V blobs have already been baked are skipped. Conversion call-backs are issued
+          *  from the worker threads.
+          *
+          *  @param in_generator_ptrs Generators to bake SPIR-V blobs for. Each generator may only be accessed by
+          *                           the worker threads until the function returns. Null entries are ignored.
+          *  @param in_n_threads      Maximum number of worker threads to use. 0 is interpreted as the number of
+          *                           hardware threads available. Ignored if @param in_opt_task_scheduler_ptr
+          *                           is not null.
+          *  @param in_opt_task_scheduler_ptr If not null, generators are baked by tasks submitted to this scheduler
+          *                                   (eg. BaseDevice::get_task_scheduler() ) instead of dedicated threads.
+          *
+          *  @return true if all SPIR-V blobs have been baked successfully, false otherwise. Use get_spirv_blob_size()
+          *          to determine which of the generators failed.
+          **/
+         static bool bake_all(const std::vector<Anvil::GLSLShaderToSPIRVGenerator*>& in_generator_ptrs,
+                              uint32_t                                               in_n_threads              = 0,
+                              Anvil::TaskScheduler*                                  in_opt_task_scheduler_ptr = nullptr);
+
          /* Loads the GLSL source code, injects the requested #defines and writes the result code
           * to a temporary file. Then, the func invokes glslangvalidator to build a SPIR-V blob
           * of the updated GLSL shader, deletes the temp file, loads up the blob and purges it.
@@ -254,6 +365,14 @@ namespace Anvil
           **/
          bool bake_spirv_blob() const;
 
+         /** Returns the data specified at creation time. Depending on the mode, this is either the name of the file
+          *  the GLSL source code is loaded from, or the GLSL source code itself.
+          **/
+         const std::string& get_data() const
+         {
+             return m_data;
+         }
+
          /* Converts a ExtensionBehavior enum value to a corresponding GLSL definition */
          std::string get_extension_behavior_glsl_code(const ExtensionBehavior& in_value) const;
 
@@ -311,6 +430,44 @@ namespace Anvil
              return m_glsl_source_code;
          }
 
+         /** Returns the header cache #include directives are resolved against, as specified with set_header_cache(). */
+         Anvil::GLSLHeaderCache* get_header_cache() const
+         {
+             return m_header_cache_ptr;
+         }
+
+         /** Returns resolved names of all headers the shader included, directly or indirectly, the last time its
+          *  SPIR-V blob was baked. The order is unspecified.
+          *
+          *  If the blob was loaded from the on-disk SPIR-V cache, the list still reflects the headers the final
+          *  GLSL source code depends on.
+          **/
+         std::vector<std::string> get_include_dependencies() const;
+
+         /** Returns the mode specified at creation time. */
+         const Mode& get_mode() const
+         {
+             return m_mode;
+         }
+
+         /** Returns optimization settings, as specified with set_optimization_settings(). */
+         const OptimizationSettings& get_optimization_settings() const
+         {
+             return m_optimization_settings;
+         }
+
+         /** Returns size and time statistics of the optimization stage, gathered by the last bake_spirv_blob() call. */
+         const OptimizationStats& get_optimization_stats() const
+         {
+             return m_optimization_stats;
+         }
+
+         /** Returns the directory used for the on-disk SPIR-V cache, or an empty string if the cache is disabled. */
+         const std::string& get_spirv_cache_directory() const
+         {
+             return m_spirv_cache_directory;
+         }
+
          /** Tells what shader stage the encapsulated GLSL shader descirbes. */
          ShaderStage get_shader_stage() const
          {
@@ -346,6 +503,82 @@ namespace Anvil
              return static_cast<uint32_t>(m_spirv_blob.size() );
          }
 
+         /** Discards the GLSL source code and the SPIR-V blob baked so far. The next time either of them is needed,
+          *  the source code is re-loaded (if MODE_LOAD_SOURCE_FROM_FILE mode is used) and the blob is re-baked.
+          *
+          *  Useful for picking up changes made to the source file after the blob has been baked.
+          **/
+         void reset_baked_data()
+         {
+             m_glsl_source_code.clear    ();
+             m_include_dependencies.clear();
+             m_spirv_blob.clear          ();
+
+             m_glsl_source_code_dirty = true;
+         }
+
+         /** Makes the generator resolve #include directives against the specified header cache.
+          *
+          *  GL_GOOGLE_include_directive is enabled automatically, unless a behavior for the extension has been
+          *  specified with add_extension_behavior(). Names of all included headers, along with a hash of their
+          *  contents, become a part of the SPIR-V cache key, so cache entries are invalidated whenever any of
+          *  the headers changes. Shaders which include headers are never matched against the source code of
+          *  living shader modules.
+          *
+          *  Includes are only supported if Anvil is linked with glslang. Otherwise, the cache is ignored.
+          *
+          *  Must be called before the SPIR-V blob is baked.
+          *
+          *  @param in_header_cache_ptr Header cache to use. Not owned by the generator, so it must outlive it.
+          *                             Null disables include support, which is the default.
+          **/
+         void set_header_cache(Anvil::GLSLHeaderCache* in_header_cache_ptr)
+         {
+             anvil_assert(m_spirv_blob.size() == 0);
+
+             m_glsl_source_code_dirty = true;
+             m_header_cache_ptr       = in_header_cache_ptr;
+         }
+
+         /** Specifies optimization passes to apply to the SPIR-V blob after it is baked.
+          *
+          *  Optimized blobs are what gets stored in the on-disk SPIR-V cache, so cached blobs do not need to be
+          *  optimized again. Optimization settings are included in cache keys.
+          *
+          *  If any of the passes fails, the unoptimized blob is used.
+          *
+          *  Must be called before the SPIR-V blob is baked.
+          *
+          *  @param in_settings Settings to use.
+          **/
+         void set_optimization_settings(const OptimizationSettings& in_settings)
+         {
+             anvil_assert(m_spirv_blob.size() == 0);
+
+             m_optimization_settings = in_settings;
+         }
+
+         /** Enables the on-disk SPIR-V cache for this generator.
+          *
+          *  Cache entries are keyed by the final GLSL source code (ie. after definitions, extension behaviors,
+          *  pragmas and placeholder values have been applied), the shader stage, target SPIR-V version, glslang
+          *  version and device limits passed to glslang. bake_spirv_blob() checks the cache before compiling
+          *  the shader and stores newly compiled blobs in it.
+          *
+          *  If ANVIL_LINK_WITH_GLSLANG is undefined, the version of the spawned glslangValidator is not known.
+          *  In this case, it is the app's responsibility to purge the cache whenever the tool is updated.
+          *
+          *  Must be called before the SPIR-V blob is baked.
+          *
+          *  @param in_directory Existing directory to store cache entries in. Empty string disables the cache.
+          **/
+         void set_spirv_cache_directory(const std::string& in_directory)
+         {
+             anvil_assert(m_spirv_blob.size() == 0);
+
+             m_spirv_cache_directory = in_directory;
+         }
+
     private:
         /* Private type declarations */
         typedef std::map<std::string, ExtensionBehavior>         ExtensionNameToExtensionBehaviorMap;
@@ -363,11 +596,17 @@ namespace Anvil
                                             ShaderStage              in_shader_stage,
                                             SpvVersion               in_spirv_version);
 
-        bool bake_glsl_source_code() const;
+        bool        bake_glsl_source_code     () const;
+        std::string get_spirv_cache_filename  (const std::string& in_key) const;
+        std::string get_spirv_cache_key       () const;
+        bool        load_spirv_blob_from_cache() const;
+        void        optimize_spirv_blob       () const;
+        void        store_spirv_blob_in_cache () const;
 
         #ifdef ANVIL_LINK_WITH_GLSLANG
             bool        bake_spirv_blob_by_calling_glslang(const char* in_body) const;
             EShLanguage get_glslang_shader_stage          () const;
+            bool        preprocess_includes               () const;
         #else
             bool bake_spirv_blob_by_spawning_glslang_process(const std::string& in_glsl_filename_with_path,
                                                              const std::string& in_spirv_filename_with_path) const;
@@ -382,11 +621,19 @@ namespace Anvil
             mutable std::string            m_shader_info_log;
         #endif
 
-        std::string m_data;
-        Mode        m_mode;
+        std::string                        m_data;
+        Mode                               m_mode;
+        std::shared_ptr<const std::string> m_shared_glsl_source_ptr;
+
+        OptimizationSettings      m_optimization_settings;
+        mutable OptimizationStats m_optimization_stats;
 
         mutable std::string m_glsl_source_code;
         mutable bool        m_glsl_source_code_dirty;
+        std::string         m_spirv_cache_directory;
+
+        Anvil::GLSLHeaderCache*                 m_header_cache_ptr;
+        mutable std::map<std::string, uint64_t> m_include_dependencies; /* resolved header name -> hash of contents */
 
         ShaderStage               m_shader_stage;
         SpvVersion                m_spirv_version;
@@ -0,0 +1,156 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Decompresses LZ4-compressed chunks with a compute shader.
+ *
+ *  Each chunk is a raw LZ4 block (no frame header), as produced by eg. LZ4_compress_default(), and is decompressed
+ *  independently of other chunks. Chunks are described by a table of ChunkInfo items, stored in the source buffer
+ *  next to the compressed data. Each shader invocation decodes a single chunk, so apps should split their data into
+ *  many chunks (64 KB is a good default) for the work to spread over the GPU.
+ *
+ *  Compressed data can be read at any byte offset. Decompressed data is written to the destination buffer in whole
+ *  32-bit words, so the destination offset of each chunk must be a multiple of 4. If a chunk's decompressed size is
+ *  not a multiple of 4, the remaining bytes of its last word are zeroed. Chunks must not overlap in the destination
+ *  buffer, rounding their size up to a multiple of 4.
+ *
+ *  Malformed chunks never cause out-of-bounds accesses to the chunk's destination region, but leave the region's
+ *  contents undefined.
+ *
+ *  Shaders are compiled at creation time with GLSLShaderToSPIRVGenerator, so the decompressor requires Anvil to be
+ *  built with ANVIL_LINK_WITH_GLSLANG defined.
+ *
+ *  GPU decompressor is NOT thread-safe.
+ */
+#ifndef MISC_GPU_DECOMPRESSOR_H
+#define MISC_GPU_DECOMPRESSOR_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class GPUDecompressor
+    {
+    public:
+        /* Public type definitions */
+
+        /** Describes a single chunk. Layout matches the one expected by the decompression shader (std430). */
+        typedef struct ChunkInfo
+        {
+            uint32_t src_offset;        /* Offset of the compressed data in the source buffer, in bytes      */
+            uint32_t compressed_size;   /* Size of the compressed data, in bytes                             */
+            uint32_t dst_offset;        /* Offset to decompress to in the destination buffer. Multiple of 4. */
+            uint32_t decompressed_size; /* Size of the decompressed data, in bytes                           */
+
+            ChunkInfo()
+                :src_offset       (0),
+                 compressed_size  (0),
+                 dst_offset       (0),
+                 decompressed_size(0)
+            {
+                /* Stub */
+            }
+
+            ChunkInfo(uint32_t in_src_offset,
+                      uint32_t in_compressed_size,
+                      uint32_t in_dst_offset,
+                      uint32_t in_decompressed_size)
+                :src_offset       (in_src_offset),
+                 compressed_size  (in_compressed_size),
+                 dst_offset       (in_dst_offset),
+                 decompressed_size(in_decompressed_size)
+            {
+                /* Stub */
+            }
+        } ChunkInfo;
+
+        /* Public functions */
+
+        /** Creates a new GPU decompressor instance. Compiles the decompression shader and bakes the compute pipeline.
+         *
+         *  @param in_device_ptr Device to create the decompressor for. Must not be null.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::GPUDecompressorUniquePtr create(const Anvil::BaseDevice* in_device_ptr);
+
+        /** Destructor. The caller must make sure none of the recorded decompressions is still executed by the GPU. */
+        ~GPUDecompressor();
+
+        /** Releases descriptor sets cached for the buffers passed to record_decompress(). Must be called before any of
+         *  these buffers is released.
+         */
+        void clear_cache();
+
+        /** Records a dispatch which decompresses a set of chunks.
+         *
+         *  The caller is responsible for making earlier writes to the source buffer available to compute shaders, and
+         *  for synchronizing later accesses to the destination buffer, which is written by compute shaders.
+         *
+         *  @param in_cmd_buffer_ptr     Command buffer to record the commands to. Must be in recording state and must
+         *                               support compute operations. Must not be null.
+         *  @param in_src_buffer_ptr     Buffer holding the compressed data and the chunk table. Must have been created
+         *                               with STORAGE_BUFFER usage. Must not be null.
+         *  @param in_chunk_table_offset Offset of the first ChunkInfo item in @param in_src_buffer_ptr. Must be
+         *                               a multiple of 4.
+         *  @param in_n_chunks           Number of ChunkInfo items in the table.
+         *  @param in_dst_buffer_ptr     Buffer to decompress to. Must have been created with STORAGE_BUFFER usage.
+         *                               Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_decompress(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                               Anvil::Buffer*            in_src_buffer_ptr,
+                               VkDeviceSize              in_chunk_table_offset,
+                               uint32_t                  in_n_chunks,
+                               Anvil::Buffer*            in_dst_buffer_ptr);
+
+    private:
+        /* Private type definitions */
+
+        /* Matches the decompression shader's push constant block */
+        typedef struct PushConstants
+        {
+            uint32_t chunk_table_offset; /* In 32-bit words */
+            uint32_t n_chunks;
+        } PushConstants;
+
+        /* Private functions */
+        GPUDecompressor(const Anvil::BaseDevice* in_device_ptr);
+
+        bool init();
+
+        /* Private variables */
+        const Anvil::BaseDevice*                            m_device_ptr;
+        Anvil::DescriptorSetCacheUniquePtr                  m_ds_cache_ptr;
+        Anvil::DescriptorSetLayoutUniquePtr                 m_ds_layout_ptr;
+        std::unique_ptr<Anvil::ShaderModuleStageEntryPoint> m_entrypoint_ptr;
+        Anvil::PipelineID                                   m_pipeline_id;
+        Anvil::ShaderModuleUniquePtr                        m_shader_module_ptr;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(GPUDecompressor);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(GPUDecompressor);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_GPU_DECOMPRESSOR_H */
@@ -0,0 +1,239 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements a scoped GPU profiler built on timestamp queries.
+ *
+ *  Apps wrap the work they would like to measure with begin_region() and end_region() calls. Regions can
+ *  be nested, and each region is also exposed to debugging tools with a debug marker (VK_EXT_debug_marker)
+ *  or, if the extension is not enabled, a debug utils label (VK_EXT_debug_utils).
+ *
+ *  The profiler owns a single timestamp query pool, split into one range per frame slot. begin_frame()
+ *  moves to the next slot and reads back the results of the frame which last used it, N frames ago. The
+ *  read never blocks: if any of the frame's timestamps are not available yet, the frame is dropped and
+ *  accounted for by get_n_dropped_frames(). Apps which wait on the fence of the frame being recycled before
+ *  calling begin_frame() never lose frames.
+ *
+ *  Results of the last frame which has been read back are exposed by get_last_frame_timings() as a tree,
+ *  stored in depth-first order. Timestamps are converted to nanoseconds using the device's timestampPeriod.
+ *
+ *  Regions must be begun and ended on command buffers which are submitted in recording order, to a single
+ *  queue family which supports timestamps. If the device does not support timestamp queries on graphics &
+ *  compute queues, timestamps are silently disabled and only the debug markers are recorded.
+ *
+ *  GPU profiler is NOT thread-safe.
+ */
+#ifndef MISC_GPU_PROFILER_H
+#define MISC_GPU_PROFILER_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class GPUProfiler
+    {
+    public:
+        /* Public type definitions */
+        typedef struct RegionTimings
+        {
+            /* Time at which the GPU started & finished executing the region's commands. Expressed in nanoseconds,
+             * in the device's time domain. */
+            uint64_t    end_time;
+            uint64_t    start_time;
+
+            /* Nesting level of the region. 0 for top-level regions. */
+            uint32_t    depth;
+
+            std::string name;
+
+            /* Index of the parent region, or UINT32_MAX for top-level regions. */
+            uint32_t    parent_index;
+
+            RegionTimings()
+                :end_time    (0),
+                 start_time  (0),
+                 depth       (0),
+                 parent_index(UINT32_MAX)
+            {
+                /* Stub */
+            }
+
+            /** Returns the time it took the GPU to execute the region, in nanoseconds. */
+            uint64_t get_duration() const
+            {
+                return (end_time > start_time) ? (end_time - start_time)
+                                               : 0;
+            }
+        } RegionTimings;
+
+        typedef struct FrameTimings
+        {
+            /* Index of the frame, as counted by begin_frame() calls. */
+            uint64_t                   frame_index;
+
+            /* Regions recorded for the frame, in the order they were begun. Children follow their parent. */
+            std::vector<RegionTimings> regions;
+
+            FrameTimings()
+                :frame_index(0)
+            {
+                /* Stub */
+            }
+        } FrameTimings;
+
+        /* Public functions */
+
+        /** Creates a new GPU profiler instance.
+         *
+         *  @param in_device_ptr                Device to create the profiler for. Must not be null.
+         *  @param in_n_frames_in_flight        Number of frames which can be in flight at any given time. Results
+         *                                      of a frame are read back this many frames later. Must not be 0.
+         *  @param in_n_max_regions_per_frame   Maximum number of regions which can be recorded for a single frame.
+         *                                      Regions in excess are only marked for debugging tools. Must not be 0.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::GPUProfilerUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
+                                                  uint32_t                 in_n_frames_in_flight,
+                                                  uint32_t                 in_n_max_regions_per_frame = 256);
+
+        /** Destructor. */
+        ~GPUProfiler();
+
+        /** Starts a new frame.
+         *
+         *  Reads back the results of the frame which last used the next frame slot, and then records a command which
+         *  resets the slot's timestamp queries into @param in_cmd_buffer_ptr. The command buffer must be submitted
+         *  before any other command buffer which holds the frame's regions.
+         *
+         *  All regions begun for the previous frame must have been ended.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the reset into. Must be recording and must not have
+         *                           a renderpass active. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool begin_frame(Anvil::CommandBufferBase* in_cmd_buffer_ptr);
+
+        /** Begins a new region, nested in the most recently begun region which has not been ended yet.
+         *
+         *  Records a timestamp write and a debug marker or label into @param in_cmd_buffer_ptr.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the commands into. Must be recording. Must not be null.
+         *  @param in_name           Name of the region.
+         *  @param in_opt_color      If not null, four floats defining the color of the debug marker.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool begin_region(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                          const std::string&        in_name,
+                          const float*              in_opt_color = nullptr);
+
+        /** Ends the most recently begun region.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the commands into. May be different from the command
+         *                           buffer the region has been begun in. Must be recording. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool end_region(Anvil::CommandBufferBase* in_cmd_buffer_ptr);
+
+        /** Returns timings of the last frame whose results have been read back.
+         *
+         *  @param out_opt_is_valid_ptr If not null, deref will be set to true if any frame has been read back so
+         *                              far, or to false otherwise.
+         */
+        const FrameTimings& get_last_frame_timings(bool* out_opt_is_valid_ptr = nullptr) const
+        {
+            if (out_opt_is_valid_ptr != nullptr)
+            {
+                *out_opt_is_valid_ptr = m_has_last_frame_timings;
+            }
+
+            return m_last_frame_timings;
+        }
+
+        /** Returns the number of frames whose results were unavailable by the time their slot was reused. */
+        uint64_t get_n_dropped_frames() const
+        {
+            return m_n_dropped_frames;
+        }
+
+        /** Tells whether timestamps are recorded. If false, regions are only marked for debugging tools. */
+        bool is_timestamp_recording_enabled() const
+        {
+            return (m_query_pool_ptr != nullptr);
+        }
+
+    private:
+        /* Private type definitions */
+        typedef struct Region
+        {
+            uint32_t    depth;
+            std::string name;
+            uint32_t    parent_index;
+        } Region;
+
+        typedef struct Frame
+        {
+            uint64_t            frame_index;
+            bool                is_pending;
+            std::vector<Region> regions;
+
+            Frame()
+                :frame_index(0),
+                 is_pending (false)
+            {
+                /* Stub */
+            }
+        } Frame;
+
+        /* Private functions */
+        GPUProfiler(const Anvil::BaseDevice* in_device_ptr,
+                    uint32_t                 in_n_frames_in_flight,
+                    uint32_t                 in_n_max_regions_per_frame);
+
+        bool init           ();
+        void read_back_frame(Frame*   in_frame_ptr,
+                             uint32_t in_n_frame);
+
+        /* Private variables */
+        const Anvil::BaseDevice*  m_device_ptr;
+        std::vector<Frame>        m_frames;
+        bool                      m_has_last_frame_timings;
+        FrameTimings              m_last_frame_timings;
+        uint32_t                  m_n_current_frame;
+        uint64_t                  m_n_dropped_frames;
+        const uint32_t            m_n_max_regions_per_frame;
+        uint64_t                  m_next_frame_index;
+        std::vector<uint32_t>     m_open_regions;   /* UINT32_MAX for regions which did not fit in the frame */
+        Anvil::QueryPoolUniquePtr m_query_pool_ptr;
+        std::vector<uint64_t>     m_query_results;
+        double                    m_timestamp_period;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(GPUProfiler);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(GPUProfiler);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_GPU_PROFILER_H */
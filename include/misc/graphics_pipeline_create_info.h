@@ -23,6 +23,8 @@
 #define ANVIL_GRAPHICS_PIPELINE_CREATE_INFO_H
 
 #include "misc/base_pipeline_create_info.h"
+#include "misc/flat_map.h"
+#include <functional>
 
 
 namespace Anvil
@@ -80,6 +82,11 @@ namespace Anvil
     class GraphicsPipelineCreateInfo : public BasePipelineCreateInfo
     {
     public:
+        /* Public type definitions */
+
+        /* Callback used by clone_with() to adjust state of a pipeline permutation. */
+        typedef std::function<void(Anvil::GraphicsPipelineCreateInfo* in_create_info_ptr)> PermutationFunction;
+
         /* Public functions */
         static Anvil::GraphicsPipelineCreateInfoUniquePtr create      (const Anvil::PipelineCreateFlags&        in_create_flags,
                                                                        const RenderPass*                        in_renderpass_ptr,
@@ -91,6 +98,39 @@ namespace Anvil
                                                                        const ShaderModuleStageEntryPoint&       in_vertex_shader_shader_stage_entrypoint_info,
                                                                        const Anvil::GraphicsPipelineCreateInfo* in_opt_reference_pipeline_info_ptr = nullptr,
                                                                        const Anvil::PipelineID*                 in_opt_base_pipeline_id_ptr        = nullptr);
+
+        /** Creates a graphics pipeline create info instance for use with dynamic rendering instances
+         *  (see CommandBufferBase::record_begin_rendering_KHR() ). No render pass is associated with
+         *  such pipelines. Instead, formats of the attachments rendered to are specified directly.
+         *
+         *  Color blending properties are indexed by color attachment location for such pipelines.
+         *
+         *  Requires VK_KHR_dynamic_rendering.
+         *
+         *  @param in_view_mask                    Multiview view mask to use.
+         *  @param in_n_color_attachment_formats   Number of formats available under @param in_opt_color_attachment_formats_ptr.
+         *  @param in_opt_color_attachment_formats_ptr Formats of the color attachments, indexed by location. Format::UNKNOWN
+         *                                         can be used for unused locations. May be null if
+         *                                         @param in_n_color_attachment_formats is 0.
+         *  @param in_depth_attachment_format      Format of the depth attachment, or Format::UNKNOWN if none is used.
+         *  @param in_stencil_attachment_format    Format of the stencil attachment, or Format::UNKNOWN if none is used.
+         *
+         *  Remaining arguments as per create().
+         **/
+        static Anvil::GraphicsPipelineCreateInfoUniquePtr create_for_dynamic_rendering(const Anvil::PipelineCreateFlags&        in_create_flags,
+                                                                                       uint32_t                                 in_view_mask,
+                                                                                       uint32_t                                 in_n_color_attachment_formats,
+                                                                                       const Anvil::Format*                     in_opt_color_attachment_formats_ptr,
+                                                                                       Anvil::Format                            in_depth_attachment_format,
+                                                                                       Anvil::Format                            in_stencil_attachment_format,
+                                                                                       const ShaderModuleStageEntryPoint&       in_fragment_shader_stage_entrypoint_info,
+                                                                                       const ShaderModuleStageEntryPoint&       in_geometry_shader_stage_entrypoint_info,
+                                                                                       const ShaderModuleStageEntryPoint&       in_tess_control_shader_stage_entrypoint_info,
+                                                                                       const ShaderModuleStageEntryPoint&       in_tess_evaluation_shader_stage_entrypoint_info,
+                                                                                       const ShaderModuleStageEntryPoint&       in_vertex_shader_shader_stage_entrypoint_info,
+                                                                                       const Anvil::GraphicsPipelineCreateInfo* in_opt_reference_pipeline_info_ptr = nullptr,
+                                                                                       const Anvil::PipelineID*                 in_opt_base_pipeline_id_ptr        = nullptr);
+
         static Anvil::GraphicsPipelineCreateInfoUniquePtr create_proxy();
 
         ~GraphicsPipelineCreateInfo();
@@ -113,12 +153,16 @@ namespace Anvil
         {
             if (in_shader_stage != Anvil::ShaderStage::FRAGMENT                &&
                 in_shader_stage != Anvil::ShaderStage::GEOMETRY                &&
+                in_shader_stage != Anvil::ShaderStage::MESH                    &&
+                in_shader_stage != Anvil::ShaderStage::TASK                    &&
                 in_shader_stage != Anvil::ShaderStage::TESSELLATION_CONTROL    &&
                 in_shader_stage != Anvil::ShaderStage::TESSELLATION_EVALUATION &&
                 in_shader_stage != Anvil::ShaderStage::VERTEX)
             {
                 anvil_assert(in_shader_stage == Anvil::ShaderStage::FRAGMENT                ||
                              in_shader_stage == Anvil::ShaderStage::GEOMETRY                ||
+                             in_shader_stage == Anvil::ShaderStage::MESH                    ||
+                             in_shader_stage == Anvil::ShaderStage::TASK                    ||
                              in_shader_stage == Anvil::ShaderStage::TESSELLATION_CONTROL    ||
                              in_shader_stage == Anvil::ShaderStage::TESSELLATION_EVALUATION ||
                              in_shader_stage == Anvil::ShaderStage::VERTEX);
@@ -158,6 +202,21 @@ namespace Anvil
         /** Tells whether depth writes have been enabled. **/
         bool are_depth_writes_enabled() const;
 
+        /** Creates a copy of this create info and passes it to @param in_opt_permutation_func, so that state which is
+         *  specific to a pipeline permutation can be adjusted before the copy is returned.
+         *
+         *  Vertex bindings, scissor boxes, viewports and blending properties are shared with this instance until
+         *  either of the two modifies them, so spawning many permutations off a single create info is cheap.
+         *
+         *  Not supported for proxy create infos.
+         *
+         *  @param in_opt_permutation_func Function to call for the new create info instance. May be null, in which
+         *                                 case an exact copy is returned.
+         *
+         *  @return New create info instance if successful, nullptr otherwise.
+         **/
+        Anvil::GraphicsPipelineCreateInfoUniquePtr clone_with(const PermutationFunction& in_opt_permutation_func = nullptr) const;
+
         /** Retrieves blending properties defined.
          *
          *  @param out_opt_blend_constant_vec4_ptr If not NULL, deref will be assigned to a ptr holding four float values
@@ -267,6 +326,14 @@ namespace Anvil
                                               const RenderPass** out_opt_renderpass_ptr_ptr,
                                               SubPassID*         out_opt_subpass_id_ptr) const;
 
+        /** Returns a structural hash of the create info. Covers shader stages, specialization constants, descriptor
+         *  set create info items, push constant ranges, all fixed-function state, the renderpass and the subpass.
+         *  Pipeline names are not taken into account.
+         *
+         *  Create info instances which compare equal return the same hash.
+         **/
+        uint64_t get_hash() const;
+
         /** Retrieves logic op-related state configuration.
          *
          *  @param out_opt_is_enabled_ptr  If not null, deref will be set to true if the logic op has
@@ -330,6 +397,26 @@ namespace Anvil
             return m_rasterization_stream_index;
         }
 
+        /** Retrieves attachment formats & view mask specified for a dynamic rendering pipeline.
+         *
+         *  Can only be called for create info instances created with create_for_dynamic_rendering().
+         *
+         *  @param out_opt_view_mask_ptr                   If not null, deref will be set to the view mask.
+         *  @param out_opt_n_color_attachment_formats_ptr  If not null, deref will be set to the number of color attachment formats.
+         *  @param out_opt_color_attachment_formats_ptr_ptr If not null, deref will be set to a ptr to an array of color attachment
+         *                                                 formats. The array is owned by the create info instance.
+         *  @param out_opt_depth_attachment_format_ptr     If not null, deref will be set to the depth attachment format.
+         *  @param out_opt_stencil_attachment_format_ptr   If not null, deref will be set to the stencil attachment format.
+         **/
+        void get_rendering_properties(uint32_t*             out_opt_view_mask_ptr,
+                                      uint32_t*             out_opt_n_color_attachment_formats_ptr,
+                                      const Anvil::Format** out_opt_color_attachment_formats_ptr_ptr,
+                                      Anvil::Format*        out_opt_depth_attachment_format_ptr,
+                                      Anvil::Format*        out_opt_stencil_attachment_format_ptr) const;
+
+        /** Returns the render pass associated with the create info instance. Null for create info instances
+         *  created with create_for_dynamic_rendering().
+         **/
         const RenderPass* get_renderpass() const
         {
             return m_renderpass_ptr;
@@ -381,6 +468,18 @@ namespace Anvil
                                         uint32_t* out_opt_width_ptr,
                                         uint32_t* out_opt_height_ptr) const;
 
+        /** Retrieves the shading rate palette assigned to a viewport at the specified index.
+         *
+         *  @param in_n_viewport            Index of the viewport to use for the query.
+         *  @param out_opt_n_entries_ptr    If not null, deref will be set to the number of palette entries.
+         *  @param out_opt_entries_ptr_ptr  If not null, deref will be set to a ptr to an array holding the palette entries.
+         *
+         *  @return true if a palette has been assigned to the viewport, false otherwise.
+         **/
+        bool get_shading_rate_palette(uint32_t                                 in_n_viewport,
+                                      uint32_t*                                out_opt_n_entries_ptr,
+                                      const Anvil::ShadingRatePaletteEntryNV** out_opt_entries_ptr_ptr) const;
+
         /** Retrieves stencil test-related state configuration.
          *
          *  @param out_opt_is_enabled_ptr                  If not null, deref will be set to true if stencil test
@@ -514,6 +613,25 @@ namespace Anvil
         /** Tells whether sample mask has been enabled. */
         bool is_sample_mask_enabled() const;
 
+        /** Tells whether the shading rate image has been enabled. */
+        bool is_shading_rate_image_enabled() const
+        {
+            return m_shading_rate_image_enabled;
+        }
+
+        /** Tells whether the pipeline is going to be used with dynamic rendering instances, rather than a render pass. */
+        bool uses_dynamic_rendering() const
+        {
+            return m_uses_dynamic_rendering;
+        }
+
+        /** Tells whether the pipeline uses mesh shading (see set_mesh_shading_stages() ) rather than the vertex
+         *  processing stages. */
+        bool uses_mesh_shading() const
+        {
+            return (m_shader_stages.find(Anvil::ShaderStage::MESH) != m_shader_stages.end() );
+        }
+
         /** Sets a new blend constant.
          *
          *  @param in_blend_constant_vec4 4 floats, specifying the constant. Must not be nullptr.
@@ -544,6 +662,24 @@ namespace Anvil
                                                    Anvil::BlendFactor         in_dst_alpha_blend_factor,
                                                    Anvil::ColorComponentFlags in_channel_write_mask);
 
+        /** Turns the pipeline into a mesh shading pipeline. Mesh shading pipelines replace the vertex,
+         *  tessellation and geometry stages with an optional task stage and a mandatory mesh stage. Vertex input
+         *  and input assembly state is ignored for such pipelines.
+         *
+         *  The entry-point names used for both stages are taken from the specified descriptors, since
+         *  ShaderModule does not track names for these stages.
+         *
+         *  Requires VK_NV_mesh_shader. Only the fragment stage may have been specified at creation time.
+         *
+         *  @param in_mesh_shader_stage_entrypoint_info     Mesh stage entry-point. Must refer to a shader module.
+         *  @param in_opt_task_shader_stage_entrypoint_info Task stage entry-point. May refer to a null shader module
+         *                                                  if no task stage should be used.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool set_mesh_shading_stages(const ShaderModuleStageEntryPoint& in_mesh_shader_stage_entrypoint_info,
+                                     const ShaderModuleStageEntryPoint& in_opt_task_shader_stage_entrypoint_info = ShaderModuleStageEntryPoint() );
+
         /** Updates multisampling properties.
          *
          *  @param in_sample_count       Number of rasterization samples to be used (expressed as one of the enum values).
@@ -659,6 +795,26 @@ namespace Anvil
                                         uint32_t in_width,
                                         uint32_t in_height);
 
+        /** Assigns a shading rate palette to a viewport at the specified index. Each texel of the shading rate image
+         *  bound with CommandBuffer::record_bind_shading_rate_image_NV() indexes the palette of the viewport being
+         *  rasterized to, and the entry found there controls how many fragment shader invocations are spawned for the
+         *  covered pixels.
+         *
+         *  This information is only used if the shading rate image has been enabled with toggle_shading_rate_image().
+         *  A palette must be assigned to each viewport used by the pipeline, unless
+         *  DynamicState::VIEWPORT_SHADING_RATE_PALETTE_NV is enabled.
+         *
+         *  Requires VK_NV_shading_rate_image.
+         *
+         *  @param in_n_viewport   Index of the viewport to assign the palette to.
+         *  @param in_n_entries    Number of palette entries. Must not be 0 and must not exceed the device's
+         *                         shadingRatePaletteSize limit.
+         *  @param in_entries_ptr  Array of @param in_n_entries palette entries. Must not be null.
+         */
+        void set_shading_rate_palette(uint32_t                                in_n_viewport,
+                                      uint32_t                                in_n_entries,
+                                      const Anvil::ShadingRatePaletteEntryNV* in_entries_ptr);
+
         /** Sets a number of stencil test properties.
          *
          *  @param in_update_front_face_state true if the front face stencil states should be updated; false to update the
@@ -833,12 +989,30 @@ namespace Anvil
          */
         void toggle_sample_shading(bool in_should_enable);
 
+        /** Enables or disables the shading rate image. When enabled, fragment shading rate is looked up per screen-space
+         *  tile from the shading rate image bound with CommandBuffer::record_bind_shading_rate_image_NV(), which lets
+         *  apps shade peripheral or low-contrast regions at a coarser rate.
+         *
+         *  NOTE: If you enable the functionality, also make sure to call set_shading_rate_palette() for each viewport,
+         *        or enable DynamicState::VIEWPORT_SHADING_RATE_PALETTE_NV.
+         *
+         *  Requires VK_NV_shading_rate_image.
+         *
+         *  @param in_should_enable true to enable the shading rate image; false to disable it.
+         */
+        void toggle_shading_rate_image(bool in_should_enable);
+
         /** Enables or disables the stencil test.
          *
          *  @param in_should_enable true to enable the test; false to disable it.
          */
         void toggle_stencil_test(bool in_should_enable);
 
+        /** Tells whether the two create info instances describe identical pipelines. Pipeline names are not
+         *  taken into account.
+         **/
+        bool operator==(const Anvil::GraphicsPipelineCreateInfo& in_create_info) const;
+
     private:
         /* Private type definitions */
 
@@ -890,7 +1064,7 @@ namespace Anvil
             }
         } BlendingProperties;
 
-        typedef std::map<SubPassAttachmentID, BlendingProperties> SubPassAttachmentToBlendingPropertiesMap;
+        typedef Anvil::FlatMap<SubPassAttachmentID, BlendingProperties> SubPassAttachmentToBlendingPropertiesMap;
 
         /** Defines a single scissor box
          *
@@ -1016,15 +1190,18 @@ namespace Anvil
             }
         } InternalVertexBinding;
 
-        typedef std::map<uint32_t, InternalScissorBox>    InternalScissorBoxes;
-        typedef std::map<uint32_t, InternalVertexBinding> InternalVertexBindings;
-        typedef std::map<uint32_t, InternalViewport>      InternalViewports;
+        /* Kept in copy-on-write storage, so that clone_with() does not need to copy these */
+        typedef Anvil::FlatMap<uint32_t, InternalScissorBox>                             InternalScissorBoxes;
+        typedef Anvil::FlatMap<uint32_t, std::vector<Anvil::ShadingRatePaletteEntryNV> > InternalShadingRatePalettes;
+        typedef Anvil::FlatMap<uint32_t, InternalVertexBinding>                          InternalVertexBindings;
+        typedef Anvil::FlatMap<uint32_t, InternalViewport>                               InternalViewports;
 
         /* Private functions */
         explicit GraphicsPipelineCreateInfo(const RenderPass* in_renderpass_ptr,
                                             SubPassID         in_subpass_id);
 
         bool copy_gfx_state_from(const Anvil::GraphicsPipelineCreateInfo* in_src_pipeline_create_info_ptr);
+        void get_state_words    (std::vector<uint64_t>*                   out_words_ptr)                   const;
 
         /* Private variables */
         bool m_depth_clip_enabled;
@@ -1067,6 +1244,9 @@ namespace Anvil
         Anvil::ConservativeRasterizationModeEXT m_conservative_rasterization_mode;
         float                                   m_extra_primitive_overestimation_size;
 
+        bool                        m_shading_rate_image_enabled;
+        InternalShadingRatePalettes m_shading_rate_palettes;
+
         TessellationDomainOrigin m_tessellation_domain_origin;
 
         InternalVertexBindings                   m_bindings;
@@ -1090,6 +1270,13 @@ namespace Anvil
 
         const RenderPass* m_renderpass_ptr;
         SubPassID         m_subpass_id;
+
+        /* VK_KHR_dynamic_rendering: */
+        std::vector<Anvil::Format> m_rendering_color_attachment_formats;
+        Anvil::Format              m_rendering_depth_attachment_format;
+        Anvil::Format              m_rendering_stencil_attachment_format;
+        uint32_t                   m_rendering_view_mask;
+        bool                       m_uses_dynamic_rendering;
     };
 
 };
@@ -0,0 +1,312 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements host memory allocators which can be plugged into Vulkan via VkAllocationCallbacks.
+ *
+ *  Anvil passes the callbacks of the allocator assigned with InstanceCreateInfo::set_host_allocator() and
+ *  DeviceCreateInfo::set_host_allocator() to all vkCreate*(), vkDestroy*(), vkAllocateMemory() and vkFreeMemory()
+ *  calls it makes. If no allocator is assigned, a null pointer is passed and the driver falls back to its own
+ *  allocator, as before.
+ *
+ *  Two implementations are provided:
+ *
+ *  1) TrackingHostAllocator:         forwards allocations to the system heap and keeps track of the number of bytes
+ *                                    which are alive at any given time, per allocation scope. Use it to find out how
+ *                                    much host memory the driver uses on behalf of the app.
+ *  2) ThreadLocalArenaHostAllocator: services VK_SYSTEM_ALLOCATION_SCOPE_COMMAND allocations, which only live for
+ *                                    the duration of a single Vulkan command, from a per-thread linear arena. The arena
+ *                                    is rewound as soon as all its allocations are freed. Allocations of other scopes
+ *                                    are forwarded to a fallback allocator.
+ *
+ *  Apps can provide their own allocators by deriving from HostAllocator.
+ *
+ *  Allocators must outlive all instances & devices they have been assigned to, as well as all objects created from
+ *  them.
+ */
+#ifndef MISC_HOST_ALLOCATOR_H
+#define MISC_HOST_ALLOCATOR_H
+
+#include "misc/types.h"
+#include <atomic>
+
+
+namespace Anvil
+{
+    class HostAllocator
+    {
+    public:
+        /* Public functions */
+
+        /** Destructor. */
+        virtual ~HostAllocator();
+
+        /** Allocates @param in_size bytes of host memory, aligned to @param in_alignment.
+         *
+         *  Must be thread-safe.
+         *
+         *  @return Pointer to the allocated memory if successful, null otherwise.
+         */
+        virtual void* allocate(size_t                       in_size,
+                               size_t                       in_alignment,
+                               Anvil::SystemAllocationScope in_scope) = 0;
+
+        /** Releases memory previously returned by allocate() or reallocate(). Null pointers must be ignored.
+         *
+         *  Must be thread-safe.
+         */
+        virtual void free(void* in_ptr) = 0;
+
+        /** Returns a VkAllocationCallbacks instance, which routes all calls to this allocator.
+         *
+         *  The returned pointer stays valid for as long as the allocator is alive.
+         */
+        const VkAllocationCallbacks* get_allocation_callbacks_vk() const
+        {
+            return &m_allocation_callbacks_vk;
+        }
+
+        /** Called when the driver has allocated @param in_size bytes of host memory on its own, for example
+         *  to hold executable code. The memory is owned and released by the driver.
+         *
+         *  Default implementation is a stub.
+         */
+        virtual void on_internal_allocation(size_t                       in_size,
+                                            Anvil::SystemAllocationScope in_scope);
+
+        /** Called when the driver has released a block of host memory previously reported via
+         *  on_internal_allocation().
+         *
+         *  Default implementation is a stub.
+         */
+        virtual void on_internal_free(size_t                       in_size,
+                                      Anvil::SystemAllocationScope in_scope);
+
+        /** Resizes memory block @param in_ptr to @param in_size bytes, following the semantics of
+         *  PFN_vkReallocationFunction. Contents of the block, up to the smaller of the two sizes, must be
+         *  preserved.
+         *
+         *  Must be thread-safe.
+         *
+         *  @return Pointer to the resized memory block if successful, null otherwise.
+         */
+        virtual void* reallocate(void*                        in_ptr,
+                                 size_t                       in_size,
+                                 size_t                       in_alignment,
+                                 Anvil::SystemAllocationScope in_scope) = 0;
+
+    protected:
+        /* Protected functions */
+        HostAllocator();
+
+        /** Allocates @param in_size bytes from the system heap, aligned to @param in_alignment. The size of
+         *  the allocation and @param in_tag are stored in a header preceding the returned pointer, and can be
+         *  retrieved with get_heap_allocation_size() and get_heap_allocation_tag().
+         *
+         *  Returned pointer must be released with free_to_heap().
+         */
+        static void* allocate_from_heap(size_t   in_size,
+                                        size_t   in_alignment,
+                                        uint32_t in_tag);
+
+        static void     free_to_heap            (void*       in_ptr);
+        static size_t   get_heap_allocation_size(const void* in_ptr);
+        static uint32_t get_heap_allocation_tag (const void* in_ptr);
+
+    private:
+        /* Private functions */
+        static void* VKAPI_PTR allocate_callback           (void*                    in_user_data_ptr,
+                                                            size_t                   in_size,
+                                                            size_t                   in_alignment,
+                                                            VkSystemAllocationScope  in_scope);
+        static void  VKAPI_PTR free_callback               (void*                    in_user_data_ptr,
+                                                            void*                    in_ptr);
+        static void  VKAPI_PTR internal_allocation_callback(void*                    in_user_data_ptr,
+                                                            size_t                   in_size,
+                                                            VkInternalAllocationType in_type,
+                                                            VkSystemAllocationScope  in_scope);
+        static void  VKAPI_PTR internal_free_callback      (void*                    in_user_data_ptr,
+                                                            size_t                   in_size,
+                                                            VkInternalAllocationType in_type,
+                                                            VkSystemAllocationScope  in_scope);
+        static void* VKAPI_PTR reallocate_callback         (void*                    in_user_data_ptr,
+                                                            void*                    in_ptr,
+                                                            size_t                   in_size,
+                                                            size_t                   in_alignment,
+                                                            VkSystemAllocationScope  in_scope);
+
+        /* Private variables */
+        VkAllocationCallbacks m_allocation_callbacks_vk;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(HostAllocator);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(HostAllocator);
+    };
+
+    /** Serves command-scope allocations from a per-thread linear arena. Please see the top of this file for
+     *  more details.
+     *
+     *  Command-scope allocations which do not fit in the arena, and allocations of all other scopes, are
+     *  forwarded to the fallback allocator or, if none has been specified, to the system heap.
+     *
+     *  The arena is shared by all instances of this class used on a given thread. It is released when the
+     *  thread exits.
+     *
+     *  Thread-safe.
+     */
+    class ThreadLocalArenaHostAllocator : public HostAllocator
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new allocator instance.
+         *
+         *  @param in_arena_size                 Size of the per-thread arena, in bytes. Must not be 0.
+         *  @param in_opt_fallback_allocator_ptr Allocator to forward non-command-scope allocations to. May be
+         *                                       null, in which case the system heap is used. If not null, must
+         *                                       outlive the created allocator.
+         *
+         *  @return New instance.
+         */
+        static Anvil::ThreadLocalArenaHostAllocatorUniquePtr create(size_t               in_arena_size                 = 64 * 1024,
+                                                                    Anvil::HostAllocator* in_opt_fallback_allocator_ptr = nullptr);
+
+        /** Destructor. */
+        virtual ~ThreadLocalArenaHostAllocator();
+
+        /** Returns the number of command-scope allocations served from the arena so far. */
+        uint64_t get_n_arena_allocations() const
+        {
+            return m_n_arena_allocations;
+        }
+
+        /** Returns the number of command-scope allocations which did not fit in the arena and had to be
+         *  forwarded to the fallback allocator. If this number is high, consider using a larger arena.
+         */
+        uint64_t get_n_arena_overflows() const
+        {
+            return m_n_arena_overflows;
+        }
+
+        /* HostAllocator functions */
+        void* allocate  (size_t                       in_size,
+                         size_t                       in_alignment,
+                         Anvil::SystemAllocationScope in_scope) override;
+        void  free      (void*                        in_ptr) override;
+        void* reallocate(void*                        in_ptr,
+                         size_t                       in_size,
+                         size_t                       in_alignment,
+                         Anvil::SystemAllocationScope in_scope) override;
+
+        void on_internal_allocation(size_t                       in_size,
+                                    Anvil::SystemAllocationScope in_scope) override;
+        void on_internal_free      (size_t                       in_size,
+                                    Anvil::SystemAllocationScope in_scope) override;
+
+    private:
+        /* Private functions */
+        ThreadLocalArenaHostAllocator(size_t                in_arena_size,
+                                      Anvil::HostAllocator* in_opt_fallback_allocator_ptr);
+
+        void* allocate_from_arena   (size_t                       in_size,
+                                     size_t                       in_alignment);
+        void* allocate_from_fallback(size_t                       in_size,
+                                     size_t                       in_alignment,
+                                     Anvil::SystemAllocationScope in_scope);
+        bool  is_arena_allocation   (const void*                  in_ptr) const;
+
+        /* Private variables */
+        const size_t          m_arena_size;
+        Anvil::HostAllocator* m_fallback_allocator_ptr;
+
+        std::atomic<uint64_t> m_n_arena_allocations;
+        std::atomic<uint64_t> m_n_arena_overflows;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(ThreadLocalArenaHostAllocator);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(ThreadLocalArenaHostAllocator);
+    };
+
+    /** Forwards all allocations to the system heap and tracks the amount of host memory allocated, per
+     *  allocation scope. Please see the top of this file for more details.
+     *
+     *  Thread-safe.
+     */
+    class TrackingHostAllocator : public HostAllocator
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new allocator instance. */
+        static Anvil::TrackingHostAllocatorUniquePtr create();
+
+        /** Destructor. */
+        virtual ~TrackingHostAllocator();
+
+        /** Returns the number of bytes currently allocated for @param in_scope. Does not include internal
+         *  allocations. */
+        uint64_t get_n_allocated_bytes(Anvil::SystemAllocationScope in_scope) const;
+
+        /** Returns the number of bytes currently allocated for all scopes. Does not include internal allocations. */
+        uint64_t get_n_allocated_bytes() const;
+
+        /** Returns the number of live allocations made for @param in_scope. */
+        uint64_t get_n_allocations(Anvil::SystemAllocationScope in_scope) const;
+
+        /** Returns the number of bytes the driver reported it allocated internally for @param in_scope. */
+        uint64_t get_n_internal_allocated_bytes(Anvil::SystemAllocationScope in_scope) const;
+
+        /** Returns the highest value get_n_allocated_bytes() has reported since the allocator was created. */
+        uint64_t get_n_peak_allocated_bytes() const
+        {
+            return m_n_peak_allocated_bytes;
+        }
+
+        /* HostAllocator functions */
+        void* allocate  (size_t                       in_size,
+                         size_t                       in_alignment,
+                         Anvil::SystemAllocationScope in_scope) override;
+        void  free      (void*                        in_ptr) override;
+        void* reallocate(void*                        in_ptr,
+                         size_t                       in_size,
+                         size_t                       in_alignment,
+                         Anvil::SystemAllocationScope in_scope) override;
+
+        void on_internal_allocation(size_t                       in_size,
+                                    Anvil::SystemAllocationScope in_scope) override;
+        void on_internal_free      (size_t                       in_size,
+                                    Anvil::SystemAllocationScope in_scope) override;
+
+    private:
+        /* Private functions */
+        TrackingHostAllocator();
+
+        /* Private variables */
+        std::atomic<uint64_t> m_n_allocated_bytes         [static_cast<uint32_t>(Anvil::SystemAllocationScope::COUNT)];
+        std::atomic<uint64_t> m_n_allocations             [static_cast<uint32_t>(Anvil::SystemAllocationScope::COUNT)];
+        std::atomic<uint64_t> m_n_internal_allocated_bytes[static_cast<uint32_t>(Anvil::SystemAllocationScope::COUNT)];
+        std::atomic<uint64_t> m_n_peak_allocated_bytes;
+        std::atomic<uint64_t> m_n_total_allocated_bytes;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(TrackingHostAllocator);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(TrackingHostAllocator);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_HOST_ALLOCATOR_H */
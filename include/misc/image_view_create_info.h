@@ -328,6 +328,12 @@ namespace Anvil
             return m_format;
         }
 
+        /** Returns a hash of the create info. Create info instances which compare equal return the same hash.
+         *
+         *  The parent image and the YCbCr conversion object, if any, are identified by their wrapper addresses.
+         */
+        uint64_t get_hash() const;
+
         const Anvil::MTSafety& get_mt_safety() const
         {
             return m_mt_safety;
@@ -453,6 +459,8 @@ namespace Anvil
             m_usage = in_usage;
         }
 
+        bool operator==(const Anvil::ImageViewCreateInfo& in_create_info) const;
+
     private:
 
         /* Private functions */
@@ -0,0 +1,249 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements GPU-driven culling of instanced geometry, producing compacted indirect draw command streams.
+ *
+ *  The culler consumes a buffer of Instance items, each describing the world-space bounding sphere of an instance
+ *  and the indexed draw which renders it. A compute shader tests each instance's bounding sphere against the view
+ *  frustum and, optionally, against a hierarchical depth pyramid. Visible instances append a
+ *  VkDrawIndexedIndirectCommand (with instance count of 1 and the instance's first instance index, which shaders can
+ *  use to fetch per-instance data) to the stream the instance belongs to, and bump the stream's draw count.
+ *
+ *  Streams let apps keep instances which need different pipelines or bindings separate. Each stream occupies
+ *  n_max_draws_per_stream tightly packed commands in the draw command buffer, and a single uint32 in the count
+ *  buffer. The streams can be drawn with record_draw_stream(), which uses vkCmdDrawIndexedIndirectCountKHR() or
+ *  vkCmdDrawIndexedIndirectCountAMD(), depending on which extension has been enabled for the device. If more than
+ *  n_max_draws_per_stream instances of a stream turn out to be visible, the excess ones are dropped.
+ *
+ *  The depth pyramid, if used, must be a single-channel floating-point image, whose each texel holds the farthest
+ *  depth of the region it covers in the base mip, with the conventional depth range (0 at the near plane). Mip 0 does
+ *  not need to match the render target's resolution. It is usually built from the previous frame's depth buffer.
+ *
+ *  Shaders are compiled at creation time with GLSLShaderToSPIRVGenerator, so the culler requires Anvil to be built
+ *  with ANVIL_LINK_WITH_GLSLANG defined.
+ *
+ *  Indirect draw culler is NOT thread-safe.
+ */
+#ifndef MISC_INDIRECT_DRAW_CULLER_H
+#define MISC_INDIRECT_DRAW_CULLER_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class IndirectDrawCuller
+    {
+    public:
+        /* Public type definitions */
+
+        /** Describes a single instance. Layout matches the one expected by the culling shader (std430). */
+        typedef struct Instance
+        {
+            float    bounding_sphere[4]; /* World-space center (xyz) and radius (w)                        */
+            uint32_t index_count;        /* Draw arguments, as per VkDrawIndexedIndirectCommand            */
+            uint32_t first_index;
+            int32_t  vertex_offset;
+            uint32_t first_instance;
+            uint32_t n_stream;           /* Index of the stream to append the draw to if instance is visible */
+            uint32_t padding[3];
+
+            Instance()
+                :index_count   (0),
+                 first_index   (0),
+                 vertex_offset (0),
+                 first_instance(0),
+                 n_stream      (0)
+            {
+                bounding_sphere[0] = 0.0f;
+                bounding_sphere[1] = 0.0f;
+                bounding_sphere[2] = 0.0f;
+                bounding_sphere[3] = 0.0f;
+                padding        [0] = 0;
+                padding        [1] = 0;
+                padding        [2] = 0;
+            }
+        } Instance;
+
+        /** Describes a single culling pass. */
+        typedef struct CullInfo
+        {
+            /* Buffer to store per-stream draw counts in. Must have been created with STORAGE_BUFFER and INDIRECT_BUFFER usage.
+             * Must hold at least get_count_buffer_size() bytes, starting at the specified offset. */
+            Anvil::Buffer*    count_buffer_ptr;
+            VkDeviceSize      count_buffer_offset;
+
+            /* Optional depth pyramid image view, as described in the documentation above. If null, occlusion culling is
+             * not performed. The image must be in SHADER_READ_ONLY_OPTIMAL layout at the time the commands execute. */
+            Anvil::ImageView* depth_pyramid_image_view_ptr;
+            uint32_t          depth_pyramid_height;
+            uint32_t          depth_pyramid_width;
+
+            /* Buffer to store compacted draw commands in. Must have been created with STORAGE_BUFFER and INDIRECT_BUFFER usage.
+             * Must hold at least get_draw_command_buffer_size() bytes, starting at the specified offset. */
+            Anvil::Buffer*    draw_command_buffer_ptr;
+            VkDeviceSize      draw_command_buffer_offset;
+
+            /* Buffer holding n_instances Instance items. Must have been created with STORAGE_BUFFER usage. */
+            Anvil::Buffer*    instance_buffer_ptr;
+            VkDeviceSize      instance_buffer_offset;
+
+            uint32_t          n_instances;
+            uint32_t          n_max_draws_per_stream;
+            uint32_t          n_streams;
+
+            /* Column-major view-projection matrix, with Vulkan clip space conventions. */
+            float             view_projection_matrix[16];
+
+            CullInfo()
+                :count_buffer_ptr            (nullptr),
+                 count_buffer_offset         (0),
+                 depth_pyramid_image_view_ptr(nullptr),
+                 depth_pyramid_height        (0),
+                 depth_pyramid_width         (0),
+                 draw_command_buffer_ptr     (nullptr),
+                 draw_command_buffer_offset  (0),
+                 instance_buffer_ptr         (nullptr),
+                 instance_buffer_offset      (0),
+                 n_instances                 (0),
+                 n_max_draws_per_stream      (0),
+                 n_streams                   (1)
+            {
+                /* Identity */
+                for (uint32_t n_element = 0;
+                              n_element < sizeof(view_projection_matrix) / sizeof(view_projection_matrix[0]);
+                            ++n_element)
+                {
+                    view_projection_matrix[n_element] = ((n_element % 5) == 0) ? 1.0f : 0.0f;
+                }
+            }
+        } CullInfo;
+
+        /* Public functions */
+
+        /** Creates a new indirect draw culler instance. Compiles the culling shaders and bakes the compute pipelines.
+         *
+         *  @param in_device_ptr Device to create the culler for. Must not be null.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::IndirectDrawCullerUniquePtr create(const Anvil::BaseDevice* in_device_ptr);
+
+        /** Destructor. The caller must make sure none of the recorded culling passes is still executed by the GPU. */
+        ~IndirectDrawCuller();
+
+        /** Returns the number of bytes needed to hold draw counts of the specified number of streams. */
+        static VkDeviceSize get_count_buffer_size(uint32_t in_n_streams)
+        {
+            return static_cast<VkDeviceSize>(in_n_streams) * sizeof(uint32_t);
+        }
+
+        /** Returns the number of bytes needed to hold draw command streams of the specified dimensions. */
+        static VkDeviceSize get_draw_command_buffer_size(uint32_t in_n_streams,
+                                                         uint32_t in_n_max_draws_per_stream)
+        {
+            return static_cast<VkDeviceSize>(in_n_streams) * in_n_max_draws_per_stream * sizeof(VkDrawIndexedIndirectCommand);
+        }
+
+        /** Records a culling pass. The pass resets the draw counts, dispatches the culling shader, and makes the written
+         *  draw commands and counts available to indirect draw commands.
+         *
+         *  The caller is responsible for making any earlier writes to the instance buffer (or the depth pyramid)
+         *  available to compute shaders. Must be called outside a renderpass.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the commands to. Must be in recording state and must
+         *                           support compute operations.
+         *  @param in_cull_info      Pass description.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_cull(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                         const CullInfo&           in_cull_info);
+
+        /** Records an indexed indirect draw of a stream written by a culling pass recorded with @param in_cull_info.
+         *  Must be called inside a renderpass, after a graphics pipeline, index buffer and vertex buffers have been bound.
+         *
+         *  Requires either VK_KHR_draw_indirect_count or VK_AMD_draw_indirect_count to be enabled for the device.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the command to. Must be in recording state.
+         *  @param in_cull_info      Description of the culling pass which has written the stream.
+         *  @param in_n_stream       Index of the stream to draw.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_draw_stream(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                const CullInfo&           in_cull_info,
+                                uint32_t                  in_n_stream) const;
+
+    private:
+        /* Private type definitions */
+        enum
+        {
+            VARIANT_FRUSTUM,
+            VARIANT_FRUSTUM_OCCLUSION,
+
+            VARIANT_COUNT
+        };
+
+        /* Matches the culling shader's push constant block */
+        typedef struct PushConstants
+        {
+            float    view_projection_matrix[16];
+            float    depth_pyramid_size[2];
+            uint32_t n_instances;
+            uint32_t n_max_draws_per_stream;
+            uint32_t n_streams;
+        } PushConstants;
+
+        typedef struct Variant
+        {
+            Anvil::DescriptorSetLayoutUniquePtr                 ds_layout_ptr;
+            std::unique_ptr<Anvil::ShaderModuleStageEntryPoint> entrypoint_ptr;
+            Anvil::PipelineID                                   pipeline_id;
+            Anvil::ShaderModuleUniquePtr                        shader_module_ptr;
+
+            Variant()
+                :pipeline_id(UINT32_MAX)
+            {
+                /* Stub */
+            }
+        } Variant;
+
+        /* Private functions */
+        IndirectDrawCuller(const Anvil::BaseDevice* in_device_ptr);
+
+        bool init        ();
+        bool init_variant(uint32_t in_n_variant);
+
+        /* Private variables */
+        const Anvil::BaseDevice*           m_device_ptr;
+        Anvil::DescriptorSetCacheUniquePtr m_ds_cache_ptr;
+        Anvil::SamplerUniquePtr            m_sampler_ptr;
+        Variant                            m_variants[VARIANT_COUNT];
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(IndirectDrawCuller);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(IndirectDrawCuller);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_INDIRECT_DRAW_CULLER_H */
@@ -93,6 +93,11 @@ namespace Anvil
             return m_engine_version;
         }
 
+        Anvil::HostAllocator* get_host_allocator() const
+        {
+            return m_host_allocator_ptr;
+        }
+
         /* Returns memory type index which should be used by Anvil when allocating memory. This value can be specified with set_n_memory_type_to_use_for_all_allocs().
          *
          * If UINT32_MAX is returned, Anvil will be free to use any memory type determined to be valid for particular memory allocations. This is the default behavior.
@@ -107,6 +112,38 @@ namespace Anvil
             return m_validation_callback;
         }
 
+        /** Returns IDs of validation messages which should be dropped before the validation callback is invoked. */
+        const std::vector<int32_t>& get_validation_filtered_message_ids() const
+        {
+            return m_validation_filtered_message_ids;
+        }
+
+        /** Returns severity of validation messages the implementation should report. */
+        const Anvil::DebugMessageSeverityFlags& get_validation_message_severity() const
+        {
+            return m_validation_message_severity;
+        }
+
+        /** Returns types of validation messages the implementation should report. */
+        const Anvil::DebugMessageTypeFlags& get_validation_message_types() const
+        {
+            return m_validation_message_types;
+        }
+
+        /** Returns validation message rate limit settings. Please see set_validation_rate_limit(). */
+        void get_validation_rate_limit(uint32_t* out_max_messages_per_id_ptr,
+                                       uint32_t* out_period_msec_ptr) const
+        {
+            *out_max_messages_per_id_ptr = m_validation_rate_limit_max_messages_per_id;
+            *out_period_msec_ptr         = m_validation_rate_limit_period_msec;
+        }
+
+        /** Tells if validation messages should be delivered from a background thread. */
+        bool is_validation_async_delivery_enabled() const
+        {
+            return m_validation_async_delivery_enabled;
+        }
+
         const bool& is_mt_safe() const
         {
             return m_is_mt_safe;
@@ -142,6 +179,19 @@ namespace Anvil
             m_engine_name = in_engine_name;
         }
 
+        /* Specifies a host allocator to route host memory allocations, which the driver makes for the instance and
+         * all instance-level objects created by Anvil, to. Devices use it too, unless DeviceCreateInfo::set_host_allocator()
+         * has been called. Please see misc/host_allocator.h for more details.
+         *
+         * By default, no allocator is specified and the driver uses its own.
+         *
+         * @param in_host_allocator_ptr Allocator to use. Must outlive the instance. May be null.
+         */
+        void set_host_allocator(Anvil::HostAllocator* in_host_allocator_ptr)
+        {
+            m_host_allocator_ptr = in_host_allocator_ptr;
+        }
+
         /* When called, any memory allocations performed by objects owned by Anvil Instance object created using this create info structure
          * will always use the specified memory type index.
          *
@@ -157,6 +207,42 @@ namespace Anvil
             m_validation_callback = in_validation_callback;
         }
 
+        /** Makes the validation callback get invoked from a background thread. Please see
+         *  DebugMessengerCreateInfo::set_async_delivery() for more details.
+         */
+        void set_validation_async_delivery(bool in_enable)
+        {
+            m_validation_async_delivery_enabled = in_enable;
+        }
+
+        /** Narrows the set of validation messages which reach the validation callback.
+         *
+         *  Severity & type flags are passed to the implementation at debug messenger creation time. By default,
+         *  errors, warnings and info messages of validation type are reported.
+         *
+         *  @param in_severity                 Severity of messages the implementation should report.
+         *  @param in_types                    Types of messages the implementation should report.
+         *  @param in_opt_filtered_message_ids IDs of messages which should be dropped before the callback is invoked.
+         */
+        void set_validation_message_filter(const Anvil::DebugMessageSeverityFlags& in_severity,
+                                           const Anvil::DebugMessageTypeFlags&     in_types,
+                                           const std::vector<int32_t>&             in_opt_filtered_message_ids = std::vector<int32_t>() )
+        {
+            m_validation_filtered_message_ids = in_opt_filtered_message_ids;
+            m_validation_message_severity     = in_severity;
+            m_validation_message_types        = in_types;
+        }
+
+        /** Limits how many validation messages with the same ID reach the validation callback. Please see
+         *  DebugMessengerCreateInfo::set_rate_limit() for more details.
+         */
+        void set_validation_rate_limit(uint32_t in_max_messages_per_id,
+                                       uint32_t in_period_msec)
+        {
+            m_validation_rate_limit_max_messages_per_id = in_max_messages_per_id;
+            m_validation_rate_limit_period_msec         = in_period_msec;
+        }
+
         void set_is_mt_safe(const bool& in_is_mt_safe)
         {
             m_is_mt_safe = in_is_mt_safe;
@@ -179,10 +265,18 @@ namespace Anvil
         std::vector<std::string>     m_disallowed_instance_level_extensions;
         std::string                  m_engine_name;
         uint32_t                     m_engine_version;
+        Anvil::HostAllocator*        m_host_allocator_ptr;
         bool                         m_is_mt_safe;
         uint32_t                     m_n_memory_type_to_use_for_all_alocs;
         Anvil::DebugCallbackFunction m_validation_callback;
 
+        bool                             m_validation_async_delivery_enabled;
+        std::vector<int32_t>             m_validation_filtered_message_ids;
+        Anvil::DebugMessageSeverityFlags m_validation_message_severity;
+        Anvil::DebugMessageTypeFlags     m_validation_message_types;
+        uint32_t                         m_validation_rate_limit_max_messages_per_id;
+        uint32_t                         m_validation_rate_limit_period_msec;
+
         ANVIL_DISABLE_ASSIGNMENT_OPERATOR(InstanceCreateInfo);
         ANVIL_DISABLE_COPY_CONSTRUCTOR(InstanceCreateInfo);
     };
@@ -28,6 +28,7 @@
 #include <vector>
 
 #include "config.h"
+#include "misc/types.h"
 
 #ifdef _WIN32
     #include <windows.h>
@@ -96,9 +97,35 @@ namespace Anvil
                                                  bool                      in_recursive,
                                                  std::vector<std::string>* out_result_ptr);
 
+        /** Retrieves the time the specified file has last been modified at.
+         *
+         *  @param in_filename               Name of the file to query.
+         *  @param out_modification_time_ptr Deref will be set to the modification time, expressed in seconds since
+         *                                   the epoch. Must not be nullptr.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        static bool get_file_modification_time(const std::string& in_filename,
+                                               uint64_t*          out_modification_time_ptr);
+
         /** Tells whether the specified path exists and is a directory. */
         static bool is_directory(const std::string& in_path);
 
+        /** Maps contents of the specified file into the process' address space for reading. Unlike read_file(),
+         *  no copy of the file contents is made. Pages are brought in by the OS on first access.
+         *
+         *  The mapping must be released with unmap_file() when no longer needed.
+         *
+         *  @param in_filename       Name of the file to map.
+         *  @param out_data_ptr_ptr  Deref will be set to the start of the mapped region. Must not be nullptr.
+         *  @param out_size_ptr      Deref will be set to the size of the mapped region. Must not be nullptr.
+         *
+         *  @return true if successful, false otherwise. Empty files cannot be mapped.
+         **/
+        static bool map_file(const std::string& in_filename,
+                             const void**       out_data_ptr_ptr,
+                             size_t*            out_size_ptr);
+
         /** Loads file contents and returns a buffer holding the read data.
          *
          *  Upon failure, the function generates an assertion failure.
@@ -125,6 +152,14 @@ namespace Anvil
                               size_t      in_size,
                               char**      out_result_ptr);
 
+        /** Releases a mapping created with map_file().
+         *
+         *  @param in_data_ptr Start of the mapped region, as returned by map_file().
+         *  @param in_size     Size of the mapped region, as returned by map_file().
+         **/
+        static void unmap_file(const void* in_data_ptr,
+                               size_t      in_size);
+
         /** Writes specified data to a file under specified location. If a file exists under
          *  given location, its contents is discarded.
          *
@@ -144,6 +179,57 @@ namespace Anvil
                                       std::string  in_contents,
                                       bool         in_should_append = false);
     };
+
+    /** RAII wrapper for a read-only file mapping, as created by IO::map_file(). The mapping is released when
+     *  the instance goes out of scope.
+     *
+     *  The mapping is lazy: pages are brought in by the OS on first access. Call prefetch() to page the whole
+     *  file in up-front, for instance from a worker thread.
+     */
+    class MappedFile
+    {
+    public:
+        /* Public functions */
+
+        /** Maps the specified file.
+         *
+         *  @param in_filename Name of the file to map.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::MappedFileUniquePtr create(const std::string& in_filename);
+
+        /** Destructor. Releases the file mapping. */
+        ~MappedFile();
+
+        /** Returns the start of the mapped region. */
+        const void* get_data_ptr() const
+        {
+            return m_data_ptr;
+        }
+
+        /** Returns the size of the mapped region. */
+        size_t get_size() const
+        {
+            return m_size;
+        }
+
+        /** Touches every page of the mapping, so that the file contents is read into memory before the
+         *  function returns. */
+        void prefetch() const;
+
+    private:
+        /* Private functions */
+        MappedFile(const void* in_data_ptr,
+                   size_t      in_size);
+
+        /* Private variables */
+        const void* m_data_ptr;
+        size_t      m_size;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(MappedFile);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(MappedFile);
+    };
 }
 
 #endif /* MISC_FILE_H */
\ No newline at end of file
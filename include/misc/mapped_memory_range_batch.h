@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Batches flush & invalidate requests for host-mapped, non-coherent memory.
+ *
+ *  MemoryBlock::write() and MemoryBlock::read() flush or invalidate the touched range on every call. Apps which update
+ *  many small ranges per frame can instead write directly into mapped pointers (see MemoryBlock::map() and
+ *  MemoryBlockCreateInfo::set_persistently_mapped()), register the touched ranges with add_range_to_flush(), and then
+ *  call flush() once. Ranges are expanded to non_coherent_atom_size boundaries, overlapping and adjacent ranges within
+ *  the same VkDeviceMemory are merged, and a single vkFlushMappedMemoryRanges() call is issued for all of them.
+ *
+ *  Invalidation works the same way, with add_range_to_invalidate() and invalidate().
+ *
+ *  Ranges of memory blocks which are host-coherent are ignored. Memory blocks must stay mapped, and alive, until
+ *  the ranges registered for them have been flushed or invalidated.
+ *
+ *  Batch instances are NOT thread-safe.
+ */
+#ifndef MISC_MAPPED_MEMORY_RANGE_BATCH_H
+#define MISC_MAPPED_MEMORY_RANGE_BATCH_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class MappedMemoryRangeBatch
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new batch instance.
+         *
+         *  @param in_device_ptr Device which owns all memory blocks whose ranges are going to be registered with the batch.
+         *                       Must not be null.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::MappedMemoryRangeBatchUniquePtr create(const Anvil::BaseDevice* in_device_ptr);
+
+        /** Destructor. Pending ranges are discarded. */
+        ~MappedMemoryRangeBatch();
+
+        /** Registers a range of @param in_memory_block_ptr which has been written to by the host, and needs to be flushed
+         *  before the device reads it.
+         *
+         *  @param in_memory_block_ptr Memory block the range belongs to. Must not be null.
+         *  @param in_start_offset     Start offset of the range, relative to the memory block's start.
+         *  @param in_size             Size of the range. Must not be 0.
+         */
+        void add_range_to_flush(Anvil::MemoryBlock* in_memory_block_ptr,
+                                VkDeviceSize        in_start_offset,
+                                VkDeviceSize        in_size);
+
+        /** Registers a range of @param in_memory_block_ptr which has been written to by the device, and needs to be
+         *  invalidated before the host reads it.
+         *
+         *  Arguments as per add_range_to_flush().
+         */
+        void add_range_to_invalidate(Anvil::MemoryBlock* in_memory_block_ptr,
+                                     VkDeviceSize        in_start_offset,
+                                     VkDeviceSize        in_size);
+
+        /** Flushes all ranges registered with add_range_to_flush() with a single vkFlushMappedMemoryRanges() call, and
+         *  clears the list.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool flush();
+
+        /** Returns the number of ranges pending a flush, before merging. */
+        uint32_t get_n_ranges_to_flush() const
+        {
+            return static_cast<uint32_t>(m_ranges_to_flush.size() );
+        }
+
+        /** Returns the number of ranges pending an invalidation, before merging. */
+        uint32_t get_n_ranges_to_invalidate() const
+        {
+            return static_cast<uint32_t>(m_ranges_to_invalidate.size() );
+        }
+
+        /** Invalidates all ranges registered with add_range_to_invalidate() with a single vkInvalidateMappedMemoryRanges()
+         *  call, and clears the list.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool invalidate();
+
+    private:
+        /* Private type definitions */
+        typedef struct Range
+        {
+            VkDeviceSize   end_offset;   /* Relative to the start of memory */
+            VkDeviceMemory memory;
+            VkDeviceSize   start_offset; /* Relative to the start of memory */
+
+            Range(VkDeviceMemory in_memory,
+                  VkDeviceSize   in_start_offset,
+                  VkDeviceSize   in_end_offset)
+                :end_offset  (in_end_offset),
+                 memory      (in_memory),
+                 start_offset(in_start_offset)
+            {
+                /* Stub */
+            }
+
+            bool operator<(const Range& in_range) const
+            {
+                if (memory != in_range.memory)
+                {
+                    return (memory < in_range.memory);
+                }
+
+                return (start_offset < in_range.start_offset);
+            }
+        } Range;
+
+        /* Private functions */
+        MappedMemoryRangeBatch(const Anvil::BaseDevice* in_device_ptr);
+
+        void add_range    (Anvil::MemoryBlock*               in_memory_block_ptr,
+                           VkDeviceSize                      in_start_offset,
+                           VkDeviceSize                      in_size,
+                           std::vector<Range>*               inout_ranges_ptr);
+        void merge_ranges (std::vector<Range>*               inout_ranges_ptr,
+                           std::vector<VkMappedMemoryRange>* out_vk_ranges_ptr) const;
+
+        /* Private variables */
+        const Anvil::BaseDevice*         m_device_ptr;
+        VkDeviceSize                     m_non_coherent_atom_size;
+        std::vector<Range>               m_ranges_to_flush;
+        std::vector<Range>               m_ranges_to_invalidate;
+        std::vector<VkMappedMemoryRange> m_vk_ranges;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(MappedMemoryRangeBatch);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(MappedMemoryRangeBatch);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_MAPPED_MEMORY_RANGE_BATCH_H */
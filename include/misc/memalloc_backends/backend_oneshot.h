@@ -23,7 +23,9 @@
  * registered objects. At baking time, non-overlapping regions of memory storage are distributed to the objects,
  * with respect to object-specific alignment requirements.
  *
- * The allocator can only handle one bake request throughout its life-time.
+ * The allocator can handle any number of bake requests. Non-dedicated items baked by subsequent requests are packed
+ * into the unused tail of previously allocated memory blocks first. Only the items which do not fit get a new block.
+ * Memory regions are never returned to the blocks they were carved out of.
  *
  * This class should only be used internally by MemoryAllocator.
  **/
@@ -51,34 +53,91 @@ namespace Anvil
              *
              *  Should only be used internally by MemoryAllocator.
              *
-             *  @param in_device_ptr Vulkan device the memory allocations are going to be made for.
+             *  @param in_device_ptr     Vulkan device the memory allocations are going to be made for.
+             *  @param in_min_block_size Minimum size of memory blocks to allocate for non-dedicated items.
              **/
-            OneShot(const Anvil::BaseDevice* in_device_ptr);
+            OneShot(const Anvil::BaseDevice* in_device_ptr,
+                    VkDeviceSize             in_min_block_size = 0);
 
             /** Destructor. */
             virtual ~OneShot();
 
         private:
+            /* Private type definitions */
+
+            /* Memory block shared by non-dedicated items. Regions are carved out of the block in a linear fashion. */
+            typedef struct SharedBlock
+            {
+                uint32_t             device_mask;
+                bool                 is_last_item_linear;
+                MemoryBlockUniquePtr memory_block_ptr;
+                float                memory_priority;
+                uint32_t             n_memory_type;
+                VkDeviceSize         size;
+                VkDeviceSize         used_size;
+
+                SharedBlock(MemoryBlockUniquePtr in_memory_block_ptr,
+                            uint32_t             in_n_memory_type,
+                            uint32_t             in_device_mask,
+                            float                in_memory_priority,
+                            VkDeviceSize         in_size,
+                            VkDeviceSize         in_used_size,
+                            bool                 in_is_last_item_linear)
+                    :device_mask        (in_device_mask),
+                     is_last_item_linear(in_is_last_item_linear),
+                     memory_block_ptr   (std::move(in_memory_block_ptr) ),
+                     memory_priority    (in_memory_priority),
+                     n_memory_type      (in_n_memory_type),
+                     size               (in_size),
+                     used_size          (in_used_size)
+                {
+                    /* Stub */
+                }
+            } SharedBlock;
+
             /* IMemoryAllocatorBackend functions */
 
             bool     bake                            (Anvil::MemoryAllocator::Items&              in_items) final;
+            bool     defragment                      (const std::vector<void*>&                                in_backend_objects,
+                                                      uint32_t                                                 in_n_max_moves,
+                                                      std::vector<Anvil::MemoryAllocator::MovedBackendObject>* out_moved_objects_ptr,
+                                                      Anvil::MemoryAllocator::DefragmentationStats*            inout_stats_ptr,
+                                                      bool*                                                    out_is_complete_ptr) final;
+            void     get_json_dump                   (std::string*                                out_json_ptr)  const final;
+            uint32_t get_n_pools                     ()                                                                            const final;
+            void     get_stats                       (Anvil::MemoryAllocator::Stats*              out_stats_ptr) const final;
             VkResult map                             (void*                                       in_memory_object,
                                                       VkDeviceSize                                in_start_offset,
                                                       VkDeviceSize                                in_memory_block_start_offset,
                                                       VkDeviceSize                                in_size,
                                                       void**                                      out_result_ptr) final;
             bool     supports_baking                 () const final;
+            bool     supports_concurrent_bakes       ()                                                                            const final;
             bool     supports_external_memory_handles(const Anvil::ExternalMemoryHandleTypeFlags& in_external_memory_handle_types) const final;
+            bool     supports_defragmentation        ()                                                                            const final;
             bool     supports_device_masks           ()                                                                            const final;
             bool     supports_protected_memory       ()                                                                            const final;
             void     unmap                           (void*                                       in_memory_object) final;
 
             /* Private functions */
 
+            bool assign_derived_memory_block(Anvil::MemoryAllocator::Item* in_item_ptr,
+                                             Anvil::MemoryBlock*           in_parent_memory_block_ptr,
+                                             VkDeviceSize                  in_start_offset);
+            bool is_item_linear             (const Anvil::MemoryAllocator::Item* in_item_ptr) const;
+            bool prefers_dedicated_alloc    (const Anvil::MemoryAllocator::Item* in_item_ptr) const;
+
             /* Private variables */
-            const Anvil::BaseDevice*          m_device_ptr;
-            bool                              m_is_baked;
-            std::vector<MemoryBlockUniquePtr> m_memory_blocks;
+            const Anvil::BaseDevice*                      m_device_ptr;
+            std::vector<MemoryBlockUniquePtr>             m_memory_blocks;
+            std::array<VkDeviceSize, VK_MAX_MEMORY_TYPES> m_memory_type_n_bytes_allocated;
+            std::array<VkDeviceSize, VK_MAX_MEMORY_TYPES> m_memory_type_n_bytes_used;
+            const VkDeviceSize                            m_min_block_size;
+            uint32_t                                      m_n_allocations;
+            uint32_t                                      m_n_dedicated_allocations;
+            VkDeviceSize                                  m_n_bytes_allocated;
+            VkDeviceSize                                  m_n_bytes_used;
+            std::vector<SharedBlock>                      m_shared_blocks;
         };
     };
 };
@@ -31,6 +31,9 @@
 #include "misc/types.h"
 #include "misc/memory_allocator.h"
 #include "VulkanMemoryAllocator/vk_mem_alloc.h"
+#include <atomic>
+#include <list>
+#include <mutex>
 
 
 namespace Anvil
@@ -52,8 +55,10 @@ namespace Anvil
              *  Should only be used internally by MemoryAllocator.
              *
              *  @param in_device_ptr Vulkan device the memory allocations are going to be made for.
+             *  @param in_pools      Custom memory pools to create. See MemoryAllocator::create_vma().
              **/
-            static std::unique_ptr<VMA> create(const Anvil::BaseDevice* in_device_ptr);
+            static std::unique_ptr<VMA> create(const Anvil::BaseDevice*                                      in_device_ptr,
+                                               const std::vector<Anvil::MemoryAllocator::VMAPoolCreateInfo>& in_pools);
 
             /** Destructor. */
             virtual ~VMA();
@@ -111,26 +116,100 @@ namespace Anvil
                 /* Private variables */
                 VmaAllocator                        m_allocator;
                 const Anvil::BaseDevice*            m_device_ptr;
+                bool                                m_uses_device_address_shim;
                 std::unique_ptr<VmaVulkanFunctions> m_vma_func_ptrs;
 
                 std::vector<std::shared_ptr<VMAAllocator> > m_refcount_helper;
+                std::mutex                                  m_refcount_helper_mutex;
             };
 
+            /* Region of a LINEAR or RING_BUFFER pool block, assigned to a single item. */
+            typedef struct PoolRegion
+            {
+                VkDeviceSize end_offset;
+                bool         is_released;
+                VkDeviceSize start_offset;
+
+                PoolRegion(VkDeviceSize in_start_offset,
+                           VkDeviceSize in_end_offset)
+                    :end_offset  (in_end_offset),
+                     is_released (false),
+                     start_offset(in_start_offset)
+                {
+                    /* Stub */
+                }
+            } PoolRegion;
+
+            /* Device memory allocation made for a LINEAR or RING_BUFFER pool. Regions are carved out of it by the backend. */
+            typedef struct PoolBlock
+            {
+                VmaAllocation               allocation;
+                Anvil::MemoryBlockUniquePtr memory_block_ptr;
+                std::list<PoolRegion>       regions; /* Live regions, in allocation order */
+
+                PoolBlock()
+                    :allocation      (VK_NULL_HANDLE),
+                     memory_block_ptr(nullptr,
+                                      std::default_delete<Anvil::MemoryBlock>() )
+                {
+                    /* Stub */
+                }
+            } PoolBlock;
+
+            typedef struct Pool
+            {
+                std::vector<std::unique_ptr<PoolBlock> >  blocks; /* Only used by LINEAR and RING_BUFFER pools */
+                Anvil::MemoryAllocator::VMAPoolCreateInfo create_info;
+                std::mutex                                mutex;
+                VmaPool                                   pool;
+
+                Pool(const Anvil::MemoryAllocator::VMAPoolCreateInfo& in_create_info)
+                    :create_info(in_create_info),
+                     pool       (VK_NULL_HANDLE)
+                {
+                    /* Stub */
+                }
+            } Pool;
+
             /* Private functions */
 
             VMA(const Anvil::BaseDevice* in_device_ptr);
 
-            bool init();
+            bool bake_pool_item         (Pool*                                                         in_pool_ptr,
+                                         Anvil::MemoryAllocator::Item*                                 in_item_ptr);
+            bool create_pool_block      (Pool*                                                         in_pool_ptr,
+                                         bool                                                          in_persistently_mapped,
+                                         PoolBlock**                                                   out_block_ptr_ptr);
+            bool find_pool_region       (const Pool*                                                   in_pool_ptr,
+                                         const PoolBlock*                                              in_block_ptr,
+                                         VkDeviceSize                                                  in_size,
+                                         VkDeviceSize                                                  in_alignment,
+                                         VkDeviceSize*                                                 out_start_offset_ptr) const;
+            bool init                   (const std::vector<Anvil::MemoryAllocator::VMAPoolCreateInfo>& in_pools);
+            void on_pool_region_released(Pool*                                                         in_pool_ptr,
+                                         PoolBlock*                                                    in_block_ptr,
+                                         std::list<PoolRegion>::iterator                               in_region_iterator,
+                                         Anvil::MemoryBlock*                                           in_memory_block_ptr);
 
             /* IMemoryAllocatorBackend functions */
 
             bool     bake                            (Anvil::MemoryAllocator::Items&              in_items) final;
+            bool     defragment                      (const std::vector<void*>&                                in_backend_objects,
+                                                      uint32_t                                                 in_n_max_moves,
+                                                      std::vector<Anvil::MemoryAllocator::MovedBackendObject>* out_moved_objects_ptr,
+                                                      Anvil::MemoryAllocator::DefragmentationStats*            inout_stats_ptr,
+                                                      bool*                                                    out_is_complete_ptr) final;
+            void     get_json_dump                   (std::string*                                out_json_ptr)  const final;
+            uint32_t get_n_pools                     ()                                                                            const final;
+            void     get_stats                       (Anvil::MemoryAllocator::Stats*              out_stats_ptr) const final;
             VkResult map                             (void*                                       in_memory_object,
                                                       VkDeviceSize                                in_start_offset,
                                                       VkDeviceSize                                in_memory_block_start_offset,
                                                       VkDeviceSize                                in_size,
                                                       void**                                      out_result_ptr);
             bool     supports_baking                 () const final;
+            bool     supports_concurrent_bakes       ()                                                                            const final;
+            bool     supports_defragmentation        ()                                                                            const final;
             bool     supports_device_masks           ()                                                                            const final;
             bool     supports_external_memory_handles(const Anvil::ExternalMemoryHandleTypeFlags& in_external_memory_handle_types) const final;
             bool     supports_protected_memory       ()                                                                            const final;
@@ -138,7 +217,10 @@ namespace Anvil
 
             /* Private variables */
             const Anvil::BaseDevice*            m_device_ptr;
+            std::atomic<uint32_t>               m_n_dedicated_allocations;
             std::shared_ptr<VMAAllocator>       m_vma_allocator_ptr;
+
+            std::vector<std::unique_ptr<Pool> > m_pools;
         };
     };
 };
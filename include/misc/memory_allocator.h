@@ -24,7 +24,8 @@
  * objects. At baking time, non-overlapping regions of memory storage are distributed to the objects,
  * respect to object-specific alignment requirements.
  *
- * MT-safe at an opt-in basis.
+ * MT-safe at an opt-in basis. If enabled, objects can be registered from multiple threads at the same
+ * time. Each thread adds its objects to a separate list, and the lists are merged at baking time.
  **/
 #ifndef MISC_MEMORY_ALLOCATOR_H
 #define MISC_MEMORY_ALLOCATOR_H
@@ -32,6 +33,7 @@
 #include "misc/debug.h"
 #include "misc/mt_safety.h"
 #include "misc/types.h"
+#include <array>
 #include <functional>
 #include <vector>
 #include <cfloat>
@@ -41,6 +43,13 @@ namespace Anvil
     typedef std::pair<uint32_t, uint32_t>                                            LocalRemoteDeviceIndexPair;
     typedef std::pair<uint32_t, uint32_t>                                            ResourceMemoryDeviceIndexPair;
     typedef std::function<void (Anvil::MemoryAllocator*) >                           MemoryAllocatorBakeCallbackFunction;
+    typedef std::function<void (Anvil::Buffer* in_buffer_ptr,
+                                void*          out_data_ptr,
+                                VkDeviceSize   in_size) >                            MemoryAllocatorBufferFillCallbackFunction;
+    typedef std::function<void (Anvil::MemoryAllocator*,
+                                uint32_t     in_n_heap,
+                                VkDeviceSize in_n_bytes_used,
+                                VkDeviceSize in_n_bytes_budget) >                    MemoryAllocatorLowMemoryCallbackFunction;
     typedef std::function<void (Anvil::Buffer*,       Anvil::MemoryBlockUniquePtr) > MemoryAllocatorPostBakePerNonSparseBufferItemMemAssignmentCallback;
     typedef std::function<void (Anvil::Image*,        Anvil::MemoryBlockUniquePtr) > MemoryAllocatorPostBakePerNonSparseImageItemMemAssignmentCallback;
     typedef std::map<LocalRemoteDeviceIndexPair, Anvil::PeerMemoryFeatureFlags>      MGPUPeerMemoryRequirements;
@@ -63,6 +72,9 @@ namespace Anvil
         typedef struct Item
         {
             Anvil::Buffer*                                                                        buffer_ptr;
+            std::string                                                                           buffer_ref_file_name;
+            size_t                                                                                buffer_ref_file_start_offset;
+            MemoryAllocatorBufferFillCallbackFunction                                             buffer_ref_fill_callback_function;
             std::unique_ptr<float[]>                                                              buffer_ref_float_data_ptr;
             std::unique_ptr<std::vector<float>, std::function<void (std::vector<float>*)> >       buffer_ref_float_vector_data_ptr;
             std::unique_ptr<uint8_t[]>                                                            buffer_ref_uchar8_data_ptr;
@@ -96,6 +108,9 @@ namespace Anvil
             VkDeviceSize                         alloc_size;
             float                                memory_priority;
 
+            uint32_t alias_first_use; /* UINT32_MAX if the item is not aliased */
+            uint32_t alias_last_use;
+
             VkExtent3D              extent;
             bool                    is_baked;
             VkDeviceSize            miptail_offset;
@@ -104,6 +119,14 @@ namespace Anvil
             VkOffset3D              offset;
             Anvil::ImageSubresource subresource;
 
+            /* Peer view of the item, bound to the same memory block with peer_view_device_indices at bake time.
+             * Null if the item has not been added with add_peer_accessible_buffer() or add_peer_accessible_image(). */
+            Anvil::Buffer*          peer_view_buffer_ptr;
+            std::vector<uint32_t>   peer_view_device_indices;
+            Anvil::Image*           peer_view_image_ptr;
+
+            VMAPoolID pool_id; /* UINT32_MAX if the item is not placed in a custom VMA pool */
+
             Item(Anvil::MemoryAllocator*                     in_memory_allocator_ptr,
                  Anvil::Buffer*                              in_buffer_ptr,
                  VkDeviceSize                                in_alloc_size,
@@ -213,6 +236,121 @@ namespace Anvil
 
         typedef std::vector<std::unique_ptr<Item> > Items;
 
+        /* Statistics of the work done by defragment(). */
+        typedef struct DefragmentationStats
+        {
+            uint32_t     n_allocations_moved;   /* Number of memory regions moved to a different location   */
+            VkDeviceSize n_bytes_freed;         /* Total size of device memory allocations released         */
+            VkDeviceSize n_bytes_moved;         /* Total number of bytes copied                             */
+            uint32_t     n_memory_blocks_freed; /* Number of device memory allocations released             */
+
+            DefragmentationStats()
+                :n_allocations_moved  (0),
+                 n_bytes_freed        (0),
+                 n_bytes_moved        (0),
+                 n_memory_blocks_freed(0)
+            {
+                /* Stub */
+            }
+        } DefragmentationStats;
+
+        /* Describes the new location of a memory region moved by a backend's defragment() implementation. */
+        typedef struct MovedBackendObject
+        {
+            VkDeviceMemory memory;
+            uint32_t       n_backend_object; /* Index of the backend object passed to defragment() */
+            VkDeviceSize   start_offset;
+
+            MovedBackendObject(uint32_t       in_n_backend_object,
+                               VkDeviceMemory in_memory,
+                               VkDeviceSize   in_start_offset)
+                :memory          (in_memory),
+                 n_backend_object(in_n_backend_object),
+                 start_offset    (in_start_offset)
+            {
+                /* Stub */
+            }
+        } MovedBackendObject;
+
+        /* Describes memory assigned to a single object, as reported by get_item_assignments(). */
+        typedef struct ItemAssignment
+        {
+            VkDeviceMemory memory;            /* Device memory object backing the item                              */
+            uint32_t       memory_type_index; /* Index of the memory type the backing memory was allocated from     */
+            std::string    name;              /* Debug name of the buffer or image at bake time. May be empty       */
+            VkDeviceSize   size;              /* Size of the region assigned to the item                            */
+            VkDeviceSize   start_offset;      /* Start offset of the region, relative to the start of @param memory */
+            ItemType       type;
+
+            ItemAssignment()
+                :memory           (VK_NULL_HANDLE),
+                 memory_type_index(UINT32_MAX),
+                 size             (0),
+                 start_offset     (0),
+                 type             (ITEM_TYPE_BUFFER)
+            {
+                /* Stub */
+            }
+        } ItemAssignment;
+
+        /* Memory usage statistics, as reported by get_stats(). */
+        typedef struct Stats
+        {
+            uint32_t     n_allocations;             /* Number of memory regions handed out to objects                       */
+            uint32_t     n_dedicated_allocations;   /* Number of regions which have been given a dedicated memory allocation */
+            VkDeviceSize n_bytes_allocated;         /* Total size of all device memory allocations made by the backend      */
+            VkDeviceSize n_bytes_saved_by_aliasing; /* Total size of aliased regions, minus the size of memory backing them */
+            VkDeviceSize n_bytes_used;              /* Total size of all memory regions handed out to objects               */
+            VkDeviceSize n_bytes_wasted;            /* n_bytes_allocated - n_bytes_used (alignment padding & free slack)     */
+            uint32_t     n_memory_blocks;           /* Number of device memory allocations made by the backend              */
+            VkDeviceSize largest_free_range;        /* Size of the largest unused range within backend memory blocks        */
+
+            std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> heap_n_bytes_allocated;         /* n_bytes_allocated, per memory heap  */
+            std::array<VkDeviceSize, VK_MAX_MEMORY_TYPES> memory_type_largest_free_range; /* largest_free_range, per memory type */
+            std::array<VkDeviceSize, VK_MAX_MEMORY_TYPES> memory_type_n_bytes_allocated;  /* n_bytes_allocated, per memory type  */
+            std::array<VkDeviceSize, VK_MAX_MEMORY_TYPES> memory_type_n_bytes_used;       /* n_bytes_used, per memory type       */
+            std::array<uint32_t,     VK_MAX_MEMORY_TYPES> memory_type_n_memory_blocks;    /* n_memory_blocks, per memory type    */
+
+            Stats()
+                :n_allocations            (0),
+                 n_dedicated_allocations  (0),
+                 n_bytes_allocated        (0),
+                 n_bytes_saved_by_aliasing(0),
+                 n_bytes_used             (0),
+                 n_bytes_wasted           (0),
+                 n_memory_blocks          (0),
+                 largest_free_range       (0)
+            {
+                heap_n_bytes_allocated.fill        (0);
+                memory_type_largest_free_range.fill(0);
+                memory_type_n_bytes_allocated.fill (0);
+                memory_type_n_bytes_used.fill      (0);
+                memory_type_n_memory_blocks.fill   (0);
+            }
+        } Stats;
+
+        /* Describes a custom memory pool of a VMA memory allocator. See create_vma(). */
+        typedef struct VMAPoolCreateInfo
+        {
+            VMAPoolAlgorithm algorithm;
+            VkDeviceSize     block_size;        /* Size of device memory allocations made for the pool. 0 lets VMA decide. Must not be 0 for LINEAR and RING_BUFFER pools */
+            uint32_t         max_n_blocks;      /* Maximum number of blocks the pool may allocate. 0 means no limit. Ignored for RING_BUFFER pools, which use a single block */
+            uint32_t         memory_type_index; /* Index of the memory type to allocate the pool's memory from                                                              */
+            uint32_t         min_n_blocks;      /* Number of blocks allocated at creation time, which are kept around even when empty                                       */
+
+            VMAPoolCreateInfo(uint32_t         in_memory_type_index,
+                              VkDeviceSize     in_block_size,
+                              VMAPoolAlgorithm in_algorithm = VMAPoolAlgorithm::DEFAULT)
+                :algorithm        (in_algorithm),
+                 block_size       (in_block_size),
+                 max_n_blocks     (0),
+                 memory_type_index(in_memory_type_index),
+                 min_n_blocks     (0)
+            {
+                /* Stub */
+            }
+        } VMAPoolCreateInfo;
+
         class IMemoryAllocatorBackend : public IMemoryAllocatorBackendBase
         {
         public:
@@ -221,14 +359,64 @@ namespace Anvil
                 /* Stub */
             }
 
-            virtual bool bake                            (Items&                                      in_items)                              = 0;
-            virtual bool supports_device_masks           ()                                                                            const = 0;
-            virtual bool supports_external_memory_handles(const Anvil::ExternalMemoryHandleTypeFlags& in_external_memory_handle_types) const = 0;
-            virtual bool supports_protected_memory       ()                                                                            const = 0;
+            virtual bool     bake                            (Items&                                      in_items)                              = 0;
+            virtual bool     defragment                      (const std::vector<void*>&                   in_backend_objects,
+                                                              uint32_t                                    in_n_max_moves,
+                                                              std::vector<MovedBackendObject>*            out_moved_objects_ptr,
+                                                              DefragmentationStats*                       inout_stats_ptr,
+                                                              bool*                                       out_is_complete_ptr)                   = 0;
+            virtual uint32_t get_n_pools                     ()                                                                            const = 0;
+            virtual void     get_stats                       (Stats*                                      out_stats_ptr)                   const = 0;
+            virtual void     get_json_dump                   (std::string*                                out_json_ptr)                    const = 0;
+            virtual bool     supports_concurrent_bakes       ()                                                                            const = 0;
+            virtual bool     supports_defragmentation        ()                                                                            const = 0;
+            virtual bool     supports_device_masks           ()                                                                            const = 0;
+            virtual bool     supports_external_memory_handles(const Anvil::ExternalMemoryHandleTypeFlags& in_external_memory_handle_types) const = 0;
+            virtual bool     supports_protected_memory       ()                                                                            const = 0;
         };
 
         /* Public functions */
 
+        /** Adds a new non-sparse Buffer or Image object whose memory may be shared with other aliased objects
+         *  registered for the same bake.
+         *
+         *  The app declares the object's lifetime as an inclusive range of abstract time points, e.g. indices
+         *  of the render passes which access the object. At bake time, aliased objects whose lifetimes do not
+         *  overlap are placed in overlapping regions of a single memory block per memory type. This is mostly
+         *  useful for transient render targets and scratch buffers of a frame graph.
+         *
+         *  Objects sharing memory do not preserve each other's contents. At the first use, contents of an aliased
+         *  object are undefined, images must be transitioned from UNDEFINED layout, and the app must make sure
+         *  that accesses to the previous user of the region have completed, e.g. with a memory barrier.
+         *
+         *  Objects which require a dedicated allocation are allocated as if added with add_buffer() or
+         *  add_image_whole(), without aliasing.
+         *
+         *  @param in_buffer_ptr / in_image_ptr Object to configure storage for at bake() call time. Must not be null.
+         *                                      Must not be sparse or use external memory handles.
+         *  @param in_first_use                 First time point the object is used at.
+         *  @param in_last_use                  Last time point the object is used at. Must not be smaller than
+         *                                      @param in_first_use and must not be UINT32_MAX.
+         *  @param in_required_memory_features  Memory features the assigned memory must support. Must not include
+         *                                      MAPPABLE_BIT.
+         *  @param in_opt_device_mask_ptr       As per add_buffer().
+         *  @param in_opt_memory_priority       As per add_buffer().
+         *
+         *  @return true if the object has been successfully scheduled for baking, false otherwise.
+         **/
+        bool add_aliased_buffer(Anvil::Buffer*     in_buffer_ptr,
+                                uint32_t           in_first_use,
+                                uint32_t           in_last_use,
+                                MemoryFeatureFlags in_required_memory_features = Anvil::MemoryFeatureFlagBits::NONE,
+                                const uint32_t*    in_opt_device_mask_ptr      = nullptr,
+                                const float&       in_opt_memory_priority      = FLT_MAX);
+        bool add_aliased_image (Anvil::Image*      in_image_ptr,
+                                uint32_t           in_first_use,
+                                uint32_t           in_last_use,
+                                MemoryFeatureFlags in_required_memory_features = Anvil::MemoryFeatureFlagBits::NONE,
+                                const uint32_t*    in_opt_device_mask_ptr      = nullptr,
+                                const float&       in_opt_memory_priority      = FLT_MAX);
+
         /** Adds a new Buffer object which should use storage coming from the buffer memory
          *  maintained by the Memory Allocator.
          *
@@ -240,6 +428,16 @@ namespace Anvil
          *  @param in_data_vector_ptr                         The buffer will be filled with data extracted from the specified
          *                                                    vector. Total number of bytes defined in the vector must match
          *                                                    buffer size.
+         *  @param in_fill_callback_function                  Called at bake() time with a pointer to buffer-sized storage, which the
+         *                                                    function should fill with buffer contents. If the buffer ends up in
+         *                                                    host-coherent mappable memory, the pointer points directly at the mapped
+         *                                                    buffer memory. Otherwise, it points at temporary host storage, which is
+         *                                                    then uploaded with Buffer::write(). Must not be null.
+         *  @param in_filename                                The buffer will be filled with @param in_file_start_offset onward contents
+         *                                                    of the specified file at bake() time. The file is mapped with MappedFile,
+         *                                                    so no intermediate copy of its contents is made. The file must hold at
+         *                                                    least buffer size bytes past @param in_file_start_offset.
+         *  @param in_file_start_offset                       See @param in_filename.
          *  @param in_required_memory_features                Memory features the assigned memory must support.
          *                                                    See MemoryFeatureFlagBits for more details.
          *  @param in_opt_external_nt_handle_info_ptr         TODO. Pointer must remain valid till baking time.
@@ -252,7 +450,12 @@ namespace Anvil
          *                                                    resource index to a memory allocation instance on the device with memory index. If null or empty, the binding will work
          *                                                    as if both indices were zero.
          *  @param in_opt_memory_priority                     Memory priority to use for the allocation. Valid values must be within range [0.0f, 1.0f].
-         *                                                    Ignored if VK_EXT_memory_priority is unavailable or if VMA backend is used or if FLT_MAX is passed.
+         *                                                    Ignored if VK_EXT_memory_priority is unavailable or if FLT_MAX is passed. VMA backend
+         *                                                    only honours it if VK_EXT_pageable_device_local_memory is enabled.
+         *  @param in_opt_pool_id                             (add_buffer() only) If not UINT32_MAX, ID of the custom VMA pool to place the buffer in.
+         *                                                    See create_vma(). The pool's memory type must be supported by the buffer and meet
+         *                                                    @param in_required_memory_features. Buffers which require a dedicated allocation
+         *                                                    are not placed in the pool. Memory priority is not applied to pooled buffers.
          *
          *  @return true if the buffer has been successfully scheduled for baking, false otherwise.
          **/
@@ -261,6 +464,30 @@ namespace Anvil
                                                                     const Anvil::ExternalMemoryHandleTypeFlags&  in_opt_exportable_external_handle_types    = Anvil::ExternalMemoryHandleTypeFlagBits::NONE,
         #if defined(_WIN32)
                                                                     const Anvil::ExternalNTHandleInfo*           in_opt_external_nt_handle_info_ptr         = nullptr,
+        #endif
+                                                                    const uint32_t*                              in_opt_device_mask_ptr                     = nullptr,
+                                                                    const MGPUPeerMemoryRequirements*            in_opt_mgpu_peer_memory_reqs_ptr           = nullptr,
+                                                                    const MGPUBindSparseDeviceIndices*           in_opt_mgpu_bind_sparse_device_indices_ptr = nullptr,
+                                                                    const float&                                 in_opt_memory_priority                     = FLT_MAX,
+                                                                    const VMAPoolID&                             in_opt_pool_id                             = UINT32_MAX);
+        bool add_buffer_with_callback_based_post_fill              (Anvil::Buffer*                               in_buffer_ptr,
+                                                                    MemoryAllocatorBufferFillCallbackFunction    in_fill_callback_function,
+                                                                    MemoryFeatureFlags                           in_required_memory_features,
+                                                                    const Anvil::ExternalMemoryHandleTypeFlags&  in_opt_exportable_external_handle_types    = Anvil::ExternalMemoryHandleTypeFlagBits::NONE,
+        #if defined(_WIN32)
+                                                                    const Anvil::ExternalNTHandleInfo*           in_opt_external_nt_handle_info_ptr         = nullptr,
+        #endif
+                                                                    const uint32_t*                              in_opt_device_mask_ptr                     = nullptr,
+                                                                    const MGPUPeerMemoryRequirements*            in_opt_mgpu_peer_memory_reqs_ptr           = nullptr,
+                                                                    const MGPUBindSparseDeviceIndices*           in_opt_mgpu_bind_sparse_device_indices_ptr = nullptr,
+                                                                    const float&                                 in_opt_memory_priority                     = FLT_MAX);
+        bool add_buffer_with_file_based_post_fill                  (Anvil::Buffer*                               in_buffer_ptr,
+                                                                    const std::string&                           in_filename,
+                                                                    size_t                                       in_file_start_offset,
+                                                                    MemoryFeatureFlags                           in_required_memory_features,
+                                                                    const Anvil::ExternalMemoryHandleTypeFlags&  in_opt_exportable_external_handle_types    = Anvil::ExternalMemoryHandleTypeFlagBits::NONE,
+        #if defined(_WIN32)
+                                                                    const Anvil::ExternalNTHandleInfo*           in_opt_external_nt_handle_info_ptr         = nullptr,
         #endif
                                                                     const uint32_t*                              in_opt_device_mask_ptr                     = nullptr,
                                                                     const MGPUPeerMemoryRequirements*            in_opt_mgpu_peer_memory_reqs_ptr           = nullptr,
@@ -373,7 +600,8 @@ namespace Anvil
          *                                                    resource index to a memory allocation instance on the device with memory index. If null or empty, the binding will work
          *                                                    as if both indices were zero.
          *  @param in_opt_memory_priority                     Memory priority to use for the allocation. Valid values must be within range [0.0f, 1.0f].
-         *                                                    Ignored if VK_EXT_memory_priority is unavailable or if VMA backend is used or if FLT_MAX is passed.
+         *                                                    Ignored if VK_EXT_memory_priority is unavailable or if FLT_MAX is passed. VMA backend
+         *                                                    only honours it if VK_EXT_pageable_device_local_memory is enabled.
          *
          *  @return TODO
          */
@@ -393,6 +621,13 @@ namespace Anvil
          *
          *  This function can be used against both non-sparse and sparse images.
          *
+         *  Images created with TRANSIENT_ATTACHMENT usage are placed in lazily allocated memory whenever the device
+         *  exposes a compatible memory type supporting it, even if LAZILY_ALLOCATED_BIT has not been requested.
+         *  On tile-based GPUs, such attachments then only get physical memory committed if the implementation
+         *  needs to spill them out of tile memory. Requesting LAZILY_ALLOCATED_BIT explicitly makes the call fail
+         *  on devices which do not provide such memory. Lazily allocated memory can only be requested for transient
+         *  attachments and cannot be combined with MAPPABLE_BIT.
+         *
          *  @param image_ptr                                  Image to configure storage for at bake() call time. Must not
          *                                                    be nullptr.
          *  @param in_required_memory_features                Memory features the assigned memory must support.
@@ -407,7 +642,8 @@ namespace Anvil
          *                                                    resource index to a memory allocation instance on the device with memory index. If null or empty, the binding will work
          *                                                    as if both indices were zero.
          *  @param in_opt_memory_priority                     Memory priority to use for the allocation. Valid values must be within range [0.0f, 1.0f].
-         *                                                    Ignored if VK_EXT_memory_priority is unavailable or if VMA backend is used or if FLT_MAX is passed.
+         *                                                    Ignored if VK_EXT_memory_priority is unavailable or if FLT_MAX is passed. VMA backend
+         *                                                    only honours it if VK_EXT_pageable_device_local_memory is enabled.
          *
          *  @return true if the image has been successfully scheduled for baking, false otherwise.
          **/
@@ -422,6 +658,50 @@ namespace Anvil
                              const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr = nullptr,
                              const float&                                in_opt_memory_priority                     = FLT_MAX);
 
+        /** Adds a buffer, whose memory should have an instance on each physical device of a mGPU device, together
+         *  with a peer view buffer, which is going to be bound to the same memory with custom device indices.
+         *
+         *  At bake time, @param in_buffer_ptr is bound so that each physical device uses its own memory instance.
+         *  @param in_peer_view_buffer_ptr is bound so that physical device N uses the memory instance of physical
+         *  device @param in_peer_device_indices[N]. Copying from the buffer to the peer view on physical device N
+         *  therefore moves data from device N's instance to device in_peer_device_indices[N]'s instance over the
+         *  device link. Please see PeerCopy for helpers which record such copies.
+         *
+         *  Memory is only picked from heaps, whose peer memory features satisfy @param in_required_peer_memory_features
+         *  for all (N, in_peer_device_indices[N]) pairs, where the two indices differ. Dedicated allocations cannot
+         *  be shared between two buffers, so the buffer must not require one.
+         *
+         *  The peer view does not take part in implicit baking, and must not outlive @param in_buffer_ptr, which owns
+         *  the memory. Per-item memory assignment callbacks, if set, are responsible for binding the peer view.
+         *
+         *  Can only be used with MGPU devices and the one-shot backend.
+         *
+         *  @param in_buffer_ptr                    Buffer to configure storage for. Must not be null.
+         *  @param in_peer_view_buffer_ptr          Buffer to bind to peer memory instances. Must not be null, and must
+         *                                          have been created with the same size & usage as @param in_buffer_ptr.
+         *  @param in_peer_device_indices           Memory instance indices to bind the peer view to, one per physical device.
+         *  @param in_required_peer_memory_features Peer memory features the memory must support. Use COPY_DST_BIT if
+         *                                          devices write to the peer view, and COPY_SRC_BIT if they read from it.
+         *  @param in_required_memory_features      Memory features the assigned memory must support.
+         *
+         *  @return true if the buffer has been successfully scheduled for baking, false otherwise.
+         **/
+        bool add_peer_accessible_buffer(Anvil::Buffer*                       in_buffer_ptr,
+                                        Anvil::Buffer*                       in_peer_view_buffer_ptr,
+                                        const std::vector<uint32_t>&         in_peer_device_indices,
+                                        const Anvil::PeerMemoryFeatureFlags& in_required_peer_memory_features,
+                                        MemoryFeatureFlags                   in_required_memory_features = Anvil::MemoryFeatureFlagBits::NONE);
+
+        /** Image counterpart of add_peer_accessible_buffer().
+         *
+         *  Both images must have been created with identical parameters, including Anvil::ImageCreateFlagBits::ALIAS_BIT,
+         *  so that they interpret the shared memory consistently. Multi-planar images are not supported.
+         **/
+        bool add_peer_accessible_image(Anvil::Image*                        in_image_ptr,
+                                       Anvil::Image*                        in_peer_view_image_ptr,
+                                       const std::vector<uint32_t>&         in_peer_device_indices,
+                                       const Anvil::PeerMemoryFeatureFlags& in_required_peer_memory_features,
+                                       MemoryFeatureFlags                   in_required_memory_features = Anvil::MemoryFeatureFlagBits::NONE);
 
         /** Adds a new Image object whose layer @param in_n_layer 's miptail for @param in_aspect
          *  aspect should be assigned a physical memory backing. The miptail will be bound a memory
@@ -446,7 +726,8 @@ namespace Anvil
          *                                                    resource index to a memory allocation instance on the device with memory index. If null or empty, the binding will work
          *                                                    as if both indices were zero.
          *  @param in_opt_memory_priority                     Memory priority to use for the allocation. Valid values must be within range [0.0f, 1.0f].
-         *                                                    Ignored if VK_EXT_memory_priority is unavailable or if VMA backend is used or if FLT_MAX is passed.
+         *                                                    Ignored if VK_EXT_memory_priority is unavailable or if FLT_MAX is passed. VMA backend
+         *                                                    only honours it if VK_EXT_pageable_device_local_memory is enabled.
          *
          *  @return true if the miptail has been successfully scheduled for baking, false otherwise.
          */
@@ -484,7 +765,8 @@ namespace Anvil
          *                                                    resource index to a memory allocation instance on the device with memory index. If null or empty, the binding will work
          *                                                    as if both indices were zero.
          *  @param in_opt_memory_priority                     Memory priority to use for the allocation. Valid values must be within range [0.0f, 1.0f].
-         *                                                    Ignored if VK_EXT_memory_priority is unavailable or if VMA backend is used or if FLT_MAX is passed.
+         *                                                    Ignored if VK_EXT_memory_priority is unavailable or if FLT_MAX is passed. VMA backend
+         *                                                    only honours it if VK_EXT_pageable_device_local_memory is enabled.
          *
          *  @return true if the subresource has been successfully scheduled for baking, false otherwise.
          **/
@@ -498,17 +780,71 @@ namespace Anvil
                                           const MGPUBindSparseDeviceIndices*    in_opt_mgpu_bind_sparse_device_indices_ptr = nullptr,
                                           const float&                          in_opt_memory_priority                     = FLT_MAX);
 
-        /** TODO */
+        /** Assigns memory to all objects registered since the last bake, including objects registered by other threads.
+         *
+         *  If the backend supports it (VMA), objects which can be assigned memory of different sets of memory types
+         *  are baked in parallel, using the device's task scheduler.
+         *
+         *  @return true if successful, false otherwise.
+         **/
         bool bake();
 
+        /** Compacts memory used by the specified buffers by moving their memory regions, so that free space becomes
+         *  contiguous and memory allocations left empty can be released.
+         *
+         *  Work is split into passes, each of which moves up to @param in_n_max_moves_per_pass regions. Passes are
+         *  issued until there is nothing left to move or until @param in_time_budget_msec elapses, so the function
+         *  can be called once per frame to defragment incrementally.
+         *
+         *  Each buffer whose memory has been moved gets a new Vulkan buffer handle, bound to the new location.
+         *  BUFFER_CALLBACK_ID_MEMORY_MOVED call-back is then issued for the buffer, so that descriptor sets and
+         *  buffer views referring to the old handle can be updated.
+         *
+         *  Buffers which cannot be moved are silently skipped. This includes buffers which are sparse, use dedicated
+         *  allocations, have not been assigned memory by this allocator, or whose memory is mapped at call time.
+         *  Sub-buffers created off a moved buffer keep using the old handle, so buffers which have children should
+         *  not be passed.
+         *
+         *  The caller must make sure the GPU does not access any of the specified buffers until the function returns.
+         *
+         *  Requires a backend supporting defragmentation (VMA). Note that the VMA library copies data on the host,
+         *  and therefore only ever moves regions of host-visible memory.
+         *
+         *  @param in_buffers              Buffers which are allowed to be moved.
+         *  @param in_time_budget_msec     Time after which no new pass is going to be started. 0 means no limit.
+         *  @param in_n_max_moves_per_pass Maximum number of regions to move in a single pass. Must not be 0.
+         *  @param out_opt_stats_ptr       If not null, deref will be set to the total amount of work done by the call.
+         *  @param out_opt_is_complete_ptr If not null, deref will be set to true if there is nothing left to move,
+         *                                 or to false if the time budget has been exhausted first.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool defragment(const std::vector<Anvil::Buffer*>& in_buffers,
+                        uint64_t                           in_time_budget_msec     = 0,
+                        uint32_t                           in_n_max_moves_per_pass = 16,
+                        DefragmentationStats*              out_opt_stats_ptr       = nullptr,
+                        bool*                              out_opt_is_complete_ptr = nullptr);
+
         /** Creates a new one-shot memory allocator instance.
          *
-         *  This type of allocator only supports a single explicit (or implicit) bake invocation.
+         *  This type of allocator supports an arbitrary number of implicit or explicit bake invocations. Each bake
+         *  only processes items added since the previous one. New items are first packed into the unused tail of
+         *  memory blocks allocated by earlier bakes, and only the remainder is assigned a new memory block.
+         *  Regions are never reclaimed, even after the objects using them are released.
          *
-         *  @param in_device_ptr Device to use.
+         *  Objects for which the driver prefers or requires a dedicated allocation, as reported via
+         *  VK_KHR_dedicated_allocation, are given their own memory block instead of being packed. Sparse objects
+         *  and disjoint images are always packed. See Stats::n_dedicated_allocations for the resulting split.
+         *
+         *  @param in_device_ptr     Device to use.
+         *  @param in_mt_safety      MT safety setting to use.
+         *  @param in_min_block_size Minimum size of memory blocks to allocate for non-dedicated items. Values larger
+         *                           than what a bake needs leave slack which later bakes can fill, reducing
+         *                           the number of device memory allocations made by streaming apps.
          **/
         static Anvil::MemoryAllocatorUniquePtr create_oneshot(const Anvil::BaseDevice* in_device_ptr,
-                                                              MTSafety                 in_mt_safety = Anvil::MTSafety::INHERIT_FROM_PARENT_DEVICE);
+                                                              MTSafety                 in_mt_safety      = Anvil::MTSafety::INHERIT_FROM_PARENT_DEVICE,
+                                                              VkDeviceSize             in_min_block_size = 0);
 
         /** Creates a new VMA memory allocator instance.
          *
@@ -516,16 +852,87 @@ namespace Anvil
          *  This type of allocator does NOT support external handles of any type.
          *  This type of allocator does NOT support device masks.
          *
+         *  Custom memory pools can be created for objects with specific allocation patterns. Buffers are placed in a pool
+         *  by passing its ID, which is the index of its create info in @param in_pools, to add_buffer(). LINEAR and
+         *  RING_BUFFER pools hand out memory in O(1) time without fragmentation; see VMAPoolAlgorithm for details.
+         *  A buffer which does not fit in a LINEAR or RING_BUFFER pool at bake time is not assigned memory.
+         *
          *  @param in_device_ptr Device to use.
+         *  @param in_mt_safety  MT safety setting to use.
+         *  @param in_pools      Custom memory pools to create.
          **/
-        static Anvil::MemoryAllocatorUniquePtr create_vma(const Anvil::BaseDevice* in_device_ptr,
-                                                          MTSafety                 in_mt_safety = Anvil::MTSafety::INHERIT_FROM_PARENT_DEVICE);
+        static Anvil::MemoryAllocatorUniquePtr create_vma(const Anvil::BaseDevice*              in_device_ptr,
+                                                          MTSafety                              in_mt_safety = Anvil::MTSafety::INHERIT_FROM_PARENT_DEVICE,
+                                                          const std::vector<VMAPoolCreateInfo>& in_pools     = std::vector<VMAPoolCreateInfo>() );
+
+        /** Retrieves current usage and budget of the specified memory heap.
+         *
+         *  If VK_EXT_memory_budget is enabled on the device, both values are as reported by the implementation and
+         *  cover all allocations made by the process. Otherwise, usage only covers device memory allocated by this
+         *  allocator and the budget is the size of the heap.
+         *
+         *  @param in_n_heap              Index of the memory heap to use for the query.
+         *  @param out_n_bytes_used_ptr   Deref will be set to the number of bytes allocated from the heap. Must not be null.
+         *  @param out_n_bytes_budget_ptr Deref will be set to the number of bytes which can be allocated from the heap
+         *                                without risking allocation failures or performance penalties. Must not be null.
+         *
+         *  @return true if successful, false if @param in_n_heap is not a valid heap index.
+         */
+        bool get_heap_budget(uint32_t      in_n_heap,
+                             VkDeviceSize* out_n_bytes_used_ptr,
+                             VkDeviceSize* out_n_bytes_budget_ptr) const;
 
         static bool get_mem_types_supporting_mem_features(const Anvil::BaseDevice*         in_device_ptr,
                                                           uint32_t                         in_memory_types,
                                                           const Anvil::MemoryFeatureFlags& in_memory_features,
                                                           uint32_t*                        out_opt_filtered_memory_types_ptr);
 
+        /** Returns memory assigned to objects by bake() invocations so far, in the order of assignment.
+         *
+         *  The allocator does not track lifetime of objects after their memory has been bound, so the list also covers
+         *  objects which have been released since.
+         *
+         *  @param out_assignments_ptr Deref will be set to the list of assignments. Must not be null.
+         */
+        void get_item_assignments(std::vector<ItemAssignment>* out_assignments_ptr) const;
+
+        /** Returns a JSON document describing the state of the allocator. The document holds an object with:
+         *
+         *  - "Stats":   totals as reported by get_stats(), with a per-memory type breakdown.
+         *  - "Items":   assignments as reported by get_item_assignments().
+         *  - "Backend": backend-specific details. For VMA allocators, this is the detailed map produced by
+         *               vmaBuildStatsString(). For one-shot allocators, this lists all memory blocks with
+         *               their used & reserved sizes.
+         */
+        std::string get_json_dump() const;
+
+        /** Retrieves memory usage statistics of the allocator.
+         *
+         *  Only covers memory which has been handed out by bake() invocations so far. Items which are still pending
+         *  a bake are not accounted for.
+         *
+         *  @param out_stats_ptr Deref will be set to the statistics. Must not be null.
+         */
+        void get_stats(Stats* out_stats_ptr) const;
+
+        /** Tells whether memory blocks created by the allocator stay mapped once mapped for the first time. */
+        bool is_persistent_mapping_enabled() const
+        {
+            return m_persistent_mapping_enabled;
+        }
+
+        /** Makes the allocator create memory blocks which stay mapped into process space once mapped for the first time.
+         *  Reads & writes of host-visible allocations then no longer map & unmap the underlying memory every time.
+         *
+         *  Only affects memory blocks created by subsequent bake() calls. Disabled by default.
+         *
+         *  Please see MemoryBlockCreateInfo::set_persistently_mapped() for more details.
+         */
+        void set_persistent_mapping_enabled(const bool& in_enabled)
+        {
+            m_persistent_mapping_enabled = in_enabled;
+        }
+
         /** By default, once memory regions are baked, memory allocator will bind them to objects specified
          *  at add_*() call time. Use cases exist where apps may prefer to handle this action on their own.
          *
@@ -565,6 +972,19 @@ namespace Anvil
          */
         void set_post_bake_callback(MemoryAllocatorBakeCallbackFunction in_post_bake_callback_function);
 
+        /** Assigns a func pointer which will be called by the allocator at the end of each bake() invocation, for
+         *  each memory heap whose usage, as reported by get_heap_budget(), has reached @param in_usage_threshold
+         *  of the heap's budget. Apps can use it to throttle streaming before allocations start failing.
+         *
+         *  The callback is also issued if the bake fails.
+         *
+         *  @param in_callback_function Function pointer to assign. May be null, in which case no callbacks are issued.
+         *  @param in_usage_threshold   Fraction of the heap budget at which the callback starts firing. Must be larger
+         *                              than 0.
+         */
+        void set_low_memory_callback(MemoryAllocatorLowMemoryCallbackFunction in_callback_function,
+                                     float                                    in_usage_threshold = 0.9f);
+
          /** Destructor.
           *
           *  Releases the underlying MemoryBlock instance
@@ -584,8 +1004,24 @@ namespace Anvil
                                  const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
                                  const float&                                in_opt_memory_priority);
 
+        bool   bake_aliased_items       (Items&                                         in_items);
+        bool   bake_backend_items       (Items&                                         in_items);
+        void   check_memory_budget      ();
+        void   get_heap_budgets         (std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS>* out_n_bytes_used_ptr,
+                                         std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS>* out_n_bytes_budget_ptr) const;
+        Items* get_pending_items        (std::unique_lock<Anvil::RecursiveSpinLock>*    out_lock_ptr);
+        bool   has_pending_items        ();
+        void   mark_alloc_pending       (const void*                                    in_object_ptr);
+
+        std::unique_lock<Anvil::RecursiveSpinLock> lock_pending_alloc_status();
+
         bool do_bind_sparse_device_indices_sanity_check  (const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr) const;
         bool do_external_memory_handle_type_sanity_checks(const Anvil::ExternalMemoryHandleTypeFlags& in_external_memory_handle_types) const;
+        bool get_peer_access_properties                  (const std::vector<uint32_t>&                in_peer_device_indices,
+                                                          const Anvil::PeerMemoryFeatureFlags&        in_required_peer_memory_features,
+                                                          uint32_t*                                   out_device_mask_ptr,
+                                                          MGPUPeerMemoryRequirements*                 out_peer_memory_reqs_ptr) const;
+        bool is_buffer_defragmentable                    (Anvil::Buffer*                              in_buffer_ptr)                              const;
 
         void on_is_alloc_pending_for_buffer_query(CallbackArgument* in_callback_arg_ptr);
         void on_is_alloc_pending_for_image_query (CallbackArgument* in_callback_arg_ptr);
@@ -601,12 +1037,30 @@ namespace Anvil
         MemoryAllocator           (const MemoryAllocator&);
         MemoryAllocator& operator=(const MemoryAllocator&);
 
+        /* Private type definitions */
+
+        /* Holds items registered by threads which have been assigned the shard, until the next bake. Registration
+         * only locks the shard of the calling thread, so that threads can register objects concurrently. */
+        typedef struct PendingItemShard
+        {
+            Items                    items;
+            Anvil::RecursiveSpinLock lock;
+        } PendingItemShard;
+
         /* Private members */
         std::shared_ptr<IMemoryAllocatorBackend> m_backend_ptr;
         const Anvil::BaseDevice*                 m_device_ptr;
+        std::vector<ItemAssignment>              m_item_assignments;
         Items                                    m_items;
+        std::array<PendingItemShard, 16>         m_pending_item_shards;
         std::map<const void*, bool>              m_per_object_pending_alloc_status;
+        Anvil::RecursiveSpinLock                 m_pending_alloc_status_lock;
+
+        Stats                                    m_aliasing_stats;
 
+        MemoryAllocatorLowMemoryCallbackFunction                           m_low_memory_callback_function;
+        float                                                              m_low_memory_usage_threshold;
+        bool                                                               m_persistent_mapping_enabled;
         MemoryAllocatorBakeCallbackFunction                                m_post_bake_callback_function;
         MemoryAllocatorPostBakePerNonSparseBufferItemMemAssignmentCallback m_post_bake_per_buffer_item_mem_assignment_callback_function;
         MemoryAllocatorPostBakePerNonSparseImageItemMemAssignmentCallback  m_post_bake_per_image_item_mem_assignment_callback_function;
@@ -78,6 +78,61 @@ namespace Anvil
                                                                                      VkDeviceSize                         in_start_offset,
                                                                                      OnMemoryBlockReleaseCallbackFunction in_on_release_callback_function);
 
+        #if !defined(_WIN32)
+            /** Spawns a create info instance which can be used to import a Linux dmabuf, eg. one exported by a video
+             *  decoder or a camera driver, without copying its contents.
+             *
+             *  A memory type which can hold the dmabuf and supports @param in_memory_features is picked automatically.
+             *  Buffers and images bound to the memory block must have been created with Anvil::ExternalMemoryHandleTypeFlagBits::DMA_BUF_BIT_EXT
+             *  specified as one of their external memory handle types.
+             *
+             *  If MemoryBlock::create() succeeds, the implementation takes ownership of @param in_fd. The app must not use or close
+             *  the FD afterward. If it fails, the FD remains owned by the app.
+             *
+             *  Requires VK_KHR_external_memory_fd and VK_EXT_external_memory_dma_buf.
+             *
+             *  @param in_device_ptr          Device to use. Must not be null.
+             *  @param in_fd                  Dmabuf FD to import.
+             *  @param in_size                Size of the imported region. Must not be larger than the dmabuf.
+             *  @param in_allowed_memory_bits Memory type bits which meet the requirements of resources the memory block is going to be
+             *                                bound to.
+             *  @param in_memory_features     Required memory features.
+             *
+             *  @return New create info instance if successful, null if none of the memory types supports the dmabuf.
+             **/
+            static MemoryBlockCreateInfoUniquePtr create_imported_dma_buf(const Anvil::BaseDevice*  in_device_ptr,
+                                                                          int                       in_fd,
+                                                                          VkDeviceSize              in_size,
+                                                                          uint32_t                  in_allowed_memory_bits,
+                                                                          Anvil::MemoryFeatureFlags in_memory_features);
+        #endif
+
+        /** Spawns a create info instance which can be used to import a host allocation, eg. a network receive buffer,
+         *  so that the GPU accesses it directly.
+         *
+         *  A memory type which can hold the allocation and supports @param in_memory_features is picked automatically.
+         *  Buffers bound to the memory block must have been created with Anvil::ExternalMemoryHandleTypeFlagBits::HOST_ALLOCATION_BIT_EXT
+         *  specified as one of their external memory handle types.
+         *
+         *  The allocation is not owned by the memory block. It must remain valid until the memory block is released.
+         *
+         *  Requires VK_EXT_external_memory_host.
+         *
+         *  @param in_device_ptr          Device to use. Must not be null.
+         *  @param in_host_ptr            Host allocation to import. Must be aligned to minImportedHostPointerAlignment.
+         *  @param in_size                Size of the allocation. Must be a multiple of minImportedHostPointerAlignment.
+         *  @param in_allowed_memory_bits As per create_imported_dma_buf().
+         *  @param in_memory_features     Required memory features.
+         *
+         *  @return New create info instance if successful, null if the allocation is misaligned or none of the memory types
+         *          supports it.
+         **/
+        static MemoryBlockCreateInfoUniquePtr create_imported_host_allocation(const Anvil::BaseDevice*  in_device_ptr,
+                                                                              void*                     in_host_ptr,
+                                                                              VkDeviceSize              in_size,
+                                                                              uint32_t                  in_allowed_memory_bits,
+                                                                              Anvil::MemoryFeatureFlags in_memory_features);
+
         /** Spawns a create info instance which can be used to instantiate a new memory block.
          *
          *  This function can be used for both single- and multi-GPU device instances. For the latter case,
@@ -278,6 +333,15 @@ namespace Anvil
             return m_type;
         }
 
+        /** Tells whether the memory block stays mapped into process space, once mapped for the first time.
+         *
+         *  Please see set_persistently_mapped() for more details.
+         */
+        const bool& is_persistently_mapped() const
+        {
+            return m_persistently_mapped;
+        }
+
         /* Requires VK_KHR_device_group */
         void set_device_mask(const uint32_t& in_device_mask)
         {
@@ -398,6 +462,31 @@ namespace Anvil
             m_memory_priority = in_priority;
         }
 
+        /** Sets a function to call right before the memory block is released.
+         *
+         *  Used by memory allocator backends which carve derived memory blocks out of memory they manage themselves.
+         */
+        void set_on_release_callback_function(const Anvil::OnMemoryBlockReleaseCallbackFunction& in_on_release_callback_function)
+        {
+            m_on_release_callback_function = in_on_release_callback_function;
+        }
+
+        /** Makes the memory block keep its memory mapped into process space from the first time it is mapped (either
+         *  explicitly with MemoryBlock::map(), or implicitly by read() or write() calls) until it is released. Reads and
+         *  writes issued for the block, or for any of the blocks derived from it, are then plain memcpy()s.
+         *
+         *  Only affects memory blocks which are not derived from other blocks. Derived blocks use the mapping of their
+         *  parent block.
+         *
+         *  Ignored for memory which is not host-visible.
+         *
+         *  Disabled by default.
+         */
+        void set_persistently_mapped(const bool& in_persistently_mapped)
+        {
+            m_persistently_mapped = in_persistently_mapped;
+        }
+
     private:
         MemoryBlockCreateInfo(const Anvil::MemoryBlockType&                      in_type,
                               const uint32_t&                                    in_allowed_memory_bits,
@@ -412,6 +501,18 @@ namespace Anvil
                               const VkDeviceSize&                                in_size,
                               const VkDeviceSize&                                in_start_offset);
 
+        static uint32_t get_imported_memory_type_index(const Anvil::BaseDevice*  in_device_ptr,
+                                                       uint32_t                  in_supported_memory_types,
+                                                       Anvil::MemoryFeatureFlags in_memory_features);
+
+        /* NOTE: Only to be used by Anvil::MemoryBlock! */
+        void set_memory_location(VkDeviceMemory      in_memory,
+                                 const VkDeviceSize& in_start_offset)
+        {
+            m_memory       = in_memory;
+            m_start_offset = in_start_offset;
+        }
+
         /* NOTE: Only to be used by Anvil::MemoryBlock! */
         void set_memory_type_index(const uint32_t& in_new_index)
         {
@@ -430,6 +531,7 @@ namespace Anvil
         Anvil::MTSafety                             m_mt_safety;
         Anvil::OnMemoryBlockReleaseCallbackFunction m_on_release_callback_function;
         Anvil::MemoryBlock*                         m_parent_memory_block_ptr;
+        bool                                        m_persistently_mapped;
         std::vector<const Anvil::PhysicalDevice*>   m_physical_devices;
         VkDeviceSize                                m_size;
         VkDeviceSize                                m_start_offset;
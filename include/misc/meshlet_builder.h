@@ -0,0 +1,164 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Splits an indexed triangle list into meshlets, suitable for consumption by task & mesh shaders.
+ *
+ *  Triangles are clustered greedily: each meshlet is seeded with the first triangle which has not been emitted yet,
+ *  and then grown by adding the adjacent triangle which introduces the fewest new vertices. A meshlet is closed when
+ *  either of the limits passed at creation time would be exceeded, or when no adjacent triangle fits.
+ *
+ *  The builder outputs three arrays:
+ *
+ *  1. Meshlet descriptors (see Meshlet). Each descriptor takes 48 bytes and is laid out so that it can be read
+ *     directly from a std430 storage buffer.
+ *  2. Vertex indices. For each meshlet, n_vertices entries starting at vertex_offset map meshlet-local vertex indices
+ *     to indices in the original vertex buffer.
+ *  3. Primitive indices. For each meshlet, n_primitives entries starting at primitive_offset describe one triangle
+ *     each. The three meshlet-local vertex indices are packed into bits 0-7, 8-15 and 16-23 of the entry.
+ *
+ *  Each meshlet also carries a bounding sphere and a normal cone which a task shader can use to reject whole meshlets.
+ *  A meshlet can be culled if:
+ *
+ *      dot(center - camera_position, cone_axis) >= cone_cutoff * length(center - camera_position) + radius
+ *
+ *  Builder instances are NOT thread-safe.
+ */
+#ifndef MISC_MESHLET_BUILDER_H
+#define MISC_MESHLET_BUILDER_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class MeshletBuilder
+    {
+    public:
+        /* Public type definitions */
+        typedef struct Meshlet
+        {
+            float    bounding_sphere [4]; /* xyz: center, w: radius                                  */
+            float    cone_axis_cutoff[4]; /* xyz: normal cone axis, w: cutoff. 1.0 disables culling. */
+            uint32_t n_primitives;
+            uint32_t n_vertices;
+            uint32_t primitive_offset;
+            uint32_t vertex_offset;
+        } Meshlet;
+
+        /* Public functions */
+
+        /** Creates a new builder instance.
+         *
+         *  @param in_max_vertices_per_meshlet   Maximum number of unique vertices a single meshlet may reference. Must be
+         *                                       at least 3 and must not exceed 256. Should not exceed the device's
+         *                                       maxMeshOutputVertices limit.
+         *  @param in_max_primitives_per_meshlet Maximum number of triangles a single meshlet may hold. Must not be 0.
+         *                                       Should not exceed the device's maxMeshOutputPrimitives limit.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::MeshletBuilderUniquePtr create(uint32_t in_max_vertices_per_meshlet   = 64,
+                                                     uint32_t in_max_primitives_per_meshlet = 126);
+
+        /** Destructor. */
+        ~MeshletBuilder();
+
+        /** Splits the specified triangle list into meshlets. Results of any previous build() call are discarded.
+         *
+         *  @param in_positions_ptr    Vertex positions. Each position is defined by three consecutive floats. Must not
+         *                             be null.
+         *  @param in_n_vertices       Number of vertices @param in_positions_ptr holds.
+         *  @param in_position_stride  Distance between two consecutive positions, in bytes. Must be at least
+         *                             3 * sizeof(float).
+         *  @param in_indices_ptr      Triangle list indices. Must not be null.
+         *  @param in_n_indices        Number of indices. Must be a non-zero multiple of 3. All indices must be smaller
+         *                             than @param in_n_vertices.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool build(const float*    in_positions_ptr,
+                   uint32_t        in_n_vertices,
+                   uint32_t        in_position_stride,
+                   const uint32_t* in_indices_ptr,
+                   uint32_t        in_n_indices);
+
+        /** Creates storage buffers holding meshlet descriptors, vertex indices and primitive indices, as produced by
+         *  the last successful build() call. Buffer memory is allocated via @param in_memory_allocator_ptr and filled
+         *  when the allocator bakes; the caller is responsible for baking it.
+         *
+         *  @param in_device_ptr                      Device to create the buffers for. Must not be null.
+         *  @param in_memory_allocator_ptr            Memory allocator to use. Must not be null.
+         *  @param in_required_memory_features        Memory features the buffer memory must support.
+         *  @param out_meshlet_buffer_ptr             Deref will be set to the meshlet descriptor buffer. Must not be null.
+         *  @param out_vertex_index_buffer_ptr        Deref will be set to the vertex index buffer. Must not be null.
+         *  @param out_primitive_index_buffer_ptr     Deref will be set to the primitive index buffer. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool create_buffers(const Anvil::BaseDevice*   in_device_ptr,
+                            Anvil::MemoryAllocator*    in_memory_allocator_ptr,
+                            Anvil::MemoryFeatureFlags  in_required_memory_features,
+                            Anvil::BufferUniquePtr*    out_meshlet_buffer_ptr,
+                            Anvil::BufferUniquePtr*    out_vertex_index_buffer_ptr,
+                            Anvil::BufferUniquePtr*    out_primitive_index_buffer_ptr) const;
+
+        /** Returns meshlet descriptors produced by the last successful build() call. */
+        const std::vector<Meshlet>& get_meshlets() const
+        {
+            return m_meshlets;
+        }
+
+        /** Returns packed primitive indices produced by the last successful build() call. */
+        const std::vector<uint32_t>& get_primitive_indices() const
+        {
+            return m_primitive_indices;
+        }
+
+        /** Returns vertex indices produced by the last successful build() call. */
+        const std::vector<uint32_t>& get_vertex_indices() const
+        {
+            return m_vertex_indices;
+        }
+
+    private:
+        /* Private functions */
+        MeshletBuilder(uint32_t in_max_vertices_per_meshlet,
+                       uint32_t in_max_primitives_per_meshlet);
+
+        void calculate_bounds(const float* in_positions_ptr,
+                              uint32_t     in_position_stride,
+                              Meshlet*     inout_meshlet_ptr) const;
+
+        /* Private variables */
+        const uint32_t        m_max_primitives_per_meshlet;
+        const uint32_t        m_max_vertices_per_meshlet;
+        std::vector<Meshlet>  m_meshlets;
+        std::vector<uint32_t> m_primitive_indices;
+        std::vector<uint32_t> m_vertex_indices;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(MeshletBuilder);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(MeshletBuilder);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_MESHLET_BUILDER_H */
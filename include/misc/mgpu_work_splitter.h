@@ -0,0 +1,258 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Distributes rendering & compute work across the physical devices of a mGPU device.
+ *
+ *  Two split modes are supported:
+ *
+ *  - Alternate frame rendering (AFR): each frame is rendered in its entirety by a single physical device.
+ *    Devices are picked in round-robin order. Apps use get_afr_device_mask() for the frame's submissions
+ *    and command buffer device masks.
+ *
+ *  - Split frame rendering (SFR): each frame is split into horizontal bands, one per physical device.
+ *    record_sfr_scissors() records a per-device scissor for the band, and record_split_dispatch() splits
+ *    a compute dispatch along the X axis using vkCmdDispatchBase(). get_sfr_composition_copies() tells which
+ *    device should execute each of the peer-memory copies needed to gather the bands on a single device,
+ *    based on the peer memory features reported by the device group.
+ *
+ *  Band & dispatch split ratios start out even. If apps report how long each device took to execute its part
+ *  of the frame with report_device_gpu_time() (eg. with timings taken from a GPUProfiler), begin_frame()
+ *  moves the ratios towards each device's measured throughput. Devices which have not reported a time since
+ *  the last rebalance keep their share.
+ *
+ *  MGPU work splitter is NOT thread-safe.
+ */
+#ifndef MISC_MGPU_WORK_SPLITTER_H
+#define MISC_MGPU_WORK_SPLITTER_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    enum class MGPUWorkSplitMode
+    {
+        /* Alternate frame rendering */
+        AFR,
+
+        /* Split frame rendering */
+        SFR,
+    };
+
+    class MGPUWorkSplitter
+    {
+    public:
+        /* Public type definitions */
+
+        /* Describes a single peer-memory copy needed to gather SFR bands on a single physical device. */
+        typedef struct PeerCopyInfo
+        {
+            /* Index of the physical device which should execute the copy. Equal to either the source or the
+             * destination device index. */
+            uint32_t executing_device_index;
+
+            /* Index of the physical device whose memory instance holds the band. */
+            uint32_t src_device_index;
+
+            /* Index of the physical device whose memory instance the band should be copied to. */
+            uint32_t dst_device_index;
+
+            /* Band to copy. */
+            VkRect2D rect;
+
+            PeerCopyInfo()
+                :executing_device_index(UINT32_MAX),
+                 src_device_index      (UINT32_MAX),
+                 dst_device_index      (UINT32_MAX)
+            {
+                rect.extent.height = 0;
+                rect.extent.width  = 0;
+                rect.offset.x      = 0;
+                rect.offset.y      = 0;
+            }
+        } PeerCopyInfo;
+
+        /* Public functions */
+
+        /** Creates a new MGPU work splitter instance.
+         *
+         *  @param in_device_ptr Device to split work for. Must not be null.
+         *  @param in_mode       Split mode to use.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::MGPUWorkSplitterUniquePtr create(const Anvil::MGPUDevice*  in_device_ptr,
+                                                       Anvil::MGPUWorkSplitMode  in_mode);
+
+        ~MGPUWorkSplitter();
+
+        /** Moves to the next frame.
+         *
+         *  In AFR mode, selects the physical device the new frame should be rendered with. In SFR mode,
+         *  rebalances split ratios, taking into account GPU times reported since the last begin_frame() call.
+         */
+        void begin_frame();
+
+        /** Returns the device mask of the physical device the current frame should be rendered with.
+         *
+         *  Can only be called in AFR mode.
+         */
+        uint32_t get_afr_device_mask() const
+        {
+            anvil_assert(m_mode == Anvil::MGPUWorkSplitMode::AFR);
+
+            return (1u << m_n_current_afr_device);
+        }
+
+        /** Returns index of the physical device the current frame should be rendered with.
+         *
+         *  Can only be called in AFR mode.
+         */
+        uint32_t get_afr_device_index() const
+        {
+            anvil_assert(m_mode == Anvil::MGPUWorkSplitMode::AFR);
+
+            return m_n_current_afr_device;
+        }
+
+        /** Returns a device mask covering all physical devices of the mGPU device. */
+        uint32_t get_all_devices_mask() const
+        {
+            return (1u << get_n_devices() ) - 1;
+        }
+
+        /** Returns the number of physical devices work is split across. */
+        uint32_t get_n_devices() const
+        {
+            return static_cast<uint32_t>(m_split_ratios.size() );
+        }
+
+        /** Returns current split ratios, one per physical device. Ratios add up to 1. */
+        const std::vector<float>& get_split_ratios() const
+        {
+            return m_split_ratios;
+        }
+
+        /** Fills @param out_result_ptr with the peer-memory copies needed to gather SFR bands rendered by all
+         *  physical devices in the memory instance of device @param in_n_target_device.
+         *
+         *  For each band, the copy is executed by the source device if it can write to the target device's
+         *  memory instance, or by the target device if it can read from the source device's instance.
+         *
+         *  @param in_n_target_device Index of the physical device to gather the bands on.
+         *  @param in_memory_heap_idx Index of the memory heap the resource's memory comes from.
+         *  @param in_render_area     Render area. Bands are calculated as per get_sfr_rects().
+         *  @param in_opt_tile_size   Please see get_sfr_rects().
+         *  @param out_result_ptr     Deref will be set to copies to execute. Must not be null.
+         *
+         *  @return true if successful, false if one of the bands cannot be copied between the devices.
+         */
+        bool get_sfr_composition_copies(uint32_t                   in_n_target_device,
+                                        uint32_t                   in_memory_heap_idx,
+                                        const VkRect2D&            in_render_area,
+                                        const VkExtent2D*          in_opt_tile_size,
+                                        std::vector<PeerCopyInfo>* out_result_ptr) const;
+
+        /** Splits the render area into horizontal bands, one per physical device, with heights proportional to
+         *  current split ratios.
+         *
+         *  @param in_render_area   Render area to split.
+         *  @param in_opt_tile_size If not null, band boundaries are aligned to the tile height. Apps which bind
+         *                          SFR images should pass the value reported by Image::get_SFR_tile_size().
+         *  @param out_result_ptr   Deref will be set to one rectangle per physical device. Rectangles of devices
+         *                          with a 0-sized band have a height of 0. Must not be null.
+         */
+        void get_sfr_rects(const VkRect2D&        in_render_area,
+                           const VkExtent2D*      in_opt_tile_size,
+                           std::vector<VkRect2D>* out_result_ptr) const;
+
+        /** Records per-device scissors, so that each physical device only rasterizes its SFR band.
+         *
+         *  For each device, sets the device mask and the scissor of index 0. The device mask is restored to
+         *  @param in_final_device_mask before leaving. Requires the bound pipeline to use a dynamic scissor.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_sfr_scissors(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                 const VkRect2D&           in_render_area,
+                                 const VkExtent2D*         in_opt_tile_size,
+                                 uint32_t                  in_final_device_mask);
+
+        /** Splits a compute dispatch along the X axis between physical devices, proportionally to current split
+         *  ratios, and records one vkCmdDispatchBase() call per device with a non-empty share.
+         *
+         *  The device mask is restored to @param in_final_device_mask before leaving.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_split_dispatch(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                   uint32_t                  in_n_groups_x,
+                                   uint32_t                  in_n_groups_y,
+                                   uint32_t                  in_n_groups_z,
+                                   uint32_t                  in_final_device_mask);
+
+        /** Reports how long physical device @param in_n_device took to execute its part of a frame.
+         *
+         *  The value is taken into account by the next begin_frame() call. Reports are ignored in AFR mode.
+         */
+        void report_device_gpu_time(uint32_t in_n_device,
+                                    uint64_t in_duration_nsec);
+
+        /** Sets how quickly split ratios react to reported GPU times.
+         *
+         *  @param in_damping Value in range (0, 1]. 1 moves ratios straight to the measured throughput.
+         *                    Lower values smooth out noise in the measurements. Defaults to 0.5.
+         */
+        void set_rebalance_damping(float in_damping);
+
+        /** Sets the minimum share of the work each physical device is left with after rebalancing.
+         *
+         *  A non-zero value ensures a device which has been slow for a few frames keeps getting work, so
+         *  that its throughput can still be measured. Defaults to 0.05.
+         */
+        void set_min_split_ratio(float in_min_ratio);
+
+    private:
+        /* Private functions */
+        MGPUWorkSplitter(const Anvil::MGPUDevice* in_device_ptr,
+                         Anvil::MGPUWorkSplitMode in_mode);
+
+        void get_split_offsets(uint32_t               in_size,
+                               uint32_t               in_alignment,
+                               std::vector<uint32_t>* out_result_ptr) const;
+        void rebalance        ();
+
+        /* Private variables */
+        const Anvil::MGPUDevice* m_device_ptr;
+        Anvil::MGPUWorkSplitMode m_mode;
+        float                    m_min_split_ratio;
+        uint32_t                 m_n_current_afr_device;
+        float                    m_rebalance_damping;
+        std::vector<uint64_t>    m_reported_gpu_times;
+        std::vector<float>       m_split_ratios;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(MGPUWorkSplitter);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(MGPUWorkSplitter);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_MGPU_WORK_SPLITTER_H */
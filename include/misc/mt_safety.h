@@ -22,22 +22,204 @@
 #ifndef MISC_MT_SAFETY_H
 #define MISC_MT_SAFETY_H
 
+#include "misc/debug.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
 #include <mutex>
+#include <thread>
 
 namespace Anvil
 {
-    class MTSafetySupportProvider
+    /** Compact recursive lock, meant to be stored inline in the objects it protects.
+     *
+     *  Most sections guarded by wrapper locks wrap a single Vulkan call, so a contending thread spins for a while
+     *  first. Some sections are held for much longer though (eg. pipeline compiles, memory allocations or fence
+     *  waits), so once the spin budget is exhausted, the thread goes to sleep. Sleeping threads are parked on
+     *  one of a fixed number of condition variables shared by all locks, so that the lock itself stays 16 bytes
+     *  in size.
+     *
+     *  Recursion is tracked, since wrappers may call their own locked entry-points from within a locked section.
+     *  The recursion counter is only ever touched by the owning thread, so it needs no synchronization. It is
+     *  16-bit wide to keep the lock compact, so re-entering a lock more than 65535 times results in an assertion
+     *  failure. Objects which never re-enter their lock should say so at creation time. Re-entering such a lock
+     *  results in an assertion failure.
+     *
+     *  Satisfies the Lockable requirements, so it can be used with std::unique_lock & std::lock_guard.
+     */
+    class RecursiveSpinLock
     {
     public:
-        explicit MTSafetySupportProvider(const bool& in_enable)
+        explicit RecursiveSpinLock(bool in_allow_recursion = true)
+            :m_state          (STATE_UNLOCKED),
+             m_n_recursions   (0),
+             m_allow_recursion(in_allow_recursion),
+             m_owner_thread_id(std::thread::id() )
+        {
+            /* Stub */
+        }
+
+        void lock()
+        {
+            const std::thread::id this_thread_id = std::this_thread::get_id();
+
+            /* Only the calling thread could have stored its own ID, so a relaxed load is sufficient here. */
+            if (m_owner_thread_id.load(std::memory_order_relaxed) == this_thread_id)
+            {
+                anvil_assert(m_allow_recursion);
+                anvil_assert(m_n_recursions < UINT16_MAX);
+
+                ++m_n_recursions;
+
+                return;
+            }
+
+            if (!try_lock_spinning() )
+            {
+                auto&                        parking_bucket = get_parking_bucket(this);
+                std::unique_lock<std::mutex> parking_lock    (parking_bucket.mutex);
+
+                /* Mark the lock as contended, so that unlock() wakes us up. The bucket mutex is held between the
+                 * exchange and the wait, so the wake-up cannot be missed. */
+                while (m_state.exchange(STATE_LOCKED_CONTENDED,
+                                        std::memory_order_acquire) != STATE_UNLOCKED)
+                {
+                    parking_bucket.condition.wait(parking_lock);
+                }
+            }
+
+            m_owner_thread_id.store(this_thread_id,
+                                    std::memory_order_relaxed);
+        }
+
+        bool try_lock()
+        {
+            const std::thread::id this_thread_id = std::this_thread::get_id();
+            uint32_t              expected_state = STATE_UNLOCKED;
+
+            if (m_owner_thread_id.load(std::memory_order_relaxed) == this_thread_id)
+            {
+                anvil_assert(m_allow_recursion);
+                anvil_assert(m_n_recursions < UINT16_MAX);
+
+                ++m_n_recursions;
+
+                return true;
+            }
+
+            if (m_state.load(std::memory_order_relaxed) != STATE_UNLOCKED                 ||
+               !m_state.compare_exchange_strong(expected_state,
+                                                STATE_LOCKED,
+                                                std::memory_order_acquire) )
+            {
+                return false;
+            }
+
+            m_owner_thread_id.store(this_thread_id,
+                                    std::memory_order_relaxed);
+
+            return true;
+        }
+
+        void unlock()
+        {
+            if (m_n_recursions > 0)
+            {
+                --m_n_recursions;
+
+                return;
+            }
+
+            m_owner_thread_id.store(std::thread::id(),
+                                    std::memory_order_relaxed);
+
+            if (m_state.exchange(STATE_UNLOCKED,
+                                 std::memory_order_release) == STATE_LOCKED_CONTENDED)
+            {
+                auto&                       parking_bucket = get_parking_bucket(this);
+                std::lock_guard<std::mutex> parking_lock    (parking_bucket.mutex);
+
+                /* Buckets are shared between locks, so the woken up threads may be waiting for a different lock. */
+                parking_bucket.condition.notify_all();
+            }
+        }
+
+    private:
+        /* Private type definitions */
+        struct ParkingBucket
+        {
+            std::condition_variable condition;
+            std::mutex              mutex;
+        };
+
+        /* Private functions */
+
+        /** Returns the bucket threads waiting for @param in_lock_ptr are parked on. */
+        static ParkingBucket& get_parking_bucket(const RecursiveSpinLock* in_lock_ptr)
+        {
+            static ParkingBucket parking_buckets[N_PARKING_BUCKETS];
+
+            return parking_buckets[(reinterpret_cast<uintptr_t>(in_lock_ptr) / sizeof(RecursiveSpinLock) ) % N_PARKING_BUCKETS];
+        }
+
+        /** Spins for a while, trying to take an uncontended lock.
+         *
+         *  @return true if the lock has been taken, false if the spin budget has been exhausted.
+         **/
+        bool try_lock_spinning()
         {
-            if (in_enable)
+            for (uint32_t n_attempt = 0;
+                          n_attempt < N_SPINS_BEFORE_PARKING;
+                        ++n_attempt)
             {
-                m_mutex_ptr.reset(
-                    new std::recursive_mutex()
-                );
+                uint32_t expected_state = STATE_UNLOCKED;
+
+                if (m_state.load(std::memory_order_relaxed) == STATE_UNLOCKED                 &&
+                    m_state.compare_exchange_weak(expected_state,
+                                                  STATE_LOCKED,
+                                                  std::memory_order_acquire) )
+                {
+                    return true;
+                }
             }
+
+            return false;
+        }
+
+        /* Private variables */
+        static const uint32_t N_PARKING_BUCKETS      = 64;
+        static const uint32_t N_SPINS_BEFORE_PARKING = 128;
+
+        static const uint32_t STATE_UNLOCKED         = 0;
+        static const uint32_t STATE_LOCKED           = 1;
+        static const uint32_t STATE_LOCKED_CONTENDED = 2;
+
+        std::atomic<uint32_t>        m_state;
+        uint16_t                     m_n_recursions;
+        bool                         m_allow_recursion;
+        std::atomic<std::thread::id> m_owner_thread_id;
+
+        RecursiveSpinLock           (const RecursiveSpinLock&);
+        RecursiveSpinLock& operator=(const RecursiveSpinLock&);
+    };
+
+    class MTSafetySupportProvider
+    {
+    public:
+        /** Constructor.
+         *
+         *  @param in_enable            true if the object should be made MT-safe, false otherwise.
+         *  @param in_is_lock_recursive true if the object may re-enter its lock from within a locked section.
+         *                              Objects which never do should pass false, so that accidental re-entrancy
+         *                              is caught by an assertion.
+         **/
+        explicit MTSafetySupportProvider(const bool& in_enable,
+                                         const bool& in_is_lock_recursive = true)
+            :m_is_mt_safe(in_enable),
+             m_lock      (in_is_lock_recursive)
+        {
+            /* Stub */
         }
 
         virtual ~MTSafetySupportProvider()
@@ -47,33 +229,34 @@ namespace Anvil
 
         inline bool is_mt_safe() const
         {
-            return (m_mutex_ptr != nullptr);
+            return m_is_mt_safe;
         }
 
         inline void lock() const
         {
-            if (m_mutex_ptr != nullptr)
+            if (m_is_mt_safe)
             {
-                m_mutex_ptr->lock();
+                m_lock.lock();
             }
         }
 
         inline void unlock() const
         {
-            if (m_mutex_ptr != nullptr)
+            if (m_is_mt_safe)
             {
-                m_mutex_ptr->unlock();
+                m_lock.unlock();
             }
         }
 
     protected:
-        std::recursive_mutex* get_mutex() const
+        Anvil::RecursiveSpinLock* get_mutex() const
         {
-            return m_mutex_ptr.get();
+            return (m_is_mt_safe) ? &m_lock : nullptr;
         }
 
     private:
-        std::unique_ptr<std::recursive_mutex> m_mutex_ptr;
+        bool                             m_is_mt_safe;
+        mutable Anvil::RecursiveSpinLock m_lock;
 
         MTSafetySupportProvider           (const MTSafetySupportProvider&);
         MTSafetySupportProvider& operator=(const MTSafetySupportProvider&) const;
@@ -32,11 +32,17 @@
  *  ObjectTracker::check_for_leaks() to determine, if there are any wrapper objects alive. If so,
  *  brief info on each such instance will be printed out to stdout.
  *
- *  Object Tracker is thread-safe.
+ *  Object Tracker is thread-safe. Registrations are spread across a number of shards, each protected
+ *  by its own lock, so that objects created & released on different threads rarely contend. Releasing
+ *  an object takes constant time.
+ *
+ *  If Anvil is built with ANVIL_LEAN_RELEASE, allocations are not tracked. Call-backs are still issued,
+ *  but check_for_leaks() reports nothing and get_object_at_index() always returns null.
  **/
 #ifndef MISC_OBJECT_TRACKER_H
 #define MISC_OBJECT_TRACKER_H
 
+#include <atomic>
 #include <unordered_map>
 #include <vector>
 #include "misc/callbacks.h"
@@ -187,18 +193,38 @@ namespace Anvil
 
         typedef std::vector<ObjectAllocation> ObjectAllocations;
 
+        /** Holds all alive objects of a single type, which have been assigned to a shard.
+         *
+         *  Allocations are stored densely. On release, the last allocation is moved into the slot
+         *  of the released one, and its index is updated accordingly.
+         */
+        typedef struct ShardTypeAllocations
+        {
+            ObjectAllocations                   allocations;
+            std::unordered_map<void*, uint32_t> object_ptr_to_allocation_index_map;
+        } ShardTypeAllocations;
+
+        typedef struct Shard
+        {
+            std::mutex                                        cs;
+            std::map<Anvil::ObjectType, ShardTypeAllocations> type_allocations;
+        } Shard;
+
         /* Private functions */
         ObjectTracker           ();
         ObjectTracker           (const ObjectTracker&);
         ObjectTracker& operator=(const ObjectTracker&);
 
+        Shard&      get_shard           (const void*       in_object_ptr) const;
         const char* get_object_type_name(const ObjectType& in_object_type) const;
+        bool        release_allocation  (const ObjectType& in_object_type,
+                                         void*             in_object_ptr);
 
         /* Private members */
-        mutable std::mutex m_cs;
+        static const uint32_t N_SHARDS = 16;
 
-        mutable std::map<Anvil::ObjectType, ObjectAllocations>  m_object_allocations;
-        std::map<Anvil::ObjectType, uint32_t>                   m_n_objects_allocated_array;
+        std::atomic<uint32_t> m_n_objects_allocated;
+        mutable Shard         m_shards[N_SHARDS];
     };
 }; /* namespace Anvil */
 
@@ -28,10 +28,32 @@
 
 namespace Anvil
 {
-    /** Tracks memory page bindings for sparse images & sparse buffers */
+    /** Tracks memory page bindings for sparse images & sparse buffers.
+     *
+     *  Bindings are kept in an interval map keyed by start offset, so that lookups and binding updates
+     *  take O(log n) time, where n is the number of disjoint bindings. Page occupancy is tracked in a bitset,
+     *  which is updated & queried a 32-bit word at a time.
+     **/
     class PageTracker
     {
     public:
+        /* Public type definitions */
+
+        /** A range of the tracked region, all pages of which have memory backing. */
+        typedef struct ResidentRange
+        {
+            VkDeviceSize size;
+            VkDeviceSize start_offset;
+
+            ResidentRange(VkDeviceSize in_start_offset,
+                          VkDeviceSize in_size)
+                :size        (in_size),
+                 start_offset(in_start_offset)
+            {
+                /* Stub */
+            }
+        } ResidentRange;
+
         /* Public functions */
 
         /** Constructor.
@@ -64,17 +86,14 @@ namespace Anvil
          *  This function can be used to retrieve a memory block, bound to a descriptor
          *  at a given index (@param in_n_memory_block).
          *
+         *  Descriptors are ordered by start offset. This call is linear in @param in_n_memory_block.
+         *
          *  @param in_n_memory_block See above. Must not be equal or larger than value returned
          *                           by get_n_memory_blocks().
          *
          *  @return The requested memory block.
          */
-        Anvil::MemoryBlock* get_memory_block(uint32_t in_n_memory_block) const
-        {
-            anvil_assert(in_n_memory_block < m_memory_blocks.size() );
-
-            return m_memory_blocks.at(in_n_memory_block).memory_block_ptr;
-        }
+        Anvil::MemoryBlock* get_memory_block(uint32_t in_n_memory_block) const;
 
         /** Returns the number of disjoint memory blocks */
         uint32_t get_n_memory_blocks() const
@@ -94,6 +113,27 @@ namespace Anvil
             return m_n_pages_with_memory_backing;
         }
 
+        /** Returns the number of pages within the region <in_start_offset, in_start_offset + in_size>
+         *  that have been assigned non-null memory blocks.
+         *
+         *  @param in_start_offset Start offset of the region. Must be page-aligned.
+         *  @param in_size         Size of the region. Must not exceed the tracked region's boundaries.
+         **/
+        uint32_t get_n_pages_with_memory_backing(VkDeviceSize in_start_offset,
+                                                 VkDeviceSize in_size) const;
+
+        /** Retrieves all ranges of the region <in_start_offset, in_start_offset + in_size> which have been assigned
+         *  non-null memory blocks. Adjacent bindings are coalesced into a single range, regardless of which memory
+         *  blocks back them. Ranges are clipped to the requested region and sorted by start offset.
+         *
+         *  @param in_start_offset Start offset of the region. Does not need to be page-aligned.
+         *  @param in_size         Size of the region.
+         *  @param out_result_ptr  Deref will be filled with the ranges. Must not be null.
+         **/
+        void get_resident_ranges(VkDeviceSize                in_start_offset,
+                                 VkDeviceSize                in_size,
+                                 std::vector<ResidentRange>* out_result_ptr) const;
+
         /* Returns page size, as recognized by the page tracker */
         VkDeviceSize get_page_size() const
         {
@@ -140,11 +180,20 @@ namespace Anvil
             }
         } MemoryBlockBinding;
 
+        /* Maps start offsets to disjoint, non-null memory block bindings. */
+        typedef std::map<VkDeviceSize, MemoryBlockBinding> MemoryBlockBindingMap;
+
         /* Private functions */
 
+        /** Flips occupancy bits of pages <in_n_first_page, in_n_first_page + in_n_pages> to @param in_has_memory_backing,
+         *  a 32-bit word at a time, and adjusts the number of memory-backed pages by the number of flipped bits.
+         **/
+        void update_page_occupancy(uint32_t in_n_first_page,
+                                   uint32_t in_n_pages,
+                                   bool     in_has_memory_backing);
+
         /* Private variables */
-        std::vector<MemoryBlockBinding>  m_memory_blocks;
-        uint32_t                         m_n_memory_blocks_with_memory_backing;
+        MemoryBlockBindingMap            m_memory_blocks;
         uint32_t                         m_n_pages_with_memory_backing;
         uint32_t                         m_n_total_pages;
         VkDeviceSize                     m_page_size;
@@ -0,0 +1,207 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements a helper which records the draw calls of a single subpass from multiple threads.
+ *
+ *  record() splits the work into a user-specified number of jobs, and runs them on the recorder's worker
+ *  threads. Each job records into its own secondary command buffer, which has its inheritance info filled
+ *  for the specified render pass, subpass and framebuffer. Once all jobs finish, the secondary command buffers
+ *  are stitched into the primary command buffer with a single record_execute_commands() call, in job order.
+ *
+ *  Each worker thread owns a separate transient command pool for every frame slot, so allocating and
+ *  recording command buffers never contends with other threads. begin_frame() moves to the next frame
+ *  slot and resets all of its pools at once. If a fence has been associated with the slot, the function
+ *  first waits until it is signalled. Command buffer wrappers are retained and reused in later frames.
+ *
+ *  Parallel command recorder is NOT thread-safe. record() and begin_frame() must be called from one thread
+ *  at a time.
+ */
+#ifndef MISC_PARALLEL_COMMAND_RECORDER_H
+#define MISC_PARALLEL_COMMAND_RECORDER_H
+
+#include "misc/types.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+
+namespace Anvil
+{
+    class ParallelCommandRecorder
+    {
+    public:
+        /* Public type definitions */
+
+        /** Function called from a worker thread to record a job.
+         *
+         *  @param in_cmd_buffer_ptr Secondary command buffer to record the job's commands into. Recording is
+         *                           already in progress. The callback must not start or stop it.
+         *  @param in_n_job          Index of the job, from 0 to the number of jobs passed to record() - 1.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        typedef std::function<bool(Anvil::SecondaryCommandBuffer* in_cmd_buffer_ptr,
+                                   uint32_t                       in_n_job)> RecordCallback;
+
+        /* Public functions */
+
+        /** Creates a new parallel command recorder instance and spawns its worker threads.
+         *
+         *  @param in_device_ptr         Device to create the recorder for. Must not be null.
+         *  @param in_queue_family_index Index of the queue family the primary command buffers are going to be
+         *                               submitted to.
+         *  @param in_n_frames_in_flight Number of frames which can be in flight at any given time. Must not be 0.
+         *  @param in_n_threads          Number of worker threads to use. If 0, the number of available hardware
+         *                               threads is used.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::ParallelCommandRecorderUniquePtr create(Anvil::BaseDevice* in_device_ptr,
+                                                              uint32_t           in_queue_family_index,
+                                                              uint32_t           in_n_frames_in_flight,
+                                                              uint32_t           in_n_threads = 0);
+
+        /** Destructor. Joins the worker threads. The caller must make sure none of the command buffers
+         *  is still executing. */
+        ~ParallelCommandRecorder();
+
+        /** Moves to the next frame slot and resets all command pools created for it.
+         *
+         *  @param in_opt_fence_ptr If not null, the fence must be signalled by the app once the GPU finishes
+         *                          executing all the primary command buffers the frame's jobs have been recorded
+         *                          into. The next time the slot is about to be recycled, the function is going
+         *                          to wait on it.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool begin_frame(Anvil::Fence* in_opt_fence_ptr = nullptr);
+
+        /** Returns the number of worker threads used by the recorder. */
+        uint32_t get_n_threads() const
+        {
+            return static_cast<uint32_t>(m_threads.size() );
+        }
+
+        /** Records @param in_n_jobs jobs in parallel and executes the resulting secondary command buffers
+         *  from @param in_cmd_buffer_ptr. Blocks until all jobs finish.
+         *
+         *  @param in_cmd_buffer_ptr                         Primary command buffer to execute the jobs from. Must be
+         *                                                   recording and have the subpass @param in_subpass_id of
+         *                                                   @param in_render_pass_ptr active, with contents set to
+         *                                                   SubpassContents::SECONDARY_COMMAND_BUFFERS.
+         *  @param in_framebuffer_ptr                        Framebuffer the render pass has been started with.
+         *  @param in_render_pass_ptr                        Render pass the jobs are going to be executed in. Must
+         *                                                   not be null.
+         *  @param in_subpass_id                             Subpass the jobs are going to be executed in.
+         *  @param in_n_jobs                                 Number of jobs to run. Each job gets its own command
+         *                                                   buffer. Usually a small multiple of get_n_threads().
+         *  @param in_callback                               Function to call for each job. May be called from
+         *                                                   multiple threads at the same time.
+         *  @param in_required_occlusion_query_support_scope Inheritance info, as per SecondaryCommandBuffer::start_recording().
+         *  @param in_occlusion_query_used_by_primary        Inheritance info, as per SecondaryCommandBuffer::start_recording().
+         *  @param in_required_pipeline_statistics_scope     Inheritance info, as per SecondaryCommandBuffer::start_recording().
+         *
+         *  @return true if all jobs succeeded and the secondary command buffers have been executed, false otherwise.
+         */
+        bool record(Anvil::PrimaryCommandBuffer*       in_cmd_buffer_ptr,
+                    Anvil::Framebuffer*                in_framebuffer_ptr,
+                    Anvil::RenderPass*                 in_render_pass_ptr,
+                    Anvil::SubPassID                   in_subpass_id,
+                    uint32_t                           in_n_jobs,
+                    RecordCallback                     in_callback,
+                    Anvil::OcclusionQuerySupportScope  in_required_occlusion_query_support_scope = Anvil::OcclusionQuerySupportScope::NOT_REQUIRED,
+                    bool                               in_occlusion_query_used_by_primary        = false,
+                    Anvil::QueryPipelineStatisticFlags in_required_pipeline_statistics_scope     = Anvil::QueryPipelineStatisticFlagBits::NONE);
+
+    private:
+        /* Private type definitions */
+        typedef struct Batch
+        {
+            RecordCallback                              callback;
+            std::vector<Anvil::SecondaryCommandBuffer*> cmd_buffers;
+            Anvil::Framebuffer*                         framebuffer_ptr;
+            bool                                        has_failed;
+            uint32_t                                    n_jobs_finished;
+            uint32_t                                    n_next_job;
+            bool                                        occlusion_query_used_by_primary;
+            Anvil::RenderPass*                          render_pass_ptr;
+            Anvil::OcclusionQuerySupportScope           required_occlusion_query_support_scope;
+            Anvil::QueryPipelineStatisticFlags          required_pipeline_statistics_scope;
+            Anvil::SubPassID                            subpass_id;
+
+            Batch()
+                :framebuffer_ptr                       (nullptr),
+                 has_failed                            (false),
+                 n_jobs_finished                       (0),
+                 n_next_job                            (0),
+                 occlusion_query_used_by_primary       (false),
+                 render_pass_ptr                       (nullptr),
+                 required_occlusion_query_support_scope(Anvil::OcclusionQuerySupportScope::NOT_REQUIRED),
+                 subpass_id                            (0)
+            {
+                /* Stub */
+            }
+        } Batch;
+
+        typedef struct Frame
+        {
+            Anvil::CommandPoolUniquePtr                         command_pool_ptr;
+            uint32_t                                            n_used_cmd_buffers;
+            std::vector<Anvil::SecondaryCommandBufferUniquePtr> cmd_buffers;
+
+            Frame()
+                :n_used_cmd_buffers(0)
+            {
+                /* Stub */
+            }
+        } Frame;
+
+        /* Private functions */
+        ParallelCommandRecorder(Anvil::BaseDevice* in_device_ptr,
+                                uint32_t           in_queue_family_index,
+                                uint32_t           in_n_frames_in_flight,
+                                uint32_t           in_n_threads);
+
+        Anvil::SecondaryCommandBuffer* get_cmd_buffer(Frame*   in_frame_ptr);
+        void                           thread_main   (uint32_t in_n_thread);
+
+        /* Private variables */
+        Batch                            m_batch;
+        Anvil::BaseDevice*               m_device_ptr;
+        std::vector<Anvil::Fence*>       m_frame_fences;
+        std::vector<std::vector<Frame> > m_frames; /* [n_thread][n_frame] */
+        uint32_t                         m_n_current_frame;
+        const uint32_t                   m_queue_family_index;
+        bool                             m_should_quit;
+        std::vector<std::thread>         m_threads;
+
+        std::condition_variable          m_done_cv;
+        std::mutex                       m_mutex;
+        std::condition_variable          m_wake_cv;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(ParallelCommandRecorder);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(ParallelCommandRecorder);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_PARALLEL_COMMAND_RECORDER_H */
@@ -0,0 +1,102 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Records GPU-to-GPU copies between physical devices of a mGPU device.
+ *
+ *  Copies are recorded between a resource and its peer view, as configured with
+ *  MemoryAllocator::add_peer_accessible_buffer() or MemoryAllocator::add_peer_accessible_image().
+ *  Only the physical device selected by the caller executes the copy. The device mask is
+ *  narrowed down to that device for the barriers & the copy, and restored afterwards.
+ *
+ *  Barriers recorded by these helpers are device-local. They make the copy's writes available
+ *  on the executing device. If a different physical device consumes the data, apps must order
+ *  the copy against the consumer with a semaphore, or a submission boundary whose device indices
+ *  cover both devices.
+ */
+#ifndef MISC_PEER_COPY_H
+#define MISC_PEER_COPY_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class PeerCopy
+    {
+    public:
+        /* Public functions */
+
+        /** Records a copy from @param in_src_buffer_ptr to @param in_dst_buffer_ptr, executed by physical
+         *  device @param in_n_executing_device only.
+         *
+         *  A barrier making prior writes to the source visible to the copy, and ordering the copy after prior
+         *  accesses to the destination, is recorded before the copy. A barrier making the copy's writes visible
+         *  to @param in_dst_stage_mask / @param in_dst_access_mask is recorded after it.
+         *
+         *  @param in_cmd_buffer_ptr     Command buffer to record commands in. Must not be null.
+         *  @param in_n_executing_device Index of the physical device to execute the copy.
+         *  @param in_src_buffer_ptr     Buffer to copy from. Must not be null.
+         *  @param in_dst_buffer_ptr     Buffer to copy to. Must not be null.
+         *  @param in_n_regions          Number of regions under @param in_regions_ptr.
+         *  @param in_regions_ptr        Regions to copy. Must not be null.
+         *  @param in_dst_stage_mask     Pipeline stages which consume the copied data.
+         *  @param in_dst_access_mask    Access types which consume the copied data.
+         *  @param in_final_device_mask  Device mask to restore before leaving.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        static bool record_buffer_copy(Anvil::CommandBufferBase*  in_cmd_buffer_ptr,
+                                       uint32_t                   in_n_executing_device,
+                                       Anvil::Buffer*             in_src_buffer_ptr,
+                                       Anvil::Buffer*             in_dst_buffer_ptr,
+                                       uint32_t                   in_n_regions,
+                                       const Anvil::BufferCopy*   in_regions_ptr,
+                                       Anvil::PipelineStageFlags  in_dst_stage_mask,
+                                       Anvil::AccessFlags         in_dst_access_mask,
+                                       uint32_t                   in_final_device_mask);
+
+        /** Image counterpart of record_buffer_copy().
+         *
+         *  Layouts are not changed. The source image must be in @param in_src_image_layout and the destination
+         *  image must be in @param in_dst_image_layout at the time the copy executes. Both layouts must be valid
+         *  for vkCmdCopyImage().
+         **/
+        static bool record_image_copy(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                      uint32_t                  in_n_executing_device,
+                                      Anvil::Image*             in_src_image_ptr,
+                                      Anvil::ImageLayout        in_src_image_layout,
+                                      Anvil::Image*             in_dst_image_ptr,
+                                      Anvil::ImageLayout        in_dst_image_layout,
+                                      uint32_t                  in_n_regions,
+                                      const Anvil::ImageCopy*   in_regions_ptr,
+                                      Anvil::PipelineStageFlags in_dst_stage_mask,
+                                      Anvil::AccessFlags        in_dst_access_mask,
+                                      uint32_t                  in_final_device_mask);
+
+    private:
+        /* Private functions */
+        static bool is_executing_device_valid(const Anvil::BaseDevice* in_device_ptr,
+                                              uint32_t                 in_n_executing_device);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_PEER_COPY_H */
@@ -0,0 +1,155 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements a per-draw constants helper, which picks the fastest mechanism available on the device to feed
+ *  a block of constants to shaders.
+ *
+ *  If the block fits within the device's maxPushConstantsSize limit, the data is passed with push constants.
+ *  Otherwise, each record() call writes the data into a TransientBufferAllocator region and binds it as
+ *  a dynamic uniform buffer, using the region's offset as the dynamic offset. One descriptor set is created
+ *  for each chunk buffer of the allocator the first time it is used, so after a few frames no Vulkan objects
+ *  are created on the per-draw path.
+ *
+ *  Shaders can use a single declaration for both cases by defining the block's layout qualifier with
+ *  the string returned by get_glsl_block_layout(), e.g.:
+ *
+ *      PER_DRAW_CONSTANTS_LAYOUT uniform DrawConstants { ... } draw_constants;
+ *
+ *  Pipelines using the constants need to be configured with configure_pipeline(). In the uniform buffer case,
+ *  the pipeline's descriptor set create info vector also needs to hold get_descriptor_set_create_info() at
+ *  the set index specified at creation time.
+ *
+ *  PerDrawConstants is NOT thread-safe.
+ */
+#ifndef MISC_PER_DRAW_CONSTANTS_H
+#define MISC_PER_DRAW_CONSTANTS_H
+
+#include "misc/types.h"
+#include <unordered_map>
+
+
+namespace Anvil
+{
+    class PerDrawConstants
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new per-draw constants helper instance.
+         *
+         *  @param in_device_ptr            Device to create the instance for. Must not be null.
+         *  @param in_size                  Size of the constants block. Must be a multiple of 4 and must not be 0.
+         *  @param in_stages                Shader stages which access the constants.
+         *  @param in_n_set                 Descriptor set index to bind the uniform buffer to, if push constants
+         *                                  cannot be used.
+         *  @param in_uniform_allocator_ptr Allocator to write the constants to, if push constants cannot be used.
+         *                                  Must have been created with UNIFORM_BUFFER_BIT usage. Only accessed
+         *                                  if the block does not fit in push constant space, but must not be
+         *                                  null regardless.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::PerDrawConstantsUniquePtr create(const Anvil::BaseDevice*         in_device_ptr,
+                                                       uint32_t                         in_size,
+                                                       Anvil::ShaderStageFlags          in_stages,
+                                                       uint32_t                         in_n_set,
+                                                       Anvil::TransientBufferAllocator* in_uniform_allocator_ptr);
+
+        /** Destructor. The caller must make sure none of the descriptor sets is still accessed by the GPU. */
+        ~PerDrawConstants();
+
+        /** Attaches the push constant range needed to pass the constants to the specified pipeline. Does nothing
+         *  if the constants are passed via a uniform buffer.
+         *
+         *  @param in_pipeline_create_info_ptr Pipeline create info to update. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool configure_pipeline(Anvil::BasePipelineCreateInfo* in_pipeline_create_info_ptr) const;
+
+        /** Returns the layout of the descriptor set the uniform buffer is bound to, or null if the constants
+         *  are passed with push constants.
+         */
+        const Anvil::DescriptorSetCreateInfo* get_descriptor_set_create_info() const;
+
+        /** Returns the layout qualifier to declare the constants block with in GLSL, e.g.
+         *  "layout(push_constant)" or "layout(set = 1, binding = 0)". The string is meant to be passed to
+         *  GLSLShaderToSPIRVGenerator::add_definition_value_pair().
+         */
+        std::string get_glsl_block_layout() const;
+
+        /** Returns the number of descriptor sets created so far. */
+        uint32_t get_n_descriptor_sets() const
+        {
+            return static_cast<uint32_t>(m_dsgs.size() );
+        }
+
+        /** Records commands which make @param in_data_ptr visible to subsequent draw or dispatch calls.
+         *
+         *  The uniform buffer path allocates from the uniform allocator's current frame, so the data stays valid
+         *  until the allocator recycles the frame slot.
+         *
+         *  @param in_cmd_buffer_ptr      Command buffer to record the commands to. Must not be null.
+         *  @param in_pipeline_bind_point Bind point of the pipeline the constants are going to be used with.
+         *  @param in_layout_ptr          Layout of that pipeline. Must not be null.
+         *  @param in_data_ptr            Constants to use. Must hold as many bytes as specified at creation time.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                    Anvil::PipelineBindPoint  in_pipeline_bind_point,
+                    Anvil::PipelineLayout*    in_layout_ptr,
+                    const void*               in_data_ptr);
+
+        /** Tells whether the constants are passed with push constants (true) or via a uniform buffer (false). */
+        bool uses_push_constants() const
+        {
+            return m_uses_push_constants;
+        }
+
+    private:
+        /* Private functions */
+        PerDrawConstants(const Anvil::BaseDevice*         in_device_ptr,
+                         uint32_t                         in_size,
+                         Anvil::ShaderStageFlags          in_stages,
+                         uint32_t                         in_n_set,
+                         Anvil::TransientBufferAllocator* in_uniform_allocator_ptr);
+
+        bool init();
+
+        /* Private variables */
+        const Anvil::BaseDevice*                                               m_device_ptr;
+        std::unordered_map<Anvil::Buffer*, Anvil::DescriptorSetGroupUniquePtr> m_dsgs;
+        const uint32_t                                                         m_n_set;
+        Anvil::DescriptorSetGroupUniquePtr                                     m_parent_dsg_ptr;
+        const uint32_t                                                         m_size;
+        const Anvil::ShaderStageFlags                                          m_stages;
+        Anvil::TransientBufferAllocator*                                       m_uniform_allocator_ptr;
+        bool                                                                   m_uses_push_constants;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(PerDrawConstants);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(PerDrawConstants);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_PER_DRAW_CONSTANTS_H */
@@ -0,0 +1,125 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements cheap, always-on counters of Vulkan work issued through Anvil, meant to drive performance dashboards.
+ *
+ *  Anvil increments the counters from the following places:
+ *
+ *  - CommandBufferBase::stop_recording():      vkCmd* calls and pipeline binds recorded into the command buffer.
+ *                                              The per-command buffer count is available from
+ *                                              CommandBufferBase::get_n_recorded_commands().
+ *  - Queue::submit():                          vkQueueSubmit() calls.
+ *  - DescriptorSet::update() & update_multi(): descriptor set updates which had dirty bindings to flush.
+ *  - Buffer and Image creation:                vkCreateBuffer() and vkCreateImage() calls.
+ *  - MemoryBlock::write() & host image copies: bytes written to device memory by the host. This covers Buffer::write()
+ *                                              and image uploads, including the staging copies they make. Writes
+ *                                              made by the application through pointers to mapped memory are not
+ *                                              included.
+ *
+ *  Each thread increments its own shard of the counters with relaxed atomic adds, so that threads do not contend with
+ *  each other. get_snapshot() sums all shards up. Shards outlive the threads which own them.
+ *
+ *  A typical per-frame use is to call get_snapshot(true) once per frame, which returns the counter values accumulated
+ *  since the previous call and resets them.
+ *
+ *  PerfCounters is thread-safe.
+ */
+#ifndef MISC_PERF_COUNTERS_H
+#define MISC_PERF_COUNTERS_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    /** Values of all counters, as returned by PerfCounters::get_snapshot(). */
+    typedef struct PerfCountersSnapshot
+    {
+        uint64_t n_buffers_created;
+        uint64_t n_command_buffer_commands;
+        uint64_t n_command_buffers_recorded;
+        uint64_t n_descriptor_set_updates;
+        uint64_t n_images_created;
+        uint64_t n_pipeline_binds;
+        uint64_t n_queue_submissions;
+        uint64_t n_uploaded_bytes;
+
+        PerfCountersSnapshot()
+        {
+            n_buffers_created          = 0;
+            n_command_buffer_commands  = 0;
+            n_command_buffers_recorded = 0;
+            n_descriptor_set_updates   = 0;
+            n_images_created           = 0;
+            n_pipeline_binds           = 0;
+            n_queue_submissions        = 0;
+            n_uploaded_bytes           = 0;
+        }
+    } PerfCountersSnapshot;
+
+    class PerfCounters
+    {
+    public:
+        /* Public type definitions */
+        enum class Counter
+        {
+            BUFFERS_CREATED,
+            COMMAND_BUFFER_COMMANDS,
+            COMMAND_BUFFERS_RECORDED,
+            DESCRIPTOR_SET_UPDATES,
+            IMAGES_CREATED,
+            PIPELINE_BINDS,
+            QUEUE_SUBMISSIONS,
+            UPLOADED_BYTES,
+
+            COUNT
+        };
+
+        /* Public functions */
+
+        /** Returns the sum of all counter shards.
+         *
+         *  @param in_should_reset True to reset the counters to zero at the same time. Increments which happen
+         *                         concurrently are either included in the returned values, or retained for the next
+         *                         snapshot. None are lost.
+         *
+         *  @return As per description.
+         */
+        static Anvil::PerfCountersSnapshot get_snapshot(bool in_should_reset = false);
+
+        /** Adds @param in_value to the calling thread's shard of @param in_counter. Called by Anvil. */
+        static void increment(Counter  in_counter,
+                              uint64_t in_value = 1);
+
+        /** Resets all counters to zero. */
+        static void reset();
+
+    private:
+        PerfCounters();
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(PerfCounters);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(PerfCounters);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_PERF_COUNTERS_H */
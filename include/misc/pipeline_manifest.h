@@ -0,0 +1,218 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements capture & replay of pipeline create info, used to pre-populate pipeline caches offline.
+ *
+ *  A manifest records every pipeline added to the pipeline managers it has been attached to, together with
+ *  everything necessary to re-create the pipeline on another device:
+ *
+ *  - SPIR-V blobs of the shader modules used, stored once per blob and referenced by their 64-bit hash.
+ *  - Descriptions of the render passes used, stored once per render pass compatibility class. Attachment formats,
+ *    sample counts, subpass structure, dependencies and multiview configuration are recorded.
+ *  - Descriptor set layouts, push constant ranges, specialization constants and the complete fixed-function state.
+ *
+ *  Identical pipelines are only recorded once. store_to_file() writes the manifest to a binary file, which can be
+ *  loaded with create_from_file() and replayed with replay(). Replaying a manifest re-creates all the objects and
+ *  bakes each pipeline using the pipeline cache specified by the caller, which can then be written to disk with
+ *  PipelineCache::store_to_file(). The anvil_pipeline_prewarm tool does exactly that.
+ *
+ *  If usage profiling has been enabled for the attached pipeline managers (see
+ *  BasePipelineManager::set_usage_profiling_enabled() ), the manifest also captures how often and since which frame
+ *  each recorded pipeline has been bound. The profile is stored alongside the pipelines, accumulates over sessions
+ *  recorded into the same manifest, and makes replay() bake the earliest and most frequently used pipelines first.
+ *
+ *  Limitations:
+ *
+ *  - Immutable samplers are not recorded. Bindings which use them are replayed without immutable samplers.
+ *  - The base pipeline of derivative pipelines is not recorded. Such pipelines are replayed as regular pipelines.
+ *  - Proxy pipelines are ignored.
+ *
+ *  Pipeline manifest is NOT thread-safe, unless created with @param in_mt_safe set to true. Manifests attached to
+ *  a pipeline manager which compiles pipelines from multiple threads should be thread-safe.
+ */
+#ifndef MISC_PIPELINE_MANIFEST_H
+#define MISC_PIPELINE_MANIFEST_H
+
+#include "misc/base_pipeline_manager.h"
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+#include <map>
+#include <unordered_map>
+
+
+namespace Anvil
+{
+    class PipelineManifest : public MTSafetySupportProvider
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new, empty pipeline manifest instance.
+         *
+         *  @param in_mt_safe True if the instance should be thread-safe.
+         *
+         *  @return New instance.
+         */
+        static Anvil::PipelineManifestUniquePtr create(bool in_mt_safe = false);
+
+        /** Creates a new pipeline manifest instance, initialized with contents of a file written by an earlier
+         *  store_to_file() call.
+         *
+         *  @param in_filename Name of the file to load.
+         *  @param in_mt_safe  True if the instance should be thread-safe.
+         *
+         *  @return New instance if successful, null if the file could not be read or is malformed.
+         */
+        static Anvil::PipelineManifestUniquePtr create_from_file(const std::string& in_filename,
+                                                                 bool               in_mt_safe = false);
+
+        /** Destructor. Detaches the manifest from all pipeline managers it is still attached to. */
+        ~PipelineManifest();
+
+        /** Records the specified pipeline.
+         *
+         *  @param in_pipeline_create_info_ptr Create info of the pipeline to record. Must not be null. Proxy pipelines
+         *                                     are ignored.
+         *  @param out_opt_n_pipeline_ptr      If not null, deref will be set to the index of the recorded pipeline
+         *                                     if the function succeeds.
+         *
+         *  @return true if the pipeline has been recorded, or an identical pipeline had been recorded earlier.
+         *          false otherwise.
+         */
+        bool add_pipeline(const Anvil::BasePipelineCreateInfo* in_pipeline_create_info_ptr,
+                          uint32_t*                            out_opt_n_pipeline_ptr = nullptr);
+
+        /** Starts recording all pipelines added to the specified pipeline manager. Pipelines added to the manager
+         *  before this call are not recorded.
+         *
+         *  The manager must not be released before detach() is called, or before the manifest is released.
+         *
+         *  @param in_pipeline_manager_ptr Pipeline manager to attach to. Must not be null.
+         */
+        void attach(Anvil::BasePipelineManager* in_pipeline_manager_ptr);
+
+        /** Merges bind statistics gathered by all attached pipeline managers since the last capture into the usage
+         *  profile of the recorded pipelines. Only pipelines recorded while the manifest was attached are accounted
+         *  for. The statistics are only gathered while usage profiling is enabled for the manager.
+         *
+         *  Called implicitly by detach(), which is also invoked for all attached managers at destruction time.
+         *  Call this function explicitly before store_to_file() if the manifest is stored while still attached.
+         */
+        void capture_usage();
+
+        /** Stops recording pipelines added to the specified pipeline manager. Usage statistics gathered by the manager
+         *  are captured before the manifest detaches.
+         *
+         *  @param in_pipeline_manager_ptr Pipeline manager to detach from. The manifest must have been attached to it.
+         */
+        void detach(Anvil::BasePipelineManager* in_pipeline_manager_ptr);
+
+        /** Returns the number of recorded pipelines. */
+        uint32_t get_n_pipelines() const;
+
+        /** Returns the number of recorded pipelines which have been bound at least once while usage profiling was
+         *  enabled. */
+        uint32_t get_n_profiled_pipelines() const;
+
+        /** Returns the number of recorded render pass descriptions. */
+        uint32_t get_n_render_passes() const;
+
+        /** Returns the number of recorded SPIR-V blobs. */
+        uint32_t get_n_spirv_blobs() const;
+
+        /** Re-creates and bakes all recorded pipelines on the specified device, so that the pipeline cache they are
+         *  baked with gets populated. The pipelines are released before the function returns.
+         *
+         *  Pipelines are created in the order of their first use, as captured in the usage profile. Pipelines used
+         *  in the same frame are ordered by their bind count, most frequently bound ones first. Pipelines which have
+         *  never been bound follow in the order they have been recorded.
+         *
+         *  Pipelines which fail to bake (eg. because they require an extension the device does not support) are
+         *  skipped.
+         *
+         *  @param in_device_ptr                 Device to create the pipelines on. Must not be null.
+         *  @param in_opt_pipeline_cache_ptr     Pipeline cache to bake the pipelines with. If null, the device's
+         *                                       pipeline cache is used.
+         *  @param out_opt_n_pipelines_baked_ptr If not null, deref will be set to the number of pipelines which have
+         *                                       been baked successfully.
+         *
+         *  @return true if all recorded pipelines have been baked successfully, false otherwise.
+         */
+        bool replay(Anvil::BaseDevice*    in_device_ptr,
+                    Anvil::PipelineCache* in_opt_pipeline_cache_ptr,
+                    uint32_t*             out_opt_n_pipelines_baked_ptr = nullptr) const;
+
+        /** Writes the manifest to a binary file.
+         *
+         *  @param in_filename Name of the file to write. Existing contents are discarded.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool store_to_file(const std::string& in_filename) const;
+
+    private:
+        /* Private type definitions */
+        typedef std::vector<uint32_t> Words;
+
+        typedef struct TrackedPipeline
+        {
+            uint32_t n_binds_captured;
+            uint32_t n_pipeline;
+
+            explicit TrackedPipeline(uint32_t in_n_pipeline)
+                :n_binds_captured(0),
+                 n_pipeline      (in_n_pipeline)
+            {
+                /* Stub */
+            }
+        } TrackedPipeline;
+
+        typedef std::pair<Anvil::BasePipelineManager*, Anvil::PipelineID> TrackedPipelineKey;
+
+        /* Private functions */
+        explicit PipelineManifest(bool in_mt_safe);
+
+        void capture_usage       (Anvil::BasePipelineManager*          in_pipeline_manager_ptr);
+        bool load                (const Words&                         in_words);
+        void on_new_pipeline     (Anvil::BasePipelineManager*          in_pipeline_manager_ptr,
+                                  Anvil::CallbackArgument*             in_callback_arg_ptr);
+        bool record_pipeline     (const Anvil::BasePipelineCreateInfo* in_pipeline_create_info_ptr,
+                                  Words*                               out_words_ptr);
+        void record_render_pass  (const Anvil::RenderPassCreateInfo*   in_render_pass_create_info_ptr);
+        void record_shader_module(const Anvil::ShaderModule*           in_shader_module_ptr);
+
+        /* Private variables */
+        std::vector<Anvil::BasePipelineManager*>               m_attached_pipeline_managers;
+        std::unordered_map<uint64_t, uint32_t>                 m_pipeline_hashes;
+        std::vector<Anvil::BasePipelineManager::PipelineUsage> m_pipeline_usage;
+        std::vector<Words>                                     m_pipelines;
+        std::unordered_map<uint64_t, Words>                    m_render_passes;
+        std::unordered_map<uint64_t, Words>                    m_spirv_blobs;
+        std::map<TrackedPipelineKey, TrackedPipeline>          m_tracked_pipelines;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(PipelineManifest);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(PipelineManifest);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_PIPELINE_MANIFEST_H */
@@ -0,0 +1,247 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements a per-pass pipeline statistics & occlusion query profiler.
+ *
+ *  Every pass is bracketed with a pipeline statistics query and an occlusion query. Results are aggregated by
+ *  pass name, so that all instances of a pass recorded for a single frame add up to a single entry. The counters
+ *  help tell apart vertex-bound passes (many vertex shader invocations per fragment shader invocation) from passes
+ *  which suffer from overdraw (many more fragment shader invocations than samples which eventually pass the depth
+ *  & stencil tests).
+ *
+ *  Passes can be begun and ended explicitly with begin_pass() and end_pass(), eg. to measure compute work. Render
+ *  passes can also be bracketed automatically by assigning the profiler to a primary command buffer with
+ *  PrimaryCommandBuffer::set_pipeline_statistics_profiler(). Secondary command buffers executed within such
+ *  render passes must be started with occlusion query support and pipeline statistics matching
+ *  get_pipeline_statistics().
+ *
+ *  Vulkan forbids nesting queries of the same type, so passes cannot be nested.
+ *
+ *  The profiler owns a pipeline statistics and an occlusion query pool, each split into one range per frame slot.
+ *  begin_frame() moves to the next slot and reads back the results of the frame which last used it, N frames ago.
+ *  The read never blocks: if any of the frame's results are not available yet, the frame is dropped and accounted
+ *  for by get_n_dropped_frames().
+ *
+ *  If the device does not support pipeline statistics queries, only the occlusion queries are recorded and all
+ *  invocation counters are reported as 0. Occlusion queries are precise if the device supports it.
+ *
+ *  Pipeline statistics profiler is NOT thread-safe.
+ */
+#ifndef MISC_PIPELINE_STATISTICS_PROFILER_H
+#define MISC_PIPELINE_STATISTICS_PROFILER_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class PipelineStatisticsProfiler
+    {
+    public:
+        /* Public type definitions */
+        typedef struct PassStatistics
+        {
+            uint64_t    clipping_primitives;
+            uint64_t    compute_shader_invocations;
+            uint64_t    fragment_shader_invocations;
+            uint64_t    input_assembly_primitives;
+            uint64_t    input_assembly_vertices;
+            uint64_t    vertex_shader_invocations;
+
+            /* Number of samples which passed the depth & stencil tests. */
+            uint64_t    samples_passed;
+
+            std::string name;
+
+            /* Number of times the pass has been recorded for the frame. */
+            uint32_t    n_instances;
+
+            PassStatistics()
+                :clipping_primitives        (0),
+                 compute_shader_invocations (0),
+                 fragment_shader_invocations(0),
+                 input_assembly_primitives  (0),
+                 input_assembly_vertices    (0),
+                 vertex_shader_invocations  (0),
+                 samples_passed             (0),
+                 n_instances                (0)
+            {
+                /* Stub */
+            }
+        } PassStatistics;
+
+        typedef struct FrameStatistics
+        {
+            /* Index of the frame, as counted by begin_frame() calls. */
+            uint64_t                    frame_index;
+
+            /* Statistics of all passes recorded for the frame, in the order the passes were first begun. */
+            std::vector<PassStatistics> passes;
+
+            FrameStatistics()
+                :frame_index(0)
+            {
+                /* Stub */
+            }
+        } FrameStatistics;
+
+        /* Public functions */
+
+        /** Creates a new pipeline statistics profiler instance.
+         *
+         *  @param in_device_ptr              Device to create the profiler for. Must not be null.
+         *  @param in_n_frames_in_flight      Number of frames which can be in flight at any given time. Results of
+         *                                    a frame are read back this many frames later. Must not be 0.
+         *  @param in_n_max_passes_per_frame  Maximum number of passes which can be measured for a single frame. Passes
+         *                                    in excess are not measured. Must not be 0.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::PipelineStatisticsProfilerUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
+                                                                 uint32_t                 in_n_frames_in_flight,
+                                                                 uint32_t                 in_n_max_passes_per_frame = 64);
+
+        /** Destructor. */
+        ~PipelineStatisticsProfiler();
+
+        /** Starts a new frame.
+         *
+         *  Reads back the results of the frame which last used the next frame slot, and then records commands which
+         *  reset the slot's queries into @param in_cmd_buffer_ptr. The command buffer must be submitted before any
+         *  other command buffer which holds the frame's passes.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the reset into. Must be recording and must not have
+         *                           a renderpass active. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool begin_frame(Anvil::CommandBufferBase* in_cmd_buffer_ptr);
+
+        /** Begins a new pass by recording the beginning of both queries into @param in_cmd_buffer_ptr.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the commands into. Must be recording. Must not be null.
+         *  @param in_name           Name of the pass. Passes sharing the name are aggregated.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool begin_pass(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                        const std::string&        in_name);
+
+        /** Ends the pass which has been begun most recently.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the commands into. Must be the command buffer the pass
+         *                           has been begun in. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool end_pass(Anvil::CommandBufferBase* in_cmd_buffer_ptr);
+
+        /** Returns statistics of the last frame whose results have been read back.
+         *
+         *  @param out_opt_is_valid_ptr If not null, deref will be set to true if any frame has been read back so
+         *                              far, or to false otherwise.
+         */
+        const FrameStatistics& get_last_frame_statistics(bool* out_opt_is_valid_ptr = nullptr) const
+        {
+            if (out_opt_is_valid_ptr != nullptr)
+            {
+                *out_opt_is_valid_ptr = m_has_last_frame_statistics;
+            }
+
+            return m_last_frame_statistics;
+        }
+
+        /** Returns the number of frames whose results were unavailable by the time their slot was reused. */
+        uint64_t get_n_dropped_frames() const
+        {
+            return m_n_dropped_frames;
+        }
+
+        /** Returns the occlusion query flags secondary command buffers executed within measured render passes
+         *  need to be started with. */
+        Anvil::QueryControlFlags get_occlusion_query_flags() const
+        {
+            return m_occlusion_query_flags;
+        }
+
+        /** Returns the pipeline statistics gathered by the profiler. NONE if the device does not support
+         *  pipeline statistics queries. */
+        Anvil::QueryPipelineStatisticFlags get_pipeline_statistics() const
+        {
+            return m_pipeline_statistics;
+        }
+
+        /** Tells whether a pass has been begun and has not been ended yet. */
+        bool is_pass_active() const
+        {
+            return m_is_pass_active;
+        }
+
+    private:
+        /* Private type definitions */
+        typedef struct Frame
+        {
+            uint64_t                 frame_index;
+            bool                     is_pending;
+            std::vector<std::string> pass_names;
+
+            Frame()
+                :frame_index(0),
+                 is_pending (false)
+            {
+                /* Stub */
+            }
+        } Frame;
+
+        /* Private functions */
+        PipelineStatisticsProfiler(const Anvil::BaseDevice* in_device_ptr,
+                                   uint32_t                 in_n_frames_in_flight,
+                                   uint32_t                 in_n_max_passes_per_frame);
+
+        bool init           ();
+        void read_back_frame(uint32_t in_n_frame);
+
+        /* Private variables */
+        const Anvil::BaseDevice*           m_device_ptr;
+        std::vector<Frame>                 m_frames;
+        bool                               m_has_last_frame_statistics;
+        bool                               m_is_pass_active;
+        bool                               m_is_pass_measured;
+        FrameStatistics                    m_last_frame_statistics;
+        uint32_t                           m_n_current_frame;
+        uint64_t                           m_n_dropped_frames;
+        const uint32_t                     m_n_max_passes_per_frame;
+        uint64_t                           m_next_frame_index;
+        Anvil::QueryPoolUniquePtr          m_occlusion_query_pool_ptr;
+        Anvil::QueryControlFlags           m_occlusion_query_flags;
+        std::vector<uint64_t>              m_occlusion_query_results;
+        Anvil::QueryPipelineStatisticFlags m_pipeline_statistics;
+        Anvil::QueryPoolUniquePtr          m_ps_query_pool_ptr;
+        std::vector<uint64_t>              m_ps_query_results;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(PipelineStatisticsProfiler);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(PipelineStatisticsProfiler);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_PIPELINE_STATISTICS_PROFILER_H */
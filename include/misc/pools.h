@@ -33,13 +33,19 @@
  *  3. Finally, at the top we have specialized classes which inherit from Pool. At instantiation time,
  *     they initialize a worker's instance and pass it down to the middle layer.
  *
- *  Pools are NOT thread-safe at the moment. This will be added in the near future.
+ *  Pools are NOT thread-safe, unless requested at creation time.
+ *
+ *  Items returned to a pool are only reset when the pool runs out of ready items. All returned items are then reset
+ *  with a single IPoolWorker::reset_items() call, which lets workers batch the reset (eg. with a single
+ *  vkResetFences() call).
  */
 #ifndef WRAPPERS_POOLS_H
 #define WRAPPERS_POOLS_H
 
 #include "misc/types.h"
 #include <forward_list>
+#include <mutex>
+#include <unordered_map>
 
 
 namespace Anvil
@@ -65,6 +71,18 @@ namespace Anvil
         virtual PoolItem create_item ()                      = 0;
         virtual void     release_item(PoolItem  in_item_ptr) = 0;
         virtual void     reset_item  (PoolItem& in_item_ptr) = 0;
+
+        /** Resets @param in_n_items items at once. The default implementation calls reset_item() for each item. */
+        virtual void reset_items(uint32_t         in_n_items,
+                                 PoolItem* const* in_item_ptrs)
+        {
+            for (uint32_t n_item = 0;
+                          n_item < in_n_items;
+                        ++n_item)
+            {
+                reset_item(*in_item_ptrs[n_item]);
+            }
+        }
     };
 
     /** Generic pool implementation  */
@@ -137,11 +155,15 @@ namespace Anvil
          *  @param in_n_items_to_preallocate Number of pool items to preallocate.
          *  @param in_worker_ptr             Pointer to the pool item worker implementation.
          *                                   Must not be nullptr. Also see the note above.
+         *  @param in_mt_safe                true if items may be retrieved from & returned to the pool
+         *                                   from multiple threads at the same time.
          *
          **/
         GenericPool(uint32_t                      in_n_items_to_preallocate,
-                    IPoolWorker<PoolItemPtrType>* in_worker_ptr)
+                    IPoolWorker<PoolItemPtrType>* in_worker_ptr,
+                    bool                          in_mt_safe = false)
             :m_capacity  (in_n_items_to_preallocate),
+             m_mt_safe   (in_mt_safe),
              m_worker_ptr(in_worker_ptr)
         {
             for (uint32_t n_item = 0;
@@ -152,7 +174,7 @@ namespace Anvil
                     new PoolItemContainer<PoolItemType, PoolItemPtrType>(m_worker_ptr->create_item() )
                 );
 
-                m_available_pool_item_containers.push_back(
+                m_returned_pool_item_containers.push_back(
                     std::move(new_item_container_ptr)
                 );
             }
@@ -187,6 +209,17 @@ namespace Anvil
                 m_available_pool_item_containers.pop_back();
             }
 
+            while (!m_returned_pool_item_containers.empty())
+            {
+                std::unique_ptr<Anvil::PoolItemContainer<PoolItemType, PoolItemPtrType> >& current_item_container = m_returned_pool_item_containers.back();
+
+                m_worker_ptr->release_item(
+                    std::move(current_item_container->item)
+                );
+
+                m_returned_pool_item_containers.pop_back();
+            }
+
             delete m_worker_ptr;
             m_worker_ptr = nullptr;
         }
@@ -207,9 +240,22 @@ namespace Anvil
          *  @return As per description. */
         PoolItemPtrType get_item()
         {
+            std::unique_lock<std::mutex>                       lock           (m_mutex,
+                                                                               std::defer_lock);
             ReturnToPoolFunctor<PoolItemType, PoolItemPtrType> release_functor(this);
             PoolItemPtrType                                    result;
 
+            if (m_mt_safe)
+            {
+                lock.lock();
+            }
+
+            if ( m_available_pool_item_containers.empty() &&
+                !m_returned_pool_item_containers.empty () )
+            {
+                reset_returned_items();
+            }
+
             if (!m_available_pool_item_containers.empty())
             {
                 result = PoolItemPtrType(m_available_pool_item_containers.back()->item.get(),
@@ -233,41 +279,56 @@ namespace Anvil
 
                 result = PoolItemPtrType(m_active_pool_item_containers.back()->item.get(),
                                          release_functor);
+
+                m_worker_ptr->reset_item(result);
             }
 
-            m_worker_ptr->reset_item(result);
+            m_active_pool_item_container_indices[result.get()] = m_active_pool_item_containers.size() - 1;
 
             return result;
         }
 
-        /** Stores the provided instance back in the pool. */
+        /** Stores the provided instance back in the pool.
+         *
+         *  The container is looked up by its index in the active container vector, and is swapped
+         *  with the last active container prior to removal, so the call takes constant time.
+         */
         void return_item(PoolItemType* in_item_ptr)
         {
-            std::unique_ptr<PoolItemContainer<PoolItemType, PoolItemPtrType> > container;
-            bool                                                               has_found = false;
-
-            ANVIL_REDUNDANT_VARIABLE(has_found);
+            std::unique_lock<std::mutex> lock(m_mutex,
+                                              std::defer_lock);
 
-            for (auto iterator  = m_active_pool_item_containers.begin();
-                      iterator != m_active_pool_item_containers.end();
-                    ++iterator)
+            if (m_mt_safe)
             {
-                if ((*iterator)->item.get() == in_item_ptr)
-                {
-                    container = std::move(*iterator);
-                    has_found = true;
+                lock.lock();
+            }
 
-                    m_active_pool_item_containers.erase(iterator);
+            auto index_iterator = m_active_pool_item_container_indices.find(in_item_ptr);
+
+            if (index_iterator == m_active_pool_item_container_indices.end() )
+            {
+                anvil_assert(index_iterator != m_active_pool_item_container_indices.end() );
 
-                    break;
-                }
+                return;
             }
 
-            anvil_assert(has_found);
+            const size_t n_container = index_iterator->second;
 
-            m_available_pool_item_containers.push_back(
-                std::move(container)
+            m_active_pool_item_container_indices.erase(index_iterator);
+
+            if (n_container != m_active_pool_item_containers.size() - 1)
+            {
+                std::swap(m_active_pool_item_containers.at(n_container),
+                          m_active_pool_item_containers.back() );
+
+                m_active_pool_item_container_indices[m_active_pool_item_containers.at(n_container)->item.get()] = n_container;
+            }
+
+            m_returned_pool_item_containers.push_back(
+                std::move(m_active_pool_item_containers.back() )
             );
+
+            m_active_pool_item_containers.pop_back();
         }
 
     protected:
@@ -283,12 +344,44 @@ namespace Anvil
         }
 
         /* Protected variables */
-        PoolItemContainers m_active_pool_item_containers;
-        PoolItemContainers m_available_pool_item_containers;
+        PoolItemContainers                                m_active_pool_item_containers;
+        std::unordered_map<const PoolItemType*, size_t>   m_active_pool_item_container_indices;
+        PoolItemContainers                                m_available_pool_item_containers;
+        PoolItemContainers                                m_returned_pool_item_containers;
 
     private:
+        /* Private functions */
+
+        /** Resets all items returned to the pool with a single reset_items() call and makes them available. */
+        void reset_returned_items()
+        {
+            const uint32_t n_returned_items = static_cast<uint32_t>(m_returned_pool_item_containers.size() );
+
+            m_reset_item_ptrs.clear();
+
+            for (auto& current_item_container_ptr : m_returned_pool_item_containers)
+            {
+                m_reset_item_ptrs.push_back(&current_item_container_ptr->item);
+            }
+
+            m_worker_ptr->reset_items(n_returned_items,
+                                     &m_reset_item_ptrs.at(0) );
+
+            for (auto& current_item_container_ptr : m_returned_pool_item_containers)
+            {
+                m_available_pool_item_containers.push_back(
+                    std::move(current_item_container_ptr)
+                );
+            }
+
+            m_returned_pool_item_containers.clear();
+        }
+
         /* Private variables */
         uint32_t                      m_capacity;
+        bool                          m_mt_safe;
+        std::mutex                    m_mutex;
+        std::vector<PoolItemPtrType*> m_reset_item_ptrs;
         IPoolWorker<PoolItemPtrType>* m_worker_ptr;
     };
 
@@ -432,6 +525,174 @@ namespace Anvil
     typedef CommandBufferPool<PrimaryCommandBufferPoolWorker,   PrimaryCommandBuffer,   PrimaryCommandBufferUniquePtr>   PrimaryCommandBufferPool;
     typedef CommandBufferPool<SecondaryCommandBufferPoolWorker, SecondaryCommandBuffer, SecondaryCommandBufferUniquePtr> SecondaryCommandBufferPool;
 
+
+    /** Implements IPoolWorker interface for synchronization primitives. */
+    template<class SyncObjectPtr>
+    class SyncObjectPoolWorker : public IPoolWorker<SyncObjectPtr>
+    {
+    public:
+        /* Public functions */
+
+        /** Constructor.
+         *
+         *  @param in_device_ptr Device to create sync objects for. Must not be nullptr.
+         **/
+        SyncObjectPoolWorker(const Anvil::BaseDevice* in_device_ptr)
+            :m_device_ptr(in_device_ptr)
+        {
+            anvil_assert(m_device_ptr != nullptr);
+        }
+
+        virtual ~SyncObjectPoolWorker()
+        {
+            /* Stub */
+        }
+
+        void release_item(SyncObjectPtr in_item_ptr)
+        {
+            /* Stub */
+        }
+
+    protected:
+        /* Protected variables */
+        const Anvil::BaseDevice* m_device_ptr;
+
+    private:
+        /* Private functions */
+        SyncObjectPoolWorker(const SyncObjectPoolWorker&);
+        bool operator=      (const SyncObjectPoolWorker&);
+    };
+
+    class EventPoolWorker : public SyncObjectPoolWorker<Anvil::EventUniquePtr>
+    {
+    public:
+        EventPoolWorker(const Anvil::BaseDevice* in_device_ptr)
+            :SyncObjectPoolWorker(in_device_ptr)
+        {
+            /* Stub */
+        }
+
+        virtual ~EventPoolWorker()
+        {
+             /* Stub */
+        }
+
+        Anvil::EventUniquePtr create_item();
+        void                  reset_item (Anvil::EventUniquePtr& in_item_ptr);
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(EventPoolWorker);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR   (EventPoolWorker);
+    };
+
+    class FencePoolWorker : public SyncObjectPoolWorker<Anvil::FenceUniquePtr>
+    {
+    public:
+        FencePoolWorker(const Anvil::BaseDevice* in_device_ptr)
+            :SyncObjectPoolWorker(in_device_ptr)
+        {
+            /* Stub */
+        }
+
+        virtual ~FencePoolWorker()
+        {
+             /* Stub */
+        }
+
+        Anvil::FenceUniquePtr create_item();
+        void                  reset_item (Anvil::FenceUniquePtr&        in_item_ptr);
+        void                  reset_items(uint32_t                      in_n_items,
+                                          Anvil::FenceUniquePtr* const* in_item_ptrs);
+
+    private:
+        std::vector<Anvil::Fence*> m_fence_ptrs;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(FencePoolWorker);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR   (FencePoolWorker);
+    };
+
+    class SemaphorePoolWorker : public SyncObjectPoolWorker<Anvil::SemaphoreUniquePtr>
+    {
+    public:
+        SemaphorePoolWorker(const Anvil::BaseDevice* in_device_ptr)
+            :SyncObjectPoolWorker(in_device_ptr)
+        {
+            /* Stub */
+        }
+
+        virtual ~SemaphorePoolWorker()
+        {
+             /* Stub */
+        }
+
+        Anvil::SemaphoreUniquePtr create_item();
+
+        void reset_item(Anvil::SemaphoreUniquePtr& in_item_ptr)
+        {
+            /* Binary semaphores are unsignalled once the wait operation which consumed the signal has executed */
+        }
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(SemaphorePoolWorker);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR   (SemaphorePoolWorker);
+    };
+
+    /** Implements a generic pool of synchronization primitives.
+     *
+     *  Items must only be returned to the pool once the device no longer uses them: fences must have been
+     *  waited on, and binary semaphores must have had their signal consumed by a wait operation which has
+     *  finished executing. Returned fences & events are unsignalled before they are handed out again.
+     */
+    template <class PoolWorker, class SyncObjectType, class SyncObjectPtrType>
+    class SyncObjectPool : public GenericPool<SyncObjectType, SyncObjectPtrType>
+    {
+    public:
+        /** Creates a new pool instance.
+         *
+         *  @param in_device_ptr           Device to create sync objects for. Must not be nullptr.
+         *  @param in_n_preallocated_items Number of sync objects to preallocate at creation time.
+         *  @param in_mt_safe              Please see GenericPool().
+         *
+         **/
+        static std::unique_ptr<SyncObjectPool<PoolWorker, SyncObjectType, SyncObjectPtrType> > create(const Anvil::BaseDevice* in_device_ptr,
+                                                                                                        uint32_t                 in_n_preallocated_items,
+                                                                                                        bool                     in_mt_safe)
+        {
+            std::unique_ptr<SyncObjectPool<PoolWorker, SyncObjectType, SyncObjectPtrType> > result_ptr;
+
+            result_ptr.reset(
+                new SyncObjectPool<PoolWorker, SyncObjectType, SyncObjectPtrType>(in_n_preallocated_items,
+                                                                                  new PoolWorker(in_device_ptr),
+                                                                                  in_mt_safe)
+            );
+
+            return result_ptr;
+        }
+
+        /** Stub destructor */
+        virtual ~SyncObjectPool()
+        {
+            /* Stub */
+        }
+
+    private:
+
+        /* Constructor. Please see create() for documentation */
+        SyncObjectPool(uint32_t    in_n_preallocated_items,
+                       PoolWorker* in_pool_worker_ptr,
+                       bool        in_mt_safe)
+            :GenericPool<SyncObjectType, SyncObjectPtrType>(in_n_preallocated_items,
+                                                            in_pool_worker_ptr,
+                                                            in_mt_safe)
+        {
+            /* Stub */
+        }
+
+    };
+
+    /* Sync object pool specializations */
+    typedef SyncObjectPool<EventPoolWorker,     Event,     EventUniquePtr>     EventPool;
+    typedef SyncObjectPool<FencePoolWorker,     Fence,     FenceUniquePtr>     FencePool;
+    typedef SyncObjectPool<SemaphorePoolWorker, Semaphore, SemaphoreUniquePtr> SemaphorePool;
+
 }; /* namespace Anvil */
 
 #endif /* WRAPPERS_POOLS_H */
\ No newline at end of file
@@ -0,0 +1,206 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a per-frame query allocator.
+ *
+ *  The allocator sub-allocates ranges of query indices from a set of large query pools, so that profiling and
+ *  occlusion code does not need to manage pools of its own. Ranges allocated within a frame are linearly
+ *  carved out of the frame's pools. Apps end a frame by calling end_frame() with a fence, or a timeline
+ *  semaphore value, which is signalled once the GPU has finished executing all work submitted for that frame.
+ *  collect() then recycles pools of completed frames, making them available for further allocations.
+ *
+ *  If VK_EXT_host_query_reset is enabled, recycled pools are reset from the host with QueryPool::reset_host(),
+ *  so allocated queries can be used straight away. Otherwise, allocate() records a reset of the allocated range
+ *  into a command buffer provided by the caller, which needs to be executed before the queries are used.
+ *
+ *  Query results must be retrieved before the frame the queries were allocated in is recycled.
+ *
+ *  Query allocator is thread-safe.
+ */
+#ifndef MISC_QUERY_ALLOCATOR_H
+#define MISC_QUERY_ALLOCATOR_H
+
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+#include <deque>
+
+
+namespace Anvil
+{
+    class QueryAllocator : public MTSafetySupportProvider
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new query allocator instance for occlusion or timestamp queries.
+         *
+         *  @param in_device_ptr          Device to use. Must not be null.
+         *  @param in_query_type          Type of queries to allocate. Must not be VK_QUERY_TYPE_PIPELINE_STATISTICS.
+         *  @param in_n_queries_per_pool  Number of queries each of the underlying query pools holds. Also the
+         *                                maximum number of queries a single allocate() call may request.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::QueryAllocatorUniquePtr create_non_ps(const Anvil::BaseDevice* in_device_ptr,
+                                                            VkQueryType              in_query_type,
+                                                            uint32_t                 in_n_queries_per_pool = 1024);
+
+        /** Creates a new query allocator instance for pipeline statistics queries.
+         *
+         *  @param in_device_ptr          Device to use. Must not be null.
+         *  @param in_pipeline_statistics Pipeline statistics the queries should capture.
+         *  @param in_n_queries_per_pool  As per create_non_ps().
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::QueryAllocatorUniquePtr create_ps(const Anvil::BaseDevice*           in_device_ptr,
+                                                        Anvil::QueryPipelineStatisticFlags in_pipeline_statistics,
+                                                        uint32_t                           in_n_queries_per_pool = 1024);
+
+        /** Destructor. The device must not be executing any work which refers to allocated queries. */
+        ~QueryAllocator();
+
+        /** Allocates a range of consecutive query indices for use within the current frame.
+         *
+         *  @param in_n_queries                Number of queries to allocate. Must not exceed the number of queries
+         *                                     per pool.
+         *  @param in_opt_reset_cmd_buffer_ptr Command buffer to record a reset of the allocated range into. Ignored if
+         *                                     host query reset is used. Otherwise, it must not be null, must be in
+         *                                     recording state and must be submitted before the queries are used.
+         *  @param out_query_pool_ptr_ptr      Deref will be set to the pool the range has been allocated from.
+         *                                     Must not be null.
+         *  @param out_first_query_index_ptr   Deref will be set to index of the first allocated query. Must not be
+         *                                     null.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool allocate(uint32_t                  in_n_queries,
+                      Anvil::CommandBufferBase* in_opt_reset_cmd_buffer_ptr,
+                      Anvil::QueryPool**        out_query_pool_ptr_ptr,
+                      Anvil::QueryIndex*        out_first_query_index_ptr);
+
+        /** Recycles pools of all frames which have completed. Does not block.
+         *
+         *  Results of queries allocated in these frames are no longer available after this call.
+         *
+         *  @return Number of frames recycled.
+         */
+        uint32_t collect();
+
+        /** Ends the current frame. Pools used so far are recycled by collect() once @param in_fence_ptr becomes
+         *  signalled.
+         *
+         *  @param in_fence_ptr Fence used by the last submission of the frame. Must not be null. The fence must stay
+         *                      alive until the frame is recycled.
+         */
+        void end_frame(Anvil::Fence* in_fence_ptr);
+
+        /** Ends the current frame. Pools used so far are recycled by collect() once the counter of
+         *  @param in_timeline_semaphore_ptr reaches @param in_value.
+         *
+         *  @param in_timeline_semaphore_ptr Timeline semaphore signalled by the last submission of the frame.
+         *                                   Must not be null. The semaphore must stay alive until the frame is
+         *                                   recycled.
+         *  @param in_value                  Value the last submission of the frame signals.
+         */
+        void end_frame(Anvil::Semaphore* in_timeline_semaphore_ptr,
+                       uint64_t          in_value);
+
+        /** Returns the number of query pools created by the allocator so far. */
+        uint32_t get_n_pools() const;
+
+        /** Returns the number of queries each of the underlying query pools holds. */
+        uint32_t get_n_queries_per_pool() const
+        {
+            return m_n_queries_per_pool;
+        }
+
+        /** Tells whether queries are reset from the host, rather than with commands recorded by allocate(). */
+        bool uses_host_query_reset() const
+        {
+            return m_uses_host_query_reset;
+        }
+
+    private:
+        /* Private type definitions */
+        typedef struct PoolUsage
+        {
+            uint32_t          n_used_queries;
+            Anvil::QueryPool* pool_ptr;
+
+            PoolUsage(Anvil::QueryPool* in_pool_ptr)
+                :n_used_queries(0),
+                 pool_ptr      (in_pool_ptr)
+            {
+                /* Stub */
+            }
+        } PoolUsage;
+
+        typedef struct Frame
+        {
+            Anvil::Fence*          fence_ptr;
+            std::vector<PoolUsage> pools;
+            Anvil::Semaphore*      semaphore_ptr;
+            uint64_t               semaphore_value;
+
+            Frame(Anvil::Fence*          in_fence_ptr,
+                  Anvil::Semaphore*      in_semaphore_ptr,
+                  uint64_t               in_semaphore_value,
+                  std::vector<PoolUsage> in_pools)
+                :fence_ptr      (in_fence_ptr),
+                 pools          (std::move(in_pools) ),
+                 semaphore_ptr  (in_semaphore_ptr),
+                 semaphore_value(in_semaphore_value)
+            {
+                /* Stub */
+            }
+        } Frame;
+
+        /* Private functions */
+        QueryAllocator(const Anvil::BaseDevice*           in_device_ptr,
+                       VkQueryType                        in_query_type,
+                       Anvil::QueryPipelineStatisticFlags in_pipeline_statistics,
+                       uint32_t                           in_n_queries_per_pool);
+
+        Anvil::QueryPool* get_free_pool    ();
+        bool              is_frame_complete(const Frame& in_frame) const;
+        void              end_frame        (Anvil::Fence*     in_opt_fence_ptr,
+                                            Anvil::Semaphore* in_opt_semaphore_ptr,
+                                            uint64_t          in_semaphore_value);
+
+        /* Private variables */
+        std::vector<PoolUsage>             m_current_frame_pools;
+        const Anvil::BaseDevice*           m_device_ptr;
+        std::deque<Frame>                  m_frames;
+        std::vector<Anvil::QueryPool*>     m_free_pools;
+        uint32_t                           m_n_queries_per_pool;
+        Anvil::QueryPipelineStatisticFlags m_pipeline_statistics;
+        std::vector<QueryPoolUniquePtr>    m_pools;
+        const VkQueryType                  m_query_type;
+        bool                               m_uses_host_query_reset;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(QueryAllocator);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(QueryAllocator);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_QUERY_ALLOCATOR_H */
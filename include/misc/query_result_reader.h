@@ -0,0 +1,204 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements non-blocking readback of occlusion and timestamp query results.
+ *
+ *  The reader keeps a persistent copy of the result of every query in the pool, together with a flag telling
+ *  whether the result is up to date. Queries become pending when they are reset with record_reset() (or marked
+ *  as such with invalidate() if they have been reset by other means). Each update() call then checks pending
+ *  queries for availability and stores the results of those which are ready, without ever waiting for the GPU.
+ *
+ *  By default, results are polled with vkGetQueryPoolResults() and WITH_AVAILABILITY_BIT. If the reader is
+ *  created with one or more copy slots, results are instead transferred by the GPU to a persistently mapped,
+ *  host-coherent ring buffer with record_copy(), so that update() only needs to read host memory. Each
+ *  record_copy() call uses the next slot of the ring. The app must make sure the GPU has finished executing the
+ *  copy recorded the last time a slot was used before the slot is reused, eg. by using as many slots as there are
+ *  frames in flight if a single copy is recorded per frame.
+ *
+ *  Pipeline statistics query pools are not supported.
+ *
+ *  Query result reader is NOT thread-safe.
+ */
+#ifndef MISC_QUERY_RESULT_READER_H
+#define MISC_QUERY_RESULT_READER_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class QueryResultReader
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new query result reader instance.
+         *
+         *  @param in_device_ptr     Device to use. Must not be null.
+         *  @param in_query_pool_ptr Query pool to read results of. Must not be null. Must not be a pipeline
+         *                           statistics query pool. Must outlive the reader.
+         *  @param in_n_copy_slots   Number of slots in the ring buffer results are copied to by record_copy().
+         *                           If 0, results are polled with vkGetQueryPoolResults() instead and
+         *                           record_copy() must not be used.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::QueryResultReaderUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
+                                                        Anvil::QueryPool*        in_query_pool_ptr,
+                                                        uint32_t                 in_n_copy_slots = 0);
+
+        /** Destructor. The caller must make sure none of the recorded copies is still executed by the GPU. */
+        ~QueryResultReader();
+
+        /** Returns the number of queries whose results have not become available yet. */
+        uint32_t get_n_pending_queries() const
+        {
+            return m_n_pending_queries;
+        }
+
+        /** Retrieves the last result read for the specified query.
+         *
+         *  @param in_query_index    Index of the query to use.
+         *  @param out_result_ptr    Deref will be set to the result value, if it is available. Must not be null.
+         *
+         *  @return true if the query's result is available, false if it is still pending or the query has never
+         *          been used.
+         */
+        bool get_result(Anvil::QueryIndex in_query_index,
+                        uint64_t*         out_result_ptr) const;
+
+        /** Marks the specified query range as pending, without recording any commands. Use this function if
+         *  the queries have been reset by other means than record_reset().
+         *
+         *  @param in_first_query_index Index of the first query to use.
+         *  @param in_n_queries         Number of queries to mark.
+         */
+        void invalidate(Anvil::QueryIndex in_first_query_index,
+                        uint32_t          in_n_queries);
+
+        /** Tells whether the last result read for the specified query is up to date. */
+        bool is_result_available(Anvil::QueryIndex in_query_index) const;
+
+        /** Records a copy of the specified query range's results to the next slot of the ring buffer. The
+         *  results are picked up by update() calls made after the command buffer finishes executing.
+         *
+         *  Must not be called for readers which have been created without copy slots. Must be called outside
+         *  a renderpass.
+         *
+         *  @param in_cmd_buffer_ptr    Command buffer to record the commands to. Must be in recording state.
+         *  @param in_first_query_index Index of the first query to copy.
+         *  @param in_n_queries         Number of queries to copy.
+         *  @param in_gpu_wait          True if the GPU should wait for the results to become available before
+         *                              copying them. If false, results of queries which are not available at
+         *                              the time the copy executes are left pending, and need to be copied again.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_copy(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                         Anvil::QueryIndex         in_first_query_index,
+                         uint32_t                  in_n_queries,
+                         bool                      in_gpu_wait = true);
+
+        /** Records a reset of the specified query range and marks the queries as pending.
+         *
+         *  @param in_cmd_buffer_ptr    Command buffer to record the command to. Must be in recording state.
+         *  @param in_first_query_index Index of the first query to reset.
+         *  @param in_n_queries         Number of queries to reset.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_reset(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                          Anvil::QueryIndex         in_first_query_index,
+                          uint32_t                  in_n_queries);
+
+        /** Reads results of all pending queries which have become available. Never blocks.
+         *
+         *  @return Number of queries whose results have become available since the last call.
+         */
+        uint32_t update();
+
+        /** Tells whether results are copied to a ring buffer by the GPU, as opposed to being polled with
+         *  vkGetQueryPoolResults(). */
+        bool uses_gpu_copies() const
+        {
+            return (m_n_copy_slots > 0);
+        }
+
+    private:
+        /* Private type definitions */
+        enum class QueryState : uint8_t
+        {
+            AVAILABLE,
+            PENDING,
+            UNUSED
+        };
+
+        typedef struct CopyRequest
+        {
+            uint64_t          epoch;
+            Anvil::QueryIndex first_query_index;
+            uint32_t          n_queries;
+
+            CopyRequest()
+                :epoch            (0),
+                 first_query_index(0),
+                 n_queries        (0)
+            {
+                /* Stub */
+            }
+        } CopyRequest;
+
+        /* Private functions */
+        QueryResultReader(const Anvil::BaseDevice* in_device_ptr,
+                          Anvil::QueryPool*        in_query_pool_ptr,
+                          uint32_t                 in_n_copy_slots);
+
+        bool     init                 ();
+        void     mark_pending         (Anvil::QueryIndex in_first_query_index,
+                                       uint32_t          in_n_queries);
+        uint32_t process_copy_request (uint32_t          in_n_slot);
+        uint32_t poll_query_pool      ();
+        void     store_result         (Anvil::QueryIndex in_query_index,
+                                       uint64_t          in_result);
+
+        /* Private variables */
+        Anvil::BufferUniquePtr         m_copy_buffer_ptr;
+        std::vector<CopyRequest>       m_copy_requests;
+        const uint8_t*                 m_copy_mapped_ptr;
+        const Anvil::BaseDevice*       m_device_ptr;
+        uint64_t                       m_epoch;
+        const uint32_t                 m_n_copy_slots;
+        uint32_t                       m_n_next_copy_slot;
+        uint32_t                       m_n_pending_queries;
+        std::vector<uint64_t>          m_poll_data;
+        std::vector<uint64_t>          m_query_epochs;
+        Anvil::QueryPool*              m_query_pool_ptr;
+        std::vector<QueryState>        m_query_states;
+        std::vector<uint64_t>          m_results;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(QueryResultReader);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(QueryResultReader);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_QUERY_RESULT_READER_H */
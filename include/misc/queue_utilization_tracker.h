@@ -0,0 +1,214 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+
+/** Implements opt-in detection of idle gaps between the submissions of a single queue.
+ *
+ *  Once attached to a queue with Queue::set_utilization_tracker(), the tracker brackets each submission issued for the
+ *  queue with two extra command buffers, which write top- and bottom-of-pipe timestamps. Bracketing is done per
+ *  SubmitInfo, so the time spent waiting on the submission's wait semaphores is accounted for as idle time.
+ *
+ *  update() reads back the timestamps of submissions which have completed without blocking, and folds the intervals
+ *  the queue has been busy for into a running report. Intervals of consecutive submissions which overlap on the GPU
+ *  are merged, and the time between the end of one merged interval and the start of the next one is accounted for as
+ *  a gap. The report covers all submissions since the tracker has been created or last reset, across any number of
+ *  frames, and holds the queue's utilization and the largest gaps seen.
+ *
+ *  If VK_EXT_calibrated_timestamps is enabled, each gap is also tagged with the delay between the moment the queue
+ *  went idle and the moment the host issued the submission which ended the gap. A positive delay means the CPU did
+ *  not provide work in time. If the built-in Tracer recorder is enabled, gaps are also recorded as device spans,
+ *  so that they can be inspected next to the CPU spans (see Tracer::record_device_span() ).
+ *
+ *  The following submissions are not bracketed and show up as idle time:
+ *
+ *  - submissions which do not execute any command buffers,
+ *  - protected submissions and multi-GPU submissions,
+ *  - submissions issued while all of the tracker's slots are in flight (see get_report() ).
+ *
+ *  Requires the queue's family to support timestamp queries. Queue utilization tracker is NOT thread-safe, unless
+ *  created with @param in_mt_safe set to true. A thread-safe instance must be used if update() or get_report() are
+ *  called from threads other than the one which submits to the queue.
+ */
+#ifndef MISC_QUEUE_UTILIZATION_TRACKER_H
+#define MISC_QUEUE_UTILIZATION_TRACKER_H
+
+#include "misc/mt_safety.h"
+#include "misc/time.h"
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class QueueUtilizationTracker : public MTSafetySupportProvider
+    {
+    public:
+        /* Public type definitions */
+
+        /** A period of time during which the queue had no bracketed work to execute. */
+        typedef struct Gap
+        {
+            /* Duration of the gap, in nanoseconds. */
+            uint64_t duration;
+
+            /* Time at which the queue went idle, in nanoseconds, in the device's time domain. */
+            uint64_t start_time;
+
+            /* Time between the moment the queue went idle and the moment the host issued the submission which ended
+             * the gap, in nanoseconds. Positive if the submission has been issued after the queue went idle. Only
+             * valid if has_submit_delay is true. */
+            int64_t  submit_delay;
+            bool     has_submit_delay;
+
+            Gap()
+                :duration        (0),
+                 start_time      (0),
+                 submit_delay    (0),
+                 has_submit_delay(false)
+            {
+                /* Stub */
+            }
+        } Gap;
+
+        typedef struct Report
+        {
+            /* Total time the queue has spent executing bracketed submissions, in nanoseconds. */
+            uint64_t         busy_time;
+
+            /* Total time between bracketed submissions, in nanoseconds. */
+            uint64_t         idle_time;
+
+            /* Largest gaps seen, longest first. */
+            std::vector<Gap> largest_gaps;
+
+            /* Number of submissions which were not bracketed because all slots were in flight. */
+            uint64_t         n_dropped_submissions;
+
+            /* Number of gaps seen. */
+            uint64_t         n_gaps;
+
+            /* Number of bracketed submissions whose timestamps have been read back. */
+            uint64_t         n_submissions;
+
+            Report()
+                :busy_time            (0),
+                 idle_time            (0),
+                 n_dropped_submissions(0),
+                 n_gaps               (0),
+                 n_submissions        (0)
+            {
+                /* Stub */
+            }
+
+            /** Returns the fraction of time the queue has been busy for, between the start of the first and the end of
+             *  the last bracketed submission covered by the report. */
+            double get_utilization() const
+            {
+                return (busy_time + idle_time > 0) ? static_cast<double>(busy_time) / static_cast<double>(busy_time + idle_time)
+                                                   : 0.0;
+            }
+        } Report;
+
+        /* Public functions */
+
+        /** Creates a new queue utilization tracker instance.
+         *
+         *  @param in_queue_ptr        Queue to track. Must not be null. The tracker must be attached to the same queue.
+         *  @param in_n_slots          Maximum number of submissions which can be in flight before their timestamps
+         *                             are read back. Submissions in excess are not bracketed. Must not be 0.
+         *  @param in_n_largest_gaps   Number of the largest gaps to keep in the report.
+         *  @param in_mt_safe          True if the instance should be thread-safe.
+         *
+         *  @return New instance if successful, null if the queue's family does not support timestamp queries, or if
+         *          the required objects could not be created.
+         */
+        static Anvil::QueueUtilizationTrackerUniquePtr create(Anvil::Queue* in_queue_ptr,
+                                                              uint32_t      in_n_slots        = 256,
+                                                              uint32_t      in_n_largest_gaps = 8,
+                                                              bool          in_mt_safe        = false);
+
+        /** Destructor.
+         *
+         *  The tracker must have been detached from the queue, and all submissions it has bracketed must have
+         *  completed.
+         */
+        ~QueueUtilizationTracker();
+
+        /** Calls update() and returns the report covering all submissions read back since the tracker has been
+         *  created, or since reset() has last been called. */
+        Report get_report();
+
+        /** Discards the report. Submissions which are still in flight are going to be accounted for by the new
+         *  report. */
+        void reset();
+
+        /** Reads back timestamps of all completed submissions, in submission order, and updates the report. Never
+         *  blocks. Apps should call this function periodically, eg. once per frame.
+         */
+        void update();
+
+    private:
+        /* Private type definitions */
+        typedef struct Slot
+        {
+            Anvil::PrimaryCommandBufferUniquePtr begin_cmd_buffer_ptr;
+            Anvil::PrimaryCommandBufferUniquePtr end_cmd_buffer_ptr;
+            uint64_t                             submit_host_timestamp;
+        } Slot;
+
+        /* Private functions */
+        QueueUtilizationTracker(Anvil::Queue* in_queue_ptr,
+                                uint32_t      in_n_slots,
+                                uint32_t      in_n_largest_gaps,
+                                bool          in_mt_safe);
+
+        bool begin_submission(const Anvil::Queue* in_queue_ptr,
+                              VkCommandBuffer*    out_begin_cmd_buffer_ptr,
+                              VkCommandBuffer*    out_end_cmd_buffer_ptr);
+        void end_submissions (bool                in_submitted);
+        bool init            ();
+        void retire_slots    ();
+        void track_gap       (const Gap&          in_gap);
+
+        /* Private variables */
+        uint64_t                  m_busy_end_time;
+        uint64_t                  m_committed_write_pos;
+        const Anvil::BaseDevice*  m_device_ptr;
+        bool                      m_has_busy_end_time;
+        const uint32_t            m_n_largest_gaps;
+        Anvil::QueryPoolUniquePtr m_query_pool_ptr;
+        Anvil::Queue*             m_queue_ptr;
+        uint64_t                  m_read_pos;
+        Report                    m_report;
+        std::vector<Slot>         m_slots;
+        Anvil::Time               m_time;
+        double                    m_timestamp_period;
+        uint64_t                  m_write_pos;
+
+        friend class Anvil::Queue;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(QueueUtilizationTracker);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(QueueUtilizationTracker);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_QUEUE_UTILIZATION_TRACKER_H */
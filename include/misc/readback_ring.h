@@ -0,0 +1,255 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a ring of persistently mapped host memory which GPU->host copies can be streamed into,
+ *  without stalling the calling thread until the copies complete.
+ *
+ *  A readback reserves a region of the ring and records a copy from a buffer or an image into it. The copy
+ *  can either be recorded into a command buffer owned by the app, in which case the app ends the frame by
+ *  calling end_frame() with the fence it is going to submit the command buffer with, or submitted by the
+ *  ring itself with submit_buffer_readback(). Each readback is identified by a ReadbackID, which can be polled
+ *  with is_ready(). Once the copy has completed, read() copies the data out and returns the region to the ring.
+ *
+ *  Regions are recycled in the order they were reserved in, so readbacks which are never read should be
+ *  discarded with release(). If the ring runs out of space, record_*() and submit_*() calls fail instead of
+ *  blocking. Apps are then expected to read or release the oldest readbacks first.
+ *
+ *  Readback ring is thread-safe.
+ */
+#ifndef MISC_READBACK_RING_H
+#define MISC_READBACK_RING_H
+
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+#include <deque>
+
+
+namespace Anvil
+{
+    class ReadbackRing : public MTSafetySupportProvider
+    {
+    public:
+        /* Public type definitions */
+        typedef uint64_t ReadbackID;
+
+        /* Public functions */
+
+        /** Creates a new readback ring instance.
+         *
+         *  Host-cached memory is used for the ring if the device exposes it, so that reading the data back
+         *  is not slowed down by uncached host reads.
+         *
+         *  @param in_device_ptr Device to create the ring for. Must not be null.
+         *  @param in_size       Size of the ring's backing buffer. Must not be 0.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::ReadbackRingUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
+                                                   VkDeviceSize             in_size);
+
+        /** Destructor. Waits for all readbacks which have been submitted to complete. */
+        ~ReadbackRing();
+
+        /** Ends the current frame. Readbacks recorded by record_*() calls since the last end_frame() invocation
+         *  become ready once @param in_fence_ptr is signalled.
+         *
+         *  @param in_fence_ptr Fence used by the submission which executes the recorded copies. Must not be null.
+         *                      The fence must stay alive, and must not be reset, until these readbacks have been
+         *                      read or released.
+         */
+        void end_frame(Anvil::Fence* in_fence_ptr);
+
+        /** Ends the current frame. Readbacks recorded by record_*() calls since the last end_frame() invocation
+         *  become ready once the counter of @param in_timeline_semaphore_ptr reaches @param in_value.
+         *
+         *  @param in_timeline_semaphore_ptr Timeline semaphore signalled by the submission which executes the
+         *                                   recorded copies. Must not be null. The semaphore must stay alive until
+         *                                   these readbacks have been read or released.
+         *  @param in_value                  Value the submission signals.
+         */
+        void end_frame(Anvil::Semaphore* in_timeline_semaphore_ptr,
+                       uint64_t          in_value);
+
+        /** Returns the buffer backing the ring. */
+        Anvil::Buffer* get_buffer() const
+        {
+            return m_buffer_ptr.get();
+        }
+
+        /** Returns the number of bytes the specified readback is going to return. Returns 0 if the ID is invalid. */
+        VkDeviceSize get_readback_size(ReadbackID in_readback_id) const;
+
+        /** Returns the size of the ring. */
+        const VkDeviceSize& get_size() const
+        {
+            return m_size;
+        }
+
+        /** Tells whether the copy performed for the specified readback has completed. Does not block.
+         *
+         *  Always returns false for readbacks recorded by record_*() calls, until end_frame() is called.
+         */
+        bool is_ready(ReadbackID in_readback_id) const;
+
+        /** Copies data of the specified readback to @param out_result_ptr and returns its region to the ring.
+         *
+         *  @param in_readback_id  ID of the readback to read. The ID is no longer valid after a successful call.
+         *  @param out_result_ptr  Deref will be filled with get_readback_size() bytes. Must not be null.
+         *  @param in_should_block If true, the call waits for the copy to complete. Otherwise, the call fails
+         *                         if is_ready() would have returned false.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool read(ReadbackID in_readback_id,
+                  void*      out_result_ptr,
+                  bool       in_should_block);
+
+        /** Records a copy of the specified buffer region into a new region of the ring.
+         *
+         *  The recorded commands make sure all prior writes to the buffer are visible to the copy, and that the
+         *  copied data is visible to the host once the copy completes.
+         *
+         *  @param in_cmd_buffer_ptr   Command buffer to record the commands into. Must be in recording state.
+         *  @param in_buffer_ptr       Buffer to read from. Must have been created with TRANSFER_SRC usage.
+         *  @param in_start_offset     Start offset of the region to read.
+         *  @param in_size             Number of bytes to read. Must not be 0.
+         *  @param out_readback_id_ptr Deref will be set to the ID of the new readback. Must not be null.
+         *
+         *  @return true if successful, false if the ring does not have enough free space.
+         */
+        bool record_buffer_readback(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                    Anvil::Buffer*            in_buffer_ptr,
+                                    VkDeviceSize              in_start_offset,
+                                    VkDeviceSize              in_size,
+                                    ReadbackID*               out_readback_id_ptr);
+
+        /** Records a copy of the specified image region into a new region of the ring. Texels are tightly packed.
+         *
+         *  Only non-compressed, non-YUV color formats are supported. The recorded commands make sure all prior
+         *  transfer and color attachment writes to the image are visible to the copy.
+         *
+         *  @param in_cmd_buffer_ptr   Command buffer to record the commands into. Must be in recording state.
+         *  @param in_image_ptr        Image to read from. Must have been created with TRANSFER_SRC usage.
+         *  @param in_image_layout     Layout the image is going to be in at execution time. Must be GENERAL or
+         *                             TRANSFER_SRC_OPTIMAL.
+         *  @param in_subresource      Subresource to read from. Must only cover a single layer.
+         *  @param in_offset           Offset of the region to read.
+         *  @param in_extent           Extent of the region to read.
+         *  @param out_readback_id_ptr Deref will be set to the ID of the new readback. Must not be null.
+         *
+         *  @return true if successful, false if the format is not supported or the ring does not have enough
+         *          free space.
+         */
+        bool record_image_readback(Anvil::CommandBufferBase*            in_cmd_buffer_ptr,
+                                   Anvil::Image*                        in_image_ptr,
+                                   Anvil::ImageLayout                   in_image_layout,
+                                   const Anvil::ImageSubresourceLayers& in_subresource,
+                                   const VkOffset3D&                    in_offset,
+                                   const VkExtent3D&                    in_extent,
+                                   ReadbackID*                          out_readback_id_ptr);
+
+        /** Discards the specified readback and returns its region to the ring.
+         *
+         *  If the copy is still in flight, the region is recycled once it completes.
+         */
+        void release(ReadbackID in_readback_id);
+
+        /** Records a copy of the specified buffer region into a new region of the ring and submits it to
+         *  @param in_queue_ptr straight away, without waiting for it to complete.
+         *
+         *  This is an asynchronous counterpart of Buffer::read(). Please see record_buffer_readback() for
+         *  argument documentation.
+         *
+         *  @param in_queue_ptr Queue to submit the copy to. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool submit_buffer_readback(Anvil::Queue*  in_queue_ptr,
+                                    Anvil::Buffer* in_buffer_ptr,
+                                    VkDeviceSize   in_start_offset,
+                                    VkDeviceSize   in_size,
+                                    ReadbackID*    out_readback_id_ptr);
+
+    private:
+        /* Private type definitions */
+        typedef struct Region
+        {
+            Anvil::PrimaryCommandBufferUniquePtr cmd_buffer_ptr;
+            VkDeviceSize                         end_offset;
+            Anvil::Fence*                        fence_ptr;
+            bool                                 is_complete;
+            bool                                 is_frame_ended;
+            bool                                 is_released;
+            Anvil::FenceUniquePtr                owned_fence_ptr;
+            Anvil::Semaphore*                    semaphore_ptr;
+            uint64_t                             semaphore_value;
+            VkDeviceSize                         size;
+            VkDeviceSize                         start_offset;
+
+            Region(VkDeviceSize in_start_offset,
+                   VkDeviceSize in_size)
+                :end_offset     (in_start_offset + in_size),
+                 fence_ptr      (nullptr),
+                 is_complete    (false),
+                 is_frame_ended (false),
+                 is_released    (false),
+                 semaphore_ptr  (nullptr),
+                 semaphore_value(0),
+                 size           (in_size),
+                 start_offset   (in_start_offset)
+            {
+                /* Stub */
+            }
+        } Region;
+
+        /* Private functions */
+        ReadbackRing(const Anvil::BaseDevice* in_device_ptr,
+                     VkDeviceSize             in_size);
+
+        bool                  allocate_region   (VkDeviceSize in_size,
+                                                 VkDeviceSize in_alignment,
+                                                 ReadbackID*  out_readback_id_ptr);
+        Anvil::FenceUniquePtr get_fence         ();
+        Region*               get_region        (ReadbackID   in_readback_id) const;
+        bool                  init              ();
+        bool                  is_region_complete(Region*      in_region_ptr) const;
+        void                  retire_regions    ();
+        bool                  try_reserve_region(VkDeviceSize  in_size,
+                                                 VkDeviceSize  in_alignment,
+                                                 VkDeviceSize* out_start_offset_ptr) const;
+        void                  wait_for_region   (Region*      in_region_ptr) const;
+
+        /* Private variables */
+        Anvil::BufferUniquePtr             m_buffer_ptr;
+        const Anvil::BaseDevice*           m_device_ptr;
+        ReadbackID                         m_first_region_id;
+        std::vector<Anvil::FenceUniquePtr> m_free_fences;
+        VkDeviceSize                       m_head_offset;
+        mutable std::deque<Region>         m_regions;
+        VkDeviceSize                       m_size;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(ReadbackRing);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(ReadbackRing);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_READBACK_RING_H */
@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a device-wide cache of render passes.
+ *
+ *  Render passes are often re-created from identical create info instances (eg. each time a swapchain is
+ *  re-created, or by independent rendering modules). get_render_pass() returns a shared render pass for all
+ *  create info instances which compare equal and which use the same swapchain, so that identical passes are
+ *  only baked once.
+ *
+ *  Render passes are reference-counted. The cache does not hold a reference of its own, so a render pass is
+ *  released as soon as the last pointer returned for it goes out of scope.
+ *
+ *  Pipelines only depend on render pass compatibility (see RenderPassCreateInfo::is_compatible_with()), so
+ *  render passes which only differ in attachment layouts or load/store ops can share pipelines.
+ *
+ *  This object should ONLY be instantiated by Anvil::BaseDevice.
+ *
+ *  Render pass cache is thread-safe.
+ */
+#ifndef MISC_RENDER_PASS_CACHE_H
+#define MISC_RENDER_PASS_CACHE_H
+
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+#include <unordered_map>
+
+
+namespace Anvil
+{
+    class RenderPassCache : public MTSafetySupportProvider
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new render pass cache instance.
+         *
+         *  @param in_device_ptr Device to create the cache for. Must not be null.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::RenderPassCacheUniquePtr create(const Anvil::BaseDevice* in_device_ptr);
+
+        /** Destructor. */
+        ~RenderPassCache();
+
+        /** Returns the number of get_render_pass() calls which have been served with an existing render pass. */
+        uint32_t get_n_cache_hits() const
+        {
+            return m_n_cache_hits;
+        }
+
+        /** Returns the number of get_render_pass() calls which required a new render pass to be created. */
+        uint32_t get_n_cache_misses() const
+        {
+            return m_n_cache_misses;
+        }
+
+        /** Returns the number of render passes tracked by the cache which are still alive. */
+        uint32_t get_n_cached_render_passes() const;
+
+        /** Returns a render pass created with properties matching @param in_create_info_ptr. If no such render pass
+         *  is alive, a new one is created.
+         *
+         *  @param in_create_info_ptr   Render pass create info. Must not be null. Must have been created for the
+         *                              device which owns the cache.
+         *  @param in_opt_swapchain_ptr Swapchain to pass to RenderPass::create(). May be nullptr.
+         *
+         *  @return Shared render pass if successful, null otherwise.
+         */
+        Anvil::RenderPassSharedPtr get_render_pass(Anvil::RenderPassCreateInfoUniquePtr in_create_info_ptr,
+                                                   Anvil::Swapchain*                    in_opt_swapchain_ptr);
+
+    private:
+        /* Private functions */
+        RenderPassCache(const Anvil::BaseDevice* in_device_ptr);
+
+        /* Private variables */
+        const Anvil::BaseDevice*                                                      m_device_ptr;
+        std::atomic<uint32_t>                                                         m_n_cache_hits;
+        std::atomic<uint32_t>                                                         m_n_cache_misses;
+        std::unordered_map<uint64_t, std::vector<std::weak_ptr<Anvil::RenderPass> > > m_render_passes;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(RenderPassCache);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(RenderPassCache);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_RENDER_PASS_CACHE_H */
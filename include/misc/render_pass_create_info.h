@@ -117,6 +117,34 @@ namespace Anvil
                                           uint32_t                      in_location,
                                           const RenderPassAttachmentID* in_opt_attachment_resolve_id_ptr = nullptr);
 
+        /** Adds a multisample color attachment to the specified subpass, together with a new single-sample render-pass
+         *  attachment the multisample data is resolved to at the end of the subpass.
+         *
+         *  Resolving at the end of the subpass lets the implementation resolve the samples while they are still on-chip.
+         *  Resolving with CommandBufferBase::record_resolve_image() after the render pass requires the whole multisample
+         *  attachment to be stored, and then read back. If the multisample data is not needed after the render pass, its
+         *  attachment should use AttachmentStoreOp::DONT_CARE, so that it never leaves tile memory on tiling GPUs.
+         *
+         *  The resolve attachment uses DONT_CARE load op, STORE store op and UNDEFINED initial layout. Its image view
+         *  must be attached to the framebuffer at the index reported by @param out_opt_resolve_attachment_id_ptr.
+         *
+         *  @param in_subpass_id                     ID of the render-pass subpass to update.
+         *  @param in_layout                         Layout to use for both the color and the resolve attachment when
+         *                                           executing the subpass.
+         *  @param in_attachment_id                  ID of a multisample render-pass color attachment.
+         *  @param in_location                       As per add_subpass_color_attachment().
+         *  @param in_resolve_final_layout           Layout to transition the resolve attachment to at the end of the render pass.
+         *  @param out_opt_resolve_attachment_id_ptr If not nullptr, deref will be set to ID of the new resolve attachment.
+         *
+         *  @return true if the function executed successfully, false otherwise.
+         **/
+        bool add_subpass_color_attachment_with_resolve(SubPassID               in_subpass_id,
+                                                       Anvil::ImageLayout      in_layout,
+                                                       RenderPassAttachmentID  in_attachment_id,
+                                                       uint32_t                in_location,
+                                                       Anvil::ImageLayout      in_resolve_final_layout,
+                                                       RenderPassAttachmentID* out_opt_resolve_attachment_id_ptr = nullptr);
+
         /** Configures the depth+stencil attachment the subpass should use.
          *
          *  Note that only up to one depth/stencil attachment may be added for each subpass.
@@ -164,6 +192,35 @@ namespace Anvil
                                                         nullptr); /* in_stencil_resolve_mode_ptr  */
         }
 
+        /** Configures a multisample depth/stencil attachment for the specified subpass, together with a new single-sample
+         *  render-pass attachment the depth and/or stencil data is resolved to at the end of the subpass.
+         *
+         *  Requires VK_KHR_depth_stencil_resolve and VK_KHR_create_renderpass2, which is used to create render passes
+         *  whenever it is enabled. The resolve modes must be supported by the device, as reported by
+         *  PhysicalDeviceProperties::khr_depth_stencil_resolve_properties_ptr.
+         *
+         *  The resolve attachment is created as per add_subpass_color_attachment_with_resolve(), with the same store op used for
+         *  both aspects.
+         *
+         *  @param in_subpass_id                     ID of the subpass to update.
+         *  @param in_layout                         Layout to use for both the depth/stencil and the resolve attachment when
+         *                                           executing the subpass.
+         *  @param in_attachment_id                  ID of a multisample render-pass depth/stencil attachment.
+         *  @param in_depth_resolve_mode             Resolve mode to use for the depth aspect. May be NONE.
+         *  @param in_stencil_resolve_mode           Resolve mode to use for the stencil aspect. May be NONE.
+         *  @param in_resolve_final_layout           Layout to transition the resolve attachment to at the end of the render pass.
+         *  @param out_opt_resolve_attachment_id_ptr If not nullptr, deref will be set to ID of the new resolve attachment.
+         *
+         *  @return true if the function executed successfully, false otherwise.
+         **/
+        bool add_subpass_depth_stencil_attachment_with_resolve(SubPassID                  in_subpass_id,
+                                                               Anvil::ImageLayout         in_layout,
+                                                               RenderPassAttachmentID     in_attachment_id,
+                                                               Anvil::ResolveModeFlagBits in_depth_resolve_mode,
+                                                               Anvil::ResolveModeFlagBits in_stencil_resolve_mode,
+                                                               Anvil::ImageLayout         in_resolve_final_layout,
+                                                               RenderPassAttachmentID*    out_opt_resolve_attachment_id_ptr = nullptr);
+
         /** Adds a new input attachment to the RenderPass instance's specified subpass.
          *
          *  @param in_subpass_id           ID of the render-pass subpass to update.
@@ -317,6 +374,15 @@ namespace Anvil
                                              Anvil::ImageLayout*         out_opt_final_layout_ptr   = nullptr,
                                              bool*                       out_opt_may_alias_ptr      = nullptr) const;
 
+        /** Returns a hash of the render pass properties which determine render pass compatibility, as defined by
+         *  the Vulkan specification: attachment formats and sample counts, subpass structure, dependencies and
+         *  multiview configuration. Attachment layouts and load/store ops are ignored.
+         *
+         *  Render passes which are compatible return the same hash. Framebuffers and pipelines created for
+         *  a render pass can be used with any render pass it is compatible with.
+         */
+        uint64_t get_compatibility_hash() const;
+
         /** Retrieves properties of a dependency at user-specified index.
          *
          *  @param in_n_dependency                 Index of the dependency to retrieve properties of.
@@ -401,6 +467,9 @@ namespace Anvil
             return m_device_ptr;
         }
 
+        /** Returns a hash of all render pass properties. Create info instances which compare equal return the same hash. */
+        uint64_t get_hash() const;
+
         /* Returns the largest location assigned to color attachments for the specified subpass.
          *
          * If no color attachments have been defined for the queried subpass, UINT32_MAX is returned.
@@ -514,6 +583,11 @@ namespace Anvil
                                    uint32_t* out_view_mask_ptr) const;
 
         /* Tells whether the renderpass uses multiview functionality. */
+        /** Tells whether a render pass created with this create info is compatible with a render pass created
+         *  with @param in_create_info. Please see get_compatibility_hash() for more details.
+         */
+        bool is_compatible_with(const Anvil::RenderPassCreateInfo& in_create_info) const;
+
         bool is_multiview_enabled() const
         {
             return m_multiview_enabled;
@@ -569,6 +643,8 @@ namespace Anvil
         bool set_subpass_view_mask(SubPassID       in_subpass_id,
                                    const uint32_t& in_view_mask);
 
+        bool operator==(const Anvil::RenderPassCreateInfo& in_create_info) const;
+
     private:
         /* Private type definitions */
 
@@ -917,6 +993,8 @@ namespace Anvil
         VkAttachmentReference get_attachment_reference_from_subpass_attachment   (const SubPassAttachment&                           in_subpass_attachment)                   const;
         VkAttachmentReference get_attachment_reference_for_resolve_attachment    (const SubPassesConstIterator&                      in_subpass_iterator,
                                                                                   const LocationToSubPassAttachmentMapConstIterator& in_location_to_subpass_att_map_iterator) const;
+        void                  get_key                                            (bool                                               in_compatibility_only,
+                                                                                  std::vector<uint64_t>*                             out_key_ptr)                             const;
         void                  update_preserved_attachments                       () const;
 
 
@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a device-wide cache of samplers.
+ *
+ *  Identical samplers are frequently created by independent parts of an app (eg. one per material). Since
+ *  implementations cap the number of samplers which can exist at any given time (maxSamplerAllocationCount),
+ *  get_sampler() returns a shared sampler for all create info instances which compare equal, including the
+ *  YCbCr conversion object, which is identified by its wrapper address.
+ *
+ *  Samplers are reference-counted. The cache does not hold a reference of its own, so a sampler is released as
+ *  soon as the last pointer returned for it goes out of scope. It is the app's responsibility to make sure the
+ *  GPU no longer uses the sampler at that point, as it would be for samplers created with Sampler::create().
+ *
+ *  This object should ONLY be instantiated by Anvil::BaseDevice.
+ *
+ *  Sampler cache is thread-safe.
+ */
+#ifndef MISC_SAMPLER_CACHE_H
+#define MISC_SAMPLER_CACHE_H
+
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+#include <unordered_map>
+
+
+namespace Anvil
+{
+    class SamplerCache : public MTSafetySupportProvider
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new sampler cache instance.
+         *
+         *  @param in_device_ptr Device to create the cache for. Must not be null.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::SamplerCacheUniquePtr create(const Anvil::BaseDevice* in_device_ptr);
+
+        /** Destructor. */
+        ~SamplerCache();
+
+        /** Returns the number of get_sampler() calls which have been served with an existing sampler. */
+        uint32_t get_n_cache_hits() const
+        {
+            return m_n_cache_hits;
+        }
+
+        /** Returns the number of get_sampler() calls which required a new sampler to be created. */
+        uint32_t get_n_cache_misses() const
+        {
+            return m_n_cache_misses;
+        }
+
+        /** Returns the number of samplers tracked by the cache which are still alive. */
+        uint32_t get_n_cached_samplers() const;
+
+        /** Returns a sampler created with properties matching @param in_create_info_ptr. If no such sampler is alive,
+         *  a new one is created.
+         *
+         *  @param in_create_info_ptr Sampler create info. Must not be null. Must have been created for the device
+         *                            which owns the cache.
+         *
+         *  @return Shared sampler if successful, null otherwise.
+         */
+        Anvil::SamplerSharedPtr get_sampler(Anvil::SamplerCreateInfoUniquePtr in_create_info_ptr);
+
+    private:
+        /* Private functions */
+        SamplerCache(const Anvil::BaseDevice* in_device_ptr);
+
+        /* Private variables */
+        const Anvil::BaseDevice*                                                   m_device_ptr;
+        std::atomic<uint32_t>                                                      m_n_cache_hits;
+        std::atomic<uint32_t>                                                      m_n_cache_misses;
+        std::unordered_map<uint64_t, std::vector<std::weak_ptr<Anvil::Sampler> > > m_samplers;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(SamplerCache);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(SamplerCache);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_SAMPLER_CACHE_H */
@@ -85,6 +85,12 @@ namespace Anvil
             return m_device_ptr;
         }
 
+        /** Returns a hash of the create info. Create info instances which compare equal return the same hash.
+         *
+         *  The YCbCr conversion object, if any, is identified by its wrapper address.
+         */
+        uint64_t get_hash() const;
+
         const float& get_lod_bias() const
         {
             return m_lod_bias;
@@ -245,6 +251,8 @@ namespace Anvil
             return m_use_unnormalized_coordinates;
         }
 
+        bool operator==(const Anvil::SamplerCreateInfo& in_create_info) const;
+
     private:
         /* Private functions */
 
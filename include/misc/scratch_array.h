@@ -0,0 +1,126 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a fixed-size array used to convert Anvil structures to their Vulkan counterparts.
+ *
+ *  Up to N_STACK_ITEMS items are stored in-place, so that scratch arrays declared on the stack do not
+ *  touch the heap for typical item counts. Larger arrays fall back to a heap allocation.
+ *
+ *  Items are NOT initialized, so the type should be a POD structure.
+ *
+ *  Scratch array is NOT thread-safe.
+ */
+#ifndef MISC_SCRATCH_ARRAY_H
+#define MISC_SCRATCH_ARRAY_H
+
+#include "misc/debug.h"
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    template<typename T, uint32_t N_STACK_ITEMS>
+    class ScratchArray
+    {
+    public:
+        /* Public functions */
+
+        /** Constructor.
+         *
+         *  @param in_n_items Number of items the array should hold.
+         **/
+        explicit ScratchArray(uint32_t in_n_items)
+            :m_items_ptr(m_stack_items),
+             m_n_items  (in_n_items)
+        {
+            if (in_n_items > N_STACK_ITEMS)
+            {
+                m_heap_items_ptr.reset(new T[in_n_items]);
+
+                m_items_ptr = m_heap_items_ptr.get();
+            }
+        }
+
+        T& at(uint32_t in_n_item)
+        {
+            anvil_assert(in_n_item < m_n_items);
+
+            return m_items_ptr[in_n_item];
+        }
+
+        const T& at(uint32_t in_n_item) const
+        {
+            anvil_assert(in_n_item < m_n_items);
+
+            return m_items_ptr[in_n_item];
+        }
+
+        T* begin()
+        {
+            return m_items_ptr;
+        }
+
+        const T* begin() const
+        {
+            return m_items_ptr;
+        }
+
+        /** Returns a pointer to the first item, or nullptr if the array is empty. */
+        const T* data() const
+        {
+            return (m_n_items > 0) ? m_items_ptr : nullptr;
+        }
+
+        T* end()
+        {
+            return m_items_ptr + m_n_items;
+        }
+
+        const T* end() const
+        {
+            return m_items_ptr + m_n_items;
+        }
+
+        /** Tells whether the items had to be allocated on the heap. */
+        bool is_heap_allocated() const
+        {
+            return (m_heap_items_ptr != nullptr);
+        }
+
+        uint32_t size() const
+        {
+            return m_n_items;
+        }
+
+    private:
+        /* Private variables */
+        std::unique_ptr<T[]> m_heap_items_ptr;
+        T*                   m_items_ptr;
+        uint32_t             m_n_items;
+        T                    m_stack_items[N_STACK_ITEMS];
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(ScratchArray);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(ScratchArray);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_SCRATCH_ARRAY_H */
@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements shader hot-reloading, for quick content iteration.
+ *
+ *  Shaders are registered with the reloader as GLSLShaderToSPIRVGenerator instances, which load their GLSL source code
+ *  from files. The reloader creates and owns a shader module for each of them. Every time poll() is called, the
+ *  modification times of all source files, as well as of all headers they include, are checked. For each shader whose
+ *  source file or any of the included headers has changed since the last check:
+ *
+ *  - changed headers are invalidated in the generator's header cache, so that their new contents are picked up.
+ *  - the generator's SPIR-V blob is re-baked. If the generator has been assigned a SPIR-V cache directory, the cache
+ *    is used, so reverted changes do not need to be recompiled.
+ *  - a new shader module is created.
+ *  - all pipelines of the device's compute and graphics pipeline managers which use the previous shader module are
+ *    rebuilt, as per BasePipelineManager::replace_shader_module(). If async compilation is enabled for a manager,
+ *    the pipelines are re-baked on its compiler thread and swapped in as soon as they are ready. Until then, the
+ *    previous pipelines continue to be used. Other pipelines are not affected.
+ *
+ *  Shaders which fail to compile are left intact, and are retried the next time their source file or any of the
+ *  included headers changes. Use
+ *  get_glsl_generator() to retrieve the compilation logs.
+ *
+ *  Shader modules and pipelines which have been superseded may still be used by the GPU, so they are retired
+ *  instead of being released. Call release_retired_objects() once the GPU is known to be done with them.
+ *
+ *  Only the files specified at generator creation time and headers included from disk, as reported by
+ *  GLSLShaderToSPIRVGenerator::get_include_dependencies(), are monitored. Files with modification times which differ
+ *  by less than a second may not be told apart.
+ *
+ *  Shader hot reloader is NOT thread-safe.
+ */
+#ifndef MISC_SHADER_HOT_RELOADER_H
+#define MISC_SHADER_HOT_RELOADER_H
+
+#include "misc/types.h"
+#include <map>
+
+
+namespace Anvil
+{
+    class ShaderHotReloader
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new shader hot reloader instance.
+         *
+         *  @param in_device_ptr Device to create shader modules for. Must not be null. Pipelines of the device's
+         *                       compute and graphics pipeline managers are rebuilt whenever a shader is reloaded.
+         *
+         *  @return New instance.
+         */
+        static Anvil::ShaderHotReloaderUniquePtr create(const Anvil::BaseDevice* in_device_ptr);
+
+        /** Destructor. Releases all shader modules owned by the reloader. The caller must make sure the modules are
+         *  no longer referred to by any pipeline which has yet to be baked.
+         */
+        ~ShaderHotReloader();
+
+        /** Registers a new shader with the reloader and creates its shader module.
+         *
+         *  @param in_glsl_generator_ptr Generator to use. Must not be null. Must have been created with
+         *                               MODE_LOAD_SOURCE_FROM_FILE mode.
+         *  @param out_shader_id_ptr     Deref will be set to the ID of the shader. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool add_shader(Anvil::GLSLShaderToSPIRVGeneratorUniquePtr in_glsl_generator_ptr,
+                        uint32_t*                                  out_shader_id_ptr);
+
+        /** Returns the generator of the specified shader. */
+        const Anvil::GLSLShaderToSPIRVGenerator* get_glsl_generator(uint32_t in_shader_id) const;
+
+        /** Returns the current shader module of the specified shader.
+         *
+         *  The returned module is superseded whenever the shader is reloaded, so it should not be cached by the
+         *  app for longer than needed to set up new pipelines.
+         */
+        Anvil::ShaderModule* get_shader_module(uint32_t in_shader_id) const;
+
+        /** Reloads all shaders whose source files, or included headers, have changed since the last check.
+         *
+         *  @param out_opt_reloaded_shader_ids_ptr If not null, deref will be filled with IDs of all shaders which
+         *                                         have been reloaded successfully.
+         *
+         *  @return true if all changed shaders have been reloaded successfully, false otherwise.
+         */
+        bool poll(std::vector<uint32_t>* out_opt_reloaded_shader_ids_ptr = nullptr);
+
+        /** Releases all shader modules and pipelines which have been superseded by reloaded shaders.
+         *
+         *  The caller must make sure none of the retired pipelines is still accessed by the GPU.
+         */
+        void release_retired_objects();
+
+    private:
+        /* Private type definitions */
+        typedef struct Shader
+        {
+            Anvil::GLSLShaderToSPIRVGeneratorUniquePtr glsl_generator_ptr;
+            std::map<std::string, uint64_t>            include_modification_times;
+            uint64_t                                   modification_time;
+            Anvil::ShaderModuleUniquePtr               shader_module_ptr;
+
+            Shader()
+                :modification_time(0)
+            {
+                /* Stub */
+            }
+        } Shader;
+
+        /* Private functions */
+        ShaderHotReloader(const Anvil::BaseDevice* in_device_ptr);
+
+        bool reload_shader                    (Shader* in_shader_ptr);
+        void update_include_modification_times(Shader* in_shader_ptr);
+
+        /* Private variables */
+        const Anvil::BaseDevice*                  m_device_ptr;
+        std::vector<Anvil::ShaderModuleUniquePtr> m_retired_shader_modules;
+        std::vector<std::unique_ptr<Shader> >     m_shaders;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(ShaderHotReloader);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(ShaderHotReloader);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_SHADER_HOT_RELOADER_H */
@@ -26,6 +26,7 @@
 #include "misc/mt_safety.h"
 #include "misc/types.h"
 #include "wrappers/shader_module.h"
+#include <unordered_map>
 
 
 namespace Anvil
@@ -63,40 +64,26 @@ namespace Anvil
         typedef struct HashMapItem
         {
             const Anvil::BaseDevice*     device_ptr;
-            std::vector<uint32_t>        spirv_blob;
+            uint64_t                     hash;
             Anvil::ShaderModuleUniquePtr shader_module_owned_ptr;
 
-            std::string cs_entrypoint_name;
-            std::string fs_entrypoint_name;
-            std::string gs_entrypoint_name;
-            std::string tc_entrypoint_name;
-            std::string te_entrypoint_name;
-            std::string vs_entrypoint_name;
-
-            explicit HashMapItem(const Anvil::BaseDevice*     in_device_ptr,
-                                 const std::vector<uint32_t>& in_spirv_blob,
-                                 const std::string&           in_cs_entrypoint_name,
-                                 const std::string&           in_fs_entrypoint_name,
-                                 const std::string&           in_gs_entrypoint_name,
-                                 const std::string&           in_tc_entrypoint_name,
-                                 const std::string&           in_te_entrypoint_name,
-                                 const std::string&           in_vs_entrypoint_name,
-                                 Anvil::ShaderModule*         in_shader_module_ptr)
+            explicit HashMapItem(const Anvil::BaseDevice* in_device_ptr,
+                                 uint64_t                 in_hash,
+                                 Anvil::ShaderModule*     in_shader_module_ptr)
             {
                 device_ptr              = in_device_ptr;
-                spirv_blob              = in_spirv_blob;
+                hash                    = in_hash;
                 shader_module_owned_ptr = Anvil::ShaderModuleUniquePtr(in_shader_module_ptr,
                                                                        std::default_delete<ShaderModule>() );
-
-                cs_entrypoint_name = in_cs_entrypoint_name;
-                fs_entrypoint_name = in_fs_entrypoint_name;
-                gs_entrypoint_name = in_gs_entrypoint_name;
-                tc_entrypoint_name = in_tc_entrypoint_name;
-                te_entrypoint_name = in_te_entrypoint_name;
-                vs_entrypoint_name = in_vs_entrypoint_name;
             }
 
+            /** Tells whether the cached shader module has been created with the specified properties.
+             *
+             *  SPIR-V blob and entry-point names are compared against the shader module's own copies,
+             *  so the item does not need to duplicate them.
+             **/
             bool matches(const Anvil::BaseDevice* in_device_ptr,
+                         uint64_t                 in_hash,
                          const char*              in_spirv_blob,
                          uint32_t                 in_n_spirv_blob_bytes,
                          const std::string&       in_cs_entrypoint_name,
@@ -106,21 +93,19 @@ namespace Anvil
                          const std::string&       in_te_entrypoint_name,
                          const std::string&       in_vs_entrypoint_name) const
             {
-                bool result = (spirv_blob.size() * sizeof(spirv_blob.at(0)) == in_n_spirv_blob_bytes);
-
-                if (result)
-                {
-                    result = (cs_entrypoint_name == in_cs_entrypoint_name &&
-                              fs_entrypoint_name == in_fs_entrypoint_name &&
-                              gs_entrypoint_name == in_gs_entrypoint_name &&
-                              tc_entrypoint_name == in_tc_entrypoint_name &&
-                              te_entrypoint_name == in_te_entrypoint_name &&
-                              vs_entrypoint_name == in_vs_entrypoint_name);
-                }
+                const auto& spirv_blob = shader_module_owned_ptr->get_spirv_blob();
+                bool        result     = (hash       == in_hash       &&
+                                          device_ptr == in_device_ptr &&
+                                          spirv_blob.size() * sizeof(spirv_blob.at(0)) == in_n_spirv_blob_bytes);
 
                 if (result)
                 {
-                    result = (device_ptr == in_device_ptr);
+                    result = (shader_module_owned_ptr->get_cs_entrypoint_name() == in_cs_entrypoint_name &&
+                              shader_module_owned_ptr->get_fs_entrypoint_name() == in_fs_entrypoint_name &&
+                              shader_module_owned_ptr->get_gs_entrypoint_name() == in_gs_entrypoint_name &&
+                              shader_module_owned_ptr->get_tc_entrypoint_name() == in_tc_entrypoint_name &&
+                              shader_module_owned_ptr->get_te_entrypoint_name() == in_te_entrypoint_name &&
+                              shader_module_owned_ptr->get_vs_entrypoint_name() == in_vs_entrypoint_name);
                 }
 
                 if (result)
@@ -143,20 +128,19 @@ namespace Anvil
         void cache               (Anvil::ShaderModule* in_shader_module_ptr);
         void update_subscriptions(bool                 in_should_init);
 
-        size_t get_hash(const char*        in_spirv_blob,
-                        uint32_t           in_n_spirv_blob_bytes,
-                        const std::string& in_cs_entrypoint_name,
-                        const std::string& in_fs_entrypoint_name,
-                        const std::string& in_gs_entrypoint_name,
-                        const std::string& in_tc_entrypoint_name,
-                        const std::string& in_te_entrypoint_name,
-                        const std::string& in_vs_entrypoint_name) const;
+        uint64_t get_hash(uint64_t           in_spirv_blob_hash,
+                          const std::string& in_cs_entrypoint_name,
+                          const std::string& in_fs_entrypoint_name,
+                          const std::string& in_gs_entrypoint_name,
+                          const std::string& in_tc_entrypoint_name,
+                          const std::string& in_te_entrypoint_name,
+                          const std::string& in_vs_entrypoint_name) const;
 
         void on_shader_module_object_about_to_be_released(CallbackArgument* in_callback_arg_ptr);
         void on_shader_module_object_registered          (CallbackArgument* in_callback_arg_ptr);
 
         /* Private variables */
-        std::map<size_t, HashMapItems> m_item_ptrs;
+        std::unordered_map<uint64_t, HashMapItems> m_item_ptrs;
 
         ANVIL_DISABLE_ASSIGNMENT_OPERATOR(ShaderModuleCache);
         ANVIL_DISABLE_COPY_CONSTRUCTOR(ShaderModuleCache);
@@ -0,0 +1,215 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements a lightweight SPIR-V reflection pass. The pass walks the SPIR-V word stream of one or more shader
+ *  stages, and extracts the descriptor bindings, push constant ranges and specialization constants they use.
+ *
+ *  Only resources which are statically referenced by the entry-point's call tree are reported, and each resource is
+ *  only assigned the stages which access it. The results can be used to fill a pipeline create info with exact
+ *  descriptor set create info items & push constant ranges, in place of hand-maintained layouts. This keeps bindings
+ *  and stage flags minimal, which saves descriptor memory and gives the driver more room for optimizations.
+ *
+ *  Limitations:
+ *
+ *  - Uniform and storage buffers are reported as non-dynamic. Use set_descriptor_type() to switch them to their
+ *    dynamic counterparts.
+ *  - Runtime descriptor arrays are reported as variable descriptor count bindings.
+ *  - Inline uniform blocks and acceleration structures are not recognized.
+ *
+ *  For compute stages, the local workgroup size is also reported, together with the IDs of specialization constants
+ *  which drive it, if any.
+ *
+ *  The reflection pass does not require any external dependencies.
+ */
+#ifndef MISC_SHADER_REFLECTION_H
+#define MISC_SHADER_REFLECTION_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class ShaderReflection
+    {
+    public:
+        /* Public type definitions */
+
+        /** Describes a single descriptor binding used by the reflected stages. */
+        typedef struct Binding
+        {
+            Anvil::DescriptorType   descriptor_type;
+            uint32_t                n_descriptors;   /* 0 for runtime arrays */
+            Anvil::ShaderStageFlags stages;
+
+            Binding()
+                :descriptor_type(Anvil::DescriptorType::UNKNOWN),
+                 n_descriptors  (0)
+            {
+                /* Stub */
+            }
+        } Binding;
+
+        /** Describes a single specialization constant declared by the reflected stages. */
+        typedef struct SpecializationConstantInfo
+        {
+            uint32_t                constant_id;
+            uint32_t                n_bytes;
+            Anvil::ShaderStageFlags stages;
+
+            SpecializationConstantInfo()
+                :constant_id(UINT32_MAX),
+                 n_bytes    (0)
+            {
+                /* Stub */
+            }
+        } SpecializationConstantInfo;
+
+        typedef std::pair<uint32_t, uint32_t>                   BindingLocation; /* descriptor set index, binding index */
+        typedef std::map<BindingLocation, Binding>              Bindings;
+        typedef std::map<uint32_t, SpecializationConstantInfo> SpecializationConstantInfos;
+
+        /* Public functions */
+
+        /** Creates a new, empty reflection instance. Use add_shader_stage() or add_spirv_blob() to reflect shader stages. */
+        static Anvil::ShaderReflectionUniquePtr create();
+
+        /** Creates a new reflection instance and reflects all shader stages used by the specified pipeline.
+         *
+         *  @param in_pipeline_create_info_ptr Pipeline create info to reflect the shader stages of. Must not be null.
+         *
+         *  @return New instance if successful, null if any of the stages could not be reflected.
+         */
+        static Anvil::ShaderReflectionUniquePtr create_for_pipeline(const Anvil::BasePipelineCreateInfo* in_pipeline_create_info_ptr);
+
+        /** Destructor. */
+        ~ShaderReflection();
+
+        /** Reflects the specified shader stage.
+         *
+         *  @param in_entrypoint Entry-point to reflect. The shader module's SPIR-V blob is used.
+         *
+         *  @return true if successful, false if the blob is malformed, the entry-point could not be found, or a binding
+         *          conflicts with a binding reported by another stage.
+         */
+        bool add_shader_stage(const Anvil::ShaderModuleStageEntryPoint& in_entrypoint);
+
+        /** Reflects the specified entry-point of a SPIR-V blob.
+         *
+         *  @param in_spirv_blob           SPIR-V blob to reflect. Must not be null.
+         *  @param in_n_spirv_blob_uint32s Number of words held by @param in_spirv_blob.
+         *  @param in_shader_stage         Shader stage of the entry-point.
+         *  @param in_entrypoint_name      Name of the entry-point.
+         *
+         *  @return As per add_shader_stage().
+         */
+        bool add_spirv_blob(const uint32_t*    in_spirv_blob,
+                            uint32_t           in_n_spirv_blob_uint32s,
+                            Anvil::ShaderStage in_shader_stage,
+                            const std::string& in_entrypoint_name);
+
+        /** Assigns descriptor set create info items and push constant ranges, as reported by the reflected stages, to
+         *  the specified pipeline create info.
+         *
+         *  @param inout_pipeline_create_info_ptr     Pipeline create info to configure. Must not be null. Must not have been
+         *                                            assigned any descriptor set create info items or push constant ranges.
+         *  @param in_n_max_runtime_array_descriptors Maximum number of descriptors to use for runtime descriptor arrays.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool configure_pipeline_create_info(Anvil::BasePipelineCreateInfo* inout_pipeline_create_info_ptr,
+                                            uint32_t                       in_n_max_runtime_array_descriptors = 1024) const;
+
+        /** Returns all descriptor bindings used by the reflected stages. */
+        const Bindings& get_bindings() const
+        {
+            return m_bindings;
+        }
+
+        /** Creates descriptor set create info items for all bindings used by the reflected stages. Sets which are not
+         *  used by any of the stages are represented by null items.
+         *
+         *  @param out_ds_create_info_items_ptr       Deref will be set to the create info items, indexed by set index. Must
+         *                                            not be null.
+         *  @param in_n_max_runtime_array_descriptors Maximum number of descriptors to use for runtime descriptor arrays.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool get_descriptor_set_create_infos(std::vector<Anvil::DescriptorSetCreateInfoUniquePtr>* out_ds_create_info_items_ptr,
+                                             uint32_t                                              in_n_max_runtime_array_descriptors = 1024) const;
+
+        /** Returns the local workgroup size declared by the reflected compute stage. Components driven by specialization
+         *  constants hold the constants' default values. {1, 1, 1} is returned if no compute stage has been reflected.
+         */
+        const std::array<uint32_t, 3>& get_local_workgroup_size() const
+        {
+            return m_local_workgroup_size;
+        }
+
+        /** Returns IDs of specialization constants which drive the local workgroup size components of the reflected
+         *  compute stage. Components which are not specialized are assigned UINT32_MAX.
+         */
+        const std::array<uint32_t, 3>& get_local_workgroup_size_spec_ids() const
+        {
+            return m_local_workgroup_size_spec_ids;
+        }
+
+        /** Returns push constant ranges used by the reflected stages. Stages which use identical ranges share
+         *  a single item.
+         */
+        Anvil::PushConstantRanges get_push_constant_ranges() const;
+
+        /** Returns all specialization constants declared by the reflected stages, indexed by constant ID. */
+        const SpecializationConstantInfos& get_specialization_constants() const
+        {
+            return m_specialization_constants;
+        }
+
+        /** Changes the descriptor type of a reflected buffer binding to its dynamic counterpart, or back.
+         *
+         *  @param in_set_index       Index of the descriptor set the binding belongs to.
+         *  @param in_binding_index   Index of the binding.
+         *  @param in_descriptor_type New descriptor type. Must be compatible with the reflected one.
+         *
+         *  @return true if successful, false if the binding has not been reflected, or if the types are not compatible.
+         */
+        bool set_descriptor_type(uint32_t              in_set_index,
+                                 uint32_t              in_binding_index,
+                                 Anvil::DescriptorType in_descriptor_type);
+
+    private:
+        /* Private functions */
+        ShaderReflection();
+
+        /* Private variables */
+        Bindings                                        m_bindings;
+        std::array<uint32_t, 3>                         m_local_workgroup_size;
+        std::array<uint32_t, 3>                         m_local_workgroup_size_spec_ids;
+        std::map<Anvil::ShaderStage, PushConstantRange> m_push_constant_ranges;
+        SpecializationConstantInfos                     m_specialization_constants;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(ShaderReflection);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(ShaderReflection);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_SHADER_REFLECTION_H */
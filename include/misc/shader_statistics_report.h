@@ -0,0 +1,200 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements a shader statistics report, meant to help tune register & LDS usage for occupancy.
+ *
+ *  The report gathers per-stage resource usage of every pipeline baked by one or more pipeline managers, works out
+ *  the theoretical number of waves each SIMD can keep in flight for it, and sorts the stages so that the ones which
+ *  limit occupancy the most come first.
+ *
+ *  Two sources of statistics are supported:
+ *
+ *  - VK_AMD_shader_info: VGPR, SGPR, LDS and scratch usage are reported for each shader stage. Theoretical
+ *    occupancy is derived from these, using the shader core properties reported by VK_AMD_shader_core_properties
+ *    if available, or GCN defaults otherwise. For compute pipelines, LDS usage of a workgroup is taken into
+ *    account, too.
+ *  - VK_KHR_pipeline_executable_properties: the statistics reported by the driver for each pipeline executable
+ *    are stored as is. Values whose names match well-known register, LDS & scratch statistics are used for
+ *    the occupancy estimate. If the driver reports the number of waves (or subgroups) per SIMD directly, that
+ *    value takes precedence. Statistics are only reported for pipelines created with
+ *    Anvil::PipelineCreateFlagBits::CAPTURE_STATISTICS_BIT_KHR.
+ *
+ *  VK_AMD_shader_info is used if both extensions are enabled. Stages for which no occupancy estimate could be made
+ *  are reported last.
+ *
+ *  Shader statistics report is NOT thread-safe.
+ */
+#ifndef MISC_SHADER_STATISTICS_REPORT_H
+#define MISC_SHADER_STATISTICS_REPORT_H
+
+#include "misc/base_pipeline_manager.h"
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class ShaderStatisticsReport
+    {
+    public:
+        /* Public type definitions */
+        typedef struct Entry
+        {
+            /* Name of the pipeline, as specified with BasePipelineCreateInfo::set_name(). */
+            std::string             pipeline_name;
+
+            Anvil::PipelineID       pipeline_id;
+
+            /* Stages covered by the entry. Only holds more than one bit if the driver has merged stages
+             * into a single pipeline executable. */
+            Anvil::ShaderStageFlags stages;
+
+            uint32_t                lds_usage_bytes;
+            uint32_t                n_used_sgprs;
+            uint32_t                n_used_vgprs;
+            uint32_t                scratch_usage_bytes;
+
+            /* Theoretical number of waves a SIMD can keep in flight, and the maximum the SIMD supports. Only valid
+             * if has_occupancy is true. */
+            bool                    has_occupancy;
+            uint32_t                n_max_waves_per_simd;
+            uint32_t                n_waves_per_simd;
+
+            /* Statistics reported through VK_KHR_pipeline_executable_properties. Empty for entries gathered
+             * with VK_AMD_shader_info. */
+            std::vector<Anvil::BasePipelineManager::PipelineExecutableStatistic> executable_statistics;
+
+            Entry()
+                :pipeline_id         (UINT32_MAX),
+                 stages              (Anvil::ShaderStageFlagBits::NONE),
+                 lds_usage_bytes     (0),
+                 n_used_sgprs        (0),
+                 n_used_vgprs        (0),
+                 scratch_usage_bytes (0),
+                 has_occupancy       (false),
+                 n_max_waves_per_simd(0),
+                 n_waves_per_simd    (0)
+            {
+                /* Stub */
+            }
+
+            /** Returns theoretical occupancy in <0, 1> range, or 0 if has_occupancy is false. */
+            float get_occupancy() const
+            {
+                return (has_occupancy && n_max_waves_per_simd > 0) ? static_cast<float>(n_waves_per_simd) / static_cast<float>(n_max_waves_per_simd)
+                                                                  : 0.0f;
+            }
+        } Entry;
+
+        /* Public functions */
+
+        /** Creates a new, empty shader statistics report.
+         *
+         *  @param in_device_ptr Device the reported pipelines have been created for. Must not be null.
+         *                       Either VK_AMD_shader_info or VK_KHR_pipeline_executable_properties must have
+         *                       been enabled for the device.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::ShaderStatisticsReportUniquePtr create(const Anvil::BaseDevice* in_device_ptr);
+
+        /** Destructor. */
+        ~ShaderStatisticsReport();
+
+        /** Gathers statistics of all pipelines baked by @param in_pipeline_manager_ptr and adds them to the report.
+         *  Outstanding pipelines are baked first.
+         *
+         *  @param in_pipeline_manager_ptr Pipeline manager to gather the statistics from. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool add_pipelines(Anvil::BasePipelineManager* in_pipeline_manager_ptr);
+
+        /** Gathers statistics of pipelines baked by the device's compute & graphics pipeline managers. Please see
+         *  add_pipelines() for more details.
+         */
+        bool add_device_pipelines();
+
+        /** Drops all entries gathered so far. */
+        void clear()
+        {
+            m_entries.clear();
+        }
+
+        /** Returns all entries gathered so far, sorted by theoretical occupancy in ascending order. Ties are
+         *  broken by VGPR usage, in descending order. */
+        const std::vector<Entry>& get_entries() const
+        {
+            return m_entries;
+        }
+
+        /** Returns a human-readable table listing the gathered entries, worst offenders first.
+         *
+         *  @param in_n_max_entries Maximum number of entries to list. UINT32_MAX lists all of them.
+         */
+        std::string to_string(uint32_t in_n_max_entries = UINT32_MAX) const;
+
+    private:
+        /* Private type definitions */
+
+        /** Register file & LDS limits of a single compute unit, used for the occupancy estimate. */
+        typedef struct ShaderCoreLimits
+        {
+            uint32_t lds_per_compute_unit;
+            uint32_t min_sgpr_allocation;
+            uint32_t min_vgpr_allocation;
+            uint32_t sgpr_allocation_granularity;
+            uint32_t sgprs_per_simd;
+            uint32_t simd_per_compute_unit;
+            uint32_t vgpr_allocation_granularity;
+            uint32_t vgprs_per_simd;
+            uint32_t wavefront_size;
+            uint32_t wavefronts_per_simd;
+
+            ShaderCoreLimits();
+        } ShaderCoreLimits;
+
+        /* Private functions */
+        explicit ShaderStatisticsReport(const Anvil::BaseDevice* in_device_ptr);
+
+        bool add_pipeline_amd  (Anvil::BasePipelineManager* in_pipeline_manager_ptr,
+                                Anvil::PipelineID           in_pipeline_id);
+        bool add_pipeline_khr  (Anvil::BasePipelineManager* in_pipeline_manager_ptr,
+                                Anvil::PipelineID           in_pipeline_id);
+        void estimate_occupancy(uint32_t                    in_n_threads_per_workgroup,
+                                Entry*                      inout_entry_ptr) const;
+        bool init              ();
+        void sort_entries      ();
+
+        /* Private variables */
+        const Anvil::BaseDevice* m_device_ptr;
+        std::vector<Entry>       m_entries;
+        bool                     m_has_shader_core_properties;
+        ShaderCoreLimits         m_limits;
+        bool                     m_use_amd_shader_info;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(ShaderStatisticsReport);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(ShaderStatisticsReport);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_SHADER_STATISTICS_REPORT_H */
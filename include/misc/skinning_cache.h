@@ -0,0 +1,212 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements a cache of post-skinning vertex data, so that skinned meshes drawn in multiple passes of a frame
+ *  (shadow maps, depth prepass, main pass, ..) only need to be skinned once per frame.
+ *
+ *  Each entry owns a region of a pooled vertex buffer, sized to hold the mesh's skinned vertices. Once per frame,
+ *  the app captures the skinned vertices of an entry into its region and then binds the region as a plain vertex
+ *  buffer in all passes which draw the mesh, using a pass-through vertex shader.
+ *
+ *  Two capture modes are supported:
+ *
+ *  - TRANSFORM_FEEDBACK: the app draws the mesh with its skinning vertex shader and rasterization discard enabled,
+ *                        between record_begin_capture() and record_end_capture() calls. The entry's region is bound
+ *                        as transform feedback buffer 0. Since transform feedback requires an active render pass,
+ *                        captures need to be recorded inside one. Requires VK_EXT_transform_feedback.
+ *  - COMPUTE:            the app skins the mesh with a compute shader which writes the vertices to the storage buffer
+ *                        region returned by get_output(), between the same two calls. Used as a fallback if
+ *                        transform feedback is unavailable.
+ *
+ *  The app is expected to call record_pre_capture_barrier() before the first capture of a frame and
+ *  record_post_capture_barrier() after the last one, both outside of render passes. The former makes sure the GPU
+ *  has finished reading the previous frame's data before it is overwritten, and the latter makes the captured
+ *  data visible to vertex input.
+ *
+ *  SkinningCache is NOT thread-safe.
+ */
+#ifndef MISC_SKINNING_CACHE_H
+#define MISC_SKINNING_CACHE_H
+
+#include "misc/buffer_suballocator.h"
+#include "misc/types.h"
+#include <unordered_map>
+
+
+namespace Anvil
+{
+    class SkinningCache
+    {
+    public:
+        /* Public type definitions */
+        typedef uint32_t EntryID;
+
+        enum class Mode
+        {
+            COMPUTE,
+            TRANSFORM_FEEDBACK,
+        };
+
+        /* Public functions */
+
+        /** Creates a new skinning cache instance.
+         *
+         *  @param in_device_ptr Device to create the cache for. Must not be null.
+         *  @param in_mode       Preferred capture mode. If TRANSFORM_FEEDBACK is requested, but the device does not
+         *                       support it, the cache falls back to COMPUTE. Use get_mode() to find out which mode
+         *                       is actually used.
+         *  @param in_block_size Size of the pooled buffers to carve entry regions from. Must not be 0.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::SkinningCacheUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
+                                                    Mode                     in_mode,
+                                                    VkDeviceSize             in_block_size = 16 * 1024 * 1024);
+
+        /** Destructor. The caller must make sure none of the regions is still accessed by the GPU. */
+        ~SkinningCache();
+
+        /** Registers a new mesh with the cache and allocates a region for its skinned vertices.
+         *
+         *  @param in_n_vertices    Number of vertices the skinning pass outputs. Must not be 0.
+         *  @param in_vertex_stride Size of a single skinned vertex. Must be a multiple of 4 and must not be 0.
+         *  @param out_entry_id_ptr Deref will be set to the new entry's ID if the call succeeds. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool add_entry(uint32_t in_n_vertices,
+                       uint32_t in_vertex_stride,
+                       EntryID* out_entry_id_ptr);
+
+        /** Moves to the next frame. All entries are considered stale until they are captured again. */
+        void begin_frame();
+
+        /** Returns the capture mode used by the cache. */
+        Mode get_mode() const
+        {
+            return m_mode;
+        }
+
+        /** Returns the number of pooled buffers created so far. */
+        uint32_t get_n_blocks() const
+        {
+            return m_suballocator_ptr->get_n_blocks();
+        }
+
+        /** Returns the location of the entry's skinned vertices.
+         *
+         *  @param in_entry_id        ID of the entry to use.
+         *  @param out_buffer_ptr_ptr Deref will be set to the pooled buffer holding the region. Must not be null.
+         *  @param out_offset_ptr     Deref will be set to the start offset of the region. Must not be null.
+         *  @param out_opt_size_ptr   If not null, deref will be set to the size of the region.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool get_output(EntryID         in_entry_id,
+                        Anvil::Buffer** out_buffer_ptr_ptr,
+                        VkDeviceSize*   out_offset_ptr,
+                        VkDeviceSize*   out_opt_size_ptr = nullptr) const;
+
+        /** Tells whether the entry's skinned vertices have been captured in the current frame. Passes which find
+         *  the entry captured can draw from the cache instead of skinning the mesh again.
+         */
+        bool is_captured(EntryID in_entry_id) const;
+
+        /** Starts capturing the skinned vertices of an entry. In TRANSFORM_FEEDBACK mode, binds the entry's region
+         *  as transform feedback buffer 0 and begins transform feedback. Does nothing in COMPUTE mode.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the commands to. Must not be null.
+         *  @param in_entry_id       ID of the entry to capture.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_begin_capture(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                  EntryID                   in_entry_id);
+
+        /** Binds the entry's skinned vertices as a vertex buffer. The entry must have been captured in the current
+         *  frame.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the commands to. Must not be null.
+         *  @param in_entry_id       ID of the entry to bind.
+         *  @param in_binding        Vertex buffer binding to use.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_bind_vertex_buffer(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                       EntryID                   in_entry_id,
+                                       uint32_t                  in_binding);
+
+        /** Finishes a capture started with record_begin_capture() and marks the entry as captured for the current
+         *  frame.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the commands to. Must not be null.
+         *  @param in_entry_id       ID of the entry being captured.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_end_capture(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                EntryID                   in_entry_id);
+
+        /** Records a barrier which makes all captures recorded so far visible to vertex input. */
+        bool record_post_capture_barrier(Anvil::CommandBufferBase* in_cmd_buffer_ptr) const;
+
+        /** Records a barrier which makes subsequent captures wait until earlier vertex input reads finish. */
+        bool record_pre_capture_barrier(Anvil::CommandBufferBase* in_cmd_buffer_ptr) const;
+
+        /** Releases an entry's region. The caller must make sure the GPU is no longer accessing it. */
+        void remove_entry(EntryID in_entry_id);
+
+    private:
+        /* Private type definitions */
+        typedef struct Entry
+        {
+            Anvil::BufferSuballocator::Allocation allocation;
+            uint64_t                              n_captured_frame;
+
+            Entry()
+                :n_captured_frame(UINT64_MAX)
+            {
+                /* Stub */
+            }
+        } Entry;
+
+        /* Private functions */
+        SkinningCache(const Anvil::BaseDevice* in_device_ptr,
+                      Mode                     in_mode);
+
+        bool init(VkDeviceSize in_block_size);
+
+        /* Private variables */
+        const Anvil::BaseDevice*           m_device_ptr;
+        std::unordered_map<EntryID, Entry> m_entries;
+        Mode                               m_mode;
+        uint64_t                           m_n_current_frame;
+        EntryID                            m_n_next_entry_id;
+        Anvil::BufferSuballocatorUniquePtr m_suballocator_ptr;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(SkinningCache);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(SkinningCache);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_SKINNING_CACHE_H */
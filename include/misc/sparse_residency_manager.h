@@ -0,0 +1,272 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a residency manager for sparse resident images, which streams image pages in and out of a fixed
+ *  memory budget.
+ *
+ *  Apps tell the manager which pages (tiles) they need every frame by calling request_page() or request_pages(),
+ *  for instance with the contents of a feedback buffer. commit() then binds memory to all requested pages which
+ *  are not resident yet, using a single vkQueueBindSparse() call per frame. Physical pages are carved out of
+ *  memory blocks pooled by the manager, which are allocated on demand until the budget is reached. Once the budget
+ *  is exhausted, the least recently requested pages which have not been requested in the current frame are
+ *  evicted to make room for the new ones.
+ *
+ *  Newly bound pages hold undefined contents. commit() reports them to the caller, which is then responsible for
+ *  uploading their data, after the bind operation has completed.
+ *
+ *  The mip tail of the image (and, if the image uses one mip tail per layer, of all layers) is bound by the first
+ *  commit() call and stays resident for the manager's lifetime. Pages which belong to the mip tail are always
+ *  considered resident.
+ *
+ *  The manager owns the memory bound to the image. It must therefore be released after the image has stopped
+ *  being used by the GPU.
+ *
+ *  Sparse residency manager is NOT thread-safe, unless created with @param in_mt_safe set to true.
+ */
+#ifndef MISC_SPARSE_RESIDENCY_MANAGER_H
+#define MISC_SPARSE_RESIDENCY_MANAGER_H
+
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class SparseResidencyManager : public MTSafetySupportProvider
+    {
+    public:
+        /* Public type definitions */
+
+        /** Identifies a single page of the managed image aspect. Tile coordinates are expressed in units of
+         *  the aspect's sparse block granularity. */
+        typedef struct PageID
+        {
+            uint32_t n_layer;
+            uint32_t n_mipmap;
+            uint32_t tile_x;
+            uint32_t tile_y;
+            uint32_t tile_z;
+
+            /** Dummy constructor. Should only be used by STL containers. */
+            PageID()
+                :n_layer (0),
+                 n_mipmap(0),
+                 tile_x  (0),
+                 tile_y  (0),
+                 tile_z  (0)
+            {
+                /* Stub */
+            }
+
+            /** Constructor. */
+            PageID(uint32_t in_n_layer,
+                   uint32_t in_n_mipmap,
+                   uint32_t in_tile_x,
+                   uint32_t in_tile_y,
+                   uint32_t in_tile_z)
+                :n_layer (in_n_layer),
+                 n_mipmap(in_n_mipmap),
+                 tile_x  (in_tile_x),
+                 tile_y  (in_tile_y),
+                 tile_z  (in_tile_z)
+            {
+                /* Stub */
+            }
+        } PageID;
+
+        /* Public functions */
+
+        /** Creates a new residency manager instance.
+         *
+         *  @param in_image_ptr                Image to manage. Must not be null. Must have been created with the
+         *                                     SPARSE_RESIDENCY create flag. No memory may be bound to it yet.
+         *  @param in_aspect                   Aspect of the image to manage.
+         *  @param in_n_max_resident_pages     Maximum number of pages (excluding the mip tail) which can be resident at
+         *                                     the same time. Must not be 0.
+         *  @param in_n_pages_per_memory_block Number of pages each pooled memory block can hold. Must not be 0.
+         *  @param in_mt_safe                  True if the instance should be thread-safe.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::SparseResidencyManagerUniquePtr create(Anvil::Image*              in_image_ptr,
+                                                             Anvil::ImageAspectFlagBits in_aspect,
+                                                             uint32_t                   in_n_max_resident_pages,
+                                                             uint32_t                   in_n_pages_per_memory_block = 64,
+                                                             bool                       in_mt_safe                  = false);
+
+        /** Destructor. Releases all memory blocks pooled by the manager.
+         *
+         *  The caller must make sure the image is no longer accessed by the GPU.
+         */
+        ~SparseResidencyManager();
+
+        /** Binds memory to all pages requested since the last commit() call, which are not resident yet. Pages
+         *  are evicted in LRU order as needed, but pages requested since the last commit() call are never evicted.
+         *  Requests which cannot be served because all resident pages are in use are dropped, and need to be
+         *  re-issued in a later frame.
+         *
+         *  All binding updates are submitted with a single Queue::bind_sparse_memory() call.
+         *
+         *  @param in_queue_ptr                  Queue to use for the bind operation. Must support sparse binding.
+         *  @param in_n_signal_semaphores        Number of semaphores to signal once the bind operation completes.
+         *  @param in_opt_signal_semaphore_ptrs  Semaphores to signal. Must not be null if @param in_n_signal_semaphores
+         *                                       is not 0.
+         *  @param in_n_wait_semaphores          Number of semaphores to wait on before the bind operation starts.
+         *  @param in_opt_wait_semaphore_ptrs    Semaphores to wait on. Must not be null if @param in_n_wait_semaphores
+         *                                       is not 0.
+         *  @param out_opt_bound_pages_ptr       If not null, deref will be set to the list of pages which have been bound
+         *                                       by this call. Their contents is undefined until uploaded by the app.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool commit(Anvil::Queue*             in_queue_ptr,
+                    uint32_t                  in_n_signal_semaphores       = 0,
+                    Anvil::Semaphore* const*  in_opt_signal_semaphore_ptrs = nullptr,
+                    uint32_t                  in_n_wait_semaphores         = 0,
+                    Anvil::Semaphore* const*  in_opt_wait_semaphore_ptrs   = nullptr,
+                    std::vector<PageID>*      out_opt_bound_pages_ptr      = nullptr);
+
+        /** Returns the image managed by the instance. */
+        Anvil::Image* get_image() const
+        {
+            return m_image_ptr;
+        }
+
+        /** Returns the maximum number of pages which can be resident at the same time. */
+        uint32_t get_n_max_resident_pages() const
+        {
+            return m_n_max_resident_pages;
+        }
+
+        /** Returns the number of memory blocks allocated by the manager so far, excluding the mip tail block. */
+        uint32_t get_n_memory_blocks() const;
+
+        /** Returns the number of requests which are going to be processed by the next commit() call. */
+        uint32_t get_n_pending_requests() const;
+
+        /** Returns the number of pages which are currently resident, excluding the mip tail. */
+        uint32_t get_n_resident_pages() const;
+
+        /** Returns the extent of a single page, expressed in texels. */
+        const VkExtent3D& get_page_extent() const
+        {
+            return m_page_extent;
+        }
+
+        /** Returns the number of bytes of memory backing a single page. */
+        VkDeviceSize get_page_size() const
+        {
+            return m_page_size;
+        }
+
+        /** Tells whether the specified page has memory bound to it. */
+        bool is_page_resident(const PageID& in_page) const;
+
+        /** Marks the specified page as used in the current frame. If the page is not resident, it is going to be
+         *  bound by the next commit() call.
+         *
+         *  Requesting the same page more than once per frame has no additional effect.
+         */
+        void request_page(const PageID& in_page);
+
+        /** Calls request_page() for each page in the specified array.
+         *
+         *  @param in_n_pages    Number of pages to request.
+         *  @param in_pages_ptr  Array of @param in_n_pages pages. Must not be null if @param in_n_pages is not 0.
+         */
+        void request_pages(uint32_t      in_n_pages,
+                           const PageID* in_pages_ptr);
+
+    private:
+        /* Private type definitions */
+        typedef struct Slot
+        {
+            uint64_t last_used_frame;
+            uint32_t n_next_slot;  /* towards less recently used slots */
+            uint32_t n_prev_slot;  /* towards more recently used slots */
+            PageID   page;
+            uint32_t page_index;   /* UINT32_MAX if the slot is free */
+
+            Slot()
+                :last_used_frame(0),
+                 n_next_slot    (UINT32_MAX),
+                 n_prev_slot    (UINT32_MAX),
+                 page_index     (UINT32_MAX)
+            {
+                /* Stub */
+            }
+        } Slot;
+
+        /* Private functions */
+        SparseResidencyManager(Anvil::Image*                             in_image_ptr,
+                               Anvil::ImageAspectFlagBits                in_aspect,
+                               const Anvil::SparseImageAspectProperties& in_aspect_props,
+                               uint32_t                                  in_n_max_resident_pages,
+                               uint32_t                                  in_n_pages_per_memory_block,
+                               bool                                      in_mt_safe);
+
+        bool acquire_slot       (uint32_t*                             out_n_slot_ptr);
+        void append_page_update (Anvil::SparseMemoryBindingUpdateInfo* in_update_ptr,
+                                 Anvil::SparseMemoryBindInfoID         in_bind_info_id,
+                                 const PageID&                         in_page,
+                                 Anvil::MemoryBlock*                   in_opt_memory_block_ptr,
+                                 VkDeviceSize                          in_memory_block_start_offset);
+        bool bind_mip_tails     (Anvil::SparseMemoryBindingUpdateInfo* in_update_ptr,
+                                 Anvil::SparseMemoryBindInfoID         in_bind_info_id);
+        bool get_page_index     (const PageID&                         in_page,
+                                 uint32_t*                             out_page_index_ptr) const;
+        void init_page_layout   ();
+        void link_slot_as_mru   (uint32_t                              in_n_slot);
+        void request_page_locked(const PageID&                         in_page);
+        void unlink_slot        (uint32_t                              in_n_slot);
+
+        /* Private variables */
+        Anvil::ImageAspectFlagBits                m_aspect;
+        Anvil::SparseImageAspectProperties        m_aspect_props;
+        std::vector<uint32_t>                     m_free_slots;
+        Anvil::Image*                             m_image_ptr;
+        bool                                      m_is_mip_tail_bound;
+        uint32_t                                  m_lru_head_slot;     /* most recently used */
+        uint32_t                                  m_lru_tail_slot;     /* least recently used */
+        std::vector<Anvil::MemoryBlockUniquePtr>  m_memory_blocks;
+        std::vector<uint32_t>                     m_mip_first_page_indices;
+        Anvil::MemoryBlockUniquePtr               m_mip_tail_memory_block_ptr;
+        std::vector<std::array<uint32_t, 3> >     m_mip_n_tiles;
+        uint64_t                                  m_n_current_frame;
+        const uint32_t                            m_n_max_resident_pages;
+        uint32_t                                  m_n_pages_per_layer;
+        const uint32_t                            m_n_pages_per_memory_block;
+        uint32_t                                  m_n_resident_pages;
+        uint32_t                                  m_n_tiled_mipmaps;
+        VkExtent3D                                m_page_extent;
+        std::vector<uint64_t>                     m_page_request_frames;
+        VkDeviceSize                              m_page_size;
+        std::vector<uint32_t>                     m_page_slots;
+        std::vector<PageID>                       m_pending_pages;
+        std::vector<Slot>                         m_slots;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(SparseResidencyManager);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(SparseResidencyManager);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_SPARSE_RESIDENCY_MANAGER_H */
@@ -0,0 +1,171 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a device-wide staging ring.
+ *
+ *  The ring wraps a single, persistently mapped host-visible buffer which is shared by all
+ *  buffers & images which need to transfer data to or from non-mappable memory. Regions are
+ *  sub-allocated linearly. Each region is associated with a fence, which the caller must
+ *  use for the submission that accesses the region. Once the fence becomes signalled and the
+ *  caller has released the region, its storage is recycled.
+ *
+ *  If the ring runs out of space, allocation blocks until the oldest region in flight retires.
+ *
+ *  This object should ONLY be instantiated by Anvil::BaseDevice.
+ *
+ *  Staging ring is thread-safe.
+ */
+#ifndef MISC_STAGING_RING_H
+#define MISC_STAGING_RING_H
+
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+#include <deque>
+
+
+namespace Anvil
+{
+    class StagingRing : public MTSafetySupportProvider
+    {
+    public:
+        /* Public type definitions */
+        typedef struct Allocation
+        {
+            Anvil::Buffer* buffer_ptr;
+            Anvil::Fence*  fence_ptr;
+            VkDeviceSize   offset;
+            VkDeviceSize   size;
+
+            Allocation()
+                :buffer_ptr(nullptr),
+                 fence_ptr (nullptr),
+                 offset    (0),
+                 size      (0)
+            {
+                /* Stub */
+            }
+        } Allocation;
+
+        /* Public functions */
+
+        /** Creates a new staging ring instance.
+         *
+         *  @param in_device_ptr Device to create the ring for. Must not be null.
+         *  @param in_size       Size of the ring's backing buffer. Must not be 0.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::StagingRingUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
+                                                  VkDeviceSize             in_size);
+
+        /** Destructor. Waits for all regions in flight to retire. */
+        ~StagingRing();
+
+        /** Sub-allocates a region of the ring.
+         *
+         *  The returned fence is reset and must be passed to the submission which accesses the region,
+         *  after which the caller must call release(). If the region ends up not being used for a
+         *  submission, release() must still be called with @param in_submitted set to false.
+         *
+         *  @param in_size        Number of bytes to allocate. Must not be 0.
+         *  @param in_alignment   Required alignment of the region's start offset. Must not be 0.
+         *  @param out_result_ptr Deref will be set to the allocation details if the call succeeds.
+         *                        Must not be null.
+         *
+         *  @return true if successful, false if the request cannot be accommodated by the ring. In the
+         *          latter case, callers are expected to fall back to a dedicated staging buffer.
+         */
+        bool allocate(VkDeviceSize in_size,
+                      VkDeviceSize in_alignment,
+                      Allocation*  out_result_ptr);
+
+        /** Returns the buffer backing the ring. */
+        Anvil::Buffer* get_buffer() const
+        {
+            return m_buffer_ptr.get();
+        }
+
+        /** Returns the size of the ring. */
+        const VkDeviceSize& get_size() const
+        {
+            return m_size;
+        }
+
+        /** Releases a region returned by an earlier allocate() call.
+         *
+         *  @param in_allocation         Allocation to release.
+         *  @param in_submitted          True if the allocation's fence has been used for a submission.
+         *  @param in_opt_cmd_buffer_ptr If not null, the command buffer will be kept alive until the region retires.
+         */
+        void release(const Allocation&                    in_allocation,
+                     bool                                 in_submitted,
+                     Anvil::PrimaryCommandBufferUniquePtr in_opt_cmd_buffer_ptr = Anvil::PrimaryCommandBufferUniquePtr() );
+
+    private:
+        /* Private type definitions */
+        typedef struct Region
+        {
+            Anvil::PrimaryCommandBufferUniquePtr cmd_buffer_ptr;
+            VkDeviceSize                         end_offset;
+            Anvil::FenceUniquePtr                fence_ptr;
+            bool                                 is_released;
+            bool                                 is_submitted;
+            VkDeviceSize                         start_offset;
+
+            Region(VkDeviceSize          in_start_offset,
+                   VkDeviceSize          in_end_offset,
+                   Anvil::FenceUniquePtr in_fence_ptr)
+                :end_offset  (in_end_offset),
+                 fence_ptr   (std::move(in_fence_ptr) ),
+                 is_released (false),
+                 is_submitted(false),
+                 start_offset(in_start_offset)
+            {
+                /* Stub */
+            }
+        } Region;
+
+        /* Private functions */
+        StagingRing(const Anvil::BaseDevice* in_device_ptr,
+                    VkDeviceSize             in_size);
+
+        bool                  init              ();
+        Anvil::FenceUniquePtr get_fence         ();
+        void                  retire_regions    ();
+        bool                  try_reserve_region(VkDeviceSize  in_size,
+                                                 VkDeviceSize  in_alignment,
+                                                 VkDeviceSize* out_start_offset_ptr) const;
+
+        /* Private variables */
+        Anvil::BufferUniquePtr             m_buffer_ptr;
+        const Anvil::BaseDevice*           m_device_ptr;
+        std::vector<Anvil::FenceUniquePtr> m_free_fences;
+        VkDeviceSize                       m_head_offset;
+        std::deque<Region>                 m_regions;
+        VkDeviceSize                       m_size;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(StagingRing);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(StagingRing);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_STAGING_RING_H */
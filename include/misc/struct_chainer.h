@@ -23,6 +23,7 @@
 #ifndef MISC_STRUCT_CHAINER_H
 #define MISC_STRUCT_CHAINER_H
 
+#include "misc/command_arena.h"
 #include "types.h"
 
 namespace Anvil
@@ -220,10 +221,6 @@ namespace Anvil
 
         std::unique_ptr<StructChain<StructType> > create_chain() const
         {
-            size_t                                    helper_data_start_offset = 0;
-            size_t                                    n_bytes_used             = 0;
-            const uint32_t                            n_helper_structs         = static_cast<uint32_t>(m_helper_structs.size() );
-            const uint32_t                            n_structs                = static_cast<uint32_t>(m_structs.size       () );
             std::unique_ptr<StructChain<StructType> > result_ptr;
 
             /* Sanity checks */
@@ -246,6 +243,126 @@ namespace Anvil
                 goto end;
             }
 
+            link_chain(&result_ptr->raw_data.at(0) );
+
+            result_ptr->root_struct_ptr = reinterpret_cast<StructType*>(&result_ptr->raw_data.at(0) );
+
+            /* Done. */
+        end:
+            return result_ptr;
+        }
+
+        /** Works like create_chain(), except that the chain is formed in memory allocated from @param in_arena_ptr,
+         *  instead of a new StructChain instance. The chain stays valid until the arena is rewound or released.
+         *
+         *  @return Root struct of the chain, or nullptr if no struct has been appended.
+         */
+        StructType* create_chain(Anvil::CommandArena* in_arena_ptr) const
+        {
+            uint8_t*    raw_data_ptr = nullptr;
+            StructType* result_ptr   = nullptr;
+
+            if (m_structs.size() == 0)
+            {
+                anvil_assert(m_structs.size() > 0);
+
+                goto end;
+            }
+
+            raw_data_ptr = static_cast<uint8_t*>(in_arena_ptr->allocate(m_structs_size + m_helper_structs_size,
+                                                                        alignof(uint64_t) ));
+
+            link_chain(raw_data_ptr);
+
+            result_ptr = reinterpret_cast<StructType*>(raw_data_ptr);
+
+        end:
+            return result_ptr;
+        }
+
+        StructType* get_last_struct()
+        {
+            anvil_assert(m_structs.size() > 0);
+
+            return reinterpret_cast<StructType*>(&m_structs.at(m_structs.size() - 1).at(0) );
+        }
+
+        const StructType* get_last_struct() const
+        {
+            anvil_assert(m_structs.size() > 0);
+
+            return reinterpret_cast<const StructType*>(&m_structs.at(m_structs.size() - 1).at(0) );
+        }
+
+        uint32_t get_n_structs() const
+        {
+            return static_cast<uint32_t>(m_structs.size() );
+        }
+
+        StructType* get_root_struct()
+        {
+            anvil_assert(m_structs.size() > 0);
+
+            return reinterpret_cast<StructType*>(&m_structs.at(0).at(0) );
+        }
+
+        const StructType* get_root_struct() const
+        {
+            anvil_assert(m_structs.size() > 0);
+
+            return reinterpret_cast<const StructType*>(&m_structs.at(0).at(0) );
+        }
+
+        VkStructHeader* get_struct_at_index(const uint32_t& in_index)
+        {
+            VkStructHeader* result_ptr = nullptr;
+
+            if (m_structs.size() > in_index)
+            {
+                result_ptr = reinterpret_cast<VkStructHeader*>(&m_structs.at(in_index).at(0) );
+            }
+
+            return result_ptr;
+        }
+    private:
+        /* Private type definitions */
+        typedef struct HelperStruct
+        {
+            std::vector<uint8_t> data;
+            StructID             referring_struct_id;
+            uint32_t             referring_struct_ptr_offset;
+
+            HelperStruct(const void*     in_data_ptr,
+                         const uint32_t& in_data_size,
+                         const StructID& in_referring_struct_id,
+                         const uint32_t& in_referring_struct_ptr_offset)
+                :referring_struct_id        (in_referring_struct_id),
+                 referring_struct_ptr_offset(in_referring_struct_ptr_offset)
+            {
+                anvil_assert(in_data_ptr  != nullptr);
+                anvil_assert(in_data_size != 0);
+
+                data.resize(in_data_size);
+
+                memcpy(&data.at(0),
+                       in_data_ptr,
+                       in_data_size);
+            }
+        } HelperStruct;
+
+        /* Private functions */
+
+        /** Copies all appended structs, followed by all helper structures, to @param out_raw_data_ptr and patches
+         *  pNext & helper structure pointers so that they refer to the copies. @param out_raw_data_ptr must be
+         *  able to hold (m_structs_size + m_helper_structs_size) bytes.
+         */
+        void link_chain(uint8_t* out_raw_data_ptr) const
+        {
+            size_t         helper_data_start_offset = 0;
+            size_t         n_bytes_used             = 0;
+            const uint32_t n_helper_structs         = static_cast<uint32_t>(m_helper_structs.size() );
+            const uint32_t n_structs                = static_cast<uint32_t>(m_structs.size       () );
+
             /* Form the struct chain.. */
             for (uint32_t n_struct = 0;
                           n_struct < n_structs;
@@ -255,16 +372,16 @@ namespace Anvil
                 const auto& current_struct_data      = m_structs.at(n_struct);
                 const auto  current_struct_data_size = current_struct_data.size();
 
-                memcpy(&result_ptr->raw_data.at(n_bytes_used),
+                memcpy(out_raw_data_ptr + n_bytes_used,
                        &current_struct_data.at(0),
                         current_struct_data_size);
 
                 /* Adjust pNext pointer to point at the next struct, if defined. */
                 if (n_struct != (n_structs - 1) )
                 {
-                    VkStructHeader* header_ptr = reinterpret_cast<VkStructHeader*>(&result_ptr->raw_data.at(n_bytes_used) );
+                    VkStructHeader* header_ptr = reinterpret_cast<VkStructHeader*>(out_raw_data_ptr + n_bytes_used);
 
-                    header_ptr->next_ptr = &result_ptr->raw_data.at(0) + n_bytes_used + current_struct_data_size;
+                    header_ptr->next_ptr = out_raw_data_ptr + n_bytes_used + current_struct_data_size;
                 }
 
                 n_bytes_used += current_struct_data_size;
@@ -281,7 +398,7 @@ namespace Anvil
                 const auto  current_helper_struct_data_size = current_helper_struct_data.size();
 
                 /* Cache helper structure data */
-                memcpy(&result_ptr->raw_data.at(n_bytes_used),
+                memcpy(out_raw_data_ptr + n_bytes_used,
                        &current_helper_struct_data.at(0),
                         current_helper_struct_data_size);
 
@@ -306,92 +423,134 @@ namespace Anvil
                     patch_offset += helper_data_start_offset;
                 }
 
-                *reinterpret_cast<void**>(&result_ptr->raw_data.at(patch_offset) )  = &result_ptr->raw_data.at(n_bytes_used);
-                n_bytes_used                                                       += current_helper_struct_data_size;
+                *reinterpret_cast<void**>(out_raw_data_ptr + patch_offset)  = out_raw_data_ptr + n_bytes_used;
+                n_bytes_used                                               += current_helper_struct_data_size;
             }
+        }
 
-            result_ptr->root_struct_ptr = reinterpret_cast<StructType*>(&result_ptr->raw_data.at(0) );
+        /* Private variables */
+        std::vector<HelperStruct>          m_helper_structs;
+        uint32_t                           m_helper_structs_size;
+        std::vector<std::vector<uint8_t> > m_structs;
+        uint32_t                           m_structs_size;
+    };
 
-            /* Done. */
-        end:
-            return result_ptr;
+    /* Fixed-capacity counterpart of StructChainer, meant for hot paths (command buffer recording, presentation, etc.).
+     *
+     * Structs are copied into inline storage of @param MaxChainSize bytes and linked as they are appended, so the chain
+     * can be passed to Vulkan straight away, without a create_chain() call or any heap allocations. Helper structures
+     * are not supported.
+     *
+     * Since pNext pointers refer to the instance's own storage, instances can be neither copied nor moved.
+     */
+    template<typename StructType, uint32_t MaxChainSize>
+    class InlineStructChainer
+    {
+    public:
+        /* Public functions */
+        InlineStructChainer()
+            :m_last_struct_offset(0),
+             m_n_structs         (0),
+             m_structs_size      (0)
+        {
+            /* Stub */
         }
 
-        StructType* get_last_struct()
+        template<typename ChainedStructType>
+        StructID append_struct(const ChainedStructType& in_struct)
         {
-            anvil_assert(m_structs.size() > 0);
+            /* All Vulkan structs start with a pointer-aligned header, so keep each struct 8-byte aligned */
+            const uint32_t struct_offset = (m_structs_size + 7) & ~7u;
 
-            return reinterpret_cast<StructType*>(&m_structs.at(m_structs.size() - 1).at(0) );
+            anvil_assert(in_struct.pNext == nullptr);
+
+            /* Zeroth item appended to the chain must be of StructType type! */
+            if (m_n_structs       == 0                  &&
+                sizeof(in_struct) != sizeof(StructType) )
+            {
+                anvil_assert_fail();
+            }
+
+            if (struct_offset + sizeof(in_struct) > MaxChainSize)
+            {
+                anvil_assert(struct_offset + sizeof(in_struct) <= MaxChainSize);
+
+                return StructID();
+            }
+
+            memcpy(get_raw_data() + struct_offset,
+                   &in_struct,
+                   sizeof(in_struct) );
+
+            if (m_n_structs > 0)
+            {
+                reinterpret_cast<VkStructHeader*>(get_raw_data() + m_last_struct_offset)->next_ptr = get_raw_data() + struct_offset;
+            }
+
+            m_last_struct_offset  = struct_offset;
+            m_structs_size        = struct_offset + static_cast<uint32_t>(sizeof(in_struct) );
+            m_n_structs          ++;
+
+            return StructID(struct_offset,
+                            false /* in_is_helper_struct */);
         }
 
-        const StructType* get_last_struct() const
+        StructType* get_last_struct()
         {
-            anvil_assert(m_structs.size() > 0);
+            anvil_assert(m_n_structs > 0);
 
-            return reinterpret_cast<const StructType*>(&m_structs.at(m_structs.size() - 1).at(0) );
+            return reinterpret_cast<StructType*>(get_raw_data() + m_last_struct_offset);
         }
 
         uint32_t get_n_structs() const
         {
-            return static_cast<uint32_t>(m_structs.size() );
+            return m_n_structs;
         }
 
         StructType* get_root_struct()
         {
-            anvil_assert(m_structs.size() > 0);
+            anvil_assert(m_n_structs > 0);
 
-            return reinterpret_cast<StructType*>(&m_structs.at(0).at(0) );
+            return reinterpret_cast<StructType*>(get_raw_data() );
         }
 
         const StructType* get_root_struct() const
         {
-            anvil_assert(m_structs.size() > 0);
+            anvil_assert(m_n_structs > 0);
 
-            return reinterpret_cast<const StructType*>(&m_structs.at(0).at(0) );
+            return reinterpret_cast<const StructType*>(get_raw_data() );
         }
 
-        VkStructHeader* get_struct_at_index(const uint32_t& in_index)
+        template<typename StructType2>
+        StructType2* get_struct_with_id(const StructID& in_id)
         {
-            VkStructHeader* result_ptr = nullptr;
-
-            if (m_structs.size() > in_index)
-            {
-                result_ptr = reinterpret_cast<VkStructHeader*>(&m_structs.at(in_index).at(0) );
-            }
+            anvil_assert( in_id.is_valid      () );
+            anvil_assert(!in_id.is_helper_struct);
+            anvil_assert( in_id.data_offset      < m_structs_size);
 
-            return result_ptr;
+            return reinterpret_cast<StructType2*>(get_raw_data() + in_id.data_offset);
         }
+
     private:
-        /* Private type definitions */
-        typedef struct HelperStruct
+        /* Private functions */
+        uint8_t* get_raw_data()
         {
-            std::vector<uint8_t> data;
-            StructID             referring_struct_id;
-            uint32_t             referring_struct_ptr_offset;
-
-            HelperStruct(const void*     in_data_ptr,
-                         const uint32_t& in_data_size,
-                         const StructID& in_referring_struct_id,
-                         const uint32_t& in_referring_struct_ptr_offset)
-                :referring_struct_id        (in_referring_struct_id),
-                 referring_struct_ptr_offset(in_referring_struct_ptr_offset)
-            {
-                anvil_assert(in_data_ptr  != nullptr);
-                anvil_assert(in_data_size != 0);
+            return reinterpret_cast<uint8_t*>(m_raw_data);
+        }
 
-                data.resize(in_data_size);
+        const uint8_t* get_raw_data() const
+        {
+            return reinterpret_cast<const uint8_t*>(m_raw_data);
+        }
 
-                memcpy(&data.at(0),
-                       in_data_ptr,
-                       in_data_size);
-            }
-        } HelperStruct;
+        /* Private variables */
+        uint32_t m_last_struct_offset;
+        uint32_t m_n_structs;
+        uint64_t m_raw_data[(MaxChainSize + 7) / 8];
+        uint32_t m_structs_size;
 
-        /* Private functions */
-        std::vector<HelperStruct>          m_helper_structs;
-        uint32_t                           m_helper_structs_size;
-        std::vector<std::vector<uint8_t> > m_structs;
-        uint32_t                           m_structs_size;
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(InlineStructChainer);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(InlineStructChainer);
     };
 };
 
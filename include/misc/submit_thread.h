@@ -0,0 +1,219 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a deferred submission queue, backed by a dedicated thread.
+ *
+ *  Submissions & presentation requests are copied into a bounded, lock-free ring at enqueue time, and
+ *  then picked up by a submit thread which issues them against the wrapped queue in enqueue order.
+ *  Consecutive submissions are coalesced into a single vkQueueSubmit() call. As a result, threads which
+ *  enqueue work never wait on the queue's mutex, and vkQueueSubmit() / vkQueuePresentKHR() latency is
+ *  moved off their critical path.
+ *
+ *  Each enqueued operation is identified by a ticket. Tickets are monotonically increasing 64-bit values,
+ *  starting from 1. Callers can wait until the submit thread has issued all operations up to a given ticket.
+ *
+ *  Enqueued submissions must not request blocking, since the caller cannot wait on the submit thread from
+ *  within the enqueue call. Use fences or wait() instead. Objects referred to by an enqueued operation must
+ *  stay alive until the submit thread has issued it.
+ *
+ *  If the ring is full, enqueue calls block until the submit thread frees up a slot.
+ *
+ *  Submit thread is thread-safe.
+ */
+#ifndef MISC_SUBMIT_THREAD_H
+#define MISC_SUBMIT_THREAD_H
+
+#include "misc/types.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+
+namespace Anvil
+{
+    class SubmitThread
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new submit thread instance and spawns the thread.
+         *
+         *  @param in_queue_ptr    Queue to issue operations against. Must not be null.
+         *  @param in_n_ring_slots Maximum number of operations which can be pending at any time. Must be a power
+         *                         of two.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::SubmitThreadUniquePtr create(Anvil::Queue* in_queue_ptr,
+                                                   uint32_t      in_n_ring_slots = 256);
+
+        /** Destructor. Issues all pending operations and joins the submit thread. */
+        ~SubmitThread();
+
+        /** Returns the number of operations the submit thread has failed to issue so far. */
+        uint32_t get_n_failed_operations() const
+        {
+            return m_n_failed_operations.load();
+        }
+
+        /** Returns the result of the most recent present operation the submit thread has issued. */
+        Anvil::SwapchainOperationErrorCode get_last_present_result() const
+        {
+            return m_last_present_result.load();
+        }
+
+        /** Returns the queue the submit thread issues operations against. */
+        Anvil::Queue* get_queue() const
+        {
+            return m_queue_ptr;
+        }
+
+        /** Enqueues a presentation request.
+         *
+         *  @param in_swapchain_ptr           Swapchain to present. Must not be null.
+         *  @param in_swapchain_image_index   Index of the swapchain image to present.
+         *  @param in_n_wait_semaphores       Number of semaphores to wait on before presenting.
+         *  @param in_wait_semaphore_ptrs_ptr Semaphores to wait on. Must not be null if @param in_n_wait_semaphores
+         *                                    is not 0. Copied before the function returns.
+         *
+         *  @return Ticket associated with the operation.
+         */
+        uint64_t present(Anvil::Swapchain*        in_swapchain_ptr,
+                         uint32_t                 in_swapchain_image_index,
+                         uint32_t                 in_n_wait_semaphores,
+                         Anvil::Semaphore* const* in_wait_semaphore_ptrs_ptr);
+
+        /** Enqueues a submission.
+         *
+         *  All arrays referred to by @param in_submit_info are copied before the function returns.
+         *
+         *  NOTE: Win32 keyed mutex and D3D12 fence info is not supported.
+         *
+         *  @param in_submit_info Submission to enqueue. Must not request blocking.
+         *
+         *  @return Ticket associated with the operation.
+         */
+        uint64_t submit(const Anvil::SubmitInfo& in_submit_info);
+
+        /** Blocks until the submit thread has issued all operations up to and including @param in_ticket.
+         *
+         *  NOTE: This does NOT wait for the GPU to finish executing the operations.
+         */
+        void wait(uint64_t in_ticket);
+
+        /** Blocks until the submit thread has issued all operations enqueued prior to this call. */
+        void wait_idle();
+
+    private:
+        /* Private type definitions */
+        enum class OperationType
+        {
+            PRESENT,
+            SUBMIT,
+
+            UNKNOWN
+        };
+
+        typedef struct Slot
+        {
+            /* Pos of the enqueue op which may write to the slot next. Set to pos + 1 once the op has been
+             * published, and to pos + n_ring_slots once the consumer is done with it. */
+            std::atomic<uint64_t> sequence;
+
+            OperationType type;
+
+            /* Submission data */
+            std::vector<Anvil::CommandBufferMGPUSubmission> cmd_buffers_mgpu;
+            std::vector<Anvil::CommandBufferBase*>          cmd_buffers_sgpu;
+            std::vector<Anvil::PipelineStageFlags>          dst_stage_wait_masks;
+            Anvil::Fence*                                   fence_ptr;
+            bool                                            has_timeline_semaphore_values;
+            bool                                            is_protected;
+            std::vector<Anvil::SemaphoreMGPUSubmission>     signal_semaphores_mgpu;
+            std::vector<Anvil::Semaphore*>                  signal_semaphores_sgpu;
+            Anvil::SubmissionType                           submission_type;
+            std::vector<uint64_t>                           timeline_signal_semaphore_values;
+            std::vector<uint64_t>                           timeline_wait_semaphore_values;
+            std::vector<Anvil::SemaphoreMGPUSubmission>     wait_semaphores_mgpu;
+
+            /* Data shared by submissions & presentation requests */
+            std::vector<Anvil::Semaphore*>                  wait_semaphores_sgpu;
+
+            /* Presentation request data */
+            Anvil::Swapchain*                               swapchain_ptr;
+            uint32_t                                        swapchain_image_index;
+
+            Slot()
+                :sequence                     (0),
+                 type                         (OperationType::UNKNOWN),
+                 fence_ptr                    (nullptr),
+                 has_timeline_semaphore_values(false),
+                 is_protected                 (false),
+                 submission_type              (Anvil::SubmissionType::SGPU),
+                 swapchain_ptr                (nullptr),
+                 swapchain_image_index        (UINT32_MAX)
+            {
+                /* Stub */
+            }
+        } Slot;
+
+        /* Private functions */
+        SubmitThread(Anvil::Queue* in_queue_ptr,
+                     uint32_t      in_n_ring_slots);
+
+        Slot* acquire_slot     (uint64_t*    out_ticket_ptr);
+        void  issue_present    (const Slot&  in_slot);
+        void  issue_submissions(uint32_t     in_n_slots,
+                                Slot* const* in_slot_ptrs);
+        void  publish_slot     (Slot*        in_slot_ptr,
+                                uint64_t     in_ticket);
+        void  thread_main      ();
+
+        /* Private variables */
+        std::vector<Anvil::SubmitInfo>                  m_batch_submit_infos;
+        std::vector<const Anvil::SubmitInfo*>           m_batch_submit_info_ptrs;
+        std::vector<Slot*>                              m_batch_slot_ptrs;
+
+        uint64_t                                        m_dequeue_pos;          /* Only accessed by the submit thread */
+        std::atomic<uint64_t>                           m_enqueue_pos;
+        std::atomic<bool>                               m_is_thread_sleeping;
+        std::atomic<Anvil::SwapchainOperationErrorCode> m_last_present_result;
+        std::atomic<uint32_t>                           m_n_failed_operations;
+        std::atomic<uint64_t>                           m_n_issued_tickets;
+        Anvil::Queue*                                   m_queue_ptr;
+        std::vector<Slot>                               m_ring;
+        const uint64_t                                  m_ring_mask;
+        std::atomic<bool>                               m_should_quit;
+        std::thread                                     m_thread;
+
+        std::condition_variable                         m_issued_cv;
+        std::mutex                                      m_issued_mutex;
+        std::condition_variable                         m_wake_cv;
+        std::mutex                                      m_wake_mutex;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(SubmitThread);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(SubmitThread);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_SUBMIT_THREAD_H */
@@ -52,6 +52,30 @@ namespace Anvil
                                                    const bool&              in_clipped               = true,
                                                    const Anvil::Swapchain*  in_opt_old_swapchain_ptr = nullptr);
 
+        /** Creates a swapchain create info structure whose present mode, image count and number of frames in flight
+         *  are picked according to @param in_present_policy, based on the present modes & surface capabilities
+         *  reported for all physical devices @param in_device_ptr encapsulates.
+         *
+         *  The present mode always falls back to FIFO, which is guaranteed to be supported. The image count is clamped
+         *  to the range permitted by the surface.
+         *
+         *  Whether the picked configuration meets the app's latency goals can be verified at run-time with
+         *  Anvil::FrameTimingRecorder.
+         *
+         *  Remaining arguments & defaults are as for create().
+         *
+         *  @return New create info instance if successful, null if surface properties could not be retrieved.
+         */
+        static SwapchainCreateInfoUniquePtr create_for_present_policy(Anvil::BaseDevice*            in_device_ptr,
+                                                                      Anvil::RenderingSurface*      in_parent_surface_ptr,
+                                                                      Anvil::Window*                in_window_ptr,
+                                                                      Anvil::Format                 in_format,
+                                                                      Anvil::ColorSpaceKHR          in_color_space,
+                                                                      Anvil::ImageUsageFlags        in_usage_flags,
+                                                                      Anvil::SwapchainPresentPolicy in_present_policy,
+                                                                      const bool&                   in_clipped               = true,
+                                                                      const Anvil::Swapchain*       in_opt_old_swapchain_ptr = nullptr);
+
         const bool& get_clipped() const
         {
             return m_clipped;
@@ -105,6 +129,15 @@ namespace Anvil
             return m_n_images;
         }
 
+        /** Returns the maximum number of frames apps should keep in flight at any time.
+         *
+         *  Set by create_for_present_policy(). Otherwise defaults to the number of images minus one (but at least one).
+         */
+        uint32_t get_n_frames_in_flight() const
+        {
+            return m_n_frames_in_flight;
+        }
+
         const Anvil::Swapchain* get_old_swapchain() const
         {
             return m_old_swapchain_ptr;
@@ -115,6 +148,13 @@ namespace Anvil
             return m_present_mode;
         }
 
+        /** Returns the policy the present mode & image count have been picked with, or SwapchainPresentPolicy::UNKNOWN
+         *  if the create info has not been created with create_for_present_policy(). */
+        Anvil::SwapchainPresentPolicy get_present_policy() const
+        {
+            return m_present_policy;
+        }
+
         /** Retrieves parent rendering surface. */
         const Anvil::RenderingSurface* get_rendering_surface() const
         {
@@ -133,6 +173,23 @@ namespace Anvil
             return m_window_ptr;
         }
 
+        /** Adds ImageUsageFlagBits::STORAGE_BIT to the usage flags, so that compute shaders can write to swapchain
+         *  images directly, instead of blitting their results into the images.
+         *
+         *  The flag is only added if the surface lists storage usage in SurfaceCapabilities::supported_usage_flags (as
+         *  reported by BaseDevice::get_physical_device_surface_capabilities() ), and if the swapchain format supports
+         *  storage images with optimal tiling. The latter rarely holds for sRGB formats, so apps which would like to use
+         *  storage usage should pick a UNORM format and apply the transfer function in the shader.
+         *
+         *  Off-screen swapchains only need the format to support storage images.
+         *
+         *  Must be called after the format, the rendering surface and the window have been set.
+         *
+         *  @return true if storage usage has been requested, false if it is not supported, in which case the usage
+         *          flags are left unchanged.
+         */
+        bool request_storage_usage();
+
         void set_clipped(const bool& in_clipped)
         {
             m_clipped = in_clipped;
@@ -177,6 +234,13 @@ namespace Anvil
             m_n_images = in_n_images;
         }
 
+        void set_n_frames_in_flight(const uint32_t& in_n_frames_in_flight)
+        {
+            anvil_assert(in_n_frames_in_flight > 0);
+
+            m_n_frames_in_flight = in_n_frames_in_flight;
+        }
+
         void set_old_swapchain(const Anvil::Swapchain* in_old_swapchain_ptr)
         {
             m_old_swapchain_ptr = in_old_swapchain_ptr;
@@ -243,10 +307,12 @@ namespace Anvil
         Anvil::Format                      m_format;
         Anvil::DeviceGroupPresentModeFlags m_mgpu_present_mode_flags;
         Anvil::MTSafety                    m_mt_safety;
+        uint32_t                           m_n_frames_in_flight;
         uint32_t                           m_n_images;
         const Anvil::Swapchain*            m_old_swapchain_ptr;
         Anvil::RenderingSurface*           m_parent_surface_ptr;
         Anvil::PresentModeKHR              m_present_mode;
+        Anvil::SwapchainPresentPolicy      m_present_policy;
         Anvil::Window*                     m_window_ptr;
 
         Anvil::ImageUsageFlags m_usage_flags;
@@ -0,0 +1,227 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Defines the task scheduler interface used by all Anvil features which fan work out to multiple CPU threads,
+ *  eg. parallel pipeline baking, texture conversion or batch GLSL->SPIR-V compilation.
+ *
+ *  Applications which already run a job system should implement TaskScheduler on top of it and pass the instance
+ *  to DeviceCreateInfo::set_task_scheduler(). Anvil will then never spawn short-lived worker threads of its own for
+ *  these features, and will not oversubscribe the cores the engine's workers are running on.
+ *
+ *  If no scheduler is specified, the device lazily instantiates a WorkStealingTaskScheduler, sized to the number
+ *  of hardware threads, the first time one is needed.
+ *
+ *  Threads waiting for a wait group to drain help out by executing pending tasks, so it is safe to submit and wait
+ *  for nested tasks from within a task.
+ */
+#ifndef MISC_TASK_SCHEDULER_H
+#define MISC_TASK_SCHEDULER_H
+
+#include "misc/types.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+
+namespace Anvil
+{
+    /** Counts outstanding tasks. A wait group is done once each add() has been matched by a done() call. */
+    class TaskWaitGroup
+    {
+    public:
+        /* Public functions */
+        TaskWaitGroup();
+
+        ~TaskWaitGroup()
+        {
+            /* Stub */
+        }
+
+        /** Increments the number of outstanding tasks by @param in_n_tasks. */
+        void add(const uint32_t& in_n_tasks = 1);
+
+        /** Marks a single outstanding task as finished. */
+        void done();
+
+        /** Tells whether all outstanding tasks have finished.
+         *
+         *  Synchronizes with done() via the wait group mutex, so once this function returns true, no done() call
+         *  is still accessing the wait group and the caller may release it.
+         */
+        bool is_done() const;
+
+        /** Blocks until all outstanding tasks finish. Does not execute any tasks. Use TaskScheduler::wait()
+         *  to help out while waiting.
+         */
+        void wait();
+
+        /** Blocks until all outstanding tasks finish, or until @param in_timeout_ns nanoseconds pass.
+         *
+         *  @return true if all outstanding tasks have finished, false otherwise.
+         */
+        bool wait_for(const uint64_t& in_timeout_ns);
+
+    private:
+        /* Private variables */
+        std::condition_variable m_done_cv;
+        mutable std::mutex      m_mutex;
+        std::atomic<uint32_t>   m_n_pending_tasks;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(TaskWaitGroup);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(TaskWaitGroup);
+    };
+
+    class TaskScheduler
+    {
+    public:
+        /* Public type definitions */
+        typedef std::function<void()> Task;
+
+        /** Range task prototype. Called with the index of the first item to process and the number of items. */
+        typedef std::function<void(uint32_t in_n_first_item, uint32_t in_n_items)> RangeTask;
+
+        /* Public functions */
+        virtual ~TaskScheduler()
+        {
+            /* Stub */
+        }
+
+        /** Returns the number of threads tasks may run on concurrently. Used to decide how finely to split work. */
+        virtual uint32_t get_n_workers() const = 0;
+
+        /** Splits the [0, in_n_items) range into chunks of at least @param in_min_items_per_task items and
+         *  executes @param in_task for each chunk. The calling thread takes part in processing and the function
+         *  returns after all chunks have been processed.
+         *
+         *  @param in_n_items            Number of items to process.
+         *  @param in_min_items_per_task Minimum number of items to hand to a single task. 0 is treated as 1.
+         *  @param in_task               Function to call for each chunk. Must be safe to call concurrently.
+         */
+        void parallel_for(const uint32_t&  in_n_items,
+                          const uint32_t&  in_min_items_per_task,
+                          const RangeTask& in_task);
+
+        /** Queues @param in_task for execution on one of the scheduler's threads.
+         *
+         *  If @param in_opt_wait_group_ptr is not null, add() is called on it before this function returns, and
+         *  done() is called after the task finishes executing.
+         */
+        virtual void submit(const Task&    in_task,
+                            TaskWaitGroup* in_opt_wait_group_ptr = nullptr) = 0;
+
+        /** Executes one pending task on the calling thread, if there is any.
+         *
+         *  Implementations which cannot hand tasks out to foreign threads may always return false.
+         *
+         *  @return true if a task was executed, false otherwise.
+         */
+        virtual bool try_run_pending_task() = 0;
+
+        /** Blocks until @param in_wait_group_ptr is done, executing pending tasks in the meantime. */
+        void wait(TaskWaitGroup* in_wait_group_ptr);
+    };
+
+    /** Default task scheduler implementation.
+     *
+     *  Each worker thread owns a task deque. Workers pop tasks off the back of their own deque and, once it runs
+     *  dry, steal from the front of the other workers' deques. Tasks submitted from a worker thread go to that
+     *  worker's deque. Tasks submitted from other threads are distributed across deques in round-robin fashion.
+     *
+     *  Work-stealing task scheduler is thread-safe.
+     */
+    class WorkStealingTaskScheduler : public TaskScheduler
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new scheduler instance and spawns its worker threads.
+         *
+         *  @param in_n_workers Number of worker threads to spawn. 0 selects the number of hardware threads.
+         */
+        static Anvil::WorkStealingTaskSchedulerUniquePtr create(const uint32_t& in_n_workers = 0);
+
+        /** Stops and joins all worker threads. Tasks which have not started executing by then are dropped. */
+        virtual ~WorkStealingTaskScheduler();
+
+        uint32_t get_n_workers() const override
+        {
+            return static_cast<uint32_t>(m_workers.size() );
+        }
+
+        void submit(const Task&    in_task,
+                    TaskWaitGroup* in_opt_wait_group_ptr = nullptr) override;
+
+        bool try_run_pending_task() override;
+
+    private:
+        /* Private type definitions */
+        typedef struct QueuedTask
+        {
+            Task           task;
+            TaskWaitGroup* wait_group_ptr;
+
+            QueuedTask()
+            {
+                wait_group_ptr = nullptr;
+            }
+
+            QueuedTask(const Task&    in_task,
+                       TaskWaitGroup* in_wait_group_ptr)
+                :task          (in_task),
+                 wait_group_ptr(in_wait_group_ptr)
+            {
+                /* Stub */
+            }
+        } QueuedTask;
+
+        typedef struct Worker
+        {
+            std::mutex             mutex;
+            std::deque<QueuedTask> tasks;
+            std::thread            thread;
+        } Worker;
+
+        /* Private functions */
+        explicit WorkStealingTaskScheduler(const uint32_t& in_n_workers);
+
+        void execute      (QueuedTask&     in_task);
+        bool pop_task     (const uint32_t& in_n_preferred_worker,
+                           QueuedTask*     out_task_ptr);
+        void worker_thread(uint32_t        in_n_worker);
+
+        /* Private variables */
+        std::atomic<uint32_t>                m_n_next_worker;
+        std::atomic<uint32_t>                m_n_queued_tasks;
+        std::atomic<bool>                    m_should_stop;
+        std::condition_variable              m_wake_cv;
+        std::mutex                           m_wake_mutex;
+        std::vector<std::unique_ptr<Worker> > m_workers;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(WorkStealingTaskScheduler);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(WorkStealingTaskScheduler);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_TASK_SCHEDULER_H */
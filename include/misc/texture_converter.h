@@ -0,0 +1,141 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements CPU-side conversion of 2D texel data between formats, including block compression.
+ *
+ *  Conversions are driven by the bit layouts and format types Anvil::Formats reports, so that any uncompressed,
+ *  non-YUV color format whose components are UNORM, SNORM, UINT, SINT, USCALED, SSCALED, SRGB or 16-/32-bit SFLOAT
+ *  can be read from and written to. Components missing from the source format are set to (0, 0, 0, 1).
+ *  SRGB components are linearized when read, and sRGB-encoded when written.
+ *
+ *  The following conversions use dedicated, vectorized code paths:
+ *
+ *  - RGBA8 <-> BGRA8 swizzles, between formats of the same type.
+ *  - 8-bit UNORM <-> SRGB conversions of RGBA8 and BGRA8 formats, with or without a swizzle.
+ *  - 32-bit <-> 16-bit SFLOAT conversions between formats using the same component layout.
+ *
+ *  BC1, BC3 and BC7 formats can be used as destination formats. Blocks are encoded from 8-bit texel data, which
+ *  is sRGB-encoded if the destination format is an SRGB format. The BC7 encoder only uses mode 6, which trades
+ *  some quality on blocks with several distinct colors for encoding speed.
+ *
+ *  Work is split across threads in bands of texel rows (block rows for compressed destination formats). If a task
+ *  scheduler is specified, the bands are processed by tasks submitted to it instead of dedicated threads.
+ *
+ *  The output can be wrapped in a MipmapRawData instance with create_mipmap_raw_data() and passed to
+ *  Image::upload_mipmaps().
+ */
+#ifndef MISC_TEXTURE_CONVERTER_H
+#define MISC_TEXTURE_CONVERTER_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class TextureConverter
+    {
+    public:
+        /* Public functions */
+
+        /** Converts a 2D region of texel data from one format to another.
+         *
+         *  @param in_src_format     Format of the source data. Must be an uncompressed format.
+         *  @param in_src_data_ptr   Source data. Must not be null.
+         *  @param in_src_row_pitch  Number of bytes between the starts of consecutive source rows.
+         *  @param in_dst_format     Format to convert the data to.
+         *  @param in_dst_row_pitch  Number of bytes between the starts of consecutive destination rows. For block formats,
+         *                           the value describes rows of blocks.
+         *  @param in_width          Width of the region, in texels.
+         *  @param in_height         Height of the region, in texels.
+         *  @param in_n_threads      Number of threads to use. 0 uses as many threads as there are logical CPU cores.
+         *                           Ignored if @param in_opt_task_scheduler_ptr is not null.
+         *  @param out_dst_data_ptr  Destination memory. Must not be null, and must hold at least
+         *                           (number of destination rows - 1) * @param in_dst_row_pitch + size of a single row bytes.
+         *  @param in_opt_task_scheduler_ptr If not null, the conversion is split into tasks submitted to this scheduler
+         *                                   (eg. BaseDevice::get_task_scheduler() ).
+         *
+         *  @return true if successful, false if the conversion is not supported.
+         **/
+        static bool convert(Anvil::Format         in_src_format,
+                            const void*           in_src_data_ptr,
+                            uint32_t              in_src_row_pitch,
+                            Anvil::Format         in_dst_format,
+                            uint32_t              in_dst_row_pitch,
+                            uint32_t              in_width,
+                            uint32_t              in_height,
+                            uint32_t              in_n_threads,
+                            void*                 out_dst_data_ptr,
+                            Anvil::TaskScheduler* in_opt_task_scheduler_ptr = nullptr);
+
+        /** Converts a 2D region of texel data to another format, and wraps the tightly packed result in a MipmapRawData
+         *  instance, which can be passed to Image::upload_mipmaps().
+         *
+         *  Please see convert() for more details.
+         *
+         *  @param in_n_mipmap    Index of the mip the data is going to be uploaded to.
+         *  @param out_result_ptr Deref will be set to the new MipmapRawData instance. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        static bool create_mipmap_raw_data(Anvil::Format         in_src_format,
+                                           const void*           in_src_data_ptr,
+                                           uint32_t              in_src_row_pitch,
+                                           Anvil::Format         in_dst_format,
+                                           uint32_t              in_width,
+                                           uint32_t              in_height,
+                                           uint32_t              in_n_mipmap,
+                                           uint32_t              in_n_threads,
+                                           Anvil::MipmapRawData* out_result_ptr,
+                                           Anvil::TaskScheduler* in_opt_task_scheduler_ptr = nullptr);
+
+        /** Returns the number of bytes a tightly packed, 2D region of texel data takes in the specified format.
+         *
+         *  @param in_format             Format to use for the query.
+         *  @param in_width              Width of the region, in texels.
+         *  @param in_height             Height of the region, in texels.
+         *  @param out_opt_row_size_ptr  If not null, deref will be set to the number of bytes a single row (of blocks,
+         *                               for block formats) takes.
+         *  @param out_opt_data_size_ptr If not null, deref will be set to the number of bytes the whole region takes.
+         *
+         *  @return true if successful, false if the format is not supported.
+         **/
+        static bool get_data_size(Anvil::Format in_format,
+                                  uint32_t      in_width,
+                                  uint32_t      in_height,
+                                  uint32_t*     out_opt_row_size_ptr,
+                                  uint32_t*     out_opt_data_size_ptr);
+
+        /** Tells whether convert() supports conversions from @param in_src_format to @param in_dst_format. */
+        static bool is_conversion_supported(Anvil::Format in_src_format,
+                                            Anvil::Format in_dst_format);
+
+    private:
+        /* Private functions */
+        TextureConverter();
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(TextureConverter);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(TextureConverter);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_TEXTURE_CONVERTER_H */
@@ -0,0 +1,189 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Implements a loader for KTX2 and DDS texture container files.
+ *
+ *  The file is memory-mapped for the loader's lifetime, and the MipmapRawData items exposed by the loader point
+ *  directly into the mapping. When passed to Image::upload_mipmaps() (or to an ImageCreateInfo instance created with
+ *  create_image_create_info()), mip data is therefore copied straight from the mapped file into staging memory,
+ *  without any intermediate copies.
+ *
+ *  The loader must outlive any upload which uses its mip data.
+ *
+ *  Supported KTX2 files are those which do not use supercompression. Supported DDS files are BC1-7, as well as
+ *  the most common uncompressed, 8-bit RGBA, BGRA and floating-point RGBA formats, with or without the DX10 header
+ *  extension. Both containers may hold arrays, cube maps, cube map arrays and 3D images.
+ */
+#ifndef MISC_TEXTURE_FILE_H
+#define MISC_TEXTURE_FILE_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class TextureFile
+    {
+    public:
+        /* Public type definitions */
+        enum class FileType
+        {
+            DDS,
+            KTX2,
+
+            UNKNOWN
+        };
+
+        /* Public functions */
+
+        /** Maps the specified file and parses its header. The container type is determined from the file's contents.
+         *
+         *  @param in_filename Name of the file to load.
+         *
+         *  @return New instance if successful, null if the file could not be mapped, or if it is not a valid KTX2 or DDS
+         *          file, or if it uses features not supported by the loader.
+         */
+        static Anvil::TextureFileUniquePtr create(const std::string& in_filename);
+
+        /** Destructor. Releases the file mapping. */
+        ~TextureFile();
+
+        /** Creates an ImageCreateInfo instance which describes an optimally-tiled image matching the file's contents.
+         *  The instance is configured to upload all mips held by the file at memory allocation time.
+         *
+         *  If the file holds more than one, but not all mips, storage for the full mip chain is allocated. Contents of
+         *  the mips missing from the file are undefined.
+         *
+         *  @param in_device_ptr              Device to use. Must not be null.
+         *  @param in_usage                   Image usage. TRANSFER_DST is added automatically.
+         *  @param in_queue_families          Queue families the image is going to be accessed by.
+         *  @param in_sharing_mode            Sharing mode to use.
+         *  @param in_post_alloc_image_layout Layout to transition the image to after the upload.
+         *  @param in_memory_features         Memory features for the memory backing.
+         *
+         *  @return New create info instance.
+         */
+        Anvil::ImageCreateInfoUniquePtr create_image_create_info(const Anvil::BaseDevice*  in_device_ptr,
+                                                                 Anvil::ImageUsageFlags    in_usage,
+                                                                 Anvil::QueueFamilyFlags   in_queue_families,
+                                                                 Anvil::SharingMode        in_sharing_mode,
+                                                                 Anvil::ImageLayout        in_post_alloc_image_layout,
+                                                                 Anvil::MemoryFeatureFlags in_memory_features = Anvil::MemoryFeatureFlagBits::NONE) const;
+
+        /** Returns the depth of the base mip. 1 for non-3D images. */
+        uint32_t get_base_mip_depth() const
+        {
+            return m_base_mip_depth;
+        }
+
+        /** Returns the height of the base mip. 1 for 1D images. */
+        uint32_t get_base_mip_height() const
+        {
+            return m_base_mip_height;
+        }
+
+        /** Returns the width of the base mip. */
+        uint32_t get_base_mip_width() const
+        {
+            return m_base_mip_width;
+        }
+
+        /** Returns type of the container the texture has been loaded from. */
+        FileType get_file_type() const
+        {
+            return m_file_type;
+        }
+
+        /** Returns the format of the texture. */
+        Anvil::Format get_format() const
+        {
+            return m_format;
+        }
+
+        /** Returns the image type of the texture. */
+        Anvil::ImageType get_image_type() const
+        {
+            return m_image_type;
+        }
+
+        /** Returns mip data held by the file. Data pointers stay valid for the loader's lifetime. */
+        const std::vector<Anvil::MipmapRawData>& get_mipmaps() const
+        {
+            return m_mipmaps;
+        }
+
+        /** Returns the number of image layers. For cube maps, each face takes a separate layer. */
+        uint32_t get_n_layers() const
+        {
+            return m_n_layers;
+        }
+
+        /** Returns the number of mips held by the file. */
+        uint32_t get_n_mipmaps() const
+        {
+            return m_n_mipmaps;
+        }
+
+        /** Tells whether the texture is a cube map or a cube map array. */
+        bool is_cube_map() const
+        {
+            return m_is_cube_map;
+        }
+
+    private:
+        /* Private functions */
+        TextureFile(Anvil::MappedFileUniquePtr in_file_ptr);
+
+        bool add_mipmaps      (uint32_t             in_n_mipmap,
+                               uint32_t             in_n_layer,
+                               uint32_t             in_n_layers,
+                               const unsigned char* in_data_ptr,
+                               size_t               in_data_size);
+        void get_mipmap_layout(uint32_t             in_n_mipmap,
+                               uint32_t*            out_row_size_ptr,
+                               uint32_t*            out_slice_size_ptr,
+                               uint32_t*            out_n_slices_ptr) const;
+        bool init_dds         ();
+        bool init_ktx2        ();
+
+        /* Private variables */
+        uint32_t                          m_base_mip_depth;
+        uint32_t                          m_base_mip_height;
+        uint32_t                          m_base_mip_width;
+        const unsigned char*              m_data_ptr;
+        size_t                            m_data_size;
+        Anvil::MappedFileUniquePtr        m_file_ptr;
+        FileType                          m_file_type;
+        Anvil::Format                     m_format;
+        Anvil::ImageType                  m_image_type;
+        bool                              m_is_cube_map;
+        std::vector<Anvil::MipmapRawData> m_mipmaps;
+        uint32_t                          m_n_layers;
+        uint32_t                          m_n_mipmaps;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(TextureFile);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(TextureFile);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_TEXTURE_FILE_H */
@@ -20,7 +20,12 @@
 // THE SOFTWARE.
 //
 
-/*  Implements an utility which returns high-performance, monotonic time data. **/
+/*  Implements an utility which returns high-performance, monotonic time data.
+ *
+ *  Time instances can also move device timestamps onto their timeline, given a TimestampCalibration obtained
+ *  with VK_EXT_calibrated_timestamps. This allows GPU timings (eg. GPUProfiler regions) to be displayed next to
+ *  CPU timings taken with the same Time instance.
+ **/
 #ifndef MISC_TIME_H
 #define MISC_TIME_H
 
@@ -35,6 +40,8 @@
 
 namespace Anvil
 {
+    struct TimestampCalibration;
+
     class Time
     {
     public:
@@ -42,15 +49,48 @@ namespace Anvil
          Time();
         ~Time();
 
+        /** Returns the number of milliseconds which have elapsed since the object was created. */
         uint64_t get_time_in_msec();
 
+        /** Returns the number of nanoseconds which have elapsed since the object was created. */
+        uint64_t get_time_in_nsec();
+
+        /** Converts a device timestamp to the number of nanoseconds which have elapsed between the object's creation
+         *  and the moment the device wrote the timestamp.
+         *
+         *  Calibrations drift apart over time, so they should be refreshed periodically, eg. once per second.
+         *
+         *  @param in_device_time_nsec Device timestamp to convert, expressed in nanoseconds (ie. already multiplied by
+         *                             the timestampPeriod limit, as GPUProfiler reports them).
+         *  @param in_calibration      Calibration to use for the conversion. Its host timestamp must come from
+         *                             get_raw_host_timestamp().
+         *
+         *  @return As per description. Timestamps which precede the object's creation are clamped to 0.
+         */
+        uint64_t convert_device_time_to_nsec(uint64_t                           in_device_time_nsec,
+                                             const Anvil::TimestampCalibration& in_calibration) const;
+
+        /** Converts a value returned by get_raw_host_timestamp() to the number of nanoseconds which have elapsed
+         *  since the object was created. Values which precede the object's creation are clamped to 0.
+         */
+        uint64_t convert_raw_host_timestamp_to_nsec(uint64_t in_raw_host_timestamp) const;
+
+        /** Returns the current value of the clock Time instances are built upon, in the clock's native units:
+         *  QueryPerformanceCounter() ticks under Windows, CLOCK_MONOTONIC nanoseconds otherwise.
+         *
+         *  These are the same values VK_EXT_calibrated_timestamps reports for the
+         *  TimeDomainEXT::QUERY_PERFORMANCE_COUNTER_EXT and TimeDomainEXT::CLOCK_MONOTONIC_EXT time domains,
+         *  respectively.
+         */
+        static uint64_t get_raw_host_timestamp();
+
     private:
         /* Private fields */
         #ifdef _WIN32
             LARGE_INTEGER m_frequency;
             LARGE_INTEGER m_start_time;
         #else
-            uint64_t m_start_time;
+            uint64_t m_start_time; /* in nanoseconds */
         #endif
     };
 }; /* namespace Anvil */
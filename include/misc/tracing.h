@@ -0,0 +1,193 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements low-overhead CPU tracing of Anvil's hot paths.
+ *
+ *  Anvil wraps potentially expensive entry-points (memory allocator & pipeline baking, queue submissions, swapchain image
+ *  acquisition, descriptor set updates, GLSL->SPIR-V conversion) with ANVIL_TRACE_SPAN() scopes. Each span is
+ *  identified by a string literal.
+ *
+ *  Spans are only compiled in if Anvil has been built with ANVIL_ENABLE_TRACING. Otherwise, ANVIL_TRACE_SPAN()
+ *  expands to nothing and tracing has no run-time cost at all.
+ *
+ *  When compiled in, spans can be consumed in two ways:
+ *
+ *  1) By hooks installed with Tracer::set_hooks(). The hooks are called when a span begins and ends, on the thread
+ *     which executes the span. Use them to forward spans to an external profiler, eg. Tracy.
+ *  2) By the built-in recorder, enabled with Tracer::set_recording_enabled(). Completed spans are appended to
+ *     per-thread buffers, so that recording threads do not contend with each other. Recorded spans can be exported
+ *     to a Chrome trace event JSON file (chrome://tracing, Perfetto) with Tracer::export_chrome_json().
+ *
+ *  If neither is active, a span costs two relaxed atomic loads.
+ *
+ *  Spans executed by the device, eg. GPUProfiler regions, can be added to the recording with record_device_span().
+ *  Their timestamps are moved onto the CPU timeline with a TimestampCalibration (VK_EXT_calibrated_timestamps), and
+ *  they are exported on a separate "GPU" track.
+ *
+ *  Tracer is thread-safe.
+ */
+#ifndef MISC_TRACING_H
+#define MISC_TRACING_H
+
+#include "misc/types.h"
+
+
+#if defined(ANVIL_ENABLE_TRACING)
+    #define ANVIL_TRACE_SPAN_CONCAT_INTERNAL(a, b) a##b
+    #define ANVIL_TRACE_SPAN_CONCAT(a, b)          ANVIL_TRACE_SPAN_CONCAT_INTERNAL(a, b)
+
+    /** Traces the enclosing scope. @param name must be a string literal. */
+    #define ANVIL_TRACE_SPAN(name) Anvil::TraceSpan ANVIL_TRACE_SPAN_CONCAT(anvil_trace_span_, __LINE__)(name)
+#else
+    #define ANVIL_TRACE_SPAN(name)
+#endif
+
+
+namespace Anvil
+{
+    class Tracer
+    {
+    public:
+        /* Public type definitions */
+
+        /** Call-backs to invoke whenever a span begins or ends.
+         *
+         *  @param in_name     Name of the span. Points to a string literal, so it can be retained.
+         *  @param in_user_arg User argument, as specified in the Hooks instance.
+         **/
+        typedef struct Hooks
+        {
+            void (*begin_span_func)(const char* in_name,
+                                    void*       in_user_arg);
+            void (*end_span_func)  (const char* in_name,
+                                    void*       in_user_arg);
+            void* user_arg;
+
+            Hooks()
+                :begin_span_func(nullptr),
+                 end_span_func  (nullptr),
+                 user_arg       (nullptr)
+            {
+                /* Stub */
+            }
+        } Hooks;
+
+        /* Public functions */
+
+        /** Called when a span begins. Do not call directly; use ANVIL_TRACE_SPAN() instead.
+         *
+         *  @return Start time of the span in nanoseconds, or UINT64_MAX if the span is not being recorded.
+         */
+        static uint64_t begin_span(const char* in_name);
+
+        /** Discards all spans recorded so far. */
+        static void clear();
+
+        /** Called when a span ends. Do not call directly; use ANVIL_TRACE_SPAN() instead.
+         *
+         *  @param in_name       Name of the span.
+         *  @param in_start_time Value returned by the corresponding begin_span() call.
+         */
+        static void end_span(const char* in_name,
+                             uint64_t    in_start_time);
+
+        /** Writes all spans recorded so far to a file, using Chrome trace event format.
+         *
+         *  Spans which are still in progress are not included.
+         *
+         *  @param in_filename Name of the file to write to. If the file exists, it is overwritten.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        static bool export_chrome_json(const std::string& in_filename);
+
+        /** Returns all spans recorded so far, formatted using Chrome trace event format. */
+        static std::string get_chrome_json();
+
+        /** Tells whether Anvil has been built with ANVIL_ENABLE_TRACING. If not, no spans are ever reported. */
+        static bool is_compiled_in();
+
+        /** Tells whether the built-in recorder is enabled. */
+        static bool is_recording_enabled();
+
+        /** Records a span which has been executed by the device. Does nothing if the built-in recorder is disabled.
+         *
+         *  Unlike ANVIL_TRACE_SPAN(), this function is available even if Anvil has been built without
+         *  ANVIL_ENABLE_TRACING.
+         *
+         *  @param in_name              Name of the span. The string is copied.
+         *  @param in_device_start_time Time at which the device started executing the span, in nanoseconds, in the
+         *                              device's time domain (eg. GPUProfiler::RegionTimings::start_time).
+         *  @param in_device_end_time   Time at which the device finished executing the span. Same units as above.
+         *  @param in_calibration       Calibration to move the timestamps onto the CPU timeline with, as returned
+         *                              by BaseDevice::get_timestamp_calibration().
+         */
+        static void record_device_span(const std::string&                 in_name,
+                                       uint64_t                           in_device_start_time,
+                                       uint64_t                           in_device_end_time,
+                                       const Anvil::TimestampCalibration& in_calibration);
+
+        /** Installs hooks to call whenever a span begins or ends.
+         *
+         *  @param in_opt_hooks_ptr Hooks to install. The instance is NOT copied and must stay alive until the hooks
+         *                          are uninstalled, and all threads which may be executing Anvil code have
+         *                          left it. Pass null to uninstall the hooks.
+         */
+        static void set_hooks(const Hooks* in_opt_hooks_ptr);
+
+        /** Enables or disables the built-in recorder. The recorder is disabled by default. */
+        static void set_recording_enabled(bool in_enabled);
+
+    private:
+        Tracer();
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(Tracer);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(Tracer);
+    };
+
+    /** Reports a span to Tracer for the lifetime of the object. Use through ANVIL_TRACE_SPAN(). */
+    class TraceSpan
+    {
+    public:
+        explicit TraceSpan(const char* in_name)
+            :m_name      (in_name),
+             m_start_time(Anvil::Tracer::begin_span(in_name) )
+        {
+            /* Stub */
+        }
+
+        ~TraceSpan()
+        {
+            Anvil::Tracer::end_span(m_name,
+                                    m_start_time);
+        }
+
+    private:
+        const char* m_name;
+        uint64_t    m_start_time;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(TraceSpan);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(TraceSpan);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_TRACING_H */
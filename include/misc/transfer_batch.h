@@ -0,0 +1,427 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a non-blocking, batched upload helper.
+ *
+ *  Buffer writes & image mip uploads are queued into the batch. Their data is copied into host-side storage
+ *  at enqueue time, so the caller may release its copy right after the enqueue call returns. A flush() call
+ *  moves all queued data into a single staging buffer, records all copy ops into command buffers and submits
+ *  them to the batch's queues (all transfer queues by default).
+ *
+ *  If the batch uses more than one queue, flush() spreads copies across all of them, so that large uploads
+ *  keep several copy engines busy. Buffer writes larger than 4 MB are split into chunks, which are assigned to
+ *  the least loaded queue one by one. Writes to a buffer whose regions overlap, and all uploads to a single
+ *  image, are kept on a single queue to preserve their order. All queues other than the first one signal
+ *  an internal semaphore, which the first queue's submission waits on, so a flush still completes as a whole.
+ *  Copies of a flush only start once all copies of the previous flush have finished executing, since the two
+ *  may write to the same destinations from different queues.
+ *  Since staging buffers of in-flight flushes are not reused, apps can keep queueing data for the next flush
+ *  while the copies of the previous one execute.
+ *
+ *  Each flush is identified by a token. Tokens are monotonically increasing 64-bit values, starting from 1.
+ *  Callers can query or wait for completion of all copies associated with a token, or ask flush() to signal
+ *  semaphores which other submissions can wait on.
+ *
+ *  Small buffer writes (up to 64 KB, with 4-byte aligned offset & size) skip the staging buffer. Their data is
+ *  embedded in the command buffer with vkCmdUpdateBuffer() instead. Such writes to adjacent regions of the
+ *  same buffer, which are queued one after another, are coalesced into a single update command.
+ *
+ *  Staging buffers and fences used by retired flushes are recycled.
+ *
+ *  If GPU decompression is enabled at creation time, data can also be queued in compressed form (as raw LZ4
+ *  blocks, see GPUDecompressor). Compressed bytes travel through the staging buffer as-is and are decompressed by
+ *  a compute dispatch into a device-local scratch buffer, which the copy ops then read from. This cuts the amount
+ *  of data which needs to be written to host-visible memory and moved over the bus. Compute dispatches require
+ *  the batch to use a queue which supports compute operations.
+ *
+ *  Resources updated via the batch must be usable with the queue family of the batch's queue, and must
+ *  have been created with TRANSFER_DST usage.
+ */
+#ifndef MISC_TRANSFER_BATCH_H
+#define MISC_TRANSFER_BATCH_H
+
+#include "misc/gpu_decompressor.h"
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+#include <deque>
+
+
+namespace Anvil
+{
+    class TransferBatch : public MTSafetySupportProvider
+    {
+    public:
+        /* Public type definitions */
+
+        /** Describes a single LZ4-compressed chunk of data. */
+        typedef struct CompressedChunk
+        {
+            const void* data_ptr;          /* Raw LZ4 block                                             */
+            uint32_t    compressed_size;   /* Number of bytes under data_ptr                            */
+            uint32_t    decompressed_size; /* Number of bytes the block decompresses to. Must not be 0. */
+
+            CompressedChunk()
+                :data_ptr         (nullptr),
+                 compressed_size  (0),
+                 decompressed_size(0)
+            {
+                /* Stub */
+            }
+
+            CompressedChunk(const void* in_data_ptr,
+                            uint32_t    in_compressed_size,
+                            uint32_t    in_decompressed_size)
+                :data_ptr         (in_data_ptr),
+                 compressed_size  (in_compressed_size),
+                 decompressed_size(in_decompressed_size)
+            {
+                /* Stub */
+            }
+        } CompressedChunk;
+
+        /** Describes compressed data of a single mip. The chunks, decompressed one after another, must form
+         *  the mip's linear, tightly packed data, laid out as for MipmapRawData.
+         */
+        typedef struct CompressedMipmap
+        {
+            Anvil::ImageAspectFlagBits   aspect;
+            std::vector<CompressedChunk> chunks;
+            uint32_t                     n_layer;
+            uint32_t                     n_layers;
+            uint32_t                     n_mipmap;
+            uint32_t                     n_slices;
+
+            CompressedMipmap()
+                :aspect  (Anvil::ImageAspectFlagBits::NONE),
+                 n_layer (0),
+                 n_layers(1),
+                 n_mipmap(0),
+                 n_slices(1)
+            {
+                /* Stub */
+            }
+        } CompressedMipmap;
+
+        /* Public functions */
+
+        /** Creates a new transfer batch instance.
+         *
+         *  @param in_device_ptr               Device to create the batch for. Must not be null.
+         *  @param in_opt_queue_ptr            Queue to submit copy ops to. If null, all transfer queues will be
+         *                                     used, or the first universal queue, if the device exposes no
+         *                                     transfer queues. If GPU decompression is requested, the first compute
+         *                                     queue is used instead, or the first universal queue, if the device
+         *                                     exposes no compute queues.
+         *  @param in_mt_safe                  True if the instance should be thread-safe.
+         *  @param in_enable_gpu_decompression True if the batch should accept compressed data. Requires Anvil to
+         *                                     be built with ANVIL_LINK_WITH_GLSLANG defined.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::TransferBatchUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
+                                                    Anvil::Queue*            in_opt_queue_ptr            = nullptr,
+                                                    bool                     in_mt_safe                  = false,
+                                                    bool                     in_enable_gpu_decompression = false);
+
+        /** Creates a new transfer batch instance, which spreads copy ops across multiple queues.
+         *
+         *  @param in_device_ptr               Device to create the batch for. Must not be null.
+         *  @param in_queue_ptrs               Queues to submit copy ops to. Must not be empty. All queues must
+         *                                     belong to the same queue family. Decompression dispatches are only
+         *                                     submitted to the first queue.
+         *  @param in_mt_safe                  True if the instance should be thread-safe.
+         *  @param in_enable_gpu_decompression True if the batch should accept compressed data. Requires Anvil to
+         *                                     be built with ANVIL_LINK_WITH_GLSLANG defined.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::TransferBatchUniquePtr create(const Anvil::BaseDevice*          in_device_ptr,
+                                                    const std::vector<Anvil::Queue*>& in_queue_ptrs,
+                                                    bool                              in_mt_safe                  = false,
+                                                    bool                              in_enable_gpu_decompression = false);
+
+        /** Destructor. Flushes outstanding copies and waits until all of them finish executing. */
+        ~TransferBatch();
+
+        /** Queues a buffer update.
+         *
+         *  Writes of up to 64 KB, whose start offset and size are multiples of 4, are recorded as inline updates
+         *  and do not use the staging buffer.
+         *
+         *  @param in_buffer_ptr   Buffer to update. Must not be null.
+         *  @param in_start_offset Start offset of the region to update.
+         *  @param in_size         Number of bytes to update. Must not be 0.
+         *  @param in_data         Data to use. Must not be null. Copied before the function returns.
+         *
+         *  @return Token of the flush the copy will be submitted with.
+         */
+        uint64_t enqueue_buffer_write(Anvil::Buffer* in_buffer_ptr,
+                                      VkDeviceSize   in_start_offset,
+                                      VkDeviceSize   in_size,
+                                      const void*    in_data);
+
+        /** Queues a buffer update, whose data is provided in compressed form. Can only be used if GPU decompression
+         *  has been enabled at creation time.
+         *
+         *  The chunks are decompressed one after another, starting at @param in_start_offset.
+         *
+         *  @param in_buffer_ptr   Buffer to update. Must not be null.
+         *  @param in_start_offset Start offset of the region to update.
+         *  @param in_n_chunks     Number of chunks under @param in_chunks_ptr. Must not be 0.
+         *  @param in_chunks_ptr   Chunks to use. Must not be null. Decompressed size of all chunks but the last one
+         *                         must be a multiple of 4. Chunk data is copied before the function returns.
+         *
+         *  @return Token of the flush the copy will be submitted with.
+         */
+        uint64_t enqueue_compressed_buffer_write(Anvil::Buffer*         in_buffer_ptr,
+                                                 VkDeviceSize           in_start_offset,
+                                                 uint32_t               in_n_chunks,
+                                                 const CompressedChunk* in_chunks_ptr);
+
+        /** Queues an update of optimally-tiled image mips, whose data is provided in compressed form. Can only be
+         *  used if GPU decompression has been enabled at creation time.
+         *
+         *  Follows the same rules as enqueue_image_upload(). Decompressed size of all chunks of a mip but the last
+         *  one must be a multiple of 4.
+         *
+         *  @param in_image_ptr             Image to update. Must not be null. Must use optimal tiling.
+         *  @param in_mipmaps               Compressed mip data to use. Copied before the function returns.
+         *  @param in_current_image_layout  Image layout the image will be in when the batch executes.
+         *  @param out_new_image_layout_ptr Deref will be set to the layout the image will be in after the copy
+         *                                  ops execute. Must not be null.
+         *
+         *  @return Token of the flush the copy will be submitted with.
+         */
+        uint64_t enqueue_compressed_image_upload(Anvil::Image*                        in_image_ptr,
+                                                 const std::vector<CompressedMipmap>& in_mipmaps,
+                                                 Anvil::ImageLayout                   in_current_image_layout,
+                                                 Anvil::ImageLayout*                  out_new_image_layout_ptr);
+
+        /** Queues an update of optimally-tiled image mips.
+         *
+         *  The image will be transitioned to TRANSFER_DST_OPTIMAL layout, unless @param in_current_image_layout is
+         *  GENERAL or TRANSFER_DST_OPTIMAL already.
+         *
+         *  @param in_image_ptr             Image to update. Must not be null. Must use optimal tiling.
+         *  @param in_mipmaps               Mip data to use. Copied before the function returns.
+         *  @param in_current_image_layout  Image layout the image will be in when the batch executes.
+         *  @param out_new_image_layout_ptr Deref will be set to the layout the image will be in after the copy
+         *                                  ops execute. Must not be null.
+         *
+         *  @return Token of the flush the copy will be submitted with.
+         */
+        uint64_t enqueue_image_upload(Anvil::Image*                            in_image_ptr,
+                                      const std::vector<Anvil::MipmapRawData>& in_mipmaps,
+                                      Anvil::ImageLayout                       in_current_image_layout,
+                                      Anvil::ImageLayout*                      out_new_image_layout_ptr);
+
+        /** Submits all queued copies. Does not block.
+         *
+         *  @param in_n_semaphores_to_signal           Number of semaphores to signal once the copies finish executing.
+         *  @param in_opt_semaphore_to_signal_ptrs_ptr Semaphores to signal. Must not be null if @param in_n_semaphores_to_signal
+         *                                             is not 0.
+         *
+         *  @return Token associated with the submitted copies. If no copies have been queued, the token of the
+         *          most recent flush is returned instead (0 if flush() has never submitted anything).
+         */
+        uint64_t flush(uint32_t                 in_n_semaphores_to_signal           = 0,
+                       Anvil::Semaphore* const* in_opt_semaphore_to_signal_ptrs_ptr = nullptr);
+
+        /** Returns the token, which the currently queued copies are going to be submitted with. */
+        uint64_t get_pending_token() const
+        {
+            return m_next_token;
+        }
+
+        /** Returns the number of queues the batch submits copy ops to. */
+        uint32_t get_n_queues() const
+        {
+            return static_cast<uint32_t>(m_queue_ptrs.size() );
+        }
+
+        /** Returns a queue the batch submits copy ops to.
+         *
+         *  @param in_n_queue Index of the queue to return. Must be smaller than the value returned by get_n_queues().
+         */
+        Anvil::Queue* get_queue(uint32_t in_n_queue = 0) const
+        {
+            return m_queue_ptrs.at(in_n_queue);
+        }
+
+        /** Tells whether all copies associated with @param in_token have finished executing. */
+        bool is_complete(uint64_t in_token);
+
+        /** Tells whether the batch accepts compressed data. */
+        bool is_gpu_decompression_enabled() const
+        {
+            return (m_decompressor_ptr != nullptr);
+        }
+
+        /** Blocks until all copies associated with @param in_token finish executing. If the token refers to
+         *  copies which have not been flushed yet, a flush() call is made first.
+         *
+         *  The batch is not locked for the duration of the wait, so other threads can keep enqueueing & flushing
+         *  copies meanwhile.
+         *
+         *  @param in_token   Token to wait on.
+         *  @param in_timeout Timeout, expressed in nanoseconds.
+         *
+         *  @return true if the copies finished executing within the specified timeout, false otherwise.
+         */
+        bool wait(uint64_t in_token,
+                  uint64_t in_timeout = UINT64_MAX);
+
+    private:
+        /* Private type definitions */
+        typedef struct BufferCopyItem
+        {
+            Anvil::Buffer* buffer_ptr;
+            VkDeviceSize   dst_offset;
+            bool           is_decompressed;
+            bool           is_inline_update;
+            VkDeviceSize   size;
+
+            /* Offset into m_pending_inline_data for inline updates, offset into the decompression buffer for
+             * decompressed data, offset into the staging buffer otherwise. */
+            VkDeviceSize   src_offset;
+
+            BufferCopyItem(Anvil::Buffer* in_buffer_ptr,
+                           VkDeviceSize   in_dst_offset,
+                           VkDeviceSize   in_size,
+                           VkDeviceSize   in_src_offset,
+                           bool           in_is_inline_update,
+                           bool           in_is_decompressed = false)
+                :buffer_ptr      (in_buffer_ptr),
+                 dst_offset      (in_dst_offset),
+                 is_decompressed (in_is_decompressed),
+                 is_inline_update(in_is_inline_update),
+                 size            (in_size),
+                 src_offset      (in_src_offset)
+            {
+                /* Stub */
+            }
+        } BufferCopyItem;
+
+        typedef struct ImageCopyItem
+        {
+            std::vector<Anvil::BufferImageCopy> copy_regions;
+            Anvil::ImageLayout                  current_layout;
+            Anvil::Image*                       image_ptr;
+            bool                                is_decompressed;
+            VkDeviceSize                        n_bytes;
+            Anvil::ImageLayout                  new_layout;
+            Anvil::ImageSubresourceRange        subresource_range;
+        } ImageCopyItem;
+
+        typedef struct InFlightFlush
+        {
+            std::vector<Anvil::PrimaryCommandBufferUniquePtr> cmd_buffer_ptrs;
+            Anvil::BufferUniquePtr                            decompression_buffer_ptr;
+            Anvil::FenceUniquePtr                             fence_ptr;
+            std::vector<Anvil::SemaphoreUniquePtr>            semaphore_ptrs;
+            Anvil::BufferUniquePtr                            staging_buffer_ptr;
+            uint64_t                                          token;
+
+            InFlightFlush(std::vector<Anvil::PrimaryCommandBufferUniquePtr> in_cmd_buffer_ptrs,
+                          std::vector<Anvil::SemaphoreUniquePtr>            in_semaphore_ptrs,
+                          Anvil::FenceUniquePtr                             in_fence_ptr,
+                          Anvil::BufferUniquePtr                            in_staging_buffer_ptr,
+                          Anvil::BufferUniquePtr                            in_decompression_buffer_ptr,
+                          uint64_t                                          in_token)
+                :cmd_buffer_ptrs         (std::move(in_cmd_buffer_ptrs) ),
+                 decompression_buffer_ptr(std::move(in_decompression_buffer_ptr) ),
+                 fence_ptr               (std::move(in_fence_ptr) ),
+                 semaphore_ptrs          (std::move(in_semaphore_ptrs) ),
+                 staging_buffer_ptr      (std::move(in_staging_buffer_ptr) ),
+                 token                   (in_token)
+            {
+                /* Stub */
+            }
+        } InFlightFlush;
+
+        /* Private functions */
+        TransferBatch(const Anvil::BaseDevice*          in_device_ptr,
+                      const std::vector<Anvil::Queue*>& in_queue_ptrs,
+                      bool                              in_mt_safe);
+
+        bool init(bool in_enable_gpu_decompression);
+
+        VkDeviceSize               append_compressed_chunks(uint32_t                                         in_n_chunks,
+                                                            const CompressedChunk*                           in_chunks_ptr,
+                                                            VkDeviceSize*                                    out_decompressed_size_ptr);
+        VkDeviceSize               append_data             (const void*                                      in_data,
+                                                            VkDeviceSize                                     in_size);
+        void                       distribute_copies       (std::vector<std::vector<BufferCopyItem> >*       out_buffer_copies_per_queue_ptr,
+                                                            std::vector<std::vector<const ImageCopyItem*> >* out_image_copies_per_queue_ptr) const;
+        Anvil::BufferImageCopy     get_copy_region         (const Anvil::Image*                              in_image_ptr,
+                                                            Anvil::ImageAspectFlagBits                       in_aspect,
+                                                            uint32_t                                         in_n_layer,
+                                                            uint32_t                                         in_n_layers,
+                                                            uint32_t                                         in_n_mipmap,
+                                                            uint32_t                                         in_n_slices,
+                                                            VkDeviceSize                                     in_buffer_offset) const;
+        Anvil::BufferUniquePtr     get_decompression_buffer(VkDeviceSize                                     in_size);
+        Anvil::FenceUniquePtr      get_fence               ();
+        Anvil::QueueFamilyFlagBits get_queue_family_bits   () const;
+        Anvil::SemaphoreUniquePtr  get_semaphore           ();
+        Anvil::BufferUniquePtr     get_staging_buffer      (VkDeviceSize                                     in_size);
+        void                       init_image_copy_item    (Anvil::Image*                                    in_image_ptr,
+                                                            Anvil::ImageLayout                               in_current_image_layout,
+                                                            bool                                             in_is_decompressed,
+                                                            ImageCopyItem*                                   out_copy_item_ptr) const;
+        void                       record_copies           (Anvil::PrimaryCommandBuffer*                     in_cmd_buffer_ptr,
+                                                            const std::vector<BufferCopyItem>&               in_buffer_copies,
+                                                            const std::vector<const ImageCopyItem*>&         in_image_copies,
+                                                            Anvil::Buffer*                                   in_staging_buffer_ptr,
+                                                            Anvil::Buffer*                                   in_decompression_buffer_ptr,
+                                                            VkDeviceSize                                     in_chunk_table_offset,
+                                                            bool                                             in_record_decompression);
+        void                       retire_flushes          ();
+
+        /* Private variables */
+        std::vector<BufferCopyItem>                      m_pending_buffer_copies;
+        std::vector<Anvil::GPUDecompressor::ChunkInfo>   m_pending_chunks;
+        std::vector<unsigned char>                       m_pending_data;
+        VkDeviceSize                                     m_pending_decompressed_data_size;
+        std::vector<ImageCopyItem>                       m_pending_image_copies;
+        std::vector<unsigned char>                       m_pending_inline_data;
+
+        Anvil::GPUDecompressorUniquePtr                  m_decompressor_ptr;
+        const Anvil::BaseDevice*                         m_device_ptr;
+        std::vector<Anvil::BufferUniquePtr>              m_free_decompression_buffers;
+        std::vector<Anvil::FenceUniquePtr>               m_free_fences;
+        std::vector<Anvil::SemaphoreUniquePtr>           m_free_semaphores;
+        std::vector<Anvil::BufferUniquePtr>              m_free_staging_buffers;
+        std::deque<InFlightFlush>                        m_in_flight_flushes;
+        Anvil::SemaphoreUniquePtr                        m_last_flush_semaphore_ptr;
+        uint64_t                                         m_last_retired_token;
+        uint64_t                                         m_next_token;
+        uint32_t                                         m_n_unlocked_fence_waits;
+        std::vector<Anvil::Queue*>                       m_queue_ptrs;
+        VkDeviceSize                                     m_staging_data_alignment;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(TransferBatch);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(TransferBatch);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_TRANSFER_BATCH_H */
@@ -0,0 +1,196 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a linear, per-frame sub-allocator for short-lived buffer data, such as uniform data
+ *  consumed through dynamic offsets.
+ *
+ *  Each frame slot owns a list of persistently mapped, host-coherent chunk buffers. Allocations are
+ *  carved out of the current chunk by bumping an offset, so they cost no Vulkan calls. When a chunk
+ *  runs out of space, the next chunk retained by the slot is used, or a new one is created. Requests
+ *  larger than the chunk size get a dedicated chunk.
+ *
+ *  begin_frame() moves to the next frame slot and recycles all of its allocations at once. It is the
+ *  caller's responsibility to make sure the GPU is no longer accessing the slot's data at that point;
+ *  the easiest way to achieve this is to call it in lockstep with CommandBufferFrameRing::begin_frame(),
+ *  using the same number of frames in flight.
+ *
+ *  Transient buffer allocator is NOT thread-safe, unless created with @param in_mt_safe set to true.
+ */
+#ifndef MISC_TRANSIENT_BUFFER_ALLOCATOR_H
+#define MISC_TRANSIENT_BUFFER_ALLOCATOR_H
+
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class TransientBufferAllocator : public MTSafetySupportProvider
+    {
+    public:
+        /* Public type definitions */
+        typedef struct Allocation
+        {
+            Anvil::Buffer* buffer_ptr;
+            void*          mapped_ptr;
+            VkDeviceSize   offset;
+            VkDeviceSize   size;
+
+            Allocation()
+                :buffer_ptr(nullptr),
+                 mapped_ptr(nullptr),
+                 offset    (0),
+                 size      (0)
+            {
+                /* Stub */
+            }
+        } Allocation;
+
+        /* Public functions */
+
+        /** Creates a new transient buffer allocator instance.
+         *
+         *  @param in_device_ptr         Device to create the allocator for. Must not be null.
+         *  @param in_n_frames_in_flight Number of frames which can be in flight at any given time. Must not be 0.
+         *  @param in_chunk_size         Size of chunk buffers to create. Must not be 0.
+         *  @param in_usage_flags        Usage flags to create chunk buffers with.
+         *  @param in_mt_safe            True if the instance should be thread-safe.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::TransientBufferAllocatorUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
+                                                               uint32_t                 in_n_frames_in_flight,
+                                                               VkDeviceSize             in_chunk_size  = 4 * 1024 * 1024,
+                                                               Anvil::BufferUsageFlags  in_usage_flags = Anvil::BufferUsageFlagBits::UNIFORM_BUFFER_BIT,
+                                                               bool                     in_mt_safe     = false);
+
+        /** Destructor. The caller must make sure none of the chunks is still accessed by the GPU. */
+        ~TransientBufferAllocator();
+
+        /** Sub-allocates a region for the current frame.
+         *
+         *  The region's start offset is aligned to the allocator's alignment, which is compatible with dynamic
+         *  offsets for the usages the allocator has been created with. The region stays valid until the frame
+         *  slot is reused by begin_frame().
+         *
+         *  @param in_size        Number of bytes to allocate. Must not be 0.
+         *  @param out_result_ptr Deref will be set to the allocation details if the call succeeds. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool allocate(VkDeviceSize in_size,
+                      Allocation*  out_result_ptr);
+
+        /** Sub-allocates a region for the current frame and fills it with user data.
+         *
+         *  @param in_size        Number of bytes to allocate. Must not be 0.
+         *  @param in_data        Data to copy to the region. Must not be null.
+         *  @param out_result_ptr Please see allocate() for specification.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool allocate_and_write(VkDeviceSize in_size,
+                                const void*  in_data,
+                                Allocation*  out_result_ptr);
+
+        /** Moves to the next frame slot and recycles all allocations made for it. Chunks created for the slot
+         *  in earlier frames are retained and reused. */
+        void begin_frame();
+
+        /** Returns the alignment all allocations are rounded up to. */
+        VkDeviceSize get_alignment() const
+        {
+            return m_alignment;
+        }
+
+        /** Returns the number of chunk buffers created so far, across all frame slots. */
+        uint32_t get_n_chunks() const;
+
+        /** Returns the index of the current frame slot. */
+        uint32_t get_n_current_frame() const
+        {
+            return m_n_current_frame;
+        }
+
+        /** Returns usage flags chunk buffers are created with. */
+        Anvil::BufferUsageFlags get_usage_flags() const
+        {
+            return m_usage_flags;
+        }
+
+    private:
+        /* Private type definitions */
+        typedef struct Chunk
+        {
+            Anvil::BufferUniquePtr buffer_ptr;
+            unsigned char*         mapped_ptr;
+            VkDeviceSize           size;
+
+            Chunk(Anvil::BufferUniquePtr in_buffer_ptr,
+                  unsigned char*         in_mapped_ptr,
+                  VkDeviceSize           in_size)
+                :buffer_ptr(std::move(in_buffer_ptr) ),
+                 mapped_ptr(in_mapped_ptr),
+                 size      (in_size)
+            {
+                /* Stub */
+            }
+        } Chunk;
+
+        typedef struct Frame
+        {
+            std::vector<Chunk> chunks;
+            uint32_t           n_current_chunk;
+            VkDeviceSize       head_offset;
+
+            Frame()
+                :n_current_chunk(0),
+                 head_offset    (0)
+            {
+                /* Stub */
+            }
+        } Frame;
+
+        /* Private functions */
+        TransientBufferAllocator(const Anvil::BaseDevice* in_device_ptr,
+                                 uint32_t                 in_n_frames_in_flight,
+                                 VkDeviceSize             in_chunk_size,
+                                 Anvil::BufferUsageFlags  in_usage_flags,
+                                 bool                     in_mt_safe);
+
+        bool create_chunk(VkDeviceSize in_size,
+                          Frame*       in_frame_ptr);
+
+        /* Private variables */
+        VkDeviceSize             m_alignment;
+        const VkDeviceSize       m_chunk_size;
+        const Anvil::BaseDevice* m_device_ptr;
+        std::vector<Frame>       m_frames;
+        uint32_t                 m_n_current_frame;
+        Anvil::BufferUsageFlags  m_usage_flags;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(TransientBufferAllocator);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(TransientBufferAllocator);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_TRANSIENT_BUFFER_ALLOCATOR_H */
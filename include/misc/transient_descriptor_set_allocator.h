@@ -0,0 +1,155 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a linear, per-frame allocator for transient descriptor sets, such as per-draw sets which
+ *  are only used by the command buffers recorded for a single frame.
+ *
+ *  Each thread which allocates sets gets its own DescriptorPoolChain for every frame slot, so that
+ *  allocations do not need to be synchronized with other threads. Sets are carved out of the current pool
+ *  of the chain. Once the pool runs out of space, the next pool retained by the chain is used, or a new one
+ *  is created. Pools are never destroyed until the allocator is released, so after a few frames all
+ *  allocations are served by warm pools.
+ *
+ *  begin_frame() moves to the next frame slot and resets all of its pools at once, which releases all
+ *  sets allocated for the slot. If a fence has been associated with the slot, the function first waits
+ *  until it is signalled.
+ *
+ *  The total usage of each thread's pool chain is reported to the device's DescriptorPoolSizingProfile whenever
+ *  a frame slot is recycled. If adaptive sizing is enabled on the profile, the first pool of each new chain is
+ *  sized to fit a whole frame worth of allocations, as observed so far, instead of using the sizes specified
+ *  at creation time.
+ *
+ *  Pools are created without the UPDATE_AFTER_BIND and FREE_DESCRIPTOR_SET flags, and do not reserve space
+ *  for inline uniform blocks. Sets using layouts which require any of these should be allocated from
+ *  a DescriptorSetGroup instead.
+ *
+ *  allocate() may be called from any thread, but not concurrently with begin_frame().
+ */
+#ifndef MISC_TRANSIENT_DESCRIPTOR_SET_ALLOCATOR_H
+#define MISC_TRANSIENT_DESCRIPTOR_SET_ALLOCATOR_H
+
+#include "misc/descriptor_pool_chain.h"
+#include "misc/types.h"
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+
+namespace Anvil
+{
+    class TransientDescriptorSetAllocator
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new transient descriptor set allocator instance.
+         *
+         *  @param in_device_ptr                   Device to create the allocator for. Must not be null.
+         *  @param in_n_frames_in_flight           Number of frames which can be in flight at any given time. Must not be 0.
+         *  @param in_n_sets_per_pool              Maximum number of sets each pool can hold. Must not be 0.
+         *  @param in_n_descriptors_per_type_pool  Number of descriptors of each type each pool can hold. Must not be 0.
+         *
+         *  @return New instance if successful, null otherwise.
+         */
+        static Anvil::TransientDescriptorSetAllocatorUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
+                                                                      uint32_t                 in_n_frames_in_flight,
+                                                                      uint32_t                 in_n_sets_per_pool             = 256,
+                                                                      uint32_t                 in_n_descriptors_per_type_pool = 1024);
+
+        /** Destructor. The caller must make sure none of the sets is still accessed by the GPU. */
+        ~TransientDescriptorSetAllocator();
+
+        /** Allocates a descriptor set for the current frame from the calling thread's pool chain.
+         *
+         *  The set stays valid until the frame slot is reused by begin_frame(). It must not be released by the caller.
+         *
+         *  @param in_ds_allocation Layout (and, if needed, the variable descriptor count) to allocate the set with.
+         *                          The layout must not be null.
+         *
+         *  @return Descriptor set if successful, null otherwise.
+         */
+        Anvil::DescriptorSet* allocate(const Anvil::DescriptorSetAllocation& in_ds_allocation);
+
+        /** Moves to the next frame slot and releases all sets allocated for it. Pools created for the slot in
+         *  earlier frames are reset and retained.
+         *
+         *  @param in_opt_fence_ptr If not null, the fence must be signalled by the app once the GPU finishes
+         *                          executing all the commands which use sets allocated for the new frame. The next
+         *                          time the slot is about to be recycled, the function is going to wait on it.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool begin_frame(Anvil::Fence* in_opt_fence_ptr = nullptr);
+
+        /** Returns the index of the current frame slot. */
+        uint32_t get_n_current_frame() const
+        {
+            return m_n_current_frame;
+        }
+
+        /** Returns the number of descriptor pools created so far, across all threads and frame slots. */
+        uint32_t get_n_pools() const;
+
+    private:
+        /* Private type definitions */
+        typedef struct Frame
+        {
+            std::unique_ptr<Anvil::DescriptorPoolChain> pool_chain_ptr;
+            std::vector<Anvil::DescriptorSetUniquePtr>  sets;
+        } Frame;
+
+        typedef struct ThreadData
+        {
+            std::vector<Frame> frames;
+
+            ThreadData(uint32_t in_n_frames)
+                :frames(in_n_frames)
+            {
+                /* Stub */
+            }
+        } ThreadData;
+
+        /* Private functions */
+        TransientDescriptorSetAllocator(const Anvil::BaseDevice* in_device_ptr,
+                                        uint32_t                 in_n_frames_in_flight,
+                                        uint32_t                 in_n_sets_per_pool,
+                                        uint32_t                 in_n_descriptors_per_type_pool);
+
+        ThreadData* get_thread_data();
+
+        /* Private variables */
+        const Anvil::BaseDevice*                                          m_device_ptr;
+        std::vector<Anvil::Fence*>                                        m_frame_fences;
+        const uint32_t                                                    m_n_descriptors_per_type_pool;
+        uint32_t                                                          m_n_current_frame;
+        const uint32_t                                                    m_n_frames_in_flight;
+        const uint32_t                                                    m_n_sets_per_pool;
+        uint64_t                                                          m_sizing_profile_key;
+        std::unordered_map<std::thread::id, std::unique_ptr<ThreadData> > m_thread_data;
+        mutable std::mutex                                                m_thread_data_mutex;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(TransientDescriptorSetAllocator);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(TransientDescriptorSetAllocator);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_TRANSIENT_DESCRIPTOR_SET_ALLOCATOR_H */
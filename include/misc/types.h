@@ -105,63 +105,103 @@
 /* Forward declarations */
 namespace Anvil
 {
+    class  AccelerationStructure;
+    class  AccelerationStructureBuilder;
+    class  AccelerationStructureCreateInfo;
+    class  AsyncFileReader;
+    class  BackgroundWorkScheduler;
     class  BaseDevice;
     class  BasePipelineCreateInfo;
+    class  BasePipelineManager;
     class  Buffer;
     class  BufferCreateInfo;
+    class  BufferSuballocator;
     class  BufferView;
     class  BufferViewCreateInfo;
     struct CallbackArgument;
+    class  CommandArena;
     class  CommandBufferBase;
+    class  CommandBufferFrameRing;
     class  CommandPool;
+    class  CompletionService;
+    class  ComputeKernel;
     class  ComputePipelineCreateInfo;
     class  ComputePipelineManager;
+    class  ComputePrimitives;
     class  DebugMessenger;
     class  DebugMessengerCreateInfo;
+    class  DeferredDeletionQueue;
+    class  DepthPyramidBuilder;
     class  DescriptorPool;
+    class  DescriptorPoolChain;
     class  DescriptorPoolCreateInfo;
+    class  DescriptorPoolSizingProfile;
     class  DescriptorSet;
+    class  DescriptorSetCache;
     class  DescriptorSetCreateInfo;
     class  DescriptorSetGroup;
     class  DescriptorSetLayout;
     class  DescriptorSetLayoutManager;
     class  DescriptorUpdateTemplate;
     class  DeviceCreateInfo;
+    class  DrawBatcher;
     class  ExternalHandle;
     class  Event;
     class  EventCreateInfo;
     class  Fence;
     class  FenceCreateInfo;
+    class  FrameGraph;
+    class  FrameTimingRecorder;
     class  Framebuffer;
+    class  FramebufferCache;
     class  FramebufferCreateInfo;
+    class  GLSLHeaderCache;
     class  GLSLShaderToSPIRVGenerator;
+    class  GPUDecompressor;
+    class  GPUProfiler;
     class  GraphicsPipelineCreateInfo;
     class  GraphicsPipelineManager;
+    class  HostAllocator;
     class  Image;
     class  ImageCreateInfo;
     class  ImageView;
     class  ImageViewCreateInfo;
+    class  IndirectDrawCuller;
     class  Instance;
     class  InstanceCreateInfo;
+    class  MappedFile;
+    class  MappedMemoryRangeBatch;
     class  MemoryAllocator;
     class  MemoryBlock;
     class  MemoryBlockCreateInfo;
     struct MemoryHeap;
     struct MemoryProperties;
     struct MemoryType;
+    class  MeshletBuilder;
     class  MGPUDevice;
+    class  MGPUWorkSplitter;
+    class  ParallelCommandRecorder;
+    class  PerDrawConstants;
     class  PhysicalDevice;
     class  PipelineCache;
     class  PipelineLayout;
     class  PipelineLayoutManager;
+    class  PipelineManifest;
+    class  PipelineStatisticsProfiler;
     class  PrimaryCommandBuffer;
+    class  QueryAllocator;
     class  QueryPool;
+    class  QueryResultReader;
+    class  ReadbackRing;
     class  Queue;
+    class  QueueUtilizationTracker;
     class  RenderingSurface;
     class  RenderingSurfaceCreateInfo;
     class  RenderPass;
+    class  RenderPassCache;
     class  RenderPassCreateInfo;
     class  Sampler;
+    class  SamplerCache;
     class  SamplerCreateInfo;
     class  SamplerYCbCrConversion;
     class  SamplerYCbCrConversionCreateInfo;
@@ -169,25 +209,57 @@ namespace Anvil
     class  Semaphore;
     class  SemaphoreCreateInfo;
     class  SGPUDevice;
+    class  ShaderHotReloader;
     class  ShaderModule;
     class  ShaderModuleCache;
+    class  ShaderReflection;
+    class  ShaderStatisticsReport;
+    class  SkinningCache;
+    class  SparseResidencyManager;
+    class  StagingRing;
+    class  SubmitThread;
     class  Swapchain;
     class  SwapchainCreateInfo;
+    class  TaskScheduler;
+    class  TaskWaitGroup;
+    class  TextureConverter;
+    class  ThreadLocalArenaHostAllocator;
+    class  TrackingHostAllocator;
+    class  TextureFile;
+    class  TransferBatch;
+    class  TransientBufferAllocator;
+    class  TransientDescriptorSetAllocator;
+    class  VertexPacker;
     class  Window;
+    class  WorkStealingTaskScheduler;
 
+    typedef std::unique_ptr<AccelerationStructureBuilder,          std::function<void(AccelerationStructureBuilder*)> > AccelerationStructureBuilderUniquePtr;
+    typedef std::unique_ptr<AccelerationStructureCreateInfo>                                                           AccelerationStructureCreateInfoUniquePtr;
+    typedef std::unique_ptr<AccelerationStructure,                 std::function<void(AccelerationStructure*)> >       AccelerationStructureUniquePtr;
+    typedef std::unique_ptr<AsyncFileReader,                       std::function<void(AsyncFileReader*)> >             AsyncFileReaderUniquePtr;
+    typedef std::unique_ptr<BackgroundWorkScheduler,               std::function<void(BackgroundWorkScheduler*)> >     BackgroundWorkSchedulerUniquePtr;
     typedef std::unique_ptr<BaseDevice,                            std::function<void(BaseDevice*)> >                  BaseDeviceUniquePtr;
     typedef std::unique_ptr<BasePipelineCreateInfo>                                                                    BasePipelineCreateInfoUniquePtr;
     typedef std::unique_ptr<BufferCreateInfo>                                                                          BufferCreateInfoUniquePtr;
     typedef std::unique_ptr<Buffer,                                std::function<void(Buffer*)> >                      BufferUniquePtr;
+    typedef std::unique_ptr<BufferSuballocator,                    std::function<void(BufferSuballocator*)> >          BufferSuballocatorUniquePtr;
     typedef std::unique_ptr<BufferViewCreateInfo>                                                                      BufferViewCreateInfoUniquePtr;
     typedef std::unique_ptr<BufferView,                            std::function<void(BufferView*)> >                  BufferViewUniquePtr;
     typedef std::unique_ptr<CommandBufferBase,                     std::function<void(CommandBufferBase*)> >           CommandBufferBaseUniquePtr;
+    typedef std::unique_ptr<CommandBufferFrameRing,                std::function<void(CommandBufferFrameRing*)> >      CommandBufferFrameRingUniquePtr;
     typedef std::unique_ptr<CommandPool,                           std::function<void(CommandPool*)> >                 CommandPoolUniquePtr;
+    typedef std::unique_ptr<CompletionService,                     std::function<void(CompletionService*)> >           CompletionServiceUniquePtr;
+    typedef std::unique_ptr<ComputeKernel,                         std::function<void(ComputeKernel*)> >               ComputeKernelUniquePtr;
     typedef std::unique_ptr<ComputePipelineCreateInfo>                                                                 ComputePipelineCreateInfoUniquePtr;
+    typedef std::unique_ptr<ComputePrimitives,                     std::function<void(ComputePrimitives*)> >           ComputePrimitivesUniquePtr;
     typedef std::unique_ptr<DebugMessengerCreateInfo>                                                                  DebugMessengerCreateInfoUniquePtr;
     typedef std::unique_ptr<DebugMessenger,                        std::function<void(DebugMessenger*)> >              DebugMessengerUniquePtr;
+    typedef std::unique_ptr<DeferredDeletionQueue,                 std::function<void(DeferredDeletionQueue*)> >       DeferredDeletionQueueUniquePtr;
+    typedef std::unique_ptr<DepthPyramidBuilder,                   std::function<void(DepthPyramidBuilder*)> >         DepthPyramidBuilderUniquePtr;
     typedef std::unique_ptr<DescriptorPoolCreateInfo>                                                                  DescriptorPoolCreateInfoUniquePtr;
     typedef std::unique_ptr<DescriptorPool,                        std::function<void(DescriptorPool*)> >              DescriptorPoolUniquePtr;
+    typedef std::unique_ptr<DescriptorPoolSizingProfile,           std::function<void(DescriptorPoolSizingProfile*)> > DescriptorPoolSizingProfileUniquePtr;
+    typedef std::unique_ptr<DescriptorSetCache,                    std::function<void(DescriptorSetCache*)> >          DescriptorSetCacheUniquePtr;
     typedef std::unique_ptr<DescriptorSetCreateInfo>                                                                   DescriptorSetCreateInfoUniquePtr;
     typedef std::unique_ptr<DescriptorSetGroup,                    std::function<void(DescriptorSetGroup*)> >          DescriptorSetGroupUniquePtr;
     typedef std::unique_ptr<DescriptorSetLayout,                   std::function<void(DescriptorSetLayout*)> >         DescriptorSetLayoutUniquePtr;
@@ -195,37 +267,61 @@ namespace Anvil
     typedef std::unique_ptr<DescriptorSet,                         std::function<void(DescriptorSet*)> >               DescriptorSetUniquePtr;
     typedef std::unique_ptr<DescriptorUpdateTemplate,              std::function<void(DescriptorUpdateTemplate*)> >    DescriptorUpdateTemplateUniquePtr;
     typedef std::unique_ptr<DeviceCreateInfo>                                                                          DeviceCreateInfoUniquePtr;
+    typedef std::unique_ptr<DrawBatcher,                           std::function<void(DrawBatcher*)> >                 DrawBatcherUniquePtr;
     typedef std::unique_ptr<ExternalHandle,                        std::function<void(ExternalHandle*)> >              ExternalHandleUniquePtr;
     typedef std::unique_ptr<EventCreateInfo>                                                                           EventCreateInfoUniquePtr;
     typedef std::unique_ptr<Event,                                 std::function<void(Event*)> >                       EventUniquePtr;
     typedef std::unique_ptr<FenceCreateInfo>                                                                           FenceCreateInfoUniquePtr;
     typedef std::unique_ptr<Fence,                                 std::function<void(Fence*)> >                       FenceUniquePtr;
+    typedef std::unique_ptr<FrameGraph,                            std::function<void(FrameGraph*)> >                  FrameGraphUniquePtr;
+    typedef std::unique_ptr<FrameTimingRecorder,                   std::function<void(FrameTimingRecorder*)> >         FrameTimingRecorderUniquePtr;
+    typedef std::unique_ptr<FramebufferCache,                      std::function<void(FramebufferCache*)> >            FramebufferCacheUniquePtr;
     typedef std::unique_ptr<FramebufferCreateInfo>                                                                     FramebufferCreateInfoUniquePtr;
     typedef std::unique_ptr<Framebuffer,                           std::function<void(Framebuffer*)> >                 FramebufferUniquePtr;
+    typedef std::unique_ptr<GLSLHeaderCache,                       std::function<void(GLSLHeaderCache*)> >             GLSLHeaderCacheUniquePtr;
     typedef std::unique_ptr<GLSLShaderToSPIRVGenerator,            std::function<void(GLSLShaderToSPIRVGenerator*)> >  GLSLShaderToSPIRVGeneratorUniquePtr;
+    typedef std::unique_ptr<GPUDecompressor,                       std::function<void(GPUDecompressor*)> >             GPUDecompressorUniquePtr;
+    typedef std::unique_ptr<GPUProfiler,                           std::function<void(GPUProfiler*)> >                 GPUProfilerUniquePtr;
     typedef std::unique_ptr<GraphicsPipelineCreateInfo>                                                                GraphicsPipelineCreateInfoUniquePtr;
     typedef std::unique_ptr<GraphicsPipelineManager>                                                                   GraphicsPipelineManagerUniquePtr;
     typedef std::unique_ptr<ImageCreateInfo>                                                                           ImageCreateInfoUniquePtr;
     typedef std::unique_ptr<Image,                                 std::function<void(Image*)> >                       ImageUniquePtr;
     typedef std::unique_ptr<ImageViewCreateInfo>                                                                       ImageViewCreateInfoUniquePtr;
     typedef std::unique_ptr<ImageView,                             std::function<void(ImageView*)> >                   ImageViewUniquePtr;
+    typedef std::unique_ptr<IndirectDrawCuller,                    std::function<void(IndirectDrawCuller*)> >          IndirectDrawCullerUniquePtr;
     typedef std::unique_ptr<InstanceCreateInfo>                                                                        InstanceCreateInfoUniquePtr;
     typedef std::unique_ptr<Instance,                              std::function<void(Instance*)> >                    InstanceUniquePtr;
+    typedef std::unique_ptr<MappedFile,                            std::function<void(MappedFile*)> >                  MappedFileUniquePtr;
+    typedef std::unique_ptr<MappedMemoryRangeBatch,                std::function<void(MappedMemoryRangeBatch*)> >      MappedMemoryRangeBatchUniquePtr;
     typedef std::unique_ptr<MemoryAllocator,                       std::function<void(MemoryAllocator*)> >             MemoryAllocatorUniquePtr;
     typedef std::unique_ptr<MemoryBlockCreateInfo>                                                                     MemoryBlockCreateInfoUniquePtr;
     typedef std::unique_ptr<MemoryBlock,                           std::function<void(MemoryBlock*)> >                 MemoryBlockUniquePtr;
+    typedef std::unique_ptr<MeshletBuilder,                        std::function<void(MeshletBuilder*)> >              MeshletBuilderUniquePtr;
     typedef std::unique_ptr<MGPUDevice,                            std::function<void(MGPUDevice*)> >                  MGPUDeviceUniquePtr;
+    typedef std::unique_ptr<MGPUWorkSplitter,                      std::function<void(MGPUWorkSplitter*)> >            MGPUWorkSplitterUniquePtr;
+    typedef std::unique_ptr<ParallelCommandRecorder,               std::function<void(ParallelCommandRecorder*)> >     ParallelCommandRecorderUniquePtr;
+    typedef std::unique_ptr<PerDrawConstants,                      std::function<void(PerDrawConstants*)> >            PerDrawConstantsUniquePtr;
     typedef std::unique_ptr<PipelineCache,                         std::function<void(PipelineCache*)> >               PipelineCacheUniquePtr;
     typedef std::unique_ptr<PipelineLayoutManager,                 std::function<void(PipelineLayoutManager*)> >       PipelineLayoutManagerUniquePtr;
+    typedef std::unique_ptr<PipelineManifest,                      std::function<void(PipelineManifest*)> >            PipelineManifestUniquePtr;
     typedef std::unique_ptr<PipelineLayout,                        std::function<void(PipelineLayout*)> >              PipelineLayoutUniquePtr;
+    typedef std::unique_ptr<PipelineStatisticsProfiler,            std::function<void(PipelineStatisticsProfiler*)> >  PipelineStatisticsProfilerUniquePtr;
     typedef std::unique_ptr<PrimaryCommandBuffer,                  std::function<void(PrimaryCommandBuffer*)> >        PrimaryCommandBufferUniquePtr;
+    typedef std::unique_ptr<QueryAllocator,                        std::function<void(QueryAllocator*)> >              QueryAllocatorUniquePtr;
     typedef std::unique_ptr<QueryPool,                             std::function<void(QueryPool*)> >                   QueryPoolUniquePtr;
+    typedef std::unique_ptr<QueryResultReader,                     std::function<void(QueryResultReader*)> >           QueryResultReaderUniquePtr;
+    typedef std::unique_ptr<QueueUtilizationTracker,               std::function<void(QueueUtilizationTracker*)> >     QueueUtilizationTrackerUniquePtr;
+    typedef std::unique_ptr<ReadbackRing,                          std::function<void(ReadbackRing*)> >                ReadbackRingUniquePtr;
     typedef std::unique_ptr<RenderingSurface,                      std::function<void(RenderingSurface*)> >            RenderingSurfaceUniquePtr;
     typedef std::unique_ptr<RenderingSurfaceCreateInfo>                                                                RenderingSurfaceCreateInfoUniquePtr;
+    typedef std::unique_ptr<RenderPassCache,                       std::function<void(RenderPassCache*)> >             RenderPassCacheUniquePtr;
     typedef std::unique_ptr<RenderPassCreateInfo>                                                                      RenderPassCreateInfoUniquePtr;
     typedef std::unique_ptr<RenderPass,                            std::function<void(RenderPass*)> >                  RenderPassUniquePtr;
+    typedef std::shared_ptr<RenderPass>                                                                                RenderPassSharedPtr;
     typedef std::unique_ptr<SamplerCreateInfo>                                                                         SamplerCreateInfoUniquePtr;
+    typedef std::unique_ptr<SamplerCache,                          std::function<void(SamplerCache*)> >                SamplerCacheUniquePtr;
     typedef std::unique_ptr<Sampler,                               std::function<void(Sampler*)> >                     SamplerUniquePtr;
+    typedef std::shared_ptr<Sampler>                                                                                   SamplerSharedPtr;
     typedef std::unique_ptr<SamplerYCbCrConversionCreateInfo>                                                          SamplerYCbCrConversionCreateInfoUniquePtr;
     typedef std::unique_ptr<SamplerYCbCrConversion,                std::function<void(SamplerYCbCrConversion*)> >      SamplerYCbCrConversionUniquePtr;
     typedef std::unique_ptr<SecondaryCommandBuffer,                std::function<void(SecondaryCommandBuffer*)> >      SecondaryCommandBufferUniquePtr;
@@ -233,10 +329,25 @@ namespace Anvil
     typedef std::unique_ptr<Semaphore,                             std::function<void(Semaphore*)> >                   SemaphoreUniquePtr;
     typedef std::unique_ptr<SGPUDevice,                            std::function<void(SGPUDevice*)> >                  SGPUDeviceUniquePtr;
     typedef std::unique_ptr<ShaderModuleCache,                     std::function<void(ShaderModuleCache*)> >           ShaderModuleCacheUniquePtr;
+    typedef std::unique_ptr<ShaderHotReloader,                     std::function<void(ShaderHotReloader*)> >           ShaderHotReloaderUniquePtr;
     typedef std::unique_ptr<ShaderModule,                          std::function<void(ShaderModule*)> >                ShaderModuleUniquePtr;
+    typedef std::unique_ptr<ShaderReflection,                      std::function<void(ShaderReflection*)> >            ShaderReflectionUniquePtr;
+    typedef std::unique_ptr<ShaderStatisticsReport,                std::function<void(ShaderStatisticsReport*)> >      ShaderStatisticsReportUniquePtr;
+    typedef std::unique_ptr<SkinningCache,                         std::function<void(SkinningCache*)> >               SkinningCacheUniquePtr;
+    typedef std::unique_ptr<SparseResidencyManager,                std::function<void(SparseResidencyManager*)> >      SparseResidencyManagerUniquePtr;
+    typedef std::unique_ptr<StagingRing,                           std::function<void(StagingRing*)> >                 StagingRingUniquePtr;
+    typedef std::unique_ptr<SubmitThread,                          std::function<void(SubmitThread*)> >                SubmitThreadUniquePtr;
     typedef std::unique_ptr<SwapchainCreateInfo>                                                                       SwapchainCreateInfoUniquePtr;
     typedef std::unique_ptr<Swapchain,                             std::function<void(Swapchain*)> >                   SwapchainUniquePtr;
+    typedef std::unique_ptr<TextureFile,                           std::function<void(TextureFile*)> >                 TextureFileUniquePtr;
+    typedef std::unique_ptr<ThreadLocalArenaHostAllocator,         std::function<void(ThreadLocalArenaHostAllocator*)> > ThreadLocalArenaHostAllocatorUniquePtr;
+    typedef std::unique_ptr<TrackingHostAllocator,                 std::function<void(TrackingHostAllocator*)> >       TrackingHostAllocatorUniquePtr;
+    typedef std::unique_ptr<TransferBatch,                         std::function<void(TransferBatch*)> >               TransferBatchUniquePtr;
+    typedef std::unique_ptr<TransientBufferAllocator,              std::function<void(TransientBufferAllocator*)> >    TransientBufferAllocatorUniquePtr;
+    typedef std::unique_ptr<TransientDescriptorSetAllocator,       std::function<void(TransientDescriptorSetAllocator*)> > TransientDescriptorSetAllocatorUniquePtr;
+    typedef std::unique_ptr<VertexPacker,                          std::function<void(VertexPacker*)> >                VertexPackerUniquePtr;
     typedef std::unique_ptr<Window,                                std::function<void(Window*)> >                      WindowUniquePtr;
+    typedef std::unique_ptr<WorkStealingTaskScheduler,             std::function<void(WorkStealingTaskScheduler*)> >   WorkStealingTaskSchedulerUniquePtr;
 };
 
 /* Defines various types used by Vulkan API wrapper classes. */
@@ -278,6 +389,9 @@ namespace Anvil
 
     /* Unique ID of a sub-pass within scope of a RenderPass instance. */
     typedef uint32_t SubPassID;
+
+    /* Index of a custom memory pool of a VMA memory allocator, as specified at MemoryAllocator::create_vma() call time. */
+    typedef uint32_t VMAPoolID;
 };
 
 #include "misc/types_enums.h"
@@ -78,6 +78,10 @@ namespace Anvil
                                              Anvil::Semaphore* const* in_opt_wait_semaphores_ptrs_ptr);
 
         /** Appends a new buffer memory block update to the bind info.
+         *
+         *  If the update continues the range described by the last update appended for the same buffer, using the
+         *  same memory block at a contiguous memory offset, the two are merged into a single VkSparseMemoryBind entry.
+         *  Updates which transfer memory block ownership to the buffer are never merged.
          *
          *  @param in_bind_info_id                     ID of the bind info to append the update to.
          *  @param in_buffer_ptr                       Buffer instance to update. Must not be NULL.
@@ -97,6 +101,11 @@ namespace Anvil
                                          VkDeviceSize           in_size);
 
         /** Appends a new non-opaque image memory update to the bind info.
+         *
+         *  If the update covers the tile which follows, along the X axis, a single-tile-high run of tiles described by
+         *  the last update appended for the same image subresource, and uses memory which is contiguous with that run,
+         *  the two are merged into a single VkSparseImageMemoryBind entry. Updates which transfer memory block ownership
+         *  to the image are never merged.
          *
          *  @param in_bind_info_id                    ID of the bind info to append the update to.
          *  @param in_image_ptr                       Image instance to update. Must not be NULL.
@@ -120,6 +129,8 @@ namespace Anvil
                                         bool                           in_opt_memory_block_owned_by_image);
 
         /** Appends a new opaque image memory update to the bind info.
+         *
+         *  Contiguous updates are merged on the same terms as in append_buffer_memory_update().
          *
          *  @param in_bind_info_id                    ID of the bind info to append the update to.
          *  @param in_image_ptr                       Image instance to update. Must not be NULL.
@@ -381,9 +392,12 @@ namespace Anvil
             }
         } ImageBindInfo;
 
-        typedef std::map<Anvil::Buffer*, std::pair<std::vector<GeneralBindInfo>, std::vector<VkSparseMemoryBind>      >> BufferBindUpdateMap;
-        typedef std::map<Anvil::Image*,  std::pair<std::vector<ImageBindInfo>,   std::vector<VkSparseImageMemoryBind> >> ImageBindUpdateMap;
-        typedef std::map<Anvil::Image*,  std::pair<std::vector<GeneralBindInfo>, std::vector<VkSparseMemoryBind>      >> ImageOpaqueBindUpdateMap;
+        typedef std::pair<std::vector<GeneralBindInfo>, std::vector<VkSparseMemoryBind>      > GeneralBindUpdates;
+        typedef std::pair<std::vector<ImageBindInfo>,   std::vector<VkSparseImageMemoryBind> > ImageBindUpdates;
+
+        typedef std::map<Anvil::Buffer*, GeneralBindUpdates> BufferBindUpdateMap;
+        typedef std::map<Anvil::Image*,  ImageBindUpdates>   ImageBindUpdateMap;
+        typedef std::map<Anvil::Image*,  GeneralBindUpdates> ImageOpaqueBindUpdateMap;
 
         typedef struct BindingInfo
         {
@@ -420,7 +434,14 @@ namespace Anvil
         SparseMemoryBindingUpdateInfo          (const SparseMemoryBindingUpdateInfo&);
         SparseMemoryBindingUpdateInfo operator=(const SparseMemoryBindingUpdateInfo&);
 
-        void bake();
+        void bake                 ();
+        bool coalesce_general_bind(GeneralBindUpdates*            in_updates_ptr,
+                                   const GeneralBindInfo&         in_update,
+                                   const VkSparseMemoryBind&      in_update_vk);
+        bool coalesce_image_bind  (const Anvil::Image*            in_image_ptr,
+                                   ImageBindUpdates*              in_updates_ptr,
+                                   const ImageBindInfo&           in_update,
+                                   const VkSparseImageMemoryBind& in_update_vk);
     };
 }; /* namespace Anvil */
 
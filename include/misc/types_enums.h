@@ -239,8 +239,23 @@ namespace Anvil
             IndividualBitEnumType result = static_cast<IndividualBitEnumType>(~static_cast<uint32_t>(in_val1) );                                                          \
                                                                                                                                                                           \
             return result;                                                                                                                                                \
+        }                                                                                                                                                                 \
+        BitfieldType Anvil::operator~(const BitfieldType& in_val1)                                                                                                        \
+        {                                                                                                                                                                 \
+            BitfieldType result = BitfieldType(static_cast<IndividualBitEnumType>(~static_cast<uint32_t>(in_val1.get_vk() )) );                                           \
+                                                                                                                                                                          \
+            return result;                                                                                                                                                \
         }
 
+    /* NOTE: These map 1:1 to VK equivalents */
+    enum class AccelerationStructureType
+    {
+        BOTTOM_LEVEL = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR,
+        TOP_LEVEL    = VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR,
+
+        UNKNOWN = VK_ACCELERATION_STRUCTURE_TYPE_MAX_ENUM_KHR
+    };
+
     /* NOTE: These map 1:1 to VK equivalents */
     enum class AccessFlagBits
     {
@@ -262,6 +277,16 @@ namespace Anvil
         UNIFORM_READ_BIT                   = VK_ACCESS_UNIFORM_READ_BIT,
         VERTEX_ATTRIBUTE_READ_BIT          = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
 
+        /* VK_EXT_conditional_rendering */
+        CONDITIONAL_RENDERING_READ_BIT_EXT = VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT,
+
+        /* VK_KHR_acceleration_structure */
+        ACCELERATION_STRUCTURE_READ_BIT_KHR  = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR,
+        ACCELERATION_STRUCTURE_WRITE_BIT_KHR = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+
+        /* VK_NV_shading_rate_image */
+        SHADING_RATE_IMAGE_READ_BIT_NV = VK_ACCESS_SHADING_RATE_IMAGE_READ_BIT_NV,
+
         /* VK_EXT_transform_feedback */
         TRANSFORM_FEEDBACK_COUNTER_READ_BIT_EXT  = VK_ACCESS_TRANSFORM_FEEDBACK_COUNTER_READ_BIT_EXT,
         TRANSFORM_FEEDBACK_COUNTER_WRITE_BIT_EXT = VK_ACCESS_TRANSFORM_FEEDBACK_COUNTER_WRITE_BIT_EXT,
@@ -406,16 +431,41 @@ namespace Anvil
         UNIFORM_TEXEL_BUFFER_BIT = VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT,
         VERTEX_BUFFER_BIT        = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
 
+        /* VK_EXT_conditional_rendering */
+        CONDITIONAL_RENDERING_BIT_EXT = VK_BUFFER_USAGE_CONDITIONAL_RENDERING_BIT_EXT,
+
         /* VK_EXT_transform_feedback */
         TRANSFORM_FEEDBACK_BUFFER_BIT_EXT         = VK_BUFFER_USAGE_TRANSFORM_FEEDBACK_BUFFER_BIT_EXT,
         TRANSFORM_FEEDBACK_COUNTER_BUFFER_BIT_EXT = VK_BUFFER_USAGE_TRANSFORM_FEEDBACK_COUNTER_BUFFER_BIT_EXT,
 
+        /* VK_KHR_acceleration_structure */
+        ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR = VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR,
+        ACCELERATION_STRUCTURE_STORAGE_BIT_KHR               = VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR,
+
+        /* VK_KHR_buffer_device_address */
+        SHADER_DEVICE_ADDRESS_BIT_KHR = VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT_KHR,
+
         NONE = 0
     };
     typedef Anvil::Bitfield<Anvil::BufferUsageFlagBits, VkBufferUsageFlags> BufferUsageFlags;
 
     INJECT_BITFIELD_HELPER_FUNC_PROTOTYPES(BufferUsageFlags, VkBufferUsageFlags, BufferUsageFlagBits)
 
+    /* NOTE: These map 1:1 to VK equivalents */
+    enum class BuildAccelerationStructureFlagBits
+    {
+        ALLOW_COMPACTION_BIT  = VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR,
+        ALLOW_UPDATE_BIT      = VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR,
+        LOW_MEMORY_BIT        = VK_BUILD_ACCELERATION_STRUCTURE_LOW_MEMORY_BIT_KHR,
+        PREFER_FAST_BUILD_BIT = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_BUILD_BIT_KHR,
+        PREFER_FAST_TRACE_BIT = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR,
+
+        NONE = 0
+    };
+    typedef Anvil::Bitfield<Anvil::BuildAccelerationStructureFlagBits, VkBuildAccelerationStructureFlagsKHR> BuildAccelerationStructureFlags;
+
+    INJECT_BITFIELD_HELPER_FUNC_PROTOTYPES(BuildAccelerationStructureFlags, VkBuildAccelerationStructureFlagsKHR, BuildAccelerationStructureFlagBits)
+
     /* NOTE: These map 1:1 to VK equivalents */
     enum class ChromaLocation
     {
@@ -464,6 +514,18 @@ namespace Anvil
         UNKNOWN = VK_COLOR_SPACE_MAX_ENUM_KHR
     };
 
+    /* NOTE: These map 1:1 to VK equivalents */
+    enum class ConditionalRenderingFlagBits
+    {
+        /* VK_EXT_conditional_rendering */
+        INVERTED_BIT_EXT = VK_CONDITIONAL_RENDERING_INVERTED_BIT_EXT,
+
+        NONE = 0
+    };
+    typedef Anvil::Bitfield<Anvil::ConditionalRenderingFlagBits, VkConditionalRenderingFlagBitsEXT> ConditionalRenderingFlags;
+
+    INJECT_BITFIELD_HELPER_FUNC_PROTOTYPES(ConditionalRenderingFlags, VkConditionalRenderingFlagsEXT, ConditionalRenderingFlagBits)
+
     /* NOTE: These map 1:1 to VK equivalents */
     enum class CommandPoolCreateFlagBits
     {
@@ -593,6 +655,9 @@ namespace Anvil
 
         /* VK_EXT_sample_locations */
         SAMPLE_LOCATIONS_EXT = VK_DYNAMIC_STATE_SAMPLE_LOCATIONS_EXT,
+
+        /* VK_NV_shading_rate_image */
+        VIEWPORT_SHADING_RATE_PALETTE_NV = VK_DYNAMIC_STATE_VIEWPORT_SHADING_RATE_PALETTE_NV,
     };
 
     enum class ExternalFenceHandleTypeFlagBits
@@ -624,6 +689,9 @@ namespace Anvil
         #else
             /* VK_KHR_external_memory_fd */
             OPAQUE_FD_BIT = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT_KHR,
+
+            /* VK_EXT_external_memory_dma_buf */
+            DMA_BUF_BIT_EXT = VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT,
         #endif
 
         /* VK_EXT_external_memory_host */
@@ -836,6 +904,27 @@ namespace Anvil
 
     INJECT_BITFIELD_HELPER_FUNC_PROTOTYPES(DescriptorPoolCreateFlags, VkDescriptorPoolCreateFlags, DescriptorPoolCreateFlagBits)
 
+    /* NOTE: Maps 1:1 to VK equivalents.
+     *
+     * UPDATE_AFTER_BIND_POOL is not exposed, as it is set automatically for layouts which include bindings
+     * created with DESCRIPTOR_BINDING_FLAG_UPDATE_AFTER_BIND_BIT.
+     */
+    enum class DescriptorSetLayoutCreateFlagBits
+    {
+        /* When set, descriptor sets must not be allocated with the layout. Instead, descriptors are pushed
+         * directly into command buffers with record_push_descriptor_set_KHR() or
+         * record_push_descriptor_set_with_template_KHR().
+         *
+         * Requires VK_KHR_push_descriptor.
+         **/
+        PUSH_DESCRIPTOR_BIT_KHR = VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR,
+
+        NONE = 0
+    };
+    typedef Anvil::Bitfield<Anvil::DescriptorSetLayoutCreateFlagBits, VkDescriptorSetLayoutCreateFlags> DescriptorSetLayoutCreateFlags;
+
+    INJECT_BITFIELD_HELPER_FUNC_PROTOTYPES(DescriptorSetLayoutCreateFlags, VkDescriptorSetLayoutCreateFlags, DescriptorSetLayoutCreateFlagBits)
+
     enum class DescriptorSetUpdateMethod
     {
         /* Updates dirty DS bindings using vkUpdateDescriptorSet() which is available on all Vulkan implementations. */
@@ -849,6 +938,14 @@ namespace Anvil
          * Only available on devices supporting VK_KHR_descriptor_update_template extension.
          */
         TEMPLATE,
+
+        /* Lets the descriptor set layout pick the faster of the two methods above. The first few updates of descriptor sets
+         * using the layout alternate between CORE and TEMPLATE methods and are timed. All subsequent updates use
+         * the method which turned out to be faster. Falls back to CORE if VK_KHR_descriptor_update_template is unavailable.
+         *
+         * The decision can be inspected with DescriptorSetLayout::get_update_method_stats().
+         */
+        AUTO,
     };
 
     enum class ExtensionAvailability
@@ -1236,6 +1333,9 @@ namespace Anvil
         /* Requires VK_KHR_swapchain */
         PRESENT_SRC_KHR = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
 
+        /* Requires VK_NV_shading_rate_image */
+        SHADING_RATE_OPTIMAL_NV = VK_IMAGE_LAYOUT_SHADING_RATE_OPTIMAL_NV,
+
         UNKNOWN = VK_IMAGE_LAYOUT_MAX_ENUM,
     };
 
@@ -1252,6 +1352,12 @@ namespace Anvil
         TRANSIENT_ATTACHMENT_BIT     = VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT,
         INPUT_ATTACHMENT_BIT         = VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT,
 
+        /* VK_EXT_host_image_copy */
+        HOST_TRANSFER_BIT_EXT = VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT,
+
+        /* VK_NV_shading_rate_image */
+        SHADING_RATE_IMAGE_BIT_NV = VK_IMAGE_USAGE_SHADING_RATE_IMAGE_BIT_NV,
+
         NONE = 0
     };
     typedef Anvil::Bitfield<Anvil::ImageUsageFlagBits, VkImageUsageFlags> ImageUsageFlags;
@@ -1354,6 +1460,14 @@ namespace Anvil
         /* Core VK 1.1 only */
         PROTECTED_BIT        = 1 << 6,
 
+        /* Preference, not a requirement. Steers the allocation toward device-local memory types, if any of the
+         * compatible ones are. When combined with MAPPABLE_BIT, only host-visible device-local memory types backed
+         * by a heap larger than the legacy 256 MB BAR window (ie. resizable BAR / Smart Access Memory) are preferred.
+         *
+         * Never reported for memory types.
+         */
+        PREFER_DEVICE_LOCAL_BIT = 1 << 7,
+
         NONE = 0
     };
     typedef Anvil::Bitfield<Anvil::MemoryFeatureFlagBits, uint32_t> MemoryFeatureFlags;
@@ -1416,6 +1530,7 @@ namespace Anvil
         /* NOTE: If new entries are added or existing entries are removed, make sure to
          *       update Anvil::ObjectTracker::get_object_type_name().
          */
+        ACCELERATION_STRUCTURE      = VK_OBJECT_TYPE_ACCELERATION_STRUCTURE_KHR,
         BUFFER                      = VK_OBJECT_TYPE_BUFFER,
         BUFFER_VIEW                 = VK_OBJECT_TYPE_BUFFER_VIEW,
         COMMAND_BUFFER              = VK_OBJECT_TYPE_COMMAND_BUFFER,
@@ -1508,6 +1623,19 @@ namespace Anvil
         VERTEX_INPUT_BIT                   = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
         VERTEX_SHADER_BIT                  = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
 
+        /* VK_EXT_conditional_rendering */
+        CONDITIONAL_RENDERING_BIT_EXT      = VK_PIPELINE_STAGE_CONDITIONAL_RENDERING_BIT_EXT,
+
+        /* VK_KHR_acceleration_structure */
+        ACCELERATION_STRUCTURE_BUILD_BIT_KHR = VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+
+        /* VK_NV_mesh_shader */
+        MESH_SHADER_BIT_NV                 = VK_PIPELINE_STAGE_MESH_SHADER_BIT_NV,
+        TASK_SHADER_BIT_NV                 = VK_PIPELINE_STAGE_TASK_SHADER_BIT_NV,
+
+        /* VK_NV_shading_rate_image */
+        SHADING_RATE_IMAGE_BIT_NV          = VK_PIPELINE_STAGE_SHADING_RATE_IMAGE_BIT_NV,
+
         /* VK_EXT_transform_feedback */
         TRANSFORM_FEEDBACK_BIT_EXT         = VK_PIPELINE_STAGE_TRANSFORM_FEEDBACK_BIT_EXT,
 
@@ -1540,6 +1668,10 @@ namespace Anvil
         /* VK_KHR_device_group */
         DISPATCH_BASE_BIT = VK_PIPELINE_CREATE_DISPATCH_BASE_KHR,
 
+        /* VK_KHR_pipeline_executable_properties */
+        CAPTURE_INTERNAL_REPRESENTATIONS_BIT_KHR = VK_PIPELINE_CREATE_CAPTURE_INTERNAL_REPRESENTATIONS_BIT_KHR,
+        CAPTURE_STATISTICS_BIT_KHR               = VK_PIPELINE_CREATE_CAPTURE_STATISTICS_BIT_KHR,
+
         NONE = 0
     };
     typedef Anvil::Bitfield<Anvil::PipelineCreateFlagBits, VkPipelineCreateFlagBits> PipelineCreateFlags;
@@ -1720,6 +1852,20 @@ namespace Anvil
         UNKNOWN = VK_RASTERIZATION_ORDER_MAX_ENUM_AMD
     };
 
+    /* NOTE: These map 1:1 to VK equivalents */
+    enum class RenderingFlagBits
+    {
+        /* VK_KHR_dynamic_rendering */
+        CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR,
+        RESUMING_BIT_KHR                           = VK_RENDERING_RESUMING_BIT_KHR,
+        SUSPENDING_BIT_KHR                         = VK_RENDERING_SUSPENDING_BIT_KHR,
+
+        NONE = 0
+    };
+    typedef Anvil::Bitfield<Anvil::RenderingFlagBits, VkRenderingFlagBitsKHR> RenderingFlags;
+
+    INJECT_BITFIELD_HELPER_FUNC_PROTOTYPES(RenderingFlags, VkRenderingFlagsKHR, RenderingFlagBits)
+
     /* NOTE: These map 1:1 to VK equivalents */
     enum class ResolveModeFlagBits
     {
@@ -1812,6 +1958,17 @@ namespace Anvil
         UNKNOWN = VK_SAMPLER_YCBCR_MODEL_CONVERSION_MAX_ENUM
     };
 
+    /* NOTE: These map 1:1 to VK equivalents */
+    enum class SemaphoreType
+    {
+        BINARY   = VK_SEMAPHORE_TYPE_BINARY_KHR,
+
+        /* NOTE: Requires VK_KHR_timeline_semaphore */
+        TIMELINE = VK_SEMAPHORE_TYPE_TIMELINE_KHR,
+
+        UNKNOWN = VK_SEMAPHORE_TYPE_MAX_ENUM_KHR
+    };
+
     /* Specifies one of the compute / rendering pipeline stages. */
     enum class ShaderStage
     {
@@ -1820,6 +1977,13 @@ namespace Anvil
         COMPUTE = FIRST,
         FRAGMENT,
         GEOMETRY,
+
+        /* NOTE: Requires VK_NV_mesh_shader */
+        MESH,
+
+        /* NOTE: Requires VK_NV_mesh_shader */
+        TASK,
+
         TESSELLATION_CONTROL,
         TESSELLATION_EVALUATION,
         VERTEX,
@@ -1838,6 +2002,10 @@ namespace Anvil
         TESSELLATION_EVALUATION_BIT = VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT,
         VERTEX_BIT                  = VK_SHADER_STAGE_VERTEX_BIT,
 
+        /* VK_NV_mesh_shader */
+        MESH_BIT_NV                 = VK_SHADER_STAGE_MESH_BIT_NV,
+        TASK_BIT_NV                 = VK_SHADER_STAGE_TASK_BIT_NV,
+
         ALL          = VK_SHADER_STAGE_ALL,
         ALL_GRAPHICS = VK_SHADER_STAGE_ALL_GRAPHICS,
 
@@ -1859,6 +2027,25 @@ namespace Anvil
         UNKNOWN = COUNT
     };
 
+    /* NOTE: These map 1:1 to VK equivalents */
+    enum class ShadingRatePaletteEntryNV
+    {
+        NO_INVOCATIONS                 = VK_SHADING_RATE_PALETTE_ENTRY_NO_INVOCATIONS_NV,
+        _16_INVOCATIONS_PER_PIXEL      = VK_SHADING_RATE_PALETTE_ENTRY_16_INVOCATIONS_PER_PIXEL_NV,
+        _8_INVOCATIONS_PER_PIXEL       = VK_SHADING_RATE_PALETTE_ENTRY_8_INVOCATIONS_PER_PIXEL_NV,
+        _4_INVOCATIONS_PER_PIXEL       = VK_SHADING_RATE_PALETTE_ENTRY_4_INVOCATIONS_PER_PIXEL_NV,
+        _2_INVOCATIONS_PER_PIXEL       = VK_SHADING_RATE_PALETTE_ENTRY_2_INVOCATIONS_PER_PIXEL_NV,
+        _1_INVOCATION_PER_PIXEL        = VK_SHADING_RATE_PALETTE_ENTRY_1_INVOCATION_PER_PIXEL_NV,
+        _1_INVOCATION_PER_2X1_PIXELS   = VK_SHADING_RATE_PALETTE_ENTRY_1_INVOCATION_PER_2X1_PIXELS_NV,
+        _1_INVOCATION_PER_1X2_PIXELS   = VK_SHADING_RATE_PALETTE_ENTRY_1_INVOCATION_PER_1X2_PIXELS_NV,
+        _1_INVOCATION_PER_2X2_PIXELS   = VK_SHADING_RATE_PALETTE_ENTRY_1_INVOCATION_PER_2X2_PIXELS_NV,
+        _1_INVOCATION_PER_4X2_PIXELS   = VK_SHADING_RATE_PALETTE_ENTRY_1_INVOCATION_PER_4X2_PIXELS_NV,
+        _1_INVOCATION_PER_2X4_PIXELS   = VK_SHADING_RATE_PALETTE_ENTRY_1_INVOCATION_PER_2X4_PIXELS_NV,
+        _1_INVOCATION_PER_4X4_PIXELS   = VK_SHADING_RATE_PALETTE_ENTRY_1_INVOCATION_PER_4X4_PIXELS_NV,
+
+        UNKNOWN = VK_SHADING_RATE_PALETTE_ENTRY_MAX_ENUM_NV
+    };
+
     /* NOTE: These map 1:1 to VK equivalents */
     enum class SharingMode
     {
@@ -1993,10 +2180,44 @@ namespace Anvil
     enum class SwapchainOperationErrorCode
     {
         DEVICE_LOST  = VK_ERROR_DEVICE_LOST,
+        NOT_READY    = VK_NOT_READY,
         OUT_OF_DATE  = VK_ERROR_OUT_OF_DATE_KHR,
         SUBOPTIMAL   = VK_SUBOPTIMAL_KHR,
         SUCCESS      = VK_SUCCESS,
-        SURFACE_LOST = VK_ERROR_SURFACE_LOST_KHR
+        SURFACE_LOST = VK_ERROR_SURFACE_LOST_KHR,
+        TIMEOUT      = VK_TIMEOUT
+    };
+
+    /** Enumerates policies which SwapchainCreateInfo::create_for_present_policy() can use to pick a present mode,
+     *  swapchain image count and the number of frames apps should keep in flight. */
+    enum class SwapchainPresentPolicy
+    {
+        /* Minimizes input-to-photon latency. Prefers MAILBOX, then IMMEDIATE, and keeps a single frame in flight. */
+        LOW_LATENCY,
+
+        /* Maximizes the number of frames rendered. Prefers IMMEDIATE, then MAILBOX, and keeps as many frames
+         * in flight as the swapchain allows. */
+        MAX_THROUGHPUT,
+
+        /* Minimizes GPU & CPU load. Uses FIFO with double buffering, so that the app is throttled to the display's
+         * refresh rate. */
+        POWER_SAVING,
+
+        /* Present mode & image count have been specified explicitly by the app. */
+        UNKNOWN
+    };
+
+    /* NOTE: These map 1:1 to VK equivalents */
+    enum class SystemAllocationScope
+    {
+        COMMAND  = VK_SYSTEM_ALLOCATION_SCOPE_COMMAND,
+        OBJECT   = VK_SYSTEM_ALLOCATION_SCOPE_OBJECT,
+        CACHE    = VK_SYSTEM_ALLOCATION_SCOPE_CACHE,
+        DEVICE   = VK_SYSTEM_ALLOCATION_SCOPE_DEVICE,
+        INSTANCE = VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE,
+
+        COUNT,
+        UNKNOWN = COUNT
     };
 
     /* NOTE: Enums map 1:1 to their VK equivalents */
@@ -2008,6 +2229,18 @@ namespace Anvil
         UNKNOWN = VK_TESSELLATION_DOMAIN_ORIGIN_MAX_ENUM
     };
 
+    /* NOTE: These map 1:1 to VK equivalents */
+    enum class TimeDomainEXT
+    {
+        /* VK_EXT_calibrated_timestamps */
+        CLOCK_MONOTONIC_EXT           = VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT,
+        CLOCK_MONOTONIC_RAW_EXT       = VK_TIME_DOMAIN_CLOCK_MONOTONIC_RAW_EXT,
+        DEVICE_EXT                    = VK_TIME_DOMAIN_DEVICE_EXT,
+        QUERY_PERFORMANCE_COUNTER_EXT = VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_EXT,
+
+        UNKNOWN = VK_TIME_DOMAIN_MAX_ENUM_EXT
+    };
+
     enum class VertexInputRate
     {
         INSTANCE = VK_VERTEX_INPUT_RATE_INSTANCE,
@@ -2015,6 +2248,23 @@ namespace Anvil
 
         UNKNOWN = VK_VERTEX_INPUT_RATE_MAX_ENUM
     };
+
+    /* Determines how memory of a custom VMA memory pool is handed out to objects. */
+    enum class VMAPoolAlgorithm
+    {
+        /* Regions are managed by VMA's general-purpose allocator. Objects may be released in any order. */
+        DEFAULT,
+
+        /* Regions are handed out in order from the end of the last region of a block, so allocations take O(1) time
+         * and do not fragment the pool. A block is reused from its start once all objects placed in it have been
+         * released. Suited for per-frame allocations. */
+        LINEAR,
+
+        /* The pool uses a single block as a circular buffer. Allocations take O(1) time. A region is reclaimed once
+         * it and all regions allocated before it have been released, so objects should be released in allocation
+         * order. Suited for streaming. */
+        RING_BUFFER
+    };
 }; /* namespace Anvil */
 
 #endif /* TYPES_ENUMS_H */
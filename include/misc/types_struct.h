@@ -418,6 +418,38 @@ namespace Anvil
         bool operator==(const AMDShaderCoreProperties& in_props) const;
     } AMDShaderCoreProperties;
 
+    /** Summarizes a single BackgroundWorkScheduler::run() call, and the backlog left after it. */
+    typedef struct BackgroundWorkReport
+    {
+        /* Set to true if the time budget ran out while there were still tasks left to step. */
+        bool budget_exhausted;
+
+        /* Number of steps executed during the call, and the number of tasks which finished. */
+        uint32_t n_steps_executed;
+        uint32_t n_tasks_completed;
+
+        /* Backlog: number of tasks left pending after the call, how many of them did not get a single step
+         * during the call, and the largest number of consecutive run() calls any pending task has gone
+         * without being stepped. */
+        uint32_t n_pending_tasks;
+        uint32_t n_tasks_deferred;
+        uint32_t n_max_runs_deferred;
+
+        /* Time spent executing tasks, in nanoseconds. */
+        uint64_t time_spent_nsec;
+
+        BackgroundWorkReport()
+        {
+            budget_exhausted    = false;
+            n_max_runs_deferred = 0;
+            n_pending_tasks     = 0;
+            n_steps_executed    = 0;
+            n_tasks_completed   = 0;
+            n_tasks_deferred    = 0;
+            time_spent_nsec     = 0;
+        }
+    } BackgroundWorkReport;
+
     /** Describes a buffer memory barrier. */
     typedef struct BufferBarrier
     {
@@ -507,7 +539,7 @@ namespace Anvil
         BufferPropertiesQuery& operator=(const BufferPropertiesQuery& in_query) = delete;
     } BufferPropertiesQuery;
 
-    /* Used by Buffer::set_nonsparse_memory_multi(). Requires VK_KHR_device_group support. */
+    /* Used by Buffer::set_nonsparse_memory_multi(). */
     typedef struct BufferMemoryBindingUpdate
     {
         Anvil::Buffer*      buffer_ptr;
@@ -552,6 +584,64 @@ namespace Anvil
 
     } CommandBufferMGPUSubmission;
 
+    /** Usage statistics of a single command pool. Please see CommandPool::on_frame_end() for more details. */
+    typedef struct CommandPoolStats
+    {
+        /* Vulkan index of the queue family the pool has been created for. */
+        uint32_t queue_family_index;
+
+        /* Number of command buffers allocated from the pool which have not been released yet. */
+        uint32_t n_live_command_buffers;
+
+        /* Number of command buffers recorded during the last completed frame, the peak over the
+         * trim policy window, and the peak since the pool was last trimmed (or created). */
+        uint32_t n_recordings_last_frame;
+        uint32_t n_recordings_peak_recent;
+        uint32_t n_recordings_peak_since_trim;
+
+        /* Number of frames completed so far, and how many times the pool has been trimmed. */
+        uint32_t n_frames;
+        uint32_t n_trims;
+
+        CommandPoolStats()
+        {
+            n_frames                     = 0;
+            n_live_command_buffers       = 0;
+            n_recordings_last_frame      = 0;
+            n_recordings_peak_recent     = 0;
+            n_recordings_peak_since_trim = 0;
+            n_trims                      = 0;
+            queue_family_index           = UINT32_MAX;
+        }
+    } CommandPoolStats;
+
+    /** Descriptor set update method statistics of a single descriptor set layout. Please see DescriptorSetUpdateMethod::AUTO
+     *  for more details.
+     */
+    typedef struct DescriptorSetUpdateMethodStats
+    {
+        /* Method used by AUTO updates from now on. AUTO if the layout is still measuring both methods. */
+        Anvil::DescriptorSetUpdateMethod selected_method;
+
+        /* Number of AUTO updates which have been timed for each method so far. */
+        uint32_t n_core_updates;
+        uint32_t n_template_updates;
+
+        /* Total time spent in timed updates, in nanoseconds. The first update of each method is not included, as it
+         * accounts for one-off costs like template creation. */
+        uint64_t core_update_time_nsec;
+        uint64_t template_update_time_nsec;
+
+        DescriptorSetUpdateMethodStats()
+        {
+            core_update_time_nsec     = 0;
+            n_core_updates            = 0;
+            n_template_updates        = 0;
+            selected_method           = Anvil::DescriptorSetUpdateMethod::AUTO;
+            template_update_time_nsec = 0;
+        }
+    } DescriptorSetUpdateMethodStats;
+
     /* NOTE: Matches VK equivalent */
     struct ComponentMapping
     {
@@ -705,6 +795,19 @@ namespace Anvil
         bool operator==(const EXTConservativeRasterizationProperties& in_properties) const;
     } EXTConservativeRasterizationProperties;
 
+    typedef struct EXTConditionalRenderingFeatures
+    {
+        bool conditional_rendering;
+        bool inherited_conditional_rendering;
+
+        EXTConditionalRenderingFeatures();
+        EXTConditionalRenderingFeatures(const VkPhysicalDeviceConditionalRenderingFeaturesEXT& in_features);
+
+        VkPhysicalDeviceConditionalRenderingFeaturesEXT get_vk_physical_device_conditional_rendering_features() const;
+
+        bool operator==(const EXTConditionalRenderingFeatures& in_features) const;
+    } EXTConditionalRenderingFeatures;
+
     typedef struct EXTDepthClipEnableFeatures
     {
         bool depth_clip_enable;
@@ -748,6 +851,30 @@ namespace Anvil
         bool operator==(const EXTDescriptorIndexingFeatures& in_features) const;
     } EXTDescriptorIndexingFeatures;
 
+    typedef struct EXTHostImageCopyFeatures
+    {
+        bool host_image_copy;
+
+        EXTHostImageCopyFeatures();
+        EXTHostImageCopyFeatures(const VkPhysicalDeviceHostImageCopyFeaturesEXT& in_features);
+
+        VkPhysicalDeviceHostImageCopyFeaturesEXT get_vk_physical_device_host_image_copy_features() const;
+
+        bool operator==(const EXTHostImageCopyFeatures& in_features) const;
+    } EXTHostImageCopyFeatures;
+
+    typedef struct EXTHostQueryResetFeatures
+    {
+        bool host_query_reset;
+
+        EXTHostQueryResetFeatures();
+        EXTHostQueryResetFeatures(const VkPhysicalDeviceHostQueryResetFeaturesEXT& in_features);
+
+        VkPhysicalDeviceHostQueryResetFeaturesEXT get_vk_physical_device_host_query_reset_features() const;
+
+        bool operator==(const EXTHostQueryResetFeatures& in_features) const;
+    } EXTHostQueryResetFeatures;
+
     typedef struct EXTDescriptorIndexingProperties
     {
         uint32_t max_descriptor_set_update_after_bind_input_attachments;
@@ -825,6 +952,21 @@ namespace Anvil
         bool operator==(const EXTVertexAttributeDivisorProperties& in_props) const;
     } EXTVertexAttributeDivisorProperties;
 
+    /** Describes how much of a descriptor pool has been requested. Please see DescriptorPoolSizingProfile. */
+    typedef struct DescriptorPoolUsage
+    {
+        /* Number of descriptors of each type. */
+        std::map<Anvil::DescriptorType, uint32_t> n_descriptors_per_type;
+
+        /* Number of descriptor sets. */
+        uint32_t n_sets;
+
+        DescriptorPoolUsage()
+        {
+            n_sets = 0;
+        }
+    } DescriptorPoolUsage;
+
     typedef struct DescriptorSetAllocation
     {
         /* Descriptor set layout to use for the allocation request */
@@ -884,6 +1026,156 @@ namespace Anvil
         bool operator< (const DescriptorUpdateTemplateEntry& in_entry) const;
     } DescriptorUpdateTemplateEntry;
 
+    /* Holds device-level core Vulkan entry-points, as retrieved with vkGetDeviceProcAddr() for a specific VkDevice.
+     *
+     * Calling through these func ptrs bypasses the loader's dispatch trampoline. VK 1.1 entry-points are only
+     * set if the device supports VK 1.1.
+     */
+    typedef struct DeviceDispatchTable
+    {
+        /* VK 1.0 core */
+        PFN_vkDestroyDevice                     vkDestroyDevice;
+        PFN_vkGetDeviceQueue                    vkGetDeviceQueue;
+        PFN_vkQueueSubmit                       vkQueueSubmit;
+        PFN_vkQueueWaitIdle                     vkQueueWaitIdle;
+        PFN_vkDeviceWaitIdle                    vkDeviceWaitIdle;
+        PFN_vkAllocateMemory                    vkAllocateMemory;
+        PFN_vkFreeMemory                        vkFreeMemory;
+        PFN_vkMapMemory                         vkMapMemory;
+        PFN_vkUnmapMemory                       vkUnmapMemory;
+        PFN_vkFlushMappedMemoryRanges           vkFlushMappedMemoryRanges;
+        PFN_vkInvalidateMappedMemoryRanges      vkInvalidateMappedMemoryRanges;
+        PFN_vkGetDeviceMemoryCommitment         vkGetDeviceMemoryCommitment;
+        PFN_vkBindBufferMemory                  vkBindBufferMemory;
+        PFN_vkBindImageMemory                   vkBindImageMemory;
+        PFN_vkGetBufferMemoryRequirements       vkGetBufferMemoryRequirements;
+        PFN_vkGetImageMemoryRequirements        vkGetImageMemoryRequirements;
+        PFN_vkGetImageSparseMemoryRequirements  vkGetImageSparseMemoryRequirements;
+        PFN_vkQueueBindSparse                   vkQueueBindSparse;
+        PFN_vkCreateFence                       vkCreateFence;
+        PFN_vkDestroyFence                      vkDestroyFence;
+        PFN_vkResetFences                       vkResetFences;
+        PFN_vkGetFenceStatus                    vkGetFenceStatus;
+        PFN_vkWaitForFences                     vkWaitForFences;
+        PFN_vkCreateSemaphore                   vkCreateSemaphore;
+        PFN_vkDestroySemaphore                  vkDestroySemaphore;
+        PFN_vkCreateEvent                       vkCreateEvent;
+        PFN_vkDestroyEvent                      vkDestroyEvent;
+        PFN_vkGetEventStatus                    vkGetEventStatus;
+        PFN_vkSetEvent                          vkSetEvent;
+        PFN_vkResetEvent                        vkResetEvent;
+        PFN_vkCreateQueryPool                   vkCreateQueryPool;
+        PFN_vkDestroyQueryPool                  vkDestroyQueryPool;
+        PFN_vkGetQueryPoolResults               vkGetQueryPoolResults;
+        PFN_vkCreateBuffer                      vkCreateBuffer;
+        PFN_vkDestroyBuffer                     vkDestroyBuffer;
+        PFN_vkCreateBufferView                  vkCreateBufferView;
+        PFN_vkDestroyBufferView                 vkDestroyBufferView;
+        PFN_vkCreateImage                       vkCreateImage;
+        PFN_vkDestroyImage                      vkDestroyImage;
+        PFN_vkGetImageSubresourceLayout         vkGetImageSubresourceLayout;
+        PFN_vkCreateImageView                   vkCreateImageView;
+        PFN_vkDestroyImageView                  vkDestroyImageView;
+        PFN_vkCreateShaderModule                vkCreateShaderModule;
+        PFN_vkDestroyShaderModule               vkDestroyShaderModule;
+        PFN_vkCreatePipelineCache               vkCreatePipelineCache;
+        PFN_vkDestroyPipelineCache              vkDestroyPipelineCache;
+        PFN_vkGetPipelineCacheData              vkGetPipelineCacheData;
+        PFN_vkMergePipelineCaches               vkMergePipelineCaches;
+        PFN_vkCreateGraphicsPipelines           vkCreateGraphicsPipelines;
+        PFN_vkCreateComputePipelines            vkCreateComputePipelines;
+        PFN_vkDestroyPipeline                   vkDestroyPipeline;
+        PFN_vkCreatePipelineLayout              vkCreatePipelineLayout;
+        PFN_vkDestroyPipelineLayout             vkDestroyPipelineLayout;
+        PFN_vkCreateSampler                     vkCreateSampler;
+        PFN_vkDestroySampler                    vkDestroySampler;
+        PFN_vkCreateDescriptorSetLayout         vkCreateDescriptorSetLayout;
+        PFN_vkDestroyDescriptorSetLayout        vkDestroyDescriptorSetLayout;
+        PFN_vkCreateDescriptorPool              vkCreateDescriptorPool;
+        PFN_vkDestroyDescriptorPool             vkDestroyDescriptorPool;
+        PFN_vkResetDescriptorPool               vkResetDescriptorPool;
+        PFN_vkAllocateDescriptorSets            vkAllocateDescriptorSets;
+        PFN_vkFreeDescriptorSets                vkFreeDescriptorSets;
+        PFN_vkUpdateDescriptorSets              vkUpdateDescriptorSets;
+        PFN_vkCreateFramebuffer                 vkCreateFramebuffer;
+        PFN_vkDestroyFramebuffer                vkDestroyFramebuffer;
+        PFN_vkCreateRenderPass                  vkCreateRenderPass;
+        PFN_vkDestroyRenderPass                 vkDestroyRenderPass;
+        PFN_vkGetRenderAreaGranularity          vkGetRenderAreaGranularity;
+        PFN_vkCreateCommandPool                 vkCreateCommandPool;
+        PFN_vkDestroyCommandPool                vkDestroyCommandPool;
+        PFN_vkResetCommandPool                  vkResetCommandPool;
+        PFN_vkAllocateCommandBuffers            vkAllocateCommandBuffers;
+        PFN_vkFreeCommandBuffers                vkFreeCommandBuffers;
+        PFN_vkBeginCommandBuffer                vkBeginCommandBuffer;
+        PFN_vkEndCommandBuffer                  vkEndCommandBuffer;
+        PFN_vkResetCommandBuffer                vkResetCommandBuffer;
+        PFN_vkCmdBindPipeline                   vkCmdBindPipeline;
+        PFN_vkCmdSetViewport                    vkCmdSetViewport;
+        PFN_vkCmdSetScissor                     vkCmdSetScissor;
+        PFN_vkCmdSetLineWidth                   vkCmdSetLineWidth;
+        PFN_vkCmdSetDepthBias                   vkCmdSetDepthBias;
+        PFN_vkCmdSetBlendConstants              vkCmdSetBlendConstants;
+        PFN_vkCmdSetDepthBounds                 vkCmdSetDepthBounds;
+        PFN_vkCmdSetStencilCompareMask          vkCmdSetStencilCompareMask;
+        PFN_vkCmdSetStencilWriteMask            vkCmdSetStencilWriteMask;
+        PFN_vkCmdSetStencilReference            vkCmdSetStencilReference;
+        PFN_vkCmdBindDescriptorSets             vkCmdBindDescriptorSets;
+        PFN_vkCmdBindIndexBuffer                vkCmdBindIndexBuffer;
+        PFN_vkCmdBindVertexBuffers              vkCmdBindVertexBuffers;
+        PFN_vkCmdDraw                           vkCmdDraw;
+        PFN_vkCmdDrawIndexed                    vkCmdDrawIndexed;
+        PFN_vkCmdDrawIndirect                   vkCmdDrawIndirect;
+        PFN_vkCmdDrawIndexedIndirect            vkCmdDrawIndexedIndirect;
+        PFN_vkCmdDispatch                       vkCmdDispatch;
+        PFN_vkCmdDispatchIndirect               vkCmdDispatchIndirect;
+        PFN_vkCmdCopyBuffer                     vkCmdCopyBuffer;
+        PFN_vkCmdCopyImage                      vkCmdCopyImage;
+        PFN_vkCmdBlitImage                      vkCmdBlitImage;
+        PFN_vkCmdCopyBufferToImage              vkCmdCopyBufferToImage;
+        PFN_vkCmdCopyImageToBuffer              vkCmdCopyImageToBuffer;
+        PFN_vkCmdUpdateBuffer                   vkCmdUpdateBuffer;
+        PFN_vkCmdFillBuffer                     vkCmdFillBuffer;
+        PFN_vkCmdClearColorImage                vkCmdClearColorImage;
+        PFN_vkCmdClearDepthStencilImage         vkCmdClearDepthStencilImage;
+        PFN_vkCmdClearAttachments               vkCmdClearAttachments;
+        PFN_vkCmdResolveImage                   vkCmdResolveImage;
+        PFN_vkCmdSetEvent                       vkCmdSetEvent;
+        PFN_vkCmdResetEvent                     vkCmdResetEvent;
+        PFN_vkCmdWaitEvents                     vkCmdWaitEvents;
+        PFN_vkCmdPipelineBarrier                vkCmdPipelineBarrier;
+        PFN_vkCmdBeginQuery                     vkCmdBeginQuery;
+        PFN_vkCmdEndQuery                       vkCmdEndQuery;
+        PFN_vkCmdResetQueryPool                 vkCmdResetQueryPool;
+        PFN_vkCmdWriteTimestamp                 vkCmdWriteTimestamp;
+        PFN_vkCmdCopyQueryPoolResults           vkCmdCopyQueryPoolResults;
+        PFN_vkCmdPushConstants                  vkCmdPushConstants;
+        PFN_vkCmdBeginRenderPass                vkCmdBeginRenderPass;
+        PFN_vkCmdNextSubpass                    vkCmdNextSubpass;
+        PFN_vkCmdEndRenderPass                  vkCmdEndRenderPass;
+        PFN_vkCmdExecuteCommands                vkCmdExecuteCommands;
+
+        /* VK 1.1 core */
+        PFN_vkBindBufferMemory2                 vkBindBufferMemory2;
+        PFN_vkBindImageMemory2                  vkBindImageMemory2;
+        PFN_vkCmdDispatchBase                   vkCmdDispatchBase;
+        PFN_vkCmdSetDeviceMask                  vkCmdSetDeviceMask;
+        PFN_vkCreateDescriptorUpdateTemplate    vkCreateDescriptorUpdateTemplate;
+        PFN_vkCreateSamplerYcbcrConversion      vkCreateSamplerYcbcrConversion;
+        PFN_vkDestroyDescriptorUpdateTemplate   vkDestroyDescriptorUpdateTemplate;
+        PFN_vkDestroySamplerYcbcrConversion     vkDestroySamplerYcbcrConversion;
+        PFN_vkGetBufferMemoryRequirements2      vkGetBufferMemoryRequirements2;
+        PFN_vkGetDescriptorSetLayoutSupport     vkGetDescriptorSetLayoutSupport;
+        PFN_vkGetDeviceGroupPeerMemoryFeatures  vkGetDeviceGroupPeerMemoryFeatures;
+        PFN_vkGetDeviceQueue2                   vkGetDeviceQueue2;
+        PFN_vkGetImageMemoryRequirements2       vkGetImageMemoryRequirements2;
+        PFN_vkGetImageSparseMemoryRequirements2 vkGetImageSparseMemoryRequirements2;
+        PFN_vkTrimCommandPool                   vkTrimCommandPool;
+        PFN_vkUpdateDescriptorSetWithTemplate   vkUpdateDescriptorSetWithTemplate;
+
+        DeviceDispatchTable();
+    } DeviceDispatchTable;
+
     typedef struct ExtensionAMDBufferMarkerEntrypoints
     {
         PFN_vkCmdWriteBufferMarkerAMD vkCmdWriteBufferMarkerAMD;
@@ -906,6 +1198,22 @@ namespace Anvil
         ExtensionAMDShaderInfoEntrypoints();
     } ExtensionAMDShaderInfoEntrypoints;
 
+    typedef struct ExtensionEXTCalibratedTimestampsEntrypoints
+    {
+        PFN_vkGetCalibratedTimestampsEXT                   vkGetCalibratedTimestampsEXT;
+        PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT vkGetPhysicalDeviceCalibrateableTimeDomainsEXT;
+
+        ExtensionEXTCalibratedTimestampsEntrypoints();
+    } ExtensionEXTCalibratedTimestampsEntrypoints;
+
+    typedef struct ExtensionEXTConditionalRenderingEntrypoints
+    {
+        PFN_vkCmdBeginConditionalRenderingEXT vkCmdBeginConditionalRenderingEXT;
+        PFN_vkCmdEndConditionalRenderingEXT   vkCmdEndConditionalRenderingEXT;
+
+        ExtensionEXTConditionalRenderingEntrypoints();
+    } ExtensionEXTConditionalRenderingEntrypoints;
+
     typedef struct ExtensionEXTDebugMarkerEntrypoints
     {
         PFN_vkCmdDebugMarkerBeginEXT      vkCmdDebugMarkerBeginEXT;
@@ -957,6 +1265,28 @@ namespace Anvil
         ExtensionEXTHdrMetadataEntrypoints();
     } ExtensionEXTHdrMetadataEntrypoints;
 
+    typedef struct ExtensionEXTHostImageCopyEntrypoints
+    {
+        PFN_vkCopyMemoryToImageEXT     vkCopyMemoryToImageEXT;
+        PFN_vkTransitionImageLayoutEXT vkTransitionImageLayoutEXT;
+
+        ExtensionEXTHostImageCopyEntrypoints();
+    } ExtensionEXTHostImageCopyEntrypoints;
+
+    typedef struct ExtensionEXTHostQueryResetEntrypoints
+    {
+        PFN_vkResetQueryPoolEXT vkResetQueryPoolEXT;
+
+        ExtensionEXTHostQueryResetEntrypoints();
+    } ExtensionEXTHostQueryResetEntrypoints;
+
+    typedef struct ExtensionEXTPageableDeviceLocalMemoryEntrypoints
+    {
+        PFN_vkSetDeviceMemoryPriorityEXT vkSetDeviceMemoryPriorityEXT;
+
+        ExtensionEXTPageableDeviceLocalMemoryEntrypoints();
+    } ExtensionEXTPageableDeviceLocalMemoryEntrypoints;
+
     typedef struct ExtensionEXTSampleLocationsEntrypoints
     {
         PFN_vkCmdSetSampleLocationsEXT                  vkCmdSetSampleLocationsEXT;
@@ -977,6 +1307,14 @@ namespace Anvil
         ExtensionEXTTransformFeedbackEntrypoints();
     } ExtensionEXTTransformFeedbackEntrypoints;
 
+    typedef struct ExtensionGOOGLEDisplayTimingEntrypoints
+    {
+        PFN_vkGetPastPresentationTimingGOOGLE vkGetPastPresentationTimingGOOGLE;
+        PFN_vkGetRefreshCycleDurationGOOGLE   vkGetRefreshCycleDurationGOOGLE;
+
+        ExtensionGOOGLEDisplayTimingEntrypoints();
+    } ExtensionGOOGLEDisplayTimingEntrypoints;
+
     typedef struct ExtensionKHRCreateRenderpass2Entrypoints
     {
         PFN_vkCreateRenderPass2KHR   vkCreateRenderPass2KHR;
@@ -1008,6 +1346,27 @@ namespace Anvil
         ExtensionKHRDrawIndirectCountEntrypoints();
     } ExtensionKHRDrawIndirectCountEntrypoints;
 
+    typedef struct ExtensionKHRDynamicRenderingEntrypoints
+    {
+        PFN_vkCmdBeginRenderingKHR vkCmdBeginRenderingKHR;
+        PFN_vkCmdEndRenderingKHR   vkCmdEndRenderingKHR;
+
+        ExtensionKHRDynamicRenderingEntrypoints();
+    } ExtensionKHRDynamicRenderingEntrypoints;
+
+    typedef struct ExtensionKHRAccelerationStructureEntrypoints
+    {
+        PFN_vkCmdBuildAccelerationStructuresKHR           vkCmdBuildAccelerationStructuresKHR;
+        PFN_vkCmdCopyAccelerationStructureKHR             vkCmdCopyAccelerationStructureKHR;
+        PFN_vkCmdWriteAccelerationStructuresPropertiesKHR vkCmdWriteAccelerationStructuresPropertiesKHR;
+        PFN_vkCreateAccelerationStructureKHR              vkCreateAccelerationStructureKHR;
+        PFN_vkDestroyAccelerationStructureKHR             vkDestroyAccelerationStructureKHR;
+        PFN_vkGetAccelerationStructureBuildSizesKHR       vkGetAccelerationStructureBuildSizesKHR;
+        PFN_vkGetAccelerationStructureDeviceAddressKHR    vkGetAccelerationStructureDeviceAddressKHR;
+
+        ExtensionKHRAccelerationStructureEntrypoints();
+    } ExtensionKHRAccelerationStructureEntrypoints;
+
     typedef struct ExtensionKHRBindMemory2Entrypoints
     {
         PFN_vkBindBufferMemory2KHR vkBindBufferMemory2KHR;
@@ -1016,6 +1375,13 @@ namespace Anvil
         ExtensionKHRBindMemory2Entrypoints();
     } ExtensionKHRBindMemory2Entrypoints;
 
+    typedef struct ExtensionKHRBufferDeviceAddressEntrypoints
+    {
+        PFN_vkGetBufferDeviceAddressKHR vkGetBufferDeviceAddressKHR;
+
+        ExtensionKHRBufferDeviceAddressEntrypoints();
+    } ExtensionKHRBufferDeviceAddressEntrypoints;
+
     typedef struct ExtensionKHRDescriptorUpdateTemplateEntrypoints
     {
         PFN_vkCreateDescriptorUpdateTemplateKHR  vkCreateDescriptorUpdateTemplateKHR;
@@ -1132,6 +1498,22 @@ namespace Anvil
         ExtensionKHRMaintenance3Entrypoints();
     } ExtensionKHRMaintenance3Entrypoints;
 
+    typedef struct ExtensionKHRPipelineExecutablePropertiesEntrypoints
+    {
+        PFN_vkGetPipelineExecutablePropertiesKHR vkGetPipelineExecutablePropertiesKHR;
+        PFN_vkGetPipelineExecutableStatisticsKHR vkGetPipelineExecutableStatisticsKHR;
+
+        ExtensionKHRPipelineExecutablePropertiesEntrypoints();
+    } ExtensionKHRPipelineExecutablePropertiesEntrypoints;
+
+    typedef struct ExtensionKHRPushDescriptorEntrypoints
+    {
+        PFN_vkCmdPushDescriptorSetKHR             vkCmdPushDescriptorSetKHR;
+        PFN_vkCmdPushDescriptorSetWithTemplateKHR vkCmdPushDescriptorSetWithTemplateKHR;
+
+        ExtensionKHRPushDescriptorEntrypoints();
+    } ExtensionKHRPushDescriptorEntrypoints;
+
     typedef struct ExtensionKHRSamplerYCbCrConversionEntrypoints
     {
         PFN_vkCreateSamplerYcbcrConversionKHR  vkCreateSamplerYcbcrConversionKHR;
@@ -1162,6 +1544,15 @@ namespace Anvil
         ExtensionKHRSwapchainEntrypoints();
     } ExtensionKHRSwapchainEntrypoints;
 
+    typedef struct ExtensionKHRTimelineSemaphoreEntrypoints
+    {
+        PFN_vkGetSemaphoreCounterValueKHR vkGetSemaphoreCounterValueKHR;
+        PFN_vkSignalSemaphoreKHR          vkSignalSemaphoreKHR;
+        PFN_vkWaitSemaphoresKHR           vkWaitSemaphoresKHR;
+
+        ExtensionKHRTimelineSemaphoreEntrypoints();
+    } ExtensionKHRTimelineSemaphoreEntrypoints;
+
     #ifdef _WIN32
         #if defined(ANVIL_INCLUDE_WIN3264_WINDOW_SYSTEM_SUPPORT)
             typedef struct ExtensionKHRWin32SurfaceEntrypoints
@@ -1190,6 +1581,24 @@ namespace Anvil
         ExtensionKHRDeviceGroupCreationEntrypoints();
     } ExtensionKHRDeviceGroupCreationEntrypoints;
 
+    typedef struct ExtensionNVMeshShaderEntrypoints
+    {
+        PFN_vkCmdDrawMeshTasksIndirectCountNV vkCmdDrawMeshTasksIndirectCountNV;
+        PFN_vkCmdDrawMeshTasksIndirectNV      vkCmdDrawMeshTasksIndirectNV;
+        PFN_vkCmdDrawMeshTasksNV              vkCmdDrawMeshTasksNV;
+
+        ExtensionNVMeshShaderEntrypoints();
+    } ExtensionNVMeshShaderEntrypoints;
+
+    typedef struct ExtensionNVShadingRateImageEntrypoints
+    {
+        PFN_vkCmdBindShadingRateImageNV          vkCmdBindShadingRateImageNV;
+        PFN_vkCmdSetCoarseSampleOrderNV          vkCmdSetCoarseSampleOrderNV;
+        PFN_vkCmdSetViewportShadingRatePaletteNV vkCmdSetViewportShadingRatePaletteNV;
+
+        ExtensionNVShadingRateImageEntrypoints();
+    } ExtensionNVShadingRateImageEntrypoints;
+
     typedef struct EXTInlineUniformBlockFeatures
     {
         bool descriptor_binding_inline_uniform_block_update_after_bind;
@@ -1416,6 +1825,16 @@ namespace Anvil
         const Anvil::ImageTiling                tiling;
         const Anvil::ImageUsageFlags            usage_flags;
 
+        bool operator==(const ImageFormatPropertiesQuery& in_query) const
+        {
+            return (create_flags                == in_query.create_flags                &&
+                    external_memory_handle_type == in_query.external_memory_handle_type &&
+                    format                      == in_query.format                      &&
+                    image_type                  == in_query.image_type                  &&
+                    tiling                      == in_query.tiling                      &&
+                    usage_flags                 == in_query.usage_flags);
+        }
+
         ImageFormatPropertiesQuery           (const ImageFormatPropertiesQuery& in_query) = default;
         ImageFormatPropertiesQuery& operator=(const ImageFormatPropertiesQuery& in_query) = delete;
     } ImageFormatPropertiesQuery;
@@ -1505,6 +1924,22 @@ namespace Anvil
         ImageBarrier& operator=(const ImageBarrier&);
     } ImageBarrier;
 
+    /* Used by Image::set_memory_multi(). */
+    typedef struct ImageMemoryBindingUpdate
+    {
+        Anvil::Image*       image_ptr;
+        bool                memory_block_owned_by_image;
+        Anvil::MemoryBlock* memory_block_ptr;
+
+        /* May either be empty (for sGPU and mGPU devices) or hold as many device indices as there are physical
+         * devices assigned to the device group (mGPU devices). Index i specifies which memory instance physical
+         * device i should bind to.
+         */
+        std::vector<uint32_t> device_indices;
+
+        ImageMemoryBindingUpdate();
+    } ImageMemoryBindingUpdate;
+
     typedef struct ExternalMemoryHandleImportInfo
     {
         ExternalHandleType handle;   /* Used for non-host pointer import ops */
@@ -1538,6 +1973,32 @@ namespace Anvil
         bool operator==(const EXTScalarBlockLayoutFeatures& in_features) const;
     } EXTScalarBlockLayoutFeatures;
 
+    typedef struct EXTSubgroupSizeControlFeatures
+    {
+        bool compute_full_subgroups;
+        bool subgroup_size_control;
+
+        EXTSubgroupSizeControlFeatures();
+        EXTSubgroupSizeControlFeatures(const VkPhysicalDeviceSubgroupSizeControlFeaturesEXT& in_features);
+
+        VkPhysicalDeviceSubgroupSizeControlFeaturesEXT get_vk_physical_device_subgroup_size_control_features() const;
+
+        bool operator==(const EXTSubgroupSizeControlFeatures& in_features) const;
+    } EXTSubgroupSizeControlFeatures;
+
+    typedef struct EXTSubgroupSizeControlProperties
+    {
+        uint32_t                max_compute_workgroup_subgroups;
+        uint32_t                max_subgroup_size;
+        uint32_t                min_subgroup_size;
+        Anvil::ShaderStageFlags required_subgroup_size_stages;
+
+        EXTSubgroupSizeControlProperties();
+        EXTSubgroupSizeControlProperties(const VkPhysicalDeviceSubgroupSizeControlPropertiesEXT& in_props);
+
+        bool operator==(const EXTSubgroupSizeControlProperties& in_props) const;
+    } EXTSubgroupSizeControlProperties;
+
     typedef struct EXTTransformFeedbackFeatures
     {
         bool geometry_streams;
@@ -1594,6 +2055,19 @@ namespace Anvil
 
     } EXTMemoryPriorityFeatures;
 
+    typedef struct EXTPageableDeviceLocalMemoryFeatures
+    {
+        bool is_pageable_device_local_memory_supported;
+
+        EXTPageableDeviceLocalMemoryFeatures();
+        EXTPageableDeviceLocalMemoryFeatures(const VkPhysicalDevicePageableDeviceLocalMemoryFeaturesEXT& in_features);
+
+        VkPhysicalDevicePageableDeviceLocalMemoryFeaturesEXT get_vk_physical_device_pageable_device_local_memory_features() const;
+
+        bool operator==(const EXTPageableDeviceLocalMemoryFeatures&) const;
+
+    } EXTPageableDeviceLocalMemoryFeatures;
+
     typedef struct KHR16BitStorageFeatures
     {
         bool is_input_output_storage_supported;
@@ -1623,6 +2097,36 @@ namespace Anvil
         bool operator==(const KHR8BitStorageFeatures& in_features) const;
     } KHR8BitStorageFeatures;
 
+    typedef struct KHRAccelerationStructureFeatures
+    {
+        bool acceleration_structure;
+        bool acceleration_structure_capture_replay;
+        bool acceleration_structure_host_commands;
+        bool acceleration_structure_indirect_build;
+        bool descriptor_binding_acceleration_structure_update_after_bind;
+
+        KHRAccelerationStructureFeatures();
+        KHRAccelerationStructureFeatures(const VkPhysicalDeviceAccelerationStructureFeaturesKHR& in_features);
+
+        VkPhysicalDeviceAccelerationStructureFeaturesKHR get_vk_physical_device_acceleration_structure_features() const;
+
+        bool operator==(const KHRAccelerationStructureFeatures& in_features) const;
+    } KHRAccelerationStructureFeatures;
+
+    typedef struct KHRBufferDeviceAddressFeatures
+    {
+        bool buffer_device_address;
+        bool buffer_device_address_capture_replay;
+        bool buffer_device_address_multi_device;
+
+        KHRBufferDeviceAddressFeatures();
+        KHRBufferDeviceAddressFeatures(const VkPhysicalDeviceBufferDeviceAddressFeaturesKHR& in_features);
+
+        VkPhysicalDeviceBufferDeviceAddressFeaturesKHR get_vk_physical_device_buffer_device_address_features() const;
+
+        bool operator==(const KHRBufferDeviceAddressFeatures& in_features) const;
+    } KHRBufferDeviceAddressFeatures;
+
     typedef struct KHRDepthStencilResolveProperties
     {
         bool                    independent_resolve;
@@ -1650,6 +2154,18 @@ namespace Anvil
 
     } KHRDriverPropertiesProperties;
 
+    typedef struct KHRDynamicRenderingFeatures
+    {
+        bool dynamic_rendering;
+
+        KHRDynamicRenderingFeatures();
+        KHRDynamicRenderingFeatures(const VkPhysicalDeviceDynamicRenderingFeaturesKHR& in_features);
+
+        VkPhysicalDeviceDynamicRenderingFeaturesKHR get_vk_physical_device_dynamic_rendering_features() const;
+
+        bool operator==(const KHRDynamicRenderingFeatures& in_features) const;
+    } KHRDynamicRenderingFeatures;
+
     typedef struct KHRExternalMemoryCapabilitiesPhysicalDeviceIDProperties
     {
         uint8_t  device_luid[VK_LUID_SIZE];
@@ -1681,6 +2197,18 @@ namespace Anvil
 
     } KHRFloat16Int8Features;
 
+    typedef struct KHRImagelessFramebufferFeatures
+    {
+        bool imageless_framebuffer;
+
+        KHRImagelessFramebufferFeatures();
+        KHRImagelessFramebufferFeatures(const VkPhysicalDeviceImagelessFramebufferFeaturesKHR& in_features);
+
+        VkPhysicalDeviceImagelessFramebufferFeaturesKHR get_vk_physical_device_imageless_framebuffer_features() const;
+
+        bool operator==(const KHRImagelessFramebufferFeatures& in_features) const;
+    } KHRImagelessFramebufferFeatures;
+
     typedef struct KHRMaintenance2PhysicalDevicePointClippingProperties
     {
         PointClippingBehavior point_clipping_behavior;
@@ -1730,6 +2258,18 @@ namespace Anvil
 
     } KHRMultiviewProperties;
 
+    typedef struct KHRPipelineExecutablePropertiesFeatures
+    {
+        bool pipeline_executable_info;
+
+        KHRPipelineExecutablePropertiesFeatures();
+        KHRPipelineExecutablePropertiesFeatures(const VkPhysicalDevicePipelineExecutablePropertiesFeaturesKHR& in_features);
+
+        VkPhysicalDevicePipelineExecutablePropertiesFeaturesKHR get_vk_physical_device_pipeline_executable_properties_features() const;
+
+        bool operator==(const KHRPipelineExecutablePropertiesFeatures& in_features) const;
+    } KHRPipelineExecutablePropertiesFeatures;
+
     typedef struct KHRShaderAtomicInt64Features
     {
         bool shader_buffer_int64_atomics;
@@ -1771,6 +2311,18 @@ namespace Anvil
         bool operator==(const KHRShaderFloatControlsProperties& in_properties) const;
     } KHRShaderFloatControlsProperties;
 
+    typedef struct KHRTimelineSemaphoreFeatures
+    {
+        bool timeline_semaphore;
+
+        KHRTimelineSemaphoreFeatures();
+        KHRTimelineSemaphoreFeatures(const VkPhysicalDeviceTimelineSemaphoreFeaturesKHR& in_features);
+
+        VkPhysicalDeviceTimelineSemaphoreFeaturesKHR get_vk_physical_device_timeline_semaphore_features() const;
+
+        bool operator==(const KHRTimelineSemaphoreFeatures& in_features) const;
+    } KHRTimelineSemaphoreFeatures;
+
         typedef struct KHRVariablePointerFeatures
     {
         bool variable_pointers;
@@ -1798,6 +2350,32 @@ namespace Anvil
         bool operator==(const KHRVulkanMemoryModelFeatures& in_features) const;
     } KHRVulkanMemoryModelFeatures;
 
+    typedef struct NVMeshShaderFeatures
+    {
+        bool mesh_shader;
+        bool task_shader;
+
+        NVMeshShaderFeatures();
+        NVMeshShaderFeatures(const VkPhysicalDeviceMeshShaderFeaturesNV& in_features);
+
+        VkPhysicalDeviceMeshShaderFeaturesNV get_vk_physical_device_mesh_shader_features() const;
+
+        bool operator==(const NVMeshShaderFeatures& in_features) const;
+    } NVMeshShaderFeatures;
+
+    typedef struct NVShadingRateImageFeatures
+    {
+        bool shading_rate_coarse_sample_order;
+        bool shading_rate_image;
+
+        NVShadingRateImageFeatures();
+        NVShadingRateImageFeatures(const VkPhysicalDeviceShadingRateImageFeaturesNV& in_features);
+
+        VkPhysicalDeviceShadingRateImageFeaturesNV get_vk_physical_device_shading_rate_image_features() const;
+
+        bool operator==(const NVShadingRateImageFeatures& in_features) const;
+    } NVShadingRateImageFeatures;
+
     /** Holds properties of a single Vulkan Layer. */
     typedef struct Layer
     {
@@ -1903,6 +2481,10 @@ namespace Anvil
         uint32_t    n_heaps;
         MemoryTypes types;
 
+        /* Bitmask of memory types which are both device-local and host-visible, and whose heap is larger
+         * than the legacy 256 MB BAR window. Non-zero if the platform exposes resizable BAR. */
+        uint32_t resizable_bar_memory_types;
+
         MemoryProperties();
 
         /** Destructor */
@@ -2393,38 +2975,64 @@ namespace Anvil
     {
         const PhysicalDeviceFeaturesCoreVK10*    core_vk1_0_features_ptr;
         const PhysicalDeviceFeaturesCoreVK11*    core_vk1_1_features_ptr;
+        const EXTConditionalRenderingFeatures*   ext_conditional_rendering_features_ptr;
         const EXTDepthClipEnableFeatures*        ext_depth_clip_enable_features_ptr;
         const EXTDescriptorIndexingFeatures*     ext_descriptor_indexing_features_ptr;
+        const EXTHostImageCopyFeatures*          ext_host_image_copy_features_ptr;
+        const EXTHostQueryResetFeatures*         ext_host_query_reset_features_ptr;
         const EXTInlineUniformBlockFeatures*     ext_inline_uniform_block_features_ptr;
         const EXTScalarBlockLayoutFeatures*      ext_scalar_block_layout_features_ptr;
+        const EXTSubgroupSizeControlFeatures*    ext_subgroup_size_control_features_ptr;
         const EXTTransformFeedbackFeatures*      ext_transform_feedback_features_ptr;
         const EXTMemoryPriorityFeatures*         ext_memory_priority_features_ptr;
+        const EXTPageableDeviceLocalMemoryFeatures* ext_pageable_device_local_memory_features_ptr;
         const KHR16BitStorageFeatures*           khr_16bit_storage_features_ptr;
         const KHR8BitStorageFeatures*            khr_8bit_storage_features_ptr;
+        const KHRAccelerationStructureFeatures*  khr_acceleration_structure_features_ptr;
+        const KHRBufferDeviceAddressFeatures*    khr_buffer_device_address_features_ptr;
+        const KHRDynamicRenderingFeatures*       khr_dynamic_rendering_features_ptr;
         const KHRFloat16Int8Features*            khr_float16_int8_features_ptr;
+        const KHRImagelessFramebufferFeatures*   khr_imageless_framebuffer_features_ptr;
         const KHRMultiviewFeatures*              khr_multiview_features_ptr;
+        const KHRPipelineExecutablePropertiesFeatures* khr_pipeline_executable_properties_features_ptr;
         const KHRSamplerYCbCrConversionFeatures* khr_sampler_ycbcr_conversion_features_ptr;
         const KHRShaderAtomicInt64Features*      khr_shader_atomic_int64_features_ptr;
+        const KHRTimelineSemaphoreFeatures*      khr_timeline_semaphore_features_ptr;
         const KHRVariablePointerFeatures*        khr_variable_pointer_features_ptr;
         const KHRVulkanMemoryModelFeatures*      khr_vulkan_memory_model_features_ptr;
+        const NVMeshShaderFeatures*              nv_mesh_shader_features_ptr;
+        const NVShadingRateImageFeatures*        nv_shading_rate_image_features_ptr;
 
         PhysicalDeviceFeatures();
         PhysicalDeviceFeatures(const PhysicalDeviceFeaturesCoreVK10*    in_core_vk1_0_features_ptr,
                                const PhysicalDeviceFeaturesCoreVK11*    in_core_vk1_1_features_ptr,
+                               const EXTConditionalRenderingFeatures*   in_ext_conditional_rendering_features_ptr,
                                const EXTDepthClipEnableFeatures*        in_ext_depth_clip_enable_features_ptr,
                                const EXTDescriptorIndexingFeatures*     in_ext_descriptor_indexing_features_ptr,
+                               const EXTHostImageCopyFeatures*          in_ext_host_image_copy_features_ptr,
+                               const EXTHostQueryResetFeatures*         in_ext_host_query_reset_features_ptr,
                                const EXTInlineUniformBlockFeatures*     in_ext_inline_uniform_block_features_ptr,
                                const EXTScalarBlockLayoutFeatures*      in_ext_scalar_block_layout_features_ptr,
+                               const EXTSubgroupSizeControlFeatures*    in_ext_subgroup_size_control_features_ptr,
                                const EXTTransformFeedbackFeatures*      in_ext_transform_feedback_features_ptr,
                                const EXTMemoryPriorityFeatures*         in_ext_memory_priority_features_ptr,
+                               const EXTPageableDeviceLocalMemoryFeatures* in_ext_pageable_device_local_memory_features_ptr,
                                const KHR16BitStorageFeatures*           in_khr_16_bit_storage_features_ptr,
                                const KHR8BitStorageFeatures*            in_khr_8_bit_storage_features_ptr,
+                               const KHRAccelerationStructureFeatures*  in_khr_acceleration_structure_features_ptr,
+                               const KHRBufferDeviceAddressFeatures*    in_khr_buffer_device_address_features_ptr,
+                               const KHRDynamicRenderingFeatures*       in_khr_dynamic_rendering_features_ptr,
                                const KHRFloat16Int8Features*            in_khr_float16_int8_features_ptr,
+                               const KHRImagelessFramebufferFeatures*   in_khr_imageless_framebuffer_features_ptr,
                                const KHRMultiviewFeatures*              in_khr_multiview_features_ptr,
+                               const KHRPipelineExecutablePropertiesFeatures* in_khr_pipeline_executable_properties_features_ptr,
                                const KHRSamplerYCbCrConversionFeatures* in_khr_sampler_ycbcr_conversion_features_ptr,
                                const KHRShaderAtomicInt64Features*      in_khr_shader_atomic_int64_features_ptr,
+                               const KHRTimelineSemaphoreFeatures*      in_khr_timeline_semaphore_features_ptr,
                                const KHRVariablePointerFeatures*        in_khr_variable_pointer_features_ptr,
-                               const KHRVulkanMemoryModelFeatures*      in_khr_vulkan_memory_model_features_ptr);
+                               const KHRVulkanMemoryModelFeatures*      in_khr_vulkan_memory_model_features_ptr,
+                               const NVMeshShaderFeatures*              in_nv_mesh_shader_features_ptr,
+                               const NVShadingRateImageFeatures*        in_nv_shading_rate_image_features_ptr);
 
         bool operator==(const PhysicalDeviceFeatures& in_physical_device_features) const;
     } PhysicalDeviceFeatures;
@@ -2624,6 +3232,7 @@ namespace Anvil
         const EXTPCIBusInfoProperties*                                 ext_pci_bus_info_properties_ptr;
         const EXTSampleLocationsProperties*                            ext_sample_locations_properties_ptr;
         const EXTSamplerFilterMinmaxProperties*                        ext_sampler_filter_minmax_properties_ptr;
+        const EXTSubgroupSizeControlProperties*                        ext_subgroup_size_control_properties_ptr;
         const EXTTransformFeedbackProperties*                          ext_transform_feedback_properties_ptr;
         const EXTVertexAttributeDivisorProperties*                     ext_vertex_attribute_divisor_properties_ptr;
         const KHRDepthStencilResolveProperties*                        khr_depth_stencil_resolve_properties_ptr;
@@ -2645,6 +3254,7 @@ namespace Anvil
                                  const EXTPCIBusInfoProperties*                                 in_ext_pci_bus_info_properties_ptr,
                                  const EXTSampleLocationsProperties*                            in_ext_sample_locations_properties_ptr,
                                  const EXTSamplerFilterMinmaxProperties*                        in_ext_sampler_filter_minmax_properties_ptr,
+                                 const EXTSubgroupSizeControlProperties*                        in_ext_subgroup_size_control_properties_ptr,
                                  const EXTTransformFeedbackProperties*                          in_ext_transform_feedback_properties_ptr,
                                  const EXTVertexAttributeDivisorProperties*                     in_ext_vertex_attribute_divisor_properties_ptr,
                                  const KHRDepthStencilResolveProperties*                        in_khr_depth_stencil_resolve_props_ptr,
@@ -2681,6 +3291,66 @@ namespace Anvil
 
     typedef std::vector<PushConstantRange> PushConstantRanges;
 
+    /* Describes a single descriptor to be pushed with CommandBufferBase::record_push_descriptor_set_KHR().
+     *
+     * Only the members relevant to the descriptor type are used.
+     */
+    typedef struct PushDescriptorWrite
+    {
+        BindingIndex          binding;
+        Anvil::DescriptorType descriptor_type;
+        uint32_t              n_array_element;
+
+        /* Buffer descriptors. If buffer_start_offset is UINT64_MAX, the whole buffer is bound. */
+        Anvil::Buffer*        buffer_ptr;
+        VkDeviceSize          buffer_size;
+        VkDeviceSize          buffer_start_offset;
+
+        /* Texel buffer descriptors */
+        Anvil::BufferView*    buffer_view_ptr;
+
+        /* Image and sampler descriptors. sampler_ptr is ignored for immutable samplers. */
+        Anvil::ImageLayout    image_layout;
+        Anvil::ImageView*     image_view_ptr;
+        Anvil::Sampler*       sampler_ptr;
+
+        /** Constructor. Use for uniform & storage buffer descriptors.
+         *
+         *  @param in_binding          Binding to write to.
+         *  @param in_n_array_element  Binding array element to write to.
+         *  @param in_descriptor_type  UNIFORM_BUFFER or STORAGE_BUFFER.
+         *  @param in_buffer_ptr       Buffer to use. Must not be null.
+         *  @param in_start_offset     Start offset of the buffer region to bind. Pass UINT64_MAX to bind the whole buffer.
+         *  @param in_size             Size of the buffer region to bind. Ignored if @param in_start_offset is UINT64_MAX.
+         */
+        PushDescriptorWrite(BindingIndex          in_binding,
+                            uint32_t              in_n_array_element,
+                            Anvil::DescriptorType in_descriptor_type,
+                            Anvil::Buffer*        in_buffer_ptr,
+                            VkDeviceSize          in_start_offset = UINT64_MAX,
+                            VkDeviceSize          in_size         = VK_WHOLE_SIZE);
+
+        /** Constructor. Use for uniform & storage texel buffer descriptors. */
+        PushDescriptorWrite(BindingIndex          in_binding,
+                            uint32_t              in_n_array_element,
+                            Anvil::DescriptorType in_descriptor_type,
+                            Anvil::BufferView*    in_buffer_view_ptr);
+
+        /** Constructor. Use for sampler, combined image+sampler, sampled image, storage image and input
+         *  attachment descriptors.
+         *
+         *  @param in_image_view_ptr May be null for sampler descriptors.
+         *  @param in_sampler_ptr    May be null for descriptors other than samplers & combined image+samplers,
+         *                           or if the binding uses immutable samplers.
+         */
+        PushDescriptorWrite(BindingIndex          in_binding,
+                            uint32_t              in_n_array_element,
+                            Anvil::DescriptorType in_descriptor_type,
+                            Anvil::ImageLayout    in_image_layout,
+                            Anvil::ImageView*     in_image_view_ptr,
+                            Anvil::Sampler*       in_sampler_ptr = nullptr);
+    } PushDescriptorWrite;
+
     /** Holds information about a single Vulkan Queue Family. */
     typedef struct QueueFamilyInfo
     {
@@ -2711,6 +3381,228 @@ namespace Anvil
         explicit PhysicalDeviceGroup();
     } PhysicalDeviceGroup;
 
+    /** Describes a buffer memory barrier.
+     *
+     *  NOTE: Maps 1:1 to VkBufferMemoryBarrier, so arrays of these can be passed to Vulkan without any conversion.
+     *        Please see CommandBufferBase::record_pipeline_barrier_raw() for more details.
+     *
+     *  Unlike BufferBarrier, the structure does not refer to a Buffer wrapper instance.
+     **/
+    typedef struct RawBufferBarrier
+    {
+        VkStructureType    s_type;
+        const void*        next_ptr;
+        Anvil::AccessFlags src_access_mask;
+        Anvil::AccessFlags dst_access_mask;
+        uint32_t           src_queue_family_index;
+        uint32_t           dst_queue_family_index;
+        VkBuffer           buffer;
+        VkDeviceSize       offset;
+        VkDeviceSize       size;
+
+        /** Constructor.
+         *
+         *  Arguments as per BufferBarrier constructor. The buffer is NOT retained.
+         **/
+        explicit RawBufferBarrier(Anvil::AccessFlags in_source_access_mask,
+                                  Anvil::AccessFlags in_destination_access_mask,
+                                  uint32_t           in_src_queue_family_index,
+                                  uint32_t           in_dst_queue_family_index,
+                                  Anvil::Buffer*     in_buffer_ptr,
+                                  VkDeviceSize       in_offset,
+                                  VkDeviceSize       in_size);
+
+        /** Constructor. Copies the configuration of @param in_barrier. */
+        explicit RawBufferBarrier(const Anvil::BufferBarrier& in_barrier);
+
+        const VkBufferMemoryBarrier& get_vk() const
+        {
+            return *reinterpret_cast<const VkBufferMemoryBarrier*>(this);
+        }
+    } RawBufferBarrier;
+
+    static_assert(sizeof(RawBufferBarrier)                           == sizeof(VkBufferMemoryBarrier),                        "Struct sizes must match");
+    static_assert(offsetof(RawBufferBarrier, s_type)                 == offsetof(VkBufferMemoryBarrier, sType),               "Member offsets must match");
+    static_assert(offsetof(RawBufferBarrier, next_ptr)               == offsetof(VkBufferMemoryBarrier, pNext),               "Member offsets must match");
+    static_assert(offsetof(RawBufferBarrier, src_access_mask)        == offsetof(VkBufferMemoryBarrier, srcAccessMask),       "Member offsets must match");
+    static_assert(offsetof(RawBufferBarrier, dst_access_mask)        == offsetof(VkBufferMemoryBarrier, dstAccessMask),       "Member offsets must match");
+    static_assert(offsetof(RawBufferBarrier, src_queue_family_index) == offsetof(VkBufferMemoryBarrier, srcQueueFamilyIndex), "Member offsets must match");
+    static_assert(offsetof(RawBufferBarrier, dst_queue_family_index) == offsetof(VkBufferMemoryBarrier, dstQueueFamilyIndex), "Member offsets must match");
+    static_assert(offsetof(RawBufferBarrier, buffer)                 == offsetof(VkBufferMemoryBarrier, buffer),              "Member offsets must match");
+    static_assert(offsetof(RawBufferBarrier, offset)                 == offsetof(VkBufferMemoryBarrier, offset),              "Member offsets must match");
+    static_assert(offsetof(RawBufferBarrier, size)                   == offsetof(VkBufferMemoryBarrier, size),                "Member offsets must match");
+
+    /** Describes an image memory barrier.
+     *
+     *  NOTE: Maps 1:1 to VkImageMemoryBarrier, so arrays of these can be passed to Vulkan without any conversion.
+     *        Please see CommandBufferBase::record_pipeline_barrier_raw() for more details.
+     *
+     *  Unlike ImageBarrier, the structure does not refer to an Image wrapper instance.
+     **/
+    typedef struct RawImageBarrier
+    {
+        VkStructureType              s_type;
+        const void*                  next_ptr;
+        Anvil::AccessFlags           src_access_mask;
+        Anvil::AccessFlags           dst_access_mask;
+        Anvil::ImageLayout           old_layout;
+        Anvil::ImageLayout           new_layout;
+        uint32_t                     src_queue_family_index;
+        uint32_t                     dst_queue_family_index;
+        VkImage                      image;
+        Anvil::ImageSubresourceRange subresource_range;
+
+        /** Constructor.
+         *
+         *  Arguments as per ImageBarrier constructor. The image is NOT retained.
+         **/
+        explicit RawImageBarrier(Anvil::AccessFlags           in_source_access_mask,
+                                 Anvil::AccessFlags           in_destination_access_mask,
+                                 Anvil::ImageLayout           in_old_layout,
+                                 Anvil::ImageLayout           in_new_layout,
+                                 uint32_t                     in_src_queue_family_index,
+                                 uint32_t                     in_dst_queue_family_index,
+                                 Anvil::Image*                in_image_ptr,
+                                 Anvil::ImageSubresourceRange in_image_subresource_range);
+
+        /** Constructor. Copies the configuration of @param in_barrier. */
+        explicit RawImageBarrier(const Anvil::ImageBarrier& in_barrier);
+
+        const VkImageMemoryBarrier& get_vk() const
+        {
+            return *reinterpret_cast<const VkImageMemoryBarrier*>(this);
+        }
+    } RawImageBarrier;
+
+    static_assert(sizeof(RawImageBarrier)                           == sizeof(VkImageMemoryBarrier),                        "Struct sizes must match");
+    static_assert(offsetof(RawImageBarrier, s_type)                 == offsetof(VkImageMemoryBarrier, sType),               "Member offsets must match");
+    static_assert(offsetof(RawImageBarrier, next_ptr)               == offsetof(VkImageMemoryBarrier, pNext),               "Member offsets must match");
+    static_assert(offsetof(RawImageBarrier, src_access_mask)        == offsetof(VkImageMemoryBarrier, srcAccessMask),       "Member offsets must match");
+    static_assert(offsetof(RawImageBarrier, dst_access_mask)        == offsetof(VkImageMemoryBarrier, dstAccessMask),       "Member offsets must match");
+    static_assert(offsetof(RawImageBarrier, old_layout)             == offsetof(VkImageMemoryBarrier, oldLayout),           "Member offsets must match");
+    static_assert(offsetof(RawImageBarrier, new_layout)             == offsetof(VkImageMemoryBarrier, newLayout),           "Member offsets must match");
+    static_assert(offsetof(RawImageBarrier, src_queue_family_index) == offsetof(VkImageMemoryBarrier, srcQueueFamilyIndex), "Member offsets must match");
+    static_assert(offsetof(RawImageBarrier, dst_queue_family_index) == offsetof(VkImageMemoryBarrier, dstQueueFamilyIndex), "Member offsets must match");
+    static_assert(offsetof(RawImageBarrier, image)                  == offsetof(VkImageMemoryBarrier, image),               "Member offsets must match");
+    static_assert(offsetof(RawImageBarrier, subresource_range)      == offsetof(VkImageMemoryBarrier, subresourceRange),    "Member offsets must match");
+
+    /** Describes a global memory barrier.
+     *
+     *  NOTE: Maps 1:1 to VkMemoryBarrier, so arrays of these can be passed to Vulkan without any conversion.
+     *        Please see CommandBufferBase::record_pipeline_barrier_raw() for more details.
+     **/
+    typedef struct RawMemoryBarrier
+    {
+        VkStructureType    s_type;
+        const void*        next_ptr;
+        Anvil::AccessFlags src_access_mask;
+        Anvil::AccessFlags dst_access_mask;
+
+        /** Constructor.
+         *
+         *  NOTE: Unlike MemoryBarrier's, this constructor takes the source access mask first.
+         **/
+        explicit RawMemoryBarrier(Anvil::AccessFlags in_source_access_mask,
+                                  Anvil::AccessFlags in_destination_access_mask);
+
+        /** Constructor. Copies the configuration of @param in_barrier. */
+        explicit RawMemoryBarrier(const Anvil::MemoryBarrier& in_barrier);
+
+        const VkMemoryBarrier& get_vk() const
+        {
+            return *reinterpret_cast<const VkMemoryBarrier*>(this);
+        }
+    } RawMemoryBarrier;
+
+    static_assert(sizeof(RawMemoryBarrier)                    == sizeof(VkMemoryBarrier),                  "Struct sizes must match");
+    static_assert(offsetof(RawMemoryBarrier, s_type)          == offsetof(VkMemoryBarrier, sType),         "Member offsets must match");
+    static_assert(offsetof(RawMemoryBarrier, next_ptr)        == offsetof(VkMemoryBarrier, pNext),         "Member offsets must match");
+    static_assert(offsetof(RawMemoryBarrier, src_access_mask) == offsetof(VkMemoryBarrier, srcAccessMask), "Member offsets must match");
+    static_assert(offsetof(RawMemoryBarrier, dst_access_mask) == offsetof(VkMemoryBarrier, dstAccessMask), "Member offsets must match");
+
+    /** Describes a single attachment used by a dynamic rendering pass. Used by CommandBufferBase::record_begin_rendering().
+     *
+     *  Requires VK_KHR_dynamic_rendering.
+     **/
+    typedef struct RenderingAttachmentInfo
+    {
+        VkClearValue               clear_value;
+        Anvil::ImageLayout         image_layout;
+        Anvil::ImageView*          image_view_ptr;
+        Anvil::AttachmentLoadOp    load_op;
+        Anvil::ImageLayout         resolve_image_layout;
+        Anvil::ImageView*          resolve_image_view_ptr;
+        Anvil::ResolveModeFlagBits resolve_mode;
+        Anvil::AttachmentStoreOp   store_op;
+
+        /** Dummy constructor. Leaves the attachment unused. */
+        RenderingAttachmentInfo();
+
+        /** Constructor.
+         *
+         *  @param in_image_view_ptr             Image view to render to. May be null, in which case writes to
+         *                                       the attachment are discarded.
+         *  @param in_image_layout               Layout the image view is going to be in during rendering.
+         *  @param in_load_op                    Load op to use for the attachment.
+         *  @param in_store_op                   Store op to use for the attachment.
+         *  @param in_clear_value                Clear value to use if @param in_load_op is AttachmentLoadOp::CLEAR.
+         *  @param in_opt_resolve_mode           Resolve mode to use, if the attachment is multisampled and should be
+         *                                       resolved at the end of rendering.
+         *  @param in_opt_resolve_image_view_ptr Image view to resolve to. Must not be null if @param in_opt_resolve_mode
+         *                                       is not ResolveModeFlagBits::NONE.
+         *  @param in_opt_resolve_image_layout   Layout the resolve image view is going to be in during rendering.
+         **/
+        RenderingAttachmentInfo(Anvil::ImageView*          in_image_view_ptr,
+                                Anvil::ImageLayout         in_image_layout,
+                                Anvil::AttachmentLoadOp    in_load_op,
+                                Anvil::AttachmentStoreOp   in_store_op,
+                                const VkClearValue&        in_clear_value,
+                                Anvil::ResolveModeFlagBits in_opt_resolve_mode           = Anvil::ResolveModeFlagBits::NONE,
+                                Anvil::ImageView*          in_opt_resolve_image_view_ptr = nullptr,
+                                Anvil::ImageLayout         in_opt_resolve_image_layout   = Anvil::ImageLayout::UNDEFINED);
+
+        /** Returns a Vulkan descriptor, whose configuration corresponds to the configuration of this descriptor. */
+        VkRenderingAttachmentInfoKHR get_vk() const;
+    } RenderingAttachmentInfo;
+
+    /** Describes how a buffer, or a single image subresource, has been accessed by the commands recorded since
+     *  the last barrier which synchronized it. Used for resource state tracking.
+     *
+     *  After a barrier, the masks are set to the barrier's destination scope. Subsequent commands accessing
+     *  the resource add their stages and access types to the masks.
+     **/
+    typedef struct ResourceAccessState
+    {
+        Anvil::AccessFlags        access_mask;
+        Anvil::ImageLayout        layout;      //< only used for image subresources
+        Anvil::PipelineStageFlags stage_mask;
+
+        ResourceAccessState()
+            :access_mask(Anvil::AccessFlagBits::NONE),
+             layout     (Anvil::ImageLayout::UNDEFINED),
+             stage_mask (Anvil::PipelineStageFlagBits::NONE)
+        {
+            /* Stub */
+        }
+
+        ResourceAccessState(Anvil::ImageLayout        in_layout,
+                            Anvil::PipelineStageFlags in_stage_mask,
+                            Anvil::AccessFlags        in_access_mask)
+            :access_mask(in_access_mask),
+             layout     (in_layout),
+             stage_mask (in_stage_mask)
+        {
+            /* Stub */
+        }
+
+        bool operator==(const ResourceAccessState& in_state) const
+        {
+            return (access_mask == in_state.access_mask &&
+                    layout      == in_state.layout      &&
+                    stage_mask  == in_state.stage_mask);
+        }
+    } ResourceAccessState;
+
     /** TODO */
     typedef struct SemaphoreMGPUSubmission
     {
@@ -2889,6 +3781,44 @@ namespace Anvil
 
     typedef std::vector<SpecializationConstant> SpecializationConstants;
 
+    /* Describes how long a single phase of Instance or device initialization took. */
+    typedef struct StartupPhaseTiming
+    {
+        uint64_t    duration_nsec;
+        std::string name;
+
+        StartupPhaseTiming(const char* in_name,
+                           uint64_t    in_duration_nsec)
+            :duration_nsec(in_duration_nsec),
+             name         (in_name)
+        {
+            /* Stub */
+        }
+    } StartupPhaseTiming;
+
+    /** Pairs a device timestamp with a host timestamp sampled at (nearly) the same moment. Used to move device
+     *  timestamps onto the host timeline. Please see BaseDevice::get_timestamp_calibration() and
+     *  Time::convert_device_time_to_nsec().
+     */
+    typedef struct TimestampCalibration
+    {
+        /* Device timestamp, converted to nanoseconds using the device's timestampPeriod limit. */
+        uint64_t device_time_nsec;
+
+        /* Host timestamp, as returned by Time::get_raw_host_timestamp(). */
+        uint64_t host_timestamp;
+
+        /* Maximum deviation between the moments at which both timestamps were sampled, in nanoseconds. */
+        uint64_t max_deviation_nsec;
+
+        TimestampCalibration()
+        {
+            device_time_nsec   = 0;
+            host_timestamp     = 0;
+            max_deviation_nsec = 0;
+        }
+    } TimestampCalibration;
+
     typedef enum class SubmissionType
     {
         MGPU,
@@ -2916,6 +3846,7 @@ namespace Anvil
          *  - D3D12 fence submit info:          none
          *  - Keyed mutex acquire/release info: none
          *  - Protected submission:             no
+         *  - Timeline semaphore values:        none
          *
          *  To adjust these settings, please use corresponding set_..() functions, prior to passing the structure over to Queue::submit().
          *
@@ -3175,6 +4106,22 @@ namespace Anvil
             return should_block;
         }
 
+        /* Returns true if set_timeline_semaphore_values() has been called prior to this call. Otherwise returns false.
+         *
+         * If the func returns true, derefs are set to the cached value arrays.
+         */
+        bool get_timeline_semaphore_values(const uint64_t** out_signal_semaphore_values_ptr_ptr,
+                                           const uint64_t** out_wait_semaphore_values_ptr_ptr) const
+        {
+            bool result = (timeline_signal_semaphore_values_ptr != nullptr && n_signal_semaphores != 0) ||
+                          (timeline_wait_semaphore_values_ptr   != nullptr && n_wait_semaphores   != 0);
+
+            *out_signal_semaphore_values_ptr_ptr = timeline_signal_semaphore_values_ptr;
+            *out_wait_semaphore_values_ptr_ptr   = timeline_wait_semaphore_values_ptr;
+
+            return result;
+        }
+
         const uint64_t& get_timeout() const
         {
             return timeout;
@@ -3303,6 +4250,38 @@ namespace Anvil
             is_protected = in_should_enable;
         }
 
+        /* Calling this function will make Anvil fill & chain a VkTimelineSemaphoreSubmitInfoKHR struct at queue submission time.
+         *
+         * Requires VK_KHR_timeline_semaphore support.
+         *
+         * NOTE: The structure caches the provided pointers, not the contents available under derefs! Make sure the pointers remain valid
+         *       for the time of the Queue::submit() call.
+         *
+         * @param in_signal_semaphore_values_ptr An array of exactly n_signal_semaphores values. Values associated with binary semaphores
+         *                                       are ignored. Must not be nullptr unless n_signal_semaphores is 0.
+         * @param in_wait_semaphore_values_ptr   An array of exactly n_wait_semaphores values. Values associated with binary semaphores
+         *                                       are ignored. Must not be nullptr unless n_wait_semaphores is 0.
+         **/
+        void set_timeline_semaphore_values(const uint64_t* in_signal_semaphore_values_ptr,
+                                           const uint32_t& in_n_signal_semaphore_values,
+                                           const uint64_t* in_wait_semaphore_values_ptr,
+                                           const uint32_t& in_n_wait_semaphore_values)
+        {
+            ANVIL_REDUNDANT_ARGUMENT_CONST(in_n_signal_semaphore_values);
+            ANVIL_REDUNDANT_ARGUMENT_CONST(in_n_wait_semaphore_values);
+
+            anvil_assert((n_signal_semaphores != 0  && in_signal_semaphore_values_ptr != nullptr) ||
+                         (n_signal_semaphores == 0) );
+            anvil_assert((n_wait_semaphores   != 0  && in_wait_semaphore_values_ptr   != nullptr) ||
+                         (n_wait_semaphores   == 0) );
+
+            anvil_assert(in_n_signal_semaphore_values == n_signal_semaphores);
+            anvil_assert(in_n_wait_semaphore_values   == n_wait_semaphores);
+
+            timeline_signal_semaphore_values_ptr = in_signal_semaphore_values_ptr;
+            timeline_wait_semaphore_values_ptr   = in_wait_semaphore_values_ptr;
+        }
+
         /* Sets a timeout which is used when waiting on a fence that the submission is associated with.
          *
          * If your submission times out, you're likely about to experience a TDR and lose the device.
@@ -3353,6 +4332,9 @@ namespace Anvil
 
         Anvil::Fence* fence_ptr;
 
+        const uint64_t* timeline_signal_semaphore_values_ptr;
+        const uint64_t* timeline_wait_semaphore_values_ptr;
+
         #if defined(_WIN32)
             const uint64_t* d3d12_fence_signal_semaphore_values_ptr;
             const uint64_t* d3d12_fence_wait_semaphore_values_ptr;
@@ -3371,6 +4353,8 @@ namespace Anvil
         uint64_t             timeout;
         const SubmissionType type;
 
+        friend class Anvil::SubmitThread;
+
         ANVIL_DISABLE_ASSIGNMENT_OPERATOR(SubmitInfo);
     } SubmitInfo;
 
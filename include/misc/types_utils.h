@@ -285,6 +285,26 @@ namespace Anvil
                                                              Anvil::MemoryPropertyFlags* out_mem_type_flags_ptr,
                                                              Anvil::MemoryHeapFlags*     out_mem_heap_flags_ptr);
 
+        /** Returns the subset of @param in_access_mask which describes write accesses. */
+        Anvil::AccessFlags get_write_access_mask(Anvil::AccessFlags in_access_mask);
+
+        /** Computes a 64-bit, non-cryptographic hash of the specified data.
+         *
+         *  The hash is based on MurmurHash64A. It does not allocate, consumes data eight bytes at a time and
+         *  yields the same value for the same input on all runs on a given platform, so it can be used for
+         *  on-disk keys. Multiple buffers can be combined by passing the hash of the previous buffer as
+         *  @param in_seed.
+         *
+         *  @param in_data_ptr Data to hash. May be nullptr if @param in_n_bytes is 0.
+         *  @param in_n_bytes  Number of bytes to hash.
+         *  @param in_seed     Seed value.
+         *
+         *  @return Hash value.
+         **/
+        uint64_t hash64(const void* in_data_ptr,
+                        size_t      in_n_bytes,
+                        uint64_t    in_seed = 0);
+
         #ifdef _WIN32
             bool is_nt_handle(const Anvil::ExternalFenceHandleTypeFlagBits&     in_type);
             bool is_nt_handle(const Anvil::ExternalMemoryHandleTypeFlagBits&    in_type);
@@ -0,0 +1,187 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Converts fp32 vertex attribute streams into a single interleaved vertex stream using compact formats, and
+ *  produces matching vertex attribute descriptions for GraphicsPipelineCreateInfo.
+ *
+ *  Formats are picked per attribute semantic:
+ *
+ *  - COLOR:    R8G8B8A8_UNORM. Values are clamped to [0, 1]. Missing alpha is set to 1.
+ *  - GENERIC:  R32*_SFLOAT. Data is copied as is.
+ *  - NORMAL:   A2B10G10R10_SNORM_PACK32. Values are clamped to [-1, 1]. If present, the fourth component (eg. tangent
+ *              handedness) is stored in the 2-bit alpha channel, which can only represent -1, 0 and 1.
+ *  - POSITION: R16*_SFLOAT. Three-component positions are padded to four components, with w set to 1. Positions must
+ *              fit in the FP16 range; meshes with large extents or tight precision requirements should pass their
+ *              positions as GENERIC instead.
+ *  - TEXCOORD: R16*_UNORM if all values of the attribute lie within [0, 1], R16*_SFLOAT otherwise.
+ *
+ *  Conversions are vectorized: FP16 conversions use the batch routines from misc/fp16.h, and normalized formats are
+ *  quantized with SSE2 or NEON where available. Quantization rounds to nearest even.
+ *
+ *  Every attribute starts at a 4-byte aligned offset, so the packed stride is always a multiple of 4.
+ *
+ *  Packer instances are NOT thread-safe.
+ */
+#ifndef MISC_VERTEX_PACKER_H
+#define MISC_VERTEX_PACKER_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class VertexPacker
+    {
+    public:
+        /* Public type definitions */
+        enum class AttributeSemantic
+        {
+            COLOR,
+            GENERIC,
+            NORMAL,
+            POSITION,
+            TEXCOORD,
+        };
+
+        /* Public functions */
+
+        /** Creates a new packer instance. */
+        static Anvil::VertexPackerUniquePtr create();
+
+        /** Destructor. */
+        ~VertexPacker();
+
+        /** Registers a new fp32 attribute stream. The data is not copied, so it must stay alive until pack() is called.
+         *
+         *  @param in_location        Shader location to assign to the attribute. Must not have been used by an
+         *                            earlier add_attribute() call.
+         *  @param in_semantic        Semantic of the attribute, which determines the packed format.
+         *  @param in_n_components    Number of floats per vertex. Must be between 1 and 4. NORMAL attributes must use
+         *                            3 or 4 components.
+         *  @param in_data_ptr        Pointer to the first component of the first vertex. Must not be null.
+         *  @param in_stride_in_bytes Distance between two consecutive vertices, in bytes. Must be at least
+         *                            @param in_n_components * sizeof(float).
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool add_attribute(uint32_t          in_location,
+                           AttributeSemantic in_semantic,
+                           uint32_t          in_n_components,
+                           const float*      in_data_ptr,
+                           uint32_t          in_stride_in_bytes);
+
+        /** Adds a vertex binding using the packed layout to the specified graphics pipeline create info.
+         *
+         *  Requires a prior successful pack() call.
+         *
+         *  @param in_binding                      Binding index to use.
+         *  @param in_gfx_pipeline_create_info_ptr Create info to update. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool add_to_pipeline_create_info(uint32_t                           in_binding,
+                                         Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr) const;
+
+        /** Creates a vertex buffer holding the data produced by the last successful pack() call. Buffer memory is
+         *  allocated via @param in_memory_allocator_ptr and filled when the allocator bakes; the caller is responsible
+         *  for baking it.
+         *
+         *  @param in_device_ptr               Device to create the buffer for. Must not be null.
+         *  @param in_memory_allocator_ptr     Memory allocator to use. Must not be null.
+         *  @param in_required_memory_features Memory features the buffer memory must support.
+         *
+         *  @return New buffer instance if successful, null otherwise.
+         */
+        Anvil::BufferUniquePtr create_vertex_buffer(const Anvil::BaseDevice*  in_device_ptr,
+                                                    Anvil::MemoryAllocator*   in_memory_allocator_ptr,
+                                                    Anvil::MemoryFeatureFlags in_required_memory_features) const;
+
+        /** Returns interleaved vertex data produced by the last successful pack() call. */
+        const std::vector<uint32_t>& get_packed_data() const
+        {
+            return m_packed_data;
+        }
+
+        /** Returns the stride of the packed vertex stream, in bytes. Only valid after a successful pack() call. */
+        uint32_t get_packed_stride() const
+        {
+            return m_packed_stride;
+        }
+
+        /** Returns vertex attribute descriptions matching the packed layout, in the order attributes were added.
+         *  Only valid after a successful pack() call.
+         */
+        const std::vector<Anvil::VertexInputAttribute>& get_vertex_attributes() const
+        {
+            return m_vertex_attributes;
+        }
+
+        /** Converts all registered attributes and interleaves them. Results of any previous pack() call are
+         *  discarded.
+         *
+         *  @param in_n_vertices Number of vertices to pack. Must not be 0.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool pack(uint32_t in_n_vertices);
+
+    private:
+        /* Private type definitions */
+        typedef struct InputAttribute
+        {
+            const float*      data_ptr;
+            uint32_t          location;
+            uint32_t          n_components;
+            AttributeSemantic semantic;
+            uint32_t          stride_in_bytes;
+
+            InputAttribute(uint32_t          in_location,
+                           AttributeSemantic in_semantic,
+                           uint32_t          in_n_components,
+                           const float*      in_data_ptr,
+                           uint32_t          in_stride_in_bytes)
+                :data_ptr       (in_data_ptr),
+                 location       (in_location),
+                 n_components   (in_n_components),
+                 semantic       (in_semantic),
+                 stride_in_bytes(in_stride_in_bytes)
+            {
+                /* Stub */
+            }
+        } InputAttribute;
+
+        /* Private functions */
+        VertexPacker();
+
+        /* Private variables */
+        std::vector<InputAttribute>              m_input_attributes;
+        std::vector<uint32_t>                    m_packed_data;
+        uint32_t                                 m_packed_stride;
+        std::vector<Anvil::VertexInputAttribute> m_vertex_attributes;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(VertexPacker);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(VertexPacker);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_VERTEX_PACKER_H */
@@ -25,12 +25,760 @@
 #include <config.h>
 #include "vulkan/vulkan.h"
 
+/* VK_KHR_timeline_semaphore is newer than the Vulkan headers bundled with Anvil. Provide the definitions
+ * Anvil relies on, unless the headers in use already expose them.
+ */
+#if !defined(VK_KHR_timeline_semaphore)
+    #define VK_KHR_timeline_semaphore                1
+    #define VK_KHR_TIMELINE_SEMAPHORE_SPEC_VERSION   2
+    #define VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME "VK_KHR_timeline_semaphore"
+
+    #define VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR   static_cast<VkStructureType>(1000207000)
+    #define VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_PROPERTIES_KHR static_cast<VkStructureType>(1000207001)
+    #define VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR                    static_cast<VkStructureType>(1000207002)
+    #define VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR                static_cast<VkStructureType>(1000207003)
+    #define VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR                           static_cast<VkStructureType>(1000207004)
+    #define VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO_KHR                         static_cast<VkStructureType>(1000207005)
+
+    typedef enum VkSemaphoreTypeKHR
+    {
+        VK_SEMAPHORE_TYPE_BINARY_KHR   = 0,
+        VK_SEMAPHORE_TYPE_TIMELINE_KHR = 1,
+        VK_SEMAPHORE_TYPE_MAX_ENUM_KHR = 0x7FFFFFFF
+    } VkSemaphoreTypeKHR;
+
+    typedef enum VkSemaphoreWaitFlagBitsKHR
+    {
+        VK_SEMAPHORE_WAIT_ANY_BIT_KHR            = 0x00000001,
+        VK_SEMAPHORE_WAIT_FLAG_BITS_MAX_ENUM_KHR = 0x7FFFFFFF
+    } VkSemaphoreWaitFlagBitsKHR;
+    typedef VkFlags VkSemaphoreWaitFlagsKHR;
+
+    typedef struct VkPhysicalDeviceTimelineSemaphoreFeaturesKHR
+    {
+        VkStructureType sType;
+        void*           pNext;
+        VkBool32        timelineSemaphore;
+    } VkPhysicalDeviceTimelineSemaphoreFeaturesKHR;
+
+    typedef struct VkPhysicalDeviceTimelineSemaphorePropertiesKHR
+    {
+        VkStructureType sType;
+        void*           pNext;
+        uint64_t        maxTimelineSemaphoreValueDifference;
+    } VkPhysicalDeviceTimelineSemaphorePropertiesKHR;
+
+    typedef struct VkSemaphoreTypeCreateInfoKHR
+    {
+        VkStructureType    sType;
+        const void*        pNext;
+        VkSemaphoreTypeKHR semaphoreType;
+        uint64_t           initialValue;
+    } VkSemaphoreTypeCreateInfoKHR;
+
+    typedef struct VkTimelineSemaphoreSubmitInfoKHR
+    {
+        VkStructureType sType;
+        const void*     pNext;
+        uint32_t        waitSemaphoreValueCount;
+        const uint64_t* pWaitSemaphoreValues;
+        uint32_t        signalSemaphoreValueCount;
+        const uint64_t* pSignalSemaphoreValues;
+    } VkTimelineSemaphoreSubmitInfoKHR;
+
+    typedef struct VkSemaphoreWaitInfoKHR
+    {
+        VkStructureType         sType;
+        const void*             pNext;
+        VkSemaphoreWaitFlagsKHR flags;
+        uint32_t                semaphoreCount;
+        const VkSemaphore*      pSemaphores;
+        const uint64_t*         pValues;
+    } VkSemaphoreWaitInfoKHR;
+
+    typedef struct VkSemaphoreSignalInfoKHR
+    {
+        VkStructureType sType;
+        const void*     pNext;
+        VkSemaphore     semaphore;
+        uint64_t        value;
+    } VkSemaphoreSignalInfoKHR;
+
+    typedef VkResult (VKAPI_PTR *PFN_vkGetSemaphoreCounterValueKHR)(VkDevice device, VkSemaphore semaphore, uint64_t* pValue);
+    typedef VkResult (VKAPI_PTR *PFN_vkWaitSemaphoresKHR)          (VkDevice device, const VkSemaphoreWaitInfoKHR* pWaitInfo, uint64_t timeout);
+    typedef VkResult (VKAPI_PTR *PFN_vkSignalSemaphoreKHR)         (VkDevice device, const VkSemaphoreSignalInfoKHR* pSignalInfo);
+#endif
+
+/* Same applies to VK_EXT_pipeline_creation_feedback. */
+#if !defined(VK_EXT_pipeline_creation_feedback)
+    #define VK_EXT_pipeline_creation_feedback                1
+    #define VK_EXT_PIPELINE_CREATION_FEEDBACK_SPEC_VERSION   1
+    #define VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME "VK_EXT_pipeline_creation_feedback"
+
+    #define VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO_EXT static_cast<VkStructureType>(1000192000)
+
+    typedef enum VkPipelineCreationFeedbackFlagBitsEXT
+    {
+        VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT_EXT                          = 0x00000001,
+        VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT_EXT = 0x00000002,
+        VK_PIPELINE_CREATION_FEEDBACK_BASE_PIPELINE_ACCELERATION_BIT_EXT     = 0x00000004,
+        VK_PIPELINE_CREATION_FEEDBACK_FLAG_BITS_MAX_ENUM_EXT                 = 0x7FFFFFFF
+    } VkPipelineCreationFeedbackFlagBitsEXT;
+    typedef VkFlags VkPipelineCreationFeedbackFlagsEXT;
+
+    typedef struct VkPipelineCreationFeedbackEXT
+    {
+        VkPipelineCreationFeedbackFlagsEXT flags;
+        uint64_t                           duration;
+    } VkPipelineCreationFeedbackEXT;
+
+    typedef struct VkPipelineCreationFeedbackCreateInfoEXT
+    {
+        VkStructureType                sType;
+        const void*                    pNext;
+        VkPipelineCreationFeedbackEXT* pPipelineCreationFeedback;
+        uint32_t                       pipelineStageCreationFeedbackCount;
+        VkPipelineCreationFeedbackEXT* pPipelineStageCreationFeedbacks;
+    } VkPipelineCreationFeedbackCreateInfoEXT;
+#endif
+
+/* Same applies to VK_KHR_imageless_framebuffer. */
+#if !defined(VK_KHR_imageless_framebuffer)
+    #define VK_KHR_imageless_framebuffer                1
+    #define VK_KHR_IMAGELESS_FRAMEBUFFER_SPEC_VERSION   1
+    #define VK_KHR_IMAGELESS_FRAMEBUFFER_EXTENSION_NAME "VK_KHR_imageless_framebuffer"
+
+    #define VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGELESS_FRAMEBUFFER_FEATURES_KHR static_cast<VkStructureType>(1000108000)
+    #define VK_STRUCTURE_TYPE_FRAMEBUFFER_ATTACHMENTS_CREATE_INFO_KHR            static_cast<VkStructureType>(1000108001)
+    #define VK_STRUCTURE_TYPE_FRAMEBUFFER_ATTACHMENT_IMAGE_INFO_KHR              static_cast<VkStructureType>(1000108002)
+    #define VK_STRUCTURE_TYPE_RENDER_PASS_ATTACHMENT_BEGIN_INFO_KHR              static_cast<VkStructureType>(1000108003)
+
+    #define VK_FRAMEBUFFER_CREATE_IMAGELESS_BIT_KHR static_cast<VkFramebufferCreateFlags>(0x00000001)
+
+    typedef struct VkPhysicalDeviceImagelessFramebufferFeaturesKHR
+    {
+        VkStructureType sType;
+        void*           pNext;
+        VkBool32        imagelessFramebuffer;
+    } VkPhysicalDeviceImagelessFramebufferFeaturesKHR;
+
+    typedef struct VkFramebufferAttachmentImageInfoKHR
+    {
+        VkStructureType    sType;
+        const void*        pNext;
+        VkImageCreateFlags flags;
+        VkImageUsageFlags  usage;
+        uint32_t           width;
+        uint32_t           height;
+        uint32_t           layerCount;
+        uint32_t           viewFormatCount;
+        const VkFormat*    pViewFormats;
+    } VkFramebufferAttachmentImageInfoKHR;
+
+    typedef struct VkFramebufferAttachmentsCreateInfoKHR
+    {
+        VkStructureType                            sType;
+        const void*                                pNext;
+        uint32_t                                   attachmentImageInfoCount;
+        const VkFramebufferAttachmentImageInfoKHR* pAttachmentImageInfos;
+    } VkFramebufferAttachmentsCreateInfoKHR;
+
+    typedef struct VkRenderPassAttachmentBeginInfoKHR
+    {
+        VkStructureType    sType;
+        const void*        pNext;
+        uint32_t           attachmentCount;
+        const VkImageView* pAttachments;
+    } VkRenderPassAttachmentBeginInfoKHR;
+#endif
+
+/* Same applies to VK_KHR_dynamic_rendering. */
+#if !defined(VK_KHR_dynamic_rendering)
+    #define VK_KHR_dynamic_rendering                1
+    #define VK_KHR_DYNAMIC_RENDERING_SPEC_VERSION   1
+    #define VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME "VK_KHR_dynamic_rendering"
+
+    #define VK_STRUCTURE_TYPE_RENDERING_INFO_KHR                             static_cast<VkStructureType>(1000044000)
+    #define VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR                  static_cast<VkStructureType>(1000044001)
+    #define VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR             static_cast<VkStructureType>(1000044002)
+    #define VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR static_cast<VkStructureType>(1000044003)
+
+    typedef enum VkRenderingFlagBitsKHR
+    {
+        VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR = 0x00000001,
+        VK_RENDERING_SUSPENDING_BIT_KHR                         = 0x00000002,
+        VK_RENDERING_RESUMING_BIT_KHR                           = 0x00000004,
+        VK_RENDERING_FLAG_BITS_MAX_ENUM_KHR                     = 0x7FFFFFFF
+    } VkRenderingFlagBitsKHR;
+    typedef VkFlags VkRenderingFlagsKHR;
+
+    typedef struct VkPhysicalDeviceDynamicRenderingFeaturesKHR
+    {
+        VkStructureType sType;
+        void*           pNext;
+        VkBool32        dynamicRendering;
+    } VkPhysicalDeviceDynamicRenderingFeaturesKHR;
+
+    typedef struct VkPipelineRenderingCreateInfoKHR
+    {
+        VkStructureType sType;
+        const void*     pNext;
+        uint32_t        viewMask;
+        uint32_t        colorAttachmentCount;
+        const VkFormat* pColorAttachmentFormats;
+        VkFormat        depthAttachmentFormat;
+        VkFormat        stencilAttachmentFormat;
+    } VkPipelineRenderingCreateInfoKHR;
+
+    typedef struct VkRenderingAttachmentInfoKHR
+    {
+        VkStructureType          sType;
+        const void*              pNext;
+        VkImageView              imageView;
+        VkImageLayout            imageLayout;
+        VkResolveModeFlagBitsKHR resolveMode;
+        VkImageView              resolveImageView;
+        VkImageLayout            resolveImageLayout;
+        VkAttachmentLoadOp       loadOp;
+        VkAttachmentStoreOp      storeOp;
+        VkClearValue             clearValue;
+    } VkRenderingAttachmentInfoKHR;
+
+    typedef struct VkRenderingInfoKHR
+    {
+        VkStructureType                     sType;
+        const void*                         pNext;
+        VkRenderingFlagsKHR                 flags;
+        VkRect2D                            renderArea;
+        uint32_t                            layerCount;
+        uint32_t                            viewMask;
+        uint32_t                            colorAttachmentCount;
+        const VkRenderingAttachmentInfoKHR* pColorAttachments;
+        const VkRenderingAttachmentInfoKHR* pDepthAttachment;
+        const VkRenderingAttachmentInfoKHR* pStencilAttachment;
+    } VkRenderingInfoKHR;
+
+    typedef void (VKAPI_PTR *PFN_vkCmdBeginRenderingKHR)(VkCommandBuffer commandBuffer, const VkRenderingInfoKHR* pRenderingInfo);
+    typedef void (VKAPI_PTR *PFN_vkCmdEndRenderingKHR)  (VkCommandBuffer commandBuffer);
+#endif
+
+/* Same goes for VK_EXT_host_query_reset. */
+#if !defined(VK_EXT_host_query_reset)
+    #define VK_EXT_host_query_reset                1
+    #define VK_EXT_HOST_QUERY_RESET_SPEC_VERSION   1
+    #define VK_EXT_HOST_QUERY_RESET_EXTENSION_NAME "VK_EXT_host_query_reset"
+
+    #define VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_QUERY_RESET_FEATURES_EXT static_cast<VkStructureType>(1000261000)
+
+    typedef struct VkPhysicalDeviceHostQueryResetFeaturesEXT
+    {
+        VkStructureType sType;
+        void*           pNext;
+        VkBool32        hostQueryReset;
+    } VkPhysicalDeviceHostQueryResetFeaturesEXT;
+
+    typedef void (VKAPI_PTR *PFN_vkResetQueryPoolEXT)(VkDevice device, VkQueryPool queryPool, uint32_t firstQuery, uint32_t queryCount);
+#endif
+
+/* Same goes for VK_EXT_subgroup_size_control. */
+#if !defined(VK_EXT_subgroup_size_control)
+    #define VK_EXT_subgroup_size_control                1
+    #define VK_EXT_SUBGROUP_SIZE_CONTROL_SPEC_VERSION   2
+    #define VK_EXT_SUBGROUP_SIZE_CONTROL_EXTENSION_NAME "VK_EXT_subgroup_size_control"
+
+    #define VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_SIZE_CONTROL_PROPERTIES_EXT         static_cast<VkStructureType>(1000225000)
+    #define VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_REQUIRED_SUBGROUP_SIZE_CREATE_INFO_EXT static_cast<VkStructureType>(1000225001)
+    #define VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_SIZE_CONTROL_FEATURES_EXT           static_cast<VkStructureType>(1000225002)
+
+    #define VK_PIPELINE_SHADER_STAGE_CREATE_ALLOW_VARYING_SUBGROUP_SIZE_BIT_EXT static_cast<VkPipelineShaderStageCreateFlags>(0x00000001)
+    #define VK_PIPELINE_SHADER_STAGE_CREATE_REQUIRE_FULL_SUBGROUPS_BIT_EXT      static_cast<VkPipelineShaderStageCreateFlags>(0x00000002)
+
+    typedef struct VkPhysicalDeviceSubgroupSizeControlFeaturesEXT
+    {
+        VkStructureType sType;
+        void*           pNext;
+        VkBool32        subgroupSizeControl;
+        VkBool32        computeFullSubgroups;
+    } VkPhysicalDeviceSubgroupSizeControlFeaturesEXT;
+
+    typedef struct VkPhysicalDeviceSubgroupSizeControlPropertiesEXT
+    {
+        VkStructureType    sType;
+        void*              pNext;
+        uint32_t           minSubgroupSize;
+        uint32_t           maxSubgroupSize;
+        uint32_t           maxComputeWorkgroupSubgroups;
+        VkShaderStageFlags requiredSubgroupSizeStages;
+    } VkPhysicalDeviceSubgroupSizeControlPropertiesEXT;
+
+    typedef struct VkPipelineShaderStageRequiredSubgroupSizeCreateInfoEXT
+    {
+        VkStructureType sType;
+        void*           pNext;
+        uint32_t        requiredSubgroupSize;
+    } VkPipelineShaderStageRequiredSubgroupSizeCreateInfoEXT;
+#endif
+
+/* Same goes for VK_KHR_pipeline_executable_properties. */
+#if !defined(VK_KHR_pipeline_executable_properties)
+    #define VK_KHR_pipeline_executable_properties                1
+    #define VK_KHR_PIPELINE_EXECUTABLE_PROPERTIES_SPEC_VERSION   1
+    #define VK_KHR_PIPELINE_EXECUTABLE_PROPERTIES_EXTENSION_NAME "VK_KHR_pipeline_executable_properties"
+
+    #define VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PIPELINE_EXECUTABLE_PROPERTIES_FEATURES_KHR static_cast<VkStructureType>(1000269000)
+    #define VK_STRUCTURE_TYPE_PIPELINE_INFO_KHR                                           static_cast<VkStructureType>(1000269001)
+    #define VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_PROPERTIES_KHR                          static_cast<VkStructureType>(1000269002)
+    #define VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_INFO_KHR                                static_cast<VkStructureType>(1000269003)
+    #define VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_STATISTIC_KHR                           static_cast<VkStructureType>(1000269004)
+    #define VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_INTERNAL_REPRESENTATION_KHR             static_cast<VkStructureType>(1000269005)
+
+    #define VK_PIPELINE_CREATE_CAPTURE_STATISTICS_BIT_KHR               static_cast<VkPipelineCreateFlagBits>(0x00000040)
+    #define VK_PIPELINE_CREATE_CAPTURE_INTERNAL_REPRESENTATIONS_BIT_KHR static_cast<VkPipelineCreateFlagBits>(0x00000080)
+
+    typedef enum VkPipelineExecutableStatisticFormatKHR
+    {
+        VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_BOOL32_KHR  = 0,
+        VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_INT64_KHR   = 1,
+        VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_UINT64_KHR  = 2,
+        VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_FLOAT64_KHR = 3,
+    } VkPipelineExecutableStatisticFormatKHR;
+
+    typedef struct VkPhysicalDevicePipelineExecutablePropertiesFeaturesKHR
+    {
+        VkStructureType sType;
+        void*           pNext;
+        VkBool32        pipelineExecutableInfo;
+    } VkPhysicalDevicePipelineExecutablePropertiesFeaturesKHR;
+
+    typedef struct VkPipelineInfoKHR
+    {
+        VkStructureType sType;
+        const void*     pNext;
+        VkPipeline      pipeline;
+    } VkPipelineInfoKHR;
+
+    typedef struct VkPipelineExecutablePropertiesKHR
+    {
+        VkStructureType    sType;
+        void*              pNext;
+        VkShaderStageFlags stages;
+        char               name       [VK_MAX_DESCRIPTION_SIZE];
+        char               description[VK_MAX_DESCRIPTION_SIZE];
+        uint32_t           subgroupSize;
+    } VkPipelineExecutablePropertiesKHR;
+
+    typedef struct VkPipelineExecutableInfoKHR
+    {
+        VkStructureType sType;
+        const void*     pNext;
+        VkPipeline      pipeline;
+        uint32_t        executableIndex;
+    } VkPipelineExecutableInfoKHR;
+
+    typedef union VkPipelineExecutableStatisticValueKHR
+    {
+        VkBool32 b32;
+        int64_t  i64;
+        uint64_t u64;
+        double   f64;
+    } VkPipelineExecutableStatisticValueKHR;
+
+    typedef struct VkPipelineExecutableStatisticKHR
+    {
+        VkStructureType                        sType;
+        void*                                  pNext;
+        char                                   name       [VK_MAX_DESCRIPTION_SIZE];
+        char                                   description[VK_MAX_DESCRIPTION_SIZE];
+        VkPipelineExecutableStatisticFormatKHR format;
+        VkPipelineExecutableStatisticValueKHR  value;
+    } VkPipelineExecutableStatisticKHR;
+
+    typedef VkResult (VKAPI_PTR *PFN_vkGetPipelineExecutablePropertiesKHR)(VkDevice device, const VkPipelineInfoKHR* pPipelineInfo, uint32_t* pExecutableCount, VkPipelineExecutablePropertiesKHR* pProperties);
+    typedef VkResult (VKAPI_PTR *PFN_vkGetPipelineExecutableStatisticsKHR)(VkDevice device, const VkPipelineExecutableInfoKHR* pExecutableInfo, uint32_t* pStatisticCount, VkPipelineExecutableStatisticKHR* pStatistics);
+#endif
+
+/* Same goes for VK_EXT_pageable_device_local_memory. */
+#if !defined(VK_EXT_pageable_device_local_memory)
+    #define VK_EXT_pageable_device_local_memory                1
+    #define VK_EXT_PAGEABLE_DEVICE_LOCAL_MEMORY_SPEC_VERSION   1
+    #define VK_EXT_PAGEABLE_DEVICE_LOCAL_MEMORY_EXTENSION_NAME "VK_EXT_pageable_device_local_memory"
+
+    #define VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PAGEABLE_DEVICE_LOCAL_MEMORY_FEATURES_EXT static_cast<VkStructureType>(1000412000)
+
+    typedef struct VkPhysicalDevicePageableDeviceLocalMemoryFeaturesEXT
+    {
+        VkStructureType sType;
+        void*           pNext;
+        VkBool32        pageableDeviceLocalMemory;
+    } VkPhysicalDevicePageableDeviceLocalMemoryFeaturesEXT;
+
+    typedef void (VKAPI_PTR *PFN_vkSetDeviceMemoryPriorityEXT)(VkDevice device, VkDeviceMemory memory, float priority);
+#endif
+
+/* Same goes for VK_KHR_buffer_device_address. */
+#if !defined(VK_KHR_buffer_device_address)
+    #define VK_KHR_buffer_device_address                1
+    #define VK_KHR_BUFFER_DEVICE_ADDRESS_SPEC_VERSION   1
+    #define VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME "VK_KHR_buffer_device_address"
+
+    #define VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO_KHR                   static_cast<VkStructureType>(1000244001)
+    #define VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES_KHR static_cast<VkStructureType>(1000257000)
+
+    #define VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT_KHR static_cast<VkBufferUsageFlags>(0x00020000)
+    #define VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR     static_cast<VkMemoryAllocateFlags>(0x00000002)
+
+    typedef struct VkPhysicalDeviceBufferDeviceAddressFeaturesKHR
+    {
+        VkStructureType sType;
+        void*           pNext;
+        VkBool32        bufferDeviceAddress;
+        VkBool32        bufferDeviceAddressCaptureReplay;
+        VkBool32        bufferDeviceAddressMultiDevice;
+    } VkPhysicalDeviceBufferDeviceAddressFeaturesKHR;
+
+    typedef VkBufferDeviceAddressInfoEXT VkBufferDeviceAddressInfoKHR;
+
+    typedef VkDeviceAddress (VKAPI_PTR *PFN_vkGetBufferDeviceAddressKHR)(VkDevice device, const VkBufferDeviceAddressInfoKHR* pInfo);
+#endif
+
+/* Same goes for VK_KHR_deferred_host_operations. Anvil only needs the handle type, as it never
+ * defers acceleration structure operations to the host. */
+#if !defined(VK_KHR_deferred_host_operations)
+    #define VK_KHR_deferred_host_operations                1
+    #define VK_KHR_DEFERRED_HOST_OPERATIONS_SPEC_VERSION   4
+    #define VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME "VK_KHR_deferred_host_operations"
+
+    VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkDeferredOperationKHR)
+#endif
+
+/* Same goes for VK_KHR_acceleration_structure. */
+#if !defined(VK_KHR_acceleration_structure)
+    #define VK_KHR_acceleration_structure                1
+    #define VK_KHR_ACCELERATION_STRUCTURE_SPEC_VERSION   13
+    #define VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME "VK_KHR_acceleration_structure"
+
+    VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkAccelerationStructureKHR)
+
+    #define VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR        static_cast<VkStructureType>(1000150000)
+    #define VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR        static_cast<VkStructureType>(1000150002)
+    #define VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_AABBS_DATA_KHR        static_cast<VkStructureType>(1000150003)
+    #define VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR    static_cast<VkStructureType>(1000150004)
+    #define VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_TRIANGLES_DATA_KHR    static_cast<VkStructureType>(1000150005)
+    #define VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR                   static_cast<VkStructureType>(1000150006)
+    #define VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_INFO_KHR                  static_cast<VkStructureType>(1000150010)
+    #define VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR   static_cast<VkStructureType>(1000150013)
+    #define VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_PROPERTIES_KHR static_cast<VkStructureType>(1000150014)
+    #define VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR                static_cast<VkStructureType>(1000150017)
+    #define VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR           static_cast<VkStructureType>(1000150020)
+
+    #define VK_DEBUG_REPORT_OBJECT_TYPE_ACCELERATION_STRUCTURE_KHR_EXT  static_cast<VkDebugReportObjectTypeEXT>(1000150000)
+    #define VK_OBJECT_TYPE_ACCELERATION_STRUCTURE_KHR                   static_cast<VkObjectType>(1000150000)
+    #define VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR     static_cast<VkQueryType>(1000150000)
+    #define VK_QUERY_TYPE_ACCELERATION_STRUCTURE_SERIALIZATION_SIZE_KHR static_cast<VkQueryType>(1000150001)
+
+    #define VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR                        static_cast<VkAccessFlags>(0x00200000)
+    #define VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR                       static_cast<VkAccessFlags>(0x00400000)
+    #define VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR static_cast<VkBufferUsageFlags>(0x00080000)
+    #define VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR               static_cast<VkBufferUsageFlags>(0x00100000)
+    #define VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR               static_cast<VkPipelineStageFlags>(0x02000000)
+
+    typedef enum VkAccelerationStructureTypeKHR
+    {
+        VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR    = 0,
+        VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR = 1,
+        VK_ACCELERATION_STRUCTURE_TYPE_GENERIC_KHR      = 2,
+        VK_ACCELERATION_STRUCTURE_TYPE_MAX_ENUM_KHR     = 0x7FFFFFFF
+    } VkAccelerationStructureTypeKHR;
+
+    typedef enum VkAccelerationStructureBuildTypeKHR
+    {
+        VK_ACCELERATION_STRUCTURE_BUILD_TYPE_HOST_KHR           = 0,
+        VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR         = 1,
+        VK_ACCELERATION_STRUCTURE_BUILD_TYPE_HOST_OR_DEVICE_KHR = 2,
+        VK_ACCELERATION_STRUCTURE_BUILD_TYPE_MAX_ENUM_KHR       = 0x7FFFFFFF
+    } VkAccelerationStructureBuildTypeKHR;
+
+    typedef enum VkBuildAccelerationStructureModeKHR
+    {
+        VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR    = 0,
+        VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR   = 1,
+        VK_BUILD_ACCELERATION_STRUCTURE_MODE_MAX_ENUM_KHR = 0x7FFFFFFF
+    } VkBuildAccelerationStructureModeKHR;
+
+    typedef enum VkCopyAccelerationStructureModeKHR
+    {
+        VK_COPY_ACCELERATION_STRUCTURE_MODE_CLONE_KHR       = 0,
+        VK_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR     = 1,
+        VK_COPY_ACCELERATION_STRUCTURE_MODE_SERIALIZE_KHR   = 2,
+        VK_COPY_ACCELERATION_STRUCTURE_MODE_DESERIALIZE_KHR = 3,
+        VK_COPY_ACCELERATION_STRUCTURE_MODE_MAX_ENUM_KHR    = 0x7FFFFFFF
+    } VkCopyAccelerationStructureModeKHR;
+
+    typedef enum VkGeometryTypeKHR
+    {
+        VK_GEOMETRY_TYPE_TRIANGLES_KHR = 0,
+        VK_GEOMETRY_TYPE_AABBS_KHR     = 1,
+        VK_GEOMETRY_TYPE_INSTANCES_KHR = 1000150000,
+        VK_GEOMETRY_TYPE_MAX_ENUM_KHR  = 0x7FFFFFFF
+    } VkGeometryTypeKHR;
+
+    typedef enum VkAccelerationStructureCreateFlagBitsKHR
+    {
+        VK_ACCELERATION_STRUCTURE_CREATE_DEVICE_ADDRESS_CAPTURE_REPLAY_BIT_KHR = 0x00000001,
+        VK_ACCELERATION_STRUCTURE_CREATE_FLAG_BITS_MAX_ENUM_KHR                = 0x7FFFFFFF
+    } VkAccelerationStructureCreateFlagBitsKHR;
+    typedef VkFlags VkAccelerationStructureCreateFlagsKHR;
+
+    typedef enum VkBuildAccelerationStructureFlagBitsKHR
+    {
+        VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR      = 0x00000001,
+        VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR  = 0x00000002,
+        VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR = 0x00000004,
+        VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_BUILD_BIT_KHR = 0x00000008,
+        VK_BUILD_ACCELERATION_STRUCTURE_LOW_MEMORY_BIT_KHR        = 0x00000010,
+        VK_BUILD_ACCELERATION_STRUCTURE_FLAG_BITS_MAX_ENUM_KHR    = 0x7FFFFFFF
+    } VkBuildAccelerationStructureFlagBitsKHR;
+    typedef VkFlags VkBuildAccelerationStructureFlagsKHR;
+
+    typedef enum VkGeometryFlagBitsKHR
+    {
+        VK_GEOMETRY_OPAQUE_BIT_KHR                          = 0x00000001,
+        VK_GEOMETRY_NO_DUPLICATE_ANY_HIT_INVOCATION_BIT_KHR = 0x00000002,
+        VK_GEOMETRY_FLAG_BITS_MAX_ENUM_KHR                  = 0x7FFFFFFF
+    } VkGeometryFlagBitsKHR;
+    typedef VkFlags VkGeometryFlagsKHR;
+
+    typedef enum VkGeometryInstanceFlagBitsKHR
+    {
+        VK_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR = 0x00000001,
+        VK_GEOMETRY_INSTANCE_TRIANGLE_FLIP_FACING_BIT_KHR         = 0x00000002,
+        VK_GEOMETRY_INSTANCE_FORCE_OPAQUE_BIT_KHR                 = 0x00000004,
+        VK_GEOMETRY_INSTANCE_FORCE_NO_OPAQUE_BIT_KHR              = 0x00000008,
+        VK_GEOMETRY_INSTANCE_FLAG_BITS_MAX_ENUM_KHR               = 0x7FFFFFFF
+    } VkGeometryInstanceFlagBitsKHR;
+    typedef VkFlags VkGeometryInstanceFlagsKHR;
+
+    typedef union VkDeviceOrHostAddressKHR
+    {
+        VkDeviceAddress deviceAddress;
+        void*           hostAddress;
+    } VkDeviceOrHostAddressKHR;
+
+    typedef union VkDeviceOrHostAddressConstKHR
+    {
+        VkDeviceAddress deviceAddress;
+        const void*     hostAddress;
+    } VkDeviceOrHostAddressConstKHR;
+
+    typedef struct VkAccelerationStructureBuildRangeInfoKHR
+    {
+        uint32_t primitiveCount;
+        uint32_t primitiveOffset;
+        uint32_t firstVertex;
+        uint32_t transformOffset;
+    } VkAccelerationStructureBuildRangeInfoKHR;
+
+    typedef struct VkAccelerationStructureGeometryTrianglesDataKHR
+    {
+        VkStructureType               sType;
+        const void*                   pNext;
+        VkFormat                      vertexFormat;
+        VkDeviceOrHostAddressConstKHR vertexData;
+        VkDeviceSize                  vertexStride;
+        uint32_t                      maxVertex;
+        VkIndexType                   indexType;
+        VkDeviceOrHostAddressConstKHR indexData;
+        VkDeviceOrHostAddressConstKHR transformData;
+    } VkAccelerationStructureGeometryTrianglesDataKHR;
+
+    typedef struct VkAccelerationStructureGeometryAabbsDataKHR
+    {
+        VkStructureType               sType;
+        const void*                   pNext;
+        VkDeviceOrHostAddressConstKHR data;
+        VkDeviceSize                  stride;
+    } VkAccelerationStructureGeometryAabbsDataKHR;
+
+    typedef struct VkAccelerationStructureGeometryInstancesDataKHR
+    {
+        VkStructureType               sType;
+        const void*                   pNext;
+        VkBool32                      arrayOfPointers;
+        VkDeviceOrHostAddressConstKHR data;
+    } VkAccelerationStructureGeometryInstancesDataKHR;
+
+    typedef union VkAccelerationStructureGeometryDataKHR
+    {
+        VkAccelerationStructureGeometryTrianglesDataKHR triangles;
+        VkAccelerationStructureGeometryAabbsDataKHR     aabbs;
+        VkAccelerationStructureGeometryInstancesDataKHR instances;
+    } VkAccelerationStructureGeometryDataKHR;
+
+    typedef struct VkAccelerationStructureGeometryKHR
+    {
+        VkStructureType                        sType;
+        const void*                            pNext;
+        VkGeometryTypeKHR                      geometryType;
+        VkAccelerationStructureGeometryDataKHR geometry;
+        VkGeometryFlagsKHR                     flags;
+    } VkAccelerationStructureGeometryKHR;
+
+    typedef struct VkAccelerationStructureBuildGeometryInfoKHR
+    {
+        VkStructureType                                  sType;
+        const void*                                      pNext;
+        VkAccelerationStructureTypeKHR                   type;
+        VkBuildAccelerationStructureFlagsKHR             flags;
+        VkBuildAccelerationStructureModeKHR              mode;
+        VkAccelerationStructureKHR                       srcAccelerationStructure;
+        VkAccelerationStructureKHR                       dstAccelerationStructure;
+        uint32_t                                         geometryCount;
+        const VkAccelerationStructureGeometryKHR*        pGeometries;
+        const VkAccelerationStructureGeometryKHR* const* ppGeometries;
+        VkDeviceOrHostAddressKHR                         scratchData;
+    } VkAccelerationStructureBuildGeometryInfoKHR;
+
+    typedef struct VkAccelerationStructureBuildSizesInfoKHR
+    {
+        VkStructureType sType;
+        const void*     pNext;
+        VkDeviceSize    accelerationStructureSize;
+        VkDeviceSize    updateScratchSize;
+        VkDeviceSize    buildScratchSize;
+    } VkAccelerationStructureBuildSizesInfoKHR;
+
+    typedef struct VkAccelerationStructureCreateInfoKHR
+    {
+        VkStructureType                       sType;
+        const void*                           pNext;
+        VkAccelerationStructureCreateFlagsKHR createFlags;
+        VkBuffer                              buffer;
+        VkDeviceSize                          offset;
+        VkDeviceSize                          size;
+        VkAccelerationStructureTypeKHR        type;
+        VkDeviceAddress                       deviceAddress;
+    } VkAccelerationStructureCreateInfoKHR;
+
+    typedef struct VkAccelerationStructureDeviceAddressInfoKHR
+    {
+        VkStructureType            sType;
+        const void*                pNext;
+        VkAccelerationStructureKHR accelerationStructure;
+    } VkAccelerationStructureDeviceAddressInfoKHR;
+
+    typedef struct VkTransformMatrixKHR
+    {
+        float matrix[3][4];
+    } VkTransformMatrixKHR;
+
+    typedef struct VkAccelerationStructureInstanceKHR
+    {
+        VkTransformMatrixKHR       transform;
+        uint32_t                   instanceCustomIndex                    : 24;
+        uint32_t                   mask                                   : 8;
+        uint32_t                   instanceShaderBindingTableRecordOffset : 24;
+        VkGeometryInstanceFlagsKHR flags                                  : 8;
+        uint64_t                   accelerationStructureReference;
+    } VkAccelerationStructureInstanceKHR;
+
+    typedef struct VkCopyAccelerationStructureInfoKHR
+    {
+        VkStructureType                    sType;
+        const void*                        pNext;
+        VkAccelerationStructureKHR         src;
+        VkAccelerationStructureKHR         dst;
+        VkCopyAccelerationStructureModeKHR mode;
+    } VkCopyAccelerationStructureInfoKHR;
+
+    typedef struct VkPhysicalDeviceAccelerationStructureFeaturesKHR
+    {
+        VkStructureType sType;
+        void*           pNext;
+        VkBool32        accelerationStructure;
+        VkBool32        accelerationStructureCaptureReplay;
+        VkBool32        accelerationStructureIndirectBuild;
+        VkBool32        accelerationStructureHostCommands;
+        VkBool32        descriptorBindingAccelerationStructureUpdateAfterBind;
+    } VkPhysicalDeviceAccelerationStructureFeaturesKHR;
+
+    typedef VkResult (VKAPI_PTR *PFN_vkCreateAccelerationStructureKHR)(VkDevice device, const VkAccelerationStructureCreateInfoKHR* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkAccelerationStructureKHR* pAccelerationStructure);
+    typedef void (VKAPI_PTR *PFN_vkDestroyAccelerationStructureKHR)(VkDevice device, VkAccelerationStructureKHR accelerationStructure, const VkAllocationCallbacks* pAllocator);
+    typedef void (VKAPI_PTR *PFN_vkCmdBuildAccelerationStructuresKHR)(VkCommandBuffer commandBuffer, uint32_t infoCount, const VkAccelerationStructureBuildGeometryInfoKHR* pInfos, const VkAccelerationStructureBuildRangeInfoKHR* const* ppBuildRangeInfos);
+    typedef void (VKAPI_PTR *PFN_vkCmdCopyAccelerationStructureKHR)(VkCommandBuffer commandBuffer, const VkCopyAccelerationStructureInfoKHR* pInfo);
+    typedef void (VKAPI_PTR *PFN_vkCmdWriteAccelerationStructuresPropertiesKHR)(VkCommandBuffer commandBuffer, uint32_t accelerationStructureCount, const VkAccelerationStructureKHR* pAccelerationStructures, VkQueryType queryType, VkQueryPool queryPool, uint32_t firstQuery);
+    typedef VkDeviceAddress (VKAPI_PTR *PFN_vkGetAccelerationStructureDeviceAddressKHR)(VkDevice device, const VkAccelerationStructureDeviceAddressInfoKHR* pInfo);
+    typedef void (VKAPI_PTR *PFN_vkGetAccelerationStructureBuildSizesKHR)(VkDevice device, VkAccelerationStructureBuildTypeKHR buildType, const VkAccelerationStructureBuildGeometryInfoKHR* pBuildInfo, const uint32_t* pMaxPrimitiveCounts, VkAccelerationStructureBuildSizesInfoKHR* pSizeInfo);
+#endif
+
+/* Same goes for VK_EXT_host_image_copy. Only the memory->image copy and host layout transition bits are
+ * declared, as Anvil does not use the other entrypoints. */
+#if !defined(VK_EXT_host_image_copy)
+    #define VK_EXT_host_image_copy                1
+    #define VK_EXT_HOST_IMAGE_COPY_SPEC_VERSION   1
+    #define VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME "VK_EXT_host_image_copy"
+
+    #define VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_FEATURES_EXT static_cast<VkStructureType>(1000270000)
+    #define VK_STRUCTURE_TYPE_MEMORY_TO_IMAGE_COPY_EXT                     static_cast<VkStructureType>(1000270002)
+    #define VK_STRUCTURE_TYPE_COPY_MEMORY_TO_IMAGE_INFO_EXT                static_cast<VkStructureType>(1000270005)
+    #define VK_STRUCTURE_TYPE_HOST_IMAGE_LAYOUT_TRANSITION_INFO_EXT        static_cast<VkStructureType>(1000270006)
+
+    #define VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT static_cast<VkImageUsageFlags>(0x00400000)
+
+    typedef VkFlags VkHostImageCopyFlagsEXT;
+
+    typedef struct VkPhysicalDeviceHostImageCopyFeaturesEXT
+    {
+        VkStructureType sType;
+        void*           pNext;
+        VkBool32        hostImageCopy;
+    } VkPhysicalDeviceHostImageCopyFeaturesEXT;
+
+    typedef struct VkMemoryToImageCopyEXT
+    {
+        VkStructureType          sType;
+        const void*              pNext;
+        const void*              pHostPointer;
+        uint32_t                 memoryRowLength;
+        uint32_t                 memoryImageHeight;
+        VkImageSubresourceLayers imageSubresource;
+        VkOffset3D               imageOffset;
+        VkExtent3D               imageExtent;
+    } VkMemoryToImageCopyEXT;
+
+    typedef struct VkCopyMemoryToImageInfoEXT
+    {
+        VkStructureType               sType;
+        const void*                   pNext;
+        VkHostImageCopyFlagsEXT       flags;
+        VkImage                       dstImage;
+        VkImageLayout                 dstImageLayout;
+        uint32_t                      regionCount;
+        const VkMemoryToImageCopyEXT* pRegions;
+    } VkCopyMemoryToImageInfoEXT;
+
+    typedef struct VkHostImageLayoutTransitionInfoEXT
+    {
+        VkStructureType         sType;
+        const void*             pNext;
+        VkImage                 image;
+        VkImageLayout           oldLayout;
+        VkImageLayout           newLayout;
+        VkImageSubresourceRange subresourceRange;
+    } VkHostImageLayoutTransitionInfoEXT;
+
+    typedef VkResult (VKAPI_PTR *PFN_vkCopyMemoryToImageEXT)    (VkDevice device, const VkCopyMemoryToImageInfoEXT* pCopyMemoryToImageInfo);
+    typedef VkResult (VKAPI_PTR *PFN_vkTransitionImageLayoutEXT)(VkDevice device, uint32_t transitionCount, const VkHostImageLayoutTransitionInfoEXT* pTransitions);
+#endif
+
 namespace Anvil
 {
     /* Anvil::Vulkan exposes raw pointers to Vulkan entrypoints.
      *
      * These func ptrs are initialized, first time a Vulkan instance is created. Applications MUST NOT
      * assume the entrypoints are available prior to the time.
+     *
+     * Device-level entrypoints exposed here go through the loader's dispatch trampoline. Anvil wrappers call
+     * the per-device func ptrs returned by BaseDevice::get_dispatch_table() instead.
      */
     namespace Vulkan
     {
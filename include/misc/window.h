@@ -32,6 +32,9 @@
 #include "misc/ref_counter.h"
 #include "misc/types.h"
 #include "misc/debug.h"
+#include <atomic>
+#include <thread>
+#include <vector>
 
 namespace Anvil
 {
@@ -95,6 +98,50 @@ namespace Anvil
         WINDOW_PLATFORM_UNKNOWN = WINDOW_PLATFORM_COUNT
     };
 
+    /* Enumerates events delivered by windows whose message pump runs on a dedicated thread.
+     *
+     * Please see WindowFactory::create_window_with_event_thread() for more details.
+     */
+    enum WindowEventType
+    {
+        /* The user has requested the window to be closed. The window stays open until the app calls close(). */
+        WINDOW_EVENT_TYPE_CLOSE_REQUESTED,
+
+        /* The user has released a pressed key. WindowEvent::key_id holds ID of the key. */
+        WINDOW_EVENT_TYPE_KEYPRESS_RELEASED,
+
+        /* The window has been resized. WindowEvent::width and WindowEvent::height hold the new size. */
+        WINDOW_EVENT_TYPE_RESIZED,
+
+        WINDOW_EVENT_TYPE_UNKNOWN
+    };
+
+    typedef struct WindowEvent
+    {
+        KeyID           key_id;
+        uint32_t        height;
+        WindowEventType type;
+        uint32_t        width;
+
+        WindowEvent()
+            :key_id(KEY_ID_UNKNOWN),
+             height(0),
+             type  (WINDOW_EVENT_TYPE_UNKNOWN),
+             width (0)
+        {
+            /* Stub */
+        }
+
+        explicit WindowEvent(WindowEventType in_type)
+            :key_id(KEY_ID_UNKNOWN),
+             height(0),
+             type  (in_type),
+             width (0)
+        {
+            /* Stub */
+        }
+    } WindowEvent;
+
     class Window : public CallbacksSupportProvider
     {
     public:
@@ -132,6 +179,12 @@ namespace Anvil
         /** Returns system XCB connection, should be used by linux only */
         virtual void* get_connection() const { return nullptr; }
 
+        /** Returns the number of events which have been discarded, because the event queue was full. */
+        uint64_t get_n_dropped_events() const
+        {
+            return m_n_dropped_events.load();
+        }
+
         /** Returns system window handle. */
         WindowHandle get_handle() const
         {
@@ -153,12 +206,30 @@ namespace Anvil
             return m_width;
         }
 
+        /** Tells whether the window's message pump runs on a dedicated thread. */
+        bool is_event_thread_enabled() const
+        {
+            return m_is_event_thread_enabled;
+        }
+
+        /** Pops the oldest pending event off the window's event queue. Never blocks.
+         *
+         *  Events are only queued for windows created with WindowFactory::create_window_with_event_thread().
+         *  This function must not be called from more than one thread at a time.
+         *
+         *  @param out_event_ptr Deref will be set to the popped event, if any. Must not be null.
+         *
+         *  @return true if an event has been popped, false if the queue was empty.
+         */
+        bool poll_event(WindowEvent* out_event_ptr);
+
         /** Makes the window responsive to user's action and starts updating window contents.
          *
          *  This function will *block* the calling thread. To unblock it, call close().
          *
          *  This function can only be called once throughout Window instance's lifetime.
          *  This function can only be called for window instances which have opened a system window.
+         *  This function must not be called for windows created with WindowFactory::create_window_with_event_thread().
          *
          **/
         virtual void run() = 0;
@@ -195,13 +266,38 @@ namespace Anvil
         WindowHandle    m_window;
         bool            m_window_owned;
 
+        /* Event thread state. Please see WindowFactory::create_window_with_event_thread() */
+        std::atomic<bool> m_event_thread_close_requested;
+        std::thread::id   m_event_thread_id;
+        bool              m_is_event_thread_enabled;
+
         /* protected functions */
 
+        /** Tells whether the caller should hand over closing the window to the event thread. */
+        bool should_delegate_close_to_event_thread() const
+        {
+            return m_is_event_thread_enabled                      &&
+                   std::this_thread::get_id() != m_event_thread_id;
+        }
+
+        void join_event_thread();
+
+        /** Pushes @param in_event onto the event queue. Must only be called from the event thread. */
+        void push_event(const WindowEvent& in_event);
+
     private:
         /* Private functions */
 
-    /* Private variables */
+        /* Private variables */
+        static const uint32_t N_EVENT_QUEUE_SLOTS = 256;
+
+        std::vector<WindowEvent> m_event_queue;
+        std::atomic<uint32_t>    m_event_queue_read_index;
+        std::atomic<uint32_t>    m_event_queue_write_index;
+        std::thread              m_event_thread;
+        std::atomic<uint64_t>    m_n_dropped_events;
 
+        friend class WindowFactory;
     };
 }; /* namespace Anvil */
 
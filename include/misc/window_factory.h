@@ -68,6 +68,36 @@ namespace Anvil
                                                     Anvil::PresentCallbackFunction in_present_callback_func,
                                                     bool                           in_visible               = true);
 
+        /* Creates a Window wrapper instance by opening a new system window on a dedicated thread, which then hosts
+         * the window's message pump. The app must NOT call run() for the returned window.
+         *
+         * Instead of rendering from within a present call-back, the app is expected to render from its own thread,
+         * at whatever rate it needs, and to poll window events with Window::poll_event(). Events are handed over
+         * with a lock-free queue, so polling never blocks the calling thread.
+         *
+         * Close requests made by the user are delivered as WINDOW_EVENT_TYPE_CLOSE_REQUESTED events. The window
+         * is only closed once the app calls Window::close(), or releases the window. Window call-backs, including
+         * WINDOW_CALLBACK_ID_ABOUT_TO_CLOSE, are invoked from the event thread. The thread which calls close()
+         * is blocked until the window has been closed.
+         *
+         * Dummy windows with PNG snapshots are not supported, as they need a present call-back.
+         *
+         * @param in_platform Window platform to use. See WindowPlatform documentation for more details.
+         * @param in_title    Title to use for the new window.
+         * @param in_width    Width of the new window.
+         * @param in_height   Height of the new window.
+         * @param in_closable Should the "close button" of the window be accesible to the user?
+         * @param in_visible  Should the created window be made visible at creation time?
+         *
+         * @return A new Window wrapper instance if successful, null otherwise.
+         **/
+        static Anvil::WindowUniquePtr create_window_with_event_thread(WindowPlatform     in_platform,
+                                                                      const std::string& in_title,
+                                                                      unsigned int       in_width,
+                                                                      unsigned int       in_height,
+                                                                      bool               in_closable,
+                                                                      bool               in_visible = true);
+
         /* Creates a Window wrapper instance using app-managed window handle.
          *
          * NOTE: The following restrictions apply:
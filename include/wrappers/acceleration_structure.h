@@ -0,0 +1,113 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a wrapper for a single VK_KHR_acceleration_structure acceleration structure. Implemented in order to:
+ *
+ *  - simplify life-time management of acceleration structures and their backing storage.
+ *  - let ObjectTracker detect leaking acceleration structure instances.
+ *
+ *  Each wrapper owns a dedicated storage buffer, which is allocated and bound at creation time.
+ **/
+#ifndef WRAPPERS_ACCELERATION_STRUCTURE_H
+#define WRAPPERS_ACCELERATION_STRUCTURE_H
+
+#include "misc/debug_marker.h"
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+
+namespace Anvil
+{
+    /** Wrapper class for Vulkan acceleration structures */
+    class AccelerationStructure : public DebugMarkerSupportProvider<AccelerationStructure>,
+                                  public MTSafetySupportProvider
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new AccelerationStructure instance.
+         *
+         *  Allocates the storage buffer, creates a single Vulkan acceleration structure on top of it and
+         *  registers the object in Object Tracker.
+         *
+         *  Requires VK_KHR_acceleration_structure and VK_KHR_buffer_device_address extensions.
+         */
+        static Anvil::AccelerationStructureUniquePtr create(Anvil::AccelerationStructureCreateInfoUniquePtr in_create_info_ptr);
+
+        /** Destructor.
+         *
+         *  Releases the Vulkan counterpart and unregisters the wrapper instance from the object tracker.
+         **/
+        virtual ~AccelerationStructure();
+
+        /** Retrieves a raw Vulkan handle for the underlying VkAccelerationStructureKHR instance. */
+        VkAccelerationStructureKHR get_acceleration_structure() const
+        {
+            return m_acceleration_structure;
+        }
+
+        /** Retrieves a pointer to the raw Vulkan handle for the underlying VkAccelerationStructureKHR instance. */
+        const VkAccelerationStructureKHR* get_acceleration_structure_ptr() const
+        {
+            return &m_acceleration_structure;
+        }
+
+        /** Returns the buffer which holds the acceleration structure's data. */
+        Anvil::Buffer* get_buffer() const
+        {
+            return m_buffer_ptr.get();
+        }
+
+        const Anvil::AccelerationStructureCreateInfo* get_create_info_ptr() const
+        {
+            return m_create_info_ptr.get();
+        }
+
+        /** Returns the device address of the acceleration structure, as reported by
+         *  vkGetAccelerationStructureDeviceAddressKHR(). Use it to reference bottom-level structures
+         *  from top-level instance data.
+         **/
+        VkDeviceAddress get_device_address() const
+        {
+            return m_device_address;
+        }
+
+    private:
+        /* Private functions */
+
+        /* Constructor. */
+        AccelerationStructure(Anvil::AccelerationStructureCreateInfoUniquePtr in_create_info_ptr);
+
+        AccelerationStructure           (const AccelerationStructure&);
+        AccelerationStructure& operator=(const AccelerationStructure&);
+
+        bool init                          ();
+        void release_acceleration_structure();
+
+        /* Private variables */
+        VkAccelerationStructureKHR                      m_acceleration_structure;
+        Anvil::BufferUniquePtr                          m_buffer_ptr;
+        Anvil::AccelerationStructureCreateInfoUniquePtr m_create_info_ptr;
+        VkDeviceAddress                                 m_device_address;
+    };
+}; /* namespace Anvil */
+
+#endif /* WRAPPERS_ACCELERATION_STRUCTURE_H */
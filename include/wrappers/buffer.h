@@ -38,6 +38,7 @@
 #include "misc/mt_safety.h"
 #include "misc/types.h"
 #include "misc/page_tracker.h"
+#include <unordered_map>
 
 namespace Anvil
 {
@@ -66,6 +67,16 @@ namespace Anvil
          **/
         BUFFER_CALLBACK_ID_MEMORY_BLOCK_NEEDED,
 
+        /* Call-back issued after the buffer's memory has been moved by MemoryAllocator::defragment().
+         *
+         * At this point, the buffer wrapper uses a new Vulkan buffer handle, bound to the new memory location.
+         * The old handle has been released. Recipients must update all descriptor sets and buffer views
+         * which referred to the old handle.
+         *
+         * callback_arg: Pointer to OnBufferMemoryMovedCallbackArgument instance.
+         **/
+        BUFFER_CALLBACK_ID_MEMORY_MOVED,
+
         /* Always last */
         BUFFER_CALLBACK_ID_COUNT
     };
@@ -82,6 +93,37 @@ namespace Anvil
 
         static Anvil::BufferUniquePtr create(Anvil::BufferCreateInfoUniquePtr in_create_info_ptr);
 
+        /** Disables access tracking for the buffer. */
+        void disable_state_tracking()
+        {
+            m_is_state_tracking_enabled = false;
+        }
+
+        /** Enables access tracking for the buffer.
+         *
+         *  Once enabled, command buffers update the tracked state whenever they record a command which refers to
+         *  the buffer directly: pipeline barriers, event waits, copies, fills, updates, index & vertex buffer binds,
+         *  as well as indirect draws and dispatches. The state is tracked for the buffer as a whole, regardless of
+         *  the regions accessed. Accesses made via descriptor sets are NOT tracked and need to be expressed with
+         *  CommandBufferBase::record_transition(), which also uses the tracked state to emit barriers only when
+         *  necessary.
+         *
+         *  The state is updated at recording time, so it only reflects the GPU-side state if command buffers are
+         *  submitted in the order they have been recorded in. Global memory barriers are not taken into account.
+         *
+         *  @param in_last_stage_mask  Stages the buffer has last been accessed at, or NONE if the buffer has not been
+         *                             accessed yet.
+         *  @param in_last_access_mask Access types the buffer has last been accessed with.
+         **/
+        void enable_state_tracking(Anvil::PipelineStageFlags in_last_stage_mask  = Anvil::PipelineStageFlagBits::NONE,
+                                   Anvil::AccessFlags        in_last_access_mask = Anvil::AccessFlagBits::NONE)
+        {
+            m_is_state_tracking_enabled = true;
+            m_tracked_state             = Anvil::ResourceAccessState(Anvil::ImageLayout::UNDEFINED,
+                                                                     in_last_stage_mask,
+                                                                     in_last_access_mask);
+        }
+
         /** Returns the lowest-level Buffer instance which stores the data exposed by this Buffer instance. */
         const Anvil::Buffer* get_base_buffer();
 
@@ -109,6 +151,33 @@ namespace Anvil
             return m_create_info_ptr.get();
         }
 
+        /** Returns the device address of the first byte of the buffer, as reported by vkGetBufferDeviceAddressKHR().
+         *  For child buffers, the start offset within the parent buffer is taken into account.
+         *
+         *  Requires VK_KHR_buffer_device_address to be enabled and the base buffer to have been created with
+         *  SHADER_DEVICE_ADDRESS_BIT_KHR usage. Since the address is only defined for buffers bound to memory,
+         *  this function bakes the memory block if needed, the same way get_buffer() does.
+         */
+        VkDeviceAddress get_device_address();
+
+        /** Returns a buffer view created for this buffer with the specified format and range.
+         *
+         *  Views are cached per buffer and keyed by (format, start offset, size), so binding the same texel
+         *  buffer range every frame does not create a new VkBufferView each time. Cached views are released
+         *  when the buffer is destroyed.
+         *
+         *  Do NOT release the returned view. It is owned by the buffer.
+         *
+         *  @param in_format       Format of the view.
+         *  @param in_start_offset Start offset of the view, relative to the start of this buffer.
+         *  @param in_size         Size of the view, or VK_WHOLE_SIZE.
+         *
+         *  @return Buffer view if successful, null otherwise.
+         **/
+        Anvil::BufferView* get_cached_view(Anvil::Format in_format,
+                                           VkDeviceSize  in_start_offset,
+                                           VkDeviceSize  in_size);
+
         /** Returns a pointer to the underlying memory block wrapper instance.
          *
          *  For non-sparse buffers, in case no memory block has been assigned to the buffer,
@@ -125,6 +194,9 @@ namespace Anvil
         /** Returns memory requirements for the buffer */
         VkMemoryRequirements get_memory_requirements() const;
 
+        /** Returns the number of views held by the view cache. */
+        uint32_t get_n_cached_views() const;
+
         /** Returns the number of memory blocks assigned to the buffer. */
         uint32_t get_n_memory_blocks() const;
 
@@ -133,6 +205,18 @@ namespace Anvil
             return m_page_tracker_ptr.get();
         }
 
+        /** Returns the tracked state of the buffer. Only meaningful if state tracking is enabled. */
+        const Anvil::ResourceAccessState& get_tracked_state() const
+        {
+            return m_tracked_state;
+        }
+
+        /** Tells whether access tracking is enabled for the buffer. */
+        bool is_state_tracking_enabled() const
+        {
+            return m_is_state_tracking_enabled;
+        }
+
         bool prefers_dedicated_allocation() const
         {
             return m_prefers_dedicated_allocation;
@@ -147,7 +231,13 @@ namespace Anvil
          *  If the buffer object uses non-mappable storage memory, a staging buffer using mappable memory will be created
          *  instead. User-specified region of the source buffer will then be copied into it by submitting a copy operation,
          *  executed either on the transfer queue (if available), or on the universal queue. Afterward, the staging buffer
-         *  will be released.
+         *  will be released. If the parent device has been created with a staging ring, a region of the ring is used
+         *  instead of a dedicated staging buffer, as long as the ring can accommodate the request. Large reads are split
+         *  into chunks, which go through a bounded, double-buffered staging window.
+         *
+         *  Sparse buffers, unless all their pages are backed by a single memory block, are always read through
+         *  the staging window. Only runs of resident pages are copied, with a single batched copy command per chunk.
+         *  Bytes which fall into non-resident pages are set to zero.
          *
          *  The function prototype without @param in_device_mask argument should be used for single-GPU devices only.
          *  The function prototype with @param in_device_mask argument should be used for multi-GPU devices only.
@@ -206,12 +296,18 @@ namespace Anvil
 
         /** See set_nonsparse_memory() for general documentation.
          *
-         *  This static function can be used to set buffer memory bindings in a batched manner.
+         *  This static function can be used to set buffer memory bindings in a batched manner. All bindings are
+         *  applied with a single vkBindBufferMemory2KHR() call.
+         *
+         *  Can be used for both single- and multi-GPU devices. Updates which specify physical devices require
+         *  VK_KHR_device_group to be supported by & enabled for the device.
+         *
+         *  All buffers must have been created for the same device.
          *
-         *  Can be used for both single- and multi-GPU devices.
-         *  Requires VK_KHR_device_group to be supported by & enabled for the device.
+         *  @param in_n_buffer_memory_binding_updates Number of items available under @param in_updates_ptr. Must not be 0.
+         *  @param in_updates_ptr                     Binding updates to apply. Must not be null.
          *
-         *  TODO
+         *  @return true if successful, false otherwise.
          **/
         static bool set_nonsparse_memory_multi(uint32_t                   in_n_buffer_memory_binding_updates,
                                                BufferMemoryBindingUpdate* in_updates_ptr);
@@ -225,7 +321,12 @@ namespace Anvil
          *  If the buffer object uses non-mappable storage memory, a staging buffer using mappable memory will be created
          *  instead. It will then be filled with user-specified data and used as a source for a copy operation which will
          *  transfer the new contents to the target buffer. The operation will be submitted via a transfer queue, if one
-         *  is available, or a universal queue otherwise.
+         *  is available, or a universal queue otherwise. Large writes are split into chunks, which go through a bounded,
+         *  double-buffered staging window, so that the staging memory usage does not grow with the write size.
+         *
+         *  Sparse buffers, unless all their pages are backed by a single memory block, are always written to through
+         *  the staging window. Only runs of resident pages are copied, with a single batched copy command per chunk.
+         *  Data which falls into non-resident pages is dropped.
          *
          *  This function must not be used to read data from buffers, whose memory backing comes from a multi-instance heap.
          *
@@ -238,7 +339,12 @@ namespace Anvil
          *  backing the buffer is not mappable, you MUST specify a queue instance that should be used to perform a buffer->buffer
          *  copy op. The queue MUST support transfer ops.
          *
-         *  This function blocks until the transfer completes.
+         *  This function blocks until the transfer completes, unless the parent device has been created with a staging ring
+         *  which could accommodate the request. In the latter case, the function returns as soon as the copy op has been
+         *  submitted. Please see DeviceCreateInfo::set_staging_ring_size() for more details.
+         *
+         *  Buffers whose memory was allocated with MAPPABLE_BIT | PREFER_DEVICE_LOCAL_BIT features are placed in
+         *  resizable BAR memory, if the platform exposes it. Such buffers live in VRAM and are written to directly.
          *
          *  @param in_start_offset   As per description. Must be smaller than the underlying memory object's size.
          *  @param in_size           As per description. @param in_start_offset + @param in_size must be lower than or
@@ -262,9 +368,14 @@ namespace Anvil
 
         Buffer(Anvil::BufferCreateInfoUniquePtr in_create_info_ptr);
 
-        bool init               ();
-        bool init_staging_buffer(const VkDeviceSize& in_size,
-                                 Anvil::Queue*       in_opt_queue_ptr);
+        Anvil::Queue* get_staging_queue(Anvil::Queue*               in_opt_queue_ptr,
+                                        Anvil::QueueFamilyFlagBits* out_queue_fam_bits_ptr) const;
+
+        VkResult create_buffer_vk   (VkBuffer*           out_buffer_ptr) const;
+        bool     init               ();
+        bool     init_staging_buffer(const VkDeviceSize& in_size,
+                                     Anvil::Queue*       in_opt_queue_ptr);
+        bool     on_memory_moved    ();
         bool set_memory_sparse  (MemoryBlock*        in_memory_block_ptr,
                                  bool                in_memory_block_owned_by_buffer,
                                  VkDeviceSize        in_memory_start_offset,
@@ -277,11 +388,26 @@ namespace Anvil
 
         bool is_memory_block_owned(const MemoryBlock* in_memory_block_ptr) const;
 
+        bool requires_resident_range_transfers() const;
+
+        bool transfer_via_staging_window(VkDeviceSize  in_start_offset,
+                                         VkDeviceSize  in_size,
+                                         uint32_t      in_device_mask,
+                                         Anvil::Queue* in_opt_queue_ptr,
+                                         const void*   in_opt_data_ptr,
+                                         void*         out_opt_data_ptr);
+
+        void update_tracked_state(Anvil::PipelineStageFlags in_stage_mask,
+                                  Anvil::AccessFlags        in_access_mask,
+                                  bool                      in_is_barrier);
+
         /* Private members */
         VkBuffer                                 m_buffer;
         VkMemoryRequirements                     m_buffer_memory_reqs;
         std::unique_ptr<Anvil::BufferCreateInfo> m_create_info_ptr;
 
+        std::unordered_map<uint64_t, std::vector<Anvil::BufferViewUniquePtr> > m_cached_views;
+
         Anvil::MemoryBlock*                  m_memory_block_ptr; // only used by non-sparse buffers
         std::unique_ptr<Anvil::PageTracker>  m_page_tracker_ptr; // only used by sparse buffers
         Anvil::BufferUniquePtr               m_staging_buffer_ptr;
@@ -291,7 +417,12 @@ namespace Anvil
         bool                              m_prefers_dedicated_allocation;
         bool                              m_requires_dedicated_allocation;
 
-        friend class Anvil::Queue; /* set_memory_sparse() */
+        bool                       m_is_state_tracking_enabled;
+        Anvil::ResourceAccessState m_tracked_state;
+
+        friend class Anvil::CommandBufferBase; /* update_tracked_state() */
+        friend class Anvil::MemoryAllocator;   /* on_memory_moved()      */
+        friend class Anvil::Queue;             /* set_memory_sparse()    */
 
         ANVIL_DISABLE_ASSIGNMENT_OPERATOR(Buffer);
         ANVIL_DISABLE_COPY_CONSTRUCTOR(Buffer);
@@ -36,12 +36,14 @@
 #define WRAPPERS_COMMAND_BUFFER_H
 
 #include "misc/callbacks.h"
+#include "misc/command_arena.h"
 #include "misc/debug_marker.h"
 #include "misc/io.h"
 #include "misc/mt_safety.h"
 #include "misc/types.h"
+#include <unordered_map>
 
-#ifdef _DEBUG
+#if defined(_DEBUG) || defined(ANVIL_STORE_COMMAND_BUFFER_COMMANDS)
     #define STORE_COMMAND_BUFFER_COMMANDS
 #endif
 
@@ -61,20 +63,25 @@ namespace Anvil
     /** Enumerates available Vulkan command buffer commands */
     typedef enum
     {
+        COMMAND_TYPE_BEGIN_CONDITIONAL_RENDERING_EXT,
         COMMAND_TYPE_BEGIN_RENDER_PASS,
         COMMAND_TYPE_BEGIN_RENDER_PASS_2_KHR,
         COMMAND_TYPE_BEGIN_QUERY,
         COMMAND_TYPE_BEGIN_QUERY_INDEXED_EXT,
+        COMMAND_TYPE_BEGIN_RENDERING_KHR,
         COMMAND_TYPE_BEGIN_TRANSFORM_FEEDBACK_EXT,
         COMMAND_TYPE_BIND_DESCRIPTOR_SETS,
         COMMAND_TYPE_BIND_INDEX_BUFFER,
         COMMAND_TYPE_BIND_PIPELINE,
+        COMMAND_TYPE_BIND_SHADING_RATE_IMAGE_NV,
         COMMAND_TYPE_BIND_TRANSFORM_FEEDBACK_BUFFERS_EXT,
         COMMAND_TYPE_BIND_VERTEX_BUFFER,
         COMMAND_TYPE_BLIT_IMAGE,
+        COMMAND_TYPE_BUILD_ACCELERATION_STRUCTURES_KHR,
         COMMAND_TYPE_CLEAR_ATTACHMENTS,
         COMMAND_TYPE_CLEAR_COLOR_IMAGE,
         COMMAND_TYPE_CLEAR_DEPTH_STENCIL_IMAGE,
+        COMMAND_TYPE_COPY_ACCELERATION_STRUCTURE_KHR,
         COMMAND_TYPE_COPY_BUFFER,
         COMMAND_TYPE_COPY_BUFFER_TO_IMAGE,
         COMMAND_TYPE_COPY_IMAGE,
@@ -95,17 +102,25 @@ namespace Anvil
         COMMAND_TYPE_DRAW_INDIRECT_BYTE_COUNT_EXT,
         COMMAND_TYPE_DRAW_INDIRECT_COUNT_AMD,
         COMMAND_TYPE_DRAW_INDIRECT_COUNT_KHR,
+        COMMAND_TYPE_DRAW_MESH_TASKS_INDIRECT_COUNT_NV,
+        COMMAND_TYPE_DRAW_MESH_TASKS_INDIRECT_NV,
+        COMMAND_TYPE_DRAW_MESH_TASKS_NV,
+        COMMAND_TYPE_END_CONDITIONAL_RENDERING_EXT,
         COMMAND_TYPE_END_QUERY,
         COMMAND_TYPE_END_QUERY_INDEXED_EXT,
         COMMAND_TYPE_END_RENDER_PASS,
         COMMAND_TYPE_END_RENDER_PASS_2_KHR,
+        COMMAND_TYPE_END_RENDERING_KHR,
         COMMAND_TYPE_END_TRANSFORM_FEEDBACK_EXT,
         COMMAND_TYPE_EXECUTE_COMMANDS,
         COMMAND_TYPE_FILL_BUFFER,
         COMMAND_TYPE_NEXT_SUBPASS,
         COMMAND_TYPE_NEXT_SUBPASS_2_KHR,
         COMMAND_TYPE_PIPELINE_BARRIER,
+        COMMAND_TYPE_PIPELINE_BARRIER_RAW,
         COMMAND_TYPE_PUSH_CONSTANTS,
+        COMMAND_TYPE_PUSH_DESCRIPTOR_SET_KHR,
+        COMMAND_TYPE_PUSH_DESCRIPTOR_SET_WITH_TEMPLATE_KHR,
         COMMAND_TYPE_RESET_EVENT,
         COMMAND_TYPE_RESET_QUERY_POOL,
         COMMAND_TYPE_RESOLVE_IMAGE,
@@ -121,8 +136,11 @@ namespace Anvil
         COMMAND_TYPE_SET_STENCIL_REFERENCE,
         COMMAND_TYPE_SET_STENCIL_WRITE_MASK,
         COMMAND_TYPE_SET_VIEWPORT,
+        COMMAND_TYPE_SET_VIEWPORT_SHADING_RATE_PALETTE_NV,
         COMMAND_TYPE_UPDATE_BUFFER,
         COMMAND_TYPE_WAIT_EVENTS,
+        COMMAND_TYPE_WAIT_EVENTS_RAW,
+        COMMAND_TYPE_WRITE_ACCELERATION_STRUCTURES_PROPERTIES_KHR,
         COMMAND_TYPE_WRITE_BUFFER_MARKER_AMD,
         COMMAND_TYPE_WRITE_TIMESTAMP,
 
@@ -215,6 +233,9 @@ namespace Anvil
         std::vector<Anvil::AttachmentSampleLocations> attachment_initial_sample_locations;
         std::vector<Anvil::SubpassSampleLocations>    post_subpass_sample_locations;
 
+        /* VK_KHR_imageless_framebuffer: */
+        std::vector<Anvil::ImageView*> attachment_image_view_ptrs;
+
         /** Constructor.
          *
          *  Arguments as per Vulkan API.
@@ -230,7 +251,9 @@ namespace Anvil
                                         const uint32_t&                         in_n_attachment_initial_sample_locations,
                                         const Anvil::AttachmentSampleLocations* in_attachment_initial_sample_locations_ptr,
                                         const uint32_t&                         in_n_post_subpass_sample_locations,
-                                        const Anvil::SubpassSampleLocations*    in_post_subpass_sample_locations_ptr);
+                                        const Anvil::SubpassSampleLocations*    in_post_subpass_sample_locations_ptr,
+                                        const uint32_t&                         in_n_attachment_image_views,
+                                        Anvil::ImageView* const*                in_attachment_image_view_ptrs);
 
         /** Destructor.
          *
@@ -260,7 +283,9 @@ namespace Anvil
                                    const uint32_t&                         in_n_attachment_initial_sample_locations,
                                    const Anvil::AttachmentSampleLocations* in_attachment_initial_sample_locations_ptr,
                                    const uint32_t&                         in_n_post_subpass_sample_locations,
-                                   const Anvil::SubpassSampleLocations*    in_post_subpass_sample_locations_ptr)
+                                   const Anvil::SubpassSampleLocations*    in_post_subpass_sample_locations_ptr,
+                                   const uint32_t&                         in_n_attachment_image_views,
+                                   Anvil::ImageView* const*                in_attachment_image_view_ptrs)
             :BeginRenderPassCommand(in_n_clear_values,
                                     in_clear_value_ptrs,
                                     in_fbo_ptr,
@@ -272,7 +297,9 @@ namespace Anvil
                                     in_n_attachment_initial_sample_locations,
                                     in_attachment_initial_sample_locations_ptr,
                                     in_n_post_subpass_sample_locations,
-                                    in_post_subpass_sample_locations_ptr)
+                                    in_post_subpass_sample_locations_ptr,
+                                    in_n_attachment_image_views,
+                                    in_attachment_image_view_ptrs)
         {
             type = CommandType::COMMAND_TYPE_BEGIN_RENDER_PASS_2_KHR;
         }
@@ -407,6 +434,53 @@ namespace Anvil
         }
     } PipelineBarrierCommand;
 
+    /** Maps objects referenced by stashed commands to objects which should be used in their place, when the
+     *  commands are replayed with CommandBufferBase::record_replay(). Objects without an entry are used as-is.
+     **/
+    typedef struct CommandReplayRemapTable
+    {
+        std::unordered_map<const Anvil::Buffer*,        Anvil::Buffer*>              buffers;
+        std::unordered_map<const Anvil::DescriptorSet*, const Anvil::DescriptorSet*> descriptor_sets;
+        std::unordered_map<const Anvil::Framebuffer*,   Anvil::Framebuffer*>         framebuffers;
+        std::unordered_map<const Anvil::Image*,         Anvil::Image*>               images;
+
+        /** Returns the buffer to use in place of @param in_buffer_ptr. */
+        Anvil::Buffer* get_buffer(Anvil::Buffer* in_buffer_ptr) const
+        {
+            auto iterator = buffers.find(in_buffer_ptr);
+
+            return (iterator != buffers.end() ) ? iterator->second
+                                                : in_buffer_ptr;
+        }
+
+        /** Returns the descriptor set to use in place of @param in_ds_ptr. */
+        const Anvil::DescriptorSet* get_descriptor_set(const Anvil::DescriptorSet* in_ds_ptr) const
+        {
+            auto iterator = descriptor_sets.find(in_ds_ptr);
+
+            return (iterator != descriptor_sets.end() ) ? iterator->second
+                                                        : in_ds_ptr;
+        }
+
+        /** Returns the framebuffer to use in place of @param in_fbo_ptr. */
+        Anvil::Framebuffer* get_framebuffer(Anvil::Framebuffer* in_fbo_ptr) const
+        {
+            auto iterator = framebuffers.find(in_fbo_ptr);
+
+            return (iterator != framebuffers.end() ) ? iterator->second
+                                                     : in_fbo_ptr;
+        }
+
+        /** Returns the image to use in place of @param in_image_ptr. */
+        Anvil::Image* get_image(Anvil::Image* in_image_ptr) const
+        {
+            auto iterator = images.find(in_image_ptr);
+
+            return (iterator != images.end() ) ? iterator->second
+                                               : in_image_ptr;
+        }
+    } CommandReplayRemapTable;
+
     /** Implements base functionality of a command buffer object, such as common command registration
      *  support or validation. Also encapsulates command wrapper structure declarations.
      *
@@ -472,6 +546,24 @@ namespace Anvil
             return m_type;
         }
 
+        /** Returns the number of bind and dynamic state calls which have been skipped by the state filter,
+         *  since recording was last started. Please see set_state_filtering_enabled() for more details.
+         **/
+        uint32_t get_n_filtered_state_calls() const
+        {
+            return m_n_filtered_state_calls;
+        }
+
+        /** Returns the number of vkCmd* calls which have been issued for the command buffer, since recording was
+         *  last started. Calls skipped by the state filter or merged by barrier batching are not included.
+         *
+         *  Please see misc/perf_counters.h for process-wide counters.
+         **/
+        uint32_t get_n_recorded_commands() const
+        {
+            return m_n_recorded_commands;
+        }
+
         /** Returns the parent command pool */
         Anvil::CommandPool* get_parent_command_pool() const
         {
@@ -488,6 +580,48 @@ namespace Anvil
         void insert_debug_utils_label(const char*  in_label_name_ptr,
                                       const float* in_color_vec4_ptr);
 
+        /** Tells whether barrier batching is enabled for the command buffer. Please see
+         *  set_barrier_batching_enabled() for more details.
+         **/
+        bool is_barrier_batching_enabled() const
+        {
+            return m_barrier_batching_enabled;
+        }
+
+        /** Tells whether redundant state filtering is enabled for the command buffer. Please see
+         *  set_state_filtering_enabled() for more details.
+         **/
+        bool is_state_filtering_enabled() const
+        {
+            return m_state_filtering_enabled;
+        }
+
+        /** Issues a vkCmdBeginConditionalRenderingEXT() call and appends it to the internal vector of commands
+         *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
+         *  #define enabled).
+         *
+         *  Draws, dispatches and clears recorded until the matching record_end_conditional_rendering_EXT()
+         *  call are discarded by the GPU if the 32-bit value at @param in_offset in @param in_buffer_ptr is zero
+         *  (or non-zero, if INVERTED_BIT_EXT is specified). Combined with occlusion query results copied to
+         *  a buffer with record_copy_query_pool_results(), this lets the GPU skip work without a CPU round-trip.
+         *
+         *  The buffer must have been created with BufferUsageFlagBits::CONDITIONAL_RENDERING_BIT_EXT usage.
+         *  @param in_offset must be a multiple of 4.
+         *
+         *  Calling this function for a command buffer which has not been put into a recording mode
+         *  (by issuing a start_recording() call earlier) will result in an assertion failure.
+         *
+         *  Conditional rendering blocks cannot be nested. Doing so will result in an assertion failure.
+         *
+         *  This function is only available if VK_EXT_conditional_rendering is supported by the Vulkan
+         *  device AND if the extension has been requested at creation time.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool record_begin_conditional_rendering_EXT(Anvil::Buffer*                   in_buffer_ptr,
+                                                    VkDeviceSize                     in_offset,
+                                                    Anvil::ConditionalRenderingFlags in_flags = Anvil::ConditionalRenderingFlagBits::NONE);
+
         /** Issues a vkCmdBeginQuery() call and appends it to the internal vector of commands
          *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
          *  #define enabled).
@@ -521,6 +655,48 @@ namespace Anvil
                                         const Anvil::QueryControlFlags& in_flags,
                                         const uint32_t&                 in_index);
 
+        /** Issues a vkCmdBeginRenderingKHR() call and appends it to the internal vector of commands
+         *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
+         *  #define enabled).
+         *
+         *  Starts a dynamic rendering instance. Attachments are specified directly, so no RenderPass
+         *  or Framebuffer instance is needed. Graphics pipelines bound within the instance must have been
+         *  created with GraphicsPipelineCreateInfo::create_for_dynamic_rendering(), using formats which
+         *  match the attachments.
+         *
+         *  Calling this function for a command buffer which has not been put into a recording mode
+         *  (by issuing a start_recording() call earlier) will result in an assertion failure.
+         *
+         *  It is illegal to call this function when a renderpass or another dynamic rendering instance
+         *  is active. Doing so will also result in an assertion failure.
+         *
+         *  Attachment images are assumed to stay in the layouts specified for the attachments once the
+         *  instance ends.
+         *
+         *  This function is only available if VK_KHR_dynamic_rendering is supported by the Vulkan
+         *  device AND if the extension has been requested at creation time.
+         *
+         *  @param in_render_area              Render area to use.
+         *  @param in_layer_count              Number of layers rendered to. Must be 1 if @param in_view_mask is not 0.
+         *  @param in_view_mask                Multiview view mask.
+         *  @param in_n_color_attachments      Number of color attachments specified under @param in_opt_color_attachments_ptr.
+         *  @param in_opt_color_attachments_ptr Color attachments. Entries may have a null image view. May be null if
+         *                                     @param in_n_color_attachments is 0.
+         *  @param in_opt_depth_attachment_ptr Depth attachment. May be null.
+         *  @param in_opt_stencil_attachment_ptr Stencil attachment. May be null.
+         *  @param in_flags                    Rendering flags to use.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool record_begin_rendering_KHR(const VkRect2D&                       in_render_area,
+                                        uint32_t                              in_layer_count,
+                                        uint32_t                              in_view_mask,
+                                        uint32_t                              in_n_color_attachments,
+                                        const Anvil::RenderingAttachmentInfo* in_opt_color_attachments_ptr,
+                                        const Anvil::RenderingAttachmentInfo* in_opt_depth_attachment_ptr,
+                                        const Anvil::RenderingAttachmentInfo* in_opt_stencil_attachment_ptr,
+                                        Anvil::RenderingFlags                 in_flags = Anvil::RenderingFlagBits::NONE);
+
         /** Issues a vkCmdBeginTransformFeedbackEXT() call and appends it to the internal vector of commands
          *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
          *  #define enabled).
@@ -589,6 +765,26 @@ namespace Anvil
         bool record_bind_pipeline(Anvil::PipelineBindPoint in_pipeline_bind_point,
                                   Anvil::PipelineID        in_pipeline_id);
 
+        /** Issues a vkCmdBindShadingRateImageNV() call and appends it to the internal vector of commands
+         *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
+         *  #define enabled).
+         *
+         *  Calling this function for a command buffer which has not been put into a recording mode
+         *  (by issuing a start_recording() call earlier) will result in an assertion failure.
+         *
+         *  The image view must be of UINT8 format and its parent image must have been created with
+         *  ImageUsageFlagBits::SHADING_RATE_IMAGE_BIT_NV usage. Pass nullptr to unbind the image.
+         *  Shading rate images are only consulted by pipelines created with
+         *  GraphicsPipelineCreateInfo::toggle_shading_rate_image(true).
+         *
+         *  This function is only available if VK_NV_shading_rate_image is supported by the Vulkan device
+         *  AND if the extension has been requested at creation time.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool record_bind_shading_rate_image_NV(Anvil::ImageView*  in_opt_image_view_ptr,
+                                               Anvil::ImageLayout in_image_layout);
+
         /** Issues a vkCmdBindTransformFeedbackBuffersEXT() call and appends it to the internal vector of commands
          *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
          *  #define enabled).
@@ -647,6 +843,29 @@ namespace Anvil
                                const Anvil::ImageBlit* in_region_ptrs,
                                Anvil::Filter           in_filter);
 
+        /** Issues a vkCmdBuildAccelerationStructuresKHR() call and appends it to the internal vector of
+         *  commands recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
+         *  #define enabled).
+         *
+         *  Calling this function for a command buffer which has not been put into a recording mode
+         *  (by issuing a start_recording() call earlier) will result in an assertion failure.
+         *
+         *  It is also illegal to call this function when recording renderpass commands. Doing so
+         *  will also result in an assertion failure.
+         *
+         *  All builds passed in a single call execute without any implicit synchronization between them,
+         *  so they must not share scratch memory or depend on each other's results.
+         *
+         *  Argument meaning is as per VK_KHR_acceleration_structure specification.
+         *
+         *  Requires VK_KHR_acceleration_structure extension.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool record_build_acceleration_structures_KHR(uint32_t                                               in_n_infos,
+                                                      const VkAccelerationStructureBuildGeometryInfoKHR*     in_infos_ptr,
+                                                      const VkAccelerationStructureBuildRangeInfoKHR* const* in_build_range_infos_ptr);
+
         /** Issues a vkCmdClearAttachments() call and appends it to the internal vector of commands
          *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
          *  #define enabled).
@@ -706,6 +925,26 @@ namespace Anvil
                                               uint32_t                            in_range_count,
                                               const Anvil::ImageSubresourceRange* in_range_ptrs);
 
+        /** Issues a vkCmdCopyAccelerationStructureKHR() call and appends it to the internal vector of
+         *  commands recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
+         *  #define enabled).
+         *
+         *  Calling this function for a command buffer which has not been put into a recording mode
+         *  (by issuing a start_recording() call earlier) will result in an assertion failure.
+         *
+         *  It is also illegal to call this function when recording renderpass commands. Doing so
+         *  will also result in an assertion failure.
+         *
+         *  Argument meaning is as per VK_KHR_acceleration_structure specification.
+         *
+         *  Requires VK_KHR_acceleration_structure extension.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool record_copy_acceleration_structure_KHR(Anvil::AccelerationStructure*      in_src_ptr,
+                                                    Anvil::AccelerationStructure*      in_dst_ptr,
+                                                    VkCopyAccelerationStructureModeKHR in_mode);
+
         /** Issues a vkCmdCopyBuffer() call and appends it to the internal vector of commands
          *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
          *  #define enabled).
@@ -1104,6 +1343,90 @@ namespace Anvil
                                             uint32_t       in_max_draw_count,
                                             uint32_t       in_stride);
 
+        /** Issues a vkCmdDrawMeshTasksIndirectCountNV() call and appends it to the internal vector of commands
+         *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
+         *  #define enabled).
+         *
+         *  Calling this function for a command buffer which has not been put into a recording mode
+         *  (by issuing a start_recording() call earlier) will result in an assertion failure.
+         *
+         *  It is also illegal to call this function when not recording renderpass commands. Doing so
+         *  will also result in an assertion failure.
+         *
+         *  This function is only available if VK_NV_mesh_shader and VK_KHR_draw_indirect_count are
+         *  supported by the Vulkan device AND if both extensions have been requested at creation time.
+         *
+         *  Argument meaning is as per VK_NV_mesh_shader specification.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool record_draw_mesh_tasks_indirect_count_NV(Anvil::Buffer* in_buffer_ptr,
+                                                      VkDeviceSize   in_offset,
+                                                      Anvil::Buffer* in_count_buffer_ptr,
+                                                      VkDeviceSize   in_count_offset,
+                                                      uint32_t       in_max_draw_count,
+                                                      uint32_t       in_stride);
+
+        /** Issues a vkCmdDrawMeshTasksIndirectNV() call and appends it to the internal vector of commands
+         *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
+         *  #define enabled).
+         *
+         *  Calling this function for a command buffer which has not been put into a recording mode
+         *  (by issuing a start_recording() call earlier) will result in an assertion failure.
+         *
+         *  It is also illegal to call this function when not recording renderpass commands. Doing so
+         *  will also result in an assertion failure.
+         *
+         *  This function is only available if VK_NV_mesh_shader is supported by the Vulkan device
+         *  AND if the extension has been requested at creation time.
+         *
+         *  Argument meaning is as per VK_NV_mesh_shader specification.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool record_draw_mesh_tasks_indirect_NV(Anvil::Buffer* in_buffer_ptr,
+                                                VkDeviceSize   in_offset,
+                                                uint32_t       in_draw_count,
+                                                uint32_t       in_stride);
+
+        /** Issues a vkCmdDrawMeshTasksNV() call and appends it to the internal vector of commands
+         *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
+         *  #define enabled).
+         *
+         *  Calling this function for a command buffer which has not been put into a recording mode
+         *  (by issuing a start_recording() call earlier) will result in an assertion failure.
+         *
+         *  It is also illegal to call this function when not recording renderpass commands. Doing so
+         *  will also result in an assertion failure.
+         *
+         *  This function is only available if VK_NV_mesh_shader is supported by the Vulkan device
+         *  AND if the extension has been requested at creation time.
+         *
+         *  @param in_task_count Number of local workgroups to launch for the first stage of the
+         *                       bound mesh shading pipeline (task stage if present, mesh stage otherwise).
+         *  @param in_first_task Index of the first workgroup to launch.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool record_draw_mesh_tasks_NV(uint32_t in_task_count,
+                                       uint32_t in_first_task);
+
+        /** Issues a vkCmdEndConditionalRenderingEXT() call and appends it to the internal vector of commands
+         *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
+         *  #define enabled).
+         *
+         *  Ends a conditional rendering block started with record_begin_conditional_rendering_EXT().
+         *
+         *  Calling this function for a command buffer which has not been put into a recording mode
+         *  (by issuing a start_recording() call earlier) will result in an assertion failure.
+         *
+         *  This function is only available if VK_EXT_conditional_rendering is supported by the Vulkan
+         *  device AND if the extension has been requested at creation time.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool record_end_conditional_rendering_EXT();
+
         /** Issues a vkCmdEndQuery() call and appends it to the internal vector of commands
          *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
          *  #define enabled).
@@ -1135,6 +1458,22 @@ namespace Anvil
                                           const Anvil::QueryIndex& in_query,
                                           const uint32_t&          in_index);
 
+        /** Issues a vkCmdEndRenderingKHR() call and appends it to the internal vector of commands
+         *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
+         *  #define enabled).
+         *
+         *  Ends a dynamic rendering instance started with record_begin_rendering_KHR().
+         *
+         *  Calling this function for a command buffer which has not been put into a recording mode
+         *  (by issuing a start_recording() call earlier) will result in an assertion failure.
+         *
+         *  This function is only available if VK_KHR_dynamic_rendering is supported by the Vulkan
+         *  device AND if the extension has been requested at creation time.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool record_end_rendering_KHR();
+
         /** Issues a vkCmdEndTransformFeedbackEXT() call and appends it to the internal vector of commands
          *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
          *  #define enabled).
@@ -1178,6 +1517,10 @@ namespace Anvil
          *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
          *  #define enabled).
          *
+         *  If barrier batching is enabled, and no renderpass is active, the Vulkan call is deferred
+         *  and the barriers are merged with other pending barriers instead. Please see
+         *  set_barrier_batching_enabled() for more details.
+         *
          *  Calling this function for a command buffer which has not been put into a recording mode
          *  (by issuing a start_recording() call earlier) will result in an assertion failure.
          *
@@ -1195,6 +1538,28 @@ namespace Anvil
                                      uint32_t                   in_image_memory_barrier_count,
                                      const ImageBarrier*  const in_image_memory_barriers_ptr);
 
+        /** Same as record_pipeline_barrier(), but takes barriers which map 1:1 to their Vulkan counterparts.
+         *  The barrier arrays are handed over to Vulkan (or the barrier batcher) as-is, without any per-barrier
+         *  conversion. Use it for barrier-heavy workloads.
+         *
+         *  Since raw barriers do not refer to wrapper instances:
+         *
+         *  - tracked buffer & image state is NOT updated.
+         *  - COMMAND_BUFFER_CALLBACK_ID_PIPELINE_BARRIER_COMMAND_RECORDED call-back is NOT fired.
+         *  - replayed commands are NOT affected by the remap table passed to record_replay().
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool record_pipeline_barrier_raw(Anvil::PipelineStageFlags     in_src_stage_mask,
+                                         Anvil::PipelineStageFlags     in_dst_stage_mask,
+                                         Anvil::DependencyFlags        in_dependency_flags,
+                                         uint32_t                      in_memory_barrier_count,
+                                         const RawMemoryBarrier* const in_memory_barriers_ptr,
+                                         uint32_t                      in_buffer_memory_barrier_count,
+                                         const RawBufferBarrier* const in_buffer_memory_barriers_ptr,
+                                         uint32_t                      in_image_memory_barrier_count,
+                                         const RawImageBarrier*  const in_image_memory_barriers_ptr);
+
         /** Issues a vkCmdPushConstants() call and appends it to the internal vector of commands
          *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
          *  #define enabled).
@@ -1212,6 +1577,88 @@ namespace Anvil
                                    uint32_t                in_size,
                                    const void*             in_values);
 
+        /** Issues a vkCmdPushDescriptorSetKHR() call and appends it to the internal vector of commands
+         *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
+         *  #define enabled).
+         *
+         *  Calling this function for a command buffer which has not been put into a recording mode
+         *  (by issuing a start_recording() call earlier) will result in an assertion failure.
+         *
+         *  Requires VK_KHR_push_descriptor. The set at index @param in_set of @param in_layout_ptr must
+         *  use a DS layout created with DescriptorSetLayoutCreateFlagBits::PUSH_DESCRIPTOR_BIT_KHR.
+         *
+         *  @param in_pipeline_bind_point Pipeline bind point to push the descriptors for.
+         *  @param in_layout_ptr          Pipeline layout to use. Must not be null.
+         *  @param in_set                 Index of the push descriptor set in @param in_layout_ptr.
+         *  @param in_n_writes            Number of items available for reading under @param in_writes_ptr.
+         *  @param in_writes_ptr          Descriptors to push. Must not be null if @param in_n_writes is not 0.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool record_push_descriptor_set_KHR(Anvil::PipelineBindPoint          in_pipeline_bind_point,
+                                            Anvil::PipelineLayout*            in_layout_ptr,
+                                            uint32_t                          in_set,
+                                            uint32_t                          in_n_writes,
+                                            const Anvil::PushDescriptorWrite* in_writes_ptr);
+
+        /** Issues a vkCmdPushDescriptorSetWithTemplateKHR() call and appends it to the internal vector of
+         *  commands recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
+         *  #define enabled).
+         *
+         *  Calling this function for a command buffer which has not been put into a recording mode
+         *  (by issuing a start_recording() call earlier) will result in an assertion failure.
+         *
+         *  Requires VK_KHR_push_descriptor and VK_KHR_descriptor_update_template (or Vulkan 1.1).
+         *
+         *  @param in_template_ptr Template to use. Must have been created with
+         *                         DescriptorUpdateTemplate::create_for_push_descriptor_updates(). Must not be null.
+         *  @param in_layout_ptr   Pipeline layout to use. Must be compatible with the one the template has
+         *                         been created for. Must not be null.
+         *  @param in_set          Index of the push descriptor set in @param in_layout_ptr.
+         *  @param in_data_ptr     Descriptor data, laid out as described by the template entries. The data
+         *                         is consumed at call time.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool record_push_descriptor_set_with_template_KHR(const Anvil::DescriptorUpdateTemplate* in_template_ptr,
+                                                          Anvil::PipelineLayout*                 in_layout_ptr,
+                                                          uint32_t                               in_set,
+                                                          const void*                            in_data_ptr);
+
+        #ifdef STORE_COMMAND_BUFFER_COMMANDS
+            /** Re-emits all commands stashed by @param in_src_command_buffer_ptr into this command buffer.
+             *  Objects referenced by the stashed commands can be substituted with other objects by passing
+             *  a remap table, so that a static pass can be recorded once and then replayed every frame
+             *  against per-frame resources.
+             *
+             *  Binds, dynamic state, push constants, attachment clears, draws and dispatches are emitted straight
+             *  from the stash, without the validation performed by the corresponding record_*() functions, and
+             *  under a single command pool & command buffer lock. They are stashed by this command buffer with
+             *  substituted objects, so it can be replayed in turn.
+             *  All other commands are forwarded to their record_*() counterparts, so eg. barriers and copies
+             *  are still batched and tracked as usual.
+             *
+             *  Render pass, subpass and execute commands can only be replayed into a primary command buffer.
+             *  Copy query pool results, wait events, push descriptor set, transform feedback, indexed query,
+             *  indirect byte count, sample locations and buffer marker commands are not supported.
+             *
+             *  The source command buffer must not be modified while the commands are being replayed. The caller
+             *  is responsible for making sure substituted objects are compatible with the original ones.
+             *
+             *  Redundant state filtering does not track state across replayed commands. Any state bound before
+             *  the call is considered unknown afterward.
+             *
+             *  @param in_src_command_buffer_ptr Command buffer to replay stashed commands of. Must not be null
+             *                                   and must not be this command buffer.
+             *  @param in_opt_remap_table_ptr    If not null, objects listed in the table are used in place of
+             *                                   the objects referenced by the stashed commands.
+             *
+             *  @return true if all commands were replayed successfully, false otherwise.
+             **/
+            bool record_replay(const CommandBufferBase*       in_src_command_buffer_ptr,
+                               const CommandReplayRemapTable* in_opt_remap_table_ptr = nullptr);
+        #endif
+
         /** Issues a vkCmdResetEvent() call and appends it to the internal vector of commands
          *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
          *  #define enabled).
@@ -1442,6 +1889,68 @@ namespace Anvil
                                  uint32_t          in_viewport_count,
                                  const VkViewport* in_viewport_ptrs);
 
+        /** Issues a vkCmdSetViewportShadingRatePaletteNV() call and appends it to the internal vector of commands
+         *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
+         *  #define enabled).
+         *
+         *  Calling this function for a command buffer which has not been put into a recording mode
+         *  (by issuing a start_recording() call earlier) will result in an assertion failure.
+         *
+         *  Only affects pipelines created with DynamicState::VIEWPORT_SHADING_RATE_PALETTE_NV enabled. Other
+         *  pipelines use palettes specified with GraphicsPipelineCreateInfo::set_shading_rate_palette().
+         *
+         *  This function is only available if VK_NV_shading_rate_image is supported by the Vulkan device
+         *  AND if the extension has been requested at creation time.
+         *
+         *  Argument meaning is as per VK_NV_shading_rate_image specification.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool record_set_viewport_shading_rate_palette_NV(uint32_t                      in_first_viewport,
+                                                         uint32_t                      in_viewport_count,
+                                                         const VkShadingRatePaletteNV* in_palettes_ptr);
+
+        /** Transitions subresources of an image to a new layout and makes them available to the specified stages and
+         *  access types, using the image's tracked state. The image must have state tracking enabled.
+         *
+         *  Barriers are only recorded for subresources which are in a different layout, have been written to since they
+         *  were last synchronized, or are about to be written to after having been accessed. Consecutive layers of each mip
+         *  which share the same state are covered by a single barrier, and all barriers are recorded with a single
+         *  record_pipeline_barrier() call. If no subresource needs a barrier, no command is recorded.
+         *
+         *  The new state is also assumed to cover accesses made via descriptor sets between this and the next call,
+         *  so the function should be called before each use of the image which is not tracked automatically.
+         *
+         *  @param in_image_ptr                 Image to transition. Must not be null.
+         *  @param in_new_layout                Layout to transition the subresources to.
+         *  @param in_dst_stage_mask            Stages the subresources are going to be accessed at.
+         *  @param in_dst_access_mask           Access types the subresources are going to be accessed with.
+         *  @param in_opt_subresource_range_ptr Subresources to transition. If null, all subresources are transitioned.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool record_transition(Anvil::Image*                       in_image_ptr,
+                               Anvil::ImageLayout                  in_new_layout,
+                               Anvil::PipelineStageFlags           in_dst_stage_mask,
+                               Anvil::AccessFlags                  in_dst_access_mask,
+                               const Anvil::ImageSubresourceRange* in_opt_subresource_range_ptr = nullptr);
+
+        /** Makes a buffer available to the specified stages and access types, using the buffer's tracked state.
+         *  The buffer must have state tracking enabled.
+         *
+         *  A barrier is only recorded if the buffer has been written to since it was last synchronized, or is about
+         *  to be written to after having been accessed.
+         *
+         *  @param in_buffer_ptr      Buffer to synchronize. Must not be null.
+         *  @param in_dst_stage_mask  Stages the buffer is going to be accessed at.
+         *  @param in_dst_access_mask Access types the buffer is going to be accessed with.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool record_transition(Anvil::Buffer*            in_buffer_ptr,
+                               Anvil::PipelineStageFlags in_dst_stage_mask,
+                               Anvil::AccessFlags        in_dst_access_mask);
+
         /** Issues a vkCmdUpdateBuffer() call and appends it to the internal vector of commands
          *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
          *  #define enabled).
@@ -1484,6 +1993,44 @@ namespace Anvil
                                 uint32_t                   in_image_memory_barrier_count,
                                 const ImageBarrier* const  in_image_memory_barriers_ptr);
 
+        /** Same as record_wait_events(), but takes barriers which map 1:1 to their Vulkan counterparts.
+         *  Please see record_pipeline_barrier_raw() for more details.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool record_wait_events_raw(uint32_t                      in_event_count,
+                                    Anvil::Event* const*          in_event_ptrs,
+                                    Anvil::PipelineStageFlags     in_src_stage_mask,
+                                    Anvil::PipelineStageFlags     in_dst_stage_mask,
+                                    uint32_t                      in_memory_barrier_count,
+                                    const RawMemoryBarrier* const in_memory_barriers_ptr,
+                                    uint32_t                      in_buffer_memory_barrier_count,
+                                    const RawBufferBarrier* const in_buffer_memory_barriers_ptr,
+                                    uint32_t                      in_image_memory_barrier_count,
+                                    const RawImageBarrier*  const in_image_memory_barriers_ptr);
+
+        /** Issues a vkCmdWriteAccelerationStructuresPropertiesKHR() call and appends it to the internal vector
+         *  of commands recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
+         *  #define enabled).
+         *
+         *  Calling this function for a command buffer which has not been put into a recording mode
+         *  (by issuing a start_recording() call earlier) will result in an assertion failure.
+         *
+         *  It is also illegal to call this function when recording renderpass commands. Doing so
+         *  will also result in an assertion failure.
+         *
+         *  Argument meaning is as per VK_KHR_acceleration_structure specification.
+         *
+         *  Requires VK_KHR_acceleration_structure extension.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool record_write_acceleration_structures_properties_KHR(uint32_t                             in_n_acceleration_structures,
+                                                                 Anvil::AccelerationStructure* const* in_acceleration_structure_ptrs,
+                                                                 VkQueryType                          in_query_type,
+                                                                 Anvil::QueryPool*                    in_query_pool_ptr,
+                                                                 Anvil::QueryIndex                    in_first_query);
+
         /** Issues a vkCmdWriteBufferMarkerAMD() call and appends it to the internal vector of commands
          *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
          *  #define enabled).
@@ -1527,6 +2074,52 @@ namespace Anvil
          **/
         bool reset(bool in_should_release_resources);
 
+        /** Enables or disables barrier batching for the command buffer. Batching is disabled by default.
+         *
+         *  With batching enabled, record_pipeline_barrier() calls made outside renderpasses do not
+         *  issue vkCmdPipelineBarrier() immediately. Instead, their barriers are accumulated and
+         *  flushed with a single vkCmdPipelineBarrier() call, using the union of all stage masks,
+         *  right before the next command which may read or write resources (actions, copies, clears,
+         *  queries, events, renderpass commands, secondary command buffer execution, debug markers
+         *  and labels, as well as stop_recording()). State-setting commands (binds, dynamic state,
+         *  push constants and push descriptors) do not break the batch.
+         *
+         *  A barrier which refers to a buffer or an image already referenced by a pending barrier,
+         *  uses different dependency flags, or mixes global memory barriers with layout transitions
+         *  or queue family ownership transfers, flushes the pending barriers first.
+         *
+         *  Merging barriers can only widen the synchronization scopes, so the results are always
+         *  correct, but may be more conservative than the original barriers.
+         *
+         *  Disabling batching flushes all pending barriers.
+         *
+         *  @param in_enabled true to enable barrier batching, false to disable it.
+         **/
+        void set_barrier_batching_enabled(bool in_enabled);
+
+        /** Enables or disables redundant state filtering for the command buffer. Filtering is disabled by default.
+         *
+         *  With filtering enabled, the command buffer caches the state bound by record_bind_pipeline(),
+         *  record_bind_descriptor_sets(), record_bind_index_buffer(), record_bind_vertex_buffers() and
+         *  record_set_*() dynamic state calls. A call which would bind exactly the same state again is not
+         *  passed to the driver. get_n_filtered_state_calls() tells how many calls have been skipped.
+         *
+         *  The cache is conservative:
+         *
+         *  - Binding a graphics pipeline forgets all dynamic state which the pipeline does not declare as dynamic.
+         *  - Binding descriptor sets with a different pipeline layout forgets all sets bound for that bind point.
+         *  - Descriptor set binds which use dynamic offsets are never skipped.
+         *  - Pushing descriptors forgets the set bound at the push descriptor set index.
+         *  - Executing secondary command buffers, resetting the command buffer and starting recording forgets
+         *    everything.
+         *
+         *  State changed by calls made directly against the raw command buffer handle is not visible to the
+         *  cache. Filtering must be disabled if the app records such calls.
+         *
+         *  @param in_enabled true to enable state filtering, false to disable it.
+         **/
+        void set_state_filtering_enabled(bool in_enabled);
+
         /** Stops an ongoing command recording process.
          *
          *  It is an error to invoke this function if the command buffer has not been put
@@ -1536,17 +2129,25 @@ namespace Anvil
          **/
         bool stop_recording();
 
+        /* Number of handles / barriers record_*() functions convert to Vulkan structures in stack storage.
+         * Larger counts make the conversion fall back to the heap. */
+        static const uint32_t N_MAX_STACK_SCRATCH_ITEMS = 16;
+
     protected:
         /* Forward declarations */
+        struct BeginConditionalRenderingEXTCommand;
         struct BeginQueryCommand;
         struct BindDescriptorSetsCommand;
         struct BindIndexBufferCommand;
         struct BindPipelineCommand;
+        struct BindShadingRateImageNVCommand;
         struct BindVertexBuffersCommand;
         struct BlitImageCommand;
+        struct BuildAccelerationStructuresKHRCommand;
         struct ClearAttachmentsCommand;
         struct ClearColorImageCommand;
         struct ClearDepthStencilImageCommand;
+        struct CopyAccelerationStructureKHRCommand;
         struct CopyBufferCommand;
         struct CopyBufferToImageCommand;
         struct CopyImageCommand;
@@ -1560,12 +2161,16 @@ namespace Anvil
         struct DrawIndexedCommand;
         struct DrawIndirectCommand;
         struct DrawIndexedIndirectCommand;
+        struct EndConditionalRenderingEXTCommand;
         struct EndQueryCommand;
         struct EndQueryIndexedEXTCommand;
         struct ExecuteCommandsCommand;
         struct FillBufferCommand;
         struct NextSubpassCommand;
+        struct PipelineBarrierRawCommand;
         struct PushConstantsCommand;
+        struct PushDescriptorSetKHRCommand;
+        struct PushDescriptorSetWithTemplateKHRCommand;
         struct ResetEventCommand;
         struct ResetQueryPoolCommand;
         struct ResolveImageCommand;
@@ -1580,12 +2185,34 @@ namespace Anvil
         struct SetStencilReferenceCommand;
         struct SetStencilWriteMaskCommand;
         struct SetViewportCommand;
+        struct SetViewportShadingRatePaletteNVCommand;
         struct UpdateBufferCommand;
         struct WaitEventsCommand;
+        struct WaitEventsRawCommand;
+        struct WriteAccelerationStructuresPropertiesKHRCommand;
         struct WriteTimestampCommand;
 
         /* Protected type definitions */
 
+        /** Holds all arguments passed to a vkCmdBeginConditionalRenderingEXT() command */
+        typedef struct BeginConditionalRenderingEXTCommand : public Command
+        {
+            Anvil::Buffer*                   buffer_ptr;
+            Anvil::ConditionalRenderingFlags flags;
+            VkDeviceSize                     offset;
+
+            /** Constructor. */
+            explicit BeginConditionalRenderingEXTCommand(Anvil::Buffer*                   in_buffer_ptr,
+                                                         VkDeviceSize                     in_offset,
+                                                         Anvil::ConditionalRenderingFlags in_flags);
+
+            /** Destructor. */
+            virtual ~BeginConditionalRenderingEXTCommand()
+            {
+                /* Stub */
+            }
+        } BeginConditionalRenderingEXTCommand;
+
         /** Holds all arguments passed to a vkCmdBeginQuery() command */
         typedef struct BeginQueryCommand : public Command
         {
@@ -1606,14 +2233,48 @@ namespace Anvil
             }
         } BeginQueryCommand;
 
+        /** Holds all arguments passed to a vkCmdBeginRenderingKHR() command. */
+        typedef struct BeginRenderingKHRCommand : public Command
+        {
+            std::vector<Anvil::RenderingAttachmentInfo> color_attachments;
+            Anvil::RenderingAttachmentInfo              depth_attachment;
+            Anvil::RenderingFlags                       flags;
+            bool                                        has_depth_attachment;
+            bool                                        has_stencil_attachment;
+            uint32_t                                    layer_count;
+            VkRect2D                                    render_area;
+            Anvil::RenderingAttachmentInfo              stencil_attachment;
+            uint32_t                                    view_mask;
+
+            /** Constructor. */
+            explicit BeginRenderingKHRCommand(const VkRect2D&                       in_render_area,
+                                              uint32_t                              in_layer_count,
+                                              uint32_t                              in_view_mask,
+                                              uint32_t                              in_n_color_attachments,
+                                              const Anvil::RenderingAttachmentInfo* in_opt_color_attachments_ptr,
+                                              const Anvil::RenderingAttachmentInfo* in_opt_depth_attachment_ptr,
+                                              const Anvil::RenderingAttachmentInfo* in_opt_stencil_attachment_ptr,
+                                              Anvil::RenderingFlags                 in_flags);
+
+            /** Destructor. */
+            virtual ~BeginRenderingKHRCommand()
+            {
+                /* Stub */
+            }
+
+        private:
+            BeginRenderingKHRCommand           (const BeginRenderingKHRCommand&);
+            BeginRenderingKHRCommand& operator=(const BeginRenderingKHRCommand&);
+        } BeginRenderingKHRCommand;
+
         /** Holds all arguments passed to a vkCmdBindDescriptorSets() command. */
         typedef struct BindDescriptorSetsCommand : public Command
         {
-            std::vector<const Anvil::DescriptorSet*> descriptor_sets;
-            std::vector<uint32_t>                    dynamic_offsets;
-            uint32_t                                 first_set;
-            Anvil::PipelineLayout*                   layout_ptr;
-            Anvil::PipelineBindPoint                 pipeline_bind_point;
+            Anvil::CommandArenaVector<const Anvil::DescriptorSet*> descriptor_sets;
+            Anvil::CommandArenaVector<uint32_t>                    dynamic_offsets;
+            uint32_t                                               first_set;
+            Anvil::PipelineLayout*                                 layout_ptr;
+            Anvil::PipelineBindPoint                               pipeline_bind_point;
 
             /** Constructor. **/
             explicit BindDescriptorSetsCommand(Anvil::PipelineBindPoint           in_pipeline_bind_point,
@@ -1622,7 +2283,8 @@ namespace Anvil
                                                uint32_t                           in_set_count,
                                                const Anvil::DescriptorSet* const* in_descriptor_set_ptrs,
                                                uint32_t                           in_dynamic_offset_count,
-                                               const uint32_t*                    in_dynamic_offset_ptrs);
+                                               const uint32_t*                    in_dynamic_offset_ptrs,
+                                               Anvil::CommandArena*               in_arena_ptr);
 
             /** Destructor. */
             virtual ~BindDescriptorSetsCommand()
@@ -1681,6 +2343,26 @@ namespace Anvil
             }
         } BindPipelineCommand;
 
+        /** Holds all arguments passed to a vkCmdBindShadingRateImageNV() command. **/
+        typedef struct BindShadingRateImageNVCommand : public Command
+        {
+            Anvil::ImageLayout image_layout;
+            Anvil::ImageView*  image_view_ptr;
+
+            /** Constructor.
+             *
+             *  Arguments as per VK_NV_shading_rate_image.
+             **/
+            explicit BindShadingRateImageNVCommand(Anvil::ImageView*  in_opt_image_view_ptr,
+                                                   Anvil::ImageLayout in_image_layout);
+
+            /* Destructor. */
+            virtual ~BindShadingRateImageNVCommand()
+            {
+                 /* Stub */
+            }
+        } BindShadingRateImageNVCommand;
+
 
         /** Holds a single vertex buffer binding, as specified by "in_buffer_ptrs" and "in_offset_ptrs"
          *  argment arrays, passed to a vkCmdBindVertexBuffers() call.
@@ -1710,14 +2392,15 @@ namespace Anvil
         /** Holds all arguments passed to a vkCmdBindVertexBuffers() command. */
         typedef struct BindVertexBuffersCommand : public Command
         {
-            std::vector<BindVertexBuffersCommandBinding> bindings;
-            uint32_t                                     start_binding;
+            Anvil::CommandArenaVector<BindVertexBuffersCommandBinding> bindings;
+            uint32_t                                                   start_binding;
 
             /** Constructor. **/
-            explicit BindVertexBuffersCommand(uint32_t            in_start_binding,
-                                              uint32_t            in_binding_count,
-                                              Anvil::Buffer**     in_buffer_ptrs,
-                                              const VkDeviceSize* in_offset_ptrs);
+            explicit BindVertexBuffersCommand(uint32_t             in_start_binding,
+                                              uint32_t             in_binding_count,
+                                              Anvil::Buffer**      in_buffer_ptrs,
+                                              const VkDeviceSize*  in_offset_ptrs,
+                                              Anvil::CommandArena* in_arena_ptr);
 
             /** Destructor. */
             virtual ~BindVertexBuffersCommand()
@@ -1736,8 +2419,8 @@ namespace Anvil
             Anvil::ImageLayout src_image_layout;
             Anvil::Image*      src_image_ptr;
 
-            Anvil::Filter                 filter;
-            std::vector<Anvil::ImageBlit> regions;
+            Anvil::Filter                               filter;
+            Anvil::CommandArenaVector<Anvil::ImageBlit> regions;
 
             /** Constructor. */
             explicit BlitImageCommand(Anvil::Image*           in_src_image_ptr,
@@ -1746,7 +2429,8 @@ namespace Anvil
                                       Anvil::ImageLayout      in_dst_image_layout,
                                       uint32_t                in_region_count,
                                       const Anvil::ImageBlit* in_region_ptrs,
-                                      Anvil::Filter           in_filter);
+                                      Anvil::Filter           in_filter,
+                                      Anvil::CommandArena*    in_arena_ptr);
 
             /** Destructor. */
             virtual ~BlitImageCommand()
@@ -1758,6 +2442,33 @@ namespace Anvil
             BlitImageCommand& operator=(const BlitImageCommand&);
         } BlitImageCommand;
 
+        /** Holds all arguments passed to a vkCmdBuildAccelerationStructuresKHR() command.
+         *
+         *  Geometry descriptors and build ranges of all builds are deep-copied into flat arrays. The stored
+         *  build infos have their geometry pointers patched to point at the copies.
+         **/
+        typedef struct BuildAccelerationStructuresKHRCommand : public Command
+        {
+            Anvil::CommandArenaVector<VkAccelerationStructureGeometryKHR>          geometries;
+            Anvil::CommandArenaVector<VkAccelerationStructureBuildGeometryInfoKHR> infos;
+            Anvil::CommandArenaVector<VkAccelerationStructureBuildRangeInfoKHR>    range_infos;
+
+            /** Constructor. */
+            explicit BuildAccelerationStructuresKHRCommand(uint32_t                                               in_n_infos,
+                                                           const VkAccelerationStructureBuildGeometryInfoKHR*     in_infos_ptr,
+                                                           const VkAccelerationStructureBuildRangeInfoKHR* const* in_build_range_infos_ptr,
+                                                           Anvil::CommandArena*                                   in_arena_ptr);
+
+            /** Destructor. */
+            virtual ~BuildAccelerationStructuresKHRCommand()
+            {
+                /* Stub */
+            }
+
+        private:
+            BuildAccelerationStructuresKHRCommand& operator=(const BuildAccelerationStructuresKHRCommand&);
+        } BuildAccelerationStructuresKHRCommand;
+
 
         /* Holds a single attachment definition, as used by ClearAttachmentsCommand descriptor */
         typedef struct ClearAttachmentsCommandAttachment
@@ -1787,14 +2498,15 @@ namespace Anvil
         /** Holds all arguments passed to a vkCmdClearAttachments() command. */
         typedef struct ClearAttachmentsCommand : public Command
         {
-            std::vector<ClearAttachmentsCommandAttachment> attachments;
-            std::vector<VkClearRect>                       rects;
+            Anvil::CommandArenaVector<ClearAttachmentsCommandAttachment> attachments;
+            Anvil::CommandArenaVector<VkClearRect>                       rects;
 
             /* Constructor. **/
             explicit ClearAttachmentsCommand(uint32_t                      in_n_attachments,
                                              const Anvil::ClearAttachment* in_attachments,
                                              uint32_t                      in_n_rects,
-                                             const VkClearRect*            in_rect_ptrs);
+                                             const VkClearRect*            in_rect_ptrs,
+                                             Anvil::CommandArena*          in_arena_ptr);
 
             /** Destructor. */
             virtual ~ClearAttachmentsCommand()
@@ -1807,18 +2519,19 @@ namespace Anvil
         /** Holds all arguments passed to a vkCmdClearColorImage() command. */
         typedef struct ClearColorImageCommand : public Command
         {
-            VkClearColorValue                         color;
-            VkImage                                   image;
-            Anvil::ImageLayout                        image_layout;
-            Anvil::Image*                             image_ptr;
-            std::vector<Anvil::ImageSubresourceRange> ranges;
+            VkClearColorValue                                       color;
+            VkImage                                                 image;
+            Anvil::ImageLayout                                      image_layout;
+            Anvil::Image*                                           image_ptr;
+            Anvil::CommandArenaVector<Anvil::ImageSubresourceRange> ranges;
 
             /** Constructor. **/
             explicit ClearColorImageCommand(Anvil::Image*                       in_image_ptr,
                                             Anvil::ImageLayout                  in_image_layout,
                                             const VkClearColorValue*            in_color_ptr,
                                             uint32_t                            in_range_count,
-                                            const Anvil::ImageSubresourceRange* in_range_ptrs);
+                                            const Anvil::ImageSubresourceRange* in_range_ptrs,
+                                            Anvil::CommandArena*                in_arena_ptr);
 
             /** Destructor. */
             virtual ~ClearColorImageCommand()
@@ -1834,18 +2547,19 @@ namespace Anvil
         /** Holds all arguments passed to a vkCmdClearDepthStencilImage() command. */
         typedef struct ClearDepthStencilImageCommand : public Command
         {
-            VkClearDepthStencilValue                  depth_stencil;
-            VkImage                                   image;
-            Anvil::ImageLayout                        image_layout;
-            Anvil::Image*                             image_ptr;
-            std::vector<Anvil::ImageSubresourceRange> ranges;
+            VkClearDepthStencilValue                                depth_stencil;
+            VkImage                                                 image;
+            Anvil::ImageLayout                                      image_layout;
+            Anvil::Image*                                           image_ptr;
+            Anvil::CommandArenaVector<Anvil::ImageSubresourceRange> ranges;
 
             /** Constructor. **/
             explicit ClearDepthStencilImageCommand(Anvil::Image*                       in_image_ptr,
                                                    Anvil::ImageLayout                  in_image_layout,
                                                    const VkClearDepthStencilValue*     in_depth_stencil_ptr,
                                                    uint32_t                            in_range_count,
-                                                   const Anvil::ImageSubresourceRange* in_range_ptrs);
+                                                   const Anvil::ImageSubresourceRange* in_range_ptrs,
+                                                   Anvil::CommandArena*                in_arena_ptr);
 
             /** Destructor. */
             virtual ~ClearDepthStencilImageCommand()
@@ -1858,20 +2572,43 @@ namespace Anvil
         } ClearDepthStencilImageCommand;
 
 
+        /** Holds all arguments passed to a vkCmdCopyAccelerationStructureKHR() command. */
+        typedef struct CopyAccelerationStructureKHRCommand : public Command
+        {
+            Anvil::AccelerationStructure*      dst_ptr;
+            VkCopyAccelerationStructureModeKHR mode;
+            Anvil::AccelerationStructure*      src_ptr;
+
+            /** Constructor. */
+            explicit CopyAccelerationStructureKHRCommand(Anvil::AccelerationStructure*      in_src_ptr,
+                                                         Anvil::AccelerationStructure*      in_dst_ptr,
+                                                         VkCopyAccelerationStructureModeKHR in_mode);
+
+            /** Destructor. */
+            virtual ~CopyAccelerationStructureKHRCommand()
+            {
+                /* Stub */
+            }
+
+        private:
+            CopyAccelerationStructureKHRCommand& operator=(const CopyAccelerationStructureKHRCommand&);
+        } CopyAccelerationStructureKHRCommand;
+
         /** Holds all arguments passed to a vkCmdCopyBuffer() command. */
         typedef struct CopyBufferCommand : public Command
         {
-            VkBuffer                       dst_buffer;
-            Anvil::Buffer*                 dst_buffer_ptr;
-            std::vector<Anvil::BufferCopy> regions;
-            VkBuffer                       src_buffer;
-            Anvil::Buffer*                 src_buffer_ptr;
+            VkBuffer                                     dst_buffer;
+            Anvil::Buffer*                               dst_buffer_ptr;
+            Anvil::CommandArenaVector<Anvil::BufferCopy> regions;
+            VkBuffer                                     src_buffer;
+            Anvil::Buffer*                               src_buffer_ptr;
 
             /** Constructor. **/
             explicit CopyBufferCommand(Anvil::Buffer*           in_src_buffer_ptr,
                                        Anvil::Buffer*           in_dst_buffer_ptr,
                                        uint32_t                 in_region_count,
-                                       const Anvil::BufferCopy* in_region_ptrs);
+                                       const Anvil::BufferCopy* in_region_ptrs,
+                                       Anvil::CommandArena*     in_arena_ptr);
 
             /** Destructor. */
             virtual ~CopyBufferCommand()
@@ -1887,19 +2624,20 @@ namespace Anvil
         /** Holds all arguments passed to a vkCmdCopyBufferToImage() command. */
         typedef struct CopyBufferToImageCommand : public Command
         {
-            VkImage                             dst_image;
-            Anvil::ImageLayout                  dst_image_layout;
-            Anvil::Image*                       dst_image_ptr;
-            std::vector<Anvil::BufferImageCopy> regions;
-            VkBuffer                            src_buffer;
-            Anvil::Buffer*                      src_buffer_ptr;
+            VkImage                                           dst_image;
+            Anvil::ImageLayout                                dst_image_layout;
+            Anvil::Image*                                     dst_image_ptr;
+            Anvil::CommandArenaVector<Anvil::BufferImageCopy> regions;
+            VkBuffer                                          src_buffer;
+            Anvil::Buffer*                                    src_buffer_ptr;
 
             /** Constructor. **/
             explicit CopyBufferToImageCommand(Anvil::Buffer*                in_src_buffer_ptr,
                                               Anvil::Image*                 in_dst_image_ptr,
                                               Anvil::ImageLayout            in_dst_image_layout,
                                               uint32_t                      in_region_count,
-                                              const Anvil::BufferImageCopy* in_region_ptrs);
+                                              const Anvil::BufferImageCopy* in_region_ptrs,
+                                              Anvil::CommandArena*          in_arena_ptr);
 
             /** Destructor. */
             virtual ~CopyBufferToImageCommand()
@@ -1916,13 +2654,13 @@ namespace Anvil
         /** Holds all arguments passed to a vkCmdCopyImage() command. */
         typedef struct CopyImageCommand : public Command
         {
-            VkImage                       dst_image;
-            Anvil::Image*                 dst_image_ptr;
-            Anvil::ImageLayout            dst_image_layout;
-            std::vector<Anvil::ImageCopy> regions;
-            VkImage                       src_image;
-            Anvil::Image*                 src_image_ptr;
-            Anvil::ImageLayout            src_image_layout;
+            VkImage                                     dst_image;
+            Anvil::Image*                               dst_image_ptr;
+            Anvil::ImageLayout                          dst_image_layout;
+            Anvil::CommandArenaVector<Anvil::ImageCopy> regions;
+            VkImage                                     src_image;
+            Anvil::Image*                               src_image_ptr;
+            Anvil::ImageLayout                          src_image_layout;
 
             /** Constructor. **/
             explicit CopyImageCommand(Anvil::Image*           in_src_image_ptr,
@@ -1930,7 +2668,8 @@ namespace Anvil
                                       Anvil::Image*           in_dst_image_ptr,
                                       Anvil::ImageLayout      in_dst_image_layout,
                                       uint32_t                in_region_count,
-                                      const Anvil::ImageCopy* in_region_ptrs);
+                                      const Anvil::ImageCopy* in_region_ptrs,
+                                      Anvil::CommandArena*    in_arena_ptr);
 
             /** Destructor. */
             virtual ~CopyImageCommand()
@@ -1946,19 +2685,20 @@ namespace Anvil
         /** Holds all arguments passed to a vkCmdCopyImageToBuffer() command. */
         typedef struct CopyImageToBufferCommand : public Command
         {
-            VkBuffer                            dst_buffer;
-            Anvil::Buffer*                      dst_buffer_ptr;
-            std::vector<Anvil::BufferImageCopy> regions;
-            VkImage                             src_image;
-            Anvil::ImageLayout                  src_image_layout;
-            Anvil::Image*                       src_image_ptr;
+            VkBuffer                                          dst_buffer;
+            Anvil::Buffer*                                    dst_buffer_ptr;
+            Anvil::CommandArenaVector<Anvil::BufferImageCopy> regions;
+            VkImage                                           src_image;
+            Anvil::ImageLayout                                src_image_layout;
+            Anvil::Image*                                     src_image_ptr;
 
             /** Constructor. **/
             explicit CopyImageToBufferCommand(Anvil::Image*                 in_src_image_ptr,
                                               Anvil::ImageLayout            in_src_image_layout,
                                               Anvil::Buffer*                in_dst_buffer_ptr,
                                               uint32_t                      in_region_count,
-                                              const Anvil::BufferImageCopy* in_region_ptrs);
+                                              const Anvil::BufferImageCopy* in_region_ptrs,
+                                              Anvil::CommandArena*          in_arena_ptr);
 
             /** Destructor. */
             virtual ~CopyImageToBufferCommand()
@@ -2251,6 +2991,81 @@ namespace Anvil
             DrawIndirectCountKHRCommand& operator=(const DrawIndirectCountKHRCommand&);
         } DrawIndirectCountKHRCommand;
 
+        /** Holds all arguments passed to a vkCmdDrawMeshTasksIndirectCountNV() command. */
+        typedef struct DrawMeshTasksIndirectCountNVCommand : public Command
+        {
+            VkBuffer       buffer;
+            Anvil::Buffer* buffer_ptr;
+            VkBuffer       count_buffer;
+            Anvil::Buffer* count_buffer_ptr;
+            VkDeviceSize   count_offset;
+            uint32_t       max_draw_count;
+            VkDeviceSize   offset;
+            uint32_t       stride;
+
+            /** Constructor. **/
+            explicit DrawMeshTasksIndirectCountNVCommand(Anvil::Buffer* in_buffer_ptr,
+                                                         VkDeviceSize   in_offset,
+                                                         Anvil::Buffer* in_count_buffer_ptr,
+                                                         VkDeviceSize   in_count_offset,
+                                                         uint32_t       in_max_draw_count,
+                                                         uint32_t       in_stride);
+
+            /** Destructor */
+            virtual ~DrawMeshTasksIndirectCountNVCommand()
+            {
+                /* Stub */
+            }
+
+        private:
+            DrawMeshTasksIndirectCountNVCommand& operator=(const DrawMeshTasksIndirectCountNVCommand&);
+        } DrawMeshTasksIndirectCountNVCommand;
+
+        /** Holds all arguments passed to a vkCmdDrawMeshTasksIndirectNV() command. */
+        typedef struct DrawMeshTasksIndirectNVCommand : public Command
+        {
+            VkBuffer       buffer;
+            Anvil::Buffer* buffer_ptr;
+            uint32_t       draw_count;
+            VkDeviceSize   offset;
+            uint32_t       stride;
+
+            /** Constructor. **/
+            explicit DrawMeshTasksIndirectNVCommand(Anvil::Buffer* in_buffer_ptr,
+                                                    VkDeviceSize   in_offset,
+                                                    uint32_t       in_draw_count,
+                                                    uint32_t       in_stride);
+
+            /** Destructor */
+            virtual ~DrawMeshTasksIndirectNVCommand()
+            {
+                /* Stub */
+            }
+
+        private:
+            DrawMeshTasksIndirectNVCommand& operator=(const DrawMeshTasksIndirectNVCommand&);
+        } DrawMeshTasksIndirectNVCommand;
+
+        /** Holds all arguments passed to a vkCmdDrawMeshTasksNV() command. */
+        typedef struct DrawMeshTasksNVCommand : public Command
+        {
+            uint32_t first_task;
+            uint32_t task_count;
+
+            /** Constructor.
+             *
+             *  Arguments as per VK_NV_mesh_shader.
+             **/
+            explicit DrawMeshTasksNVCommand(uint32_t in_task_count,
+                                            uint32_t in_first_task);
+
+            /** Destructor */
+            virtual ~DrawMeshTasksNVCommand()
+            {
+                /* Stub */
+            }
+        } DrawMeshTasksNVCommand;
+
         /** Holds all arguments passed to a vkCmdDrawIndexedIndirect() command. */
         typedef struct DrawIndexedIndirectCommand : public Command
         {
@@ -2364,6 +3179,19 @@ namespace Anvil
             DrawIndexedIndirectCountKHRCommand& operator=(const DrawIndexedIndirectCountKHRCommand&);
         } DrawIndexedIndirectCountKHRCommand;
 
+        /** Holds all arguments passed to a vkCmdEndConditionalRenderingEXT() command. */
+        typedef struct EndConditionalRenderingEXTCommand : public Command
+        {
+            /** Constructor. **/
+            explicit EndConditionalRenderingEXTCommand();
+
+            /** Destructor. */
+            virtual ~EndConditionalRenderingEXTCommand()
+            {
+                /* Stub */
+            }
+        } EndConditionalRenderingEXTCommand;
+
         /** Holds all arguments passed to a vkCmdEndQuery() command. */
         typedef struct EndQueryCommand : public Command
         {
@@ -2402,15 +3230,29 @@ namespace Anvil
 
         } EndQueryIndexedEXTCommand;
 
+        /** Holds all arguments passed to a vkCmdEndRenderingKHR() command. */
+        typedef struct EndRenderingKHRCommand : public Command
+        {
+            /** Constructor. **/
+            explicit EndRenderingKHRCommand();
+
+            /** Destructor. */
+            virtual ~EndRenderingKHRCommand()
+            {
+                /* Stub */
+            }
+        } EndRenderingKHRCommand;
+
         typedef struct EndTransformFeedbackEXTCommand : public Command
         {
-            std::vector<VkDeviceSize>         counter_buffer_offsets;
-            std::vector<const Anvil::Buffer*> counter_buffer_ptrs;
-            uint32_t                          first_counter_buffer;
+            Anvil::CommandArenaVector<VkDeviceSize>         counter_buffer_offsets;
+            Anvil::CommandArenaVector<const Anvil::Buffer*> counter_buffer_ptrs;
+            uint32_t                                        first_counter_buffer;
 
             explicit EndTransformFeedbackEXTCommand(const uint32_t&                          in_first_counter_buffer,
                                                     const std::vector<const Anvil::Buffer*>& in_counter_buffer_ptrs,
-                                                    const std::vector<VkDeviceSize>&         in_counter_buffer_offsets);
+                                                    const std::vector<VkDeviceSize>&         in_counter_buffer_offsets,
+                                                    Anvil::CommandArena*                     in_arena_ptr);
 
         private:
             EndTransformFeedbackEXTCommand           (const EndTransformFeedbackEXTCommand&);
@@ -2420,12 +3262,13 @@ namespace Anvil
         /** Holds all arguments passed to a vkCmdExecuteCommands() command. */
         typedef struct ExecuteCommandsCommand : public Command
         {
-            std::vector<Anvil::SecondaryCommandBuffer*> command_buffer_ptrs;
-            std::vector<VkCommandBuffer>                command_buffers;
+            Anvil::CommandArenaVector<Anvil::SecondaryCommandBuffer*> command_buffer_ptrs;
+            Anvil::CommandArenaVector<VkCommandBuffer>                command_buffers;
 
             /** Constructor. **/
             explicit ExecuteCommandsCommand(uint32_t                        in_cmd_buffers_count,
-                                            Anvil::SecondaryCommandBuffer** in_cmd_buffer_ptrs);
+                                            Anvil::SecondaryCommandBuffer** in_cmd_buffer_ptrs,
+                                            Anvil::CommandArena*            in_arena_ptr);
 
             /** Destructor. */
             virtual ~ExecuteCommandsCommand()
@@ -2489,6 +3332,40 @@ namespace Anvil
             }
         } NextSubpass2KHRCommand;
 
+        /** Holds all arguments passed to a record_pipeline_barrier_raw() call. */
+        typedef struct PipelineBarrierRawCommand : public Command
+        {
+            Anvil::CommandArenaVector<RawBufferBarrier> buffer_barriers;
+            Anvil::CommandArenaVector<RawImageBarrier>  image_barriers;
+            Anvil::CommandArenaVector<RawMemoryBarrier> memory_barriers;
+
+            Anvil::DependencyFlags flags;
+
+            Anvil::PipelineStageFlags dst_stage_mask;
+            Anvil::PipelineStageFlags src_stage_mask;
+
+            /** Constructor. Arguments as per record_pipeline_barrier_raw(). **/
+            explicit PipelineBarrierRawCommand(Anvil::PipelineStageFlags     in_src_stage_mask,
+                                               Anvil::PipelineStageFlags     in_dst_stage_mask,
+                                               Anvil::DependencyFlags        in_flags,
+                                               uint32_t                      in_memory_barrier_count,
+                                               const RawMemoryBarrier* const in_memory_barriers_ptr,
+                                               uint32_t                      in_buffer_memory_barrier_count,
+                                               const RawBufferBarrier* const in_buffer_memory_barriers_ptr,
+                                               uint32_t                      in_image_memory_barrier_count,
+                                               const RawImageBarrier*  const in_image_memory_barriers_ptr,
+                                               Anvil::CommandArena*          in_arena_ptr);
+
+            /** Destructor. */
+            virtual ~PipelineBarrierRawCommand()
+            {
+                /* Stub */
+            }
+
+        private:
+            PipelineBarrierRawCommand& operator=(const PipelineBarrierRawCommand&);
+        } PipelineBarrierRawCommand;
+
         /** Holds all arguments passed to a vkCmdPushConstants() command. */
         typedef struct PushConstantsCommand : public Command
         {
@@ -2513,6 +3390,53 @@ namespace Anvil
             }
         } PushConstantsCommand;
 
+        /** Holds all arguments passed to a vkCmdPushDescriptorSetKHR() command. */
+        typedef struct PushDescriptorSetKHRCommand : public Command
+        {
+            Anvil::PipelineLayout*                                layout_ptr;
+            Anvil::PipelineBindPoint                              pipeline_bind_point;
+            uint32_t                                              set;
+            Anvil::CommandArenaVector<Anvil::PushDescriptorWrite> writes;
+
+            /** Constructor. **/
+            explicit PushDescriptorSetKHRCommand(Anvil::PipelineBindPoint          in_pipeline_bind_point,
+                                                 Anvil::PipelineLayout*            in_layout_ptr,
+                                                 uint32_t                          in_set,
+                                                 uint32_t                          in_n_writes,
+                                                 const Anvil::PushDescriptorWrite* in_writes_ptr,
+                                                 Anvil::CommandArena*              in_arena_ptr);
+
+            /** Destructor. */
+            virtual ~PushDescriptorSetKHRCommand()
+            {
+                /* Stub */
+            }
+        } PushDescriptorSetKHRCommand;
+
+        /** Holds all arguments passed to a vkCmdPushDescriptorSetWithTemplateKHR() command.
+         *
+         *  @param data_ptr points to a copy of the template data, held in the command arena.
+         */
+        typedef struct PushDescriptorSetWithTemplateKHRCommand : public Command
+        {
+            const void*                            data_ptr;
+            Anvil::PipelineLayout*                 layout_ptr;
+            uint32_t                               set;
+            const Anvil::DescriptorUpdateTemplate* template_ptr;
+
+            /** Constructor. **/
+            explicit PushDescriptorSetWithTemplateKHRCommand(const Anvil::DescriptorUpdateTemplate* in_template_ptr,
+                                                             Anvil::PipelineLayout*                 in_layout_ptr,
+                                                             uint32_t                               in_set,
+                                                             const void*                            in_data_ptr);
+
+            /** Destructor. */
+            virtual ~PushDescriptorSetWithTemplateKHRCommand()
+            {
+                /* Stub */
+            }
+        } PushDescriptorSetWithTemplateKHRCommand;
+
         /** Holds all arguments passed to a vkCmdResetEvent() command. **/
         typedef struct ResetEventCommand : public Command
         {
@@ -2559,13 +3483,13 @@ namespace Anvil
         /** Holds all arguments passed to a vkCmdResolveImage() command. **/
         typedef struct ResolveImageCommand : public Command
         {
-            VkImage                          dst_image;
-            Anvil::Image*                    dst_image_ptr;
-            Anvil::ImageLayout               dst_image_layout;
-            std::vector<Anvil::ImageResolve> regions;
-            VkImage                          src_image;
-            Anvil::Image*                    src_image_ptr;
-            Anvil::ImageLayout               src_image_layout;
+            VkImage                                        dst_image;
+            Anvil::Image*                                  dst_image_ptr;
+            Anvil::ImageLayout                             dst_image_layout;
+            Anvil::CommandArenaVector<Anvil::ImageResolve> regions;
+            VkImage                                        src_image;
+            Anvil::Image*                                  src_image_ptr;
+            Anvil::ImageLayout                             src_image_layout;
 
             /** Constructor. **/
             explicit ResolveImageCommand(Anvil::Image*              in_src_image_ptr,
@@ -2573,7 +3497,8 @@ namespace Anvil
                                          Anvil::Image*              in_dst_image_ptr,
                                          Anvil::ImageLayout         in_dst_image_layout,
                                          uint32_t                   in_region_count,
-                                         const Anvil::ImageResolve* in_region_ptrs);
+                                         const Anvil::ImageResolve* in_region_ptrs,
+                                         Anvil::CommandArena*       in_arena_ptr);
 
             /** Destructor. */
             virtual ~ResolveImageCommand()
@@ -2711,13 +3636,14 @@ namespace Anvil
         /** Holds all arguments passed to a vkCmdSetScissor() command. **/
         typedef struct SetScissorCommand : public Command
         {
-            uint32_t              first_scissor;
-            std::vector<VkRect2D> scissors;
+            uint32_t                            first_scissor;
+            Anvil::CommandArenaVector<VkRect2D> scissors;
 
             /** Constructor. **/
-            explicit SetScissorCommand(uint32_t        in_first_scissor,
-                                       uint32_t        in_scissor_count,
-                                       const VkRect2D* in_scissor_ptrs);
+            explicit SetScissorCommand(uint32_t             in_first_scissor,
+                                       uint32_t             in_scissor_count,
+                                       const VkRect2D*      in_scissor_ptrs,
+                                       Anvil::CommandArena* in_arena_ptr);
 
             /** Destructor. */
             virtual ~SetScissorCommand()
@@ -2786,13 +3712,14 @@ namespace Anvil
         /** Holds all arguments passed to a vkCmdSetViewport() command. **/
         typedef struct SetViewportCommand : public Command
         {
-            uint32_t                first_viewport;
-            std::vector<VkViewport> viewports;
+            uint32_t                              first_viewport;
+            Anvil::CommandArenaVector<VkViewport> viewports;
 
             /** Constructor. **/
-            explicit SetViewportCommand(uint32_t          in_first_viewport,
-                                        uint32_t          in_viewport_count,
-                                        const VkViewport* in_viewport_ptrs);
+            explicit SetViewportCommand(uint32_t             in_first_viewport,
+                                        uint32_t             in_viewport_count,
+                                        const VkViewport*    in_viewport_ptrs,
+                                        Anvil::CommandArena* in_arena_ptr);
 
             /** Destructor. */
             virtual ~SetViewportCommand()
@@ -2801,6 +3728,26 @@ namespace Anvil
             }
         } SetViewportCommand;
 
+        /** Holds all arguments passed to a vkCmdSetViewportShadingRatePaletteNV() command. **/
+        typedef struct SetViewportShadingRatePaletteNVCommand : public Command
+        {
+            Anvil::CommandArenaVector<VkShadingRatePaletteEntryNV> entries;
+            uint32_t                                               first_viewport;
+            Anvil::CommandArenaVector<VkShadingRatePaletteNV>      palettes; /* Point into entries */
+
+            /** Constructor. **/
+            explicit SetViewportShadingRatePaletteNVCommand(uint32_t                      in_first_viewport,
+                                                            uint32_t                      in_viewport_count,
+                                                            const VkShadingRatePaletteNV* in_palettes_ptr,
+                                                            Anvil::CommandArena*          in_arena_ptr);
+
+            /** Destructor. */
+            virtual ~SetViewportShadingRatePaletteNVCommand()
+            {
+                /* Stub */
+            }
+        } SetViewportShadingRatePaletteNVCommand;
+
 
         /** Holds all arguments passed to a vkCmdUpdateBuffer() command. **/
         typedef struct UpdateBufferCommand : public Command
@@ -2833,12 +3780,12 @@ namespace Anvil
             Anvil::PipelineStageFlags dst_stage_mask;
             Anvil::PipelineStageFlags src_stage_mask;
 
-            std::vector<BufferBarrier>  buffer_barriers;
-            std::vector<ImageBarrier>   image_barriers;
-            std::vector<MemoryBarrier>  memory_barriers;
+            Anvil::CommandArenaVector<BufferBarrier> buffer_barriers;
+            Anvil::CommandArenaVector<ImageBarrier>  image_barriers;
+            Anvil::CommandArenaVector<MemoryBarrier> memory_barriers;
 
-            std::vector<VkEvent>       events;
-            std::vector<Anvil::Event*> event_ptrs;
+            Anvil::CommandArenaVector<VkEvent>       events;
+            Anvil::CommandArenaVector<Anvil::Event*> event_ptrs;
 
             /** Constructor **/
             explicit WaitEventsCommand(uint32_t                   in_event_count,
@@ -2850,7 +3797,8 @@ namespace Anvil
                                        uint32_t                   in_buffer_memory_barrier_count,
                                        const BufferBarrier* const in_buffer_memory_barrier_ptr_ptr,
                                        uint32_t                   in_image_memory_barrier_count,
-                                       const ImageBarrier* const  in_image_memory_barrier_ptr_ptr);
+                                       const ImageBarrier* const  in_image_memory_barrier_ptr_ptr,
+                                       Anvil::CommandArena*       in_arena_ptr);
 
             /** Destructor. */
             virtual ~WaitEventsCommand()
@@ -2862,6 +3810,68 @@ namespace Anvil
             WaitEventsCommand& operator=(const WaitEventsCommand&);
         } WaitEventsCommand;
 
+        /** Holds all arguments passed to a record_wait_events_raw() call. **/
+        typedef struct WaitEventsRawCommand : public Command
+        {
+            Anvil::PipelineStageFlags dst_stage_mask;
+            Anvil::PipelineStageFlags src_stage_mask;
+
+            Anvil::CommandArenaVector<RawBufferBarrier> buffer_barriers;
+            Anvil::CommandArenaVector<RawImageBarrier>  image_barriers;
+            Anvil::CommandArenaVector<RawMemoryBarrier> memory_barriers;
+
+            Anvil::CommandArenaVector<Anvil::Event*> event_ptrs;
+
+            /** Constructor. Arguments as per record_wait_events_raw(). **/
+            explicit WaitEventsRawCommand(uint32_t                      in_event_count,
+                                          Anvil::Event* const*          in_event_ptrs,
+                                          Anvil::PipelineStageFlags     in_src_stage_mask,
+                                          Anvil::PipelineStageFlags     in_dst_stage_mask,
+                                          uint32_t                      in_memory_barrier_count,
+                                          const RawMemoryBarrier* const in_memory_barriers_ptr,
+                                          uint32_t                      in_buffer_memory_barrier_count,
+                                          const RawBufferBarrier* const in_buffer_memory_barriers_ptr,
+                                          uint32_t                      in_image_memory_barrier_count,
+                                          const RawImageBarrier*  const in_image_memory_barriers_ptr,
+                                          Anvil::CommandArena*          in_arena_ptr);
+
+            /** Destructor. */
+            virtual ~WaitEventsRawCommand()
+            {
+                /* Stub */
+            }
+
+        private:
+            WaitEventsRawCommand& operator=(const WaitEventsRawCommand&);
+        } WaitEventsRawCommand;
+
+        /** Holds all arguments passed to a vkCmdWriteAccelerationStructuresPropertiesKHR() command. **/
+        typedef struct WriteAccelerationStructuresPropertiesKHRCommand : public Command
+        {
+            Anvil::CommandArenaVector<Anvil::AccelerationStructure*> acceleration_structure_ptrs;
+
+            Anvil::QueryIndex first_query;
+            Anvil::QueryPool* query_pool_ptr;
+            VkQueryType       query_type;
+
+            /** Constructor. **/
+            explicit WriteAccelerationStructuresPropertiesKHRCommand(uint32_t                             in_n_acceleration_structures,
+                                                                     Anvil::AccelerationStructure* const* in_acceleration_structure_ptrs,
+                                                                     VkQueryType                          in_query_type,
+                                                                     Anvil::QueryPool*                    in_query_pool_ptr,
+                                                                     Anvil::QueryIndex                    in_first_query,
+                                                                     Anvil::CommandArena*                 in_arena_ptr);
+
+            /** Destructor. */
+            virtual ~WriteAccelerationStructuresPropertiesKHRCommand()
+            {
+                /* Stub */
+            }
+
+        private:
+            WriteAccelerationStructuresPropertiesKHRCommand& operator=(const WriteAccelerationStructuresPropertiesKHRCommand&);
+        } WriteAccelerationStructuresPropertiesKHRCommand;
+
         /** Holds all arguments passed to vkCmdWriteBufferMarkerAMD() command. **/
         typedef struct WriteBufferMarkerAMDCommand : public Command
         {
@@ -2910,7 +3920,96 @@ namespace Anvil
         } WriteTimestampCommand;
 
 
-        typedef std::vector<Command> Commands;
+        typedef std::vector<Command*> Commands;
+
+        /** Holds barriers whose vkCmdPipelineBarrier() call has been deferred by the barrier batcher. */
+        typedef struct PendingBarriers
+        {
+            std::vector<VkBufferMemoryBarrier> buffer_barriers;
+            Anvil::DependencyFlags             dependency_flags;
+            Anvil::PipelineStageFlags          dst_stage_mask;
+            std::vector<VkImageMemoryBarrier>  image_barriers;
+            std::vector<VkMemoryBarrier>       memory_barriers;
+            Anvil::PipelineStageFlags          src_stage_mask;
+
+            /** Forgets all pending barriers. Storage used by the vectors is retained. */
+            void clear()
+            {
+                buffer_barriers.clear();
+                image_barriers.clear ();
+                memory_barriers.clear();
+
+                dependency_flags = Anvil::DependencyFlagBits::NONE;
+                dst_stage_mask   = Anvil::PipelineStageFlagBits::NONE;
+                src_stage_mask   = Anvil::PipelineStageFlagBits::NONE;
+            }
+
+            /** Tells whether any barrier is waiting to be flushed. */
+            bool is_empty() const
+            {
+                return (src_stage_mask == Anvil::PipelineStageFlagBits::NONE);
+            }
+        } PendingBarriers;
+
+        /** Holds state bound to the command buffer, as seen by the state filter. */
+        typedef struct BoundState
+        {
+            enum
+            {
+                BLEND_CONSTANTS_BIT            = 1 << 0,
+                DEPTH_BIAS_BIT                 = 1 << 1,
+                DEPTH_BOUNDS_BIT               = 1 << 2,
+                INDEX_BUFFER_BIT               = 1 << 3,
+                LINE_WIDTH_BIT                 = 1 << 4,
+                STENCIL_BACK_COMPARE_MASK_BIT  = 1 << 5,
+                STENCIL_BACK_REFERENCE_BIT     = 1 << 6,
+                STENCIL_BACK_WRITE_MASK_BIT    = 1 << 7,
+                STENCIL_FRONT_COMPARE_MASK_BIT = 1 << 8,
+                STENCIL_FRONT_REFERENCE_BIT    = 1 << 9,
+                STENCIL_FRONT_WRITE_MASK_BIT   = 1 << 10,
+            };
+
+            /* Arrays indexed with bind points hold graphics state at index 0, and compute state at index 1. */
+            float                        blend_constants[4];
+            std::vector<VkDescriptorSet> descriptor_sets[2]; /* VK_NULL_HANDLE for unknown sets */
+            float                        depth_bias     [3]; /* constant factor, clamp, slope factor */
+            float                        depth_bounds   [2];
+            VkBuffer                     index_buffer;
+            VkDeviceSize                 index_buffer_offset;
+            Anvil::IndexType             index_type;
+            float                        line_width;
+            VkPipelineLayout             pipeline_layouts[2];
+            VkPipeline                   pipelines       [2];
+            std::vector<VkRect2D>        scissors;
+            std::vector<bool>            scissors_valid;
+            uint32_t                     stencil_compare_masks[2]; /* back, front */
+            uint32_t                     stencil_references   [2]; /* back, front */
+            uint32_t                     stencil_write_masks  [2]; /* back, front */
+            uint32_t                     valid_state_bits;
+            std::vector<VkDeviceSize>    vertex_buffer_offsets;
+            std::vector<VkBuffer>        vertex_buffers;        /* VK_NULL_HANDLE for unknown bindings */
+            std::vector<VkViewport>      viewports;
+            std::vector<bool>            viewports_valid;
+
+            /** Forgets all bound state. Storage used by the vectors is retained. */
+            void clear()
+            {
+                for (uint32_t n_bind_point = 0;
+                              n_bind_point < 2;
+                            ++n_bind_point)
+                {
+                    descriptor_sets [n_bind_point].clear();
+                    pipeline_layouts[n_bind_point] = VK_NULL_HANDLE;
+                    pipelines       [n_bind_point] = VK_NULL_HANDLE;
+                }
+
+                scissors_valid.clear ();
+                vertex_buffers.clear ();
+                viewports_valid.clear();
+
+                valid_state_bits = 0;
+            }
+        } BoundState;
 
         /* Protected functions */
         explicit CommandBufferBase(const Anvil::BaseDevice* in_device_ptr,
@@ -2922,19 +4021,83 @@ namespace Anvil
             void clear_commands();
         #endif
 
+        bool filter_stencil_state(Anvil::StencilFaceFlags in_face_mask,
+                                  uint32_t                in_value,
+                                  uint32_t                in_back_bit,
+                                  uint32_t                in_front_bit,
+                                  uint32_t*               inout_values_ptr);
+
+        /** Issues a single vkCmdPipelineBarrier() call for all barriers deferred by the barrier batcher.
+         *  If no barriers are pending, the call is a no-op.
+         *
+         *  Needs to be called before recording any command which may access resources.
+         **/
+        void flush_pending_barriers();
+
+        void invalidate_dynamic_states(Anvil::PipelineID in_graphics_pipeline_id);
+
+        void record_pipeline_barrier_internal(Anvil::PipelineStageFlags    in_src_stage_mask,
+                                              Anvil::PipelineStageFlags    in_dst_stage_mask,
+                                              Anvil::DependencyFlags       in_dependency_flags,
+                                              uint32_t                     in_memory_barrier_count,
+                                              const VkMemoryBarrier*       in_memory_barriers_ptr,
+                                              uint32_t                     in_buffer_memory_barrier_count,
+                                              const VkBufferMemoryBarrier* in_buffer_memory_barriers_ptr,
+                                              uint32_t                     in_image_memory_barrier_count,
+                                              const VkImageMemoryBarrier*  in_image_memory_barriers_ptr);
+        void record_wait_events_internal     (uint32_t                     in_event_count,
+                                              const VkEvent*               in_events_ptr,
+                                              Anvil::PipelineStageFlags    in_src_stage_mask,
+                                              Anvil::PipelineStageFlags    in_dst_stage_mask,
+                                              uint32_t                     in_memory_barrier_count,
+                                              const VkMemoryBarrier*       in_memory_barriers_ptr,
+                                              uint32_t                     in_buffer_memory_barrier_count,
+                                              const VkBufferMemoryBarrier* in_buffer_memory_barriers_ptr,
+                                              uint32_t                     in_image_memory_barrier_count,
+                                              const VkImageMemoryBarrier*  in_image_memory_barriers_ptr);
+
+        void track_barriers     (Anvil::PipelineStageFlags            in_dst_stage_mask,
+                                 uint32_t                             in_buffer_memory_barrier_count,
+                                 const BufferBarrier* const           in_buffer_memory_barriers_ptr,
+                                 uint32_t                             in_image_memory_barrier_count,
+                                 const ImageBarrier*  const           in_image_memory_barriers_ptr);
+        void track_buffer_access(Anvil::Buffer*                       in_buffer_ptr,
+                                 Anvil::PipelineStageFlags            in_stage_mask,
+                                 Anvil::AccessFlags                   in_access_mask);
+        void track_image_access (Anvil::Image*                        in_image_ptr,
+                                 const Anvil::ImageSubresourceRange&  in_subresource_range,
+                                 Anvil::ImageLayout                   in_layout,
+                                 Anvil::PipelineStageFlags            in_stage_mask,
+                                 Anvil::AccessFlags                   in_access_mask);
+        void track_image_access (Anvil::Image*                        in_image_ptr,
+                                 const Anvil::ImageSubresourceLayers& in_subresource_layers,
+                                 Anvil::ImageLayout                   in_layout,
+                                 Anvil::PipelineStageFlags            in_stage_mask,
+                                 Anvil::AccessFlags                   in_access_mask);
+
         /* Protected variables */
         #ifdef STORE_COMMAND_BUFFER_COMMANDS
-            Commands m_commands;
+            Anvil::CommandArena m_command_arena;
+            Commands            m_commands;
         #endif
 
+        bool                     m_barrier_batching_enabled;
+        BoundState               m_bound_state;
         VkCommandBuffer          m_command_buffer;
         uint32_t                 m_device_mask;
         const Anvil::BaseDevice* m_device_ptr;
+        bool                     m_is_conditional_rendering_active;
+        bool                     m_is_dynamic_rendering_active;
         bool                     m_is_renderpass_active;
         uint32_t                 m_n_debug_label_regions_started;
+        uint32_t                 m_n_filtered_state_calls;
+        uint32_t                 m_n_recorded_commands;
+        uint32_t                 m_n_recorded_pipeline_binds;
         Anvil::CommandPool*      m_parent_command_pool_ptr;
+        PendingBarriers          m_pending_barriers;
         bool                     m_recording_in_progress;
         uint32_t                 m_renderpass_device_mask;
+        bool                     m_state_filtering_enabled;
         CommandBufferType        m_type;
 
         static bool m_command_stashing_disabled;
@@ -2963,6 +4126,14 @@ namespace Anvil
             /* Stub */
         }
 
+        /** Returns the pipeline statistics profiler assigned to the command buffer, or null if none has
+         *  been assigned. Please see set_pipeline_statistics_profiler() for more details.
+         **/
+        Anvil::PipelineStatisticsProfiler* get_pipeline_statistics_profiler() const
+        {
+            return m_pipeline_statistics_profiler_ptr;
+        }
+
         /** Issues a vkCmdBeginRenderPass() call and appends it to the internal vector of commands
          *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
          *  #define enabled).
@@ -2979,6 +4150,11 @@ namespace Anvil
          *  NOTE: If either @param in_opt_n_attachment_initial_sample_locations or @param in_opt_n_post_subpass_sample_locations
          *        (or both) are not zero, VK_EXT_sample_locations is required.
          *
+         *  NOTE: If @param in_fbo_ptr is an imageless framebuffer, @param in_opt_n_attachment_image_views and
+         *        @param in_opt_attachment_image_view_ptrs must specify the image views to use for all of its attachments
+         *        for the duration of the render pass. This requires VK_KHR_imageless_framebuffer. The arguments must
+         *        be left at their default values for framebuffers created with image views.
+         *
          *  @return true if successful, false otherwise.
          **/
         bool record_begin_render_pass(uint32_t                                in_n_clear_values,
@@ -2990,7 +4166,9 @@ namespace Anvil
                                       const uint32_t&                         in_opt_n_attachment_initial_sample_locations   = 0,
                                       const Anvil::AttachmentSampleLocations* in_opt_attachment_initial_sample_locations_ptr = nullptr,
                                       const uint32_t&                         in_opt_n_post_subpass_sample_locations         = 0,
-                                      const Anvil::SubpassSampleLocations*    in_opt_post_subpass_sample_locations_ptr       = nullptr);
+                                      const Anvil::SubpassSampleLocations*    in_opt_post_subpass_sample_locations_ptr       = nullptr,
+                                      const uint32_t&                         in_opt_n_attachment_image_views                = 0,
+                                      Anvil::ImageView* const*                in_opt_attachment_image_view_ptrs              = nullptr);
 
         /** See documentation for the other record_begin_render_pass() function prototype for general
          *  information about this function.
@@ -3010,7 +4188,9 @@ namespace Anvil
                                       const uint32_t&                         in_opt_n_attachment_initial_sample_locations   = 0,
                                       const Anvil::AttachmentSampleLocations* in_opt_attachment_initial_sample_locations_ptr = nullptr,
                                       const uint32_t&                         in_opt_n_post_subpass_sample_locations         = 0,
-                                      const Anvil::SubpassSampleLocations*    in_opt_post_subpass_sample_locations_ptr       = nullptr);
+                                      const Anvil::SubpassSampleLocations*    in_opt_post_subpass_sample_locations_ptr       = nullptr,
+                                      const uint32_t&                         in_opt_n_attachment_image_views                = 0,
+                                      Anvil::ImageView* const*                in_opt_attachment_image_view_ptrs              = nullptr);
 
         /** Issues a vkCmdBeginRenderPass2KHR() call and appends it to the internal vector of commands
          *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
@@ -3039,7 +4219,9 @@ namespace Anvil
                                            const uint32_t&                         in_opt_n_attachment_initial_sample_locations   = 0,
                                            const Anvil::AttachmentSampleLocations* in_opt_attachment_initial_sample_locations_ptr = nullptr,
                                            const uint32_t&                         in_opt_n_post_subpass_sample_locations         = 0,
-                                           const Anvil::SubpassSampleLocations*    in_opt_post_subpass_sample_locations_ptr       = nullptr);
+                                           const Anvil::SubpassSampleLocations*    in_opt_post_subpass_sample_locations_ptr       = nullptr,
+                                           const uint32_t&                         in_opt_n_attachment_image_views                = 0,
+                                           Anvil::ImageView* const*                in_opt_attachment_image_view_ptrs              = nullptr);
 
         /** See documentation for the other record_begin_render_pass2_KHR() function prototype for general
          *  information about this function.
@@ -3059,7 +4241,9 @@ namespace Anvil
                                            const uint32_t&                         in_opt_n_attachment_initial_sample_locations   = 0,
                                            const Anvil::AttachmentSampleLocations* in_opt_attachment_initial_sample_locations_ptr = nullptr,
                                            const uint32_t&                         in_opt_n_post_subpass_sample_locations         = 0,
-                                           const Anvil::SubpassSampleLocations*    in_opt_post_subpass_sample_locations_ptr       = nullptr);
+                                           const Anvil::SubpassSampleLocations*    in_opt_post_subpass_sample_locations_ptr       = nullptr,
+                                           const uint32_t&                         in_opt_n_attachment_image_views                = 0,
+                                           Anvil::ImageView* const*                in_opt_attachment_image_view_ptrs              = nullptr);
 
         /** Issues a vkCmdEndRenderPass() call and appends it to the internal vector of commands
          *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
@@ -3127,6 +4311,24 @@ namespace Anvil
          **/
         bool record_next_subpass2_KHR(Anvil::SubpassContents in_contents);
 
+        /** Assigns a pipeline statistics profiler to the command buffer. Pass null to stop instrumenting
+         *  the command buffer. No profiler is assigned by default.
+         *
+         *  With a profiler assigned, each render pass recorded into the command buffer is bracketed with
+         *  the profiler's begin_pass() and end_pass() calls. The render pass's debug name is used as the pass name.
+         *  If the render pass has not been named, a name derived from the render pass instance is used instead.
+         *
+         *  Render passes recorded while a pass started by the app with an explicit begin_pass() call is active
+         *  are not bracketed. This way, apps can aggregate multiple render passes under a single name.
+         *
+         *  The profiler's begin_frame() must be called before the first render pass of each frame is recorded.
+         *
+         *  It is an error to call this function while a render pass is active.
+         *
+         *  @param in_opt_profiler_ptr Profiler to use, or null.
+         **/
+        void set_pipeline_statistics_profiler(Anvil::PipelineStatisticsProfiler* in_opt_profiler_ptr);
+
         /** Issues a vkBeginCommandBufer() call and clears the internally managed vector of recorded
          *  commands, if STORE_COMMAND_BUFFER_COMMANDS has been defined for the build.
          *
@@ -3182,10 +4384,16 @@ namespace Anvil
                                                const uint32_t&                         in_opt_n_attachment_initial_sample_locations,
                                                const Anvil::AttachmentSampleLocations* in_opt_attachment_initial_sample_locations_ptr,
                                                const uint32_t&                         in_opt_n_post_subpass_sample_locations,
-                                               const Anvil::SubpassSampleLocations*    in_opt_post_subpass_sample_locations_ptr);
+                                               const Anvil::SubpassSampleLocations*    in_opt_post_subpass_sample_locations_ptr,
+                                               const uint32_t&                         in_opt_n_attachment_image_views,
+                                               Anvil::ImageView* const*                in_opt_attachment_image_view_ptrs);
         bool record_end_render_pass_internal  (const bool&                             in_use_khr_create_rp2_extension);
         bool record_next_subpass_internal     (const bool&                             in_use_khr_create_rp2_extension,
                                                Anvil::SubpassContents                  in_contents);
+
+        /* Private variables */
+        bool                               m_is_pipeline_statistics_pass_active;
+        Anvil::PipelineStatisticsProfiler* m_pipeline_statistics_profiler_ptr;
     };
 
     /** Wrapper class for secondary command buffers. */
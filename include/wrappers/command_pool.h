@@ -26,6 +26,7 @@
 #include "misc/debug_marker.h"
 #include "misc/mt_safety.h"
 #include "misc/types.h"
+#include <atomic>
 
 
 namespace Anvil
@@ -69,6 +70,13 @@ namespace Anvil
                                            uint32_t                             in_queue_family_index,
                                            MTSafety                             in_mt_safety = MTSafety::INHERIT_FROM_PARENT_DEVICE);
 
+        /** Returns usage statistics gathered for the pool so far.
+         *
+         *  Vulkan does not expose the amount of memory held by a command pool, so usage is expressed
+         *  in terms of the number of command buffers recorded per frame, as reported by on_frame_end().
+         **/
+        Anvil::CommandPoolStats get_stats() const;
+
         /** Retrieves the raw Vulkan handle for the encapsulated command pool */
         VkCommandPool get_command_pool() const
         {
@@ -87,6 +95,26 @@ namespace Anvil
             return m_queue_family_index;
         }
 
+        /** Closes the current frame window of the pool's usage tracking and applies the trim policy.
+         *
+         *  The number of command buffers recorded since the previous call is appended to the history of
+         *  the last N frames, where N is the window size specified with set_trim_policy(). Once at least
+         *  N frames have passed since the pool was last trimmed, and the peak usage over the window falls
+         *  below the configured fraction of the peak usage seen since the last trim, the pool is trimmed.
+         *  This releases memory a pool has retained after recording unusually large or numerous command
+         *  buffers in the past.
+         *
+         *  Meant to be called once per frame, after the pool has been reset. Pools returned by
+         *  BaseDevice::get_thread_command_pool_for_queue_family_index() are stepped by
+         *  BaseDevice::reset_thread_command_pools(). The call must not overlap with other calls made
+         *  against the pool.
+         *
+         *  Trimming is only performed if VK_KHR_maintenance1 has been enabled for the parent device.
+         *
+         *  @return true if the pool has been trimmed, false otherwise.
+         **/
+        bool on_frame_end();
+
         /** Reset the command pool.
          *
          *  @param in_release_resources true if the vkResetCommandPool() call should be invoked with
@@ -103,6 +131,18 @@ namespace Anvil
          */
         void trim();
 
+        /** Configures the policy used by on_frame_end() to decide when to trim the pool.
+         *
+         *  By default, the pool is trimmed when peak usage over the last 60 frames drops below
+         *  half the peak usage seen since the pool was last trimmed.
+         *
+         *  @param in_n_window_frames Number of most recent frames to consider. 0 disables automatic trimming.
+         *  @param in_usage_ratio     Fraction of the peak usage since the last trim, below which recent
+         *                            usage must fall for the pool to be trimmed. Must be in (0, 1].
+         **/
+        void set_trim_policy(uint32_t in_n_window_frames,
+                             float    in_usage_ratio);
+
     private:
         /* Private functions */
 
@@ -115,13 +155,32 @@ namespace Anvil
         CommandPool           (const CommandPool&);
         CommandPool& operator=(const CommandPool&);
 
+        /* Called by CommandBufferBase to keep usage statistics up to date. */
+        void on_command_buffer_allocated();
+        void on_command_buffer_recording_started();
+        void on_command_buffer_released();
+
         /* Private variables */
         VkCommandPool                 m_command_pool;
         Anvil::CommandPoolCreateFlags m_create_flags;
         Anvil::BaseDevice*            m_device_ptr;
         uint32_t                      m_queue_family_index;
 
+        std::atomic<uint32_t> m_n_live_command_buffers;
+        std::atomic<uint32_t> m_n_recordings_this_frame;
+
+        uint32_t              m_n_frames;
+        uint32_t              m_n_frames_since_trim;
+        uint32_t              m_n_trims;
+        uint32_t              m_peak_usage_since_trim;
+        uint32_t              m_trim_n_window_frames;
+        float                 m_trim_usage_ratio;
+        std::vector<uint32_t> m_usage_history;
+        uint32_t              m_usage_history_next_index;
+
         friend class Anvil::CommandBufferBase;
+        friend class Anvil::PrimaryCommandBuffer;
+        friend class Anvil::SecondaryCommandBuffer;
     };
 
 }; /* namespace Anvil */
@@ -39,8 +39,6 @@ namespace Anvil
     class ComputePipelineManager : public BasePipelineManager
     {
     public:
-       using BasePipelineManager::bake;
-
         /* Public functions */
        static std::unique_ptr<ComputePipelineManager> create(Anvil::BaseDevice*    in_device_ptr,
                                                              bool                  in_mt_safe,
@@ -49,7 +47,9 @@ namespace Anvil
 
        virtual ~ComputePipelineManager();
 
-       bool bake();
+       protected:
+           /* Protected functions */
+           bool bake_pipelines(Pipelines* inout_pipelines_ptr);
 
        private:
            /* Constructor */
@@ -31,7 +31,10 @@
 #include "misc/types.h"
 #include "misc/debug_marker.h"
 #include "misc/mt_safety.h"
+#include "misc/time.h"
 #include "wrappers/device.h"
+#include <condition_variable>
+#include <thread>
 
 namespace Anvil
 {
@@ -58,6 +61,16 @@ namespace Anvil
             return m_create_info_ptr.get();
         }
 
+        /** Returns the number of messages dropped so far, either because they exceeded the rate limit, or because
+         *  the asynchronous delivery ring was full.
+         *
+         *  Messages with filtered IDs are not included.
+         */
+        uint32_t get_n_dropped_messages() const
+        {
+            return m_n_dropped_messages.load();
+        }
+
         void submit_message(const Anvil::DebugMessageSeverityFlagBits&     in_message_severity,
                             const Anvil::DebugMessageTypeFlags&            in_message_type_flags,
                             const char*                                    in_message_id_name_ptr,
@@ -75,10 +88,62 @@ namespace Anvil
             EXT_DEBUG_UTILS
         };
 
+        /* Copy of a message which is waiting to be delivered by the delivery thread. */
+        typedef struct AsyncMessage
+        {
+            /* Pos of the producer which may write to the slot next. Set to pos + 1 once the message has been
+             * written, and to pos + ring size once the message has been delivered. */
+            std::atomic<uint64_t> sequence;
+
+            /* Name ptrs of labels & objects are only compared against nullptr, until the delivery thread
+             * redirects them to the strings stored below. */
+            std::vector<Anvil::DebugLabel>          cmd_buffer_labels;
+            std::vector<std::string>                cmd_buffer_label_names;
+            std::string                             message;
+            int32_t                                 message_id;
+            std::string                             message_id_name;
+            bool                                    message_id_name_specified;
+            std::vector<Anvil::DebugObjectNameInfo> objects;
+            std::vector<std::string>                object_names;
+            std::vector<Anvil::DebugLabel>          queue_labels;
+            std::vector<std::string>                queue_label_names;
+            Anvil::DebugMessageSeverityFlagBits     severity;
+            Anvil::DebugMessageTypeFlags            types;
+
+            AsyncMessage()
+                :sequence                 (0),
+                 message_id               (0),
+                 message_id_name_specified(false),
+                 severity                 (Anvil::DebugMessageSeverityFlagBits::NONE)
+            {
+                /* Stub */
+            }
+        } AsyncMessage;
+
+        /* Rate limiting state of all message IDs which hash to the same table entry. */
+        typedef struct RateLimitEntry
+        {
+            std::atomic<uint32_t> n_messages;
+            std::atomic<uint64_t> period_start_msec;
+
+            RateLimitEntry()
+                :n_messages       (0),
+                 period_start_msec(0)
+            {
+                /* Stub */
+            }
+        } RateLimitEntry;
+
         /* Private functions */
         DebugMessenger(const DebugAPI&                          in_debug_api,
                        Anvil::DebugMessengerCreateInfoUniquePtr in_create_info_ptr);
 
+        AsyncMessage* acquire_async_message (uint64_t*     out_pos_ptr);
+        void          delivery_thread_main  ();
+        void          publish_async_message (AsyncMessage* in_message_ptr,
+                                             uint64_t      in_pos);
+        bool          should_deliver_message(int32_t       in_message_id);
+
         static Anvil::DebugMessageSeverityFlags get_debug_message_severity_flags_for_debug_report_flags(const VkDebugReportFlagsEXT&            in_flags);
         static VkDebugReportFlagsEXT            get_debug_report_flags_for_debug_message_severity_flags(const Anvil::DebugMessageSeverityFlags& in_flags);
 
@@ -98,6 +163,21 @@ namespace Anvil
         /* Private variables */
         Anvil::DebugMessengerCreateInfoUniquePtr m_create_info_ptr;
         const DebugAPI                           m_debug_api;
+        std::atomic<uint32_t>                    m_n_dropped_messages;
+        std::vector<RateLimitEntry>              m_rate_limit_entries;
+        Anvil::Time                              m_time;
+
+        /* Only used if asynchronous delivery is enabled: ==> */
+        std::vector<AsyncMessage>                m_async_ring;
+        uint64_t                                 m_async_ring_mask;
+        uint64_t                                 m_dequeue_pos;         /* Only accessed by the delivery thread */
+        std::thread                              m_delivery_thread;
+        std::atomic<uint64_t>                    m_enqueue_pos;
+        std::atomic<bool>                        m_is_thread_sleeping;
+        std::atomic<bool>                        m_should_quit;
+        std::condition_variable                  m_wake_cv;
+        std::mutex                               m_wake_mutex;
+        /* <== */
 
 
         VkDebugReportCallbackEXT m_debug_callback; //< only used if m_debug_api == EXT_DEBUG_REPORT
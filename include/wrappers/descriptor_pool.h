@@ -33,6 +33,7 @@
 #include "misc/debug_marker.h"
 #include "misc/mt_safety.h"
 #include "misc/types.h"
+#include <unordered_map>
 
 namespace Anvil
 {
@@ -79,6 +80,12 @@ namespace Anvil
          *  @param out_opt_result_ptr            If not null, deref will be set to the VkResult value, as returned by
          *                                       the vkAllocateDescriptorSets() invocation that this function makes.
          *                                       This may be useful for KHR_maintenance1-aware applications.
+         *
+         *  If the pool has been created with DescriptorPoolCreateInfo::set_should_recycle_released_sets() enabled,
+         *  sets released with release_descriptor_sets() are handed out first, and only the remaining sets are
+         *  allocated from the Vulkan pool. Recycled sets keep the contents they had when they were released, so all
+         *  their bindings must be updated before use.
+         *
          *  @return true if successful, false otherwise.
          **/
         bool alloc_descriptor_sets(uint32_t                       in_n_sets,
@@ -107,7 +114,47 @@ namespace Anvil
             return m_pool;
         }
 
-        /** Resets the pool.
+        /** Returns the highest usage the pool has seen between any two reset() calls, including the current
+         *  period. Please see get_usage() for more details.
+         **/
+        const Anvil::DescriptorPoolUsage& get_peak_usage() const
+        {
+            return m_peak_usage;
+        }
+
+        /** Returns the number of sets and descriptors requested from the pool since it was last reset.
+         *
+         *  Sets whose allocation has failed are included. Sets released individually (for pools created
+         *  with the FREE_DESCRIPTOR_SET flag) are not subtracted. Recycled sets (see release_descriptor_sets() )
+         *  are only accounted for when they are first allocated.
+         **/
+        const Anvil::DescriptorPoolUsage& get_usage() const
+        {
+            return m_usage;
+        }
+
+        /** Returns descriptor sets to the pool's per-layout free lists, so that later alloc_descriptor_sets() calls
+         *  for the same layouts can reuse them in O(1) time. The Vulkan sets are not freed, so the pool does not
+         *  fragment. Free lists are keyed by Vulkan layout handles, which DescriptorSetLayoutManager shares between
+         *  identical layouts.
+         *
+         *  Sets whose layout contains a variable descriptor count binding are not recycled. Their space is only
+         *  reclaimed by reset().
+         *
+         *  Requires the pool to have been created with DescriptorPoolCreateInfo::set_should_recycle_released_sets()
+         *  enabled. The sets must have been allocated from this pool, and must no longer be used by any command
+         *  buffer which is pending execution.
+         *
+         *  @param in_n_sets               Number of sets to release.
+         *  @param in_descriptor_sets_ptr  Array of @param in_n_sets sets to release. Null items are ignored. All
+         *                                 items are reset by the function.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool release_descriptor_sets(uint32_t                in_n_sets,
+                                     DescriptorSetUniquePtr* in_descriptor_sets_ptr);
+
+        /** Resets the pool. Also clears all free lists.
          *
          *  @return true if successful, false otherwise
          **/
@@ -127,9 +174,18 @@ namespace Anvil
 
         /* Private variables */
         Anvil::DescriptorPoolCreateInfoUniquePtr m_create_info_ptr;
+        std::vector<uint32_t>                    m_ds_alloc_index_cache;
+        std::vector<VkDescriptorSet>             m_ds_alloc_result_cache;
         std::vector<VkDescriptorSet>             m_ds_cache;
         std::vector<VkDescriptorSetLayout>       m_ds_layout_cache;
         VkDescriptorPool                         m_pool;
+
+        /* Released sets, keyed by DescriptorSetLayout::get_unique_id() of their layouts. Vulkan handles of released
+         * layouts may be reused for new ones, so they cannot be used as keys. */
+        std::unordered_map<uint64_t, std::vector<VkDescriptorSet> > m_released_ds_per_layout;
+
+        Anvil::DescriptorPoolUsage m_peak_usage;
+        Anvil::DescriptorPoolUsage m_usage;
     };
 
 }; /* namespace Anvil */
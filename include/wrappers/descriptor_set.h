@@ -465,6 +465,48 @@ namespace Anvil
                                                            Anvil::ImageView**  out_opt_image_view_ptr_ptr,
                                                            Anvil::Sampler**    out_opt_sampler_ptr_ptr);
 
+        /** Returns a pointer to @param in_element_range.second VkDescriptorBufferInfo items, which are going to be written
+         *  as-is to the specified range of binding array elements at next bake time.
+         *
+         *  This is a low-overhead alternative to set_binding_array_items(): the descriptors are written directly to a staging
+         *  block owned by the set, without creating binding items. As a consequence, get_*_binding_properties() functions do
+         *  not reflect descriptors written this way. Raw writes are applied after the binding items updated for the same bake.
+         *
+         *  Can only be used for uniform & storage buffer bindings, including the dynamic ones.
+         *
+         *  @param in_binding_index Binding to write to.
+         *  @param in_element_range Range of array elements to write to. Must not exceed the binding's array size.
+         *
+         *  @return Pointer to the staging block region the caller must fill, or null if the request is invalid. The pointer
+         *          stays valid until the next get_raw_*() or update() call.
+         **/
+        VkDescriptorBufferInfo* get_raw_buffer_infos_ptr(BindingIndex             in_binding_index,
+                                                         BindingElementArrayRange in_element_range)
+        {
+            return reinterpret_cast<VkDescriptorBufferInfo*>(alloc_raw_write(in_binding_index,
+                                                                             in_element_range,
+                                                                             sizeof(VkDescriptorBufferInfo) ));
+        }
+
+        /** Works like get_raw_buffer_infos_ptr(), but for sampler, combined image+sampler, sampled image, storage image
+         *  and input attachment bindings. */
+        VkDescriptorImageInfo* get_raw_image_infos_ptr(BindingIndex             in_binding_index,
+                                                       BindingElementArrayRange in_element_range)
+        {
+            return reinterpret_cast<VkDescriptorImageInfo*>(alloc_raw_write(in_binding_index,
+                                                                            in_element_range,
+                                                                            sizeof(VkDescriptorImageInfo) ));
+        }
+
+        /** Works like get_raw_buffer_infos_ptr(), but for uniform & storage texel buffer bindings. */
+        VkBufferView* get_raw_texel_buffer_views_ptr(BindingIndex             in_binding_index,
+                                                     BindingElementArrayRange in_element_range)
+        {
+            return reinterpret_cast<VkBufferView*>(alloc_raw_write(in_binding_index,
+                                                                   in_element_range,
+                                                                   sizeof(VkBufferView) ));
+        }
+
         /** Retrieves raw Vulkan handle of the encapsulated descriptor set.
          *
          *  If the wrapper instance is marked as dirty, the function will bake the descriptor set,
@@ -543,6 +585,21 @@ namespace Anvil
                                             uint32_t         in_n_binding_array_item,
                                             Anvil::Sampler** out_sampler_ptr_ptr) const;
 
+        /** Tells whether all samplers written to a sampler or combined image+sampler binding so far were the same.
+         *  Distinct sampler instances created with equal create info structures are considered the same sampler.
+         *
+         *  Bindings updated with raw writes are never reported as using a uniform sampler.
+         *
+         *  @param in_n_binding        Binding index to use for the query.
+         *  @param out_sampler_ptr_ptr If the function returns true, deref will be set to the first sampler which
+         *                             has been written to the binding. Must not be null.
+         *
+         *  @return true if at least one sampler has been written to the binding and all samplers written so far
+         *          were the same, false otherwise.
+         */
+        bool get_uniform_sampler(BindingIndex           in_n_binding,
+                                 const Anvil::Sampler** out_sampler_ptr_ptr) const;
+
         /** Returns properties of a storage buffer descriptor binding.
          *
          *  @param in_n_binding             Binding index to use for the query.
@@ -667,10 +724,15 @@ namespace Anvil
          *
          *  This function CANNOT be used for inline uniform block binding updates. Instead, please use set_inline_uniform_block_binding_data().
          *
+         *  Only the elements whose contents has changed are written to the descriptor set at bake time. For bindings created
+         *  with the UPDATE_AFTER_BIND and PARTIALLY_BOUND flags, this makes it possible to keep a large descriptor array bound
+         *  and only refresh the slots which have been touched since the last bake.
+         *
          *  @param in_binding_index As per documentation. Must correspond to a binding which has earlier
          *                          been added by calling add_binding() function.
-         *  @param in_element_range As per documentation. Must not be equal to or larger than the array size,
-         *                          specified when calling add_binding() function.
+         *  @param in_element_range As per documentation. Must not exceed the array size specified when calling add_binding(),
+         *                          or the variable descriptor count specified at allocation time for variable descriptor
+         *                          count bindings.
          *  @param in_elements      As per documentation. Must not be nullptr.
          *
          *  @return true if the function executed successfully, false otherwise.
@@ -686,6 +748,17 @@ namespace Anvil
             BindingItemUniquePtrs& binding_item_ptrs  = m_binding_ptrs[in_binding_index];
             const uint32_t         last_element_index = in_element_range.second + in_element_range.first;
 
+            /* For variable descriptor count bindings, the number of binding items matches the count specified at allocation time */
+            if (last_element_index > binding_item_ptrs.size() )
+            {
+                anvil_assert(last_element_index <= binding_item_ptrs.size() );
+
+                return false;
+            }
+
+            uint32_t first_dirty_element_index = UINT32_MAX;
+            uint32_t last_dirty_element_index  = 0;
+
             for (BindingElementIndex current_element_index = in_element_range.first;
                                      current_element_index < last_element_index;
                                    ++current_element_index)
@@ -693,7 +766,12 @@ namespace Anvil
                 if (!( binding_item_ptrs[current_element_index]  != nullptr                                                         &&
                       *binding_item_ptrs[current_element_index] == in_elements_ptr[current_element_index - in_element_range.first]) )
                 {
-                    m_dirty = true;
+                    if (first_dirty_element_index == UINT32_MAX)
+                    {
+                        first_dirty_element_index = current_element_index;
+                    }
+
+                    last_dirty_element_index = current_element_index;
 
                     binding_item_ptrs[current_element_index].reset(
                         new Anvil::DescriptorSet::BindingItem()
@@ -701,12 +779,26 @@ namespace Anvil
 
                     *binding_item_ptrs[current_element_index] = in_elements_ptr[current_element_index - in_element_range.first];
                 }
+
+                if (binding_item_ptrs[current_element_index]->sampler_ptr != nullptr)
+                {
+                    on_sampler_written(in_binding_index,
+                                       binding_item_ptrs[current_element_index]->sampler_ptr);
+                }
+            }
+
+            if (first_dirty_element_index != UINT32_MAX)
+            {
+                mark_binding_elements_dirty(in_binding_index,
+                                            first_dirty_element_index,
+                                            last_dirty_element_index + 1);
             }
 
             return true;
         }
 
-        /* TODO
+        /** This function works exactly like the other set_binding_array_items() overload, except that it takes an array
+         *  of pointers to binding elements.
          *
          * NOTE: This function CANNOT be used for inline uniform block binding updates. Instead, please use set_inline_uniform_block_binding_data().
          */
@@ -721,17 +813,49 @@ namespace Anvil
             BindingItemUniquePtrs& binding_item_ptrs  = m_binding_ptrs[in_binding_index];
             const uint32_t         last_element_index = in_element_range.second + in_element_range.first;
 
+            if (last_element_index > binding_item_ptrs.size() )
+            {
+                anvil_assert(last_element_index <= binding_item_ptrs.size() );
+
+                return false;
+            }
+
+            uint32_t first_dirty_element_index = UINT32_MAX;
+            uint32_t last_dirty_element_index  = 0;
+
             for (BindingElementIndex current_element_index = in_element_range.first;
                                      current_element_index < last_element_index;
                                    ++current_element_index)
             {
-                m_dirty |= !(*binding_item_ptrs[current_element_index] == *in_elements_ptr_ptr[current_element_index - in_element_range.first]);
+                if (!( binding_item_ptrs[current_element_index]  != nullptr                                                              &&
+                      *binding_item_ptrs[current_element_index] == *in_elements_ptr_ptr[current_element_index - in_element_range.first]) )
+                {
+                    if (first_dirty_element_index == UINT32_MAX)
+                    {
+                        first_dirty_element_index = current_element_index;
+                    }
+
+                    last_dirty_element_index = current_element_index;
+
+                    binding_item_ptrs[current_element_index].reset(
+                        new Anvil::DescriptorSet::BindingItem()
+                    );
 
-                binding_item_ptrs[current_element_index].reset(
-                    new Anvil::DescriptorSet::BindingItem()
-                );
+                    *binding_item_ptrs[current_element_index] = *in_elements_ptr_ptr[current_element_index - in_element_range.first];
+                }
 
-                *binding_item_ptrs[current_element_index] = *in_elements_ptr_ptr[current_element_index - in_element_range.first];
+                if (binding_item_ptrs[current_element_index]->sampler_ptr != nullptr)
+                {
+                    on_sampler_written(in_binding_index,
+                                       binding_item_ptrs[current_element_index]->sampler_ptr);
+                }
+            }
+
+            if (first_dirty_element_index != UINT32_MAX)
+            {
+                mark_binding_elements_dirty(in_binding_index,
+                                            first_dirty_element_index,
+                                            last_dirty_element_index + 1);
             }
 
             return true;
@@ -775,14 +899,54 @@ namespace Anvil
                                                    const void*         in_raw_data_ptr,
                                                    const bool&         in_should_cache_raw_data);
 
+        /** Writes @param in_size bytes to the specified inline uniform block binding, starting at @param in_start_offset.
+         *
+         *  This is a low-overhead alternative to set_inline_uniform_block_binding_data(), intended for small constants which
+         *  change frequently, e.g. per draw call. The data is copied to the staging block used by raw writes, no binding item
+         *  is created and, at next bake time, only the specified byte range is rewritten. Consecutive writes to adjacent byte
+         *  ranges of the same binding are merged into a single VkWriteDescriptorSetInlineUniformBlockEXT update.
+         *
+         *  Requires VK_EXT_inline_uniform_block.
+         *
+         *  @param in_binding_index Index of the inline uniform block binding to write to.
+         *  @param in_start_offset  Start offset of the region to write. Must be a mul of 4.
+         *  @param in_size          Size of the region to write. Must be a mul of 4 and must not be 0. The region must not exceed
+         *                          the inline uniform block's size.
+         *  @param in_data_ptr      Data to write. Must not be nullptr. The data is copied, so the memory can be released as soon
+         *                          as the function returns.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool write_inline_uniform_block_data(BindingIndex in_binding_index,
+                                             uint32_t     in_start_offset,
+                                             uint32_t     in_size,
+                                             const void*  in_data_ptr);
+
         /** Updates internally-maintained Vulkan descriptor set instances.
          *
-         *  @param in_update_method Please see DescriptorSetUpdateMethod documentation for more details.
+         *  @param in_update_method Please see DescriptorSetUpdateMethod documentation for more details. With AUTO,
+         *                          the method is picked by the descriptor set's layout.
          *
          *  @return true if the function executed successfully, false otherwise.
          **/
         bool update(const DescriptorSetUpdateMethod& in_update_method = Anvil::DescriptorSetUpdateMethod::CORE) const;
 
+        /** Bakes all dirty descriptor sets from the specified array with a single vkUpdateDescriptorSets() call.
+         *
+         *  Equivalent to calling update() with the CORE update method for each set, but saves the driver the overhead
+         *  of a separate entry-point call per set. Scratch storage used to gather the write items is retained per thread,
+         *  so repeated calls do not allocate.
+         *
+         *  All sets must have been created for the same device.
+         *
+         *  @param in_n_sets  Number of elements available under @param in_ds_ptrs.
+         *  @param in_ds_ptrs Sets to bake. Null elements, duplicates and sets which are not dirty are skipped.
+         *
+         *  @return true if the function executed successfully, false otherwise.
+         **/
+        static bool update_multi(uint32_t                     in_n_sets,
+                                 Anvil::DescriptorSet* const* in_ds_ptrs);
+
     private:
         /* Private type declarations */
 
@@ -873,6 +1037,41 @@ namespace Anvil
         typedef std::vector<BindingItemUniquePtr>             BindingItemUniquePtrs;
         typedef std::map<BindingIndex, BindingItemUniquePtrs> BindingIndexToBindingItemUniquePtrsMap;
 
+        /* Describes a range of binding array elements, whose descriptors have been written to the raw staging block */
+        typedef struct RawWrite
+        {
+            BindingIndex          binding_index;
+            Anvil::DescriptorType descriptor_type;
+            uint32_t              n_elements;      /* in bytes for inline uniform blocks */
+            uint32_t              n_first_element; /* start offset in bytes for inline uniform blocks */
+            size_t                staging_offset;  /* in uint64_t units */
+        } RawWrite;
+
+        /* (first element index, last element index + 1) */
+        /* Tracks samplers written to a binding, for the purpose of immutable sampler promotion */
+        typedef struct ObservedSampler
+        {
+            bool                  is_uniform;
+            const Anvil::Sampler* sampler_ptr;
+
+            ObservedSampler()
+            {
+                is_uniform  = false;
+                sampler_ptr = nullptr;
+            }
+
+            explicit ObservedSampler(const Anvil::Sampler* in_sampler_ptr)
+            {
+                is_uniform  = true;
+                sampler_ptr = in_sampler_ptr;
+            }
+        } ObservedSampler;
+
+        typedef std::map<BindingIndex, ObservedSampler> BindingIndexToObservedSamplerMap;
+
+        typedef std::pair<uint32_t, uint32_t>                    BindingElementDirtyRange;
+        typedef std::map<BindingIndex, BindingElementDirtyRange> BindingIndexToBindingElementDirtyRangeMap;
+
         /* Private functions */
 
         /** Please see create() documentation for argument discussion */
@@ -907,9 +1106,52 @@ namespace Anvil
                                             VkDescriptorImageInfo*                     out_descriptor_ptr) const;
         void fill_iub_vk_descriptor        (const Anvil::DescriptorSet::BindingItem&   in_binding_item,
                                             VkWriteDescriptorSetInlineUniformBlockEXT* out_descriptor_ptr) const;
+
+        void* alloc_raw_write(BindingIndex             in_binding_index,
+                              BindingElementArrayRange in_element_range,
+                              size_t                   in_item_size);
+
+        /** Extends the range of array elements of binding @param in_binding_index, which need to be written at next
+         *  bake time, so that it covers <@param in_first_element_index, @param in_end_element_index). Also marks
+         *  the set as dirty.
+         */
+        void mark_binding_elements_dirty(BindingIndex in_binding_index,
+                                         uint32_t     in_first_element_index,
+                                         uint32_t     in_end_element_index)
+        {
+            auto range_iterator = m_dirty_binding_element_ranges.find(in_binding_index);
+
+            if (range_iterator == m_dirty_binding_element_ranges.end() )
+            {
+                m_dirty_binding_element_ranges[in_binding_index] = BindingElementDirtyRange(in_first_element_index,
+                                                                                            in_end_element_index);
+            }
+            else
+            {
+                if (range_iterator->second.first > in_first_element_index)
+                {
+                    range_iterator->second.first = in_first_element_index;
+                }
+
+                if (range_iterator->second.second < in_end_element_index)
+                {
+                    range_iterator->second.second = in_end_element_index;
+                }
+            }
+
+            m_dirty = true;
+        }
+
+        void on_core_writes_submitted      () const;
         void on_parent_pool_reset          ();
+        void on_raw_writes_submitted       () const;
+        void on_sampler_written            (BindingIndex          in_binding_index,
+                                            const Anvil::Sampler* in_sampler_ptr);
+        bool prepare_core_writes           () const;
+        void prepare_raw_writes            () const;
         bool update_using_core_method      () const;
         bool update_using_template_method  () const;
+        bool update_using_raw_writes       () const;
 
         /* Private variables */
 
@@ -920,6 +1162,13 @@ namespace Anvil
          */
         mutable BindingIndexToBindingItemUniquePtrsMap m_binding_ptrs;
 
+        /* Ranges of binding array elements which have been modified since the last bake. Bindings which have not been
+         * touched are not included, so that bakes only need to visit the modified elements.
+         */
+        mutable BindingIndexToBindingElementDirtyRangeMap m_dirty_binding_element_ranges;
+
+        /* Samplers written to sampler & combined image+sampler bindings. Only bindings which have been written to are included. */
+        BindingIndexToObservedSamplerMap m_observed_samplers;
 
         VkDescriptorSet                                m_descriptor_set;
         const Anvil::BaseDevice*                       m_device_ptr;
@@ -933,10 +1182,17 @@ namespace Anvil
         mutable std::vector<VkBufferView>                              m_cached_ds_info_texel_buffer_info_items_vk;
         mutable std::vector<VkWriteDescriptorSetInlineUniformBlockEXT> m_cached_ds_write_iub_items_vk;
         mutable std::vector<VkWriteDescriptorSet>                      m_cached_ds_write_items_vk;
+        mutable std::vector<VkWriteDescriptorSetInlineUniformBlockEXT> m_cached_raw_write_iub_items_vk;
+        mutable std::vector<VkWriteDescriptorSet>                      m_cached_raw_write_items_vk;
+        mutable std::vector<uint32_t>                                  m_cached_iub_binding_indices; /* IUB bindings processed by the last prepare_core_writes() call */
+
+        /* Raw writes pending until next bake. Storage is 64-bit aligned, which satisfies all descriptor info structures. */
+        mutable std::vector<RawWrite>                                  m_raw_writes;
+        mutable std::vector<uint64_t>                                  m_raw_staging;
 
-        mutable std::vector<DescriptorUpdateTemplateEntry>                                                     m_template_entries;
-        mutable std::map<std::vector<DescriptorUpdateTemplateEntry>, Anvil::DescriptorUpdateTemplateUniquePtr> m_template_object_map;
-        mutable std::vector<uint8_t>                                                                           m_template_raw_data;
+        mutable std::vector<DescriptorUpdateTemplateEntry> m_template_entries;
+        mutable std::vector<uint32_t>                      m_template_key;      /* (binding index, array element) pair per entry */
+        mutable std::vector<uint8_t>                       m_template_raw_data;
 
         friend class Anvil::DescriptorPool;
     };
@@ -44,7 +44,8 @@
  *  instance to re-use parent's DS layouts. Non-orphaned DescriptorSetGroup instances will throw an assertion failure if any
  *  call that would have modified the layout is issued.
  *
- *  Each DescriptorSetGroup instance uses its own VkDescriptorPool instance.
+ *  Each DescriptorSetGroup instance uses its own VkDescriptorPool instance, except for lightweight clones, which
+ *  allocate their descriptor sets from a TransientDescriptorSetAllocator.
  *
  *  DescriptorSetGroup instances are reference-counted.
  **/
@@ -103,6 +104,9 @@ namespace Anvil
          *  @param in_descriptor_pool_create_flags Create flags to specify when creating a descriptor pool for the DSG.
          *  @param in_mt_safety                    MT safety setting for the created object.
          *  @param in_opt_overhead_allocations     Extra allocations to request when creating a descriptor pool for the DSG.
+         *                                         Ignored if adaptive descriptor pool sizing is enabled and usage has been
+         *                                         recorded for DSGs using the same layouts. Please see
+         *                                         DescriptorPoolSizingProfile for more details.
          */
         static Anvil::DescriptorSetGroupUniquePtr create(const Anvil::BaseDevice*                              in_device_ptr,
                                                          std::vector<Anvil::DescriptorSetCreateInfoUniquePtr>& in_ds_create_info_ptrs,
@@ -121,6 +125,26 @@ namespace Anvil
          **/
         static DescriptorSetGroupUniquePtr create(const DescriptorSetGroup* in_parent_dsg_ptr);
 
+        /** Creates a new, lightweight DescriptorSetGroup instance, intended for per-frame copies of a DSG.
+         *
+         *  Unlike clones created with the function above, the new instance does not create a descriptor pool
+         *  and does not acquire its own references to the parent's layouts. Layouts and their create info
+         *  are shared with the parent by reference, and descriptor sets are allocated for the current frame
+         *  from @param in_allocator_ptr. Creating such a clone is therefore cheap enough to do every frame.
+         *
+         *  The descriptor sets are only valid until the allocator recycles the frame slot they have been
+         *  allocated for, so the clone should be re-created (and its bindings re-specified) after the slot's
+         *  begin_frame() call. The clone must not outlive its parent.
+         *
+         *  Layouts using UPDATE_AFTER_BIND bindings or inline uniform blocks are not supported. Please see
+         *  TransientDescriptorSetAllocator documentation for more details.
+         *
+         *  @param in_parent_dsg_ptr Pointer to a DSG without a parent. Must not be nullptr.
+         *  @param in_allocator_ptr  Allocator to allocate the descriptor sets from. Must not be nullptr.
+         **/
+        static DescriptorSetGroupUniquePtr create(const DescriptorSetGroup*               in_parent_dsg_ptr,
+                                                  Anvil::TransientDescriptorSetAllocator* in_allocator_ptr);
+
         /** Retrieves a Vulkan instance of the descriptor set, as configured for the DSG instance's set
          *  at index @param in_n_set.
          *
@@ -285,6 +309,14 @@ namespace Anvil
                                           &in_element);
         }
 
+        /** Bakes all dirty descriptor sets owned by the DSG with a single vkUpdateDescriptorSets() call.
+         *
+         *  Please see DescriptorSet::update_multi() for more details.
+         *
+         *  @return true if the function executed successfully, false otherwise.
+         **/
+        bool update_descriptor_sets();
+
     private:
         /* Private type declarations */
 
@@ -332,7 +364,8 @@ namespace Anvil
                            const std::vector<OverheadAllocation>&        in_opt_overhead_allocations = std::vector<OverheadAllocation>() );
 
         /** Please see create() documentation for more details. */
-        DescriptorSetGroup(const DescriptorSetGroup* in_parent_dsg_ptr);
+        DescriptorSetGroup(const DescriptorSetGroup*               in_parent_dsg_ptr,
+                           Anvil::TransientDescriptorSetAllocator* in_opt_transient_allocator_ptr);
 
         bool bake_descriptor_pool();
         bool bake_descriptor_sets();
@@ -345,9 +378,11 @@ namespace Anvil
 
         std::unordered_map<Anvil::DescriptorType, DescriptorTypeProperties, EnumClassHasher<Anvil::DescriptorType> > m_descriptor_type_properties;
 
-        const Anvil::DescriptorPoolCreateFlags m_descriptor_pool_create_flags;
-        uint32_t                               m_n_unique_dses;
-        const Anvil::DescriptorSetGroup*       m_parent_dsg_ptr;
+        const Anvil::DescriptorPoolCreateFlags  m_descriptor_pool_create_flags;
+        uint32_t                                m_n_unique_dses;
+        const Anvil::DescriptorSetGroup*        m_parent_dsg_ptr;
+        uint64_t                                m_sizing_profile_key;
+        Anvil::TransientDescriptorSetAllocator* m_transient_allocator_ptr;
 
         ANVIL_DISABLE_ASSIGNMENT_OPERATOR(DescriptorSetGroup);
         ANVIL_DISABLE_COPY_CONSTRUCTOR(DescriptorSetGroup);
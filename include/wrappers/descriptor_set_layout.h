@@ -33,9 +33,11 @@
 #include "misc/callbacks.h"
 #include "misc/debug_marker.h"
 #include "misc/mt_safety.h"
+#include "misc/time.h"
 #include "misc/types.h"
 #include "wrappers/sampler.h"
 #include <memory>
+#include <unordered_map>
 
 namespace Anvil
 {
@@ -84,6 +86,19 @@ namespace Anvil
             return m_layout;
         }
 
+        /** Returns an ID which identifies this layout instance. Unlike Vulkan handles, IDs are never reused, even
+         *  after the layout is released, so they can be used to key data associated with the layout.
+         **/
+        uint64_t get_unique_id() const
+        {
+            return m_unique_id;
+        }
+
+        /** Returns statistics of DescriptorSetUpdateMethod::AUTO updates of descriptor sets using this layout, including
+         *  the update method which has been selected, if any.
+         **/
+        Anvil::DescriptorSetUpdateMethodStats get_update_method_stats() const;
+
         /* Returns the maximum number of variable descriptor count binding size supported for the specified descriptor set layout.
          *
          * Requires VK_KHR_maintenance3 and VK_KHR_descriptor_indexing.
@@ -94,6 +109,13 @@ namespace Anvil
         static uint32_t get_maximum_variable_descriptor_count(const DescriptorSetLayoutCreateInfoContainer* in_ds_create_info_ptr,
                                                               const Anvil::BaseDevice*                      in_device_ptr);
 
+        /** Tells whether the layout identified by @param in_unique_id, as returned by get_unique_id(), has not
+         *  been released yet.
+         *
+         *  Thread-safe.
+         */
+        static bool is_unique_id_live(uint64_t in_unique_id);
+
         /* Checks if the specified descriptor set layout create info structure can be used to create a descriptor set layout instance.
          *
          * The app should call this function if the DS create info structure defines a number of descriptors that exceeds the 
@@ -108,8 +130,31 @@ namespace Anvil
                                                         const Anvil::BaseDevice*                      in_device_ptr);
 
     private:
+        /* Private type definitions */
+        typedef struct UpdateTemplateCacheItem
+        {
+            std::vector<uint32_t>                    key;
+            Anvil::DescriptorUpdateTemplateUniquePtr template_ptr;
+
+            UpdateTemplateCacheItem(const std::vector<uint32_t>&             in_key,
+                                    Anvil::DescriptorUpdateTemplateUniquePtr in_template_ptr)
+                :key         (in_key),
+                 template_ptr(std::move(in_template_ptr) )
+            {
+                /* Stub */
+            }
+        } UpdateTemplateCacheItem;
+
         /* Private functions */
 
+        Anvil::DescriptorSetUpdateMethod get_auto_update_method(bool* out_should_measure_ptr) const;
+        void                             on_auto_update_measured(Anvil::DescriptorSetUpdateMethod in_update_method,
+                                                                 uint64_t                         in_duration_nsec) const;
+
+        const Anvil::DescriptorUpdateTemplate* get_update_template(uint64_t                                          in_key_hash,
+                                                                   const std::vector<uint32_t>&                      in_key,
+                                                                   const std::vector<DescriptorUpdateTemplateEntry>& in_entries) const;
+
         /** Converts internal layout representation to a Vulkan object.
          *
          *  The baking will only occur if the object is internally marked as dirty. If it is not,
@@ -131,6 +176,17 @@ namespace Anvil
         DescriptorSetCreateInfoUniquePtr m_create_info_ptr;
         const Anvil::BaseDevice*         m_device_ptr;
         VkDescriptorSetLayout            m_layout;
+        const uint64_t                   m_unique_id;
+
+        /* Descriptor update templates, shared by all descriptor sets using this layout. Keyed by hash of the list of
+         * updated (binding, array element) pairs. */
+        mutable std::unordered_map<uint64_t, std::vector<UpdateTemplateCacheItem> > m_update_template_cache;
+
+        /* State of DescriptorSetUpdateMethod::AUTO update method selection. */
+        mutable Anvil::DescriptorSetUpdateMethodStats m_update_method_stats;
+        Anvil::Time                                   m_update_method_timer;
+
+        friend class Anvil::DescriptorSet; /* get_auto_update_method(), get_update_template(), on_auto_update_measured() */
     };
 }; /* namespace Anvil */
 
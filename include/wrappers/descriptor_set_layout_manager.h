@@ -25,6 +25,7 @@
 
 #include "misc/mt_safety.h"
 #include "misc/types.h"
+#include <unordered_map>
 
 namespace Anvil
 {
@@ -58,6 +59,10 @@ namespace Anvil
 
         typedef std::vector<std::unique_ptr<DescriptorSetLayoutContainer> > DescriptorSetLayouts;
 
+        /* Layouts are bucketed by DescriptorSetCreateInfo::get_hash(), so that lookups only need to compare create info
+         * instances which are likely to match. */
+        typedef std::unordered_map<uint64_t, DescriptorSetLayouts> HashToDescriptorSetLayoutsMap;
+
         /* Private functions */
         DescriptorSetLayoutManager(const Anvil::BaseDevice* in_device_ptr,
                                    bool                     in_mt_safe);
@@ -71,8 +76,8 @@ namespace Anvil
                                                                  bool                     in_mt_safe);
 
         /* Private members */
-        const Anvil::BaseDevice* m_device_ptr;
-        DescriptorSetLayouts     m_descriptor_set_layouts;
+        const Anvil::BaseDevice*      m_device_ptr;
+        HashToDescriptorSetLayoutsMap m_descriptor_set_layouts;
 
         friend class BaseDevice;
     };
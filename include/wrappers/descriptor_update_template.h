@@ -69,6 +69,45 @@ namespace Anvil
                                                                                           const uint32_t&                             in_n_update_entries,
                                                                                           MTSafety                                    in_mt_safety = Anvil::MTSafety::INHERIT_FROM_PARENT_DEVICE);
 
+        /** Creates a new DescriptorUpdateTemplate instance which can be used to push descriptors with
+         *  CommandBufferBase::record_push_descriptor_set_with_template_KHR().
+         *
+         *  Requires VK_KHR_push_descriptor.
+         *
+         *  @param in_device_ptr                Device the template will be created for. Must not be null.
+         *  @param in_descriptor_set_layout_ptr DS layout to use as reference when creating the template. Must
+         *                                      have been created with PUSH_DESCRIPTOR_BIT_KHR. Must not be null.
+         *  @param in_pipeline_bind_point       Pipeline bind point the descriptors are going to be pushed for.
+         *  @param in_pipeline_layout_ptr       Pipeline layout the descriptors are going to be pushed for. Must not be null.
+         *  @param in_n_set                     Index of the push descriptor set in @param in_pipeline_layout_ptr.
+         **/
+        static Anvil::DescriptorUpdateTemplateUniquePtr create_for_push_descriptor_updates(const Anvil::BaseDevice*                                 in_device_ptr,
+                                                                                           const Anvil::DescriptorSetLayout*                        in_descriptor_set_layout_ptr,
+                                                                                           const std::vector<Anvil::DescriptorUpdateTemplateEntry>& in_update_entries,
+                                                                                           Anvil::PipelineBindPoint                                 in_pipeline_bind_point,
+                                                                                           const Anvil::PipelineLayout*                             in_pipeline_layout_ptr,
+                                                                                           uint32_t                                                 in_n_set,
+                                                                                           MTSafety                                                 in_mt_safety = Anvil::MTSafety::INHERIT_FROM_PARENT_DEVICE);
+
+        /** Returns the number of bytes the template reads, starting at the data pointer passed to
+         *  an update or push call. */
+        size_t get_data_size() const
+        {
+            return m_data_size;
+        }
+
+        /** Returns the raw Vulkan handle of the template. */
+        VkDescriptorUpdateTemplateKHR get_descriptor_update_template() const
+        {
+            return m_vk_object;
+        }
+
+        /** Tells whether the template has been created with create_for_push_descriptor_updates(). */
+        bool is_push_descriptor_template() const
+        {
+            return m_is_push_descriptor_template;
+        }
+
         /* Issues a MT-safe (if needed) vkUpdateDescriptorSetWithTeeplateKHR() call against the specified descriptor set. */
         void update_descriptor_set(const Anvil::DescriptorSet* inout_ds_ptr,
                                    const void*                 in_data_ptr) const;
@@ -78,7 +117,10 @@ namespace Anvil
 
         bool init(const Anvil::DescriptorSetLayout*           in_descriptor_set_layout_ptr,
                   const Anvil::DescriptorUpdateTemplateEntry* in_update_entries_ptr,
-                  const uint32_t&                             in_n_update_entries);
+                  const uint32_t&                             in_n_update_entries,
+                  const Anvil::PipelineLayout*                in_opt_push_pipeline_layout_ptr,
+                  Anvil::PipelineBindPoint                    in_push_pipeline_bind_point,
+                  uint32_t                                    in_push_n_set);
 
         /* Please see create() documentation for more details */
         DescriptorUpdateTemplate(const Anvil::BaseDevice* in_device_ptr,
@@ -88,8 +130,10 @@ namespace Anvil
         ANVIL_DISABLE_COPY_CONSTRUCTOR   (DescriptorUpdateTemplate);
 
         /* Private variables */
+        size_t                                  m_data_size;
         const Anvil::BaseDevice*                m_device_ptr;
         Anvil::DescriptorSetCreateInfoUniquePtr m_ds_create_info_ptr;
+        bool                                    m_is_push_descriptor_template;
         VkDescriptorUpdateTemplateKHR           m_vk_object;
     };
 }; /* namespace Anvil */
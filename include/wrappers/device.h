@@ -35,9 +35,12 @@
 #include "misc/device_create_info.h"
 #include "misc/extensions.h"
 #include "misc/mt_safety.h"
+#include "misc/pools.h"
 #include "misc/struct_chainer.h"
 #include "misc/types.h"
 #include <algorithm>
+#include <map>
+#include <thread>
 
 namespace Anvil
 {
@@ -51,6 +54,76 @@ namespace Anvil
 
         virtual ~BaseDevice();
 
+        /** Returns allocation callbacks to pass to Vulkan functions which create or destroy device-level objects.
+         *
+         *  These come from the host allocator specified with DeviceCreateInfo::set_host_allocator() or, if none
+         *  was specified, the parent instance's. Null if neither specifies a host allocator.
+         */
+        const VkAllocationCallbacks* get_allocation_callbacks_vk() const
+        {
+            return m_allocation_callbacks_vk_ptr;
+        }
+
+        /** Retrieves an unsignalled event from a device-wide recycling pool. The pool is created on first use.
+         *
+         *  Releasing the returned pointer puts the event back in the pool, so per-submission synchronization
+         *  does not need to create and destroy Vulkan objects. The event must no longer be used by the device
+         *  at release time. All pooled events must be released before the device is destroyed.
+         *
+         *  @return As per description
+         **/
+        Anvil::EventUniquePtr acquire_event() const;
+
+        /** Retrieves an unsignalled fence from a device-wide recycling pool. The pool is created on first use.
+         *
+         *  Releasing the returned pointer puts the fence back in the pool. Returned fences are reset in batches
+         *  with a single vkResetFences() call, once the pool runs out of ready fences. Fences used in a submission
+         *  must have been waited on before they are released. All pooled fences must be released before the device
+         *  is destroyed.
+         *
+         *  @return As per description
+         **/
+        Anvil::FenceUniquePtr acquire_fence() const;
+
+        /** Retrieves an unsignalled binary semaphore from a device-wide recycling pool. The pool is created on first use.
+         *
+         *  Releasing the returned pointer puts the semaphore back in the pool. A signalled semaphore must only be
+         *  released once a wait operation consuming the signal has finished executing. All pooled semaphores must be
+         *  released before the device is destroyed.
+         *
+         *  @return As per description
+         **/
+        Anvil::SemaphoreUniquePtr acquire_semaphore() const;
+
+        /** Retrieves time domains which the device can sample calibrated timestamps in.
+         *
+         *  Requires VK_EXT_calibrated_timestamps. For multi-GPU devices, the first physical device is queried.
+         *
+         *  @param out_time_domains_ptr Deref will be set to the list of supported time domains. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool get_calibrateable_time_domains(std::vector<Anvil::TimeDomainEXT>* out_time_domains_ptr) const;
+
+        /** Samples timestamps in multiple time domains at (nearly) the same moment.
+         *
+         *  Requires VK_EXT_calibrated_timestamps. Timestamps are returned in each domain's native units: ticks
+         *  for TimeDomainEXT::DEVICE_EXT (multiply by the timestampPeriod limit to get nanoseconds), nanoseconds
+         *  for clock domains, and ticks for TimeDomainEXT::QUERY_PERFORMANCE_COUNTER_EXT.
+         *
+         *  @param in_time_domains           Domains to sample. Each domain must be reported by
+         *                                   get_calibrateable_time_domains(), and must not be specified more than once.
+         *  @param out_timestamps_ptr        Deref will be set to the timestamps, in the order of @param in_time_domains.
+         *                                   Must not be null.
+         *  @param out_opt_max_deviation_ptr If not null, deref will be set to the maximum deviation between the
+         *                                   moments at which the timestamps were sampled, in nanoseconds.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool get_calibrated_timestamps(const std::vector<Anvil::TimeDomainEXT>& in_time_domains,
+                                       std::vector<uint64_t>*                out_timestamps_ptr,
+                                       uint64_t*                             out_opt_max_deviation_ptr = nullptr) const;
+
         /** Retrieves a command pool, created for the specified queue family index.
          *
          *  @param in_vk_queue_family_index Vulkan index of the queue family to return the command pool for.
@@ -62,6 +135,49 @@ namespace Anvil
             return m_command_pool_ptr_per_vk_queue_fam.at(in_vk_queue_family_index).get();
         }
 
+        /** Retrieves a command pool, created for the specified queue family index, which is exclusive to the
+         *  calling thread. The pool is created on first use.
+         *
+         *  The pool is not MT-safe. Command buffers allocated from it must only be recorded, reset and released
+         *  by the calling thread. In exchange, allocating & recording command buffers does not contend with
+         *  any other thread.
+         *
+         *  Do NOT release. The pool is owned by Device and will be released at object tear-down time, even if
+         *  the thread which has requested it exits earlier.
+         *
+         *  @param in_vk_queue_family_index Vulkan index of the queue family to return the command pool for.
+         *
+         *  @return As per description
+         **/
+        Anvil::CommandPool* get_thread_command_pool_for_queue_family_index(uint32_t in_vk_queue_family_index) const;
+
+        /** Returns usage statistics of all command pools returned by get_thread_command_pool_for_queue_family_index()
+         *  so far, grouped by the thread which has requested them. Useful for telling which threads hold on to
+         *  command memory.
+         *
+         *  Must not be called while reset_thread_command_pools() executes.
+         *
+         *  @param out_stats_ptr Deref will be set to a map of thread IDs to stats of each of the thread's command
+         *                       pools. Must not be nullptr.
+         **/
+        void get_thread_command_pool_stats(std::map<std::thread::id, std::vector<Anvil::CommandPoolStats> >* out_stats_ptr) const;
+
+        /** Returns the device-wide scheduler for frame-budgeted background work. Please see
+         *  misc/background_work_scheduler.h for more details. It is created on first use.
+         *
+         *  Do NOT release. This object is owned by Device and will be released at object tear-down time.
+         **/
+        Anvil::BackgroundWorkScheduler* get_background_work_scheduler() const;
+
+        /** Returns the device-wide GPU completion call-back service.
+         *
+         *  The service dispatches call-backs once fences or timeline semaphores become signalled, so that
+         *  subsystems do not need to poll them. It is created on first use.
+         *
+         *  Do NOT release. This object is owned by Device and will be released at object tear-down time.
+         **/
+        Anvil::CompletionService* get_completion_service() const;
+
         /** Retrieves a compute pipeline manager, created for this device instance.
          *
          *  @return As per description
@@ -99,6 +215,23 @@ namespace Anvil
             return m_descriptor_set_layout_manager_ptr.get();
         }
 
+        /** Returns the device-wide deferred deletion queue.
+         *
+         *  Objects which may still be referenced by GPU work in flight can be handed over to the queue instead
+         *  of being released straight away. The queue is created on first use.
+         *
+         *  Do NOT release. This object is owned by Device and will be released at object tear-down time.
+         **/
+        Anvil::DeferredDeletionQueue* get_deferred_deletion_queue() const;
+
+        /** Returns the device-wide record of descriptor pool usage, which DescriptorSetGroup and
+         *  TransientDescriptorSetAllocator use to size new pools adaptively. Please see
+         *  misc/descriptor_pool_sizing_profile.h for more details. It is created on first use.
+         *
+         *  Do NOT release. This object is owned by Device and will be released at object tear-down time.
+         **/
+        Anvil::DescriptorPoolSizingProfile* get_descriptor_pool_sizing_profile() const;
+
         /** Retrieves a raw Vulkan handle for this device.
          *
          *  @return As per description
@@ -128,6 +261,7 @@ namespace Anvil
         const ExtensionAMDBufferMarkerEntrypoints& get_extension_amd_buffer_marker_entrypoints() const
         {
             anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->amd_buffer_marker() );
+            resolve_extension_func_ptrs();
 
             return m_amd_buffer_marker_extension_entrypoints;
         }
@@ -140,6 +274,7 @@ namespace Anvil
         const ExtensionAMDDrawIndirectCountEntrypoints& get_extension_amd_draw_indirect_count_entrypoints() const
         {
             anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->amd_draw_indirect_count() );
+            resolve_extension_func_ptrs();
 
             return m_amd_draw_indirect_count_extension_entrypoints;
         }
@@ -151,10 +286,35 @@ namespace Anvil
         const ExtensionAMDShaderInfoEntrypoints& get_extension_amd_shader_info_entrypoints() const
         {
             anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->amd_shader_info() );
+            resolve_extension_func_ptrs();
 
             return m_amd_shader_info_extension_entrypoints;
         }
 
+        /** Returns a container with entry-points to functions introduced by VK_EXT_calibrated_timestamps extension.
+         *
+         *  Will fire an assertion failure if the extension is not supported.
+         **/
+        const ExtensionEXTCalibratedTimestampsEntrypoints& get_extension_ext_calibrated_timestamps_entrypoints() const
+        {
+            anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->ext_calibrated_timestamps() );
+            resolve_extension_func_ptrs();
+
+            return m_ext_calibrated_timestamps_extension_entrypoints;
+        }
+
+        /** Returns a container with entry-points to functions introduced by VK_EXT_conditional_rendering extension.
+         *
+         *  Will fire an assertion failure if the extension is not supported.
+         **/
+        const ExtensionEXTConditionalRenderingEntrypoints& get_extension_ext_conditional_rendering_entrypoints() const
+        {
+            anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->ext_conditional_rendering() );
+            resolve_extension_func_ptrs();
+
+            return m_ext_conditional_rendering_extension_entrypoints;
+        }
+
         /** Returns a container with entry-points to functions introduced by VK_EXT_debug_marker extension.
          *
          *  Will fire an assertion failure if the extension is not supported.
@@ -162,6 +322,7 @@ namespace Anvil
         const ExtensionEXTDebugMarkerEntrypoints& get_extension_ext_debug_marker_entrypoints() const
         {
             anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->ext_debug_marker() );
+            resolve_extension_func_ptrs();
 
             return m_ext_debug_marker_extension_entrypoints;
         }
@@ -173,6 +334,7 @@ namespace Anvil
         const ExtensionEXTExternalMemoryHostEntrypoints& get_extension_ext_external_memory_host_entrypoints() const
         {
             anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->ext_external_memory_host() );
+            resolve_extension_func_ptrs();
 
             return m_ext_external_memory_host_extension_entrypoints;
         }
@@ -184,10 +346,47 @@ namespace Anvil
         const ExtensionEXTHdrMetadataEntrypoints& get_extension_ext_hdr_metadata_entrypoints() const
         {
             anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->ext_hdr_metadata() );
+            resolve_extension_func_ptrs();
 
             return m_ext_hdr_metadata_extension_entrypoints;
         }
 
+        /** Returns a container with entry-points to functions introduced by VK_EXT_host_image_copy extension.
+         *
+         *  Will fire an assertion failure if the extension is not supported.
+         **/
+        const ExtensionEXTHostImageCopyEntrypoints& get_extension_ext_host_image_copy_entrypoints() const
+        {
+            anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->ext_host_image_copy() );
+            resolve_extension_func_ptrs();
+
+            return m_ext_host_image_copy_extension_entrypoints;
+        }
+
+        /** Returns a container with entry-points to functions introduced by VK_EXT_host_query_reset extension.
+         *
+         *  Will fire an assertion failure if the extension is not supported.
+         **/
+        const ExtensionEXTHostQueryResetEntrypoints& get_extension_ext_host_query_reset_entrypoints() const
+        {
+            anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->ext_host_query_reset() );
+            resolve_extension_func_ptrs();
+
+            return m_ext_host_query_reset_extension_entrypoints;
+        }
+
+        /** Returns a container with entry-points to functions introduced by VK_EXT_pageable_device_local_memory extension.
+         *
+         *  Will fire an assertion failure if the extension is not supported.
+         **/
+        const ExtensionEXTPageableDeviceLocalMemoryEntrypoints& get_extension_ext_pageable_device_local_memory_entrypoints() const
+        {
+            anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->ext_pageable_device_local_memory() );
+            resolve_extension_func_ptrs();
+
+            return m_ext_pageable_device_local_memory_extension_entrypoints;
+        }
+
         /** Returns a container with entry-points to functions introduced by VK_EXT_sample_locations extension.
          *
          *  Will fire an assertion failure if the extension is not supported.
@@ -200,18 +399,47 @@ namespace Anvil
          **/
         const ExtensionEXTTransformFeedbackEntrypoints& get_extension_ext_transform_feedback_entrypoints() const;
 
+        /** Returns a container with entry-points to functions introduced by VK_GOOGLE_display_timing extension. **/
+        const ExtensionGOOGLEDisplayTimingEntrypoints& get_extension_google_display_timing_entrypoints() const
+        {
+            anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->google_display_timing() );
+            resolve_extension_func_ptrs();
+
+            return m_google_display_timing_extension_entrypoints;
+        }
+
+        /** Returns a container with entry-points to functions introduced by VK_KHR_acceleration_structure extension. **/
+        const ExtensionKHRAccelerationStructureEntrypoints& get_extension_khr_acceleration_structure_entrypoints() const
+        {
+            anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_acceleration_structure() );
+            resolve_extension_func_ptrs();
+
+            return m_khr_acceleration_structure_extension_entrypoints;
+        }
+
         /** Returns a container with entry-points to functions introduced by VK_KHR_bind_memory2 extension. **/
         const ExtensionKHRBindMemory2Entrypoints& get_extension_khr_bind_memory2_entrypoints() const
         {
             anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_bind_memory2() );
+            resolve_extension_func_ptrs();
 
             return m_khr_bind_memory2_extension_entrypoints;
         }
 
+        /** Returns a container with entry-points to functions introduced by VK_KHR_buffer_device_address extension. **/
+        const ExtensionKHRBufferDeviceAddressEntrypoints& get_extension_khr_buffer_device_address_entrypoints() const
+        {
+            anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_buffer_device_address() );
+            resolve_extension_func_ptrs();
+
+            return m_khr_buffer_device_address_extension_entrypoints;
+        }
+
         /** Returns a container with entry-points to functions introduced by VK_KHR_create_renderpass2 extension. **/
         const ExtensionKHRCreateRenderpass2Entrypoints& get_extension_khr_create_renderpass2_entrypoints() const
         {
             anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_create_renderpass2() );
+            resolve_extension_func_ptrs();
 
             return m_khr_create_renderpass2_extension_entrypoints;
         }
@@ -220,6 +448,7 @@ namespace Anvil
         const ExtensionKHRDescriptorUpdateTemplateEntrypoints& get_extension_khr_descriptor_update_template_entrypoints() const
         {
             anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_descriptor_update_template() );
+            resolve_extension_func_ptrs();
 
             return m_khr_descriptor_update_template_extension_entrypoints;
         }
@@ -228,6 +457,7 @@ namespace Anvil
         const ExtensionKHRDeviceGroupEntrypoints& get_extension_khr_device_group_entrypoints() const
         {
             anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_device_group() );
+            resolve_extension_func_ptrs();
 
             return m_khr_device_group_extension_entrypoints;
         }
@@ -239,14 +469,28 @@ namespace Anvil
         const ExtensionKHRDrawIndirectCountEntrypoints& get_extension_khr_draw_indirect_count_entrypoints() const
         {
             anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_draw_indirect_count() );
+            resolve_extension_func_ptrs();
 
             return m_khr_draw_indirect_count_extension_entrypoints;
         }
 
+        /** Returns a container with entry-points to functions introduced by VK_KHR_dynamic_rendering extension.
+         *
+         *  Will fire an assertion failure if the extension was not requested at device creation time.
+         **/
+        const ExtensionKHRDynamicRenderingEntrypoints& get_extension_khr_dynamic_rendering_entrypoints() const
+        {
+            anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_dynamic_rendering() );
+            resolve_extension_func_ptrs();
+
+            return m_khr_dynamic_rendering_extension_entrypoints;
+        }
+
         #if defined(_WIN32)
             const ExtensionKHRExternalFenceWin32Entrypoints& get_extension_khr_external_fence_win32_entrypoints() const
             {
                 anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_external_fence_win32() );
+                resolve_extension_func_ptrs();
 
                 return m_khr_external_fence_win32_extension_entrypoints;
             }
@@ -254,6 +498,7 @@ namespace Anvil
             const ExtensionKHRExternalMemoryWin32Entrypoints& get_extension_khr_external_memory_win32_entrypoints() const
             {
                 anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_external_memory_win32() );
+                resolve_extension_func_ptrs();
 
                 return m_khr_external_memory_win32_extension_entrypoints;
             }
@@ -261,6 +506,7 @@ namespace Anvil
             const ExtensionKHRExternalSemaphoreWin32Entrypoints& get_extension_khr_external_semaphore_win32_entrypoints() const
             {
                 anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_external_semaphore_win32() );
+                resolve_extension_func_ptrs();
 
                 return m_khr_external_semaphore_win32_extension_entrypoints;
             }
@@ -268,6 +514,7 @@ namespace Anvil
             const ExtensionKHRExternalFenceFdEntrypoints& get_extension_khr_external_fence_fd_entrypoints() const
             {
                 anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_external_fence_fd() );
+                resolve_extension_func_ptrs();
 
                 return m_khr_external_fence_fd_extension_entrypoints;
             }
@@ -275,6 +522,7 @@ namespace Anvil
             const ExtensionKHRExternalMemoryFdEntrypoints& get_extension_khr_external_memory_fd_entrypoints() const
             {
                 anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_external_memory_fd() );
+                resolve_extension_func_ptrs();
 
                 return m_khr_external_memory_fd_extension_entrypoints;
             }
@@ -282,6 +530,7 @@ namespace Anvil
             const ExtensionKHRExternalSemaphoreFdEntrypoints& get_extension_khr_external_semaphore_fd_entrypoints() const
             {
                 anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_external_semaphore_fd() );
+                resolve_extension_func_ptrs();
 
                 return m_khr_external_semaphore_fd_extension_entrypoints;
             }
@@ -291,6 +540,7 @@ namespace Anvil
         const ExtensionKHRGetMemoryRequirements2Entrypoints& get_extension_khr_get_memory_requirements2_entrypoints() const
         {
             anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_get_memory_requirements2() );
+            resolve_extension_func_ptrs();
 
             return m_khr_get_memory_requirements2_extension_entrypoints;
         }
@@ -299,6 +549,7 @@ namespace Anvil
         const ExtensionKHRMaintenance1Entrypoints& get_extension_khr_maintenance1_entrypoints() const
         {
             anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_maintenance1() );
+            resolve_extension_func_ptrs();
 
             return m_khr_maintenance1_extension_entrypoints;
         }
@@ -307,14 +558,38 @@ namespace Anvil
         const ExtensionKHRMaintenance3Entrypoints& get_extension_khr_maintenance3_entrypoints() const
         {
             anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_maintenance3() );
+            resolve_extension_func_ptrs();
 
             return m_khr_maintenance3_extension_entrypoints;
         }
 
+        /** Returns a container with entry-points to functions introduced by VK_KHR_pipeline_executable_properties extension. **/
+        const ExtensionKHRPipelineExecutablePropertiesEntrypoints& get_extension_khr_pipeline_executable_properties_entrypoints() const
+        {
+            anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_pipeline_executable_properties() );
+            resolve_extension_func_ptrs();
+
+            return m_khr_pipeline_executable_properties_extension_entrypoints;
+        }
+
+        /** Returns a container with entry-points to functions introduced by VK_KHR_push_descriptor extension.
+         *
+         *  vkCmdPushDescriptorSetWithTemplateKHR is only available if VK_KHR_descriptor_update_template is also
+         *  supported, or the device is a Vulkan 1.1 device.
+         **/
+        const ExtensionKHRPushDescriptorEntrypoints& get_extension_khr_push_descriptor_entrypoints() const
+        {
+            anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_push_descriptor() );
+            resolve_extension_func_ptrs();
+
+            return m_khr_push_descriptor_extension_entrypoints;
+        }
+
         /** Returns a container with entry-points to functions introduced by VK_KHR_sampler_ycbcr_conversion extension. **/
         const ExtensionKHRSamplerYCbCrConversionEntrypoints& get_extension_khr_sampler_ycbcr_conversion_entrypoints() const
         {
             anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_sampler_ycbcr_conversion() );
+            resolve_extension_func_ptrs();
 
             return m_khr_sampler_ycbcr_conversion_extension_entrypoints;
         }
@@ -326,10 +601,47 @@ namespace Anvil
         const ExtensionKHRSwapchainEntrypoints& get_extension_khr_swapchain_entrypoints() const
         {
             anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_swapchain() );
+            resolve_extension_func_ptrs();
 
             return m_khr_swapchain_extension_entrypoints;
         }
 
+        /** Returns a container with entry-points to functions introduced by VK_KHR_timeline_semaphore extension.
+         *
+         *  Will fire an assertion failure if the extension was not requested at device creation time.
+         **/
+        const ExtensionKHRTimelineSemaphoreEntrypoints& get_extension_khr_timeline_semaphore_entrypoints() const
+        {
+            anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_timeline_semaphore() );
+            resolve_extension_func_ptrs();
+
+            return m_khr_timeline_semaphore_extension_entrypoints;
+        }
+
+        /** Returns a container with entry-points to functions introduced by VK_NV_mesh_shader extension.
+         *
+         *  Will fire an assertion failure if the extension was not requested at device creation time.
+         **/
+        const ExtensionNVMeshShaderEntrypoints& get_extension_nv_mesh_shader_entrypoints() const
+        {
+            anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->nv_mesh_shader() );
+            resolve_extension_func_ptrs();
+
+            return m_nv_mesh_shader_extension_entrypoints;
+        }
+
+        /** Returns a container with entry-points to functions introduced by VK_NV_shading_rate_image extension.
+         *
+         *  Will fire an assertion failure if the extension was not requested at device creation time.
+         **/
+        const ExtensionNVShadingRateImageEntrypoints& get_extension_nv_shading_rate_image_entrypoints() const
+        {
+            anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->nv_shading_rate_image() );
+            resolve_extension_func_ptrs();
+
+            return m_nv_shading_rate_image_extension_entrypoints;
+        }
+
         /** Retrieves a graphics pipeline manager, created for this device instance.
          *
          *  @return As per description
@@ -511,6 +823,19 @@ namespace Anvil
             return get_proc_address(in_name.c_str() );
         }
 
+        /** Returns a queue of the specified family type which suits latency-sensitive submissions best. This is
+         *  the queue with the highest global priority that was granted at device creation time and, amongst such
+         *  queues, the one with the highest priority.
+         *
+         *  Priorities can be assigned with DeviceCreateInfo::set_queue_global_priority() and
+         *  DeviceCreateInfo::set_queue_priority().
+         *
+         *  @param in_queue_family_type Queue family type to return the queue for.
+         *
+         *  @return As per description, or nullptr if no queue of the requested type is available.
+         **/
+        Anvil::Queue* get_high_priority_queue(const Anvil::QueueFamilyType& in_queue_family_type) const;
+
         /** TODO */
         Anvil::Queue* get_queue(const Anvil::QueueFamilyType& in_queue_family_type,
                                 uint32_t                      in_n_queue) const;
@@ -556,12 +881,88 @@ namespace Anvil
         bool get_sample_locations(Anvil::SampleCountFlagBits          in_sample_count,
                                   std::vector<Anvil::SampleLocation>* out_result_ptr) const;
 
+        /** Returns the device-wide framebuffer cache. Framebuffers for frequently used attachment combinations
+         *  should be requested from the cache instead of being re-created, so that framebuffers are shared between
+         *  compatible render passes. The cache is created on first use.
+         *
+         *  Do NOT release. This object is owned by Device and will be released at object tear-down time.
+         **/
+        Anvil::FramebufferCache* get_framebuffer_cache() const;
+
+        /** Returns the device-wide render pass cache. Render passes which may be re-created many times with
+         *  identical properties should be requested from the cache instead of being created with
+         *  RenderPass::create(), so that identical render passes are only baked once. The cache is created on
+         *  first use.
+         *
+         *  Do NOT release. This object is owned by Device and will be released at object tear-down time.
+         **/
+        Anvil::RenderPassCache* get_render_pass_cache() const;
+
+        /** Returns the device-wide sampler cache. Samplers which are shared by many objects (eg. materials) should
+         *  be requested from the cache instead of being created with Sampler::create(), so that identical samplers
+         *  are only created once. The cache is created on first use.
+         *
+         *  Do NOT release. This object is owned by Device and will be released at object tear-down time.
+         **/
+        Anvil::SamplerCache* get_sampler_cache() const;
+
         /** Returns shader module cache instance */
         Anvil::ShaderModuleCache* get_shader_module_cache() const
         {
             return m_shader_module_cache_ptr.get();
         }
 
+        /** Returns the device-wide staging ring, or nullptr if the ring has been disabled at creation time.
+         *
+         *  The ring is created on first use.
+         *
+         *  Do NOT release. This object is owned by Device and will be released at object tear-down time.
+         **/
+        Anvil::StagingRing* get_staging_ring() const;
+
+        /** Returns the (name, value) pairs injected into every GLSLShaderToSPIRVGenerator created for this device.
+         *
+         *  Empty unless DeviceCreateInfo::set_storage_feature_probe() was called with true. Otherwise, holds one
+         *  entry set to "1" for each of the following features which has been enabled for the device:
+         *
+         *  ANVIL_STORAGE_BUFFER_16BIT_ACCESS, ANVIL_UNIFORM_AND_STORAGE_BUFFER_16BIT_ACCESS,
+         *  ANVIL_STORAGE_PUSH_CONSTANT_16, ANVIL_STORAGE_INPUT_OUTPUT_16 (VK_KHR_16bit_storage),
+         *  ANVIL_STORAGE_BUFFER_8BIT_ACCESS, ANVIL_UNIFORM_AND_STORAGE_BUFFER_8BIT_ACCESS,
+         *  ANVIL_STORAGE_PUSH_CONSTANT_8 (VK_KHR_8bit_storage),
+         *  ANVIL_SHADER_FLOAT16, ANVIL_SHADER_INT8 (VK_KHR_shader_float16_int8),
+         *  ANVIL_SCALAR_BLOCK_LAYOUT (VK_EXT_scalar_block_layout).
+         **/
+        const std::vector<std::pair<std::string, std::string> >& get_storage_feature_shader_definitions() const
+        {
+            return m_storage_feature_shader_definitions;
+        }
+
+        /** Returns time spent in consecutive phases of device initialization, in the order they were executed. */
+        const std::vector<Anvil::StartupPhaseTiming>& get_startup_phase_timings() const
+        {
+            return m_startup_phase_timings;
+        }
+
+        /** Returns the task scheduler Anvil runs CPU-parallel work for this device on.
+         *
+         *  This is the scheduler specified with DeviceCreateInfo::set_task_scheduler() or, if none was specified,
+         *  a WorkStealingTaskScheduler owned by the device, created on first use.
+         **/
+        Anvil::TaskScheduler* get_task_scheduler() const;
+
+        /** Samples a device timestamp together with a timestamp of the host clock Anvil::Time is built upon.
+         *  The result can be passed to Time::convert_device_time_to_nsec() to move device timestamps, eg. those
+         *  reported by GPUProfiler, onto a Time instance's timeline.
+         *
+         *  Requires VK_EXT_calibrated_timestamps. The device must support sampling both TimeDomainEXT::DEVICE_EXT
+         *  and TimeDomainEXT::CLOCK_MONOTONIC_EXT (TimeDomainEXT::QUERY_PERFORMANCE_COUNTER_EXT under Windows).
+         *
+         *  @param out_calibration_ptr Deref will be set to the calibration. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool get_timestamp_calibration(Anvil::TimestampCalibration* out_calibration_ptr) const;
+
         /** Returns a Queue instance, corresponding to a sparse binding-capable queue at index @param in_n_queue,
          *  which supports queue family capabilities specified with @param opt_required_queue_flags.
          *
@@ -591,7 +992,9 @@ namespace Anvil
          *
          *                                           (Other) (Windows) must be either Anvil::ExternalMemoryHandleTypeFlagBits::OPAQUE_WIN32_BIT or
          *                                                             Anvil::ExternalMemoryHandleTypeFlagBits::WIN32_KMT_BIT.
-         *                                                   (Linux)   must be Anvil::ExternalMemoryHandleTypeFlagBits::OPAQUE_FD_BIT.
+         *                                                   (Linux)   must be Anvil::ExternalMemoryHandleTypeFlagBits::DMA_BUF_BIT_EXT. Requires
+         *                                                             VK_EXT_external_memory_dma_buf. Opaque FDs cannot be queried, as
+         *                                                             they can only be imported with the memory type they were exported from.
          *
          * @param out_supported_memory_type_bits_ptr Deref will be set to a set of bits where each index corresponds to support status
          *                                           of a memory type with corresponding index. Must not be null.
@@ -600,6 +1003,24 @@ namespace Anvil
                                                             ExternalHandleType                             in_handle,
                                                             uint32_t*                                      out_supported_memory_type_bits) const;
 
+        /* Tells which memory types can be used to import host pointer @param in_host_ptr.
+         *
+         * Unlike get_memory_types_supported_for_external_handle(), which can only carry handle-sized values,
+         * this function takes the pointer as is.
+         *
+         * Requires VK_EXT_external_memory_host.
+         *
+         * @param in_external_handle_type            Must be Anvil::ExternalMemoryHandleTypeFlagBits::HOST_ALLOCATION_BIT_EXT or
+         *                                           Anvil::ExternalMemoryHandleTypeFlagBits::HOST_MAPPED_FOREIGN_MEMORY_BIT_EXT.
+         * @param in_host_ptr                        Host pointer to use for the query. Must not be null.
+         * @param out_supported_memory_type_bits_ptr As per get_memory_types_supported_for_external_handle().
+         *
+         * @return true if successful, false otherwise.
+         */
+        bool get_memory_types_supported_for_host_pointer(const Anvil::ExternalMemoryHandleTypeFlagBits& in_external_handle_type,
+                                                         const void*                                    in_host_ptr,
+                                                         uint32_t*                                      out_supported_memory_type_bits_ptr) const;
+
         /** Returns a Queue instance, corresponding to a transfer queue at index @param in_n_queue
          *
          *  @param in_n_queue Index of the transfer queue to retrieve the wrapper instance for.
@@ -641,6 +1062,16 @@ namespace Anvil
 
         bool is_compute_queue_family_index(const uint32_t& in_queue_family_index) const;
 
+        /** Returns device-level core Vulkan entry-points, retrieved for this device with vkGetDeviceProcAddr().
+         *
+         *  Calls issued through the returned table are dispatched directly to the driver which owns the device,
+         *  bypassing the loader trampoline.
+         **/
+        const Anvil::DeviceDispatchTable& get_dispatch_table() const
+        {
+            return m_dispatch_table;
+        }
+
         const Anvil::IExtensionInfoDevice<bool>* get_extension_info() const
         {
             return m_extension_enabled_info_ptr->get_device_extension_info();
@@ -663,6 +1094,41 @@ namespace Anvil
 
         bool is_universal_queue_family_index(const uint32_t& in_queue_family_index) const;
 
+        /** Resets all command pools returned by get_thread_command_pool_for_queue_family_index() so far, in one go.
+         *
+         *  Meant to be called once per frame, after all command buffers allocated from thread command pools
+         *  have finished executing. No thread may be recording or allocating command buffers from thread command
+         *  pools while this function executes.
+         *
+         *  Each pool's CommandPool::on_frame_end() is called after the reset, which trims pools whose recent usage
+         *  has dropped well below their past peak. Please see set_thread_command_pool_trim_policy().
+         *
+         *  @param in_release_resources As per CommandPool::reset().
+         *
+         *  @return true if all pools have been reset successfully, false otherwise.
+         **/
+        bool reset_thread_command_pools(bool in_release_resources) const;
+
+        /** Steps background work registered with get_background_work_scheduler() until @param in_budget_usec
+         *  microseconds pass. Meant to be called once per frame with the time the frame can spare.
+         *
+         *  Please see BackgroundWorkScheduler::run() for more details.
+         *
+         *  @param in_budget_usec     Time budget, in microseconds.
+         *  @param out_opt_report_ptr If not null, deref will be filled with information about the work done and
+         *                            the deferred work backlog.
+         **/
+        void run_background_work(const uint64_t&              in_budget_usec,
+                                 Anvil::BackgroundWorkReport* out_opt_report_ptr = nullptr) const;
+
+        /** Configures the trim policy of all command pools returned by get_thread_command_pool_for_queue_family_index(),
+         *  including pools created after the call. Please see CommandPool::set_trim_policy() for more details.
+         *
+         *  Must not be called while reset_thread_command_pools() executes.
+         **/
+        void set_thread_command_pool_trim_policy(uint32_t in_n_window_frames,
+                                                 float    in_usage_ratio) const;
+
         bool wait_idle() const;
 
     protected:
@@ -728,6 +1194,7 @@ namespace Anvil
         virtual bool is_physical_device_extension_supported(const std::string&              in_extension_name)      const = 0;
 
         /* Protected variables */
+        const VkAllocationCallbacks*     m_allocation_callbacks_vk_ptr;
         Anvil::DeviceCreateInfoUniquePtr m_create_info_ptr;
 
         std::vector<Anvil::Queue*> m_compute_queues;
@@ -742,28 +1209,45 @@ namespace Anvil
         std::map<Anvil::QueueFamilyType, std::vector<uint32_t> >                        m_queue_family_type_to_queue_family_indices;
         std::map<uint32_t /* Vulkan queue family index */, std::vector<Anvil::Queue*> > m_queue_ptrs_per_vk_queue_fam;
 
+        std::vector<Anvil::QueueGlobalPriority> m_queue_family_global_priorities; /* Granted at creation time, indexed with Vulkan queue family index */
+
         /* Protected variables */
-        VkDevice m_device;
+        VkDevice                   m_device;
+        Anvil::DeviceDispatchTable m_dispatch_table;
 
         ExtensionAMDBufferMarkerEntrypoints               m_amd_buffer_marker_extension_entrypoints;
         ExtensionAMDDrawIndirectCountEntrypoints          m_amd_draw_indirect_count_extension_entrypoints;
         ExtensionAMDShaderInfoEntrypoints                 m_amd_shader_info_extension_entrypoints;
+        ExtensionEXTCalibratedTimestampsEntrypoints       m_ext_calibrated_timestamps_extension_entrypoints;
+        ExtensionEXTConditionalRenderingEntrypoints       m_ext_conditional_rendering_extension_entrypoints;
         ExtensionEXTDebugMarkerEntrypoints                m_ext_debug_marker_extension_entrypoints;
         ExtensionEXTExternalMemoryHostEntrypoints         m_ext_external_memory_host_extension_entrypoints;
         ExtensionEXTHdrMetadataEntrypoints                m_ext_hdr_metadata_extension_entrypoints;
+        ExtensionEXTHostImageCopyEntrypoints              m_ext_host_image_copy_extension_entrypoints;
+        ExtensionEXTHostQueryResetEntrypoints             m_ext_host_query_reset_extension_entrypoints;
+        ExtensionEXTPageableDeviceLocalMemoryEntrypoints  m_ext_pageable_device_local_memory_extension_entrypoints;
         ExtensionEXTSampleLocationsEntrypoints            m_ext_sample_locations_extension_entrypoints;
         ExtensionEXTTransformFeedbackEntrypoints          m_ext_transform_feedback_extension_entrypoints;
+        ExtensionGOOGLEDisplayTimingEntrypoints           m_google_display_timing_extension_entrypoints;
+        ExtensionKHRAccelerationStructureEntrypoints      m_khr_acceleration_structure_extension_entrypoints;
         ExtensionKHRBindMemory2Entrypoints                m_khr_bind_memory2_extension_entrypoints;
+        ExtensionKHRBufferDeviceAddressEntrypoints        m_khr_buffer_device_address_extension_entrypoints;
         ExtensionKHRCreateRenderpass2Entrypoints          m_khr_create_renderpass2_extension_entrypoints;
         ExtensionKHRDescriptorUpdateTemplateEntrypoints   m_khr_descriptor_update_template_extension_entrypoints;
         ExtensionKHRDeviceGroupEntrypoints                m_khr_device_group_extension_entrypoints;
         ExtensionKHRDrawIndirectCountEntrypoints          m_khr_draw_indirect_count_extension_entrypoints;
+        ExtensionKHRDynamicRenderingEntrypoints           m_khr_dynamic_rendering_extension_entrypoints;
         ExtensionKHRGetMemoryRequirements2Entrypoints     m_khr_get_memory_requirements2_extension_entrypoints;
         ExtensionKHRMaintenance1Entrypoints               m_khr_maintenance1_extension_entrypoints;
         ExtensionKHRMaintenance3Entrypoints               m_khr_maintenance3_extension_entrypoints;
+        ExtensionKHRPipelineExecutablePropertiesEntrypoints m_khr_pipeline_executable_properties_extension_entrypoints;
+        ExtensionKHRPushDescriptorEntrypoints             m_khr_push_descriptor_extension_entrypoints;
         ExtensionKHRSamplerYCbCrConversionEntrypoints     m_khr_sampler_ycbcr_conversion_extension_entrypoints;
         ExtensionKHRSurfaceEntrypoints                    m_khr_surface_extension_entrypoints;
         ExtensionKHRSwapchainEntrypoints                  m_khr_swapchain_extension_entrypoints;
+        ExtensionKHRTimelineSemaphoreEntrypoints          m_khr_timeline_semaphore_extension_entrypoints;
+        ExtensionNVMeshShaderEntrypoints                  m_nv_mesh_shader_extension_entrypoints;
+        ExtensionNVShadingRateImageEntrypoints            m_nv_shading_rate_image_extension_entrypoints;
 
         #if defined(_WIN32)
             ExtensionKHRExternalFenceWin32Entrypoints     m_khr_external_fence_win32_extension_entrypoints;
@@ -775,26 +1259,69 @@ namespace Anvil
             ExtensionKHRExternalSemaphoreFdEntrypoints    m_khr_external_semaphore_fd_extension_entrypoints;
         #endif
 
+        /** Retrieves device-level extension entry-points, unless this has already been done.
+         *
+         *  Entry-points are retrieved at device creation time, unless the device has been created with deferred
+         *  entry-point resolution. Please see DeviceCreateInfo::set_extension_entrypoint_resolution_deferred() for
+         *  more details.
+         *
+         *  @return true if the entry-points have been retrieved successfully, false otherwise.
+         */
+        bool resolve_extension_func_ptrs() const;
+
     private:
         /* Private functions */
+        bool init_dispatch_table     ();
         bool init_dummy_dsg          () const;
         bool init_extension_func_ptrs();
 
         /* Private variables */
 
 
+        mutable Anvil::BackgroundWorkSchedulerUniquePtr  m_background_work_scheduler_ptr;
+        mutable std::mutex                               m_background_work_scheduler_mutex;
+        mutable Anvil::CompletionServiceUniquePtr        m_completion_service_ptr;
+        mutable std::mutex                               m_completion_service_mutex;
         std::unique_ptr<Anvil::ComputePipelineManager>   m_compute_pipeline_manager_ptr;
+        mutable Anvil::DeferredDeletionQueueUniquePtr    m_deferred_deletion_queue_ptr;
+        mutable std::mutex                               m_deferred_deletion_queue_mutex;
+        mutable Anvil::DescriptorPoolSizingProfileUniquePtr m_descriptor_pool_sizing_profile_ptr;
+        mutable std::mutex                                  m_descriptor_pool_sizing_profile_mutex;
         DescriptorSetLayoutManagerUniquePtr              m_descriptor_set_layout_manager_ptr;
         mutable Anvil::DescriptorSetGroupUniquePtr       m_dummy_dsg_ptr;
         mutable std::mutex                               m_dummy_dsg_mutex;
+        mutable std::unique_ptr<Anvil::EventPool>        m_event_pool_ptr;
         std::unique_ptr<Anvil::ExtensionInfo<bool> >     m_extension_enabled_info_ptr;
+        mutable std::once_flag                           m_extension_func_ptrs_once_flag;
+        mutable bool                                     m_extension_func_ptrs_resolved;
+        mutable std::unique_ptr<Anvil::FencePool>        m_fence_pool_ptr;
         GraphicsPipelineManagerUniquePtr                 m_graphics_pipeline_manager_ptr;
         PipelineCacheUniquePtr                           m_pipeline_cache_ptr;
         PipelineLayoutManagerUniquePtr                   m_pipeline_layout_manager_ptr;
+        mutable Anvil::FramebufferCacheUniquePtr         m_framebuffer_cache_ptr;
+        mutable std::mutex                               m_framebuffer_cache_mutex;
+        mutable Anvil::RenderPassCacheUniquePtr          m_render_pass_cache_ptr;
+        mutable std::mutex                               m_render_pass_cache_mutex;
+        mutable Anvil::SamplerCacheUniquePtr             m_sampler_cache_ptr;
+        mutable std::mutex                               m_sampler_cache_mutex;
+        mutable std::unique_ptr<Anvil::SemaphorePool>    m_semaphore_pool_ptr;
         Anvil::ShaderModuleCacheUniquePtr                m_shader_module_cache_ptr;
+        mutable Anvil::StagingRingUniquePtr              m_staging_ring_ptr;
+        mutable std::mutex                               m_staging_ring_mutex;
+        mutable std::mutex                               m_sync_object_pools_mutex;
+        std::vector<Anvil::StartupPhaseTiming>           m_startup_phase_timings;
+        std::vector<std::pair<std::string, std::string> > m_storage_feature_shader_definitions;
+        mutable Anvil::WorkStealingTaskSchedulerUniquePtr m_task_scheduler_ptr;
+        mutable std::mutex                               m_task_scheduler_mutex;
 
         std::vector<CommandPoolUniquePtr> m_command_pool_ptr_per_vk_queue_fam;
 
+        mutable std::map<std::thread::id, std::vector<CommandPoolUniquePtr> > m_thread_command_pools;
+        mutable std::mutex                                                    m_thread_command_pools_mutex;
+        const uint64_t                                                        m_thread_command_pools_registry_id;
+        mutable uint32_t                                                      m_thread_command_pools_trim_n_window_frames;
+        mutable float                                                         m_thread_command_pools_trim_usage_ratio;
+
         friend struct DeviceDeleter;
     };
 
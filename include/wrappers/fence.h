@@ -118,6 +118,24 @@ namespace Anvil
          **/
         bool is_set() const;
 
+        /** Tells which of the specified fences are signalled at the time of the call. Does not block.
+         *
+         *  If none of the fences are signalled, the function only issues a single Vulkan call, so it is cheaper
+         *  than calling is_set() for each fence in reclamation loops which usually find nothing to reclaim.
+         *
+         *  @param in_n_fences                Number of fences under @param in_fence_ptrs.
+         *  @param in_fence_ptrs              Fences to check. All fences must have been created for the same device.
+         *                                    Must not be null unless @param in_n_fences is 0.
+         *  @param out_signalled_indices_ptr  Array of at least @param in_n_fences items. The first <return value> items
+         *                                    will be set to indices of signalled fences, in ascending order. Must not be
+         *                                    null unless @param in_n_fences is 0.
+         *
+         *  @return Number of signalled fences.
+         **/
+        static uint32_t poll_fences(uint32_t      in_n_fences,
+                                    Fence* const* in_fence_ptrs,
+                                    uint32_t*     out_signalled_indices_ptr);
+
         /** Resets the specified Vulkan Fence, if set. If the fence is not set, this function is a nop.
          *
          *  @return true if the function executed successfully, false otherwise.
@@ -138,6 +156,42 @@ namespace Anvil
         static bool reset_fences(const uint32_t in_n_fences,
                                  Fence*         in_fences);
 
+        /** Resets the specified number of Vulkan fences with a single vkResetFences() call.
+         *
+         *  @param in_n_fences   Number of Fence instances accessible under @param in_fence_ptrs.
+         *  @param in_fence_ptrs An array of @param in_n_fences Fence instances to reset. All fences must have
+         *                       been created for the same device. Must not be nullptr, unless @param in_n_fences
+         *                       is 0.
+         *
+         *  @return true if the function executed successfully, false otherwise.
+         **/
+        static bool reset_fences(const uint32_t in_n_fences,
+                                 Fence* const*  in_fence_ptrs);
+
+        /** Blocks until all (or any, if @param in_wait_all is false) of the specified fences become signalled.
+         *
+         *  This function is expected to be more efficient than calling vkWaitForFences() for each fence. Does not
+         *  allocate memory, unless more than N_MAX_STACK_FENCES fences are specified.
+         *
+         *  @param in_n_fences        Number of fences under @param in_fence_ptrs.
+         *  @param in_fence_ptrs      Fences to wait on. All fences must have been created for the same device.
+         *                            Must not be null unless @param in_n_fences is 0.
+         *  @param in_wait_all        True to wait until all fences are signalled, false to wait for any.
+         *  @param in_timeout         Timeout, expressed in nanoseconds.
+         *  @param out_opt_result_ptr If not null, deref will be set to the result of the vkWaitForFences() call, so
+         *                            that callers can tell a timeout apart from a failure (eg. device loss).
+         *
+         *  @return true if the wait condition was satisfied within the specified timeout, false otherwise.
+         **/
+        static bool wait_fences(uint32_t      in_n_fences,
+                                Fence* const* in_fence_ptrs,
+                                bool          in_wait_all        = true,
+                                uint64_t      in_timeout         = UINT64_MAX,
+                                VkResult*     out_opt_result_ptr = nullptr);
+
+        /* Number of fences wait_fences() can gather in stack storage */
+        static const uint32_t N_MAX_STACK_FENCES = 64;
+
     private:
         /* Private functions */
 
@@ -28,6 +28,10 @@
  * - baking of the graphics pipeline object
  * - pipeline properties are assigned default values, as described below. They can be
  *   adjusted by calling relevant entrypoints, prior to baking.
+ * - optional automatic selection of base pipelines. Permutations which share shaders, layout
+ *   and subpass are created as derivatives of the first such permutation. See
+ *   set_automatic_derivatives_enabled() for details.
+ * - optional deduplication of pipelines. See set_pipeline_deduplication_enabled() for details.
  *
  **/
 #ifndef WRAPPERS_GRAPHICS_PIPELINE_MANAGER_H
@@ -39,6 +43,7 @@
 #include "misc/types.h"
 #include "wrappers/render_pass.h"
 #include <map>
+#include <unordered_map>
 
 namespace Anvil
 {
@@ -49,12 +54,23 @@ namespace Anvil
 
         /* Public functions */
 
-        /** Generates a VkPipeline instance for each outstanding pipeline object.
+        /** Adds a new pipeline to the manager. Please see BasePipelineManager::add_pipeline() for more details.
          *
-         *  @return true if successful, false otherwise.
+         *  If pipeline deduplication is enabled, and the manager already holds a pipeline whose create info
+         *  compares equal to @param in_pipeline_create_info_ptr, no new pipeline is created. The ID of the
+         *  existing pipeline is returned instead, and its reference counter is incremented.
          **/
-        bool bake();
+        bool add_pipeline(Anvil::BasePipelineCreateInfoUniquePtr in_pipeline_create_info_ptr,
+                          PipelineID*                            out_pipeline_id_ptr,
+                          PipelineID                             in_opt_fallback_pipeline_id = UINT32_MAX);
 
+        /** Deletes an existing pipeline. For pipelines which have been returned by more than one add_pipeline()
+         *  call, only the reference counter is decremented, until the last reference is released.
+         *
+         *  @param in_pipeline_id ID of a pipeline to delete.
+         *
+         *  @return true if successful, false otherwise.
+         **/
         bool delete_pipeline(PipelineID in_pipeline_id);
 
         /** Creates a new GraphicsPipelineManager instance.
@@ -77,6 +93,63 @@ namespace Anvil
         /** Destructor. */
         virtual ~GraphicsPipelineManager();
 
+        /** Tells whether pipeline deduplication is enabled. */
+        bool is_pipeline_deduplication_enabled() const
+        {
+            return m_pipeline_deduplication_enabled;
+        }
+
+        /** Tells whether base pipelines are selected automatically at baking time. */
+        bool is_automatic_derivatives_enabled() const
+        {
+            return m_automatic_derivatives_enabled;
+        }
+
+        /** Enables or disables automatic base pipeline selection. Disabled by default.
+         *
+         *  When enabled, pipelines which have not been assigned a base pipeline by the app are grouped by
+         *  pipeline layout, renderpass, subpass and the shader stage entry-points they use. The first pipeline
+         *  baked for each group is created with the ALLOW_DERIVATIVES flag, and all permutations which are baked
+         *  later on are created as its derivatives. This lets the driver share compilation work across material
+         *  permutations which only differ in fixed-function state or specialization constants.
+         *
+         *  Base pipelines requested explicitly with the create info structure are always respected.
+         *
+         *  NOTE: Pipelines which derive from a pipeline baked in the same bake() call must be created in a single
+         *        vkCreateGraphicsPipelines() call, so such batches are not distributed across threads.
+         */
+        void set_automatic_derivatives_enabled(bool in_enabled)
+        {
+            m_automatic_derivatives_enabled = in_enabled;
+        }
+
+        /** Enables or disables pipeline deduplication. Disabled by default.
+         *
+         *  When enabled, add_pipeline() hashes each new non-proxy create info, and returns the ID of an existing
+         *  pipeline if one with an identical create info has been added earlier on, also with deduplication enabled.
+         *  This lets subsystems which request structurally identical pipelines share a single VkPipeline.
+         *
+         *  Create infos are compared by shader modules and entry-points, specialization constants, descriptor set
+         *  create info items, push constant ranges, all fixed-function state, the renderpass instance and the subpass.
+         *  Pipeline names are ignored.
+         *
+         *  Deduplicated pipelines are reference-counted. Each add_pipeline() call must be matched by a delete_pipeline()
+         *  call.
+         */
+        void set_pipeline_deduplication_enabled(bool in_enabled)
+        {
+            m_pipeline_deduplication_enabled = in_enabled;
+        }
+
+    protected:
+        /* Protected functions */
+
+        /** Generates a VkPipeline instance for each pipeline object held by @param inout_pipelines_ptr.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool bake_pipelines(Pipelines* inout_pipelines_ptr);
+
     private:
         /* Private type declarations */
         typedef std::map<uint32_t, uint32_t> AttributeLocationToBindingIndexMap;
@@ -130,47 +203,90 @@ namespace Anvil
 
         typedef std::map<PipelineID, std::unique_ptr<GraphicsPipelineData> > GraphicsPipelineDataMap;
 
+        typedef struct DeduplicatedPipeline
+        {
+            uint64_t hash;
+            uint32_t n_references;
+
+            DeduplicatedPipeline()
+                :hash        (0),
+                 n_references(0)
+            {
+                /* Stub */
+            }
+
+            DeduplicatedPipeline(uint64_t in_hash)
+                :hash        (in_hash),
+                 n_references(1)
+            {
+                /* Stub */
+            }
+        } DeduplicatedPipeline;
+
         /* Private functions */
         explicit GraphicsPipelineManager(const Anvil::BaseDevice* in_device_ptr,
                                          bool                     in_mt_safe,
                                          bool                     in_use_pipeline_cache,
                                          Anvil::PipelineCache*    in_pipeline_cache_to_reuse_ptr);
 
-        Anvil::StructChainUniquePtr<VkGraphicsPipelineCreateInfo>                   bake_graphics_pipeline_create_info                 (const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr,
-                                                                                                                                        const Anvil::PipelineLayout*                  in_pipeline_layout_ptr,
-                                                                                                                                        const VkPipeline&                             in_opt_base_pipeline_handle,
-                                                                                                                                        const int32_t&                                in_opt_base_pipeline_index,
-                                                                                                                                        const VkPipelineColorBlendStateCreateInfo*    in_opt_color_blend_state_create_info_ptr,
-                                                                                                                                        const VkPipelineDepthStencilStateCreateInfo*  in_opt_depth_stencil_state_create_info_ptr,
-                                                                                                                                        const VkPipelineDynamicStateCreateInfo*       in_opt_dynamic_state_create_info_ptr,
-                                                                                                                                        const VkPipelineInputAssemblyStateCreateInfo* in_input_assembly_state_create_info_ptr,
-                                                                                                                                        const VkPipelineMultisampleStateCreateInfo*   in_opt_multisample_state_create_info_ptr,
-                                                                                                                                        const VkPipelineRasterizationStateCreateInfo* in_rasterization_state_create_info_ptr,
-                                                                                                                                        const uint32_t&                               in_n_shader_stage_create_info_items,
-                                                                                                                                        const VkPipelineShaderStageCreateInfo*        in_shader_stage_create_info_items_ptr,
-                                                                                                                                        const VkPipelineTessellationStateCreateInfo*  in_opt_tessellation_state_create_info_ptr,
-                                                                                                                                        const VkPipelineVertexInputStateCreateInfo*   in_vertex_input_state_create_info_ptr,
-                                                                                                                                        const VkPipelineViewportStateCreateInfo*      in_opt_viewport_state_create_info_ptr) const;
-        Anvil::StructChainUniquePtr<VkPipelineColorBlendStateCreateInfo>            bake_pipeline_color_blend_state_create_info        (const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr,
-                                                                                                                                        const Anvil::RenderPass*                      in_current_renderpass_ptr,
-                                                                                                                                        const Anvil::SubPassID&                       in_subpass_id)                         const;
-        Anvil::StructChainUniquePtr<VkPipelineDepthStencilStateCreateInfo>          bake_pipeline_depth_stencil_state_create_info      (const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr,
-                                                                                                                                        const Anvil::RenderPass*                      in_current_renderpass_ptr)             const;
-        Anvil::StructChainUniquePtr<VkPipelineDynamicStateCreateInfo>               bake_pipeline_dynamic_state_create_info            (const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr)       const;
-        Anvil::StructChainUniquePtr<VkPipelineInputAssemblyStateCreateInfo>         bake_pipeline_input_assembly_state_create_info     (const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr)       const;
-        Anvil::StructChainUniquePtr<VkPipelineMultisampleStateCreateInfo>           bake_pipeline_multisample_state_create_info        (const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr)       const;
-        Anvil::StructChainUniquePtr<VkPipelineRasterizationStateCreateInfo>         bake_pipeline_rasterization_state_create_info      (const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr)       const;
-        std::unique_ptr<Anvil::StructChainVector<VkPipelineShaderStageCreateInfo> > bake_pipeline_shader_stage_create_info_chain_vector(const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr)       const;
-        Anvil::StructChainUniquePtr<VkPipelineTessellationStateCreateInfo>          bake_pipeline_tessellation_state_create_info       (const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr)       const;
-        Anvil::StructChainUniquePtr<VkPipelineVertexInputStateCreateInfo>           bake_pipeline_vertex_input_state_create_info       (const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr)       const;
-        Anvil::StructChainUniquePtr<VkPipelineViewportStateCreateInfo>              bake_pipeline_viewport_state_create_info           (Anvil::GraphicsPipelineCreateInfo*            in_gfx_pipeline_create_info_ptr,
-                                                                                                                                        const bool&                                   in_is_dynamic_scissor_state_enabled,
-                                                                                                                                        const bool&                                   in_is_dynamic_viewport_state_enabled)  const;
+        void get_derivative_key(const Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr,
+                                const Anvil::PipelineLayout*             in_pipeline_layout_ptr,
+                                std::vector<uint64_t>*                   out_key_ptr) const;
+
+        /* The functions below form Vulkan descriptors in memory allocated from @param in_arena_ptr. The descriptors,
+         * as well as any arrays they refer to, stay valid until the arena is released. */
+        VkGraphicsPipelineCreateInfo*                 bake_graphics_pipeline_create_info            (Anvil::CommandArena*                          in_arena_ptr,
+                                                                                                     const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr,
+                                                                                                     const Anvil::PipelineLayout*                  in_pipeline_layout_ptr,
+                                                                                                     const VkPipeline&                             in_opt_base_pipeline_handle,
+                                                                                                     const int32_t&                                in_opt_base_pipeline_index,
+                                                                                                     const VkPipelineColorBlendStateCreateInfo*    in_opt_color_blend_state_create_info_ptr,
+                                                                                                     const VkPipelineDepthStencilStateCreateInfo*  in_opt_depth_stencil_state_create_info_ptr,
+                                                                                                     const VkPipelineDynamicStateCreateInfo*       in_opt_dynamic_state_create_info_ptr,
+                                                                                                     const VkPipelineInputAssemblyStateCreateInfo* in_input_assembly_state_create_info_ptr,
+                                                                                                     const VkPipelineMultisampleStateCreateInfo*   in_opt_multisample_state_create_info_ptr,
+                                                                                                     const VkPipelineRasterizationStateCreateInfo* in_rasterization_state_create_info_ptr,
+                                                                                                     const uint32_t&                               in_n_shader_stage_create_info_items,
+                                                                                                     const VkPipelineShaderStageCreateInfo*        in_shader_stage_create_info_items_ptr,
+                                                                                                     const VkPipelineTessellationStateCreateInfo*  in_opt_tessellation_state_create_info_ptr,
+                                                                                                     const VkPipelineVertexInputStateCreateInfo*   in_vertex_input_state_create_info_ptr,
+                                                                                                     const VkPipelineViewportStateCreateInfo*      in_opt_viewport_state_create_info_ptr) const;
+        const VkPipelineColorBlendStateCreateInfo*    bake_pipeline_color_blend_state_create_info   (Anvil::CommandArena*                          in_arena_ptr,
+                                                                                                     const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr,
+                                                                                                     const Anvil::RenderPass*                      in_current_renderpass_ptr,
+                                                                                                     const Anvil::SubPassID&                       in_subpass_id)                         const;
+        const VkPipelineDepthStencilStateCreateInfo*  bake_pipeline_depth_stencil_state_create_info (Anvil::CommandArena*                          in_arena_ptr,
+                                                                                                     const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr,
+                                                                                                     const Anvil::RenderPass*                      in_current_renderpass_ptr)             const;
+        const VkPipelineDynamicStateCreateInfo*       bake_pipeline_dynamic_state_create_info       (Anvil::CommandArena*                          in_arena_ptr,
+                                                                                                     const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr)       const;
+        const VkPipelineInputAssemblyStateCreateInfo* bake_pipeline_input_assembly_state_create_info(Anvil::CommandArena*                          in_arena_ptr,
+                                                                                                     const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr)       const;
+        const VkPipelineMultisampleStateCreateInfo*   bake_pipeline_multisample_state_create_info   (Anvil::CommandArena*                          in_arena_ptr,
+                                                                                                     const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr)       const;
+        const VkPipelineRasterizationStateCreateInfo* bake_pipeline_rasterization_state_create_info (Anvil::CommandArena*                          in_arena_ptr,
+                                                                                                     const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr)       const;
+        const VkPipelineShaderStageCreateInfo*        bake_pipeline_shader_stage_create_info_items  (Anvil::CommandArena*                          in_arena_ptr,
+                                                                                                     const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr,
+                                                                                                     uint32_t*                                     out_n_items_ptr)                       const;
+        const VkPipelineTessellationStateCreateInfo*  bake_pipeline_tessellation_state_create_info  (Anvil::CommandArena*                          in_arena_ptr,
+                                                                                                     const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr)       const;
+        const VkPipelineVertexInputStateCreateInfo*   bake_pipeline_vertex_input_state_create_info  (Anvil::CommandArena*                          in_arena_ptr,
+                                                                                                     const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr)       const;
+        const VkPipelineViewportStateCreateInfo*      bake_pipeline_viewport_state_create_info      (Anvil::CommandArena*                          in_arena_ptr,
+                                                                                                     Anvil::GraphicsPipelineCreateInfo*            in_gfx_pipeline_create_info_ptr,
+                                                                                                     const bool&                                   in_is_dynamic_scissor_state_enabled,
+                                                                                                     const bool&                                   in_is_dynamic_viewport_state_enabled)  const;
 
         ANVIL_DISABLE_ASSIGNMENT_OPERATOR(GraphicsPipelineManager);
         ANVIL_DISABLE_COPY_CONSTRUCTOR   (GraphicsPipelineManager);
 
         /* Private variables */
+        bool                                                   m_automatic_derivatives_enabled;
+        std::map<PipelineID, DeduplicatedPipeline>             m_deduplicated_pipelines;
+        std::unordered_map<uint64_t, std::vector<PipelineID> > m_deduplicated_pipeline_ids_by_hash;
+        std::map<std::vector<uint64_t>, PipelineID>            m_derivative_base_pipeline_ids;
+        bool                                                   m_pipeline_deduplication_enabled;
     };
 }; /* Vulkan namespace */
 
@@ -34,6 +34,7 @@
 #include "misc/mt_safety.h"
 #include "misc/types.h"
 #include "misc/page_tracker.h"
+#include "misc/struct_chainer.h"
 #include <unordered_map>
 
 
@@ -111,6 +112,56 @@ namespace Anvil
                                  const uint32_t                      in_opt_n_set_semaphores         = 0,
                                  Anvil::Semaphore* const*            in_opt_set_semaphore_ptrs       = nullptr);
 
+        /** Disables per-subresource state tracking and releases the tracked states. */
+        void disable_state_tracking();
+
+        /** Enables per-subresource layout and access tracking for the image.
+         *
+         *  Once enabled, command buffers update the tracked state of each mip of each layer whenever they record
+         *  a command which refers to the image directly: pipeline barriers, event waits, copies, blits, clears,
+         *  resolves and renderpasses using the image as an attachment (which leave the attachment in its final
+         *  layout). Accesses made via descriptor sets are NOT tracked and need to be expressed with
+         *  CommandBufferBase::record_transition(), which also uses the tracked state to emit minimal barriers.
+         *
+         *  The state is updated at recording time, so it only reflects the GPU-side state if command buffers are
+         *  submitted in the order they have been recorded in. Global memory barriers are not taken into account.
+         *
+         *  State tracking must be enabled before any other commands accessing the image are recorded.
+         *
+         *  @param in_current_layout    Layout all subresources of the image are in at the time of the call.
+         *  @param in_last_stage_mask   Stages the image has last been accessed at, or NONE if the image has not been
+         *                              accessed yet.
+         *  @param in_last_access_mask  Access types the image has last been accessed with.
+         **/
+        void enable_state_tracking(Anvil::ImageLayout        in_current_layout,
+                                   Anvil::PipelineStageFlags in_last_stage_mask  = Anvil::PipelineStageFlagBits::NONE,
+                                   Anvil::AccessFlags        in_last_access_mask = Anvil::AccessFlagBits::NONE);
+
+        /** Records commands which fill all mips but the base one with downsampled contents of the preceding mip, so that
+         *  only the base mip needs to be uploaded by the app. Each mip is produced by a blit op, followed by a barrier which
+         *  makes the result available to the next blit.
+         *
+         *  All layers of the image are processed. Contents of mips other than the base one are discarded.
+         *
+         *  Requires an optimally-tiled, non-multiplanar image, created with TRANSFER_SRC and TRANSFER_DST usage flags, whose
+         *  format supports BLIT_SRC and BLIT_DST features for optimal tiling. If @param in_filter is LINEAR but the format does
+         *  not support linear filtering, or the format has a depth or stencil aspect, NEAREST filtering is used instead.
+         *
+         *  @param in_cmd_buffer_ptr       Command buffer to record the commands to. Must be in recording state. Must not be NULL.
+         *  @param in_filter               Filter to use for the blit ops.
+         *  @param in_src_access_mask      Access mask the base mip has last been written with.
+         *  @param in_current_image_layout Layout all mips of the image are in at the time the commands execute.
+         *  @param in_dst_access_mask      Access mask the image is going to be used with, once the commands execute.
+         *  @param in_new_image_layout     Layout to transition all mips of the image to. Must not be UNDEFINED or PREINITIALIZED.
+         *
+         *  @return true if the commands have been recorded successfully, false otherwise.
+         **/
+        bool generate_mipmaps(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                              Anvil::Filter             in_filter,
+                              Anvil::AccessFlags        in_src_access_mask,
+                              Anvil::ImageLayout        in_current_image_layout,
+                              Anvil::AccessFlags        in_dst_access_mask,
+                              Anvil::ImageLayout        in_new_image_layout);
 
         /** Destructor */
         virtual ~Image();
@@ -194,6 +245,23 @@ namespace Anvil
                                    uint32_t* out_opt_height_ptr,
                                    uint32_t* out_opt_depth_ptr) const;
 
+        /** Returns an image view created for this image with properties matching @param in_create_info_ptr.
+         *
+         *  Views are cached per image and keyed by their create info (view type, format, subresource range,
+         *  swizzle, etc.), so repeated requests for the same view return the same instance instead of creating
+         *  a new Vulkan object. Cached views are released when the image is destroyed.
+         *
+         *  Do NOT release the returned view. It is owned by the image.
+         *
+         *  @param in_create_info_ptr View create info. Must not be null. Parent image must be this image.
+         *
+         *  @return Image view if successful, null otherwise.
+         **/
+        Anvil::ImageView* get_cached_view(Anvil::ImageViewCreateInfoUniquePtr in_create_info_ptr);
+
+        /** Returns the number of views held by the view cache. */
+        uint32_t get_n_cached_views() const;
+
         /** Returns information about the amount of memory the underlying VkImage instance requires
          *  to work correctly.
          **/
@@ -247,6 +315,18 @@ namespace Anvil
         /** Returns a filled subresource range descriptor, covering all layers & mipmaps of the image */
         Anvil::ImageSubresourceRange get_subresource_range() const;
 
+        /** Retrieves the tracked state of the specified subresource. Requires state tracking to be enabled.
+         *
+         *  @param in_n_layer    Index of the layer to use for the query.
+         *  @param in_n_mip      Index of the mip to use for the query.
+         *  @param out_state_ptr Deref will be set to the tracked state. Must not be null.
+         *
+         *  @return true if successful, false if state tracking is disabled or the subresource does not exist.
+         **/
+        bool get_tracked_state(uint32_t                    in_n_layer,
+                               uint32_t                    in_n_mip,
+                               Anvil::ResourceAccessState* out_state_ptr) const;
+
         /** Tells whether this image provides data for the specified image aspects.
          *
          *  @param in_aspects A bitfield of image aspect bits which should be used for the query.
@@ -276,6 +356,12 @@ namespace Anvil
                                        uint32_t                   in_y,
                                        uint32_t                   in_z) const;
 
+        /** Tells whether per-subresource state tracking is enabled for the image. */
+        bool is_state_tracking_enabled() const
+        {
+            return !m_tracked_states.empty();
+        }
+
         bool prefers_dedicated_allocation(const uint32_t& in_n_plane) const
         {
             return m_plane_index_to_memory_properties_map.at(in_n_plane).prefers_dedicated_allocation;
@@ -343,7 +429,25 @@ namespace Anvil
                         uint32_t             in_n_SFR_rects,
                         const VkRect2D*      in_SFRs_ptr);
 
-        /** Updates image with specified mip-map data. Blocks until the operation finishes executing.
+        /** See set_memory() for general documentation.
+         *
+         *  This static function binds memory to multiple non-sparse images with a single vkBindImageMemory2KHR() call.
+         *  Mipmap data specified at creation time is uploaded, and post-alloc layout transitions are carried out,
+         *  once all images have been bound.
+         *
+         *  All images must have been created for the same device.
+         *
+         *  @param in_n_image_memory_binding_updates Number of items available under @param in_updates_ptr. Must not be 0.
+         *  @param in_updates_ptr                    Binding updates to apply. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        static bool set_memory_multi(uint32_t                  in_n_image_memory_binding_updates,
+                                     ImageMemoryBindingUpdate* in_updates_ptr);
+
+        /** Updates image with specified mip-map data. Blocks until the operation finishes executing, unless
+         *  the parent device has been created with a staging ring which could accommodate the data. In the latter
+         *  case, the function returns as soon as the copy op has been submitted to the universal queue.
          *
          *  Handles both linear and optimal images.
          *
@@ -358,6 +462,46 @@ namespace Anvil
                             Anvil::ImageLayout                in_current_image_layout,
                             Anvil::ImageLayout*               out_new_image_layout_ptr);
 
+        /** Updates an optimally-tiled image with specified mip-map data on a transfer queue, without blocking the calling
+         *  thread or the consumer queue. Intended for texture streaming.
+         *
+         *  The data is staged in the device-wide staging ring. If the parent device has no staging ring, or the ring cannot
+         *  accommodate the data, a temporary staging buffer is used instead and the function blocks until the copy finishes.
+         *
+         *  Once the copy ops finish executing, the image is transitioned to @param in_new_image_layout and, if the image uses
+         *  exclusive sharing mode and the transfer queue belongs to a different family than @param in_dst_queue_ptr, its
+         *  ownership is released to the consumer queue's family. In the latter case, the consumer queue MUST execute the
+         *  matching acquire barrier (as returned via @param out_opt_acquire_barriers_ptr) before accessing the image, after
+         *  waiting on @param in_opt_semaphore_to_signal_ptr.
+         *
+         *  The image's current contents are discarded, unless it is in GENERAL or TRANSFER_DST_OPTIMAL layout. Exclusively-owned
+         *  images must not be owned by a queue family other than the transfer queue's one at the time of the call.
+         *
+         *  @param in_mipmaps_ptr                 A vector of MipmapRawData items, holding mipmap data. Must not be NULL. The data
+         *                                        is copied before the function returns.
+         *  @param in_current_image_layout        Image layout, that the image is in right now.
+         *  @param in_new_image_layout            Image layout to transition the image to after the upload. Must not be UNDEFINED
+         *                                        or PREINITIALIZED.
+         *  @param in_dst_queue_ptr               Queue which is going to consume the image. Must not be NULL.
+         *  @param in_dst_access_mask             Access mask the consumer is going to use the image with. Used for the acquire barrier.
+         *  @param in_opt_semaphore_to_signal_ptr If not NULL, the semaphore is signalled once the image is ready to be acquired.
+         *  @param out_opt_acquire_barriers_ptr   If not NULL and an ownership transfer takes place, the acquire barrier is appended
+         *                                        to the vector. Barriers for many images can be collected this way and recorded
+         *                                        on the consumer queue with a single pipeline barrier command.
+         *  @param in_opt_transfer_queue_ptr      Queue to perform the upload on. If NULL, the first transfer queue is used, or the
+         *                                        first universal queue, if the device exposes no transfer queues.
+         *
+         *  @return true if the upload has been submitted successfully, false otherwise.
+         **/
+        bool upload_mipmaps_async(const std::vector<MipmapRawData>* in_mipmaps_ptr,
+                                  Anvil::ImageLayout                in_current_image_layout,
+                                  Anvil::ImageLayout                in_new_image_layout,
+                                  Anvil::Queue*                     in_dst_queue_ptr,
+                                  Anvil::AccessFlags                in_dst_access_mask             = Anvil::AccessFlagBits::SHADER_READ_BIT,
+                                  Anvil::Semaphore*                 in_opt_semaphore_to_signal_ptr = nullptr,
+                                  std::vector<Anvil::ImageBarrier>* out_opt_acquire_barriers_ptr   = nullptr,
+                                  Anvil::Queue*                     in_opt_transfer_queue_ptr      = nullptr);
+
     private:
         /** Defines dimensions of a single image mip-map */
         typedef struct Mipmap
@@ -499,6 +643,13 @@ namespace Anvil
 
         Image(Anvil::ImageCreateInfoUniquePtr in_create_info_ptr);
 
+        void append_memory_bind_infos(Anvil::MemoryBlock*                                 in_memory_block_ptr,
+                                      uint32_t                                            in_n_device_group_indices,
+                                      const uint32_t*                                     in_device_group_indices_ptr,
+                                      uint32_t                                            in_n_SFR_rects,
+                                      const VkRect2D*                                     in_SFRs_ptr,
+                                      Anvil::StructChainVector<VkBindImageMemoryInfoKHR>* inout_bind_info_chains_ptr) const;
+
         bool do_sanity_checks_for_physical_device_binding(const Anvil::MemoryBlock* in_memory_block_ptr,
                                                           uint32_t                  in_n_physical_devices) const;
         bool do_sanity_checks_for_sfr_binding            (uint32_t                  in_n_SFR_rects,
@@ -522,6 +673,9 @@ namespace Anvil
                                            const uint32_t*        in_opt_device_indices);
 
 
+        void on_nonsparse_memory_bound(Anvil::MemoryBlock* in_memory_block_ptr,
+                                       bool                in_owned_by_image);
+
         void on_memory_backing_update       (const Anvil::ImageSubresource& in_subresource,
                                              VkOffset3D                     in_offset,
                                              VkExtent3D                     in_extent,
@@ -535,8 +689,29 @@ namespace Anvil
                                              VkDeviceSize                   in_memory_block_start_offset,
                                              bool                           in_memory_block_owned_by_image);
 
+        bool can_upload_mipmaps_from_host(Anvil::ImageLayout in_current_image_layout) const;
+
         void transition_to_post_alloc_image_layout(Anvil::AccessFlags in_src_access_mask,
                                                    Anvil::ImageLayout in_src_layout);
+        void update_tracked_state                 (const Anvil::ImageSubresourceRange& in_subresource_range,
+                                                   Anvil::ImageLayout                  in_new_layout,
+                                                   Anvil::PipelineStageFlags           in_stage_mask,
+                                                   Anvil::AccessFlags                  in_access_mask,
+                                                   bool                                in_is_barrier);
+        void upload_mipmaps_optimal               (const std::vector<MipmapRawData>*   in_mipmaps_ptr,
+                                                   const Anvil::ImageSubresourceRange& in_subresource_range,
+                                                   Anvil::ImageLayout                  in_current_image_layout,
+                                                   Anvil::Queue*                       in_queue_ptr,
+                                                   Anvil::ImageLayout                  in_final_image_layout,
+                                                   uint32_t                            in_dst_queue_family_index,
+                                                   Anvil::AccessFlags                  in_dst_access_mask,
+                                                   Anvil::Semaphore*                   in_opt_semaphore_to_signal_ptr,
+                                                   std::vector<Anvil::ImageBarrier>*   out_opt_acquire_barriers_ptr,
+                                                   Anvil::ImageLayout*                 out_new_image_layout_ptr);
+        void upload_mipmaps_host                  (const std::vector<MipmapRawData>*   in_mipmaps_ptr,
+                                                   const Anvil::ImageSubresourceRange& in_subresource_range,
+                                                   Anvil::ImageLayout                  in_current_image_layout,
+                                                   Anvil::ImageLayout*                 out_new_image_layout_ptr);
 
         /* Private members */
         typedef std::pair<uint32_t /* n_layer */, uint32_t /* n_mip */>              LayerMipKey;
@@ -550,6 +725,8 @@ namespace Anvil
          */
         AspectToLayerMipToSubresourceLayoutMap m_linear_image_aspect_data;
 
+        std::unordered_map<uint64_t, std::vector<Anvil::ImageViewUniquePtr> > m_cached_views;
+
         Anvil::ImageCreateInfoUniquePtr        m_create_info_ptr;
         bool                                   m_has_transitioned_to_post_alloc_layout;
         VkImage                                m_image;
@@ -600,6 +777,9 @@ namespace Anvil
         std::vector<VkRect2D> m_peer_sfr_rects;
         VkExtent2D            m_sfr_tile_size;
 
+        /* Indexed with (n_layer * m_n_mipmaps + n_mip). Empty if state tracking is disabled. */
+        std::vector<Anvil::ResourceAccessState> m_tracked_states;
+
         MemoryBlockUniquePtr              m_metadata_memory_block_ptr;
         std::vector<MemoryBlockUniquePtr> m_memory_blocks_owned;
 
@@ -607,6 +787,7 @@ namespace Anvil
         std::vector<std::unique_ptr<AspectPageOccupancyData> >                   m_sparse_aspect_page_occupancy_data_items_owned;
         std::map<Anvil::ImageAspectFlagBits, Anvil::SparseImageAspectProperties> m_sparse_aspect_props;
 
+        friend class Anvil::CommandBufferBase; /* update_tracked_state() */
         friend class Anvil::Queue;
 
         ANVIL_DISABLE_ASSIGNMENT_OPERATOR(Image);
@@ -49,6 +49,15 @@ namespace Anvil
         /** Creates a new Instance wrapper instance. **/
         static Anvil::InstanceUniquePtr create(Anvil::InstanceCreateInfoUniquePtr in_create_info_ptr);
 
+        /** Returns allocation callbacks to pass to Vulkan functions which create or destroy instance-level objects.
+         *
+         *  Null, unless a host allocator has been specified with InstanceCreateInfo::set_host_allocator().
+         */
+        const VkAllocationCallbacks* get_allocation_callbacks_vk() const
+        {
+            return m_allocation_callbacks_vk_ptr;
+        }
+
         const Anvil::APIVersion& get_api_version() const
         {
             return m_api_version;
@@ -109,6 +118,12 @@ namespace Anvil
             return m_create_info_ptr.get();
         }
 
+        /** Returns time spent in consecutive phases of instance initialization, in the order they were executed. */
+        const std::vector<Anvil::StartupPhaseTiming>& get_startup_phase_timings() const
+        {
+            return m_startup_phase_timings;
+        }
+
         /** Returns a raw wrapped VkInstance handle. */
         VkInstance get_instance_vk() const
         {
@@ -177,6 +192,12 @@ namespace Anvil
             return is_instance_extension_supported(in_extension_name.c_str() );
         }
 
+        /** Tells if at least one debug messenger is currently alive for this Vulkan Instance wrapper. */
+        bool has_active_debug_messenger() const
+        {
+            return (m_n_active_debug_messengers.load() > 0);
+        }
+
         /** Tells if validation support has been requested for this Vulkan Instance wrapper */
         bool is_validation_enabled() const
         {
@@ -231,6 +252,7 @@ namespace Anvil
             #endif
         #endif
 
+        const VkAllocationCallbacks*       m_allocation_callbacks_vk_ptr;
         Anvil::APIVersion                  m_api_version;
         Anvil::InstanceCreateInfoUniquePtr m_create_info_ptr;
 
@@ -239,10 +261,13 @@ namespace Anvil
 
         Anvil::DebugMessengerUniquePtr                       m_debug_messenger_ptr;
         Anvil::Layer                                         m_global_layer;
+        mutable std::atomic<uint32_t>                        m_n_active_debug_messengers;
         std::vector<Anvil::PhysicalDeviceGroup>              m_physical_device_groups;
         std::vector<std::unique_ptr<Anvil::PhysicalDevice> > m_physical_devices;
+        std::vector<Anvil::StartupPhaseTiming>               m_startup_phase_timings;
         std::vector<Anvil::Layer>                            m_supported_layers;
 
+        friend class  Anvil::DebugMessenger;
         friend struct InstanceDeleter;
     };
 }; /* namespace Anvil */
@@ -92,6 +92,14 @@ namespace Anvil
         /** Releases the Vulkan counterpart and unregisters the wrapper instance from the object tracker */
         virtual ~MemoryBlock();
 
+        /** Returns the number of bytes of the underlying memory allocation which have been committed by the
+         *  implementation so far, as reported by vkGetDeviceMemoryCommitment().
+         *
+         *  Only meaningful for memory blocks using a memory type with LAZILY_ALLOCATED_BIT property. Note that
+         *  for derived memory blocks, the returned value refers to the whole parent allocation.
+         */
+        VkDeviceSize get_committed_size() const;
+
         const Anvil::MemoryBlockCreateInfo* get_create_info_ptr() const
         {
             return m_create_info_ptr.get();
@@ -171,6 +179,19 @@ namespace Anvil
                   VkDeviceSize in_size,
                   void*        out_result_ptr);
 
+        /** Changes priority of the underlying memory allocation at run-time. Use it to demote streamed resources
+         *  which are no longer needed, or to promote render targets, so that the implementation keeps frame-critical
+         *  allocations resident under memory pressure.
+         *
+         *  Requires VK_EXT_pageable_device_local_memory. For derived memory blocks, the new priority applies to the
+         *  whole parent allocation, including other memory blocks derived from it.
+         *
+         *  @param in_priority New priority. Must be within range [0.0f, 1.0f].
+         *
+         *  @return true if successful, false if the extension is not enabled.
+         **/
+        bool set_priority(float in_priority);
+
         /** Unmaps the mapped storage from the process space.
          *
          *  The call should only be made after a map() call.
@@ -223,6 +244,8 @@ namespace Anvil
         void     close_gpu_memory_access     ();
         uint32_t get_device_memory_type_index(uint32_t                  in_memory_type_bits,
                                               Anvil::MemoryFeatureFlags in_memory_features);
+        void     on_memory_moved             (VkDeviceMemory            in_new_memory,
+                                              VkDeviceSize              in_new_start_offset);
         bool     open_gpu_memory_access      ();
 
         /* IMemoryBlockBackendSupport */
@@ -252,8 +275,9 @@ namespace Anvil
         }
 
         /* Private members */
-        std::atomic<uint32_t> m_gpu_data_map_count; /* Only set for root memory blocks */
-        void*                 m_gpu_data_ptr;       /* Only set for root memory blocks */
+        std::atomic<uint32_t> m_gpu_data_map_count;       /* Only set for root memory blocks */
+        void*                 m_gpu_data_ptr;             /* Only set for root memory blocks */
+        std::atomic<bool>     m_holds_persistent_mapping; /* Only set for root memory blocks */
 
         void*                                 m_backend_object;
         Anvil::MemoryBlockCreateInfoUniquePtr m_create_info_ptr;
@@ -266,6 +290,8 @@ namespace Anvil
         Anvil::IMemoryAllocatorBackendBase*                 m_parent_memory_allocator_backend_ptr;
 
         std::map<Anvil::ExternalMemoryHandleTypeFlagBits, Anvil::ExternalHandleUniquePtr> m_external_handle_type_to_external_handle;
+
+        friend class Anvil::MemoryAllocator; /* defragment() */
     };
 }; /* Vulkan namespace */
 
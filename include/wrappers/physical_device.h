@@ -25,8 +25,10 @@
  *  - simplify life-time management of physical devices.
  *  - provide a simply way to cache & retrieve information about physical device capabilities.
  *  - track any physical device wrapper instance leaks via object tracker.
+ *  - memoize format & image format capability queries, so that repeated checks do not call back into the driver.
  *
- *  The wrapper is NOT thread-safe.
+ *  The wrapper is NOT thread-safe, with the exception of get_format_properties(), get_image_format_properties()
+ *  and prewarm_format_capability_cache() which can be called from multiple threads at the same time.
  **/
 #ifndef WRAPPERS_PHYSICAL_DEVICE_H
 #define WRAPPERS_PHYSICAL_DEVICE_H
@@ -34,6 +36,8 @@
 #include "misc/debug.h"
 #include "misc/extensions.h"
 #include "misc/types.h"
+#include <mutex>
+#include <unordered_map>
 
 namespace Anvil
 {
@@ -61,7 +65,10 @@ namespace Anvil
 
         /** Returns a filled structure telling current consumption of memory on a per-heap basis.
          *
-         *  Requires VK_EXT_memory_budget support.
+         *  Requires VK_EXT_memory_budget support. If the extension is not supported, a zeroed structure is returned.
+         *
+         *  Values are sampled at call time. Budget reported by the implementation may change between calls, as other
+         *  processes allocate and release memory.
          **/
         Anvil::MemoryBudget get_available_memory_budget() const;
 
@@ -103,12 +110,20 @@ namespace Anvil
         bool get_fence_properties(const Anvil::FencePropertiesQuery& in_query,
                                   Anvil::FenceProperties*            out_opt_result_ptr = nullptr) const;
 
+        /** Retrieves format properties, as reported by the wrapped physical device.
+         *
+         *  The driver is only queried the first time properties of a given format are requested. Subsequent calls
+         *  return the memoized result.
+         **/
         Anvil::FormatProperties get_format_properties(Anvil::Format in_format) const;
 
         /** Retrieves image format properties, as reported by the wrapped physical device.
          *
          *  For external memory handle capability queries, VK_KHR_external_memory_capabilities support is required.
          *
+         *  Results are memoized, using all fields of @param in_query as the key. Unsupported configurations are
+         *  memoized too.
+         *
          *
          *  @param in_format Vulkan format to retrieve the filled structure for.
          *
@@ -190,6 +205,18 @@ namespace Anvil
                                                 Anvil::ImageTiling                               in_tiling,
                                                 std::vector<Anvil::SparseImageFormatProperties>& out_result) const;
 
+        /** Fills the memo tables used by get_format_properties() and get_image_format_properties() ahead of time.
+         *
+         *  Format properties are retrieved for all core Vulkan 1.0 formats. Image format properties are only retrieved
+         *  for the queries specified by the caller. Entries which are already memoized are not queried again.
+         *
+         *  Called at device creation time if DeviceCreateInfo::set_format_capability_cache_prewarm() has been used
+         *  to request it.
+         *
+         *  @param in_image_format_queries Image format properties queries to run. May be empty.
+         **/
+        void prewarm_format_capability_cache(const std::vector<ImageFormatPropertiesQuery>& in_image_format_queries) const;
+
         /** Tells whether user-specified extension is supported by the physical device.
          *
          *  @param in_extension_name Name of the extension to use for the query. Must not be
@@ -212,6 +239,30 @@ namespace Anvil
         bool supports_core_vk1_1() const;
 
     private:
+        /* Private type definitions */
+
+        typedef struct ImageFormatPropertiesCacheEntry
+        {
+            bool                         is_supported;
+            Anvil::ImageFormatProperties properties;
+
+            ImageFormatPropertiesCacheEntry(const bool&                         in_is_supported,
+                                            const Anvil::ImageFormatProperties& in_properties)
+                :is_supported(in_is_supported),
+                 properties  (in_properties)
+            {
+                /* Stub */
+            }
+        } ImageFormatPropertiesCacheEntry;
+
+        struct ImageFormatPropertiesQueryHasher
+        {
+            std::size_t operator()(const ImageFormatPropertiesQuery& in_query) const;
+        };
+
+        typedef std::unordered_map<Anvil::Format, Anvil::FormatProperties, EnumClassHasher<Anvil::Format> >              FormatPropertiesCache;
+        typedef std::unordered_map<ImageFormatPropertiesQuery, ImageFormatPropertiesCacheEntry, ImageFormatPropertiesQueryHasher> ImageFormatPropertiesCache;
+
         /* Private functions */
 
         /** Constructor. Retrieves properties & capabilities of a physical device at
@@ -241,6 +292,17 @@ namespace Anvil
         void set_device_group_device_index(uint32_t in_new_device_group_device_index);
         void set_device_group_index       (uint32_t in_new_device_group_index);
 
+        /** Retrieves format properties from the driver, bypassing the memo table. */
+        Anvil::FormatProperties query_format_properties(Anvil::Format in_format) const;
+
+        /** Retrieves image format properties from the driver, bypassing the memo table.
+         *
+         *  @return true if the configuration is supported, false otherwise. @param out_result_ptr is only
+         *          filled if true is returned.
+         **/
+        bool query_image_format_properties(const ImageFormatPropertiesQuery& in_query,
+                                           Anvil::ImageFormatProperties*     out_result_ptr) const;
+
         bool supports_core_vk1_1(const uint32_t& in_api_version) const;
 
         /* Private variables */
@@ -256,41 +318,60 @@ namespace Anvil
         QueueFamilyInfoItems                         m_queue_families;
         Anvil::PhysicalDeviceProperties              m_properties;
 
+        mutable FormatPropertiesCache      m_format_properties_cache;
+        mutable std::mutex                 m_format_properties_cache_mutex;
+        mutable ImageFormatPropertiesCache m_image_format_properties_cache;
+        mutable std::mutex                 m_image_format_properties_cache_mutex;
+
         std::unique_ptr<Anvil::AMDShaderCoreProperties>                                 m_amd_shader_core_properties_ptr;
         std::unique_ptr<Anvil::PhysicalDeviceFeaturesCoreVK10>                          m_core_features_vk10_ptr;
         std::unique_ptr<Anvil::PhysicalDeviceFeaturesCoreVK11>                          m_core_features_vk11_ptr;
         std::unique_ptr<Anvil::PhysicalDevicePropertiesCoreVK10>                        m_core_properties_vk10_ptr;
         std::unique_ptr<Anvil::PhysicalDevicePropertiesCoreVK11>                        m_core_properties_vk11_ptr;
+        std::unique_ptr<Anvil::EXTConditionalRenderingFeatures>                         m_ext_conditional_rendering_features_ptr;
         std::unique_ptr<Anvil::EXTConservativeRasterizationProperties>                  m_ext_conservative_rasterization_properties_ptr;
         std::unique_ptr<Anvil::EXTDepthClipEnableFeatures>                              m_ext_depth_clip_enable_features_ptr;
         std::unique_ptr<Anvil::EXTDescriptorIndexingFeatures>                           m_ext_descriptor_indexing_features_ptr;
         std::unique_ptr<Anvil::EXTDescriptorIndexingProperties>                         m_ext_descriptor_indexing_properties_ptr;
         std::unique_ptr<Anvil::EXTExternalMemoryHostProperties>                         m_ext_external_memory_host_properties_ptr;
+        std::unique_ptr<Anvil::EXTHostImageCopyFeatures>                                m_ext_host_image_copy_features_ptr;
+        std::unique_ptr<Anvil::EXTHostQueryResetFeatures>                               m_ext_host_query_reset_features_ptr;
         std::unique_ptr<Anvil::EXTInlineUniformBlockFeatures>                           m_ext_inline_uniform_block_features_ptr;
         std::unique_ptr<Anvil::EXTInlineUniformBlockProperties>                         m_ext_inline_uniform_block_properties_ptr;
         std::unique_ptr<Anvil::EXTPCIBusInfoProperties>                                 m_ext_pci_bus_info_ptr;
         std::unique_ptr<Anvil::EXTSampleLocationsProperties>                            m_ext_sample_locations_properties_ptr;
         std::unique_ptr<Anvil::EXTSamplerFilterMinmaxProperties>                        m_ext_sampler_filter_minmax_properties_ptr;
         std::unique_ptr<Anvil::EXTScalarBlockLayoutFeatures>                            m_ext_scalar_block_layout_features_ptr;
+        std::unique_ptr<Anvil::EXTSubgroupSizeControlFeatures>                          m_ext_subgroup_size_control_features_ptr;
+        std::unique_ptr<Anvil::EXTSubgroupSizeControlProperties>                        m_ext_subgroup_size_control_properties_ptr;
         std::unique_ptr<Anvil::EXTTransformFeedbackFeatures>                            m_ext_transform_feedback_features_ptr;
         std::unique_ptr<Anvil::EXTTransformFeedbackProperties>                          m_ext_transform_feedback_properties_ptr;
         std::unique_ptr<Anvil::EXTVertexAttributeDivisorProperties>                     m_ext_vertex_attribute_divisor_properties_ptr;
         std::unique_ptr<Anvil::EXTMemoryPriorityFeatures>                               m_ext_memory_priority_features_ptr;
+        std::unique_ptr<Anvil::EXTPageableDeviceLocalMemoryFeatures>                    m_ext_pageable_device_local_memory_features_ptr;
         std::unique_ptr<Anvil::KHR16BitStorageFeatures>                                 m_khr_16_bit_storage_features_ptr;
         std::unique_ptr<Anvil::KHR8BitStorageFeatures>                                  m_khr_8_bit_storage_features_ptr;
+        std::unique_ptr<Anvil::KHRAccelerationStructureFeatures>                        m_khr_acceleration_structure_features_ptr;
+        std::unique_ptr<Anvil::KHRBufferDeviceAddressFeatures>                          m_khr_buffer_device_address_features_ptr;
         std::unique_ptr<Anvil::KHRDepthStencilResolveProperties>                        m_khr_depth_stencil_resolve_properties_ptr;
         std::unique_ptr<Anvil::KHRDriverPropertiesProperties>                           m_khr_driver_properties_properties_ptr;
+        std::unique_ptr<Anvil::KHRDynamicRenderingFeatures>                             m_khr_dynamic_rendering_features_ptr;
         std::unique_ptr<Anvil::KHRExternalMemoryCapabilitiesPhysicalDeviceIDProperties> m_khr_external_memory_capabilities_physical_device_id_properties_ptr;
         std::unique_ptr<Anvil::KHRFloat16Int8Features>                                  m_khr_float16_int8_features_ptr;
+        std::unique_ptr<Anvil::KHRImagelessFramebufferFeatures>                         m_khr_imageless_framebuffer_features_ptr;
         std::unique_ptr<Anvil::KHRMaintenance2PhysicalDevicePointClippingProperties>    m_khr_maintenance2_physical_device_point_clipping_properties_ptr;
         std::unique_ptr<Anvil::KHRMaintenance3Properties>                               m_khr_maintenance3_properties_ptr;
         std::unique_ptr<Anvil::KHRMultiviewFeatures>                                    m_khr_multiview_features_ptr;
         std::unique_ptr<Anvil::KHRMultiviewProperties>                                  m_khr_multiview_properties_ptr;
+        std::unique_ptr<Anvil::KHRPipelineExecutablePropertiesFeatures>                 m_khr_pipeline_executable_properties_features_ptr;
         std::unique_ptr<Anvil::KHRSamplerYCbCrConversionFeatures>                       m_khr_sampler_ycbcr_conversion_features_ptr;
         std::unique_ptr<Anvil::KHRShaderAtomicInt64Features>                            m_khr_shader_atomic_int64_features_ptr;
         std::unique_ptr<Anvil::KHRShaderFloatControlsProperties>                        m_khr_shader_float_controls_properties_ptr;
+        std::unique_ptr<Anvil::KHRTimelineSemaphoreFeatures>                            m_khr_timeline_semaphore_features_ptr;
         std::unique_ptr<Anvil::KHRVariablePointerFeatures>                              m_khr_variable_pointer_features_ptr;
         std::unique_ptr<Anvil::KHRVulkanMemoryModelFeatures>                            m_khr_vulkan_memory_model_features_ptr;
+        std::unique_ptr<Anvil::NVMeshShaderFeatures>                                    m_nv_mesh_shader_features_ptr;
+        std::unique_ptr<Anvil::NVShadingRateImageFeatures>                              m_nv_shading_rate_image_features_ptr;
 
         friend class Anvil::Instance;
     };
@@ -24,6 +24,11 @@
  *
  *  - manage life-time of pipeline cache instances.
  *  - let ObjectTracker detect leaking queue pipeline cache instances.
+ *  - persist pipeline cache contents across runs. Files written by store_to_file() are tagged with
+ *    the driver version and validated against the device's vendor ID, device ID and pipeline cache UUID
+ *    when loaded with create_from_file(). Stale or corrupt files are discarded. Cache contents can
+ *    optionally be deflate-compressed on store.
+ *  - combine caches written by multiple processes into a single file. See create_merged_from_files().
  *
  *  The wrapper is NOT thread-safe.
  **/
@@ -34,6 +39,8 @@
 #include "misc/debug_marker.h"
 #include "misc/mt_safety.h"
 #include "misc/types.h"
+#include <string>
+#include <vector>
 
 
 namespace Anvil
@@ -58,6 +65,43 @@ namespace Anvil
                                                     size_t                   in_initial_data_size = 0,
                                                     const void*              in_initial_data      = nullptr);
 
+        /** Creates a new pipeline cache, initialized with contents of a file written by an earlier store_to_file() call.
+         *
+         *  If the file does not exist, or holds data which is incompatible with @param in_device_ptr (eg. because
+         *  it was written by a different driver version or for a different physical device), an empty pipeline
+         *  cache is created instead. Compressed files are decompressed transparently.
+         *
+         *  @param in_device_ptr Vulkan device to initialize the pipeline cache with.
+         *  @param in_mt_safe    True if MT-safety should be enforced for functions that operate on the
+         *                       underlying Vulkan handle.
+         *  @param in_filename   Name of the file to load cache contents from.
+         *
+         *  @return New pipeline cache instance if successful, nullptr otherwise.
+         **/
+        static Anvil::PipelineCacheUniquePtr create_from_file(const Anvil::BaseDevice* in_device_ptr,
+                                                              bool                     in_mt_safe,
+                                                              const std::string&       in_filename);
+
+        /** Creates a new pipeline cache, holding the merged contents of all files under @param in_filenames. Each file
+         *  must have been written by an earlier store_to_file() call, eg. by a different process.
+         *
+         *  Files which do not exist or are incompatible with @param in_device_ptr are skipped, as per
+         *  create_from_file().
+         *
+         *  @param in_device_ptr              Vulkan device to initialize the pipeline cache with.
+         *  @param in_mt_safe                 True if MT-safety should be enforced for functions that operate on the
+         *                                    underlying Vulkan handle.
+         *  @param in_filenames               Names of the files to merge.
+         *  @param out_opt_n_files_merged_ptr If not null, deref will be set to the number of files whose contents
+         *                                    have been merged into the new cache.
+         *
+         *  @return New pipeline cache instance if successful, nullptr otherwise.
+         **/
+        static Anvil::PipelineCacheUniquePtr create_merged_from_files(const Anvil::BaseDevice*        in_device_ptr,
+                                                                      bool                            in_mt_safe,
+                                                                      const std::vector<std::string>& in_filenames,
+                                                                      uint32_t*                       out_opt_n_files_merged_ptr = nullptr);
+
         /** Destroys the Vulkan counterpart and unregisters the wrapper instance from the object tracker. */
         virtual ~PipelineCache();
 
@@ -91,7 +135,38 @@ namespace Anvil
         bool merge(uint32_t                           in_n_pipeline_caches,
                    const Anvil::PipelineCache* const* in_src_cache_ptrs);
 
+        /** Writes pipeline cache contents to a file, so that they can be restored in a subsequent run with
+         *  create_from_file().
+         *
+         *  Data is first written to a temporary file, which then replaces the file under @param in_filename.
+         *  This prevents concurrently running processes from loading a partially written cache.
+         *
+         *  Driver-produced cache data is usually highly redundant. If @param in_compress is true, it is deflate-compressed
+         *  before being written, which typically reduces the file size several times at the cost of extra CPU time on
+         *  store and load.
+         *
+         *  @param in_filename Name of the file to write cache contents to.
+         *  @param in_compress True to compress cache contents.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool store_to_file(const std::string& in_filename,
+                           bool               in_compress = false);
+
     private:
+        /* Private type definitions */
+
+        /* Header prepended to cache data by store_to_file() */
+        typedef struct FileHeader
+        {
+            uint32_t magic;
+            uint32_t file_version;
+            uint32_t driver_version;
+            uint32_t flags;
+            uint32_t n_data_bytes;
+            uint32_t n_stored_bytes;
+        } FileHeader;
+
         /* Private functions */
 
         /* Constructor. See create() for specification */
@@ -103,6 +178,13 @@ namespace Anvil
         PipelineCache           (const PipelineCache&);
         PipelineCache& operator=(const PipelineCache&);
 
+        static bool is_data_compatible(const Anvil::BaseDevice* in_device_ptr,
+                                       size_t                   in_n_data_bytes,
+                                       const void*              in_data_ptr);
+        static bool read_file_data    (const Anvil::BaseDevice*    in_device_ptr,
+                                       const std::string&          in_filename,
+                                       std::vector<unsigned char>* out_data_ptr);
+
         /* Private variables */
         const Anvil::BaseDevice* m_device_ptr;
         VkPipelineCache          m_pipeline_cache;
@@ -33,6 +33,7 @@
 #include "misc/mt_safety.h"
 #include "misc/types.h"
 #include <memory>
+#include <unordered_map>
 
 namespace Anvil
 {
@@ -78,6 +79,9 @@ namespace Anvil
 
         typedef std::vector<std::unique_ptr<PipelineLayoutContainer> > PipelineLayouts;
 
+        /* Layouts are bucketed by get_hash(), so that lookups only need to compare layouts which are likely to match. */
+        typedef std::unordered_map<uint64_t, PipelineLayouts> HashToPipelineLayoutsMap;
+
         /* Private functions */
         PipelineLayoutManager(const Anvil::BaseDevice* in_device_ptr,
                               bool                     in_mt_safe);
@@ -87,6 +91,9 @@ namespace Anvil
 
         void on_pipeline_layout_dereferenced(Anvil::PipelineLayout* in_layout_ptr);
 
+        static uint64_t get_hash(const std::vector<DescriptorSetCreateInfoUniquePtr>* in_ds_create_info_items_ptr,
+                                 const PushConstantRanges&                            in_push_constant_ranges);
+
         /** Instantiates a new PipelineLayoutManager instance.
          *
          *  NOTE: This function should only be used by Device.
@@ -101,7 +108,7 @@ namespace Anvil
 
         /* Private members */
         const Anvil::BaseDevice* m_device_ptr;
-        PipelineLayouts          m_pipeline_layouts;
+        HashToPipelineLayoutsMap m_pipeline_layouts;
 
         friend class BaseDevice;
     };
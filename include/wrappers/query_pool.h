@@ -46,8 +46,9 @@ namespace Anvil
          *
          *  @param in_device_ptr               Device to use.
          *  @param in_query_type               Type of the query to create the query pool for. May
-         *                                     either be VK_QUERY_TYPE_OCCLUSION or
-         *                                     VK_QUERY_TYPE_PIPELINE_STATISTICS.
+         *                                     be VK_QUERY_TYPE_OCCLUSION, VK_QUERY_TYPE_TIMESTAMP,
+         *                                     VK_QUERY_TYPE_TRANSFORM_FEEDBACK_STREAM_EXT or
+         *                                     VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR.
          *  @param in_n_max_concurrent_queries Maximum number of queries which are going to be in-flight
          *                                     for this query pool.
          *
@@ -81,21 +82,39 @@ namespace Anvil
             return m_n_max_indices;
         }
 
+        /** Returns the number of result values each query of the pool produces. This is the number of enabled
+         *  pipeline statistics for pipeline statistics pools, and 1 for all other pool types. */
+        uint32_t get_n_values_per_query() const
+        {
+            return m_n_values_per_query;
+        }
+
         /** Retrieves the raw Vulkan handle of the encapsulated query pool. */
         VkQueryPool get_query_pool() const
         {
             return m_query_pool_vk;
         }
 
+        /** Returns the type of queries the pool has been created for. */
+        VkQueryType get_query_type() const
+        {
+            return m_query_type;
+        }
+
         /* Uses vkGetQueryPoolResults() to retrieve result values for the user-specified query range.
          *
          * NOTE: It is assumed result values are to be returned to a tightly-packed array of size
-         *       @param in_n_queries * sizeof(query result type). if @param in_query_props includes QUERY_RESULT_WITH_AVAILABILITY_BIT,
-         *       twice the amount of memory is needed for result storage.
+         *       @param in_n_queries * get_n_values_per_query() * sizeof(query result type). if @param in_query_props
+         *       includes QUERY_RESULT_WITH_AVAILABILITY_BIT, one more value per query is needed for result storage.
+         *       The availability value follows the query's result values.
          *
          * NOTE: It is caller's responsibility to follow the requirements listed in the spec which guarantee
          *       the results returned by this entrypoint are correct.
          *
+         * NOTE: If @param in_query_props includes QUERY_RESULT_WITH_AVAILABILITY_BIT or QUERY_RESULT_PARTIAL_BIT,
+         *       the function does not fail if some of the queries are not ready yet. Instead, false is stored
+         *       under @param out_all_query_results_retrieved_ptr.
+         *
          **/
         bool get_query_pool_results(const uint32_t&                in_first_query_index,
                                     const uint32_t&                in_n_queries,
@@ -125,6 +144,24 @@ namespace Anvil
                                                    out_all_query_results_retrieved_ptr);
         }
 
+        /** Resets the user-specified query range from the host, using vkResetQueryPoolEXT().
+         *
+         *  Unlike CommandBufferBase::record_reset_query_pool(), this does not require a command buffer to be
+         *  recorded and submitted before the queries can be reused.
+         *
+         *  Requires VK_EXT_host_query_reset, with hostQueryReset feature enabled.
+         *
+         *  NOTE: It is caller's responsibility to make sure no submitted command which refers to any of the
+         *        queries in the range is still pending execution.
+         *
+         *  @param in_first_query_index Index of the first query to reset.
+         *  @param in_n_queries         Number of queries to reset.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool reset_host(uint32_t in_first_query_index,
+                        uint32_t in_n_queries);
+
     private:
         /* Constructor. Please see corresponding create() for specification */
         explicit QueryPool(const Anvil::BaseDevice* in_device_ptr,
@@ -160,6 +197,7 @@ namespace Anvil
         /* Private variables */
         const Anvil::BaseDevice* m_device_ptr;
         uint32_t                 m_n_max_indices;
+        uint32_t                 m_n_values_per_query;
         VkQueryPool              m_query_pool_vk;
         const VkQueryType        m_query_type;
     };
@@ -134,6 +134,18 @@ namespace Anvil
          **/
         bool bind_sparse_memory(Anvil::SparseMemoryBindingUpdateInfo& in_update);
 
+        /** Updates sparse resource memory bindings described by multiple update containers, using a single
+         *  vkQueueBindSparse() call. Bind infos are submitted in the order of the containers, as if the containers'
+         *  bind infos had been appended to a single container.
+         *
+         *  At most one of the containers may have a fence assigned.
+         *
+         *  @param in_n_updates   Number of containers to submit. Must not be 0.
+         *  @param in_updates_ptr Array of @param in_n_updates containers to submit. Must not be null.
+         **/
+        bool bind_sparse_memory(uint32_t                                     in_n_updates,
+                                Anvil::SparseMemoryBindingUpdateInfo* const* in_updates_ptr);
+
         /** Ends a queue debug label region. Requires a preceding begin_debug_utils_label() call.
          *
          *  Requires VK_EXT_debug_utils support. Otherwise, the call is moot.
@@ -141,6 +153,12 @@ namespace Anvil
          */
         void end_debug_utils_label();
 
+        /** Returns the frame timing recorder associated with the queue, or null if none has been set. */
+        Anvil::FrameTimingRecorder* get_frame_timing_recorder() const
+        {
+            return m_frame_timing_recorder_ptr;
+        }
+
         /** Retrieves parent device instance */
         const Anvil::BaseDevice* get_parent_device() const
         {
@@ -174,6 +192,12 @@ namespace Anvil
             return m_queue_index;
         }
 
+        /** Returns the utilization tracker associated with the queue, or null if none has been set. */
+        Anvil::QueueUtilizationTracker* get_utilization_tracker() const
+        {
+            return m_utilization_tracker_ptr;
+        }
+
         /** Inserts a single queue debug label.
          *
          *  Requires VK_EXT_debug_utils support. Otherwise, the call is moot.
@@ -278,8 +302,51 @@ namespace Anvil
                                               Anvil::Semaphore* const*            in_wait_semaphore_ptrs_ptr,
                                               Anvil::SwapchainOperationErrorCode* out_present_results_ptr);
 
+        /** Associates a frame timing recorder with the queue. Once set, the recorder is notified about every
+         *  vkQueueSubmit() call issued for the queue.
+         *
+         *  Present requests are reported to the recorder attached to the presented swapchain instead.
+         *
+         *  @param in_opt_recorder_ptr Recorder to use. Pass null to detach the current recorder.
+         */
+        void set_frame_timing_recorder(Anvil::FrameTimingRecorder* in_opt_recorder_ptr)
+        {
+            m_frame_timing_recorder_ptr = in_opt_recorder_ptr;
+        }
+
+        /** Associates a utilization tracker with the queue. Once set, each SubmitInfo submitted to the queue is
+         *  bracketed with timestamp writes, as described in QueueUtilizationTracker.
+         *
+         *  Must not be called while other threads are submitting to the queue.
+         *
+         *  @param in_opt_tracker_ptr Tracker to use. Must have been created for this queue. Pass null to detach
+         *                            the current tracker.
+         */
+        void set_utilization_tracker(Anvil::QueueUtilizationTracker* in_opt_tracker_ptr)
+        {
+            m_utilization_tracker_ptr = in_opt_tracker_ptr;
+        }
+
         bool submit(const SubmitInfo& in_submit_info);
 
+        /** Submits multiple batches with a single vkQueueSubmit() call.
+         *
+         *  Vulkan structures needed to describe the batches are kept in storage owned by the queue, which is
+         *  reused across calls. This makes the function a better fit for apps which submit many small batches
+         *  per frame than issuing a submit() call per batch.
+         *
+         *  Only the last SubmitInfo instance may specify a fence or request the call to block. If it does, the
+         *  fence is signalled once all batches finish executing and its timeout applies to the whole submission.
+         *
+         *  @param in_n_submit_infos   Number of SubmitInfo instances available under @param in_submit_info_ptrs.
+         *  @param in_submit_info_ptrs Batches to submit, in submission order. Must not be null if @param in_n_submit_infos
+         *                             is not 0.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool submit(uint32_t                        in_n_submit_infos,
+                    const Anvil::SubmitInfo* const* in_submit_info_ptrs);
+
         /** Tells whether the queue supports protected memory operations */
         bool supports_protected_memory_operations() const
         {
@@ -310,6 +377,8 @@ namespace Anvil
                                  Anvil::Semaphore* const*              in_wait_semaphore_ptrs,
                                  bool                                  in_should_lock);
 
+        void bind_sparse_memory_update_resources(Anvil::SparseMemoryBindingUpdateInfo& in_update);
+
         void bind_sparse_memory_lock_unlock    (Anvil::SparseMemoryBindingUpdateInfo& in_update,
                                                 bool                                  in_should_lock);
         void submit_command_buffers_lock_unlock(uint32_t                              in_n_command_buffers,
@@ -328,6 +397,10 @@ namespace Anvil
                                                 const SemaphoreMGPUSubmission*        in_opt_wait_semaphore_submissions_ptr,
                                                 Anvil::Fence*                         in_opt_fence_ptr,
                                                 bool                                  in_should_lock);
+        void submit_lock_unlock                (uint32_t                              in_n_submit_infos,
+                                                const Anvil::SubmitInfo* const*       in_submit_info_ptrs,
+                                                Anvil::Fence*                         in_opt_fence_ptr,
+                                                bool                                  in_should_lock);
 
         /* Constructor. Please see create() for specification */
         Queue(const Anvil::BaseDevice*          in_device_ptr,
@@ -339,16 +412,41 @@ namespace Anvil
         Queue          (const Queue&);
         Queue operator=(const Queue&);
 
+        /* Private type definitions */
+
+        /* Holds Vulkan structures used by submit(). Vectors are only ever grown, so that steady-state submissions
+         * do not allocate. */
+        typedef struct SubmitScratch
+        {
+            std::vector<uint32_t>                               cmd_buffer_device_masks;
+            std::vector<VkCommandBuffer>                        cmd_buffers_vk;
+            std::vector<VkDeviceGroupSubmitInfoKHR>             device_group_submit_infos;
+            std::vector<VkProtectedSubmitInfo>                  protected_submit_infos;
+            std::vector<uint32_t>                               semaphore_device_indices;
+            std::vector<VkSemaphore>                            semaphores_vk;
+            std::vector<VkSubmitInfo>                           submit_infos;
+            std::vector<VkTimelineSemaphoreSubmitInfoKHR>       timeline_submit_infos;
+
+            #if defined(_WIN32)
+                std::vector<VkD3D12FenceSubmitInfoKHR>              d3d12_fence_submit_infos;
+                std::vector<VkDeviceMemory>                         device_memory_blocks;
+                std::vector<VkWin32KeyedMutexAcquireReleaseInfoKHR> keyed_mutex_infos;
+            #endif
+        } SubmitScratch;
+
         /* Private variables */
         const Anvil::BaseDevice*         m_device_ptr;
+        Anvil::FrameTimingRecorder*      m_frame_timing_recorder_ptr;
         uint32_t                         m_n_debug_label_regions_started;
         VkQueue                          m_queue;
         const uint32_t                   m_queue_family_index;
         const Anvil::QueueGlobalPriority m_queue_global_priority;
         const uint32_t                   m_queue_index;
         Anvil::FenceUniquePtr            m_submit_fence_ptr;
+        SubmitScratch                    m_submit_scratch;
         bool                             m_supports_protected_memory_operations;
         bool                             m_supports_sparse_bindings;
+        Anvil::QueueUtilizationTracker*  m_utilization_tracker_ptr;
     };
 }; /* namespace Anvil */
 
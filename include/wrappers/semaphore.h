@@ -26,6 +26,8 @@
  *  - simplify semaphore usage.
  *  - let ObjectTracker detect leaking semaphore instances.
  *
+ *  Both binary and timeline semaphores are supported. The latter require VK_KHR_timeline_semaphore.
+ *
  *  The wrapper is NOT thread-safe.
  **/
 #ifndef WRAPPERS_SEMAPHORE_H
@@ -70,6 +72,16 @@ namespace Anvil
             return m_create_info_ptr.get();
         }
 
+        /** Retrieves the current counter value of a timeline semaphore.
+         *
+         *  Requires VK_KHR_timeline_semaphore. Must only be called for timeline semaphores.
+         *
+         *  @param out_value_ptr Deref will be set to the counter value if the call succeeds. Must not be null.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool get_counter_value(uint64_t* out_value_ptr) const;
+
         /** Retrieves a raw handle to the underlying Vulkan semaphore instance  */
         VkSemaphore get_semaphore() const
         {
@@ -109,9 +121,57 @@ namespace Anvil
                                              const ExternalHandleType&                         in_handle);
         #endif
 
+        /** Tells whether the wrapped semaphore is a timeline semaphore. */
+        bool is_timeline() const;
+
         /** Releases the underlying Vulkan Semaphore instance and creates a new Vulkan object. */
         bool reset();
 
+        /** Sets the counter of a timeline semaphore to @param in_value from the host.
+         *
+         *  Requires VK_KHR_timeline_semaphore. Must only be called for timeline semaphores. @param in_value must be
+         *  larger than the current counter value and than all pending signal operations' values.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool signal(uint64_t in_value);
+
+        /** Blocks until the counter of a timeline semaphore reaches @param in_value.
+         *
+         *  Requires VK_KHR_timeline_semaphore. Must only be called for timeline semaphores.
+         *
+         *  @param in_value   Value to wait for.
+         *  @param in_timeout Timeout, expressed in nanoseconds.
+         *
+         *  @return true if the counter reached the value within the specified timeout, false otherwise.
+         */
+        bool wait(uint64_t in_value,
+                  uint64_t in_timeout = UINT64_MAX);
+
+        /** Blocks until the counters of all (or any, if @param in_wait_all is false) of the specified timeline
+         *  semaphores reach the corresponding values.
+         *
+         *  This function is expected to be more efficient than calling wait() for @param in_n_semaphores times.
+         *
+         *  Requires VK_KHR_timeline_semaphore. All semaphores must be timeline semaphores created for the same device.
+         *
+         *  @param in_n_semaphores    Number of semaphores & values under @param in_semaphore_ptrs and @param in_values.
+         *  @param in_semaphore_ptrs  Semaphores to wait on. Must not be null unless @param in_n_semaphores is 0.
+         *  @param in_values          Values to wait for. Must not be null unless @param in_n_semaphores is 0.
+         *  @param in_wait_all        True to wait until all counters reach their values, false to wait for any.
+         *  @param in_timeout         Timeout, expressed in nanoseconds.
+         *  @param out_opt_result_ptr If not null, deref will be set to the result of the vkWaitSemaphoresKHR() call,
+         *                            so that callers can tell a timeout apart from a failure (eg. device loss).
+         *
+         *  @return true if the wait condition was satisfied within the specified timeout, false otherwise.
+         */
+        static bool wait_semaphores(uint32_t                 in_n_semaphores,
+                                    Anvil::Semaphore* const* in_semaphore_ptrs,
+                                    const uint64_t*          in_values,
+                                    bool                     in_wait_all        = true,
+                                    uint64_t                 in_timeout         = UINT64_MAX,
+                                    VkResult*                out_opt_result_ptr = nullptr);
+
     private:
         /* Private functions */
 
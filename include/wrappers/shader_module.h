@@ -206,6 +206,12 @@ namespace Anvil
             return m_spirv_blob;
         }
 
+        /** Returns a 64-bit hash of the SPIR-V blob, computed with Anvil::Utils::hash64() at creation time. */
+        uint64_t get_spirv_blob_hash() const
+        {
+            return m_spirv_blob_hash;
+        }
+
         /** Returns name of the tessellation control shader stage entry-point, as defined at
          *  construction time.
          *
@@ -284,6 +290,7 @@ namespace Anvil
         std::string              m_glsl_source_code;
         VkShaderModule           m_module;
         std::vector<uint32_t>    m_spirv_blob;
+        uint64_t                 m_spirv_blob_hash;
 
 #ifdef ANVIL_LINK_WITH_GLSLANG
         std::string m_disassembly;
@@ -33,6 +33,7 @@
 #define WRAPPERS_SWAPCHAIN_H
 
 #include "misc/debug_marker.h"
+#include "misc/frame_timing_recorder.h"
 #include "misc/mt_safety.h"
 #include "misc/types.h"
 #include "wrappers/device.h"
@@ -80,11 +81,67 @@ namespace Anvil
                                                   uint32_t*                           out_result_index_ptr,
                                                   bool                                in_should_block = false);
 
+        /** Acquires a new swapchain image without any CPU-side wait.
+         *
+         *  Can be used for both SGPUDevice and mGPU swapchains. For the latter, all physical devices are used.
+         *
+         *  For off-screen swapchains, the call always succeeds. If the device supports VK_KHR_timeline_semaphore,
+         *  @param in_semaphore_ptr is signalled by the GPU once the present op which last used the image has executed,
+         *  so multiple frames can be in flight at the same time.
+         *
+         *  @param in_semaphore_ptr     Semaphore to set upon frame acquisition. Must not be null.
+         *  @param out_result_index_ptr Deref will be set to the index of the acquired swapchain image, or to UINT32_MAX
+         *                              if no image could be acquired. Must not be null.
+         *  @param in_timeout           Maximum time to spend in vkAcquireNextImage*KHR(), in nanoseconds. Pass 0 to
+         *                              return immediately if no image is available.
+         *
+         *  @return NOT_READY or TIMEOUT if no image could be acquired, status of the acquisition otherwise.
+         **/
+        SwapchainOperationErrorCode acquire_image_nonblocking(Anvil::Semaphore* in_semaphore_ptr,
+                                                              uint32_t*         out_result_index_ptr,
+                                                              uint64_t          in_timeout = 0);
+
+        /** Binds the image view of a swapchain image as a storage image, so that a compute pass can write its results
+         *  directly to the swapchain image. The view is bound in ImageLayout::GENERAL. Please see
+         *  record_storage_image_barrier() for the layout transitions this requires.
+         *
+         *  The swapchain must have been created with storage usage (see SwapchainCreateInfo::request_storage_usage() ).
+         *
+         *  @param in_n_swapchain_image      Index of the swapchain image to bind. Must be smaller than get_n_images().
+         *  @param in_descriptor_set_ptr     Descriptor set to update. Must not be null.
+         *  @param in_binding_index          Index of a STORAGE_IMAGE binding of the descriptor set.
+         *  @param in_binding_element_index  Array element of the binding to update.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool bind_storage_image(uint32_t                   in_n_swapchain_image,
+                                Anvil::DescriptorSet*      in_descriptor_set_ptr,
+                                Anvil::BindingIndex        in_binding_index,
+                                Anvil::BindingElementIndex in_binding_element_index = 0) const;
+
+        /** Binds image views of all swapchain images as storage images, to consecutive array elements of a single
+         *  binding, starting at element 0. This lets a single descriptor set serve all frames, with the compute shader
+         *  indexing the array with the acquired image index (eg. passed as a push constant).
+         *
+         *  The binding must hold at least get_n_images() elements. Remaining requirements are as for
+         *  bind_storage_image().
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool bind_storage_images(Anvil::DescriptorSet* in_descriptor_set_ptr,
+                                 Anvil::BindingIndex   in_binding_index) const;
+
         const SwapchainCreateInfo* get_create_info_ptr() const
         {
             return m_create_info_ptr.get();
         }
 
+        /** Returns the frame timing recorder associated with the swapchain, or null if none has been set. */
+        Anvil::FrameTimingRecorder* get_frame_timing_recorder() const
+        {
+            return m_frame_timing_recorder_ptr;
+        }
+
         /** Returns height of the swapchain, as specified at creation time */
         uint32_t get_height() const
         {
@@ -149,6 +206,62 @@ namespace Anvil
             return m_size.width;
         }
 
+        /** Creates a new swapchain for the surface and window @param in_old_swapchain_ptr has been created for, using the
+         *  surface's current extents and the old swapchain's remaining properties. The old swapchain is passed as
+         *  oldSwapchain, so that the presentation engine can reuse its resources. The device is never waited on.
+         *
+         *  The old swapchain is retired, even if the new swapchain could not be created. Acquire requests issued
+         *  against it return SwapchainOperationErrorCode::OUT_OF_DATE, but images which have already been acquired
+         *  from it must still be presented.
+         *
+         *  Frames in flight may still be using images of the old swapchain. The wrapper is therefore handed over to
+         *  the device's deferred deletion queue, and released by the first DeferredDeletionQueue::collect() call
+         *  made after the current frame completes. Apps are expected to call DeferredDeletionQueue::end_frame()
+         *  and collect() once per frame.
+         *
+         *  @param in_old_swapchain_ptr Swapchain to recreate. Must not be null.
+         *
+         *  @return New swapchain instance if successful, null otherwise.
+         */
+        static Anvil::SwapchainUniquePtr recreate(Anvil::SwapchainUniquePtr in_old_swapchain_ptr);
+
+        /** Records a layout transition of a swapchain image, which makes it writable by compute shaders, or hands it
+         *  back over to presentation.
+         *
+         *  Before the compute pass, the image is moved from ImageLayout::UNDEFINED to ImageLayout::GENERAL, so its
+         *  contents are discarded. The pass is expected to write all pixels. The semaphore passed to acquire_image()
+         *  should be waited on at PipelineStageFlagBits::COMPUTE_SHADER_BIT (or earlier).
+         *
+         *  After the compute pass, the image is moved to the layout presentation expects: PRESENT_SRC_KHR, or GENERAL
+         *  for off-screen swapchains.
+         *
+         *  @param in_cmd_buffer_ptr       Command buffer to record the barrier in. Must not be null, and must be
+         *                                 submitted to the queue which presents the image.
+         *  @param in_n_swapchain_image    Index of the swapchain image to transition.
+         *  @param in_before_compute_pass  true to make the image writable by compute shaders, false to prepare it for
+         *                                 presentation.
+         *
+         *  @return true if successful, false otherwise.
+         */
+        bool record_storage_image_barrier(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                          uint32_t                  in_n_swapchain_image,
+                                          bool                      in_before_compute_pass) const;
+
+        /** Associates a frame timing recorder with the swapchain. Once set, the recorder is notified about every
+         *  image acquisition, and about every present request issued for the swapchain.
+         *
+         *  The recorder must have been created for this swapchain, and must outlive it, or be detached first.
+         *
+         *  @param in_opt_recorder_ptr Recorder to use. Pass null to detach the current recorder.
+         */
+        void set_frame_timing_recorder(Anvil::FrameTimingRecorder* in_opt_recorder_ptr)
+        {
+            anvil_assert(in_opt_recorder_ptr                  == nullptr ||
+                         in_opt_recorder_ptr->get_swapchain() == this);
+
+            m_frame_timing_recorder_ptr = in_opt_recorder_ptr;
+        }
+
         /* Associates HDR metadata with one or more swapchains.
          *
          * Requires VK_EXT_hdr_metadata.
@@ -187,6 +300,10 @@ namespace Anvil
             return m_destroy_swapchain_before_parent_window_closes;
         }
 
+        /** Tells whether swapchain images have been created with storage usage, and can therefore be bound with
+         *  bind_storage_image(). */
+        bool supports_storage_usage() const;
+
     private:
         /* Private functions */
 
@@ -196,14 +313,39 @@ namespace Anvil
         Swapchain           (const Swapchain&);
         Swapchain& operator=(const Swapchain&);
 
+        SwapchainOperationErrorCode acquire_image_for_all_devices(Anvil::Semaphore*                   in_opt_semaphore_ptr,
+                                                                  uint32_t*                           out_result_index_ptr,
+                                                                  bool                                in_should_block,
+                                                                  uint64_t                            in_timeout);
+        SwapchainOperationErrorCode acquire_image_internal       (Anvil::Semaphore*                   in_opt_semaphore_ptr,
+                                                                  uint32_t                            in_n_mgpu_physical_devices,
+                                                                  const Anvil::PhysicalDevice* const* in_mgpu_physical_device_ptrs,
+                                                                  uint32_t*                           out_result_index_ptr,
+                                                                  bool                                in_should_block,
+                                                                  uint64_t                            in_timeout);
+
         void destroy_swapchain();
         bool init             ();
 
+        /** Used by Anvil::Queue to retire images of off-screen swapchains.
+         *
+         *  Returns the timeline semaphore which the present op for swapchain image @param in_n_swapchain_image
+         *  should signal, and sets *out_signal_value_ptr to the value to signal it with. Returns null if the
+         *  swapchain does not track image availability with a timeline semaphore.
+         */
+        Anvil::Semaphore* get_headless_present_semaphore(uint32_t  in_n_swapchain_image,
+                                                         uint64_t* out_signal_value_ptr);
+
         void on_parent_window_about_to_close();
         void on_present_request_issued      (Anvil::CallbackArgument* in_callback_raw_ptr);
 
         /* Private variables */
         Anvil::SwapchainCreateInfoUniquePtr  m_create_info_ptr;
+        Anvil::FrameTimingRecorder*          m_frame_timing_recorder_ptr;
+        std::vector<uint64_t>                m_headless_image_available_values;
+        Anvil::SemaphoreUniquePtr            m_headless_timeline_semaphore_ptr;
+        uint64_t                             m_headless_timeline_value;
+        bool                                 m_is_retired;
         Anvil::FenceUniquePtr                m_image_available_fence_ptr;
         uint32_t                             m_n_images;  /* number of images created in the swapchain. */
         std::vector<ImageUniquePtr>          m_image_ptrs;
@@ -219,6 +361,8 @@ namespace Anvil
         volatile uint64_t m_n_present_counter;
 
         std::vector<Anvil::Queue*> m_observed_queues;
+
+        friend class Anvil::Queue;
     };
 }; /* namespace Anvil */
 
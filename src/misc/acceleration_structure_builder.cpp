@@ -0,0 +1,729 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/acceleration_structure_builder.h"
+#include "misc/acceleration_structure_create_info.h"
+#include "misc/buffer_create_info.h"
+#include "misc/debug.h"
+#include "misc/memory_allocator.h"
+#include "wrappers/acceleration_structure.h"
+#include "wrappers/buffer.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/device.h"
+#include "wrappers/query_pool.h"
+#include <algorithm>
+
+/* Alignment of scratch regions carved out of the pooled scratch buffer. This is the largest value
+ * minAccelerationStructureScratchOffsetAlignment may take, as per spec. */
+static const VkDeviceSize g_scratch_offset_alignment = 256;
+
+
+/** Please see header for specification */
+Anvil::AccelerationStructureBuilder::AccelerationStructureBuilder(const Anvil::BaseDevice* in_device_ptr,
+                                                                  Anvil::MemoryAllocator*  in_memory_allocator_ptr,
+                                                                  VkDeviceSize             in_max_batch_scratch_size,
+                                                                  bool                     in_mt_safe)
+    :MTSafetySupportProvider (in_mt_safe),
+     m_device_ptr            (in_device_ptr),
+     m_max_batch_scratch_size(in_max_batch_scratch_size),
+     m_memory_allocator_ptr  (in_memory_allocator_ptr),
+     m_scratch_buffer_used   (false),
+     m_scratch_buffer_size   (0)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::AccelerationStructureBuilder::~AccelerationStructureBuilder()
+{
+    lock();
+    {
+        m_builds.clear();
+        m_query_pools.clear();
+        m_retired_acceleration_structures.clear();
+        m_retired_scratch_buffers.clear();
+        m_scratch_buffer_ptr.reset();
+    }
+    unlock();
+}
+
+/** Please see header for specification */
+bool Anvil::AccelerationStructureBuilder::add_build(Anvil::AccelerationStructureType                in_type,
+                                                    uint32_t                                        in_n_geometries,
+                                                    const VkAccelerationStructureGeometryKHR*       in_geometries_ptr,
+                                                    const VkAccelerationStructureBuildRangeInfoKHR* in_build_ranges_ptr,
+                                                    Anvil::BuildAccelerationStructureFlags          in_flags,
+                                                    BuildID*                                        out_build_id_ptr)
+{
+    VkAccelerationStructureBuildGeometryInfoKHR build_info;
+    std::unique_ptr<Build>                      build_ptr           (new Build() );
+    VkAccelerationStructureBuildSizesInfoKHR    build_sizes;
+    std::vector<uint32_t>                       max_primitive_counts(in_n_geometries);
+    bool                                        result              (false);
+
+    anvil_assert(in_n_geometries     >  0);
+    anvil_assert(in_geometries_ptr   != nullptr);
+    anvil_assert(in_build_ranges_ptr != nullptr);
+    anvil_assert(out_build_id_ptr    != nullptr);
+
+    build_ptr->flags = in_flags;
+    build_ptr->type  = in_type;
+
+    build_ptr->geometries.assign(in_geometries_ptr,
+                                 in_geometries_ptr   + in_n_geometries);
+    build_ptr->ranges.assign    (in_build_ranges_ptr,
+                                 in_build_ranges_ptr + in_n_geometries);
+
+    for (uint32_t n_geometry = 0;
+                  n_geometry < in_n_geometries;
+                ++n_geometry)
+    {
+        max_primitive_counts.at(n_geometry) = in_build_ranges_ptr[n_geometry].primitiveCount;
+    }
+
+    build_info.dstAccelerationStructure  = VK_NULL_HANDLE;
+    build_info.flags                     = in_flags.get_vk();
+    build_info.geometryCount             = in_n_geometries;
+    build_info.mode                      = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+    build_info.pGeometries               = build_ptr->geometries.data();
+    build_info.pNext                     = nullptr;
+    build_info.ppGeometries              = nullptr;
+    build_info.scratchData.deviceAddress = 0;
+    build_info.srcAccelerationStructure  = VK_NULL_HANDLE;
+    build_info.sType                     = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
+    build_info.type                      = static_cast<VkAccelerationStructureTypeKHR>(in_type);
+
+    build_sizes.pNext = nullptr;
+    build_sizes.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR;
+
+    m_device_ptr->get_extension_khr_acceleration_structure_entrypoints().vkGetAccelerationStructureBuildSizesKHR(m_device_ptr->get_device_vk(),
+                                                                                                                 VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR,
+                                                                                                                &build_info,
+                                                                                                                 max_primitive_counts.data(),
+                                                                                                                &build_sizes);
+
+    build_ptr->acceleration_structure_ptr = create_acceleration_structure(in_type,
+                                                                          build_sizes.accelerationStructureSize);
+    build_ptr->scratch_size               = Anvil::Utils::round_up(build_sizes.buildScratchSize,
+                                                                   g_scratch_offset_alignment);
+
+    if (build_ptr->acceleration_structure_ptr == nullptr)
+    {
+        anvil_assert(build_ptr->acceleration_structure_ptr != nullptr);
+
+        goto end;
+    }
+
+    lock();
+    {
+        *out_build_id_ptr = static_cast<BuildID>(m_builds.size() );
+
+        m_builds.push_back(std::move(build_ptr) );
+    }
+    unlock();
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::AccelerationStructureBuilderUniquePtr Anvil::AccelerationStructureBuilder::create(const Anvil::BaseDevice* in_device_ptr,
+                                                                                         Anvil::MemoryAllocator*  in_memory_allocator_ptr,
+                                                                                         VkDeviceSize             in_max_batch_scratch_size,
+                                                                                         bool                     in_mt_safe)
+{
+    Anvil::AccelerationStructureBuilderUniquePtr result_ptr(nullptr,
+                                                            std::default_delete<Anvil::AccelerationStructureBuilder>() );
+
+    anvil_assert(in_device_ptr           != nullptr);
+    anvil_assert(in_memory_allocator_ptr != nullptr);
+
+    result_ptr.reset(
+        new Anvil::AccelerationStructureBuilder(in_device_ptr,
+                                                in_memory_allocator_ptr,
+                                                in_max_batch_scratch_size,
+                                                in_mt_safe)
+    );
+
+    return result_ptr;
+}
+
+/** Creates a new acceleration structure of the specified type and size, backed by memory taken from the builder's
+ *  memory allocator.
+ **/
+Anvil::AccelerationStructureUniquePtr Anvil::AccelerationStructureBuilder::create_acceleration_structure(Anvil::AccelerationStructureType in_type,
+                                                                                                         VkDeviceSize                     in_size) const
+{
+    auto create_info_ptr = Anvil::AccelerationStructureCreateInfo::create(m_device_ptr,
+                                                                          in_type,
+                                                                          in_size,
+                                                                          m_memory_allocator_ptr);
+
+    create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+
+    return Anvil::AccelerationStructure::create(std::move(create_info_ptr) );
+}
+
+/** Makes sure the pooled scratch buffer can hold at least @param in_size bytes. If the current buffer is too small,
+ *  it is retired and replaced with a new one.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::AccelerationStructureBuilder::ensure_scratch_buffer_size(VkDeviceSize in_size)
+{
+    Anvil::QueueFamilyFlags queue_fams = Anvil::QueueFamilyFlagBits::NONE;
+    bool                    result     = false;
+
+    if (m_scratch_buffer_ptr != nullptr    &&
+        m_scratch_buffer_size >= in_size)
+    {
+        result = true;
+
+        goto end;
+    }
+
+    if (m_scratch_buffer_ptr != nullptr)
+    {
+        /* The GPU may still be using the buffer */
+        m_retired_scratch_buffers.push_back(std::move(m_scratch_buffer_ptr) );
+
+        m_scratch_buffer_size = 0;
+        m_scratch_buffer_used = false;
+    }
+
+    if (m_device_ptr->get_n_universal_queues() > 0)
+    {
+        queue_fams |= Anvil::QueueFamilyFlagBits::GRAPHICS_BIT;
+    }
+
+    if (m_device_ptr->get_n_compute_queues() > 0)
+    {
+        queue_fams |= Anvil::QueueFamilyFlagBits::COMPUTE_BIT;
+    }
+
+    {
+        const auto sharing_mode    = Anvil::Utils::is_pow2(queue_fams.get_vk() ) ? Anvil::SharingMode::EXCLUSIVE
+                                                                                 : Anvil::SharingMode::CONCURRENT;
+        auto       create_info_ptr = Anvil::BufferCreateInfo::create_no_alloc(m_device_ptr,
+                                                                              in_size + g_scratch_offset_alignment, /* leave room to align the base address */
+                                                                              queue_fams,
+                                                                              sharing_mode,
+                                                                              Anvil::BufferCreateFlagBits::NONE,
+                                                                              Anvil::BufferUsageFlagBits::SHADER_DEVICE_ADDRESS_BIT_KHR |
+                                                                              Anvil::BufferUsageFlagBits::STORAGE_BUFFER_BIT);
+
+        create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+
+        m_scratch_buffer_ptr = Anvil::Buffer::create(std::move(create_info_ptr) );
+    }
+
+    if (m_scratch_buffer_ptr == nullptr)
+    {
+        anvil_assert(m_scratch_buffer_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (!m_memory_allocator_ptr->add_buffer(m_scratch_buffer_ptr.get(),
+                                            Anvil::MemoryFeatureFlagBits::DEVICE_LOCAL_BIT) )
+    {
+        anvil_assert_fail();
+
+        m_scratch_buffer_ptr.reset();
+        goto end;
+    }
+
+    m_scratch_buffer_size = in_size;
+    result                = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::AccelerationStructure* Anvil::AccelerationStructureBuilder::get_acceleration_structure(BuildID in_build_id) const
+{
+    Anvil::AccelerationStructure* result_ptr = nullptr;
+
+    lock();
+    {
+        if (in_build_id < static_cast<BuildID>(m_builds.size() ) )
+        {
+            result_ptr = m_builds.at(in_build_id)->acceleration_structure_ptr.get();
+        }
+    }
+    unlock();
+
+    return result_ptr;
+}
+
+/** Returns index of a query pool which is not in use and can hold at least @param in_n_queries queries. A new
+ *  pool is created if none of the existing ones qualifies.
+ *
+ *  @return Index of the query pool in m_query_pools if successful, UINT32_MAX otherwise.
+ **/
+uint32_t Anvil::AccelerationStructureBuilder::get_query_pool(uint32_t in_n_queries)
+{
+    Anvil::QueryPoolUniquePtr query_pool_ptr;
+    uint32_t                  result         = UINT32_MAX;
+
+    for (uint32_t n_query_pool = 0;
+                  n_query_pool < static_cast<uint32_t>(m_query_pools.size() );
+                ++n_query_pool)
+    {
+        if (m_query_pools_n_used_queries.at(n_query_pool) == 0                  &&
+            m_query_pools.at               (n_query_pool)->get_capacity() >= in_n_queries)
+        {
+            result = n_query_pool;
+
+            goto end;
+        }
+    }
+
+    query_pool_ptr = Anvil::QueryPool::create_non_ps_query_pool(m_device_ptr,
+                                                                VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR,
+                                                                in_n_queries,
+                                                                Anvil::MTSafety::DISABLED);
+
+    if (query_pool_ptr == nullptr)
+    {
+        anvil_assert(query_pool_ptr != nullptr);
+
+        goto end;
+    }
+
+    result = static_cast<uint32_t>(m_query_pools.size() );
+
+    m_query_pools.push_back               (std::move(query_pool_ptr) );
+    m_query_pools_n_used_queries.push_back(0);
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+VkDeviceSize Anvil::AccelerationStructureBuilder::get_scratch_buffer_size() const
+{
+    VkDeviceSize result;
+
+    lock();
+    {
+        result = m_scratch_buffer_size;
+    }
+    unlock();
+
+    return result;
+}
+
+/** Records a single vkCmdBuildAccelerationStructuresKHR() call for all specified builds. Each build is assigned
+ *  a separate region of the scratch buffer. The caller must make sure the regions fit in the buffer.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::AccelerationStructureBuilder::record_batch(Anvil::CommandBufferBase*  in_cmd_buffer_ptr,
+                                                       const std::vector<Build*>& in_builds)
+{
+    std::vector<VkAccelerationStructureBuildGeometryInfoKHR>     build_infos;
+    std::vector<const VkAccelerationStructureBuildRangeInfoKHR*> build_range_ptrs;
+    VkDeviceAddress                                              scratch_address;
+
+    build_infos.reserve     (in_builds.size() );
+    build_range_ptrs.reserve(in_builds.size() );
+
+    scratch_address = Anvil::Utils::round_up(m_scratch_buffer_ptr->get_device_address(),
+                                             static_cast<VkDeviceAddress>(g_scratch_offset_alignment) );
+
+    for (const auto current_build_ptr : in_builds)
+    {
+        VkAccelerationStructureBuildGeometryInfoKHR build_info;
+
+        build_info.dstAccelerationStructure  = current_build_ptr->acceleration_structure_ptr->get_acceleration_structure();
+        build_info.flags                     = current_build_ptr->flags.get_vk();
+        build_info.geometryCount             = static_cast<uint32_t>(current_build_ptr->geometries.size() );
+        build_info.mode                      = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+        build_info.pGeometries               = current_build_ptr->geometries.data();
+        build_info.pNext                     = nullptr;
+        build_info.ppGeometries              = nullptr;
+        build_info.scratchData.deviceAddress = scratch_address;
+        build_info.srcAccelerationStructure  = VK_NULL_HANDLE;
+        build_info.sType                     = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
+        build_info.type                      = static_cast<VkAccelerationStructureTypeKHR>(current_build_ptr->type);
+
+        build_infos.push_back     (build_info);
+        build_range_ptrs.push_back(current_build_ptr->ranges.data() );
+
+        scratch_address += current_build_ptr->scratch_size;
+    }
+
+    return in_cmd_buffer_ptr->record_build_acceleration_structures_KHR(static_cast<uint32_t>(build_infos.size() ),
+                                                                       build_infos.data(),
+                                                                       build_range_ptrs.data() );
+}
+
+/** Records a barrier which makes acceleration structure build writes visible to the specified stages and access types. */
+bool Anvil::AccelerationStructureBuilder::record_barrier(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                                         Anvil::PipelineStageFlags in_dst_stage_mask,
+                                                         Anvil::AccessFlags        in_dst_access_mask) const
+{
+    const Anvil::MemoryBarrier barrier(in_dst_access_mask,                                           /* in_destination_access_mask */
+                                       Anvil::AccessFlagBits::ACCELERATION_STRUCTURE_WRITE_BIT_KHR); /* in_source_access_mask      */
+
+    return in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                                                      in_dst_stage_mask,
+                                                      Anvil::DependencyFlagBits::NONE,
+                                                      1,       /* in_memory_barrier_count        */
+                                                     &barrier,
+                                                      0,       /* in_buffer_memory_barrier_count */
+                                                      nullptr, /* in_buffer_memory_barrier_ptrs  */
+                                                      0,       /* in_image_memory_barrier_count  */
+                                                      nullptr);
+}
+
+/** Please see header for specification */
+bool Anvil::AccelerationStructureBuilder::record_builds(Anvil::CommandBufferBase* in_cmd_buffer_ptr)
+{
+    const Anvil::AccessFlags                   build_access_mask      = Anvil::AccessFlagBits::ACCELERATION_STRUCTURE_READ_BIT_KHR |
+                                                                        Anvil::AccessFlagBits::ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+    std::vector<Build*>                        batch;
+    VkDeviceSize                               batch_scratch_size     = 0;
+    std::vector<Build*>                        compactable_builds;
+    std::vector<Anvil::AccelerationStructure*> compactable_structures;
+    VkDeviceSize                               max_build_scratch_size = 0;
+    uint32_t                                   n_query_pool           = UINT32_MAX;
+    std::vector<Build*>                        pending_builds;
+    bool                                       result                 = false;
+    VkDeviceSize                               total_scratch_size     = 0;
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    lock();
+    {
+        /* Bottom-level structures must be built before top-level structures, which may reference them */
+        for (const auto current_type : {Anvil::AccelerationStructureType::BOTTOM_LEVEL,
+                                        Anvil::AccelerationStructureType::TOP_LEVEL})
+        {
+            for (const auto& current_build_ptr : m_builds)
+            {
+                if (current_build_ptr->state == BuildState::PENDING &&
+                    current_build_ptr->type  == current_type)
+                {
+                    pending_builds.push_back(current_build_ptr.get() );
+                }
+            }
+        }
+
+        if (pending_builds.size() == 0)
+        {
+            result = true;
+
+            goto end;
+        }
+
+        /* Size the scratch buffer, so that it can hold the largest build, and as many others as the budget permits */
+        for (const auto current_build_ptr : pending_builds)
+        {
+            max_build_scratch_size  = std::max(max_build_scratch_size,
+                                               current_build_ptr->scratch_size);
+            total_scratch_size     += current_build_ptr->scratch_size;
+        }
+
+        if (!ensure_scratch_buffer_size(std::max(max_build_scratch_size,
+                                                 std::min(total_scratch_size,
+                                                          m_max_batch_scratch_size) )) )
+        {
+            goto end;
+        }
+
+        /* Builds recorded by a previous call may still be using the scratch buffer */
+        if (m_scratch_buffer_used)
+        {
+            if (!record_barrier(in_cmd_buffer_ptr,
+                                Anvil::PipelineStageFlagBits::ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                                build_access_mask) )
+            {
+                goto end;
+            }
+        }
+
+        /* Pack the builds into batches. A new batch is started whenever the scratch buffer runs out of space,
+         * or when switching from bottom-level to top-level builds. */
+        for (const auto current_build_ptr : pending_builds)
+        {
+            if (batch.size() > 0                                                            &&
+               (batch_scratch_size + current_build_ptr->scratch_size > m_scratch_buffer_size ||
+                batch.back()->type                                   != current_build_ptr->type) )
+            {
+                if (!record_batch(in_cmd_buffer_ptr,
+                                  batch) )
+                {
+                    goto end;
+                }
+
+                if (!record_barrier(in_cmd_buffer_ptr,
+                                    Anvil::PipelineStageFlagBits::ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                                    build_access_mask) )
+                {
+                    goto end;
+                }
+
+                batch.clear();
+
+                batch_scratch_size = 0;
+            }
+
+            batch.push_back(current_build_ptr);
+
+            batch_scratch_size += current_build_ptr->scratch_size;
+        }
+
+        if (!record_batch(in_cmd_buffer_ptr,
+                          batch) )
+        {
+            goto end;
+        }
+
+        m_scratch_buffer_used = true;
+
+        /* Make the results visible to all subsequent commands, including the compacted size queries below */
+        if (!record_barrier(in_cmd_buffer_ptr,
+                            Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT,
+                            Anvil::AccessFlagBits::ACCELERATION_STRUCTURE_READ_BIT_KHR) )
+        {
+            goto end;
+        }
+
+        for (const auto current_build_ptr : pending_builds)
+        {
+            if ((current_build_ptr->flags & Anvil::BuildAccelerationStructureFlagBits::ALLOW_COMPACTION_BIT) != 0)
+            {
+                compactable_builds.push_back    (current_build_ptr);
+                compactable_structures.push_back(current_build_ptr->acceleration_structure_ptr.get() );
+            }
+            else
+            {
+                current_build_ptr->state = BuildState::BUILT;
+            }
+        }
+
+        if (compactable_builds.size() > 0)
+        {
+            const uint32_t n_compactable_builds = static_cast<uint32_t>(compactable_builds.size() );
+
+            n_query_pool = get_query_pool(n_compactable_builds);
+
+            if (n_query_pool == UINT32_MAX)
+            {
+                goto end;
+            }
+
+            if (!in_cmd_buffer_ptr->record_reset_query_pool                            (m_query_pools.at(n_query_pool).get(),
+                                                                                        0, /* in_start_query */
+                                                                                        n_compactable_builds) ||
+                !in_cmd_buffer_ptr->record_write_acceleration_structures_properties_KHR(n_compactable_builds,
+                                                                                        compactable_structures.data(),
+                                                                                        VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR,
+                                                                                        m_query_pools.at(n_query_pool).get(),
+                                                                                        0) ) /* in_first_query */
+            {
+                goto end;
+            }
+
+            for (uint32_t n_build = 0;
+                          n_build < n_compactable_builds;
+                        ++n_build)
+            {
+                compactable_builds.at(n_build)->n_query_pool = n_query_pool;
+                compactable_builds.at(n_build)->query_index  = n_build;
+                compactable_builds.at(n_build)->state        = BuildState::COMPACTION_PENDING;
+            }
+
+            m_query_pools_n_used_queries.at(n_query_pool) = n_compactable_builds;
+        }
+
+        result = true;
+    }
+end:
+    unlock();
+
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::AccelerationStructureBuilder::record_compaction(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                                            VkDeviceSize*             out_opt_n_bytes_saved_ptr)
+{
+    std::vector<uint64_t> compacted_sizes;
+    bool                  has_recorded_copies = false;
+    VkDeviceSize          n_bytes_saved       = 0;
+    bool                  result              = false;
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    lock();
+    {
+        for (uint32_t n_query_pool = 0;
+                      n_query_pool < static_cast<uint32_t>(m_query_pools.size() );
+                    ++n_query_pool)
+        {
+            bool           all_results_retrieved = false;
+            const uint32_t n_used_queries        = m_query_pools_n_used_queries.at(n_query_pool);
+
+            if (n_used_queries == 0)
+            {
+                continue;
+            }
+
+            compacted_sizes.resize(n_used_queries);
+
+            if (!m_query_pools.at(n_query_pool)->get_query_pool_results(0, /* in_first_query_index */
+                                                                        n_used_queries,
+                                                                        Anvil::QueryResultFlagBits::_64_BIT | Anvil::QueryResultFlagBits::WAIT_BIT,
+                                                                        compacted_sizes.data(),
+                                                                       &all_results_retrieved) ||
+                !all_results_retrieved)
+            {
+                anvil_assert_fail();
+
+                goto end;
+            }
+
+            for (auto& current_build_ptr : m_builds)
+            {
+                Anvil::AccelerationStructureUniquePtr compacted_structure_ptr;
+                VkDeviceSize                          compacted_size;
+                VkDeviceSize                          original_size;
+
+                if (current_build_ptr->state        != BuildState::COMPACTION_PENDING ||
+                    current_build_ptr->n_query_pool != n_query_pool)
+                {
+                    continue;
+                }
+
+                compacted_size = static_cast<VkDeviceSize>(compacted_sizes.at(current_build_ptr->query_index) );
+                original_size  = current_build_ptr->acceleration_structure_ptr->get_create_info_ptr()->get_size();
+
+                current_build_ptr->n_query_pool = UINT32_MAX;
+                current_build_ptr->query_index  = UINT32_MAX;
+                current_build_ptr->state        = BuildState::BUILT;
+
+                if (compacted_size == 0              ||
+                    compacted_size >= original_size)
+                {
+                    continue;
+                }
+
+                compacted_structure_ptr = create_acceleration_structure(current_build_ptr->type,
+                                                                        compacted_size);
+
+                if (compacted_structure_ptr == nullptr)
+                {
+                    anvil_assert(compacted_structure_ptr != nullptr);
+
+                    goto end;
+                }
+
+                if (!in_cmd_buffer_ptr->record_copy_acceleration_structure_KHR(current_build_ptr->acceleration_structure_ptr.get(),
+                                                                               compacted_structure_ptr.get(),
+                                                                               VK_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR) )
+                {
+                    goto end;
+                }
+
+                /* The copy reads from the original structure, so it can only be released after the GPU is done */
+                m_retired_acceleration_structures.push_back(std::move(current_build_ptr->acceleration_structure_ptr) );
+
+                current_build_ptr->acceleration_structure_ptr = std::move(compacted_structure_ptr);
+                has_recorded_copies                           = true;
+                n_bytes_saved                                += original_size - compacted_size;
+            }
+
+            m_query_pools_n_used_queries.at(n_query_pool) = 0;
+        }
+
+        if (has_recorded_copies)
+        {
+            if (!record_barrier(in_cmd_buffer_ptr,
+                                Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT,
+                                Anvil::AccessFlagBits::ACCELERATION_STRUCTURE_READ_BIT_KHR) )
+            {
+                goto end;
+            }
+        }
+
+        if (out_opt_n_bytes_saved_ptr != nullptr)
+        {
+            *out_opt_n_bytes_saved_ptr = n_bytes_saved;
+        }
+
+        result = true;
+    }
+end:
+    unlock();
+
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::AccelerationStructureUniquePtr Anvil::AccelerationStructureBuilder::release_acceleration_structure(BuildID in_build_id)
+{
+    Anvil::AccelerationStructureUniquePtr result_ptr(nullptr,
+                                                     std::default_delete<Anvil::AccelerationStructure>() );
+
+    lock();
+    {
+        if (in_build_id >= static_cast<BuildID>(m_builds.size() ) )
+        {
+            anvil_assert(in_build_id < static_cast<BuildID>(m_builds.size() ));
+
+            goto end;
+        }
+
+        if (m_builds.at(in_build_id)->state != BuildState::BUILT)
+        {
+            anvil_assert(m_builds.at(in_build_id)->state == BuildState::BUILT);
+
+            goto end;
+        }
+
+        result_ptr = std::move(m_builds.at(in_build_id)->acceleration_structure_ptr);
+
+        m_builds.at(in_build_id)->geometries.clear();
+        m_builds.at(in_build_id)->ranges.clear    ();
+
+        m_builds.at(in_build_id)->state = BuildState::RELEASED;
+    }
+end:
+    unlock();
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+void Anvil::AccelerationStructureBuilder::release_retired_resources()
+{
+    lock();
+    {
+        m_retired_acceleration_structures.clear();
+        m_retired_scratch_buffers.clear        ();
+    }
+    unlock();
+}
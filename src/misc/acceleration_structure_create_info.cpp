@@ -0,0 +1,56 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/acceleration_structure_create_info.h"
+
+Anvil::AccelerationStructureCreateInfoUniquePtr Anvil::AccelerationStructureCreateInfo::create(const Anvil::BaseDevice*         in_device_ptr,
+                                                                                               Anvil::AccelerationStructureType in_type,
+                                                                                               VkDeviceSize                     in_size,
+                                                                                               Anvil::MemoryAllocator*          in_memory_allocator_ptr)
+{
+    Anvil::AccelerationStructureCreateInfoUniquePtr result_ptr(nullptr,
+                                                               std::default_delete<Anvil::AccelerationStructureCreateInfo>() );
+
+    result_ptr.reset(
+        new Anvil::AccelerationStructureCreateInfo(in_device_ptr,
+                                                   in_type,
+                                                   in_size,
+                                                   in_memory_allocator_ptr,
+                                                   Anvil::MTSafety::INHERIT_FROM_PARENT_DEVICE)
+    );
+
+    return result_ptr;
+}
+
+Anvil::AccelerationStructureCreateInfo::AccelerationStructureCreateInfo(const Anvil::BaseDevice*         in_device_ptr,
+                                                                        Anvil::AccelerationStructureType in_type,
+                                                                        VkDeviceSize                     in_size,
+                                                                        Anvil::MemoryAllocator*          in_memory_allocator_ptr,
+                                                                        MTSafety                         in_mt_safety)
+    :m_device_ptr          (in_device_ptr),
+     m_memory_allocator_ptr(in_memory_allocator_ptr),
+     m_mt_safety           (in_mt_safety),
+     m_size                (in_size),
+     m_type                (in_type)
+{
+    /* Stub */
+}
@@ -0,0 +1,223 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#include "misc/async_file_reader.h"
+#include "misc/debug.h"
+#include "misc/io.h"
+#include <algorithm>
+
+
+/** Please see header for specification */
+Anvil::AsyncFileReader::AsyncFileReader(uint32_t in_n_threads)
+    :m_n_busy_threads(0),
+     m_should_quit   (false)
+{
+    m_threads.reserve(in_n_threads);
+
+    for (uint32_t n_thread = 0;
+                  n_thread < in_n_threads;
+                ++n_thread)
+    {
+        m_threads.push_back(
+            std::thread(&Anvil::AsyncFileReader::thread_main,
+                        this)
+        );
+    }
+}
+
+/** Please see header for specification */
+Anvil::AsyncFileReader::~AsyncFileReader()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_should_quit = true;
+
+        m_wake_cv.notify_all();
+    }
+
+    for (auto& current_thread : m_threads)
+    {
+        if (current_thread.joinable() )
+        {
+            current_thread.join();
+        }
+    }
+}
+
+/** Please see header for specification */
+Anvil::AsyncFileReaderUniquePtr Anvil::AsyncFileReader::create(uint32_t in_n_threads)
+{
+    Anvil::AsyncFileReaderUniquePtr result_ptr(nullptr,
+                                               std::default_delete<Anvil::AsyncFileReader>() );
+    uint32_t                        n_threads = in_n_threads;
+
+    if (n_threads == 0)
+    {
+        /* I/O-bound work does not scale with the number of cores, so do not spawn more threads than needed to keep
+         * a few requests in flight. */
+        n_threads = std::min(std::max(std::thread::hardware_concurrency(), 1u),
+                             4u);
+    }
+
+    result_ptr.reset(
+        new Anvil::AsyncFileReader(n_threads)
+    );
+
+    return result_ptr;
+}
+
+/** Appends a request to the queue and wakes up an idle I/O thread.
+ *
+ *  @param in_request Function to call from the I/O thread.
+ */
+void Anvil::AsyncFileReader::enqueue(std::function<void()> in_request)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    anvil_assert(!m_should_quit);
+
+    m_requests.push_back(std::move(in_request) );
+
+    m_wake_cv.notify_one();
+}
+
+/** Please see header for specification */
+std::future<Anvil::MappedFileUniquePtr> Anvil::AsyncFileReader::map_file(const std::string& in_filename,
+                                                                         bool               in_should_prefetch)
+{
+    /* std::function requires copyable callables, so the task needs to be wrapped */
+    auto task_ptr = std::make_shared<std::packaged_task<Anvil::MappedFileUniquePtr()> >(
+        [=]()
+        {
+            auto result_ptr = Anvil::MappedFile::create(in_filename);
+
+            if (result_ptr != nullptr &&
+                in_should_prefetch)
+            {
+                result_ptr->prefetch();
+            }
+
+            return result_ptr;
+        }
+    );
+
+    auto result = task_ptr->get_future();
+
+    enqueue(
+        [task_ptr]()
+        {
+            (*task_ptr)();
+        }
+    );
+
+    return result;
+}
+
+/** Please see header for specification */
+std::future<Anvil::AsyncFileReader::ReadResult> Anvil::AsyncFileReader::read_file(const std::string& in_filename,
+                                                                                  bool               in_is_text_file)
+{
+    auto task_ptr = std::make_shared<std::packaged_task<ReadResult()> >(
+        [=]()
+        {
+            char*      data_ptr = nullptr;
+            ReadResult result;
+
+            if (Anvil::IO::read_file(in_filename,
+                                     in_is_text_file,
+                                    &data_ptr,
+                                    &result.size) )
+            {
+                result.data_ptr.reset(data_ptr);
+            }
+            else
+            {
+                result.size = 0;
+            }
+
+            return result;
+        }
+    );
+
+    auto result = task_ptr->get_future();
+
+    enqueue(
+        [task_ptr]()
+        {
+            (*task_ptr)();
+        }
+    );
+
+    return result;
+}
+
+/** Entry-point for the I/O threads. Serves requests until the reader is released and the queue is drained. */
+void Anvil::AsyncFileReader::thread_main()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true)
+    {
+        std::function<void()> request;
+
+        if (m_requests.empty() )
+        {
+            if (m_should_quit)
+            {
+                break;
+            }
+
+            m_wake_cv.wait(lock);
+
+            continue;
+        }
+
+        request = std::move(m_requests.front() );
+
+        m_requests.pop_front();
+        m_n_busy_threads++;
+
+        lock.unlock();
+        {
+            request();
+        }
+        lock.lock();
+
+        if (--m_n_busy_threads == 0 &&
+            m_requests.empty   () )
+        {
+            m_idle_cv.notify_all();
+        }
+    }
+}
+
+/** Please see header for specification */
+void Anvil::AsyncFileReader::wait_idle()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (m_n_busy_threads != 0 ||
+          !m_requests.empty() )
+    {
+        m_idle_cv.wait(lock);
+    }
+}
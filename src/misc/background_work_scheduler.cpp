@@ -0,0 +1,230 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "misc/background_work_scheduler.h"
+#include "misc/debug.h"
+#include <algorithm>
+
+
+/** Please see header for specification */
+Anvil::BackgroundWorkScheduler::BackgroundWorkScheduler()
+    :m_active_task_id          (0),
+     m_is_active_task_cancelled(false),
+     m_n_current_run           (0),
+     m_next_task_id            (1)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::BackgroundWorkScheduler::~BackgroundWorkScheduler()
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+uint64_t Anvil::BackgroundWorkScheduler::add_task(const MicroTask&   in_task,
+                                                  const std::string& in_name)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    Task                         new_task;
+
+    anvil_assert(in_task != nullptr);
+
+    new_task.id   = m_next_task_id++;
+    new_task.name = in_name;
+    new_task.task = in_task;
+
+    m_tasks.push_back(std::move(new_task) );
+
+    return m_tasks.back().id;
+}
+
+/** Please see header for specification */
+bool Anvil::BackgroundWorkScheduler::cancel(const uint64_t& in_task_id)
+{
+    std::unique_lock<std::mutex> lock  (m_mutex);
+    bool                         result(false);
+
+    if (in_task_id == 0)
+    {
+        goto end;
+    }
+
+    if (m_active_task_id == in_task_id)
+    {
+        result                     = !m_is_active_task_cancelled;
+        m_is_active_task_cancelled = true;
+
+        goto end;
+    }
+
+    for (auto task_iterator  = m_tasks.begin();
+              task_iterator != m_tasks.end();
+            ++task_iterator)
+    {
+        if (task_iterator->id == in_task_id)
+        {
+            m_tasks.erase(task_iterator);
+
+            result = true;
+            break;
+        }
+    }
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::BackgroundWorkSchedulerUniquePtr Anvil::BackgroundWorkScheduler::create()
+{
+    Anvil::BackgroundWorkSchedulerUniquePtr result_ptr(nullptr,
+                                                       std::default_delete<Anvil::BackgroundWorkScheduler>() );
+
+    result_ptr.reset(
+        new Anvil::BackgroundWorkScheduler()
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::BackgroundWorkScheduler::get_n_pending_tasks() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    return static_cast<uint32_t>(m_tasks.size() ) + ((m_active_task_id != 0) ? 1 : 0);
+}
+
+/** Please see header for specification */
+std::vector<std::string> Anvil::BackgroundWorkScheduler::get_pending_task_names() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    std::vector<std::string>     result;
+
+    result.reserve(m_tasks.size() );
+
+    for (const auto& current_task : m_tasks)
+    {
+        result.push_back(current_task.name);
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::BackgroundWorkScheduler::run(const uint64_t&              in_budget_usec,
+                                         Anvil::BackgroundWorkReport* out_opt_report_ptr)
+{
+    const uint64_t              budget_nsec     = in_budget_usec * 1000;
+    Anvil::BackgroundWorkReport report;
+    const uint64_t              start_time_nsec = m_time.get_time_in_nsec();
+
+    anvil_assert(m_active_task_id == 0);
+
+    ++m_n_current_run;
+
+    while (in_budget_usec > 0)
+    {
+        const uint64_t elapsed_nsec = m_time.get_time_in_nsec() - start_time_nsec;
+        bool           has_more_work;
+        Task           task;
+
+        if (elapsed_nsec >= budget_nsec)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            report.budget_exhausted = !m_tasks.empty();
+
+            break;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            if (m_tasks.empty() )
+            {
+                break;
+            }
+
+            task = std::move(m_tasks.front() );
+
+            m_tasks.pop_front();
+
+            m_active_task_id           = task.id;
+            m_is_active_task_cancelled = false;
+        }
+
+        /* Step the task with the lock released, so that it can register follow-up tasks. */
+        has_more_work = task.task(budget_nsec - elapsed_nsec);
+
+        report.n_steps_executed++;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            if (!has_more_work)
+            {
+                report.n_tasks_completed++;
+            }
+            else
+            if (!m_is_active_task_cancelled)
+            {
+                task.n_last_stepped_run = m_n_current_run;
+                task.n_runs_deferred    = 0;
+
+                m_tasks.push_back(std::move(task) );
+            }
+
+            m_active_task_id = 0;
+        }
+    }
+
+    report.time_spent_nsec = m_time.get_time_in_nsec() - start_time_nsec;
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        /* Update the backlog. Tasks which were not stepped during this call have been deferred once more. */
+        for (auto& current_task : m_tasks)
+        {
+            if (current_task.n_last_stepped_run != m_n_current_run)
+            {
+                current_task.n_runs_deferred++;
+
+                report.n_tasks_deferred++;
+            }
+
+            report.n_max_runs_deferred = std::max(report.n_max_runs_deferred,
+                                                  current_task.n_runs_deferred);
+        }
+
+        report.n_pending_tasks = static_cast<uint32_t>(m_tasks.size() );
+    }
+
+    if (out_opt_report_ptr != nullptr)
+    {
+        *out_opt_report_ptr = report;
+    }
+}
@@ -225,6 +225,26 @@ void Anvil::BasePipelineCreateInfo::init_shader_modules(uint32_t
     }
 }
 
+bool Anvil::BasePipelineCreateInfo::replace_shader_module(const Anvil::ShaderModule* in_old_shader_module_ptr,
+                                                          Anvil::ShaderModule*       in_new_shader_module_ptr)
+{
+    bool result = false;
+
+    anvil_assert(in_new_shader_module_ptr != nullptr);
+
+    for (auto& current_shader_stage : m_shader_stages)
+    {
+        if (current_shader_stage.second.shader_module_ptr == in_old_shader_module_ptr)
+        {
+            current_shader_stage.second.shader_module_ptr = in_new_shader_module_ptr;
+
+            result = true;
+        }
+    }
+
+    return result;
+}
+
 void Anvil::BasePipelineCreateInfo::set_descriptor_set_create_info(const std::vector<const Anvil::DescriptorSetCreateInfo*>* in_ds_create_info_vec_ptr)
 {
     const uint32_t n_descriptor_sets = static_cast<uint32_t>(in_ds_create_info_vec_ptr->size() );
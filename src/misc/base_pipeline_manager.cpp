@@ -23,27 +23,80 @@
 #include "misc/base_pipeline_create_info.h"
 #include "misc/base_pipeline_manager.h"
 #include "misc/debug.h"
+#include "misc/task_scheduler.h"
 #include "wrappers/descriptor_set_group.h"
 #include "wrappers/device.h"
 #include "wrappers/pipeline_layout.h"
 #include "wrappers/pipeline_layout_manager.h"
 #include "wrappers/pipeline_cache.h"
 #include <algorithm>
+#include <thread>
 
-/** Please see header for specification */
+/** Converts a feedback struct written by the driver to its Anvil equivalent. */
+static Anvil::BasePipelineManager::CreationFeedback get_creation_feedback(const VkPipelineCreationFeedbackEXT& in_feedback_vk)
+{
+    Anvil::BasePipelineManager::CreationFeedback result;
+
+    result.duration_nsec                     = in_feedback_vk.duration;
+    result.is_application_pipeline_cache_hit = (in_feedback_vk.flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT_EXT) != 0;
+    result.is_base_pipeline_acceleration     = (in_feedback_vk.flags & VK_PIPELINE_CREATION_FEEDBACK_BASE_PIPELINE_ACCELERATION_BIT_EXT)     != 0;
+    result.is_valid                          = (in_feedback_vk.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT_EXT)                          != 0;
+
+    return result;
+}
+
+/** Tells whether any of the shader stages of the specified pipeline uses the specified shader module. */
+static bool is_shader_module_used(const Anvil::BasePipelineCreateInfo* in_pipeline_create_info_ptr,
+                                  const Anvil::ShaderModule*           in_shader_module_ptr)
+{
+    bool result = false;
+
+    for (uint32_t n_shader_stage = static_cast<uint32_t>(Anvil::ShaderStage::FIRST);
+                  n_shader_stage < static_cast<uint32_t>(Anvil::ShaderStage::COUNT) && !result;
+                ++n_shader_stage)
+    {
+        const Anvil::ShaderModuleStageEntryPoint* entrypoint_ptr = nullptr;
+
+        if (in_pipeline_create_info_ptr->get_shader_stage_properties(static_cast<Anvil::ShaderStage>(n_shader_stage),
+                                                                    &entrypoint_ptr) )
+        {
+            result = (entrypoint_ptr->shader_module_ptr == in_shader_module_ptr);
+        }
+    }
+
+    return result;
+}
+
+/** Please see header for specification.
+ *
+ *  The lock is recursive: get_pipeline() bakes outstanding pipelines and resolves fallback pipelines from within
+ *  its locked section, and bake() calls into the derived managers' bake_pipelines(), which lock again.
+ **/
 Anvil::BasePipelineManager::BasePipelineManager(const Anvil::BaseDevice* in_device_ptr,
                                                 bool                     in_mt_safe,
                                                 bool                     in_use_pipeline_cache,
                                                 Anvil::PipelineCache*    in_pipeline_cache_to_reuse_ptr)
-    :CallbacksSupportProvider(BASE_PIPELINE_MANAGER_CALLBACK_ID_COUNT),
-     MTSafetySupportProvider (in_mt_safe),
-     m_device_ptr            (in_device_ptr),
-     m_pipeline_cache_ptr    (nullptr),
-     m_pipeline_counter      (0)
+    :CallbacksSupportProvider     (BASE_PIPELINE_MANAGER_CALLBACK_ID_COUNT),
+     MTSafetySupportProvider      (in_mt_safe,
+                                   true), /* in_is_lock_recursive */
+     m_device_ptr                 (in_device_ptr),
+     m_n_bake_threads             (1),
+     m_pipeline_cache_ptr         (nullptr),
+     m_pipeline_counter           (0),
+     m_compiler_thread_should_quit(false),
+     m_is_async_compilation_enabled(false),
+     m_is_usage_profiling_enabled (false),
+     m_usage_profiling_frame      (0),
+     m_specialization_info_arena_block_offset(SPECIALIZATION_INFO_ARENA_BLOCK_SIZE)
 {
     anvil_assert((!in_use_pipeline_cache && in_pipeline_cache_to_reuse_ptr == nullptr) ||
                    in_use_pipeline_cache);
 
+    for (auto& current_chunk : m_pipeline_slot_chunks)
+    {
+        current_chunk.store(nullptr);
+    }
+
     m_pipeline_layout_manager_ptr = in_device_ptr->get_pipeline_layout_manager();
     anvil_assert(m_pipeline_layout_manager_ptr != nullptr);
 
@@ -71,7 +124,27 @@ Anvil::BasePipelineManager::BasePipelineManager(const Anvil::BaseDevice* in_devi
 /** Please see header for specification */
 Anvil::BasePipelineManager::~BasePipelineManager()
 {
+    /* Derived classes must disable async compilation before releasing their pipelines */
+    anvil_assert(!m_is_async_compilation_enabled);
     anvil_assert(m_baked_pipelines.size() == 0);
+
+    /* Previous objects of pipelines which have been re-queued, but never re-baked, are no longer needed either */
+    for (const auto& current_previous_handle : m_rebuilt_pipeline_previous_handles)
+    {
+        m_retired_pipelines.push_back(current_previous_handle.second);
+    }
+
+    m_rebuilt_pipeline_previous_handles.clear();
+
+    release_retired_pipelines();
+
+    for (auto& current_chunk : m_pipeline_slot_chunks)
+    {
+        delete [] current_chunk.load();
+    }
+
+    m_specialization_info_cache.clear       ();
+    m_specialization_info_arena_blocks.clear();
 }
 
 
@@ -86,9 +159,9 @@ void Anvil::BasePipelineManager::Pipeline::release_pipeline()
         device_ptr->get_pipeline_cache()->lock();
         lock();
         {
-            Anvil::Vulkan::vkDestroyPipeline(device_ptr->get_device_vk(),
-                                             baked_pipeline,
-                                             nullptr /* pAllocator */);
+            device_ptr->get_dispatch_table().vkDestroyPipeline(device_ptr->get_device_vk(),
+                                                               baked_pipeline,
+                                                               device_ptr->get_allocation_callbacks_vk() );
         }
         unlock();
         device_ptr->get_pipeline_cache()->unlock();
@@ -100,40 +173,32 @@ void Anvil::BasePipelineManager::Pipeline::release_pipeline()
 
 /* Please see header for specification */
 bool Anvil::BasePipelineManager::add_pipeline(Anvil::BasePipelineCreateInfoUniquePtr in_pipeline_create_info_ptr,
-                                              PipelineID*                            out_pipeline_id_ptr)
+                                              PipelineID*                            out_pipeline_id_ptr,
+                                              PipelineID                             in_opt_fallback_pipeline_id)
 {
-    const Anvil::PipelineID                base_pipeline_id = in_pipeline_create_info_ptr->get_base_pipeline_id();
-    auto                                   callback_arg     = Anvil::OnNewPipelineCreatedCallbackData(UINT32_MAX);
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr        = get_mutex();
-    PipelineID                             new_pipeline_id  = 0;
-    std::unique_ptr<Pipeline>              new_pipeline_ptr;
-    bool                                   result           = false;
+    const Anvil::PipelineID                    base_pipeline_id = in_pipeline_create_info_ptr->get_base_pipeline_id();
+    auto                                       callback_arg     = Anvil::OnNewPipelineCreatedCallbackData(UINT32_MAX);
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr        = get_mutex();
+    PipelineID                                 new_pipeline_id  = 0;
+    std::unique_ptr<Pipeline>                  new_pipeline_ptr;
+    bool                                       result           = false;
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
         );
     }
 
     if (base_pipeline_id != UINT32_MAX)
     {
         Anvil::BasePipelineCreateInfo* base_pipeline_create_info_ptr = nullptr;
-        auto                           base_pipeline_iterator        = m_baked_pipelines.find(base_pipeline_id);
+        const Pipeline*                base_pipeline_ptr             = find_pipeline(base_pipeline_id);
 
-        if (base_pipeline_iterator == m_baked_pipelines.end() )
+        if (base_pipeline_ptr != nullptr)
         {
-            base_pipeline_iterator = m_outstanding_pipelines.find(base_pipeline_id);
-
-            if (base_pipeline_iterator != m_outstanding_pipelines.end() )
-            {
-                base_pipeline_create_info_ptr = base_pipeline_iterator->second->pipeline_create_info_ptr.get();
-            }
-        }
-        else
-        {
-            base_pipeline_create_info_ptr = base_pipeline_iterator->second->pipeline_create_info_ptr.get();
+            base_pipeline_create_info_ptr = base_pipeline_ptr->pipeline_create_info_ptr.get();
         }
 
         if (base_pipeline_create_info_ptr != nullptr)
@@ -165,6 +230,18 @@ bool Anvil::BasePipelineManager::add_pipeline(Anvil::BasePipelineCreateInfoUniqu
         m_baked_pipelines[new_pipeline_id] = std::move(new_pipeline_ptr);
     }
     else
+    if (is_async_compilation_enabled() )
+    {
+        m_async_pipelines[new_pipeline_id] = std::move(new_pipeline_ptr);
+
+        if (in_opt_fallback_pipeline_id != UINT32_MAX)
+        {
+            m_fallback_pipeline_ids[new_pipeline_id] = in_opt_fallback_pipeline_id;
+        }
+
+        m_compiler_thread_cv.notify_all();
+    }
+    else
     {
         m_outstanding_pipelines[new_pipeline_id] = std::move(new_pipeline_ptr);
     }
@@ -183,308 +260,1239 @@ end:
     return result;
 }
 
-/* Please see header for specification */
-void Anvil::BasePipelineManager::bake_specialization_info_vk(const SpecializationConstants&         in_specialization_constants,
-                                                             const unsigned char*                   in_specialization_constant_data_ptr,
-                                                             std::vector<VkSpecializationMapEntry>* out_specialization_map_entry_vk_vector_ptr,
-                                                             VkSpecializationInfo*                  out_specialization_info_ptr) const
+/** Carves a region out of the specialization info arena. The region stays valid until the manager is released.
+ *
+ *  A new block is allocated if the current one cannot hold @param in_n_bytes bytes. Requests larger than the
+ *  block size are served with a dedicated block, which also retires the current one.
+ *
+ *  @param in_n_bytes Number of bytes to allocate.
+ *
+ *  @return Ptr to the region, aligned to 8 bytes.
+ **/
+void* Anvil::BasePipelineManager::alloc_specialization_info_arena_memory(uint32_t in_n_bytes) const
 {
-    uint32_t n_specialization_constant_bytes = 0;
-    uint32_t n_specialization_constants      = 0;
-
-    /* Prepare specialization info descriptor */
-    n_specialization_constants = static_cast<uint32_t>(in_specialization_constants.size() );
+    const uint32_t n_bytes_aligned = (in_n_bytes + 7) & ~7u;
+    void*          result_ptr      = nullptr;
 
-    out_specialization_map_entry_vk_vector_ptr->clear  ();
-    out_specialization_map_entry_vk_vector_ptr->reserve(n_specialization_constants);
-
-    for (uint32_t n_specialization_constant = 0;
-                  n_specialization_constant < n_specialization_constants;
-                ++n_specialization_constant)
+    if (n_bytes_aligned > SPECIALIZATION_INFO_ARENA_BLOCK_SIZE)
     {
-        const SpecializationConstant& current_specialization_constant = in_specialization_constants[n_specialization_constant];
-        VkSpecializationMapEntry      new_entry;
+        m_specialization_info_arena_blocks.push_back(
+            std::unique_ptr<unsigned char[]>(new unsigned char[n_bytes_aligned])
+        );
 
-        new_entry.constantID = current_specialization_constant.constant_id;
-        new_entry.offset     = current_specialization_constant.start_offset;
-        new_entry.size       = current_specialization_constant.n_bytes;
+        result_ptr                               = m_specialization_info_arena_blocks.back().get();
+        m_specialization_info_arena_block_offset = SPECIALIZATION_INFO_ARENA_BLOCK_SIZE;
 
-        n_specialization_constant_bytes += current_specialization_constant.n_bytes;
+        goto end;
+    }
+
+    if (m_specialization_info_arena_block_offset + n_bytes_aligned > SPECIALIZATION_INFO_ARENA_BLOCK_SIZE)
+    {
+        m_specialization_info_arena_blocks.push_back(
+            std::unique_ptr<unsigned char[]>(new unsigned char[SPECIALIZATION_INFO_ARENA_BLOCK_SIZE])
+        );
 
-        out_specialization_map_entry_vk_vector_ptr->push_back(new_entry);
+        m_specialization_info_arena_block_offset = 0;
     }
 
-    out_specialization_info_ptr->dataSize      = n_specialization_constant_bytes;
-    out_specialization_info_ptr->mapEntryCount = n_specialization_constants;
-    out_specialization_info_ptr->pData         = (n_specialization_constants > 0) ? in_specialization_constant_data_ptr
-                                                                                  : nullptr;
-    out_specialization_info_ptr->pMapEntries   = (n_specialization_constants > 0) ? &(*out_specialization_map_entry_vk_vector_ptr).at(0)
-                                                                                  : nullptr;
+    result_ptr                                = m_specialization_info_arena_blocks.back().get() + m_specialization_info_arena_block_offset;
+    m_specialization_info_arena_block_offset += n_bytes_aligned;
+
+end:
+    return result_ptr;
 }
 
 /* Please see header for specification */
-bool Anvil::BasePipelineManager::delete_pipeline(PipelineID in_pipeline_id)
+bool Anvil::BasePipelineManager::bake()
 {
-    bool result = false;
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr    = get_mutex();
+    std::vector<PipelineID>                    pipeline_ids;
+    bool                                       result       = false;
 
+    if (mutex_ptr != nullptr)
     {
-        std::unique_lock<std::recursive_mutex> mutex_lock;
-        auto                                   mutex_ptr         = get_mutex();
-        Pipelines::iterator                    pipeline_iterator;
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
 
-        if (mutex_ptr != nullptr)
-        {
-            mutex_lock = std::move(
-                std::unique_lock<std::recursive_mutex>(*mutex_ptr)
-            );
-        }
+    for (const auto& current_pipeline : m_outstanding_pipelines)
+    {
+        pipeline_ids.push_back(current_pipeline.first);
+    }
 
-        pipeline_iterator = m_baked_pipelines.find(in_pipeline_id);
+    result = bake_pipelines(&m_outstanding_pipelines);
 
-        if (pipeline_iterator != m_baked_pipelines.end() )
-        {
-            m_baked_pipelines.erase(pipeline_iterator);
-        }
-        else
+    if (result)
+    {
+        for (const auto& current_pipeline_id : pipeline_ids)
         {
-            pipeline_iterator = m_outstanding_pipelines.find(in_pipeline_id);
-
-            if (pipeline_iterator == m_outstanding_pipelines.end() )
-            {
-                goto end;
-            }
+            publish_pipeline(current_pipeline_id,
+                             m_baked_pipelines.at(current_pipeline_id).get() );
 
-            m_outstanding_pipelines.erase(pipeline_iterator);
+            retire_previous_pipeline(current_pipeline_id);
         }
     }
+    else
+    {
+        restore_rebuilt_pipelines(&m_outstanding_pipelines);
+    }
 
-    /* All done */
-    result = true;
-end:
     return result;
 }
 
 /* Please see header for specification */
-VkPipeline Anvil::BasePipelineManager::get_pipeline(PipelineID in_pipeline_id)
+const VkSpecializationInfo* Anvil::BasePipelineManager::bake_specialization_info_vk(const SpecializationConstants& in_specialization_constants,
+                                                                                    const unsigned char*           in_specialization_constant_data_ptr) const
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr         = get_mutex();
-    Pipelines::const_iterator              pipeline_iterator;
-    Pipeline*                              pipeline_ptr      = nullptr;
-    VkPipeline                             result            = VK_NULL_HANDLE;
+    unsigned char*                data_ptr                        = nullptr;
+    uint64_t                      hash                            = 0;
+    VkSpecializationMapEntry*     map_entries_ptr                 = nullptr;
+    uint32_t                      n_specialization_constant_bytes = 0;
+    const uint32_t                n_specialization_constants      = static_cast<uint32_t>(in_specialization_constants.size() );
+    SpecializationInfoCacheEntry* new_entry_ptr                   = nullptr;
+    const VkSpecializationInfo*   result_ptr                      = nullptr;
 
-    if (mutex_ptr != nullptr)
+    anvil_assert(n_specialization_constants > 0);
+
+    /* Form the cache key */
+    m_specialization_info_scratch_key.clear();
+
+    for (const auto& current_specialization_constant : in_specialization_constants)
     {
-        mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
-        );
+        const uint32_t key_offset = static_cast<uint32_t>(m_specialization_info_scratch_key.size() );
+
+        m_specialization_info_scratch_key.resize(key_offset + sizeof(uint32_t) * 2);
+
+        memcpy(&m_specialization_info_scratch_key.at(key_offset),
+               &current_specialization_constant.constant_id,
+               sizeof(uint32_t) );
+        memcpy(&m_specialization_info_scratch_key.at(key_offset + sizeof(uint32_t) ),
+               &current_specialization_constant.n_bytes,
+               sizeof(uint32_t) );
+
+        n_specialization_constant_bytes += current_specialization_constant.n_bytes;
     }
 
-    if (m_outstanding_pipelines.size() > 0)
+    for (const auto& current_specialization_constant : in_specialization_constants)
     {
-        bake();
+        m_specialization_info_scratch_key.insert(m_specialization_info_scratch_key.end(),
+                                                 in_specialization_constant_data_ptr + current_specialization_constant.start_offset,
+                                                 in_specialization_constant_data_ptr + current_specialization_constant.start_offset + current_specialization_constant.n_bytes);
     }
 
-    pipeline_iterator = m_baked_pipelines.find(in_pipeline_id);
+    hash = Anvil::Utils::hash64(&m_specialization_info_scratch_key.at(0),
+                                m_specialization_info_scratch_key.size() );
 
-    if (pipeline_iterator == m_baked_pipelines.end() )
+    /* Reuse a descriptor baked earlier, if possible */
+    auto& bucket = m_specialization_info_cache[hash];
+
+    for (const auto& current_entry_ptr : bucket)
     {
-        anvil_assert(!(pipeline_iterator == m_baked_pipelines.end()) );
+        if (current_entry_ptr->key == m_specialization_info_scratch_key)
+        {
+            result_ptr = &current_entry_ptr->info;
 
-        goto end;
+            goto end;
+        }
     }
 
-    pipeline_ptr = pipeline_iterator->second.get();
+    /* Cache miss. Store map entries and constant data in the arena, with constant data tightly packed. */
+    map_entries_ptr = static_cast<VkSpecializationMapEntry*>(alloc_specialization_info_arena_memory(static_cast<uint32_t>(sizeof(VkSpecializationMapEntry) * n_specialization_constants) ));
+    data_ptr        = static_cast<unsigned char*>           (alloc_specialization_info_arena_memory(n_specialization_constant_bytes) );
 
-    if (pipeline_ptr->pipeline_create_info_ptr->is_proxy() )
+    memcpy(data_ptr,
+           &m_specialization_info_scratch_key.at(sizeof(uint32_t) * 2 * n_specialization_constants),
+           n_specialization_constant_bytes);
+
+    for (uint32_t n_specialization_constant = 0, data_offset = 0;
+                  n_specialization_constant < n_specialization_constants;
+                ++n_specialization_constant)
     {
-        anvil_assert(!pipeline_ptr->pipeline_create_info_ptr->is_proxy() );
+        const SpecializationConstant& current_specialization_constant = in_specialization_constants[n_specialization_constant];
+        VkSpecializationMapEntry&     current_entry                   = map_entries_ptr[n_specialization_constant];
 
-        goto end;
+        current_entry.constantID = current_specialization_constant.constant_id;
+        current_entry.offset     = data_offset;
+        current_entry.size       = current_specialization_constant.n_bytes;
+
+        data_offset += current_specialization_constant.n_bytes;
     }
 
-    result = pipeline_ptr->baked_pipeline;
-    anvil_assert(result != VK_NULL_HANDLE);
+    new_entry_ptr = new SpecializationInfoCacheEntry();
+
+    new_entry_ptr->info.dataSize      = n_specialization_constant_bytes;
+    new_entry_ptr->info.mapEntryCount = n_specialization_constants;
+    new_entry_ptr->info.pData         = data_ptr;
+    new_entry_ptr->info.pMapEntries   = map_entries_ptr;
+    new_entry_ptr->key                = m_specialization_info_scratch_key;
+
+    bucket.push_back(
+        std::unique_ptr<SpecializationInfoCacheEntry>(new_entry_ptr)
+    );
+
+    result_ptr = &new_entry_ptr->info;
 end:
-    return result;
+    return result_ptr;
 }
 
-const Anvil::BasePipelineCreateInfo* Anvil::BasePipelineManager::get_pipeline_create_info(PipelineID in_pipeline_id) const
+/* Please see header for specification */
+std::unique_ptr<Anvil::BasePipelineManager::CreationFeedbackStorage> Anvil::BasePipelineManager::chain_creation_feedback(uint32_t                               in_n_stages,
+                                                                                                                         const VkPipelineShaderStageCreateInfo* in_stages_ptr,
+                                                                                                                         const void**                           inout_next_ptr_ptr) const
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr         = get_mutex();
-    Pipelines::const_iterator              pipeline_iterator;
-    Pipeline*                              pipeline_ptr      = nullptr;
-    const Anvil::BasePipelineCreateInfo*   result_ptr        = nullptr;
+    std::unique_ptr<CreationFeedbackStorage> result_ptr;
 
-    if (mutex_ptr != nullptr)
+    anvil_assert(inout_next_ptr_ptr != nullptr);
+
+    if (!m_device_ptr->get_extension_info()->ext_pipeline_creation_feedback() )
     {
-        mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
-        );
+        goto end;
     }
 
-    pipeline_iterator = m_baked_pipelines.find(in_pipeline_id);
+    result_ptr.reset(new CreationFeedbackStorage() );
 
-    if (pipeline_iterator == m_baked_pipelines.end() )
+    result_ptr->pipeline_feedback.duration = 0;
+    result_ptr->pipeline_feedback.flags    = 0;
+
+    result_ptr->stage_feedbacks.resize(in_n_stages,
+                                       result_ptr->pipeline_feedback);
+    result_ptr->stages.reserve        (in_n_stages);
+
+    for (uint32_t n_stage = 0;
+                  n_stage < in_n_stages;
+                ++n_stage)
     {
-        pipeline_iterator = m_outstanding_pipelines.find(in_pipeline_id);
+        Anvil::ShaderStage current_stage = Anvil::ShaderStage::UNKNOWN;
 
-        if (pipeline_iterator == m_outstanding_pipelines.end() )
+        for (uint32_t n_shader_stage = static_cast<uint32_t>(Anvil::ShaderStage::FIRST);
+                      n_shader_stage < static_cast<uint32_t>(Anvil::ShaderStage::COUNT);
+                    ++n_shader_stage)
         {
-            anvil_assert(!(pipeline_iterator == m_outstanding_pipelines.end() ));
+            const auto shader_stage = static_cast<Anvil::ShaderStage>(n_shader_stage);
 
-            goto end;
+            if (static_cast<VkShaderStageFlagBits>(Anvil::Utils::get_shader_stage_flag_bits_from_shader_stage(shader_stage) ) == in_stages_ptr[n_stage].stage)
+            {
+                current_stage = shader_stage;
+
+                break;
+            }
         }
+
+        result_ptr->stages.push_back(current_stage);
     }
 
-    pipeline_ptr = pipeline_iterator->second.get();
-    result_ptr   = pipeline_ptr->pipeline_create_info_ptr.get();
+    result_ptr->create_info.pipelineStageCreationFeedbackCount = in_n_stages;
+    result_ptr->create_info.pNext                              = *inout_next_ptr_ptr;
+    result_ptr->create_info.pPipelineCreationFeedback          = &result_ptr->pipeline_feedback;
+    result_ptr->create_info.pPipelineStageCreationFeedbacks    = (in_n_stages > 0) ? &result_ptr->stage_feedbacks.at(0)
+                                                                                   : nullptr;
+    result_ptr->create_info.sType                              = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO_EXT;
 
+    *inout_next_ptr_ptr = &result_ptr->create_info;
 end:
     return result_ptr;
 }
 
-/* Please see header for specification */
-Anvil::PipelineLayout* Anvil::BasePipelineManager::get_pipeline_layout(PipelineID in_pipeline_id)
+/** Entry-point of the compiler thread. Compiles pipelines queued by add_pipeline() in batches, until
+ *  set_async_compilation_enabled() asks the thread to quit.
+ **/
+void Anvil::BasePipelineManager::compiler_thread_main()
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr         = get_mutex();
-    Pipelines::iterator                    pipeline_iterator;
-    Pipeline*                              pipeline_ptr      = nullptr;
-    Anvil::PipelineLayout*                 result_ptr        = nullptr;
-
-    if (mutex_ptr != nullptr)
-    {
-        mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
-        );
-    }
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+    std::vector<PipelineID>                    pipeline_ids;
 
-    pipeline_iterator = m_baked_pipelines.find(in_pipeline_id);
+    m_compiler_thread_id = std::this_thread::get_id();
 
-    if (pipeline_iterator == m_baked_pipelines.end() )
+    while (true)
     {
-        pipeline_iterator = m_outstanding_pipelines.find(in_pipeline_id);
+        bool result = false;
+
+        m_compiler_thread_cv.wait(mutex_lock,
+                                  [this]()
+                                  {
+                                      return m_async_pipelines.size() > 0 || m_compiler_thread_should_quit;
+                                  });
 
-        if (pipeline_iterator == m_outstanding_pipelines.end() )
+        if (m_compiler_thread_should_quit)
         {
-            anvil_assert(!(pipeline_iterator == m_outstanding_pipelines.end() ));
+            break;
+        }
 
-            goto end;
+        /* Move the whole queue to a separate container, so that other threads neither bake the batch
+         * nor modify it while the lock is released by create_pipelines(). */
+        anvil_assert(m_compiling_pipelines.size() == 0);
+
+        m_compiling_pipelines.swap(m_async_pipelines);
+
+        pipeline_ids.clear();
+
+        for (const auto& current_pipeline : m_compiling_pipelines)
+        {
+            pipeline_ids.push_back(current_pipeline.first);
         }
-    }
 
-    pipeline_ptr = pipeline_iterator->second.get();
+        /* bake_pipelines() locks the manager on its own. create_pipelines() can only release the lock fully
+         * if it has been taken exactly once. */
+        mutex_lock.unlock();
+        {
+            result = bake_pipelines(&m_compiling_pipelines);
+        }
+        mutex_lock.lock();
 
-    if (pipeline_ptr->pipeline_create_info_ptr->is_proxy() )
-    {
-        anvil_assert(!pipeline_ptr->pipeline_create_info_ptr->is_proxy() );
+        /* Pipelines which failed to compile are dropped, unless they have been re-queued by replace_shader_module() */
+        if (!result)
+        {
+            restore_rebuilt_pipelines(&m_compiling_pipelines);
+        }
 
-        goto end;
-    }
+        m_compiling_pipelines.clear();
 
-    if (pipeline_ptr->layout_ptr == nullptr)
-    {
-        if (!m_pipeline_layout_manager_ptr->get_layout(pipeline_ptr->pipeline_create_info_ptr->get_ds_create_info_items(),
-                                                       pipeline_ptr->pipeline_create_info_ptr->get_push_constant_ranges(),
-                                                      &pipeline_ptr->layout_ptr) )
+        for (const auto& current_pipeline_id : m_pipelines_to_delete)
         {
-            anvil_assert_fail();
+            publish_pipeline(current_pipeline_id,
+                             nullptr); /* in_opt_pipeline_ptr */
 
-            goto end;
+            retire_previous_pipeline(current_pipeline_id);
+
+            m_baked_pipelines.erase      (current_pipeline_id);
+            m_fallback_pipeline_ids.erase(current_pipeline_id);
         }
 
-        if (pipeline_ptr->layout_ptr == nullptr)
+        for (const auto& current_pipeline_id : pipeline_ids)
         {
-            anvil_assert(!(pipeline_ptr->layout_ptr == nullptr) );
+            if (std::find(m_pipelines_to_delete.begin(),
+                          m_pipelines_to_delete.end(),
+                          current_pipeline_id) == m_pipelines_to_delete.end() )
+            {
+                auto callback_arg = Anvil::OnPipelineCompiledCallbackData(current_pipeline_id,
+                                                                          result);
 
-            goto end;
+                if (result)
+                {
+                    publish_pipeline(current_pipeline_id,
+                                     m_baked_pipelines.at(current_pipeline_id).get() );
+
+                    retire_previous_pipeline(current_pipeline_id);
+                }
+
+                m_fallback_pipeline_ids.erase(current_pipeline_id);
+
+                callback(BASE_PIPELINE_MANAGER_CALLBACK_ID_ON_PIPELINE_COMPILED,
+                        &callback_arg);
+            }
         }
-    }
 
-    result_ptr = pipeline_ptr->layout_ptr.get();
+        m_pipelines_to_delete.clear();
 
-end:
-    return result_ptr;
+        /* Wake up wait_for_async_compilation() callers */
+        m_compiler_thread_cv.notify_all();
+    }
+
+    m_compiler_thread_id = std::thread::id();
 }
 
 /* Please see header for specification */
-bool Anvil::BasePipelineManager::get_shader_info(PipelineID                  in_pipeline_id,
-                                                 Anvil::ShaderStage          in_shader_stage,
-                                                 Anvil::ShaderInfoType       in_info_type,
-                                                 std::vector<unsigned char>* out_data_ptr)
+bool Anvil::BasePipelineManager::create_pipelines(uint32_t                       in_n_pipelines,
+                                                  bool                           in_can_be_split,
+                                                  const CreatePipelinesFunction& in_create_func,
+                                                  VkPipeline*                    out_pipelines_ptr)
 {
-    Anvil::ExtensionAMDShaderInfoEntrypoints entrypoints       = m_device_ptr->get_extension_amd_shader_info_entrypoints();
-    std::unique_lock<std::recursive_mutex>   mutex_lock;
-    auto                                     mutex_ptr         = get_mutex();
-    Pipelines::const_iterator                pipeline_iterator;
-    Pipeline*                                pipeline_ptr      = nullptr;
-    size_t                                   out_data_size     = out_data_ptr->size();
-    bool                                     result            = false;
-    const auto                               shader_stage_vk   = Anvil::Utils::get_shader_stage_flag_bits_from_shader_stage(in_shader_stage);
-    VkShaderInfoTypeAMD                      vk_info_type;
-    VkResult                                 vk_result;
+    const bool is_compiler_thread = (std::this_thread::get_id() == m_compiler_thread_id);
+    uint32_t   n_threads          = m_n_bake_threads;
+    bool       result             = false;
 
-    if (entrypoints.vkGetShaderInfoAMD == nullptr)
+    /* Do not block other threads for the duration of the compile. The pipelines being compiled are owned
+     * by the compiler thread, and the remaining state accessed below is guarded by its own locks. */
+    if (is_compiler_thread)
     {
-        anvil_assert(!(entrypoints.vkGetShaderInfoAMD == nullptr));
-
-        goto end;
+        get_mutex()->unlock();
     }
 
-    if (mutex_ptr != nullptr)
+    if (in_n_pipelines == 0)
     {
-        mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
-        );
+        result = true;
+
+        goto end;
     }
 
-    if (m_outstanding_pipelines.size() > 0)
+    anvil_assert(out_pipelines_ptr != nullptr);
+
+    if (n_threads == 0)
     {
-        bake();
+        /* The calling thread helps out while waiting for the workers to finish */
+        n_threads = m_device_ptr->get_task_scheduler()->get_n_workers() + 1;
     }
 
-    pipeline_iterator = m_baked_pipelines.find(in_pipeline_id);
-    if (pipeline_iterator == m_baked_pipelines.end())
+    if (!in_can_be_split)
     {
-        anvil_assert(!(pipeline_iterator == m_baked_pipelines.end()));
-
-        goto end;
+        n_threads = 1;
     }
 
-    pipeline_ptr = pipeline_iterator->second.get();
+    n_threads = std::min(n_threads,
+                         in_n_pipelines);
 
-    if (pipeline_ptr->baked_pipeline == VK_NULL_HANDLE)
+    if (n_threads == 1)
     {
-        bake();
+        VkResult result_vk;
 
-        anvil_assert(!pipeline_ptr->baked_pipeline != VK_NULL_HANDLE);
-    }
+        if (m_pipeline_cache_ptr != nullptr)
+        {
+            m_pipeline_cache_ptr->lock();
+        }
+        {
+            result_vk = in_create_func((m_pipeline_cache_ptr != nullptr) ? m_pipeline_cache_ptr->get_pipeline_cache()
+                                                                         : VK_NULL_HANDLE,
+                                       0, /* in_n_first_pipeline */
+                                       in_n_pipelines,
+                                       out_pipelines_ptr);
+        }
+        if (m_pipeline_cache_ptr != nullptr)
+        {
+            m_pipeline_cache_ptr->unlock();
+        }
 
-    switch (in_info_type)
+        anvil_assert_vk_call_succeeded(result_vk);
+
+        result = is_vk_call_successful(result_vk);
+    }
+    else
     {
-        case ShaderInfoType::BINARY:
+        const uint32_t                               n_pipelines_per_thread = (in_n_pipelines + n_threads - 1) / n_threads;
+        std::vector<unsigned char>                   pipeline_cache_data;
+        std::vector<Anvil::PipelineCacheUniquePtr>   worker_pipeline_cache_ptrs;
+        std::vector<const Anvil::PipelineCache*>     worker_pipeline_cache_raw_ptrs;
+        std::vector<VkResult>                        worker_results;
+        Anvil::TaskScheduler*                        task_scheduler_ptr     = m_device_ptr->get_task_scheduler();
+        Anvil::TaskWaitGroup                         wait_group;
+
+        /* Chunks are rounded up, so the last thread(s) might have nothing to do. Drop them. */
+        n_threads = (in_n_pipelines + n_pipelines_per_thread - 1) / n_pipelines_per_thread;
+
+        /* Seed worker caches with the manager's cache contents, so that pipelines which have already been
+         * cached do not need to be compiled again. */
+        if (m_pipeline_cache_ptr != nullptr)
         {
-            vk_info_type = VK_SHADER_INFO_TYPE_BINARY_AMD;
+            size_t n_pipeline_cache_data_bytes = 0;
 
-            break;
-        }
+            if (m_pipeline_cache_ptr->get_data(&n_pipeline_cache_data_bytes,
+                                               nullptr) &&
+                n_pipeline_cache_data_bytes > 0)
+            {
+                pipeline_cache_data.resize(n_pipeline_cache_data_bytes);
+
+                if (!m_pipeline_cache_ptr->get_data(&n_pipeline_cache_data_bytes,
+                                                    &pipeline_cache_data.at(0) ))
+                {
+                    pipeline_cache_data.clear();
+                }
+                else
+                {
+                    pipeline_cache_data.resize(n_pipeline_cache_data_bytes);
+                }
+            }
 
-        case ShaderInfoType::DISASSEMBLY:
-        {
-            vk_info_type = VK_SHADER_INFO_TYPE_DISASSEMBLY_AMD;
+            for (uint32_t n_thread = 0;
+                          n_thread < n_threads;
+                        ++n_thread)
+            {
+                auto worker_pipeline_cache_ptr = Anvil::PipelineCache::create(m_device_ptr,
+                                                                              false, /* in_mt_safe */
+                                                                              pipeline_cache_data.size(),
+                                                                              (pipeline_cache_data.size() > 0) ? &pipeline_cache_data.at(0)
+                                                                                                               : nullptr);
 
-            break;
+                if (worker_pipeline_cache_ptr == nullptr)
+                {
+                    anvil_assert(worker_pipeline_cache_ptr != nullptr);
+
+                    goto end;
+                }
+
+                worker_pipeline_cache_raw_ptrs.push_back(worker_pipeline_cache_ptr.get() );
+                worker_pipeline_cache_ptrs.push_back    (std::move(worker_pipeline_cache_ptr) );
+            }
         }
 
-        default:
-        {
-            anvil_assert(!"Unknown shader info type");
+        worker_results.resize(n_threads,
+                              VK_ERROR_INITIALIZATION_FAILED);
 
-            goto end;
+        for (uint32_t n_thread = 0;
+                      n_thread < n_threads;
+                    ++n_thread)
+        {
+            const uint32_t        n_first_pipeline = n_thread * n_pipelines_per_thread;
+            const uint32_t        n_pipelines      = std::min(n_pipelines_per_thread,
+                                                              in_n_pipelines - n_first_pipeline);
+            const VkPipelineCache pipeline_cache   = (worker_pipeline_cache_ptrs.size() > 0) ? worker_pipeline_cache_ptrs.at(n_thread)->get_pipeline_cache()
+                                                                                             : VK_NULL_HANDLE;
+            VkResult*             result_vk_ptr    = &worker_results.at(n_thread);
+
+            task_scheduler_ptr->submit(
+                [&in_create_func, pipeline_cache, n_first_pipeline, n_pipelines, out_pipelines_ptr, result_vk_ptr]()
+                {
+                    *result_vk_ptr = in_create_func(pipeline_cache,
+                                                    n_first_pipeline,
+                                                    n_pipelines,
+                                                    out_pipelines_ptr + n_first_pipeline);
+                },
+                &wait_group);
         }
-    }
+
+        task_scheduler_ptr->wait(&wait_group);
+
+        result = true;
+
+        for (const auto& current_worker_result : worker_results)
+        {
+            if (!is_vk_call_successful(current_worker_result) )
+            {
+                anvil_assert_vk_call_succeeded(current_worker_result);
+
+                result = false;
+            }
+        }
+
+        if (worker_pipeline_cache_raw_ptrs.size() > 0)
+        {
+            if (!m_pipeline_cache_ptr->merge(static_cast<uint32_t>(worker_pipeline_cache_raw_ptrs.size() ),
+                                            &worker_pipeline_cache_raw_ptrs.at(0) ))
+            {
+                /* Not fatal. Pipelines are still usable, they just won't be cached. */
+                anvil_assert_fail();
+            }
+        }
+
+        if (!result)
+        {
+            /* Release any pipelines created by the workers which did manage to finish successfully. */
+            for (uint32_t n_pipeline = 0;
+                          n_pipeline < in_n_pipelines;
+                        ++n_pipeline)
+            {
+                if (out_pipelines_ptr[n_pipeline] != VK_NULL_HANDLE)
+                {
+                    m_device_ptr->get_dispatch_table().vkDestroyPipeline(m_device_ptr->get_device_vk(),
+                                                                         out_pipelines_ptr[n_pipeline],
+                                                                         m_device_ptr->get_allocation_callbacks_vk() );
+
+                    out_pipelines_ptr[n_pipeline] = VK_NULL_HANDLE;
+                }
+            }
+        }
+    }
+
+end:
+    if (is_compiler_thread)
+    {
+        get_mutex()->lock();
+    }
+
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::BasePipelineManager::delete_pipeline(PipelineID in_pipeline_id)
+{
+    bool result = false;
+
+    {
+        std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+        auto                                       mutex_ptr         = get_mutex();
+        Pipelines::iterator                        pipeline_iterator;
+
+        if (mutex_ptr != nullptr)
+        {
+            mutex_lock = std::move(
+                std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+            );
+        }
+
+        pipeline_iterator = m_baked_pipelines.find(in_pipeline_id);
+
+        if (pipeline_iterator != m_baked_pipelines.end() )
+        {
+            publish_pipeline(in_pipeline_id,
+                             nullptr); /* in_opt_pipeline_ptr */
+
+            m_baked_pipelines.erase(pipeline_iterator);
+        }
+        else
+        if (m_compiling_pipelines.find(in_pipeline_id) != m_compiling_pipelines.end() )
+        {
+            /* The compiler thread is using the pipeline. It will release it once it is done. */
+            m_pipelines_to_delete.push_back(in_pipeline_id);
+        }
+        else
+        {
+            pipeline_iterator = m_outstanding_pipelines.find(in_pipeline_id);
+
+            if (pipeline_iterator != m_outstanding_pipelines.end() )
+            {
+                m_outstanding_pipelines.erase(pipeline_iterator);
+            }
+            else
+            {
+                pipeline_iterator = m_async_pipelines.find(in_pipeline_id);
+
+                if (pipeline_iterator == m_async_pipelines.end() )
+                {
+                    goto end;
+                }
+
+                m_async_pipelines.erase      (pipeline_iterator);
+                m_fallback_pipeline_ids.erase(in_pipeline_id);
+            }
+
+            /* Pipelines re-queued by replace_shader_module() still expose their previous Vulkan objects */
+            if (m_rebuilt_pipeline_previous_handles.find(in_pipeline_id) != m_rebuilt_pipeline_previous_handles.end() )
+            {
+                publish_pipeline(in_pipeline_id,
+                                 nullptr); /* in_opt_pipeline_ptr */
+
+                retire_previous_pipeline(in_pipeline_id);
+            }
+        }
+    }
+
+    /* All done */
+    result = true;
+end:
+    return result;
+}
+
+/** Looks up a pipeline, regardless of whether it has been baked, is outstanding or is being compiled
+ *  asynchronously. The manager must be locked by the caller.
+ *
+ *  @param in_pipeline_id ID of the pipeline to look up.
+ *
+ *  @return Pipeline descriptor or null if no pipeline with the specified ID exists.
+ **/
+Anvil::BasePipelineManager::Pipeline* Anvil::BasePipelineManager::find_pipeline(PipelineID in_pipeline_id) const
+{
+    const Pipelines* const pipelines[] =
+    {
+        &m_baked_pipelines,
+        &m_outstanding_pipelines,
+        &m_async_pipelines,
+        &m_compiling_pipelines
+    };
+    Pipeline* result_ptr = nullptr;
+
+    for (const auto& current_pipelines_ptr : pipelines)
+    {
+        auto pipeline_iterator = current_pipelines_ptr->find(in_pipeline_id);
+
+        if (pipeline_iterator != current_pipelines_ptr->end() )
+        {
+            result_ptr = pipeline_iterator->second.get();
+
+            break;
+        }
+    }
+
+    return result_ptr;
+}
+
+/* Please see header for specification */
+void Anvil::BasePipelineManager::get_baked_pipeline_ids(std::vector<PipelineID>* out_result_ptr)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr = get_mutex();
+
+    anvil_assert(out_result_ptr != nullptr);
+
+    out_result_ptr->clear();
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    if (m_outstanding_pipelines.size() > 0)
+    {
+        bake();
+    }
+
+    /* NOTE: Pipelines is an ordered map, so the IDs come out sorted. */
+    for (const auto& current_pipeline : m_baked_pipelines)
+    {
+        if (current_pipeline.second->pipeline_create_info_ptr->is_proxy() ||
+            current_pipeline.second->baked_pipeline == VK_NULL_HANDLE)
+        {
+            continue;
+        }
+
+        out_result_ptr->push_back(current_pipeline.first);
+    }
+}
+
+/* Please see header for specification */
+VkPipeline Anvil::BasePipelineManager::get_pipeline(PipelineID in_pipeline_id)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr         = get_mutex();
+    Pipelines::const_iterator                  pipeline_iterator;
+    Pipeline*                                  pipeline_ptr      = nullptr;
+    VkPipeline                                 result            = VK_NULL_HANDLE;
+    const PipelineSlot*                        slot_ptr          = get_pipeline_slot(in_pipeline_id);
+
+    /* Fast path: baked pipelines can be returned without locking the manager */
+    if (slot_ptr != nullptr)
+    {
+        result = slot_ptr->baked_pipeline.load(std::memory_order_acquire);
+
+        if (result != VK_NULL_HANDLE)
+        {
+            goto end;
+        }
+    }
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    if (m_outstanding_pipelines.size() > 0)
+    {
+        bake();
+    }
+
+    pipeline_iterator = m_baked_pipelines.find(in_pipeline_id);
+
+    if (pipeline_iterator == m_baked_pipelines.end() )
+    {
+        if (m_async_pipelines.find    (in_pipeline_id) != m_async_pipelines.end    () ||
+            m_compiling_pipelines.find(in_pipeline_id) != m_compiling_pipelines.end() )
+        {
+            /* Still being compiled. Do not wait for it. */
+            auto fallback_iterator = m_fallback_pipeline_ids.find(in_pipeline_id);
+
+            if (fallback_iterator != m_fallback_pipeline_ids.end() )
+            {
+                result = get_pipeline(fallback_iterator->second);
+            }
+
+            goto end;
+        }
+
+        anvil_assert(!(pipeline_iterator == m_baked_pipelines.end()) );
+
+        goto end;
+    }
+
+    pipeline_ptr = pipeline_iterator->second.get();
+
+    if (pipeline_ptr->pipeline_create_info_ptr->is_proxy() )
+    {
+        anvil_assert(!pipeline_ptr->pipeline_create_info_ptr->is_proxy() );
+
+        goto end;
+    }
+
+    result = pipeline_ptr->baked_pipeline;
+    anvil_assert(result != VK_NULL_HANDLE);
+end:
+    return result;
+}
+
+const Anvil::BasePipelineCreateInfo* Anvil::BasePipelineManager::get_pipeline_create_info(PipelineID in_pipeline_id) const
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr         = get_mutex();
+    Pipeline*                                  pipeline_ptr      = nullptr;
+    const Anvil::BasePipelineCreateInfo*       result_ptr        = nullptr;
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    pipeline_ptr = find_pipeline(in_pipeline_id);
+
+    if (pipeline_ptr == nullptr)
+    {
+        anvil_assert(pipeline_ptr != nullptr);
+
+        goto end;
+    }
+
+    result_ptr = pipeline_ptr->pipeline_create_info_ptr.get();
+
+end:
+    return result_ptr;
+}
+
+/* Please see header for specification */
+bool Anvil::BasePipelineManager::get_pipeline_creation_feedback(PipelineID                in_pipeline_id,
+                                                                PipelineCreationFeedback* out_result_ptr) const
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr    = get_mutex();
+    const Pipeline*                            pipeline_ptr = nullptr;
+    bool                                       result       = false;
+
+    anvil_assert(out_result_ptr != nullptr);
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    pipeline_ptr = find_pipeline(in_pipeline_id);
+
+    if (pipeline_ptr == nullptr)
+    {
+        anvil_assert(pipeline_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (!pipeline_ptr->creation_feedback.pipeline.is_valid)
+    {
+        goto end;
+    }
+
+    *out_result_ptr = pipeline_ptr->creation_feedback;
+    result          = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+Anvil::BasePipelineManager::PipelineCreationFeedbackReport Anvil::BasePipelineManager::get_pipeline_creation_feedback_report() const
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr = get_mutex();
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    return m_creation_feedback_report;
+}
+
+/* Please see header for specification */
+bool Anvil::BasePipelineManager::get_pipeline_executable_properties(PipelineID                                 in_pipeline_id,
+                                                                    std::vector<PipelineExecutableProperties>* out_result_ptr)
+{
+    std::vector<VkPipelineExecutablePropertiesKHR> executable_props_vk;
+    std::unique_lock<Anvil::RecursiveSpinLock>     mutex_lock;
+    auto                                           mutex_ptr         = get_mutex();
+    uint32_t                                       n_executables     = 0;
+    Pipelines::const_iterator                      pipeline_iterator;
+    VkPipelineInfoKHR                              pipeline_info_vk;
+    const Pipeline*                                pipeline_ptr      = nullptr;
+    bool                                           result            = false;
+    VkResult                                       result_vk;
+
+    anvil_assert(out_result_ptr != nullptr);
+
+    if (!m_device_ptr->get_extension_info()->khr_pipeline_executable_properties() )
+    {
+        anvil_assert(m_device_ptr->get_extension_info()->khr_pipeline_executable_properties() );
+
+        goto end;
+    }
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    if (m_outstanding_pipelines.size() > 0)
+    {
+        bake();
+    }
+
+    pipeline_iterator = m_baked_pipelines.find(in_pipeline_id);
+
+    if (pipeline_iterator == m_baked_pipelines.end() )
+    {
+        anvil_assert(pipeline_iterator != m_baked_pipelines.end() );
+
+        goto end;
+    }
+
+    pipeline_ptr = pipeline_iterator->second.get();
+
+    if (pipeline_ptr->pipeline_create_info_ptr->is_proxy() ||
+        pipeline_ptr->baked_pipeline == VK_NULL_HANDLE)
+    {
+        anvil_assert(!pipeline_ptr->pipeline_create_info_ptr->is_proxy() );
+
+        goto end;
+    }
+
+    {
+        const auto& entrypoints = m_device_ptr->get_extension_khr_pipeline_executable_properties_entrypoints();
+
+        pipeline_info_vk.pipeline = pipeline_ptr->baked_pipeline;
+        pipeline_info_vk.pNext    = nullptr;
+        pipeline_info_vk.sType    = VK_STRUCTURE_TYPE_PIPELINE_INFO_KHR;
+
+        result_vk = entrypoints.vkGetPipelineExecutablePropertiesKHR(m_device_ptr->get_device_vk(),
+                                                                    &pipeline_info_vk,
+                                                                    &n_executables,
+                                                                     nullptr); /* pProperties */
+
+        if (!is_vk_call_successful(result_vk) )
+        {
+            anvil_assert_vk_call_succeeded(result_vk);
+
+            goto end;
+        }
+
+        executable_props_vk.resize(n_executables);
+
+        for (auto& current_props_vk : executable_props_vk)
+        {
+            current_props_vk.pNext = nullptr;
+            current_props_vk.sType = VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_PROPERTIES_KHR;
+        }
+
+        if (n_executables > 0)
+        {
+            result_vk = entrypoints.vkGetPipelineExecutablePropertiesKHR(m_device_ptr->get_device_vk(),
+                                                                        &pipeline_info_vk,
+                                                                        &n_executables,
+                                                                        &executable_props_vk.at(0) );
+
+            if (!is_vk_call_successful(result_vk) )
+            {
+                anvil_assert_vk_call_succeeded(result_vk);
+
+                goto end;
+            }
+        }
+
+        out_result_ptr->clear();
+        out_result_ptr->resize(n_executables);
+
+        for (uint32_t n_executable = 0;
+                      n_executable < n_executables;
+                    ++n_executable)
+        {
+            PipelineExecutableProperties&                 current_props      = out_result_ptr->at(n_executable);
+            const VkPipelineExecutablePropertiesKHR&      current_props_vk   = executable_props_vk.at(n_executable);
+            VkPipelineExecutableInfoKHR                   executable_info_vk;
+            uint32_t                                      n_statistics       = 0;
+            std::vector<VkPipelineExecutableStatisticKHR> statistics_vk;
+
+            current_props.description   = current_props_vk.description;
+            current_props.name          = current_props_vk.name;
+            current_props.stages        = Anvil::ShaderStageFlags(static_cast<Anvil::ShaderStageFlagBits>(current_props_vk.stages) );
+            current_props.subgroup_size = current_props_vk.subgroupSize;
+
+            if (!pipeline_ptr->pipeline_create_info_ptr->captures_statistics() )
+            {
+                continue;
+            }
+
+            executable_info_vk.executableIndex = n_executable;
+            executable_info_vk.pipeline        = pipeline_ptr->baked_pipeline;
+            executable_info_vk.pNext           = nullptr;
+            executable_info_vk.sType           = VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_INFO_KHR;
+
+            result_vk = entrypoints.vkGetPipelineExecutableStatisticsKHR(m_device_ptr->get_device_vk(),
+                                                                        &executable_info_vk,
+                                                                        &n_statistics,
+                                                                         nullptr); /* pStatistics */
+
+            if (!is_vk_call_successful(result_vk) )
+            {
+                anvil_assert_vk_call_succeeded(result_vk);
+
+                goto end;
+            }
+
+            if (n_statistics == 0)
+            {
+                continue;
+            }
+
+            statistics_vk.resize(n_statistics);
+
+            for (auto& current_statistic_vk : statistics_vk)
+            {
+                current_statistic_vk.pNext = nullptr;
+                current_statistic_vk.sType = VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_STATISTIC_KHR;
+            }
+
+            result_vk = entrypoints.vkGetPipelineExecutableStatisticsKHR(m_device_ptr->get_device_vk(),
+                                                                        &executable_info_vk,
+                                                                        &n_statistics,
+                                                                        &statistics_vk.at(0) );
+
+            if (!is_vk_call_successful(result_vk) )
+            {
+                anvil_assert_vk_call_succeeded(result_vk);
+
+                goto end;
+            }
+
+            current_props.statistics.resize(n_statistics);
+
+            for (uint32_t n_statistic = 0;
+                          n_statistic < n_statistics;
+                        ++n_statistic)
+            {
+                PipelineExecutableStatistic&            current_statistic    = current_props.statistics.at(n_statistic);
+                const VkPipelineExecutableStatisticKHR& current_statistic_vk = statistics_vk.at               (n_statistic);
+
+                current_statistic.description = current_statistic_vk.description;
+                current_statistic.format      = current_statistic_vk.format;
+                current_statistic.name        = current_statistic_vk.name;
+                current_statistic.value       = current_statistic_vk.value;
+            }
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+Anvil::PipelineLayout* Anvil::BasePipelineManager::get_pipeline_layout(PipelineID in_pipeline_id)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr         = get_mutex();
+    Pipeline*                                  pipeline_ptr      = nullptr;
+    Anvil::PipelineLayout*                     result_ptr        = nullptr;
+    const PipelineSlot*                        slot_ptr          = get_pipeline_slot(in_pipeline_id);
+
+    /* Fast path: layouts which have already been retrieved can be returned without locking the manager */
+    if (slot_ptr != nullptr)
+    {
+        result_ptr = slot_ptr->layout_ptr.load(std::memory_order_acquire);
+
+        if (result_ptr != nullptr)
+        {
+            goto end;
+        }
+    }
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    pipeline_ptr = find_pipeline(in_pipeline_id);
+
+    if (pipeline_ptr == nullptr)
+    {
+        anvil_assert(pipeline_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (pipeline_ptr->pipeline_create_info_ptr->is_proxy() )
+    {
+        anvil_assert(!pipeline_ptr->pipeline_create_info_ptr->is_proxy() );
+
+        goto end;
+    }
+
+    if (pipeline_ptr->layout_ptr == nullptr)
+    {
+        if (!m_pipeline_layout_manager_ptr->get_layout(pipeline_ptr->pipeline_create_info_ptr->get_ds_create_info_items(),
+                                                       pipeline_ptr->pipeline_create_info_ptr->get_push_constant_ranges(),
+                                                      &pipeline_ptr->layout_ptr) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        if (pipeline_ptr->layout_ptr == nullptr)
+        {
+            anvil_assert(!(pipeline_ptr->layout_ptr == nullptr) );
+
+            goto end;
+        }
+    }
+
+    result_ptr = pipeline_ptr->layout_ptr.get();
+
+    publish_pipeline(in_pipeline_id,
+                     pipeline_ptr);
+
+end:
+    return result_ptr;
+}
+
+/** Returns the lock-free slot of the specified pipeline, creating it if needed. The manager must be locked
+ *  by the caller.
+ *
+ *  @param in_pipeline_id ID of the pipeline to return the slot for.
+ *
+ *  @return Requested slot or null if the manager has run out of slots.
+ **/
+Anvil::BasePipelineManager::PipelineSlot* Anvil::BasePipelineManager::get_or_create_pipeline_slot(PipelineID in_pipeline_id)
+{
+    const uint32_t n_chunk    = in_pipeline_id / N_PIPELINE_SLOTS_PER_CHUNK;
+    PipelineSlot*  chunk_ptr  = nullptr;
+    PipelineSlot*  result_ptr = nullptr;
+
+    if (n_chunk >= N_MAX_PIPELINE_SLOT_CHUNKS)
+    {
+        goto end;
+    }
+
+    chunk_ptr = m_pipeline_slot_chunks[n_chunk].load(std::memory_order_acquire);
+
+    if (chunk_ptr == nullptr)
+    {
+        chunk_ptr = new PipelineSlot[N_PIPELINE_SLOTS_PER_CHUNK];
+
+        m_pipeline_slot_chunks[n_chunk].store(chunk_ptr,
+                                              std::memory_order_release);
+    }
+
+    result_ptr = chunk_ptr + (in_pipeline_id % N_PIPELINE_SLOTS_PER_CHUNK);
+
+end:
+    return result_ptr;
+}
+
+/* Please see header for specification */
+bool Anvil::BasePipelineManager::get_pipeline_usage(PipelineID     in_pipeline_id,
+                                                    PipelineUsage* out_result_ptr) const
+{
+    bool                result   = false;
+    const PipelineSlot* slot_ptr = get_pipeline_slot(in_pipeline_id);
+
+    anvil_assert(out_result_ptr != nullptr);
+
+    if (slot_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    out_result_ptr->n_binds            = slot_ptr->n_binds.load           (std::memory_order_relaxed);
+    out_result_ptr->n_first_bind_frame = slot_ptr->n_first_bind_frame.load(std::memory_order_relaxed);
+
+    result = (out_result_ptr->n_binds > 0);
+end:
+    return result;
+}
+
+/** Returns the lock-free slot of the specified pipeline, or null if the slot has not been created yet.
+ *  May be called without locking the manager.
+ *
+ *  @param in_pipeline_id ID of the pipeline to return the slot for.
+ **/
+const Anvil::BasePipelineManager::PipelineSlot* Anvil::BasePipelineManager::get_pipeline_slot(PipelineID in_pipeline_id) const
+{
+    const uint32_t      n_chunk    = in_pipeline_id / N_PIPELINE_SLOTS_PER_CHUNK;
+    const PipelineSlot* result_ptr = nullptr;
+
+    if (n_chunk < N_MAX_PIPELINE_SLOT_CHUNKS)
+    {
+        const PipelineSlot* chunk_ptr = m_pipeline_slot_chunks[n_chunk].load(std::memory_order_acquire);
+
+        if (chunk_ptr != nullptr)
+        {
+            result_ptr = chunk_ptr + (in_pipeline_id % N_PIPELINE_SLOTS_PER_CHUNK);
+        }
+    }
+
+    return result_ptr;
+}
+
+/* Please see header for specification */
+bool Anvil::BasePipelineManager::get_shader_info(PipelineID                  in_pipeline_id,
+                                                 Anvil::ShaderStage          in_shader_stage,
+                                                 Anvil::ShaderInfoType       in_info_type,
+                                                 std::vector<unsigned char>* out_data_ptr)
+{
+    Anvil::ExtensionAMDShaderInfoEntrypoints   entrypoints       = m_device_ptr->get_extension_amd_shader_info_entrypoints();
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr         = get_mutex();
+    Pipelines::const_iterator                  pipeline_iterator;
+    Pipeline*                                  pipeline_ptr      = nullptr;
+    size_t                                     out_data_size     = out_data_ptr->size();
+    bool                                       result            = false;
+    const auto                                 shader_stage_vk   = Anvil::Utils::get_shader_stage_flag_bits_from_shader_stage(in_shader_stage);
+    VkShaderInfoTypeAMD                        vk_info_type;
+    VkResult                                   vk_result;
+
+    if (entrypoints.vkGetShaderInfoAMD == nullptr)
+    {
+        anvil_assert(!(entrypoints.vkGetShaderInfoAMD == nullptr));
+
+        goto end;
+    }
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    if (m_outstanding_pipelines.size() > 0)
+    {
+        bake();
+    }
+
+    pipeline_iterator = m_baked_pipelines.find(in_pipeline_id);
+    if (pipeline_iterator == m_baked_pipelines.end())
+    {
+        anvil_assert(!(pipeline_iterator == m_baked_pipelines.end()));
+
+        goto end;
+    }
+
+    pipeline_ptr = pipeline_iterator->second.get();
+
+    if (pipeline_ptr->baked_pipeline == VK_NULL_HANDLE)
+    {
+        bake();
+
+        anvil_assert(!pipeline_ptr->baked_pipeline != VK_NULL_HANDLE);
+    }
+
+    switch (in_info_type)
+    {
+        case ShaderInfoType::BINARY:
+        {
+            vk_info_type = VK_SHADER_INFO_TYPE_BINARY_AMD;
+
+            break;
+        }
+
+        case ShaderInfoType::DISASSEMBLY:
+        {
+            vk_info_type = VK_SHADER_INFO_TYPE_DISASSEMBLY_AMD;
+
+            break;
+        }
+
+        default:
+        {
+            anvil_assert(!"Unknown shader info type");
+
+            goto end;
+        }
+    }
 
     if (out_data_size == 0)
     {
@@ -537,15 +1545,15 @@ bool Anvil::BasePipelineManager::get_shader_statistics(PipelineID
                                                        Anvil::ShaderStage          in_shader_stage,
                                                        VkShaderStatisticsInfoAMD*  out_shader_statistics_ptr)
 {
-    Anvil::ExtensionAMDShaderInfoEntrypoints entrypoints            = m_device_ptr->get_extension_amd_shader_info_entrypoints();
-    std::unique_lock<std::recursive_mutex>   mutex_lock;
-    auto                                     mutex_ptr              = get_mutex();
-    Pipelines::const_iterator                pipeline_iterator;
-    Pipeline*                                pipeline_ptr           = nullptr;
-    bool                                     result                 = false;
-    const auto                               shader_stage_vk        = Anvil::Utils::get_shader_stage_flag_bits_from_shader_stage(in_shader_stage);
-    size_t                                   shader_statistics_size = sizeof(VkShaderStatisticsInfoAMD);
-    VkResult                                 vk_result;
+    Anvil::ExtensionAMDShaderInfoEntrypoints   entrypoints            = m_device_ptr->get_extension_amd_shader_info_entrypoints();
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr              = get_mutex();
+    Pipelines::const_iterator                  pipeline_iterator;
+    Pipeline*                                  pipeline_ptr           = nullptr;
+    bool                                       result                 = false;
+    const auto                                 shader_stage_vk        = Anvil::Utils::get_shader_stage_flag_bits_from_shader_stage(in_shader_stage);
+    size_t                                     shader_statistics_size = sizeof(VkShaderStatisticsInfoAMD);
+    VkResult                                   vk_result;
 
     if (entrypoints.vkGetShaderInfoAMD == nullptr)
     {
@@ -557,7 +1565,7 @@ bool Anvil::BasePipelineManager::get_shader_statistics(PipelineID
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
         );
     }
 
@@ -606,3 +1614,438 @@ bool Anvil::BasePipelineManager::get_shader_statistics(PipelineID
 end:
     return result;
 }
+
+/** Updates usage statistics of the specified pipeline, if usage profiling is enabled. Called by
+ *  CommandBufferBase::record_bind_pipeline(). Only locks the manager if the pipeline's slot has not been
+ *  created yet, which can only happen for pipelines which are still waiting to be compiled asynchronously.
+ *
+ *  @param in_pipeline_id ID of the pipeline which has been bound.
+ **/
+void Anvil::BasePipelineManager::on_pipeline_bound(PipelineID in_pipeline_id)
+{
+    const PipelineSlot* slot_ptr = nullptr;
+
+    if (!is_usage_profiling_enabled() )
+    {
+        goto end;
+    }
+
+    slot_ptr = get_pipeline_slot(in_pipeline_id);
+
+    if (slot_ptr == nullptr)
+    {
+        std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+        auto                                       mutex_ptr = get_mutex();
+
+        if (mutex_ptr != nullptr)
+        {
+            mutex_lock = std::move(
+                std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+            );
+        }
+
+        slot_ptr = get_or_create_pipeline_slot(in_pipeline_id);
+
+        if (slot_ptr == nullptr)
+        {
+            goto end;
+        }
+    }
+
+    if (slot_ptr->n_binds.fetch_add(1,
+                                    std::memory_order_relaxed) == 0)
+    {
+        slot_ptr->n_first_bind_frame.store(m_usage_profiling_frame.load(std::memory_order_relaxed),
+                                           std::memory_order_relaxed);
+    }
+
+end:
+    ;
+}
+
+/** Updates the lock-free slot of the specified pipeline with the pipeline's baked objects. Creates the slot
+ *  if needed. The manager must be locked by the caller.
+ *
+ *  @param in_pipeline_id      ID of the pipeline to update the slot for.
+ *  @param in_opt_pipeline_ptr Pipeline to take the baked objects from, or null to clear the slot, in which case
+ *                             the slot is not created if it does not exist.
+ **/
+void Anvil::BasePipelineManager::publish_pipeline(PipelineID      in_pipeline_id,
+                                                  const Pipeline* in_opt_pipeline_ptr)
+{
+    PipelineSlot* slot_ptr = (in_opt_pipeline_ptr != nullptr) ? get_or_create_pipeline_slot(in_pipeline_id)
+                                                              : const_cast<PipelineSlot*>(get_pipeline_slot(in_pipeline_id) );
+
+    if (slot_ptr == nullptr)
+    {
+        /* Either out of slots, in which case the pipeline is still going to be accessible, but only with the manager
+         * locked, or there is no slot to clear. */
+        goto end;
+    }
+
+    if (in_opt_pipeline_ptr != nullptr)
+    {
+        slot_ptr->layout_ptr.store    (in_opt_pipeline_ptr->layout_ptr.get(),
+                                       std::memory_order_release);
+        slot_ptr->baked_pipeline.store(in_opt_pipeline_ptr->baked_pipeline,
+                                       std::memory_order_release);
+    }
+    else
+    {
+        slot_ptr->baked_pipeline.store(VK_NULL_HANDLE,
+                                       std::memory_order_release);
+        slot_ptr->layout_ptr.store    (nullptr,
+                                       std::memory_order_release);
+    }
+
+end:
+    ;
+}
+
+/* Please see header for specification */
+void Anvil::BasePipelineManager::release_retired_pipelines()
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr = get_mutex();
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    if (m_retired_pipelines.size() > 0)
+    {
+        m_device_ptr->get_pipeline_cache()->lock();
+        {
+            for (const auto& current_pipeline : m_retired_pipelines)
+            {
+                m_device_ptr->get_dispatch_table().vkDestroyPipeline(m_device_ptr->get_device_vk(),
+                                                                     current_pipeline,
+                                                                     m_device_ptr->get_allocation_callbacks_vk() );
+            }
+        }
+        m_device_ptr->get_pipeline_cache()->unlock();
+
+        m_retired_pipelines.clear();
+    }
+}
+
+/* Please see header for specification */
+void Anvil::BasePipelineManager::replace_shader_module(const Anvil::ShaderModule* in_old_shader_module_ptr,
+                                                       Anvil::ShaderModule*       in_new_shader_module_ptr,
+                                                       std::vector<PipelineID>*   out_opt_rebuilt_pipeline_ids_ptr)
+{
+    Pipelines* const pending_pipelines[] =
+    {
+        &m_outstanding_pipelines,
+        &m_async_pipelines
+    };
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr     = get_mutex();
+    bool                                       should_notify = false;
+
+    anvil_assert(in_new_shader_module_ptr != nullptr);
+    anvil_assert(in_old_shader_module_ptr != nullptr);
+
+    if (out_opt_rebuilt_pipeline_ids_ptr != nullptr)
+    {
+        out_opt_rebuilt_pipeline_ids_ptr->clear();
+    }
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+
+        /* The compiler thread reads create infos of the pipelines it compiles with the lock released */
+        m_compiler_thread_cv.wait(mutex_lock,
+                                  [this, in_old_shader_module_ptr]()
+                                  {
+                                      for (const auto& current_pipeline : m_compiling_pipelines)
+                                      {
+                                          if (is_shader_module_used(current_pipeline.second->pipeline_create_info_ptr.get(),
+                                                                    in_old_shader_module_ptr) )
+                                          {
+                                              return false;
+                                          }
+                                      }
+
+                                      return true;
+                                  });
+    }
+
+    /* Pipelines which have not been baked yet only need to be pointed at the new module */
+    for (const auto& current_pipelines_ptr : pending_pipelines)
+    {
+        for (auto& current_pipeline : *current_pipelines_ptr)
+        {
+            if (current_pipeline.second->pipeline_create_info_ptr->replace_shader_module(in_old_shader_module_ptr,
+                                                                                        in_new_shader_module_ptr) &&
+                out_opt_rebuilt_pipeline_ids_ptr != nullptr)
+            {
+                out_opt_rebuilt_pipeline_ids_ptr->push_back(current_pipeline.first);
+            }
+        }
+    }
+
+    /* Baked pipelines are re-queued. Their slots keep exposing the previous Vulkan objects until the new ones
+     * are published. */
+    for (auto pipeline_iterator  = m_baked_pipelines.begin();
+              pipeline_iterator != m_baked_pipelines.end();
+        )
+    {
+        const PipelineID pipeline_id  = pipeline_iterator->first;
+        auto&            pipeline_ptr = pipeline_iterator->second;
+
+        if (!pipeline_ptr->pipeline_create_info_ptr->replace_shader_module(in_old_shader_module_ptr,
+                                                                           in_new_shader_module_ptr) )
+        {
+            ++pipeline_iterator;
+
+            continue;
+        }
+
+        anvil_assert(m_rebuilt_pipeline_previous_handles.find(pipeline_id) == m_rebuilt_pipeline_previous_handles.end() );
+
+        m_rebuilt_pipeline_previous_handles[pipeline_id] = pipeline_ptr->baked_pipeline;
+        pipeline_ptr->baked_pipeline                     = VK_NULL_HANDLE;
+
+        if (is_async_compilation_enabled() )
+        {
+            m_async_pipelines[pipeline_id] = std::move(pipeline_ptr);
+
+            should_notify = true;
+        }
+        else
+        {
+            m_outstanding_pipelines[pipeline_id] = std::move(pipeline_ptr);
+        }
+
+        if (out_opt_rebuilt_pipeline_ids_ptr != nullptr)
+        {
+            out_opt_rebuilt_pipeline_ids_ptr->push_back(pipeline_id);
+        }
+
+        pipeline_iterator = m_baked_pipelines.erase(pipeline_iterator);
+    }
+
+    if (should_notify)
+    {
+        m_compiler_thread_cv.notify_all();
+    }
+}
+
+/* Please see header for specification */
+void Anvil::BasePipelineManager::reset_pipeline_creation_feedback_report()
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr = get_mutex();
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    m_creation_feedback_report = PipelineCreationFeedbackReport();
+}
+
+/** Moves pipelines, which have been re-queued by replace_shader_module() but failed to re-bake, back to
+ *  m_baked_pipelines. The pipelines go back to using their previous Vulkan pipeline objects, which their
+ *  slots have been exposing all along. Other pipelines are left intact.
+ *
+ *  Must be called with the manager locked.
+ *
+ *  @param inout_pipelines_ptr Pipelines which have failed to bake. Must not be null.
+ **/
+void Anvil::BasePipelineManager::restore_rebuilt_pipelines(Pipelines* inout_pipelines_ptr)
+{
+    for (auto pipeline_iterator  = inout_pipelines_ptr->begin();
+              pipeline_iterator != inout_pipelines_ptr->end();
+        )
+    {
+        auto previous_handle_iterator = m_rebuilt_pipeline_previous_handles.find(pipeline_iterator->first);
+
+        if (previous_handle_iterator == m_rebuilt_pipeline_previous_handles.end() )
+        {
+            ++pipeline_iterator;
+
+            continue;
+        }
+
+        pipeline_iterator->second->baked_pipeline = previous_handle_iterator->second;
+        m_baked_pipelines[pipeline_iterator->first] = std::move(pipeline_iterator->second);
+
+        m_rebuilt_pipeline_previous_handles.erase(previous_handle_iterator);
+
+        pipeline_iterator = inout_pipelines_ptr->erase(pipeline_iterator);
+    }
+}
+
+/** If the specified pipeline has been re-queued by replace_shader_module(), moves its previous Vulkan pipeline
+ *  object to the list of retired pipelines. Does nothing otherwise.
+ *
+ *  Must be called with the manager locked.
+ *
+ *  @param in_pipeline_id ID of the pipeline.
+ **/
+void Anvil::BasePipelineManager::retire_previous_pipeline(PipelineID in_pipeline_id)
+{
+    auto previous_handle_iterator = m_rebuilt_pipeline_previous_handles.find(in_pipeline_id);
+
+    if (previous_handle_iterator != m_rebuilt_pipeline_previous_handles.end() )
+    {
+        m_retired_pipelines.push_back(previous_handle_iterator->second);
+
+        m_rebuilt_pipeline_previous_handles.erase(previous_handle_iterator);
+    }
+}
+
+/* Please see header for specification */
+bool Anvil::BasePipelineManager::set_async_compilation_enabled(bool in_enabled)
+{
+    auto mutex_ptr = get_mutex();
+    bool result    = false;
+
+    if (in_enabled == m_compiler_thread.joinable() )
+    {
+        result = true;
+
+        goto end;
+    }
+
+    if (mutex_ptr == nullptr)
+    {
+        /* The compiler thread relies on the manager's lock */
+        anvil_assert(mutex_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (in_enabled)
+    {
+        std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*mutex_ptr);
+
+        m_compiler_thread_should_quit  = false;
+        m_is_async_compilation_enabled = true;
+        m_compiler_thread              = std::thread(&BasePipelineManager::compiler_thread_main,
+                                                     this);
+    }
+    else
+    {
+        {
+            std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*mutex_ptr);
+
+            m_compiler_thread_should_quit  = true;
+            m_is_async_compilation_enabled = false;
+
+            m_compiler_thread_cv.notify_all();
+        }
+
+        m_compiler_thread.join();
+
+        {
+            std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*mutex_ptr);
+
+            /* Leave the pipelines which have not been picked up by the compiler thread to bake() */
+            for (auto& current_pipeline : m_async_pipelines)
+            {
+                m_outstanding_pipelines[current_pipeline.first] = std::move(current_pipeline.second);
+            }
+
+            m_async_pipelines.clear      ();
+            m_fallback_pipeline_ids.clear();
+            m_pipelines_to_delete.clear  ();
+
+            m_compiler_thread_cv.notify_all();
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+void Anvil::BasePipelineManager::set_n_bake_threads(uint32_t in_n_bake_threads)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr = get_mutex();
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    m_n_bake_threads = in_n_bake_threads;
+}
+
+/* Please see header for specification */
+void Anvil::BasePipelineManager::store_creation_feedback(const CreationFeedbackStorage* in_opt_storage_ptr,
+                                                         Pipeline*                      in_pipeline_ptr)
+{
+    PipelineCreationFeedback feedback;
+
+    anvil_assert(in_pipeline_ptr != nullptr);
+
+    if (in_opt_storage_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    feedback.pipeline = get_creation_feedback(in_opt_storage_ptr->pipeline_feedback);
+
+    for (uint32_t n_stage = 0;
+                  n_stage < static_cast<uint32_t>(in_opt_storage_ptr->stages.size() );
+                ++n_stage)
+    {
+        const auto stage_feedback = get_creation_feedback(in_opt_storage_ptr->stage_feedbacks.at(n_stage) );
+
+        if (stage_feedback.is_valid                                               &&
+            in_opt_storage_ptr->stages.at(n_stage) != Anvil::ShaderStage::UNKNOWN)
+        {
+            feedback.stages[in_opt_storage_ptr->stages.at(n_stage)] = stage_feedback;
+        }
+    }
+
+    in_pipeline_ptr->creation_feedback = feedback;
+
+    if (feedback.pipeline.is_valid)
+    {
+        m_creation_feedback_report.n_application_pipeline_cache_hits += (feedback.pipeline.is_application_pipeline_cache_hit) ? 1 : 0;
+        m_creation_feedback_report.n_pipelines                       ++;
+        m_creation_feedback_report.total_duration_nsec               += feedback.pipeline.duration_nsec;
+
+        for (const auto& current_stage_feedback : feedback.stages)
+        {
+            m_creation_feedback_report.stage_duration_nsec[current_stage_feedback.first] += current_stage_feedback.second.duration_nsec;
+        }
+    }
+
+end:
+    ;
+}
+
+/* Please see header for specification */
+void Anvil::BasePipelineManager::wait_for_async_compilation()
+{
+    auto mutex_ptr = get_mutex();
+
+    if (mutex_ptr != nullptr)
+    {
+        std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*mutex_ptr);
+
+        m_compiler_thread_cv.wait(mutex_lock,
+                                  [this]()
+                                  {
+                                      return m_async_pipelines.size    () == 0 &&
+                                             m_compiling_pipelines.size() == 0;
+                                  });
+    }
+}
@@ -0,0 +1,377 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/buffer_create_info.h"
+#include "misc/buffer_suballocator.h"
+#include "misc/debug.h"
+#include "wrappers/buffer.h"
+#include "wrappers/device.h"
+#include "wrappers/memory_block.h"
+#include <algorithm>
+
+
+/** Please see header for specification */
+Anvil::BufferSuballocator::BufferSuballocator(const Anvil::BaseDevice*  in_device_ptr,
+                                              VkDeviceSize              in_block_size,
+                                              Anvil::BufferUsageFlags   in_usage_flags,
+                                              Anvil::MemoryFeatureFlags in_memory_features,
+                                              bool                      in_mt_safe)
+    :MTSafetySupportProvider(in_mt_safe),
+     m_alignment            (16),
+     m_block_size           (in_block_size),
+     m_device_ptr           (in_device_ptr),
+     m_memory_features      (in_memory_features),
+     m_n_allocated_bytes    (0),
+     m_usage_flags          (in_usage_flags)
+{
+    const auto& limits = in_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits;
+
+    /* Use a single alignment which satisfies all usages the blocks are created with, so that any allocation can be
+     * bound as any of them. */
+    if ((in_usage_flags & Anvil::BufferUsageFlagBits::UNIFORM_BUFFER_BIT) != 0)
+    {
+        m_alignment = std::max(m_alignment,
+                               limits.min_uniform_buffer_offset_alignment);
+    }
+
+    if ((in_usage_flags & Anvil::BufferUsageFlagBits::STORAGE_BUFFER_BIT) != 0)
+    {
+        m_alignment = std::max(m_alignment,
+                               limits.min_storage_buffer_offset_alignment);
+    }
+
+    if ((in_usage_flags & Anvil::BufferUsageFlagBits::STORAGE_TEXEL_BUFFER_BIT) != 0 ||
+        (in_usage_flags & Anvil::BufferUsageFlagBits::UNIFORM_TEXEL_BUFFER_BIT) != 0)
+    {
+        m_alignment = std::max(m_alignment,
+                               limits.min_texel_buffer_offset_alignment);
+    }
+}
+
+/** Please see header for specification */
+Anvil::BufferSuballocator::~BufferSuballocator()
+{
+    lock();
+    {
+        for (auto& current_block : m_blocks)
+        {
+            if (current_block.mapped_ptr != nullptr)
+            {
+                current_block.buffer_ptr->get_memory_block(0 /* in_n_memory_block */)->unmap();
+            }
+        }
+
+        m_blocks.clear();
+    }
+    unlock();
+}
+
+/** Please see header for specification */
+bool Anvil::BufferSuballocator::allocate(VkDeviceSize in_size,
+                                         VkDeviceSize in_alignment,
+                                         Allocation*  out_result_ptr)
+{
+    const VkDeviceSize alignment = std::max(m_alignment,
+                                            in_alignment);
+    bool               result    = false;
+
+    anvil_assert(in_size        >  0);
+    anvil_assert(Anvil::Utils::is_pow2(in_alignment) );
+    anvil_assert(out_result_ptr != nullptr);
+
+    lock();
+    {
+        for (uint32_t n_block = 0;
+                      n_block < static_cast<uint32_t>(m_blocks.size() );
+                    ++n_block)
+        {
+            if (allocate_from_block(n_block,
+                                    in_size,
+                                    alignment,
+                                    out_result_ptr) )
+            {
+                result = true;
+
+                goto end;
+            }
+        }
+
+        /* None of the existing blocks can accommodate the request. Requests larger than the block size get
+         * a dedicated block. */
+        if (!create_block(std::max(m_block_size,
+                                   Anvil::Utils::round_up(in_size,
+                                                          m_alignment) )) )
+        {
+            goto end;
+        }
+
+        result = allocate_from_block(static_cast<uint32_t>(m_blocks.size() ) - 1,
+                                     in_size,
+                                     alignment,
+                                     out_result_ptr);
+
+        anvil_assert(result);
+    }
+end:
+    unlock();
+
+    return result;
+}
+
+/** Carves a region out of the free list of the specified block, using first-fit.
+ *
+ *  Any padding needed to satisfy @param in_alignment is left in the free list.
+ *
+ *  @return true if successful, false if the block cannot accommodate the request.
+ */
+bool Anvil::BufferSuballocator::allocate_from_block(uint32_t     in_n_block,
+                                                    VkDeviceSize in_size,
+                                                    VkDeviceSize in_alignment,
+                                                    Allocation*  out_result_ptr)
+{
+    Block&             block        = m_blocks.at(in_n_block);
+    bool               result       = false;
+    const VkDeviceSize size_aligned = Anvil::Utils::round_up(in_size,
+                                                             m_alignment);
+
+    for (auto range_iterator  = block.free_ranges.begin();
+              range_iterator != block.free_ranges.end();
+            ++range_iterator)
+    {
+        const VkDeviceSize range_end    = range_iterator->first + range_iterator->second;
+        const VkDeviceSize range_start  = range_iterator->first;
+        const VkDeviceSize region_start = Anvil::Utils::round_up(range_start,
+                                                                 in_alignment);
+
+        if (region_start + size_aligned > range_end)
+        {
+            continue;
+        }
+
+        block.free_ranges.erase(range_iterator);
+
+        if (region_start > range_start)
+        {
+            block.free_ranges[range_start] = region_start - range_start;
+        }
+
+        if (region_start + size_aligned < range_end)
+        {
+            block.free_ranges[region_start + size_aligned] = range_end - (region_start + size_aligned);
+        }
+
+        out_result_ptr->buffer_ptr = block.buffer_ptr.get();
+        out_result_ptr->mapped_ptr = (block.mapped_ptr != nullptr) ? block.mapped_ptr + region_start
+                                                                   : nullptr;
+        out_result_ptr->n_block    = in_n_block;
+        out_result_ptr->offset     = region_start;
+        out_result_ptr->size       = in_size;
+
+        m_n_allocated_bytes += size_aligned;
+
+        result = true;
+        break;
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::BufferSuballocatorUniquePtr Anvil::BufferSuballocator::create(const Anvil::BaseDevice*  in_device_ptr,
+                                                                     VkDeviceSize              in_block_size,
+                                                                     Anvil::BufferUsageFlags   in_usage_flags,
+                                                                     Anvil::MemoryFeatureFlags in_memory_features,
+                                                                     bool                      in_mt_safe)
+{
+    Anvil::BufferSuballocatorUniquePtr result_ptr(nullptr,
+                                                  std::default_delete<Anvil::BufferSuballocator>() );
+
+    anvil_assert(in_device_ptr != nullptr);
+    anvil_assert(in_block_size >  0);
+
+    result_ptr.reset(
+        new Anvil::BufferSuballocator(in_device_ptr,
+                                      in_block_size,
+                                      in_usage_flags,
+                                      in_memory_features,
+                                      in_mt_safe)
+    );
+
+    return result_ptr;
+}
+
+/** Creates a new block buffer and appends it to the block list. Blocks created with mappable memory are
+ *  mapped for their whole lifetime.
+ *
+ *  @param in_size Size of the block.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::BufferSuballocator::create_block(VkDeviceSize in_size)
+{
+    Anvil::BufferUniquePtr  buffer_ptr;
+    void*                   mapped_ptr = nullptr;
+    Anvil::QueueFamilyFlags queue_fams = Anvil::QueueFamilyFlagBits::NONE;
+    bool                    result     = false;
+
+    /* Sub-allocated buffers may be consumed by any queue family */
+    if (m_device_ptr->get_n_universal_queues() > 0)
+    {
+        queue_fams |= Anvil::QueueFamilyFlagBits::GRAPHICS_BIT;
+    }
+
+    if (m_device_ptr->get_n_compute_queues() > 0)
+    {
+        queue_fams |= Anvil::QueueFamilyFlagBits::COMPUTE_BIT;
+    }
+
+    if (m_device_ptr->get_n_transfer_queues() > 0)
+    {
+        queue_fams |= Anvil::QueueFamilyFlagBits::DMA_BIT;
+    }
+
+    {
+        const auto sharing_mode    = Anvil::Utils::is_pow2(queue_fams.get_vk() ) ? Anvil::SharingMode::EXCLUSIVE
+                                                                                 : Anvil::SharingMode::CONCURRENT;
+        auto       create_info_ptr = Anvil::BufferCreateInfo::create_alloc(m_device_ptr,
+                                                                           in_size,
+                                                                           queue_fams,
+                                                                           sharing_mode,
+                                                                           Anvil::BufferCreateFlagBits::NONE,
+                                                                           m_usage_flags,
+                                                                           m_memory_features);
+
+        create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+
+        buffer_ptr = Anvil::Buffer::create(std::move(create_info_ptr) );
+    }
+
+    if (buffer_ptr == nullptr)
+    {
+        anvil_assert(buffer_ptr != nullptr);
+
+        goto end;
+    }
+
+    if ((m_memory_features & Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT) != 0)
+    {
+        if (!buffer_ptr->get_memory_block(0 /* in_n_memory_block */)->map(0, /* in_start_offset */
+                                                                          in_size,
+                                                                         &mapped_ptr) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    m_blocks.emplace_back(std::move(buffer_ptr),
+                          static_cast<unsigned char*>(mapped_ptr),
+                          in_size);
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::BufferSuballocator::free(const Allocation& in_allocation)
+{
+    lock();
+    {
+        Block*       block_ptr    = nullptr;
+        VkDeviceSize region_end   = 0;
+        VkDeviceSize region_start = 0;
+
+        anvil_assert(in_allocation.n_block < m_blocks.size() );
+        anvil_assert(in_allocation.size    > 0);
+
+        block_ptr    = &m_blocks.at(in_allocation.n_block);
+        region_start = in_allocation.offset;
+        region_end   = region_start + Anvil::Utils::round_up(in_allocation.size,
+                                                             m_alignment);
+
+        anvil_assert(block_ptr->buffer_ptr.get() == in_allocation.buffer_ptr);
+        anvil_assert(region_end                  <= block_ptr->size);
+
+        m_n_allocated_bytes -= region_end - region_start;
+
+        /* Coalesce with the neighbouring free ranges, if they are adjacent to the region. */
+        auto next_range_iterator = block_ptr->free_ranges.lower_bound(region_start);
+
+        anvil_assert(next_range_iterator == block_ptr->free_ranges.end() ||
+                     next_range_iterator->first >= region_end);
+
+        if (next_range_iterator != block_ptr->free_ranges.end() &&
+            next_range_iterator->first == region_end)
+        {
+            region_end = next_range_iterator->first + next_range_iterator->second;
+
+            next_range_iterator = block_ptr->free_ranges.erase(next_range_iterator);
+        }
+
+        if (next_range_iterator != block_ptr->free_ranges.begin() )
+        {
+            auto prev_range_iterator = std::prev(next_range_iterator);
+
+            anvil_assert(prev_range_iterator->first + prev_range_iterator->second <= region_start);
+
+            if (prev_range_iterator->first + prev_range_iterator->second == region_start)
+            {
+                region_start = prev_range_iterator->first;
+
+                block_ptr->free_ranges.erase(prev_range_iterator);
+            }
+        }
+
+        block_ptr->free_ranges[region_start] = region_end - region_start;
+    }
+    unlock();
+}
+
+/** Please see header for specification */
+VkDeviceSize Anvil::BufferSuballocator::get_n_allocated_bytes() const
+{
+    VkDeviceSize result;
+
+    lock();
+    {
+        result = m_n_allocated_bytes;
+    }
+    unlock();
+
+    return result;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::BufferSuballocator::get_n_blocks() const
+{
+    uint32_t result;
+
+    lock();
+    {
+        result = static_cast<uint32_t>(m_blocks.size() );
+    }
+    unlock();
+
+    return result;
+}
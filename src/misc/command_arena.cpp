@@ -0,0 +1,96 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/command_arena.h"
+#include "misc/debug.h"
+#include <cstddef>
+
+
+/** Please see header for specification */
+Anvil::CommandArena::CommandArena(size_t in_chunk_size)
+    :m_chunk_size          (in_chunk_size),
+     m_current_chunk_offset(0),
+     m_n_current_chunk     (0)
+{
+    anvil_assert(in_chunk_size > 0);
+}
+
+/** Please see header for specification */
+Anvil::CommandArena::~CommandArena()
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+void* Anvil::CommandArena::allocate(size_t in_size,
+                                    size_t in_alignment)
+{
+    void* result_ptr = nullptr;
+
+    anvil_assert(in_alignment                        != 0);
+    anvil_assert((in_alignment & (in_alignment - 1)) == 0);
+
+    if (in_size == 0)
+    {
+        in_size = 1;
+    }
+
+    /* Find the first chunk, starting from the current one, which can hold the requested region. Chunks which are
+     * too small are skipped. They are going to be reused after the arena is rewound. */
+    while (m_n_current_chunk < static_cast<uint32_t>(m_chunks.size() ) )
+    {
+        const auto&  current_chunk  = m_chunks.at(m_n_current_chunk);
+        const size_t aligned_offset = (m_current_chunk_offset + in_alignment - 1) & ~(in_alignment - 1);
+
+        if (aligned_offset + in_size <= current_chunk.size)
+        {
+            result_ptr             = current_chunk.data_ptr.get() + aligned_offset;
+            m_current_chunk_offset = aligned_offset + in_size;
+
+            goto end;
+        }
+
+        ++m_n_current_chunk;
+        m_current_chunk_offset = 0;
+    }
+
+    /* Out of space. Allocate a new chunk. new[] returns storage aligned for any fundamental type, which is enough
+     * for anything Anvil stores in the arena. */
+    anvil_assert(in_alignment <= alignof(std::max_align_t) );
+
+    m_chunks.emplace_back( (in_size > m_chunk_size) ? in_size
+                                                    : m_chunk_size);
+
+    m_n_current_chunk      = static_cast<uint32_t>(m_chunks.size() - 1);
+    m_current_chunk_offset = in_size;
+    result_ptr             = m_chunks.back().data_ptr.get();
+
+end:
+    return result_ptr;
+}
+
+/** Please see header for specification */
+void Anvil::CommandArena::reset()
+{
+    m_current_chunk_offset = 0;
+    m_n_current_chunk      = 0;
+}
@@ -0,0 +1,312 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#include "misc/command_buffer_frame_ring.h"
+#include "misc/debug.h"
+#include "misc/fence_create_info.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/command_pool.h"
+#include "wrappers/device.h"
+#include "wrappers/fence.h"
+
+
+/** Please see header for specification */
+Anvil::CommandBufferFrameRing::CommandBufferFrameRing(Anvil::BaseDevice* in_device_ptr,
+                                                      uint32_t           in_queue_family_index,
+                                                      bool               in_mt_safe)
+    :MTSafetySupportProvider(in_mt_safe,
+                             false), /* in_is_lock_recursive */
+     m_device_ptr           (in_device_ptr),
+     m_n_current_frame      (0),
+     m_queue_family_index   (in_queue_family_index)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::CommandBufferFrameRing::~CommandBufferFrameRing()
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr = get_mutex();
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr);
+    }
+
+    for (auto& current_frame : m_frames)
+    {
+        wait_for_frame(&current_frame);
+
+        /* Command buffers must go out of scope before their parent pool does. */
+        current_frame.primary_command_buffers.clear  ();
+        current_frame.secondary_command_buffers.clear();
+        current_frame.command_pool_ptr.reset         ();
+        current_frame.fence_ptr.reset                ();
+    }
+
+    m_frames.clear();
+}
+
+/** Please see header for specification */
+bool Anvil::CommandBufferFrameRing::begin_frame()
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr = get_mutex();
+    Frame*                                     frame_ptr = nullptr;
+    bool                                       result    = false;
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr);
+    }
+
+    m_n_current_frame = (m_n_current_frame + 1) % static_cast<uint32_t>(m_frames.size() );
+    frame_ptr         = &m_frames.at(m_n_current_frame);
+
+    if (!wait_for_frame(frame_ptr) )
+    {
+        goto end;
+    }
+
+    /* Resetting the whole pool returns all command buffers allocated for the slot to the initial state in a single call.
+     * Retain the memory backing the command buffers, since the slot is going to reuse it in the frame. */
+    if (frame_ptr->n_used_primary_command_buffers   > 0 ||
+        frame_ptr->n_used_secondary_command_buffers > 0)
+    {
+        if (!frame_ptr->command_pool_ptr->reset(false) ) /* in_release_resources */
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    /* Close the usage window of the slot's previous frame. This trims the pool if it has been holding on to
+     * far more memory than recent frames have needed. */
+    frame_ptr->command_pool_ptr->on_frame_end();
+
+    frame_ptr->n_used_primary_command_buffers   = 0;
+    frame_ptr->n_used_secondary_command_buffers = 0;
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::CommandBufferFrameRingUniquePtr Anvil::CommandBufferFrameRing::create(Anvil::BaseDevice* in_device_ptr,
+                                                                             uint32_t           in_queue_family_index,
+                                                                             uint32_t           in_n_frames_in_flight,
+                                                                             bool               in_mt_safe)
+{
+    Anvil::CommandBufferFrameRingUniquePtr result_ptr(nullptr,
+                                                      std::default_delete<Anvil::CommandBufferFrameRing>() );
+
+    anvil_assert(in_device_ptr         != nullptr);
+    anvil_assert(in_n_frames_in_flight >  0);
+
+    result_ptr.reset(
+        new Anvil::CommandBufferFrameRing(in_device_ptr,
+                                          in_queue_family_index,
+                                          in_mt_safe)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init(in_n_frames_in_flight) )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+Anvil::Fence* Anvil::CommandBufferFrameRing::get_fence()
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr = get_mutex();
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr);
+    }
+
+    auto& current_frame = m_frames.at(m_n_current_frame);
+
+    current_frame.is_fence_pending = true;
+
+    return current_frame.fence_ptr.get();
+}
+
+/** Please see header for specification */
+Anvil::PrimaryCommandBuffer* Anvil::CommandBufferFrameRing::get_primary_command_buffer()
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr = get_mutex();
+    Anvil::PrimaryCommandBuffer*               result_ptr = nullptr;
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr);
+    }
+
+    auto& current_frame = m_frames.at(m_n_current_frame);
+
+    if (current_frame.n_used_primary_command_buffers == current_frame.primary_command_buffers.size() )
+    {
+        auto new_cmd_buffer_ptr = current_frame.command_pool_ptr->alloc_primary_level_command_buffer();
+
+        if (new_cmd_buffer_ptr == nullptr)
+        {
+            anvil_assert(new_cmd_buffer_ptr != nullptr);
+
+            goto end;
+        }
+
+        current_frame.primary_command_buffers.push_back(std::move(new_cmd_buffer_ptr) );
+    }
+
+    result_ptr = current_frame.primary_command_buffers.at(current_frame.n_used_primary_command_buffers++).get();
+end:
+    return result_ptr;
+}
+
+/** Please see header for specification */
+Anvil::SecondaryCommandBuffer* Anvil::CommandBufferFrameRing::get_secondary_command_buffer()
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr = get_mutex();
+    Anvil::SecondaryCommandBuffer*             result_ptr = nullptr;
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr);
+    }
+
+    auto& current_frame = m_frames.at(m_n_current_frame);
+
+    if (current_frame.n_used_secondary_command_buffers == current_frame.secondary_command_buffers.size() )
+    {
+        auto new_cmd_buffer_ptr = current_frame.command_pool_ptr->alloc_secondary_level_command_buffer();
+
+        if (new_cmd_buffer_ptr == nullptr)
+        {
+            anvil_assert(new_cmd_buffer_ptr != nullptr);
+
+            goto end;
+        }
+
+        current_frame.secondary_command_buffers.push_back(std::move(new_cmd_buffer_ptr) );
+    }
+
+    result_ptr = current_frame.secondary_command_buffers.at(current_frame.n_used_secondary_command_buffers++).get();
+end:
+    return result_ptr;
+}
+
+/** Creates command pools & fences for all frame slots. */
+bool Anvil::CommandBufferFrameRing::init(uint32_t in_n_frames_in_flight)
+{
+    bool result = false;
+
+    m_frames.resize(in_n_frames_in_flight);
+
+    for (auto& current_frame : m_frames)
+    {
+        /* The ring's own lock serializes all accesses to the pools, so they need not be thread-safe. Command buffers are
+         * never reset individually, so RESET_COMMAND_BUFFER is not needed. */
+        current_frame.command_pool_ptr = Anvil::CommandPool::create(m_device_ptr,
+                                                                    Anvil::CommandPoolCreateFlagBits::CREATE_TRANSIENT_BIT,
+                                                                    m_queue_family_index,
+                                                                    Anvil::MTSafety::DISABLED);
+
+        if (current_frame.command_pool_ptr == nullptr)
+        {
+            anvil_assert(current_frame.command_pool_ptr != nullptr);
+
+            goto end;
+        }
+
+        {
+            auto create_info_ptr = Anvil::FenceCreateInfo::create(m_device_ptr,
+                                                                  false); /* in_create_signalled */
+
+            create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+
+            current_frame.fence_ptr = Anvil::Fence::create(std::move(create_info_ptr) );
+        }
+
+        if (current_frame.fence_ptr == nullptr)
+        {
+            anvil_assert(current_frame.fence_ptr != nullptr);
+
+            goto end;
+        }
+    }
+
+    /* begin_frame() advances to the next slot before using it, so make the first call pick slot 0. */
+    m_n_current_frame = in_n_frames_in_flight - 1;
+
+    result = true;
+end:
+    return result;
+}
+
+/** Blocks until the fence of the specified frame is signalled, if it has been handed out for the frame, and then
+ *  resets it.
+ *
+ *  @param in_frame_ptr Frame to wait on. Must not be null.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::CommandBufferFrameRing::wait_for_frame(Frame* in_frame_ptr)
+{
+    bool result = false;
+
+    if (in_frame_ptr->is_fence_pending)
+    {
+        if (!in_frame_ptr->fence_ptr->is_set() )
+        {
+            const VkResult result_vk = m_device_ptr->get_dispatch_table().vkWaitForFences(m_device_ptr->get_device_vk(),
+                                                                                          1, /* fenceCount */
+                                                                                          in_frame_ptr->fence_ptr->get_fence_ptr(),
+                                                                                          VK_TRUE,     /* waitAll */
+                                                                                          UINT64_MAX); /* timeout */
+
+            if (!is_vk_call_successful(result_vk) )
+            {
+                anvil_assert_vk_call_succeeded(result_vk);
+
+                goto end;
+            }
+        }
+
+        in_frame_ptr->fence_ptr->reset();
+        in_frame_ptr->is_fence_pending = false;
+    }
+
+    result = true;
+end:
+    return result;
+}
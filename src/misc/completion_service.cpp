@@ -0,0 +1,467 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "misc/completion_service.h"
+#include "misc/debug.h"
+#include "misc/semaphore_create_info.h"
+#include "wrappers/device.h"
+#include "wrappers/fence.h"
+#include "wrappers/semaphore.h"
+#include <algorithm>
+
+
+/** Please see header for specification */
+Anvil::CompletionService::CompletionService(const Anvil::BaseDevice* in_device_ptr)
+    :m_device_ptr                (in_device_ptr),
+     m_fence_wait_timeout_ns     (1000000), /* 1 ms */
+     m_has_failed                (false),
+     m_is_waiting                (false),
+     m_n_watches_being_dispatched(0),
+     m_next_watch_id             (1),
+     m_should_quit               (false),
+     m_wait_generation           (0),
+     m_wake_semaphore_value      (0)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::CompletionService::~CompletionService()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_should_quit = true;
+
+        wake_up();
+    }
+
+    if (m_thread.joinable() )
+    {
+        m_thread.join();
+    }
+}
+
+/** Please see header for specification */
+uint64_t Anvil::CompletionService::add_fence_callback(Anvil::Fence*   in_fence_ptr,
+                                                      const Callback& in_callback,
+                                                      const Executor& in_opt_executor)
+{
+    Watch new_watch;
+
+    anvil_assert(in_fence_ptr != nullptr);
+    anvil_assert(in_callback  != nullptr);
+
+    new_watch.callback  = in_callback;
+    new_watch.executor  = in_opt_executor;
+    new_watch.fence_ptr = in_fence_ptr;
+
+    return add_watch(new_watch);
+}
+
+/** Please see header for specification */
+uint64_t Anvil::CompletionService::add_timeline_callback(Anvil::Semaphore* in_semaphore_ptr,
+                                                         uint64_t          in_value,
+                                                         const Callback&   in_callback,
+                                                         const Executor&   in_opt_executor)
+{
+    Watch new_watch;
+
+    anvil_assert(in_semaphore_ptr != nullptr);
+    anvil_assert(in_semaphore_ptr->is_timeline() );
+    anvil_assert(in_callback      != nullptr);
+
+    new_watch.callback        = in_callback;
+    new_watch.executor        = in_opt_executor;
+    new_watch.semaphore_ptr   = in_semaphore_ptr;
+    new_watch.semaphore_value = in_value;
+
+    return add_watch(new_watch);
+}
+
+/** Assigns an ID to @param in_watch, appends it to the watch list and wakes up the watcher thread.
+ *
+ *  @return ID assigned to the watch.
+ **/
+uint64_t Anvil::CompletionService::add_watch(const Watch& in_watch)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    uint64_t                     result = m_next_watch_id++;
+
+    /* The watcher thread is gone, so the call-back would never be dispatched */
+    if (m_has_failed)
+    {
+        goto end;
+    }
+
+    m_watches.push_back(in_watch);
+    m_watches.back().id = result;
+
+    wake_up();
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::CompletionService::cancel(uint64_t in_id)
+{
+    std::unique_lock<std::mutex> lock  (m_mutex);
+    bool                         result(false);
+    auto                         watch_iterator = std::find_if(m_watches.begin(),
+                                                               m_watches.end  (),
+                                                               [in_id](const Watch& in_watch)
+                                                               {
+                                                                   return in_watch.id == in_id;
+                                                               });
+
+    if (watch_iterator == m_watches.end() )
+    {
+        goto end;
+    }
+
+    m_watches.erase(watch_iterator);
+
+    /* The watcher thread may still be waiting on the object. Make sure it is done with it before returning. */
+    if (m_is_waiting)
+    {
+        const uint64_t wait_generation = m_wait_generation;
+
+        wake_up();
+
+        m_dispatched_cv.wait(lock,
+                             [this, wait_generation]()
+                             {
+                                 return !m_is_waiting                      ||
+                                         m_wait_generation != wait_generation;
+                             });
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::CompletionServiceUniquePtr Anvil::CompletionService::create(const Anvil::BaseDevice* in_device_ptr)
+{
+    Anvil::CompletionServiceUniquePtr result_ptr(nullptr,
+                                                 std::default_delete<Anvil::CompletionService>() );
+
+    anvil_assert(in_device_ptr != nullptr);
+
+    result_ptr.reset(
+        new Anvil::CompletionService(in_device_ptr)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init() )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+Anvil::CompletionService::Executor Anvil::CompletionService::get_deferred_executor()
+{
+    return [this](const Callback& in_callback)
+    {
+        std::unique_lock<std::mutex> lock(m_deferred_callbacks_mutex);
+
+        m_deferred_callbacks.push_back(in_callback);
+    };
+}
+
+/** Please see header for specification */
+uint32_t Anvil::CompletionService::get_n_pending_callbacks() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    return static_cast<uint32_t>(m_watches.size() ) + m_n_watches_being_dispatched;
+}
+
+/** Please see header for specification */
+bool Anvil::CompletionService::has_failed() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    return m_has_failed;
+}
+
+/** Creates the wake-up semaphore, if timeline semaphores are supported, and spawns the watcher thread.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::CompletionService::init()
+{
+    bool result = false;
+
+    if (m_device_ptr->get_extension_info()->khr_timeline_semaphore() )
+    {
+        auto create_info_ptr = Anvil::SemaphoreCreateInfo::create(m_device_ptr);
+
+        create_info_ptr->set_timeline(m_wake_semaphore_value);
+
+        m_wake_semaphore_ptr = Anvil::Semaphore::create(std::move(create_info_ptr) );
+
+        if (m_wake_semaphore_ptr == nullptr)
+        {
+            anvil_assert(m_wake_semaphore_ptr != nullptr);
+
+            goto end;
+        }
+
+        m_wake_semaphore_ptr->set_name("Completion service wake-up semaphore");
+    }
+
+    m_thread = std::thread(&CompletionService::thread_main,
+                           this);
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::CompletionService::run_deferred_callbacks()
+{
+    std::deque<Callback> callbacks;
+    uint32_t             result = 0;
+
+    {
+        std::unique_lock<std::mutex> lock(m_deferred_callbacks_mutex);
+
+        callbacks.swap(m_deferred_callbacks);
+    }
+
+    for (const auto& current_callback : callbacks)
+    {
+        current_callback();
+
+        ++result;
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::CompletionService::set_fence_wait_timeout(uint64_t in_timeout_ns)
+{
+    anvil_assert(in_timeout_ns != 0);
+
+    m_fence_wait_timeout_ns = in_timeout_ns;
+}
+
+/** Watcher thread entry-point. */
+void Anvil::CompletionService::thread_main()
+{
+    std::vector<Anvil::Fence*>     fence_ptrs;
+    std::vector<Watch>             ready_watches;
+    std::vector<Anvil::Semaphore*> semaphore_ptrs;
+    std::vector<uint64_t>          semaphore_values;
+    VkResult                       wait_result_vk;
+
+    while (true)
+    {
+        fence_ptrs.clear      ();
+        semaphore_ptrs.clear  ();
+        semaphore_values.clear();
+
+        /* Snapshot the objects to wait on */
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_wake_cv.wait(lock,
+                           [this]()
+                           {
+                               return m_should_quit || !m_watches.empty();
+                           });
+
+            if (m_should_quit)
+            {
+                break;
+            }
+
+            for (const auto& current_watch : m_watches)
+            {
+                if (current_watch.fence_ptr != nullptr)
+                {
+                    fence_ptrs.push_back(current_watch.fence_ptr);
+                }
+                else
+                {
+                    semaphore_ptrs.push_back  (current_watch.semaphore_ptr);
+                    semaphore_values.push_back(current_watch.semaphore_value);
+                }
+            }
+
+            if (fence_ptrs.empty()             &&
+                m_wake_semaphore_ptr != nullptr)
+            {
+                semaphore_ptrs.push_back  (m_wake_semaphore_ptr.get() );
+                semaphore_values.push_back(m_wake_semaphore_value + 1);
+            }
+
+            m_is_waiting = true;
+        }
+
+        /* Wait until any of the objects is signalled. Fence waits cannot be interrupted from the host, so they
+         * time out periodically to pick up new registrations. */
+        if (!fence_ptrs.empty() )
+        {
+            Anvil::Fence::wait_fences(static_cast<uint32_t>(fence_ptrs.size() ),
+                                     &fence_ptrs.at(0),
+                                      false, /* in_wait_all */
+                                      m_fence_wait_timeout_ns,
+                                     &wait_result_vk);
+        }
+        else
+        {
+            Anvil::Semaphore::wait_semaphores(static_cast<uint32_t>(semaphore_ptrs.size() ),
+                                             &semaphore_ptrs.at(0),
+                                             &semaphore_values.at(0),
+                                              false, /* in_wait_all */
+                                              (m_wake_semaphore_ptr != nullptr) ? UINT64_MAX
+                                                                                : m_fence_wait_timeout_ns.load(),
+                                             &wait_result_vk);
+        }
+
+        /* A failed wait (eg. after device loss) would keep failing right away, so retrying would turn the thread
+         * into a busy loop. Drop all registrations instead, so that wait_idle() callers do not block forever. */
+        if (wait_result_vk != VK_SUCCESS &&
+            wait_result_vk != VK_TIMEOUT)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+
+                m_has_failed = true;
+                m_is_waiting = false;
+                m_wait_generation++;
+
+                m_watches.clear();
+            }
+
+            m_dispatched_cv.notify_all();
+
+            break;
+        }
+
+        /* Pull out all watches whose conditions are satisfied. Checking the objects directly also covers timeline
+         * semaphores which are watched alongside fences. */
+        ready_watches.clear();
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_is_waiting = false;
+            m_wait_generation++;
+
+            for (auto watch_iterator  = m_watches.begin();
+                      watch_iterator != m_watches.end  ();
+                     )
+            {
+                bool is_ready = false;
+
+                if (watch_iterator->fence_ptr != nullptr)
+                {
+                    is_ready = watch_iterator->fence_ptr->is_set();
+                }
+                else
+                {
+                    uint64_t counter_value = 0;
+
+                    is_ready = watch_iterator->semaphore_ptr->get_counter_value(&counter_value) &&
+                               counter_value >= watch_iterator->semaphore_value;
+                }
+
+                if (is_ready)
+                {
+                    ready_watches.push_back(*watch_iterator);
+
+                    watch_iterator = m_watches.erase(watch_iterator);
+                }
+                else
+                {
+                    ++watch_iterator;
+                }
+            }
+
+            m_n_watches_being_dispatched = static_cast<uint32_t>(ready_watches.size() );
+        }
+
+        m_dispatched_cv.notify_all();
+
+        /* Dispatch the call-backs with the service unlocked, so that they can register new ones. */
+        for (const auto& current_watch : ready_watches)
+        {
+            if (current_watch.executor != nullptr)
+            {
+                current_watch.executor(current_watch.callback);
+            }
+            else
+            {
+                current_watch.callback();
+            }
+        }
+
+        if (!ready_watches.empty() )
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+
+                m_n_watches_being_dispatched = 0;
+            }
+
+            m_dispatched_cv.notify_all();
+        }
+    }
+}
+
+/** Please see header for specification */
+void Anvil::CompletionService::wait_idle()
+{
+    std::unique_lock<std::mutex> lock       (m_mutex);
+    const uint64_t               last_id    (m_next_watch_id - 1);
+
+    m_dispatched_cv.wait(lock,
+                         [this, last_id]()
+                         {
+                             return (m_watches.empty() || m_watches.front().id > last_id) &&
+                                    m_n_watches_being_dispatched == 0;
+                         });
+}
+
+/** Wakes up the watcher thread. The service must be locked by the caller. */
+void Anvil::CompletionService::wake_up()
+{
+    if (m_wake_semaphore_ptr != nullptr)
+    {
+        m_wake_semaphore_ptr->signal(++m_wake_semaphore_value);
+    }
+
+    m_wake_cv.notify_one();
+}
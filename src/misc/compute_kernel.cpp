@@ -0,0 +1,290 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "misc/base_pipeline_create_info.h"
+#include "misc/compute_kernel.h"
+#include "misc/debug.h"
+#include "misc/shader_reflection.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/compute_pipeline_manager.h"
+#include "wrappers/device.h"
+#include "wrappers/physical_device.h"
+#include <cstring>
+
+/* Size of the batch header, which holds VkDispatchIndirectCommand followed by the number of dispatches */
+static const uint32_t g_batch_header_size = 4 * sizeof(uint32_t);
+
+
+/** Please see header for specification */
+Anvil::ComputeKernel::ComputeKernel(const Anvil::BaseDevice*       in_device_ptr,
+                                    PipelineID                     in_pipeline_id,
+                                    const std::array<uint32_t, 3>& in_local_workgroup_size)
+    :m_device_ptr          (in_device_ptr),
+     m_local_workgroup_size(in_local_workgroup_size),
+     m_n_batched_workgroups(0),
+     m_pipeline_id         (in_pipeline_id)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::ComputeKernel::~ComputeKernel()
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+uint32_t Anvil::ComputeKernel::add_batched_dispatch(uint32_t in_n_invocations)
+{
+    const uint32_t n_invocations_per_group = m_local_workgroup_size[0] * m_local_workgroup_size[1] * m_local_workgroup_size[2];
+    const uint32_t result                  = get_n_batched_dispatches();
+
+    anvil_assert(in_n_invocations > 0);
+
+    m_batched_dispatches.push_back(static_cast<uint32_t>(m_n_batched_workgroups) );
+    m_batched_dispatches.push_back(in_n_invocations);
+
+    m_n_batched_workgroups += (in_n_invocations + n_invocations_per_group - 1) / n_invocations_per_group;
+
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::ComputeKernel::bake_batch(Anvil::TransientBufferAllocator* in_allocator_ptr,
+                                      Batch*                           out_batch_ptr)
+{
+    Anvil::TransientBufferAllocator::Allocation allocation;
+    const uint32_t                              n_max_groups = m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits.max_compute_work_group_count[0];
+    bool                                        result       = false;
+
+    anvil_assert(in_allocator_ptr != nullptr);
+    anvil_assert(out_batch_ptr    != nullptr);
+
+    if (m_batched_dispatches.size() == 0)
+    {
+        anvil_assert(m_batched_dispatches.size() != 0);
+
+        goto end;
+    }
+
+    if (m_n_batched_workgroups > n_max_groups)
+    {
+        /* The app needs to split the batch */
+        anvil_assert(m_n_batched_workgroups <= n_max_groups);
+
+        goto end;
+    }
+
+    if (!in_allocator_ptr->allocate(g_batch_header_size + m_batched_dispatches.size() * sizeof(uint32_t),
+                                   &allocation) )
+    {
+        goto end;
+    }
+
+    {
+        const uint32_t header[] =
+        {
+            static_cast<uint32_t>(m_n_batched_workgroups),
+            1,
+            1,
+            get_n_batched_dispatches()
+        };
+
+        static_assert(sizeof(header) == g_batch_header_size,
+                      "Batch header size mismatch");
+
+        memcpy(allocation.mapped_ptr,
+               header,
+               sizeof(header) );
+        memcpy(static_cast<unsigned char*>(allocation.mapped_ptr) + g_batch_header_size,
+              &m_batched_dispatches.at(0),
+               m_batched_dispatches.size() * sizeof(uint32_t) );
+    }
+
+    out_batch_ptr->allocation   = allocation;
+    out_batch_ptr->n_dispatches = get_n_batched_dispatches();
+    out_batch_ptr->n_workgroups = static_cast<uint32_t>(m_n_batched_workgroups);
+
+    reset_batch();
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::ComputeKernelUniquePtr Anvil::ComputeKernel::create(const Anvil::BaseDevice* in_device_ptr,
+                                                           PipelineID               in_pipeline_id)
+{
+    const Anvil::BasePipelineCreateInfo*      create_info_ptr         = nullptr;
+    const Anvil::ShaderModuleStageEntryPoint* entrypoint_ptr          = nullptr;
+    std::array<uint32_t, 3>                   local_workgroup_size;
+    Anvil::ShaderReflectionUniquePtr          reflection_ptr;
+    Anvil::ComputeKernelUniquePtr             result_ptr              (nullptr,
+                                                                       std::default_delete<Anvil::ComputeKernel>() );
+    const Anvil::SpecializationConstants*     spec_constants_ptr      = nullptr;
+    const unsigned char*                      spec_constants_data_ptr = nullptr;
+
+    anvil_assert(in_device_ptr != nullptr);
+
+    create_info_ptr = in_device_ptr->get_compute_pipeline_manager()->get_pipeline_create_info(in_pipeline_id);
+
+    if (create_info_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    if (!create_info_ptr->get_shader_stage_properties(Anvil::ShaderStage::COMPUTE,
+                                                     &entrypoint_ptr) ||
+        entrypoint_ptr == nullptr)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    reflection_ptr = Anvil::ShaderReflection::create();
+
+    if (!reflection_ptr->add_shader_stage(*entrypoint_ptr) )
+    {
+        goto end;
+    }
+
+    local_workgroup_size = reflection_ptr->get_local_workgroup_size();
+
+    /* Pick up values the pipeline assigns to specialization constants which drive the workgroup size */
+    if (create_info_ptr->get_specialization_constants(Anvil::ShaderStage::COMPUTE,
+                                                     &spec_constants_ptr,
+                                                     &spec_constants_data_ptr) )
+    {
+        const auto& spec_ids = reflection_ptr->get_local_workgroup_size_spec_ids();
+
+        for (uint32_t n_component = 0;
+                      n_component < 3;
+                    ++n_component)
+        {
+            if (spec_ids[n_component] == UINT32_MAX)
+            {
+                continue;
+            }
+
+            for (const auto& current_spec_constant : *spec_constants_ptr)
+            {
+                if (current_spec_constant.constant_id == spec_ids[n_component] &&
+                    current_spec_constant.n_bytes     == sizeof(uint32_t)      &&
+                    spec_constants_data_ptr           != nullptr)
+                {
+                    memcpy(&local_workgroup_size[n_component],
+                            spec_constants_data_ptr + current_spec_constant.start_offset,
+                            sizeof(uint32_t) );
+                }
+            }
+        }
+    }
+
+    if (local_workgroup_size[0] == 0 ||
+        local_workgroup_size[1] == 0 ||
+        local_workgroup_size[2] == 0)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    result_ptr.reset(
+        new Anvil::ComputeKernel(in_device_ptr,
+                                 in_pipeline_id,
+                                 local_workgroup_size)
+    );
+
+end:
+    return result_ptr;
+}
+
+/** Please see header for specification */
+bool Anvil::ComputeKernel::get_n_workgroups(uint32_t                 in_x,
+                                            uint32_t                 in_y,
+                                            uint32_t                 in_z,
+                                            std::array<uint32_t, 3>* out_n_groups_ptr) const
+{
+    const uint32_t  problem_size[] = {in_x, in_y, in_z};
+    const uint32_t* n_max_groups   = m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits.max_compute_work_group_count;
+    bool            result         = true;
+
+    anvil_assert(out_n_groups_ptr != nullptr);
+
+    for (uint32_t n_component = 0;
+                  n_component < 3;
+                ++n_component)
+    {
+        const uint64_t n_groups = (static_cast<uint64_t>(problem_size[n_component]) + m_local_workgroup_size[n_component] - 1) / m_local_workgroup_size[n_component];
+
+        if (n_groups > n_max_groups[n_component])
+        {
+            result = false;
+        }
+
+        (*out_n_groups_ptr)[n_component] = static_cast<uint32_t>(n_groups);
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::ComputeKernel::record_batch(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                        const Batch&              in_batch) const
+{
+    anvil_assert(in_cmd_buffer_ptr              != nullptr);
+    anvil_assert(in_batch.allocation.buffer_ptr != nullptr);
+
+    return in_cmd_buffer_ptr->record_dispatch_indirect(in_batch.allocation.buffer_ptr,
+                                                       in_batch.allocation.offset);
+}
+
+/** Please see header for specification */
+bool Anvil::ComputeKernel::record_dispatch(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                           uint32_t                  in_x,
+                                           uint32_t                  in_y,
+                                           uint32_t                  in_z) const
+{
+    std::array<uint32_t, 3> n_groups;
+    bool                    result = false;
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    if (!get_n_workgroups(in_x,
+                          in_y,
+                          in_z,
+                         &n_groups) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    result = in_cmd_buffer_ptr->record_dispatch(n_groups[0],
+                                                n_groups[1],
+                                                n_groups[2]);
+end:
+    return result;
+}
@@ -20,8 +20,12 @@
 // THE SOFTWARE.
 //
 #include "misc/compute_pipeline_create_info.h"
+#include "misc/debug.h"
 
 Anvil::ComputePipelineCreateInfo::ComputePipelineCreateInfo()
+    :m_allow_varying_subgroup_size(false),
+     m_require_full_subgroups     (false),
+     m_required_subgroup_size     (0)
 {
     /* Stub */
 }
@@ -69,3 +73,32 @@ Anvil::ComputePipelineCreateInfoUniquePtr Anvil::ComputePipelineCreateInfo::crea
 
     return result_ptr;
 }
+
+bool Anvil::ComputePipelineCreateInfo::set_required_subgroup_size(uint32_t in_subgroup_size,
+                                                                  uint32_t in_opt_specialization_constant_id)
+{
+    bool result = false;
+
+    if ((in_subgroup_size & (in_subgroup_size - 1)) != 0)
+    {
+        anvil_assert((in_subgroup_size & (in_subgroup_size - 1)) == 0);
+
+        goto end;
+    }
+
+    if (in_opt_specialization_constant_id != UINT32_MAX &&
+        in_subgroup_size                  != 0)
+    {
+        if (!add_specialization_constant(in_opt_specialization_constant_id,
+                                         sizeof(in_subgroup_size),
+                                        &in_subgroup_size) )
+        {
+            goto end;
+        }
+    }
+
+    m_required_subgroup_size = in_subgroup_size;
+    result                   = true;
+end:
+    return result;
+}
@@ -0,0 +1,1210 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/compute_pipeline_create_info.h"
+#include "misc/compute_primitives.h"
+#include "misc/debug.h"
+#include "misc/descriptor_set_cache.h"
+#include "misc/descriptor_set_create_info.h"
+#include "misc/glsl_to_spirv.h"
+#include "wrappers/buffer.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/compute_pipeline_manager.h"
+#include "wrappers/descriptor_set_layout.h"
+#include "wrappers/device.h"
+#include "wrappers/shader_module.h"
+#include <algorithm>
+
+/* Must match the kernels' definitions */
+#define FLAG_EXCLUSIVE              (1u)
+#define FLAG_PREDICATE              (2u)
+#define FLAG_WRITE_BLOCK_SUMS       (4u)
+#define FLAG_HAS_VALUES             (8u)
+#define MAX_WORKGROUP_SIZE          (256u)
+#define N_ITEMS_PER_INVOCATION      (4u)
+#define N_RADIX_BINS                (16u)
+#define N_RADIX_BITS_PER_PASS       (4u)
+
+
+static const char* g_glsl_compute_primitives_comp =
+    "#version 450\n"
+    "\n"
+    "#ifdef USE_SUBGROUPS\n"
+    "    #extension GL_KHR_shader_subgroup_arithmetic : require\n"
+    "    #extension GL_KHR_shader_subgroup_basic      : require\n"
+    "#endif\n"
+    "\n"
+    "layout(local_size_x_id = 0) in;\n"
+    "\n"
+    "layout(constant_id = 1) const uint SUBGROUP_SIZE = 32;\n"
+    "\n"
+    "#define N_ITEMS_PER_INVOCATION 4u\n"
+    "#define N_RADIX_BINS           16u\n"
+    "#define RADIX_MASK             15u\n"
+    "#define WORKGROUP_SIZE         gl_WorkGroupSize.x\n"
+    "\n"
+    "#define FLAG_EXCLUSIVE        1u\n"
+    "#define FLAG_PREDICATE        2u\n"
+    "#define FLAG_WRITE_BLOCK_SUMS 4u\n"
+    "#define FLAG_HAS_VALUES       8u\n"
+    "\n"
+    "layout(push_constant) uniform pushConstants\n"
+    "{\n"
+    "    uint n_elements;\n"
+    "    uint n_blocks;\n"
+    "    uint flags;\n"
+    "    uint shift;\n"
+    "} pc;\n"
+    "\n"
+    "#ifdef USE_SUBGROUPS\n"
+    "    shared uint s_subgroup_sums[WORKGROUP_SIZE / SUBGROUP_SIZE];\n"
+    "#else\n"
+    "    shared uint s_scan[WORKGROUP_SIZE];\n"
+    "#endif\n"
+    "\n"
+    "/* Workgroups are laid out in two dimensions, so that large inputs do not exceed the dispatch size limits */\n"
+    "uint get_block_index()\n"
+    "{\n"
+    "    return gl_WorkGroupID.y * gl_NumWorkGroups.x + gl_WorkGroupID.x;\n"
+    "}\n"
+    "\n"
+    "/* Returns the inclusive prefix sum of @param value across the workgroup, and the sum of all values under @param total.\n"
+    " * Must be called in uniform control flow. */\n"
+    "uint workgroup_inclusive_scan(uint value, out uint total)\n"
+    "{\n"
+    "#ifdef USE_SUBGROUPS\n"
+    "    uint result = subgroupInclusiveAdd(value);\n"
+    "\n"
+    "    if (gl_SubgroupInvocationID == gl_SubgroupSize - 1u)\n"
+    "    {\n"
+    "        s_subgroup_sums[gl_SubgroupID] = result;\n"
+    "    }\n"
+    "\n"
+    "    barrier();\n"
+    "\n"
+    "    if (gl_SubgroupID == 0u)\n"
+    "    {\n"
+    "        uint subgroup_sum = (gl_SubgroupInvocationID < gl_NumSubgroups) ? s_subgroup_sums[gl_SubgroupInvocationID] : 0u;\n"
+    "\n"
+    "        subgroup_sum = subgroupInclusiveAdd(subgroup_sum);\n"
+    "\n"
+    "        if (gl_SubgroupInvocationID < gl_NumSubgroups)\n"
+    "        {\n"
+    "            s_subgroup_sums[gl_SubgroupInvocationID] = subgroup_sum;\n"
+    "        }\n"
+    "    }\n"
+    "\n"
+    "    barrier();\n"
+    "\n"
+    "    if (gl_SubgroupID > 0u)\n"
+    "    {\n"
+    "        result += s_subgroup_sums[gl_SubgroupID - 1u];\n"
+    "    }\n"
+    "\n"
+    "    total = s_subgroup_sums[gl_NumSubgroups - 1u];\n"
+    "#else\n"
+    "    uint n_invocation = gl_LocalInvocationIndex;\n"
+    "\n"
+    "    s_scan[n_invocation] = value;\n"
+    "\n"
+    "    barrier();\n"
+    "\n"
+    "    for (uint offset = 1u; offset < WORKGROUP_SIZE; offset <<= 1u)\n"
+    "    {\n"
+    "        uint addend = (n_invocation >= offset) ? s_scan[n_invocation - offset] : 0u;\n"
+    "\n"
+    "        barrier();\n"
+    "\n"
+    "        s_scan[n_invocation] += addend;\n"
+    "\n"
+    "        barrier();\n"
+    "    }\n"
+    "\n"
+    "    uint result = s_scan[n_invocation];\n"
+    "\n"
+    "    total = s_scan[WORKGROUP_SIZE - 1u];\n"
+    "#endif\n"
+    "\n"
+    "    /* Let the caller call the function again right away */\n"
+    "    barrier();\n"
+    "\n"
+    "    return result;\n"
+    "}\n"
+    "\n"
+    "#if defined(KERNEL_SCAN)\n"
+    "    layout(std430, set = 0, binding = 0) readonly buffer inputBlock\n"
+    "    {\n"
+    "        uint input_data[];\n"
+    "    };\n"
+    "    layout(std430, set = 0, binding = 1) buffer outputBlock\n"
+    "    {\n"
+    "        uint output_data[];\n"
+    "    };\n"
+    "    layout(std430, set = 0, binding = 2) writeonly buffer blockSumBlock\n"
+    "    {\n"
+    "        uint block_sums[];\n"
+    "    };\n"
+    "\n"
+    "    void main()\n"
+    "    {\n"
+    "        uint n_block = get_block_index();\n"
+    "\n"
+    "        if (n_block >= pc.n_blocks)\n"
+    "        {\n"
+    "            return;\n"
+    "        }\n"
+    "\n"
+    "        uint n_first_element = (n_block * WORKGROUP_SIZE + gl_LocalInvocationIndex) * N_ITEMS_PER_INVOCATION;\n"
+    "        uint invocation_sum  = 0u;\n"
+    "        uint values[N_ITEMS_PER_INVOCATION];\n"
+    "\n"
+    "        for (uint n_item = 0u; n_item < N_ITEMS_PER_INVOCATION; ++n_item)\n"
+    "        {\n"
+    "            uint n_element = n_first_element + n_item;\n"
+    "            uint value     = (n_element < pc.n_elements) ? input_data[n_element] : 0u;\n"
+    "\n"
+    "            if ((pc.flags & FLAG_PREDICATE) != 0u)\n"
+    "            {\n"
+    "                value = (value != 0u) ? 1u : 0u;\n"
+    "            }\n"
+    "\n"
+    "            values[n_item]  = value;\n"
+    "            invocation_sum += value;\n"
+    "        }\n"
+    "\n"
+    "        uint block_sum;\n"
+    "        uint running_sum = workgroup_inclusive_scan(invocation_sum, block_sum) - invocation_sum;\n"
+    "\n"
+    "        for (uint n_item = 0u; n_item < N_ITEMS_PER_INVOCATION; ++n_item)\n"
+    "        {\n"
+    "            uint n_element = n_first_element + n_item;\n"
+    "\n"
+    "            if (n_element < pc.n_elements)\n"
+    "            {\n"
+    "                output_data[n_element] = ((pc.flags & FLAG_EXCLUSIVE) != 0u) ? running_sum : running_sum + values[n_item];\n"
+    "            }\n"
+    "\n"
+    "            running_sum += values[n_item];\n"
+    "        }\n"
+    "\n"
+    "        if ((pc.flags & FLAG_WRITE_BLOCK_SUMS) != 0u &&\n"
+    "            gl_LocalInvocationIndex            == 0u)\n"
+    "        {\n"
+    "            block_sums[n_block] = block_sum;\n"
+    "        }\n"
+    "    }\n"
+    "#elif defined(KERNEL_ADD_BLOCK_OFFSETS)\n"
+    "    layout(std430, set = 0, binding = 0) buffer dataBlock\n"
+    "    {\n"
+    "        uint data[];\n"
+    "    };\n"
+    "    layout(std430, set = 0, binding = 1) readonly buffer blockOffsetBlock\n"
+    "    {\n"
+    "        uint block_offsets[];\n"
+    "    };\n"
+    "\n"
+    "    void main()\n"
+    "    {\n"
+    "        uint n_block = get_block_index();\n"
+    "\n"
+    "        if (n_block >= pc.n_blocks)\n"
+    "        {\n"
+    "            return;\n"
+    "        }\n"
+    "\n"
+    "        uint block_offset    = block_offsets[n_block];\n"
+    "        uint n_first_element = (n_block * WORKGROUP_SIZE + gl_LocalInvocationIndex) * N_ITEMS_PER_INVOCATION;\n"
+    "\n"
+    "        for (uint n_item = 0u; n_item < N_ITEMS_PER_INVOCATION; ++n_item)\n"
+    "        {\n"
+    "            uint n_element = n_first_element + n_item;\n"
+    "\n"
+    "            if (n_element < pc.n_elements)\n"
+    "            {\n"
+    "                data[n_element] += block_offset;\n"
+    "            }\n"
+    "        }\n"
+    "    }\n"
+    "#elif defined(KERNEL_COMPACT)\n"
+    "    layout(std430, set = 0, binding = 0) readonly buffer valueBlock\n"
+    "    {\n"
+    "        uint values[];\n"
+    "    };\n"
+    "    layout(std430, set = 0, binding = 1) readonly buffer flagBlock\n"
+    "    {\n"
+    "        uint flags[];\n"
+    "    };\n"
+    "    layout(std430, set = 0, binding = 2) readonly buffer indexBlock\n"
+    "    {\n"
+    "        uint indices[];\n"
+    "    };\n"
+    "    layout(std430, set = 0, binding = 3) writeonly buffer outputBlock\n"
+    "    {\n"
+    "        uint output_values[];\n"
+    "    };\n"
+    "    layout(std430, set = 0, binding = 4) writeonly buffer countBlock\n"
+    "    {\n"
+    "        uint count;\n"
+    "    };\n"
+    "\n"
+    "    void main()\n"
+    "    {\n"
+    "        uint n_element = get_block_index() * WORKGROUP_SIZE + gl_LocalInvocationIndex;\n"
+    "\n"
+    "        if (n_element >= pc.n_elements)\n"
+    "        {\n"
+    "            return;\n"
+    "        }\n"
+    "\n"
+    "        bool is_kept = (flags[n_element] != 0u);\n"
+    "\n"
+    "        if (is_kept)\n"
+    "        {\n"
+    "            output_values[indices[n_element]] = values[n_element];\n"
+    "        }\n"
+    "\n"
+    "        if (n_element == pc.n_elements - 1u)\n"
+    "        {\n"
+    "            count = indices[n_element] + (is_kept ? 1u : 0u);\n"
+    "        }\n"
+    "    }\n"
+    "#elif defined(KERNEL_RADIX_HISTOGRAM) || defined(KERNEL_RADIX_SCATTER)\n"
+    "    #ifdef USE_64BIT_KEYS\n"
+    "        #define KEY_TYPE uvec2\n"
+    "    #else\n"
+    "        #define KEY_TYPE uint\n"
+    "    #endif\n"
+    "\n"
+    "    layout(std430, set = 0, binding = 0) readonly buffer keyBlock\n"
+    "    {\n"
+    "        KEY_TYPE keys[];\n"
+    "    };\n"
+    "\n"
+    "    uint get_digit(KEY_TYPE key)\n"
+    "    {\n"
+    "        #ifdef USE_64BIT_KEYS\n"
+    "            return ((pc.shift < 32u) ? (key.x >> pc.shift) : (key.y >> (pc.shift - 32u) )) & RADIX_MASK;\n"
+    "        #else\n"
+    "            return (key >> pc.shift) & RADIX_MASK;\n"
+    "        #endif\n"
+    "    }\n"
+    "\n"
+    "    #if defined(KERNEL_RADIX_HISTOGRAM)\n"
+    "        layout(std430, set = 0, binding = 1) writeonly buffer histogramBlock\n"
+    "        {\n"
+    "            uint histogram[];\n"
+    "        };\n"
+    "\n"
+    "        shared uint s_histogram[N_RADIX_BINS];\n"
+    "\n"
+    "        void main()\n"
+    "        {\n"
+    "            uint n_block = get_block_index();\n"
+    "\n"
+    "            if (n_block >= pc.n_blocks)\n"
+    "            {\n"
+    "                return;\n"
+    "            }\n"
+    "\n"
+    "            uint n_element = n_block * WORKGROUP_SIZE + gl_LocalInvocationIndex;\n"
+    "\n"
+    "            if (gl_LocalInvocationIndex < N_RADIX_BINS)\n"
+    "            {\n"
+    "                s_histogram[gl_LocalInvocationIndex] = 0u;\n"
+    "            }\n"
+    "\n"
+    "            barrier();\n"
+    "\n"
+    "            if (n_element < pc.n_elements)\n"
+    "            {\n"
+    "                atomicAdd(s_histogram[get_digit(keys[n_element])], 1u);\n"
+    "            }\n"
+    "\n"
+    "            barrier();\n"
+    "\n"
+    "            /* Digit-major layout, so that an exclusive scan of the whole table yields each block's output offsets */\n"
+    "            if (gl_LocalInvocationIndex < N_RADIX_BINS)\n"
+    "            {\n"
+    "                histogram[gl_LocalInvocationIndex * pc.n_blocks + n_block] = s_histogram[gl_LocalInvocationIndex];\n"
+    "            }\n"
+    "        }\n"
+    "    #else\n"
+    "        layout(std430, set = 0, binding = 1) readonly buffer valueBlock\n"
+    "        {\n"
+    "            uint values[];\n"
+    "        };\n"
+    "        layout(std430, set = 0, binding = 2) writeonly buffer outputKeyBlock\n"
+    "        {\n"
+    "            KEY_TYPE output_keys[];\n"
+    "        };\n"
+    "        layout(std430, set = 0, binding = 3) writeonly buffer outputValueBlock\n"
+    "        {\n"
+    "            uint output_values[];\n"
+    "        };\n"
+    "        layout(std430, set = 0, binding = 4) readonly buffer histogramBlock\n"
+    "        {\n"
+    "            uint histogram_offsets[];\n"
+    "        };\n"
+    "\n"
+    "        shared uint s_digit_start[N_RADIX_BINS];\n"
+    "        shared uint s_elements   [WORKGROUP_SIZE];\n"
+    "\n"
+    "        void main()\n"
+    "        {\n"
+    "            uint n_block = get_block_index();\n"
+    "\n"
+    "            if (n_block >= pc.n_blocks)\n"
+    "            {\n"
+    "                return;\n"
+    "            }\n"
+    "\n"
+    "            uint n_first_element = n_block * WORKGROUP_SIZE;\n"
+    "            uint n_invocation    = gl_LocalInvocationIndex;\n"
+    "            uint n_element       = n_first_element + n_invocation;\n"
+    "\n"
+    "            /* Elements past the end of the input sort after all valid ones, and are never written out */\n"
+    "            uint element = (n_invocation << 4u) | ((n_element < pc.n_elements) ? get_digit(keys[n_element]) : RADIX_MASK);\n"
+    "\n"
+    "            /* Sort the block by digit locally, with one stable split per digit bit. Each element holds the index\n"
+    "             * of the invocation it originates from, and its digit. */\n"
+    "            for (uint n_bit = 0u; n_bit < 4u; ++n_bit)\n"
+    "            {\n"
+    "                uint is_set = (element >> n_bit) & 1u;\n"
+    "                uint n_zeros;\n"
+    "                uint n_zeros_before = workgroup_inclusive_scan(1u - is_set, n_zeros) - (1u - is_set);\n"
+    "                uint n_slot         = (is_set == 0u) ? n_zeros_before\n"
+    "                                                     : n_zeros + n_invocation - n_zeros_before;\n"
+    "\n"
+    "                s_elements[n_slot] = element;\n"
+    "\n"
+    "                barrier();\n"
+    "\n"
+    "                element = s_elements[n_invocation];\n"
+    "\n"
+    "                barrier();\n"
+    "            }\n"
+    "\n"
+    "            uint digit = element & RADIX_MASK;\n"
+    "\n"
+    "            if (n_invocation == 0u || (s_elements[n_invocation - 1u] & RADIX_MASK) != digit)\n"
+    "            {\n"
+    "                s_digit_start[digit] = n_invocation;\n"
+    "            }\n"
+    "\n"
+    "            barrier();\n"
+    "\n"
+    "            uint n_source_element = n_first_element + (element >> 4u);\n"
+    "\n"
+    "            if (n_source_element < pc.n_elements)\n"
+    "            {\n"
+    "                uint n_output_element = histogram_offsets[digit * pc.n_blocks + n_block] + n_invocation - s_digit_start[digit];\n"
+    "\n"
+    "                output_keys[n_output_element] = keys[n_source_element];\n"
+    "\n"
+    "                if ((pc.flags & FLAG_HAS_VALUES) != 0u)\n"
+    "                {\n"
+    "                    output_values[n_output_element] = values[n_source_element];\n"
+    "                }\n"
+    "            }\n"
+    "        }\n"
+    "    #endif\n"
+    "#endif\n";
+
+/* Definitions which select each of the kernels, in the order they are declared in, and the number of storage buffers they access */
+static const struct
+{
+    const char* kernel_definition;
+    const char* key_definition;
+    uint32_t    n_bindings;
+} g_kernel_infos[] =
+{
+    {"KERNEL_ADD_BLOCK_OFFSETS", nullptr,          2},
+    {"KERNEL_COMPACT",           nullptr,          5},
+    {"KERNEL_RADIX_HISTOGRAM",   nullptr,          2},
+    {"KERNEL_RADIX_HISTOGRAM",   "USE_64BIT_KEYS", 2},
+    {"KERNEL_RADIX_SCATTER",     nullptr,          5},
+    {"KERNEL_RADIX_SCATTER",     "USE_64BIT_KEYS", 5},
+    {"KERNEL_SCAN",              nullptr,          3},
+};
+
+
+/** Please see header for specification */
+Anvil::ComputePrimitives::ComputePrimitives(const Anvil::BaseDevice* in_device_ptr)
+    :m_device_ptr    (in_device_ptr),
+     m_subgroup_size (0),
+     m_workgroup_size(0)
+{
+    static_assert(sizeof(g_kernel_infos) / sizeof(g_kernel_infos[0]) == KERNEL_COUNT,
+                  "Kernel info table does not match the kernel enum");
+}
+
+/** Please see header for specification */
+Anvil::ComputePrimitives::~ComputePrimitives()
+{
+    auto compute_pipeline_manager_ptr = m_device_ptr->get_compute_pipeline_manager();
+
+    /* Release the sets before the layouts they use */
+    m_ds_cache_ptr.reset();
+
+    for (auto& current_kernel : m_kernels)
+    {
+        if (current_kernel.pipeline_id != UINT32_MAX)
+        {
+            compute_pipeline_manager_ptr->delete_pipeline(current_kernel.pipeline_id);
+
+            current_kernel.pipeline_id = UINT32_MAX;
+        }
+    }
+}
+
+/** Rounds @param in_size up to the device's storage buffer offset alignment, so that scratch sub-ranges laid out
+ *  one after another can be bound as storage buffers. */
+VkDeviceSize Anvil::ComputePrimitives::align_scratch_size(VkDeviceSize in_size) const
+{
+    const VkDeviceSize alignment = std::max(m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits.min_storage_buffer_offset_alignment,
+                                            static_cast<VkDeviceSize>(1) );
+
+    return (in_size + alignment - 1) / alignment * alignment;
+}
+
+/** Please see header for specification */
+Anvil::ComputePrimitivesUniquePtr Anvil::ComputePrimitives::create(const Anvil::BaseDevice* in_device_ptr)
+{
+    Anvil::ComputePrimitivesUniquePtr result_ptr(nullptr,
+                                                 std::default_delete<Anvil::ComputePrimitives>() );
+
+    anvil_assert(in_device_ptr != nullptr);
+
+    result_ptr.reset(
+        new Anvil::ComputePrimitives(in_device_ptr)
+    );
+
+    if (!result_ptr->init() )
+    {
+        result_ptr.reset();
+    }
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+VkDeviceSize Anvil::ComputePrimitives::get_compaction_scratch_buffer_size(uint32_t in_n_elements) const
+{
+    /* Exclusive scan of the flags, which yields output indices, followed by the scan's own scratch memory */
+    return align_scratch_size          (static_cast<VkDeviceSize>(in_n_elements) * sizeof(uint32_t) ) +
+           get_scan_scratch_buffer_size(in_n_elements);
+}
+
+/** Returns the number of workgroups the scan kernel needs to cover the specified number of elements. */
+uint32_t Anvil::ComputePrimitives::get_n_scan_blocks(uint32_t in_n_elements) const
+{
+    const uint64_t n_elements_per_block = static_cast<uint64_t>(m_workgroup_size) * N_ITEMS_PER_INVOCATION;
+
+    return static_cast<uint32_t>( (static_cast<uint64_t>(in_n_elements) + n_elements_per_block - 1) / n_elements_per_block);
+}
+
+/** Please see header for specification */
+VkDeviceSize Anvil::ComputePrimitives::get_scan_scratch_buffer_size(uint32_t in_n_elements) const
+{
+    uint32_t     n_elements = in_n_elements;
+    VkDeviceSize result     = 0;
+
+    /* Each level which spans more than one block stores its block sums, which are then scanned by the next level */
+    while (get_n_scan_blocks(n_elements) > 1)
+    {
+        n_elements = get_n_scan_blocks(n_elements);
+        result    += align_scratch_size(static_cast<VkDeviceSize>(n_elements) * sizeof(uint32_t) );
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+VkDeviceSize Anvil::ComputePrimitives::get_sort_scratch_buffer_size(KeyType  in_key_type,
+                                                                    uint32_t in_n_elements,
+                                                                    bool     in_has_values) const
+{
+    const VkDeviceSize key_size          = (in_key_type == KeyType::UINT64) ? sizeof(uint64_t) : sizeof(uint32_t);
+    const uint32_t     n_blocks          = (in_n_elements + m_workgroup_size - 1) / m_workgroup_size;
+    const uint32_t     n_histogram_items = n_blocks * N_RADIX_BINS;
+    VkDeviceSize       result            = 0;
+
+    /* Keys (and values) are ping-ponged between the app's buffers and the scratch memory */
+    result += align_scratch_size(key_size * in_n_elements);
+
+    if (in_has_values)
+    {
+        result += align_scratch_size(static_cast<VkDeviceSize>(in_n_elements) * sizeof(uint32_t) );
+    }
+
+    result += align_scratch_size          (static_cast<VkDeviceSize>(n_histogram_items) * sizeof(uint32_t) );
+    result += get_scan_scratch_buffer_size(n_histogram_items);
+
+    return result;
+}
+
+/** Picks the workgroup size and the kernel flavor, compiles all kernels and bakes their pipelines.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::ComputePrimitives::init()
+{
+    const auto& device_properties = m_device_ptr->get_physical_device_properties();
+    const auto& limits            = device_properties.core_vk1_0_properties_ptr->limits;
+    uint32_t    max_workgroup_size = std::min(MAX_WORKGROUP_SIZE,
+                                              std::min(limits.max_compute_work_group_invocations,
+                                                       limits.max_compute_work_group_size[0]) );
+    bool        result             = false;
+
+    /* Subgroup operations need a Vulkan 1.1 device. The second level of the workgroup scan is performed by a single
+     * subgroup, so the workgroup must not hold more subgroups than there are invocations in a subgroup. */
+    if (device_properties.core_vk1_1_properties_ptr != nullptr)
+    {
+        const auto& subgroup_properties = device_properties.core_vk1_1_properties_ptr->subgroup_properties;
+
+        if ((subgroup_properties.supported_stages     & Anvil::ShaderStageFlagBits::COMPUTE_BIT)        != 0 &&
+            (subgroup_properties.supported_operations & Anvil::SubgroupFeatureFlagBits::ARITHMETIC_BIT) != 0 &&
+            (subgroup_properties.supported_operations & Anvil::SubgroupFeatureFlagBits::BASIC_BIT)      != 0 &&
+             subgroup_properties.subgroup_size        >= 4                                                   &&
+             subgroup_properties.subgroup_size        <= max_workgroup_size)
+        {
+            m_subgroup_size    = subgroup_properties.subgroup_size;
+            max_workgroup_size = std::min(max_workgroup_size,
+                                          m_subgroup_size * m_subgroup_size);
+        }
+    }
+
+    /* Largest power of two which fits. The radix kernels need at least one invocation per bin. */
+    m_workgroup_size = 1;
+
+    while (m_workgroup_size * 2 <= max_workgroup_size)
+    {
+        m_workgroup_size *= 2;
+    }
+
+    if (m_workgroup_size < N_RADIX_BINS)
+    {
+        anvil_assert(m_workgroup_size >= N_RADIX_BINS);
+
+        goto end;
+    }
+
+    m_ds_cache_ptr = Anvil::DescriptorSetCache::create(m_device_ptr,
+                                                       64,   /* in_n_sets_per_pool             */
+                                                       320); /* in_n_descriptors_per_type_pool */
+
+    if (m_ds_cache_ptr == nullptr)
+    {
+        anvil_assert(m_ds_cache_ptr != nullptr);
+
+        goto end;
+    }
+
+    for (uint32_t n_kernel = 0;
+                  n_kernel < KERNEL_COUNT;
+                ++n_kernel)
+    {
+        if (!init_kernel(n_kernel) )
+        {
+            goto end;
+        }
+    }
+
+    if (!m_device_ptr->get_compute_pipeline_manager()->bake() )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Compiles the specified kernel, and creates a descriptor set layout and a compute pipeline which uses it.
+ *  The pipeline is baked by init().
+ *
+ *  @param in_n_kernel Index of the kernel to initialize.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::ComputePrimitives::init_kernel(uint32_t in_n_kernel)
+{
+    auto                                       compute_pipeline_manager_ptr = m_device_ptr->get_compute_pipeline_manager();
+    Anvil::GLSLShaderToSPIRVGeneratorUniquePtr glsl_ptr;
+    Kernel&                                    kernel                       = m_kernels[in_n_kernel];
+    const auto&                                kernel_info                  = g_kernel_infos[in_n_kernel];
+    bool                                       result                       = false;
+
+    /* Subgroup operations need SPIR-V 1.3 */
+    glsl_ptr = Anvil::GLSLShaderToSPIRVGenerator::create(m_device_ptr,
+                                                         Anvil::GLSLShaderToSPIRVGenerator::MODE_USE_SPECIFIED_SOURCE,
+                                                         g_glsl_compute_primitives_comp,
+                                                         Anvil::ShaderStage::COMPUTE,
+                                                         (m_subgroup_size != 0) ? Anvil::SpvVersion::_1_3
+                                                                                : Anvil::SpvVersion::_1_0);
+
+    if (glsl_ptr == nullptr)
+    {
+        anvil_assert(glsl_ptr != nullptr);
+
+        goto end;
+    }
+
+    glsl_ptr->add_empty_definition(kernel_info.kernel_definition);
+
+    if (kernel_info.key_definition != nullptr)
+    {
+        glsl_ptr->add_empty_definition(kernel_info.key_definition);
+    }
+
+    if (m_subgroup_size != 0)
+    {
+        glsl_ptr->add_empty_definition("USE_SUBGROUPS");
+    }
+
+    kernel.n_bindings        = kernel_info.n_bindings;
+    kernel.shader_module_ptr = Anvil::ShaderModule::create_from_spirv_generator(m_device_ptr,
+                                                                                glsl_ptr.get() );
+
+    if (kernel.shader_module_ptr == nullptr)
+    {
+        anvil_assert(kernel.shader_module_ptr != nullptr);
+
+        goto end;
+    }
+
+    kernel.entrypoint_ptr.reset(
+        new Anvil::ShaderModuleStageEntryPoint("main",
+                                               kernel.shader_module_ptr.get(),
+                                               Anvil::ShaderStage::COMPUTE)
+    );
+
+    {
+        auto ds_create_info_ptr = Anvil::DescriptorSetCreateInfo::create();
+
+        for (uint32_t n_binding = 0;
+                      n_binding < kernel.n_bindings;
+                    ++n_binding)
+        {
+            ds_create_info_ptr->add_binding(n_binding,
+                                            Anvil::DescriptorType::STORAGE_BUFFER,
+                                            1, /* in_descriptor_array_size */
+                                            Anvil::ShaderStageFlagBits::COMPUTE_BIT);
+        }
+
+        kernel.ds_layout_ptr = Anvil::DescriptorSetLayout::create(std::move(ds_create_info_ptr),
+                                                                  m_device_ptr);
+    }
+
+    if (kernel.ds_layout_ptr == nullptr)
+    {
+        anvil_assert(kernel.ds_layout_ptr != nullptr);
+
+        goto end;
+    }
+
+    {
+        const std::vector<const Anvil::DescriptorSetCreateInfo*> ds_create_info_ptrs(1,
+                                                                                      kernel.ds_layout_ptr->get_create_info() );
+        auto                                                     pipeline_create_info_ptr = Anvil::ComputePipelineCreateInfo::create(Anvil::PipelineCreateFlagBits::NONE,
+                                                                                                                                     *kernel.entrypoint_ptr);
+
+        /* Specialize the kernel for the workgroup & subgroup sizes picked at init time */
+        pipeline_create_info_ptr->add_specialization_constant   (0, /* in_constant_id */
+                                                                 sizeof(m_workgroup_size),
+                                                                &m_workgroup_size);
+        pipeline_create_info_ptr->add_specialization_constant   (1, /* in_constant_id */
+                                                                 sizeof(m_subgroup_size),
+                                                                &m_subgroup_size);
+        pipeline_create_info_ptr->attach_push_constant_range    (0, /* in_offset */
+                                                                 sizeof(PushConstants),
+                                                                 Anvil::ShaderStageFlagBits::COMPUTE_BIT);
+        pipeline_create_info_ptr->set_descriptor_set_create_info(&ds_create_info_ptrs);
+
+        if (!compute_pipeline_manager_ptr->add_pipeline(std::move(pipeline_create_info_ptr),
+                                                       &kernel.pipeline_id) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Records a compute-to-compute memory barrier, which makes the results of a dispatch visible to the next one. */
+bool Anvil::ComputePrimitives::record_barrier(Anvil::CommandBufferBase* in_cmd_buffer_ptr) const
+{
+    const Anvil::MemoryBarrier barrier(Anvil::AccessFlagBits::SHADER_READ_BIT | Anvil::AccessFlagBits::SHADER_WRITE_BIT, /* in_destination_access_mask */
+                                       Anvil::AccessFlagBits::SHADER_WRITE_BIT);                                         /* in_source_access_mask      */
+
+    return in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::COMPUTE_SHADER_BIT,
+                                                      Anvil::PipelineStageFlagBits::COMPUTE_SHADER_BIT,
+                                                      Anvil::DependencyFlagBits::NONE,
+                                                      1,       /* in_memory_barrier_count        */
+                                                     &barrier,
+                                                      0,       /* in_buffer_memory_barrier_count */
+                                                      nullptr, /* in_buffer_memory_barrier_ptrs  */
+                                                      0,       /* in_image_memory_barrier_count  */
+                                                      nullptr);
+}
+
+/** Please see header for specification */
+bool Anvil::ComputePrimitives::record_compaction(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                                 const CompactionInfo&     in_info)
+{
+    const VkDeviceSize n_element_bytes = static_cast<VkDeviceSize>(in_info.n_elements) * sizeof(uint32_t);
+    PushConstants      push_constants;
+    bool               result          = false;
+
+    anvil_assert(in_cmd_buffer_ptr          != nullptr);
+    anvil_assert(in_info.count_buffer_ptr   != nullptr);
+    anvil_assert(in_info.flag_buffer_ptr    != nullptr);
+    anvil_assert(in_info.input_buffer_ptr   != nullptr);
+    anvil_assert(in_info.output_buffer_ptr  != nullptr);
+    anvil_assert(in_info.scratch_buffer_ptr != nullptr);
+
+    if (in_info.n_elements == 0)
+    {
+        /* Nothing to dispatch. Only the count needs to be written. */
+        result = in_cmd_buffer_ptr->record_fill_buffer(in_info.count_buffer_ptr,
+                                                       in_info.count_buffer_offset,
+                                                       sizeof(uint32_t),
+                                                       0); /* in_data */
+
+        goto end;
+    }
+
+    {
+        const BufferRange index_range(in_info.scratch_buffer_ptr,
+                                      in_info.scratch_buffer_offset,
+                                      n_element_bytes);
+
+        /* Output indices are the exclusive prefix sums of the flags, treated as 0 or 1 */
+        if (!record_scan_level(in_cmd_buffer_ptr,
+                               BufferRange(in_info.flag_buffer_ptr,
+                                           in_info.flag_buffer_offset,
+                                           n_element_bytes),
+                               index_range,
+                               in_info.scratch_buffer_ptr,
+                               in_info.scratch_buffer_offset + align_scratch_size(n_element_bytes),
+                               in_info.n_elements,
+                               FLAG_EXCLUSIVE | FLAG_PREDICATE) ||
+            !record_barrier   (in_cmd_buffer_ptr) )
+        {
+            goto end;
+        }
+
+        {
+            const BufferRange buffer_ranges[] =
+            {
+                BufferRange(in_info.input_buffer_ptr,  in_info.input_buffer_offset,  n_element_bytes),
+                BufferRange(in_info.flag_buffer_ptr,   in_info.flag_buffer_offset,   n_element_bytes),
+                index_range,
+                BufferRange(in_info.output_buffer_ptr, in_info.output_buffer_offset, n_element_bytes),
+                BufferRange(in_info.count_buffer_ptr,  in_info.count_buffer_offset,  sizeof(uint32_t) )
+            };
+
+            push_constants.n_elements = in_info.n_elements;
+            push_constants.n_blocks   = (in_info.n_elements + m_workgroup_size - 1) / m_workgroup_size;
+
+            if (!record_kernel(in_cmd_buffer_ptr,
+                               KERNEL_COMPACT,
+                               push_constants,
+                               buffer_ranges) )
+            {
+                goto end;
+            }
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Binds the specified kernel along with a descriptor set holding @param in_buffer_ranges, and dispatches one
+ *  workgroup per block, as specified in the push constants. Workgroups are laid out in two dimensions if the block
+ *  count exceeds the device's limit for a single dimension.
+ *
+ *  @param in_cmd_buffer_ptr Command buffer to record the commands to.
+ *  @param in_n_kernel       Index of the kernel to dispatch.
+ *  @param in_push_constants Push constants to use. n_blocks must not be 0.
+ *  @param in_buffer_ranges  Buffer ranges to bind, one per binding of the kernel.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::ComputePrimitives::record_kernel(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                             uint32_t                  in_n_kernel,
+                                             const PushConstants&      in_push_constants,
+                                             const BufferRange*        in_buffer_ranges)
+{
+    Anvil::DescriptorSetCache::Contents ds_contents;
+    Anvil::DescriptorSet*               ds_ptr              = nullptr;
+    const Kernel&                       kernel              = m_kernels[in_n_kernel];
+    const uint32_t*                     n_max_groups        = m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits.max_compute_work_group_count;
+    uint32_t                            n_groups_x          = 0;
+    uint32_t                            n_groups_y          = 0;
+    Anvil::PipelineLayout*              pipeline_layout_ptr = nullptr;
+    bool                                result              = false;
+
+    anvil_assert(in_push_constants.n_blocks > 0);
+
+    n_groups_x = std::min(in_push_constants.n_blocks,
+                          n_max_groups[0]);
+    n_groups_y = (in_push_constants.n_blocks + n_groups_x - 1) / n_groups_x;
+
+    if (n_groups_y > n_max_groups[1])
+    {
+        anvil_assert(n_groups_y <= n_max_groups[1]);
+
+        goto end;
+    }
+
+    for (uint32_t n_binding = 0;
+                  n_binding < kernel.n_bindings;
+                ++n_binding)
+    {
+        ds_contents.set_binding_item(n_binding,
+                                     Anvil::DescriptorSet::StorageBufferBindingElement(in_buffer_ranges[n_binding].buffer_ptr,
+                                                                                       in_buffer_ranges[n_binding].offset,
+                                                                                       in_buffer_ranges[n_binding].size) );
+    }
+
+    ds_ptr = m_ds_cache_ptr->get_descriptor_set(kernel.ds_layout_ptr.get(),
+                                                ds_contents);
+
+    if (ds_ptr == nullptr)
+    {
+        anvil_assert(ds_ptr != nullptr);
+
+        goto end;
+    }
+
+    pipeline_layout_ptr = m_device_ptr->get_compute_pipeline_manager()->get_pipeline_layout(kernel.pipeline_id);
+
+    in_cmd_buffer_ptr->record_bind_pipeline       (Anvil::PipelineBindPoint::COMPUTE,
+                                                   kernel.pipeline_id);
+    in_cmd_buffer_ptr->record_bind_descriptor_sets(Anvil::PipelineBindPoint::COMPUTE,
+                                                   pipeline_layout_ptr,
+                                                   0, /* in_first_set */
+                                                   1, /* in_set_count */
+                                                  &ds_ptr,
+                                                   0,        /* in_dynamic_offset_count */
+                                                   nullptr); /* in_dynamic_offset_ptrs  */
+    in_cmd_buffer_ptr->record_push_constants      (pipeline_layout_ptr,
+                                                   Anvil::ShaderStageFlagBits::COMPUTE_BIT,
+                                                   0, /* in_offset */
+                                                   sizeof(in_push_constants),
+                                                  &in_push_constants);
+
+    result = in_cmd_buffer_ptr->record_dispatch(n_groups_x,
+                                                n_groups_y,
+                                                1); /* in_z */
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::ComputePrimitives::record_scan(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                           const ScanInfo&           in_info)
+{
+    const VkDeviceSize n_element_bytes = static_cast<VkDeviceSize>(in_info.n_elements) * sizeof(uint32_t);
+
+    anvil_assert(in_cmd_buffer_ptr        != nullptr);
+    anvil_assert(in_info.input_buffer_ptr  != nullptr);
+    anvil_assert(in_info.output_buffer_ptr != nullptr);
+
+    if (in_info.n_elements == 0)
+    {
+        return true;
+    }
+
+    anvil_assert(in_info.scratch_buffer_ptr                      != nullptr ||
+                 get_scan_scratch_buffer_size(in_info.n_elements) == 0);
+
+    return record_scan_level(in_cmd_buffer_ptr,
+                             BufferRange(in_info.input_buffer_ptr,
+                                         in_info.input_buffer_offset,
+                                         n_element_bytes),
+                             BufferRange(in_info.output_buffer_ptr,
+                                         in_info.output_buffer_offset,
+                                         n_element_bytes),
+                             in_info.scratch_buffer_ptr,
+                             in_info.scratch_buffer_offset,
+                             in_info.n_elements,
+                             (in_info.type == ScanType::EXCLUSIVE) ? FLAG_EXCLUSIVE : 0);
+}
+
+/** Records a scan of @param in_n_elements elements. If the input spans more than one block, the block sums are
+ *  stored at the start of the scratch range, scanned recursively with the rest of the scratch range, and added
+ *  back to the output.
+ *
+ *  @param in_cmd_buffer_ptr        Command buffer to record the commands to.
+ *  @param in_input_range           Input elements.
+ *  @param in_output_range          Range to store the prefix sums in. May be the same as the input range.
+ *  @param in_scratch_buffer_ptr    Scratch buffer.
+ *  @param in_scratch_buffer_offset Start of the scratch range. Must hold get_scan_scratch_buffer_size(in_n_elements) bytes.
+ *  @param in_n_elements            Number of elements to scan. Must not be 0.
+ *  @param in_flags                 FLAG_EXCLUSIVE and/or FLAG_PREDICATE.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::ComputePrimitives::record_scan_level(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                                 const BufferRange&        in_input_range,
+                                                 const BufferRange&        in_output_range,
+                                                 Anvil::Buffer*            in_scratch_buffer_ptr,
+                                                 VkDeviceSize              in_scratch_buffer_offset,
+                                                 uint32_t                  in_n_elements,
+                                                 uint32_t                  in_flags)
+{
+    PushConstants push_constants;
+    bool          result = false;
+
+    push_constants.flags      = in_flags;
+    push_constants.n_blocks   = get_n_scan_blocks(in_n_elements);
+    push_constants.n_elements = in_n_elements;
+
+    if (push_constants.n_blocks == 1)
+    {
+        /* The block sum is not needed, so the output range stands in for the block sum buffer */
+        const BufferRange buffer_ranges[] =
+        {
+            in_input_range,
+            in_output_range,
+            in_output_range
+        };
+
+        result = record_kernel(in_cmd_buffer_ptr,
+                               KERNEL_SCAN,
+                               push_constants,
+                               buffer_ranges);
+    }
+    else
+    {
+        const BufferRange block_sum_range(in_scratch_buffer_ptr,
+                                          in_scratch_buffer_offset,
+                                          static_cast<VkDeviceSize>(push_constants.n_blocks) * sizeof(uint32_t) );
+
+        {
+            const BufferRange buffer_ranges[] =
+            {
+                in_input_range,
+                in_output_range,
+                block_sum_range
+            };
+
+            push_constants.flags |= FLAG_WRITE_BLOCK_SUMS;
+
+            if (!record_kernel (in_cmd_buffer_ptr,
+                                KERNEL_SCAN,
+                                push_constants,
+                                buffer_ranges) ||
+                !record_barrier(in_cmd_buffer_ptr) )
+            {
+                goto end;
+            }
+        }
+
+        /* Turn the block sums into block offsets */
+        if (!record_scan_level(in_cmd_buffer_ptr,
+                               block_sum_range,
+                               block_sum_range,
+                               in_scratch_buffer_ptr,
+                               in_scratch_buffer_offset + align_scratch_size(block_sum_range.size),
+                               push_constants.n_blocks,
+                               FLAG_EXCLUSIVE) ||
+            !record_barrier   (in_cmd_buffer_ptr) )
+        {
+            goto end;
+        }
+
+        {
+            const BufferRange buffer_ranges[] =
+            {
+                in_output_range,
+                block_sum_range
+            };
+
+            push_constants.flags = 0;
+
+            result = record_kernel(in_cmd_buffer_ptr,
+                                   KERNEL_ADD_BLOCK_OFFSETS,
+                                   push_constants,
+                                   buffer_ranges);
+        }
+    }
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::ComputePrimitives::record_sort(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                           const SortInfo&           in_info)
+{
+    const bool         has_values            = (in_info.value_buffer_ptr != nullptr);
+    const bool         is_64bit              = (in_info.key_type         == KeyType::UINT64);
+    const VkDeviceSize key_size              = (is_64bit) ? sizeof(uint64_t) : sizeof(uint32_t);
+    const uint32_t     n_max_key_bits        = static_cast<uint32_t>(key_size * 8);
+    const uint32_t     n_blocks              = (in_info.n_elements + m_workgroup_size - 1) / m_workgroup_size;
+    const uint32_t     n_histogram_items     = n_blocks * N_RADIX_BINS;
+    const VkDeviceSize n_histogram_bytes     = static_cast<VkDeviceSize>(n_histogram_items) * sizeof(uint32_t);
+    const VkDeviceSize n_key_bytes           = key_size * in_info.n_elements;
+    const VkDeviceSize n_value_bytes         = static_cast<VkDeviceSize>(in_info.n_elements) * sizeof(uint32_t);
+    uint32_t           n_key_bits            = in_info.n_key_bits;
+    uint32_t           n_passes              = 0;
+    PushConstants      push_constants;
+    bool               result                = false;
+    VkDeviceSize       scratch_offset        = in_info.scratch_buffer_offset;
+
+    anvil_assert(in_cmd_buffer_ptr          != nullptr);
+    anvil_assert(in_info.key_buffer_ptr     != nullptr);
+    anvil_assert(in_info.scratch_buffer_ptr != nullptr);
+    anvil_assert(in_info.n_key_bits         <= n_max_key_bits);
+
+    if (in_info.n_elements == 0)
+    {
+        result = true;
+
+        goto end;
+    }
+
+    if (n_key_bits == 0             ||
+        n_key_bits >  n_max_key_bits)
+    {
+        n_key_bits = n_max_key_bits;
+    }
+
+    /* Use an even number of passes, so that the sorted keys end up in the app's buffers. Extra passes sort by bits
+     * which are zero, so they do not change the order. */
+    n_passes  = (n_key_bits + N_RADIX_BITS_PER_PASS - 1) / N_RADIX_BITS_PER_PASS;
+    n_passes += (n_passes % 2);
+
+    {
+        const BufferRange key_ranges[] =
+        {
+            BufferRange(in_info.key_buffer_ptr,     in_info.key_buffer_offset, n_key_bytes),
+            BufferRange(in_info.scratch_buffer_ptr, scratch_offset,            n_key_bytes)
+        };
+
+        scratch_offset += align_scratch_size(n_key_bytes);
+
+        /* If there are no values, the key ranges stand in for the value buffers. The kernels do not access them. */
+        const BufferRange value_ranges[] =
+        {
+            (has_values) ? BufferRange(in_info.value_buffer_ptr,   in_info.value_buffer_offset, n_value_bytes) : key_ranges[0],
+            (has_values) ? BufferRange(in_info.scratch_buffer_ptr, scratch_offset,              n_value_bytes) : key_ranges[1]
+        };
+
+        if (has_values)
+        {
+            scratch_offset += align_scratch_size(n_value_bytes);
+        }
+
+        const BufferRange histogram_range(in_info.scratch_buffer_ptr,
+                                          scratch_offset,
+                                          n_histogram_bytes);
+
+        scratch_offset += align_scratch_size(n_histogram_bytes);
+
+        push_constants.flags      = (has_values) ? FLAG_HAS_VALUES : 0;
+        push_constants.n_blocks   = n_blocks;
+        push_constants.n_elements = in_info.n_elements;
+
+        for (uint32_t n_pass = 0;
+                      n_pass < n_passes;
+                    ++n_pass)
+        {
+            const uint32_t src_index = (n_pass % 2);
+            const uint32_t dst_index = 1 - src_index;
+
+            push_constants.shift = n_pass * N_RADIX_BITS_PER_PASS;
+
+            if (n_pass > 0 &&
+                !record_barrier(in_cmd_buffer_ptr) )
+            {
+                goto end;
+            }
+
+            /* Count the digits of each block */
+            {
+                const BufferRange buffer_ranges[] =
+                {
+                    key_ranges[src_index],
+                    histogram_range
+                };
+
+                if (!record_kernel (in_cmd_buffer_ptr,
+                                    (is_64bit) ? KERNEL_RADIX_HISTOGRAM_64 : KERNEL_RADIX_HISTOGRAM_32,
+                                    push_constants,
+                                    buffer_ranges) ||
+                    !record_barrier(in_cmd_buffer_ptr) )
+                {
+                    goto end;
+                }
+            }
+
+            /* The histogram is stored digit-major, so its exclusive scan yields the output offset of each block's digits */
+            if (!record_scan_level(in_cmd_buffer_ptr,
+                                   histogram_range,
+                                   histogram_range,
+                                   in_info.scratch_buffer_ptr,
+                                   scratch_offset,
+                                   n_histogram_items,
+                                   FLAG_EXCLUSIVE) ||
+                !record_barrier   (in_cmd_buffer_ptr) )
+            {
+                goto end;
+            }
+
+            {
+                const BufferRange buffer_ranges[] =
+                {
+                    key_ranges  [src_index],
+                    value_ranges[src_index],
+                    key_ranges  [dst_index],
+                    value_ranges[dst_index],
+                    histogram_range
+                };
+
+                if (!record_kernel(in_cmd_buffer_ptr,
+                                   (is_64bit) ? KERNEL_RADIX_SCATTER_64 : KERNEL_RADIX_SCATTER_32,
+                                   push_constants,
+                                   buffer_ranges) )
+                {
+                    goto end;
+                }
+            }
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
@@ -96,10 +96,18 @@ void Anvil::DebugMarkerSupportProviderWorker::set_name_internal(const std::strin
 
                 case DebugAPI::EXT_DEBUG_UTILS:
                 {
-                    const auto&                   entrypoints(m_device_ptr->get_parent_instance()->get_extension_ext_debug_utils_entrypoints() );
+                    const auto                    instance_ptr(m_device_ptr->get_parent_instance() );
+                    const auto&                   entrypoints (instance_ptr->get_extension_ext_debug_utils_entrypoints() );
                     VkDebugUtilsObjectNameInfoEXT name_info;
                     VkResult                      result_vk;
 
+                    if (!instance_ptr->has_active_debug_messenger() )
+                    {
+                        /* Only forward the data if somebody is going to report it. The data stays cached, so it is
+                         * re-sent if the Vulkan handle changes after a messenger has been created. */
+                        break;
+                    }
+
                     name_info.objectHandle = m_vk_object_handle;
                     name_info.objectType   = static_cast<VkObjectType>(m_vk_object_type);
                     name_info.pNext        = nullptr;
@@ -193,14 +201,23 @@ void Anvil::DebugMarkerSupportProviderWorker::set_tag_internal(const uint64_t in
                     anvil_assert_vk_call_succeeded(result_vk);
 
                     ANVIL_REDUNDANT_VARIABLE(result_vk);
+
+                    break;
                 }
 
                 case DebugAPI::EXT_DEBUG_UTILS:
                 {
-                    const auto&                  entrypoints(m_device_ptr->get_parent_instance()->get_extension_ext_debug_utils_entrypoints() );
+                    const auto                   instance_ptr(m_device_ptr->get_parent_instance() );
+                    const auto&                  entrypoints (instance_ptr->get_extension_ext_debug_utils_entrypoints() );
                     VkDebugUtilsObjectTagInfoEXT name_info;
                     VkResult                     result_vk;
 
+                    if (!instance_ptr->has_active_debug_messenger() )
+                    {
+                        /* Please see set_name_internal() */
+                        break;
+                    }
+
                     name_info.objectHandle = m_vk_object_handle;
                     name_info.objectType   = static_cast<VkObjectType>(m_vk_object_type);
                     name_info.pNext        = nullptr;
@@ -252,8 +269,8 @@ void Anvil::DebugMarkerSupportProviderWorker::set_vk_handle_internal(uint64_t in
     else
     if (m_vk_object_handle != in_vk_object_handle)
     {
-        anvil_assert(m_vk_object_handle == VK_NULL_HANDLE);
-
+        /* The handle may also be replaced with a new one, in which case the name & the tag are carried over
+         * to the new handle. This happens when a buffer is re-created after its memory has been moved. */
         m_vk_object_handle = in_vk_object_handle;
 
         if (m_object_name.size() != 0)
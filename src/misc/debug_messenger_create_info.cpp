@@ -25,10 +25,14 @@ Anvil::DebugMessengerCreateInfo::DebugMessengerCreateInfo(Anvil::Instance*
                                                           const Anvil::DebugMessageSeverityFlags& in_debug_message_severity_flags,
                                                           const Anvil::DebugMessageTypeFlags&     in_debug_message_type_flags,
                                                           Anvil::DebugMessengerCallbackFunction   in_callback_function)
-    :m_callback_function           (in_callback_function),
-     m_debug_message_severity_flags(in_debug_message_severity_flags),
-     m_debug_message_type_flags    (in_debug_message_type_flags),
-     m_instance_ptr                (in_instance_ptr)
+    :m_async_delivery_enabled        (false),
+     m_async_delivery_ring_size      (256),
+     m_callback_function             (in_callback_function),
+     m_debug_message_severity_flags  (in_debug_message_severity_flags),
+     m_debug_message_type_flags      (in_debug_message_type_flags),
+     m_instance_ptr                  (in_instance_ptr),
+     m_rate_limit_max_messages_per_id(0),
+     m_rate_limit_period_msec        (0)
 {
     /* Stub */
 }
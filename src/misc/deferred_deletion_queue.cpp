@@ -0,0 +1,185 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#include "misc/debug.h"
+#include "misc/deferred_deletion_queue.h"
+#include "wrappers/fence.h"
+#include "wrappers/semaphore.h"
+
+
+/** Please see header for specification */
+Anvil::DeferredDeletionQueue::DeferredDeletionQueue(const Anvil::BaseDevice* in_device_ptr)
+    :MTSafetySupportProvider(true),
+     m_device_ptr           (in_device_ptr),
+     m_n_current_frame      (0)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::DeferredDeletionQueue::~DeferredDeletionQueue()
+{
+    /* The device waits until it goes idle before releasing the queue, so it is safe to release all objects. */
+    std::deque<Item> items;
+
+    {
+        std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+
+        items = std::move(m_items);
+
+        m_frames.clear();
+        m_items.clear ();
+    }
+
+    for (auto& current_item : items)
+    {
+        current_item.release_func();
+    }
+}
+
+/** Please see header for specification */
+uint32_t Anvil::DeferredDeletionQueue::collect()
+{
+    std::vector<std::function<void()> > release_funcs;
+
+    {
+        std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+
+        while (!m_frames.empty()                     &&
+                is_frame_complete(m_frames.front() ) )
+        {
+            const uint64_t n_frame = m_frames.front().n_frame;
+
+            while (!m_items.empty()                   &&
+                    m_items.front().n_frame <= n_frame)
+            {
+                release_funcs.push_back(std::move(m_items.front().release_func) );
+
+                m_items.pop_front();
+            }
+
+            m_frames.pop_front();
+        }
+    }
+
+    /* Release the objects with the lock dropped. Their destructors may take a while, or re-enter the queue. */
+    for (auto& current_release_func : release_funcs)
+    {
+        current_release_func();
+    }
+
+    return static_cast<uint32_t>(release_funcs.size() );
+}
+
+/** Please see header for specification */
+Anvil::DeferredDeletionQueueUniquePtr Anvil::DeferredDeletionQueue::create(const Anvil::BaseDevice* in_device_ptr)
+{
+    Anvil::DeferredDeletionQueueUniquePtr result_ptr(nullptr,
+                                                     std::default_delete<Anvil::DeferredDeletionQueue>() );
+
+    anvil_assert(in_device_ptr != nullptr);
+
+    result_ptr.reset(
+        new Anvil::DeferredDeletionQueue(in_device_ptr)
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+void Anvil::DeferredDeletionQueue::end_frame(Anvil::Fence* in_fence_ptr)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+
+    anvil_assert(in_fence_ptr != nullptr);
+
+    m_frames.emplace_back(m_n_current_frame,
+                          in_fence_ptr,
+                          nullptr, /* in_semaphore_ptr   */
+                          0);      /* in_semaphore_value */
+
+    ++m_n_current_frame;
+}
+
+/** Please see header for specification */
+void Anvil::DeferredDeletionQueue::end_frame(Anvil::Semaphore* in_timeline_semaphore_ptr,
+                                             uint64_t          in_value)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+
+    anvil_assert(in_timeline_semaphore_ptr != nullptr);
+
+    m_frames.emplace_back(m_n_current_frame,
+                          nullptr, /* in_fence_ptr */
+                          in_timeline_semaphore_ptr,
+                          in_value);
+
+    ++m_n_current_frame;
+}
+
+/** Please see header for specification */
+void Anvil::DeferredDeletionQueue::enqueue_release_func(std::function<void()> in_release_func)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+
+    m_items.emplace_back(m_n_current_frame,
+                         std::move(in_release_func) );
+}
+
+/** Please see header for specification */
+uint64_t Anvil::DeferredDeletionQueue::get_current_frame() const
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+
+    return m_n_current_frame;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::DeferredDeletionQueue::get_n_pending_objects() const
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+
+    return static_cast<uint32_t>(m_items.size() );
+}
+
+/** Please see header for specification */
+bool Anvil::DeferredDeletionQueue::is_frame_complete(const Frame& in_frame) const
+{
+    bool result = false;
+
+    if (in_frame.fence_ptr != nullptr)
+    {
+        result = in_frame.fence_ptr->is_set();
+    }
+    else
+    {
+        uint64_t counter_value = 0;
+
+        anvil_assert(in_frame.semaphore_ptr != nullptr);
+
+        if (in_frame.semaphore_ptr->get_counter_value(&counter_value) )
+        {
+            result = (counter_value >= in_frame.semaphore_value);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,726 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "misc/compute_pipeline_create_info.h"
+#include "misc/debug.h"
+#include "misc/depth_pyramid_builder.h"
+#include "misc/descriptor_set_cache.h"
+#include "misc/descriptor_set_create_info.h"
+#include "misc/glsl_to_spirv.h"
+#include "misc/gpu_profiler.h"
+#include "misc/image_create_info.h"
+#include "misc/image_view_create_info.h"
+#include "misc/sampler_create_info.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/compute_pipeline_manager.h"
+#include "wrappers/descriptor_set_layout.h"
+#include "wrappers/device.h"
+#include "wrappers/image.h"
+#include "wrappers/image_view.h"
+#include "wrappers/sampler.h"
+#include "wrappers/shader_module.h"
+#include <algorithm>
+
+#define N_MAX_MIPS_PER_PASS (5)
+#define TILE_SIZE           (16)
+
+
+static const char* g_glsl_reduce_comp =
+    "#version 450\n"
+    "\n"
+    "#define N_MAX_MIPS_PER_PASS 5\n"
+    "#define TILE_SIZE           16\n"
+    "\n"
+    "layout(local_size_x = TILE_SIZE, local_size_y = TILE_SIZE) in;\n"
+    "\n"
+    "layout(set = 0, binding = 0)        uniform           sampler2D src;\n"
+    "layout(set = 0, binding = 1, r32f) uniform writeonly image2D   dst_mips[N_MAX_MIPS_PER_PASS];\n"
+    "\n"
+    "layout(push_constant) uniform pushConstants\n"
+    "{\n"
+    "    ivec2 src_size;\n"
+    "    ivec2 dst_size;\n"
+    "    uint  n_mips;\n"
+    "    uint  is_src_depth;\n"
+    "} pc;\n"
+    "\n"
+    "shared float tile[TILE_SIZE * TILE_SIZE];\n"
+    "\n"
+    "/* Indexing image arrays with non-constant expressions needs shaderStorageImageArrayDynamicIndexing */\n"
+    "void store(uint n_mip, ivec2 xy, float value)\n"
+    "{\n"
+    "    switch (n_mip)\n"
+    "    {\n"
+    "        case 0:  imageStore(dst_mips[0], xy, vec4(value) ); break;\n"
+    "        case 1:  imageStore(dst_mips[1], xy, vec4(value) ); break;\n"
+    "        case 2:  imageStore(dst_mips[2], xy, vec4(value) ); break;\n"
+    "        case 3:  imageStore(dst_mips[3], xy, vec4(value) ); break;\n"
+    "        default: imageStore(dst_mips[4], xy, vec4(value) ); break;\n"
+    "    }\n"
+    "}\n"
+    "\n"
+    "float reduce_src(ivec2 xy)\n"
+    "{\n"
+    "    float result = 0.0;\n"
+    "\n"
+    "    if (pc.is_src_depth != 0u)\n"
+    "    {\n"
+    "        /* Depth buffer size is arbitrary, so take the maximum over all texels the footprint touches */\n"
+    "        vec2  ratio = vec2(pc.src_size) / vec2(pc.dst_size);\n"
+    "        ivec2 start = ivec2(floor(vec2(xy)     * ratio) );\n"
+    "        ivec2 end   = min  (ivec2(ceil (vec2(xy + 1) * ratio) ), pc.src_size);\n"
+    "\n"
+    "        for (int y = start.y; y < end.y; ++y)\n"
+    "        {\n"
+    "            for (int x = start.x; x < end.x; ++x)\n"
+    "            {\n"
+    "                result = max(result, texelFetch(src, ivec2(x, y), 0).x);\n"
+    "            }\n"
+    "        }\n"
+    "    }\n"
+    "    else\n"
+    "    {\n"
+    "#ifdef USE_REDUCTION_SAMPLER\n"
+    "        /* Bilinear fetch at the center of the 2x2 quad returns its maximum */\n"
+    "        result = textureLod(src, (vec2(xy * 2) + vec2(1.0) ) / vec2(pc.src_size), 0.0).x;\n"
+    "#else\n"
+    "        ivec2 max_xy = pc.src_size - ivec2(1);\n"
+    "        ivec2 base   = xy * 2;\n"
+    "\n"
+    "        result = max(max(texelFetch(src, min(base,               max_xy), 0).x,\n"
+    "                         texelFetch(src, min(base + ivec2(1, 0), max_xy), 0).x),\n"
+    "                     max(texelFetch(src, min(base + ivec2(0, 1), max_xy), 0).x,\n"
+    "                         texelFetch(src, min(base + ivec2(1, 1), max_xy), 0).x) );\n"
+    "#endif\n"
+    "    }\n"
+    "\n"
+    "    return result;\n"
+    "}\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "    ivec2 global_xy = ivec2(gl_GlobalInvocationID.xy);\n"
+    "    ivec2 local_xy  = ivec2(gl_LocalInvocationID.xy);\n"
+    "    ivec2 size      = pc.dst_size;\n"
+    "    float value     = 0.0;\n"
+    "\n"
+    "    if (all(lessThan(global_xy, size) ) )\n"
+    "    {\n"
+    "        value = reduce_src(global_xy);\n"
+    "\n"
+    "        store(0u, global_xy, value);\n"
+    "    }\n"
+    "\n"
+    "    /* Texels outside the mip hold 0, which never wins the reduction */\n"
+    "    tile[local_xy.y * TILE_SIZE + local_xy.x] = value;\n"
+    "\n"
+    "    for (uint n_mip = 1u; n_mip < pc.n_mips; ++n_mip)\n"
+    "    {\n"
+    "        int  step      = 1 << n_mip;\n"
+    "        int  half_step = step >> 1;\n"
+    "        bool is_active = all(equal(local_xy & ivec2(step - 1), ivec2(0) ) );\n"
+    "\n"
+    "        size = max(size >> 1, ivec2(1) );\n"
+    "\n"
+    "        memoryBarrierShared();\n"
+    "        barrier            ();\n"
+    "\n"
+    "        if (is_active)\n"
+    "        {\n"
+    "            value = max(max(tile[ local_xy.y              * TILE_SIZE + local_xy.x],\n"
+    "                            tile[ local_xy.y              * TILE_SIZE + local_xy.x + half_step]),\n"
+    "                        max(tile[(local_xy.y + half_step) * TILE_SIZE + local_xy.x],\n"
+    "                            tile[(local_xy.y + half_step) * TILE_SIZE + local_xy.x + half_step]) );\n"
+    "        }\n"
+    "\n"
+    "        memoryBarrierShared();\n"
+    "        barrier            ();\n"
+    "\n"
+    "        if (is_active)\n"
+    "        {\n"
+    "            ivec2 dst_xy = global_xy >> n_mip;\n"
+    "\n"
+    "            tile[local_xy.y * TILE_SIZE + local_xy.x] = value;\n"
+    "\n"
+    "            if (all(lessThan(dst_xy, size) ) )\n"
+    "            {\n"
+    "                store(n_mip, dst_xy, value);\n"
+    "            }\n"
+    "        }\n"
+    "    }\n"
+    "}\n";
+
+
+/** Please see header for specification */
+Anvil::DepthPyramidBuilder::DepthPyramidBuilder(const Anvil::BaseDevice* in_device_ptr,
+                                                uint32_t                 in_width,
+                                                uint32_t                 in_height)
+    :m_device_ptr (in_device_ptr),
+     m_height     (in_height),
+     m_pipeline_id(UINT32_MAX),
+     m_width      (in_width)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::DepthPyramidBuilder::~DepthPyramidBuilder()
+{
+    /* Release the sets before the layout they use */
+    m_ds_cache_ptr.reset();
+
+    if (m_pipeline_id != UINT32_MAX)
+    {
+        m_device_ptr->get_compute_pipeline_manager()->delete_pipeline(m_pipeline_id);
+
+        m_pipeline_id = UINT32_MAX;
+    }
+}
+
+/** Please see header for specification */
+Anvil::DepthPyramidBuilderUniquePtr Anvil::DepthPyramidBuilder::create(const Anvil::BaseDevice* in_device_ptr,
+                                                                       uint32_t                 in_depth_width,
+                                                                       uint32_t                 in_depth_height)
+{
+    uint32_t                            height     = 1;
+    Anvil::DepthPyramidBuilderUniquePtr result_ptr(nullptr,
+                                                   std::default_delete<Anvil::DepthPyramidBuilder>() );
+    uint32_t                            width      = 1;
+
+    if (in_device_ptr   == nullptr ||
+        in_depth_width  == 0       ||
+        in_depth_height == 0)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    /* Mip 0 uses the largest power-of-two size which fits in the depth buffer, so that each mip is exactly half
+     * the size of the previous one. */
+    while (width * 2 <= in_depth_width)
+    {
+        width *= 2;
+    }
+
+    while (height * 2 <= in_depth_height)
+    {
+        height *= 2;
+    }
+
+    result_ptr.reset(
+        new Anvil::DepthPyramidBuilder(in_device_ptr,
+                                       width,
+                                       height)
+    );
+
+    if (!result_ptr->init() )
+    {
+        result_ptr.reset();
+    }
+
+end:
+    return result_ptr;
+}
+
+/** Creates the pyramid image, the samplers, the descriptor set cache and the reduction pipeline.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::DepthPyramidBuilder::init()
+{
+    bool result = false;
+
+    m_ds_cache_ptr = Anvil::DescriptorSetCache::create(m_device_ptr,
+                                                       16,  /* in_n_sets_per_pool             */
+                                                       64); /* in_n_descriptors_per_type_pool */
+
+    if (m_ds_cache_ptr == nullptr)
+    {
+        anvil_assert(m_ds_cache_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (!init_image   () ||
+        !init_samplers() ||
+        !init_pipeline() )
+    {
+        goto end;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Creates the pyramid image, a view of its full mip chain, and one view per mip for storage writes.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::DepthPyramidBuilder::init_image()
+{
+    uint32_t n_mips = 0;
+    bool     result = false;
+
+    {
+        auto create_info_ptr = Anvil::ImageCreateInfo::create_alloc(m_device_ptr,
+                                                                    Anvil::ImageType::_2D,
+                                                                    Anvil::Format::R32_SFLOAT,
+                                                                    Anvil::ImageTiling::OPTIMAL,
+                                                                    Anvil::ImageUsageFlagBits::SAMPLED_BIT | Anvil::ImageUsageFlagBits::STORAGE_BIT,
+                                                                    m_width,
+                                                                    m_height,
+                                                                    1, /* in_base_mipmap_depth */
+                                                                    1, /* in_n_layers          */
+                                                                    Anvil::SampleCountFlagBits::_1_BIT,
+                                                                    Anvil::QueueFamilyFlagBits::COMPUTE_BIT | Anvil::QueueFamilyFlagBits::GRAPHICS_BIT,
+                                                                    Anvil::SharingMode::EXCLUSIVE,
+                                                                    true, /* in_use_full_mipmap_chain */
+                                                                    Anvil::MemoryFeatureFlagBits::DEVICE_LOCAL_BIT,
+                                                                    Anvil::ImageCreateFlagBits::NONE,
+                                                                    Anvil::ImageLayout::UNDEFINED);
+
+        m_image_ptr = Anvil::Image::create(std::move(create_info_ptr) );
+    }
+
+    if (m_image_ptr == nullptr)
+    {
+        anvil_assert(m_image_ptr != nullptr);
+
+        goto end;
+    }
+
+    n_mips = m_image_ptr->get_n_mipmaps();
+
+    for (uint32_t n_view = 0;
+                  n_view < n_mips + 1;
+                ++n_view)
+    {
+        /* The last view covers the whole chain */
+        const bool is_full_chain_view = (n_view == n_mips);
+        auto       create_info_ptr    = Anvil::ImageViewCreateInfo::create_2D(m_device_ptr,
+                                                                             m_image_ptr.get(),
+                                                                             0, /* in_n_base_layer */
+                                                                             (is_full_chain_view) ? 0      : n_view,
+                                                                             (is_full_chain_view) ? n_mips : 1,
+                                                                             Anvil::ImageAspectFlagBits::COLOR_BIT,
+                                                                             Anvil::Format::R32_SFLOAT,
+                                                                             Anvil::ComponentSwizzle::IDENTITY,
+                                                                             Anvil::ComponentSwizzle::IDENTITY,
+                                                                             Anvil::ComponentSwizzle::IDENTITY,
+                                                                             Anvil::ComponentSwizzle::IDENTITY);
+        auto       view_ptr           = Anvil::ImageView::create(std::move(create_info_ptr) );
+
+        if (view_ptr == nullptr)
+        {
+            anvil_assert(view_ptr != nullptr);
+
+            goto end;
+        }
+
+        if (is_full_chain_view)
+        {
+            m_image_view_ptr = std::move(view_ptr);
+        }
+        else
+        {
+            m_mip_image_view_ptrs.push_back(std::move(view_ptr) );
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Compiles the reduction shader, and creates a descriptor set layout and a compute pipeline which uses it.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::DepthPyramidBuilder::init_pipeline()
+{
+    auto                                       compute_pipeline_manager_ptr = m_device_ptr->get_compute_pipeline_manager();
+    Anvil::GLSLShaderToSPIRVGeneratorUniquePtr glsl_ptr;
+    bool                                       result                       = false;
+
+    glsl_ptr = Anvil::GLSLShaderToSPIRVGenerator::create(m_device_ptr,
+                                                         Anvil::GLSLShaderToSPIRVGenerator::MODE_USE_SPECIFIED_SOURCE,
+                                                         g_glsl_reduce_comp,
+                                                         Anvil::ShaderStage::COMPUTE);
+
+    if (glsl_ptr == nullptr)
+    {
+        anvil_assert(glsl_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (m_reduction_sampler_ptr != nullptr)
+    {
+        glsl_ptr->add_empty_definition("USE_REDUCTION_SAMPLER");
+    }
+
+    m_shader_module_ptr = Anvil::ShaderModule::create_from_spirv_generator(m_device_ptr,
+                                                                           glsl_ptr.get() );
+
+    if (m_shader_module_ptr == nullptr)
+    {
+        anvil_assert(m_shader_module_ptr != nullptr);
+
+        goto end;
+    }
+
+    m_entrypoint_ptr.reset(
+        new Anvil::ShaderModuleStageEntryPoint("main",
+                                               m_shader_module_ptr.get(),
+                                               Anvil::ShaderStage::COMPUTE)
+    );
+
+    {
+        auto ds_create_info_ptr = Anvil::DescriptorSetCreateInfo::create();
+
+        ds_create_info_ptr->add_binding(0, /* in_binding_index */
+                                        Anvil::DescriptorType::COMBINED_IMAGE_SAMPLER,
+                                        1, /* in_descriptor_array_size */
+                                        Anvil::ShaderStageFlagBits::COMPUTE_BIT);
+        ds_create_info_ptr->add_binding(1, /* in_binding_index */
+                                        Anvil::DescriptorType::STORAGE_IMAGE,
+                                        N_MAX_MIPS_PER_PASS,
+                                        Anvil::ShaderStageFlagBits::COMPUTE_BIT);
+
+        m_ds_layout_ptr = Anvil::DescriptorSetLayout::create(std::move(ds_create_info_ptr),
+                                                             m_device_ptr);
+    }
+
+    if (m_ds_layout_ptr == nullptr)
+    {
+        anvil_assert(m_ds_layout_ptr != nullptr);
+
+        goto end;
+    }
+
+    {
+        const std::vector<const Anvil::DescriptorSetCreateInfo*> ds_create_info_ptrs(1,
+                                                                                      m_ds_layout_ptr->get_create_info() );
+        auto                                                     pipeline_create_info_ptr = Anvil::ComputePipelineCreateInfo::create(Anvil::PipelineCreateFlagBits::NONE,
+                                                                                                                                     *m_entrypoint_ptr);
+
+        pipeline_create_info_ptr->attach_push_constant_range    (0, /* in_offset */
+                                                                 sizeof(PushConstants),
+                                                                 Anvil::ShaderStageFlagBits::COMPUTE_BIT);
+        pipeline_create_info_ptr->set_descriptor_set_create_info(&ds_create_info_ptrs);
+
+        if (!compute_pipeline_manager_ptr->add_pipeline(std::move(pipeline_create_info_ptr),
+                                                       &m_pipeline_id) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    if (!compute_pipeline_manager_ptr->bake() )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Creates the nearest-filtering sampler used to read the depth buffer and, if supported, the MAX reduction sampler
+ *  used to read pyramid mips.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::DepthPyramidBuilder::init_samplers()
+{
+    const auto& device_properties      = m_device_ptr->get_physical_device_properties();
+    const bool  is_reduction_supported = m_device_ptr->get_extension_info()->ext_sampler_filter_minmax()      &&
+                                         device_properties.ext_sampler_filter_minmax_properties_ptr != nullptr &&
+                                         device_properties.ext_sampler_filter_minmax_properties_ptr->filter_minmax_single_component_formats;
+    bool        result                 = false;
+
+    for (uint32_t n_sampler = 0;
+                  n_sampler < ((is_reduction_supported) ? 2u : 1u);
+                ++n_sampler)
+    {
+        const bool is_reduction_sampler = (n_sampler == 1);
+        auto       create_info_ptr      = Anvil::SamplerCreateInfo::create(m_device_ptr,
+                                                                           (is_reduction_sampler) ? Anvil::Filter::LINEAR : Anvil::Filter::NEAREST,
+                                                                           (is_reduction_sampler) ? Anvil::Filter::LINEAR : Anvil::Filter::NEAREST,
+                                                                           Anvil::SamplerMipmapMode::NEAREST,
+                                                                           Anvil::SamplerAddressMode::CLAMP_TO_EDGE,
+                                                                           Anvil::SamplerAddressMode::CLAMP_TO_EDGE,
+                                                                           Anvil::SamplerAddressMode::CLAMP_TO_EDGE,
+                                                                           0.0f,  /* in_lod_bias                     */
+                                                                           1.0f,  /* in_max_anisotropy               */
+                                                                           false, /* in_compare_enable               */
+                                                                           Anvil::CompareOp::ALWAYS,
+                                                                           0.0f,  /* in_min_lod                      */
+                                                                           0.0f,  /* in_max_lod                      */
+                                                                           Anvil::BorderColor::FLOAT_TRANSPARENT_BLACK,
+                                                                           false); /* in_use_unnormalized_coordinates */
+
+        if (is_reduction_sampler)
+        {
+            create_info_ptr->set_sampler_reduction_mode(Anvil::SamplerReductionMode::MAX_EXT);
+
+            m_reduction_sampler_ptr = Anvil::Sampler::create(std::move(create_info_ptr) );
+
+            if (m_reduction_sampler_ptr == nullptr)
+            {
+                anvil_assert(m_reduction_sampler_ptr != nullptr);
+
+                goto end;
+            }
+        }
+        else
+        {
+            m_nearest_sampler_ptr = Anvil::Sampler::create(std::move(create_info_ptr) );
+
+            if (m_nearest_sampler_ptr == nullptr)
+            {
+                anvil_assert(m_nearest_sampler_ptr != nullptr);
+
+                goto end;
+            }
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::DepthPyramidBuilder::record_build(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                              Anvil::ImageView*         in_depth_image_view_ptr,
+                                              Anvil::ImageLayout        in_depth_image_layout,
+                                              Anvil::GPUProfiler*       in_opt_profiler_ptr)
+{
+    uint32_t               depth_height        = 0;
+    uint32_t               depth_width         = 0;
+    bool                   is_region_begun     = false;
+    const uint32_t         n_mips              = get_n_mips();
+    Anvil::PipelineLayout* pipeline_layout_ptr = nullptr;
+    bool                   result              = false;
+
+    if (in_cmd_buffer_ptr       == nullptr ||
+        in_depth_image_view_ptr == nullptr)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    anvil_assert(in_depth_image_layout == Anvil::ImageLayout::DEPTH_STENCIL_READ_ONLY_OPTIMAL ||
+                 in_depth_image_layout == Anvil::ImageLayout::GENERAL                         ||
+                 in_depth_image_layout == Anvil::ImageLayout::SHADER_READ_ONLY_OPTIMAL);
+
+    {
+        const auto view_create_info_ptr = in_depth_image_view_ptr->get_create_info_ptr();
+
+        if (!view_create_info_ptr->get_parent_image()->get_image_mipmap_size(view_create_info_ptr->get_base_mipmap_level(),
+                                                                             &depth_width,
+                                                                             &depth_height,
+                                                                             nullptr) ) /* out_opt_depth_ptr */
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    if (in_opt_profiler_ptr != nullptr)
+    {
+        is_region_begun = in_opt_profiler_ptr->begin_region(in_cmd_buffer_ptr,
+                                                            "Depth pyramid");
+    }
+
+    pipeline_layout_ptr = m_device_ptr->get_compute_pipeline_manager()->get_pipeline_layout(m_pipeline_id);
+
+    in_cmd_buffer_ptr->record_bind_pipeline(Anvil::PipelineBindPoint::COMPUTE,
+                                            m_pipeline_id);
+
+    /* Previous contents are discarded. Culling passes which used the pyramid earlier may still be reading it. */
+    {
+        const Anvil::ImageSubresourceRange pyramid_range =
+        {
+            Anvil::ImageAspectFlagBits::COLOR_BIT,
+            0,      /* base_mip_level   */
+            n_mips, /* level_count      */
+            0,      /* base_array_layer */
+            1       /* layer_count      */
+        };
+        const Anvil::ImageBarrier          image_barrier(Anvil::AccessFlagBits::NONE,
+                                                         Anvil::AccessFlagBits::SHADER_WRITE_BIT,
+                                                         Anvil::ImageLayout::UNDEFINED,
+                                                         Anvil::ImageLayout::GENERAL,
+                                                         VK_QUEUE_FAMILY_IGNORED,
+                                                         VK_QUEUE_FAMILY_IGNORED,
+                                                         m_image_ptr.get(),
+                                                         pyramid_range);
+
+        if (!in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::COMPUTE_SHADER_BIT,
+                                                        Anvil::PipelineStageFlagBits::COMPUTE_SHADER_BIT,
+                                                        Anvil::DependencyFlagBits::NONE,
+                                                        0,       /* in_memory_barrier_count        */
+                                                        nullptr, /* in_memory_barrier_ptrs         */
+                                                        0,       /* in_buffer_memory_barrier_count */
+                                                        nullptr, /* in_buffer_memory_barrier_ptrs  */
+                                                        1,       /* in_image_memory_barrier_count  */
+                                                       &image_barrier) )
+        {
+            goto end;
+        }
+    }
+
+    for (uint32_t n_first_mip = 0;
+                  n_first_mip < n_mips;
+                  n_first_mip += N_MAX_MIPS_PER_PASS)
+    {
+        std::vector<Anvil::DescriptorSet::StorageImageBindingElement> dst_elements;
+        Anvil::DescriptorSet*                                         ds_ptr       = nullptr;
+        const bool                                                    is_src_depth = (n_first_mip == 0);
+        const uint32_t                                                n_pass_mips  = std::min(n_mips - n_first_mip,
+                                                                                              static_cast<uint32_t>(N_MAX_MIPS_PER_PASS) );
+        PushConstants                                                 push_constants;
+
+        push_constants.dst_size[0]  = static_cast<int32_t>(std::max(m_width  >> n_first_mip, 1u) );
+        push_constants.dst_size[1]  = static_cast<int32_t>(std::max(m_height >> n_first_mip, 1u) );
+        push_constants.is_src_depth = (is_src_depth) ? 1 : 0;
+        push_constants.n_mips       = n_pass_mips;
+        push_constants.src_size[0]  = (is_src_depth) ? static_cast<int32_t>(depth_width)
+                                                     : static_cast<int32_t>(std::max(m_width  >> (n_first_mip - 1), 1u) );
+        push_constants.src_size[1]  = (is_src_depth) ? static_cast<int32_t>(depth_height)
+                                                     : static_cast<int32_t>(std::max(m_height >> (n_first_mip - 1), 1u) );
+
+        /* Unused array elements are bound to the last mip, but never written */
+        for (uint32_t n_element = 0;
+                      n_element < N_MAX_MIPS_PER_PASS;
+                    ++n_element)
+        {
+            dst_elements.push_back(
+                Anvil::DescriptorSet::StorageImageBindingElement(Anvil::ImageLayout::GENERAL,
+                                                                 m_mip_image_view_ptrs.at(std::min(n_first_mip + n_element,
+                                                                                                   n_mips      - 1) ).get() )
+            );
+        }
+
+        {
+            Anvil::DescriptorSetCache::Contents ds_contents;
+            Anvil::Sampler*                     sampler_ptr = (is_src_depth || m_reduction_sampler_ptr == nullptr) ? m_nearest_sampler_ptr.get  ()
+                                                                                                                   : m_reduction_sampler_ptr.get();
+
+            ds_contents.set_binding_item       (0, /* in_binding_index */
+                                                Anvil::DescriptorSet::CombinedImageSamplerBindingElement((is_src_depth) ? in_depth_image_layout
+                                                                                                                        : Anvil::ImageLayout::GENERAL,
+                                                                                                         (is_src_depth) ? in_depth_image_view_ptr
+                                                                                                                        : m_mip_image_view_ptrs.at(n_first_mip - 1).get(),
+                                                                                                         sampler_ptr) );
+            ds_contents.set_binding_array_items(1, /* in_binding_index */
+                                                Anvil::BindingElementArrayRange(0, /* StartBindingElementIndex */
+                                                                                N_MAX_MIPS_PER_PASS),
+                                                dst_elements.data() );
+
+            ds_ptr = m_ds_cache_ptr->get_descriptor_set(m_ds_layout_ptr.get(),
+                                                        ds_contents);
+        }
+
+        if (ds_ptr == nullptr)
+        {
+            anvil_assert(ds_ptr != nullptr);
+
+            goto end;
+        }
+
+        in_cmd_buffer_ptr->record_bind_descriptor_sets(Anvil::PipelineBindPoint::COMPUTE,
+                                                       pipeline_layout_ptr,
+                                                       0, /* in_first_set */
+                                                       1, /* in_set_count */
+                                                      &ds_ptr,
+                                                       0,        /* in_dynamic_offset_count */
+                                                       nullptr); /* in_dynamic_offset_ptrs  */
+        in_cmd_buffer_ptr->record_push_constants      (pipeline_layout_ptr,
+                                                       Anvil::ShaderStageFlagBits::COMPUTE_BIT,
+                                                       0, /* in_offset */
+                                                       sizeof(push_constants),
+                                                      &push_constants);
+
+        if (!in_cmd_buffer_ptr->record_dispatch((push_constants.dst_size[0] + TILE_SIZE - 1) / TILE_SIZE,
+                                                (push_constants.dst_size[1] + TILE_SIZE - 1) / TILE_SIZE,
+                                                1) ) /* in_z */
+        {
+            goto end;
+        }
+
+        /* Make the mips visible to the next pass or, after the last pass, to culling shaders */
+        {
+            const bool                         is_last_pass = (n_first_mip + n_pass_mips == n_mips);
+            const Anvil::ImageSubresourceRange mips_range   =
+            {
+                Anvil::ImageAspectFlagBits::COLOR_BIT,
+                (is_last_pass) ? 0 : n_first_mip,
+                (is_last_pass) ? n_mips : n_pass_mips,
+                0, /* base_array_layer */
+                1  /* layer_count      */
+            };
+            const Anvil::ImageBarrier          image_barrier(Anvil::AccessFlagBits::SHADER_WRITE_BIT,
+                                                             Anvil::AccessFlagBits::SHADER_READ_BIT,
+                                                             Anvil::ImageLayout::GENERAL,
+                                                             (is_last_pass) ? Anvil::ImageLayout::SHADER_READ_ONLY_OPTIMAL
+                                                                            : Anvil::ImageLayout::GENERAL,
+                                                             VK_QUEUE_FAMILY_IGNORED,
+                                                             VK_QUEUE_FAMILY_IGNORED,
+                                                             m_image_ptr.get(),
+                                                             mips_range);
+
+            if (!in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::COMPUTE_SHADER_BIT,
+                                                            Anvil::PipelineStageFlagBits::COMPUTE_SHADER_BIT,
+                                                            Anvil::DependencyFlagBits::NONE,
+                                                            0,       /* in_memory_barrier_count        */
+                                                            nullptr, /* in_memory_barrier_ptrs         */
+                                                            0,       /* in_buffer_memory_barrier_count */
+                                                            nullptr, /* in_buffer_memory_barrier_ptrs  */
+                                                            1,       /* in_image_memory_barrier_count  */
+                                                           &image_barrier) )
+            {
+                goto end;
+            }
+        }
+    }
+
+    result = true;
+end:
+    if (is_region_begun)
+    {
+        in_opt_profiler_ptr->end_region(in_cmd_buffer_ptr);
+    }
+
+    return result;
+}
@@ -0,0 +1,249 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/descriptor_pool_chain.h"
+#include "misc/descriptor_pool_create_info.h"
+#include "misc/descriptor_pool_sizing_profile.h"
+#include "wrappers/descriptor_pool.h"
+#include "wrappers/descriptor_set.h"
+#include "wrappers/device.h"
+
+
+/** Adds a quarter on top of a learned pool size, so that frames slightly busier than the ones observed so far
+ *  still fit in a single pool. */
+static uint32_t get_n_with_headroom(uint32_t in_n)
+{
+    return in_n + in_n / 4 + 1;
+}
+
+/** Please see header for specification */
+Anvil::DescriptorPoolChain::DescriptorPoolChain(const Anvil::BaseDevice* in_device_ptr,
+                                                uint32_t                 in_n_sets_per_pool,
+                                                uint32_t                 in_n_descriptors_per_type_pool,
+                                                const uint64_t*          in_opt_sizing_profile_key_ptr)
+    :m_device_ptr                 (in_device_ptr),
+     m_has_sizing_profile_key     (in_opt_sizing_profile_key_ptr != nullptr),
+     m_is_first_pool_profiled     (false),
+     m_n_current_pool             (0),
+     m_n_descriptors_per_type_pool(in_n_descriptors_per_type_pool),
+     m_n_sets_per_pool            (in_n_sets_per_pool),
+     m_sizing_profile_key         ((in_opt_sizing_profile_key_ptr != nullptr) ? *in_opt_sizing_profile_key_ptr : 0)
+{
+    anvil_assert(in_device_ptr                  != nullptr);
+    anvil_assert(in_n_descriptors_per_type_pool >  0);
+    anvil_assert(in_n_sets_per_pool             >  0);
+}
+
+/** Please see header for specification */
+Anvil::DescriptorPoolChain::~DescriptorPoolChain()
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+bool Anvil::DescriptorPoolChain::alloc_descriptor_set(const Anvil::DescriptorSetAllocation& in_ds_allocation,
+                                                      Anvil::DescriptorSetUniquePtr*        out_ds_ptr)
+{
+    bool result = false;
+
+    anvil_assert(out_ds_ptr != nullptr);
+
+    while (true)
+    {
+        bool is_new_pool = false;
+
+        if (m_n_current_pool == static_cast<uint32_t>(m_pools.size() ))
+        {
+            if (!create_pool() )
+            {
+                goto end;
+            }
+
+            is_new_pool = true;
+        }
+
+        if (m_pools.at(m_n_current_pool)->alloc_descriptor_sets(1, /* in_n_sets */
+                                                               &in_ds_allocation,
+                                                               out_ds_ptr) )
+        {
+            break;
+        }
+
+        /* Out of pool memory. If the set does not fit in an empty pool, it never will. The first pool of the chain
+         * may have been sized for past usage, though, in which case the next pool will use regular sizes. */
+        if (is_new_pool                                           &&
+            !(m_n_current_pool == 0 && m_is_first_pool_profiled) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        m_n_current_pool++;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Creates a new descriptor pool and appends it to the chain.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::DescriptorPoolChain::create_pool()
+{
+    static const Anvil::DescriptorType descriptor_types[] =
+    {
+        Anvil::DescriptorType::COMBINED_IMAGE_SAMPLER,
+        Anvil::DescriptorType::INPUT_ATTACHMENT,
+        Anvil::DescriptorType::SAMPLED_IMAGE,
+        Anvil::DescriptorType::SAMPLER,
+        Anvil::DescriptorType::STORAGE_BUFFER,
+        Anvil::DescriptorType::STORAGE_BUFFER_DYNAMIC,
+        Anvil::DescriptorType::STORAGE_IMAGE,
+        Anvil::DescriptorType::STORAGE_TEXEL_BUFFER,
+        Anvil::DescriptorType::UNIFORM_BUFFER,
+        Anvil::DescriptorType::UNIFORM_BUFFER_DYNAMIC,
+        Anvil::DescriptorType::UNIFORM_TEXEL_BUFFER,
+    };
+
+    Anvil::DescriptorPoolUsage     learned_usage;
+    uint32_t                       n_learned_descriptors = 0;
+    Anvil::DescriptorPoolUniquePtr pool_ptr;
+    bool                           result                = false;
+    auto                           sizing_profile_ptr    = m_device_ptr->get_descriptor_pool_sizing_profile();
+    const bool                     use_learned_usage     = (m_pools.size() == 0                               &&
+                                                            m_has_sizing_profile_key                         &&
+                                                            sizing_profile_ptr->is_adaptive_sizing_enabled() &&
+                                                            sizing_profile_ptr->get_usage(m_sizing_profile_key,
+                                                                                         &learned_usage) );
+
+    if (use_learned_usage)
+    {
+        for (const auto& current_descriptor_type : descriptor_types)
+        {
+            auto learned_type_iterator = learned_usage.n_descriptors_per_type.find(current_descriptor_type);
+
+            if (learned_type_iterator != learned_usage.n_descriptors_per_type.end() )
+            {
+                n_learned_descriptors += learned_type_iterator->second;
+            }
+        }
+    }
+
+    {
+        /* The chain's owner is responsible for synchronizing accesses to the pools */
+        auto create_info_ptr = Anvil::DescriptorPoolCreateInfo::create(m_device_ptr,
+                                                                       (n_learned_descriptors > 0) ? get_n_with_headroom(learned_usage.n_sets)
+                                                                                                   : m_n_sets_per_pool,
+                                                                       Anvil::DescriptorPoolCreateFlagBits::NONE,
+                                                                       Anvil::MTSafety::DISABLED);
+
+        for (const auto& current_descriptor_type : descriptor_types)
+        {
+            if (n_learned_descriptors > 0)
+            {
+                auto learned_type_iterator = learned_usage.n_descriptors_per_type.find(current_descriptor_type);
+
+                if (learned_type_iterator        != learned_usage.n_descriptors_per_type.end() &&
+                    learned_type_iterator->second > 0)
+                {
+                    create_info_ptr->set_n_descriptors_for_descriptor_type(current_descriptor_type,
+                                                                           get_n_with_headroom(learned_type_iterator->second) );
+                }
+            }
+            else
+            {
+                create_info_ptr->set_n_descriptors_for_descriptor_type(current_descriptor_type,
+                                                                       m_n_descriptors_per_type_pool);
+            }
+        }
+
+        pool_ptr = Anvil::DescriptorPool::create(std::move(create_info_ptr) );
+    }
+
+    if (pool_ptr == nullptr)
+    {
+        anvil_assert(pool_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (m_pools.size() == 0)
+    {
+        m_is_first_pool_profiled = (n_learned_descriptors > 0);
+    }
+
+    m_pools.push_back(
+        std::move(pool_ptr)
+    );
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::DescriptorPoolUsage Anvil::DescriptorPoolChain::get_usage() const
+{
+    Anvil::DescriptorPoolUsage result;
+
+    for (uint32_t n_pool = 0;
+                  n_pool < static_cast<uint32_t>(m_pools.size() ) && n_pool <= m_n_current_pool;
+                ++n_pool)
+    {
+        const auto& pool_usage = m_pools.at(n_pool)->get_usage();
+
+        result.n_sets += pool_usage.n_sets;
+
+        for (const auto& current_type_usage : pool_usage.n_descriptors_per_type)
+        {
+            result.n_descriptors_per_type[current_type_usage.first] += current_type_usage.second;
+        }
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::DescriptorPoolChain::reset()
+{
+    bool result = false;
+
+    /* Pools past the current one have not been allocated from since the last reset */
+    for (uint32_t n_pool = 0;
+                  n_pool < static_cast<uint32_t>(m_pools.size() ) && n_pool <= m_n_current_pool;
+                ++n_pool)
+    {
+        if (!m_pools.at(n_pool)->reset() )
+        {
+            goto end;
+        }
+    }
+
+    m_n_current_pool = 0;
+    result           = true;
+end:
+    return result;
+}
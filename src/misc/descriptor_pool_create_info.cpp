@@ -48,7 +48,8 @@ Anvil::DescriptorPoolCreateInfo::DescriptorPoolCreateInfo(const Anvil::BaseDevic
      m_device_ptr                         (in_device_ptr),
      m_mt_safety                          (in_mt_safety),
      m_n_max_inline_uniform_block_bindings(0),
-     m_n_max_sets                         (in_n_max_sets)
+     m_n_max_sets                         (in_n_max_sets),
+     m_should_recycle_released_sets       (false)
 {
     /* Stub */
 }
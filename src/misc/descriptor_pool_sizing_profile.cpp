@@ -0,0 +1,386 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/descriptor_pool_sizing_profile.h"
+#include "misc/descriptor_set_create_info.h"
+#include "misc/io.h"
+#include <algorithm>
+#include <string.h>
+
+static const uint32_t g_profile_magic   = 0x50445041; /* "APDP" */
+static const uint32_t g_profile_version = 1;
+
+
+/** Please see header for specification */
+Anvil::DescriptorPoolSizingProfile::DescriptorPoolSizingProfile()
+    :MTSafetySupportProvider  (true),
+     m_adaptive_sizing_enabled(false)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::DescriptorPoolSizingProfile::~DescriptorPoolSizingProfile()
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+void Anvil::DescriptorPoolSizingProfile::add_descriptor_set_usage(const Anvil::DescriptorSetCreateInfo* in_ds_create_info_ptr,
+                                                                  uint32_t                              in_n_variable_descriptors,
+                                                                  Anvil::DescriptorPoolUsage*           inout_usage_ptr)
+{
+    const uint32_t n_bindings                        = in_ds_create_info_ptr->get_n_bindings();
+    uint32_t       variable_descriptor_binding_index = UINT32_MAX;
+
+    in_ds_create_info_ptr->contains_variable_descriptor_count_binding(&variable_descriptor_binding_index);
+
+    for (uint32_t n_binding = 0;
+                  n_binding < n_bindings;
+                ++n_binding)
+    {
+        uint32_t              binding_array_size = 0;
+        uint32_t              binding_index      = UINT32_MAX;
+        Anvil::DescriptorType binding_type       = Anvil::DescriptorType::UNKNOWN;
+
+        in_ds_create_info_ptr->get_binding_properties_by_index_number(n_binding,
+                                                                     &binding_index,
+                                                                     &binding_type,
+                                                                     &binding_array_size);
+
+        if (binding_index == variable_descriptor_binding_index)
+        {
+            binding_array_size = in_n_variable_descriptors;
+        }
+
+        inout_usage_ptr->n_descriptors_per_type[binding_type] += binding_array_size;
+    }
+
+    inout_usage_ptr->n_sets++;
+}
+
+/** Please see header for specification */
+void Anvil::DescriptorPoolSizingProfile::clear()
+{
+    lock();
+    {
+        m_usage.clear();
+    }
+    unlock();
+}
+
+/** Please see header for specification */
+Anvil::DescriptorPoolSizingProfileUniquePtr Anvil::DescriptorPoolSizingProfile::create()
+{
+    Anvil::DescriptorPoolSizingProfileUniquePtr result_ptr(nullptr,
+                                                           std::default_delete<Anvil::DescriptorPoolSizingProfile>() );
+
+    result_ptr.reset(
+        new Anvil::DescriptorPoolSizingProfile()
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+uint64_t Anvil::DescriptorPoolSizingProfile::get_descriptor_set_key(const Anvil::DescriptorSetCreateInfo* in_ds_create_info_ptr)
+{
+    const uint32_t        n_bindings = in_ds_create_info_ptr->get_n_bindings();
+    std::vector<uint64_t> words;
+
+    words.reserve(1 + n_bindings * 6);
+
+    words.push_back(in_ds_create_info_ptr->get_create_flags().get_vk() );
+
+    for (uint32_t n_binding = 0;
+                  n_binding < n_bindings;
+                ++n_binding)
+    {
+        uint32_t                      binding_array_size         = 0;
+        Anvil::DescriptorBindingFlags binding_flags;
+        uint32_t                      binding_index              = UINT32_MAX;
+        Anvil::ShaderStageFlags       binding_stage_flags;
+        Anvil::DescriptorType         binding_type               = Anvil::DescriptorType::UNKNOWN;
+        bool                          immutable_samplers_enabled = false;
+
+        in_ds_create_info_ptr->get_binding_properties_by_index_number(n_binding,
+                                                                     &binding_index,
+                                                                     &binding_type,
+                                                                     &binding_array_size,
+                                                                     &binding_stage_flags,
+                                                                     &immutable_samplers_enabled,
+                                                                     &binding_flags);
+
+        words.push_back(binding_index);
+        words.push_back(binding_array_size);
+        words.push_back(static_cast<uint64_t>(binding_type) );
+        words.push_back(binding_flags.get_vk      () );
+        words.push_back(binding_stage_flags.get_vk() );
+        words.push_back((immutable_samplers_enabled) ? 1 : 0);
+    }
+
+    return Anvil::Utils::hash64(&words.at(0),
+                                words.size() * sizeof(words.at(0) ));
+}
+
+/** Please see header for specification */
+uint32_t Anvil::DescriptorPoolSizingProfile::get_n_keys() const
+{
+    uint32_t result;
+
+    lock();
+    {
+        result = static_cast<uint32_t>(m_usage.size() );
+    }
+    unlock();
+
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::DescriptorPoolSizingProfile::get_usage(uint64_t                    in_key,
+                                                   Anvil::DescriptorPoolUsage* out_usage_ptr) const
+{
+    bool result = false;
+
+    lock();
+    {
+        auto usage_iterator = m_usage.find(in_key);
+
+        if (usage_iterator != m_usage.end() )
+        {
+            *out_usage_ptr = usage_iterator->second;
+            result         = true;
+        }
+    }
+    unlock();
+
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::DescriptorPoolSizingProfile::load_from_file(const std::string& in_filename)
+{
+    char*                                                    data_ptr = nullptr;
+    uint32_t                                                 n_keys   = 0;
+    size_t                                                   n_bytes  = 0;
+    size_t                                                   n_words  = 0;
+    std::unordered_map<uint64_t, Anvil::DescriptorPoolUsage> loaded_usage;
+    uint32_t                                                 offset   = 0;
+    bool                                                     result   = false;
+    std::vector<uint32_t>                                    words;
+
+    if (!Anvil::IO::read_file(in_filename,
+                              false, /* in_is_text_file */
+                             &data_ptr,
+                             &n_bytes) )
+    {
+        goto end;
+    }
+
+    if ((n_bytes % sizeof(uint32_t)) != 0 ||
+         n_bytes                     <  sizeof(uint32_t) * 3)
+    {
+        goto end;
+    }
+
+    n_words = n_bytes / sizeof(uint32_t);
+
+    words.resize(n_words);
+
+    memcpy(&words.at(0),
+           data_ptr,
+           n_bytes);
+
+    if (words.at(0) != g_profile_magic   ||
+        words.at(1) != g_profile_version)
+    {
+        goto end;
+    }
+
+    n_keys = words.at(2);
+    offset = 3;
+
+    for (uint32_t n_key = 0;
+                  n_key < n_keys;
+                ++n_key)
+    {
+        Anvil::DescriptorPoolUsage usage;
+        uint64_t                   key;
+        uint32_t                   n_types;
+
+        /* Key (2 words), number of sets, number of descriptor types */
+        if (offset + 4 > n_words)
+        {
+            goto end;
+        }
+
+        key     = static_cast<uint64_t>(words.at(offset) ) | (static_cast<uint64_t>(words.at(offset + 1) ) << 32);
+        n_types = words.at(offset + 3);
+
+        usage.n_sets = words.at(offset + 2);
+        offset      += 4;
+
+        if (offset + static_cast<size_t>(n_types) * 2 > n_words)
+        {
+            goto end;
+        }
+
+        for (uint32_t n_type = 0;
+                      n_type < n_types;
+                    ++n_type)
+        {
+            usage.n_descriptors_per_type[static_cast<Anvil::DescriptorType>(words.at(offset) )] = words.at(offset + 1);
+
+            offset += 2;
+        }
+
+        loaded_usage[key] = usage;
+    }
+
+    if (offset != n_words)
+    {
+        goto end;
+    }
+
+    lock();
+    {
+        for (const auto& current_loaded_usage : loaded_usage)
+        {
+            auto& usage = m_usage[current_loaded_usage.first];
+
+            usage.n_sets = std::max(usage.n_sets,
+                                    current_loaded_usage.second.n_sets);
+
+            for (const auto& current_type_usage : current_loaded_usage.second.n_descriptors_per_type)
+            {
+                auto& n_descriptors = usage.n_descriptors_per_type[current_type_usage.first];
+
+                n_descriptors = std::max(n_descriptors,
+                                         current_type_usage.second);
+            }
+        }
+    }
+    unlock();
+
+    result = true;
+end:
+    delete [] data_ptr;
+
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::DescriptorPoolSizingProfile::record_usage(uint64_t                          in_key,
+                                                      const Anvil::DescriptorPoolUsage& in_usage)
+{
+    /* Moves a recorded value towards a new observation. Increases apply at once, decreases only in part. */
+    auto update_value = [](uint32_t* inout_value_ptr,
+                           uint32_t  in_observed_value)
+    {
+        if (in_observed_value >= *inout_value_ptr)
+        {
+            *inout_value_ptr = in_observed_value;
+        }
+        else
+        {
+            *inout_value_ptr -= (*inout_value_ptr - in_observed_value) / 4;
+        }
+    };
+
+    if (in_usage.n_sets == 0)
+    {
+        goto end;
+    }
+
+    lock();
+    {
+        auto usage_iterator = m_usage.find(in_key);
+
+        if (usage_iterator == m_usage.end() )
+        {
+            m_usage[in_key] = in_usage;
+        }
+        else
+        {
+            auto& usage = usage_iterator->second;
+
+            update_value(&usage.n_sets,
+                         in_usage.n_sets);
+
+            for (auto& current_type_usage : usage.n_descriptors_per_type)
+            {
+                auto observed_iterator = in_usage.n_descriptors_per_type.find(current_type_usage.first);
+
+                update_value(&current_type_usage.second,
+                             (observed_iterator != in_usage.n_descriptors_per_type.end() ) ? observed_iterator->second
+                                                                                           : 0);
+            }
+
+            for (const auto& current_observed_type_usage : in_usage.n_descriptors_per_type)
+            {
+                if (usage.n_descriptors_per_type.find(current_observed_type_usage.first) == usage.n_descriptors_per_type.end() )
+                {
+                    usage.n_descriptors_per_type[current_observed_type_usage.first] = current_observed_type_usage.second;
+                }
+            }
+        }
+    }
+    unlock();
+
+end:
+    ;
+}
+
+/** Please see header for specification */
+bool Anvil::DescriptorPoolSizingProfile::store_to_file(const std::string& in_filename) const
+{
+    std::vector<uint32_t> words;
+
+    words.push_back(g_profile_magic);
+    words.push_back(g_profile_version);
+
+    lock();
+    {
+        words.push_back(static_cast<uint32_t>(m_usage.size() ));
+
+        for (const auto& current_usage : m_usage)
+        {
+            words.push_back(static_cast<uint32_t>(current_usage.first & 0xFFFFFFFFu) );
+            words.push_back(static_cast<uint32_t>(current_usage.first >> 32) );
+            words.push_back(current_usage.second.n_sets);
+            words.push_back(static_cast<uint32_t>(current_usage.second.n_descriptors_per_type.size() ));
+
+            for (const auto& current_type_usage : current_usage.second.n_descriptors_per_type)
+            {
+                words.push_back(static_cast<uint32_t>(current_type_usage.first) );
+                words.push_back(current_type_usage.second);
+            }
+        }
+    }
+    unlock();
+
+    return Anvil::IO::write_binary_file(in_filename,
+                                        &words.at(0),
+                                        static_cast<unsigned int>(words.size() * sizeof(uint32_t) ));
+}
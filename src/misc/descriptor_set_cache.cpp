@@ -0,0 +1,307 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/descriptor_set_cache.h"
+#include "misc/descriptor_set_create_info.h"
+#include "wrappers/descriptor_set.h"
+#include "wrappers/descriptor_set_layout.h"
+#include "wrappers/device.h"
+
+
+/** Please see header for specification */
+Anvil::DescriptorSetCache::DescriptorSetCache(const Anvil::BaseDevice* in_device_ptr,
+                                              uint32_t                 in_n_sets_per_pool,
+                                              uint32_t                 in_n_descriptors_per_type_pool,
+                                              bool                     in_mt_safe)
+    :MTSafetySupportProvider      (in_mt_safe),
+     m_device_ptr                 (in_device_ptr),
+     m_n_cache_hits               (0),
+     m_n_cache_misses             (0),
+     m_pool_chain                 (in_device_ptr,
+                                   in_n_sets_per_pool,
+                                   in_n_descriptors_per_type_pool)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::DescriptorSetCache::~DescriptorSetCache()
+{
+    lock();
+    {
+        /* Release set wrappers before the pools they have been allocated from */
+        m_cache.clear();
+    }
+    unlock();
+}
+
+/** Allocates a new descriptor set from the pool chain. If the current pool runs out of space, the next one is used.
+ *
+ *  @param in_ds_layout_ptr Layout to allocate the set with. Must not be null.
+ *
+ *  @return Descriptor set if successful, null otherwise.
+ */
+Anvil::DescriptorSetUniquePtr Anvil::DescriptorSetCache::alloc_descriptor_set(const Anvil::DescriptorSetLayout* in_ds_layout_ptr)
+{
+    const Anvil::DescriptorSetAllocation ds_allocation(in_ds_layout_ptr);
+    Anvil::DescriptorSetUniquePtr        result_ptr;
+
+    if (!m_pool_chain.alloc_descriptor_set(ds_allocation,
+                                          &result_ptr) )
+    {
+        result_ptr.reset();
+    }
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+void Anvil::DescriptorSetCache::clear()
+{
+    lock();
+    {
+        m_cache.clear();
+        m_pool_chain.reset();
+    }
+    unlock();
+}
+
+/** Please see header for specification */
+Anvil::DescriptorSetCacheUniquePtr Anvil::DescriptorSetCache::create(const Anvil::BaseDevice* in_device_ptr,
+                                                                     uint32_t                 in_n_sets_per_pool,
+                                                                     uint32_t                 in_n_descriptors_per_type_pool,
+                                                                     bool                     in_mt_safe)
+{
+    Anvil::DescriptorSetCacheUniquePtr result_ptr(nullptr,
+                                                  std::default_delete<Anvil::DescriptorSetCache>() );
+
+    anvil_assert(in_device_ptr                  != nullptr);
+    anvil_assert(in_n_descriptors_per_type_pool >  0);
+    anvil_assert(in_n_sets_per_pool             >  0);
+
+    result_ptr.reset(
+        new Anvil::DescriptorSetCache(in_device_ptr,
+                                      in_n_sets_per_pool,
+                                      in_n_descriptors_per_type_pool,
+                                      in_mt_safe)
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+Anvil::DescriptorSet* Anvil::DescriptorSetCache::get_descriptor_set(const Anvil::DescriptorSetLayout* in_ds_layout_ptr,
+                                                                    const Contents&                   in_contents)
+{
+    Anvil::DescriptorSetUniquePtr ds_ptr;
+    uint64_t                      key_hash   = 0;
+    Anvil::DescriptorSet*         result_ptr = nullptr;
+
+    anvil_assert(in_ds_layout_ptr != nullptr);
+    anvil_assert(!in_ds_layout_ptr->get_create_info()->contains_variable_descriptor_count_binding() );
+
+    lock();
+    {
+        in_contents.get_key(in_ds_layout_ptr,
+                           &m_scratch_key);
+
+        key_hash = Anvil::Utils::hash64(&m_scratch_key.at(0),
+                                        m_scratch_key.size() * sizeof(m_scratch_key.at(0) ));
+
+        /* Look for a set whose contents matches. The whole key is compared, so hash collisions cannot result in
+         * a wrong set being returned. */
+        {
+            auto cache_iterator = m_cache.find(key_hash);
+
+            if (cache_iterator != m_cache.end() )
+            {
+                for (const auto& current_entry : cache_iterator->second)
+                {
+                    if (current_entry.key == m_scratch_key)
+                    {
+                        result_ptr = current_entry.ds_ptr.get();
+
+                        m_n_cache_hits++;
+
+                        goto end;
+                    }
+                }
+            }
+        }
+
+        /* Cache miss. Create, fill and bake a new set. */
+        ds_ptr = alloc_descriptor_set(in_ds_layout_ptr);
+
+        if (ds_ptr == nullptr)
+        {
+            goto end;
+        }
+
+        for (const auto& current_setter : in_contents.m_setters)
+        {
+            if (!current_setter(ds_ptr.get() ))
+            {
+                anvil_assert_fail();
+
+                goto end;
+            }
+        }
+
+        if (ds_ptr->get_descriptor_set_vk() == VK_NULL_HANDLE)
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        result_ptr = ds_ptr.get();
+
+        m_cache[key_hash].emplace_back(m_scratch_key,
+                                       std::move(ds_ptr) );
+
+        m_n_cache_misses++;
+    }
+end:
+    unlock();
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::DescriptorSetCache::get_n_cached_sets() const
+{
+    uint32_t result = 0;
+
+    lock();
+    {
+        for (const auto& current_bucket : m_cache)
+        {
+            result += static_cast<uint32_t>(current_bucket.second.size() );
+        }
+    }
+    unlock();
+
+    return result;
+}
+
+/** Returns key words describing a buffer binding element. */
+Anvil::DescriptorSetCache::Contents::ElementKey Anvil::DescriptorSetCache::Contents::get_element_key(const Anvil::DescriptorSet::BufferBindingElement& in_element)
+{
+    ElementKey result =
+    {
+        static_cast<uint64_t>(in_element.get_type() ),
+        reinterpret_cast<uint64_t>(in_element.buffer_ptr),
+        0,
+        in_element.start_offset,
+        in_element.size
+    };
+
+    return result;
+}
+
+/** Returns key words describing a combined image+sampler binding element. */
+Anvil::DescriptorSetCache::Contents::ElementKey Anvil::DescriptorSetCache::Contents::get_element_key(const Anvil::DescriptorSet::CombinedImageSamplerBindingElement& in_element)
+{
+    ElementKey result =
+    {
+        static_cast<uint64_t>(in_element.get_type() ),
+        reinterpret_cast<uint64_t>(in_element.image_view_ptr),
+        reinterpret_cast<uint64_t>(in_element.sampler_ptr),
+        static_cast<uint64_t>(in_element.image_layout),
+        0
+    };
+
+    return result;
+}
+
+/** Returns key words describing an image binding element. */
+Anvil::DescriptorSetCache::Contents::ElementKey Anvil::DescriptorSetCache::Contents::get_element_key(const Anvil::DescriptorSet::ImageBindingElement& in_element)
+{
+    ElementKey result =
+    {
+        static_cast<uint64_t>(in_element.get_type() ),
+        reinterpret_cast<uint64_t>(in_element.image_view_ptr),
+        0,
+        static_cast<uint64_t>(in_element.image_layout),
+        0
+    };
+
+    return result;
+}
+
+/** Returns key words describing a sampler binding element. */
+Anvil::DescriptorSetCache::Contents::ElementKey Anvil::DescriptorSetCache::Contents::get_element_key(const Anvil::DescriptorSet::SamplerBindingElement& in_element)
+{
+    ElementKey result =
+    {
+        static_cast<uint64_t>(in_element.get_type() ),
+        reinterpret_cast<uint64_t>(in_element.sampler_ptr),
+        0,
+        0,
+        0
+    };
+
+    return result;
+}
+
+/** Returns key words describing a texel buffer binding element. */
+Anvil::DescriptorSetCache::Contents::ElementKey Anvil::DescriptorSetCache::Contents::get_element_key(const Anvil::DescriptorSet::TexelBufferBindingElement& in_element)
+{
+    ElementKey result =
+    {
+        static_cast<uint64_t>(in_element.get_type() ),
+        reinterpret_cast<uint64_t>(in_element.buffer_view_ptr),
+        0,
+        0,
+        0
+    };
+
+    return result;
+}
+
+/** Flattens the layout and all assigned descriptors into a vector of words, which is used to look up cached sets.
+ *
+ *  Elements are stored in (binding, array element) order, so the key does not depend on the order in which
+ *  the descriptors have been assigned.
+ *
+ *  @param in_ds_layout_ptr Layout the set is going to use.
+ *  @param out_key_ptr      Deref will be set to the key. Must not be null.
+ */
+void Anvil::DescriptorSetCache::Contents::get_key(const Anvil::DescriptorSetLayout* in_ds_layout_ptr,
+                                                  std::vector<uint64_t>*            out_key_ptr) const
+{
+    out_key_ptr->clear  ();
+    out_key_ptr->reserve(1 + m_elements.size() * (2 + std::tuple_size<ElementKey>::value) );
+
+    out_key_ptr->push_back(reinterpret_cast<uint64_t>(in_ds_layout_ptr) );
+
+    for (const auto& current_element : m_elements)
+    {
+        out_key_ptr->push_back(current_element.first.first);
+        out_key_ptr->push_back(current_element.first.second);
+
+        out_key_ptr->insert(out_key_ptr->end(),
+                            current_element.second.begin(),
+                            current_element.second.end  () );
+    }
+}
@@ -21,13 +21,16 @@
 //
 
 #include "misc/descriptor_set_create_info.h"
+#include "misc/sampler_create_info.h"
 #include "misc/struct_chainer.h"
+#include "wrappers/descriptor_set.h"
 #include "wrappers/device.h"
 #include "wrappers/sampler.h"
 
 /** Please see header for specification */
 Anvil::DescriptorSetCreateInfo::DescriptorSetCreateInfo()
-    :m_n_variable_descriptor_count_binding   (UINT32_MAX),
+    :m_create_flags                          (Anvil::DescriptorSetLayoutCreateFlagBits::NONE),
+     m_n_variable_descriptor_count_binding   (UINT32_MAX),
      m_variable_descriptor_count_binding_size(0)
 {
     /* Stub */
@@ -135,6 +138,32 @@ std::unique_ptr<Anvil::DescriptorSetLayoutCreateInfoContainer> Anvil::Descriptor
         goto end;
     }
 
+    if ((m_create_flags & Anvil::DescriptorSetLayoutCreateFlagBits::PUSH_DESCRIPTOR_BIT_KHR) != 0)
+    {
+        if (!in_device_ptr->get_extension_info()->khr_push_descriptor() )
+        {
+            anvil_assert(in_device_ptr->get_extension_info()->khr_push_descriptor() );
+
+            result_ptr.reset();
+            goto end;
+        }
+
+        for (const auto& current_binding : m_bindings)
+        {
+            /* These are not allowed in push descriptor set layouts, as per spec */
+            if (current_binding.second.descriptor_type == Anvil::DescriptorType::INLINE_UNIFORM_BLOCK                          ||
+                current_binding.second.descriptor_type == Anvil::DescriptorType::STORAGE_BUFFER_DYNAMIC                        ||
+                current_binding.second.descriptor_type == Anvil::DescriptorType::UNIFORM_BUFFER_DYNAMIC                        ||
+               (current_binding.second.flags           &  Anvil::DescriptorBindingFlagBits::UPDATE_AFTER_BIND_BIT)        != 0)
+            {
+                anvil_assert_fail();
+
+                result_ptr.reset();
+                goto end;
+            }
+        }
+    }
+
     /* Count the number of immutable samplers defined. This is needed because if sampler_items is reallocated
      * after we start building the VkSampler array contents, all previously initialized VkDescriptorSetLayoutBinding
      * instances will start referring to invalid sampler arrays.
@@ -171,7 +200,7 @@ std::unique_ptr<Anvil::DescriptorSetLayoutCreateInfoContainer> Anvil::Descriptor
         VkDescriptorSetLayoutCreateInfo create_info;
 
         create_info.bindingCount = n_bindings_defined;
-        create_info.flags        = 0;
+        create_info.flags        = m_create_flags.get_vk();
         create_info.pNext        = nullptr;
         create_info.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
 
@@ -400,6 +429,73 @@ end:
     return result;
 }
 
+/* Please see header for specification */
+uint32_t Anvil::DescriptorSetCreateInfo::promote_uniform_samplers(uint32_t                           in_n_sets,
+                                                                  const Anvil::DescriptorSet* const* in_ds_ptrs)
+{
+    uint32_t result = 0;
+
+    anvil_assert(in_n_sets  >  0);
+    anvil_assert(in_ds_ptrs != nullptr);
+
+    for (auto& binding_item : m_bindings)
+    {
+        Anvil::DescriptorSetCreateInfo::Binding& binding     = binding_item.second;
+        const Anvil::Sampler*                    sampler_ptr = nullptr;
+
+        if (binding.descriptor_type != Anvil::DescriptorType::COMBINED_IMAGE_SAMPLER &&
+            binding.descriptor_type != Anvil::DescriptorType::SAMPLER)
+        {
+            continue;
+        }
+
+        if (binding.immutable_samplers.size()                                                        >  0 ||
+            (binding.flags & Anvil::DescriptorBindingFlagBits::VARIABLE_DESCRIPTOR_COUNT_BIT) != 0)
+        {
+            continue;
+        }
+
+        for (uint32_t n_set = 0;
+                      n_set < in_n_sets;
+                    ++n_set)
+        {
+            const Anvil::Sampler* set_sampler_ptr = nullptr;
+
+            if (!in_ds_ptrs[n_set]->get_uniform_sampler(binding_item.first,
+                                                       &set_sampler_ptr) )
+            {
+                sampler_ptr = nullptr;
+
+                break;
+            }
+
+            if (sampler_ptr == nullptr)
+            {
+                sampler_ptr = set_sampler_ptr;
+            }
+            else if (sampler_ptr != set_sampler_ptr                                                    &&
+                     !(*sampler_ptr->get_create_info_ptr() == *set_sampler_ptr->get_create_info_ptr()) )
+            {
+                sampler_ptr = nullptr;
+
+                break;
+            }
+        }
+
+        if (sampler_ptr == nullptr)
+        {
+            continue;
+        }
+
+        binding.immutable_samplers.assign(binding.descriptor_array_size,
+                                          sampler_ptr);
+
+        ++result;
+    }
+
+    return result;
+}
+
 bool Anvil::DescriptorSetCreateInfo::set_binding_variable_descriptor_count(const uint32_t& in_count)
 {
     uint32_t binding_index = UINT32_MAX;
@@ -420,10 +516,41 @@ end:
     return result;
 }
 
+/* Please see header for specification */
+uint64_t Anvil::DescriptorSetCreateInfo::get_hash() const
+{
+    std::vector<uint64_t> words;
+
+    words.reserve(3 + m_bindings.size() * 6);
+
+    words.push_back(m_create_flags.get_vk() );
+    words.push_back(m_n_variable_descriptor_count_binding);
+    words.push_back(m_variable_descriptor_count_binding_size);
+
+    for (const auto& current_binding : m_bindings)
+    {
+        words.push_back(current_binding.first);
+        words.push_back(current_binding.second.descriptor_array_size);
+        words.push_back(static_cast<uint64_t>(current_binding.second.descriptor_type) );
+        words.push_back(current_binding.second.flags.get_vk() );
+        words.push_back(current_binding.second.stage_flags.get_vk() );
+        words.push_back(current_binding.second.immutable_samplers.size() );
+
+        for (const auto& current_sampler_ptr : current_binding.second.immutable_samplers)
+        {
+            words.push_back(reinterpret_cast<uint64_t>(current_sampler_ptr) );
+        }
+    }
+
+    return Anvil::Utils::hash64(&words.at(0),
+                                words.size() * sizeof(words.at(0) ));
+}
+
 /** Please see header for specification */
 bool Anvil::DescriptorSetCreateInfo::operator==(const Anvil::DescriptorSetCreateInfo& in_ds) const
 {
     return (m_bindings                               == in_ds.m_bindings                               &&
+            m_create_flags                           == in_ds.m_create_flags                           &&
             m_n_variable_descriptor_count_binding    == in_ds.m_n_variable_descriptor_count_binding    &&
             m_variable_descriptor_count_binding_size == in_ds.m_variable_descriptor_count_binding_size);
 }
\ No newline at end of file
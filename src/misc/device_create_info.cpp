@@ -72,13 +72,19 @@ Anvil::DeviceCreateInfo::DeviceCreateInfo(const std::vector<const Anvil::Physica
                                           const std::vector<std::string>&                  in_layers_to_enable,
                                           const Anvil::CommandPoolCreateFlags&             in_helper_command_pool_create_flags,
                                           const bool&                                      in_mt_safe)
-    :m_extension_configuration          (in_extension_configuration),
-     m_helper_command_pool_create_flags (in_helper_command_pool_create_flags),
-     m_layers_to_enable                 (in_layers_to_enable),
-     m_memory_overallocation_behavior   (Anvil::MemoryOverallocationBehavior::DEFAULT),
-     m_mt_safe                          (in_mt_safe),
-     m_physical_device_ptrs             (in_physical_device_ptrs),
-     m_should_enable_shader_module_cache(in_enable_shader_module_cache)
+    :m_extension_configuration                     (in_extension_configuration),
+     m_helper_command_pool_create_flags            (in_helper_command_pool_create_flags),
+     m_host_allocator_ptr                          (nullptr),
+     m_layers_to_enable                            (in_layers_to_enable),
+     m_memory_overallocation_behavior              (Anvil::MemoryOverallocationBehavior::DEFAULT),
+     m_mt_safe                                     (in_mt_safe),
+     m_physical_device_ptrs                        (in_physical_device_ptrs),
+     m_should_defer_extension_entrypoint_resolution(false),
+     m_should_enable_shader_module_cache           (in_enable_shader_module_cache),
+     m_should_prewarm_format_capability_cache      (false),
+     m_should_probe_storage_features               (false),
+     m_staging_ring_size                           (0),
+     m_task_scheduler_ptr                          (nullptr)
 {
     if (in_physical_device_ptrs.size() > 1)
     {
@@ -89,4 +95,32 @@ Anvil::DeviceCreateInfo::DeviceCreateInfo(const std::vector<const Anvil::Physica
             anvil_assert(current_physical_device_ptr->get_instance() == in_physical_device_ptrs.at(0)->get_instance() );
         }
     }
-}
\ No newline at end of file
+}
+
+/** Please see header for specification */
+void Anvil::DeviceCreateInfo::set_storage_feature_probe(const bool& in_should_probe)
+{
+    if (in_should_probe)
+    {
+        static const char* const storage_extension_names[] =
+        {
+            VK_EXT_SCALAR_BLOCK_LAYOUT_EXTENSION_NAME,
+            VK_KHR_16BIT_STORAGE_EXTENSION_NAME,
+            VK_KHR_8BIT_STORAGE_EXTENSION_NAME,
+            VK_KHR_SHADER_FLOAT16_INT8_EXTENSION_NAME,
+            VK_KHR_STORAGE_BUFFER_STORAGE_CLASS_EXTENSION_NAME,
+        };
+
+        for (const auto& current_extension_name : storage_extension_names)
+        {
+            auto& current_status = m_extension_configuration.extension_status[current_extension_name];
+
+            if (current_status == Anvil::ExtensionAvailability::IGNORE)
+            {
+                current_status = Anvil::ExtensionAvailability::ENABLE_IF_AVAILABLE;
+            }
+        }
+    }
+
+    m_should_probe_storage_features = in_should_probe;
+}
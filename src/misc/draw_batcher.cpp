@@ -0,0 +1,225 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#include "misc/debug.h"
+#include "misc/debug.h"
+#include "misc/draw_batcher.h"
+#include "misc/transient_buffer_allocator.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/device.h"
+#include <algorithm>
+
+
+/** Please see header for specification */
+Anvil::DrawBatcher::DrawBatcher(const Anvil::BaseDevice*         in_device_ptr,
+                                Anvil::TransientBufferAllocator* in_transient_allocator_ptr)
+    :m_device_ptr                           (in_device_ptr),
+     m_draw_indirect_first_instance_supported(false),
+     m_max_draws_per_call                   (1),
+     m_n_recorded_draw_calls                (0),
+     m_transient_allocator_ptr              (in_transient_allocator_ptr)
+{
+    const auto& features = *in_device_ptr->get_physical_device_features  ().core_vk1_0_features_ptr;
+    const auto& limits   =  in_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits;
+
+    m_draw_indirect_first_instance_supported = features.draw_indirect_first_instance;
+
+    /* Without multiDrawIndirect, each indirect call can only consume a single draw command. */
+    if (features.multi_draw_indirect)
+    {
+        m_max_draws_per_call = std::max(limits.max_draw_indirect_count,
+                                        1u);
+    }
+}
+
+/** Please see header for specification */
+Anvil::DrawBatcher::~DrawBatcher()
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+void Anvil::DrawBatcher::add_draw_indexed(uint64_t in_bucket_key,
+                                          uint32_t in_index_count,
+                                          uint32_t in_instance_count,
+                                          uint32_t in_first_index,
+                                          int32_t  in_vertex_offset,
+                                          uint32_t in_first_instance)
+{
+    auto&                        bucket = m_buckets[in_bucket_key];
+    VkDrawIndexedIndirectCommand draw;
+
+    anvil_assert(in_first_instance == 0                       ||
+                 m_draw_indirect_first_instance_supported);
+
+    if (bucket.draws.empty() )
+    {
+        m_active_bucket_keys.push_back(in_bucket_key);
+    }
+
+    draw.firstIndex    = in_first_index;
+    draw.firstInstance = in_first_instance;
+    draw.indexCount    = in_index_count;
+    draw.instanceCount = in_instance_count;
+    draw.vertexOffset  = in_vertex_offset;
+
+    bucket.draws.push_back(draw);
+}
+
+/** Please see header for specification */
+Anvil::DrawBatcherUniquePtr Anvil::DrawBatcher::create(const Anvil::BaseDevice*         in_device_ptr,
+                                                       Anvil::TransientBufferAllocator* in_transient_allocator_ptr)
+{
+    Anvil::DrawBatcherUniquePtr result_ptr(nullptr,
+                                           std::default_delete<Anvil::DrawBatcher>() );
+
+    anvil_assert(in_device_ptr              != nullptr);
+    anvil_assert(in_transient_allocator_ptr != nullptr);
+
+    if ((in_transient_allocator_ptr->get_usage_flags() & Anvil::BufferUsageFlagBits::INDIRECT_BUFFER_BIT) == 0)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    result_ptr.reset(
+        new Anvil::DrawBatcher(in_device_ptr,
+                               in_transient_allocator_ptr)
+    );
+
+end:
+    return result_ptr;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::DrawBatcher::get_n_draws(uint64_t in_bucket_key) const
+{
+    auto     bucket_iterator = m_buckets.find(in_bucket_key);
+    uint32_t result          = 0;
+
+    if (bucket_iterator != m_buckets.end() )
+    {
+        result = static_cast<uint32_t>(bucket_iterator->second.draws.size() );
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::DrawBatcher::record_bucket(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                       uint64_t                  in_bucket_key)
+{
+    Anvil::TransientBufferAllocator::Allocation allocation;
+    auto                                        bucket_iterator = m_buckets.find(in_bucket_key);
+    uint32_t                                    n_draws         = 0;
+    bool                                        result          = false;
+    const uint32_t                              stride          = static_cast<uint32_t>(sizeof(VkDrawIndexedIndirectCommand) );
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    if (bucket_iterator == m_buckets.end() ||
+        bucket_iterator->second.draws.empty() )
+    {
+        result = true;
+
+        goto end;
+    }
+
+    n_draws = static_cast<uint32_t>(bucket_iterator->second.draws.size() );
+
+    if (!m_transient_allocator_ptr->allocate_and_write(static_cast<VkDeviceSize>(n_draws) * stride,
+                                                       bucket_iterator->second.draws.data(),
+                                                      &allocation) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    /* Transient allocations are host-coherent, so the commands are visible to the device once the command
+     * buffer is submitted. */
+    for (uint32_t n_first_draw  = 0;
+                  n_first_draw  < n_draws;
+                  n_first_draw += m_max_draws_per_call)
+    {
+        const uint32_t n_draws_in_call = std::min(n_draws - n_first_draw,
+                                                  m_max_draws_per_call);
+
+        if (!in_cmd_buffer_ptr->record_draw_indexed_indirect(allocation.buffer_ptr,
+                                                             allocation.offset + static_cast<VkDeviceSize>(n_first_draw) * stride,
+                                                             n_draws_in_call,
+                                                             stride) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        ++m_n_recorded_draw_calls;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::DrawBatcher::record_buckets(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                        const BindStateFunction&  in_bind_state_function)
+{
+    bool result = true;
+
+    anvil_assert(in_bind_state_function != nullptr);
+
+    for (const auto& current_bucket_key : m_active_bucket_keys)
+    {
+        if (!in_bind_state_function(in_cmd_buffer_ptr,
+                                    current_bucket_key) )
+        {
+            continue;
+        }
+
+        if (!record_bucket(in_cmd_buffer_ptr,
+                           current_bucket_key) )
+        {
+            result = false;
+
+            break;
+        }
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::DrawBatcher::reset()
+{
+    /* Clear the draw vectors rather than the map, so that their storage is reused in the next frame. */
+    for (auto& current_bucket : m_buckets)
+    {
+        current_bucket.second.draws.clear();
+    }
+
+    m_active_bucket_keys.clear();
+
+    m_n_recorded_draw_calls = 0;
+}
@@ -21,19 +21,78 @@
 //
 #include "misc/buffer_create_info.h"
 #include "misc/dummy_window.h"
+#include "misc/fence_create_info.h"
 #include "misc/image_create_info.h"
 #include "misc/io.h"
 #include "misc/swapchain_create_info.h"
 #include "wrappers/buffer.h"
 #include "wrappers/command_buffer.h"
 #include "wrappers/command_pool.h"
+#include "wrappers/device.h"
+#include "wrappers/fence.h"
+#include "wrappers/image.h"
+#include "wrappers/queue.h"
 #include "wrappers/semaphore.h"
 #include "wrappers/swapchain.h"
+#include <algorithm>
 #include <sstream>
 #include <thread>
 
 #include "miniz/miniz.c"
 
+namespace
+{
+    /* Maximum number of frames whose captures can be in flight at the same time. */
+    static const uint32_t N_MAX_PENDING_FRAMES = 3;
+
+    /* Maximum number of encoder threads. Encoding is CPU-bound, but there is rarely more than a couple of frames
+     * to encode at any time. */
+    static const uint32_t N_MAX_ENCODER_THREADS = 4;
+
+    /** Encodes a captured frame in the requested format and writes it to a file.
+     *
+     *  @param in_filename Name of the file to write, without an extension.
+     *  @param in_format   Format to use.
+     *  @param in_data_ptr Tightly packed R8G8B8A8_UNORM texels. Must not be null.
+     *  @param in_width    Frame width.
+     *  @param in_height   Frame height.
+     */
+    void store_frame(const std::string&                                 in_filename,
+                     Anvil::DummyWindowWithPNGSnapshots::SnapshotFormat in_format,
+                     const uint8_t*                                     in_data_ptr,
+                     uint32_t                                           in_width,
+                     uint32_t                                           in_height)
+    {
+        if (in_format == Anvil::DummyWindowWithPNGSnapshots::SnapshotFormat::PNG)
+        {
+            void*  result_data_ptr  = nullptr;
+            size_t result_data_size = 0;
+
+            result_data_ptr = tdefl_write_image_to_png_file_in_memory(in_data_ptr,
+                                                                      static_cast<int32_t>(in_width),
+                                                                      static_cast<int32_t>(in_height),
+                                                                      4, /* num_chans */
+                                                                     &result_data_size);
+
+            anvil_assert(result_data_ptr != nullptr);
+
+            Anvil::IO::write_binary_file(in_filename + ".png",
+                                         result_data_ptr,
+                                         static_cast<uint32_t>(result_data_size) );
+
+            free(result_data_ptr);
+        }
+        else
+        {
+            anvil_assert(in_format == Anvil::DummyWindowWithPNGSnapshots::SnapshotFormat::RAW_R8G8B8A8_UNORM);
+
+            Anvil::IO::write_binary_file(in_filename + ".rgba",
+                                         in_data_ptr,
+                                         4 /* RGBA8 */ * in_width * in_height);
+        }
+    }
+}
+
 /** Please see header for specification */
 Anvil::WindowUniquePtr Anvil::DummyWindow::create(const std::string&      in_title,
                                                   unsigned int            in_width,
@@ -154,68 +213,53 @@ Anvil::DummyWindowWithPNGSnapshots::DummyWindowWithPNGSnapshots(const std::strin
                  in_height,
                  in_present_callback_func)
 {
-    m_height             = in_height;
-    m_n_frames_presented = 0;
-    m_swapchain_ptr      = nullptr;
-    m_title              = in_title;
-    m_width              = in_width;
-    m_window_owned       = true;
+    m_height                      = in_height;
+    m_intermediate_image_used     = false;
+    m_n_busy_encoder_threads      = 0;
+    m_n_frames_presented          = 0;
+    m_should_encoder_threads_quit = false;
+    m_snapshot_format             = SnapshotFormat::PNG;
+    m_swapchain_ptr               = nullptr;
+    m_title                       = in_title;
+    m_width                       = in_width;
+    m_window_owned                = true;
 }
 
 /** Please see header for specification */
-std::unique_ptr<uint8_t[]> Anvil::DummyWindowWithPNGSnapshots::get_swapchain_image_raw_r8g8b8a8_unorm_data(Anvil::Image* in_swapchain_image_ptr)
+Anvil::DummyWindowWithPNGSnapshots::~DummyWindowWithPNGSnapshots()
 {
-    const Anvil::BaseDevice*           device_ptr                       (m_swapchain_ptr->get_create_info_ptr()->get_device() );
-    std::unique_ptr<uint8_t[]>         result_ptr;
-    Anvil::Format                      swapchain_image_format           (in_swapchain_image_ptr->get_create_info_ptr()->get_format() );
-    const Anvil::ImageSubresourceRange swapchain_image_subresource_range(in_swapchain_image_ptr->get_subresource_range            () );
-
-    /* Sanity checks .. */
-    ANVIL_REDUNDANT_VARIABLE(swapchain_image_format);
-
-    anvil_assert(swapchain_image_subresource_range.aspect_mask == Anvil::ImageAspectFlagBits::COLOR_BIT);
-
-    /* Initialize storage for the raw R8G8B8A8 image data */
-    Anvil::BufferUniquePtr raw_image_buffer_ptr;
-    uint32_t               raw_image_size         = 0;
-    uint32_t               swapchain_image_height = 0;
-    uint32_t               swapchain_image_width  = 0;
-
-    in_swapchain_image_ptr->get_image_mipmap_size(0, /* n_mipmap */
-                                                 &swapchain_image_width,
-                                                 &swapchain_image_height,
-                                                 nullptr); /* out_opt_depth_ptr */
-
-    raw_image_size = 4 /* RGBA8 */ * swapchain_image_width * swapchain_image_height;
-
-    result_ptr.reset(new unsigned char[raw_image_size]);
-
-    {
-        auto create_info_ptr = Anvil::BufferCreateInfo::create_alloc(device_ptr,
-                                                                     raw_image_size,
-                                                                     Anvil::QueueFamilyFlagBits::GRAPHICS_BIT,
-                                                                     Anvil::SharingMode::EXCLUSIVE,
-                                                                     Anvil::BufferCreateFlagBits::NONE,
-                                                                     Anvil::BufferUsageFlagBits::TRANSFER_DST_BIT,
-                                                                     Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT);
+    stop_encoder_threads();
+}
 
-        create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+/** Please see header for specification */
+bool Anvil::DummyWindowWithPNGSnapshots::capture_swapchain_frame()
+{
+    Anvil::PrimaryCommandBufferUniquePtr command_buffer_ptr;
+    const Anvil::BaseDevice*             device_ptr           (m_swapchain_ptr->get_create_info_ptr()->get_device() );
+    PendingFrame                         new_frame;
+    bool                                 result               (false);
+    const uint32_t                       swapchain_image_index(m_swapchain_ptr->get_last_acquired_image_index() );
+    Anvil::Image*                        swapchain_image_ptr  (m_swapchain_ptr->get_image                    (swapchain_image_index) );
+    Anvil::Queue*                        universal_queue_ptr  (device_ptr->get_universal_queue               (0) );
 
-        raw_image_buffer_ptr = Anvil::Buffer::create(std::move(create_info_ptr) );
-    }
+    swapchain_image_ptr->get_image_mipmap_size(0, /* n_mipmap */
+                                              &new_frame.width,
+                                              &new_frame.height,
+                                               nullptr); /* out_opt_depth_ptr */
 
-    /* 2. Create the intermediate image */
-    Anvil::ImageBlit intermediate_image_blit;
-    ImageUniquePtr   intermediate_image_ptr;
+    anvil_assert(swapchain_image_ptr->get_subresource_range().aspect_mask == Anvil::ImageAspectFlagBits::COLOR_BIT);
 
+    /* The intermediate image converts swapchain image contents to R8G8B8A8_UNORM. It is reused for all frames,
+     * as the queue executes the captures in order. */
+    if (m_intermediate_image_ptr == nullptr)
     {
         auto create_info_ptr = Anvil::ImageCreateInfo::create_alloc(device_ptr,
                                                                     Anvil::ImageType::_2D,
                                                                     Anvil::Format::R8G8B8A8_UNORM,
                                                                     Anvil::ImageTiling::OPTIMAL,
                                                                     Anvil::ImageUsageFlagBits::TRANSFER_SRC_BIT | Anvil::ImageUsageFlagBits::TRANSFER_DST_BIT,
-                                                                    swapchain_image_width,
-                                                                    swapchain_image_height,
+                                                                    new_frame.width,
+                                                                    new_frame.height,
                                                                     1,      /* in_base_mipmap_depth */
                                                                     1,      /* in_n_layers          */
                                                                     Anvil::SampleCountFlagBits::_1_BIT,
@@ -228,34 +272,206 @@ std::unique_ptr<uint8_t[]> Anvil::DummyWindowWithPNGSnapshots::get_swapchain_ima
 
         create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
 
-        intermediate_image_ptr = Anvil::Image::create(std::move(create_info_ptr) );
+        m_intermediate_image_ptr  = Anvil::Image::create(std::move(create_info_ptr) );
+        m_intermediate_image_used = false;
+        m_readback_ring_ptr       = Anvil::ReadbackRing::create(device_ptr,
+                                                                static_cast<VkDeviceSize>(4 /* RGBA8 */) * new_frame.width * new_frame.height * N_MAX_PENDING_FRAMES);
+
+        if (m_intermediate_image_ptr == nullptr ||
+            m_readback_ring_ptr      == nullptr)
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    /* If the ring is full, wait for the oldest frame to be stored and retry. */
+    while (true)
+    {
+        command_buffer_ptr = device_ptr->get_command_pool_for_queue_family_index(universal_queue_ptr->get_queue_family_index() )->alloc_primary_level_command_buffer();
+
+        command_buffer_ptr->start_recording(true,   /* one_time_submit          */
+                                            false); /* simultaneous_use_allowed */
+
+        if (record_capture_commands(command_buffer_ptr.get(),
+                                    swapchain_image_ptr,
+                                    new_frame.width,
+                                    new_frame.height,
+                                   &new_frame.readback_id) )
+        {
+            break;
+        }
+
+        command_buffer_ptr.reset();
+
+        if (m_pending_frames.empty() )
+        {
+            anvil_assert(!m_pending_frames.empty() );
+
+            goto end;
+        }
+
+        store_pending_frames(1); /* in_n_frames_to_wait_for */
+    }
+
+    command_buffer_ptr->stop_recording();
+
+    /* Submit without blocking. The frame is stored by a later store_pending_frames() call. */
+    {
+        auto create_info_ptr = Anvil::FenceCreateInfo::create(device_ptr,
+                                                              false); /* in_create_signalled */
+
+        create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+
+        new_frame.fence_ptr = Anvil::Fence::create(std::move(create_info_ptr) );
     }
 
-    /* 3. Set up the command buffer */
-    auto                command_buffer_ptr           = Anvil::PrimaryCommandBufferUniquePtr();
-    Anvil::CommandPool* universal_command_pool_ptr   = nullptr;
-    Anvil::Queue*       universal_queue_ptr          = device_ptr->get_universal_queue            (0);
-    const uint32_t      universal_queue_family_index = universal_queue_ptr->get_queue_family_index();
+    universal_queue_ptr->submit(Anvil::SubmitInfo::create_execute(command_buffer_ptr.get(),
+                                                                  false, /* should_block */
+                                                                  new_frame.fence_ptr.get() )
+    );
+
+    m_readback_ring_ptr->end_frame(new_frame.fence_ptr.get() );
+
+    m_intermediate_image_used = true;
+    new_frame.cmd_buffer_ptr  = std::move(command_buffer_ptr);
+    new_frame.n_frame         = m_n_frames_presented++;
 
-    universal_command_pool_ptr = device_ptr->get_command_pool_for_queue_family_index(universal_queue_ptr->get_queue_family_index() );
-    command_buffer_ptr         = universal_command_pool_ptr->alloc_primary_level_command_buffer();
+    m_pending_frames.push_back(std::move(new_frame) );
 
-    command_buffer_ptr->start_recording(true,   /* one_time_submit          */
-                                        false); /* simultaneous_use_allowed */
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::DummyWindowWithPNGSnapshots::encoder_thread_main()
+{
+    std::unique_lock<std::mutex> lock(m_encoder_mutex);
+
+    while (true)
     {
-        Anvil::BufferImageCopy buffer_image_copy_region;
+        std::function<void()> request;
 
-        Anvil::ImageBarrier general_to_transfer_src_image_barrier(
-            Anvil::AccessFlagBits::COLOR_ATTACHMENT_WRITE_BIT | Anvil::AccessFlagBits::TRANSFER_WRITE_BIT | Anvil::AccessFlagBits::MEMORY_READ_BIT, /* source_access_mask      */
-            Anvil::AccessFlagBits::TRANSFER_READ_BIT,                                                                                               /* destination_access_mask */
-            Anvil::ImageLayout::GENERAL,
-            Anvil::ImageLayout::TRANSFER_SRC_OPTIMAL,
-            universal_queue_family_index,
-            universal_queue_family_index,
-            in_swapchain_image_ptr,
-            swapchain_image_subresource_range
-        );
+        if (m_encode_requests.empty() )
+        {
+            if (m_should_encoder_threads_quit)
+            {
+                break;
+            }
+
+            m_encoder_wake_cv.wait(lock);
+
+            continue;
+        }
+
+        request = std::move(m_encode_requests.front() );
+
+        m_encode_requests.pop_front();
+        m_n_busy_encoder_threads++;
+
+        lock.unlock();
+        {
+            request();
+        }
+        lock.lock();
+
+        m_n_busy_encoder_threads--;
+
+        /* Wake up the render thread, in case it is waiting for space in the queue */
+        m_encoder_idle_cv.notify_all();
+    }
+}
+
+/** Please see header for specification */
+void Anvil::DummyWindowWithPNGSnapshots::enqueue_encode_request(std::function<void()> in_request)
+{
+    std::unique_lock<std::mutex> lock(m_encoder_mutex);
+
+    anvil_assert(!m_encoder_threads.empty() );
+
+    while (m_encode_requests.size() >= m_encoder_threads.size() * 2)
+    {
+        m_encoder_idle_cv.wait(lock);
+    }
+
+    m_encode_requests.push_back(std::move(in_request) );
+
+    m_encoder_wake_cv.notify_one();
+}
+
+/** Please see header for specification */
+bool Anvil::DummyWindowWithPNGSnapshots::record_capture_commands(Anvil::PrimaryCommandBuffer*     in_command_buffer_ptr,
+                                                                 Anvil::Image*                    in_swapchain_image_ptr,
+                                                                 uint32_t                         in_width,
+                                                                 uint32_t                         in_height,
+                                                                 Anvil::ReadbackRing::ReadbackID* out_readback_id_ptr)
+{
+    const Anvil::BaseDevice*           device_ptr                       (m_swapchain_ptr->get_create_info_ptr()->get_device() );
+    Anvil::ImageBlit                   intermediate_image_blit;
+    bool                               result                           (false);
+    const Anvil::ImageSubresourceRange swapchain_image_subresource_range(in_swapchain_image_ptr->get_subresource_range() );
+    const uint32_t                     universal_queue_family_index     (device_ptr->get_universal_queue(0)->get_queue_family_index() );
+
+    {
+        Anvil::ImageBarrier pre_blit_barriers[] =
+        {
+            Anvil::ImageBarrier(Anvil::AccessFlagBits::COLOR_ATTACHMENT_WRITE_BIT | Anvil::AccessFlagBits::TRANSFER_WRITE_BIT | Anvil::AccessFlagBits::MEMORY_READ_BIT, /* source_access_mask      */
+                                Anvil::AccessFlagBits::TRANSFER_READ_BIT,                                                                                               /* destination_access_mask */
+                                Anvil::ImageLayout::GENERAL,
+                                Anvil::ImageLayout::TRANSFER_SRC_OPTIMAL,
+                                universal_queue_family_index,
+                                universal_queue_family_index,
+                                in_swapchain_image_ptr,
+                                swapchain_image_subresource_range),
+
+            /* Previous capture may still be reading from the intermediate image */
+            Anvil::ImageBarrier(Anvil::AccessFlagBits::TRANSFER_READ_BIT,  /* source_access_mask      */
+                                Anvil::AccessFlagBits::TRANSFER_WRITE_BIT, /* destination_access_mask */
+                                (m_intermediate_image_used) ? Anvil::ImageLayout::TRANSFER_SRC_OPTIMAL
+                                                            : Anvil::ImageLayout::TRANSFER_DST_OPTIMAL,
+                                Anvil::ImageLayout::TRANSFER_DST_OPTIMAL,
+                                universal_queue_family_index,
+                                universal_queue_family_index,
+                                m_intermediate_image_ptr.get(),
+                                swapchain_image_subresource_range)
+        };
+
+        in_command_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::COLOR_ATTACHMENT_OUTPUT_BIT | Anvil::PipelineStageFlagBits::TRANSFER_BIT, /* src_stage_mask                 */
+                                                       Anvil::PipelineStageFlagBits::TRANSFER_BIT,                                                             /* dst_stage_mask                 */
+                                                       Anvil::DependencyFlagBits::NONE,
+                                                       0,                                                                                                      /* in_memory_barrier_count        */
+                                                       nullptr,                                                                                                /* in_memory_barrier_ptrs         */
+                                                       0,                                                                                                      /* in_buffer_memory_barrier_count */
+                                                       nullptr,                                                                                                /* in_buffer_memory_barrier_ptrs  */
+                                                       sizeof(pre_blit_barriers) / sizeof(pre_blit_barriers[0]),                                               /* in_image_memory_barrier_count  */
+                                                       pre_blit_barriers);
+    }
+
+    intermediate_image_blit.dst_offsets[0].x                 = 0;
+    intermediate_image_blit.dst_offsets[0].y                 = 0;
+    intermediate_image_blit.dst_offsets[0].z                 = 0;
+    intermediate_image_blit.dst_offsets[1].x                 = static_cast<int32_t>(in_width);
+    intermediate_image_blit.dst_offsets[1].y                 = static_cast<int32_t>(in_height);
+    intermediate_image_blit.dst_offsets[1].z                 = 1;
+    intermediate_image_blit.dst_subresource.base_array_layer = 0;
+    intermediate_image_blit.dst_subresource.layer_count      = 1;
+    intermediate_image_blit.dst_subresource.aspect_mask      = Anvil::ImageAspectFlagBits::COLOR_BIT;
+    intermediate_image_blit.dst_subresource.mip_level        = 0;
+    intermediate_image_blit.src_offsets[0]                   = intermediate_image_blit.dst_offsets[0];
+    intermediate_image_blit.src_offsets[1]                   = intermediate_image_blit.dst_offsets[1];
+    intermediate_image_blit.src_subresource                  = intermediate_image_blit.dst_subresource;
+
+    in_command_buffer_ptr->record_blit_image(in_swapchain_image_ptr,
+                                             Anvil::ImageLayout::TRANSFER_SRC_OPTIMAL,
+                                             m_intermediate_image_ptr.get(),
+                                             Anvil::ImageLayout::TRANSFER_DST_OPTIMAL,
+                                             1, /* regionCount */
+                                            &intermediate_image_blit,
+                                             Anvil::Filter::NEAREST);
 
+    {
         Anvil::ImageBarrier transfer_dst_to_transfer_src_image_barrier(
             Anvil::AccessFlagBits::TRANSFER_WRITE_BIT, /* source_access_mask      */
             Anvil::AccessFlagBits::TRANSFER_READ_BIT,  /* desitnation_access_mask */
@@ -263,9 +479,43 @@ std::unique_ptr<uint8_t[]> Anvil::DummyWindowWithPNGSnapshots::get_swapchain_ima
             Anvil::ImageLayout::TRANSFER_SRC_OPTIMAL,
             universal_queue_family_index,
             universal_queue_family_index,
-            intermediate_image_ptr.get(),
+            m_intermediate_image_ptr.get(),
             swapchain_image_subresource_range);
 
+        in_command_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TRANSFER_BIT, /* src_stage_mask                 */
+                                                       Anvil::PipelineStageFlagBits::TRANSFER_BIT, /* dst_stage_mask                 */
+                                                       Anvil::DependencyFlagBits::NONE,
+                                                       0,                                          /* in_memory_barrier_count        */
+                                                       nullptr,                                    /* in_memory_barrier_ptrs         */
+                                                       0,                                          /* in_buffer_memory_barrier_count */
+                                                       nullptr,                                    /* in_buffer_memory_barrier_ptrs  */
+                                                       1,                                          /* in_image_memory_barrier_count  */
+                                                      &transfer_dst_to_transfer_src_image_barrier);
+    }
+
+    {
+        VkExtent3D                    extent;
+        const VkOffset3D              offset      = {0, 0, 0};
+        Anvil::ImageSubresourceLayers subresource = intermediate_image_blit.dst_subresource;
+
+        extent.depth  = 1;
+        extent.height = in_height;
+        extent.width  = in_width;
+
+        if (!m_readback_ring_ptr->record_image_readback(in_command_buffer_ptr,
+                                                        m_intermediate_image_ptr.get(),
+                                                        Anvil::ImageLayout::TRANSFER_SRC_OPTIMAL,
+                                                        subresource,
+                                                        offset,
+                                                        extent,
+                                                        out_readback_id_ptr) )
+        {
+            goto end;
+        }
+    }
+
+    {
+        /* Later frames may render into the swapchain image straight away, so make all subsequent commands wait for the blit. */
         Anvil::ImageBarrier transfer_src_to_general_image_barrier(
             Anvil::AccessFlagBits::TRANSFER_READ_BIT, /* source_access_mask      */
             Anvil::AccessFlags(),                     /* destination_access_mask */
@@ -276,96 +526,20 @@ std::unique_ptr<uint8_t[]> Anvil::DummyWindowWithPNGSnapshots::get_swapchain_ima
             in_swapchain_image_ptr,
             swapchain_image_subresource_range);
 
-        command_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::COLOR_ATTACHMENT_OUTPUT_BIT | Anvil::PipelineStageFlagBits::TRANSFER_BIT, /* src_stage_mask                 */
-                                                    Anvil::PipelineStageFlagBits::TRANSFER_BIT,                                                             /* dst_stage_mask                 */
-                                                    Anvil::DependencyFlagBits::NONE,
-                                                    0,                                                                                                      /* in_memory_barrier_count        */
-                                                    nullptr,                                                                                                /* in_memory_barrier_ptrs         */
-                                                    0,                                                                                                      /* in_buffer_memory_barrier_count */
-                                                    nullptr,                                                                                                /* in_buffer_memory_barrier_ptrs  */
-                                                    1,                                                                                                      /* in_image_memory_barrier_count  */
-                                                   &general_to_transfer_src_image_barrier);
-
-        intermediate_image_blit.dst_offsets[0].x                 = 0;
-        intermediate_image_blit.dst_offsets[0].y                 = 0;
-        intermediate_image_blit.dst_offsets[0].z                 = 0;
-        intermediate_image_blit.dst_offsets[1].x                 = static_cast<int32_t>(swapchain_image_width);
-        intermediate_image_blit.dst_offsets[1].y                 = static_cast<int32_t>(swapchain_image_height);
-        intermediate_image_blit.dst_offsets[1].z                 = 1;
-        intermediate_image_blit.dst_subresource.base_array_layer = 0;
-        intermediate_image_blit.dst_subresource.layer_count      = 1;
-        intermediate_image_blit.dst_subresource.aspect_mask      = Anvil::ImageAspectFlagBits::COLOR_BIT;
-        intermediate_image_blit.dst_subresource.mip_level        = 0;
-        intermediate_image_blit.src_offsets[0]                   = intermediate_image_blit.dst_offsets[0];
-        intermediate_image_blit.src_offsets[1]                   = intermediate_image_blit.dst_offsets[1];
-        intermediate_image_blit.src_subresource                  = intermediate_image_blit.dst_subresource;
-
-        command_buffer_ptr->record_blit_image(in_swapchain_image_ptr,
-                                              Anvil::ImageLayout::TRANSFER_SRC_OPTIMAL,
-                                              intermediate_image_ptr.get(),
-                                              Anvil::ImageLayout::TRANSFER_DST_OPTIMAL,
-                                              1, /* regionCount */
-                                             &intermediate_image_blit,
-                                              Anvil::Filter::NEAREST);
-
-        command_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TRANSFER_BIT, /* src_stage_mask                 */
-                                                    Anvil::PipelineStageFlagBits::TRANSFER_BIT, /* dst_stage_mask                 */
-                                                    Anvil::DependencyFlagBits::NONE,
-                                                    0,                                          /* in_memory_barrier_count        */
-                                                    nullptr,                                    /* in_memory_barrier_ptrs         */
-                                                    0,                                          /* in_buffer_memory_barrier_count */
-                                                    nullptr,                                    /* in_buffer_memory_barrier_ptrs  */
-                                                    1,                                          /* in_image_memory_barrier_count  */
-                                                   &transfer_dst_to_transfer_src_image_barrier);
-
-        buffer_image_copy_region.buffer_image_height                = 0; /* assume tight packing */
-        buffer_image_copy_region.buffer_offset                      = 0;
-        buffer_image_copy_region.buffer_row_length                  = 0; /* assume tight packing */
-        buffer_image_copy_region.image_extent.depth                 = 1;
-        buffer_image_copy_region.image_extent.height                = swapchain_image_height;
-        buffer_image_copy_region.image_extent.width                 = swapchain_image_width;
-        buffer_image_copy_region.image_offset.x                     = 0;
-        buffer_image_copy_region.image_offset.y                     = 0;
-        buffer_image_copy_region.image_offset.z                     = 0;
-        buffer_image_copy_region.image_subresource.aspect_mask      = Anvil::ImageAspectFlagBits::COLOR_BIT;
-        buffer_image_copy_region.image_subresource.base_array_layer = 0;
-        buffer_image_copy_region.image_subresource.layer_count      = 1;
-        buffer_image_copy_region.image_subresource.mip_level        = 0;
-
-        command_buffer_ptr->record_copy_image_to_buffer(intermediate_image_ptr.get(),
-                                                        Anvil::ImageLayout::TRANSFER_SRC_OPTIMAL,
-                                                        raw_image_buffer_ptr.get(),
-                                                        1, /* regionCount */
-                                                       &buffer_image_copy_region);
-
-        command_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TRANSFER_BIT,    /* src_stage_mask */
-                                                    Anvil::PipelineStageFlagBits::TOP_OF_PIPE_BIT, /* dst_stage_mask */
-                                                    Anvil::DependencyFlagBits::NONE,
-                                                    0,                                             /* in_memory_barrier_count        */
-                                                    nullptr,                                       /* in_memory_barrier_ptrs         */
-                                                    0,                                             /* in_buffer_memory_barrier_count */
-                                                    nullptr,                                       /* in_buffer_memory_barrier_ptrs  */
-                                                    1,                                             /* in_image_memory_barrier_count  */
-                                                   &transfer_src_to_general_image_barrier);
+        in_command_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TRANSFER_BIT,     /* src_stage_mask */
+                                                       Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT, /* dst_stage_mask */
+                                                       Anvil::DependencyFlagBits::NONE,
+                                                       0,                                              /* in_memory_barrier_count        */
+                                                       nullptr,                                        /* in_memory_barrier_ptrs         */
+                                                       0,                                              /* in_buffer_memory_barrier_count */
+                                                       nullptr,                                        /* in_buffer_memory_barrier_ptrs  */
+                                                       1,                                              /* in_image_memory_barrier_count  */
+                                                      &transfer_src_to_general_image_barrier);
     }
-    command_buffer_ptr->stop_recording();
-
-    /* Execute the command buffer */
-    {
-        Anvil::CommandBufferBase* cmd_buffer_raw_ptr = command_buffer_ptr.get();
-
-        universal_queue_ptr->submit(Anvil::SubmitInfo::create_execute(&cmd_buffer_raw_ptr,
-                                                                      1,    /* in_n_cmd_buffers */
-                                                                      true) /* should_block     */
-        );
-    }
-
-    /* Read back the result data */
-    raw_image_buffer_ptr->read(0, /* offset */
-                               raw_image_size,
-                               result_ptr.get() );
 
-    return result_ptr;
+    result = true;
+end:
+    return result;
 }
 
 /** Please see header for specification */
@@ -373,6 +547,8 @@ void Anvil::DummyWindowWithPNGSnapshots::run()
 {
     bool running = true;
 
+    start_encoder_threads();
+
     while (running && !m_window_should_close)
     {
         m_present_callback_func();
@@ -382,6 +558,14 @@ void Anvil::DummyWindowWithPNGSnapshots::run()
         running = !m_window_should_close;
     }
 
+    /* Flush frames which are still in flight, and release GPU objects while the device is still around */
+    store_pending_frames(static_cast<uint32_t>(m_pending_frames.size() ) );
+
+    m_readback_ring_ptr.reset     ();
+    m_intermediate_image_ptr.reset();
+
+    stop_encoder_threads();
+
     m_window_close_finished = true;
 }
 
@@ -394,46 +578,123 @@ void Anvil::DummyWindowWithPNGSnapshots::set_swapchain(Anvil::Swapchain* in_swap
 }
 
 /** Please see header for specification */
-void Anvil::DummyWindowWithPNGSnapshots::store_swapchain_frame()
+void Anvil::DummyWindowWithPNGSnapshots::store_pending_frames(uint32_t in_n_frames_to_wait_for)
 {
-    anvil_assert(m_swapchain_ptr != nullptr);
+    while (!m_pending_frames.empty() )
+    {
+        auto&                    oldest_frame = m_pending_frames.front();
+        std::shared_ptr<uint8_t> raw_data_ptr;
+        std::stringstream        snapshot_file_name_sstream;
 
-    /* Retrieve image contents */
-    const uint32_t swapchain_image_index        = m_swapchain_ptr->get_last_acquired_image_index();
-    Anvil::Image*  swapchain_image_ptr          = m_swapchain_ptr->get_image                    (swapchain_image_index);
-    auto           swapchain_image_raw_data_ptr = get_swapchain_image_raw_r8g8b8a8_unorm_data   (swapchain_image_ptr);
-    uint32_t       swapchain_image_size[2];
+        if ( in_n_frames_to_wait_for == 0                                &&
+            !m_readback_ring_ptr->is_ready(oldest_frame.readback_id) )
+        {
+            break;
+        }
 
-    swapchain_image_ptr->get_image_mipmap_size(0, /* n_mipmap */
-                                               swapchain_image_size + 0,
-                                               swapchain_image_size + 1,
-                                               nullptr); /* out_opt_depth_ptr */
+        /* Retrieve image contents */
+        raw_data_ptr.reset(new uint8_t[4 /* RGBA8 */ * oldest_frame.width * oldest_frame.height],
+                           std::default_delete<uint8_t[]>() );
+
+        m_readback_ring_ptr->read(oldest_frame.readback_id,
+                                  raw_data_ptr.get(),
+                                  true); /* in_should_block */
+
+        /* Determine what name should be used for the snapshot file */
+        snapshot_file_name_sstream << m_title
+                                   << "_"
+                                   << oldest_frame.n_frame;
+
+        /* Encode the frame and store it in a file on one of the encoder threads */
+        {
+            const std::string    filename = snapshot_file_name_sstream.str();
+            const SnapshotFormat format   = m_snapshot_format;
+            const uint32_t       height   = oldest_frame.height;
+            const uint32_t       width    = oldest_frame.width;
+
+            enqueue_encode_request(
+                [filename, format, height, raw_data_ptr, width]()
+                {
+                    store_frame(filename,
+                                format,
+                                raw_data_ptr.get(),
+                                width,
+                                height);
+                }
+            );
+        }
+
+        m_pending_frames.pop_front();
+
+        if (in_n_frames_to_wait_for > 0)
+        {
+            --in_n_frames_to_wait_for;
+        }
+    }
+}
+
+/** Please see header for specification */
+void Anvil::DummyWindowWithPNGSnapshots::start_encoder_threads()
+{
+    uint32_t n_threads = 0;
+
+    if (!m_encoder_threads.empty() )
+    {
+        return;
+    }
+
+    n_threads = std::min(std::max(std::thread::hardware_concurrency(), 1u),
+                         N_MAX_ENCODER_THREADS);
+
+    m_should_encoder_threads_quit = false;
+
+    m_encoder_threads.reserve(n_threads);
+
+    for (uint32_t n_thread = 0;
+                  n_thread < n_threads;
+                ++n_thread)
+    {
+        m_encoder_threads.push_back(
+            std::thread(&Anvil::DummyWindowWithPNGSnapshots::encoder_thread_main,
+                        this)
+        );
+    }
+}
 
-    /* Determine what name should be used for the snapshot file */
-    std::stringstream snapshot_file_name_sstream;
+/** Please see header for specification */
+void Anvil::DummyWindowWithPNGSnapshots::stop_encoder_threads()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_encoder_mutex);
+
+        m_should_encoder_threads_quit = true;
 
-    snapshot_file_name_sstream << m_title
-                               << "_"
-                               << m_n_frames_presented++
-                               << ".png";
+        m_encoder_wake_cv.notify_all();
+    }
+
+    for (auto& current_thread : m_encoder_threads)
+    {
+        if (current_thread.joinable() )
+        {
+            current_thread.join();
+        }
+    }
 
-    /* Convert the retrieved data to a PNG blob */
-    void*  result_data_ptr  = nullptr;
-    size_t result_data_size = 0;
+    m_encoder_threads.clear();
+}
 
-    result_data_ptr = tdefl_write_image_to_png_file_in_memory(swapchain_image_raw_data_ptr.get(),
-                                                              static_cast<int32_t>(swapchain_image_size[0]),
-                                                              static_cast<int32_t>(swapchain_image_size[1]),
-                                                              4, /* num_chans */
-                                                             &result_data_size);
+/** Please see header for specification */
+void Anvil::DummyWindowWithPNGSnapshots::store_swapchain_frame()
+{
+    anvil_assert(m_swapchain_ptr != nullptr);
 
-    anvil_assert(result_data_ptr != nullptr);
+    /* Write out frames whose captures have completed, then kick off a capture of the current one. */
+    store_pending_frames(0); /* in_n_frames_to_wait_for */
 
-    /* Store it in a file */
-    Anvil::IO::write_binary_file(snapshot_file_name_sstream.str(),
-                                 result_data_ptr,
-                                 static_cast<uint32_t>(result_data_size) );
+    if (m_pending_frames.size() >= N_MAX_PENDING_FRAMES)
+    {
+        store_pending_frames(1); /* in_n_frames_to_wait_for */
+    }
 
-    /* Clean up */
-    free(result_data_ptr);
-}
\ No newline at end of file
+    capture_swapchain_frame();
+}
@@ -26,7 +26,7 @@
 #include <algorithm>
 #include <unordered_map>
 
-static const struct FormatInfo
+static constexpr struct FormatInfo
 {
     Anvil::Format          format;
     const char*            name;
@@ -232,159 +232,166 @@ struct SubresourceLayoutInfo
     uint8_t                component_bits_unused[4];
 
     /*  Default Constructor  */
-    SubresourceLayoutInfo()
+    constexpr SubresourceLayoutInfo()
+        :compatible_singleplanar_format(Anvil::Format::UNKNOWN),
+         component_layout              (Anvil::ComponentLayout::UNKNOWN),
+         component_bits_used           {0, 0, 0, 0},
+         component_bits_unused         {0, 0, 0, 0}
     {
-        compatible_singleplanar_format = Anvil::Format::UNKNOWN;
-        component_layout               = Anvil::ComponentLayout::UNKNOWN;
-        component_bits_used  [0]       = component_bits_used  [1] = component_bits_used  [2] = component_bits_used  [3] = 0;
-        component_bits_unused[0]       = component_bits_unused[1] = component_bits_unused[2] = component_bits_unused[3] = 0;
+        /* Stub */
     }
 
-    SubresourceLayoutInfo(const Anvil::Format&   in_compatible_singleplanar_format,
-                          Anvil::ComponentLayout in_component_layout,
-                          uint8_t                in_component0_bits,
-                          uint8_t                in_component1_bits,
-                          uint8_t                in_component2_bits,
-                          uint8_t                in_component3_bits)
-    {
-        compatible_singleplanar_format = in_compatible_singleplanar_format;
-        component_layout               = in_component_layout;
-        component_bits_used[0]         = in_component0_bits;
-        component_bits_used[1]         = in_component1_bits;
-        component_bits_used[2]         = in_component2_bits;
-        component_bits_used[3]         = in_component3_bits;
-
-        component_bits_unused[0] = component_bits_unused[1] = component_bits_unused[2] = component_bits_unused[3] = 0;
+    constexpr SubresourceLayoutInfo(Anvil::Format          in_compatible_singleplanar_format,
+                                    Anvil::ComponentLayout in_component_layout,
+                                    uint8_t                in_component0_bits,
+                                    uint8_t                in_component1_bits,
+                                    uint8_t                in_component2_bits,
+                                    uint8_t                in_component3_bits)
+        :compatible_singleplanar_format(in_compatible_singleplanar_format),
+         component_layout              (in_component_layout),
+         component_bits_used           {in_component0_bits, in_component1_bits, in_component2_bits, in_component3_bits},
+         component_bits_unused         {0, 0, 0, 0}
+    {
+        /* Stub */
     }
 
     /* Constructor for packed format */
-    SubresourceLayoutInfo(const Anvil::Format&   in_compatible_singleplanar_format,
-                          Anvil::ComponentLayout in_component_layout,
-                          uint8_t                in_component0_bits_used,
-                          uint8_t                in_component1_bits_used,
-                          uint8_t                in_component2_bits_used,
-                          uint8_t                in_component3_bits_used,
-                          uint8_t                in_n_bits_per_component)
-    {
-        compatible_singleplanar_format = in_compatible_singleplanar_format;
-        component_layout               = in_component_layout;
-        component_bits_used[0]         = in_component0_bits_used;
-        component_bits_used[1]         = in_component1_bits_used;
-        component_bits_used[2]         = in_component2_bits_used;
-        component_bits_used[3]         = in_component3_bits_used;
-
-        component_bits_unused[0] = component_bits_unused[1] = component_bits_unused[2] = component_bits_unused[3] = 0;
-
-        if (in_component0_bits_used != 0)
-        {
-            anvil_assert(in_component0_bits_used <= in_n_bits_per_component);
-
-            component_bits_unused[0] = in_n_bits_per_component - in_component0_bits_used;
-        }
-
-        if (in_component1_bits_used != 0)
-        {
-            anvil_assert(in_component1_bits_used <= in_n_bits_per_component);
-
-            component_bits_unused[1] = in_n_bits_per_component - in_component1_bits_used;
-        }
-
-        if (in_component2_bits_used != 0)
-        {
-            anvil_assert(in_component2_bits_used <= in_n_bits_per_component);
-
-            component_bits_unused[2] = in_n_bits_per_component - in_component2_bits_used;
-        }
-
-        if (in_component3_bits_used != 0)
-        {
-            anvil_assert(in_component3_bits_used <= in_n_bits_per_component);
-
-            component_bits_unused[3] = in_n_bits_per_component - in_component3_bits_used;
-        }
+    constexpr SubresourceLayoutInfo(Anvil::Format          in_compatible_singleplanar_format,
+                                    Anvil::ComponentLayout in_component_layout,
+                                    uint8_t                in_component0_bits_used,
+                                    uint8_t                in_component1_bits_used,
+                                    uint8_t                in_component2_bits_used,
+                                    uint8_t                in_component3_bits_used,
+                                    uint8_t                in_n_bits_per_component)
+        :compatible_singleplanar_format(in_compatible_singleplanar_format),
+         component_layout              (in_component_layout),
+         component_bits_used           {in_component0_bits_used, in_component1_bits_used, in_component2_bits_used, in_component3_bits_used},
+         component_bits_unused         {get_n_unused_bits(in_component0_bits_used, in_n_bits_per_component),
+                                        get_n_unused_bits(in_component1_bits_used, in_n_bits_per_component),
+                                        get_n_unused_bits(in_component2_bits_used, in_n_bits_per_component),
+                                        get_n_unused_bits(in_component3_bits_used, in_n_bits_per_component)}
+    {
+        /* Stub */
     }
 
+    static constexpr uint8_t get_n_unused_bits(uint8_t in_n_bits_used,
+                                               uint8_t in_n_bits_per_component)
+    {
+        return (in_n_bits_used != 0) ? static_cast<uint8_t>(in_n_bits_per_component - in_n_bits_used)
+                                     : 0;
+    }
 };
 
 struct YUVFormatInfo
 {
-    const char*                        name;
-    uint8_t                            num_planes;
-    std::vector<SubresourceLayoutInfo> subresources;
-    Anvil::FormatType                  format_type;
-    bool                               is_multiplanar;
-    bool                               is_packed;
-
-    YUVFormatInfo()
-        :name          (nullptr),
-         num_planes    (0),
-         format_type   (Anvil::FormatType::UNKNOWN),
-         is_multiplanar(false),
-         is_packed     (false)
+    Anvil::Format         format;
+    const char*           name;
+    uint8_t               num_planes;
+    SubresourceLayoutInfo subresources[3];
+    Anvil::FormatType     format_type;
+    bool                  is_multiplanar;
+    bool                  is_packed;
+
+    constexpr YUVFormatInfo(Anvil::Format         in_format,
+                            const char*           in_name,
+                            uint8_t               in_num_planes,
+                            SubresourceLayoutInfo in_subresource0,
+                            SubresourceLayoutInfo in_subresource1,
+                            SubresourceLayoutInfo in_subresource2,
+                            Anvil::FormatType     in_format_type,
+                            bool                  in_multiplanar,
+                            bool                  in_packed)
+        :format        (in_format),
+         name          (in_name),
+         num_planes    (in_num_planes),
+         subresources  {in_subresource0, in_subresource1, in_subresource2},
+         format_type   (in_format_type),
+         is_multiplanar(in_multiplanar),
+         is_packed     (in_packed)
     {
         /* Stub */
     }
-
-    YUVFormatInfo(const char*           in_name,
-                  uint8_t               in_num_planes,
-                  SubresourceLayoutInfo in_subresource0,
-                  SubresourceLayoutInfo in_subresource1,
-                  SubresourceLayoutInfo in_subresource2,
-                  Anvil::FormatType     in_format_type,
-                  bool                  in_multiplanar,
-                  bool                  in_packed)
-        : name          (in_name),
-          num_planes    (in_num_planes),
-          format_type   (in_format_type),
-          is_multiplanar(in_multiplanar),
-          is_packed     (in_packed)
-    {
-        subresources.push_back(in_subresource0);
-        subresources.push_back(in_subresource1);
-        subresources.push_back(in_subresource2);
-    }
 };
 
-/* TODO: Component layouts are wrong for YUV formats? */
-static const std::unordered_map<Anvil::Format, YUVFormatInfo, Anvil::EnumClassHasher<Anvil::Format>> g_yuv_formats =
+/* TODO: Component layouts are wrong for YUV formats?
+ *
+ * NOTE: Entries must be stored in the same order as the YUV formats are defined in Anvil::Format. Entries are indexed with
+ *       get_yuv_format_index().
+ */
+static constexpr YUVFormatInfo g_yuv_formats[] =
 {
     /* format                                                    | name                                                   | num_planes | subresources[0]                                                                                          | subresources[1]                                                                                 | subresources[2]                                                                  | format_type              | is_multiplanar? | is_packed? */
-    {Anvil::Format::G8B8G8R8_422_UNORM,                          {"VK_FORMAT_G8B8G8R8_422_UNORM",                         1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::GBGR,     8,      8,      8,      8},          {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            false} },
-    {Anvil::Format::B8G8R8G8_422_UNORM,                          {"VK_FORMAT_B8G8R8G8_422_UNORM",                         1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::BGRG,     8,      8,      8,      8},          {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            false} },
-    {Anvil::Format::G8_B8_R8_3PLANE_420_UNORM,                   {"VK_FORMAT_G8_B8_R8_3PLANE_420_UNORM",                  3,             {Anvil::Format::R8_UNORM,           Anvil::ComponentLayout::R,        8,      0,      0,      0},          {Anvil::Format::R8_UNORM,                 Anvil::ComponentLayout::R,    8,   0,   0,   0},        {Anvil::Format::R8_UNORM, Anvil::ComponentLayout::R,  8,  0, 0, 0},                Anvil::FormatType::UNORM,  true,             false} },
-    {Anvil::Format::G8_B8R8_2PLANE_420_UNORM,                    {"VK_FORMAT_G8_B8R8_2PLANE_420_UNORM",                   2,             {Anvil::Format::R8_UNORM,           Anvil::ComponentLayout::R,        8,      0,      0,      0},          {Anvil::Format::R8G8_UNORM,               Anvil::ComponentLayout::BR,   8,   8,   0,   0},        {},                                                                                Anvil::FormatType::UNORM,  true,             false} },
-    {Anvil::Format::G8_B8_R8_3PLANE_422_UNORM,                   {"VK_FORMAT_G8_B8_R8_3PLANE_422_UNORM",                  3,             {Anvil::Format::R8_UNORM,           Anvil::ComponentLayout::G,        8,      0,      0,      0},          {Anvil::Format::R8_UNORM,                 Anvil::ComponentLayout::B,    8,   0,   0,   0},        {Anvil::Format::R8_UNORM, Anvil::ComponentLayout::R,  8,  0, 0, 0},                Anvil::FormatType::UNORM,  true,             false} },
-    {Anvil::Format::G8_B8R8_2PLANE_422_UNORM,                    {"VK_FORMAT_G8_B8R8_2PLANE_422_UNORM",                   2,             {Anvil::Format::R8_UNORM,           Anvil::ComponentLayout::G,        8,      0,      0,      0},          {Anvil::Format::R8G8_UNORM,               Anvil::ComponentLayout::BR,   8,   8,   0,   0},        {},                                                                                Anvil::FormatType::UNORM,  true,             false} },
-    {Anvil::Format::G8_B8_R8_3PLANE_444_UNORM,                   {"VK_FORMAT_G8_B8_R8_3PLANE_444_UNORM",                  3,             {Anvil::Format::R8_UNORM,           Anvil::ComponentLayout::G,        8,      0,      0,      0},          {Anvil::Format::R8_UNORM,                 Anvil::ComponentLayout::B,    8,   0,   0,   0},        {Anvil::Format::R8_UNORM, Anvil::ComponentLayout::R,  8,  0, 0, 0},                Anvil::FormatType::UNORM,  true,             false} },
-    {Anvil::Format::R10X6_UNORM_PACK16,                          {"VK_FORMAT_R10X6_UNORM_PACK16",                         1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::RX,       10,     0,      0,      0,    16},   {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            true } },
-    {Anvil::Format::R10X6G10X6_UNORM_2PACK16,                    {"VK_FORMAT_R10X6G10X6_UNORM_2PACK16",                   1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::RXGX,     10,     10,     0,      0,    16},   {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            true } },
-    {Anvil::Format::R10X6G10X6B10X6A10X6_UNORM_4PACK16,          {"VK_FORMAT_R10X6G10X6B10X6A10X6_UNORM_4PACK16",         1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::RXGXBXAX, 10,     10,     10,     10,   16},   {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            true } },
-    {Anvil::Format::G10X6B10X6G10X6R10X6_422_UNORM_4PACK16,      {"VK_FORMAT_G10X6B10X6G10X6R10X6_422_UNORM_4PACK16",     1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::GXBXGXRX, 10,     10,     10,     10,   16},   {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            true } },
-    {Anvil::Format::B10X6G10X6R10X6G10X6_422_UNORM_4PACK16,      {"VK_FORMAT_B10X6G10X6R10X6G10X6_422_UNORM_4PACK16",     1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::BXGXRXGX, 10,     10,     10,     10,   16},   {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            true } },
-    {Anvil::Format::G10X6_B10X6_R10X6_3PLANE_420_UNORM_3PACK16,  {"VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_420_UNORM_3PACK16", 3,             {Anvil::Format::R10X6_UNORM_PACK16, Anvil::ComponentLayout::GX,       10,     0,      0,      0,    16},   {Anvil::Format::R10X6_UNORM_PACK16,       Anvil::ComponentLayout::BX,   10,  0,   0,   0,  16},   {Anvil::Format::R10X6_UNORM_PACK16, Anvil::ComponentLayout::RX, 10, 0, 0, 0, 16},  Anvil::FormatType::UNORM,  true,             true } },
-    {Anvil::Format::G10X6_B10X6R10X6_2PLANE_420_UNORM_3PACK16,   {"VK_FORMAT_G10X6_B10X6R10X6_2PLANE_420_UNORM_3PACK16",  2,             {Anvil::Format::R10X6_UNORM_PACK16, Anvil::ComponentLayout::GX,       10,     0,      0,      0,    16},   {Anvil::Format::R10X6G10X6_UNORM_2PACK16, Anvil::ComponentLayout::BXRX, 10,  10,  0,   0,  16},   {},                                                                                Anvil::FormatType::UNORM,  true,             true } },
-    {Anvil::Format::G10X6_B10X6_R10X6_3PLANE_422_UNORM_3PACK16,  {"VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_422_UNORM_3PACK16", 3,             {Anvil::Format::R10X6_UNORM_PACK16, Anvil::ComponentLayout::GX,       10,     0,      0,      0,    16},   {Anvil::Format::R10X6_UNORM_PACK16,       Anvil::ComponentLayout::BX,   10,  0,   0,   0,  16},   {Anvil::Format::R10X6_UNORM_PACK16, Anvil::ComponentLayout::RX, 10, 0, 0, 0, 16},  Anvil::FormatType::UNORM,  true,             true } },
-    {Anvil::Format::G10X6_B10X6R10X6_2PLANE_422_UNORM_3PACK16,   {"VK_FORMAT_G10X6_B10X6R10X6_2PLANE_422_UNORM_3PACK16",  2,             {Anvil::Format::R10X6_UNORM_PACK16, Anvil::ComponentLayout::GX,       10,     0,      0,      0,    16},   {Anvil::Format::R10X6G10X6_UNORM_2PACK16, Anvil::ComponentLayout::BXRX, 10,  10,  0,   0,  16},   {},                                                                                Anvil::FormatType::UNORM,  true,             true } },
-    {Anvil::Format::G10X6_B10X6_R10X6_3PLANE_444_UNORM_3PACK16,  {"VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_444_UNORM_3PACK16", 3,             {Anvil::Format::R10X6_UNORM_PACK16, Anvil::ComponentLayout::GX,       10,     0,      0,      0,    16},   {Anvil::Format::R10X6_UNORM_PACK16,       Anvil::ComponentLayout::BX,   10,  0,   0,   0,  16},   {Anvil::Format::R10X6_UNORM_PACK16, Anvil::ComponentLayout::RX, 10, 0, 0, 0, 16},  Anvil::FormatType::UNORM,  true,             true } },
-    {Anvil::Format::R12X4_UNORM_PACK16,                          {"VK_FORMAT_R12X4_UNORM_PACK16",                         1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::RX,       12,     0,      0,      0,    16},   {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            true } },
-    {Anvil::Format::R12X4G12X4_UNORM_2PACK16,                    {"VK_FORMAT_R12X4G12X4_UNORM_2PACK16",                   1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::RXGX,     12,     12,     0,      0,    16},   {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            true } },
-    {Anvil::Format::R12X4G12X4B12X4A12X4_UNORM_4PACK16,          {"VK_FORMAT_R12X4G12X4B12X4A12X4_UNORM_4PACK16",         1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::RXGXBXAX, 12,     12,     12,     12,   16},   {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            true } },
-    {Anvil::Format::G12X4B12X4G12X4R12X4_422_UNORM_4PACK16,      {"VK_FORMAT_G12X4B12X4G12X4R12X4_422_UNORM_4PACK16",     1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::GXBXGXRX, 12,     12,     12,     12,   16},   {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            true } },
-    {Anvil::Format::B12X4G12X4R12X4G12X4_422_UNORM_4PACK16,      {"VK_FORMAT_B12X4G12X4R12X4G12X4_422_UNORM_4PACK16",     1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::BXGXRXGX, 12,     12,     12,     12,   16},   {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            true } },
-    {Anvil::Format::G12X4_B12X4_R12X4_3PLANE_420_UNORM_3PACK16,  {"VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_420_UNORM_3PACK16", 3,             {Anvil::Format::R12X4_UNORM_PACK16, Anvil::ComponentLayout::GX,       12,     0,      0,      0,    16},   {Anvil::Format::R12X4_UNORM_PACK16,       Anvil::ComponentLayout::BX,   12,  0,   0,   0,  16},   {Anvil::Format::R12X4_UNORM_PACK16, Anvil::ComponentLayout::RX, 12, 0, 0, 0, 16},  Anvil::FormatType::UNORM,  true,             true } },
-    {Anvil::Format::G12X4_B12X4R12X4_2PLANE_420_UNORM_3PACK16,   {"VK_FORMAT_G12X4_B12X4R12X4_2PLANE_420_UNORM_3PACK16",  2,             {Anvil::Format::R12X4_UNORM_PACK16, Anvil::ComponentLayout::GX,       12,     0,      0,      0,    16},   {Anvil::Format::R12X4G12X4_UNORM_2PACK16, Anvil::ComponentLayout::BXRX, 12,  12,  0,   0,  16},   {},                                                                                Anvil::FormatType::UNORM,  true,             true } },
-    {Anvil::Format::G12X4_B12X4_R12X4_3PLANE_422_UNORM_3PACK16,  {"VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_422_UNORM_3PACK16", 3,             {Anvil::Format::R12X4_UNORM_PACK16, Anvil::ComponentLayout::GX,       12,     0,      0,      0,    16},   {Anvil::Format::R12X4_UNORM_PACK16,       Anvil::ComponentLayout::BX,   12,  0,   0,   0,  16},   {Anvil::Format::R12X4_UNORM_PACK16, Anvil::ComponentLayout::RX, 12, 0, 0, 0, 16},  Anvil::FormatType::UNORM,  true,             true } },
-    {Anvil::Format::G12X4_B12X4R12X4_2PLANE_422_UNORM_3PACK16,   {"VK_FORMAT_G12X4_B12X4R12X4_2PLANE_422_UNORM_3PACK16",  2,             {Anvil::Format::R12X4_UNORM_PACK16, Anvil::ComponentLayout::GX,       12,     0,      0,      0,    16},   {Anvil::Format::R12X4G12X4_UNORM_2PACK16, Anvil::ComponentLayout::BXRX, 12,  12,  0,   0,  16},   {},                                                                                Anvil::FormatType::UNORM,  true,             true } },
-    {Anvil::Format::G12X4_B12X4_R12X4_3PLANE_444_UNORM_3PACK16,  {"VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_444_UNORM_3PACK16", 3,             {Anvil::Format::R12X4_UNORM_PACK16, Anvil::ComponentLayout::GX,       12,     0,      0,      0,    16},   {Anvil::Format::R12X4_UNORM_PACK16,       Anvil::ComponentLayout::BX,   12,  0,   0,   0,  16},   {Anvil::Format::R12X4_UNORM_PACK16, Anvil::ComponentLayout::RX, 12, 0, 0, 0, 16},  Anvil::FormatType::UNORM,  true,             true } },
-    {Anvil::Format::G16B16G16R16_422_UNORM,                      {"VK_FORMAT_G16B16G16R16_422_UNORM",                     1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::GBGR,     16,     16,     16,     16},         {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            false} },
-    {Anvil::Format::B16G16R16G16_422_UNORM,                      {"VK_FORMAT_B16G16R16G16_422_UNORM",                     1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::BGRG,     16,     16,     16,     16},         {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            false} },
-    {Anvil::Format::G16_B16_R16_3PLANE_420_UNORM,                {"VK_FORMAT_G16_B16_R16_3PLANE_420_UNORM",               3,             {Anvil::Format::R16_UNORM,          Anvil::ComponentLayout::G,        16,     0,      0,      0},          {Anvil::Format::R16_UNORM,                Anvil::ComponentLayout::B,    16,  0,   0,   0},        {Anvil::Format::R16_UNORM, Anvil::ComponentLayout::R,  16, 0, 0, 0},               Anvil::FormatType::UNORM,  true,             false} },
-    {Anvil::Format::G16_B16R16_2PLANE_420_UNORM,                 {"VK_FORMAT_G16_B16R16_2PLANE_420_UNORM",                2,             {Anvil::Format::R16_UNORM,          Anvil::ComponentLayout::G,        16,     0,      0,      0},          {Anvil::Format::R16G16_UNORM,             Anvil::ComponentLayout::BR,   16,  16,  0,   0},        {},                                                                                Anvil::FormatType::UNORM,  true,             false} },
-    {Anvil::Format::G16_B16_R16_3PLANE_422_UNORM,                {"VK_FORMAT_G16_B16_R16_3PLANE_422_UNORM",               3,             {Anvil::Format::R16_UNORM,          Anvil::ComponentLayout::G,        16,     0,      0,      0},          {Anvil::Format::R16_UNORM,                Anvil::ComponentLayout::B,    16,  0,   0,   0},        {Anvil::Format::R16_UNORM, Anvil::ComponentLayout::R,  16, 0, 0, 0},               Anvil::FormatType::UNORM,  true,             false} },
-    {Anvil::Format::G16_B16R16_2PLANE_422_UNORM,                 {"VK_FORMAT_G16_B16R16_2PLANE_422_UNORM",                2,             {Anvil::Format::R16_UNORM,          Anvil::ComponentLayout::G,        16,     0,      0,      0},          {Anvil::Format::R16G16_UNORM,             Anvil::ComponentLayout::BR,   16,  16,  0,   0},        {},                                                                                Anvil::FormatType::UNORM,  true,             false} },
-    {Anvil::Format::G16_B16_R16_3PLANE_444_UNORM,                {"VK_FORMAT_G16_B16_R16_3PLANE_444_UNORM",               3,             {Anvil::Format::R16_UNORM,          Anvil::ComponentLayout::G,        16,     0,      0,      0},          {Anvil::Format::R16_UNORM,                Anvil::ComponentLayout::B,    16,  0,   0,   0},        {Anvil::Format::R16_UNORM, Anvil::ComponentLayout::R,  16, 0, 0, 0},               Anvil::FormatType::UNORM,  true,             false} },
+    {Anvil::Format::G8B8G8R8_422_UNORM,                           "VK_FORMAT_G8B8G8R8_422_UNORM",                         1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::GBGR,     8,      8,      8,      8},          {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            false},  
+    {Anvil::Format::B8G8R8G8_422_UNORM,                           "VK_FORMAT_B8G8R8G8_422_UNORM",                         1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::BGRG,     8,      8,      8,      8},          {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            false},  
+    {Anvil::Format::G8_B8_R8_3PLANE_420_UNORM,                    "VK_FORMAT_G8_B8_R8_3PLANE_420_UNORM",                  3,             {Anvil::Format::R8_UNORM,           Anvil::ComponentLayout::R,        8,      0,      0,      0},          {Anvil::Format::R8_UNORM,                 Anvil::ComponentLayout::R,    8,   0,   0,   0},        {Anvil::Format::R8_UNORM, Anvil::ComponentLayout::R,  8,  0, 0, 0},                Anvil::FormatType::UNORM,  true,             false},  
+    {Anvil::Format::G8_B8R8_2PLANE_420_UNORM,                     "VK_FORMAT_G8_B8R8_2PLANE_420_UNORM",                   2,             {Anvil::Format::R8_UNORM,           Anvil::ComponentLayout::R,        8,      0,      0,      0},          {Anvil::Format::R8G8_UNORM,               Anvil::ComponentLayout::BR,   8,   8,   0,   0},        {},                                                                                Anvil::FormatType::UNORM,  true,             false},  
+    {Anvil::Format::G8_B8_R8_3PLANE_422_UNORM,                    "VK_FORMAT_G8_B8_R8_3PLANE_422_UNORM",                  3,             {Anvil::Format::R8_UNORM,           Anvil::ComponentLayout::G,        8,      0,      0,      0},          {Anvil::Format::R8_UNORM,                 Anvil::ComponentLayout::B,    8,   0,   0,   0},        {Anvil::Format::R8_UNORM, Anvil::ComponentLayout::R,  8,  0, 0, 0},                Anvil::FormatType::UNORM,  true,             false},  
+    {Anvil::Format::G8_B8R8_2PLANE_422_UNORM,                     "VK_FORMAT_G8_B8R8_2PLANE_422_UNORM",                   2,             {Anvil::Format::R8_UNORM,           Anvil::ComponentLayout::G,        8,      0,      0,      0},          {Anvil::Format::R8G8_UNORM,               Anvil::ComponentLayout::BR,   8,   8,   0,   0},        {},                                                                                Anvil::FormatType::UNORM,  true,             false},  
+    {Anvil::Format::G8_B8_R8_3PLANE_444_UNORM,                    "VK_FORMAT_G8_B8_R8_3PLANE_444_UNORM",                  3,             {Anvil::Format::R8_UNORM,           Anvil::ComponentLayout::G,        8,      0,      0,      0},          {Anvil::Format::R8_UNORM,                 Anvil::ComponentLayout::B,    8,   0,   0,   0},        {Anvil::Format::R8_UNORM, Anvil::ComponentLayout::R,  8,  0, 0, 0},                Anvil::FormatType::UNORM,  true,             false},  
+    {Anvil::Format::R10X6_UNORM_PACK16,                           "VK_FORMAT_R10X6_UNORM_PACK16",                         1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::RX,       10,     0,      0,      0,    16},   {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            true },  
+    {Anvil::Format::R10X6G10X6_UNORM_2PACK16,                     "VK_FORMAT_R10X6G10X6_UNORM_2PACK16",                   1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::RXGX,     10,     10,     0,      0,    16},   {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            true },  
+    {Anvil::Format::R10X6G10X6B10X6A10X6_UNORM_4PACK16,           "VK_FORMAT_R10X6G10X6B10X6A10X6_UNORM_4PACK16",         1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::RXGXBXAX, 10,     10,     10,     10,   16},   {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            true },  
+    {Anvil::Format::G10X6B10X6G10X6R10X6_422_UNORM_4PACK16,       "VK_FORMAT_G10X6B10X6G10X6R10X6_422_UNORM_4PACK16",     1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::GXBXGXRX, 10,     10,     10,     10,   16},   {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            true },  
+    {Anvil::Format::B10X6G10X6R10X6G10X6_422_UNORM_4PACK16,       "VK_FORMAT_B10X6G10X6R10X6G10X6_422_UNORM_4PACK16",     1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::BXGXRXGX, 10,     10,     10,     10,   16},   {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            true },  
+    {Anvil::Format::G10X6_B10X6_R10X6_3PLANE_420_UNORM_3PACK16,   "VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_420_UNORM_3PACK16", 3,             {Anvil::Format::R10X6_UNORM_PACK16, Anvil::ComponentLayout::GX,       10,     0,      0,      0,    16},   {Anvil::Format::R10X6_UNORM_PACK16,       Anvil::ComponentLayout::BX,   10,  0,   0,   0,  16},   {Anvil::Format::R10X6_UNORM_PACK16, Anvil::ComponentLayout::RX, 10, 0, 0, 0, 16},  Anvil::FormatType::UNORM,  true,             true },  
+    {Anvil::Format::G10X6_B10X6R10X6_2PLANE_420_UNORM_3PACK16,    "VK_FORMAT_G10X6_B10X6R10X6_2PLANE_420_UNORM_3PACK16",  2,             {Anvil::Format::R10X6_UNORM_PACK16, Anvil::ComponentLayout::GX,       10,     0,      0,      0,    16},   {Anvil::Format::R10X6G10X6_UNORM_2PACK16, Anvil::ComponentLayout::BXRX, 10,  10,  0,   0,  16},   {},                                                                                Anvil::FormatType::UNORM,  true,             true },  
+    {Anvil::Format::G10X6_B10X6_R10X6_3PLANE_422_UNORM_3PACK16,   "VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_422_UNORM_3PACK16", 3,             {Anvil::Format::R10X6_UNORM_PACK16, Anvil::ComponentLayout::GX,       10,     0,      0,      0,    16},   {Anvil::Format::R10X6_UNORM_PACK16,       Anvil::ComponentLayout::BX,   10,  0,   0,   0,  16},   {Anvil::Format::R10X6_UNORM_PACK16, Anvil::ComponentLayout::RX, 10, 0, 0, 0, 16},  Anvil::FormatType::UNORM,  true,             true },  
+    {Anvil::Format::G10X6_B10X6R10X6_2PLANE_422_UNORM_3PACK16,    "VK_FORMAT_G10X6_B10X6R10X6_2PLANE_422_UNORM_3PACK16",  2,             {Anvil::Format::R10X6_UNORM_PACK16, Anvil::ComponentLayout::GX,       10,     0,      0,      0,    16},   {Anvil::Format::R10X6G10X6_UNORM_2PACK16, Anvil::ComponentLayout::BXRX, 10,  10,  0,   0,  16},   {},                                                                                Anvil::FormatType::UNORM,  true,             true },  
+    {Anvil::Format::G10X6_B10X6_R10X6_3PLANE_444_UNORM_3PACK16,   "VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_444_UNORM_3PACK16", 3,             {Anvil::Format::R10X6_UNORM_PACK16, Anvil::ComponentLayout::GX,       10,     0,      0,      0,    16},   {Anvil::Format::R10X6_UNORM_PACK16,       Anvil::ComponentLayout::BX,   10,  0,   0,   0,  16},   {Anvil::Format::R10X6_UNORM_PACK16, Anvil::ComponentLayout::RX, 10, 0, 0, 0, 16},  Anvil::FormatType::UNORM,  true,             true },  
+    {Anvil::Format::R12X4_UNORM_PACK16,                           "VK_FORMAT_R12X4_UNORM_PACK16",                         1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::RX,       12,     0,      0,      0,    16},   {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            true },  
+    {Anvil::Format::R12X4G12X4_UNORM_2PACK16,                     "VK_FORMAT_R12X4G12X4_UNORM_2PACK16",                   1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::RXGX,     12,     12,     0,      0,    16},   {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            true },  
+    {Anvil::Format::R12X4G12X4B12X4A12X4_UNORM_4PACK16,           "VK_FORMAT_R12X4G12X4B12X4A12X4_UNORM_4PACK16",         1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::RXGXBXAX, 12,     12,     12,     12,   16},   {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            true },  
+    {Anvil::Format::G12X4B12X4G12X4R12X4_422_UNORM_4PACK16,       "VK_FORMAT_G12X4B12X4G12X4R12X4_422_UNORM_4PACK16",     1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::GXBXGXRX, 12,     12,     12,     12,   16},   {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            true },  
+    {Anvil::Format::B12X4G12X4R12X4G12X4_422_UNORM_4PACK16,       "VK_FORMAT_B12X4G12X4R12X4G12X4_422_UNORM_4PACK16",     1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::BXGXRXGX, 12,     12,     12,     12,   16},   {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            true },  
+    {Anvil::Format::G12X4_B12X4_R12X4_3PLANE_420_UNORM_3PACK16,   "VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_420_UNORM_3PACK16", 3,             {Anvil::Format::R12X4_UNORM_PACK16, Anvil::ComponentLayout::GX,       12,     0,      0,      0,    16},   {Anvil::Format::R12X4_UNORM_PACK16,       Anvil::ComponentLayout::BX,   12,  0,   0,   0,  16},   {Anvil::Format::R12X4_UNORM_PACK16, Anvil::ComponentLayout::RX, 12, 0, 0, 0, 16},  Anvil::FormatType::UNORM,  true,             true },  
+    {Anvil::Format::G12X4_B12X4R12X4_2PLANE_420_UNORM_3PACK16,    "VK_FORMAT_G12X4_B12X4R12X4_2PLANE_420_UNORM_3PACK16",  2,             {Anvil::Format::R12X4_UNORM_PACK16, Anvil::ComponentLayout::GX,       12,     0,      0,      0,    16},   {Anvil::Format::R12X4G12X4_UNORM_2PACK16, Anvil::ComponentLayout::BXRX, 12,  12,  0,   0,  16},   {},                                                                                Anvil::FormatType::UNORM,  true,             true },  
+    {Anvil::Format::G12X4_B12X4_R12X4_3PLANE_422_UNORM_3PACK16,   "VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_422_UNORM_3PACK16", 3,             {Anvil::Format::R12X4_UNORM_PACK16, Anvil::ComponentLayout::GX,       12,     0,      0,      0,    16},   {Anvil::Format::R12X4_UNORM_PACK16,       Anvil::ComponentLayout::BX,   12,  0,   0,   0,  16},   {Anvil::Format::R12X4_UNORM_PACK16, Anvil::ComponentLayout::RX, 12, 0, 0, 0, 16},  Anvil::FormatType::UNORM,  true,             true },  
+    {Anvil::Format::G12X4_B12X4R12X4_2PLANE_422_UNORM_3PACK16,    "VK_FORMAT_G12X4_B12X4R12X4_2PLANE_422_UNORM_3PACK16",  2,             {Anvil::Format::R12X4_UNORM_PACK16, Anvil::ComponentLayout::GX,       12,     0,      0,      0,    16},   {Anvil::Format::R12X4G12X4_UNORM_2PACK16, Anvil::ComponentLayout::BXRX, 12,  12,  0,   0,  16},   {},                                                                                Anvil::FormatType::UNORM,  true,             true },  
+    {Anvil::Format::G12X4_B12X4_R12X4_3PLANE_444_UNORM_3PACK16,   "VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_444_UNORM_3PACK16", 3,             {Anvil::Format::R12X4_UNORM_PACK16, Anvil::ComponentLayout::GX,       12,     0,      0,      0,    16},   {Anvil::Format::R12X4_UNORM_PACK16,       Anvil::ComponentLayout::BX,   12,  0,   0,   0,  16},   {Anvil::Format::R12X4_UNORM_PACK16, Anvil::ComponentLayout::RX, 12, 0, 0, 0, 16},  Anvil::FormatType::UNORM,  true,             true },  
+    {Anvil::Format::G16B16G16R16_422_UNORM,                       "VK_FORMAT_G16B16G16R16_422_UNORM",                     1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::GBGR,     16,     16,     16,     16},         {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            false},  
+    {Anvil::Format::B16G16R16G16_422_UNORM,                       "VK_FORMAT_B16G16R16G16_422_UNORM",                     1,             {Anvil::Format::UNKNOWN,            Anvil::ComponentLayout::BGRG,     16,     16,     16,     16},         {},                                                                                               {},                                                                                Anvil::FormatType::UNORM,  false,            false},  
+    {Anvil::Format::G16_B16_R16_3PLANE_420_UNORM,                 "VK_FORMAT_G16_B16_R16_3PLANE_420_UNORM",               3,             {Anvil::Format::R16_UNORM,          Anvil::ComponentLayout::G,        16,     0,      0,      0},          {Anvil::Format::R16_UNORM,                Anvil::ComponentLayout::B,    16,  0,   0,   0},        {Anvil::Format::R16_UNORM, Anvil::ComponentLayout::R,  16, 0, 0, 0},               Anvil::FormatType::UNORM,  true,             false},  
+    {Anvil::Format::G16_B16R16_2PLANE_420_UNORM,                  "VK_FORMAT_G16_B16R16_2PLANE_420_UNORM",                2,             {Anvil::Format::R16_UNORM,          Anvil::ComponentLayout::G,        16,     0,      0,      0},          {Anvil::Format::R16G16_UNORM,             Anvil::ComponentLayout::BR,   16,  16,  0,   0},        {},                                                                                Anvil::FormatType::UNORM,  true,             false},  
+    {Anvil::Format::G16_B16_R16_3PLANE_422_UNORM,                 "VK_FORMAT_G16_B16_R16_3PLANE_422_UNORM",               3,             {Anvil::Format::R16_UNORM,          Anvil::ComponentLayout::G,        16,     0,      0,      0},          {Anvil::Format::R16_UNORM,                Anvil::ComponentLayout::B,    16,  0,   0,   0},        {Anvil::Format::R16_UNORM, Anvil::ComponentLayout::R,  16, 0, 0, 0},               Anvil::FormatType::UNORM,  true,             false},  
+    {Anvil::Format::G16_B16R16_2PLANE_422_UNORM,                  "VK_FORMAT_G16_B16R16_2PLANE_422_UNORM",                2,             {Anvil::Format::R16_UNORM,          Anvil::ComponentLayout::G,        16,     0,      0,      0},          {Anvil::Format::R16G16_UNORM,             Anvil::ComponentLayout::BR,   16,  16,  0,   0},        {},                                                                                Anvil::FormatType::UNORM,  true,             false},  
+    {Anvil::Format::G16_B16_R16_3PLANE_444_UNORM,                 "VK_FORMAT_G16_B16_R16_3PLANE_444_UNORM",               3,             {Anvil::Format::R16_UNORM,          Anvil::ComponentLayout::G,        16,     0,      0,      0},          {Anvil::Format::R16_UNORM,                Anvil::ComponentLayout::B,    16,  0,   0,   0},        {Anvil::Format::R16_UNORM, Anvil::ComponentLayout::R,  16, 0, 0, 0},               Anvil::FormatType::UNORM,  true,             false},  
 };
 
+static constexpr uint32_t g_n_yuv_formats = static_cast<uint32_t>(Anvil::Format::G16_B16_R16_3PLANE_444_UNORM) - static_cast<uint32_t>(Anvil::Format::G8B8G8R8_422_UNORM) + 1;
+
+/** Maps a YUV format to an index of the g_yuv_formats entry which describes it. */
+static constexpr uint32_t get_yuv_format_index(Anvil::Format in_format)
+{
+    return static_cast<uint32_t>(in_format) - static_cast<uint32_t>(Anvil::Format::G8B8G8R8_422_UNORM);
+}
+
+/** Tells whether g_formats[] entries, starting at @param in_n_format, are indexed by their format's value. */
+static constexpr bool is_format_table_sorted(uint32_t in_n_format = 0)
+{
+    return (in_n_format >= sizeof(g_formats) / sizeof(g_formats[0]) ) ||
+           (static_cast<uint32_t>(g_formats[in_n_format].format) == in_n_format && is_format_table_sorted(in_n_format + 1) );
+}
+
+/** Tells whether g_yuv_formats[] entries, starting at @param in_n_format, are indexed by get_yuv_format_index(). */
+static constexpr bool is_yuv_format_table_sorted(uint32_t in_n_format = 0)
+{
+    return (in_n_format >= g_n_yuv_formats) ||
+           (get_yuv_format_index(g_yuv_formats[in_n_format].format) == in_n_format && is_yuv_format_table_sorted(in_n_format + 1) );
+}
+
+static_assert(sizeof(g_formats)     / sizeof(g_formats[0])     == VK_FORMAT_RANGE_SIZE, "g_formats[] must cover all core formats");
+static_assert(sizeof(g_yuv_formats) / sizeof(g_yuv_formats[0]) == g_n_yuv_formats,      "g_yuv_formats[] must cover all YUV formats");
+static_assert(is_format_table_sorted    (),                                             "g_formats[] must be sorted by format");
+static_assert(is_yuv_format_table_sorted(),                                             "g_yuv_formats[] must be sorted by format");
+
+/** Returns the g_yuv_formats[] entry describing YUV format @param in_format. */
+static inline const YUVFormatInfo& get_yuv_format_info(Anvil::Format in_format)
+{
+    anvil_assert(Anvil::Formats::is_format_yuv_khr(in_format) );
+
+    return g_yuv_formats[get_yuv_format_index(in_format)];
+}
+
 typedef struct
 {
     uint32_t red_component_start_bit_index;
@@ -1771,8 +1778,7 @@ void Anvil::Formats::get_format_bit_layout_yuv(Anvil::Format in_format,
 /** Please see header for specification */
 Anvil::ComponentLayout Anvil::Formats::get_format_component_layout_nonyuv(Anvil::Format in_format)
 {
-    static_assert(sizeof(g_formats) / sizeof(g_formats[0]) == VK_FORMAT_RANGE_SIZE, "");
-    anvil_assert(static_cast<uint32_t>(in_format)          <  VK_FORMAT_RANGE_SIZE);
+    anvil_assert(static_cast<uint32_t>(in_format) < VK_FORMAT_RANGE_SIZE);
     anvil_assert(!Anvil::Formats::is_format_yuv_khr(in_format) );
 
     return g_formats[static_cast<uint32_t>(in_format)].component_layout;
@@ -1782,16 +1788,12 @@ Anvil::ComponentLayout Anvil::Formats::get_format_component_layout_nonyuv(Anvil:
 Anvil::ComponentLayout Anvil::Formats::get_format_component_layout_yuv(Anvil::Format              in_format,
                                                                        Anvil::ImageAspectFlagBits in_aspect)
 {
-    const auto plane_idx           = Anvil::Formats::get_yuv_format_plane_index(in_format,
-                                                                                in_aspect);
-    const auto YUV_FORMAT_KHR_SIZE = static_cast<uint32_t>(Anvil::Format::G16_B16_R16_3PLANE_444_UNORM) - static_cast<uint32_t>(Anvil::Format::G8B8G8R8_422_UNORM) + 1;
-
-    ANVIL_REDUNDANT_VARIABLE_CONST(YUV_FORMAT_KHR_SIZE);
+    const auto plane_idx = Anvil::Formats::get_yuv_format_plane_index(in_format,
+                                                                      in_aspect);
 
-    anvil_assert(g_yuv_formats.size() == YUV_FORMAT_KHR_SIZE);
     anvil_assert(Anvil::Formats::is_format_yuv_khr(in_format) );
 
-    return g_yuv_formats.at(in_format).subresources[plane_idx].component_layout;
+    return get_yuv_format_info(in_format).subresources[plane_idx].component_layout;
 }
 
 /** Please see header for specification */
@@ -1812,7 +1814,7 @@ uint32_t Anvil::Formats::get_format_n_components_yuv(Anvil::Format
 
     anvil_assert(Anvil::Formats::is_format_yuv_khr(in_format) );
 
-    return g_layout_to_n_components[static_cast<uint32_t>(g_yuv_formats.at(in_format).subresources[plane_idx].component_layout)];
+    return g_layout_to_n_components[static_cast<uint32_t>(get_yuv_format_info(in_format).subresources[plane_idx].component_layout)];
 }
 
 /** Please see header for specification */
@@ -1849,7 +1851,7 @@ void Anvil::Formats::get_format_n_component_bits_yuv(Anvil::Format
 
     anvil_assert(Anvil::Formats::is_format_yuv_khr(in_format) );
 
-    format_props_ptr = &g_yuv_formats.at(in_format).subresources.at(plane_idx);
+    format_props_ptr = &get_yuv_format_info(in_format).subresources[plane_idx];
 
     *out_channel0_bits_ptr = format_props_ptr->component_bits_used[0];
     *out_channel1_bits_ptr = format_props_ptr->component_bits_used[1];
@@ -1919,7 +1921,7 @@ void Anvil::Formats::get_format_n_unused_component_bits_yuv(Anvil::Format
 
     anvil_assert(Anvil::Formats::is_format_yuv_khr(in_format) );
 
-    format_props_ptr = &g_yuv_formats.at(in_format).subresources.at(plane_idx);
+    format_props_ptr = &get_yuv_format_info(in_format).subresources[plane_idx];
 
     *out_channel0_unused_bits_ptr = format_props_ptr->component_bits_unused[0];
     *out_channel1_unused_bits_ptr = format_props_ptr->component_bits_unused[1];
@@ -1934,7 +1936,7 @@ const char* Anvil::Formats::get_format_name(Anvil::Format in_format)
 
     if (Anvil::Formats::is_format_yuv_khr(in_format) )
     {
-        return g_yuv_formats.at(in_format).name;
+        return get_yuv_format_info(in_format).name;
     }
     else
     {
@@ -1949,7 +1951,7 @@ Anvil::FormatType Anvil::Formats::get_format_type(Anvil::Format in_format)
 
     if (Anvil::Formats::is_format_yuv_khr(in_format) )
     {
-        return g_yuv_formats.at(in_format).format_type;
+        return get_yuv_format_info(in_format).format_type;
     }
     else
     {
@@ -1962,7 +1964,7 @@ uint32_t Anvil::Formats::get_yuv_format_n_planes(Anvil::Format in_format)
 {
     anvil_assert(Anvil::Formats::is_format_yuv_khr(in_format) );
 
-    return g_yuv_formats.at(in_format).num_planes;
+    return get_yuv_format_info(in_format).num_planes;
 }
 
 /** Please see header for specification */
@@ -2181,10 +2183,10 @@ bool Anvil::Formats::is_format_compressed(Anvil::Format in_format)
 
     if (Anvil::Formats::is_format_yuv_khr(in_format) )
     {
-        return (g_yuv_formats.at(in_format).subresources[0].component_layout == Anvil::ComponentLayout::GBGR)     ||
-               (g_yuv_formats.at(in_format).subresources[0].component_layout == Anvil::ComponentLayout::BGRG)     ||
-               (g_yuv_formats.at(in_format).subresources[0].component_layout == Anvil::ComponentLayout::GXBXGXRX) ||
-               (g_yuv_formats.at(in_format).subresources[0].component_layout == Anvil::ComponentLayout::BXGXRXGX);
+        return (get_yuv_format_info(in_format).subresources[0].component_layout == Anvil::ComponentLayout::GBGR)     ||
+               (get_yuv_format_info(in_format).subresources[0].component_layout == Anvil::ComponentLayout::BGRG)     ||
+               (get_yuv_format_info(in_format).subresources[0].component_layout == Anvil::ComponentLayout::GXBXGXRX) ||
+               (get_yuv_format_info(in_format).subresources[0].component_layout == Anvil::ComponentLayout::BXGXRXGX);
     }
     else
     {
@@ -2202,51 +2204,12 @@ bool Anvil::Formats::is_format_multiplanar(Anvil::Format in_format)
 
     if (Anvil::Formats::is_format_yuv_khr(in_format) )
     {
-        return g_yuv_formats.at(in_format).is_multiplanar;
+        return get_yuv_format_info(in_format).is_multiplanar;
     }
 
     return false;
 }
 
-/** Please see header for specification */
-bool Anvil::Formats::is_format_yuv_khr(Anvil::Format in_format)
-{
-    return (in_format == Anvil::Format::G8B8G8R8_422_UNORM                         ||
-            in_format == Anvil::Format::B8G8R8G8_422_UNORM                         ||
-            in_format == Anvil::Format::G8_B8_R8_3PLANE_420_UNORM                  ||
-            in_format == Anvil::Format::G8_B8R8_2PLANE_420_UNORM                   ||
-            in_format == Anvil::Format::G8_B8_R8_3PLANE_422_UNORM                  ||
-            in_format == Anvil::Format::G8_B8R8_2PLANE_422_UNORM                   ||
-            in_format == Anvil::Format::G8_B8_R8_3PLANE_444_UNORM                  ||
-            in_format == Anvil::Format::R10X6_UNORM_PACK16                         ||
-            in_format == Anvil::Format::R10X6G10X6_UNORM_2PACK16                   ||
-            in_format == Anvil::Format::R10X6G10X6B10X6A10X6_UNORM_4PACK16         ||
-            in_format == Anvil::Format::G10X6B10X6G10X6R10X6_422_UNORM_4PACK16     ||
-            in_format == Anvil::Format::B10X6G10X6R10X6G10X6_422_UNORM_4PACK16     ||
-            in_format == Anvil::Format::G10X6_B10X6_R10X6_3PLANE_420_UNORM_3PACK16 ||
-            in_format == Anvil::Format::G10X6_B10X6R10X6_2PLANE_420_UNORM_3PACK16  ||
-            in_format == Anvil::Format::G10X6_B10X6_R10X6_3PLANE_422_UNORM_3PACK16 ||
-            in_format == Anvil::Format::G10X6_B10X6R10X6_2PLANE_422_UNORM_3PACK16  ||
-            in_format == Anvil::Format::G10X6_B10X6_R10X6_3PLANE_444_UNORM_3PACK16 ||
-            in_format == Anvil::Format::R12X4_UNORM_PACK16                         ||
-            in_format == Anvil::Format::R12X4G12X4_UNORM_2PACK16                   ||
-            in_format == Anvil::Format::R12X4G12X4B12X4A12X4_UNORM_4PACK16         ||
-            in_format == Anvil::Format::G12X4B12X4G12X4R12X4_422_UNORM_4PACK16     ||
-            in_format == Anvil::Format::B12X4G12X4R12X4G12X4_422_UNORM_4PACK16     ||
-            in_format == Anvil::Format::G12X4_B12X4_R12X4_3PLANE_420_UNORM_3PACK16 ||
-            in_format == Anvil::Format::G12X4_B12X4R12X4_2PLANE_420_UNORM_3PACK16  ||
-            in_format == Anvil::Format::G12X4_B12X4_R12X4_3PLANE_422_UNORM_3PACK16 ||
-            in_format == Anvil::Format::G12X4_B12X4R12X4_2PLANE_422_UNORM_3PACK16  ||
-            in_format == Anvil::Format::G12X4_B12X4_R12X4_3PLANE_444_UNORM_3PACK16 ||
-            in_format == Anvil::Format::G16B16G16R16_422_UNORM                     ||
-            in_format == Anvil::Format::B16G16R16G16_422_UNORM                     ||
-            in_format == Anvil::Format::G16_B16_R16_3PLANE_420_UNORM               ||
-            in_format == Anvil::Format::G16_B16R16_2PLANE_420_UNORM                ||
-            in_format == Anvil::Format::G16_B16_R16_3PLANE_422_UNORM               ||
-            in_format == Anvil::Format::G16_B16R16_2PLANE_422_UNORM                ||
-            in_format == Anvil::Format::G16_B16_R16_3PLANE_444_UNORM);
-}
-
 /** Please see header for specification */
 bool Anvil::Formats::is_format_packed(Anvil::Format in_format)
 {
@@ -2254,7 +2217,7 @@ bool Anvil::Formats::is_format_packed(Anvil::Format in_format)
 
     if (Anvil::Formats::is_format_yuv_khr(in_format) )
     {
-        return g_yuv_formats.at(in_format).is_packed;
+        return get_yuv_format_info(in_format).is_packed;
     }
     else
     {
@@ -20,8 +20,35 @@
 // THE SOFTWARE.
 //
 
+#include "misc/debug.h"
 #include "misc/fp16.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define ANVIL_FP16_HAS_SSE2
+
+    /* F16C code is compiled regardless of the flags the library is built with. It is only called if the running
+     * CPU supports it. */
+    #define ANVIL_FP16_HAS_F16C
+
+    #include <immintrin.h>
+
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+
+        #define ANVIL_FP16_TARGET_F16C
+    #else
+        #include <cpuid.h>
+
+        #define ANVIL_FP16_TARGET_F16C __attribute__((target("avx,f16c")))
+    #endif
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+    #define ANVIL_FP16_HAS_NEON
+
+    #include <arm_neon.h>
+#endif
+
 // Conversion tables
 static const struct PrecalcedData
 {
@@ -654,3 +681,464 @@ Anvil::float16_t Anvil::Utils::fp32_to_fp16_approx(Anvil::float32_t in_f)
 
     return o;
 }
+
+#if defined(ANVIL_FP16_HAS_F16C)
+    /** Tells whether the running CPU supports F16C, and whether the OS preserves AVX state across context switches. */
+    static bool is_f16c_supported()
+    {
+        uint32_t regs[4] = {0};
+        bool     result  = false;
+        uint64_t xcr0    = 0;
+
+        #if defined(_MSC_VER)
+        {
+            int msvc_regs[4];
+
+            __cpuid(msvc_regs,
+                    1);
+
+            for (uint32_t n_reg = 0; n_reg < 4; ++n_reg)
+            {
+                regs[n_reg] = static_cast<uint32_t>(msvc_regs[n_reg]);
+            }
+        }
+        #else
+        {
+            if (__get_cpuid(1,
+                           &regs[0],
+                           &regs[1],
+                           &regs[2],
+                           &regs[3]) == 0)
+            {
+                goto end;
+            }
+        }
+        #endif
+
+        /* ECX: bit 27 = OSXSAVE, bit 28 = AVX, bit 29 = F16C */
+        if ((regs[2] & (1u << 27)) == 0 ||
+            (regs[2] & (1u << 28)) == 0 ||
+            (regs[2] & (1u << 29)) == 0)
+        {
+            goto end;
+        }
+
+        #if defined(_MSC_VER)
+        {
+            xcr0 = _xgetbv(0);
+        }
+        #else
+        {
+            uint32_t xcr0_hi = 0;
+            uint32_t xcr0_lo = 0;
+
+            __asm__ __volatile__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0) );
+
+            xcr0 = (static_cast<uint64_t>(xcr0_hi) << 32) | xcr0_lo;
+        }
+        #endif
+
+        /* XMM and YMM state must both be enabled */
+        result = ((xcr0 & 0x6) == 0x6);
+    end:
+        return result;
+    }
+#endif
+
+#if defined(ANVIL_FP16_HAS_SSE2)
+    /* Vectorized FP16->FP32 conversion, based on fp16_to_fp32_fast5(). Converts the 4 values stored in the lower halves of @param in_h. */
+    static __m128 fp16_to_fp32_sse2(__m128i in_h)
+    {
+        const __m128i mask_nosign = _mm_set1_epi32(0x7fff);
+        const __m128  magic       = _mm_castsi128_ps(_mm_set1_epi32( (254 - 15) << 23) );
+        const __m128i was_infnan  = _mm_set1_epi32(0x7bff);
+        const __m128  exp_infnan  = _mm_castsi128_ps(_mm_set1_epi32(255 << 23) );
+
+        const __m128i expmant     = _mm_and_si128 (mask_nosign, in_h);
+        const __m128i justsign    = _mm_xor_si128 (in_h,        expmant);
+        const __m128i shifted     = _mm_slli_epi32(expmant,     13);
+        const __m128  scaled      = _mm_mul_ps    (_mm_castsi128_ps(shifted),
+                                                   magic);
+        const __m128i b_wasinfnan = _mm_cmpgt_epi32(expmant,
+                                                    was_infnan);
+        const __m128i sign        = _mm_slli_epi32 (justsign,
+                                                    16);
+        const __m128  infnanexp   = _mm_and_ps     (_mm_castsi128_ps(b_wasinfnan),
+                                                    exp_infnan);
+        const __m128  sign_inf    = _mm_or_ps      (_mm_castsi128_ps(sign),
+                                                    infnanexp);
+
+        return _mm_or_ps(scaled,
+                         sign_inf);
+    }
+
+    /* Vectorized FP32->FP16 conversion with round-to-nearest-even, based on fp32_to_fp16_fast3_rtne(). Returns 4 results, sign-extended to 32 bits, so that they
+     * can be packed with a saturating 32->16 bit pack. */
+    static __m128i fp32_to_fp16_rtne_sse2(__m128 in_f)
+    {
+        const __m128i c_f16max        = _mm_set1_epi32( (127 + 16) << 23);
+        const __m128i c_infty_as_fp16 = _mm_set1_epi32(0x7c00);
+        const __m128i c_min_normal    = _mm_set1_epi32( (127 - 14) << 23);
+        const __m128i c_nanbit        = _mm_set1_epi32(0x200);
+        const __m128i c_normal_bias   = _mm_set1_epi32(0xfff - ( (127 - 15) << 23) );
+        const __m128i c_subnorm_magic = _mm_set1_epi32( ( (127 - 15) + (23 - 10) + 1) << 23);
+        const __m128  mask_sign       = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u) ) );
+
+        const __m128  justsign    = _mm_and_ps      (mask_sign, in_f);
+        const __m128  absf        = _mm_xor_ps      (in_f,      justsign);
+        const __m128i absf_int    = _mm_castps_si128(absf);
+        const __m128  b_isnan     = _mm_cmpunord_ps (absf,      absf);
+        const __m128i b_isregular = _mm_cmpgt_epi32 (c_f16max,  absf_int);
+        const __m128i nanbit      = _mm_and_si128   (_mm_castps_si128(b_isnan),
+                                                     c_nanbit);
+        const __m128i inf_or_nan  = _mm_or_si128    (nanbit,
+                                                     c_infty_as_fp16);
+        const __m128i b_issub     = _mm_cmpgt_epi32 (c_min_normal,
+                                                     absf_int);
+
+        /* Result is a denormal */
+        const __m128  subnorm1    = _mm_add_ps   (absf,
+                                                  _mm_castsi128_ps(c_subnorm_magic) );
+        const __m128i subnorm2    = _mm_sub_epi32(_mm_castps_si128(subnorm1),
+                                                  c_subnorm_magic);
+
+        /* Result is a normalized number */
+        const __m128i mantoddbit  = _mm_slli_epi32(absf_int,      31 - 13);
+        const __m128i mantodd     = _mm_srai_epi32(mantoddbit,    31);
+        const __m128i round1      = _mm_add_epi32 (absf_int,      c_normal_bias);
+        const __m128i round2      = _mm_sub_epi32 (round1,        mantodd);
+        const __m128i normal      = _mm_srli_epi32(round2,        13);
+
+        const __m128i nonspecial  = _mm_or_si128(_mm_and_si128   (subnorm2, b_issub),
+                                                 _mm_andnot_si128(b_issub,  normal) );
+        const __m128i joined      = _mm_or_si128(_mm_and_si128   (nonspecial,  b_isregular),
+                                                 _mm_andnot_si128(b_isregular, inf_or_nan) );
+        const __m128i sign_shift  = _mm_srai_epi32(_mm_castps_si128(justsign),
+                                                   16);
+
+        return _mm_or_si128(joined,
+                            sign_shift);
+    }
+
+    static void convert_fp16_to_fp32_n_sse2(const Anvil::float16_t* in_src_ptr,
+                                            uint32_t                in_n_values,
+                                            Anvil::float32_t*       out_result_ptr)
+    {
+        const __m128i zero    = _mm_setzero_si128();
+        uint32_t      n_value = 0;
+
+        for (;
+             n_value + 8 <= in_n_values;
+             n_value += 8)
+        {
+            const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in_src_ptr + n_value) );
+
+            _mm_storeu_ps(reinterpret_cast<float*>(out_result_ptr + n_value),
+                          fp16_to_fp32_sse2(_mm_unpacklo_epi16(h, zero) ));
+            _mm_storeu_ps(reinterpret_cast<float*>(out_result_ptr + n_value + 4),
+                          fp16_to_fp32_sse2(_mm_unpackhi_epi16(h, zero) ));
+        }
+
+        for (;
+             n_value < in_n_values;
+           ++n_value)
+        {
+            out_result_ptr[n_value] = Anvil::Utils::fp16_to_fp32_full(in_src_ptr[n_value]);
+        }
+    }
+
+    static void convert_fp32_to_fp16_n_sse2(const Anvil::float32_t* in_src_ptr,
+                                            uint32_t                in_n_values,
+                                            Anvil::float16_t*       out_result_ptr)
+    {
+        uint32_t n_value = 0;
+
+        for (;
+             n_value + 8 <= in_n_values;
+             n_value += 8)
+        {
+            const __m128i lo = fp32_to_fp16_rtne_sse2(_mm_loadu_ps(reinterpret_cast<const float*>(in_src_ptr + n_value) ));
+            const __m128i hi = fp32_to_fp16_rtne_sse2(_mm_loadu_ps(reinterpret_cast<const float*>(in_src_ptr + n_value + 4) ));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out_result_ptr + n_value),
+                             _mm_packs_epi32(lo, hi) );
+        }
+
+        for (;
+             n_value < in_n_values;
+           ++n_value)
+        {
+            out_result_ptr[n_value] = Anvil::Utils::fp32_to_fp16_full_rtne(in_src_ptr[n_value]);
+        }
+    }
+#endif
+
+#if defined(ANVIL_FP16_HAS_F16C)
+    ANVIL_FP16_TARGET_F16C static void convert_fp16_to_fp32_n_f16c(const Anvil::float16_t* in_src_ptr,
+                                                                   uint32_t                in_n_values,
+                                                                   Anvil::float32_t*       out_result_ptr)
+    {
+        uint32_t n_value = 0;
+
+        for (;
+             n_value + 8 <= in_n_values;
+             n_value += 8)
+        {
+            const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in_src_ptr + n_value) );
+
+            _mm256_storeu_ps(reinterpret_cast<float*>(out_result_ptr + n_value),
+                             _mm256_cvtph_ps(h) );
+        }
+
+        for (;
+             n_value < in_n_values;
+           ++n_value)
+        {
+            out_result_ptr[n_value] = Anvil::Utils::fp16_to_fp32_full(in_src_ptr[n_value]);
+        }
+    }
+
+    ANVIL_FP16_TARGET_F16C static void convert_fp32_to_fp16_n_f16c(const Anvil::float32_t* in_src_ptr,
+                                                                   uint32_t                in_n_values,
+                                                                   Anvil::float16_t*       out_result_ptr)
+    {
+        uint32_t n_value = 0;
+
+        for (;
+             n_value + 8 <= in_n_values;
+             n_value += 8)
+        {
+            const __m256 f = _mm256_loadu_ps(reinterpret_cast<const float*>(in_src_ptr + n_value) );
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out_result_ptr + n_value),
+                             _mm256_cvtps_ph(f,
+                                             _MM_FROUND_TO_NEAREST_INT) );
+        }
+
+        for (;
+             n_value < in_n_values;
+           ++n_value)
+        {
+            out_result_ptr[n_value] = Anvil::Utils::fp32_to_fp16_full_rtne(in_src_ptr[n_value]);
+        }
+    }
+#endif
+
+#if defined(ANVIL_FP16_HAS_NEON)
+    static void convert_fp16_to_fp32_n_neon(const Anvil::float16_t* in_src_ptr,
+                                            uint32_t                in_n_values,
+                                            Anvil::float32_t*       out_result_ptr)
+    {
+        uint32_t n_value = 0;
+
+        for (;
+             n_value + 4 <= in_n_values;
+             n_value += 4)
+        {
+            const uint16x4_t h = vld1_u16(reinterpret_cast<const uint16_t*>(in_src_ptr + n_value) );
+
+            vst1q_f32(reinterpret_cast<float*>(out_result_ptr + n_value),
+                      vcvt_f32_f16(vreinterpret_f16_u16(h) ));
+        }
+
+        for (;
+             n_value < in_n_values;
+           ++n_value)
+        {
+            out_result_ptr[n_value] = Anvil::Utils::fp16_to_fp32_full(in_src_ptr[n_value]);
+        }
+    }
+
+    static void convert_fp32_to_fp16_n_neon(const Anvil::float32_t* in_src_ptr,
+                                            uint32_t                in_n_values,
+                                            Anvil::float16_t*       out_result_ptr)
+    {
+        uint32_t n_value = 0;
+
+        for (;
+             n_value + 4 <= in_n_values;
+             n_value += 4)
+        {
+            const float32x4_t f = vld1q_f32(reinterpret_cast<const float*>(in_src_ptr + n_value) );
+
+            vst1_u16(reinterpret_cast<uint16_t*>(out_result_ptr + n_value),
+                     vreinterpret_u16_f16(vcvt_f16_f32(f) ));
+        }
+
+        for (;
+             n_value < in_n_values;
+           ++n_value)
+        {
+            out_result_ptr[n_value] = Anvil::Utils::fp32_to_fp16_full_rtne(in_src_ptr[n_value]);
+        }
+    }
+#endif
+
+/* Please see header for specification */
+void Anvil::Utils::convert_fp16_to_fp32_n(const Anvil::float16_t* in_src_ptr,
+                                          uint32_t                in_n_values,
+                                          Anvil::float32_t*       out_result_ptr)
+{
+    convert_fp16_to_fp32_n(in_src_ptr,
+                           in_n_values,
+                           get_preferred_fp16_conversion_implementation(),
+                           out_result_ptr);
+}
+
+/* Please see header for specification */
+void Anvil::Utils::convert_fp16_to_fp32_n(const Anvil::float16_t*                    in_src_ptr,
+                                          uint32_t                                   in_n_values,
+                                          const Anvil::FP16ConversionImplementation& in_implementation,
+                                          Anvil::float32_t*                          out_result_ptr)
+{
+    anvil_assert(is_fp16_conversion_implementation_supported(in_implementation) );
+    anvil_assert(in_n_values == 0 || (in_src_ptr != nullptr && out_result_ptr != nullptr) );
+
+    switch (in_implementation)
+    {
+        #if defined(ANVIL_FP16_HAS_SSE2)
+            case Anvil::FP16ConversionImplementation::SSE2: convert_fp16_to_fp32_n_sse2(in_src_ptr, in_n_values, out_result_ptr); break;
+        #endif
+
+        #if defined(ANVIL_FP16_HAS_F16C)
+            case Anvil::FP16ConversionImplementation::F16C: convert_fp16_to_fp32_n_f16c(in_src_ptr, in_n_values, out_result_ptr); break;
+        #endif
+
+        #if defined(ANVIL_FP16_HAS_NEON)
+            case Anvil::FP16ConversionImplementation::NEON: convert_fp16_to_fp32_n_neon(in_src_ptr, in_n_values, out_result_ptr); break;
+        #endif
+
+        default:
+        {
+            for (uint32_t n_value = 0;
+                          n_value < in_n_values;
+                        ++n_value)
+            {
+                out_result_ptr[n_value] = fp16_to_fp32_full(in_src_ptr[n_value]);
+            }
+        }
+    }
+}
+
+/* Please see header for specification */
+void Anvil::Utils::convert_fp32_to_fp16_n(const Anvil::float32_t* in_src_ptr,
+                                          uint32_t                in_n_values,
+                                          Anvil::float16_t*       out_result_ptr)
+{
+    convert_fp32_to_fp16_n(in_src_ptr,
+                           in_n_values,
+                           get_preferred_fp16_conversion_implementation(),
+                           out_result_ptr);
+}
+
+/* Please see header for specification */
+void Anvil::Utils::convert_fp32_to_fp16_n(const Anvil::float32_t*                    in_src_ptr,
+                                          uint32_t                                   in_n_values,
+                                          const Anvil::FP16ConversionImplementation& in_implementation,
+                                          Anvil::float16_t*                          out_result_ptr)
+{
+    anvil_assert(is_fp16_conversion_implementation_supported(in_implementation) );
+    anvil_assert(in_n_values == 0 || (in_src_ptr != nullptr && out_result_ptr != nullptr) );
+
+    switch (in_implementation)
+    {
+        #if defined(ANVIL_FP16_HAS_SSE2)
+            case Anvil::FP16ConversionImplementation::SSE2: convert_fp32_to_fp16_n_sse2(in_src_ptr, in_n_values, out_result_ptr); break;
+        #endif
+
+        #if defined(ANVIL_FP16_HAS_F16C)
+            case Anvil::FP16ConversionImplementation::F16C: convert_fp32_to_fp16_n_f16c(in_src_ptr, in_n_values, out_result_ptr); break;
+        #endif
+
+        #if defined(ANVIL_FP16_HAS_NEON)
+            case Anvil::FP16ConversionImplementation::NEON: convert_fp32_to_fp16_n_neon(in_src_ptr, in_n_values, out_result_ptr); break;
+        #endif
+
+        default:
+        {
+            for (uint32_t n_value = 0;
+                          n_value < in_n_values;
+                        ++n_value)
+            {
+                out_result_ptr[n_value] = fp32_to_fp16_full_rtne(in_src_ptr[n_value]);
+            }
+        }
+    }
+}
+
+/* Please see header for specification */
+Anvil::FP16ConversionImplementation Anvil::Utils::get_preferred_fp16_conversion_implementation()
+{
+    static const Anvil::FP16ConversionImplementation result = []()
+    {
+        static const Anvil::FP16ConversionImplementation candidates[] =
+        {
+            Anvil::FP16ConversionImplementation::F16C,
+            Anvil::FP16ConversionImplementation::NEON,
+            Anvil::FP16ConversionImplementation::SSE2,
+        };
+
+        for (const auto& current_candidate : candidates)
+        {
+            if (is_fp16_conversion_implementation_supported(current_candidate) )
+            {
+                return current_candidate;
+            }
+        }
+
+        return Anvil::FP16ConversionImplementation::SCALAR;
+    }();
+
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::Utils::is_fp16_conversion_implementation_supported(const Anvil::FP16ConversionImplementation& in_implementation)
+{
+    bool result = false;
+
+    switch (in_implementation)
+    {
+        case Anvil::FP16ConversionImplementation::SCALAR:
+        {
+            result = true;
+
+            break;
+        }
+
+        #if defined(ANVIL_FP16_HAS_SSE2)
+            case Anvil::FP16ConversionImplementation::SSE2:
+            {
+                result = true;
+
+                break;
+            }
+        #endif
+
+        #if defined(ANVIL_FP16_HAS_F16C)
+            case Anvil::FP16ConversionImplementation::F16C:
+            {
+                static const bool is_supported = is_f16c_supported();
+
+                result = is_supported;
+                break;
+            }
+        #endif
+
+        #if defined(ANVIL_FP16_HAS_NEON)
+            case Anvil::FP16ConversionImplementation::NEON:
+            {
+                result = true;
+
+                break;
+            }
+        #endif
+
+        default:
+        {
+            /* Not compiled in */
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,2155 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#include "misc/buffer_create_info.h"
+#include "misc/buffer_create_info.h"
+#include "misc/formats.h"
+#include "misc/frame_graph.h"
+#include "misc/framebuffer_create_info.h"
+#include "misc/image_create_info.h"
+#include "misc/image_view_create_info.h"
+#include "misc/memory_allocator.h"
+#include "misc/render_pass_create_info.h"
+#include "misc/semaphore_create_info.h"
+#include "wrappers/buffer.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/command_pool.h"
+#include "wrappers/device.h"
+#include "wrappers/framebuffer.h"
+#include "wrappers/image.h"
+#include "wrappers/image_view.h"
+#include "wrappers/memory_block.h"
+#include "wrappers/queue.h"
+#include "wrappers/render_pass.h"
+#include "wrappers/semaphore.h"
+#include <algorithm>
+
+
+/** Please see header for specification */
+Anvil::FrameGraph::FrameGraph(const Anvil::BaseDevice* in_device_ptr)
+    :m_device_ptr              (in_device_ptr),
+     m_is_compiled             (false),
+     m_n_executions            (0),
+     m_uses_timeline_semaphores(false)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::FrameGraph::~FrameGraph()
+{
+    /* Release command buffers before the pools they have been allocated from, image views before the images
+     * they refer to, and transient resources before the allocator which owns their memory */
+    m_batches.clear      ();
+    m_render_passes.clear();
+    m_resources.clear    ();
+
+    m_memory_allocator_ptr.reset();
+}
+
+/** Registers an access of a resource by a pass. If the pass has already declared an access of the same
+ *  resource, the two are merged.
+ *
+ *  @param in_pass_id ID of the pass.
+ *  @param in_access  Access to register.
+ **/
+void Anvil::FrameGraph::add_access(PassID        in_pass_id,
+                                   const Access& in_access)
+{
+    Pass* pass_ptr = nullptr;
+
+    anvil_assert(!m_is_compiled);
+    anvil_assert(in_pass_id            < static_cast<uint32_t>(m_passes.size   () ));
+    anvil_assert(in_access.resource_id < static_cast<uint32_t>(m_resources.size() ));
+    anvil_assert(in_access.stages      != Anvil::PipelineStageFlagBits::NONE);
+
+    pass_ptr = &m_passes.at(in_pass_id);
+
+    for (auto& current_access : pass_ptr->accesses)
+    {
+        if (current_access.resource_id == in_access.resource_id)
+        {
+            /* A pass can only use a single layout for an image */
+            anvil_assert(current_access.layout == in_access.layout);
+
+            current_access.access   |= in_access.access;
+            current_access.is_write |= in_access.is_write;
+            current_access.stages   |= in_access.stages;
+
+            return;
+        }
+    }
+
+    pass_ptr->accesses.push_back(in_access);
+}
+
+/** Registers an attachment of a raster pass, along with the access the attachment performs.
+ *
+ *  @param in_pass_id    ID of the pass.
+ *  @param in_attachment Attachment to register. The pass must not have declared another attachment using
+ *                       the same resource.
+ *  @param in_stages     Pipeline stages the attachment is accessed at.
+ *  @param in_access     Types of accesses performed on the attachment.
+ *  @param in_is_write   true if the pass writes the attachment.
+ **/
+void Anvil::FrameGraph::add_attachment(PassID                    in_pass_id,
+                                       const Attachment&         in_attachment,
+                                       Anvil::PipelineStageFlags in_stages,
+                                       Anvil::AccessFlags        in_access,
+                                       bool                      in_is_write)
+{
+    anvil_assert(in_attachment.resource_id                         < static_cast<uint32_t>(m_resources.size() ));
+    anvil_assert(get_image_create_info(in_attachment.resource_id) != nullptr);
+
+    add_access(in_pass_id,
+               Access(in_attachment.resource_id,
+                      in_stages,
+                      in_access,
+                      in_attachment.layout,
+                      in_is_write) );
+
+    anvil_assert(get_attachment(in_pass_id,
+                                in_attachment.resource_id) == nullptr);
+
+    m_passes.at(in_pass_id).attachments.push_back(in_attachment);
+}
+
+/** Makes a batch wait on the batches which accessed a resource earlier in the frame.
+ *
+ *  @param in_n_batch         Index of the batch to add dependencies to.
+ *  @param in_state           State of the resource, prior to the batch's access.
+ *  @param in_include_readers True if the batch modifies the resource (writes it, or changes its layout or owning
+ *                            queue family), in which case it also needs to wait on batches which read the resource
+ *                            since the last write. Otherwise, the batch only waits on the last write.
+ **/
+void Anvil::FrameGraph::add_batch_dependencies(uint32_t             in_n_batch,
+                                               const ResourceState& in_state,
+                                               bool                 in_include_readers)
+{
+    auto&                 dependencies = m_batches.at(in_n_batch).dependencies;
+    std::vector<uint32_t> new_dependencies;
+
+    new_dependencies.push_back(in_state.n_write_batch);
+
+    if (in_include_readers)
+    {
+        new_dependencies.push_back(in_state.n_batch);
+        new_dependencies.insert   (new_dependencies.end(),
+                                   in_state.read_batches.begin(),
+                                   in_state.read_batches.end  () );
+    }
+
+    for (const auto& current_dependency : new_dependencies)
+    {
+        if (current_dependency == UINT32_MAX ||
+            current_dependency == in_n_batch)
+        {
+            continue;
+        }
+
+        anvil_assert(current_dependency < in_n_batch);
+
+        if (std::find(dependencies.begin(),
+                      dependencies.end  (),
+                      current_dependency) == dependencies.end() )
+        {
+            dependencies.push_back(current_dependency);
+        }
+    }
+}
+
+/** Appends a barrier to a barrier set.
+ *
+ *  @param in_barrier_set_ptr Barrier set to append the barrier to. Must not be null.
+ *  @param in_resource_id     ID of the resource the barrier refers to.
+ *
+ *  Other arguments are as per VkBufferMemoryBarrier, VkImageMemoryBarrier and vkCmdPipelineBarrier(). Empty
+ *  stage masks are replaced with TOP_OF_PIPE (source) and BOTTOM_OF_PIPE (destination). Layouts are ignored for
+ *  buffers.
+ **/
+void Anvil::FrameGraph::add_barrier(BarrierSet*               in_barrier_set_ptr,
+                                    ResourceID                in_resource_id,
+                                    Anvil::PipelineStageFlags in_src_stages,
+                                    Anvil::AccessFlags        in_src_access,
+                                    Anvil::PipelineStageFlags in_dst_stages,
+                                    Anvil::AccessFlags        in_dst_access,
+                                    Anvil::ImageLayout        in_old_layout,
+                                    Anvil::ImageLayout        in_new_layout,
+                                    uint32_t                  in_src_queue_family_index,
+                                    uint32_t                  in_dst_queue_family_index)
+{
+    const auto& resource = m_resources.at(in_resource_id);
+
+    if (resource.image_ptr != nullptr)
+    {
+        in_barrier_set_ptr->image_barriers.push_back(
+            Anvil::ImageBarrier(in_src_access,
+                                in_dst_access,
+                                in_old_layout,
+                                in_new_layout,
+                                in_src_queue_family_index,
+                                in_dst_queue_family_index,
+                                resource.image_ptr,
+                                resource.image_ptr->get_subresource_range() )
+        );
+    }
+    else
+    {
+        anvil_assert(resource.buffer_ptr != nullptr);
+
+        in_barrier_set_ptr->buffer_barriers.push_back(
+            Anvil::BufferBarrier(in_src_access,
+                                 in_dst_access,
+                                 in_src_queue_family_index,
+                                 in_dst_queue_family_index,
+                                 resource.buffer_ptr,
+                                 0, /* in_offset */
+                                 VK_WHOLE_SIZE)
+        );
+    }
+
+    in_barrier_set_ptr->dst_stages |= (in_dst_stages != Anvil::PipelineStageFlagBits::NONE) ? in_dst_stages
+                                                                                            : Anvil::PipelineStageFlagBits::BOTTOM_OF_PIPE_BIT;
+    in_barrier_set_ptr->src_stages |= (in_src_stages != Anvil::PipelineStageFlagBits::NONE) ? in_src_stages
+                                                                                            : Anvil::PipelineStageFlagBits::TOP_OF_PIPE_BIT;
+}
+
+/** Please see header for specification */
+void Anvil::FrameGraph::add_buffer_read(PassID                    in_pass_id,
+                                        ResourceID                in_resource_id,
+                                        Anvil::PipelineStageFlags in_stages,
+                                        Anvil::AccessFlags        in_access)
+{
+    anvil_assert(in_resource_id                                        <  static_cast<uint32_t>(m_resources.size() ));
+    anvil_assert(m_resources.at(in_resource_id).image_ptr              == nullptr &&
+                 m_resources.at(in_resource_id).image_create_info_ptr  == nullptr);
+
+    add_access(in_pass_id,
+               Access(in_resource_id,
+                      in_stages,
+                      in_access,
+                      Anvil::ImageLayout::UNDEFINED,
+                      false) ); /* in_is_write */
+}
+
+/** Please see header for specification */
+void Anvil::FrameGraph::add_buffer_write(PassID                    in_pass_id,
+                                         ResourceID                in_resource_id,
+                                         Anvil::PipelineStageFlags in_stages,
+                                         Anvil::AccessFlags        in_access)
+{
+    anvil_assert(in_resource_id                                        <  static_cast<uint32_t>(m_resources.size() ));
+    anvil_assert(m_resources.at(in_resource_id).image_ptr              == nullptr &&
+                 m_resources.at(in_resource_id).image_create_info_ptr  == nullptr);
+
+    add_access(in_pass_id,
+               Access(in_resource_id,
+                      in_stages,
+                      in_access,
+                      Anvil::ImageLayout::UNDEFINED,
+                      true) ); /* in_is_write */
+}
+
+/** Please see header for specification */
+void Anvil::FrameGraph::add_color_attachment(PassID                  in_pass_id,
+                                             ResourceID              in_resource_id,
+                                             uint32_t                in_location,
+                                             Anvil::AttachmentLoadOp in_load_op,
+                                             const VkClearValue*     in_opt_clear_value_ptr)
+{
+    Anvil::AccessFlags access = Anvil::AccessFlagBits::COLOR_ATTACHMENT_WRITE_BIT;
+    Attachment         attachment;
+
+    anvil_assert(in_load_op             != Anvil::AttachmentLoadOp::CLEAR ||
+                 in_opt_clear_value_ptr != nullptr);
+
+    if (in_load_op == Anvil::AttachmentLoadOp::LOAD)
+    {
+        access |= Anvil::AccessFlagBits::COLOR_ATTACHMENT_READ_BIT;
+    }
+
+    attachment.clear_value = (in_opt_clear_value_ptr != nullptr) ? *in_opt_clear_value_ptr : VkClearValue();
+    attachment.index       = in_location;
+    attachment.layout      = Anvil::ImageLayout::COLOR_ATTACHMENT_OPTIMAL;
+    attachment.load_op     = in_load_op;
+    attachment.resource_id = in_resource_id;
+    attachment.type        = Anvil::AttachmentType::COLOR;
+
+    add_attachment(in_pass_id,
+                   attachment,
+                   Anvil::PipelineStageFlagBits::COLOR_ATTACHMENT_OUTPUT_BIT,
+                   access,
+                   true); /* in_is_write */
+}
+
+/** Please see header for specification */
+void Anvil::FrameGraph::add_depth_stencil_attachment(PassID                  in_pass_id,
+                                                     ResourceID              in_resource_id,
+                                                     Anvil::AttachmentLoadOp in_load_op,
+                                                     const VkClearValue*     in_opt_clear_value_ptr)
+{
+    Attachment attachment;
+
+    anvil_assert(in_load_op             != Anvil::AttachmentLoadOp::CLEAR ||
+                 in_opt_clear_value_ptr != nullptr);
+
+    attachment.clear_value = (in_opt_clear_value_ptr != nullptr) ? *in_opt_clear_value_ptr : VkClearValue();
+    attachment.index       = 0;
+    attachment.layout      = Anvil::ImageLayout::DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    attachment.load_op     = in_load_op;
+    attachment.resource_id = in_resource_id;
+    attachment.type        = Anvil::AttachmentType::DEPTH_STENCIL;
+
+    add_attachment(in_pass_id,
+                   attachment,
+                   Anvil::PipelineStageFlagBits::EARLY_FRAGMENT_TESTS_BIT | Anvil::PipelineStageFlagBits::LATE_FRAGMENT_TESTS_BIT,
+                   Anvil::AccessFlagBits::DEPTH_STENCIL_ATTACHMENT_READ_BIT | Anvil::AccessFlagBits::DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                   true); /* in_is_write */
+}
+
+/** Please see header for specification */
+void Anvil::FrameGraph::add_image_read(PassID                    in_pass_id,
+                                       ResourceID                in_resource_id,
+                                       Anvil::PipelineStageFlags in_stages,
+                                       Anvil::AccessFlags        in_access,
+                                       Anvil::ImageLayout        in_layout)
+{
+    anvil_assert(in_resource_id                                        <  static_cast<uint32_t>(m_resources.size() ));
+    anvil_assert(m_resources.at(in_resource_id).image_ptr              != nullptr ||
+                 m_resources.at(in_resource_id).image_create_info_ptr  != nullptr);
+    anvil_assert(in_layout                                             != Anvil::ImageLayout::UNDEFINED);
+
+    add_access(in_pass_id,
+               Access(in_resource_id,
+                      in_stages,
+                      in_access,
+                      in_layout,
+                      false) ); /* in_is_write */
+}
+
+/** Please see header for specification */
+void Anvil::FrameGraph::add_image_write(PassID                    in_pass_id,
+                                        ResourceID                in_resource_id,
+                                        Anvil::PipelineStageFlags in_stages,
+                                        Anvil::AccessFlags        in_access,
+                                        Anvil::ImageLayout        in_layout)
+{
+    anvil_assert(in_resource_id                                        <  static_cast<uint32_t>(m_resources.size() ));
+    anvil_assert(m_resources.at(in_resource_id).image_ptr              != nullptr ||
+                 m_resources.at(in_resource_id).image_create_info_ptr  != nullptr);
+    anvil_assert(in_layout                                             != Anvil::ImageLayout::UNDEFINED);
+
+    add_access(in_pass_id,
+               Access(in_resource_id,
+                      in_stages,
+                      in_access,
+                      in_layout,
+                      true) ); /* in_is_write */
+}
+
+/** Please see header for specification */
+void Anvil::FrameGraph::add_input_attachment(PassID     in_pass_id,
+                                             ResourceID in_resource_id,
+                                             uint32_t   in_attachment_index)
+{
+    const Anvil::ImageCreateInfo* create_info_ptr = get_image_create_info(in_resource_id);
+    Attachment                    attachment;
+
+    anvil_assert(create_info_ptr != nullptr);
+
+    attachment.clear_value = VkClearValue();
+    attachment.index       = in_attachment_index;
+    attachment.layout      = (Anvil::Formats::has_depth_aspect  (create_info_ptr->get_format() ) ||
+                              Anvil::Formats::has_stencil_aspect(create_info_ptr->get_format() )) ? Anvil::ImageLayout::DEPTH_STENCIL_READ_ONLY_OPTIMAL
+                                                                                                  : Anvil::ImageLayout::SHADER_READ_ONLY_OPTIMAL;
+    attachment.load_op     = Anvil::AttachmentLoadOp::LOAD;
+    attachment.resource_id = in_resource_id;
+    attachment.type        = Anvil::AttachmentType::INPUT;
+
+    add_attachment(in_pass_id,
+                   attachment,
+                   Anvil::PipelineStageFlagBits::FRAGMENT_SHADER_BIT,
+                   Anvil::AccessFlagBits::INPUT_ATTACHMENT_READ_BIT,
+                   false); /* in_is_write */
+}
+
+/** Please see header for specification */
+Anvil::FrameGraph::PassID Anvil::FrameGraph::add_pass(const std::string& in_name,
+                                                      uint32_t           in_queue_family_index,
+                                                      PassRecordFunction in_record_function)
+{
+    Pass new_pass;
+
+    anvil_assert(!m_is_compiled);
+    anvil_assert(in_record_function != nullptr);
+
+    new_pass.n_batch            = UINT32_MAX;
+    new_pass.n_render_pass      = UINT32_MAX;
+    new_pass.name               = in_name;
+    new_pass.queue_family_index = in_queue_family_index;
+    new_pass.record_function    = std::move(in_record_function);
+    new_pass.subpass_id         = UINT32_MAX;
+
+    m_passes.push_back(
+        std::move(new_pass)
+    );
+
+    return static_cast<PassID>(m_passes.size() - 1);
+}
+
+/** Please see header for specification */
+Anvil::FrameGraph::PassID Anvil::FrameGraph::add_pass(const std::string&     in_name,
+                                                      Anvil::QueueFamilyType in_queue_family_type,
+                                                      PassRecordFunction     in_record_function)
+{
+    uint32_t               n_queue_family_indices   = 0;
+    const uint32_t*        queue_family_indices_ptr = nullptr;
+    Anvil::QueueFamilyType queue_family_type        = in_queue_family_type;
+
+    /* Fall back to a more capable queue family type if the device does not expose queues of the requested one. */
+    while (true)
+    {
+        if (m_device_ptr->get_queue_family_indices_for_queue_family_type(queue_family_type,
+                                                                        &n_queue_family_indices,
+                                                                        &queue_family_indices_ptr) &&
+            n_queue_family_indices > 0                                                             &&
+            m_device_ptr->get_queue_for_queue_family_index(queue_family_indices_ptr[0],
+                                                           0 /* in_n_queue */) != nullptr)
+        {
+            break;
+        }
+
+        if (queue_family_type == Anvil::QueueFamilyType::TRANSFER)
+        {
+            queue_family_type = Anvil::QueueFamilyType::COMPUTE;
+        }
+        else
+        if (queue_family_type == Anvil::QueueFamilyType::COMPUTE)
+        {
+            queue_family_type = Anvil::QueueFamilyType::UNIVERSAL;
+        }
+        else
+        {
+            anvil_assert_fail();
+
+            n_queue_family_indices = 0;
+            break;
+        }
+    }
+
+    return add_pass(in_name,
+                    (n_queue_family_indices > 0) ? queue_family_indices_ptr[0]
+                                                 : VK_QUEUE_FAMILY_IGNORED,
+                    std::move(in_record_function) );
+}
+
+/** Please see header for specification */
+Anvil::FrameGraph::ResourceID Anvil::FrameGraph::add_transient_buffer(Anvil::BufferCreateInfoUniquePtr in_create_info_ptr)
+{
+    Resource new_resource;
+
+    anvil_assert(!m_is_compiled);
+    anvil_assert(in_create_info_ptr                                                                           != nullptr);
+    anvil_assert(in_create_info_ptr->get_type        ()                                                       == Anvil::BufferType::NO_ALLOC);
+    anvil_assert((in_create_info_ptr->get_create_flags() & Anvil::BufferCreateFlagBits::SPARSE_BINDING_BIT) == 0);
+
+    new_resource.buffer_create_info_ptr = std::move(in_create_info_ptr);
+    new_resource.is_transient           = true;
+
+    m_resources.push_back(
+        std::move(new_resource)
+    );
+
+    return static_cast<ResourceID>(m_resources.size() - 1);
+}
+
+/** Please see header for specification */
+Anvil::FrameGraph::ResourceID Anvil::FrameGraph::add_transient_image(Anvil::ImageCreateInfoUniquePtr in_create_info_ptr)
+{
+    Resource new_resource;
+
+    anvil_assert(!m_is_compiled);
+    anvil_assert(in_create_info_ptr                                                                         != nullptr);
+    anvil_assert(in_create_info_ptr->get_internal_type()                                                    == Anvil::ImageInternalType::NO_ALLOC);
+    anvil_assert((in_create_info_ptr->get_create_flags() & Anvil::ImageCreateFlagBits::SPARSE_BINDING_BIT) == 0);
+
+    new_resource.image_create_info_ptr = std::move(in_create_info_ptr);
+    new_resource.is_transient          = true;
+
+    m_resources.push_back(
+        std::move(new_resource)
+    );
+
+    return static_cast<ResourceID>(m_resources.size() - 1);
+}
+
+/** Tells whether a raster pass can be merged into the render pass formed by the raster passes directly preceding it.
+ *
+ *  @param in_render_pass Render pass to merge the pass into.
+ *  @param in_n_pass      Index of the pass. Must directly follow the render pass' last pass.
+ *
+ *  @return true if the pass reads an attachment written by the render pass as an input attachment, and all
+ *          dependencies between the pass and the render pass' passes can be expressed as subpass dependencies;
+ *          false otherwise.
+ **/
+bool Anvil::FrameGraph::can_merge_pass(const RenderPassInstance& in_render_pass,
+                                       uint32_t                  in_n_pass) const
+{
+    const auto&                   current_pass          = m_passes.at(in_n_pass);
+    const auto&                   first_pass            = m_passes.at(in_render_pass.n_first_pass);
+    const Anvil::ImageCreateInfo* first_create_info_ptr = get_image_create_info(first_pass.attachments.at(0).resource_id);
+    bool                          reads_attachment      = false;
+    bool                          result                = false;
+
+    anvil_assert(in_n_pass == in_render_pass.n_first_pass + in_render_pass.n_passes);
+
+    if (current_pass.queue_family_index != first_pass.queue_family_index)
+    {
+        goto end;
+    }
+
+    /* All attachments of a framebuffer must be of the same size */
+    for (const auto& current_attachment : current_pass.attachments)
+    {
+        const Anvil::ImageCreateInfo* create_info_ptr = get_image_create_info(current_attachment.resource_id);
+
+        if (create_info_ptr->get_base_mip_width () != first_create_info_ptr->get_base_mip_width () ||
+            create_info_ptr->get_base_mip_height() != first_create_info_ptr->get_base_mip_height() ||
+            create_info_ptr->get_n_layers       () != first_create_info_ptr->get_n_layers       () )
+        {
+            goto end;
+        }
+    }
+
+    for (const auto& current_access : current_pass.accesses)
+    {
+        const Attachment* attachment_ptr = get_attachment(in_n_pass,
+                                                          current_access.resource_id);
+
+        for (uint32_t n_pass = in_render_pass.n_first_pass;
+                      n_pass < in_n_pass;
+                    ++n_pass)
+        {
+            const Access*     earlier_access_ptr     = nullptr;
+            const Attachment* earlier_attachment_ptr = get_attachment(n_pass,
+                                                                      current_access.resource_id);
+
+            for (const auto& earlier_access : m_passes.at(n_pass).accesses)
+            {
+                if (earlier_access.resource_id == current_access.resource_id)
+                {
+                    earlier_access_ptr = &earlier_access;
+
+                    break;
+                }
+            }
+
+            if (earlier_access_ptr == nullptr)
+            {
+                continue;
+            }
+
+            if (attachment_ptr         != nullptr &&
+                earlier_attachment_ptr != nullptr)
+            {
+                if (attachment_ptr->type         == Anvil::AttachmentType::INPUT &&
+                    earlier_attachment_ptr->type != Anvil::AttachmentType::INPUT)
+                {
+                    reads_attachment = true;
+                }
+
+                continue;
+            }
+
+            /* Barriers for other accesses of later subpasses are recorded before the render pass begins, so the
+             * accesses must not depend on accesses of earlier subpasses. */
+            if (attachment_ptr                 != nullptr               ||
+                earlier_attachment_ptr         != nullptr               ||
+                current_access.is_write                                 ||
+                earlier_access_ptr->is_write                            ||
+                earlier_access_ptr->layout     != current_access.layout)
+            {
+                goto end;
+            }
+        }
+    }
+
+    result = reads_attachment;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::FrameGraph::compile()
+{
+    bool                       result = false;
+    std::vector<ResourceState> states (m_resources.size() );
+    BarrierSet                 subpass_barriers;
+
+    anvil_assert(!m_is_compiled);
+
+    group_render_passes();
+
+    if (!create_transient_resources() )
+    {
+        goto end;
+    }
+
+    for (uint32_t n_resource = 0;
+                  n_resource < static_cast<uint32_t>(m_resources.size() );
+                ++n_resource)
+    {
+        const auto& current_resource = m_resources.at(n_resource);
+        auto&       current_state    = states.at     (n_resource);
+
+        current_state.layout             = current_resource.initial_layout;
+        current_state.n_batch            = UINT32_MAX;
+        current_state.n_write_batch      = UINT32_MAX;
+        current_state.queue_family_index = current_resource.initial_queue_family_index;
+        current_state.write_access       = current_resource.initial_src_access;
+        current_state.write_stages       = current_resource.initial_src_stages;
+    }
+
+    for (uint32_t n_pass = 0;
+                  n_pass < static_cast<uint32_t>(m_passes.size() );
+                ++n_pass)
+    {
+        auto& current_pass = m_passes.at(n_pass);
+
+        if (m_batches.size()                      == 0                               ||
+            m_batches.back().queue_family_index   != current_pass.queue_family_index)
+        {
+            Batch new_batch;
+
+            new_batch.n_first_pass       = n_pass;
+            new_batch.n_passes           = 0;
+            new_batch.queue_family_index = current_pass.queue_family_index;
+
+            m_batches.push_back(
+                std::move(new_batch)
+            );
+        }
+
+        current_pass.n_batch = static_cast<uint32_t>(m_batches.size() - 1);
+        m_batches.back().n_passes++;
+
+        for (const auto& current_access : current_pass.accesses)
+        {
+            const auto& current_resource        = m_resources.at(current_access.resource_id);
+            auto&       current_state           = states.at     (current_access.resource_id);
+            const bool  is_exclusive            = is_resource_exclusive(current_access.resource_id);
+            const auto  new_layout              = (current_resource.image_ptr != nullptr) ? current_access.layout
+                                                                                          : Anvil::ImageLayout::UNDEFINED;
+            const bool  needs_layout_transition = (current_state.layout != new_layout);
+            const bool  is_cross_batch_transfer = (current_state.n_batch            != UINT32_MAX                      &&
+                                                   current_state.n_batch            != current_pass.n_batch            &&
+                                                   is_exclusive                                                        &&
+                                                   current_state.queue_family_index != current_pass.queue_family_index);
+            const bool  is_modifying_access     = (current_access.is_write || needs_layout_transition || is_cross_batch_transfer);
+            bool        is_dependency_chained   = false;
+            bool        is_visibility_barrier   = false;
+            BarrierSet* barrier_set_ptr         = &current_pass.barriers;
+
+            /* Within a render pass, accesses of an attachment by different subpasses are synchronized with subpass
+             * dependencies. Barriers needed by other accesses of later subpasses are recorded before the render pass
+             * begins. */
+            if (current_pass.n_render_pass                                  != UINT32_MAX &&
+                m_render_passes.at(current_pass.n_render_pass).n_first_pass != n_pass)
+            {
+                const auto& render_pass = m_render_passes.at(current_pass.n_render_pass);
+
+                if (get_attachment      (n_pass,
+                                         current_access.resource_id) != nullptr &&
+                    is_resource_accessed(current_access.resource_id,
+                                         render_pass.n_first_pass,
+                                         n_pass - render_pass.n_first_pass) )
+                {
+                    subpass_barriers = BarrierSet();
+                    barrier_set_ptr  = &subpass_barriers;
+                }
+                else
+                {
+                    barrier_set_ptr = &m_passes.at(render_pass.n_first_pass).barriers;
+                }
+            }
+
+            /* Cross-batch hazards are resolved by making the batch wait on the batches it conflicts with */
+            add_batch_dependencies(current_pass.n_batch,
+                                   current_state,
+                                   is_modifying_access);
+
+            if (current_state.n_batch != UINT32_MAX &&
+                current_state.n_batch != current_pass.n_batch)
+            {
+                /* Earlier accesses have been recorded for an earlier batch. The batches' semaphore makes them
+                 * available and visible, so only an ownership transfer and/or a layout transition may be needed. */
+                if (is_exclusive                                                                &&
+                    current_state.queue_family_index != current_pass.queue_family_index)
+                {
+                    add_barrier(&m_batches.at(current_state.n_batch).release_barriers,
+                                current_access.resource_id,
+                                current_state.write_stages | current_state.read_stages,
+                                current_state.write_access,
+                                Anvil::PipelineStageFlagBits::BOTTOM_OF_PIPE_BIT,
+                                Anvil::AccessFlagBits::NONE,
+                                current_state.layout,
+                                new_layout,
+                                current_state.queue_family_index,
+                                current_pass.queue_family_index);
+                    add_barrier(barrier_set_ptr,
+                                current_access.resource_id,
+                                Anvil::PipelineStageFlagBits::TOP_OF_PIPE_BIT,
+                                Anvil::AccessFlagBits::NONE,
+                                current_access.stages,
+                                current_access.access,
+                                current_state.layout,
+                                new_layout,
+                                current_state.queue_family_index,
+                                current_pass.queue_family_index);
+
+                    is_dependency_chained = true;
+                }
+                else
+                if (needs_layout_transition)
+                {
+                    add_barrier(barrier_set_ptr,
+                                current_access.resource_id,
+                                Anvil::PipelineStageFlagBits::TOP_OF_PIPE_BIT,
+                                Anvil::AccessFlagBits::NONE,
+                                current_access.stages,
+                                current_access.access,
+                                current_state.layout,
+                                new_layout,
+                                VK_QUEUE_FAMILY_IGNORED,
+                                VK_QUEUE_FAMILY_IGNORED);
+
+                    is_dependency_chained = true;
+                }
+
+                current_state.read_stages  = Anvil::PipelineStageFlagBits::NONE;
+                current_state.write_access = Anvil::AccessFlagBits::NONE;
+                current_state.write_stages = Anvil::PipelineStageFlagBits::NONE;
+            }
+            else
+            if (current_state.n_batch == UINT32_MAX)
+            {
+                /* First access in the frame. Imported resources may need to wait on work which precedes the frame,
+                 * or be acquired from another queue family. Transient resources may be using memory of other transient
+                 * resources, whose lifetimes ended earlier in the same batch. */
+                Anvil::AccessFlags        src_access = current_state.write_access;
+                Anvil::PipelineStageFlags src_stages = current_state.write_stages;
+
+                if (current_resource.is_transient)
+                {
+                    for (uint32_t n_resource = 0;
+                                  n_resource < static_cast<uint32_t>(m_resources.size() );
+                                ++n_resource)
+                    {
+                        const auto& aliasing_resource = m_resources.at(n_resource);
+                        const auto& aliasing_state    = states.at     (n_resource);
+
+                        if ( aliasing_resource.is_transient                          &&
+                             aliasing_resource.n_last_pass <  n_pass                 &&
+                             aliasing_state.n_batch        == current_pass.n_batch)
+                        {
+                            src_access |= aliasing_state.write_access;
+                            src_stages |= aliasing_state.write_stages | aliasing_state.read_stages;
+                        }
+
+                        /* Batches which may execute concurrently must not use the same memory */
+                        if ( aliasing_resource.is_transient                          &&
+                             aliasing_resource.n_last_pass <  n_pass                 &&
+                             aliasing_state.n_batch        != UINT32_MAX             &&
+                             do_resources_alias(n_resource,
+                                                current_access.resource_id) )
+                        {
+                            add_batch_dependencies(current_pass.n_batch,
+                                                   aliasing_state,
+                                                   true); /* in_include_readers */
+                        }
+                    }
+                }
+
+                if (is_exclusive                                                       &&
+                    current_state.queue_family_index != VK_QUEUE_FAMILY_IGNORED         &&
+                    current_state.queue_family_index != current_pass.queue_family_index)
+                {
+                    add_barrier(barrier_set_ptr,
+                                current_access.resource_id,
+                                src_stages,
+                                src_access,
+                                current_access.stages,
+                                current_access.access,
+                                current_state.layout,
+                                new_layout,
+                                current_state.queue_family_index,
+                                current_pass.queue_family_index);
+
+                    is_dependency_chained = true;
+                }
+                else
+                if (needs_layout_transition                          ||
+                    src_stages != Anvil::PipelineStageFlagBits::NONE)
+                {
+                    add_barrier(barrier_set_ptr,
+                                current_access.resource_id,
+                                src_stages,
+                                src_access,
+                                current_access.stages,
+                                current_access.access,
+                                current_state.layout,
+                                new_layout,
+                                VK_QUEUE_FAMILY_IGNORED,
+                                VK_QUEUE_FAMILY_IGNORED);
+
+                    if (needs_layout_transition)
+                    {
+                        is_dependency_chained = true;
+                    }
+                    else
+                    {
+                        is_visibility_barrier = true;
+                    }
+                }
+            }
+            else
+            if (current_access.is_write ||
+                needs_layout_transition)
+            {
+                /* Write-after-read, write-after-write or a layout transition within the batch */
+                const auto src_stages = current_state.write_stages | current_state.read_stages;
+
+                if (needs_layout_transition                          ||
+                    src_stages != Anvil::PipelineStageFlagBits::NONE)
+                {
+                    add_barrier(barrier_set_ptr,
+                                current_access.resource_id,
+                                src_stages,
+                                current_state.write_access,
+                                current_access.stages,
+                                current_access.access,
+                                current_state.layout,
+                                new_layout,
+                                VK_QUEUE_FAMILY_IGNORED,
+                                VK_QUEUE_FAMILY_IGNORED);
+
+                    is_dependency_chained = needs_layout_transition;
+                }
+            }
+            else
+            {
+                /* Read-after-write within the batch. Reads which the last write has already been made visible to
+                 * need no barrier. */
+                if ( current_state.write_stages                                 != Anvil::PipelineStageFlagBits::NONE &&
+                   ((current_access.access & ~current_state.visible_access)     != Anvil::AccessFlagBits::NONE ||
+                    (current_access.stages & ~current_state.visible_stages)     != Anvil::PipelineStageFlagBits::NONE) )
+                {
+                    add_barrier(barrier_set_ptr,
+                                current_access.resource_id,
+                                current_state.write_stages,
+                                current_state.write_access,
+                                current_access.stages,
+                                current_access.access,
+                                current_state.layout,
+                                new_layout,
+                                VK_QUEUE_FAMILY_IGNORED,
+                                VK_QUEUE_FAMILY_IGNORED);
+
+                    is_visibility_barrier = true;
+                }
+            }
+
+            /* Replace barriers between subpasses with dependencies on all earlier subpasses which used the attachment */
+            if (barrier_set_ptr == &subpass_barriers &&
+                !subpass_barriers.is_empty() )
+            {
+                auto& render_pass = m_render_passes.at(current_pass.n_render_pass);
+
+                for (uint32_t n_src_pass = render_pass.n_first_pass;
+                              n_src_pass < n_pass;
+                            ++n_src_pass)
+                {
+                    if (!is_resource_accessed(current_access.resource_id,
+                                              n_src_pass,
+                                              1) ) /* in_n_passes */
+                    {
+                        continue;
+                    }
+
+                    auto dependency_iterator = std::find_if(render_pass.dependencies.begin(),
+                                                            render_pass.dependencies.end  (),
+                                                            [=](const SubpassDependency& in_dependency)
+                                                            {
+                                                                return (in_dependency.n_dst_pass == n_pass     &&
+                                                                        in_dependency.n_src_pass == n_src_pass);
+                                                            });
+
+                    if (dependency_iterator == render_pass.dependencies.end() )
+                    {
+                        SubpassDependency new_dependency;
+
+                        new_dependency.n_dst_pass = n_pass;
+                        new_dependency.n_src_pass = n_src_pass;
+
+                        render_pass.dependencies.push_back(new_dependency);
+
+                        dependency_iterator = render_pass.dependencies.end() - 1;
+                    }
+
+                    dependency_iterator->dst_access |= current_access.access;
+                    dependency_iterator->dst_stages |= subpass_barriers.dst_stages;
+                    dependency_iterator->src_access |= current_state.write_access;
+                    dependency_iterator->src_stages |= subpass_barriers.src_stages;
+                }
+            }
+
+            /* Update the resource's state */
+            if (current_access.is_write)
+            {
+                current_state.read_stages    = Anvil::PipelineStageFlagBits::NONE;
+                current_state.visible_access = Anvil::AccessFlagBits::NONE;
+                current_state.visible_stages = Anvil::PipelineStageFlagBits::NONE;
+                current_state.write_access   = current_access.access;
+                current_state.write_stages   = current_access.stages;
+            }
+            else
+            if (is_dependency_chained)
+            {
+                /* Later reads at other stages need to wait on the stages which waited on the layout transition or
+                 * ownership transfer. */
+                current_state.read_stages    = current_access.stages;
+                current_state.visible_access = current_access.access;
+                current_state.visible_stages = current_access.stages;
+                current_state.write_access   = Anvil::AccessFlagBits::NONE;
+                current_state.write_stages   = current_access.stages;
+            }
+            else
+            {
+                if (is_visibility_barrier)
+                {
+                    current_state.visible_access |= current_access.access;
+                    current_state.visible_stages |= current_access.stages;
+                }
+
+                current_state.read_stages |= current_access.stages;
+            }
+
+            if (is_modifying_access)
+            {
+                current_state.n_write_batch = current_pass.n_batch;
+
+                current_state.read_batches.clear();
+            }
+
+            if (!current_access.is_write                                &&
+                std::find(current_state.read_batches.begin(),
+                          current_state.read_batches.end  (),
+                          current_pass.n_batch) == current_state.read_batches.end() )
+            {
+                current_state.read_batches.push_back(current_pass.n_batch);
+            }
+
+            current_state.layout             = new_layout;
+            current_state.n_batch            = current_pass.n_batch;
+            current_state.queue_family_index = current_pass.queue_family_index;
+        }
+    }
+
+    /* Transition imported images to their final layouts once their last batch finishes using them */
+    for (uint32_t n_resource = 0;
+                  n_resource < static_cast<uint32_t>(m_resources.size() );
+                ++n_resource)
+    {
+        const auto& current_resource = m_resources.at(n_resource);
+        const auto& current_state    = states.at     (n_resource);
+
+        if (current_resource.final_layout == Anvil::ImageLayout::UNDEFINED ||
+            current_resource.final_layout == current_state.layout          ||
+            current_state.n_batch         == UINT32_MAX)
+        {
+            continue;
+        }
+
+        add_barrier(&m_batches.at(current_state.n_batch).release_barriers,
+                    n_resource,
+                    current_state.write_stages | current_state.read_stages,
+                    current_state.write_access,
+                    Anvil::PipelineStageFlagBits::BOTTOM_OF_PIPE_BIT,
+                    Anvil::AccessFlagBits::NONE,
+                    current_state.layout,
+                    current_resource.final_layout,
+                    VK_QUEUE_FAMILY_IGNORED,
+                    VK_QUEUE_FAMILY_IGNORED);
+
+        /* The transition must not start before other batches reading the image finish */
+        add_batch_dependencies(current_state.n_batch,
+                               current_state,
+                               true); /* in_include_readers */
+    }
+
+    if (!create_render_passes() )
+    {
+        goto end;
+    }
+
+    m_is_compiled = true;
+    result        = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::FrameGraphUniquePtr Anvil::FrameGraph::create(const Anvil::BaseDevice* in_device_ptr)
+{
+    Anvil::FrameGraphUniquePtr result_ptr(nullptr,
+                                          std::default_delete<Anvil::FrameGraph>() );
+
+    anvil_assert(in_device_ptr != nullptr);
+
+    result_ptr.reset(
+        new Anvil::FrameGraph(in_device_ptr)
+    );
+
+    return result_ptr;
+}
+
+/** Allocates command buffers and creates semaphores used by execute(). Must only be called once the graph has been
+ *  compiled.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::FrameGraph::create_execution_objects()
+{
+    std::vector<bool> has_dependents   (m_batches.size(),
+                                        false);
+    const uint32_t    last_batch_family = m_batches.back().queue_family_index;
+    bool              result            = false;
+
+    m_uses_timeline_semaphores = m_device_ptr->get_extension_info()->khr_timeline_semaphore();
+
+    for (auto& current_batch : m_batches)
+    {
+        auto& command_pool_ptr = m_command_pools[current_batch.queue_family_index];
+
+        if (command_pool_ptr == nullptr)
+        {
+            /* Batches are re-recorded by each execute() call, so the pool must let command buffers be reset individually */
+            command_pool_ptr = Anvil::CommandPool::create(const_cast<Anvil::BaseDevice*>(m_device_ptr),
+                                                          Anvil::CommandPoolCreateFlagBits::CREATE_RESET_COMMAND_BUFFER_BIT,
+                                                          current_batch.queue_family_index);
+
+            if (command_pool_ptr == nullptr)
+            {
+                anvil_assert(command_pool_ptr != nullptr);
+
+                goto end;
+            }
+        }
+
+        current_batch.cmd_buffer_ptr = command_pool_ptr->alloc_primary_level_command_buffer();
+
+        if (current_batch.cmd_buffer_ptr == nullptr)
+        {
+            anvil_assert(current_batch.cmd_buffer_ptr != nullptr);
+
+            goto end;
+        }
+
+        for (const auto& current_dependency : current_batch.dependencies)
+        {
+            has_dependents.at(current_dependency) = true;
+        }
+    }
+
+    if (m_uses_timeline_semaphores)
+    {
+        /* Each batch signals its own timeline semaphore with the execution counter. Batches executing on different
+         * queues may finish in any order, so they cannot share a single timeline. */
+        for (uint32_t n_semaphore = 0;
+                      n_semaphore < static_cast<uint32_t>(m_batches.size() ) + 1;
+                    ++n_semaphore)
+        {
+            auto create_info_ptr = Anvil::SemaphoreCreateInfo::create(m_device_ptr);
+
+            create_info_ptr->set_timeline(0); /* in_initial_value */
+
+            auto semaphore_ptr = Anvil::Semaphore::create(std::move(create_info_ptr) );
+
+            if (semaphore_ptr == nullptr)
+            {
+                anvil_assert(semaphore_ptr != nullptr);
+
+                goto end;
+            }
+
+            if (n_semaphore < static_cast<uint32_t>(m_batches.size() ))
+            {
+                m_batches.at(n_semaphore).signal_semaphore_ptrs.push_back(semaphore_ptr.get() );
+
+                m_semaphores.push_back(
+                    std::move(semaphore_ptr)
+                );
+            }
+            else
+            {
+                m_entry_timeline_semaphore_ptr = std::move(semaphore_ptr);
+            }
+        }
+    }
+    else
+    {
+        /* Binary semaphores can only be waited on once per signal, so each dependency needs its own semaphore.
+         *
+         * Root batches additionally get an entry semaphore, signalled once app-specified wait semaphores are met.
+         * Leaf batches submitted to a queue other than the last batch's get an exit semaphore, waited on before
+         * app-specified signal semaphores & fence are signalled. */
+        for (uint32_t n_batch = 0;
+                      n_batch < static_cast<uint32_t>(m_batches.size() );
+                    ++n_batch)
+        {
+            auto&      current_batch  = m_batches.at(n_batch);
+            const bool needs_entry    = (current_batch.dependencies.size() == 0);
+            const bool needs_exit     = (!has_dependents.at(n_batch)                           &&
+                                          n_batch                          != m_batches.size() - 1 &&
+                                          current_batch.queue_family_index != last_batch_family);
+            const auto n_dependencies = static_cast<uint32_t>(current_batch.dependencies.size() );
+
+            for (uint32_t n_semaphore = 0;
+                          n_semaphore < n_dependencies + 2;
+                        ++n_semaphore)
+            {
+                if ((n_semaphore == n_dependencies     && !needs_entry) ||
+                    (n_semaphore == n_dependencies + 1 && !needs_exit) )
+                {
+                    continue;
+                }
+
+                auto semaphore_ptr = Anvil::Semaphore::create(Anvil::SemaphoreCreateInfo::create(m_device_ptr) );
+
+                if (semaphore_ptr == nullptr)
+                {
+                    anvil_assert(semaphore_ptr != nullptr);
+
+                    goto end;
+                }
+
+                if (n_semaphore < n_dependencies)
+                {
+                    current_batch.wait_semaphore_ptrs.push_back                                                   (semaphore_ptr.get() );
+                    m_batches.at(current_batch.dependencies.at(n_semaphore) ).signal_semaphore_ptrs.push_back(semaphore_ptr.get() );
+                }
+                else
+                if (n_semaphore == n_dependencies)
+                {
+                    current_batch.entry_semaphore_ptr = semaphore_ptr.get();
+                }
+                else
+                {
+                    current_batch.exit_semaphore_ptr = semaphore_ptr.get();
+                }
+
+                m_semaphores.push_back(
+                    std::move(semaphore_ptr)
+                );
+            }
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Creates render passes, attachment image views and framebuffers used by raster passes. Must be called once
+ *  barriers and subpass dependencies have been determined.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::FrameGraph::create_render_passes()
+{
+    bool result = false;
+
+    for (auto& current_render_pass : m_render_passes)
+    {
+        std::vector<Anvil::RenderPassAttachmentID> attachment_ids;
+        const Anvil::ImageCreateInfo*              first_create_info_ptr       = get_image_create_info(m_passes.at(current_render_pass.n_first_pass).attachments.at(0).resource_id);
+        Anvil::FramebufferCreateInfoUniquePtr      framebuffer_create_info_ptr;
+        const uint32_t                             n_last_pass                 = current_render_pass.n_first_pass + current_render_pass.n_passes - 1;
+        Anvil::RenderPassCreateInfoUniquePtr       render_pass_create_info_ptr(new Anvil::RenderPassCreateInfo(m_device_ptr) );
+
+        /* Attachments are defined in the order of their first use. Their initial and final layouts are the layouts of
+         * their first and last use, so that the render pass only transitions them between subpasses. Attachments are
+         * only stored if they are accessed after the render pass, or are owned by the app. */
+        for (uint32_t n_pass = current_render_pass.n_first_pass;
+                      n_pass <= n_last_pass;
+                    ++n_pass)
+        {
+            for (const auto& current_attachment : m_passes.at(n_pass).attachments)
+            {
+                Anvil::RenderPassAttachmentID       attachment_id               = UINT32_MAX;
+                const auto&                         current_resource            = m_resources.at(current_attachment.resource_id);
+                const Anvil::ImageCreateInfo*       create_info_ptr             = current_resource.image_ptr->get_create_info_ptr();
+                Anvil::ImageLayout                  final_layout                = current_attachment.layout;
+                const bool                          has_stencil                 = Anvil::Formats::has_stencil_aspect(create_info_ptr->get_format() );
+                Anvil::ImageViewCreateInfoUniquePtr image_view_create_info_ptr;
+                Anvil::ImageViewUniquePtr           image_view_ptr;
+                const Anvil::AttachmentLoadOp       load_op                     = (current_attachment.type == Anvil::AttachmentType::INPUT) ? Anvil::AttachmentLoadOp::LOAD
+                                                                                                                                           : current_attachment.load_op;
+                const Anvil::AttachmentStoreOp      store_op                    = (!current_resource.is_transient             ||
+                                                                                    current_resource.n_last_pass > n_last_pass) ? Anvil::AttachmentStoreOp::STORE
+                                                                                                                                : Anvil::AttachmentStoreOp::DONT_CARE;
+                const Anvil::ImageAspectFlags       aspects                     = current_resource.image_ptr->get_subresource_range().aspect_mask;
+                bool                                is_attachment_added         = false;
+
+                if (std::find(current_render_pass.attachment_resource_ids.begin(),
+                              current_render_pass.attachment_resource_ids.end  (),
+                              current_attachment.resource_id) != current_render_pass.attachment_resource_ids.end() )
+                {
+                    continue;
+                }
+
+                for (uint32_t n_later_pass = n_pass + 1;
+                              n_later_pass <= n_last_pass;
+                            ++n_later_pass)
+                {
+                    const Attachment* later_attachment_ptr = get_attachment(n_later_pass,
+                                                                            current_attachment.resource_id);
+
+                    if (later_attachment_ptr != nullptr)
+                    {
+                        final_layout = later_attachment_ptr->layout;
+                    }
+                }
+
+                if (has_stencil                                                        ||
+                    Anvil::Formats::has_depth_aspect(create_info_ptr->get_format() ) )
+                {
+                    is_attachment_added = render_pass_create_info_ptr->add_depth_stencil_attachment(create_info_ptr->get_format      (),
+                                                                                                    create_info_ptr->get_sample_count(),
+                                                                                                    load_op,
+                                                                                                    store_op,
+                                                                                                    (has_stencil) ? load_op  : Anvil::AttachmentLoadOp::DONT_CARE,
+                                                                                                    (has_stencil) ? store_op : Anvil::AttachmentStoreOp::DONT_CARE,
+                                                                                                    current_attachment.layout,
+                                                                                                    final_layout,
+                                                                                                    false, /* in_may_alias */
+                                                                                                   &attachment_id);
+                }
+                else
+                {
+                    is_attachment_added = render_pass_create_info_ptr->add_color_attachment(create_info_ptr->get_format      (),
+                                                                                            create_info_ptr->get_sample_count(),
+                                                                                            load_op,
+                                                                                            store_op,
+                                                                                            current_attachment.layout,
+                                                                                            final_layout,
+                                                                                            false, /* in_may_alias */
+                                                                                           &attachment_id);
+                }
+
+                if (!is_attachment_added)
+                {
+                    anvil_assert(is_attachment_added);
+
+                    goto end;
+                }
+
+                if (create_info_ptr->get_n_layers() > 1)
+                {
+                    image_view_create_info_ptr = Anvil::ImageViewCreateInfo::create_2D_array(m_device_ptr,
+                                                                                             current_resource.image_ptr,
+                                                                                             0, /* in_n_base_layer         */
+                                                                                             create_info_ptr->get_n_layers(),
+                                                                                             0, /* in_n_base_mipmap_level  */
+                                                                                             1, /* in_n_mipmaps            */
+                                                                                             aspects,
+                                                                                             create_info_ptr->get_format(),
+                                                                                             Anvil::ComponentSwizzle::IDENTITY,
+                                                                                             Anvil::ComponentSwizzle::IDENTITY,
+                                                                                             Anvil::ComponentSwizzle::IDENTITY,
+                                                                                             Anvil::ComponentSwizzle::IDENTITY);
+                }
+                else
+                {
+                    image_view_create_info_ptr = Anvil::ImageViewCreateInfo::create_2D(m_device_ptr,
+                                                                                       current_resource.image_ptr,
+                                                                                       0, /* in_n_base_layer        */
+                                                                                       0, /* in_n_base_mipmap_level */
+                                                                                       1, /* in_n_mipmaps           */
+                                                                                       aspects,
+                                                                                       create_info_ptr->get_format(),
+                                                                                       Anvil::ComponentSwizzle::IDENTITY,
+                                                                                       Anvil::ComponentSwizzle::IDENTITY,
+                                                                                       Anvil::ComponentSwizzle::IDENTITY,
+                                                                                       Anvil::ComponentSwizzle::IDENTITY);
+                }
+
+                image_view_ptr = Anvil::ImageView::create(std::move(image_view_create_info_ptr) );
+
+                if (image_view_ptr == nullptr)
+                {
+                    anvil_assert(image_view_ptr != nullptr);
+
+                    goto end;
+                }
+
+                attachment_ids.push_back                             (attachment_id);
+                current_render_pass.attachment_resource_ids.push_back(current_attachment.resource_id);
+                current_render_pass.clear_values.push_back           (current_attachment.clear_value);
+                current_render_pass.image_view_ptrs.push_back        (std::move(image_view_ptr) );
+            }
+        }
+
+        for (uint32_t n_pass = current_render_pass.n_first_pass;
+                      n_pass <= n_last_pass;
+                    ++n_pass)
+        {
+            auto& current_pass = m_passes.at(n_pass);
+
+            if (!render_pass_create_info_ptr->add_subpass(&current_pass.subpass_id) )
+            {
+                anvil_assert_fail();
+
+                goto end;
+            }
+
+            for (const auto& current_attachment : current_pass.attachments)
+            {
+                const auto attachment_id       = attachment_ids.at(std::find(current_render_pass.attachment_resource_ids.begin(),
+                                                                             current_render_pass.attachment_resource_ids.end  (),
+                                                                             current_attachment.resource_id) - current_render_pass.attachment_resource_ids.begin() );
+                bool       is_attachment_added = false;
+
+                switch (current_attachment.type)
+                {
+                    case Anvil::AttachmentType::COLOR:
+                    {
+                        is_attachment_added = render_pass_create_info_ptr->add_subpass_color_attachment(current_pass.subpass_id,
+                                                                                                        current_attachment.layout,
+                                                                                                        attachment_id,
+                                                                                                        current_attachment.index);
+
+                        break;
+                    }
+
+                    case Anvil::AttachmentType::DEPTH_STENCIL:
+                    {
+                        is_attachment_added = render_pass_create_info_ptr->add_subpass_depth_stencil_attachment(current_pass.subpass_id,
+                                                                                                                current_attachment.layout,
+                                                                                                                attachment_id);
+
+                        break;
+                    }
+
+                    case Anvil::AttachmentType::INPUT:
+                    {
+                        is_attachment_added = render_pass_create_info_ptr->add_subpass_input_attachment(current_pass.subpass_id,
+                                                                                                        current_attachment.layout,
+                                                                                                        attachment_id,
+                                                                                                        current_attachment.index);
+
+                        break;
+                    }
+
+                    default:
+                    {
+                        anvil_assert_fail();
+                    }
+                }
+
+                if (!is_attachment_added)
+                {
+                    anvil_assert(is_attachment_added);
+
+                    goto end;
+                }
+            }
+        }
+
+        for (const auto& current_dependency : current_render_pass.dependencies)
+        {
+            if (!render_pass_create_info_ptr->add_subpass_to_subpass_dependency(m_passes.at(current_dependency.n_src_pass).subpass_id,
+                                                                                m_passes.at(current_dependency.n_dst_pass).subpass_id,
+                                                                                current_dependency.src_stages,
+                                                                                current_dependency.dst_stages,
+                                                                                current_dependency.src_access,
+                                                                                current_dependency.dst_access,
+                                                                                Anvil::DependencyFlagBits::BY_REGION_BIT) )
+            {
+                anvil_assert_fail();
+
+                goto end;
+            }
+        }
+
+        current_render_pass.render_pass_ptr = Anvil::RenderPass::create(std::move(render_pass_create_info_ptr),
+                                                                        nullptr); /* in_opt_swapchain_ptr */
+
+        if (current_render_pass.render_pass_ptr == nullptr)
+        {
+            anvil_assert(current_render_pass.render_pass_ptr != nullptr);
+
+            goto end;
+        }
+
+        current_render_pass.render_area.extent.height = first_create_info_ptr->get_base_mip_height();
+        current_render_pass.render_area.extent.width  = first_create_info_ptr->get_base_mip_width ();
+        current_render_pass.render_area.offset.x      = 0;
+        current_render_pass.render_area.offset.y      = 0;
+
+        framebuffer_create_info_ptr = Anvil::FramebufferCreateInfo::create(m_device_ptr,
+                                                                           first_create_info_ptr->get_base_mip_width (),
+                                                                           first_create_info_ptr->get_base_mip_height(),
+                                                                           first_create_info_ptr->get_n_layers       () );
+
+        for (const auto& current_image_view_ptr : current_render_pass.image_view_ptrs)
+        {
+            if (!framebuffer_create_info_ptr->add_attachment(current_image_view_ptr.get(),
+                                                             nullptr) ) /* out_opt_attachment_id_ptr */
+            {
+                anvil_assert_fail();
+
+                goto end;
+            }
+        }
+
+        current_render_pass.framebuffer_ptr = Anvil::Framebuffer::create(std::move(framebuffer_create_info_ptr) );
+
+        if (current_render_pass.framebuffer_ptr == nullptr)
+        {
+            anvil_assert(current_render_pass.framebuffer_ptr != nullptr);
+
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Determines lifetimes of all resources. Creates transient resources accessed by at least one pass, and assigns
+ *  them aliased device-local memory.
+ *
+ *  Resources accessed by a render pass live throughout the whole render pass, so that attachments used by
+ *  different subpasses never share memory.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::FrameGraph::create_transient_resources()
+{
+    bool needs_bake = false;
+    bool result     = false;
+
+    for (uint32_t n_pass = 0;
+                  n_pass < static_cast<uint32_t>(m_passes.size() );
+                ++n_pass)
+    {
+        const auto& current_pass = m_passes.at(n_pass);
+        uint32_t    n_first_pass = n_pass;
+        uint32_t    n_last_pass  = n_pass;
+
+        if (current_pass.n_render_pass != UINT32_MAX)
+        {
+            const auto& render_pass = m_render_passes.at(current_pass.n_render_pass);
+
+            n_first_pass = render_pass.n_first_pass;
+            n_last_pass  = render_pass.n_first_pass + render_pass.n_passes - 1;
+        }
+
+        for (const auto& current_access : current_pass.accesses)
+        {
+            auto& current_resource = m_resources.at(current_access.resource_id);
+
+            if (current_resource.n_first_pass == UINT32_MAX)
+            {
+                current_resource.n_first_pass = n_first_pass;
+            }
+
+            current_resource.n_last_pass = n_last_pass;
+        }
+    }
+
+    m_memory_allocator_ptr = Anvil::MemoryAllocator::create_oneshot(m_device_ptr);
+
+    if (m_memory_allocator_ptr == nullptr)
+    {
+        anvil_assert(m_memory_allocator_ptr != nullptr);
+
+        goto end;
+    }
+
+    for (auto& current_resource : m_resources)
+    {
+        if (!current_resource.is_transient            ||
+             current_resource.n_first_pass == UINT32_MAX)
+        {
+            continue;
+        }
+
+        if (current_resource.buffer_create_info_ptr != nullptr)
+        {
+            current_resource.transient_buffer_ptr = Anvil::Buffer::create(std::move(current_resource.buffer_create_info_ptr) );
+            current_resource.buffer_ptr           = current_resource.transient_buffer_ptr.get();
+
+            if (current_resource.buffer_ptr == nullptr)
+            {
+                anvil_assert(current_resource.buffer_ptr != nullptr);
+
+                goto end;
+            }
+
+            if (!m_memory_allocator_ptr->add_aliased_buffer(current_resource.buffer_ptr,
+                                                            current_resource.n_first_pass,
+                                                            current_resource.n_last_pass,
+                                                            Anvil::MemoryFeatureFlagBits::DEVICE_LOCAL_BIT) )
+            {
+                goto end;
+            }
+        }
+        else
+        {
+            current_resource.transient_image_ptr = Anvil::Image::create(std::move(current_resource.image_create_info_ptr) );
+            current_resource.image_ptr           = current_resource.transient_image_ptr.get();
+
+            if (current_resource.image_ptr == nullptr)
+            {
+                anvil_assert(current_resource.image_ptr != nullptr);
+
+                goto end;
+            }
+
+            if (!m_memory_allocator_ptr->add_aliased_image(current_resource.image_ptr,
+                                                           current_resource.n_first_pass,
+                                                           current_resource.n_last_pass,
+                                                           Anvil::MemoryFeatureFlagBits::DEVICE_LOCAL_BIT) )
+            {
+                goto end;
+            }
+        }
+
+        needs_bake = true;
+    }
+
+    if (needs_bake                      &&
+        !m_memory_allocator_ptr->bake() )
+    {
+        goto end;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Tells whether memory backing two resources overlaps. Only meaningful for resources with memory assigned.
+ *
+ *  @return true if the resources share at least one byte of memory, false otherwise.
+ **/
+bool Anvil::FrameGraph::do_resources_alias(ResourceID in_resource_a_id,
+                                           ResourceID in_resource_b_id)
+{
+    Anvil::MemoryBlock* memory_block_ptrs[2] = {nullptr, nullptr};
+    const ResourceID    resource_ids     [2] = {in_resource_a_id, in_resource_b_id};
+
+    for (uint32_t n_resource = 0;
+                  n_resource < 2;
+                ++n_resource)
+    {
+        const auto& current_resource = m_resources.at(resource_ids[n_resource]);
+
+        memory_block_ptrs[n_resource] = (current_resource.image_ptr != nullptr) ? current_resource.image_ptr->get_memory_block ()
+                                                                                 : current_resource.buffer_ptr->get_memory_block(0); /* in_n_memory_block */
+    }
+
+    return (memory_block_ptrs[0] != nullptr                         &&
+            memory_block_ptrs[1] != nullptr                         &&
+            memory_block_ptrs[0]->intersects(memory_block_ptrs[1]) );
+}
+
+/** Please see header for specification */
+bool Anvil::FrameGraph::execute(uint32_t                         in_n_wait_semaphores,
+                                Anvil::Semaphore* const*         in_opt_wait_semaphore_ptrs,
+                                const Anvil::PipelineStageFlags* in_opt_wait_stage_masks_ptr,
+                                uint32_t                         in_n_signal_semaphores,
+                                Anvil::Semaphore* const*         in_opt_signal_semaphore_ptrs,
+                                Anvil::Fence*                    in_opt_fence_ptr)
+{
+    const uint32_t                         last_batch_family = (m_batches.size() > 0) ? m_batches.back().queue_family_index : VK_QUEUE_FAMILY_IGNORED;
+    bool                                   result            = false;
+    std::vector<Anvil::Semaphore*>         signal_semaphore_ptrs;
+    std::vector<uint64_t>                  signal_semaphore_values;
+    std::vector<Anvil::PipelineStageFlags> wait_stage_masks;
+    std::vector<Anvil::Semaphore*>         wait_semaphore_ptrs;
+    std::vector<uint64_t>                  wait_semaphore_values;
+
+    anvil_assert(m_is_compiled);
+
+    if (m_batches.size() == 0)
+    {
+        anvil_assert(m_batches.size() > 0);
+
+        goto end;
+    }
+
+    if (m_batches.at(0).cmd_buffer_ptr == nullptr)
+    {
+        if (!create_execution_objects() )
+        {
+            goto end;
+        }
+    }
+
+    ++m_n_executions;
+
+    /* App-specified wait semaphores are waited on by a single, empty submission. Root batches then wait on a semaphore it
+     * signals, instead of each root batch waiting on the app's semaphores. */
+    if (in_n_wait_semaphores > 0)
+    {
+        if (m_uses_timeline_semaphores)
+        {
+            signal_semaphore_ptrs.push_back  (m_entry_timeline_semaphore_ptr.get() );
+            signal_semaphore_values.push_back(m_n_executions);
+        }
+        else
+        {
+            for (const auto& current_batch : m_batches)
+            {
+                if (current_batch.entry_semaphore_ptr != nullptr)
+                {
+                    signal_semaphore_ptrs.push_back(current_batch.entry_semaphore_ptr);
+                }
+            }
+        }
+
+        auto submit_info = Anvil::SubmitInfo::create(nullptr, /* in_opt_cmd_buffer_ptr */
+                                                     static_cast<uint32_t>(signal_semaphore_ptrs.size() ),
+                                                     signal_semaphore_ptrs.data(),
+                                                     in_n_wait_semaphores,
+                                                     in_opt_wait_semaphore_ptrs,
+                                                     in_opt_wait_stage_masks_ptr,
+                                                     false); /* in_should_block */
+
+        if (m_uses_timeline_semaphores)
+        {
+            wait_semaphore_values.assign(in_n_wait_semaphores,
+                                         0);
+
+            submit_info.set_timeline_semaphore_values(signal_semaphore_values.data(),
+                                                      static_cast<uint32_t>(signal_semaphore_values.size() ),
+                                                      wait_semaphore_values.data(),
+                                                      static_cast<uint32_t>(wait_semaphore_values.size() ));
+        }
+
+        if (!m_device_ptr->get_queue_for_queue_family_index(m_batches.at(0).queue_family_index,
+                                                            0 /* in_n_queue */)->submit(submit_info) )
+        {
+            goto end;
+        }
+    }
+
+    for (uint32_t n_batch = 0;
+                  n_batch < static_cast<uint32_t>(m_batches.size() );
+                ++n_batch)
+    {
+        auto&      current_batch = m_batches.at(n_batch);
+        const bool needs_exit    = (current_batch.exit_semaphore_ptr != nullptr)                          &&
+                                   (in_n_signal_semaphores           >  0 || in_opt_fence_ptr != nullptr);
+
+        signal_semaphore_ptrs.clear  ();
+        signal_semaphore_values.clear();
+        wait_semaphore_ptrs.clear    ();
+        wait_semaphore_values.clear  ();
+
+        if (!current_batch.cmd_buffer_ptr->start_recording(true,   /* in_one_time_submit          */
+                                                           false) /* in_simultaneous_use_allowed */ ||
+            !record_batch                                 (n_batch,
+                                                           current_batch.cmd_buffer_ptr.get() )    ||
+            !current_batch.cmd_buffer_ptr->stop_recording () )
+        {
+            goto end;
+        }
+
+        if (m_uses_timeline_semaphores)
+        {
+            for (const auto& current_dependency : current_batch.dependencies)
+            {
+                wait_semaphore_ptrs.push_back  (m_batches.at(current_dependency).signal_semaphore_ptrs.at(0) );
+                wait_semaphore_values.push_back(m_n_executions);
+            }
+
+            if (current_batch.dependencies.size() == 0 &&
+                in_n_wait_semaphores              >  0)
+            {
+                wait_semaphore_ptrs.push_back  (m_entry_timeline_semaphore_ptr.get() );
+                wait_semaphore_values.push_back(m_n_executions);
+            }
+
+            signal_semaphore_ptrs.push_back  (current_batch.signal_semaphore_ptrs.at(0) );
+            signal_semaphore_values.push_back(m_n_executions);
+        }
+        else
+        {
+            wait_semaphore_ptrs   = current_batch.wait_semaphore_ptrs;
+            signal_semaphore_ptrs = current_batch.signal_semaphore_ptrs;
+
+            if (current_batch.entry_semaphore_ptr != nullptr &&
+                in_n_wait_semaphores              >  0)
+            {
+                wait_semaphore_ptrs.push_back(current_batch.entry_semaphore_ptr);
+            }
+
+            if (needs_exit)
+            {
+                signal_semaphore_ptrs.push_back(current_batch.exit_semaphore_ptr);
+            }
+        }
+
+        wait_stage_masks.assign(wait_semaphore_ptrs.size(),
+                                Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT);
+
+        {
+            auto submit_info = Anvil::SubmitInfo::create(current_batch.cmd_buffer_ptr.get(),
+                                                         static_cast<uint32_t>(signal_semaphore_ptrs.size() ),
+                                                         (signal_semaphore_ptrs.size() > 0) ? signal_semaphore_ptrs.data() : nullptr,
+                                                         static_cast<uint32_t>(wait_semaphore_ptrs.size() ),
+                                                         (wait_semaphore_ptrs.size()   > 0) ? wait_semaphore_ptrs.data()   : nullptr,
+                                                         (wait_stage_masks.size()      > 0) ? wait_stage_masks.data()      : nullptr,
+                                                         false); /* in_should_block */
+
+            if (m_uses_timeline_semaphores)
+            {
+                submit_info.set_timeline_semaphore_values(signal_semaphore_values.data(),
+                                                          static_cast<uint32_t>(signal_semaphore_values.size() ),
+                                                          wait_semaphore_values.data(),
+                                                          static_cast<uint32_t>(wait_semaphore_values.size() ));
+            }
+
+            if (!m_device_ptr->get_queue_for_queue_family_index(current_batch.queue_family_index,
+                                                                0 /* in_n_queue */)->submit(submit_info) )
+            {
+                goto end;
+            }
+        }
+    }
+
+    /* App-specified signal semaphores & fence are signalled by a single, empty submission on the last batch's queue.
+     * Submission order covers batches executed on that queue. Leaf batches executed on other queues are waited on. */
+    if (in_n_signal_semaphores > 0          ||
+        in_opt_fence_ptr       != nullptr)
+    {
+        wait_semaphore_ptrs.clear  ();
+        wait_semaphore_values.clear();
+
+        for (uint32_t n_batch = 0;
+                      n_batch < static_cast<uint32_t>(m_batches.size() );
+                    ++n_batch)
+        {
+            const auto& current_batch = m_batches.at(n_batch);
+
+            if (m_uses_timeline_semaphores)
+            {
+                if (current_batch.queue_family_index != last_batch_family)
+                {
+                    wait_semaphore_ptrs.push_back  (current_batch.signal_semaphore_ptrs.at(0) );
+                    wait_semaphore_values.push_back(m_n_executions);
+                }
+            }
+            else
+            if (current_batch.exit_semaphore_ptr != nullptr)
+            {
+                wait_semaphore_ptrs.push_back(current_batch.exit_semaphore_ptr);
+            }
+        }
+
+        signal_semaphore_values.assign(in_n_signal_semaphores,
+                                       0);
+        wait_stage_masks.assign       (wait_semaphore_ptrs.size(),
+                                       Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT);
+
+        auto submit_info = Anvil::SubmitInfo::create(nullptr, /* in_opt_cmd_buffer_ptr */
+                                                     in_n_signal_semaphores,
+                                                     in_opt_signal_semaphore_ptrs,
+                                                     static_cast<uint32_t>(wait_semaphore_ptrs.size() ),
+                                                     (wait_semaphore_ptrs.size() > 0) ? wait_semaphore_ptrs.data() : nullptr,
+                                                     (wait_stage_masks.size()    > 0) ? wait_stage_masks.data()    : nullptr,
+                                                     false, /* in_should_block */
+                                                     in_opt_fence_ptr);
+
+        if (m_uses_timeline_semaphores)
+        {
+            submit_info.set_timeline_semaphore_values(signal_semaphore_values.data(),
+                                                      in_n_signal_semaphores,
+                                                      wait_semaphore_values.data(),
+                                                      static_cast<uint32_t>(wait_semaphore_values.size() ));
+        }
+
+        if (!m_device_ptr->get_queue_for_queue_family_index(last_batch_family,
+                                                            0 /* in_n_queue */)->submit(submit_info) )
+        {
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+const std::vector<uint32_t>& Anvil::FrameGraph::get_batch_dependencies(uint32_t in_n_batch) const
+{
+    anvil_assert(in_n_batch < static_cast<uint32_t>(m_batches.size() ));
+
+    return m_batches.at(in_n_batch).dependencies;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::FrameGraph::get_batch_queue_family_index(uint32_t in_n_batch) const
+{
+    anvil_assert(in_n_batch < static_cast<uint32_t>(m_batches.size() ));
+
+    return m_batches.at(in_n_batch).queue_family_index;
+}
+
+/** Please see header for specification */
+Anvil::Buffer* Anvil::FrameGraph::get_buffer(ResourceID in_resource_id) const
+{
+    anvil_assert(in_resource_id < static_cast<uint32_t>(m_resources.size() ));
+
+    return m_resources.at(in_resource_id).buffer_ptr;
+}
+
+/** Returns the attachment a pass uses a resource as, or null if the pass does not use the resource as an attachment. */
+const Anvil::FrameGraph::Attachment* Anvil::FrameGraph::get_attachment(uint32_t   in_n_pass,
+                                                                       ResourceID in_resource_id) const
+{
+    for (const auto& current_attachment : m_passes.at(in_n_pass).attachments)
+    {
+        if (current_attachment.resource_id == in_resource_id)
+        {
+            return &current_attachment;
+        }
+    }
+
+    return nullptr;
+}
+
+/** Please see header for specification */
+Anvil::Image* Anvil::FrameGraph::get_image(ResourceID in_resource_id) const
+{
+    anvil_assert(in_resource_id < static_cast<uint32_t>(m_resources.size() ));
+
+    return m_resources.at(in_resource_id).image_ptr;
+}
+
+/** Returns create info of an image resource, or null for buffer resources. Transient images' create info is
+ *  available both before and after the image is created.
+ **/
+const Anvil::ImageCreateInfo* Anvil::FrameGraph::get_image_create_info(ResourceID in_resource_id) const
+{
+    const auto& resource = m_resources.at(in_resource_id);
+
+    return (resource.image_ptr != nullptr) ? resource.image_ptr->get_create_info_ptr()
+                                           : resource.image_create_info_ptr.get     ();
+}
+
+/** Please see header for specification */
+Anvil::RenderPass* Anvil::FrameGraph::get_render_pass(PassID            in_pass_id,
+                                                      Anvil::SubPassID* out_opt_subpass_id_ptr) const
+{
+    Anvil::RenderPass* result_ptr = nullptr;
+
+    anvil_assert(m_is_compiled);
+    anvil_assert(in_pass_id < static_cast<uint32_t>(m_passes.size() ));
+
+    if (m_passes.at(in_pass_id).n_render_pass != UINT32_MAX)
+    {
+        result_ptr = m_render_passes.at(m_passes.at(in_pass_id).n_render_pass).render_pass_ptr.get();
+
+        if (out_opt_subpass_id_ptr != nullptr)
+        {
+            *out_opt_subpass_id_ptr = m_passes.at(in_pass_id).subpass_id;
+        }
+    }
+
+    return result_ptr;
+}
+
+/** Assigns raster passes to render passes. A raster pass joins the render pass of the raster pass(es) directly
+ *  preceding it if can_merge_pass() allows it, and starts a new render pass otherwise.
+ **/
+void Anvil::FrameGraph::group_render_passes()
+{
+    for (uint32_t n_pass = 0;
+                  n_pass < static_cast<uint32_t>(m_passes.size() );
+                ++n_pass)
+    {
+        auto& current_pass = m_passes.at(n_pass);
+
+        if (current_pass.attachments.size() == 0)
+        {
+            continue;
+        }
+
+        if ( m_render_passes.size()                                                 == 0      ||
+             m_render_passes.back().n_first_pass + m_render_passes.back().n_passes != n_pass ||
+            !can_merge_pass(m_render_passes.back(),
+                            n_pass) )
+        {
+            RenderPassInstance new_render_pass;
+
+            new_render_pass.n_first_pass = n_pass;
+
+            m_render_passes.push_back(
+                std::move(new_render_pass)
+            );
+        }
+
+        current_pass.n_render_pass = static_cast<uint32_t>(m_render_passes.size() - 1);
+        m_render_passes.back().n_passes++;
+    }
+}
+
+/** Please see header for specification */
+Anvil::FrameGraph::ResourceID Anvil::FrameGraph::import_buffer(Anvil::Buffer*            in_buffer_ptr,
+                                                               Anvil::PipelineStageFlags in_src_stages,
+                                                               Anvil::AccessFlags        in_src_access,
+                                                               uint32_t                  in_queue_family_index)
+{
+    Resource new_resource;
+
+    anvil_assert(!m_is_compiled);
+    anvil_assert(in_buffer_ptr != nullptr);
+
+    new_resource.buffer_ptr                 = in_buffer_ptr;
+    new_resource.initial_queue_family_index = in_queue_family_index;
+    new_resource.initial_src_access         = in_src_access;
+    new_resource.initial_src_stages         = in_src_stages;
+
+    m_resources.push_back(
+        std::move(new_resource)
+    );
+
+    return static_cast<ResourceID>(m_resources.size() - 1);
+}
+
+/** Please see header for specification */
+Anvil::FrameGraph::ResourceID Anvil::FrameGraph::import_image(Anvil::Image*             in_image_ptr,
+                                                              Anvil::ImageLayout        in_layout,
+                                                              Anvil::ImageLayout        in_final_layout,
+                                                              Anvil::PipelineStageFlags in_src_stages,
+                                                              Anvil::AccessFlags        in_src_access,
+                                                              uint32_t                  in_queue_family_index)
+{
+    Resource new_resource;
+
+    anvil_assert(!m_is_compiled);
+    anvil_assert(in_image_ptr != nullptr);
+
+    new_resource.final_layout               = in_final_layout;
+    new_resource.image_ptr                  = in_image_ptr;
+    new_resource.initial_layout             = in_layout;
+    new_resource.initial_queue_family_index = in_queue_family_index;
+    new_resource.initial_src_access         = in_src_access;
+    new_resource.initial_src_stages         = in_src_stages;
+
+    m_resources.push_back(
+        std::move(new_resource)
+    );
+
+    return static_cast<ResourceID>(m_resources.size() - 1);
+}
+
+/** Tells whether any of the specified passes accesses a resource.
+ *
+ *  @param in_resource_id  ID of the resource.
+ *  @param in_n_first_pass Index of the first pass to check.
+ *  @param in_n_passes     Number of passes to check.
+ *
+ *  @return As per description.
+ **/
+bool Anvil::FrameGraph::is_resource_accessed(ResourceID in_resource_id,
+                                             uint32_t   in_n_first_pass,
+                                             uint32_t   in_n_passes) const
+{
+    for (uint32_t n_pass = in_n_first_pass;
+                  n_pass < in_n_first_pass + in_n_passes;
+                ++n_pass)
+    {
+        for (const auto& current_access : m_passes.at(n_pass).accesses)
+        {
+            if (current_access.resource_id == in_resource_id)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/** Tells whether the specified resource uses exclusive sharing mode, in which case accesses from different queue
+ *  families require ownership transfers.
+ *
+ *  @param in_resource_id ID of the resource. The resource's wrapper must have been created.
+ *
+ *  @return As per description.
+ **/
+bool Anvil::FrameGraph::is_resource_exclusive(ResourceID in_resource_id) const
+{
+    const auto& resource = m_resources.at(in_resource_id);
+
+    if (resource.image_ptr != nullptr)
+    {
+        return (resource.image_ptr->get_create_info_ptr()->get_sharing_mode() == Anvil::SharingMode::EXCLUSIVE);
+    }
+
+    anvil_assert(resource.buffer_ptr != nullptr);
+
+    return (resource.buffer_ptr->get_create_info_ptr()->get_sharing_mode() == Anvil::SharingMode::EXCLUSIVE);
+}
+
+/** Please see header for specification */
+bool Anvil::FrameGraph::record(Anvil::PrimaryCommandBuffer* in_cmd_buffer_ptr)
+{
+    bool result = false;
+
+    anvil_assert(m_is_compiled);
+
+    if (m_batches.size() == 0)
+    {
+        result = true;
+
+        goto end;
+    }
+
+    if (m_batches.size() != 1)
+    {
+        anvil_assert(m_batches.size() == 1);
+
+        goto end;
+    }
+
+    result = record_batch(0, /* in_n_batch */
+                          in_cmd_buffer_ptr);
+end:
+    return result;
+}
+
+/** Records a barrier set with a single vkCmdPipelineBarrier() call. Nop for empty sets.
+ *
+ *  @param in_barrier_set    Barrier set to record.
+ *  @param in_cmd_buffer_ptr Command buffer to record the barriers into. Must not be null.
+ **/
+void Anvil::FrameGraph::record_barriers(const BarrierSet&            in_barrier_set,
+                                        Anvil::PrimaryCommandBuffer* in_cmd_buffer_ptr) const
+{
+    if (in_barrier_set.is_empty() )
+    {
+        return;
+    }
+
+    in_cmd_buffer_ptr->record_pipeline_barrier(in_barrier_set.src_stages,
+                                               in_barrier_set.dst_stages,
+                                               Anvil::DependencyFlagBits::NONE,
+                                               0,       /* in_memory_barrier_count */
+                                               nullptr, /* in_memory_barriers_ptr  */
+                                               static_cast<uint32_t>(in_barrier_set.buffer_barriers.size() ),
+                                               (in_barrier_set.buffer_barriers.size() > 0) ? &in_barrier_set.buffer_barriers.at(0) : nullptr,
+                                               static_cast<uint32_t>(in_barrier_set.image_barriers.size() ),
+                                               (in_barrier_set.image_barriers.size()  > 0) ? &in_barrier_set.image_barriers.at(0)  : nullptr);
+}
+
+/** Please see header for specification */
+bool Anvil::FrameGraph::record_batch(uint32_t                     in_n_batch,
+                                     Anvil::PrimaryCommandBuffer* in_cmd_buffer_ptr)
+{
+    static const float label_color[] = {1.0f, 1.0f, 1.0f, 1.0f};
+
+    const Batch* batch_ptr = nullptr;
+    bool         result    = false;
+
+    anvil_assert(m_is_compiled);
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    if (in_n_batch >= static_cast<uint32_t>(m_batches.size() ))
+    {
+        anvil_assert(in_n_batch < static_cast<uint32_t>(m_batches.size() ));
+
+        goto end;
+    }
+
+    batch_ptr = &m_batches.at(in_n_batch);
+
+    for (uint32_t n_pass = batch_ptr->n_first_pass;
+                  n_pass < batch_ptr->n_first_pass + batch_ptr->n_passes;
+                ++n_pass)
+    {
+        const auto&               current_pass    = m_passes.at(n_pass);
+        const RenderPassInstance* render_pass_ptr = (current_pass.n_render_pass != UINT32_MAX) ? &m_render_passes.at(current_pass.n_render_pass)
+                                                                                               : nullptr;
+
+        record_barriers(current_pass.barriers,
+                        in_cmd_buffer_ptr);
+
+        if (render_pass_ptr != nullptr)
+        {
+            if (n_pass == render_pass_ptr->n_first_pass)
+            {
+                in_cmd_buffer_ptr->record_begin_render_pass(static_cast<uint32_t>(render_pass_ptr->clear_values.size() ),
+                                                            render_pass_ptr->clear_values.data(),
+                                                            render_pass_ptr->framebuffer_ptr.get(),
+                                                            render_pass_ptr->render_area,
+                                                            render_pass_ptr->render_pass_ptr.get(),
+                                                            Anvil::SubpassContents::INLINE);
+            }
+            else
+            {
+                /* Barriers of later subpasses are recorded before the render pass */
+                anvil_assert(current_pass.barriers.is_empty() );
+
+                in_cmd_buffer_ptr->record_next_subpass(Anvil::SubpassContents::INLINE);
+            }
+        }
+
+        in_cmd_buffer_ptr->begin_debug_utils_label(current_pass.name.c_str(),
+                                                   label_color);
+        {
+            current_pass.record_function(in_cmd_buffer_ptr,
+                                         n_pass);
+        }
+        in_cmd_buffer_ptr->end_debug_utils_label();
+
+        if (render_pass_ptr != nullptr                                                   &&
+            n_pass          == render_pass_ptr->n_first_pass + render_pass_ptr->n_passes - 1)
+        {
+            in_cmd_buffer_ptr->record_end_render_pass();
+        }
+    }
+
+    record_barriers(batch_ptr->release_barriers,
+                    in_cmd_buffer_ptr);
+
+    result = true;
+end:
+    return result;
+}
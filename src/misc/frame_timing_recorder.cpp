@@ -0,0 +1,469 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/frame_timing_recorder.h"
+#include "misc/swapchain_create_info.h"
+#include "misc/window.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/device.h"
+#include "wrappers/query_pool.h"
+#include "wrappers/swapchain.h"
+
+
+/** Please see header for specification */
+Anvil::FrameTimingRecorder::FrameTimingRecorder(Anvil::Swapchain* in_swapchain_ptr,
+                                                uint32_t          in_n_ring_slots)
+    :m_ring                         (in_n_ring_slots),
+     m_ring_mask                    (in_n_ring_slots - 1),
+     m_read_pos                     (0),
+     m_write_pos                    (0),
+     m_current_acquire_end_time     (0),
+     m_current_acquire_start_time   (0),
+     m_current_first_submit_time    (0),
+     m_current_gpu_end_write_pos    (0),
+     m_current_gpu_start_write_pos  (0),
+     m_current_last_submit_time     (0),
+     m_current_n_submissions        (0),
+     m_current_swapchain_image_index(UINT32_MAX),
+     m_is_display_timing_enabled    (false),
+     m_n_dropped_frames             (0),
+     m_next_frame_id                (1),
+     m_swapchain_ptr                (in_swapchain_ptr),
+     m_timestamp_period             (1.0)
+{
+    for (auto& current_slot : m_ring)
+    {
+        current_slot.is_display_time_pending = false;
+        current_slot.is_gpu_time_pending     = false;
+    }
+}
+
+/** Please see header for specification */
+Anvil::FrameTimingRecorder::~FrameTimingRecorder()
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::FrameTimingRecorderUniquePtr Anvil::FrameTimingRecorder::create(Anvil::Swapchain* in_swapchain_ptr,
+                                                                       uint32_t          in_n_ring_slots,
+                                                                       bool              in_enable_gpu_timestamps)
+{
+    Anvil::FrameTimingRecorderUniquePtr result_ptr(nullptr,
+                                                   std::default_delete<Anvil::FrameTimingRecorder>() );
+
+    anvil_assert(in_swapchain_ptr != nullptr);
+
+    if (in_n_ring_slots < 4                         ||
+        (in_n_ring_slots & (in_n_ring_slots - 1)) != 0)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    result_ptr.reset(
+        new Anvil::FrameTimingRecorder(in_swapchain_ptr,
+                                       in_n_ring_slots)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init(in_enable_gpu_timestamps) )
+        {
+            result_ptr.reset();
+        }
+    }
+
+end:
+    return result_ptr;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::FrameTimingRecorder::drain(uint32_t      in_n_max_frames,
+                                           FrameTimings* out_frames_ptr)
+{
+    const uint64_t n_max_pending_frames = m_ring.size() / 2;
+    bool           past_timings_updated = false;
+    uint64_t       read_pos             = m_read_pos.load (std::memory_order_relaxed);
+    uint32_t       result               = 0;
+    const uint64_t write_pos            = m_write_pos.load(std::memory_order_acquire);
+
+    anvil_assert(in_n_max_frames == 0 || out_frames_ptr != nullptr);
+
+    while (read_pos != write_pos      &&
+           result   <  in_n_max_frames)
+    {
+        const uint32_t n_slot   = static_cast<uint32_t>(read_pos & m_ring_mask);
+        Slot&          slot     = m_ring.at(n_slot);
+        const bool     is_stale = (write_pos - read_pos - 1 > n_max_pending_frames);
+
+        if (slot.is_gpu_time_pending)
+        {
+            bool     all_results_retrieved = false;
+            uint64_t query_results[2];
+
+            if (m_query_pool_ptr->get_query_pool_results(n_slot * 2, /* in_first_query_index */
+                                                         2,          /* in_n_queries         */
+                                                         Anvil::QueryResultFlagBits::NONE,
+                                                         query_results,
+                                                        &all_results_retrieved) &&
+                all_results_retrieved)
+            {
+                slot.timings.gpu_start_time = static_cast<uint64_t>(static_cast<double>(query_results[0]) * m_timestamp_period);
+                slot.timings.gpu_end_time   = static_cast<uint64_t>(static_cast<double>(query_results[1]) * m_timestamp_period);
+                slot.timings.has_gpu_times  = true;
+                slot.is_gpu_time_pending    = false;
+            }
+            else
+            if (is_stale)
+            {
+                slot.is_gpu_time_pending = false;
+            }
+            else
+            {
+                /* Frames are returned in presentation order. Try again during a later drain() call. */
+                break;
+            }
+        }
+
+        if (slot.is_display_time_pending)
+        {
+            const uint32_t present_id = static_cast<uint32_t>(slot.timings.frame_id);
+
+            if (!past_timings_updated)
+            {
+                update_past_presentation_info();
+
+                past_timings_updated = true;
+            }
+
+            for (auto past_timing_iterator  = m_past_presentation_timings.begin();
+                      past_timing_iterator != m_past_presentation_timings.end();
+                    ++past_timing_iterator)
+            {
+                if (past_timing_iterator->presentID == present_id)
+                {
+                    slot.timings.actual_present_time   = past_timing_iterator->actualPresentTime;
+                    slot.timings.earliest_present_time = past_timing_iterator->earliestPresentTime;
+                    slot.timings.has_display_times     = true;
+                    slot.timings.present_margin        = past_timing_iterator->presentMargin;
+                    slot.is_display_time_pending       = false;
+
+                    m_past_presentation_timings.erase(past_timing_iterator);
+                    break;
+                }
+            }
+
+            if (slot.is_display_time_pending)
+            {
+                if (is_stale)
+                {
+                    slot.is_display_time_pending = false;
+                }
+                else
+                {
+                    break;
+                }
+            }
+        }
+
+        out_frames_ptr[result++] = slot.timings;
+
+        m_read_pos.store(++read_pos,
+                         std::memory_order_release);
+    }
+
+    /* Forget about timing info of frames which have already been drained or dropped. */
+    if (m_past_presentation_timings.size() > 0 &&
+        result                             > 0)
+    {
+        const uint32_t last_present_id = static_cast<uint32_t>(out_frames_ptr[result - 1].frame_id);
+
+        for (auto past_timing_iterator  = m_past_presentation_timings.begin();
+                  past_timing_iterator != m_past_presentation_timings.end();)
+        {
+            if (static_cast<int32_t>(past_timing_iterator->presentID - last_present_id) <= 0)
+            {
+                past_timing_iterator = m_past_presentation_timings.erase(past_timing_iterator);
+            }
+            else
+            {
+                ++past_timing_iterator;
+            }
+        }
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::FrameTimingRecorder::get_refresh_cycle_duration(uint64_t* out_duration_ptr) const
+{
+    const Anvil::BaseDevice*     device_ptr = m_swapchain_ptr->get_create_info_ptr()->get_device();
+    VkRefreshCycleDurationGOOGLE duration;
+    bool                         result     = false;
+    VkResult                     result_vk;
+
+    if (!m_is_display_timing_enabled)
+    {
+        goto end;
+    }
+
+    m_swapchain_ptr->lock();
+    {
+        result_vk = device_ptr->get_extension_google_display_timing_entrypoints().vkGetRefreshCycleDurationGOOGLE(device_ptr->get_device_vk(),
+                                                                                                                   m_swapchain_ptr->get_swapchain_vk(),
+                                                                                                                  &duration);
+    }
+    m_swapchain_ptr->unlock();
+
+    if (!is_vk_call_successful(result_vk) )
+    {
+        goto end;
+    }
+
+    *out_duration_ptr = duration.refreshDuration;
+    result            = true;
+
+end:
+    return result;
+}
+
+/** Initializes the query pool used for GPU timestamps, and determines whether display timing should be used.
+ *
+ *  @param in_enable_gpu_timestamps Please see create() for specification.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::FrameTimingRecorder::init(bool in_enable_gpu_timestamps)
+{
+    const Anvil::BaseDevice* device_ptr      = m_swapchain_ptr->get_create_info_ptr()->get_device();
+    const auto&              limits          = device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits;
+    bool                     result          = false;
+    const WindowPlatform     window_platform = m_swapchain_ptr->get_create_info_ptr()->get_window()->get_platform();
+
+    /* Off-screen swapchains are never handed over to a presentation engine */
+    m_is_display_timing_enabled = device_ptr->get_extension_info()->google_display_timing() &&
+                                  window_platform != WINDOW_PLATFORM_DUMMY                  &&
+                                  window_platform != WINDOW_PLATFORM_DUMMY_WITH_PNG_SNAPSHOTS;
+
+    if (in_enable_gpu_timestamps          &&
+        limits.timestamp_compute_and_graphics)
+    {
+        m_query_pool_ptr = Anvil::QueryPool::create_non_ps_query_pool(device_ptr,
+                                                                      VK_QUERY_TYPE_TIMESTAMP,
+                                                                      static_cast<uint32_t>(m_ring.size() ) * 2);
+
+        if (m_query_pool_ptr == nullptr)
+        {
+            anvil_assert(m_query_pool_ptr != nullptr);
+
+            goto end;
+        }
+
+        m_timestamp_period = static_cast<double>(limits.timestamp_period);
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Called by Anvil::Swapchain whenever a swapchain image has been acquired.
+ *
+ *  @param in_acquire_start_time    Time at which the acquire call was made.
+ *  @param in_swapchain_image_index Index of the acquired swapchain image.
+ */
+void Anvil::FrameTimingRecorder::on_image_acquired(uint64_t in_acquire_start_time,
+                                                   uint32_t in_swapchain_image_index)
+{
+    m_current_acquire_start_time.store   (in_acquire_start_time);
+    m_current_acquire_end_time.store     (get_time() );
+    m_current_swapchain_image_index.store(in_swapchain_image_index);
+}
+
+/** Called by Anvil::Queue right after vkQueuePresentKHR() returns. Publishes the frame in progress.
+ *
+ *  @param in_present_result Result of the present operation.
+ */
+void Anvil::FrameTimingRecorder::on_present_finished(Anvil::SwapchainOperationErrorCode in_present_result)
+{
+    const uint64_t read_pos  = m_read_pos.load (std::memory_order_acquire);
+    const uint64_t write_pos = m_write_pos.load(std::memory_order_relaxed);
+
+    m_current_present_timings.present_end_time = get_time();
+    m_current_present_timings.present_result   = in_present_result;
+
+    if (write_pos - read_pos >= m_ring.size() )
+    {
+        /* The app is not draining the ring quickly enough */
+        m_n_dropped_frames.fetch_add(1);
+    }
+    else
+    {
+        Slot& slot = m_ring.at(static_cast<size_t>(write_pos & m_ring_mask) );
+
+        slot.timings                 = m_current_present_timings;
+        slot.is_display_time_pending = m_is_display_timing_enabled                                                   &&
+                                       (in_present_result == Anvil::SwapchainOperationErrorCode::SUCCESS          ||
+                                        in_present_result == Anvil::SwapchainOperationErrorCode::SUBOPTIMAL);
+        slot.is_gpu_time_pending     = (m_current_gpu_start_write_pos.load() == write_pos + 1 &&
+                                        m_current_gpu_end_write_pos.load  () == write_pos + 1);
+
+        m_write_pos.store(write_pos + 1,
+                          std::memory_order_release);
+    }
+}
+
+/** Called by Anvil::Queue right before vkQueuePresentKHR() is issued. Closes the frame in progress.
+ *
+ *  @return Present ID to use for VK_GOOGLE_display_timing.
+ */
+uint32_t Anvil::FrameTimingRecorder::on_present_started()
+{
+    m_current_present_timings = FrameTimings();
+
+    m_current_present_timings.acquire_end_time      = m_current_acquire_end_time.exchange     (0);
+    m_current_present_timings.acquire_start_time    = m_current_acquire_start_time.exchange   (0);
+    m_current_present_timings.first_submit_time     = m_current_first_submit_time.exchange    (0);
+    m_current_present_timings.frame_id              = m_next_frame_id++;
+    m_current_present_timings.last_submit_time      = m_current_last_submit_time.exchange     (0);
+    m_current_present_timings.n_submissions         = m_current_n_submissions.exchange        (0);
+    m_current_present_timings.present_start_time    = get_time();
+    m_current_present_timings.swapchain_image_index = m_current_swapchain_image_index.exchange(UINT32_MAX);
+
+    return static_cast<uint32_t>(m_current_present_timings.frame_id);
+}
+
+/** Called by Anvil::Queue whenever a vkQueueSubmit() call has been issued. */
+void Anvil::FrameTimingRecorder::on_submission_issued()
+{
+    const uint64_t current_time = get_time();
+    uint64_t       expected     = 0;
+
+    m_current_first_submit_time.compare_exchange_strong(expected,
+                                                        current_time);
+    m_current_last_submit_time.store                   (current_time);
+    m_current_n_submissions.fetch_add                  (1);
+}
+
+/** Please see header for specification */
+bool Anvil::FrameTimingRecorder::record_gpu_frame_end(Anvil::CommandBufferBase* in_cmd_buffer_ptr)
+{
+    bool           result    = false;
+    const uint64_t write_pos = m_write_pos.load(std::memory_order_acquire);
+
+    if (m_query_pool_ptr                     == nullptr       ||
+        m_current_gpu_start_write_pos.load() != write_pos + 1)
+    {
+        goto end;
+    }
+
+    result = in_cmd_buffer_ptr->record_write_timestamp(Anvil::PipelineStageFlagBits::BOTTOM_OF_PIPE_BIT,
+                                                       m_query_pool_ptr.get(),
+                                                       static_cast<Anvil::QueryIndex>(write_pos & m_ring_mask) * 2 + 1);
+
+    if (result)
+    {
+        m_current_gpu_end_write_pos.store(write_pos + 1);
+    }
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::FrameTimingRecorder::record_gpu_frame_start(Anvil::CommandBufferBase* in_cmd_buffer_ptr)
+{
+    Anvil::QueryIndex query_index;
+    bool              result      = false;
+    const uint64_t    write_pos   = m_write_pos.load(std::memory_order_acquire);
+
+    if (m_query_pool_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    if (write_pos - m_read_pos.load(std::memory_order_acquire) >= m_ring.size() )
+    {
+        /* The slot is still owned by the consumer. The frame is going to be dropped anyway. */
+        goto end;
+    }
+
+    query_index = static_cast<Anvil::QueryIndex>(write_pos & m_ring_mask) * 2;
+
+    if (!in_cmd_buffer_ptr->record_reset_query_pool(m_query_pool_ptr.get(),
+                                                    query_index,
+                                                    2) ) /* in_query_count */
+    {
+        goto end;
+    }
+
+    result = in_cmd_buffer_ptr->record_write_timestamp(Anvil::PipelineStageFlagBits::TOP_OF_PIPE_BIT,
+                                                       m_query_pool_ptr.get(),
+                                                       query_index);
+
+    if (result)
+    {
+        m_current_gpu_end_write_pos.store  (0);
+        m_current_gpu_start_write_pos.store(write_pos + 1);
+    }
+
+end:
+    return result;
+}
+
+/** Appends timing info of frames which the presentation engine has displayed since the last call to
+ *  m_past_presentation_timings. Only called by the consumer.
+ */
+void Anvil::FrameTimingRecorder::update_past_presentation_info()
+{
+    const Anvil::BaseDevice* device_ptr       = m_swapchain_ptr->get_create_info_ptr()->get_device();
+    const auto&              entrypoints      = device_ptr->get_extension_google_display_timing_entrypoints();
+    uint32_t                 n_timings        = 0;
+    const size_t             n_timings_before = m_past_presentation_timings.size();
+
+    m_swapchain_ptr->lock();
+    {
+        if (is_vk_call_successful(entrypoints.vkGetPastPresentationTimingGOOGLE(device_ptr->get_device_vk(),
+                                                                                m_swapchain_ptr->get_swapchain_vk(),
+                                                                               &n_timings,
+                                                                                nullptr) ) &&
+            n_timings > 0)
+        {
+            m_past_presentation_timings.resize(n_timings_before + n_timings);
+
+            if (!is_vk_call_successful(entrypoints.vkGetPastPresentationTimingGOOGLE(device_ptr->get_device_vk(),
+                                                                                     m_swapchain_ptr->get_swapchain_vk(),
+                                                                                    &n_timings,
+                                                                                    &m_past_presentation_timings.at(n_timings_before) ) ))
+            {
+                n_timings = 0;
+            }
+
+            m_past_presentation_timings.resize(n_timings_before + n_timings);
+        }
+    }
+    m_swapchain_ptr->unlock();
+}
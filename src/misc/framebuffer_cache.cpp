@@ -0,0 +1,337 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/framebuffer_cache.h"
+#include "misc/framebuffer_create_info.h"
+#include "misc/render_pass_create_info.h"
+#include "wrappers/framebuffer.h"
+#include "wrappers/render_pass.h"
+#include <algorithm>
+
+
+/** Please see header for specification */
+Anvil::FramebufferCache::Entry::Entry()
+    :framebuffer_ptr(nullptr,
+                     std::default_delete<Anvil::Framebuffer>() ),
+     height         (0),
+     n_layers       (0),
+     width          (0)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::FramebufferCache::FramebufferCache(const Anvil::BaseDevice* in_device_ptr)
+    :MTSafetySupportProvider(true),
+     m_device_ptr           (in_device_ptr),
+     m_n_cache_hits         (0),
+     m_n_cache_misses       (0)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::FramebufferCache::~FramebufferCache()
+{
+    clear();
+}
+
+/** Please see header for specification */
+void Anvil::FramebufferCache::clear()
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+
+    m_entries.clear();
+}
+
+/** Please see header for specification */
+Anvil::FramebufferCacheUniquePtr Anvil::FramebufferCache::create(const Anvil::BaseDevice* in_device_ptr)
+{
+    Anvil::FramebufferCacheUniquePtr result_ptr(nullptr,
+                                                std::default_delete<Anvil::FramebufferCache>() );
+
+    anvil_assert(in_device_ptr != nullptr);
+
+    result_ptr.reset(
+        new Anvil::FramebufferCache(in_device_ptr)
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+Anvil::Framebuffer* Anvil::FramebufferCache::get_framebuffer(const Anvil::RenderPass* in_render_pass_ptr,
+                                                             uint32_t                 in_n_attachments,
+                                                             Anvil::ImageView* const* in_attachment_ptrs,
+                                                             uint32_t                 in_width,
+                                                             uint32_t                 in_height,
+                                                             uint32_t                 in_n_layers)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+    Anvil::FramebufferCreateInfoUniquePtr      create_info_ptr;
+    uint64_t                                   hash;
+    std::vector<uint64_t>                      hash_words;
+    EntryUniquePtr                             new_entry_ptr;
+    std::vector<AttachmentSignature>           render_pass_signature;
+    Anvil::Framebuffer*                        result_ptr = nullptr;
+
+    if ( in_render_pass_ptr == nullptr                              ||
+        (in_n_attachments   >  0 && in_attachment_ptrs == nullptr) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (!get_render_pass_signature(in_render_pass_ptr,
+                                  &render_pass_signature) )
+    {
+        goto end;
+    }
+
+    if (render_pass_signature.size() != in_n_attachments)
+    {
+        anvil_assert(render_pass_signature.size() == in_n_attachments);
+
+        goto end;
+    }
+
+    /* Look for an existing framebuffer first */
+    hash_words.reserve(3 + in_n_attachments * 3);
+
+    hash_words.push_back(in_width);
+    hash_words.push_back(in_height);
+    hash_words.push_back(in_n_layers);
+
+    for (uint32_t n_attachment = 0;
+                  n_attachment < in_n_attachments;
+                ++n_attachment)
+    {
+        hash_words.push_back(reinterpret_cast<uint64_t>(in_attachment_ptrs[n_attachment]) );
+        hash_words.push_back(static_cast<uint64_t>     (render_pass_signature.at(n_attachment).format) );
+        hash_words.push_back(static_cast<uint64_t>     (render_pass_signature.at(n_attachment).sample_count) );
+    }
+
+    hash = Anvil::Utils::hash64(&hash_words.at(0),
+                                hash_words.size() * sizeof(uint64_t) );
+
+    {
+        auto& bucket = m_entries[hash];
+
+        for (const auto& current_entry_ptr : bucket)
+        {
+            if (current_entry_ptr->width                 == in_width              &&
+                current_entry_ptr->height                == in_height             &&
+                current_entry_ptr->n_layers              == in_n_layers           &&
+                current_entry_ptr->render_pass_signature == render_pass_signature &&
+                std::equal(current_entry_ptr->attachment_ptrs.begin(),
+                           current_entry_ptr->attachment_ptrs.end  (),
+                           in_attachment_ptrs) )
+            {
+                result_ptr = current_entry_ptr->framebuffer_ptr.get();
+
+                ++m_n_cache_hits;
+                goto end;
+            }
+        }
+
+        /* No luck. Create a new framebuffer. */
+        create_info_ptr = Anvil::FramebufferCreateInfo::create(m_device_ptr,
+                                                               in_width,
+                                                               in_height,
+                                                               in_n_layers);
+
+        if (create_info_ptr == nullptr)
+        {
+            anvil_assert(create_info_ptr != nullptr);
+
+            goto end;
+        }
+
+        for (uint32_t n_attachment = 0;
+                      n_attachment < in_n_attachments;
+                    ++n_attachment)
+        {
+            if (!create_info_ptr->add_attachment(in_attachment_ptrs[n_attachment],
+                                                 nullptr) ) /* out_opt_attachment_id_ptr */
+            {
+                anvil_assert_fail();
+
+                goto end;
+            }
+        }
+
+        new_entry_ptr.reset(new Entry() );
+
+        new_entry_ptr->attachment_ptrs.assign(in_attachment_ptrs,
+                                              in_attachment_ptrs + in_n_attachments);
+
+        new_entry_ptr->framebuffer_ptr       = Anvil::Framebuffer::create(std::move(create_info_ptr) );
+        new_entry_ptr->height                = in_height;
+        new_entry_ptr->n_layers              = in_n_layers;
+        new_entry_ptr->render_pass_signature = std::move(render_pass_signature);
+        new_entry_ptr->width                 = in_width;
+
+        if (new_entry_ptr->framebuffer_ptr == nullptr)
+        {
+            anvil_assert(new_entry_ptr->framebuffer_ptr != nullptr);
+
+            goto end;
+        }
+
+        result_ptr = new_entry_ptr->framebuffer_ptr.get();
+
+        bucket.push_back(std::move(new_entry_ptr) );
+
+        ++m_n_cache_misses;
+    }
+
+end:
+    return result_ptr;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::FramebufferCache::get_n_cached_framebuffers() const
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+    uint32_t                                   result    (0);
+
+    for (const auto& current_bucket : m_entries)
+    {
+        result += static_cast<uint32_t>(current_bucket.second.size() );
+    }
+
+    return result;
+}
+
+/** Builds a compatibility signature for the specified render pass.
+ *
+ *  @param in_render_pass_ptr Render pass to use. Must not be null.
+ *  @param out_signature_ptr  Deref will be set to a vector holding format & sample count of each attachment.
+ *                            Must not be null.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::FramebufferCache::get_render_pass_signature(const Anvil::RenderPass*          in_render_pass_ptr,
+                                                        std::vector<AttachmentSignature>* out_signature_ptr) const
+{
+    const Anvil::RenderPassCreateInfo* create_info_ptr = in_render_pass_ptr->get_render_pass_create_info();
+    const uint32_t                     n_attachments   = create_info_ptr->get_n_attachments();
+    bool                               result          = false;
+
+    out_signature_ptr->clear  ();
+    out_signature_ptr->reserve(n_attachments);
+
+    for (uint32_t n_attachment = 0;
+                  n_attachment < n_attachments;
+                ++n_attachment)
+    {
+        AttachmentSignature   signature;
+        Anvil::AttachmentType type      = Anvil::AttachmentType::UNKNOWN;
+
+        if (!create_info_ptr->get_attachment_type(n_attachment,
+                                                 &type) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        if (type == Anvil::AttachmentType::COLOR)
+        {
+            result = create_info_ptr->get_color_attachment_properties(n_attachment,
+                                                                     &signature.format,
+                                                                     &signature.sample_count);
+        }
+        else
+        if (type == Anvil::AttachmentType::DEPTH_STENCIL)
+        {
+            result = create_info_ptr->get_depth_stencil_attachment_properties(n_attachment,
+                                                                             &signature.format,
+                                                                             &signature.sample_count);
+        }
+        else
+        {
+            result = false;
+        }
+
+        if (!result)
+        {
+            anvil_assert(result);
+
+            goto end;
+        }
+
+        out_signature_ptr->push_back(signature);
+    }
+
+    result = true;
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::FramebufferCache::release_framebuffers_using(const Anvil::ImageView* in_image_view_ptr)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+    uint32_t                                   result    (0);
+
+    for (auto bucket_iterator  = m_entries.begin();
+              bucket_iterator != m_entries.end();
+             )
+    {
+        auto& bucket = bucket_iterator->second;
+
+        for (auto entry_iterator  = bucket.begin();
+                  entry_iterator != bucket.end();
+                 )
+        {
+            const auto& attachment_ptrs = (*entry_iterator)->attachment_ptrs;
+
+            if (std::find(attachment_ptrs.begin(),
+                          attachment_ptrs.end  (),
+                          in_image_view_ptr) != attachment_ptrs.end() )
+            {
+                entry_iterator = bucket.erase(entry_iterator);
+
+                ++result;
+            }
+            else
+            {
+                ++entry_iterator;
+            }
+        }
+
+        if (bucket.empty() )
+        {
+            bucket_iterator = m_entries.erase(bucket_iterator);
+        }
+        else
+        {
+            ++bucket_iterator;
+        }
+    }
+
+    return result;
+}
@@ -21,15 +21,38 @@
 //
 #include "misc/framebuffer_create_info.h"
 #include "misc/image_view_create_info.h"
+#include "wrappers/device.h"
 #include "wrappers/image.h"
 #include "wrappers/image_view.h"
 
 Anvil::FramebufferCreateInfo::FramebufferAttachment::FramebufferAttachment(ImageView* in_image_view_ptr)
-    :image_view_ptr(in_image_view_ptr)
+    :image_view_ptr(in_image_view_ptr),
+     height        (0),
+     n_layers      (0),
+     width         (0)
 {
     anvil_assert(in_image_view_ptr != nullptr);
 }
 
+Anvil::FramebufferCreateInfo::FramebufferAttachment::FramebufferAttachment(const Anvil::ImageCreateFlags& in_image_create_flags,
+                                                                           const Anvil::ImageUsageFlags&  in_image_usage_flags,
+                                                                           const uint32_t&                in_width,
+                                                                           const uint32_t&                in_height,
+                                                                           const uint32_t&                in_n_layers,
+                                                                           const uint32_t&                in_n_view_formats,
+                                                                           const Anvil::Format*           in_view_formats_ptr)
+    :image_view_ptr    (nullptr),
+     image_create_flags(in_image_create_flags),
+     image_usage_flags (in_image_usage_flags),
+     height            (in_height),
+     n_layers          (in_n_layers),
+     view_formats      (in_view_formats_ptr,
+                        in_view_formats_ptr + in_n_view_formats),
+     width             (in_width)
+{
+    /* Stub */
+}
+
 Anvil::FramebufferCreateInfo::FramebufferAttachment::~FramebufferAttachment()
 {
     /* Stub */
@@ -37,12 +60,24 @@ Anvil::FramebufferCreateInfo::FramebufferAttachment::~FramebufferAttachment()
 
 Anvil::FramebufferCreateInfo::FramebufferAttachment::FramebufferAttachment(const FramebufferAttachment& in)
 {
-    image_view_ptr = in.image_view_ptr;
+    image_create_flags = in.image_create_flags;
+    image_usage_flags  = in.image_usage_flags;
+    image_view_ptr     = in.image_view_ptr;
+    height             = in.height;
+    n_layers           = in.n_layers;
+    view_formats       = in.view_formats;
+    width              = in.width;
 }
 
 Anvil::FramebufferCreateInfo::FramebufferAttachment& Anvil::FramebufferCreateInfo::FramebufferAttachment::operator=(const Anvil::FramebufferCreateInfo::FramebufferAttachment& in)
 {
-    image_view_ptr = in.image_view_ptr;
+    image_create_flags = in.image_create_flags;
+    image_usage_flags  = in.image_usage_flags;
+    image_view_ptr     = in.image_view_ptr;
+    height             = in.height;
+    n_layers           = in.n_layers;
+    view_formats       = in.view_formats;
+    width              = in.width;
 
     return *this;
 }
@@ -52,11 +87,12 @@ Anvil::FramebufferCreateInfo::FramebufferCreateInfo(const Anvil::BaseDevice* in_
                                                     const uint32_t&          in_height,
                                                     const uint32_t&          in_n_layers,
                                                     MTSafety                 in_mt_safety)
-    :m_device_ptr(in_device_ptr),
-     m_height    (in_height),
-     m_mt_safety (in_mt_safety),
-     m_n_layers  (in_n_layers),
-     m_width     (in_width)
+    :m_device_ptr  (in_device_ptr),
+     m_height      (in_height),
+     m_is_imageless(false),
+     m_mt_safety   (in_mt_safety),
+     m_n_layers    (in_n_layers),
+     m_width       (in_width)
 {
     anvil_assert(in_device_ptr != nullptr);
     anvil_assert(in_height     >= 1);
@@ -74,6 +110,14 @@ bool Anvil::FramebufferCreateInfo::add_attachment(ImageView*               in_im
     /* Sanity checks: Input image view must not be nullptr */
     anvil_assert(in_image_view_ptr != nullptr);
 
+    /* Sanity checks: Imageless framebuffers can only hold imageless attachments */
+    if (m_is_imageless)
+    {
+        anvil_assert(!m_is_imageless);
+
+        goto end;
+    }
+
     /* Sanity checks: make sure the image views have the same, or larger size than the framebuffer's. */
     parent_image_ptr = in_image_view_ptr->get_create_info_ptr()->get_parent_image();
 
@@ -114,6 +158,78 @@ end:
     return result;
 }
 
+bool Anvil::FramebufferCreateInfo::add_imageless_attachment(const Anvil::ImageCreateFlags& in_image_create_flags,
+                                                            const Anvil::ImageUsageFlags&  in_image_usage_flags,
+                                                            const uint32_t&                in_width,
+                                                            const uint32_t&                in_height,
+                                                            const uint32_t&                in_n_layers,
+                                                            const uint32_t&                in_n_view_formats,
+                                                            const Anvil::Format*           in_view_formats_ptr,
+                                                            FramebufferAttachmentID*       out_opt_attachment_id_ptr)
+{
+    bool result = false;
+
+    /* Sanity checks */
+    if (!m_device_ptr->get_extension_info()->khr_imageless_framebuffer() )
+    {
+        anvil_assert(m_device_ptr->get_extension_info()->khr_imageless_framebuffer() );
+
+        goto end;
+    }
+
+    if (!m_is_imageless        &&
+        !m_attachments.empty() )
+    {
+        /* Cannot mix imageless attachments with image view-based ones */
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (in_n_view_formats   == 0       ||
+        in_view_formats_ptr == nullptr)
+    {
+        anvil_assert(in_n_view_formats   >  0);
+        anvil_assert(in_view_formats_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (in_width    < m_width    ||
+        in_height   < m_height   ||
+        in_n_layers < m_n_layers)
+    {
+        /* Attachment size is wrong */
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    /* Store a new descriptor for the attachment. */
+    if (out_opt_attachment_id_ptr != nullptr)
+    {
+        *out_opt_attachment_id_ptr = static_cast<FramebufferAttachmentID>(m_attachments.size() );
+    }
+
+    m_attachments.push_back(
+        FramebufferAttachment(in_image_create_flags,
+                              in_image_usage_flags,
+                              in_width,
+                              in_height,
+                              in_n_layers,
+                              in_n_view_formats,
+                              in_view_formats_ptr)
+    );
+
+    m_is_imageless = true;
+
+    /* All done */
+    result = true;
+
+end:
+    return result;
+}
+
 Anvil::FramebufferCreateInfoUniquePtr Anvil::FramebufferCreateInfo::create(const Anvil::BaseDevice* in_device_ptr,
                                                                            const uint32_t&          in_width,
                                                                            const uint32_t&          in_height,
@@ -169,6 +285,61 @@ bool Anvil::FramebufferCreateInfo::get_attachment_id_for_image_view(ImageView*
     return result;
 }
 
+bool Anvil::FramebufferCreateInfo::get_imageless_attachment_properties(uint32_t                          in_attachment_index,
+                                                                       Anvil::ImageCreateFlags*          out_opt_image_create_flags_ptr,
+                                                                       Anvil::ImageUsageFlags*           out_opt_image_usage_flags_ptr,
+                                                                       uint32_t*                         out_opt_width_ptr,
+                                                                       uint32_t*                         out_opt_height_ptr,
+                                                                       uint32_t*                         out_opt_n_layers_ptr,
+                                                                       const std::vector<Anvil::Format>** out_opt_view_formats_ptr_ptr) const
+{
+    const FramebufferAttachment* attachment_ptr = nullptr;
+    bool                         result         = false;
+
+    if (!m_is_imageless                             ||
+        m_attachments.size() <= in_attachment_index)
+    {
+        goto end;
+    }
+
+    attachment_ptr = &m_attachments.at(in_attachment_index);
+
+    if (out_opt_image_create_flags_ptr != nullptr)
+    {
+        *out_opt_image_create_flags_ptr = attachment_ptr->image_create_flags;
+    }
+
+    if (out_opt_image_usage_flags_ptr != nullptr)
+    {
+        *out_opt_image_usage_flags_ptr = attachment_ptr->image_usage_flags;
+    }
+
+    if (out_opt_width_ptr != nullptr)
+    {
+        *out_opt_width_ptr = attachment_ptr->width;
+    }
+
+    if (out_opt_height_ptr != nullptr)
+    {
+        *out_opt_height_ptr = attachment_ptr->height;
+    }
+
+    if (out_opt_n_layers_ptr != nullptr)
+    {
+        *out_opt_n_layers_ptr = attachment_ptr->n_layers;
+    }
+
+    if (out_opt_view_formats_ptr_ptr != nullptr)
+    {
+        *out_opt_view_formats_ptr_ptr = &attachment_ptr->view_formats;
+    }
+
+    result = true;
+
+end:
+    return result;
+}
+
 void Anvil::FramebufferCreateInfo::get_size(uint32_t* out_framebuffer_width_ptr,
                                             uint32_t* out_framebuffer_height_ptr,
                                             uint32_t* out_framebuffer_depth_ptr) const
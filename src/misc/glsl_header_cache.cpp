@@ -0,0 +1,212 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#include "misc/debug.h"
+#include "misc/glsl_header_cache.h"
+#include "misc/io.h"
+
+
+/** Please see header for specification */
+Anvil::GLSLHeaderCache::GLSLHeaderCache(const std::vector<std::string>& in_include_directories)
+    :m_include_directories(in_include_directories)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::GLSLHeaderCache::~GLSLHeaderCache()
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+bool Anvil::GLSLHeaderCache::add_header(const std::string& in_name,
+                                        const std::string& in_contents)
+{
+    std::unique_lock<std::mutex> lock  (m_mutex);
+    bool                         result(false);
+
+    if (m_virtual_headers.find(in_name) != m_virtual_headers.end() )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    m_virtual_headers[in_name] = std::make_shared<const std::string>(in_contents);
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::GLSLHeaderCacheUniquePtr Anvil::GLSLHeaderCache::create(const std::vector<std::string>& in_include_directories)
+{
+    Anvil::GLSLHeaderCacheUniquePtr result_ptr(nullptr,
+                                               std::default_delete<Anvil::GLSLHeaderCache>() );
+
+    result_ptr.reset(
+        new Anvil::GLSLHeaderCache(in_include_directories)
+    );
+
+    return result_ptr;
+}
+
+/** Returns contents of the specified file, loading it if it has not been loaded yet.
+ *
+ *  The file is read with the lock dropped, so that generators baked in parallel do not wait on each other's I/O.
+ *  If two threads happen to load the same file at the same time, the contents loaded first are used.
+ *
+ *  @param in_filename      Name of the file.
+ *  @param out_contents_ptr Deref will be set to contents of the file. Must not be null.
+ *
+ *  @return true if successful, false if the file could not be read.
+ */
+bool Anvil::GLSLHeaderCache::get_file_header(const std::string&                  in_filename,
+                                             std::shared_ptr<const std::string>* out_contents_ptr)
+{
+    char* file_data_ptr = nullptr;
+    bool  result        = false;
+
+    {
+        std::unique_lock<std::mutex> lock        (m_mutex);
+        auto                         header_iterator = m_file_headers.find(in_filename);
+
+        if (header_iterator != m_file_headers.end() )
+        {
+            *out_contents_ptr = header_iterator->second;
+
+            result = true;
+            goto end;
+        }
+    }
+
+    if (!Anvil::IO::read_file(in_filename,
+                              true, /* in_is_text_file */
+                             &file_data_ptr,
+                              nullptr) ) /* out_opt_size_ptr */
+    {
+        goto end;
+    }
+
+    {
+        std::shared_ptr<const std::string> contents_ptr = std::make_shared<const std::string>(file_data_ptr);
+        std::unique_lock<std::mutex>       lock        (m_mutex);
+
+        delete [] file_data_ptr;
+
+        *out_contents_ptr = m_file_headers.insert(
+            std::make_pair(in_filename,
+                           contents_ptr)
+        ).first->second;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::GLSLHeaderCache::get_header(const std::string&                  in_header_name,
+                                        const std::string&                  in_includer_name,
+                                        bool                                in_is_local,
+                                        std::string*                        out_resolved_name_ptr,
+                                        std::shared_ptr<const std::string>* out_contents_ptr)
+{
+    bool result = false;
+
+    anvil_assert(out_resolved_name_ptr != nullptr);
+    anvil_assert(out_contents_ptr      != nullptr);
+
+    {
+        std::unique_lock<std::mutex> lock           (m_mutex);
+        auto                         header_iterator = m_virtual_headers.find(in_header_name);
+
+        if (header_iterator != m_virtual_headers.end() )
+        {
+            *out_contents_ptr      = header_iterator->second;
+            *out_resolved_name_ptr = in_header_name;
+
+            result = true;
+            goto end;
+        }
+    }
+
+    if (in_is_local)
+    {
+        /* Quoted includes are first looked up relative to the directory of the including file. */
+        const size_t separator_index = in_includer_name.find_last_of("/\\");
+        std::string  filename        = (separator_index != std::string::npos) ? in_includer_name.substr(0, separator_index + 1) + in_header_name
+                                                                               : in_header_name;
+
+        if (get_file_header(filename,
+                            out_contents_ptr) )
+        {
+            *out_resolved_name_ptr = filename;
+
+            result = true;
+            goto end;
+        }
+    }
+
+    for (const auto& current_include_directory : m_include_directories)
+    {
+        std::string filename = current_include_directory;
+
+        if (filename.size()  > 0    &&
+            filename.back() != '/'  &&
+            filename.back() != '\\')
+        {
+            filename += "/";
+        }
+
+        filename += in_header_name;
+
+        if (get_file_header(filename,
+                            out_contents_ptr) )
+        {
+            *out_resolved_name_ptr = filename;
+
+            result = true;
+            goto end;
+        }
+    }
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::GLSLHeaderCache::invalidate(const std::string& in_resolved_name)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_file_headers.erase(in_resolved_name);
+}
+
+/** Please see header for specification */
+void Anvil::GLSLHeaderCache::invalidate_all()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_file_headers.clear();
+}
@@ -20,13 +20,22 @@
 // THE SOFTWARE.
 //
 
+#include "misc/glsl_header_cache.h"
 #include "misc/glsl_to_spirv.h"
 #include "misc/io.h"
 #include "misc/object_tracker.h"
+#include "misc/task_scheduler.h"
+#include "misc/time.h"
+#include "misc/tracing.h"
 #include "wrappers/device.h"
 #include "wrappers/shader_module.h"
 #include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
 #include <sstream>
+#include <thread>
 
 #ifndef _WIN32
     #include <limits.h>
@@ -57,6 +66,38 @@
     #endif
 #endif
 
+#ifdef ANVIL_LINK_WITH_SPIRV_TOOLS
+    #include "spirv-tools/libspirv.h"
+    #include "spirv-tools/optimizer.hpp"
+#endif
+
+/* "ASPV" */
+#define SPIRV_CACHE_FILE_MAGIC   (0x56505341u)
+#define SPIRV_CACHE_FILE_VERSION (1)
+
+/* SPIR-V definitions used by the built-in optimization passes */
+#define SPIRV_DECORATION_SPEC_ID         (1)
+#define SPIRV_N_HEADER_WORDS             (5)
+#define SPIRV_OP_CONSTANT                (43)
+#define SPIRV_OP_CONSTANT_COMPOSITE      (44)
+#define SPIRV_OP_CONSTANT_FALSE          (42)
+#define SPIRV_OP_CONSTANT_TRUE           (41)
+#define SPIRV_OP_DECORATE                (71)
+#define SPIRV_OP_EXT_INST_IMPORT         (11)
+#define SPIRV_OP_LINE                    (8)
+#define SPIRV_OP_MEMBER_NAME             (6)
+#define SPIRV_OP_MODULE_PROCESSED        (330)
+#define SPIRV_OP_NAME                    (5)
+#define SPIRV_OP_NO_LINE                 (317)
+#define SPIRV_OP_SOURCE                  (3)
+#define SPIRV_OP_SOURCE_CONTINUED        (2)
+#define SPIRV_OP_SOURCE_EXTENSION        (4)
+#define SPIRV_OP_SPEC_CONSTANT           (50)
+#define SPIRV_OP_SPEC_CONSTANT_COMPOSITE (51)
+#define SPIRV_OP_SPEC_CONSTANT_FALSE     (49)
+#define SPIRV_OP_SPEC_CONSTANT_TRUE      (48)
+#define SPIRV_OP_STRING                  (7)
+
 #ifndef ANVIL_LINK_WITH_GLSLANG
     #define SPIRV_FILE_NAME_LEN 100
 #else
@@ -241,11 +282,482 @@
             m_resources_ptr->maxTransformFeedbackBuffers               = 0; /* not supported in core Vulkan */
             m_resources_ptr->maxTransformFeedbackInterleavedComponents = 0; /* not supported in core Vulkan */
         }
+
+        if (in_device_ptr->get_extension_info()->nv_mesh_shader() )
+        {
+            /* Minimum values guaranteed by VK_NV_mesh_shader */
+            m_resources_ptr->maxMeshOutputVerticesNV   = 256;
+            m_resources_ptr->maxMeshOutputPrimitivesNV = 256;
+            m_resources_ptr->maxMeshWorkGroupSizeX_NV  = 32;
+            m_resources_ptr->maxMeshWorkGroupSizeY_NV  = 1;
+            m_resources_ptr->maxMeshWorkGroupSizeZ_NV  = 1;
+            m_resources_ptr->maxTaskWorkGroupSizeX_NV  = 32;
+            m_resources_ptr->maxTaskWorkGroupSizeY_NV  = 1;
+            m_resources_ptr->maxTaskWorkGroupSizeZ_NV  = 1;
+            m_resources_ptr->maxMeshViewCountNV        = 1;
+        }
     }
 
     static const GLSLangGlobalInitializer glslang_helper;
 #endif
 
+/** Turns all specialization constants defined by a SPIR-V blob into regular constants, and removes the SpecId
+ *  decorations. OpSpecConstantOp instructions are left intact, as they remain valid once their operands are
+ *  frozen.
+ *
+ *  @param in_values       Maps specialization constant IDs to values to use for 32-bit and boolean constants.
+ *                         Constants which are not specified in the map keep their default values.
+ *  @param inout_words_ptr SPIR-V blob to update. Must not be null.
+ **/
+static void freeze_specialization_constants(const std::map<uint32_t, uint32_t>& in_values,
+                                            std::vector<uint32_t>*              inout_words_ptr)
+{
+    std::map<uint32_t, uint32_t> result_id_to_spec_id_map;
+    std::vector<uint32_t>        result_words;
+    auto&                        words = *inout_words_ptr;
+
+    for (uint32_t n_word = SPIRV_N_HEADER_WORDS;
+                  n_word < static_cast<uint32_t>(words.size() ) && (words.at(n_word) >> 16) != 0;
+                  n_word += words.at(n_word) >> 16)
+    {
+        if ((words.at(n_word) & 0xFFFF) == SPIRV_OP_DECORATE        &&
+            (words.at(n_word) >> 16)    >= 4                        &&
+            words.at(n_word + 2)        == SPIRV_DECORATION_SPEC_ID)
+        {
+            result_id_to_spec_id_map[words.at(n_word + 1)] = words.at(n_word + 3);
+        }
+    }
+
+    result_words.reserve(words.size() );
+    result_words.insert (result_words.end(),
+                         words.begin(),
+                         words.begin() + SPIRV_N_HEADER_WORDS);
+
+    for (uint32_t n_word = SPIRV_N_HEADER_WORDS;
+                  n_word < static_cast<uint32_t>(words.size() ) && (words.at(n_word) >> 16) != 0;
+                  n_word += words.at(n_word) >> 16)
+    {
+        const uint32_t n_inst_words     = words.at(n_word) >> 16;
+        const size_t   n_result_word    = result_words.size();
+        uint32_t       opcode           = words.at(n_word) & 0xFFFF;
+        const auto     spec_id_iterator = (n_inst_words >= 3) ? result_id_to_spec_id_map.find(words.at(n_word + 2) )
+                                                              : result_id_to_spec_id_map.end ();
+        const auto     value_iterator   = (spec_id_iterator != result_id_to_spec_id_map.end() ) ? in_values.find(spec_id_iterator->second)
+                                                                                                : in_values.end ();
+
+        if (opcode               == SPIRV_OP_DECORATE        &&
+            n_inst_words         >= 4                        &&
+            words.at(n_word + 2) == SPIRV_DECORATION_SPEC_ID)
+        {
+            continue;
+        }
+
+        result_words.insert(result_words.end(),
+                            words.begin() + n_word,
+                            words.begin() + n_word + n_inst_words);
+
+        switch (opcode)
+        {
+            case SPIRV_OP_SPEC_CONSTANT:
+            {
+                opcode = SPIRV_OP_CONSTANT;
+
+                if (n_inst_words   == 4 &&
+                    value_iterator != in_values.end() )
+                {
+                    result_words.at(n_result_word + 3) = value_iterator->second;
+                }
+
+                break;
+            }
+
+            case SPIRV_OP_SPEC_CONSTANT_FALSE:
+            case SPIRV_OP_SPEC_CONSTANT_TRUE:
+            {
+                const bool value = (value_iterator != in_values.end() ) ? (value_iterator->second != 0)
+                                                                        : (opcode == SPIRV_OP_SPEC_CONSTANT_TRUE);
+
+                opcode = (value) ? SPIRV_OP_CONSTANT_TRUE
+                                 : SPIRV_OP_CONSTANT_FALSE;
+
+                break;
+            }
+
+            case SPIRV_OP_SPEC_CONSTANT_COMPOSITE:
+            {
+                opcode = SPIRV_OP_CONSTANT_COMPOSITE;
+
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
+        }
+
+        result_words.at(n_result_word) = (n_inst_words << 16) | opcode;
+    }
+
+    words = std::move(result_words);
+}
+
+/** Removes debug instructions from a SPIR-V blob.
+ *
+ *  OpString instructions are preserved if the blob imports a non-semantic instruction set, as these may
+ *  refer to them.
+ *
+ *  @param inout_words_ptr SPIR-V blob to update. Must not be null.
+ **/
+static void strip_debug_info(std::vector<uint32_t>* inout_words_ptr)
+{
+    bool                  preserve_strings = false;
+    std::vector<uint32_t> result_words;
+    auto&                 words            = *inout_words_ptr;
+
+    for (uint32_t n_word = SPIRV_N_HEADER_WORDS;
+                  n_word < static_cast<uint32_t>(words.size() ) && (words.at(n_word) >> 16) != 0;
+                  n_word += words.at(n_word) >> 16)
+    {
+        const uint32_t n_inst_words = words.at(n_word) >> 16;
+
+        if ((words.at(n_word) & 0xFFFF) == SPIRV_OP_EXT_INST_IMPORT &&
+            n_inst_words                >= 3)
+        {
+            const std::string name(reinterpret_cast<const char*>(&words.at(n_word + 2) ),
+                                   strnlen(reinterpret_cast<const char*>(&words.at(n_word + 2) ),
+                                           (n_inst_words - 2) * sizeof(uint32_t) ));
+
+            if (name.compare(0,  /* pos */
+                             12, /* len */
+                             "NonSemantic.") == 0)
+            {
+                preserve_strings = true;
+            }
+        }
+    }
+
+    result_words.reserve(words.size() );
+    result_words.insert (result_words.end(),
+                         words.begin(),
+                         words.begin() + SPIRV_N_HEADER_WORDS);
+
+    for (uint32_t n_word = SPIRV_N_HEADER_WORDS;
+                  n_word < static_cast<uint32_t>(words.size() ) && (words.at(n_word) >> 16) != 0;
+                  n_word += words.at(n_word) >> 16)
+    {
+        const uint32_t n_inst_words = words.at(n_word) >> 16;
+
+        switch (words.at(n_word) & 0xFFFF)
+        {
+            case SPIRV_OP_LINE:
+            case SPIRV_OP_MEMBER_NAME:
+            case SPIRV_OP_MODULE_PROCESSED:
+            case SPIRV_OP_NAME:
+            case SPIRV_OP_NO_LINE:
+            case SPIRV_OP_SOURCE:
+            case SPIRV_OP_SOURCE_CONTINUED:
+            case SPIRV_OP_SOURCE_EXTENSION:
+            {
+                continue;
+            }
+
+            case SPIRV_OP_STRING:
+            {
+                if (!preserve_strings)
+                {
+                    continue;
+                }
+
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
+        }
+
+        result_words.insert(result_words.end(),
+                            words.begin() + n_word,
+                            words.begin() + n_word + n_inst_words);
+    }
+
+    words = std::move(result_words);
+}
+
+namespace
+{
+    /** Trie built over placeholder names, used to substitute all placeholders in a single pass over the source code. */
+    class PlaceholderTrie
+    {
+    public:
+        explicit PlaceholderTrie(const std::vector<std::pair<std::string, std::string> >& in_placeholder_values)
+        {
+            m_nodes.push_back   (Node() );
+            m_root_children.fill(UINT32_MAX);
+
+            for (uint32_t n_placeholder = 0;
+                          n_placeholder < static_cast<uint32_t>(in_placeholder_values.size() );
+                        ++n_placeholder)
+            {
+                const auto& current_name = in_placeholder_values.at(n_placeholder).first;
+                uint32_t    n_node       = 0;
+
+                if (current_name.empty() )
+                {
+                    continue;
+                }
+
+                for (const auto& current_char : current_name)
+                {
+                    n_node = get_or_create_child(n_node,
+                                                 current_char);
+                }
+
+                /* If the same name has been specified more than once, the first value wins, as was the case
+                 * when placeholders were substituted one after another. */
+                if (m_nodes.at(n_node).n_value == UINT32_MAX)
+                {
+                    m_nodes.at(n_node).n_value = n_placeholder;
+                }
+            }
+        }
+
+        /** Finds the longest placeholder name which starts at @param in_begin_ptr.
+         *
+         *  @return Index of the corresponding placeholder value, or UINT32_MAX if no placeholder name matches.
+         *          If a match is found, *out_length_ptr is set to the name's length.
+         **/
+        uint32_t match(const char* in_begin_ptr,
+                       const char* in_end_ptr,
+                       size_t*     out_length_ptr) const
+        {
+            uint32_t n_node = 0;
+            uint32_t result = UINT32_MAX;
+
+            for (const char* current_char_ptr  = in_begin_ptr;
+                             current_char_ptr != in_end_ptr;
+                           ++current_char_ptr)
+            {
+                n_node = get_child(n_node,
+                                   *current_char_ptr);
+
+                if (n_node == UINT32_MAX)
+                {
+                    break;
+                }
+
+                if (m_nodes[n_node].n_value != UINT32_MAX)
+                {
+                    result          = m_nodes[n_node].n_value;
+                    *out_length_ptr = static_cast<size_t>(current_char_ptr - in_begin_ptr + 1);
+                }
+            }
+
+            return result;
+        }
+
+    private:
+        typedef struct Node
+        {
+            /* Most nodes below the root have a single child, so a short list is scanned faster than a table is filled. */
+            std::vector<std::pair<char, uint32_t> > children;
+            uint32_t                                n_value;
+
+            Node()
+                :n_value(UINT32_MAX)
+            {
+                /* Stub */
+            }
+        } Node;
+
+        uint32_t get_child(uint32_t in_n_node,
+                           char     in_char) const
+        {
+            uint32_t result = UINT32_MAX;
+
+            if (in_n_node == 0)
+            {
+                result = m_root_children[static_cast<uint8_t>(in_char)];
+            }
+            else
+            {
+                for (const auto& current_child : m_nodes[in_n_node].children)
+                {
+                    if (current_child.first == in_char)
+                    {
+                        result = current_child.second;
+
+                        break;
+                    }
+                }
+            }
+
+            return result;
+        }
+
+        uint32_t get_or_create_child(uint32_t in_n_node,
+                                     char     in_char)
+        {
+            uint32_t result = get_child(in_n_node,
+                                        in_char);
+
+            if (result == UINT32_MAX)
+            {
+                result = static_cast<uint32_t>(m_nodes.size() );
+
+                m_nodes.push_back(Node() );
+
+                if (in_n_node == 0)
+                {
+                    m_root_children[static_cast<uint8_t>(in_char)] = result;
+                }
+                else
+                {
+                    m_nodes.at(in_n_node).children.push_back(std::make_pair(in_char, result) );
+                }
+            }
+
+            return result;
+        }
+
+        std::vector<Node>         m_nodes;
+        std::array<uint32_t, 256> m_root_children; /* lets the scan reject characters which cannot start a name with one look-up */
+    };
+
+    /** Appends <in_begin_ptr, in_end_ptr> to @param out_result_ptr, replacing all placeholder names with their values
+     *  in a single pass. Among placeholder names starting at the same location, the longest one is substituted.
+     *  Substituted values are not scanned for placeholder names.
+     **/
+    void append_with_placeholders_substituted(const PlaceholderTrie&                                    in_trie,
+                                              const std::vector<std::pair<std::string, std::string> >& in_placeholder_values,
+                                              const char*                                               in_begin_ptr,
+                                              const char*                                               in_end_ptr,
+                                              std::string*                                              out_result_ptr)
+    {
+        const char* current_char_ptr       = in_begin_ptr;
+        const char* pending_copy_begin_ptr = in_begin_ptr;
+
+        while (current_char_ptr != in_end_ptr)
+        {
+            size_t         match_length = 0;
+            const uint32_t n_value      = in_trie.match(current_char_ptr,
+                                                        in_end_ptr,
+                                                       &match_length);
+
+            if (n_value == UINT32_MAX)
+            {
+                ++current_char_ptr;
+
+                continue;
+            }
+
+            out_result_ptr->append(pending_copy_begin_ptr,
+                                   current_char_ptr);
+            out_result_ptr->append(in_placeholder_values.at(n_value).second);
+
+            current_char_ptr      += match_length;
+            pending_copy_begin_ptr = current_char_ptr;
+        }
+
+        out_result_ptr->append(pending_copy_begin_ptr,
+                               in_end_ptr);
+    }
+
+    #ifdef ANVIL_LINK_WITH_GLSLANG
+        /** glslang includer which resolves #include directives against a GLSLHeaderCache instance, and records
+         *  all headers it has resolved. */
+        class HeaderCacheIncluder : public glslang::TShader::Includer
+        {
+        public:
+            explicit HeaderCacheIncluder(Anvil::GLSLHeaderCache* in_header_cache_ptr)
+                :m_header_cache_ptr(in_header_cache_ptr)
+            {
+                anvil_assert(m_header_cache_ptr != nullptr);
+            }
+
+            /** Returns resolved names of all included headers, mapped to hashes of their contents. */
+            const std::map<std::string, uint64_t>& get_dependencies() const
+            {
+                return m_dependencies;
+            }
+
+            IncludeResult* includeLocal(const char* in_header_name,
+                                        const char* in_includer_name,
+                                        size_t      in_inclusion_depth) override
+            {
+                ANVIL_REDUNDANT_ARGUMENT(in_inclusion_depth);
+
+                return include(in_header_name,
+                               in_includer_name,
+                               true); /* in_is_local */
+            }
+
+            IncludeResult* includeSystem(const char* in_header_name,
+                                         const char* in_includer_name,
+                                         size_t      in_inclusion_depth) override
+            {
+                ANVIL_REDUNDANT_ARGUMENT(in_inclusion_depth);
+
+                return include(in_header_name,
+                               in_includer_name,
+                               false); /* in_is_local */
+            }
+
+            void releaseInclude(IncludeResult* in_result_ptr) override
+            {
+                delete static_cast<HeaderIncludeResult*>(in_result_ptr);
+            }
+
+        private:
+            /* Keeps the header contents alive for as long as glslang refers to them */
+            struct HeaderIncludeResult : public IncludeResult
+            {
+                std::shared_ptr<const std::string> contents_ptr;
+
+                HeaderIncludeResult(const std::string&                 in_resolved_name,
+                                    std::shared_ptr<const std::string> in_contents_ptr)
+                    :IncludeResult(in_resolved_name,
+                                   in_contents_ptr->c_str(),
+                                   in_contents_ptr->size(),
+                                   nullptr), /* userData */
+                     contents_ptr (in_contents_ptr)
+                {
+                    /* Stub */
+                }
+            };
+
+            IncludeResult* include(const char* in_header_name,
+                                   const char* in_includer_name,
+                                   bool        in_is_local)
+            {
+                std::shared_ptr<const std::string> contents_ptr;
+                std::string                        resolved_name;
+
+                if (!m_header_cache_ptr->get_header(in_header_name,
+                                                    (in_includer_name != nullptr) ? in_includer_name : "",
+                                                    in_is_local,
+                                                   &resolved_name,
+                                                   &contents_ptr) )
+                {
+                    /* glslang reports missing headers on its own */
+                    return nullptr;
+                }
+
+                m_dependencies[resolved_name] = Anvil::Utils::hash64(contents_ptr->c_str(),
+                                                                     contents_ptr->size() );
+
+                return new HeaderIncludeResult(resolved_name,
+                                               contents_ptr);
+            }
+
+            std::map<std::string, uint64_t> m_dependencies;
+            Anvil::GLSLHeaderCache*         m_header_cache_ptr;
+        };
+    #endif
+};
+
 
 /* Please see header for specification */
 Anvil::GLSLShaderToSPIRVGenerator::GLSLShaderToSPIRVGenerator(const Anvil::BaseDevice* in_device_ptr,
@@ -256,6 +768,7 @@ Anvil::GLSLShaderToSPIRVGenerator::GLSLShaderToSPIRVGenerator(const Anvil::BaseD
     :CallbacksSupportProvider(GLSL_SHADER_TO_SPIRV_GENERATOR_CALLBACK_ID_COUNT),
      m_data                  (in_data),
      m_glsl_source_code_dirty(true),
+     m_header_cache_ptr      (nullptr),
      m_mode                  (in_mode),
      m_shader_stage          (in_shader_stage),
      m_spirv_version         (in_spirv_version)
@@ -377,15 +890,116 @@ end:
     return result;
 }
 
+/* Please see header for specification */
+bool Anvil::GLSLShaderToSPIRVGenerator::bake_all(const std::vector<Anvil::GLSLShaderToSPIRVGenerator*>& in_generator_ptrs,
+                                                 uint32_t                                               in_n_threads,
+                                                 Anvil::TaskScheduler*                                  in_opt_task_scheduler_ptr)
+{
+    std::atomic<uint32_t>                          n_failed_generators(0);
+    std::atomic<uint32_t>                          n_next_generator   (0);
+    uint32_t                                       n_threads          (in_n_threads);
+    std::vector<const GLSLShaderToSPIRVGenerator*> pending_generator_ptrs;
+    std::vector<std::thread>                       worker_threads;
+
+    for (const auto& current_generator_ptr : in_generator_ptrs)
+    {
+        if (current_generator_ptr                      != nullptr &&
+            current_generator_ptr->m_spirv_blob.size() == 0)
+        {
+            pending_generator_ptrs.push_back(current_generator_ptr);
+        }
+    }
+
+    /* The same generator must not be baked by more than one thread at a time. */
+    std::sort(pending_generator_ptrs.begin(),
+              pending_generator_ptrs.end  () );
+
+    pending_generator_ptrs.erase(std::unique(pending_generator_ptrs.begin(),
+                                             pending_generator_ptrs.end  () ),
+                                 pending_generator_ptrs.end() );
+
+    if (in_opt_task_scheduler_ptr != nullptr)
+    {
+        /* Hand out one generator per task. The scheduler balances the load across its workers. */
+        in_opt_task_scheduler_ptr->parallel_for(static_cast<uint32_t>(pending_generator_ptrs.size() ),
+                                                1, /* in_min_items_per_task */
+                                                [&pending_generator_ptrs, &n_failed_generators](uint32_t in_n_first_generator,
+                                                                                                uint32_t in_n_generators)
+                                                {
+                                                    for (uint32_t n_generator  = in_n_first_generator;
+                                                                  n_generator  < in_n_first_generator + in_n_generators;
+                                                                ++n_generator)
+                                                    {
+                                                        if (!pending_generator_ptrs.at(n_generator)->bake_spirv_blob() )
+                                                        {
+                                                            n_failed_generators.fetch_add(1);
+                                                        }
+                                                    }
+                                                });
+
+        goto end;
+    }
+
+    if (n_threads == 0)
+    {
+        n_threads = std::max(std::thread::hardware_concurrency(),
+                             1u);
+    }
+
+    n_threads = std::min(n_threads,
+                         static_cast<uint32_t>(pending_generator_ptrs.size() ));
+
+    {
+        /* Generators take wildly different amounts of time to bake, so let workers pick up generators one at a time,
+         * rather than handing out fixed-size chunks. */
+        auto worker_func = [&pending_generator_ptrs, &n_failed_generators, &n_next_generator]()
+        {
+            uint32_t n_generator;
+
+            while ((n_generator = n_next_generator.fetch_add(1) ) < static_cast<uint32_t>(pending_generator_ptrs.size() ))
+            {
+                if (!pending_generator_ptrs.at(n_generator)->bake_spirv_blob() )
+                {
+                    n_failed_generators.fetch_add(1);
+                }
+            }
+        };
+
+        if (n_threads <= 1)
+        {
+            worker_func();
+        }
+        else
+        {
+            for (uint32_t n_thread = 0;
+                          n_thread < n_threads;
+                        ++n_thread)
+            {
+                worker_threads.push_back(std::thread(worker_func) );
+            }
+
+            for (auto& current_worker_thread : worker_threads)
+            {
+                current_worker_thread.join();
+            }
+        }
+    }
+
+end:
+    return (n_failed_generators == 0);
+}
+
 /* Please see header for specification */
 bool Anvil::GLSLShaderToSPIRVGenerator::bake_glsl_source_code() const
 {
-    std::string    final_glsl_source_string;
-    const uint32_t n_definition_values        = static_cast<uint32_t>(m_definition_values.size() );
-    const uint32_t n_extension_behaviors      = static_cast<uint32_t>(m_extension_behaviors.size() );
-    const uint32_t n_placeholder_values       = static_cast<uint32_t>(m_placeholder_values.size());
-    const uint32_t n_pragmas                  = static_cast<uint32_t>(m_pragmas.size() );
-    bool           result                     = false;
+    std::unique_ptr<char[]> file_glsl_source_ptr;
+    std::string             final_glsl_source_string;
+    std::string             injected_lines;
+    const PlaceholderTrie   placeholder_trie      (m_placeholder_values);
+    bool                    result                (false);
+    const char*             source_begin_ptr      (nullptr);
+    const char*             source_end_ptr        (nullptr);
+    const char*             source_second_line_ptr(nullptr);
 
     anvil_assert(m_glsl_source_code_dirty);
 
@@ -407,15 +1021,22 @@ bool Anvil::GLSLShaderToSPIRVGenerator::bake_glsl_source_code() const
                 goto end;
             }
 
-            final_glsl_source_string = std::string(glsl_source);
+            file_glsl_source_ptr.reset(glsl_source);
+
+            source_begin_ptr = glsl_source;
+            source_end_ptr   = glsl_source + strlen(glsl_source);
 
-            delete [] glsl_source;
             break;
         }
 
         case MODE_USE_SPECIFIED_SOURCE:
         {
-            final_glsl_source_string = m_data;
+            /* Use the source code in-place. It may be shared with other generators, so it must not be modified. */
+            const std::string& glsl_source = (m_shared_glsl_source_ptr != nullptr) ? *m_shared_glsl_source_ptr
+                                                                                   : m_data;
+
+            source_begin_ptr = glsl_source.c_str();
+            source_end_ptr   = glsl_source.c_str() + glsl_source.size();
 
             break;
         }
@@ -429,81 +1050,72 @@ bool Anvil::GLSLShaderToSPIRVGenerator::bake_glsl_source_code() const
         }
     }
 
-    if (n_pragmas             > 0 ||
-        n_placeholder_values  > 0 ||
-        n_extension_behaviors > 0 ||
-        n_definition_values   > 0)
+    /* Form extension behavior definitions, which are going to be injected starting from the second line. According to the spec,
+     * first line in a GLSL shader must define the ESSL/GLSL version, and glslangvalidator seems to be pretty strict about this. */
+    for (const auto& current_extension_behavior : m_extension_behaviors)
     {
-        size_t glsl_source_string_second_line_index;
-
-        /* Inject extension behavior definitions, starting from the second line. According to the spec, first line in
-         * a GLSL shader must define the ESSL/GLSL version, and glslangvalidator seems to be pretty
-         * strict about this. */
-        glsl_source_string_second_line_index = final_glsl_source_string.find_first_of('\n') + 1;
-
-        for (auto map_iterator  = m_extension_behaviors.begin();
-                  map_iterator != m_extension_behaviors.end();
-                ++map_iterator)
-        {
-            const ExtensionBehavior& current_extension_behavior      = map_iterator->second;
-            std::string              current_extension_behavior_glsl = get_extension_behavior_glsl_code(current_extension_behavior);
-            std::string              current_extension_name          = map_iterator->first;
-            std::string              new_line                        = std::string("#extension ")      +
-                                                                       current_extension_name          +
-                                                                       std::string(" : ")              +
-                                                                       current_extension_behavior_glsl +
-                                                                       "\n";
-
-            final_glsl_source_string.insert(glsl_source_string_second_line_index,
-                                            new_line);
-
-            glsl_source_string_second_line_index += new_line.length();
-        }
-
-        /* Follow with #defines which associate values with definition names */
-        for (auto map_iterator  = m_definition_values.begin();
-                  map_iterator != m_definition_values.end();
-                ++map_iterator)
-        {
-            std::string current_key   = map_iterator->first;
-            std::string current_value = map_iterator->second;
-            std::string new_line      = std::string("#define ") + current_key + std::string(" ") + current_value + "\n";
-
-            final_glsl_source_string.insert(glsl_source_string_second_line_index,
-                                            new_line);
-        }
+        injected_lines += std::string("#extension ")                                          +
+                          current_extension_behavior.first                                    +
+                          std::string(" : ")                                                  +
+                          get_extension_behavior_glsl_code(current_extension_behavior.second) +
+                          "\n";
+    }
 
-        /* Next define pragmas */
-        for (auto& current_pragma : m_pragmas)
+    #ifdef ANVIL_LINK_WITH_GLSLANG
+    {
+        if (m_header_cache_ptr                                                  != nullptr &&
+            m_extension_behaviors.find("GL_GOOGLE_include_directive") == m_extension_behaviors.end() )
         {
-            std::string pragma_name  = current_pragma.first;
-            std::string pragma_value = current_pragma.second;
-            std::string new_line     = std::string("#pragma ") + pragma_name + std::string(" ") + pragma_value + "\n";
-
-            final_glsl_source_string.insert(glsl_source_string_second_line_index,
-                                            new_line);
+            injected_lines += "#extension GL_GOOGLE_include_directive : require\n";
         }
+    }
+    #endif
 
-        /* Finish with replacing placeholders with values */
-        for(auto vec_iterator  = m_placeholder_values.begin();
-                 vec_iterator != m_placeholder_values.end();
-               ++vec_iterator)
-        {
-            const std::string& current_key   = vec_iterator->first;
-            const std::string& current_value = vec_iterator->second;
-            size_t glsl_source_string_pos    = final_glsl_source_string.find(current_key, 0);
-
-            while (glsl_source_string_pos != std::string::npos)
-            {
-                final_glsl_source_string.replace(glsl_source_string_pos, current_key.size(), current_value);
+    /* Follow with pragmas and #defines which associate values with definition names. Both are emitted in reverse order
+     * to keep the source code (and hence SPIR-V cache keys) identical to what earlier versions used to produce. */
+    for (auto map_iterator  = m_pragmas.rbegin();
+              map_iterator != m_pragmas.rend();
+            ++map_iterator)
+    {
+        injected_lines += std::string("#pragma ") + map_iterator->first + std::string(" ") + map_iterator->second + "\n";
+    }
 
-                glsl_source_string_pos = final_glsl_source_string.find(current_key, glsl_source_string_pos);
-            }
-        }
+    for (auto map_iterator  = m_definition_values.rbegin();
+              map_iterator != m_definition_values.rend();
+            ++map_iterator)
+    {
+        injected_lines += std::string("#define ") + map_iterator->first + std::string(" ") + map_iterator->second + "\n";
     }
 
+    source_second_line_ptr = std::find(source_begin_ptr,
+                                       source_end_ptr,
+                                       '\n');
+
+    source_second_line_ptr = (source_second_line_ptr != source_end_ptr) ? source_second_line_ptr + 1
+                                                                        : source_begin_ptr;
+
+    /* Finish with replacing placeholders with values. This is done in a single pass over the source code,
+     * so the cost does not grow with the number of placeholders. */
+    final_glsl_source_string.reserve(static_cast<size_t>(source_end_ptr - source_begin_ptr) + injected_lines.size() );
+
+    append_with_placeholders_substituted(placeholder_trie,
+                                         m_placeholder_values,
+                                         source_begin_ptr,
+                                         source_second_line_ptr,
+                                        &final_glsl_source_string);
+    append_with_placeholders_substituted(placeholder_trie,
+                                         m_placeholder_values,
+                                         injected_lines.c_str(),
+                                         injected_lines.c_str() + injected_lines.size(),
+                                        &final_glsl_source_string);
+    append_with_placeholders_substituted(placeholder_trie,
+                                         m_placeholder_values,
+                                         source_second_line_ptr,
+                                         source_end_ptr,
+                                        &final_glsl_source_string);
+
     /* Cache the GLSL source code used for the conversion */
-    m_glsl_source_code = final_glsl_source_string;
+    m_glsl_source_code = std::move(final_glsl_source_string);
 
     /* All done */
     m_glsl_source_code_dirty = false;
@@ -516,12 +1128,16 @@ end:
 /* Please see header for specification */
 bool Anvil::GLSLShaderToSPIRVGenerator::bake_spirv_blob() const
 {
+    ANVIL_TRACE_SPAN("GLSLShaderToSPIRVGenerator::bake_spirv_blob");
+
     bool           glsl_filename_is_temporary = false;
     std::string    glsl_filename_with_path;
     bool           result                     = false;
 
     ANVIL_REDUNDANT_VARIABLE(glsl_filename_is_temporary);
 
+    m_optimization_stats = OptimizationStats();
+
     if (m_glsl_source_code_dirty)
     {
         bake_glsl_source_code();
@@ -529,23 +1145,51 @@ bool Anvil::GLSLShaderToSPIRVGenerator::bake_spirv_blob() const
         anvil_assert(!m_glsl_source_code_dirty);
     }
 
+    #ifdef ANVIL_LINK_WITH_GLSLANG
+    {
+        /* The cache key needs to cover contents of all included headers, so resolve them before looking the blob up. */
+        if (m_header_cache_ptr               != nullptr &&
+            m_spirv_cache_directory.size()   >  0       &&
+            !preprocess_includes() )
+        {
+            /* Let the compiler report the error */
+            m_include_dependencies.clear();
+        }
+    }
+    #endif
+
+    if (m_spirv_cache_directory.size() > 0 &&
+        load_spirv_blob_from_cache() )
+    {
+        result = true;
+
+        goto end;
+    }
+
     if (m_mode == MODE_LOAD_SOURCE_FROM_FILE)
     {
         glsl_filename_is_temporary = false;
         glsl_filename_with_path    = m_data;
     }
 
-    /* Form a temporary file name we will use to write the modified GLSL shader to. */
+    /* Form a temporary file name we will use to write the modified GLSL shader to. The name is unique to
+     * the generator, so that multiple generators can be baked at the same time. */
     #ifndef ANVIL_LINK_WITH_GLSLANG
     {
+        std::stringstream glsl_filename_sstream;
+
+        glsl_filename_sstream << "temp_" << std::hex << reinterpret_cast<uintptr_t>(this);
+
         switch (m_shader_stage)
         {
-            case ShaderStage::COMPUTE:                 glsl_filename_with_path = "temp.comp"; break;
-            case ShaderStage::FRAGMENT:                glsl_filename_with_path = "temp.frag"; break;
-            case ShaderStage::GEOMETRY:                glsl_filename_with_path = "temp.geom"; break;
-            case ShaderStage::TESSELLATION_CONTROL:    glsl_filename_with_path = "temp.tesc"; break;
-            case ShaderStage::TESSELLATION_EVALUATION: glsl_filename_with_path = "temp.tese"; break;
-            case ShaderStage::VERTEX:                  glsl_filename_with_path = "temp.vert"; break;
+            case ShaderStage::COMPUTE:                 glsl_filename_sstream << ".comp"; break;
+            case ShaderStage::FRAGMENT:                glsl_filename_sstream << ".frag"; break;
+            case ShaderStage::GEOMETRY:                glsl_filename_sstream << ".geom"; break;
+            case ShaderStage::MESH:                    glsl_filename_sstream << ".mesh"; break;
+            case ShaderStage::TASK:                    glsl_filename_sstream << ".task"; break;
+            case ShaderStage::TESSELLATION_CONTROL:    glsl_filename_sstream << ".tesc"; break;
+            case ShaderStage::TESSELLATION_EVALUATION: glsl_filename_sstream << ".tese"; break;
+            case ShaderStage::VERTEX:                  glsl_filename_sstream << ".vert"; break;
 
             default:
             {
@@ -555,6 +1199,8 @@ bool Anvil::GLSLShaderToSPIRVGenerator::bake_spirv_blob() const
             }
         }
 
+        glsl_filename_with_path = glsl_filename_sstream.str();
+
         /* Write down the file to a temporary location */
         Anvil::IO::write_text_file(glsl_filename_with_path,
                                    m_glsl_source_code);
@@ -571,11 +1217,13 @@ bool Anvil::GLSLShaderToSPIRVGenerator::bake_spirv_blob() const
          *
          * Given that the conversion process can be time-consuming, let's try to see if any of the living
          * shader module instances already use exactly the same source code.
+         *
+         * Source code which includes headers cannot be compared this way, as the headers may have changed since.
          */
         uint32_t n_current_shader_module = 0;
         auto     object_tracker_ptr      = Anvil::ObjectTracker::get();
 
-        do
+        while (m_header_cache_ptr == nullptr)
         {
             auto                       shader_module_raw_ptr = object_tracker_ptr->get_object_at_index     (Anvil::ObjectType::SHADER_MODULE,
                                                                                                             n_current_shader_module);
@@ -607,7 +1255,6 @@ bool Anvil::GLSLShaderToSPIRVGenerator::bake_spirv_blob() const
             /* Move to the next shader module instance */
             ++n_current_shader_module;
         }
-        while (n_current_shader_module != 0); /* work around "conditional expression is constant" warnings issued by some compilers */
 
         if (m_spirv_blob.size() == 0)
         {
@@ -620,14 +1267,27 @@ bool Anvil::GLSLShaderToSPIRVGenerator::bake_spirv_blob() const
     {
         /* We need to point glslangvalidator at a location where it can stash the SPIR-V blob. */
         result = bake_spirv_blob_by_spawning_glslang_process(glsl_filename_with_path,
-                                                             "temp.spv");
-    }
+                                                             glsl_filename_with_path + ".spv");
 
-end:
+        if (glsl_filename_is_temporary)
+        {
+            Anvil::IO::delete_file(glsl_filename_with_path);
+        }
+    }
     #endif
 
+    if (result)
+    {
+        optimize_spirv_blob();
+    }
 
+    if (result                            &&
+        m_spirv_cache_directory.size() > 0)
+    {
+        store_spirv_blob_in_cache();
+    }
 
+end:
     return result;
 }
 
@@ -646,6 +1306,7 @@ end:
         glslang::TProgram*        new_program_ptr      = new glslang::TProgram();
         glslang::TShader*         new_shader_ptr       = new glslang::TShader(glslang_shader_stage);
         bool                      result               = false;
+        const char*               source_name          = (m_mode == MODE_LOAD_SOURCE_FROM_FILE) ? m_data.c_str() : "";
         std::vector<unsigned int> spirv_blob;
 
         anvil_assert(new_program_ptr != nullptr &&
@@ -668,9 +1329,11 @@ end:
             bool                              link_result = false;
             glslang::EShTargetLanguageVersion spirv_version;
 
-            /* Try to compile the shader */
-            new_shader_ptr->setStrings(&in_body,
-                                       1);
+            /* Try to compile the shader. The source name is what local includes are resolved relative to. */
+            new_shader_ptr->setStringsWithLengthsAndNames(&in_body,
+                                                          nullptr, /* l */
+                                                         &source_name,
+                                                          1);
 
             switch (m_spirv_version)
             {
@@ -720,10 +1383,25 @@ end:
             new_shader_ptr->setEnvTarget(glslang::EShTargetSpv,
                                          spirv_version);
 
-            result = new_shader_ptr->parse(m_limits_ptr->get_resource_ptr(),
-                                           110,   /* defaultVersion    */
-                                           false, /* forwardCompatible */
-                                           (EShMessages) (EShMsgDefault | EShMsgSpvRules | EShMsgVulkanRules) );
+            if (m_header_cache_ptr != nullptr)
+            {
+                HeaderCacheIncluder includer(m_header_cache_ptr);
+
+                result = new_shader_ptr->parse(m_limits_ptr->get_resource_ptr(),
+                                               110,   /* defaultVersion    */
+                                               false, /* forwardCompatible */
+                                               (EShMessages) (EShMsgDefault | EShMsgSpvRules | EShMsgVulkanRules),
+                                               includer);
+
+                m_include_dependencies = includer.get_dependencies();
+            }
+            else
+            {
+                result = new_shader_ptr->parse(m_limits_ptr->get_resource_ptr(),
+                                               110,   /* defaultVersion    */
+                                               false, /* forwardCompatible */
+                                               (EShMessages) (EShMsgDefault | EShMsgSpvRules | EShMsgVulkanRules) );
+            }
 
             m_debug_info_log  = new_shader_ptr->getInfoDebugLog();
             m_shader_info_log = new_shader_ptr->getInfoLog();
@@ -808,6 +1486,8 @@ end:
             case Anvil::ShaderStage::COMPUTE:                 result = EShLangCompute;        break;
             case Anvil::ShaderStage::FRAGMENT:                result = EShLangFragment;       break;
             case Anvil::ShaderStage::GEOMETRY:                result = EShLangGeometry;       break;
+            case Anvil::ShaderStage::MESH:                    result = EShLangMeshNV;         break;
+            case Anvil::ShaderStage::TASK:                    result = EShLangTaskNV;         break;
             case Anvil::ShaderStage::TESSELLATION_CONTROL:    result = EShLangTessControl;    break;
             case Anvil::ShaderStage::TESSELLATION_EVALUATION: result = EShLangTessEvaluation; break;
             case Anvil::ShaderStage::VERTEX:                  result = EShLangVertex;         break;
@@ -820,6 +1500,42 @@ end:
 
         return result;
     }
+
+    /** Runs the final GLSL source code through glslang's preprocessor to find out which headers it includes, and
+     *  stores their names and hashes under m_include_dependencies.
+     *
+     *  @return true if successful, false otherwise.
+     **/
+    bool Anvil::GLSLShaderToSPIRVGenerator::preprocess_includes() const
+    {
+        HeaderCacheIncluder includer         (m_header_cache_ptr);
+        std::string         preprocessed_glsl;
+        bool                result           (false);
+        glslang::TShader    shader           (get_glslang_shader_stage() );
+        const char*         source_name      ((m_mode == MODE_LOAD_SOURCE_FROM_FILE) ? m_data.c_str() : "");
+        const char*         source_ptr       (m_glsl_source_code.c_str() );
+
+        anvil_assert(m_header_cache_ptr != nullptr);
+        anvil_assert(m_limits_ptr       != nullptr);
+
+        shader.setStringsWithLengthsAndNames(&source_ptr,
+                                              nullptr, /* l */
+                                             &source_name,
+                                              1);
+
+        result = shader.preprocess(m_limits_ptr->get_resource_ptr(),
+                                   110,        /* defaultVersion                */
+                                   ENoProfile,
+                                   false,      /* forceDefaultVersionAndProfile */
+                                   false,      /* forwardCompatible             */
+                                   (EShMessages) (EShMsgDefault | EShMsgSpvRules | EShMsgVulkanRules),
+                                  &preprocessed_glsl,
+                                   includer);
+
+        m_include_dependencies = includer.get_dependencies();
+
+        return result;
+    }
 #else
     /** Reads contents of a file under location @param glsl_filename_with_path and treats the retrieved contents as GLSL source code,
      *  which is then used for GLSL->SPIRV conversion process. The result blob is stored at @param spirv_filename_with_path. The function
@@ -986,12 +1702,46 @@ Anvil::GLSLShaderToSPIRVGeneratorUniquePtr Anvil::GLSLShaderToSPIRVGenerator::cr
                                               in_spirv_version)
     );
 
+    if (in_opt_device_ptr != nullptr)
+    {
+        for (const auto& current_definition : in_opt_device_ptr->get_storage_feature_shader_definitions() )
+        {
+            result_ptr->add_definition_value_pair(current_definition.first,
+                                                  current_definition.second);
+        }
+    }
+
     Anvil::ObjectTracker::get()->register_object(Anvil::ObjectType::ANVIL_GLSL_SHADER_TO_SPIRV_GENERATOR,
                                                  result_ptr.get() );
 
     return result_ptr;
 }
 
+/* Please see header for specification */
+Anvil::GLSLShaderToSPIRVGeneratorUniquePtr Anvil::GLSLShaderToSPIRVGenerator::create(const Anvil::BaseDevice*           in_opt_device_ptr,
+                                                                                     std::shared_ptr<const std::string> in_glsl_source_ptr,
+                                                                                     ShaderStage                        in_shader_stage,
+                                                                                     SpvVersion                         in_spirv_version)
+{
+    Anvil::GLSLShaderToSPIRVGeneratorUniquePtr result_ptr(nullptr,
+                                                          std::default_delete<Anvil::GLSLShaderToSPIRVGenerator>() );
+
+    anvil_assert(in_glsl_source_ptr != nullptr);
+
+    result_ptr = create(in_opt_device_ptr,
+                        MODE_USE_SPECIFIED_SOURCE,
+                        std::string(), /* in_data */
+                        in_shader_stage,
+                        in_spirv_version);
+
+    if (result_ptr != nullptr)
+    {
+        result_ptr->m_shared_glsl_source_ptr = std::move(in_glsl_source_ptr);
+    }
+
+    return result_ptr;
+}
+
 /* Please see header for specification */
 std::string Anvil::GLSLShaderToSPIRVGenerator::get_extension_behavior_glsl_code(const ExtensionBehavior& in_value) const
 {
@@ -1012,3 +1762,343 @@ std::string Anvil::GLSLShaderToSPIRVGenerator::get_extension_behavior_glsl_code(
 
     return result;
 }
+
+/* Please see header for specification */
+std::vector<std::string> Anvil::GLSLShaderToSPIRVGenerator::get_include_dependencies() const
+{
+    std::vector<std::string> result;
+
+    result.reserve(m_include_dependencies.size() );
+
+    for (const auto& current_include_dependency : m_include_dependencies)
+    {
+        result.push_back(current_include_dependency.first);
+    }
+
+    return result;
+}
+
+/** Returns name of the file, under which a SPIR-V cache entry for @param in_key is stored.
+ *
+ *  The name is formed from a 64-bit hash of the key. The hash only needs to be stable across runs,
+ *  since the key itself is stored in the file and compared at load time to detect collisions.
+ **/
+std::string Anvil::GLSLShaderToSPIRVGenerator::get_spirv_cache_filename(const std::string& in_key) const
+{
+    const uint64_t    hash = Anvil::Utils::hash64(in_key.c_str(),
+                                                  in_key.size() );
+    std::stringstream result_sstream;
+
+    result_sstream << m_spirv_cache_directory;
+
+    if (m_spirv_cache_directory.back() != '/' &&
+        m_spirv_cache_directory.back() != '\\')
+    {
+        result_sstream << "/";
+    }
+
+    result_sstream << std::hex << hash << ".spv";
+
+    return result_sstream.str();
+}
+
+/** Forms a string which uniquely identifies the SPIR-V blob this generator is going to produce. */
+std::string Anvil::GLSLShaderToSPIRVGenerator::get_spirv_cache_key() const
+{
+    std::stringstream result_sstream;
+
+    anvil_assert(!m_glsl_source_code_dirty);
+
+    result_sstream << "stage:" << static_cast<uint32_t>(m_shader_stage)  << "\n"
+                   << "spv:"   << static_cast<uint32_t>(m_spirv_version) << "\n";
+
+    if (m_optimization_settings.is_enabled() )
+    {
+        result_sstream << "opt:" << m_optimization_settings.eliminate_dead_code
+                                 << m_optimization_settings.fold_constants
+                                 << m_optimization_settings.freeze_specialization_constants
+                                 << m_optimization_settings.strip_debug_info;
+
+        for (const auto& current_value : m_optimization_settings.specialization_constant_values)
+        {
+            result_sstream << " " << current_value.first << "=" << current_value.second;
+        }
+
+        #ifdef ANVIL_LINK_WITH_SPIRV_TOOLS
+        {
+            result_sstream << " spirv-tools:" << spvSoftwareVersionString();
+        }
+        #endif
+
+        result_sstream << "\n";
+    }
+
+    #ifdef ANVIL_LINK_WITH_GLSLANG
+    {
+        result_sstream << "glslang:" << glslang::GetGlslVersionString    () << " "
+                                     << glslang::GetKhronosToolId        () << " "
+                                     << glslang::GetSpirvGeneratorVersion() << "\n";
+
+        if (m_limits_ptr != nullptr)
+        {
+            /* TBuiltInResource is value-initialized, so its padding, if any, is zeroed. */
+            const auto     resource_ptr     = reinterpret_cast<const uint8_t*>(m_limits_ptr->get_resource_ptr() );
+            const uint32_t n_resource_bytes = static_cast<uint32_t>(sizeof(TBuiltInResource) );
+
+            result_sstream << "limits:" << std::hex;
+
+            for (uint32_t n_resource_byte = 0;
+                          n_resource_byte < n_resource_bytes;
+                        ++n_resource_byte)
+            {
+                result_sstream << std::setw(2) << std::setfill('0') << static_cast<uint32_t>(resource_ptr[n_resource_byte]);
+            }
+
+            result_sstream << std::dec << "\n";
+        }
+    }
+    #else
+    {
+        result_sstream << "glslang:glslangValidator\n";
+    }
+    #endif
+
+    for (const auto& current_include_dependency : m_include_dependencies)
+    {
+        result_sstream << "include:" << current_include_dependency.first << ":" << std::hex << current_include_dependency.second << std::dec << "\n";
+    }
+
+    result_sstream << m_glsl_source_code;
+
+    return result_sstream.str();
+}
+
+/** Tries to load the SPIR-V blob from the on-disk cache.
+ *
+ *  @return true if a matching cache entry was found and loaded into m_spirv_blob, false otherwise.
+ **/
+bool Anvil::GLSLShaderToSPIRVGenerator::load_spirv_blob_from_cache() const
+{
+    const std::string key           = get_spirv_cache_key();
+    char*             file_data_ptr = nullptr;
+    uint32_t          header[4];
+    size_t            n_file_bytes  = 0;
+    bool              result        = false;
+
+    if (!Anvil::IO::read_file(get_spirv_cache_filename(key),
+                              false, /* in_is_text_file */
+                             &file_data_ptr,
+                             &n_file_bytes) )
+    {
+        goto end;
+    }
+
+    if (n_file_bytes < sizeof(header) )
+    {
+        goto end;
+    }
+
+    memcpy(header,
+           file_data_ptr,
+           sizeof(header) );
+
+    /* header[2] holds the key size, header[3] holds the SPIR-V blob size */
+    if (header[0]    != SPIRV_CACHE_FILE_MAGIC                                         ||
+        header[1]    != SPIRV_CACHE_FILE_VERSION                                       ||
+        header[2]    != key.size()                                                     ||
+        header[3]    == 0                                                              ||
+        n_file_bytes != sizeof(header) + static_cast<size_t>(header[2]) + header[3])
+    {
+        goto end;
+    }
+
+    if (memcmp(file_data_ptr + sizeof(header),
+               key.c_str(),
+               key.size() ) != 0)
+    {
+        /* Hash collision */
+        goto end;
+    }
+
+    m_spirv_blob.resize(header[3]);
+
+    memcpy(&m_spirv_blob.at(0),
+           file_data_ptr + sizeof(header) + header[2],
+           header[3]);
+
+    result = true;
+end:
+    delete [] file_data_ptr;
+
+    return result;
+}
+
+/** Runs the optimization passes enabled with set_optimization_settings() on m_spirv_blob, and updates
+ *  m_optimization_stats. If any of the passes fails, m_spirv_blob is left intact.
+ **/
+void Anvil::GLSLShaderToSPIRVGenerator::optimize_spirv_blob() const
+{
+    Anvil::Time           timer;
+    std::vector<uint32_t> words;
+
+    m_optimization_stats.n_unoptimized_bytes = static_cast<uint32_t>(m_spirv_blob.size() );
+
+    if (!m_optimization_settings.is_enabled() )
+    {
+        goto end;
+    }
+
+    if ((m_spirv_blob.size() % sizeof(uint32_t) ) != 0                    ||
+        m_spirv_blob.size()                        <  SPIRV_N_HEADER_WORDS * sizeof(uint32_t) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    words.resize(m_spirv_blob.size() / sizeof(uint32_t) );
+
+    memcpy(&words.at       (0),
+           &m_spirv_blob.at(0),
+            m_spirv_blob.size() );
+
+    /* The built-in passes expect a well-formed instruction stream */
+    for (uint32_t n_word = SPIRV_N_HEADER_WORDS;
+                  n_word < static_cast<uint32_t>(words.size() );
+                  n_word += words.at(n_word) >> 16)
+    {
+        if ((words.at(n_word) >> 16)          == 0            ||
+            n_word + (words.at(n_word) >> 16) >  words.size() )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    if (m_optimization_settings.freeze_specialization_constants)
+    {
+        freeze_specialization_constants(m_optimization_settings.specialization_constant_values,
+                                       &words);
+    }
+
+    #ifdef ANVIL_LINK_WITH_SPIRV_TOOLS
+    {
+        if (m_optimization_settings.eliminate_dead_code ||
+            m_optimization_settings.fold_constants)
+        {
+            spv_target_env        target_env;
+            std::vector<uint32_t> optimized_words;
+
+            switch (m_spirv_version)
+            {
+                case SpvVersion::_1_0: target_env = SPV_ENV_UNIVERSAL_1_0; break;
+                case SpvVersion::_1_1: target_env = SPV_ENV_UNIVERSAL_1_1; break;
+                case SpvVersion::_1_2: target_env = SPV_ENV_UNIVERSAL_1_2; break;
+                case SpvVersion::_1_3: target_env = SPV_ENV_UNIVERSAL_1_3; break;
+                case SpvVersion::_1_4: target_env = SPV_ENV_UNIVERSAL_1_4; break;
+
+                default:
+                {
+                    anvil_assert_fail();
+
+                    goto end;
+                }
+            }
+
+            {
+                spvtools::Optimizer optimizer(target_env);
+
+                if (m_optimization_settings.fold_constants)
+                {
+                    optimizer.RegisterPass(spvtools::CreateFoldSpecConstantOpAndCompositePass() )
+                             .RegisterPass(spvtools::CreateCCPPass                          () )
+                             .RegisterPass(spvtools::CreateUnifyConstantPass                () );
+                }
+
+                if (m_optimization_settings.eliminate_dead_code)
+                {
+                    optimizer.RegisterPass(spvtools::CreateEliminateDeadFunctionsPass() )
+                             .RegisterPass(spvtools::CreateDeadBranchElimPass        () )
+                             .RegisterPass(spvtools::CreateAggressiveDCEPass         () )
+                             .RegisterPass(spvtools::CreateEliminateDeadConstantPass () );
+                }
+
+                if (!optimizer.Run(&words.at(0),
+                                    words.size(),
+                                   &optimized_words) )
+                {
+                    goto end;
+                }
+            }
+
+            words = std::move(optimized_words);
+        }
+    }
+    #endif
+
+    if (m_optimization_settings.strip_debug_info)
+    {
+        strip_debug_info(&words);
+    }
+
+    m_spirv_blob.resize(words.size() * sizeof(uint32_t) );
+
+    memcpy(&m_spirv_blob.at(0),
+           &words.at       (0),
+            m_spirv_blob.size() );
+
+end:
+    m_optimization_stats.n_optimized_bytes      = static_cast<uint32_t>(m_spirv_blob.size() );
+    m_optimization_stats.optimization_time_nsec = timer.get_time_in_nsec();
+}
+
+/** Stores m_spirv_blob in the on-disk cache.
+ *
+ *  The entry is written to a temporary file first, and then renamed, so that other generators (possibly
+ *  running in other processes) never see a partially written entry. Failures are not fatal.
+ **/
+void Anvil::GLSLShaderToSPIRVGenerator::store_spirv_blob_in_cache() const
+{
+    std::vector<char> file_data;
+    const std::string key           = get_spirv_cache_key();
+    const std::string filename      = get_spirv_cache_filename(key);
+    uint32_t          header[4];
+    std::stringstream temp_filename_sstream;
+
+    anvil_assert(m_spirv_blob.size() > 0);
+
+    header[0] = SPIRV_CACHE_FILE_MAGIC;
+    header[1] = SPIRV_CACHE_FILE_VERSION;
+    header[2] = static_cast<uint32_t>(key.size         () );
+    header[3] = static_cast<uint32_t>(m_spirv_blob.size() );
+
+    file_data.resize(sizeof(header) + key.size() + m_spirv_blob.size() );
+
+    memcpy(&file_data.at(0),
+            header,
+            sizeof(header) );
+    memcpy(&file_data.at(sizeof(header) ),
+            key.c_str(),
+            key.size() );
+    memcpy(&file_data.at(sizeof(header) + key.size() ),
+           &m_spirv_blob.at(0),
+            m_spirv_blob.size() );
+
+    temp_filename_sstream << filename << "." << std::hex << reinterpret_cast<uintptr_t>(this) << ".tmp";
+
+    if (!Anvil::IO::write_binary_file(temp_filename_sstream.str(),
+                                     &file_data.at(0),
+                                      static_cast<unsigned int>(file_data.size() )) )
+    {
+        return;
+    }
+
+    if (std::rename(temp_filename_sstream.str().c_str(),
+                    filename.c_str() ) != 0)
+    {
+        /* rename() does not replace existing files on some platforms. Another generator may have stored
+         * the same entry in the meantime, in which case there's nothing left to do. */
+        Anvil::IO::delete_file(temp_filename_sstream.str() );
+    }
+}
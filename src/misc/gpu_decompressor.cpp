@@ -0,0 +1,403 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "misc/compute_pipeline_create_info.h"
+#include "misc/debug.h"
+#include "misc/descriptor_set_cache.h"
+#include "misc/descriptor_set_create_info.h"
+#include "misc/glsl_to_spirv.h"
+#include "misc/gpu_decompressor.h"
+#include "wrappers/buffer.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/compute_pipeline_manager.h"
+#include "wrappers/descriptor_set_layout.h"
+#include "wrappers/device.h"
+#include "wrappers/shader_module.h"
+
+#define N_INVOCATIONS_PER_WORKGROUP (64)
+
+
+static const char* g_glsl_lz4_decompress_comp =
+    "#version 450\n"
+    "\n"
+    "layout(local_size_x = 64) in;\n"
+    "\n"
+    "layout(std430, set = 0, binding = 0) restrict readonly buffer srcBlock\n"
+    "{\n"
+    "    uint src_data[];\n"
+    "};\n"
+    "layout(std430, set = 0, binding = 1) restrict buffer dstBlock\n"
+    "{\n"
+    "    uint dst_data[];\n"
+    "};\n"
+    "\n"
+    "layout(push_constant) uniform pushConstants\n"
+    "{\n"
+    "    uint chunk_table_offset;\n"
+    "    uint n_chunks;\n"
+    "} pc;\n"
+    "\n"
+    "/* Output bytes are gathered in a register and written out one word at a time. */\n"
+    "uint dst_base_word;\n"
+    "uint pending_word;\n"
+    "\n"
+    "uint read_src_byte(uint offset)\n"
+    "{\n"
+    "    return (src_data[offset >> 2] >> ((offset & 3u) * 8u) ) & 0xFFu;\n"
+    "}\n"
+    "\n"
+    "uint read_dst_byte(uint offset, uint current_offset)\n"
+    "{\n"
+    "    uint word = ((offset >> 2) == (current_offset >> 2) ) ? pending_word\n"
+    "                                                          : dst_data[dst_base_word + (offset >> 2)];\n"
+    "\n"
+    "    return (word >> ((offset & 3u) * 8u) ) & 0xFFu;\n"
+    "}\n"
+    "\n"
+    "void write_dst_byte(uint offset, uint value)\n"
+    "{\n"
+    "    pending_word = ((offset & 3u) == 0u) ? value\n"
+    "                                         : (pending_word | (value << ((offset & 3u) * 8u) ));\n"
+    "\n"
+    "    if ((offset & 3u) == 3u)\n"
+    "    {\n"
+    "        dst_data[dst_base_word + (offset >> 2)] = pending_word;\n"
+    "    }\n"
+    "}\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "    uint n_chunk = gl_GlobalInvocationID.x;\n"
+    "\n"
+    "    if (n_chunk >= pc.n_chunks)\n"
+    "    {\n"
+    "        return;\n"
+    "    }\n"
+    "\n"
+    "    uint table_offset = pc.chunk_table_offset + n_chunk * 4u;\n"
+    "    uint src_offset   = src_data[table_offset];\n"
+    "    uint src_end      = src_offset + src_data[table_offset + 1u];\n"
+    "    uint dst_size     = src_data[table_offset + 3u];\n"
+    "    uint dst_offset   = 0u;\n"
+    "\n"
+    "    dst_base_word = src_data[table_offset + 2u] >> 2;\n"
+    "    pending_word  = 0u;\n"
+    "\n"
+    "    while (src_offset < src_end && dst_offset < dst_size)\n"
+    "    {\n"
+    "        uint token      = read_src_byte(src_offset++);\n"
+    "        uint n_literals = token >> 4;\n"
+    "        uint match_size = (token & 0xFu) + 4u;\n"
+    "        uint next_byte  = 255u;\n"
+    "\n"
+    "        if (n_literals == 15u)\n"
+    "        {\n"
+    "            while (next_byte == 255u && src_offset < src_end)\n"
+    "            {\n"
+    "                next_byte   = read_src_byte(src_offset++);\n"
+    "                n_literals += next_byte;\n"
+    "            }\n"
+    "        }\n"
+    "\n"
+    "        n_literals = min(n_literals, min(src_end - src_offset, dst_size - dst_offset) );\n"
+    "\n"
+    "        for (uint n_literal = 0u; n_literal < n_literals; ++n_literal)\n"
+    "        {\n"
+    "            write_dst_byte(dst_offset++, read_src_byte(src_offset++) );\n"
+    "        }\n"
+    "\n"
+    "        /* The last sequence of a block only holds literals */\n"
+    "        if (src_offset + 2u > src_end)\n"
+    "        {\n"
+    "            break;\n"
+    "        }\n"
+    "\n"
+    "        uint match_offset = read_src_byte(src_offset) | (read_src_byte(src_offset + 1u) << 8);\n"
+    "\n"
+    "        src_offset += 2u;\n"
+    "        next_byte   = 255u;\n"
+    "\n"
+    "        if (match_size == 19u)\n"
+    "        {\n"
+    "            while (next_byte == 255u && src_offset < src_end)\n"
+    "            {\n"
+    "                next_byte   = read_src_byte(src_offset++);\n"
+    "                match_size += next_byte;\n"
+    "            }\n"
+    "        }\n"
+    "\n"
+    "        if (match_offset == 0u || match_offset > dst_offset)\n"
+    "        {\n"
+    "            break;\n"
+    "        }\n"
+    "\n"
+    "        match_size = min(match_size, dst_size - dst_offset);\n"
+    "\n"
+    "        for (uint n_byte = 0u; n_byte < match_size; ++n_byte)\n"
+    "        {\n"
+    "            write_dst_byte(dst_offset, read_dst_byte(dst_offset - match_offset, dst_offset) );\n"
+    "\n"
+    "            ++dst_offset;\n"
+    "        }\n"
+    "    }\n"
+    "\n"
+    "    /* Flush the last, partially filled word. Its remaining bytes are zero. */\n"
+    "    if ((dst_offset & 3u) != 0u)\n"
+    "    {\n"
+    "        dst_data[dst_base_word + (dst_offset >> 2)] = pending_word;\n"
+    "    }\n"
+    "}\n";
+
+
+/** Please see header for specification */
+Anvil::GPUDecompressor::GPUDecompressor(const Anvil::BaseDevice* in_device_ptr)
+    :m_device_ptr (in_device_ptr),
+     m_pipeline_id(UINT32_MAX)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::GPUDecompressor::~GPUDecompressor()
+{
+    m_ds_cache_ptr.reset();
+
+    if (m_pipeline_id != UINT32_MAX)
+    {
+        m_device_ptr->get_compute_pipeline_manager()->delete_pipeline(m_pipeline_id);
+
+        m_pipeline_id = UINT32_MAX;
+    }
+
+    m_ds_layout_ptr.reset    ();
+    m_entrypoint_ptr.reset   ();
+    m_shader_module_ptr.reset();
+}
+
+/** Please see header for specification */
+void Anvil::GPUDecompressor::clear_cache()
+{
+    m_ds_cache_ptr->clear();
+}
+
+/** Please see header for specification */
+Anvil::GPUDecompressorUniquePtr Anvil::GPUDecompressor::create(const Anvil::BaseDevice* in_device_ptr)
+{
+    Anvil::GPUDecompressorUniquePtr result_ptr(nullptr,
+                                               std::default_delete<Anvil::GPUDecompressor>() );
+
+    result_ptr.reset(
+        new Anvil::GPUDecompressor(in_device_ptr)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init() )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+/** Initializes the shader, the descriptor set layout, the compute pipeline and the descriptor set cache.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::GPUDecompressor::init()
+{
+    Anvil::ComputePipelineCreateInfoUniquePtr          pipeline_create_info_ptr;
+    Anvil::DescriptorSetCreateInfoUniquePtr            ds_create_info_ptr;
+    std::vector<const Anvil::DescriptorSetCreateInfo*> ds_create_info_ptrs;
+    Anvil::GLSLShaderToSPIRVGeneratorUniquePtr         glsl_ptr;
+    bool                                               result = false;
+
+    glsl_ptr = Anvil::GLSLShaderToSPIRVGenerator::create(m_device_ptr,
+                                                         Anvil::GLSLShaderToSPIRVGenerator::MODE_USE_SPECIFIED_SOURCE,
+                                                         g_glsl_lz4_decompress_comp,
+                                                         Anvil::ShaderStage::COMPUTE);
+
+    if (glsl_ptr == nullptr)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    m_shader_module_ptr = Anvil::ShaderModule::create_from_spirv_generator(m_device_ptr,
+                                                                           glsl_ptr.get() );
+
+    if (m_shader_module_ptr == nullptr)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    m_entrypoint_ptr.reset(
+        new Anvil::ShaderModuleStageEntryPoint("main",
+                                               m_shader_module_ptr.get(),
+                                               Anvil::ShaderStage::COMPUTE)
+    );
+
+    ds_create_info_ptr = Anvil::DescriptorSetCreateInfo::create();
+
+    ds_create_info_ptr->add_binding(0, /* in_binding_index */
+                                    Anvil::DescriptorType::STORAGE_BUFFER,
+                                    1, /* in_descriptor_array_size */
+                                    Anvil::ShaderStageFlagBits::COMPUTE_BIT);
+    ds_create_info_ptr->add_binding(1, /* in_binding_index */
+                                    Anvil::DescriptorType::STORAGE_BUFFER,
+                                    1, /* in_descriptor_array_size */
+                                    Anvil::ShaderStageFlagBits::COMPUTE_BIT);
+
+    m_ds_layout_ptr = Anvil::DescriptorSetLayout::create(std::move(ds_create_info_ptr),
+                                                         m_device_ptr);
+
+    if (m_ds_layout_ptr == nullptr)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    ds_create_info_ptrs.push_back(m_ds_layout_ptr->get_create_info() );
+
+    pipeline_create_info_ptr = Anvil::ComputePipelineCreateInfo::create(Anvil::PipelineCreateFlagBits::NONE,
+                                                                        *m_entrypoint_ptr);
+
+    if (pipeline_create_info_ptr == nullptr)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    pipeline_create_info_ptr->attach_push_constant_range(0, /* in_offset */
+                                                         sizeof(PushConstants),
+                                                         Anvil::ShaderStageFlagBits::COMPUTE_BIT);
+    pipeline_create_info_ptr->set_descriptor_set_create_info(&ds_create_info_ptrs);
+
+    if (!m_device_ptr->get_compute_pipeline_manager()->add_pipeline(std::move(pipeline_create_info_ptr),
+                                                                    &m_pipeline_id) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (!m_device_ptr->get_compute_pipeline_manager()->bake() )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    m_ds_cache_ptr = Anvil::DescriptorSetCache::create(m_device_ptr,
+                                                       4,  /* in_n_sets_per_pool             */
+                                                       8); /* in_n_descriptors_per_type_pool */
+
+    result = (m_ds_cache_ptr != nullptr);
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::GPUDecompressor::record_decompress(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                               Anvil::Buffer*            in_src_buffer_ptr,
+                                               VkDeviceSize              in_chunk_table_offset,
+                                               uint32_t                  in_n_chunks,
+                                               Anvil::Buffer*            in_dst_buffer_ptr)
+{
+    Anvil::DescriptorSetCache::Contents ds_contents;
+    Anvil::DescriptorSet*               ds_ptr           = nullptr;
+    Anvil::PipelineLayout*              pipeline_layout_ptr;
+    PushConstants                       push_constants;
+    bool                                result           = false;
+
+    if (in_cmd_buffer_ptr == nullptr ||
+        in_src_buffer_ptr == nullptr ||
+        in_dst_buffer_ptr == nullptr)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if ((in_chunk_table_offset % sizeof(uint32_t)) != 0)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (in_n_chunks == 0)
+    {
+        result = true;
+
+        goto end;
+    }
+
+    ds_contents.set_binding_item(0, /* in_binding_index */
+                                 Anvil::DescriptorSet::StorageBufferBindingElement(in_src_buffer_ptr) );
+    ds_contents.set_binding_item(1, /* in_binding_index */
+                                 Anvil::DescriptorSet::StorageBufferBindingElement(in_dst_buffer_ptr) );
+
+    ds_ptr = m_ds_cache_ptr->get_descriptor_set(m_ds_layout_ptr.get(),
+                                                ds_contents);
+
+    if (ds_ptr == nullptr)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    pipeline_layout_ptr = m_device_ptr->get_compute_pipeline_manager()->get_pipeline_layout(m_pipeline_id);
+
+    push_constants.chunk_table_offset = static_cast<uint32_t>(in_chunk_table_offset / sizeof(uint32_t) );
+    push_constants.n_chunks           = in_n_chunks;
+
+    in_cmd_buffer_ptr->record_bind_pipeline       (Anvil::PipelineBindPoint::COMPUTE,
+                                                   m_pipeline_id);
+    in_cmd_buffer_ptr->record_bind_descriptor_sets(Anvil::PipelineBindPoint::COMPUTE,
+                                                   pipeline_layout_ptr,
+                                                   0, /* in_first_set */
+                                                   1, /* in_set_count */
+                                                  &ds_ptr,
+                                                   0,        /* in_dynamic_offset_count */
+                                                   nullptr); /* in_dynamic_offset_ptrs  */
+    in_cmd_buffer_ptr->record_push_constants      (pipeline_layout_ptr,
+                                                   Anvil::ShaderStageFlagBits::COMPUTE_BIT,
+                                                   0, /* in_offset */
+                                                   sizeof(push_constants),
+                                                   &push_constants);
+    in_cmd_buffer_ptr->record_dispatch            ((in_n_chunks + N_INVOCATIONS_PER_WORKGROUP - 1) / N_INVOCATIONS_PER_WORKGROUP,
+                                                   1,  /* in_y */
+                                                   1); /* in_z */
+
+    result = true;
+end:
+    return result;
+}
@@ -0,0 +1,316 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/gpu_profiler.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/device.h"
+#include "wrappers/query_pool.h"
+
+
+/** Please see header for specification */
+Anvil::GPUProfiler::GPUProfiler(const Anvil::BaseDevice* in_device_ptr,
+                                uint32_t                 in_n_frames_in_flight,
+                                uint32_t                 in_n_max_regions_per_frame)
+    :m_device_ptr             (in_device_ptr),
+     m_frames                 (in_n_frames_in_flight),
+     m_has_last_frame_timings (false),
+     m_n_current_frame        (in_n_frames_in_flight - 1),
+     m_n_dropped_frames       (0),
+     m_n_max_regions_per_frame(in_n_max_regions_per_frame),
+     m_next_frame_index       (0),
+     m_timestamp_period       (1.0)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::GPUProfiler::~GPUProfiler()
+{
+    anvil_assert(m_open_regions.empty() );
+}
+
+/** Please see header for specification */
+bool Anvil::GPUProfiler::begin_frame(Anvil::CommandBufferBase* in_cmd_buffer_ptr)
+{
+    Frame* frame_ptr = nullptr;
+    bool   result    = false;
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    if (!m_open_regions.empty() )
+    {
+        anvil_assert(m_open_regions.empty() );
+
+        m_open_regions.clear();
+    }
+
+    /* begin_frame() advances to the next slot before using it, so the first call picks slot 0. */
+    m_n_current_frame = (m_n_current_frame + 1) % static_cast<uint32_t>(m_frames.size() );
+    frame_ptr         = &m_frames.at(m_n_current_frame);
+
+    if (frame_ptr->is_pending)
+    {
+        read_back_frame(frame_ptr,
+                        m_n_current_frame);
+    }
+
+    frame_ptr->frame_index = m_next_frame_index++;
+    frame_ptr->is_pending  = false;
+    frame_ptr->regions.clear();
+
+    if (m_query_pool_ptr != nullptr)
+    {
+        if (!in_cmd_buffer_ptr->record_reset_query_pool(m_query_pool_ptr.get(),
+                                                        m_n_current_frame * m_n_max_regions_per_frame * 2,
+                                                        m_n_max_regions_per_frame                     * 2) )
+        {
+            goto end;
+        }
+
+        frame_ptr->is_pending = true;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::GPUProfiler::begin_region(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                      const std::string&        in_name,
+                                      const float*              in_opt_color)
+{
+    static const float default_color[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+    Frame&   current_frame = m_frames.at(m_n_current_frame);
+    uint32_t region_index  = UINT32_MAX;
+    bool     result        = false;
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    if (m_next_frame_index == 0)
+    {
+        /* begin_frame() has not been called yet, so the queries have not been reset */
+        anvil_assert(m_next_frame_index != 0);
+
+        goto end;
+    }
+
+    if (m_query_pool_ptr         != nullptr                   &&
+        current_frame.is_pending                                &&
+        current_frame.regions.size() <  m_n_max_regions_per_frame)
+    {
+        Region new_region;
+
+        region_index = static_cast<uint32_t>(current_frame.regions.size() );
+
+        if (!in_cmd_buffer_ptr->record_write_timestamp(Anvil::PipelineStageFlagBits::TOP_OF_PIPE_BIT,
+                                                       m_query_pool_ptr.get(),
+                                                       (m_n_current_frame * m_n_max_regions_per_frame + region_index) * 2) )
+        {
+            goto end;
+        }
+
+        /* Regions never fit in a frame whose parent did not, so the parent is either top-level or a recorded region */
+        new_region.depth        = static_cast<uint32_t>(m_open_regions.size() );
+        new_region.name         = in_name;
+        new_region.parent_index = (m_open_regions.size() > 0) ? m_open_regions.back()
+                                                              : UINT32_MAX;
+
+        current_frame.regions.push_back(new_region);
+    }
+
+    m_open_regions.push_back(region_index);
+
+    if (m_device_ptr->get_extension_info()->ext_debug_marker() )
+    {
+        result = in_cmd_buffer_ptr->record_debug_marker_begin_EXT(in_name,
+                                                                  in_opt_color);
+    }
+    else
+    {
+        in_cmd_buffer_ptr->begin_debug_utils_label(in_name.c_str(),
+                                                   (in_opt_color != nullptr) ? in_opt_color : default_color);
+
+        result = true;
+    }
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::GPUProfilerUniquePtr Anvil::GPUProfiler::create(const Anvil::BaseDevice* in_device_ptr,
+                                                       uint32_t                 in_n_frames_in_flight,
+                                                       uint32_t                 in_n_max_regions_per_frame)
+{
+    Anvil::GPUProfilerUniquePtr result_ptr(nullptr,
+                                           std::default_delete<Anvil::GPUProfiler>() );
+
+    anvil_assert(in_device_ptr              != nullptr);
+    anvil_assert(in_n_frames_in_flight      >  0);
+    anvil_assert(in_n_max_regions_per_frame >  0);
+
+    result_ptr.reset(
+        new Anvil::GPUProfiler(in_device_ptr,
+                               in_n_frames_in_flight,
+                               in_n_max_regions_per_frame)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init() )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+bool Anvil::GPUProfiler::end_region(Anvil::CommandBufferBase* in_cmd_buffer_ptr)
+{
+    uint32_t region_index = UINT32_MAX;
+    bool     result       = false;
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    if (m_open_regions.empty() )
+    {
+        anvil_assert(!m_open_regions.empty() );
+
+        goto end;
+    }
+
+    region_index = m_open_regions.back();
+
+    m_open_regions.pop_back();
+
+    if (region_index != UINT32_MAX)
+    {
+        if (!in_cmd_buffer_ptr->record_write_timestamp(Anvil::PipelineStageFlagBits::BOTTOM_OF_PIPE_BIT,
+                                                       m_query_pool_ptr.get(),
+                                                       (m_n_current_frame * m_n_max_regions_per_frame + region_index) * 2 + 1) )
+        {
+            goto end;
+        }
+    }
+
+    if (m_device_ptr->get_extension_info()->ext_debug_marker() )
+    {
+        result = in_cmd_buffer_ptr->record_debug_marker_end_EXT();
+    }
+    else
+    {
+        in_cmd_buffer_ptr->end_debug_utils_label();
+
+        result = true;
+    }
+
+end:
+    return result;
+}
+
+/** Creates the timestamp query pool, if timestamps are supported by the device.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::GPUProfiler::init()
+{
+    const auto& limits = m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits;
+    bool        result = false;
+
+    if (limits.timestamp_compute_and_graphics)
+    {
+        m_query_pool_ptr = Anvil::QueryPool::create_non_ps_query_pool(m_device_ptr,
+                                                                      VK_QUERY_TYPE_TIMESTAMP,
+                                                                      static_cast<uint32_t>(m_frames.size() ) * m_n_max_regions_per_frame * 2);
+
+        if (m_query_pool_ptr == nullptr)
+        {
+            anvil_assert(m_query_pool_ptr != nullptr);
+
+            goto end;
+        }
+
+        m_timestamp_period = static_cast<double>(limits.timestamp_period);
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Retrieves the timestamps of the specified frame without waiting and, if all of them are available, replaces
+ *  the last frame timings with the frame's results. Otherwise, the frame is dropped.
+ *
+ *  @param in_frame_ptr Frame to read back. Must not be null.
+ *  @param in_n_frame   Index of the frame's slot.
+ */
+void Anvil::GPUProfiler::read_back_frame(Frame*   in_frame_ptr,
+                                         uint32_t in_n_frame)
+{
+    const uint32_t n_regions = static_cast<uint32_t>(in_frame_ptr->regions.size() );
+
+    if (n_regions > 0)
+    {
+        bool all_results_retrieved = false;
+
+        m_query_results.resize(n_regions * 2);
+
+        if (!m_query_pool_ptr->get_query_pool_results(in_n_frame * m_n_max_regions_per_frame * 2, /* in_first_query_index */
+                                                      n_regions * 2,                               /* in_n_queries         */
+                                                      Anvil::QueryResultFlagBits::NONE,
+                                                     &m_query_results.at(0),
+                                                     &all_results_retrieved) ||
+            !all_results_retrieved)
+        {
+            m_n_dropped_frames++;
+
+            goto end;
+        }
+    }
+
+    m_last_frame_timings.frame_index = in_frame_ptr->frame_index;
+
+    m_last_frame_timings.regions.resize(n_regions);
+
+    for (uint32_t n_region = 0;
+                  n_region < n_regions;
+                ++n_region)
+    {
+        const Region&  src_region = in_frame_ptr->regions.at(n_region);
+        RegionTimings& dst_region = m_last_frame_timings.regions.at(n_region);
+
+        dst_region.depth        = src_region.depth;
+        dst_region.end_time     = static_cast<uint64_t>(static_cast<double>(m_query_results.at(n_region * 2 + 1) ) * m_timestamp_period);
+        dst_region.name         = src_region.name;
+        dst_region.parent_index = src_region.parent_index;
+        dst_region.start_time   = static_cast<uint64_t>(static_cast<double>(m_query_results.at(n_region * 2)     ) * m_timestamp_period);
+    }
+
+    m_has_last_frame_timings = true;
+end:
+    ;
+}
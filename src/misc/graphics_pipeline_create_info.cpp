@@ -19,6 +19,7 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 //
+#include "misc/descriptor_set_create_info.h"
 #include "misc/graphics_pipeline_create_info.h"
 #include "misc/render_pass_create_info.h"
 #include "wrappers/device.h"
@@ -52,11 +53,17 @@ Anvil::GraphicsPipelineCreateInfo::GraphicsPipelineCreateInfo(const RenderPass*
     m_sample_locations_enabled             = false;
     m_sample_mask_enabled                  = false;
     m_sample_shading_enabled               = false;
+    m_shading_rate_image_enabled           = false;
     m_stencil_test_enabled                 = false;
 
     m_renderpass_ptr = in_renderpass_ptr;
     m_subpass_id     = in_subpass_id;
 
+    m_rendering_depth_attachment_format   = Anvil::Format::UNKNOWN;
+    m_rendering_stencil_attachment_format = Anvil::Format::UNKNOWN;
+    m_rendering_view_mask                 = 0;
+    m_uses_dynamic_rendering              = false;
+
     m_stencil_state_back_face.compareMask = ~0u;
     m_stencil_state_back_face.compareOp   = VK_COMPARE_OP_ALWAYS;
     m_stencil_state_back_face.depthFailOp = VK_STENCIL_OP_KEEP;
@@ -152,6 +159,60 @@ bool Anvil::GraphicsPipelineCreateInfo::are_depth_writes_enabled() const
     return m_depth_writes_enabled;
 }
 
+/* Please see header for specification */
+Anvil::GraphicsPipelineCreateInfoUniquePtr Anvil::GraphicsPipelineCreateInfo::clone_with(const PermutationFunction& in_opt_permutation_func) const
+{
+    Anvil::GraphicsPipelineCreateInfoUniquePtr result_ptr(nullptr,
+                                                          std::default_delete<Anvil::GraphicsPipelineCreateInfo>() );
+
+    if (is_proxy() )
+    {
+        anvil_assert(!is_proxy() );
+
+        goto end;
+    }
+
+    result_ptr.reset(
+        new GraphicsPipelineCreateInfo(m_renderpass_ptr,
+                                       m_subpass_id)
+    );
+
+    if (result_ptr == nullptr)
+    {
+        anvil_assert(result_ptr != nullptr);
+
+        goto end;
+    }
+
+    /* NOTE: Base pipeline ID, create flags & shader stages are overwritten by copy_gfx_state_from() */
+    result_ptr->init(get_create_flags(),
+                     0,        /* in_n_shader_module_stage_entrypoints   */
+                     nullptr,  /* in_shader_module_stage_entrypoint_ptrs */
+                     nullptr); /* in_opt_base_pipeline_id_ptr            */
+
+    if (!result_ptr->copy_gfx_state_from(this) )
+    {
+        anvil_assert_fail();
+
+        result_ptr.reset();
+        goto end;
+    }
+
+    result_ptr->m_rendering_color_attachment_formats  = m_rendering_color_attachment_formats;
+    result_ptr->m_rendering_depth_attachment_format   = m_rendering_depth_attachment_format;
+    result_ptr->m_rendering_stencil_attachment_format = m_rendering_stencil_attachment_format;
+    result_ptr->m_rendering_view_mask                 = m_rendering_view_mask;
+    result_ptr->m_uses_dynamic_rendering              = m_uses_dynamic_rendering;
+
+    if (in_opt_permutation_func != nullptr)
+    {
+        in_opt_permutation_func(result_ptr.get() );
+    }
+
+end:
+    return result_ptr;
+}
+
 bool Anvil::GraphicsPipelineCreateInfo::copy_gfx_state_from(const Anvil::GraphicsPipelineCreateInfo* in_src_pipeline_create_info_ptr)
 {
     bool result = false;
@@ -203,6 +264,9 @@ bool Anvil::GraphicsPipelineCreateInfo::copy_gfx_state_from(const Anvil::Graphic
     m_conservative_rasterization_mode     = in_src_pipeline_create_info_ptr->m_conservative_rasterization_mode;
     m_extra_primitive_overestimation_size = in_src_pipeline_create_info_ptr->m_extra_primitive_overestimation_size;
 
+    m_shading_rate_image_enabled = in_src_pipeline_create_info_ptr->m_shading_rate_image_enabled;
+    m_shading_rate_palettes      = in_src_pipeline_create_info_ptr->m_shading_rate_palettes;
+
     m_tessellation_domain_origin = in_src_pipeline_create_info_ptr->m_tessellation_domain_origin;
 
     m_bindings                               = in_src_pipeline_create_info_ptr->m_bindings;
@@ -220,6 +284,7 @@ bool Anvil::GraphicsPipelineCreateInfo::copy_gfx_state_from(const Anvil::Graphic
     m_n_dynamic_viewports                    = in_src_pipeline_create_info_ptr->m_n_dynamic_viewports;
     m_n_patch_control_points                 = in_src_pipeline_create_info_ptr->m_n_patch_control_points;
     m_primitive_topology                     = in_src_pipeline_create_info_ptr->m_primitive_topology;
+    m_rasterization_stream_index             = in_src_pipeline_create_info_ptr->m_rasterization_stream_index;
     m_sample_count                           = in_src_pipeline_create_info_ptr->m_sample_count;
     m_sample_mask                            = in_src_pipeline_create_info_ptr->m_sample_mask;
     m_scissor_boxes                          = in_src_pipeline_create_info_ptr->m_scissor_boxes;
@@ -283,6 +348,57 @@ Anvil::GraphicsPipelineCreateInfoUniquePtr Anvil::GraphicsPipelineCreateInfo::cr
     return result_ptr;
 }
 
+Anvil::GraphicsPipelineCreateInfoUniquePtr Anvil::GraphicsPipelineCreateInfo::create_for_dynamic_rendering(const Anvil::PipelineCreateFlags&        in_create_flags,
+                                                                                                           uint32_t                                 in_view_mask,
+                                                                                                           uint32_t                                 in_n_color_attachment_formats,
+                                                                                                           const Anvil::Format*                     in_opt_color_attachment_formats_ptr,
+                                                                                                           Anvil::Format                            in_depth_attachment_format,
+                                                                                                           Anvil::Format                            in_stencil_attachment_format,
+                                                                                                           const ShaderModuleStageEntryPoint&       in_fragment_shader_stage_entrypoint_info,
+                                                                                                           const ShaderModuleStageEntryPoint&       in_geometry_shader_stage_entrypoint_info,
+                                                                                                           const ShaderModuleStageEntryPoint&       in_tess_control_shader_stage_entrypoint_info,
+                                                                                                           const ShaderModuleStageEntryPoint&       in_tess_evaluation_shader_stage_entrypoint_info,
+                                                                                                           const ShaderModuleStageEntryPoint&       in_vertex_shader_shader_stage_entrypoint_info,
+                                                                                                           const Anvil::GraphicsPipelineCreateInfo* in_opt_reference_pipeline_info_ptr,
+                                                                                                           const Anvil::PipelineID*                 in_opt_base_pipeline_id_ptr)
+{
+    Anvil::GraphicsPipelineCreateInfoUniquePtr result_ptr(nullptr,
+                                                          std::default_delete<Anvil::GraphicsPipelineCreateInfo>() );
+
+    if (in_n_color_attachment_formats       >  0       &&
+        in_opt_color_attachment_formats_ptr == nullptr)
+    {
+        anvil_assert(in_opt_color_attachment_formats_ptr != nullptr);
+
+        goto end;
+    }
+
+    result_ptr = create(in_create_flags,
+                        nullptr, /* in_renderpass_ptr */
+                        0,       /* in_subpass_id     */
+                        in_fragment_shader_stage_entrypoint_info,
+                        in_geometry_shader_stage_entrypoint_info,
+                        in_tess_control_shader_stage_entrypoint_info,
+                        in_tess_evaluation_shader_stage_entrypoint_info,
+                        in_vertex_shader_shader_stage_entrypoint_info,
+                        in_opt_reference_pipeline_info_ptr,
+                        in_opt_base_pipeline_id_ptr);
+
+    if (result_ptr != nullptr)
+    {
+        result_ptr->m_rendering_color_attachment_formats.assign(in_opt_color_attachment_formats_ptr,
+                                                                in_opt_color_attachment_formats_ptr + in_n_color_attachment_formats);
+
+        result_ptr->m_rendering_depth_attachment_format   = in_depth_attachment_format;
+        result_ptr->m_rendering_stencil_attachment_format = in_stencil_attachment_format;
+        result_ptr->m_rendering_view_mask                 = in_view_mask;
+        result_ptr->m_uses_dynamic_rendering              = true;
+    }
+
+end:
+    return result_ptr;
+}
+
 Anvil::GraphicsPipelineCreateInfoUniquePtr Anvil::GraphicsPipelineCreateInfo::create_proxy()
 {
     Anvil::GraphicsPipelineCreateInfoUniquePtr result_ptr(nullptr,
@@ -481,6 +597,16 @@ void Anvil::GraphicsPipelineCreateInfo::get_graphics_pipeline_properties(uint32_
     }
 }
 
+uint64_t Anvil::GraphicsPipelineCreateInfo::get_hash() const
+{
+    std::vector<uint64_t> words;
+
+    get_state_words(&words);
+
+    return Anvil::Utils::hash64(&words.at(0),
+                                words.size() * sizeof(words.at(0) ));
+}
+
 void Anvil::GraphicsPipelineCreateInfo::get_logic_op_state(bool*           out_opt_is_enabled_ptr,
                                                            Anvil::LogicOp* out_opt_logic_op_ptr) const
 {
@@ -575,6 +701,41 @@ void Anvil::GraphicsPipelineCreateInfo::get_rasterization_properties(Anvil::Poly
     }
 }
 
+void Anvil::GraphicsPipelineCreateInfo::get_rendering_properties(uint32_t*             out_opt_view_mask_ptr,
+                                                                 uint32_t*             out_opt_n_color_attachment_formats_ptr,
+                                                                 const Anvil::Format** out_opt_color_attachment_formats_ptr_ptr,
+                                                                 Anvil::Format*        out_opt_depth_attachment_format_ptr,
+                                                                 Anvil::Format*        out_opt_stencil_attachment_format_ptr) const
+{
+    anvil_assert(m_uses_dynamic_rendering);
+
+    if (out_opt_view_mask_ptr != nullptr)
+    {
+        *out_opt_view_mask_ptr = m_rendering_view_mask;
+    }
+
+    if (out_opt_n_color_attachment_formats_ptr != nullptr)
+    {
+        *out_opt_n_color_attachment_formats_ptr = static_cast<uint32_t>(m_rendering_color_attachment_formats.size() );
+    }
+
+    if (out_opt_color_attachment_formats_ptr_ptr != nullptr)
+    {
+        *out_opt_color_attachment_formats_ptr_ptr = (m_rendering_color_attachment_formats.size() > 0) ? &m_rendering_color_attachment_formats.at(0)
+                                                                                                      : nullptr;
+    }
+
+    if (out_opt_depth_attachment_format_ptr != nullptr)
+    {
+        *out_opt_depth_attachment_format_ptr = m_rendering_depth_attachment_format;
+    }
+
+    if (out_opt_stencil_attachment_format_ptr != nullptr)
+    {
+        *out_opt_stencil_attachment_format_ptr = m_rendering_stencil_attachment_format;
+    }
+}
+
 void Anvil::GraphicsPipelineCreateInfo::get_sample_location_state(bool*                         out_opt_is_enabled_ptr,
                                                                   Anvil::SampleCountFlagBits*   out_opt_sample_locations_per_pixel_ptr,
                                                                   VkExtent2D*                   out_opt_sample_location_grid_size_ptr,
@@ -667,6 +828,278 @@ end:
     return result;
 }
 
+bool Anvil::GraphicsPipelineCreateInfo::get_shading_rate_palette(uint32_t                                 in_n_viewport,
+                                                                 uint32_t*                                out_opt_n_entries_ptr,
+                                                                 const Anvil::ShadingRatePaletteEntryNV** out_opt_entries_ptr_ptr) const
+{
+    auto palette_iterator = m_shading_rate_palettes.find(in_n_viewport);
+    bool result           = false;
+
+    if (palette_iterator == m_shading_rate_palettes.end() )
+    {
+        goto end;
+    }
+
+    if (out_opt_n_entries_ptr != nullptr)
+    {
+        *out_opt_n_entries_ptr = static_cast<uint32_t>(palette_iterator->second.size() );
+    }
+
+    if (out_opt_entries_ptr_ptr != nullptr)
+    {
+        *out_opt_entries_ptr_ptr = &palette_iterator->second.at(0);
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Serializes all state which affects the pipeline object to a vector of words. Two create info instances
+ *  produce identical vectors if, and only if, they describe the same pipeline, with the exception of descriptor
+ *  set create info items, which are represented by their hashes.
+ *
+ *  Floating-point values are stored bitwise.
+ *
+ *  @param out_words_ptr Deref will be set to the serialized state. Must not be null.
+ */
+void Anvil::GraphicsPipelineCreateInfo::get_state_words(std::vector<uint64_t>* out_words_ptr) const
+{
+    auto push_float = [=](float in_value)
+    {
+        uint32_t value_bits = 0;
+
+        memcpy(&value_bits,
+               &in_value,
+               sizeof(value_bits) );
+
+        out_words_ptr->push_back(value_bits);
+    };
+
+    auto push_stencil_op_state = [=](const VkStencilOpState& in_state)
+    {
+        out_words_ptr->push_back(in_state.compareMask);
+        out_words_ptr->push_back(in_state.compareOp);
+        out_words_ptr->push_back(in_state.depthFailOp);
+        out_words_ptr->push_back(in_state.failOp);
+        out_words_ptr->push_back(in_state.passOp);
+        out_words_ptr->push_back(in_state.reference);
+        out_words_ptr->push_back(in_state.writeMask);
+    };
+
+    out_words_ptr->clear();
+
+    /* Base pipeline state */
+    out_words_ptr->push_back(m_base_pipeline_id);
+    out_words_ptr->push_back(m_create_flags.get_vk() );
+    out_words_ptr->push_back((m_is_proxy) ? 1 : 0);
+
+    out_words_ptr->push_back(m_ds_create_info_items.size() );
+
+    for (const auto& current_ds_create_info_ptr : m_ds_create_info_items)
+    {
+        out_words_ptr->push_back((current_ds_create_info_ptr != nullptr) ? current_ds_create_info_ptr->get_hash()
+                                                                         : 0);
+    }
+
+    out_words_ptr->push_back(m_push_constant_ranges.size() );
+
+    for (const auto& current_range : m_push_constant_ranges)
+    {
+        out_words_ptr->push_back(current_range.offset);
+        out_words_ptr->push_back(current_range.size);
+        out_words_ptr->push_back(current_range.stages.get_vk() );
+    }
+
+    out_words_ptr->push_back(m_shader_stages.size() );
+
+    for (const auto& current_shader_stage : m_shader_stages)
+    {
+        out_words_ptr->push_back(static_cast<uint64_t>(current_shader_stage.first) );
+        out_words_ptr->push_back(reinterpret_cast<uintptr_t>(current_shader_stage.second.shader_module_ptr) );
+        out_words_ptr->push_back(current_shader_stage.second.name.size() );
+
+        for (const auto& current_char : current_shader_stage.second.name)
+        {
+            out_words_ptr->push_back(static_cast<unsigned char>(current_char) );
+        }
+    }
+
+    out_words_ptr->push_back(m_specialization_constants_map.size() );
+
+    for (const auto& current_stage_constants : m_specialization_constants_map)
+    {
+        out_words_ptr->push_back(static_cast<uint64_t>(current_stage_constants.first) );
+        out_words_ptr->push_back(current_stage_constants.second.size() );
+
+        for (const auto& current_constant : current_stage_constants.second)
+        {
+            out_words_ptr->push_back(current_constant.constant_id);
+            out_words_ptr->push_back(current_constant.n_bytes);
+
+            for (uint32_t n_byte = 0;
+                          n_byte < current_constant.n_bytes;
+                        ++n_byte)
+            {
+                out_words_ptr->push_back(m_specialization_constants_data_buffer.at(current_constant.start_offset + n_byte) );
+            }
+        }
+    }
+
+    /* Graphics pipeline state */
+    out_words_ptr->push_back(reinterpret_cast<uintptr_t>(m_renderpass_ptr) );
+    out_words_ptr->push_back(m_subpass_id);
+
+    out_words_ptr->push_back((m_uses_dynamic_rendering) ? 1 : 0);
+    out_words_ptr->push_back(m_rendering_view_mask);
+    out_words_ptr->push_back(static_cast<uint64_t>(m_rendering_depth_attachment_format) );
+    out_words_ptr->push_back(static_cast<uint64_t>(m_rendering_stencil_attachment_format) );
+    out_words_ptr->push_back(m_rendering_color_attachment_formats.size() );
+
+    for (const auto& current_format : m_rendering_color_attachment_formats)
+    {
+        out_words_ptr->push_back(static_cast<uint64_t>(current_format) );
+    }
+
+    out_words_ptr->push_back((m_alpha_to_coverage_enabled)  ? 1 : 0);
+    out_words_ptr->push_back((m_alpha_to_one_enabled)       ? 1 : 0);
+    out_words_ptr->push_back((m_depth_bias_enabled)         ? 1 : 0);
+    out_words_ptr->push_back((m_depth_bounds_test_enabled)  ? 1 : 0);
+    out_words_ptr->push_back((m_depth_clamp_enabled)        ? 1 : 0);
+    out_words_ptr->push_back((m_depth_clip_enabled)         ? 1 : 0);
+    out_words_ptr->push_back((m_depth_test_enabled)         ? 1 : 0);
+    out_words_ptr->push_back((m_depth_writes_enabled)       ? 1 : 0);
+    out_words_ptr->push_back((m_logic_op_enabled)           ? 1 : 0);
+    out_words_ptr->push_back((m_primitive_restart_enabled)  ? 1 : 0);
+    out_words_ptr->push_back((m_rasterizer_discard_enabled) ? 1 : 0);
+    out_words_ptr->push_back((m_sample_locations_enabled)   ? 1 : 0);
+    out_words_ptr->push_back((m_sample_mask_enabled)        ? 1 : 0);
+    out_words_ptr->push_back((m_sample_shading_enabled)     ? 1 : 0);
+    out_words_ptr->push_back((m_shading_rate_image_enabled) ? 1 : 0);
+    out_words_ptr->push_back((m_stencil_test_enabled)       ? 1 : 0);
+
+    push_float(m_blend_constant[0]);
+    push_float(m_blend_constant[1]);
+    push_float(m_blend_constant[2]);
+    push_float(m_blend_constant[3]);
+    push_float(m_depth_bias_clamp);
+    push_float(m_depth_bias_constant_factor);
+    push_float(m_depth_bias_slope_factor);
+    push_float(m_extra_primitive_overestimation_size);
+    push_float(m_line_width);
+    push_float(m_max_depth_bounds);
+    push_float(m_min_depth_bounds);
+    push_float(m_min_sample_shading);
+
+    out_words_ptr->push_back(static_cast<uint64_t>(m_conservative_rasterization_mode) );
+    out_words_ptr->push_back(m_cull_mode.get_vk() );
+    out_words_ptr->push_back(static_cast<uint64_t>(m_depth_test_compare_op) );
+    out_words_ptr->push_back(static_cast<uint64_t>(m_front_face) );
+    out_words_ptr->push_back(static_cast<uint64_t>(m_logic_op) );
+    out_words_ptr->push_back(m_n_dynamic_scissor_boxes);
+    out_words_ptr->push_back(m_n_dynamic_viewports);
+    out_words_ptr->push_back(m_n_patch_control_points);
+    out_words_ptr->push_back(static_cast<uint64_t>(m_polygon_mode) );
+    out_words_ptr->push_back(static_cast<uint64_t>(m_primitive_topology) );
+    out_words_ptr->push_back(static_cast<uint64_t>(m_rasterization_order) );
+    out_words_ptr->push_back(m_rasterization_stream_index);
+    out_words_ptr->push_back(static_cast<uint64_t>(m_sample_count) );
+    out_words_ptr->push_back(m_sample_mask);
+    out_words_ptr->push_back(static_cast<uint64_t>(m_tessellation_domain_origin) );
+
+    push_stencil_op_state(m_stencil_state_back_face);
+    push_stencil_op_state(m_stencil_state_front_face);
+
+    out_words_ptr->push_back(m_enabled_dynamic_states.size() );
+
+    for (const auto& current_dynamic_state : m_enabled_dynamic_states)
+    {
+        out_words_ptr->push_back(static_cast<uint64_t>(current_dynamic_state) );
+    }
+
+    out_words_ptr->push_back(m_sample_location_grid_size.height);
+    out_words_ptr->push_back(m_sample_location_grid_size.width);
+    out_words_ptr->push_back(static_cast<uint64_t>(m_sample_locations_per_pixel) );
+    out_words_ptr->push_back(m_sample_locations.size() );
+
+    for (const auto& current_sample_location : m_sample_locations)
+    {
+        push_float(current_sample_location.x);
+        push_float(current_sample_location.y);
+    }
+
+    out_words_ptr->push_back(m_bindings.size() );
+
+    for (const auto& current_binding : m_bindings)
+    {
+        out_words_ptr->push_back(current_binding.first);
+        out_words_ptr->push_back(current_binding.second.divisor);
+        out_words_ptr->push_back(static_cast<uint64_t>(current_binding.second.rate) );
+        out_words_ptr->push_back(current_binding.second.stride_in_bytes);
+        out_words_ptr->push_back(current_binding.second.attributes.size() );
+
+        for (const auto& current_attribute : current_binding.second.attributes)
+        {
+            out_words_ptr->push_back(static_cast<uint64_t>(current_attribute.format) );
+            out_words_ptr->push_back(current_attribute.location);
+            out_words_ptr->push_back(current_attribute.offset_in_bytes);
+        }
+    }
+
+    out_words_ptr->push_back(m_scissor_boxes.size() );
+
+    for (const auto& current_scissor_box : m_scissor_boxes)
+    {
+        out_words_ptr->push_back(current_scissor_box.first);
+        out_words_ptr->push_back(current_scissor_box.second.height);
+        out_words_ptr->push_back(current_scissor_box.second.width);
+        out_words_ptr->push_back(static_cast<uint32_t>(current_scissor_box.second.x) );
+        out_words_ptr->push_back(static_cast<uint32_t>(current_scissor_box.second.y) );
+    }
+
+    out_words_ptr->push_back(m_shading_rate_palettes.size() );
+
+    for (const auto& current_palette : m_shading_rate_palettes)
+    {
+        out_words_ptr->push_back(current_palette.first);
+        out_words_ptr->push_back(current_palette.second.size() );
+
+        for (const auto& current_entry : current_palette.second)
+        {
+            out_words_ptr->push_back(static_cast<uint64_t>(current_entry) );
+        }
+    }
+
+    out_words_ptr->push_back(m_subpass_attachment_blending_properties.size() );
+
+    for (const auto& current_attachment : m_subpass_attachment_blending_properties)
+    {
+        out_words_ptr->push_back(current_attachment.first);
+        out_words_ptr->push_back((current_attachment.second.blend_enabled) ? 1 : 0);
+        out_words_ptr->push_back(static_cast<uint64_t>(current_attachment.second.blend_op_alpha) );
+        out_words_ptr->push_back(static_cast<uint64_t>(current_attachment.second.blend_op_color) );
+        out_words_ptr->push_back(current_attachment.second.channel_write_mask.get_vk() );
+        out_words_ptr->push_back(static_cast<uint64_t>(current_attachment.second.dst_alpha_blend_factor) );
+        out_words_ptr->push_back(static_cast<uint64_t>(current_attachment.second.dst_color_blend_factor) );
+        out_words_ptr->push_back(static_cast<uint64_t>(current_attachment.second.src_alpha_blend_factor) );
+        out_words_ptr->push_back(static_cast<uint64_t>(current_attachment.second.src_color_blend_factor) );
+    }
+
+    out_words_ptr->push_back(m_viewports.size() );
+
+    for (const auto& current_viewport : m_viewports)
+    {
+        out_words_ptr->push_back(current_viewport.first);
+
+        push_float(current_viewport.second.height);
+        push_float(current_viewport.second.max_depth);
+        push_float(current_viewport.second.min_depth);
+        push_float(current_viewport.second.origin_x);
+        push_float(current_viewport.second.origin_y);
+        push_float(current_viewport.second.width);
+    }
+}
+
 void Anvil::GraphicsPipelineCreateInfo::get_stencil_test_properties(bool*             out_opt_is_enabled_ptr,
                                                                     Anvil::StencilOp* out_opt_front_stencil_fail_op_ptr,
                                                                     Anvil::StencilOp* out_opt_front_stencil_pass_op_ptr,
@@ -776,26 +1209,14 @@ bool Anvil::GraphicsPipelineCreateInfo::get_vertex_binding_properties(uint32_t
     const InternalVertexBinding* binding_ptr      = nullptr;
     bool                         result           = false;
 
-    if (m_bindings.size() < in_n_vertex_binding)
+    if (m_bindings.size() <= in_n_vertex_binding)
     {
         goto end;
     }
     else
     {
-        uint32_t n_item           = 0;
-
-        while (n_item != in_n_vertex_binding)
-        {
-            binding_iterator++;
-            n_item          ++;
-
-            if (binding_iterator == m_bindings.end() )
-            {
-                goto end;
-            }
-        }
-
-        binding_ptr = &binding_iterator->second;
+        binding_iterator += in_n_vertex_binding;
+        binding_ptr       = &binding_iterator->second;
     }
 
     if (out_opt_binding_ptr != nullptr)
@@ -956,6 +1377,64 @@ void Anvil::GraphicsPipelineCreateInfo::set_color_blend_attachment_properties(Su
     attachment_blending_props_ptr->src_color_blend_factor = in_src_color_blend_factor;
 }
 
+bool Anvil::GraphicsPipelineCreateInfo::set_mesh_shading_stages(const ShaderModuleStageEntryPoint& in_mesh_shader_stage_entrypoint_info,
+                                                                const ShaderModuleStageEntryPoint& in_opt_task_shader_stage_entrypoint_info)
+{
+    static const Anvil::ShaderStage vertex_processing_stages[] =
+    {
+        Anvil::ShaderStage::GEOMETRY,
+        Anvil::ShaderStage::TESSELLATION_CONTROL,
+        Anvil::ShaderStage::TESSELLATION_EVALUATION,
+        Anvil::ShaderStage::VERTEX
+    };
+
+    bool result = false;
+
+    if (in_mesh_shader_stage_entrypoint_info.shader_module_ptr == nullptr ||
+        in_mesh_shader_stage_entrypoint_info.stage             != Anvil::ShaderStage::MESH)
+    {
+        anvil_assert(in_mesh_shader_stage_entrypoint_info.shader_module_ptr != nullptr);
+        anvil_assert(in_mesh_shader_stage_entrypoint_info.stage             == Anvil::ShaderStage::MESH);
+
+        goto end;
+    }
+
+    if (in_opt_task_shader_stage_entrypoint_info.shader_module_ptr != nullptr &&
+        in_opt_task_shader_stage_entrypoint_info.stage             != Anvil::ShaderStage::TASK)
+    {
+        anvil_assert(in_opt_task_shader_stage_entrypoint_info.stage == Anvil::ShaderStage::TASK);
+
+        goto end;
+    }
+
+    for (const auto& current_stage : vertex_processing_stages)
+    {
+        const auto stage_iterator = m_shader_stages.find(current_stage);
+
+        if (stage_iterator                           != m_shader_stages.end() &&
+            stage_iterator->second.shader_module_ptr != nullptr)
+        {
+            /* Mesh shading cannot be combined with the vertex processing stages */
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    m_shader_stages               [Anvil::ShaderStage::MESH] = in_mesh_shader_stage_entrypoint_info;
+    m_specialization_constants_map[Anvil::ShaderStage::MESH] = SpecializationConstants();
+
+    if (in_opt_task_shader_stage_entrypoint_info.shader_module_ptr != nullptr)
+    {
+        m_shader_stages               [Anvil::ShaderStage::TASK] = in_opt_task_shader_stage_entrypoint_info;
+        m_specialization_constants_map[Anvil::ShaderStage::TASK] = SpecializationConstants();
+    }
+
+    result = true;
+end:
+    return result;
+}
+
 void Anvil::GraphicsPipelineCreateInfo::set_multisampling_properties(Anvil::SampleCountFlagBits in_sample_count,
                                                                      float                      in_min_sample_shading,
                                                                      const VkSampleMask         in_sample_mask)
@@ -1050,6 +1529,17 @@ void Anvil::GraphicsPipelineCreateInfo::set_scissor_box_properties(uint32_t in_n
                                                            in_height);
 }
 
+void Anvil::GraphicsPipelineCreateInfo::set_shading_rate_palette(uint32_t                                in_n_viewport,
+                                                                 uint32_t                                in_n_entries,
+                                                                 const Anvil::ShadingRatePaletteEntryNV* in_entries_ptr)
+{
+    anvil_assert(in_n_entries   != 0);
+    anvil_assert(in_entries_ptr != nullptr);
+
+    m_shading_rate_palettes[in_n_viewport] = std::vector<Anvil::ShadingRatePaletteEntryNV>(in_entries_ptr,
+                                                                                           in_entries_ptr + in_n_entries);
+}
+
 void Anvil::GraphicsPipelineCreateInfo::set_stencil_test_properties(bool             in_update_front_face_state,
                                                                     Anvil::StencilOp in_stencil_fail_op,
                                                                     Anvil::StencilOp in_stencil_pass_op,
@@ -1226,7 +1716,47 @@ void Anvil::GraphicsPipelineCreateInfo::toggle_sample_shading(bool in_should_ena
     m_sample_shading_enabled = in_should_enable;
 }
 
+void Anvil::GraphicsPipelineCreateInfo::toggle_shading_rate_image(bool in_should_enable)
+{
+    m_shading_rate_image_enabled = in_should_enable;
+}
+
 void Anvil::GraphicsPipelineCreateInfo::toggle_stencil_test(bool in_should_enable)
 {
     m_stencil_test_enabled = in_should_enable;
 }
+
+bool Anvil::GraphicsPipelineCreateInfo::operator==(const Anvil::GraphicsPipelineCreateInfo& in_create_info) const
+{
+    std::vector<uint64_t> in_words;
+    bool                  result    = false;
+    std::vector<uint64_t> words;
+
+    get_state_words              (&words);
+    in_create_info.get_state_words(&in_words);
+
+    if (words != in_words)
+    {
+        goto end;
+    }
+
+    /* DS create info items are only represented by their hashes in the state words */
+    for (uint32_t n_ds_create_info = 0;
+                  n_ds_create_info < static_cast<uint32_t>(m_ds_create_info_items.size() );
+                ++n_ds_create_info)
+    {
+        const auto& current_ds_create_info_ptr    = m_ds_create_info_items.at               (n_ds_create_info);
+        const auto& in_current_ds_create_info_ptr = in_create_info.m_ds_create_info_items.at(n_ds_create_info);
+
+        if (current_ds_create_info_ptr    != nullptr &&
+            in_current_ds_create_info_ptr != nullptr &&
+          !(*current_ds_create_info_ptr == *in_current_ds_create_info_ptr) )
+        {
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
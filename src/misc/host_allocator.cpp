@@ -0,0 +1,622 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/host_allocator.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+
+namespace
+{
+    /* Stored right in front of pointers returned by HostAllocator::allocate_from_heap(). */
+    typedef struct HeapAllocationHeader
+    {
+        size_t   size;
+        uint32_t n_bytes_to_base;
+        uint32_t tag;
+    } HeapAllocationHeader;
+
+    /* Per-thread arena used by ThreadLocalArenaHostAllocator. Each allocation is preceded by its size. */
+    typedef struct ThreadArena
+    {
+        std::unique_ptr<uint8_t[]> block_ptr;
+        uint32_t                   n_live_allocations;
+        size_t                     offset;
+        size_t                     size;
+
+        ThreadArena()
+            :n_live_allocations(0),
+             offset            (0),
+             size              (0)
+        {
+            /* Stub */
+        }
+    } ThreadArena;
+
+    thread_local ThreadArena t_arena;
+
+    uintptr_t align_up(uintptr_t in_value,
+                       size_t    in_alignment)
+    {
+        return (in_value + in_alignment - 1) / in_alignment * in_alignment;
+    }
+}
+
+
+/** Please see header for specification */
+Anvil::HostAllocator::HostAllocator()
+{
+    m_allocation_callbacks_vk.pfnAllocation         = allocate_callback;
+    m_allocation_callbacks_vk.pfnFree               = free_callback;
+    m_allocation_callbacks_vk.pfnInternalAllocation = internal_allocation_callback;
+    m_allocation_callbacks_vk.pfnInternalFree       = internal_free_callback;
+    m_allocation_callbacks_vk.pfnReallocation       = reallocate_callback;
+    m_allocation_callbacks_vk.pUserData             = this;
+}
+
+/** Please see header for specification */
+Anvil::HostAllocator::~HostAllocator()
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+void* VKAPI_PTR Anvil::HostAllocator::allocate_callback(void*                   in_user_data_ptr,
+                                                        size_t                  in_size,
+                                                        size_t                  in_alignment,
+                                                        VkSystemAllocationScope in_scope)
+{
+    return static_cast<Anvil::HostAllocator*>(in_user_data_ptr)->allocate(in_size,
+                                                                          in_alignment,
+                                                                          static_cast<Anvil::SystemAllocationScope>(in_scope) );
+}
+
+/** Please see header for specification */
+void* Anvil::HostAllocator::allocate_from_heap(size_t   in_size,
+                                               size_t   in_alignment,
+                                               uint32_t in_tag)
+{
+    const size_t          alignment  = std::max(in_alignment,
+                                                alignof(HeapAllocationHeader) );
+    void*                 base_ptr   = nullptr;
+    HeapAllocationHeader* header_ptr = nullptr;
+    uintptr_t             result     = 0;
+
+    base_ptr = std::malloc(in_size + sizeof(HeapAllocationHeader) + alignment - 1);
+
+    if (base_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    result     = align_up(reinterpret_cast<uintptr_t>(base_ptr) + sizeof(HeapAllocationHeader),
+                          alignment);
+    header_ptr = reinterpret_cast<HeapAllocationHeader*>(result) - 1;
+
+    header_ptr->n_bytes_to_base = static_cast<uint32_t>(result - reinterpret_cast<uintptr_t>(base_ptr) );
+    header_ptr->size            = in_size;
+    header_ptr->tag             = in_tag;
+
+end:
+    return reinterpret_cast<void*>(result);
+}
+
+/** Please see header for specification */
+void VKAPI_PTR Anvil::HostAllocator::free_callback(void* in_user_data_ptr,
+                                                   void* in_ptr)
+{
+    static_cast<Anvil::HostAllocator*>(in_user_data_ptr)->free(in_ptr);
+}
+
+/** Please see header for specification */
+void Anvil::HostAllocator::free_to_heap(void* in_ptr)
+{
+    if (in_ptr != nullptr)
+    {
+        const HeapAllocationHeader* header_ptr = static_cast<const HeapAllocationHeader*>(in_ptr) - 1;
+
+        std::free(static_cast<uint8_t*>(in_ptr) - header_ptr->n_bytes_to_base);
+    }
+}
+
+/** Please see header for specification */
+size_t Anvil::HostAllocator::get_heap_allocation_size(const void* in_ptr)
+{
+    anvil_assert(in_ptr != nullptr);
+
+    return (static_cast<const HeapAllocationHeader*>(in_ptr) - 1)->size;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::HostAllocator::get_heap_allocation_tag(const void* in_ptr)
+{
+    anvil_assert(in_ptr != nullptr);
+
+    return (static_cast<const HeapAllocationHeader*>(in_ptr) - 1)->tag;
+}
+
+/** Please see header for specification */
+void VKAPI_PTR Anvil::HostAllocator::internal_allocation_callback(void*                    in_user_data_ptr,
+                                                                  size_t                   in_size,
+                                                                  VkInternalAllocationType in_type,
+                                                                  VkSystemAllocationScope  in_scope)
+{
+    ANVIL_REDUNDANT_ARGUMENT(in_type);
+
+    static_cast<Anvil::HostAllocator*>(in_user_data_ptr)->on_internal_allocation(in_size,
+                                                                                 static_cast<Anvil::SystemAllocationScope>(in_scope) );
+}
+
+/** Please see header for specification */
+void VKAPI_PTR Anvil::HostAllocator::internal_free_callback(void*                    in_user_data_ptr,
+                                                            size_t                   in_size,
+                                                            VkInternalAllocationType in_type,
+                                                            VkSystemAllocationScope  in_scope)
+{
+    ANVIL_REDUNDANT_ARGUMENT(in_type);
+
+    static_cast<Anvil::HostAllocator*>(in_user_data_ptr)->on_internal_free(in_size,
+                                                                           static_cast<Anvil::SystemAllocationScope>(in_scope) );
+}
+
+/** Please see header for specification */
+void Anvil::HostAllocator::on_internal_allocation(size_t                       in_size,
+                                                  Anvil::SystemAllocationScope in_scope)
+{
+    ANVIL_REDUNDANT_ARGUMENT(in_scope);
+    ANVIL_REDUNDANT_ARGUMENT(in_size);
+}
+
+/** Please see header for specification */
+void Anvil::HostAllocator::on_internal_free(size_t                       in_size,
+                                            Anvil::SystemAllocationScope in_scope)
+{
+    ANVIL_REDUNDANT_ARGUMENT(in_scope);
+    ANVIL_REDUNDANT_ARGUMENT(in_size);
+}
+
+/** Please see header for specification */
+void* VKAPI_PTR Anvil::HostAllocator::reallocate_callback(void*                   in_user_data_ptr,
+                                                          void*                   in_ptr,
+                                                          size_t                  in_size,
+                                                          size_t                  in_alignment,
+                                                          VkSystemAllocationScope in_scope)
+{
+    return static_cast<Anvil::HostAllocator*>(in_user_data_ptr)->reallocate(in_ptr,
+                                                                            in_size,
+                                                                            in_alignment,
+                                                                            static_cast<Anvil::SystemAllocationScope>(in_scope) );
+}
+
+
+/** Please see header for specification */
+Anvil::ThreadLocalArenaHostAllocator::ThreadLocalArenaHostAllocator(size_t                in_arena_size,
+                                                                    Anvil::HostAllocator* in_opt_fallback_allocator_ptr)
+    :m_arena_size            (in_arena_size),
+     m_fallback_allocator_ptr(in_opt_fallback_allocator_ptr),
+     m_n_arena_allocations   (0),
+     m_n_arena_overflows     (0)
+{
+    anvil_assert(in_arena_size != 0);
+}
+
+/** Please see header for specification */
+Anvil::ThreadLocalArenaHostAllocator::~ThreadLocalArenaHostAllocator()
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+void* Anvil::ThreadLocalArenaHostAllocator::allocate(size_t                       in_size,
+                                                     size_t                       in_alignment,
+                                                     Anvil::SystemAllocationScope in_scope)
+{
+    void* result_ptr = nullptr;
+
+    if (in_scope == Anvil::SystemAllocationScope::COMMAND)
+    {
+        result_ptr = allocate_from_arena(in_size,
+                                         in_alignment);
+
+        if (result_ptr == nullptr)
+        {
+            ++m_n_arena_overflows;
+        }
+    }
+
+    if (result_ptr == nullptr)
+    {
+        result_ptr = allocate_from_fallback(in_size,
+                                            in_alignment,
+                                            in_scope);
+    }
+
+    return result_ptr;
+}
+
+/** Reserves @param in_size bytes from the calling thread's arena.
+ *
+ *  The arena is (re)created if it is smaller than requested at creation time, and holds no live allocations.
+ *
+ *  @return Pointer to the reserved region if successful, null if the arena has run out of space.
+ **/
+void* Anvil::ThreadLocalArenaHostAllocator::allocate_from_arena(size_t in_size,
+                                                                size_t in_alignment)
+{
+    const size_t alignment  = std::max(in_alignment,
+                                       alignof(size_t) );
+    uintptr_t    arena_base = 0;
+    uintptr_t    result     = 0;
+
+    if (t_arena.size               < m_arena_size &&
+        t_arena.n_live_allocations == 0)
+    {
+        t_arena.block_ptr.reset(new uint8_t[m_arena_size]);
+
+        t_arena.offset = 0;
+        t_arena.size   = m_arena_size;
+    }
+
+    arena_base = reinterpret_cast<uintptr_t>(t_arena.block_ptr.get() );
+    result     = align_up(arena_base + t_arena.offset + sizeof(size_t),
+                          alignment);
+
+    if (result + in_size > arena_base + t_arena.size)
+    {
+        result = 0;
+
+        goto end;
+    }
+
+    *(reinterpret_cast<size_t*>(result) - 1) = in_size;
+
+    t_arena.offset = result + in_size - arena_base;
+
+    ++t_arena.n_live_allocations;
+    ++m_n_arena_allocations;
+
+end:
+    return reinterpret_cast<void*>(result);
+}
+
+/** Forwards an allocation request to the fallback allocator, or to the system heap if none was specified. */
+void* Anvil::ThreadLocalArenaHostAllocator::allocate_from_fallback(size_t                       in_size,
+                                                                   size_t                       in_alignment,
+                                                                   Anvil::SystemAllocationScope in_scope)
+{
+    return (m_fallback_allocator_ptr != nullptr) ? m_fallback_allocator_ptr->allocate(in_size,
+                                                                                      in_alignment,
+                                                                                      in_scope)
+                                                 : allocate_from_heap                (in_size,
+                                                                                      in_alignment,
+                                                                                      0); /* in_tag */
+}
+
+/** Please see header for specification */
+Anvil::ThreadLocalArenaHostAllocatorUniquePtr Anvil::ThreadLocalArenaHostAllocator::create(size_t                in_arena_size,
+                                                                                           Anvil::HostAllocator* in_opt_fallback_allocator_ptr)
+{
+    Anvil::ThreadLocalArenaHostAllocatorUniquePtr result_ptr(nullptr,
+                                                             std::default_delete<Anvil::ThreadLocalArenaHostAllocator>() );
+
+    result_ptr.reset(
+        new Anvil::ThreadLocalArenaHostAllocator(in_arena_size,
+                                                 in_opt_fallback_allocator_ptr)
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+void Anvil::ThreadLocalArenaHostAllocator::free(void* in_ptr)
+{
+    if (in_ptr == nullptr)
+    {
+        return;
+    }
+
+    if (is_arena_allocation(in_ptr) )
+    {
+        anvil_assert(t_arena.n_live_allocations > 0);
+
+        if (--t_arena.n_live_allocations == 0)
+        {
+            /* All command-scope allocations are gone. Rewind the arena. */
+            t_arena.offset = 0;
+        }
+    }
+    else
+    if (m_fallback_allocator_ptr != nullptr)
+    {
+        m_fallback_allocator_ptr->free(in_ptr);
+    }
+    else
+    {
+        free_to_heap(in_ptr);
+    }
+}
+
+/** Tells whether @param in_ptr has been carved out of the calling thread's arena.
+ *
+ *  Command-scope allocations are always released on the thread which made them, so there is no need to look
+ *  at arenas of other threads.
+ **/
+bool Anvil::ThreadLocalArenaHostAllocator::is_arena_allocation(const void* in_ptr) const
+{
+    const uint8_t* arena_start_ptr = t_arena.block_ptr.get();
+
+    const uint8_t* ptr             = static_cast<const uint8_t*>(in_ptr);
+
+    return (arena_start_ptr != nullptr                        &&
+            ptr             >= arena_start_ptr                &&
+            ptr             <  arena_start_ptr + t_arena.size);
+}
+
+/** Please see header for specification */
+void Anvil::ThreadLocalArenaHostAllocator::on_internal_allocation(size_t                       in_size,
+                                                                  Anvil::SystemAllocationScope in_scope)
+{
+    if (m_fallback_allocator_ptr != nullptr)
+    {
+        m_fallback_allocator_ptr->on_internal_allocation(in_size,
+                                                         in_scope);
+    }
+}
+
+/** Please see header for specification */
+void Anvil::ThreadLocalArenaHostAllocator::on_internal_free(size_t                       in_size,
+                                                            Anvil::SystemAllocationScope in_scope)
+{
+    if (m_fallback_allocator_ptr != nullptr)
+    {
+        m_fallback_allocator_ptr->on_internal_free(in_size,
+                                                   in_scope);
+    }
+}
+
+/** Please see header for specification */
+void* Anvil::ThreadLocalArenaHostAllocator::reallocate(void*                        in_ptr,
+                                                       size_t                       in_size,
+                                                       size_t                       in_alignment,
+                                                       Anvil::SystemAllocationScope in_scope)
+{
+    void* result_ptr = nullptr;
+
+    if (in_ptr == nullptr)
+    {
+        result_ptr = allocate(in_size,
+                              in_alignment,
+                              in_scope);
+    }
+    else
+    if (in_size == 0)
+    {
+        free(in_ptr);
+    }
+    else
+    if (!is_arena_allocation(in_ptr)        &&
+         m_fallback_allocator_ptr != nullptr)
+    {
+        result_ptr = m_fallback_allocator_ptr->reallocate(in_ptr,
+                                                          in_size,
+                                                          in_alignment,
+                                                          in_scope);
+    }
+    else
+    {
+        const size_t old_size = (is_arena_allocation(in_ptr) ) ? *(static_cast<const size_t*>(in_ptr) - 1)
+                                                               : get_heap_allocation_size(in_ptr);
+
+        result_ptr = allocate(in_size,
+                              in_alignment,
+                              in_scope);
+
+        if (result_ptr != nullptr)
+        {
+            memcpy(result_ptr,
+                   in_ptr,
+                   std::min(old_size,
+                            in_size) );
+
+            free(in_ptr);
+        }
+    }
+
+    return result_ptr;
+}
+
+
+/** Please see header for specification */
+Anvil::TrackingHostAllocator::TrackingHostAllocator()
+    :m_n_peak_allocated_bytes (0),
+     m_n_total_allocated_bytes(0)
+{
+    for (uint32_t n_scope = 0;
+                  n_scope < static_cast<uint32_t>(Anvil::SystemAllocationScope::COUNT);
+                ++n_scope)
+    {
+        m_n_allocated_bytes         [n_scope] = 0;
+        m_n_allocations             [n_scope] = 0;
+        m_n_internal_allocated_bytes[n_scope] = 0;
+    }
+}
+
+/** Please see header for specification */
+Anvil::TrackingHostAllocator::~TrackingHostAllocator()
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+void* Anvil::TrackingHostAllocator::allocate(size_t                       in_size,
+                                             size_t                       in_alignment,
+                                             Anvil::SystemAllocationScope in_scope)
+{
+    const uint32_t n_scope    = static_cast<uint32_t>(in_scope);
+    void*          result_ptr = nullptr;
+    uint64_t       n_total    = 0;
+    uint64_t       n_peak     = 0;
+
+    anvil_assert(n_scope < static_cast<uint32_t>(Anvil::SystemAllocationScope::COUNT) );
+
+    result_ptr = allocate_from_heap(in_size,
+                                    in_alignment,
+                                    n_scope);
+
+    if (result_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    m_n_allocated_bytes[n_scope] += in_size;
+    m_n_allocations    [n_scope] ++;
+
+    n_total = (m_n_total_allocated_bytes += in_size);
+    n_peak  = m_n_peak_allocated_bytes;
+
+    while (n_peak < n_total                                             &&
+          !m_n_peak_allocated_bytes.compare_exchange_weak(n_peak, n_total) )
+    {
+        /* Stub */
+    }
+
+end:
+    return result_ptr;
+}
+
+/** Please see header for specification */
+Anvil::TrackingHostAllocatorUniquePtr Anvil::TrackingHostAllocator::create()
+{
+    Anvil::TrackingHostAllocatorUniquePtr result_ptr(nullptr,
+                                                     std::default_delete<Anvil::TrackingHostAllocator>() );
+
+    result_ptr.reset(
+        new Anvil::TrackingHostAllocator()
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+void Anvil::TrackingHostAllocator::free(void* in_ptr)
+{
+    if (in_ptr != nullptr)
+    {
+        const uint32_t n_scope = get_heap_allocation_tag (in_ptr);
+        const size_t   size    = get_heap_allocation_size(in_ptr);
+
+        m_n_allocated_bytes[n_scope] -= size;
+        m_n_allocations    [n_scope] --;
+        m_n_total_allocated_bytes    -= size;
+
+        free_to_heap(in_ptr);
+    }
+}
+
+/** Please see header for specification */
+uint64_t Anvil::TrackingHostAllocator::get_n_allocated_bytes(Anvil::SystemAllocationScope in_scope) const
+{
+    anvil_assert(static_cast<uint32_t>(in_scope) < static_cast<uint32_t>(Anvil::SystemAllocationScope::COUNT) );
+
+    return m_n_allocated_bytes[static_cast<uint32_t>(in_scope)];
+}
+
+/** Please see header for specification */
+uint64_t Anvil::TrackingHostAllocator::get_n_allocated_bytes() const
+{
+    return m_n_total_allocated_bytes;
+}
+
+/** Please see header for specification */
+uint64_t Anvil::TrackingHostAllocator::get_n_allocations(Anvil::SystemAllocationScope in_scope) const
+{
+    anvil_assert(static_cast<uint32_t>(in_scope) < static_cast<uint32_t>(Anvil::SystemAllocationScope::COUNT) );
+
+    return m_n_allocations[static_cast<uint32_t>(in_scope)];
+}
+
+/** Please see header for specification */
+uint64_t Anvil::TrackingHostAllocator::get_n_internal_allocated_bytes(Anvil::SystemAllocationScope in_scope) const
+{
+    anvil_assert(static_cast<uint32_t>(in_scope) < static_cast<uint32_t>(Anvil::SystemAllocationScope::COUNT) );
+
+    return m_n_internal_allocated_bytes[static_cast<uint32_t>(in_scope)];
+}
+
+/** Please see header for specification */
+void Anvil::TrackingHostAllocator::on_internal_allocation(size_t                       in_size,
+                                                          Anvil::SystemAllocationScope in_scope)
+{
+    anvil_assert(static_cast<uint32_t>(in_scope) < static_cast<uint32_t>(Anvil::SystemAllocationScope::COUNT) );
+
+    m_n_internal_allocated_bytes[static_cast<uint32_t>(in_scope)] += in_size;
+}
+
+/** Please see header for specification */
+void Anvil::TrackingHostAllocator::on_internal_free(size_t                       in_size,
+                                                    Anvil::SystemAllocationScope in_scope)
+{
+    anvil_assert(static_cast<uint32_t>(in_scope) < static_cast<uint32_t>(Anvil::SystemAllocationScope::COUNT) );
+
+    m_n_internal_allocated_bytes[static_cast<uint32_t>(in_scope)] -= in_size;
+}
+
+/** Please see header for specification */
+void* Anvil::TrackingHostAllocator::reallocate(void*                        in_ptr,
+                                               size_t                       in_size,
+                                               size_t                       in_alignment,
+                                               Anvil::SystemAllocationScope in_scope)
+{
+    void* result_ptr = nullptr;
+
+    if (in_ptr == nullptr)
+    {
+        result_ptr = allocate(in_size,
+                              in_alignment,
+                              in_scope);
+    }
+    else
+    if (in_size == 0)
+    {
+        free(in_ptr);
+    }
+    else
+    {
+        result_ptr = allocate(in_size,
+                              in_alignment,
+                              in_scope);
+
+        if (result_ptr != nullptr)
+        {
+            memcpy(result_ptr,
+                   in_ptr,
+                   std::min(get_heap_allocation_size(in_ptr),
+                            in_size) );
+
+            free(in_ptr);
+        }
+    }
+
+    return result_ptr;
+}
@@ -322,3 +322,48 @@ Anvil::ImageViewCreateInfo::ImageViewCreateInfo(const Anvil::ImageAspectFlags& i
 {
     anvil_assert(in_parent_image_ptr != nullptr);
 }
+
+/** Please see header for specification */
+uint64_t Anvil::ImageViewCreateInfo::get_hash() const
+{
+    const uint64_t words[] =
+    {
+        m_aspect_mask.get_vk(),
+        reinterpret_cast<uint64_t>(m_device_ptr),
+        static_cast<uint64_t>(m_format),
+        static_cast<uint64_t>(m_mt_safety),
+        m_n_base_layer,
+        m_n_base_mipmap_level,
+        m_n_layers,
+        m_n_mipmaps,
+        reinterpret_cast<uint64_t>(m_parent_image_ptr),
+        reinterpret_cast<uint64_t>(m_sampler_ycbcr_conversion_ptr),
+        static_cast<uint64_t>(m_swizzle_array[0]),
+        static_cast<uint64_t>(m_swizzle_array[1]),
+        static_cast<uint64_t>(m_swizzle_array[2]),
+        static_cast<uint64_t>(m_swizzle_array[3]),
+        static_cast<uint64_t>(m_type),
+        m_usage.get_vk()
+    };
+
+    return Anvil::Utils::hash64(words,
+                                sizeof(words) );
+}
+
+/** Please see header for specification */
+bool Anvil::ImageViewCreateInfo::operator==(const Anvil::ImageViewCreateInfo& in_create_info) const
+{
+    return (m_aspect_mask                  == in_create_info.m_aspect_mask                  &&
+            m_device_ptr                   == in_create_info.m_device_ptr                   &&
+            m_format                       == in_create_info.m_format                       &&
+            m_mt_safety                    == in_create_info.m_mt_safety                    &&
+            m_n_base_layer                 == in_create_info.m_n_base_layer                 &&
+            m_n_base_mipmap_level          == in_create_info.m_n_base_mipmap_level          &&
+            m_n_layers                     == in_create_info.m_n_layers                     &&
+            m_n_mipmaps                    == in_create_info.m_n_mipmaps                    &&
+            m_parent_image_ptr             == in_create_info.m_parent_image_ptr             &&
+            m_sampler_ycbcr_conversion_ptr == in_create_info.m_sampler_ycbcr_conversion_ptr &&
+            m_swizzle_array                == in_create_info.m_swizzle_array                &&
+            m_type                         == in_create_info.m_type                         &&
+            m_usage                        == in_create_info.m_usage);
+}
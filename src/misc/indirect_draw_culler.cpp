@@ -0,0 +1,643 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "misc/compute_pipeline_create_info.h"
+#include "misc/debug.h"
+#include "misc/descriptor_set_cache.h"
+#include "misc/descriptor_set_create_info.h"
+#include "misc/glsl_to_spirv.h"
+#include "misc/indirect_draw_culler.h"
+#include "misc/sampler_create_info.h"
+#include "wrappers/buffer.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/compute_pipeline_manager.h"
+#include "wrappers/descriptor_set_layout.h"
+#include "wrappers/device.h"
+#include "wrappers/sampler.h"
+#include "wrappers/shader_module.h"
+
+#define N_INVOCATIONS_PER_WORKGROUP (64)
+
+
+static const char* g_glsl_cull_comp =
+    "#version 450\n"
+    "\n"
+    "layout(local_size_x = 64) in;\n"
+    "\n"
+    "struct DrawCommand\n"
+    "{\n"
+    "    uint index_count;\n"
+    "    uint instance_count;\n"
+    "    uint first_index;\n"
+    "    int  vertex_offset;\n"
+    "    uint first_instance;\n"
+    "};\n"
+    "\n"
+    "struct Instance\n"
+    "{\n"
+    "    vec4 bounding_sphere;\n"
+    "    uint index_count;\n"
+    "    uint first_index;\n"
+    "    int  vertex_offset;\n"
+    "    uint first_instance;\n"
+    "    uint n_stream;\n"
+    "    uint padding[3];\n"
+    "};\n"
+    "\n"
+    "layout(std430, set = 0, binding = 0) restrict readonly buffer instanceBlock\n"
+    "{\n"
+    "    Instance instances[];\n"
+    "};\n"
+    "layout(std430, set = 0, binding = 1) restrict writeonly buffer drawCommandBlock\n"
+    "{\n"
+    "    DrawCommand draw_commands[];\n"
+    "};\n"
+    "layout(std430, set = 0, binding = 2) restrict buffer countBlock\n"
+    "{\n"
+    "    uint counts[];\n"
+    "};\n"
+    "\n"
+    "#ifdef USE_OCCLUSION\n"
+    "    layout(set = 0, binding = 3) uniform sampler2D depth_pyramid;\n"
+    "#endif\n"
+    "\n"
+    "layout(push_constant) uniform pushConstants\n"
+    "{\n"
+    "    mat4 view_projection;\n"
+    "    vec2 depth_pyramid_size;\n"
+    "    uint n_instances;\n"
+    "    uint n_max_draws_per_stream;\n"
+    "    uint n_streams;\n"
+    "} pc;\n"
+    "\n"
+    "bool is_inside_frustum(vec3 center, float radius)\n"
+    "{\n"
+    "    /* Extract the frustum planes from the matrix rows (Vulkan clip space, 0 <= z <= w) */\n"
+    "    mat4 rows = transpose(pc.view_projection);\n"
+    "    vec4 planes[6];\n"
+    "\n"
+    "    planes[0] = rows[3] + rows[0];\n"
+    "    planes[1] = rows[3] - rows[0];\n"
+    "    planes[2] = rows[3] + rows[1];\n"
+    "    planes[3] = rows[3] - rows[1];\n"
+    "    planes[4] = rows[2];\n"
+    "    planes[5] = rows[3] - rows[2];\n"
+    "\n"
+    "    for (int n_plane = 0; n_plane < 6; ++n_plane)\n"
+    "    {\n"
+    "        if (dot(planes[n_plane].xyz, center) + planes[n_plane].w < -radius * length(planes[n_plane].xyz) )\n"
+    "        {\n"
+    "            return false;\n"
+    "        }\n"
+    "    }\n"
+    "\n"
+    "    return true;\n"
+    "}\n"
+    "\n"
+    "#ifdef USE_OCCLUSION\n"
+    "    bool is_unoccluded(vec3 center, float radius)\n"
+    "    {\n"
+    "        vec2  uv_max = vec2(0.0);\n"
+    "        vec2  uv_min = vec2(1.0);\n"
+    "        float z_min  = 1.0;\n"
+    "\n"
+    "        /* Project the sphere's bounding box to screen space */\n"
+    "        for (int n_corner = 0; n_corner < 8; ++n_corner)\n"
+    "        {\n"
+    "            vec3 corner = center + radius * vec3(((n_corner & 1) != 0) ? 1.0 : -1.0,\n"
+    "                                                 ((n_corner & 2) != 0) ? 1.0 : -1.0,\n"
+    "                                                 ((n_corner & 4) != 0) ? 1.0 : -1.0);\n"
+    "            vec4 clip   = pc.view_projection * vec4(corner, 1.0);\n"
+    "\n"
+    "            if (clip.w <= 0.0)\n"
+    "            {\n"
+    "                /* The box crosses the camera plane */\n"
+    "                return true;\n"
+    "            }\n"
+    "\n"
+    "            clip.xyz /= clip.w;\n"
+    "            uv_max    = max(uv_max, clip.xy * 0.5 + 0.5);\n"
+    "            uv_min    = min(uv_min, clip.xy * 0.5 + 0.5);\n"
+    "            z_min     = min(z_min,  clip.z);\n"
+    "        }\n"
+    "\n"
+    "        uv_max = clamp(uv_max, vec2(0.0), vec2(1.0) );\n"
+    "        uv_min = clamp(uv_min, vec2(0.0), vec2(1.0) );\n"
+    "\n"
+    "        /* Pick the mip at which the footprint spans at most 2x2 texels */\n"
+    "        vec2  footprint = (uv_max - uv_min) * pc.depth_pyramid_size;\n"
+    "        float lod       = ceil(log2(max(max(footprint.x, footprint.y), 1.0) ) );\n"
+    "        float depth     = max(max(textureLod(depth_pyramid, uv_min,                   lod).x,\n"
+    "                                  textureLod(depth_pyramid, vec2(uv_max.x, uv_min.y), lod).x),\n"
+    "                              max(textureLod(depth_pyramid, vec2(uv_min.x, uv_max.y), lod).x,\n"
+    "                                  textureLod(depth_pyramid, uv_max,                   lod).x) );\n"
+    "\n"
+    "        return (z_min <= depth);\n"
+    "    }\n"
+    "#endif\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "    uint n_instance = gl_GlobalInvocationID.x;\n"
+    "\n"
+    "    if (n_instance >= pc.n_instances)\n"
+    "    {\n"
+    "        return;\n"
+    "    }\n"
+    "\n"
+    "    Instance instance = instances[n_instance];\n"
+    "\n"
+    "    if (instance.n_stream >= pc.n_streams                                                  ||\n"
+    "        !is_inside_frustum(instance.bounding_sphere.xyz, instance.bounding_sphere.w) )\n"
+    "    {\n"
+    "        return;\n"
+    "    }\n"
+    "\n"
+    "#ifdef USE_OCCLUSION\n"
+    "    if (!is_unoccluded(instance.bounding_sphere.xyz, instance.bounding_sphere.w) )\n"
+    "    {\n"
+    "        return;\n"
+    "    }\n"
+    "#endif\n"
+    "\n"
+    "    uint n_draw = atomicAdd(counts[instance.n_stream], 1u);\n"
+    "\n"
+    "    if (n_draw < pc.n_max_draws_per_stream)\n"
+    "    {\n"
+    "        draw_commands[instance.n_stream * pc.n_max_draws_per_stream + n_draw] = DrawCommand(instance.index_count,\n"
+    "                                                                                            1u,\n"
+    "                                                                                            instance.first_index,\n"
+    "                                                                                            instance.vertex_offset,\n"
+    "                                                                                            instance.first_instance);\n"
+    "    }\n"
+    "}\n";
+
+
+/** Please see header for specification */
+Anvil::IndirectDrawCuller::IndirectDrawCuller(const Anvil::BaseDevice* in_device_ptr)
+    :m_device_ptr(in_device_ptr)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::IndirectDrawCuller::~IndirectDrawCuller()
+{
+    auto compute_pipeline_manager_ptr = m_device_ptr->get_compute_pipeline_manager();
+
+    /* Release the sets before the layouts they use */
+    m_ds_cache_ptr.reset();
+
+    for (auto& current_variant : m_variants)
+    {
+        if (current_variant.pipeline_id != UINT32_MAX)
+        {
+            compute_pipeline_manager_ptr->delete_pipeline(current_variant.pipeline_id);
+
+            current_variant.pipeline_id = UINT32_MAX;
+        }
+    }
+}
+
+/** Please see header for specification */
+Anvil::IndirectDrawCullerUniquePtr Anvil::IndirectDrawCuller::create(const Anvil::BaseDevice* in_device_ptr)
+{
+    Anvil::IndirectDrawCullerUniquePtr result_ptr(nullptr,
+                                                  std::default_delete<Anvil::IndirectDrawCuller>() );
+
+    anvil_assert(in_device_ptr != nullptr);
+
+    result_ptr.reset(
+        new Anvil::IndirectDrawCuller(in_device_ptr)
+    );
+
+    if (!result_ptr->init() )
+    {
+        result_ptr.reset();
+    }
+
+    return result_ptr;
+}
+
+/** Creates the descriptor set cache, the depth pyramid sampler and all pipeline variants.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::IndirectDrawCuller::init()
+{
+    bool result = false;
+
+    m_ds_cache_ptr = Anvil::DescriptorSetCache::create(m_device_ptr,
+                                                       64,   /* in_n_sets_per_pool             */
+                                                       256); /* in_n_descriptors_per_type_pool */
+
+    if (m_ds_cache_ptr == nullptr)
+    {
+        anvil_assert(m_ds_cache_ptr != nullptr);
+
+        goto end;
+    }
+
+    {
+        auto create_info_ptr = Anvil::SamplerCreateInfo::create(m_device_ptr,
+                                                                Anvil::Filter::NEAREST,
+                                                                Anvil::Filter::NEAREST,
+                                                                Anvil::SamplerMipmapMode::NEAREST,
+                                                                Anvil::SamplerAddressMode::CLAMP_TO_EDGE,
+                                                                Anvil::SamplerAddressMode::CLAMP_TO_EDGE,
+                                                                Anvil::SamplerAddressMode::CLAMP_TO_EDGE,
+                                                                0.0f,  /* in_lod_bias                     */
+                                                                1.0f,  /* in_max_anisotropy               */
+                                                                false, /* in_compare_enable               */
+                                                                Anvil::CompareOp::ALWAYS,
+                                                                0.0f,  /* in_min_lod                      */
+                                                                VK_LOD_CLAMP_NONE,
+                                                                Anvil::BorderColor::FLOAT_TRANSPARENT_BLACK,
+                                                                false); /* in_use_unnormalized_coordinates */
+
+        m_sampler_ptr = Anvil::Sampler::create(std::move(create_info_ptr) );
+    }
+
+    if (m_sampler_ptr == nullptr)
+    {
+        anvil_assert(m_sampler_ptr != nullptr);
+
+        goto end;
+    }
+
+    for (uint32_t n_variant = 0;
+                  n_variant < VARIANT_COUNT;
+                ++n_variant)
+    {
+        if (!init_variant(n_variant) )
+        {
+            goto end;
+        }
+    }
+
+    if (!m_device_ptr->get_compute_pipeline_manager()->bake() )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Compiles the culling shader for the specified variant, and creates a descriptor set layout and a compute
+ *  pipeline which uses it. The pipeline is baked by init().
+ *
+ *  @param in_n_variant Index of the variant to initialize.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::IndirectDrawCuller::init_variant(uint32_t in_n_variant)
+{
+    auto                                       compute_pipeline_manager_ptr = m_device_ptr->get_compute_pipeline_manager();
+    Anvil::GLSLShaderToSPIRVGeneratorUniquePtr glsl_ptr;
+    const bool                                 is_occlusion_variant         = (in_n_variant == VARIANT_FRUSTUM_OCCLUSION);
+    bool                                       result                       = false;
+    Variant&                                   variant                      = m_variants[in_n_variant];
+
+    glsl_ptr = Anvil::GLSLShaderToSPIRVGenerator::create(m_device_ptr,
+                                                         Anvil::GLSLShaderToSPIRVGenerator::MODE_USE_SPECIFIED_SOURCE,
+                                                         g_glsl_cull_comp,
+                                                         Anvil::ShaderStage::COMPUTE);
+
+    if (glsl_ptr == nullptr)
+    {
+        anvil_assert(glsl_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (is_occlusion_variant)
+    {
+        glsl_ptr->add_empty_definition("USE_OCCLUSION");
+    }
+
+    variant.shader_module_ptr = Anvil::ShaderModule::create_from_spirv_generator(m_device_ptr,
+                                                                                 glsl_ptr.get() );
+
+    if (variant.shader_module_ptr == nullptr)
+    {
+        anvil_assert(variant.shader_module_ptr != nullptr);
+
+        goto end;
+    }
+
+    variant.entrypoint_ptr.reset(
+        new Anvil::ShaderModuleStageEntryPoint("main",
+                                               variant.shader_module_ptr.get(),
+                                               Anvil::ShaderStage::COMPUTE)
+    );
+
+    {
+        auto ds_create_info_ptr = Anvil::DescriptorSetCreateInfo::create();
+
+        ds_create_info_ptr->add_binding(0, /* in_binding_index */
+                                        Anvil::DescriptorType::STORAGE_BUFFER,
+                                        1, /* in_descriptor_array_size */
+                                        Anvil::ShaderStageFlagBits::COMPUTE_BIT);
+        ds_create_info_ptr->add_binding(1, /* in_binding_index */
+                                        Anvil::DescriptorType::STORAGE_BUFFER,
+                                        1, /* in_descriptor_array_size */
+                                        Anvil::ShaderStageFlagBits::COMPUTE_BIT);
+        ds_create_info_ptr->add_binding(2, /* in_binding_index */
+                                        Anvil::DescriptorType::STORAGE_BUFFER,
+                                        1, /* in_descriptor_array_size */
+                                        Anvil::ShaderStageFlagBits::COMPUTE_BIT);
+
+        if (is_occlusion_variant)
+        {
+            ds_create_info_ptr->add_binding(3, /* in_binding_index */
+                                            Anvil::DescriptorType::COMBINED_IMAGE_SAMPLER,
+                                            1, /* in_descriptor_array_size */
+                                            Anvil::ShaderStageFlagBits::COMPUTE_BIT);
+        }
+
+        variant.ds_layout_ptr = Anvil::DescriptorSetLayout::create(std::move(ds_create_info_ptr),
+                                                                   m_device_ptr);
+    }
+
+    if (variant.ds_layout_ptr == nullptr)
+    {
+        anvil_assert(variant.ds_layout_ptr != nullptr);
+
+        goto end;
+    }
+
+    {
+        const std::vector<const Anvil::DescriptorSetCreateInfo*> ds_create_info_ptrs(1,
+                                                                                      variant.ds_layout_ptr->get_create_info() );
+        auto                                                     pipeline_create_info_ptr = Anvil::ComputePipelineCreateInfo::create(Anvil::PipelineCreateFlagBits::NONE,
+                                                                                                                                     *variant.entrypoint_ptr);
+
+        pipeline_create_info_ptr->attach_push_constant_range    (0, /* in_offset */
+                                                                 sizeof(PushConstants),
+                                                                 Anvil::ShaderStageFlagBits::COMPUTE_BIT);
+        pipeline_create_info_ptr->set_descriptor_set_create_info(&ds_create_info_ptrs);
+
+        if (!compute_pipeline_manager_ptr->add_pipeline(std::move(pipeline_create_info_ptr),
+                                                       &variant.pipeline_id) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::IndirectDrawCuller::record_cull(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                            const CullInfo&           in_cull_info)
+{
+    const VkDeviceSize     count_buffer_size        = get_count_buffer_size       (in_cull_info.n_streams);
+    const VkDeviceSize     draw_command_buffer_size = get_draw_command_buffer_size(in_cull_info.n_streams,
+                                                                                   in_cull_info.n_max_draws_per_stream);
+    Anvil::DescriptorSet*  ds_ptr                   = nullptr;
+    const bool             uses_occlusion           = (in_cull_info.depth_pyramid_image_view_ptr != nullptr);
+    Anvil::PipelineLayout* pipeline_layout_ptr      = nullptr;
+    PushConstants          push_constants;
+    bool                   result                   = false;
+    const Variant&         variant                  = m_variants[uses_occlusion ? VARIANT_FRUSTUM_OCCLUSION
+                                                                                : VARIANT_FRUSTUM];
+
+    anvil_assert(in_cmd_buffer_ptr                    != nullptr);
+    anvil_assert(in_cull_info.count_buffer_ptr        != nullptr);
+    anvil_assert(in_cull_info.draw_command_buffer_ptr != nullptr);
+    anvil_assert(in_cull_info.instance_buffer_ptr     != nullptr);
+    anvil_assert(in_cull_info.n_max_draws_per_stream  >  0);
+    anvil_assert(in_cull_info.n_streams               >  0);
+
+    /* Bind the culling pipeline and its resources */
+    {
+        Anvil::DescriptorSetCache::Contents ds_contents;
+
+        ds_contents.set_binding_item(0, /* in_binding_index */
+                                     Anvil::DescriptorSet::StorageBufferBindingElement(in_cull_info.instance_buffer_ptr,
+                                                                                       in_cull_info.instance_buffer_offset,
+                                                                                       (in_cull_info.n_instances > 0) ? in_cull_info.n_instances * sizeof(Instance)
+                                                                                                                      : VK_WHOLE_SIZE) );
+        ds_contents.set_binding_item(1, /* in_binding_index */
+                                     Anvil::DescriptorSet::StorageBufferBindingElement(in_cull_info.draw_command_buffer_ptr,
+                                                                                       in_cull_info.draw_command_buffer_offset,
+                                                                                       draw_command_buffer_size) );
+        ds_contents.set_binding_item(2, /* in_binding_index */
+                                     Anvil::DescriptorSet::StorageBufferBindingElement(in_cull_info.count_buffer_ptr,
+                                                                                       in_cull_info.count_buffer_offset,
+                                                                                       count_buffer_size) );
+
+        if (uses_occlusion)
+        {
+            anvil_assert(in_cull_info.depth_pyramid_height > 0);
+            anvil_assert(in_cull_info.depth_pyramid_width  > 0);
+
+            ds_contents.set_binding_item(3, /* in_binding_index */
+                                         Anvil::DescriptorSet::CombinedImageSamplerBindingElement(Anvil::ImageLayout::SHADER_READ_ONLY_OPTIMAL,
+                                                                                                  in_cull_info.depth_pyramid_image_view_ptr,
+                                                                                                  m_sampler_ptr.get() ) );
+        }
+
+        ds_ptr = m_ds_cache_ptr->get_descriptor_set(variant.ds_layout_ptr.get(),
+                                                    ds_contents);
+    }
+
+    if (ds_ptr == nullptr)
+    {
+        anvil_assert(ds_ptr != nullptr);
+
+        goto end;
+    }
+
+    pipeline_layout_ptr = m_device_ptr->get_compute_pipeline_manager()->get_pipeline_layout(variant.pipeline_id);
+
+    memcpy(push_constants.view_projection_matrix,
+           in_cull_info.view_projection_matrix,
+           sizeof(push_constants.view_projection_matrix) );
+
+    push_constants.depth_pyramid_size[0]  = static_cast<float>(in_cull_info.depth_pyramid_width);
+    push_constants.depth_pyramid_size[1]  = static_cast<float>(in_cull_info.depth_pyramid_height);
+    push_constants.n_instances            = in_cull_info.n_instances;
+    push_constants.n_max_draws_per_stream = in_cull_info.n_max_draws_per_stream;
+    push_constants.n_streams              = in_cull_info.n_streams;
+
+    /* Indirect draws recorded earlier may still be reading the streams, so wait for them before overwriting
+     * the counts and the commands. */
+    if (!in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::DRAW_INDIRECT_BIT,
+                                                    Anvil::PipelineStageFlagBits::COMPUTE_SHADER_BIT | Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                    Anvil::DependencyFlagBits::NONE,
+                                                    0,       /* in_memory_barrier_count        */
+                                                    nullptr, /* in_memory_barrier_ptrs         */
+                                                    0,       /* in_buffer_memory_barrier_count */
+                                                    nullptr, /* in_buffer_memory_barrier_ptrs  */
+                                                    0,       /* in_image_memory_barrier_count  */
+                                                    nullptr) )
+    {
+        goto end;
+    }
+
+    if (!in_cmd_buffer_ptr->record_fill_buffer(in_cull_info.count_buffer_ptr,
+                                               in_cull_info.count_buffer_offset,
+                                               count_buffer_size,
+                                               0) ) /* in_data */
+    {
+        goto end;
+    }
+
+    {
+        const Anvil::BufferBarrier count_barrier(Anvil::AccessFlagBits::TRANSFER_WRITE_BIT,
+                                                 Anvil::AccessFlagBits::SHADER_READ_BIT | Anvil::AccessFlagBits::SHADER_WRITE_BIT,
+                                                 VK_QUEUE_FAMILY_IGNORED,
+                                                 VK_QUEUE_FAMILY_IGNORED,
+                                                 in_cull_info.count_buffer_ptr,
+                                                 in_cull_info.count_buffer_offset,
+                                                 count_buffer_size);
+
+        if (!in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                        Anvil::PipelineStageFlagBits::COMPUTE_SHADER_BIT,
+                                                        Anvil::DependencyFlagBits::NONE,
+                                                        0,       /* in_memory_barrier_count        */
+                                                        nullptr, /* in_memory_barrier_ptrs         */
+                                                        1,       /* in_buffer_memory_barrier_count */
+                                                       &count_barrier,
+                                                        0,       /* in_image_memory_barrier_count  */
+                                                        nullptr) )
+        {
+            goto end;
+        }
+    }
+
+    /* If there are no instances, the streams are left empty */
+    if (in_cull_info.n_instances > 0)
+    {
+        in_cmd_buffer_ptr->record_bind_pipeline       (Anvil::PipelineBindPoint::COMPUTE,
+                                                       variant.pipeline_id);
+        in_cmd_buffer_ptr->record_bind_descriptor_sets(Anvil::PipelineBindPoint::COMPUTE,
+                                                       pipeline_layout_ptr,
+                                                       0, /* in_first_set */
+                                                       1, /* in_set_count */
+                                                      &ds_ptr,
+                                                       0,        /* in_dynamic_offset_count */
+                                                       nullptr); /* in_dynamic_offset_ptrs  */
+        in_cmd_buffer_ptr->record_push_constants      (pipeline_layout_ptr,
+                                                       Anvil::ShaderStageFlagBits::COMPUTE_BIT,
+                                                       0, /* in_offset */
+                                                       sizeof(push_constants),
+                                                      &push_constants);
+
+        if (!in_cmd_buffer_ptr->record_dispatch((in_cull_info.n_instances + N_INVOCATIONS_PER_WORKGROUP - 1) / N_INVOCATIONS_PER_WORKGROUP,
+                                                1,  /* in_y */
+                                                1) ) /* in_z */
+        {
+            goto end;
+        }
+    }
+
+    /* Make the streams visible to indirect draws */
+    {
+        const Anvil::BufferBarrier stream_barriers[] =
+        {
+            Anvil::BufferBarrier(Anvil::AccessFlagBits::SHADER_WRITE_BIT,
+                                 Anvil::AccessFlagBits::INDIRECT_COMMAND_READ_BIT,
+                                 VK_QUEUE_FAMILY_IGNORED,
+                                 VK_QUEUE_FAMILY_IGNORED,
+                                 in_cull_info.count_buffer_ptr,
+                                 in_cull_info.count_buffer_offset,
+                                 count_buffer_size),
+            Anvil::BufferBarrier(Anvil::AccessFlagBits::SHADER_WRITE_BIT,
+                                 Anvil::AccessFlagBits::INDIRECT_COMMAND_READ_BIT,
+                                 VK_QUEUE_FAMILY_IGNORED,
+                                 VK_QUEUE_FAMILY_IGNORED,
+                                 in_cull_info.draw_command_buffer_ptr,
+                                 in_cull_info.draw_command_buffer_offset,
+                                 draw_command_buffer_size)
+        };
+
+        if (!in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::COMPUTE_SHADER_BIT,
+                                                        Anvil::PipelineStageFlagBits::DRAW_INDIRECT_BIT,
+                                                        Anvil::DependencyFlagBits::NONE,
+                                                        0,       /* in_memory_barrier_count        */
+                                                        nullptr, /* in_memory_barrier_ptrs         */
+                                                        sizeof(stream_barriers) / sizeof(stream_barriers[0]),
+                                                        stream_barriers,
+                                                        0,       /* in_image_memory_barrier_count  */
+                                                        nullptr) )
+        {
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::IndirectDrawCuller::record_draw_stream(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                                   const CullInfo&           in_cull_info,
+                                                   uint32_t                  in_n_stream) const
+{
+    const VkDeviceSize count_offset       = in_cull_info.count_buffer_offset        + get_count_buffer_size(in_n_stream);
+    const VkDeviceSize draw_offset        = in_cull_info.draw_command_buffer_offset + get_draw_command_buffer_size(in_n_stream,
+                                                                                                                   in_cull_info.n_max_draws_per_stream);
+    const auto         extension_info_ptr = m_device_ptr->get_extension_info();
+    bool               result             = false;
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+    anvil_assert(in_n_stream       <  in_cull_info.n_streams);
+
+    if (extension_info_ptr->khr_draw_indirect_count() )
+    {
+        result = in_cmd_buffer_ptr->record_draw_indexed_indirect_count_KHR(in_cull_info.draw_command_buffer_ptr,
+                                                                           draw_offset,
+                                                                           in_cull_info.count_buffer_ptr,
+                                                                           count_offset,
+                                                                           in_cull_info.n_max_draws_per_stream,
+                                                                           sizeof(VkDrawIndexedIndirectCommand) );
+    }
+    else
+    if (extension_info_ptr->amd_draw_indirect_count() )
+    {
+        result = in_cmd_buffer_ptr->record_draw_indexed_indirect_count_AMD(in_cull_info.draw_command_buffer_ptr,
+                                                                           draw_offset,
+                                                                           in_cull_info.count_buffer_ptr,
+                                                                           count_offset,
+                                                                           in_cull_info.n_max_draws_per_stream,
+                                                                           sizeof(VkDrawIndexedIndirectCommand) );
+    }
+    else
+    {
+        /* Neither of the extensions has been enabled */
+        anvil_assert_fail();
+    }
+
+    return result;
+}
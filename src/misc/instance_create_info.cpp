@@ -26,15 +26,21 @@ Anvil::InstanceCreateInfo::InstanceCreateInfo(const std::string&              in
                                               Anvil::DebugCallbackFunction    in_opt_validation_callback_proc,
                                               bool                            in_mt_safe,
                                               const std::vector<std::string>& in_opt_disallowed_instance_level_extensions)
-    :m_api_version                         (Anvil::APIVersion::UNKNOWN),
-     m_app_name                            (in_app_name),
-     m_app_version                         (0),
-     m_disallowed_instance_level_extensions(in_opt_disallowed_instance_level_extensions),
-     m_engine_name                         (in_engine_name),
-     m_engine_version                      (0),
-     m_is_mt_safe                          (in_mt_safe),
-     m_n_memory_type_to_use_for_all_alocs  (UINT32_MAX),
-     m_validation_callback                 (in_opt_validation_callback_proc)
+    :m_api_version                              (Anvil::APIVersion::UNKNOWN),
+     m_app_name                                 (in_app_name),
+     m_app_version                              (0),
+     m_disallowed_instance_level_extensions     (in_opt_disallowed_instance_level_extensions),
+     m_engine_name                              (in_engine_name),
+     m_engine_version                           (0),
+     m_host_allocator_ptr                       (nullptr),
+     m_is_mt_safe                               (in_mt_safe),
+     m_n_memory_type_to_use_for_all_alocs       (UINT32_MAX),
+     m_validation_callback                      (in_opt_validation_callback_proc),
+     m_validation_async_delivery_enabled        (false),
+     m_validation_message_severity              (Anvil::DebugMessageSeverityFlagBits::ERROR_BIT | Anvil::DebugMessageSeverityFlagBits::INFO_BIT | Anvil::DebugMessageSeverityFlagBits::WARNING_BIT),
+     m_validation_message_types                 (Anvil::DebugMessageTypeFlagBits::VALIDATION_BIT),
+     m_validation_rate_limit_max_messages_per_id(0),
+     m_validation_rate_limit_period_msec        (0)
 {
     /* Stub */
 }
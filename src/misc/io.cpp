@@ -35,6 +35,8 @@
     #include <Windows.h>
 #else
     #include <dirent.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
     #include <unistd.h>
 #endif
 
@@ -253,6 +255,24 @@ end:
     return result;
 }
 
+/* Please see header for specification */
+bool Anvil::IO::get_file_modification_time(const std::string& in_filename,
+                                           uint64_t*          out_modification_time_ptr)
+{
+    bool        result    = false;
+    struct stat stat_data = {0};
+
+    if (stat(in_filename.c_str(),
+            &stat_data) == 0)
+    {
+        *out_modification_time_ptr = static_cast<uint64_t>(stat_data.st_mtime);
+
+        result = true;
+    }
+
+    return result;
+}
+
 /* Please see header for specification */
 bool Anvil::IO::is_directory(const std::string& in_path)
 {
@@ -269,6 +289,118 @@ bool Anvil::IO::is_directory(const std::string& in_path)
     return result;
 }
 
+/* Please see header for specification */
+bool Anvil::IO::map_file(const std::string& in_filename,
+                         const void**       out_data_ptr_ptr,
+                         size_t*            out_size_ptr)
+{
+    const void* data_ptr  = nullptr;
+    size_t      file_size = 0;
+    bool        result    = false;
+
+    anvil_assert(out_data_ptr_ptr != nullptr);
+    anvil_assert(out_size_ptr     != nullptr);
+
+    #if defined(_WIN32)
+    {
+        HANDLE             file_handle     = INVALID_HANDLE_VALUE;
+        LARGE_INTEGER      file_size_large;
+        const std::wstring filename_wide   = std::wstring(in_filename.begin(), in_filename.end() );
+        HANDLE             mapping_handle  = nullptr;
+
+        file_handle = ::CreateFileW(filename_wide.c_str(),
+                                    GENERIC_READ,
+                                    FILE_SHARE_READ,
+                                    nullptr, /* lpSecurityAttributes */
+                                    OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                    nullptr);
+
+        if (file_handle == INVALID_HANDLE_VALUE)
+        {
+            goto end;
+        }
+
+        if (::GetFileSizeEx(file_handle,
+                           &file_size_large) != 0)
+        {
+            file_size = static_cast<size_t>(file_size_large.QuadPart);
+        }
+
+        if (file_size > 0)
+        {
+            mapping_handle = ::CreateFileMappingW(file_handle,
+                                                  nullptr, /* lpFileMappingAttributes */
+                                                  PAGE_READONLY,
+                                                  0,        /* dwMaximumSizeHigh */
+                                                  0,        /* dwMaximumSizeLow  */
+                                                  nullptr); /* lpName            */
+        }
+
+        if (mapping_handle != nullptr)
+        {
+            data_ptr = ::MapViewOfFile(mapping_handle,
+                                       FILE_MAP_READ,
+                                       0,  /* dwFileOffsetHigh     */
+                                       0,  /* dwFileOffsetLow      */
+                                       0); /* dwNumberOfBytesToMap */
+
+            /* The view keeps the mapping object alive */
+            ::CloseHandle(mapping_handle);
+        }
+
+        ::CloseHandle(file_handle);
+    }
+    #else
+    {
+        const int   file_fd    = open(in_filename.c_str(),
+                                      O_RDONLY);
+        struct stat file_stats;
+
+        if (file_fd == -1)
+        {
+            goto end;
+        }
+
+        if (fstat(file_fd,
+                 &file_stats) == 0)
+        {
+            file_size = static_cast<size_t>(file_stats.st_size);
+        }
+
+        if (file_size > 0)
+        {
+            void* mapping_ptr = mmap(nullptr, /* addr */
+                                     file_size,
+                                     PROT_READ,
+                                     MAP_PRIVATE,
+                                     file_fd,
+                                     0);      /* offset */
+
+            if (mapping_ptr != MAP_FAILED)
+            {
+                data_ptr = mapping_ptr;
+            }
+        }
+
+        /* The mapping stays valid after the descriptor is closed */
+        close(file_fd);
+    }
+    #endif
+
+    if (data_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    *out_data_ptr_ptr = data_ptr;
+    *out_size_ptr     = file_size;
+
+    result = true;
+end:
+    return result;
+}
+
 /** Reads contents of a file with user-specified name and returns it to the caller.
  *
  *  @param in_filename        Name of the file to use for the operation.
@@ -546,6 +678,26 @@ end:
     return result_bool;
 }
 
+/* Please see header for specification */
+void Anvil::IO::unmap_file(const void* in_data_ptr,
+                           size_t      in_size)
+{
+    anvil_assert(in_data_ptr != nullptr);
+
+    #if defined(_WIN32)
+    {
+        ANVIL_REDUNDANT_ARGUMENT(in_size);
+
+        ::UnmapViewOfFile(in_data_ptr);
+    }
+    #else
+    {
+        munmap(const_cast<void*>(in_data_ptr),
+               in_size);
+    }
+    #endif
+}
+
 /** Please see header for specification */
 bool Anvil::IO::write_binary_file(std::string  in_filename,
                                   const void*  in_data,
@@ -614,4 +766,67 @@ end:
 
     return result;
 }
- 
\ No newline at end of file
+ 
+
+/* Please see header for specification */
+Anvil::MappedFile::MappedFile(const void* in_data_ptr,
+                              size_t      in_size)
+    :m_data_ptr(in_data_ptr),
+     m_size    (in_size)
+{
+    /* Stub */
+}
+
+/* Please see header for specification */
+Anvil::MappedFile::~MappedFile()
+{
+    Anvil::IO::unmap_file(m_data_ptr,
+                          m_size);
+}
+
+/* Please see header for specification */
+Anvil::MappedFileUniquePtr Anvil::MappedFile::create(const std::string& in_filename)
+{
+    const void*                data_ptr  = nullptr;
+    size_t                     data_size = 0;
+    Anvil::MappedFileUniquePtr result_ptr(nullptr,
+                                          std::default_delete<Anvil::MappedFile>() );
+
+    if (Anvil::IO::map_file(in_filename,
+                           &data_ptr,
+                           &data_size) )
+    {
+        result_ptr.reset(
+            new Anvil::MappedFile(data_ptr,
+                                  data_size)
+        );
+    }
+
+    return result_ptr;
+}
+
+/* Please see header for specification */
+void Anvil::MappedFile::prefetch() const
+{
+    const volatile unsigned char* data_ptr  = static_cast<const volatile unsigned char*>(m_data_ptr);
+    static const size_t           page_size = 4096;
+    unsigned char                 sum       = 0;
+
+    #if !defined(_WIN32)
+    {
+        madvise(const_cast<void*>(m_data_ptr),
+                m_size,
+                MADV_WILLNEED);
+    }
+    #endif
+
+    /* Reading a single byte of each page is enough to fault it in */
+    for (size_t offset = 0;
+                offset < m_size;
+                offset += page_size)
+    {
+        sum = static_cast<unsigned char>(sum + data_ptr[offset]);
+    }
+
+    ANVIL_REDUNDANT_VARIABLE(sum);
+}
@@ -0,0 +1,208 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#include "misc/debug.h"
+#include "misc/mapped_memory_range_batch.h"
+#include "misc/memory_block_create_info.h"
+#include "wrappers/device.h"
+#include "wrappers/memory_block.h"
+#include <algorithm>
+
+
+/** Please see header for specification */
+Anvil::MappedMemoryRangeBatch::MappedMemoryRangeBatch(const Anvil::BaseDevice* in_device_ptr)
+    :m_device_ptr            (in_device_ptr),
+     m_non_coherent_atom_size(in_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits.non_coherent_atom_size)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::MappedMemoryRangeBatch::~MappedMemoryRangeBatch()
+{
+    /* Stub */
+}
+
+/** Converts the specified memory block range to a memory range, rounded to non-coherent atom boundaries, and
+ *  appends it to @param inout_ranges_ptr. Ranges of host-coherent memory blocks are dropped.
+ **/
+void Anvil::MappedMemoryRangeBatch::add_range(Anvil::MemoryBlock* in_memory_block_ptr,
+                                              VkDeviceSize        in_start_offset,
+                                              VkDeviceSize        in_size,
+                                              std::vector<Range>* inout_ranges_ptr)
+{
+    const Anvil::MemoryBlock* root_memory_block_ptr = in_memory_block_ptr;
+
+    anvil_assert(in_memory_block_ptr                                      != nullptr);
+    anvil_assert(in_memory_block_ptr->get_create_info_ptr()->get_device() == m_device_ptr);
+    anvil_assert(in_size                                                  >  0);
+    anvil_assert(in_start_offset + in_size                                <= in_memory_block_ptr->get_create_info_ptr()->get_size() );
+
+    if ((in_memory_block_ptr->get_create_info_ptr()->get_memory_features() & Anvil::MemoryFeatureFlagBits::HOST_COHERENT_BIT) == 0)
+    {
+        VkDeviceSize end_offset   = 0;
+        VkDeviceSize max_offset   = 0;
+        VkDeviceSize start_offset = 0;
+
+        /* Rounding up must not step outside of the memory region owned by the root block */
+        while (root_memory_block_ptr->get_create_info_ptr()->get_parent_memory_block() != nullptr)
+        {
+            root_memory_block_ptr = root_memory_block_ptr->get_create_info_ptr()->get_parent_memory_block();
+        }
+
+        max_offset   = root_memory_block_ptr->get_start_offset() + root_memory_block_ptr->get_create_info_ptr()->get_size();
+        start_offset = Anvil::Utils::round_down(in_memory_block_ptr->get_start_offset() + in_start_offset,
+                                                m_non_coherent_atom_size);
+        end_offset   = std::min(Anvil::Utils::round_up(in_memory_block_ptr->get_start_offset() + in_start_offset + in_size,
+                                                       m_non_coherent_atom_size),
+                                max_offset);
+
+        inout_ranges_ptr->push_back(
+            Range(in_memory_block_ptr->get_memory(),
+                  start_offset,
+                  end_offset)
+        );
+    }
+}
+
+/** Please see header for specification */
+void Anvil::MappedMemoryRangeBatch::add_range_to_flush(Anvil::MemoryBlock* in_memory_block_ptr,
+                                                       VkDeviceSize        in_start_offset,
+                                                       VkDeviceSize        in_size)
+{
+    add_range(in_memory_block_ptr,
+              in_start_offset,
+              in_size,
+             &m_ranges_to_flush);
+}
+
+/** Please see header for specification */
+void Anvil::MappedMemoryRangeBatch::add_range_to_invalidate(Anvil::MemoryBlock* in_memory_block_ptr,
+                                                            VkDeviceSize        in_start_offset,
+                                                            VkDeviceSize        in_size)
+{
+    add_range(in_memory_block_ptr,
+              in_start_offset,
+              in_size,
+             &m_ranges_to_invalidate);
+}
+
+/** Please see header for specification */
+Anvil::MappedMemoryRangeBatchUniquePtr Anvil::MappedMemoryRangeBatch::create(const Anvil::BaseDevice* in_device_ptr)
+{
+    Anvil::MappedMemoryRangeBatchUniquePtr result_ptr(nullptr,
+                                                      std::default_delete<Anvil::MappedMemoryRangeBatch>() );
+
+    anvil_assert(in_device_ptr != nullptr);
+
+    result_ptr.reset(
+        new Anvil::MappedMemoryRangeBatch(in_device_ptr)
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+bool Anvil::MappedMemoryRangeBatch::flush()
+{
+    bool     result    = true;
+    VkResult result_vk = VK_SUCCESS;
+
+    merge_ranges(&m_ranges_to_flush,
+                 &m_vk_ranges);
+
+    if (m_vk_ranges.size() > 0)
+    {
+        result_vk = m_device_ptr->get_dispatch_table().vkFlushMappedMemoryRanges(m_device_ptr->get_device_vk(),
+                                                                                 static_cast<uint32_t>(m_vk_ranges.size() ),
+                                                                                &m_vk_ranges.at(0) );
+
+        anvil_assert_vk_call_succeeded(result_vk);
+        result = is_vk_call_successful(result_vk);
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::MappedMemoryRangeBatch::invalidate()
+{
+    bool     result    = true;
+    VkResult result_vk = VK_SUCCESS;
+
+    merge_ranges(&m_ranges_to_invalidate,
+                 &m_vk_ranges);
+
+    if (m_vk_ranges.size() > 0)
+    {
+        result_vk = m_device_ptr->get_dispatch_table().vkInvalidateMappedMemoryRanges(m_device_ptr->get_device_vk(),
+                                                                                      static_cast<uint32_t>(m_vk_ranges.size() ),
+                                                                                     &m_vk_ranges.at(0) );
+
+        anvil_assert_vk_call_succeeded(result_vk);
+        result = is_vk_call_successful(result_vk);
+    }
+
+    return result;
+}
+
+/** Sorts @param inout_ranges_ptr, merges overlapping & adjacent ranges of the same memory object into
+ *  @param out_vk_ranges_ptr, and clears @param inout_ranges_ptr.
+ **/
+void Anvil::MappedMemoryRangeBatch::merge_ranges(std::vector<Range>*               inout_ranges_ptr,
+                                                 std::vector<VkMappedMemoryRange>* out_vk_ranges_ptr) const
+{
+    out_vk_ranges_ptr->clear();
+
+    std::sort(inout_ranges_ptr->begin(),
+              inout_ranges_ptr->end  () );
+
+    for (const auto& current_range : *inout_ranges_ptr)
+    {
+        if (out_vk_ranges_ptr->size() > 0)
+        {
+            auto& last_vk_range = out_vk_ranges_ptr->back();
+
+            if (last_vk_range.memory                      == current_range.memory &&
+                last_vk_range.offset + last_vk_range.size >= current_range.start_offset)
+            {
+                last_vk_range.size = std::max(last_vk_range.offset + last_vk_range.size,
+                                              current_range.end_offset) - last_vk_range.offset;
+
+                continue;
+            }
+        }
+
+        {
+            VkMappedMemoryRange new_vk_range;
+
+            new_vk_range.memory = current_range.memory;
+            new_vk_range.offset = current_range.start_offset;
+            new_vk_range.pNext  = nullptr;
+            new_vk_range.size   = current_range.end_offset - current_range.start_offset;
+            new_vk_range.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+
+            out_vk_ranges_ptr->push_back(new_vk_range);
+        }
+    }
+
+    inout_ranges_ptr->clear();
+}
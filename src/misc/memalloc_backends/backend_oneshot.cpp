@@ -21,6 +21,7 @@
 //
 
 #include "misc/memalloc_backends/backend_oneshot.h"
+#include "misc/buffer_create_info.h"
 #include "misc/debug.h"
 #include "misc/formats.h"
 #include "misc/image_create_info.h"
@@ -35,11 +36,17 @@
 #include <cmath>
 
 /** Please see header for specification */
-Anvil::MemoryAllocatorBackends::OneShot::OneShot(const Anvil::BaseDevice* in_device_ptr)
-    :m_device_ptr(in_device_ptr),
-     m_is_baked  (false)
+Anvil::MemoryAllocatorBackends::OneShot::OneShot(const Anvil::BaseDevice* in_device_ptr,
+                                                  VkDeviceSize             in_min_block_size)
+    :m_device_ptr       (in_device_ptr),
+     m_min_block_size   (in_min_block_size),
+     m_n_allocations          (0),
+     m_n_dedicated_allocations(0),
+     m_n_bytes_allocated      (0),
+     m_n_bytes_used           (0)
 {
-    /* Stub */
+    m_memory_type_n_bytes_allocated.fill(0);
+    m_memory_type_n_bytes_used.fill     (0);
 }
 
 /** Please see header for specification */
@@ -82,8 +89,51 @@ namespace
     } MemoryUniqueInfo;
 }
 
-/** Tries to create a memory object of size large enough to capacitate all added objects,
- *  given their alignment, size, and other requirements.
+/** Creates a memory block derived from @param in_parent_memory_block_ptr for the specified item
+ *  and marks the item as baked.
+ *
+ *  @param in_item_ptr                Item to assign the memory block to. Must not be null.
+ *  @param in_parent_memory_block_ptr Memory block to derive the item's block from. Must not be null.
+ *  @param in_start_offset            Start offset of the item's region within the parent memory block.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::MemoryAllocatorBackends::OneShot::assign_derived_memory_block(Anvil::MemoryAllocator::Item* in_item_ptr,
+                                                                          Anvil::MemoryBlock*           in_parent_memory_block_ptr,
+                                                                          VkDeviceSize                  in_start_offset)
+{
+    {
+        auto create_info_ptr = Anvil::MemoryBlockCreateInfo::create_derived(in_parent_memory_block_ptr,
+                                                                            in_start_offset,
+                                                                            in_item_ptr->alloc_size);
+
+        in_item_ptr->alloc_memory_block_ptr = Anvil::MemoryBlock::create(std::move(create_info_ptr) );
+    }
+
+    if (in_item_ptr->alloc_memory_block_ptr == nullptr)
+    {
+        anvil_assert(in_item_ptr->alloc_memory_block_ptr != nullptr);
+
+        return false;
+    }
+
+    in_item_ptr->is_baked = true;
+
+    dynamic_cast<IMemoryBlockBackendSupport*>(in_item_ptr->alloc_memory_block_ptr.get() )->set_parent_memory_allocator_backend_ptr(shared_from_this(),
+                                                                                                                               reinterpret_cast<void*>(in_parent_memory_block_ptr->get_memory() ));
+
+    m_n_allocations++;
+    m_n_bytes_used                                                                                           += in_item_ptr->alloc_size;
+    m_memory_type_n_bytes_used.at(in_parent_memory_block_ptr->get_create_info_ptr()->get_memory_type_index()) += in_item_ptr->alloc_size;
+
+    return true;
+}
+
+/** Tries to assign memory regions to all added objects, given their alignment, size, and other requirements.
+ *
+ *  Non-dedicated objects are first packed into the unused tail of memory blocks created by earlier
+ *  bake invocations, as long as the blocks use a compatible memory type, device mask and priority.
+ *  For the remaining objects, a memory object large enough to capacitate all of them is created.
  *
  *  If the call is successful, each added object will have its set_memory() entry-point
  *  called with more details about what memory object they should use, along with
@@ -137,8 +187,16 @@ bool Anvil::MemoryAllocatorBackends::OneShot::bake(Anvil::MemoryAllocator::Items
               item_iterator != in_items.end();
             ++item_iterator)
     {
+        /* Honour the driver's preference for a dedicated allocation. Items which require one have already been
+         * flagged at add_*() call time. */
+        if (!(*item_iterator)->alloc_is_dedicated_memory &&
+             prefers_dedicated_alloc(item_iterator->get() ))
+        {
+            (*item_iterator)->alloc_is_dedicated_memory = true;
+        }
+
         /* Assign the item to supported memory types */
-        const auto& required_memory_features = ((*item_iterator)->alloc_memory_required_features);
+        const auto  required_memory_features = ((*item_iterator)->alloc_memory_required_features & ~Anvil::MemoryFeatureFlagBits::PREFER_DEVICE_LOCAL_BIT);
         const auto& supported_memory_types   = (*item_iterator)->alloc_memory_supported_memory_types;
 
         for (uint32_t n_memory_type = 0;
@@ -238,9 +296,10 @@ bool Anvil::MemoryAllocatorBackends::OneShot::bake(Anvil::MemoryAllocator::Items
                                                                                 current_unique_alloc.item_ptr->alloc_size,
                                                                                 (memory_props.types[current_unique_alloc.n_memory_type].features) );
 
-            create_info_ptr->set_memory_priority(current_unique_alloc.item_ptr->memory_priority);
-            create_info_ptr->set_device_mask    (current_unique_alloc.item_ptr->alloc_device_mask);
-            create_info_ptr->set_mt_safety      (Anvil::Utils::convert_boolean_to_mt_safety_enum(m_device_ptr->is_mt_safe()) );
+            create_info_ptr->set_memory_priority    (current_unique_alloc.item_ptr->memory_priority);
+            create_info_ptr->set_device_mask        (current_unique_alloc.item_ptr->alloc_device_mask);
+            create_info_ptr->set_mt_safety          (Anvil::Utils::convert_boolean_to_mt_safety_enum(m_device_ptr->is_mt_safe()) );
+            create_info_ptr->set_persistently_mapped(current_unique_alloc.item_ptr->memory_allocator_ptr->is_persistent_mapping_enabled() );
 
             if (current_unique_alloc.item_ptr->alloc_is_dedicated_memory)
             {
@@ -286,6 +345,22 @@ bool Anvil::MemoryAllocatorBackends::OneShot::bake(Anvil::MemoryAllocator::Items
             current_unique_alloc.item_ptr->is_baked               = (current_unique_alloc.item_ptr->alloc_memory_block_ptr != nullptr);
         }
 
+        {
+            const uint32_t memory_type_index = current_unique_alloc.item_ptr->alloc_memory_block_ptr->get_create_info_ptr()->get_memory_type_index();
+
+            m_n_allocations++;
+
+            if (current_unique_alloc.item_ptr->alloc_is_dedicated_memory)
+            {
+                m_n_dedicated_allocations++;
+            }
+
+            m_n_bytes_allocated                                  += current_unique_alloc.item_ptr->alloc_size;
+            m_n_bytes_used                                       += current_unique_alloc.item_ptr->alloc_size;
+            m_memory_type_n_bytes_allocated.at(memory_type_index) += current_unique_alloc.item_ptr->alloc_size;
+            m_memory_type_n_bytes_used.at     (memory_type_index) += current_unique_alloc.item_ptr->alloc_size;
+        }
+
         dynamic_cast<IMemoryBlockBackendSupport*>(current_unique_alloc.item_ptr->alloc_memory_block_ptr.get() )->set_parent_memory_allocator_backend_ptr(shared_from_this(),
                                                                                                                                                          reinterpret_cast<void*>(new_memory_block_ptr_derived->get_memory() ));
 
@@ -307,33 +382,85 @@ bool Anvil::MemoryAllocatorBackends::OneShot::bake(Anvil::MemoryAllocator::Items
 
             for (const auto& current_items : current_memory_info_to_item_vector_data.second)
             {
-                if (current_items.size() > 0)
+                std::vector<Anvil::MemoryAllocator::Item*> new_block_items;
+
+                /* Try to fit the items into the unused tail of compatible blocks which have been created by
+                 * earlier bake invocations. */
+                for (auto& current_item_ptr : current_items)
+                {
+                    const bool is_current_item_linear = is_item_linear(current_item_ptr);
+                    bool       is_item_assigned       = false;
+
+                    anvil_assert(current_item_ptr->alloc_exportable_external_handle_types == 0);
+
+                    #if defined(_WIN32)
+                        anvil_assert(current_item_ptr->alloc_external_nt_handle_info_ptr == nullptr);
+                    #endif
+
+                    for (auto& current_shared_block : m_shared_blocks)
+                    {
+                        const MemoryUniqueInfo shared_block_info(current_shared_block.device_mask,
+                                                                 current_shared_block.memory_priority);
+                        VkDeviceSize           start_offset     (0);
+
+                        if (current_shared_block.n_memory_type != current_memory_type_index ||
+                          !(shared_block_info                  == current_memory_info) )
+                        {
+                            continue;
+                        }
+
+                        start_offset = Anvil::Utils::round_up(current_shared_block.used_size,
+                                                              current_item_ptr->alloc_memory_required_alignment);
+
+                        /* Make sure to adhere to the buffer-image granularity requirement */
+                        if (current_shared_block.used_size           >  0 &&
+                            current_shared_block.is_last_item_linear != is_current_item_linear)
+                        {
+                            start_offset = Anvil::Utils::round_up(start_offset,
+                                                                  m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits.buffer_image_granularity);
+                        }
+
+                        if (start_offset + current_item_ptr->alloc_size > current_shared_block.size)
+                        {
+                            continue;
+                        }
+
+                        if (!assign_derived_memory_block(current_item_ptr,
+                                                         current_shared_block.memory_block_ptr.get(),
+                                                         start_offset) )
+                        {
+                            result = false;
+                        }
+
+                        current_shared_block.is_last_item_linear = is_current_item_linear;
+                        current_shared_block.used_size           = start_offset + current_item_ptr->alloc_size;
+
+                        is_item_assigned = true;
+                        break;
+                    }
+
+                    if (!is_item_assigned)
+                    {
+                        new_block_items.push_back(current_item_ptr);
+                    }
+                }
+
+                if (new_block_items.size() > 0)
                 {
                     Anvil::MemoryBlockUniquePtr new_memory_block_ptr(nullptr,
                                                                      std::default_delete<Anvil::MemoryBlock>() );
                     VkDeviceSize                n_bytes_required    (0);
+                    VkDeviceSize                n_bytes_to_alloc    (0);
+                    bool                        is_prev_item_linear (false);
 
                     /* Go through the items, calculate offsets and the total amount of memory we're going
                      * to need to alloc off the heap */
                     {
-                        bool                          is_prev_item_linear = false;
-                        Anvil::MemoryAllocator::Item* prev_item_ptr       = nullptr;
+                        Anvil::MemoryAllocator::Item* prev_item_ptr = nullptr;
 
-                        for (auto& current_item_ptr : current_items)
+                        for (auto& current_item_ptr : new_block_items)
                         {
-                            const bool is_current_item_buffer  = (current_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_BUFFER                   ||
-                                                                  current_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_SPARSE_BUFFER_REGION);
-                            const bool is_current_item_image   = (current_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_IMAGE_WHOLE              ||
-                                                                  current_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_SPARSE_IMAGE_MIPTAIL     ||
-                                                                  current_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_SPARSE_IMAGE_SUBRESOURCE);
-                            const bool is_current_item_linear = (is_current_item_buffer)                                                                                                  ||
-                                                                (is_current_item_image && current_item_ptr->image_ptr->get_create_info_ptr()->get_tiling() == Anvil::ImageTiling::LINEAR);
-
-                            anvil_assert(current_item_ptr->alloc_exportable_external_handle_types == 0);
-
-                            #if defined(_WIN32)
-                                anvil_assert(current_item_ptr->alloc_external_nt_handle_info_ptr == nullptr);
-                            #endif
+                            const bool is_current_item_linear = is_item_linear(current_item_ptr);
 
                             n_bytes_required = Anvil::Utils::round_up(n_bytes_required,
                                                                       current_item_ptr->alloc_memory_required_alignment);
@@ -356,16 +483,21 @@ bool Anvil::MemoryAllocatorBackends::OneShot::bake(Anvil::MemoryAllocator::Items
                         }
                     }
 
+                    /* Over-allocate if requested, so that later bakes can reuse the slack */
+                    n_bytes_to_alloc = std::max(n_bytes_required,
+                                                m_min_block_size);
+
                     /* Bake the block and stash it */
                     {
                         auto create_info_ptr = Anvil::MemoryBlockCreateInfo::create_regular(m_device_ptr,
                                                                                             1u << current_memory_type_index,
-                                                                                            n_bytes_required,
+                                                                                            n_bytes_to_alloc,
                                                                                             (memory_props.types[current_memory_type_index].features) );
 
-                        create_info_ptr->set_memory_priority(current_memory_info_to_item_vector_data.first.memory_priority);
-                        create_info_ptr->set_device_mask    (current_memory_info.device_mask);
-                        create_info_ptr->set_mt_safety      (Anvil::Utils::convert_boolean_to_mt_safety_enum(m_device_ptr->is_mt_safe()) );
+                        create_info_ptr->set_memory_priority    (current_memory_info_to_item_vector_data.first.memory_priority);
+                        create_info_ptr->set_device_mask        (current_memory_info.device_mask);
+                        create_info_ptr->set_mt_safety          (Anvil::Utils::convert_boolean_to_mt_safety_enum(m_device_ptr->is_mt_safe()) );
+                        create_info_ptr->set_persistently_mapped(new_block_items.at(0)->memory_allocator_ptr->is_persistent_mapping_enabled() );
 
                         new_memory_block_ptr = Anvil::MemoryBlock::create(std::move(create_info_ptr) );
                     }
@@ -375,31 +507,33 @@ bool Anvil::MemoryAllocatorBackends::OneShot::bake(Anvil::MemoryAllocator::Items
                         anvil_assert(new_memory_block_ptr != nullptr);
 
                         result = false;
+
+                        ++current_memory_type_index;
                         continue;
                     }
 
                     /* Go through the items again and assign the result memory block */
-                    for (auto& current_item_ptr : current_items)
+                    for (auto& current_item_ptr : new_block_items)
                     {
+                        if (!assign_derived_memory_block(current_item_ptr,
+                                                         new_memory_block_ptr.get(),
+                                                         alloc_offset_map.at(current_item_ptr) ))
                         {
-                            auto create_info_ptr = Anvil::MemoryBlockCreateInfo::create_derived(new_memory_block_ptr.get(),
-                                                                                                alloc_offset_map.at(current_item_ptr),
-                                                                                                current_item_ptr->alloc_size);
-
-                            current_item_ptr->alloc_memory_block_ptr = Anvil::MemoryBlock::create(std::move(create_info_ptr) );
-                        }
-
-                        if (current_item_ptr->alloc_memory_block_ptr != nullptr)
-                        {
-                            current_item_ptr->is_baked = true;
+                            result = false;
                         }
-
-                        dynamic_cast<IMemoryBlockBackendSupport*>(current_item_ptr->alloc_memory_block_ptr.get() )->set_parent_memory_allocator_backend_ptr(shared_from_this(),
-                                                                                                                                                            reinterpret_cast<void*>(new_memory_block_ptr->get_memory() ));
                     }
 
-                    m_memory_blocks.push_back(
-                        std::move(new_memory_block_ptr)
+                    m_n_bytes_allocated                                          += n_bytes_to_alloc;
+                    m_memory_type_n_bytes_allocated.at(current_memory_type_index) += n_bytes_to_alloc;
+
+                    m_shared_blocks.push_back(
+                        SharedBlock(std::move(new_memory_block_ptr),
+                                    current_memory_type_index,
+                                    current_memory_info.device_mask,
+                                    current_memory_info.memory_priority,
+                                    n_bytes_to_alloc,
+                                    n_bytes_required,
+                                    is_prev_item_linear)
                     );
                 }
 
@@ -408,8 +542,6 @@ bool Anvil::MemoryAllocatorBackends::OneShot::bake(Anvil::MemoryAllocator::Items
         }
     }
 
-    m_is_baked = true;
-
     /* One-shot backend is not able to handle cases where only a portion of scheduled
      * items was successfully assigned memory backing.
      */
@@ -427,23 +559,211 @@ VkResult Anvil::MemoryAllocatorBackends::OneShot::map(void*        in_memory_obj
 {
     ANVIL_REDUNDANT_VARIABLE(in_memory_block_start_offset);
 
-    return Anvil::Vulkan::vkMapMemory(m_device_ptr->get_device_vk(),
-                                      reinterpret_cast<VkDeviceMemory>(in_memory_object),
-                                      in_start_offset,
-                                      in_size,
-                                      0, /* flags */
-                                      out_result_ptr);
+    return m_device_ptr->get_dispatch_table().vkMapMemory(m_device_ptr->get_device_vk(),
+                                                          reinterpret_cast<VkDeviceMemory>(in_memory_object),
+                                                          in_start_offset,
+                                                          in_size,
+                                                          0, /* flags */
+                                                          out_result_ptr);
+}
+
+/** One-shot memory allocator backend does not support defragmentation. */
+bool Anvil::MemoryAllocatorBackends::OneShot::defragment(const std::vector<void*>&                                in_backend_objects,
+                                                         uint32_t                                                 in_n_max_moves,
+                                                         std::vector<Anvil::MemoryAllocator::MovedBackendObject>* out_moved_objects_ptr,
+                                                         Anvil::MemoryAllocator::DefragmentationStats*            inout_stats_ptr,
+                                                         bool*                                                    out_is_complete_ptr)
+{
+    ANVIL_REDUNDANT_ARGUMENT_CONST(in_backend_objects);
+    ANVIL_REDUNDANT_ARGUMENT      (in_n_max_moves);
+    ANVIL_REDUNDANT_ARGUMENT      (out_moved_objects_ptr);
+    ANVIL_REDUNDANT_ARGUMENT      (inout_stats_ptr);
+    ANVIL_REDUNDANT_ARGUMENT      (out_is_complete_ptr);
+
+    anvil_assert_fail();
+
+    return false;
+}
+
+/** Lists all memory blocks created so far, together with their used & reserved sizes.
+ *
+ *  Dedicated blocks are always fully used. Shared blocks only have unused space at their tail.
+ **/
+void Anvil::MemoryAllocatorBackends::OneShot::get_json_dump(std::string* out_json_ptr) const
+{
+    char        block_data[192];
+    bool        is_first_block = true;
+    std::string result         = "{\"Blocks\":[";
+
+    for (const auto& current_block_ptr : m_memory_blocks)
+    {
+        snprintf(block_data,
+                 sizeof(block_data),
+                 "%s\n{\"MemoryType\":%u,\"Dedicated\":true,\"Size\":%llu,\"UsedSize\":%llu}",
+                 (is_first_block) ? "" : ",",
+                 current_block_ptr->get_create_info_ptr()->get_memory_type_index(),
+                 static_cast<unsigned long long>(current_block_ptr->get_create_info_ptr()->get_size() ),
+                 static_cast<unsigned long long>(current_block_ptr->get_create_info_ptr()->get_size() ) );
+
+        result        += block_data;
+        is_first_block = false;
+    }
+
+    for (const auto& current_block : m_shared_blocks)
+    {
+        snprintf(block_data,
+                 sizeof(block_data),
+                 "%s\n{\"MemoryType\":%u,\"Dedicated\":false,\"Size\":%llu,\"UsedSize\":%llu}",
+                 (is_first_block) ? "" : ",",
+                 current_block.n_memory_type,
+                 static_cast<unsigned long long>(current_block.size),
+                 static_cast<unsigned long long>(current_block.used_size) );
+
+        result        += block_data;
+        is_first_block = false;
+    }
+
+    result += "\n]}";
+
+    *out_json_ptr = std::move(result);
+}
+
+/** One-shot allocator does not support custom memory pools. Always returns 0. */
+uint32_t Anvil::MemoryAllocatorBackends::OneShot::get_n_pools() const
+{
+    return 0;
+}
+
+/** Fills @param out_stats_ptr with the totals of all memory blocks created & regions handed out so far.
+ *
+ *  Since regions are never reclaimed, released objects are still accounted for.
+ **/
+void Anvil::MemoryAllocatorBackends::OneShot::get_stats(Anvil::MemoryAllocator::Stats* out_stats_ptr) const
+{
+    out_stats_ptr->n_allocations           = m_n_allocations;
+    out_stats_ptr->n_dedicated_allocations = m_n_dedicated_allocations;
+    out_stats_ptr->n_bytes_allocated       = m_n_bytes_allocated;
+    out_stats_ptr->n_bytes_used            = m_n_bytes_used;
+    out_stats_ptr->n_memory_blocks         = static_cast<uint32_t>(m_memory_blocks.size() + m_shared_blocks.size() );
+
+    out_stats_ptr->memory_type_n_bytes_allocated = m_memory_type_n_bytes_allocated;
+    out_stats_ptr->memory_type_n_bytes_used      = m_memory_type_n_bytes_used;
+
+    for (const auto& current_block_ptr : m_memory_blocks)
+    {
+        out_stats_ptr->memory_type_n_memory_blocks.at(current_block_ptr->get_create_info_ptr()->get_memory_type_index() )++;
+    }
+
+    /* Shared blocks are filled front to back, so the only unused range is at the tail */
+    for (const auto& current_block : m_shared_blocks)
+    {
+        const VkDeviceSize n_free_bytes                   = current_block.size - current_block.used_size;
+        auto&              memory_type_largest_free_range = out_stats_ptr->memory_type_largest_free_range.at(current_block.n_memory_type);
+
+        out_stats_ptr->memory_type_n_memory_blocks.at(current_block.n_memory_type)++;
+
+        out_stats_ptr->largest_free_range = std::max(out_stats_ptr->largest_free_range,
+                                                     n_free_bytes);
+        memory_type_largest_free_range    = std::max(memory_type_largest_free_range,
+                                                     n_free_bytes);
+    }
+}
+
+/** Tells whether the item's memory is going to be accessed in a linear fashion, as far as the buffer-image
+ *  granularity requirement is concerned.
+ **/
+bool Anvil::MemoryAllocatorBackends::OneShot::is_item_linear(const Anvil::MemoryAllocator::Item* in_item_ptr) const
+{
+    const bool is_buffer = (in_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_BUFFER                   ||
+                            in_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_SPARSE_BUFFER_REGION);
+    const bool is_image  = (in_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_IMAGE_WHOLE              ||
+                            in_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_SPARSE_IMAGE_MIPTAIL     ||
+                            in_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_SPARSE_IMAGE_SUBRESOURCE);
+
+    return (is_buffer)                                                                                     ||
+           (is_image && in_item_ptr->image_ptr->get_create_info_ptr()->get_tiling() == Anvil::ImageTiling::LINEAR);
+}
+
+/** Tells whether the driver prefers the item to be assigned a dedicated memory allocation, as reported
+ *  by VkMemoryDedicatedRequirements at object creation time.
+ *
+ *  Always returns false if VK_KHR_dedicated_allocation is not enabled, and for sparse resources and
+ *  disjoint images, which cannot be bound to dedicated allocations. Also returns false for items with a
+ *  peer view, as the memory block is shared with a second resource.
+ **/
+bool Anvil::MemoryAllocatorBackends::OneShot::prefers_dedicated_alloc(const Anvil::MemoryAllocator::Item* in_item_ptr) const
+{
+    bool result = false;
+
+    if (!m_device_ptr->get_extension_info()->khr_dedicated_allocation() )
+    {
+        goto end;
+    }
+
+    if (in_item_ptr->peer_view_buffer_ptr != nullptr ||
+        in_item_ptr->peer_view_image_ptr  != nullptr)
+    {
+        goto end;
+    }
+
+    switch (in_item_ptr->type)
+    {
+        case Anvil::MemoryAllocator::ITEM_TYPE_BUFFER:
+        {
+            const auto& create_flags = in_item_ptr->buffer_ptr->get_create_info_ptr()->get_create_flags();
+
+            if ((create_flags & Anvil::BufferCreateFlagBits::SPARSE_BINDING_BIT) == 0)
+            {
+                result = in_item_ptr->buffer_ptr->prefers_dedicated_allocation();
+            }
+
+            break;
+        }
+
+        case Anvil::MemoryAllocator::ITEM_TYPE_IMAGE_WHOLE:
+        {
+            const auto& create_flags = in_item_ptr->image_ptr->get_create_info_ptr()->get_create_flags();
+
+            if ((create_flags & (Anvil::ImageCreateFlagBits::CREATE_DISJOINT_BIT  |
+                                 Anvil::ImageCreateFlagBits::SPARSE_BINDING_BIT)) == 0)
+            {
+                result = in_item_ptr->image_ptr->prefers_dedicated_allocation(in_item_ptr->n_plane);
+            }
+
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+end:
+    return result;
 }
 
 /** Tells whether or not the backend is ready to handle allocation request.
  *
- *  One-shot memory allocator backend will return true until the first bake() invocation,
-  * after which it's always going to return false (even if not all items have been assigned
-  * memory regions successfully
-  **/
+ *  One-shot memory allocator backend can handle an arbitrary number of bake() invocations,
+ *  so this function always returns true.
+ **/
 bool Anvil::MemoryAllocatorBackends::OneShot::supports_baking() const
 {
-    return !m_is_baked;
+    return true;
+}
+
+/** One-shot allocator packs all items of a memory type into a single memory block and keeps per-backend
+ *  allocation stats, so items cannot be baked concurrently. Always returns false.
+ **/
+bool Anvil::MemoryAllocatorBackends::OneShot::supports_concurrent_bakes() const
+{
+    return false;
+}
+
+bool Anvil::MemoryAllocatorBackends::OneShot::supports_defragmentation() const
+{
+    return false;
 }
 
 bool Anvil::MemoryAllocatorBackends::OneShot::supports_device_masks() const
@@ -463,6 +783,6 @@ bool Anvil::MemoryAllocatorBackends::OneShot::supports_protected_memory() const
 
 void Anvil::MemoryAllocatorBackends::OneShot::unmap(void* in_memory_object)
 {
-    Anvil::Vulkan::vkUnmapMemory(m_device_ptr->get_device_vk(),
-                                 reinterpret_cast<VkDeviceMemory>(in_memory_object) );
+    m_device_ptr->get_dispatch_table().vkUnmapMemory(m_device_ptr->get_device_vk(),
+                                                     reinterpret_cast<VkDeviceMemory>(in_memory_object) );
 }
@@ -25,6 +25,9 @@
 #include "wrappers/device.h"
 #include "wrappers/memory_block.h"
 #include "wrappers/physical_device.h"
+#include <algorithm>
+#include <map>
+#include <mutex>
 
 /* Inject Vulkan Memory Allocator impl (ignore any warnings reported for the library) ==> */
 #define VMA_IMPLEMENTATION 
@@ -50,11 +53,50 @@
 
 /* <== */
 
+/* VMA is not aware of VK_KHR_buffer_device_address. On devices which have the extension enabled, VMA's memory
+ * allocations are routed through a shim which chains VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR, so that buffers
+ * created with SHADER_DEVICE_ADDRESS usage can be bound to VMA-managed memory.
+ *
+ * VMA calls the func ptr without any user data, so the shim looks up the device's actual vkAllocateMemory()
+ * entrypoint in a map, which also tracks the number of VMA allocators using it.
+ */
+static std::mutex                                                     g_device_address_shim_cs;
+static std::map<VkDevice, std::pair<PFN_vkAllocateMemory, uint32_t> > g_device_address_shim_func_ptrs;
+
+static VKAPI_ATTR VkResult VKAPI_CALL allocate_memory_with_device_address(VkDevice                     in_device,
+                                                                           const VkMemoryAllocateInfo*  in_allocate_info_ptr,
+                                                                           const VkAllocationCallbacks* in_allocator_ptr,
+                                                                           VkDeviceMemory*              out_memory_ptr)
+{
+    VkMemoryAllocateFlagsInfoKHR alloc_flags_info;
+    VkMemoryAllocateInfo         allocate_info    = *in_allocate_info_ptr;
+    PFN_vkAllocateMemory         func_ptr         = nullptr;
+
+    {
+        std::unique_lock<std::mutex> lock(g_device_address_shim_cs);
+
+        func_ptr = g_device_address_shim_func_ptrs.at(in_device).first;
+    }
+
+    alloc_flags_info.deviceMask = 0;
+    alloc_flags_info.flags      = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR;
+    alloc_flags_info.pNext      = in_allocate_info_ptr->pNext;
+    alloc_flags_info.sType      = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO_KHR;
+
+    allocate_info.pNext = &alloc_flags_info;
+
+    return func_ptr(in_device,
+                   &allocate_info,
+                    in_allocator_ptr,
+                    out_memory_ptr);
+}
+
 
 /* Please see header for specification */
 Anvil::MemoryAllocatorBackends::VMA::VMAAllocator::VMAAllocator(const Anvil::BaseDevice* in_device_ptr)
-    :m_allocator (nullptr),
-     m_device_ptr(in_device_ptr)
+    :m_allocator               (nullptr),
+     m_device_ptr              (in_device_ptr),
+     m_uses_device_address_shim(false)
 {
     /* Stub */
 }
@@ -68,6 +110,19 @@ Anvil::MemoryAllocatorBackends::VMA::VMAAllocator::~VMAAllocator()
 
         m_allocator = nullptr;
     }
+
+    if (m_uses_device_address_shim)
+    {
+        std::unique_lock<std::mutex> lock         (g_device_address_shim_cs);
+        auto                         shim_iterator(g_device_address_shim_func_ptrs.find(m_device_ptr->get_device_vk() ) );
+
+        anvil_assert(shim_iterator != g_device_address_shim_func_ptrs.end() );
+
+        if (--shim_iterator->second.second == 0)
+        {
+            g_device_address_shim_func_ptrs.erase(shim_iterator);
+        }
+    }
 }
 
 /* Please see header for specifications */
@@ -97,6 +152,7 @@ std::shared_ptr<Anvil::MemoryAllocatorBackends::VMA::VMAAllocator> Anvil::Memory
 bool Anvil::MemoryAllocatorBackends::VMA::VMAAllocator::init()
 {
     VmaAllocatorCreateInfo create_info                        = {};
+    const auto&            dispatch_table                     = m_device_ptr->get_dispatch_table();
     const bool             khr_dedicated_allocation_supported = m_device_ptr->get_extension_info()->khr_dedicated_allocation();
     VkResult               result                             = VK_ERROR_DEVICE_LOST;
 
@@ -112,20 +168,20 @@ bool Anvil::MemoryAllocatorBackends::VMA::VMAAllocator::init()
         goto end;
     }
 
-    m_vma_func_ptrs->vkAllocateMemory                    = Vulkan::vkAllocateMemory;
-    m_vma_func_ptrs->vkBindBufferMemory                  = Vulkan::vkBindBufferMemory;
-    m_vma_func_ptrs->vkBindImageMemory                   = Vulkan::vkBindImageMemory;
-    m_vma_func_ptrs->vkCreateBuffer                      = Vulkan::vkCreateBuffer;
-    m_vma_func_ptrs->vkCreateImage                       = Vulkan::vkCreateImage;
-    m_vma_func_ptrs->vkDestroyBuffer                     = Vulkan::vkDestroyBuffer;
-    m_vma_func_ptrs->vkDestroyImage                      = Vulkan::vkDestroyImage;
-    m_vma_func_ptrs->vkFreeMemory                        = Vulkan::vkFreeMemory;
-    m_vma_func_ptrs->vkGetBufferMemoryRequirements       = Vulkan::vkGetBufferMemoryRequirements;
-    m_vma_func_ptrs->vkGetImageMemoryRequirements        = Vulkan::vkGetImageMemoryRequirements;
+    m_vma_func_ptrs->vkAllocateMemory                    = dispatch_table.vkAllocateMemory;
+    m_vma_func_ptrs->vkBindBufferMemory                  = dispatch_table.vkBindBufferMemory;
+    m_vma_func_ptrs->vkBindImageMemory                   = dispatch_table.vkBindImageMemory;
+    m_vma_func_ptrs->vkCreateBuffer                      = dispatch_table.vkCreateBuffer;
+    m_vma_func_ptrs->vkCreateImage                       = dispatch_table.vkCreateImage;
+    m_vma_func_ptrs->vkDestroyBuffer                     = dispatch_table.vkDestroyBuffer;
+    m_vma_func_ptrs->vkDestroyImage                      = dispatch_table.vkDestroyImage;
+    m_vma_func_ptrs->vkFreeMemory                        = dispatch_table.vkFreeMemory;
+    m_vma_func_ptrs->vkGetBufferMemoryRequirements       = dispatch_table.vkGetBufferMemoryRequirements;
+    m_vma_func_ptrs->vkGetImageMemoryRequirements        = dispatch_table.vkGetImageMemoryRequirements;
     m_vma_func_ptrs->vkGetPhysicalDeviceMemoryProperties = Vulkan::vkGetPhysicalDeviceMemoryProperties;
     m_vma_func_ptrs->vkGetPhysicalDeviceProperties       = Vulkan::vkGetPhysicalDeviceProperties;
-    m_vma_func_ptrs->vkMapMemory                         = Vulkan::vkMapMemory;
-    m_vma_func_ptrs->vkUnmapMemory                       = Vulkan::vkUnmapMemory;
+    m_vma_func_ptrs->vkMapMemory                         = dispatch_table.vkMapMemory;
+    m_vma_func_ptrs->vkUnmapMemory                       = dispatch_table.vkUnmapMemory;
 
     if (m_device_ptr->get_extension_info()->khr_get_memory_requirements2() )
     {
@@ -138,6 +194,18 @@ bool Anvil::MemoryAllocatorBackends::VMA::VMAAllocator::init()
         m_vma_func_ptrs->vkGetImageMemoryRequirements2KHR  = nullptr;
     }
 
+    if (m_device_ptr->get_extension_info()->khr_buffer_device_address() )
+    {
+        std::unique_lock<std::mutex> lock     (g_device_address_shim_cs);
+        auto&                        shim_data(g_device_address_shim_func_ptrs[m_device_ptr->get_device_vk()]);
+
+        shim_data.first   = dispatch_table.vkAllocateMemory;
+        shim_data.second += 1;
+
+        m_uses_device_address_shim        = true;
+        m_vma_func_ptrs->vkAllocateMemory = allocate_memory_with_device_address;
+    }
+
     /* Prepare VMA create info struct */
     switch (m_device_ptr->get_type() )
     {
@@ -171,7 +239,7 @@ bool Anvil::MemoryAllocatorBackends::VMA::VMAAllocator::init()
 
     create_info.flags                       = (khr_dedicated_allocation_supported) ? VMA_ALLOCATOR_CREATE_KHR_DEDICATED_ALLOCATION_BIT : 0;
     create_info.device                      = m_device_ptr->get_device_vk();
-    create_info.pAllocationCallbacks        = nullptr;
+    create_info.pAllocationCallbacks        = m_device_ptr->get_allocation_callbacks_vk();
     create_info.preferredLargeHeapBlockSize = 0;
     create_info.pVulkanFunctions            = m_vma_func_ptrs.get();
 
@@ -185,7 +253,8 @@ end:
 
 /** Please see header for specification */
 Anvil::MemoryAllocatorBackends::VMA::VMA(const Anvil::BaseDevice* in_device_ptr)
-    :m_device_ptr(in_device_ptr)
+    :m_device_ptr             (in_device_ptr),
+     m_n_dedicated_allocations(0)
 {
     /* Stub */
 }
@@ -193,7 +262,20 @@ Anvil::MemoryAllocatorBackends::VMA::VMA(const Anvil::BaseDevice* in_device_ptr)
 /** Please see header for specification */
 Anvil::MemoryAllocatorBackends::VMA::~VMA()
 {
-    /* Stub */
+    /* Pool blocks must be released before the VMA pools they were allocated from. This also needs to happen
+     * before the VMA allocator goes out of scope, since the blocks may hold a persistent mapping. */
+    for (auto& current_pool_ptr : m_pools)
+    {
+        current_pool_ptr->blocks.clear();
+
+        if (current_pool_ptr->pool != VK_NULL_HANDLE)
+        {
+            vmaDestroyPool(m_vma_allocator_ptr->get_handle(),
+                           current_pool_ptr->pool);
+
+            current_pool_ptr->pool = VK_NULL_HANDLE;
+        }
+    }
 }
 
 /** For each specified Memory Allocator's Item, the function asks VMA for a memory region that
@@ -218,7 +300,17 @@ bool Anvil::MemoryAllocatorBackends::VMA::bake(Anvil::MemoryAllocator::Items& in
      */
     for (auto& current_item_ptr : in_items)
     {
-        anvil_assert(current_item_ptr->memory_priority == FLT_MAX); /* VMA doesn't support memory_priority */
+        /* VMA cannot chain VkMemoryPriorityAllocateInfoEXT. If VK_EXT_pageable_device_local_memory is available,
+         * give prioritized items their own allocation and set the priority once it has been made. Otherwise,
+         * the priority is ignored. */
+        const bool uses_memory_priority = (current_item_ptr->memory_priority != FLT_MAX                             &&
+                                           m_device_ptr->get_extension_info()->ext_pageable_device_local_memory() );
+
+        /* Dedicated allocations, including prioritized ones, never come from a custom pool */
+        Pool* const pool_ptr = (current_item_ptr->pool_id != UINT32_MAX               &&
+                                !current_item_ptr->alloc_is_dedicated_memory          &&
+                                !uses_memory_priority)                                ? m_pools.at(current_item_ptr->pool_id).get()
+                                                                                      : nullptr;
 
         MemoryBlockUniquePtr new_memory_block_ptr(nullptr,
                                                   std::default_delete<Anvil::MemoryBlock>() );
@@ -232,6 +324,29 @@ bool Anvil::MemoryAllocatorBackends::VMA::bake(Anvil::MemoryAllocator::Items& in
         Anvil::MemoryHeapFlags                      required_mem_heap_flags;
         Anvil::MemoryPropertyFlags                  required_mem_property_flags;
 
+        if (pool_ptr != nullptr)
+        {
+            if ((current_item_ptr->alloc_memory_supported_memory_types & (1u << pool_ptr->create_info.memory_type_index)) == 0)
+            {
+                /* The pool's memory type cannot back this item */
+                anvil_assert_fail();
+
+                result = false;
+                continue;
+            }
+
+            if (pool_ptr->create_info.algorithm != Anvil::VMAPoolAlgorithm::DEFAULT)
+            {
+                if (!bake_pool_item(pool_ptr,
+                                    current_item_ptr.get() ))
+                {
+                    result = false;
+                }
+
+                continue;
+            }
+        }
+
         Anvil::Utils::get_vk_property_flags_from_memory_feature_flags(current_item_ptr->alloc_memory_required_features,
                                                                      &required_mem_property_flags,
                                                                      &required_mem_heap_flags);
@@ -243,10 +358,15 @@ bool Anvil::MemoryAllocatorBackends::VMA::bake(Anvil::MemoryAllocator::Items& in
         memory_requirements_vk.memoryTypeBits = current_item_ptr->alloc_memory_supported_memory_types;
         memory_requirements_vk.size           = current_item_ptr->alloc_size;
 
-        allocation_create_info.flags         = (current_item_ptr->alloc_is_dedicated_memory) ? VmaAllocationCreateFlagBits::VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT
-                                                                                             : 0;
+        allocation_create_info.flags         = (current_item_ptr->alloc_is_dedicated_memory || uses_memory_priority) ? VmaAllocationCreateFlagBits::VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT
+                                                                                                                     : 0;
         allocation_create_info.requiredFlags = required_mem_property_flags.get_vk();
 
+        if (pool_ptr != nullptr)
+        {
+            allocation_create_info.pool = pool_ptr->pool;
+        }
+
         result_vk = vmaAllocateMemory(m_vma_allocator_ptr->get_handle(),
                                      &memory_requirements_vk,
                                      &allocation_create_info,
@@ -282,6 +402,8 @@ bool Anvil::MemoryAllocatorBackends::VMA::bake(Anvil::MemoryAllocator::Items& in
                                                                                                         allocation_info.offset,
                                                                                                         release_callback_function);
 
+            create_info_ptr->set_persistently_mapped(current_item_ptr->memory_allocator_ptr->is_persistent_mapping_enabled() );
+
             if (is_dedicated_alloc)
             {
                 if (current_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_BUFFER               ||
@@ -318,18 +440,305 @@ bool Anvil::MemoryAllocatorBackends::VMA::bake(Anvil::MemoryAllocator::Items& in
         dynamic_cast<IMemoryBlockBackendSupport*>(new_memory_block_ptr.get() )->set_parent_memory_allocator_backend_ptr(shared_from_this(),
                                                                                                                         allocation);
 
+        if (uses_memory_priority)
+        {
+            new_memory_block_ptr->set_priority(current_item_ptr->memory_priority);
+        }
+
         current_item_ptr->alloc_memory_block_ptr = std::move(new_memory_block_ptr);
         current_item_ptr->alloc_size             = memory_requirements_vk.size;
         current_item_ptr->is_baked               = true;
 
+        if (is_dedicated_alloc)
+        {
+            m_n_dedicated_allocations++;
+        }
+
         m_vma_allocator_ptr->on_new_vma_mem_block_alloced();
     }
 
     return result;
 }
 
+/** Assigns a region of a LINEAR or RING_BUFFER pool to the specified item. If none of the pool's blocks
+ *  has enough space left, a new block is allocated, as long as the pool has not reached its block limit.
+ *
+ *  @param in_pool_ptr Pool to allocate the region from. Must not be null.
+ *  @param in_item_ptr Item to bake. Must not be null.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::MemoryAllocatorBackends::VMA::bake_pool_item(Pool*                         in_pool_ptr,
+                                                         Anvil::MemoryAllocator::Item* in_item_ptr)
+{
+    PoolBlock*                      block_ptr           = nullptr;
+    std::unique_lock<std::mutex>    lock                (in_pool_ptr->mutex);
+    const uint32_t                  n_max_blocks        = (in_pool_ptr->create_info.algorithm == Anvil::VMAPoolAlgorithm::RING_BUFFER) ? 1
+                                                                                                                                       : in_pool_ptr->create_info.max_n_blocks;
+    MemoryBlockUniquePtr            new_memory_block_ptr(nullptr,
+                                                         std::default_delete<Anvil::MemoryBlock>() );
+    std::list<PoolRegion>::iterator region_iterator;
+    bool                            result              = false;
+    VkDeviceSize                    start_offset        = 0;
+
+    if (in_item_ptr->alloc_size > in_pool_ptr->create_info.block_size)
+    {
+        anvil_assert(in_item_ptr->alloc_size <= in_pool_ptr->create_info.block_size);
+
+        goto end;
+    }
+
+    /* Most recently created blocks are the most likely to have space left */
+    for (auto block_iterator  = in_pool_ptr->blocks.rbegin();
+              block_iterator != in_pool_ptr->blocks.rend()   && block_ptr == nullptr;
+            ++block_iterator)
+    {
+        if (find_pool_region(in_pool_ptr,
+                             block_iterator->get(),
+                             in_item_ptr->alloc_size,
+                             in_item_ptr->alloc_memory_required_alignment,
+                            &start_offset) )
+        {
+            block_ptr = block_iterator->get();
+        }
+    }
+
+    if (block_ptr == nullptr)
+    {
+        /* A full pool is not an error. The app may retry once older regions have been released. */
+        if (n_max_blocks != 0                                                &&
+            static_cast<uint32_t>(in_pool_ptr->blocks.size() ) >= n_max_blocks)
+        {
+            goto end;
+        }
+
+        if (!create_pool_block(in_pool_ptr,
+                               in_item_ptr->memory_allocator_ptr->is_persistent_mapping_enabled(),
+                              &block_ptr) )
+        {
+            goto end;
+        }
+
+        start_offset = 0;
+    }
+
+    region_iterator = block_ptr->regions.insert(block_ptr->regions.end(),
+                                                PoolRegion(start_offset,
+                                                           start_offset + in_item_ptr->alloc_size) );
+
+    {
+        auto create_info_ptr = Anvil::MemoryBlockCreateInfo::create_derived(block_ptr->memory_block_ptr.get(),
+                                                                             start_offset,
+                                                                             in_item_ptr->alloc_size);
+
+        create_info_ptr->set_on_release_callback_function(
+            std::bind(&VMA::on_pool_region_released,
+                      this,
+                      in_pool_ptr,
+                      block_ptr,
+                      region_iterator,
+                      std::placeholders::_1)
+        );
+
+        new_memory_block_ptr = Anvil::MemoryBlock::create(std::move(create_info_ptr) );
+    }
+
+    if (new_memory_block_ptr == nullptr)
+    {
+        anvil_assert(new_memory_block_ptr != nullptr);
+
+        /* The release callback was never called, so the region must be dropped manually */
+        block_ptr->regions.erase(region_iterator);
+
+        goto end;
+    }
+
+    dynamic_cast<IMemoryBlockBackendSupport*>(new_memory_block_ptr.get() )->set_parent_memory_allocator_backend_ptr(shared_from_this(),
+                                                                                                                    block_ptr->allocation);
+
+    in_item_ptr->alloc_memory_block_ptr = std::move(new_memory_block_ptr);
+    in_item_ptr->is_baked               = true;
+
+    result = true;
+end:
+    return result;
+}
+
+/** Allocates a new block for a LINEAR or RING_BUFFER pool from the pool's VMA pool, and appends it
+ *  to the pool's block list. Must be called with the pool's mutex locked.
+ *
+ *  @param in_pool_ptr            Pool to allocate the block for. Must not be null.
+ *  @param in_persistently_mapped True if the block should stay mapped once it has been mapped for the first time.
+ *  @param out_block_ptr_ptr      Deref will be set to the new block if successful. Must not be null.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::MemoryAllocatorBackends::VMA::create_pool_block(Pool*       in_pool_ptr,
+                                                            bool        in_persistently_mapped,
+                                                            PoolBlock** out_block_ptr_ptr)
+{
+    VmaAllocation                               allocation             = VK_NULL_HANDLE;
+    VmaAllocationCreateInfo                     allocation_create_info = {};
+    VmaAllocationInfo                           allocation_info        = {};
+    const auto&                                 memory_props           = m_device_ptr->get_physical_device_memory_properties();
+    const uint32_t                              memory_type_index      = in_pool_ptr->create_info.memory_type_index;
+    VkMemoryRequirements                        memory_requirements_vk;
+    std::unique_ptr<PoolBlock>                  new_block_ptr          (new PoolBlock() );
+    Anvil::OnMemoryBlockReleaseCallbackFunction release_callback_function;
+    bool                                        result                 = false;
+    VkResult                                    result_vk              = VK_ERROR_DEVICE_LOST;
+
+    allocation_create_info.pool = in_pool_ptr->pool;
+
+    memory_requirements_vk.alignment      = 1;
+    memory_requirements_vk.memoryTypeBits = 1u << memory_type_index;
+    memory_requirements_vk.size           = in_pool_ptr->create_info.block_size;
+
+    result_vk = vmaAllocateMemory(m_vma_allocator_ptr->get_handle(),
+                                 &memory_requirements_vk,
+                                 &allocation_create_info,
+                                 &allocation,
+                                 &allocation_info);
+
+    if (!is_vk_call_successful(result_vk) )
+    {
+        goto end;
+    }
+
+    /* The block is released back to VMA exactly like allocations made by bake() */
+    release_callback_function = std::bind(
+        &VMAAllocator::on_vma_alloced_mem_block_gone_out_of_scope,
+        m_vma_allocator_ptr,
+        std::placeholders::_1,
+        allocation
+    );
+
+    {
+        auto create_info_ptr = Anvil::MemoryBlockCreateInfo::create_derived_with_custom_delete_proc(m_device_ptr,
+                                                                                                    allocation_info.deviceMemory,
+                                                                                                    memory_requirements_vk.memoryTypeBits,
+                                                                                                    memory_props.types.at(memory_type_index).features,
+                                                                                                    allocation_info.memoryType,
+                                                                                                    memory_requirements_vk.size,
+                                                                                                    allocation_info.offset,
+                                                                                                    release_callback_function);
+
+        create_info_ptr->set_persistently_mapped(in_persistently_mapped);
+
+        new_block_ptr->memory_block_ptr = Anvil::MemoryBlock::create(std::move(create_info_ptr) );
+    }
+
+    if (new_block_ptr->memory_block_ptr == nullptr)
+    {
+        anvil_assert(new_block_ptr->memory_block_ptr != nullptr);
+
+        vmaFreeMemory(m_vma_allocator_ptr->get_handle(),
+                      allocation);
+
+        goto end;
+    }
+
+    m_vma_allocator_ptr->on_new_vma_mem_block_alloced();
+
+    new_block_ptr->allocation = allocation;
+    *out_block_ptr_ptr        = new_block_ptr.get();
+
+    in_pool_ptr->blocks.push_back(std::move(new_block_ptr) );
+
+    result = true;
+end:
+    return result;
+}
+
+/** Runs a single vmaDefragment() pass over the specified VMA allocations.
+ *
+ *  VMA copies the data of moved allocations on the host. Buffers and images bound to the moved
+ *  allocations need to be re-created by the caller.
+ *
+ *  @param in_backend_objects    VMA allocations which are allowed to be moved.
+ *  @param in_n_max_moves        Maximum number of allocations to move in this pass.
+ *  @param out_moved_objects_ptr Deref will be filled with new locations of all moved allocations. Must not be null.
+ *  @param inout_stats_ptr       Deref will be incremented by the amount of work done in this pass. Must not be null.
+ *  @param out_is_complete_ptr   Deref will be set to false if the pass hit the move limit. Must not be null.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::MemoryAllocatorBackends::VMA::defragment(const std::vector<void*>&                                in_backend_objects,
+                                                     uint32_t                                                 in_n_max_moves,
+                                                     std::vector<Anvil::MemoryAllocator::MovedBackendObject>* out_moved_objects_ptr,
+                                                     Anvil::MemoryAllocator::DefragmentationStats*            inout_stats_ptr,
+                                                     bool*                                                    out_is_complete_ptr)
+{
+    std::vector<VmaAllocation> allocations        (in_backend_objects.size() );
+    std::vector<VkBool32>      allocations_changed(in_backend_objects.size(),
+                                                   VK_FALSE);
+    VmaDefragmentationInfo     defrag_info;
+    VmaDefragmentationStats    defrag_stats       = {};
+    bool                       result             = false;
+    VkResult                   result_vk          = VK_ERROR_DEVICE_LOST;
+
+    for (uint32_t n_backend_object = 0;
+                  n_backend_object < static_cast<uint32_t>(in_backend_objects.size() );
+                ++n_backend_object)
+    {
+        allocations.at(n_backend_object) = static_cast<VmaAllocation>(in_backend_objects.at(n_backend_object) );
+    }
+
+    defrag_info.maxAllocationsToMove = in_n_max_moves;
+    defrag_info.maxBytesToMove       = VK_WHOLE_SIZE;
+
+    result_vk = vmaDefragment(m_vma_allocator_ptr->get_handle(),
+                              allocations.data(),
+                              allocations.size(),
+                              allocations_changed.data(),
+                             &defrag_info,
+                             &defrag_stats);
+
+    if (!is_vk_call_successful(result_vk) )
+    {
+        anvil_assert_vk_call_succeeded(result_vk);
+
+        goto end;
+    }
+
+    for (uint32_t n_backend_object = 0;
+                  n_backend_object < static_cast<uint32_t>(allocations.size() );
+                ++n_backend_object)
+    {
+        VmaAllocationInfo allocation_info;
+
+        if (allocations_changed.at(n_backend_object) != VK_TRUE)
+        {
+            continue;
+        }
+
+        vmaGetAllocationInfo(m_vma_allocator_ptr->get_handle(),
+                             allocations.at(n_backend_object),
+                            &allocation_info);
+
+        out_moved_objects_ptr->push_back(
+            Anvil::MemoryAllocator::MovedBackendObject(n_backend_object,
+                                                       allocation_info.deviceMemory,
+                                                       allocation_info.offset)
+        );
+    }
+
+    inout_stats_ptr->n_allocations_moved   += defrag_stats.allocationsMoved;
+    inout_stats_ptr->n_bytes_freed         += defrag_stats.bytesFreed;
+    inout_stats_ptr->n_bytes_moved         += defrag_stats.bytesMoved;
+    inout_stats_ptr->n_memory_blocks_freed += defrag_stats.deviceMemoryBlocksFreed;
+
+    /* VK_INCOMPLETE means the pass has been cut short by the move limit */
+    *out_is_complete_ptr = (result_vk == VK_SUCCESS);
+
+    result = true;
+end:
+    return result;
+}
+
 /** Please see header for specification */
-std::unique_ptr<Anvil::MemoryAllocatorBackends::VMA> Anvil::MemoryAllocatorBackends::VMA::create(const Anvil::BaseDevice* in_device_ptr)
+std::unique_ptr<Anvil::MemoryAllocatorBackends::VMA> Anvil::MemoryAllocatorBackends::VMA::create(const Anvil::BaseDevice*                                      in_device_ptr,
+                                                                                                 const std::vector<Anvil::MemoryAllocator::VMAPoolCreateInfo>& in_pools)
 {
     std::unique_ptr<Anvil::MemoryAllocatorBackends::VMA> result_ptr;
 
@@ -339,7 +748,7 @@ std::unique_ptr<Anvil::MemoryAllocatorBackends::VMA> Anvil::MemoryAllocatorBacke
 
     if (result_ptr != nullptr)
     {
-        if (!result_ptr->init() )
+        if (!result_ptr->init(in_pools) )
         {
             result_ptr.reset();
         }
@@ -348,15 +757,126 @@ std::unique_ptr<Anvil::MemoryAllocatorBackends::VMA> Anvil::MemoryAllocatorBacke
     return result_ptr;
 }
 
-/** Creates and stores a new VMAAllocator instance.
+/** Looks for space for a new region in the specified LINEAR or RING_BUFFER pool block.
+ *
+ *  New regions are always placed after the most recent live region. RING_BUFFER pools additionally
+ *  wrap around to the start of the block, as long as the new region ends before the oldest live one.
+ *
+ *  @param in_pool_ptr          Pool the block belongs to. Must not be null.
+ *  @param in_block_ptr         Block to search. Must not be null.
+ *  @param in_size              Size of the region.
+ *  @param in_alignment         Required alignment of the region's start offset.
+ *  @param out_start_offset_ptr Deref will be set to the region's start offset if successful. Must not be null.
+ *
+ *  @return true if the region fits in the block, false otherwise.
+ **/
+bool Anvil::MemoryAllocatorBackends::VMA::find_pool_region(const Pool*      in_pool_ptr,
+                                                           const PoolBlock* in_block_ptr,
+                                                           VkDeviceSize     in_size,
+                                                           VkDeviceSize     in_alignment,
+                                                           VkDeviceSize*    out_start_offset_ptr) const
+{
+    const VkDeviceSize block_size   = in_pool_ptr->create_info.block_size;
+    VkDeviceSize       head_offset  = 0;
+    bool               is_wrapped   = false;
+    bool               result       = false;
+    VkDeviceSize       tail_offset  = block_size;
+
+    if (in_block_ptr->regions.size() > 0)
+    {
+        const auto& oldest_region = in_block_ptr->regions.front();
+        const auto& newest_region = in_block_ptr->regions.back ();
+
+        head_offset = Anvil::Utils::round_up(newest_region.end_offset,
+                                             in_alignment);
+        is_wrapped  = (newest_region.start_offset < oldest_region.start_offset);
+        tail_offset = (is_wrapped) ? oldest_region.start_offset
+                                   : block_size;
+    }
+
+    if (head_offset + in_size <= tail_offset)
+    {
+        *out_start_offset_ptr = head_offset;
+        result                = true;
+    }
+    else
+    if (in_pool_ptr->create_info.algorithm == Anvil::VMAPoolAlgorithm::RING_BUFFER &&
+        !is_wrapped                                                               &&
+        in_block_ptr->regions.size() > 0                                          &&
+        in_size <= in_block_ptr->regions.front().start_offset)
+    {
+        *out_start_offset_ptr = 0;
+        result                = true;
+    }
+
+    return result;
+}
+
+/** Creates and stores a new VMAAllocator instance, followed by all requested custom pools.
+ *
+ *  @param in_pools Custom pools to create.
  *
  *  @return true if successful, false otherwise.
  */
-bool Anvil::MemoryAllocatorBackends::VMA::init()
+bool Anvil::MemoryAllocatorBackends::VMA::init(const std::vector<Anvil::MemoryAllocator::VMAPoolCreateInfo>& in_pools)
 {
+    const auto& memory_props = m_device_ptr->get_physical_device_memory_properties();
+    bool        result       = false;
+
     m_vma_allocator_ptr = VMAAllocator::create(m_device_ptr);
 
-    return (m_vma_allocator_ptr != nullptr);
+    if (m_vma_allocator_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    for (const auto& current_pool_create_info : in_pools)
+    {
+        const bool            is_ring_buffer   = (current_pool_create_info.algorithm == Anvil::VMAPoolAlgorithm::RING_BUFFER);
+        std::unique_ptr<Pool> new_pool_ptr     (new Pool(current_pool_create_info) );
+        VmaPoolCreateInfo     pool_create_info = {};
+        VkResult              result_vk        = VK_ERROR_DEVICE_LOST;
+
+        if (current_pool_create_info.memory_type_index >= static_cast<uint32_t>(memory_props.types.size() ) )
+        {
+            anvil_assert(current_pool_create_info.memory_type_index < static_cast<uint32_t>(memory_props.types.size() ) );
+
+            goto end;
+        }
+
+        /* Regions of LINEAR and RING_BUFFER pools are carved out of whole blocks, so the block size must be known up-front */
+        if (current_pool_create_info.algorithm != Anvil::VMAPoolAlgorithm::DEFAULT &&
+            current_pool_create_info.block_size == 0)
+        {
+            anvil_assert(current_pool_create_info.block_size != 0);
+
+            goto end;
+        }
+
+        pool_create_info.blockSize       = current_pool_create_info.block_size;
+        pool_create_info.maxBlockCount   = (is_ring_buffer) ? 1
+                                                            : current_pool_create_info.max_n_blocks;
+        pool_create_info.memoryTypeIndex = current_pool_create_info.memory_type_index;
+        pool_create_info.minBlockCount   = (is_ring_buffer) ? std::min(current_pool_create_info.min_n_blocks, 1u)
+                                                            : current_pool_create_info.min_n_blocks;
+
+        result_vk = vmaCreatePool(m_vma_allocator_ptr->get_handle(),
+                                 &pool_create_info,
+                                 &new_pool_ptr->pool);
+
+        if (!is_vk_call_successful(result_vk) )
+        {
+            anvil_assert_vk_call_succeeded(result_vk);
+
+            goto end;
+        }
+
+        m_pools.push_back(std::move(new_pool_ptr) );
+    }
+
+    result = true;
+end:
+    return result;
 }
 
 VkResult Anvil::MemoryAllocatorBackends::VMA::map(void*        in_memory_object,
@@ -393,7 +913,11 @@ void Anvil::MemoryAllocatorBackends::VMA::VMAAllocator::on_new_vma_mem_block_all
      * Every time the alloc is released back to the library, we remove a pointer off the vector.
      *
      * This prevents from premature release of the VMA wrapper instance if the user did not care to keep
-     * a copy of a pointer to the allocator throughout Vulkan instance lifetime. */
+     * a copy of a pointer to the allocator throughout Vulkan instance lifetime.
+     *
+     * Blocks may be baked and released from multiple threads at the same time, hence the lock. */
+    std::lock_guard<std::mutex> lock(m_refcount_helper_mutex);
+
     m_refcount_helper.push_back(shared_from_this() );
 }
 
@@ -409,21 +933,132 @@ void Anvil::MemoryAllocatorBackends::VMA::VMAAllocator::on_vma_alloced_mem_block
 
         /* Remove one cached pointer to the VMA wrapper class instance. This means that VMA instance
          * is going to be destroyed in case the vector's size reaches zero!
+         *
+         * The pointer is moved out of the vector first, so that the instance, including the mutex, is not
+         * destroyed until the lock has been released.
          */
-        anvil_assert(m_refcount_helper.size() >= 1);
+        std::shared_ptr<VMAAllocator> this_ptr;
+
+        {
+            std::lock_guard<std::mutex> lock(m_refcount_helper_mutex);
+
+            anvil_assert(m_refcount_helper.size() >= 1);
+
+            this_ptr = std::move(m_refcount_helper.back() );
 
-        m_refcount_helper.pop_back();
+            m_refcount_helper.pop_back();
+        }
+
+        this_ptr.reset();
 
         /* WARNING: *this is potentially out of scope from this point onward!: */
     }
 }
 
+/** Marks the region as released and reclaims the space taken by released regions at either end of the
+ *  block's region list. Regions released out of order are reclaimed once their neighbours are gone.
+ *
+ *  Called whenever a memory block created by bake_pool_item() goes out of scope.
+ **/
+void Anvil::MemoryAllocatorBackends::VMA::on_pool_region_released(Pool*                           in_pool_ptr,
+                                                                  PoolBlock*                      in_block_ptr,
+                                                                  std::list<PoolRegion>::iterator in_region_iterator,
+                                                                  Anvil::MemoryBlock*             in_memory_block_ptr)
+{
+    std::unique_lock<std::mutex> lock   (in_pool_ptr->mutex);
+    auto&                        regions(in_block_ptr->regions);
+
+    ANVIL_REDUNDANT_ARGUMENT(in_memory_block_ptr);
+
+    in_region_iterator->is_released = true;
+
+    while (regions.size() > 0          &&
+           regions.front().is_released)
+    {
+        regions.pop_front();
+    }
+
+    while (regions.size() > 0         &&
+           regions.back().is_released)
+    {
+        regions.pop_back();
+    }
+}
+
+/** Returns the detailed map of the allocator, as built by vmaBuildStatsString(). */
+void Anvil::MemoryAllocatorBackends::VMA::get_json_dump(std::string* out_json_ptr) const
+{
+    char* stats_string_ptr = nullptr;
+
+    vmaBuildStatsString(m_vma_allocator_ptr->get_handle(),
+                       &stats_string_ptr,
+                        VK_TRUE); /* detailedMap */
+
+    if (stats_string_ptr != nullptr)
+    {
+        *out_json_ptr = stats_string_ptr;
+
+        vmaFreeStatsString(m_vma_allocator_ptr->get_handle(),
+                           stats_string_ptr);
+    }
+    else
+    {
+        *out_json_ptr = "{}";
+    }
+}
+
+/** Returns the number of custom pools created for the allocator. */
+uint32_t Anvil::MemoryAllocatorBackends::VMA::get_n_pools() const
+{
+    return static_cast<uint32_t>(m_pools.size() );
+}
+
+/** Fills @param out_stats_ptr with the totals reported by the VMA library. */
+void Anvil::MemoryAllocatorBackends::VMA::get_stats(Anvil::MemoryAllocator::Stats* out_stats_ptr) const
+{
+    VmaStats vma_stats;
+
+    vmaCalculateStats(m_vma_allocator_ptr->get_handle(),
+                     &vma_stats);
+
+    out_stats_ptr->n_allocations           = vma_stats.total.allocationCount;
+    out_stats_ptr->n_dedicated_allocations = m_n_dedicated_allocations;
+    out_stats_ptr->n_bytes_allocated       = vma_stats.total.usedBytes + vma_stats.total.unusedBytes;
+    out_stats_ptr->n_bytes_used            = vma_stats.total.usedBytes;
+    out_stats_ptr->n_memory_blocks         = vma_stats.total.blockCount;
+    out_stats_ptr->largest_free_range      = vma_stats.total.unusedRangeSizeMax;
+
+    for (uint32_t n_memory_type = 0;
+                  n_memory_type < VK_MAX_MEMORY_TYPES;
+                ++n_memory_type)
+    {
+        out_stats_ptr->memory_type_largest_free_range.at(n_memory_type) = vma_stats.memoryType[n_memory_type].unusedRangeSizeMax;
+        out_stats_ptr->memory_type_n_bytes_allocated.at (n_memory_type) = vma_stats.memoryType[n_memory_type].usedBytes + vma_stats.memoryType[n_memory_type].unusedBytes;
+        out_stats_ptr->memory_type_n_bytes_used.at      (n_memory_type) = vma_stats.memoryType[n_memory_type].usedBytes;
+        out_stats_ptr->memory_type_n_memory_blocks.at   (n_memory_type) = vma_stats.memoryType[n_memory_type].blockCount;
+    }
+}
+
 /** Always returns true */
 bool Anvil::MemoryAllocatorBackends::VMA::supports_baking() const
 {
     return true;
 }
 
+/** VMA library is internally synchronized and each item is given a separate allocation, so items can be baked
+ *  from multiple threads at the same time. Always returns true.
+ */
+bool Anvil::MemoryAllocatorBackends::VMA::supports_concurrent_bakes() const
+{
+    return true;
+}
+
+/** Always returns true */
+bool Anvil::MemoryAllocatorBackends::VMA::supports_defragmentation() const
+{
+    return true;
+}
+
 bool Anvil::MemoryAllocatorBackends::VMA::supports_device_masks() const
 {
     /* The version of VMA we currently use does not provide support for device groups. */
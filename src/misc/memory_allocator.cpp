@@ -25,17 +25,26 @@
 #include "misc/formats.h"
 #include "misc/image_create_info.h"
 #include "misc/instance_create_info.h"
+#include "misc/io.h"
 #include "misc/memory_allocator.h"
 #include "misc/memalloc_backends/backend_oneshot.h"
 #include "misc/memalloc_backends/backend_vma.h"
+#include "misc/memory_block_create_info.h"
+#include "misc/task_scheduler.h"
+#include "misc/time.h"
+#include "misc/tracing.h"
 #include "wrappers/buffer.h"
 #include "wrappers/device.h"
 #include "wrappers/fence.h"
 #include "wrappers/image.h"
 #include "wrappers/instance.h"
 #include "wrappers/memory_block.h"
+#include "wrappers/physical_device.h"
 #include "wrappers/queue.h"
+#include <algorithm>
+#include <atomic>
 #include <set>
+#include <thread>
 
 /* Please see header for specification */
 Anvil::MemoryAllocator::Item::Item(Anvil::MemoryAllocator*                     in_memory_allocator_ptr,
@@ -62,6 +71,8 @@ Anvil::MemoryAllocator::Item::Item(Anvil::MemoryAllocator*                     i
     alloc_external_nt_handle_info_ptr   = in_alloc_external_nt_handle_info_ptr;
 #endif
 
+    alias_first_use                        = UINT32_MAX;
+    alias_last_use                         = UINT32_MAX;
     alloc_device_mask                      = in_device_mask;
     alloc_exportable_external_handle_types = in_opt_exportable_external_handle_types;
     alloc_image_aspect                     = Anvil::ImageAspectFlagBits::NONE;
@@ -76,12 +87,16 @@ Anvil::MemoryAllocator::Item::Item(Anvil::MemoryAllocator*                     i
     alloc_mgpu_peer_memory_reqs            = in_mgpu_peer_memory_reqs;
     alloc_size                             = in_alloc_size;
     buffer_ptr                             = in_buffer_ptr;
+    buffer_ref_file_start_offset           = 0;
     image_ptr                              = nullptr;
     is_baked                               = false;
     memory_allocator_ptr                   = in_memory_allocator_ptr;
     memory_priority                        = in_memory_priority;
     n_layer                                = UINT32_MAX;
     n_plane                                = UINT32_MAX;
+    peer_view_buffer_ptr                   = nullptr;
+    peer_view_image_ptr                    = nullptr;
+    pool_id                                = UINT32_MAX;
     type                                   = ITEM_TYPE_BUFFER;
 
     register_for_callbacks();
@@ -112,6 +127,8 @@ Anvil::MemoryAllocator::Item::Item(Anvil::MemoryAllocator*                     i
     alloc_external_nt_handle_info_ptr   = in_alloc_external_nt_handle_info_ptr;
 #endif
 
+    alias_first_use                        = UINT32_MAX;
+    alias_last_use                         = UINT32_MAX;
     alloc_device_mask                      = in_device_mask;
     alloc_exportable_external_handle_types = in_opt_exportable_external_handle_types;
     alloc_image_aspect                     = Anvil::ImageAspectFlagBits::NONE;
@@ -127,12 +144,16 @@ Anvil::MemoryAllocator::Item::Item(Anvil::MemoryAllocator*                     i
     alloc_offset                           = in_alloc_offset;
     alloc_size                             = in_alloc_size;
     buffer_ptr                             = in_buffer_ptr;
+    buffer_ref_file_start_offset           = 0;
     image_ptr                              = nullptr;
     is_baked                               = false;
     memory_allocator_ptr                   = in_memory_allocator_ptr;
     memory_priority                        = in_memory_priority;
     n_layer                                = UINT32_MAX;
     n_plane                                = UINT32_MAX;
+    peer_view_buffer_ptr                   = nullptr;
+    peer_view_image_ptr                    = nullptr;
+    pool_id                                = UINT32_MAX;
     type                                   = ITEM_TYPE_SPARSE_BUFFER_REGION;
 
     register_for_callbacks();
@@ -166,6 +187,8 @@ Anvil::MemoryAllocator::Item::Item(Anvil::MemoryAllocator*                     i
     alloc_external_nt_handle_info_ptr   = in_alloc_external_nt_handle_info_ptr;
 #endif
 
+    alias_first_use                        = UINT32_MAX;
+    alias_last_use                         = UINT32_MAX;
     alloc_device_mask                      = in_device_mask;
     alloc_exportable_external_handle_types = in_opt_exportable_external_handle_types;
     alloc_image_aspect                     = in_alloc_aspect;
@@ -181,6 +204,7 @@ Anvil::MemoryAllocator::Item::Item(Anvil::MemoryAllocator*                     i
     alloc_offset                           = UINT64_MAX;
     alloc_size                             = in_alloc_size;
     buffer_ptr                             = nullptr;
+    buffer_ref_file_start_offset           = 0;
     image_ptr                              = in_image_ptr;
     is_baked                               = false;
     memory_allocator_ptr                   = in_memory_allocator_ptr;
@@ -190,6 +214,9 @@ Anvil::MemoryAllocator::Item::Item(Anvil::MemoryAllocator*                     i
     n_plane                                = (in_alloc_aspect == Anvil::ImageAspectFlagBits::PLANE_1_BIT) ? 1
                                            : (in_alloc_aspect == Anvil::ImageAspectFlagBits::PLANE_2_BIT) ? 2
                                                                                                           : 0;
+    peer_view_buffer_ptr                   = nullptr;
+    peer_view_image_ptr                    = nullptr;
+    pool_id                                = UINT32_MAX;
     type                                   = ITEM_TYPE_SPARSE_IMAGE_MIPTAIL;
 
     register_for_callbacks();
@@ -223,6 +250,8 @@ Anvil::MemoryAllocator::Item::Item(Anvil::MemoryAllocator*                     i
     alloc_external_nt_handle_info_ptr   = in_alloc_external_nt_handle_info_ptr;
 #endif
 
+    alias_first_use                        = UINT32_MAX;
+    alias_last_use                         = UINT32_MAX;
     alloc_device_mask                      = in_device_mask;
     alloc_exportable_external_handle_types = in_opt_exportable_external_handle_types;
     alloc_image_aspect                     = Anvil::ImageAspectFlagBits::NONE;
@@ -238,6 +267,7 @@ Anvil::MemoryAllocator::Item::Item(Anvil::MemoryAllocator*                     i
     alloc_offset                           = UINT64_MAX;
     alloc_size                             = in_alloc_size;
     buffer_ptr                             = nullptr;
+    buffer_ref_file_start_offset           = 0;
     extent                                 = in_extent;
     image_ptr                              = in_image_ptr;
     is_baked                               = false;
@@ -249,6 +279,9 @@ Anvil::MemoryAllocator::Item::Item(Anvil::MemoryAllocator*                     i
                                                                                                                      : 0;
     offset                                 = in_offset;
     subresource                            = in_subresource;
+    peer_view_buffer_ptr                   = nullptr;
+    peer_view_image_ptr                    = nullptr;
+    pool_id                                = UINT32_MAX;
     type                                   = ITEM_TYPE_SPARSE_IMAGE_SUBRESOURCE;
 
     register_for_callbacks();
@@ -280,6 +313,8 @@ Anvil::MemoryAllocator::Item::Item(Anvil::MemoryAllocator*                     i
     alloc_external_nt_handle_info_ptr   = in_alloc_external_nt_handle_info_ptr;
 #endif
 
+    alias_first_use                        = UINT32_MAX;
+    alias_last_use                         = UINT32_MAX;
     alloc_device_mask                      = in_device_mask;
     alloc_exportable_external_handle_types = in_opt_exportable_external_handle_types;
     alloc_image_aspect                     = Anvil::ImageAspectFlagBits::NONE;
@@ -295,12 +330,16 @@ Anvil::MemoryAllocator::Item::Item(Anvil::MemoryAllocator*                     i
     alloc_offset                           = UINT64_MAX;
     alloc_size                             = in_alloc_size;
     buffer_ptr                             = nullptr;
+    buffer_ref_file_start_offset           = 0;
     image_ptr                              = in_image_ptr;
     is_baked                               = false;
     memory_allocator_ptr                   = in_memory_allocator_ptr;
     memory_priority                        = in_memory_priority;
     n_layer                                = UINT32_MAX;
     n_plane                                = in_n_plane;
+    peer_view_buffer_ptr                   = nullptr;
+    peer_view_image_ptr                    = nullptr;
+    pool_id                                = UINT32_MAX;
     type                                   = ITEM_TYPE_IMAGE_WHOLE;
 
     register_for_callbacks();
@@ -444,13 +483,20 @@ void Anvil::MemoryAllocator::Item::unregister_from_callbacks()
 }
 
 
-/* Please see header for specification */
+/* Please see header for specification.
+ *
+ * The lock is recursive: bake() invokes user callbacks, which may call back into the allocator, and defragment()
+ * calls get_stats() from within its locked section.
+ */
 Anvil::MemoryAllocator::MemoryAllocator(const Anvil::BaseDevice*                 in_device_ptr,
                                         std::shared_ptr<IMemoryAllocatorBackend> in_backend_ptr,
                                         bool                                     in_mt_safe)
-    :MTSafetySupportProvider(in_mt_safe),
-     m_backend_ptr          (std::move(in_backend_ptr) ),
-     m_device_ptr           (in_device_ptr)
+    :MTSafetySupportProvider(in_mt_safe,
+                             true), /* in_is_lock_recursive */
+     m_backend_ptr               (std::move(in_backend_ptr) ),
+     m_device_ptr                (in_device_ptr),
+     m_low_memory_usage_threshold(0.9f),
+     m_persistent_mapping_enabled(false)
 {
     /* Stub */
 }
@@ -458,13 +504,136 @@ Anvil::MemoryAllocator::MemoryAllocator(const Anvil::BaseDevice*
 /* Please see header for specification */
 Anvil::MemoryAllocator::~MemoryAllocator()
 {
-    if (m_items.size()                   > 0 &&
+    if (has_pending_items()               &&
         m_backend_ptr->supports_baking() )
     {
         bake();
     }
 }
 
+/** Please see header for specification */
+bool Anvil::MemoryAllocator::add_aliased_buffer(Anvil::Buffer*     in_buffer_ptr,
+                                                uint32_t           in_first_use,
+                                                uint32_t           in_last_use,
+                                                MemoryFeatureFlags in_required_memory_features,
+                                                const uint32_t*    in_opt_device_mask_ptr,
+                                                const float&       in_opt_memory_priority)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    Items*                                     pending_items_ptr = get_pending_items(&mutex_lock);
+    uint32_t                                   n_first_item      = 0;
+    bool                                       result            = false;
+
+    /* Sanity checks */
+    anvil_assert(in_buffer_ptr != nullptr);
+    anvil_assert(in_first_use  <= in_last_use);
+    anvil_assert(in_last_use   != UINT32_MAX);
+    anvil_assert((in_required_memory_features & Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT) == 0);
+
+    if ((in_buffer_ptr->get_create_info_ptr()->get_create_flags()                         & Anvil::BufferCreateFlagBits::SPARSE_BINDING_BIT) != 0 ||
+         in_buffer_ptr->get_create_info_ptr()->get_exportable_external_memory_handle_types()                                                 != 0)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    n_first_item = static_cast<uint32_t>(pending_items_ptr->size() );
+
+    if (!add_buffer_internal(in_buffer_ptr,
+                             in_required_memory_features,
+                             Anvil::ExternalMemoryHandleTypeFlagBits::NONE,
+#if defined(_WIN32)
+                             nullptr, /* in_opt_external_nt_handle_info_ptr */
+#endif
+                             in_opt_device_mask_ptr,
+                             nullptr, /* in_opt_mgpu_peer_memory_reqs_ptr           */
+                             nullptr, /* in_opt_mgpu_bind_sparse_device_indices_ptr */
+                             in_opt_memory_priority) )
+    {
+        goto end;
+    }
+
+    for (uint32_t n_item = n_first_item;
+                  n_item < static_cast<uint32_t>(pending_items_ptr->size() );
+                ++n_item)
+    {
+        auto& item_ptr = pending_items_ptr->at(n_item);
+
+        if (!item_ptr->alloc_is_dedicated_memory)
+        {
+            item_ptr->alias_first_use = in_first_use;
+            item_ptr->alias_last_use  = in_last_use;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::MemoryAllocator::add_aliased_image(Anvil::Image*      in_image_ptr,
+                                               uint32_t           in_first_use,
+                                               uint32_t           in_last_use,
+                                               MemoryFeatureFlags in_required_memory_features,
+                                               const uint32_t*    in_opt_device_mask_ptr,
+                                               const float&       in_opt_memory_priority)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    Items*                                     pending_items_ptr = get_pending_items(&mutex_lock);
+    uint32_t                                   n_first_item      = 0;
+    bool                                       result            = false;
+
+    /* Sanity checks */
+    anvil_assert(in_image_ptr != nullptr);
+    anvil_assert(in_first_use <= in_last_use);
+    anvil_assert(in_last_use  != UINT32_MAX);
+    anvil_assert((in_required_memory_features & Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT) == 0);
+
+    if ((in_image_ptr->get_create_info_ptr()->get_create_flags()               & Anvil::ImageCreateFlagBits::SPARSE_BINDING_BIT) != 0 ||
+         in_image_ptr->get_create_info_ptr()->get_external_memory_handle_types()                                                 != 0)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    n_first_item = static_cast<uint32_t>(pending_items_ptr->size() );
+
+    if (!add_image_whole(in_image_ptr,
+                         in_required_memory_features,
+                         Anvil::ExternalMemoryHandleTypeFlagBits::NONE,
+#if defined(_WIN32)
+                         nullptr, /* in_opt_external_nt_handle_info_ptr */
+#endif
+                         in_opt_device_mask_ptr,
+                         nullptr, /* in_opt_mgpu_peer_memory_reqs_ptr           */
+                         nullptr, /* in_opt_mgpu_bind_sparse_device_indices_ptr */
+                         in_opt_memory_priority) )
+    {
+        goto end;
+    }
+
+    /* Each plane of a disjoint image is a separate item. Planes share the image's lifetime, so they never alias each other. */
+    for (uint32_t n_item = n_first_item;
+                  n_item < static_cast<uint32_t>(pending_items_ptr->size() );
+                ++n_item)
+    {
+        auto& item_ptr = pending_items_ptr->at(n_item);
+
+        if (!item_ptr->alloc_is_dedicated_memory)
+        {
+            item_ptr->alias_first_use = in_first_use;
+            item_ptr->alias_last_use  = in_last_use;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
 /** Please see header for specification */
 bool Anvil::MemoryAllocator::add_buffer(Anvil::Buffer*                              in_buffer_ptr,
                                         MemoryFeatureFlags                          in_required_memory_features,
@@ -475,28 +644,39 @@ bool Anvil::MemoryAllocator::add_buffer(Anvil::Buffer*
                                         const uint32_t*                             in_opt_device_mask_ptr,
                                         const MGPUPeerMemoryRequirements*           in_opt_mgpu_peer_memory_reqs_ptr,
                                         const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
-                                        const float&                                in_opt_memory_priority)
+                                        const float&                                in_opt_memory_priority,
+                                        const VMAPoolID&                            in_opt_pool_id)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr  = get_mutex();
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    Items*                                     pending_items_ptr = get_pending_items(&mutex_lock);
+    bool                                       result            = false;
 
-    if (mutex_ptr != nullptr)
+    if (in_opt_pool_id != UINT32_MAX                  &&
+        in_opt_pool_id >= m_backend_ptr->get_n_pools() )
     {
-        mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
-        );
+        anvil_assert_fail();
+
+        goto end;
     }
 
-    return add_buffer_internal(in_buffer_ptr,
-                               in_required_memory_features,
-                               in_opt_exportable_external_handle_types,
+    result = add_buffer_internal(in_buffer_ptr,
+                                 in_required_memory_features,
+                                 in_opt_exportable_external_handle_types,
 #if defined(_WIN32)
-                               in_opt_external_nt_handle_info_ptr,
+                                 in_opt_external_nt_handle_info_ptr,
 #endif
-                               in_opt_device_mask_ptr,
-                               in_opt_mgpu_peer_memory_reqs_ptr,
-                               in_opt_mgpu_bind_sparse_device_indices_ptr,
-                               in_opt_memory_priority);
+                                 in_opt_device_mask_ptr,
+                                 in_opt_mgpu_peer_memory_reqs_ptr,
+                                 in_opt_mgpu_bind_sparse_device_indices_ptr,
+                                 in_opt_memory_priority);
+
+    if (result)
+    {
+        pending_items_ptr->back()->pool_id = in_opt_pool_id;
+    }
+
+end:
+    return result;
 }
 
 /** Determines the amount of memory, supported memory type and required alignment for the specified
@@ -515,14 +695,16 @@ bool Anvil::MemoryAllocator::add_buffer_internal(Anvil::Buffer*
                                                  const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
                                                  const float&                                in_opt_memory_priority)
 {
-    IMemoryAllocatorBackend*   backend_interface_ptr    = dynamic_cast<IMemoryAllocatorBackend*>(m_backend_ptr.get() );
-    VkDeviceSize               buffer_alignment         = 0;
-    uint32_t                   buffer_memory_types      = 0;
-    VkDeviceSize               buffer_storage_size      = 0;
-    uint32_t                   filtered_memory_types    = 0;
-    const VkMemoryRequirements memory_reqs              = in_buffer_ptr->get_memory_requirements();
-    std::unique_ptr<Item>      new_item_ptr;
-    bool                       result                   = true;
+    IMemoryAllocatorBackend*                   backend_interface_ptr    = dynamic_cast<IMemoryAllocatorBackend*>(m_backend_ptr.get() );
+    VkDeviceSize                               buffer_alignment         = 0;
+    uint32_t                                   buffer_memory_types      = 0;
+    VkDeviceSize                               buffer_storage_size      = 0;
+    uint32_t                                   filtered_memory_types    = 0;
+    const VkMemoryRequirements                 memory_reqs              = in_buffer_ptr->get_memory_requirements();
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    std::unique_ptr<Item>                      new_item_ptr;
+    Items*                                     pending_items_ptr        = get_pending_items(&mutex_lock);
+    bool                                       result                   = true;
 
     ANVIL_REDUNDANT_VARIABLE(backend_interface_ptr);
 
@@ -583,9 +765,9 @@ bool Anvil::MemoryAllocator::add_buffer_internal(Anvil::Buffer*
                  in_opt_memory_priority)
     );
 
-    m_items.push_back(std::move(new_item_ptr));
+    pending_items_ptr->push_back(std::move(new_item_ptr));
 
-    m_per_object_pending_alloc_status[in_buffer_ptr] = true;
+    mark_alloc_pending(in_buffer_ptr);
 
 end:
     anvil_assert(result);
@@ -593,6 +775,84 @@ end:
     return result;
 }
 
+/* Please see header for specification */
+bool Anvil::MemoryAllocator::add_buffer_with_callback_based_post_fill(Anvil::Buffer*                              in_buffer_ptr,
+                                                                      MemoryAllocatorBufferFillCallbackFunction   in_fill_callback_function,
+                                                                      MemoryFeatureFlags                          in_required_memory_features,
+                                                                      const Anvil::ExternalMemoryHandleTypeFlags& in_opt_exportable_external_handle_types,
+#if defined(_WIN32)
+                                                                      const Anvil::ExternalNTHandleInfo*          in_opt_external_nt_handle_info_ptr,
+#endif
+                                                                      const uint32_t*                             in_opt_device_mask_ptr,
+                                                                      const MGPUPeerMemoryRequirements*           in_opt_mgpu_peer_memory_reqs_ptr,
+                                                                      const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
+                                                                      const float&                                in_opt_memory_priority)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    Items*                                     pending_items_ptr = get_pending_items(&mutex_lock);
+    bool                                       result;
+
+    anvil_assert(in_fill_callback_function != nullptr);
+
+    result = add_buffer_internal(in_buffer_ptr,
+                                 in_required_memory_features,
+                                 in_opt_exportable_external_handle_types,
+#if defined(_WIN32)
+                                 in_opt_external_nt_handle_info_ptr,
+#endif
+                                 in_opt_device_mask_ptr,
+                                 in_opt_mgpu_peer_memory_reqs_ptr,
+                                 in_opt_mgpu_bind_sparse_device_indices_ptr,
+                                 in_opt_memory_priority);
+
+    if (result)
+    {
+        pending_items_ptr->back()->buffer_ref_fill_callback_function = std::move(in_fill_callback_function);
+    }
+
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::MemoryAllocator::add_buffer_with_file_based_post_fill(Anvil::Buffer*                              in_buffer_ptr,
+                                                                  const std::string&                          in_filename,
+                                                                  size_t                                      in_file_start_offset,
+                                                                  MemoryFeatureFlags                          in_required_memory_features,
+                                                                  const Anvil::ExternalMemoryHandleTypeFlags& in_opt_exportable_external_handle_types,
+#if defined(_WIN32)
+                                                                  const Anvil::ExternalNTHandleInfo*          in_opt_external_nt_handle_info_ptr,
+#endif
+                                                                  const uint32_t*                             in_opt_device_mask_ptr,
+                                                                  const MGPUPeerMemoryRequirements*           in_opt_mgpu_peer_memory_reqs_ptr,
+                                                                  const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
+                                                                  const float&                                in_opt_memory_priority)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    Items*                                     pending_items_ptr = get_pending_items(&mutex_lock);
+    bool                                       result;
+
+    anvil_assert(!in_filename.empty() );
+
+    result = add_buffer_internal(in_buffer_ptr,
+                                 in_required_memory_features,
+                                 in_opt_exportable_external_handle_types,
+#if defined(_WIN32)
+                                 in_opt_external_nt_handle_info_ptr,
+#endif
+                                 in_opt_device_mask_ptr,
+                                 in_opt_mgpu_peer_memory_reqs_ptr,
+                                 in_opt_mgpu_bind_sparse_device_indices_ptr,
+                                 in_opt_memory_priority);
+
+    if (result)
+    {
+        pending_items_ptr->back()->buffer_ref_file_name         = in_filename;
+        pending_items_ptr->back()->buffer_ref_file_start_offset = in_file_start_offset;
+    }
+
+    return result;
+}
+
 /* Please see header for specification */
 bool Anvil::MemoryAllocator::add_buffer_with_float_data_ptr_based_post_fill(Anvil::Buffer*                              in_buffer_ptr,
                                                                             std::unique_ptr<float[]>                    in_data_ptr,
@@ -606,16 +866,9 @@ bool Anvil::MemoryAllocator::add_buffer_with_float_data_ptr_based_post_fill(Anvi
                                                                             const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
                                                                             const float&                                in_opt_memory_priority)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr  = get_mutex();
-    bool                                   result;
-
-    if (mutex_ptr != nullptr)
-    {
-        mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
-        );
-    }
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    Items*                                     pending_items_ptr = get_pending_items(&mutex_lock);
+    bool                                       result;
 
     result = add_buffer_internal(in_buffer_ptr,
                                  in_required_memory_features,
@@ -630,7 +883,7 @@ bool Anvil::MemoryAllocator::add_buffer_with_float_data_ptr_based_post_fill(Anvi
 
     if (result)
     {
-        m_items.back()->buffer_ref_float_data_ptr = std::move(in_data_ptr);
+        pending_items_ptr->back()->buffer_ref_float_data_ptr = std::move(in_data_ptr);
     }
 
     return result;
@@ -649,16 +902,9 @@ bool Anvil::MemoryAllocator::add_buffer_with_float_data_vector_ptr_based_post_fi
                                                                                    const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
                                                                                    const float&                                in_opt_memory_priority)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr  = get_mutex();
-    bool                                   result;
-
-    if (mutex_ptr != nullptr)
-    {
-        mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
-        );
-    }
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    Items*                                     pending_items_ptr = get_pending_items(&mutex_lock);
+    bool                                       result;
 
     anvil_assert(in_data_vector_ptr->size() * sizeof(float) == in_buffer_ptr->get_create_info_ptr()->get_size() );
 
@@ -675,7 +921,7 @@ bool Anvil::MemoryAllocator::add_buffer_with_float_data_vector_ptr_based_post_fi
 
     if (result)
     {
-        m_items.back()->buffer_ref_float_vector_data_ptr = std::move(in_data_vector_ptr);
+        pending_items_ptr->back()->buffer_ref_float_vector_data_ptr = std::move(in_data_vector_ptr);
     }
 
     return result;
@@ -694,21 +940,14 @@ bool Anvil::MemoryAllocator::add_buffer_with_float_data_vector_ptr_based_post_fi
                                                                                    const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
                                                                                    const float&                                in_opt_memory_priority)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr  = get_mutex();
-    auto                                   ptr        = std::unique_ptr<std::vector<float>, std::function<void (std::vector<float>*) > >(const_cast<std::vector<float>* >(in_data_vector_ptr),
-                                                                                                                                         [](const std::vector<float>*)
-                                                                                                                                         {
-                                                                                                                                             /* Stub */
-                                                                                                                                         });
-    bool                                   result;
-
-    if (mutex_ptr != nullptr)
-    {
-        mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
-        );
-    }
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    Items*                                     pending_items_ptr = get_pending_items(&mutex_lock);
+    auto                                       ptr               = std::unique_ptr<std::vector<float>, std::function<void (std::vector<float>*) > >(const_cast<std::vector<float>* >(in_data_vector_ptr),
+                                                                                                                                                    [](const std::vector<float>*)
+                                                                                                                                                    {
+                                                                                                                                                        /* Stub */
+                                                                                                                                                    });
+    bool                                       result;
 
     anvil_assert(in_data_vector_ptr->size() * sizeof(uint32_t) == in_buffer_ptr->get_create_info_ptr()->get_size() );
 
@@ -725,7 +964,7 @@ bool Anvil::MemoryAllocator::add_buffer_with_float_data_vector_ptr_based_post_fi
 
     if (result)
     {
-        m_items.back()->buffer_ref_float_vector_data_ptr = std::move(ptr);
+        pending_items_ptr->back()->buffer_ref_float_vector_data_ptr = std::move(ptr);
     }
 
     return result;
@@ -744,16 +983,9 @@ bool Anvil::MemoryAllocator::add_buffer_with_uchar8_data_ptr_based_post_fill(Anv
                                                                              const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
                                                                              const float&                                in_opt_memory_priority)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr  = get_mutex();
-    bool                                   result;
-
-    if (mutex_ptr != nullptr)
-    {
-        mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
-        );
-    }
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    Items*                                     pending_items_ptr = get_pending_items(&mutex_lock);
+    bool                                       result;
 
     result = add_buffer_internal(in_buffer_ptr,
                                  in_required_memory_features,
@@ -768,7 +1000,7 @@ bool Anvil::MemoryAllocator::add_buffer_with_uchar8_data_ptr_based_post_fill(Anv
 
     if (result)
     {
-        m_items.back()->buffer_ref_uchar8_data_ptr = std::move(in_data_ptr);
+        pending_items_ptr->back()->buffer_ref_uchar8_data_ptr = std::move(in_data_ptr);
     }
 
     return result;
@@ -787,16 +1019,9 @@ bool Anvil::MemoryAllocator::add_buffer_with_uchar8_data_vector_ptr_based_post_f
                                                                                     const MGPUBindSparseDeviceIndices*           in_opt_mgpu_bind_sparse_device_indices_ptr,
                                                                                     const float&                                 in_opt_memory_priority)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr  = get_mutex();
-    bool                                   result;
-
-    if (mutex_ptr != nullptr)
-    {
-        mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
-        );
-    }
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    Items*                                     pending_items_ptr = get_pending_items(&mutex_lock);
+    bool                                       result;
 
     anvil_assert(in_data_vector_ptr->size() == in_buffer_ptr->get_create_info_ptr()->get_size() );
 
@@ -813,7 +1038,7 @@ bool Anvil::MemoryAllocator::add_buffer_with_uchar8_data_vector_ptr_based_post_f
 
     if (result)
     {
-        m_items.back()->buffer_ref_uchar8_vector_data_ptr = std::move(in_data_vector_ptr);
+        pending_items_ptr->back()->buffer_ref_uchar8_vector_data_ptr = std::move(in_data_vector_ptr);
     }
 
     return result;
@@ -832,16 +1057,9 @@ bool Anvil::MemoryAllocator::add_buffer_with_uint32_data_ptr_based_post_fill(Anv
                                                                              const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
                                                                              const float&                                in_opt_memory_priority)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr  = get_mutex();
-    bool                                   result;
-
-    if (mutex_ptr != nullptr)
-    {
-        mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
-        );
-    }
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    Items*                                     pending_items_ptr = get_pending_items(&mutex_lock);
+    bool                                       result;
 
     result = add_buffer_internal(in_buffer_ptr,
                                  in_required_memory_features,
@@ -856,7 +1074,7 @@ bool Anvil::MemoryAllocator::add_buffer_with_uint32_data_ptr_based_post_fill(Anv
 
     if (result)
     {
-        m_items.back()->buffer_ref_uint32_data_ptr = std::move(in_data_ptr);
+        pending_items_ptr->back()->buffer_ref_uint32_data_ptr = std::move(in_data_ptr);
     }
 
     return result;
@@ -875,16 +1093,9 @@ bool Anvil::MemoryAllocator::add_buffer_with_uint32_data_vector_ptr_based_post_f
                                                                                     const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
                                                                                     const float&                                in_opt_memory_priority)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr  = get_mutex();
-    bool                                   result;
-
-    if (mutex_ptr != nullptr)
-    {
-        mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
-        );
-    }
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    Items*                                     pending_items_ptr = get_pending_items(&mutex_lock);
+    bool                                       result;
 
     anvil_assert(in_data_vector_ptr->size() * sizeof(uint32_t) == in_buffer_ptr->get_create_info_ptr()->get_size() );
 
@@ -901,7 +1112,7 @@ bool Anvil::MemoryAllocator::add_buffer_with_uint32_data_vector_ptr_based_post_f
 
     if (result)
     {
-        m_items.back()->buffer_ref_uint32_vector_data_ptr = std::move(in_data_vector_ptr);
+        pending_items_ptr->back()->buffer_ref_uint32_vector_data_ptr = std::move(in_data_vector_ptr);
     }
 
     return result;
@@ -920,21 +1131,14 @@ bool Anvil::MemoryAllocator::add_buffer_with_uint32_data_vector_ptr_based_post_f
                                                                                     const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
                                                                                     const float&                                in_opt_memory_priority)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr  = get_mutex();
-    auto                                   ptr        = std::unique_ptr<std::vector<uint32_t>, std::function<void (std::vector<uint32_t>*) > >(const_cast<std::vector<uint32_t>* >(in_data_vector_ptr),
-                                                                                                                                              [](const std::vector<uint32_t>*)
-                                                                                                                                              {
-                                                                                                                                                  /* Stub */
-                                                                                                                                              });
-    bool                                   result;
-
-    if (mutex_ptr != nullptr)
-    {
-        mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
-        );
-    }
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    Items*                                     pending_items_ptr = get_pending_items(&mutex_lock);
+    auto                                       ptr               = std::unique_ptr<std::vector<uint32_t>, std::function<void (std::vector<uint32_t>*) > >(const_cast<std::vector<uint32_t>* >(in_data_vector_ptr),
+                                                                                                                                                         [](const std::vector<uint32_t>*)
+                                                                                                                                                         {
+                                                                                                                                                             /* Stub */
+                                                                                                                                                         });
+    bool                                       result;
 
     anvil_assert(in_data_vector_ptr->size() * sizeof(uint32_t) == in_buffer_ptr->get_create_info_ptr()->get_size() );
 
@@ -951,7 +1155,7 @@ bool Anvil::MemoryAllocator::add_buffer_with_uint32_data_vector_ptr_based_post_f
 
     if (result)
     {
-        m_items.back()->buffer_ref_uint32_vector_data_ptr = std::move(ptr);
+        pending_items_ptr->back()->buffer_ref_uint32_vector_data_ptr = std::move(ptr);
     }
 
     return result;
@@ -970,22 +1174,15 @@ bool Anvil::MemoryAllocator::add_image_whole(Anvil::Image*
                                              const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
                                              const float&                                in_opt_memory_priority)
 {
-    uint32_t                               filtered_memory_types = 0;
-    VkDeviceSize                           image_alignment       = 0;
-    uint32_t                               image_memory_types    = 0;
-    const auto                             image_n_planes        = Anvil::Formats::get_format_n_planes(in_image_ptr->get_create_info_ptr()->get_format() );
-    VkDeviceSize                           image_storage_size    = 0;
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr             = get_mutex();
-    std::unique_ptr<Item>                  new_item_ptr;
-    bool                                   result                = true;
-
-    if (mutex_ptr != nullptr)
-    {
-        mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
-        );
-    }
+    uint32_t                                   filtered_memory_types = 0;
+    VkDeviceSize                               image_alignment       = 0;
+    uint32_t                                   image_memory_types    = 0;
+    const auto                                 image_n_planes        = Anvil::Formats::get_format_n_planes(in_image_ptr->get_create_info_ptr()->get_format() );
+    VkDeviceSize                               image_storage_size    = 0;
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    Items*                                     pending_items_ptr     = get_pending_items(&mutex_lock);
+    std::unique_ptr<Item>                      new_item_ptr;
+    bool                                       result                = true;
 
     /* Sanity checks */
     anvil_assert(m_backend_ptr->supports_baking() );
@@ -1000,6 +1197,11 @@ bool Anvil::MemoryAllocator::add_image_whole(Anvil::Image*
     anvil_assert((in_required_memory_features & Anvil::MemoryFeatureFlagBits::PROTECTED_BIT) == 0 ||
                  (m_backend_ptr->supports_protected_memory() ));
 
+    /* Lazily allocated memory can only back transient attachments, which are never accessed by the host */
+    anvil_assert( (in_required_memory_features & Anvil::MemoryFeatureFlagBits::LAZILY_ALLOCATED_BIT) == 0                                                  ||
+                 ((in_image_ptr->get_create_info_ptr()->get_usage_flags() & Anvil::ImageUsageFlagBits::TRANSIENT_ATTACHMENT_BIT)                    != 0 &&
+                  (in_required_memory_features                            & Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT)                             == 0) );
+
     if (!do_external_memory_handle_type_sanity_checks(in_image_ptr->get_create_info_ptr()->get_external_memory_handle_types()) )
     {
         result = false;
@@ -1027,6 +1229,25 @@ bool Anvil::MemoryAllocator::add_image_whole(Anvil::Image*
             goto end;
         }
 
+        /* Transient attachments which do not explicitly ask for lazily allocated memory are still placed in such
+         * memory, if any of the compatible memory types provides it. On tile-based GPUs, this means attachments
+         * which never leave tile memory do not consume physical memory. Other GPUs do not expose such memory
+         * types, in which case the filtered set stays intact.
+         */
+        if ((in_image_ptr->get_create_info_ptr()->get_usage_flags() & Anvil::ImageUsageFlagBits::TRANSIENT_ATTACHMENT_BIT) != 0 &&
+            (in_required_memory_features                            & Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT)           == 0)
+        {
+            uint32_t lazily_allocated_memory_types = 0;
+
+            if (get_mem_types_supporting_mem_features(m_device_ptr,
+                                                      filtered_memory_types,
+                                                      in_required_memory_features | Anvil::MemoryFeatureFlagBits::LAZILY_ALLOCATED_BIT,
+                                                     &lazily_allocated_memory_types) )
+            {
+                filtered_memory_types = lazily_allocated_memory_types;
+            }
+        }
+
         /* Store a new block item descriptor */
         new_item_ptr.reset(
             new Item(this,
@@ -1048,128 +1269,246 @@ bool Anvil::MemoryAllocator::add_image_whole(Anvil::Image*
                      n_plane)
         );
 
-        m_items.push_back(
+        pending_items_ptr->push_back(
             std::move(new_item_ptr)
         );
     }
 
-    m_per_object_pending_alloc_status[in_image_ptr] = true;
+    mark_alloc_pending(in_image_ptr);
 end:
     return result;
 }
 
 /** Please see header for specification */
-bool Anvil::MemoryAllocator::add_sparse_buffer_region(Anvil::Buffer*                     in_buffer_ptr,
-                                                      VkDeviceSize                       in_offset,
-                                                      VkDeviceSize                       in_size,
-                                                      MemoryFeatureFlags                 in_required_memory_features,
-                                                      const uint32_t*                    in_opt_device_mask_ptr,
-                                                      const MGPUPeerMemoryRequirements*  in_opt_mgpu_peer_memory_reqs_ptr,
-                                                      const MGPUBindSparseDeviceIndices* in_opt_mgpu_bind_sparse_device_indices_ptr,
-                                                      const float&                       in_opt_memory_priority)
+bool Anvil::MemoryAllocator::add_peer_accessible_buffer(Anvil::Buffer*                       in_buffer_ptr,
+                                                        Anvil::Buffer*                       in_peer_view_buffer_ptr,
+                                                        const std::vector<uint32_t>&         in_peer_device_indices,
+                                                        const Anvil::PeerMemoryFeatureFlags& in_required_peer_memory_features,
+                                                        MemoryFeatureFlags                   in_required_memory_features)
 {
-    uint32_t                               filtered_memory_types = 0;
-    const auto&                            memory_reqs           = in_buffer_ptr->get_memory_requirements();
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr             = get_mutex();
-    std::unique_ptr<Item>                  new_item_ptr;
-    bool                                   result                = true;
+    uint32_t                                   device_mask       = 0;
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    Items*                                     pending_items_ptr = get_pending_items(&mutex_lock);
+    MGPUPeerMemoryRequirements                 peer_memory_reqs;
+    bool                                       result            = false;
 
     /* Sanity checks */
-    anvil_assert(in_buffer_ptr                                    != nullptr);
-    anvil_assert(m_backend_ptr->supports_baking                () );
-    anvil_assert(in_buffer_ptr->get_memory_requirements().size    >= in_offset + in_size);
-    anvil_assert( in_opt_device_mask_ptr                          == nullptr                                            ||
-                 (in_opt_device_mask_ptr                          != nullptr && m_backend_ptr->supports_device_masks() ));
-
-    anvil_assert((in_required_memory_features                              & Anvil::MemoryFeatureFlagBits::PROTECTED_BIT)       == 0);
-    anvil_assert((in_buffer_ptr->get_create_info_ptr()->get_create_flags() & Anvil::BufferCreateFlagBits::SPARSE_RESIDENCY_BIT) != 0);
-    anvil_assert(do_bind_sparse_device_indices_sanity_check(in_opt_mgpu_bind_sparse_device_indices_ptr));
+    anvil_assert(in_buffer_ptr           != nullptr);
+    anvil_assert(in_peer_view_buffer_ptr != nullptr);
 
-
-    if (mutex_ptr != nullptr)
+    if (in_buffer_ptr->requires_dedicated_allocation() )
     {
-        mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
-        );
+        /* Dedicated allocations can only ever be bound to the buffer they were made for. */
+        anvil_assert(!in_buffer_ptr->requires_dedicated_allocation() );
+
+        goto end;
     }
 
-    if (!do_external_memory_handle_type_sanity_checks(in_buffer_ptr->get_create_info_ptr()->get_exportable_external_memory_handle_types() ) )
+    if (in_peer_view_buffer_ptr->get_memory_requirements().size                                                                     >  in_buffer_ptr->get_memory_requirements().size ||
+        (in_peer_view_buffer_ptr->get_memory_requirements().memoryTypeBits & in_buffer_ptr->get_memory_requirements().memoryTypeBits) == 0)
     {
-        result = false;
+        anvil_assert_fail();
 
         goto end;
     }
 
-    /* Determine how much space we're going to need, what alignment we need
-     * to consider, and so on. */
-    anvil_assert((in_offset % memory_reqs.alignment) == 0);
-
-    if (!get_mem_types_supporting_mem_features(m_device_ptr,
-                                               memory_reqs.memoryTypeBits,
-                                               in_required_memory_features,
-                                              &filtered_memory_types) )
+    if (!get_peer_access_properties(in_peer_device_indices,
+                                    in_required_peer_memory_features,
+                                   &device_mask,
+                                   &peer_memory_reqs) )
     {
-        result = false;
-
         goto end;
     }
 
-    /* Store a new block item descriptor. */
-    new_item_ptr.reset(
-        new Item(this,
-                 in_buffer_ptr,
-                 in_offset,
-                 in_size,
-                 memory_reqs.memoryTypeBits,
-                 memory_reqs.alignment,
-                 in_required_memory_features,
-                 filtered_memory_types,
-                 Anvil::ExternalMemoryHandleTypeFlagBits::NONE,
+    if (!add_buffer_internal(in_buffer_ptr,
+                             in_required_memory_features,
+                             Anvil::ExternalMemoryHandleTypeFlagBits::NONE,
 #if defined(_WIN32)
-                 nullptr, /* in_alloc_external_nt_handle_info_ptr    */
+                             nullptr, /* in_opt_external_nt_handle_info_ptr */
 #endif
-                 in_buffer_ptr->requires_dedicated_allocation(),
-                 (in_opt_device_mask_ptr                     != nullptr) ? *in_opt_device_mask_ptr                     : 0,
-                 (in_opt_mgpu_peer_memory_reqs_ptr           != nullptr) ? *in_opt_mgpu_peer_memory_reqs_ptr           : MGPUPeerMemoryRequirements(),
-                 (in_opt_mgpu_bind_sparse_device_indices_ptr != nullptr) ? *in_opt_mgpu_bind_sparse_device_indices_ptr : MGPUBindSparseDeviceIndices(),
-                 in_opt_memory_priority)
-    );
-
-    m_items.push_back(
-        std::move(new_item_ptr)
-    );
+                            &device_mask,
+                            &peer_memory_reqs,
+                             nullptr, /* in_opt_mgpu_bind_sparse_device_indices_ptr */
+                             FLT_MAX) )
+    {
+        goto end;
+    }
 
-    m_per_object_pending_alloc_status[in_buffer_ptr] = true;
+    pending_items_ptr->back()->peer_view_buffer_ptr     = in_peer_view_buffer_ptr;
+    pending_items_ptr->back()->peer_view_device_indices = in_peer_device_indices;
 
+    result = true;
 end:
-    anvil_assert(result);
-
     return result;
 }
 
 /** Please see header for specification */
-bool Anvil::MemoryAllocator::add_sparse_image_miptail(Anvil::Image*                        in_image_ptr,
-                                                      Anvil::ImageAspectFlagBits           in_aspect,
-                                                      uint32_t                             in_n_layer,
-                                                      MemoryFeatureFlags                   in_required_memory_features,
-                                                      const uint32_t*                      in_opt_device_mask_ptr,
+bool Anvil::MemoryAllocator::add_peer_accessible_image(Anvil::Image*                        in_image_ptr,
+                                                       Anvil::Image*                        in_peer_view_image_ptr,
+                                                       const std::vector<uint32_t>&         in_peer_device_indices,
+                                                       const Anvil::PeerMemoryFeatureFlags& in_required_peer_memory_features,
+                                                       MemoryFeatureFlags                   in_required_memory_features)
+{
+    uint32_t                                   device_mask       = 0;
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    Items*                                     pending_items_ptr = get_pending_items(&mutex_lock);
+    MGPUPeerMemoryRequirements                 peer_memory_reqs;
+    bool                                       result            = false;
+
+    /* Sanity checks */
+    anvil_assert(in_image_ptr           != nullptr);
+    anvil_assert(in_peer_view_image_ptr != nullptr);
+
+    if (Anvil::Formats::get_format_n_planes(in_image_ptr->get_create_info_ptr()->get_format() ) != 1 ||
+        in_image_ptr->requires_dedicated_allocation(0) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if ((in_image_ptr->get_create_info_ptr          ()->get_create_flags() & Anvil::ImageCreateFlagBits::ALIAS_BIT) == 0 ||
+        (in_peer_view_image_ptr->get_create_info_ptr()->get_create_flags() & Anvil::ImageCreateFlagBits::ALIAS_BIT) == 0)
+    {
+        /* Without the flag, the two images are not guaranteed to interpret the shared memory the same way. */
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (!get_peer_access_properties(in_peer_device_indices,
+                                    in_required_peer_memory_features,
+                                   &device_mask,
+                                   &peer_memory_reqs) )
+    {
+        goto end;
+    }
+
+    if (!add_image_whole(in_image_ptr,
+                         in_required_memory_features,
+                         Anvil::ExternalMemoryHandleTypeFlagBits::NONE,
+#if defined(_WIN32)
+                         nullptr, /* in_opt_external_nt_handle_info_ptr */
+#endif
+                        &device_mask,
+                        &peer_memory_reqs) )
+    {
+        goto end;
+    }
+
+    pending_items_ptr->back()->peer_view_device_indices = in_peer_device_indices;
+    pending_items_ptr->back()->peer_view_image_ptr      = in_peer_view_image_ptr;
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::MemoryAllocator::add_sparse_buffer_region(Anvil::Buffer*                     in_buffer_ptr,
+                                                      VkDeviceSize                       in_offset,
+                                                      VkDeviceSize                       in_size,
+                                                      MemoryFeatureFlags                 in_required_memory_features,
+                                                      const uint32_t*                    in_opt_device_mask_ptr,
+                                                      const MGPUPeerMemoryRequirements*  in_opt_mgpu_peer_memory_reqs_ptr,
+                                                      const MGPUBindSparseDeviceIndices* in_opt_mgpu_bind_sparse_device_indices_ptr,
+                                                      const float&                       in_opt_memory_priority)
+{
+    uint32_t                                   filtered_memory_types = 0;
+    const auto&                                memory_reqs           = in_buffer_ptr->get_memory_requirements();
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    Items*                                     pending_items_ptr     = get_pending_items(&mutex_lock);
+    std::unique_ptr<Item>                      new_item_ptr;
+    bool                                       result                = true;
+
+    /* Sanity checks */
+    anvil_assert(in_buffer_ptr                                    != nullptr);
+    anvil_assert(m_backend_ptr->supports_baking                () );
+    anvil_assert(in_buffer_ptr->get_memory_requirements().size    >= in_offset + in_size);
+    anvil_assert( in_opt_device_mask_ptr                          == nullptr                                            ||
+                 (in_opt_device_mask_ptr                          != nullptr && m_backend_ptr->supports_device_masks() ));
+
+    anvil_assert((in_required_memory_features                              & Anvil::MemoryFeatureFlagBits::PROTECTED_BIT)       == 0);
+    anvil_assert((in_buffer_ptr->get_create_info_ptr()->get_create_flags() & Anvil::BufferCreateFlagBits::SPARSE_RESIDENCY_BIT) != 0);
+    anvil_assert(do_bind_sparse_device_indices_sanity_check(in_opt_mgpu_bind_sparse_device_indices_ptr));
+
+
+    if (!do_external_memory_handle_type_sanity_checks(in_buffer_ptr->get_create_info_ptr()->get_exportable_external_memory_handle_types() ) )
+    {
+        result = false;
+
+        goto end;
+    }
+
+    /* Determine how much space we're going to need, what alignment we need
+     * to consider, and so on. */
+    anvil_assert((in_offset % memory_reqs.alignment) == 0);
+
+    if (!get_mem_types_supporting_mem_features(m_device_ptr,
+                                               memory_reqs.memoryTypeBits,
+                                               in_required_memory_features,
+                                              &filtered_memory_types) )
+    {
+        result = false;
+
+        goto end;
+    }
+
+    /* Store a new block item descriptor. */
+    new_item_ptr.reset(
+        new Item(this,
+                 in_buffer_ptr,
+                 in_offset,
+                 in_size,
+                 memory_reqs.memoryTypeBits,
+                 memory_reqs.alignment,
+                 in_required_memory_features,
+                 filtered_memory_types,
+                 Anvil::ExternalMemoryHandleTypeFlagBits::NONE,
+#if defined(_WIN32)
+                 nullptr, /* in_alloc_external_nt_handle_info_ptr    */
+#endif
+                 in_buffer_ptr->requires_dedicated_allocation(),
+                 (in_opt_device_mask_ptr                     != nullptr) ? *in_opt_device_mask_ptr                     : 0,
+                 (in_opt_mgpu_peer_memory_reqs_ptr           != nullptr) ? *in_opt_mgpu_peer_memory_reqs_ptr           : MGPUPeerMemoryRequirements(),
+                 (in_opt_mgpu_bind_sparse_device_indices_ptr != nullptr) ? *in_opt_mgpu_bind_sparse_device_indices_ptr : MGPUBindSparseDeviceIndices(),
+                 in_opt_memory_priority)
+    );
+
+    pending_items_ptr->push_back(
+        std::move(new_item_ptr)
+    );
+
+    mark_alloc_pending(in_buffer_ptr);
+
+end:
+    anvil_assert(result);
+
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::MemoryAllocator::add_sparse_image_miptail(Anvil::Image*                        in_image_ptr,
+                                                      Anvil::ImageAspectFlagBits           in_aspect,
+                                                      uint32_t                             in_n_layer,
+                                                      MemoryFeatureFlags                   in_required_memory_features,
+                                                      const uint32_t*                      in_opt_device_mask_ptr,
                                                       const MGPUPeerMemoryRequirements*    in_opt_mgpu_peer_memory_reqs_ptr,
                                                       const MGPUBindSparseDeviceIndices*   in_opt_mgpu_bind_sparse_device_indices_ptr,
                                                       const float&                         in_opt_memory_priority)
 {
-    const Anvil::SparseImageAspectProperties* aspect_props_ptr      = nullptr;
-    uint32_t                                  filtered_memory_types = 0;
-    std::unique_lock<std::recursive_mutex>    mutex_lock;
-    auto                                      mutex_ptr             = get_mutex();
-    std::unique_ptr<Item>                     new_item_ptr;
-    uint32_t                                  miptail_memory_types  = 0;
-    VkDeviceSize                              miptail_offset        = static_cast<VkDeviceSize>(UINT64_MAX);
-    VkDeviceSize                              miptail_size          = 0;
-    const uint32_t                            n_plane               = (in_aspect == Anvil::ImageAspectFlagBits::PLANE_1_BIT) ? 1
-                                                                    : (in_aspect == Anvil::ImageAspectFlagBits::PLANE_2_BIT) ? 2
-                                                                                                                             : 0;
-    bool                                      result                = true;
+    const Anvil::SparseImageAspectProperties*  aspect_props_ptr      = nullptr;
+    uint32_t                                   filtered_memory_types = 0;
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    Items*                                     pending_items_ptr     = get_pending_items(&mutex_lock);
+    std::unique_ptr<Item>                      new_item_ptr;
+    uint32_t                                   miptail_memory_types  = 0;
+    VkDeviceSize                               miptail_offset        = static_cast<VkDeviceSize>(UINT64_MAX);
+    VkDeviceSize                               miptail_size          = 0;
+    const uint32_t                             n_plane               = (in_aspect == Anvil::ImageAspectFlagBits::PLANE_1_BIT) ? 1
+                                                                     : (in_aspect == Anvil::ImageAspectFlagBits::PLANE_2_BIT) ? 2
+                                                                                                                              : 0;
+    bool                                       result                = true;
 
     ANVIL_REDUNDANT_VARIABLE(result);
 
@@ -1185,13 +1524,6 @@ bool Anvil::MemoryAllocator::add_sparse_image_miptail(Anvil::Image*
     anvil_assert((in_required_memory_features                                                                       & Anvil::MemoryFeatureFlagBits::PROTECTED_BIT)      == 0);
     anvil_assert(do_bind_sparse_device_indices_sanity_check            (in_opt_mgpu_bind_sparse_device_indices_ptr));
 
-    if (mutex_ptr != nullptr)
-    {
-        mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
-        );
-    }
-
     if (!do_external_memory_handle_type_sanity_checks(in_image_ptr->get_create_info_ptr()->get_external_memory_handle_types()) )
     {
         result = false;
@@ -1249,11 +1581,11 @@ bool Anvil::MemoryAllocator::add_sparse_image_miptail(Anvil::Image*
                  in_opt_memory_priority)
     );
 
-    m_items.push_back(
+    pending_items_ptr->push_back(
         std::move(new_item_ptr)
     );
 
-    m_per_object_pending_alloc_status[in_image_ptr] = true;
+    mark_alloc_pending(in_image_ptr);
 
 end:
     return result;
@@ -1270,20 +1602,20 @@ bool Anvil::MemoryAllocator::add_sparse_image_subresource(Anvil::Image*
                                                           const MGPUBindSparseDeviceIndices* in_opt_mgpu_bind_sparse_device_indices_ptr,
                                                           const float&                       in_opt_memory_priority)
 {
-    const Anvil::SparseImageAspectProperties* aspect_props_ptr           = nullptr;
-    uint32_t                                  component_size_bits[4]     = {0};
-    uint32_t                                  filtered_memory_types      = 0;
-    const auto                                image_format               = in_image_ptr->get_create_info_ptr()->get_format();
-    uint32_t                                  mip_size[3];
-    std::unique_lock<std::recursive_mutex>    mutex_lock;
-    auto                                      mutex_ptr                  = get_mutex();
-    std::unique_ptr<Item>                     new_item_ptr;
-    const uint32_t                            n_plane                    = (in_subresource.aspect_mask == Anvil::ImageAspectFlagBits::PLANE_1_BIT) ? 1
-                                                                         : (in_subresource.aspect_mask == Anvil::ImageAspectFlagBits::PLANE_2_BIT) ? 2
-                                                                                                                                                   : 0;
-    bool                                      result                     = true;
-    const VkDeviceSize                        tile_size                  = in_image_ptr->get_image_alignment(n_plane);
-    VkDeviceSize                              total_region_size_in_bytes = 0;
+    const Anvil::SparseImageAspectProperties*  aspect_props_ptr           = nullptr;
+    uint32_t                                   component_size_bits[4]     = {0};
+    uint32_t                                   filtered_memory_types      = 0;
+    const auto                                 image_format               = in_image_ptr->get_create_info_ptr()->get_format();
+    uint32_t                                   mip_size[3];
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    Items*                                     pending_items_ptr          = get_pending_items(&mutex_lock);
+    std::unique_ptr<Item>                      new_item_ptr;
+    const uint32_t                             n_plane                    = (in_subresource.aspect_mask == Anvil::ImageAspectFlagBits::PLANE_1_BIT) ? 1
+                                                                          : (in_subresource.aspect_mask == Anvil::ImageAspectFlagBits::PLANE_2_BIT) ? 2
+                                                                                                                                                    : 0;
+    bool                                       result                     = true;
+    const VkDeviceSize                         tile_size                  = in_image_ptr->get_image_alignment(n_plane);
+    VkDeviceSize                               total_region_size_in_bytes = 0;
 
     ANVIL_REDUNDANT_VARIABLE(result);
 
@@ -1306,13 +1638,6 @@ bool Anvil::MemoryAllocator::add_sparse_image_subresource(Anvil::Image*
     anvil_assert(do_bind_sparse_device_indices_sanity_check(in_opt_mgpu_bind_sparse_device_indices_ptr));
 
 
-    if (mutex_ptr != nullptr)
-    {
-        mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
-        );
-    }
-
     if (!do_external_memory_handle_type_sanity_checks(in_image_ptr->get_create_info_ptr()->get_external_memory_handle_types() ) )
     {
         result = false;
@@ -1475,11 +1800,11 @@ bool Anvil::MemoryAllocator::add_sparse_image_subresource(Anvil::Image*
                  in_opt_memory_priority)
     );
 
-    m_items.push_back(
+    pending_items_ptr->push_back(
         std::move(new_item_ptr)
     );
 
-    m_per_object_pending_alloc_status[in_image_ptr] = true;
+    mark_alloc_pending(in_image_ptr);
 
 end:
     return result;
@@ -1488,10 +1813,15 @@ end:
 /* Please see header for specification */
 bool Anvil::MemoryAllocator::bake()
 {
+    ANVIL_TRACE_SPAN("MemoryAllocator::bake");
+
+    std::vector<Anvil::BufferMemoryBindingUpdate>                          buffer_binding_updates;
     Anvil::SparseMemoryBindInfoID                                          default_sparse_bind_info_id               = UINT32_MAX;
+    Items                                                                  aliased_items;
     std::map<ResourceMemoryDeviceIndexPair, Anvil::SparseMemoryBindInfoID> device_index_pair_to_sparse_bind_info_map;
     std::vector<Anvil::FenceUniquePtr>                                     fences;
-    std::unique_lock<std::recursive_mutex>                                 mutex_lock;
+    std::vector<Anvil::ImageMemoryBindingUpdate>                           image_binding_updates;
+    std::unique_lock<Anvil::RecursiveSpinLock>                             mutex_lock;
     auto                                                                   mutex_ptr                                 = get_mutex();
     bool                                                                   needs_sparse_memory_binding               = false;
     bool                                                                   result                                    = false;
@@ -1500,10 +1830,30 @@ bool Anvil::MemoryAllocator::bake()
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
         );
     }
 
+    /* Gather items registered by all threads since the last bake. */
+    for (auto& current_shard : m_pending_item_shards)
+    {
+        std::unique_lock<Anvil::RecursiveSpinLock> shard_lock;
+
+        if (is_mt_safe() )
+        {
+            shard_lock = std::unique_lock<Anvil::RecursiveSpinLock>(current_shard.lock);
+        }
+
+        for (auto& current_item_ptr : current_shard.items)
+        {
+            m_items.push_back(
+                std::move(current_item_ptr)
+            );
+        }
+
+        current_shard.items.clear();
+    }
+
     if (!m_backend_ptr->supports_baking() )
     {
         result = (m_items.size() == 0);
@@ -1519,12 +1869,54 @@ bool Anvil::MemoryAllocator::bake()
         goto end;
     }
 
-    result = m_backend_ptr->bake(m_items);
-    if (!result)
+    /* Aliased items are placed by the allocator itself, since backends assume each item gets a separate region */
+    for (auto item_iterator  = m_items.begin();
+              item_iterator != m_items.end();
+        )
     {
-        m_items.clear();
+        if ((*item_iterator)->alias_first_use != UINT32_MAX)
+        {
+            aliased_items.push_back(
+                std::move(*item_iterator)
+            );
 
-        goto end;
+            item_iterator = m_items.erase(item_iterator);
+        }
+        else
+        {
+            ++item_iterator;
+        }
+    }
+
+    if (aliased_items.size() > 0)
+    {
+        result = bake_aliased_items(aliased_items);
+
+        if (!result)
+        {
+            m_items.clear();
+
+            goto end;
+        }
+    }
+
+    if (m_items.size() > 0)
+    {
+        result = bake_backend_items(m_items);
+
+        if (!result)
+        {
+            m_items.clear();
+
+            goto end;
+        }
+    }
+
+    for (auto& current_aliased_item_ptr : aliased_items)
+    {
+        m_items.push_back(
+            std::move(current_aliased_item_ptr)
+        );
     }
 
     /* Prepare a sparse memory binding structure, if we're going to need one */
@@ -1645,6 +2037,21 @@ bool Anvil::MemoryAllocator::bake()
         {
             anvil_assert(item_ptr->is_baked);
 
+            /* Record the assignment before the memory block is handed over to the object */
+            {
+                ItemAssignment assignment;
+
+                assignment.memory            = item_ptr->alloc_memory_block_ptr->get_memory();
+                assignment.memory_type_index = item_ptr->alloc_memory_block_ptr->get_create_info_ptr()->get_memory_type_index();
+                assignment.name              = (item_ptr->buffer_ptr != nullptr) ? item_ptr->buffer_ptr->get_name()
+                                                                                 : item_ptr->image_ptr->get_name ();
+                assignment.size              = item_ptr->alloc_size;
+                assignment.start_offset      = item_ptr->alloc_memory_block_ptr->get_start_offset();
+                assignment.type              = item_ptr->type;
+
+                m_item_assignments.push_back(assignment);
+            }
+
             switch (item_ptr->type)
             {
                 case Anvil::MemoryAllocator::ITEM_TYPE_BUFFER:
@@ -1658,10 +2065,48 @@ bool Anvil::MemoryAllocator::bake()
                         }
                         else
                         {
-                            /* Bind with default device indices in MGPU case. */
-                            item_ptr->buffer_ptr->set_nonsparse_memory(
-                                std::move(item_ptr->alloc_memory_block_ptr)
-                            );
+                            Anvil::BufferMemoryBindingUpdate binding_update;
+
+                            /* Bindings are batched and applied with a single call once all items have been traversed.
+                             *
+                             * Bind with default device indices in MGPU case. */
+                            binding_update.buffer_ptr                   = item_ptr->buffer_ptr;
+                            binding_update.memory_block_owned_by_buffer = true;
+                            binding_update.memory_block_ptr             = item_ptr->alloc_memory_block_ptr.release();
+
+                            buffer_binding_updates.push_back(binding_update);
+
+                            if (item_ptr->peer_view_buffer_ptr != nullptr)
+                            {
+                                const Anvil::MGPUDevice* mgpu_device_ptr(dynamic_cast<const Anvil::MGPUDevice*>(m_device_ptr) );
+
+                                anvil_assert(mgpu_device_ptr != nullptr);
+
+                                binding_update.buffer_ptr                   = item_ptr->peer_view_buffer_ptr;
+                                binding_update.memory_block_owned_by_buffer = false;
+
+                                /* BufferMemoryBindingUpdate takes physical devices, whose device group indices are used as device indices */
+                                for (const auto& current_device_index : item_ptr->peer_view_device_indices)
+                                {
+                                    for (uint32_t n_physical_device = 0;
+                                                  n_physical_device < mgpu_device_ptr->get_n_physical_devices();
+                                                ++n_physical_device)
+                                    {
+                                        const Anvil::PhysicalDevice* physical_device_ptr(mgpu_device_ptr->get_physical_device(n_physical_device) );
+
+                                        if (physical_device_ptr->get_device_group_device_index() == current_device_index)
+                                        {
+                                            binding_update.physical_devices.push_back(physical_device_ptr);
+
+                                            break;
+                                        }
+                                    }
+                                }
+
+                                anvil_assert(binding_update.physical_devices.size() == item_ptr->peer_view_device_indices.size() );
+
+                                buffer_binding_updates.push_back(binding_update);
+                            }
                         }
                     }
                     else
@@ -1772,10 +2217,25 @@ bool Anvil::MemoryAllocator::bake()
                         }
                         else
                         {
-                            /* Bind with default device indices in MGPU case. */
-                            item_ptr->image_ptr->set_memory(
-                                std::move(item_ptr->alloc_memory_block_ptr)
-                            );
+                            Anvil::ImageMemoryBindingUpdate binding_update;
+
+                            /* Bindings are batched and applied with a single call once all items have been traversed.
+                             *
+                             * Bind with default device indices in MGPU case. */
+                            binding_update.image_ptr                   = item_ptr->image_ptr;
+                            binding_update.memory_block_owned_by_image = true;
+                            binding_update.memory_block_ptr            = item_ptr->alloc_memory_block_ptr.release();
+
+                            image_binding_updates.push_back(binding_update);
+
+                            if (item_ptr->peer_view_image_ptr != nullptr)
+                            {
+                                binding_update.device_indices              = item_ptr->peer_view_device_indices;
+                                binding_update.image_ptr                   = item_ptr->peer_view_image_ptr;
+                                binding_update.memory_block_owned_by_image = false;
+
+                                image_binding_updates.push_back(binding_update);
+                            }
                         }
                     }
                     else
@@ -1938,6 +2398,45 @@ bool Anvil::MemoryAllocator::bake()
         }
     }
 
+    /* Bind memory to all non-sparse resources with one vkBindBufferMemory2KHR() and one vkBindImageMemory2KHR() call. */
+    if (buffer_binding_updates.size() > 0)
+    {
+        if (!Anvil::Buffer::set_nonsparse_memory_multi(static_cast<uint32_t>(buffer_binding_updates.size() ),
+                                                      &buffer_binding_updates.at(0) ))
+        {
+            anvil_assert_fail();
+
+            for (const auto& current_update : buffer_binding_updates)
+            {
+                if (current_update.memory_block_owned_by_buffer)
+                {
+                    delete current_update.memory_block_ptr;
+                }
+            }
+
+            result = false;
+        }
+    }
+
+    if (image_binding_updates.size() > 0)
+    {
+        if (!Anvil::Image::set_memory_multi(static_cast<uint32_t>(image_binding_updates.size() ),
+                                           &image_binding_updates.at(0) ))
+        {
+            anvil_assert_fail();
+
+            for (const auto& current_update : image_binding_updates)
+            {
+                if (current_update.memory_block_owned_by_image)
+                {
+                    delete current_update.memory_block_ptr;
+                }
+            }
+
+            result = false;
+        }
+    }
+
     if (m_post_bake_per_buffer_item_mem_assignment_callback_function == nullptr)
     {
         /* If memory backing is needed for one or more sparse resources, bind these now */
@@ -1949,11 +2448,11 @@ bool Anvil::MemoryAllocator::bake()
             anvil_assert(result);
 
             /* Block until the sparse memory bindings are in place */
-            Anvil::Vulkan::vkWaitForFences(m_device_ptr->get_device_vk(),
-                                           1, /* fenceCount */
-                                           sparse_memory_binding.get_fence()->get_fence_ptr(),
-                                           VK_FALSE, /* waitAll */
-                                           UINT64_MAX);
+            m_device_ptr->get_dispatch_table().vkWaitForFences(m_device_ptr->get_device_vk(),
+                                                               1, /* fenceCount */
+                                                               sparse_memory_binding.get_fence()->get_fence_ptr(),
+                                                               VK_FALSE, /* waitAll */
+                                                               UINT64_MAX);
         }
     }
 
@@ -1974,6 +2473,7 @@ bool Anvil::MemoryAllocator::bake()
         if (item_ptr->is_baked)
         {
             decltype(m_per_object_pending_alloc_status)::iterator alloc_status_map_iterator;
+            std::unique_lock<Anvil::RecursiveSpinLock>            status_lock               = lock_pending_alloc_status();
 
             switch (item_ptr->type)
             {
@@ -2057,6 +2557,65 @@ bool Anvil::MemoryAllocator::bake()
                                                     buffer_size,
                                                    &(*current_item_ptr->buffer_ref_uint32_vector_data_ptr)[0]);
             }
+            else
+            if (current_item_ptr->buffer_ref_fill_callback_function != nullptr)
+            {
+                Anvil::MemoryBlock*      memory_block_ptr = current_item_ptr->buffer_ptr->get_memory_block(0);
+                const MemoryFeatureFlags memory_features  = memory_block_ptr->get_create_info_ptr()->get_memory_features();
+
+                /* Let the app write straight into the buffer memory, if possible. Non-coherent memory would need
+                 * an explicit flush and non-mappable memory needs a staging copy. write() takes care of both. */
+                if ((memory_features & Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT)       != 0 &&
+                    (memory_features & Anvil::MemoryFeatureFlagBits::HOST_COHERENT_BIT)  != 0 &&
+                    (memory_features & Anvil::MemoryFeatureFlagBits::MULTI_INSTANCE_BIT) == 0)
+                {
+                    void* mapped_data_ptr = nullptr;
+
+                    if (memory_block_ptr->map(0, /* in_start_offset */
+                                              buffer_size,
+                                             &mapped_data_ptr) )
+                    {
+                        current_item_ptr->buffer_ref_fill_callback_function(current_item_ptr->buffer_ptr,
+                                                                            mapped_data_ptr,
+                                                                            buffer_size);
+
+                        memory_block_ptr->unmap();
+                    }
+                    else
+                    {
+                        anvil_assert_fail();
+                    }
+                }
+                else
+                {
+                    std::unique_ptr<uint8_t[]> fill_data_ptr(new uint8_t[static_cast<size_t>(buffer_size)]);
+
+                    current_item_ptr->buffer_ref_fill_callback_function(current_item_ptr->buffer_ptr,
+                                                                        fill_data_ptr.get(),
+                                                                        buffer_size);
+
+                    current_item_ptr->buffer_ptr->write(0, /* start_offset */
+                                                        buffer_size,
+                                                        fill_data_ptr.get() );
+                }
+            }
+            else
+            if (!current_item_ptr->buffer_ref_file_name.empty() )
+            {
+                auto mapped_file_ptr = Anvil::MappedFile::create(current_item_ptr->buffer_ref_file_name);
+
+                if (mapped_file_ptr             == nullptr                                                    ||
+                    mapped_file_ptr->get_size() <  current_item_ptr->buffer_ref_file_start_offset + buffer_size)
+                {
+                    anvil_assert_fail();
+
+                    continue;
+                }
+
+                current_item_ptr->buffer_ptr->write(0, /* start_offset */
+                                                    buffer_size,
+                                                    static_cast<const uint8_t*>(mapped_file_ptr->get_data_ptr() ) + current_item_ptr->buffer_ref_file_start_offset);
+            }
         }
     }
 
@@ -2068,6 +2627,8 @@ bool Anvil::MemoryAllocator::bake()
     }
 
 end:
+    check_memory_budget();
+
     if (mutex_lock.owns_lock() )
     {
         mutex_lock.unlock();
@@ -2076,19 +2637,359 @@ end:
     return result;
 }
 
-/* Please see header for specification */
-Anvil::MemoryAllocatorUniquePtr Anvil::MemoryAllocator::create_oneshot(const Anvil::BaseDevice* in_device_ptr,
-                                                                       MTSafety                 in_mt_safety)
+/** Assigns memory to aliased items. Items are grouped by memory type, device mask and memory priority, and each
+ *  group is given a single memory block. Within a group, items are placed, largest first, at the lowest offset
+ *  which does not overlap with regions of already placed items whose lifetimes overlap with the item's lifetime.
+ *
+ *  Memory blocks assigned to the items are derived from the group's memory block, which is released when the
+ *  last of them goes out of scope.
+ *
+ *  @param in_items Aliased items to assign memory to.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::MemoryAllocator::bake_aliased_items(Items& in_items)
 {
-    std::shared_ptr<IMemoryAllocatorBackend> backend_ptr;
-    const bool                               mt_safe    (Anvil::Utils::convert_mt_safety_enum_to_boolean(in_mt_safety,
-                                                                                                         in_device_ptr) );
-    std::unique_ptr<MemoryAllocator>         result_ptr (nullptr,
-                                                         std::default_delete<MemoryAllocator>() );
+    typedef std::tuple<uint32_t, uint32_t, float> GroupKey; /* memory type index, device mask, memory priority */
 
-    backend_ptr.reset(
-        new Anvil::MemoryAllocatorBackends::OneShot(in_device_ptr)
-    );
+    const auto                              do_lifetimes_overlap = [](const Item* in_item1_ptr,
+                                                                      const Item* in_item2_ptr)
+    {
+        return (in_item1_ptr->alias_first_use <= in_item2_ptr->alias_last_use &&
+                in_item2_ptr->alias_first_use <= in_item1_ptr->alias_last_use);
+    };
+    const VkDeviceSize                      granularity          = m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits.buffer_image_granularity;
+    std::map<GroupKey, std::vector<Item*> > groups;
+    const auto&                             memory_props         = m_device_ptr->get_physical_device_memory_properties();
+    bool                                    result               = true;
+
+    for (auto& current_item_ptr : in_items)
+    {
+        uint32_t n_memory_type = 0;
+
+        anvil_assert(current_item_ptr->alloc_memory_supported_memory_types != 0);
+
+        while ((current_item_ptr->alloc_memory_supported_memory_types & (1u << n_memory_type)) == 0)
+        {
+            ++n_memory_type;
+        }
+
+        groups[GroupKey(n_memory_type,
+                        current_item_ptr->alloc_device_mask,
+                        current_item_ptr->memory_priority)].push_back(current_item_ptr.get() );
+    }
+
+    for (auto& current_group : groups)
+    {
+        const uint32_t                                      n_memory_type    = std::get<0>(current_group.first);
+        auto&                                               current_items    = current_group.second;
+        VkDeviceSize                                        n_bytes_items    = 0;
+        VkDeviceSize                                        n_bytes_required = 0;
+        std::shared_ptr<Anvil::MemoryBlock>                 parent_memory_block_ptr;
+        std::vector<VkDeviceSize>                           start_offsets;
+        std::vector<std::pair<VkDeviceSize, VkDeviceSize> > used_ranges;
+
+        std::stable_sort(current_items.begin(),
+                         current_items.end  (),
+                         [](const Item* in_item1_ptr,
+                            const Item* in_item2_ptr)
+                         {
+                             return in_item1_ptr->alloc_size > in_item2_ptr->alloc_size;
+                         });
+
+        /* Regions are aligned to the buffer-image granularity, so that linear and non-linear resources can be mixed freely */
+        for (uint32_t n_item = 0;
+                      n_item < static_cast<uint32_t>(current_items.size() );
+                    ++n_item)
+        {
+            const Item*        current_item_ptr = current_items.at(n_item);
+            const VkDeviceSize alignment        = std::max(current_item_ptr->alloc_memory_required_alignment,
+                                                           granularity);
+            VkDeviceSize       start_offset     = 0;
+
+            used_ranges.clear();
+
+            for (uint32_t n_placed_item = 0;
+                          n_placed_item < n_item;
+                        ++n_placed_item)
+            {
+                if (do_lifetimes_overlap(current_items.at(n_placed_item),
+                                         current_item_ptr) )
+                {
+                    used_ranges.push_back(
+                        std::make_pair(start_offsets.at(n_placed_item),
+                                       start_offsets.at(n_placed_item) + current_items.at(n_placed_item)->alloc_size)
+                    );
+                }
+            }
+
+            std::sort(used_ranges.begin(),
+                      used_ranges.end  () );
+
+            for (const auto& current_used_range : used_ranges)
+            {
+                if (start_offset + current_item_ptr->alloc_size <= current_used_range.first)
+                {
+                    break;
+                }
+
+                start_offset = std::max(start_offset,
+                                        Anvil::Utils::round_up(current_used_range.second,
+                                                               alignment) );
+            }
+
+            start_offsets.push_back(start_offset);
+
+            n_bytes_items    += current_item_ptr->alloc_size;
+            n_bytes_required  = std::max(n_bytes_required,
+                                         start_offset + current_item_ptr->alloc_size);
+        }
+
+        {
+            Anvil::MemoryBlockUniquePtr new_memory_block_ptr(nullptr,
+                                                             std::default_delete<Anvil::MemoryBlock>() );
+
+            {
+                auto create_info_ptr = Anvil::MemoryBlockCreateInfo::create_regular(m_device_ptr,
+                                                                                    1u << n_memory_type,
+                                                                                    n_bytes_required,
+                                                                                    memory_props.types.at(n_memory_type).features);
+
+                create_info_ptr->set_memory_priority    (std::get<2>(current_group.first) );
+                create_info_ptr->set_device_mask        (std::get<1>(current_group.first) );
+                create_info_ptr->set_mt_safety          (Anvil::Utils::convert_boolean_to_mt_safety_enum(m_device_ptr->is_mt_safe()) );
+                create_info_ptr->set_persistently_mapped(m_persistent_mapping_enabled);
+
+                new_memory_block_ptr = Anvil::MemoryBlock::create(std::move(create_info_ptr) );
+            }
+
+            if (new_memory_block_ptr == nullptr)
+            {
+                anvil_assert(new_memory_block_ptr != nullptr);
+
+                result = false;
+                continue;
+            }
+
+            parent_memory_block_ptr = std::move(new_memory_block_ptr);
+        }
+
+        for (uint32_t n_item = 0;
+                      n_item < static_cast<uint32_t>(current_items.size() );
+                    ++n_item)
+        {
+            auto current_item_ptr = current_items.at(n_item);
+
+            {
+                auto create_info_ptr = Anvil::MemoryBlockCreateInfo::create_derived_with_custom_delete_proc(m_device_ptr,
+                                                                                                            parent_memory_block_ptr->get_memory(),
+                                                                                                            1u << n_memory_type,
+                                                                                                            memory_props.types.at(n_memory_type).features,
+                                                                                                            n_memory_type,
+                                                                                                            current_item_ptr->alloc_size,
+                                                                                                            start_offsets.at(n_item),
+                                                                                                            [parent_memory_block_ptr](Anvil::MemoryBlock*)
+                                                                                                            {
+                                                                                                                /* The parent block releases the memory once all regions are gone */
+                                                                                                            });
+
+                current_item_ptr->alloc_memory_block_ptr = Anvil::MemoryBlock::create(std::move(create_info_ptr) );
+            }
+
+            if (current_item_ptr->alloc_memory_block_ptr == nullptr)
+            {
+                anvil_assert(current_item_ptr->alloc_memory_block_ptr != nullptr);
+
+                result = false;
+                continue;
+            }
+
+            current_item_ptr->alloc_memory_final_type = n_memory_type;
+            current_item_ptr->is_baked                = true;
+        }
+
+        /* Validate the placement: items which may be in use at the same time must not share memory */
+        for (uint32_t n_item1 = 0;
+                      n_item1 < static_cast<uint32_t>(current_items.size() );
+                    ++n_item1)
+        {
+            for (uint32_t n_item2 = n_item1 + 1;
+                          n_item2 < static_cast<uint32_t>(current_items.size() );
+                        ++n_item2)
+            {
+                const auto item1_ptr = current_items.at(n_item1);
+                const auto item2_ptr = current_items.at(n_item2);
+
+                if (item1_ptr->alloc_memory_block_ptr != nullptr &&
+                    item2_ptr->alloc_memory_block_ptr != nullptr &&
+                    do_lifetimes_overlap(item1_ptr,
+                                         item2_ptr) )
+                {
+                    anvil_assert(!item1_ptr->alloc_memory_block_ptr->intersects(item2_ptr->alloc_memory_block_ptr.get() ));
+                }
+            }
+        }
+
+        m_aliasing_stats.memory_type_n_bytes_allocated.at(n_memory_type) += n_bytes_required;
+        m_aliasing_stats.memory_type_n_bytes_used.at     (n_memory_type) += n_bytes_required;
+        m_aliasing_stats.memory_type_n_memory_blocks.at  (n_memory_type) += 1;
+        m_aliasing_stats.n_allocations                                   += static_cast<uint32_t>(current_items.size() );
+        m_aliasing_stats.n_bytes_allocated                               += n_bytes_required;
+        m_aliasing_stats.n_bytes_saved_by_aliasing                       += (n_bytes_items > n_bytes_required) ? (n_bytes_items - n_bytes_required) : 0;
+        m_aliasing_stats.n_bytes_used                                    += n_bytes_required;
+        m_aliasing_stats.n_memory_blocks                                 += 1;
+    }
+
+    anvil_assert(result);
+
+    return result;
+}
+
+/** Passes non-aliased items to the backend.
+ *
+ *  If the backend supports concurrent bakes, items are grouped by the set of memory types they can be assigned
+ *  memory from, and the groups are baked in parallel on the device's task scheduler.
+ *
+ *  @param in_items Items to bake. Order of the items may change.
+ *
+ *  @return true if all items were baked successfully, false otherwise.
+ **/
+bool Anvil::MemoryAllocator::bake_backend_items(Items& in_items)
+{
+    std::vector<Items>           item_groups;
+    std::map<uint32_t, uint32_t> memory_types_to_group_index_map;
+    std::atomic<uint32_t>        n_failed_groups   (0);
+    bool                         result            = false;
+    Anvil::TaskScheduler*        task_scheduler_ptr(nullptr);
+
+    if (m_backend_ptr->supports_concurrent_bakes() )
+    {
+        task_scheduler_ptr = m_device_ptr->get_task_scheduler();
+    }
+
+    if (task_scheduler_ptr == nullptr)
+    {
+        result = m_backend_ptr->bake(in_items);
+
+        goto end;
+    }
+
+    for (auto& current_item_ptr : in_items)
+    {
+        auto group_iterator = memory_types_to_group_index_map.find(current_item_ptr->alloc_memory_supported_memory_types);
+
+        if (group_iterator == memory_types_to_group_index_map.end() )
+        {
+            group_iterator = memory_types_to_group_index_map.insert(
+                std::make_pair(current_item_ptr->alloc_memory_supported_memory_types,
+                               static_cast<uint32_t>(item_groups.size() ))
+            ).first;
+
+            item_groups.push_back(Items() );
+        }
+
+        item_groups.at(group_iterator->second).push_back(
+            std::move(current_item_ptr)
+        );
+    }
+
+    in_items.clear();
+
+    if (item_groups.size() == 1)
+    {
+        in_items = std::move(item_groups.at(0) );
+        result   = m_backend_ptr->bake(in_items);
+
+        goto end;
+    }
+
+    task_scheduler_ptr->parallel_for(static_cast<uint32_t>(item_groups.size() ),
+                                     1, /* in_min_items_per_task */
+                                     [this, &item_groups, &n_failed_groups](uint32_t in_n_first_group,
+                                                                            uint32_t in_n_groups)
+                                     {
+                                         for (uint32_t n_group  = in_n_first_group;
+                                                       n_group  < in_n_first_group + in_n_groups;
+                                                     ++n_group)
+                                         {
+                                             if (!m_backend_ptr->bake(item_groups.at(n_group) ) )
+                                             {
+                                                 n_failed_groups.fetch_add(1);
+                                             }
+                                         }
+                                     });
+
+    for (auto& current_group : item_groups)
+    {
+        for (auto& current_item_ptr : current_group)
+        {
+            in_items.push_back(
+                std::move(current_item_ptr)
+            );
+        }
+    }
+
+    result = (n_failed_groups.load() == 0);
+end:
+    return result;
+}
+
+/** Issues the low memory callback for each memory heap whose usage has reached the threshold specified at
+ *  set_low_memory_callback() call time.
+ **/
+void Anvil::MemoryAllocator::check_memory_budget()
+{
+    std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> n_bytes_budget;
+    std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> n_bytes_used;
+    uint32_t                                      n_heaps;
+
+    if (m_low_memory_callback_function == nullptr)
+    {
+        goto end;
+    }
+
+    get_heap_budgets(&n_bytes_used,
+                     &n_bytes_budget);
+
+    n_heaps = m_device_ptr->get_physical_device_memory_properties().n_heaps;
+
+    for (uint32_t n_heap = 0;
+                  n_heap < n_heaps;
+                ++n_heap)
+    {
+        if (n_bytes_budget.at(n_heap) == 0)
+        {
+            continue;
+        }
+
+        if (static_cast<double>(n_bytes_used.at(n_heap) ) >= static_cast<double>(n_bytes_budget.at(n_heap) ) * m_low_memory_usage_threshold)
+        {
+            m_low_memory_callback_function(this,
+                                           n_heap,
+                                           n_bytes_used.at  (n_heap),
+                                           n_bytes_budget.at(n_heap) );
+        }
+    }
+
+end:
+    ;
+}
+
+/* Please see header for specification */
+Anvil::MemoryAllocatorUniquePtr Anvil::MemoryAllocator::create_oneshot(const Anvil::BaseDevice* in_device_ptr,
+                                                                       MTSafety                 in_mt_safety,
+                                                                       VkDeviceSize             in_min_block_size)
+{
+    std::shared_ptr<IMemoryAllocatorBackend> backend_ptr;
+    const bool                               mt_safe    (Anvil::Utils::convert_mt_safety_enum_to_boolean(in_mt_safety,
+                                                                                                         in_device_ptr) );
+    std::unique_ptr<MemoryAllocator>         result_ptr (nullptr,
+                                                         std::default_delete<MemoryAllocator>() );
+
+    backend_ptr.reset(
+        new Anvil::MemoryAllocatorBackends::OneShot(in_device_ptr,
+                                                    in_min_block_size)
+    );
 
     if (backend_ptr != nullptr)
     {
@@ -2103,8 +3004,9 @@ Anvil::MemoryAllocatorUniquePtr Anvil::MemoryAllocator::create_oneshot(const Anv
 }
 
 /* Please see header for specification */
-Anvil::MemoryAllocatorUniquePtr Anvil::MemoryAllocator::create_vma(const Anvil::BaseDevice* in_device_ptr,
-                                                                   MTSafety                 in_mt_safety)
+Anvil::MemoryAllocatorUniquePtr Anvil::MemoryAllocator::create_vma(const Anvil::BaseDevice*              in_device_ptr,
+                                                                   MTSafety                              in_mt_safety,
+                                                                   const std::vector<VMAPoolCreateInfo>& in_pools)
 {
     std::shared_ptr<IMemoryAllocatorBackend> backend_ptr;
     const bool                               mt_safe    (Anvil::Utils::convert_mt_safety_enum_to_boolean(in_mt_safety,
@@ -2112,7 +3014,8 @@ Anvil::MemoryAllocatorUniquePtr Anvil::MemoryAllocator::create_vma(const Anvil::
     std::unique_ptr<MemoryAllocator>         result_ptr(nullptr,
                                                         std::default_delete<MemoryAllocator>() );
 
-    backend_ptr = Anvil::MemoryAllocatorBackends::VMA::create(in_device_ptr);
+    backend_ptr = Anvil::MemoryAllocatorBackends::VMA::create(in_device_ptr,
+                                                              in_pools);
 
     if (backend_ptr != nullptr)
     {
@@ -2126,6 +3029,104 @@ Anvil::MemoryAllocatorUniquePtr Anvil::MemoryAllocator::create_vma(const Anvil::
     return std::move(result_ptr);
 }
 
+/* Please see header for specification */
+bool Anvil::MemoryAllocator::defragment(const std::vector<Anvil::Buffer*>& in_buffers,
+                                        uint64_t                           in_time_budget_msec,
+                                        uint32_t                           in_n_max_moves_per_pass,
+                                        DefragmentationStats*              out_opt_stats_ptr,
+                                        bool*                              out_opt_is_complete_ptr)
+{
+    std::vector<void*>                         backend_objects;
+    std::vector<Anvil::Buffer*>                buffers;
+    bool                                       is_complete     (false);
+    std::vector<MovedBackendObject>            moved_objects;
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr       (get_mutex() );
+    bool                                       result          (false);
+    DefragmentationStats                       stats;
+    Anvil::Time                                timer;
+
+    anvil_assert(in_n_max_moves_per_pass > 0);
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    if (!m_backend_ptr->supports_defragmentation() )
+    {
+        anvil_assert(m_backend_ptr->supports_defragmentation() );
+
+        goto end;
+    }
+
+    /* Only consider buffers whose memory we can safely move */
+    for (auto current_buffer_ptr : in_buffers)
+    {
+        if (!is_buffer_defragmentable(current_buffer_ptr) )
+        {
+            continue;
+        }
+
+        backend_objects.push_back(current_buffer_ptr->m_memory_block_ptr->m_backend_object);
+        buffers.push_back        (current_buffer_ptr);
+    }
+
+    if (buffers.size() == 0)
+    {
+        is_complete = true;
+        result      = true;
+
+        goto end;
+    }
+
+    do
+    {
+        moved_objects.clear();
+
+        if (!m_backend_ptr->defragment(backend_objects,
+                                       in_n_max_moves_per_pass,
+                                      &moved_objects,
+                                      &stats,
+                                      &is_complete) )
+        {
+            goto end;
+        }
+
+        /* Data has already been copied at this point. The buffers need to be re-created before the old regions are handed out. */
+        for (const auto& current_moved_object : moved_objects)
+        {
+            auto buffer_ptr = buffers.at(current_moved_object.n_backend_object);
+
+            buffer_ptr->m_memory_block_ptr->on_memory_moved(current_moved_object.memory,
+                                                            current_moved_object.start_offset);
+
+            if (!buffer_ptr->on_memory_moved() )
+            {
+                goto end;
+            }
+        }
+    }
+    while (!is_complete                                                     &&
+           (in_time_budget_msec == 0 || timer.get_time_in_msec() < in_time_budget_msec) );
+
+    result = true;
+end:
+    if (out_opt_is_complete_ptr != nullptr)
+    {
+        *out_opt_is_complete_ptr = is_complete;
+    }
+
+    if (out_opt_stats_ptr != nullptr)
+    {
+        *out_opt_stats_ptr = stats;
+    }
+
+    return result;
+}
+
 bool Anvil::MemoryAllocator::do_external_memory_handle_type_sanity_checks(const Anvil::ExternalMemoryHandleTypeFlags& in_external_memory_handle_types) const
 {
     bool result = true;
@@ -2143,6 +3144,72 @@ bool Anvil::MemoryAllocator::do_external_memory_handle_type_sanity_checks(const
     return result;
 }
 
+/** Please see header for specification */
+bool Anvil::MemoryAllocator::get_heap_budget(uint32_t      in_n_heap,
+                                             VkDeviceSize* out_n_bytes_used_ptr,
+                                             VkDeviceSize* out_n_bytes_budget_ptr) const
+{
+    std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> n_bytes_budget;
+    std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> n_bytes_used;
+    bool                                          result = false;
+
+    anvil_assert(out_n_bytes_budget_ptr != nullptr);
+    anvil_assert(out_n_bytes_used_ptr   != nullptr);
+
+    if (in_n_heap >= m_device_ptr->get_physical_device_memory_properties().n_heaps)
+    {
+        anvil_assert(in_n_heap < m_device_ptr->get_physical_device_memory_properties().n_heaps);
+
+        goto end;
+    }
+
+    get_heap_budgets(&n_bytes_used,
+                     &n_bytes_budget);
+
+    *out_n_bytes_budget_ptr = n_bytes_budget.at(in_n_heap);
+    *out_n_bytes_used_ptr   = n_bytes_used.at  (in_n_heap);
+
+    result = true;
+end:
+    return result;
+}
+
+/** Retrieves usage and budget of all memory heaps. Please see get_heap_budget() documentation for details.
+ *
+ *  For multi-GPU devices, budget reported for the first physical device in the group is used.
+ **/
+void Anvil::MemoryAllocator::get_heap_budgets(std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS>* out_n_bytes_used_ptr,
+                                              std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS>* out_n_bytes_budget_ptr) const
+{
+    if (m_device_ptr->get_extension_info()->ext_memory_budget() )
+    {
+        const Anvil::PhysicalDevice* physical_device_ptr = (m_device_ptr->get_type() == Anvil::DeviceType::MULTI_GPU) ? dynamic_cast<const Anvil::MGPUDevice*>(m_device_ptr)->get_physical_device(0)
+                                                                                                                      : dynamic_cast<const Anvil::SGPUDevice*>(m_device_ptr)->get_physical_device();
+        const Anvil::MemoryBudget    budget              = physical_device_ptr->get_available_memory_budget();
+
+        *out_n_bytes_budget_ptr = budget.heap_budget;
+        *out_n_bytes_used_ptr   = budget.heap_usage;
+    }
+    else
+    {
+        const auto& memory_props = m_device_ptr->get_physical_device_memory_properties();
+        Stats       stats;
+
+        get_stats(&stats);
+
+        out_n_bytes_budget_ptr->fill(0);
+
+        for (uint32_t n_heap = 0;
+                      n_heap < memory_props.n_heaps;
+                    ++n_heap)
+        {
+            out_n_bytes_budget_ptr->at(n_heap) = memory_props.heaps[n_heap].size;
+        }
+
+        *out_n_bytes_used_ptr = stats.heap_n_bytes_allocated;
+    }
+}
+
 /** Tells whether or not a given set of memory types supports the requested memory features. */
 bool Anvil::MemoryAllocator::get_mem_types_supporting_mem_features(const Anvil::BaseDevice*         in_device_ptr,
                                                                    uint32_t                         in_memory_types,
@@ -2156,6 +3223,7 @@ bool Anvil::MemoryAllocator::get_mem_types_supporting_mem_features(const Anvil::
     const bool  is_mappable_memory_required        (((in_memory_features & Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT)         != 0) );
     const bool  is_multi_instance_memory_required  (((in_memory_features & Anvil::MemoryFeatureFlagBits::MULTI_INSTANCE_BIT)   != 0) );
     const bool  is_protected_memory_required       (((in_memory_features & Anvil::MemoryFeatureFlagBits::PROTECTED_BIT)        != 0) );
+    const bool  is_device_local_memory_preferred   (((in_memory_features & Anvil::MemoryFeatureFlagBits::PREFER_DEVICE_LOCAL_BIT) != 0) );
     const auto& memory_props                       (in_device_ptr->get_physical_device_memory_properties()  );
     const auto  n_forced_mem_type                  (in_device_ptr->get_parent_instance()->get_create_info_ptr()->get_n_memory_type_to_use_for_all_allocs() );
     bool        result                             (true);
@@ -2192,6 +3260,36 @@ bool Anvil::MemoryAllocator::get_mem_types_supporting_mem_features(const Anvil::
         }
     }
 
+    /* Narrow the set down to preferred memory types, if any of the remaining ones qualifies. For host-visible
+     * allocations, this picks resizable BAR memory which lets the CPU write straight to VRAM without any staging. */
+    if (is_device_local_memory_preferred)
+    {
+        uint32_t preferred_memory_types = 0;
+
+        if (is_mappable_memory_required)
+        {
+            preferred_memory_types = in_memory_types & memory_props.resizable_bar_memory_types;
+        }
+        else
+        {
+            for (uint32_t n_memory_type = 0;
+                          (1u << n_memory_type) <= in_memory_types;
+                        ++n_memory_type)
+            {
+                if ((in_memory_types                         & (1u << n_memory_type))                          != 0 &&
+                    (memory_props.types[n_memory_type].flags & Anvil::MemoryPropertyFlagBits::DEVICE_LOCAL_BIT) != 0)
+                {
+                    preferred_memory_types |= (1u << n_memory_type);
+                }
+            }
+        }
+
+        if (preferred_memory_types != 0)
+        {
+            in_memory_types = preferred_memory_types;
+        }
+    }
+
 end:
     if (result                                       &&
         out_opt_filtered_memory_types_ptr != nullptr)
@@ -2203,41 +3301,372 @@ end:
 }
 
 /* Please see header for specification */
-void Anvil::MemoryAllocator::on_is_alloc_pending_for_buffer_query(CallbackArgument* in_callback_arg_ptr)
+void Anvil::MemoryAllocator::get_item_assignments(std::vector<ItemAssignment>* out_assignments_ptr) const
 {
-    IsBufferMemoryAllocPendingQueryCallbackArgument* query_ptr                 = dynamic_cast<IsBufferMemoryAllocPendingQueryCallbackArgument*>(in_callback_arg_ptr);
-    auto                                             alloc_status_map_iterator = m_per_object_pending_alloc_status.find                        (query_ptr->buffer_ptr);
-    std::unique_lock<std::recursive_mutex>           mutex_lock;
-    auto                                             mutex_ptr                 = get_mutex();
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr  = get_mutex();
+
+    anvil_assert(out_assignments_ptr != nullptr);
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
         );
     }
 
-    if (alloc_status_map_iterator != m_per_object_pending_alloc_status.end() )
+    *out_assignments_ptr = m_item_assignments;
+}
+
+/* Please see header for specification */
+std::string Anvil::MemoryAllocator::get_json_dump() const
+{
+    std::string                                backend_json;
+    char                                       entry_data[256];
+    const auto&                                memory_props = m_device_ptr->get_physical_device_memory_properties();
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr    = get_mutex();
+    std::string                                result;
+    Stats                                      stats;
+
+    if (mutex_ptr != nullptr)
     {
-        query_ptr->result = true;
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    get_stats                  (&stats);
+    m_backend_ptr->get_json_dump(&backend_json);
+
+    snprintf(entry_data,
+             sizeof(entry_data),
+             "{\n\"Stats\":{\"Allocations\":%u,\"DedicatedAllocations\":%u,\"Blocks\":%u,\"ReservedBytes\":%llu,\"UsedBytes\":%llu,\"LargestFreeRange\":%llu,\"MemoryTypes\":[",
+             stats.n_allocations,
+             stats.n_dedicated_allocations,
+             stats.n_memory_blocks,
+             static_cast<unsigned long long>(stats.n_bytes_allocated),
+             static_cast<unsigned long long>(stats.n_bytes_used),
+             static_cast<unsigned long long>(stats.largest_free_range) );
+
+    result = entry_data;
+
+    for (uint32_t n_memory_type = 0;
+                  n_memory_type < static_cast<uint32_t>(memory_props.types.size() );
+                ++n_memory_type)
+    {
+        snprintf(entry_data,
+                 sizeof(entry_data),
+                 "%s\n{\"Index\":%u,\"Blocks\":%u,\"ReservedBytes\":%llu,\"UsedBytes\":%llu,\"LargestFreeRange\":%llu}",
+                 (n_memory_type == 0) ? "" : ",",
+                 n_memory_type,
+                 stats.memory_type_n_memory_blocks.at(n_memory_type),
+                 static_cast<unsigned long long>(stats.memory_type_n_bytes_allocated.at (n_memory_type) ),
+                 static_cast<unsigned long long>(stats.memory_type_n_bytes_used.at      (n_memory_type) ),
+                 static_cast<unsigned long long>(stats.memory_type_largest_free_range.at(n_memory_type) ) );
+
+        result += entry_data;
     }
+
+    result += "]},\n\"Items\":[";
+
+    for (uint32_t n_assignment = 0;
+                  n_assignment < static_cast<uint32_t>(m_item_assignments.size() );
+                ++n_assignment)
+    {
+        const auto& current_assignment = m_item_assignments.at(n_assignment);
+        const bool  is_buffer          = (current_assignment.type == ITEM_TYPE_BUFFER               ||
+                                          current_assignment.type == ITEM_TYPE_SPARSE_BUFFER_REGION);
+
+        result += (n_assignment == 0) ? "\n{\"Name\":\"" : ",\n{\"Name\":\"";
+
+        for (const auto& current_char : current_assignment.name)
+        {
+            if (current_char == '"'  ||
+                current_char == '\\')
+            {
+                result += '\\';
+            }
+
+            result += current_char;
+        }
+
+        snprintf(entry_data,
+                 sizeof(entry_data),
+                 "\",\"Type\":\"%s\",\"Memory\":\"0x%llx\",\"MemoryType\":%u,\"Offset\":%llu,\"Size\":%llu}",
+                 (is_buffer) ? "Buffer" : "Image",
+                 static_cast<unsigned long long>(reinterpret_cast<uint64_t>(current_assignment.memory) ),
+                 current_assignment.memory_type_index,
+                 static_cast<unsigned long long>(current_assignment.start_offset),
+                 static_cast<unsigned long long>(current_assignment.size) );
+
+        result += entry_data;
+    }
+
+    result += "],\n\"Backend\":";
+    result += backend_json;
+    result += "\n}\n";
+
+    return result;
 }
 
 /* Please see header for specification */
-void Anvil::MemoryAllocator::on_is_alloc_pending_for_image_query(CallbackArgument* in_callback_arg_ptr)
+void Anvil::MemoryAllocator::get_stats(Stats* out_stats_ptr) const
 {
-    IsImageMemoryAllocPendingQueryCallbackArgument* query_ptr                 = dynamic_cast<IsImageMemoryAllocPendingQueryCallbackArgument*>(in_callback_arg_ptr);
-    auto                                            alloc_status_map_iterator = m_per_object_pending_alloc_status.find                       (query_ptr->image_ptr);
-    std::unique_lock<std::recursive_mutex>          mutex_lock;
-    auto                                            mutex_ptr                 = get_mutex();
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr  = get_mutex();
+
+    anvil_assert(out_stats_ptr != nullptr);
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
         );
     }
 
+    *out_stats_ptr = Stats();
+
+    m_backend_ptr->get_stats(out_stats_ptr);
+
+    /* Memory backing aliased items is allocated by the allocator itself */
+    out_stats_ptr->n_allocations             += m_aliasing_stats.n_allocations;
+    out_stats_ptr->n_bytes_allocated         += m_aliasing_stats.n_bytes_allocated;
+    out_stats_ptr->n_bytes_saved_by_aliasing += m_aliasing_stats.n_bytes_saved_by_aliasing;
+    out_stats_ptr->n_bytes_used              += m_aliasing_stats.n_bytes_used;
+    out_stats_ptr->n_memory_blocks           += m_aliasing_stats.n_memory_blocks;
+
+    for (uint32_t n_memory_type = 0;
+                  n_memory_type < VK_MAX_MEMORY_TYPES;
+                ++n_memory_type)
+    {
+        out_stats_ptr->memory_type_n_bytes_allocated.at(n_memory_type) += m_aliasing_stats.memory_type_n_bytes_allocated.at(n_memory_type);
+        out_stats_ptr->memory_type_n_bytes_used.at     (n_memory_type) += m_aliasing_stats.memory_type_n_bytes_used.at     (n_memory_type);
+        out_stats_ptr->memory_type_n_memory_blocks.at  (n_memory_type) += m_aliasing_stats.memory_type_n_memory_blocks.at  (n_memory_type);
+    }
+
+    out_stats_ptr->n_bytes_wasted = out_stats_ptr->n_bytes_allocated - out_stats_ptr->n_bytes_used;
+
+    /* Backends only track memory types. Fold the numbers into per-heap totals. */
+    {
+        const auto& memory_props = m_device_ptr->get_physical_device_memory_properties();
+
+        for (uint32_t n_memory_type = 0;
+                      n_memory_type < static_cast<uint32_t>(memory_props.types.size() );
+                    ++n_memory_type)
+        {
+            const uint32_t n_heap = memory_props.types.at(n_memory_type).heap_ptr->index;
+
+            out_stats_ptr->heap_n_bytes_allocated.at(n_heap) += out_stats_ptr->memory_type_n_bytes_allocated.at(n_memory_type);
+        }
+    }
+}
+
+/** Validates peer device indices passed to add_peer_accessible_buffer() or add_peer_accessible_image() and forms
+ *  allocation properties, which make sure the allocated memory can be accessed by all specified peers.
+ *
+ *  @param in_peer_device_indices           Memory instance indices the peer view will be bound to, one per physical device.
+ *  @param in_required_peer_memory_features Peer memory features the memory must support.
+ *  @param out_device_mask_ptr              Deref will be set to a device mask covering all physical devices. Must not be null.
+ *  @param out_peer_memory_reqs_ptr         Deref will be filled with peer memory requirements for all (N, in_peer_device_indices[N])
+ *                                          pairs, where the two indices differ. Must not be null.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::MemoryAllocator::get_peer_access_properties(const std::vector<uint32_t>&         in_peer_device_indices,
+                                                        const Anvil::PeerMemoryFeatureFlags& in_required_peer_memory_features,
+                                                        uint32_t*                            out_device_mask_ptr,
+                                                        MGPUPeerMemoryRequirements*          out_peer_memory_reqs_ptr) const
+{
+    const Anvil::MGPUDevice* mgpu_device_ptr   (dynamic_cast<const Anvil::MGPUDevice*>(m_device_ptr) );
+    uint32_t                 n_physical_devices(0);
+    bool                     result            (false);
+
+    anvil_assert(out_device_mask_ptr      != nullptr);
+    anvil_assert(out_peer_memory_reqs_ptr != nullptr);
+
+    if (m_device_ptr->get_type() != Anvil::DeviceType::MULTI_GPU ||
+        mgpu_device_ptr          == nullptr)
+    {
+        anvil_assert(m_device_ptr->get_type() == Anvil::DeviceType::MULTI_GPU);
+
+        goto end;
+    }
+
+    if (!m_backend_ptr->supports_device_masks() )
+    {
+        anvil_assert(m_backend_ptr->supports_device_masks() );
+
+        goto end;
+    }
+
+    n_physical_devices = mgpu_device_ptr->get_n_physical_devices();
+
+    if (in_peer_device_indices.size() != n_physical_devices)
+    {
+        anvil_assert(in_peer_device_indices.size() == n_physical_devices);
+
+        goto end;
+    }
+
+    out_peer_memory_reqs_ptr->clear();
+
+    for (uint32_t n_physical_device = 0;
+                  n_physical_device < n_physical_devices;
+                ++n_physical_device)
+    {
+        const uint32_t peer_device_index = in_peer_device_indices.at(n_physical_device);
+
+        if (peer_device_index >= n_physical_devices)
+        {
+            anvil_assert(peer_device_index < n_physical_devices);
+
+            goto end;
+        }
+
+        if (peer_device_index != n_physical_device)
+        {
+            (*out_peer_memory_reqs_ptr)[LocalRemoteDeviceIndexPair(n_physical_device, peer_device_index)] = in_required_peer_memory_features;
+        }
+    }
+
+    /* Each physical device needs its own memory instance, so that peers have something to access. */
+    *out_device_mask_ptr = (1u << n_physical_devices) - 1;
+
+    result = true;
+end:
+    return result;
+}
+
+/** Tells whether the specified buffer's memory can be moved by defragment().
+ *
+ *  @param in_buffer_ptr Buffer to check. May be null.
+ *
+ *  @return true if the buffer is a baked, non-sparse, non-dedicated, unmapped buffer whose memory has
+ *          been assigned by this allocator; false otherwise.
+ **/
+bool Anvil::MemoryAllocator::is_buffer_defragmentable(Anvil::Buffer* in_buffer_ptr) const
+{
+    const Anvil::MemoryBlock* memory_block_ptr = nullptr;
+    bool                      is_dedicated     = false;
+    bool                      result           = false;
+
+    if (in_buffer_ptr                                            == nullptr ||
+        in_buffer_ptr->m_create_info_ptr->get_parent_buffer_ptr() != nullptr ||
+        in_buffer_ptr->m_page_tracker_ptr                        != nullptr)
+    {
+        goto end;
+    }
+
+    memory_block_ptr = in_buffer_ptr->m_memory_block_ptr;
+
+    if (memory_block_ptr                                               == nullptr             ||
+        memory_block_ptr->m_parent_memory_allocator_backend_ptr        != m_backend_ptr.get() ||
+        memory_block_ptr->m_create_info_ptr->get_parent_memory_block() != nullptr             ||
+        memory_block_ptr->m_gpu_data_map_count                         != 0)
+    {
+        goto end;
+    }
+
+    memory_block_ptr->m_create_info_ptr->get_dedicated_allocation_properties(&is_dedicated,
+                                                                             nullptr,  /* out_opt_buffer_ptr_ptr */
+                                                                             nullptr); /* out_opt_image_ptr_ptr  */
+
+    result = !is_dedicated;
+end:
+    return result;
+}
+
+/** Returns the list items registered by the calling thread should be added to, until the next bake.
+ *
+ *  @param out_lock_ptr Deref will be set to a lock held on the list, if the allocator is MT-safe. The lock
+ *                      must be held as long as the list is accessed. Must not be null.
+ *
+ *  @return Pointer to the list.
+ **/
+Anvil::MemoryAllocator::Items* Anvil::MemoryAllocator::get_pending_items(std::unique_lock<Anvil::RecursiveSpinLock>* out_lock_ptr)
+{
+    auto& shard = m_pending_item_shards.at(std::hash<std::thread::id>()(std::this_thread::get_id() ) % m_pending_item_shards.size() );
+
+    if (is_mt_safe() )
+    {
+        *out_lock_ptr = std::unique_lock<Anvil::RecursiveSpinLock>(shard.lock);
+    }
+
+    return &shard.items;
+}
+
+/** Tells whether any thread has registered an item which has not been baked yet. */
+bool Anvil::MemoryAllocator::has_pending_items()
+{
+    bool result = (m_items.size() > 0);
+
+    for (auto& current_shard : m_pending_item_shards)
+    {
+        std::unique_lock<Anvil::RecursiveSpinLock> shard_lock;
+
+        if (result)
+        {
+            break;
+        }
+
+        if (is_mt_safe() )
+        {
+            shard_lock = std::unique_lock<Anvil::RecursiveSpinLock>(current_shard.lock);
+        }
+
+        result = (current_shard.items.size() > 0);
+    }
+
+    return result;
+}
+
+/** Returns a lock which must be held while m_per_object_pending_alloc_status is accessed. The returned
+ *  lock does not own a mutex if the allocator is not MT-safe.
+ **/
+std::unique_lock<Anvil::RecursiveSpinLock> Anvil::MemoryAllocator::lock_pending_alloc_status()
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> result;
+
+    if (is_mt_safe() )
+    {
+        result = std::unique_lock<Anvil::RecursiveSpinLock>(m_pending_alloc_status_lock);
+    }
+
+    return result;
+}
+
+/** Marks the specified buffer or image as one which has been registered but not baked yet.
+ *
+ *  @param in_object_ptr Buffer or image the item has been registered for. Must not be null.
+ **/
+void Anvil::MemoryAllocator::mark_alloc_pending(const void* in_object_ptr)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> status_lock = lock_pending_alloc_status();
+
+    m_per_object_pending_alloc_status[in_object_ptr] = true;
+}
+
+/* Please see header for specification */
+void Anvil::MemoryAllocator::on_is_alloc_pending_for_buffer_query(CallbackArgument* in_callback_arg_ptr)
+{
+    IsBufferMemoryAllocPendingQueryCallbackArgument* query_ptr                 = dynamic_cast<IsBufferMemoryAllocPendingQueryCallbackArgument*>(in_callback_arg_ptr);
+    std::unique_lock<Anvil::RecursiveSpinLock>       status_lock               = lock_pending_alloc_status();
+    auto                                             alloc_status_map_iterator = m_per_object_pending_alloc_status.find(query_ptr->buffer_ptr);
+
+    if (alloc_status_map_iterator != m_per_object_pending_alloc_status.end() )
+    {
+        query_ptr->result = true;
+    }
+}
+
+/* Please see header for specification */
+void Anvil::MemoryAllocator::on_is_alloc_pending_for_image_query(CallbackArgument* in_callback_arg_ptr)
+{
+    IsImageMemoryAllocPendingQueryCallbackArgument* query_ptr                 = dynamic_cast<IsImageMemoryAllocPendingQueryCallbackArgument*>(in_callback_arg_ptr);
+    std::unique_lock<Anvil::RecursiveSpinLock>      status_lock               = lock_pending_alloc_status();
+    auto                                            alloc_status_map_iterator = m_per_object_pending_alloc_status.find(query_ptr->image_ptr);
+
     if (alloc_status_map_iterator != m_per_object_pending_alloc_status.end() )
     {
         query_ptr->result = true;
@@ -2248,21 +3677,41 @@ void Anvil::MemoryAllocator::on_is_alloc_pending_for_image_query(CallbackArgumen
 void Anvil::MemoryAllocator::on_implicit_bake_needed()
 {
     /* Sanity checks */
-    anvil_assert(m_items.size() >= 1);
+    anvil_assert(has_pending_items() );
 
     bake();
 }
 
+/** Please see header for specification */
+void Anvil::MemoryAllocator::set_low_memory_callback(MemoryAllocatorLowMemoryCallbackFunction in_callback_function,
+                                                     float                                    in_usage_threshold)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr = get_mutex();
+
+    anvil_assert(in_usage_threshold > 0.0f);
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    m_low_memory_callback_function = in_callback_function;
+    m_low_memory_usage_threshold   = in_usage_threshold;
+}
+
 /* Please see header for specification */
 void Anvil::MemoryAllocator::set_post_bake_callback(MemoryAllocatorBakeCallbackFunction in_post_bake_callback_function)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr = get_mutex();
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr = get_mutex();
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
         );
     }
 
@@ -19,6 +19,7 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 //
+#include "misc/memory_allocator.h"
 #include "misc/memory_block_create_info.h"
 #include "wrappers/device.h"
 #include "wrappers/memory_block.h"
@@ -87,6 +88,121 @@ Anvil::MemoryBlockCreateInfoUniquePtr Anvil::MemoryBlockCreateInfo::create_deriv
     return result_ptr;
 }
 
+#if !defined(_WIN32)
+    /** Please see header for specification */
+    Anvil::MemoryBlockCreateInfoUniquePtr Anvil::MemoryBlockCreateInfo::create_imported_dma_buf(const Anvil::BaseDevice*  in_device_ptr,
+                                                                                                int                       in_fd,
+                                                                                                VkDeviceSize              in_size,
+                                                                                                uint32_t                  in_allowed_memory_bits,
+                                                                                                Anvil::MemoryFeatureFlags in_memory_features)
+    {
+        uint32_t memory_type_index        = UINT32_MAX;
+        auto     result_ptr               = Anvil::MemoryBlockCreateInfoUniquePtr(nullptr,
+                                                                                  std::default_delete<Anvil::MemoryBlockCreateInfo>() );
+        uint32_t supported_memory_types   = 0;
+
+        anvil_assert(in_device_ptr != nullptr);
+        anvil_assert(in_fd         >= 0);
+
+        if (!in_device_ptr->get_memory_types_supported_for_external_handle(Anvil::ExternalMemoryHandleTypeFlagBits::DMA_BUF_BIT_EXT,
+                                                                           in_fd,
+                                                                          &supported_memory_types) )
+        {
+            goto end;
+        }
+
+        memory_type_index = get_imported_memory_type_index(in_device_ptr,
+                                                           supported_memory_types & in_allowed_memory_bits,
+                                                           in_memory_features);
+
+        if (memory_type_index == UINT32_MAX)
+        {
+            goto end;
+        }
+
+        result_ptr = create_with_memory_type(in_device_ptr,
+                                             in_allowed_memory_bits,
+                                             in_size,
+                                             in_memory_features,
+                                             memory_type_index);
+
+        if (result_ptr != nullptr)
+        {
+            result_ptr->set_external_handle_import_info         (in_fd);
+            result_ptr->set_imported_external_memory_handle_type(Anvil::ExternalMemoryHandleTypeFlagBits::DMA_BUF_BIT_EXT);
+        }
+
+    end:
+        return result_ptr;
+    }
+#endif
+
+/** Please see header for specification */
+Anvil::MemoryBlockCreateInfoUniquePtr Anvil::MemoryBlockCreateInfo::create_imported_host_allocation(const Anvil::BaseDevice*  in_device_ptr,
+                                                                                                    void*                     in_host_ptr,
+                                                                                                    VkDeviceSize              in_size,
+                                                                                                    uint32_t                  in_allowed_memory_bits,
+                                                                                                    Anvil::MemoryFeatureFlags in_memory_features)
+{
+    const Anvil::EXTExternalMemoryHostProperties* host_props_ptr         = nullptr;
+    uint32_t                                      memory_type_index      = UINT32_MAX;
+    auto                                          result_ptr             = Anvil::MemoryBlockCreateInfoUniquePtr(nullptr,
+                                                                                                                 std::default_delete<Anvil::MemoryBlockCreateInfo>() );
+    uint32_t                                      supported_memory_types = 0;
+
+    anvil_assert(in_device_ptr != nullptr);
+    anvil_assert(in_host_ptr   != nullptr);
+
+    host_props_ptr = in_device_ptr->get_physical_device_properties().ext_external_memory_host_properties_ptr;
+
+    if (host_props_ptr == nullptr)
+    {
+        anvil_assert(host_props_ptr != nullptr);
+
+        goto end;
+    }
+
+    /* Both the pointer and the size need to be aligned. Importing a misaligned region would fail at allocation time. */
+    if ((reinterpret_cast<uintptr_t>(in_host_ptr) % host_props_ptr->min_imported_host_pointer_alignment) != 0 ||
+        (in_size                                  % host_props_ptr->min_imported_host_pointer_alignment) != 0)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (!in_device_ptr->get_memory_types_supported_for_host_pointer(Anvil::ExternalMemoryHandleTypeFlagBits::HOST_ALLOCATION_BIT_EXT,
+                                                                    in_host_ptr,
+                                                                   &supported_memory_types) )
+    {
+        goto end;
+    }
+
+    memory_type_index = get_imported_memory_type_index(in_device_ptr,
+                                                       supported_memory_types & in_allowed_memory_bits,
+                                                       in_memory_features);
+
+    if (memory_type_index == UINT32_MAX)
+    {
+        goto end;
+    }
+
+    result_ptr = create_with_memory_type(in_device_ptr,
+                                         in_allowed_memory_bits,
+                                         in_size,
+                                         in_memory_features,
+                                         memory_type_index);
+
+    if (result_ptr != nullptr)
+    {
+        result_ptr->set_external_handle_import_info         (in_host_ptr);
+        result_ptr->set_imported_external_memory_handle_type(Anvil::ExternalMemoryHandleTypeFlagBits::HOST_ALLOCATION_BIT_EXT);
+    }
+
+end:
+    return result_ptr;
+}
+
 Anvil::MemoryBlockCreateInfoUniquePtr Anvil::MemoryBlockCreateInfo::create_regular(const Anvil::BaseDevice*  in_device_ptr,
                                                                                    uint32_t                  in_allowed_memory_bits,
                                                                                    VkDeviceSize              in_size,
@@ -175,7 +291,7 @@ Anvil::MemoryBlockCreateInfoUniquePtr Anvil::MemoryBlockCreateInfo::create_with_
         ANVIL_REDUNDANT_VARIABLE_CONST(device_features);
 
         /* check requested memory type features with requested features */
-        anvil_assert((device_features & in_memory_features) == in_memory_features);
+        anvil_assert((device_features & in_memory_features) == (in_memory_features & ~Anvil::MemoryFeatureFlagBits::PREFER_DEVICE_LOCAL_BIT) );
     }
 
     result_ptr.reset(
@@ -227,6 +343,7 @@ Anvil::MemoryBlockCreateInfo::MemoryBlockCreateInfo(const Anvil::MemoryBlockType
      m_mt_safety                               (Anvil::MTSafety::INHERIT_FROM_PARENT_DEVICE),
      m_on_release_callback_function            (in_on_release_callback_function),
      m_parent_memory_block_ptr                 (in_parent_memory_block_ptr),
+     m_persistently_mapped                     (false),
      m_size                                    (in_size),
      m_start_offset                            (in_start_offset),
      m_type                                    (in_type),
@@ -270,6 +387,43 @@ Anvil::MemoryBlockCreateInfo::MemoryBlockCreateInfo(const Anvil::MemoryBlockType
     }
 }
 
+/** Picks a memory type to import external memory with.
+ *
+ *  @param in_device_ptr             Device to use.
+ *  @param in_supported_memory_types Memory types the external memory can be imported with, restricted to those
+ *                                   the app allows.
+ *  @param in_memory_features        Required memory features.
+ *
+ *  @return Index of the first memory type which supports @param in_memory_features, or UINT32_MAX if none does.
+ **/
+uint32_t Anvil::MemoryBlockCreateInfo::get_imported_memory_type_index(const Anvil::BaseDevice*  in_device_ptr,
+                                                                      uint32_t                  in_supported_memory_types,
+                                                                      Anvil::MemoryFeatureFlags in_memory_features)
+{
+    uint32_t filtered_memory_types = 0;
+    uint32_t result                = UINT32_MAX;
+
+    if (!Anvil::MemoryAllocator::get_mem_types_supporting_mem_features(in_device_ptr,
+                                                                       in_supported_memory_types,
+                                                                       in_memory_features,
+                                                                      &filtered_memory_types) ||
+        filtered_memory_types == 0)
+    {
+        goto end;
+    }
+
+    result = 0;
+
+    while ((filtered_memory_types & (1 << 0)) == 0)
+    {
+        result                ++;
+        filtered_memory_types >>= 1;
+    }
+
+end:
+    return result;
+}
+
 Anvil::MemoryFeatureFlags Anvil::MemoryBlockCreateInfo::get_memory_features() const
 {
     if (m_parent_memory_block_ptr != nullptr)
@@ -0,0 +1,525 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/buffer_create_info.h"
+#include "misc/debug.h"
+#include "misc/memory_allocator.h"
+#include "misc/meshlet_builder.h"
+#include "wrappers/buffer.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+static const uint32_t g_invalid_local_index = UINT32_MAX;
+
+/* Cones whose triangle normals spread wider than this (in terms of the smallest dot product between any normal and the
+ * cone axis) are considered too wide to be of any use for culling. */
+static const float g_min_cone_normal_dot = 0.1f;
+
+
+/** Please see header for specification */
+Anvil::MeshletBuilder::MeshletBuilder(uint32_t in_max_vertices_per_meshlet,
+                                      uint32_t in_max_primitives_per_meshlet)
+    :m_max_primitives_per_meshlet(in_max_primitives_per_meshlet),
+     m_max_vertices_per_meshlet  (in_max_vertices_per_meshlet)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::MeshletBuilder::~MeshletBuilder()
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+bool Anvil::MeshletBuilder::build(const float*    in_positions_ptr,
+                                  uint32_t        in_n_vertices,
+                                  uint32_t        in_position_stride,
+                                  const uint32_t* in_indices_ptr,
+                                  uint32_t        in_n_indices)
+{
+    std::vector<uint32_t> adjacency_offsets;
+    std::vector<uint32_t> adjacency_triangles;
+    std::vector<uint32_t> live_triangle_counts;
+    std::vector<uint32_t> local_indices;
+    uint32_t              n_emitted_triangles  = 0;
+    const uint32_t        n_triangles          = in_n_indices / 3;
+    bool                  result               = false;
+    uint32_t              seed_triangle        = 0;
+    std::vector<bool>     triangle_emitted;
+
+    m_meshlets.clear         ();
+    m_primitive_indices.clear();
+    m_vertex_indices.clear   ();
+
+    if (in_positions_ptr == nullptr ||
+        in_indices_ptr   == nullptr)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (in_n_indices       == 0 ||
+        in_n_indices % 3   != 0 ||
+        in_position_stride <  sizeof(float) * 3)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    for (uint32_t n_index = 0;
+                  n_index < in_n_indices;
+                ++n_index)
+    {
+        if (in_indices_ptr[n_index] >= in_n_vertices)
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    /* Build vertex->triangle adjacency, so that candidate triangles can be found without scanning the whole index
+     * buffer for each meshlet. */
+    adjacency_offsets.resize   (in_n_vertices + 1,
+                                0);
+    live_triangle_counts.resize(in_n_vertices,
+                                0);
+
+    for (uint32_t n_index = 0;
+                  n_index < in_n_indices;
+                ++n_index)
+    {
+        ++live_triangle_counts[in_indices_ptr[n_index] ];
+    }
+
+    for (uint32_t n_vertex = 0;
+                  n_vertex < in_n_vertices;
+                ++n_vertex)
+    {
+        adjacency_offsets[n_vertex + 1] = adjacency_offsets[n_vertex] + live_triangle_counts[n_vertex];
+    }
+
+    {
+        std::vector<uint32_t> write_offsets(adjacency_offsets.begin(),
+                                            adjacency_offsets.end  () - 1);
+
+        adjacency_triangles.resize(in_n_indices);
+
+        for (uint32_t n_index = 0;
+                      n_index < in_n_indices;
+                    ++n_index)
+        {
+            adjacency_triangles[write_offsets[in_indices_ptr[n_index] ]++] = n_index / 3;
+        }
+    }
+
+    local_indices.resize   (in_n_vertices,
+                            g_invalid_local_index);
+    triangle_emitted.resize(n_triangles,
+                            false);
+
+    while (n_emitted_triangles < n_triangles)
+    {
+        Meshlet  new_meshlet;
+        uint32_t next_triangle = UINT32_MAX;
+
+        memset(&new_meshlet,
+               0,
+               sizeof(new_meshlet) );
+
+        new_meshlet.primitive_offset = static_cast<uint32_t>(m_primitive_indices.size() );
+        new_meshlet.vertex_offset    = static_cast<uint32_t>(m_vertex_indices.size   () );
+
+        while (triangle_emitted[seed_triangle])
+        {
+            ++seed_triangle;
+        }
+
+        next_triangle = seed_triangle;
+
+        while (next_triangle != UINT32_MAX)
+        {
+            uint32_t best_n_new_vertices = UINT32_MAX;
+            uint32_t best_valence        = UINT32_MAX;
+            uint32_t packed_primitive    = 0;
+
+            /* Append the triangle to the meshlet */
+            for (uint32_t n_corner = 0;
+                          n_corner < 3;
+                        ++n_corner)
+            {
+                const uint32_t vertex_index = in_indices_ptr[next_triangle * 3 + n_corner];
+
+                if (local_indices[vertex_index] == g_invalid_local_index)
+                {
+                    local_indices[vertex_index] = new_meshlet.n_vertices++;
+
+                    m_vertex_indices.push_back(vertex_index);
+                }
+
+                packed_primitive |= (local_indices[vertex_index] << (n_corner * 8) );
+
+                --live_triangle_counts[vertex_index];
+            }
+
+            m_primitive_indices.push_back(packed_primitive);
+
+            triangle_emitted[next_triangle] = true;
+            next_triangle                   = UINT32_MAX;
+
+            ++new_meshlet.n_primitives;
+            ++n_emitted_triangles;
+
+            if (new_meshlet.n_primitives == m_max_primitives_per_meshlet)
+            {
+                break;
+            }
+
+            /* Pick the adjacent triangle which needs the fewest new vertices. Ties are broken in favor of triangles whose
+             * vertices have fewer triangles left, so that the mesh is consumed from its borders inwards and fewer
+             * isolated triangles are left behind. */
+            for (uint32_t n_meshlet_vertex = 0;
+                          n_meshlet_vertex < new_meshlet.n_vertices;
+                        ++n_meshlet_vertex)
+            {
+                const uint32_t vertex_index = m_vertex_indices[new_meshlet.vertex_offset + n_meshlet_vertex];
+
+                for (uint32_t n_adjacency = adjacency_offsets[vertex_index];
+                              n_adjacency < adjacency_offsets[vertex_index + 1];
+                            ++n_adjacency)
+                {
+                    const uint32_t  candidate_triangle = adjacency_triangles[n_adjacency];
+                    const uint32_t* candidate_indices  = in_indices_ptr + candidate_triangle * 3;
+                    uint32_t        n_new_vertices     = 0;
+                    uint32_t        valence            = 0;
+
+                    if (triangle_emitted[candidate_triangle])
+                    {
+                        continue;
+                    }
+
+                    for (uint32_t n_corner = 0;
+                                  n_corner < 3;
+                                ++n_corner)
+                    {
+                        const bool is_duplicate = (n_corner > 0 && candidate_indices[n_corner] == candidate_indices[0]) ||
+                                                  (n_corner > 1 && candidate_indices[n_corner] == candidate_indices[1]);
+
+                        if (!is_duplicate                                                   &&
+                             local_indices[candidate_indices[n_corner] ] == g_invalid_local_index)
+                        {
+                            ++n_new_vertices;
+                        }
+
+                        valence += live_triangle_counts[candidate_indices[n_corner] ];
+                    }
+
+                    if (new_meshlet.n_vertices + n_new_vertices > m_max_vertices_per_meshlet)
+                    {
+                        continue;
+                    }
+
+                    if ( (n_new_vertices <  best_n_new_vertices)                            ||
+                         (n_new_vertices == best_n_new_vertices && valence < best_valence) )
+                    {
+                        best_n_new_vertices = n_new_vertices;
+                        best_valence        = valence;
+                        next_triangle       = candidate_triangle;
+                    }
+                }
+            }
+        }
+
+        for (uint32_t n_meshlet_vertex = 0;
+                      n_meshlet_vertex < new_meshlet.n_vertices;
+                    ++n_meshlet_vertex)
+        {
+            local_indices[m_vertex_indices[new_meshlet.vertex_offset + n_meshlet_vertex] ] = g_invalid_local_index;
+        }
+
+        calculate_bounds(in_positions_ptr,
+                         in_position_stride,
+                        &new_meshlet);
+
+        m_meshlets.push_back(new_meshlet);
+    }
+
+    result = true;
+end:
+    if (!result)
+    {
+        m_meshlets.clear         ();
+        m_primitive_indices.clear();
+        m_vertex_indices.clear   ();
+    }
+
+    return result;
+}
+
+/** Calculates the bounding sphere and the normal cone of the specified meshlet.
+ *
+ *  The sphere is centered at the meshlet's AABB center. The cone axis is the normalized average of the meshlet's
+ *  triangle normals. If the normals spread too wide for the cone to be useful, the cutoff is set to 1, which makes
+ *  the culling test documented in the header always fail.
+ **/
+void Anvil::MeshletBuilder::calculate_bounds(const float* in_positions_ptr,
+                                             uint32_t     in_position_stride,
+                                             Meshlet*     inout_meshlet_ptr) const
+{
+    float                  aabb_max[3]         = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    float                  aabb_min[3]         = { FLT_MAX,  FLT_MAX,  FLT_MAX};
+    float                  axis    [3]         = {0.0f,     0.0f,     0.0f};
+    float                  axis_length         = 0.0f;
+    float                  max_distance_sq     = 0.0f;
+    float                  min_dot             = 1.0f;
+    std::vector<float>     triangle_normals;
+    const uint32_t*        vertex_indices_ptr  = &m_vertex_indices[inout_meshlet_ptr->vertex_offset];
+
+    auto get_position = [&](uint32_t in_local_index) -> const float*
+    {
+        return reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(in_positions_ptr) + static_cast<size_t>(vertex_indices_ptr[in_local_index]) * in_position_stride);
+    };
+
+    /* Bounding sphere */
+    for (uint32_t n_vertex = 0;
+                  n_vertex < inout_meshlet_ptr->n_vertices;
+                ++n_vertex)
+    {
+        const float* position_ptr = get_position(n_vertex);
+
+        for (uint32_t n_component = 0;
+                      n_component < 3;
+                    ++n_component)
+        {
+            aabb_max[n_component] = std::max(aabb_max[n_component], position_ptr[n_component]);
+            aabb_min[n_component] = std::min(aabb_min[n_component], position_ptr[n_component]);
+        }
+    }
+
+    for (uint32_t n_component = 0;
+                  n_component < 3;
+                ++n_component)
+    {
+        inout_meshlet_ptr->bounding_sphere[n_component] = (aabb_max[n_component] + aabb_min[n_component]) * 0.5f;
+    }
+
+    for (uint32_t n_vertex = 0;
+                  n_vertex < inout_meshlet_ptr->n_vertices;
+                ++n_vertex)
+    {
+        const float* position_ptr = get_position(n_vertex);
+        const float  delta[3]     =
+        {
+            position_ptr[0] - inout_meshlet_ptr->bounding_sphere[0],
+            position_ptr[1] - inout_meshlet_ptr->bounding_sphere[1],
+            position_ptr[2] - inout_meshlet_ptr->bounding_sphere[2]
+        };
+
+        max_distance_sq = std::max(max_distance_sq,
+                                   delta[0] * delta[0] + delta[1] * delta[1] + delta[2] * delta[2]);
+    }
+
+    inout_meshlet_ptr->bounding_sphere[3] = sqrtf(max_distance_sq);
+
+    /* Normal cone */
+    triangle_normals.reserve(inout_meshlet_ptr->n_primitives * 3);
+
+    for (uint32_t n_primitive = 0;
+                  n_primitive < inout_meshlet_ptr->n_primitives;
+                ++n_primitive)
+    {
+        const uint32_t packed_primitive = m_primitive_indices[inout_meshlet_ptr->primitive_offset + n_primitive];
+        const float*   p0_ptr           = get_position( packed_primitive        & 0xFF);
+        const float*   p1_ptr           = get_position((packed_primitive >> 8)  & 0xFF);
+        const float*   p2_ptr           = get_position((packed_primitive >> 16) & 0xFF);
+        const float    e1[3]            = {p1_ptr[0] - p0_ptr[0], p1_ptr[1] - p0_ptr[1], p1_ptr[2] - p0_ptr[2]};
+        const float    e2[3]            = {p2_ptr[0] - p0_ptr[0], p2_ptr[1] - p0_ptr[1], p2_ptr[2] - p0_ptr[2]};
+        float          normal[3]        =
+        {
+            e1[1] * e2[2] - e1[2] * e2[1],
+            e1[2] * e2[0] - e1[0] * e2[2],
+            e1[0] * e2[1] - e1[1] * e2[0]
+        };
+        const float    normal_length    = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+        if (normal_length <= 0.0f)
+        {
+            /* Degenerate triangles never contribute to rasterization, so they need not constrain the cone */
+            continue;
+        }
+
+        for (uint32_t n_component = 0;
+                      n_component < 3;
+                    ++n_component)
+        {
+            normal[n_component] /= normal_length;
+            axis  [n_component] += normal[n_component];
+
+            triangle_normals.push_back(normal[n_component]);
+        }
+    }
+
+    axis_length = sqrtf(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+
+    if (axis_length <= 0.0f)
+    {
+        inout_meshlet_ptr->cone_axis_cutoff[0] = 0.0f;
+        inout_meshlet_ptr->cone_axis_cutoff[1] = 0.0f;
+        inout_meshlet_ptr->cone_axis_cutoff[2] = 0.0f;
+        inout_meshlet_ptr->cone_axis_cutoff[3] = 1.0f;
+
+        return;
+    }
+
+    for (uint32_t n_component = 0;
+                  n_component < 3;
+                ++n_component)
+    {
+        axis[n_component]                             /= axis_length;
+        inout_meshlet_ptr->cone_axis_cutoff[n_component] = axis[n_component];
+    }
+
+    for (uint32_t n_normal = 0;
+                  n_normal < static_cast<uint32_t>(triangle_normals.size() / 3);
+                ++n_normal)
+    {
+        const float* normal_ptr = &triangle_normals[n_normal * 3];
+
+        min_dot = std::min(min_dot,
+                           normal_ptr[0] * axis[0] + normal_ptr[1] * axis[1] + normal_ptr[2] * axis[2]);
+    }
+
+    inout_meshlet_ptr->cone_axis_cutoff[3] = (min_dot <= g_min_cone_normal_dot) ? 1.0f
+                                                                                 : sqrtf(1.0f - min_dot * min_dot);
+}
+
+/** Please see header for specification */
+Anvil::MeshletBuilderUniquePtr Anvil::MeshletBuilder::create(uint32_t in_max_vertices_per_meshlet,
+                                                             uint32_t in_max_primitives_per_meshlet)
+{
+    Anvil::MeshletBuilderUniquePtr result_ptr(nullptr,
+                                              std::default_delete<Anvil::MeshletBuilder>() );
+
+    /* Primitive indices are packed into 8 bits per corner */
+    if (in_max_vertices_per_meshlet   <  3   ||
+        in_max_vertices_per_meshlet   >  256 ||
+        in_max_primitives_per_meshlet == 0)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    result_ptr.reset(
+        new Anvil::MeshletBuilder(in_max_vertices_per_meshlet,
+                                  in_max_primitives_per_meshlet)
+    );
+
+end:
+    return result_ptr;
+}
+
+/** Please see header for specification */
+bool Anvil::MeshletBuilder::create_buffers(const Anvil::BaseDevice*  in_device_ptr,
+                                           Anvil::MemoryAllocator*   in_memory_allocator_ptr,
+                                           Anvil::MemoryFeatureFlags in_required_memory_features,
+                                           Anvil::BufferUniquePtr*   out_meshlet_buffer_ptr,
+                                           Anvil::BufferUniquePtr*   out_vertex_index_buffer_ptr,
+                                           Anvil::BufferUniquePtr*   out_primitive_index_buffer_ptr) const
+{
+    std::unique_ptr<std::vector<uint32_t> > data_vectors[3];
+    Anvil::BufferUniquePtr                  new_buffers [3];
+    bool                                    result = false;
+
+    if (in_device_ptr                  == nullptr ||
+        in_memory_allocator_ptr        == nullptr ||
+        out_meshlet_buffer_ptr         == nullptr ||
+        out_vertex_index_buffer_ptr    == nullptr ||
+        out_primitive_index_buffer_ptr == nullptr)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (m_meshlets.size() == 0)
+    {
+        /* build() has not been called, or it failed */
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    static_assert(sizeof(Meshlet) % sizeof(uint32_t) == 0,
+                  "Meshlet descriptors must be uint32-aligned");
+
+    data_vectors[0].reset(new std::vector<uint32_t>(m_meshlets.size() * sizeof(Meshlet) / sizeof(uint32_t) ) );
+    data_vectors[1].reset(new std::vector<uint32_t>(m_vertex_indices) );
+    data_vectors[2].reset(new std::vector<uint32_t>(m_primitive_indices) );
+
+    memcpy(&data_vectors[0]->at(0),
+           &m_meshlets.at(0),
+           m_meshlets.size() * sizeof(Meshlet) );
+
+    for (uint32_t n_buffer = 0;
+                  n_buffer < 3;
+                ++n_buffer)
+    {
+        auto create_info_ptr = Anvil::BufferCreateInfo::create_no_alloc(in_device_ptr,
+                                                                        data_vectors[n_buffer]->size() * sizeof(uint32_t),
+                                                                        Anvil::QueueFamilyFlagBits::GRAPHICS_BIT,
+                                                                        Anvil::SharingMode::EXCLUSIVE,
+                                                                        Anvil::BufferCreateFlagBits::NONE,
+                                                                        Anvil::BufferUsageFlagBits::STORAGE_BUFFER_BIT);
+
+        new_buffers[n_buffer] = Anvil::Buffer::create(std::move(create_info_ptr) );
+
+        if (new_buffers[n_buffer] == nullptr)
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        if (!in_memory_allocator_ptr->add_buffer_with_uint32_data_vector_ptr_based_post_fill(new_buffers[n_buffer].get(),
+                                                                                              std::move(data_vectors[n_buffer]),
+                                                                                              in_required_memory_features) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    *out_meshlet_buffer_ptr         = std::move(new_buffers[0]);
+    *out_vertex_index_buffer_ptr    = std::move(new_buffers[1]);
+    *out_primitive_index_buffer_ptr = std::move(new_buffers[2]);
+
+    result = true;
+end:
+    return result;
+}
@@ -0,0 +1,407 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/mgpu_work_splitter.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/device.h"
+#include <algorithm>
+
+
+/** Please see header for specification */
+Anvil::MGPUWorkSplitter::MGPUWorkSplitter(const Anvil::MGPUDevice* in_device_ptr,
+                                          Anvil::MGPUWorkSplitMode in_mode)
+    :m_device_ptr          (in_device_ptr),
+     m_mode                (in_mode),
+     m_min_split_ratio     (0.05f),
+     m_n_current_afr_device(in_device_ptr->get_n_physical_devices() - 1),
+     m_rebalance_damping   (0.5f),
+     m_reported_gpu_times  (in_device_ptr->get_n_physical_devices(), 0),
+     m_split_ratios        (in_device_ptr->get_n_physical_devices(), 1.0f / static_cast<float>(in_device_ptr->get_n_physical_devices() ))
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::MGPUWorkSplitter::~MGPUWorkSplitter()
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+void Anvil::MGPUWorkSplitter::begin_frame()
+{
+    if (m_mode == Anvil::MGPUWorkSplitMode::AFR)
+    {
+        /* begin_frame() advances to the next device before using it, so the first frame goes to device 0. */
+        m_n_current_afr_device = (m_n_current_afr_device + 1) % get_n_devices();
+    }
+    else
+    {
+        rebalance();
+    }
+}
+
+/** Please see header for specification */
+Anvil::MGPUWorkSplitterUniquePtr Anvil::MGPUWorkSplitter::create(const Anvil::MGPUDevice* in_device_ptr,
+                                                                 Anvil::MGPUWorkSplitMode in_mode)
+{
+    Anvil::MGPUWorkSplitterUniquePtr result_ptr(nullptr,
+                                                std::default_delete<Anvil::MGPUWorkSplitter>() );
+
+    anvil_assert(in_device_ptr != nullptr);
+
+    if (in_device_ptr->get_n_physical_devices() == 0  ||
+        in_device_ptr->get_n_physical_devices() >  32)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    result_ptr.reset(
+        new Anvil::MGPUWorkSplitter(in_device_ptr,
+                                    in_mode)
+    );
+
+end:
+    return result_ptr;
+}
+
+/** Please see header for specification */
+bool Anvil::MGPUWorkSplitter::get_sfr_composition_copies(uint32_t                   in_n_target_device,
+                                                         uint32_t                   in_memory_heap_idx,
+                                                         const VkRect2D&            in_render_area,
+                                                         const VkExtent2D*          in_opt_tile_size,
+                                                         std::vector<PeerCopyInfo>* out_result_ptr) const
+{
+    std::vector<VkRect2D>        bands;
+    bool                         result           (false);
+    const Anvil::PhysicalDevice* target_device_ptr(nullptr);
+
+    anvil_assert(out_result_ptr != nullptr);
+
+    if (in_n_target_device >= get_n_devices() )
+    {
+        anvil_assert(in_n_target_device < get_n_devices() );
+
+        goto end;
+    }
+
+    out_result_ptr->clear();
+
+    target_device_ptr = m_device_ptr->get_physical_device(in_n_target_device);
+
+    get_sfr_rects(in_render_area,
+                  in_opt_tile_size,
+                 &bands);
+
+    for (uint32_t n_src_device = 0;
+                  n_src_device < get_n_devices();
+                ++n_src_device)
+    {
+        PeerCopyInfo                  copy_info;
+        Anvil::PeerMemoryFeatureFlags push_features;
+        Anvil::PeerMemoryFeatureFlags pull_features;
+        const Anvil::PhysicalDevice*  src_device_ptr = m_device_ptr->get_physical_device(n_src_device);
+
+        if (n_src_device                         == in_n_target_device ||
+            bands.at(n_src_device).extent.height == 0)
+        {
+            continue;
+        }
+
+        copy_info.dst_device_index = in_n_target_device;
+        copy_info.rect             = bands.at(n_src_device);
+        copy_info.src_device_index = n_src_device;
+
+        /* Prefer to have the source device push the band, so that the target device can keep rendering. */
+        if (!m_device_ptr->get_peer_memory_features(src_device_ptr,
+                                                    target_device_ptr,
+                                                    in_memory_heap_idx,
+                                                   &push_features) ||
+            !m_device_ptr->get_peer_memory_features(target_device_ptr,
+                                                    src_device_ptr,
+                                                    in_memory_heap_idx,
+                                                   &pull_features) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        if ((push_features & Anvil::PeerMemoryFeatureFlagBits::COPY_DST_BIT) != 0)
+        {
+            copy_info.executing_device_index = n_src_device;
+        }
+        else
+        if ((pull_features & Anvil::PeerMemoryFeatureFlagBits::COPY_SRC_BIT) != 0)
+        {
+            copy_info.executing_device_index = in_n_target_device;
+        }
+        else
+        {
+            goto end;
+        }
+
+        out_result_ptr->push_back(copy_info);
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::MGPUWorkSplitter::get_sfr_rects(const VkRect2D&        in_render_area,
+                                            const VkExtent2D*      in_opt_tile_size,
+                                            std::vector<VkRect2D>* out_result_ptr) const
+{
+    std::vector<uint32_t> offsets;
+
+    anvil_assert(out_result_ptr != nullptr);
+
+    get_split_offsets(in_render_area.extent.height,
+                      (in_opt_tile_size != nullptr) ? in_opt_tile_size->height : 1,
+                     &offsets);
+
+    out_result_ptr->resize(get_n_devices() );
+
+    for (uint32_t n_device = 0;
+                  n_device < get_n_devices();
+                ++n_device)
+    {
+        auto& current_rect = out_result_ptr->at(n_device);
+
+        current_rect.extent.height = offsets.at(n_device + 1) - offsets.at(n_device);
+        current_rect.extent.width  = in_render_area.extent.width;
+        current_rect.offset.x      = in_render_area.offset.x;
+        current_rect.offset.y      = in_render_area.offset.y + static_cast<int32_t>(offsets.at(n_device) );
+    }
+}
+
+/** Splits [0, in_size) into one range per device, with sizes proportional to split ratios.
+ *
+ *  @param in_size        Total size to split.
+ *  @param in_alignment   Alignment of range boundaries. The last boundary is always equal to @param in_size.
+ *  @param out_result_ptr Deref will be set to get_n_devices() + 1 boundaries. Device N covers the range
+ *                        [out_result_ptr[N], out_result_ptr[N + 1]).
+ */
+void Anvil::MGPUWorkSplitter::get_split_offsets(uint32_t               in_size,
+                                                uint32_t               in_alignment,
+                                                std::vector<uint32_t>* out_result_ptr) const
+{
+    float    accumulated_ratio = 0.0f;
+    uint32_t alignment         = std::max(in_alignment, 1u);
+    uint32_t n_devices         = get_n_devices();
+
+    out_result_ptr->resize(n_devices + 1);
+
+    out_result_ptr->at(0)         = 0;
+    out_result_ptr->at(n_devices) = in_size;
+
+    for (uint32_t n_device = 1;
+                  n_device < n_devices;
+                ++n_device)
+    {
+        uint32_t boundary;
+
+        accumulated_ratio += m_split_ratios.at(n_device - 1);
+
+        boundary = static_cast<uint32_t>(static_cast<float>(in_size) * accumulated_ratio + 0.5f);
+        boundary = ((boundary + alignment / 2) / alignment) * alignment;
+        boundary = std::min(std::max(boundary, out_result_ptr->at(n_device - 1) ),
+                            in_size);
+
+        out_result_ptr->at(n_device) = boundary;
+    }
+}
+
+/** Moves split ratios towards the throughput each device has shown since the last call.
+ *
+ *  A device which was given a share of s and took t to process it is assumed to process work at a rate of s / t.
+ *  Target ratios are proportional to these rates.
+ */
+void Anvil::MGPUWorkSplitter::rebalance()
+{
+    const uint32_t     n_devices         (get_n_devices() );
+    float              ratio_sum         (0.0f);
+    std::vector<float> rates             (n_devices, 0.0f);
+    float              reported_ratio_sum(0.0f);
+    float              reported_rate_sum (0.0f);
+
+    /* Only devices which reported a time take part in the rebalance. The rest keep their share. */
+    for (uint32_t n_device = 0;
+                  n_device < n_devices;
+                ++n_device)
+    {
+        if (m_reported_gpu_times.at(n_device) == 0)
+        {
+            continue;
+        }
+
+        rates.at(n_device)  = m_split_ratios.at(n_device) / static_cast<float>(m_reported_gpu_times.at(n_device) );
+        reported_rate_sum  += rates.at(n_device);
+        reported_ratio_sum += m_split_ratios.at(n_device);
+    }
+
+    if (reported_rate_sum <= 0.0f)
+    {
+        goto end;
+    }
+
+    for (uint32_t n_device = 0;
+                  n_device < n_devices;
+                ++n_device)
+    {
+        float& ratio = m_split_ratios.at(n_device);
+
+        if (m_reported_gpu_times.at(n_device) != 0)
+        {
+            const float target_ratio = reported_ratio_sum * rates.at(n_device) / reported_rate_sum;
+
+            ratio += (target_ratio - ratio) * m_rebalance_damping;
+        }
+
+        ratio      = std::max(ratio, m_min_split_ratio);
+        ratio_sum += ratio;
+    }
+
+    for (auto& current_ratio : m_split_ratios)
+    {
+        current_ratio /= ratio_sum;
+    }
+
+end:
+    std::fill(m_reported_gpu_times.begin(),
+              m_reported_gpu_times.end(),
+              0);
+}
+
+/** Please see header for specification */
+bool Anvil::MGPUWorkSplitter::record_sfr_scissors(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                                  const VkRect2D&           in_render_area,
+                                                  const VkExtent2D*         in_opt_tile_size,
+                                                  uint32_t                  in_final_device_mask)
+{
+    std::vector<VkRect2D> bands;
+    bool                  result(false);
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+    anvil_assert(m_mode            == Anvil::MGPUWorkSplitMode::SFR);
+
+    get_sfr_rects(in_render_area,
+                  in_opt_tile_size,
+                 &bands);
+
+    for (uint32_t n_device = 0;
+                  n_device < get_n_devices();
+                ++n_device)
+    {
+        if (!in_cmd_buffer_ptr->record_set_device_mask_KHR(1u << n_device) ||
+            !in_cmd_buffer_ptr->record_set_scissor        (0, /* in_first_scissor */
+                                                           1, /* in_scissor_count */
+                                                          &bands.at(n_device) ))
+        {
+            goto end;
+        }
+    }
+
+    result = in_cmd_buffer_ptr->record_set_device_mask_KHR(in_final_device_mask);
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::MGPUWorkSplitter::record_split_dispatch(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                                    uint32_t                  in_n_groups_x,
+                                                    uint32_t                  in_n_groups_y,
+                                                    uint32_t                  in_n_groups_z,
+                                                    uint32_t                  in_final_device_mask)
+{
+    std::vector<uint32_t> offsets;
+    bool                  result(false);
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    get_split_offsets(in_n_groups_x,
+                      1, /* in_alignment */
+                     &offsets);
+
+    for (uint32_t n_device = 0;
+                  n_device < get_n_devices();
+                ++n_device)
+    {
+        const uint32_t n_device_groups_x = offsets.at(n_device + 1) - offsets.at(n_device);
+
+        if (n_device_groups_x == 0)
+        {
+            continue;
+        }
+
+        if (!in_cmd_buffer_ptr->record_set_device_mask_KHR(1u << n_device)         ||
+            !in_cmd_buffer_ptr->record_dispatch_base_KHR  (offsets.at(n_device), /* in_base_group_x */
+                                                           0,                    /* in_base_group_y */
+                                                           0,                    /* in_base_group_z */
+                                                           n_device_groups_x,
+                                                           in_n_groups_y,
+                                                           in_n_groups_z) )
+        {
+            goto end;
+        }
+    }
+
+    result = in_cmd_buffer_ptr->record_set_device_mask_KHR(in_final_device_mask);
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::MGPUWorkSplitter::report_device_gpu_time(uint32_t in_n_device,
+                                                     uint64_t in_duration_nsec)
+{
+    anvil_assert(in_n_device < get_n_devices() );
+
+    if (m_mode == Anvil::MGPUWorkSplitMode::SFR)
+    {
+        m_reported_gpu_times.at(in_n_device) = std::max(in_duration_nsec,
+                                                        static_cast<uint64_t>(1) );
+    }
+}
+
+/** Please see header for specification */
+void Anvil::MGPUWorkSplitter::set_min_split_ratio(float in_min_ratio)
+{
+    anvil_assert(in_min_ratio                                        >= 0.0f);
+    anvil_assert(in_min_ratio * static_cast<float>(get_n_devices() ) <= 1.0f);
+
+    m_min_split_ratio = in_min_ratio;
+}
+
+/** Please see header for specification */
+void Anvil::MGPUWorkSplitter::set_rebalance_damping(float in_damping)
+{
+    anvil_assert(in_damping >  0.0f &&
+                 in_damping <= 1.0f);
+
+    m_rebalance_damping = in_damping;
+}
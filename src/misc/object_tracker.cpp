@@ -30,7 +30,8 @@ static Anvil::ObjectTracker* object_tracker_ptr = nullptr;
 
 /** Constructor. */
 Anvil::ObjectTracker::ObjectTracker()
-    :CallbacksSupportProvider(OBJECT_TRACKER_CALLBACK_ID_COUNT)
+    :CallbacksSupportProvider(OBJECT_TRACKER_CALLBACK_ID_COUNT),
+     m_n_objects_allocated   (0)
 {
     /* Stub */
 }
@@ -57,14 +58,39 @@ Anvil::ObjectTracker* Anvil::ObjectTracker::get()
 /* Please see header for specification */
 void Anvil::ObjectTracker::check_for_leaks() const
 {
-    std::unique_lock<std::mutex> lock(m_cs);
+    std::map<Anvil::ObjectType, ObjectAllocations> object_allocations;
 
-    for (const auto& current_object_type_alloc_data : m_object_allocations)
+    /* Gather alive objects from all shards first, so that they can be reported in allocation order */
+    for (uint32_t n_shard = 0;
+                  n_shard < N_SHARDS;
+                ++n_shard)
+    {
+        std::unique_lock<std::mutex> lock(m_shards[n_shard].cs);
+
+        for (const auto& current_type_allocations : m_shards[n_shard].type_allocations)
+        {
+            auto& result_allocations = object_allocations[current_type_allocations.first];
+
+            result_allocations.insert(result_allocations.end(),
+                                      current_type_allocations.second.allocations.begin(),
+                                      current_type_allocations.second.allocations.end  () );
+        }
+    }
+
+    for (auto& current_object_type_alloc_data : object_allocations)
     {
         const uint32_t n_object_allocations = static_cast<uint32_t>(current_object_type_alloc_data.second.size() );
 
         if (n_object_allocations > 0)
         {
+            std::sort(current_object_type_alloc_data.second.begin(),
+                      current_object_type_alloc_data.second.end  (),
+                      [](const ObjectAllocation& in_a,
+                         const ObjectAllocation& in_b)
+                      {
+                          return in_a.n_allocation < in_b.n_allocation;
+                      });
+
             fprintf(stdout,
                     "The following %s instances have not been released:\n",
                     get_object_type_name(current_object_type_alloc_data.first) );
@@ -95,6 +121,7 @@ const char* Anvil::ObjectTracker::get_object_type_name(const Anvil::ObjectType&
 
     switch (in_object_type)
     {
+        case Anvil::ObjectType::ACCELERATION_STRUCTURE:     result_ptr = "Acceleration Structure";     break;
         case Anvil::ObjectType::BUFFER:                     result_ptr = "Buffer";                     break;
         case Anvil::ObjectType::BUFFER_VIEW:                result_ptr = "Buffer View";                break;
         case Anvil::ObjectType::COMMAND_BUFFER:             result_ptr = "Command Buffer";             break;
@@ -143,29 +170,65 @@ const char* Anvil::ObjectTracker::get_object_type_name(const Anvil::ObjectType&
 void* Anvil::ObjectTracker::get_object_at_index(const ObjectType& in_object_type,
                                                 uint32_t          in_alloc_index) const
 {
-    std::unique_lock<std::mutex> lock (m_cs);
-    void*                        result(nullptr);
+    void* result(nullptr);
 
-    if (m_object_allocations[in_object_type].size() > in_alloc_index)
+    for (uint32_t n_shard = 0;
+                  n_shard < N_SHARDS;
+                ++n_shard)
     {
-        result = m_object_allocations[in_object_type][in_alloc_index].object_ptr;
+        std::unique_lock<std::mutex> lock                    (m_shards[n_shard].cs);
+        auto                         type_allocations_iterator(m_shards[n_shard].type_allocations.find(in_object_type) );
+
+        if (type_allocations_iterator == m_shards[n_shard].type_allocations.end() )
+        {
+            continue;
+        }
+
+        const auto& allocations = type_allocations_iterator->second.allocations;
+
+        if (allocations.size() > in_alloc_index)
+        {
+            result = allocations[in_alloc_index].object_ptr;
+
+            break;
+        }
+
+        in_alloc_index -= static_cast<uint32_t>(allocations.size() );
     }
 
     return result;
 }
 
+/** Returns the shard which tracks @param in_object_ptr. */
+Anvil::ObjectTracker::Shard& Anvil::ObjectTracker::get_shard(const void* in_object_ptr) const
+{
+    /* Wrapper instances are heap-allocated, so the lowest bits of their addresses carry little information. */
+    const uintptr_t object_ptr_value = reinterpret_cast<uintptr_t>(in_object_ptr);
+    const uint32_t  n_shard          = static_cast<uint32_t>( (object_ptr_value >> 4) ^ (object_ptr_value >> 12) ) % N_SHARDS;
+
+    return m_shards[n_shard];
+}
+
 /* Please see header for specification */
 void Anvil::ObjectTracker::register_object(const ObjectType& in_object_type,
                                            void*             in_object_ptr)
 {
     anvil_assert(in_object_ptr != nullptr);
 
+    #if !defined(ANVIL_LEAN_RELEASE)
     {
-        std::unique_lock<std::mutex> lock(m_cs);
+        auto&                        shard           (get_shard(in_object_ptr) );
+        std::unique_lock<std::mutex> lock            (shard.cs);
+        auto&                        type_allocations(shard.type_allocations[in_object_type]);
+
+        anvil_assert(type_allocations.object_ptr_to_allocation_index_map.find(in_object_ptr) == type_allocations.object_ptr_to_allocation_index_map.end() );
 
-        m_object_allocations[in_object_type].push_back(ObjectAllocation(m_n_objects_allocated_array[in_object_type]++,
-                                                                        in_object_ptr) );
+        type_allocations.object_ptr_to_allocation_index_map[in_object_ptr] = static_cast<uint32_t>(type_allocations.allocations.size() );
+
+        type_allocations.allocations.push_back(ObjectAllocation(m_n_objects_allocated++,
+                                                                in_object_ptr) );
     }
+    #endif
 
     /* Notify any observers about the new object */
     OnObjectRegisteredCallbackArgument callback_arg(in_object_type,
@@ -184,6 +247,60 @@ void Anvil::ObjectTracker::register_object(const ObjectType& in_object_type,
     }
 }
 
+/** Stops tracking the allocation of @param in_object_ptr.
+ *
+ *  @return true if the object has been registered earlier, false otherwise. Always returns true if object
+ *          tracking has been compiled out.
+ */
+bool Anvil::ObjectTracker::release_allocation(const ObjectType& in_object_type,
+                                              void*             in_object_ptr)
+{
+    bool result = true;
+
+    #if !defined(ANVIL_LEAN_RELEASE)
+    {
+        auto&                        shard                    (get_shard(in_object_ptr) );
+        std::unique_lock<std::mutex> lock                     (shard.cs);
+        auto                         type_allocations_iterator(shard.type_allocations.find(in_object_type) );
+
+        result = false;
+
+        if (type_allocations_iterator != shard.type_allocations.end() )
+        {
+            auto& type_allocations = type_allocations_iterator->second;
+            auto  index_iterator   = type_allocations.object_ptr_to_allocation_index_map.find(in_object_ptr);
+
+            if (index_iterator != type_allocations.object_ptr_to_allocation_index_map.end() )
+            {
+                /* Move the last allocation into the released slot, so that the release does not need to shift
+                 * the remaining allocations. */
+                const uint32_t n_allocation = index_iterator->second;
+
+                if (n_allocation != type_allocations.allocations.size() - 1)
+                {
+                    const auto& moved_allocation = type_allocations.allocations.back();
+
+                    type_allocations.object_ptr_to_allocation_index_map[moved_allocation.object_ptr] = n_allocation;
+                    type_allocations.allocations[n_allocation]                                    = moved_allocation;
+                }
+
+                type_allocations.object_ptr_to_allocation_index_map.erase(index_iterator);
+                type_allocations.allocations.pop_back                    ();
+
+                result = true;
+            }
+        }
+    }
+    #else
+    {
+        ANVIL_REDUNDANT_ARGUMENT_CONST(in_object_type);
+        ANVIL_REDUNDANT_ARGUMENT_CONST(in_object_ptr);
+    }
+    #endif
+
+    return result;
+}
+
 /* Please see header for specification */
 void Anvil::ObjectTracker::unregister_object(const ObjectType& in_object_type,
                                              void*             in_object_ptr)
@@ -191,20 +308,12 @@ void Anvil::ObjectTracker::unregister_object(const ObjectType& in_object_type,
     OnObjectAboutToBeUnregisteredCallbackArgument callback_arg(in_object_type,
                                                                in_object_ptr);
 
+    if (!release_allocation(in_object_type,
+                            in_object_ptr) )
     {
-        std::unique_lock<std::mutex> lock                      (m_cs);
-        auto                         object_allocation_iterator(std::find(m_object_allocations[in_object_type].begin(),
-                                                                          m_object_allocations[in_object_type].end(),
-                                                                          in_object_ptr) );
-
-        if (object_allocation_iterator == m_object_allocations[in_object_type].end() )
-        {
-            anvil_assert_fail();
-
-            goto end;
-        }
+        anvil_assert_fail();
 
-        m_object_allocations[in_object_type].erase(object_allocation_iterator);
+        goto end;
     }
 
     /* Notify any observers about the event. */
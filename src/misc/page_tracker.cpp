@@ -24,16 +24,34 @@
 #include "misc/debug.h"
 #include "misc/page_tracker.h"
 
+
+namespace
+{
+    const uint32_t PAGES_PER_OCCUPANCY_ITEM = sizeof(uint32_t) * 8 /* bits in byte */;
+
+    /* Returns a mask with bits <in_n_first_bit, in_n_first_bit + in_n_bits> set. */
+    uint32_t get_bit_range_mask(uint32_t in_n_first_bit,
+                                uint32_t in_n_bits)
+    {
+        anvil_assert(in_n_bits                  >  0                        &&
+                     in_n_first_bit + in_n_bits <= PAGES_PER_OCCUPANCY_ITEM);
+
+        return (in_n_bits == PAGES_PER_OCCUPANCY_ITEM) ? ~0u
+                                                       : (((1u << in_n_bits) - 1) << in_n_first_bit);
+    }
+};
+
+
 /** Please see header for specification */
 Anvil::PageTracker::PageTracker(VkDeviceSize in_region_size,
                                 VkDeviceSize in_page_size)
-    :m_n_total_pages              (static_cast<uint32_t>(in_region_size / in_page_size) ),
+    :m_n_pages_with_memory_backing(0),
+     m_n_total_pages              (static_cast<uint32_t>(in_region_size / in_page_size) ),
      m_page_size                  (in_page_size),
-     m_n_pages_with_memory_backing(0),
      m_region_size                (in_region_size)
 {
     m_sparse_page_occupancy.resize(
-        1 + m_n_total_pages / (sizeof(uint32_t) * 8 /* bits in byte */)
+        1 + m_n_total_pages / PAGES_PER_OCCUPANCY_ITEM
     );
 
 }
@@ -43,7 +61,8 @@ Anvil::MemoryBlock* Anvil::PageTracker::get_memory_block(VkDeviceSize  in_start_
                                                          VkDeviceSize  in_size,
                                                          VkDeviceSize* out_memory_region_start_offset_ptr) const
 {
-    Anvil::MemoryBlock* result_ptr = nullptr;
+    MemoryBlockBindingMap::const_iterator binding_iterator;
+    Anvil::MemoryBlock*                   result_ptr       = nullptr;
 
     if (in_size > m_page_size)
     {
@@ -52,40 +71,122 @@ Anvil::MemoryBlock* Anvil::PageTracker::get_memory_block(VkDeviceSize  in_start_
         goto end;
     }
 
-    /* Handle the request */
-    for (const auto& current_memory_block : m_memory_blocks)
+    /* Find the last binding which starts at or before the requested offset. Bindings never overlap,
+     * so this is the only one which can cover the region. */
+    binding_iterator = m_memory_blocks.upper_bound(in_start_offset);
+
+    if (binding_iterator == m_memory_blocks.begin() )
     {
-        if (current_memory_block.start_offset                             <= in_start_offset           &&
-            current_memory_block.start_offset + current_memory_block.size >= in_start_offset + in_size)
-        {
-            result_ptr                          = current_memory_block.memory_block_ptr;
-            *out_memory_region_start_offset_ptr = in_start_offset - current_memory_block.start_offset;
+        goto end;
+    }
 
-            break;
-        }
+    --binding_iterator;
+
+    if (binding_iterator->second.start_offset + binding_iterator->second.size >= in_start_offset + in_size)
+    {
+        result_ptr                          = binding_iterator->second.memory_block_ptr;
+        *out_memory_region_start_offset_ptr = binding_iterator->second.memory_block_start_offset + (in_start_offset - binding_iterator->second.start_offset);
     }
 
 end:
     return result_ptr;
 }
 
+/** Please see header for specification */
+Anvil::MemoryBlock* Anvil::PageTracker::get_memory_block(uint32_t in_n_memory_block) const
+{
+    anvil_assert(in_n_memory_block < m_memory_blocks.size() );
+
+    return std::next(m_memory_blocks.begin(),
+                     in_n_memory_block)->second.memory_block_ptr;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::PageTracker::get_n_pages_with_memory_backing(VkDeviceSize in_start_offset,
+                                                             VkDeviceSize in_size) const
+{
+    uint32_t       n_current_page = static_cast<uint32_t>(in_start_offset / m_page_size);
+    const uint32_t n_end_page     = std::min(static_cast<uint32_t>((in_start_offset + in_size) / m_page_size),
+                                             m_n_total_pages);
+    uint32_t       result         = 0;
+
+    anvil_assert((in_start_offset % m_page_size) == 0);
+    anvil_assert(in_start_offset + in_size       <= m_region_size);
+
+    while (n_current_page < n_end_page)
+    {
+        const uint32_t n_bit    = n_current_page % PAGES_PER_OCCUPANCY_ITEM;
+        const uint32_t n_bits   = std::min(PAGES_PER_OCCUPANCY_ITEM - n_bit,
+                                           n_end_page               - n_current_page);
+        const uint32_t vec_item = m_sparse_page_occupancy[n_current_page / PAGES_PER_OCCUPANCY_ITEM].raw;
+
+        result         += Anvil::Utils::count_set_bits(vec_item & get_bit_range_mask(n_bit, n_bits) );
+        n_current_page += n_bits;
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::PageTracker::get_resident_ranges(VkDeviceSize                in_start_offset,
+                                             VkDeviceSize                in_size,
+                                             std::vector<ResidentRange>* out_result_ptr) const
+{
+    const VkDeviceSize                    end_offset       = in_start_offset + in_size;
+    MemoryBlockBindingMap::const_iterator binding_iterator = m_memory_blocks.upper_bound(in_start_offset);
+
+    out_result_ptr->clear();
+
+    /* The binding preceding the first one which starts after the requested offset may still cover the region */
+    if (binding_iterator != m_memory_blocks.begin() )
+    {
+        --binding_iterator;
+    }
+
+    for (;
+         binding_iterator                        != m_memory_blocks.end() &&
+         binding_iterator->second.start_offset   <  end_offset;
+       ++binding_iterator)
+    {
+        const VkDeviceSize range_start_offset = std::max(binding_iterator->second.start_offset,
+                                                         in_start_offset);
+        const VkDeviceSize range_end_offset   = std::min(binding_iterator->second.start_offset + binding_iterator->second.size,
+                                                         end_offset);
+
+        if (range_start_offset >= range_end_offset)
+        {
+            continue;
+        }
+
+        if (!out_result_ptr->empty()                                                         &&
+             out_result_ptr->back().start_offset + out_result_ptr->back().size == range_start_offset)
+        {
+            out_result_ptr->back().size += range_end_offset - range_start_offset;
+        }
+        else
+        {
+            out_result_ptr->push_back(ResidentRange(range_start_offset,
+                                                    range_end_offset - range_start_offset) );
+        }
+    }
+}
+
 /** Please see header for specification */
 bool Anvil::PageTracker::set_binding(MemoryBlock* in_memory_block_ptr,
                                      VkDeviceSize in_memory_block_start_offset,
                                      VkDeviceSize in_start_offset,
                                      VkDeviceSize in_size)
 {
-    const auto     end_offset_page_aligned    = Anvil::Utils::round_up(in_start_offset + in_size,
-                                                                       m_page_size);
-    uint32_t       n_pages;
-    uint32_t       occupancy_item_start_index;
-    const uint32_t pages_per_vec_item         = 32;
-    bool           result                     = false;
+    MemoryBlockBindingMap::iterator binding_iterator;
+    const auto                      end_offset              = in_start_offset + in_size;
+    const auto                      end_offset_page_aligned = Anvil::Utils::round_up(end_offset,
+                                                                                     m_page_size);
+    bool                            result                  = false;
 
     /* Sanity checks */
-    if (in_start_offset + in_size > m_region_size)
+    if (end_offset > m_region_size)
     {
-        anvil_assert(!(in_start_offset + in_size > m_region_size) );
+        anvil_assert(!(end_offset > m_region_size) );
 
         goto end;
     }
@@ -97,140 +198,151 @@ bool Anvil::PageTracker::set_binding(MemoryBlock* in_memory_block_ptr,
         goto end;
     }
 
-    if (((in_start_offset + in_size) % m_page_size) != 0              &&
-        end_offset_page_aligned                     != m_region_size)
+    if ((end_offset % m_page_size)  != 0              &&
+        end_offset_page_aligned     != m_region_size)
     {
-        anvil_assert(!((in_start_offset + in_size) % m_page_size) != 0              &&
-                       end_offset_page_aligned                    != m_region_size);
+        anvil_assert(!(end_offset % m_page_size) != 0              &&
+                       end_offset_page_aligned   != m_region_size);
 
         goto end;
     }
 
-    /* Store the memory block binding */
-    for (auto mem_binding_iterator  = m_memory_blocks.begin();
-              mem_binding_iterator != m_memory_blocks.end();
-            ++mem_binding_iterator)
+    if (in_size == 0)
     {
-        auto& mem_binding = *mem_binding_iterator;
+        result = true;
 
-        const bool does_not_overlap = (in_start_offset + in_size -1                    < mem_binding.start_offset || /* XXYY , X = new binding, Y = this binding */
-                                       mem_binding.start_offset + mem_binding.size - 1 < in_start_offset);           /* YYXX */
+        goto end;
+    }
 
-        if (does_not_overlap)
-        {
-            continue;
-        }
+    /* Locate the first binding which overlaps with the new one. That's either the last binding starting
+     * at or before @param in_start_offset, or the first one starting after it. */
+    binding_iterator = m_memory_blocks.upper_bound(in_start_offset);
 
-        /* There are four cases we need to handle separately :
-         *
-         * 1)  ###      - The new block _ interleaves with current memory block # from the left side.
-         *    __          Need to truncate # from the left side.
-         *
-         * 2)  ###      - The new block _ splits current memory block # in half.
-         *      _         Need to split # to two separate memory blocks.
-         *
-         * 3)  ###      - The new block _ interleaves with current memory block # from the right side.
-         *       __       Need to truncate # from the right side.
-         *
-         * 4)  ###      - The new block _ is going to be completely overwritten by _
-         *    _____       Need to remove it.
-         */
-        if ( in_start_offset            <=  mem_binding.start_offset                     &&
-             in_start_offset            <  (mem_binding.start_offset + mem_binding.size) &&
-            (in_start_offset + in_size) >=  mem_binding.start_offset                     &&
-            (in_start_offset + in_size) <  (mem_binding.start_offset + mem_binding.size) )
-        {
-            /* Case 1 */
-            mem_binding.size         -= in_start_offset + in_size - (mem_binding.start_offset);
-            mem_binding.start_offset  = in_start_offset + in_size;
-        }
-        else
-        if ( in_start_offset            >  mem_binding.start_offset                     &&
-             in_start_offset            < (mem_binding.start_offset + mem_binding.size) &&
-            (in_start_offset + in_size) >  mem_binding.start_offset                     &&
-            (in_start_offset + in_size) < (mem_binding.start_offset + mem_binding.size))
+    if (binding_iterator != m_memory_blocks.begin() )
+    {
+        auto prev_binding_iterator = std::prev(binding_iterator);
+
+        if (prev_binding_iterator->second.start_offset + prev_binding_iterator->second.size > in_start_offset)
         {
-            /* Case 2 */
-            MemoryBlockBinding left_half (mem_binding.memory_block_ptr,
-                                          mem_binding.memory_block_start_offset,
-                                          in_start_offset - mem_binding.start_offset, /* in_size         */
-                                          mem_binding.start_offset);                  /* in_start_offset */
-            MemoryBlockBinding right_half(mem_binding.memory_block_ptr,
-                                          mem_binding.memory_block_start_offset,
-                                          mem_binding.start_offset + mem_binding.size - (in_start_offset + in_size) + 1, /* in_size         */
-                                          in_start_offset + in_size);                                                    /* in_start_offset */
-
-            m_memory_blocks.push_back(left_half);
-            m_memory_blocks.push_back(right_half);
-
-            m_memory_blocks.erase(mem_binding_iterator);
+            binding_iterator = prev_binding_iterator;
         }
-        else
-        if ( in_start_offset            >  mem_binding.start_offset                     &&
-             in_start_offset            > (mem_binding.start_offset + mem_binding.size) &&
-            (in_start_offset + in_size) >  mem_binding.start_offset                     &&
-            (in_start_offset + in_size) > (mem_binding.start_offset + mem_binding.size) )
+    }
+
+    /* Cut the new binding's region out of all existing bindings it overlaps with. Only the first and
+     * the last of these can survive partially: the former on the left side, the latter on the right side. */
+    while (binding_iterator                      != m_memory_blocks.end() &&
+           binding_iterator->second.start_offset <  end_offset)
+    {
+        const MemoryBlockBinding overlapping_binding = binding_iterator->second;
+        const auto               binding_end_offset  = overlapping_binding.start_offset + overlapping_binding.size;
+
+        binding_iterator = m_memory_blocks.erase(binding_iterator);
+
+        if (overlapping_binding.start_offset < in_start_offset)
         {
-            /* Case 3 */
-            mem_binding.size = (mem_binding.start_offset + mem_binding.size) - in_start_offset + 1;
+            m_memory_blocks.emplace_hint(binding_iterator,
+                                         overlapping_binding.start_offset,
+                                         MemoryBlockBinding(overlapping_binding.memory_block_ptr,
+                                                            overlapping_binding.memory_block_start_offset,
+                                                            in_start_offset - overlapping_binding.start_offset, /* in_size         */
+                                                            overlapping_binding.start_offset) );                /* in_start_offset */
         }
-        else
+
+        if (binding_end_offset > end_offset)
         {
-            /* Must be case 4 */
-            anvil_assert( in_start_offset            <=  mem_binding.start_offset                     &&
-                         (in_start_offset + in_size) >= (mem_binding.start_offset + mem_binding.size) );
+            binding_iterator = m_memory_blocks.emplace_hint(binding_iterator,
+                                                            end_offset,
+                                                            MemoryBlockBinding(overlapping_binding.memory_block_ptr,
+                                                                               overlapping_binding.memory_block_start_offset + (end_offset - overlapping_binding.start_offset),
+                                                                               binding_end_offset - end_offset, /* in_size         */
+                                                                               end_offset) );                   /* in_start_offset */
 
-            m_memory_blocks.erase(mem_binding_iterator);
+            break;
         }
-
-        /* No more than one memory binding can be assigned to the same memory region */
-        break;
     }
 
-    m_memory_blocks.push_back(
-        MemoryBlockBinding(
-            in_memory_block_ptr,
-            in_memory_block_start_offset,
-            in_size,
-            in_start_offset)
-        );
-
-    /* Update page occupancy info */
-    n_pages                    = static_cast<uint32_t>(in_size         / m_page_size);
-    occupancy_item_start_index = static_cast<uint32_t>(in_start_offset / m_page_size);
-
-    /* TODO: Perf of the code below could definitely be improved */
-    for (uint32_t n_page = 0;
-                  n_page < n_pages;
-                ++n_page)
+    /* Store the new binding, coalescing it with its neighbours if they are backed by contiguous
+     * regions of the same memory block. Unbound regions are not stored at all. */
+    if (in_memory_block_ptr != nullptr)
     {
-        const uint32_t occupancy_item_index = (occupancy_item_start_index + n_page) % pages_per_vec_item;
-        const uint32_t occupancy_vec_index  = (occupancy_item_start_index + n_page) / pages_per_vec_item;
-        const uint32_t n_page_mask          = m_sparse_page_occupancy[occupancy_vec_index].raw & (1 << occupancy_item_index);
+        MemoryBlockBinding new_binding(in_memory_block_ptr,
+                                       in_memory_block_start_offset,
+                                       in_size,
+                                       in_start_offset);
 
-        /* Change the number of memory-backed pages only if a bit would be flipped */
-        if (in_memory_block_ptr != nullptr)
+        if (binding_iterator != m_memory_blocks.begin() )
         {
-            if (n_page_mask == 0)
+            auto prev_binding_iterator = std::prev(binding_iterator);
+
+            const auto& prev_binding = prev_binding_iterator->second;
+
+            if (prev_binding.memory_block_ptr                              == in_memory_block_ptr &&
+                prev_binding.start_offset              + prev_binding.size == in_start_offset     &&
+                prev_binding.memory_block_start_offset + prev_binding.size == in_memory_block_start_offset)
             {
-                m_sparse_page_occupancy[occupancy_vec_index].raw |= (1 << occupancy_item_index);
+                new_binding.memory_block_start_offset = prev_binding.memory_block_start_offset;
+                new_binding.size                     += prev_binding.size;
+                new_binding.start_offset              = prev_binding.start_offset;
 
-                ++m_n_pages_with_memory_backing;
+                m_memory_blocks.erase(prev_binding_iterator);
             }
         }
-        else
+
+        if (binding_iterator                                   != m_memory_blocks.end()                                 &&
+            binding_iterator->second.memory_block_ptr          == in_memory_block_ptr                                   &&
+            binding_iterator->second.start_offset              == end_offset                                            &&
+            binding_iterator->second.memory_block_start_offset == in_memory_block_start_offset + in_size)
         {
-            if (n_page_mask != 0)
-            {
-                m_sparse_page_occupancy[occupancy_vec_index].raw &= ~(1 << occupancy_item_index);
+            new_binding.size += binding_iterator->second.size;
 
-                --m_n_pages_with_memory_backing;
-            }
+            binding_iterator = m_memory_blocks.erase(binding_iterator);
         }
+
+        m_memory_blocks.emplace_hint(binding_iterator,
+                                     new_binding.start_offset,
+                                     new_binding);
     }
 
+    /* Update page occupancy info */
+    update_page_occupancy(static_cast<uint32_t>(in_start_offset / m_page_size),
+                          static_cast<uint32_t>(in_size         / m_page_size),
+                          (in_memory_block_ptr != nullptr) );
+
     anvil_assert(m_n_pages_with_memory_backing <= m_n_total_pages);
     result = true;
 end:
     return result;
-}
\ No newline at end of file
+}
+
+/** Please see header for specification */
+void Anvil::PageTracker::update_page_occupancy(uint32_t in_n_first_page,
+                                               uint32_t in_n_pages,
+                                               bool     in_has_memory_backing)
+{
+    uint32_t       n_current_page = in_n_first_page;
+    const uint32_t n_end_page     = in_n_first_page + in_n_pages;
+
+    while (n_current_page < n_end_page)
+    {
+        const uint32_t n_bit      = n_current_page % PAGES_PER_OCCUPANCY_ITEM;
+        const uint32_t n_bits     = std::min(PAGES_PER_OCCUPANCY_ITEM - n_bit,
+                                             n_end_page               - n_current_page);
+        const uint32_t mask       = get_bit_range_mask(n_bit, n_bits);
+        auto&          vec_item   = m_sparse_page_occupancy[n_current_page / PAGES_PER_OCCUPANCY_ITEM].raw;
+        const uint32_t n_set_bits = Anvil::Utils::count_set_bits(vec_item & mask);
+
+        /* Change the number of memory-backed pages only by the number of bits which are going to be flipped */
+        if (in_has_memory_backing)
+        {
+            m_n_pages_with_memory_backing += n_bits - n_set_bits;
+            vec_item                      |= mask;
+        }
+        else
+        {
+            m_n_pages_with_memory_backing -= n_set_bits;
+            vec_item                      &= ~mask;
+        }
+
+        n_current_page += n_bits;
+    }
+}
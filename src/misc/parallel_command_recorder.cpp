@@ -0,0 +1,365 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/parallel_command_recorder.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/command_pool.h"
+#include "wrappers/device.h"
+#include "wrappers/fence.h"
+#include <algorithm>
+
+
+/** Please see header for specification */
+Anvil::ParallelCommandRecorder::ParallelCommandRecorder(Anvil::BaseDevice* in_device_ptr,
+                                                        uint32_t           in_queue_family_index,
+                                                        uint32_t           in_n_frames_in_flight,
+                                                        uint32_t           in_n_threads)
+    :m_device_ptr        (in_device_ptr),
+     m_frame_fences      (in_n_frames_in_flight,
+                          nullptr),
+     m_n_current_frame   (0),
+     m_queue_family_index(in_queue_family_index),
+     m_should_quit       (false)
+{
+    /* Frame slots need to be in place before the worker threads start running */
+    m_frames.resize(in_n_threads);
+
+    for (auto& current_thread_frames : m_frames)
+    {
+        current_thread_frames.resize(in_n_frames_in_flight);
+    }
+
+    m_threads.reserve(in_n_threads);
+
+    for (uint32_t n_thread = 0;
+                  n_thread < in_n_threads;
+                ++n_thread)
+    {
+        m_threads.push_back(
+            std::thread(&Anvil::ParallelCommandRecorder::thread_main,
+                        this,
+                        n_thread)
+        );
+    }
+}
+
+/** Please see header for specification */
+Anvil::ParallelCommandRecorder::~ParallelCommandRecorder()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_should_quit = true;
+
+        m_wake_cv.notify_all();
+    }
+
+    for (auto& current_thread : m_threads)
+    {
+        if (current_thread.joinable() )
+        {
+            current_thread.join();
+        }
+    }
+
+    /* Command buffers must go out of scope before their parent pool does. */
+    for (auto& current_thread_frames : m_frames)
+    {
+        for (auto& current_frame : current_thread_frames)
+        {
+            current_frame.cmd_buffers.clear    ();
+            current_frame.command_pool_ptr.reset();
+        }
+    }
+}
+
+/** Please see header for specification */
+bool Anvil::ParallelCommandRecorder::begin_frame(Anvil::Fence* in_opt_fence_ptr)
+{
+    bool result = false;
+
+    m_n_current_frame = (m_n_current_frame + 1) % static_cast<uint32_t>(m_frame_fences.size() );
+
+    /* Make sure the GPU is done with the command buffers recorded the last time the slot was used */
+    if (m_frame_fences.at(m_n_current_frame) != nullptr)
+    {
+        const VkResult result_vk = m_device_ptr->get_dispatch_table().vkWaitForFences(m_device_ptr->get_device_vk(),
+                                                                                      1, /* fenceCount */
+                                                                                      m_frame_fences.at(m_n_current_frame)->get_fence_ptr(),
+                                                                                      VK_TRUE,     /* waitAll */
+                                                                                      UINT64_MAX); /* timeout */
+
+        if (!is_vk_call_successful(result_vk) )
+        {
+            anvil_assert_vk_call_succeeded(result_vk);
+
+            goto end;
+        }
+    }
+
+    m_frame_fences.at(m_n_current_frame) = in_opt_fence_ptr;
+
+    /* Worker threads are idle in-between record() calls, so their pools can be safely reset from this thread. */
+    for (auto& current_thread_frames : m_frames)
+    {
+        auto& current_frame = current_thread_frames.at(m_n_current_frame);
+
+        if (current_frame.n_used_cmd_buffers > 0)
+        {
+            if (!current_frame.command_pool_ptr->reset(false) ) /* in_release_resources */
+            {
+                anvil_assert_fail();
+
+                goto end;
+            }
+        }
+
+        current_frame.n_used_cmd_buffers = 0;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::ParallelCommandRecorderUniquePtr Anvil::ParallelCommandRecorder::create(Anvil::BaseDevice* in_device_ptr,
+                                                                               uint32_t           in_queue_family_index,
+                                                                               uint32_t           in_n_frames_in_flight,
+                                                                               uint32_t           in_n_threads)
+{
+    Anvil::ParallelCommandRecorderUniquePtr result_ptr(nullptr,
+                                                       std::default_delete<Anvil::ParallelCommandRecorder>() );
+    uint32_t                                n_threads = in_n_threads;
+
+    anvil_assert(in_device_ptr         != nullptr);
+    anvil_assert(in_n_frames_in_flight >  0);
+
+    if (n_threads == 0)
+    {
+        n_threads = std::max(std::thread::hardware_concurrency(),
+                             1u);
+    }
+
+    result_ptr.reset(
+        new Anvil::ParallelCommandRecorder(in_device_ptr,
+                                           in_queue_family_index,
+                                           in_n_frames_in_flight,
+                                           n_threads)
+    );
+
+    return result_ptr;
+}
+
+/** Returns a secondary command buffer in the initial state, allocated from the specified frame slot's pool.
+ *  The pool is created on first use. Must only be called from the worker thread which owns the slot.
+ *
+ *  @param in_frame_ptr Frame slot to use. Must not be null.
+ *
+ *  @return Requested command buffer or null, if the call failed.
+ */
+Anvil::SecondaryCommandBuffer* Anvil::ParallelCommandRecorder::get_cmd_buffer(Frame* in_frame_ptr)
+{
+    Anvil::SecondaryCommandBuffer* result_ptr = nullptr;
+
+    if (in_frame_ptr->command_pool_ptr == nullptr)
+    {
+        /* Pools are only ever accessed by the thread which owns them, or when all workers are idle. Command buffers
+         * are never reset individually, so RESET_COMMAND_BUFFER is not needed. */
+        in_frame_ptr->command_pool_ptr = Anvil::CommandPool::create(m_device_ptr,
+                                                                    Anvil::CommandPoolCreateFlagBits::CREATE_TRANSIENT_BIT,
+                                                                    m_queue_family_index,
+                                                                    Anvil::MTSafety::DISABLED);
+
+        if (in_frame_ptr->command_pool_ptr == nullptr)
+        {
+            anvil_assert(in_frame_ptr->command_pool_ptr != nullptr);
+
+            goto end;
+        }
+    }
+
+    if (in_frame_ptr->n_used_cmd_buffers == in_frame_ptr->cmd_buffers.size() )
+    {
+        auto new_cmd_buffer_ptr = in_frame_ptr->command_pool_ptr->alloc_secondary_level_command_buffer();
+
+        if (new_cmd_buffer_ptr == nullptr)
+        {
+            anvil_assert(new_cmd_buffer_ptr != nullptr);
+
+            goto end;
+        }
+
+        in_frame_ptr->cmd_buffers.push_back(std::move(new_cmd_buffer_ptr) );
+    }
+
+    result_ptr = in_frame_ptr->cmd_buffers.at(in_frame_ptr->n_used_cmd_buffers++).get();
+end:
+    return result_ptr;
+}
+
+/** Please see header for specification */
+bool Anvil::ParallelCommandRecorder::record(Anvil::PrimaryCommandBuffer*       in_cmd_buffer_ptr,
+                                            Anvil::Framebuffer*                in_framebuffer_ptr,
+                                            Anvil::RenderPass*                 in_render_pass_ptr,
+                                            Anvil::SubPassID                   in_subpass_id,
+                                            uint32_t                           in_n_jobs,
+                                            RecordCallback                     in_callback,
+                                            Anvil::OcclusionQuerySupportScope  in_required_occlusion_query_support_scope,
+                                            bool                               in_occlusion_query_used_by_primary,
+                                            Anvil::QueryPipelineStatisticFlags in_required_pipeline_statistics_scope)
+{
+    std::vector<Anvil::SecondaryCommandBuffer*> cmd_buffers;
+    bool                                        result      = false;
+
+    anvil_assert(in_cmd_buffer_ptr  != nullptr);
+    anvil_assert(in_render_pass_ptr != nullptr);
+    anvil_assert(in_callback        != nullptr);
+
+    if (in_n_jobs == 0)
+    {
+        result = true;
+
+        goto end;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_batch.callback                               = std::move(in_callback);
+        m_batch.framebuffer_ptr                        = in_framebuffer_ptr;
+        m_batch.has_failed                             = false;
+        m_batch.n_jobs_finished                        = 0;
+        m_batch.n_next_job                             = 0;
+        m_batch.occlusion_query_used_by_primary        = in_occlusion_query_used_by_primary;
+        m_batch.render_pass_ptr                        = in_render_pass_ptr;
+        m_batch.required_occlusion_query_support_scope = in_required_occlusion_query_support_scope;
+        m_batch.required_pipeline_statistics_scope     = in_required_pipeline_statistics_scope;
+        m_batch.subpass_id                             = in_subpass_id;
+
+        m_batch.cmd_buffers.assign(in_n_jobs,
+                                   nullptr);
+
+        m_wake_cv.notify_all();
+
+        while (m_batch.n_jobs_finished != in_n_jobs)
+        {
+            m_done_cv.wait(lock);
+        }
+
+        if (m_batch.has_failed)
+        {
+            anvil_assert(!m_batch.has_failed);
+        }
+        else
+        {
+            cmd_buffers = std::move(m_batch.cmd_buffers);
+        }
+
+        /* Release anything captured by the callback now, rather than when the next batch comes in */
+        m_batch.callback = nullptr;
+        m_batch.cmd_buffers.clear();
+    }
+
+    if (cmd_buffers.size() != in_n_jobs)
+    {
+        goto end;
+    }
+
+    result = in_cmd_buffer_ptr->record_execute_commands(in_n_jobs,
+                                                       &cmd_buffers.at(0) );
+end:
+    return result;
+}
+
+/** Entry-point for the worker threads. Picks up jobs of the current batch until the recorder is released.
+ *
+ *  @param in_n_thread Index of the worker thread. Used to select the thread's command pools.
+ */
+void Anvil::ParallelCommandRecorder::thread_main(uint32_t in_n_thread)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true)
+    {
+        Anvil::SecondaryCommandBuffer* cmd_buffer_ptr = nullptr;
+        Frame*                         frame_ptr      = nullptr;
+        bool                           job_result     = false;
+        uint32_t                       n_job;
+
+        if (m_batch.n_next_job >= m_batch.cmd_buffers.size() )
+        {
+            if (m_should_quit)
+            {
+                break;
+            }
+
+            m_wake_cv.wait(lock);
+
+            continue;
+        }
+
+        n_job     = m_batch.n_next_job++;
+        frame_ptr = &m_frames.at(in_n_thread).at(m_n_current_frame);
+
+        lock.unlock();
+        {
+            cmd_buffer_ptr = get_cmd_buffer(frame_ptr);
+
+            if (cmd_buffer_ptr != nullptr)
+            {
+                if (cmd_buffer_ptr->start_recording(true,  /* in_one_time_submit          */
+                                                    false, /* in_simultaneous_use_allowed */
+                                                    true,  /* in_renderpass_usage_only    */
+                                                    m_batch.framebuffer_ptr,
+                                                    m_batch.render_pass_ptr,
+                                                    m_batch.subpass_id,
+                                                    m_batch.required_occlusion_query_support_scope,
+                                                    m_batch.occlusion_query_used_by_primary,
+                                                    m_batch.required_pipeline_statistics_scope) )
+                {
+                    job_result = m_batch.callback(cmd_buffer_ptr,
+                                                  n_job);
+
+                    if (!cmd_buffer_ptr->stop_recording() )
+                    {
+                        job_result = false;
+                    }
+                }
+            }
+        }
+        lock.lock();
+
+        m_batch.cmd_buffers.at(n_job) = cmd_buffer_ptr;
+
+        if (!job_result)
+        {
+            m_batch.has_failed = true;
+        }
+
+        if (++m_batch.n_jobs_finished == m_batch.cmd_buffers.size() )
+        {
+            m_done_cv.notify_all();
+        }
+    }
+}
@@ -0,0 +1,230 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "misc/buffer_create_info.h"
+#include "misc/debug.h"
+#include "misc/image_create_info.h"
+#include "misc/peer_copy.h"
+#include "wrappers/buffer.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/device.h"
+#include "wrappers/image.h"
+
+
+/** Tells whether @param in_n_executing_device is a valid physical device index for @param in_device_ptr.
+ *
+ *  @return true if the device is a mGPU device and the index is in range, false otherwise.
+ **/
+bool Anvil::PeerCopy::is_executing_device_valid(const Anvil::BaseDevice* in_device_ptr,
+                                                uint32_t                 in_n_executing_device)
+{
+    const Anvil::MGPUDevice* mgpu_device_ptr = dynamic_cast<const Anvil::MGPUDevice*>(in_device_ptr);
+
+    return (mgpu_device_ptr       != nullptr                                    &&
+            in_n_executing_device <  mgpu_device_ptr->get_n_physical_devices() );
+}
+
+/** Please see header for specification */
+bool Anvil::PeerCopy::record_buffer_copy(Anvil::CommandBufferBase*  in_cmd_buffer_ptr,
+                                         uint32_t                   in_n_executing_device,
+                                         Anvil::Buffer*             in_src_buffer_ptr,
+                                         Anvil::Buffer*             in_dst_buffer_ptr,
+                                         uint32_t                   in_n_regions,
+                                         const Anvil::BufferCopy*   in_regions_ptr,
+                                         Anvil::PipelineStageFlags  in_dst_stage_mask,
+                                         Anvil::AccessFlags         in_dst_access_mask,
+                                         uint32_t                   in_final_device_mask)
+{
+    bool result = false;
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+    anvil_assert(in_dst_buffer_ptr != nullptr);
+    anvil_assert(in_regions_ptr    != nullptr);
+    anvil_assert(in_src_buffer_ptr != nullptr);
+
+    if (!is_executing_device_valid(in_src_buffer_ptr->get_create_info_ptr()->get_device(),
+                                   in_n_executing_device) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    {
+        const Anvil::BufferBarrier pre_copy_barriers[] =
+        {
+            Anvil::BufferBarrier(Anvil::AccessFlagBits::MEMORY_WRITE_BIT,
+                                 Anvil::AccessFlagBits::TRANSFER_READ_BIT,
+                                 VK_QUEUE_FAMILY_IGNORED,
+                                 VK_QUEUE_FAMILY_IGNORED,
+                                 in_src_buffer_ptr,
+                                 0, /* in_offset */
+                                 VK_WHOLE_SIZE),
+            Anvil::BufferBarrier(Anvil::AccessFlagBits::MEMORY_READ_BIT | Anvil::AccessFlagBits::MEMORY_WRITE_BIT,
+                                 Anvil::AccessFlagBits::TRANSFER_WRITE_BIT,
+                                 VK_QUEUE_FAMILY_IGNORED,
+                                 VK_QUEUE_FAMILY_IGNORED,
+                                 in_dst_buffer_ptr,
+                                 0, /* in_offset */
+                                 VK_WHOLE_SIZE)
+        };
+        const Anvil::BufferBarrier post_copy_barrier(Anvil::AccessFlagBits::TRANSFER_WRITE_BIT,
+                                                     in_dst_access_mask,
+                                                     VK_QUEUE_FAMILY_IGNORED,
+                                                     VK_QUEUE_FAMILY_IGNORED,
+                                                     in_dst_buffer_ptr,
+                                                     0, /* in_offset */
+                                                     VK_WHOLE_SIZE);
+
+        if (!in_cmd_buffer_ptr->record_set_device_mask_KHR(1u << in_n_executing_device) )
+        {
+            goto end;
+        }
+
+        if (!in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT,
+                                                        Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                        Anvil::DependencyFlagBits::NONE,
+                                                        0,       /* in_memory_barrier_count */
+                                                        nullptr, /* in_memory_barriers_ptr  */
+                                                        sizeof(pre_copy_barriers) / sizeof(pre_copy_barriers[0]),
+                                                        pre_copy_barriers,
+                                                        0,       /* in_image_memory_barrier_count */
+                                                        nullptr  /* in_image_memory_barriers_ptr  */) ||
+            !in_cmd_buffer_ptr->record_copy_buffer     (in_src_buffer_ptr,
+                                                        in_dst_buffer_ptr,
+                                                        in_n_regions,
+                                                        in_regions_ptr)                                ||
+            !in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                        in_dst_stage_mask,
+                                                        Anvil::DependencyFlagBits::NONE,
+                                                        0,       /* in_memory_barrier_count */
+                                                        nullptr, /* in_memory_barriers_ptr  */
+                                                        1,       /* in_buffer_memory_barrier_count */
+                                                       &post_copy_barrier,
+                                                        0,       /* in_image_memory_barrier_count */
+                                                        nullptr  /* in_image_memory_barriers_ptr  */) )
+        {
+            goto end;
+        }
+    }
+
+    result = in_cmd_buffer_ptr->record_set_device_mask_KHR(in_final_device_mask);
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::PeerCopy::record_image_copy(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                        uint32_t                  in_n_executing_device,
+                                        Anvil::Image*             in_src_image_ptr,
+                                        Anvil::ImageLayout        in_src_image_layout,
+                                        Anvil::Image*             in_dst_image_ptr,
+                                        Anvil::ImageLayout        in_dst_image_layout,
+                                        uint32_t                  in_n_regions,
+                                        const Anvil::ImageCopy*   in_regions_ptr,
+                                        Anvil::PipelineStageFlags in_dst_stage_mask,
+                                        Anvil::AccessFlags        in_dst_access_mask,
+                                        uint32_t                  in_final_device_mask)
+{
+    bool result = false;
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+    anvil_assert(in_dst_image_ptr  != nullptr);
+    anvil_assert(in_regions_ptr    != nullptr);
+    anvil_assert(in_src_image_ptr  != nullptr);
+
+    if (!is_executing_device_valid(in_src_image_ptr->get_create_info_ptr()->get_device(),
+                                   in_n_executing_device) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    {
+        const Anvil::ImageBarrier pre_copy_barriers[] =
+        {
+            Anvil::ImageBarrier(Anvil::AccessFlagBits::MEMORY_WRITE_BIT,
+                                Anvil::AccessFlagBits::TRANSFER_READ_BIT,
+                                in_src_image_layout,
+                                in_src_image_layout,
+                                VK_QUEUE_FAMILY_IGNORED,
+                                VK_QUEUE_FAMILY_IGNORED,
+                                in_src_image_ptr,
+                                in_src_image_ptr->get_subresource_range() ),
+            Anvil::ImageBarrier(Anvil::AccessFlagBits::MEMORY_READ_BIT | Anvil::AccessFlagBits::MEMORY_WRITE_BIT,
+                                Anvil::AccessFlagBits::TRANSFER_WRITE_BIT,
+                                in_dst_image_layout,
+                                in_dst_image_layout,
+                                VK_QUEUE_FAMILY_IGNORED,
+                                VK_QUEUE_FAMILY_IGNORED,
+                                in_dst_image_ptr,
+                                in_dst_image_ptr->get_subresource_range() )
+        };
+        const Anvil::ImageBarrier post_copy_barrier(Anvil::AccessFlagBits::TRANSFER_WRITE_BIT,
+                                                    in_dst_access_mask,
+                                                    in_dst_image_layout,
+                                                    in_dst_image_layout,
+                                                    VK_QUEUE_FAMILY_IGNORED,
+                                                    VK_QUEUE_FAMILY_IGNORED,
+                                                    in_dst_image_ptr,
+                                                    in_dst_image_ptr->get_subresource_range() );
+
+        if (!in_cmd_buffer_ptr->record_set_device_mask_KHR(1u << in_n_executing_device) )
+        {
+            goto end;
+        }
+
+        if (!in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT,
+                                                        Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                        Anvil::DependencyFlagBits::NONE,
+                                                        0,       /* in_memory_barrier_count */
+                                                        nullptr, /* in_memory_barriers_ptr  */
+                                                        0,       /* in_buffer_memory_barrier_count */
+                                                        nullptr, /* in_buffer_memory_barriers_ptr  */
+                                                        sizeof(pre_copy_barriers) / sizeof(pre_copy_barriers[0]),
+                                                        pre_copy_barriers)                             ||
+            !in_cmd_buffer_ptr->record_copy_image      (in_src_image_ptr,
+                                                        in_src_image_layout,
+                                                        in_dst_image_ptr,
+                                                        in_dst_image_layout,
+                                                        in_n_regions,
+                                                        in_regions_ptr)                                ||
+            !in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                        in_dst_stage_mask,
+                                                        Anvil::DependencyFlagBits::NONE,
+                                                        0,       /* in_memory_barrier_count */
+                                                        nullptr, /* in_memory_barriers_ptr  */
+                                                        0,       /* in_buffer_memory_barrier_count */
+                                                        nullptr, /* in_buffer_memory_barriers_ptr  */
+                                                        1,       /* in_image_memory_barrier_count */
+                                                       &post_copy_barrier) )
+        {
+            goto end;
+        }
+    }
+
+    result = in_cmd_buffer_ptr->record_set_device_mask_KHR(in_final_device_mask);
+end:
+    return result;
+}
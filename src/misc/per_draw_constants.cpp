@@ -0,0 +1,272 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "misc/base_pipeline_create_info.h"
+#include "misc/debug.h"
+#include "misc/descriptor_set_create_info.h"
+#include "misc/per_draw_constants.h"
+#include "misc/transient_buffer_allocator.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/descriptor_set_group.h"
+#include "wrappers/device.h"
+#include <sstream>
+
+
+/** Please see header for specification */
+Anvil::PerDrawConstants::PerDrawConstants(const Anvil::BaseDevice*         in_device_ptr,
+                                          uint32_t                         in_size,
+                                          Anvil::ShaderStageFlags          in_stages,
+                                          uint32_t                         in_n_set,
+                                          Anvil::TransientBufferAllocator* in_uniform_allocator_ptr)
+    :m_device_ptr           (in_device_ptr),
+     m_n_set                (in_n_set),
+     m_size                 (in_size),
+     m_stages               (in_stages),
+     m_uniform_allocator_ptr(in_uniform_allocator_ptr),
+     m_uses_push_constants  (false)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::PerDrawConstants::~PerDrawConstants()
+{
+    /* Clones must go away before the DSG they have been created from */
+    m_dsgs.clear();
+    m_parent_dsg_ptr.reset();
+}
+
+/** Please see header for specification */
+bool Anvil::PerDrawConstants::configure_pipeline(Anvil::BasePipelineCreateInfo* in_pipeline_create_info_ptr) const
+{
+    bool result = false;
+
+    if (in_pipeline_create_info_ptr == nullptr)
+    {
+        anvil_assert(in_pipeline_create_info_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (m_uses_push_constants)
+    {
+        result = in_pipeline_create_info_ptr->attach_push_constant_range(0, /* in_offset */
+                                                                         m_size,
+                                                                         m_stages);
+    }
+    else
+    {
+        result = true;
+    }
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::PerDrawConstantsUniquePtr Anvil::PerDrawConstants::create(const Anvil::BaseDevice*         in_device_ptr,
+                                                                 uint32_t                         in_size,
+                                                                 Anvil::ShaderStageFlags          in_stages,
+                                                                 uint32_t                         in_n_set,
+                                                                 Anvil::TransientBufferAllocator* in_uniform_allocator_ptr)
+{
+    Anvil::PerDrawConstantsUniquePtr result_ptr(nullptr,
+                                                std::default_delete<Anvil::PerDrawConstants>() );
+
+    anvil_assert(in_device_ptr            != nullptr);
+    anvil_assert(in_uniform_allocator_ptr != nullptr);
+    anvil_assert(in_size                  >  0);
+    anvil_assert((in_size % 4)            == 0);
+
+    result_ptr.reset(
+        new Anvil::PerDrawConstants(in_device_ptr,
+                                    in_size,
+                                    in_stages,
+                                    in_n_set,
+                                    in_uniform_allocator_ptr)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init() )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+const Anvil::DescriptorSetCreateInfo* Anvil::PerDrawConstants::get_descriptor_set_create_info() const
+{
+    return (m_parent_dsg_ptr != nullptr) ? m_parent_dsg_ptr->get_descriptor_set_create_info(0 /* in_n_set */)
+                                         : nullptr;
+}
+
+/** Please see header for specification */
+std::string Anvil::PerDrawConstants::get_glsl_block_layout() const
+{
+    std::stringstream result_sstream;
+
+    if (m_uses_push_constants)
+    {
+        result_sstream << "layout(push_constant)";
+    }
+    else
+    {
+        result_sstream << "layout(set = " << m_n_set << ", binding = 0)";
+    }
+
+    return result_sstream.str();
+}
+
+/** Decides which mechanism to pass the constants with and, if push constants cannot be used, creates
+ *  the descriptor set group holding the uniform buffer's layout.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::PerDrawConstants::init()
+{
+    const auto&                                          limits                 = m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits;
+    std::vector<Anvil::DescriptorSetCreateInfoUniquePtr> ds_create_info_ptrs    (1);
+    bool                                                 result                 = false;
+
+    if (m_size <= limits.max_push_constants_size)
+    {
+        m_uses_push_constants = true;
+        result                = true;
+
+        goto end;
+    }
+
+    if (m_size > limits.max_uniform_buffer_range)
+    {
+        anvil_assert(m_size <= limits.max_uniform_buffer_range);
+
+        goto end;
+    }
+
+    if ((m_uniform_allocator_ptr->get_usage_flags() & Anvil::BufferUsageFlagBits::UNIFORM_BUFFER_BIT) == 0)
+    {
+        anvil_assert((m_uniform_allocator_ptr->get_usage_flags() & Anvil::BufferUsageFlagBits::UNIFORM_BUFFER_BIT) != 0);
+
+        goto end;
+    }
+
+    ds_create_info_ptrs.at(0) = Anvil::DescriptorSetCreateInfo::create();
+
+    ds_create_info_ptrs.at(0)->add_binding(0, /* in_binding_index */
+                                           Anvil::DescriptorType::UNIFORM_BUFFER_DYNAMIC,
+                                           1, /* in_descriptor_array_size */
+                                           m_stages);
+
+    m_parent_dsg_ptr = Anvil::DescriptorSetGroup::create(m_device_ptr,
+                                                         ds_create_info_ptrs);
+
+    result = (m_parent_dsg_ptr != nullptr);
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::PerDrawConstants::record(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                     Anvil::PipelineBindPoint  in_pipeline_bind_point,
+                                     Anvil::PipelineLayout*    in_layout_ptr,
+                                     const void*               in_data_ptr)
+{
+    Anvil::TransientBufferAllocator::Allocation allocation;
+    Anvil::DescriptorSet*                       ds_ptr         = nullptr;
+    uint32_t                                    dynamic_offset = 0;
+    decltype(m_dsgs)::iterator                  dsg_iterator;
+    bool                                        result         = false;
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+    anvil_assert(in_data_ptr       != nullptr);
+    anvil_assert(in_layout_ptr     != nullptr);
+
+    if (m_uses_push_constants)
+    {
+        result = in_cmd_buffer_ptr->record_push_constants(in_layout_ptr,
+                                                          m_stages,
+                                                          0, /* in_offset */
+                                                          m_size,
+                                                          in_data_ptr);
+
+        goto end;
+    }
+
+    if (!m_uniform_allocator_ptr->allocate_and_write(m_size,
+                                                     in_data_ptr,
+                                                    &allocation) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    /* Dynamic offsets are 32-bit */
+    anvil_assert(allocation.offset <= UINT32_MAX);
+
+    dynamic_offset = static_cast<uint32_t>(allocation.offset);
+
+    /* Chunk buffers are retained by the allocator until it is released, so one descriptor set per chunk is
+     * enough to address all allocations ever made from it. */
+    dsg_iterator = m_dsgs.find(allocation.buffer_ptr);
+
+    if (dsg_iterator == m_dsgs.end() )
+    {
+        auto new_dsg_ptr = Anvil::DescriptorSetGroup::create(m_parent_dsg_ptr.get() );
+
+        if (new_dsg_ptr == nullptr)
+        {
+            anvil_assert(new_dsg_ptr != nullptr);
+
+            goto end;
+        }
+
+        new_dsg_ptr->set_binding_item(0, /* in_n_set         */
+                                      0, /* in_binding_index */
+                                      Anvil::DescriptorSet::DynamicUniformBufferBindingElement(allocation.buffer_ptr,
+                                                                                               0, /* in_start_offset */
+                                                                                               m_size) );
+
+        dsg_iterator = m_dsgs.insert(
+            std::make_pair(allocation.buffer_ptr,
+                           std::move(new_dsg_ptr) )
+        ).first;
+    }
+
+    ds_ptr = dsg_iterator->second->get_descriptor_set(0 /* in_n_set */);
+
+    result = in_cmd_buffer_ptr->record_bind_descriptor_sets(in_pipeline_bind_point,
+                                                            in_layout_ptr,
+                                                            m_n_set,
+                                                            1, /* in_set_count */
+                                                           &ds_ptr,
+                                                            1, /* in_dynamic_offset_count */
+                                                           &dynamic_offset);
+
+end:
+    return result;
+}
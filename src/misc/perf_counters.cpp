@@ -0,0 +1,125 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "misc/perf_counters.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+
+namespace
+{
+    /* Counters incremented by a single thread. Shards are shared with the global registry, so that their values
+     * survive the threads which incremented them.
+     */
+    typedef struct Shard
+    {
+        std::atomic<uint64_t> values[static_cast<uint32_t>(Anvil::PerfCounters::Counter::COUNT)];
+
+        Shard()
+        {
+            for (auto& current_value : values)
+            {
+                current_value.store(0,
+                                    std::memory_order_relaxed);
+            }
+        }
+    } Shard;
+
+    std::vector<std::shared_ptr<Shard> > g_shards;
+    std::mutex                           g_shards_mutex;
+
+    thread_local std::shared_ptr<Shard> t_shard_ptr;
+
+    Shard* get_shard()
+    {
+        if (t_shard_ptr == nullptr)
+        {
+            std::unique_lock<std::mutex> lock(g_shards_mutex);
+
+            t_shard_ptr.reset(new Shard() );
+
+            g_shards.push_back(t_shard_ptr);
+        }
+
+        return t_shard_ptr.get();
+    }
+}
+
+
+/* Please see header for specification */
+Anvil::PerfCountersSnapshot Anvil::PerfCounters::get_snapshot(bool in_should_reset)
+{
+    uint64_t                    counter_values[static_cast<uint32_t>(Counter::COUNT)] = {0};
+    Anvil::PerfCountersSnapshot result;
+
+    {
+        std::unique_lock<std::mutex> lock(g_shards_mutex);
+
+        for (const auto& current_shard_ptr : g_shards)
+        {
+            for (uint32_t n_counter = 0;
+                          n_counter < static_cast<uint32_t>(Counter::COUNT);
+                        ++n_counter)
+            {
+                counter_values[n_counter] += (in_should_reset) ? current_shard_ptr->values[n_counter].exchange(0,
+                                                                                                               std::memory_order_relaxed)
+                                                               : current_shard_ptr->values[n_counter].load    (std::memory_order_relaxed);
+            }
+        }
+    }
+
+    result.n_buffers_created          = counter_values[static_cast<uint32_t>(Counter::BUFFERS_CREATED)];
+    result.n_command_buffer_commands  = counter_values[static_cast<uint32_t>(Counter::COMMAND_BUFFER_COMMANDS)];
+    result.n_command_buffers_recorded = counter_values[static_cast<uint32_t>(Counter::COMMAND_BUFFERS_RECORDED)];
+    result.n_descriptor_set_updates   = counter_values[static_cast<uint32_t>(Counter::DESCRIPTOR_SET_UPDATES)];
+    result.n_images_created           = counter_values[static_cast<uint32_t>(Counter::IMAGES_CREATED)];
+    result.n_pipeline_binds           = counter_values[static_cast<uint32_t>(Counter::PIPELINE_BINDS)];
+    result.n_queue_submissions        = counter_values[static_cast<uint32_t>(Counter::QUEUE_SUBMISSIONS)];
+    result.n_uploaded_bytes           = counter_values[static_cast<uint32_t>(Counter::UPLOADED_BYTES)];
+
+    return result;
+}
+
+/* Please see header for specification */
+void Anvil::PerfCounters::increment(Counter  in_counter,
+                                    uint64_t in_value)
+{
+    get_shard()->values[static_cast<uint32_t>(in_counter)].fetch_add(in_value,
+                                                                     std::memory_order_relaxed);
+}
+
+/* Please see header for specification */
+void Anvil::PerfCounters::reset()
+{
+    std::unique_lock<std::mutex> lock(g_shards_mutex);
+
+    for (const auto& current_shard_ptr : g_shards)
+    {
+        for (auto& current_value : current_shard_ptr->values)
+        {
+            current_value.store(0,
+                                std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,2590 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#include "misc/debug.h"
+#include "misc/base_pipeline_manager.h"
+#include "misc/compute_pipeline_create_info.h"
+#include "misc/debug.h"
+#include "misc/descriptor_set_create_info.h"
+#include "misc/graphics_pipeline_create_info.h"
+#include "misc/io.h"
+#include "misc/pipeline_manifest.h"
+#include "misc/render_pass_create_info.h"
+#include "wrappers/compute_pipeline_manager.h"
+#include "wrappers/device.h"
+#include "wrappers/graphics_pipeline_manager.h"
+#include "wrappers/render_pass.h"
+#include "wrappers/shader_module.h"
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <tuple>
+
+
+/* File layout:
+ *
+ * - header:         magic, version, number of SPIR-V blobs, number of render passes, number of pipelines.
+ * - SPIR-V blobs:   64-bit hash, number of words, words.
+ * - render passes:  64-bit compatibility hash, number of words, serialized render pass description.
+ * - pipelines:      number of words, serialized pipeline description.
+ * - usage profile:  bind count & first bind frame of each pipeline, in the order the pipelines are stored in.
+ *
+ * All items are stored as little-endian 32-bit words. 64-bit values occupy two words, low word first.
+ *
+ * Version 3 manifests, which predate the usage profile, are still accepted. Pipelines loaded from them are treated
+ * as never bound. */
+static const uint32_t g_manifest_magic                 = 0x4D504E41; /* "ANPM" */
+static const uint32_t g_manifest_version               = 4;
+static const uint32_t g_manifest_version_without_usage = 3;
+
+/* Pipeline types, as stored in the manifest */
+enum
+{
+    PIPELINE_TYPE_COMPUTE,
+    PIPELINE_TYPE_GRAPHICS,
+};
+
+static const Anvil::ShaderStage g_graphics_shader_stages[] =
+{
+    Anvil::ShaderStage::FRAGMENT,
+    Anvil::ShaderStage::GEOMETRY,
+    Anvil::ShaderStage::TESSELLATION_CONTROL,
+    Anvil::ShaderStage::TESSELLATION_EVALUATION,
+    Anvil::ShaderStage::VERTEX,
+    Anvil::ShaderStage::MESH,
+    Anvil::ShaderStage::TASK,
+};
+
+
+namespace
+{
+    /* Sequential reader of serialized words. Reads past the end return zeros and mark the reader as failed. */
+    class WordReader
+    {
+    public:
+        WordReader(const uint32_t* in_words_ptr,
+                   size_t          in_n_words)
+            :m_failed    (false),
+             m_n_words   (in_n_words),
+             m_offset    (0),
+             m_words_ptr (in_words_ptr)
+        {
+            /* Stub */
+        }
+
+        bool has_failed() const
+        {
+            return m_failed;
+        }
+
+        bool is_at_end() const
+        {
+            return (m_offset == m_n_words);
+        }
+
+        uint32_t read()
+        {
+            uint32_t result = 0;
+
+            if (m_offset < m_n_words)
+            {
+                result = m_words_ptr[m_offset++];
+            }
+            else
+            {
+                m_failed = true;
+            }
+
+            return result;
+        }
+
+        void read_data(uint32_t                    in_n_bytes,
+                       std::vector<unsigned char>* out_data_ptr)
+        {
+            const uint32_t* words_ptr = read_words((in_n_bytes + 3) / 4);
+
+            out_data_ptr->resize(in_n_bytes);
+
+            if (words_ptr  != nullptr &&
+                in_n_bytes >  0)
+            {
+                memcpy(&out_data_ptr->at(0),
+                       words_ptr,
+                       in_n_bytes);
+            }
+        }
+
+        float read_float()
+        {
+            const uint32_t value_bits = read();
+            float          result     = 0.0f;
+
+            memcpy(&result,
+                   &value_bits,
+                   sizeof(result) );
+
+            return result;
+        }
+
+        std::string read_string()
+        {
+            std::vector<unsigned char> data;
+            const uint32_t             n_bytes = read();
+
+            read_data(n_bytes,
+                     &data);
+
+            return std::string(data.begin(),
+                               data.end  () );
+        }
+
+        uint64_t read_u64()
+        {
+            const uint64_t low  = read();
+            const uint64_t high = read();
+
+            return (high << 32) | low;
+        }
+
+        const uint32_t* read_words(uint32_t in_n_words)
+        {
+            const uint32_t* result_ptr = nullptr;
+
+            if (m_n_words - m_offset >= in_n_words)
+            {
+                result_ptr  = m_words_ptr + m_offset;
+                m_offset   += in_n_words;
+            }
+            else
+            {
+                m_failed = true;
+                m_offset = m_n_words;
+            }
+
+            return result_ptr;
+        }
+
+    private:
+        bool            m_failed;
+        size_t          m_n_words;
+        size_t          m_offset;
+        const uint32_t* m_words_ptr;
+    };
+};
+
+
+static void write_data(const void*            in_data_ptr,
+                       uint32_t               in_n_bytes,
+                       std::vector<uint32_t>* out_words_ptr)
+{
+    const size_t n_words_before = out_words_ptr->size();
+
+    out_words_ptr->push_back(in_n_bytes);
+    out_words_ptr->resize   (n_words_before + 1 + (in_n_bytes + 3) / 4,
+                             0);
+
+    if (in_n_bytes > 0)
+    {
+        memcpy(&out_words_ptr->at(n_words_before + 1),
+               in_data_ptr,
+               in_n_bytes);
+    }
+}
+
+static void write_float(float                  in_value,
+                        std::vector<uint32_t>* out_words_ptr)
+{
+    uint32_t value_bits = 0;
+
+    memcpy(&value_bits,
+           &in_value,
+           sizeof(value_bits) );
+
+    out_words_ptr->push_back(value_bits);
+}
+
+static void write_u64(uint64_t               in_value,
+                      std::vector<uint32_t>* out_words_ptr)
+{
+    out_words_ptr->push_back(static_cast<uint32_t>(in_value & 0xFFFFFFFFu) );
+    out_words_ptr->push_back(static_cast<uint32_t>(in_value >> 32) );
+}
+
+/** Returns the entry-point name the pipeline managers use for the specified shader stage.
+ *
+ *  Compute pipelines use the name specified for the stage, whereas graphics pipelines use the names
+ *  the shader module has been created with.
+ */
+static const std::string& get_entrypoint_name(const Anvil::ShaderModuleStageEntryPoint& in_entrypoint)
+{
+    const auto module_ptr = in_entrypoint.shader_module_ptr;
+
+    switch (in_entrypoint.stage)
+    {
+        case Anvil::ShaderStage::FRAGMENT:                return module_ptr->get_fs_entrypoint_name();
+        case Anvil::ShaderStage::GEOMETRY:                return module_ptr->get_gs_entrypoint_name();
+        case Anvil::ShaderStage::TESSELLATION_CONTROL:    return module_ptr->get_tc_entrypoint_name();
+        case Anvil::ShaderStage::TESSELLATION_EVALUATION: return module_ptr->get_te_entrypoint_name();
+        case Anvil::ShaderStage::VERTEX:                  return module_ptr->get_vs_entrypoint_name();
+
+        default:
+        {
+            return in_entrypoint.name;
+        }
+    }
+}
+
+/** Re-creates a render pass from a description serialized by PipelineManifest::record_render_pass().
+ *
+ *  @return Render pass instance if successful, null otherwise.
+ */
+static Anvil::RenderPassUniquePtr create_render_pass(const Anvil::BaseDevice* in_device_ptr,
+                                                     WordReader*              in_reader_ptr)
+{
+    std::map<Anvil::RenderPassAttachmentID, Anvil::RenderPassAttachmentID> attachment_ids;
+    Anvil::RenderPassCreateInfoUniquePtr                                   create_info_ptr(new Anvil::RenderPassCreateInfo(in_device_ptr) );
+    bool                                                                   is_multiview_enabled = false;
+    uint32_t                                                               n_attachments        = 0;
+    uint32_t                                                               n_dependencies       = 0;
+    uint32_t                                                               n_subpasses          = 0;
+    Anvil::RenderPassUniquePtr                                             result_ptr;
+    bool                                                                   success              = true;
+
+    auto get_attachment_id = [&](Anvil::RenderPassAttachmentID in_recorded_id) -> Anvil::RenderPassAttachmentID
+    {
+        auto iterator = attachment_ids.find(in_recorded_id);
+
+        if (iterator == attachment_ids.end() )
+        {
+            success = false;
+
+            return UINT32_MAX;
+        }
+
+        return iterator->second;
+    };
+
+    /* Attachments */
+    n_attachments = in_reader_ptr->read();
+
+    for (uint32_t n_attachment = 0;
+                  n_attachment < n_attachments && !in_reader_ptr->has_failed();
+                ++n_attachment)
+    {
+        const auto                    recorded_id     = in_reader_ptr->read();
+        const auto                    attachment_type = static_cast<Anvil::AttachmentType>     (in_reader_ptr->read() );
+        const auto                    format          = static_cast<Anvil::Format>             (in_reader_ptr->read() );
+        const auto                    sample_count    = static_cast<Anvil::SampleCountFlagBits>(in_reader_ptr->read() );
+        const auto                    load_op         = static_cast<Anvil::AttachmentLoadOp>   (in_reader_ptr->read() );
+        const auto                    store_op        = static_cast<Anvil::AttachmentStoreOp>  (in_reader_ptr->read() );
+        const auto                    stencil_load_op = static_cast<Anvil::AttachmentLoadOp>   (in_reader_ptr->read() );
+        const auto                    stencil_store_op= static_cast<Anvil::AttachmentStoreOp>  (in_reader_ptr->read() );
+        const auto                    initial_layout  = static_cast<Anvil::ImageLayout>        (in_reader_ptr->read() );
+        const auto                    final_layout    = static_cast<Anvil::ImageLayout>        (in_reader_ptr->read() );
+        const bool                    may_alias       = (in_reader_ptr->read() != 0);
+        Anvil::RenderPassAttachmentID new_id          = UINT32_MAX;
+
+        if (attachment_type == Anvil::AttachmentType::COLOR)
+        {
+            success &= create_info_ptr->add_color_attachment(format,
+                                                             sample_count,
+                                                             load_op,
+                                                             store_op,
+                                                             initial_layout,
+                                                             final_layout,
+                                                             may_alias,
+                                                            &new_id);
+        }
+        else
+        {
+            success &= create_info_ptr->add_depth_stencil_attachment(format,
+                                                                     sample_count,
+                                                                     load_op,
+                                                                     store_op,
+                                                                     stencil_load_op,
+                                                                     stencil_store_op,
+                                                                     initial_layout,
+                                                                     final_layout,
+                                                                     may_alias,
+                                                                    &new_id);
+        }
+
+        attachment_ids[recorded_id] = new_id;
+    }
+
+    /* Subpasses */
+    n_subpasses = in_reader_ptr->read();
+
+    for (uint32_t n_subpass = 0;
+                  n_subpass < n_subpasses && !in_reader_ptr->has_failed() && success;
+                ++n_subpass)
+    {
+        uint32_t         n_color_attachments = 0;
+        uint32_t         n_input_attachments = 0;
+        Anvil::SubPassID subpass_id          = UINT32_MAX;
+
+        success &= create_info_ptr->add_subpass(&subpass_id);
+
+        n_color_attachments = in_reader_ptr->read();
+
+        for (uint32_t n_color_attachment = 0;
+                      n_color_attachment < n_color_attachments && success;
+                    ++n_color_attachment)
+        {
+            const auto                    layout              = static_cast<Anvil::ImageLayout>(in_reader_ptr->read() );
+            const auto                    attachment_id       = get_attachment_id(in_reader_ptr->read() );
+            const auto                    location            = in_reader_ptr->read();
+            const auto                    recorded_resolve_id = in_reader_ptr->read();
+            Anvil::RenderPassAttachmentID resolve_id          = UINT32_MAX;
+
+            if (recorded_resolve_id != UINT32_MAX)
+            {
+                resolve_id = get_attachment_id(recorded_resolve_id);
+            }
+
+            success &= create_info_ptr->add_subpass_color_attachment(subpass_id,
+                                                                     layout,
+                                                                     attachment_id,
+                                                                     location,
+                                                                     (recorded_resolve_id != UINT32_MAX) ? &resolve_id
+                                                                                                         : nullptr);
+        }
+
+        n_input_attachments = in_reader_ptr->read();
+
+        for (uint32_t n_input_attachment = 0;
+                      n_input_attachment < n_input_attachments && success;
+                    ++n_input_attachment)
+        {
+            const auto layout           = static_cast<Anvil::ImageLayout>(in_reader_ptr->read() );
+            const auto attachment_id    = get_attachment_id(in_reader_ptr->read() );
+            const auto attachment_index = in_reader_ptr->read();
+            const auto aspects_accessed = Anvil::ImageAspectFlags(static_cast<Anvil::ImageAspectFlagBits>(in_reader_ptr->read() ));
+
+            success &= create_info_ptr->add_subpass_input_attachment(subpass_id,
+                                                                     layout,
+                                                                     attachment_id,
+                                                                     attachment_index,
+                                                                     aspects_accessed);
+        }
+
+        if (in_reader_ptr->read() != 0)
+        {
+            const auto layout              = static_cast<Anvil::ImageLayout>(in_reader_ptr->read() );
+            const auto attachment_id       = get_attachment_id(in_reader_ptr->read() );
+            const auto recorded_resolve_id = in_reader_ptr->read();
+            const auto depth_resolve_mode  = static_cast<Anvil::ResolveModeFlagBits>(in_reader_ptr->read() );
+            const auto stencil_resolve_mode= static_cast<Anvil::ResolveModeFlagBits>(in_reader_ptr->read() );
+
+            if (recorded_resolve_id != UINT32_MAX)
+            {
+                const auto resolve_id = get_attachment_id(recorded_resolve_id);
+
+                success &= create_info_ptr->add_subpass_depth_stencil_attachment(subpass_id,
+                                                                                 layout,
+                                                                                 attachment_id,
+                                                                                &resolve_id,
+                                                                                &depth_resolve_mode,
+                                                                                &stencil_resolve_mode);
+            }
+            else
+            {
+                success &= create_info_ptr->add_subpass_depth_stencil_attachment(subpass_id,
+                                                                                 layout,
+                                                                                 attachment_id);
+            }
+        }
+
+        if (in_reader_ptr->read() != 0)
+        {
+            is_multiview_enabled = true;
+
+            success &= create_info_ptr->set_subpass_view_mask(subpass_id,
+                                                              in_reader_ptr->read() );
+        }
+    }
+
+    /* Dependencies */
+    n_dependencies = in_reader_ptr->read();
+
+    for (uint32_t n_dependency = 0;
+                  n_dependency < n_dependencies && !in_reader_ptr->has_failed() && success;
+                ++n_dependency)
+    {
+        const auto dst_subpass_id = in_reader_ptr->read();
+        const auto src_subpass_id = in_reader_ptr->read();
+        const auto dst_stage_mask = Anvil::PipelineStageFlags(static_cast<Anvil::PipelineStageFlagBits>(in_reader_ptr->read() ));
+        const auto src_stage_mask = Anvil::PipelineStageFlags(static_cast<Anvil::PipelineStageFlagBits>(in_reader_ptr->read() ));
+        const auto dst_access     = Anvil::AccessFlags       (static_cast<Anvil::AccessFlagBits>       (in_reader_ptr->read() ));
+        const auto src_access     = Anvil::AccessFlags       (static_cast<Anvil::AccessFlagBits>       (in_reader_ptr->read() ));
+        const auto flags          = Anvil::DependencyFlags   (static_cast<Anvil::DependencyFlagBits>   (in_reader_ptr->read() ));
+        const auto has_view_offset= (in_reader_ptr->read() != 0);
+        const auto view_offset    = static_cast<int32_t>(in_reader_ptr->read() );
+
+        if (src_subpass_id == UINT32_MAX)
+        {
+            success &= create_info_ptr->add_external_to_subpass_dependency(dst_subpass_id,
+                                                                           src_stage_mask,
+                                                                           dst_stage_mask,
+                                                                           src_access,
+                                                                           dst_access,
+                                                                           flags);
+        }
+        else
+        if (dst_subpass_id == UINT32_MAX)
+        {
+            success &= create_info_ptr->add_subpass_to_external_dependency(src_subpass_id,
+                                                                           src_stage_mask,
+                                                                           dst_stage_mask,
+                                                                           src_access,
+                                                                           dst_access,
+                                                                           flags);
+        }
+        else
+        if (src_subpass_id == dst_subpass_id)
+        {
+            success &= create_info_ptr->add_self_subpass_dependency(dst_subpass_id,
+                                                                    src_stage_mask,
+                                                                    dst_stage_mask,
+                                                                    src_access,
+                                                                    dst_access,
+                                                                    flags);
+        }
+        else
+        {
+            success &= create_info_ptr->add_subpass_to_subpass_dependency(src_subpass_id,
+                                                                          dst_subpass_id,
+                                                                          src_stage_mask,
+                                                                          dst_stage_mask,
+                                                                          src_access,
+                                                                          dst_access,
+                                                                          flags);
+        }
+
+        if (has_view_offset)
+        {
+            success &= create_info_ptr->set_dependency_view_local_properties(n_dependency,
+                                                                             view_offset);
+        }
+    }
+
+    /* Multiview correlation masks */
+    {
+        const uint32_t  n_correlation_masks   = in_reader_ptr->read();
+        const uint32_t* correlation_masks_ptr = in_reader_ptr->read_words(n_correlation_masks);
+
+        if (is_multiview_enabled           &&
+            n_correlation_masks   >  0     &&
+            correlation_masks_ptr != nullptr)
+        {
+            create_info_ptr->set_correlation_masks(n_correlation_masks,
+                                                   correlation_masks_ptr);
+        }
+    }
+
+    if (!success                     ||
+         in_reader_ptr->has_failed() )
+    {
+        goto end;
+    }
+
+    result_ptr = Anvil::RenderPass::create(std::move(create_info_ptr),
+                                           nullptr); /* in_opt_swapchain_ptr */
+
+end:
+    return result_ptr;
+}
+
+
+/** Please see header for specification */
+Anvil::PipelineManifest::PipelineManifest(bool in_mt_safe)
+    :MTSafetySupportProvider(in_mt_safe)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::PipelineManifest::~PipelineManifest()
+{
+    while (!m_attached_pipeline_managers.empty() )
+    {
+        detach(m_attached_pipeline_managers.back() );
+    }
+}
+
+/** Please see header for specification */
+bool Anvil::PipelineManifest::add_pipeline(const Anvil::BasePipelineCreateInfo* in_pipeline_create_info_ptr,
+                                           uint32_t*                            out_opt_n_pipeline_ptr)
+{
+    bool     result        = false;
+    uint64_t hash          = 0;
+    auto     hash_iterator = m_pipeline_hashes.end();
+    Words    words;
+
+    anvil_assert(in_pipeline_create_info_ptr != nullptr);
+
+    if (in_pipeline_create_info_ptr->is_proxy() )
+    {
+        goto end;
+    }
+
+    lock();
+    {
+        if (!record_pipeline(in_pipeline_create_info_ptr,
+                            &words) )
+        {
+            goto end_locked;
+        }
+
+        hash = Anvil::Utils::hash64(&words.at(0),
+                                    words.size() * sizeof(uint32_t) );
+
+        hash_iterator = m_pipeline_hashes.find(hash);
+
+        if (hash_iterator == m_pipeline_hashes.end() )
+        {
+            hash_iterator = m_pipeline_hashes.insert(std::make_pair(hash,
+                                                                    static_cast<uint32_t>(m_pipelines.size() )) ).first;
+
+            m_pipeline_usage.push_back(Anvil::BasePipelineManager::PipelineUsage() );
+            m_pipelines.push_back     (std::move(words) );
+        }
+
+        if (out_opt_n_pipeline_ptr != nullptr)
+        {
+            *out_opt_n_pipeline_ptr = hash_iterator->second;
+        }
+
+        result = true;
+    }
+end_locked:
+    unlock();
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::PipelineManifest::attach(Anvil::BasePipelineManager* in_pipeline_manager_ptr)
+{
+    anvil_assert(in_pipeline_manager_ptr != nullptr);
+
+    lock();
+    {
+        anvil_assert(std::find(m_attached_pipeline_managers.begin(),
+                               m_attached_pipeline_managers.end  (),
+                               in_pipeline_manager_ptr) == m_attached_pipeline_managers.end() );
+
+        m_attached_pipeline_managers.push_back(in_pipeline_manager_ptr);
+    }
+    unlock();
+
+    in_pipeline_manager_ptr->register_for_callbacks(Anvil::BASE_PIPELINE_MANAGER_CALLBACK_ID_ON_NEW_PIPELINE_CREATED,
+                                                    std::bind(&PipelineManifest::on_new_pipeline,
+                                                              this,
+                                                              in_pipeline_manager_ptr,
+                                                              std::placeholders::_1),
+                                                    this);
+}
+
+/** Please see header for specification */
+void Anvil::PipelineManifest::capture_usage()
+{
+    lock();
+    {
+        for (auto& current_pipeline_manager_ptr : m_attached_pipeline_managers)
+        {
+            capture_usage(current_pipeline_manager_ptr);
+        }
+    }
+    unlock();
+}
+
+/** Merges bind statistics gathered by the specified pipeline manager since the last capture into the usage profile.
+ *
+ *  Must be called with the manifest locked.
+ *
+ *  @param in_pipeline_manager_ptr Pipeline manager to capture the statistics from. Must not be null.
+ */
+void Anvil::PipelineManifest::capture_usage(Anvil::BasePipelineManager* in_pipeline_manager_ptr)
+{
+    const auto range_begin = m_tracked_pipelines.lower_bound(TrackedPipelineKey(in_pipeline_manager_ptr, 0) );
+    const auto range_end   = m_tracked_pipelines.upper_bound(TrackedPipelineKey(in_pipeline_manager_ptr, UINT32_MAX) );
+
+    for (auto tracked_pipeline_iterator  = range_begin;
+              tracked_pipeline_iterator != range_end;
+            ++tracked_pipeline_iterator)
+    {
+        auto&                                     tracked_pipeline = tracked_pipeline_iterator->second;
+        auto&                                     pipeline_usage   = m_pipeline_usage.at(tracked_pipeline.n_pipeline);
+        Anvil::BasePipelineManager::PipelineUsage usage;
+
+        if (!in_pipeline_manager_ptr->get_pipeline_usage(tracked_pipeline_iterator->first.second,
+                                                        &usage) )
+        {
+            continue;
+        }
+
+        if (usage.n_binds <= tracked_pipeline.n_binds_captured)
+        {
+            continue;
+        }
+
+        pipeline_usage.n_binds            += usage.n_binds - tracked_pipeline.n_binds_captured;
+        pipeline_usage.n_first_bind_frame  = std::min(pipeline_usage.n_first_bind_frame,
+                                                      usage.n_first_bind_frame);
+        tracked_pipeline.n_binds_captured  = usage.n_binds;
+    }
+}
+
+/** Please see header for specification */
+Anvil::PipelineManifestUniquePtr Anvil::PipelineManifest::create(bool in_mt_safe)
+{
+    Anvil::PipelineManifestUniquePtr result_ptr(nullptr,
+                                                std::default_delete<Anvil::PipelineManifest>() );
+
+    result_ptr.reset(
+        new Anvil::PipelineManifest(in_mt_safe)
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+Anvil::PipelineManifestUniquePtr Anvil::PipelineManifest::create_from_file(const std::string& in_filename,
+                                                                           bool               in_mt_safe)
+{
+    char*                            data_ptr = nullptr;
+    size_t                           n_bytes  = 0;
+    Anvil::PipelineManifestUniquePtr result_ptr(nullptr,
+                                                std::default_delete<Anvil::PipelineManifest>() );
+    Words                            words;
+
+    if (!Anvil::IO::read_file(in_filename,
+                              false, /* in_is_text_file */
+                             &data_ptr,
+                             &n_bytes) )
+    {
+        goto end;
+    }
+
+    if ((n_bytes % sizeof(uint32_t)) != 0)
+    {
+        goto end;
+    }
+
+    words.resize(n_bytes / sizeof(uint32_t) );
+
+    if (n_bytes > 0)
+    {
+        memcpy(&words.at(0),
+               data_ptr,
+               n_bytes);
+    }
+
+    result_ptr.reset(
+        new Anvil::PipelineManifest(in_mt_safe)
+    );
+
+    if (!result_ptr->load(words) )
+    {
+        result_ptr.reset();
+    }
+
+end:
+    delete [] data_ptr;
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+void Anvil::PipelineManifest::detach(Anvil::BasePipelineManager* in_pipeline_manager_ptr)
+{
+    lock();
+    {
+        auto manager_iterator = std::find(m_attached_pipeline_managers.begin(),
+                                          m_attached_pipeline_managers.end  (),
+                                          in_pipeline_manager_ptr);
+
+        anvil_assert(manager_iterator != m_attached_pipeline_managers.end() );
+
+        if (manager_iterator != m_attached_pipeline_managers.end() )
+        {
+            capture_usage(in_pipeline_manager_ptr);
+
+            m_attached_pipeline_managers.erase(manager_iterator);
+            m_tracked_pipelines.erase         (m_tracked_pipelines.lower_bound(TrackedPipelineKey(in_pipeline_manager_ptr, 0) ),
+                                               m_tracked_pipelines.upper_bound(TrackedPipelineKey(in_pipeline_manager_ptr, UINT32_MAX) ));
+        }
+    }
+    unlock();
+
+    in_pipeline_manager_ptr->unregister_from_callbacks(Anvil::BASE_PIPELINE_MANAGER_CALLBACK_ID_ON_NEW_PIPELINE_CREATED,
+                                                       std::bind(&PipelineManifest::on_new_pipeline,
+                                                                 this,
+                                                                 in_pipeline_manager_ptr,
+                                                                 std::placeholders::_1),
+                                                       this);
+}
+
+/** Please see header for specification */
+uint32_t Anvil::PipelineManifest::get_n_pipelines() const
+{
+    uint32_t result = 0;
+
+    lock();
+    {
+        result = static_cast<uint32_t>(m_pipelines.size() );
+    }
+    unlock();
+
+    return result;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::PipelineManifest::get_n_profiled_pipelines() const
+{
+    uint32_t result = 0;
+
+    lock();
+    {
+        for (const auto& current_pipeline_usage : m_pipeline_usage)
+        {
+            if (current_pipeline_usage.n_binds > 0)
+            {
+                ++result;
+            }
+        }
+    }
+    unlock();
+
+    return result;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::PipelineManifest::get_n_render_passes() const
+{
+    uint32_t result = 0;
+
+    lock();
+    {
+        result = static_cast<uint32_t>(m_render_passes.size() );
+    }
+    unlock();
+
+    return result;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::PipelineManifest::get_n_spirv_blobs() const
+{
+    uint32_t result = 0;
+
+    lock();
+    {
+        result = static_cast<uint32_t>(m_spirv_blobs.size() );
+    }
+    unlock();
+
+    return result;
+}
+
+/** Parses a serialized manifest and replaces the contents of this instance with it.
+ *
+ *  @param in_words Serialized manifest, as written by store_to_file().
+ *
+ *  @return true if successful, false if the data is malformed.
+ */
+bool Anvil::PipelineManifest::load(const Words& in_words)
+{
+    uint32_t   n_pipelines     = 0;
+    uint32_t   n_render_passes = 0;
+    uint32_t   n_spirv_blobs   = 0;
+    WordReader reader         (in_words.data(),
+                               in_words.size() );
+    bool       result          = false;
+    uint32_t   version         = 0;
+
+    if (reader.read() != g_manifest_magic)
+    {
+        goto end;
+    }
+
+    version = reader.read();
+
+    if (version != g_manifest_version               &&
+        version != g_manifest_version_without_usage)
+    {
+        goto end;
+    }
+
+    n_spirv_blobs   = reader.read();
+    n_render_passes = reader.read();
+    n_pipelines     = reader.read();
+
+    for (uint32_t n_spirv_blob = 0;
+                  n_spirv_blob < n_spirv_blobs && !reader.has_failed();
+                ++n_spirv_blob)
+    {
+        const uint64_t  hash      = reader.read_u64  ();
+        const uint32_t  n_words   = reader.read      ();
+        const uint32_t* words_ptr = reader.read_words(n_words);
+
+        if (words_ptr != nullptr)
+        {
+            m_spirv_blobs[hash] = Words(words_ptr,
+                                        words_ptr + n_words);
+        }
+    }
+
+    for (uint32_t n_render_pass = 0;
+                  n_render_pass < n_render_passes && !reader.has_failed();
+                ++n_render_pass)
+    {
+        const uint64_t  hash      = reader.read_u64  ();
+        const uint32_t  n_words   = reader.read      ();
+        const uint32_t* words_ptr = reader.read_words(n_words);
+
+        if (words_ptr != nullptr)
+        {
+            m_render_passes[hash] = Words(words_ptr,
+                                          words_ptr + n_words);
+        }
+    }
+
+    for (uint32_t n_pipeline = 0;
+                  n_pipeline < n_pipelines && !reader.has_failed();
+                ++n_pipeline)
+    {
+        const uint32_t  n_words   = reader.read      ();
+        const uint32_t* words_ptr = reader.read_words(n_words);
+
+        if (words_ptr != nullptr &&
+            n_words   >  0)
+        {
+            Words words(words_ptr,
+                        words_ptr + n_words);
+
+            m_pipeline_hashes[Anvil::Utils::hash64(&words.at(0),
+                                                   words.size() * sizeof(uint32_t) )] = static_cast<uint32_t>(m_pipelines.size() );
+
+            m_pipeline_usage.push_back(Anvil::BasePipelineManager::PipelineUsage() );
+            m_pipelines.push_back     (std::move(words) );
+        }
+    }
+
+    if (version != g_manifest_version_without_usage)
+    {
+        for (auto& current_pipeline_usage : m_pipeline_usage)
+        {
+            current_pipeline_usage.n_binds            = reader.read();
+            current_pipeline_usage.n_first_bind_frame = reader.read();
+        }
+    }
+
+    result = !reader.has_failed() &&
+              reader.is_at_end ();
+end:
+    return result;
+}
+
+/** Call-back handler for BASE_PIPELINE_MANAGER_CALLBACK_ID_ON_NEW_PIPELINE_CREATED. Records the new pipeline. */
+void Anvil::PipelineManifest::on_new_pipeline(Anvil::BasePipelineManager* in_pipeline_manager_ptr,
+                                              Anvil::CallbackArgument*    in_callback_arg_ptr)
+{
+    const auto callback_arg_ptr         = static_cast<const Anvil::OnNewPipelineCreatedCallbackData*>(in_callback_arg_ptr);
+    uint32_t   n_pipeline               = UINT32_MAX;
+    const auto pipeline_create_info_ptr = in_pipeline_manager_ptr->get_pipeline_create_info(callback_arg_ptr->new_pipeline_id);
+
+    if (pipeline_create_info_ptr != nullptr                   &&
+        add_pipeline(pipeline_create_info_ptr,
+                    &n_pipeline) )
+    {
+        /* Remember which recorded pipeline the ID maps to, so that capture_usage() can attribute the manager's
+         * bind statistics to it. */
+        lock();
+        {
+            m_tracked_pipelines.insert(std::make_pair(TrackedPipelineKey(in_pipeline_manager_ptr,
+                                                                         callback_arg_ptr->new_pipeline_id),
+                                                      TrackedPipeline   (n_pipeline) ));
+        }
+        unlock();
+    }
+}
+
+/** Serializes the specified pipeline. Render passes and SPIR-V blobs the pipeline references are recorded as well.
+ *
+ *  Must be called with the manifest locked.
+ *
+ *  @param in_pipeline_create_info_ptr Pipeline to serialize. Must not be null.
+ *  @param out_words_ptr               Deref will be set to the serialized pipeline. Must not be null.
+ *
+ *  @return true if successful, false if the pipeline type is not recognized.
+ */
+bool Anvil::PipelineManifest::record_pipeline(const Anvil::BasePipelineCreateInfo* in_pipeline_create_info_ptr,
+                                              Words*                               out_words_ptr)
+{
+    const auto compute_create_info_ptr = dynamic_cast<const Anvil::ComputePipelineCreateInfo*> (in_pipeline_create_info_ptr);
+    const auto gfx_create_info_ptr     = dynamic_cast<const Anvil::GraphicsPipelineCreateInfo*>(in_pipeline_create_info_ptr);
+    const auto ds_create_info_items    = in_pipeline_create_info_ptr->get_ds_create_info_items();
+    bool       result                  = false;
+    uint32_t   n_shader_stages         = 0;
+    size_t     n_shader_stages_offset  = 0;
+
+    out_words_ptr->clear();
+
+    if (compute_create_info_ptr != nullptr)
+    {
+        out_words_ptr->push_back(PIPELINE_TYPE_COMPUTE);
+    }
+    else
+    if (gfx_create_info_ptr != nullptr)
+    {
+        out_words_ptr->push_back(PIPELINE_TYPE_GRAPHICS);
+    }
+    else
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    out_words_ptr->push_back(in_pipeline_create_info_ptr->get_create_flags().get_vk() );
+
+    /* Render target configuration */
+    if (gfx_create_info_ptr != nullptr)
+    {
+        out_words_ptr->push_back(gfx_create_info_ptr->uses_dynamic_rendering() ? 1 : 0);
+
+        if (gfx_create_info_ptr->uses_dynamic_rendering() )
+        {
+            const Anvil::Format* color_formats_ptr      = nullptr;
+            Anvil::Format        depth_format           = Anvil::Format::UNKNOWN;
+            uint32_t             n_color_formats        = 0;
+            Anvil::Format        stencil_format         = Anvil::Format::UNKNOWN;
+            uint32_t             view_mask              = 0;
+
+            gfx_create_info_ptr->get_rendering_properties(&view_mask,
+                                                          &n_color_formats,
+                                                          &color_formats_ptr,
+                                                          &depth_format,
+                                                          &stencil_format);
+
+            out_words_ptr->push_back(view_mask);
+            out_words_ptr->push_back(n_color_formats);
+
+            for (uint32_t n_color_format = 0;
+                          n_color_format < n_color_formats;
+                        ++n_color_format)
+            {
+                out_words_ptr->push_back(static_cast<uint32_t>(color_formats_ptr[n_color_format]) );
+            }
+
+            out_words_ptr->push_back(static_cast<uint32_t>(depth_format) );
+            out_words_ptr->push_back(static_cast<uint32_t>(stencil_format) );
+        }
+        else
+        {
+            const auto render_pass_create_info_ptr = gfx_create_info_ptr->get_renderpass()->get_render_pass_create_info();
+
+            record_render_pass(render_pass_create_info_ptr);
+
+            write_u64               (render_pass_create_info_ptr->get_compatibility_hash(),
+                                     out_words_ptr);
+            out_words_ptr->push_back(gfx_create_info_ptr->get_subpass_id() );
+        }
+    }
+
+    /* Shader stages */
+    n_shader_stages_offset = out_words_ptr->size();
+
+    out_words_ptr->push_back(0);
+
+    for (uint32_t n_stage = static_cast<uint32_t>(Anvil::ShaderStage::FIRST);
+                  n_stage < static_cast<uint32_t>(Anvil::ShaderStage::COUNT);
+                ++n_stage)
+    {
+        const Anvil::SpecializationConstants* spec_constants_ptr      = nullptr;
+        const unsigned char*                  spec_constants_data_ptr = nullptr;
+        const auto                            stage                   = static_cast<Anvil::ShaderStage>(n_stage);
+        const Anvil::ShaderModuleStageEntryPoint* stage_entrypoint_ptr = nullptr;
+
+        if (!in_pipeline_create_info_ptr->get_shader_stage_properties(stage,
+                                                                     &stage_entrypoint_ptr) ||
+            stage_entrypoint_ptr->shader_module_ptr == nullptr)
+        {
+            continue;
+        }
+
+        record_shader_module(stage_entrypoint_ptr->shader_module_ptr);
+
+        out_words_ptr->push_back(n_stage);
+        write_u64               (stage_entrypoint_ptr->shader_module_ptr->get_spirv_blob_hash(),
+                                 out_words_ptr);
+
+        {
+            const auto& entrypoint_name = get_entrypoint_name(*stage_entrypoint_ptr);
+
+            write_data(entrypoint_name.c_str(),
+                       static_cast<uint32_t>(entrypoint_name.size() ),
+                       out_words_ptr);
+        }
+
+        if (in_pipeline_create_info_ptr->get_specialization_constants(stage,
+                                                                     &spec_constants_ptr,
+                                                                     &spec_constants_data_ptr) )
+        {
+            out_words_ptr->push_back(static_cast<uint32_t>(spec_constants_ptr->size() ));
+
+            for (const auto& current_spec_constant : *spec_constants_ptr)
+            {
+                out_words_ptr->push_back(current_spec_constant.constant_id);
+                write_data              (spec_constants_data_ptr + current_spec_constant.start_offset,
+                                         current_spec_constant.n_bytes,
+                                         out_words_ptr);
+            }
+        }
+        else
+        {
+            out_words_ptr->push_back(0);
+        }
+
+        ++n_shader_stages;
+    }
+
+    out_words_ptr->at(n_shader_stages_offset) = n_shader_stages;
+
+    /* Descriptor set layouts. Immutable samplers are not recorded. */
+    out_words_ptr->push_back(static_cast<uint32_t>(ds_create_info_items->size() ));
+
+    for (const auto& current_ds_create_info_ptr : *ds_create_info_items)
+    {
+        if (current_ds_create_info_ptr == nullptr)
+        {
+            out_words_ptr->push_back(0);
+
+            continue;
+        }
+
+        out_words_ptr->push_back(1);
+        out_words_ptr->push_back(current_ds_create_info_ptr->get_create_flags().get_vk() );
+        out_words_ptr->push_back(current_ds_create_info_ptr->get_n_bindings() );
+
+        for (uint32_t n_binding = 0;
+                      n_binding < current_ds_create_info_ptr->get_n_bindings();
+                    ++n_binding)
+        {
+            uint32_t                      binding_index   = 0;
+            Anvil::DescriptorBindingFlags binding_flags;
+            uint32_t                      descriptor_array_size = 0;
+            Anvil::DescriptorType         descriptor_type = Anvil::DescriptorType::UNKNOWN;
+            Anvil::ShaderStageFlags       stage_flags;
+
+            current_ds_create_info_ptr->get_binding_properties_by_index_number(n_binding,
+                                                                              &binding_index,
+                                                                              &descriptor_type,
+                                                                              &descriptor_array_size,
+                                                                              &stage_flags,
+                                                                               nullptr, /* out_opt_immutable_samplers_enabled_ptr */
+                                                                              &binding_flags);
+
+            out_words_ptr->push_back(binding_index);
+            out_words_ptr->push_back(static_cast<uint32_t>(descriptor_type) );
+            out_words_ptr->push_back(descriptor_array_size);
+            out_words_ptr->push_back(stage_flags.get_vk  () );
+            out_words_ptr->push_back(binding_flags.get_vk() );
+        }
+    }
+
+    /* Push constant ranges */
+    out_words_ptr->push_back(static_cast<uint32_t>(in_pipeline_create_info_ptr->get_push_constant_ranges().size() ));
+
+    for (const auto& current_range : in_pipeline_create_info_ptr->get_push_constant_ranges() )
+    {
+        out_words_ptr->push_back(current_range.offset);
+        out_words_ptr->push_back(current_range.size);
+        out_words_ptr->push_back(current_range.stages.get_vk() );
+    }
+
+    if (compute_create_info_ptr != nullptr)
+    {
+        out_words_ptr->push_back(compute_create_info_ptr->get_required_subgroup_size      () );
+        out_words_ptr->push_back(compute_create_info_ptr->get_require_full_subgroups      () ? 1 : 0);
+        out_words_ptr->push_back(compute_create_info_ptr->is_varying_subgroup_size_allowed() ? 1 : 0);
+    }
+    else
+    {
+        bool                         bool_values[2];
+        const float*                 blend_constant_ptr        = nullptr;
+        const Anvil::DynamicState*   dynamic_states_ptr        = nullptr;
+        float                        float_values[3];
+        Anvil::LogicOp               logic_op                  = Anvil::LogicOp::UNKNOWN;
+        uint32_t                     n_blend_attachments       = 0;
+        uint32_t                     n_dynamic_states          = 0;
+        uint32_t                     n_sample_locations        = 0;
+        uint32_t                     n_vertex_bindings         = 0;
+        Anvil::CompareOp             compare_op                = Anvil::CompareOp::UNKNOWN;
+        Anvil::CullModeFlags         cull_mode;
+        Anvil::FrontFace             front_face                = Anvil::FrontFace::UNKNOWN;
+        float                        line_width                = 0.0f;
+        Anvil::PolygonMode           polygon_mode              = Anvil::PolygonMode::UNKNOWN;
+        Anvil::SampleCountFlagBits   sample_count              = Anvil::SampleCountFlagBits::NONE;
+        VkExtent2D                   sample_location_grid_size = {0, 0};
+        const Anvil::SampleLocation* sample_locations_ptr      = nullptr;
+        Anvil::SampleCountFlagBits   sample_locations_per_pixel= Anvil::SampleCountFlagBits::NONE;
+        const VkSampleMask*          sample_mask_ptr           = nullptr;
+        Anvil::StencilOp             stencil_ops[6];
+        Anvil::CompareOp             stencil_compare_ops[2];
+        uint32_t                     stencil_values[6];
+
+        /* Input assembly & tessellation state */
+        out_words_ptr->push_back(static_cast<uint32_t>(gfx_create_info_ptr->get_primitive_topology() ));
+        out_words_ptr->push_back(gfx_create_info_ptr->is_primitive_restart_enabled() ? 1 : 0);
+        out_words_ptr->push_back(gfx_create_info_ptr->get_n_patch_control_points() );
+        out_words_ptr->push_back(static_cast<uint32_t>(gfx_create_info_ptr->get_tessellation_domain_origin() ));
+
+        /* Rasterization state */
+        gfx_create_info_ptr->get_rasterization_properties(&polygon_mode,
+                                                          &cull_mode,
+                                                          &front_face,
+                                                          &line_width);
+
+        out_words_ptr->push_back(static_cast<uint32_t>(polygon_mode) );
+        out_words_ptr->push_back(cull_mode.get_vk() );
+        out_words_ptr->push_back(static_cast<uint32_t>(front_face) );
+        write_float             (line_width,
+                                 out_words_ptr);
+        out_words_ptr->push_back(gfx_create_info_ptr->is_depth_clamp_enabled       () ? 1 : 0);
+        out_words_ptr->push_back(gfx_create_info_ptr->is_depth_clip_enabled        () ? 1 : 0);
+        out_words_ptr->push_back(gfx_create_info_ptr->is_rasterizer_discard_enabled() ? 1 : 0);
+        out_words_ptr->push_back(static_cast<uint32_t>(gfx_create_info_ptr->get_rasterization_order          () ));
+        out_words_ptr->push_back(static_cast<uint32_t>(gfx_create_info_ptr->get_conservative_rasterization_mode() ));
+        write_float             (gfx_create_info_ptr->get_extra_primitive_overestimation_size(),
+                                 out_words_ptr);
+        out_words_ptr->push_back(gfx_create_info_ptr->get_rasterization_stream_index() );
+
+        gfx_create_info_ptr->get_depth_bias_state(&bool_values[0],
+                                                  &float_values[0],
+                                                  &float_values[1],
+                                                  &float_values[2]);
+
+        out_words_ptr->push_back(bool_values[0] ? 1 : 0);
+        write_float             (float_values[0],
+                                 out_words_ptr);
+        write_float             (float_values[1],
+                                 out_words_ptr);
+        write_float             (float_values[2],
+                                 out_words_ptr);
+
+        /* Depth/stencil state */
+        gfx_create_info_ptr->get_depth_bounds_state(&bool_values[0],
+                                                    &float_values[0],
+                                                    &float_values[1]);
+
+        out_words_ptr->push_back(bool_values[0] ? 1 : 0);
+        write_float             (float_values[0],
+                                 out_words_ptr);
+        write_float             (float_values[1],
+                                 out_words_ptr);
+
+        gfx_create_info_ptr->get_depth_test_state(&bool_values[0],
+                                                  &compare_op);
+
+        out_words_ptr->push_back(bool_values[0] ? 1 : 0);
+        out_words_ptr->push_back(static_cast<uint32_t>(compare_op) );
+        out_words_ptr->push_back(gfx_create_info_ptr->are_depth_writes_enabled() ? 1 : 0);
+
+        gfx_create_info_ptr->get_stencil_test_properties(&bool_values[0],
+                                                         &stencil_ops[0],
+                                                         &stencil_ops[1],
+                                                         &stencil_ops[2],
+                                                         &stencil_compare_ops[0],
+                                                         &stencil_values[0],
+                                                         &stencil_values[1],
+                                                         &stencil_values[2],
+                                                         &stencil_ops[3],
+                                                         &stencil_ops[4],
+                                                         &stencil_ops[5],
+                                                         &stencil_compare_ops[1],
+                                                         &stencil_values[3],
+                                                         &stencil_values[4],
+                                                         &stencil_values[5]);
+
+        out_words_ptr->push_back(bool_values[0] ? 1 : 0);
+
+        for (uint32_t n_face = 0;
+                      n_face < 2;
+                    ++n_face)
+        {
+            out_words_ptr->push_back(static_cast<uint32_t>(stencil_ops[n_face * 3 + 0]) );
+            out_words_ptr->push_back(static_cast<uint32_t>(stencil_ops[n_face * 3 + 1]) );
+            out_words_ptr->push_back(static_cast<uint32_t>(stencil_ops[n_face * 3 + 2]) );
+            out_words_ptr->push_back(static_cast<uint32_t>(stencil_compare_ops[n_face]) );
+            out_words_ptr->push_back(stencil_values[n_face * 3 + 0]);
+            out_words_ptr->push_back(stencil_values[n_face * 3 + 1]);
+            out_words_ptr->push_back(stencil_values[n_face * 3 + 2]);
+        }
+
+        /* Multisample state */
+        gfx_create_info_ptr->get_multisampling_properties(&sample_count,
+                                                          &sample_mask_ptr);
+        gfx_create_info_ptr->get_sample_shading_state   (&bool_values[0],
+                                                          &float_values[0]);
+
+        out_words_ptr->push_back(static_cast<uint32_t>(sample_count) );
+        out_words_ptr->push_back(gfx_create_info_ptr->is_sample_mask_enabled() ? 1 : 0);
+        out_words_ptr->push_back(*sample_mask_ptr);
+        out_words_ptr->push_back(bool_values[0] ? 1 : 0);
+        write_float             (float_values[0],
+                                 out_words_ptr);
+        out_words_ptr->push_back(gfx_create_info_ptr->is_alpha_to_coverage_enabled() ? 1 : 0);
+        out_words_ptr->push_back(gfx_create_info_ptr->is_alpha_to_one_enabled     () ? 1 : 0);
+
+        gfx_create_info_ptr->get_sample_location_state(&bool_values[0],
+                                                       &sample_locations_per_pixel,
+                                                       &sample_location_grid_size,
+                                                       &n_sample_locations,
+                                                       &sample_locations_ptr);
+
+        out_words_ptr->push_back(bool_values[0] ? 1 : 0);
+        out_words_ptr->push_back(static_cast<uint32_t>(sample_locations_per_pixel) );
+        out_words_ptr->push_back(sample_location_grid_size.width);
+        out_words_ptr->push_back(sample_location_grid_size.height);
+        out_words_ptr->push_back(n_sample_locations);
+
+        for (uint32_t n_sample_location = 0;
+                      n_sample_location < n_sample_locations;
+                    ++n_sample_location)
+        {
+            write_float(sample_locations_ptr[n_sample_location].x,
+                        out_words_ptr);
+            write_float(sample_locations_ptr[n_sample_location].y,
+                        out_words_ptr);
+        }
+
+        /* Color blend state */
+        gfx_create_info_ptr->get_logic_op_state     (&bool_values[0],
+                                                     &logic_op);
+        gfx_create_info_ptr->get_blending_properties(&blend_constant_ptr,
+                                                     &n_blend_attachments);
+
+        out_words_ptr->push_back(bool_values[0] ? 1 : 0);
+        out_words_ptr->push_back(static_cast<uint32_t>(logic_op) );
+
+        for (uint32_t n_component = 0;
+                      n_component < 4;
+                    ++n_component)
+        {
+            write_float(blend_constant_ptr[n_component],
+                        out_words_ptr);
+        }
+
+        out_words_ptr->push_back(n_blend_attachments);
+
+        /* Attachment IDs need not be contiguous, so probe them until all attachments are found. */
+        for (uint32_t attachment_id = 0, n_blend_attachments_found = 0;
+                      n_blend_attachments_found < n_blend_attachments;
+                    ++attachment_id)
+        {
+            Anvil::BlendOp             blend_ops    [2];
+            Anvil::BlendFactor         blend_factors[4];
+            Anvil::ColorComponentFlags write_mask;
+
+            if (!gfx_create_info_ptr->get_color_blend_attachment_properties(attachment_id,
+                                                                           &bool_values[0],
+                                                                           &blend_ops[0],
+                                                                           &blend_ops[1],
+                                                                           &blend_factors[0],
+                                                                           &blend_factors[1],
+                                                                           &blend_factors[2],
+                                                                           &blend_factors[3],
+                                                                           &write_mask) )
+            {
+                continue;
+            }
+
+            out_words_ptr->push_back(attachment_id);
+            out_words_ptr->push_back(bool_values[0] ? 1 : 0);
+            out_words_ptr->push_back(static_cast<uint32_t>(blend_ops[0]) );
+            out_words_ptr->push_back(static_cast<uint32_t>(blend_ops[1]) );
+            out_words_ptr->push_back(static_cast<uint32_t>(blend_factors[0]) );
+            out_words_ptr->push_back(static_cast<uint32_t>(blend_factors[1]) );
+            out_words_ptr->push_back(static_cast<uint32_t>(blend_factors[2]) );
+            out_words_ptr->push_back(static_cast<uint32_t>(blend_factors[3]) );
+            out_words_ptr->push_back(write_mask.get_vk() );
+
+            ++n_blend_attachments_found;
+        }
+
+        /* Dynamic state */
+        gfx_create_info_ptr->get_enabled_dynamic_states(&dynamic_states_ptr,
+                                                        &n_dynamic_states);
+
+        out_words_ptr->push_back(n_dynamic_states);
+
+        for (uint32_t n_dynamic_state = 0;
+                      n_dynamic_state < n_dynamic_states;
+                    ++n_dynamic_state)
+        {
+            out_words_ptr->push_back(static_cast<uint32_t>(dynamic_states_ptr[n_dynamic_state]) );
+        }
+
+        out_words_ptr->push_back(gfx_create_info_ptr->get_n_dynamic_scissor_boxes() );
+        out_words_ptr->push_back(gfx_create_info_ptr->get_n_dynamic_viewports    () );
+
+        /* Viewport state */
+        out_words_ptr->push_back(gfx_create_info_ptr->get_n_viewports() );
+
+        for (uint32_t n_viewport = 0;
+                      n_viewport < gfx_create_info_ptr->get_n_viewports();
+                    ++n_viewport)
+        {
+            float viewport_values[6];
+
+            gfx_create_info_ptr->get_viewport_properties(n_viewport,
+                                                        &viewport_values[0],
+                                                        &viewport_values[1],
+                                                        &viewport_values[2],
+                                                        &viewport_values[3],
+                                                        &viewport_values[4],
+                                                        &viewport_values[5]);
+
+            for (const auto& current_value : viewport_values)
+            {
+                write_float(current_value,
+                            out_words_ptr);
+            }
+        }
+
+        out_words_ptr->push_back(gfx_create_info_ptr->get_n_scissor_boxes() );
+
+        for (uint32_t n_scissor_box = 0;
+                      n_scissor_box < gfx_create_info_ptr->get_n_scissor_boxes();
+                    ++n_scissor_box)
+        {
+            int32_t  x      = 0;
+            int32_t  y      = 0;
+            uint32_t width  = 0;
+            uint32_t height = 0;
+
+            gfx_create_info_ptr->get_scissor_box_properties(n_scissor_box,
+                                                           &x,
+                                                           &y,
+                                                           &width,
+                                                           &height);
+
+            out_words_ptr->push_back(static_cast<uint32_t>(x) );
+            out_words_ptr->push_back(static_cast<uint32_t>(y) );
+            out_words_ptr->push_back(width);
+            out_words_ptr->push_back(height);
+        }
+
+        /* Shading rate image state. Palettes are stored per viewport index, including viewports which are only
+         * defined dynamically. */
+        {
+            const uint32_t n_palette_slots = std::max(gfx_create_info_ptr->get_n_viewports        (),
+                                                      gfx_create_info_ptr->get_n_dynamic_viewports() );
+
+            out_words_ptr->push_back(gfx_create_info_ptr->is_shading_rate_image_enabled() ? 1 : 0);
+            out_words_ptr->push_back(n_palette_slots);
+
+            for (uint32_t n_viewport = 0;
+                          n_viewport < n_palette_slots;
+                        ++n_viewport)
+            {
+                const Anvil::ShadingRatePaletteEntryNV* entries_ptr = nullptr;
+                uint32_t                                n_entries   = 0;
+
+                gfx_create_info_ptr->get_shading_rate_palette(n_viewport,
+                                                             &n_entries,
+                                                             &entries_ptr);
+
+                out_words_ptr->push_back(n_entries);
+
+                for (uint32_t n_entry = 0;
+                              n_entry < n_entries;
+                            ++n_entry)
+                {
+                    out_words_ptr->push_back(static_cast<uint32_t>(entries_ptr[n_entry]) );
+                }
+            }
+        }
+
+        /* Vertex input state */
+        gfx_create_info_ptr->get_graphics_pipeline_properties(nullptr, /* out_opt_n_scissors_ptr     */
+                                                              nullptr, /* out_opt_n_viewports_ptr    */
+                                                             &n_vertex_bindings,
+                                                              nullptr, /* out_opt_renderpass_ptr_ptr */
+                                                              nullptr);/* out_opt_subpass_id_ptr     */
+
+        out_words_ptr->push_back(n_vertex_bindings);
+
+        for (uint32_t n_vertex_binding = 0;
+                      n_vertex_binding < n_vertex_bindings;
+                    ++n_vertex_binding)
+        {
+            const Anvil::VertexInputAttribute* attributes_ptr = nullptr;
+            uint32_t                           binding        = 0;
+            uint32_t                           divisor        = 1;
+            uint32_t                           n_attributes   = 0;
+            Anvil::VertexInputRate             rate           = Anvil::VertexInputRate::UNKNOWN;
+            uint32_t                           stride         = 0;
+
+            gfx_create_info_ptr->get_vertex_binding_properties(n_vertex_binding,
+                                                              &binding,
+                                                              &stride,
+                                                              &rate,
+                                                              &n_attributes,
+                                                              &attributes_ptr,
+                                                              &divisor);
+
+            out_words_ptr->push_back(binding);
+            out_words_ptr->push_back(stride);
+            out_words_ptr->push_back(static_cast<uint32_t>(rate) );
+            out_words_ptr->push_back(divisor);
+            out_words_ptr->push_back(n_attributes);
+
+            for (uint32_t n_attribute = 0;
+                          n_attribute < n_attributes;
+                        ++n_attribute)
+            {
+                out_words_ptr->push_back(attributes_ptr[n_attribute].location);
+                out_words_ptr->push_back(static_cast<uint32_t>(attributes_ptr[n_attribute].format) );
+                out_words_ptr->push_back(attributes_ptr[n_attribute].offset_in_bytes);
+            }
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Records the description of the specified render pass, unless a compatible render pass has already been recorded.
+ *
+ *  Must be called with the manifest locked.
+ */
+void Anvil::PipelineManifest::record_render_pass(const Anvil::RenderPassCreateInfo* in_render_pass_create_info_ptr)
+{
+    const uint64_t hash                 = in_render_pass_create_info_ptr->get_compatibility_hash();
+    const bool     is_multiview_enabled = in_render_pass_create_info_ptr->is_multiview_enabled();
+    Words          words;
+
+    if (m_render_passes.find(hash) != m_render_passes.end() )
+    {
+        return;
+    }
+
+    /* Attachments. IDs are assigned sequentially, so attachments are stored in ID order. */
+    words.push_back(in_render_pass_create_info_ptr->get_n_attachments() );
+
+    for (uint32_t n_attachment = 0;
+                  n_attachment < in_render_pass_create_info_ptr->get_n_attachments();
+                ++n_attachment)
+    {
+        Anvil::AttachmentType      attachment_type  = Anvil::AttachmentType::UNKNOWN;
+        Anvil::Format              format           = Anvil::Format::UNKNOWN;
+        Anvil::ImageLayout         final_layout     = Anvil::ImageLayout::UNKNOWN;
+        Anvil::ImageLayout         initial_layout   = Anvil::ImageLayout::UNKNOWN;
+        Anvil::AttachmentLoadOp    load_op          = Anvil::AttachmentLoadOp::UNKNOWN;
+        bool                       may_alias        = false;
+        Anvil::SampleCountFlagBits sample_count     = Anvil::SampleCountFlagBits::NONE;
+        Anvil::AttachmentLoadOp    stencil_load_op  = Anvil::AttachmentLoadOp::UNKNOWN;
+        Anvil::AttachmentStoreOp   stencil_store_op = Anvil::AttachmentStoreOp::UNKNOWN;
+        Anvil::AttachmentStoreOp   store_op         = Anvil::AttachmentStoreOp::UNKNOWN;
+
+        in_render_pass_create_info_ptr->get_attachment_type(n_attachment,
+                                                           &attachment_type);
+
+        if (attachment_type == Anvil::AttachmentType::COLOR)
+        {
+            in_render_pass_create_info_ptr->get_color_attachment_properties(n_attachment,
+                                                                           &format,
+                                                                           &sample_count,
+                                                                           &load_op,
+                                                                           &store_op,
+                                                                           &initial_layout,
+                                                                           &final_layout,
+                                                                           &may_alias);
+        }
+        else
+        {
+            in_render_pass_create_info_ptr->get_depth_stencil_attachment_properties(n_attachment,
+                                                                                   &format,
+                                                                                   &sample_count,
+                                                                                   &load_op,
+                                                                                   &store_op,
+                                                                                   &stencil_load_op,
+                                                                                   &stencil_store_op,
+                                                                                   &initial_layout,
+                                                                                   &final_layout,
+                                                                                   &may_alias);
+        }
+
+        words.push_back(n_attachment);
+        words.push_back(static_cast<uint32_t>(attachment_type) );
+        words.push_back(static_cast<uint32_t>(format) );
+        words.push_back(static_cast<uint32_t>(sample_count) );
+        words.push_back(static_cast<uint32_t>(load_op) );
+        words.push_back(static_cast<uint32_t>(store_op) );
+        words.push_back(static_cast<uint32_t>(stencil_load_op) );
+        words.push_back(static_cast<uint32_t>(stencil_store_op) );
+        words.push_back(static_cast<uint32_t>(initial_layout) );
+        words.push_back(static_cast<uint32_t>(final_layout) );
+        words.push_back(may_alias ? 1 : 0);
+    }
+
+    /* Subpasses. Preserved attachments are derived by the render pass, so they do not need to be recorded. */
+    words.push_back(in_render_pass_create_info_ptr->get_n_subpasses() );
+
+    for (Anvil::SubPassID subpass_id = 0;
+                          subpass_id < in_render_pass_create_info_ptr->get_n_subpasses();
+                        ++subpass_id)
+    {
+        uint32_t                      n_attachments          = 0;
+        Anvil::RenderPassAttachmentID ds_attachment_id       = UINT32_MAX;
+        Anvil::ImageLayout            ds_layout              = Anvil::ImageLayout::UNKNOWN;
+        Anvil::ResolveModeFlagBits    ds_depth_resolve_mode  = Anvil::ResolveModeFlagBits::NONE;
+        Anvil::RenderPassAttachmentID ds_resolve_id          = UINT32_MAX;
+        Anvil::ResolveModeFlagBits    ds_stencil_resolve_mode= Anvil::ResolveModeFlagBits::NONE;
+        uint32_t                      view_mask              = 0;
+
+        in_render_pass_create_info_ptr->get_subpass_n_attachments(subpass_id,
+                                                                  Anvil::AttachmentType::COLOR,
+                                                                 &n_attachments);
+
+        words.push_back(n_attachments);
+
+        for (uint32_t n_attachment = 0;
+                      n_attachment < n_attachments;
+                    ++n_attachment)
+        {
+            Anvil::RenderPassAttachmentID attachment_id = UINT32_MAX;
+            Anvil::ImageLayout            layout        = Anvil::ImageLayout::UNKNOWN;
+            uint32_t                      location      = 0;
+            Anvil::RenderPassAttachmentID resolve_id    = UINT32_MAX;
+
+            in_render_pass_create_info_ptr->get_subpass_attachment_properties(subpass_id,
+                                                                              Anvil::AttachmentType::COLOR,
+                                                                              n_attachment,
+                                                                             &attachment_id,
+                                                                             &layout,
+                                                                              nullptr, /* out_opt_aspects_accessed_ptr */
+                                                                             &resolve_id,
+                                                                             &location);
+
+            words.push_back(static_cast<uint32_t>(layout) );
+            words.push_back(attachment_id);
+            words.push_back(location);
+            words.push_back(resolve_id);
+        }
+
+        in_render_pass_create_info_ptr->get_subpass_n_attachments(subpass_id,
+                                                                  Anvil::AttachmentType::INPUT,
+                                                                 &n_attachments);
+
+        words.push_back(n_attachments);
+
+        for (uint32_t n_attachment = 0;
+                      n_attachment < n_attachments;
+                    ++n_attachment)
+        {
+            Anvil::ImageAspectFlags       aspects_accessed;
+            Anvil::RenderPassAttachmentID attachment_id    = UINT32_MAX;
+            uint32_t                      attachment_index = 0;
+            Anvil::ImageLayout            layout           = Anvil::ImageLayout::UNKNOWN;
+
+            in_render_pass_create_info_ptr->get_subpass_attachment_properties(subpass_id,
+                                                                              Anvil::AttachmentType::INPUT,
+                                                                              n_attachment,
+                                                                             &attachment_id,
+                                                                             &layout,
+                                                                             &aspects_accessed,
+                                                                              nullptr, /* out_opt_attachment_resolve_id_ptr */
+                                                                             &attachment_index);
+
+            words.push_back(static_cast<uint32_t>(layout) );
+            words.push_back(attachment_id);
+            words.push_back(attachment_index);
+            words.push_back(aspects_accessed.get_vk() );
+        }
+
+        in_render_pass_create_info_ptr->get_subpass_n_attachments(subpass_id,
+                                                                  Anvil::AttachmentType::DEPTH_STENCIL,
+                                                                 &n_attachments);
+
+        words.push_back(n_attachments);
+
+        if (n_attachments > 0)
+        {
+            in_render_pass_create_info_ptr->get_subpass_attachment_properties(subpass_id,
+                                                                              Anvil::AttachmentType::DEPTH_STENCIL,
+                                                                              0, /* in_n_subpass_attachment */
+                                                                             &ds_attachment_id,
+                                                                             &ds_layout);
+
+            if (!in_render_pass_create_info_ptr->get_subpass_ds_resolve_attachment_properties(subpass_id,
+                                                                                             &ds_resolve_id,
+                                                                                              nullptr, /* out_opt_layout_ptr */
+                                                                                             &ds_depth_resolve_mode,
+                                                                                             &ds_stencil_resolve_mode) )
+            {
+                ds_resolve_id = UINT32_MAX;
+            }
+
+            words.push_back(static_cast<uint32_t>(ds_layout) );
+            words.push_back(ds_attachment_id);
+            words.push_back(ds_resolve_id);
+            words.push_back(static_cast<uint32_t>(ds_depth_resolve_mode) );
+            words.push_back(static_cast<uint32_t>(ds_stencil_resolve_mode) );
+        }
+
+        if (is_multiview_enabled)
+        {
+            in_render_pass_create_info_ptr->get_subpass_view_mask(subpass_id,
+                                                                 &view_mask);
+
+            words.push_back(1);
+            words.push_back(view_mask);
+        }
+        else
+        {
+            words.push_back(0);
+        }
+    }
+
+    /* Dependencies */
+    words.push_back(in_render_pass_create_info_ptr->get_n_dependencies() );
+
+    for (uint32_t n_dependency = 0;
+                  n_dependency < in_render_pass_create_info_ptr->get_n_dependencies();
+                ++n_dependency)
+    {
+        Anvil::AccessFlags        dst_access_mask;
+        Anvil::PipelineStageFlags dst_stage_mask;
+        Anvil::SubPassID          dst_subpass_id  = UINT32_MAX;
+        Anvil::DependencyFlags    flags;
+        Anvil::AccessFlags        src_access_mask;
+        Anvil::PipelineStageFlags src_stage_mask;
+        Anvil::SubPassID          src_subpass_id  = UINT32_MAX;
+        int32_t                   view_offset     = 0;
+
+        in_render_pass_create_info_ptr->get_dependency_properties(n_dependency,
+                                                                 &dst_subpass_id,
+                                                                 &src_subpass_id,
+                                                                 &dst_stage_mask,
+                                                                 &src_stage_mask,
+                                                                 &dst_access_mask,
+                                                                 &src_access_mask,
+                                                                 &flags);
+
+        words.push_back(dst_subpass_id);
+        words.push_back(src_subpass_id);
+        words.push_back(dst_stage_mask.get_vk () );
+        words.push_back(src_stage_mask.get_vk () );
+        words.push_back(dst_access_mask.get_vk() );
+        words.push_back(src_access_mask.get_vk() );
+        words.push_back(flags.get_vk          () );
+
+        if (is_multiview_enabled                                                             &&
+            in_render_pass_create_info_ptr->get_dependency_multiview_properties(n_dependency,
+                                                                               &view_offset) &&
+            view_offset != 0)
+        {
+            words.push_back(1);
+            words.push_back(static_cast<uint32_t>(view_offset) );
+        }
+        else
+        {
+            words.push_back(0);
+            words.push_back(0);
+        }
+    }
+
+    /* Multiview correlation masks */
+    if (is_multiview_enabled)
+    {
+        const uint32_t* correlation_masks_ptr = nullptr;
+        uint32_t        n_correlation_masks   = 0;
+
+        in_render_pass_create_info_ptr->get_multiview_correlation_masks(&n_correlation_masks,
+                                                                        &correlation_masks_ptr);
+
+        words.push_back(n_correlation_masks);
+        words.insert   (words.end(),
+                        correlation_masks_ptr,
+                        correlation_masks_ptr + n_correlation_masks);
+    }
+    else
+    {
+        words.push_back(0);
+    }
+
+    m_render_passes[hash] = std::move(words);
+}
+
+/** Records the SPIR-V blob of the specified shader module, unless it has already been recorded.
+ *
+ *  Must be called with the manifest locked.
+ */
+void Anvil::PipelineManifest::record_shader_module(const Anvil::ShaderModule* in_shader_module_ptr)
+{
+    const uint64_t hash = in_shader_module_ptr->get_spirv_blob_hash();
+
+    if (m_spirv_blobs.find(hash) == m_spirv_blobs.end() )
+    {
+        m_spirv_blobs[hash] = in_shader_module_ptr->get_spirv_blob();
+    }
+}
+
+/** Please see header for specification */
+bool Anvil::PipelineManifest::replay(Anvil::BaseDevice*    in_device_ptr,
+                                     Anvil::PipelineCache* in_opt_pipeline_cache_ptr,
+                                     uint32_t*             out_opt_n_pipelines_baked_ptr) const
+{
+    typedef std::tuple<uint64_t, Anvil::ShaderStage, std::string> ShaderModuleKey;
+
+    struct StageInfo
+    {
+        Anvil::ShaderModuleStageEntryPoint                             entrypoint;
+        std::vector<std::pair<uint32_t, std::vector<unsigned char> > > specialization_constants;
+    };
+
+    /* NOTE: Shader modules & render passes are referenced by the pipeline create info structures owned by the pipeline
+     *       managers, so they must outlive the managers. */
+    std::map<uint64_t, Anvil::RenderPassUniquePtr>                          render_passes;
+    std::map<ShaderModuleKey, Anvil::ShaderModuleUniquePtr>                 shader_modules;
+    std::unique_ptr<Anvil::ComputePipelineManager>                          compute_pipeline_manager_ptr;
+    Anvil::GraphicsPipelineManagerUniquePtr                                 gfx_pipeline_manager_ptr;
+    uint32_t                                                                n_pipelines_baked  = 0;
+    Anvil::PipelineCache*                                                   pipeline_cache_ptr = nullptr;
+    std::vector<uint32_t>                                                   pipeline_order;
+    std::vector<std::pair<Anvil::BasePipelineManager*, Anvil::PipelineID> > pipelines;
+    bool                                                                    result             = true;
+
+    anvil_assert(in_device_ptr != nullptr);
+
+    pipeline_cache_ptr = (in_opt_pipeline_cache_ptr != nullptr) ? in_opt_pipeline_cache_ptr
+                                                                : in_device_ptr->get_pipeline_cache();
+
+    compute_pipeline_manager_ptr = Anvil::ComputePipelineManager::create (in_device_ptr,
+                                                                          false, /* in_mt_safe            */
+                                                                          true,  /* in_use_pipeline_cache */
+                                                                          pipeline_cache_ptr);
+    gfx_pipeline_manager_ptr     = Anvil::GraphicsPipelineManager::create(in_device_ptr,
+                                                                          false, /* in_mt_safe            */
+                                                                          true,  /* in_use_pipeline_cache */
+                                                                          pipeline_cache_ptr);
+
+    if (compute_pipeline_manager_ptr == nullptr ||
+        gfx_pipeline_manager_ptr     == nullptr)
+    {
+        anvil_assert_fail();
+
+        result = false;
+        goto end;
+    }
+
+    lock();
+
+    /* Create the pipelines needed first and most often first. Pipelines are baked in the order they have been added
+     * to the managers. */
+    for (uint32_t n_pipeline = 0;
+                  n_pipeline < static_cast<uint32_t>(m_pipelines.size() );
+                ++n_pipeline)
+    {
+        pipeline_order.push_back(n_pipeline);
+    }
+
+    std::stable_sort(pipeline_order.begin(),
+                     pipeline_order.end  (),
+                     [this](uint32_t in_n_pipeline_a,
+                            uint32_t in_n_pipeline_b)
+                     {
+                         const auto& usage_a = m_pipeline_usage.at(in_n_pipeline_a);
+                         const auto& usage_b = m_pipeline_usage.at(in_n_pipeline_b);
+
+                         if (usage_a.n_first_bind_frame != usage_b.n_first_bind_frame)
+                         {
+                             return usage_a.n_first_bind_frame < usage_b.n_first_bind_frame;
+                         }
+
+                         return usage_a.n_binds > usage_b.n_binds;
+                     });
+
+    for (const auto& current_n_pipeline : pipeline_order)
+    {
+        const Words&                                         current_pipeline_words = m_pipelines.at(current_n_pipeline);
+        std::vector<Anvil::Format>                           color_formats;
+        Anvil::BasePipelineCreateInfoUniquePtr               create_info_ptr;
+        Anvil::Format                                        depth_format           = Anvil::Format::UNKNOWN;
+        std::vector<Anvil::DescriptorSetCreateInfoUniquePtr> ds_create_info_ptrs;
+        std::vector<const Anvil::DescriptorSetCreateInfo*>   ds_create_info_raw_ptrs;
+        uint32_t                                             n_ds_create_infos      = 0;
+        uint32_t                                             n_push_constant_ranges = 0;
+        uint32_t                                             n_stages               = 0;
+        Anvil::PipelineCreateFlags                           pipeline_create_flags;
+        Anvil::PipelineID                                    pipeline_id            = UINT32_MAX;
+        Anvil::BasePipelineManager*                          pipeline_manager_ptr   = nullptr;
+        uint32_t                                             pipeline_type          = 0;
+        WordReader                                           reader                (current_pipeline_words.data(),
+                                                                                    current_pipeline_words.size() );
+        uint64_t                                             render_pass_hash       = 0;
+        std::map<Anvil::ShaderStage, StageInfo>              stages;
+        Anvil::Format                                        stencil_format         = Anvil::Format::UNKNOWN;
+        Anvil::SubPassID                                     subpass_id             = 0;
+        bool                                                 success                = true;
+        bool                                                 uses_dynamic_rendering = false;
+        uint32_t                                             view_mask              = 0;
+
+        /* The base pipeline is not recorded, so replay derivative pipelines as regular ones. */
+        pipeline_type         = reader.read();
+        pipeline_create_flags = Anvil::PipelineCreateFlags(static_cast<Anvil::PipelineCreateFlagBits>(reader.read() & ~static_cast<uint32_t>(VK_PIPELINE_CREATE_DERIVATIVE_BIT) ));
+
+        /* Render target configuration */
+        if (pipeline_type == PIPELINE_TYPE_GRAPHICS)
+        {
+            uses_dynamic_rendering = (reader.read() != 0);
+
+            if (uses_dynamic_rendering)
+            {
+                uint32_t n_color_formats = 0;
+
+                view_mask       = reader.read();
+                n_color_formats = reader.read();
+
+                for (uint32_t n_color_format = 0;
+                              n_color_format < n_color_formats && !reader.has_failed();
+                            ++n_color_format)
+                {
+                    color_formats.push_back(static_cast<Anvil::Format>(reader.read() ));
+                }
+
+                depth_format   = static_cast<Anvil::Format>(reader.read() );
+                stencil_format = static_cast<Anvil::Format>(reader.read() );
+            }
+            else
+            {
+                render_pass_hash = reader.read_u64();
+                subpass_id       = reader.read    ();
+            }
+        }
+
+        /* Shader stages */
+        n_stages = reader.read();
+
+        for (uint32_t n_stage = 0;
+                      n_stage < n_stages && !reader.has_failed() && success;
+                    ++n_stage)
+        {
+            const auto       stage                       = static_cast<Anvil::ShaderStage>(reader.read() );
+            const uint64_t   spirv_blob_hash             = reader.read_u64   ();
+            const auto       entrypoint_name             = reader.read_string();
+            const uint32_t   n_specialization_constants  = reader.read       ();
+            const auto       shader_module_key           = ShaderModuleKey   (spirv_blob_hash,
+                                                                              stage,
+                                                                              entrypoint_name);
+            auto             shader_module_iterator      = shader_modules.find(shader_module_key);
+            StageInfo        stage_info;
+
+            if (shader_module_iterator == shader_modules.end() )
+            {
+                const auto spirv_blob_iterator = m_spirv_blobs.find(spirv_blob_hash);
+
+                if (spirv_blob_iterator == m_spirv_blobs.end() ||
+                    spirv_blob_iterator->second.empty() )
+                {
+                    success = false;
+
+                    break;
+                }
+
+                shader_modules[shader_module_key] = Anvil::ShaderModule::create_from_spirv_blob(in_device_ptr,
+                                                                                                &spirv_blob_iterator->second.at(0),
+                                                                                                static_cast<uint32_t>(spirv_blob_iterator->second.size() ),
+                                                                                                (stage == Anvil::ShaderStage::COMPUTE)                 ? entrypoint_name : std::string(),
+                                                                                                (stage == Anvil::ShaderStage::FRAGMENT)                ? entrypoint_name : std::string(),
+                                                                                                (stage == Anvil::ShaderStage::GEOMETRY)                ? entrypoint_name : std::string(),
+                                                                                                (stage == Anvil::ShaderStage::TESSELLATION_CONTROL)    ? entrypoint_name : std::string(),
+                                                                                                (stage == Anvil::ShaderStage::TESSELLATION_EVALUATION) ? entrypoint_name : std::string(),
+                                                                                                (stage == Anvil::ShaderStage::VERTEX)                  ? entrypoint_name : std::string() );
+
+                shader_module_iterator = shader_modules.find(shader_module_key);
+            }
+
+            if (shader_module_iterator->second == nullptr)
+            {
+                success = false;
+
+                break;
+            }
+
+            stage_info.entrypoint = Anvil::ShaderModuleStageEntryPoint(entrypoint_name,
+                                                                       shader_module_iterator->second.get(),
+                                                                       stage);
+
+            for (uint32_t n_specialization_constant = 0;
+                          n_specialization_constant < n_specialization_constants && !reader.has_failed();
+                        ++n_specialization_constant)
+            {
+                std::vector<unsigned char> data;
+                const uint32_t             constant_id = reader.read();
+
+                reader.read_data(reader.read(),
+                                &data);
+
+                stage_info.specialization_constants.push_back(
+                    std::make_pair(constant_id,
+                                   std::move(data) )
+                );
+            }
+
+            stages[stage] = std::move(stage_info);
+        }
+
+        /* Descriptor set layouts */
+        n_ds_create_infos = reader.read();
+
+        for (uint32_t n_ds_create_info = 0;
+                      n_ds_create_info < n_ds_create_infos && !reader.has_failed();
+                    ++n_ds_create_info)
+        {
+            Anvil::DescriptorSetCreateInfoUniquePtr ds_create_info_ptr;
+            uint32_t                                n_bindings = 0;
+
+            if (reader.read() == 0)
+            {
+                ds_create_info_raw_ptrs.push_back(nullptr);
+
+                continue;
+            }
+
+            ds_create_info_ptr = Anvil::DescriptorSetCreateInfo::create();
+
+            ds_create_info_ptr->set_create_flags(Anvil::DescriptorSetLayoutCreateFlags(static_cast<Anvil::DescriptorSetLayoutCreateFlagBits>(reader.read() )));
+
+            n_bindings = reader.read();
+
+            for (uint32_t n_binding = 0;
+                          n_binding < n_bindings && !reader.has_failed();
+                        ++n_binding)
+            {
+                const uint32_t binding_index         = reader.read();
+                const auto     descriptor_type       = static_cast<Anvil::DescriptorType>(reader.read() );
+                const uint32_t descriptor_array_size = reader.read();
+                const auto     stage_flags           = Anvil::ShaderStageFlags      (static_cast<Anvil::ShaderStageFlagBits>      (reader.read() ));
+                const auto     binding_flags         = Anvil::DescriptorBindingFlags(static_cast<Anvil::DescriptorBindingFlagBits>(reader.read() ));
+
+                success &= ds_create_info_ptr->add_binding(binding_index,
+                                                           descriptor_type,
+                                                           descriptor_array_size,
+                                                           stage_flags,
+                                                           binding_flags);
+            }
+
+            ds_create_info_raw_ptrs.push_back(ds_create_info_ptr.get() );
+            ds_create_info_ptrs.push_back    (std::move(ds_create_info_ptr) );
+        }
+
+        if (!success            ||
+            reader.has_failed() )
+        {
+            result = false;
+
+            continue;
+        }
+
+        if (pipeline_type == PIPELINE_TYPE_COMPUTE)
+        {
+            const auto compute_stage_iterator = stages.find(Anvil::ShaderStage::COMPUTE);
+
+            if (compute_stage_iterator == stages.end() )
+            {
+                result = false;
+
+                continue;
+            }
+
+            create_info_ptr      = Anvil::ComputePipelineCreateInfo::create(pipeline_create_flags,
+                                                                            compute_stage_iterator->second.entrypoint);
+            pipeline_manager_ptr = compute_pipeline_manager_ptr.get();
+        }
+        else
+        if (pipeline_type == PIPELINE_TYPE_GRAPHICS)
+        {
+            Anvil::ShaderModuleStageEntryPoint entrypoints[sizeof(g_graphics_shader_stages) / sizeof(g_graphics_shader_stages[0])];
+
+            for (uint32_t n_gfx_stage = 0;
+                          n_gfx_stage < sizeof(g_graphics_shader_stages) / sizeof(g_graphics_shader_stages[0]);
+                        ++n_gfx_stage)
+            {
+                const auto stage_iterator = stages.find(g_graphics_shader_stages[n_gfx_stage]);
+
+                if (stage_iterator != stages.end() )
+                {
+                    entrypoints[n_gfx_stage] = stage_iterator->second.entrypoint;
+                }
+            }
+
+            pipeline_manager_ptr = gfx_pipeline_manager_ptr.get();
+
+            if (uses_dynamic_rendering)
+            {
+                create_info_ptr = Anvil::GraphicsPipelineCreateInfo::create_for_dynamic_rendering(pipeline_create_flags,
+                                                                                                  view_mask,
+                                                                                                  static_cast<uint32_t>(color_formats.size() ),
+                                                                                                  (color_formats.size() > 0) ? &color_formats.at(0) : nullptr,
+                                                                                                  depth_format,
+                                                                                                  stencil_format,
+                                                                                                  entrypoints[0],
+                                                                                                  entrypoints[1],
+                                                                                                  entrypoints[2],
+                                                                                                  entrypoints[3],
+                                                                                                  entrypoints[4]);
+            }
+            else
+            {
+                auto render_pass_iterator = render_passes.find(render_pass_hash);
+
+                if (render_pass_iterator == render_passes.end() )
+                {
+                    const auto render_pass_words_iterator = m_render_passes.find(render_pass_hash);
+
+                    if (render_pass_words_iterator != m_render_passes.end() )
+                    {
+                        WordReader render_pass_reader(render_pass_words_iterator->second.data(),
+                                                      render_pass_words_iterator->second.size() );
+
+                        render_passes[render_pass_hash] = create_render_pass(in_device_ptr,
+                                                                            &render_pass_reader);
+                    }
+                    else
+                    {
+                        render_passes[render_pass_hash] = Anvil::RenderPassUniquePtr();
+                    }
+
+                    render_pass_iterator = render_passes.find(render_pass_hash);
+                }
+
+                if (render_pass_iterator->second != nullptr)
+                {
+                    create_info_ptr = Anvil::GraphicsPipelineCreateInfo::create(pipeline_create_flags,
+                                                                                render_pass_iterator->second.get(),
+                                                                                subpass_id,
+                                                                                entrypoints[0],
+                                                                                entrypoints[1],
+                                                                                entrypoints[2],
+                                                                                entrypoints[3],
+                                                                                entrypoints[4]);
+                }
+            }
+
+            /* Mesh & task stages are stored past the vertex processing stages */
+            if (create_info_ptr                  != nullptr &&
+                entrypoints[5].shader_module_ptr != nullptr)
+            {
+                success &= dynamic_cast<Anvil::GraphicsPipelineCreateInfo*>(create_info_ptr.get() )->set_mesh_shading_stages(entrypoints[5],
+                                                                                                                               entrypoints[6]);
+            }
+        }
+
+        if (create_info_ptr == nullptr)
+        {
+            result = false;
+
+            continue;
+        }
+
+        create_info_ptr->set_descriptor_set_create_info(&ds_create_info_raw_ptrs);
+
+        for (const auto& current_stage : stages)
+        {
+            for (const auto& current_specialization_constant : current_stage.second.specialization_constants)
+            {
+                const auto n_data_bytes = static_cast<uint32_t>(current_specialization_constant.second.size() );
+
+                if (pipeline_type == PIPELINE_TYPE_COMPUTE)
+                {
+                    success &= dynamic_cast<Anvil::ComputePipelineCreateInfo*>(create_info_ptr.get() )->add_specialization_constant(current_specialization_constant.first,
+                                                                                                                                   n_data_bytes,
+                                                                                                                                   current_specialization_constant.second.data() );
+                }
+                else
+                {
+                    success &= dynamic_cast<Anvil::GraphicsPipelineCreateInfo*>(create_info_ptr.get() )->add_specialization_constant(current_stage.first,
+                                                                                                                                    current_specialization_constant.first,
+                                                                                                                                    n_data_bytes,
+                                                                                                                                    current_specialization_constant.second.data() );
+                }
+            }
+        }
+
+        /* Push constant ranges */
+        n_push_constant_ranges = reader.read();
+
+        for (uint32_t n_push_constant_range = 0;
+                      n_push_constant_range < n_push_constant_ranges && !reader.has_failed();
+                    ++n_push_constant_range)
+        {
+            const uint32_t offset = reader.read();
+            const uint32_t size   = reader.read();
+            const auto     stages_flags = Anvil::ShaderStageFlags(static_cast<Anvil::ShaderStageFlagBits>(reader.read() ));
+
+            success &= create_info_ptr->attach_push_constant_range(offset,
+                                                                   size,
+                                                                   stages_flags);
+        }
+
+        if (pipeline_type == PIPELINE_TYPE_COMPUTE)
+        {
+            auto           compute_create_info_ptr = dynamic_cast<Anvil::ComputePipelineCreateInfo*>(create_info_ptr.get() );
+            const uint32_t required_subgroup_size  = reader.read();
+
+            /* The subgroup size specialization constant, if any, has been recorded as a regular specialization constant. */
+            if (required_subgroup_size != 0)
+            {
+                success &= compute_create_info_ptr->set_required_subgroup_size(required_subgroup_size);
+            }
+
+            compute_create_info_ptr->set_require_full_subgroups     (reader.read() != 0);
+            compute_create_info_ptr->set_allow_varying_subgroup_size(reader.read() != 0);
+        }
+        else
+        {
+            auto           gfx_create_info_ptr = dynamic_cast<Anvil::GraphicsPipelineCreateInfo*>(create_info_ptr.get() );
+            float          blend_constant[4];
+            bool           bool_value          = false;
+            float          float_values[3];
+            uint32_t       n_blend_attachments = 0;
+            uint32_t       n_dynamic_states    = 0;
+            uint32_t       n_sample_locations  = 0;
+            uint32_t       n_vertex_bindings   = 0;
+
+            /* Input assembly & tessellation state */
+            gfx_create_info_ptr->set_primitive_topology        (static_cast<Anvil::PrimitiveTopology>(reader.read() ));
+            gfx_create_info_ptr->toggle_primitive_restart      (reader.read() != 0);
+            gfx_create_info_ptr->set_n_patch_control_points    (reader.read() );
+            gfx_create_info_ptr->set_tessellation_domain_origin(static_cast<Anvil::TessellationDomainOrigin>(reader.read() ));
+
+            /* Rasterization state */
+            {
+                const auto  polygon_mode = static_cast<Anvil::PolygonMode>(reader.read() );
+                const auto  cull_mode    = Anvil::CullModeFlags(static_cast<Anvil::CullModeFlagBits>(reader.read() ));
+                const auto  front_face   = static_cast<Anvil::FrontFace>(reader.read() );
+                const float line_width   = reader.read_float();
+
+                gfx_create_info_ptr->set_rasterization_properties(polygon_mode,
+                                                                  cull_mode,
+                                                                  front_face,
+                                                                  line_width);
+            }
+
+            gfx_create_info_ptr->toggle_depth_clamp                     (reader.read() != 0);
+            gfx_create_info_ptr->toggle_depth_clip                      (reader.read() != 0);
+            gfx_create_info_ptr->toggle_rasterizer_discard              (reader.read() != 0);
+            gfx_create_info_ptr->set_rasterization_order                (static_cast<Anvil::RasterizationOrderAMD>           (reader.read() ));
+            gfx_create_info_ptr->set_conservative_rasterization_mode    (static_cast<Anvil::ConservativeRasterizationModeEXT>(reader.read() ));
+            gfx_create_info_ptr->set_extra_primitive_overestimation_size(reader.read_float() );
+            gfx_create_info_ptr->set_rasterization_stream_index         (reader.read() );
+
+            bool_value      = (reader.read() != 0);
+            float_values[0] = reader.read_float();
+            float_values[1] = reader.read_float();
+            float_values[2] = reader.read_float();
+
+            gfx_create_info_ptr->toggle_depth_bias(bool_value,
+                                                   float_values[0],
+                                                   float_values[1],
+                                                   float_values[2]);
+
+            /* Depth/stencil state */
+            bool_value      = (reader.read() != 0);
+            float_values[0] = reader.read_float();
+            float_values[1] = reader.read_float();
+
+            gfx_create_info_ptr->toggle_depth_bounds_test(bool_value,
+                                                          float_values[0],
+                                                          float_values[1]);
+
+            bool_value = (reader.read() != 0);
+
+            gfx_create_info_ptr->toggle_depth_test  (bool_value,
+                                                     static_cast<Anvil::CompareOp>(reader.read() ));
+            gfx_create_info_ptr->toggle_depth_writes(reader.read() != 0);
+            gfx_create_info_ptr->toggle_stencil_test(reader.read() != 0);
+
+            for (uint32_t n_face = 0;
+                          n_face < 2;
+                        ++n_face)
+            {
+                const auto     fail_op       = static_cast<Anvil::StencilOp>(reader.read() );
+                const auto     pass_op       = static_cast<Anvil::StencilOp>(reader.read() );
+                const auto     depth_fail_op = static_cast<Anvil::StencilOp>(reader.read() );
+                const auto     compare_op    = static_cast<Anvil::CompareOp>(reader.read() );
+                const uint32_t compare_mask  = reader.read();
+                const uint32_t write_mask    = reader.read();
+                const uint32_t reference     = reader.read();
+
+                gfx_create_info_ptr->set_stencil_test_properties((n_face == 0),
+                                                                 fail_op,
+                                                                 pass_op,
+                                                                 depth_fail_op,
+                                                                 compare_op,
+                                                                 compare_mask,
+                                                                 write_mask,
+                                                                 reference);
+            }
+
+            /* Multisample state */
+            {
+                const auto   sample_count               = static_cast<Anvil::SampleCountFlagBits>(reader.read() );
+                const bool   is_sample_mask_enabled     = (reader.read() != 0);
+                const auto   sample_mask                = static_cast<VkSampleMask>(reader.read() );
+                const bool   is_sample_shading_enabled  = (reader.read() != 0);
+                const float  min_sample_shading         = reader.read_float();
+
+                gfx_create_info_ptr->set_multisampling_properties(sample_count,
+                                                                  min_sample_shading,
+                                                                  sample_mask);
+                gfx_create_info_ptr->toggle_sample_mask          (is_sample_mask_enabled);
+                gfx_create_info_ptr->toggle_sample_shading       (is_sample_shading_enabled);
+            }
+
+            gfx_create_info_ptr->toggle_alpha_to_coverage(reader.read() != 0);
+            gfx_create_info_ptr->toggle_alpha_to_one     (reader.read() != 0);
+
+            {
+                std::vector<Anvil::SampleLocation> sample_locations;
+                const bool                         are_sample_locations_enabled = (reader.read() != 0);
+                const auto                         sample_locations_per_pixel   = static_cast<Anvil::SampleCountFlagBits>(reader.read() );
+                VkExtent2D                         sample_location_grid_size;
+
+                sample_location_grid_size.width  = reader.read();
+                sample_location_grid_size.height = reader.read();
+                n_sample_locations               = reader.read();
+
+                for (uint32_t n_sample_location = 0;
+                              n_sample_location < n_sample_locations && !reader.has_failed();
+                            ++n_sample_location)
+                {
+                    Anvil::SampleLocation sample_location;
+
+                    sample_location.x = reader.read_float();
+                    sample_location.y = reader.read_float();
+
+                    sample_locations.push_back(sample_location);
+                }
+
+                if (n_sample_locations > 0 &&
+                    !reader.has_failed() )
+                {
+                    gfx_create_info_ptr->set_sample_location_properties(sample_locations_per_pixel,
+                                                                        sample_location_grid_size,
+                                                                        n_sample_locations,
+                                                                       &sample_locations.at(0) );
+                }
+
+                gfx_create_info_ptr->toggle_sample_locations(are_sample_locations_enabled);
+            }
+
+            /* Color blend state */
+            bool_value = (reader.read() != 0);
+
+            gfx_create_info_ptr->toggle_logic_op(bool_value,
+                                                 static_cast<Anvil::LogicOp>(reader.read() ));
+
+            for (auto& current_component : blend_constant)
+            {
+                current_component = reader.read_float();
+            }
+
+            gfx_create_info_ptr->set_blending_properties(blend_constant);
+
+            n_blend_attachments = reader.read();
+
+            for (uint32_t n_blend_attachment = 0;
+                          n_blend_attachment < n_blend_attachments && !reader.has_failed();
+                        ++n_blend_attachment)
+            {
+                const uint32_t attachment_id          = reader.read();
+                const bool     is_blending_enabled    = (reader.read() != 0);
+                const auto     blend_op_color         = static_cast<Anvil::BlendOp>    (reader.read() );
+                const auto     blend_op_alpha         = static_cast<Anvil::BlendOp>    (reader.read() );
+                const auto     src_color_blend_factor = static_cast<Anvil::BlendFactor>(reader.read() );
+                const auto     dst_color_blend_factor = static_cast<Anvil::BlendFactor>(reader.read() );
+                const auto     src_alpha_blend_factor = static_cast<Anvil::BlendFactor>(reader.read() );
+                const auto     dst_alpha_blend_factor = static_cast<Anvil::BlendFactor>(reader.read() );
+                const auto     write_mask             = Anvil::ColorComponentFlags(static_cast<Anvil::ColorComponentFlagBits>(reader.read() ));
+
+                gfx_create_info_ptr->set_color_blend_attachment_properties(attachment_id,
+                                                                           is_blending_enabled,
+                                                                           blend_op_color,
+                                                                           blend_op_alpha,
+                                                                           src_color_blend_factor,
+                                                                           dst_color_blend_factor,
+                                                                           src_alpha_blend_factor,
+                                                                           dst_alpha_blend_factor,
+                                                                           write_mask);
+            }
+
+            /* Dynamic state */
+            n_dynamic_states = reader.read();
+
+            {
+                std::vector<Anvil::DynamicState> dynamic_states;
+
+                for (uint32_t n_dynamic_state = 0;
+                              n_dynamic_state < n_dynamic_states && !reader.has_failed();
+                            ++n_dynamic_state)
+                {
+                    dynamic_states.push_back(static_cast<Anvil::DynamicState>(reader.read() ));
+                }
+
+                gfx_create_info_ptr->toggle_dynamic_states(true, /* in_should_enable */
+                                                           dynamic_states);
+            }
+
+            gfx_create_info_ptr->set_n_dynamic_scissor_boxes(reader.read() );
+            gfx_create_info_ptr->set_n_dynamic_viewports    (reader.read() );
+
+            /* Viewport state */
+            {
+                const uint32_t n_viewports = reader.read();
+
+                for (uint32_t n_viewport = 0;
+                              n_viewport < n_viewports && !reader.has_failed();
+                            ++n_viewport)
+                {
+                    float viewport_values[6];
+
+                    for (auto& current_value : viewport_values)
+                    {
+                        current_value = reader.read_float();
+                    }
+
+                    gfx_create_info_ptr->set_viewport_properties(n_viewport,
+                                                                 viewport_values[0],
+                                                                 viewport_values[1],
+                                                                 viewport_values[2],
+                                                                 viewport_values[3],
+                                                                 viewport_values[4],
+                                                                 viewport_values[5]);
+                }
+            }
+
+            {
+                const uint32_t n_scissor_boxes = reader.read();
+
+                for (uint32_t n_scissor_box = 0;
+                              n_scissor_box < n_scissor_boxes && !reader.has_failed();
+                            ++n_scissor_box)
+                {
+                    const auto     x      = static_cast<int32_t>(reader.read() );
+                    const auto     y      = static_cast<int32_t>(reader.read() );
+                    const uint32_t width  = reader.read();
+                    const uint32_t height = reader.read();
+
+                    gfx_create_info_ptr->set_scissor_box_properties(n_scissor_box,
+                                                                    x,
+                                                                    y,
+                                                                    width,
+                                                                    height);
+                }
+            }
+
+            /* Shading rate image state */
+            {
+                const bool     is_shading_rate_image_enabled = (reader.read() != 0);
+                const uint32_t n_palette_slots               = reader.read();
+
+                for (uint32_t n_viewport = 0;
+                              n_viewport < n_palette_slots && !reader.has_failed();
+                            ++n_viewport)
+                {
+                    std::vector<Anvil::ShadingRatePaletteEntryNV> entries;
+                    const uint32_t                                n_entries = reader.read();
+
+                    for (uint32_t n_entry = 0;
+                                  n_entry < n_entries && !reader.has_failed();
+                                ++n_entry)
+                    {
+                        entries.push_back(static_cast<Anvil::ShadingRatePaletteEntryNV>(reader.read() ));
+                    }
+
+                    if (n_entries > 0 &&
+                        !reader.has_failed() )
+                    {
+                        gfx_create_info_ptr->set_shading_rate_palette(n_viewport,
+                                                                      n_entries,
+                                                                     &entries.at(0) );
+                    }
+                }
+
+                gfx_create_info_ptr->toggle_shading_rate_image(is_shading_rate_image_enabled);
+            }
+
+            /* Vertex input state */
+            n_vertex_bindings = reader.read();
+
+            for (uint32_t n_vertex_binding = 0;
+                          n_vertex_binding < n_vertex_bindings && !reader.has_failed();
+                        ++n_vertex_binding)
+            {
+                std::vector<Anvil::VertexInputAttribute> attributes;
+                const uint32_t                           binding      = reader.read();
+                const uint32_t                           stride       = reader.read();
+                const auto                               rate         = static_cast<Anvil::VertexInputRate>(reader.read() );
+                const uint32_t                           divisor      = reader.read();
+                const uint32_t                           n_attributes = reader.read();
+
+                for (uint32_t n_attribute = 0;
+                              n_attribute < n_attributes && !reader.has_failed();
+                            ++n_attribute)
+                {
+                    const uint32_t location        = reader.read();
+                    const auto     format          = static_cast<Anvil::Format>(reader.read() );
+                    const uint32_t offset_in_bytes = reader.read();
+
+                    attributes.push_back(
+                        Anvil::VertexInputAttribute(location,
+                                                    format,
+                                                    offset_in_bytes)
+                    );
+                }
+
+                success &= gfx_create_info_ptr->add_vertex_binding(binding,
+                                                                   rate,
+                                                                   stride,
+                                                                   n_attributes,
+                                                                   (n_attributes > 0) ? &attributes.at(0) : nullptr,
+                                                                   divisor);
+            }
+        }
+
+        if (!success                ||
+             reader.has_failed()    ||
+            !reader.is_at_end    () )
+        {
+            result = false;
+
+            continue;
+        }
+
+        if (!pipeline_manager_ptr->add_pipeline(std::move(create_info_ptr),
+                                               &pipeline_id) )
+        {
+            result = false;
+
+            continue;
+        }
+
+        pipelines.push_back(
+            std::make_pair(pipeline_manager_ptr,
+                           pipeline_id)
+        );
+    }
+
+    unlock();
+
+    compute_pipeline_manager_ptr->bake();
+    gfx_pipeline_manager_ptr->bake    ();
+
+    for (const auto& current_pipeline : pipelines)
+    {
+        if (current_pipeline.first->get_pipeline(current_pipeline.second) != VK_NULL_HANDLE)
+        {
+            ++n_pipelines_baked;
+        }
+        else
+        {
+            result = false;
+        }
+    }
+
+end:
+    if (out_opt_n_pipelines_baked_ptr != nullptr)
+    {
+        *out_opt_n_pipelines_baked_ptr = n_pipelines_baked;
+    }
+
+    /* Release the pipelines before the shader modules & render passes they were created from. */
+    compute_pipeline_manager_ptr.reset();
+    gfx_pipeline_manager_ptr.reset    ();
+
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::PipelineManifest::store_to_file(const std::string& in_filename) const
+{
+    bool  result = false;
+    Words words;
+
+    lock();
+    {
+        words.push_back(g_manifest_magic);
+        words.push_back(g_manifest_version);
+        words.push_back(static_cast<uint32_t>(m_spirv_blobs.size  () ));
+        words.push_back(static_cast<uint32_t>(m_render_passes.size() ));
+        words.push_back(static_cast<uint32_t>(m_pipelines.size    () ));
+
+        for (const auto& current_spirv_blob : m_spirv_blobs)
+        {
+            write_u64      (current_spirv_blob.first,
+                           &words);
+            words.push_back(static_cast<uint32_t>(current_spirv_blob.second.size() ));
+            words.insert   (words.end(),
+                            current_spirv_blob.second.begin(),
+                            current_spirv_blob.second.end  () );
+        }
+
+        for (const auto& current_render_pass : m_render_passes)
+        {
+            write_u64      (current_render_pass.first,
+                           &words);
+            words.push_back(static_cast<uint32_t>(current_render_pass.second.size() ));
+            words.insert   (words.end(),
+                            current_render_pass.second.begin(),
+                            current_render_pass.second.end  () );
+        }
+
+        for (const auto& current_pipeline : m_pipelines)
+        {
+            words.push_back(static_cast<uint32_t>(current_pipeline.size() ));
+            words.insert   (words.end(),
+                            current_pipeline.begin(),
+                            current_pipeline.end  () );
+        }
+
+        for (const auto& current_pipeline_usage : m_pipeline_usage)
+        {
+            words.push_back(current_pipeline_usage.n_binds);
+            words.push_back(current_pipeline_usage.n_first_bind_frame);
+        }
+    }
+    unlock();
+
+    result = Anvil::IO::write_binary_file(in_filename,
+                                          &words.at(0),
+                                          static_cast<unsigned int>(words.size() * sizeof(uint32_t) ));
+
+    return result;
+}
@@ -0,0 +1,399 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/pipeline_statistics_profiler.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/device.h"
+#include "wrappers/query_pool.h"
+#include <unordered_map>
+
+/* Statistics gathered by the profiler. Vulkan returns the values in the order of the bits' positions, which is
+ * also the order of this array. */
+static const Anvil::QueryPipelineStatisticFlagBits g_pipeline_statistics[] =
+{
+    Anvil::QueryPipelineStatisticFlagBits::INPUT_ASSEMBLY_VERTICES_BIT,
+    Anvil::QueryPipelineStatisticFlagBits::INPUT_ASSEMBLY_PRIMITIVES_BIT,
+    Anvil::QueryPipelineStatisticFlagBits::VERTEX_SHADER_INVOCATIONS_BIT,
+    Anvil::QueryPipelineStatisticFlagBits::CLIPPING_PRIMITIVES_BIT,
+    Anvil::QueryPipelineStatisticFlagBits::FRAGMENT_SHADER_INVOCATIONS_BIT,
+    Anvil::QueryPipelineStatisticFlagBits::COMPUTE_SHADER_INVOCATIONS_BIT,
+};
+static const uint32_t g_n_pipeline_statistics = sizeof(g_pipeline_statistics) / sizeof(g_pipeline_statistics[0]);
+
+
+/** Please see header for specification */
+Anvil::PipelineStatisticsProfiler::PipelineStatisticsProfiler(const Anvil::BaseDevice* in_device_ptr,
+                                                              uint32_t                 in_n_frames_in_flight,
+                                                              uint32_t                 in_n_max_passes_per_frame)
+    :m_device_ptr               (in_device_ptr),
+     m_frames                   (in_n_frames_in_flight),
+     m_has_last_frame_statistics(false),
+     m_is_pass_active           (false),
+     m_is_pass_measured         (false),
+     m_n_current_frame          (in_n_frames_in_flight - 1),
+     m_n_dropped_frames         (0),
+     m_n_max_passes_per_frame   (in_n_max_passes_per_frame),
+     m_next_frame_index         (0),
+     m_occlusion_query_flags    (Anvil::QueryControlFlagBits::NONE),
+     m_pipeline_statistics      (Anvil::QueryPipelineStatisticFlagBits::NONE)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::PipelineStatisticsProfiler::~PipelineStatisticsProfiler()
+{
+    anvil_assert(!m_is_pass_active);
+}
+
+/** Please see header for specification */
+bool Anvil::PipelineStatisticsProfiler::begin_frame(Anvil::CommandBufferBase* in_cmd_buffer_ptr)
+{
+    const uint32_t first_query = 0;
+    Frame*         frame_ptr   = nullptr;
+    bool           result      = false;
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    if (m_is_pass_active)
+    {
+        anvil_assert(!m_is_pass_active);
+
+        m_is_pass_active = false;
+    }
+
+    /* begin_frame() advances to the next slot before using it, so the first call picks slot 0. */
+    m_n_current_frame = (m_n_current_frame + 1) % static_cast<uint32_t>(m_frames.size() );
+    frame_ptr         = &m_frames.at(m_n_current_frame);
+
+    if (frame_ptr->is_pending)
+    {
+        read_back_frame(m_n_current_frame);
+    }
+
+    frame_ptr->frame_index = m_next_frame_index++;
+    frame_ptr->is_pending  = false;
+    frame_ptr->pass_names.clear();
+
+    if (!in_cmd_buffer_ptr->record_reset_query_pool(m_occlusion_query_pool_ptr.get(),
+                                                    first_query + m_n_current_frame * m_n_max_passes_per_frame,
+                                                    m_n_max_passes_per_frame) )
+    {
+        goto end;
+    }
+
+    if (m_ps_query_pool_ptr != nullptr)
+    {
+        if (!in_cmd_buffer_ptr->record_reset_query_pool(m_ps_query_pool_ptr.get(),
+                                                        first_query + m_n_current_frame * m_n_max_passes_per_frame,
+                                                        m_n_max_passes_per_frame) )
+        {
+            goto end;
+        }
+    }
+
+    frame_ptr->is_pending = true;
+    result                = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::PipelineStatisticsProfiler::begin_pass(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                                   const std::string&        in_name)
+{
+    Frame&   current_frame = m_frames.at(m_n_current_frame);
+    uint32_t query_index   = UINT32_MAX;
+    bool     result        = false;
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    if (m_is_pass_active)
+    {
+        /* Queries of the same type must not be nested */
+        anvil_assert(!m_is_pass_active);
+
+        goto end;
+    }
+
+    if (m_next_frame_index == 0)
+    {
+        /* begin_frame() has not been called yet, so the queries have not been reset */
+        anvil_assert(m_next_frame_index != 0);
+
+        goto end;
+    }
+
+    m_is_pass_active   = true;
+    m_is_pass_measured = false;
+
+    if (!current_frame.is_pending                                 ||
+         current_frame.pass_names.size() >= m_n_max_passes_per_frame)
+    {
+        result = true;
+
+        goto end;
+    }
+
+    query_index = m_n_current_frame * m_n_max_passes_per_frame + static_cast<uint32_t>(current_frame.pass_names.size() );
+
+    if (!in_cmd_buffer_ptr->record_begin_query(m_occlusion_query_pool_ptr.get(),
+                                               query_index,
+                                               m_occlusion_query_flags) )
+    {
+        goto end;
+    }
+
+    if (m_ps_query_pool_ptr != nullptr)
+    {
+        if (!in_cmd_buffer_ptr->record_begin_query(m_ps_query_pool_ptr.get(),
+                                                   query_index,
+                                                   Anvil::QueryControlFlagBits::NONE) )
+        {
+            goto end;
+        }
+    }
+
+    current_frame.pass_names.push_back(in_name);
+
+    m_is_pass_measured = true;
+    result             = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::PipelineStatisticsProfilerUniquePtr Anvil::PipelineStatisticsProfiler::create(const Anvil::BaseDevice* in_device_ptr,
+                                                                                     uint32_t                 in_n_frames_in_flight,
+                                                                                     uint32_t                 in_n_max_passes_per_frame)
+{
+    Anvil::PipelineStatisticsProfilerUniquePtr result_ptr(nullptr,
+                                                          std::default_delete<Anvil::PipelineStatisticsProfiler>() );
+
+    anvil_assert(in_device_ptr             != nullptr);
+    anvil_assert(in_n_frames_in_flight     >  0);
+    anvil_assert(in_n_max_passes_per_frame >  0);
+
+    result_ptr.reset(
+        new Anvil::PipelineStatisticsProfiler(in_device_ptr,
+                                              in_n_frames_in_flight,
+                                              in_n_max_passes_per_frame)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init() )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+bool Anvil::PipelineStatisticsProfiler::end_pass(Anvil::CommandBufferBase* in_cmd_buffer_ptr)
+{
+    const uint32_t n_passes = static_cast<uint32_t>(m_frames.at(m_n_current_frame).pass_names.size() );
+    bool           result   = false;
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    if (!m_is_pass_active)
+    {
+        anvil_assert(m_is_pass_active);
+
+        goto end;
+    }
+
+    m_is_pass_active = false;
+
+    if (m_is_pass_measured)
+    {
+        const uint32_t query_index = m_n_current_frame * m_n_max_passes_per_frame + n_passes - 1;
+
+        if (m_ps_query_pool_ptr != nullptr)
+        {
+            if (!in_cmd_buffer_ptr->record_end_query(m_ps_query_pool_ptr.get(),
+                                                     query_index) )
+            {
+                goto end;
+            }
+        }
+
+        if (!in_cmd_buffer_ptr->record_end_query(m_occlusion_query_pool_ptr.get(),
+                                                 query_index) )
+        {
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Creates the query pools. Pipeline statistics are only gathered if the device supports them.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::PipelineStatisticsProfiler::init()
+{
+    const auto&    features  = *m_device_ptr->get_physical_device_features().core_vk1_0_features_ptr;
+    const uint32_t n_queries = static_cast<uint32_t>(m_frames.size() ) * m_n_max_passes_per_frame;
+    bool           result    = false;
+
+    m_occlusion_query_pool_ptr = Anvil::QueryPool::create_non_ps_query_pool(m_device_ptr,
+                                                                            VK_QUERY_TYPE_OCCLUSION,
+                                                                            n_queries);
+
+    if (m_occlusion_query_pool_ptr == nullptr)
+    {
+        anvil_assert(m_occlusion_query_pool_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (features.occlusion_query_precise)
+    {
+        m_occlusion_query_flags = Anvil::QueryControlFlagBits::PRECISE_BIT;
+    }
+
+    if (features.pipeline_statistics_query)
+    {
+        for (uint32_t n_statistic = 0;
+                      n_statistic < g_n_pipeline_statistics;
+                    ++n_statistic)
+        {
+            m_pipeline_statistics = m_pipeline_statistics | g_pipeline_statistics[n_statistic];
+        }
+
+        m_ps_query_pool_ptr = Anvil::QueryPool::create_ps_query_pool(m_device_ptr,
+                                                                     m_pipeline_statistics,
+                                                                     n_queries);
+
+        if (m_ps_query_pool_ptr == nullptr)
+        {
+            anvil_assert(m_ps_query_pool_ptr != nullptr);
+
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Retrieves the results of the specified frame without waiting and, if all of them are available, replaces
+ *  the last frame statistics with the frame's results, aggregated by pass name. Otherwise, the frame is dropped.
+ *
+ *  @param in_n_frame Index of the frame's slot.
+ */
+void Anvil::PipelineStatisticsProfiler::read_back_frame(uint32_t in_n_frame)
+{
+    const Frame&                              frame       = m_frames.at(in_n_frame);
+    const uint32_t                            first_query = in_n_frame * m_n_max_passes_per_frame;
+    const uint32_t                            n_passes    = static_cast<uint32_t>(frame.pass_names.size() );
+    std::unordered_map<std::string, uint32_t> pass_indices;
+
+    if (n_passes > 0)
+    {
+        bool all_results_retrieved = false;
+
+        m_occlusion_query_results.resize(n_passes);
+
+        if (!m_occlusion_query_pool_ptr->get_query_pool_results(first_query,
+                                                                n_passes,
+                                                                Anvil::QueryResultFlagBits::NONE,
+                                                               &m_occlusion_query_results.at(0),
+                                                               &all_results_retrieved) ||
+            !all_results_retrieved)
+        {
+            m_n_dropped_frames++;
+
+            goto end;
+        }
+
+        if (m_ps_query_pool_ptr != nullptr)
+        {
+            m_ps_query_results.resize(n_passes * g_n_pipeline_statistics);
+
+            if (!m_ps_query_pool_ptr->get_query_pool_results(first_query,
+                                                             n_passes,
+                                                             Anvil::QueryResultFlagBits::NONE,
+                                                            &m_ps_query_results.at(0),
+                                                            &all_results_retrieved) ||
+                !all_results_retrieved)
+            {
+                m_n_dropped_frames++;
+
+                goto end;
+            }
+        }
+    }
+
+    m_last_frame_statistics.frame_index = frame.frame_index;
+    m_last_frame_statistics.passes.clear();
+
+    for (uint32_t n_pass = 0;
+                  n_pass < n_passes;
+                ++n_pass)
+    {
+        auto            pass_index_iterator = pass_indices.find(frame.pass_names.at(n_pass) );
+        PassStatistics* pass_ptr            = nullptr;
+
+        if (pass_index_iterator == pass_indices.end() )
+        {
+            pass_indices[frame.pass_names.at(n_pass)] = static_cast<uint32_t>(m_last_frame_statistics.passes.size() );
+
+            m_last_frame_statistics.passes.push_back(PassStatistics() );
+
+            pass_ptr       = &m_last_frame_statistics.passes.back();
+            pass_ptr->name = frame.pass_names.at(n_pass);
+        }
+        else
+        {
+            pass_ptr = &m_last_frame_statistics.passes.at(pass_index_iterator->second);
+        }
+
+        pass_ptr->n_instances    ++;
+        pass_ptr->samples_passed += m_occlusion_query_results.at(n_pass);
+
+        if (m_ps_query_pool_ptr != nullptr)
+        {
+            const uint64_t* values_ptr = &m_ps_query_results.at(n_pass * g_n_pipeline_statistics);
+
+            pass_ptr->input_assembly_vertices     += values_ptr[0];
+            pass_ptr->input_assembly_primitives   += values_ptr[1];
+            pass_ptr->vertex_shader_invocations   += values_ptr[2];
+            pass_ptr->clipping_primitives         += values_ptr[3];
+            pass_ptr->fragment_shader_invocations += values_ptr[4];
+            pass_ptr->compute_shader_invocations  += values_ptr[5];
+        }
+    }
+
+    m_has_last_frame_statistics = true;
+end:
+    ;
+}
@@ -21,9 +21,15 @@
 //
 
 #include "misc/debug.h"
+#include "misc/event_create_info.h"
+#include "misc/fence_create_info.h"
 #include "misc/pools.h"
+#include "misc/semaphore_create_info.h"
 #include "wrappers/command_buffer.h"
 #include "wrappers/command_pool.h"
+#include "wrappers/event.h"
+#include "wrappers/fence.h"
+#include "wrappers/semaphore.h"
 
 Anvil::PrimaryCommandBufferUniquePtr Anvil::PrimaryCommandBufferPoolWorker::create_item()
 {
@@ -44,4 +50,49 @@ Anvil::SecondaryCommandBufferUniquePtr Anvil::SecondaryCommandBufferPoolWorker::
 void Anvil::SecondaryCommandBufferPoolWorker::reset_item(Anvil::SecondaryCommandBufferUniquePtr& in_item_ptr)
 {
     in_item_ptr->reset(false /* should_release_resources */);
-}
\ No newline at end of file
+}
+
+
+Anvil::EventUniquePtr Anvil::EventPoolWorker::create_item()
+{
+    return Anvil::Event::create(Anvil::EventCreateInfo::create(m_device_ptr) );
+}
+
+void Anvil::EventPoolWorker::reset_item(Anvil::EventUniquePtr& in_item_ptr)
+{
+    in_item_ptr->reset();
+}
+
+
+Anvil::FenceUniquePtr Anvil::FencePoolWorker::create_item()
+{
+    return Anvil::Fence::create(Anvil::FenceCreateInfo::create(m_device_ptr,
+                                                               false) ); /* in_create_signalled */
+}
+
+void Anvil::FencePoolWorker::reset_item(Anvil::FenceUniquePtr& in_item_ptr)
+{
+    in_item_ptr->reset();
+}
+
+void Anvil::FencePoolWorker::reset_items(uint32_t                      in_n_items,
+                                         Anvil::FenceUniquePtr* const* in_item_ptrs)
+{
+    m_fence_ptrs.resize(in_n_items);
+
+    for (uint32_t n_item = 0;
+                  n_item < in_n_items;
+                ++n_item)
+    {
+        m_fence_ptrs.at(n_item) = in_item_ptrs[n_item]->get();
+    }
+
+    Anvil::Fence::reset_fences(in_n_items,
+                               (in_n_items > 0) ? &m_fence_ptrs.at(0) : nullptr);
+}
+
+
+Anvil::SemaphoreUniquePtr Anvil::SemaphorePoolWorker::create_item()
+{
+    return Anvil::Semaphore::create(Anvil::SemaphoreCreateInfo::create(m_device_ptr) );
+}
@@ -0,0 +1,313 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#include "misc/debug.h"
+#include "misc/query_allocator.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/device.h"
+#include "wrappers/fence.h"
+#include "wrappers/query_pool.h"
+#include "wrappers/semaphore.h"
+
+
+/** Please see header for specification */
+Anvil::QueryAllocator::QueryAllocator(const Anvil::BaseDevice*           in_device_ptr,
+                                      VkQueryType                        in_query_type,
+                                      Anvil::QueryPipelineStatisticFlags in_pipeline_statistics,
+                                      uint32_t                           in_n_queries_per_pool)
+    :MTSafetySupportProvider(true),
+     m_device_ptr           (in_device_ptr),
+     m_n_queries_per_pool   (in_n_queries_per_pool),
+     m_pipeline_statistics  (in_pipeline_statistics),
+     m_query_type           (in_query_type),
+     m_uses_host_query_reset(false)
+{
+    if (m_device_ptr->get_extension_info()->ext_host_query_reset() )
+    {
+        const auto features_ptr = m_device_ptr->get_physical_device_features().ext_host_query_reset_features_ptr;
+
+        m_uses_host_query_reset = (features_ptr != nullptr && features_ptr->host_query_reset);
+    }
+}
+
+/** Please see header for specification */
+Anvil::QueryAllocator::~QueryAllocator()
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+bool Anvil::QueryAllocator::allocate(uint32_t                  in_n_queries,
+                                     Anvil::CommandBufferBase* in_opt_reset_cmd_buffer_ptr,
+                                     Anvil::QueryPool**        out_query_pool_ptr_ptr,
+                                     Anvil::QueryIndex*        out_first_query_index_ptr)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+    PoolUsage*                                 pool_usage_ptr = nullptr;
+    bool                                       result         = false;
+
+    if (in_n_queries == 0                    ||
+        in_n_queries >  m_n_queries_per_pool)
+    {
+        anvil_assert(in_n_queries != 0                    &&
+                     in_n_queries <= m_n_queries_per_pool);
+
+        goto end;
+    }
+
+    if (!m_uses_host_query_reset                 &&
+         in_opt_reset_cmd_buffer_ptr == nullptr)
+    {
+        anvil_assert(in_opt_reset_cmd_buffer_ptr != nullptr);
+
+        goto end;
+    }
+
+    /* Ranges are carved out of the last pool used in this frame. Earlier pools only have too little space left. */
+    if (m_current_frame_pools.empty()                                                  ||
+        m_current_frame_pools.back().n_used_queries + in_n_queries > m_n_queries_per_pool)
+    {
+        Anvil::QueryPool* pool_ptr = get_free_pool();
+
+        if (pool_ptr == nullptr)
+        {
+            goto end;
+        }
+
+        m_current_frame_pools.push_back(PoolUsage(pool_ptr) );
+    }
+
+    pool_usage_ptr = &m_current_frame_pools.back();
+
+    if (!m_uses_host_query_reset)
+    {
+        if (!in_opt_reset_cmd_buffer_ptr->record_reset_query_pool(pool_usage_ptr->pool_ptr,
+                                                                  pool_usage_ptr->n_used_queries,
+                                                                  in_n_queries) )
+        {
+            goto end;
+        }
+    }
+
+    *out_query_pool_ptr_ptr    = pool_usage_ptr->pool_ptr;
+    *out_first_query_index_ptr = pool_usage_ptr->n_used_queries;
+
+    pool_usage_ptr->n_used_queries += in_n_queries;
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::QueryAllocator::collect()
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+    uint32_t                                   n_frames_recycled = 0;
+
+    while (!m_frames.empty()                     &&
+            is_frame_complete(m_frames.front() ) )
+    {
+        for (auto& current_pool_usage : m_frames.front().pools)
+        {
+            if (m_uses_host_query_reset)
+            {
+                current_pool_usage.pool_ptr->reset_host(0, /* in_first_query_index */
+                                                        current_pool_usage.n_used_queries);
+            }
+
+            m_free_pools.push_back(current_pool_usage.pool_ptr);
+        }
+
+        m_frames.pop_front();
+
+        ++n_frames_recycled;
+    }
+
+    return n_frames_recycled;
+}
+
+/** Please see header for specification */
+Anvil::QueryAllocatorUniquePtr Anvil::QueryAllocator::create_non_ps(const Anvil::BaseDevice* in_device_ptr,
+                                                                    VkQueryType              in_query_type,
+                                                                    uint32_t                 in_n_queries_per_pool)
+{
+    Anvil::QueryAllocatorUniquePtr result_ptr(nullptr,
+                                              std::default_delete<Anvil::QueryAllocator>() );
+
+    anvil_assert(in_device_ptr         != nullptr);
+    anvil_assert(in_n_queries_per_pool >  0);
+    anvil_assert(in_query_type         != VK_QUERY_TYPE_PIPELINE_STATISTICS);
+
+    result_ptr.reset(
+        new Anvil::QueryAllocator(in_device_ptr,
+                                  in_query_type,
+                                  Anvil::QueryPipelineStatisticFlagBits::NONE,
+                                  in_n_queries_per_pool)
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+Anvil::QueryAllocatorUniquePtr Anvil::QueryAllocator::create_ps(const Anvil::BaseDevice*           in_device_ptr,
+                                                                Anvil::QueryPipelineStatisticFlags in_pipeline_statistics,
+                                                                uint32_t                           in_n_queries_per_pool)
+{
+    Anvil::QueryAllocatorUniquePtr result_ptr(nullptr,
+                                              std::default_delete<Anvil::QueryAllocator>() );
+
+    anvil_assert(in_device_ptr         != nullptr);
+    anvil_assert(in_n_queries_per_pool >  0);
+
+    result_ptr.reset(
+        new Anvil::QueryAllocator(in_device_ptr,
+                                  VK_QUERY_TYPE_PIPELINE_STATISTICS,
+                                  in_pipeline_statistics,
+                                  in_n_queries_per_pool)
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+void Anvil::QueryAllocator::end_frame(Anvil::Fence* in_fence_ptr)
+{
+    anvil_assert(in_fence_ptr != nullptr);
+
+    end_frame(in_fence_ptr,
+              nullptr, /* in_opt_semaphore_ptr */
+              0);      /* in_semaphore_value   */
+}
+
+/** Please see header for specification */
+void Anvil::QueryAllocator::end_frame(Anvil::Semaphore* in_timeline_semaphore_ptr,
+                                      uint64_t          in_value)
+{
+    anvil_assert(in_timeline_semaphore_ptr != nullptr);
+
+    end_frame(nullptr, /* in_opt_fence_ptr */
+              in_timeline_semaphore_ptr,
+              in_value);
+}
+
+/** Moves pools used in the current frame to a new pending frame.
+ *
+ *  Exactly one of @param in_opt_fence_ptr and @param in_opt_semaphore_ptr must not be null.
+ */
+void Anvil::QueryAllocator::end_frame(Anvil::Fence*     in_opt_fence_ptr,
+                                      Anvil::Semaphore* in_opt_semaphore_ptr,
+                                      uint64_t          in_semaphore_value)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+
+    m_frames.emplace_back(in_opt_fence_ptr,
+                          in_opt_semaphore_ptr,
+                          in_semaphore_value,
+                          std::move(m_current_frame_pools) );
+
+    m_current_frame_pools.clear();
+}
+
+/** Returns a pool which has no queries in use, creating a new one if needed.
+ *
+ *  @return As per description, or null if a new pool could not be created.
+ */
+Anvil::QueryPool* Anvil::QueryAllocator::get_free_pool()
+{
+    Anvil::QueryPoolUniquePtr new_pool_ptr;
+    Anvil::QueryPool*         result_ptr   = nullptr;
+
+    if (!m_free_pools.empty() )
+    {
+        result_ptr = m_free_pools.back();
+
+        m_free_pools.pop_back();
+
+        goto end;
+    }
+
+    if (m_query_type == VK_QUERY_TYPE_PIPELINE_STATISTICS)
+    {
+        new_pool_ptr = Anvil::QueryPool::create_ps_query_pool(m_device_ptr,
+                                                              m_pipeline_statistics,
+                                                              m_n_queries_per_pool);
+    }
+    else
+    {
+        new_pool_ptr = Anvil::QueryPool::create_non_ps_query_pool(m_device_ptr,
+                                                                  m_query_type,
+                                                                  m_n_queries_per_pool);
+    }
+
+    if (new_pool_ptr == nullptr)
+    {
+        anvil_assert(new_pool_ptr != nullptr);
+
+        goto end;
+    }
+
+    /* Queries start in an undefined state. */
+    if (m_uses_host_query_reset)
+    {
+        new_pool_ptr->reset_host(0, /* in_first_query_index */
+                                 m_n_queries_per_pool);
+    }
+
+    result_ptr = new_pool_ptr.get();
+
+    m_pools.push_back(std::move(new_pool_ptr) );
+
+end:
+    return result_ptr;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::QueryAllocator::get_n_pools() const
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+
+    return static_cast<uint32_t>(m_pools.size() );
+}
+
+/** Tells whether the GPU has finished executing all work submitted for @param in_frame. Does not block. */
+bool Anvil::QueryAllocator::is_frame_complete(const Frame& in_frame) const
+{
+    bool result = false;
+
+    if (in_frame.fence_ptr != nullptr)
+    {
+        result = in_frame.fence_ptr->is_set();
+    }
+    else
+    {
+        uint64_t counter_value = 0;
+
+        anvil_assert(in_frame.semaphore_ptr != nullptr);
+
+        if (in_frame.semaphore_ptr->get_counter_value(&counter_value) )
+        {
+            result = (counter_value >= in_frame.semaphore_value);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,504 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "misc/buffer_create_info.h"
+#include "misc/debug.h"
+#include "misc/query_result_reader.h"
+#include "wrappers/buffer.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/device.h"
+#include "wrappers/memory_block.h"
+#include "wrappers/query_pool.h"
+#include <string.h>
+
+/* Each query occupies a result value followed by an availability value, both 64-bit */
+#define QUERY_DATA_SIZE (2 * sizeof(uint64_t) )
+
+
+/** Please see header for specification */
+Anvil::QueryResultReader::QueryResultReader(const Anvil::BaseDevice* in_device_ptr,
+                                            Anvil::QueryPool*        in_query_pool_ptr,
+                                            uint32_t                 in_n_copy_slots)
+    :m_copy_requests    (in_n_copy_slots),
+     m_copy_mapped_ptr  (nullptr),
+     m_device_ptr       (in_device_ptr),
+     m_epoch            (0),
+     m_n_copy_slots     (in_n_copy_slots),
+     m_n_next_copy_slot (0),
+     m_n_pending_queries(0),
+     m_query_epochs     (in_query_pool_ptr->get_capacity(),
+                         0),
+     m_query_pool_ptr   (in_query_pool_ptr),
+     m_query_states     (in_query_pool_ptr->get_capacity(),
+                         QueryState::UNUSED),
+     m_results          (in_query_pool_ptr->get_capacity(),
+                         0)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::QueryResultReader::~QueryResultReader()
+{
+    if (m_copy_mapped_ptr != nullptr)
+    {
+        m_copy_buffer_ptr->get_memory_block(0 /* in_n_memory_block */)->unmap();
+
+        m_copy_mapped_ptr = nullptr;
+    }
+}
+
+/** Please see header for specification */
+Anvil::QueryResultReaderUniquePtr Anvil::QueryResultReader::create(const Anvil::BaseDevice* in_device_ptr,
+                                                                   Anvil::QueryPool*        in_query_pool_ptr,
+                                                                   uint32_t                 in_n_copy_slots)
+{
+    Anvil::QueryResultReaderUniquePtr result_ptr(nullptr,
+                                                 std::default_delete<Anvil::QueryResultReader>() );
+
+    anvil_assert(in_device_ptr     != nullptr);
+    anvil_assert(in_query_pool_ptr != nullptr);
+
+    if (in_query_pool_ptr->get_query_type() == VK_QUERY_TYPE_PIPELINE_STATISTICS)
+    {
+        /* Pipeline statistics queries return a variable number of values per query */
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    result_ptr.reset(
+        new Anvil::QueryResultReader(in_device_ptr,
+                                     in_query_pool_ptr,
+                                     in_n_copy_slots)
+    );
+
+    if (!result_ptr->init() )
+    {
+        result_ptr.reset();
+    }
+
+end:
+    return result_ptr;
+}
+
+/** Please see header for specification */
+bool Anvil::QueryResultReader::get_result(Anvil::QueryIndex in_query_index,
+                                          uint64_t*         out_result_ptr) const
+{
+    bool result = false;
+
+    anvil_assert(in_query_index < m_results.size() );
+    anvil_assert(out_result_ptr != nullptr);
+
+    if (m_query_states.at(in_query_index) == QueryState::AVAILABLE)
+    {
+        *out_result_ptr = m_results.at(in_query_index);
+        result          = true;
+    }
+
+    return result;
+}
+
+/** Creates and maps the ring buffer results are copied to, if the reader has been created with
+ *  copy slots.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::QueryResultReader::init()
+{
+    const VkDeviceSize      buffer_size = static_cast<VkDeviceSize>(m_n_copy_slots) * m_query_pool_ptr->get_capacity() * QUERY_DATA_SIZE;
+    void*                   mapped_ptr  = nullptr;
+    Anvil::QueueFamilyFlags queue_fams  = Anvil::QueueFamilyFlagBits::NONE;
+    bool                    result      = false;
+
+    if (m_n_copy_slots == 0)
+    {
+        result = true;
+
+        goto end;
+    }
+
+    /* Query results can be copied by any universal or compute queue */
+    if (m_device_ptr->get_n_universal_queues() > 0)
+    {
+        queue_fams |= Anvil::QueueFamilyFlagBits::GRAPHICS_BIT;
+    }
+
+    if (m_device_ptr->get_n_compute_queues() > 0)
+    {
+        queue_fams |= Anvil::QueueFamilyFlagBits::COMPUTE_BIT;
+    }
+
+    {
+        const auto sharing_mode    = Anvil::Utils::is_pow2(queue_fams.get_vk() ) ? Anvil::SharingMode::EXCLUSIVE
+                                                                                 : Anvil::SharingMode::CONCURRENT;
+        auto       create_info_ptr = Anvil::BufferCreateInfo::create_alloc(m_device_ptr,
+                                                                           buffer_size,
+                                                                           queue_fams,
+                                                                           sharing_mode,
+                                                                           Anvil::BufferCreateFlagBits::NONE,
+                                                                           Anvil::BufferUsageFlagBits::TRANSFER_DST_BIT,
+                                                                           Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT | Anvil::MemoryFeatureFlagBits::HOST_COHERENT_BIT);
+
+        create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+
+        m_copy_buffer_ptr = Anvil::Buffer::create(std::move(create_info_ptr) );
+    }
+
+    if (m_copy_buffer_ptr == nullptr)
+    {
+        anvil_assert(m_copy_buffer_ptr != nullptr);
+
+        goto end;
+    }
+
+    /* Keep the ring mapped throughout the reader's lifetime, so that update() never needs to remap it. */
+    if (!m_copy_buffer_ptr->get_memory_block(0 /* in_n_memory_block */)->map(0, /* in_start_offset */
+                                                                             buffer_size,
+                                                                            &mapped_ptr) )
+    {
+        anvil_assert_fail();
+
+        m_copy_buffer_ptr.reset();
+        goto end;
+    }
+
+    m_copy_mapped_ptr = static_cast<const uint8_t*>(mapped_ptr);
+
+    memset(mapped_ptr,
+           0,
+           static_cast<size_t>(buffer_size) );
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::QueryResultReader::invalidate(Anvil::QueryIndex in_first_query_index,
+                                          uint32_t          in_n_queries)
+{
+    mark_pending(in_first_query_index,
+                 in_n_queries);
+}
+
+/** Please see header for specification */
+bool Anvil::QueryResultReader::is_result_available(Anvil::QueryIndex in_query_index) const
+{
+    anvil_assert(in_query_index < m_query_states.size() );
+
+    return (m_query_states.at(in_query_index) == QueryState::AVAILABLE);
+}
+
+/** Marks the specified query range as pending. Copies recorded before this call are not going to be
+ *  used to update the queries' results.
+ *
+ *  @param in_first_query_index Index of the first query to mark.
+ *  @param in_n_queries         Number of queries to mark.
+ */
+void Anvil::QueryResultReader::mark_pending(Anvil::QueryIndex in_first_query_index,
+                                            uint32_t          in_n_queries)
+{
+    anvil_assert(in_first_query_index + in_n_queries <= m_query_states.size() );
+
+    ++m_epoch;
+
+    for (uint32_t n_query = in_first_query_index;
+                  n_query < in_first_query_index + in_n_queries;
+                ++n_query)
+    {
+        if (m_query_states.at(n_query) != QueryState::PENDING)
+        {
+            m_query_states.at(n_query) = QueryState::PENDING;
+
+            m_n_pending_queries++;
+        }
+
+        m_query_epochs.at(n_query) = m_epoch;
+    }
+}
+
+/** Reads results of pending queries from the ring buffer slot written by the copy request assigned
+ *  to the slot. Once all queries covered by the request have been handled, the request is retired.
+ *
+ *  @param in_n_slot Index of the slot to use.
+ *
+ *  @return Number of queries whose results have become available.
+ */
+uint32_t Anvil::QueryResultReader::process_copy_request(uint32_t in_n_slot)
+{
+    auto&           request         = m_copy_requests.at(in_n_slot);
+    bool            is_request_done = true;
+    uint32_t        result          = 0;
+    const uint64_t* slot_data_ptr   = reinterpret_cast<const uint64_t*>(m_copy_mapped_ptr + static_cast<size_t>(in_n_slot) * m_query_pool_ptr->get_capacity() * QUERY_DATA_SIZE);
+
+    for (uint32_t n_query = request.first_query_index;
+                  n_query < request.first_query_index + request.n_queries;
+                ++n_query)
+    {
+        if (m_query_states.at(n_query) != QueryState::PENDING ||
+            m_query_epochs.at(n_query) >  request.epoch)
+        {
+            /* Either already read, or reset after the copy has been recorded */
+            continue;
+        }
+
+        if (slot_data_ptr[n_query * 2 + 1] == 0)
+        {
+            is_request_done = false;
+
+            continue;
+        }
+
+        store_result(n_query,
+                     slot_data_ptr[n_query * 2]);
+
+        result++;
+    }
+
+    if (is_request_done)
+    {
+        request.n_queries = 0;
+    }
+
+    return result;
+}
+
+/** Polls the query pool for results of all pending queries, in contiguous runs.
+ *
+ *  @return Number of queries whose results have become available.
+ */
+uint32_t Anvil::QueryResultReader::poll_query_pool()
+{
+    const uint32_t n_queries = static_cast<uint32_t>(m_query_states.size() );
+    uint32_t       result    = 0;
+
+    for (uint32_t n_query = 0;
+                  n_query < n_queries;)
+    {
+        bool     all_retrieved = false;
+        uint32_t n_run_queries = 0;
+
+        if (m_query_states.at(n_query) != QueryState::PENDING)
+        {
+            ++n_query;
+
+            continue;
+        }
+
+        while (n_query + n_run_queries < n_queries                                 &&
+               m_query_states.at(n_query + n_run_queries) == QueryState::PENDING)
+        {
+            ++n_run_queries;
+        }
+
+        if (m_poll_data.size() < n_run_queries * 2)
+        {
+            m_poll_data.resize(n_run_queries * 2);
+        }
+
+        if (m_query_pool_ptr->get_query_pool_results(n_query,
+                                                     n_run_queries,
+                                                     Anvil::QueryResultFlagBits::_64_BIT | Anvil::QueryResultFlagBits::WITH_AVAILABILITY_BIT,
+                                                    &m_poll_data.at(0),
+                                                    &all_retrieved) )
+        {
+            for (uint32_t n_run_query = 0;
+                          n_run_query < n_run_queries;
+                        ++n_run_query)
+            {
+                if (m_poll_data.at(n_run_query * 2 + 1) != 0)
+                {
+                    store_result(n_query + n_run_query,
+                                 m_poll_data.at(n_run_query * 2) );
+
+                    result++;
+                }
+            }
+        }
+        else
+        {
+            anvil_assert_fail();
+        }
+
+        n_query += n_run_queries;
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::QueryResultReader::record_copy(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                           Anvil::QueryIndex         in_first_query_index,
+                                           uint32_t                  in_n_queries,
+                                           bool                      in_gpu_wait)
+{
+    const uint32_t     n_slot       = m_n_next_copy_slot;
+    VkQueryResultFlags result_flags = VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT;
+    bool               result       = false;
+    VkDeviceSize       slot_offset  = 0;
+
+    anvil_assert(in_cmd_buffer_ptr                   != nullptr);
+    anvil_assert(in_first_query_index + in_n_queries <= m_query_states.size() );
+
+    if (m_n_copy_slots == 0)
+    {
+        anvil_assert(m_n_copy_slots != 0);
+
+        goto end;
+    }
+
+    m_n_next_copy_slot = (m_n_next_copy_slot + 1) % m_n_copy_slots;
+    slot_offset        = static_cast<VkDeviceSize>(n_slot) * m_query_pool_ptr->get_capacity() * QUERY_DATA_SIZE;
+
+    /* The GPU is guaranteed to be done with the slot at this point. Pick up whatever the earlier copy has delivered,
+     * then clear availability values, so that stale ones are not mistaken for the new copy's. */
+    if (m_copy_requests.at(n_slot).n_queries > 0)
+    {
+        process_copy_request(n_slot);
+    }
+
+    memset(const_cast<uint8_t*>(m_copy_mapped_ptr) + slot_offset + in_first_query_index * QUERY_DATA_SIZE,
+           0,
+           in_n_queries * QUERY_DATA_SIZE);
+
+    if (in_gpu_wait)
+    {
+        result_flags |= VK_QUERY_RESULT_WAIT_BIT;
+    }
+
+    if (!in_cmd_buffer_ptr->record_copy_query_pool_results(m_query_pool_ptr,
+                                                           in_first_query_index,
+                                                           in_n_queries,
+                                                           m_copy_buffer_ptr.get(),
+                                                           slot_offset + in_first_query_index * QUERY_DATA_SIZE,
+                                                           QUERY_DATA_SIZE,
+                                                           result_flags) )
+    {
+        goto end;
+    }
+
+    {
+        const Anvil::BufferBarrier barrier(Anvil::AccessFlagBits::TRANSFER_WRITE_BIT,
+                                           Anvil::AccessFlagBits::HOST_READ_BIT,
+                                           VK_QUEUE_FAMILY_IGNORED,
+                                           VK_QUEUE_FAMILY_IGNORED,
+                                           m_copy_buffer_ptr.get(),
+                                           slot_offset + in_first_query_index * QUERY_DATA_SIZE,
+                                           in_n_queries * QUERY_DATA_SIZE);
+
+        if (!in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                        Anvil::PipelineStageFlagBits::HOST_BIT,
+                                                        Anvil::DependencyFlagBits::NONE,
+                                                        0,       /* in_memory_barrier_count        */
+                                                        nullptr, /* in_memory_barrier_ptrs         */
+                                                        1,       /* in_buffer_memory_barrier_count */
+                                                       &barrier,
+                                                        0,       /* in_image_memory_barrier_count  */
+                                                        nullptr) )
+        {
+            goto end;
+        }
+    }
+
+    m_copy_requests.at(n_slot).epoch             = m_epoch;
+    m_copy_requests.at(n_slot).first_query_index = in_first_query_index;
+    m_copy_requests.at(n_slot).n_queries         = in_n_queries;
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::QueryResultReader::record_reset(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                            Anvil::QueryIndex         in_first_query_index,
+                                            uint32_t                  in_n_queries)
+{
+    bool result = false;
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    if (!in_cmd_buffer_ptr->record_reset_query_pool(m_query_pool_ptr,
+                                                    in_first_query_index,
+                                                    in_n_queries) )
+    {
+        goto end;
+    }
+
+    mark_pending(in_first_query_index,
+                 in_n_queries);
+
+    result = true;
+end:
+    return result;
+}
+
+/** Stores the result of a query which has become available.
+ *
+ *  @param in_query_index Index of the query to use. The query must be pending.
+ *  @param in_result      Result value to store.
+ */
+void Anvil::QueryResultReader::store_result(Anvil::QueryIndex in_query_index,
+                                            uint64_t          in_result)
+{
+    anvil_assert(m_query_states.at(in_query_index) == QueryState::PENDING);
+    anvil_assert(m_n_pending_queries                >  0);
+
+    m_query_states.at(in_query_index) = QueryState::AVAILABLE;
+    m_results.at     (in_query_index) = in_result;
+
+    m_n_pending_queries--;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::QueryResultReader::update()
+{
+    uint32_t result = 0;
+
+    if (m_n_pending_queries == 0)
+    {
+        goto end;
+    }
+
+    if (m_n_copy_slots == 0)
+    {
+        result = poll_query_pool();
+    }
+    else
+    {
+        for (uint32_t n_slot = 0;
+                      n_slot < m_n_copy_slots;
+                    ++n_slot)
+        {
+            if (m_copy_requests.at(n_slot).n_queries > 0)
+            {
+                result += process_copy_request(n_slot);
+            }
+        }
+    }
+
+end:
+    return result;
+}
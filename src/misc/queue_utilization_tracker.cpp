@@ -0,0 +1,415 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "misc/debug.h"
+#include "misc/queue_utilization_tracker.h"
+#include "misc/tracing.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/command_pool.h"
+#include "wrappers/device.h"
+#include "wrappers/query_pool.h"
+#include "wrappers/queue.h"
+#include <algorithm>
+
+
+/** Please see header for specification */
+Anvil::QueueUtilizationTracker::QueueUtilizationTracker(Anvil::Queue* in_queue_ptr,
+                                                        uint32_t      in_n_slots,
+                                                        uint32_t      in_n_largest_gaps,
+                                                        bool          in_mt_safe)
+    :MTSafetySupportProvider(in_mt_safe),
+     m_busy_end_time        (0),
+     m_committed_write_pos  (0),
+     m_device_ptr           (in_queue_ptr->get_parent_device() ),
+     m_has_busy_end_time    (false),
+     m_n_largest_gaps       (in_n_largest_gaps),
+     m_queue_ptr            (in_queue_ptr),
+     m_read_pos             (0),
+     m_slots                (in_n_slots),
+     m_timestamp_period     (1.0),
+     m_write_pos            (0)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::QueueUtilizationTracker::~QueueUtilizationTracker()
+{
+    /* Stub */
+}
+
+/** Called by Anvil::Queue for each submission it is about to bracket. Claims the next free slot.
+ *
+ *  @param in_queue_ptr             Queue the submission is going to be issued for. Must match the tracked queue.
+ *  @param out_begin_cmd_buffer_ptr Deref will be set to the command buffer to execute before the submission's
+ *                                  command buffers. Must not be null.
+ *  @param out_end_cmd_buffer_ptr   Deref will be set to the command buffer to execute after the submission's
+ *                                  command buffers. Must not be null.
+ *
+ *  @return true if a slot has been claimed, false if all slots are in flight and the submission should not be
+ *          bracketed.
+ */
+bool Anvil::QueueUtilizationTracker::begin_submission(const Anvil::Queue* in_queue_ptr,
+                                                      VkCommandBuffer*    out_begin_cmd_buffer_ptr,
+                                                      VkCommandBuffer*    out_end_cmd_buffer_ptr)
+{
+    const uint64_t n_slots = static_cast<uint64_t>(m_slots.size() );
+    bool           result  = false;
+    Slot*          slot_ptr;
+
+    anvil_assert(in_queue_ptr == m_queue_ptr);
+
+    ANVIL_REDUNDANT_ARGUMENT_CONST(in_queue_ptr);
+
+    lock();
+
+    if (m_write_pos - m_read_pos >= n_slots)
+    {
+        retire_slots();
+
+        if (m_write_pos - m_read_pos >= n_slots)
+        {
+            m_report.n_dropped_submissions++;
+
+            goto end;
+        }
+    }
+
+    slot_ptr = &m_slots.at(static_cast<size_t>(m_write_pos % n_slots) );
+
+    slot_ptr->submit_host_timestamp = Anvil::Time::get_raw_host_timestamp();
+    *out_begin_cmd_buffer_ptr       = slot_ptr->begin_cmd_buffer_ptr->get_command_buffer();
+    *out_end_cmd_buffer_ptr         = slot_ptr->end_cmd_buffer_ptr->get_command_buffer  ();
+
+    m_write_pos++;
+
+    result = true;
+end:
+    unlock();
+
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::QueueUtilizationTrackerUniquePtr Anvil::QueueUtilizationTracker::create(Anvil::Queue* in_queue_ptr,
+                                                                               uint32_t      in_n_slots,
+                                                                               uint32_t      in_n_largest_gaps,
+                                                                               bool          in_mt_safe)
+{
+    Anvil::QueueUtilizationTrackerUniquePtr result_ptr(nullptr,
+                                                       std::default_delete<Anvil::QueueUtilizationTracker>() );
+
+    anvil_assert(in_queue_ptr != nullptr);
+    anvil_assert(in_n_slots   >  0);
+
+    result_ptr.reset(
+        new Anvil::QueueUtilizationTracker(in_queue_ptr,
+                                           in_n_slots,
+                                           in_n_largest_gaps,
+                                           in_mt_safe)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init() )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+/** Called by Anvil::Queue after the submissions it has claimed slots for have been issued.
+ *
+ *  @param in_submitted true if the submit call succeeded, in which case the claimed slots are going to be read back
+ *                      by update(). Otherwise, the slots are released.
+ */
+void Anvil::QueueUtilizationTracker::end_submissions(bool in_submitted)
+{
+    lock();
+    {
+        if (in_submitted)
+        {
+            m_committed_write_pos = m_write_pos;
+        }
+        else
+        {
+            m_write_pos = m_committed_write_pos;
+        }
+    }
+    unlock();
+}
+
+/** Please see header for specification */
+Anvil::QueueUtilizationTracker::Report Anvil::QueueUtilizationTracker::get_report()
+{
+    Report result;
+
+    lock();
+    {
+        retire_slots();
+
+        result = m_report;
+    }
+    unlock();
+
+    return result;
+}
+
+/** Creates the timestamp query pool and pre-records the command buffers of all slots.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::QueueUtilizationTracker::init()
+{
+    const uint32_t                queue_family_index = m_queue_ptr->get_queue_family_index();
+    Anvil::CommandPool*           command_pool_ptr   = m_device_ptr->get_command_pool_for_queue_family_index(queue_family_index);
+    const auto&                   limits             = m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits;
+    const Anvil::QueueFamilyInfo* queue_family_ptr   = m_device_ptr->get_queue_family_info                  (queue_family_index);
+    bool                          result             = false;
+
+    if (!limits.timestamp_compute_and_graphics ||
+         queue_family_ptr                      == nullptr ||
+         queue_family_ptr->n_timestamp_bits    == 0)
+    {
+        goto end;
+    }
+
+    m_query_pool_ptr = Anvil::QueryPool::create_non_ps_query_pool(m_device_ptr,
+                                                                  VK_QUERY_TYPE_TIMESTAMP,
+                                                                  static_cast<uint32_t>(m_slots.size() ) * 2);
+
+    if (m_query_pool_ptr == nullptr)
+    {
+        anvil_assert(m_query_pool_ptr != nullptr);
+
+        goto end;
+    }
+
+    m_timestamp_period = static_cast<double>(limits.timestamp_period);
+
+    for (uint32_t n_slot = 0;
+                  n_slot < static_cast<uint32_t>(m_slots.size() );
+                ++n_slot)
+    {
+        auto& slot = m_slots.at(n_slot);
+
+        slot.begin_cmd_buffer_ptr  = command_pool_ptr->alloc_primary_level_command_buffer();
+        slot.end_cmd_buffer_ptr    = command_pool_ptr->alloc_primary_level_command_buffer();
+        slot.submit_host_timestamp = 0;
+
+        if (slot.begin_cmd_buffer_ptr == nullptr ||
+            slot.end_cmd_buffer_ptr   == nullptr)
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        /* The end command buffer of a slot may still be pending when its timestamp becomes available, so allow
+         * simultaneous use to let the slot be reused right away. */
+        if (!slot.begin_cmd_buffer_ptr->start_recording       (false, /* in_one_time_submit          */
+                                                                true)  /* in_simultaneous_use_allowed */                          ||
+            !slot.begin_cmd_buffer_ptr->record_reset_query_pool(m_query_pool_ptr.get(),
+                                                                n_slot * 2,
+                                                                2)                                                                ||
+            !slot.begin_cmd_buffer_ptr->record_write_timestamp (Anvil::PipelineStageFlagBits::TOP_OF_PIPE_BIT,
+                                                                m_query_pool_ptr.get(),
+                                                                n_slot * 2)                                                       ||
+            !slot.begin_cmd_buffer_ptr->stop_recording         ()                                                                 ||
+            !slot.end_cmd_buffer_ptr->start_recording          (false, /* in_one_time_submit          */
+                                                                true)  /* in_simultaneous_use_allowed */                          ||
+            !slot.end_cmd_buffer_ptr->record_write_timestamp   (Anvil::PipelineStageFlagBits::BOTTOM_OF_PIPE_BIT,
+                                                                m_query_pool_ptr.get(),
+                                                                n_slot * 2 + 1)                                                   ||
+            !slot.end_cmd_buffer_ptr->stop_recording           () )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::QueueUtilizationTracker::reset()
+{
+    lock();
+    {
+        m_busy_end_time     = 0;
+        m_has_busy_end_time = false;
+        m_report            = Report();
+    }
+    unlock();
+}
+
+/** Reads back timestamps of all committed slots, in submission order, until a slot whose timestamps are not
+ *  available yet is encountered. Must be called with the lock held.
+ */
+void Anvil::QueueUtilizationTracker::retire_slots()
+{
+    Anvil::TimestampCalibration calibration;
+    bool                        has_calibration = false;
+    const uint64_t              n_slots         = static_cast<uint64_t>(m_slots.size() );
+
+    if (m_read_pos == m_committed_write_pos)
+    {
+        return;
+    }
+
+    if (m_device_ptr->get_extension_info()->ext_calibrated_timestamps() )
+    {
+        has_calibration = m_device_ptr->get_timestamp_calibration(&calibration);
+    }
+
+    while (m_read_pos != m_committed_write_pos)
+    {
+        bool           all_results_retrieved = false;
+        uint64_t       end_time;
+        const uint32_t n_slot                = static_cast<uint32_t>(m_read_pos % n_slots);
+        uint64_t       query_results[2];
+        const Slot&    slot                  = m_slots.at(n_slot);
+        uint64_t       start_time;
+
+        if (!m_query_pool_ptr->get_query_pool_results(n_slot * 2, /* in_first_query_index */
+                                                      2,          /* in_n_queries         */
+                                                      Anvil::QueryResultFlagBits::NONE,
+                                                      query_results,
+                                                     &all_results_retrieved) ||
+            !all_results_retrieved)
+        {
+            break;
+        }
+
+        start_time = static_cast<uint64_t>(static_cast<double>(query_results[0]) * m_timestamp_period);
+        end_time   = static_cast<uint64_t>(static_cast<double>(query_results[1]) * m_timestamp_period);
+
+        if (end_time < start_time)
+        {
+            end_time = start_time;
+        }
+
+        /* Consecutive submissions may overlap on the GPU, in which case only the part which extends the busy
+         * interval is accounted for. */
+        if (!m_has_busy_end_time)
+        {
+            m_report.busy_time += end_time - start_time;
+        }
+        else
+        if (start_time > m_busy_end_time)
+        {
+            Gap gap;
+
+            gap.duration   = start_time - m_busy_end_time;
+            gap.start_time = m_busy_end_time;
+
+            if (has_calibration)
+            {
+                gap.has_submit_delay = true;
+                gap.submit_delay     = static_cast<int64_t>(m_time.convert_raw_host_timestamp_to_nsec(slot.submit_host_timestamp) ) -
+                                       static_cast<int64_t>(m_time.convert_device_time_to_nsec       (gap.start_time, calibration) );
+
+                if (Anvil::Tracer::is_recording_enabled() )
+                {
+                    Anvil::Tracer::record_device_span("Queue idle (family " + std::to_string(m_queue_ptr->get_queue_family_index() ) + ", queue " + std::to_string(m_queue_ptr->get_queue_index() ) + ")",
+                                                      gap.start_time,
+                                                      start_time,
+                                                      calibration);
+                }
+            }
+
+            track_gap(gap);
+
+            m_report.busy_time += end_time - start_time;
+        }
+        else
+        if (end_time > m_busy_end_time)
+        {
+            m_report.busy_time += end_time - m_busy_end_time;
+        }
+
+        if (!m_has_busy_end_time      ||
+            end_time > m_busy_end_time)
+        {
+            m_busy_end_time     = end_time;
+            m_has_busy_end_time = true;
+        }
+
+        m_report.n_submissions++;
+        m_read_pos++;
+    }
+}
+
+/** Accounts for a gap and inserts it into the list of largest gaps, if it qualifies. Must be called with the lock
+ *  held.
+ *
+ *  @param in_gap Gap to account for.
+ */
+void Anvil::QueueUtilizationTracker::track_gap(const Gap& in_gap)
+{
+    auto& largest_gaps = m_report.largest_gaps;
+
+    m_report.idle_time += in_gap.duration;
+    m_report.n_gaps    ++;
+
+    if (m_n_largest_gaps == 0)
+    {
+        return;
+    }
+
+    if (largest_gaps.size()                 == m_n_largest_gaps &&
+        largest_gaps.back().duration        >= in_gap.duration)
+    {
+        return;
+    }
+
+    largest_gaps.insert(std::upper_bound(largest_gaps.begin(),
+                                         largest_gaps.end  (),
+                                         in_gap,
+                                         [](const Gap& in_gap1,
+                                            const Gap& in_gap2)
+                                         {
+                                             return in_gap1.duration > in_gap2.duration;
+                                         }),
+                        in_gap);
+
+    if (largest_gaps.size() > m_n_largest_gaps)
+    {
+        largest_gaps.pop_back();
+    }
+}
+
+/** Please see header for specification */
+void Anvil::QueueUtilizationTracker::update()
+{
+    lock();
+    {
+        retire_slots();
+    }
+    unlock();
+}
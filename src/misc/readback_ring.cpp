@@ -0,0 +1,781 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#include "misc/buffer_create_info.h"
+#include "misc/debug.h"
+#include "misc/fence_create_info.h"
+#include "misc/formats.h"
+#include "misc/image_create_info.h"
+#include "misc/memory_allocator.h"
+#include "misc/readback_ring.h"
+#include "wrappers/buffer.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/command_pool.h"
+#include "wrappers/device.h"
+#include "wrappers/fence.h"
+#include "wrappers/image.h"
+#include "wrappers/memory_block.h"
+#include "wrappers/queue.h"
+#include "wrappers/semaphore.h"
+
+
+/** Please see header for specification */
+Anvil::ReadbackRing::ReadbackRing(const Anvil::BaseDevice* in_device_ptr,
+                                  VkDeviceSize             in_size)
+    :MTSafetySupportProvider(true),
+     m_device_ptr           (in_device_ptr),
+     m_first_region_id      (0),
+     m_head_offset          (0),
+     m_size                 (in_size)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::ReadbackRing::~ReadbackRing()
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+
+    for (auto& current_region : m_regions)
+    {
+        if (current_region.is_frame_ended)
+        {
+            wait_for_region(&current_region);
+        }
+    }
+
+    m_regions.clear    ();
+    m_free_fences.clear();
+
+    if (m_buffer_ptr != nullptr)
+    {
+        m_buffer_ptr->get_memory_block(0 /* in_n_memory_block */)->unmap();
+        m_buffer_ptr.reset();
+    }
+}
+
+/** Reserves a new region of the ring. Must be called with the mutex held.
+ *
+ *  @param in_size             Number of bytes to reserve.
+ *  @param in_alignment        Required alignment of the region's start offset.
+ *  @param out_readback_id_ptr Deref will be set to the ID of the new region if the call succeeds.
+ *
+ *  @return true if successful, false if the ring does not have enough free space.
+ */
+bool Anvil::ReadbackRing::allocate_region(VkDeviceSize in_size,
+                                          VkDeviceSize in_alignment,
+                                          ReadbackID*  out_readback_id_ptr)
+{
+    bool         result      (false);
+    VkDeviceSize start_offset(0);
+
+    if (in_size > m_size)
+    {
+        goto end;
+    }
+
+    retire_regions();
+
+    if (!try_reserve_region(in_size,
+                            in_alignment,
+                           &start_offset) )
+    {
+        goto end;
+    }
+
+    m_regions.emplace_back(start_offset,
+                           in_size);
+
+    m_head_offset        = start_offset + in_size;
+    *out_readback_id_ptr = m_first_region_id + m_regions.size() - 1;
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::ReadbackRingUniquePtr Anvil::ReadbackRing::create(const Anvil::BaseDevice* in_device_ptr,
+                                                         VkDeviceSize             in_size)
+{
+    Anvil::ReadbackRingUniquePtr result_ptr(nullptr,
+                                            std::default_delete<Anvil::ReadbackRing>() );
+
+    anvil_assert(in_device_ptr != nullptr);
+    anvil_assert(in_size       >  0);
+
+    result_ptr.reset(
+        new Anvil::ReadbackRing(in_device_ptr,
+                                in_size)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init() )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+void Anvil::ReadbackRing::end_frame(Anvil::Fence* in_fence_ptr)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+
+    anvil_assert(in_fence_ptr != nullptr);
+
+    for (auto& current_region : m_regions)
+    {
+        if (!current_region.is_frame_ended)
+        {
+            current_region.fence_ptr      = in_fence_ptr;
+            current_region.is_frame_ended = true;
+        }
+    }
+}
+
+/** Please see header for specification */
+void Anvil::ReadbackRing::end_frame(Anvil::Semaphore* in_timeline_semaphore_ptr,
+                                    uint64_t          in_value)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+
+    anvil_assert(in_timeline_semaphore_ptr != nullptr);
+
+    for (auto& current_region : m_regions)
+    {
+        if (!current_region.is_frame_ended)
+        {
+            current_region.is_frame_ended  = true;
+            current_region.semaphore_ptr   = in_timeline_semaphore_ptr;
+            current_region.semaphore_value = in_value;
+        }
+    }
+}
+
+/** Returns a reset fence, recycling previously retired fences if possible. */
+Anvil::FenceUniquePtr Anvil::ReadbackRing::get_fence()
+{
+    Anvil::FenceUniquePtr result_ptr;
+
+    if (!m_free_fences.empty() )
+    {
+        result_ptr = std::move(m_free_fences.back() );
+
+        m_free_fences.pop_back();
+        result_ptr->reset     ();
+    }
+    else
+    {
+        auto create_info_ptr = Anvil::FenceCreateInfo::create(m_device_ptr,
+                                                              false); /* in_create_signalled */
+
+        create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+
+        result_ptr = Anvil::Fence::create(std::move(create_info_ptr) );
+    }
+
+    return result_ptr;
+}
+
+/** Returns the region associated with the specified readback, or null if the ID does not refer to a live
+ *  readback. Must be called with the mutex held.
+ */
+Anvil::ReadbackRing::Region* Anvil::ReadbackRing::get_region(ReadbackID in_readback_id) const
+{
+    Region* result_ptr = nullptr;
+
+    /* IDs are assigned sequentially and regions only ever retire from the front, so the ID maps directly
+     * to an index. */
+    if (in_readback_id >= m_first_region_id                   &&
+        in_readback_id <  m_first_region_id + m_regions.size() )
+    {
+        result_ptr = &m_regions.at(static_cast<size_t>(in_readback_id - m_first_region_id) );
+
+        if (result_ptr->is_released)
+        {
+            result_ptr = nullptr;
+        }
+    }
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+VkDeviceSize Anvil::ReadbackRing::get_readback_size(ReadbackID in_readback_id) const
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+    const Region*                              region_ptr(get_region(in_readback_id) );
+
+    return (region_ptr != nullptr) ? region_ptr->size
+                                   : 0;
+}
+
+/** Creates & persistently maps the buffer backing the ring. */
+bool Anvil::ReadbackRing::init()
+{
+    const uint32_t            n_memory_types  = static_cast<uint32_t>(m_device_ptr->get_physical_device_memory_properties().types.size() );
+    Anvil::MemoryFeatureFlags memory_features = Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT;
+    Anvil::QueueFamilyFlags   queue_fams      = Anvil::QueueFamilyFlagBits::NONE;
+    bool                      result          = false;
+
+    /* The data is only ever read on the host, so prefer cached memory if there is any. */
+    if (Anvil::MemoryAllocator::get_mem_types_supporting_mem_features(m_device_ptr,
+                                                                      (1u << n_memory_types) - 1,
+                                                                      Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT | Anvil::MemoryFeatureFlagBits::HOST_CACHED_BIT,
+                                                                      nullptr) ) /* out_opt_filtered_memory_types_ptr */
+    {
+        memory_features |= Anvil::MemoryFeatureFlagBits::HOST_CACHED_BIT;
+    }
+
+    /* The ring is shared by all queue families the device exposes, since we cannot tell in advance
+     * which queue is going to be used for a given readback. */
+    if (m_device_ptr->get_n_universal_queues() > 0)
+    {
+        queue_fams |= Anvil::QueueFamilyFlagBits::GRAPHICS_BIT;
+    }
+
+    if (m_device_ptr->get_n_compute_queues() > 0)
+    {
+        queue_fams |= Anvil::QueueFamilyFlagBits::COMPUTE_BIT;
+    }
+
+    if (m_device_ptr->get_n_transfer_queues() > 0)
+    {
+        queue_fams |= Anvil::QueueFamilyFlagBits::DMA_BIT;
+    }
+
+    {
+        const auto sharing_mode    = Anvil::Utils::is_pow2(queue_fams.get_vk() ) ? Anvil::SharingMode::EXCLUSIVE
+                                                                                 : Anvil::SharingMode::CONCURRENT;
+        auto       create_info_ptr = Anvil::BufferCreateInfo::create_alloc(m_device_ptr,
+                                                                           m_size,
+                                                                           queue_fams,
+                                                                           sharing_mode,
+                                                                           Anvil::BufferCreateFlagBits::NONE,
+                                                                           Anvil::BufferUsageFlagBits::TRANSFER_DST_BIT,
+                                                                           memory_features);
+
+        create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+
+        m_buffer_ptr = Anvil::Buffer::create(std::move(create_info_ptr) );
+    }
+
+    if (m_buffer_ptr == nullptr)
+    {
+        anvil_assert(m_buffer_ptr != nullptr);
+
+        goto end;
+    }
+
+    /* Keep the ring mapped throughout its lifetime, so that reads do not need to remap it. */
+    if (!m_buffer_ptr->get_memory_block(0 /* in_n_memory_block */)->map(0, /* in_start_offset */
+                                                                        m_size) )
+    {
+        anvil_assert_fail();
+
+        m_buffer_ptr.reset();
+        goto end;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Tells whether the copy into the specified region has completed. The result is cached, so that fences which
+ *  are reset by the app after the fact do not make the region look pending again.
+ */
+bool Anvil::ReadbackRing::is_region_complete(Region* in_region_ptr) const
+{
+    if (!in_region_ptr->is_complete &&
+         in_region_ptr->is_frame_ended)
+    {
+        if (in_region_ptr->owned_fence_ptr != nullptr)
+        {
+            in_region_ptr->is_complete = in_region_ptr->owned_fence_ptr->is_set();
+        }
+        else
+        if (in_region_ptr->fence_ptr != nullptr)
+        {
+            in_region_ptr->is_complete = in_region_ptr->fence_ptr->is_set();
+        }
+        else
+        {
+            uint64_t counter_value = 0;
+
+            anvil_assert(in_region_ptr->semaphore_ptr != nullptr);
+
+            if (in_region_ptr->semaphore_ptr->get_counter_value(&counter_value) )
+            {
+                in_region_ptr->is_complete = (counter_value >= in_region_ptr->semaphore_value);
+            }
+        }
+    }
+
+    return in_region_ptr->is_complete;
+}
+
+/** Please see header for specification */
+bool Anvil::ReadbackRing::is_ready(ReadbackID in_readback_id) const
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+    Region*                                    region_ptr(get_region(in_readback_id) );
+
+    anvil_assert(region_ptr != nullptr);
+
+    return (region_ptr != nullptr)              &&
+           is_region_complete(region_ptr);
+}
+
+/** Please see header for specification */
+bool Anvil::ReadbackRing::read(ReadbackID in_readback_id,
+                               void*      out_result_ptr,
+                               bool       in_should_block)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+    Region*                                    region_ptr(get_region(in_readback_id) );
+    bool                                       result    (false);
+
+    anvil_assert(out_result_ptr != nullptr);
+
+    if (region_ptr == nullptr)
+    {
+        anvil_assert(region_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (!is_region_complete(region_ptr) )
+    {
+        if (!in_should_block)
+        {
+            goto end;
+        }
+
+        if (!region_ptr->is_frame_ended)
+        {
+            /* Nothing is going to signal the region. */
+            anvil_assert(region_ptr->is_frame_ended);
+
+            goto end;
+        }
+
+        /* The region cannot retire before it is released, so it is safe to wait with the lock dropped. */
+        mutex_lock.unlock();
+        {
+            wait_for_region(region_ptr);
+        }
+        mutex_lock.lock();
+
+        region_ptr->is_complete = true;
+    }
+
+    result = m_buffer_ptr->get_memory_block(0 /* in_n_memory_block */)->read(region_ptr->start_offset,
+                                                                             region_ptr->size,
+                                                                             out_result_ptr);
+
+    region_ptr->is_released = true;
+
+    retire_regions();
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::ReadbackRing::record_buffer_readback(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                                 Anvil::Buffer*            in_buffer_ptr,
+                                                 VkDeviceSize              in_start_offset,
+                                                 VkDeviceSize              in_size,
+                                                 ReadbackID*               out_readback_id_ptr)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+    const Region*                              region_ptr(nullptr);
+    bool                                       result    (false);
+
+    anvil_assert(in_cmd_buffer_ptr   != nullptr);
+    anvil_assert(in_buffer_ptr       != nullptr);
+    anvil_assert(in_size             >  0);
+    anvil_assert(out_readback_id_ptr != nullptr);
+
+    if (!allocate_region(in_size,
+                         m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits.optimal_buffer_copy_offset_alignment,
+                         out_readback_id_ptr) )
+    {
+        goto end;
+    }
+
+    region_ptr = &m_regions.back();
+
+    {
+        Anvil::BufferBarrier post_copy_barrier(Anvil::AccessFlagBits::TRANSFER_WRITE_BIT,
+                                               Anvil::AccessFlagBits::HOST_READ_BIT,
+                                               VK_QUEUE_FAMILY_IGNORED,
+                                               VK_QUEUE_FAMILY_IGNORED,
+                                               m_buffer_ptr.get(),
+                                               region_ptr->start_offset,
+                                               in_size);
+        Anvil::BufferCopy    copy_region;
+        Anvil::MemoryBarrier pre_copy_barrier (Anvil::AccessFlagBits::TRANSFER_READ_BIT, /* in_destination_access_mask */
+                                               Anvil::AccessFlagBits::HOST_WRITE_BIT | Anvil::AccessFlagBits::MEMORY_WRITE_BIT | Anvil::AccessFlagBits::SHADER_WRITE_BIT | Anvil::AccessFlagBits::TRANSFER_WRITE_BIT);
+
+        copy_region.dst_offset = region_ptr->start_offset;
+        copy_region.size       = in_size;
+        copy_region.src_offset = in_start_offset;
+
+        in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT, /* in_src_stage_mask */
+                                                   Anvil::PipelineStageFlagBits::TRANSFER_BIT,     /* in_dst_stage_mask */
+                                                   Anvil::DependencyFlagBits::NONE,
+                                                   1,        /* in_memory_barrier_count        */
+                                                  &pre_copy_barrier,
+                                                   0,        /* in_buffer_memory_barrier_count */
+                                                   nullptr,  /* in_buffer_memory_barriers_ptr  */
+                                                   0,        /* in_image_memory_barrier_count  */
+                                                   nullptr); /* in_image_memory_barriers_ptr   */
+        in_cmd_buffer_ptr->record_copy_buffer     (in_buffer_ptr,
+                                                   m_buffer_ptr.get(),
+                                                   1, /* in_region_count */
+                                                  &copy_region);
+        in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                   Anvil::PipelineStageFlagBits::HOST_BIT,
+                                                   Anvil::DependencyFlagBits::NONE,
+                                                   0,        /* in_memory_barrier_count        */
+                                                   nullptr,  /* in_memory_barriers_ptr         */
+                                                   1,        /* in_buffer_memory_barrier_count */
+                                                  &post_copy_barrier,
+                                                   0,        /* in_image_memory_barrier_count  */
+                                                   nullptr); /* in_image_memory_barriers_ptr   */
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::ReadbackRing::record_image_readback(Anvil::CommandBufferBase*            in_cmd_buffer_ptr,
+                                                Anvil::Image*                        in_image_ptr,
+                                                Anvil::ImageLayout                   in_image_layout,
+                                                const Anvil::ImageSubresourceLayers& in_subresource,
+                                                const VkOffset3D&                    in_offset,
+                                                const VkExtent3D&                    in_extent,
+                                                ReadbackID*                          out_readback_id_ptr)
+{
+    VkDeviceSize                               alignment        (0);
+    Anvil::BufferImageCopy                     copy_region;
+    const Anvil::Format                        image_format     (in_image_ptr->get_create_info_ptr()->get_format() );
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock       (*get_mutex() );
+    uint32_t                                   n_bytes_per_texel(0);
+    uint32_t                                   n_component_bits [4];
+    const Region*                              region_ptr       (nullptr);
+    bool                                       result           (false);
+
+    anvil_assert(in_cmd_buffer_ptr          != nullptr);
+    anvil_assert(in_subresource.layer_count == 1);
+    anvil_assert(out_readback_id_ptr        != nullptr);
+    anvil_assert(in_image_layout            == Anvil::ImageLayout::GENERAL              ||
+                 in_image_layout            == Anvil::ImageLayout::TRANSFER_SRC_OPTIMAL);
+
+    if (Anvil::Formats::is_format_compressed(image_format) ||
+        Anvil::Formats::is_format_yuv_khr   (image_format) ||
+        in_subresource.aspect_mask != Anvil::ImageAspectFlagBits::COLOR_BIT)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    Anvil::Formats::get_format_n_component_bits_nonyuv(image_format,
+                                                       n_component_bits + 0,
+                                                       n_component_bits + 1,
+                                                       n_component_bits + 2,
+                                                       n_component_bits + 3);
+
+    n_bytes_per_texel = (n_component_bits[0] + n_component_bits[1] + n_component_bits[2] + n_component_bits[3]) / 8 /* bits in byte */;
+
+    anvil_assert(n_bytes_per_texel > 0);
+
+    /* Buffer offsets used for image copies must be a multiple of both the texel size and 4 */
+    alignment = std::max(m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits.optimal_buffer_copy_offset_alignment,
+                         static_cast<VkDeviceSize>(n_bytes_per_texel * 4) );
+
+    if (!allocate_region(static_cast<VkDeviceSize>(n_bytes_per_texel) * in_extent.width * in_extent.height * in_extent.depth,
+                         alignment,
+                         out_readback_id_ptr) )
+    {
+        goto end;
+    }
+
+    region_ptr = &m_regions.back();
+
+    copy_region.buffer_image_height = 0; /* tight packing */
+    copy_region.buffer_offset       = region_ptr->start_offset;
+    copy_region.buffer_row_length   = 0; /* tight packing */
+    copy_region.image_extent        = in_extent;
+    copy_region.image_offset        = in_offset;
+    copy_region.image_subresource   = in_subresource;
+
+    {
+        Anvil::BufferBarrier post_copy_barrier(Anvil::AccessFlagBits::TRANSFER_WRITE_BIT,
+                                               Anvil::AccessFlagBits::HOST_READ_BIT,
+                                               VK_QUEUE_FAMILY_IGNORED,
+                                               VK_QUEUE_FAMILY_IGNORED,
+                                               m_buffer_ptr.get(),
+                                               region_ptr->start_offset,
+                                               region_ptr->size);
+        Anvil::MemoryBarrier pre_copy_barrier (Anvil::AccessFlagBits::TRANSFER_READ_BIT, /* in_destination_access_mask */
+                                               Anvil::AccessFlagBits::COLOR_ATTACHMENT_WRITE_BIT | Anvil::AccessFlagBits::SHADER_WRITE_BIT | Anvil::AccessFlagBits::TRANSFER_WRITE_BIT);
+
+        in_cmd_buffer_ptr->record_pipeline_barrier    (Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT, /* in_src_stage_mask */
+                                                       Anvil::PipelineStageFlagBits::TRANSFER_BIT,     /* in_dst_stage_mask */
+                                                       Anvil::DependencyFlagBits::NONE,
+                                                       1,        /* in_memory_barrier_count        */
+                                                      &pre_copy_barrier,
+                                                       0,        /* in_buffer_memory_barrier_count */
+                                                       nullptr,  /* in_buffer_memory_barriers_ptr  */
+                                                       0,        /* in_image_memory_barrier_count  */
+                                                       nullptr); /* in_image_memory_barriers_ptr   */
+        in_cmd_buffer_ptr->record_copy_image_to_buffer(in_image_ptr,
+                                                       in_image_layout,
+                                                       m_buffer_ptr.get(),
+                                                       1, /* in_region_count */
+                                                      &copy_region);
+        in_cmd_buffer_ptr->record_pipeline_barrier    (Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                       Anvil::PipelineStageFlagBits::HOST_BIT,
+                                                       Anvil::DependencyFlagBits::NONE,
+                                                       0,        /* in_memory_barrier_count        */
+                                                       nullptr,  /* in_memory_barriers_ptr         */
+                                                       1,        /* in_buffer_memory_barrier_count */
+                                                      &post_copy_barrier,
+                                                       0,        /* in_image_memory_barrier_count  */
+                                                       nullptr); /* in_image_memory_barriers_ptr   */
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::ReadbackRing::release(ReadbackID in_readback_id)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+    Region*                                    region_ptr(get_region(in_readback_id) );
+
+    anvil_assert(region_ptr != nullptr);
+
+    if (region_ptr != nullptr)
+    {
+        region_ptr->is_released = true;
+
+        retire_regions();
+    }
+}
+
+/** Drops all released regions at the front of the ring whose copies have completed. */
+void Anvil::ReadbackRing::retire_regions()
+{
+    while (!m_regions.empty() )
+    {
+        auto& oldest_region = m_regions.front();
+
+        if (!oldest_region.is_released           ||
+            !is_region_complete(&oldest_region) )
+        {
+            break;
+        }
+
+        if (oldest_region.owned_fence_ptr != nullptr)
+        {
+            m_free_fences.push_back(std::move(oldest_region.owned_fence_ptr) );
+        }
+
+        m_regions.pop_front();
+
+        ++m_first_region_id;
+    }
+
+    if (m_regions.empty() )
+    {
+        m_head_offset = 0;
+    }
+}
+
+/** Please see header for specification */
+bool Anvil::ReadbackRing::submit_buffer_readback(Anvil::Queue*  in_queue_ptr,
+                                                 Anvil::Buffer* in_buffer_ptr,
+                                                 VkDeviceSize   in_start_offset,
+                                                 VkDeviceSize   in_size,
+                                                 ReadbackID*    out_readback_id_ptr)
+{
+    Anvil::PrimaryCommandBufferUniquePtr       cmd_buffer_ptr;
+    Anvil::FenceUniquePtr                      fence_ptr;
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock    (*get_mutex() );
+    Region*                                    region_ptr    (nullptr);
+    bool                                       result        (false);
+
+    anvil_assert(in_queue_ptr != nullptr);
+
+    /* The command buffer is released by the ring once the copy completes, possibly on a different thread,
+     * so it must not come from the calling thread's pool. */
+    cmd_buffer_ptr = m_device_ptr->get_command_pool_for_queue_family_index(in_queue_ptr->get_queue_family_index() )->alloc_primary_level_command_buffer();
+    fence_ptr      = get_fence();
+
+    if (cmd_buffer_ptr == nullptr ||
+        fence_ptr      == nullptr)
+    {
+        anvil_assert(cmd_buffer_ptr != nullptr);
+        anvil_assert(fence_ptr      != nullptr);
+
+        goto end;
+    }
+
+    cmd_buffer_ptr->start_recording(true,   /* one_time_submit          */
+                                    false); /* simultaneous_use_allowed */
+
+    if (!record_buffer_readback(cmd_buffer_ptr.get(),
+                                in_buffer_ptr,
+                                in_start_offset,
+                                in_size,
+                                out_readback_id_ptr) )
+    {
+        m_free_fences.push_back(std::move(fence_ptr) );
+
+        goto end;
+    }
+
+    cmd_buffer_ptr->stop_recording();
+
+    result = in_queue_ptr->submit(
+        Anvil::SubmitInfo::create_execute(cmd_buffer_ptr.get(),
+                                          false, /* should_block */
+                                          fence_ptr.get() )
+    );
+
+    region_ptr = get_region(*out_readback_id_ptr);
+
+    if (!result)
+    {
+        /* Nothing is going to write to the region, so it can be recycled straight away */
+        region_ptr->is_complete    = true;
+        region_ptr->is_frame_ended = true;
+        region_ptr->is_released    = true;
+
+        m_free_fences.push_back(std::move(fence_ptr) );
+
+        retire_regions();
+        goto end;
+    }
+
+    region_ptr->cmd_buffer_ptr  = std::move(cmd_buffer_ptr);
+    region_ptr->is_frame_ended  = true;
+    region_ptr->owned_fence_ptr = std::move(fence_ptr);
+
+end:
+    return result;
+}
+
+/** Tells whether a region of the requested size can be carved out of the ring without overlapping any of the
+ *  regions still in use.
+ *
+ *  @param in_size              Number of bytes required.
+ *  @param in_alignment         Required start offset alignment.
+ *  @param out_start_offset_ptr Deref will be set to the region's start offset if the function returns true.
+ *
+ *  @return true if space is available, false otherwise.
+ */
+bool Anvil::ReadbackRing::try_reserve_region(VkDeviceSize  in_size,
+                                             VkDeviceSize  in_alignment,
+                                             VkDeviceSize* out_start_offset_ptr) const
+{
+    const VkDeviceSize aligned_head_offset = Anvil::Utils::round_up(m_head_offset,
+                                                                    in_alignment);
+    bool               result              = false;
+
+    if (m_regions.empty() )
+    {
+        *out_start_offset_ptr = 0;
+        result                = true;
+    }
+    else
+    {
+        const VkDeviceSize tail_offset = m_regions.front().start_offset;
+
+        if (m_head_offset > tail_offset)
+        {
+            /* Used space is contiguous: [tail, head). Try the end of the ring first, then wrap around. */
+            if (aligned_head_offset + in_size <= m_size)
+            {
+                *out_start_offset_ptr = aligned_head_offset;
+                result                = true;
+            }
+            else
+            if (in_size <= tail_offset)
+            {
+                *out_start_offset_ptr = 0;
+                result                = true;
+            }
+        }
+        else
+        {
+            /* The ring has wrapped around. Free space is [head, tail). */
+            if (aligned_head_offset + in_size <= tail_offset)
+            {
+                *out_start_offset_ptr = aligned_head_offset;
+                result                = true;
+            }
+        }
+    }
+
+    return result;
+}
+
+/** Blocks until the copy into the specified region completes. The region's frame must have been ended. */
+void Anvil::ReadbackRing::wait_for_region(Region* in_region_ptr) const
+{
+    Anvil::Fence* fence_ptr = (in_region_ptr->owned_fence_ptr != nullptr) ? in_region_ptr->owned_fence_ptr.get()
+                                                                           : in_region_ptr->fence_ptr;
+
+    anvil_assert(in_region_ptr->is_frame_ended);
+
+    if (in_region_ptr->is_complete)
+    {
+        return;
+    }
+
+    if (fence_ptr != nullptr)
+    {
+        m_device_ptr->get_dispatch_table().vkWaitForFences(m_device_ptr->get_device_vk(),
+                                                           1, /* fenceCount */
+                                                           fence_ptr->get_fence_ptr(),
+                                                           VK_TRUE,     /* waitAll */
+                                                           UINT64_MAX); /* timeout */
+    }
+    else
+    {
+        anvil_assert(in_region_ptr->semaphore_ptr != nullptr);
+
+        in_region_ptr->semaphore_ptr->wait(in_region_ptr->semaphore_value);
+    }
+}
@@ -0,0 +1,146 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#include "misc/debug.h"
+#include "misc/render_pass_cache.h"
+#include "misc/render_pass_create_info.h"
+#include "wrappers/render_pass.h"
+
+
+/** Please see header for specification */
+Anvil::RenderPassCache::RenderPassCache(const Anvil::BaseDevice* in_device_ptr)
+    :MTSafetySupportProvider(true),
+     m_device_ptr           (in_device_ptr),
+     m_n_cache_hits         (0),
+     m_n_cache_misses       (0)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::RenderPassCache::~RenderPassCache()
+{
+    /* Render passes are owned by the pointers handed out to the app. */
+}
+
+/** Please see header for specification */
+Anvil::RenderPassCacheUniquePtr Anvil::RenderPassCache::create(const Anvil::BaseDevice* in_device_ptr)
+{
+    Anvil::RenderPassCacheUniquePtr result_ptr(nullptr,
+                                               std::default_delete<Anvil::RenderPassCache>() );
+
+    anvil_assert(in_device_ptr != nullptr);
+
+    result_ptr.reset(
+        new Anvil::RenderPassCache(in_device_ptr)
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::RenderPassCache::get_n_cached_render_passes() const
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+    uint32_t                                   result    (0);
+
+    for (const auto& current_bucket : m_render_passes)
+    {
+        for (const auto& current_render_pass_ptr : current_bucket.second)
+        {
+            if (!current_render_pass_ptr.expired() )
+            {
+                ++result;
+            }
+        }
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::RenderPassSharedPtr Anvil::RenderPassCache::get_render_pass(Anvil::RenderPassCreateInfoUniquePtr in_create_info_ptr,
+                                                                   Anvil::Swapchain*                    in_opt_swapchain_ptr)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+    uint64_t                                   hash;
+    Anvil::RenderPassSharedPtr                 result_ptr;
+
+    if (in_create_info_ptr == nullptr)
+    {
+        anvil_assert(in_create_info_ptr != nullptr);
+
+        goto end;
+    }
+
+    anvil_assert(in_create_info_ptr->get_device() == m_device_ptr);
+
+    hash = in_create_info_ptr->get_hash() ^ std::hash<Anvil::Swapchain*>()(in_opt_swapchain_ptr);
+
+    {
+        auto& bucket = m_render_passes[hash];
+
+        for (auto render_pass_iterator  = bucket.begin();
+                  render_pass_iterator != bucket.end();
+                 )
+        {
+            auto render_pass_ptr = render_pass_iterator->lock();
+
+            /* Drop entries of render passes which have been released in the meantime */
+            if (render_pass_ptr == nullptr)
+            {
+                render_pass_iterator = bucket.erase(render_pass_iterator);
+
+                continue;
+            }
+
+            if ( render_pass_ptr->get_swapchain()              == in_opt_swapchain_ptr &&
+                *render_pass_ptr->get_render_pass_create_info() == *in_create_info_ptr)
+            {
+                result_ptr = std::move(render_pass_ptr);
+
+                ++m_n_cache_hits;
+                goto end;
+            }
+
+            ++render_pass_iterator;
+        }
+
+        result_ptr = Anvil::RenderPassSharedPtr(
+            Anvil::RenderPass::create(std::move(in_create_info_ptr),
+                                      in_opt_swapchain_ptr)
+        );
+
+        if (result_ptr == nullptr)
+        {
+            anvil_assert(result_ptr != nullptr);
+
+            goto end;
+        }
+
+        bucket.push_back(result_ptr);
+
+        ++m_n_cache_misses;
+    }
+
+end:
+    return result_ptr;
+}
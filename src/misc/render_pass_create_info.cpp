@@ -21,6 +21,7 @@
 //
 
 #include "misc/render_pass_create_info.h"
+#include "misc/types_utils.h"
 #include "wrappers/device.h"
 #include <algorithm>
 #include <cmath>
@@ -274,6 +275,63 @@ bool Anvil::RenderPassCreateInfo::add_subpass_color_attachment(SubPassID
                                               Anvil::ImageAspectFlagBits::NONE); /* in_stencil_resolve_mode */
 }
 
+/* Please see header for specification */
+bool Anvil::RenderPassCreateInfo::add_subpass_color_attachment_with_resolve(SubPassID               in_subpass_id,
+                                                                            Anvil::ImageLayout      in_layout,
+                                                                            RenderPassAttachmentID  in_attachment_id,
+                                                                            uint32_t                in_location,
+                                                                            Anvil::ImageLayout      in_resolve_final_layout,
+                                                                            RenderPassAttachmentID* out_opt_resolve_attachment_id_ptr)
+{
+    Anvil::Format              format                = Anvil::Format::UNKNOWN;
+    RenderPassAttachmentID     resolve_attachment_id = UINT32_MAX;
+    bool                       result                = false;
+    Anvil::SampleCountFlagBits sample_count          = Anvil::SampleCountFlagBits::NONE;
+
+    if (!get_color_attachment_properties(in_attachment_id,
+                                        &format,
+                                        &sample_count) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (sample_count == Anvil::SampleCountFlagBits::_1_BIT)
+    {
+        anvil_assert(sample_count != Anvil::SampleCountFlagBits::_1_BIT);
+
+        goto end;
+    }
+
+    /* Resolve overwrites all texels of the attachment, so its previous contents are irrelevant */
+    if (!add_color_attachment(format,
+                              Anvil::SampleCountFlagBits::_1_BIT,
+                              Anvil::AttachmentLoadOp::DONT_CARE,
+                              Anvil::AttachmentStoreOp::STORE,
+                              Anvil::ImageLayout::UNDEFINED,
+                              in_resolve_final_layout,
+                              false, /* in_may_alias */
+                             &resolve_attachment_id) ||
+        !add_subpass_color_attachment(in_subpass_id,
+                                      in_layout,
+                                      in_attachment_id,
+                                      in_location,
+                                     &resolve_attachment_id) )
+    {
+        goto end;
+    }
+
+    if (out_opt_resolve_attachment_id_ptr != nullptr)
+    {
+        *out_opt_resolve_attachment_id_ptr = resolve_attachment_id;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
 /** Adds a new attachment to the specified subpass.
  *
  *  @param in_subpass_id            ID of the subpass to update. The subpass must have been earlier
@@ -461,6 +519,112 @@ end:
     return result;
 }
 
+/* Please see header for specification */
+bool Anvil::RenderPassCreateInfo::add_subpass_depth_stencil_attachment_with_resolve(SubPassID                  in_subpass_id,
+                                                                                    Anvil::ImageLayout         in_layout,
+                                                                                    RenderPassAttachmentID     in_attachment_id,
+                                                                                    Anvil::ResolveModeFlagBits in_depth_resolve_mode,
+                                                                                    Anvil::ResolveModeFlagBits in_stencil_resolve_mode,
+                                                                                    Anvil::ImageLayout         in_resolve_final_layout,
+                                                                                    RenderPassAttachmentID*    out_opt_resolve_attachment_id_ptr)
+{
+    Anvil::Format                                  format                = Anvil::Format::UNKNOWN;
+    const Anvil::KHRDepthStencilResolveProperties* properties_ptr        = nullptr;
+    RenderPassAttachmentID                         resolve_attachment_id = UINT32_MAX;
+    bool                                           result                = false;
+    Anvil::SampleCountFlagBits                     sample_count          = Anvil::SampleCountFlagBits::NONE;
+
+    /* DS resolve operations are only accessible via VK_KHR_create_renderpass2 */
+    if (!m_device_ptr->get_extension_info()->khr_depth_stencil_resolve() ||
+        !m_device_ptr->get_extension_info()->khr_create_renderpass2   () )
+    {
+        anvil_assert(m_device_ptr->get_extension_info()->khr_depth_stencil_resolve() &&
+                     m_device_ptr->get_extension_info()->khr_create_renderpass2   () );
+
+        goto end;
+    }
+
+    properties_ptr = m_device_ptr->get_physical_device_properties().khr_depth_stencil_resolve_properties_ptr;
+
+    if (properties_ptr == nullptr)
+    {
+        anvil_assert(properties_ptr != nullptr);
+
+        goto end;
+    }
+
+    /* Sanity checks: each mode must be supported. Different modes for both aspects, or only resolving one of them,
+     * require independent resolve support. */
+    if ((in_depth_resolve_mode   != Anvil::ResolveModeFlagBits::NONE                                                &&
+         (properties_ptr->supported_depth_resolve_modes   & in_depth_resolve_mode)   == 0)                         ||
+        (in_stencil_resolve_mode != Anvil::ResolveModeFlagBits::NONE                                                &&
+         (properties_ptr->supported_stencil_resolve_modes & in_stencil_resolve_mode) == 0) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (in_depth_resolve_mode != in_stencil_resolve_mode)
+    {
+        const bool is_either_none = (in_depth_resolve_mode   == Anvil::ResolveModeFlagBits::NONE ||
+                                     in_stencil_resolve_mode == Anvil::ResolveModeFlagBits::NONE);
+
+        if (!properties_ptr->independent_resolve                     &&
+            !(is_either_none && properties_ptr->independent_resolve_none) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    if (!get_depth_stencil_attachment_properties(in_attachment_id,
+                                                &format,
+                                                &sample_count) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (sample_count == Anvil::SampleCountFlagBits::_1_BIT)
+    {
+        anvil_assert(sample_count != Anvil::SampleCountFlagBits::_1_BIT);
+
+        goto end;
+    }
+
+    if (!add_depth_stencil_attachment(format,
+                                      Anvil::SampleCountFlagBits::_1_BIT,
+                                      Anvil::AttachmentLoadOp::DONT_CARE,
+                                      Anvil::AttachmentStoreOp::STORE,
+                                      Anvil::AttachmentLoadOp::DONT_CARE,
+                                      Anvil::AttachmentStoreOp::STORE,
+                                      Anvil::ImageLayout::UNDEFINED,
+                                      in_resolve_final_layout,
+                                      false, /* in_may_alias */
+                                     &resolve_attachment_id)           ||
+        !add_subpass_depth_stencil_attachment(in_subpass_id,
+                                              in_layout,
+                                              in_attachment_id,
+                                             &resolve_attachment_id,
+                                             &in_depth_resolve_mode,
+                                             &in_stencil_resolve_mode) )
+    {
+        goto end;
+    }
+
+    if (out_opt_resolve_attachment_id_ptr != nullptr)
+    {
+        *out_opt_resolve_attachment_id_ptr = resolve_attachment_id;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
 /* Please see header for specification */
 bool Anvil::RenderPassCreateInfo::add_subpass_input_attachment(SubPassID                      in_subpass_id,
                                                                Anvil::ImageLayout             in_layout,
@@ -680,6 +844,18 @@ end:
     return result;
 }
 
+/* Please see header for specification */
+uint64_t Anvil::RenderPassCreateInfo::get_compatibility_hash() const
+{
+    std::vector<uint64_t> key;
+
+    get_key(true, /* in_compatibility_only */
+           &key);
+
+    return Anvil::Utils::hash64(&key.at(0),
+                                key.size() * sizeof(uint64_t) );
+}
+
 /** Please see header for specification */
 bool Anvil::RenderPassCreateInfo::get_dependency_properties(uint32_t                   in_n_dependency,
                                                             SubPassID*                 out_destination_subpass_id_ptr,
@@ -813,6 +989,120 @@ end:
     return result;
 }
 
+/* Please see header for specification */
+uint64_t Anvil::RenderPassCreateInfo::get_hash() const
+{
+    std::vector<uint64_t> key;
+
+    get_key(false, /* in_compatibility_only */
+           &key);
+
+    return Anvil::Utils::hash64(&key.at(0),
+                                key.size() * sizeof(uint64_t) );
+}
+
+/** Serializes render pass properties into a vector of words. Two create info instances describe the same render pass
+ *  if their keys are equal.
+ *
+ *  @param in_compatibility_only true to only include properties which affect render pass compatibility. Attachment
+ *                               layouts and load/store ops are then skipped.
+ *  @param out_key_ptr           Deref will be set to the key. Must not be null.
+ **/
+void Anvil::RenderPassCreateInfo::get_key(bool                   in_compatibility_only,
+                                          std::vector<uint64_t>* out_key_ptr) const
+{
+    const auto append_subpass_attachment = [&](const SubPassAttachment& in_attachment)
+    {
+        out_key_ptr->push_back(in_attachment.attachment_index);
+        out_key_ptr->push_back(in_attachment.resolve_attachment_index);
+        out_key_ptr->push_back(in_attachment.aspects_accessed.get_vk() );
+        out_key_ptr->push_back(static_cast<uint64_t>(in_attachment.depth_resolve_mode) );
+        out_key_ptr->push_back(static_cast<uint64_t>(in_attachment.stencil_resolve_mode) );
+
+        if (!in_compatibility_only)
+        {
+            out_key_ptr->push_back(static_cast<uint64_t>(in_attachment.layout) );
+        }
+    };
+
+    const auto append_subpass_attachment_map = [&](const LocationToSubPassAttachmentMap& in_map)
+    {
+        out_key_ptr->push_back(in_map.size() );
+
+        for (const auto& current_location : in_map)
+        {
+            out_key_ptr->push_back(current_location.first);
+
+            append_subpass_attachment(current_location.second);
+        }
+    };
+
+    out_key_ptr->clear();
+
+    /* Attachments */
+    out_key_ptr->push_back(m_attachments.size() );
+
+    for (const auto& current_attachment : m_attachments)
+    {
+        out_key_ptr->push_back(static_cast<uint64_t>(current_attachment.format) );
+        out_key_ptr->push_back(static_cast<uint64_t>(current_attachment.sample_count) );
+        out_key_ptr->push_back(static_cast<uint64_t>(current_attachment.type) );
+        out_key_ptr->push_back((current_attachment.may_alias) ? 1 : 0);
+
+        if (!in_compatibility_only)
+        {
+            out_key_ptr->push_back(static_cast<uint64_t>(current_attachment.color_depth_load_op) );
+            out_key_ptr->push_back(static_cast<uint64_t>(current_attachment.color_depth_store_op) );
+            out_key_ptr->push_back(static_cast<uint64_t>(current_attachment.final_layout) );
+            out_key_ptr->push_back(static_cast<uint64_t>(current_attachment.initial_layout) );
+            out_key_ptr->push_back(static_cast<uint64_t>(current_attachment.stencil_load_op) );
+            out_key_ptr->push_back(static_cast<uint64_t>(current_attachment.stencil_store_op) );
+        }
+    }
+
+    /* Subpasses */
+    out_key_ptr->push_back(m_subpasses.size() );
+
+    for (const auto& current_subpass_ptr : m_subpasses)
+    {
+        out_key_ptr->push_back(current_subpass_ptr->multiview_view_mask);
+
+        append_subpass_attachment_map(current_subpass_ptr->color_attachments_map);
+        append_subpass_attachment_map(current_subpass_ptr->input_attachments_map);
+        append_subpass_attachment_map(current_subpass_ptr->resolved_attachments_map);
+
+        append_subpass_attachment(current_subpass_ptr->depth_stencil_attachment);
+        append_subpass_attachment(current_subpass_ptr->ds_resolve_attachment);
+    }
+
+    /* Dependencies */
+    out_key_ptr->push_back(m_subpass_dependencies.size() );
+
+    for (const auto& current_dependency : m_subpass_dependencies)
+    {
+        out_key_ptr->push_back((current_dependency.destination_subpass_ptr != nullptr) ? current_dependency.destination_subpass_ptr->index
+                                                                                       : UINT32_MAX);
+        out_key_ptr->push_back((current_dependency.source_subpass_ptr      != nullptr) ? current_dependency.source_subpass_ptr->index
+                                                                                       : UINT32_MAX);
+
+        out_key_ptr->push_back(current_dependency.destination_access_mask.get_vk() );
+        out_key_ptr->push_back(current_dependency.destination_stage_mask.get_vk () );
+        out_key_ptr->push_back(current_dependency.flags.get_vk                  () );
+        out_key_ptr->push_back(static_cast<uint32_t>(current_dependency.multiview_view_offset) );
+        out_key_ptr->push_back(current_dependency.source_access_mask.get_vk     () );
+        out_key_ptr->push_back(current_dependency.source_stage_mask.get_vk      () );
+    }
+
+    /* Multiview */
+    out_key_ptr->push_back((m_multiview_enabled) ? 1 : 0);
+    out_key_ptr->push_back(m_correlation_masks.size() );
+
+    for (const auto& current_mask : m_correlation_masks)
+    {
+        out_key_ptr->push_back(current_mask);
+    }
+}
+
 /* Please see header for specification */
 uint32_t Anvil::RenderPassCreateInfo::get_max_color_location_used_by_subpass(const SubPassID& in_subpass_id) const
 {
@@ -1169,6 +1459,36 @@ end:
     return result;
 }
 
+/* Please see header for specification */
+bool Anvil::RenderPassCreateInfo::is_compatible_with(const Anvil::RenderPassCreateInfo& in_create_info) const
+{
+    std::vector<uint64_t> in_key;
+    std::vector<uint64_t> this_key;
+
+    get_key               (true, /* in_compatibility_only */
+                          &this_key);
+    in_create_info.get_key(true, /* in_compatibility_only */
+                          &in_key);
+
+    return (m_device_ptr == in_create_info.m_device_ptr &&
+            this_key     == in_key);
+}
+
+/* Please see header for specification */
+bool Anvil::RenderPassCreateInfo::operator==(const Anvil::RenderPassCreateInfo& in_create_info) const
+{
+    std::vector<uint64_t> in_key;
+    std::vector<uint64_t> this_key;
+
+    get_key               (false, /* in_compatibility_only */
+                          &this_key);
+    in_create_info.get_key(false, /* in_compatibility_only */
+                          &in_key);
+
+    return (m_device_ptr == in_create_info.m_device_ptr &&
+            this_key     == in_key);
+}
+
 /* Please see header for specification */
 void Anvil::RenderPassCreateInfo::set_correlation_masks(const uint32_t& in_n_correlation_masks,
                                                         const uint32_t* in_correlation_masks_ptr)
@@ -0,0 +1,144 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/sampler_cache.h"
+#include "misc/sampler_create_info.h"
+#include "wrappers/sampler.h"
+
+
+/** Please see header for specification */
+Anvil::SamplerCache::SamplerCache(const Anvil::BaseDevice* in_device_ptr)
+    :MTSafetySupportProvider(true),
+     m_device_ptr           (in_device_ptr),
+     m_n_cache_hits         (0),
+     m_n_cache_misses       (0)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::SamplerCache::~SamplerCache()
+{
+    /* Samplers are owned by the pointers handed out to the app. */
+}
+
+/** Please see header for specification */
+Anvil::SamplerCacheUniquePtr Anvil::SamplerCache::create(const Anvil::BaseDevice* in_device_ptr)
+{
+    Anvil::SamplerCacheUniquePtr result_ptr(nullptr,
+                                            std::default_delete<Anvil::SamplerCache>() );
+
+    anvil_assert(in_device_ptr != nullptr);
+
+    result_ptr.reset(
+        new Anvil::SamplerCache(in_device_ptr)
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::SamplerCache::get_n_cached_samplers() const
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+    uint32_t                                   result    (0);
+
+    for (const auto& current_bucket : m_samplers)
+    {
+        for (const auto& current_sampler_ptr : current_bucket.second)
+        {
+            if (!current_sampler_ptr.expired() )
+            {
+                ++result;
+            }
+        }
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::SamplerSharedPtr Anvil::SamplerCache::get_sampler(Anvil::SamplerCreateInfoUniquePtr in_create_info_ptr)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+    uint64_t                                   hash;
+    Anvil::SamplerSharedPtr                    result_ptr;
+
+    if (in_create_info_ptr == nullptr)
+    {
+        anvil_assert(in_create_info_ptr != nullptr);
+
+        goto end;
+    }
+
+    anvil_assert(in_create_info_ptr->get_device() == m_device_ptr);
+
+    hash = in_create_info_ptr->get_hash();
+
+    {
+        auto& bucket = m_samplers[hash];
+
+        for (auto sampler_iterator  = bucket.begin();
+                  sampler_iterator != bucket.end();
+                 )
+        {
+            auto sampler_ptr = sampler_iterator->lock();
+
+            /* Drop entries of samplers which have been released in the meantime */
+            if (sampler_ptr == nullptr)
+            {
+                sampler_iterator = bucket.erase(sampler_iterator);
+
+                continue;
+            }
+
+            if (*sampler_ptr->get_create_info_ptr() == *in_create_info_ptr)
+            {
+                result_ptr = std::move(sampler_ptr);
+
+                ++m_n_cache_hits;
+                goto end;
+            }
+
+            ++sampler_iterator;
+        }
+
+        result_ptr = Anvil::SamplerSharedPtr(
+            Anvil::Sampler::create(std::move(in_create_info_ptr) )
+        );
+
+        if (result_ptr == nullptr)
+        {
+            anvil_assert(result_ptr != nullptr);
+
+            goto end;
+        }
+
+        bucket.push_back(result_ptr);
+
+        ++m_n_cache_misses;
+    }
+
+end:
+    return result_ptr;
+}
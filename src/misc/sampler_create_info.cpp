@@ -21,6 +21,7 @@
 //
 
 #include "misc/sampler_create_info.h"
+#include <cstring>
 
 Anvil::SamplerCreateInfoUniquePtr Anvil::SamplerCreateInfo::create(const Anvil::BaseDevice*  in_device_ptr,
                                                                    Anvil::Filter             in_mag_filter,
@@ -100,3 +101,65 @@ Anvil::SamplerCreateInfo::SamplerCreateInfo(const Anvil::BaseDevice*    in_devic
 {
     /* Stub */
 }
+
+/** Please see header for specification */
+uint64_t Anvil::SamplerCreateInfo::get_hash() const
+{
+    const float float_values[] =
+    {
+        m_lod_bias,
+        m_max_anisotropy,
+        m_max_lod,
+        m_min_lod
+    };
+    uint64_t words[16]; /* 14 properties + 4 floats packed into 2 words */
+
+    words[0]  = static_cast<uint64_t>(m_address_mode_u);
+    words[1]  = static_cast<uint64_t>(m_address_mode_v);
+    words[2]  = static_cast<uint64_t>(m_address_mode_w);
+    words[3]  = static_cast<uint64_t>(m_border_color);
+    words[4]  = (m_compare_enable) ? 1 : 0;
+    words[5]  = static_cast<uint64_t>(m_compare_op);
+    words[6]  = reinterpret_cast<uint64_t>(m_device_ptr);
+    words[7]  = static_cast<uint64_t>(m_mag_filter);
+    words[8]  = static_cast<uint64_t>(m_min_filter);
+    words[9]  = static_cast<uint64_t>(m_mipmap_mode);
+    words[10] = static_cast<uint64_t>(m_mt_safety);
+    words[11] = static_cast<uint64_t>(m_sampler_reduction_mode);
+    words[12] = reinterpret_cast<uint64_t>(m_sampler_ycbcr_conversion_ptr);
+    words[13] = (m_use_unnormalized_coordinates) ? 1 : 0;
+
+    /* Floats are hashed by their bit patterns */
+    static_assert(sizeof(float_values) == sizeof(uint64_t) * 2,
+                  "Float properties must fill the two trailing words");
+
+    memcpy(&words[14],
+           float_values,
+           sizeof(float_values) );
+
+    return Anvil::Utils::hash64(words,
+                                sizeof(words) );
+}
+
+/** Please see header for specification */
+bool Anvil::SamplerCreateInfo::operator==(const Anvil::SamplerCreateInfo& in_create_info) const
+{
+    return (m_address_mode_u               == in_create_info.m_address_mode_u               &&
+            m_address_mode_v               == in_create_info.m_address_mode_v               &&
+            m_address_mode_w               == in_create_info.m_address_mode_w               &&
+            m_border_color                 == in_create_info.m_border_color                 &&
+            m_compare_enable               == in_create_info.m_compare_enable               &&
+            m_compare_op                   == in_create_info.m_compare_op                   &&
+            m_device_ptr                   == in_create_info.m_device_ptr                   &&
+            m_lod_bias                     == in_create_info.m_lod_bias                     &&
+            m_mag_filter                   == in_create_info.m_mag_filter                   &&
+            m_max_anisotropy               == in_create_info.m_max_anisotropy               &&
+            m_max_lod                      == in_create_info.m_max_lod                      &&
+            m_min_filter                   == in_create_info.m_min_filter                   &&
+            m_min_lod                      == in_create_info.m_min_lod                      &&
+            m_mipmap_mode                  == in_create_info.m_mipmap_mode                  &&
+            m_mt_safety                    == in_create_info.m_mt_safety                    &&
+            m_sampler_reduction_mode       == in_create_info.m_sampler_reduction_mode       &&
+            m_sampler_ycbcr_conversion_ptr == in_create_info.m_sampler_ycbcr_conversion_ptr &&
+            m_use_unnormalized_coordinates == in_create_info.m_use_unnormalized_coordinates);
+}
@@ -43,7 +43,9 @@ Anvil::SemaphoreCreateInfo::SemaphoreCreateInfo(const Anvil::BaseDevice* in_devi
      m_exportable_nt_handle_info_specified                    (false),
      m_exportable_nt_handle_info_security_attributes_specified(false),
 #endif
-     m_mt_safety                                              (in_mt_safety)
+     m_initial_value                                          (0),
+     m_mt_safety                                              (in_mt_safety),
+     m_semaphore_type                                         (Anvil::SemaphoreType::BINARY)
 {
     /* Stub */
 }
\ No newline at end of file
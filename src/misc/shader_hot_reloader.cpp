@@ -0,0 +1,327 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "misc/debug.h"
+#include "misc/glsl_header_cache.h"
+#include "misc/glsl_to_spirv.h"
+#include "misc/io.h"
+#include "misc/shader_hot_reloader.h"
+#include "wrappers/compute_pipeline_manager.h"
+#include "wrappers/device.h"
+#include "wrappers/graphics_pipeline_manager.h"
+#include "wrappers/shader_module.h"
+#include <set>
+
+
+/** Please see header for specification */
+Anvil::ShaderHotReloader::ShaderHotReloader(const Anvil::BaseDevice* in_device_ptr)
+    :m_device_ptr(in_device_ptr)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::ShaderHotReloader::~ShaderHotReloader()
+{
+    m_shaders.clear               ();
+    m_retired_shader_modules.clear();
+}
+
+/** Please see header for specification */
+bool Anvil::ShaderHotReloader::add_shader(Anvil::GLSLShaderToSPIRVGeneratorUniquePtr in_glsl_generator_ptr,
+                                          uint32_t*                                  out_shader_id_ptr)
+{
+    std::unique_ptr<Shader> new_shader_ptr(new Shader() );
+    bool                    result        = false;
+
+    anvil_assert(in_glsl_generator_ptr != nullptr);
+
+    if (in_glsl_generator_ptr->get_mode() != Anvil::GLSLShaderToSPIRVGenerator::MODE_LOAD_SOURCE_FROM_FILE)
+    {
+        anvil_assert(in_glsl_generator_ptr->get_mode() == Anvil::GLSLShaderToSPIRVGenerator::MODE_LOAD_SOURCE_FROM_FILE);
+
+        goto end;
+    }
+
+    if (!Anvil::IO::get_file_modification_time(in_glsl_generator_ptr->get_data(),
+                                              &new_shader_ptr->modification_time) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (in_glsl_generator_ptr->get_spirv_blob() == nullptr)
+    {
+        goto end;
+    }
+
+    new_shader_ptr->shader_module_ptr = Anvil::ShaderModule::create_from_spirv_generator(m_device_ptr,
+                                                                                         in_glsl_generator_ptr.get() );
+
+    if (new_shader_ptr->shader_module_ptr == nullptr)
+    {
+        anvil_assert(new_shader_ptr->shader_module_ptr != nullptr);
+
+        goto end;
+    }
+
+    new_shader_ptr->glsl_generator_ptr = std::move(in_glsl_generator_ptr);
+
+    update_include_modification_times(new_shader_ptr.get() );
+
+    *out_shader_id_ptr = static_cast<uint32_t>(m_shaders.size() );
+
+    m_shaders.push_back(
+        std::move(new_shader_ptr)
+    );
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::ShaderHotReloaderUniquePtr Anvil::ShaderHotReloader::create(const Anvil::BaseDevice* in_device_ptr)
+{
+    Anvil::ShaderHotReloaderUniquePtr result_ptr(nullptr,
+                                                 std::default_delete<Anvil::ShaderHotReloader>() );
+
+    anvil_assert(in_device_ptr != nullptr);
+
+    result_ptr.reset(
+        new Anvil::ShaderHotReloader(in_device_ptr)
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+const Anvil::GLSLShaderToSPIRVGenerator* Anvil::ShaderHotReloader::get_glsl_generator(uint32_t in_shader_id) const
+{
+    anvil_assert(in_shader_id < m_shaders.size() );
+
+    return m_shaders.at(in_shader_id)->glsl_generator_ptr.get();
+}
+
+/** Please see header for specification */
+Anvil::ShaderModule* Anvil::ShaderHotReloader::get_shader_module(uint32_t in_shader_id) const
+{
+    anvil_assert(in_shader_id < m_shaders.size() );
+
+    return m_shaders.at(in_shader_id)->shader_module_ptr.get();
+}
+
+/** Please see header for specification */
+bool Anvil::ShaderHotReloader::poll(std::vector<uint32_t>* out_opt_reloaded_shader_ids_ptr)
+{
+    std::set<std::pair<Anvil::GLSLHeaderCache*, std::string> > invalidated_headers;
+    bool                                                        result = true;
+
+    if (out_opt_reloaded_shader_ids_ptr != nullptr)
+    {
+        out_opt_reloaded_shader_ids_ptr->clear();
+    }
+
+    for (uint32_t n_shader = 0;
+                  n_shader < static_cast<uint32_t>(m_shaders.size() );
+                ++n_shader)
+    {
+        auto&                   current_shader_ptr = m_shaders.at(n_shader);
+        Anvil::GLSLHeaderCache* header_cache_ptr   = current_shader_ptr->glsl_generator_ptr->get_header_cache();
+        bool                    is_changed         = false;
+        bool                    is_reloaded        = false;
+        uint64_t                modification_time  = 0;
+
+        if (!Anvil::IO::get_file_modification_time(current_shader_ptr->glsl_generator_ptr->get_data(),
+                                                  &modification_time) )
+        {
+            /* The file is being replaced by the editor. */
+            continue;
+        }
+
+        if (modification_time != current_shader_ptr->modification_time)
+        {
+            current_shader_ptr->modification_time = modification_time;
+
+            is_changed = true;
+        }
+
+        for (const auto& current_include : current_shader_ptr->include_modification_times)
+        {
+            uint64_t include_modification_time = 0;
+
+            if (!Anvil::IO::get_file_modification_time(current_include.first,
+                                                      &include_modification_time) ||
+                include_modification_time == current_include.second)
+            {
+                continue;
+            }
+
+            /* Make sure the new contents of the header are used. Headers shared by many shaders only need to be re-read once. */
+            if (header_cache_ptr != nullptr &&
+                invalidated_headers.insert(std::make_pair(header_cache_ptr,
+                                                          current_include.first) ).second)
+            {
+                header_cache_ptr->invalidate(current_include.first);
+            }
+
+            is_changed = true;
+        }
+
+        if (!is_changed)
+        {
+            continue;
+        }
+
+        is_reloaded = reload_shader(current_shader_ptr.get() );
+
+        if (!is_reloaded)
+        {
+            result = false;
+        }
+
+        /* The set of included headers may have changed, too. If the shader failed to compile, this still reflects
+         * the headers which were included up to the point of failure, so that fixing any of them triggers a retry. */
+        update_include_modification_times(current_shader_ptr.get() );
+
+        if (!is_reloaded)
+        {
+            continue;
+        }
+
+        if (out_opt_reloaded_shader_ids_ptr != nullptr)
+        {
+            out_opt_reloaded_shader_ids_ptr->push_back(n_shader);
+        }
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::ShaderHotReloader::release_retired_objects()
+{
+    Anvil::BasePipelineManager* const pipeline_manager_ptrs[] =
+    {
+        m_device_ptr->get_compute_pipeline_manager (),
+        m_device_ptr->get_graphics_pipeline_manager()
+    };
+
+    for (const auto& current_pipeline_manager_ptr : pipeline_manager_ptrs)
+    {
+        if (current_pipeline_manager_ptr != nullptr)
+        {
+            current_pipeline_manager_ptr->release_retired_pipelines();
+        }
+    }
+
+    m_retired_shader_modules.clear();
+}
+
+/** Re-bakes the SPIR-V blob of the specified shader, creates a new shader module for it and makes all pipelines
+ *  which use the previous module use the new one instead. The previous module is retired.
+ *
+ *  @param in_shader_ptr Shader to reload. Must not be null.
+ *
+ *  @return true if successful, false if the shader failed to compile. In the latter case, the shader is left intact.
+ */
+bool Anvil::ShaderHotReloader::reload_shader(Shader* in_shader_ptr)
+{
+    Anvil::ShaderModuleUniquePtr      new_shader_module_ptr;
+    Anvil::BasePipelineManager* const pipeline_manager_ptrs[] =
+    {
+        m_device_ptr->get_compute_pipeline_manager (),
+        m_device_ptr->get_graphics_pipeline_manager()
+    };
+    bool                              result = false;
+
+    in_shader_ptr->glsl_generator_ptr->reset_baked_data();
+
+    if (in_shader_ptr->glsl_generator_ptr->get_spirv_blob() == nullptr)
+    {
+        goto end;
+    }
+
+    new_shader_module_ptr = Anvil::ShaderModule::create_from_spirv_generator(m_device_ptr,
+                                                                             in_shader_ptr->glsl_generator_ptr.get() );
+
+    if (new_shader_module_ptr == nullptr)
+    {
+        anvil_assert(new_shader_module_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (new_shader_module_ptr.get() == in_shader_ptr->shader_module_ptr.get() )
+    {
+        /* The change did not affect the SPIR-V blob, and the shader module cache has returned the current module */
+        new_shader_module_ptr.release();
+
+        result = true;
+        goto end;
+    }
+
+    for (const auto& current_pipeline_manager_ptr : pipeline_manager_ptrs)
+    {
+        if (current_pipeline_manager_ptr != nullptr)
+        {
+            current_pipeline_manager_ptr->replace_shader_module(in_shader_ptr->shader_module_ptr.get(),
+                                                                new_shader_module_ptr.get() );
+        }
+    }
+
+    m_retired_shader_modules.push_back(
+        std::move(in_shader_ptr->shader_module_ptr)
+    );
+
+    in_shader_ptr->shader_module_ptr = std::move(new_shader_module_ptr);
+
+    result = true;
+end:
+    return result;
+}
+
+/** Records modification times of all headers the shader's generator reported as included from disk.
+ *
+ *  Headers which do not live on disk (see GLSLHeaderCache::add_header() ) are skipped.
+ *
+ *  @param in_shader_ptr Shader to update. Must not be null.
+ */
+void Anvil::ShaderHotReloader::update_include_modification_times(Shader* in_shader_ptr)
+{
+    const auto include_dependencies = in_shader_ptr->glsl_generator_ptr->get_include_dependencies();
+
+    in_shader_ptr->include_modification_times.clear();
+
+    for (const auto& current_include_dependency : include_dependencies)
+    {
+        uint64_t modification_time = 0;
+
+        if (Anvil::IO::get_file_modification_time(current_include_dependency,
+                                                 &modification_time) )
+        {
+            in_shader_ptr->include_modification_times[current_include_dependency] = modification_time;
+        }
+    }
+}
@@ -26,7 +26,8 @@
 
 /** Please see header for documentation */
 Anvil::ShaderModuleCache::ShaderModuleCache()
-    :MTSafetySupportProvider(true)
+    :MTSafetySupportProvider(true,   /* in_enable            */
+                             false)  /* in_is_lock_recursive */
 {
     update_subscriptions(true);
 }
@@ -40,83 +41,64 @@ Anvil::ShaderModuleCache::~ShaderModuleCache()
 /** TODO */
 void Anvil::ShaderModuleCache::cache(Anvil::ShaderModule* in_shader_module_ptr)
 {
-    const auto shader_module_cs_entrypoint_name = in_shader_module_ptr->get_cs_entrypoint_name();
-    const auto shader_module_device_ptr         = in_shader_module_ptr->get_parent_device     ();
-    const auto shader_module_fs_entrypoint_name = in_shader_module_ptr->get_fs_entrypoint_name();
-    const auto shader_module_gs_entrypoint_name = in_shader_module_ptr->get_gs_entrypoint_name();
-    const auto shader_module_spirv_blob         = in_shader_module_ptr->get_spirv_blob();
-    const auto shader_module_tc_entrypoint_name = in_shader_module_ptr->get_tc_entrypoint_name();
-    const auto shader_module_te_entrypoint_name = in_shader_module_ptr->get_te_entrypoint_name();
-    const auto shader_module_vs_entrypoint_name = in_shader_module_ptr->get_vs_entrypoint_name();
-
-    const size_t hash(get_hash(reinterpret_cast<const char*>(&shader_module_spirv_blob.at(0) ),
-                               static_cast<uint32_t>(shader_module_spirv_blob.size() * sizeof(shader_module_spirv_blob.at(0) )),
-                               shader_module_cs_entrypoint_name,
-                               shader_module_fs_entrypoint_name,
-                               shader_module_gs_entrypoint_name,
-                               shader_module_tc_entrypoint_name,
-                               shader_module_te_entrypoint_name,
-                               shader_module_vs_entrypoint_name) );
-
     anvil_assert(in_shader_module_ptr != nullptr);
 
+    const auto& shader_module_cs_entrypoint_name = in_shader_module_ptr->get_cs_entrypoint_name();
+    const auto  shader_module_device_ptr         = in_shader_module_ptr->get_parent_device     ();
+    const auto& shader_module_fs_entrypoint_name = in_shader_module_ptr->get_fs_entrypoint_name();
+    const auto& shader_module_gs_entrypoint_name = in_shader_module_ptr->get_gs_entrypoint_name();
+    const auto& shader_module_spirv_blob         = in_shader_module_ptr->get_spirv_blob        ();
+    const auto& shader_module_tc_entrypoint_name = in_shader_module_ptr->get_tc_entrypoint_name();
+    const auto& shader_module_te_entrypoint_name = in_shader_module_ptr->get_te_entrypoint_name();
+    const auto& shader_module_vs_entrypoint_name = in_shader_module_ptr->get_vs_entrypoint_name();
+
+    /* The SPIR-V blob hash has already been computed by the shader module at creation time. */
+    const uint64_t hash(get_hash(in_shader_module_ptr->get_spirv_blob_hash(),
+                                 shader_module_cs_entrypoint_name,
+                                 shader_module_fs_entrypoint_name,
+                                 shader_module_gs_entrypoint_name,
+                                 shader_module_tc_entrypoint_name,
+                                 shader_module_te_entrypoint_name,
+                                 shader_module_vs_entrypoint_name) );
+
     {
-        std::unique_lock<std::recursive_mutex> mutex_lock(*get_mutex() );
+        std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
 
-        auto items_map_iterator    = m_item_ptrs.find(hash);
-        bool should_store_new_item = false;
+        auto& item_list             = m_item_ptrs[hash];
+        bool  should_store_new_item = true;
 
-        if (items_map_iterator == m_item_ptrs.end() )
-        {
-            /* No collision case */
-            should_store_new_item = true;
-        }
-        else
+        /* The item we are being asked to cache might be already there. Make sure this is not the case
+         * before stashing the new structure.
+         */
+        for (const auto& current_item_ptr : item_list)
         {
-            /* The item we are being asked to cache might be already there. Make sure this is not the case
-             * before stashing the new structure.
-             */
-            bool  item_found = false;
-            auto& item_list  = items_map_iterator->second;
-
-            for (const auto& current_item_ptr : item_list)
+            if (current_item_ptr->matches(shader_module_device_ptr,
+                                          hash,
+                                          reinterpret_cast<const char*>(&shader_module_spirv_blob.at(0) ),
+                                          static_cast<uint32_t>(shader_module_spirv_blob.size() * sizeof(shader_module_spirv_blob.at(0) )),
+                                          shader_module_cs_entrypoint_name,
+                                          shader_module_fs_entrypoint_name,
+                                          shader_module_gs_entrypoint_name,
+                                          shader_module_tc_entrypoint_name,
+                                          shader_module_te_entrypoint_name,
+                                          shader_module_vs_entrypoint_name) )
             {
-                if (current_item_ptr->matches(shader_module_device_ptr,
-                                              reinterpret_cast<const char*>(&shader_module_spirv_blob.at(0) ),
-                                              static_cast<uint32_t>(shader_module_spirv_blob.size() * sizeof(shader_module_spirv_blob.at(0) )),
-                                              shader_module_cs_entrypoint_name,
-                                              shader_module_fs_entrypoint_name,
-                                              shader_module_gs_entrypoint_name,
-                                              shader_module_tc_entrypoint_name,
-                                              shader_module_te_entrypoint_name,
-                                              shader_module_vs_entrypoint_name) )
-                {
-                    /* This assertion check should never explode */
-                    anvil_assert(current_item_ptr->shader_module_owned_ptr.get() == in_shader_module_ptr);
+                anvil_assert(current_item_ptr->shader_module_owned_ptr.get() == in_shader_module_ptr);
 
-                    item_found = true;
-                    break;
-                }
+                should_store_new_item = false;
+                break;
             }
-
-            should_store_new_item = !item_found;
         }
 
         if (should_store_new_item)
         {
             std::unique_ptr<HashMapItem> new_item_ptr(
                 new HashMapItem(shader_module_device_ptr,
-                                shader_module_spirv_blob,
-                                shader_module_cs_entrypoint_name,
-                                shader_module_fs_entrypoint_name,
-                                shader_module_gs_entrypoint_name,
-                                shader_module_tc_entrypoint_name,
-                                shader_module_te_entrypoint_name,
-                                shader_module_vs_entrypoint_name,
+                                hash,
                                 in_shader_module_ptr)
             );
 
-            m_item_ptrs[hash].push_front(
+            item_list.push_front(
                 std::move(new_item_ptr)
             );
         }
@@ -148,18 +130,19 @@ Anvil::ShaderModuleUniquePtr Anvil::ShaderModuleCache::get_cached_shader_module(
 {
     Anvil::ShaderModuleUniquePtr result_ptr;
 
+    /* Hash outside the lock. hash64() does not allocate, so this is cheap even for large blobs. */
+    const uint64_t hash(get_hash(Anvil::Utils::hash64(in_spirv_blob,
+                                                      in_n_spirv_blob_bytes),
+                                 in_cs_entrypoint_name,
+                                 in_fs_entrypoint_name,
+                                 in_gs_entrypoint_name,
+                                 in_tc_entrypoint_name,
+                                 in_te_entrypoint_name,
+                                 in_vs_entrypoint_name) );
+
     {
-        std::unique_lock<std::recursive_mutex> mutex_lock(*get_mutex() );
-
-        const auto hash              (get_hash(in_spirv_blob,
-                                               in_n_spirv_blob_bytes,
-                                               in_cs_entrypoint_name,
-                                               in_fs_entrypoint_name,
-                                               in_gs_entrypoint_name,
-                                               in_tc_entrypoint_name,
-                                               in_te_entrypoint_name,
-                                               in_vs_entrypoint_name) );
-        auto       items_map_iterator(m_item_ptrs.find(hash) );
+        std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock        (*get_mutex() );
+        auto                                       items_map_iterator(m_item_ptrs.find(hash) );
 
         if (items_map_iterator != m_item_ptrs.end() )
         {
@@ -168,6 +151,7 @@ Anvil::ShaderModuleUniquePtr Anvil::ShaderModuleCache::get_cached_shader_module(
             for (const auto& current_item_ptr : items)
             {
                 if (current_item_ptr->matches(in_device_ptr,
+                                              hash,
                                               in_spirv_blob,
                                               in_n_spirv_blob_bytes,
                                               in_cs_entrypoint_name,
@@ -194,38 +178,34 @@ Anvil::ShaderModuleUniquePtr Anvil::ShaderModuleCache::get_cached_shader_module(
     return result_ptr;
 }
 
-/** TODO */
-size_t Anvil::ShaderModuleCache::get_hash(const char*        in_spirv_blob,
-                                          uint32_t           in_n_spirv_blob_bytes,
-                                          const std::string& in_cs_entrypoint_name,
-                                          const std::string& in_fs_entrypoint_name,
-                                          const std::string& in_gs_entrypoint_name,
-                                          const std::string& in_tc_entrypoint_name,
-                                          const std::string& in_te_entrypoint_name,
-                                          const std::string& in_vs_entrypoint_name) const
+/** Combines the SPIR-V blob hash with entry-point names into the final cache key. */
+uint64_t Anvil::ShaderModuleCache::get_hash(uint64_t           in_spirv_blob_hash,
+                                            const std::string& in_cs_entrypoint_name,
+                                            const std::string& in_fs_entrypoint_name,
+                                            const std::string& in_gs_entrypoint_name,
+                                            const std::string& in_tc_entrypoint_name,
+                                            const std::string& in_te_entrypoint_name,
+                                            const std::string& in_vs_entrypoint_name) const
 {
-    std::hash<std::string> hash_string;
-    std::hash<uint32_t>    hash_uint32;
-    const uint32_t         n_spirv_blob_ops      = in_n_spirv_blob_bytes / sizeof(uint32_t);
-    size_t                 result_hash           = 0;
-    const uint32_t*        spirv_blob_uint32_ptr = reinterpret_cast<const uint32_t*>(in_spirv_blob);
-
-    anvil_assert((in_n_spirv_blob_bytes % sizeof(uint32_t)) == 0);
-
-    for (uint32_t n_spirv_blob_op = 0;
-                  n_spirv_blob_op < n_spirv_blob_ops;
-                ++n_spirv_blob_op)
+    const std::string* entrypoint_name_ptrs[] =
+    {
+        &in_cs_entrypoint_name,
+        &in_fs_entrypoint_name,
+        &in_gs_entrypoint_name,
+        &in_tc_entrypoint_name,
+        &in_te_entrypoint_name,
+        &in_vs_entrypoint_name
+    };
+    uint64_t result_hash = in_spirv_blob_hash;
+
+    /* Chaining the hashes keeps the result dependent on which stage each name has been specified for. */
+    for (const auto& current_entrypoint_name_ptr : entrypoint_name_ptrs)
     {
-        result_hash ^= hash_uint32(spirv_blob_uint32_ptr[n_spirv_blob_op]);
+        result_hash = Anvil::Utils::hash64(current_entrypoint_name_ptr->c_str(),
+                                           current_entrypoint_name_ptr->size(),
+                                           result_hash);
     }
 
-    result_hash ^= hash_string(in_cs_entrypoint_name);
-    result_hash ^= hash_string(in_fs_entrypoint_name);
-    result_hash ^= hash_string(in_gs_entrypoint_name);
-    result_hash ^= hash_string(in_tc_entrypoint_name);
-    result_hash ^= hash_string(in_te_entrypoint_name);
-    result_hash ^= hash_string(in_vs_entrypoint_name);
-
     return result_hash;
 }
 
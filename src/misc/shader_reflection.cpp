@@ -0,0 +1,1132 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/base_pipeline_create_info.h"
+#include "misc/debug.h"
+#include "misc/descriptor_set_create_info.h"
+#include "misc/shader_reflection.h"
+#include "wrappers/shader_module.h"
+#include <algorithm>
+#include <set>
+
+/* SPIR-V definitions. Only the subset used by the reflection pass is included. */
+static const uint32_t g_spirv_magic          = 0x07230203;
+static const uint32_t g_spirv_n_header_words = 5;
+
+static const uint32_t g_spirv_decoration_array_stride   = 6;
+static const uint32_t g_spirv_decoration_binding        = 33;
+static const uint32_t g_spirv_decoration_block          = 2;
+static const uint32_t g_spirv_decoration_buffer_block   = 3;
+static const uint32_t g_spirv_decoration_builtin        = 11;
+static const uint32_t g_spirv_decoration_descriptor_set = 34;
+static const uint32_t g_spirv_decoration_matrix_stride  = 7;
+static const uint32_t g_spirv_decoration_offset         = 35;
+static const uint32_t g_spirv_decoration_spec_id        = 1;
+
+static const uint32_t g_spirv_builtin_workgroup_size = 25;
+
+static const uint32_t g_spirv_dim_buffer       = 5;
+static const uint32_t g_spirv_dim_subpass_data = 6;
+
+static const uint32_t g_spirv_execution_mode_local_size    = 17;
+static const uint32_t g_spirv_execution_mode_local_size_id = 38;
+
+static const uint32_t g_spirv_execution_model_fragment                = 4;
+static const uint32_t g_spirv_execution_model_geometry                = 3;
+static const uint32_t g_spirv_execution_model_gl_compute              = 5;
+static const uint32_t g_spirv_execution_model_mesh_nv                 = 5268;
+static const uint32_t g_spirv_execution_model_task_nv                 = 5267;
+static const uint32_t g_spirv_execution_model_tessellation_control    = 1;
+static const uint32_t g_spirv_execution_model_tessellation_evaluation = 2;
+static const uint32_t g_spirv_execution_model_vertex                  = 0;
+
+static const uint32_t g_spirv_op_constant                = 43;
+static const uint32_t g_spirv_op_constant_composite      = 44;
+static const uint32_t g_spirv_op_decorate                = 71;
+static const uint32_t g_spirv_op_entry_point             = 15;
+static const uint32_t g_spirv_op_execution_mode          = 16;
+static const uint32_t g_spirv_op_function                = 54;
+static const uint32_t g_spirv_op_function_call           = 57;
+static const uint32_t g_spirv_op_function_end            = 56;
+static const uint32_t g_spirv_op_member_decorate         = 72;
+static const uint32_t g_spirv_op_spec_constant           = 50;
+static const uint32_t g_spirv_op_spec_constant_composite = 51;
+static const uint32_t g_spirv_op_spec_constant_false     = 49;
+static const uint32_t g_spirv_op_spec_constant_true      = 48;
+static const uint32_t g_spirv_op_type_array              = 28;
+static const uint32_t g_spirv_op_type_bool               = 20;
+static const uint32_t g_spirv_op_type_float              = 22;
+static const uint32_t g_spirv_op_type_image              = 25;
+static const uint32_t g_spirv_op_type_int                = 21;
+static const uint32_t g_spirv_op_type_matrix             = 24;
+static const uint32_t g_spirv_op_type_pointer            = 32;
+static const uint32_t g_spirv_op_type_runtime_array      = 29;
+static const uint32_t g_spirv_op_type_sampled_image      = 27;
+static const uint32_t g_spirv_op_type_sampler            = 26;
+static const uint32_t g_spirv_op_type_struct             = 30;
+static const uint32_t g_spirv_op_type_vector             = 23;
+static const uint32_t g_spirv_op_type_void               = 19;
+static const uint32_t g_spirv_op_variable                = 59;
+
+static const uint32_t g_spirv_storage_class_push_constant    = 9;
+static const uint32_t g_spirv_storage_class_storage_buffer   = 12;
+static const uint32_t g_spirv_storage_class_uniform          = 2;
+static const uint32_t g_spirv_storage_class_uniform_constant = 0;
+
+/* Holds the parts of a SPIR-V module the reflection pass needs. Type operands do not include the result ID. */
+typedef struct SPIRVModule
+{
+    std::map<uint32_t, uint32_t>                       array_strides;
+    std::map<uint32_t, uint32_t>                       binding_indices;
+    std::set<uint32_t>                                 block_structs;
+    std::set<uint32_t>                                 buffer_block_structs;
+    std::map<uint32_t, std::vector<uint32_t> >         composite_constituents;
+    std::map<uint32_t, uint32_t>                       constant_values;
+    std::map<uint32_t, uint32_t>                       descriptor_set_indices;
+    uint32_t                                           entrypoint_function_id;
+    std::map<uint32_t, std::set<uint32_t> >            function_calls;
+    std::map<uint32_t, std::set<uint32_t> >            function_variable_refs;
+    std::array<uint32_t, 3>                            local_size;
+    std::array<uint32_t, 3>                            local_size_ids;
+    std::map<std::pair<uint32_t, uint32_t>, uint32_t>  member_matrix_strides;
+    std::map<std::pair<uint32_t, uint32_t>, uint32_t>  member_offsets;
+    std::map<uint32_t, uint32_t>                       spec_constant_type_ids;
+    std::map<uint32_t, uint32_t>                       spec_constant_values;
+    std::map<uint32_t, uint32_t>                       spec_ids;
+    std::map<uint32_t, std::vector<uint32_t> >         type_operands;
+    std::map<uint32_t, uint32_t>                       type_opcodes;
+    std::map<uint32_t, std::pair<uint32_t, uint32_t> > variables; /* pointer type ID, storage class */
+    uint32_t                                           workgroup_size_id;
+
+    SPIRVModule()
+        :entrypoint_function_id(UINT32_MAX),
+         workgroup_size_id     (UINT32_MAX)
+    {
+        local_size.fill    (1);
+        local_size_ids.fill(UINT32_MAX);
+    }
+} SPIRVModule;
+
+/** Maps a SPIR-V execution model to an Anvil shader stage. Returns ShaderStage::UNKNOWN for unsupported models. */
+static Anvil::ShaderStage get_shader_stage_for_execution_model(uint32_t in_execution_model)
+{
+    switch (in_execution_model)
+    {
+        case g_spirv_execution_model_fragment:                return Anvil::ShaderStage::FRAGMENT;
+        case g_spirv_execution_model_geometry:                return Anvil::ShaderStage::GEOMETRY;
+        case g_spirv_execution_model_gl_compute:              return Anvil::ShaderStage::COMPUTE;
+        case g_spirv_execution_model_mesh_nv:                 return Anvil::ShaderStage::MESH;
+        case g_spirv_execution_model_task_nv:                 return Anvil::ShaderStage::TASK;
+        case g_spirv_execution_model_tessellation_control:    return Anvil::ShaderStage::TESSELLATION_CONTROL;
+        case g_spirv_execution_model_tessellation_evaluation: return Anvil::ShaderStage::TESSELLATION_EVALUATION;
+        case g_spirv_execution_model_vertex:                  return Anvil::ShaderStage::VERTEX;
+
+        default:
+        {
+            return Anvil::ShaderStage::UNKNOWN;
+        }
+    }
+}
+
+/** Returns the number of bytes taken by a value of the specified type, as laid out in an explicitly laid out
+ *  block. Returns 0 for types which cannot be stored in such blocks.
+ *
+ *  @param in_module        Module the type belongs to.
+ *  @param in_type_id       ID of the type.
+ *  @param in_matrix_stride Matrix stride to use if the type is a matrix, or 0 if none was specified.
+ */
+static uint32_t get_type_size(const SPIRVModule& in_module,
+                              uint32_t           in_type_id,
+                              uint32_t           in_matrix_stride)
+{
+    const auto opcode_iterator = in_module.type_opcodes.find(in_type_id);
+    uint32_t   result          = 0;
+
+    if (opcode_iterator == in_module.type_opcodes.end() )
+    {
+        goto end;
+    }
+
+    {
+        const auto& operands = in_module.type_operands.at(in_type_id);
+
+        switch (opcode_iterator->second)
+        {
+            case g_spirv_op_type_bool:
+            {
+                result = sizeof(VkBool32);
+
+                break;
+            }
+
+            case g_spirv_op_type_float:
+            case g_spirv_op_type_int:
+            {
+                result = operands.at(0) / 8;
+
+                break;
+            }
+
+            case g_spirv_op_type_vector:
+            {
+                result = operands.at(1) * get_type_size(in_module,
+                                                        operands.at(0),
+                                                        0); /* in_matrix_stride */
+
+                break;
+            }
+
+            case g_spirv_op_type_matrix:
+            {
+                result = operands.at(1) * ((in_matrix_stride != 0) ? in_matrix_stride
+                                                                    : get_type_size(in_module,
+                                                                                    operands.at(0),
+                                                                                    0) ); /* in_matrix_stride */
+
+                break;
+            }
+
+            case g_spirv_op_type_array:
+            {
+                const auto array_stride_iterator = in_module.array_strides.find  (in_type_id);
+                const auto length_iterator       = in_module.constant_values.find(operands.at(1) );
+
+                if (length_iterator != in_module.constant_values.end() )
+                {
+                    result = length_iterator->second * ((array_stride_iterator != in_module.array_strides.end() ) ? array_stride_iterator->second
+                                                                                                                   : get_type_size(in_module,
+                                                                                                                                   operands.at(0),
+                                                                                                                                   in_matrix_stride) );
+                }
+
+                break;
+            }
+
+            case g_spirv_op_type_struct:
+            {
+                for (uint32_t n_member = 0;
+                              n_member < static_cast<uint32_t>(operands.size() );
+                            ++n_member)
+                {
+                    const auto member_key             = std::make_pair(in_type_id, n_member);
+                    const auto matrix_stride_iterator = in_module.member_matrix_strides.find(member_key);
+                    const auto offset_iterator        = in_module.member_offsets.find       (member_key);
+                    const auto member_size            = get_type_size(in_module,
+                                                                      operands.at(n_member),
+                                                                      (matrix_stride_iterator != in_module.member_matrix_strides.end() ) ? matrix_stride_iterator->second
+                                                                                                                                         : 0);
+
+                    result = std::max(result,
+                                      ((offset_iterator != in_module.member_offsets.end() ) ? offset_iterator->second : 0) + member_size);
+                }
+
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
+        }
+    }
+
+end:
+    return result;
+}
+
+/** Reads a null-terminated literal string, which starts at the specified word.
+ *
+ *  @param in_words_ptr Words holding the string.
+ *  @param in_n_words   Number of words available under @param in_words_ptr.
+ */
+static std::string get_literal_string(const uint32_t* in_words_ptr,
+                                      uint32_t        in_n_words)
+{
+    const char* chars_ptr = reinterpret_cast<const char*>(in_words_ptr);
+    std::string result;
+
+    for (uint32_t n_char = 0;
+                  n_char < in_n_words * sizeof(uint32_t) && chars_ptr[n_char] != '\0';
+                ++n_char)
+    {
+        result.push_back(chars_ptr[n_char]);
+    }
+
+    return result;
+}
+
+/** Walks the SPIR-V word stream and gathers the information the reflection pass needs.
+ *
+ *  @param in_spirv_blob      SPIR-V blob to parse.
+ *  @param in_n_words         Number of words held by @param in_spirv_blob.
+ *  @param in_shader_stage    Shader stage of the entry-point to look for.
+ *  @param in_entrypoint_name Name of the entry-point to look for.
+ *  @param out_module_ptr     Deref will be filled with the parsed information. Must not be null.
+ *
+ *  @return true if successful, false if the blob is malformed or the entry-point could not be found.
+ */
+static bool parse_spirv_blob(const uint32_t*    in_spirv_blob,
+                             uint32_t           in_n_words,
+                             Anvil::ShaderStage in_shader_stage,
+                             const std::string& in_entrypoint_name,
+                             SPIRVModule*       out_module_ptr)
+{
+    uint32_t current_function_id = UINT32_MAX;
+    uint32_t n_word              = g_spirv_n_header_words;
+    bool     result              = false;
+
+    if (in_spirv_blob    == nullptr                ||
+        in_n_words       <  g_spirv_n_header_words ||
+        in_spirv_blob[0] != g_spirv_magic)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    while (n_word < in_n_words)
+    {
+        const uint32_t* instruction_ptr = in_spirv_blob + n_word;
+        const uint32_t  n_inst_words    = instruction_ptr[0] >> 16;
+        const uint32_t  opcode          = instruction_ptr[0] & 0xFFFF;
+
+        if (n_inst_words         == 0 ||
+            n_word + n_inst_words >  in_n_words)
+        {
+            /* Malformed blob */
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        if (current_function_id != UINT32_MAX)
+        {
+            /* Record all global variables and functions the function refers to */
+            if (opcode == g_spirv_op_function_end)
+            {
+                current_function_id = UINT32_MAX;
+            }
+            else
+            if (opcode         == g_spirv_op_function_call &&
+                n_inst_words   >= 4)
+            {
+                out_module_ptr->function_calls[current_function_id].insert(instruction_ptr[3]);
+            }
+
+            for (uint32_t n_operand_word = 1;
+                          n_operand_word < n_inst_words && current_function_id != UINT32_MAX;
+                        ++n_operand_word)
+            {
+                if (out_module_ptr->variables.find(instruction_ptr[n_operand_word]) != out_module_ptr->variables.end() )
+                {
+                    out_module_ptr->function_variable_refs[current_function_id].insert(instruction_ptr[n_operand_word]);
+                }
+            }
+        }
+        else
+        switch (opcode)
+        {
+            case g_spirv_op_entry_point:
+            {
+                if (n_inst_words                                              >= 4               &&
+                    get_shader_stage_for_execution_model(instruction_ptr[1])  == in_shader_stage &&
+                    get_literal_string(instruction_ptr + 3, n_inst_words - 3) == in_entrypoint_name)
+                {
+                    out_module_ptr->entrypoint_function_id = instruction_ptr[2];
+                }
+
+                break;
+            }
+
+            case g_spirv_op_execution_mode:
+            {
+                if (n_inst_words       >= 6                                      &&
+                    instruction_ptr[1] == out_module_ptr->entrypoint_function_id)
+                {
+                    if (instruction_ptr[2] == g_spirv_execution_mode_local_size)
+                    {
+                        out_module_ptr->local_size[0] = instruction_ptr[3];
+                        out_module_ptr->local_size[1] = instruction_ptr[4];
+                        out_module_ptr->local_size[2] = instruction_ptr[5];
+                    }
+                    else
+                    if (instruction_ptr[2] == g_spirv_execution_mode_local_size_id)
+                    {
+                        out_module_ptr->local_size_ids[0] = instruction_ptr[3];
+                        out_module_ptr->local_size_ids[1] = instruction_ptr[4];
+                        out_module_ptr->local_size_ids[2] = instruction_ptr[5];
+                    }
+                }
+
+                break;
+            }
+
+            case g_spirv_op_decorate:
+            {
+                if (n_inst_words < 3)
+                {
+                    break;
+                }
+
+                const uint32_t target_id  = instruction_ptr[1];
+                const uint32_t decoration = instruction_ptr[2];
+
+                if (decoration == g_spirv_decoration_block)
+                {
+                    out_module_ptr->block_structs.insert(target_id);
+                }
+                else
+                if (decoration == g_spirv_decoration_buffer_block)
+                {
+                    out_module_ptr->buffer_block_structs.insert(target_id);
+                }
+                else
+                if (n_inst_words >= 4)
+                {
+                    switch (decoration)
+                    {
+                        case g_spirv_decoration_array_stride:   out_module_ptr->array_strides         [target_id] = instruction_ptr[3]; break;
+                        case g_spirv_decoration_binding:        out_module_ptr->binding_indices       [target_id] = instruction_ptr[3]; break;
+
+                        case g_spirv_decoration_builtin:
+                        {
+                            if (instruction_ptr[3] == g_spirv_builtin_workgroup_size)
+                            {
+                                out_module_ptr->workgroup_size_id = target_id;
+                            }
+
+                            break;
+                        }
+
+                        case g_spirv_decoration_descriptor_set: out_module_ptr->descriptor_set_indices[target_id] = instruction_ptr[3]; break;
+                        case g_spirv_decoration_spec_id:        out_module_ptr->spec_ids              [target_id] = instruction_ptr[3]; break;
+
+                        default:
+                        {
+                            break;
+                        }
+                    }
+                }
+
+                break;
+            }
+
+            case g_spirv_op_member_decorate:
+            {
+                if (n_inst_words >= 5)
+                {
+                    const auto member_key = std::make_pair(instruction_ptr[1],
+                                                           instruction_ptr[2]);
+
+                    if (instruction_ptr[3] == g_spirv_decoration_matrix_stride)
+                    {
+                        out_module_ptr->member_matrix_strides[member_key] = instruction_ptr[4];
+                    }
+                    else
+                    if (instruction_ptr[3] == g_spirv_decoration_offset)
+                    {
+                        out_module_ptr->member_offsets[member_key] = instruction_ptr[4];
+                    }
+                }
+
+                break;
+            }
+
+            case g_spirv_op_type_array:
+            case g_spirv_op_type_bool:
+            case g_spirv_op_type_float:
+            case g_spirv_op_type_image:
+            case g_spirv_op_type_int:
+            case g_spirv_op_type_matrix:
+            case g_spirv_op_type_pointer:
+            case g_spirv_op_type_runtime_array:
+            case g_spirv_op_type_sampled_image:
+            case g_spirv_op_type_sampler:
+            case g_spirv_op_type_struct:
+            case g_spirv_op_type_vector:
+            case g_spirv_op_type_void:
+            {
+                if (n_inst_words >= 2)
+                {
+                    out_module_ptr->type_opcodes [instruction_ptr[1]] = opcode;
+                    out_module_ptr->type_operands[instruction_ptr[1]] = std::vector<uint32_t>(instruction_ptr + 2,
+                                                                                              instruction_ptr + n_inst_words);
+                }
+
+                break;
+            }
+
+            case g_spirv_op_constant:
+            {
+                if (n_inst_words >= 4)
+                {
+                    out_module_ptr->constant_values[instruction_ptr[2]] = instruction_ptr[3];
+                }
+
+                break;
+            }
+
+            case g_spirv_op_constant_composite:
+            case g_spirv_op_spec_constant_composite:
+            {
+                if (n_inst_words >= 3)
+                {
+                    out_module_ptr->composite_constituents[instruction_ptr[2]] = std::vector<uint32_t>(instruction_ptr + 3,
+                                                                                                       instruction_ptr + n_inst_words);
+                }
+
+                break;
+            }
+
+            case g_spirv_op_spec_constant:
+            case g_spirv_op_spec_constant_false:
+            case g_spirv_op_spec_constant_true:
+            {
+                if (n_inst_words >= 3)
+                {
+                    out_module_ptr->spec_constant_type_ids[instruction_ptr[2]] = instruction_ptr[1];
+                    out_module_ptr->spec_constant_values  [instruction_ptr[2]] = (opcode == g_spirv_op_spec_constant && n_inst_words >= 4) ? instruction_ptr[3]
+                                                                               : (opcode == g_spirv_op_spec_constant_true)                ? 1
+                                                                                                                                          : 0;
+                }
+
+                break;
+            }
+
+            case g_spirv_op_variable:
+            {
+                if (n_inst_words >= 4)
+                {
+                    out_module_ptr->variables[instruction_ptr[2]] = std::make_pair(instruction_ptr[1],
+                                                                                   instruction_ptr[3]);
+                }
+
+                break;
+            }
+
+            case g_spirv_op_function:
+            {
+                if (n_inst_words >= 3)
+                {
+                    current_function_id = instruction_ptr[2];
+                }
+
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
+        }
+
+        n_word += n_inst_words;
+    }
+
+    if (out_module_ptr->entrypoint_function_id == UINT32_MAX)
+    {
+        /* Entry-point not found */
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Resolves the value of a constant which drives a local workgroup size component.
+ *
+ *  @param in_module       Module the constant belongs to.
+ *  @param in_constant_id  ID of the constant.
+ *  @param out_value_ptr   Deref will be set to the constant's value. For specialization constants, the default
+ *                         value is used. Left untouched if the constant could not be found. Must not be null.
+ *  @param out_spec_id_ptr Deref will be set to the specialization constant ID, or to UINT32_MAX if the constant
+ *                         is not specialized. Must not be null.
+ */
+static void resolve_workgroup_size_component(const SPIRVModule& in_module,
+                                             uint32_t           in_constant_id,
+                                             uint32_t*          out_value_ptr,
+                                             uint32_t*          out_spec_id_ptr)
+{
+    const auto constant_iterator      = in_module.constant_values.find     (in_constant_id);
+    const auto spec_constant_iterator = in_module.spec_constant_values.find(in_constant_id);
+    const auto spec_id_iterator       = in_module.spec_ids.find            (in_constant_id);
+
+    *out_spec_id_ptr = UINT32_MAX;
+
+    if (constant_iterator != in_module.constant_values.end() )
+    {
+        *out_value_ptr = constant_iterator->second;
+    }
+    else
+    if (spec_constant_iterator != in_module.spec_constant_values.end() )
+    {
+        *out_value_ptr = spec_constant_iterator->second;
+
+        if (spec_id_iterator != in_module.spec_ids.end() )
+        {
+            *out_spec_id_ptr = spec_id_iterator->second;
+        }
+    }
+}
+
+
+/** Please see header for specification */
+Anvil::ShaderReflection::ShaderReflection()
+{
+    m_local_workgroup_size.fill         (1);
+    m_local_workgroup_size_spec_ids.fill(UINT32_MAX);
+}
+
+/** Please see header for specification */
+Anvil::ShaderReflection::~ShaderReflection()
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+bool Anvil::ShaderReflection::add_shader_stage(const Anvil::ShaderModuleStageEntryPoint& in_entrypoint)
+{
+    bool result = false;
+
+    if (in_entrypoint.shader_module_ptr == nullptr)
+    {
+        anvil_assert(in_entrypoint.shader_module_ptr != nullptr);
+
+        goto end;
+    }
+
+    {
+        const auto& spirv_blob = in_entrypoint.shader_module_ptr->get_spirv_blob();
+
+        result = add_spirv_blob(&spirv_blob.at(0),
+                                static_cast<uint32_t>(spirv_blob.size() ),
+                                in_entrypoint.stage,
+                                in_entrypoint.name);
+    }
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::ShaderReflection::add_spirv_blob(const uint32_t*    in_spirv_blob,
+                                             uint32_t           in_n_spirv_blob_uint32s,
+                                             Anvil::ShaderStage in_shader_stage,
+                                             const std::string& in_entrypoint_name)
+{
+    std::vector<uint32_t>         functions_to_visit;
+    SPIRVModule                   module;
+    Bindings                      new_bindings = m_bindings;
+    bool                          result       = false;
+    const Anvil::ShaderStageFlags stage_flags  = Anvil::Utils::get_shader_stage_flag_bits_from_shader_stage(in_shader_stage);
+    std::set<uint32_t>            used_variable_ids;
+    std::set<uint32_t>            visited_function_ids;
+
+    if (!parse_spirv_blob(in_spirv_blob,
+                          in_n_spirv_blob_uint32s,
+                          in_shader_stage,
+                          in_entrypoint_name,
+                         &module) )
+    {
+        goto end;
+    }
+
+    /* Gather global variables statically referenced by the entry-point's call tree */
+    functions_to_visit.push_back(module.entrypoint_function_id);
+
+    while (functions_to_visit.size() > 0)
+    {
+        const uint32_t current_function_id = functions_to_visit.back();
+
+        functions_to_visit.pop_back();
+
+        if (!visited_function_ids.insert(current_function_id).second)
+        {
+            continue;
+        }
+
+        {
+            auto refs_iterator = module.function_variable_refs.find(current_function_id);
+
+            if (refs_iterator != module.function_variable_refs.end() )
+            {
+                used_variable_ids.insert(refs_iterator->second.begin(),
+                                         refs_iterator->second.end  () );
+            }
+        }
+
+        {
+            auto calls_iterator = module.function_calls.find(current_function_id);
+
+            if (calls_iterator != module.function_calls.end() )
+            {
+                functions_to_visit.insert(functions_to_visit.end(),
+                                          calls_iterator->second.begin(),
+                                          calls_iterator->second.end  () );
+            }
+        }
+    }
+
+    /* Classify the variables */
+    for (const auto& current_variable_id : used_variable_ids)
+    {
+        const auto&    variable      = module.variables.at(current_variable_id);
+        const uint32_t storage_class = variable.second;
+        uint32_t       type_id       = UINT32_MAX;
+        Binding        new_binding;
+
+        {
+            const auto pointer_opcode_iterator = module.type_opcodes.find(variable.first);
+
+            if (pointer_opcode_iterator == module.type_opcodes.end() ||
+                pointer_opcode_iterator->second != g_spirv_op_type_pointer)
+            {
+                continue;
+            }
+
+            type_id = module.type_operands.at(variable.first).at(1);
+        }
+
+        if (storage_class == g_spirv_storage_class_push_constant)
+        {
+            const auto& members    = module.type_operands[type_id];
+            uint32_t    min_offset = UINT32_MAX;
+            const auto  block_size = get_type_size(module,
+                                                   type_id,
+                                                   0); /* in_matrix_stride */
+
+            for (uint32_t n_member = 0;
+                          n_member < static_cast<uint32_t>(members.size() );
+                        ++n_member)
+            {
+                const auto offset_iterator = module.member_offsets.find(std::make_pair(type_id, n_member) );
+
+                min_offset = std::min(min_offset,
+                                      (offset_iterator != module.member_offsets.end() ) ? offset_iterator->second : 0);
+            }
+
+            if (block_size > 0          &&
+                min_offset < block_size)
+            {
+                m_push_constant_ranges.erase  (in_shader_stage);
+                m_push_constant_ranges.emplace(in_shader_stage,
+                                               Anvil::PushConstantRange(min_offset,
+                                                                        block_size - min_offset,
+                                                                        stage_flags) );
+            }
+
+            continue;
+        }
+
+        if (storage_class != g_spirv_storage_class_storage_buffer   &&
+            storage_class != g_spirv_storage_class_uniform          &&
+            storage_class != g_spirv_storage_class_uniform_constant)
+        {
+            continue;
+        }
+
+        if (module.binding_indices.find       (current_variable_id) == module.binding_indices.end       () ||
+            module.descriptor_set_indices.find(current_variable_id) == module.descriptor_set_indices.end() )
+        {
+            continue;
+        }
+
+        /* Strip arrays */
+        new_binding.n_descriptors = 1;
+        new_binding.stages        = stage_flags;
+
+        while (module.type_opcodes.find(type_id) != module.type_opcodes.end() )
+        {
+            const auto type_opcode = module.type_opcodes.at(type_id);
+
+            if (type_opcode == g_spirv_op_type_array)
+            {
+                const auto length_iterator = module.constant_values.find(module.type_operands.at(type_id).at(1) );
+
+                new_binding.n_descriptors *= (length_iterator != module.constant_values.end() ) ? length_iterator->second : 1;
+            }
+            else
+            if (type_opcode == g_spirv_op_type_runtime_array)
+            {
+                new_binding.n_descriptors = 0;
+            }
+            else
+            {
+                break;
+            }
+
+            type_id = module.type_operands.at(type_id).at(0);
+        }
+
+        if (module.type_opcodes.find(type_id) == module.type_opcodes.end() )
+        {
+            continue;
+        }
+
+        switch (module.type_opcodes.at(type_id) )
+        {
+            case g_spirv_op_type_image:
+            {
+                const auto& image_operands = module.type_operands.at(type_id);
+                const auto  dim            = image_operands.at(1);
+                const auto  sampled        = image_operands.at(5);
+
+                new_binding.descriptor_type = (dim == g_spirv_dim_subpass_data) ? Anvil::DescriptorType::INPUT_ATTACHMENT
+                                            : (dim == g_spirv_dim_buffer)       ? ((sampled == 2) ? Anvil::DescriptorType::STORAGE_TEXEL_BUFFER
+                                                                                                  : Anvil::DescriptorType::UNIFORM_TEXEL_BUFFER)
+                                            : (sampled == 2)                    ? Anvil::DescriptorType::STORAGE_IMAGE
+                                                                                : Anvil::DescriptorType::SAMPLED_IMAGE;
+
+                break;
+            }
+
+            case g_spirv_op_type_sampled_image:
+            {
+                const auto image_type_id = module.type_operands.at(type_id).at(0);
+
+                new_binding.descriptor_type = (module.type_operands.find(image_type_id)     != module.type_operands.end() &&
+                                               module.type_operands.at  (image_type_id).at(1) == g_spirv_dim_buffer)        ? Anvil::DescriptorType::UNIFORM_TEXEL_BUFFER
+                                                                                                                          : Anvil::DescriptorType::COMBINED_IMAGE_SAMPLER;
+
+                break;
+            }
+
+            case g_spirv_op_type_sampler:
+            {
+                new_binding.descriptor_type = Anvil::DescriptorType::SAMPLER;
+
+                break;
+            }
+
+            case g_spirv_op_type_struct:
+            {
+                if (storage_class == g_spirv_storage_class_storage_buffer                  ||
+                    module.buffer_block_structs.find(type_id) != module.buffer_block_structs.end() )
+                {
+                    new_binding.descriptor_type = Anvil::DescriptorType::STORAGE_BUFFER;
+                }
+                else
+                if (module.block_structs.find(type_id) != module.block_structs.end() )
+                {
+                    new_binding.descriptor_type = Anvil::DescriptorType::UNIFORM_BUFFER;
+                }
+
+                break;
+            }
+
+            default:
+            {
+                /* Unsupported resource type */
+                break;
+            }
+        }
+
+        if (new_binding.descriptor_type == Anvil::DescriptorType::UNKNOWN)
+        {
+            continue;
+        }
+
+        /* Merge with bindings reported by other stages */
+        {
+            const auto location         = BindingLocation(module.descriptor_set_indices.at(current_variable_id),
+                                                          module.binding_indices.at       (current_variable_id) );
+            auto       binding_iterator = new_bindings.find(location);
+
+            if (binding_iterator == new_bindings.end() )
+            {
+                new_bindings[location] = new_binding;
+            }
+            else
+            if (binding_iterator->second.n_descriptors   != new_binding.n_descriptors                                      ||
+                (binding_iterator->second.descriptor_type != new_binding.descriptor_type                                 &&
+                 !(binding_iterator->second.descriptor_type == Anvil::DescriptorType::STORAGE_BUFFER_DYNAMIC && new_binding.descriptor_type == Anvil::DescriptorType::STORAGE_BUFFER) &&
+                 !(binding_iterator->second.descriptor_type == Anvil::DescriptorType::UNIFORM_BUFFER_DYNAMIC && new_binding.descriptor_type == Anvil::DescriptorType::UNIFORM_BUFFER) ) )
+            {
+                /* Two stages declare the same binding differently */
+                anvil_assert_fail();
+
+                goto end;
+            }
+            else
+            {
+                binding_iterator->second.stages = binding_iterator->second.stages | stage_flags;
+            }
+        }
+    }
+
+    /* Specialization constants are declared at module scope */
+    for (const auto& current_spec_constant : module.spec_constant_type_ids)
+    {
+        const auto spec_id_iterator = module.spec_ids.find(current_spec_constant.first);
+
+        if (spec_id_iterator == module.spec_ids.end() )
+        {
+            continue;
+        }
+
+        auto& constant_info = m_specialization_constants[spec_id_iterator->second];
+
+        constant_info.constant_id = spec_id_iterator->second;
+        constant_info.n_bytes     = get_type_size(module,
+                                                  current_spec_constant.second,
+                                                  0); /* in_matrix_stride */
+        constant_info.stages      = constant_info.stages | stage_flags;
+    }
+
+    /* A WorkgroupSize built-in takes precedence over the LocalSize and LocalSizeId execution modes */
+    if (in_shader_stage == Anvil::ShaderStage::COMPUTE)
+    {
+        const auto composite_iterator = module.composite_constituents.find(module.workgroup_size_id);
+
+        m_local_workgroup_size = module.local_size;
+        m_local_workgroup_size_spec_ids.fill(UINT32_MAX);
+
+        for (uint32_t n_component = 0;
+                      n_component < 3;
+                    ++n_component)
+        {
+            if (composite_iterator                 != module.composite_constituents.end() &&
+                composite_iterator->second.size() >  n_component)
+            {
+                resolve_workgroup_size_component(module,
+                                                 composite_iterator->second.at(n_component),
+                                                &m_local_workgroup_size         [n_component],
+                                                &m_local_workgroup_size_spec_ids[n_component]);
+            }
+            else
+            if (module.local_size_ids[n_component] != UINT32_MAX)
+            {
+                resolve_workgroup_size_component(module,
+                                                 module.local_size_ids.at(n_component),
+                                                &m_local_workgroup_size         [n_component],
+                                                &m_local_workgroup_size_spec_ids[n_component]);
+            }
+        }
+    }
+
+    m_bindings = std::move(new_bindings);
+    result     = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::ShaderReflection::configure_pipeline_create_info(Anvil::BasePipelineCreateInfo* inout_pipeline_create_info_ptr,
+                                                             uint32_t                       in_n_max_runtime_array_descriptors) const
+{
+    std::vector<Anvil::DescriptorSetCreateInfoUniquePtr> ds_create_info_items;
+    std::vector<const Anvil::DescriptorSetCreateInfo*>   ds_create_info_raw_ptrs;
+    bool                                                 result = false;
+
+    anvil_assert(inout_pipeline_create_info_ptr != nullptr);
+
+    if (inout_pipeline_create_info_ptr->get_ds_create_info_items()->size() != 0 ||
+        inout_pipeline_create_info_ptr->get_push_constant_ranges().size()  != 0)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (!get_descriptor_set_create_infos(&ds_create_info_items,
+                                         in_n_max_runtime_array_descriptors) )
+    {
+        goto end;
+    }
+
+    for (const auto& current_ds_create_info_ptr : ds_create_info_items)
+    {
+        ds_create_info_raw_ptrs.push_back(current_ds_create_info_ptr.get() );
+    }
+
+    inout_pipeline_create_info_ptr->set_descriptor_set_create_info(&ds_create_info_raw_ptrs);
+
+    for (const auto& current_range : get_push_constant_ranges() )
+    {
+        if (!inout_pipeline_create_info_ptr->attach_push_constant_range(current_range.offset,
+                                                                        current_range.size,
+                                                                        current_range.stages) )
+        {
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::ShaderReflectionUniquePtr Anvil::ShaderReflection::create()
+{
+    Anvil::ShaderReflectionUniquePtr result_ptr(nullptr,
+                                                std::default_delete<Anvil::ShaderReflection>() );
+
+    result_ptr.reset(
+        new Anvil::ShaderReflection()
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+Anvil::ShaderReflectionUniquePtr Anvil::ShaderReflection::create_for_pipeline(const Anvil::BasePipelineCreateInfo* in_pipeline_create_info_ptr)
+{
+    Anvil::ShaderReflectionUniquePtr result_ptr = create();
+
+    anvil_assert(in_pipeline_create_info_ptr != nullptr);
+
+    for (uint32_t n_shader_stage = static_cast<uint32_t>(Anvil::ShaderStage::FIRST);
+                  n_shader_stage < static_cast<uint32_t>(Anvil::ShaderStage::COUNT);
+                ++n_shader_stage)
+    {
+        const Anvil::ShaderModuleStageEntryPoint* entrypoint_ptr = nullptr;
+
+        if (!in_pipeline_create_info_ptr->get_shader_stage_properties(static_cast<Anvil::ShaderStage>(n_shader_stage),
+                                                                     &entrypoint_ptr) ||
+            entrypoint_ptr                    == nullptr                             ||
+            entrypoint_ptr->shader_module_ptr == nullptr)
+        {
+            continue;
+        }
+
+        if (!result_ptr->add_shader_stage(*entrypoint_ptr) )
+        {
+            result_ptr.reset();
+
+            break;
+        }
+    }
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+bool Anvil::ShaderReflection::get_descriptor_set_create_infos(std::vector<Anvil::DescriptorSetCreateInfoUniquePtr>* out_ds_create_info_items_ptr,
+                                                              uint32_t                                              in_n_max_runtime_array_descriptors) const
+{
+    bool result = false;
+
+    out_ds_create_info_items_ptr->clear();
+
+    for (const auto& current_binding : m_bindings)
+    {
+        const uint32_t set_index = current_binding.first.first;
+
+        while (out_ds_create_info_items_ptr->size() <= set_index)
+        {
+            out_ds_create_info_items_ptr->push_back(
+                Anvil::DescriptorSetCreateInfoUniquePtr()
+            );
+        }
+
+        if (out_ds_create_info_items_ptr->at(set_index) == nullptr)
+        {
+            out_ds_create_info_items_ptr->at(set_index) = Anvil::DescriptorSetCreateInfo::create();
+        }
+
+        if (!out_ds_create_info_items_ptr->at(set_index)->add_binding(current_binding.first.second,
+                                                                      current_binding.second.descriptor_type,
+                                                                      (current_binding.second.n_descriptors != 0) ? current_binding.second.n_descriptors
+                                                                                                                  : in_n_max_runtime_array_descriptors,
+                                                                      current_binding.second.stages,
+                                                                      (current_binding.second.n_descriptors != 0) ? Anvil::DescriptorBindingFlagBits::NONE
+                                                                                                                  : Anvil::DescriptorBindingFlagBits::VARIABLE_DESCRIPTOR_COUNT_BIT) )
+        {
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::PushConstantRanges Anvil::ShaderReflection::get_push_constant_ranges() const
+{
+    Anvil::PushConstantRanges result;
+
+    for (const auto& current_stage_range : m_push_constant_ranges)
+    {
+        auto result_iterator = std::find_if(result.begin(),
+                                            result.end  (),
+                                            [&](const Anvil::PushConstantRange& in_range)
+                                            {
+                                                return (in_range.offset == current_stage_range.second.offset &&
+                                                        in_range.size   == current_stage_range.second.size);
+                                            });
+
+        if (result_iterator != result.end() )
+        {
+            result_iterator->stages = result_iterator->stages | current_stage_range.second.stages;
+        }
+        else
+        {
+            result.push_back(current_stage_range.second);
+        }
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::ShaderReflection::set_descriptor_type(uint32_t              in_set_index,
+                                                  uint32_t              in_binding_index,
+                                                  Anvil::DescriptorType in_descriptor_type)
+{
+    auto binding_iterator = m_bindings.find(BindingLocation(in_set_index,
+                                                            in_binding_index) );
+    bool result           = false;
+
+    if (binding_iterator == m_bindings.end() )
+    {
+        anvil_assert(binding_iterator != m_bindings.end() );
+
+        goto end;
+    }
+
+    {
+        const auto current_type = binding_iterator->second.descriptor_type;
+        const bool is_storage   = (current_type == Anvil::DescriptorType::STORAGE_BUFFER         ||
+                                   current_type == Anvil::DescriptorType::STORAGE_BUFFER_DYNAMIC);
+        const bool is_uniform   = (current_type == Anvil::DescriptorType::UNIFORM_BUFFER         ||
+                                   current_type == Anvil::DescriptorType::UNIFORM_BUFFER_DYNAMIC);
+
+        if (!(is_storage && (in_descriptor_type == Anvil::DescriptorType::STORAGE_BUFFER || in_descriptor_type == Anvil::DescriptorType::STORAGE_BUFFER_DYNAMIC) ) &&
+            !(is_uniform && (in_descriptor_type == Anvil::DescriptorType::UNIFORM_BUFFER || in_descriptor_type == Anvil::DescriptorType::UNIFORM_BUFFER_DYNAMIC) ) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        binding_iterator->second.descriptor_type = in_descriptor_type;
+    }
+
+    result = true;
+end:
+    return result;
+}
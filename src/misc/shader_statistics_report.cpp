@@ -0,0 +1,550 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "misc/base_pipeline_create_info.h"
+#include "misc/debug.h"
+#include "misc/shader_statistics_report.h"
+#include "wrappers/compute_pipeline_manager.h"
+#include "wrappers/device.h"
+#include "wrappers/graphics_pipeline_manager.h"
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+#include <sstream>
+
+/* Shader stages which are checked for statistics, in pipeline order. */
+static const Anvil::ShaderStage g_shader_stages[] =
+{
+    Anvil::ShaderStage::TASK,
+    Anvil::ShaderStage::MESH,
+    Anvil::ShaderStage::VERTEX,
+    Anvil::ShaderStage::TESSELLATION_CONTROL,
+    Anvil::ShaderStage::TESSELLATION_EVALUATION,
+    Anvil::ShaderStage::GEOMETRY,
+    Anvil::ShaderStage::FRAGMENT,
+    Anvil::ShaderStage::COMPUTE,
+};
+static const uint32_t g_n_shader_stages = sizeof(g_shader_stages) / sizeof(g_shader_stages[0]);
+
+
+/** Returns a lower-case copy of @param in_string. */
+static std::string get_lower_case_string(const std::string& in_string)
+{
+    std::string result = in_string;
+
+    for (auto& current_char : result)
+    {
+        current_char = static_cast<char>(::tolower(static_cast<unsigned char>(current_char) ) );
+    }
+
+    return result;
+}
+
+/** Returns a short, human-readable list of stages set in @param in_stages, eg. "VS+FS". */
+static std::string get_stages_string(Anvil::ShaderStageFlags in_stages)
+{
+    static const struct
+    {
+        Anvil::ShaderStageFlagBits bit;
+        const char*                name;
+    } stage_names[] =
+    {
+        {Anvil::ShaderStageFlagBits::TASK_BIT_NV,                 "TS"},
+        {Anvil::ShaderStageFlagBits::MESH_BIT_NV,                 "MS"},
+        {Anvil::ShaderStageFlagBits::VERTEX_BIT,                  "VS"},
+        {Anvil::ShaderStageFlagBits::TESSELLATION_CONTROL_BIT,    "TCS"},
+        {Anvil::ShaderStageFlagBits::TESSELLATION_EVALUATION_BIT, "TES"},
+        {Anvil::ShaderStageFlagBits::GEOMETRY_BIT,                "GS"},
+        {Anvil::ShaderStageFlagBits::FRAGMENT_BIT,                "FS"},
+        {Anvil::ShaderStageFlagBits::COMPUTE_BIT,                 "CS"},
+    };
+    std::string result;
+
+    for (const auto& current_stage : stage_names)
+    {
+        if ((in_stages & current_stage.bit) != 0)
+        {
+            if (!result.empty() )
+            {
+                result += "+";
+            }
+
+            result += current_stage.name;
+        }
+    }
+
+    return (result.empty() ) ? "?" : result;
+}
+
+/** Rounds @param in_value up to the nearest multiple of @param in_granularity. */
+static uint32_t round_up(uint32_t in_value,
+                         uint32_t in_granularity)
+{
+    return (in_granularity > 1) ? ((in_value + in_granularity - 1) / in_granularity) * in_granularity
+                                : in_value;
+}
+
+
+/* Default limits match a GCN compute unit. They are only used if VK_AMD_shader_core_properties is unavailable. */
+Anvil::ShaderStatisticsReport::ShaderCoreLimits::ShaderCoreLimits()
+    :lds_per_compute_unit       (65536),
+     min_sgpr_allocation        (16),
+     min_vgpr_allocation        (4),
+     sgpr_allocation_granularity(16),
+     sgprs_per_simd             (800),
+     simd_per_compute_unit      (4),
+     vgpr_allocation_granularity(4),
+     vgprs_per_simd             (256),
+     wavefront_size             (64),
+     wavefronts_per_simd        (10)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::ShaderStatisticsReport::ShaderStatisticsReport(const Anvil::BaseDevice* in_device_ptr)
+    :m_device_ptr                (in_device_ptr),
+     m_has_shader_core_properties(false),
+     m_use_amd_shader_info       (false)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::ShaderStatisticsReport::~ShaderStatisticsReport()
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+bool Anvil::ShaderStatisticsReport::add_device_pipelines()
+{
+    bool result = true;
+
+    result &= add_pipelines(m_device_ptr->get_compute_pipeline_manager () );
+    result &= add_pipelines(m_device_ptr->get_graphics_pipeline_manager() );
+
+    return result;
+}
+
+/** Gathers VK_AMD_shader_info statistics of all stages defined for the specified pipeline.
+ *
+ *  @param in_pipeline_manager_ptr Pipeline manager which owns the pipeline. Must not be null.
+ *  @param in_pipeline_id          ID of the pipeline to gather the statistics of.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::ShaderStatisticsReport::add_pipeline_amd(Anvil::BasePipelineManager* in_pipeline_manager_ptr,
+                                                     Anvil::PipelineID           in_pipeline_id)
+{
+    const Anvil::BasePipelineCreateInfo* create_info_ptr = in_pipeline_manager_ptr->get_pipeline_create_info(in_pipeline_id);
+    bool                                 result          = false;
+
+    if (create_info_ptr == nullptr)
+    {
+        anvil_assert(create_info_ptr != nullptr);
+
+        goto end;
+    }
+
+    for (uint32_t n_shader_stage = 0;
+                  n_shader_stage < g_n_shader_stages;
+                ++n_shader_stage)
+    {
+        Entry                                     new_entry;
+        const Anvil::ShaderStage                  shader_stage                 = g_shader_stages[n_shader_stage];
+        const Anvil::ShaderModuleStageEntryPoint* shader_stage_entry_point_ptr = nullptr;
+        VkShaderStatisticsInfoAMD                 statistics_vk;
+        uint32_t                                  n_threads_per_workgroup      = 0;
+
+        if (!create_info_ptr->get_shader_stage_properties(shader_stage,
+                                                         &shader_stage_entry_point_ptr) ||
+            shader_stage_entry_point_ptr                    == nullptr                  ||
+            shader_stage_entry_point_ptr->shader_module_ptr == nullptr)
+        {
+            continue;
+        }
+
+        if (!in_pipeline_manager_ptr->get_shader_statistics(in_pipeline_id,
+                                                            shader_stage,
+                                                           &statistics_vk) )
+        {
+            goto end;
+        }
+
+        new_entry.lds_usage_bytes     = static_cast<uint32_t>(statistics_vk.resourceUsage.ldsUsageSizeInBytes);
+        new_entry.n_used_sgprs        = statistics_vk.resourceUsage.numUsedSgprs;
+        new_entry.n_used_vgprs        = statistics_vk.resourceUsage.numUsedVgprs;
+        new_entry.pipeline_id         = in_pipeline_id;
+        new_entry.pipeline_name       = create_info_ptr->get_name();
+        new_entry.scratch_usage_bytes = static_cast<uint32_t>(statistics_vk.resourceUsage.scratchMemUsageInBytes);
+        new_entry.stages              = Anvil::Utils::get_shader_stage_flag_bits_from_shader_stage(shader_stage);
+
+        if (shader_stage == Anvil::ShaderStage::COMPUTE)
+        {
+            n_threads_per_workgroup = statistics_vk.computeWorkGroupSize[0] *
+                                      statistics_vk.computeWorkGroupSize[1] *
+                                      statistics_vk.computeWorkGroupSize[2];
+        }
+
+        estimate_occupancy(n_threads_per_workgroup,
+                          &new_entry);
+
+        m_entries.push_back(new_entry);
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Gathers VK_KHR_pipeline_executable_properties statistics of all executables of the specified pipeline.
+ *
+ *  @param in_pipeline_manager_ptr Pipeline manager which owns the pipeline. Must not be null.
+ *  @param in_pipeline_id          ID of the pipeline to gather the statistics of.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::ShaderStatisticsReport::add_pipeline_khr(Anvil::BasePipelineManager* in_pipeline_manager_ptr,
+                                                     Anvil::PipelineID           in_pipeline_id)
+{
+    const Anvil::BasePipelineCreateInfo*                                  create_info_ptr = in_pipeline_manager_ptr->get_pipeline_create_info(in_pipeline_id);
+    std::vector<Anvil::BasePipelineManager::PipelineExecutableProperties> executables;
+    bool                                                                  result          = false;
+
+    if (create_info_ptr == nullptr)
+    {
+        anvil_assert(create_info_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (!in_pipeline_manager_ptr->get_pipeline_executable_properties(in_pipeline_id,
+                                                                    &executables) )
+    {
+        goto end;
+    }
+
+    for (const auto& current_executable : executables)
+    {
+        bool     has_n_waves_per_simd = false;
+        Entry    new_entry;
+        uint32_t n_waves_per_simd     = 0;
+
+        new_entry.executable_statistics = current_executable.statistics;
+        new_entry.pipeline_id           = in_pipeline_id;
+        new_entry.pipeline_name         = create_info_ptr->get_name();
+        new_entry.stages                = current_executable.stages;
+
+        /* Statistic names are driver-specific, so look for the usual suspects. Spill & private memory counters
+         * also mention registers, but they do not contribute to the register file usage. */
+        for (const auto& current_statistic : current_executable.statistics)
+        {
+            const std::string name  = get_lower_case_string(current_statistic.name);
+            const uint32_t    value = static_cast<uint32_t>(current_statistic.get_value_as_double() );
+
+            if (name.find("spill")   != std::string::npos ||
+                name.find("privmem") != std::string::npos)
+            {
+                continue;
+            }
+
+            if (name.find("subgroups per simd")  != std::string::npos ||
+                name.find("waves per simd")      != std::string::npos ||
+                name.find("wavefronts per simd") != std::string::npos)
+            {
+                has_n_waves_per_simd = true;
+                n_waves_per_simd     = value;
+            }
+            else
+            if (name.find("vgpr") != std::string::npos)
+            {
+                new_entry.n_used_vgprs = value;
+            }
+            else
+            if (name.find("sgpr") != std::string::npos)
+            {
+                new_entry.n_used_sgprs = value;
+            }
+            else
+            if (name.find("lds") != std::string::npos)
+            {
+                new_entry.lds_usage_bytes = value;
+            }
+            else
+            if (name.find("scratch") != std::string::npos)
+            {
+                new_entry.scratch_usage_bytes = value;
+            }
+        }
+
+        if (has_n_waves_per_simd)
+        {
+            new_entry.has_occupancy        = true;
+            new_entry.n_max_waves_per_simd = std::max(m_limits.wavefronts_per_simd,
+                                                      n_waves_per_simd);
+            new_entry.n_waves_per_simd     = n_waves_per_simd;
+        }
+        else
+        if (m_has_shader_core_properties)
+        {
+            /* The register-based estimate is only meaningful if we know what the shader core looks like. The
+             * workgroup size is not reported by the extension, so LDS is not accounted for. */
+            estimate_occupancy(0, /* in_n_threads_per_workgroup */
+                              &new_entry);
+        }
+
+        m_entries.push_back(new_entry);
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::ShaderStatisticsReport::add_pipelines(Anvil::BasePipelineManager* in_pipeline_manager_ptr)
+{
+    std::vector<Anvil::PipelineID> pipeline_ids;
+    bool                           result = true;
+
+    anvil_assert(in_pipeline_manager_ptr != nullptr);
+
+    in_pipeline_manager_ptr->get_baked_pipeline_ids(&pipeline_ids);
+
+    for (const auto& current_pipeline_id : pipeline_ids)
+    {
+        if (m_use_amd_shader_info)
+        {
+            result &= add_pipeline_amd(in_pipeline_manager_ptr,
+                                       current_pipeline_id);
+        }
+        else
+        {
+            result &= add_pipeline_khr(in_pipeline_manager_ptr,
+                                       current_pipeline_id);
+        }
+    }
+
+    sort_entries();
+
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::ShaderStatisticsReportUniquePtr Anvil::ShaderStatisticsReport::create(const Anvil::BaseDevice* in_device_ptr)
+{
+    Anvil::ShaderStatisticsReportUniquePtr result_ptr(nullptr,
+                                                      std::default_delete<Anvil::ShaderStatisticsReport>() );
+
+    anvil_assert(in_device_ptr != nullptr);
+
+    result_ptr.reset(
+        new Anvil::ShaderStatisticsReport(in_device_ptr)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init() )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+/** Works out the theoretical number of waves a SIMD can keep in flight, given register & LDS usage of @param inout_entry_ptr.
+ *
+ *  @param in_n_threads_per_workgroup Number of threads in a compute workgroup, or 0 if LDS usage should not be
+ *                                    taken into account.
+ *  @param inout_entry_ptr            Entry to update. Must not be null.
+ **/
+void Anvil::ShaderStatisticsReport::estimate_occupancy(uint32_t in_n_threads_per_workgroup,
+                                                       Entry*   inout_entry_ptr) const
+{
+    uint32_t n_waves_per_simd = m_limits.wavefronts_per_simd;
+
+    if (inout_entry_ptr->n_used_vgprs > 0)
+    {
+        const uint32_t n_allocated_vgprs = round_up(std::max(inout_entry_ptr->n_used_vgprs, m_limits.min_vgpr_allocation),
+                                                    m_limits.vgpr_allocation_granularity);
+
+        n_waves_per_simd = std::min(n_waves_per_simd,
+                                    m_limits.vgprs_per_simd / n_allocated_vgprs);
+    }
+
+    if (inout_entry_ptr->n_used_sgprs > 0)
+    {
+        const uint32_t n_allocated_sgprs = round_up(std::max(inout_entry_ptr->n_used_sgprs, m_limits.min_sgpr_allocation),
+                                                    m_limits.sgpr_allocation_granularity);
+
+        n_waves_per_simd = std::min(n_waves_per_simd,
+                                    m_limits.sgprs_per_simd / n_allocated_sgprs);
+    }
+
+    if (inout_entry_ptr->lds_usage_bytes > 0 &&
+        in_n_threads_per_workgroup       > 0)
+    {
+        const uint32_t n_waves_per_workgroup      = (in_n_threads_per_workgroup + m_limits.wavefront_size - 1) / m_limits.wavefront_size;
+        const uint32_t n_workgroups_per_cu        = m_limits.lds_per_compute_unit / inout_entry_ptr->lds_usage_bytes;
+        const uint32_t n_lds_limited_waves_per_cu = n_workgroups_per_cu * n_waves_per_workgroup;
+
+        /* Waves of a single workgroup get spread across the CU's SIMDs, so the limit is averaged. */
+        n_waves_per_simd = std::min(n_waves_per_simd,
+                                    std::max(1u, n_lds_limited_waves_per_cu / m_limits.simd_per_compute_unit) );
+    }
+
+    inout_entry_ptr->has_occupancy        = true;
+    inout_entry_ptr->n_max_waves_per_simd = m_limits.wavefronts_per_simd;
+    inout_entry_ptr->n_waves_per_simd     = n_waves_per_simd;
+}
+
+/** Picks the statistics source and caches shader core limits of the device.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::ShaderStatisticsReport::init()
+{
+    const Anvil::AMDShaderCoreProperties* core_props_ptr = m_device_ptr->get_physical_device_properties().amd_shader_core_properties_ptr;
+    bool                                  result         = false;
+
+    if (m_device_ptr->get_extension_info()->amd_shader_info() )
+    {
+        m_use_amd_shader_info = true;
+    }
+    else
+    if (!m_device_ptr->get_extension_info()->khr_pipeline_executable_properties() )
+    {
+        anvil_assert(m_device_ptr->get_extension_info()->amd_shader_info                   () ||
+                     m_device_ptr->get_extension_info()->khr_pipeline_executable_properties() );
+
+        goto end;
+    }
+
+    if (core_props_ptr                      != nullptr &&
+        core_props_ptr->wavefronts_per_simd >  0)
+    {
+        m_has_shader_core_properties = true;
+
+        m_limits.min_sgpr_allocation         = core_props_ptr->min_sgpr_allocation;
+        m_limits.min_vgpr_allocation         = core_props_ptr->min_vgpr_allocation;
+        m_limits.sgpr_allocation_granularity = core_props_ptr->sgpr_allocation_granularity;
+        m_limits.sgprs_per_simd              = core_props_ptr->sgprs_per_simd;
+        m_limits.simd_per_compute_unit       = std::max(1u, core_props_ptr->simd_per_compute_unit);
+        m_limits.vgpr_allocation_granularity = core_props_ptr->vgpr_allocation_granularity;
+        m_limits.vgprs_per_simd              = core_props_ptr->vgprs_per_simd;
+        m_limits.wavefront_size              = std::max(1u, core_props_ptr->wavefront_size);
+        m_limits.wavefronts_per_simd         = core_props_ptr->wavefronts_per_simd;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Sorts m_entries so that the entries with the lowest theoretical occupancy come first. */
+void Anvil::ShaderStatisticsReport::sort_entries()
+{
+    std::stable_sort(m_entries.begin(),
+                     m_entries.end  (),
+                     [](const Entry& in_entry1,
+                        const Entry& in_entry2)
+                     {
+                         if (in_entry1.has_occupancy != in_entry2.has_occupancy)
+                         {
+                             return in_entry1.has_occupancy;
+                         }
+
+                         if (in_entry1.has_occupancy)
+                         {
+                             /* Compare n_waves / n_max_waves ratios without going through floats. */
+                             const uint64_t lhs = static_cast<uint64_t>(in_entry1.n_waves_per_simd) * in_entry2.n_max_waves_per_simd;
+                             const uint64_t rhs = static_cast<uint64_t>(in_entry2.n_waves_per_simd) * in_entry1.n_max_waves_per_simd;
+
+                             if (lhs != rhs)
+                             {
+                                 return lhs < rhs;
+                             }
+                         }
+
+                         return in_entry1.n_used_vgprs > in_entry2.n_used_vgprs;
+                     });
+}
+
+/** Please see header for specification */
+std::string Anvil::ShaderStatisticsReport::to_string(uint32_t in_n_max_entries) const
+{
+    const uint32_t    n_entries = static_cast<uint32_t>(std::min(static_cast<size_t>(in_n_max_entries),
+                                                                 m_entries.size() ));
+    std::stringstream result_sstream;
+
+    result_sstream << std::left
+                   << std::setw(10) << "Pipeline"
+                   << std::setw(32) << "Name"
+                   << std::setw(16) << "Stages"
+                   << std::right
+                   << std::setw(7)  << "VGPRs"
+                   << std::setw(7)  << "SGPRs"
+                   << std::setw(10) << "LDS"
+                   << std::setw(10) << "Scratch"
+                   << std::setw(8)  << "Waves"
+                   << std::setw(11) << "Occupancy"
+                   << "\n";
+
+    for (uint32_t n_entry = 0;
+                  n_entry < n_entries;
+                ++n_entry)
+    {
+        const Entry& current_entry = m_entries.at(n_entry);
+
+        result_sstream << std::left
+                       << std::setw(10) << current_entry.pipeline_id
+                       << std::setw(32) << current_entry.pipeline_name.substr(0, 31)
+                       << std::setw(16) << get_stages_string(current_entry.stages)
+                       << std::right
+                       << std::setw(7)  << current_entry.n_used_vgprs
+                       << std::setw(7)  << current_entry.n_used_sgprs
+                       << std::setw(10) << current_entry.lds_usage_bytes
+                       << std::setw(10) << current_entry.scratch_usage_bytes;
+
+        if (current_entry.has_occupancy)
+        {
+            std::stringstream waves_sstream;
+
+            waves_sstream << current_entry.n_waves_per_simd << "/" << current_entry.n_max_waves_per_simd;
+
+            result_sstream << std::setw(8)  << waves_sstream.str()
+                           << std::setw(10) << std::fixed << std::setprecision(1) << (current_entry.get_occupancy() * 100.0f) << "%";
+        }
+        else
+        {
+            result_sstream << std::setw(8)  << "-"
+                           << std::setw(11) << "-";
+        }
+
+        result_sstream << "\n";
+    }
+
+    return result_sstream.str();
+}
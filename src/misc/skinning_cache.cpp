@@ -0,0 +1,372 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "misc/debug.h"
+#include "misc/skinning_cache.h"
+#include "wrappers/buffer.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/device.h"
+
+
+/** Please see header for specification */
+Anvil::SkinningCache::SkinningCache(const Anvil::BaseDevice* in_device_ptr,
+                                    Mode                     in_mode)
+    :m_device_ptr     (in_device_ptr),
+     m_mode           (in_mode),
+     m_n_current_frame(0),
+     m_n_next_entry_id(0)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::SkinningCache::~SkinningCache()
+{
+    /* Regions must be returned before the pooled buffers go away */
+    for (const auto& current_entry : m_entries)
+    {
+        m_suballocator_ptr->free(current_entry.second.allocation);
+    }
+
+    m_entries.clear();
+}
+
+/** Please see header for specification */
+bool Anvil::SkinningCache::add_entry(uint32_t in_n_vertices,
+                                     uint32_t in_vertex_stride,
+                                     EntryID* out_entry_id_ptr)
+{
+    Entry              new_entry;
+    bool               result    = false;
+    const VkDeviceSize size      = static_cast<VkDeviceSize>(in_n_vertices) * in_vertex_stride;
+
+    anvil_assert(in_n_vertices          >  0);
+    anvil_assert(in_vertex_stride       >  0);
+    anvil_assert((in_vertex_stride % 4) == 0);
+    anvil_assert(out_entry_id_ptr       != nullptr);
+
+    if (m_mode == Mode::TRANSFORM_FEEDBACK)
+    {
+        const auto xfb_props_ptr = m_device_ptr->get_physical_device_properties().ext_transform_feedback_properties_ptr;
+
+        if (xfb_props_ptr != nullptr                                                     &&
+            (size             > xfb_props_ptr->max_transform_feedback_buffer_size        ||
+             in_vertex_stride > xfb_props_ptr->max_transform_feedback_buffer_data_stride) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    if (!m_suballocator_ptr->allocate(size,
+                                      0, /* in_alignment */
+                                     &new_entry.allocation) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    *out_entry_id_ptr = m_n_next_entry_id++;
+
+    m_entries[*out_entry_id_ptr] = new_entry;
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::SkinningCache::begin_frame()
+{
+    ++m_n_current_frame;
+}
+
+/** Please see header for specification */
+Anvil::SkinningCacheUniquePtr Anvil::SkinningCache::create(const Anvil::BaseDevice* in_device_ptr,
+                                                           Mode                     in_mode,
+                                                           VkDeviceSize             in_block_size)
+{
+    Anvil::SkinningCacheUniquePtr result_ptr(nullptr,
+                                             std::default_delete<Anvil::SkinningCache>() );
+
+    anvil_assert(in_device_ptr != nullptr);
+    anvil_assert(in_block_size >  0);
+
+    result_ptr.reset(
+        new Anvil::SkinningCache(in_device_ptr,
+                                 in_mode)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init(in_block_size) )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+bool Anvil::SkinningCache::get_output(EntryID         in_entry_id,
+                                      Anvil::Buffer** out_buffer_ptr_ptr,
+                                      VkDeviceSize*   out_offset_ptr,
+                                      VkDeviceSize*   out_opt_size_ptr) const
+{
+    auto entry_iterator = m_entries.find(in_entry_id);
+    bool result         = false;
+
+    if (entry_iterator == m_entries.end() )
+    {
+        anvil_assert(entry_iterator != m_entries.end() );
+
+        goto end;
+    }
+
+    *out_buffer_ptr_ptr = entry_iterator->second.allocation.buffer_ptr;
+    *out_offset_ptr     = entry_iterator->second.allocation.offset;
+
+    if (out_opt_size_ptr != nullptr)
+    {
+        *out_opt_size_ptr = entry_iterator->second.allocation.size;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Picks the capture mode and creates the suballocator the entry regions are carved out of.
+ *
+ *  @param in_block_size Size of pooled buffers to create.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::SkinningCache::init(VkDeviceSize in_block_size)
+{
+    Anvil::BufferUsageFlags usage_flags = Anvil::BufferUsageFlagBits::VERTEX_BUFFER_BIT;
+
+    if (m_mode == Mode::TRANSFORM_FEEDBACK)
+    {
+        const auto features_ptr = m_device_ptr->get_physical_device_features().ext_transform_feedback_features_ptr;
+
+        if (!m_device_ptr->get_extension_info()->ext_transform_feedback() ||
+             features_ptr                                                 == nullptr ||
+            !features_ptr->transform_feedback)
+        {
+            m_mode = Mode::COMPUTE;
+        }
+    }
+
+    if (m_mode == Mode::TRANSFORM_FEEDBACK)
+    {
+        usage_flags |= Anvil::BufferUsageFlagBits::TRANSFORM_FEEDBACK_BUFFER_BIT_EXT;
+    }
+    else
+    {
+        usage_flags |= Anvil::BufferUsageFlagBits::STORAGE_BUFFER_BIT;
+    }
+
+    m_suballocator_ptr = Anvil::BufferSuballocator::create(m_device_ptr,
+                                                           in_block_size,
+                                                           usage_flags,
+                                                           Anvil::MemoryFeatureFlagBits::DEVICE_LOCAL_BIT);
+
+    return (m_suballocator_ptr != nullptr);
+}
+
+/** Please see header for specification */
+bool Anvil::SkinningCache::is_captured(EntryID in_entry_id) const
+{
+    auto entry_iterator = m_entries.find(in_entry_id);
+
+    anvil_assert(entry_iterator != m_entries.end() );
+
+    return (entry_iterator                          != m_entries.end() &&
+            entry_iterator->second.n_captured_frame == m_n_current_frame);
+}
+
+/** Please see header for specification */
+bool Anvil::SkinningCache::record_begin_capture(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                                EntryID                   in_entry_id)
+{
+    auto entry_iterator = m_entries.find(in_entry_id);
+    bool result         = false;
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    if (entry_iterator == m_entries.end() )
+    {
+        anvil_assert(entry_iterator != m_entries.end() );
+
+        goto end;
+    }
+
+    if (m_mode == Mode::TRANSFORM_FEEDBACK)
+    {
+        const auto& allocation = entry_iterator->second.allocation;
+        auto        buffer_ptr = allocation.buffer_ptr;
+
+        if (!in_cmd_buffer_ptr->record_bind_transform_feedback_buffers_EXT(0, /* in_first_binding */
+                                                                           1, /* in_n_bindings    */
+                                                                          &buffer_ptr,
+                                                                          &allocation.offset,
+                                                                          &allocation.size) )
+        {
+            goto end;
+        }
+
+        /* No counter buffers, since captures are never resumed */
+        if (!in_cmd_buffer_ptr->record_begin_transform_feedback_EXT(0,         /* in_first_counter_buffer       */
+                                                                    0,         /* in_n_counter_buffers          */
+                                                                    nullptr,   /* in_opt_counter_buffer_ptrs    */
+                                                                    nullptr) ) /* in_opt_counter_buffer_offsets */
+        {
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::SkinningCache::record_bind_vertex_buffer(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                                     EntryID                   in_entry_id,
+                                                     uint32_t                  in_binding)
+{
+    Anvil::Buffer* buffer_ptr = nullptr;
+    VkDeviceSize   offset     = 0;
+    bool           result     = false;
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+    anvil_assert(is_captured(in_entry_id) );
+
+    if (!get_output(in_entry_id,
+                   &buffer_ptr,
+                   &offset) )
+    {
+        goto end;
+    }
+
+    result = in_cmd_buffer_ptr->record_bind_vertex_buffers(in_binding,
+                                                           1, /* in_binding_count */
+                                                          &buffer_ptr,
+                                                          &offset);
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::SkinningCache::record_end_capture(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                              EntryID                   in_entry_id)
+{
+    auto entry_iterator = m_entries.find(in_entry_id);
+    bool result         = false;
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    if (entry_iterator == m_entries.end() )
+    {
+        anvil_assert(entry_iterator != m_entries.end() );
+
+        goto end;
+    }
+
+    if (m_mode == Mode::TRANSFORM_FEEDBACK)
+    {
+        if (!in_cmd_buffer_ptr->record_end_transform_feedback_EXT(0,         /* in_first_counter_buffer       */
+                                                                  0,         /* in_n_counter_buffers          */
+                                                                  nullptr,   /* in_opt_counter_buffer_ptrs    */
+                                                                  nullptr) ) /* in_opt_counter_buffer_offsets */
+        {
+            goto end;
+        }
+    }
+
+    entry_iterator->second.n_captured_frame = m_n_current_frame;
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::SkinningCache::record_post_capture_barrier(Anvil::CommandBufferBase* in_cmd_buffer_ptr) const
+{
+    const bool                 is_xfb = (m_mode == Mode::TRANSFORM_FEEDBACK);
+    const Anvil::MemoryBarrier barrier(Anvil::AccessFlagBits::VERTEX_ATTRIBUTE_READ_BIT, /* in_destination_access_mask */
+                                       (is_xfb) ? Anvil::AccessFlagBits::TRANSFORM_FEEDBACK_WRITE_BIT_EXT
+                                                : Anvil::AccessFlagBits::SHADER_WRITE_BIT);
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    return in_cmd_buffer_ptr->record_pipeline_barrier((is_xfb) ? Anvil::PipelineStageFlagBits::TRANSFORM_FEEDBACK_BIT_EXT
+                                                               : Anvil::PipelineStageFlagBits::COMPUTE_SHADER_BIT,
+                                                      Anvil::PipelineStageFlagBits::VERTEX_INPUT_BIT,
+                                                      Anvil::DependencyFlagBits::NONE,
+                                                      1,        /* in_memory_barrier_count        */
+                                                     &barrier,
+                                                      0,        /* in_buffer_memory_barrier_count */
+                                                      nullptr,  /* in_buffer_memory_barriers_ptr  */
+                                                      0,        /* in_image_memory_barrier_count  */
+                                                      nullptr); /* in_image_memory_barriers_ptr   */
+}
+
+/** Please see header for specification */
+bool Anvil::SkinningCache::record_pre_capture_barrier(Anvil::CommandBufferBase* in_cmd_buffer_ptr) const
+{
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    /* Write-after-read hazard only, so an execution dependency is enough */
+    return in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::VERTEX_INPUT_BIT,
+                                                      (m_mode == Mode::TRANSFORM_FEEDBACK) ? Anvil::PipelineStageFlagBits::TRANSFORM_FEEDBACK_BIT_EXT
+                                                                                           : Anvil::PipelineStageFlagBits::COMPUTE_SHADER_BIT,
+                                                      Anvil::DependencyFlagBits::NONE,
+                                                      0,        /* in_memory_barrier_count        */
+                                                      nullptr,  /* in_memory_barriers_ptr         */
+                                                      0,        /* in_buffer_memory_barrier_count */
+                                                      nullptr,  /* in_buffer_memory_barriers_ptr  */
+                                                      0,        /* in_image_memory_barrier_count  */
+                                                      nullptr); /* in_image_memory_barriers_ptr   */
+}
+
+/** Please see header for specification */
+void Anvil::SkinningCache::remove_entry(EntryID in_entry_id)
+{
+    auto entry_iterator = m_entries.find(in_entry_id);
+
+    if (entry_iterator == m_entries.end() )
+    {
+        anvil_assert(entry_iterator != m_entries.end() );
+
+        return;
+    }
+
+    m_suballocator_ptr->free(entry_iterator->second.allocation);
+    m_entries.erase         (entry_iterator);
+}
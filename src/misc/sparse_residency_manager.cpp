@@ -0,0 +1,658 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#include "misc/debug.h"
+#include "misc/debug.h"
+#include "misc/image_create_info.h"
+#include "misc/memory_block_create_info.h"
+#include "misc/sparse_residency_manager.h"
+#include "wrappers/device.h"
+#include "wrappers/image.h"
+#include "wrappers/memory_block.h"
+#include "wrappers/queue.h"
+#include <algorithm>
+
+
+/** Please see header for specification */
+Anvil::SparseResidencyManager::SparseResidencyManager(Anvil::Image*                             in_image_ptr,
+                                                      Anvil::ImageAspectFlagBits                in_aspect,
+                                                      const Anvil::SparseImageAspectProperties& in_aspect_props,
+                                                      uint32_t                                  in_n_max_resident_pages,
+                                                      uint32_t                                  in_n_pages_per_memory_block,
+                                                      bool                                      in_mt_safe)
+    :MTSafetySupportProvider   (in_mt_safe),
+     m_aspect                  (in_aspect),
+     m_aspect_props            (in_aspect_props),
+     m_image_ptr               (in_image_ptr),
+     m_is_mip_tail_bound       (false),
+     m_lru_head_slot           (UINT32_MAX),
+     m_lru_tail_slot           (UINT32_MAX),
+     m_n_current_frame         (1),
+     m_n_max_resident_pages    (in_n_max_resident_pages),
+     m_n_pages_per_layer       (0),
+     m_n_pages_per_memory_block(in_n_pages_per_memory_block),
+     m_n_resident_pages        (0),
+     m_n_tiled_mipmaps         (0),
+     m_page_extent             (in_aspect_props.granularity),
+     m_page_size               (in_image_ptr->get_image_alignment(0 /* in_n_plane */) )
+{
+    init_page_layout();
+}
+
+/** Please see header for specification */
+Anvil::SparseResidencyManager::~SparseResidencyManager()
+{
+    /* Stub */
+}
+
+/** Retrieves a slot which a new page can be bound to. Free slots are used first. If none is available and the
+ *  budget allows, a new memory block is allocated. Otherwise, the least recently used slot is returned, as long as
+ *  its page has not been requested in the current frame.
+ *
+ *  If the returned slot holds a page, the caller is responsible for evicting it.
+ *
+ *  @param out_n_slot_ptr Deref will be set to the index of the slot. Must not be null.
+ *
+ *  @return true if a slot has been found, false otherwise.
+ */
+bool Anvil::SparseResidencyManager::acquire_slot(uint32_t* out_n_slot_ptr)
+{
+    bool result = false;
+
+    if (m_free_slots.empty()                       &&
+        m_slots.size     () < m_n_max_resident_pages)
+    {
+        const uint32_t              n_first_slot     = static_cast<uint32_t>(m_slots.size() );
+        const uint32_t              n_new_slots      = std::min(m_n_pages_per_memory_block,
+                                                                m_n_max_resident_pages - n_first_slot);
+        Anvil::MemoryBlockUniquePtr memory_block_ptr;
+
+        {
+            auto create_info_ptr = Anvil::MemoryBlockCreateInfo::create_regular(m_image_ptr->get_create_info_ptr()->get_device(),
+                                                                                m_image_ptr->get_image_memory_types(0 /* in_n_plane */),
+                                                                                m_page_size * n_new_slots,
+                                                                                Anvil::MemoryFeatureFlagBits::DEVICE_LOCAL_BIT);
+
+            memory_block_ptr = Anvil::MemoryBlock::create(std::move(create_info_ptr) );
+        }
+
+        /* An out-of-memory condition is not fatal. Fall back to evicting resident pages instead. */
+        if (memory_block_ptr != nullptr)
+        {
+            m_memory_blocks.push_back(
+                std::move(memory_block_ptr)
+            );
+
+            m_slots.resize(n_first_slot + n_new_slots);
+
+            for (uint32_t n_slot = n_first_slot + n_new_slots;
+                          n_slot > n_first_slot;
+                        --n_slot)
+            {
+                m_free_slots.push_back(n_slot - 1);
+            }
+        }
+    }
+
+    if (!m_free_slots.empty() )
+    {
+        *out_n_slot_ptr = m_free_slots.back();
+
+        m_free_slots.pop_back();
+
+        result = true;
+    }
+    else
+    if (m_lru_tail_slot                             != UINT32_MAX &&
+        m_slots.at(m_lru_tail_slot).last_used_frame <  m_n_current_frame)
+    {
+        *out_n_slot_ptr = m_lru_tail_slot;
+        result          = true;
+    }
+
+    return result;
+}
+
+/** Appends a bind (or, if @param in_opt_memory_block_ptr is null, unbind) operation for the specified page
+ *  to the bind info.
+ *
+ *  @param in_update_ptr                Update to append the operation to. Must not be null.
+ *  @param in_bind_info_id              ID of the bind info to use.
+ *  @param in_page                      Page to update. Must not belong to the mip tail.
+ *  @param in_opt_memory_block_ptr      Memory block to bind to the page, or null to unbind the page.
+ *  @param in_memory_block_start_offset Start offset of the page's memory within @param in_opt_memory_block_ptr.
+ */
+void Anvil::SparseResidencyManager::append_page_update(Anvil::SparseMemoryBindingUpdateInfo* in_update_ptr,
+                                                       Anvil::SparseMemoryBindInfoID         in_bind_info_id,
+                                                       const PageID&                         in_page,
+                                                       Anvil::MemoryBlock*                   in_opt_memory_block_ptr,
+                                                       VkDeviceSize                          in_memory_block_start_offset)
+{
+    Anvil::ImageSubresource subresource;
+    VkOffset3D              offset;
+
+    subresource.array_layer = in_page.n_layer;
+    subresource.aspect_mask = m_aspect;
+    subresource.mip_level   = in_page.n_mipmap;
+
+    offset.x = static_cast<int32_t>(in_page.tile_x * m_page_extent.width);
+    offset.y = static_cast<int32_t>(in_page.tile_y * m_page_extent.height);
+    offset.z = static_cast<int32_t>(in_page.tile_z * m_page_extent.depth);
+
+    /* Tiles at the subresource edge are bound with the full granularity-sized extent, as expected by
+     * Image::on_memory_backing_update(). Extents which are a multiple of the granularity are always valid. */
+    in_update_ptr->append_image_memory_update(in_bind_info_id,
+                                              m_image_ptr,
+                                              subresource,
+                                              offset,
+                                              m_page_extent,
+                                              Anvil::SparseMemoryBindFlagBits::NONE,
+                                              in_opt_memory_block_ptr,
+                                              in_memory_block_start_offset,
+                                              false); /* in_opt_memory_block_owned_by_image */
+}
+
+/** Allocates memory for the image's mip tail(s) and appends the corresponding opaque bind operations to
+ *  the bind info.
+ *
+ *  @param in_update_ptr   Update to append the operations to. Must not be null.
+ *  @param in_bind_info_id ID of the bind info to use.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::SparseResidencyManager::bind_mip_tails(Anvil::SparseMemoryBindingUpdateInfo* in_update_ptr,
+                                                   Anvil::SparseMemoryBindInfoID         in_bind_info_id)
+{
+    uint32_t n_mip_tails = 0;
+    bool     result      = false;
+
+    if (m_aspect_props.mip_tail_first_lod >= m_image_ptr->get_n_mipmaps() ||
+        m_aspect_props.mip_tail_size      == 0)
+    {
+        /* Nothing to bind */
+        result = true;
+
+        goto end;
+    }
+
+    n_mip_tails = ((m_aspect_props.flags & Anvil::SparseImageFormatFlagBits::SINGLE_MIPTAIL_BIT) != 0) ? 1
+                                                                                                       : m_image_ptr->get_create_info_ptr()->get_n_layers();
+
+    {
+        auto create_info_ptr = Anvil::MemoryBlockCreateInfo::create_regular(m_image_ptr->get_create_info_ptr()->get_device(),
+                                                                            m_image_ptr->get_image_memory_types(0 /* in_n_plane */),
+                                                                            m_aspect_props.mip_tail_size * n_mip_tails,
+                                                                            Anvil::MemoryFeatureFlagBits::DEVICE_LOCAL_BIT);
+
+        m_mip_tail_memory_block_ptr = Anvil::MemoryBlock::create(std::move(create_info_ptr) );
+    }
+
+    if (m_mip_tail_memory_block_ptr == nullptr)
+    {
+        anvil_assert(m_mip_tail_memory_block_ptr != nullptr);
+
+        goto end;
+    }
+
+    for (uint32_t n_mip_tail = 0;
+                  n_mip_tail < n_mip_tails;
+                ++n_mip_tail)
+    {
+        in_update_ptr->append_opaque_image_memory_update(in_bind_info_id,
+                                                         m_image_ptr,
+                                                         m_aspect_props.mip_tail_offset + m_aspect_props.mip_tail_stride * n_mip_tail,
+                                                         m_aspect_props.mip_tail_size,
+                                                         Anvil::SparseMemoryBindFlagBits::NONE,
+                                                         m_mip_tail_memory_block_ptr.get(),
+                                                         m_aspect_props.mip_tail_size * n_mip_tail,
+                                                         false, /* in_opt_memory_block_owned_by_image */
+                                                         0);    /* in_n_plane                         */
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::SparseResidencyManager::commit(Anvil::Queue*            in_queue_ptr,
+                                           uint32_t                 in_n_signal_semaphores,
+                                           Anvil::Semaphore* const* in_opt_signal_semaphore_ptrs,
+                                           uint32_t                 in_n_wait_semaphores,
+                                           Anvil::Semaphore* const* in_opt_wait_semaphore_ptrs,
+                                           std::vector<PageID>*     out_opt_bound_pages_ptr)
+{
+    bool has_updates = false;
+    bool result      = false;
+
+    anvil_assert(in_queue_ptr != nullptr);
+    anvil_assert(in_queue_ptr->supports_sparse_bindings() );
+
+    if (out_opt_bound_pages_ptr != nullptr)
+    {
+        out_opt_bound_pages_ptr->clear();
+    }
+
+    lock();
+    {
+        Anvil::SparseMemoryBindingUpdateInfo update;
+        const auto                           bind_info_id = update.add_bind_info(in_n_signal_semaphores,
+                                                                                 in_opt_signal_semaphore_ptrs,
+                                                                                 in_n_wait_semaphores,
+                                                                                 in_opt_wait_semaphore_ptrs);
+
+        if (!m_is_mip_tail_bound)
+        {
+            if (!bind_mip_tails(&update,
+                                bind_info_id) )
+            {
+                goto end;
+            }
+
+            has_updates = true;
+        }
+
+        for (const auto& current_page : m_pending_pages)
+        {
+            uint32_t n_slot     = UINT32_MAX;
+            uint32_t page_index = UINT32_MAX;
+            Slot*    slot_ptr   = nullptr;
+
+            get_page_index(current_page,
+                          &page_index);
+
+            if (m_page_slots.at(page_index) != UINT32_MAX)
+            {
+                continue;
+            }
+
+            if (!acquire_slot(&n_slot) )
+            {
+                /* All resident pages are in use by the current frame. Drop the remaining requests. */
+                break;
+            }
+
+            slot_ptr = &m_slots.at(n_slot);
+
+            if (slot_ptr->page_index != UINT32_MAX)
+            {
+                /* Evict the page currently held by the slot */
+                append_page_update(&update,
+                                   bind_info_id,
+                                   slot_ptr->page,
+                                   nullptr, /* in_opt_memory_block_ptr */
+                                   0);      /* in_memory_block_start_offset */
+
+                m_page_slots.at(slot_ptr->page_index) = UINT32_MAX;
+                m_n_resident_pages--;
+
+                unlink_slot(n_slot);
+            }
+
+            append_page_update(&update,
+                               bind_info_id,
+                               current_page,
+                               m_memory_blocks.at(n_slot / m_n_pages_per_memory_block).get(),
+                               m_page_size * (n_slot % m_n_pages_per_memory_block) );
+
+            slot_ptr->last_used_frame = m_n_current_frame;
+            slot_ptr->page            = current_page;
+            slot_ptr->page_index      = page_index;
+
+            link_slot_as_mru(n_slot);
+
+            m_page_slots.at(page_index) = n_slot;
+            m_n_resident_pages++;
+
+            if (out_opt_bound_pages_ptr != nullptr)
+            {
+                out_opt_bound_pages_ptr->push_back(current_page);
+            }
+
+            has_updates = true;
+        }
+
+        if (has_updates                 ||
+            in_n_signal_semaphores > 0  ||
+            in_n_wait_semaphores   > 0)
+        {
+            if (!in_queue_ptr->bind_sparse_memory(update) )
+            {
+                goto end;
+            }
+        }
+
+        m_is_mip_tail_bound = true;
+
+        m_pending_pages.clear();
+        m_n_current_frame++;
+
+        result = true;
+    }
+end:
+    unlock();
+
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::SparseResidencyManagerUniquePtr Anvil::SparseResidencyManager::create(Anvil::Image*              in_image_ptr,
+                                                                             Anvil::ImageAspectFlagBits in_aspect,
+                                                                             uint32_t                   in_n_max_resident_pages,
+                                                                             uint32_t                   in_n_pages_per_memory_block,
+                                                                             bool                       in_mt_safe)
+{
+    const Anvil::SparseImageAspectProperties* aspect_props_ptr = nullptr;
+    Anvil::SparseResidencyManagerUniquePtr    result_ptr        (nullptr,
+                                                                 std::default_delete<Anvil::SparseResidencyManager>() );
+
+    anvil_assert(in_image_ptr                != nullptr);
+    anvil_assert(in_n_max_resident_pages     >  0);
+    anvil_assert(in_n_pages_per_memory_block >  0);
+
+    if ((in_image_ptr->get_create_info_ptr()->get_create_flags() & Anvil::ImageCreateFlagBits::SPARSE_RESIDENCY_BIT) == 0)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (!in_image_ptr->get_sparse_image_aspect_properties(in_aspect,
+                                                         &aspect_props_ptr) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    result_ptr.reset(
+        new Anvil::SparseResidencyManager(in_image_ptr,
+                                          in_aspect,
+                                         *aspect_props_ptr,
+                                          in_n_max_resident_pages,
+                                          in_n_pages_per_memory_block,
+                                          in_mt_safe)
+    );
+
+end:
+    return result_ptr;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::SparseResidencyManager::get_n_memory_blocks() const
+{
+    uint32_t result = 0;
+
+    lock();
+    {
+        result = static_cast<uint32_t>(m_memory_blocks.size() );
+    }
+    unlock();
+
+    return result;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::SparseResidencyManager::get_n_pending_requests() const
+{
+    uint32_t result = 0;
+
+    lock();
+    {
+        result = static_cast<uint32_t>(m_pending_pages.size() );
+    }
+    unlock();
+
+    return result;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::SparseResidencyManager::get_n_resident_pages() const
+{
+    uint32_t result = 0;
+
+    lock();
+    {
+        result = m_n_resident_pages;
+    }
+    unlock();
+
+    return result;
+}
+
+/** Converts a page ID to an index into the per-page arrays.
+ *
+ *  @param in_page            Page to use for the query.
+ *  @param out_page_index_ptr Deref will be set to the index of the page. Must not be null.
+ *
+ *  @return true if the page belongs to one of the tiled mips, false if it belongs to the mip tail or is invalid.
+ */
+bool Anvil::SparseResidencyManager::get_page_index(const PageID& in_page,
+                                                   uint32_t*     out_page_index_ptr) const
+{
+    bool result = false;
+
+    if (in_page.n_layer  >= m_image_ptr->get_create_info_ptr()->get_n_layers() ||
+        in_page.n_mipmap >= m_n_tiled_mipmaps)
+    {
+        goto end;
+    }
+
+    {
+        const auto& n_tiles = m_mip_n_tiles.at(in_page.n_mipmap);
+
+        if (in_page.tile_x >= n_tiles[0] ||
+            in_page.tile_y >= n_tiles[1] ||
+            in_page.tile_z >= n_tiles[2])
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        *out_page_index_ptr = in_page.n_layer * m_n_pages_per_layer                       +
+                              m_mip_first_page_indices.at(in_page.n_mipmap)                 +
+                              (in_page.tile_z * n_tiles[1] + in_page.tile_y) * n_tiles[0] +
+                              in_page.tile_x;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Determines the number of tiles in each tiled mip and sizes the per-page arrays accordingly. */
+void Anvil::SparseResidencyManager::init_page_layout()
+{
+    const uint32_t n_layers  = m_image_ptr->get_create_info_ptr()->get_n_layers();
+    const uint32_t n_mipmaps = m_image_ptr->get_n_mipmaps();
+
+    m_n_tiled_mipmaps = std::min(n_mipmaps,
+                                 m_aspect_props.mip_tail_first_lod);
+
+    m_mip_first_page_indices.resize(m_n_tiled_mipmaps);
+    m_mip_n_tiles.resize           (m_n_tiled_mipmaps);
+
+    for (uint32_t n_mipmap = 0;
+                  n_mipmap < m_n_tiled_mipmaps;
+                ++n_mipmap)
+    {
+        const VkExtent3D mip_extent = m_image_ptr->get_image_extent_3D(n_mipmap);
+        auto&            n_tiles    = m_mip_n_tiles.at(n_mipmap);
+
+        n_tiles[0] = (mip_extent.width  + m_page_extent.width  - 1) / m_page_extent.width;
+        n_tiles[1] = (mip_extent.height + m_page_extent.height - 1) / m_page_extent.height;
+        n_tiles[2] = (mip_extent.depth  + m_page_extent.depth  - 1) / m_page_extent.depth;
+
+        m_mip_first_page_indices.at(n_mipmap) = m_n_pages_per_layer;
+        m_n_pages_per_layer                  += n_tiles[0] * n_tiles[1] * n_tiles[2];
+    }
+
+    m_page_request_frames.resize(n_layers * m_n_pages_per_layer,
+                                 0);
+    m_page_slots.resize         (n_layers * m_n_pages_per_layer,
+                                 UINT32_MAX);
+}
+
+/** Please see header for specification */
+bool Anvil::SparseResidencyManager::is_page_resident(const PageID& in_page) const
+{
+    uint32_t page_index = UINT32_MAX;
+    bool     result     = false;
+
+    lock();
+    {
+        if (get_page_index(in_page,
+                          &page_index) )
+        {
+            result = (m_page_slots.at(page_index) != UINT32_MAX);
+        }
+        else
+        {
+            result = (m_is_mip_tail_bound                              &&
+                      in_page.n_mipmap >= m_n_tiled_mipmaps            &&
+                      in_page.n_mipmap <  m_image_ptr->get_n_mipmaps() );
+        }
+    }
+    unlock();
+
+    return result;
+}
+
+/** Inserts the specified slot at the most recently used end of the LRU list.
+ *
+ *  @param in_n_slot Index of the slot. Must not be linked.
+ */
+void Anvil::SparseResidencyManager::link_slot_as_mru(uint32_t in_n_slot)
+{
+    auto& slot = m_slots.at(in_n_slot);
+
+    slot.n_next_slot = m_lru_head_slot;
+    slot.n_prev_slot = UINT32_MAX;
+
+    if (m_lru_head_slot != UINT32_MAX)
+    {
+        m_slots.at(m_lru_head_slot).n_prev_slot = in_n_slot;
+    }
+
+    m_lru_head_slot = in_n_slot;
+
+    if (m_lru_tail_slot == UINT32_MAX)
+    {
+        m_lru_tail_slot = in_n_slot;
+    }
+}
+
+/** Please see header for specification */
+void Anvil::SparseResidencyManager::request_page(const PageID& in_page)
+{
+    lock();
+    {
+        request_page_locked(in_page);
+    }
+    unlock();
+}
+
+/** Implements request_page(). The caller must hold the lock. */
+void Anvil::SparseResidencyManager::request_page_locked(const PageID& in_page)
+{
+    uint32_t page_index = UINT32_MAX;
+    uint32_t n_slot     = UINT32_MAX;
+
+    if (!get_page_index(in_page,
+                       &page_index) )
+    {
+        /* Mip tail pages are always resident */
+        anvil_assert(in_page.n_mipmap < m_image_ptr->get_n_mipmaps() );
+
+        return;
+    }
+
+    if (m_page_request_frames.at(page_index) == m_n_current_frame)
+    {
+        return;
+    }
+
+    m_page_request_frames.at(page_index) = m_n_current_frame;
+    n_slot                               = m_page_slots.at(page_index);
+
+    if (n_slot != UINT32_MAX)
+    {
+        /* Resident page. Move it to the MRU end so that it is evicted last. */
+        m_slots.at(n_slot).last_used_frame = m_n_current_frame;
+
+        unlink_slot     (n_slot);
+        link_slot_as_mru(n_slot);
+    }
+    else
+    {
+        m_pending_pages.push_back(in_page);
+    }
+}
+
+/** Please see header for specification */
+void Anvil::SparseResidencyManager::request_pages(uint32_t      in_n_pages,
+                                                  const PageID* in_pages_ptr)
+{
+    anvil_assert(in_n_pages   == 0       ||
+                 in_pages_ptr != nullptr);
+
+    lock();
+    {
+        for (uint32_t n_page = 0;
+                      n_page < in_n_pages;
+                    ++n_page)
+        {
+            request_page_locked(in_pages_ptr[n_page]);
+        }
+    }
+    unlock();
+}
+
+/** Removes the specified slot from the LRU list.
+ *
+ *  @param in_n_slot Index of the slot. Must be linked.
+ */
+void Anvil::SparseResidencyManager::unlink_slot(uint32_t in_n_slot)
+{
+    auto& slot = m_slots.at(in_n_slot);
+
+    if (slot.n_prev_slot != UINT32_MAX)
+    {
+        m_slots.at(slot.n_prev_slot).n_next_slot = slot.n_next_slot;
+    }
+    else
+    {
+        m_lru_head_slot = slot.n_next_slot;
+    }
+
+    if (slot.n_next_slot != UINT32_MAX)
+    {
+        m_slots.at(slot.n_next_slot).n_prev_slot = slot.n_prev_slot;
+    }
+    else
+    {
+        m_lru_tail_slot = slot.n_prev_slot;
+    }
+
+    slot.n_next_slot = UINT32_MAX;
+    slot.n_prev_slot = UINT32_MAX;
+}
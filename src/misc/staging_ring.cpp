@@ -0,0 +1,367 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#include "misc/buffer_create_info.h"
+#include "misc/debug.h"
+#include "misc/fence_create_info.h"
+#include "misc/staging_ring.h"
+#include "wrappers/buffer.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/device.h"
+#include "wrappers/fence.h"
+#include "wrappers/memory_block.h"
+
+
+/** Please see header for specification */
+Anvil::StagingRing::StagingRing(const Anvil::BaseDevice* in_device_ptr,
+                                VkDeviceSize             in_size)
+    :MTSafetySupportProvider(true,   /* in_enable            */
+                             false), /* in_is_lock_recursive */
+     m_device_ptr           (in_device_ptr),
+     m_head_offset          (0),
+     m_size                 (in_size)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::StagingRing::~StagingRing()
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+
+    for (auto& current_region : m_regions)
+    {
+        anvil_assert(current_region.is_released);
+
+        if (current_region.is_submitted &&
+           !current_region.fence_ptr->is_set() )
+        {
+            m_device_ptr->get_dispatch_table().vkWaitForFences(m_device_ptr->get_device_vk(),
+                                                               1, /* fenceCount */
+                                                               current_region.fence_ptr->get_fence_ptr(),
+                                                               VK_TRUE,     /* waitAll */
+                                                               UINT64_MAX); /* timeout */
+        }
+    }
+
+    m_regions.clear    ();
+    m_free_fences.clear();
+
+    if (m_buffer_ptr != nullptr)
+    {
+        m_buffer_ptr->get_memory_block(0 /* in_n_memory_block */)->unmap();
+        m_buffer_ptr.reset();
+    }
+}
+
+/** Please see header for specification */
+bool Anvil::StagingRing::allocate(VkDeviceSize in_size,
+                                  VkDeviceSize in_alignment,
+                                  Allocation*  out_result_ptr)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock (*get_mutex() );
+    bool                                       result     (false);
+    VkDeviceSize                               start_offset(0);
+
+    anvil_assert(in_size        >  0);
+    anvil_assert(in_alignment   >  0);
+    anvil_assert(out_result_ptr != nullptr);
+
+    if (in_size > m_size)
+    {
+        goto end;
+    }
+
+    while (true)
+    {
+        retire_regions();
+
+        if (try_reserve_region(in_size,
+                               in_alignment,
+                              &start_offset) )
+        {
+            break;
+        }
+
+        /* No space left. If the oldest region is in flight, wait for it to retire. Otherwise its owner is still
+         * accessing it and we cannot tell when the space is going to become available, so bail out. */
+        anvil_assert(!m_regions.empty() );
+
+        if (!m_regions.front().is_released  ||
+            !m_regions.front().is_submitted)
+        {
+            goto end;
+        }
+
+        m_device_ptr->get_dispatch_table().vkWaitForFences(m_device_ptr->get_device_vk(),
+                                                           1, /* fenceCount */
+                                                           m_regions.front().fence_ptr->get_fence_ptr(),
+                                                           VK_TRUE,     /* waitAll */
+                                                           UINT64_MAX); /* timeout */
+    }
+
+    m_regions.emplace_back(start_offset,
+                           start_offset + in_size,
+                           get_fence() );
+
+    if (m_regions.back().fence_ptr == nullptr)
+    {
+        anvil_assert(m_regions.back().fence_ptr != nullptr);
+
+        m_regions.pop_back();
+        goto end;
+    }
+
+    m_head_offset = start_offset + in_size;
+
+    out_result_ptr->buffer_ptr = m_buffer_ptr.get();
+    out_result_ptr->fence_ptr  = m_regions.back().fence_ptr.get();
+    out_result_ptr->offset     = start_offset;
+    out_result_ptr->size       = in_size;
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::StagingRingUniquePtr Anvil::StagingRing::create(const Anvil::BaseDevice* in_device_ptr,
+                                                       VkDeviceSize             in_size)
+{
+    Anvil::StagingRingUniquePtr result_ptr(nullptr,
+                                           std::default_delete<Anvil::StagingRing>() );
+
+    anvil_assert(in_size > 0);
+
+    result_ptr.reset(
+        new Anvil::StagingRing(in_device_ptr,
+                               in_size)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init() )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+/** Returns a reset fence, recycling previously retired fences if possible. */
+Anvil::FenceUniquePtr Anvil::StagingRing::get_fence()
+{
+    Anvil::FenceUniquePtr result_ptr;
+
+    if (!m_free_fences.empty() )
+    {
+        result_ptr = std::move(m_free_fences.back() );
+
+        m_free_fences.pop_back();
+        result_ptr->reset     ();
+    }
+    else
+    {
+        auto create_info_ptr = Anvil::FenceCreateInfo::create(m_device_ptr,
+                                                              false); /* in_create_signalled */
+
+        create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+
+        result_ptr = Anvil::Fence::create(std::move(create_info_ptr) );
+    }
+
+    return result_ptr;
+}
+
+/** Creates & persistently maps the buffer backing the ring. */
+bool Anvil::StagingRing::init()
+{
+    Anvil::QueueFamilyFlags queue_fams = Anvil::QueueFamilyFlagBits::NONE;
+    bool                    result     = false;
+
+    /* The ring is shared by all queue families the device exposes, since we cannot tell in advance
+     * which queue is going to be used for a given transfer. */
+    if (m_device_ptr->get_n_universal_queues() > 0)
+    {
+        queue_fams |= Anvil::QueueFamilyFlagBits::GRAPHICS_BIT;
+    }
+
+    if (m_device_ptr->get_n_compute_queues() > 0)
+    {
+        queue_fams |= Anvil::QueueFamilyFlagBits::COMPUTE_BIT;
+    }
+
+    if (m_device_ptr->get_n_transfer_queues() > 0)
+    {
+        queue_fams |= Anvil::QueueFamilyFlagBits::DMA_BIT;
+    }
+
+    {
+        const auto sharing_mode    = Anvil::Utils::is_pow2(queue_fams.get_vk() ) ? Anvil::SharingMode::EXCLUSIVE
+                                                                                 : Anvil::SharingMode::CONCURRENT;
+        auto       create_info_ptr = Anvil::BufferCreateInfo::create_alloc(m_device_ptr,
+                                                                           m_size,
+                                                                           queue_fams,
+                                                                           sharing_mode,
+                                                                           Anvil::BufferCreateFlagBits::NONE,
+                                                                           Anvil::BufferUsageFlagBits::TRANSFER_DST_BIT | Anvil::BufferUsageFlagBits::TRANSFER_SRC_BIT,
+                                                                           Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT);
+
+        create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+
+        m_buffer_ptr = Anvil::Buffer::create(std::move(create_info_ptr) );
+    }
+
+    if (m_buffer_ptr == nullptr)
+    {
+        anvil_assert(m_buffer_ptr != nullptr);
+
+        goto end;
+    }
+
+    /* Keep the ring mapped throughout its lifetime, so that transfers do not need to remap it. */
+    if (!m_buffer_ptr->get_memory_block(0 /* in_n_memory_block */)->map(0, /* in_start_offset */
+                                                                        m_size) )
+    {
+        anvil_assert_fail();
+
+        m_buffer_ptr.reset();
+        goto end;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::StagingRing::release(const Allocation&                    in_allocation,
+                                 bool                                 in_submitted,
+                                 Anvil::PrimaryCommandBufferUniquePtr in_opt_cmd_buffer_ptr)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock(*get_mutex() );
+    bool                                       found     (false);
+
+    ANVIL_REDUNDANT_VARIABLE(found);
+
+    for (auto& current_region : m_regions)
+    {
+        if (current_region.fence_ptr.get() == in_allocation.fence_ptr)
+        {
+            anvil_assert(!current_region.is_released);
+
+            current_region.cmd_buffer_ptr = std::move(in_opt_cmd_buffer_ptr);
+            current_region.is_released    = true;
+            current_region.is_submitted   = in_submitted;
+
+            found = true;
+            break;
+        }
+    }
+
+    anvil_assert(found);
+
+    retire_regions();
+}
+
+/** Drops all regions at the front of the ring whose fences have been signalled. */
+void Anvil::StagingRing::retire_regions()
+{
+    while (!m_regions.empty() )
+    {
+        auto& oldest_region = m_regions.front();
+
+        if (!oldest_region.is_released)
+        {
+            break;
+        }
+
+        if (oldest_region.is_submitted    &&
+           !oldest_region.fence_ptr->is_set() )
+        {
+            break;
+        }
+
+        m_free_fences.push_back(std::move(oldest_region.fence_ptr) );
+        m_regions.pop_front    ();
+    }
+
+    if (m_regions.empty() )
+    {
+        m_head_offset = 0;
+    }
+}
+
+/** Tells whether a region of the requested size can be carved out of the ring without overlapping any of the
+ *  regions still in use.
+ *
+ *  @param in_size              Number of bytes required.
+ *  @param in_alignment         Required start offset alignment.
+ *  @param out_start_offset_ptr Deref will be set to the region's start offset if the function returns true.
+ *
+ *  @return true if space is available, false otherwise.
+ */
+bool Anvil::StagingRing::try_reserve_region(VkDeviceSize  in_size,
+                                            VkDeviceSize  in_alignment,
+                                            VkDeviceSize* out_start_offset_ptr) const
+{
+    const VkDeviceSize aligned_head_offset = Anvil::Utils::round_up(m_head_offset,
+                                                                    in_alignment);
+    bool               result              = false;
+
+    if (m_regions.empty() )
+    {
+        *out_start_offset_ptr = 0;
+        result                = true;
+    }
+    else
+    {
+        const VkDeviceSize tail_offset = m_regions.front().start_offset;
+
+        if (m_head_offset > tail_offset)
+        {
+            /* Used space is contiguous: [tail, head). Try the end of the ring first, then wrap around. */
+            if (aligned_head_offset + in_size <= m_size)
+            {
+                *out_start_offset_ptr = aligned_head_offset;
+                result                = true;
+            }
+            else
+            if (in_size <= tail_offset)
+            {
+                *out_start_offset_ptr = 0;
+                result                = true;
+            }
+        }
+        else
+        {
+            /* The ring has wrapped around. Free space is [head, tail). */
+            if (aligned_head_offset + in_size <= tail_offset)
+            {
+                *out_start_offset_ptr = aligned_head_offset;
+                result                = true;
+            }
+        }
+    }
+
+    return result;
+}
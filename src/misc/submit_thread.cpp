@@ -0,0 +1,498 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#include "misc/debug.h"
+#include "misc/submit_thread.h"
+#include "wrappers/queue.h"
+
+
+/** Please see header for specification */
+Anvil::SubmitThread::SubmitThread(Anvil::Queue* in_queue_ptr,
+                                  uint32_t      in_n_ring_slots)
+    :m_dequeue_pos        (0),
+     m_enqueue_pos        (0),
+     m_is_thread_sleeping (false),
+     m_last_present_result(Anvil::SwapchainOperationErrorCode::SUCCESS),
+     m_n_failed_operations(0),
+     m_n_issued_tickets   (0),
+     m_queue_ptr          (in_queue_ptr),
+     m_ring               (in_n_ring_slots),
+     m_ring_mask          (in_n_ring_slots - 1),
+     m_should_quit        (false)
+{
+    for (uint32_t n_slot = 0;
+                  n_slot < in_n_ring_slots;
+                ++n_slot)
+    {
+        m_ring.at(n_slot).sequence.store(n_slot);
+    }
+
+    m_batch_slot_ptrs.resize        (in_n_ring_slots);
+    m_batch_submit_info_ptrs.reserve(in_n_ring_slots);
+    m_batch_submit_infos.reserve    (in_n_ring_slots);
+
+    m_thread = std::thread(&Anvil::SubmitThread::thread_main,
+                           this);
+}
+
+/** Please see header for specification */
+Anvil::SubmitThread::~SubmitThread()
+{
+    m_should_quit.store(true);
+
+    {
+        std::unique_lock<std::mutex> lock(m_wake_mutex);
+
+        m_wake_cv.notify_one();
+    }
+
+    if (m_thread.joinable() )
+    {
+        m_thread.join();
+    }
+}
+
+/** Reserves the next ring slot for writing. Blocks if the ring is full.
+ *
+ *  @param out_ticket_ptr Deref will be set to the ticket associated with the slot. Must not be null.
+ *
+ *  @return Slot to write the operation to.
+ */
+Anvil::SubmitThread::Slot* Anvil::SubmitThread::acquire_slot(uint64_t* out_ticket_ptr)
+{
+    uint64_t pos        = m_enqueue_pos.load(std::memory_order_relaxed);
+    Slot*    result_ptr = nullptr;
+
+    while (true)
+    {
+        result_ptr = &m_ring.at(static_cast<size_t>(pos & m_ring_mask) );
+
+        const uint64_t sequence = result_ptr->sequence.load(std::memory_order_acquire);
+        const int64_t  diff     = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+
+        if (diff == 0)
+        {
+            if (m_enqueue_pos.compare_exchange_weak(pos,
+                                                    pos + 1,
+                                                    std::memory_order_relaxed) )
+            {
+                break;
+            }
+        }
+        else
+        {
+            if (diff < 0)
+            {
+                /* The ring is full. Block until the submit thread issues the operation which occupies the slot.
+                 * Slots are handed back before the issued ticket counter is updated, so the slot is free
+                 * once wait() returns. */
+                wait(pos - m_ring_mask);
+            }
+
+            pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    *out_ticket_ptr = pos + 1;
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+Anvil::SubmitThreadUniquePtr Anvil::SubmitThread::create(Anvil::Queue* in_queue_ptr,
+                                                         uint32_t      in_n_ring_slots)
+{
+    Anvil::SubmitThreadUniquePtr result_ptr(nullptr,
+                                            std::default_delete<Anvil::SubmitThread>() );
+
+    anvil_assert(in_queue_ptr != nullptr);
+
+    if (in_n_ring_slots == 0                       ||
+        (in_n_ring_slots & (in_n_ring_slots - 1)) != 0)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    result_ptr.reset(
+        new Anvil::SubmitThread(in_queue_ptr,
+                                in_n_ring_slots)
+    );
+
+end:
+    return result_ptr;
+}
+
+/** Issues a presentation request stored in the specified slot. */
+void Anvil::SubmitThread::issue_present(const Slot& in_slot)
+{
+    Anvil::SwapchainOperationErrorCode present_result = Anvil::SwapchainOperationErrorCode::DEVICE_LOST;
+    const uint32_t                     n_semaphores   = static_cast<uint32_t>(in_slot.wait_semaphores_sgpu.size() );
+
+    if (!m_queue_ptr->present(in_slot.swapchain_ptr,
+                              in_slot.swapchain_image_index,
+                              n_semaphores,
+                              (n_semaphores > 0) ? &in_slot.wait_semaphores_sgpu.at(0) : nullptr,
+                             &present_result) )
+    {
+        m_n_failed_operations.fetch_add(1);
+    }
+
+    m_last_present_result.store(present_result);
+}
+
+/** Issues all submissions stored in the specified slots with a single Queue::submit() call.
+ *
+ *  Only the last slot may specify a fence.
+ */
+void Anvil::SubmitThread::issue_submissions(uint32_t     in_n_slots,
+                                            Slot* const* in_slot_ptrs)
+{
+    m_batch_submit_infos.clear    ();
+    m_batch_submit_info_ptrs.clear();
+
+    for (uint32_t n_slot = 0;
+                  n_slot < in_n_slots;
+                ++n_slot)
+    {
+        const Slot&    current_slot        = *in_slot_ptrs[n_slot];
+        const uint32_t n_signal_semaphores = static_cast<uint32_t>((current_slot.submission_type == Anvil::SubmissionType::SGPU) ? current_slot.signal_semaphores_sgpu.size()
+                                                                                                                                 : current_slot.signal_semaphores_mgpu.size() );
+        const uint32_t n_wait_semaphores   = static_cast<uint32_t>(current_slot.dst_stage_wait_masks.size() );
+
+        anvil_assert(current_slot.fence_ptr == nullptr ||
+                     n_slot                 == in_n_slots - 1);
+
+        if (current_slot.submission_type == Anvil::SubmissionType::SGPU)
+        {
+            m_batch_submit_infos.push_back(
+                Anvil::SubmitInfo(static_cast<uint32_t>(current_slot.cmd_buffers_sgpu.size() ),
+                                  nullptr, /* in_opt_single_cmd_buffer_ptr */
+                                  current_slot.cmd_buffers_sgpu.data      (),
+                                  n_signal_semaphores,
+                                  current_slot.signal_semaphores_sgpu.data(),
+                                  n_wait_semaphores,
+                                  current_slot.wait_semaphores_sgpu.data  (),
+                                  current_slot.dst_stage_wait_masks.data  (),
+                                  false, /* in_should_block */
+                                  current_slot.fence_ptr)
+            );
+        }
+        else
+        {
+            m_batch_submit_infos.push_back(
+                Anvil::SubmitInfo(static_cast<uint32_t>(current_slot.cmd_buffers_mgpu.size() ),
+                                  current_slot.cmd_buffers_mgpu.data      (),
+                                  n_signal_semaphores,
+                                  current_slot.signal_semaphores_mgpu.data(),
+                                  n_wait_semaphores,
+                                  current_slot.wait_semaphores_mgpu.data  (),
+                                  current_slot.dst_stage_wait_masks.data  (),
+                                  false, /* in_should_block */
+                                  current_slot.fence_ptr)
+            );
+        }
+
+        m_batch_submit_infos.back().set_protected_submission(current_slot.is_protected);
+
+        if (current_slot.has_timeline_semaphore_values)
+        {
+            m_batch_submit_infos.back().set_timeline_semaphore_values((current_slot.timeline_signal_semaphore_values.size() > 0) ? &current_slot.timeline_signal_semaphore_values.at(0) : nullptr,
+                                                                      n_signal_semaphores,
+                                                                      (current_slot.timeline_wait_semaphore_values.size()   > 0) ? &current_slot.timeline_wait_semaphore_values.at(0)   : nullptr,
+                                                                      n_wait_semaphores);
+        }
+    }
+
+    /* NOTE: The vector has been reserved for the maximum batch size at creation time, so the ptrs below stay valid. */
+    for (const auto& current_submit_info : m_batch_submit_infos)
+    {
+        m_batch_submit_info_ptrs.push_back(&current_submit_info);
+    }
+
+    if (!m_queue_ptr->submit(in_n_slots,
+                            &m_batch_submit_info_ptrs.at(0) ))
+    {
+        m_n_failed_operations.fetch_add(in_n_slots);
+    }
+}
+
+/** Please see header for specification */
+uint64_t Anvil::SubmitThread::present(Anvil::Swapchain*        in_swapchain_ptr,
+                                      uint32_t                 in_swapchain_image_index,
+                                      uint32_t                 in_n_wait_semaphores,
+                                      Anvil::Semaphore* const* in_wait_semaphore_ptrs_ptr)
+{
+    uint64_t ticket   = 0;
+    Slot*    slot_ptr = acquire_slot(&ticket);
+
+    anvil_assert(in_swapchain_ptr != nullptr);
+    anvil_assert(in_n_wait_semaphores       == 0 ||
+                 in_wait_semaphore_ptrs_ptr != nullptr);
+
+    slot_ptr->swapchain_image_index = in_swapchain_image_index;
+    slot_ptr->swapchain_ptr         = in_swapchain_ptr;
+    slot_ptr->type                  = OperationType::PRESENT;
+
+    slot_ptr->wait_semaphores_sgpu.assign(in_wait_semaphore_ptrs_ptr,
+                                          in_wait_semaphore_ptrs_ptr + in_n_wait_semaphores);
+
+    publish_slot(slot_ptr,
+                 ticket);
+
+    return ticket;
+}
+
+/** Makes a slot previously returned by acquire_slot() visible to the submit thread, and wakes the thread up
+ *  if it is asleep.
+ */
+void Anvil::SubmitThread::publish_slot(Slot*    in_slot_ptr,
+                                       uint64_t in_ticket)
+{
+    /* NOTE: Both the store below and the sleep flag load need to be sequentially consistent. Otherwise, the load
+     *       could be satisfied before the store becomes visible, and the submit thread could go to sleep
+     *       on a slot which has already been published, without anyone waking it up.
+     */
+    in_slot_ptr->sequence.store(in_ticket);
+
+    if (m_is_thread_sleeping.load() )
+    {
+        std::unique_lock<std::mutex> lock(m_wake_mutex);
+
+        m_wake_cv.notify_one();
+    }
+}
+
+/** Please see header for specification */
+uint64_t Anvil::SubmitThread::submit(const Anvil::SubmitInfo& in_submit_info)
+{
+    const uint32_t n_cmd_buffers       = in_submit_info.get_n_command_buffers  ();
+    const uint32_t n_signal_semaphores = in_submit_info.get_n_signal_semaphores();
+    const uint32_t n_wait_semaphores   = in_submit_info.get_n_wait_semaphores  ();
+    uint64_t       ticket              = 0;
+    Slot*          slot_ptr            = nullptr;
+
+    anvil_assert(!in_submit_info.get_should_block() );
+
+    #if defined(_WIN32)
+    {
+        const uint64_t* d3d12_fence_signal_semaphore_values_ptr = nullptr;
+        const uint64_t* d3d12_fence_wait_semaphore_values_ptr   = nullptr;
+
+        anvil_assert(!in_submit_info.get_d3d12_fence_semaphore_values(&d3d12_fence_signal_semaphore_values_ptr,
+                                                                      &d3d12_fence_wait_semaphore_values_ptr) );
+    }
+    #endif
+
+    slot_ptr = acquire_slot(&ticket);
+
+    slot_ptr->fence_ptr       = in_submit_info.get_fence();
+    slot_ptr->is_protected    = in_submit_info.is_protected_submission();
+    slot_ptr->submission_type = in_submit_info.get_type();
+    slot_ptr->type            = OperationType::SUBMIT;
+
+    slot_ptr->cmd_buffers_mgpu.clear      ();
+    slot_ptr->cmd_buffers_sgpu.clear      ();
+    slot_ptr->signal_semaphores_mgpu.clear();
+    slot_ptr->signal_semaphores_sgpu.clear();
+    slot_ptr->wait_semaphores_mgpu.clear  ();
+    slot_ptr->wait_semaphores_sgpu.clear  ();
+
+    if (in_submit_info.get_type() == Anvil::SubmissionType::SGPU)
+    {
+        slot_ptr->cmd_buffers_sgpu.assign      (in_submit_info.get_command_buffers_sgpu(),
+                                                in_submit_info.get_command_buffers_sgpu() + n_cmd_buffers);
+        slot_ptr->signal_semaphores_sgpu.assign(in_submit_info.get_signal_semaphores_sgpu(),
+                                                in_submit_info.get_signal_semaphores_sgpu() + n_signal_semaphores);
+        slot_ptr->wait_semaphores_sgpu.assign  (in_submit_info.get_wait_semaphores_sgpu(),
+                                                in_submit_info.get_wait_semaphores_sgpu() + n_wait_semaphores);
+    }
+    else
+    {
+        slot_ptr->cmd_buffers_mgpu.assign      (in_submit_info.get_command_buffers_mgpu(),
+                                                in_submit_info.get_command_buffers_mgpu() + n_cmd_buffers);
+        slot_ptr->signal_semaphores_mgpu.assign(in_submit_info.get_signal_semaphores_mgpu(),
+                                                in_submit_info.get_signal_semaphores_mgpu() + n_signal_semaphores);
+        slot_ptr->wait_semaphores_mgpu.assign  (in_submit_info.get_wait_semaphores_mgpu(),
+                                                in_submit_info.get_wait_semaphores_mgpu() + n_wait_semaphores);
+    }
+
+    slot_ptr->dst_stage_wait_masks.clear();
+
+    for (uint32_t n_wait_semaphore = 0;
+                  n_wait_semaphore < n_wait_semaphores;
+                ++n_wait_semaphore)
+    {
+        slot_ptr->dst_stage_wait_masks.push_back(
+            static_cast<Anvil::PipelineStageFlagBits>(in_submit_info.get_destination_stage_wait_masks()[n_wait_semaphore])
+        );
+    }
+
+    {
+        const uint64_t* timeline_signal_semaphore_values_ptr = nullptr;
+        const uint64_t* timeline_wait_semaphore_values_ptr   = nullptr;
+
+        slot_ptr->has_timeline_semaphore_values = in_submit_info.get_timeline_semaphore_values(&timeline_signal_semaphore_values_ptr,
+                                                                                               &timeline_wait_semaphore_values_ptr);
+
+        slot_ptr->timeline_signal_semaphore_values.clear();
+        slot_ptr->timeline_wait_semaphore_values.clear  ();
+
+        if (timeline_signal_semaphore_values_ptr != nullptr)
+        {
+            slot_ptr->timeline_signal_semaphore_values.assign(timeline_signal_semaphore_values_ptr,
+                                                              timeline_signal_semaphore_values_ptr + n_signal_semaphores);
+        }
+
+        if (timeline_wait_semaphore_values_ptr != nullptr)
+        {
+            slot_ptr->timeline_wait_semaphore_values.assign(timeline_wait_semaphore_values_ptr,
+                                                            timeline_wait_semaphore_values_ptr + n_wait_semaphores);
+        }
+    }
+
+    publish_slot(slot_ptr,
+                 ticket);
+
+    return ticket;
+}
+
+/** Entry point of the submit thread. Picks up all published slots, issues their operations in order, and
+ *  goes to sleep when the ring is empty.
+ */
+void Anvil::SubmitThread::thread_main()
+{
+    const uint32_t n_ring_slots = static_cast<uint32_t>(m_ring.size() );
+
+    while (true)
+    {
+        uint32_t n_ready_slots = 0;
+
+        /* Gather all consecutive slots which have been published so far. A slot that is still being written to
+         * stops the scan, so that operations are issued in ticket order. */
+        while (n_ready_slots < n_ring_slots)
+        {
+            const uint64_t pos      = m_dequeue_pos + n_ready_slots;
+            Slot*          slot_ptr = &m_ring.at(static_cast<size_t>(pos & m_ring_mask) );
+
+            if (slot_ptr->sequence.load(std::memory_order_acquire) != pos + 1)
+            {
+                break;
+            }
+
+            m_batch_slot_ptrs.at(n_ready_slots++) = slot_ptr;
+        }
+
+        if (n_ready_slots == 0)
+        {
+            std::unique_lock<std::mutex> lock(m_wake_mutex);
+
+            if (m_should_quit.load() )
+            {
+                break;
+            }
+
+            m_is_thread_sleeping.store(true);
+
+            /* Must be a sequentially consistent load. Please see publish_slot() for details. */
+            if (m_ring.at(static_cast<size_t>(m_dequeue_pos & m_ring_mask) ).sequence.load() != m_dequeue_pos + 1)
+            {
+                m_wake_cv.wait(lock);
+            }
+
+            m_is_thread_sleeping.store(false);
+
+            continue;
+        }
+
+        /* Issue the operations. Consecutive submissions are coalesced, as long as only the last one in a batch
+         * uses a fence. */
+        for (uint32_t n_slot = 0;
+                      n_slot < n_ready_slots;
+                     )
+        {
+            if (m_batch_slot_ptrs.at(n_slot)->type == OperationType::PRESENT)
+            {
+                issue_present(*m_batch_slot_ptrs.at(n_slot) );
+
+                ++n_slot;
+            }
+            else
+            {
+                uint32_t n_last_slot = n_slot;
+
+                anvil_assert(m_batch_slot_ptrs.at(n_slot)->type == OperationType::SUBMIT);
+
+                while (n_last_slot < n_ready_slots                                       &&
+                       m_batch_slot_ptrs.at(n_last_slot)->type == OperationType::SUBMIT)
+                {
+                    if (m_batch_slot_ptrs.at(n_last_slot++)->fence_ptr != nullptr)
+                    {
+                        break;
+                    }
+                }
+
+                issue_submissions(n_last_slot - n_slot,
+                                 &m_batch_slot_ptrs.at(n_slot) );
+
+                n_slot = n_last_slot;
+            }
+        }
+
+        /* Hand the slots back to producers. */
+        for (uint32_t n_slot = 0;
+                      n_slot < n_ready_slots;
+                    ++n_slot)
+        {
+            m_batch_slot_ptrs.at(n_slot)->sequence.store(m_dequeue_pos + n_slot + n_ring_slots,
+                                                         std::memory_order_release);
+        }
+
+        m_dequeue_pos += n_ready_slots;
+
+        {
+            std::unique_lock<std::mutex> lock(m_issued_mutex);
+
+            m_n_issued_tickets.store(m_dequeue_pos);
+        }
+
+        m_issued_cv.notify_all();
+    }
+}
+
+/** Please see header for specification */
+void Anvil::SubmitThread::wait(uint64_t in_ticket)
+{
+    std::unique_lock<std::mutex> lock(m_issued_mutex);
+
+    m_issued_cv.wait(lock,
+                     [this, in_ticket]()
+                     {
+                         return m_n_issued_tickets.load() >= in_ticket;
+                     });
+}
+
+/** Please see header for specification */
+void Anvil::SubmitThread::wait_idle()
+{
+    wait(m_enqueue_pos.load() );
+}
@@ -20,7 +20,12 @@
 // THE SOFTWARE.
 //
 
+#include "misc/debug.h"
 #include "misc/swapchain_create_info.h"
+#include "misc/window.h"
+#include "wrappers/device.h"
+#include "wrappers/rendering_surface.h"
+#include <algorithm>
 
 
 Anvil::SwapchainCreateInfoUniquePtr Anvil::SwapchainCreateInfo::create(Anvil::BaseDevice*       in_device_ptr,
@@ -56,6 +61,233 @@ Anvil::SwapchainCreateInfoUniquePtr Anvil::SwapchainCreateInfo::create(Anvil::Ba
     return result_ptr;
 }
 
+/** Please see header for specification */
+Anvil::SwapchainCreateInfoUniquePtr Anvil::SwapchainCreateInfo::create_for_present_policy(Anvil::BaseDevice*            in_device_ptr,
+                                                                                          Anvil::RenderingSurface*      in_parent_surface_ptr,
+                                                                                          Anvil::Window*                in_window_ptr,
+                                                                                          Anvil::Format                 in_format,
+                                                                                          Anvil::ColorSpaceKHR          in_color_space,
+                                                                                          Anvil::ImageUsageFlags        in_usage_flags,
+                                                                                          Anvil::SwapchainPresentPolicy in_present_policy,
+                                                                                          const bool&                   in_clipped,
+                                                                                          const Anvil::Swapchain*       in_opt_old_swapchain_ptr)
+{
+    static const Anvil::PresentModeKHR low_latency_present_modes[] =
+    {
+        Anvil::PresentModeKHR::MAILBOX_KHR,
+        Anvil::PresentModeKHR::IMMEDIATE_KHR,
+        Anvil::PresentModeKHR::FIFO_RELAXED_KHR,
+        Anvil::PresentModeKHR::FIFO_KHR
+    };
+    static const Anvil::PresentModeKHR max_throughput_present_modes[] =
+    {
+        Anvil::PresentModeKHR::IMMEDIATE_KHR,
+        Anvil::PresentModeKHR::MAILBOX_KHR,
+        Anvil::PresentModeKHR::FIFO_RELAXED_KHR,
+        Anvil::PresentModeKHR::FIFO_KHR
+    };
+    static const Anvil::PresentModeKHR power_saving_present_modes[] =
+    {
+        Anvil::PresentModeKHR::FIFO_KHR
+    };
+
+    const Anvil::PresentModeKHR*              candidate_present_modes_ptr = nullptr;
+    uint32_t                                  max_image_count             = UINT32_MAX;
+    uint32_t                                  min_image_count             = 1;
+    uint32_t                                  n_candidate_present_modes   = 0;
+    uint32_t                                  n_frames_in_flight          = 1;
+    uint32_t                                  n_images                    = 0;
+    std::vector<const Anvil::PhysicalDevice*> physical_device_ptrs;
+    Anvil::PresentModeKHR                     present_mode                = Anvil::PresentModeKHR::UNKNOWN;
+    SwapchainCreateInfoUniquePtr              result_ptr                  (nullptr,
+                                                                           std::default_delete<Anvil::SwapchainCreateInfo>() );
+
+    anvil_assert(in_device_ptr         != nullptr);
+    anvil_assert(in_parent_surface_ptr != nullptr);
+
+    switch (in_device_ptr->get_type() )
+    {
+        case Anvil::DeviceType::MULTI_GPU:
+        {
+            const Anvil::MGPUDevice* mgpu_device_ptr(dynamic_cast<const Anvil::MGPUDevice*>(in_device_ptr) );
+
+            for (uint32_t n_physical_device = 0;
+                          n_physical_device < mgpu_device_ptr->get_n_physical_devices();
+                        ++n_physical_device)
+            {
+                physical_device_ptrs.push_back(mgpu_device_ptr->get_physical_device(n_physical_device) );
+            }
+
+            break;
+        }
+
+        case Anvil::DeviceType::SINGLE_GPU:
+        {
+            const Anvil::SGPUDevice* sgpu_device_ptr(dynamic_cast<const Anvil::SGPUDevice*>(in_device_ptr) );
+
+            physical_device_ptrs.push_back(sgpu_device_ptr->get_physical_device() );
+
+            break;
+        }
+
+        default:
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    /* The image count must work for all physical devices */
+    for (const auto& current_physical_device_ptr : physical_device_ptrs)
+    {
+        Anvil::SurfaceCapabilities surface_caps;
+
+        if (!in_parent_surface_ptr->get_capabilities(current_physical_device_ptr,
+                                                     &surface_caps) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        min_image_count = std::max(min_image_count,
+                                   surface_caps.min_image_count);
+
+        /* A max image count of 0 means there is no limit */
+        if (surface_caps.max_image_count != 0)
+        {
+            max_image_count = std::min(max_image_count,
+                                       surface_caps.max_image_count);
+        }
+    }
+
+    switch (in_present_policy)
+    {
+        case Anvil::SwapchainPresentPolicy::LOW_LATENCY:
+        {
+            candidate_present_modes_ptr = low_latency_present_modes;
+            n_candidate_present_modes   = sizeof(low_latency_present_modes) / sizeof(low_latency_present_modes[0]);
+
+            break;
+        }
+
+        case Anvil::SwapchainPresentPolicy::MAX_THROUGHPUT:
+        {
+            candidate_present_modes_ptr = max_throughput_present_modes;
+            n_candidate_present_modes   = sizeof(max_throughput_present_modes) / sizeof(max_throughput_present_modes[0]);
+
+            break;
+        }
+
+        case Anvil::SwapchainPresentPolicy::POWER_SAVING:
+        {
+            candidate_present_modes_ptr = power_saving_present_modes;
+            n_candidate_present_modes   = sizeof(power_saving_present_modes) / sizeof(power_saving_present_modes[0]);
+
+            break;
+        }
+
+        default:
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    /* Pick the first candidate mode supported by all physical devices. */
+    for (uint32_t n_candidate_present_mode = 0;
+                  n_candidate_present_mode < n_candidate_present_modes && present_mode == Anvil::PresentModeKHR::UNKNOWN;
+                ++n_candidate_present_mode)
+    {
+        bool is_supported = true;
+
+        for (const auto& current_physical_device_ptr : physical_device_ptrs)
+        {
+            bool is_supported_by_physical_device = false;
+
+            if (!in_parent_surface_ptr->supports_presentation_mode(current_physical_device_ptr,
+                                                                   candidate_present_modes_ptr[n_candidate_present_mode],
+                                                                   &is_supported_by_physical_device) ||
+                !is_supported_by_physical_device)
+            {
+                is_supported = false;
+
+                break;
+            }
+        }
+
+        if (is_supported)
+        {
+            present_mode = candidate_present_modes_ptr[n_candidate_present_mode];
+        }
+    }
+
+    if (present_mode == Anvil::PresentModeKHR::UNKNOWN)
+    {
+        /* FIFO support is guaranteed by the spec */
+        present_mode = Anvil::PresentModeKHR::FIFO_KHR;
+    }
+
+    switch (in_present_policy)
+    {
+        case Anvil::SwapchainPresentPolicy::LOW_LATENCY:
+        {
+            /* MAILBOX needs a spare image, so that rendering never blocks on the image being scanned out. */
+            n_images           = (present_mode == Anvil::PresentModeKHR::MAILBOX_KHR) ? 3 : 2;
+            n_frames_in_flight = 1;
+
+            break;
+        }
+
+        case Anvil::SwapchainPresentPolicy::MAX_THROUGHPUT:
+        {
+            n_images           = std::max(3u,
+                                          min_image_count + 1);
+            n_frames_in_flight = UINT32_MAX;
+
+            break;
+        }
+
+        case Anvil::SwapchainPresentPolicy::POWER_SAVING:
+        {
+            n_images           = 2;
+            n_frames_in_flight = 1;
+
+            break;
+        }
+
+        default:
+        {
+            anvil_assert_fail();
+        }
+    }
+
+    n_images           = std::min(std::max(n_images,
+                                           min_image_count),
+                                  max_image_count);
+    n_frames_in_flight = std::min(n_frames_in_flight,
+                                  (n_images > 1) ? n_images - 1 : 1);
+
+    result_ptr = Anvil::SwapchainCreateInfo::create(in_device_ptr,
+                                                    in_parent_surface_ptr,
+                                                    in_window_ptr,
+                                                    in_format,
+                                                    in_color_space,
+                                                    present_mode,
+                                                    in_usage_flags,
+                                                    n_images,
+                                                    in_clipped,
+                                                    in_opt_old_swapchain_ptr);
+
+    result_ptr->m_n_frames_in_flight = n_frames_in_flight;
+    result_ptr->m_present_policy     = in_present_policy;
+
+end:
+    return result_ptr;
+}
+
 Anvil::SwapchainCreateInfo::SwapchainCreateInfo(Anvil::BaseDevice*                 in_device_ptr,
                                                 Anvil::RenderingSurface*           in_parent_surface_ptr,
                                                 Anvil::Window*                     in_window_ptr,
@@ -76,10 +308,12 @@ Anvil::SwapchainCreateInfo::SwapchainCreateInfo(Anvil::BaseDevice*
      m_format                 (in_format),
      m_mgpu_present_mode_flags(in_mgpu_present_mode_flags),
      m_mt_safety              (in_mt_safety),
+     m_n_frames_in_flight     ((in_n_images > 1) ? in_n_images - 1 : 1),
      m_n_images               (in_n_images),
      m_old_swapchain_ptr      (in_opt_old_swapchain_ptr),
      m_parent_surface_ptr     (in_parent_surface_ptr),
      m_present_mode           (in_present_mode),
+     m_present_policy         (Anvil::SwapchainPresentPolicy::UNKNOWN),
      m_usage_flags            (in_usage_flags),
      m_window_ptr             (in_window_ptr)
 {
@@ -88,6 +322,59 @@ Anvil::SwapchainCreateInfo::SwapchainCreateInfo(Anvil::BaseDevice*
     anvil_assert(in_usage_flags        != 0);
 }
 
+/** Please see header for specification */
+bool Anvil::SwapchainCreateInfo::request_storage_usage()
+{
+    const bool is_offscreen = (m_window_ptr                 != nullptr                                  &&
+                              (m_window_ptr->get_platform() == WINDOW_PLATFORM_DUMMY                     ||
+                               m_window_ptr->get_platform() == WINDOW_PLATFORM_DUMMY_WITH_PNG_SNAPSHOTS) );
+    bool       result       = false;
+
+    anvil_assert(m_device_ptr != nullptr);
+
+    if ((m_usage_flags & Anvil::ImageUsageFlagBits::STORAGE_BIT) != 0)
+    {
+        result = true;
+
+        goto end;
+    }
+
+    if (!is_offscreen)
+    {
+        Anvil::SurfaceCapabilities surface_caps;
+
+        anvil_assert(m_parent_surface_ptr != nullptr);
+
+        if (!m_device_ptr->get_physical_device_surface_capabilities(m_parent_surface_ptr,
+                                                                   &surface_caps) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        if ((surface_caps.supported_usage_flags & Anvil::ImageUsageFlagBits::STORAGE_BIT) == 0)
+        {
+            goto end;
+        }
+    }
+
+    {
+        const Anvil::FormatProperties format_props = m_device_ptr->get_physical_device_format_properties(m_format);
+
+        if ((format_props.optimal_tiling_capabilities & Anvil::FormatFeatureFlagBits::STORAGE_IMAGE_BIT) == 0)
+        {
+            goto end;
+        }
+    }
+
+    m_usage_flags |= Anvil::ImageUsageFlagBits::STORAGE_BIT;
+    result         = true;
+
+end:
+    return result;
+}
+
 void Anvil::SwapchainCreateInfo::set_view_format_list(const Anvil::Format* in_compatible_formats_ptr,
                                                       const uint32_t&      in_n_compatible_formats)
 {
@@ -0,0 +1,392 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "misc/debug.h"
+#include "misc/task_scheduler.h"
+#include <algorithm>
+#include <chrono>
+
+
+namespace
+{
+    /* Identifies the scheduler & worker the calling thread belongs to, if any. */
+    thread_local const Anvil::WorkStealingTaskScheduler* t_scheduler_ptr = nullptr;
+    thread_local uint32_t                                t_n_worker      = 0;
+}
+
+
+/** Please see header for specification */
+Anvil::TaskWaitGroup::TaskWaitGroup()
+    :m_n_pending_tasks(0)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+void Anvil::TaskWaitGroup::add(const uint32_t& in_n_tasks)
+{
+    m_n_pending_tasks.fetch_add(in_n_tasks);
+}
+
+/** Please see header for specification */
+void Anvil::TaskWaitGroup::done()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    anvil_assert(m_n_pending_tasks.load() > 0);
+
+    if (m_n_pending_tasks.fetch_sub(1) == 1)
+    {
+        m_done_cv.notify_all();
+    }
+}
+
+/** Please see header for specification */
+bool Anvil::TaskWaitGroup::is_done() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    return (m_n_pending_tasks.load() == 0);
+}
+
+/** Please see header for specification */
+void Anvil::TaskWaitGroup::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_done_cv.wait(lock,
+                   [this]()
+                   {
+                       return (m_n_pending_tasks.load() == 0);
+                   });
+}
+
+/** Please see header for specification */
+bool Anvil::TaskWaitGroup::wait_for(const uint64_t& in_timeout_ns)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    return m_done_cv.wait_for(lock,
+                              std::chrono::nanoseconds(in_timeout_ns),
+                              [this]()
+                              {
+                                  return (m_n_pending_tasks.load() == 0);
+                              });
+}
+
+
+/** Please see header for specification */
+void Anvil::TaskScheduler::parallel_for(const uint32_t&  in_n_items,
+                                        const uint32_t&  in_min_items_per_task,
+                                        const RangeTask& in_task)
+{
+    const uint32_t min_items_per_task = std::max(in_min_items_per_task, 1u);
+    const uint32_t n_threads          = get_n_workers() + 1; /* The calling thread helps out */
+    uint32_t       n_items_per_task;
+    TaskWaitGroup  wait_group;
+
+    if (in_n_items == 0)
+    {
+        goto end;
+    }
+
+    /* Over-split by a small factor, so that threads which finish early can pick up remaining chunks. */
+    n_items_per_task = std::max(min_items_per_task,
+                                (in_n_items + n_threads * 4 - 1) / (n_threads * 4) );
+
+    if (n_items_per_task >= in_n_items)
+    {
+        in_task(0,
+                in_n_items);
+
+        goto end;
+    }
+
+    for (uint32_t n_first_item  = n_items_per_task;
+                  n_first_item  < in_n_items;
+                  n_first_item += n_items_per_task)
+    {
+        const uint32_t n_items = std::min(n_items_per_task,
+                                          in_n_items - n_first_item);
+
+        submit([&in_task, n_first_item, n_items]()
+               {
+                   in_task(n_first_item,
+                           n_items);
+               },
+               &wait_group);
+    }
+
+    in_task(0,
+            n_items_per_task);
+
+    wait(&wait_group);
+
+end:
+    ;
+}
+
+/** Please see header for specification */
+void Anvil::TaskScheduler::wait(TaskWaitGroup* in_wait_group_ptr)
+{
+    anvil_assert(in_wait_group_ptr != nullptr);
+
+    /* NOTE: is_done() takes the wait group's mutex, so that the group (which usually lives on the caller's stack)
+     *       is not released while the worker which finished the last task is still notifying it.
+     */
+    while (!in_wait_group_ptr->is_done() )
+    {
+        if (!try_run_pending_task() )
+        {
+            /* Nothing to help out with. Outstanding tasks are running on other threads, but they might still
+             * spawn new tasks, so wake up periodically to check. */
+            in_wait_group_ptr->wait_for(1000000); /* 1 ms */
+        }
+    }
+}
+
+
+/** Please see header for specification */
+Anvil::WorkStealingTaskScheduler::WorkStealingTaskScheduler(const uint32_t& in_n_workers)
+    :m_n_next_worker (0),
+     m_n_queued_tasks(0),
+     m_should_stop   (false)
+{
+    for (uint32_t n_worker = 0;
+                  n_worker < in_n_workers;
+                ++n_worker)
+    {
+        m_workers.push_back(
+            std::unique_ptr<Worker>(new Worker() )
+        );
+    }
+
+    for (uint32_t n_worker = 0;
+                  n_worker < in_n_workers;
+                ++n_worker)
+    {
+        m_workers.at(n_worker)->thread = std::thread(&WorkStealingTaskScheduler::worker_thread,
+                                                     this,
+                                                     n_worker);
+    }
+}
+
+/** Please see header for specification */
+Anvil::WorkStealingTaskScheduler::~WorkStealingTaskScheduler()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_wake_mutex);
+
+        m_should_stop = true;
+
+        m_wake_cv.notify_all();
+    }
+
+    for (auto& current_worker_ptr : m_workers)
+    {
+        if (current_worker_ptr->thread.joinable() )
+        {
+            current_worker_ptr->thread.join();
+        }
+    }
+
+    /* Release anyone waiting for tasks which never got to run. */
+    for (auto& current_worker_ptr : m_workers)
+    {
+        for (auto& current_task : current_worker_ptr->tasks)
+        {
+            if (current_task.wait_group_ptr != nullptr)
+            {
+                current_task.wait_group_ptr->done();
+            }
+        }
+    }
+}
+
+/** Please see header for specification */
+Anvil::WorkStealingTaskSchedulerUniquePtr Anvil::WorkStealingTaskScheduler::create(const uint32_t& in_n_workers)
+{
+    uint32_t                                  n_workers = in_n_workers;
+    Anvil::WorkStealingTaskSchedulerUniquePtr result_ptr(nullptr,
+                                                         std::default_delete<Anvil::WorkStealingTaskScheduler>() );
+
+    if (n_workers == 0)
+    {
+        n_workers = std::max(std::thread::hardware_concurrency(),
+                             1u);
+    }
+
+    result_ptr.reset(
+        new Anvil::WorkStealingTaskScheduler(n_workers)
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+void Anvil::WorkStealingTaskScheduler::execute(QueuedTask& in_task)
+{
+    in_task.task();
+
+    if (in_task.wait_group_ptr != nullptr)
+    {
+        in_task.wait_group_ptr->done();
+    }
+}
+
+/** Please see header for specification */
+bool Anvil::WorkStealingTaskScheduler::pop_task(const uint32_t& in_n_preferred_worker,
+                                                QueuedTask*     out_task_ptr)
+{
+    const bool     is_own_worker = (t_scheduler_ptr == this);
+    const uint32_t n_workers     = static_cast<uint32_t>(m_workers.size() );
+    bool           result        = false;
+
+    if (m_n_queued_tasks.load() == 0)
+    {
+        goto end;
+    }
+
+    for (uint32_t n_attempt = 0;
+                  n_attempt < n_workers && !result;
+                ++n_attempt)
+    {
+        Worker*                      worker_ptr = m_workers.at( (in_n_preferred_worker + n_attempt) % n_workers).get();
+        std::unique_lock<std::mutex> lock      (worker_ptr->mutex);
+
+        if (worker_ptr->tasks.empty() )
+        {
+            continue;
+        }
+
+        /* Workers process their own deque in LIFO order, which keeps nested tasks cache-hot. Everyone else steals
+         * the oldest task. */
+        if (n_attempt == 0 && is_own_worker)
+        {
+            *out_task_ptr = std::move(worker_ptr->tasks.back() );
+
+            worker_ptr->tasks.pop_back();
+        }
+        else
+        {
+            *out_task_ptr = std::move(worker_ptr->tasks.front() );
+
+            worker_ptr->tasks.pop_front();
+        }
+
+        m_n_queued_tasks.fetch_sub(1);
+
+        result = true;
+    }
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::WorkStealingTaskScheduler::submit(const Task&    in_task,
+                                              TaskWaitGroup* in_opt_wait_group_ptr)
+{
+    const uint32_t n_worker = (t_scheduler_ptr == this) ? t_n_worker
+                                                        : (m_n_next_worker.fetch_add(1) % static_cast<uint32_t>(m_workers.size() ));
+    Worker*        worker_ptr = m_workers.at(n_worker).get();
+
+    anvil_assert(in_task != nullptr);
+
+    if (in_opt_wait_group_ptr != nullptr)
+    {
+        in_opt_wait_group_ptr->add();
+    }
+
+    /* Bump the counter first, so that it never drops below the actual number of queued tasks. */
+    m_n_queued_tasks.fetch_add(1);
+
+    {
+        std::unique_lock<std::mutex> lock(worker_ptr->mutex);
+
+        worker_ptr->tasks.push_back(QueuedTask(in_task,
+                                               in_opt_wait_group_ptr) );
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(m_wake_mutex);
+
+        m_wake_cv.notify_one();
+    }
+}
+
+/** Please see header for specification */
+bool Anvil::WorkStealingTaskScheduler::try_run_pending_task()
+{
+    const uint32_t n_preferred_worker = (t_scheduler_ptr == this) ? t_n_worker
+                                                                  : (m_n_next_worker.load() % static_cast<uint32_t>(m_workers.size() ));
+    bool           result             = false;
+    QueuedTask     task;
+
+    if (pop_task(n_preferred_worker,
+                &task) )
+    {
+        execute(task);
+
+        result = true;
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::WorkStealingTaskScheduler::worker_thread(uint32_t in_n_worker)
+{
+    t_scheduler_ptr = this;
+    t_n_worker      = in_n_worker;
+
+    while (true)
+    {
+        QueuedTask task;
+
+        if (pop_task(in_n_worker,
+                    &task) )
+        {
+            execute(task);
+
+            continue;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(m_wake_mutex);
+
+            m_wake_cv.wait(lock,
+                           [this]()
+                           {
+                               return m_should_stop.load() || m_n_queued_tasks.load() > 0;
+                           });
+
+            if (m_should_stop)
+            {
+                break;
+            }
+        }
+    }
+
+    t_scheduler_ptr = nullptr;
+}
@@ -0,0 +1,1734 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "misc/debug.h"
+#include "misc/formats.h"
+#include "misc/fp16.h"
+#include "misc/task_scheduler.h"
+#include "misc/texture_converter.h"
+#include "misc/types.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define ANVIL_TEXTURE_CONVERTER_HAS_SSE2
+
+    #include <emmintrin.h>
+#endif
+
+/* Minimum number of rows (or block rows) each conversion thread is assigned. Spawning threads for fewer rows
+ * costs more than it saves. */
+static const uint32_t g_min_n_rows_per_thread = 8;
+
+/* BC7 interpolation weights for 4-bit indices */
+static const uint32_t g_bc7_weights4[] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+
+enum class BlockFormat
+{
+    BC1,
+    BC1_ALPHA,
+    BC3,
+    BC7,
+
+    NONE
+};
+
+enum class ConversionPath
+{
+    /* Both formats are the same. Rows are copied. */
+    COPY,
+
+    /* 32-bit SFLOAT <-> 16-bit SFLOAT with the same component layout. */
+    FP16_TO_FP32,
+    FP32_TO_FP16,
+
+    /* 4x8-bit RGBA/BGRA formats, which only differ in ordering and/or UNORM vs SRGB encoding. */
+    LUT_8BIT,
+
+    /* 4x8-bit RGBA <-> BGRA formats of the same type. */
+    SWIZZLE_8BIT,
+
+    /* Texels are decoded to double-precision RGBA and re-encoded. */
+    GENERIC,
+};
+
+/* Describes where RGBA components of an uncompressed format are stored, and how they are encoded */
+typedef struct FormatLayout
+{
+    uint32_t          n_bits      [4];
+    uint32_t          n_bytes_per_texel;
+    uint32_t          n_components;
+    uint32_t          start_bit   [4];
+    Anvil::FormatType type;
+
+    FormatLayout()
+        :n_bytes_per_texel(0),
+         n_components     (0),
+         type             (Anvil::FormatType::UNKNOWN)
+    {
+        memset(n_bits,
+               0,
+               sizeof(n_bits) );
+        memset(start_bit,
+               0,
+               sizeof(start_bit) );
+    }
+} FormatLayout;
+
+/* Holds everything rows of a single conversion need */
+typedef struct ConversionContext
+{
+    FormatLayout   dst_layout;
+    uint8_t        lut[4][256];
+    ConversionPath path;
+    uint32_t       src_component_index_per_dst_component[4];
+    FormatLayout   src_layout;
+
+    ConversionContext()
+        :path(ConversionPath::GENERIC)
+    {
+        /* Stub */
+    }
+} ConversionContext;
+
+
+/** Returns the block format @param in_format corresponds to, or BlockFormat::NONE if the format is not a block format
+ *  the converter can encode to.
+ *
+ *  @param out_opt_is_srgb_ptr If not null, deref will be set to true if the format stores sRGB-encoded data.
+ */
+static BlockFormat get_block_format(Anvil::Format in_format,
+                                    bool*         out_opt_is_srgb_ptr = nullptr)
+{
+    BlockFormat result  = BlockFormat::NONE;
+    bool        is_srgb = false;
+
+    switch (in_format)
+    {
+        case Anvil::Format::BC1_RGB_SRGB_BLOCK:   is_srgb = true; /* fall-through */
+        case Anvil::Format::BC1_RGB_UNORM_BLOCK:  result  = BlockFormat::BC1;       break;
+        case Anvil::Format::BC1_RGBA_SRGB_BLOCK:  is_srgb = true; /* fall-through */
+        case Anvil::Format::BC1_RGBA_UNORM_BLOCK: result  = BlockFormat::BC1_ALPHA; break;
+        case Anvil::Format::BC3_SRGB_BLOCK:       is_srgb = true; /* fall-through */
+        case Anvil::Format::BC3_UNORM_BLOCK:      result  = BlockFormat::BC3;       break;
+        case Anvil::Format::BC7_SRGB_BLOCK:       is_srgb = true; /* fall-through */
+        case Anvil::Format::BC7_UNORM_BLOCK:      result  = BlockFormat::BC7;       break;
+
+        default:
+        {
+            /* Not a supported block format */
+        }
+    }
+
+    if (out_opt_is_srgb_ptr != nullptr)
+    {
+        *out_opt_is_srgb_ptr = is_srgb;
+    }
+
+    return result;
+}
+
+/** Retrieves RGBA bit layout of @param in_format from Anvil::Formats.
+ *
+ *  @return true if the converter can read and write texels of the format, false otherwise.
+ */
+static bool get_format_layout(Anvil::Format in_format,
+                              FormatLayout* out_layout_ptr)
+{
+    uint32_t end_bit       [4];
+    uint32_t n_total_bits  = 0;
+    uint32_t shared_start  = UINT32_MAX;
+    bool     result        = false;
+
+    if (in_format == Anvil::Format::UNKNOWN                   ||
+        Anvil::Formats::is_format_compressed(in_format)       ||
+        Anvil::Formats::is_format_yuv_khr   (in_format)       ||
+        Anvil::Formats::has_depth_aspect    (in_format)       ||
+        Anvil::Formats::has_stencil_aspect  (in_format) )
+    {
+        goto end;
+    }
+
+    out_layout_ptr->type = Anvil::Formats::get_format_type(in_format);
+
+    switch (out_layout_ptr->type)
+    {
+        case Anvil::FormatType::SFLOAT:
+        case Anvil::FormatType::SINT:
+        case Anvil::FormatType::SNORM:
+        case Anvil::FormatType::SRGB:
+        case Anvil::FormatType::SSCALED:
+        case Anvil::FormatType::UINT:
+        case Anvil::FormatType::UNORM:
+        case Anvil::FormatType::USCALED:
+        {
+            break;
+        }
+
+        default:
+        {
+            goto end;
+        }
+    }
+
+    Anvil::Formats::get_format_bit_layout_nonyuv(in_format,
+                                                &out_layout_ptr->start_bit[0],
+                                                &end_bit[0],
+                                                &out_layout_ptr->start_bit[1],
+                                                &end_bit[1],
+                                                &out_layout_ptr->start_bit[2],
+                                                &end_bit[2],
+                                                &out_layout_ptr->start_bit[3],
+                                                &end_bit[3],
+                                                &shared_start);
+
+    if (shared_start != UINT32_MAX)
+    {
+        /* Shared exponent formats are not supported */
+        goto end;
+    }
+
+    out_layout_ptr->n_components = 0;
+
+    for (uint32_t n_component = 0;
+                  n_component < 4;
+                ++n_component)
+    {
+        if (out_layout_ptr->start_bit[n_component] == UINT32_MAX)
+        {
+            out_layout_ptr->n_bits   [n_component] = 0;
+            out_layout_ptr->start_bit[n_component] = 0;
+
+            continue;
+        }
+
+        out_layout_ptr->n_bits[n_component] = end_bit[n_component] - out_layout_ptr->start_bit[n_component] + 1;
+        n_total_bits                       += out_layout_ptr->n_bits[n_component];
+
+        out_layout_ptr->n_components++;
+
+        if (out_layout_ptr->n_bits[n_component] > 32)
+        {
+            goto end;
+        }
+
+        if (out_layout_ptr->type                == Anvil::FormatType::SFLOAT &&
+            out_layout_ptr->n_bits[n_component] != 16                        &&
+            out_layout_ptr->n_bits[n_component] != 32)
+        {
+            goto end;
+        }
+    }
+
+    if (n_total_bits       == 0 ||
+        (n_total_bits % 8) != 0)
+    {
+        goto end;
+    }
+
+    out_layout_ptr->n_bytes_per_texel = n_total_bits / 8;
+    result                            = true;
+end:
+    return result;
+}
+
+/** Returns sRGB -> linear conversion table for 8-bit values. */
+static const float* get_srgb_to_linear_table()
+{
+    static const struct Table
+    {
+        float values[256];
+
+        Table()
+        {
+            for (uint32_t n_value = 0;
+                          n_value < 256;
+                        ++n_value)
+            {
+                const float srgb = static_cast<float>(n_value) / 255.0f;
+
+                values[n_value] = (srgb <= 0.04045f) ? srgb / 12.92f
+                                                     : powf( (srgb + 0.055f) / 1.055f, 2.4f);
+            }
+        }
+    } table;
+
+    return table.values;
+}
+
+/** Encodes a linear value in <0, 1> range to an 8-bit sRGB value. Rounds to the nearest representable value. */
+static uint8_t encode_srgb(double in_linear)
+{
+    /* Linear values at the midpoints between consecutive 8-bit sRGB values */
+    static const struct Thresholds
+    {
+        float values[255];
+
+        Thresholds()
+        {
+            for (uint32_t n_value = 0;
+                          n_value < 255;
+                        ++n_value)
+            {
+                const float srgb = (static_cast<float>(n_value) + 0.5f) / 255.0f;
+
+                values[n_value] = (srgb <= 0.04045f) ? srgb / 12.92f
+                                                     : powf( (srgb + 0.055f) / 1.055f, 2.4f);
+            }
+        }
+    } thresholds;
+
+    return static_cast<uint8_t>(std::upper_bound(thresholds.values,
+                                                 thresholds.values + 255,
+                                                 static_cast<float>(in_linear) ) - thresholds.values);
+}
+
+/** Reads @param in_n_bits bits, starting at bit @param in_start_bit of a texel, which takes @param in_n_texel_bytes bytes. */
+static uint32_t read_bits(const uint8_t* in_texel_ptr,
+                          uint32_t       in_n_texel_bytes,
+                          uint32_t       in_start_bit,
+                          uint32_t       in_n_bits)
+{
+    const uint32_t first_byte = in_start_bit / 8;
+    const uint32_t n_bytes    = std::min(in_n_texel_bytes - first_byte,
+                                         5u);
+    uint64_t       window     = 0;
+
+    for (uint32_t n_byte = 0;
+                  n_byte < n_bytes;
+                ++n_byte)
+    {
+        window |= static_cast<uint64_t>(in_texel_ptr[first_byte + n_byte]) << (8 * n_byte);
+    }
+
+    return static_cast<uint32_t>( (window >> (in_start_bit % 8) ) & ( (1ull << in_n_bits) - 1) );
+}
+
+/** Writes @param in_n_bits bits of @param in_value, starting at bit @param in_start_bit of a texel. */
+static void write_bits(uint8_t* inout_texel_ptr,
+                       uint32_t in_n_texel_bytes,
+                       uint32_t in_start_bit,
+                       uint32_t in_n_bits,
+                       uint32_t in_value)
+{
+    const uint32_t first_byte = in_start_bit / 8;
+    const uint32_t n_bytes    = std::min(in_n_texel_bytes - first_byte,
+                                         5u);
+    const uint64_t mask       = ( (1ull << in_n_bits) - 1) << (in_start_bit % 8);
+    uint64_t       window     = 0;
+
+    for (uint32_t n_byte = 0;
+                  n_byte < n_bytes;
+                ++n_byte)
+    {
+        window |= static_cast<uint64_t>(inout_texel_ptr[first_byte + n_byte]) << (8 * n_byte);
+    }
+
+    window = (window & ~mask) | ( (static_cast<uint64_t>(in_value) << (in_start_bit % 8) ) & mask);
+
+    for (uint32_t n_byte = 0;
+                  n_byte < n_bytes;
+                ++n_byte)
+    {
+        inout_texel_ptr[first_byte + n_byte] = static_cast<uint8_t>(window >> (8 * n_byte) );
+    }
+}
+
+/** Decodes a single texel to RGBA. Missing components are set to (0, 0, 0, 1). */
+static void decode_texel(const FormatLayout& in_layout,
+                         const uint8_t*      in_texel_ptr,
+                         double*             out_rgba_ptr)
+{
+    for (uint32_t n_component = 0;
+                  n_component < 4;
+                ++n_component)
+    {
+        const uint32_t n_bits = in_layout.n_bits[n_component];
+        uint32_t       raw;
+
+        if (n_bits == 0)
+        {
+            out_rgba_ptr[n_component] = (n_component == 3) ? 1.0 : 0.0;
+
+            continue;
+        }
+
+        raw = read_bits(in_texel_ptr,
+                        in_layout.n_bytes_per_texel,
+                        in_layout.start_bit[n_component],
+                        n_bits);
+
+        switch (in_layout.type)
+        {
+            case Anvil::FormatType::SFLOAT:
+            {
+                if (n_bits == 16)
+                {
+                    Anvil::float16_t value;
+
+                    value.u                   = static_cast<unsigned short>(raw);
+                    out_rgba_ptr[n_component] = Anvil::Utils::fp16_to_fp32_full(value).f;
+                }
+                else
+                {
+                    Anvil::float32_t value;
+
+                    value.u                   = raw;
+                    out_rgba_ptr[n_component] = value.f;
+                }
+
+                break;
+            }
+
+            case Anvil::FormatType::SINT:
+            case Anvil::FormatType::SNORM:
+            case Anvil::FormatType::SSCALED:
+            {
+                const int64_t sign_bit = 1ll << (n_bits - 1);
+                const int64_t value    = (static_cast<int64_t>(raw) ^ sign_bit) - sign_bit;
+
+                out_rgba_ptr[n_component] = (in_layout.type == Anvil::FormatType::SNORM) ? std::max(static_cast<double>(value) / static_cast<double>(sign_bit - 1),
+                                                                                                    -1.0)
+                                                                                          : static_cast<double>(value);
+
+                break;
+            }
+
+            case Anvil::FormatType::SRGB:
+            {
+                if (n_component != 3 &&
+                    n_bits      == 8)
+                {
+                    out_rgba_ptr[n_component] = get_srgb_to_linear_table()[raw];
+
+                    break;
+                }
+
+                /* Alpha is stored as UNORM */
+            }
+            /* fall-through */
+
+            case Anvil::FormatType::UNORM:
+            {
+                out_rgba_ptr[n_component] = static_cast<double>(raw) / static_cast<double>( (1ull << n_bits) - 1);
+
+                break;
+            }
+
+            default:
+            {
+                /* UINT, USCALED */
+                out_rgba_ptr[n_component] = static_cast<double>(raw);
+            }
+        }
+    }
+}
+
+/** Encodes RGBA to a single texel. Values out of the range representable by the format are clamped. */
+static void encode_texel(const FormatLayout& in_layout,
+                         const double*       in_rgba_ptr,
+                         uint8_t*            out_texel_ptr)
+{
+    memset(out_texel_ptr,
+           0,
+           in_layout.n_bytes_per_texel);
+
+    for (uint32_t n_component = 0;
+                  n_component < 4;
+                ++n_component)
+    {
+        const uint32_t n_bits = in_layout.n_bits[n_component];
+        const double   value  = in_rgba_ptr[n_component];
+        uint32_t       raw    = 0;
+
+        if (n_bits == 0)
+        {
+            continue;
+        }
+
+        switch (in_layout.type)
+        {
+            case Anvil::FormatType::SFLOAT:
+            {
+                const Anvil::float32_t value_fp32(static_cast<float>(value) );
+
+                raw = (n_bits == 16) ? Anvil::Utils::fp32_to_fp16_full_rtne(value_fp32).u
+                                     : value_fp32.u;
+
+                break;
+            }
+
+            case Anvil::FormatType::SINT:
+            case Anvil::FormatType::SNORM:
+            case Anvil::FormatType::SSCALED:
+            {
+                const double max_value = static_cast<double>( (1ll << (n_bits - 1) ) - 1);
+                double       scaled;
+
+                if (in_layout.type == Anvil::FormatType::SNORM)
+                {
+                    scaled = std::floor(std::min(std::max(value, -1.0), 1.0) * max_value + 0.5);
+                }
+                else
+                {
+                    scaled = std::floor(std::min(std::max(value, -max_value - 1.0), max_value) + 0.5);
+                }
+
+                raw = static_cast<uint32_t>(static_cast<int64_t>(scaled) ) & static_cast<uint32_t>( (1ull << n_bits) - 1);
+
+                break;
+            }
+
+            case Anvil::FormatType::SRGB:
+            {
+                if (n_component != 3 &&
+                    n_bits      == 8)
+                {
+                    raw = encode_srgb(value);
+
+                    break;
+                }
+
+                /* Alpha is stored as UNORM */
+            }
+            /* fall-through */
+
+            case Anvil::FormatType::UNORM:
+            {
+                const double max_value = static_cast<double>( (1ull << n_bits) - 1);
+
+                raw = static_cast<uint32_t>(std::floor(std::min(std::max(value, 0.0), 1.0) * max_value + 0.5) );
+
+                break;
+            }
+
+            default:
+            {
+                /* UINT, USCALED */
+                const double max_value = static_cast<double>( (1ull << n_bits) - 1);
+
+                raw = static_cast<uint32_t>(std::floor(std::min(std::max(value, 0.0), max_value) + 0.5) );
+            }
+        }
+
+        write_bits(out_texel_ptr,
+                   in_layout.n_bytes_per_texel,
+                   in_layout.start_bit[n_component],
+                   n_bits,
+                   raw);
+    }
+}
+
+/** Tells whether @param in_layout describes a 4x8-bit format, whose components are stored in whole bytes. */
+static bool is_4x8bit_layout(const FormatLayout& in_layout)
+{
+    bool result = (in_layout.n_bytes_per_texel == 4);
+
+    for (uint32_t n_component = 0;
+                  n_component < 4 && result;
+                ++n_component)
+    {
+        result = (in_layout.n_bits   [n_component]      == 8 &&
+                  in_layout.start_bit[n_component] % 8  == 0);
+    }
+
+    return result;
+}
+
+/** Determines which code path a conversion is going to use, and precomputes data it needs. */
+static bool init_conversion_context(Anvil::Format      in_src_format,
+                                    Anvil::Format      in_dst_format,
+                                    ConversionContext* out_context_ptr)
+{
+    const FormatLayout& dst_layout = out_context_ptr->dst_layout;
+    bool                result     = false;
+    const FormatLayout& src_layout = out_context_ptr->src_layout;
+
+    if (!get_format_layout(in_src_format,
+                          &out_context_ptr->src_layout) ||
+        !get_format_layout(in_dst_format,
+                          &out_context_ptr->dst_layout) )
+    {
+        goto end;
+    }
+
+    if (in_src_format == in_dst_format)
+    {
+        out_context_ptr->path = ConversionPath::COPY;
+    }
+    else
+    if (is_4x8bit_layout(src_layout) &&
+        is_4x8bit_layout(dst_layout) )
+    {
+        const bool is_src_8bit_color = (src_layout.type == Anvil::FormatType::UNORM || src_layout.type == Anvil::FormatType::SRGB);
+        const bool is_dst_8bit_color = (dst_layout.type == Anvil::FormatType::UNORM || dst_layout.type == Anvil::FormatType::SRGB);
+
+        for (uint32_t n_component = 0;
+                      n_component < 4;
+                    ++n_component)
+        {
+            uint32_t n_src_byte = src_layout.start_bit[n_component] / 8;
+            uint32_t n_dst_byte = dst_layout.start_bit[n_component] / 8;
+
+            out_context_ptr->src_component_index_per_dst_component[n_dst_byte] = n_src_byte;
+        }
+
+        if (src_layout.type == dst_layout.type)
+        {
+            out_context_ptr->path = ConversionPath::SWIZZLE_8BIT;
+        }
+        else
+        if (is_src_8bit_color &&
+            is_dst_8bit_color)
+        {
+            const float* srgb_to_linear_ptr = get_srgb_to_linear_table();
+
+            for (uint32_t n_component = 0;
+                          n_component < 4;
+                        ++n_component)
+            {
+                const uint32_t n_dst_byte = dst_layout.start_bit[n_component] / 8;
+
+                for (uint32_t n_value = 0;
+                              n_value < 256;
+                            ++n_value)
+                {
+                    uint8_t value = static_cast<uint8_t>(n_value);
+
+                    if (n_component != 3)
+                    {
+                        value = (src_layout.type == Anvil::FormatType::SRGB) ? static_cast<uint8_t>(std::floor(srgb_to_linear_ptr[n_value] * 255.0f + 0.5f) )
+                                                                             : encode_srgb(static_cast<double>(n_value) / 255.0);
+                    }
+
+                    out_context_ptr->lut[n_dst_byte][n_value] = value;
+                }
+            }
+
+            out_context_ptr->path = ConversionPath::LUT_8BIT;
+        }
+    }
+    else
+    if (src_layout.type         == Anvil::FormatType::SFLOAT &&
+        dst_layout.type         == Anvil::FormatType::SFLOAT &&
+        src_layout.n_components == dst_layout.n_components)
+    {
+        const uint32_t src_n_bits = src_layout.n_bits[0];
+        const uint32_t dst_n_bits = dst_layout.n_bits[0];
+        bool           is_match   = (src_n_bits != dst_n_bits);
+
+        /* Components must be stored in the same order, with no gaps */
+        for (uint32_t n_component = 0;
+                      n_component < 4 && is_match;
+                    ++n_component)
+        {
+            if (src_layout.n_bits[n_component] == 0 &&
+                dst_layout.n_bits[n_component] == 0)
+            {
+                continue;
+            }
+
+            is_match = (src_layout.n_bits   [n_component]              == src_n_bits                             &&
+                        dst_layout.n_bits   [n_component]              == dst_n_bits                             &&
+                        src_layout.start_bit[n_component] / src_n_bits == dst_layout.start_bit[n_component] / dst_n_bits &&
+                        src_layout.start_bit[n_component] / src_n_bits == n_component);
+        }
+
+        if (is_match)
+        {
+            out_context_ptr->path = (src_n_bits == 32) ? ConversionPath::FP32_TO_FP16
+                                                       : ConversionPath::FP16_TO_FP32;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Swizzles @param in_n_texels 4x8-bit texels. */
+static void swizzle_4x8bit_row(const ConversionContext& in_context,
+                               const uint8_t*           in_src_ptr,
+                               uint32_t                 in_n_texels,
+                               uint8_t*                 out_dst_ptr)
+{
+    const uint32_t* component_map = in_context.src_component_index_per_dst_component;
+    uint32_t        n_texel       = 0;
+
+    #if defined(ANVIL_TEXTURE_CONVERTER_HAS_SSE2)
+    {
+        /* RGBA8 <-> BGRA8 is by far the most common swizzle. Swap bytes 0 and 2 of each texel, 4 texels at a time. */
+        if (component_map[0] == 2 &&
+            component_map[1] == 1 &&
+            component_map[2] == 0 &&
+            component_map[3] == 3)
+        {
+            const __m128i mask_ga = _mm_set1_epi32(static_cast<int>(0xFF00FF00u) );
+            const __m128i mask_rb = _mm_set1_epi32(0x00FF00FF);
+
+            for (;
+                 n_texel + 4 <= in_n_texels;
+                 n_texel += 4)
+            {
+                const __m128i texels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in_src_ptr + n_texel * 4) );
+                const __m128i ga     = _mm_and_si128  (texels, mask_ga);
+                const __m128i rb     = _mm_and_si128  (texels, mask_rb);
+                const __m128i br     = _mm_or_si128   (_mm_slli_epi32(rb, 16),
+                                                       _mm_srli_epi32(rb, 16) );
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out_dst_ptr + n_texel * 4),
+                                 _mm_or_si128(ga, br) );
+            }
+        }
+    }
+    #endif
+
+    for (;
+         n_texel < in_n_texels;
+       ++n_texel)
+    {
+        const uint8_t* src_texel_ptr = in_src_ptr  + n_texel * 4;
+        uint8_t*       dst_texel_ptr = out_dst_ptr + n_texel * 4;
+
+        dst_texel_ptr[0] = src_texel_ptr[component_map[0] ];
+        dst_texel_ptr[1] = src_texel_ptr[component_map[1] ];
+        dst_texel_ptr[2] = src_texel_ptr[component_map[2] ];
+        dst_texel_ptr[3] = src_texel_ptr[component_map[3] ];
+    }
+}
+
+/** Converts a single row of @param in_n_texels texels. */
+static void convert_row(const ConversionContext& in_context,
+                        const uint8_t*           in_src_ptr,
+                        uint32_t                 in_n_texels,
+                        uint8_t*                 out_dst_ptr)
+{
+    switch (in_context.path)
+    {
+        case ConversionPath::COPY:
+        {
+            memcpy(out_dst_ptr,
+                   in_src_ptr,
+                   in_n_texels * in_context.src_layout.n_bytes_per_texel);
+
+            break;
+        }
+
+        case ConversionPath::FP16_TO_FP32:
+        {
+            Anvil::Utils::convert_fp16_to_fp32_n(reinterpret_cast<const Anvil::float16_t*>(in_src_ptr),
+                                                 in_n_texels * in_context.src_layout.n_components,
+                                                 reinterpret_cast<Anvil::float32_t*>(out_dst_ptr) );
+
+            break;
+        }
+
+        case ConversionPath::FP32_TO_FP16:
+        {
+            Anvil::Utils::convert_fp32_to_fp16_n(reinterpret_cast<const Anvil::float32_t*>(in_src_ptr),
+                                                 in_n_texels * in_context.src_layout.n_components,
+                                                 reinterpret_cast<Anvil::float16_t*>(out_dst_ptr) );
+
+            break;
+        }
+
+        case ConversionPath::LUT_8BIT:
+        {
+            const uint32_t* component_map = in_context.src_component_index_per_dst_component;
+
+            for (uint32_t n_texel = 0;
+                          n_texel < in_n_texels;
+                        ++n_texel)
+            {
+                const uint8_t* src_texel_ptr = in_src_ptr  + n_texel * 4;
+                uint8_t*       dst_texel_ptr = out_dst_ptr + n_texel * 4;
+
+                dst_texel_ptr[0] = in_context.lut[0][src_texel_ptr[component_map[0] ] ];
+                dst_texel_ptr[1] = in_context.lut[1][src_texel_ptr[component_map[1] ] ];
+                dst_texel_ptr[2] = in_context.lut[2][src_texel_ptr[component_map[2] ] ];
+                dst_texel_ptr[3] = in_context.lut[3][src_texel_ptr[component_map[3] ] ];
+            }
+
+            break;
+        }
+
+        case ConversionPath::SWIZZLE_8BIT:
+        {
+            swizzle_4x8bit_row(in_context,
+                               in_src_ptr,
+                               in_n_texels,
+                               out_dst_ptr);
+
+            break;
+        }
+
+        default:
+        {
+            const uint32_t n_dst_bytes_per_texel = in_context.dst_layout.n_bytes_per_texel;
+            const uint32_t n_src_bytes_per_texel = in_context.src_layout.n_bytes_per_texel;
+            double         rgba[4];
+
+            for (uint32_t n_texel = 0;
+                          n_texel < in_n_texels;
+                        ++n_texel)
+            {
+                decode_texel(in_context.src_layout,
+                             in_src_ptr + n_texel * n_src_bytes_per_texel,
+                             rgba);
+                encode_texel(in_context.dst_layout,
+                             rgba,
+                             out_dst_ptr + n_texel * n_dst_bytes_per_texel);
+            }
+        }
+    }
+}
+
+/** Computes the principal axis of @param in_n_points points of @param in_n_dimensions dimensions (up to 4), using power iteration.
+ *
+ *  @param out_mean_ptr Deref will be set to the mean of the points.
+ *  @param out_axis_ptr Deref will be set to the (not normalized) principal axis.
+ */
+static void get_principal_axis(const float* in_points_ptr,
+                               uint32_t     in_n_points,
+                               uint32_t     in_n_dimensions,
+                               float*       out_mean_ptr,
+                               float*       out_axis_ptr)
+{
+    float covariance[4][4] = {};
+
+    for (uint32_t n_dimension = 0;
+                  n_dimension < in_n_dimensions;
+                ++n_dimension)
+    {
+        out_mean_ptr[n_dimension] = 0.0f;
+
+        for (uint32_t n_point = 0;
+                      n_point < in_n_points;
+                    ++n_point)
+        {
+            out_mean_ptr[n_dimension] += in_points_ptr[n_point * 4 + n_dimension];
+        }
+
+        out_mean_ptr[n_dimension] /= static_cast<float>(in_n_points);
+    }
+
+    for (uint32_t n_point = 0;
+                  n_point < in_n_points;
+                ++n_point)
+    {
+        for (uint32_t n_row = 0;
+                      n_row < in_n_dimensions;
+                    ++n_row)
+        {
+            for (uint32_t n_column = 0;
+                          n_column < in_n_dimensions;
+                        ++n_column)
+            {
+                covariance[n_row][n_column] += (in_points_ptr[n_point * 4 + n_row]    - out_mean_ptr[n_row]) *
+                                               (in_points_ptr[n_point * 4 + n_column] - out_mean_ptr[n_column]);
+            }
+        }
+    }
+
+    for (uint32_t n_dimension = 0;
+                  n_dimension < in_n_dimensions;
+                ++n_dimension)
+    {
+        out_axis_ptr[n_dimension] = 1.0f;
+    }
+
+    for (uint32_t n_iteration = 0;
+                  n_iteration < 8;
+                ++n_iteration)
+    {
+        float new_axis[4] = {};
+        float max_value   = 0.0f;
+
+        for (uint32_t n_row = 0;
+                      n_row < in_n_dimensions;
+                    ++n_row)
+        {
+            for (uint32_t n_column = 0;
+                          n_column < in_n_dimensions;
+                        ++n_column)
+            {
+                new_axis[n_row] += covariance[n_row][n_column] * out_axis_ptr[n_column];
+            }
+
+            max_value = std::max(max_value,
+                                 std::fabs(new_axis[n_row]) );
+        }
+
+        if (max_value < 1e-6f)
+        {
+            break;
+        }
+
+        for (uint32_t n_dimension = 0;
+                      n_dimension < in_n_dimensions;
+                    ++n_dimension)
+        {
+            out_axis_ptr[n_dimension] = new_axis[n_dimension] / max_value;
+        }
+    }
+}
+
+/** Finds two endpoints spanning @param in_n_points points along their principal axis. Endpoints are inset by
+ *  1/16th of the span, to account for the rounding interpolated palette entries go through.
+ */
+static void get_endpoints(const float* in_points_ptr,
+                          uint32_t     in_n_points,
+                          uint32_t     in_n_dimensions,
+                          float*       out_endpoint0_ptr,
+                          float*       out_endpoint1_ptr)
+{
+    float axis            [4];
+    float axis_length_sqr = 0.0f;
+    float max_projection  = -1e30f;
+    float mean            [4];
+    float min_projection  = 1e30f;
+
+    get_principal_axis(in_points_ptr,
+                       in_n_points,
+                       in_n_dimensions,
+                       mean,
+                       axis);
+
+    for (uint32_t n_dimension = 0;
+                  n_dimension < in_n_dimensions;
+                ++n_dimension)
+    {
+        axis_length_sqr += axis[n_dimension] * axis[n_dimension];
+    }
+
+    for (uint32_t n_point = 0;
+                  n_point < in_n_points;
+                ++n_point)
+    {
+        float projection = 0.0f;
+
+        for (uint32_t n_dimension = 0;
+                      n_dimension < in_n_dimensions;
+                    ++n_dimension)
+        {
+            projection += (in_points_ptr[n_point * 4 + n_dimension] - mean[n_dimension]) * axis[n_dimension];
+        }
+
+        max_projection = std::max(max_projection, projection);
+        min_projection = std::min(min_projection, projection);
+    }
+
+    if (axis_length_sqr > 0.0f)
+    {
+        const float inset = (max_projection - min_projection) / 16.0f;
+
+        max_projection = (max_projection - inset) / axis_length_sqr;
+        min_projection = (min_projection + inset) / axis_length_sqr;
+    }
+    else
+    {
+        max_projection = 0.0f;
+        min_projection = 0.0f;
+    }
+
+    for (uint32_t n_dimension = 0;
+                  n_dimension < in_n_dimensions;
+                ++n_dimension)
+    {
+        out_endpoint0_ptr[n_dimension] = std::min(std::max(mean[n_dimension] + axis[n_dimension] * max_projection, 0.0f), 255.0f);
+        out_endpoint1_ptr[n_dimension] = std::min(std::max(mean[n_dimension] + axis[n_dimension] * min_projection, 0.0f), 255.0f);
+    }
+}
+
+/** Returns the index of the palette entry closest to @param in_texel_ptr. */
+static uint32_t get_closest_palette_index(const int32_t* in_texel_ptr,
+                                          const int32_t  in_palette[][4],
+                                          uint32_t       in_n_palette_entries,
+                                          uint32_t       in_n_dimensions)
+{
+    int32_t  min_distance = INT32_MAX;
+    uint32_t result       = 0;
+
+    for (uint32_t n_entry = 0;
+                  n_entry < in_n_palette_entries;
+                ++n_entry)
+    {
+        int32_t distance = 0;
+
+        for (uint32_t n_dimension = 0;
+                      n_dimension < in_n_dimensions;
+                    ++n_dimension)
+        {
+            const int32_t delta = in_texel_ptr[n_dimension] - in_palette[n_entry][n_dimension];
+
+            distance += delta * delta;
+        }
+
+        if (distance < min_distance)
+        {
+            min_distance = distance;
+            result       = n_entry;
+        }
+    }
+
+    return result;
+}
+
+/** Quantizes an 8-bit RGB color to RGB565. */
+static uint16_t get_rgb565(const float* in_rgb_ptr)
+{
+    const uint32_t r = static_cast<uint32_t>(in_rgb_ptr[0] * 31.0f / 255.0f + 0.5f);
+    const uint32_t g = static_cast<uint32_t>(in_rgb_ptr[1] * 63.0f / 255.0f + 0.5f);
+    const uint32_t b = static_cast<uint32_t>(in_rgb_ptr[2] * 31.0f / 255.0f + 0.5f);
+
+    return static_cast<uint16_t>( (r << 11) | (g << 5) | b);
+}
+
+/** Expands an RGB565 color to 8-bit RGB. */
+static void get_rgb888(uint16_t in_rgb565,
+                       int32_t* out_rgb_ptr)
+{
+    const int32_t r = (in_rgb565 >> 11) & 0x1F;
+    const int32_t g = (in_rgb565 >> 5)  & 0x3F;
+    const int32_t b =  in_rgb565        & 0x1F;
+
+    out_rgb_ptr[0] = (r << 3) | (r >> 2);
+    out_rgb_ptr[1] = (g << 2) | (g >> 4);
+    out_rgb_ptr[2] = (b << 3) | (b >> 2);
+    out_rgb_ptr[3] = 255;
+}
+
+/** Encodes a BC1 color block.
+ *
+ *  @param in_texels_ptr     16 RGBA8 texels, in row-major order.
+ *  @param in_use_alpha      True to encode texels with alpha < 128 as transparent (3-color mode), false to ignore alpha.
+ *  @param out_block_ptr     Deref will be set to the 8-byte block.
+ */
+static void encode_bc1_block(const uint8_t* in_texels_ptr,
+                             bool           in_use_alpha,
+                             uint8_t*       out_block_ptr)
+{
+    uint16_t color0          = 0;
+    uint16_t color1          = 0;
+    bool     has_transparent = false;
+    uint32_t indices         = 0;
+    uint32_t n_opaque_texels = 0;
+    int32_t  palette[4][4]   = {};
+    float    points[16 * 4];
+
+    for (uint32_t n_texel = 0;
+                  n_texel < 16;
+                ++n_texel)
+    {
+        if (in_use_alpha                       &&
+            in_texels_ptr[n_texel * 4 + 3] < 128)
+        {
+            has_transparent = true;
+
+            continue;
+        }
+
+        for (uint32_t n_component = 0;
+                      n_component < 3;
+                    ++n_component)
+        {
+            points[n_opaque_texels * 4 + n_component] = static_cast<float>(in_texels_ptr[n_texel * 4 + n_component]);
+        }
+
+        n_opaque_texels++;
+    }
+
+    if (n_opaque_texels > 0)
+    {
+        float endpoint0[4];
+        float endpoint1[4];
+
+        get_endpoints(points,
+                      n_opaque_texels,
+                      3, /* in_n_dimensions */
+                      endpoint0,
+                      endpoint1);
+
+        color0 = get_rgb565(endpoint0);
+        color1 = get_rgb565(endpoint1);
+    }
+
+    /* color0 > color1 selects 4-color mode. color0 <= color1 selects 3-color mode with a transparent entry. */
+    if ( ( has_transparent && color0 > color1) ||
+         (!has_transparent && color0 < color1) )
+    {
+        std::swap(color0,
+                  color1);
+    }
+
+    get_rgb888(color0,
+               palette[0]);
+    get_rgb888(color1,
+               palette[1]);
+
+    if (color0 > color1)
+    {
+        for (uint32_t n_component = 0;
+                      n_component < 3;
+                    ++n_component)
+        {
+            palette[2][n_component] = (2 * palette[0][n_component] +     palette[1][n_component]) / 3;
+            palette[3][n_component] = (    palette[0][n_component] + 2 * palette[1][n_component]) / 3;
+        }
+    }
+    else
+    {
+        for (uint32_t n_component = 0;
+                      n_component < 3;
+                    ++n_component)
+        {
+            palette[2][n_component] = (palette[0][n_component] + palette[1][n_component]) / 2;
+        }
+    }
+
+    for (uint32_t n_texel = 0;
+                  n_texel < 16;
+                ++n_texel)
+    {
+        const int32_t texel[3] =
+        {
+            in_texels_ptr[n_texel * 4 + 0],
+            in_texels_ptr[n_texel * 4 + 1],
+            in_texels_ptr[n_texel * 4 + 2],
+        };
+        uint32_t index;
+
+        if (has_transparent                    &&
+            in_texels_ptr[n_texel * 4 + 3] < 128)
+        {
+            index = 3;
+        }
+        else
+        if (color0 == color1)
+        {
+            index = 0;
+        }
+        else
+        {
+            index = get_closest_palette_index(texel,
+                                              palette,
+                                              (color0 > color1) ? 4 : 3,
+                                              3); /* in_n_dimensions */
+        }
+
+        indices |= index << (n_texel * 2);
+    }
+
+    out_block_ptr[0] = static_cast<uint8_t>(color0 & 0xFF);
+    out_block_ptr[1] = static_cast<uint8_t>(color0 >> 8);
+    out_block_ptr[2] = static_cast<uint8_t>(color1 & 0xFF);
+    out_block_ptr[3] = static_cast<uint8_t>(color1 >> 8);
+
+    for (uint32_t n_byte = 0;
+                  n_byte < 4;
+                ++n_byte)
+    {
+        out_block_ptr[4 + n_byte] = static_cast<uint8_t>(indices >> (n_byte * 8) );
+    }
+}
+
+/** Encodes the alpha block of a BC3 block, using the 8-value interpolation mode.
+ *
+ *  @param in_texels_ptr 16 RGBA8 texels, in row-major order.
+ *  @param out_block_ptr Deref will be set to the 8-byte block.
+ */
+static void encode_bc3_alpha_block(const uint8_t* in_texels_ptr,
+                                   uint8_t*       out_block_ptr)
+{
+    uint32_t alpha0        = 0;
+    uint32_t alpha1        = 255;
+    uint64_t indices       = 0;
+    int32_t  palette[8][4] = {};
+
+    for (uint32_t n_texel = 0;
+                  n_texel < 16;
+                ++n_texel)
+    {
+        alpha0 = std::max(alpha0, static_cast<uint32_t>(in_texels_ptr[n_texel * 4 + 3]) );
+        alpha1 = std::min(alpha1, static_cast<uint32_t>(in_texels_ptr[n_texel * 4 + 3]) );
+    }
+
+    palette[0][0] = static_cast<int32_t>(alpha0);
+    palette[1][0] = static_cast<int32_t>(alpha1);
+
+    for (uint32_t n_entry = 1;
+                  n_entry < 7;
+                ++n_entry)
+    {
+        palette[n_entry + 1][0] = static_cast<int32_t>( ( (7 - n_entry) * alpha0 + n_entry * alpha1) / 7);
+    }
+
+    if (alpha0 != alpha1)
+    {
+        for (uint32_t n_texel = 0;
+                      n_texel < 16;
+                    ++n_texel)
+        {
+            const int32_t alpha = in_texels_ptr[n_texel * 4 + 3];
+
+            indices |= static_cast<uint64_t>(get_closest_palette_index(&alpha,
+                                                                       palette,
+                                                                       8,
+                                                                       1) ) << (n_texel * 3); /* in_n_dimensions */
+        }
+    }
+
+    out_block_ptr[0] = static_cast<uint8_t>(alpha0);
+    out_block_ptr[1] = static_cast<uint8_t>(alpha1);
+
+    for (uint32_t n_byte = 0;
+                  n_byte < 6;
+                ++n_byte)
+    {
+        out_block_ptr[2 + n_byte] = static_cast<uint8_t>(indices >> (n_byte * 8) );
+    }
+}
+
+/** Quantizes an 8-bit RGBA endpoint to 7 bits per component + a shared p-bit, as used by BC7 mode 6.
+ *
+ *  @param in_endpoint_ptr       Endpoint to quantize.
+ *  @param out_quantized_ptr     Deref will be set to the 7-bit components.
+ *  @param out_p_bit_ptr         Deref will be set to the p-bit.
+ */
+static void quantize_bc7_mode6_endpoint(const float* in_endpoint_ptr,
+                                        uint32_t*    out_quantized_ptr,
+                                        uint32_t*    out_p_bit_ptr)
+{
+    float min_error = 1e30f;
+
+    for (uint32_t p_bit = 0;
+                  p_bit < 2;
+                ++p_bit)
+    {
+        float    error = 0.0f;
+        uint32_t quantized[4];
+
+        for (uint32_t n_component = 0;
+                      n_component < 4;
+                    ++n_component)
+        {
+            const float value = std::floor( (in_endpoint_ptr[n_component] - static_cast<float>(p_bit) ) / 2.0f + 0.5f);
+            const float delta = static_cast<float>( (static_cast<uint32_t>(std::min(std::max(value, 0.0f), 127.0f) ) << 1) | p_bit) - in_endpoint_ptr[n_component];
+
+            quantized[n_component] = static_cast<uint32_t>(std::min(std::max(value, 0.0f), 127.0f) );
+            error                 += delta * delta;
+        }
+
+        if (error < min_error)
+        {
+            min_error      = error;
+            *out_p_bit_ptr = p_bit;
+
+            memcpy(out_quantized_ptr,
+                   quantized,
+                   sizeof(quantized) );
+        }
+    }
+}
+
+/** Encodes a BC7 block, using mode 6 (single subset, RGBA 7.7.7.7 endpoints with unique p-bits, 4-bit indices).
+ *
+ *  @param in_texels_ptr 16 RGBA8 texels, in row-major order.
+ *  @param out_block_ptr Deref will be set to the 16-byte block.
+ */
+static void encode_bc7_block(const uint8_t* in_texels_ptr,
+                             uint8_t*       out_block_ptr)
+{
+    float    endpoints  [2][4];
+    uint32_t indices    [16];
+    int32_t  palette    [16][4];
+    uint32_t p_bits     [2];
+    float    points     [16 * 4];
+    uint32_t quantized  [2][4];
+
+    for (uint32_t n_value = 0;
+                  n_value < 16 * 4;
+                ++n_value)
+    {
+        points[n_value] = static_cast<float>(in_texels_ptr[n_value]);
+    }
+
+    get_endpoints(points,
+                  16, /* in_n_points     */
+                  4,  /* in_n_dimensions */
+                  endpoints[0],
+                  endpoints[1]);
+
+    for (uint32_t n_endpoint = 0;
+                  n_endpoint < 2;
+                ++n_endpoint)
+    {
+        quantize_bc7_mode6_endpoint(endpoints[n_endpoint],
+                                    quantized[n_endpoint],
+                                   &p_bits   [n_endpoint]);
+    }
+
+    for (uint32_t n_entry = 0;
+                  n_entry < 16;
+                ++n_entry)
+    {
+        for (uint32_t n_component = 0;
+                      n_component < 4;
+                    ++n_component)
+        {
+            const uint32_t value0 = (quantized[0][n_component] << 1) | p_bits[0];
+            const uint32_t value1 = (quantized[1][n_component] << 1) | p_bits[1];
+
+            palette[n_entry][n_component] = static_cast<int32_t>( ( (64 - g_bc7_weights4[n_entry]) * value0 + g_bc7_weights4[n_entry] * value1 + 32) >> 6);
+        }
+    }
+
+    for (uint32_t n_texel = 0;
+                  n_texel < 16;
+                ++n_texel)
+    {
+        const int32_t texel[4] =
+        {
+            in_texels_ptr[n_texel * 4 + 0],
+            in_texels_ptr[n_texel * 4 + 1],
+            in_texels_ptr[n_texel * 4 + 2],
+            in_texels_ptr[n_texel * 4 + 3],
+        };
+
+        indices[n_texel] = get_closest_palette_index(texel,
+                                                     palette,
+                                                     16,
+                                                     4); /* in_n_dimensions */
+    }
+
+    /* The MSB of the anchor index is implicitly 0. Swap the endpoints if the first texel does not satisfy that. */
+    if ( (indices[0] & 0x8) != 0)
+    {
+        std::swap(p_bits[0],
+                  p_bits[1]);
+
+        for (uint32_t n_component = 0;
+                      n_component < 4;
+                    ++n_component)
+        {
+            std::swap(quantized[0][n_component],
+                      quantized[1][n_component]);
+        }
+
+        for (uint32_t n_texel = 0;
+                      n_texel < 16;
+                    ++n_texel)
+        {
+            indices[n_texel] = 15 - indices[n_texel];
+        }
+    }
+
+    /* Pack the bits */
+    {
+        uint64_t bits[2]  = {0, 0};
+        uint32_t n_bit    = 0;
+
+        auto write = [&bits, &n_bit](uint32_t in_value,
+                                     uint32_t in_n_bits)
+        {
+            for (uint32_t n_value_bit = 0;
+                          n_value_bit < in_n_bits;
+                        ++n_value_bit, ++n_bit)
+            {
+                bits[n_bit / 64] |= static_cast<uint64_t>( (in_value >> n_value_bit) & 1) << (n_bit % 64);
+            }
+        };
+
+        write(1 << 6, 7); /* mode 6 */
+
+        for (uint32_t n_component = 0;
+                      n_component < 4;
+                    ++n_component)
+        {
+            write(quantized[0][n_component], 7);
+            write(quantized[1][n_component], 7);
+        }
+
+        write(p_bits[0], 1);
+        write(p_bits[1], 1);
+        write(indices[0], 3);
+
+        for (uint32_t n_texel = 1;
+                      n_texel < 16;
+                    ++n_texel)
+        {
+            write(indices[n_texel], 4);
+        }
+
+        anvil_assert(n_bit == 128);
+
+        for (uint32_t n_byte = 0;
+                      n_byte < 16;
+                    ++n_byte)
+        {
+            out_block_ptr[n_byte] = static_cast<uint8_t>(bits[n_byte / 8] >> ( (n_byte % 8) * 8) );
+        }
+    }
+}
+
+/** Calls @param in_func for consecutive ranges of <0, @param in_n_items) items, using up to @param in_n_threads threads,
+ *  or tasks submitted to @param in_opt_task_scheduler_ptr if it is not null. */
+static void run_in_parallel(uint32_t                                       in_n_items,
+                            uint32_t                                       in_n_threads,
+                            Anvil::TaskScheduler*                          in_opt_task_scheduler_ptr,
+                            const std::function<void(uint32_t, uint32_t)>& in_func)
+{
+    std::vector<std::thread> threads;
+    uint32_t                 n_items_per_thread;
+    uint32_t                 n_threads = in_n_threads;
+
+    if (in_opt_task_scheduler_ptr != nullptr)
+    {
+        in_opt_task_scheduler_ptr->parallel_for(in_n_items,
+                                                g_min_n_rows_per_thread,
+                                                [&in_func](uint32_t in_n_first_item,
+                                                           uint32_t in_n_items_in_range)
+                                                {
+                                                    in_func(in_n_first_item,
+                                                            in_n_first_item + in_n_items_in_range);
+                                                });
+
+        return;
+    }
+
+    if (n_threads == 0)
+    {
+        n_threads = std::max(std::thread::hardware_concurrency(),
+                             1u);
+    }
+
+    n_threads          = std::max(std::min(n_threads,
+                                           in_n_items / g_min_n_rows_per_thread),
+                                  1u);
+    n_items_per_thread = (in_n_items + n_threads - 1) / n_threads;
+
+    for (uint32_t n_thread = 1;
+                  n_thread < n_threads;
+                ++n_thread)
+    {
+        const uint32_t first_item = n_thread * n_items_per_thread;
+        const uint32_t last_item  = std::min(first_item + n_items_per_thread,
+                                             in_n_items);
+
+        if (first_item >= last_item)
+        {
+            break;
+        }
+
+        threads.push_back(
+            std::thread(in_func,
+                        first_item,
+                        last_item)
+        );
+    }
+
+    /* The calling thread handles the first range */
+    in_func(0,
+            std::min(n_items_per_thread,
+                     in_n_items) );
+
+    for (auto& current_thread : threads)
+    {
+        current_thread.join();
+    }
+}
+
+/* Please see header for specification */
+bool Anvil::TextureConverter::convert(Anvil::Format         in_src_format,
+                                      const void*           in_src_data_ptr,
+                                      uint32_t              in_src_row_pitch,
+                                      Anvil::Format         in_dst_format,
+                                      uint32_t              in_dst_row_pitch,
+                                      uint32_t              in_width,
+                                      uint32_t              in_height,
+                                      uint32_t              in_n_threads,
+                                      void*                 out_dst_data_ptr,
+                                      Anvil::TaskScheduler* in_opt_task_scheduler_ptr)
+{
+    ConversionContext context;
+    bool              is_dst_srgb  = false;
+    const BlockFormat block_format = get_block_format(in_dst_format,
+                                                     &is_dst_srgb);
+    bool              result       = false;
+    auto              src_ptr      = static_cast<const uint8_t*>(in_src_data_ptr);
+    auto              dst_ptr      = static_cast<uint8_t*>      (out_dst_data_ptr);
+
+    anvil_assert(in_src_data_ptr  != nullptr);
+    anvil_assert(out_dst_data_ptr != nullptr);
+
+    if (!init_conversion_context(in_src_format,
+                                 (block_format != BlockFormat::NONE) ? (is_dst_srgb ? Anvil::Format::R8G8B8A8_SRGB
+                                                                                    : Anvil::Format::R8G8B8A8_UNORM)
+                                                                     : in_dst_format,
+                                &context) )
+    {
+        goto end;
+    }
+
+    if (in_width  == 0 ||
+        in_height == 0)
+    {
+        result = true;
+
+        goto end;
+    }
+
+    if (block_format == BlockFormat::NONE)
+    {
+        run_in_parallel(in_height,
+                        in_n_threads,
+                        in_opt_task_scheduler_ptr,
+                        [&](uint32_t in_first_row,
+                            uint32_t in_last_row)
+                        {
+                            for (uint32_t n_row = in_first_row;
+                                          n_row < in_last_row;
+                                        ++n_row)
+                            {
+                                convert_row(context,
+                                            src_ptr + static_cast<size_t>(n_row) * in_src_row_pitch,
+                                            in_width,
+                                            dst_ptr + static_cast<size_t>(n_row) * in_dst_row_pitch);
+                            }
+                        });
+    }
+    else
+    {
+        const uint32_t n_block_bytes  = (block_format == BlockFormat::BC1 || block_format == BlockFormat::BC1_ALPHA) ? 8 : 16;
+        const uint32_t n_block_columns = (in_width  + 3) / 4;
+        const uint32_t n_block_rows    = (in_height + 3) / 4;
+
+        run_in_parallel(n_block_rows,
+                        in_n_threads,
+                        in_opt_task_scheduler_ptr,
+                        [&](uint32_t in_first_block_row,
+                            uint32_t in_last_block_row)
+                        {
+                            std::vector<uint8_t> band(static_cast<size_t>(in_width) * 4 * 4);
+                            uint8_t              texels[16 * 4];
+
+                            for (uint32_t n_block_row = in_first_block_row;
+                                          n_block_row < in_last_block_row;
+                                        ++n_block_row)
+                            {
+                                const uint32_t first_row = n_block_row * 4;
+                                const uint32_t n_rows    = std::min(in_height - first_row,
+                                                                    4u);
+                                uint8_t*       block_ptr = dst_ptr + static_cast<size_t>(n_block_row) * in_dst_row_pitch;
+
+                                /* Convert the band of rows to RGBA8 first */
+                                for (uint32_t n_row = 0;
+                                              n_row < n_rows;
+                                            ++n_row)
+                                {
+                                    convert_row(context,
+                                                src_ptr + static_cast<size_t>(first_row + n_row) * in_src_row_pitch,
+                                                in_width,
+                                               &band[static_cast<size_t>(n_row) * in_width * 4]);
+                                }
+
+                                for (uint32_t n_block_column = 0;
+                                              n_block_column < n_block_columns;
+                                            ++n_block_column)
+                                {
+                                    /* Texels outside the region replicate the closest texel inside */
+                                    for (uint32_t n_texel = 0;
+                                                  n_texel < 16;
+                                                ++n_texel)
+                                    {
+                                        const uint32_t x = std::min(n_block_column * 4 + n_texel % 4,
+                                                                    in_width - 1);
+                                        const uint32_t y = std::min(n_texel / 4,
+                                                                    n_rows - 1);
+
+                                        memcpy(texels + n_texel * 4,
+                                              &band[ (static_cast<size_t>(y) * in_width + x) * 4],
+                                               4);
+                                    }
+
+                                    switch (block_format)
+                                    {
+                                        case BlockFormat::BC1:       encode_bc1_block(texels, false, block_ptr); break;
+                                        case BlockFormat::BC1_ALPHA: encode_bc1_block(texels, true,  block_ptr); break;
+
+                                        case BlockFormat::BC3:
+                                        {
+                                            encode_bc3_alpha_block(texels,
+                                                                   block_ptr);
+                                            encode_bc1_block      (texels,
+                                                                   false, /* in_use_alpha */
+                                                                   block_ptr + 8);
+
+                                            break;
+                                        }
+
+                                        default:
+                                        {
+                                            encode_bc7_block(texels,
+                                                             block_ptr);
+                                        }
+                                    }
+
+                                    block_ptr += n_block_bytes;
+                                }
+                            }
+                        });
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::TextureConverter::create_mipmap_raw_data(Anvil::Format         in_src_format,
+                                                     const void*           in_src_data_ptr,
+                                                     uint32_t              in_src_row_pitch,
+                                                     Anvil::Format         in_dst_format,
+                                                     uint32_t              in_width,
+                                                     uint32_t              in_height,
+                                                     uint32_t              in_n_mipmap,
+                                                     uint32_t              in_n_threads,
+                                                     Anvil::MipmapRawData* out_result_ptr,
+                                                     Anvil::TaskScheduler* in_opt_task_scheduler_ptr)
+{
+    std::shared_ptr<std::vector<unsigned char> > data_ptr;
+    uint32_t                                     data_size = 0;
+    bool                                         result    = false;
+    uint32_t                                     row_size  = 0;
+
+    anvil_assert(out_result_ptr != nullptr);
+
+    if (!get_data_size(in_dst_format,
+                       in_width,
+                       in_height,
+                      &row_size,
+                      &data_size) )
+    {
+        goto end;
+    }
+
+    data_ptr.reset(
+        new std::vector<unsigned char>(data_size)
+    );
+
+    if (!convert(in_src_format,
+                 in_src_data_ptr,
+                 in_src_row_pitch,
+                 in_dst_format,
+                 row_size,
+                 in_width,
+                 in_height,
+                 in_n_threads,
+                 (data_size > 0) ? &data_ptr->at(0) : nullptr,
+                 in_opt_task_scheduler_ptr) )
+    {
+        goto end;
+    }
+
+    *out_result_ptr = Anvil::MipmapRawData::create_2D_from_uchar_vector_ptr(Anvil::ImageAspectFlagBits::COLOR_BIT,
+                                                                            in_n_mipmap,
+                                                                            data_ptr,
+                                                                            data_size,
+                                                                            row_size);
+
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::TextureConverter::get_data_size(Anvil::Format in_format,
+                                            uint32_t      in_width,
+                                            uint32_t      in_height,
+                                            uint32_t*     out_opt_row_size_ptr,
+                                            uint32_t*     out_opt_data_size_ptr)
+{
+    FormatLayout layout;
+    bool         result   = false;
+    uint32_t     n_rows   = 0;
+    uint32_t     row_size = 0;
+
+    if (get_block_format(in_format) != BlockFormat::NONE)
+    {
+        uint32_t block_size[2]     = {0, 0};
+        uint32_t n_bytes_per_block = 0;
+
+        if (!Anvil::Formats::get_compressed_format_block_size(in_format,
+                                                              block_size,
+                                                             &n_bytes_per_block) )
+        {
+            goto end;
+        }
+
+        n_rows   = (in_height + block_size[1] - 1) / block_size[1];
+        row_size = ( (in_width + block_size[0] - 1) / block_size[0]) * n_bytes_per_block;
+    }
+    else
+    if (get_format_layout(in_format,
+                         &layout) )
+    {
+        n_rows   = in_height;
+        row_size = in_width * layout.n_bytes_per_texel;
+    }
+    else
+    {
+        goto end;
+    }
+
+    if (out_opt_data_size_ptr != nullptr)
+    {
+        *out_opt_data_size_ptr = n_rows * row_size;
+    }
+
+    if (out_opt_row_size_ptr != nullptr)
+    {
+        *out_opt_row_size_ptr = row_size;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::TextureConverter::is_conversion_supported(Anvil::Format in_src_format,
+                                                      Anvil::Format in_dst_format)
+{
+    FormatLayout layout;
+
+    return get_format_layout(in_src_format,
+                            &layout)                                &&
+           (get_block_format (in_dst_format) != BlockFormat::NONE ||
+            get_format_layout(in_dst_format,
+                             &layout) );
+}
@@ -0,0 +1,794 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "misc/debug.h"
+#include "misc/formats.h"
+#include "misc/image_create_info.h"
+#include "misc/io.h"
+#include "misc/texture_file.h"
+#include <algorithm>
+#include <cstring>
+
+/* DDS container definitions */
+static const uint32_t g_dds_magic = 0x20534444; /* "DDS " */
+
+static const uint32_t g_dds_caps2_cubemap     = 0x200;
+static const uint32_t g_dds_caps2_volume      = 0x200000;
+static const uint32_t g_dds_flag_mipmap_count = 0x20000;
+static const uint32_t g_dds_pf_flag_fourcc    = 0x4;
+static const uint32_t g_dds_pf_flag_rgb       = 0x40;
+static const uint32_t g_dx10_dimension_1D     = 2;
+static const uint32_t g_dx10_dimension_3D     = 4;
+static const uint32_t g_dx10_misc_flag_cube   = 0x4;
+
+typedef struct DDSHeader
+{
+    uint32_t size;
+    uint32_t flags;
+    uint32_t height;
+    uint32_t width;
+    uint32_t pitch_or_linear_size;
+    uint32_t depth;
+    uint32_t mip_map_count;
+    uint32_t reserved1[11];
+
+    uint32_t pf_size;
+    uint32_t pf_flags;
+    uint32_t pf_fourcc;
+    uint32_t pf_rgb_bit_count;
+    uint32_t pf_r_bit_mask;
+    uint32_t pf_g_bit_mask;
+    uint32_t pf_b_bit_mask;
+    uint32_t pf_a_bit_mask;
+
+    uint32_t caps;
+    uint32_t caps2;
+    uint32_t caps3;
+    uint32_t caps4;
+    uint32_t reserved2;
+} DDSHeader;
+
+typedef struct DDSHeaderDX10
+{
+    uint32_t dxgi_format;
+    uint32_t resource_dimension;
+    uint32_t misc_flag;
+    uint32_t array_size;
+    uint32_t misc_flags2;
+} DDSHeaderDX10;
+
+static const struct
+{
+    uint32_t      dxgi_format;
+    Anvil::Format format;
+} g_dxgi_formats[] =
+{
+    {2,  Anvil::Format::R32G32B32A32_SFLOAT},
+    {10, Anvil::Format::R16G16B16A16_SFLOAT},
+    {28, Anvil::Format::R8G8B8A8_UNORM},
+    {29, Anvil::Format::R8G8B8A8_SRGB},
+    {49, Anvil::Format::R8G8_UNORM},
+    {61, Anvil::Format::R8_UNORM},
+    {71, Anvil::Format::BC1_RGBA_UNORM_BLOCK},
+    {72, Anvil::Format::BC1_RGBA_SRGB_BLOCK},
+    {74, Anvil::Format::BC2_UNORM_BLOCK},
+    {75, Anvil::Format::BC2_SRGB_BLOCK},
+    {77, Anvil::Format::BC3_UNORM_BLOCK},
+    {78, Anvil::Format::BC3_SRGB_BLOCK},
+    {80, Anvil::Format::BC4_UNORM_BLOCK},
+    {81, Anvil::Format::BC4_SNORM_BLOCK},
+    {83, Anvil::Format::BC5_UNORM_BLOCK},
+    {84, Anvil::Format::BC5_SNORM_BLOCK},
+    {87, Anvil::Format::B8G8R8A8_UNORM},
+    {91, Anvil::Format::B8G8R8A8_SRGB},
+    {95, Anvil::Format::BC6H_UFLOAT_BLOCK},
+    {96, Anvil::Format::BC6H_SFLOAT_BLOCK},
+    {98, Anvil::Format::BC7_UNORM_BLOCK},
+    {99, Anvil::Format::BC7_SRGB_BLOCK},
+};
+
+static const struct
+{
+    char          fourcc[5];
+    Anvil::Format format;
+} g_dds_fourcc_formats[] =
+{
+    {"ATI1", Anvil::Format::BC4_UNORM_BLOCK},
+    {"ATI2", Anvil::Format::BC5_UNORM_BLOCK},
+    {"BC4S", Anvil::Format::BC4_SNORM_BLOCK},
+    {"BC4U", Anvil::Format::BC4_UNORM_BLOCK},
+    {"BC5S", Anvil::Format::BC5_SNORM_BLOCK},
+    {"BC5U", Anvil::Format::BC5_UNORM_BLOCK},
+    {"DXT1", Anvil::Format::BC1_RGBA_UNORM_BLOCK},
+    {"DXT2", Anvil::Format::BC2_UNORM_BLOCK},
+    {"DXT3", Anvil::Format::BC2_UNORM_BLOCK},
+    {"DXT4", Anvil::Format::BC3_UNORM_BLOCK},
+    {"DXT5", Anvil::Format::BC3_UNORM_BLOCK},
+};
+
+/* D3DFMT values which legacy DDS files store in the FourCC field */
+static const uint32_t g_d3dfmt_a16b16g16r16f = 113;
+static const uint32_t g_d3dfmt_a32b32g32r32f = 116;
+
+/* KTX2 container definitions */
+static const unsigned char g_ktx2_identifier[] =
+{
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+};
+
+typedef struct KTX2Header
+{
+    unsigned char identifier[12];
+    uint32_t      vk_format;
+    uint32_t      type_size;
+    uint32_t      pixel_width;
+    uint32_t      pixel_height;
+    uint32_t      pixel_depth;
+    uint32_t      layer_count;
+    uint32_t      face_count;
+    uint32_t      level_count;
+    uint32_t      supercompression_scheme;
+
+    uint32_t      dfd_byte_offset;
+    uint32_t      dfd_byte_length;
+    uint32_t      kvd_byte_offset;
+    uint32_t      kvd_byte_length;
+    uint64_t      sgd_byte_offset;
+    uint64_t      sgd_byte_length;
+} KTX2Header;
+
+typedef struct KTX2LevelIndexEntry
+{
+    uint64_t byte_offset;
+    uint64_t byte_length;
+    uint64_t uncompressed_byte_length;
+} KTX2LevelIndexEntry;
+
+static_assert(sizeof(DDSHeader)           == 124, "DDS header size mismatch");
+static_assert(sizeof(DDSHeaderDX10)       == 20,  "DDS DX10 header size mismatch");
+static_assert(sizeof(KTX2Header)          == 80,  "KTX2 header size mismatch");
+static_assert(sizeof(KTX2LevelIndexEntry) == 24,  "KTX2 level index entry size mismatch");
+
+/** Returns the number of mips in a full mip chain of an image of the specified size. Mip counts stored in file
+ *  headers are clamped to this value, so that corrupt headers cannot make mip size computations shift past
+ *  the width of the base mip size. */
+static uint32_t get_n_mipmaps_in_full_chain(uint32_t in_width,
+                                            uint32_t in_height,
+                                            uint32_t in_depth)
+{
+    uint32_t max_size = std::max(std::max(in_width, in_height), in_depth);
+    uint32_t result   = 1;
+
+    while ((max_size >>= 1) > 0)
+    {
+        ++result;
+    }
+
+    return result;
+}
+
+
+/** Please see header for specification */
+Anvil::TextureFile::TextureFile(Anvil::MappedFileUniquePtr in_file_ptr)
+    :m_base_mip_depth (1),
+     m_base_mip_height(1),
+     m_base_mip_width (1),
+     m_data_ptr       (static_cast<const unsigned char*>(in_file_ptr->get_data_ptr() ) ),
+     m_data_size      (in_file_ptr->get_size() ),
+     m_file_ptr       (std::move(in_file_ptr) ),
+     m_file_type      (FileType::UNKNOWN),
+     m_format         (Anvil::Format::UNKNOWN),
+     m_image_type     (Anvil::ImageType::UNKNOWN),
+     m_is_cube_map    (false),
+     m_n_layers       (1),
+     m_n_mipmaps      (0)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::TextureFile::~TextureFile()
+{
+    /* Mip data needs to be released before the mapping it points to */
+    m_mipmaps.clear();
+}
+
+/** Creates MipmapRawData items for the specified mip of a range of layers, whose data is stored in a single,
+ *  tightly packed region of the mapped file.
+ *
+ *  @param in_n_mipmap   Index of the mip the data is for.
+ *  @param in_n_layer    Index of the first layer the data is for.
+ *  @param in_n_layers   Number of consecutive layers the data is for.
+ *  @param in_data_ptr   Start of the data region. Must point into the mapping.
+ *  @param in_data_size  Size of the data region. The region must not extend past the end of the mapping.
+ *
+ *  @return true if the region is large enough to hold the mip data, false otherwise.
+ */
+bool Anvil::TextureFile::add_mipmaps(uint32_t             in_n_mipmap,
+                                     uint32_t             in_n_layer,
+                                     uint32_t             in_n_layers,
+                                     const unsigned char* in_data_ptr,
+                                     size_t               in_data_size)
+{
+    const auto aspect        = (Anvil::Formats::has_depth_aspect(m_format) ) ? Anvil::ImageAspectFlagBits::DEPTH_BIT
+                                                                             : Anvil::ImageAspectFlagBits::COLOR_BIT;
+    uint64_t   expected_size = 0;
+    uint32_t   n_slices      = 0;
+    bool       result        = false;
+    uint32_t   row_size      = 0;
+    uint32_t   slice_size    = 0;
+
+    get_mipmap_layout(in_n_mipmap,
+                     &row_size,
+                     &slice_size,
+                     &n_slices);
+
+    /* Both factors are 32-bit, so the product cannot overflow. The layer count is applied only once the
+     * product is known to fit in the data region. */
+    expected_size = static_cast<uint64_t>(slice_size) * n_slices;
+
+    anvil_assert(in_data_ptr                >= m_data_ptr);
+    anvil_assert(in_data_ptr + in_data_size <= m_data_ptr + m_data_size);
+
+    if (expected_size == 0                                        ||
+        in_n_layers   == 0                                        ||
+        expected_size >  static_cast<uint64_t>(in_data_size) / in_n_layers)
+    {
+        goto end;
+    }
+
+    expected_size *= in_n_layers;
+
+    if (expected_size > UINT32_MAX)
+    {
+        goto end;
+    }
+
+    switch (m_image_type)
+    {
+        case Anvil::ImageType::_1D:
+        {
+            m_mipmaps.push_back(
+                Anvil::MipmapRawData::create_1D_array_from_uchar_ptr(aspect,
+                                                                     in_n_layer,
+                                                                     in_n_layers,
+                                                                     in_n_mipmap,
+                                                                     in_data_ptr,
+                                                                     row_size,
+                                                                     static_cast<uint32_t>(expected_size) )
+            );
+
+            break;
+        }
+
+        case Anvil::ImageType::_2D:
+        {
+            m_mipmaps.push_back(
+                Anvil::MipmapRawData::create_2D_array_from_uchar_ptr(aspect,
+                                                                     in_n_layer,
+                                                                     in_n_layers,
+                                                                     in_n_mipmap,
+                                                                     in_data_ptr,
+                                                                     static_cast<uint32_t>(expected_size),
+                                                                     row_size)
+            );
+
+            break;
+        }
+
+        case Anvil::ImageType::_3D:
+        {
+            anvil_assert(in_n_layer  == 0);
+            anvil_assert(in_n_layers == 1);
+
+            m_mipmaps.push_back(
+                Anvil::MipmapRawData::create_3D_from_uchar_ptr(aspect,
+                                                               in_n_layer,
+                                                               n_slices,
+                                                               in_n_mipmap,
+                                                               in_data_ptr,
+                                                               slice_size,
+                                                               row_size)
+            );
+
+            break;
+        }
+
+        default:
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::TextureFileUniquePtr Anvil::TextureFile::create(const std::string& in_filename)
+{
+    const void*                 data_ptr  = nullptr;
+    size_t                      data_size = 0;
+    Anvil::MappedFileUniquePtr  file_ptr  = Anvil::MappedFile::create(in_filename);
+    Anvil::TextureFileUniquePtr result_ptr(nullptr,
+                                           std::default_delete<Anvil::TextureFile>() );
+
+    if (file_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    data_ptr  = file_ptr->get_data_ptr();
+    data_size = file_ptr->get_size    ();
+
+    result_ptr.reset(
+        new Anvil::TextureFile(std::move(file_ptr) )
+    );
+
+    if (data_size >= sizeof(g_ktx2_identifier) &&
+        memcmp(data_ptr,
+               g_ktx2_identifier,
+               sizeof(g_ktx2_identifier) ) == 0)
+    {
+        if (!result_ptr->init_ktx2() )
+        {
+            result_ptr.reset();
+        }
+    }
+    else
+    if (data_size >= sizeof(g_dds_magic) &&
+        memcmp(data_ptr,
+              &g_dds_magic,
+               sizeof(g_dds_magic) ) == 0)
+    {
+        if (!result_ptr->init_dds() )
+        {
+            result_ptr.reset();
+        }
+    }
+    else
+    {
+        result_ptr.reset();
+    }
+
+end:
+    return result_ptr;
+}
+
+/** Please see header for specification */
+Anvil::ImageCreateInfoUniquePtr Anvil::TextureFile::create_image_create_info(const Anvil::BaseDevice*  in_device_ptr,
+                                                                             Anvil::ImageUsageFlags    in_usage,
+                                                                             Anvil::QueueFamilyFlags   in_queue_families,
+                                                                             Anvil::SharingMode        in_sharing_mode,
+                                                                             Anvil::ImageLayout        in_post_alloc_image_layout,
+                                                                             Anvil::MemoryFeatureFlags in_memory_features) const
+{
+    anvil_assert(in_device_ptr != nullptr);
+
+    return Anvil::ImageCreateInfo::create_alloc(in_device_ptr,
+                                                m_image_type,
+                                                m_format,
+                                                Anvil::ImageTiling::OPTIMAL,
+                                                in_usage | Anvil::ImageUsageFlagBits::TRANSFER_DST_BIT,
+                                                m_base_mip_width,
+                                                m_base_mip_height,
+                                                m_base_mip_depth,
+                                                m_n_layers,
+                                                Anvil::SampleCountFlagBits::_1_BIT,
+                                                in_queue_families,
+                                                in_sharing_mode,
+                                                (m_n_mipmaps > 1), /* in_use_full_mipmap_chain */
+                                                in_memory_features,
+                                                (m_is_cube_map) ? Anvil::ImageCreateFlagBits::CUBE_COMPATIBLE_BIT
+                                                                : Anvil::ImageCreateFlagBits::NONE,
+                                                in_post_alloc_image_layout,
+                                               &m_mipmaps);
+}
+
+/** Computes the layout of the tightly packed data of a single layer of the specified mip.
+ *
+ *  @param in_n_mipmap        Index of the mip to use.
+ *  @param out_row_size_ptr   Deref will be set to the size of a single row of texels (or texel blocks). Must not be null.
+ *  @param out_slice_size_ptr Deref will be set to the size of a single 2D slice. Must not be null.
+ *  @param out_n_slices_ptr   Deref will be set to the number of slices. Must not be null.
+ *
+ *  Sizes are set to 0 if the format's texel size cannot be determined, or if they do not fit in 32 bits.
+ */
+void Anvil::TextureFile::get_mipmap_layout(uint32_t  in_n_mipmap,
+                                           uint32_t* out_row_size_ptr,
+                                           uint32_t* out_slice_size_ptr,
+                                           uint32_t* out_n_slices_ptr) const
+{
+    uint32_t mip_depth  = 1;
+    uint32_t mip_height = 1;
+    uint32_t mip_width  = 1;
+    uint64_t row_size   = 0;
+    uint64_t slice_size = 0;
+
+    /* Mip counts are clamped to the length of the full mip chain at load time, so the shifts below never reach
+     * the width of the operands. */
+    anvil_assert(in_n_mipmap < m_n_mipmaps);
+
+    if (in_n_mipmap < 32)
+    {
+        mip_depth  = std::max(m_base_mip_depth  >> in_n_mipmap, 1u);
+        mip_height = std::max(m_base_mip_height >> in_n_mipmap, 1u);
+        mip_width  = std::max(m_base_mip_width  >> in_n_mipmap, 1u);
+    }
+
+    *out_n_slices_ptr   = (m_image_type == Anvil::ImageType::_3D) ? mip_depth : 1;
+    *out_row_size_ptr   = 0;
+    *out_slice_size_ptr = 0;
+
+    if (Anvil::Formats::is_format_compressed(m_format) )
+    {
+        uint32_t block_size[2]     = {0, 0};
+        uint32_t n_bytes_per_block = 0;
+
+        if (Anvil::Formats::get_compressed_format_block_size(m_format,
+                                                             block_size,
+                                                            &n_bytes_per_block) &&
+            block_size[0] > 0                                                    &&
+            block_size[1] > 0)
+        {
+            row_size   = ((static_cast<uint64_t>(mip_width)  + block_size[0] - 1) / block_size[0]) * n_bytes_per_block;
+            slice_size = ((static_cast<uint64_t>(mip_height) + block_size[1] - 1) / block_size[1]) * row_size;
+        }
+    }
+    else
+    {
+        uint32_t n_bits[4] = {0, 0, 0, 0};
+
+        Anvil::Formats::get_format_n_component_bits_nonyuv(m_format,
+                                                          &n_bits[0],
+                                                          &n_bits[1],
+                                                          &n_bits[2],
+                                                          &n_bits[3]);
+
+        row_size   = static_cast<uint64_t>(mip_width) * ( (n_bits[0] + n_bits[1] + n_bits[2] + n_bits[3]) / 8);
+        slice_size = mip_height * row_size;
+    }
+
+    /* Rows are at most 2^32 texels (or blocks) of up to 32 bytes each, so the row size cannot overflow. The slice
+     * size can only wrap around if the row size does not fit in 32 bits, in which case both are discarded. */
+    if (row_size   <= UINT32_MAX &&
+        slice_size <= UINT32_MAX)
+    {
+        *out_row_size_ptr   = static_cast<uint32_t>(row_size);
+        *out_slice_size_ptr = static_cast<uint32_t>(slice_size);
+    }
+}
+
+/** Parses a DDS file and creates MipmapRawData items for all subresources it holds.
+ *
+ *  Subresource data of DDS files is stored layer-major, so a separate item is created for each layer and mip.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::TextureFile::init_dds()
+{
+    size_t    data_offset = sizeof(g_dds_magic) + sizeof(DDSHeader);
+    DDSHeader header;
+    uint32_t  n_faces     = 1;
+    bool      result      = false;
+
+    m_file_type = FileType::DDS;
+
+    if (m_data_size < data_offset)
+    {
+        goto end;
+    }
+
+    memcpy(&header,
+            m_data_ptr + sizeof(g_dds_magic),
+            sizeof(header) );
+
+    if (header.size    != sizeof(DDSHeader) ||
+        header.pf_size != 32)
+    {
+        goto end;
+    }
+
+    m_base_mip_width  = std::max(header.width,  1u);
+    m_base_mip_height = std::max(header.height, 1u);
+    m_image_type      = Anvil::ImageType::_2D;
+    m_n_mipmaps       = ((header.flags & g_dds_flag_mipmap_count) != 0 && header.mip_map_count > 0) ? header.mip_map_count
+                                                                                                   : 1;
+
+    if ((header.pf_flags & g_dds_pf_flag_fourcc) != 0 &&
+        memcmp(&header.pf_fourcc,
+               "DX10",
+               sizeof(header.pf_fourcc) ) == 0)
+    {
+        DDSHeaderDX10 header_dx10;
+
+        if (m_data_size < data_offset + sizeof(DDSHeaderDX10) )
+        {
+            goto end;
+        }
+
+        memcpy(&header_dx10,
+                m_data_ptr + data_offset,
+                sizeof(header_dx10) );
+
+        data_offset += sizeof(DDSHeaderDX10);
+
+        for (const auto& current_format : g_dxgi_formats)
+        {
+            if (current_format.dxgi_format == header_dx10.dxgi_format)
+            {
+                m_format = current_format.format;
+
+                break;
+            }
+        }
+
+        if (header_dx10.resource_dimension == g_dx10_dimension_1D)
+        {
+            m_base_mip_height = 1;
+            m_image_type      = Anvil::ImageType::_1D;
+        }
+        else
+        if (header_dx10.resource_dimension == g_dx10_dimension_3D)
+        {
+            m_base_mip_depth = std::max(header.depth, 1u);
+            m_image_type     = Anvil::ImageType::_3D;
+        }
+
+        if ((header_dx10.misc_flag & g_dx10_misc_flag_cube) != 0)
+        {
+            m_is_cube_map = true;
+            n_faces       = 6;
+        }
+
+        if (header_dx10.array_size > UINT32_MAX / n_faces)
+        {
+            goto end;
+        }
+
+        m_n_layers = std::max(header_dx10.array_size, 1u) * n_faces;
+    }
+    else
+    {
+        if ((header.pf_flags & g_dds_pf_flag_fourcc) != 0)
+        {
+            for (const auto& current_format : g_dds_fourcc_formats)
+            {
+                if (memcmp(&header.pf_fourcc,
+                           current_format.fourcc,
+                           sizeof(header.pf_fourcc) ) == 0)
+                {
+                    m_format = current_format.format;
+
+                    break;
+                }
+            }
+
+            if (header.pf_fourcc == g_d3dfmt_a16b16g16r16f)
+            {
+                m_format = Anvil::Format::R16G16B16A16_SFLOAT;
+            }
+            else
+            if (header.pf_fourcc == g_d3dfmt_a32b32g32r32f)
+            {
+                m_format = Anvil::Format::R32G32B32A32_SFLOAT;
+            }
+        }
+        else
+        if ((header.pf_flags & g_dds_pf_flag_rgb) != 0 &&
+             header.pf_rgb_bit_count              == 32)
+        {
+            if (header.pf_r_bit_mask == 0x000000FF)
+            {
+                m_format = Anvil::Format::R8G8B8A8_UNORM;
+            }
+            else
+            if (header.pf_r_bit_mask == 0x00FF0000)
+            {
+                m_format = Anvil::Format::B8G8R8A8_UNORM;
+            }
+        }
+
+        if ((header.caps2 & g_dds_caps2_volume) != 0)
+        {
+            m_base_mip_depth = std::max(header.depth, 1u);
+            m_image_type     = Anvil::ImageType::_3D;
+        }
+
+        /* Legacy cube map files which do not hold all six faces are not supported */
+        if ((header.caps2 & g_dds_caps2_cubemap) != 0)
+        {
+            m_is_cube_map = true;
+            m_n_layers    = 6;
+        }
+    }
+
+    if (m_format == Anvil::Format::UNKNOWN)
+    {
+        goto end;
+    }
+
+    if (m_image_type == Anvil::ImageType::_3D &&
+        m_n_layers   != 1)
+    {
+        goto end;
+    }
+
+    m_n_mipmaps = std::min(m_n_mipmaps,
+                           get_n_mipmaps_in_full_chain(m_base_mip_width,
+                                                       m_base_mip_height,
+                                                       m_base_mip_depth) );
+
+    for (uint32_t n_layer = 0;
+                  n_layer < m_n_layers;
+                ++n_layer)
+    {
+        for (uint32_t n_mipmap = 0;
+                      n_mipmap < m_n_mipmaps;
+                    ++n_mipmap)
+        {
+            uint32_t n_slices   = 0;
+            uint32_t row_size   = 0;
+            uint32_t slice_size = 0;
+            uint64_t mip_size   = 0;
+
+            get_mipmap_layout(n_mipmap,
+                             &row_size,
+                             &slice_size,
+                             &n_slices);
+
+            mip_size = static_cast<uint64_t>(slice_size) * n_slices;
+
+            if (data_offset > m_data_size ||
+                !add_mipmaps(n_mipmap,
+                             n_layer,
+                             1, /* in_n_layers */
+                             m_data_ptr  + data_offset,
+                             m_data_size - data_offset) )
+            {
+                goto end;
+            }
+
+            /* add_mipmaps() has verified the mip fits in the remaining part of the file */
+            data_offset += static_cast<size_t>(mip_size);
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Parses a KTX2 file and creates MipmapRawData items for all subresources it holds.
+ *
+ *  KTX2 files store all layers and faces of a mip in one region, so a single item is created for each mip.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::TextureFile::init_ktx2()
+{
+    KTX2Header header;
+    uint32_t   n_faces = 1;
+    bool       result  = false;
+
+    m_file_type = FileType::KTX2;
+
+    if (m_data_size < sizeof(KTX2Header) )
+    {
+        goto end;
+    }
+
+    memcpy(&header,
+            m_data_ptr,
+            sizeof(header) );
+
+    /* Supercompressed files would require transcoding, which defeats the purpose of the loader */
+    if (header.supercompression_scheme != 0                                 ||
+        header.vk_format               == VK_FORMAT_UNDEFINED               ||
+        header.vk_format               >= VK_FORMAT_RANGE_SIZE              ||
+        header.pixel_width             == 0                                 ||
+        (header.face_count             != 1 && header.face_count != 6) )
+    {
+        goto end;
+    }
+
+    m_format = static_cast<Anvil::Format>(header.vk_format);
+
+    if (header.pixel_height == 0)
+    {
+        m_image_type = Anvil::ImageType::_1D;
+    }
+    else
+    if (header.pixel_depth > 0)
+    {
+        m_base_mip_depth = header.pixel_depth;
+        m_image_type     = Anvil::ImageType::_3D;
+    }
+    else
+    {
+        m_image_type = Anvil::ImageType::_2D;
+    }
+
+    if (header.face_count == 6)
+    {
+        m_is_cube_map = true;
+        n_faces       = 6;
+    }
+
+    if (header.layer_count > UINT32_MAX / n_faces)
+    {
+        goto end;
+    }
+
+    m_base_mip_height = std::max(header.pixel_height, 1u);
+    m_base_mip_width  = header.pixel_width;
+    m_n_layers        = std::max(header.layer_count, 1u) * n_faces;
+    m_n_mipmaps       = std::min(std::max(header.level_count, 1u),
+                                 get_n_mipmaps_in_full_chain(m_base_mip_width,
+                                                             m_base_mip_height,
+                                                             m_base_mip_depth) );
+
+    if (m_image_type == Anvil::ImageType::_3D &&
+        m_n_layers   != 1)
+    {
+        goto end;
+    }
+
+    if (m_data_size < sizeof(KTX2Header) + static_cast<size_t>(m_n_mipmaps) * sizeof(KTX2LevelIndexEntry) )
+    {
+        goto end;
+    }
+
+    for (uint32_t n_mipmap = 0;
+                  n_mipmap < m_n_mipmaps;
+                ++n_mipmap)
+    {
+        KTX2LevelIndexEntry level_index_entry;
+
+        memcpy(&level_index_entry,
+                m_data_ptr + sizeof(KTX2Header) + n_mipmap * sizeof(KTX2LevelIndexEntry),
+                sizeof(level_index_entry) );
+
+        if (level_index_entry.byte_offset > m_data_size ||
+            level_index_entry.byte_length > m_data_size - level_index_entry.byte_offset)
+        {
+            goto end;
+        }
+
+        if (!add_mipmaps(n_mipmap,
+                         0, /* in_n_layer */
+                         m_n_layers,
+                         m_data_ptr + level_index_entry.byte_offset,
+                         static_cast<size_t>(level_index_entry.byte_length) ) )
+        {
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
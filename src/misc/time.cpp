@@ -21,6 +21,7 @@
 //
 
 #include "misc/time.h"
+#include "misc/types.h"
 
 
 /** Please see header for specification */
@@ -37,7 +38,7 @@ Anvil::Time::Time()
 
         clock_gettime(CLOCK_MONOTONIC, &current_timespec);
 
-        m_start_time = static_cast<uint64_t>(1000LL /* SEC_TO_MSEC */ * current_timespec.tv_sec + current_timespec.tv_nsec / 1000000LL /* MSEC_TO_NSEC */);
+        m_start_time = static_cast<uint64_t>(1000000000LL /* SEC_TO_NSEC */ * current_timespec.tv_sec + current_timespec.tv_nsec);
     }
     #endif
 }
@@ -48,18 +49,93 @@ Anvil::Time::~Time()
     /* Stub */
 }
 
+/** Please see header for specification */
+uint64_t Anvil::Time::convert_device_time_to_nsec(uint64_t                           in_device_time_nsec,
+                                                  const Anvil::TimestampCalibration& in_calibration) const
+{
+    const int64_t calibration_time_nsec = static_cast<int64_t>(convert_raw_host_timestamp_to_nsec(in_calibration.host_timestamp) );
+    const int64_t device_delta_nsec     = static_cast<int64_t>(in_device_time_nsec - in_calibration.device_time_nsec);
+    const int64_t result                = calibration_time_nsec + device_delta_nsec;
+
+    return (result > 0) ? static_cast<uint64_t>(result)
+                        : 0;
+}
+
+/** Please see header for specification */
+uint64_t Anvil::Time::convert_raw_host_timestamp_to_nsec(uint64_t in_raw_host_timestamp) const
+{
+    uint64_t result = 0;
+
+    #ifdef _WIN32
+    {
+        if (in_raw_host_timestamp > static_cast<uint64_t>(m_start_time.QuadPart) )
+        {
+            const uint64_t n_ticks = in_raw_host_timestamp - static_cast<uint64_t>(m_start_time.QuadPart);
+
+            result = (n_ticks / m_frequency.QuadPart) * 1000000000ULL /* SEC_TO_NSEC */ +
+                     (n_ticks % m_frequency.QuadPart) * 1000000000ULL /* SEC_TO_NSEC */ / m_frequency.QuadPart;
+        }
+    }
+    #else
+    {
+        if (in_raw_host_timestamp > m_start_time)
+        {
+            result = in_raw_host_timestamp - m_start_time;
+        }
+    }
+    #endif
+
+    return result;
+}
+
+/** Please see header for specification */
+uint64_t Anvil::Time::get_raw_host_timestamp()
+{
+    uint64_t result = 0;
+
+    #ifdef _WIN32
+    {
+        LARGE_INTEGER current_time;
+
+        QueryPerformanceCounter(&current_time);
+
+        result = static_cast<uint64_t>(current_time.QuadPart);
+    }
+    #else
+    {
+        struct timespec current_timespec;
+
+        clock_gettime(CLOCK_MONOTONIC, &current_timespec);
+
+        result = static_cast<uint64_t>(1000000000LL /* SEC_TO_NSEC */ * current_timespec.tv_sec + current_timespec.tv_nsec);
+    }
+    #endif
+
+    return result;
+}
+
 /** Please see header for specification */
 uint64_t Anvil::Time::get_time_in_msec()
+{
+    return get_time_in_nsec() / 1000000ULL /* MSEC_TO_NSEC */;
+}
+
+/** Please see header for specification */
+uint64_t Anvil::Time::get_time_in_nsec()
 {
     uint64_t result = 0;
 
     #ifdef _WIN32
     {
         LARGE_INTEGER current_time;
+        uint64_t      n_ticks;
 
         QueryPerformanceCounter(&current_time);
 
-        result = static_cast<uint64_t>(((current_time.QuadPart - m_start_time.QuadPart) * 1000LL /* ms in s */ / m_frequency.QuadPart));
+        /* Split the conversion into whole seconds & remainder, so that the multiplication does not overflow */
+        n_ticks = static_cast<uint64_t>(current_time.QuadPart - m_start_time.QuadPart);
+        result  = (n_ticks / m_frequency.QuadPart) * 1000000000ULL /* SEC_TO_NSEC */ +
+                  (n_ticks % m_frequency.QuadPart) * 1000000000ULL /* SEC_TO_NSEC */ / m_frequency.QuadPart;
     }
     #else
     {
@@ -67,7 +143,7 @@ uint64_t Anvil::Time::get_time_in_msec()
 
         clock_gettime(CLOCK_MONOTONIC, &current_timespec);
 
-        result = 1000LL /* SEC_TO_MSEC */ * current_timespec.tv_sec + current_timespec.tv_nsec / 1000000LL /* MSEC_TO_NSEC */ - m_start_time;
+        result = 1000000000LL /* SEC_TO_NSEC */ * current_timespec.tv_sec + current_timespec.tv_nsec - m_start_time;
     }
     #endif
 
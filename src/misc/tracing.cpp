@@ -0,0 +1,352 @@
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/io.h"
+#include "misc/time.h"
+#include "misc/tracing.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+
+
+namespace
+{
+    typedef struct Span
+    {
+        uint64_t    end_time;
+        const char* name;
+        uint64_t    start_time;
+
+        Span(const char* in_name,
+             uint64_t    in_start_time,
+             uint64_t    in_end_time)
+            :end_time  (in_end_time),
+             name      (in_name),
+             start_time(in_start_time)
+        {
+            /* Stub */
+        }
+    } Span;
+
+    /* Span executed by the device, already moved onto the CPU timeline. */
+    typedef struct DeviceSpan
+    {
+        uint64_t    end_time;
+        std::string name;
+        uint64_t    start_time;
+
+        DeviceSpan(const std::string& in_name,
+                   uint64_t           in_start_time,
+                   uint64_t           in_end_time)
+            :end_time  (in_end_time),
+             name      (in_name),
+             start_time(in_start_time)
+        {
+            /* Stub */
+        }
+    } DeviceSpan;
+
+    /* Spans recorded by a single thread. Buffers are shared with the global registry, so that their contents
+     * survive the threads which recorded them.
+     */
+    typedef struct ThreadBuffer
+    {
+        std::mutex        mutex;
+        std::vector<Span> spans;
+        uint32_t          thread_index;
+
+        explicit ThreadBuffer(uint32_t in_thread_index)
+            :thread_index(in_thread_index)
+        {
+            /* Stub */
+        }
+    } ThreadBuffer;
+
+    /* Thread ID device spans are exported with. Chosen so that it never collides with CPU thread indices. */
+    const uint32_t g_device_track_tid = 0x7FFFFFFF;
+
+    std::vector<DeviceSpan>                    g_device_spans;
+    std::mutex                                 g_device_spans_mutex;
+    std::atomic<const Anvil::Tracer::Hooks*>   g_hooks_ptr        (nullptr);
+    std::atomic<bool>                          g_recording_enabled(false);
+    std::vector<std::shared_ptr<ThreadBuffer> > g_thread_buffers;
+    std::mutex                                 g_thread_buffers_mutex;
+
+    thread_local std::shared_ptr<ThreadBuffer> t_thread_buffer_ptr;
+
+    Anvil::Time& get_epoch()
+    {
+        static Anvil::Time epoch;
+
+        return epoch;
+    }
+
+    ThreadBuffer* get_thread_buffer()
+    {
+        if (t_thread_buffer_ptr == nullptr)
+        {
+            std::unique_lock<std::mutex> lock(g_thread_buffers_mutex);
+
+            t_thread_buffer_ptr.reset(
+                new ThreadBuffer(static_cast<uint32_t>(g_thread_buffers.size() ))
+            );
+
+            g_thread_buffers.push_back(t_thread_buffer_ptr);
+        }
+
+        return t_thread_buffer_ptr.get();
+    }
+
+    /* Appends a Chrome trace event describing a complete span to @param inout_json_ptr. Times are in nanoseconds. */
+    void append_span_event(const char*  in_name,
+                           uint64_t     in_start_time,
+                           uint64_t     in_end_time,
+                           uint32_t     in_tid,
+                           bool*        inout_is_first_event_ptr,
+                           std::string* inout_json_ptr)
+    {
+        char event_data[128];
+
+        if (!*inout_is_first_event_ptr)
+        {
+            *inout_json_ptr += ",";
+        }
+
+        *inout_json_ptr += "\n{\"name\":\"";
+
+        for (const char* current_char_ptr = in_name;
+                        *current_char_ptr != '\0';
+                       ++current_char_ptr)
+        {
+            if (*current_char_ptr == '"'  ||
+                *current_char_ptr == '\\')
+            {
+                *inout_json_ptr += '\\';
+            }
+
+            *inout_json_ptr += *current_char_ptr;
+        }
+
+        /* Chrome expects timestamps & durations in microseconds */
+        snprintf(event_data,
+                 sizeof(event_data),
+                 "\",\"cat\":\"anvil\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                 static_cast<double>(in_start_time)               / 1000.0,
+                 static_cast<double>(in_end_time - in_start_time) / 1000.0,
+                 in_tid);
+
+        *inout_json_ptr           += event_data;
+        *inout_is_first_event_ptr  = false;
+    }
+}
+
+
+/** Please see header for specification */
+uint64_t Anvil::Tracer::begin_span(const char* in_name)
+{
+    const Hooks* hooks_ptr = g_hooks_ptr.load(std::memory_order_acquire);
+    uint64_t     result    = UINT64_MAX;
+
+    if (hooks_ptr                  != nullptr &&
+        hooks_ptr->begin_span_func != nullptr)
+    {
+        hooks_ptr->begin_span_func(in_name,
+                                   hooks_ptr->user_arg);
+    }
+
+    if (g_recording_enabled.load(std::memory_order_relaxed) )
+    {
+        result = get_epoch().get_time_in_nsec();
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::Tracer::clear()
+{
+    std::unique_lock<std::mutex> lock(g_thread_buffers_mutex);
+
+    for (auto& current_buffer_ptr : g_thread_buffers)
+    {
+        std::unique_lock<std::mutex> buffer_lock(current_buffer_ptr->mutex);
+
+        current_buffer_ptr->spans.clear();
+    }
+
+    {
+        std::unique_lock<std::mutex> device_spans_lock(g_device_spans_mutex);
+
+        g_device_spans.clear();
+    }
+}
+
+/** Please see header for specification */
+void Anvil::Tracer::end_span(const char* in_name,
+                             uint64_t    in_start_time)
+{
+    const Hooks* hooks_ptr = g_hooks_ptr.load(std::memory_order_acquire);
+
+    if (in_start_time != UINT64_MAX)
+    {
+        const uint64_t end_time   = get_epoch().get_time_in_nsec();
+        ThreadBuffer*  buffer_ptr = get_thread_buffer();
+
+        std::unique_lock<std::mutex> lock(buffer_ptr->mutex);
+
+        buffer_ptr->spans.push_back(
+            Span(in_name,
+                 in_start_time,
+                 end_time)
+        );
+    }
+
+    if (hooks_ptr                != nullptr &&
+        hooks_ptr->end_span_func != nullptr)
+    {
+        hooks_ptr->end_span_func(in_name,
+                                 hooks_ptr->user_arg);
+    }
+}
+
+/** Please see header for specification */
+bool Anvil::Tracer::export_chrome_json(const std::string& in_filename)
+{
+    return Anvil::IO::write_text_file(in_filename,
+                                      get_chrome_json() );
+}
+
+/** Please see header for specification */
+std::string Anvil::Tracer::get_chrome_json()
+{
+    bool                         is_first_span = true;
+    std::unique_lock<std::mutex> lock         (g_thread_buffers_mutex);
+    std::string                  result       ("{\"traceEvents\":[");
+
+    for (auto& current_buffer_ptr : g_thread_buffers)
+    {
+        std::unique_lock<std::mutex> buffer_lock(current_buffer_ptr->mutex);
+
+        for (const auto& current_span : current_buffer_ptr->spans)
+        {
+            append_span_event(current_span.name,
+                              current_span.start_time,
+                              current_span.end_time,
+                              current_buffer_ptr->thread_index,
+                             &is_first_span,
+                             &result);
+        }
+    }
+
+    {
+        std::unique_lock<std::mutex> device_spans_lock(g_device_spans_mutex);
+
+        if (g_device_spans.size() > 0)
+        {
+            char metadata_event[128];
+
+            snprintf(metadata_event,
+                     sizeof(metadata_event),
+                     "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"GPU\"}}",
+                     is_first_span ? "" : ",",
+                     g_device_track_tid);
+
+            result        += metadata_event;
+            is_first_span  = false;
+        }
+
+        for (const auto& current_span : g_device_spans)
+        {
+            append_span_event(current_span.name.c_str(),
+                              current_span.start_time,
+                              current_span.end_time,
+                              g_device_track_tid,
+                             &is_first_span,
+                             &result);
+        }
+    }
+
+    result += "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::Tracer::is_compiled_in()
+{
+    #if defined(ANVIL_ENABLE_TRACING)
+    {
+        return true;
+    }
+    #else
+    {
+        return false;
+    }
+    #endif
+}
+
+/** Please see header for specification */
+bool Anvil::Tracer::is_recording_enabled()
+{
+    return g_recording_enabled;
+}
+
+/** Please see header for specification */
+void Anvil::Tracer::record_device_span(const std::string&                 in_name,
+                                       uint64_t                           in_device_start_time,
+                                       uint64_t                           in_device_end_time,
+                                       const Anvil::TimestampCalibration& in_calibration)
+{
+    if (g_recording_enabled.load(std::memory_order_relaxed) )
+    {
+        const uint64_t start_time = get_epoch().convert_device_time_to_nsec(in_device_start_time,
+                                                                            in_calibration);
+        const uint64_t end_time   = get_epoch().convert_device_time_to_nsec(std::max(in_device_start_time,
+                                                                                     in_device_end_time),
+                                                                            in_calibration);
+
+        std::unique_lock<std::mutex> lock(g_device_spans_mutex);
+
+        g_device_spans.push_back(
+            DeviceSpan(in_name,
+                       start_time,
+                       end_time)
+        );
+    }
+}
+
+/** Please see header for specification */
+void Anvil::Tracer::set_hooks(const Hooks* in_opt_hooks_ptr)
+{
+    g_hooks_ptr.store(in_opt_hooks_ptr,
+                      std::memory_order_release);
+}
+
+/** Please see header for specification */
+void Anvil::Tracer::set_recording_enabled(bool in_enabled)
+{
+    /* Make sure the epoch is established before any span can be recorded */
+    get_epoch();
+
+    g_recording_enabled = in_enabled;
+}
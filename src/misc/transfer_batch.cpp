@@ -0,0 +1,1414 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#include "misc/buffer_create_info.h"
+#include "misc/debug.h"
+#include "misc/fence_create_info.h"
+#include "misc/image_create_info.h"
+#include "misc/semaphore_create_info.h"
+#include "misc/transfer_batch.h"
+#include "wrappers/buffer.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/command_pool.h"
+#include "wrappers/device.h"
+#include "wrappers/fence.h"
+#include "wrappers/image.h"
+#include "wrappers/queue.h"
+#include "wrappers/semaphore.h"
+#include <algorithm>
+#include <map>
+#include <string.h>
+
+/* Buffer copies larger than this are split into chunks, which may execute on different queues. */
+#define COPY_CHUNK_SIZE (4 * 1024 * 1024)
+
+/* vkCmdUpdateBuffer() accepts at most 64 KB of data per call. */
+#define MAX_INLINE_UPDATE_SIZE (65536)
+
+
+/** Returns index of the queue which has the smallest amount of data assigned to it. */
+static uint32_t get_least_loaded_queue_index(const std::vector<VkDeviceSize>& in_queue_loads)
+{
+    return static_cast<uint32_t>(std::min_element(in_queue_loads.begin(),
+                                                  in_queue_loads.end  () ) - in_queue_loads.begin() );
+}
+
+
+/** Please see header for specification.
+ *
+ *  The lock is recursive, since wait() flushes pending transfers from within its locked section.
+ **/
+Anvil::TransferBatch::TransferBatch(const Anvil::BaseDevice*          in_device_ptr,
+                                    const std::vector<Anvil::Queue*>& in_queue_ptrs,
+                                    bool                              in_mt_safe)
+    :MTSafetySupportProvider         (in_mt_safe,
+                                      true), /* in_is_lock_recursive */
+     m_pending_decompressed_data_size(0),
+     m_device_ptr                    (in_device_ptr),
+     m_last_retired_token            (0),
+     m_next_token                    (1),
+     m_n_unlocked_fence_waits        (0),
+     m_queue_ptrs                    (in_queue_ptrs)
+{
+    const VkDeviceSize optimal_copy_offset_alignment = in_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits.optimal_buffer_copy_offset_alignment;
+
+    /* bufferOffset of buffer->image copy regions must be a multiple of 4 and of the texel block size. Texel blocks
+     * are at most 32 bytes large and may use a multiple of 3 bytes, hence the alignment below. */
+    m_staging_data_alignment = 3 * std::max(static_cast<VkDeviceSize>(32),
+                                            optimal_copy_offset_alignment);
+}
+
+/** Please see header for specification */
+Anvil::TransferBatch::~TransferBatch()
+{
+    flush();
+
+    for (auto& current_flush : m_in_flight_flushes)
+    {
+        m_device_ptr->get_dispatch_table().vkWaitForFences(m_device_ptr->get_device_vk(),
+                                                           1, /* fenceCount */
+                                                           current_flush.fence_ptr->get_fence_ptr(),
+                                                           VK_TRUE,     /* waitAll */
+                                                           UINT64_MAX); /* timeout */
+    }
+
+    /* Descriptor sets cached by the decompressor refer to the batch's buffers, so release them first. */
+    m_decompressor_ptr.reset();
+
+    m_in_flight_flushes.clear         ();
+    m_last_flush_semaphore_ptr.reset  ();
+    m_free_decompression_buffers.clear();
+    m_free_fences.clear               ();
+    m_free_semaphores.clear           ();
+    m_free_staging_buffers.clear      ();
+}
+
+/** Appends compressed chunks to the pending data storage and reserves space for their decompressed contents
+ *  in the decompression buffer.
+ *
+ *  @param in_n_chunks               Number of chunks to append. Must not be 0.
+ *  @param in_chunks_ptr             Chunks to append. Must not be null.
+ *  @param out_decompressed_size_ptr Deref will be set to the total decompressed size of the chunks. Must not be null.
+ *
+ *  @return Offset in the decompression buffer, under which the decompressed data is going to be stored.
+ */
+VkDeviceSize Anvil::TransferBatch::append_compressed_chunks(uint32_t               in_n_chunks,
+                                                            const CompressedChunk* in_chunks_ptr,
+                                                            VkDeviceSize*          out_decompressed_size_ptr)
+{
+    const VkDeviceSize result         = Anvil::Utils::round_up(m_pending_decompressed_data_size,
+                                                               m_staging_data_alignment);
+    VkDeviceSize       current_offset = result;
+
+    anvil_assert(m_decompressor_ptr != nullptr);
+    anvil_assert(in_chunks_ptr      != nullptr);
+    anvil_assert(in_n_chunks        >  0);
+
+    for (uint32_t n_chunk = 0;
+                  n_chunk < in_n_chunks;
+                ++n_chunk)
+    {
+        const auto&        current_chunk = in_chunks_ptr[n_chunk];
+        const VkDeviceSize src_offset    = static_cast<VkDeviceSize>(m_pending_data.size() );
+
+        anvil_assert(current_chunk.data_ptr          != nullptr);
+        anvil_assert(current_chunk.decompressed_size >  0);
+
+        /* Each chunk is written out in whole words, so only the last one may end mid-word. */
+        anvil_assert(n_chunk == in_n_chunks - 1                ||
+                     (current_chunk.decompressed_size % 4) == 0);
+
+        /* The shader reads compressed data at byte granularity, so there is no need to align it. */
+        m_pending_data.insert(m_pending_data.end(),
+                              static_cast<const unsigned char*>(current_chunk.data_ptr),
+                              static_cast<const unsigned char*>(current_chunk.data_ptr) + current_chunk.compressed_size);
+
+        m_pending_chunks.push_back(
+            Anvil::GPUDecompressor::ChunkInfo(static_cast<uint32_t>(src_offset),
+                                              current_chunk.compressed_size,
+                                              static_cast<uint32_t>(current_offset),
+                                              current_chunk.decompressed_size)
+        );
+
+        current_offset += current_chunk.decompressed_size;
+    }
+
+    m_pending_decompressed_data_size = current_offset;
+    *out_decompressed_size_ptr       = current_offset - result;
+
+    return result;
+}
+
+/** Appends user data to the pending data storage.
+ *
+ *  @param in_data Data to append. Must not be null.
+ *  @param in_size Number of bytes to append.
+ *
+ *  @return Offset, under which the data has been stored.
+ */
+VkDeviceSize Anvil::TransferBatch::append_data(const void*  in_data,
+                                               VkDeviceSize in_size)
+{
+    const VkDeviceSize result = Anvil::Utils::round_up(static_cast<VkDeviceSize>(m_pending_data.size() ),
+                                                       m_staging_data_alignment);
+
+    m_pending_data.resize(static_cast<size_t>(result + in_size) );
+
+    memcpy(&m_pending_data.at(static_cast<size_t>(result) ),
+           in_data,
+           static_cast<size_t>(in_size) );
+
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::TransferBatchUniquePtr Anvil::TransferBatch::create(const Anvil::BaseDevice* in_device_ptr,
+                                                           Anvil::Queue*            in_opt_queue_ptr,
+                                                           bool                     in_mt_safe,
+                                                           bool                     in_enable_gpu_decompression)
+{
+    std::vector<Anvil::Queue*> queue_ptrs;
+
+    if (in_opt_queue_ptr != nullptr)
+    {
+        queue_ptrs.push_back(in_opt_queue_ptr);
+    }
+    else
+    if (in_enable_gpu_decompression)
+    {
+        queue_ptrs.push_back(
+            (in_device_ptr->get_n_compute_queues() > 0) ? in_device_ptr->get_compute_queue  (0)
+                                                        : in_device_ptr->get_universal_queue(0)
+        );
+    }
+    else
+    if (in_device_ptr->get_n_transfer_queues() > 0)
+    {
+        for (uint32_t n_queue = 0;
+                      n_queue < in_device_ptr->get_n_transfer_queues();
+                    ++n_queue)
+        {
+            queue_ptrs.push_back(in_device_ptr->get_transfer_queue(n_queue) );
+        }
+    }
+    else
+    {
+        queue_ptrs.push_back(in_device_ptr->get_universal_queue(0) );
+    }
+
+    return create(in_device_ptr,
+                  queue_ptrs,
+                  in_mt_safe,
+                  in_enable_gpu_decompression);
+}
+
+/** Please see header for specification */
+Anvil::TransferBatchUniquePtr Anvil::TransferBatch::create(const Anvil::BaseDevice*          in_device_ptr,
+                                                           const std::vector<Anvil::Queue*>& in_queue_ptrs,
+                                                           bool                              in_mt_safe,
+                                                           bool                              in_enable_gpu_decompression)
+{
+    Anvil::TransferBatchUniquePtr result_ptr(nullptr,
+                                             std::default_delete<Anvil::TransferBatch>() );
+
+    if (in_queue_ptrs.size() == 0                                                        ||
+        std::find(in_queue_ptrs.begin(), in_queue_ptrs.end(), nullptr) != in_queue_ptrs.end() )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    result_ptr.reset(
+        new Anvil::TransferBatch(in_device_ptr,
+                                 in_queue_ptrs,
+                                 in_mt_safe)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init(in_enable_gpu_decompression) )
+        {
+            result_ptr.reset();
+        }
+    }
+
+end:
+    return result_ptr;
+}
+
+/** Assigns pending copies to the batch's queues, balancing the number of bytes each queue has to copy.
+ *
+ *  Writes to a buffer are spread independently of one another only if none of them overlap, in which case large
+ *  copies are also split into COPY_CHUNK_SIZE-sized chunks. Otherwise, all writes to the buffer are assigned to
+ *  a single queue, in the order they were queued in. All uploads to a single image are assigned to a single queue,
+ *  as their layout transitions depend on each other. Copies which read decompressed data are always assigned
+ *  to the first queue, which executes the decompression dispatch.
+ *
+ *  @param out_buffer_copies_per_queue_ptr Deref will be filled with buffer copies per queue. Must not be null.
+ *                                         Must hold as many vectors as there are queues.
+ *  @param out_image_copies_per_queue_ptr  Deref will be filled with image copies per queue. Must not be null.
+ *                                         Must hold as many vectors as there are queues.
+ */
+void Anvil::TransferBatch::distribute_copies(std::vector<std::vector<BufferCopyItem> >*       out_buffer_copies_per_queue_ptr,
+                                             std::vector<std::vector<const ImageCopyItem*> >* out_image_copies_per_queue_ptr) const
+{
+    std::vector<Anvil::Buffer*>                   buffer_ptrs;
+    std::map<Anvil::Buffer*, std::vector<size_t> > buffer_to_copy_indices_map;
+    std::map<Anvil::Image*,  uint32_t>             image_to_queue_index_map;
+    std::vector<VkDeviceSize>                     queue_loads(m_queue_ptrs.size(), 0);
+
+    if (m_queue_ptrs.size() == 1)
+    {
+        out_buffer_copies_per_queue_ptr->at(0) = m_pending_buffer_copies;
+
+        for (const auto& current_image_copy : m_pending_image_copies)
+        {
+            out_image_copies_per_queue_ptr->at(0).push_back(&current_image_copy);
+        }
+
+        return;
+    }
+
+    for (size_t n_buffer_copy = 0;
+                n_buffer_copy < m_pending_buffer_copies.size();
+              ++n_buffer_copy)
+    {
+        auto buffer_ptr = m_pending_buffer_copies.at(n_buffer_copy).buffer_ptr;
+
+        if (buffer_to_copy_indices_map.find(buffer_ptr) == buffer_to_copy_indices_map.end() )
+        {
+            buffer_ptrs.push_back(buffer_ptr);
+        }
+
+        buffer_to_copy_indices_map[buffer_ptr].push_back(n_buffer_copy);
+    }
+
+    for (const auto& current_buffer_ptr : buffer_ptrs)
+    {
+        const auto&                                         copy_indices           = buffer_to_copy_indices_map.at(current_buffer_ptr);
+        bool                                                has_overlaps           = false;
+        std::vector<std::pair<VkDeviceSize, VkDeviceSize> > sorted_ranges;
+        bool                                                uses_decompressed_data = false;
+
+        for (const auto& current_copy_index : copy_indices)
+        {
+            const auto& current_copy = m_pending_buffer_copies.at(current_copy_index);
+
+            sorted_ranges.push_back(
+                std::make_pair(current_copy.dst_offset,
+                               current_copy.dst_offset + current_copy.size)
+            );
+
+            uses_decompressed_data |= current_copy.is_decompressed;
+        }
+
+        std::sort(sorted_ranges.begin(),
+                  sorted_ranges.end  () );
+
+        for (size_t n_range = 1;
+                    n_range < sorted_ranges.size() && !has_overlaps;
+                  ++n_range)
+        {
+            has_overlaps = (sorted_ranges.at(n_range).first < sorted_ranges.at(n_range - 1).second);
+        }
+
+        if (has_overlaps)
+        {
+            const uint32_t n_queue = (uses_decompressed_data) ? 0
+                                                              : get_least_loaded_queue_index(queue_loads);
+
+            for (const auto& current_copy_index : copy_indices)
+            {
+                const auto& current_copy = m_pending_buffer_copies.at(current_copy_index);
+
+                out_buffer_copies_per_queue_ptr->at(n_queue).push_back(current_copy);
+                queue_loads.at                     (n_queue) += current_copy.size;
+            }
+
+            continue;
+        }
+
+        for (const auto& current_copy_index : copy_indices)
+        {
+            const auto& current_copy = m_pending_buffer_copies.at(current_copy_index);
+
+            if (current_copy.is_decompressed  ||
+                current_copy.is_inline_update)
+            {
+                const uint32_t n_queue = (current_copy.is_decompressed) ? 0
+                                                                        : get_least_loaded_queue_index(queue_loads);
+
+                out_buffer_copies_per_queue_ptr->at(n_queue).push_back(current_copy);
+                queue_loads.at                     (n_queue) += current_copy.size;
+
+                continue;
+            }
+
+            for (VkDeviceSize chunk_offset  = 0;
+                              chunk_offset  < current_copy.size;
+                              chunk_offset += COPY_CHUNK_SIZE)
+            {
+                const VkDeviceSize chunk_size = std::min(static_cast<VkDeviceSize>(COPY_CHUNK_SIZE),
+                                                         current_copy.size - chunk_offset);
+                const uint32_t     n_queue    = get_least_loaded_queue_index(queue_loads);
+
+                out_buffer_copies_per_queue_ptr->at(n_queue).push_back(
+                    BufferCopyItem(current_copy.buffer_ptr,
+                                   current_copy.dst_offset + chunk_offset,
+                                   chunk_size,
+                                   current_copy.src_offset + chunk_offset,
+                                   false) /* in_is_inline_update */
+                );
+
+                queue_loads.at(n_queue) += chunk_size;
+            }
+        }
+    }
+
+    /* Images with decompressed uploads are pinned to the first queue up front, so that all their uploads execute
+     * in order. */
+    for (const auto& current_image_copy : m_pending_image_copies)
+    {
+        if (current_image_copy.is_decompressed)
+        {
+            image_to_queue_index_map[current_image_copy.image_ptr] = 0;
+        }
+    }
+
+    for (const auto& current_image_copy : m_pending_image_copies)
+    {
+        auto     map_iterator = image_to_queue_index_map.find(current_image_copy.image_ptr);
+        uint32_t n_queue;
+
+        if (map_iterator != image_to_queue_index_map.end() )
+        {
+            n_queue = map_iterator->second;
+        }
+        else
+        {
+            n_queue = get_least_loaded_queue_index(queue_loads);
+
+            image_to_queue_index_map[current_image_copy.image_ptr] = n_queue;
+        }
+
+        out_image_copies_per_queue_ptr->at(n_queue).push_back(&current_image_copy);
+        queue_loads.at                    (n_queue) += current_image_copy.n_bytes;
+    }
+}
+
+/** Please see header for specification */
+uint64_t Anvil::TransferBatch::enqueue_buffer_write(Anvil::Buffer* in_buffer_ptr,
+                                                    VkDeviceSize   in_start_offset,
+                                                    VkDeviceSize   in_size,
+                                                    const void*    in_data)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr = get_mutex();
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    anvil_assert(in_buffer_ptr != nullptr);
+    anvil_assert(in_data       != nullptr);
+    anvil_assert(in_size       >  0);
+
+    if ((in_start_offset % 4) != 0 ||
+        (in_size         % 4) != 0 ||
+         in_size              >  MAX_INLINE_UPDATE_SIZE)
+    {
+        m_pending_buffer_copies.push_back(
+            BufferCopyItem(in_buffer_ptr,
+                           in_start_offset,
+                           in_size,
+                           append_data(in_data,
+                                       in_size),
+                           false) /* in_is_inline_update */
+        );
+
+        goto end;
+    }
+
+    /* Small, aligned write. Embed the data in the command buffer instead of going through the staging buffer. */
+    {
+        const VkDeviceSize src_offset = static_cast<VkDeviceSize>(m_pending_inline_data.size() );
+
+        m_pending_inline_data.insert(m_pending_inline_data.end(),
+                                     static_cast<const unsigned char*>(in_data),
+                                     static_cast<const unsigned char*>(in_data) + in_size);
+
+        if (m_pending_buffer_copies.size() > 0)
+        {
+            auto& last_copy = m_pending_buffer_copies.back();
+
+            /* Coalesce with the previous write if it continues it. Inline data of consecutive inline updates
+             * is stored back-to-back, so it is enough to extend the previous update. */
+            if (last_copy.is_inline_update                                     &&
+                last_copy.buffer_ptr                  == in_buffer_ptr         &&
+                last_copy.dst_offset + last_copy.size == in_start_offset       &&
+                last_copy.size       + in_size        <= MAX_INLINE_UPDATE_SIZE)
+            {
+                anvil_assert(last_copy.src_offset + last_copy.size == src_offset);
+
+                last_copy.size += in_size;
+
+                goto end;
+            }
+        }
+
+        m_pending_buffer_copies.push_back(
+            BufferCopyItem(in_buffer_ptr,
+                           in_start_offset,
+                           in_size,
+                           src_offset,
+                           true) /* in_is_inline_update */
+        );
+    }
+
+end:
+    return m_next_token;
+}
+
+/** Please see header for specification */
+uint64_t Anvil::TransferBatch::enqueue_compressed_buffer_write(Anvil::Buffer*         in_buffer_ptr,
+                                                               VkDeviceSize           in_start_offset,
+                                                               uint32_t               in_n_chunks,
+                                                               const CompressedChunk* in_chunks_ptr)
+{
+    VkDeviceSize                               decompressed_size = 0;
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr         = get_mutex();
+    VkDeviceSize                               src_offset;
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    anvil_assert(in_buffer_ptr != nullptr);
+
+    src_offset = append_compressed_chunks(in_n_chunks,
+                                          in_chunks_ptr,
+                                         &decompressed_size);
+
+    m_pending_buffer_copies.push_back(
+        BufferCopyItem(in_buffer_ptr,
+                       in_start_offset,
+                       decompressed_size,
+                       src_offset,
+                       false, /* in_is_inline_update */
+                       true)  /* in_is_decompressed  */
+    );
+
+    return m_next_token;
+}
+
+/** Please see header for specification */
+uint64_t Anvil::TransferBatch::enqueue_compressed_image_upload(Anvil::Image*                        in_image_ptr,
+                                                               const std::vector<CompressedMipmap>& in_mipmaps,
+                                                               Anvil::ImageLayout                   in_current_image_layout,
+                                                               Anvil::ImageLayout*                  out_new_image_layout_ptr)
+{
+    ImageCopyItem                              copy_item;
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr = get_mutex();
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    init_image_copy_item(in_image_ptr,
+                         in_current_image_layout,
+                         true, /* in_is_decompressed */
+                        &copy_item);
+
+    copy_item.copy_regions.reserve(in_mipmaps.size() );
+
+    for (const auto& current_mipmap : in_mipmaps)
+    {
+        VkDeviceSize decompressed_size = 0;
+        VkDeviceSize src_offset        = append_compressed_chunks(static_cast<uint32_t>(current_mipmap.chunks.size() ),
+                                                                  (current_mipmap.chunks.size() > 0) ? &current_mipmap.chunks.at(0) : nullptr,
+                                                                 &decompressed_size);
+
+        copy_item.n_bytes                       += decompressed_size;
+        copy_item.subresource_range.aspect_mask |= current_mipmap.aspect;
+
+        copy_item.copy_regions.push_back(
+            get_copy_region(in_image_ptr,
+                            current_mipmap.aspect,
+                            current_mipmap.n_layer,
+                            current_mipmap.n_layers,
+                            current_mipmap.n_mipmap,
+                            current_mipmap.n_slices,
+                            src_offset)
+        );
+    }
+
+    *out_new_image_layout_ptr = copy_item.new_layout;
+
+    m_pending_image_copies.push_back(copy_item);
+
+    return m_next_token;
+}
+
+/** Please see header for specification */
+uint64_t Anvil::TransferBatch::enqueue_image_upload(Anvil::Image*                            in_image_ptr,
+                                                    const std::vector<Anvil::MipmapRawData>& in_mipmaps,
+                                                    Anvil::ImageLayout                       in_current_image_layout,
+                                                    Anvil::ImageLayout*                      out_new_image_layout_ptr)
+{
+    ImageCopyItem                              copy_item;
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr = get_mutex();
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    init_image_copy_item(in_image_ptr,
+                         in_current_image_layout,
+                         false, /* in_is_decompressed */
+                        &copy_item);
+
+    copy_item.copy_regions.reserve(in_mipmaps.size() );
+
+    for (const auto& current_mipmap : in_mipmaps)
+    {
+        const unsigned char* current_mipmap_data_ptr;
+        const VkDeviceSize   current_mipmap_size     = current_mipmap.n_slices * current_mipmap.data_size;
+
+        current_mipmap_data_ptr = (current_mipmap.linear_tightly_packed_data_uchar_ptr     != nullptr) ? current_mipmap.linear_tightly_packed_data_uchar_ptr.get()
+                                : (current_mipmap.linear_tightly_packed_data_uchar_raw_ptr != nullptr) ? current_mipmap.linear_tightly_packed_data_uchar_raw_ptr
+                                                                                                       : &(*current_mipmap.linear_tightly_packed_data_uchar_vec_ptr)[0];
+
+        copy_item.n_bytes                       += current_mipmap_size;
+        copy_item.subresource_range.aspect_mask |= current_mipmap.aspect;
+
+        copy_item.copy_regions.push_back(
+            get_copy_region(in_image_ptr,
+                            current_mipmap.aspect,
+                            current_mipmap.n_layer,
+                            current_mipmap.n_layers,
+                            current_mipmap.n_mipmap,
+                            current_mipmap.n_slices,
+                            append_data(current_mipmap_data_ptr,
+                                        current_mipmap_size) )
+        );
+    }
+
+    *out_new_image_layout_ptr = copy_item.new_layout;
+
+    m_pending_image_copies.push_back(copy_item);
+
+    return m_next_token;
+}
+
+/** Please see header for specification */
+uint64_t Anvil::TransferBatch::flush(uint32_t                 in_n_semaphores_to_signal,
+                                     Anvil::Semaphore* const* in_opt_semaphore_to_signal_ptrs_ptr)
+{
+    std::vector<std::vector<BufferCopyItem> >         buffer_copies_per_queue (m_queue_ptrs.size() );
+    VkDeviceSize                                      chunk_table_offset       = 0;
+    std::vector<Anvil::PrimaryCommandBufferUniquePtr> cmd_buffer_ptrs;
+    std::vector<uint32_t>                             cmd_buffer_queue_indices;
+    Anvil::BufferUniquePtr                            decompression_buffer_ptr;
+    Anvil::FenceUniquePtr                             fence_ptr;
+    Anvil::SemaphoreUniquePtr                         flush_semaphore_ptr;
+    std::vector<std::vector<const ImageCopyItem*> >   image_copies_per_queue  (m_queue_ptrs.size() );
+    std::unique_lock<Anvil::RecursiveSpinLock>        mutex_lock;
+    auto                                              mutex_ptr                = get_mutex();
+    uint64_t                                          result                   = m_next_token - 1;
+    std::vector<Anvil::SemaphoreUniquePtr>            semaphore_ptrs;
+    std::vector<Anvil::Semaphore*>                    signal_semaphore_ptrs;
+    Anvil::BufferUniquePtr                            staging_buffer_ptr;
+    std::vector<Anvil::Semaphore*>                    start_semaphore_ptrs;
+    std::vector<Anvil::PipelineStageFlags>            wait_semaphore_stage_masks;
+    std::vector<Anvil::Semaphore*>                    wait_semaphore_ptrs;
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    retire_flushes();
+
+    if (m_pending_buffer_copies.size() == 0 &&
+        m_pending_image_copies.size () == 0)
+    {
+        goto end;
+    }
+
+    fence_ptr = get_fence();
+
+    if (fence_ptr == nullptr)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (m_pending_chunks.size() > 0)
+    {
+        /* The chunk table travels with the compressed data. The decompressor writes whole words, so round the
+         * decompression buffer's size up accordingly. */
+        chunk_table_offset       = append_data             (&m_pending_chunks.at(0),
+                                                            m_pending_chunks.size() * sizeof(Anvil::GPUDecompressor::ChunkInfo) );
+        decompression_buffer_ptr = get_decompression_buffer(Anvil::Utils::round_up(m_pending_decompressed_data_size,
+                                                                                   static_cast<VkDeviceSize>(sizeof(uint32_t) )) );
+
+        if (decompression_buffer_ptr == nullptr)
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    /* No staging buffer is needed if all queued writes are inline updates. */
+    if (m_pending_data.size() > 0)
+    {
+        staging_buffer_ptr = get_staging_buffer(m_pending_data.size() );
+
+        if (staging_buffer_ptr == nullptr)
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        staging_buffer_ptr->write(0, /* in_start_offset */
+                                  m_pending_data.size(),
+                                 &m_pending_data.at(0) );
+    }
+
+    distribute_copies(&buffer_copies_per_queue,
+                      &image_copies_per_queue);
+
+    /* The first queue always gets a command buffer, since its submission signals the fence. Other queues are only
+     * used if any copies have been assigned to them. */
+    for (uint32_t n_queue = 0;
+                  n_queue < static_cast<uint32_t>(m_queue_ptrs.size() );
+                ++n_queue)
+    {
+        Anvil::PrimaryCommandBufferUniquePtr cmd_buffer_ptr;
+
+        if (n_queue                                  >  0 &&
+            buffer_copies_per_queue.at(n_queue).size() == 0 &&
+            image_copies_per_queue.at (n_queue).size() == 0)
+        {
+            continue;
+        }
+
+        cmd_buffer_ptr = m_device_ptr->get_command_pool_for_queue_family_index(m_queue_ptrs.at(n_queue)->get_queue_family_index() )->alloc_primary_level_command_buffer();
+
+        if (cmd_buffer_ptr == nullptr)
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        record_copies(cmd_buffer_ptr.get(),
+                      buffer_copies_per_queue.at(n_queue),
+                      image_copies_per_queue.at (n_queue),
+                      staging_buffer_ptr.get      (),
+                      decompression_buffer_ptr.get(),
+                      chunk_table_offset,
+                      (n_queue == 0) ); /* in_record_decompression */
+
+        cmd_buffer_ptrs.push_back         (std::move(cmd_buffer_ptr) );
+        cmd_buffer_queue_indices.push_back(n_queue);
+    }
+
+    /* Get hold of all semaphores up front, so that nothing is submitted unless the whole flush can be. Each
+     * submission made to the other queues signals a semaphore, which the first queue waits on. This way, the fence
+     * and the user's semaphores are only signalled after all copies of the flush finish executing. */
+    for (uint32_t n_cmd_buffer = 1;
+                  n_cmd_buffer < static_cast<uint32_t>(cmd_buffer_ptrs.size() );
+                ++n_cmd_buffer)
+    {
+        auto semaphore_ptr = get_semaphore();
+
+        if (semaphore_ptr == nullptr)
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        wait_semaphore_ptrs.push_back       (semaphore_ptr.get() );
+        wait_semaphore_stage_masks.push_back(Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT);
+        semaphore_ptrs.push_back            (std::move(semaphore_ptr) );
+    }
+
+    /* Copies of this flush must not overlap with copies of the previous one, which may write to the same
+     * destinations from a different queue. The previous flush's first queue submission signalled a semaphore once
+     * all of its copies finished executing. If only the first queue is used, its submission waits on the semaphore
+     * directly. Otherwise, an empty submission made to the first queue waits on it and starts the other queues.
+     * Since semaphore waits also block all later submissions made to the same queue, the first queue's copies
+     * are ordered after the previous flush, too. */
+    if (m_last_flush_semaphore_ptr != nullptr && cmd_buffer_ptrs.size() > 1)
+    {
+        for (uint32_t n_cmd_buffer = 1;
+                      n_cmd_buffer < static_cast<uint32_t>(cmd_buffer_ptrs.size() );
+                    ++n_cmd_buffer)
+        {
+            auto semaphore_ptr = get_semaphore();
+
+            if (semaphore_ptr == nullptr)
+            {
+                anvil_assert_fail();
+
+                goto end;
+            }
+
+            start_semaphore_ptrs.push_back(semaphore_ptr.get() );
+            semaphore_ptrs.push_back      (std::move(semaphore_ptr) );
+        }
+    }
+
+    /* Single-queue batches need no cross-queue ordering, so only multi-queue batches chain their flushes. */
+    if (m_queue_ptrs.size() > 1)
+    {
+        flush_semaphore_ptr = get_semaphore();
+
+        if (flush_semaphore_ptr == nullptr)
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    if (m_last_flush_semaphore_ptr != nullptr)
+    {
+        auto                            last_flush_semaphore_raw_ptr = m_last_flush_semaphore_ptr.get();
+        const Anvil::PipelineStageFlags start_wait_stage_mask        = Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT;
+
+        if (start_semaphore_ptrs.size() > 0)
+        {
+            m_queue_ptrs.at(0)->submit(
+                Anvil::SubmitInfo::create_signal_wait(static_cast<uint32_t>(start_semaphore_ptrs.size() ),
+                                                     &start_semaphore_ptrs.at(0),
+                                                      1, /* in_n_semaphores_to_wait_on */
+                                                     &last_flush_semaphore_raw_ptr,
+                                                     &start_wait_stage_mask,
+                                                      false) /* in_should_block */
+            );
+        }
+        else
+        {
+            wait_semaphore_ptrs.push_back       (last_flush_semaphore_raw_ptr);
+            wait_semaphore_stage_masks.push_back(start_wait_stage_mask);
+        }
+
+        /* The semaphore is unsignalled again by the time this flush's fence is signalled. */
+        semaphore_ptrs.push_back(std::move(m_last_flush_semaphore_ptr) );
+    }
+
+    for (uint32_t n_cmd_buffer = 1;
+                  n_cmd_buffer < static_cast<uint32_t>(cmd_buffer_ptrs.size() );
+                ++n_cmd_buffer)
+    {
+        auto                            done_semaphore_raw_ptr = wait_semaphore_ptrs.at(n_cmd_buffer - 1);
+        const Anvil::PipelineStageFlags start_wait_stage_mask  = Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT;
+
+        if (start_semaphore_ptrs.size() > 0)
+        {
+            m_queue_ptrs.at(cmd_buffer_queue_indices.at(n_cmd_buffer) )->submit(
+                Anvil::SubmitInfo::create(cmd_buffer_ptrs.at(n_cmd_buffer).get(),
+                                          1, /* in_n_semaphores_to_signal */
+                                         &done_semaphore_raw_ptr,
+                                          1, /* in_n_semaphores_to_wait_on */
+                                         &start_semaphore_ptrs.at(n_cmd_buffer - 1),
+                                         &start_wait_stage_mask,
+                                          false) /* should_block */
+            );
+        }
+        else
+        {
+            m_queue_ptrs.at(cmd_buffer_queue_indices.at(n_cmd_buffer) )->submit(
+                Anvil::SubmitInfo::create_execute_signal(cmd_buffer_ptrs.at(n_cmd_buffer).get(),
+                                                         1, /* in_n_semaphores_to_signal */
+                                                        &done_semaphore_raw_ptr,
+                                                         false) /* should_block */
+            );
+        }
+    }
+
+    anvil_assert(in_n_semaphores_to_signal == 0 || in_opt_semaphore_to_signal_ptrs_ptr != nullptr);
+
+    signal_semaphore_ptrs.assign(in_opt_semaphore_to_signal_ptrs_ptr,
+                                 in_opt_semaphore_to_signal_ptrs_ptr + in_n_semaphores_to_signal);
+
+    if (flush_semaphore_ptr != nullptr)
+    {
+        signal_semaphore_ptrs.push_back(flush_semaphore_ptr.get() );
+    }
+
+    m_queue_ptrs.at(0)->submit(
+        Anvil::SubmitInfo::create(cmd_buffer_ptrs.at(0).get(),
+                                  static_cast<uint32_t>(signal_semaphore_ptrs.size() ),
+                                  (signal_semaphore_ptrs.size() > 0) ? &signal_semaphore_ptrs.at(0) : nullptr,
+                                  static_cast<uint32_t>(wait_semaphore_ptrs.size() ),
+                                  (wait_semaphore_ptrs.size() > 0) ? &wait_semaphore_ptrs.at       (0) : nullptr,
+                                  (wait_semaphore_ptrs.size() > 0) ? &wait_semaphore_stage_masks.at(0) : nullptr,
+                                  false, /* should_block */
+                                  fence_ptr.get() )
+    );
+
+    result                     = m_next_token++;
+    m_last_flush_semaphore_ptr = std::move(flush_semaphore_ptr);
+
+    m_in_flight_flushes.emplace_back(std::move(cmd_buffer_ptrs),
+                                     std::move(semaphore_ptrs),
+                                     std::move(fence_ptr),
+                                     std::move(staging_buffer_ptr),
+                                     std::move(decompression_buffer_ptr),
+                                     result);
+
+    m_pending_buffer_copies.clear();
+    m_pending_chunks.clear       ();
+    m_pending_data.clear         ();
+    m_pending_image_copies.clear ();
+    m_pending_inline_data.clear  ();
+
+    m_pending_decompressed_data_size = 0;
+
+end:
+    return result;
+}
+
+/** Fills a buffer->image copy region for a single mip, whose data starts at @param in_buffer_offset. */
+Anvil::BufferImageCopy Anvil::TransferBatch::get_copy_region(const Anvil::Image*        in_image_ptr,
+                                                             Anvil::ImageAspectFlagBits in_aspect,
+                                                             uint32_t                   in_n_layer,
+                                                             uint32_t                   in_n_layers,
+                                                             uint32_t                   in_n_mipmap,
+                                                             uint32_t                   in_n_slices,
+                                                             VkDeviceSize               in_buffer_offset) const
+{
+    const auto             image_create_info_ptr = in_image_ptr->get_create_info_ptr();
+    const auto             base_mip_height       = image_create_info_ptr->get_base_mip_height();
+    const auto             base_mip_width        = image_create_info_ptr->get_base_mip_width ();
+    Anvil::BufferImageCopy result;
+
+    result.buffer_image_height                = std::max(base_mip_height / (1 << in_n_mipmap), 1u);
+    result.buffer_offset                      = in_buffer_offset;
+    result.buffer_row_length                  = 0;
+    result.image_offset.x                     = 0;
+    result.image_offset.y                     = 0;
+    result.image_offset.z                     = 0;
+    result.image_subresource.base_array_layer = in_n_layer;
+    result.image_subresource.layer_count      = in_n_layers;
+    result.image_subresource.aspect_mask      = in_aspect;
+    result.image_subresource.mip_level        = in_n_mipmap;
+    result.image_extent.depth                 = std::max(in_n_slices,                             1u);
+    result.image_extent.height                = std::max(base_mip_height / (1 << in_n_mipmap), 1u);
+    result.image_extent.width                 = std::max(base_mip_width  / (1 << in_n_mipmap), 1u);
+
+    return result;
+}
+
+/** Returns a device-local buffer of at least @param in_size bytes, which the decompressor can write to, recycling
+ *  decompression buffers of retired flushes if possible. */
+Anvil::BufferUniquePtr Anvil::TransferBatch::get_decompression_buffer(VkDeviceSize in_size)
+{
+    Anvil::BufferUniquePtr result_ptr;
+
+    for (auto buffer_iterator  = m_free_decompression_buffers.begin();
+              buffer_iterator != m_free_decompression_buffers.end();
+            ++buffer_iterator)
+    {
+        if ((*buffer_iterator)->get_create_info_ptr()->get_size() >= in_size)
+        {
+            result_ptr = std::move(*buffer_iterator);
+
+            m_free_decompression_buffers.erase(buffer_iterator);
+            break;
+        }
+    }
+
+    if (result_ptr == nullptr)
+    {
+        auto create_info_ptr = Anvil::BufferCreateInfo::create_alloc(m_device_ptr,
+                                                                     in_size,
+                                                                     get_queue_family_bits(),
+                                                                     Anvil::SharingMode::EXCLUSIVE,
+                                                                     Anvil::BufferCreateFlagBits::NONE,
+                                                                     Anvil::BufferUsageFlagBits::STORAGE_BUFFER_BIT | Anvil::BufferUsageFlagBits::TRANSFER_SRC_BIT,
+                                                                     Anvil::MemoryFeatureFlagBits::DEVICE_LOCAL_BIT);
+
+        create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+
+        result_ptr = Anvil::Buffer::create(std::move(create_info_ptr) );
+    }
+
+    return result_ptr;
+}
+
+/** Returns a reset fence, recycling fences of retired flushes if possible. */
+Anvil::FenceUniquePtr Anvil::TransferBatch::get_fence()
+{
+    Anvil::FenceUniquePtr result_ptr;
+
+    /* wait() may be blocked on a retired flush's fence with the lock released. Resetting & reusing that fence
+     * could keep the waiter blocked until a later flush completes. */
+    if (!m_free_fences.empty()         &&
+         m_n_unlocked_fence_waits == 0)
+    {
+        result_ptr = std::move(m_free_fences.back() );
+
+        m_free_fences.pop_back();
+        result_ptr->reset     ();
+    }
+    else
+    {
+        auto create_info_ptr = Anvil::FenceCreateInfo::create(m_device_ptr,
+                                                              false); /* in_create_signalled */
+
+        create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+
+        result_ptr = Anvil::Fence::create(std::move(create_info_ptr) );
+    }
+
+    return result_ptr;
+}
+
+/** Returns a semaphore, recycling semaphores of retired flushes if possible. */
+Anvil::SemaphoreUniquePtr Anvil::TransferBatch::get_semaphore()
+{
+    Anvil::SemaphoreUniquePtr result_ptr;
+
+    if (!m_free_semaphores.empty() )
+    {
+        result_ptr = std::move(m_free_semaphores.back() );
+
+        m_free_semaphores.pop_back();
+    }
+    else
+    {
+        auto create_info_ptr = Anvil::SemaphoreCreateInfo::create(m_device_ptr);
+
+        create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+
+        result_ptr = Anvil::Semaphore::create(std::move(create_info_ptr) );
+    }
+
+    return result_ptr;
+}
+
+/** Returns a mappable staging buffer of at least @param in_size bytes, recycling staging buffers of retired
+ *  flushes if possible. */
+Anvil::BufferUniquePtr Anvil::TransferBatch::get_staging_buffer(VkDeviceSize in_size)
+{
+    Anvil::BufferUniquePtr result_ptr;
+
+    for (auto buffer_iterator  = m_free_staging_buffers.begin();
+              buffer_iterator != m_free_staging_buffers.end();
+            ++buffer_iterator)
+    {
+        if ((*buffer_iterator)->get_create_info_ptr()->get_size() >= in_size)
+        {
+            result_ptr = std::move(*buffer_iterator);
+
+            m_free_staging_buffers.erase(buffer_iterator);
+            break;
+        }
+    }
+
+    if (result_ptr == nullptr)
+    {
+        Anvil::BufferCreateInfoUniquePtr create_info_ptr;
+        Anvil::BufferUsageFlags          usage = Anvil::BufferUsageFlagBits::TRANSFER_SRC_BIT;
+
+        /* The decompressor reads compressed data straight from staging buffers. */
+        if (m_decompressor_ptr != nullptr)
+        {
+            usage |= Anvil::BufferUsageFlagBits::STORAGE_BUFFER_BIT;
+        }
+
+        create_info_ptr = Anvil::BufferCreateInfo::create_alloc(m_device_ptr,
+                                                                in_size,
+                                                                get_queue_family_bits(),
+                                                                Anvil::SharingMode::EXCLUSIVE,
+                                                                Anvil::BufferCreateFlagBits::NONE,
+                                                                usage,
+                                                                Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT);
+
+        create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+
+        result_ptr = Anvil::Buffer::create(std::move(create_info_ptr) );
+    }
+
+    return result_ptr;
+}
+
+/** Returns queue family bits describing the batch's queue, as expected by buffer create info. */
+Anvil::QueueFamilyFlagBits Anvil::TransferBatch::get_queue_family_bits() const
+{
+    Anvil::QueueFamilyFlagBits result = Anvil::QueueFamilyFlagBits::NONE;
+
+    switch (m_device_ptr->get_queue_family_type(m_queue_ptrs.at(0)->get_queue_family_index() ) )
+    {
+        case Anvil::QueueFamilyType::COMPUTE:   result = Anvil::QueueFamilyFlagBits::COMPUTE_BIT;  break;
+        case Anvil::QueueFamilyType::TRANSFER:  result = Anvil::QueueFamilyFlagBits::DMA_BIT;      break;
+        case Anvil::QueueFamilyType::UNIVERSAL: result = Anvil::QueueFamilyFlagBits::GRAPHICS_BIT; break;
+
+        default:
+        {
+            anvil_assert_fail();
+        }
+    }
+
+    return result;
+}
+
+/** Verifies the batch's queues and creates the GPU decompressor, if requested.
+ *
+ *  @param in_enable_gpu_decompression True if the batch should accept compressed data.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::TransferBatch::init(bool in_enable_gpu_decompression)
+{
+    const uint32_t queue_family_index = m_queue_ptrs.at(0)->get_queue_family_index();
+    bool           result             = false;
+
+    /* Resources are created with exclusive sharing mode for the family of the batch's queues, and command buffers
+     * come from a single pool. */
+    for (const auto& current_queue_ptr : m_queue_ptrs)
+    {
+        if (current_queue_ptr->get_queue_family_index() != queue_family_index)
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    if (in_enable_gpu_decompression)
+    {
+        /* Decompression is done with compute dispatches. */
+        if (m_device_ptr->get_queue_family_type(queue_family_index) == Anvil::QueueFamilyType::TRANSFER)
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        m_decompressor_ptr = Anvil::GPUDecompressor::create(m_device_ptr);
+
+        if (m_decompressor_ptr == nullptr)
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Initializes an image copy item, which describes an upload to @param in_image_ptr. Copy regions are left
+ *  empty and the aspect mask of the subresource range is cleared, so that callers can fill both per mip. */
+void Anvil::TransferBatch::init_image_copy_item(Anvil::Image*      in_image_ptr,
+                                                Anvil::ImageLayout in_current_image_layout,
+                                                bool               in_is_decompressed,
+                                                ImageCopyItem*     out_copy_item_ptr) const
+{
+    const auto image_create_info_ptr = in_image_ptr->get_create_info_ptr();
+    const auto base_mip_height       = image_create_info_ptr->get_base_mip_height();
+
+    ANVIL_REDUNDANT_VARIABLE_CONST(base_mip_height);
+
+    anvil_assert(image_create_info_ptr->get_tiling() == Anvil::ImageTiling::OPTIMAL);
+    anvil_assert(base_mip_height < 2 || (base_mip_height % 2) == 0);
+
+    out_copy_item_ptr->current_layout                = in_current_image_layout;
+    out_copy_item_ptr->image_ptr                     = in_image_ptr;
+    out_copy_item_ptr->is_decompressed               = in_is_decompressed;
+    out_copy_item_ptr->n_bytes                       = 0;
+    out_copy_item_ptr->new_layout                    = (in_current_image_layout == Anvil::ImageLayout::GENERAL ||
+                                                        in_current_image_layout == Anvil::ImageLayout::TRANSFER_DST_OPTIMAL) ? in_current_image_layout
+                                                                                                                             : Anvil::ImageLayout::TRANSFER_DST_OPTIMAL;
+    out_copy_item_ptr->subresource_range             = in_image_ptr->get_subresource_range();
+    out_copy_item_ptr->subresource_range.aspect_mask = Anvil::ImageAspectFlagBits::NONE;
+}
+
+/** Please see header for specification */
+bool Anvil::TransferBatch::is_complete(uint64_t in_token)
+{
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr = get_mutex();
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    retire_flushes();
+
+    return (in_token <= m_last_retired_token);
+}
+
+/** Records copy ops assigned to a single queue.
+ *
+ *  @param in_cmd_buffer_ptr           Command buffer to record the ops to. Must not be in recording state.
+ *  @param in_buffer_copies            Buffer copies to record.
+ *  @param in_image_copies             Image copies to record.
+ *  @param in_staging_buffer_ptr       Staging buffer of the flush. May be null if no copies read from it.
+ *  @param in_decompression_buffer_ptr Decompression buffer of the flush. May be null if no copies read from it.
+ *  @param in_chunk_table_offset       Offset of the chunk table in the staging buffer.
+ *  @param in_record_decompression     True if the decompression dispatch should be recorded to the command buffer.
+ */
+void Anvil::TransferBatch::record_copies(Anvil::PrimaryCommandBuffer*             in_cmd_buffer_ptr,
+                                         const std::vector<BufferCopyItem>&       in_buffer_copies,
+                                         const std::vector<const ImageCopyItem*>& in_image_copies,
+                                         Anvil::Buffer*                           in_staging_buffer_ptr,
+                                         Anvil::Buffer*                           in_decompression_buffer_ptr,
+                                         VkDeviceSize                             in_chunk_table_offset,
+                                         bool                                     in_record_decompression)
+{
+    std::vector<Anvil::ImageBarrier> image_barriers;
+    Anvil::MemoryBarrier             post_copy_barrier(Anvil::AccessFlagBits::MEMORY_READ_BIT | Anvil::AccessFlagBits::MEMORY_WRITE_BIT, /* in_destination_access_mask */
+                                                       Anvil::AccessFlagBits::TRANSFER_WRITE_BIT);
+    Anvil::MemoryBarrier             pre_copy_barrier (Anvil::AccessFlagBits::TRANSFER_READ_BIT | Anvil::AccessFlagBits::TRANSFER_WRITE_BIT, /* in_destination_access_mask */
+                                                       Anvil::AccessFlagBits::MEMORY_READ_BIT   | Anvil::AccessFlagBits::MEMORY_WRITE_BIT);
+
+    in_cmd_buffer_ptr->start_recording(true,   /* one_time_submit          */
+                                       false); /* simultaneous_use_allowed */
+
+    /* Decompressed data becomes visible to the copy ops below thanks to the pre-copy barrier. */
+    if (in_record_decompression              &&
+        in_decompression_buffer_ptr != nullptr)
+    {
+        m_decompressor_ptr->record_decompress(in_cmd_buffer_ptr,
+                                              in_staging_buffer_ptr,
+                                              in_chunk_table_offset,
+                                              static_cast<uint32_t>(m_pending_chunks.size() ),
+                                              in_decompression_buffer_ptr);
+    }
+
+    for (const auto& current_image_copy_ptr : in_image_copies)
+    {
+        if (current_image_copy_ptr->current_layout != current_image_copy_ptr->new_layout)
+        {
+            image_barriers.push_back(
+                Anvil::ImageBarrier(Anvil::AccessFlagBits::NONE, /* in_source_access_mask */
+                                    Anvil::AccessFlagBits::TRANSFER_WRITE_BIT,
+                                    current_image_copy_ptr->current_layout,
+                                    current_image_copy_ptr->new_layout,
+                                    VK_QUEUE_FAMILY_IGNORED,
+                                    VK_QUEUE_FAMILY_IGNORED,
+                                    current_image_copy_ptr->image_ptr,
+                                    current_image_copy_ptr->subresource_range)
+            );
+        }
+    }
+
+    in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT,
+                                               Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                               Anvil::DependencyFlagBits::NONE,
+                                               1, /* in_memory_barrier_count */
+                                              &pre_copy_barrier,
+                                               0,       /* in_buffer_memory_barrier_count */
+                                               nullptr, /* in_buffer_memory_barriers_ptr  */
+                                               static_cast<uint32_t>(image_barriers.size() ),
+                                               (image_barriers.size() > 0) ? &image_barriers.at(0) : nullptr);
+
+    for (const auto& current_buffer_copy : in_buffer_copies)
+    {
+        Anvil::BufferCopy copy_region;
+
+        if (current_buffer_copy.is_inline_update)
+        {
+            in_cmd_buffer_ptr->record_update_buffer(current_buffer_copy.buffer_ptr,
+                                                    current_buffer_copy.dst_offset,
+                                                    current_buffer_copy.size,
+                                                   &m_pending_inline_data.at(static_cast<size_t>(current_buffer_copy.src_offset) ));
+
+            continue;
+        }
+
+        copy_region.dst_offset = current_buffer_copy.dst_offset;
+        copy_region.size       = current_buffer_copy.size;
+        copy_region.src_offset = current_buffer_copy.src_offset;
+
+        in_cmd_buffer_ptr->record_copy_buffer((current_buffer_copy.is_decompressed) ? in_decompression_buffer_ptr
+                                                                                    : in_staging_buffer_ptr,
+                                              current_buffer_copy.buffer_ptr,
+                                              1, /* in_region_count */
+                                             &copy_region);
+    }
+
+    for (const auto& current_image_copy_ptr : in_image_copies)
+    {
+        static const uint32_t n_max_copy_regions_per_copy_call = 1024;
+        const uint32_t        n_copy_regions                   = static_cast<uint32_t>(current_image_copy_ptr->copy_regions.size() );
+
+        for (uint32_t n_copy_region = 0;
+                      n_copy_region < n_copy_regions;
+                      n_copy_region += n_max_copy_regions_per_copy_call)
+        {
+            const uint32_t n_copy_regions_to_use = std::min(n_max_copy_regions_per_copy_call,
+                                                            n_copy_regions - n_copy_region);
+
+            in_cmd_buffer_ptr->record_copy_buffer_to_image((current_image_copy_ptr->is_decompressed) ? in_decompression_buffer_ptr
+                                                                                                     : in_staging_buffer_ptr,
+                                                           current_image_copy_ptr->image_ptr,
+                                                           current_image_copy_ptr->new_layout,
+                                                           n_copy_regions_to_use,
+                                                          &current_image_copy_ptr->copy_regions.at(n_copy_region) );
+        }
+    }
+
+    in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                               Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT,
+                                               Anvil::DependencyFlagBits::NONE,
+                                               1, /* in_memory_barrier_count */
+                                              &post_copy_barrier,
+                                               0,        /* in_buffer_memory_barrier_count */
+                                               nullptr,  /* in_buffer_memory_barriers_ptr  */
+                                               0,        /* in_image_memory_barrier_count  */
+                                               nullptr); /* in_image_memory_barriers_ptr   */
+
+    in_cmd_buffer_ptr->stop_recording();
+}
+
+/** Releases resources of all flushes at the front of the queue whose fences have been signalled. */
+void Anvil::TransferBatch::retire_flushes()
+{
+    while (!m_in_flight_flushes.empty() )
+    {
+        auto& oldest_flush = m_in_flight_flushes.front();
+
+        if (!oldest_flush.fence_ptr->is_set() )
+        {
+            break;
+        }
+
+        m_last_retired_token = oldest_flush.token;
+
+        m_free_fences.push_back(std::move(oldest_flush.fence_ptr) );
+
+        if (oldest_flush.staging_buffer_ptr != nullptr)
+        {
+            m_free_staging_buffers.push_back(std::move(oldest_flush.staging_buffer_ptr) );
+        }
+
+        if (oldest_flush.decompression_buffer_ptr != nullptr)
+        {
+            m_free_decompression_buffers.push_back(std::move(oldest_flush.decompression_buffer_ptr) );
+        }
+
+        /* The first queue's submission, whose fence has just been found signalled, waited on all these semaphores,
+         * so they are unsignalled again. */
+        for (auto& current_semaphore_ptr : oldest_flush.semaphore_ptrs)
+        {
+            m_free_semaphores.push_back(std::move(current_semaphore_ptr) );
+        }
+
+        m_in_flight_flushes.pop_front();
+    }
+}
+
+/** Please see header for specification */
+bool Anvil::TransferBatch::wait(uint64_t in_token,
+                                uint64_t in_timeout)
+{
+    VkFence                                    fence_vk  = VK_NULL_HANDLE;
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr = get_mutex();
+    bool                                       result    = true;
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    anvil_assert(in_token <= m_next_token);
+
+    if (in_token == m_next_token)
+    {
+        flush();
+    }
+
+    for (const auto& current_flush : m_in_flight_flushes)
+    {
+        if (current_flush.token == in_token)
+        {
+            fence_vk = *current_flush.fence_ptr->get_fence_ptr();
+
+            break;
+        }
+    }
+
+    if (fence_vk != VK_NULL_HANDLE)
+    {
+        /* Do not stall other threads' enqueue & flush calls for the duration of the GPU wait. The fence is not
+         * going to be recycled by get_fence() until the wait finishes. */
+        ++m_n_unlocked_fence_waits;
+
+        if (mutex_lock.owns_lock() )
+        {
+            mutex_lock.unlock();
+        }
+
+        result = (m_device_ptr->get_dispatch_table().vkWaitForFences(m_device_ptr->get_device_vk(),
+                                                                     1, /* fenceCount */
+                                                                    &fence_vk,
+                                                                     VK_TRUE, /* waitAll */
+                                                                     in_timeout) == VK_SUCCESS);
+
+        if (mutex_ptr != nullptr)
+        {
+            mutex_lock.lock();
+        }
+
+        --m_n_unlocked_fence_waits;
+    }
+
+    retire_flushes();
+
+    return result;
+}
@@ -0,0 +1,307 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/buffer_create_info.h"
+#include "misc/debug.h"
+#include "misc/transient_buffer_allocator.h"
+#include "wrappers/buffer.h"
+#include "wrappers/device.h"
+#include "wrappers/memory_block.h"
+#include <algorithm>
+#include <cstring>
+
+
+/** Please see header for specification */
+Anvil::TransientBufferAllocator::TransientBufferAllocator(const Anvil::BaseDevice* in_device_ptr,
+                                                          uint32_t                 in_n_frames_in_flight,
+                                                          VkDeviceSize             in_chunk_size,
+                                                          Anvil::BufferUsageFlags  in_usage_flags,
+                                                          bool                     in_mt_safe)
+    :MTSafetySupportProvider(in_mt_safe),
+     m_alignment            (16),
+     m_chunk_size           (in_chunk_size),
+     m_device_ptr           (in_device_ptr),
+     m_frames               (in_n_frames_in_flight),
+     m_n_current_frame      (0),
+     m_usage_flags          (in_usage_flags)
+{
+    const auto& limits = in_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits;
+
+    /* Use a single alignment which satisfies all usages the chunks are created with, so that any allocation can be
+     * bound at a dynamic offset. */
+    if ((in_usage_flags & Anvil::BufferUsageFlagBits::UNIFORM_BUFFER_BIT) != 0)
+    {
+        m_alignment = std::max(m_alignment,
+                               limits.min_uniform_buffer_offset_alignment);
+    }
+
+    if ((in_usage_flags & Anvil::BufferUsageFlagBits::STORAGE_BUFFER_BIT) != 0)
+    {
+        m_alignment = std::max(m_alignment,
+                               limits.min_storage_buffer_offset_alignment);
+    }
+
+    if ((in_usage_flags & Anvil::BufferUsageFlagBits::STORAGE_TEXEL_BUFFER_BIT) != 0 ||
+        (in_usage_flags & Anvil::BufferUsageFlagBits::UNIFORM_TEXEL_BUFFER_BIT) != 0)
+    {
+        m_alignment = std::max(m_alignment,
+                               limits.min_texel_buffer_offset_alignment);
+    }
+}
+
+/** Please see header for specification */
+Anvil::TransientBufferAllocator::~TransientBufferAllocator()
+{
+    lock();
+    {
+        for (auto& current_frame : m_frames)
+        {
+            for (auto& current_chunk : current_frame.chunks)
+            {
+                current_chunk.buffer_ptr->get_memory_block(0 /* in_n_memory_block */)->unmap();
+            }
+
+            current_frame.chunks.clear();
+        }
+
+        m_frames.clear();
+    }
+    unlock();
+}
+
+/** Please see header for specification */
+bool Anvil::TransientBufferAllocator::allocate(VkDeviceSize in_size,
+                                               Allocation*  out_result_ptr)
+{
+    Chunk*             chunk_ptr    = nullptr;
+    Frame*             frame_ptr    = nullptr;
+    bool               result       = false;
+    const VkDeviceSize size_aligned = Anvil::Utils::round_up(in_size,
+                                                             m_alignment);
+
+    anvil_assert(in_size        >  0);
+    anvil_assert(out_result_ptr != nullptr);
+
+    lock();
+    {
+        frame_ptr = &m_frames.at(m_n_current_frame);
+
+        /* Skip chunks which cannot accommodate the request. Chunks retained from earlier frames are tried first. */
+        while (frame_ptr->n_current_chunk < frame_ptr->chunks.size() )
+        {
+            chunk_ptr = &frame_ptr->chunks.at(frame_ptr->n_current_chunk);
+
+            if (frame_ptr->head_offset + size_aligned <= chunk_ptr->size)
+            {
+                break;
+            }
+
+            chunk_ptr = nullptr;
+
+            frame_ptr->head_offset = 0;
+            frame_ptr->n_current_chunk++;
+        }
+
+        if (chunk_ptr == nullptr)
+        {
+            if (!create_chunk(std::max(m_chunk_size, size_aligned),
+                              frame_ptr) )
+            {
+                goto end;
+            }
+
+            frame_ptr->head_offset     = 0;
+            frame_ptr->n_current_chunk = static_cast<uint32_t>(frame_ptr->chunks.size() ) - 1;
+
+            chunk_ptr = &frame_ptr->chunks.back();
+        }
+
+        out_result_ptr->buffer_ptr = chunk_ptr->buffer_ptr.get();
+        out_result_ptr->mapped_ptr = chunk_ptr->mapped_ptr + frame_ptr->head_offset;
+        out_result_ptr->offset     = frame_ptr->head_offset;
+        out_result_ptr->size       = in_size;
+
+        frame_ptr->head_offset += size_aligned;
+
+        result = true;
+    }
+end:
+    unlock();
+
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::TransientBufferAllocator::allocate_and_write(VkDeviceSize in_size,
+                                                         const void*  in_data,
+                                                         Allocation*  out_result_ptr)
+{
+    bool result = false;
+
+    anvil_assert(in_data != nullptr);
+
+    if (!allocate(in_size,
+                  out_result_ptr) )
+    {
+        goto end;
+    }
+
+    /* Chunks are host-coherent, so no flush is needed. */
+    memcpy(out_result_ptr->mapped_ptr,
+           in_data,
+           static_cast<size_t>(in_size) );
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::TransientBufferAllocator::begin_frame()
+{
+    lock();
+    {
+        Frame* frame_ptr = nullptr;
+
+        m_n_current_frame = (m_n_current_frame + 1) % static_cast<uint32_t>(m_frames.size() );
+        frame_ptr         = &m_frames.at(m_n_current_frame);
+
+        frame_ptr->head_offset     = 0;
+        frame_ptr->n_current_chunk = 0;
+    }
+    unlock();
+}
+
+/** Please see header for specification */
+Anvil::TransientBufferAllocatorUniquePtr Anvil::TransientBufferAllocator::create(const Anvil::BaseDevice* in_device_ptr,
+                                                                                 uint32_t                 in_n_frames_in_flight,
+                                                                                 VkDeviceSize             in_chunk_size,
+                                                                                 Anvil::BufferUsageFlags  in_usage_flags,
+                                                                                 bool                     in_mt_safe)
+{
+    Anvil::TransientBufferAllocatorUniquePtr result_ptr(nullptr,
+                                                        std::default_delete<Anvil::TransientBufferAllocator>() );
+
+    anvil_assert(in_device_ptr         != nullptr);
+    anvil_assert(in_chunk_size         >  0);
+    anvil_assert(in_n_frames_in_flight >  0);
+
+    result_ptr.reset(
+        new Anvil::TransientBufferAllocator(in_device_ptr,
+                                            in_n_frames_in_flight,
+                                            in_chunk_size,
+                                            in_usage_flags,
+                                            in_mt_safe)
+    );
+
+    return result_ptr;
+}
+
+/** Creates a new persistently mapped chunk buffer and appends it to the specified frame slot.
+ *
+ *  @param in_size      Size of the chunk.
+ *  @param in_frame_ptr Frame slot to append the chunk to. Must not be null.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::TransientBufferAllocator::create_chunk(VkDeviceSize in_size,
+                                                   Frame*       in_frame_ptr)
+{
+    Anvil::BufferUniquePtr  buffer_ptr;
+    void*                   mapped_ptr = nullptr;
+    Anvil::QueueFamilyFlags queue_fams = Anvil::QueueFamilyFlagBits::NONE;
+    bool                    result     = false;
+
+    /* Transient data may be consumed by any queue family */
+    if (m_device_ptr->get_n_universal_queues() > 0)
+    {
+        queue_fams |= Anvil::QueueFamilyFlagBits::GRAPHICS_BIT;
+    }
+
+    if (m_device_ptr->get_n_compute_queues() > 0)
+    {
+        queue_fams |= Anvil::QueueFamilyFlagBits::COMPUTE_BIT;
+    }
+
+    if (m_device_ptr->get_n_transfer_queues() > 0)
+    {
+        queue_fams |= Anvil::QueueFamilyFlagBits::DMA_BIT;
+    }
+
+    {
+        const auto sharing_mode    = Anvil::Utils::is_pow2(queue_fams.get_vk() ) ? Anvil::SharingMode::EXCLUSIVE
+                                                                                 : Anvil::SharingMode::CONCURRENT;
+        auto       create_info_ptr = Anvil::BufferCreateInfo::create_alloc(m_device_ptr,
+                                                                           in_size,
+                                                                           queue_fams,
+                                                                           sharing_mode,
+                                                                           Anvil::BufferCreateFlagBits::NONE,
+                                                                           m_usage_flags,
+                                                                           Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT | Anvil::MemoryFeatureFlagBits::HOST_COHERENT_BIT);
+
+        create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+
+        buffer_ptr = Anvil::Buffer::create(std::move(create_info_ptr) );
+    }
+
+    if (buffer_ptr == nullptr)
+    {
+        anvil_assert(buffer_ptr != nullptr);
+
+        goto end;
+    }
+
+    /* Keep the chunk mapped throughout its lifetime, so that allocations do not need to map it. */
+    if (!buffer_ptr->get_memory_block(0 /* in_n_memory_block */)->map(0, /* in_start_offset */
+                                                                      in_size,
+                                                                     &mapped_ptr) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    in_frame_ptr->chunks.emplace_back(std::move(buffer_ptr),
+                                      static_cast<unsigned char*>(mapped_ptr),
+                                      in_size);
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::TransientBufferAllocator::get_n_chunks() const
+{
+    uint32_t result = 0;
+
+    lock();
+    {
+        for (const auto& current_frame : m_frames)
+        {
+            result += static_cast<uint32_t>(current_frame.chunks.size() );
+        }
+    }
+    unlock();
+
+    return result;
+}
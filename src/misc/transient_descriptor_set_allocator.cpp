@@ -0,0 +1,223 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/descriptor_pool_chain.h"
+#include "misc/descriptor_pool_sizing_profile.h"
+#include "misc/transient_descriptor_set_allocator.h"
+#include "wrappers/descriptor_set.h"
+#include "wrappers/device.h"
+#include "wrappers/fence.h"
+
+
+/** Please see header for specification */
+Anvil::TransientDescriptorSetAllocator::TransientDescriptorSetAllocator(const Anvil::BaseDevice* in_device_ptr,
+                                                                        uint32_t                 in_n_frames_in_flight,
+                                                                        uint32_t                 in_n_sets_per_pool,
+                                                                        uint32_t                 in_n_descriptors_per_type_pool)
+    :m_device_ptr                 (in_device_ptr),
+     m_frame_fences               (in_n_frames_in_flight,
+                                   nullptr),
+     m_n_descriptors_per_type_pool(in_n_descriptors_per_type_pool),
+     m_n_current_frame            (0),
+     m_n_frames_in_flight         (in_n_frames_in_flight),
+     m_n_sets_per_pool            (in_n_sets_per_pool)
+{
+    /* Allocators configured the same way share the recorded usage, also across runs. */
+    const uint64_t sizing_profile_key_words[] =
+    {
+        0x5452414E53444153ull, /* "TRANSDAS" */
+        in_n_sets_per_pool,
+        in_n_descriptors_per_type_pool
+    };
+
+    m_sizing_profile_key = Anvil::Utils::hash64(sizing_profile_key_words,
+                                                sizeof(sizing_profile_key_words) );
+}
+
+/** Please see header for specification */
+Anvil::TransientDescriptorSetAllocator::~TransientDescriptorSetAllocator()
+{
+    std::unique_lock<std::mutex> lock(m_thread_data_mutex);
+
+    /* Release set wrappers before the pools they have been allocated from */
+    for (auto& current_thread_data : m_thread_data)
+    {
+        for (auto& current_frame : current_thread_data.second->frames)
+        {
+            current_frame.sets.clear        ();
+            current_frame.pool_chain_ptr.reset();
+        }
+    }
+
+    m_thread_data.clear();
+}
+
+/** Please see header for specification */
+Anvil::DescriptorSet* Anvil::TransientDescriptorSetAllocator::allocate(const Anvil::DescriptorSetAllocation& in_ds_allocation)
+{
+    Frame*                        frame_ptr       = nullptr;
+    Anvil::DescriptorSet*         result_ptr      = nullptr;
+    Anvil::DescriptorSetUniquePtr set_ptr;
+    ThreadData*                   thread_data_ptr = get_thread_data();
+
+    anvil_assert(in_ds_allocation.ds_layout_ptr != nullptr);
+
+    frame_ptr = &thread_data_ptr->frames.at(m_n_current_frame);
+
+    if (!frame_ptr->pool_chain_ptr->alloc_descriptor_set(in_ds_allocation,
+                                                        &set_ptr) )
+    {
+        goto end;
+    }
+
+    result_ptr = set_ptr.get();
+
+    frame_ptr->sets.push_back(
+        std::move(set_ptr)
+    );
+
+end:
+    return result_ptr;
+}
+
+/** Please see header for specification */
+bool Anvil::TransientDescriptorSetAllocator::begin_frame(Anvil::Fence* in_opt_fence_ptr)
+{
+    std::unique_lock<std::mutex> lock              (m_thread_data_mutex);
+    bool                         result            (false);
+    auto                         sizing_profile_ptr(m_device_ptr->get_descriptor_pool_sizing_profile() );
+
+    m_n_current_frame = (m_n_current_frame + 1) % m_n_frames_in_flight;
+
+    /* Make sure the GPU is done with the sets allocated the last time the slot was used */
+    if (m_frame_fences.at(m_n_current_frame) != nullptr)
+    {
+        const VkResult result_vk = m_device_ptr->get_dispatch_table().vkWaitForFences(m_device_ptr->get_device_vk(),
+                                                                                      1, /* fenceCount */
+                                                                                      m_frame_fences.at(m_n_current_frame)->get_fence_ptr(),
+                                                                                      VK_TRUE,     /* waitAll */
+                                                                                      UINT64_MAX); /* timeout */
+
+        if (!is_vk_call_successful(result_vk) )
+        {
+            anvil_assert_vk_call_succeeded(result_vk);
+
+            goto end;
+        }
+    }
+
+    m_frame_fences.at(m_n_current_frame) = in_opt_fence_ptr;
+
+    for (auto& current_thread_data : m_thread_data)
+    {
+        auto& current_frame = current_thread_data.second->frames.at(m_n_current_frame);
+
+        /* Report how much the thread has needed for the frame the slot has last been used for. */
+        sizing_profile_ptr->record_usage(m_sizing_profile_key,
+                                         current_frame.pool_chain_ptr->get_usage() );
+
+        current_frame.sets.clear();
+
+        if (!current_frame.pool_chain_ptr->reset() )
+        {
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::TransientDescriptorSetAllocatorUniquePtr Anvil::TransientDescriptorSetAllocator::create(const Anvil::BaseDevice* in_device_ptr,
+                                                                                               uint32_t                 in_n_frames_in_flight,
+                                                                                               uint32_t                 in_n_sets_per_pool,
+                                                                                               uint32_t                 in_n_descriptors_per_type_pool)
+{
+    Anvil::TransientDescriptorSetAllocatorUniquePtr result_ptr(nullptr,
+                                                               std::default_delete<Anvil::TransientDescriptorSetAllocator>() );
+
+    anvil_assert(in_device_ptr                  != nullptr);
+    anvil_assert(in_n_descriptors_per_type_pool >  0);
+    anvil_assert(in_n_frames_in_flight          >  0);
+    anvil_assert(in_n_sets_per_pool             >  0);
+
+    result_ptr.reset(
+        new Anvil::TransientDescriptorSetAllocator(in_device_ptr,
+                                                   in_n_frames_in_flight,
+                                                   in_n_sets_per_pool,
+                                                   in_n_descriptors_per_type_pool)
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::TransientDescriptorSetAllocator::get_n_pools() const
+{
+    std::unique_lock<std::mutex> lock  (m_thread_data_mutex);
+    uint32_t                     result(0);
+
+    for (const auto& current_thread_data : m_thread_data)
+    {
+        for (const auto& current_frame : current_thread_data.second->frames)
+        {
+            result += current_frame.pool_chain_ptr->get_n_pools();
+        }
+    }
+
+    return result;
+}
+
+/** Returns the calling thread's pool chains, creating them if this is the first time the thread
+ *  allocates from the allocator.
+ *
+ *  The returned pointer stays valid for the allocator's lifetime.
+ */
+Anvil::TransientDescriptorSetAllocator::ThreadData* Anvil::TransientDescriptorSetAllocator::get_thread_data()
+{
+    std::unique_lock<std::mutex> lock          (m_thread_data_mutex);
+    const auto                   thread_id     (std::this_thread::get_id() );
+    auto                         data_iterator = m_thread_data.find(thread_id);
+
+    if (data_iterator == m_thread_data.end() )
+    {
+        data_iterator = m_thread_data.emplace(
+            thread_id,
+            std::unique_ptr<ThreadData>(new ThreadData(m_n_frames_in_flight) )
+        ).first;
+
+        for (auto& current_frame : data_iterator->second->frames)
+        {
+            current_frame.pool_chain_ptr.reset(
+                new Anvil::DescriptorPoolChain(m_device_ptr,
+                                               m_n_sets_per_pool,
+                                               m_n_descriptors_per_type_pool,
+                                              &m_sizing_profile_key)
+            );
+        }
+    }
+
+    return data_iterator->second.get();
+}
@@ -24,7 +24,9 @@
 INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::AccessFlags,                      VkAccessFlags,                         Anvil::AccessFlagBits);
 INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::BufferCreateFlags,                VkBufferCreateFlags,                   Anvil::BufferCreateFlagBits);
 INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::BufferUsageFlags,                 VkBufferUsageFlags,                    Anvil::BufferUsageFlagBits);
+INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::BuildAccelerationStructureFlags,   VkBuildAccelerationStructureFlagsKHR,  Anvil::BuildAccelerationStructureFlagBits);
 INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::ColorComponentFlags,              VkColorComponentFlags,                 Anvil::ColorComponentFlagBits);
+INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::ConditionalRenderingFlags,        VkConditionalRenderingFlagsEXT,        Anvil::ConditionalRenderingFlagBits);
 INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::CompositeAlphaFlags,              VkCompositeAlphaFlagsKHR,              Anvil::CompositeAlphaFlagBits);
 INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::CullModeFlags,                    VkCullModeFlags,                       Anvil::CullModeFlagBits);
 INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::DebugMessageSeverityFlags,        VkDebugUtilsMessageSeverityFlagsEXT,   Anvil::DebugMessageSeverityFlagBits);
@@ -32,6 +34,7 @@ INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::DebugMessageTypeFlags,
 INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::DependencyFlags,                  VkDependencyFlags,                     Anvil::DependencyFlagBits);
 INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::DescriptorBindingFlags,           VkDescriptorBindingFlagsEXT,           Anvil::DescriptorBindingFlagBits);
 INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::DescriptorPoolCreateFlags,        VkDescriptorPoolCreateFlags,           Anvil::DescriptorPoolCreateFlagBits);
+INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::DescriptorSetLayoutCreateFlags,   VkDescriptorSetLayoutCreateFlags,      Anvil::DescriptorSetLayoutCreateFlagBits);
 INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::DeviceGroupPresentModeFlags,      VkDeviceGroupPresentModeFlagsKHR,      Anvil::DeviceGroupPresentModeFlagBits);
 INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::ExternalFenceHandleTypeFlags,     VkExternalFenceHandleTypeFlagsKHR,     Anvil::ExternalFenceHandleTypeFlagBits);
 INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::ExternalMemoryHandleTypeFlags,    VkExternalMemoryHandleTypeFlagsKHR,    Anvil::ExternalMemoryHandleTypeFlagBits);
@@ -51,6 +54,7 @@ INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::QueueFlags,
 INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::QueryControlFlags,                VkQueryControlFlags,                   Anvil::QueryControlFlagBits);
 INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::QueryPipelineStatisticFlags,      VkQueryPipelineStatisticFlags,         Anvil::QueryPipelineStatisticFlagBits);
 INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::QueryResultFlags,                 VkQueryResultFlags,                    Anvil::QueryResultFlagBits);
+INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::RenderingFlags,                   VkRenderingFlagsKHR,                   Anvil::RenderingFlagBits);
 INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::ResolveModeFlags,                 VkResolveModeFlagsKHR,                 Anvil::ResolveModeFlagBits);
 INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::SampleCountFlags,                 VkSampleCountFlags,                    Anvil::SampleCountFlagBits);
 INJECT_BITFIELD_HELPER_FUNC_IMPLEMENTATION(Anvil::ShaderStageFlags,                 VkShaderStageFlags,                    Anvil::ShaderStageFlagBits);
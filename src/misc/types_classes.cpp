@@ -20,6 +20,7 @@
 // THE SOFTWARE.
 //
 #include "misc/buffer_create_info.h"
+#include "misc/formats.h"
 #include "misc/image_create_info.h"
 #include "misc/types.h"
 #include "wrappers/buffer.h"
@@ -93,8 +94,17 @@ void Anvil::SparseMemoryBindingUpdateInfo::append_buffer_memory_update(SparseMem
     update_vk.resourceOffset            = (in_buffer_ptr->get_create_info_ptr()->get_start_offset() + in_buffer_memory_start_offset);
     update_vk.size                      = in_size;
 
-    binding.buffer_updates[in_buffer_ptr].first.push_back (update);
-    binding.buffer_updates[in_buffer_ptr].second.push_back(update_vk);
+    auto& buffer_updates = binding.buffer_updates[in_buffer_ptr];
+
+    if (!coalesce_general_bind(&buffer_updates,
+                                update,
+                                update_vk) )
+    {
+        buffer_updates.first.push_back (update);
+        buffer_updates.second.push_back(update_vk);
+    }
+
+    m_dirty = true;
 }
 
 /** Please see header for specification */
@@ -144,8 +154,18 @@ void Anvil::SparseMemoryBindingUpdateInfo::append_image_memory_update(SparseMemo
     update_vk.offset       = in_offset;
     update_vk.subresource  = in_subresource.get_vk();
 
-    binding.image_updates[in_image_ptr].first.push_back (update);
-    binding.image_updates[in_image_ptr].second.push_back(update_vk);
+    auto& image_updates = binding.image_updates[in_image_ptr];
+
+    if (!coalesce_image_bind(in_image_ptr,
+                            &image_updates,
+                             update,
+                             update_vk) )
+    {
+        image_updates.first.push_back (update);
+        image_updates.second.push_back(update_vk);
+    }
+
+    m_dirty = true;
 }
 
 /** Please see header for specification */
@@ -190,8 +210,17 @@ void Anvil::SparseMemoryBindingUpdateInfo::append_opaque_image_memory_update(Spa
     update_vk.resourceOffset            = in_resource_offset;
     update_vk.size                      = in_size;
 
-    binding.image_opaque_updates[in_image_ptr].first.push_back (update);
-    binding.image_opaque_updates[in_image_ptr].second.push_back(update_vk);
+    auto& image_opaque_updates = binding.image_opaque_updates[in_image_ptr];
+
+    if (!coalesce_general_bind(&image_opaque_updates,
+                                update,
+                                update_vk) )
+    {
+        image_opaque_updates.first.push_back (update);
+        image_opaque_updates.second.push_back(update_vk);
+    }
+
+    m_dirty = true;
 }
 
 /** Please see header for specification */
@@ -344,6 +373,151 @@ void Anvil::SparseMemoryBindingUpdateInfo::bake()
     m_dirty = false;
 }
 
+/** Merges a buffer or opaque image memory update with the last update recorded for the same resource, if the
+ *  former continues the range described by the latter, using the same memory block at a contiguous memory offset.
+ *
+ *  @param in_updates_ptr Updates recorded so far for the resource. Must not be null.
+ *  @param in_update      Update to merge.
+ *  @param in_update_vk   Vulkan descriptor of the update to merge.
+ *
+ *  @return true if the update has been merged, false if it needs to be appended as a separate entry.
+ */
+bool Anvil::SparseMemoryBindingUpdateInfo::coalesce_general_bind(GeneralBindUpdates*       in_updates_ptr,
+                                                                 const GeneralBindInfo&    in_update,
+                                                                 const VkSparseMemoryBind& in_update_vk)
+{
+    bool result = false;
+
+    if (in_updates_ptr->first.size() == 0)
+    {
+        goto end;
+    }
+
+    {
+        auto& last_update    = in_updates_ptr->first.back ();
+        auto& last_update_vk = in_updates_ptr->second.back();
+
+        /* Each ownership transfer must reach the target resource separately. */
+        if (last_update.memory_block_owned_by_target ||
+            in_update.memory_block_owned_by_target)
+        {
+            goto end;
+        }
+
+        if (last_update.memory_block_ptr                      != in_update.memory_block_ptr ||
+            last_update.n_plane                               != in_update.n_plane          ||
+            last_update_vk.flags                              != in_update_vk.flags         ||
+            last_update_vk.resourceOffset + last_update_vk.size != in_update_vk.resourceOffset)
+        {
+            goto end;
+        }
+
+        if (in_update.memory_block_ptr                                != nullptr &&
+            last_update.memory_block_start_offset + last_update.size != in_update.memory_block_start_offset)
+        {
+            goto end;
+        }
+
+        last_update.size    += in_update.size;
+        last_update_vk.size += in_update_vk.size;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Merges a non-opaque image memory update with the last update recorded for the same image, if both refer to
+ *  the same subresource and the former covers the tiles which follow, along the X axis, the single-tile-high
+ *  run of tiles described by the latter. Memory backing the merged run must be contiguous.
+ *
+ *  Multi-planar images are not coalesced.
+ *
+ *  @param in_image_ptr   Image the update refers to. Must not be null.
+ *  @param in_updates_ptr Updates recorded so far for the image. Must not be null.
+ *  @param in_update      Update to merge.
+ *  @param in_update_vk   Vulkan descriptor of the update to merge.
+ *
+ *  @return true if the update has been merged, false if it needs to be appended as a separate entry.
+ */
+bool Anvil::SparseMemoryBindingUpdateInfo::coalesce_image_bind(const Anvil::Image*            in_image_ptr,
+                                                               ImageBindUpdates*              in_updates_ptr,
+                                                               const ImageBindInfo&           in_update,
+                                                               const VkSparseImageMemoryBind& in_update_vk)
+{
+    const Anvil::SparseImageAspectProperties* aspect_props_ptr = nullptr;
+    bool                                      result           = false;
+
+    if (in_updates_ptr->first.size() == 0)
+    {
+        goto end;
+    }
+
+    if (Anvil::Formats::is_format_multiplanar(in_image_ptr->get_create_info_ptr()->get_format() ) )
+    {
+        goto end;
+    }
+
+    if (!in_image_ptr->get_sparse_image_aspect_properties(static_cast<Anvil::ImageAspectFlagBits>(in_update_vk.subresource.aspectMask),
+                                                         &aspect_props_ptr) )
+    {
+        goto end;
+    }
+
+    {
+        const VkExtent3D& granularity    = aspect_props_ptr->granularity;
+        auto&             last_update    = in_updates_ptr->first.back ();
+        auto&             last_update_vk = in_updates_ptr->second.back();
+
+        if (last_update.memory_block_owned_by_image ||
+            in_update.memory_block_owned_by_image)
+        {
+            goto end;
+        }
+
+        if (last_update.memory_block_ptr          != in_update.memory_block_ptr          ||
+            last_update_vk.flags                  != in_update_vk.flags                  ||
+            last_update_vk.subresource.aspectMask != in_update_vk.subresource.aspectMask ||
+            last_update_vk.subresource.arrayLayer != in_update_vk.subresource.arrayLayer ||
+            last_update_vk.subresource.mipLevel   != in_update_vk.subresource.mipLevel)
+        {
+            goto end;
+        }
+
+        /* Tiles of a multi-row region are bound in row-major order, so only single-tile-high runs can be extended
+         * without breaking memory contiguity.
+         */
+        if (last_update_vk.offset.y                                                   != in_update_vk.offset.y       ||
+            last_update_vk.offset.z                                                   != in_update_vk.offset.z       ||
+            last_update_vk.extent.height                                              != in_update_vk.extent.height  ||
+            last_update_vk.extent.depth                                               != in_update_vk.extent.depth   ||
+            last_update_vk.extent.height                                              >  granularity.height          ||
+            last_update_vk.extent.depth                                               >  granularity.depth           ||
+            (last_update_vk.extent.width % granularity.width)                         != 0                           ||
+            last_update_vk.offset.x + static_cast<int32_t>(last_update_vk.extent.width) != in_update_vk.offset.x)
+        {
+            goto end;
+        }
+
+        if (in_update.memory_block_ptr != nullptr)
+        {
+            const VkDeviceSize last_update_n_tiles = last_update_vk.extent.width / granularity.width;
+
+            if (last_update.memory_block_start_offset + last_update_n_tiles * in_image_ptr->get_image_alignment(0 /* in_n_plane */) != in_update.memory_block_start_offset)
+            {
+                goto end;
+            }
+        }
+
+        last_update.extent.width    += in_update.extent.width;
+        last_update_vk.extent.width += in_update_vk.extent.width;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
 /** Please see header for specification */
 bool Anvil::SparseMemoryBindingUpdateInfo::get_bind_info_properties(SparseMemoryBindInfoID in_bind_info_id,
                                                                     uint32_t* const        out_opt_n_buffer_memory_updates_ptr,
@@ -26,6 +26,7 @@
 #include "wrappers/buffer.h"
 #include "wrappers/descriptor_set_layout.h"
 #include "wrappers/image.h"
+#include "wrappers/image_view.h"
 #include <cfloat>
 #include <cmath>
 
@@ -328,6 +329,146 @@ VkDescriptorUpdateTemplateEntryKHR Anvil::DescriptorUpdateTemplateEntry::get_vk_
     return result;
 }
 
+Anvil::DeviceDispatchTable::DeviceDispatchTable()
+{
+    vkDestroyDevice                     = nullptr;
+    vkGetDeviceQueue                    = nullptr;
+    vkQueueSubmit                       = nullptr;
+    vkQueueWaitIdle                     = nullptr;
+    vkDeviceWaitIdle                    = nullptr;
+    vkAllocateMemory                    = nullptr;
+    vkFreeMemory                        = nullptr;
+    vkMapMemory                         = nullptr;
+    vkUnmapMemory                       = nullptr;
+    vkFlushMappedMemoryRanges           = nullptr;
+    vkInvalidateMappedMemoryRanges      = nullptr;
+    vkGetDeviceMemoryCommitment         = nullptr;
+    vkBindBufferMemory                  = nullptr;
+    vkBindImageMemory                   = nullptr;
+    vkGetBufferMemoryRequirements       = nullptr;
+    vkGetImageMemoryRequirements        = nullptr;
+    vkGetImageSparseMemoryRequirements  = nullptr;
+    vkQueueBindSparse                   = nullptr;
+    vkCreateFence                       = nullptr;
+    vkDestroyFence                      = nullptr;
+    vkResetFences                       = nullptr;
+    vkGetFenceStatus                    = nullptr;
+    vkWaitForFences                     = nullptr;
+    vkCreateSemaphore                   = nullptr;
+    vkDestroySemaphore                  = nullptr;
+    vkCreateEvent                       = nullptr;
+    vkDestroyEvent                      = nullptr;
+    vkGetEventStatus                    = nullptr;
+    vkSetEvent                          = nullptr;
+    vkResetEvent                        = nullptr;
+    vkCreateQueryPool                   = nullptr;
+    vkDestroyQueryPool                  = nullptr;
+    vkGetQueryPoolResults               = nullptr;
+    vkCreateBuffer                      = nullptr;
+    vkDestroyBuffer                     = nullptr;
+    vkCreateBufferView                  = nullptr;
+    vkDestroyBufferView                 = nullptr;
+    vkCreateImage                       = nullptr;
+    vkDestroyImage                      = nullptr;
+    vkGetImageSubresourceLayout         = nullptr;
+    vkCreateImageView                   = nullptr;
+    vkDestroyImageView                  = nullptr;
+    vkCreateShaderModule                = nullptr;
+    vkDestroyShaderModule               = nullptr;
+    vkCreatePipelineCache               = nullptr;
+    vkDestroyPipelineCache              = nullptr;
+    vkGetPipelineCacheData              = nullptr;
+    vkMergePipelineCaches               = nullptr;
+    vkCreateGraphicsPipelines           = nullptr;
+    vkCreateComputePipelines            = nullptr;
+    vkDestroyPipeline                   = nullptr;
+    vkCreatePipelineLayout              = nullptr;
+    vkDestroyPipelineLayout             = nullptr;
+    vkCreateSampler                     = nullptr;
+    vkDestroySampler                    = nullptr;
+    vkCreateDescriptorSetLayout         = nullptr;
+    vkDestroyDescriptorSetLayout        = nullptr;
+    vkCreateDescriptorPool              = nullptr;
+    vkDestroyDescriptorPool             = nullptr;
+    vkResetDescriptorPool               = nullptr;
+    vkAllocateDescriptorSets            = nullptr;
+    vkFreeDescriptorSets                = nullptr;
+    vkUpdateDescriptorSets              = nullptr;
+    vkCreateFramebuffer                 = nullptr;
+    vkDestroyFramebuffer                = nullptr;
+    vkCreateRenderPass                  = nullptr;
+    vkDestroyRenderPass                 = nullptr;
+    vkGetRenderAreaGranularity          = nullptr;
+    vkCreateCommandPool                 = nullptr;
+    vkDestroyCommandPool                = nullptr;
+    vkResetCommandPool                  = nullptr;
+    vkAllocateCommandBuffers            = nullptr;
+    vkFreeCommandBuffers                = nullptr;
+    vkBeginCommandBuffer                = nullptr;
+    vkEndCommandBuffer                  = nullptr;
+    vkResetCommandBuffer                = nullptr;
+    vkCmdBindPipeline                   = nullptr;
+    vkCmdSetViewport                    = nullptr;
+    vkCmdSetScissor                     = nullptr;
+    vkCmdSetLineWidth                   = nullptr;
+    vkCmdSetDepthBias                   = nullptr;
+    vkCmdSetBlendConstants              = nullptr;
+    vkCmdSetDepthBounds                 = nullptr;
+    vkCmdSetStencilCompareMask          = nullptr;
+    vkCmdSetStencilWriteMask            = nullptr;
+    vkCmdSetStencilReference            = nullptr;
+    vkCmdBindDescriptorSets             = nullptr;
+    vkCmdBindIndexBuffer                = nullptr;
+    vkCmdBindVertexBuffers              = nullptr;
+    vkCmdDraw                           = nullptr;
+    vkCmdDrawIndexed                    = nullptr;
+    vkCmdDrawIndirect                   = nullptr;
+    vkCmdDrawIndexedIndirect            = nullptr;
+    vkCmdDispatch                       = nullptr;
+    vkCmdDispatchIndirect               = nullptr;
+    vkCmdCopyBuffer                     = nullptr;
+    vkCmdCopyImage                      = nullptr;
+    vkCmdBlitImage                      = nullptr;
+    vkCmdCopyBufferToImage              = nullptr;
+    vkCmdCopyImageToBuffer              = nullptr;
+    vkCmdUpdateBuffer                   = nullptr;
+    vkCmdFillBuffer                     = nullptr;
+    vkCmdClearColorImage                = nullptr;
+    vkCmdClearDepthStencilImage         = nullptr;
+    vkCmdClearAttachments               = nullptr;
+    vkCmdResolveImage                   = nullptr;
+    vkCmdSetEvent                       = nullptr;
+    vkCmdResetEvent                     = nullptr;
+    vkCmdWaitEvents                     = nullptr;
+    vkCmdPipelineBarrier                = nullptr;
+    vkCmdBeginQuery                     = nullptr;
+    vkCmdEndQuery                       = nullptr;
+    vkCmdResetQueryPool                 = nullptr;
+    vkCmdWriteTimestamp                 = nullptr;
+    vkCmdCopyQueryPoolResults           = nullptr;
+    vkCmdPushConstants                  = nullptr;
+    vkCmdBeginRenderPass                = nullptr;
+    vkCmdNextSubpass                    = nullptr;
+    vkCmdEndRenderPass                  = nullptr;
+    vkCmdExecuteCommands                = nullptr;
+    vkBindBufferMemory2                 = nullptr;
+    vkBindImageMemory2                  = nullptr;
+    vkCmdDispatchBase                   = nullptr;
+    vkCmdSetDeviceMask                  = nullptr;
+    vkCreateDescriptorUpdateTemplate    = nullptr;
+    vkCreateSamplerYcbcrConversion      = nullptr;
+    vkDestroyDescriptorUpdateTemplate   = nullptr;
+    vkDestroySamplerYcbcrConversion     = nullptr;
+    vkGetBufferMemoryRequirements2      = nullptr;
+    vkGetDescriptorSetLayoutSupport     = nullptr;
+    vkGetDeviceGroupPeerMemoryFeatures  = nullptr;
+    vkGetDeviceQueue2                   = nullptr;
+    vkGetImageMemoryRequirements2       = nullptr;
+    vkGetImageSparseMemoryRequirements2 = nullptr;
+    vkTrimCommandPool                   = nullptr;
+    vkUpdateDescriptorSetWithTemplate   = nullptr;
+}
+
 Anvil::ExtensionAMDBufferMarkerEntrypoints::ExtensionAMDBufferMarkerEntrypoints()
 {
     vkCmdWriteBufferMarkerAMD = nullptr;
@@ -344,6 +485,18 @@ Anvil::ExtensionAMDShaderInfoEntrypoints::ExtensionAMDShaderInfoEntrypoints()
     vkGetShaderInfoAMD = nullptr;
 }
 
+Anvil::ExtensionEXTCalibratedTimestampsEntrypoints::ExtensionEXTCalibratedTimestampsEntrypoints()
+{
+    vkGetCalibratedTimestampsEXT                   = nullptr;
+    vkGetPhysicalDeviceCalibrateableTimeDomainsEXT = nullptr;
+}
+
+Anvil::ExtensionEXTConditionalRenderingEntrypoints::ExtensionEXTConditionalRenderingEntrypoints()
+{
+    vkCmdBeginConditionalRenderingEXT = nullptr;
+    vkCmdEndConditionalRenderingEXT   = nullptr;
+}
+
 Anvil::ExtensionEXTDebugMarkerEntrypoints::ExtensionEXTDebugMarkerEntrypoints()
 {
     vkCmdDebugMarkerBeginEXT      = nullptr;
@@ -385,6 +538,22 @@ Anvil::ExtensionEXTHdrMetadataEntrypoints::ExtensionEXTHdrMetadataEntrypoints()
     vkSetHdrMetadataEXT = nullptr;
 }
 
+Anvil::ExtensionEXTHostImageCopyEntrypoints::ExtensionEXTHostImageCopyEntrypoints()
+{
+    vkCopyMemoryToImageEXT     = nullptr;
+    vkTransitionImageLayoutEXT = nullptr;
+}
+
+Anvil::ExtensionEXTHostQueryResetEntrypoints::ExtensionEXTHostQueryResetEntrypoints()
+{
+    vkResetQueryPoolEXT = nullptr;
+}
+
+Anvil::ExtensionEXTPageableDeviceLocalMemoryEntrypoints::ExtensionEXTPageableDeviceLocalMemoryEntrypoints()
+{
+    vkSetDeviceMemoryPriorityEXT = nullptr;
+}
+
 Anvil::ExtensionEXTSampleLocationsEntrypoints::ExtensionEXTSampleLocationsEntrypoints()
 {
     vkCmdSetSampleLocationsEXT                  = nullptr;
@@ -401,6 +570,12 @@ Anvil::ExtensionEXTTransformFeedbackEntrypoints::ExtensionEXTTransformFeedbackEn
     vkCmdEndTransformFeedbackEXT         = nullptr;
 }
 
+Anvil::ExtensionGOOGLEDisplayTimingEntrypoints::ExtensionGOOGLEDisplayTimingEntrypoints()
+{
+    vkGetPastPresentationTimingGOOGLE = nullptr;
+    vkGetRefreshCycleDurationGOOGLE   = nullptr;
+}
+
 Anvil::ExtensionKHRCreateRenderpass2Entrypoints::ExtensionKHRCreateRenderpass2Entrypoints()
 {
     vkCmdBeginRenderPass2KHR = nullptr;
@@ -420,12 +595,28 @@ Anvil::ExtensionKHRDeviceGroupEntrypoints::ExtensionKHRDeviceGroupEntrypoints()
     vkCmdSetDeviceMaskKHR                   = nullptr;
 }
 
+Anvil::ExtensionKHRAccelerationStructureEntrypoints::ExtensionKHRAccelerationStructureEntrypoints()
+{
+    vkCmdBuildAccelerationStructuresKHR           = nullptr;
+    vkCmdCopyAccelerationStructureKHR             = nullptr;
+    vkCmdWriteAccelerationStructuresPropertiesKHR = nullptr;
+    vkCreateAccelerationStructureKHR              = nullptr;
+    vkDestroyAccelerationStructureKHR             = nullptr;
+    vkGetAccelerationStructureBuildSizesKHR       = nullptr;
+    vkGetAccelerationStructureDeviceAddressKHR    = nullptr;
+}
+
 Anvil::ExtensionKHRBindMemory2Entrypoints::ExtensionKHRBindMemory2Entrypoints()
 {
     vkBindBufferMemory2KHR = nullptr;
     vkBindImageMemory2KHR  = nullptr;
 }
 
+Anvil::ExtensionKHRBufferDeviceAddressEntrypoints::ExtensionKHRBufferDeviceAddressEntrypoints()
+{
+    vkGetBufferDeviceAddressKHR = nullptr;
+}
+
 Anvil::ExtensionKHRDescriptorUpdateTemplateEntrypoints::ExtensionKHRDescriptorUpdateTemplateEntrypoints()
 {
     vkCreateDescriptorUpdateTemplateKHR  = nullptr;
@@ -444,6 +635,12 @@ Anvil::ExtensionKHRDrawIndirectCountEntrypoints::ExtensionKHRDrawIndirectCountEn
     vkCmdDrawIndirectCountKHR        = nullptr;
 }
 
+Anvil::ExtensionKHRDynamicRenderingEntrypoints::ExtensionKHRDynamicRenderingEntrypoints()
+{
+    vkCmdBeginRenderingKHR = nullptr;
+    vkCmdEndRenderingKHR   = nullptr;
+}
+
 Anvil::ExtensionKHRExternalFenceCapabilitiesEntrypoints::ExtensionKHRExternalFenceCapabilitiesEntrypoints()
 {
     vkGetPhysicalDeviceExternalFencePropertiesKHR = nullptr;
@@ -507,6 +704,18 @@ Anvil::ExtensionKHRMaintenance3Entrypoints::ExtensionKHRMaintenance3Entrypoints(
     vkGetDescriptorSetLayoutSupportKHR = nullptr;
 }
 
+Anvil::ExtensionKHRPipelineExecutablePropertiesEntrypoints::ExtensionKHRPipelineExecutablePropertiesEntrypoints()
+{
+    vkGetPipelineExecutablePropertiesKHR = nullptr;
+    vkGetPipelineExecutableStatisticsKHR = nullptr;
+}
+
+Anvil::ExtensionKHRPushDescriptorEntrypoints::ExtensionKHRPushDescriptorEntrypoints()
+{
+    vkCmdPushDescriptorSetKHR             = nullptr;
+    vkCmdPushDescriptorSetWithTemplateKHR = nullptr;
+}
+
 Anvil::ExtensionKHRSamplerYCbCrConversionEntrypoints::ExtensionKHRSamplerYCbCrConversionEntrypoints()
 {
     vkCreateSamplerYcbcrConversionKHR  = nullptr;
@@ -531,6 +740,13 @@ Anvil::ExtensionKHRSwapchainEntrypoints::ExtensionKHRSwapchainEntrypoints()
     vkQueuePresentKHR       = nullptr;
 }
 
+Anvil::ExtensionKHRTimelineSemaphoreEntrypoints::ExtensionKHRTimelineSemaphoreEntrypoints()
+{
+    vkGetSemaphoreCounterValueKHR = nullptr;
+    vkSignalSemaphoreKHR          = nullptr;
+    vkWaitSemaphoresKHR           = nullptr;
+}
+
 #ifdef _WIN32
     #if defined(ANVIL_INCLUDE_WIN3264_WINDOW_SYSTEM_SUPPORT)
         Anvil::ExtensionKHRWin32SurfaceEntrypoints::ExtensionKHRWin32SurfaceEntrypoints()
@@ -548,6 +764,20 @@ Anvil::ExtensionKHRSwapchainEntrypoints::ExtensionKHRSwapchainEntrypoints()
     #endif
 #endif
 
+Anvil::ExtensionNVMeshShaderEntrypoints::ExtensionNVMeshShaderEntrypoints()
+{
+    vkCmdDrawMeshTasksIndirectCountNV = nullptr;
+    vkCmdDrawMeshTasksIndirectNV      = nullptr;
+    vkCmdDrawMeshTasksNV              = nullptr;
+}
+
+Anvil::ExtensionNVShadingRateImageEntrypoints::ExtensionNVShadingRateImageEntrypoints()
+{
+    vkCmdBindShadingRateImageNV          = nullptr;
+    vkCmdSetCoarseSampleOrderNV          = nullptr;
+    vkCmdSetViewportShadingRatePaletteNV = nullptr;
+}
+
 Anvil::ExtensionKHRGetMemoryRequirements2Entrypoints::ExtensionKHRGetMemoryRequirements2Entrypoints()
 {
     vkGetBufferMemoryRequirements2KHR      = nullptr;
@@ -626,6 +856,36 @@ VkPhysicalDeviceConservativeRasterizationPropertiesEXT Anvil::EXTConservativeRas
     return result;
 }
 
+Anvil::EXTConditionalRenderingFeatures::EXTConditionalRenderingFeatures()
+{
+    conditional_rendering           = false;
+    inherited_conditional_rendering = false;
+}
+
+Anvil::EXTConditionalRenderingFeatures::EXTConditionalRenderingFeatures(const VkPhysicalDeviceConditionalRenderingFeaturesEXT& in_features)
+{
+    conditional_rendering           = VK_BOOL32_TO_BOOL(in_features.conditionalRendering);
+    inherited_conditional_rendering = VK_BOOL32_TO_BOOL(in_features.inheritedConditionalRendering);
+}
+
+VkPhysicalDeviceConditionalRenderingFeaturesEXT Anvil::EXTConditionalRenderingFeatures::get_vk_physical_device_conditional_rendering_features() const
+{
+    VkPhysicalDeviceConditionalRenderingFeaturesEXT result;
+
+    result.conditionalRendering          = BOOL_TO_VK_BOOL32(conditional_rendering);
+    result.inheritedConditionalRendering = BOOL_TO_VK_BOOL32(inherited_conditional_rendering);
+    result.pNext                         = nullptr;
+    result.sType                         = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_CONDITIONAL_RENDERING_FEATURES_EXT;
+
+    return result;
+}
+
+bool Anvil::EXTConditionalRenderingFeatures::operator==(const EXTConditionalRenderingFeatures& in_features) const
+{
+    return (in_features.conditional_rendering           == conditional_rendering            &&
+            in_features.inherited_conditional_rendering == inherited_conditional_rendering);
+}
+
 Anvil::EXTDepthClipEnableFeatures::EXTDepthClipEnableFeatures()
     :depth_clip_enable(false)
 {
@@ -758,6 +1018,58 @@ VkPhysicalDeviceDescriptorIndexingFeaturesEXT Anvil::EXTDescriptorIndexingFeatur
     return result;
 }
 
+Anvil::EXTHostImageCopyFeatures::EXTHostImageCopyFeatures()
+{
+    host_image_copy = false;
+}
+
+Anvil::EXTHostImageCopyFeatures::EXTHostImageCopyFeatures(const VkPhysicalDeviceHostImageCopyFeaturesEXT& in_features)
+{
+    host_image_copy = VK_BOOL32_TO_BOOL(in_features.hostImageCopy);
+}
+
+VkPhysicalDeviceHostImageCopyFeaturesEXT Anvil::EXTHostImageCopyFeatures::get_vk_physical_device_host_image_copy_features() const
+{
+    VkPhysicalDeviceHostImageCopyFeaturesEXT result;
+
+    result.hostImageCopy = BOOL_TO_VK_BOOL32(host_image_copy);
+    result.pNext         = nullptr;
+    result.sType         = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_FEATURES_EXT;
+
+    return result;
+}
+
+bool Anvil::EXTHostImageCopyFeatures::operator==(const EXTHostImageCopyFeatures& in_features) const
+{
+    return (in_features.host_image_copy == host_image_copy);
+}
+
+Anvil::EXTHostQueryResetFeatures::EXTHostQueryResetFeatures()
+{
+    host_query_reset = false;
+}
+
+Anvil::EXTHostQueryResetFeatures::EXTHostQueryResetFeatures(const VkPhysicalDeviceHostQueryResetFeaturesEXT& in_features)
+{
+    host_query_reset = VK_BOOL32_TO_BOOL(in_features.hostQueryReset);
+}
+
+VkPhysicalDeviceHostQueryResetFeaturesEXT Anvil::EXTHostQueryResetFeatures::get_vk_physical_device_host_query_reset_features() const
+{
+    VkPhysicalDeviceHostQueryResetFeaturesEXT result;
+
+    result.hostQueryReset = BOOL_TO_VK_BOOL32(host_query_reset);
+    result.pNext          = nullptr;
+    result.sType          = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_QUERY_RESET_FEATURES_EXT;
+
+    return result;
+}
+
+bool Anvil::EXTHostQueryResetFeatures::operator==(const EXTHostQueryResetFeatures& in_features) const
+{
+    return (in_features.host_query_reset == host_query_reset);
+}
+
 Anvil::EXTDescriptorIndexingProperties::EXTDescriptorIndexingProperties()
     :max_descriptor_set_update_after_bind_input_attachments      (UINT32_MAX),
      max_descriptor_set_update_after_bind_sampled_images         (UINT32_MAX),
@@ -1015,6 +1327,64 @@ bool Anvil::EXTScalarBlockLayoutFeatures::operator==(const EXTScalarBlockLayoutF
     return (in_features.scalar_block_layout == scalar_block_layout);
 }
 
+Anvil::EXTSubgroupSizeControlFeatures::EXTSubgroupSizeControlFeatures()
+    :compute_full_subgroups(false),
+     subgroup_size_control (false)
+{
+    /* Stub */
+}
+
+Anvil::EXTSubgroupSizeControlFeatures::EXTSubgroupSizeControlFeatures(const VkPhysicalDeviceSubgroupSizeControlFeaturesEXT& in_features)
+    :compute_full_subgroups(in_features.computeFullSubgroups == VK_TRUE),
+     subgroup_size_control (in_features.subgroupSizeControl  == VK_TRUE)
+{
+    /* Stub */
+}
+
+VkPhysicalDeviceSubgroupSizeControlFeaturesEXT Anvil::EXTSubgroupSizeControlFeatures::get_vk_physical_device_subgroup_size_control_features() const
+{
+    VkPhysicalDeviceSubgroupSizeControlFeaturesEXT result;
+
+    result.computeFullSubgroups = (compute_full_subgroups) ? VK_TRUE : VK_FALSE;
+    result.pNext                = nullptr;
+    result.sType                = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_SIZE_CONTROL_FEATURES_EXT;
+    result.subgroupSizeControl  = (subgroup_size_control) ? VK_TRUE : VK_FALSE;
+
+    return result;
+}
+
+bool Anvil::EXTSubgroupSizeControlFeatures::operator==(const EXTSubgroupSizeControlFeatures& in_features) const
+{
+    return (in_features.compute_full_subgroups == compute_full_subgroups &&
+            in_features.subgroup_size_control  == subgroup_size_control);
+}
+
+Anvil::EXTSubgroupSizeControlProperties::EXTSubgroupSizeControlProperties()
+    :max_compute_workgroup_subgroups(0),
+     max_subgroup_size              (0),
+     min_subgroup_size              (0),
+     required_subgroup_size_stages  (Anvil::ShaderStageFlagBits::NONE)
+{
+    /* Stub */
+}
+
+Anvil::EXTSubgroupSizeControlProperties::EXTSubgroupSizeControlProperties(const VkPhysicalDeviceSubgroupSizeControlPropertiesEXT& in_props)
+    :max_compute_workgroup_subgroups(in_props.maxComputeWorkgroupSubgroups),
+     max_subgroup_size              (in_props.maxSubgroupSize),
+     min_subgroup_size              (in_props.minSubgroupSize),
+     required_subgroup_size_stages  (static_cast<Anvil::ShaderStageFlagBits>(in_props.requiredSubgroupSizeStages) )
+{
+    /* Stub */
+}
+
+bool Anvil::EXTSubgroupSizeControlProperties::operator==(const EXTSubgroupSizeControlProperties& in_props) const
+{
+    return (max_compute_workgroup_subgroups == in_props.max_compute_workgroup_subgroups &&
+            max_subgroup_size               == in_props.max_subgroup_size               &&
+            min_subgroup_size               == in_props.min_subgroup_size               &&
+            required_subgroup_size_stages   == in_props.required_subgroup_size_stages);
+}
+
 Anvil::EXTTransformFeedbackFeatures::EXTTransformFeedbackFeatures()
     :geometry_streams  (false),
      transform_feedback(false)
@@ -1300,6 +1670,13 @@ bool Anvil::ImageBarrier::operator==(const ImageBarrier& in_barrier) const
     return result;
 }
 
+Anvil::ImageMemoryBindingUpdate::ImageMemoryBindingUpdate()
+{
+    image_ptr                   = nullptr;
+    memory_block_owned_by_image = false;
+    memory_block_ptr            = nullptr;
+}
+
 bool Anvil::ImageSubresourceRange::operator==(const Anvil::ImageSubresourceRange& in_subresource_range) const
 {
     return (aspect_mask      == in_subresource_range.aspect_mask      &&
@@ -1383,6 +1760,32 @@ bool Anvil::EXTMemoryPriorityFeatures::operator==(const EXTMemoryPriorityFeature
     return (is_memory_priority_supported == in_memory_priority_features.is_memory_priority_supported);
 }
 
+Anvil::EXTPageableDeviceLocalMemoryFeatures::EXTPageableDeviceLocalMemoryFeatures()
+{
+    is_pageable_device_local_memory_supported = false;
+}
+
+Anvil::EXTPageableDeviceLocalMemoryFeatures::EXTPageableDeviceLocalMemoryFeatures(const VkPhysicalDevicePageableDeviceLocalMemoryFeaturesEXT& in_features)
+{
+    is_pageable_device_local_memory_supported = VK_BOOL32_TO_BOOL(in_features.pageableDeviceLocalMemory);
+}
+
+VkPhysicalDevicePageableDeviceLocalMemoryFeaturesEXT Anvil::EXTPageableDeviceLocalMemoryFeatures::get_vk_physical_device_pageable_device_local_memory_features() const
+{
+    VkPhysicalDevicePageableDeviceLocalMemoryFeaturesEXT result;
+
+    result.sType                     = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PAGEABLE_DEVICE_LOCAL_MEMORY_FEATURES_EXT;
+    result.pNext                     = nullptr;
+    result.pageableDeviceLocalMemory = BOOL_TO_VK_BOOL32(is_pageable_device_local_memory_supported);
+
+    return result;
+}
+
+bool Anvil::EXTPageableDeviceLocalMemoryFeatures::operator==(const EXTPageableDeviceLocalMemoryFeatures& in_features) const
+{
+    return (is_pageable_device_local_memory_supported == in_features.is_pageable_device_local_memory_supported);
+}
+
 Anvil::KHR16BitStorageFeatures::KHR16BitStorageFeatures()
 {
     is_input_output_storage_supported                     = false;
@@ -1456,6 +1859,82 @@ bool Anvil::KHR8BitStorageFeatures::operator==(const Anvil::KHR8BitStorageFeatur
             uniform_and_storage_buffer_8_bit_access == in_features.uniform_and_storage_buffer_8_bit_access);
 }
 
+Anvil::KHRAccelerationStructureFeatures::KHRAccelerationStructureFeatures()
+{
+    acceleration_structure                                      = false;
+    acceleration_structure_capture_replay                       = false;
+    acceleration_structure_host_commands                        = false;
+    acceleration_structure_indirect_build                       = false;
+    descriptor_binding_acceleration_structure_update_after_bind = false;
+}
+
+Anvil::KHRAccelerationStructureFeatures::KHRAccelerationStructureFeatures(const VkPhysicalDeviceAccelerationStructureFeaturesKHR& in_features)
+{
+    acceleration_structure                                      = (in_features.accelerationStructure                                 == VK_TRUE);
+    acceleration_structure_capture_replay                       = (in_features.accelerationStructureCaptureReplay                    == VK_TRUE);
+    acceleration_structure_host_commands                        = (in_features.accelerationStructureHostCommands                     == VK_TRUE);
+    acceleration_structure_indirect_build                       = (in_features.accelerationStructureIndirectBuild                    == VK_TRUE);
+    descriptor_binding_acceleration_structure_update_after_bind = (in_features.descriptorBindingAccelerationStructureUpdateAfterBind == VK_TRUE);
+}
+
+VkPhysicalDeviceAccelerationStructureFeaturesKHR Anvil::KHRAccelerationStructureFeatures::get_vk_physical_device_acceleration_structure_features() const
+{
+    VkPhysicalDeviceAccelerationStructureFeaturesKHR result;
+
+    result.accelerationStructure                                 = (acceleration_structure)                                      ? VK_TRUE : VK_FALSE;
+    result.accelerationStructureCaptureReplay                    = (acceleration_structure_capture_replay)                       ? VK_TRUE : VK_FALSE;
+    result.accelerationStructureHostCommands                     = (acceleration_structure_host_commands)                        ? VK_TRUE : VK_FALSE;
+    result.accelerationStructureIndirectBuild                    = (acceleration_structure_indirect_build)                       ? VK_TRUE : VK_FALSE;
+    result.descriptorBindingAccelerationStructureUpdateAfterBind = (descriptor_binding_acceleration_structure_update_after_bind) ? VK_TRUE : VK_FALSE;
+    result.pNext                                                 = nullptr;
+    result.sType                                                 = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR;
+
+    return result;
+}
+
+bool Anvil::KHRAccelerationStructureFeatures::operator==(const Anvil::KHRAccelerationStructureFeatures& in_features) const
+{
+    return (acceleration_structure                                      == in_features.acceleration_structure                                      &&
+            acceleration_structure_capture_replay                       == in_features.acceleration_structure_capture_replay                       &&
+            acceleration_structure_host_commands                        == in_features.acceleration_structure_host_commands                        &&
+            acceleration_structure_indirect_build                       == in_features.acceleration_structure_indirect_build                       &&
+            descriptor_binding_acceleration_structure_update_after_bind == in_features.descriptor_binding_acceleration_structure_update_after_bind);
+}
+
+Anvil::KHRBufferDeviceAddressFeatures::KHRBufferDeviceAddressFeatures()
+{
+    buffer_device_address                = false;
+    buffer_device_address_capture_replay = false;
+    buffer_device_address_multi_device   = false;
+}
+
+Anvil::KHRBufferDeviceAddressFeatures::KHRBufferDeviceAddressFeatures(const VkPhysicalDeviceBufferDeviceAddressFeaturesKHR& in_features)
+{
+    buffer_device_address                = (in_features.bufferDeviceAddress              == VK_TRUE);
+    buffer_device_address_capture_replay = (in_features.bufferDeviceAddressCaptureReplay == VK_TRUE);
+    buffer_device_address_multi_device   = (in_features.bufferDeviceAddressMultiDevice   == VK_TRUE);
+}
+
+VkPhysicalDeviceBufferDeviceAddressFeaturesKHR Anvil::KHRBufferDeviceAddressFeatures::get_vk_physical_device_buffer_device_address_features() const
+{
+    VkPhysicalDeviceBufferDeviceAddressFeaturesKHR result;
+
+    result.bufferDeviceAddress              = (buffer_device_address)                ? VK_TRUE : VK_FALSE;
+    result.bufferDeviceAddressCaptureReplay = (buffer_device_address_capture_replay) ? VK_TRUE : VK_FALSE;
+    result.bufferDeviceAddressMultiDevice   = (buffer_device_address_multi_device)   ? VK_TRUE : VK_FALSE;
+    result.pNext                            = nullptr;
+    result.sType                            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES_KHR;
+
+    return result;
+}
+
+bool Anvil::KHRBufferDeviceAddressFeatures::operator==(const Anvil::KHRBufferDeviceAddressFeatures& in_features) const
+{
+    return (buffer_device_address                == in_features.buffer_device_address                &&
+            buffer_device_address_capture_replay == in_features.buffer_device_address_capture_replay &&
+            buffer_device_address_multi_device   == in_features.buffer_device_address_multi_device);
+}
+
 Anvil::KHRDepthStencilResolveProperties::KHRDepthStencilResolveProperties()
 {
     independent_resolve             = false;
@@ -1542,6 +2021,32 @@ end:
 }
 
 
+Anvil::KHRDynamicRenderingFeatures::KHRDynamicRenderingFeatures()
+{
+    dynamic_rendering = false;
+}
+
+Anvil::KHRDynamicRenderingFeatures::KHRDynamicRenderingFeatures(const VkPhysicalDeviceDynamicRenderingFeaturesKHR& in_features)
+{
+    dynamic_rendering = VK_BOOL32_TO_BOOL(in_features.dynamicRendering);
+}
+
+VkPhysicalDeviceDynamicRenderingFeaturesKHR Anvil::KHRDynamicRenderingFeatures::get_vk_physical_device_dynamic_rendering_features() const
+{
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR result;
+
+    result.dynamicRendering = BOOL_TO_VK_BOOL32(dynamic_rendering);
+    result.pNext            = nullptr;
+    result.sType            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+
+    return result;
+}
+
+bool Anvil::KHRDynamicRenderingFeatures::operator==(const Anvil::KHRDynamicRenderingFeatures& in_features) const
+{
+    return (dynamic_rendering == in_features.dynamic_rendering);
+}
+
 Anvil::KHRFloat16Int8Features::KHRFloat16Int8Features()
 {
     shader_float16 = false;
@@ -1572,6 +2077,32 @@ bool Anvil::KHRFloat16Int8Features::operator==(const Anvil::KHRFloat16Int8Featur
             shader_int8     == in_features.shader_int8);
 }
 
+Anvil::KHRImagelessFramebufferFeatures::KHRImagelessFramebufferFeatures()
+{
+    imageless_framebuffer = false;
+}
+
+Anvil::KHRImagelessFramebufferFeatures::KHRImagelessFramebufferFeatures(const VkPhysicalDeviceImagelessFramebufferFeaturesKHR& in_features)
+{
+    imageless_framebuffer = VK_BOOL32_TO_BOOL(in_features.imagelessFramebuffer);
+}
+
+VkPhysicalDeviceImagelessFramebufferFeaturesKHR Anvil::KHRImagelessFramebufferFeatures::get_vk_physical_device_imageless_framebuffer_features() const
+{
+    VkPhysicalDeviceImagelessFramebufferFeaturesKHR result;
+
+    result.imagelessFramebuffer = BOOL_TO_VK_BOOL32(imageless_framebuffer);
+    result.pNext                = nullptr;
+    result.sType                = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGELESS_FRAMEBUFFER_FEATURES_KHR;
+
+    return result;
+}
+
+bool Anvil::KHRImagelessFramebufferFeatures::operator==(const Anvil::KHRImagelessFramebufferFeatures& in_features) const
+{
+    return (imageless_framebuffer == in_features.imageless_framebuffer);
+}
+
 Anvil::KHRMaintenance2PhysicalDevicePointClippingProperties::KHRMaintenance2PhysicalDevicePointClippingProperties()
     :point_clipping_behavior(PointClippingBehavior::UNKNOWN)
 {
@@ -1661,6 +2192,32 @@ bool Anvil::KHRMultiviewProperties::operator==(const KHRMultiviewProperties& in_
             max_multiview_view_count     == in_props.max_multiview_view_count);
 }
 
+Anvil::KHRPipelineExecutablePropertiesFeatures::KHRPipelineExecutablePropertiesFeatures()
+{
+    pipeline_executable_info = false;
+}
+
+Anvil::KHRPipelineExecutablePropertiesFeatures::KHRPipelineExecutablePropertiesFeatures(const VkPhysicalDevicePipelineExecutablePropertiesFeaturesKHR& in_features)
+{
+    pipeline_executable_info = VK_BOOL32_TO_BOOL(in_features.pipelineExecutableInfo);
+}
+
+VkPhysicalDevicePipelineExecutablePropertiesFeaturesKHR Anvil::KHRPipelineExecutablePropertiesFeatures::get_vk_physical_device_pipeline_executable_properties_features() const
+{
+    VkPhysicalDevicePipelineExecutablePropertiesFeaturesKHR result;
+
+    result.pipelineExecutableInfo = BOOL_TO_VK_BOOL32(pipeline_executable_info);
+    result.pNext                  = nullptr;
+    result.sType                  = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PIPELINE_EXECUTABLE_PROPERTIES_FEATURES_KHR;
+
+    return result;
+}
+
+bool Anvil::KHRPipelineExecutablePropertiesFeatures::operator==(const Anvil::KHRPipelineExecutablePropertiesFeatures& in_features) const
+{
+    return (pipeline_executable_info == in_features.pipeline_executable_info);
+}
+
 Anvil::KHRShaderAtomicInt64Features::KHRShaderAtomicInt64Features()
     :shader_buffer_int64_atomics(false),
      shader_shared_int64_atomics(false)
@@ -1815,6 +2372,32 @@ bool Anvil::KHRVariablePointerFeatures::operator==(const Anvil::KHRVariablePoint
             variable_pointers_storage_buffer == in_props.variable_pointers_storage_buffer);
 }
 
+Anvil::KHRTimelineSemaphoreFeatures::KHRTimelineSemaphoreFeatures()
+{
+    timeline_semaphore = false;
+}
+
+Anvil::KHRTimelineSemaphoreFeatures::KHRTimelineSemaphoreFeatures(const VkPhysicalDeviceTimelineSemaphoreFeaturesKHR& in_features)
+{
+    timeline_semaphore = VK_BOOL32_TO_BOOL(in_features.timelineSemaphore);
+}
+
+VkPhysicalDeviceTimelineSemaphoreFeaturesKHR Anvil::KHRTimelineSemaphoreFeatures::get_vk_physical_device_timeline_semaphore_features() const
+{
+    VkPhysicalDeviceTimelineSemaphoreFeaturesKHR result;
+
+    result.pNext             = nullptr;
+    result.sType             = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+    result.timelineSemaphore = BOOL_TO_VK_BOOL32(timeline_semaphore);
+
+    return result;
+}
+
+bool Anvil::KHRTimelineSemaphoreFeatures::operator==(const KHRTimelineSemaphoreFeatures& in_features) const
+{
+    return (in_features.timeline_semaphore == timeline_semaphore);
+}
+
 Anvil::KHRVulkanMemoryModelFeatures::KHRVulkanMemoryModelFeatures()
 {
     vulkan_memory_model                                = false;
@@ -1849,6 +2432,66 @@ bool Anvil::KHRVulkanMemoryModelFeatures::operator==(const KHRVulkanMemoryModelF
            (in_features.vulkan_memory_model_device_scope                   == vulkan_memory_model_device_scope);
 }
 
+Anvil::NVMeshShaderFeatures::NVMeshShaderFeatures()
+{
+    mesh_shader = false;
+    task_shader = false;
+}
+
+Anvil::NVMeshShaderFeatures::NVMeshShaderFeatures(const VkPhysicalDeviceMeshShaderFeaturesNV& in_features)
+{
+    mesh_shader = (in_features.meshShader == VK_TRUE);
+    task_shader = (in_features.taskShader == VK_TRUE);
+}
+
+VkPhysicalDeviceMeshShaderFeaturesNV Anvil::NVMeshShaderFeatures::get_vk_physical_device_mesh_shader_features() const
+{
+    VkPhysicalDeviceMeshShaderFeaturesNV result;
+
+    result.meshShader = (mesh_shader) ? VK_TRUE : VK_FALSE;
+    result.pNext      = nullptr;
+    result.sType      = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_NV;
+    result.taskShader = (task_shader) ? VK_TRUE : VK_FALSE;
+
+    return result;
+}
+
+bool Anvil::NVMeshShaderFeatures::operator==(const NVMeshShaderFeatures& in_features) const
+{
+    return (mesh_shader == in_features.mesh_shader &&
+            task_shader == in_features.task_shader);
+}
+
+Anvil::NVShadingRateImageFeatures::NVShadingRateImageFeatures()
+{
+    shading_rate_coarse_sample_order = false;
+    shading_rate_image               = false;
+}
+
+Anvil::NVShadingRateImageFeatures::NVShadingRateImageFeatures(const VkPhysicalDeviceShadingRateImageFeaturesNV& in_features)
+{
+    shading_rate_coarse_sample_order = (in_features.shadingRateCoarseSampleOrder == VK_TRUE);
+    shading_rate_image               = (in_features.shadingRateImage             == VK_TRUE);
+}
+
+VkPhysicalDeviceShadingRateImageFeaturesNV Anvil::NVShadingRateImageFeatures::get_vk_physical_device_shading_rate_image_features() const
+{
+    VkPhysicalDeviceShadingRateImageFeaturesNV result;
+
+    result.pNext                        = nullptr;
+    result.shadingRateCoarseSampleOrder = (shading_rate_coarse_sample_order) ? VK_TRUE : VK_FALSE;
+    result.shadingRateImage             = (shading_rate_image)               ? VK_TRUE : VK_FALSE;
+    result.sType                        = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADING_RATE_IMAGE_FEATURES_NV;
+
+    return result;
+}
+
+bool Anvil::NVShadingRateImageFeatures::operator==(const NVShadingRateImageFeatures& in_features) const
+{
+    return (shading_rate_coarse_sample_order == in_features.shading_rate_coarse_sample_order &&
+            shading_rate_image               == in_features.shading_rate_image);
+}
+
 Anvil::Layer::Layer(const std::string& in_layer_name)
 {
     implementation_version = 0;
@@ -1911,8 +2554,9 @@ bool Anvil::operator==(const MemoryProperties& in1,
 
 Anvil::MemoryProperties::MemoryProperties()
 {
-    heaps   = nullptr;
-    n_heaps = 0;
+    heaps                      = nullptr;
+    n_heaps                    = 0;
+    resizable_bar_memory_types = 0;
 }
 
 /** Destructor */
@@ -1949,6 +2593,25 @@ void Anvil::MemoryProperties::init(const VkPhysicalDeviceMemoryProperties& in_me
         types.push_back(MemoryType(in_mem_properties.memoryTypes[n_type],
                                    this) );
     }
+
+    /* Without resizable BAR, host-visible device-local memory is confined to a 256 MB window. Anything
+     * larger means the whole VRAM heap can be written to by the CPU. */
+    resizable_bar_memory_types = 0;
+
+    for (uint32_t n_type = 0;
+                  n_type < static_cast<uint32_t>(types.size() );
+                ++n_type)
+    {
+        const auto& current_type = types.at(n_type);
+
+        if ((current_type.flags           & Anvil::MemoryPropertyFlagBits::DEVICE_LOCAL_BIT) != 0 &&
+            (current_type.flags           & Anvil::MemoryPropertyFlagBits::HOST_VISIBLE_BIT) != 0 &&
+            (current_type.heap_ptr->flags & Anvil::MemoryHeapFlagBits::DEVICE_LOCAL_BIT)     != 0 &&
+             current_type.heap_ptr->size  >  256 * 1024 * 1024)
+        {
+            resizable_bar_memory_types |= (1u << n_type);
+        }
+    }
 }
 
 /** Please see header for specification */
@@ -2522,6 +3185,7 @@ Anvil::PhysicalDeviceProperties::PhysicalDeviceProperties()
     ext_pci_bus_info_properties_ptr                                    = nullptr;
     ext_sample_locations_properties_ptr                                = nullptr;
     ext_sampler_filter_minmax_properties_ptr                           = nullptr;
+    ext_subgroup_size_control_properties_ptr                           = nullptr;
     ext_transform_feedback_properties_ptr                              = nullptr;
     ext_vertex_attribute_divisor_properties_ptr                        = nullptr;
     khr_depth_stencil_resolve_properties_ptr                           = nullptr;
@@ -2543,6 +3207,7 @@ Anvil::PhysicalDeviceProperties::PhysicalDeviceProperties(const AMDShaderCorePro
                                                           const EXTPCIBusInfoProperties*                                        in_ext_pci_bus_info_properties_ptr,
                                                           const EXTSampleLocationsProperties*                                   in_ext_sample_locations_properties_ptr,
                                                           const EXTSamplerFilterMinmaxProperties*                               in_ext_sampler_filter_minmax_properties_ptr,
+                                                          const EXTSubgroupSizeControlProperties*                               in_ext_subgroup_size_control_properties_ptr,
                                                           const EXTTransformFeedbackProperties*                                 in_ext_transform_feedback_properties_ptr,
                                                           const EXTVertexAttributeDivisorProperties*                            in_ext_vertex_attribute_divisor_properties_ptr,
                                                           const Anvil::KHRDepthStencilResolveProperties*                        in_khr_depth_stencil_resolve_props_ptr,
@@ -2562,6 +3227,7 @@ Anvil::PhysicalDeviceProperties::PhysicalDeviceProperties(const AMDShaderCorePro
      ext_pci_bus_info_properties_ptr                                   (in_ext_pci_bus_info_properties_ptr),
      ext_sample_locations_properties_ptr                               (in_ext_sample_locations_properties_ptr),
      ext_sampler_filter_minmax_properties_ptr                          (in_ext_sampler_filter_minmax_properties_ptr),
+     ext_subgroup_size_control_properties_ptr                          (in_ext_subgroup_size_control_properties_ptr),
      ext_transform_feedback_properties_ptr                             (in_ext_transform_feedback_properties_ptr),
      ext_vertex_attribute_divisor_properties_ptr                       (in_ext_vertex_attribute_divisor_properties_ptr),
      khr_depth_stencil_resolve_properties_ptr                          (in_khr_depth_stencil_resolve_props_ptr),
@@ -2587,6 +3253,7 @@ bool Anvil::PhysicalDeviceProperties::operator==(const PhysicalDeviceProperties&
     bool       ext_pci_bus_info_properties_match                  = false;
     bool       ext_sample_locations_properties_match              = false;
     bool       ext_sampler_filter_minmax_properties_match         = false;
+    bool       ext_subgroup_size_control_properties_match         = false;
     bool       ext_vertex_attribute_divisor_properties_match      = false;
     bool       khr_depth_stencil_resolve_properties_match         = false;
     bool       khr_driver_properties_properties_match             = false;
@@ -2695,6 +3362,17 @@ bool Anvil::PhysicalDeviceProperties::operator==(const PhysicalDeviceProperties&
                                                       in_props.ext_sampler_filter_minmax_properties_ptr == nullptr);
     }
 
+    if (ext_subgroup_size_control_properties_ptr          != nullptr &&
+        in_props.ext_subgroup_size_control_properties_ptr != nullptr)
+    {
+        ext_subgroup_size_control_properties_match = (*ext_subgroup_size_control_properties_ptr == *in_props.ext_subgroup_size_control_properties_ptr);
+    }
+    else
+    {
+        ext_subgroup_size_control_properties_match = (ext_subgroup_size_control_properties_ptr          == nullptr &&
+                                                      in_props.ext_subgroup_size_control_properties_ptr == nullptr);
+    }
+
     if (ext_vertex_attribute_divisor_properties_ptr          != nullptr &&
         in_props.ext_vertex_attribute_divisor_properties_ptr != nullptr)
     {
@@ -2793,6 +3471,7 @@ bool Anvil::PhysicalDeviceProperties::operator==(const PhysicalDeviceProperties&
            ext_pci_bus_info_properties_match                  &&
            ext_sample_locations_properties_match              &&
            ext_sampler_filter_minmax_properties_match         &&
+           ext_subgroup_size_control_properties_match         &&
            ext_vertex_attribute_divisor_properties_match      &&
            khr_depth_stencil_resolve_properties_match         &&
            khr_driver_properties_properties_match             &&
@@ -2827,55 +3506,94 @@ Anvil::PhysicalDeviceFeatures::PhysicalDeviceFeatures()
 {
     core_vk1_0_features_ptr                   = nullptr;
     core_vk1_1_features_ptr                   = nullptr;
+    ext_conditional_rendering_features_ptr    = nullptr;
     ext_depth_clip_enable_features_ptr        = nullptr;
     ext_descriptor_indexing_features_ptr      = nullptr;
+    ext_host_image_copy_features_ptr          = nullptr;
+    ext_host_query_reset_features_ptr         = nullptr;
     ext_inline_uniform_block_features_ptr     = nullptr;
     ext_scalar_block_layout_features_ptr      = nullptr;
+    ext_subgroup_size_control_features_ptr    = nullptr;
     ext_transform_feedback_features_ptr       = nullptr;
     ext_memory_priority_features_ptr          = nullptr;
+    ext_pageable_device_local_memory_features_ptr = nullptr;
     khr_16bit_storage_features_ptr            = nullptr;
     khr_8bit_storage_features_ptr             = nullptr;
+    khr_acceleration_structure_features_ptr   = nullptr;
+    khr_buffer_device_address_features_ptr    = nullptr;
+    khr_dynamic_rendering_features_ptr        = nullptr;
     khr_float16_int8_features_ptr             = nullptr;
+    khr_imageless_framebuffer_features_ptr    = nullptr;
     khr_multiview_features_ptr                = nullptr;
+    khr_pipeline_executable_properties_features_ptr = nullptr;
     khr_sampler_ycbcr_conversion_features_ptr = nullptr;
     khr_shader_atomic_int64_features_ptr      = nullptr;
+    khr_timeline_semaphore_features_ptr       = nullptr;
     khr_variable_pointer_features_ptr         = nullptr;
     khr_vulkan_memory_model_features_ptr      = nullptr;
+    nv_mesh_shader_features_ptr               = nullptr;
+    nv_shading_rate_image_features_ptr        = nullptr;
 }
 
 Anvil::PhysicalDeviceFeatures::PhysicalDeviceFeatures(const PhysicalDeviceFeaturesCoreVK10*    in_core_vk1_0_features_ptr,
                                                       const PhysicalDeviceFeaturesCoreVK11*    in_core_vk1_1_features_ptr,
+                                                      const EXTConditionalRenderingFeatures*   in_ext_conditional_rendering_features_ptr,
                                                       const EXTDepthClipEnableFeatures*        in_ext_depth_clip_enable_features_ptr,
                                                       const EXTDescriptorIndexingFeatures*     in_ext_descriptor_indexing_features_ptr,
+                                                      const EXTHostImageCopyFeatures*          in_ext_host_image_copy_features_ptr,
+                                                      const EXTHostQueryResetFeatures*         in_ext_host_query_reset_features_ptr,
                                                       const EXTInlineUniformBlockFeatures*     in_ext_inline_uniform_block_features_ptr,
                                                       const EXTScalarBlockLayoutFeatures*      in_ext_scalar_block_layout_features_ptr,
+                                                      const EXTSubgroupSizeControlFeatures*    in_ext_subgroup_size_control_features_ptr,
                                                       const EXTTransformFeedbackFeatures*      in_ext_transform_feedback_features_ptr,
                                                       const EXTMemoryPriorityFeatures*         in_ext_memory_priority_features_ptr,
+                                                      const EXTPageableDeviceLocalMemoryFeatures* in_ext_pageable_device_local_memory_features_ptr,
                                                       const KHR16BitStorageFeatures*           in_khr_16_bit_storage_features_ptr,
                                                       const KHR8BitStorageFeatures*            in_khr_8_bit_storage_features_ptr,
+                                                      const KHRAccelerationStructureFeatures*  in_khr_acceleration_structure_features_ptr,
+                                                      const KHRBufferDeviceAddressFeatures*    in_khr_buffer_device_address_features_ptr,
+                                                      const KHRDynamicRenderingFeatures*       in_khr_dynamic_rendering_features_ptr,
                                                       const KHRFloat16Int8Features*            in_khr_float16_int8_features_ptr,
+                                                      const KHRImagelessFramebufferFeatures*   in_khr_imageless_framebuffer_features_ptr,
                                                       const KHRMultiviewFeatures*              in_khr_multiview_features_ptr,
+                                                      const KHRPipelineExecutablePropertiesFeatures* in_khr_pipeline_executable_properties_features_ptr,
                                                       const KHRSamplerYCbCrConversionFeatures* in_khr_sampler_ycbcr_conversion_features_ptr,
                                                       const KHRShaderAtomicInt64Features*      in_khr_shader_atomic_int64_features_ptr,
+                                                      const KHRTimelineSemaphoreFeatures*      in_khr_timeline_semaphore_features_ptr,
                                                       const KHRVariablePointerFeatures*        in_khr_variable_pointer_features_ptr,
-                                                      const KHRVulkanMemoryModelFeatures*      in_khr_vulkan_memory_model_features_ptr)
+                                                      const KHRVulkanMemoryModelFeatures*      in_khr_vulkan_memory_model_features_ptr,
+                                                      const NVMeshShaderFeatures*              in_nv_mesh_shader_features_ptr,
+                                                      const NVShadingRateImageFeatures*        in_nv_shading_rate_image_features_ptr)
 {
     core_vk1_0_features_ptr                   = in_core_vk1_0_features_ptr;
     core_vk1_1_features_ptr                   = in_core_vk1_1_features_ptr;
+    ext_conditional_rendering_features_ptr    = in_ext_conditional_rendering_features_ptr;
     ext_depth_clip_enable_features_ptr        = in_ext_depth_clip_enable_features_ptr;
     ext_descriptor_indexing_features_ptr      = in_ext_descriptor_indexing_features_ptr;
+    ext_host_image_copy_features_ptr          = in_ext_host_image_copy_features_ptr;
+    ext_host_query_reset_features_ptr         = in_ext_host_query_reset_features_ptr;
     ext_inline_uniform_block_features_ptr     = in_ext_inline_uniform_block_features_ptr;
     ext_scalar_block_layout_features_ptr      = in_ext_scalar_block_layout_features_ptr;
+    ext_subgroup_size_control_features_ptr    = in_ext_subgroup_size_control_features_ptr;
     ext_transform_feedback_features_ptr       = in_ext_transform_feedback_features_ptr;
     ext_memory_priority_features_ptr          = in_ext_memory_priority_features_ptr;
+    ext_pageable_device_local_memory_features_ptr = in_ext_pageable_device_local_memory_features_ptr;
     khr_16bit_storage_features_ptr            = in_khr_16_bit_storage_features_ptr;
     khr_8bit_storage_features_ptr             = in_khr_8_bit_storage_features_ptr;
+    khr_acceleration_structure_features_ptr   = in_khr_acceleration_structure_features_ptr;
+    khr_buffer_device_address_features_ptr    = in_khr_buffer_device_address_features_ptr;
+    khr_dynamic_rendering_features_ptr        = in_khr_dynamic_rendering_features_ptr;
     khr_float16_int8_features_ptr             = in_khr_float16_int8_features_ptr;
+    khr_imageless_framebuffer_features_ptr    = in_khr_imageless_framebuffer_features_ptr;
     khr_multiview_features_ptr                = in_khr_multiview_features_ptr;
+    khr_pipeline_executable_properties_features_ptr = in_khr_pipeline_executable_properties_features_ptr;
     khr_sampler_ycbcr_conversion_features_ptr = in_khr_sampler_ycbcr_conversion_features_ptr;
     khr_shader_atomic_int64_features_ptr      = in_khr_shader_atomic_int64_features_ptr;
+    khr_timeline_semaphore_features_ptr       = in_khr_timeline_semaphore_features_ptr;
     khr_variable_pointer_features_ptr         = in_khr_variable_pointer_features_ptr;
     khr_vulkan_memory_model_features_ptr      = in_khr_vulkan_memory_model_features_ptr;
+    nv_mesh_shader_features_ptr               = in_nv_mesh_shader_features_ptr;
+    nv_shading_rate_image_features_ptr        = in_nv_shading_rate_image_features_ptr;
 }
 
 bool Anvil::PhysicalDeviceFeatures::operator==(const PhysicalDeviceFeatures& in_physical_device_features) const
@@ -2883,20 +3601,44 @@ bool Anvil::PhysicalDeviceFeatures::operator==(const PhysicalDeviceFeatures& in_
     const bool core_vk1_0_features_match                   = (*core_vk1_0_features_ptr == *in_physical_device_features.core_vk1_0_features_ptr);
     const bool core_vk1_1_features_match                   = ( core_vk1_1_features_ptr == nullptr                                              && in_physical_device_features.core_vk1_1_features_ptr == nullptr) ||
                                                              (*core_vk1_1_features_ptr == *in_physical_device_features.core_vk1_1_features_ptr);
+    bool       ext_conditional_rendering_features_match    = false;
     bool       ext_depth_clip_enable_features_match        = false;
     bool       ext_descriptor_indexing_features_match      = false;
+    bool       ext_host_image_copy_features_match          = false;
+    bool       ext_host_query_reset_features_match         = false;
     bool       ext_inline_uniform_block_features_match     = false;
     bool       ext_scalar_block_layout_features_match      = false;
+    bool       ext_subgroup_size_control_features_match    = false;
     bool       ext_transform_feedback_features_match       = false;
     bool       ext_memory_priority_features_match          = false;
+    bool       ext_pageable_device_local_memory_features_match = false;
     bool       khr_16bit_storage_features_match            = false;
     bool       khr_8bit_storage_features_match             = false;
+    bool       khr_acceleration_structure_features_match   = false;
+    bool       khr_buffer_device_address_features_match    = false;
+    bool       khr_dynamic_rendering_features_match        = false;
     bool       khr_float16_int8_features_match             = false;
+    bool       khr_imageless_framebuffer_features_match    = false;
     bool       khr_multiview_features_match                = false;
+    bool       khr_pipeline_executable_properties_features_match = false;
     bool       khr_sampler_ycbcr_conversion_features_match = false;
     bool       khr_shader_atomic_int64_features_match      = false;
+    bool       khr_timeline_semaphore_features_match       = false;
     bool       khr_variable_pointer_features_match         = false;
     bool       khr_vulkan_memory_features_match            = false;
+    bool       nv_mesh_shader_features_match               = false;
+    bool       nv_shading_rate_image_features_match        = false;
+
+    if (ext_conditional_rendering_features_ptr                             != nullptr &&
+        in_physical_device_features.ext_conditional_rendering_features_ptr != nullptr)
+    {
+        ext_conditional_rendering_features_match = (*ext_conditional_rendering_features_ptr == *in_physical_device_features.ext_conditional_rendering_features_ptr);
+    }
+    else
+    {
+        ext_conditional_rendering_features_match = (ext_conditional_rendering_features_ptr                             == nullptr &&
+                                                    in_physical_device_features.ext_conditional_rendering_features_ptr == nullptr);
+    }
 
     if (ext_depth_clip_enable_features_ptr                             != nullptr &&
         in_physical_device_features.ext_depth_clip_enable_features_ptr != nullptr)
@@ -2920,6 +3662,28 @@ bool Anvil::PhysicalDeviceFeatures::operator==(const PhysicalDeviceFeatures& in_
                                                   in_physical_device_features.ext_descriptor_indexing_features_ptr == nullptr);
     }
 
+    if (ext_host_image_copy_features_ptr                             != nullptr &&
+        in_physical_device_features.ext_host_image_copy_features_ptr != nullptr)
+    {
+        ext_host_image_copy_features_match = (*ext_host_image_copy_features_ptr == *in_physical_device_features.ext_host_image_copy_features_ptr);
+    }
+    else
+    {
+        ext_host_image_copy_features_match = (ext_host_image_copy_features_ptr                             == nullptr &&
+                                              in_physical_device_features.ext_host_image_copy_features_ptr == nullptr);
+    }
+
+    if (ext_host_query_reset_features_ptr                             != nullptr &&
+        in_physical_device_features.ext_host_query_reset_features_ptr != nullptr)
+    {
+        ext_host_query_reset_features_match = (*ext_host_query_reset_features_ptr == *in_physical_device_features.ext_host_query_reset_features_ptr);
+    }
+    else
+    {
+        ext_host_query_reset_features_match = (ext_host_query_reset_features_ptr                             == nullptr &&
+                                               in_physical_device_features.ext_host_query_reset_features_ptr == nullptr);
+    }
+
     if (ext_inline_uniform_block_features_ptr                             != nullptr &&
         in_physical_device_features.ext_inline_uniform_block_features_ptr != nullptr)
     {
@@ -2942,6 +3706,17 @@ bool Anvil::PhysicalDeviceFeatures::operator==(const PhysicalDeviceFeatures& in_
                                                   in_physical_device_features.ext_scalar_block_layout_features_ptr == nullptr);
     }
 
+    if (ext_subgroup_size_control_features_ptr                             != nullptr &&
+        in_physical_device_features.ext_subgroup_size_control_features_ptr != nullptr)
+    {
+        ext_subgroup_size_control_features_match = (*ext_subgroup_size_control_features_ptr == *in_physical_device_features.ext_subgroup_size_control_features_ptr);
+    }
+    else
+    {
+        ext_subgroup_size_control_features_match = (ext_subgroup_size_control_features_ptr                             == nullptr &&
+                                                    in_physical_device_features.ext_subgroup_size_control_features_ptr == nullptr);
+    }
+
     if (ext_transform_feedback_features_ptr                             != nullptr &&
         in_physical_device_features.ext_transform_feedback_features_ptr != nullptr)
     {
@@ -2959,6 +3734,17 @@ bool Anvil::PhysicalDeviceFeatures::operator==(const PhysicalDeviceFeatures& in_
         ext_memory_priority_features_match = (*ext_memory_priority_features_ptr == *in_physical_device_features.ext_memory_priority_features_ptr);
     }
 
+    if (ext_pageable_device_local_memory_features_ptr                             != nullptr &&
+        in_physical_device_features.ext_pageable_device_local_memory_features_ptr != nullptr)
+    {
+        ext_pageable_device_local_memory_features_match = (*ext_pageable_device_local_memory_features_ptr == *in_physical_device_features.ext_pageable_device_local_memory_features_ptr);
+    }
+    else
+    {
+        ext_pageable_device_local_memory_features_match = (ext_pageable_device_local_memory_features_ptr                             == nullptr &&
+                                                           in_physical_device_features.ext_pageable_device_local_memory_features_ptr == nullptr);
+    }
+
     if (khr_16bit_storage_features_ptr                             != nullptr &&
         in_physical_device_features.khr_16bit_storage_features_ptr != nullptr)
     {
@@ -2981,6 +3767,39 @@ bool Anvil::PhysicalDeviceFeatures::operator==(const PhysicalDeviceFeatures& in_
                                            in_physical_device_features.khr_8bit_storage_features_ptr == nullptr);
     }
 
+    if (khr_acceleration_structure_features_ptr                             != nullptr &&
+        in_physical_device_features.khr_acceleration_structure_features_ptr != nullptr)
+    {
+        khr_acceleration_structure_features_match = (*khr_acceleration_structure_features_ptr == *in_physical_device_features.khr_acceleration_structure_features_ptr);
+    }
+    else
+    {
+        khr_acceleration_structure_features_match = (khr_acceleration_structure_features_ptr                             == nullptr &&
+                                                     in_physical_device_features.khr_acceleration_structure_features_ptr == nullptr);
+    }
+
+    if (khr_buffer_device_address_features_ptr                             != nullptr &&
+        in_physical_device_features.khr_buffer_device_address_features_ptr != nullptr)
+    {
+        khr_buffer_device_address_features_match = (*khr_buffer_device_address_features_ptr == *in_physical_device_features.khr_buffer_device_address_features_ptr);
+    }
+    else
+    {
+        khr_buffer_device_address_features_match = (khr_buffer_device_address_features_ptr                             == nullptr &&
+                                                    in_physical_device_features.khr_buffer_device_address_features_ptr == nullptr);
+    }
+
+    if (khr_dynamic_rendering_features_ptr                             != nullptr &&
+        in_physical_device_features.khr_dynamic_rendering_features_ptr != nullptr)
+    {
+        khr_dynamic_rendering_features_match = (*khr_dynamic_rendering_features_ptr == *in_physical_device_features.khr_dynamic_rendering_features_ptr);
+    }
+    else
+    {
+        khr_dynamic_rendering_features_match = (khr_dynamic_rendering_features_ptr                             == nullptr &&
+                                                in_physical_device_features.khr_dynamic_rendering_features_ptr == nullptr);
+    }
+
     if (khr_float16_int8_features_ptr                             != nullptr &&
         in_physical_device_features.khr_float16_int8_features_ptr != nullptr)
     {
@@ -2992,6 +3811,17 @@ bool Anvil::PhysicalDeviceFeatures::operator==(const PhysicalDeviceFeatures& in_
                                            in_physical_device_features.khr_float16_int8_features_ptr == nullptr);
     }
 
+    if (khr_imageless_framebuffer_features_ptr                             != nullptr &&
+        in_physical_device_features.khr_imageless_framebuffer_features_ptr != nullptr)
+    {
+        khr_imageless_framebuffer_features_match = (*khr_imageless_framebuffer_features_ptr == *in_physical_device_features.khr_imageless_framebuffer_features_ptr);
+    }
+    else
+    {
+        khr_imageless_framebuffer_features_match = (khr_imageless_framebuffer_features_ptr                             == nullptr &&
+                                                    in_physical_device_features.khr_imageless_framebuffer_features_ptr == nullptr);
+    }
+
     if (khr_multiview_features_ptr                             != nullptr &&
         in_physical_device_features.khr_multiview_features_ptr != nullptr)
     {
@@ -3003,6 +3833,17 @@ bool Anvil::PhysicalDeviceFeatures::operator==(const PhysicalDeviceFeatures& in_
                                         in_physical_device_features.khr_multiview_features_ptr == nullptr);
     }
 
+    if (khr_pipeline_executable_properties_features_ptr                             != nullptr &&
+        in_physical_device_features.khr_pipeline_executable_properties_features_ptr != nullptr)
+    {
+        khr_pipeline_executable_properties_features_match = (*khr_pipeline_executable_properties_features_ptr == *in_physical_device_features.khr_pipeline_executable_properties_features_ptr);
+    }
+    else
+    {
+        khr_pipeline_executable_properties_features_match = (khr_pipeline_executable_properties_features_ptr                             == nullptr &&
+                                                             in_physical_device_features.khr_pipeline_executable_properties_features_ptr == nullptr);
+    }
+
     if (khr_sampler_ycbcr_conversion_features_ptr                             != nullptr &&
         in_physical_device_features.khr_sampler_ycbcr_conversion_features_ptr != nullptr)
     {
@@ -3025,6 +3866,17 @@ bool Anvil::PhysicalDeviceFeatures::operator==(const PhysicalDeviceFeatures& in_
                                                   in_physical_device_features.khr_shader_atomic_int64_features_ptr == nullptr);
     }
 
+    if (khr_timeline_semaphore_features_ptr                             != nullptr &&
+        in_physical_device_features.khr_timeline_semaphore_features_ptr != nullptr)
+    {
+        khr_timeline_semaphore_features_match = (*khr_timeline_semaphore_features_ptr == *in_physical_device_features.khr_timeline_semaphore_features_ptr);
+    }
+    else
+    {
+        khr_timeline_semaphore_features_match = (khr_timeline_semaphore_features_ptr                             == nullptr &&
+                                                 in_physical_device_features.khr_timeline_semaphore_features_ptr == nullptr);
+    }
+
     if (khr_variable_pointer_features_ptr                             != nullptr &&
         in_physical_device_features.khr_variable_pointer_features_ptr != nullptr)
     {
@@ -3047,22 +3899,57 @@ bool Anvil::PhysicalDeviceFeatures::operator==(const PhysicalDeviceFeatures& in_
                                             in_physical_device_features.khr_vulkan_memory_model_features_ptr == nullptr);
     }
 
+    if (nv_mesh_shader_features_ptr                             != nullptr &&
+        in_physical_device_features.nv_mesh_shader_features_ptr != nullptr)
+    {
+        nv_mesh_shader_features_match = (*nv_mesh_shader_features_ptr == *in_physical_device_features.nv_mesh_shader_features_ptr);
+    }
+    else
+    {
+        nv_mesh_shader_features_match = (nv_mesh_shader_features_ptr                             == nullptr &&
+                                         in_physical_device_features.nv_mesh_shader_features_ptr == nullptr);
+    }
+
+    if (nv_shading_rate_image_features_ptr                             != nullptr &&
+        in_physical_device_features.nv_shading_rate_image_features_ptr != nullptr)
+    {
+        nv_shading_rate_image_features_match = (*nv_shading_rate_image_features_ptr == *in_physical_device_features.nv_shading_rate_image_features_ptr);
+    }
+    else
+    {
+        nv_shading_rate_image_features_match = (nv_shading_rate_image_features_ptr                             == nullptr &&
+                                                in_physical_device_features.nv_shading_rate_image_features_ptr == nullptr);
+    }
+
     return core_vk1_0_features_match                   &&
            core_vk1_1_features_match                   &&
+           ext_conditional_rendering_features_match    &&
            ext_depth_clip_enable_features_match        &&
            ext_descriptor_indexing_features_match      &&
+           ext_host_image_copy_features_match          &&
+           ext_host_query_reset_features_match         &&
            ext_inline_uniform_block_features_match     &&
            ext_scalar_block_layout_features_match      &&
+           ext_subgroup_size_control_features_match    &&
            ext_transform_feedback_features_match       &&
            ext_memory_priority_features_match          &&
+           ext_pageable_device_local_memory_features_match &&
            khr_16bit_storage_features_match            &&
            khr_8bit_storage_features_match             &&
+           khr_acceleration_structure_features_match   &&
+           khr_buffer_device_address_features_match    &&
+           khr_dynamic_rendering_features_match        &&
            khr_float16_int8_features_match             &&
+           khr_imageless_framebuffer_features_match    &&
            khr_multiview_features_match                &&
+           khr_pipeline_executable_properties_features_match &&
            khr_sampler_ycbcr_conversion_features_match &&
            khr_shader_atomic_int64_features_match      &&
+           khr_timeline_semaphore_features_match       &&
            khr_variable_pointer_features_match         &&
-           khr_vulkan_memory_features_match;
+           khr_vulkan_memory_features_match            &&
+           nv_mesh_shader_features_match               &&
+           nv_shading_rate_image_features_match;
 }
 
 Anvil::PhysicalDeviceGroup::PhysicalDeviceGroup()
@@ -3696,6 +4583,72 @@ bool Anvil::PushConstantRange::operator==(const PushConstantRange& in) const
             stages == in.stages);
 }
 
+Anvil::PushDescriptorWrite::PushDescriptorWrite(BindingIndex          in_binding,
+                                                uint32_t              in_n_array_element,
+                                                Anvil::DescriptorType in_descriptor_type,
+                                                Anvil::Buffer*        in_buffer_ptr,
+                                                VkDeviceSize          in_start_offset,
+                                                VkDeviceSize          in_size)
+    :binding            (in_binding),
+     descriptor_type    (in_descriptor_type),
+     n_array_element    (in_n_array_element),
+     buffer_ptr         (in_buffer_ptr),
+     buffer_size        (in_size),
+     buffer_start_offset(in_start_offset),
+     buffer_view_ptr    (nullptr),
+     image_layout       (Anvil::ImageLayout::UNKNOWN),
+     image_view_ptr     (nullptr),
+     sampler_ptr        (nullptr)
+{
+    anvil_assert(in_buffer_ptr      != nullptr);
+    anvil_assert(in_descriptor_type == Anvil::DescriptorType::STORAGE_BUFFER ||
+                 in_descriptor_type == Anvil::DescriptorType::UNIFORM_BUFFER);
+}
+
+Anvil::PushDescriptorWrite::PushDescriptorWrite(BindingIndex          in_binding,
+                                                uint32_t              in_n_array_element,
+                                                Anvil::DescriptorType in_descriptor_type,
+                                                Anvil::BufferView*    in_buffer_view_ptr)
+    :binding            (in_binding),
+     descriptor_type    (in_descriptor_type),
+     n_array_element    (in_n_array_element),
+     buffer_ptr         (nullptr),
+     buffer_size        (0),
+     buffer_start_offset(0),
+     buffer_view_ptr    (in_buffer_view_ptr),
+     image_layout       (Anvil::ImageLayout::UNKNOWN),
+     image_view_ptr     (nullptr),
+     sampler_ptr        (nullptr)
+{
+    anvil_assert(in_buffer_view_ptr != nullptr);
+    anvil_assert(in_descriptor_type == Anvil::DescriptorType::STORAGE_TEXEL_BUFFER ||
+                 in_descriptor_type == Anvil::DescriptorType::UNIFORM_TEXEL_BUFFER);
+}
+
+Anvil::PushDescriptorWrite::PushDescriptorWrite(BindingIndex          in_binding,
+                                                uint32_t              in_n_array_element,
+                                                Anvil::DescriptorType in_descriptor_type,
+                                                Anvil::ImageLayout    in_image_layout,
+                                                Anvil::ImageView*     in_image_view_ptr,
+                                                Anvil::Sampler*       in_sampler_ptr)
+    :binding            (in_binding),
+     descriptor_type    (in_descriptor_type),
+     n_array_element    (in_n_array_element),
+     buffer_ptr         (nullptr),
+     buffer_size        (0),
+     buffer_start_offset(0),
+     buffer_view_ptr    (nullptr),
+     image_layout       (in_image_layout),
+     image_view_ptr     (in_image_view_ptr),
+     sampler_ptr        (in_sampler_ptr)
+{
+    anvil_assert(in_descriptor_type == Anvil::DescriptorType::COMBINED_IMAGE_SAMPLER ||
+                 in_descriptor_type == Anvil::DescriptorType::INPUT_ATTACHMENT       ||
+                 in_descriptor_type == Anvil::DescriptorType::SAMPLED_IMAGE          ||
+                 in_descriptor_type == Anvil::DescriptorType::SAMPLER                ||
+                 in_descriptor_type == Anvil::DescriptorType::STORAGE_IMAGE);
+}
+
 Anvil::QueueFamilyInfo::QueueFamilyInfo(const VkQueueFamilyProperties& in_props)
 {
     flags                          = static_cast<Anvil::QueueFlagBits>(in_props.queueFlags);
@@ -3716,6 +4669,161 @@ bool Anvil::operator==(const Anvil::QueueFamilyInfo& in1,
             in1.n_timestamp_bits                      == in2.n_timestamp_bits);
 }
 
+/** Please see header for specification */
+Anvil::RawBufferBarrier::RawBufferBarrier(Anvil::AccessFlags in_source_access_mask,
+                                          Anvil::AccessFlags in_destination_access_mask,
+                                          uint32_t           in_src_queue_family_index,
+                                          uint32_t           in_dst_queue_family_index,
+                                          Anvil::Buffer*     in_buffer_ptr,
+                                          VkDeviceSize       in_offset,
+                                          VkDeviceSize       in_size)
+{
+    anvil_assert(in_buffer_ptr != nullptr);
+
+    buffer                 = in_buffer_ptr->get_buffer();
+    dst_access_mask        = in_destination_access_mask;
+    dst_queue_family_index = in_dst_queue_family_index;
+    next_ptr               = nullptr;
+    offset                 = in_offset;
+    s_type                 = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    size                   = in_size;
+    src_access_mask        = in_source_access_mask;
+    src_queue_family_index = in_src_queue_family_index;
+
+    /* NOTE: See BufferBarrier constructor */
+    auto memory_block_ptr = in_buffer_ptr->get_memory_block(0 /* in_n_memory_block */);
+
+    ANVIL_REDUNDANT_VARIABLE(memory_block_ptr);
+}
+
+/** Please see header for specification */
+Anvil::RawBufferBarrier::RawBufferBarrier(const Anvil::BufferBarrier& in_barrier)
+{
+    *reinterpret_cast<VkBufferMemoryBarrier*>(this) = in_barrier.get_barrier_vk();
+}
+
+/** Please see header for specification */
+Anvil::RawImageBarrier::RawImageBarrier(Anvil::AccessFlags           in_source_access_mask,
+                                        Anvil::AccessFlags           in_destination_access_mask,
+                                        Anvil::ImageLayout           in_old_layout,
+                                        Anvil::ImageLayout           in_new_layout,
+                                        uint32_t                     in_src_queue_family_index,
+                                        uint32_t                     in_dst_queue_family_index,
+                                        Anvil::Image*                in_image_ptr,
+                                        Anvil::ImageSubresourceRange in_image_subresource_range)
+{
+    anvil_assert(in_image_ptr != nullptr);
+
+    dst_access_mask        = in_destination_access_mask;
+    dst_queue_family_index = in_dst_queue_family_index;
+    image                  = in_image_ptr->get_image();
+    new_layout             = in_new_layout;
+    next_ptr               = nullptr;
+    old_layout             = in_old_layout;
+    s_type                 = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    src_access_mask        = in_source_access_mask;
+    src_queue_family_index = in_src_queue_family_index;
+    subresource_range      = in_image_subresource_range;
+
+    /* NOTE: Barriers referring to DS images must always specify both aspects. */
+    {
+        const auto image_format = in_image_ptr->get_create_info_ptr()->get_format();
+
+        if (Anvil::Formats::has_depth_aspect  (image_format) &&
+            Anvil::Formats::has_stencil_aspect(image_format) )
+        {
+            subresource_range.aspect_mask = (Anvil::ImageAspectFlagBits::DEPTH_BIT | Anvil::ImageAspectFlagBits::STENCIL_BIT);
+        }
+    }
+
+    /* NOTE: See ImageBarrier constructor */
+    auto memory_block_ptr = in_image_ptr->get_memory_block();
+
+    ANVIL_REDUNDANT_VARIABLE(memory_block_ptr);
+}
+
+/** Please see header for specification */
+Anvil::RawImageBarrier::RawImageBarrier(const Anvil::ImageBarrier& in_barrier)
+{
+    *reinterpret_cast<VkImageMemoryBarrier*>(this) = in_barrier.image_barrier_vk;
+}
+
+/** Please see header for specification */
+Anvil::RawMemoryBarrier::RawMemoryBarrier(Anvil::AccessFlags in_source_access_mask,
+                                          Anvil::AccessFlags in_destination_access_mask)
+{
+    dst_access_mask = in_destination_access_mask;
+    next_ptr        = nullptr;
+    s_type          = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    src_access_mask = in_source_access_mask;
+}
+
+/** Please see header for specification */
+Anvil::RawMemoryBarrier::RawMemoryBarrier(const Anvil::MemoryBarrier& in_barrier)
+{
+    *reinterpret_cast<VkMemoryBarrier*>(this) = in_barrier.memory_barrier_vk;
+}
+
+/** Please see header for specification */
+Anvil::RenderingAttachmentInfo::RenderingAttachmentInfo()
+{
+    memset(&clear_value,
+           0,
+           sizeof(clear_value) );
+
+    image_layout           = Anvil::ImageLayout::UNDEFINED;
+    image_view_ptr         = nullptr;
+    load_op                = Anvil::AttachmentLoadOp::DONT_CARE;
+    resolve_image_layout   = Anvil::ImageLayout::UNDEFINED;
+    resolve_image_view_ptr = nullptr;
+    resolve_mode           = Anvil::ResolveModeFlagBits::NONE;
+    store_op               = Anvil::AttachmentStoreOp::DONT_CARE;
+}
+
+/** Please see header for specification */
+Anvil::RenderingAttachmentInfo::RenderingAttachmentInfo(Anvil::ImageView*          in_image_view_ptr,
+                                                        Anvil::ImageLayout         in_image_layout,
+                                                        Anvil::AttachmentLoadOp    in_load_op,
+                                                        Anvil::AttachmentStoreOp   in_store_op,
+                                                        const VkClearValue&        in_clear_value,
+                                                        Anvil::ResolveModeFlagBits in_opt_resolve_mode,
+                                                        Anvil::ImageView*          in_opt_resolve_image_view_ptr,
+                                                        Anvil::ImageLayout         in_opt_resolve_image_layout)
+{
+    anvil_assert(in_opt_resolve_mode           == Anvil::ResolveModeFlagBits::NONE ||
+                 in_opt_resolve_image_view_ptr != nullptr);
+
+    clear_value            = in_clear_value;
+    image_layout           = in_image_layout;
+    image_view_ptr         = in_image_view_ptr;
+    load_op                = in_load_op;
+    resolve_image_layout   = in_opt_resolve_image_layout;
+    resolve_image_view_ptr = in_opt_resolve_image_view_ptr;
+    resolve_mode           = in_opt_resolve_mode;
+    store_op               = in_store_op;
+}
+
+/** Please see header for specification */
+VkRenderingAttachmentInfoKHR Anvil::RenderingAttachmentInfo::get_vk() const
+{
+    VkRenderingAttachmentInfoKHR result;
+
+    result.clearValue         = clear_value;
+    result.imageLayout        = static_cast<VkImageLayout>(image_layout);
+    result.imageView          = (image_view_ptr != nullptr) ? image_view_ptr->get_image_view()
+                                                            : VK_NULL_HANDLE;
+    result.loadOp             = static_cast<VkAttachmentLoadOp>(load_op);
+    result.pNext              = nullptr;
+    result.resolveImageLayout = static_cast<VkImageLayout>(resolve_image_layout);
+    result.resolveImageView   = (resolve_image_view_ptr != nullptr) ? resolve_image_view_ptr->get_image_view()
+                                                                    : VK_NULL_HANDLE;
+    result.resolveMode        = static_cast<VkResolveModeFlagBitsKHR>(resolve_mode);
+    result.storeOp            = static_cast<VkAttachmentStoreOp>(store_op);
+    result.sType              = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+
+    return result;
+}
+
 /** Please see header for specification */
 Anvil::SemaphoreProperties::SemaphoreProperties()
 {
@@ -4117,6 +5225,8 @@ Anvil::SubmitInfo::SubmitInfo(uint32_t                         in_n_command_buff
      signal_semaphores_mgpu_ptr                    (nullptr),
      signal_semaphores_sgpu_ptr                    (in_opt_semaphore_to_signal_ptrs_ptr),
      should_block                                  (in_should_block),
+     timeline_signal_semaphore_values_ptr          (nullptr),
+     timeline_wait_semaphore_values_ptr            (nullptr),
      timeout                                       (UINT64_MAX),
      type                                          (SubmissionType::SGPU),
      wait_semaphores_mgpu_ptr                      (nullptr),
@@ -4182,6 +5292,8 @@ Anvil::SubmitInfo::SubmitInfo(uint32_t                           in_n_command_bu
      signal_semaphores_mgpu_ptr                    (in_opt_signal_semaphore_submissions_ptr),
      signal_semaphores_sgpu_ptr                    (nullptr),
      should_block                                  (in_should_block),
+     timeline_signal_semaphore_values_ptr          (nullptr),
+     timeline_wait_semaphore_values_ptr            (nullptr),
      timeout                                       (UINT64_MAX),
      type                                          (SubmissionType::MGPU),
      wait_semaphores_mgpu_ptr                      (in_opt_wait_semaphore_submissions_ptr),
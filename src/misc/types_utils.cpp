@@ -22,6 +22,7 @@
 #include "misc/types.h"
 #include "wrappers/buffer.h"
 #include "wrappers/device.h"
+#include <cstring>
 
 /** Please see header for specification */
 void Anvil::Utils::get_version_chunks_for_api_version(const Anvil::APIVersion& in_api_version,
@@ -277,6 +278,13 @@ Anvil::AccessFlags Anvil::Utils::get_access_mask_from_image_layout(Anvil::ImageL
             break;
         }
 
+        case Anvil::ImageLayout::SHADING_RATE_OPTIMAL_NV:
+        {
+            result = Anvil::AccessFlagBits::SHADING_RATE_IMAGE_READ_BIT_NV;
+
+            break;
+        }
+
         default:
         {
             /* Invalid Anvil::ImageLayout argument value */
@@ -322,6 +330,7 @@ Anvil::AccessFlags Anvil::Utils::get_access_mask_from_image_layout(Anvil::ImageL
                        Anvil::AccessFlagBits::MEMORY_WRITE_BIT                   |
                        Anvil::AccessFlagBits::SHADER_READ_BIT                    |
                        Anvil::AccessFlagBits::SHADER_WRITE_BIT                   |
+                       Anvil::AccessFlagBits::SHADING_RATE_IMAGE_READ_BIT_NV     |
                        Anvil::AccessFlagBits::TRANSFER_READ_BIT                  |
                        Anvil::AccessFlagBits::TRANSFER_WRITE_BIT                 |
                        Anvil::AccessFlagBits::UNIFORM_READ_BIT                   |
@@ -654,6 +663,7 @@ const char* Anvil::Utils::get_raw_string(VkImageLayout in_image_layout)
         case VK_IMAGE_LAYOUT_PREINITIALIZED:                                 result = "VK_IMAGE_LAYOUT_PREINITIALIZED";                                 break;
         case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:                                result = "VK_IMAGE_LAYOUT_PRESENT_SRC_KHR";                                break;
         case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:                       result = "VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL";                       break;
+        case VK_IMAGE_LAYOUT_SHADING_RATE_OPTIMAL_NV:                        result = "VK_IMAGE_LAYOUT_SHADING_RATE_OPTIMAL_NV";                        break;
         case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:                           result = "VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL";                           break;
         case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:                           result = "VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL";                           break;
         case VK_IMAGE_LAYOUT_UNDEFINED:                                      result = "VK_IMAGE_LAYOUT_UNDEFINED";                                      break;
@@ -838,6 +848,8 @@ const char* Anvil::Utils::get_raw_string(Anvil::ShaderStage in_shader_stage)
         case ShaderStage::COMPUTE:                 result = "SHADER_STAGE_COMPUTE";                 break;
         case ShaderStage::FRAGMENT:                result = "SHADER_STAGE_FRAGMENT";                break;
         case ShaderStage::GEOMETRY:                result = "SHADER_STAGE_GEOMETRY";                break;
+        case ShaderStage::MESH:                    result = "SHADER_STAGE_MESH";                    break;
+        case ShaderStage::TASK:                    result = "SHADER_STAGE_TASK";                    break;
         case ShaderStage::TESSELLATION_CONTROL:    result = "SHADER_STAGE_TESSELLATION_CONTROL";    break;
         case ShaderStage::TESSELLATION_EVALUATION: result = "SHADER_STAGE_TESSELLATION_EVALUATION"; break;
         case ShaderStage::VERTEX:                  result = "SHADER_STAGE_VERTEX";                  break;
@@ -862,6 +874,8 @@ const char* Anvil::Utils::get_raw_string(VkShaderStageFlagBits in_shader_stage)
         case VK_SHADER_STAGE_COMPUTE_BIT:                 result = "VK_SHADER_STAGE_COMPUTE_BIT";                 break;
         case VK_SHADER_STAGE_FRAGMENT_BIT:                result = "VK_SHADER_STAGE_FRAGMENT_BIT";                break;
         case VK_SHADER_STAGE_GEOMETRY_BIT:                result = "VK_SHADER_STAGE_GEOMETRY_BIT";                break;
+        case VK_SHADER_STAGE_MESH_BIT_NV:                 result = "VK_SHADER_STAGE_MESH_BIT_NV";                 break;
+        case VK_SHADER_STAGE_TASK_BIT_NV:                 result = "VK_SHADER_STAGE_TASK_BIT_NV";                 break;
         case VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT:    result = "VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT";    break;
         case VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT: result = "VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT"; break;
         case VK_SHADER_STAGE_VERTEX_BIT:                  result = "VK_SHADER_STAGE_VERTEX_BIT";                  break;
@@ -926,6 +940,8 @@ Anvil::ShaderStageFlagBits Anvil::Utils::get_shader_stage_flag_bits_from_shader_
         case Anvil::ShaderStage::COMPUTE:                 result = Anvil::ShaderStageFlagBits::COMPUTE_BIT;                 break;
         case Anvil::ShaderStage::FRAGMENT:                result = Anvil::ShaderStageFlagBits::FRAGMENT_BIT;                break;
         case Anvil::ShaderStage::GEOMETRY:                result = Anvil::ShaderStageFlagBits::GEOMETRY_BIT;                break;
+        case Anvil::ShaderStage::MESH:                    result = Anvil::ShaderStageFlagBits::MESH_BIT_NV;                 break;
+        case Anvil::ShaderStage::TASK:                    result = Anvil::ShaderStageFlagBits::TASK_BIT_NV;                 break;
         case Anvil::ShaderStage::TESSELLATION_CONTROL:    result = Anvil::ShaderStageFlagBits::TESSELLATION_CONTROL_BIT;    break;
         case Anvil::ShaderStage::TESSELLATION_EVALUATION: result = Anvil::ShaderStageFlagBits::TESSELLATION_EVALUATION_BIT; break;
         case Anvil::ShaderStage::VERTEX:                  result = Anvil::ShaderStageFlagBits::VERTEX_BIT;                  break;
@@ -946,6 +962,7 @@ VkDebugReportObjectTypeEXT Anvil::Utils::get_vk_debug_report_object_type_ext_fro
 
     switch (in_object_type)
     {
+        case Anvil::ObjectType::ACCELERATION_STRUCTURE:     result = VK_DEBUG_REPORT_OBJECT_TYPE_ACCELERATION_STRUCTURE_KHR_EXT; break;
         case Anvil::ObjectType::BUFFER:                     result = VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT;                     break;
         case Anvil::ObjectType::BUFFER_VIEW:                result = VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_VIEW_EXT;                break;
         case Anvil::ObjectType::COMMAND_BUFFER:             result = VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT;             break;
@@ -992,6 +1009,7 @@ VkObjectType Anvil::Utils::get_vk_object_type_for_object_type(const Anvil::Objec
 
     switch (in_object_type)
     {
+        case Anvil::ObjectType::ACCELERATION_STRUCTURE:     result = VK_OBJECT_TYPE_ACCELERATION_STRUCTURE_KHR; break;
         case Anvil::ObjectType::BUFFER:                     result = VK_OBJECT_TYPE_BUFFER;                     break;
         case Anvil::ObjectType::BUFFER_VIEW:                result = VK_OBJECT_TYPE_BUFFER_VIEW;                break;
         case Anvil::ObjectType::COMMAND_BUFFER:             result = VK_OBJECT_TYPE_COMMAND_BUFFER;             break;
@@ -1069,6 +1087,8 @@ void Anvil::Utils::get_vk_property_flags_from_memory_feature_flags(Anvil::Memory
         result_mem_heap_flags |= Anvil::MemoryHeapFlagBits::MULTI_INSTANCE_BIT_KHR;
     }
 
+    /* NOTE: PREFER_DEVICE_LOCAL_BIT is a preference and is deliberately not translated to a required property flag. */
+
     if ((in_mem_feature_flags & Anvil::MemoryFeatureFlagBits::PROTECTED_BIT) != 0)
     {
         result_mem_type_flags |= Anvil::MemoryPropertyFlagBits::PROTECTED_BIT;
@@ -1078,6 +1098,75 @@ void Anvil::Utils::get_vk_property_flags_from_memory_feature_flags(Anvil::Memory
     *out_mem_type_flags_ptr = result_mem_type_flags;
 }
 
+/** Please see header for specification */
+Anvil::AccessFlags Anvil::Utils::get_write_access_mask(Anvil::AccessFlags in_access_mask)
+{
+    const Anvil::AccessFlags write_access_mask = Anvil::AccessFlagBits::COLOR_ATTACHMENT_WRITE_BIT               |
+                                                 Anvil::AccessFlagBits::DEPTH_STENCIL_ATTACHMENT_WRITE_BIT       |
+                                                 Anvil::AccessFlagBits::HOST_WRITE_BIT                           |
+                                                 Anvil::AccessFlagBits::MEMORY_WRITE_BIT                         |
+                                                 Anvil::AccessFlagBits::SHADER_WRITE_BIT                         |
+                                                 Anvil::AccessFlagBits::TRANSFER_WRITE_BIT                       |
+                                                 Anvil::AccessFlagBits::TRANSFORM_FEEDBACK_COUNTER_WRITE_BIT_EXT |
+                                                 Anvil::AccessFlagBits::TRANSFORM_FEEDBACK_WRITE_BIT_EXT;
+
+    return (in_access_mask & write_access_mask);
+}
+
+/** Please see header for specification */
+uint64_t Anvil::Utils::hash64(const void* in_data_ptr,
+                              size_t      in_n_bytes,
+                              uint64_t    in_seed)
+{
+    const uint64_t       multiplier   = 0xc6a4a7935bd1e995ull;
+    const uint32_t       shift        = 47;
+    const unsigned char* data_u8_ptr  = static_cast<const unsigned char*>(in_data_ptr);
+    const size_t         n_tail_bytes = in_n_bytes % sizeof(uint64_t);
+    const size_t         n_words      = in_n_bytes / sizeof(uint64_t);
+    uint64_t             result       = in_seed ^ (static_cast<uint64_t>(in_n_bytes) * multiplier);
+
+    for (size_t n_word = 0;
+                n_word < n_words;
+              ++n_word)
+    {
+        uint64_t word;
+
+        /* memcpy() keeps the reads safe for unaligned input. Compilers turn it into a single load. */
+        memcpy(&word,
+               data_u8_ptr + n_word * sizeof(uint64_t),
+               sizeof(word) );
+
+        word *= multiplier;
+        word ^= word >> shift;
+        word *= multiplier;
+
+        result ^= word;
+        result *= multiplier;
+    }
+
+    if (n_tail_bytes > 0)
+    {
+        const unsigned char* tail_u8_ptr = data_u8_ptr + n_words * sizeof(uint64_t);
+        uint64_t             tail        = 0;
+
+        for (size_t n_tail_byte = 0;
+                    n_tail_byte < n_tail_bytes;
+                  ++n_tail_byte)
+        {
+            tail |= static_cast<uint64_t>(tail_u8_ptr[n_tail_byte]) << (8 * n_tail_byte);
+        }
+
+        result ^= tail;
+        result *= multiplier;
+    }
+
+    result ^= result >> shift;
+    result *= multiplier;
+    result ^= result >> shift;
+
+    return result;
+}
+
 #ifdef _WIN32
     bool Anvil::Utils::is_nt_handle(const Anvil::ExternalFenceHandleTypeFlagBits& in_type)
     {
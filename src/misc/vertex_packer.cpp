@@ -0,0 +1,677 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "misc/buffer_create_info.h"
+#include "misc/debug.h"
+#include "misc/fp16.h"
+#include "misc/graphics_pipeline_create_info.h"
+#include "misc/memory_allocator.h"
+#include "misc/vertex_packer.h"
+#include "wrappers/buffer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define ANVIL_VERTEX_PACKER_HAS_SSE2
+
+    #include <emmintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+    #define ANVIL_VERTEX_PACKER_HAS_NEON
+
+    #include <arm_neon.h>
+#endif
+
+namespace
+{
+    enum class PackedEncoding
+    {
+        FLOAT16,
+        FLOAT32,
+        SNORM10_10_10_2,
+        UNORM8,
+        UNORM16,
+    };
+
+    typedef struct PackedAttributeLayout
+    {
+        PackedEncoding encoding;
+        Anvil::Format  format;
+        uint32_t       n_components; /* Number of components stored, including padding */
+        uint32_t       offset_in_bytes;
+    } PackedAttributeLayout;
+}
+
+/* Value padding components are set to, unless the attribute semantic calls for something else. */
+static const float g_default_pad_value = 0.0f;
+
+
+/** Returns the packed layout to use for an attribute. Offset is left for the caller to fill. */
+static PackedAttributeLayout get_packed_attribute_layout(Anvil::VertexPacker::AttributeSemantic in_semantic,
+                                                         uint32_t                               in_n_components,
+                                                         bool                                   in_is_in_unorm_range)
+{
+    static const Anvil::Format float16_formats[] =
+    {
+        Anvil::Format::R16_SFLOAT,
+        Anvil::Format::R16G16_SFLOAT,
+        Anvil::Format::R16G16B16A16_SFLOAT,
+        Anvil::Format::R16G16B16A16_SFLOAT,
+    };
+    static const Anvil::Format float32_formats[] =
+    {
+        Anvil::Format::R32_SFLOAT,
+        Anvil::Format::R32G32_SFLOAT,
+        Anvil::Format::R32G32B32_SFLOAT,
+        Anvil::Format::R32G32B32A32_SFLOAT,
+    };
+    static const Anvil::Format unorm16_formats[] =
+    {
+        Anvil::Format::R16_UNORM,
+        Anvil::Format::R16G16_UNORM,
+        Anvil::Format::R16G16B16A16_UNORM,
+        Anvil::Format::R16G16B16A16_UNORM,
+    };
+
+    /* 3-component 16-bit formats have poor device support and break 4-byte alignment, so pad them to 4 components. */
+    const uint32_t        n_16bit_components = (in_n_components == 3) ? 4 : in_n_components;
+    PackedAttributeLayout result;
+
+    result.offset_in_bytes = 0;
+
+    switch (in_semantic)
+    {
+        case Anvil::VertexPacker::AttributeSemantic::COLOR:
+        {
+            result.encoding     = PackedEncoding::UNORM8;
+            result.format       = Anvil::Format::R8G8B8A8_UNORM;
+            result.n_components = 4;
+
+            break;
+        }
+
+        case Anvil::VertexPacker::AttributeSemantic::NORMAL:
+        {
+            result.encoding     = PackedEncoding::SNORM10_10_10_2;
+            result.format       = Anvil::Format::A2B10G10R10_SNORM_PACK32;
+            result.n_components = 4;
+
+            break;
+        }
+
+        case Anvil::VertexPacker::AttributeSemantic::POSITION:
+        {
+            result.encoding     = PackedEncoding::FLOAT16;
+            result.format       = float16_formats[in_n_components - 1];
+            result.n_components = n_16bit_components;
+
+            break;
+        }
+
+        case Anvil::VertexPacker::AttributeSemantic::TEXCOORD:
+        {
+            result.encoding     = (in_is_in_unorm_range) ? PackedEncoding::UNORM16
+                                                         : PackedEncoding::FLOAT16;
+            result.format       = (in_is_in_unorm_range) ? unorm16_formats[in_n_components - 1]
+                                                         : float16_formats[in_n_components - 1];
+            result.n_components = n_16bit_components;
+
+            break;
+        }
+
+        default:
+        {
+            anvil_assert(in_semantic == Anvil::VertexPacker::AttributeSemantic::GENERIC);
+
+            result.encoding     = PackedEncoding::FLOAT32;
+            result.format       = float32_formats[in_n_components - 1];
+            result.n_components = in_n_components;
+        }
+    }
+
+    return result;
+}
+
+/** Returns the number of bytes a single packed attribute value takes. */
+static uint32_t get_packed_attribute_size(const PackedAttributeLayout& in_layout)
+{
+    switch (in_layout.encoding)
+    {
+        case PackedEncoding::FLOAT16:         return in_layout.n_components * static_cast<uint32_t>(sizeof(uint16_t) );
+        case PackedEncoding::FLOAT32:         return in_layout.n_components * static_cast<uint32_t>(sizeof(float) );
+        case PackedEncoding::SNORM10_10_10_2: return static_cast<uint32_t>(sizeof(uint32_t) );
+        case PackedEncoding::UNORM8:          return static_cast<uint32_t>(sizeof(uint32_t) );
+        case PackedEncoding::UNORM16:         return in_layout.n_components * static_cast<uint32_t>(sizeof(uint16_t) );
+
+        default:
+        {
+            anvil_assert_fail();
+
+            return 0;
+        }
+    }
+}
+
+/** Clamps @param in_n_values values to [in_min, in_max], multiplies them by @param in_scale and rounds the results to
+ *  nearest even.
+ *
+ *  NaNs are clamped to @param in_min.
+ **/
+static void quantize_n(const float* in_src_ptr,
+                       uint32_t     in_n_values,
+                       float        in_min,
+                       float        in_max,
+                       float        in_scale,
+                       int32_t*     out_result_ptr)
+{
+    uint32_t n_value = 0;
+
+    #if defined(ANVIL_VERTEX_PACKER_HAS_SSE2)
+    {
+        const __m128 max_v   = _mm_set1_ps(in_max);
+        const __m128 min_v   = _mm_set1_ps(in_min);
+        const __m128 scale_v = _mm_set1_ps(in_scale);
+
+        /* _mm_max_ps() returns the second operand if the first one is a NaN, which is what clamps NaNs to in_min.
+         * _mm_cvtps_epi32() rounds according to MXCSR, which defaults to round-to-nearest-even. */
+        for (;
+             n_value + 4 <= in_n_values;
+             n_value += 4)
+        {
+            const __m128 src_v     = _mm_loadu_ps (in_src_ptr + n_value);
+            const __m128 clamped_v = _mm_min_ps   (_mm_max_ps(src_v, min_v),
+                                                   max_v);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out_result_ptr + n_value),
+                             _mm_cvtps_epi32(_mm_mul_ps(clamped_v, scale_v) ));
+        }
+    }
+    #elif defined(ANVIL_VERTEX_PACKER_HAS_NEON)
+    {
+        const float32x4_t max_v   = vdupq_n_f32(in_max);
+        const float32x4_t min_v   = vdupq_n_f32(in_min);
+        const float32x4_t scale_v = vdupq_n_f32(in_scale);
+
+        for (;
+             n_value + 4 <= in_n_values;
+             n_value += 4)
+        {
+            const float32x4_t src_v     = vld1q_f32(in_src_ptr + n_value);
+            const uint32x4_t  is_gt_v   = vcgtq_f32(src_v, min_v);
+            const float32x4_t clamped_v = vminq_f32(vbslq_f32(is_gt_v, src_v, min_v),
+                                                    max_v);
+
+            vst1q_s32(out_result_ptr + n_value,
+                      vcvtnq_s32_f32(vmulq_f32(clamped_v, scale_v) ));
+        }
+    }
+    #endif
+
+    for (;
+         n_value < in_n_values;
+       ++n_value)
+    {
+        float value = in_src_ptr[n_value];
+
+        value = (value > in_min) ? value : in_min;
+        value = (value < in_max) ? value : in_max;
+
+        out_result_ptr[n_value] = static_cast<int32_t>(std::nearbyint(value * in_scale) );
+    }
+}
+
+
+/** Please see header for specification */
+Anvil::VertexPacker::VertexPacker()
+    :m_packed_stride(0)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::VertexPacker::~VertexPacker()
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+bool Anvil::VertexPacker::add_attribute(uint32_t          in_location,
+                                        AttributeSemantic in_semantic,
+                                        uint32_t          in_n_components,
+                                        const float*      in_data_ptr,
+                                        uint32_t          in_stride_in_bytes)
+{
+    bool result = false;
+
+    if (in_data_ptr        == nullptr                                                  ||
+        in_n_components    <  1                                                        ||
+        in_n_components    >  4                                                        ||
+        in_stride_in_bytes <  in_n_components * static_cast<uint32_t>(sizeof(float) ) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (in_semantic     == AttributeSemantic::NORMAL &&
+        in_n_components <  3)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    for (const auto& current_attribute : m_input_attributes)
+    {
+        if (current_attribute.location == in_location)
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    m_input_attributes.push_back(
+        InputAttribute(in_location,
+                       in_semantic,
+                       in_n_components,
+                       in_data_ptr,
+                       in_stride_in_bytes)
+    );
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::VertexPacker::add_to_pipeline_create_info(uint32_t                           in_binding,
+                                                      Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr) const
+{
+    bool result = false;
+
+    if (in_gfx_pipeline_create_info_ptr == nullptr)
+    {
+        anvil_assert(in_gfx_pipeline_create_info_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (m_vertex_attributes.size() == 0)
+    {
+        /* pack() has not been called, or it failed */
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    result = in_gfx_pipeline_create_info_ptr->add_vertex_binding(in_binding,
+                                                                 Anvil::VertexInputRate::VERTEX,
+                                                                 m_packed_stride,
+                                                                 static_cast<uint32_t>(m_vertex_attributes.size() ),
+                                                                 m_vertex_attributes.data() );
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::VertexPackerUniquePtr Anvil::VertexPacker::create()
+{
+    Anvil::VertexPackerUniquePtr result_ptr(new Anvil::VertexPacker(),
+                                            std::default_delete<Anvil::VertexPacker>() );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+Anvil::BufferUniquePtr Anvil::VertexPacker::create_vertex_buffer(const Anvil::BaseDevice*  in_device_ptr,
+                                                                 Anvil::MemoryAllocator*   in_memory_allocator_ptr,
+                                                                 Anvil::MemoryFeatureFlags in_required_memory_features) const
+{
+    Anvil::BufferCreateInfoUniquePtr        create_info_ptr;
+    std::unique_ptr<std::vector<uint32_t> > data_ptr;
+    Anvil::BufferUniquePtr                  result_ptr;
+
+    if (in_device_ptr           == nullptr ||
+        in_memory_allocator_ptr == nullptr)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (m_packed_data.size() == 0)
+    {
+        /* pack() has not been called, or it failed */
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    create_info_ptr = Anvil::BufferCreateInfo::create_no_alloc(in_device_ptr,
+                                                               m_packed_data.size() * sizeof(uint32_t),
+                                                               Anvil::QueueFamilyFlagBits::GRAPHICS_BIT,
+                                                               Anvil::SharingMode::EXCLUSIVE,
+                                                               Anvil::BufferCreateFlagBits::NONE,
+                                                               Anvil::BufferUsageFlagBits::VERTEX_BUFFER_BIT);
+    result_ptr      = Anvil::Buffer::create(std::move(create_info_ptr) );
+
+    if (result_ptr == nullptr)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    data_ptr.reset(new std::vector<uint32_t>(m_packed_data) );
+
+    if (!in_memory_allocator_ptr->add_buffer_with_uint32_data_vector_ptr_based_post_fill(result_ptr.get(),
+                                                                                          std::move(data_ptr),
+                                                                                          in_required_memory_features) )
+    {
+        anvil_assert_fail();
+
+        result_ptr.reset();
+        goto end;
+    }
+
+end:
+    return result_ptr;
+}
+
+/** Please see header for specification */
+bool Anvil::VertexPacker::pack(uint32_t in_n_vertices)
+{
+    std::vector<float>                 gathered_data;
+    std::vector<Anvil::float16_t>      float16_data;
+    std::vector<PackedAttributeLayout> layouts;
+    uint8_t*                           packed_data_u8_ptr = nullptr;
+    std::vector<int32_t>               quantized_data;
+    bool                               result             = false;
+    uint32_t                           stride             = 0;
+
+    static_assert(sizeof(Anvil::float32_t) == sizeof(float),
+                  "FP16 batch conversion routines are fed float arrays");
+
+    m_packed_data.clear      ();
+    m_vertex_attributes.clear();
+
+    m_packed_stride = 0;
+
+    if (in_n_vertices            == 0 ||
+        m_input_attributes.size() == 0)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    /* 1. Determine the packed layout. */
+    layouts.reserve(m_input_attributes.size() );
+
+    for (const auto& current_attribute : m_input_attributes)
+    {
+        bool is_in_unorm_range = true;
+
+        if (current_attribute.semantic == AttributeSemantic::TEXCOORD)
+        {
+            const uint8_t* src_u8_ptr = reinterpret_cast<const uint8_t*>(current_attribute.data_ptr);
+
+            for (uint32_t n_vertex = 0;
+                          n_vertex < in_n_vertices && is_in_unorm_range;
+                        ++n_vertex)
+            {
+                const float* src_ptr = reinterpret_cast<const float*>(src_u8_ptr + n_vertex * current_attribute.stride_in_bytes);
+
+                for (uint32_t n_component = 0;
+                              n_component < current_attribute.n_components;
+                            ++n_component)
+                {
+                    /* Written so that NaNs fail the test */
+                    if (!(src_ptr[n_component] >= 0.0f && src_ptr[n_component] <= 1.0f) )
+                    {
+                        is_in_unorm_range = false;
+
+                        break;
+                    }
+                }
+            }
+        }
+
+        layouts.push_back(
+            get_packed_attribute_layout(current_attribute.semantic,
+                                        current_attribute.n_components,
+                                        is_in_unorm_range)
+        );
+
+        layouts.back().offset_in_bytes = stride;
+
+        stride += Anvil::Utils::round_up(get_packed_attribute_size(layouts.back() ),
+                                         static_cast<uint32_t>(sizeof(uint32_t) ));
+    }
+
+    m_packed_data.resize(static_cast<size_t>(stride / sizeof(uint32_t) ) * in_n_vertices,
+                         0);
+
+    packed_data_u8_ptr = reinterpret_cast<uint8_t*>(&m_packed_data.at(0) );
+
+    /* 2. Convert & interleave the attributes one after another. Source data is first gathered into a tightly packed
+     *    array, so that the conversion routines can operate on contiguous data.
+     */
+    for (uint32_t n_attribute = 0;
+                  n_attribute < static_cast<uint32_t>(m_input_attributes.size() );
+                ++n_attribute)
+    {
+        const auto&    current_attribute = m_input_attributes.at(n_attribute);
+        const auto&    current_layout    = layouts.at           (n_attribute);
+        const uint32_t n_values          = in_n_vertices * current_layout.n_components;
+        const float    pad_value_w       = (current_attribute.semantic == AttributeSemantic::COLOR    ||
+                                            current_attribute.semantic == AttributeSemantic::POSITION) ? 1.0f
+                                                                                                       : g_default_pad_value;
+        const uint8_t* src_u8_ptr        = reinterpret_cast<const uint8_t*>(current_attribute.data_ptr);
+        uint8_t*       dst_u8_ptr        = packed_data_u8_ptr + current_layout.offset_in_bytes;
+
+        gathered_data.resize(n_values);
+
+        for (uint32_t n_vertex = 0;
+                      n_vertex < in_n_vertices;
+                    ++n_vertex)
+        {
+            const float* src_ptr = reinterpret_cast<const float*>(src_u8_ptr + n_vertex * current_attribute.stride_in_bytes);
+            float*       dst_ptr = &gathered_data.at(n_vertex * current_layout.n_components);
+
+            for (uint32_t n_component = 0;
+                          n_component < current_layout.n_components;
+                        ++n_component)
+            {
+                dst_ptr[n_component] = (n_component < current_attribute.n_components) ? src_ptr[n_component]
+                                     : (n_component == 3)                             ? pad_value_w
+                                                                                      : g_default_pad_value;
+            }
+        }
+
+        switch (current_layout.encoding)
+        {
+            case PackedEncoding::FLOAT16:
+            {
+                const uint32_t value_size = current_layout.n_components * static_cast<uint32_t>(sizeof(Anvil::float16_t) );
+
+                float16_data.resize(n_values);
+
+                Anvil::Utils::convert_fp32_to_fp16_n(reinterpret_cast<const Anvil::float32_t*>(gathered_data.data() ),
+                                                     n_values,
+                                                     float16_data.data() );
+
+                for (uint32_t n_vertex = 0;
+                              n_vertex < in_n_vertices;
+                            ++n_vertex)
+                {
+                    memcpy(dst_u8_ptr + n_vertex * stride,
+                           &float16_data.at(n_vertex * current_layout.n_components),
+                           value_size);
+                }
+
+                break;
+            }
+
+            case PackedEncoding::FLOAT32:
+            {
+                const uint32_t value_size = current_layout.n_components * static_cast<uint32_t>(sizeof(float) );
+
+                for (uint32_t n_vertex = 0;
+                              n_vertex < in_n_vertices;
+                            ++n_vertex)
+                {
+                    memcpy(dst_u8_ptr + n_vertex * stride,
+                           &gathered_data.at(n_vertex * current_layout.n_components),
+                           value_size);
+                }
+
+                break;
+            }
+
+            case PackedEncoding::SNORM10_10_10_2:
+            {
+                quantized_data.resize(n_values);
+
+                quantize_n(gathered_data.data(),
+                           n_values,
+                           -1.0f,
+                           1.0f,
+                           511.0f,
+                           quantized_data.data() );
+
+                for (uint32_t n_vertex = 0;
+                              n_vertex < in_n_vertices;
+                            ++n_vertex)
+                {
+                    const int32_t* src_ptr = &quantized_data.at(n_vertex * 4);
+                    const float    w       = gathered_data.at  (n_vertex * 4 + 3);
+
+                    /* The 2-bit alpha channel only holds -1, 0 and 1, so it is rounded separately. */
+                    const int32_t  alpha   = (w >= 0.5f)  ?  1
+                                           : (w <= -0.5f) ? -1
+                                                          :  0;
+                    const uint32_t packed  = ((static_cast<uint32_t>(src_ptr[0]) & 0x3FFu)      ) |
+                                             ((static_cast<uint32_t>(src_ptr[1]) & 0x3FFu) << 10) |
+                                             ((static_cast<uint32_t>(src_ptr[2]) & 0x3FFu) << 20) |
+                                             ((static_cast<uint32_t>(alpha)      & 0x3u)   << 30);
+
+                    memcpy(dst_u8_ptr + n_vertex * stride,
+                           &packed,
+                           sizeof(packed) );
+                }
+
+                break;
+            }
+
+            case PackedEncoding::UNORM8:
+            {
+                quantized_data.resize(n_values);
+
+                quantize_n(gathered_data.data(),
+                           n_values,
+                           0.0f,
+                           1.0f,
+                           255.0f,
+                           quantized_data.data() );
+
+                for (uint32_t n_vertex = 0;
+                              n_vertex < in_n_vertices;
+                            ++n_vertex)
+                {
+                    uint8_t* dst_ptr = dst_u8_ptr + n_vertex * stride;
+
+                    for (uint32_t n_component = 0;
+                                  n_component < 4;
+                                ++n_component)
+                    {
+                        dst_ptr[n_component] = static_cast<uint8_t>(quantized_data.at(n_vertex * 4 + n_component) );
+                    }
+                }
+
+                break;
+            }
+
+            case PackedEncoding::UNORM16:
+            {
+                quantized_data.resize(n_values);
+
+                quantize_n(gathered_data.data(),
+                           n_values,
+                           0.0f,
+                           1.0f,
+                           65535.0f,
+                           quantized_data.data() );
+
+                for (uint32_t n_vertex = 0;
+                              n_vertex < in_n_vertices;
+                            ++n_vertex)
+                {
+                    uint8_t* dst_ptr = dst_u8_ptr + n_vertex * stride;
+
+                    for (uint32_t n_component = 0;
+                                  n_component < current_layout.n_components;
+                                ++n_component)
+                    {
+                        const uint16_t value = static_cast<uint16_t>(quantized_data.at(n_vertex * current_layout.n_components + n_component) );
+
+                        memcpy(dst_ptr + n_component * sizeof(uint16_t),
+                               &value,
+                               sizeof(value) );
+                    }
+                }
+
+                break;
+            }
+
+            default:
+            {
+                anvil_assert_fail();
+
+                goto end;
+            }
+        }
+
+        m_vertex_attributes.push_back(
+            Anvil::VertexInputAttribute(current_attribute.location,
+                                        current_layout.format,
+                                        current_layout.offset_in_bytes)
+        );
+    }
+
+    m_packed_stride = stride;
+    result          = true;
+
+end:
+    if (!result)
+    {
+        m_packed_data.clear      ();
+        m_vertex_attributes.clear();
+    }
+
+    return result;
+}
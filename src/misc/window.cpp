@@ -29,14 +29,19 @@ Anvil::Window::Window(const std::string&      in_title,
                       unsigned int            in_height,
                       bool                    in_closable,
                       PresentCallbackFunction in_present_callback_func)
-    :CallbacksSupportProvider(WINDOW_CALLBACK_ID_COUNT),
-     m_closable              (in_closable),
-     m_height                (in_height),
-     m_present_callback_func (in_present_callback_func),
-     m_title                 (in_title),
-     m_width                 (in_width),
-     m_window_should_close   (false),
-     m_window_close_finished (false)
+    :CallbacksSupportProvider      (WINDOW_CALLBACK_ID_COUNT),
+     m_closable                    (in_closable),
+     m_height                      (in_height),
+     m_present_callback_func       (in_present_callback_func),
+     m_title                       (in_title),
+     m_width                       (in_width),
+     m_window_should_close         (false),
+     m_window_close_finished       (false),
+     m_event_thread_close_requested(false),
+     m_is_event_thread_enabled     (false),
+     m_event_queue_read_index      (0),
+     m_event_queue_write_index     (0),
+     m_n_dropped_events            (0)
 {
     /* Stub */
 }
@@ -44,6 +49,61 @@ Anvil::Window::Window(const std::string&      in_title,
 /** Destructor */
 Anvil::Window::~Window()
 {
-    /* Stub */
+    /* Derived classes release the system window before this destructor is invoked, so the event thread
+     * must have been joined by now. Please see WindowFactory::create_window_with_event_thread() */
+    anvil_assert(!m_event_thread.joinable() );
+}
+
+/** Waits until the event thread, if any, quits. */
+void Anvil::Window::join_event_thread()
+{
+    if (m_event_thread.joinable() )
+    {
+        anvil_assert(std::this_thread::get_id() != m_event_thread_id);
+
+        m_event_thread.join();
+    }
+}
+
+/** Please see header for specification */
+bool Anvil::Window::poll_event(WindowEvent* out_event_ptr)
+{
+    const uint32_t read_index = m_event_queue_read_index.load (std::memory_order_relaxed);
+    bool           result     = false;
+
+    if (read_index == m_event_queue_write_index.load(std::memory_order_acquire) )
+    {
+        goto end;
+    }
+
+    *out_event_ptr = m_event_queue.at(read_index % N_EVENT_QUEUE_SLOTS);
+
+    m_event_queue_read_index.store(read_index + 1,
+                                   std::memory_order_release);
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::Window::push_event(const WindowEvent& in_event)
+{
+    const uint32_t write_index = m_event_queue_write_index.load(std::memory_order_relaxed);
+
+    anvil_assert(std::this_thread::get_id() == m_event_thread_id);
+
+    if (write_index - m_event_queue_read_index.load(std::memory_order_acquire) >= N_EVENT_QUEUE_SLOTS)
+    {
+        /* The app is not polling the queue quickly enough. Drop the event rather than block the message pump. */
+        m_n_dropped_events.fetch_add(1);
+    }
+    else
+    {
+        m_event_queue.at(write_index % N_EVENT_QUEUE_SLOTS) = in_event;
+
+        m_event_queue_write_index.store(write_index + 1,
+                                        std::memory_order_release);
+    }
 }
 
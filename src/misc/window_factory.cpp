@@ -21,6 +21,7 @@
 //
 
 #include "misc/window_factory.h"
+#include <future>
 
 Anvil::WindowUniquePtr Anvil::WindowFactory::create_window(WindowPlatform          in_platform,
                                                            const std::string&      in_title,
@@ -157,4 +158,84 @@ Anvil::WindowUniquePtr Anvil::WindowFactory::create_window(WindowPlatform in_pla
     }
 
     return result_ptr;
-}
\ No newline at end of file
+}
+
+Anvil::WindowUniquePtr Anvil::WindowFactory::create_window_with_event_thread(WindowPlatform     in_platform,
+                                                                             const std::string& in_title,
+                                                                             unsigned int       in_width,
+                                                                             unsigned int       in_height,
+                                                                             bool               in_closable,
+                                                                             bool               in_visible)
+{
+    std::thread                                   event_thread;
+    WindowUniquePtr                               result_ptr         (nullptr,
+                                                                      std::default_delete<Window>() );
+    Anvil::Window*                                window_ptr         (nullptr);
+    std::shared_ptr<std::promise<Anvil::Window*> > window_promise_ptr(new std::promise<Anvil::Window*>() );
+    std::future<Anvil::Window*>                   window_future      (window_promise_ptr->get_future() );
+
+    if (in_platform == WINDOW_PLATFORM_DUMMY_WITH_PNG_SNAPSHOTS)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    /* Some platforms (eg. win32) deliver window messages to the thread which has created the window, so the window
+     * needs to be created on the event thread.
+     */
+    event_thread = std::thread(
+        [=]()
+        {
+            auto           new_window_ptr = Anvil::WindowFactory::create_window(in_platform,
+                                                                                in_title,
+                                                                                in_width,
+                                                                                in_height,
+                                                                                in_closable,
+                                                                                nullptr, /* in_present_callback_func */
+                                                                                in_visible);
+            Anvil::Window* new_window_raw_ptr = new_window_ptr.release();
+
+            if (new_window_raw_ptr != nullptr)
+            {
+                new_window_raw_ptr->m_event_queue.resize(static_cast<size_t>(Anvil::Window::N_EVENT_QUEUE_SLOTS) );
+
+                new_window_raw_ptr->m_event_thread_id         = std::this_thread::get_id();
+                new_window_raw_ptr->m_is_event_thread_enabled = true;
+            }
+
+            window_promise_ptr->set_value(new_window_raw_ptr);
+
+            if (new_window_raw_ptr != nullptr)
+            {
+                new_window_raw_ptr->run();
+            }
+        }
+    );
+
+    window_ptr = window_future.get();
+
+    if (window_ptr == nullptr)
+    {
+        event_thread.join();
+
+        goto end;
+    }
+
+    window_ptr->m_event_thread = std::move(event_thread);
+
+    /* The event thread must quit before the system window is released. */
+    result_ptr = WindowUniquePtr(
+        window_ptr,
+        [](Anvil::Window* in_window_ptr)
+        {
+            in_window_ptr->close            ();
+            in_window_ptr->join_event_thread();
+
+            delete in_window_ptr;
+        }
+    );
+
+end:
+    return result_ptr;
+}
@@ -144,7 +144,8 @@ void Anvil::WindowWin3264::close()
     {
         m_window_should_close = true;
 
-        /* NOTE: When the call below leaves, the window is guaranteed to be gone */
+        /* NOTE: When the call below leaves, the window is guaranteed to be gone. If the window is owned by the event thread,
+         *       SendMessage() blocks until that thread has handled the message. */
         ::SendMessage(m_window,
                       WM_DESTROY_WINDOW,
                       0,  /* wParam */
@@ -285,6 +286,17 @@ LRESULT CALLBACK Anvil::WindowWin3264::msg_callback_pfn_proc(HWND   in_window_ha
         }
 
         case WM_CLOSE:
+        {
+            if (window_ptr->m_is_event_thread_enabled)
+            {
+                /* The app decides when the window gets closed. Please see WindowFactory::create_window_with_event_thread() */
+                window_ptr->push_event(WindowEvent(WINDOW_EVENT_TYPE_CLOSE_REQUESTED) );
+
+                return 0;
+            }
+        }
+        /* Fall-through */
+
         case WM_DESTROY_WINDOW:
         {
             OnWindowAboutToCloseCallbackArgument callback_argument(window_ptr);
@@ -305,9 +317,35 @@ LRESULT CALLBACK Anvil::WindowWin3264::msg_callback_pfn_proc(HWND   in_window_ha
             window_ptr->callback(WINDOW_CALLBACK_ID_KEYPRESS_RELEASED,
                                 &callback_data);
 
+            if (window_ptr->m_is_event_thread_enabled)
+            {
+                WindowEvent event(WINDOW_EVENT_TYPE_KEYPRESS_RELEASED);
+
+                event.key_id = callback_data.released_key_id;
+
+                window_ptr->push_event(event);
+            }
+
             return 0;
         }
 
+        case WM_SIZE:
+        {
+            /* NOTE: The message is also sent while the window is being created, before user data is assigned. */
+            if (window_ptr                             != nullptr &&
+                window_ptr->m_is_event_thread_enabled)
+            {
+                WindowEvent event(WINDOW_EVENT_TYPE_RESIZED);
+
+                event.height = HIWORD(in_param_long);
+                event.width  = LOWORD(in_param_long);
+
+                window_ptr->push_event(event);
+            }
+
+            break;
+        }
+
         default:
         {
             break;
@@ -328,6 +366,24 @@ void Anvil::WindowWin3264::run()
     /* This function should only be called for wrapper instances which have created the window! */
     anvil_assert(m_window_owned);
 
+    if (m_is_event_thread_enabled)
+    {
+        MSG msg;
+
+        /* Nothing to render on this thread, so block until new messages arrive. close() sends a message to this thread,
+         * which eventually results in WM_QUIT being posted. */
+        while (::GetMessage(&msg,
+                            nullptr,
+                            0,
+                            0) > 0)
+        {
+            ::TranslateMessage(&msg);
+            ::DispatchMessage (&msg);
+        }
+
+        done = 1;
+    }
+
     /* Run the message loop */
     while (!done)
     {
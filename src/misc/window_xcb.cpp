@@ -20,6 +20,7 @@
 // THE SOFTWARE.
 //
 #include "misc/window_xcb.h"
+#include <chrono>
 
 /* Copy-pasted from xcb-icccm.h header, as there's no really good reason to include
  * a new dependency on the icccm library other than this struct and a bunch of const ints.
@@ -143,6 +144,15 @@ void Anvil::WindowXcb::close()
 {
     anvil_assert(m_window_owned);
 
+    if (should_delegate_close_to_event_thread() )
+    {
+        /* Let the event thread close the window once it leaves the message pump, so that the resources used by
+         * the pump are not released from under it. */
+        m_event_thread_close_requested = true;
+
+        join_event_thread();
+    }
+    else
     if (!m_window_should_close)
     {
         OnWindowAboutToCloseCallbackArgument callback_argument(this);
@@ -359,12 +369,15 @@ end:
 /* Please see header for specification */
 void Anvil::WindowXcb::run()
 {
-    bool running = true;
+    uint32_t last_height = m_height;
+    uint32_t last_width  = m_width;
+    bool     running     = true;
 
     anvil_assert(m_window_owned);
 
-    while (running                &&
-           !m_window_should_close)
+    while (running                         &&
+           !m_window_should_close          &&
+           !m_event_thread_close_requested)
     {
         xcb_generic_event_t* event_ptr = m_xcb_loader.get_procs_table()->pfn_xcbPollForEvent(m_connection_ptr);
 
@@ -377,7 +390,14 @@ void Anvil::WindowXcb::run()
                     if ((reinterpret_cast<xcb_client_message_event_t*>(event_ptr)->data.data32[0] == m_atom_wm_delete_window_ptr->atom) &&
                         m_closable)
                     {
-                        running = false;
+                        if (m_is_event_thread_enabled)
+                        {
+                            push_event(WindowEvent(WINDOW_EVENT_TYPE_CLOSE_REQUESTED) );
+                        }
+                        else
+                        {
+                            running = false;
+                        }
                     }
 
                     break;
@@ -398,6 +418,36 @@ void Anvil::WindowXcb::run()
                     callback(WINDOW_CALLBACK_ID_KEYPRESS_RELEASED,
                             &callback_argument);
 
+                    if (m_is_event_thread_enabled)
+                    {
+                        WindowEvent event(WINDOW_EVENT_TYPE_KEYPRESS_RELEASED);
+
+                        event.key_id = static_cast<Anvil::KeyID>(sym);
+
+                        push_event(event);
+                    }
+
+                    break;
+                }
+
+                case XCB_CONFIGURE_NOTIFY:
+                {
+                    const xcb_configure_notify_event_t* configure_ptr = reinterpret_cast<const xcb_configure_notify_event_t*>(event_ptr);
+
+                    if (m_is_event_thread_enabled          &&
+                        (configure_ptr->width  != last_width ||
+                         configure_ptr->height != last_height) )
+                    {
+                        WindowEvent event(WINDOW_EVENT_TYPE_RESIZED);
+
+                        event.height = configure_ptr->height;
+                        event.width  = configure_ptr->width;
+                        last_height  = configure_ptr->height;
+                        last_width   = configure_ptr->width;
+
+                        push_event(event);
+                    }
+
                     break;
                 }
 
@@ -433,6 +483,12 @@ void Anvil::WindowXcb::run()
             {
                 m_present_callback_func();
             }
+            else
+            if (m_is_event_thread_enabled)
+            {
+                /* Nothing to render on this thread. Do not spin while waiting for new events. */
+                std::this_thread::sleep_for(std::chrono::milliseconds(1) );
+            }
 
             running = !m_window_should_close;
         }
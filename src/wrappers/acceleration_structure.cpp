@@ -0,0 +1,189 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/acceleration_structure_create_info.h"
+#include "misc/buffer_create_info.h"
+#include "misc/debug.h"
+#include "misc/memory_allocator.h"
+#include "misc/object_tracker.h"
+#include "wrappers/acceleration_structure.h"
+#include "wrappers/buffer.h"
+#include "wrappers/device.h"
+
+/* Please see header for specification */
+Anvil::AccelerationStructure::AccelerationStructure(Anvil::AccelerationStructureCreateInfoUniquePtr in_create_info_ptr)
+    :DebugMarkerSupportProvider(in_create_info_ptr->get_device(),
+                                Anvil::ObjectType::ACCELERATION_STRUCTURE),
+     MTSafetySupportProvider   (Anvil::Utils::convert_mt_safety_enum_to_boolean(in_create_info_ptr->get_mt_safety(),
+                                                                                in_create_info_ptr->get_device   () )),
+     m_acceleration_structure  (VK_NULL_HANDLE),
+     m_device_address          (0)
+{
+    m_create_info_ptr = std::move(in_create_info_ptr);
+
+    /* Register the acceleration structure instance */
+    Anvil::ObjectTracker::get()->register_object(Anvil::ObjectType::ACCELERATION_STRUCTURE,
+                                                  this);
+}
+
+/** Destructor.
+ *
+ *  Releases the underlying Vulkan acceleration structure instance and signs the wrapper object out from
+ *  the Object Tracker. The storage buffer is released afterward.
+ **/
+Anvil::AccelerationStructure::~AccelerationStructure()
+{
+    Anvil::ObjectTracker::get()->unregister_object(Anvil::ObjectType::ACCELERATION_STRUCTURE,
+                                                    this);
+
+    release_acceleration_structure();
+}
+
+/* Please see header for specification */
+Anvil::AccelerationStructureUniquePtr Anvil::AccelerationStructure::create(Anvil::AccelerationStructureCreateInfoUniquePtr in_create_info_ptr)
+{
+    Anvil::AccelerationStructureUniquePtr result_ptr(nullptr,
+                                                     std::default_delete<Anvil::AccelerationStructure>() );
+
+    result_ptr.reset(
+        new Anvil::AccelerationStructure(std::move(in_create_info_ptr) )
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init() )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+bool Anvil::AccelerationStructure::init()
+{
+    VkAccelerationStructureCreateInfoKHR        create_info;
+    VkAccelerationStructureDeviceAddressInfoKHR device_address_info;
+    const auto&                                 entrypoints         = m_device_ptr->get_extension_khr_acceleration_structure_entrypoints();
+    Anvil::QueueFamilyFlags                     queue_fams          = Anvil::QueueFamilyFlagBits::NONE;
+    VkResult                                    result              = VK_ERROR_INITIALIZATION_FAILED;
+
+    if (m_create_info_ptr->get_memory_allocator() == nullptr)
+    {
+        anvil_assert(m_create_info_ptr->get_memory_allocator() != nullptr);
+
+        goto end;
+    }
+
+    /* Builds and traversals may take place on any queue family which supports compute */
+    if (m_device_ptr->get_n_universal_queues() > 0)
+    {
+        queue_fams |= Anvil::QueueFamilyFlagBits::GRAPHICS_BIT;
+    }
+
+    if (m_device_ptr->get_n_compute_queues() > 0)
+    {
+        queue_fams |= Anvil::QueueFamilyFlagBits::COMPUTE_BIT;
+    }
+
+    {
+        const auto sharing_mode    = Anvil::Utils::is_pow2(queue_fams.get_vk() ) ? Anvil::SharingMode::EXCLUSIVE
+                                                                                 : Anvil::SharingMode::CONCURRENT;
+        auto       create_info_ptr = Anvil::BufferCreateInfo::create_no_alloc(m_device_ptr,
+                                                                              m_create_info_ptr->get_size(),
+                                                                              queue_fams,
+                                                                              sharing_mode,
+                                                                              Anvil::BufferCreateFlagBits::NONE,
+                                                                              Anvil::BufferUsageFlagBits::ACCELERATION_STRUCTURE_STORAGE_BIT_KHR |
+                                                                              Anvil::BufferUsageFlagBits::SHADER_DEVICE_ADDRESS_BIT_KHR);
+
+        create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+
+        m_buffer_ptr = Anvil::Buffer::create(std::move(create_info_ptr) );
+    }
+
+    if (m_buffer_ptr == nullptr)
+    {
+        anvil_assert(m_buffer_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (!m_create_info_ptr->get_memory_allocator()->add_buffer(m_buffer_ptr.get(),
+                                                               Anvil::MemoryFeatureFlagBits::DEVICE_LOCAL_BIT) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    /* Spawn a new acceleration structure. get_buffer() bakes the memory allocator, if needed. */
+    create_info.buffer        = m_buffer_ptr->get_buffer();
+    create_info.createFlags   = 0;
+    create_info.deviceAddress = 0;
+    create_info.offset        = 0;
+    create_info.pNext         = nullptr;
+    create_info.size          = m_create_info_ptr->get_size();
+    create_info.sType         = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
+    create_info.type          = static_cast<VkAccelerationStructureTypeKHR>(m_create_info_ptr->get_type() );
+
+    result = entrypoints.vkCreateAccelerationStructureKHR(m_device_ptr->get_device_vk(),
+                                                         &create_info,
+                                                          m_device_ptr->get_allocation_callbacks_vk(),
+                                                         &m_acceleration_structure);
+
+    anvil_assert_vk_call_succeeded(result);
+    if (!is_vk_call_successful(result) )
+    {
+        goto end;
+    }
+
+    set_vk_handle(m_acceleration_structure);
+
+    /* Cache the device address. It stays valid for the whole life-time of the acceleration structure. */
+    device_address_info.accelerationStructure = m_acceleration_structure;
+    device_address_info.pNext                 = nullptr;
+    device_address_info.sType                 = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR;
+
+    m_device_address = entrypoints.vkGetAccelerationStructureDeviceAddressKHR(m_device_ptr->get_device_vk(),
+                                                                             &device_address_info);
+
+end:
+    return is_vk_call_successful(result);
+}
+
+/** Destroys the underlying Vulkan acceleration structure instance. */
+void Anvil::AccelerationStructure::release_acceleration_structure()
+{
+    if (m_acceleration_structure != VK_NULL_HANDLE)
+    {
+        lock();
+        {
+            m_device_ptr->get_extension_khr_acceleration_structure_entrypoints().vkDestroyAccelerationStructureKHR(m_device_ptr->get_device_vk(),
+                                                                                                                   m_acceleration_structure,
+                                                                                                                   m_device_ptr->get_allocation_callbacks_vk() );
+        }
+        unlock();
+
+        m_acceleration_structure = VK_NULL_HANDLE;
+    }
+}
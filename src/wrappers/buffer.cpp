@@ -21,18 +21,30 @@
 //
 
 #include "misc/buffer_create_info.h"
+#include "misc/buffer_view_create_info.h"
 #include "misc/debug.h"
+#include "misc/fence_create_info.h"
 #include "misc/object_tracker.h"
+#include "misc/perf_counters.h"
+#include "misc/staging_ring.h"
 #include "misc/struct_chainer.h"
 #include "wrappers/buffer.h"
+#include "wrappers/buffer_view.h"
 #include "wrappers/command_buffer.h"
 #include "wrappers/command_pool.h"
 #include "wrappers/device.h"
+#include "wrappers/fence.h"
 #include "wrappers/instance.h"
 #include "wrappers/memory_block.h"
 #include "wrappers/physical_device.h"
 #include "wrappers/queue.h"
 
+/* Transfers to and from non-mappable buffers, which the staging ring cannot accommodate, go through a staging window
+ * made of this many chunks of the specified size. Larger transfers are split into chunks, so that staging memory
+ * usage stays bounded regardless of the transfer size. */
+static const uint32_t     g_n_staging_window_chunks   = 2;
+static const VkDeviceSize g_staging_window_chunk_size = 8 * 1024 * 1024;
+
 Anvil::Buffer::Buffer(Anvil::BufferCreateInfoUniquePtr in_create_info_ptr)
     :CallbacksSupportProvider          (BUFFER_CALLBACK_ID_COUNT),
      DebugMarkerSupportProvider<Buffer>(in_create_info_ptr->get_device(),
@@ -40,6 +52,7 @@ Anvil::Buffer::Buffer(Anvil::BufferCreateInfoUniquePtr in_create_info_ptr)
      MTSafetySupportProvider           (Anvil::Utils::convert_mt_safety_enum_to_boolean(in_create_info_ptr->get_mt_safety(),
                                                                                         in_create_info_ptr->get_device   () )),
      m_buffer                          (VK_NULL_HANDLE),
+     m_is_state_tracking_enabled       (false),
      m_memory_block_ptr                (nullptr),
      m_prefers_dedicated_allocation    (false),
      m_requires_dedicated_allocation   (false),
@@ -73,14 +86,17 @@ Anvil::Buffer::~Buffer()
     Anvil::ObjectTracker::get()->unregister_object(Anvil::ObjectType::BUFFER,
                                                    this);
 
+    /* Cached views must go away before the buffer they have been created for */
+    m_cached_views.clear();
+
     if (m_buffer                                   != VK_NULL_HANDLE &&
         m_create_info_ptr->get_parent_buffer_ptr() == nullptr)
     {
         lock();
         {
-            Anvil::Vulkan::vkDestroyBuffer(m_device_ptr->get_device_vk(),
-                                           m_buffer,
-                                           nullptr /* pAllocator */);
+            m_device_ptr->get_dispatch_table().vkDestroyBuffer(m_device_ptr->get_device_vk(),
+                                                               m_buffer,
+                                                               m_device_ptr->get_allocation_callbacks_vk() );
         }
         unlock();
 
@@ -146,6 +162,89 @@ VkBuffer Anvil::Buffer::get_buffer(const bool& in_bake_memory_if_necessary)
     return m_buffer;
 }
 
+/* Please see header for specification */
+VkDeviceAddress Anvil::Buffer::get_device_address()
+{
+    const Anvil::Buffer*         base_buffer_ptr = get_base_buffer();
+    VkBufferDeviceAddressInfoKHR info;
+    VkDeviceAddress              result          = 0;
+
+    anvil_assert((base_buffer_ptr->get_create_info_ptr()->get_usage_flags() & Anvil::BufferUsageFlagBits::SHADER_DEVICE_ADDRESS_BIT_KHR) != 0);
+
+    info.buffer = get_buffer();
+    info.pNext  = nullptr;
+    info.sType  = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO_KHR;
+
+    result = m_device_ptr->get_extension_khr_buffer_device_address_entrypoints().vkGetBufferDeviceAddressKHR(m_device_ptr->get_device_vk(),
+                                                                                                            &info);
+
+    if (base_buffer_ptr != this)
+    {
+        result += m_create_info_ptr->get_start_offset();
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::BufferView* Anvil::Buffer::get_cached_view(Anvil::Format in_format,
+                                                  VkDeviceSize  in_start_offset,
+                                                  VkDeviceSize  in_size)
+{
+    Anvil::BufferView* result_ptr = nullptr;
+    const uint64_t     words[]    =
+    {
+        static_cast<uint64_t>(in_format),
+        in_start_offset,
+        in_size
+    };
+    const uint64_t     hash       = Anvil::Utils::hash64(words,
+                                                         sizeof(words) );
+
+    lock();
+    {
+        auto& bucket = m_cached_views[hash];
+
+        for (const auto& current_view_ptr : bucket)
+        {
+            const auto current_create_info_ptr = current_view_ptr->get_create_info_ptr();
+
+            if (current_create_info_ptr->get_format      () == in_format       &&
+                current_create_info_ptr->get_size        () == in_size         &&
+                current_create_info_ptr->get_start_offset() == in_start_offset)
+            {
+                result_ptr = current_view_ptr.get();
+
+                break;
+            }
+        }
+
+        if (result_ptr == nullptr)
+        {
+            auto create_info_ptr = Anvil::BufferViewCreateInfo::create(m_device_ptr,
+                                                                       this,
+                                                                       in_format,
+                                                                       in_start_offset,
+                                                                       in_size);
+            auto new_view_ptr    = Anvil::BufferView::create(std::move(create_info_ptr) );
+
+            if (new_view_ptr != nullptr)
+            {
+                result_ptr = new_view_ptr.get();
+
+                bucket.push_back(std::move(new_view_ptr) );
+            }
+            else
+            {
+                anvil_assert(new_view_ptr != nullptr);
+            }
+        }
+    }
+    unlock();
+
+    return result_ptr;
+}
+
 /* Please see header for specification */
 Anvil::MemoryBlock* Anvil::Buffer::get_memory_block(uint32_t in_n_memory_block)
 {
@@ -203,6 +302,23 @@ VkMemoryRequirements Anvil::Buffer::get_memory_requirements() const
     }
 }
 
+/** Please see header for specification */
+uint32_t Anvil::Buffer::get_n_cached_views() const
+{
+    uint32_t result = 0;
+
+    lock();
+    {
+        for (const auto& current_bucket : m_cached_views)
+        {
+            result += static_cast<uint32_t>(current_bucket.second.size() );
+        }
+    }
+    unlock();
+
+    return result;
+}
+
 uint32_t Anvil::Buffer::get_n_memory_blocks() const
 {
     const auto& create_flags = get_create_info_ptr()->get_create_flags();
@@ -219,71 +335,91 @@ uint32_t Anvil::Buffer::get_n_memory_blocks() const
     }
 }
 
-bool Anvil::Buffer::init()
+/** Creates a new Vulkan buffer handle, using the properties specified at creation time.
+ *
+ *  @param out_buffer_ptr Deref will be set to the new handle if successful. Must not be null.
+ *
+ *  @return Result of the vkCreateBuffer() call.
+ */
+VkResult Anvil::Buffer::create_buffer_vk(VkBuffer* out_buffer_ptr) const
 {
     uint32_t                                 n_queue_family_indices;
-    uint32_t                                 queue_family_indices   [8];
-    VkResult                                 result                  (VK_ERROR_INITIALIZATION_FAILED);
+    uint32_t                                 queue_family_indices[8];
+    VkResult                                 result                 (VK_ERROR_INITIALIZATION_FAILED);
     Anvil::StructChainer<VkBufferCreateInfo> struct_chainer;
-    bool                                     use_dedicated_allocation(false);
 
-    if ( m_create_info_ptr->get_client_data    ()                                               != nullptr &&
-        (m_create_info_ptr->get_memory_features() & Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT) == 0)
+    /* Determine which queues the buffer should be available to. */
+    Anvil::Utils::convert_queue_family_bits_to_family_indices(m_device_ptr,
+                                                              m_create_info_ptr->get_queue_families(),
+                                                              queue_family_indices,
+                                                             &n_queue_family_indices);
+
+    anvil_assert(n_queue_family_indices > 0);
+    anvil_assert(n_queue_family_indices < sizeof(queue_family_indices) / sizeof(queue_family_indices[0]) );
+
+    /* Prepare the create info structure */
     {
-        m_create_info_ptr->set_usage_flags(m_create_info_ptr->get_usage_flags() | Anvil::BufferUsageFlagBits::TRANSFER_DST_BIT);
+        VkBufferCreateInfo buffer_create_info;
+
+        buffer_create_info.flags                 = m_create_info_ptr->get_create_flags().get_vk();
+        buffer_create_info.pNext                 = nullptr;
+        buffer_create_info.pQueueFamilyIndices   = queue_family_indices;
+        buffer_create_info.queueFamilyIndexCount = n_queue_family_indices;
+        buffer_create_info.sharingMode           = static_cast<VkSharingMode>(m_create_info_ptr->get_sharing_mode() );
+        buffer_create_info.size                  = m_create_info_ptr->get_size();
+        buffer_create_info.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        buffer_create_info.usage                 = m_create_info_ptr->get_usage_flags().get_vk();
+
+        struct_chainer.append_struct(buffer_create_info);
     }
 
-    if (m_create_info_ptr->get_type() != BufferType::NO_ALLOC_CHILD)
     {
-        /* Determine which queues the buffer should be available to. */
-        Anvil::Utils::convert_queue_family_bits_to_family_indices(m_device_ptr,
-                                                                  m_create_info_ptr->get_queue_families(),
-                                                                  queue_family_indices,
-                                                                 &n_queue_family_indices);
-
-        anvil_assert(n_queue_family_indices > 0);
-        anvil_assert(n_queue_family_indices < sizeof(queue_family_indices) / sizeof(queue_family_indices[0]) );
+        const auto& external_memory_handle_types = m_create_info_ptr->get_exportable_external_memory_handle_types();
 
-        /* Prepare the create info structure */
+        if (external_memory_handle_types != 0)
         {
-            VkBufferCreateInfo buffer_create_info;
+            VkExternalMemoryBufferCreateInfoKHR external_memory_buffer_create_info;
 
-            buffer_create_info.flags                 = m_create_info_ptr->get_create_flags().get_vk();
-            buffer_create_info.pNext                 = nullptr;
-            buffer_create_info.pQueueFamilyIndices   = queue_family_indices;
-            buffer_create_info.queueFamilyIndexCount = n_queue_family_indices;
-            buffer_create_info.sharingMode           = static_cast<VkSharingMode>(m_create_info_ptr->get_sharing_mode() );
-            buffer_create_info.size                  = m_create_info_ptr->get_size();
-            buffer_create_info.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            buffer_create_info.usage                 = m_create_info_ptr->get_usage_flags().get_vk();
+            external_memory_buffer_create_info.handleTypes = external_memory_handle_types.get_vk();
+            external_memory_buffer_create_info.pNext       = nullptr;
+            external_memory_buffer_create_info.sType       = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO_KHR;
 
-            struct_chainer.append_struct(buffer_create_info);
+            struct_chainer.append_struct(external_memory_buffer_create_info);
         }
+    }
 
-        {
-            const auto& external_memory_handle_types = m_create_info_ptr->get_exportable_external_memory_handle_types();
+    /* Create the buffer object */
+    {
+        auto struct_chain_ptr = struct_chainer.create_chain();
 
-            if (external_memory_handle_types != 0)
-            {
-                VkExternalMemoryBufferCreateInfoKHR external_memory_buffer_create_info;
+        result = m_device_ptr->get_dispatch_table().vkCreateBuffer(m_device_ptr->get_device_vk(),
+                                                                   struct_chain_ptr->get_root_struct(),
+                                                                   m_device_ptr->get_allocation_callbacks_vk(),
+                                                                   out_buffer_ptr);
+    }
 
-                external_memory_buffer_create_info.handleTypes = external_memory_handle_types.get_vk();
-                external_memory_buffer_create_info.pNext       = nullptr;
-                external_memory_buffer_create_info.sType       = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO_KHR;
+    if (is_vk_call_successful(result) )
+    {
+        Anvil::PerfCounters::increment(Anvil::PerfCounters::Counter::BUFFERS_CREATED);
+    }
 
-                struct_chainer.append_struct(external_memory_buffer_create_info);
-            }
-        }
+    return result;
+}
 
-        /* Create the buffer object */
-        {
-            auto struct_chain_ptr = struct_chainer.create_chain();
+bool Anvil::Buffer::init()
+{
+    VkResult result                  (VK_ERROR_INITIALIZATION_FAILED);
+    bool     use_dedicated_allocation(false);
 
-            result = Anvil::Vulkan::vkCreateBuffer(m_device_ptr->get_device_vk(),
-                                                   struct_chain_ptr->get_root_struct(),
-                                                   nullptr, /* pAllocator */
-                                                  &m_buffer);
-        }
+    if ( m_create_info_ptr->get_client_data    ()                                               != nullptr &&
+        (m_create_info_ptr->get_memory_features() & Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT) == 0)
+    {
+        m_create_info_ptr->set_usage_flags(m_create_info_ptr->get_usage_flags() | Anvil::BufferUsageFlagBits::TRANSFER_DST_BIT);
+    }
+
+    if (m_create_info_ptr->get_type() != BufferType::NO_ALLOC_CHILD)
+    {
+        result = create_buffer_vk(&m_buffer);
 
         anvil_assert_vk_call_succeeded(result);
         if (is_vk_call_successful(result) )
@@ -353,9 +489,9 @@ bool Anvil::Buffer::init()
             }
             else
             {
-                Anvil::Vulkan::vkGetBufferMemoryRequirements(m_device_ptr->get_device_vk(),
-                                                             m_buffer,
-                                                            &m_buffer_memory_reqs);
+                m_device_ptr->get_dispatch_table().vkGetBufferMemoryRequirements(m_device_ptr->get_device_vk(),
+                                                                                 m_buffer,
+                                                                                &m_buffer_memory_reqs);
             }
         }
     }
@@ -479,17 +615,21 @@ end:
     return is_vk_call_successful(result);
 }
 
-/* TODO */
-bool Anvil::Buffer::init_staging_buffer(const VkDeviceSize& in_size,
-                                        Anvil::Queue*       in_opt_queue_ptr)
+/** Determines which queue should be used to transfer data between the buffer and a staging buffer.
+ *
+ *  @param in_opt_queue_ptr       Queue to use if the buffer has been created with exclusive sharing mode
+ *                                and is compatible with more than one queue family type. May be null otherwise.
+ *  @param out_queue_fam_bits_ptr Deref will be set to the queue family type of the returned queue. Must not be null.
+ *
+ *  @return As per description.
+ **/
+Anvil::Queue* Anvil::Buffer::get_staging_queue(Anvil::Queue*               in_opt_queue_ptr,
+                                               Anvil::QueueFamilyFlagBits* out_queue_fam_bits_ptr) const
 {
-    Anvil::PrimaryCommandBufferUniquePtr      copy_cmdbuf_ptr;
-    std::vector<const Anvil::PhysicalDevice*> helper_vec;
-    const auto                                queue_fams                    = m_create_info_ptr->get_queue_families();
-    Anvil::QueueFamilyFlagBits                staging_buffer_queue_fam_bits = Anvil::QueueFamilyFlagBits::NONE;
+    const auto    queue_fams = m_create_info_ptr->get_queue_families();
+    Anvil::Queue* result_ptr = nullptr;
 
-    m_staging_buffer_ptr.reset();
-    m_staging_buffer_queue_ptr = nullptr;
+    *out_queue_fam_bits_ptr = Anvil::QueueFamilyFlagBits::NONE;
 
     if (m_create_info_ptr->get_sharing_mode() == Anvil::SharingMode::EXCLUSIVE)
     {
@@ -501,9 +641,9 @@ bool Anvil::Buffer::init_staging_buffer(const VkDeviceSize& in_size,
         {
             switch (queue_fams.get_vk() )
             {
-                case static_cast<uint32_t>(Anvil::QueueFamilyFlagBits::COMPUTE_BIT):  m_staging_buffer_queue_ptr = m_device_ptr->get_compute_queue  (0); break;
-                case static_cast<uint32_t>(Anvil::QueueFamilyFlagBits::DMA_BIT):      m_staging_buffer_queue_ptr = m_device_ptr->get_transfer_queue (0); break;
-                case static_cast<uint32_t>(Anvil::QueueFamilyFlagBits::GRAPHICS_BIT): m_staging_buffer_queue_ptr = m_device_ptr->get_universal_queue(0); break;
+                case static_cast<uint32_t>(Anvil::QueueFamilyFlagBits::COMPUTE_BIT):  result_ptr = m_device_ptr->get_compute_queue  (0); break;
+                case static_cast<uint32_t>(Anvil::QueueFamilyFlagBits::DMA_BIT):      result_ptr = m_device_ptr->get_transfer_queue (0); break;
+                case static_cast<uint32_t>(Anvil::QueueFamilyFlagBits::GRAPHICS_BIT): result_ptr = m_device_ptr->get_universal_queue(0); break;
 
                 default:
                 {
@@ -515,16 +655,16 @@ bool Anvil::Buffer::init_staging_buffer(const VkDeviceSize& in_size,
         {
             anvil_assert(in_opt_queue_ptr != nullptr);
 
-            m_staging_buffer_queue_ptr = in_opt_queue_ptr;
+            result_ptr = in_opt_queue_ptr;
         }
 
-        anvil_assert(m_staging_buffer_queue_ptr != nullptr);
+        anvil_assert(result_ptr != nullptr);
 
-        switch (m_device_ptr->get_queue_family_type(m_staging_buffer_queue_ptr->get_queue_family_index() ) )
+        switch (m_device_ptr->get_queue_family_type(result_ptr->get_queue_family_index() ) )
         {
-            case Anvil::QueueFamilyType::COMPUTE:   staging_buffer_queue_fam_bits = Anvil::QueueFamilyFlagBits::COMPUTE_BIT;  break;
-            case Anvil::QueueFamilyType::TRANSFER:  staging_buffer_queue_fam_bits = Anvil::QueueFamilyFlagBits::DMA_BIT;      break;
-            case Anvil::QueueFamilyType::UNIVERSAL: staging_buffer_queue_fam_bits = Anvil::QueueFamilyFlagBits::GRAPHICS_BIT; break;
+            case Anvil::QueueFamilyType::COMPUTE:   *out_queue_fam_bits_ptr = Anvil::QueueFamilyFlagBits::COMPUTE_BIT;  break;
+            case Anvil::QueueFamilyType::TRANSFER:  *out_queue_fam_bits_ptr = Anvil::QueueFamilyFlagBits::DMA_BIT;      break;
+            case Anvil::QueueFamilyType::UNIVERSAL: *out_queue_fam_bits_ptr = Anvil::QueueFamilyFlagBits::GRAPHICS_BIT; break;
 
             default:
             {
@@ -537,24 +677,38 @@ bool Anvil::Buffer::init_staging_buffer(const VkDeviceSize& in_size,
         /* We can use any queue from the list of queue fams this buffer is compatible with, in order to perform the copy op. */
         if ((queue_fams & Anvil::QueueFamilyFlagBits::GRAPHICS_BIT) != 0)
         {
-            m_staging_buffer_queue_ptr    = m_device_ptr->get_universal_queue(0);
-            staging_buffer_queue_fam_bits = Anvil::QueueFamilyFlagBits::GRAPHICS_BIT;
+            result_ptr              = m_device_ptr->get_universal_queue(0);
+            *out_queue_fam_bits_ptr = Anvil::QueueFamilyFlagBits::GRAPHICS_BIT;
         }
         else
         if ((queue_fams & Anvil::QueueFamilyFlagBits::DMA_BIT) != 0)
         {
-            m_staging_buffer_queue_ptr    = m_device_ptr->get_transfer_queue(0);
-            staging_buffer_queue_fam_bits = Anvil::QueueFamilyFlagBits::DMA_BIT;
+            result_ptr              = m_device_ptr->get_transfer_queue(0);
+            *out_queue_fam_bits_ptr = Anvil::QueueFamilyFlagBits::DMA_BIT;
         }
         else
         {
             anvil_assert((queue_fams & Anvil::QueueFamilyFlagBits::COMPUTE_BIT) != 0)
 
-            m_staging_buffer_queue_ptr    = m_device_ptr->get_compute_queue(0);
-            staging_buffer_queue_fam_bits = Anvil::QueueFamilyFlagBits::COMPUTE_BIT;
+            result_ptr              = m_device_ptr->get_compute_queue(0);
+            *out_queue_fam_bits_ptr = Anvil::QueueFamilyFlagBits::COMPUTE_BIT;
         }
     }
 
+    return result_ptr;
+}
+
+/* TODO */
+bool Anvil::Buffer::init_staging_buffer(const VkDeviceSize& in_size,
+                                        Anvil::Queue*       in_opt_queue_ptr)
+{
+    Anvil::QueueFamilyFlagBits staging_buffer_queue_fam_bits = Anvil::QueueFamilyFlagBits::NONE;
+
+    m_staging_buffer_ptr.reset();
+
+    m_staging_buffer_queue_ptr = get_staging_queue(in_opt_queue_ptr,
+                                                  &staging_buffer_queue_fam_bits);
+
     if (m_staging_buffer_ptr == nullptr                                   ||
         m_staging_buffer_ptr->get_create_info_ptr()->get_size() < in_size)
     {
@@ -584,6 +738,98 @@ bool Anvil::Buffer::init_staging_buffer(const VkDeviceSize& in_size,
     return (m_staging_buffer_ptr != nullptr);
 }
 
+/** Re-creates the Vulkan buffer handle and binds it to the new location of the buffer's memory block.
+ *
+ *  Vulkan does not allow to re-bind a buffer to a different memory region. This function is called by
+ *  MemoryAllocator::defragment() after the memory block has been updated to point at the region its data
+ *  has been moved to. Issues a BUFFER_CALLBACK_ID_MEMORY_MOVED call-back if successful.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::Buffer::on_memory_moved()
+{
+    VkBuffer             new_buffer     (VK_NULL_HANDLE);
+    VkMemoryRequirements new_memory_reqs;
+    const VkBuffer       old_buffer     (m_buffer);
+    bool                 result         (false);
+    VkResult             result_vk      (VK_ERROR_INITIALIZATION_FAILED);
+
+    anvil_assert(m_create_info_ptr->get_parent_buffer_ptr() == nullptr);
+    anvil_assert(m_memory_block_ptr                         != nullptr);
+
+    result_vk = create_buffer_vk(&new_buffer);
+
+    if (!is_vk_call_successful(result_vk) )
+    {
+        anvil_assert_vk_call_succeeded(result_vk);
+
+        goto end;
+    }
+
+    /* The new handle must be happy with the memory region which has been allocated for the original one. */
+    m_device_ptr->get_dispatch_table().vkGetBufferMemoryRequirements(m_device_ptr->get_device_vk(),
+                                                                     new_buffer,
+                                                                    &new_memory_reqs);
+
+    if (new_memory_reqs.size                                              >  m_buffer_memory_reqs.size ||
+        (m_memory_block_ptr->get_start_offset() % new_memory_reqs.alignment) != 0)
+    {
+        anvil_assert_fail();
+
+        m_device_ptr->get_dispatch_table().vkDestroyBuffer(m_device_ptr->get_device_vk(),
+                                                           new_buffer,
+                                                           m_device_ptr->get_allocation_callbacks_vk() );
+
+        goto end;
+    }
+
+    lock();
+    {
+        result_vk = m_device_ptr->get_dispatch_table().vkBindBufferMemory(m_device_ptr->get_device_vk(),
+                                                                          new_buffer,
+                                                                          m_memory_block_ptr->get_memory      (),
+                                                                          m_memory_block_ptr->get_start_offset() );
+
+        if (is_vk_call_successful(result_vk) )
+        {
+            m_device_ptr->get_dispatch_table().vkDestroyBuffer(m_device_ptr->get_device_vk(),
+                                                               old_buffer,
+                                                               m_device_ptr->get_allocation_callbacks_vk() );
+
+            m_buffer = new_buffer;
+        }
+        else
+        {
+            m_device_ptr->get_dispatch_table().vkDestroyBuffer(m_device_ptr->get_device_vk(),
+                                                               new_buffer,
+                                                               m_device_ptr->get_allocation_callbacks_vk() );
+        }
+    }
+    unlock();
+
+    if (!is_vk_call_successful(result_vk) )
+    {
+        anvil_assert_vk_call_succeeded(result_vk);
+
+        goto end;
+    }
+
+    set_vk_handle(m_buffer);
+
+    /* Let the users know they need to update all references to the old handle */
+    {
+        OnBufferMemoryMovedCallbackArgument callback_arg(this,
+                                                         old_buffer);
+
+        callback(BUFFER_CALLBACK_ID_MEMORY_MOVED,
+                &callback_arg);
+    }
+
+    result = true;
+end:
+    return result;
+}
+
 /* Please see header for specification */
 bool Anvil::Buffer::read(VkDeviceSize in_start_offset,
                          VkDeviceSize in_size,
@@ -602,18 +848,22 @@ bool Anvil::Buffer::read(VkDeviceSize in_start_offset,
                          void*        out_result_ptr)
 {
     const Anvil::DeviceType device_type      (m_device_ptr->get_type() );
-    auto                    memory_block_ptr (get_memory_block(0 /* in_n_memory_block */) );
+    Anvil::MemoryBlock*     memory_block_ptr (nullptr);
     bool                    result           (false);
 
-    /* TODO: Complete support for sparsely-bound & sparse-resident buffers */
-    anvil_assert((m_create_info_ptr->get_create_flags() & Anvil::BufferCreateFlagBits::SPARSE_RESIDENCY_BIT) == 0);
-
-    if ((m_create_info_ptr->get_create_flags() & Anvil::BufferCreateFlagBits::SPARSE_BINDING_BIT) != 0)
+    if (requires_resident_range_transfers() )
     {
-        anvil_assert(m_page_tracker_ptr->get_n_memory_blocks            () == 1);
-        anvil_assert(m_page_tracker_ptr->get_n_pages_with_memory_backing() == m_page_tracker_ptr->get_n_pages() );
+        result = transfer_via_staging_window(in_start_offset,
+                                             in_size,
+                                             in_device_mask,
+                                             nullptr, /* in_opt_queue_ptr */
+                                             nullptr, /* in_opt_data_ptr  */
+                                             out_result_ptr);
+
+        goto end;
     }
 
+    memory_block_ptr = get_memory_block(0 /* in_n_memory_block */);
 
     if ((memory_block_ptr->get_create_info_ptr()->get_memory_features() & Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT) != 0)
     {
@@ -623,36 +873,83 @@ bool Anvil::Buffer::read(VkDeviceSize in_start_offset,
     }
     else
     {
-        /* The buffer memory is not mappable. We need to create a staging buffer,
-         * do a non-mappable->mappable memory copy, and then read back data from the mappable buffer. */
+        /* The buffer memory is not mappable. We need to use a staging buffer, do a non-mappable->mappable
+         * memory copy, and then read back data from the mappable buffer.
+         *
+         * If the device-wide staging ring is available and can accommodate the request, use a region of it.
+         * Otherwise, fall back to a staging buffer owned by this instance. */
         Anvil::PrimaryCommandBufferUniquePtr copy_cmdbuf_ptr;
+        Anvil::StagingRing::Allocation       staging_allocation;
+        Anvil::Buffer*                       staging_buffer_ptr    (nullptr);
+        VkDeviceSize                         staging_buffer_offset (0);
+        Anvil::Queue*                        staging_queue_ptr     (nullptr);
+        Anvil::StagingRing*                  staging_ring_ptr      ( (device_type == Anvil::DeviceType::SINGLE_GPU) ? m_device_ptr->get_staging_ring()
+                                                                                                                    : nullptr);
+        bool                                 staging_ring_submitted(false);
+        bool                                 uses_staging_ring     (false);
+
+        if (staging_ring_ptr != nullptr)
+        {
+            uses_staging_ring = staging_ring_ptr->allocate(in_size,
+                                                           m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits.optimal_buffer_copy_offset_alignment,
+                                                          &staging_allocation);
+        }
+
+        if (uses_staging_ring)
+        {
+            Anvil::QueueFamilyFlagBits staging_queue_fam_bits;
 
-        if (m_staging_buffer_ptr                                    == nullptr ||
-            m_staging_buffer_ptr->get_create_info_ptr()->get_size() <  in_size)
+            staging_buffer_offset = staging_allocation.offset;
+            staging_buffer_ptr    = staging_allocation.buffer_ptr;
+            staging_queue_ptr     = get_staging_queue(nullptr, /* in_opt_queue_ptr */
+                                                     &staging_queue_fam_bits);
+        }
+        else
         {
-            if (!init_staging_buffer(in_size,
-                                     nullptr) ) /* in_opt_queue_ptr */
+            if (in_size > g_n_staging_window_chunks * g_staging_window_chunk_size)
             {
-                result = false;
+                result = transfer_via_staging_window(in_start_offset,
+                                                     in_size,
+                                                     in_device_mask,
+                                                     nullptr, /* in_opt_queue_ptr */
+                                                     nullptr, /* in_opt_data_ptr  */
+                                                     out_result_ptr);
 
                 goto end;
             }
-        }
 
-        if (m_staging_buffer_ptr == nullptr)
-        {
-            anvil_assert(m_staging_buffer_ptr != nullptr);
+            if (m_staging_buffer_ptr                                    == nullptr ||
+                m_staging_buffer_ptr->get_create_info_ptr()->get_size() <  in_size)
+            {
+                if (!init_staging_buffer(in_size,
+                                         nullptr) ) /* in_opt_queue_ptr */
+                {
+                    result = false;
 
-            goto end;
+                    goto end;
+                }
+            }
+
+            if (m_staging_buffer_ptr == nullptr)
+            {
+                anvil_assert(m_staging_buffer_ptr != nullptr);
+
+                goto end;
+            }
+
+            staging_buffer_ptr = m_staging_buffer_ptr.get();
+            staging_queue_ptr  = m_staging_buffer_queue_ptr;
         }
 
-        copy_cmdbuf_ptr = m_device_ptr->get_command_pool_for_queue_family_index(m_staging_buffer_queue_ptr->get_queue_family_index() )->alloc_primary_level_command_buffer();
+        /* The copy is always submitted in a blocking manner, so the command buffer can come from the calling thread's
+         * pool. It must not be handed over to the staging ring, as the ring may release it on a different thread. */
+        copy_cmdbuf_ptr = m_device_ptr->get_thread_command_pool_for_queue_family_index(staging_queue_ptr->get_queue_family_index() )->alloc_primary_level_command_buffer();
 
         if (copy_cmdbuf_ptr == nullptr)
         {
             anvil_assert(copy_cmdbuf_ptr != nullptr);
 
-            goto end;
+            goto end_staging;
 
         }
         if (device_type == Anvil::DeviceType::SINGLE_GPU)
@@ -674,14 +971,14 @@ bool Anvil::Buffer::read(VkDeviceSize in_start_offset,
                                                 Anvil::AccessFlagBits::HOST_READ_BIT,
                                                 VK_QUEUE_FAMILY_IGNORED,
                                                 VK_QUEUE_FAMILY_IGNORED,
-                                                m_staging_buffer_ptr.get(),
-                                                0, /* in_offset */
+                                                staging_buffer_ptr,
+                                                staging_buffer_offset,
                                                 in_size);
             Anvil::BufferCopy    copy_region;
             Anvil::MemoryBarrier pre_copy_barrier(Anvil::AccessFlagBits::TRANSFER_READ_BIT, /* in_destination_access_mask */
                                                   Anvil::AccessFlagBits::HOST_WRITE_BIT | Anvil::AccessFlagBits::MEMORY_WRITE_BIT | Anvil::AccessFlagBits::SHADER_WRITE_BIT | Anvil::AccessFlagBits::TRANSFER_WRITE_BIT);
 
-            copy_region.dst_offset = 0;
+            copy_region.dst_offset = staging_buffer_offset;
             copy_region.size       = in_size;
             copy_region.src_offset = in_start_offset;
 
@@ -696,7 +993,7 @@ bool Anvil::Buffer::read(VkDeviceSize in_start_offset,
                                                      nullptr); /* in_iamge_memory_barriers_ptr   */
 
             copy_cmdbuf_ptr->record_copy_buffer     (this,
-                                                     m_staging_buffer_ptr.get(),
+                                                     staging_buffer_ptr,
                                                      1, /* in_region_count */
                                                     &copy_region);
             copy_cmdbuf_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TRANSFER_BIT,
@@ -713,9 +1010,10 @@ bool Anvil::Buffer::read(VkDeviceSize in_start_offset,
 
         if (device_type == Anvil::DeviceType::SINGLE_GPU)
         {
-            m_staging_buffer_queue_ptr->submit(
+            staging_queue_ptr->submit(
                 Anvil::SubmitInfo::create_execute(copy_cmdbuf_ptr.get(),
-                                                  true /* should_block */)
+                                                  true, /* should_block */
+                                                  staging_allocation.fence_ptr)
             );
         }
         else
@@ -727,22 +1025,42 @@ bool Anvil::Buffer::read(VkDeviceSize in_start_offset,
             cmd_buffer_submission.cmd_buffer_ptr = copy_cmdbuf_ptr.get();
             cmd_buffer_submission.device_mask    = in_device_mask;
 
-            m_staging_buffer_queue_ptr->submit(
+            staging_queue_ptr->submit(
                 Anvil::SubmitInfo::create_execute(&cmd_buffer_submission,
                                                   1, /* in_n_command_buffer_submissions */
                                                   true /* should_block */)
             );
         }
 
-        result = m_staging_buffer_ptr->read(0,
-                                            in_size,
-                                            out_result_ptr);
+        staging_ring_submitted = uses_staging_ring;
+
+        result = staging_buffer_ptr->read(staging_buffer_offset,
+                                          in_size,
+                                          out_result_ptr);
+
+end_staging:
+        if (uses_staging_ring)
+        {
+            staging_ring_ptr->release(staging_allocation,
+                                      staging_ring_submitted);
+        }
     }
 
 end:
     return result;
 }
 
+/** Tells whether transfers to and from the buffer need to be split into runs of resident pages. This is the case
+ *  for sparse buffers, unless a single memory block backs all their pages, in which case the block can be accessed
+ *  directly.
+ **/
+bool Anvil::Buffer::requires_resident_range_transfers() const
+{
+    return (m_page_tracker_ptr                                    != nullptr) &&
+           (m_page_tracker_ptr->get_n_memory_blocks            () != 1                                  ||
+            m_page_tracker_ptr->get_n_pages_with_memory_backing() != m_page_tracker_ptr->get_n_pages() );
+}
+
 bool Anvil::Buffer::set_memory_nonsparse_internal(MemoryBlockUniquePtr  in_memory_block_ptr,
                                                   uint32_t              in_n_device_group_indices,
                                                   const uint32_t*       in_device_group_indices_ptr)
@@ -779,10 +1097,10 @@ bool Anvil::Buffer::set_memory_nonsparse_internal(MemoryBlockUniquePtr  in_memor
     {
         lock();
         {
-            result_vk = Anvil::Vulkan::vkBindBufferMemory(m_device_ptr->get_device_vk(),
-                                                          m_buffer,
-                                                          in_memory_block_ptr->get_memory      (),
-                                                          in_memory_block_ptr->get_start_offset() );
+            result_vk = m_device_ptr->get_dispatch_table().vkBindBufferMemory(m_device_ptr->get_device_vk(),
+                                                                              m_buffer,
+                                                                              in_memory_block_ptr->get_memory      (),
+                                                                              in_memory_block_ptr->get_start_offset() );
         }
         unlock();
     }
@@ -965,23 +1283,11 @@ bool Anvil::Buffer::set_nonsparse_memory_multi(uint32_t                   in_n_b
         goto end;
     }
 
-    /* Convert input structure into VkBindBufferMemoryInfoKHR structures */
     for (uint32_t n_update = 0;
                   n_update < in_n_buffer_memory_binding_updates;
                 ++n_update)
     {
-        const auto&              current_update (in_updates_ptr[n_update]);
-        const Anvil::MGPUDevice* mgpu_device_ptr(dynamic_cast<const Anvil::MGPUDevice*>(current_update.buffer_ptr->m_device_ptr) );
-
-        if (current_update.physical_devices.size() != mgpu_device_ptr->get_n_physical_devices() )
-        {
-            anvil_assert(current_update.physical_devices.size() == mgpu_device_ptr->get_n_physical_devices() ||
-                         current_update.physical_devices.size() == 0);
-
-            goto end;
-        }
-
-        n_total_physical_devices += static_cast<uint32_t>(current_update.physical_devices.size() );
+        const auto& current_update(in_updates_ptr[n_update]);
 
         if (n_update == 0)
         {
@@ -991,6 +1297,29 @@ bool Anvil::Buffer::set_nonsparse_memory_multi(uint32_t                   in_n_b
         {
             anvil_assert(device_ptr == current_update.buffer_ptr->m_device_ptr);
         }
+
+        if (current_update.buffer_ptr->m_memory_block_ptr != nullptr)
+        {
+            anvil_assert(current_update.buffer_ptr->m_memory_block_ptr == nullptr);
+
+            goto end;
+        }
+
+        if (current_update.physical_devices.size() > 0)
+        {
+            const Anvil::MGPUDevice* mgpu_device_ptr(dynamic_cast<const Anvil::MGPUDevice*>(current_update.buffer_ptr->m_device_ptr) );
+
+            if (mgpu_device_ptr                        == nullptr                                   ||
+                current_update.physical_devices.size() != mgpu_device_ptr->get_n_physical_devices() )
+            {
+                anvil_assert(mgpu_device_ptr                        != nullptr                                   &&
+                             current_update.physical_devices.size() == mgpu_device_ptr->get_n_physical_devices() );
+
+                goto end;
+            }
+        }
+
+        n_total_physical_devices += static_cast<uint32_t>(current_update.physical_devices.size() );
     }
 
     {
@@ -1020,13 +1349,8 @@ bool Anvil::Buffer::set_nonsparse_memory_multi(uint32_t                   in_n_b
                     ++n_update)
         {
             VkBindBufferMemoryInfoKHR                current_bind_info;
-            VkBindBufferMemoryDeviceGroupInfoKHR     current_bind_info_device_group;
             StructChainer<VkBindBufferMemoryInfoKHR> current_bind_info_chain;
-            const auto&                              current_update                      = in_updates_ptr[n_update];
-
-            current_bind_info_device_group.sType            = VK_STRUCTURE_TYPE_BIND_BUFFER_MEMORY_INFO_KHR;
-            current_bind_info_device_group.deviceIndexCount = static_cast<uint32_t>(current_update.physical_devices.size());
-            current_bind_info_device_group.pDeviceIndices   = &device_indices.at(n_current_physical_device);
+            const auto&                              current_update = in_updates_ptr[n_update];
 
             current_bind_info.buffer        = current_update.buffer_ptr->get_buffer            ();
             current_bind_info.memory        = current_update.memory_block_ptr->get_memory      ();
@@ -1035,16 +1359,51 @@ bool Anvil::Buffer::set_nonsparse_memory_multi(uint32_t                   in_n_b
             current_bind_info.sType         = VK_STRUCTURE_TYPE_BIND_BUFFER_MEMORY_INFO_KHR;
 
             current_bind_info_chain.append_struct(current_bind_info);
-            current_bind_info_chain.append_struct(current_bind_info_device_group);
+
+            /* Device group info is only needed if the caller has specified device indices. Otherwise, the default
+             * device indices are used. */
+            if (current_update.physical_devices.size() > 0)
+            {
+                VkBindBufferMemoryDeviceGroupInfoKHR current_bind_info_device_group;
+
+                current_bind_info_device_group.deviceIndexCount = static_cast<uint32_t>(current_update.physical_devices.size());
+                current_bind_info_device_group.pDeviceIndices   = &device_indices.at(n_current_physical_device);
+                current_bind_info_device_group.pNext            = nullptr;
+                current_bind_info_device_group.sType            = VK_STRUCTURE_TYPE_BIND_BUFFER_MEMORY_DEVICE_GROUP_INFO_KHR;
+
+                current_bind_info_chain.append_struct(current_bind_info_device_group);
+            }
 
             bind_info_struct_chains.append_struct_chain(current_bind_info_chain.create_chain() );
 
             n_current_physical_device += static_cast<uint32_t>(current_update.physical_devices.size());
         }
 
-        result_vk = entrypoints.vkBindBufferMemory2KHR(device_ptr->get_device_vk(),
-                                                       in_n_buffer_memory_binding_updates,
-                                                       bind_info_struct_chains.get_root_structs() );
+        if (entrypoints.vkBindBufferMemory2KHR != nullptr)
+        {
+            result_vk = entrypoints.vkBindBufferMemory2KHR(device_ptr->get_device_vk(),
+                                                           in_n_buffer_memory_binding_updates,
+                                                           bind_info_struct_chains.get_root_structs() );
+        }
+        else
+        {
+            /* VK_KHR_bind_memory2 is unavailable. Fall back to one vkBindBufferMemory() call per buffer. */
+            const VkBindBufferMemoryInfoKHR* bind_infos_ptr = bind_info_struct_chains.get_root_structs();
+
+            anvil_assert(n_total_physical_devices == 0);
+
+            result_vk = VK_SUCCESS;
+
+            for (uint32_t n_update = 0;
+                          n_update < in_n_buffer_memory_binding_updates && is_vk_call_successful(result_vk);
+                        ++n_update)
+            {
+                result_vk = device_ptr->get_dispatch_table().vkBindBufferMemory(device_ptr->get_device_vk(),
+                                                                                bind_infos_ptr[n_update].buffer,
+                                                                                bind_infos_ptr[n_update].memory,
+                                                                                bind_infos_ptr[n_update].memoryOffset);
+            }
+        }
 
         if (!is_vk_call_successful(result_vk) )
         {
@@ -1059,8 +1418,6 @@ bool Anvil::Buffer::set_nonsparse_memory_multi(uint32_t                   in_n_b
         {
             auto& current_update = in_updates_ptr[n_update];
 
-            anvil_assert(current_update.buffer_ptr->m_memory_block_ptr == nullptr);
-
             anvil_assert(std::find_if(current_update.buffer_ptr->m_owned_memory_blocks.begin(),
                                       current_update.buffer_ptr->m_owned_memory_blocks.end  (),
                                       [=](const MemoryBlockUniquePtr& in_memory_block_ptr)
@@ -1090,6 +1447,368 @@ end:
     return result;
 }
 
+/** Copies data between the host and a buffer backed by non-mappable memory, in chunks going through a bounded,
+ *  double-buffered staging window. The host-side copy of one chunk overlaps with the GPU copy of the previous one.
+ *
+ *  Used for transfers which do not fit in the staging window, and for all transfers to and from sparse buffers
+ *  which are not backed by a single memory block in their entirety. For the latter, only page runs which have
+ *  memory backing are transferred, using a single batched copy command per chunk. Writes to the remaining pages
+ *  are dropped, and reads return zeroes for them. Blocks until all copy ops finish.
+ *
+ *  @param in_start_offset  Start offset of the buffer region to update or read from.
+ *  @param in_size          Number of bytes to transfer.
+ *  @param in_device_mask   Device mask to use for multi-GPU devices. Ignored for single-GPU devices.
+ *  @param in_opt_queue_ptr Queue to use for the copy ops, as per Buffer::write().
+ *  @param in_opt_data_ptr  Data to upload. Must be null if @param out_opt_data_ptr is not null.
+ *  @param out_opt_data_ptr Deref will be filled with buffer contents. Must be null if @param in_opt_data_ptr is not null.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::Buffer::transfer_via_staging_window(VkDeviceSize  in_start_offset,
+                                                VkDeviceSize  in_size,
+                                                uint32_t      in_device_mask,
+                                                Anvil::Queue* in_opt_queue_ptr,
+                                                const void*   in_opt_data_ptr,
+                                                void*         out_opt_data_ptr)
+{
+    std::vector<Anvil::BufferCopy>                chunk_copy_regions[g_n_staging_window_chunks];
+    VkDeviceSize                                  chunk_data_offsets[g_n_staging_window_chunks];
+    Anvil::FenceUniquePtr                         chunk_fence_ptrs  [g_n_staging_window_chunks];
+    VkDeviceSize                                  chunk_sizes       [g_n_staging_window_chunks];
+    Anvil::PrimaryCommandBufferUniquePtr          copy_cmdbuf_ptrs  [g_n_staging_window_chunks];
+    const Anvil::DeviceType                       device_type       (m_device_ptr->get_type() );
+    uint32_t                                      device_mask       (in_device_mask);
+    const bool                                    is_read           (out_opt_data_ptr != nullptr);
+    const uint32_t                                n_chunks          (static_cast<uint32_t>( (in_size + g_staging_window_chunk_size - 1) / g_staging_window_chunk_size) );
+    uint32_t                                      n_first_range     (0);
+    std::vector<Anvil::PageTracker::ResidentRange> resident_ranges;
+    bool                                          result            (false);
+    Anvil::Buffer*                                staging_buffer_ptr(nullptr);
+    const VkDeviceSize                            window_size       (g_n_staging_window_chunks * g_staging_window_chunk_size);
+
+    anvil_assert((in_opt_data_ptr != nullptr) != (out_opt_data_ptr != nullptr) );
+
+    for (uint32_t n_slot = 0;
+                  n_slot < g_n_staging_window_chunks;
+                ++n_slot)
+    {
+        chunk_data_offsets[n_slot] = 0;
+        chunk_sizes       [n_slot] = 0;
+    }
+
+    /* Determine which parts of the region can actually be transferred. Non-sparse buffers are backed in their entirety. */
+    if (m_page_tracker_ptr != nullptr)
+    {
+        m_page_tracker_ptr->get_resident_ranges(in_start_offset,
+                                                in_size,
+                                               &resident_ranges);
+
+        if (is_read)
+        {
+            memset(out_opt_data_ptr,
+                   0,
+                   static_cast<size_t>(in_size) );
+        }
+
+        if (resident_ranges.empty() )
+        {
+            result = true;
+
+            goto end;
+        }
+    }
+    else
+    {
+        resident_ranges.push_back(Anvil::PageTracker::ResidentRange(in_start_offset,
+                                                                    in_size) );
+    }
+
+    if (m_staging_buffer_ptr                                    == nullptr ||
+        m_staging_buffer_ptr->get_create_info_ptr()->get_size() <  window_size)
+    {
+        if (!init_staging_buffer(window_size,
+                                 in_opt_queue_ptr) )
+        {
+            goto end;
+        }
+    }
+
+    staging_buffer_ptr = m_staging_buffer_ptr.get();
+
+    /* Writes need to update all memory instances. For sparse buffers, the first memory block bound is assumed
+     * to be representative of all the others. */
+    if (device_type == Anvil::DeviceType::MULTI_GPU &&
+        !is_read)
+    {
+        const auto memory_block_ptr = get_memory_block(0);
+
+        if ((memory_block_ptr->get_create_info_ptr()->get_memory_features() & Anvil::MemoryFeatureFlagBits::MULTI_INSTANCE_BIT) != 0)
+        {
+            const Anvil::MGPUDevice* mgpu_device_ptr = dynamic_cast<const Anvil::MGPUDevice*>(m_device_ptr);
+
+            device_mask = memory_block_ptr->get_create_info_ptr()->get_device_mask();
+
+            if (device_mask == 0)
+            {
+                device_mask = (1 << mgpu_device_ptr->get_n_physical_devices()) - 1;
+            }
+        }
+    }
+
+    for (uint32_t n_slot = 0;
+                  n_slot < g_n_staging_window_chunks;
+                ++n_slot)
+    {
+        chunk_fence_ptrs[n_slot] = Anvil::Fence::create(Anvil::FenceCreateInfo::create(m_device_ptr,
+                                                                                       false) ); /* in_create_signalled */
+
+        if (chunk_fence_ptrs[n_slot] == nullptr)
+        {
+            anvil_assert(chunk_fence_ptrs[n_slot] != nullptr);
+
+            goto end;
+        }
+    }
+
+    /* Chunk N uses slot (N % g_n_staging_window_chunks) of the staging buffer. Before a slot is reused, the copy op which
+     * last used it needs to retire and, for reads, the data it brought in is handed over to the caller. The last
+     * g_n_staging_window_chunks iterations only retire the outstanding chunks. */
+    for (uint32_t n_chunk = 0;
+                  n_chunk < n_chunks + g_n_staging_window_chunks;
+                ++n_chunk)
+    {
+        const uint32_t     n_slot              = n_chunk % g_n_staging_window_chunks;
+        auto               slot_fence_ptr      = chunk_fence_ptrs[n_slot].get();
+        const VkDeviceSize slot_staging_offset = n_slot  * g_staging_window_chunk_size;
+
+        if (chunk_sizes[n_slot] != 0)
+        {
+            Anvil::Fence::wait_fences(1, /* in_n_fences */
+                                     &slot_fence_ptr);
+
+            if (is_read)
+            {
+                for (const auto& current_copy_region : chunk_copy_regions[n_slot])
+                {
+                    if (!staging_buffer_ptr->read(current_copy_region.dst_offset,
+                                                  current_copy_region.size,
+                                                  static_cast<uint8_t*>(out_opt_data_ptr) + (current_copy_region.src_offset - in_start_offset) ))
+                    {
+                        anvil_assert_fail();
+
+                        chunk_sizes[n_slot] = 0;
+                        goto end;
+                    }
+                }
+            }
+
+            chunk_fence_ptrs[n_slot]->reset();
+
+            chunk_sizes[n_slot] = 0;
+        }
+
+        if (n_chunk >= n_chunks)
+        {
+            continue;
+        }
+
+        chunk_data_offsets[n_slot] = static_cast<VkDeviceSize>(n_chunk) * g_staging_window_chunk_size;
+        chunk_sizes       [n_slot] = std::min(g_staging_window_chunk_size,
+                                              in_size - chunk_data_offsets[n_slot]);
+
+        /* Gather all resident ranges which intersect the chunk. Each becomes a region of the chunk's copy command.
+         * Ranges are sorted, so those which end within this chunk never need to be looked at again. */
+        {
+            const VkDeviceSize chunk_start_offset = in_start_offset    + chunk_data_offsets[n_slot];
+            const VkDeviceSize chunk_end_offset   = chunk_start_offset + chunk_sizes       [n_slot];
+
+            chunk_copy_regions[n_slot].clear();
+
+            for (uint32_t n_range = n_first_range;
+                          n_range < static_cast<uint32_t>(resident_ranges.size() ) && resident_ranges.at(n_range).start_offset < chunk_end_offset;
+                        ++n_range)
+            {
+                const auto&        current_range             = resident_ranges.at(n_range);
+                const VkDeviceSize region_buffer_start_offset = std::max(current_range.start_offset,
+                                                                         chunk_start_offset);
+                const VkDeviceSize region_buffer_end_offset   = std::min(current_range.start_offset + current_range.size,
+                                                                         chunk_end_offset);
+                const VkDeviceSize region_staging_offset      = slot_staging_offset + (region_buffer_start_offset - chunk_start_offset);
+                Anvil::BufferCopy  copy_region;
+
+                if (region_buffer_start_offset >= region_buffer_end_offset)
+                {
+                    continue;
+                }
+
+                copy_region.dst_offset = (is_read) ? region_staging_offset      : region_buffer_start_offset;
+                copy_region.size       = region_buffer_end_offset - region_buffer_start_offset;
+                copy_region.src_offset = (is_read) ? region_buffer_start_offset : region_staging_offset;
+
+                chunk_copy_regions[n_slot].push_back(copy_region);
+            }
+
+            while (n_first_range < static_cast<uint32_t>(resident_ranges.size() ))
+            {
+                const auto& first_range = resident_ranges.at(n_first_range);
+
+                if (first_range.start_offset + first_range.size > chunk_end_offset)
+                {
+                    break;
+                }
+
+                ++n_first_range;
+            }
+        }
+
+        if (chunk_copy_regions[n_slot].empty() )
+        {
+            /* Nothing is resident within this chunk */
+            chunk_sizes[n_slot] = 0;
+
+            continue;
+        }
+
+        if (!is_read)
+        {
+            staging_buffer_ptr->write(slot_staging_offset,
+                                      chunk_sizes[n_slot],
+                                      static_cast<const uint8_t*>(in_opt_data_ptr) + chunk_data_offsets[n_slot]);
+        }
+
+        /* Copies are waited upon by this thread, so the command buffers can come from the calling thread's pool. */
+        copy_cmdbuf_ptrs[n_slot] = m_device_ptr->get_thread_command_pool_for_queue_family_index(m_staging_buffer_queue_ptr->get_queue_family_index() )->alloc_primary_level_command_buffer();
+
+        if (copy_cmdbuf_ptrs[n_slot] == nullptr)
+        {
+            anvil_assert(copy_cmdbuf_ptrs[n_slot] != nullptr);
+
+            chunk_sizes[n_slot] = 0;
+            goto end;
+        }
+
+        if (device_type == Anvil::DeviceType::SINGLE_GPU)
+        {
+            copy_cmdbuf_ptrs[n_slot]->start_recording(true,   /* one_time_submit          */
+                                                      false); /* simultaneous_use_allowed */
+        }
+        else
+        {
+            anvil_assert(device_type == Anvil::DeviceType::MULTI_GPU);
+
+            copy_cmdbuf_ptrs[n_slot]->start_recording(true,  /* one_time_submit          */
+                                                      false, /* simultaneous_use_allowed */
+                                                      device_mask);
+        }
+        {
+            const auto&    copy_regions   = chunk_copy_regions[n_slot];
+            const uint32_t n_copy_regions = static_cast<uint32_t>(copy_regions.size() );
+
+            if (is_read)
+            {
+                Anvil::BufferBarrier buffer_barrier  (Anvil::AccessFlagBits::TRANSFER_WRITE_BIT,
+                                                      Anvil::AccessFlagBits::HOST_READ_BIT,
+                                                      VK_QUEUE_FAMILY_IGNORED,
+                                                      VK_QUEUE_FAMILY_IGNORED,
+                                                      staging_buffer_ptr,
+                                                      slot_staging_offset,
+                                                      chunk_sizes[n_slot]);
+                Anvil::MemoryBarrier pre_copy_barrier(Anvil::AccessFlagBits::TRANSFER_READ_BIT, /* in_destination_access_mask */
+                                                      Anvil::AccessFlagBits::HOST_WRITE_BIT | Anvil::AccessFlagBits::MEMORY_WRITE_BIT | Anvil::AccessFlagBits::SHADER_WRITE_BIT | Anvil::AccessFlagBits::TRANSFER_WRITE_BIT);
+
+                copy_cmdbuf_ptrs[n_slot]->record_pipeline_barrier(Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT, /* in_src_stage_mask */
+                                                                  Anvil::PipelineStageFlagBits::TRANSFER_BIT,     /* in_dst_stage_mask */
+                                                                  Anvil::DependencyFlagBits::NONE,
+                                                                  1,        /* in_memory_barrier_count        */
+                                                                 &pre_copy_barrier,
+                                                                  0,        /* in_buffer_memory_barrier_count */
+                                                                  nullptr,  /* in_buffer_memory_barriers_ptr  */
+                                                                  0,        /* in_image_memory_barrier_count  */
+                                                                  nullptr); /* in_image_memory_barriers_ptr   */
+                copy_cmdbuf_ptrs[n_slot]->record_copy_buffer     (this,
+                                                                  staging_buffer_ptr,
+                                                                  n_copy_regions,
+                                                                 &copy_regions.at(0) );
+                copy_cmdbuf_ptrs[n_slot]->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                                  Anvil::PipelineStageFlagBits::HOST_BIT,
+                                                                  Anvil::DependencyFlagBits::NONE,
+                                                                  0,        /* in_memory_barrier_count        */
+                                                                  nullptr,  /* in_memory_barriers_ptr         */
+                                                                  1,        /* in_buffer_memory_barrier_count */
+                                                                 &buffer_barrier,
+                                                                  0,        /* in_image_memory_barrier_count  */
+                                                                  nullptr); /* in_image_memory_barriers_ptr   */
+            }
+            else
+            {
+                Anvil::BufferBarrier buffer_barrier(Anvil::AccessFlagBits::HOST_WRITE_BIT, /* in_source_access_mask */
+                                                    Anvil::AccessFlagBits::TRANSFER_READ_BIT,
+                                                    VK_QUEUE_FAMILY_IGNORED,
+                                                    VK_QUEUE_FAMILY_IGNORED,
+                                                    staging_buffer_ptr,
+                                                    slot_staging_offset,
+                                                    chunk_sizes[n_slot]);
+
+                copy_cmdbuf_ptrs[n_slot]->record_pipeline_barrier(Anvil::PipelineStageFlagBits::HOST_BIT,
+                                                                  Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                                  Anvil::DependencyFlagBits::NONE,
+                                                                  0,        /* in_memory_barrier_count        */
+                                                                  nullptr,  /* in_memory_barriers_ptr         */
+                                                                  1,        /* in_buffer_memory_barrier_count */
+                                                                 &buffer_barrier,
+                                                                  0,        /* in_image_memory_barrier_count  */
+                                                                  nullptr); /* in_image_memory_barriers_ptr   */
+                copy_cmdbuf_ptrs[n_slot]->record_copy_buffer     (staging_buffer_ptr,
+                                                                  this,
+                                                                  n_copy_regions,
+                                                                 &copy_regions.at(0) );
+            }
+        }
+        copy_cmdbuf_ptrs[n_slot]->stop_recording();
+
+        if (device_type == Anvil::DeviceType::SINGLE_GPU)
+        {
+            m_staging_buffer_queue_ptr->submit(
+                Anvil::SubmitInfo::create_execute(copy_cmdbuf_ptrs[n_slot].get(),
+                                                  false, /* should_block */
+                                                  slot_fence_ptr)
+            );
+        }
+        else
+        {
+            Anvil::CommandBufferMGPUSubmission copy_cmdbuf_submission;
+
+            copy_cmdbuf_submission.cmd_buffer_ptr = copy_cmdbuf_ptrs[n_slot].get();
+            copy_cmdbuf_submission.device_mask    = device_mask;
+
+            m_staging_buffer_queue_ptr->submit(
+                Anvil::SubmitInfo::create_execute(&copy_cmdbuf_submission,
+                                                  1,     /* in_n_command_buffer_submissions */
+                                                  false, /* should_block                    */
+                                                  slot_fence_ptr)
+            );
+        }
+    }
+
+    result = true;
+end:
+    /* Make sure no copy op still refers to the staging buffer or the command buffers when bailing out. */
+    for (uint32_t n_slot = 0;
+                  n_slot < g_n_staging_window_chunks;
+                ++n_slot)
+    {
+        if (chunk_sizes[n_slot] != 0)
+        {
+            auto slot_fence_ptr = chunk_fence_ptrs[n_slot].get();
+
+            Anvil::Fence::wait_fences(1, /* in_n_fences */
+                                     &slot_fence_ptr);
+        }
+    }
+
+    return result;
+}
+
 /* Please see header for specification */
 bool Anvil::Buffer::write(VkDeviceSize  in_start_offset,
                           VkDeviceSize  in_size,
@@ -1110,18 +1829,24 @@ bool Anvil::Buffer::write(VkDeviceSize  in_start_offset,
                           uint32_t      in_device_mask,
                           Anvil::Queue* in_opt_queue_ptr)
 {
-    const Anvil::DeviceType device_type(m_device_ptr->get_type() );
-    bool                    result     (false);
+    const Anvil::DeviceType device_type     (m_device_ptr->get_type() );
+    Anvil::MemoryBlock*     memory_block_ptr(nullptr);
+    bool                    result          (false);
 
-    /** TODO: Support for sparse-resident buffers whose n_memory_blocks > 1 */
-    Anvil::MemoryBlock* memory_block_ptr(get_memory_block(0) );
-
-    if ( m_create_info_ptr->get_type()                                                              == Anvil::BufferType::NO_ALLOC &&
-        (m_create_info_ptr->get_create_flags() & Anvil::BufferCreateFlagBits::SPARSE_RESIDENCY_BIT) != 0)
+    if (requires_resident_range_transfers() )
     {
-        anvil_assert(m_page_tracker_ptr->get_n_memory_blocks() == 1);
+        result = transfer_via_staging_window(in_start_offset,
+                                             in_size,
+                                             in_device_mask,
+                                             in_opt_queue_ptr,
+                                             in_data,
+                                             nullptr); /* out_opt_data_ptr */
+
+        goto end;
     }
 
+    memory_block_ptr = get_memory_block(0);
+
     anvil_assert(memory_block_ptr                                    != nullptr);
     anvil_assert(memory_block_ptr->get_create_info_ptr()->get_size() >= in_size);
 
@@ -1135,35 +1860,81 @@ bool Anvil::Buffer::write(VkDeviceSize  in_start_offset,
     }
     else
     {
-        /* The buffer memory is not mappable. We need to create a staging memory,
-         * upload user's data there, and then issue a copy op. */
-        Anvil::PrimaryCommandBufferUniquePtr      copy_cmdbuf_ptr;
+        /* The buffer memory is not mappable. We need to use a staging buffer, upload user's data there,
+         * and then issue a copy op.
+         *
+         * If the device-wide staging ring is available and can accommodate the request, use a region of it.
+         * The copy op is then not waited upon. The ring will recycle the region once it retires.
+         * Otherwise, fall back to a staging buffer owned by this instance and block until the copy finishes. */
+        Anvil::PrimaryCommandBufferUniquePtr copy_cmdbuf_ptr;
+        Anvil::StagingRing::Allocation       staging_allocation;
+        Anvil::Buffer*                       staging_buffer_ptr    (nullptr);
+        VkDeviceSize                         staging_buffer_offset (0);
+        Anvil::Queue*                        staging_queue_ptr     (nullptr);
+        Anvil::StagingRing*                  staging_ring_ptr      ( (device_type == Anvil::DeviceType::SINGLE_GPU) ? m_device_ptr->get_staging_ring()
+                                                                                                                    : nullptr);
+        bool                                 staging_ring_submitted(false);
+        bool                                 uses_staging_ring     (false);
+
+        if (staging_ring_ptr != nullptr)
+        {
+            uses_staging_ring = staging_ring_ptr->allocate(in_size,
+                                                           m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits.optimal_buffer_copy_offset_alignment,
+                                                          &staging_allocation);
+        }
+
+        if (uses_staging_ring)
+        {
+            Anvil::QueueFamilyFlagBits staging_queue_fam_bits;
 
-        if (m_staging_buffer_ptr == nullptr                                    ||
-            m_staging_buffer_ptr->get_create_info_ptr()->get_size() < in_size)
+            staging_buffer_offset = staging_allocation.offset;
+            staging_buffer_ptr    = staging_allocation.buffer_ptr;
+            staging_queue_ptr     = get_staging_queue(in_opt_queue_ptr,
+                                                     &staging_queue_fam_bits);
+        }
+        else
         {
-            if (!init_staging_buffer(in_size,
-                                     in_opt_queue_ptr) )
+            if (in_size > g_n_staging_window_chunks * g_staging_window_chunk_size)
             {
-                result = false;
+                result = transfer_via_staging_window(in_start_offset,
+                                                     in_size,
+                                                     in_device_mask,
+                                                     in_opt_queue_ptr,
+                                                     in_data,
+                                                     nullptr); /* out_opt_data_ptr */
 
                 goto end;
             }
 
-            anvil_assert(m_staging_buffer_ptr != nullptr);
+            if (m_staging_buffer_ptr == nullptr                                    ||
+                m_staging_buffer_ptr->get_create_info_ptr()->get_size() < in_size)
+            {
+                if (!init_staging_buffer(in_size,
+                                         in_opt_queue_ptr) )
+                {
+                    result = false;
+
+                    goto end;
+                }
+
+                anvil_assert(m_staging_buffer_ptr != nullptr);
+            }
+
+            staging_buffer_ptr = m_staging_buffer_ptr.get();
+            staging_queue_ptr  = m_staging_buffer_queue_ptr;
         }
 
-        m_staging_buffer_ptr->write(0, /* in_start_offset */
-                                    in_size,
-                                    in_data);
+        staging_buffer_ptr->write(staging_buffer_offset,
+                                  in_size,
+                                  in_data);
 
-        copy_cmdbuf_ptr = m_device_ptr->get_command_pool_for_queue_family_index(m_staging_buffer_queue_ptr->get_queue_family_index() )->alloc_primary_level_command_buffer();
+        copy_cmdbuf_ptr = m_device_ptr->get_command_pool_for_queue_family_index(staging_queue_ptr->get_queue_family_index() )->alloc_primary_level_command_buffer();
 
         if (copy_cmdbuf_ptr == nullptr)
         {
             anvil_assert(copy_cmdbuf_ptr != nullptr);
 
-            goto end;
+            goto end_staging;
         }
 
         if (device_type == Anvil::DeviceType::SINGLE_GPU)
@@ -1185,14 +1956,14 @@ bool Anvil::Buffer::write(VkDeviceSize  in_start_offset,
                                                  Anvil::AccessFlagBits::HOST_WRITE_BIT | Anvil::AccessFlagBits::MEMORY_WRITE_BIT | Anvil::AccessFlagBits::SHADER_WRITE_BIT | Anvil::AccessFlagBits::TRANSFER_WRITE_BIT),
                                                 VK_QUEUE_FAMILY_IGNORED,
                                                 VK_QUEUE_FAMILY_IGNORED,
-                                                m_staging_buffer_ptr.get(),
-                                                0, /* in_offset */
+                                                staging_buffer_ptr,
+                                                staging_buffer_offset,
                                                 in_size);
             Anvil::BufferCopy    copy_region;
 
             copy_region.dst_offset = in_start_offset;
             copy_region.size       = in_size;
-            copy_region.src_offset = 0;
+            copy_region.src_offset = staging_buffer_offset;
 
 
             copy_cmdbuf_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::HOST_BIT,
@@ -1204,7 +1975,7 @@ bool Anvil::Buffer::write(VkDeviceSize  in_start_offset,
                                                      &buffer_barrier,
                                                      0,               /* in_image_memory_barrier_count */
                                                      nullptr);        /* in_image_memory_barriers_ptr  */
-            copy_cmdbuf_ptr->record_copy_buffer     (m_staging_buffer_ptr.get(),
+            copy_cmdbuf_ptr->record_copy_buffer     (staging_buffer_ptr,
                                                      this,
                                                      1, /* in_region_count */
                                                     &copy_region);
@@ -1213,9 +1984,10 @@ bool Anvil::Buffer::write(VkDeviceSize  in_start_offset,
 
         if (device_type == Anvil::DeviceType::SINGLE_GPU)
         {
-            m_staging_buffer_queue_ptr->submit(
+            staging_queue_ptr->submit(
                 Anvil::SubmitInfo::create_execute(copy_cmdbuf_ptr.get(),
-                                                  true /* should_block */)
+                                                  !uses_staging_ring, /* should_block */
+                                                  staging_allocation.fence_ptr)
             );
         }
         else
@@ -1239,14 +2011,24 @@ bool Anvil::Buffer::write(VkDeviceSize  in_start_offset,
                 copy_cmdbuf_submission.device_mask = device_mask;
             }
 
-            m_staging_buffer_queue_ptr->submit(
+            staging_queue_ptr->submit(
                 Anvil::SubmitInfo::create_execute(&copy_cmdbuf_submission,
                                                   1, /* in_n_command_buffer_submissions */
                                                   true /* should_block */)
             );
         }
 
-        result = true;
+        staging_ring_submitted = uses_staging_ring;
+        result                 = true;
+
+end_staging:
+        if (uses_staging_ring)
+        {
+            /* The command buffer must outlive the copy op, so hand it over to the ring. */
+            staging_ring_ptr->release(staging_allocation,
+                                      staging_ring_submitted,
+                                      std::move(copy_cmdbuf_ptr) );
+        }
     }
 
 end:
@@ -1267,3 +2049,34 @@ bool Anvil::Buffer::is_memory_block_owned(const MemoryBlock* in_memory_block_ptr
 
     return false;
 }
+
+/** Updates the tracked state of the buffer. Does nothing if state tracking is disabled.
+ *
+ *  @param in_stage_mask  Stages the command accesses the buffer at. For barriers, the destination stage mask.
+ *  @param in_access_mask Access types used by the command. For barriers, the destination access mask.
+ *  @param in_is_barrier  true if the command synchronizes the buffer, in which case the masks replace the
+ *                        tracked ones. Otherwise, they are added to the tracked masks.
+ **/
+void Anvil::Buffer::update_tracked_state(Anvil::PipelineStageFlags in_stage_mask,
+                                         Anvil::AccessFlags        in_access_mask,
+                                         bool                      in_is_barrier)
+{
+    if (!m_is_state_tracking_enabled)
+    {
+        goto end;
+    }
+
+    if (in_is_barrier)
+    {
+        m_tracked_state.access_mask = in_access_mask;
+        m_tracked_state.stage_mask  = in_stage_mask;
+    }
+    else
+    {
+        m_tracked_state.access_mask |= in_access_mask;
+        m_tracked_state.stage_mask  |= in_stage_mask;
+    }
+
+end:
+    ;
+}
@@ -20,11 +20,21 @@
 // THE SOFTWARE.
 //
 
+#include "misc/buffer_create_info.h"
 #include "misc/callbacks.h"
 #include "misc/debug.h"
 #include "misc/descriptor_set_create_info.h"
+#include "misc/framebuffer_create_info.h"
+#include "misc/graphics_pipeline_create_info.h"
+#include "misc/image_create_info.h"
+#include "misc/image_view_create_info.h"
 #include "misc/memory_block_create_info.h"
+#include "misc/perf_counters.h"
+#include "misc/pipeline_statistics_profiler.h"
+#include "misc/render_pass_create_info.h"
+#include "misc/scratch_array.h"
 #include "misc/struct_chainer.h"
+#include "wrappers/acceleration_structure.h"
 #include "wrappers/buffer.h"
 #include "wrappers/buffer_view.h"
 #include "wrappers/command_buffer.h"
@@ -32,6 +42,7 @@
 #include "wrappers/compute_pipeline_manager.h"
 #include "wrappers/descriptor_set.h"
 #include "wrappers/descriptor_set_layout.h"
+#include "wrappers/descriptor_update_template.h"
 #include "wrappers/device.h"
 #include "wrappers/event.h"
 #include "wrappers/framebuffer.h"
@@ -44,12 +55,24 @@
 #include "wrappers/pipeline_layout.h"
 #include "wrappers/query_pool.h"
 #include "wrappers/render_pass.h"
+#include "wrappers/sampler.h"
 
 
 /* Command stashing should be enabled by default for builds that care. */
 bool Anvil::CommandBufferBase::m_command_stashing_disabled = false;
 
 
+/** Please see header for specification */
+Anvil::CommandBufferBase::BeginConditionalRenderingEXTCommand::BeginConditionalRenderingEXTCommand(Anvil::Buffer*                   in_buffer_ptr,
+                                                                                                   VkDeviceSize                     in_offset,
+                                                                                                   Anvil::ConditionalRenderingFlags in_flags)
+    :Command(COMMAND_TYPE_BEGIN_CONDITIONAL_RENDERING_EXT)
+{
+    buffer_ptr = in_buffer_ptr;
+    flags      = in_flags;
+    offset     = in_offset;
+}
+
 /** Please see header for specification */
 Anvil::CommandBufferBase::BeginQueryCommand::BeginQueryCommand(Anvil::QueryPool*        in_query_pool_ptr,
                                                                Anvil::QueryIndex        in_entry,
@@ -75,6 +98,40 @@ Anvil::BeginQueryIndexedEXTCommand::BeginQueryIndexedEXTCommand(Anvil::QueryPool
     /* Stub */
 }
 
+/** Please see header for specification */
+Anvil::CommandBufferBase::BeginRenderingKHRCommand::BeginRenderingKHRCommand(const VkRect2D&                       in_render_area,
+                                                                             uint32_t                              in_layer_count,
+                                                                             uint32_t                              in_view_mask,
+                                                                             uint32_t                              in_n_color_attachments,
+                                                                             const Anvil::RenderingAttachmentInfo* in_opt_color_attachments_ptr,
+                                                                             const Anvil::RenderingAttachmentInfo* in_opt_depth_attachment_ptr,
+                                                                             const Anvil::RenderingAttachmentInfo* in_opt_stencil_attachment_ptr,
+                                                                             Anvil::RenderingFlags                 in_flags)
+    :Command               (COMMAND_TYPE_BEGIN_RENDERING_KHR),
+     flags                 (in_flags),
+     has_depth_attachment  (in_opt_depth_attachment_ptr   != nullptr),
+     has_stencil_attachment(in_opt_stencil_attachment_ptr != nullptr),
+     layer_count           (in_layer_count),
+     render_area           (in_render_area),
+     view_mask             (in_view_mask)
+{
+    if (in_n_color_attachments > 0)
+    {
+        color_attachments.assign(in_opt_color_attachments_ptr,
+                                 in_opt_color_attachments_ptr + in_n_color_attachments);
+    }
+
+    if (in_opt_depth_attachment_ptr != nullptr)
+    {
+        depth_attachment = *in_opt_depth_attachment_ptr;
+    }
+
+    if (in_opt_stencil_attachment_ptr != nullptr)
+    {
+        stencil_attachment = *in_opt_stencil_attachment_ptr;
+    }
+}
+
 /** Please see header for specification */
 Anvil::BeginRenderPassCommand::BeginRenderPassCommand(uint32_t                                in_n_clear_values,
                                                       const VkClearValue*                     in_clear_value_ptrs,
@@ -87,7 +144,9 @@ Anvil::BeginRenderPassCommand::BeginRenderPassCommand(uint32_t
                                                       const uint32_t&                         in_n_attachment_initial_sample_locations,
                                                       const Anvil::AttachmentSampleLocations* in_attachment_initial_sample_locations_ptr,
                                                       const uint32_t&                         in_n_post_subpass_sample_locations,
-                                                      const Anvil::SubpassSampleLocations*    in_post_subpass_sample_locations_ptr)
+                                                      const Anvil::SubpassSampleLocations*    in_post_subpass_sample_locations_ptr,
+                                                      const uint32_t&                         in_n_attachment_image_views,
+                                                      Anvil::ImageView* const*                in_attachment_image_view_ptrs)
     :Command(COMMAND_TYPE_BEGIN_RENDER_PASS)
 {
     contents        = in_contents;
@@ -126,6 +185,12 @@ Anvil::BeginRenderPassCommand::BeginRenderPassCommand(uint32_t
     {
         post_subpass_sample_locations.at(n_subpass) = in_post_subpass_sample_locations_ptr[n_subpass];
     }
+
+    if (in_n_attachment_image_views > 0)
+    {
+        attachment_image_view_ptrs.assign(in_attachment_image_view_ptrs,
+                                          in_attachment_image_view_ptrs + in_n_attachment_image_views);
+    }
 }
 
 /** Please see header for specification */
@@ -147,13 +212,18 @@ Anvil::CommandBufferBase::BindDescriptorSetsCommand::BindDescriptorSetsCommand(A
                                                                                uint32_t                           in_set_count,
                                                                                const Anvil::DescriptorSet* const* in_descriptor_set_ptrs,
                                                                                uint32_t                           in_dynamic_offset_count,
-                                                                               const uint32_t*                    in_dynamic_offset_ptrs)
-    :Command(COMMAND_TYPE_BIND_DESCRIPTOR_SETS)
+                                                                               const uint32_t*                    in_dynamic_offset_ptrs,
+                                                                               Anvil::CommandArena*               in_arena_ptr)
+    :Command        (COMMAND_TYPE_BIND_DESCRIPTOR_SETS),
+     descriptor_sets(Anvil::CommandArenaAllocator<const Anvil::DescriptorSet*>(in_arena_ptr) ),
+     dynamic_offsets(Anvil::CommandArenaAllocator<uint32_t>(in_arena_ptr) )
 {
     first_set           = in_first_set;
     layout_ptr          = in_layout_ptr;
     pipeline_bind_point = in_pipeline_bind_point;
 
+    descriptor_sets.reserve(in_set_count);
+
     for (uint32_t n_set = 0;
                   n_set < in_set_count;
                 ++n_set)
@@ -161,6 +231,8 @@ Anvil::CommandBufferBase::BindDescriptorSetsCommand::BindDescriptorSetsCommand(A
         descriptor_sets.push_back(in_descriptor_set_ptrs[n_set]);
     }
 
+    dynamic_offsets.reserve(in_dynamic_offset_count);
+
     for (uint32_t n_dynamic_offset = 0;
                   n_dynamic_offset < in_dynamic_offset_count;
                 ++n_dynamic_offset)
@@ -191,14 +263,27 @@ Anvil::CommandBufferBase::BindPipelineCommand::BindPipelineCommand(Anvil::Pipeli
 }
 
 /** Please see header for specification */
-Anvil::CommandBufferBase::BindVertexBuffersCommand::BindVertexBuffersCommand(uint32_t            in_start_binding,
-                                                                             uint32_t            in_binding_count,
-                                                                             Anvil::Buffer**     in_buffer_ptrs,
-                                                                             const VkDeviceSize* in_offset_ptrs)
-    :Command(COMMAND_TYPE_BIND_VERTEX_BUFFER)
+Anvil::CommandBufferBase::BindShadingRateImageNVCommand::BindShadingRateImageNVCommand(Anvil::ImageView*  in_opt_image_view_ptr,
+                                                                                       Anvil::ImageLayout in_image_layout)
+    :Command(COMMAND_TYPE_BIND_SHADING_RATE_IMAGE_NV)
+{
+    image_layout   = in_image_layout;
+    image_view_ptr = in_opt_image_view_ptr;
+}
+
+/** Please see header for specification */
+Anvil::CommandBufferBase::BindVertexBuffersCommand::BindVertexBuffersCommand(uint32_t             in_start_binding,
+                                                                             uint32_t             in_binding_count,
+                                                                             Anvil::Buffer**      in_buffer_ptrs,
+                                                                             const VkDeviceSize*  in_offset_ptrs,
+                                                                             Anvil::CommandArena* in_arena_ptr)
+    :Command (COMMAND_TYPE_BIND_VERTEX_BUFFER),
+     bindings(Anvil::CommandArenaAllocator<BindVertexBuffersCommandBinding>(in_arena_ptr) )
 {
     start_binding = in_start_binding;
 
+    bindings.reserve(in_binding_count);
+
     for (uint32_t n_binding = 0;
                   n_binding < in_binding_count;
                 ++n_binding)
@@ -232,8 +317,10 @@ Anvil::CommandBufferBase::BlitImageCommand::BlitImageCommand(Anvil::Image*
                                                              Anvil::ImageLayout      in_dst_image_layout,
                                                              uint32_t                in_region_count,
                                                              const Anvil::ImageBlit* in_region_ptrs,
-                                                             Anvil::Filter           in_filter)
-    :Command(COMMAND_TYPE_BLIT_IMAGE)
+                                                             Anvil::Filter           in_filter,
+                                                             Anvil::CommandArena*    in_arena_ptr)
+    :Command(COMMAND_TYPE_BLIT_IMAGE),
+     regions(Anvil::CommandArenaAllocator<Anvil::ImageBlit>(in_arena_ptr) )
 {
     dst_image        = in_dst_image_ptr->get_image();
     dst_image_layout = in_dst_image_layout;
@@ -243,6 +330,8 @@ Anvil::CommandBufferBase::BlitImageCommand::BlitImageCommand(Anvil::Image*
     src_image_layout = in_src_image_layout;
     src_image_ptr    = in_src_image_ptr;
 
+    regions.reserve(in_region_count);
+
     for (uint32_t n_region = 0;
                   n_region < in_region_count;
                 ++n_region)
@@ -251,6 +340,61 @@ Anvil::CommandBufferBase::BlitImageCommand::BlitImageCommand(Anvil::Image*
     }
 }
 
+/** Please see header for specification */
+Anvil::CommandBufferBase::BuildAccelerationStructuresKHRCommand::BuildAccelerationStructuresKHRCommand(uint32_t                                               in_n_infos,
+                                                                                                       const VkAccelerationStructureBuildGeometryInfoKHR*     in_infos_ptr,
+                                                                                                       const VkAccelerationStructureBuildRangeInfoKHR* const* in_build_range_infos_ptr,
+                                                                                                       Anvil::CommandArena*                                   in_arena_ptr)
+    :Command    (COMMAND_TYPE_BUILD_ACCELERATION_STRUCTURES_KHR),
+     geometries (Anvil::CommandArenaAllocator<VkAccelerationStructureGeometryKHR>         (in_arena_ptr) ),
+     infos      (Anvil::CommandArenaAllocator<VkAccelerationStructureBuildGeometryInfoKHR>(in_arena_ptr) ),
+     range_infos(Anvil::CommandArenaAllocator<VkAccelerationStructureBuildRangeInfoKHR>   (in_arena_ptr) )
+{
+    uint32_t n_total_geometries = 0;
+
+    for (uint32_t n_info = 0;
+                  n_info < in_n_infos;
+                ++n_info)
+    {
+        n_total_geometries += in_infos_ptr[n_info].geometryCount;
+    }
+
+    geometries.reserve (n_total_geometries);
+    infos.reserve      (in_n_infos);
+    range_infos.reserve(n_total_geometries);
+
+    for (uint32_t n_info = 0;
+                  n_info < in_n_infos;
+                ++n_info)
+    {
+        const auto& current_info = in_infos_ptr[n_info];
+
+        for (uint32_t n_geometry = 0;
+                      n_geometry < current_info.geometryCount;
+                    ++n_geometry)
+        {
+            geometries.push_back (current_info.pGeometries != nullptr ?  current_info.pGeometries [n_geometry]
+                                                                      : *current_info.ppGeometries[n_geometry]);
+            range_infos.push_back(in_build_range_infos_ptr[n_info][n_geometry]);
+        }
+
+        infos.push_back(current_info);
+    }
+
+    /* Patch geometry pointers only after all geometries have been copied, so that they stay valid */
+    for (uint32_t n_info = 0, n_first_geometry = 0;
+                  n_info < in_n_infos;
+                ++n_info)
+    {
+        auto& current_info = infos.at(n_info);
+
+        current_info.pGeometries  = (current_info.geometryCount > 0) ? &geometries.at(n_first_geometry) : nullptr;
+        current_info.ppGeometries = nullptr;
+
+        n_first_geometry += current_info.geometryCount;
+    }
+}
+
 /** Please see header for specification */
 Anvil::BindTransformFeedbackBuffersEXTCommand::BindTransformFeedbackBuffersEXTCommand(const uint32_t&                    in_first_binding,
                                                                                       const uint32_t&                    in_n_bindings,
@@ -271,9 +415,14 @@ Anvil::BindTransformFeedbackBuffersEXTCommand::BindTransformFeedbackBuffersEXTCo
 Anvil::CommandBufferBase::ClearAttachmentsCommand::ClearAttachmentsCommand(uint32_t                      in_n_attachments,
                                                                            const Anvil::ClearAttachment* in_attachments,
                                                                            uint32_t                      in_n_rects,
-                                                                           const VkClearRect*            in_rect_ptrs)
-    :Command(COMMAND_TYPE_CLEAR_ATTACHMENTS)
+                                                                           const VkClearRect*            in_rect_ptrs,
+                                                                           Anvil::CommandArena*          in_arena_ptr)
+    :Command    (COMMAND_TYPE_CLEAR_ATTACHMENTS),
+     attachments(Anvil::CommandArenaAllocator<ClearAttachmentsCommandAttachment>(in_arena_ptr) ),
+     rects      (Anvil::CommandArenaAllocator<VkClearRect>(in_arena_ptr) )
 {
+    attachments.reserve(in_n_attachments);
+
     for (uint32_t n_attachment = 0;
                   n_attachment < in_n_attachments;
                 ++n_attachment)
@@ -283,6 +432,8 @@ Anvil::CommandBufferBase::ClearAttachmentsCommand::ClearAttachmentsCommand(uint3
                                                                 in_attachments[n_attachment].color_attachment) );
     }
 
+    rects.reserve(in_n_rects);
+
     for (uint32_t n_rect = 0;
                   n_rect < in_n_rects;
                 ++n_rect)
@@ -296,14 +447,18 @@ Anvil::CommandBufferBase::ClearColorImageCommand::ClearColorImageCommand(Anvil::
                                                                          Anvil::ImageLayout                  in_image_layout,
                                                                          const VkClearColorValue*            in_color_ptr,
                                                                          uint32_t                            in_range_count,
-                                                                         const Anvil::ImageSubresourceRange* in_range_ptrs)
-    :Command(COMMAND_TYPE_CLEAR_COLOR_IMAGE)
+                                                                         const Anvil::ImageSubresourceRange* in_range_ptrs,
+                                                                         Anvil::CommandArena*                in_arena_ptr)
+    :Command(COMMAND_TYPE_CLEAR_COLOR_IMAGE),
+     ranges (Anvil::CommandArenaAllocator<Anvil::ImageSubresourceRange>(in_arena_ptr) )
 {
     color        = *in_color_ptr;
     image        = in_image_ptr->get_image();
     image_layout = in_image_layout;
     image_ptr    = in_image_ptr;
 
+    ranges.reserve(in_range_count);
+
     for (uint32_t n_range = 0;
                   n_range < in_range_count;
                 ++n_range)
@@ -317,14 +472,18 @@ Anvil::CommandBufferBase::ClearDepthStencilImageCommand::ClearDepthStencilImageC
                                                                                        Anvil::ImageLayout                  in_image_layout,
                                                                                        const VkClearDepthStencilValue*     in_depth_stencil_ptr,
                                                                                        uint32_t                            in_range_count,
-                                                                                       const Anvil::ImageSubresourceRange* in_range_ptrs)
-    :Command(COMMAND_TYPE_CLEAR_DEPTH_STENCIL_IMAGE)
+                                                                                       const Anvil::ImageSubresourceRange* in_range_ptrs,
+                                                                                       Anvil::CommandArena*                in_arena_ptr)
+    :Command(COMMAND_TYPE_CLEAR_DEPTH_STENCIL_IMAGE),
+     ranges (Anvil::CommandArenaAllocator<Anvil::ImageSubresourceRange>(in_arena_ptr) )
 {
     depth_stencil = *in_depth_stencil_ptr;
     image         =  in_image_ptr->get_image();
     image_layout  =  in_image_layout;
     image_ptr     =  in_image_ptr;
 
+    ranges.reserve(in_range_count);
+
     for (uint32_t n_range = 0;
                   n_range < in_range_count;
                 ++n_range)
@@ -333,18 +492,33 @@ Anvil::CommandBufferBase::ClearDepthStencilImageCommand::ClearDepthStencilImageC
     }
 }
 
+/** Please see header for specification */
+Anvil::CommandBufferBase::CopyAccelerationStructureKHRCommand::CopyAccelerationStructureKHRCommand(Anvil::AccelerationStructure*      in_src_ptr,
+                                                                                                   Anvil::AccelerationStructure*      in_dst_ptr,
+                                                                                                   VkCopyAccelerationStructureModeKHR in_mode)
+    :Command(COMMAND_TYPE_COPY_ACCELERATION_STRUCTURE_KHR)
+{
+    dst_ptr = in_dst_ptr;
+    mode    = in_mode;
+    src_ptr = in_src_ptr;
+}
+
 /** Please see header for specification */
 Anvil::CommandBufferBase::CopyBufferCommand::CopyBufferCommand(Anvil::Buffer*           in_src_buffer_ptr,
                                                                Anvil::Buffer*           in_dst_buffer_ptr,
                                                                uint32_t                 in_region_count,
-                                                               const Anvil::BufferCopy* in_region_ptrs)
-    :Command(COMMAND_TYPE_COPY_BUFFER)
+                                                               const Anvil::BufferCopy* in_region_ptrs,
+                                                               Anvil::CommandArena*     in_arena_ptr)
+    :Command(COMMAND_TYPE_COPY_BUFFER),
+     regions(Anvil::CommandArenaAllocator<Anvil::BufferCopy>(in_arena_ptr) )
 {
     dst_buffer     = in_dst_buffer_ptr->get_buffer();
     dst_buffer_ptr = in_dst_buffer_ptr;
     src_buffer     = in_src_buffer_ptr->get_buffer();
     src_buffer_ptr = in_src_buffer_ptr;
 
+    regions.reserve(in_region_count);
+
     for (uint32_t n_region = 0;
                   n_region < in_region_count;
                 ++n_region)
@@ -358,8 +532,10 @@ Anvil::CommandBufferBase::CopyBufferToImageCommand::CopyBufferToImageCommand(Anv
                                                                              Anvil::Image*                 in_dst_image_ptr,
                                                                              Anvil::ImageLayout            in_dst_image_layout,
                                                                              uint32_t                      in_region_count,
-                                                                             const Anvil::BufferImageCopy* in_region_ptrs)
-    :Command(COMMAND_TYPE_COPY_BUFFER_TO_IMAGE)
+                                                                             const Anvil::BufferImageCopy* in_region_ptrs,
+                                                                             Anvil::CommandArena*          in_arena_ptr)
+    :Command(COMMAND_TYPE_COPY_BUFFER_TO_IMAGE),
+     regions(Anvil::CommandArenaAllocator<Anvil::BufferImageCopy>(in_arena_ptr) )
 {
     dst_image        = in_dst_image_ptr->get_image();
     dst_image_layout = in_dst_image_layout;
@@ -367,6 +543,8 @@ Anvil::CommandBufferBase::CopyBufferToImageCommand::CopyBufferToImageCommand(Anv
     src_buffer       = in_src_buffer_ptr->get_buffer();
     src_buffer_ptr   = in_src_buffer_ptr;
 
+    regions.reserve(in_region_count);
+
     for (uint32_t n_region = 0;
                   n_region < in_region_count;
                 ++n_region)
@@ -381,8 +559,10 @@ Anvil::CommandBufferBase::CopyImageCommand::CopyImageCommand(Anvil::Image*
                                                              Anvil::Image*           in_dst_image_ptr,
                                                              Anvil::ImageLayout      in_dst_image_layout,
                                                              uint32_t                in_region_count,
-                                                             const Anvil::ImageCopy* in_region_ptrs)
-    :Command(COMMAND_TYPE_COPY_IMAGE)
+                                                             const Anvil::ImageCopy* in_region_ptrs,
+                                                             Anvil::CommandArena*    in_arena_ptr)
+    :Command(COMMAND_TYPE_COPY_IMAGE),
+     regions(Anvil::CommandArenaAllocator<Anvil::ImageCopy>(in_arena_ptr) )
 {
     dst_image        = in_dst_image_ptr->get_image();
     dst_image_layout = in_dst_image_layout;
@@ -391,6 +571,8 @@ Anvil::CommandBufferBase::CopyImageCommand::CopyImageCommand(Anvil::Image*
     src_image_layout = in_src_image_layout;
     src_image_ptr    = in_src_image_ptr;
 
+    regions.reserve(in_region_count);
+
     for (uint32_t n_region = 0;
                   n_region < in_region_count;
                 ++n_region)
@@ -404,8 +586,10 @@ Anvil::CommandBufferBase::CopyImageToBufferCommand::CopyImageToBufferCommand(Anv
                                                                              Anvil::ImageLayout            in_src_image_layout,
                                                                              Anvil::Buffer*                in_dst_buffer_ptr,
                                                                              uint32_t                      in_region_count,
-                                                                             const Anvil::BufferImageCopy* in_region_ptrs)
-    :Command(COMMAND_TYPE_COPY_IMAGE_TO_BUFFER)
+                                                                             const Anvil::BufferImageCopy* in_region_ptrs,
+                                                                             Anvil::CommandArena*          in_arena_ptr)
+    :Command(COMMAND_TYPE_COPY_IMAGE_TO_BUFFER),
+     regions(Anvil::CommandArenaAllocator<Anvil::BufferImageCopy>(in_arena_ptr) )
 {
     dst_buffer       = in_dst_buffer_ptr->get_buffer();
     dst_buffer_ptr   = in_dst_buffer_ptr;
@@ -413,6 +597,8 @@ Anvil::CommandBufferBase::CopyImageToBufferCommand::CopyImageToBufferCommand(Anv
     src_image_layout = in_src_image_layout;
     src_image_ptr    = in_src_image_ptr;
 
+    regions.reserve(in_region_count);
+
     for (uint32_t n_region = 0;
                   n_region < in_region_count;
                 ++n_region)
@@ -677,6 +863,48 @@ Anvil::CommandBufferBase::DrawIndirectCountKHRCommand::DrawIndirectCountKHRComma
     stride           = in_stride;
 }
 
+/** Please see header for specification */
+Anvil::CommandBufferBase::DrawMeshTasksIndirectCountNVCommand::DrawMeshTasksIndirectCountNVCommand(Anvil::Buffer* in_buffer_ptr,
+                                                                                                   VkDeviceSize   in_offset,
+                                                                                                   Anvil::Buffer* in_count_buffer_ptr,
+                                                                                                   VkDeviceSize   in_count_offset,
+                                                                                                   uint32_t       in_max_draw_count,
+                                                                                                   uint32_t       in_stride)
+    :Command(COMMAND_TYPE_DRAW_MESH_TASKS_INDIRECT_COUNT_NV)
+{
+    buffer           = in_buffer_ptr->get_buffer();
+    buffer_ptr       = in_buffer_ptr;
+    count_buffer     = in_count_buffer_ptr->get_buffer();
+    count_buffer_ptr = in_count_buffer_ptr;
+    count_offset     = in_count_offset;
+    max_draw_count   = in_max_draw_count;
+    offset           = in_offset;
+    stride           = in_stride;
+}
+
+/** Please see header for specification */
+Anvil::CommandBufferBase::DrawMeshTasksIndirectNVCommand::DrawMeshTasksIndirectNVCommand(Anvil::Buffer* in_buffer_ptr,
+                                                                                         VkDeviceSize   in_offset,
+                                                                                         uint32_t       in_draw_count,
+                                                                                         uint32_t       in_stride)
+    :Command(COMMAND_TYPE_DRAW_MESH_TASKS_INDIRECT_NV)
+{
+    buffer     = in_buffer_ptr->get_buffer();
+    buffer_ptr = in_buffer_ptr;
+    draw_count = in_draw_count;
+    offset     = in_offset;
+    stride     = in_stride;
+}
+
+/** Please see header for specification */
+Anvil::CommandBufferBase::DrawMeshTasksNVCommand::DrawMeshTasksNVCommand(uint32_t in_task_count,
+                                                                         uint32_t in_first_task)
+    :Command(COMMAND_TYPE_DRAW_MESH_TASKS_NV)
+{
+    first_task = in_first_task;
+    task_count = in_task_count;
+}
+
 /** Please see header for specification */
 Anvil::CommandBufferBase::EndQueryCommand::EndQueryCommand(Anvil::QueryPool* in_query_pool_ptr,
                                                            Anvil::QueryIndex in_entry)
@@ -704,23 +932,48 @@ Anvil::EndRenderPassCommand::EndRenderPassCommand()
 {
 }
 
+/** Please see header for specification */
+Anvil::CommandBufferBase::EndConditionalRenderingEXTCommand::EndConditionalRenderingEXTCommand()
+    :Command(COMMAND_TYPE_END_CONDITIONAL_RENDERING_EXT)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::CommandBufferBase::EndRenderingKHRCommand::EndRenderingKHRCommand()
+    :Command(COMMAND_TYPE_END_RENDERING_KHR)
+{
+    /* Stub */
+}
+
 /** Please see header for specification */
 Anvil::CommandBufferBase::EndTransformFeedbackEXTCommand::EndTransformFeedbackEXTCommand(const uint32_t&                          in_first_counter_buffer,
                                                                                          const std::vector<const Anvil::Buffer*>& in_counter_buffer_ptrs,
-                                                                                         const std::vector<VkDeviceSize>&         in_counter_buffer_offsets)
+                                                                                         const std::vector<VkDeviceSize>&         in_counter_buffer_offsets,
+                                                                                         Anvil::CommandArena*                     in_arena_ptr)
     :Command               (COMMAND_TYPE_END_TRANSFORM_FEEDBACK_EXT),
-     first_counter_buffer  (in_first_counter_buffer),
-     counter_buffer_ptrs   (in_counter_buffer_ptrs),
-     counter_buffer_offsets(in_counter_buffer_offsets)
+     counter_buffer_offsets(in_counter_buffer_offsets.begin(),
+                            in_counter_buffer_offsets.end  (),
+                            Anvil::CommandArenaAllocator<VkDeviceSize>(in_arena_ptr) ),
+     counter_buffer_ptrs   (in_counter_buffer_ptrs.begin(),
+                            in_counter_buffer_ptrs.end  (),
+                            Anvil::CommandArenaAllocator<const Anvil::Buffer*>(in_arena_ptr) ),
+     first_counter_buffer  (in_first_counter_buffer)
 {
     /* Stub */
 }
 
 /** Please see header for specification */
 Anvil::CommandBufferBase::ExecuteCommandsCommand::ExecuteCommandsCommand(uint32_t                        in_cmd_buffers_count,
-                                                                         Anvil::SecondaryCommandBuffer** in_cmd_buffer_ptrs)
-    :Command(COMMAND_TYPE_EXECUTE_COMMANDS)
+                                                                         Anvil::SecondaryCommandBuffer** in_cmd_buffer_ptrs,
+                                                                         Anvil::CommandArena*            in_arena_ptr)
+    :Command            (COMMAND_TYPE_EXECUTE_COMMANDS),
+     command_buffer_ptrs(Anvil::CommandArenaAllocator<Anvil::SecondaryCommandBuffer*>(in_arena_ptr) ),
+     command_buffers    (Anvil::CommandArenaAllocator<VkCommandBuffer>(in_arena_ptr) )
 {
+    command_buffers.reserve    (in_cmd_buffers_count);
+    command_buffer_ptrs.reserve(in_cmd_buffers_count);
+
     for (uint32_t n_cmd_buffer = 0;
                   n_cmd_buffer < in_cmd_buffers_count;
                 ++n_cmd_buffer)
@@ -789,6 +1042,54 @@ Anvil::PipelineBarrierCommand::PipelineBarrierCommand(Anvil::PipelineStageFlags
     }
 }
 
+/** Please see header for specification */
+Anvil::CommandBufferBase::PipelineBarrierRawCommand::PipelineBarrierRawCommand(Anvil::PipelineStageFlags     in_src_stage_mask,
+                                                                               Anvil::PipelineStageFlags     in_dst_stage_mask,
+                                                                               Anvil::DependencyFlags        in_flags,
+                                                                               uint32_t                      in_memory_barrier_count,
+                                                                               const RawMemoryBarrier* const in_memory_barriers_ptr,
+                                                                               uint32_t                      in_buffer_memory_barrier_count,
+                                                                               const RawBufferBarrier* const in_buffer_memory_barriers_ptr,
+                                                                               uint32_t                      in_image_memory_barrier_count,
+                                                                               const RawImageBarrier*  const in_image_memory_barriers_ptr,
+                                                                               Anvil::CommandArena*          in_arena_ptr)
+    :Command        (COMMAND_TYPE_PIPELINE_BARRIER_RAW),
+     buffer_barriers(Anvil::CommandArenaAllocator<RawBufferBarrier>(in_arena_ptr) ),
+     image_barriers (Anvil::CommandArenaAllocator<RawImageBarrier>(in_arena_ptr) ),
+     memory_barriers(Anvil::CommandArenaAllocator<RawMemoryBarrier>(in_arena_ptr) )
+{
+    dst_stage_mask = in_dst_stage_mask;
+    flags          = in_flags;
+    src_stage_mask = in_src_stage_mask;
+
+    buffer_barriers.reserve(in_buffer_memory_barrier_count);
+
+    for (uint32_t n_buffer_memory_barrier = 0;
+                  n_buffer_memory_barrier < in_buffer_memory_barrier_count;
+                ++n_buffer_memory_barrier)
+    {
+        buffer_barriers.push_back(in_buffer_memory_barriers_ptr[n_buffer_memory_barrier]);
+    }
+
+    image_barriers.reserve(in_image_memory_barrier_count);
+
+    for (uint32_t n_image_memory_barrier = 0;
+                  n_image_memory_barrier < in_image_memory_barrier_count;
+                ++n_image_memory_barrier)
+    {
+        image_barriers.push_back(in_image_memory_barriers_ptr[n_image_memory_barrier]);
+    }
+
+    memory_barriers.reserve(in_memory_barrier_count);
+
+    for (uint32_t n_memory_barrier = 0;
+                  n_memory_barrier < in_memory_barrier_count;
+                ++n_memory_barrier)
+    {
+        memory_barriers.push_back(in_memory_barriers_ptr[n_memory_barrier]);
+    }
+}
+
 /** Please see header for specification */
 Anvil::CommandBufferBase::PushConstantsCommand::PushConstantsCommand(Anvil::PipelineLayout*  in_layout_ptr,
                                                                      Anvil::ShaderStageFlags in_stage_flags,
@@ -804,6 +1105,43 @@ Anvil::CommandBufferBase::PushConstantsCommand::PushConstantsCommand(Anvil::Pipe
     values      = in_values;
 }
 
+/** Please see header for specification */
+Anvil::CommandBufferBase::PushDescriptorSetKHRCommand::PushDescriptorSetKHRCommand(Anvil::PipelineBindPoint          in_pipeline_bind_point,
+                                                                                   Anvil::PipelineLayout*            in_layout_ptr,
+                                                                                   uint32_t                          in_set,
+                                                                                   uint32_t                          in_n_writes,
+                                                                                   const Anvil::PushDescriptorWrite* in_writes_ptr,
+                                                                                   Anvil::CommandArena*              in_arena_ptr)
+    :Command(COMMAND_TYPE_PUSH_DESCRIPTOR_SET_KHR),
+     writes (Anvil::CommandArenaAllocator<Anvil::PushDescriptorWrite>(in_arena_ptr) )
+{
+    layout_ptr          = in_layout_ptr;
+    pipeline_bind_point = in_pipeline_bind_point;
+    set                 = in_set;
+
+    writes.reserve(in_n_writes);
+
+    for (uint32_t n_write = 0;
+                  n_write < in_n_writes;
+                ++n_write)
+    {
+        writes.push_back(in_writes_ptr[n_write]);
+    }
+}
+
+/** Please see header for specification */
+Anvil::CommandBufferBase::PushDescriptorSetWithTemplateKHRCommand::PushDescriptorSetWithTemplateKHRCommand(const Anvil::DescriptorUpdateTemplate* in_template_ptr,
+                                                                                                           Anvil::PipelineLayout*                 in_layout_ptr,
+                                                                                                           uint32_t                               in_set,
+                                                                                                           const void*                            in_data_ptr)
+    :Command(COMMAND_TYPE_PUSH_DESCRIPTOR_SET_WITH_TEMPLATE_KHR)
+{
+    data_ptr     = in_data_ptr;
+    layout_ptr   = in_layout_ptr;
+    set          = in_set;
+    template_ptr = in_template_ptr;
+}
+
 /** Please see header for specification */
 Anvil::CommandBufferBase::ResetEventCommand::ResetEventCommand(Anvil::Event*             in_event_ptr,
                                                                Anvil::PipelineStageFlags in_stage_mask)
@@ -826,13 +1164,15 @@ Anvil::CommandBufferBase::ResetQueryPoolCommand::ResetQueryPoolCommand(Anvil::Qu
 }
 
 /** Please see header for specification */
-Anvil::CommandBufferBase::ResolveImageCommand::ResolveImageCommand(Anvil::Image*             in_src_image_ptr,
-                                                                   Anvil::ImageLayout        in_src_image_layout,
-                                                                   Anvil::Image*             in_dst_image_ptr,
-                                                                   Anvil::ImageLayout        in_dst_image_layout,
-                                                                   uint32_t                  in_region_count,
-                                                                   const Anvil::ImageResolve* in_region_ptrs)
-    :Command(COMMAND_TYPE_RESOLVE_IMAGE)
+Anvil::CommandBufferBase::ResolveImageCommand::ResolveImageCommand(Anvil::Image*              in_src_image_ptr,
+                                                                   Anvil::ImageLayout         in_src_image_layout,
+                                                                   Anvil::Image*              in_dst_image_ptr,
+                                                                   Anvil::ImageLayout         in_dst_image_layout,
+                                                                   uint32_t                   in_region_count,
+                                                                   const Anvil::ImageResolve* in_region_ptrs,
+                                                                   Anvil::CommandArena*       in_arena_ptr)
+    :Command(COMMAND_TYPE_RESOLVE_IMAGE),
+     regions(Anvil::CommandArenaAllocator<Anvil::ImageResolve>(in_arena_ptr) )
 {
     dst_image        = in_dst_image_ptr->get_image();
     dst_image_layout = in_dst_image_layout;
@@ -841,6 +1181,8 @@ Anvil::CommandBufferBase::ResolveImageCommand::ResolveImageCommand(Anvil::Image*
     src_image_layout = in_src_image_layout;
     src_image_ptr    = in_src_image_ptr;
 
+    regions.reserve(in_region_count);
+
     for (uint32_t n_region = 0;
                   n_region < in_region_count;
                 ++n_region)
@@ -910,13 +1252,17 @@ Anvil::CommandBufferBase::SetSampleLocationsEXTCommand::SetSampleLocationsEXTCom
 }
 
 /** Please see header for specification */
-Anvil::CommandBufferBase::SetScissorCommand::SetScissorCommand(uint32_t        in_first_scissor,
-                                                               uint32_t        in_scissor_count,
-                                                               const VkRect2D* in_scissor_ptrs)
-    :Command(COMMAND_TYPE_SET_SCISSOR)
+Anvil::CommandBufferBase::SetScissorCommand::SetScissorCommand(uint32_t             in_first_scissor,
+                                                               uint32_t             in_scissor_count,
+                                                               const VkRect2D*      in_scissor_ptrs,
+                                                               Anvil::CommandArena* in_arena_ptr)
+    :Command (COMMAND_TYPE_SET_SCISSOR),
+     scissors(Anvil::CommandArenaAllocator<VkRect2D>(in_arena_ptr) )
 {
     first_scissor = in_first_scissor;
 
+    scissors.reserve(in_scissor_count);
+
     for (uint32_t n_scissor = 0;
                   n_scissor < in_scissor_count;
                 ++n_scissor)
@@ -953,13 +1299,17 @@ Anvil::CommandBufferBase::SetStencilWriteMaskCommand::SetStencilWriteMaskCommand
 }
 
 /** Please see header for specification */
-Anvil::CommandBufferBase::SetViewportCommand::SetViewportCommand(uint32_t          in_first_viewport,
-                                                                 uint32_t          in_viewport_count,
-                                                                 const VkViewport* in_viewport_ptrs)
-    :Command(COMMAND_TYPE_SET_VIEWPORT)
+Anvil::CommandBufferBase::SetViewportCommand::SetViewportCommand(uint32_t             in_first_viewport,
+                                                                 uint32_t             in_viewport_count,
+                                                                 const VkViewport*    in_viewport_ptrs,
+                                                                 Anvil::CommandArena* in_arena_ptr)
+    :Command  (COMMAND_TYPE_SET_VIEWPORT),
+     viewports(Anvil::CommandArenaAllocator<VkViewport>(in_arena_ptr) )
 {
     first_viewport = in_first_viewport;
 
+    viewports.reserve(in_viewport_count);
+
     for (uint32_t n_viewport = 0;
                   n_viewport < in_viewport_count;
                 ++n_viewport)
@@ -968,6 +1318,48 @@ Anvil::CommandBufferBase::SetViewportCommand::SetViewportCommand(uint32_t
     }
 }
 
+/** Please see header for specification */
+Anvil::CommandBufferBase::SetViewportShadingRatePaletteNVCommand::SetViewportShadingRatePaletteNVCommand(uint32_t                      in_first_viewport,
+                                                                                                         uint32_t                      in_viewport_count,
+                                                                                                         const VkShadingRatePaletteNV* in_palettes_ptr,
+                                                                                                         Anvil::CommandArena*          in_arena_ptr)
+    :Command (COMMAND_TYPE_SET_VIEWPORT_SHADING_RATE_PALETTE_NV),
+     entries (Anvil::CommandArenaAllocator<VkShadingRatePaletteEntryNV>(in_arena_ptr) ),
+     palettes(Anvil::CommandArenaAllocator<VkShadingRatePaletteNV>     (in_arena_ptr) )
+{
+    uint32_t n_total_entries = 0;
+
+    first_viewport = in_first_viewport;
+
+    for (uint32_t n_viewport = 0;
+                  n_viewport < in_viewport_count;
+                ++n_viewport)
+    {
+        n_total_entries += in_palettes_ptr[n_viewport].shadingRatePaletteEntryCount;
+    }
+
+    /* Reserve up-front so that palette entry pointers remain valid. */
+    entries.reserve (n_total_entries);
+    palettes.reserve(in_viewport_count);
+
+    for (uint32_t n_viewport = 0;
+                  n_viewport < in_viewport_count;
+                ++n_viewport)
+    {
+        const auto&            src_palette = in_palettes_ptr[n_viewport];
+        VkShadingRatePaletteNV palette;
+
+        palette.shadingRatePaletteEntryCount = src_palette.shadingRatePaletteEntryCount;
+        palette.pShadingRatePaletteEntries   = entries.data() + entries.size();
+
+        entries.insert(entries.end(),
+                       src_palette.pShadingRatePaletteEntries,
+                       src_palette.pShadingRatePaletteEntries + src_palette.shadingRatePaletteEntryCount);
+
+        palettes.push_back(palette);
+    }
+}
+
 /** Please see header for specification */
 Anvil::CommandBufferBase::UpdateBufferCommand::UpdateBufferCommand(Anvil::Buffer* in_dst_buffer_ptr,
                                                                    VkDeviceSize   in_dst_offset,
@@ -992,12 +1384,21 @@ Anvil::CommandBufferBase::WaitEventsCommand::WaitEventsCommand(uint32_t
                                                                uint32_t                   in_buffer_memory_barrier_count,
                                                                const BufferBarrier* const in_buffer_memory_barriers_ptr,
                                                                uint32_t                   in_image_memory_barrier_count,
-                                                               const ImageBarrier* const  in_image_memory_barriers_ptr)
-    :Command(COMMAND_TYPE_WAIT_EVENTS)
+                                                               const ImageBarrier* const  in_image_memory_barriers_ptr,
+                                                               Anvil::CommandArena*       in_arena_ptr)
+    :Command        (COMMAND_TYPE_WAIT_EVENTS),
+     buffer_barriers(Anvil::CommandArenaAllocator<BufferBarrier>(in_arena_ptr) ),
+     image_barriers (Anvil::CommandArenaAllocator<ImageBarrier>(in_arena_ptr) ),
+     memory_barriers(Anvil::CommandArenaAllocator<MemoryBarrier>(in_arena_ptr) ),
+     events         (Anvil::CommandArenaAllocator<VkEvent>(in_arena_ptr) ),
+     event_ptrs     (Anvil::CommandArenaAllocator<Anvil::Event*>(in_arena_ptr) )
 {
     dst_stage_mask = in_dst_stage_mask;
     src_stage_mask = in_src_stage_mask;
 
+    events.reserve    (in_event_count);
+    event_ptrs.reserve(in_event_count);
+
     for (uint32_t n_event = 0;
                   n_event < in_event_count;
                 ++n_event)
@@ -1006,6 +1407,66 @@ Anvil::CommandBufferBase::WaitEventsCommand::WaitEventsCommand(uint32_t
         event_ptrs.push_back(in_event_ptrs[n_event]);
     }
 
+    buffer_barriers.reserve(in_buffer_memory_barrier_count);
+
+    for (uint32_t n_buffer_memory_barrier = 0;
+                  n_buffer_memory_barrier < in_buffer_memory_barrier_count;
+                ++n_buffer_memory_barrier)
+    {
+        buffer_barriers.push_back(in_buffer_memory_barriers_ptr[n_buffer_memory_barrier]);
+    }
+
+    image_barriers.reserve(in_image_memory_barrier_count);
+
+    for (uint32_t n_image_memory_barrier = 0;
+                  n_image_memory_barrier < in_image_memory_barrier_count;
+                ++n_image_memory_barrier)
+    {
+        image_barriers.push_back(in_image_memory_barriers_ptr[n_image_memory_barrier]);
+    }
+
+    memory_barriers.reserve(in_memory_barrier_count);
+
+    for (uint32_t n_memory_barrier = 0;
+                  n_memory_barrier < in_memory_barrier_count;
+                ++n_memory_barrier)
+    {
+        memory_barriers.push_back(in_memory_barriers_ptr[n_memory_barrier]);
+    }
+}
+
+/** Please see header for specification */
+Anvil::CommandBufferBase::WaitEventsRawCommand::WaitEventsRawCommand(uint32_t                      in_event_count,
+                                                                     Anvil::Event* const*          in_event_ptrs,
+                                                                     Anvil::PipelineStageFlags     in_src_stage_mask,
+                                                                     Anvil::PipelineStageFlags     in_dst_stage_mask,
+                                                                     uint32_t                      in_memory_barrier_count,
+                                                                     const RawMemoryBarrier* const in_memory_barriers_ptr,
+                                                                     uint32_t                      in_buffer_memory_barrier_count,
+                                                                     const RawBufferBarrier* const in_buffer_memory_barriers_ptr,
+                                                                     uint32_t                      in_image_memory_barrier_count,
+                                                                     const RawImageBarrier*  const in_image_memory_barriers_ptr,
+                                                                     Anvil::CommandArena*          in_arena_ptr)
+    :Command        (COMMAND_TYPE_WAIT_EVENTS_RAW),
+     buffer_barriers(Anvil::CommandArenaAllocator<RawBufferBarrier>(in_arena_ptr) ),
+     image_barriers (Anvil::CommandArenaAllocator<RawImageBarrier>(in_arena_ptr) ),
+     memory_barriers(Anvil::CommandArenaAllocator<RawMemoryBarrier>(in_arena_ptr) ),
+     event_ptrs     (Anvil::CommandArenaAllocator<Anvil::Event*>(in_arena_ptr) )
+{
+    dst_stage_mask = in_dst_stage_mask;
+    src_stage_mask = in_src_stage_mask;
+
+    event_ptrs.reserve(in_event_count);
+
+    for (uint32_t n_event = 0;
+                  n_event < in_event_count;
+                ++n_event)
+    {
+        event_ptrs.push_back(in_event_ptrs[n_event]);
+    }
+
+    buffer_barriers.reserve(in_buffer_memory_barrier_count);
+
     for (uint32_t n_buffer_memory_barrier = 0;
                   n_buffer_memory_barrier < in_buffer_memory_barrier_count;
                 ++n_buffer_memory_barrier)
@@ -1013,6 +1474,8 @@ Anvil::CommandBufferBase::WaitEventsCommand::WaitEventsCommand(uint32_t
         buffer_barriers.push_back(in_buffer_memory_barriers_ptr[n_buffer_memory_barrier]);
     }
 
+    image_barriers.reserve(in_image_memory_barrier_count);
+
     for (uint32_t n_image_memory_barrier = 0;
                   n_image_memory_barrier < in_image_memory_barrier_count;
                 ++n_image_memory_barrier)
@@ -1020,6 +1483,8 @@ Anvil::CommandBufferBase::WaitEventsCommand::WaitEventsCommand(uint32_t
         image_barriers.push_back(in_image_memory_barriers_ptr[n_image_memory_barrier]);
     }
 
+    memory_barriers.reserve(in_memory_barrier_count);
+
     for (uint32_t n_memory_barrier = 0;
                   n_memory_barrier < in_memory_barrier_count;
                 ++n_memory_barrier)
@@ -1028,6 +1493,24 @@ Anvil::CommandBufferBase::WaitEventsCommand::WaitEventsCommand(uint32_t
     }
 }
 
+/** Please see header for specification */
+Anvil::CommandBufferBase::WriteAccelerationStructuresPropertiesKHRCommand::WriteAccelerationStructuresPropertiesKHRCommand(uint32_t                             in_n_acceleration_structures,
+                                                                                                                           Anvil::AccelerationStructure* const* in_acceleration_structure_ptrs,
+                                                                                                                           VkQueryType                          in_query_type,
+                                                                                                                           Anvil::QueryPool*                    in_query_pool_ptr,
+                                                                                                                           Anvil::QueryIndex                    in_first_query,
+                                                                                                                           Anvil::CommandArena*                 in_arena_ptr)
+    :Command                    (COMMAND_TYPE_WRITE_ACCELERATION_STRUCTURES_PROPERTIES_KHR),
+     acceleration_structure_ptrs(Anvil::CommandArenaAllocator<Anvil::AccelerationStructure*>(in_arena_ptr) )
+{
+    first_query    = in_first_query;
+    query_pool_ptr = in_query_pool_ptr;
+    query_type     = in_query_type;
+
+    acceleration_structure_ptrs.assign(in_acceleration_structure_ptrs,
+                                       in_acceleration_structure_ptrs + in_n_acceleration_structures);
+}
+
 /** Please see header for specification */
 Anvil::CommandBufferBase::WriteBufferMarkerAMDCommand::WriteBufferMarkerAMDCommand(const Anvil::PipelineStageFlagBits& in_pipeline_stage,
                                                                                    Anvil::Buffer*                      in_dst_buffer_ptr,
@@ -1067,17 +1550,32 @@ Anvil::CommandBufferBase::CommandBufferBase(const Anvil::BaseDevice* in_device_p
      DebugMarkerSupportProvider     (in_device_ptr,
                                      Anvil::ObjectType::COMMAND_BUFFER),
      CallbacksSupportProvider       (COMMAND_BUFFER_CALLBACK_ID_COUNT),
+     m_barrier_batching_enabled     (false),
      m_command_buffer               (VK_NULL_HANDLE),
      m_device_mask                  (0),
-     m_device_ptr                   (in_device_ptr),
-     m_is_renderpass_active         (false),
-     m_n_debug_label_regions_started(0),
-     m_parent_command_pool_ptr      (in_parent_command_pool_ptr),
-     m_recording_in_progress        (false),
-     m_renderpass_device_mask       (0),
-     m_type                         (in_type)
+     m_device_ptr                     (in_device_ptr),
+     m_is_conditional_rendering_active(false),
+     m_is_dynamic_rendering_active    (false),
+     m_is_renderpass_active           (false),
+     m_n_debug_label_regions_started  (0),
+     m_n_filtered_state_calls         (0),
+     m_n_recorded_commands            (0),
+     m_n_recorded_pipeline_binds      (0),
+     m_parent_command_pool_ptr        (in_parent_command_pool_ptr),
+     m_recording_in_progress          (false),
+     m_renderpass_device_mask         (0),
+     m_state_filtering_enabled        (false),
+     m_type                           (in_type)
 {
     anvil_assert(in_parent_command_pool_ptr != nullptr);
+
+    m_bound_state.clear     ();
+    m_pending_barriers.clear();
+
+    if (in_parent_command_pool_ptr != nullptr)
+    {
+        in_parent_command_pool_ptr->on_command_buffer_allocated();
+    }
 }
 
 /** Destructor.
@@ -1097,10 +1595,10 @@ Anvil::CommandBufferBase::~CommandBufferBase()
         m_parent_command_pool_ptr->lock();
         lock();
         {
-            Anvil::Vulkan::vkFreeCommandBuffers(m_device_ptr->get_device_vk(),
-                                                m_parent_command_pool_ptr->get_command_pool(),
-                                                1, /* commandBufferCount */
-                                               &m_command_buffer);
+            m_device_ptr->get_dispatch_table().vkFreeCommandBuffers(m_device_ptr->get_device_vk(),
+                                                                    m_parent_command_pool_ptr->get_command_pool(),
+                                                                    1, /* commandBufferCount */
+                                                                   &m_command_buffer);
         }
         unlock();
         m_parent_command_pool_ptr->unlock();
@@ -1108,6 +1606,11 @@ Anvil::CommandBufferBase::~CommandBufferBase()
         m_command_buffer = VK_NULL_HANDLE;
     }
 
+    if (m_parent_command_pool_ptr != nullptr)
+    {
+        m_parent_command_pool_ptr->on_command_buffer_released();
+    }
+
     #ifdef STORE_COMMAND_BUFFER_COMMANDS
     {
         clear_commands();
@@ -1136,6 +1639,10 @@ void Anvil::CommandBufferBase::begin_debug_utils_label(const char*  in_label_nam
         label_info.pNext      = nullptr;
         label_info.sType      = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
 
+        flush_pending_barriers();
+
+        m_n_recorded_commands++;
+
         entrypoints.vkCmdBeginDebugUtilsLabelEXT(m_command_buffer,
                                                  &label_info);
     }
@@ -1146,10 +1653,17 @@ end:
 }
 
 #ifdef STORE_COMMAND_BUFFER_COMMANDS
-    /** Clears the command vector by releasing all command descriptors back to the heap memory. */
+    /** Destroys all stashed command descriptors and rewinds the command arena. Storage used by both the
+     *  command vector and the arena is retained, so that subsequent recordings do not hit the heap. */
     void Anvil::CommandBufferBase::clear_commands()
     {
-        m_commands.clear();
+        for (auto current_command_ptr : m_commands)
+        {
+            current_command_ptr->~Command();
+        }
+
+        m_commands.clear     ();
+        m_command_arena.reset();
     }
 #endif
 
@@ -1171,6 +1685,10 @@ void Anvil::CommandBufferBase::end_debug_utils_label()
     {
         const auto& entrypoints = m_device_ptr->get_parent_instance()->get_extension_ext_debug_utils_entrypoints();
 
+        flush_pending_barriers();
+
+        m_n_recorded_commands++;
+
         entrypoints.vkCmdEndDebugUtilsLabelEXT(m_command_buffer);
     }
 
@@ -1179,36 +1697,243 @@ end:
     ;
 }
 
-/** Please see header for specification */
-void Anvil::CommandBufferBase::insert_debug_utils_label(const char*  in_label_name_ptr,
-                                                        const float* in_color_vec4_ptr)
+/** Checks if a stencil state call would set the same values as the ones already cached for all faces
+ *  specified by @param in_face_mask. If not, the cache is updated with the new value.
+ *
+ *  @param in_face_mask     Faces the call affects.
+ *  @param in_value         Value the call sets.
+ *  @param in_back_bit      BoundState bit which tells whether the back face value is known.
+ *  @param in_front_bit     BoundState bit which tells whether the front face value is known.
+ *  @param inout_values_ptr Cached values for back & front faces, in this order. Must not be null.
+ *
+ *  @return true if the call is redundant, false otherwise.
+ **/
+bool Anvil::CommandBufferBase::filter_stencil_state(Anvil::StencilFaceFlags in_face_mask,
+                                                    uint32_t                in_value,
+                                                    uint32_t                in_back_bit,
+                                                    uint32_t                in_front_bit,
+                                                    uint32_t*               inout_values_ptr)
 {
-    if (!m_device_ptr->get_parent_instance()->get_enabled_extensions_info()->ext_debug_utils() )
+    const bool affects_back  = (in_face_mask & Anvil::StencilFaceFlagBits::BACK_BIT)  != 0;
+    const bool affects_front = (in_face_mask & Anvil::StencilFaceFlagBits::FRONT_BIT) != 0;
+    bool       result        = true;
+
+    if (affects_back)
     {
-        goto end;
+        result &= ((m_bound_state.valid_state_bits & in_back_bit) != 0 &&
+                   inout_values_ptr[0]                            == in_value);
+
+        inout_values_ptr[0]             = in_value;
+        m_bound_state.valid_state_bits |= in_back_bit;
     }
 
+    if (affects_front)
     {
-        const auto&          entrypoints = m_device_ptr->get_parent_instance()->get_extension_ext_debug_utils_entrypoints();
-        VkDebugUtilsLabelEXT label_info;
-
-        label_info.color[0]   = in_color_vec4_ptr[0];
-        label_info.color[1]   = in_color_vec4_ptr[1];
-        label_info.color[2]   = in_color_vec4_ptr[2];
-        label_info.color[3]   = in_color_vec4_ptr[3];
-        label_info.pLabelName = in_label_name_ptr;
-        label_info.pNext      = nullptr;
-        label_info.sType      = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+        result &= ((m_bound_state.valid_state_bits & in_front_bit) != 0 &&
+                   inout_values_ptr[1]                             == in_value);
 
-        entrypoints.vkCmdInsertDebugUtilsLabelEXT(m_command_buffer,
-                                                 &label_info);
+        inout_values_ptr[1]             = in_value;
+        m_bound_state.valid_state_bits |= in_front_bit;
     }
 
-end:
-    ;
+    return result;
 }
 
-/* Please see header for specification */
+/** Please see header for specification */
+void Anvil::CommandBufferBase::flush_pending_barriers()
+{
+    if (m_pending_barriers.is_empty() )
+    {
+        goto end;
+    }
+
+    m_parent_command_pool_ptr->lock();
+    lock();
+    {
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdPipelineBarrier(m_command_buffer,
+                                                                m_pending_barriers.src_stage_mask.get_vk  (),
+                                                                m_pending_barriers.dst_stage_mask.get_vk  (),
+                                                                m_pending_barriers.dependency_flags.get_vk(),
+                                                                static_cast<uint32_t>(m_pending_barriers.memory_barriers.size() ),
+                                                                (m_pending_barriers.memory_barriers.size() > 0) ? &m_pending_barriers.memory_barriers.at(0) : nullptr,
+                                                                static_cast<uint32_t>(m_pending_barriers.buffer_barriers.size() ),
+                                                                (m_pending_barriers.buffer_barriers.size() > 0) ? &m_pending_barriers.buffer_barriers.at(0) : nullptr,
+                                                                static_cast<uint32_t>(m_pending_barriers.image_barriers.size() ),
+                                                                (m_pending_barriers.image_barriers.size() > 0)  ? &m_pending_barriers.image_barriers.at(0)  : nullptr);
+    }
+    unlock();
+    m_parent_command_pool_ptr->unlock();
+
+    m_pending_barriers.clear();
+end:
+    ;
+}
+
+/** Please see header for specification */
+void Anvil::CommandBufferBase::insert_debug_utils_label(const char*  in_label_name_ptr,
+                                                        const float* in_color_vec4_ptr)
+{
+    if (!m_device_ptr->get_parent_instance()->get_enabled_extensions_info()->ext_debug_utils() )
+    {
+        goto end;
+    }
+
+    {
+        const auto&          entrypoints = m_device_ptr->get_parent_instance()->get_extension_ext_debug_utils_entrypoints();
+        VkDebugUtilsLabelEXT label_info;
+
+        label_info.color[0]   = in_color_vec4_ptr[0];
+        label_info.color[1]   = in_color_vec4_ptr[1];
+        label_info.color[2]   = in_color_vec4_ptr[2];
+        label_info.color[3]   = in_color_vec4_ptr[3];
+        label_info.pLabelName = in_label_name_ptr;
+        label_info.pNext      = nullptr;
+        label_info.sType      = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+
+        flush_pending_barriers();
+
+        m_n_recorded_commands++;
+
+        entrypoints.vkCmdInsertDebugUtilsLabelEXT(m_command_buffer,
+                                                 &label_info);
+    }
+
+end:
+    ;
+}
+
+/** Forgets all cached dynamic state, except for state which the specified graphics pipeline declares
+ *  as dynamic. Binding a pipeline overwrites all of its static state.
+ *
+ *  @param in_graphics_pipeline_id ID of the graphics pipeline which has just been bound.
+ **/
+void Anvil::CommandBufferBase::invalidate_dynamic_states(Anvil::PipelineID in_graphics_pipeline_id)
+{
+    auto                       create_info_ptr    = static_cast<const Anvil::GraphicsPipelineCreateInfo*>(m_device_ptr->get_graphics_pipeline_manager()->get_pipeline_create_info(in_graphics_pipeline_id) );
+    const Anvil::DynamicState* dynamic_states_ptr = nullptr;
+    uint32_t                   n_dynamic_states   = 0;
+    bool                       preserve_scissors  = false;
+    bool                       preserve_viewports = false;
+    uint32_t                   preserved_bits     = BoundState::INDEX_BUFFER_BIT;
+
+    if (create_info_ptr != nullptr)
+    {
+        create_info_ptr->get_enabled_dynamic_states(&dynamic_states_ptr,
+                                                    &n_dynamic_states);
+    }
+
+    for (uint32_t n_dynamic_state = 0;
+                  n_dynamic_state < n_dynamic_states;
+                ++n_dynamic_state)
+    {
+        switch (dynamic_states_ptr[n_dynamic_state])
+        {
+            case Anvil::DynamicState::BLEND_CONSTANTS:      preserved_bits     |= BoundState::BLEND_CONSTANTS_BIT;                                                     break;
+            case Anvil::DynamicState::DEPTH_BIAS:           preserved_bits     |= BoundState::DEPTH_BIAS_BIT;                                                          break;
+            case Anvil::DynamicState::DEPTH_BOUNDS:         preserved_bits     |= BoundState::DEPTH_BOUNDS_BIT;                                                        break;
+            case Anvil::DynamicState::LINE_WIDTH:           preserved_bits     |= BoundState::LINE_WIDTH_BIT;                                                          break;
+            case Anvil::DynamicState::SCISSOR:              preserve_scissors   = true;                                                                                break;
+            case Anvil::DynamicState::STENCIL_COMPARE_MASK: preserved_bits     |= BoundState::STENCIL_BACK_COMPARE_MASK_BIT | BoundState::STENCIL_FRONT_COMPARE_MASK_BIT; break;
+            case Anvil::DynamicState::STENCIL_REFERENCE:    preserved_bits     |= BoundState::STENCIL_BACK_REFERENCE_BIT    | BoundState::STENCIL_FRONT_REFERENCE_BIT;    break;
+            case Anvil::DynamicState::STENCIL_WRITE_MASK:   preserved_bits     |= BoundState::STENCIL_BACK_WRITE_MASK_BIT   | BoundState::STENCIL_FRONT_WRITE_MASK_BIT;   break;
+            case Anvil::DynamicState::VIEWPORT:             preserve_viewports  = true;                                                                                break;
+
+            default:
+            {
+                /* Not cached */
+            }
+        }
+    }
+
+    m_bound_state.valid_state_bits &= preserved_bits;
+
+    if (!preserve_scissors)
+    {
+        m_bound_state.scissors_valid.clear();
+    }
+
+    if (!preserve_viewports)
+    {
+        m_bound_state.viewports_valid.clear();
+    }
+}
+
+/* Please see header for specification */
+bool Anvil::CommandBufferBase::record_begin_conditional_rendering_EXT(Anvil::Buffer*                   in_buffer_ptr,
+                                                                      VkDeviceSize                     in_offset,
+                                                                      Anvil::ConditionalRenderingFlags in_flags)
+{
+    /* NOTE: The command can be executed both inside and outside a renderpass */
+    VkConditionalRenderingBeginInfoEXT                  begin_info;
+    Anvil::ExtensionEXTConditionalRenderingEntrypoints entrypoints;
+    bool                                               result     (false);
+
+    if (m_is_conditional_rendering_active)
+    {
+        anvil_assert(!m_is_conditional_rendering_active);
+
+        goto end;
+    }
+
+    if (!m_recording_in_progress)
+    {
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
+    }
+
+    if ((in_offset % 4) != 0)
+    {
+        anvil_assert((in_offset % 4) == 0);
+
+        goto end;
+    }
+
+    #ifdef STORE_COMMAND_BUFFER_COMMANDS
+    {
+        if (!m_command_stashing_disabled)
+        {
+            m_commands.push_back(m_command_arena.create<BeginConditionalRenderingEXTCommand>(in_buffer_ptr,
+                                                                                             in_offset,
+                                                                                             in_flags) );
+        }
+    }
+    #endif
+
+    entrypoints = m_device_ptr->get_extension_ext_conditional_rendering_entrypoints();
+
+    track_buffer_access(in_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::CONDITIONAL_RENDERING_BIT_EXT,
+                        Anvil::AccessFlagBits::CONDITIONAL_RENDERING_READ_BIT_EXT);
+
+    flush_pending_barriers();
+
+    begin_info.buffer = in_buffer_ptr->get_buffer();
+    begin_info.flags  = in_flags.get_vk();
+    begin_info.offset = in_offset;
+    begin_info.pNext  = nullptr;
+    begin_info.sType  = VK_STRUCTURE_TYPE_CONDITIONAL_RENDERING_BEGIN_INFO_EXT;
+
+    m_parent_command_pool_ptr->lock();
+    lock();
+    {
+        m_n_recorded_commands++;
+
+        entrypoints.vkCmdBeginConditionalRenderingEXT(m_command_buffer,
+                                                     &begin_info);
+    }
+    unlock();
+    m_parent_command_pool_ptr->unlock();
+
+    m_is_conditional_rendering_active = true;
+    result                            = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
 bool Anvil::CommandBufferBase::record_begin_query(Anvil::QueryPool*        in_query_pool_ptr,
                                                   Anvil::QueryIndex        in_entry,
                                                   Anvil::QueryControlFlags in_flags)
@@ -1227,20 +1952,24 @@ bool Anvil::CommandBufferBase::record_begin_query(Anvil::QueryPool*        in_qu
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(BeginQueryCommand(in_query_pool_ptr,
-                                                   in_entry,
-                                                   in_flags) );
+            m_commands.push_back(m_command_arena.create<BeginQueryCommand>(in_query_pool_ptr,
+                                                                           in_entry,
+                                                                           in_flags) );
         }
     }
     #endif
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdBeginQuery(m_command_buffer,
-                                       in_query_pool_ptr->get_query_pool(),
-                                       in_entry,
-                                       in_flags.get_vk() );
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdBeginQuery(m_command_buffer,
+                                                           in_query_pool_ptr->get_query_pool(),
+                                                           in_entry,
+                                                           in_flags.get_vk() );
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -1271,17 +2000,21 @@ bool Anvil::CommandBufferBase::record_begin_query_indexed(Anvil::QueryPool*
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(BeginQueryIndexedEXTCommand(in_query_pool_ptr,
-                                                             in_query,
-                                                             in_flags,
-                                                             in_index) );
+            m_commands.push_back(m_command_arena.create<BeginQueryIndexedEXTCommand>(in_query_pool_ptr,
+                                                                                     in_query,
+                                                                                     in_flags,
+                                                                                     in_index) );
         }
     }
     #endif
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
+        m_n_recorded_commands++;
+
         entrypoints.vkCmdBeginQueryIndexedEXT(m_command_buffer,
                                               in_query_pool_ptr->get_query_pool(),
                                               in_query,
@@ -1296,15 +2029,177 @@ end:
     return result;
 }
 
+/* Please see header for specification */
+bool Anvil::CommandBufferBase::record_begin_rendering_KHR(const VkRect2D&                       in_render_area,
+                                                          uint32_t                              in_layer_count,
+                                                          uint32_t                              in_view_mask,
+                                                          uint32_t                              in_n_color_attachments,
+                                                          const Anvil::RenderingAttachmentInfo* in_opt_color_attachments_ptr,
+                                                          const Anvil::RenderingAttachmentInfo* in_opt_depth_attachment_ptr,
+                                                          const Anvil::RenderingAttachmentInfo* in_opt_stencil_attachment_ptr,
+                                                          Anvil::RenderingFlags                 in_flags)
+{
+    ScratchArray<VkRenderingAttachmentInfoKHR, N_MAX_STACK_SCRATCH_ITEMS> color_attachments_vk (in_n_color_attachments);
+    VkRenderingAttachmentInfoKHR                                          depth_attachment_vk;
+    Anvil::ExtensionKHRDynamicRenderingEntrypoints                        entrypoints;
+    VkRenderingInfoKHR                                                    rendering_info;
+    bool                                                                  result               (false);
+    VkRenderingAttachmentInfoKHR                                          stencil_attachment_vk;
+
+    if (m_is_renderpass_active)
+    {
+        anvil_assert(!m_is_renderpass_active);
+
+        goto end;
+    }
+
+    if (!m_recording_in_progress)
+    {
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
+    }
+
+    if (in_n_color_attachments       >  0      &&
+        in_opt_color_attachments_ptr == nullptr)
+    {
+        anvil_assert(in_opt_color_attachments_ptr != nullptr);
+
+        goto end;
+    }
+
+    anvil_assert(m_device_ptr->get_extension_info()->khr_dynamic_rendering() );
+
+    #ifdef STORE_COMMAND_BUFFER_COMMANDS
+    {
+        if (!m_command_stashing_disabled)
+        {
+            m_commands.push_back(m_command_arena.create<BeginRenderingKHRCommand>(in_render_area,
+                                                                                  in_layer_count,
+                                                                                  in_view_mask,
+                                                                                  in_n_color_attachments,
+                                                                                  in_opt_color_attachments_ptr,
+                                                                                  in_opt_depth_attachment_ptr,
+                                                                                  in_opt_stencil_attachment_ptr,
+                                                                                  in_flags) );
+        }
+    }
+    #endif
+
+    entrypoints = m_device_ptr->get_extension_khr_dynamic_rendering_entrypoints();
+
+    /* Attachments stay in their rendering layouts once the instance ends */
+    for (uint32_t n_color_attachment = 0;
+                  n_color_attachment < in_n_color_attachments;
+                ++n_color_attachment)
+    {
+        const auto& current_attachment = in_opt_color_attachments_ptr[n_color_attachment];
+
+        color_attachments_vk.at(n_color_attachment) = current_attachment.get_vk();
+
+        if (current_attachment.image_view_ptr != nullptr)
+        {
+            track_image_access(current_attachment.image_view_ptr->get_create_info_ptr()->get_parent_image(),
+                               current_attachment.image_view_ptr->get_subresource_range(),
+                               current_attachment.image_layout,
+                               Anvil::PipelineStageFlagBits::COLOR_ATTACHMENT_OUTPUT_BIT,
+                               Anvil::AccessFlagBits::COLOR_ATTACHMENT_READ_BIT | Anvil::AccessFlagBits::COLOR_ATTACHMENT_WRITE_BIT);
+        }
+
+        if (current_attachment.resolve_image_view_ptr != nullptr)
+        {
+            track_image_access(current_attachment.resolve_image_view_ptr->get_create_info_ptr()->get_parent_image(),
+                               current_attachment.resolve_image_view_ptr->get_subresource_range(),
+                               current_attachment.resolve_image_layout,
+                               Anvil::PipelineStageFlagBits::COLOR_ATTACHMENT_OUTPUT_BIT,
+                               Anvil::AccessFlagBits::COLOR_ATTACHMENT_WRITE_BIT);
+        }
+    }
+
+    for (uint32_t n_ds_attachment = 0;
+                  n_ds_attachment < 2;
+                ++n_ds_attachment)
+    {
+        const Anvil::RenderingAttachmentInfo* attachment_ptr = (n_ds_attachment == 0) ? in_opt_depth_attachment_ptr
+                                                                                      : in_opt_stencil_attachment_ptr;
+
+        if (attachment_ptr == nullptr)
+        {
+            continue;
+        }
+
+        if (attachment_ptr->image_view_ptr != nullptr)
+        {
+            track_image_access(attachment_ptr->image_view_ptr->get_create_info_ptr()->get_parent_image(),
+                               attachment_ptr->image_view_ptr->get_subresource_range(),
+                               attachment_ptr->image_layout,
+                               Anvil::PipelineStageFlagBits::EARLY_FRAGMENT_TESTS_BIT          | Anvil::PipelineStageFlagBits::LATE_FRAGMENT_TESTS_BIT,
+                               Anvil::AccessFlagBits::DEPTH_STENCIL_ATTACHMENT_READ_BIT | Anvil::AccessFlagBits::DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+        }
+
+        if (attachment_ptr->resolve_image_view_ptr != nullptr)
+        {
+            track_image_access(attachment_ptr->resolve_image_view_ptr->get_create_info_ptr()->get_parent_image(),
+                               attachment_ptr->resolve_image_view_ptr->get_subresource_range(),
+                               attachment_ptr->resolve_image_layout,
+                               Anvil::PipelineStageFlagBits::EARLY_FRAGMENT_TESTS_BIT | Anvil::PipelineStageFlagBits::LATE_FRAGMENT_TESTS_BIT,
+                               Anvil::AccessFlagBits::DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+        }
+    }
+
+    if (in_opt_depth_attachment_ptr != nullptr)
+    {
+        depth_attachment_vk = in_opt_depth_attachment_ptr->get_vk();
+    }
+
+    if (in_opt_stencil_attachment_ptr != nullptr)
+    {
+        stencil_attachment_vk = in_opt_stencil_attachment_ptr->get_vk();
+    }
+
+    rendering_info.colorAttachmentCount = in_n_color_attachments;
+    rendering_info.flags                = in_flags.get_vk();
+    rendering_info.layerCount           = in_layer_count;
+    rendering_info.pColorAttachments    = (in_n_color_attachments > 0)              ? &color_attachments_vk.at(0)
+                                                                                    : nullptr;
+    rendering_info.pDepthAttachment     = (in_opt_depth_attachment_ptr   != nullptr) ? &depth_attachment_vk
+                                                                                    : nullptr;
+    rendering_info.pNext                = nullptr;
+    rendering_info.pStencilAttachment   = (in_opt_stencil_attachment_ptr != nullptr) ? &stencil_attachment_vk
+                                                                                    : nullptr;
+    rendering_info.renderArea           = in_render_area;
+    rendering_info.sType                = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+    rendering_info.viewMask             = in_view_mask;
+
+    flush_pending_barriers();
+
+    m_parent_command_pool_ptr->lock();
+    lock();
+    {
+        m_n_recorded_commands++;
+
+        entrypoints.vkCmdBeginRenderingKHR(m_command_buffer,
+                                          &rendering_info);
+    }
+    unlock();
+    m_parent_command_pool_ptr->unlock();
+
+    m_is_dynamic_rendering_active = true;
+    m_is_renderpass_active        = true;
+    result                        = true;
+end:
+    return result;
+}
+
 /* Please see header for specification */
 bool Anvil::CommandBufferBase::record_begin_transform_feedback_EXT(const uint32_t&     in_first_counter_buffer,
                                                                    const uint32_t&     in_n_counter_buffers,
                                                                    Anvil::Buffer**     in_opt_counter_buffer_ptrs,
                                                                    const VkDeviceSize* in_opt_counter_buffer_offsets)
 {
-    auto        counter_buffer_ptrs = std::vector<VkBuffer>(in_n_counter_buffers);
-    const auto& entrypoints         = m_device_ptr->get_extension_ext_transform_feedback_entrypoints();
-    bool        result              = false;
+    ScratchArray<VkBuffer, N_MAX_STACK_SCRATCH_ITEMS> counter_buffer_ptrs(in_n_counter_buffers);
+    const auto&                                       entrypoints        (m_device_ptr->get_extension_ext_transform_feedback_entrypoints() );
+    bool                                              result             (false);
 
     if (!m_is_renderpass_active)
     {
@@ -1352,16 +2247,20 @@ bool Anvil::CommandBufferBase::record_begin_transform_feedback_EXT(const uint32_
                 }
             }
 
-            m_commands.push_back(BeginTransformFeedbackEXTCommand(in_first_counter_buffer,
-                                                                  buffer_ptr_vec,
-                                                                  offset_vec) );
+            m_commands.push_back(m_command_arena.create<BeginTransformFeedbackEXTCommand>(in_first_counter_buffer,
+                                                                                          buffer_ptr_vec,
+                                                                                          offset_vec) );
         }
     }
     #endif
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
+        m_n_recorded_commands++;
+
         entrypoints.vkCmdBeginTransformFeedbackEXT(m_command_buffer,
                                                    in_first_counter_buffer,
                                                    in_n_counter_buffers,
@@ -1386,8 +2285,8 @@ bool Anvil::CommandBufferBase::record_bind_descriptor_sets(Anvil::PipelineBindPo
                                                            const uint32_t*                    in_dynamic_offset_ptrs)
 {
     /* Note: Command supported inside and outside the renderpass. */
-    auto dss_vk = std::vector<VkDescriptorSet>(in_set_count);
-    bool result = false;
+    ScratchArray<VkDescriptorSet, N_MAX_STACK_SCRATCH_ITEMS> dss_vk(in_set_count);
+    bool                                                     result(false);
 
     for (uint32_t n_set = 0;
                   n_set < in_set_count;
@@ -1407,28 +2306,83 @@ bool Anvil::CommandBufferBase::record_bind_descriptor_sets(Anvil::PipelineBindPo
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(BindDescriptorSetsCommand(in_pipeline_bind_point,
-                                                           in_layout_ptr,
-                                                           in_first_set,
-                                                           in_set_count,
-                                                           in_descriptor_set_ptrs,
-                                                           in_dynamic_offset_count,
-                                                           in_dynamic_offset_ptrs) );
+            m_commands.push_back(m_command_arena.create<BindDescriptorSetsCommand>(in_pipeline_bind_point,
+                                                                                   in_layout_ptr,
+                                                                                   in_first_set,
+                                                                                   in_set_count,
+                                                                                   in_descriptor_set_ptrs,
+                                                                                   in_dynamic_offset_count,
+                                                                                   in_dynamic_offset_ptrs,
+                                                                                   &m_command_arena) );
         }
     }
     #endif
 
+    if (m_state_filtering_enabled                      &&
+        static_cast<uint32_t>(in_pipeline_bind_point) < 2)
+    {
+        auto&                  bound_sets   = m_bound_state.descriptor_sets[static_cast<uint32_t>(in_pipeline_bind_point)];
+        auto&                  bound_layout = m_bound_state.pipeline_layouts[static_cast<uint32_t>(in_pipeline_bind_point)];
+        const VkPipelineLayout layout_vk    = in_layout_ptr->get_pipeline_layout();
+
+        /* Sets with dynamic descriptors can only be bound together with dynamic offsets, so they never end up in the cache */
+        if (in_dynamic_offset_count == 0                        &&
+            bound_layout            == layout_vk                &&
+            bound_sets.size()       >= in_first_set + in_set_count)
+        {
+            bool is_redundant = true;
+
+            for (uint32_t n_set = 0;
+                          n_set < in_set_count && is_redundant;
+                        ++n_set)
+            {
+                is_redundant = (bound_sets.at(in_first_set + n_set) == dss_vk.at(n_set) );
+            }
+
+            if (is_redundant)
+            {
+                m_n_filtered_state_calls++;
+
+                result = true;
+                goto end;
+            }
+        }
+
+        if (bound_layout != layout_vk)
+        {
+            bound_layout = layout_vk;
+
+            bound_sets.clear();
+        }
+
+        if (bound_sets.size() < in_first_set + in_set_count)
+        {
+            bound_sets.resize(in_first_set + in_set_count,
+                              VK_NULL_HANDLE);
+        }
+
+        for (uint32_t n_set = 0;
+                      n_set < in_set_count;
+                    ++n_set)
+        {
+            bound_sets.at(in_first_set + n_set) = (in_dynamic_offset_count == 0) ? dss_vk.at(n_set)
+                                                                                 : VK_NULL_HANDLE;
+        }
+    }
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdBindDescriptorSets(m_command_buffer,
-                                               static_cast<VkPipelineBindPoint>(in_pipeline_bind_point),
-                                               in_layout_ptr->get_pipeline_layout(),
-                                               in_first_set,
-                                               in_set_count,
-                                               (in_set_count > 0) ? &dss_vk.at(0) : nullptr,
-                                               in_dynamic_offset_count,
-                                               in_dynamic_offset_ptrs);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdBindDescriptorSets(m_command_buffer,
+                                                                   static_cast<VkPipelineBindPoint>(in_pipeline_bind_point),
+                                                                   in_layout_ptr->get_pipeline_layout(),
+                                                                   in_first_set,
+                                                                   in_set_count,
+                                                                   (in_set_count > 0) ? &dss_vk.at(0) : nullptr,
+                                                                   in_dynamic_offset_count,
+                                                                   in_dynamic_offset_ptrs);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -1457,20 +2411,45 @@ bool Anvil::CommandBufferBase::record_bind_index_buffer(Anvil::Buffer*   in_buff
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(BindIndexBufferCommand(in_buffer_ptr,
-                                                        in_offset,
-                                                        in_index_type) );
+            m_commands.push_back(m_command_arena.create<BindIndexBufferCommand>(in_buffer_ptr,
+                                                                                in_offset,
+                                                                                in_index_type) );
         }
     }
     #endif
 
+    track_buffer_access(in_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::VERTEX_INPUT_BIT,
+                        Anvil::AccessFlagBits::INDEX_READ_BIT);
+
+    if (m_state_filtering_enabled)
+    {
+        if ((m_bound_state.valid_state_bits & BoundState::INDEX_BUFFER_BIT) != 0                        &&
+             m_bound_state.index_buffer                                  == in_buffer_ptr->get_buffer() &&
+             m_bound_state.index_buffer_offset                           == in_offset                   &&
+             m_bound_state.index_type                                    == in_index_type)
+        {
+            m_n_filtered_state_calls++;
+
+            result = true;
+            goto end;
+        }
+
+        m_bound_state.index_buffer         = in_buffer_ptr->get_buffer();
+        m_bound_state.index_buffer_offset  = in_offset;
+        m_bound_state.index_type           = in_index_type;
+        m_bound_state.valid_state_bits    |= BoundState::INDEX_BUFFER_BIT;
+    }
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdBindIndexBuffer(m_command_buffer,
-                                            in_buffer_ptr->get_buffer(),
-                                            in_offset,
-                                            static_cast<VkIndexType>(in_index_type) );
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdBindIndexBuffer(m_command_buffer,
+                                                                in_buffer_ptr->get_buffer(),
+                                                                in_offset,
+                                                                static_cast<VkIndexType>(in_index_type) );
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -1485,8 +2464,9 @@ bool Anvil::CommandBufferBase::record_bind_pipeline(Anvil::PipelineBindPoint in_
                                                     Anvil::PipelineID        in_pipeline_id)
 {
     /* Command supported inside and outside the renderpass. */
-    VkPipeline pipeline_vk      (VK_NULL_HANDLE);
-    bool       result           (false);
+    Anvil::BasePipelineManager* pipeline_manager_ptr(nullptr);
+    VkPipeline                  pipeline_vk         (VK_NULL_HANDLE);
+    bool                        result              (false);
 
     if (!m_recording_in_progress)
     {
@@ -1498,25 +2478,53 @@ bool Anvil::CommandBufferBase::record_bind_pipeline(Anvil::PipelineBindPoint in_
     anvil_assert(in_pipeline_bind_point == Anvil::PipelineBindPoint::COMPUTE  ||
                  in_pipeline_bind_point == Anvil::PipelineBindPoint::GRAPHICS);
 
-    pipeline_vk = (in_pipeline_bind_point == Anvil::PipelineBindPoint::COMPUTE) ? m_device_ptr->get_compute_pipeline_manager ()->get_pipeline(in_pipeline_id)
-                                                                                : m_device_ptr->get_graphics_pipeline_manager()->get_pipeline(in_pipeline_id);
+    pipeline_manager_ptr = (in_pipeline_bind_point == Anvil::PipelineBindPoint::COMPUTE) ? static_cast<Anvil::BasePipelineManager*>(m_device_ptr->get_compute_pipeline_manager () )
+                                                                                         : static_cast<Anvil::BasePipelineManager*>(m_device_ptr->get_graphics_pipeline_manager() );
+    pipeline_vk          = pipeline_manager_ptr->get_pipeline(in_pipeline_id);
+
+    pipeline_manager_ptr->on_pipeline_bound(in_pipeline_id);
 
     #ifdef STORE_COMMAND_BUFFER_COMMANDS
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(BindPipelineCommand(in_pipeline_bind_point,
-                                                     in_pipeline_id) );
+            m_commands.push_back(m_command_arena.create<BindPipelineCommand>(in_pipeline_bind_point,
+                                                                             in_pipeline_id) );
         }
     }
     #endif
 
+    if (m_state_filtering_enabled                                       &&
+        pipeline_vk                                   != VK_NULL_HANDLE &&
+        static_cast<uint32_t>(in_pipeline_bind_point) <  2)
+    {
+        auto& bound_pipeline = m_bound_state.pipelines[static_cast<uint32_t>(in_pipeline_bind_point)];
+
+        if (bound_pipeline == pipeline_vk)
+        {
+            m_n_filtered_state_calls++;
+
+            result = true;
+            goto end;
+        }
+
+        bound_pipeline = pipeline_vk;
+
+        if (in_pipeline_bind_point == Anvil::PipelineBindPoint::GRAPHICS)
+        {
+            invalidate_dynamic_states(in_pipeline_id);
+        }
+    }
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdBindPipeline(m_command_buffer,
-                                         static_cast<VkPipelineBindPoint>(in_pipeline_bind_point),
-                                         pipeline_vk);
+        m_n_recorded_pipeline_binds++;
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdBindPipeline(m_command_buffer,
+                                                             static_cast<VkPipelineBindPoint>(in_pipeline_bind_point),
+                                                             pipeline_vk);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -1527,16 +2535,13 @@ end:
 }
 
 /* Please see header for specification */
-bool Anvil::CommandBufferBase::record_bind_transform_feedback_buffers_EXT(const uint32_t&     in_first_binding,
-                                                                          const uint32_t&     in_n_bindings,
-                                                                          Anvil::Buffer**     in_buffer_ptrs,
-                                                                          const VkDeviceSize* in_offsets_ptr,
-                                                                          const VkDeviceSize* in_sizes_ptr)
+bool Anvil::CommandBufferBase::record_bind_shading_rate_image_NV(Anvil::ImageView*  in_opt_image_view_ptr,
+                                                                 Anvil::ImageLayout in_image_layout)
 {
-    /* Note: Command supported inside and outside the renderpass. */
-    auto        buffers     = std::vector<VkBuffer>(in_n_bindings);
-    const auto& entrypoints = m_device_ptr->get_extension_ext_transform_feedback_entrypoints ();
-    bool        result      = false;
+    /* Command supported inside and outside the renderpass. */
+    Anvil::ExtensionNVShadingRateImageEntrypoints entrypoints;
+    VkImageView                                   image_view_vk(VK_NULL_HANDLE);
+    bool                                          result       (false);
 
     if (!m_recording_in_progress)
     {
@@ -1545,12 +2550,75 @@ bool Anvil::CommandBufferBase::record_bind_transform_feedback_buffers_EXT(const
         goto end;
     }
 
+    anvil_assert(m_device_ptr->get_extension_info()->nv_shading_rate_image() );
+
     #ifdef STORE_COMMAND_BUFFER_COMMANDS
     {
         if (!m_command_stashing_disabled)
         {
-            std::vector<Anvil::Buffer*> buffer_vec(in_n_bindings);
-            std::vector<VkDeviceSize>   offset_vec(in_n_bindings);
+            m_commands.push_back(m_command_arena.create<BindShadingRateImageNVCommand>(in_opt_image_view_ptr,
+                                                                                       in_image_layout) );
+        }
+    }
+    #endif
+
+    if (in_opt_image_view_ptr != nullptr)
+    {
+        image_view_vk = in_opt_image_view_ptr->get_image_view();
+
+        track_image_access(in_opt_image_view_ptr->get_create_info_ptr()->get_parent_image(),
+                           in_opt_image_view_ptr->get_subresource_range(),
+                           in_image_layout,
+                           Anvil::PipelineStageFlagBits::SHADING_RATE_IMAGE_BIT_NV,
+                           Anvil::AccessFlagBits::SHADING_RATE_IMAGE_READ_BIT_NV);
+    }
+
+    entrypoints = m_device_ptr->get_extension_nv_shading_rate_image_entrypoints();
+
+    flush_pending_barriers();
+
+    m_parent_command_pool_ptr->lock();
+    lock();
+    {
+        m_n_recorded_commands++;
+
+        entrypoints.vkCmdBindShadingRateImageNV(m_command_buffer,
+                                                image_view_vk,
+                                                static_cast<VkImageLayout>(in_image_layout) );
+    }
+    unlock();
+    m_parent_command_pool_ptr->unlock();
+
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandBufferBase::record_bind_transform_feedback_buffers_EXT(const uint32_t&     in_first_binding,
+                                                                          const uint32_t&     in_n_bindings,
+                                                                          Anvil::Buffer**     in_buffer_ptrs,
+                                                                          const VkDeviceSize* in_offsets_ptr,
+                                                                          const VkDeviceSize* in_sizes_ptr)
+{
+    /* Note: Command supported inside and outside the renderpass. */
+    ScratchArray<VkBuffer, N_MAX_STACK_SCRATCH_ITEMS> buffers    (in_n_bindings);
+    const auto&                                       entrypoints(m_device_ptr->get_extension_ext_transform_feedback_entrypoints () );
+    bool                                              result     (false);
+
+    if (!m_recording_in_progress)
+    {
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
+    }
+
+    #ifdef STORE_COMMAND_BUFFER_COMMANDS
+    {
+        if (!m_command_stashing_disabled)
+        {
+            std::vector<Anvil::Buffer*> buffer_vec(in_n_bindings);
+            std::vector<VkDeviceSize>   offset_vec(in_n_bindings);
             std::vector<VkDeviceSize>   size_vec  (in_n_bindings);
 
             for (uint32_t n_binding = 0;
@@ -1562,11 +2630,11 @@ bool Anvil::CommandBufferBase::record_bind_transform_feedback_buffers_EXT(const
                 size_vec.at  (n_binding) = in_sizes_ptr  [n_binding];
             }
 
-            m_commands.push_back(BindTransformFeedbackBuffersEXTCommand(in_first_binding,
-                                                                        in_n_bindings,
-                                                                        buffer_vec,
-                                                                        offset_vec,
-                                                                        size_vec) );
+            m_commands.push_back(m_command_arena.create<BindTransformFeedbackBuffersEXTCommand>(in_first_binding,
+                                                                                                in_n_bindings,
+                                                                                                buffer_vec,
+                                                                                                offset_vec,
+                                                                                                size_vec) );
         }
     }
     #endif
@@ -1581,6 +2649,8 @@ bool Anvil::CommandBufferBase::record_bind_transform_feedback_buffers_EXT(const
     m_parent_command_pool_ptr->lock();
     lock();
     {
+        m_n_recorded_commands++;
+
         entrypoints.vkCmdBindTransformFeedbackBuffersEXT(m_command_buffer,
                                                          in_first_binding,
                                                          in_n_bindings,
@@ -1603,8 +2673,8 @@ bool Anvil::CommandBufferBase::record_bind_vertex_buffers(uint32_t            in
                                                           const VkDeviceSize* in_offset_ptrs)
 {
     /* Note: Command supported inside and outside the renderpass. */
-    auto buffers = std::vector<VkBuffer>(in_binding_count);
-    bool result  = false;
+    ScratchArray<VkBuffer, N_MAX_STACK_SCRATCH_ITEMS> buffers(in_binding_count);
+    bool                                              result (false);
 
     if (!m_recording_in_progress)
     {
@@ -1617,10 +2687,11 @@ bool Anvil::CommandBufferBase::record_bind_vertex_buffers(uint32_t            in
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(BindVertexBuffersCommand(in_start_binding,
-                                                          in_binding_count,
-                                                          in_buffer_ptrs,
-                                                          in_offset_ptrs) );
+            m_commands.push_back(m_command_arena.create<BindVertexBuffersCommand>(in_start_binding,
+                                                                                  in_binding_count,
+                                                                                  in_buffer_ptrs,
+                                                                                  in_offset_ptrs,
+                                                                                  &m_command_arena) );
         }
     }
     #endif
@@ -1632,14 +2703,68 @@ bool Anvil::CommandBufferBase::record_bind_vertex_buffers(uint32_t            in
         buffers.at(n_binding) = in_buffer_ptrs[n_binding]->get_buffer();
     }
 
+    for (uint32_t n_binding = 0;
+                  n_binding < in_binding_count;
+                ++n_binding)
+    {
+        track_buffer_access(in_buffer_ptrs[n_binding],
+                            Anvil::PipelineStageFlagBits::VERTEX_INPUT_BIT,
+                            Anvil::AccessFlagBits::VERTEX_ATTRIBUTE_READ_BIT);
+    }
+
+    if (m_state_filtering_enabled)
+    {
+        auto& bound_buffers = m_bound_state.vertex_buffers;
+        auto& bound_offsets = m_bound_state.vertex_buffer_offsets;
+
+        if (bound_buffers.size() >= in_start_binding + in_binding_count)
+        {
+            bool is_redundant = true;
+
+            for (uint32_t n_binding = 0;
+                          n_binding < in_binding_count && is_redundant;
+                        ++n_binding)
+            {
+                is_redundant = (bound_buffers.at(in_start_binding + n_binding) == buffers.at    (n_binding) &&
+                                bound_offsets.at(in_start_binding + n_binding) == in_offset_ptrs[n_binding]);
+            }
+
+            if (is_redundant)
+            {
+                m_n_filtered_state_calls++;
+
+                result = true;
+                goto end;
+            }
+        }
+
+        if (bound_buffers.size() < in_start_binding + in_binding_count)
+        {
+            bound_buffers.resize(in_start_binding + in_binding_count,
+                                 VK_NULL_HANDLE);
+            bound_offsets.resize(in_start_binding + in_binding_count,
+                                 0);
+        }
+
+        for (uint32_t n_binding = 0;
+                      n_binding < in_binding_count;
+                    ++n_binding)
+        {
+            bound_buffers.at(in_start_binding + n_binding) = buffers.at    (n_binding);
+            bound_offsets.at(in_start_binding + n_binding) = in_offset_ptrs[n_binding];
+        }
+    }
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdBindVertexBuffers(m_command_buffer,
-                                              in_start_binding,
-                                              in_binding_count,
-                                              (in_binding_count > 0) ? &buffers.at(0) : nullptr,
-                                              in_offset_ptrs);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdBindVertexBuffers(m_command_buffer,
+                                                                  in_start_binding,
+                                                                  in_binding_count,
+                                                                  (in_binding_count > 0) ? &buffers.at(0) : nullptr,
+                                                                  in_offset_ptrs);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -1678,28 +2803,102 @@ bool Anvil::CommandBufferBase::record_blit_image(Anvil::Image*           in_src_
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(BlitImageCommand(in_src_image_ptr,
-                                                  in_src_image_layout,
-                                                  in_dst_image_ptr,
-                                                  in_dst_image_layout,
-                                                  in_region_count,
-                                                  in_region_ptrs,
-                                                  in_filter) );
+            m_commands.push_back(m_command_arena.create<BlitImageCommand>(in_src_image_ptr,
+                                                                          in_src_image_layout,
+                                                                          in_dst_image_ptr,
+                                                                          in_dst_image_layout,
+                                                                          in_region_count,
+                                                                          in_region_ptrs,
+                                                                          in_filter,
+                                                                          &m_command_arena) );
+        }
+    }
+    #endif
+
+    for (uint32_t n_region = 0;
+                  n_region < in_region_count;
+                ++n_region)
+    {
+        track_image_access(in_src_image_ptr,
+                           in_region_ptrs[n_region].src_subresource,
+                           in_src_image_layout,
+                           Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                           Anvil::AccessFlagBits::TRANSFER_READ_BIT);
+        track_image_access(in_dst_image_ptr,
+                           in_region_ptrs[n_region].dst_subresource,
+                           in_dst_image_layout,
+                           Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                           Anvil::AccessFlagBits::TRANSFER_WRITE_BIT);
+    }
+
+    flush_pending_barriers();
+
+    m_parent_command_pool_ptr->lock();
+    lock();
+    {
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdBlitImage(m_command_buffer,
+                                                          in_src_image_ptr->get_image(),
+                                                          static_cast<VkImageLayout>(in_src_image_layout),
+                                                          in_dst_image_ptr->get_image(),
+                                                          static_cast<VkImageLayout>(in_dst_image_layout),
+                                                          in_region_count,
+                                                          reinterpret_cast<const VkImageBlit*>(in_region_ptrs),
+                                                          static_cast<VkFilter>(in_filter) );
+    }
+    unlock();
+    m_parent_command_pool_ptr->unlock();
+
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandBufferBase::record_build_acceleration_structures_KHR(uint32_t                                               in_n_infos,
+                                                                        const VkAccelerationStructureBuildGeometryInfoKHR*     in_infos_ptr,
+                                                                        const VkAccelerationStructureBuildRangeInfoKHR* const* in_build_range_infos_ptr)
+{
+    bool result = false;
+
+    if (m_is_renderpass_active)
+    {
+        anvil_assert(!m_is_renderpass_active);
+
+        goto end;
+    }
+
+    if (!m_recording_in_progress)
+    {
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
+    }
+
+    #ifdef STORE_COMMAND_BUFFER_COMMANDS
+    {
+        if (!m_command_stashing_disabled)
+        {
+            m_commands.push_back(m_command_arena.create<BuildAccelerationStructuresKHRCommand>(in_n_infos,
+                                                                                               in_infos_ptr,
+                                                                                               in_build_range_infos_ptr,
+                                                                                               &m_command_arena) );
         }
     }
     #endif
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdBlitImage(m_command_buffer,
-                                      in_src_image_ptr->get_image(),
-                                      static_cast<VkImageLayout>(in_src_image_layout),
-                                      in_dst_image_ptr->get_image(),
-                                      static_cast<VkImageLayout>(in_dst_image_layout),
-                                      in_region_count,
-                                      reinterpret_cast<const VkImageBlit*>(in_region_ptrs),
-                                      static_cast<VkFilter>(in_filter) );
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_extension_khr_acceleration_structure_entrypoints().vkCmdBuildAccelerationStructuresKHR(m_command_buffer,
+                                                                                                                in_n_infos,
+                                                                                                                in_infos_ptr,
+                                                                                                                in_build_range_infos_ptr);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -1735,22 +2934,27 @@ bool Anvil::CommandBufferBase::record_clear_attachments(uint32_t
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(ClearAttachmentsCommand(in_n_attachments,
-                                                         in_attachment_ptrs,
-                                                         in_n_rects,
-                                                         in_rect_ptrs) );
+            m_commands.push_back(m_command_arena.create<ClearAttachmentsCommand>(in_n_attachments,
+                                                                                 in_attachment_ptrs,
+                                                                                 in_n_rects,
+                                                                                 in_rect_ptrs,
+                                                                                 &m_command_arena) );
         }
     }
     #endif
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdClearAttachments(m_command_buffer,
-                                             in_n_attachments,
-                                             reinterpret_cast<const VkClearAttachment*>(in_attachment_ptrs),
-                                             in_n_rects,
-                                             in_rect_ptrs);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdClearAttachments(m_command_buffer,
+                                                                 in_n_attachments,
+                                                                 reinterpret_cast<const VkClearAttachment*>(in_attachment_ptrs),
+                                                                 in_n_rects,
+                                                                 in_rect_ptrs);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -1787,24 +2991,40 @@ bool Anvil::CommandBufferBase::record_clear_color_image(Anvil::Image*
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(ClearColorImageCommand(in_image_ptr,
-                                                        in_image_layout,
-                                                        in_color_ptr,
-                                                        in_range_count,
-                                                        in_range_ptrs) );
+            m_commands.push_back(m_command_arena.create<ClearColorImageCommand>(in_image_ptr,
+                                                                                in_image_layout,
+                                                                                in_color_ptr,
+                                                                                in_range_count,
+                                                                                in_range_ptrs,
+                                                                                &m_command_arena) );
         }
     }
     #endif
 
+    for (uint32_t n_range = 0;
+                  n_range < in_range_count;
+                ++n_range)
+    {
+        track_image_access(in_image_ptr,
+                           in_range_ptrs[n_range],
+                           in_image_layout,
+                           Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                           Anvil::AccessFlagBits::TRANSFER_WRITE_BIT);
+    }
+
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdClearColorImage(m_command_buffer,
-                                            in_image_ptr->get_image(),
-                                            static_cast<VkImageLayout>(in_image_layout),
-                                            in_color_ptr,
-                                            in_range_count,
-                                            reinterpret_cast<const VkImageSubresourceRange*>(in_range_ptrs) );
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdClearColorImage(m_command_buffer,
+                                                                in_image_ptr->get_image(),
+                                                                static_cast<VkImageLayout>(in_image_layout),
+                                                                in_color_ptr,
+                                                                in_range_count,
+                                                                reinterpret_cast<const VkImageSubresourceRange*>(in_range_ptrs) );
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -1841,24 +3061,97 @@ bool Anvil::CommandBufferBase::record_clear_depth_stencil_image(Anvil::Image*
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(ClearDepthStencilImageCommand(in_image_ptr,
-                                                               in_image_layout,
-                                                               in_depth_stencil_ptr,
-                                                               in_range_count,
-                                                               in_range_ptrs) );
+            m_commands.push_back(m_command_arena.create<ClearDepthStencilImageCommand>(in_image_ptr,
+                                                                                       in_image_layout,
+                                                                                       in_depth_stencil_ptr,
+                                                                                       in_range_count,
+                                                                                       in_range_ptrs,
+                                                                                       &m_command_arena) );
+        }
+    }
+    #endif
+
+    for (uint32_t n_range = 0;
+                  n_range < in_range_count;
+                ++n_range)
+    {
+        track_image_access(in_image_ptr,
+                           in_range_ptrs[n_range],
+                           in_image_layout,
+                           Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                           Anvil::AccessFlagBits::TRANSFER_WRITE_BIT);
+    }
+
+    flush_pending_barriers();
+
+    m_parent_command_pool_ptr->lock();
+    lock();
+    {
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdClearDepthStencilImage(m_command_buffer,
+                                                                       in_image_ptr->get_image(),
+                                                                       static_cast<VkImageLayout>(in_image_layout),
+                                                                       in_depth_stencil_ptr,
+                                                                       in_range_count,
+                                                                       reinterpret_cast<const VkImageSubresourceRange*>(in_range_ptrs) );
+    }
+    unlock();
+    m_parent_command_pool_ptr->unlock();
+
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandBufferBase::record_copy_acceleration_structure_KHR(Anvil::AccelerationStructure*      in_src_ptr,
+                                                                      Anvil::AccelerationStructure*      in_dst_ptr,
+                                                                      VkCopyAccelerationStructureModeKHR in_mode)
+{
+    VkCopyAccelerationStructureInfoKHR copy_info;
+    bool                               result    = false;
+
+    if (m_is_renderpass_active)
+    {
+        anvil_assert(!m_is_renderpass_active);
+
+        goto end;
+    }
+
+    if (!m_recording_in_progress)
+    {
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
+    }
+
+    #ifdef STORE_COMMAND_BUFFER_COMMANDS
+    {
+        if (!m_command_stashing_disabled)
+        {
+            m_commands.push_back(m_command_arena.create<CopyAccelerationStructureKHRCommand>(in_src_ptr,
+                                                                                             in_dst_ptr,
+                                                                                             in_mode) );
         }
     }
     #endif
 
+    copy_info.dst   = in_dst_ptr->get_acceleration_structure();
+    copy_info.mode  = in_mode;
+    copy_info.pNext = nullptr;
+    copy_info.src   = in_src_ptr->get_acceleration_structure();
+    copy_info.sType = VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_INFO_KHR;
+
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdClearDepthStencilImage(m_command_buffer,
-                                                   in_image_ptr->get_image(),
-                                                   static_cast<VkImageLayout>(in_image_layout),
-                                                   in_depth_stencil_ptr,
-                                                   in_range_count,
-                                                   reinterpret_cast<const VkImageSubresourceRange*>(in_range_ptrs) );
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_extension_khr_acceleration_structure_entrypoints().vkCmdCopyAccelerationStructureKHR(m_command_buffer,
+                                                                                                              &copy_info);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -1894,22 +3187,34 @@ bool Anvil::CommandBufferBase::record_copy_buffer(Anvil::Buffer*           in_sr
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(CopyBufferCommand(in_src_buffer_ptr,
-                                                   in_dst_buffer_ptr,
-                                                   in_region_count,
-                                                   in_region_ptrs) );
+            m_commands.push_back(m_command_arena.create<CopyBufferCommand>(in_src_buffer_ptr,
+                                                                           in_dst_buffer_ptr,
+                                                                           in_region_count,
+                                                                           in_region_ptrs,
+                                                                           &m_command_arena) );
         }
     }
     #endif
 
+    track_buffer_access(in_src_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                        Anvil::AccessFlagBits::TRANSFER_READ_BIT);
+    track_buffer_access(in_dst_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                        Anvil::AccessFlagBits::TRANSFER_WRITE_BIT);
+
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdCopyBuffer(m_command_buffer,
-                                       in_src_buffer_ptr->get_buffer(),
-                                       in_dst_buffer_ptr->get_buffer(),
-                                       in_region_count,
-                                       reinterpret_cast<const VkBufferCopy*>(in_region_ptrs) );
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdCopyBuffer(m_command_buffer,
+                                                           in_src_buffer_ptr->get_buffer(),
+                                                           in_dst_buffer_ptr->get_buffer(),
+                                                           in_region_count,
+                                                           reinterpret_cast<const VkBufferCopy*>(in_region_ptrs) );
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -1946,24 +3251,44 @@ bool Anvil::CommandBufferBase::record_copy_buffer_to_image(Anvil::Buffer*
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(CopyBufferToImageCommand(in_src_buffer_ptr,
-                                                          in_dst_image_ptr,
-                                                          in_dst_image_layout,
-                                                          in_region_count,
-                                                          in_region_ptrs) );
+            m_commands.push_back(m_command_arena.create<CopyBufferToImageCommand>(in_src_buffer_ptr,
+                                                                                  in_dst_image_ptr,
+                                                                                  in_dst_image_layout,
+                                                                                  in_region_count,
+                                                                                  in_region_ptrs,
+                                                                                  &m_command_arena) );
         }
     }
     #endif
 
+    track_buffer_access(in_src_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                        Anvil::AccessFlagBits::TRANSFER_READ_BIT);
+
+    for (uint32_t n_region = 0;
+                  n_region < in_region_count;
+                ++n_region)
+    {
+        track_image_access(in_dst_image_ptr,
+                           in_region_ptrs[n_region].image_subresource,
+                           in_dst_image_layout,
+                           Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                           Anvil::AccessFlagBits::TRANSFER_WRITE_BIT);
+    }
+
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdCopyBufferToImage(m_command_buffer,
-                                              in_src_buffer_ptr->get_buffer(),
-                                              in_dst_image_ptr->get_image(),
-                                              static_cast<VkImageLayout>(in_dst_image_layout),
-                                              in_region_count,
-                                              reinterpret_cast<const VkBufferImageCopy*>(in_region_ptrs) );
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdCopyBufferToImage(m_command_buffer,
+                                                                  in_src_buffer_ptr->get_buffer(),
+                                                                  in_dst_image_ptr->get_image(),
+                                                                  static_cast<VkImageLayout>(in_dst_image_layout),
+                                                                  in_region_count,
+                                                                  reinterpret_cast<const VkBufferImageCopy*>(in_region_ptrs) );
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -2001,26 +3326,47 @@ bool Anvil::CommandBufferBase::record_copy_image(Anvil::Image*           in_src_
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(CopyImageCommand(in_src_image_ptr,
-                                                  in_src_image_layout,
-                                                  in_dst_image_ptr,
-                                                  in_dst_image_layout,
-                                                  in_region_count,
-                                                  in_region_ptrs) );
+            m_commands.push_back(m_command_arena.create<CopyImageCommand>(in_src_image_ptr,
+                                                                          in_src_image_layout,
+                                                                          in_dst_image_ptr,
+                                                                          in_dst_image_layout,
+                                                                          in_region_count,
+                                                                          in_region_ptrs,
+                                                                          &m_command_arena) );
         }
     }
     #endif
 
+    for (uint32_t n_region = 0;
+                  n_region < in_region_count;
+                ++n_region)
+    {
+        track_image_access(in_src_image_ptr,
+                           in_region_ptrs[n_region].src_subresource,
+                           in_src_image_layout,
+                           Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                           Anvil::AccessFlagBits::TRANSFER_READ_BIT);
+        track_image_access(in_dst_image_ptr,
+                           in_region_ptrs[n_region].dst_subresource,
+                           in_dst_image_layout,
+                           Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                           Anvil::AccessFlagBits::TRANSFER_WRITE_BIT);
+    }
+
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdCopyImage(m_command_buffer,
-                                      in_src_image_ptr->get_image(),
-                                      static_cast<VkImageLayout>(in_src_image_layout),
-                                      in_dst_image_ptr->get_image(),
-                                      static_cast<VkImageLayout>(in_dst_image_layout),
-                                      in_region_count,
-                                      reinterpret_cast<const VkImageCopy*>(in_region_ptrs) );
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdCopyImage(m_command_buffer,
+                                                          in_src_image_ptr->get_image(),
+                                                          static_cast<VkImageLayout>(in_src_image_layout),
+                                                          in_dst_image_ptr->get_image(),
+                                                          static_cast<VkImageLayout>(in_dst_image_layout),
+                                                          in_region_count,
+                                                          reinterpret_cast<const VkImageCopy*>(in_region_ptrs) );
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -2057,24 +3403,44 @@ bool Anvil::CommandBufferBase::record_copy_image_to_buffer(Anvil::Image*
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(CopyImageToBufferCommand(in_src_image_ptr,
-                                                          in_src_image_layout,
-                                                          in_dst_buffer_ptr,
-                                                          in_region_count,
-                                                          in_region_ptrs) );
+            m_commands.push_back(m_command_arena.create<CopyImageToBufferCommand>(in_src_image_ptr,
+                                                                                  in_src_image_layout,
+                                                                                  in_dst_buffer_ptr,
+                                                                                  in_region_count,
+                                                                                  in_region_ptrs,
+                                                                                  &m_command_arena) );
         }
     }
     #endif
 
+    for (uint32_t n_region = 0;
+                  n_region < in_region_count;
+                ++n_region)
+    {
+        track_image_access(in_src_image_ptr,
+                           in_region_ptrs[n_region].image_subresource,
+                           in_src_image_layout,
+                           Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                           Anvil::AccessFlagBits::TRANSFER_READ_BIT);
+    }
+
+    track_buffer_access(in_dst_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                        Anvil::AccessFlagBits::TRANSFER_WRITE_BIT);
+
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdCopyImageToBuffer(m_command_buffer,
-                                              in_src_image_ptr->get_image(),
-                                              static_cast<VkImageLayout>(in_src_image_layout),
-                                              in_dst_buffer_ptr->get_buffer(),
-                                              in_region_count,
-                                              reinterpret_cast<const VkBufferImageCopy*>(in_region_ptrs) );
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdCopyImageToBuffer(m_command_buffer,
+                                                                  in_src_image_ptr->get_image(),
+                                                                  static_cast<VkImageLayout>(in_src_image_layout),
+                                                                  in_dst_buffer_ptr->get_buffer(),
+                                                                  in_region_count,
+                                                                  reinterpret_cast<const VkBufferImageCopy*>(in_region_ptrs) );
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -2113,28 +3479,36 @@ bool Anvil::CommandBufferBase::record_copy_query_pool_results(Anvil::QueryPool*
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(CopyQueryPoolResultsCommand(in_query_pool_ptr,
-                                                             in_start_query,
-                                                             in_query_count,
-                                                             in_dst_buffer_ptr,
-                                                             in_dst_offset,
-                                                             in_dst_stride,
-                                                             in_flags) );
+            m_commands.push_back(m_command_arena.create<CopyQueryPoolResultsCommand>(in_query_pool_ptr,
+                                                                                     in_start_query,
+                                                                                     in_query_count,
+                                                                                     in_dst_buffer_ptr,
+                                                                                     in_dst_offset,
+                                                                                     in_dst_stride,
+                                                                                     in_flags) );
         }
     }
     #endif
 
+    track_buffer_access(in_dst_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                        Anvil::AccessFlagBits::TRANSFER_WRITE_BIT);
+
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdCopyQueryPoolResults(m_command_buffer,
-                                                 in_query_pool_ptr->get_query_pool(),
-                                                 in_start_query,
-                                                 in_query_count,
-                                                 in_dst_buffer_ptr->get_buffer(),
-                                                 in_dst_offset,
-                                                 in_dst_stride,
-                                                 in_flags);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdCopyQueryPoolResults(m_command_buffer,
+                                                                     in_query_pool_ptr->get_query_pool(),
+                                                                     in_start_query,
+                                                                     in_query_count,
+                                                                     in_dst_buffer_ptr->get_buffer(),
+                                                                     in_dst_offset,
+                                                                     in_dst_stride,
+                                                                     in_flags);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -2169,20 +3543,24 @@ bool Anvil::CommandBufferBase::record_dispatch(uint32_t in_x,
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(DispatchCommand(in_x,
-                                                 in_y,
-                                                 in_z) );
+            m_commands.push_back(m_command_arena.create<DispatchCommand>(in_x,
+                                                                         in_y,
+                                                                         in_z) );
         }
     }
     #endif
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdDispatch(m_command_buffer,
-                                     in_x,
-                                     in_y,
-                                     in_z);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdDispatch(m_command_buffer,
+                                                         in_x,
+                                                         in_y,
+                                                         in_z);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -2211,8 +3589,8 @@ bool Anvil::CommandBufferBase::record_debug_marker_begin_EXT(const std::string&
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(DebugMarkerBeginEXTCommand(in_marker_name,
-                                                            in_opt_color) );
+            m_commands.push_back(m_command_arena.create<DebugMarkerBeginEXTCommand>(in_marker_name,
+                                                                                    in_opt_color) );
         }
     }
     #endif
@@ -2237,8 +3615,12 @@ bool Anvil::CommandBufferBase::record_debug_marker_begin_EXT(const std::string&
     marker_info.pNext       = nullptr;
     marker_info.sType       = VK_STRUCTURE_TYPE_DEBUG_MARKER_MARKER_INFO_EXT;
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     {
+        m_n_recorded_commands++;
+
         entrypoints.vkCmdDebugMarkerBeginEXT(m_command_buffer,
                                             &marker_info);
     }
@@ -2269,13 +3651,17 @@ bool Anvil::CommandBufferBase::record_debug_marker_end_EXT()
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(DebugMarkerEndEXTCommand() );
+            m_commands.push_back(m_command_arena.create<DebugMarkerEndEXTCommand>() );
         }
     }
     #endif
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     {
+        m_n_recorded_commands++;
+
         entrypoints.vkCmdDebugMarkerEndEXT(m_command_buffer);
     }
     m_parent_command_pool_ptr->unlock();
@@ -2307,8 +3693,8 @@ bool Anvil::CommandBufferBase::record_debug_marker_insert_EXT(const std::string&
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(DebugMarkerInsertEXTCommand(in_marker_name,
-                                                             in_opt_color) );
+            m_commands.push_back(m_command_arena.create<DebugMarkerInsertEXTCommand>(in_marker_name,
+                                                                                     in_opt_color) );
         }
     }
     #endif
@@ -2331,8 +3717,12 @@ bool Anvil::CommandBufferBase::record_debug_marker_insert_EXT(const std::string&
     marker_info.pNext       = nullptr;
     marker_info.sType       = VK_STRUCTURE_TYPE_DEBUG_MARKER_MARKER_INFO_EXT;
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     {
+        m_n_recorded_commands++;
+
         entrypoints.vkCmdDebugMarkerInsertEXT(m_command_buffer,
                                              &marker_info);
     }
@@ -2375,19 +3765,23 @@ bool Anvil::CommandBufferBase::record_dispatch_base_KHR(uint32_t in_base_group_x
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(DispatchBaseKHRCommand(in_base_group_x,
-                                                        in_base_group_y,
-                                                        in_base_group_z,
-                                                        in_group_count_x,
-                                                        in_group_count_y,
-                                                        in_group_count_z) );
+            m_commands.push_back(m_command_arena.create<DispatchBaseKHRCommand>(in_base_group_x,
+                                                                                in_base_group_y,
+                                                                                in_base_group_z,
+                                                                                in_group_count_x,
+                                                                                in_group_count_y,
+                                                                                in_group_count_z) );
         }
     }
     #endif
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
+        m_n_recorded_commands++;
+
         entrypoints.vkCmdDispatchBaseKHR(m_command_buffer,
                                          in_base_group_x,
                                          in_base_group_y,
@@ -2428,18 +3822,26 @@ bool Anvil::CommandBufferBase::record_dispatch_indirect(Anvil::Buffer* in_buffer
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(DispatchIndirectCommand(in_buffer_ptr,
-                                                         in_offset) );
+            m_commands.push_back(m_command_arena.create<DispatchIndirectCommand>(in_buffer_ptr,
+                                                                                 in_offset) );
         }
     }
     #endif
 
+    track_buffer_access(in_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::DRAW_INDIRECT_BIT,
+                        Anvil::AccessFlagBits::INDIRECT_COMMAND_READ_BIT);
+
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdDispatchIndirect(m_command_buffer,
-                                             in_buffer_ptr->get_buffer(),
-                                             in_offset);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdDispatchIndirect(m_command_buffer,
+                                                                 in_buffer_ptr->get_buffer(),
+                                                                 in_offset);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -2475,22 +3877,26 @@ bool Anvil::CommandBufferBase::record_draw(uint32_t in_vertex_count,
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(DrawCommand(in_vertex_count,
-                                             in_instance_count,
-                                             in_first_vertex,
-                                             in_first_instance) );
+            m_commands.push_back(m_command_arena.create<DrawCommand>(in_vertex_count,
+                                                                     in_instance_count,
+                                                                     in_first_vertex,
+                                                                     in_first_instance) );
         }
     }
     #endif
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdDraw(m_command_buffer,
-                                 in_vertex_count,
-                                 in_instance_count,
-                                 in_first_vertex,
-                                 in_first_instance);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdDraw(m_command_buffer,
+                                                     in_vertex_count,
+                                                     in_instance_count,
+                                                     in_first_vertex,
+                                                     in_first_instance);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -2527,24 +3933,28 @@ bool Anvil::CommandBufferBase::record_draw_indexed(uint32_t in_index_count,
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(DrawIndexedCommand(in_index_count,
-                                                    in_instance_count,
-                                                    in_first_index,
-                                                    in_vertex_offset,
-                                                    in_first_instance) );
+            m_commands.push_back(m_command_arena.create<DrawIndexedCommand>(in_index_count,
+                                                                            in_instance_count,
+                                                                            in_first_index,
+                                                                            in_vertex_offset,
+                                                                            in_first_instance) );
         }
     }
     #endif
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdDrawIndexed(m_command_buffer,
-                                        in_index_count,
-                                        in_instance_count,
-                                        in_first_index,
-                                        in_vertex_offset,
-                                        in_first_instance);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdDrawIndexed(m_command_buffer,
+                                                            in_index_count,
+                                                            in_instance_count,
+                                                            in_first_index,
+                                                            in_vertex_offset,
+                                                            in_first_instance);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -2580,22 +3990,30 @@ bool Anvil::CommandBufferBase::record_draw_indexed_indirect(Anvil::Buffer* in_bu
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(DrawIndexedIndirectCommand(in_buffer_ptr,
-                                                            in_offset,
-                                                            in_count,
-                                                            in_stride) );
+            m_commands.push_back(m_command_arena.create<DrawIndexedIndirectCommand>(in_buffer_ptr,
+                                                                                    in_offset,
+                                                                                    in_count,
+                                                                                    in_stride) );
         }
     }
     #endif
 
+    track_buffer_access(in_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::DRAW_INDIRECT_BIT,
+                        Anvil::AccessFlagBits::INDIRECT_COMMAND_READ_BIT);
+
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdDrawIndexedIndirect(m_command_buffer,
-                                                in_buffer_ptr->get_buffer(),
-                                                in_offset,
-                                                in_count,
-                                                in_stride);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdDrawIndexedIndirect(m_command_buffer,
+                                                                    in_buffer_ptr->get_buffer(),
+                                                                    in_offset,
+                                                                    in_count,
+                                                                    in_stride);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -2634,19 +4052,27 @@ bool Anvil::CommandBufferBase::record_draw_indirect_byte_count_EXT(const uint32_
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(DrawIndirectByteCountEXTCommand(in_instance_count,
-                                                                 in_first_instance,
-                                                                 in_counter_buffer_ptr,
-                                                                 in_counter_buffer_offset,
-                                                                 in_counter_offset,
-                                                                 in_vertex_stride) );
+            m_commands.push_back(m_command_arena.create<DrawIndirectByteCountEXTCommand>(in_instance_count,
+                                                                                         in_first_instance,
+                                                                                         in_counter_buffer_ptr,
+                                                                                         in_counter_buffer_offset,
+                                                                                         in_counter_offset,
+                                                                                         in_vertex_stride) );
         }
     }
     #endif
 
+    track_buffer_access(in_counter_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::DRAW_INDIRECT_BIT,
+                        Anvil::AccessFlagBits::TRANSFORM_FEEDBACK_COUNTER_READ_BIT_EXT);
+
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
+        m_n_recorded_commands++;
+
         entrypoints.vkCmdDrawIndirectByteCountEXT(m_command_buffer,
                                                   in_instance_count,
                                                   in_first_instance,
@@ -2695,21 +4121,32 @@ bool Anvil::CommandBufferBase::record_draw_indexed_indirect_count_AMD(Anvil::Buf
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(DrawIndexedIndirectCountAMDCommand(in_buffer_ptr,
-                                                                    in_offset,
-                                                                    in_count_buffer_ptr,
-                                                                    in_count_offset,
-                                                                    in_max_draw_count,
-                                                                    in_stride) );
+            m_commands.push_back(m_command_arena.create<DrawIndexedIndirectCountAMDCommand>(in_buffer_ptr,
+                                                                                            in_offset,
+                                                                                            in_count_buffer_ptr,
+                                                                                            in_count_offset,
+                                                                                            in_max_draw_count,
+                                                                                            in_stride) );
         }
     }
     #endif
 
     entrypoints = m_device_ptr->get_extension_amd_draw_indirect_count_entrypoints();
 
+    track_buffer_access(in_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::DRAW_INDIRECT_BIT,
+                        Anvil::AccessFlagBits::INDIRECT_COMMAND_READ_BIT);
+    track_buffer_access(in_count_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::DRAW_INDIRECT_BIT,
+                        Anvil::AccessFlagBits::INDIRECT_COMMAND_READ_BIT);
+
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
+        m_n_recorded_commands++;
+
         entrypoints.vkCmdDrawIndexedIndirectCountAMD(m_command_buffer,
                                                      in_buffer_ptr->get_buffer(),
                                                      in_offset,
@@ -2758,21 +4195,32 @@ bool Anvil::CommandBufferBase::record_draw_indexed_indirect_count_KHR(Anvil::Buf
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(DrawIndexedIndirectCountKHRCommand(in_buffer_ptr,
-                                                                    in_offset,
-                                                                    in_count_buffer_ptr,
-                                                                    in_count_offset,
-                                                                    in_max_draw_count,
-                                                                    in_stride) );
+            m_commands.push_back(m_command_arena.create<DrawIndexedIndirectCountKHRCommand>(in_buffer_ptr,
+                                                                                            in_offset,
+                                                                                            in_count_buffer_ptr,
+                                                                                            in_count_offset,
+                                                                                            in_max_draw_count,
+                                                                                            in_stride) );
         }
     }
     #endif
 
     entrypoints = m_device_ptr->get_extension_khr_draw_indirect_count_entrypoints();
 
+    track_buffer_access(in_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::DRAW_INDIRECT_BIT,
+                        Anvil::AccessFlagBits::INDIRECT_COMMAND_READ_BIT);
+    track_buffer_access(in_count_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::DRAW_INDIRECT_BIT,
+                        Anvil::AccessFlagBits::INDIRECT_COMMAND_READ_BIT);
+
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
+        m_n_recorded_commands++;
+
         entrypoints.vkCmdDrawIndexedIndirectCountKHR(m_command_buffer,
                                                      in_buffer_ptr->get_buffer(),
                                                      in_offset,
@@ -2815,22 +4263,30 @@ bool Anvil::CommandBufferBase::record_draw_indirect(Anvil::Buffer* in_buffer_ptr
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(DrawIndirectCommand(in_buffer_ptr,
-                                                     in_offset,
-                                                     in_count,
-                                                     in_stride) );
+            m_commands.push_back(m_command_arena.create<DrawIndirectCommand>(in_buffer_ptr,
+                                                                             in_offset,
+                                                                             in_count,
+                                                                             in_stride) );
         }
     }
     #endif
 
+    track_buffer_access(in_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::DRAW_INDIRECT_BIT,
+                        Anvil::AccessFlagBits::INDIRECT_COMMAND_READ_BIT);
+
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdDrawIndirect(m_command_buffer,
-                                         in_buffer_ptr->get_buffer(),
-                                         in_offset,
-                                         in_count,
-                                         in_stride);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdDrawIndirect(m_command_buffer,
+                                                             in_buffer_ptr->get_buffer(),
+                                                             in_offset,
+                                                             in_count,
+                                                             in_stride);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -2872,21 +4328,32 @@ bool Anvil::CommandBufferBase::record_draw_indirect_count_AMD(Anvil::Buffer* in_
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(DrawIndirectCountAMDCommand(in_buffer_ptr,
-                                                             in_offset,
-                                                             in_count_buffer_ptr,
-                                                             in_count_offset,
-                                                             in_max_draw_count,
-                                                             in_stride) );
+            m_commands.push_back(m_command_arena.create<DrawIndirectCountAMDCommand>(in_buffer_ptr,
+                                                                                     in_offset,
+                                                                                     in_count_buffer_ptr,
+                                                                                     in_count_offset,
+                                                                                     in_max_draw_count,
+                                                                                     in_stride) );
         }
     }
     #endif
 
     entrypoints = m_device_ptr->get_extension_amd_draw_indirect_count_entrypoints();
 
+    track_buffer_access(in_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::DRAW_INDIRECT_BIT,
+                        Anvil::AccessFlagBits::INDIRECT_COMMAND_READ_BIT);
+    track_buffer_access(in_count_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::DRAW_INDIRECT_BIT,
+                        Anvil::AccessFlagBits::INDIRECT_COMMAND_READ_BIT);
+
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
+        m_n_recorded_commands++;
+
         entrypoints.vkCmdDrawIndirectCountAMD(m_command_buffer,
                                               in_buffer_ptr->get_buffer(),
                                               in_offset,
@@ -2935,21 +4402,32 @@ bool Anvil::CommandBufferBase::record_draw_indirect_count_KHR(Anvil::Buffer* in_
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(DrawIndirectCountKHRCommand(in_buffer_ptr,
-                                                             in_offset,
-                                                             in_count_buffer_ptr,
-                                                             in_count_offset,
-                                                             in_max_draw_count,
-                                                             in_stride) );
+            m_commands.push_back(m_command_arena.create<DrawIndirectCountKHRCommand>(in_buffer_ptr,
+                                                                                     in_offset,
+                                                                                     in_count_buffer_ptr,
+                                                                                     in_count_offset,
+                                                                                     in_max_draw_count,
+                                                                                     in_stride) );
         }
     }
     #endif
 
     entrypoints = m_device_ptr->get_extension_khr_draw_indirect_count_entrypoints();
 
+    track_buffer_access(in_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::DRAW_INDIRECT_BIT,
+                        Anvil::AccessFlagBits::INDIRECT_COMMAND_READ_BIT);
+    track_buffer_access(in_count_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::DRAW_INDIRECT_BIT,
+                        Anvil::AccessFlagBits::INDIRECT_COMMAND_READ_BIT);
+
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
+        m_n_recorded_commands++;
+
         entrypoints.vkCmdDrawIndirectCountKHR(m_command_buffer,
                                               in_buffer_ptr->get_buffer(),
                                               in_offset,
@@ -2966,6 +4444,247 @@ end:
     return result;
 }
 
+/* Please see header for specification */
+bool Anvil::CommandBufferBase::record_draw_mesh_tasks_indirect_count_NV(Anvil::Buffer* in_buffer_ptr,
+                                                                        VkDeviceSize   in_offset,
+                                                                        Anvil::Buffer* in_count_buffer_ptr,
+                                                                        VkDeviceSize   in_count_offset,
+                                                                        uint32_t       in_max_draw_count,
+                                                                        uint32_t       in_stride)
+{
+    Anvil::ExtensionNVMeshShaderEntrypoints entrypoints;
+    bool                                    result     (false);
+
+    if (!m_is_renderpass_active)
+    {
+        anvil_assert(m_is_renderpass_active);
+
+        goto end;
+    }
+
+    if (!m_recording_in_progress)
+    {
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
+    }
+
+    anvil_assert(m_device_ptr->get_extension_info()->khr_draw_indirect_count() );
+    anvil_assert(m_device_ptr->get_extension_info()->nv_mesh_shader         () );
+
+    #ifdef STORE_COMMAND_BUFFER_COMMANDS
+    {
+        if (!m_command_stashing_disabled)
+        {
+            m_commands.push_back(m_command_arena.create<DrawMeshTasksIndirectCountNVCommand>(in_buffer_ptr,
+                                                                                             in_offset,
+                                                                                             in_count_buffer_ptr,
+                                                                                             in_count_offset,
+                                                                                             in_max_draw_count,
+                                                                                             in_stride) );
+        }
+    }
+    #endif
+
+    entrypoints = m_device_ptr->get_extension_nv_mesh_shader_entrypoints();
+
+    track_buffer_access(in_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::DRAW_INDIRECT_BIT,
+                        Anvil::AccessFlagBits::INDIRECT_COMMAND_READ_BIT);
+    track_buffer_access(in_count_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::DRAW_INDIRECT_BIT,
+                        Anvil::AccessFlagBits::INDIRECT_COMMAND_READ_BIT);
+
+    flush_pending_barriers();
+
+    m_parent_command_pool_ptr->lock();
+    lock();
+    {
+        m_n_recorded_commands++;
+
+        entrypoints.vkCmdDrawMeshTasksIndirectCountNV(m_command_buffer,
+                                                      in_buffer_ptr->get_buffer(),
+                                                      in_offset,
+                                                      in_count_buffer_ptr->get_buffer(),
+                                                      in_count_offset,
+                                                      in_max_draw_count,
+                                                      in_stride);
+    }
+    unlock();
+    m_parent_command_pool_ptr->unlock();
+
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandBufferBase::record_draw_mesh_tasks_indirect_NV(Anvil::Buffer* in_buffer_ptr,
+                                                                  VkDeviceSize   in_offset,
+                                                                  uint32_t       in_draw_count,
+                                                                  uint32_t       in_stride)
+{
+    Anvil::ExtensionNVMeshShaderEntrypoints entrypoints;
+    bool                                    result     (false);
+
+    if (!m_is_renderpass_active)
+    {
+        anvil_assert(m_is_renderpass_active);
+
+        goto end;
+    }
+
+    if (!m_recording_in_progress)
+    {
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
+    }
+
+    anvil_assert(m_device_ptr->get_extension_info()->nv_mesh_shader() );
+
+    #ifdef STORE_COMMAND_BUFFER_COMMANDS
+    {
+        if (!m_command_stashing_disabled)
+        {
+            m_commands.push_back(m_command_arena.create<DrawMeshTasksIndirectNVCommand>(in_buffer_ptr,
+                                                                                        in_offset,
+                                                                                        in_draw_count,
+                                                                                        in_stride) );
+        }
+    }
+    #endif
+
+    entrypoints = m_device_ptr->get_extension_nv_mesh_shader_entrypoints();
+
+    track_buffer_access(in_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::DRAW_INDIRECT_BIT,
+                        Anvil::AccessFlagBits::INDIRECT_COMMAND_READ_BIT);
+
+    flush_pending_barriers();
+
+    m_parent_command_pool_ptr->lock();
+    lock();
+    {
+        m_n_recorded_commands++;
+
+        entrypoints.vkCmdDrawMeshTasksIndirectNV(m_command_buffer,
+                                                 in_buffer_ptr->get_buffer(),
+                                                 in_offset,
+                                                 in_draw_count,
+                                                 in_stride);
+    }
+    unlock();
+    m_parent_command_pool_ptr->unlock();
+
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandBufferBase::record_draw_mesh_tasks_NV(uint32_t in_task_count,
+                                                         uint32_t in_first_task)
+{
+    Anvil::ExtensionNVMeshShaderEntrypoints entrypoints;
+    bool                                    result     (false);
+
+    if (!m_is_renderpass_active)
+    {
+        anvil_assert(m_is_renderpass_active);
+
+        goto end;
+    }
+
+    if (!m_recording_in_progress)
+    {
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
+    }
+
+    anvil_assert(m_device_ptr->get_extension_info()->nv_mesh_shader() );
+
+    #ifdef STORE_COMMAND_BUFFER_COMMANDS
+    {
+        if (!m_command_stashing_disabled)
+        {
+            m_commands.push_back(m_command_arena.create<DrawMeshTasksNVCommand>(in_task_count,
+                                                                                in_first_task) );
+        }
+    }
+    #endif
+
+    entrypoints = m_device_ptr->get_extension_nv_mesh_shader_entrypoints();
+
+    flush_pending_barriers();
+
+    m_parent_command_pool_ptr->lock();
+    lock();
+    {
+        m_n_recorded_commands++;
+
+        entrypoints.vkCmdDrawMeshTasksNV(m_command_buffer,
+                                         in_task_count,
+                                         in_first_task);
+    }
+    unlock();
+    m_parent_command_pool_ptr->unlock();
+
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandBufferBase::record_end_conditional_rendering_EXT()
+{
+    Anvil::ExtensionEXTConditionalRenderingEntrypoints entrypoints;
+    bool                                               result     (false);
+
+    if (!m_is_conditional_rendering_active)
+    {
+        anvil_assert(m_is_conditional_rendering_active);
+
+        goto end;
+    }
+
+    if (!m_recording_in_progress)
+    {
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
+    }
+
+    #ifdef STORE_COMMAND_BUFFER_COMMANDS
+    {
+        if (!m_command_stashing_disabled)
+        {
+            m_commands.push_back(m_command_arena.create<EndConditionalRenderingEXTCommand>() );
+        }
+    }
+    #endif
+
+    entrypoints = m_device_ptr->get_extension_ext_conditional_rendering_entrypoints();
+
+    flush_pending_barriers();
+
+    m_parent_command_pool_ptr->lock();
+    lock();
+    {
+        m_n_recorded_commands++;
+
+        entrypoints.vkCmdEndConditionalRenderingEXT(m_command_buffer);
+    }
+    unlock();
+    m_parent_command_pool_ptr->unlock();
+
+    m_is_conditional_rendering_active = false;
+    result                            = true;
+end:
+    return result;
+}
+
 /* Please see header for specification */
 bool Anvil::CommandBufferBase::record_end_query(Anvil::QueryPool* in_query_pool_ptr,
                                                 Anvil::QueryIndex in_entry)
@@ -2984,18 +4703,22 @@ bool Anvil::CommandBufferBase::record_end_query(Anvil::QueryPool* in_query_pool_
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(EndQueryCommand(in_query_pool_ptr,
-                                                 in_entry) );
+            m_commands.push_back(m_command_arena.create<EndQueryCommand>(in_query_pool_ptr,
+                                                                         in_entry) );
         }
     }
     #endif
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdEndQuery(m_command_buffer,
-                                     in_query_pool_ptr->get_query_pool(),
-                                     in_entry);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdEndQuery(m_command_buffer,
+                                                         in_query_pool_ptr->get_query_pool(),
+                                                         in_entry);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -3025,16 +4748,20 @@ bool Anvil::CommandBufferBase::record_end_query_indexed_EXT(Anvil::QueryPool*
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(EndQueryIndexedEXTCommand(in_query_pool_ptr,
-                                                           in_query,
-                                                           in_index) );
+            m_commands.push_back(m_command_arena.create<EndQueryIndexedEXTCommand>(in_query_pool_ptr,
+                                                                                   in_query,
+                                                                                   in_index) );
         }
     }
     #endif
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
+        m_n_recorded_commands++;
+
         entrypoints.vkCmdEndQueryIndexedEXT(m_command_buffer,
                                             in_query_pool_ptr->get_query_pool(),
                                             in_query,
@@ -3048,15 +4775,65 @@ end:
     return result;
 }
 
+/* Please see header for specification */
+bool Anvil::CommandBufferBase::record_end_rendering_KHR()
+{
+    Anvil::ExtensionKHRDynamicRenderingEntrypoints entrypoints;
+    bool                                           result     (false);
+
+    if (!m_is_dynamic_rendering_active)
+    {
+        anvil_assert(m_is_dynamic_rendering_active);
+
+        goto end;
+    }
+
+    if (!m_recording_in_progress)
+    {
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
+    }
+
+    #ifdef STORE_COMMAND_BUFFER_COMMANDS
+    {
+        if (!m_command_stashing_disabled)
+        {
+            m_commands.push_back(m_command_arena.create<EndRenderingKHRCommand>() );
+        }
+    }
+    #endif
+
+    entrypoints = m_device_ptr->get_extension_khr_dynamic_rendering_entrypoints();
+
+    flush_pending_barriers();
+
+    m_parent_command_pool_ptr->lock();
+    lock();
+    {
+        m_n_recorded_commands++;
+
+        entrypoints.vkCmdEndRenderingKHR(m_command_buffer);
+    }
+    unlock();
+    m_parent_command_pool_ptr->unlock();
+
+    m_is_dynamic_rendering_active = false;
+    m_is_renderpass_active        = false;
+    result                        = true;
+end:
+    return result;
+}
+
 /* Please see header for specification */
 bool Anvil::CommandBufferBase::record_end_transform_feedback_EXT(const uint32_t&     in_first_counter_buffer,
                                                                  const uint32_t&     in_n_counter_buffers,
                                                                  Anvil::Buffer**     in_opt_counter_buffer_ptrs,
                                                                  const VkDeviceSize* in_opt_counter_buffer_offsets)
 {
-    auto        counter_buffer_ptrs = std::vector<VkBuffer>(in_n_counter_buffers);
-    const auto& entrypoints         = m_device_ptr->get_extension_ext_transform_feedback_entrypoints();
-    bool        result              = false;
+    ScratchArray<VkBuffer, N_MAX_STACK_SCRATCH_ITEMS> counter_buffer_ptrs(in_n_counter_buffers);
+    const auto&                                       entrypoints        (m_device_ptr->get_extension_ext_transform_feedback_entrypoints() );
+    bool                                              result             (false);
 
     if (!m_is_renderpass_active)
     {
@@ -3103,16 +4880,21 @@ bool Anvil::CommandBufferBase::record_end_transform_feedback_EXT(const uint32_t&
                 }
             }
 
-            m_commands.push_back(EndTransformFeedbackEXTCommand(in_first_counter_buffer,
-                                                                buffer_ptr_vec,
-                                                                offset_vec) );
+            m_commands.push_back(m_command_arena.create<EndTransformFeedbackEXTCommand>(in_first_counter_buffer,
+                                                                                        buffer_ptr_vec,
+                                                                                        offset_vec,
+                                                                                        &m_command_arena) );
         }
     }
     #endif
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
+        m_n_recorded_commands++;
+
         entrypoints.vkCmdEndTransformFeedbackEXT(m_command_buffer,
                                                  in_first_counter_buffer,
                                                  in_n_counter_buffers,
@@ -3153,22 +4935,30 @@ bool Anvil::CommandBufferBase::record_fill_buffer(Anvil::Buffer* in_dst_buffer_p
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(FillBufferCommand(in_dst_buffer_ptr,
-                                                   in_dst_offset,
-                                                   in_size,
-                                                   in_data) );
+            m_commands.push_back(m_command_arena.create<FillBufferCommand>(in_dst_buffer_ptr,
+                                                                           in_dst_offset,
+                                                                           in_size,
+                                                                           in_data) );
         }
     }
     #endif
 
+    track_buffer_access(in_dst_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                        Anvil::AccessFlagBits::TRANSFER_WRITE_BIT);
+
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdFillBuffer(m_command_buffer,
-                                       in_dst_buffer_ptr->get_buffer(),
-                                       in_dst_offset,
-                                       in_size,
-                                       in_data);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdFillBuffer(m_command_buffer,
+                                                           in_dst_buffer_ptr->get_buffer(),
+                                                           in_dst_offset,
+                                                           in_size,
+                                                           in_data);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -3190,10 +4980,10 @@ bool Anvil::CommandBufferBase::record_pipeline_barrier(Anvil::PipelineStageFlags
                                                        const ImageBarrier*  const in_image_memory_barriers_ptr)
 {
     /* NOTE: The command can be executed both inside and outside a renderpass */
-    auto buffer_barriers_vk = std::vector<VkBufferMemoryBarrier>(in_buffer_memory_barrier_count);
-    auto image_barriers_vk  = std::vector<VkImageMemoryBarrier> (in_image_memory_barrier_count);
-    auto memory_barriers_vk = std::vector<VkMemoryBarrier>      (in_memory_barrier_count);
-    bool result             = false;
+    ScratchArray<VkBufferMemoryBarrier, N_MAX_STACK_SCRATCH_ITEMS> buffer_barriers_vk(in_buffer_memory_barrier_count);
+    ScratchArray<VkImageMemoryBarrier,  N_MAX_STACK_SCRATCH_ITEMS> image_barriers_vk (in_image_memory_barrier_count);
+    ScratchArray<VkMemoryBarrier,       N_MAX_STACK_SCRATCH_ITEMS> memory_barriers_vk(in_memory_barrier_count);
+    bool                                                           result            (false);
 
     if (!m_recording_in_progress)
     {
@@ -3209,15 +4999,15 @@ bool Anvil::CommandBufferBase::record_pipeline_barrier(Anvil::PipelineStageFlags
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(PipelineBarrierCommand(in_src_stage_mask,
-                                                        in_dst_stage_mask,
-                                                        in_dependency_flags,
-                                                        in_memory_barrier_count,
-                                                        in_memory_barriers_ptr,
-                                                        in_buffer_memory_barrier_count,
-                                                        in_buffer_memory_barriers_ptr,
-                                                        in_image_memory_barrier_count,
-                                                        in_image_memory_barriers_ptr) );
+            m_commands.push_back(m_command_arena.create<PipelineBarrierCommand>(in_src_stage_mask,
+                                                                                in_dst_stage_mask,
+                                                                                in_dependency_flags,
+                                                                                in_memory_barrier_count,
+                                                                                in_memory_barriers_ptr,
+                                                                                in_buffer_memory_barrier_count,
+                                                                                in_buffer_memory_barriers_ptr,
+                                                                                in_image_memory_barrier_count,
+                                                                                in_image_memory_barriers_ptr) );
         }
     }
     #endif
@@ -3261,22 +5051,21 @@ bool Anvil::CommandBufferBase::record_pipeline_barrier(Anvil::PipelineStageFlags
         memory_barriers_vk.at(n_memory_barrier) = in_memory_barriers_ptr[n_memory_barrier].get_barrier_vk();
     }
 
-    m_parent_command_pool_ptr->lock();
-    lock();
-    {
-        Anvil::Vulkan::vkCmdPipelineBarrier(m_command_buffer,
-                                            in_src_stage_mask.get_vk  (),
-                                            in_dst_stage_mask.get_vk  (),
-                                            in_dependency_flags.get_vk(),
-                                            in_memory_barrier_count,
-                                            (in_memory_barrier_count > 0) ? &memory_barriers_vk.at(0) : nullptr,
-                                            in_buffer_memory_barrier_count,
-                                            (in_buffer_memory_barrier_count > 0) ? &buffer_barriers_vk.at(0) : nullptr,
-                                            in_image_memory_barrier_count,
-                                            (in_image_memory_barrier_count > 0) ? &image_barriers_vk.at(0) : nullptr);
-    }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    track_barriers(in_dst_stage_mask,
+                   in_buffer_memory_barrier_count,
+                   in_buffer_memory_barriers_ptr,
+                   in_image_memory_barrier_count,
+                   in_image_memory_barriers_ptr);
+
+    record_pipeline_barrier_internal(in_src_stage_mask,
+                                     in_dst_stage_mask,
+                                     in_dependency_flags,
+                                     in_memory_barrier_count,
+                                     memory_barriers_vk.data(),
+                                     in_buffer_memory_barrier_count,
+                                     buffer_barriers_vk.data(),
+                                     in_image_memory_barrier_count,
+                                     image_barriers_vk.data() );
 
     result = true;
 end:
@@ -3284,11 +5073,15 @@ end:
 }
 
 /* Please see header for specification */
-bool Anvil::CommandBufferBase::record_push_constants(Anvil::PipelineLayout*  in_layout_ptr,
-                                                     Anvil::ShaderStageFlags in_stage_flags,
-                                                     uint32_t                in_offset,
-                                                     uint32_t                in_size,
-                                                     const void*             in_values)
+bool Anvil::CommandBufferBase::record_pipeline_barrier_raw(Anvil::PipelineStageFlags     in_src_stage_mask,
+                                                           Anvil::PipelineStageFlags     in_dst_stage_mask,
+                                                           Anvil::DependencyFlags        in_dependency_flags,
+                                                           uint32_t                      in_memory_barrier_count,
+                                                           const RawMemoryBarrier* const in_memory_barriers_ptr,
+                                                           uint32_t                      in_buffer_memory_barrier_count,
+                                                           const RawBufferBarrier* const in_buffer_memory_barriers_ptr,
+                                                           uint32_t                      in_image_memory_barrier_count,
+                                                           const RawImageBarrier*  const in_image_memory_barriers_ptr)
 {
     /* NOTE: The command can be executed both inside and outside a renderpass */
     bool result = false;
@@ -3300,31 +5093,37 @@ bool Anvil::CommandBufferBase::record_push_constants(Anvil::PipelineLayout*  in_
         goto end;
     }
 
+    anvil_assert((!m_is_renderpass_active)                                                                           ||
+                 ((m_is_renderpass_active) && (in_dependency_flags & Anvil::DependencyFlagBits::VIEW_LOCAL_BIT) == 0));
+
     #ifdef STORE_COMMAND_BUFFER_COMMANDS
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(PushConstantsCommand(in_layout_ptr,
-                                                      in_stage_flags,
-                                                      in_offset,
-                                                      in_size,
-                                                      in_values) );
+            m_commands.push_back(m_command_arena.create<PipelineBarrierRawCommand>(in_src_stage_mask,
+                                                                                   in_dst_stage_mask,
+                                                                                   in_dependency_flags,
+                                                                                   in_memory_barrier_count,
+                                                                                   in_memory_barriers_ptr,
+                                                                                   in_buffer_memory_barrier_count,
+                                                                                   in_buffer_memory_barriers_ptr,
+                                                                                   in_image_memory_barrier_count,
+                                                                                   in_image_memory_barriers_ptr,
+                                                                                   &m_command_arena) );
         }
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
-    {
-        Anvil::Vulkan::vkCmdPushConstants(m_command_buffer,
-                                          in_layout_ptr->get_pipeline_layout(),
-                                          in_stage_flags.get_vk(),
-                                          in_offset,
-                                          in_size,
-                                          in_values);
-    }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    /* Raw barriers map 1:1 to their Vulkan counterparts, so they are handed over as-is */
+    record_pipeline_barrier_internal(in_src_stage_mask,
+                                     in_dst_stage_mask,
+                                     in_dependency_flags,
+                                     in_memory_barrier_count,
+                                     (in_memory_barrier_count        > 0) ? &in_memory_barriers_ptr[0].get_vk()        : nullptr,
+                                     in_buffer_memory_barrier_count,
+                                     (in_buffer_memory_barrier_count > 0) ? &in_buffer_memory_barriers_ptr[0].get_vk() : nullptr,
+                                     in_image_memory_barrier_count,
+                                     (in_image_memory_barrier_count  > 0) ? &in_image_memory_barriers_ptr[0].get_vk()  : nullptr);
 
     result = true;
 end:
@@ -3332,18 +5131,15 @@ end:
 }
 
 /* Please see header for specification */
-bool Anvil::CommandBufferBase::record_reset_event(Anvil::Event*             in_event_ptr,
-                                                  Anvil::PipelineStageFlags in_stage_mask)
+bool Anvil::CommandBufferBase::record_push_constants(Anvil::PipelineLayout*  in_layout_ptr,
+                                                     Anvil::ShaderStageFlags in_stage_flags,
+                                                     uint32_t                in_offset,
+                                                     uint32_t                in_size,
+                                                     const void*             in_values)
 {
+    /* NOTE: The command can be executed both inside and outside a renderpass */
     bool result = false;
 
-    if (m_is_renderpass_active)
-    {
-        anvil_assert(!m_is_renderpass_active);
-
-        goto end;
-    }
-
     if (!m_recording_in_progress)
     {
         anvil_assert(m_recording_in_progress);
@@ -3355,8 +5151,19 @@ bool Anvil::CommandBufferBase::record_reset_event(Anvil::Event*             in_e
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(ResetEventCommand(in_event_ptr,
-                                                   in_stage_mask) );
+            /* Keep a copy of the values, so that the command can be replayed after the caller releases them */
+            void* values_copy_ptr = m_command_arena.allocate(in_size,
+                                                             sizeof(uint32_t) );
+
+            memcpy(values_copy_ptr,
+                   in_values,
+                   in_size);
+
+            m_commands.push_back(m_command_arena.create<PushConstantsCommand>(in_layout_ptr,
+                                                                              in_stage_flags,
+                                                                              in_offset,
+                                                                              in_size,
+                                                                              values_copy_ptr) );
         }
     }
     #endif
@@ -3364,9 +5171,14 @@ bool Anvil::CommandBufferBase::record_reset_event(Anvil::Event*             in_e
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdResetEvent(m_command_buffer,
-                                       in_event_ptr->get_event(),
-                                       in_stage_mask.get_vk() );
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdPushConstants(m_command_buffer,
+                                                              in_layout_ptr->get_pipeline_layout(),
+                                                              in_stage_flags.get_vk(),
+                                                              in_offset,
+                                                              in_size,
+                                                              in_values);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -3377,7 +5189,1544 @@ end:
 }
 
 /* Please see header for specification */
-bool Anvil::CommandBufferBase::record_reset_query_pool(Anvil::QueryPool* in_query_pool_ptr,
+bool Anvil::CommandBufferBase::record_push_descriptor_set_KHR(Anvil::PipelineBindPoint          in_pipeline_bind_point,
+                                                              Anvil::PipelineLayout*            in_layout_ptr,
+                                                              uint32_t                          in_set,
+                                                              uint32_t                          in_n_writes,
+                                                              const Anvil::PushDescriptorWrite* in_writes_ptr)
+{
+    /* NOTE: The command can be executed both inside and outside a renderpass */
+    ScratchArray<VkDescriptorBufferInfo, N_MAX_STACK_SCRATCH_ITEMS> buffer_infos_vk(in_n_writes);
+    ScratchArray<VkBufferView,           N_MAX_STACK_SCRATCH_ITEMS> buffer_views_vk(in_n_writes);
+    ScratchArray<VkDescriptorImageInfo,  N_MAX_STACK_SCRATCH_ITEMS> image_infos_vk (in_n_writes);
+    bool                                                            result         (false);
+    ScratchArray<VkWriteDescriptorSet,   N_MAX_STACK_SCRATCH_ITEMS> writes_vk      (in_n_writes);
+
+    if (!m_recording_in_progress)
+    {
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
+    }
+
+    if (!m_device_ptr->get_extension_info()->khr_push_descriptor() )
+    {
+        anvil_assert(m_device_ptr->get_extension_info()->khr_push_descriptor() );
+
+        goto end;
+    }
+
+    /* Each write refers to a single descriptor, so the info arrays are indexed with the write index */
+    for (uint32_t n_write = 0;
+                  n_write < in_n_writes;
+                ++n_write)
+    {
+        const auto&          current_write = in_writes_ptr[n_write];
+        VkWriteDescriptorSet write_vk;
+
+        write_vk.descriptorCount  = 1;
+        write_vk.descriptorType   = static_cast<VkDescriptorType>(current_write.descriptor_type);
+        write_vk.dstArrayElement  = current_write.n_array_element;
+        write_vk.dstBinding       = current_write.binding;
+        write_vk.dstSet           = VK_NULL_HANDLE; /* ignored for push descriptors */
+        write_vk.pBufferInfo      = nullptr;
+        write_vk.pImageInfo       = nullptr;
+        write_vk.pNext            = nullptr;
+        write_vk.pTexelBufferView = nullptr;
+        write_vk.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+
+        switch (current_write.descriptor_type)
+        {
+            case Anvil::DescriptorType::STORAGE_BUFFER:
+            case Anvil::DescriptorType::UNIFORM_BUFFER:
+            {
+                VkDescriptorBufferInfo buffer_info_vk;
+
+                buffer_info_vk.buffer = current_write.buffer_ptr->get_buffer();
+
+                if (current_write.buffer_start_offset != UINT64_MAX)
+                {
+                    buffer_info_vk.offset = current_write.buffer_start_offset;
+                    buffer_info_vk.range  = current_write.buffer_size;
+                }
+                else
+                {
+                    buffer_info_vk.offset = current_write.buffer_ptr->get_create_info_ptr()->get_start_offset();
+                    buffer_info_vk.range  = current_write.buffer_ptr->get_create_info_ptr()->get_size        ();
+                }
+
+                buffer_infos_vk.at(n_write) = buffer_info_vk;
+
+                write_vk.pBufferInfo = &buffer_infos_vk.at(n_write);
+
+                break;
+            }
+
+            case Anvil::DescriptorType::STORAGE_TEXEL_BUFFER:
+            case Anvil::DescriptorType::UNIFORM_TEXEL_BUFFER:
+            {
+                buffer_views_vk.at(n_write) = current_write.buffer_view_ptr->get_buffer_view();
+
+                write_vk.pTexelBufferView = &buffer_views_vk.at(n_write);
+
+                break;
+            }
+
+            case Anvil::DescriptorType::COMBINED_IMAGE_SAMPLER:
+            case Anvil::DescriptorType::INPUT_ATTACHMENT:
+            case Anvil::DescriptorType::SAMPLED_IMAGE:
+            case Anvil::DescriptorType::SAMPLER:
+            case Anvil::DescriptorType::STORAGE_IMAGE:
+            {
+                VkDescriptorImageInfo image_info_vk;
+
+                image_info_vk.imageLayout = static_cast<VkImageLayout>(current_write.image_layout);
+                image_info_vk.imageView   = (current_write.image_view_ptr != nullptr) ? current_write.image_view_ptr->get_image_view()
+                                                                                      : VK_NULL_HANDLE;
+                image_info_vk.sampler     = (current_write.sampler_ptr    != nullptr) ? current_write.sampler_ptr->get_sampler()
+                                                                                      : VK_NULL_HANDLE;
+
+                image_infos_vk.at(n_write) = image_info_vk;
+
+                write_vk.pImageInfo = &image_infos_vk.at(n_write);
+
+                break;
+            }
+
+            default:
+            {
+                /* Dynamic buffers and inline uniform blocks cannot be pushed */
+                anvil_assert_fail();
+
+                goto end;
+            }
+        }
+
+        writes_vk.at(n_write) = write_vk;
+    }
+
+    #ifdef STORE_COMMAND_BUFFER_COMMANDS
+    {
+        if (!m_command_stashing_disabled)
+        {
+            m_commands.push_back(m_command_arena.create<PushDescriptorSetKHRCommand>(in_pipeline_bind_point,
+                                                                                     in_layout_ptr,
+                                                                                     in_set,
+                                                                                     in_n_writes,
+                                                                                     in_writes_ptr,
+                                                                                     &m_command_arena) );
+        }
+    }
+    #endif
+
+    /* Pushed descriptors replace whatever set has been bound at the index */
+    for (uint32_t n_bind_point = 0;
+                  n_bind_point < 2;
+                ++n_bind_point)
+    {
+        auto& bound_sets = m_bound_state.descriptor_sets[n_bind_point];
+
+        if (in_set < bound_sets.size() )
+        {
+            bound_sets.at(in_set) = VK_NULL_HANDLE;
+        }
+    }
+
+    m_parent_command_pool_ptr->lock();
+    lock();
+    {
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_extension_khr_push_descriptor_entrypoints().vkCmdPushDescriptorSetKHR(m_command_buffer,
+                                                                                                static_cast<VkPipelineBindPoint>(in_pipeline_bind_point),
+                                                                                                in_layout_ptr->get_pipeline_layout(),
+                                                                                                in_set,
+                                                                                                static_cast<uint32_t>(writes_vk.size() ),
+                                                                                                (writes_vk.size() > 0) ? &writes_vk.at(0) : nullptr);
+    }
+    unlock();
+    m_parent_command_pool_ptr->unlock();
+
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandBufferBase::record_push_descriptor_set_with_template_KHR(const Anvil::DescriptorUpdateTemplate* in_template_ptr,
+                                                                            Anvil::PipelineLayout*                 in_layout_ptr,
+                                                                            uint32_t                               in_set,
+                                                                            const void*                            in_data_ptr)
+{
+    /* NOTE: The command can be executed both inside and outside a renderpass */
+    bool result = false;
+
+    if (!m_recording_in_progress)
+    {
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
+    }
+
+    if (!in_template_ptr->is_push_descriptor_template() )
+    {
+        anvil_assert(in_template_ptr->is_push_descriptor_template() );
+
+        goto end;
+    }
+
+    if (m_device_ptr->get_extension_khr_push_descriptor_entrypoints().vkCmdPushDescriptorSetWithTemplateKHR == nullptr)
+    {
+        anvil_assert(m_device_ptr->get_extension_khr_push_descriptor_entrypoints().vkCmdPushDescriptorSetWithTemplateKHR != nullptr);
+
+        goto end;
+    }
+
+    #ifdef STORE_COMMAND_BUFFER_COMMANDS
+    {
+        if (!m_command_stashing_disabled)
+        {
+            /* Keep a copy of the template data, so that the command can be inspected after the caller releases it */
+            const size_t data_size     = in_template_ptr->get_data_size();
+            void*        data_copy_ptr = nullptr;
+
+            if (data_size > 0)
+            {
+                data_copy_ptr = m_command_arena.allocate(data_size,
+                                                         alignof(VkDescriptorImageInfo) );
+
+                memcpy(data_copy_ptr,
+                       in_data_ptr,
+                       data_size);
+            }
+
+            m_commands.push_back(m_command_arena.create<PushDescriptorSetWithTemplateKHRCommand>(in_template_ptr,
+                                                                                                 in_layout_ptr,
+                                                                                                 in_set,
+                                                                                                 data_copy_ptr) );
+        }
+    }
+    #endif
+
+    /* Pushed descriptors replace whatever set has been bound at the index */
+    for (uint32_t n_bind_point = 0;
+                  n_bind_point < 2;
+                ++n_bind_point)
+    {
+        auto& bound_sets = m_bound_state.descriptor_sets[n_bind_point];
+
+        if (in_set < bound_sets.size() )
+        {
+            bound_sets.at(in_set) = VK_NULL_HANDLE;
+        }
+    }
+
+    m_parent_command_pool_ptr->lock();
+    lock();
+    {
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_extension_khr_push_descriptor_entrypoints().vkCmdPushDescriptorSetWithTemplateKHR(m_command_buffer,
+                                                                                                            in_template_ptr->get_descriptor_update_template(),
+                                                                                                            in_layout_ptr->get_pipeline_layout(),
+                                                                                                            in_set,
+                                                                                                            in_data_ptr);
+    }
+    unlock();
+    m_parent_command_pool_ptr->unlock();
+
+    result = true;
+end:
+    return result;
+}
+
+#ifdef STORE_COMMAND_BUFFER_COMMANDS
+    /* Please see header for specification */
+    bool Anvil::CommandBufferBase::record_replay(const CommandBufferBase*       in_src_command_buffer_ptr,
+                                                 const CommandReplayRemapTable* in_opt_remap_table_ptr)
+    {
+        static const CommandReplayRemapTable empty_remap_table;
+
+        std::vector<Anvil::BufferBarrier>        buffer_barriers;
+        std::vector<Anvil::Buffer*>              buffer_ptrs;
+        std::vector<VkBuffer>                    buffers_vk;
+        std::vector<VkClearAttachment>           clear_attachments_vk;
+        std::vector<const Anvil::DescriptorSet*> ds_ptrs;
+        std::vector<VkDescriptorSet>             dss_vk;
+        std::vector<Anvil::ImageBarrier>         image_barriers;
+        bool                                     is_locked              = false;
+        bool                                     needs_barrier_flush    = false;
+        std::vector<VkDeviceSize>                offsets;
+        PrimaryCommandBuffer*                    primary_cmd_buffer_ptr = (m_type == COMMAND_BUFFER_TYPE_PRIMARY) ? static_cast<PrimaryCommandBuffer*>(this)
+                                                                                                                  : nullptr;
+        const CommandReplayRemapTable&           remap_table            = (in_opt_remap_table_ptr != nullptr) ? *in_opt_remap_table_ptr
+                                                                                                              :  empty_remap_table;
+        bool                                     result                 = false;
+
+        /* Commands emitted directly from the stash are recorded under a single lock. Commands forwarded
+         * to their record_*() counterparts lock on their own, and may leave deferred barriers behind. */
+        const auto acquire_lock = [&]()
+        {
+            if (needs_barrier_flush)
+            {
+                flush_pending_barriers();
+
+                needs_barrier_flush = false;
+            }
+
+            if (!is_locked)
+            {
+                m_parent_command_pool_ptr->lock();
+                lock();
+
+                is_locked = true;
+            }
+        };
+
+        if (in_src_command_buffer_ptr == nullptr ||
+            in_src_command_buffer_ptr == this)
+        {
+            anvil_assert(in_src_command_buffer_ptr != nullptr &&
+                         in_src_command_buffer_ptr != this);
+
+            goto end;
+        }
+
+        if (!m_recording_in_progress)
+        {
+            anvil_assert(m_recording_in_progress);
+
+            goto end;
+        }
+
+        flush_pending_barriers();
+
+        for (const auto current_command_ptr : in_src_command_buffer_ptr->m_commands)
+        {
+            bool command_result = true;
+
+            switch (current_command_ptr->type)
+            {
+                case COMMAND_TYPE_BIND_DESCRIPTOR_SETS:
+                {
+                    const auto command_ptr = static_cast<const BindDescriptorSetsCommand*>(current_command_ptr);
+
+                    ds_ptrs.resize(command_ptr->descriptor_sets.size() );
+                    dss_vk.resize (command_ptr->descriptor_sets.size() );
+
+                    for (uint32_t n_set = 0;
+                                  n_set < static_cast<uint32_t>(dss_vk.size() );
+                                ++n_set)
+                    {
+                        ds_ptrs.at(n_set) = remap_table.get_descriptor_set(command_ptr->descriptor_sets.at(n_set) );
+                        dss_vk.at (n_set) = ds_ptrs.at(n_set)->get_descriptor_set_vk();
+                    }
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdBindDescriptorSets(m_command_buffer,
+                                                                               static_cast<VkPipelineBindPoint>(command_ptr->pipeline_bind_point),
+                                                                               command_ptr->layout_ptr->get_pipeline_layout(),
+                                                                               command_ptr->first_set,
+                                                                               static_cast<uint32_t>(dss_vk.size() ),
+                                                                               (dss_vk.size() > 0)                       ? &dss_vk.at(0)                       : nullptr,
+                                                                               static_cast<uint32_t>(command_ptr->dynamic_offsets.size() ),
+                                                                               (command_ptr->dynamic_offsets.size() > 0) ? &command_ptr->dynamic_offsets.at(0) : nullptr);
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        m_commands.push_back(m_command_arena.create<BindDescriptorSetsCommand>(command_ptr->pipeline_bind_point,
+                                                                                               command_ptr->layout_ptr,
+                                                                                               command_ptr->first_set,
+                                                                                               static_cast<uint32_t>(ds_ptrs.size() ),
+                                                                                               (ds_ptrs.size() > 0)                      ? &ds_ptrs.at(0)                      : nullptr,
+                                                                                               static_cast<uint32_t>(command_ptr->dynamic_offsets.size() ),
+                                                                                               (command_ptr->dynamic_offsets.size() > 0) ? &command_ptr->dynamic_offsets.at(0) : nullptr,
+                                                                                              &m_command_arena) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_BIND_INDEX_BUFFER:
+                {
+                    const auto command_ptr = static_cast<const BindIndexBufferCommand*>(current_command_ptr);
+                    const auto buffer_vk   = remap_table.get_buffer(command_ptr->buffer_ptr)->get_buffer();
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdBindIndexBuffer(m_command_buffer,
+                                                                            buffer_vk,
+                                                                            command_ptr->offset,
+                                                                            static_cast<VkIndexType>(command_ptr->index_type) );
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        m_commands.push_back(m_command_arena.create<BindIndexBufferCommand>(remap_table.get_buffer(command_ptr->buffer_ptr),
+                                                                                            command_ptr->offset,
+                                                                                            command_ptr->index_type) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_BIND_PIPELINE:
+                {
+                    const auto command_ptr = static_cast<const BindPipelineCommand*>(current_command_ptr);
+                    const auto pipeline_vk = (command_ptr->pipeline_bind_point == Anvil::PipelineBindPoint::COMPUTE) ? m_device_ptr->get_compute_pipeline_manager ()->get_pipeline(command_ptr->pipeline_id)
+                                                                                                                     : m_device_ptr->get_graphics_pipeline_manager()->get_pipeline(command_ptr->pipeline_id);
+
+                    acquire_lock();
+
+                    m_n_recorded_pipeline_binds++;
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdBindPipeline(m_command_buffer,
+                                                                         static_cast<VkPipelineBindPoint>(command_ptr->pipeline_bind_point),
+                                                                         pipeline_vk);
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        m_commands.push_back(m_command_arena.create<BindPipelineCommand>(command_ptr->pipeline_bind_point,
+                                                                                         command_ptr->pipeline_id) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_BIND_VERTEX_BUFFER:
+                {
+                    const auto command_ptr = static_cast<const BindVertexBuffersCommand*>(current_command_ptr);
+
+                    buffer_ptrs.resize(command_ptr->bindings.size() );
+                    buffers_vk.resize (command_ptr->bindings.size() );
+                    offsets.resize    (command_ptr->bindings.size() );
+
+                    for (uint32_t n_binding = 0;
+                                  n_binding < static_cast<uint32_t>(buffers_vk.size() );
+                                ++n_binding)
+                    {
+                        buffer_ptrs.at(n_binding) = remap_table.get_buffer(command_ptr->bindings.at(n_binding).buffer_ptr);
+                        buffers_vk.at (n_binding) = buffer_ptrs.at(n_binding)->get_buffer();
+                        offsets.at    (n_binding) = command_ptr->bindings.at(n_binding).offset;
+                    }
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdBindVertexBuffers(m_command_buffer,
+                                                                              command_ptr->start_binding,
+                                                                              static_cast<uint32_t>(buffers_vk.size() ),
+                                                                              (buffers_vk.size() > 0) ? &buffers_vk.at(0) : nullptr,
+                                                                              (offsets.size   () > 0) ? &offsets.at   (0) : nullptr);
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        m_commands.push_back(m_command_arena.create<BindVertexBuffersCommand>(command_ptr->start_binding,
+                                                                                              static_cast<uint32_t>(buffer_ptrs.size() ),
+                                                                                              (buffer_ptrs.size() > 0) ? &buffer_ptrs.at(0) : nullptr,
+                                                                                              (offsets.size    () > 0) ? &offsets.at    (0) : nullptr,
+                                                                                             &m_command_arena) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_CLEAR_ATTACHMENTS:
+                {
+                    const auto command_ptr = static_cast<const ClearAttachmentsCommand*>(current_command_ptr);
+
+                    clear_attachments_vk.resize(command_ptr->attachments.size() );
+
+                    for (uint32_t n_attachment = 0;
+                                  n_attachment < static_cast<uint32_t>(clear_attachments_vk.size() );
+                                ++n_attachment)
+                    {
+                        const auto& current_attachment = command_ptr->attachments.at(n_attachment);
+
+                        clear_attachments_vk.at(n_attachment).aspectMask      = current_attachment.aspect_mask.get_vk();
+                        clear_attachments_vk.at(n_attachment).clearValue      = current_attachment.clear_value;
+                        clear_attachments_vk.at(n_attachment).colorAttachment = current_attachment.color_attachment;
+                    }
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdClearAttachments(m_command_buffer,
+                                                                             static_cast<uint32_t>(clear_attachments_vk.size() ),
+                                                                             (clear_attachments_vk.size() > 0) ? &clear_attachments_vk.at(0) : nullptr,
+                                                                             static_cast<uint32_t>(command_ptr->rects.size() ),
+                                                                             command_ptr->rects.data() );
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        /* Anvil::ClearAttachment maps 1:1 to VkClearAttachment */
+                        m_commands.push_back(m_command_arena.create<ClearAttachmentsCommand>(static_cast<uint32_t>(clear_attachments_vk.size() ),
+                                                                                             (clear_attachments_vk.size() > 0) ? reinterpret_cast<const Anvil::ClearAttachment*>(&clear_attachments_vk.at(0) )
+                                                                                                                               : nullptr,
+                                                                                             static_cast<uint32_t>(command_ptr->rects.size() ),
+                                                                                             command_ptr->rects.data(),
+                                                                                            &m_command_arena) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_DISPATCH:
+                {
+                    const auto command_ptr = static_cast<const DispatchCommand*>(current_command_ptr);
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdDispatch(m_command_buffer,
+                                                                     command_ptr->x,
+                                                                     command_ptr->y,
+                                                                     command_ptr->z);
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        m_commands.push_back(m_command_arena.create<DispatchCommand>(command_ptr->x,
+                                                                                     command_ptr->y,
+                                                                                     command_ptr->z) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_DISPATCH_INDIRECT:
+                {
+                    const auto command_ptr = static_cast<const DispatchIndirectCommand*>(current_command_ptr);
+                    const auto buffer_vk   = remap_table.get_buffer(command_ptr->buffer_ptr)->get_buffer();
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdDispatchIndirect(m_command_buffer,
+                                                                             buffer_vk,
+                                                                             command_ptr->offset);
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        m_commands.push_back(m_command_arena.create<DispatchIndirectCommand>(remap_table.get_buffer(command_ptr->buffer_ptr),
+                                                                                             command_ptr->offset) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_DRAW:
+                {
+                    const auto command_ptr = static_cast<const DrawCommand*>(current_command_ptr);
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdDraw(m_command_buffer,
+                                                                 command_ptr->vertex_count,
+                                                                 command_ptr->instance_count,
+                                                                 command_ptr->first_vertex,
+                                                                 command_ptr->first_instance);
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        m_commands.push_back(m_command_arena.create<DrawCommand>(command_ptr->vertex_count,
+                                                                                 command_ptr->instance_count,
+                                                                                 command_ptr->first_vertex,
+                                                                                 command_ptr->first_instance) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_DRAW_INDEXED:
+                {
+                    const auto command_ptr = static_cast<const DrawIndexedCommand*>(current_command_ptr);
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdDrawIndexed(m_command_buffer,
+                                                                        command_ptr->index_count,
+                                                                        command_ptr->instance_count,
+                                                                        command_ptr->first_index,
+                                                                        command_ptr->vertex_offset,
+                                                                        command_ptr->first_instance);
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        m_commands.push_back(m_command_arena.create<DrawIndexedCommand>(command_ptr->index_count,
+                                                                                        command_ptr->instance_count,
+                                                                                        command_ptr->first_index,
+                                                                                        command_ptr->vertex_offset,
+                                                                                        command_ptr->first_instance) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_DRAW_INDEXED_INDIRECT:
+                {
+                    const auto command_ptr = static_cast<const DrawIndexedIndirectCommand*>(current_command_ptr);
+                    const auto buffer_vk   = remap_table.get_buffer(command_ptr->buffer_ptr)->get_buffer();
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdDrawIndexedIndirect(m_command_buffer,
+                                                                                buffer_vk,
+                                                                                command_ptr->offset,
+                                                                                command_ptr->draw_count,
+                                                                                command_ptr->stride);
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        m_commands.push_back(m_command_arena.create<DrawIndexedIndirectCommand>(remap_table.get_buffer(command_ptr->buffer_ptr),
+                                                                                                command_ptr->offset,
+                                                                                                command_ptr->draw_count,
+                                                                                                command_ptr->stride) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_DRAW_INDIRECT:
+                {
+                    const auto command_ptr = static_cast<const DrawIndirectCommand*>(current_command_ptr);
+                    const auto buffer_vk   = remap_table.get_buffer(command_ptr->buffer_ptr)->get_buffer();
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdDrawIndirect(m_command_buffer,
+                                                                         buffer_vk,
+                                                                         command_ptr->offset,
+                                                                         command_ptr->count,
+                                                                         command_ptr->stride);
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        m_commands.push_back(m_command_arena.create<DrawIndirectCommand>(remap_table.get_buffer(command_ptr->buffer_ptr),
+                                                                                         command_ptr->offset,
+                                                                                         command_ptr->count,
+                                                                                         command_ptr->stride) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_PUSH_CONSTANTS:
+                {
+                    const auto command_ptr = static_cast<const PushConstantsCommand*>(current_command_ptr);
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdPushConstants(m_command_buffer,
+                                                                          command_ptr->layout_ptr->get_pipeline_layout(),
+                                                                          command_ptr->stage_flags.get_vk(),
+                                                                          command_ptr->offset,
+                                                                          command_ptr->size,
+                                                                          command_ptr->values);
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        /* The source buffer's copy of the values lives in its own arena, so take a separate copy */
+                        void* values_copy_ptr = m_command_arena.allocate(command_ptr->size,
+                                                                         sizeof(uint32_t) );
+
+                        memcpy(values_copy_ptr,
+                               command_ptr->values,
+                               command_ptr->size);
+
+                        m_commands.push_back(m_command_arena.create<PushConstantsCommand>(command_ptr->layout_ptr,
+                                                                                          command_ptr->stage_flags,
+                                                                                          command_ptr->offset,
+                                                                                          command_ptr->size,
+                                                                                          values_copy_ptr) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_SET_BLEND_CONSTANTS:
+                {
+                    const auto command_ptr = static_cast<const SetBlendConstantsCommand*>(current_command_ptr);
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdSetBlendConstants(m_command_buffer,
+                                                                              command_ptr->blend_constants);
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        m_commands.push_back(m_command_arena.create<SetBlendConstantsCommand>(command_ptr->blend_constants) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_SET_DEPTH_BIAS:
+                {
+                    const auto command_ptr = static_cast<const SetDepthBiasCommand*>(current_command_ptr);
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdSetDepthBias(m_command_buffer,
+                                                                         command_ptr->depth_bias_constant_factor,
+                                                                         command_ptr->depth_bias_clamp,
+                                                                         command_ptr->slope_scaled_depth_bias);
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        m_commands.push_back(m_command_arena.create<SetDepthBiasCommand>(command_ptr->depth_bias_constant_factor,
+                                                                                         command_ptr->depth_bias_clamp,
+                                                                                         command_ptr->slope_scaled_depth_bias) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_SET_DEPTH_BOUNDS:
+                {
+                    const auto command_ptr = static_cast<const SetDepthBoundsCommand*>(current_command_ptr);
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdSetDepthBounds(m_command_buffer,
+                                                                           command_ptr->min_depth_bounds,
+                                                                           command_ptr->max_depth_bounds);
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        m_commands.push_back(m_command_arena.create<SetDepthBoundsCommand>(command_ptr->min_depth_bounds,
+                                                                                           command_ptr->max_depth_bounds) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_SET_LINE_WIDTH:
+                {
+                    const auto command_ptr = static_cast<const SetLineWidthCommand*>(current_command_ptr);
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdSetLineWidth(m_command_buffer,
+                                                                         command_ptr->line_width);
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        m_commands.push_back(m_command_arena.create<SetLineWidthCommand>(command_ptr->line_width) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_SET_SCISSOR:
+                {
+                    const auto command_ptr = static_cast<const SetScissorCommand*>(current_command_ptr);
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdSetScissor(m_command_buffer,
+                                                                       command_ptr->first_scissor,
+                                                                       static_cast<uint32_t>(command_ptr->scissors.size() ),
+                                                                       command_ptr->scissors.data() );
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        m_commands.push_back(m_command_arena.create<SetScissorCommand>(command_ptr->first_scissor,
+                                                                                       static_cast<uint32_t>(command_ptr->scissors.size() ),
+                                                                                       command_ptr->scissors.data(),
+                                                                                      &m_command_arena) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_SET_STENCIL_COMPARE_MASK:
+                {
+                    const auto command_ptr = static_cast<const SetStencilCompareMaskCommand*>(current_command_ptr);
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdSetStencilCompareMask(m_command_buffer,
+                                                                                  command_ptr->face_mask.get_vk(),
+                                                                                  command_ptr->stencil_compare_mask);
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        m_commands.push_back(m_command_arena.create<SetStencilCompareMaskCommand>(command_ptr->face_mask,
+                                                                                                  command_ptr->stencil_compare_mask) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_SET_STENCIL_REFERENCE:
+                {
+                    const auto command_ptr = static_cast<const SetStencilReferenceCommand*>(current_command_ptr);
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdSetStencilReference(m_command_buffer,
+                                                                                command_ptr->face_mask.get_vk(),
+                                                                                command_ptr->stencil_reference);
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        m_commands.push_back(m_command_arena.create<SetStencilReferenceCommand>(command_ptr->face_mask,
+                                                                                                command_ptr->stencil_reference) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_SET_STENCIL_WRITE_MASK:
+                {
+                    const auto command_ptr = static_cast<const SetStencilWriteMaskCommand*>(current_command_ptr);
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdSetStencilWriteMask(m_command_buffer,
+                                                                                command_ptr->face_mask.get_vk(),
+                                                                                command_ptr->stencil_write_mask);
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        m_commands.push_back(m_command_arena.create<SetStencilWriteMaskCommand>(command_ptr->face_mask,
+                                                                                                command_ptr->stencil_write_mask) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_SET_VIEWPORT:
+                {
+                    const auto command_ptr = static_cast<const SetViewportCommand*>(current_command_ptr);
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    m_device_ptr->get_dispatch_table().vkCmdSetViewport(m_command_buffer,
+                                                                        command_ptr->first_viewport,
+                                                                        static_cast<uint32_t>(command_ptr->viewports.size() ),
+                                                                        command_ptr->viewports.data() );
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        m_commands.push_back(m_command_arena.create<SetViewportCommand>(command_ptr->first_viewport,
+                                                                                        static_cast<uint32_t>(command_ptr->viewports.size() ),
+                                                                                        command_ptr->viewports.data(),
+                                                                                       &m_command_arena) );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_SET_VIEWPORT_SHADING_RATE_PALETTE_NV:
+                {
+                    const auto command_ptr = static_cast<const SetViewportShadingRatePaletteNVCommand*>(current_command_ptr);
+                    const auto entrypoints = m_device_ptr->get_extension_nv_shading_rate_image_entrypoints();
+
+                    acquire_lock();
+
+                    m_n_recorded_commands++;
+
+                    entrypoints.vkCmdSetViewportShadingRatePaletteNV(m_command_buffer,
+                                                                     command_ptr->first_viewport,
+                                                                     static_cast<uint32_t>(command_ptr->palettes.size() ),
+                                                                     command_ptr->palettes.data() );
+
+                    if (!m_command_stashing_disabled)
+                    {
+                        m_commands.push_back(m_command_arena.create<SetViewportShadingRatePaletteNVCommand>(command_ptr->first_viewport,
+                                                                                                            static_cast<uint32_t>(command_ptr->palettes.size() ),
+                                                                                                            command_ptr->palettes.data(),
+                                                                                                           &m_command_arena) );
+                    }
+
+                    break;
+                }
+
+                /* Commands below are forwarded to their record_*() counterparts */
+                case COMMAND_TYPE_BEGIN_CONDITIONAL_RENDERING_EXT:
+                {
+                    const auto command_ptr = static_cast<const BeginConditionalRenderingEXTCommand*>(current_command_ptr);
+
+                    command_result = record_begin_conditional_rendering_EXT(remap_table.get_buffer(command_ptr->buffer_ptr),
+                                                                            command_ptr->offset,
+                                                                            command_ptr->flags);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_BEGIN_QUERY:
+                {
+                    const auto command_ptr = static_cast<const BeginQueryCommand*>(current_command_ptr);
+
+                    command_result = record_begin_query(command_ptr->query_pool_ptr,
+                                                        command_ptr->entry,
+                                                        command_ptr->flags);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_BEGIN_RENDERING_KHR:
+                {
+                    const auto command_ptr = static_cast<const BeginRenderingKHRCommand*>(current_command_ptr);
+
+                    command_result = record_begin_rendering_KHR(command_ptr->render_area,
+                                                                command_ptr->layer_count,
+                                                                command_ptr->view_mask,
+                                                                static_cast<uint32_t>(command_ptr->color_attachments.size() ),
+                                                                command_ptr->color_attachments.data(),
+                                                                (command_ptr->has_depth_attachment)   ? &command_ptr->depth_attachment   : nullptr,
+                                                                (command_ptr->has_stencil_attachment) ? &command_ptr->stencil_attachment : nullptr,
+                                                                command_ptr->flags);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_BEGIN_RENDER_PASS:
+                case COMMAND_TYPE_BEGIN_RENDER_PASS_2_KHR:
+                {
+                    const auto command_ptr = static_cast<const BeginRenderPassCommand*>(current_command_ptr);
+
+                    if (primary_cmd_buffer_ptr == nullptr)
+                    {
+                        anvil_assert(primary_cmd_buffer_ptr != nullptr);
+
+                        command_result = false;
+                        break;
+                    }
+
+                    if (current_command_ptr->type == COMMAND_TYPE_BEGIN_RENDER_PASS)
+                    {
+                        command_result = primary_cmd_buffer_ptr->record_begin_render_pass(static_cast<uint32_t>(command_ptr->clear_values.size() ),
+                                                                                          (command_ptr->clear_values.size() > 0) ? &command_ptr->clear_values.at(0) : nullptr,
+                                                                                          remap_table.get_framebuffer(command_ptr->fbo_ptr),
+                                                                                          command_ptr->device_mask,
+                                                                                          static_cast<uint32_t>(command_ptr->render_areas.size() ),
+                                                                                          &command_ptr->render_areas.at(0),
+                                                                                          command_ptr->render_pass_ptr,
+                                                                                          command_ptr->contents,
+                                                                                          static_cast<uint32_t>(command_ptr->attachment_initial_sample_locations.size() ),
+                                                                                          command_ptr->attachment_initial_sample_locations.data(),
+                                                                                          static_cast<uint32_t>(command_ptr->post_subpass_sample_locations.size() ),
+                                                                                          command_ptr->post_subpass_sample_locations.data(),
+                                                                                          static_cast<uint32_t>(command_ptr->attachment_image_view_ptrs.size() ),
+                                                                                          command_ptr->attachment_image_view_ptrs.data() );
+                    }
+                    else
+                    {
+                        command_result = primary_cmd_buffer_ptr->record_begin_render_pass2_KHR(static_cast<uint32_t>(command_ptr->clear_values.size() ),
+                                                                                               (command_ptr->clear_values.size() > 0) ? &command_ptr->clear_values.at(0) : nullptr,
+                                                                                               remap_table.get_framebuffer(command_ptr->fbo_ptr),
+                                                                                               command_ptr->device_mask,
+                                                                                               static_cast<uint32_t>(command_ptr->render_areas.size() ),
+                                                                                               &command_ptr->render_areas.at(0),
+                                                                                               command_ptr->render_pass_ptr,
+                                                                                               command_ptr->contents,
+                                                                                               static_cast<uint32_t>(command_ptr->attachment_initial_sample_locations.size() ),
+                                                                                               command_ptr->attachment_initial_sample_locations.data(),
+                                                                                               static_cast<uint32_t>(command_ptr->post_subpass_sample_locations.size() ),
+                                                                                               command_ptr->post_subpass_sample_locations.data(),
+                                                                                               static_cast<uint32_t>(command_ptr->attachment_image_view_ptrs.size() ),
+                                                                                               command_ptr->attachment_image_view_ptrs.data() );
+                    }
+
+                    break;
+                }
+
+                case COMMAND_TYPE_BLIT_IMAGE:
+                {
+                    const auto command_ptr = static_cast<const BlitImageCommand*>(current_command_ptr);
+
+                    command_result = record_blit_image(remap_table.get_image(command_ptr->src_image_ptr),
+                                                       command_ptr->src_image_layout,
+                                                       remap_table.get_image(command_ptr->dst_image_ptr),
+                                                       command_ptr->dst_image_layout,
+                                                       static_cast<uint32_t>(command_ptr->regions.size() ),
+                                                       command_ptr->regions.data(),
+                                                       command_ptr->filter);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_CLEAR_COLOR_IMAGE:
+                {
+                    const auto command_ptr = static_cast<const ClearColorImageCommand*>(current_command_ptr);
+
+                    command_result = record_clear_color_image(remap_table.get_image(command_ptr->image_ptr),
+                                                              command_ptr->image_layout,
+                                                             &command_ptr->color,
+                                                              static_cast<uint32_t>(command_ptr->ranges.size() ),
+                                                              command_ptr->ranges.data() );
+
+                    break;
+                }
+
+                case COMMAND_TYPE_CLEAR_DEPTH_STENCIL_IMAGE:
+                {
+                    const auto command_ptr = static_cast<const ClearDepthStencilImageCommand*>(current_command_ptr);
+
+                    command_result = record_clear_depth_stencil_image(remap_table.get_image(command_ptr->image_ptr),
+                                                                      command_ptr->image_layout,
+                                                                     &command_ptr->depth_stencil,
+                                                                      static_cast<uint32_t>(command_ptr->ranges.size() ),
+                                                                      command_ptr->ranges.data() );
+
+                    break;
+                }
+
+                case COMMAND_TYPE_COPY_BUFFER:
+                {
+                    const auto command_ptr = static_cast<const CopyBufferCommand*>(current_command_ptr);
+
+                    command_result = record_copy_buffer(remap_table.get_buffer(command_ptr->src_buffer_ptr),
+                                                        remap_table.get_buffer(command_ptr->dst_buffer_ptr),
+                                                        static_cast<uint32_t>(command_ptr->regions.size() ),
+                                                        command_ptr->regions.data() );
+
+                    break;
+                }
+
+                case COMMAND_TYPE_COPY_BUFFER_TO_IMAGE:
+                {
+                    const auto command_ptr = static_cast<const CopyBufferToImageCommand*>(current_command_ptr);
+
+                    command_result = record_copy_buffer_to_image(remap_table.get_buffer(command_ptr->src_buffer_ptr),
+                                                                 remap_table.get_image (command_ptr->dst_image_ptr),
+                                                                 command_ptr->dst_image_layout,
+                                                                 static_cast<uint32_t>(command_ptr->regions.size() ),
+                                                                 command_ptr->regions.data() );
+
+                    break;
+                }
+
+                case COMMAND_TYPE_COPY_IMAGE:
+                {
+                    const auto command_ptr = static_cast<const CopyImageCommand*>(current_command_ptr);
+
+                    command_result = record_copy_image(remap_table.get_image(command_ptr->src_image_ptr),
+                                                       command_ptr->src_image_layout,
+                                                       remap_table.get_image(command_ptr->dst_image_ptr),
+                                                       command_ptr->dst_image_layout,
+                                                       static_cast<uint32_t>(command_ptr->regions.size() ),
+                                                       command_ptr->regions.data() );
+
+                    break;
+                }
+
+                case COMMAND_TYPE_COPY_IMAGE_TO_BUFFER:
+                {
+                    const auto command_ptr = static_cast<const CopyImageToBufferCommand*>(current_command_ptr);
+
+                    command_result = record_copy_image_to_buffer(remap_table.get_image (command_ptr->src_image_ptr),
+                                                                 command_ptr->src_image_layout,
+                                                                 remap_table.get_buffer(command_ptr->dst_buffer_ptr),
+                                                                 static_cast<uint32_t>(command_ptr->regions.size() ),
+                                                                 command_ptr->regions.data() );
+
+                    break;
+                }
+
+                case COMMAND_TYPE_DEBUG_MARKER_BEGIN_EXT:
+                {
+                    const auto command_ptr = static_cast<const DebugMarkerBeginEXTCommand*>(current_command_ptr);
+
+                    command_result = record_debug_marker_begin_EXT(command_ptr->marker_name,
+                                                                   command_ptr->color);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_DEBUG_MARKER_END_EXT:
+                {
+                    command_result = record_debug_marker_end_EXT();
+
+                    break;
+                }
+
+                case COMMAND_TYPE_DEBUG_MARKER_INSERT_EXT:
+                {
+                    const auto command_ptr = static_cast<const DebugMarkerInsertEXTCommand*>(current_command_ptr);
+
+                    command_result = record_debug_marker_insert_EXT(command_ptr->marker_name,
+                                                                    command_ptr->color);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_DISPATCH_BASE_KHR:
+                {
+                    const auto command_ptr = static_cast<const DispatchBaseKHRCommand*>(current_command_ptr);
+
+                    command_result = record_dispatch_base_KHR(command_ptr->base_group_x,
+                                                              command_ptr->base_group_y,
+                                                              command_ptr->base_group_z,
+                                                              command_ptr->group_count_x,
+                                                              command_ptr->group_count_y,
+                                                              command_ptr->group_count_z);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_DRAW_INDEXED_INDIRECT_COUNT_AMD:
+                {
+                    const auto command_ptr = static_cast<const DrawIndexedIndirectCountAMDCommand*>(current_command_ptr);
+
+                    command_result = record_draw_indexed_indirect_count_AMD(remap_table.get_buffer(command_ptr->buffer_ptr),
+                                                                            command_ptr->offset,
+                                                                            remap_table.get_buffer(command_ptr->count_buffer_ptr),
+                                                                            command_ptr->count_offset,
+                                                                            command_ptr->max_draw_count,
+                                                                            command_ptr->stride);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_DRAW_INDEXED_INDIRECT_COUNT_KHR:
+                {
+                    const auto command_ptr = static_cast<const DrawIndexedIndirectCountKHRCommand*>(current_command_ptr);
+
+                    command_result = record_draw_indexed_indirect_count_KHR(remap_table.get_buffer(command_ptr->buffer_ptr),
+                                                                            command_ptr->offset,
+                                                                            remap_table.get_buffer(command_ptr->count_buffer_ptr),
+                                                                            command_ptr->count_offset,
+                                                                            command_ptr->max_draw_count,
+                                                                            command_ptr->stride);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_DRAW_INDIRECT_COUNT_AMD:
+                {
+                    const auto command_ptr = static_cast<const DrawIndirectCountAMDCommand*>(current_command_ptr);
+
+                    command_result = record_draw_indirect_count_AMD(remap_table.get_buffer(command_ptr->buffer_ptr),
+                                                                    command_ptr->offset,
+                                                                    remap_table.get_buffer(command_ptr->count_buffer_ptr),
+                                                                    command_ptr->count_offset,
+                                                                    command_ptr->max_draw_count,
+                                                                    command_ptr->stride);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_DRAW_INDIRECT_COUNT_KHR:
+                {
+                    const auto command_ptr = static_cast<const DrawIndirectCountKHRCommand*>(current_command_ptr);
+
+                    command_result = record_draw_indirect_count_KHR(remap_table.get_buffer(command_ptr->buffer_ptr),
+                                                                    command_ptr->offset,
+                                                                    remap_table.get_buffer(command_ptr->count_buffer_ptr),
+                                                                    command_ptr->count_offset,
+                                                                    command_ptr->max_draw_count,
+                                                                    command_ptr->stride);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_DRAW_MESH_TASKS_INDIRECT_COUNT_NV:
+                {
+                    const auto command_ptr = static_cast<const DrawMeshTasksIndirectCountNVCommand*>(current_command_ptr);
+
+                    command_result = record_draw_mesh_tasks_indirect_count_NV(remap_table.get_buffer(command_ptr->buffer_ptr),
+                                                                              command_ptr->offset,
+                                                                              remap_table.get_buffer(command_ptr->count_buffer_ptr),
+                                                                              command_ptr->count_offset,
+                                                                              command_ptr->max_draw_count,
+                                                                              command_ptr->stride);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_DRAW_MESH_TASKS_INDIRECT_NV:
+                {
+                    const auto command_ptr = static_cast<const DrawMeshTasksIndirectNVCommand*>(current_command_ptr);
+
+                    command_result = record_draw_mesh_tasks_indirect_NV(remap_table.get_buffer(command_ptr->buffer_ptr),
+                                                                        command_ptr->offset,
+                                                                        command_ptr->draw_count,
+                                                                        command_ptr->stride);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_DRAW_MESH_TASKS_NV:
+                {
+                    const auto command_ptr = static_cast<const DrawMeshTasksNVCommand*>(current_command_ptr);
+
+                    command_result = record_draw_mesh_tasks_NV(command_ptr->task_count,
+                                                               command_ptr->first_task);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_END_CONDITIONAL_RENDERING_EXT:
+                {
+                    command_result = record_end_conditional_rendering_EXT();
+
+                    break;
+                }
+
+                case COMMAND_TYPE_END_QUERY:
+                {
+                    const auto command_ptr = static_cast<const EndQueryCommand*>(current_command_ptr);
+
+                    command_result = record_end_query(command_ptr->query_pool_ptr,
+                                                      command_ptr->entry);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_END_RENDER_PASS:
+                case COMMAND_TYPE_END_RENDER_PASS_2_KHR:
+                {
+                    if (primary_cmd_buffer_ptr == nullptr)
+                    {
+                        anvil_assert(primary_cmd_buffer_ptr != nullptr);
+
+                        command_result = false;
+                        break;
+                    }
+
+                    command_result = (current_command_ptr->type == COMMAND_TYPE_END_RENDER_PASS) ? primary_cmd_buffer_ptr->record_end_render_pass     ()
+                                                                                                 : primary_cmd_buffer_ptr->record_end_render_pass2_KHR();
+
+                    break;
+                }
+
+                case COMMAND_TYPE_END_RENDERING_KHR:
+                {
+                    command_result = record_end_rendering_KHR();
+
+                    break;
+                }
+
+                case COMMAND_TYPE_EXECUTE_COMMANDS:
+                {
+                    const auto command_ptr = static_cast<const ExecuteCommandsCommand*>(current_command_ptr);
+                    auto       cmd_buffers = std::vector<Anvil::SecondaryCommandBuffer*>(command_ptr->command_buffer_ptrs.begin(),
+                                                                                         command_ptr->command_buffer_ptrs.end  () );
+
+                    if (primary_cmd_buffer_ptr == nullptr)
+                    {
+                        anvil_assert(primary_cmd_buffer_ptr != nullptr);
+
+                        command_result = false;
+                        break;
+                    }
+
+                    command_result = primary_cmd_buffer_ptr->record_execute_commands(static_cast<uint32_t>(cmd_buffers.size() ),
+                                                                                     (cmd_buffers.size() > 0) ? &cmd_buffers.at(0) : nullptr);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_FILL_BUFFER:
+                {
+                    const auto command_ptr = static_cast<const FillBufferCommand*>(current_command_ptr);
+
+                    command_result = record_fill_buffer(remap_table.get_buffer(command_ptr->dst_buffer_ptr),
+                                                        command_ptr->dst_offset,
+                                                        command_ptr->size,
+                                                        command_ptr->data);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_NEXT_SUBPASS:
+                case COMMAND_TYPE_NEXT_SUBPASS_2_KHR:
+                {
+                    const auto command_ptr = static_cast<const NextSubpassCommand*>(current_command_ptr);
+
+                    if (primary_cmd_buffer_ptr == nullptr)
+                    {
+                        anvil_assert(primary_cmd_buffer_ptr != nullptr);
+
+                        command_result = false;
+                        break;
+                    }
+
+                    command_result = (current_command_ptr->type == COMMAND_TYPE_NEXT_SUBPASS) ? primary_cmd_buffer_ptr->record_next_subpass     (command_ptr->contents)
+                                                                                              : primary_cmd_buffer_ptr->record_next_subpass2_KHR(command_ptr->contents);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_PIPELINE_BARRIER:
+                {
+                    const auto command_ptr = static_cast<const PipelineBarrierCommand*>(current_command_ptr);
+
+                    buffer_barriers.clear();
+                    image_barriers.clear ();
+
+                    buffer_barriers.reserve(command_ptr->buffer_barriers.size() );
+                    image_barriers.reserve (command_ptr->image_barriers.size () );
+
+                    for (const auto& current_barrier : command_ptr->buffer_barriers)
+                    {
+                        buffer_barriers.push_back(
+                            Anvil::BufferBarrier(current_barrier.src_access_mask,
+                                                 current_barrier.dst_access_mask,
+                                                 current_barrier.src_queue_family_index,
+                                                 current_barrier.dst_queue_family_index,
+                                                 remap_table.get_buffer(current_barrier.buffer_ptr),
+                                                 current_barrier.offset,
+                                                 current_barrier.size)
+                        );
+                    }
+
+                    for (const auto& current_barrier : command_ptr->image_barriers)
+                    {
+                        image_barriers.push_back(
+                            Anvil::ImageBarrier(current_barrier.src_access_mask,
+                                                current_barrier.dst_access_mask,
+                                                current_barrier.old_layout,
+                                                current_barrier.new_layout,
+                                                current_barrier.src_queue_family_index,
+                                                current_barrier.dst_queue_family_index,
+                                                remap_table.get_image(current_barrier.image_ptr),
+                                                current_barrier.subresource_range)
+                        );
+                    }
+
+                    command_result = record_pipeline_barrier(command_ptr->src_stage_mask,
+                                                             command_ptr->dst_stage_mask,
+                                                             command_ptr->flags,
+                                                             static_cast<uint32_t>(command_ptr->memory_barriers.size() ),
+                                                             command_ptr->memory_barriers.data(),
+                                                             static_cast<uint32_t>(buffer_barriers.size() ),
+                                                             buffer_barriers.data(),
+                                                             static_cast<uint32_t>(image_barriers.size() ),
+                                                             image_barriers.data() );
+
+                    needs_barrier_flush = true;
+
+                    break;
+                }
+
+                case COMMAND_TYPE_PIPELINE_BARRIER_RAW:
+                {
+                    const auto command_ptr = static_cast<const PipelineBarrierRawCommand*>(current_command_ptr);
+
+                    command_result = record_pipeline_barrier_raw(command_ptr->src_stage_mask,
+                                                                 command_ptr->dst_stage_mask,
+                                                                 command_ptr->flags,
+                                                                 static_cast<uint32_t>(command_ptr->memory_barriers.size() ),
+                                                                 command_ptr->memory_barriers.data(),
+                                                                 static_cast<uint32_t>(command_ptr->buffer_barriers.size() ),
+                                                                 command_ptr->buffer_barriers.data(),
+                                                                 static_cast<uint32_t>(command_ptr->image_barriers.size() ),
+                                                                 command_ptr->image_barriers.data() );
+
+                    needs_barrier_flush = true;
+
+                    break;
+                }
+
+                case COMMAND_TYPE_RESET_EVENT:
+                {
+                    const auto command_ptr = static_cast<const ResetEventCommand*>(current_command_ptr);
+
+                    command_result = record_reset_event(command_ptr->event_ptr,
+                                                        command_ptr->stage_mask);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_RESET_QUERY_POOL:
+                {
+                    const auto command_ptr = static_cast<const ResetQueryPoolCommand*>(current_command_ptr);
+
+                    command_result = record_reset_query_pool(command_ptr->query_pool_ptr,
+                                                             command_ptr->start_query,
+                                                             command_ptr->query_count);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_RESOLVE_IMAGE:
+                {
+                    const auto command_ptr = static_cast<const ResolveImageCommand*>(current_command_ptr);
+
+                    command_result = record_resolve_image(remap_table.get_image(command_ptr->src_image_ptr),
+                                                          command_ptr->src_image_layout,
+                                                          remap_table.get_image(command_ptr->dst_image_ptr),
+                                                          command_ptr->dst_image_layout,
+                                                          static_cast<uint32_t>(command_ptr->regions.size() ),
+                                                          command_ptr->regions.data() );
+
+                    break;
+                }
+
+                case COMMAND_TYPE_BIND_SHADING_RATE_IMAGE_NV:
+                {
+                    const auto command_ptr = static_cast<const BindShadingRateImageNVCommand*>(current_command_ptr);
+
+                    command_result = record_bind_shading_rate_image_NV(command_ptr->image_view_ptr,
+                                                                       command_ptr->image_layout);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_SET_DEVICE_MASK_KHR:
+                {
+                    const auto command_ptr = static_cast<const SetDeviceMaskKHRCommand*>(current_command_ptr);
+
+                    command_result = record_set_device_mask_KHR(command_ptr->device_mask);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_SET_EVENT:
+                {
+                    const auto command_ptr = static_cast<const SetEventCommand*>(current_command_ptr);
+
+                    command_result = record_set_event(command_ptr->event_ptr,
+                                                      command_ptr->stage_mask);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_UPDATE_BUFFER:
+                {
+                    const auto command_ptr = static_cast<const UpdateBufferCommand*>(current_command_ptr);
+
+                    command_result = record_update_buffer(remap_table.get_buffer(command_ptr->dst_buffer_ptr),
+                                                          command_ptr->dst_offset,
+                                                          command_ptr->data_size,
+                                                          command_ptr->data_ptr);
+
+                    break;
+                }
+
+                case COMMAND_TYPE_WRITE_TIMESTAMP:
+                {
+                    const auto command_ptr = static_cast<const WriteTimestampCommand*>(current_command_ptr);
+
+                    command_result = record_write_timestamp(command_ptr->pipeline_stage,
+                                                            command_ptr->query_pool_ptr,
+                                                            command_ptr->entry);
+
+                    break;
+                }
+
+                default:
+                {
+                    /* Command type not supported by the replayer */
+                    anvil_assert_fail();
+
+                    command_result = false;
+                }
+            }
+
+            if (!command_result)
+            {
+                goto end;
+            }
+        }
+
+        result = true;
+    end:
+        if (is_locked)
+        {
+            unlock();
+            m_parent_command_pool_ptr->unlock();
+        }
+
+        /* Directly emitted commands bypass the state filter, so none of the tracked state can be trusted anymore */
+        m_bound_state.clear();
+
+        return result;
+    }
+#endif
+
+/* Please see header for specification */
+bool Anvil::CommandBufferBase::record_reset_event(Anvil::Event*             in_event_ptr,
+                                                  Anvil::PipelineStageFlags in_stage_mask)
+{
+    bool result = false;
+
+    if (m_is_renderpass_active)
+    {
+        anvil_assert(!m_is_renderpass_active);
+
+        goto end;
+    }
+
+    if (!m_recording_in_progress)
+    {
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
+    }
+
+    #ifdef STORE_COMMAND_BUFFER_COMMANDS
+    {
+        if (!m_command_stashing_disabled)
+        {
+            m_commands.push_back(m_command_arena.create<ResetEventCommand>(in_event_ptr,
+                                                                           in_stage_mask) );
+        }
+    }
+    #endif
+
+    flush_pending_barriers();
+
+    m_parent_command_pool_ptr->lock();
+    lock();
+    {
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdResetEvent(m_command_buffer,
+                                                           in_event_ptr->get_event(),
+                                                           in_stage_mask.get_vk() );
+    }
+    unlock();
+    m_parent_command_pool_ptr->unlock();
+
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandBufferBase::record_reset_query_pool(Anvil::QueryPool* in_query_pool_ptr,
                                                        Anvil::QueryIndex in_start_query,
                                                        uint32_t          in_query_count)
 {
@@ -3401,20 +6750,24 @@ bool Anvil::CommandBufferBase::record_reset_query_pool(Anvil::QueryPool* in_quer
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(ResetQueryPoolCommand(in_query_pool_ptr,
-                                                       in_start_query,
-                                                       in_query_count) );
+            m_commands.push_back(m_command_arena.create<ResetQueryPoolCommand>(in_query_pool_ptr,
+                                                                               in_start_query,
+                                                                               in_query_count) );
         }
     }
     #endif
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdResetQueryPool(m_command_buffer,
-                                           in_query_pool_ptr->get_query_pool(),
-                                           in_start_query,
-                                           in_query_count);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdResetQueryPool(m_command_buffer,
+                                                               in_query_pool_ptr->get_query_pool(),
+                                                               in_start_query,
+                                                               in_query_count);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -3452,26 +6805,47 @@ bool Anvil::CommandBufferBase::record_resolve_image(Anvil::Image*              i
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(ResolveImageCommand(in_src_image_ptr,
-                                                     in_src_image_layout,
-                                                     in_dst_image_ptr,
-                                                     in_dst_image_layout,
-                                                     in_region_count,
-                                                     in_region_ptrs) );
+            m_commands.push_back(m_command_arena.create<ResolveImageCommand>(in_src_image_ptr,
+                                                                             in_src_image_layout,
+                                                                             in_dst_image_ptr,
+                                                                             in_dst_image_layout,
+                                                                             in_region_count,
+                                                                             in_region_ptrs,
+                                                                             &m_command_arena) );
         }
     }
     #endif
 
+    for (uint32_t n_region = 0;
+                  n_region < in_region_count;
+                ++n_region)
+    {
+        track_image_access(in_src_image_ptr,
+                           in_region_ptrs[n_region].src_subresource,
+                           in_src_image_layout,
+                           Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                           Anvil::AccessFlagBits::TRANSFER_READ_BIT);
+        track_image_access(in_dst_image_ptr,
+                           in_region_ptrs[n_region].dst_subresource,
+                           in_dst_image_layout,
+                           Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                           Anvil::AccessFlagBits::TRANSFER_WRITE_BIT);
+    }
+
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdResolveImage(m_command_buffer,
-                                         in_src_image_ptr->get_image(),
-                                         static_cast<VkImageLayout>(in_src_image_layout),
-                                         in_dst_image_ptr->get_image(),
-                                         static_cast<VkImageLayout>(in_dst_image_layout),
-                                         in_region_count,
-                                         reinterpret_cast<const VkImageResolve*>(in_region_ptrs) );
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdResolveImage(m_command_buffer,
+                                                             in_src_image_ptr->get_image(),
+                                                             static_cast<VkImageLayout>(in_src_image_layout),
+                                                             in_dst_image_ptr->get_image(),
+                                                             static_cast<VkImageLayout>(in_dst_image_layout),
+                                                             in_region_count,
+                                                             reinterpret_cast<const VkImageResolve*>(in_region_ptrs) );
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -3498,16 +6872,42 @@ bool Anvil::CommandBufferBase::record_set_blend_constants(const float in_blend_c
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(SetBlendConstantsCommand(in_blend_constants));
+            m_commands.push_back(m_command_arena.create<SetBlendConstantsCommand>(in_blend_constants) );
         }
     }
     #endif
 
+    if (m_state_filtering_enabled)
+    {
+        if ((m_bound_state.valid_state_bits & BoundState::BLEND_CONSTANTS_BIT) != 0                  &&
+             m_bound_state.blend_constants[0]                               == in_blend_constants[0] &&
+             m_bound_state.blend_constants[1]                               == in_blend_constants[1] &&
+             m_bound_state.blend_constants[2]                               == in_blend_constants[2] &&
+             m_bound_state.blend_constants[3]                               == in_blend_constants[3])
+        {
+            m_n_filtered_state_calls++;
+
+            result = true;
+            goto end;
+        }
+
+        for (uint32_t n_component = 0;
+                      n_component < 4;
+                    ++n_component)
+        {
+            m_bound_state.blend_constants[n_component] = in_blend_constants[n_component];
+        }
+
+        m_bound_state.valid_state_bits |= BoundState::BLEND_CONSTANTS_BIT;
+    }
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdSetBlendConstants(m_command_buffer,
-                                              in_blend_constants);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdSetBlendConstants(m_command_buffer,
+                                                                  in_blend_constants);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -3536,20 +6936,41 @@ bool Anvil::CommandBufferBase::record_set_depth_bias(float in_depth_bias_constan
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(SetDepthBiasCommand(in_depth_bias_constant_factor,
-                                                     in_depth_bias_clamp,
-                                                     in_slope_scaled_depth_bias) );
+            m_commands.push_back(m_command_arena.create<SetDepthBiasCommand>(in_depth_bias_constant_factor,
+                                                                             in_depth_bias_clamp,
+                                                                             in_slope_scaled_depth_bias) );
+        }
+    }
+    #endif
+
+    if (m_state_filtering_enabled)
+    {
+        if ((m_bound_state.valid_state_bits & BoundState::DEPTH_BIAS_BIT) != 0                          &&
+             m_bound_state.depth_bias[0]                               == in_depth_bias_constant_factor &&
+             m_bound_state.depth_bias[1]                               == in_depth_bias_clamp           &&
+             m_bound_state.depth_bias[2]                               == in_slope_scaled_depth_bias)
+        {
+            m_n_filtered_state_calls++;
+
+            result = true;
+            goto end;
         }
+
+        m_bound_state.depth_bias[0]     = in_depth_bias_constant_factor;
+        m_bound_state.depth_bias[1]     = in_depth_bias_clamp;
+        m_bound_state.depth_bias[2]     = in_slope_scaled_depth_bias;
+        m_bound_state.valid_state_bits |= BoundState::DEPTH_BIAS_BIT;
     }
-    #endif
 
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdSetDepthBias(m_command_buffer,
-                                         in_depth_bias_constant_factor,
-                                         in_depth_bias_clamp,
-                                         in_slope_scaled_depth_bias);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdSetDepthBias(m_command_buffer,
+                                                             in_depth_bias_constant_factor,
+                                                             in_depth_bias_clamp,
+                                                             in_slope_scaled_depth_bias);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -3577,18 +6998,37 @@ bool Anvil::CommandBufferBase::record_set_depth_bounds(float in_min_depth_bounds
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(SetDepthBoundsCommand(in_min_depth_bounds,
-                                                       in_max_depth_bounds) );
+            m_commands.push_back(m_command_arena.create<SetDepthBoundsCommand>(in_min_depth_bounds,
+                                                                               in_max_depth_bounds) );
         }
     }
     #endif
 
+    if (m_state_filtering_enabled)
+    {
+        if ((m_bound_state.valid_state_bits & BoundState::DEPTH_BOUNDS_BIT) != 0                &&
+             m_bound_state.depth_bounds[0]                               == in_min_depth_bounds &&
+             m_bound_state.depth_bounds[1]                               == in_max_depth_bounds)
+        {
+            m_n_filtered_state_calls++;
+
+            result = true;
+            goto end;
+        }
+
+        m_bound_state.depth_bounds[0]   = in_min_depth_bounds;
+        m_bound_state.depth_bounds[1]   = in_max_depth_bounds;
+        m_bound_state.valid_state_bits |= BoundState::DEPTH_BOUNDS_BIT;
+    }
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdSetDepthBounds(m_command_buffer,
-                                           in_min_depth_bounds,
-                                           in_max_depth_bounds);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdSetDepthBounds(m_command_buffer,
+                                                               in_min_depth_bounds,
+                                                               in_max_depth_bounds);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -3619,7 +7059,7 @@ bool Anvil::CommandBufferBase::record_set_device_mask_KHR(uint32_t in_device_mas
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(SetDeviceMaskKHRCommand(in_device_mask) );
+            m_commands.push_back(m_command_arena.create<SetDeviceMaskKHRCommand>(in_device_mask) );
         }
     }
     #endif
@@ -3637,9 +7077,13 @@ bool Anvil::CommandBufferBase::record_set_device_mask_KHR(uint32_t in_device_mas
         }
     }
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
+        m_n_recorded_commands++;
+
         entrypoints.vkCmdSetDeviceMaskKHR(m_command_buffer,
                                           in_device_mask);
     }
@@ -3686,18 +7130,22 @@ bool Anvil::CommandBufferBase::record_set_event(Anvil::Event*             in_eve
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(SetEventCommand(in_event_ptr,
-                                                 in_stage_mask) );
+            m_commands.push_back(m_command_arena.create<SetEventCommand>(in_event_ptr,
+                                                                         in_stage_mask) );
         }
     }
     #endif
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdSetEvent(m_command_buffer,
-                                     in_event_ptr->get_event(),
-                                     in_stage_mask.get_vk() );
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdSetEvent(m_command_buffer,
+                                                         in_event_ptr->get_event(),
+                                                         in_stage_mask.get_vk() );
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -3724,16 +7172,33 @@ bool Anvil::CommandBufferBase::record_set_line_width(float in_line_width)
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(SetLineWidthCommand(in_line_width) );
+            m_commands.push_back(m_command_arena.create<SetLineWidthCommand>(in_line_width) );
         }
     }
     #endif
 
+    if (m_state_filtering_enabled)
+    {
+        if ((m_bound_state.valid_state_bits & BoundState::LINE_WIDTH_BIT) != 0 &&
+             m_bound_state.line_width                                  == in_line_width)
+        {
+            m_n_filtered_state_calls++;
+
+            result = true;
+            goto end;
+        }
+
+        m_bound_state.line_width        = in_line_width;
+        m_bound_state.valid_state_bits |= BoundState::LINE_WIDTH_BIT;
+    }
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdSetLineWidth(m_command_buffer,
-                                         in_line_width);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdSetLineWidth(m_command_buffer,
+                                                             in_line_width);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -3762,7 +7227,7 @@ bool Anvil::CommandBufferBase::record_set_sample_locations_EXT(const Anvil::Samp
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(SetSampleLocationsEXTCommand(in_sample_locations_info) );
+            m_commands.push_back(m_command_arena.create<SetSampleLocationsEXTCommand>(in_sample_locations_info) );
         }
     }
     #endif
@@ -3772,6 +7237,8 @@ bool Anvil::CommandBufferBase::record_set_sample_locations_EXT(const Anvil::Samp
     m_parent_command_pool_ptr->lock();
     lock();
     {
+        m_n_recorded_commands++;
+
         sl_entrypoints.vkCmdSetSampleLocationsEXT(m_command_buffer,
                                                  &sample_locations_info_vk);
     }
@@ -3802,20 +7269,71 @@ bool Anvil::CommandBufferBase::record_set_scissor(uint32_t        in_first_sciss
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(SetScissorCommand(in_first_scissor,
-                                                   in_scissor_count,
-                                                   in_scissor_ptrs) );
+            m_commands.push_back(m_command_arena.create<SetScissorCommand>(in_first_scissor,
+                                                                           in_scissor_count,
+                                                                           in_scissor_ptrs,
+                                                                           &m_command_arena) );
         }
     }
     #endif
 
+    if (m_state_filtering_enabled)
+    {
+        auto& bound_scissors = m_bound_state.scissors;
+        auto& valid_scissors = m_bound_state.scissors_valid;
+
+        if (valid_scissors.size() >= in_first_scissor + in_scissor_count)
+        {
+            bool is_redundant = true;
+
+            for (uint32_t n_scissor = 0;
+                          n_scissor < in_scissor_count && is_redundant;
+                        ++n_scissor)
+            {
+                const VkRect2D& bound_scissor = bound_scissors.at(in_first_scissor + n_scissor);
+                const VkRect2D& new_scissor   = in_scissor_ptrs  [n_scissor];
+
+                is_redundant = (valid_scissors.at(in_first_scissor + n_scissor)          &&
+                                bound_scissor.extent.height == new_scissor.extent.height &&
+                                bound_scissor.extent.width  == new_scissor.extent.width  &&
+                                bound_scissor.offset.x      == new_scissor.offset.x      &&
+                                bound_scissor.offset.y      == new_scissor.offset.y);
+            }
+
+            if (is_redundant)
+            {
+                m_n_filtered_state_calls++;
+
+                result = true;
+                goto end;
+            }
+        }
+
+        if (valid_scissors.size() < in_first_scissor + in_scissor_count)
+        {
+            bound_scissors.resize(in_first_scissor + in_scissor_count);
+            valid_scissors.resize(in_first_scissor + in_scissor_count,
+                                  false);
+        }
+
+        for (uint32_t n_scissor = 0;
+                      n_scissor < in_scissor_count;
+                    ++n_scissor)
+        {
+            bound_scissors.at(in_first_scissor + n_scissor) = in_scissor_ptrs[n_scissor];
+            valid_scissors.at(in_first_scissor + n_scissor) = true;
+        }
+    }
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdSetScissor(m_command_buffer,
-                                       in_first_scissor,
-                                       in_scissor_count,
-                                       in_scissor_ptrs);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdSetScissor(m_command_buffer,
+                                                           in_first_scissor,
+                                                           in_scissor_count,
+                                                           in_scissor_ptrs);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -3843,18 +7361,33 @@ bool Anvil::CommandBufferBase::record_set_stencil_compare_mask(Anvil::StencilFac
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(SetStencilCompareMaskCommand(in_face_mask,
-                                                              in_stencil_compare_mask) );
+            m_commands.push_back(m_command_arena.create<SetStencilCompareMaskCommand>(in_face_mask,
+                                                                                      in_stencil_compare_mask) );
         }
     }
     #endif
 
+    if (m_state_filtering_enabled                                                  &&
+        filter_stencil_state(in_face_mask,
+                             in_stencil_compare_mask,
+                             BoundState::STENCIL_BACK_COMPARE_MASK_BIT,
+                             BoundState::STENCIL_FRONT_COMPARE_MASK_BIT,
+                             m_bound_state.stencil_compare_masks) )
+    {
+        m_n_filtered_state_calls++;
+
+        result = true;
+        goto end;
+    }
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdSetStencilCompareMask(m_command_buffer,
-                                                  in_face_mask.get_vk(),
-                                                  in_stencil_compare_mask);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdSetStencilCompareMask(m_command_buffer,
+                                                                      in_face_mask.get_vk(),
+                                                                      in_stencil_compare_mask);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -3882,18 +7415,33 @@ bool Anvil::CommandBufferBase::record_set_stencil_reference(Anvil::StencilFaceFl
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(SetStencilReferenceCommand(in_face_mask,
-                                                            in_stencil_reference) );
+            m_commands.push_back(m_command_arena.create<SetStencilReferenceCommand>(in_face_mask,
+                                                                                    in_stencil_reference) );
         }
     }
     #endif
 
+    if (m_state_filtering_enabled                                                  &&
+        filter_stencil_state(in_face_mask,
+                             in_stencil_reference,
+                             BoundState::STENCIL_BACK_REFERENCE_BIT,
+                             BoundState::STENCIL_FRONT_REFERENCE_BIT,
+                             m_bound_state.stencil_references) )
+    {
+        m_n_filtered_state_calls++;
+
+        result = true;
+        goto end;
+    }
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdSetStencilReference(m_command_buffer,
-                                                in_face_mask.get_vk(),
-                                                in_stencil_reference);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdSetStencilReference(m_command_buffer,
+                                                                    in_face_mask.get_vk(),
+                                                                    in_stencil_reference);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -3921,18 +7469,33 @@ bool Anvil::CommandBufferBase::record_set_stencil_write_mask(Anvil::StencilFaceF
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(SetStencilWriteMaskCommand(in_face_mask,
-                                                            in_stencil_write_mask) );
+            m_commands.push_back(m_command_arena.create<SetStencilWriteMaskCommand>(in_face_mask,
+                                                                                    in_stencil_write_mask) );
         }
     }
     #endif
 
+    if (m_state_filtering_enabled                                                  &&
+        filter_stencil_state(in_face_mask,
+                             in_stencil_write_mask,
+                             BoundState::STENCIL_BACK_WRITE_MASK_BIT,
+                             BoundState::STENCIL_FRONT_WRITE_MASK_BIT,
+                             m_bound_state.stencil_write_masks) )
+    {
+        m_n_filtered_state_calls++;
+
+        result = true;
+        goto end;
+    }
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdSetStencilWriteMask(m_command_buffer,
-                                                in_face_mask.get_vk(),
-                                                in_stencil_write_mask);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdSetStencilWriteMask(m_command_buffer,
+                                                                    in_face_mask.get_vk(),
+                                                                    in_stencil_write_mask);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -3961,20 +7524,124 @@ bool Anvil::CommandBufferBase::record_set_viewport(uint32_t          in_first_vi
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(SetViewportCommand(in_first_viewport,
-                                                    in_viewport_count,
-                                                    in_viewport_ptrs) );
+            m_commands.push_back(m_command_arena.create<SetViewportCommand>(in_first_viewport,
+                                                                            in_viewport_count,
+                                                                            in_viewport_ptrs,
+                                                                            &m_command_arena) );
         }
     }
     #endif
 
+    if (m_state_filtering_enabled)
+    {
+        auto& bound_viewports = m_bound_state.viewports;
+        auto& valid_viewports = m_bound_state.viewports_valid;
+
+        if (valid_viewports.size() >= in_first_viewport + in_viewport_count)
+        {
+            bool is_redundant = true;
+
+            for (uint32_t n_viewport = 0;
+                          n_viewport < in_viewport_count && is_redundant;
+                        ++n_viewport)
+            {
+                const VkViewport& bound_viewport = bound_viewports.at(in_first_viewport + n_viewport);
+                const VkViewport& new_viewport   = in_viewport_ptrs  [n_viewport];
+
+                is_redundant = (valid_viewports.at(in_first_viewport + n_viewport) &&
+                                bound_viewport.height   == new_viewport.height     &&
+                                bound_viewport.maxDepth == new_viewport.maxDepth   &&
+                                bound_viewport.minDepth == new_viewport.minDepth   &&
+                                bound_viewport.width    == new_viewport.width      &&
+                                bound_viewport.x        == new_viewport.x          &&
+                                bound_viewport.y        == new_viewport.y);
+            }
+
+            if (is_redundant)
+            {
+                m_n_filtered_state_calls++;
+
+                result = true;
+                goto end;
+            }
+        }
+
+        if (valid_viewports.size() < in_first_viewport + in_viewport_count)
+        {
+            bound_viewports.resize(in_first_viewport + in_viewport_count);
+            valid_viewports.resize(in_first_viewport + in_viewport_count,
+                                   false);
+        }
+
+        for (uint32_t n_viewport = 0;
+                      n_viewport < in_viewport_count;
+                    ++n_viewport)
+        {
+            bound_viewports.at(in_first_viewport + n_viewport) = in_viewport_ptrs[n_viewport];
+            valid_viewports.at(in_first_viewport + n_viewport) = true;
+        }
+    }
+
+    m_parent_command_pool_ptr->lock();
+    lock();
+    {
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdSetViewport(m_command_buffer,
+                                                            in_first_viewport,
+                                                            in_viewport_count,
+                                                            in_viewport_ptrs);
+    }
+    unlock();
+    m_parent_command_pool_ptr->unlock();
+
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandBufferBase::record_set_viewport_shading_rate_palette_NV(uint32_t                      in_first_viewport,
+                                                                           uint32_t                      in_viewport_count,
+                                                                           const VkShadingRatePaletteNV* in_palettes_ptr)
+{
+    /* Note: Command supported inside and outside the renderpass. */
+    Anvil::ExtensionNVShadingRateImageEntrypoints entrypoints;
+    bool                                          result     (false);
+
+    if (!m_recording_in_progress)
+    {
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
+    }
+
+    anvil_assert(m_device_ptr->get_extension_info()->nv_shading_rate_image() );
+    anvil_assert(in_viewport_count > 0);
+
+    #ifdef STORE_COMMAND_BUFFER_COMMANDS
+    {
+        if (!m_command_stashing_disabled)
+        {
+            m_commands.push_back(m_command_arena.create<SetViewportShadingRatePaletteNVCommand>(in_first_viewport,
+                                                                                                in_viewport_count,
+                                                                                                in_palettes_ptr,
+                                                                                                &m_command_arena) );
+        }
+    }
+    #endif
+
+    entrypoints = m_device_ptr->get_extension_nv_shading_rate_image_entrypoints();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdSetViewport(m_command_buffer,
-                                        in_first_viewport,
-                                        in_viewport_count,
-                                        in_viewport_ptrs);
+        m_n_recorded_commands++;
+
+        entrypoints.vkCmdSetViewportShadingRatePaletteNV(m_command_buffer,
+                                                         in_first_viewport,
+                                                         in_viewport_count,
+                                                         in_palettes_ptr);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -3984,6 +7651,191 @@ end:
     return result;
 }
 
+/* Please see header for specification */
+bool Anvil::CommandBufferBase::record_transition(Anvil::Image*                       in_image_ptr,
+                                                 Anvil::ImageLayout                  in_new_layout,
+                                                 Anvil::PipelineStageFlags           in_dst_stage_mask,
+                                                 Anvil::AccessFlags                  in_dst_access_mask,
+                                                 const Anvil::ImageSubresourceRange* in_opt_subresource_range_ptr)
+{
+    std::vector<Anvil::ImageBarrier> barriers;
+    const bool                       is_dst_write      = (Anvil::Utils::get_write_access_mask(in_dst_access_mask) != Anvil::AccessFlagBits::NONE);
+    uint32_t                         layer_count;
+    uint32_t                         level_count;
+    bool                             result            = false;
+    Anvil::PipelineStageFlags        src_stage_mask;
+    Anvil::ImageSubresourceRange     subresource_range;
+
+    if (!m_recording_in_progress)
+    {
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
+    }
+
+    if (!in_image_ptr->is_state_tracking_enabled() )
+    {
+        anvil_assert(in_image_ptr->is_state_tracking_enabled() );
+
+        goto end;
+    }
+
+    subresource_range = (in_opt_subresource_range_ptr != nullptr) ? *in_opt_subresource_range_ptr
+                                                                  : in_image_ptr->get_subresource_range();
+    layer_count       = (subresource_range.layer_count == VK_REMAINING_ARRAY_LAYERS) ? (in_image_ptr->get_create_info_ptr()->get_n_layers() - subresource_range.base_array_layer)
+                                                                                     : subresource_range.layer_count;
+    level_count       = (subresource_range.level_count == VK_REMAINING_MIP_LEVELS)   ? (in_image_ptr->get_n_mipmaps() - subresource_range.base_mip_level)
+                                                                                     : subresource_range.level_count;
+
+    for (uint32_t n_mip = subresource_range.base_mip_level;
+                  n_mip < subresource_range.base_mip_level + level_count;
+                ++n_mip)
+    {
+        uint32_t                   n_run_first_layer = UINT32_MAX;
+        Anvil::ResourceAccessState run_state;
+
+        /* Consecutive layers which need a barrier and share the same state form a run, covered by a single barrier.
+         * The loop goes one layer past the range, so that the last run is closed, too. */
+        for (uint32_t n_layer = subresource_range.base_array_layer;
+                      n_layer <= subresource_range.base_array_layer + layer_count;
+                    ++n_layer)
+        {
+            Anvil::ResourceAccessState current_state;
+            bool                       needs_barrier = false;
+
+            if (n_layer < subresource_range.base_array_layer + layer_count &&
+                in_image_ptr->get_tracked_state(n_layer,
+                                                n_mip,
+                                               &current_state) )
+            {
+                needs_barrier = (current_state.layout                                          != in_new_layout)                   ||
+                                (Anvil::Utils::get_write_access_mask(current_state.access_mask) != Anvil::AccessFlagBits::NONE) ||
+                                (is_dst_write && current_state.stage_mask                       != Anvil::PipelineStageFlagBits::NONE);
+            }
+
+            if ((n_run_first_layer != UINT32_MAX)                       &&
+                (!needs_barrier || !(current_state == run_state) ))
+            {
+                Anvil::ImageSubresourceRange run_range;
+
+                run_range.aspect_mask      = subresource_range.aspect_mask;
+                run_range.base_array_layer = n_run_first_layer;
+                run_range.base_mip_level   = n_mip;
+                run_range.layer_count      = n_layer - n_run_first_layer;
+                run_range.level_count      = 1;
+
+                barriers.push_back(
+                    Anvil::ImageBarrier(Anvil::Utils::get_write_access_mask(run_state.access_mask),
+                                        in_dst_access_mask,
+                                        run_state.layout,
+                                        in_new_layout,
+                                        VK_QUEUE_FAMILY_IGNORED,
+                                        VK_QUEUE_FAMILY_IGNORED,
+                                        in_image_ptr,
+                                        run_range)
+                );
+
+                src_stage_mask    |= run_state.stage_mask;
+                n_run_first_layer  = UINT32_MAX;
+            }
+
+            if (needs_barrier                     &&
+                n_run_first_layer == UINT32_MAX)
+            {
+                n_run_first_layer = n_layer;
+                run_state         = current_state;
+            }
+        }
+    }
+
+    if (barriers.size() > 0)
+    {
+        if (!record_pipeline_barrier((src_stage_mask    != Anvil::PipelineStageFlagBits::NONE) ? src_stage_mask    : Anvil::PipelineStageFlagBits::TOP_OF_PIPE_BIT,
+                                     (in_dst_stage_mask != Anvil::PipelineStageFlagBits::NONE) ? in_dst_stage_mask : Anvil::PipelineStageFlagBits::BOTTOM_OF_PIPE_BIT,
+                                     Anvil::DependencyFlagBits::NONE,
+                                     0,       /* in_memory_barrier_count        */
+                                     nullptr, /* in_memory_barriers_ptr         */
+                                     0,       /* in_buffer_memory_barrier_count */
+                                     nullptr, /* in_buffer_memory_barriers_ptr  */
+                                     static_cast<uint32_t>(barriers.size() ),
+                                    &barriers.at(0) ))
+        {
+            goto end;
+        }
+    }
+
+    /* Subresources which did not need a barrier are going to be accessed in the new scope, too. */
+    track_image_access(in_image_ptr,
+                       subresource_range,
+                       in_new_layout,
+                       in_dst_stage_mask,
+                       in_dst_access_mask);
+
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandBufferBase::record_transition(Anvil::Buffer*            in_buffer_ptr,
+                                                 Anvil::PipelineStageFlags in_dst_stage_mask,
+                                                 Anvil::AccessFlags        in_dst_access_mask)
+{
+    const bool is_dst_write = (Anvil::Utils::get_write_access_mask(in_dst_access_mask) != Anvil::AccessFlagBits::NONE);
+    bool       result       = false;
+
+    if (!m_recording_in_progress)
+    {
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
+    }
+
+    if (!in_buffer_ptr->is_state_tracking_enabled() )
+    {
+        anvil_assert(in_buffer_ptr->is_state_tracking_enabled() );
+
+        goto end;
+    }
+
+    {
+        const auto& current_state = in_buffer_ptr->get_tracked_state();
+
+        if ((Anvil::Utils::get_write_access_mask(current_state.access_mask) != Anvil::AccessFlagBits::NONE) ||
+            (is_dst_write && current_state.stage_mask                       != Anvil::PipelineStageFlagBits::NONE))
+        {
+            const Anvil::BufferBarrier barrier(Anvil::Utils::get_write_access_mask(current_state.access_mask),
+                                               in_dst_access_mask,
+                                               VK_QUEUE_FAMILY_IGNORED,
+                                               VK_QUEUE_FAMILY_IGNORED,
+                                               in_buffer_ptr,
+                                               in_buffer_ptr->get_create_info_ptr()->get_start_offset(),
+                                               in_buffer_ptr->get_create_info_ptr()->get_size        () );
+
+            if (!record_pipeline_barrier((current_state.stage_mask != Anvil::PipelineStageFlagBits::NONE) ? current_state.stage_mask : Anvil::PipelineStageFlagBits::TOP_OF_PIPE_BIT,
+                                         (in_dst_stage_mask        != Anvil::PipelineStageFlagBits::NONE) ? in_dst_stage_mask        : Anvil::PipelineStageFlagBits::BOTTOM_OF_PIPE_BIT,
+                                         Anvil::DependencyFlagBits::NONE,
+                                         0,       /* in_memory_barrier_count        */
+                                         nullptr, /* in_memory_barriers_ptr         */
+                                         1,       /* in_buffer_memory_barrier_count */
+                                        &barrier,
+                                         0,       /* in_image_memory_barrier_count  */
+                                         nullptr) /* in_image_memory_barriers_ptr   */)
+            {
+                goto end;
+            }
+        }
+    }
+
+    track_buffer_access(in_buffer_ptr,
+                        in_dst_stage_mask,
+                        in_dst_access_mask);
+
+    result = true;
+end:
+    return result;
+}
+
 /* Please see header for specification */
 bool Anvil::CommandBufferBase::record_update_buffer(Anvil::Buffer* in_dst_buffer_ptr,
                                                     VkDeviceSize   in_dst_offset,
@@ -4010,23 +7862,39 @@ bool Anvil::CommandBufferBase::record_update_buffer(Anvil::Buffer* in_dst_buffer
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(UpdateBufferCommand(in_dst_buffer_ptr,
-                                                     in_dst_offset,
-                                                     in_data_size,
-                                                     in_data_ptr) );
+            /* Keep a copy of the data, so that the command can be replayed after the caller releases it */
+            void* data_copy_ptr = m_command_arena.allocate(static_cast<size_t>(in_data_size),
+                                                           sizeof(uint32_t) );
+
+            memcpy(data_copy_ptr,
+                   in_data_ptr,
+                   static_cast<size_t>(in_data_size) );
+
+            m_commands.push_back(m_command_arena.create<UpdateBufferCommand>(in_dst_buffer_ptr,
+                                                                             in_dst_offset,
+                                                                             in_data_size,
+                                                                             data_copy_ptr) );
         }
     }
     #endif
 
 
+    track_buffer_access(in_dst_buffer_ptr,
+                        Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                        Anvil::AccessFlagBits::TRANSFER_WRITE_BIT);
+
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdUpdateBuffer(m_command_buffer,
-                                         in_dst_buffer_ptr->get_buffer(),
-                                         in_dst_offset,
-                                         in_data_size,
-                                         in_data_ptr);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdUpdateBuffer(m_command_buffer,
+                                                             in_dst_buffer_ptr->get_buffer(),
+                                                             in_dst_offset,
+                                                             in_data_size,
+                                                             in_data_ptr);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -4050,11 +7918,147 @@ bool Anvil::CommandBufferBase::record_wait_events(uint32_t                   in_
 
 {
     /* NOTE: The command can be executed both inside and outside a renderpass */
-    std::vector<VkEvent>               events            (in_event_count);
-    std::vector<VkBufferMemoryBarrier> buffer_barriers_vk(in_buffer_memory_barrier_count);
-    std::vector<VkImageMemoryBarrier>  image_barriers_vk (in_image_memory_barrier_count);
-    std::vector<VkMemoryBarrier>       memory_barriers_vk(in_memory_barrier_count);
-    bool                               result            (false);
+    ScratchArray<VkEvent,               N_MAX_STACK_SCRATCH_ITEMS> events            (in_event_count);
+    ScratchArray<VkBufferMemoryBarrier, N_MAX_STACK_SCRATCH_ITEMS> buffer_barriers_vk(in_buffer_memory_barrier_count);
+    ScratchArray<VkImageMemoryBarrier,  N_MAX_STACK_SCRATCH_ITEMS> image_barriers_vk (in_image_memory_barrier_count);
+    ScratchArray<VkMemoryBarrier,       N_MAX_STACK_SCRATCH_ITEMS> memory_barriers_vk(in_memory_barrier_count);
+    bool                                                           result            (false);
+
+    anvil_assert(in_event_count > 0); /* as per spec - easy to miss */
+
+    if (!m_recording_in_progress)
+    {
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
+    }
+
+    #ifdef STORE_COMMAND_BUFFER_COMMANDS
+    {
+        if (!m_command_stashing_disabled)
+        {
+            m_commands.push_back(m_command_arena.create<WaitEventsCommand>(in_event_count,
+                                                                           in_events,
+                                                                           in_src_stage_mask,
+                                                                           in_dst_stage_mask,
+                                                                           in_memory_barrier_count,
+                                                                           in_memory_barriers_ptr,
+                                                                           in_buffer_memory_barrier_count,
+                                                                           in_buffer_memory_barriers_ptr,
+                                                                           in_image_memory_barrier_count,
+                                                                           in_image_memory_barriers_ptr,
+                                                                           &m_command_arena) );
+        }
+    }
+    #endif
+
+
+    for (uint32_t n_event = 0;
+                  n_event < in_event_count;
+                ++n_event)
+    {
+        events.at(n_event) = in_events[n_event]->get_event();
+    }
+
+    for (uint32_t n_buffer_barrier = 0;
+                  n_buffer_barrier < in_buffer_memory_barrier_count;
+                ++n_buffer_barrier)
+    {
+        buffer_barriers_vk.at(n_buffer_barrier) = in_buffer_memory_barriers_ptr[n_buffer_barrier].get_barrier_vk();
+    }
+
+    for (uint32_t n_image_barrier = 0;
+                  n_image_barrier < in_image_memory_barrier_count;
+                ++n_image_barrier)
+    {
+        image_barriers_vk.at(n_image_barrier) = in_image_memory_barriers_ptr[n_image_barrier].get_barrier_vk();
+    }
+
+    for (uint32_t n_memory_barrier = 0;
+                  n_memory_barrier < in_memory_barrier_count;
+                ++n_memory_barrier)
+    {
+        memory_barriers_vk.at(n_memory_barrier) = in_memory_barriers_ptr[n_memory_barrier].get_barrier_vk();
+    }
+
+    track_barriers(in_dst_stage_mask,
+                   in_buffer_memory_barrier_count,
+                   in_buffer_memory_barriers_ptr,
+                   in_image_memory_barrier_count,
+                   in_image_memory_barriers_ptr);
+
+    record_wait_events_internal(in_event_count,
+                                events.data(),
+                                in_src_stage_mask,
+                                in_dst_stage_mask,
+                                in_memory_barrier_count,
+                                memory_barriers_vk.data(),
+                                in_buffer_memory_barrier_count,
+                                buffer_barriers_vk.data(),
+                                in_image_memory_barrier_count,
+                                image_barriers_vk.data() );
+
+    result = true;
+end:
+    return result;
+}
+
+/** Issues a vkCmdWaitEvents() call. Pending barriers are flushed first.
+ *
+ *  Shared by record_wait_events() and record_wait_events_raw(). Neither stashes the command, nor updates
+ *  tracked resource state.
+ *
+ *  Arguments as per vkCmdWaitEvents().
+ **/
+void Anvil::CommandBufferBase::record_wait_events_internal(uint32_t                     in_event_count,
+                                                           const VkEvent*               in_events_ptr,
+                                                           Anvil::PipelineStageFlags    in_src_stage_mask,
+                                                           Anvil::PipelineStageFlags    in_dst_stage_mask,
+                                                           uint32_t                     in_memory_barrier_count,
+                                                           const VkMemoryBarrier*       in_memory_barriers_ptr,
+                                                           uint32_t                     in_buffer_memory_barrier_count,
+                                                           const VkBufferMemoryBarrier* in_buffer_memory_barriers_ptr,
+                                                           uint32_t                     in_image_memory_barrier_count,
+                                                           const VkImageMemoryBarrier*  in_image_memory_barriers_ptr)
+{
+    flush_pending_barriers();
+
+    m_parent_command_pool_ptr->lock();
+    lock();
+    {
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdWaitEvents(m_command_buffer,
+                                                           in_event_count,
+                                                           (in_event_count                 > 0) ? in_events_ptr                 : nullptr,
+                                                           in_src_stage_mask.get_vk(),
+                                                           in_dst_stage_mask.get_vk(),
+                                                           in_memory_barrier_count,
+                                                           (in_memory_barrier_count        > 0) ? in_memory_barriers_ptr        : nullptr,
+                                                           in_buffer_memory_barrier_count,
+                                                           (in_buffer_memory_barrier_count > 0) ? in_buffer_memory_barriers_ptr : nullptr,
+                                                           in_image_memory_barrier_count,
+                                                           (in_image_memory_barrier_count  > 0) ? in_image_memory_barriers_ptr  : nullptr);
+    }
+    unlock();
+    m_parent_command_pool_ptr->unlock();
+}
+
+/* Please see header for specification */
+bool Anvil::CommandBufferBase::record_wait_events_raw(uint32_t                      in_event_count,
+                                                      Anvil::Event* const*          in_events,
+                                                      Anvil::PipelineStageFlags     in_src_stage_mask,
+                                                      Anvil::PipelineStageFlags     in_dst_stage_mask,
+                                                      uint32_t                      in_memory_barrier_count,
+                                                      const RawMemoryBarrier* const in_memory_barriers_ptr,
+                                                      uint32_t                      in_buffer_memory_barrier_count,
+                                                      const RawBufferBarrier* const in_buffer_memory_barriers_ptr,
+                                                      uint32_t                      in_image_memory_barrier_count,
+                                                      const RawImageBarrier*  const in_image_memory_barriers_ptr)
+{
+    /* NOTE: The command can be executed both inside and outside a renderpass */
+    ScratchArray<VkEvent, N_MAX_STACK_SCRATCH_ITEMS> events(in_event_count);
+    bool                                             result(false);
 
     anvil_assert(in_event_count > 0); /* as per spec - easy to miss */
 
@@ -4069,21 +8073,21 @@ bool Anvil::CommandBufferBase::record_wait_events(uint32_t                   in_
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(WaitEventsCommand(in_event_count,
-                                                   in_events,
-                                                   in_src_stage_mask,
-                                                   in_dst_stage_mask,
-                                                   in_memory_barrier_count,
-                                                   in_memory_barriers_ptr,
-                                                   in_buffer_memory_barrier_count,
-                                                   in_buffer_memory_barriers_ptr,
-                                                   in_image_memory_barrier_count,
-                                                   in_image_memory_barriers_ptr) );
+            m_commands.push_back(m_command_arena.create<WaitEventsRawCommand>(in_event_count,
+                                                                              in_events,
+                                                                              in_src_stage_mask,
+                                                                              in_dst_stage_mask,
+                                                                              in_memory_barrier_count,
+                                                                              in_memory_barriers_ptr,
+                                                                              in_buffer_memory_barrier_count,
+                                                                              in_buffer_memory_barriers_ptr,
+                                                                              in_image_memory_barrier_count,
+                                                                              in_image_memory_barriers_ptr,
+                                                                              &m_command_arena) );
         }
     }
     #endif
 
-
     for (uint32_t n_event = 0;
                   n_event < in_event_count;
                 ++n_event)
@@ -4091,41 +8095,80 @@ bool Anvil::CommandBufferBase::record_wait_events(uint32_t                   in_
         events.at(n_event) = in_events[n_event]->get_event();
     }
 
-    for (uint32_t n_buffer_barrier = 0;
-                  n_buffer_barrier < in_buffer_memory_barrier_count;
-                ++n_buffer_barrier)
+    record_wait_events_internal(in_event_count,
+                                events.data(),
+                                in_src_stage_mask,
+                                in_dst_stage_mask,
+                                in_memory_barrier_count,
+                                (in_memory_barrier_count        > 0) ? &in_memory_barriers_ptr[0].get_vk()        : nullptr,
+                                in_buffer_memory_barrier_count,
+                                (in_buffer_memory_barrier_count > 0) ? &in_buffer_memory_barriers_ptr[0].get_vk() : nullptr,
+                                in_image_memory_barrier_count,
+                                (in_image_memory_barrier_count  > 0) ? &in_image_memory_barriers_ptr[0].get_vk()  : nullptr);
+
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandBufferBase::record_write_acceleration_structures_properties_KHR(uint32_t                             in_n_acceleration_structures,
+                                                                                   Anvil::AccelerationStructure* const* in_acceleration_structure_ptrs,
+                                                                                   VkQueryType                          in_query_type,
+                                                                                   Anvil::QueryPool*                    in_query_pool_ptr,
+                                                                                   Anvil::QueryIndex                    in_first_query)
+{
+    ScratchArray<VkAccelerationStructureKHR, N_MAX_STACK_SCRATCH_ITEMS> acceleration_structures_vk(in_n_acceleration_structures);
+    bool                                                                result                    (false);
+
+    if (m_is_renderpass_active)
     {
-        buffer_barriers_vk.at(n_buffer_barrier) = in_buffer_memory_barriers_ptr[n_buffer_barrier].get_barrier_vk();
+        anvil_assert(!m_is_renderpass_active);
+
+        goto end;
     }
 
-    for (uint32_t n_image_barrier = 0;
-                  n_image_barrier < in_image_memory_barrier_count;
-                ++n_image_barrier)
+    if (!m_recording_in_progress)
     {
-        image_barriers_vk.at(n_image_barrier) = in_image_memory_barriers_ptr[n_image_barrier].get_barrier_vk();
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
     }
 
-    for (uint32_t n_memory_barrier = 0;
-                  n_memory_barrier < in_memory_barrier_count;
-                ++n_memory_barrier)
+    #ifdef STORE_COMMAND_BUFFER_COMMANDS
     {
-        memory_barriers_vk.at(n_memory_barrier) = in_memory_barriers_ptr[n_memory_barrier].get_barrier_vk();
+        if (!m_command_stashing_disabled)
+        {
+            m_commands.push_back(m_command_arena.create<WriteAccelerationStructuresPropertiesKHRCommand>(in_n_acceleration_structures,
+                                                                                                         in_acceleration_structure_ptrs,
+                                                                                                         in_query_type,
+                                                                                                         in_query_pool_ptr,
+                                                                                                         in_first_query,
+                                                                                                         &m_command_arena) );
+        }
+    }
+    #endif
+
+    for (uint32_t n_acceleration_structure = 0;
+                  n_acceleration_structure < in_n_acceleration_structures;
+                ++n_acceleration_structure)
+    {
+        acceleration_structures_vk.at(n_acceleration_structure) = in_acceleration_structure_ptrs[n_acceleration_structure]->get_acceleration_structure();
     }
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdWaitEvents(m_command_buffer,
-                                       in_event_count,
-                                       (in_event_count > 0) ? &events.at(0) : nullptr,
-                                       in_src_stage_mask.get_vk(),
-                                       in_dst_stage_mask.get_vk(),
-                                       in_memory_barrier_count,
-                                       (in_memory_barrier_count > 0) ? &memory_barriers_vk.at(0) : nullptr,
-                                       in_buffer_memory_barrier_count,
-                                       (in_buffer_memory_barrier_count > 0) ? &buffer_barriers_vk.at(0) : nullptr,
-                                       in_image_memory_barrier_count,
-                                       (in_image_memory_barrier_count > 0) ? &image_barriers_vk.at(0) : nullptr);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_extension_khr_acceleration_structure_entrypoints().vkCmdWriteAccelerationStructuresPropertiesKHR(m_command_buffer,
+                                                                                                                          in_n_acceleration_structures,
+                                                                                                                          acceleration_structures_vk.data(),
+                                                                                                                          in_query_type,
+                                                                                                                          in_query_pool_ptr->get_query_pool(),
+                                                                                                                          in_first_query);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -4156,17 +8199,21 @@ bool Anvil::CommandBufferBase::record_write_buffer_marker_AMD(const Anvil::Pipel
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(WriteBufferMarkerAMDCommand(in_pipeline_stage,
-                                                             in_dst_buffer_ptr,
-                                                             in_dst_offset,
-                                                             in_marker) );
+            m_commands.push_back(m_command_arena.create<WriteBufferMarkerAMDCommand>(in_pipeline_stage,
+                                                                                     in_dst_buffer_ptr,
+                                                                                     in_dst_offset,
+                                                                                     in_marker) );
         }
     }
     #endif
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
+        m_n_recorded_commands++;
+
         entrypoints.vkCmdWriteBufferMarkerAMD(m_command_buffer,
                                               static_cast<VkPipelineStageFlagBits>(in_pipeline_stage),
                                               in_dst_buffer_ptr->get_buffer(),
@@ -4200,20 +8247,24 @@ bool Anvil::CommandBufferBase::record_write_timestamp(Anvil::PipelineStageFlagBi
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(WriteTimestampCommand(in_pipeline_stage,
-                                                       in_query_pool_ptr,
-                                                       in_query_index) );
+            m_commands.push_back(m_command_arena.create<WriteTimestampCommand>(in_pipeline_stage,
+                                                                               in_query_pool_ptr,
+                                                                               in_query_index) );
         }
     }
     #endif
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdWriteTimestamp(m_command_buffer,
-                                           static_cast<VkPipelineStageFlagBits>(in_pipeline_stage),
-                                           in_query_pool_ptr->get_query_pool(),
-                                           in_query_index);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdWriteTimestamp(m_command_buffer,
+                                                               static_cast<VkPipelineStageFlagBits>(in_pipeline_stage),
+                                                               in_query_pool_ptr->get_query_pool(),
+                                                               in_query_index);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -4239,8 +8290,8 @@ bool Anvil::CommandBufferBase::reset(bool in_should_release_resources)
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        result_vk = Anvil::Vulkan::vkResetCommandBuffer(m_command_buffer,
-                                                        (in_should_release_resources) ? VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT : 0u);
+        result_vk = m_device_ptr->get_dispatch_table().vkResetCommandBuffer(m_command_buffer,
+                                                                            (in_should_release_resources) ? VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT : 0u);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -4258,11 +8309,38 @@ bool Anvil::CommandBufferBase::reset(bool in_should_release_resources)
     }
     #endif
 
+    m_bound_state.clear     ();
+    m_pending_barriers.clear();
+
+    m_n_filtered_state_calls    = 0;
+    m_n_recorded_commands       = 0;
+    m_n_recorded_pipeline_binds = 0;
+
     result = true;
 end:
     return result;
 }
 
+/* Please see header for specification */
+void Anvil::CommandBufferBase::set_barrier_batching_enabled(bool in_enabled)
+{
+    if (!in_enabled)
+    {
+        flush_pending_barriers();
+    }
+
+    m_barrier_batching_enabled = in_enabled;
+}
+
+/* Please see header for specification */
+void Anvil::CommandBufferBase::set_state_filtering_enabled(bool in_enabled)
+{
+    /* State bound while filtering was disabled is not known to the cache */
+    m_bound_state.clear();
+
+    m_state_filtering_enabled = in_enabled;
+}
+
 /* Please see header for specification */
 bool Anvil::CommandBufferBase::stop_recording()
 {
@@ -4276,10 +8354,12 @@ bool Anvil::CommandBufferBase::stop_recording()
         goto end;
     }
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        result_vk = Anvil::Vulkan::vkEndCommandBuffer(m_command_buffer);
+        result_vk = m_device_ptr->get_dispatch_table().vkEndCommandBuffer(m_command_buffer);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -4293,18 +8373,257 @@ bool Anvil::CommandBufferBase::stop_recording()
 
     m_recording_in_progress = false;
     result                  = true;
+
+    Anvil::PerfCounters::increment(Anvil::PerfCounters::Counter::COMMAND_BUFFER_COMMANDS,
+                                   m_n_recorded_commands);
+    Anvil::PerfCounters::increment(Anvil::PerfCounters::Counter::COMMAND_BUFFERS_RECORDED);
+    Anvil::PerfCounters::increment(Anvil::PerfCounters::Counter::PIPELINE_BINDS,
+                                   m_n_recorded_pipeline_binds);
 end:
     return result;
 }
 
+/** Records a pipeline barrier, or merges it with pending barriers if barrier batching is enabled.
+ *
+ *  Shared by record_pipeline_barrier() and record_pipeline_barrier_raw(). Neither stashes the command, nor
+ *  updates tracked resource state.
+ *
+ *  Arguments as per vkCmdPipelineBarrier().
+ **/
+void Anvil::CommandBufferBase::record_pipeline_barrier_internal(Anvil::PipelineStageFlags    in_src_stage_mask,
+                                                                Anvil::PipelineStageFlags    in_dst_stage_mask,
+                                                                Anvil::DependencyFlags       in_dependency_flags,
+                                                                uint32_t                     in_memory_barrier_count,
+                                                                const VkMemoryBarrier*       in_memory_barriers_ptr,
+                                                                uint32_t                     in_buffer_memory_barrier_count,
+                                                                const VkBufferMemoryBarrier* in_buffer_memory_barriers_ptr,
+                                                                uint32_t                     in_image_memory_barrier_count,
+                                                                const VkImageMemoryBarrier*  in_image_memory_barriers_ptr)
+{
+    if (m_barrier_batching_enabled &&
+       !m_is_renderpass_active)
+    {
+        bool needs_flush = false;
+
+        if (!m_pending_barriers.is_empty() )
+        {
+            /* Layout transitions and ownership transfers are ordered with respect to other barriers referring
+             * to the same resource, so these cannot share a single vkCmdPipelineBarrier() call. The same applies
+             * to global memory barriers, which the new transitions may depend on (and vice versa). */
+            bool has_new_transitions     = false;
+            bool has_pending_transitions = false;
+
+            needs_flush = (m_pending_barriers.dependency_flags != in_dependency_flags);
+
+            for (uint32_t n_buffer_barrier = 0;
+                          n_buffer_barrier < in_buffer_memory_barrier_count;
+                        ++n_buffer_barrier)
+            {
+                const auto& current_barrier = in_buffer_memory_barriers_ptr[n_buffer_barrier];
+
+                has_new_transitions |= (current_barrier.srcQueueFamilyIndex != current_barrier.dstQueueFamilyIndex);
+
+                for (const auto& current_pending_barrier : m_pending_barriers.buffer_barriers)
+                {
+                    needs_flush |= (current_barrier.buffer == current_pending_barrier.buffer);
+                }
+            }
+
+            for (uint32_t n_image_barrier = 0;
+                          n_image_barrier < in_image_memory_barrier_count;
+                        ++n_image_barrier)
+            {
+                const auto& current_barrier = in_image_memory_barriers_ptr[n_image_barrier];
+
+                has_new_transitions |= (current_barrier.oldLayout           != current_barrier.newLayout)         ||
+                                       (current_barrier.srcQueueFamilyIndex != current_barrier.dstQueueFamilyIndex);
+
+                for (const auto& current_pending_barrier : m_pending_barriers.image_barriers)
+                {
+                    needs_flush |= (current_barrier.image == current_pending_barrier.image);
+                }
+            }
+
+            for (const auto& current_pending_barrier : m_pending_barriers.buffer_barriers)
+            {
+                has_pending_transitions |= (current_pending_barrier.srcQueueFamilyIndex != current_pending_barrier.dstQueueFamilyIndex);
+            }
+
+            for (const auto& current_pending_barrier : m_pending_barriers.image_barriers)
+            {
+                has_pending_transitions |= (current_pending_barrier.oldLayout           != current_pending_barrier.newLayout)         ||
+                                           (current_pending_barrier.srcQueueFamilyIndex != current_pending_barrier.dstQueueFamilyIndex);
+            }
+
+            needs_flush |= (has_new_transitions     && m_pending_barriers.memory_barriers.size() > 0) ||
+                           (has_pending_transitions && in_memory_barrier_count                   > 0);
+        }
+
+        if (needs_flush)
+        {
+            flush_pending_barriers();
+        }
+
+        m_pending_barriers.buffer_barriers.insert(m_pending_barriers.buffer_barriers.end(),
+                                                  in_buffer_memory_barriers_ptr,
+                                                  in_buffer_memory_barriers_ptr + in_buffer_memory_barrier_count);
+        m_pending_barriers.image_barriers.insert (m_pending_barriers.image_barriers.end(),
+                                                  in_image_memory_barriers_ptr,
+                                                  in_image_memory_barriers_ptr + in_image_memory_barrier_count);
+        m_pending_barriers.memory_barriers.insert(m_pending_barriers.memory_barriers.end(),
+                                                  in_memory_barriers_ptr,
+                                                  in_memory_barriers_ptr + in_memory_barrier_count);
+
+        m_pending_barriers.dependency_flags  = in_dependency_flags;
+        m_pending_barriers.dst_stage_mask   |= in_dst_stage_mask;
+        m_pending_barriers.src_stage_mask   |= in_src_stage_mask;
+    }
+    else
+    {
+        m_parent_command_pool_ptr->lock();
+        lock();
+        {
+            m_n_recorded_commands++;
+
+            m_device_ptr->get_dispatch_table().vkCmdPipelineBarrier(m_command_buffer,
+                                                                    in_src_stage_mask.get_vk  (),
+                                                                    in_dst_stage_mask.get_vk  (),
+                                                                    in_dependency_flags.get_vk(),
+                                                                    in_memory_barrier_count,
+                                                                    (in_memory_barrier_count        > 0) ? in_memory_barriers_ptr        : nullptr,
+                                                                    in_buffer_memory_barrier_count,
+                                                                    (in_buffer_memory_barrier_count > 0) ? in_buffer_memory_barriers_ptr : nullptr,
+                                                                    in_image_memory_barrier_count,
+                                                                    (in_image_memory_barrier_count  > 0) ? in_image_memory_barriers_ptr  : nullptr);
+        }
+        unlock();
+        m_parent_command_pool_ptr->unlock();
+    }
+
+}
+
+/** Updates the tracked state of all buffers and images referenced by the specified barriers. Resources which do
+ *  not have state tracking enabled are skipped.
+ *
+ *  @param in_dst_stage_mask              Destination stage mask of the barriers.
+ *  @param in_buffer_memory_barrier_count Number of buffer barriers under @param in_buffer_memory_barriers_ptr.
+ *  @param in_buffer_memory_barriers_ptr  Buffer barriers.
+ *  @param in_image_memory_barrier_count  Number of image barriers under @param in_image_memory_barriers_ptr.
+ *  @param in_image_memory_barriers_ptr   Image barriers.
+ **/
+void Anvil::CommandBufferBase::track_barriers(Anvil::PipelineStageFlags  in_dst_stage_mask,
+                                              uint32_t                   in_buffer_memory_barrier_count,
+                                              const BufferBarrier* const in_buffer_memory_barriers_ptr,
+                                              uint32_t                   in_image_memory_barrier_count,
+                                              const ImageBarrier*  const in_image_memory_barriers_ptr)
+{
+    for (uint32_t n_buffer_barrier = 0;
+                  n_buffer_barrier < in_buffer_memory_barrier_count;
+                ++n_buffer_barrier)
+    {
+        const auto& current_barrier = in_buffer_memory_barriers_ptr[n_buffer_barrier];
+
+        if (current_barrier.buffer_ptr != nullptr)
+        {
+            current_barrier.buffer_ptr->update_tracked_state(in_dst_stage_mask,
+                                                             current_barrier.dst_access_mask,
+                                                             true); /* in_is_barrier */
+        }
+    }
+
+    for (uint32_t n_image_barrier = 0;
+                  n_image_barrier < in_image_memory_barrier_count;
+                ++n_image_barrier)
+    {
+        const auto& current_barrier = in_image_memory_barriers_ptr[n_image_barrier];
+
+        if (current_barrier.image_ptr != nullptr)
+        {
+            current_barrier.image_ptr->update_tracked_state(current_barrier.subresource_range,
+                                                            current_barrier.new_layout,
+                                                            in_dst_stage_mask,
+                                                            current_barrier.dst_access_mask,
+                                                            true); /* in_is_barrier */
+        }
+    }
+}
+
+/** Adds an access to the tracked state of a buffer. Does nothing if the buffer is null or does not have
+ *  state tracking enabled.
+ *
+ *  @param in_buffer_ptr  Buffer accessed by the command.
+ *  @param in_stage_mask  Stages the command accesses the buffer at.
+ *  @param in_access_mask Access types used by the command.
+ **/
+void Anvil::CommandBufferBase::track_buffer_access(Anvil::Buffer*            in_buffer_ptr,
+                                                   Anvil::PipelineStageFlags in_stage_mask,
+                                                   Anvil::AccessFlags        in_access_mask)
+{
+    if (in_buffer_ptr != nullptr)
+    {
+        in_buffer_ptr->update_tracked_state(in_stage_mask,
+                                            in_access_mask,
+                                            false); /* in_is_barrier */
+    }
+}
+
+/** Adds an access to the tracked state of image subresources. Does nothing if the image is null or does not
+ *  have state tracking enabled.
+ *
+ *  @param in_image_ptr         Image accessed by the command.
+ *  @param in_subresource_range Subresources accessed by the command.
+ *  @param in_layout            Layout the subresources are in after the command executes.
+ *  @param in_stage_mask        Stages the command accesses the subresources at.
+ *  @param in_access_mask       Access types used by the command.
+ **/
+void Anvil::CommandBufferBase::track_image_access(Anvil::Image*                       in_image_ptr,
+                                                  const Anvil::ImageSubresourceRange& in_subresource_range,
+                                                  Anvil::ImageLayout                  in_layout,
+                                                  Anvil::PipelineStageFlags           in_stage_mask,
+                                                  Anvil::AccessFlags                  in_access_mask)
+{
+    if (in_image_ptr != nullptr)
+    {
+        in_image_ptr->update_tracked_state(in_subresource_range,
+                                           in_layout,
+                                           in_stage_mask,
+                                           in_access_mask,
+                                           false); /* in_is_barrier */
+    }
+}
+
+/** Same as the other track_image_access() overload, but takes subresource layers instead of a range. */
+void Anvil::CommandBufferBase::track_image_access(Anvil::Image*                        in_image_ptr,
+                                                  const Anvil::ImageSubresourceLayers& in_subresource_layers,
+                                                  Anvil::ImageLayout                   in_layout,
+                                                  Anvil::PipelineStageFlags            in_stage_mask,
+                                                  Anvil::AccessFlags                   in_access_mask)
+{
+    Anvil::ImageSubresourceRange subresource_range;
+
+    subresource_range.aspect_mask      = in_subresource_layers.aspect_mask;
+    subresource_range.base_array_layer = in_subresource_layers.base_array_layer;
+    subresource_range.base_mip_level   = in_subresource_layers.mip_level;
+    subresource_range.layer_count      = in_subresource_layers.layer_count;
+    subresource_range.level_count      = 1;
+
+    track_image_access(in_image_ptr,
+                       subresource_range,
+                       in_layout,
+                       in_stage_mask,
+                       in_access_mask);
+}
+
 /* Please see header for specification */
 Anvil::PrimaryCommandBuffer::PrimaryCommandBuffer(const Anvil::BaseDevice* in_device_ptr,
                                                   Anvil::CommandPool*      in_parent_command_pool_ptr,
                                                   bool                     in_mt_safe)
-    :CommandBufferBase(in_device_ptr,
-                       in_parent_command_pool_ptr,
-                       COMMAND_BUFFER_TYPE_PRIMARY,
-                       in_mt_safe)
+    :CommandBufferBase                    (in_device_ptr,
+                                           in_parent_command_pool_ptr,
+                                           COMMAND_BUFFER_TYPE_PRIMARY,
+                                           in_mt_safe),
+     m_is_pipeline_statistics_pass_active(false),
+     m_pipeline_statistics_profiler_ptr  (nullptr)
 {
     VkCommandBufferAllocateInfo alloc_info;
     VkResult                    result_vk (VK_ERROR_INITIALIZATION_FAILED);
@@ -4319,9 +8638,9 @@ Anvil::PrimaryCommandBuffer::PrimaryCommandBuffer(const Anvil::BaseDevice* in_de
 
     in_parent_command_pool_ptr->lock();
     {
-        result_vk = Anvil::Vulkan::vkAllocateCommandBuffers(m_device_ptr->get_device_vk(),
-                                                            &alloc_info,
-                                                            &m_command_buffer);
+        result_vk = m_device_ptr->get_dispatch_table().vkAllocateCommandBuffers(m_device_ptr->get_device_vk(),
+                                                                                &alloc_info,
+                                                                                &m_command_buffer);
     }
     in_parent_command_pool_ptr->unlock();
 
@@ -4338,7 +8657,9 @@ bool Anvil::PrimaryCommandBuffer::record_begin_render_pass(uint32_t
                                                            const uint32_t&                         in_opt_n_attachment_initial_sample_locations,
                                                            const Anvil::AttachmentSampleLocations* in_opt_attachment_initial_sample_locations_ptr,
                                                            const uint32_t&                         in_opt_n_post_subpass_sample_locations,
-                                                           const Anvil::SubpassSampleLocations*    in_opt_post_subpass_sample_locations_ptr)
+                                                           const Anvil::SubpassSampleLocations*    in_opt_post_subpass_sample_locations_ptr,
+                                                           const uint32_t&                         in_opt_n_attachment_image_views,
+                                                           Anvil::ImageView* const*                in_opt_attachment_image_view_ptrs)
 {
     return record_begin_render_pass(in_n_clear_values,
                                     in_clear_value_ptrs,
@@ -4351,7 +8672,9 @@ bool Anvil::PrimaryCommandBuffer::record_begin_render_pass(uint32_t
                                     in_opt_n_attachment_initial_sample_locations,
                                     in_opt_attachment_initial_sample_locations_ptr,
                                     in_opt_n_post_subpass_sample_locations,
-                                    in_opt_post_subpass_sample_locations_ptr);
+                                    in_opt_post_subpass_sample_locations_ptr,
+                                    in_opt_n_attachment_image_views,
+                                    in_opt_attachment_image_view_ptrs);
 }
 
 /* Please see header for specification */
@@ -4366,7 +8689,9 @@ bool Anvil::PrimaryCommandBuffer::record_begin_render_pass(uint32_t
                                                            const uint32_t&                         in_opt_n_attachment_initial_sample_locations,
                                                            const Anvil::AttachmentSampleLocations* in_opt_attachment_initial_sample_locations_ptr,
                                                            const uint32_t&                         in_opt_n_post_subpass_sample_locations,
-                                                           const Anvil::SubpassSampleLocations*    in_opt_post_subpass_sample_locations_ptr)
+                                                           const Anvil::SubpassSampleLocations*    in_opt_post_subpass_sample_locations_ptr,
+                                                           const uint32_t&                         in_opt_n_attachment_image_views,
+                                                           Anvil::ImageView* const*                in_opt_attachment_image_view_ptrs)
 {
     return record_begin_render_pass_internal(false, /* in_use_khr_create_rp2_extension */
                                              in_n_clear_values,
@@ -4380,7 +8705,9 @@ bool Anvil::PrimaryCommandBuffer::record_begin_render_pass(uint32_t
                                              in_opt_n_attachment_initial_sample_locations,
                                              in_opt_attachment_initial_sample_locations_ptr,
                                              in_opt_n_post_subpass_sample_locations,
-                                             in_opt_post_subpass_sample_locations_ptr);
+                                             in_opt_post_subpass_sample_locations_ptr,
+                                             in_opt_n_attachment_image_views,
+                                             in_opt_attachment_image_view_ptrs);
 }
 
 /* Please see header for specification */
@@ -4393,7 +8720,9 @@ bool Anvil::PrimaryCommandBuffer::record_begin_render_pass2_KHR(uint32_t
                                                                 const uint32_t&                         in_opt_n_attachment_initial_sample_locations,
                                                                 const Anvil::AttachmentSampleLocations* in_opt_attachment_initial_sample_locations_ptr,
                                                                 const uint32_t&                         in_opt_n_post_subpass_sample_locations,
-                                                                const Anvil::SubpassSampleLocations*    in_opt_post_subpass_sample_locations_ptr)
+                                                                const Anvil::SubpassSampleLocations*    in_opt_post_subpass_sample_locations_ptr,
+                                                                const uint32_t&                         in_opt_n_attachment_image_views,
+                                                                Anvil::ImageView* const*                in_opt_attachment_image_view_ptrs)
 {
     return record_begin_render_pass2_KHR(in_n_clear_values,
                                          in_clear_value_ptrs,
@@ -4406,7 +8735,9 @@ bool Anvil::PrimaryCommandBuffer::record_begin_render_pass2_KHR(uint32_t
                                          in_opt_n_attachment_initial_sample_locations,
                                          in_opt_attachment_initial_sample_locations_ptr,
                                          in_opt_n_post_subpass_sample_locations,
-                                         in_opt_post_subpass_sample_locations_ptr);
+                                         in_opt_post_subpass_sample_locations_ptr,
+                                         in_opt_n_attachment_image_views,
+                                         in_opt_attachment_image_view_ptrs);
 }
 
 /* Please see header for specification */
@@ -4421,7 +8752,9 @@ bool Anvil::PrimaryCommandBuffer::record_begin_render_pass2_KHR(uint32_t
                                                                 const uint32_t&                         in_opt_n_attachment_initial_sample_locations,
                                                                 const Anvil::AttachmentSampleLocations* in_opt_attachment_initial_sample_locations_ptr,
                                                                 const uint32_t&                         in_opt_n_post_subpass_sample_locations,
-                                                                const Anvil::SubpassSampleLocations*    in_opt_post_subpass_sample_locations_ptr)
+                                                                const Anvil::SubpassSampleLocations*    in_opt_post_subpass_sample_locations_ptr,
+                                                                const uint32_t&                         in_opt_n_attachment_image_views,
+                                                                Anvil::ImageView* const*                in_opt_attachment_image_view_ptrs)
 {
     anvil_assert(m_device_ptr->get_extension_info()->khr_create_renderpass2() );
 
@@ -4437,7 +8770,9 @@ bool Anvil::PrimaryCommandBuffer::record_begin_render_pass2_KHR(uint32_t
                                              in_opt_n_attachment_initial_sample_locations,
                                              in_opt_attachment_initial_sample_locations_ptr,
                                              in_opt_n_post_subpass_sample_locations,
-                                             in_opt_post_subpass_sample_locations_ptr);
+                                             in_opt_post_subpass_sample_locations_ptr,
+                                             in_opt_n_attachment_image_views,
+                                             in_opt_attachment_image_view_ptrs);
 }
 
 /* Please see header for specification */
@@ -4453,12 +8788,16 @@ bool Anvil::PrimaryCommandBuffer::record_begin_render_pass_internal(const bool&
                                                                     const uint32_t&                         in_opt_n_attachment_initial_sample_locations,
                                                                     const Anvil::AttachmentSampleLocations* in_opt_attachment_initial_sample_locations_ptr,
                                                                     const uint32_t&                         in_opt_n_post_subpass_sample_locations,
-                                                                    const Anvil::SubpassSampleLocations*    in_opt_post_subpass_sample_locations_ptr)
+                                                                    const Anvil::SubpassSampleLocations*    in_opt_post_subpass_sample_locations_ptr,
+                                                                    const uint32_t&                         in_opt_n_attachment_image_views,
+                                                                    Anvil::ImageView* const*                in_opt_attachment_image_view_ptrs)
 {
-    const Anvil::DeviceType device_type = m_device_ptr->get_type();
-    bool                    result      = false;
+    std::vector<VkImageView> attachment_image_views_vk;
+    const Anvil::DeviceType  device_type                = m_device_ptr->get_type();
+    const bool               is_fbo_imageless           = in_fbo_ptr->get_create_info_ptr()->is_imageless();
+    bool                     result                     = false;
 
-    Anvil::StructChainer<VkRenderPassBeginInfo> render_pass_begin_info_chain;
+    Anvil::InlineStructChainer<VkRenderPassBeginInfo, 256> render_pass_begin_info_chain;
 
     if (m_is_renderpass_active)
     {
@@ -4474,39 +8813,82 @@ bool Anvil::PrimaryCommandBuffer::record_begin_render_pass_internal(const bool&
         goto end;
     }
 
+    /* Imageless framebuffers take their image views at render pass begin time. Other framebuffers must not be given any. */
+    if (is_fbo_imageless)
+    {
+        if (in_opt_n_attachment_image_views   != in_fbo_ptr->get_create_info_ptr()->get_n_attachments() ||
+            in_opt_attachment_image_view_ptrs == nullptr)
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+    else
+    if (in_opt_n_attachment_image_views != 0)
+    {
+        anvil_assert(in_opt_n_attachment_image_views == 0);
+
+        goto end;
+    }
+
+    /* Queries must be begun outside the render pass, so the profiler's pass is started before the render pass */
+    if (m_pipeline_statistics_profiler_ptr != nullptr &&
+       !m_pipeline_statistics_profiler_ptr->is_pass_active() )
+    {
+        std::string pass_name = in_render_pass_ptr->get_name();
+
+        if (pass_name.empty() )
+        {
+            pass_name = "RenderPass " + std::to_string(reinterpret_cast<uintptr_t>(in_render_pass_ptr) );
+        }
+
+        if (!m_pipeline_statistics_profiler_ptr->begin_pass(this,
+                                                            pass_name) )
+        {
+            goto end;
+        }
+
+        m_is_pipeline_statistics_pass_active = true;
+    }
+
     #ifdef STORE_COMMAND_BUFFER_COMMANDS
     {
         if (!m_command_stashing_disabled)
         {
             if (in_use_khr_create_rp2_extension)
             {
-                m_commands.push_back(BeginRenderPass2KHRCommand(in_n_clear_values,
-                                                                in_clear_value_ptrs,
-                                                                in_fbo_ptr,
-                                                                in_device_mask,
-                                                                in_n_render_areas,
-                                                                in_render_areas_ptr,
-                                                                in_render_pass_ptr,
-                                                                in_contents,
-                                                                in_opt_n_attachment_initial_sample_locations,
-                                                                in_opt_attachment_initial_sample_locations_ptr,
-                                                                in_opt_n_post_subpass_sample_locations,
-                                                                in_opt_post_subpass_sample_locations_ptr) );
+                m_commands.push_back(m_command_arena.create<BeginRenderPass2KHRCommand>(in_n_clear_values,
+                                                                                        in_clear_value_ptrs,
+                                                                                        in_fbo_ptr,
+                                                                                        in_device_mask,
+                                                                                        in_n_render_areas,
+                                                                                        in_render_areas_ptr,
+                                                                                        in_render_pass_ptr,
+                                                                                        in_contents,
+                                                                                        in_opt_n_attachment_initial_sample_locations,
+                                                                                        in_opt_attachment_initial_sample_locations_ptr,
+                                                                                        in_opt_n_post_subpass_sample_locations,
+                                                                                        in_opt_post_subpass_sample_locations_ptr,
+                                                                                        in_opt_n_attachment_image_views,
+                                                                                        in_opt_attachment_image_view_ptrs) );
             }
             else
             {
-                m_commands.push_back(BeginRenderPassCommand(in_n_clear_values,
-                                                            in_clear_value_ptrs,
-                                                            in_fbo_ptr,
-                                                            in_device_mask,
-                                                            in_n_render_areas,
-                                                            in_render_areas_ptr,
-                                                            in_render_pass_ptr,
-                                                            in_contents,
-                                                            in_opt_n_attachment_initial_sample_locations,
-                                                            in_opt_attachment_initial_sample_locations_ptr,
-                                                            in_opt_n_post_subpass_sample_locations,
-                                                            in_opt_post_subpass_sample_locations_ptr) );
+                m_commands.push_back(m_command_arena.create<BeginRenderPassCommand>(in_n_clear_values,
+                                                                                    in_clear_value_ptrs,
+                                                                                    in_fbo_ptr,
+                                                                                    in_device_mask,
+                                                                                    in_n_render_areas,
+                                                                                    in_render_areas_ptr,
+                                                                                    in_render_pass_ptr,
+                                                                                    in_contents,
+                                                                                    in_opt_n_attachment_initial_sample_locations,
+                                                                                    in_opt_attachment_initial_sample_locations_ptr,
+                                                                                    in_opt_n_post_subpass_sample_locations,
+                                                                                    in_opt_post_subpass_sample_locations_ptr,
+                                                                                    in_opt_n_attachment_image_views,
+                                                                                    in_opt_attachment_image_view_ptrs) );
             }
         }
     }
@@ -4514,6 +8896,80 @@ bool Anvil::PrimaryCommandBuffer::record_begin_render_pass_internal(const bool&
 
     anvil_assert(in_render_areas_ptr != nullptr);
 
+    /* Attachments are left in their final layouts once the renderpass ends */
+    {
+        const Anvil::FramebufferCreateInfo* fbo_create_info_ptr = in_fbo_ptr->get_create_info_ptr();
+        const Anvil::RenderPassCreateInfo*  rp_create_info_ptr  = in_render_pass_ptr->get_render_pass_create_info();
+
+        for (uint32_t n_attachment = 0;
+                      n_attachment < fbo_create_info_ptr->get_n_attachments() &&
+                      n_attachment < rp_create_info_ptr->get_n_attachments ();
+                    ++n_attachment)
+        {
+            Anvil::AttachmentType attachment_type = Anvil::AttachmentType::UNKNOWN;
+            Anvil::ImageLayout    final_layout    = Anvil::ImageLayout::UNDEFINED;
+            Anvil::ImageView*     image_view_ptr  = nullptr;
+
+            if (is_fbo_imageless)
+            {
+                image_view_ptr = in_opt_attachment_image_view_ptrs[n_attachment];
+            }
+            else
+            if (!fbo_create_info_ptr->get_attachment_at_index(n_attachment,
+                                                             &image_view_ptr) )
+            {
+                anvil_assert_fail();
+
+                continue;
+            }
+
+            if (image_view_ptr == nullptr                                   ||
+                !rp_create_info_ptr->get_attachment_type(n_attachment,
+                                                        &attachment_type) )
+            {
+                anvil_assert_fail();
+
+                continue;
+            }
+
+            if (attachment_type == Anvil::AttachmentType::COLOR)
+            {
+                rp_create_info_ptr->get_color_attachment_properties(n_attachment,
+                                                                    nullptr, /* out_opt_format_ptr         */
+                                                                    nullptr, /* out_opt_sample_count_ptr   */
+                                                                    nullptr, /* out_opt_load_op_ptr        */
+                                                                    nullptr, /* out_opt_store_op_ptr       */
+                                                                    nullptr, /* out_opt_initial_layout_ptr */
+                                                                   &final_layout);
+
+                track_image_access(image_view_ptr->get_create_info_ptr()->get_parent_image(),
+                                   image_view_ptr->get_subresource_range(),
+                                   final_layout,
+                                   Anvil::PipelineStageFlagBits::COLOR_ATTACHMENT_OUTPUT_BIT,
+                                   Anvil::AccessFlagBits::COLOR_ATTACHMENT_READ_BIT | Anvil::AccessFlagBits::COLOR_ATTACHMENT_WRITE_BIT);
+            }
+            else
+            if (attachment_type == Anvil::AttachmentType::DEPTH_STENCIL)
+            {
+                rp_create_info_ptr->get_depth_stencil_attachment_properties(n_attachment,
+                                                                            nullptr, /* out_opt_format_ptr           */
+                                                                            nullptr, /* out_opt_sample_count_ptr     */
+                                                                            nullptr, /* out_opt_depth_load_op_ptr    */
+                                                                            nullptr, /* out_opt_depth_store_op_ptr   */
+                                                                            nullptr, /* out_opt_stencil_load_op_ptr  */
+                                                                            nullptr, /* out_opt_stencil_store_op_ptr */
+                                                                            nullptr, /* out_opt_initial_layout_ptr   */
+                                                                           &final_layout);
+
+                track_image_access(image_view_ptr->get_create_info_ptr()->get_parent_image(),
+                                   image_view_ptr->get_subresource_range(),
+                                   final_layout,
+                                   Anvil::PipelineStageFlagBits::EARLY_FRAGMENT_TESTS_BIT          | Anvil::PipelineStageFlagBits::LATE_FRAGMENT_TESTS_BIT,
+                                   Anvil::AccessFlagBits::DEPTH_STENCIL_ATTACHMENT_READ_BIT | Anvil::AccessFlagBits::DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+            }
+        }
+    }
+
     {
         VkRenderPassBeginInfo render_pass_begin_info;
 
@@ -4528,6 +8984,30 @@ bool Anvil::PrimaryCommandBuffer::record_begin_render_pass_internal(const bool&
         render_pass_begin_info_chain.append_struct(render_pass_begin_info);
     }
 
+    if (is_fbo_imageless)
+    {
+        VkRenderPassAttachmentBeginInfoKHR attachment_begin_info;
+
+        anvil_assert(m_device_ptr->get_extension_info()->khr_imageless_framebuffer() );
+
+        attachment_image_views_vk.reserve(in_opt_n_attachment_image_views);
+
+        for (uint32_t n_attachment = 0;
+                      n_attachment < in_opt_n_attachment_image_views;
+                    ++n_attachment)
+        {
+            attachment_image_views_vk.push_back(in_opt_attachment_image_view_ptrs[n_attachment]->get_image_view() );
+        }
+
+        attachment_begin_info.attachmentCount = in_opt_n_attachment_image_views;
+        attachment_begin_info.pAttachments    = (in_opt_n_attachment_image_views > 0) ? &attachment_image_views_vk.at(0)
+                                                                                      : nullptr;
+        attachment_begin_info.pNext           = nullptr;
+        attachment_begin_info.sType           = VK_STRUCTURE_TYPE_RENDER_PASS_ATTACHMENT_BEGIN_INFO_KHR;
+
+        render_pass_begin_info_chain.append_struct(attachment_begin_info);
+    }
+
     if (device_type == Anvil::DeviceType::MULTI_GPU)
     {
         VkDeviceGroupRenderPassBeginInfoKHR render_pass_device_group_begin_info;
@@ -4578,16 +9058,18 @@ bool Anvil::PrimaryCommandBuffer::record_begin_render_pass_internal(const bool&
         render_pass_begin_info_chain.append_struct(sl_begin_info);
     }
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        auto chain_ptr = render_pass_begin_info_chain.create_chain();
-
         if (!in_use_khr_create_rp2_extension)
         {
-            Anvil::Vulkan::vkCmdBeginRenderPass(m_command_buffer,
-                                                chain_ptr->get_root_struct(),
-                                                static_cast<VkSubpassContents>(in_contents) );
+            m_n_recorded_commands++;
+
+            m_device_ptr->get_dispatch_table().vkCmdBeginRenderPass(m_command_buffer,
+                                                                    render_pass_begin_info_chain.get_root_struct(),
+                                                                    static_cast<VkSubpassContents>(in_contents) );
         }
         else
         {
@@ -4598,8 +9080,10 @@ bool Anvil::PrimaryCommandBuffer::record_begin_render_pass_internal(const bool&
             subpass_begin_info.pNext    = nullptr;
             subpass_begin_info.sType    = VK_STRUCTURE_TYPE_SUBPASS_BEGIN_INFO_KHR;
 
+            m_n_recorded_commands++;
+
             crp2_entrypoints.vkCmdBeginRenderPass2KHR(m_command_buffer,
-                                                      chain_ptr->get_root_struct(),
+                                                      render_pass_begin_info_chain.get_root_struct(),
                                                      &subpass_begin_info);
         }
     }
@@ -4651,16 +9135,18 @@ bool Anvil::PrimaryCommandBuffer::record_end_render_pass_internal(const bool& in
         {
             if (in_use_khr_create_rp2_extension)
             {
-                m_commands.push_back(EndRenderPass2KHRCommand() );
+                m_commands.push_back(m_command_arena.create<EndRenderPass2KHRCommand>() );
             }
             else
             {
-                m_commands.push_back(EndRenderPassCommand() );
+                m_commands.push_back(m_command_arena.create<EndRenderPassCommand>() );
             }
         }
     }
     #endif
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -4672,19 +9158,34 @@ bool Anvil::PrimaryCommandBuffer::record_end_render_pass_internal(const bool& in
             subpass_end_info.pNext = nullptr;
             subpass_end_info.sType = VK_STRUCTURE_TYPE_SUBPASS_END_INFO_KHR;
 
+            m_n_recorded_commands++;
+
             crp2_entrypoints.vkCmdEndRenderPass2KHR(m_command_buffer,
                                                    &subpass_end_info);
         }
         else
         {
-            Anvil::Vulkan::vkCmdEndRenderPass(m_command_buffer);
+            m_n_recorded_commands++;
+
+            m_device_ptr->get_dispatch_table().vkCmdEndRenderPass(m_command_buffer);
         }
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
 
     m_is_renderpass_active = false;
-    result                 = true;
+
+    if (m_is_pipeline_statistics_pass_active)
+    {
+        m_is_pipeline_statistics_pass_active = false;
+
+        if (!m_pipeline_statistics_profiler_ptr->end_pass(this) )
+        {
+            goto end;
+        }
+    }
+
+    result = true;
 end:
     return result;
 }
@@ -4708,8 +9209,9 @@ bool Anvil::PrimaryCommandBuffer::record_execute_commands(uint32_t
     {
         if (!m_command_stashing_disabled)
         {
-            m_commands.push_back(ExecuteCommandsCommand(in_cmd_buffers_count,
-                                                        in_cmd_buffer_ptrs) );
+            m_commands.push_back(m_command_arena.create<ExecuteCommandsCommand>(in_cmd_buffers_count,
+                                                                                in_cmd_buffer_ptrs,
+                                                                                &m_command_arena) );
         }
     }
     #endif
@@ -4721,12 +9223,19 @@ bool Anvil::PrimaryCommandBuffer::record_execute_commands(uint32_t
         cmd_buffers.at(n_cmd_buffer) = in_cmd_buffer_ptrs[n_cmd_buffer]->get_command_buffer();
     }
 
+    flush_pending_barriers();
+
+    /* All state bound to the primary command buffer is undefined after vkCmdExecuteCommands() */
+    m_bound_state.clear();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        Anvil::Vulkan::vkCmdExecuteCommands(m_command_buffer,
-                                            in_cmd_buffers_count,
-                                            (in_cmd_buffers_count > 0) ? &cmd_buffers.at(0) : nullptr);
+        m_n_recorded_commands++;
+
+        m_device_ptr->get_dispatch_table().vkCmdExecuteCommands(m_command_buffer,
+                                                                in_cmd_buffers_count,
+                                                                (in_cmd_buffers_count > 0) ? &cmd_buffers.at(0) : nullptr);
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -4778,16 +9287,18 @@ bool Anvil::PrimaryCommandBuffer::record_next_subpass_internal(const bool&
         {
             if (in_use_khr_create_rp2_extension)
             {
-                m_commands.push_back(NextSubpass2KHRCommand(in_contents) );
+                m_commands.push_back(m_command_arena.create<NextSubpass2KHRCommand>(in_contents) );
             }
             else
             {
-                m_commands.push_back(NextSubpassCommand(in_contents) );
+                m_commands.push_back(m_command_arena.create<NextSubpassCommand>(in_contents) );
             }
         }
     }
     #endif
 
+    flush_pending_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -4804,14 +9315,18 @@ bool Anvil::PrimaryCommandBuffer::record_next_subpass_internal(const bool&
             subpass_end_info.pNext = nullptr;
             subpass_end_info.sType = VK_STRUCTURE_TYPE_SUBPASS_END_INFO_KHR;
 
+            m_n_recorded_commands++;
+
             crp2_entrypoints.vkCmdNextSubpass2KHR(m_command_buffer,
                                                  &subpass_begin_info,
                                                  &subpass_end_info);
         }
         else
         {
-            Anvil::Vulkan::vkCmdNextSubpass(m_command_buffer,
-                                            static_cast<VkSubpassContents>(in_contents) );
+            m_n_recorded_commands++;
+
+            m_device_ptr->get_dispatch_table().vkCmdNextSubpass(m_command_buffer,
+                                                                static_cast<VkSubpassContents>(in_contents) );
         }
     }
     unlock();
@@ -4822,15 +9337,23 @@ end:
     return result;
 }
 
+/* Please see header for specification */
+void Anvil::PrimaryCommandBuffer::set_pipeline_statistics_profiler(Anvil::PipelineStatisticsProfiler* in_opt_profiler_ptr)
+{
+    anvil_assert(!m_is_renderpass_active);
+
+    m_pipeline_statistics_profiler_ptr = in_opt_profiler_ptr;
+}
+
 /* Please see header for specification */
 bool Anvil::PrimaryCommandBuffer::start_recording(bool                                in_one_time_submit,
                                                   bool                                in_simultaneous_use_allowed,
                                                   uint32_t                            in_opt_device_mask)
 {
-    const Anvil::DeviceType                        device_type    (m_device_ptr->get_type() );
-    bool                                           result         (false);
-    VkResult                                       result_vk;
-    Anvil::StructChainer<VkCommandBufferBeginInfo> struct_chainer;
+    const Anvil::DeviceType                                   device_type    (m_device_ptr->get_type() );
+    bool                                                      result         (false);
+    VkResult                                                  result_vk;
+    Anvil::InlineStructChainer<VkCommandBufferBeginInfo, 128> struct_chainer;
 
     if (m_recording_in_progress)
     {
@@ -4877,10 +9400,8 @@ bool Anvil::PrimaryCommandBuffer::start_recording(bool
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        auto chain_ptr = struct_chainer.create_chain();
-
-        result_vk = Anvil::Vulkan::vkBeginCommandBuffer(m_command_buffer,
-                                                        chain_ptr->get_root_struct() );
+        result_vk = m_device_ptr->get_dispatch_table().vkBeginCommandBuffer(m_command_buffer,
+                                                                            struct_chainer.get_root_struct() );
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -4899,6 +9420,15 @@ bool Anvil::PrimaryCommandBuffer::start_recording(bool
     }
     #endif
 
+    m_bound_state.clear     ();
+    m_pending_barriers.clear();
+
+    m_n_filtered_state_calls    = 0;
+    m_n_recorded_commands       = 0;
+    m_n_recorded_pipeline_binds = 0;
+
+    m_parent_command_pool_ptr->on_command_buffer_recording_started();
+
     m_device_mask           = in_opt_device_mask;
     m_recording_in_progress = true;
     result                  = true;
@@ -4930,9 +9460,9 @@ Anvil::SecondaryCommandBuffer::SecondaryCommandBuffer(const Anvil::BaseDevice* i
 
     in_parent_command_pool_ptr->lock();
     {
-        result_vk = Anvil::Vulkan::vkAllocateCommandBuffers(m_device_ptr->get_device_vk(),
-                                                           &command_buffer_alloc_info,
-                                                           &m_command_buffer);
+        result_vk = m_device_ptr->get_dispatch_table().vkAllocateCommandBuffers(m_device_ptr->get_device_vk(),
+                                                                               &command_buffer_alloc_info,
+                                                                               &m_command_buffer);
     }
     in_parent_command_pool_ptr->unlock();
 
@@ -4951,11 +9481,11 @@ bool Anvil::SecondaryCommandBuffer::start_recording(bool
                                                     Anvil::QueryPipelineStatisticFlags in_required_pipeline_statistics_scope,
                                                     uint32_t                           in_opt_device_mask)
 {
-    VkCommandBufferInheritanceInfo                 command_buffer_inheritance_info;
-    const Anvil::DeviceType                        device_type                    (m_device_ptr->get_type() );
-    bool                                           result                         (false);
-    VkResult                                       result_vk;
-    Anvil::StructChainer<VkCommandBufferBeginInfo> struct_chainer;
+    VkCommandBufferInheritanceInfo                            command_buffer_inheritance_info;
+    const Anvil::DeviceType                                   device_type                    (m_device_ptr->get_type() );
+    bool                                                      result                         (false);
+    VkResult                                                  result_vk;
+    Anvil::InlineStructChainer<VkCommandBufferBeginInfo, 128> struct_chainer;
 
     if (m_recording_in_progress)
     {
@@ -5013,10 +9543,8 @@ bool Anvil::SecondaryCommandBuffer::start_recording(bool
     m_parent_command_pool_ptr->lock();
     lock();
     {
-        auto chain_ptr = struct_chainer.create_chain();
-
-        result_vk = Anvil::Vulkan::vkBeginCommandBuffer(m_command_buffer,
-                                                        chain_ptr->get_root_struct() );
+        result_vk = m_device_ptr->get_dispatch_table().vkBeginCommandBuffer(m_command_buffer,
+                                                                            struct_chainer.get_root_struct() );
     }
     unlock();
     m_parent_command_pool_ptr->unlock();
@@ -5035,6 +9563,15 @@ bool Anvil::SecondaryCommandBuffer::start_recording(bool
     }
     #endif
 
+    m_bound_state.clear     ();
+    m_pending_barriers.clear();
+
+    m_n_filtered_state_calls    = 0;
+    m_n_recorded_commands       = 0;
+    m_n_recorded_pipeline_binds = 0;
+
+    m_parent_command_pool_ptr->on_command_buffer_recording_started();
+
     m_is_renderpass_active  = in_renderpass_usage_only;
     m_recording_in_progress = true;
     result                  = true;
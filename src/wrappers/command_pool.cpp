@@ -41,7 +41,16 @@ Anvil::CommandPool::CommandPool(Anvil::BaseDevice*                   in_device_p
      m_command_pool            (VK_NULL_HANDLE),
      m_create_flags            (in_create_flags),
      m_device_ptr              (in_device_ptr),
-     m_queue_family_index      (in_queue_family_index)
+     m_queue_family_index      (in_queue_family_index),
+     m_n_live_command_buffers  (0),
+     m_n_recordings_this_frame (0),
+     m_n_frames                (0),
+     m_n_frames_since_trim     (0),
+     m_n_trims                 (0),
+     m_peak_usage_since_trim   (0),
+     m_trim_n_window_frames    (0),
+     m_trim_usage_ratio        (1.0f),
+     m_usage_history_next_index(0)
 {
     VkCommandPoolCreateInfo command_pool_create_info;
     VkResult                result_vk               (VK_ERROR_INITIALIZATION_FAILED);
@@ -54,10 +63,10 @@ Anvil::CommandPool::CommandPool(Anvil::BaseDevice*                   in_device_p
     command_pool_create_info.queueFamilyIndex = in_queue_family_index;
     command_pool_create_info.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
 
-    result_vk = Anvil::Vulkan::vkCreateCommandPool(in_device_ptr->get_device_vk(),
-                                                  &command_pool_create_info,
-                                                   nullptr, /* pAllocator */
-                                                  &m_command_pool);
+    result_vk = in_device_ptr->get_dispatch_table().vkCreateCommandPool(in_device_ptr->get_device_vk(),
+                                                                       &command_pool_create_info,
+                                                                        in_device_ptr->get_allocation_callbacks_vk(),
+                                                                       &m_command_pool);
 
     anvil_assert_vk_call_succeeded(result_vk);
     if (is_vk_call_successful(result_vk) )
@@ -65,6 +74,9 @@ Anvil::CommandPool::CommandPool(Anvil::BaseDevice*                   in_device_p
         set_vk_handle(m_command_pool);
     }
 
+    set_trim_policy(60,    /* in_n_window_frames */
+                    0.5f); /* in_usage_ratio     */
+
     /* Register the command pool instance */
     Anvil::ObjectTracker::get()->register_object(Anvil::ObjectType::COMMAND_POOL,
                                                  this);
@@ -82,9 +94,9 @@ Anvil::CommandPool::~CommandPool()
     {
         lock();
         {
-            Anvil::Vulkan::vkDestroyCommandPool(m_device_ptr->get_device_vk(),
-                                                m_command_pool,
-                                                nullptr /* pAllocator */);
+            m_device_ptr->get_dispatch_table().vkDestroyCommandPool(m_device_ptr->get_device_vk(),
+                                                                    m_command_pool,
+                                                                    m_device_ptr->get_allocation_callbacks_vk() );
         }
         unlock();
 
@@ -143,6 +155,98 @@ Anvil::CommandPoolUniquePtr Anvil::CommandPool::create(Anvil::BaseDevice*
     return result_ptr;
 }
 
+/* Please see header for specification */
+Anvil::CommandPoolStats Anvil::CommandPool::get_stats() const
+{
+    Anvil::CommandPoolStats result;
+
+    result.n_frames                     = m_n_frames;
+    result.n_live_command_buffers       = m_n_live_command_buffers.load();
+    result.n_recordings_peak_since_trim = m_peak_usage_since_trim;
+    result.n_trims                      = m_n_trims;
+    result.queue_family_index           = m_queue_family_index;
+
+    if (m_n_frames > 0)
+    {
+        const uint32_t n_window_frames = static_cast<uint32_t>(m_usage_history.size() );
+        const uint32_t last_index      = (m_usage_history_next_index + n_window_frames - 1) % n_window_frames;
+
+        result.n_recordings_last_frame  = m_usage_history.at(last_index);
+        result.n_recordings_peak_recent = *std::max_element(m_usage_history.begin(),
+                                                            m_usage_history.end  () );
+    }
+
+    return result;
+}
+
+/* Please see header for specification */
+void Anvil::CommandPool::on_command_buffer_allocated()
+{
+    ++m_n_live_command_buffers;
+}
+
+/* Please see header for specification */
+void Anvil::CommandPool::on_command_buffer_recording_started()
+{
+    ++m_n_recordings_this_frame;
+}
+
+/* Please see header for specification */
+void Anvil::CommandPool::on_command_buffer_released()
+{
+    anvil_assert(m_n_live_command_buffers > 0);
+
+    --m_n_live_command_buffers;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandPool::on_frame_end()
+{
+    const uint32_t frame_usage = m_n_recordings_this_frame.exchange(0);
+    uint32_t       recent_peak = 0;
+    bool           result      = false;
+
+    m_usage_history.at(m_usage_history_next_index) = frame_usage;
+    m_usage_history_next_index                     = (m_usage_history_next_index + 1) % static_cast<uint32_t>(m_usage_history.size() );
+
+    m_peak_usage_since_trim = std::max(m_peak_usage_since_trim,
+                                       frame_usage);
+
+    ++m_n_frames;
+    ++m_n_frames_since_trim;
+
+    if (m_trim_n_window_frames == 0                    ||
+        m_n_frames_since_trim  <  m_trim_n_window_frames)
+    {
+        goto end;
+    }
+
+    if (!m_device_ptr->get_extension_info()->khr_maintenance1() )
+    {
+        goto end;
+    }
+
+    recent_peak = *std::max_element(m_usage_history.begin(),
+                                    m_usage_history.end  () );
+
+    if (static_cast<float>(recent_peak) >= m_trim_usage_ratio * static_cast<float>(m_peak_usage_since_trim) )
+    {
+        goto end;
+    }
+
+    /* Usage has dropped well below what the pool has been sized for. Return the excess memory to the system. */
+    trim();
+
+    m_n_frames_since_trim   = 0;
+    m_peak_usage_since_trim = recent_peak;
+
+    ++m_n_trims;
+
+    result = true;
+end:
+    return result;
+}
+
 /* Please see header for specification */
 bool Anvil::CommandPool::reset(bool in_release_resources)
 {
@@ -151,9 +255,9 @@ bool Anvil::CommandPool::reset(bool in_release_resources)
 
     lock();
     {
-        result_vk = Anvil::Vulkan::vkResetCommandPool(m_device_ptr->get_device_vk(),
-                                                      m_command_pool,
-                                                      ((in_release_resources) ? VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT : 0u) );
+        result_vk = m_device_ptr->get_dispatch_table().vkResetCommandPool(m_device_ptr->get_device_vk(),
+                                                                          m_command_pool,
+                                                                          ((in_release_resources) ? VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT : 0u) );
     }
     unlock();
 
@@ -179,4 +283,21 @@ void Anvil::CommandPool::trim()
     {
         anvil_assert(m_device_ptr->get_extension_info()->khr_maintenance1() );
     }
-}
\ No newline at end of file
+}
+
+/* Please see header for specification */
+void Anvil::CommandPool::set_trim_policy(uint32_t in_n_window_frames,
+                                         float    in_usage_ratio)
+{
+    anvil_assert(in_usage_ratio > 0.0f && in_usage_ratio <= 1.0f);
+
+    m_trim_n_window_frames = in_n_window_frames;
+    m_trim_usage_ratio     = in_usage_ratio;
+
+    /* Keep at least one slot around, so that get_stats() can report last frame's usage even with trimming disabled. */
+    m_usage_history.assign(std::max(in_n_window_frames, 1u),
+                           0u);
+
+    m_n_frames_since_trim      = 0;
+    m_usage_history_next_index = 0;
+}
@@ -53,31 +53,36 @@ Anvil::ComputePipelineManager::~ComputePipelineManager()
     Anvil::ObjectTracker::get()->unregister_object(Anvil::ObjectType::ANVIL_COMPUTE_PIPELINE_MANAGER,
                                                     this);
 
+    set_async_compilation_enabled(false);
+
     m_baked_pipelines.clear      ();
     m_outstanding_pipelines.clear();
 }
 
-/** Re-creates Vulkan compute pipeline objects for all added non-proxy pipelines marked
- *  as dirty. A new compute pipeline layout object may, but does not have to, be also
- *  created implicitly by calling this function.
+/** Re-creates Vulkan compute pipeline objects for all non-proxy pipelines held by
+ *  @param inout_pipelines_ptr. A new compute pipeline layout object may, but does not have to,
+ *  be also created implicitly by calling this function.
  *
  *  @return true if the function was successful, false otherwise.
  **/
-bool Anvil::ComputePipelineManager::bake()
+bool Anvil::ComputePipelineManager::bake_pipelines(Pipelines* inout_pipelines_ptr)
 {
     typedef struct BakeItem
     {
-        VkComputePipelineCreateInfo create_info;
-        PipelineID                  pipeline_id;
-        Pipeline*                   pipeline_ptr;
+        VkComputePipelineCreateInfo    create_info;
+        const CreationFeedbackStorage* creation_feedback_ptr;
+        PipelineID                     pipeline_id;
+        Pipeline*                      pipeline_ptr;
 
         BakeItem(const VkComputePipelineCreateInfo& in_create_info,
+                 const CreationFeedbackStorage*     in_creation_feedback_ptr,
                  PipelineID                         in_pipeline_id,
                  Pipeline*                          in_pipeline_ptr)
         {
-            create_info  = in_create_info;
-            pipeline_id  = in_pipeline_id;
-            pipeline_ptr = in_pipeline_ptr;
+            create_info           = in_create_info;
+            creation_feedback_ptr = in_creation_feedback_ptr;
+            pipeline_id           = in_pipeline_id;
+            pipeline_ptr          = in_pipeline_ptr;
         }
 
         bool operator==(const PipelineID& in_pipeline_id) const
@@ -86,32 +91,36 @@ bool Anvil::ComputePipelineManager::bake()
         }
     } BakeItem;
 
-    std::map<VkPipelineLayout, std::vector<BakeItem> > layout_to_bake_item_map;
-    std::unique_lock<std::recursive_mutex>             mutex_lock;
-    auto                                               mutex_ptr                    (get_mutex() );
-    uint32_t                                           n_current_pipeline           (0);
-    std::vector<VkComputePipelineCreateInfo>           pipeline_create_info_items_vk;
-    bool                                               result                       (false);
-    std::vector<VkPipeline>                            result_pipeline_items_vk;
-    VkResult                                           result_vk;
+    bool                                                   can_be_split                 (true);
+    std::vector<std::unique_ptr<CreationFeedbackStorage> > creation_feedback_storages;
+    std::map<VkPipelineLayout, std::vector<BakeItem> >     layout_to_bake_item_map;
+    std::unique_lock<Anvil::RecursiveSpinLock>             mutex_lock;
+    auto                                                   mutex_ptr                    (get_mutex() );
+    uint32_t                                               n_current_pipeline           (0);
+    std::vector<VkComputePipelineCreateInfo>               pipeline_create_info_items_vk;
+    bool                                                   result                       (false);
+    std::vector<VkPipeline>                                result_pipeline_items_vk;
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
         );
     }
 
-    std::vector<std::vector<VkSpecializationMapEntry> > specialization_map_entries_vk(m_outstanding_pipelines.size() );
-    std::vector<VkSpecializationInfo>                   specialization_info_vk       (m_outstanding_pipelines.size());
+    std::vector<const VkSpecializationInfo*> specialization_info_vk_ptrs(inout_pipelines_ptr->size(),
+                                                                         nullptr);
+
+    /* Sized up-front, so that the stage create info structs can point into the vector */
+    std::vector<VkPipelineShaderStageRequiredSubgroupSizeCreateInfoEXT> required_subgroup_size_infos_vk(inout_pipelines_ptr->size() );
 
-    for (auto pipeline_iterator  = m_outstanding_pipelines.begin();
-              pipeline_iterator != m_outstanding_pipelines.end();
+    for (auto pipeline_iterator  = inout_pipelines_ptr->begin();
+              pipeline_iterator != inout_pipelines_ptr->end();
             ++pipeline_iterator, ++n_current_pipeline)
     {
         auto                                      current_pipeline_id                      = pipeline_iterator->first;
         Pipeline*                                 current_pipeline_ptr                     = pipeline_iterator->second.get();
-        const auto                                current_pipeline_create_info_ptr         = current_pipeline_ptr->pipeline_create_info_ptr.get();
+        const auto                                current_pipeline_create_info_ptr         = dynamic_cast<const ComputePipelineCreateInfo*>(current_pipeline_ptr->pipeline_create_info_ptr.get() );
         VkComputePipelineCreateInfo               pipeline_create_info;
         const Anvil::ShaderModuleStageEntryPoint* shader_stage_entry_point_ptr             = nullptr;
         const unsigned char*                      specialization_constants_data_buffer_ptr = nullptr;
@@ -132,10 +141,8 @@ bool Anvil::ComputePipelineManager::bake()
 
         if (specialization_constants_ptr->size() > 0)
         {
-            bake_specialization_info_vk(*specialization_constants_ptr,
-                                         specialization_constants_data_buffer_ptr,
-                                        &specialization_map_entries_vk[n_current_pipeline],
-                                        &specialization_info_vk       [n_current_pipeline]);
+            specialization_info_vk_ptrs[n_current_pipeline] = bake_specialization_info_vk(*specialization_constants_ptr,
+                                                                                           specialization_constants_data_buffer_ptr);
         }
 
         /* Prepare the Vulkan create info descriptor & store it in the map for later baking */
@@ -152,7 +159,7 @@ bool Anvil::ComputePipelineManager::bake()
              * 3. The pipeline under specified index uses a different layout. This indicates
              *    a bug in the app or the manager.
              *
-             * NOTE: A slightly adjusted version of this code is re-used in GraphicsPipelineManager::bake() */
+             * NOTE: A slightly adjusted version of this code is re-used in GraphicsPipelineManager::bake_pipelines() */
             auto& pipeline_vector        = layout_to_bake_item_map[pipeline_create_info.layout];
             auto  base_pipeline_id       = current_pipeline_ptr->pipeline_create_info_ptr->get_base_pipeline_id();
             auto  base_pipeline_iterator = std::find(pipeline_vector.begin(),
@@ -201,7 +208,7 @@ bool Anvil::ComputePipelineManager::bake()
         pipeline_create_info.stage.flags               = 0;
         pipeline_create_info.stage.pName               = shader_stage_entry_point_ptr->name.c_str();
         pipeline_create_info.stage.pNext               = nullptr;
-        pipeline_create_info.stage.pSpecializationInfo = (specialization_constants_ptr->size() > 0) ? &specialization_info_vk[n_current_pipeline]
+        pipeline_create_info.stage.pSpecializationInfo = (specialization_constants_ptr->size() > 0) ? specialization_info_vk_ptrs[n_current_pipeline]
                                                                                                     : VK_NULL_HANDLE;
         pipeline_create_info.stage.stage               = VK_SHADER_STAGE_COMPUTE_BIT;
         pipeline_create_info.stage.sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -209,6 +216,33 @@ bool Anvil::ComputePipelineManager::bake()
 
         pipeline_create_info.stage.module = shader_stage_entry_point_ptr->shader_module_ptr->get_module();
 
+        /* Subgroup size control. All of these require VK_EXT_subgroup_size_control. */
+        if (current_pipeline_create_info_ptr->get_required_subgroup_size      () != 0 ||
+            current_pipeline_create_info_ptr->get_require_full_subgroups      ()      ||
+            current_pipeline_create_info_ptr->is_varying_subgroup_size_allowed() )
+        {
+            if (!m_device_ptr->get_extension_info()->ext_subgroup_size_control() )
+            {
+                anvil_assert(m_device_ptr->get_extension_info()->ext_subgroup_size_control() );
+            }
+            else
+            {
+                if (current_pipeline_create_info_ptr->get_required_subgroup_size() != 0)
+                {
+                    auto& required_subgroup_size_info_vk = required_subgroup_size_infos_vk.at(n_current_pipeline);
+
+                    required_subgroup_size_info_vk.pNext                = nullptr;
+                    required_subgroup_size_info_vk.requiredSubgroupSize = current_pipeline_create_info_ptr->get_required_subgroup_size();
+                    required_subgroup_size_info_vk.sType                = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_REQUIRED_SUBGROUP_SIZE_CREATE_INFO_EXT;
+
+                    pipeline_create_info.stage.pNext = &required_subgroup_size_info_vk;
+                }
+
+                pipeline_create_info.stage.flags |= ((current_pipeline_create_info_ptr->is_varying_subgroup_size_allowed() ) ? VK_PIPELINE_SHADER_STAGE_CREATE_ALLOW_VARYING_SUBGROUP_SIZE_BIT_EXT : 0) |
+                                                    ((current_pipeline_create_info_ptr->get_require_full_subgroups      () ) ? VK_PIPELINE_SHADER_STAGE_CREATE_REQUIRE_FULL_SUBGROUPS_BIT_EXT      : 0);
+            }
+        }
+
         anvil_assert(pipeline_create_info.stage.module != VK_NULL_HANDLE);
 
         if (pipeline_create_info.basePipelineHandle != VK_NULL_HANDLE                   ||
@@ -217,15 +251,24 @@ bool Anvil::ComputePipelineManager::bake()
             pipeline_create_info.flags |= VK_PIPELINE_CREATE_DERIVATIVE_BIT;
         }
 
-        pipeline_create_info.flags |= ((current_pipeline_create_info_ptr->allows_derivatives        () ) ? VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT    : 0) |
-                                      ((current_pipeline_create_info_ptr->has_optimizations_disabled() ) ? VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT : 0);
+        pipeline_create_info.flags |= ((current_pipeline_create_info_ptr->allows_derivatives        () ) ? VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT      : 0) |
+                                      ((current_pipeline_create_info_ptr->captures_statistics       () ) ? VK_PIPELINE_CREATE_CAPTURE_STATISTICS_BIT_KHR : 0) |
+                                      ((current_pipeline_create_info_ptr->has_optimizations_disabled() ) ? VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT   : 0);
 
         if (m_device_ptr->get_type() == Anvil::DeviceType::MULTI_GPU)
         {
             pipeline_create_info.flags |= VK_PIPELINE_CREATE_DISPATCH_BASE_KHR;
         }
 
+        /* Ask the driver to report how long it took to create the pipeline, and whether the pipeline cache has been hit */
+        creation_feedback_storages.push_back(
+            chain_creation_feedback(1, /* in_n_stages */
+                                   &pipeline_create_info.stage,
+                                   &pipeline_create_info.pNext)
+        );
+
         layout_to_bake_item_map[pipeline_create_info.layout].push_back(BakeItem(pipeline_create_info,
+                                                                                creation_feedback_storages.back().get(),
                                                                                 current_pipeline_id,
                                                                                 current_pipeline_ptr) );
     }
@@ -248,23 +291,38 @@ bool Anvil::ComputePipelineManager::bake()
             pipeline_create_info_items_vk.push_back(current_bake_item.create_info);
         }
 
-        result_pipeline_items_vk.resize(pipeline_create_info_items_vk.size() );
+        result_pipeline_items_vk.assign(pipeline_create_info_items_vk.size(),
+                                        VK_NULL_HANDLE);
+
+        /* Pipelines which refer to their base pipeline by index must be baked with a single call. */
+        can_be_split = true;
 
-        m_pipeline_cache_ptr->lock();
+        for (const auto& current_create_info : pipeline_create_info_items_vk)
         {
-            result_vk = Anvil::Vulkan::vkCreateComputePipelines(m_device_ptr->get_device_vk(),
-                                                                m_pipeline_cache_ptr->get_pipeline_cache(),
-                                                                static_cast<uint32_t>(pipeline_create_info_items_vk.size() ),
-                                                               &pipeline_create_info_items_vk[0],
-                                                                nullptr, /* pAllocator */
-                                                               &result_pipeline_items_vk[0]);
+            if (current_create_info.basePipelineIndex != static_cast<int32_t>(UINT32_MAX) )
+            {
+                can_be_split = false;
+
+                break;
+            }
         }
-        m_pipeline_cache_ptr->unlock();
 
-        if (!is_vk_call_successful(result_vk))
+        if (!create_pipelines(static_cast<uint32_t>(pipeline_create_info_items_vk.size() ),
+                              can_be_split,
+                              [this, &pipeline_create_info_items_vk](VkPipelineCache in_pipeline_cache,
+                                                                     uint32_t        in_n_first_pipeline,
+                                                                     uint32_t        in_n_pipelines,
+                                                                     VkPipeline*     out_pipelines_ptr)
+                              {
+                                  return m_device_ptr->get_dispatch_table().vkCreateComputePipelines(m_device_ptr->get_device_vk(),
+                                                                                                     in_pipeline_cache,
+                                                                                                     in_n_pipelines,
+                                                                                                    &pipeline_create_info_items_vk.at(in_n_first_pipeline),
+                                                                                                     m_device_ptr->get_allocation_callbacks_vk(),
+                                                                                                     out_pipelines_ptr);
+                              },
+                             &result_pipeline_items_vk.at(0) ))
         {
-            anvil_assert_vk_call_succeeded(result_vk);
-
             goto end;
         }
 
@@ -278,15 +336,18 @@ bool Anvil::ComputePipelineManager::bake()
             anvil_assert(result_pipeline_items_vk[n_current_item]    != VK_NULL_HANDLE);
 
             current_bake_item.pipeline_ptr->baked_pipeline  = result_pipeline_items_vk[n_current_item];
+
+            store_creation_feedback(current_bake_item.creation_feedback_ptr,
+                                    current_bake_item.pipeline_ptr);
         }
     }
 
-    for (auto& current_baked_pipeline : m_outstanding_pipelines)
+    for (auto& current_baked_pipeline : *inout_pipelines_ptr)
     {
         m_baked_pipelines[current_baked_pipeline.first] = std::move(current_baked_pipeline.second);
     }
 
-    m_outstanding_pipelines.clear();
+    inout_pipelines_ptr->clear();
 
     /* All done */
     result = true;
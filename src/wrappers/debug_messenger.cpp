@@ -24,17 +24,85 @@
 #include "wrappers/debug_messenger.h"
 #include "wrappers/instance.h"
 
+
+namespace
+{
+    /* Number of entries in the rate limiting table. Must be a power of two. */
+    const uint32_t N_RATE_LIMIT_ENTRIES      = 256;
+    const uint32_t N_RATE_LIMIT_ENTRIES_LOG2 = 8;
+
+    /* Copies labels reported by the implementation, so that they can be accessed after the call-back returns. */
+    void copy_debug_labels(uint32_t                        in_n_labels,
+                           const VkDebugUtilsLabelEXT*     in_labels_ptr,
+                           std::vector<Anvil::DebugLabel>* out_labels_ptr,
+                           std::vector<std::string>*       out_label_names_ptr)
+    {
+        out_labels_ptr->resize     (in_n_labels);
+        out_label_names_ptr->resize(in_n_labels);
+
+        for (uint32_t n_label = 0;
+                      n_label < in_n_labels;
+                    ++n_label)
+        {
+            out_labels_ptr->at(n_label) = Anvil::DebugLabel(in_labels_ptr[n_label]);
+
+            if (in_labels_ptr[n_label].pLabelName != nullptr)
+            {
+                out_label_names_ptr->at(n_label) = in_labels_ptr[n_label].pLabelName;
+            }
+        }
+    }
+}
+
+
 Anvil::DebugMessenger::DebugMessenger(const DebugAPI&                          in_debug_api,
                                       Anvil::DebugMessengerCreateInfoUniquePtr in_create_info_ptr)
-    :MTSafetySupportProvider       (in_create_info_ptr->get_instance_ptr()->is_mt_safe() ),
-     m_debug_api                   (in_debug_api),
-     m_debug_callback              (VK_NULL_HANDLE),
-     m_messenger                   (VK_NULL_HANDLE)
+    :MTSafetySupportProvider(in_create_info_ptr->get_instance_ptr()->is_mt_safe() ),
+     m_debug_api            (in_debug_api),
+     m_n_dropped_messages   (0),
+     m_async_ring_mask      (0),
+     m_dequeue_pos          (0),
+     m_enqueue_pos          (0),
+     m_is_thread_sleeping   (false),
+     m_should_quit          (false),
+     m_debug_callback       (VK_NULL_HANDLE),
+     m_messenger            (VK_NULL_HANDLE)
 {
-    auto instance_ptr = in_create_info_ptr->get_instance_ptr();
+    auto     instance_ptr            = in_create_info_ptr->get_instance_ptr();
+    uint32_t rate_limit_max_messages = 0;
+    uint32_t rate_limit_period_msec  = 0;
 
     m_create_info_ptr = std::move(in_create_info_ptr);
 
+    instance_ptr->m_n_active_debug_messengers.fetch_add(1);
+
+    m_create_info_ptr->get_rate_limit(&rate_limit_max_messages,
+                                      &rate_limit_period_msec);
+
+    if (rate_limit_max_messages > 0)
+    {
+        std::vector<RateLimitEntry>(N_RATE_LIMIT_ENTRIES).swap(m_rate_limit_entries);
+    }
+
+    /* Spawn the delivery thread before the messenger starts receiving messages */
+    if (m_create_info_ptr->is_async_delivery_enabled() )
+    {
+        const uint32_t n_ring_slots = m_create_info_ptr->get_async_delivery_ring_size();
+
+        std::vector<AsyncMessage>(n_ring_slots).swap(m_async_ring);
+
+        for (uint32_t n_slot = 0;
+                      n_slot < n_ring_slots;
+                    ++n_slot)
+        {
+            m_async_ring.at(n_slot).sequence.store(n_slot);
+        }
+
+        m_async_ring_mask = n_ring_slots - 1;
+        m_delivery_thread = std::thread(&Anvil::DebugMessenger::delivery_thread_main,
+                                        this);
+    }
+
     switch (m_debug_api)
     {
         case DebugAPI::EXT_DEBUG_REPORT:
@@ -51,7 +119,7 @@ Anvil::DebugMessenger::DebugMessenger(const DebugAPI&                          i
 
             result_vk = entrypoints.vkCreateDebugReportCallbackEXT(instance_ptr->get_instance_vk(),
                                                                   &create_info,
-                                                                   nullptr, /* pAllocator */
+                                                                   instance_ptr->get_allocation_callbacks_vk(),
                                                                   &m_debug_callback);
 
             anvil_assert_vk_call_succeeded(result_vk);
@@ -76,7 +144,7 @@ Anvil::DebugMessenger::DebugMessenger(const DebugAPI&                          i
 
             result_vk = entrypoints.vkCreateDebugUtilsMessengerEXT(instance_ptr->get_instance_vk(),
                                                                   &create_info,
-                                                                   nullptr, /* pAllocator */
+                                                                   instance_ptr->get_allocation_callbacks_vk(),
                                                                   &m_messenger);
 
             anvil_assert_vk_call_succeeded(result_vk);
@@ -106,7 +174,7 @@ Anvil::DebugMessenger::~DebugMessenger()
             {
                 entrypoints.vkDestroyDebugReportCallbackEXT(instance_ptr->get_instance_vk(),
                                                             m_debug_callback,
-                                                            nullptr); /* pAllocator */
+                                                            instance_ptr->get_allocation_callbacks_vk() );
             }
 
             break;
@@ -120,7 +188,7 @@ Anvil::DebugMessenger::~DebugMessenger()
             {
                 entrypoints.vkDestroyDebugUtilsMessengerEXT(instance_ptr->get_instance_vk(),
                                                             m_messenger,
-                                                            nullptr); /* pAllocator */
+                                                            instance_ptr->get_allocation_callbacks_vk() );
             }
 
             break;
@@ -131,6 +199,69 @@ Anvil::DebugMessenger::~DebugMessenger()
             anvil_assert_fail();
         }
     }
+
+    /* No more messages can arrive at this point. Let the delivery thread drain the ring before it quits. */
+    if (m_delivery_thread.joinable() )
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_wake_mutex);
+
+            m_should_quit.store(true);
+            m_wake_cv.notify_one();
+        }
+
+        m_delivery_thread.join();
+    }
+
+    instance_ptr->m_n_active_debug_messengers.fetch_sub(1);
+}
+
+/** Reserves the next slot of the asynchronous delivery ring for writing.
+ *
+ *  @param out_pos_ptr Deref will be set to the position of the slot. Must not be null.
+ *
+ *  @return Slot to write the message to, or nullptr if the ring is full. In the latter case, the message
+ *          is counted as dropped.
+ */
+Anvil::DebugMessenger::AsyncMessage* Anvil::DebugMessenger::acquire_async_message(uint64_t* out_pos_ptr)
+{
+    uint64_t      pos        = m_enqueue_pos.load(std::memory_order_relaxed);
+    AsyncMessage* result_ptr = nullptr;
+
+    while (true)
+    {
+        AsyncMessage*  message_ptr = &m_async_ring.at(static_cast<size_t>(pos & m_async_ring_mask) );
+        const uint64_t sequence    = message_ptr->sequence.load(std::memory_order_acquire);
+        const int64_t  diff        = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+
+        if (diff == 0)
+        {
+            if (m_enqueue_pos.compare_exchange_weak(pos,
+                                                    pos + 1,
+                                                    std::memory_order_relaxed) )
+            {
+                result_ptr = message_ptr;
+
+                break;
+            }
+        }
+        else
+        if (diff < 0)
+        {
+            /* The ring is full. Drop the message, rather than stall the thread which triggered it. */
+            m_n_dropped_messages.fetch_add(1);
+
+            break;
+        }
+        else
+        {
+            pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    *out_pos_ptr = pos;
+
+    return result_ptr;
 }
 
 VkBool32 VKAPI_PTR Anvil::DebugMessenger::callback_handler_ext_debug_report(VkDebugReportFlagsEXT      in_flags,
@@ -142,19 +273,54 @@ VkBool32 VKAPI_PTR Anvil::DebugMessenger::callback_handler_ext_debug_report(VkDe
                                                                             const char*                in_message_ptr,
                                                                             void*                      in_user_data_ptr)
 {
-    auto                   objects         = std::vector<Anvil::DebugObjectNameInfo>(1);
     Anvil::DebugMessenger* this_ptr        = reinterpret_cast<Anvil::DebugMessenger*>(in_user_data_ptr);
     auto                   create_info_ptr = this_ptr->get_create_info_ptr();
+    const auto             object          = Anvil::DebugObjectNameInfo(in_object,
+                                                                        "UNKNOWN", /* in_object_name_ptr */
+                                                                        Anvil::Utils::get_object_type_for_vk_debug_report_object_type(in_object_type) );
+    const auto             severity        = static_cast<Anvil::DebugMessageSeverityFlagBits>(get_debug_message_severity_flags_for_debug_report_flags(in_flags).get_vk() );
 
     ANVIL_REDUNDANT_ARGUMENT_CONST(in_layer_prefix_ptr);
     ANVIL_REDUNDANT_ARGUMENT_CONST(in_location);
     ANVIL_REDUNDANT_ARGUMENT_CONST(in_location);
 
-    objects.at(0) = Anvil::DebugObjectNameInfo(in_object,
-                                               "UNKNOWN", /* in_object_name_ptr */
-                                               Anvil::Utils::get_object_type_for_vk_debug_report_object_type(in_object_type) );
+    if (!this_ptr->should_deliver_message(in_message_code) )
+    {
+        return VK_FALSE;
+    }
 
-    create_info_ptr->get_callback_function()(static_cast<Anvil::DebugMessageSeverityFlagBits>(get_debug_message_severity_flags_for_debug_report_flags(in_flags).get_vk() ),
+    if (this_ptr->m_async_ring.size() > 0)
+    {
+        uint64_t      pos         = 0;
+        AsyncMessage* message_ptr = this_ptr->acquire_async_message(&pos);
+
+        if (message_ptr != nullptr)
+        {
+            message_ptr->cmd_buffer_labels.clear();
+            message_ptr->queue_labels.clear     ();
+
+            message_ptr->objects.assign     (1, /* n */
+                                             object);
+            message_ptr->object_names.assign(1, /* n */
+                                             object.object_name_ptr);
+
+            message_ptr->message                   = (in_message_ptr != nullptr) ? in_message_ptr : "";
+            message_ptr->message_id                = in_message_code;
+            message_ptr->message_id_name_specified = false;
+            message_ptr->severity                  = severity;
+            message_ptr->types                     = create_info_ptr->get_debug_message_types();
+
+            this_ptr->publish_async_message(message_ptr,
+                                            pos);
+        }
+
+        return VK_FALSE;
+    }
+
+    auto objects = std::vector<Anvil::DebugObjectNameInfo>(1,
+                                                           object);
+
+    create_info_ptr->get_callback_function()(severity,
                                              create_info_ptr->get_debug_message_types(),
                                              nullptr, /* in_opt_message_id_name_ptr */
                                              in_message_code,
@@ -171,10 +337,62 @@ VkBool32 VKAPI_PTR Anvil::DebugMessenger::callback_handler_ext_debug_utils(VkDeb
                                                                            const VkDebugUtilsMessengerCallbackDataEXT* in_callback_data_ptr,
                                                                            void*                                       in_user_data_ptr)
 {
-    auto                   cmd_buffer_labels = std::vector<Anvil::DebugLabel>          (in_callback_data_ptr->cmdBufLabelCount);
-    auto                   objects           = std::vector<Anvil::DebugObjectNameInfo> (in_callback_data_ptr->objectCount);
-    auto                   queue_labels      = std::vector<Anvil::DebugLabel>          (in_callback_data_ptr->queueLabelCount);
-    Anvil::DebugMessenger* this_ptr          = reinterpret_cast<Anvil::DebugMessenger*>(in_user_data_ptr);
+    Anvil::DebugMessenger* this_ptr = reinterpret_cast<Anvil::DebugMessenger*>(in_user_data_ptr);
+
+    /* Drop filtered & rate-limited messages before any of the data is gathered */
+    if (!this_ptr->should_deliver_message(in_callback_data_ptr->messageIdNumber) )
+    {
+        return VK_FALSE;
+    }
+
+    if (this_ptr->m_async_ring.size() > 0)
+    {
+        uint64_t      pos         = 0;
+        AsyncMessage* message_ptr = this_ptr->acquire_async_message(&pos);
+
+        if (message_ptr != nullptr)
+        {
+            copy_debug_labels(in_callback_data_ptr->cmdBufLabelCount,
+                              in_callback_data_ptr->pCmdBufLabels,
+                             &message_ptr->cmd_buffer_labels,
+                             &message_ptr->cmd_buffer_label_names);
+            copy_debug_labels(in_callback_data_ptr->queueLabelCount,
+                              in_callback_data_ptr->pQueueLabels,
+                             &message_ptr->queue_labels,
+                             &message_ptr->queue_label_names);
+
+            message_ptr->objects.resize     (in_callback_data_ptr->objectCount);
+            message_ptr->object_names.resize(in_callback_data_ptr->objectCount);
+
+            for (uint32_t n_object = 0;
+                          n_object < in_callback_data_ptr->objectCount;
+                        ++n_object)
+            {
+                message_ptr->objects.at(n_object) = Anvil::DebugObjectNameInfo(in_callback_data_ptr->pObjects[n_object]);
+
+                if (in_callback_data_ptr->pObjects[n_object].pObjectName != nullptr)
+                {
+                    message_ptr->object_names.at(n_object) = in_callback_data_ptr->pObjects[n_object].pObjectName;
+                }
+            }
+
+            message_ptr->message                   = (in_callback_data_ptr->pMessage != nullptr) ? in_callback_data_ptr->pMessage : "";
+            message_ptr->message_id                = in_callback_data_ptr->messageIdNumber;
+            message_ptr->message_id_name_specified = (in_callback_data_ptr->pMessageIdName != nullptr);
+            message_ptr->message_id_name           = (in_callback_data_ptr->pMessageIdName != nullptr) ? in_callback_data_ptr->pMessageIdName : "";
+            message_ptr->severity                  = static_cast<Anvil::DebugMessageSeverityFlagBits>(in_message_severity);
+            message_ptr->types                     = static_cast<Anvil::DebugMessageTypeFlagBits>    (in_message_types);
+
+            this_ptr->publish_async_message(message_ptr,
+                                            pos);
+        }
+
+        return VK_FALSE;
+    }
+
+    auto cmd_buffer_labels = std::vector<Anvil::DebugLabel>         (in_callback_data_ptr->cmdBufLabelCount);
+    auto objects           = std::vector<Anvil::DebugObjectNameInfo>(in_callback_data_ptr->objectCount);
+    auto queue_labels      = std::vector<Anvil::DebugLabel>         (in_callback_data_ptr->queueLabelCount);
 
     for (uint32_t n_cmd_buffer_label = 0;
                   n_cmd_buffer_label < in_callback_data_ptr->cmdBufLabelCount;
@@ -245,6 +463,87 @@ Anvil::DebugMessengerUniquePtr Anvil::DebugMessenger::create(Anvil::DebugMesseng
     return result_ptr;
 }
 
+/** Entry point of the delivery thread. Invokes the callback for all published messages in order, and goes to
+ *  sleep when the ring is empty.
+ */
+void Anvil::DebugMessenger::delivery_thread_main()
+{
+    const auto&    callback_function = m_create_info_ptr->get_callback_function();
+    const uint64_t n_ring_slots      = m_async_ring.size();
+
+    while (true)
+    {
+        AsyncMessage* message_ptr = &m_async_ring.at(static_cast<size_t>(m_dequeue_pos & m_async_ring_mask) );
+
+        if (message_ptr->sequence.load(std::memory_order_acquire) != m_dequeue_pos + 1)
+        {
+            std::unique_lock<std::mutex> lock(m_wake_mutex);
+
+            if (m_should_quit.load() )
+            {
+                break;
+            }
+
+            m_is_thread_sleeping.store(true);
+
+            if (message_ptr->sequence.load() != m_dequeue_pos + 1)
+            {
+                m_wake_cv.wait(lock);
+            }
+
+            m_is_thread_sleeping.store(false);
+
+            continue;
+        }
+
+        /* Redirect name ptrs to the copies owned by the slot */
+        for (uint32_t n_label = 0;
+                      n_label < static_cast<uint32_t>(message_ptr->cmd_buffer_labels.size() );
+                    ++n_label)
+        {
+            if (message_ptr->cmd_buffer_labels.at(n_label).name_ptr != nullptr)
+            {
+                message_ptr->cmd_buffer_labels.at(n_label).name_ptr = message_ptr->cmd_buffer_label_names.at(n_label).c_str();
+            }
+        }
+
+        for (uint32_t n_label = 0;
+                      n_label < static_cast<uint32_t>(message_ptr->queue_labels.size() );
+                    ++n_label)
+        {
+            if (message_ptr->queue_labels.at(n_label).name_ptr != nullptr)
+            {
+                message_ptr->queue_labels.at(n_label).name_ptr = message_ptr->queue_label_names.at(n_label).c_str();
+            }
+        }
+
+        for (uint32_t n_object = 0;
+                      n_object < static_cast<uint32_t>(message_ptr->objects.size() );
+                    ++n_object)
+        {
+            if (message_ptr->objects.at(n_object).object_name_ptr != nullptr)
+            {
+                message_ptr->objects.at(n_object).object_name_ptr = message_ptr->object_names.at(n_object).c_str();
+            }
+        }
+
+        callback_function(message_ptr->severity,
+                          message_ptr->types,
+                          (message_ptr->message_id_name_specified) ? message_ptr->message_id_name.c_str() : nullptr,
+                          message_ptr->message_id,
+                          message_ptr->message.c_str(),
+                          message_ptr->queue_labels,
+                          message_ptr->cmd_buffer_labels,
+                          message_ptr->objects);
+
+        /* Hand the slot back to producers */
+        message_ptr->sequence.store(m_dequeue_pos + n_ring_slots,
+                                    std::memory_order_release);
+
+        ++m_dequeue_pos;
+    }
+}
+
 Anvil::DebugMessageSeverityFlags Anvil::DebugMessenger::get_debug_message_severity_flags_for_debug_report_flags(const VkDebugReportFlagsEXT& in_flags)
 {
     Anvil::DebugMessageSeverityFlags result = Anvil::DebugMessageSeverityFlagBits::NONE;
@@ -417,3 +716,71 @@ void Anvil::DebugMessenger::submit_message(const Anvil::DebugMessageSeverityFlag
         }
     }
 }
+
+/** Makes a slot previously returned by acquire_async_message() visible to the delivery thread, and wakes the
+ *  thread up if it is asleep.
+ */
+void Anvil::DebugMessenger::publish_async_message(AsyncMessage* in_message_ptr,
+                                                  uint64_t      in_pos)
+{
+    in_message_ptr->sequence.store(in_pos + 1);
+
+    if (m_is_thread_sleeping.load() )
+    {
+        std::unique_lock<std::mutex> lock(m_wake_mutex);
+
+        m_wake_cv.notify_one();
+    }
+}
+
+/** Tells if a message of the specified ID should be delivered, taking filtered message IDs and the rate limit
+ *  into account. Updates rate limiting state.
+ */
+bool Anvil::DebugMessenger::should_deliver_message(int32_t in_message_id)
+{
+    const auto& filtered_message_ids = m_create_info_ptr->get_filtered_message_ids();
+    bool        result               = false;
+
+    if (filtered_message_ids.size() > 0                    &&
+        std::binary_search(filtered_message_ids.begin(),
+                           filtered_message_ids.end  (),
+                           in_message_id) )
+    {
+        goto end;
+    }
+
+    if (m_rate_limit_entries.size() > 0)
+    {
+        uint32_t max_messages_per_id = 0;
+        uint32_t period_msec         = 0;
+
+        m_create_info_ptr->get_rate_limit(&max_messages_per_id,
+                                          &period_msec);
+
+        /* Fibonacci hashing spreads consecutive IDs across the table */
+        auto&          entry             = m_rate_limit_entries.at((static_cast<uint32_t>(in_message_id) * 2654435769u) >> (32 - N_RATE_LIMIT_ENTRIES_LOG2) );
+        const uint64_t time_msec         = m_time.get_time_in_msec();
+        uint64_t       period_start_msec = entry.period_start_msec.load();
+
+        if (time_msec - period_start_msec >= period_msec)
+        {
+            /* Only one of the threads which race to start a new period resets the counter */
+            if (entry.period_start_msec.compare_exchange_strong(period_start_msec,
+                                                                time_msec) )
+            {
+                entry.n_messages.store(0);
+            }
+        }
+
+        if (entry.n_messages.fetch_add(1) >= max_messages_per_id)
+        {
+            m_n_dropped_messages.fetch_add(1);
+
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
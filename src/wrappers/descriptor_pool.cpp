@@ -22,6 +22,7 @@
 
 #include "misc/debug.h"
 #include "misc/descriptor_pool_create_info.h"
+#include "misc/descriptor_pool_sizing_profile.h"
 #include "misc/descriptor_set_create_info.h"
 #include "misc/object_tracker.h"
 #include "misc/struct_chainer.h"
@@ -29,6 +30,7 @@
 #include "wrappers/descriptor_set.h"
 #include "wrappers/descriptor_set_layout.h"
 #include "wrappers/device.h"
+#include <algorithm>
 
 
 /* Please see header for specification */
@@ -58,9 +60,9 @@ Anvil::DescriptorPool::~DescriptorPool()
     {
         lock();
         {
-            Anvil::Vulkan::vkDestroyDescriptorPool(m_device_ptr->get_device_vk(),
-                                                   m_pool,
-                                                   nullptr /* pAllocator */);
+            m_device_ptr->get_dispatch_table().vkDestroyDescriptorPool(m_device_ptr->get_device_vk(),
+                                                                       m_pool,
+                                                                       m_device_ptr->get_allocation_callbacks_vk() );
         }
         unlock();
 
@@ -126,15 +128,18 @@ bool Anvil::DescriptorPool::alloc_descriptor_sets(uint32_t
                                                   VkResult*                      out_opt_result_ptr)
 {
     const auto&                                       dp_create_flags                              (m_create_info_ptr->get_create_flags() );
+    uint32_t                                          n_sets_to_alloc                              (0);
     bool                                              result                                       (false);
     VkResult                                          result_vk;
     bool                                              should_chain_variable_descriptor_count_struct(false);
+    const bool                                        should_recycle                               (m_create_info_ptr->get_should_recycle_released_sets() );
     Anvil::StructChainer<VkDescriptorSetAllocateInfo> struct_chainer;
     std::vector<uint32_t>                             variable_descriptor_counts;
 
     lock();
     {
-        m_ds_layout_cache.resize(in_n_sets);
+        m_ds_alloc_index_cache.clear();
+        m_ds_layout_cache.clear     ();
 
         for (uint32_t n_set = 0;
                       n_set < in_n_sets;
@@ -144,14 +149,34 @@ bool Anvil::DescriptorPool::alloc_descriptor_sets(uint32_t
             {
                 auto ds_create_info_ptr = in_ds_allocations_ptr[n_set].ds_layout_ptr->get_create_info();
 
+                if (should_recycle &&
+                   !ds_create_info_ptr->contains_variable_descriptor_count_binding() )
+                {
+                    auto released_ds_iterator = m_released_ds_per_layout.find(in_ds_allocations_ptr[n_set].ds_layout_ptr->get_unique_id() );
+
+                    if (released_ds_iterator         != m_released_ds_per_layout.end() &&
+                        !released_ds_iterator->second.empty() )
+                    {
+                        out_descriptor_sets_vk_ptr[n_set] = released_ds_iterator->second.back();
+
+                        released_ds_iterator->second.pop_back();
+
+                        continue;
+                    }
+                }
+
+                Anvil::DescriptorPoolSizingProfile::add_descriptor_set_usage(ds_create_info_ptr,
+                                                                             in_ds_allocations_ptr[n_set].n_variable_descriptor_bindings,
+                                                                            &m_usage);
+
                 if (ds_create_info_ptr->contains_variable_descriptor_count_binding() )
                 {
                     if ((dp_create_flags & Anvil::DescriptorPoolCreateFlagBits::UPDATE_AFTER_BIND_BIT) != 0)
                     {
                         anvil_assert_fail();
 
-                        result = false;
-                        goto end;
+                        result_vk = VK_ERROR_INITIALIZATION_FAILED;
+                        goto unlock_pool;
                     }
 
                     should_chain_variable_descriptor_count_struct = true;
@@ -163,20 +188,50 @@ bool Anvil::DescriptorPool::alloc_descriptor_sets(uint32_t
                     variable_descriptor_counts.push_back(0);
                 }
 
-                m_ds_layout_cache[n_set] = in_ds_allocations_ptr[n_set].ds_layout_ptr->get_layout();
+                m_ds_layout_cache.push_back(in_ds_allocations_ptr[n_set].ds_layout_ptr->get_layout() );
             }
             else
             {
                 /* This is a "gap" set. */
-                m_ds_layout_cache[n_set] = m_device_ptr->get_dummy_descriptor_set_layout()->get_layout();
+                m_ds_layout_cache.push_back(m_device_ptr->get_dummy_descriptor_set_layout()->get_layout() );
+
+                Anvil::DescriptorPoolSizingProfile::add_descriptor_set_usage(m_device_ptr->get_dummy_descriptor_set_layout()->get_create_info(),
+                                                                             0, /* in_n_variable_descriptors */
+                                                                            &m_usage);
+
+                variable_descriptor_counts.push_back(0);
             }
+
+            m_ds_alloc_index_cache.push_back(n_set);
+        }
+
+        n_sets_to_alloc = static_cast<uint32_t>(m_ds_alloc_index_cache.size() );
+
+        /* All sets have been recycled. */
+        if (n_sets_to_alloc == 0)
+        {
+            result_vk = VK_SUCCESS;
+
+            goto unlock_pool;
+        }
+
+        /* Usage is tracked on request, so that requests which do not fit are reflected, too. */
+        m_peak_usage.n_sets = std::max(m_peak_usage.n_sets,
+                                       m_usage.n_sets);
+
+        for (const auto& current_type_usage : m_usage.n_descriptors_per_type)
+        {
+            auto& n_peak_descriptors = m_peak_usage.n_descriptors_per_type[current_type_usage.first];
+
+            n_peak_descriptors = std::max(n_peak_descriptors,
+                                          current_type_usage.second);
         }
 
         {
             VkDescriptorSetAllocateInfo ds_alloc_info;
 
             ds_alloc_info.descriptorPool     = m_pool;
-            ds_alloc_info.descriptorSetCount = in_n_sets;
+            ds_alloc_info.descriptorSetCount = n_sets_to_alloc;
             ds_alloc_info.pNext              = nullptr;
             ds_alloc_info.pSetLayouts        = &m_ds_layout_cache.at(0);
             ds_alloc_info.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
@@ -188,9 +243,9 @@ bool Anvil::DescriptorPool::alloc_descriptor_sets(uint32_t
         {
             VkDescriptorSetVariableDescriptorCountAllocateInfoEXT variable_descriptor_count_struct;
 
-            anvil_assert(variable_descriptor_counts.size() == in_n_sets);
+            anvil_assert(variable_descriptor_counts.size() == n_sets_to_alloc);
 
-            variable_descriptor_count_struct.descriptorSetCount = in_n_sets;
+            variable_descriptor_count_struct.descriptorSetCount = n_sets_to_alloc;
             variable_descriptor_count_struct.pDescriptorCounts  = &variable_descriptor_counts.at(0);
             variable_descriptor_count_struct.pNext              = nullptr;
             variable_descriptor_count_struct.sType              = static_cast<VkStructureType>(VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO_EXT);
@@ -199,13 +254,56 @@ bool Anvil::DescriptorPool::alloc_descriptor_sets(uint32_t
         }
 
         {
-            auto chain_ptr = struct_chainer.create_chain();
+            /* If any of the sets have been recycled, allocate the remaining ones to a scratch array first */
+            VkDescriptorSet* alloc_results_ptr = out_descriptor_sets_vk_ptr;
+            auto             chain_ptr         = struct_chainer.create_chain();
 
-            result_vk = Anvil::Vulkan::vkAllocateDescriptorSets(m_device_ptr->get_device_vk(),
-                                                                chain_ptr->get_root_struct(),
-                                                                out_descriptor_sets_vk_ptr);
+            if (n_sets_to_alloc != in_n_sets)
+            {
+                m_ds_alloc_result_cache.resize(n_sets_to_alloc);
+
+                alloc_results_ptr = &m_ds_alloc_result_cache.at(0);
+            }
+
+            result_vk = m_device_ptr->get_dispatch_table().vkAllocateDescriptorSets(m_device_ptr->get_device_vk(),
+                                                                                    chain_ptr->get_root_struct(),
+                                                                                    alloc_results_ptr);
+
+            if (n_sets_to_alloc != in_n_sets)
+            {
+                if (is_vk_call_successful(result_vk) )
+                {
+                    for (uint32_t n_alloced_set = 0;
+                                  n_alloced_set < n_sets_to_alloc;
+                                ++n_alloced_set)
+                    {
+                        out_descriptor_sets_vk_ptr[m_ds_alloc_index_cache.at(n_alloced_set)] = alloc_results_ptr[n_alloced_set];
+                    }
+                }
+                else
+                {
+                    /* Put the recycled sets back on their free lists. */
+                    uint32_t n_alloced_set = 0;
+
+                    for (uint32_t n_set = 0;
+                                  n_set < in_n_sets;
+                                ++n_set)
+                    {
+                        if (n_alloced_set                                < n_sets_to_alloc &&
+                            m_ds_alloc_index_cache.at(n_alloced_set) == n_set)
+                        {
+                            ++n_alloced_set;
+
+                            continue;
+                        }
+
+                        m_released_ds_per_layout[in_ds_allocations_ptr[n_set].ds_layout_ptr->get_unique_id()].push_back(out_descriptor_sets_vk_ptr[n_set]);
+                    }
+                }
+            }
         }
     }
+unlock_pool:
     unlock();
 
     if (out_opt_result_ptr != nullptr)
@@ -214,7 +312,7 @@ bool Anvil::DescriptorPool::alloc_descriptor_sets(uint32_t
     }
 
     result = is_vk_call_successful(result_vk);
-end:
+
     return result;
 }
 
@@ -329,10 +427,10 @@ bool Anvil::DescriptorPool::init()
     {
         auto chain_ptr = struct_chainer.create_chain();
 
-        result_vk = Anvil::Vulkan::vkCreateDescriptorPool(m_device_ptr->get_device_vk(),
-                                                          chain_ptr->get_root_struct (),
-                                                          nullptr, /* pAllocator */
-                                                         &m_pool);
+        result_vk = m_device_ptr->get_dispatch_table().vkCreateDescriptorPool(m_device_ptr->get_device_vk(),
+                                                                              chain_ptr->get_root_struct (),
+                                                                              m_device_ptr->get_allocation_callbacks_vk(),
+                                                                             &m_pool);
     }
 
     anvil_assert_vk_call_succeeded(result_vk);
@@ -352,6 +450,54 @@ end:
     return result;
 }
 
+/* Please see header for specification */
+bool Anvil::DescriptorPool::release_descriptor_sets(uint32_t                in_n_sets,
+                                                    DescriptorSetUniquePtr* in_descriptor_sets_ptr)
+{
+    bool result = false;
+
+    anvil_assert(in_n_sets              == 0 ||
+                 in_descriptor_sets_ptr != nullptr);
+
+    if (!m_create_info_ptr->get_should_recycle_released_sets() )
+    {
+        anvil_assert(m_create_info_ptr->get_should_recycle_released_sets() );
+
+        goto end;
+    }
+
+    lock();
+    {
+        for (uint32_t n_set = 0;
+                      n_set < in_n_sets;
+                    ++n_set)
+        {
+            auto& ds_ptr = in_descriptor_sets_ptr[n_set];
+
+            if (ds_ptr == nullptr)
+            {
+                continue;
+            }
+
+            anvil_assert(ds_ptr->m_parent_pool_ptr == this);
+
+            /* Sets which went out of scope when the pool was last reset must not be reused. */
+            if (!ds_ptr->m_unusable                                                                  &&
+                !ds_ptr->m_layout_ptr->get_create_info()->contains_variable_descriptor_count_binding() )
+            {
+                m_released_ds_per_layout[ds_ptr->m_layout_ptr->get_unique_id()].push_back(ds_ptr->m_descriptor_set);
+            }
+
+            ds_ptr.reset();
+        }
+    }
+    unlock();
+
+    result = true;
+end:
+    return result;
+}
+
 /* Please see header for specification */
 bool Anvil::DescriptorPool::reset()
 {
@@ -362,9 +508,27 @@ bool Anvil::DescriptorPool::reset()
         /* TODO: Host synchronization to VkDescriptorSetObjects alloc'ed from the pool. */
         lock();
         {
-            result_vk = Anvil::Vulkan::vkResetDescriptorPool(m_device_ptr->get_device_vk(),
-                                                             m_pool,
-                                                             0 /* flags */);
+            result_vk = m_device_ptr->get_dispatch_table().vkResetDescriptorPool(m_device_ptr->get_device_vk(),
+                                                                                 m_pool,
+                                                                                 0 /* flags */);
+
+            /* Keep the free lists' storage around, so that steady-state recycling does not allocate. Lists of
+             * layouts which have been released since are dropped, as nothing can be allocated with them anymore. */
+            for (auto free_list_iterator  = m_released_ds_per_layout.begin();
+                      free_list_iterator != m_released_ds_per_layout.end();
+                )
+            {
+                if (!Anvil::DescriptorSetLayout::is_unique_id_live(free_list_iterator->first) )
+                {
+                    free_list_iterator = m_released_ds_per_layout.erase(free_list_iterator);
+                }
+                else
+                {
+                    free_list_iterator->second.clear();
+
+                    ++free_list_iterator;
+                }
+            }
         }
         unlock();
 
@@ -376,6 +540,8 @@ bool Anvil::DescriptorPool::reset()
              * wrapper instances can mark themselves as unusable */
             OnDescriptorPoolResetCallbackArgument callback_argument(this);
 
+            m_usage = Anvil::DescriptorPoolUsage();
+
             callback(DESCRIPTOR_POOL_CALLBACK_ID_POOL_RESET,
                     &callback_argument);
         }
@@ -24,6 +24,10 @@
 #include "misc/debug.h"
 #include "misc/descriptor_set_create_info.h"
 #include "misc/object_tracker.h"
+#include "misc/perf_counters.h"
+#include "misc/sampler_create_info.h"
+#include "misc/time.h"
+#include "misc/tracing.h"
 #include "wrappers/buffer.h"
 #include "wrappers/buffer_view.h"
 #include "wrappers/descriptor_pool.h"
@@ -33,6 +37,8 @@
 #include "wrappers/device.h"
 #include "wrappers/image_view.h"
 #include "wrappers/sampler.h"
+#include <algorithm>
+#include <functional>
 
 #ifdef max
     #undef max
@@ -292,6 +298,14 @@ Anvil::DescriptorSet::DescriptorSet(const Anvil::BaseDevice*          in_device_
 /** Please see header for specification */
 Anvil::DescriptorSet::~DescriptorSet()
 {
+    /* Parent pool may outlive this instance and be reset again later on */
+    m_parent_pool_ptr->unregister_from_callbacks(
+        Anvil::DESCRIPTOR_POOL_CALLBACK_ID_POOL_RESET,
+        std::bind(&DescriptorSet::on_parent_pool_reset,
+                  this),
+        this
+    );
+
     Anvil::ObjectTracker::get()->unregister_object(Anvil::ObjectType::DESCRIPTOR_SET,
                                                    this);
 }
@@ -344,9 +358,129 @@ void Anvil::DescriptorSet::alloc_bindings()
                 m_binding_ptrs[binding_index].resize(array_size);
             }
         }
+
+        /* The first bake needs to visit all elements, so that unassigned elements of bindings which are not partially bound are caught. */
+        if (descriptor_type != Anvil::DescriptorType::INLINE_UNIFORM_BLOCK)
+        {
+            mark_binding_elements_dirty(binding_index,
+                                        0, /* in_first_element_index */
+                                        array_size);
+        }
     }
 }
 
+/** Reserves space for a raw write in the staging block and records the write, so that it is applied at next bake time.
+ *
+ *  @param in_binding_index Binding to write to.
+ *  @param in_element_range Range of array elements to write to.
+ *  @param in_item_size     Size of a single descriptor info item. Must match the binding's descriptor type.
+ *
+ *  @return Pointer to the reserved region, or null if the request is invalid.
+ */
+void* Anvil::DescriptorSet::alloc_raw_write(BindingIndex             in_binding_index,
+                                            BindingElementArrayRange in_element_range,
+                                            size_t                   in_item_size)
+{
+    auto                  binding_iterator   = m_binding_ptrs.find(in_binding_index);
+    Anvil::DescriptorType descriptor_type    = Anvil::DescriptorType::UNKNOWN;
+    size_t                expected_item_size = 0;
+    const size_t          n_staging_items    = (in_item_size * in_element_range.second + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    RawWrite              raw_write;
+    void*                 result_ptr         = nullptr;
+
+    anvil_assert(!m_unusable);
+
+    if (binding_iterator == m_binding_ptrs.end() )
+    {
+        anvil_assert(binding_iterator != m_binding_ptrs.end() );
+
+        goto end;
+    }
+
+    if (!m_layout_ptr->get_create_info()->get_binding_properties_by_binding_index(in_binding_index,
+                                                                                 &descriptor_type) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    switch (descriptor_type)
+    {
+        case Anvil::DescriptorType::STORAGE_BUFFER:
+        case Anvil::DescriptorType::STORAGE_BUFFER_DYNAMIC:
+        case Anvil::DescriptorType::UNIFORM_BUFFER:
+        case Anvil::DescriptorType::UNIFORM_BUFFER_DYNAMIC:
+        {
+            expected_item_size = sizeof(VkDescriptorBufferInfo);
+
+            break;
+        }
+
+        case Anvil::DescriptorType::COMBINED_IMAGE_SAMPLER:
+        case Anvil::DescriptorType::INPUT_ATTACHMENT:
+        case Anvil::DescriptorType::SAMPLED_IMAGE:
+        case Anvil::DescriptorType::SAMPLER:
+        case Anvil::DescriptorType::STORAGE_IMAGE:
+        {
+            expected_item_size = sizeof(VkDescriptorImageInfo);
+
+            break;
+        }
+
+        case Anvil::DescriptorType::STORAGE_TEXEL_BUFFER:
+        case Anvil::DescriptorType::UNIFORM_TEXEL_BUFFER:
+        {
+            expected_item_size = sizeof(VkBufferView);
+
+            break;
+        }
+
+        default:
+        {
+            /* Inline uniform blocks need to be updated with write_inline_uniform_block_data() or set_inline_uniform_block_binding_data() */
+            break;
+        }
+    }
+
+    if (expected_item_size != in_item_size)
+    {
+        anvil_assert(expected_item_size == in_item_size);
+
+        goto end;
+    }
+
+    if (in_element_range.second                          == 0                                 ||
+        in_element_range.first + in_element_range.second >  binding_iterator->second.size() )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    /* Raw writes bypass the wrappers, so the samplers they use cannot be tracked */
+    if (descriptor_type == Anvil::DescriptorType::COMBINED_IMAGE_SAMPLER ||
+        descriptor_type == Anvil::DescriptorType::SAMPLER)
+    {
+        m_observed_samplers[in_binding_index] = ObservedSampler();
+    }
+
+    raw_write.binding_index   = in_binding_index;
+    raw_write.descriptor_type = descriptor_type;
+    raw_write.n_elements      = in_element_range.second;
+    raw_write.n_first_element = in_element_range.first;
+    raw_write.staging_offset  = m_raw_staging.size();
+
+    m_raw_staging.resize(m_raw_staging.size() + n_staging_items);
+    m_raw_writes.push_back(raw_write);
+
+    result_ptr = &m_raw_staging.at(raw_write.staging_offset);
+    m_dirty    = true;
+
+end:
+    return result_ptr;
+}
+
 /* Please see header for specification */
 Anvil::DescriptorSetUniquePtr Anvil::DescriptorSet::create(const Anvil::BaseDevice*          in_device_ptr,
                                                            Anvil::DescriptorPool*            in_parent_pool_ptr,
@@ -544,6 +678,28 @@ end:
     return result;
 }
 
+/* Please see header for specification */
+bool Anvil::DescriptorSet::get_uniform_sampler(BindingIndex           in_n_binding,
+                                               const Anvil::Sampler** out_sampler_ptr_ptr) const
+{
+    auto observed_sampler_iterator = m_observed_samplers.find(in_n_binding);
+    bool result                    = false;
+
+    anvil_assert(out_sampler_ptr_ptr != nullptr);
+
+    if (observed_sampler_iterator            == m_observed_samplers.end() ||
+       !observed_sampler_iterator->second.is_uniform)
+    {
+        goto end;
+    }
+
+    *out_sampler_ptr_ptr = observed_sampler_iterator->second.sampler_ptr;
+    result               = true;
+
+end:
+    return result;
+}
+
 /* Please see header for specification */
 bool Anvil::DescriptorSet::get_storage_buffer_binding_properties(uint32_t        in_n_binding,
                                                                  uint32_t        in_n_binding_array_item,
@@ -642,6 +798,39 @@ void Anvil::DescriptorSet::on_parent_pool_reset()
     m_unusable       = true;
 }
 
+/** Called back whenever a sampler is assigned to an element of a sampler or combined image+sampler binding.
+ *
+ *  Updates the binding's observed sampler, which is later used to determine whether the binding can be promoted
+ *  to use immutable samplers.
+ **/
+void Anvil::DescriptorSet::on_sampler_written(BindingIndex          in_binding_index,
+                                              const Anvil::Sampler* in_sampler_ptr)
+{
+    auto observed_sampler_iterator = m_observed_samplers.find(in_binding_index);
+
+    if (observed_sampler_iterator == m_observed_samplers.end() )
+    {
+        m_observed_samplers[in_binding_index] = ObservedSampler(in_sampler_ptr);
+
+        goto end;
+    }
+
+    if (!observed_sampler_iterator->second.is_uniform                 ||
+         observed_sampler_iterator->second.sampler_ptr == in_sampler_ptr)
+    {
+        goto end;
+    }
+
+    /* Distinct sampler instances sharing the same state are interchangeable */
+    if (!(*observed_sampler_iterator->second.sampler_ptr->get_create_info_ptr() == *in_sampler_ptr->get_create_info_ptr()) )
+    {
+        observed_sampler_iterator->second.is_uniform = false;
+    }
+
+end:
+    ;
+}
+
 /* Please see header for specification */
 bool Anvil::DescriptorSet::set_inline_uniform_block_binding_data(const BindingIndex& in_binding_index,
                                                                  const uint32_t&     in_start_offset,
@@ -681,19 +870,128 @@ bool Anvil::DescriptorSet::set_inline_uniform_block_binding_data(const BindingIn
         std::move(new_iub_binding_item_ptr)
     );
 
+    /* Pending IUB updates are always processed in their entirety */
+    mark_binding_elements_dirty(in_binding_index,
+                                0, /* in_first_element_index */
+                                static_cast<uint32_t>(iub_binding_item_ptrs.size() ));
+
+    result = true;
+
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::DescriptorSet::write_inline_uniform_block_data(BindingIndex in_binding_index,
+                                                           uint32_t     in_start_offset,
+                                                           uint32_t     in_size,
+                                                           const void*  in_data_ptr)
+{
+    uint32_t              block_size      = 0;
+    Anvil::DescriptorType descriptor_type = Anvil::DescriptorType::UNKNOWN;
+    RawWrite*             last_write_ptr  = (m_raw_writes.size() > 0) ? &m_raw_writes.back() : nullptr;
+    const size_t          n_staging_items = (in_size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    RawWrite              raw_write;
+    bool                  result          = false;
+
+    anvil_assert(!m_unusable);
+    anvil_assert(in_data_ptr != nullptr);
+
+    if ((in_start_offset % 4) != 0 ||
+        (in_size         % 4) != 0 ||
+         in_size              == 0)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (!m_layout_ptr->get_create_info()->get_binding_properties_by_binding_index(in_binding_index,
+                                                                                 &descriptor_type,
+                                                                                 &block_size) ||
+        descriptor_type != Anvil::DescriptorType::INLINE_UNIFORM_BLOCK)
+    {
+        anvil_assert(descriptor_type == Anvil::DescriptorType::INLINE_UNIFORM_BLOCK);
+
+        goto end;
+    }
+
+    if (in_start_offset + in_size > block_size)
+    {
+        anvil_assert(in_start_offset + in_size <= block_size);
+
+        goto end;
+    }
+
+    /* If the region directly follows the one written last time, and the staged data of the latter ends at a 64-bit boundary,
+     * append the data to the existing write instead of creating a new one. */
+    if ( last_write_ptr                                             != nullptr                                     &&
+         last_write_ptr->descriptor_type                            == Anvil::DescriptorType::INLINE_UNIFORM_BLOCK &&
+         last_write_ptr->binding_index                              == in_binding_index                            &&
+         last_write_ptr->n_first_element + last_write_ptr->n_elements == in_start_offset                           &&
+        (last_write_ptr->n_elements % sizeof(uint64_t))             == 0)
+    {
+        const size_t staging_offset = m_raw_staging.size();
+
+        m_raw_staging.resize(staging_offset + n_staging_items);
+
+        memcpy(&m_raw_staging.at(staging_offset),
+               in_data_ptr,
+               in_size);
+
+        last_write_ptr->n_elements += in_size;
+    }
+    else
+    {
+        raw_write.binding_index   = in_binding_index;
+        raw_write.descriptor_type = Anvil::DescriptorType::INLINE_UNIFORM_BLOCK;
+        raw_write.n_elements      = in_size;
+        raw_write.n_first_element = in_start_offset;
+        raw_write.staging_offset  = m_raw_staging.size();
+
+        m_raw_staging.resize(m_raw_staging.size() + n_staging_items);
+
+        memcpy(&m_raw_staging.at(raw_write.staging_offset),
+               in_data_ptr,
+               in_size);
+
+        m_raw_writes.push_back(raw_write);
+    }
+
     m_dirty = true;
     result  = true;
 
+end:
     return result;
 }
 
 bool Anvil::DescriptorSet::update(const DescriptorSetUpdateMethod& in_update_method) const
 {
-    bool result;
+    ANVIL_TRACE_SPAN("DescriptorSet::update");
+
+    bool                             is_dirty       (false);
+    bool                             result;
+    bool                             should_measure (false);
+    uint64_t                         start_timestamp(0);
+    Anvil::DescriptorSetUpdateMethod update_method  (in_update_method);
 
     lock();
     {
-        switch (in_update_method)
+        is_dirty = m_dirty;
+
+        if (update_method == Anvil::DescriptorSetUpdateMethod::AUTO)
+        {
+            update_method = m_layout_ptr->get_auto_update_method(&should_measure);
+
+            /* Only updates which actually do something are representative */
+            should_measure &= m_dirty;
+
+            if (should_measure)
+            {
+                start_timestamp = Anvil::Time::get_raw_host_timestamp();
+            }
+        }
+
+        switch (update_method)
         {
             case Anvil::DescriptorSetUpdateMethod::CORE:
             {
@@ -716,22 +1014,112 @@ bool Anvil::DescriptorSet::update(const DescriptorSetUpdateMethod& in_update_met
                 result = false;
             }
         }
+
+        if (result         &&
+            should_measure)
+        {
+            const auto& timer = m_layout_ptr->m_update_method_timer;
+
+            m_layout_ptr->on_auto_update_measured(update_method,
+                                                  timer.convert_raw_host_timestamp_to_nsec(Anvil::Time::get_raw_host_timestamp() ) -
+                                                  timer.convert_raw_host_timestamp_to_nsec(start_timestamp) );
+        }
+
+        if (result                &&
+            m_raw_writes.size() > 0)
+        {
+            result = update_using_raw_writes();
+        }
     }
     unlock();
 
+    if (result   &&
+        is_dirty)
+    {
+        Anvil::PerfCounters::increment(Anvil::PerfCounters::Counter::DESCRIPTOR_SET_UPDATES);
+    }
+
     return result;
 }
 
 /* Please see header for specification */
 bool Anvil::DescriptorSet::update_using_core_method() const
 {
-    std::vector<uint32_t> iub_binding_indices;
-    const auto            layout_info_ptr     = m_layout_ptr->get_create_info();
-    bool                  result              = false;
+    bool result = false;
 
     anvil_assert(!m_unusable);
 
     if (m_dirty)
+    {
+        if (!prepare_core_writes() )
+        {
+            goto end;
+        }
+
+        /* Issue the Vulkan call */
+        if (m_cached_ds_write_items_vk.size() > 0)
+        {
+            m_device_ptr->get_dispatch_table().vkUpdateDescriptorSets(m_device_ptr->get_device_vk(),
+                                                                      static_cast<uint32_t>(m_cached_ds_write_items_vk.size() ),
+                                                                     &m_cached_ds_write_items_vk[0],
+                                                                      0,        /* copyCount         */
+                                                                      nullptr); /* pDescriptorCopies */
+        }
+
+        on_core_writes_submitted();
+    }
+
+    result = true;
+
+end:
+
+    return result;
+}
+
+/** Called after the write items formed by prepare_core_writes() have been submitted. Releases the processed IUB updates
+ *  and marks the set as clean.
+ */
+void Anvil::DescriptorSet::on_core_writes_submitted() const
+{
+    /* If any IUB bindings have been processed, wipe out binding items associated with these, as the corresponding updates have already
+     * been performed.
+     */
+    for (const auto& current_iub_binding_index : m_cached_iub_binding_indices)
+    {
+        auto& current_iub_binding = m_binding_ptrs.at(current_iub_binding_index);
+
+        current_iub_binding.clear();
+    }
+
+    m_cached_iub_binding_indices.clear    ();
+    m_dirty_binding_element_ranges.clear();
+
+    m_dirty = false;
+}
+
+/** Called after the write items formed by prepare_raw_writes() have been submitted. Releases the staging block contents. */
+void Anvil::DescriptorSet::on_raw_writes_submitted() const
+{
+    /* NOTE: clear() retains the capacity, so subsequent raw writes do not reallocate the staging block */
+    m_raw_staging.clear();
+    m_raw_writes.clear ();
+
+    m_dirty = false;
+}
+
+/** Forms VkWriteDescriptorSet items for all dirty binding elements and stores them in m_cached_ds_write_items_vk.
+ *  No Vulkan call is made. The write items, as well as the descriptor info items they point to, stay valid until
+ *  the next bake.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::DescriptorSet::prepare_core_writes() const
+{
+    const auto layout_info_ptr = m_layout_ptr->get_create_info();
+    bool       result          = false;
+
+    m_cached_iub_binding_indices.clear();
+
     {
         uint32_t       cached_ds_buffer_info_items_array_offset       = 0;
         uint32_t       cached_ds_image_info_items_array_offset        = 0;
@@ -739,6 +1127,7 @@ bool Anvil::DescriptorSet::update_using_core_method() const
         uint32_t       cached_ds_texel_buffer_info_items_array_offset = 0;
         const uint32_t n_bindings                                     = static_cast<uint32_t>(m_binding_ptrs.size() );
 
+        /* NOTE: clear() retains the capacity of the cached vectors, so they only reallocate if a bake touches more elements than any bake before. */
         m_cached_ds_info_buffer_info_items_vk.clear      ();
         m_cached_ds_info_image_info_items_vk.clear       ();
         m_cached_ds_info_texel_buffer_info_items_vk.clear();
@@ -747,13 +1136,12 @@ bool Anvil::DescriptorSet::update_using_core_method() const
         {
             uint32_t n_max_ds_info_items_to_cache  = 0;
 
-            for (auto& binding_map_item : m_binding_ptrs)
+            for (const auto& dirty_range_map_item : m_dirty_binding_element_ranges)
             {
-                const uint32_t n_current_binding_items = static_cast<uint32_t>(binding_map_item.second.size() );
-
-                n_max_ds_info_items_to_cache += n_current_binding_items;
+                n_max_ds_info_items_to_cache += dirty_range_map_item.second.second - dirty_range_map_item.second.first;
             }
 
+            /* The write items point into these vectors, so they must not grow while the write items are being formed. */
             m_cached_ds_info_buffer_info_items_vk.reserve      (n_max_ds_info_items_to_cache);
             m_cached_ds_info_image_info_items_vk.reserve       (n_max_ds_info_items_to_cache);
             m_cached_ds_info_texel_buffer_info_items_vk.reserve(n_max_ds_info_items_to_cache);
@@ -785,17 +1173,38 @@ bool Anvil::DescriptorSet::update_using_core_method() const
                 anvil_assert_fail();
             }
 
-            /* For each array item, initialize a descriptor info item.. */
+            /* Bindings which have not been modified since the last bake can be skipped altogether */
+            const auto dirty_range_iterator = m_dirty_binding_element_ranges.find(current_binding_index);
+
+            if (dirty_range_iterator == m_dirty_binding_element_ranges.end() )
+            {
+                continue;
+            }
+
+            /* Sampler bindings with immutable samplers are not updatable */
+            if (descriptor_type            == Anvil::DescriptorType::SAMPLER &&
+                immutable_samplers_enabled)
+            {
+                continue;
+            }
+
+            /* For each dirty array item, initialize a descriptor info item.. */
             BindingItemUniquePtrs& current_binding_item_ptrs = m_binding_ptrs.at(current_binding_index);
-            uint32_t               n_current_binding_items   = static_cast<uint32_t>(current_binding_item_ptrs.size() );
-            int32_t                n_last_binding_item       = -1;
+            const uint32_t         n_first_binding_item      = dirty_range_iterator->second.first;
+            uint32_t               n_end_binding_item        = dirty_range_iterator->second.second;
+            int32_t                n_last_binding_item       = static_cast<int32_t>(n_first_binding_item) - 1;
 
-            for (uint32_t n_current_binding_item = 0;
-                          n_current_binding_item < n_current_binding_items;
+            if (n_end_binding_item > static_cast<uint32_t>(current_binding_item_ptrs.size() ))
+            {
+                n_end_binding_item = static_cast<uint32_t>(current_binding_item_ptrs.size() );
+            }
+
+            for (uint32_t n_current_binding_item = n_first_binding_item;
+                          n_current_binding_item < n_end_binding_item;
                         ++n_current_binding_item)
             {
                 auto& current_binding_item_ptr = current_binding_item_ptrs.at(n_current_binding_item);
-                bool  needs_write_item         = ((n_current_binding_item + 1) == n_current_binding_items);
+                bool  needs_write_item         = ((n_current_binding_item + 1) == n_end_binding_item);
 
                 if (descriptor_type == Anvil::DescriptorType::INLINE_UNIFORM_BLOCK)
                 {
@@ -806,19 +1215,28 @@ bool Anvil::DescriptorSet::update_using_core_method() const
 
                     if (n_current_binding_item == 0)
                     {
-                        iub_binding_indices.push_back(n_binding);
+                        m_cached_iub_binding_indices.push_back(current_binding_index);
                     }
                 }
 
-                /* TODO: For arrayed binding items, avoid updating all binding items every time baking is triggered. */
                 if ( current_binding_item_ptr        != nullptr &&
                     !current_binding_item_ptr->dirty            &&
                      n_current_binding_item          == 0       &&
-                     n_current_binding_items         == 1)
+                     n_end_binding_item              == 1)
                 {
                     continue;
                 }
 
+                if ( descriptor_type                 != Anvil::DescriptorType::INLINE_UNIFORM_BLOCK &&
+                     current_binding_item_ptr        != nullptr                                     &&
+                    !current_binding_item_ptr->dirty)
+                {
+                    /* Arrayed binding items which have not changed since the last bake are left intact. Flush the range of dirty
+                     * items preceding this one, so that only the touched elements are written.
+                     */
+                    needs_write_item = true;
+                }
+                else
                 if (current_binding_item_ptr             != nullptr &&
                     current_binding_item_ptr->buffer_ptr != nullptr)
                 {
@@ -948,37 +1366,224 @@ bool Anvil::DescriptorSet::update_using_core_method() const
                 }
             }
         }
+    }
 
-        /* Issue the Vulkan call */
-        if (m_cached_ds_write_items_vk.size() > 0)
+    result = true;
+
+end:
+
+    return result;
+}
+
+/** Forms VkWriteDescriptorSet items for all pending raw writes and stores them in m_cached_raw_write_items_vk.
+ *  No Vulkan call is made.
+ */
+void Anvil::DescriptorSet::prepare_raw_writes() const
+{
+    uint32_t n_raw_write = 0;
+
+    m_cached_raw_write_items_vk.clear();
+
+    /* The write items point into this vector, so it must not grow while the write items are being formed. */
+    m_cached_raw_write_iub_items_vk.resize(m_raw_writes.size() );
+
+    for (const auto& current_raw_write : m_raw_writes)
+    {
+        const void*          staging_ptr = &m_raw_staging.at(current_raw_write.staging_offset);
+        VkWriteDescriptorSet write_ds_vk;
+
+        write_ds_vk.descriptorCount  = current_raw_write.n_elements;
+        write_ds_vk.descriptorType   = static_cast<VkDescriptorType>(current_raw_write.descriptor_type);
+        write_ds_vk.dstArrayElement  = current_raw_write.n_first_element;
+        write_ds_vk.dstBinding       = current_raw_write.binding_index;
+        write_ds_vk.dstSet           = m_descriptor_set;
+        write_ds_vk.pBufferInfo      = nullptr;
+        write_ds_vk.pImageInfo       = nullptr;
+        write_ds_vk.pNext            = nullptr;
+        write_ds_vk.pTexelBufferView = nullptr;
+        write_ds_vk.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+
+        switch (current_raw_write.descriptor_type)
         {
-            Anvil::Vulkan::vkUpdateDescriptorSets(m_device_ptr->get_device_vk(),
-                                                  static_cast<uint32_t>(m_cached_ds_write_items_vk.size() ),
-                                                 &m_cached_ds_write_items_vk[0],
-                                                  0,        /* copyCount         */
-                                                  nullptr); /* pDescriptorCopies */
-
-            /* If any IUB bindings have been processed, wipe out binding items associated with these, as the corresponding updates have already
-             * been performed.
-             */
-            for (const auto& current_iub_binding_index : iub_binding_indices)
+            case Anvil::DescriptorType::STORAGE_BUFFER:
+            case Anvil::DescriptorType::STORAGE_BUFFER_DYNAMIC:
+            case Anvil::DescriptorType::UNIFORM_BUFFER:
+            case Anvil::DescriptorType::UNIFORM_BUFFER_DYNAMIC:
+            {
+                write_ds_vk.pBufferInfo = reinterpret_cast<const VkDescriptorBufferInfo*>(staging_ptr);
+
+                break;
+            }
+
+            case Anvil::DescriptorType::STORAGE_TEXEL_BUFFER:
+            case Anvil::DescriptorType::UNIFORM_TEXEL_BUFFER:
             {
-                auto& current_iub_binding = m_binding_ptrs.at(current_iub_binding_index);
+                write_ds_vk.pTexelBufferView = reinterpret_cast<const VkBufferView*>(staging_ptr);
 
-                current_iub_binding.clear();
+                break;
+            }
+
+            case Anvil::DescriptorType::INLINE_UNIFORM_BLOCK:
+            {
+                auto& iub_info = m_cached_raw_write_iub_items_vk.at(n_raw_write);
+
+                iub_info.dataSize = current_raw_write.n_elements;
+                iub_info.pData    = staging_ptr;
+                iub_info.pNext    = nullptr;
+                iub_info.sType    = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_INLINE_UNIFORM_BLOCK_EXT;
+
+                write_ds_vk.pNext = &iub_info;
+
+                break;
+            }
+
+            default:
+            {
+                write_ds_vk.pImageInfo = reinterpret_cast<const VkDescriptorImageInfo*>(staging_ptr);
             }
         }
 
-        m_dirty = false;
+        m_cached_raw_write_items_vk.push_back(write_ds_vk);
+
+        n_raw_write++;
     }
+}
 
-    result = true;
+/* Please see header for specification */
+bool Anvil::DescriptorSet::update_multi(uint32_t                     in_n_sets,
+                                        Anvil::DescriptorSet* const* in_ds_ptrs)
+{
+    /* Scratch storage is kept per-thread, so that concurrent calls for disjoint sets do not need to synchronize */
+    thread_local std::vector<const Anvil::DescriptorSet*> t_dirty_ds_ptrs;
+    thread_local std::vector<Anvil::DescriptorSet*>       t_locked_ds_ptrs;
+    thread_local std::vector<VkWriteDescriptorSet>        t_write_items_vk;
+
+    const Anvil::BaseDevice* device_ptr = nullptr;
+    bool                     result     = false;
+
+    t_dirty_ds_ptrs.clear ();
+    t_locked_ds_ptrs.clear();
+    t_write_items_vk.clear();
+
+    /* Sets are locked in address order, so that concurrent calls for overlapping sets cannot deadlock, no matter
+     * in which order the callers have specified them. Duplicates are dropped, so that each set is only locked
+     * and baked once. */
+    for (uint32_t n_set = 0;
+                  n_set < in_n_sets;
+                ++n_set)
+    {
+        if (in_ds_ptrs[n_set] != nullptr)
+        {
+            t_locked_ds_ptrs.push_back(in_ds_ptrs[n_set]);
+        }
+    }
+
+    std::sort(t_locked_ds_ptrs.begin(),
+              t_locked_ds_ptrs.end  (),
+              std::less<Anvil::DescriptorSet*>() );
+
+    t_locked_ds_ptrs.erase(std::unique(t_locked_ds_ptrs.begin(),
+                                       t_locked_ds_ptrs.end  () ),
+                           t_locked_ds_ptrs.end() );
+
+    for (auto current_ds_ptr : t_locked_ds_ptrs)
+    {
+        current_ds_ptr->lock();
+    }
+
+    /* Gather write items of all dirty sets */
+    for (const Anvil::DescriptorSet* current_ds_ptr : t_locked_ds_ptrs)
+    {
+        if (!current_ds_ptr->m_dirty)
+        {
+            continue;
+        }
+
+        anvil_assert(!current_ds_ptr->m_unusable);
+
+        if (device_ptr == nullptr)
+        {
+            device_ptr = current_ds_ptr->m_device_ptr;
+        }
+        else
+        {
+            anvil_assert(device_ptr == current_ds_ptr->m_device_ptr);
+        }
+
+        if (!current_ds_ptr->prepare_core_writes() )
+        {
+            goto end;
+        }
+
+        t_write_items_vk.insert(t_write_items_vk.end(),
+                                current_ds_ptr->m_cached_ds_write_items_vk.begin(),
+                                current_ds_ptr->m_cached_ds_write_items_vk.end  () );
+
+        /* Raw writes must follow binding item writes made for the same set */
+        if (current_ds_ptr->m_raw_writes.size() > 0)
+        {
+            current_ds_ptr->prepare_raw_writes();
+
+            t_write_items_vk.insert(t_write_items_vk.end(),
+                                    current_ds_ptr->m_cached_raw_write_items_vk.begin(),
+                                    current_ds_ptr->m_cached_raw_write_items_vk.end  () );
+        }
+
+        t_dirty_ds_ptrs.push_back(current_ds_ptr);
+    }
+
+    /* Issue the Vulkan call */
+    if (t_write_items_vk.size() > 0)
+    {
+        device_ptr->get_dispatch_table().vkUpdateDescriptorSets(device_ptr->get_device_vk(),
+                                                                static_cast<uint32_t>(t_write_items_vk.size() ),
+                                                               &t_write_items_vk.at(0),
+                                                                0,        /* copyCount         */
+                                                                nullptr); /* pDescriptorCopies */
+    }
+
+    for (const auto& current_ds_ptr : t_dirty_ds_ptrs)
+    {
+        current_ds_ptr->on_core_writes_submitted();
+
+        if (current_ds_ptr->m_raw_writes.size() > 0)
+        {
+            current_ds_ptr->on_raw_writes_submitted();
+        }
+    }
 
+    Anvil::PerfCounters::increment(Anvil::PerfCounters::Counter::DESCRIPTOR_SET_UPDATES,
+                                   t_dirty_ds_ptrs.size() );
+
+    result = true;
 end:
+    for (auto current_ds_ptr : t_locked_ds_ptrs)
+    {
+        current_ds_ptr->unlock();
+    }
 
     return result;
 }
 
+/** Submits all pending raw writes with a single vkUpdateDescriptorSets() call and releases the staging block contents.
+ *
+ *  @return true if successful, false otherwise.
+ */
+bool Anvil::DescriptorSet::update_using_raw_writes() const
+{
+    prepare_raw_writes();
+
+    m_device_ptr->get_dispatch_table().vkUpdateDescriptorSets(m_device_ptr->get_device_vk(),
+                                                              static_cast<uint32_t>(m_cached_raw_write_items_vk.size() ),
+                                                             &m_cached_raw_write_items_vk.at(0),
+                                                              0,        /* copyCount         */
+                                                              nullptr); /* pDescriptorCopies */
+
+    on_raw_writes_submitted();
+
+    return true;
+}
+
 bool Anvil::DescriptorSet::update_using_template_method() const
 {
     std::vector<uint8_t> data_vector;
@@ -999,10 +1604,11 @@ bool Anvil::DescriptorSet::update_using_template_method() const
         /* First build up a vector of template entries we need the template to encapsulate. While on it,
          * also construct an array of descriptors we're going to pass along the template.
          */
-        const uint32_t                                  n_bindings               = static_cast<uint32_t>(m_binding_ptrs.size() );
-        decltype(m_template_object_map)::const_iterator template_object_iterator;
+        const uint32_t                         n_bindings   = static_cast<uint32_t>(m_binding_ptrs.size() );
+        const Anvil::DescriptorUpdateTemplate* template_ptr = nullptr;
 
         m_template_entries.clear ();
+        m_template_key.clear     ();
         m_template_raw_data.clear();
 
         for (uint32_t n_binding = 0;
@@ -1029,21 +1635,43 @@ bool Anvil::DescriptorSet::update_using_template_method() const
                 goto end;
             }
 
+            const auto dirty_range_iterator = m_dirty_binding_element_ranges.find(current_binding_index);
+
+            if (dirty_range_iterator == m_dirty_binding_element_ranges.end() )
+            {
+                continue;
+            }
+
+            if (descriptor_type            == Anvil::DescriptorType::SAMPLER &&
+                immutable_samplers_enabled)
+            {
+                continue;
+            }
+
             binding_element_ptr_vec_ptr = &m_binding_ptrs.at(current_binding_index);
             n_binding_elements          = static_cast<uint32_t>(binding_element_ptr_vec_ptr->size() );
 
-            for (uint32_t n_binding_element = 0;
+            if (n_binding_elements > dirty_range_iterator->second.second)
+            {
+                n_binding_elements = dirty_range_iterator->second.second;
+            }
+
+            for (uint32_t n_binding_element = dirty_range_iterator->second.first;
                           n_binding_element < n_binding_elements;
                         ++n_binding_element)
             {
-                const auto&    current_binding_element        = *binding_element_ptr_vec_ptr->at(n_binding_element);
+                const auto&    current_binding_element_ptr    = binding_element_ptr_vec_ptr->at(n_binding_element);
                 const uint32_t current_template_raw_data_size = static_cast<uint32_t>(m_template_raw_data.size() );
 
-                if (!current_binding_element.dirty)
+                /* Elements of partially bound bindings may have never been assigned a descriptor */
+                if (current_binding_element_ptr == nullptr ||
+                   !current_binding_element_ptr->dirty)
                 {
                     continue;
                 }
 
+                const auto& current_binding_element = *current_binding_element_ptr;
+
                 /* Append the new descriptor to the raw data vector.
                  *
                  * TODO: Consecutive dirty binding elements could be merged into a single item here.
@@ -1095,11 +1723,20 @@ bool Anvil::DescriptorSet::update_using_template_method() const
                                                   current_template_raw_data_size,
                                                   0)                              /* in_stride */
                 );
+
+                m_template_key.push_back(current_binding_index);
+                m_template_key.push_back(n_binding_element);
             }
         }
 
         if (m_template_entries.size() == 0)
         {
+            /* Nothing to update, apart from raw writes (if any) */
+            m_dirty = false;
+
+            m_dirty_binding_element_ranges.clear();
+
+            result = true;
             goto end;
         }
         else
@@ -1107,29 +1744,19 @@ bool Anvil::DescriptorSet::update_using_template_method() const
             anvil_assert(m_template_raw_data.size() > 0);
         }
 
-        /* Has a template object matching our needs already been created in the past? */
-        template_object_iterator = m_template_object_map.find(m_template_entries);
+        /* Templates are shared by all sets using the same layout. The (binding, array element) pairs, combined
+         * with the layout, fully determine the template entries, so they are all we need to look the template up. */
+        template_ptr = m_layout_ptr->get_update_template(Anvil::Utils::hash64(&m_template_key.at(0),
+                                                                              m_template_key.size() * sizeof(m_template_key.at(0) )),
+                                                         m_template_key,
+                                                         m_template_entries);
 
-        if (template_object_iterator == m_template_object_map.end() )
+        if (template_ptr == nullptr)
         {
-            /* Need to create a new template object.. */
-            m_template_object_map[m_template_entries] = std::move(
-                Anvil::DescriptorUpdateTemplate::create_for_descriptor_set_updates(m_device_ptr,
-                                                                                   m_layout_ptr,
-                                                                                   m_template_entries,
-                                                                                   Anvil::MTSafety::DISABLED) );
-
-            /* Update the iterator */
-            template_object_iterator = m_template_object_map.find(m_template_entries);
-            anvil_assert(template_object_iterator != m_template_object_map.end() );
-
-            if (template_object_iterator->second == nullptr)
-            {
-                anvil_assert(template_object_iterator->second != nullptr);
+            anvil_assert(template_ptr != nullptr);
 
-                result = false;
-                goto end;
-            }
+            result = false;
+            goto end;
         }
 
         /* Issue the Vulkan call.
@@ -1139,8 +1766,10 @@ bool Anvil::DescriptorSet::update_using_template_method() const
          */
         m_dirty = false;
 
-        template_object_iterator->second->update_descriptor_set(this,
-                                                               &m_template_raw_data.at(0) );
+        m_dirty_binding_element_ranges.clear();
+
+        template_ptr->update_descriptor_set(this,
+                                           &m_template_raw_data.at(0) );
     }
 
     result = true;
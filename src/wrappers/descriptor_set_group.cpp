@@ -22,7 +22,9 @@
 
 #include "misc/debug.h"
 #include "misc/descriptor_pool_create_info.h"
+#include "misc/descriptor_pool_sizing_profile.h"
 #include "misc/object_tracker.h"
+#include "misc/transient_descriptor_set_allocator.h"
 #include "wrappers/descriptor_pool.h"
 #include "wrappers/descriptor_set.h"
 #include "wrappers/descriptor_set_group.h"
@@ -30,6 +32,7 @@
 #include "wrappers/descriptor_set_layout_manager.h"
 #include "wrappers/device.h"
 #include "wrappers/pipeline_layout.h"
+#include <algorithm>
 #include <map>
 
 /* Please see header for specification */
@@ -39,11 +42,14 @@ Anvil::DescriptorSetGroup::DescriptorSetGroup(const Anvil::BaseDevice*
                                               MTSafety                                             in_mt_safety,
                                               const std::vector<OverheadAllocation>&               in_opt_overhead_allocations)
     :MTSafetySupportProvider       (Anvil::Utils::convert_mt_safety_enum_to_boolean(in_mt_safety,
-                                                                                    in_device_ptr) ),
+                                                                                    in_device_ptr),
+                                    false), /* in_is_lock_recursive */
      m_descriptor_pool_create_flags(in_descriptor_pool_create_flags),
      m_device_ptr                  (in_device_ptr),
      m_n_unique_dses               (0),
-     m_parent_dsg_ptr              (nullptr)
+     m_parent_dsg_ptr              (nullptr),
+     m_sizing_profile_key          (0),
+     m_transient_allocator_ptr     (nullptr)
 {
     auto ds_layout_manager_ptr = m_device_ptr->get_descriptor_set_layout_manager();
 
@@ -96,16 +102,37 @@ Anvil::DescriptorSetGroup::DescriptorSetGroup(const Anvil::BaseDevice*
 }
 
 /* Please see header for specification */
-Anvil::DescriptorSetGroup::DescriptorSetGroup(const DescriptorSetGroup* in_parent_dsg_ptr)
-    :MTSafetySupportProvider       (in_parent_dsg_ptr->is_mt_safe() ),
+Anvil::DescriptorSetGroup::DescriptorSetGroup(const DescriptorSetGroup*               in_parent_dsg_ptr,
+                                              Anvil::TransientDescriptorSetAllocator* in_opt_transient_allocator_ptr)
+    :MTSafetySupportProvider       (in_parent_dsg_ptr->is_mt_safe(),
+                                    false), /* in_is_lock_recursive */
      m_descriptor_pool_create_flags(in_parent_dsg_ptr->m_descriptor_pool_create_flags),
      m_device_ptr                  (in_parent_dsg_ptr->m_device_ptr),
-     m_parent_dsg_ptr              (in_parent_dsg_ptr)
+     m_parent_dsg_ptr              (in_parent_dsg_ptr),
+     m_sizing_profile_key          (in_parent_dsg_ptr->m_sizing_profile_key),
+     m_transient_allocator_ptr     (in_opt_transient_allocator_ptr)
 {
     auto descriptor_set_layout_manager_ptr = m_device_ptr->get_descriptor_set_layout_manager();
 
     anvil_assert(in_parent_dsg_ptr->m_parent_dsg_ptr == nullptr);
 
+    if (m_transient_allocator_ptr != nullptr)
+    {
+        /* Lightweight clone. Layouts are accessed via the parent, and sets come from the transient allocator, so
+         * there is no pool to create and no layout references to take. */
+        for (const auto& ds : in_parent_dsg_ptr->m_descriptor_sets)
+        {
+            m_descriptor_sets[ds.first].reset(
+                new DescriptorSetInfoContainer()
+            );
+        }
+
+        m_ds_create_info_ptrs = in_parent_dsg_ptr->m_ds_create_info_ptrs;
+        m_n_unique_dses       = in_parent_dsg_ptr->m_n_unique_dses;
+
+        goto end;
+    }
+
     m_descriptor_type_properties = in_parent_dsg_ptr->m_descriptor_type_properties;
 
     for (auto& current_descriptor_type_props : m_descriptor_type_properties)
@@ -164,6 +191,7 @@ Anvil::DescriptorSetGroup::DescriptorSetGroup(const DescriptorSetGroup* in_paren
 
     m_n_unique_dses = in_parent_dsg_ptr->m_n_unique_dses;
 
+end:
     /* Register the object */
     Anvil::ObjectTracker::get()->register_object(Anvil::ObjectType::ANVIL_DESCRIPTOR_SET_GROUP,
                                                  this);
@@ -172,6 +200,13 @@ Anvil::DescriptorSetGroup::DescriptorSetGroup(const DescriptorSetGroup* in_paren
 /** Releases the internally managed descriptor pool. */
 Anvil::DescriptorSetGroup::~DescriptorSetGroup()
 {
+    /* Let DSGs created later on with the same layouts learn how much of the pool has actually been needed. */
+    if (m_descriptor_pool_ptr != nullptr)
+    {
+        m_device_ptr->get_descriptor_pool_sizing_profile()->record_usage(m_sizing_profile_key,
+                                                                         m_descriptor_pool_ptr->get_peak_usage() );
+    }
+
     /* Unregister the object */
     Anvil::ObjectTracker::get()->unregister_object(Anvil::ObjectType::ANVIL_DESCRIPTOR_SET_GROUP,
                                                     this);
@@ -181,15 +216,19 @@ Anvil::DescriptorSetGroup::~DescriptorSetGroup()
 bool Anvil::DescriptorSetGroup::bake_descriptor_pool()
 {
     Anvil::DescriptorPoolCreateFlags                                                                    flags                    = m_descriptor_pool_create_flags;
-    std::unique_lock<std::recursive_mutex>                                                              mutex_lock;
+    Anvil::DescriptorPoolUsage                                                                          learned_usage;
+    std::unique_lock<Anvil::RecursiveSpinLock>                                                          mutex_lock;
     auto                                                                                                mutex_ptr                = get_mutex();
     std::unordered_map<Anvil::DescriptorType, uint32_t, Anvil::EnumClassHasher<Anvil::DescriptorType> > n_descriptors_needed_map;
+    uint32_t                                                                                            n_max_sets               = m_n_unique_dses;
     bool                                                                                                result                   = false;
+    auto                                                                                                sizing_profile_ptr       = m_device_ptr->get_descriptor_pool_sizing_profile();
+    std::vector<uint64_t>                                                                               sizing_profile_key_words;
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
         );
     }
 
@@ -217,6 +256,8 @@ bool Anvil::DescriptorSetGroup::bake_descriptor_pool()
 
         n_ds_bindings = static_cast<uint32_t>(current_ds_create_info_ptr->get_n_bindings() );
 
+        sizing_profile_key_words.push_back(Anvil::DescriptorPoolSizingProfile::get_descriptor_set_key(current_ds_create_info_ptr) );
+
         current_ds_create_info_ptr->contains_variable_descriptor_count_binding(&variable_descriptor_binding_index,
                                                                                &variable_descriptor_binding_size);
 
@@ -251,9 +292,34 @@ bool Anvil::DescriptorSetGroup::bake_descriptor_pool()
         }
     }
 
-    for (auto& current_map_entry : n_descriptors_needed_map)
+    sizing_profile_key_words.push_back(flags.get_vk() );
+
+    m_sizing_profile_key = Anvil::Utils::hash64(&sizing_profile_key_words.at(0),
+                                                sizing_profile_key_words.size() * sizeof(sizing_profile_key_words.at(0) ));
+
+    if (sizing_profile_ptr->is_adaptive_sizing_enabled()            &&
+        sizing_profile_ptr->get_usage(m_sizing_profile_key,
+                                     &learned_usage) )
+    {
+        /* Size the pool for what earlier DSGs with the same layouts have actually used, rather than for the overhead
+         * requested by the caller. */
+        for (const auto& current_type_usage : learned_usage.n_descriptors_per_type)
+        {
+            auto& n_descriptors_needed = n_descriptors_needed_map[current_type_usage.first];
+
+            n_descriptors_needed = std::max(n_descriptors_needed,
+                                            current_type_usage.second);
+        }
+
+        n_max_sets = std::max(n_max_sets,
+                              learned_usage.n_sets);
+    }
+    else
     {
-        current_map_entry.second += m_descriptor_type_properties[current_map_entry.first].n_overhead_allocations;
+        for (auto& current_map_entry : n_descriptors_needed_map)
+        {
+            current_map_entry.second += m_descriptor_type_properties[current_map_entry.first].n_overhead_allocations;
+        }
     }
 
     /* Verify we can actually create the pool.. */
@@ -270,7 +336,7 @@ bool Anvil::DescriptorSetGroup::bake_descriptor_pool()
     /* Create the pool */
     {
         auto dp_create_info_ptr = Anvil::DescriptorPoolCreateInfo::create(m_device_ptr,
-                                                                          m_n_unique_dses,
+                                                                          n_max_sets,
                                                                           flags,
                                                                           Anvil::Utils::convert_boolean_to_mt_safety_enum(is_mt_safe() ));
 
@@ -302,23 +368,20 @@ bool Anvil::DescriptorSetGroup::bake_descriptor_sets()
     std::vector<DescriptorSetUniquePtr>         dses;
     const Anvil::DescriptorSetGroup*            layout_vk_owner_ptr = (m_parent_dsg_ptr != nullptr) ? m_parent_dsg_ptr
                                                                                                     : this;
-    std::unique_lock<std::recursive_mutex>      mutex_lock;
+    decltype(m_descriptor_sets)::iterator       ds_iterator;
+    std::unique_lock<Anvil::RecursiveSpinLock>  mutex_lock;
     auto                                        mutex_ptr           = get_mutex();
+    const auto                                  n_sets              = static_cast<uint32_t>(m_descriptor_sets.size() );
     bool                                        result              = false;
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
         );
     }
 
-    anvil_assert(m_descriptor_pool_ptr != nullptr);
-
-
     /* Copy layout descriptors to the helper vector.. */
-    const auto n_sets = static_cast<uint32_t>(m_descriptor_sets.size() );
-
     for (const auto& ds_data : layout_vk_owner_ptr->m_descriptor_sets)
     {
         const auto& ds_ptr = ds_data.second;
@@ -356,19 +419,44 @@ bool Anvil::DescriptorSetGroup::bake_descriptor_sets()
         }
     }
 
-    /* Reset all previous allocations */
-    m_descriptor_pool_ptr->reset();
+    dses.resize(n_sets);
 
-    /* Grab descriptor sets from the pool. */
-    auto ds_iterator = m_descriptor_sets.begin();
+    if (m_transient_allocator_ptr != nullptr)
+    {
+        /* Sets are owned by the transient allocator, which releases them when the frame slot is recycled. */
+        for (uint32_t n_set = 0;
+                      n_set < n_sets;
+                    ++n_set)
+        {
+            auto ds_ptr = m_transient_allocator_ptr->allocate(allocations.at(n_set) );
 
-    dses.resize(n_sets);
+            if (ds_ptr == nullptr)
+            {
+                anvil_assert(ds_ptr != nullptr);
 
-    /* Allocate everything from scratch */
-    result = m_descriptor_pool_ptr->alloc_descriptor_sets(n_sets,
-                                                         &allocations.at(0),
-                                                         &dses.at       (0) );
-    anvil_assert(result);
+                goto end;
+            }
+
+            dses.at(n_set) = Anvil::DescriptorSetUniquePtr(ds_ptr,
+                                                           [](Anvil::DescriptorSet*){});
+        }
+    }
+    else
+    {
+        anvil_assert(m_descriptor_pool_ptr != nullptr);
+
+        /* Reset all previous allocations */
+        m_descriptor_pool_ptr->reset();
+
+        /* Allocate everything from scratch */
+        result = m_descriptor_pool_ptr->alloc_descriptor_sets(n_sets,
+                                                             &allocations.at(0),
+                                                             &dses.at       (0) );
+        anvil_assert(result);
+    }
+
+    /* Assign the allocated sets to their slots */
+    ds_iterator = m_descriptor_sets.begin();
 
     for (uint32_t n_set = 0;
                   n_set < n_sets;
@@ -382,7 +470,7 @@ bool Anvil::DescriptorSetGroup::bake_descriptor_sets()
 
     /* All done */
     result = true;
-
+end:
     return result;
 }
 
@@ -424,7 +512,8 @@ Anvil::DescriptorSetGroupUniquePtr Anvil::DescriptorSetGroup::create(const Anvil
                                                   std::default_delete<Anvil::DescriptorSetGroup>() );
 
     result_ptr.reset(
-        new Anvil::DescriptorSetGroup(in_parent_dsg_ptr)
+        new Anvil::DescriptorSetGroup(in_parent_dsg_ptr,
+                                      nullptr) /* in_opt_transient_allocator_ptr */
     );
 
     if (result_ptr != nullptr)
@@ -440,17 +529,48 @@ Anvil::DescriptorSetGroupUniquePtr Anvil::DescriptorSetGroup::create(const Anvil
     return result_ptr;
 }
 
+/* Please see header for specification */
+Anvil::DescriptorSetGroupUniquePtr Anvil::DescriptorSetGroup::create(const Anvil::DescriptorSetGroup*        in_parent_dsg_ptr,
+                                                                     Anvil::TransientDescriptorSetAllocator* in_allocator_ptr)
+{
+    Anvil::DescriptorSetGroupUniquePtr result_ptr(nullptr,
+                                                  std::default_delete<Anvil::DescriptorSetGroup>() );
+
+    if (in_allocator_ptr == nullptr)
+    {
+        anvil_assert(in_allocator_ptr != nullptr);
+
+        goto end;
+    }
+
+    result_ptr.reset(
+        new Anvil::DescriptorSetGroup(in_parent_dsg_ptr,
+                                      in_allocator_ptr)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->bake_descriptor_sets() )
+        {
+            result_ptr.reset();
+        }
+    }
+
+end:
+    return result_ptr;
+}
+
 /* Please see header for specification */
 Anvil::DescriptorSet* Anvil::DescriptorSetGroup::get_descriptor_set(uint32_t in_n_set)
 {
     decltype(m_descriptor_sets)::const_iterator ds_iterator;
-    std::unique_lock<std::recursive_mutex>      mutex_lock;
+    std::unique_lock<Anvil::RecursiveSpinLock>  mutex_lock;
     auto                                        mutex_ptr    = get_mutex();
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
         );
     }
 
@@ -462,14 +582,14 @@ Anvil::DescriptorSet* Anvil::DescriptorSetGroup::get_descriptor_set(uint32_t in_
 
 const std::vector<const Anvil::DescriptorSetCreateInfo*>* Anvil::DescriptorSetGroup::get_descriptor_set_create_info() const
 {
-    std::unique_lock<std::recursive_mutex>                    mutex_lock;
+    std::unique_lock<Anvil::RecursiveSpinLock>                mutex_lock;
     auto                                                      mutex_ptr  = get_mutex();
     const std::vector<const Anvil::DescriptorSetCreateInfo*>* result_ptr = nullptr;
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
         );
     }
 
@@ -481,14 +601,14 @@ const std::vector<const Anvil::DescriptorSetCreateInfo*>* Anvil::DescriptorSetGr
 /* Please see header for specification */
 const Anvil::DescriptorSetCreateInfo* Anvil::DescriptorSetGroup::get_descriptor_set_create_info(uint32_t in_n_set) const
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr   = get_mutex();
-    const Anvil::DescriptorSetCreateInfo*  result_ptr  = nullptr;
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr   = get_mutex();
+    const Anvil::DescriptorSetCreateInfo*      result_ptr  = nullptr;
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
         );
     }
 
@@ -508,13 +628,13 @@ end:
 /* Please see header for specification */
 Anvil::DescriptorSetLayout* Anvil::DescriptorSetGroup::get_descriptor_set_layout(uint32_t in_n_set) const
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr    = get_mutex();
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr    = get_mutex();
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
         );
     }
 
@@ -540,6 +660,39 @@ Anvil::DescriptorSetLayout* Anvil::DescriptorSetGroup::get_descriptor_set_layout
     }
 }
 
+/* Please see header for specification */
+bool Anvil::DescriptorSetGroup::update_descriptor_sets()
+{
+    std::vector<Anvil::DescriptorSet*>         ds_ptrs;
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr  = get_mutex();
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
+        );
+    }
+
+    ds_ptrs.reserve(m_descriptor_sets.size() );
+
+    for (const auto& current_ds : m_descriptor_sets)
+    {
+        if (current_ds.second->descriptor_set_ptr != nullptr)
+        {
+            ds_ptrs.push_back(current_ds.second->descriptor_set_ptr.get() );
+        }
+    }
+
+    if (ds_ptrs.size() == 0)
+    {
+        return true;
+    }
+
+    return Anvil::DescriptorSet::update_multi(static_cast<uint32_t>(ds_ptrs.size() ),
+                                             &ds_ptrs.at(0) );
+}
+
 /** Please see header for specification */
 Anvil::DescriptorSetGroup::DescriptorSetInfoContainer::~DescriptorSetInfoContainer()
 {
@@ -25,8 +25,22 @@
 #include "misc/object_tracker.h"
 #include "misc/struct_chainer.h"
 #include "wrappers/descriptor_set_layout.h"
+#include "wrappers/descriptor_update_template.h"
 #include "wrappers/device.h"
 #include "wrappers/sampler.h"
+#include <set>
+
+/* Number of timed DescriptorSetUpdateMethod::AUTO updates per method, after the warm-up one, which are needed
+ * before the faster method is selected. */
+static const uint32_t g_n_auto_update_samples_per_method = 4;
+
+namespace
+{
+    /* IDs of all layouts which have not been released yet. Please see DescriptorSetLayout::is_unique_id_live(). */
+    std::set<uint64_t>    g_live_descriptor_set_layout_ids;
+    std::mutex            g_live_descriptor_set_layout_ids_mutex;
+    std::atomic<uint64_t> g_n_descriptor_set_layouts(0);
+}
 
 /** Please see header for specification */
 Anvil::DescriptorSetLayout::DescriptorSetLayout(Anvil::DescriptorSetCreateInfoUniquePtr in_ds_create_info_ptr,
@@ -37,30 +51,137 @@ Anvil::DescriptorSetLayout::DescriptorSetLayout(Anvil::DescriptorSetCreateInfoUn
      MTSafetySupportProvider   (in_mt_safe),
      m_create_info_ptr         (std::move(in_ds_create_info_ptr) ),
      m_device_ptr              (in_device_ptr),
-     m_layout                  (VK_NULL_HANDLE)
+     m_layout                  (VK_NULL_HANDLE),
+     m_unique_id               (++g_n_descriptor_set_layouts)
 {
+    {
+        std::unique_lock<std::mutex> lock(g_live_descriptor_set_layout_ids_mutex);
+
+        g_live_descriptor_set_layout_ids.insert(m_unique_id);
+    }
+
     Anvil::ObjectTracker::get()->register_object(Anvil::ObjectType::DESCRIPTOR_SET_LAYOUT,
                                                   this);
 }
 
+/** Returns the update method to use for a DescriptorSetUpdateMethod::AUTO update of a descriptor set using this layout.
+ *
+ *  While the layout is still measuring both methods, the method which has been timed fewer times is returned.
+ *
+ *  @param out_should_measure_ptr Deref will be set to true if the caller should time the update and report the result
+ *                                with on_auto_update_measured(), false otherwise. Must not be null.
+ *
+ *  @return As per description. Never AUTO.
+ **/
+Anvil::DescriptorSetUpdateMethod Anvil::DescriptorSetLayout::get_auto_update_method(bool* out_should_measure_ptr) const
+{
+    Anvil::DescriptorSetUpdateMethod result;
+
+    lock();
+    {
+        if (m_update_method_stats.selected_method == Anvil::DescriptorSetUpdateMethod::AUTO &&
+            !m_device_ptr->get_extension_info()->khr_descriptor_update_template() )
+        {
+            m_update_method_stats.selected_method = Anvil::DescriptorSetUpdateMethod::CORE;
+        }
+
+        if (m_update_method_stats.selected_method != Anvil::DescriptorSetUpdateMethod::AUTO)
+        {
+            result                  = m_update_method_stats.selected_method;
+            *out_should_measure_ptr = false;
+        }
+        else
+        {
+            result                  = (m_update_method_stats.n_template_updates < m_update_method_stats.n_core_updates) ? Anvil::DescriptorSetUpdateMethod::TEMPLATE
+                                                                                                                      : Anvil::DescriptorSetUpdateMethod::CORE;
+            *out_should_measure_ptr = true;
+        }
+    }
+    unlock();
+
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::DescriptorSetUpdateMethodStats Anvil::DescriptorSetLayout::get_update_method_stats() const
+{
+    Anvil::DescriptorSetUpdateMethodStats result;
+
+    lock();
+    {
+        result = m_update_method_stats;
+    }
+    unlock();
+
+    return result;
+}
+
+/** Records the duration of a timed DescriptorSetUpdateMethod::AUTO update. Once enough updates have been timed for
+ *  both methods, selects the faster one.
+ *
+ *  @param in_update_method Method the update has been performed with, as returned by get_auto_update_method().
+ *  @param in_duration_nsec Duration of the update, in nanoseconds.
+ **/
+void Anvil::DescriptorSetLayout::on_auto_update_measured(Anvil::DescriptorSetUpdateMethod in_update_method,
+                                                         uint64_t                         in_duration_nsec) const
+{
+    lock();
+    {
+        if (m_update_method_stats.selected_method == Anvil::DescriptorSetUpdateMethod::AUTO)
+        {
+            const bool is_core    = (in_update_method == Anvil::DescriptorSetUpdateMethod::CORE);
+            uint32_t&  n_updates  = (is_core) ? m_update_method_stats.n_core_updates        : m_update_method_stats.n_template_updates;
+            uint64_t&  total_time = (is_core) ? m_update_method_stats.core_update_time_nsec : m_update_method_stats.template_update_time_nsec;
+
+            anvil_assert(in_update_method == Anvil::DescriptorSetUpdateMethod::CORE     ||
+                         in_update_method == Anvil::DescriptorSetUpdateMethod::TEMPLATE);
+
+            /* The first update of each method is a warm-up one. */
+            if (n_updates > 0)
+            {
+                total_time += in_duration_nsec;
+            }
+
+            ++n_updates;
+
+            if (m_update_method_stats.n_core_updates     > g_n_auto_update_samples_per_method &&
+                m_update_method_stats.n_template_updates > g_n_auto_update_samples_per_method)
+            {
+                m_update_method_stats.selected_method = (m_update_method_stats.template_update_time_nsec < m_update_method_stats.core_update_time_nsec) ? Anvil::DescriptorSetUpdateMethod::TEMPLATE
+                                                                                                                                                        : Anvil::DescriptorSetUpdateMethod::CORE;
+            }
+        }
+    }
+    unlock();
+}
+
 /** Please see header for specification */
 Anvil::DescriptorSetLayout::~DescriptorSetLayout()
 {
     Anvil::ObjectTracker::get()->unregister_object(Anvil::ObjectType::DESCRIPTOR_SET_LAYOUT,
                                                     this);
 
+    /* Release the cached templates before the layout they have been created for goes away */
+    m_update_template_cache.clear();
+
     if (m_layout != VK_NULL_HANDLE)
     {
         lock();
         {
-            Anvil::Vulkan::vkDestroyDescriptorSetLayout(m_device_ptr->get_device_vk(),
-                                                        m_layout,
-                                                        nullptr /* pAllocator */);
+            m_device_ptr->get_dispatch_table().vkDestroyDescriptorSetLayout(m_device_ptr->get_device_vk(),
+                                                                            m_layout,
+                                                                            m_device_ptr->get_allocation_callbacks_vk() );
         }
         unlock();
 
         m_layout = VK_NULL_HANDLE;
     }
+
+    {
+        std::unique_lock<std::mutex> lock(g_live_descriptor_set_layout_ids_mutex);
+
+        g_live_descriptor_set_layout_ids.erase(m_unique_id);
+    }
 }
 
 /** Please see header for specification */
@@ -158,6 +279,14 @@ end:
     return result;
 }
 
+/** Please see header for specification */
+bool Anvil::DescriptorSetLayout::is_unique_id_live(uint64_t in_unique_id)
+{
+    std::unique_lock<std::mutex> lock(g_live_descriptor_set_layout_ids_mutex);
+
+    return g_live_descriptor_set_layout_ids.find(in_unique_id) != g_live_descriptor_set_layout_ids.end();
+}
+
 bool Anvil::DescriptorSetLayout::meets_max_per_set_descriptors_limit(const DescriptorSetLayoutCreateInfoContainer* in_ds_create_info_ptr,
                                                                      const Anvil::BaseDevice*                      in_device_ptr)
 {
@@ -189,6 +318,65 @@ end:
     return result;
 }
 
+/** Returns a descriptor update template for the specified list of template entries, creating and caching
+ *  one if necessary.
+ *
+ *  The cache is shared by all descriptor sets using this layout.
+ *
+ *  @param in_key_hash Hash of @param in_key.
+ *  @param in_key      (binding index, array element) pairs, one per template entry. Together with the layout,
+ *                     the pairs determine the template entries.
+ *  @param in_entries  Template entries to use if a new template needs to be created.
+ *
+ *  @return Template instance if successful, null otherwise.
+ **/
+const Anvil::DescriptorUpdateTemplate* Anvil::DescriptorSetLayout::get_update_template(uint64_t                                          in_key_hash,
+                                                                                       const std::vector<uint32_t>&                      in_key,
+                                                                                       const std::vector<DescriptorUpdateTemplateEntry>& in_entries) const
+{
+    const Anvil::DescriptorUpdateTemplate* result_ptr = nullptr;
+
+    lock();
+    {
+        auto& cache_items = m_update_template_cache[in_key_hash];
+
+        for (const auto& current_cache_item : cache_items)
+        {
+            if (current_cache_item.key == in_key)
+            {
+                result_ptr = current_cache_item.template_ptr.get();
+
+                break;
+            }
+        }
+
+        if (result_ptr == nullptr)
+        {
+            auto new_template_ptr = Anvil::DescriptorUpdateTemplate::create_for_descriptor_set_updates(m_device_ptr,
+                                                                                                       this,
+                                                                                                       in_entries,
+                                                                                                       Anvil::MTSafety::DISABLED);
+
+            if (new_template_ptr != nullptr)
+            {
+                result_ptr = new_template_ptr.get();
+
+                cache_items.push_back(
+                    UpdateTemplateCacheItem(in_key,
+                                            std::move(new_template_ptr) )
+                );
+            }
+            else
+            {
+                anvil_assert(new_template_ptr != nullptr);
+            }
+        }
+    }
+    unlock();
+
+    return result_ptr;
+}
+
 /** Please see header for specification */
 bool Anvil::DescriptorSetLayout::init()
 {
@@ -207,10 +395,10 @@ bool Anvil::DescriptorSetLayout::init()
         goto end;
     }
 
-    result_vk = Anvil::Vulkan::vkCreateDescriptorSetLayout(m_device_ptr->get_device_vk(),
-                                                           create_info_ptr->struct_chain_ptr->get_root_struct(),
-                                                           nullptr, /* pAllocator */
-                                                          &m_layout);
+    result_vk = m_device_ptr->get_dispatch_table().vkCreateDescriptorSetLayout(m_device_ptr->get_device_vk(),
+                                                                               create_info_ptr->struct_chain_ptr->get_root_struct(),
+                                                                               m_device_ptr->get_allocation_callbacks_vk(),
+                                                                              &m_layout);
 
     anvil_assert_vk_call_succeeded(result_vk);
     if (is_vk_call_successful(result_vk) )
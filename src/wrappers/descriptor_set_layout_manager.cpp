@@ -31,7 +31,8 @@
 /** Constructor. */
 Anvil::DescriptorSetLayoutManager::DescriptorSetLayoutManager(const Anvil::BaseDevice* in_device_ptr,
                                                               bool                     in_mt_safe)
-    :MTSafetySupportProvider(in_mt_safe),
+    :MTSafetySupportProvider(in_mt_safe,
+                             false), /* in_is_lock_recursive */
      m_device_ptr           (in_device_ptr)
 {
     /* Register the object */
@@ -69,22 +70,24 @@ Anvil::DescriptorSetLayoutManagerUniquePtr Anvil::DescriptorSetLayoutManager::cr
 bool Anvil::DescriptorSetLayoutManager::get_layout(const DescriptorSetCreateInfo*       in_ds_create_info_ptr,
                                                    Anvil::DescriptorSetLayoutUniquePtr* out_ds_layout_ptr_ptr)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr            = get_mutex();
-    bool                                   result               = false;
-    Anvil::DescriptorSetLayout*            result_ds_layout_ptr = nullptr;
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr            = get_mutex();
+    bool                                       result               = false;
+    Anvil::DescriptorSetLayout*                result_ds_layout_ptr = nullptr;
 
     anvil_assert(in_ds_create_info_ptr != nullptr);
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
         );
     }
 
-    for (auto layout_iterator  = m_descriptor_set_layouts.begin();
-              layout_iterator != m_descriptor_set_layouts.end();
+    auto& layouts = m_descriptor_set_layouts[in_ds_create_info_ptr->get_hash()];
+
+    for (auto layout_iterator  = layouts.begin();
+              layout_iterator != layouts.end();
             ++layout_iterator)
     {
         auto&  current_ds_layout_container_ptr  = *layout_iterator;
@@ -115,7 +118,7 @@ bool Anvil::DescriptorSetLayoutManager::get_layout(const DescriptorSetCreateInfo
         result_ds_layout_ptr                       = new_ds_layout_ptr.get();
         new_ds_layout_container_ptr->ds_layout_ptr = std::move(new_ds_layout_ptr);
 
-        m_descriptor_set_layouts.push_back(
+        layouts.push_back(
             std::move(new_ds_layout_container_ptr)
         );
     }
@@ -136,34 +139,46 @@ bool Anvil::DescriptorSetLayoutManager::get_layout(const DescriptorSetCreateInfo
 
 void Anvil::DescriptorSetLayoutManager::on_descriptor_set_layout_dereferenced(Anvil::DescriptorSetLayout* in_layout_ptr)
 {
-    bool                                   has_found  = false;
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr  = get_mutex();
+    bool                                       has_found  = false;
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr  = get_mutex();
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
         );
     }
 
-    for (auto layout_iterator  = m_descriptor_set_layouts.begin();
-              layout_iterator != m_descriptor_set_layouts.end()    && !has_found;
-            ++layout_iterator)
+    auto bucket_iterator = m_descriptor_set_layouts.find(in_layout_ptr->get_create_info()->get_hash() );
+
+    if (bucket_iterator != m_descriptor_set_layouts.end() )
     {
-        auto& current_ds_layout_container_ptr = *layout_iterator;
-        auto& current_ds_layout_ptr           = current_ds_layout_container_ptr->ds_layout_ptr;
+        auto& layouts = bucket_iterator->second;
 
-        if (current_ds_layout_ptr.get() == in_layout_ptr)
+        for (auto layout_iterator  = layouts.begin();
+                  layout_iterator != layouts.end()    && !has_found;
+                ++layout_iterator)
         {
-            has_found = true;
+            auto& current_ds_layout_container_ptr = *layout_iterator;
+            auto& current_ds_layout_ptr           = current_ds_layout_container_ptr->ds_layout_ptr;
 
-            if (current_ds_layout_container_ptr->n_references.fetch_sub(1) == 1)
+            if (current_ds_layout_ptr.get() == in_layout_ptr)
             {
-                m_descriptor_set_layouts.erase(layout_iterator);
-            }
+                has_found = true;
 
-            break;
+                if (current_ds_layout_container_ptr->n_references.fetch_sub(1) == 1)
+                {
+                    layouts.erase(layout_iterator);
+
+                    if (layouts.size() == 0)
+                    {
+                        m_descriptor_set_layouts.erase(bucket_iterator);
+                    }
+                }
+
+                break;
+            }
         }
     }
 
@@ -28,14 +28,18 @@
 #include "wrappers/descriptor_update_template.h"
 #include "wrappers/device.h"
 #include "wrappers/physical_device.h"
+#include "wrappers/pipeline_layout.h"
+#include <algorithm>
 
 Anvil::DescriptorUpdateTemplate::DescriptorUpdateTemplate(const Anvil::BaseDevice* in_device_ptr,
                                                           bool                     in_mt_safe)
     :DebugMarkerSupportProvider(in_device_ptr,
                                 Anvil::ObjectType::DESCRIPTOR_UPDATE_TEMPLATE),
      MTSafetySupportProvider   (in_mt_safe),
-     m_device_ptr              (in_device_ptr),
-     m_vk_object               (VK_NULL_HANDLE)
+     m_data_size                  (0),
+     m_device_ptr                 (in_device_ptr),
+     m_is_push_descriptor_template(false),
+     m_vk_object                  (VK_NULL_HANDLE)
 {
     /* Register this instance */
     Anvil::ObjectTracker::get()->register_object(Anvil::ObjectType::DESCRIPTOR_UPDATE_TEMPLATE,
@@ -51,7 +55,7 @@ Anvil::DescriptorUpdateTemplate::~DescriptorUpdateTemplate()
 
         entrypoints.vkDestroyDescriptorUpdateTemplateKHR(m_device_ptr->get_device_vk(),
                                                          m_vk_object,
-                                                         nullptr); /* pAllocator */
+                                                         m_device_ptr->get_allocation_callbacks_vk() );
 
         m_vk_object = VK_NULL_HANDLE;
     }
@@ -81,7 +85,45 @@ Anvil::DescriptorUpdateTemplateUniquePtr Anvil::DescriptorUpdateTemplate::create
     {
         if (!result_ptr->init(in_descriptor_set_layout_ptr,
                               in_update_entries_ptr,
-                              in_n_update_entries) )
+                              in_n_update_entries,
+                              nullptr, /* in_opt_push_pipeline_layout_ptr */
+                              Anvil::PipelineBindPoint::UNKNOWN,
+                              0) )     /* in_push_n_set */
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+Anvil::DescriptorUpdateTemplateUniquePtr Anvil::DescriptorUpdateTemplate::create_for_push_descriptor_updates(const Anvil::BaseDevice*                                 in_device_ptr,
+                                                                                                             const Anvil::DescriptorSetLayout*                        in_descriptor_set_layout_ptr,
+                                                                                                             const std::vector<Anvil::DescriptorUpdateTemplateEntry>& in_update_entries,
+                                                                                                             Anvil::PipelineBindPoint                                 in_pipeline_bind_point,
+                                                                                                             const Anvil::PipelineLayout*                             in_pipeline_layout_ptr,
+                                                                                                             uint32_t                                                 in_n_set,
+                                                                                                             MTSafety                                                 in_mt_safety)
+{
+    DescriptorUpdateTemplateUniquePtr result_ptr(nullptr,
+                                                 std::default_delete<Anvil::DescriptorUpdateTemplate>() );
+
+    anvil_assert(in_pipeline_layout_ptr != nullptr);
+
+    result_ptr.reset(
+        new DescriptorUpdateTemplate(in_device_ptr,
+                                     Anvil::Utils::convert_mt_safety_enum_to_boolean(in_mt_safety,
+                                                                                     in_device_ptr) )
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init(in_descriptor_set_layout_ptr,
+                              (in_update_entries.size() > 0) ? &in_update_entries.at(0) : nullptr,
+                              static_cast<uint32_t>(in_update_entries.size() ),
+                              in_pipeline_layout_ptr,
+                              in_pipeline_bind_point,
+                              in_n_set) )
         {
             result_ptr.reset();
         }
@@ -92,7 +134,10 @@ Anvil::DescriptorUpdateTemplateUniquePtr Anvil::DescriptorUpdateTemplate::create
 
 bool Anvil::DescriptorUpdateTemplate::init(const Anvil::DescriptorSetLayout*           in_descriptor_set_layout_ptr,
                                            const Anvil::DescriptorUpdateTemplateEntry* in_update_entries_ptr,
-                                           const uint32_t&                             in_n_update_entries)
+                                           const uint32_t&                             in_n_update_entries,
+                                           const Anvil::PipelineLayout*                in_opt_push_pipeline_layout_ptr,
+                                           Anvil::PipelineBindPoint                    in_push_pipeline_bind_point,
+                                           uint32_t                                    in_push_n_set)
 {
     const Anvil::ExtensionKHRDescriptorUpdateTemplateEntrypoints* entrypoints_ptr = nullptr;
     bool                                                          result          = true;
@@ -129,6 +174,27 @@ bool Anvil::DescriptorUpdateTemplate::init(const Anvil::DescriptorSetLayout*
         goto end;
     }
 
+    if (in_opt_push_pipeline_layout_ptr != nullptr)
+    {
+        if (!m_device_ptr->get_extension_info()->khr_push_descriptor() )
+        {
+            anvil_assert(m_device_ptr->get_extension_info()->khr_push_descriptor() );
+
+            result = false;
+            goto end;
+        }
+
+        if ((in_descriptor_set_layout_ptr->get_create_info()->get_create_flags() & Anvil::DescriptorSetLayoutCreateFlagBits::PUSH_DESCRIPTOR_BIT_KHR) == 0)
+        {
+            anvil_assert_fail();
+
+            result = false;
+            goto end;
+        }
+
+        m_is_push_descriptor_template = true;
+    }
+
     entrypoints_ptr = &m_device_ptr->get_extension_khr_descriptor_update_template_entrypoints();
 
     if (entrypoints_ptr == nullptr)
@@ -147,25 +213,84 @@ bool Anvil::DescriptorUpdateTemplate::init(const Anvil::DescriptorSetLayout*
                       n_update_entry < in_n_update_entries;
                     ++n_update_entry)
         {
-            update_entries.at(n_update_entry) = in_update_entries_ptr[n_update_entry].get_vk_descriptor_update_template_entry_khr();
+            const auto& current_entry = in_update_entries_ptr[n_update_entry];
+            size_t      element_size  = 0;
+            size_t      entry_end     = 0;
+
+            update_entries.at(n_update_entry) = current_entry.get_vk_descriptor_update_template_entry_khr();
+
+            /* Determine how far into the app-specified data the entry reaches */
+            switch (current_entry.descriptor_type)
+            {
+                case Anvil::DescriptorType::INLINE_UNIFORM_BLOCK:
+                {
+                    /* The descriptor count holds the number of bytes to update. Stride is ignored. */
+                    entry_end = current_entry.offset + current_entry.n_descriptors;
+
+                    break;
+                }
+
+                case Anvil::DescriptorType::STORAGE_TEXEL_BUFFER:
+                case Anvil::DescriptorType::UNIFORM_TEXEL_BUFFER:
+                {
+                    element_size = sizeof(VkBufferView);
+
+                    break;
+                }
+
+                case Anvil::DescriptorType::STORAGE_BUFFER:
+                case Anvil::DescriptorType::STORAGE_BUFFER_DYNAMIC:
+                case Anvil::DescriptorType::UNIFORM_BUFFER:
+                case Anvil::DescriptorType::UNIFORM_BUFFER_DYNAMIC:
+                {
+                    element_size = sizeof(VkDescriptorBufferInfo);
+
+                    break;
+                }
+
+                default:
+                {
+                    element_size = sizeof(VkDescriptorImageInfo);
+                }
+            }
+
+            if (element_size               != 0 &&
+                current_entry.n_descriptors > 0)
+            {
+                entry_end = current_entry.offset + (current_entry.n_descriptors - 1) * current_entry.stride + element_size;
+            }
+
+            m_data_size = std::max(m_data_size,
+                                   entry_end);
         }
 
         create_info.descriptorSetLayout        = in_descriptor_set_layout_ptr->get_layout();
         create_info.descriptorUpdateEntryCount = in_n_update_entries;
         create_info.flags                      = 0;
         create_info.pDescriptorUpdateEntries   = &update_entries.at(0);
-        create_info.pipelineBindPoint          = VK_PIPELINE_BIND_POINT_MAX_ENUM;
-        create_info.pipelineLayout             = VK_NULL_HANDLE;
         create_info.pNext                      = nullptr;
-        create_info.set                        = VK_NULL_HANDLE;
         create_info.sType                      = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR;
-        create_info.templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR;
+
+        if (m_is_push_descriptor_template)
+        {
+            create_info.pipelineBindPoint = static_cast<VkPipelineBindPoint>(in_push_pipeline_bind_point);
+            create_info.pipelineLayout    = in_opt_push_pipeline_layout_ptr->get_pipeline_layout();
+            create_info.set               = in_push_n_set;
+            create_info.templateType      = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR;
+        }
+        else
+        {
+            create_info.pipelineBindPoint = VK_PIPELINE_BIND_POINT_MAX_ENUM;
+            create_info.pipelineLayout    = VK_NULL_HANDLE;
+            create_info.set               = 0;
+            create_info.templateType      = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR;
+        }
 
         in_descriptor_set_layout_ptr->lock();
         {
             result = is_vk_call_successful(entrypoints_ptr->vkCreateDescriptorUpdateTemplateKHR(m_device_ptr->get_device_vk(),
                                                                                                &create_info,
-                                                                                                nullptr, /* pAllocator */
+                                                                                                m_device_ptr->get_allocation_callbacks_vk(),
                                                                                                &m_vk_object) );
         }
         in_descriptor_set_layout_ptr->unlock();
@@ -20,11 +20,22 @@
 // THE SOFTWARE.
 //
 
+#include "misc/background_work_scheduler.h"
 #include "misc/debug.h"
+#include "misc/completion_service.h"
+#include "misc/deferred_deletion_queue.h"
+#include "misc/descriptor_pool_sizing_profile.h"
 #include "misc/object_tracker.h"
+#include "misc/framebuffer_cache.h"
+#include "misc/host_allocator.h"
+#include "misc/render_pass_cache.h"
+#include "misc/sampler_cache.h"
 #include "misc/shader_module_cache.h"
+#include "misc/staging_ring.h"
 #include "misc/struct_chainer.h"
 #include "misc/swapchain_create_info.h"
+#include "misc/task_scheduler.h"
+#include "misc/time.h"
 #include "wrappers/command_pool.h"
 #include "wrappers/compute_pipeline_manager.h"
 #include "wrappers/descriptor_set.h"
@@ -40,19 +51,69 @@
 #include "wrappers/queue.h"
 #include "wrappers/rendering_surface.h"
 #include "wrappers/swapchain.h"
+#include <atomic>
+#include <mutex>
+#include <set>
 
 #ifdef max
 #undef max
 #endif
 
+
+namespace
+{
+    /* Caches thread command pools, so that the calling thread does not need to lock the device-wide registry
+     * once a pool has been created. Items are identified by a registry ID, rather than a device pointer,
+     * since device instances may be allocated at addresses of devices which have already been released.
+     *
+     * A thread cannot reach other threads' caches, so items of released devices are dropped lazily: whenever
+     * a thread misses its cache, it prunes all items whose registry ID is no longer live.
+     */
+    typedef struct ThreadCommandPoolCacheItem
+    {
+        Anvil::CommandPool* command_pool_ptr;
+        uint32_t            queue_family_index;
+        uint64_t            registry_id;
+
+        ThreadCommandPoolCacheItem(uint64_t            in_registry_id,
+                                   uint32_t            in_queue_family_index,
+                                   Anvil::CommandPool* in_command_pool_ptr)
+            :command_pool_ptr  (in_command_pool_ptr),
+             queue_family_index(in_queue_family_index),
+             registry_id       (in_registry_id)
+        {
+            /* Stub */
+        }
+    } ThreadCommandPoolCacheItem;
+
+    std::set<uint64_t>                                  g_live_thread_command_pool_registry_ids;
+    std::mutex                                          g_live_thread_command_pool_registry_ids_mutex;
+    std::atomic<uint64_t>                               g_n_thread_command_pool_registries(0);
+    thread_local std::vector<ThreadCommandPoolCacheItem> t_thread_command_pool_cache;
+}
+
 /* Please see header for specification */
 Anvil::BaseDevice::BaseDevice(Anvil::DeviceCreateInfoUniquePtr in_create_info_ptr)
-    :MTSafetySupportProvider(in_create_info_ptr->should_be_mt_safe() ),
-     m_create_info_ptr      (std::move(in_create_info_ptr) ),
-     m_device               (VK_NULL_HANDLE)
+    :MTSafetySupportProvider                    (in_create_info_ptr->should_be_mt_safe() ),
+     m_allocation_callbacks_vk_ptr              (nullptr),
+     m_create_info_ptr                          (std::move(in_create_info_ptr) ),
+     m_device                                   (VK_NULL_HANDLE),
+     m_extension_func_ptrs_resolved             (false),
+     m_thread_command_pools_registry_id         (++g_n_thread_command_pool_registries),
+     m_thread_command_pools_trim_n_window_frames(60),
+     m_thread_command_pools_trim_usage_ratio    (0.5f)
 {
+    {
+        std::unique_lock<std::mutex> lock(g_live_thread_command_pool_registry_ids_mutex);
+
+        g_live_thread_command_pool_registry_ids.insert(m_thread_command_pools_registry_id);
+    }
+
     m_khr_surface_extension_entrypoints = m_create_info_ptr->get_physical_device_ptrs().at(0)->get_instance()->get_extension_khr_surface_entrypoints();
 
+    m_allocation_callbacks_vk_ptr = (m_create_info_ptr->get_host_allocator() != nullptr) ? m_create_info_ptr->get_host_allocator()->get_allocation_callbacks_vk()
+                                                                                         : m_create_info_ptr->get_physical_device_ptrs().at(0)->get_instance()->get_allocation_callbacks_vk();
+
     /* Register the instance */
     Anvil::ObjectTracker::get()->register_object(Anvil::ObjectType::DEVICE,
                                                  this);
@@ -71,6 +132,25 @@ Anvil::BaseDevice::~BaseDevice()
         wait_idle();
     }
 
+    m_background_work_scheduler_ptr.reset    ();
+    m_completion_service_ptr.reset           ();
+    m_deferred_deletion_queue_ptr.reset      ();
+    m_event_pool_ptr.reset                   ();
+    m_fence_pool_ptr.reset                   ();
+    m_framebuffer_cache_ptr.reset            ();
+    m_render_pass_cache_ptr.reset            ();
+    m_sampler_cache_ptr.reset                ();
+    m_semaphore_pool_ptr.reset               ();
+    m_staging_ring_ptr.reset                 ();
+    m_task_scheduler_ptr.reset               ();
+    m_thread_command_pools.clear             ();
+
+    {
+        std::unique_lock<std::mutex> lock(g_live_thread_command_pool_registry_ids_mutex);
+
+        g_live_thread_command_pool_registry_ids.erase(m_thread_command_pools_registry_id);
+    }
+
     m_command_pool_ptr_per_vk_queue_fam.clear();
     m_compute_pipeline_manager_ptr.reset     ();
     m_dummy_dsg_ptr.reset                    ();
@@ -80,12 +160,15 @@ Anvil::BaseDevice::~BaseDevice()
     m_pipeline_layout_manager_ptr.reset      ();
     m_owned_queues.clear                     ();
 
+    /* DSGs record their usage when released, so the profile needs to outlive all of them. */
+    m_descriptor_pool_sizing_profile_ptr.reset();
+
     if (m_device != VK_NULL_HANDLE)
     {
         lock();
         {
             Anvil::Vulkan::vkDestroyDevice(m_device,
-                                           nullptr); /* pAllocator */
+                                           m_allocation_callbacks_vk_ptr);
         }
         unlock();
 
@@ -141,10 +224,8 @@ void Anvil::BaseDevice::create_device(const std::vector<const char*>& in_extensi
             std::vector<VkDeviceQueueCreateInfo> device_queue_create_info_items;
             const auto                           n_queue_fams                   = static_cast<uint32_t>(zeroth_physical_device_queue_fams.size() );
 
-            /* For any queue that uses non-medium global priority, we're going to need a dedicated device queue create info struct. This is
-             * to ensure the global priority does not propagate to other queues.
-             *
-             * Creation requests for all other queues can be merged into one struct, one per each queue family index.
+            /* Vulkan requires a single VkDeviceQueueCreateInfo per queue family, so global priority is a per-family
+             * property. If queues of a family were assigned different global priorities, the highest one wins.
              */
             static VkDeviceQueueGlobalPriorityCreateInfoEXT low_priority_create_info =
             {
@@ -200,66 +281,72 @@ void Anvil::BaseDevice::create_device(const std::vector<const char*>& in_extensi
 
             /* Prepare device queue create info structs */
             {
-                uint32_t n_queues_defined_so_far = 0;
+                const bool is_global_priority_enabled = is_extension_enabled(VK_EXT_GLOBAL_PRIORITY_EXTENSION_NAME);
+                uint32_t   n_queues_defined_so_far    = 0;
+
+                m_queue_family_global_priorities.clear ();
+                m_queue_family_global_priorities.resize(n_queue_fams,
+                                                        Anvil::QueueGlobalPriority::MEDIUM_EXT);
 
                 for (uint32_t n_queue_fam = 0;
                               n_queue_fam < n_queue_fams;
                             ++n_queue_fam)
                 {
-                    const auto& current_queue_fam(zeroth_physical_device_queue_fams.at(n_queue_fam) );
+                    const auto&                current_queue_fam                       (zeroth_physical_device_queue_fams.at(n_queue_fam) );
+                    Anvil::QueueGlobalPriority family_global_priority                  (Anvil::QueueGlobalPriority::MEDIUM_EXT);
+                    bool                       family_must_support_protected_memory_ops(false);
+                    VkDeviceQueueCreateInfo    queue_create_info;
 
-                    if (current_queue_fam.n_queues > 0)
+                    if (current_queue_fam.n_queues == 0)
                     {
-                        int32_t n_queue_consumed_last = -1;
+                        continue;
+                    }
 
-                        for (uint32_t n_queue = 0;
-                                      n_queue < current_queue_fam.n_queues;
-                                    ++n_queue)
+                    for (uint32_t n_queue = 0;
+                                  n_queue < current_queue_fam.n_queues;
+                                ++n_queue)
+                    {
+                        const auto current_queue_global_priority = m_create_info_ptr->get_queue_global_priority(n_queue_fam,
+                                                                                                                n_queue);
+
+                        /* NOTE: VK_QUEUE_GLOBAL_PRIORITY_*_EXT values grow with priority */
+                        if (static_cast<uint32_t>(current_queue_global_priority) > static_cast<uint32_t>(family_global_priority) )
+                        {
+                            family_global_priority = current_queue_global_priority;
+                        }
+
+                        if (m_create_info_ptr->get_queue_must_support_protected_memory_operations(n_queue_fam,
+                                                                                                  n_queue) )
                         {
-                            const auto& current_queue_global_priority                   = m_create_info_ptr->get_queue_global_priority                         (n_queue_fam,
-                                                                                                                                                                n_queue);
-                            const bool  current_queue_must_support_protected_memory_ops = m_create_info_ptr->get_queue_must_support_protected_memory_operations(n_queue_fam,
-                                                                                                                                                                n_queue);
-
-                            if (current_queue_must_support_protected_memory_ops                                                          ||
-                                current_queue_global_priority                   != Anvil::QueueGlobalPriority::MEDIUM_EXT                ||
-                                n_queue                                         == static_cast<uint32_t>(current_queue_fam.n_queues - 1) )
-                            {
-                                VkDeviceQueueCreateInfo queue_create_info;
-
-                                queue_create_info.flags            = 0;
-                                queue_create_info.pNext            = nullptr;
-                                queue_create_info.pQueuePriorities = &device_queue_priorities.at(n_queues_defined_so_far);
-                                queue_create_info.queueCount       = (n_queue - n_queue_consumed_last);
-                                queue_create_info.queueFamilyIndex = n_queue_fam;
-                                queue_create_info.sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-
-                                if (current_queue_must_support_protected_memory_ops)
-                                {
-                                    queue_create_info.flags |= VK_DEVICE_QUEUE_CREATE_PROTECTED_BIT;
-                                }
-
-                                if (current_queue_global_priority == Anvil::QueueGlobalPriority::HIGH_EXT     ||
-                                    current_queue_global_priority == Anvil::QueueGlobalPriority::LOW_EXT      ||
-                                    current_queue_global_priority == Anvil::QueueGlobalPriority::REALTIME_EXT)
-                                {
-                                    queue_create_info.pNext = (current_queue_global_priority == Anvil::QueueGlobalPriority::HIGH_EXT) ? &high_priority_create_info
-                                                            : (current_queue_global_priority == Anvil::QueueGlobalPriority::LOW_EXT)  ? &low_priority_create_info
-                                                                                                                                      : &realtime_priority_create_info;
-                                }
-                                else
-                                {
-                                    anvil_assert(current_queue_global_priority == Anvil::QueueGlobalPriority::MEDIUM_EXT);
-                                }
-
-                                device_queue_create_info_items.push_back(queue_create_info);
-
-                                n_queue_consumed_last    = static_cast<int32_t>(n_queue);
-                                n_queues_defined_so_far += (n_queue - n_queue_consumed_last);
-                            }
+                            family_must_support_protected_memory_ops = true;
                         }
+                    }
+
+                    queue_create_info.flags            = (family_must_support_protected_memory_ops) ? VK_DEVICE_QUEUE_CREATE_PROTECTED_BIT
+                                                                                                    : 0;
+                    queue_create_info.pNext            = nullptr;
+                    queue_create_info.pQueuePriorities = &device_queue_priorities.at(n_queues_defined_so_far);
+                    queue_create_info.queueCount       = current_queue_fam.n_queues;
+                    queue_create_info.queueFamilyIndex = n_queue_fam;
+                    queue_create_info.sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
 
+                    if (family_global_priority != Anvil::QueueGlobalPriority::MEDIUM_EXT)
+                    {
+                        anvil_assert(is_global_priority_enabled);
+
+                        if (is_global_priority_enabled)
+                        {
+                            queue_create_info.pNext = (family_global_priority == Anvil::QueueGlobalPriority::HIGH_EXT) ? &high_priority_create_info
+                                                    : (family_global_priority == Anvil::QueueGlobalPriority::LOW_EXT)  ? &low_priority_create_info
+                                                                                                                       : &realtime_priority_create_info;
+
+                            m_queue_family_global_priorities.at(n_queue_fam) = family_global_priority;
+                        }
                     }
+
+                    device_queue_create_info_items.push_back(queue_create_info);
+
+                    n_queues_defined_so_far += current_queue_fam.n_queues;
                 }
             }
 
@@ -309,9 +396,32 @@ void Anvil::BaseDevice::create_device(const std::vector<const char*>& in_extensi
 
         result = Anvil::Vulkan::vkCreateDevice(physical_device_ptrs.at(0)->get_physical_device(),
                                                struct_chain_ptr->get_root_struct(),
-                                               nullptr, /* pAllocator */
+                                               m_allocation_callbacks_vk_ptr,
                                               &m_device);
 
+        if (result == VK_ERROR_NOT_PERMITTED_EXT)
+        {
+            /* The process lacks privileges to use one of the requested global priorities. Fall back to the default
+             * global priority for all queues rather than fail the device creation. */
+            auto queue_create_info_ptrs = const_cast<VkDeviceQueueCreateInfo*>(struct_chain_ptr->get_root_struct()->pQueueCreateInfos);
+
+            for (uint32_t n_queue_create_info = 0;
+                          n_queue_create_info < struct_chain_ptr->get_root_struct()->queueCreateInfoCount;
+                        ++n_queue_create_info)
+            {
+                queue_create_info_ptrs[n_queue_create_info].pNext = nullptr;
+            }
+
+            std::fill(m_queue_family_global_priorities.begin(),
+                      m_queue_family_global_priorities.end  (),
+                      Anvil::QueueGlobalPriority::MEDIUM_EXT);
+
+            result = Anvil::Vulkan::vkCreateDevice(physical_device_ptrs.at(0)->get_physical_device(),
+                                                   struct_chain_ptr->get_root_struct(),
+                                                   m_allocation_callbacks_vk_ptr,
+                                                  &m_device);
+        }
+
         anvil_assert_vk_call_succeeded(result);
     }
 
@@ -320,6 +430,66 @@ void Anvil::BaseDevice::create_device(const std::vector<const char*>& in_extensi
                                                  out_queue_families_ptr);
 }
 
+/** Please see header for specification */
+Anvil::BackgroundWorkScheduler* Anvil::BaseDevice::get_background_work_scheduler() const
+{
+    std::unique_lock<std::mutex> lock(m_background_work_scheduler_mutex);
+
+    if (m_background_work_scheduler_ptr == nullptr)
+    {
+        m_background_work_scheduler_ptr = Anvil::BackgroundWorkScheduler::create();
+
+        anvil_assert(m_background_work_scheduler_ptr != nullptr);
+    }
+
+    return m_background_work_scheduler_ptr.get();
+}
+
+/** Please see header for specification */
+Anvil::CompletionService* Anvil::BaseDevice::get_completion_service() const
+{
+    std::unique_lock<std::mutex> lock(m_completion_service_mutex);
+
+    if (m_completion_service_ptr == nullptr)
+    {
+        m_completion_service_ptr = Anvil::CompletionService::create(this);
+
+        anvil_assert(m_completion_service_ptr != nullptr);
+    }
+
+    return m_completion_service_ptr.get();
+}
+
+/** Please see header for specification */
+Anvil::DeferredDeletionQueue* Anvil::BaseDevice::get_deferred_deletion_queue() const
+{
+    std::unique_lock<std::mutex> lock(m_deferred_deletion_queue_mutex);
+
+    if (m_deferred_deletion_queue_ptr == nullptr)
+    {
+        m_deferred_deletion_queue_ptr = Anvil::DeferredDeletionQueue::create(this);
+
+        anvil_assert(m_deferred_deletion_queue_ptr != nullptr);
+    }
+
+    return m_deferred_deletion_queue_ptr.get();
+}
+
+/** Please see header for specification */
+Anvil::DescriptorPoolSizingProfile* Anvil::BaseDevice::get_descriptor_pool_sizing_profile() const
+{
+    std::unique_lock<std::mutex> lock(m_descriptor_pool_sizing_profile_mutex);
+
+    if (m_descriptor_pool_sizing_profile_ptr == nullptr)
+    {
+        m_descriptor_pool_sizing_profile_ptr = Anvil::DescriptorPoolSizingProfile::create();
+
+        anvil_assert(m_descriptor_pool_sizing_profile_ptr != nullptr);
+    }
+
+    return m_descriptor_pool_sizing_profile_ptr.get();
+}
+
 /** Please see header for specification */
 const Anvil::DescriptorSet* Anvil::BaseDevice::get_dummy_descriptor_set() const
 {
@@ -349,6 +519,7 @@ Anvil::DescriptorSetLayout* Anvil::BaseDevice::get_dummy_descriptor_set_layout()
 const Anvil::ExtensionEXTSampleLocationsEntrypoints& Anvil::BaseDevice::get_extension_ext_sample_locations_entrypoints() const
 {
     anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->ext_sample_locations() );
+    resolve_extension_func_ptrs();
 
     return m_ext_sample_locations_extension_entrypoints;
 }
@@ -356,6 +527,7 @@ const Anvil::ExtensionEXTSampleLocationsEntrypoints& Anvil::BaseDevice::get_exte
 const Anvil::ExtensionEXTTransformFeedbackEntrypoints& Anvil::BaseDevice::get_extension_ext_transform_feedback_entrypoints() const
 {
     anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->ext_transform_feedback() );
+    resolve_extension_func_ptrs();
 
     return m_ext_transform_feedback_extension_entrypoints;
 }
@@ -397,9 +569,11 @@ bool Anvil::BaseDevice::get_memory_types_supported_for_external_handle(const Anv
                 goto end;
             }
 
-            if (in_external_handle_type != Anvil::ExternalMemoryHandleTypeFlagBits::OPAQUE_FD_BIT)
+            if (in_external_handle_type != Anvil::ExternalMemoryHandleTypeFlagBits::DMA_BUF_BIT_EXT                     ||
+                !m_extension_enabled_info_ptr->get_device_extension_info()->ext_external_memory_dma_buf() )
             {
-                anvil_assert(in_external_handle_type == Anvil::ExternalMemoryHandleTypeFlagBits::OPAQUE_FD_BIT);
+                anvil_assert(in_external_handle_type == Anvil::ExternalMemoryHandleTypeFlagBits::DMA_BUF_BIT_EXT);
+                anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->ext_external_memory_dma_buf() );
 
                 goto end;
             }
@@ -420,15 +594,15 @@ bool Anvil::BaseDevice::get_memory_types_supported_for_external_handle(const Anv
         #endif
 
         #if defined(_WIN32)
-            if (m_khr_external_memory_win32_extension_entrypoints.vkGetMemoryWin32HandlePropertiesKHR(m_device,
-                                                                                                      static_cast<VkExternalMemoryHandleTypeFlagBits>(in_external_handle_type),
-                                                                                                      in_handle,
-                                                                                                     &result_props) != VK_SUCCESS)
+            if (get_extension_khr_external_memory_win32_entrypoints().vkGetMemoryWin32HandlePropertiesKHR(m_device,
+                                                                                                          static_cast<VkExternalMemoryHandleTypeFlagBits>(in_external_handle_type),
+                                                                                                          in_handle,
+                                                                                                         &result_props) != VK_SUCCESS)
         #else
-            if (m_khr_external_memory_fd_extension_entrypoints.vkGetMemoryFdPropertiesKHR(m_device,
-                                                                                          static_cast<VkExternalMemoryHandleTypeFlagBits>(in_external_handle_type),
-                                                                                          in_handle,
-                                                                                         &result_props) != VK_SUCCESS)
+            if (get_extension_khr_external_memory_fd_entrypoints().vkGetMemoryFdPropertiesKHR(m_device,
+                                                                                              static_cast<VkExternalMemoryHandleTypeFlagBits>(in_external_handle_type),
+                                                                                              in_handle,
+                                                                                             &result_props) != VK_SUCCESS)
         #endif
         {
             anvil_assert_fail();
@@ -454,10 +628,10 @@ bool Anvil::BaseDevice::get_memory_types_supported_for_external_handle(const Anv
         result_props.pNext = nullptr;
         result_props.sType = VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT;
 
-        if (m_ext_external_memory_host_extension_entrypoints.vkGetMemoryHostPointerPropertiesEXT(m_device,
-                                                                                                 static_cast<VkExternalMemoryHandleTypeFlagBits>(in_external_handle_type),
-                                                                                                 reinterpret_cast<const void*>(in_handle),
-                                                                                                &result_props) != VK_SUCCESS)
+        if (get_extension_ext_external_memory_host_entrypoints().vkGetMemoryHostPointerPropertiesEXT(m_device,
+                                                                                                     static_cast<VkExternalMemoryHandleTypeFlagBits>(in_external_handle_type),
+                                                                                                     reinterpret_cast<const void*>(in_handle),
+                                                                                                    &result_props) != VK_SUCCESS)
         {
             anvil_assert_fail();
 
@@ -473,6 +647,53 @@ end:
     return result;
 }
 
+/** Please see header for specification */
+bool Anvil::BaseDevice::get_memory_types_supported_for_host_pointer(const Anvil::ExternalMemoryHandleTypeFlagBits& in_external_handle_type,
+                                                                    const void*                                    in_host_ptr,
+                                                                    uint32_t*                                      out_supported_memory_type_bits_ptr) const
+{
+    VkMemoryHostPointerPropertiesEXT result_props;
+    bool                             result       = false;
+
+    /* Sanity checks */
+    if (!m_extension_enabled_info_ptr->get_device_extension_info()->ext_external_memory_host() )
+    {
+        anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->ext_external_memory_host() );
+
+        goto end;
+    }
+
+    if (in_external_handle_type != Anvil::ExternalMemoryHandleTypeFlagBits::HOST_ALLOCATION_BIT_EXT             &&
+        in_external_handle_type != Anvil::ExternalMemoryHandleTypeFlagBits::HOST_MAPPED_FOREIGN_MEMORY_BIT_EXT)
+    {
+        anvil_assert(in_external_handle_type == Anvil::ExternalMemoryHandleTypeFlagBits::HOST_ALLOCATION_BIT_EXT             ||
+                     in_external_handle_type == Anvil::ExternalMemoryHandleTypeFlagBits::HOST_MAPPED_FOREIGN_MEMORY_BIT_EXT);
+
+        goto end;
+    }
+
+    anvil_assert(in_host_ptr != nullptr);
+
+    /* Go ahead with the query */
+    result_props.pNext = nullptr;
+    result_props.sType = VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT;
+
+    if (get_extension_ext_external_memory_host_entrypoints().vkGetMemoryHostPointerPropertiesEXT(m_device,
+                                                                                                 static_cast<VkExternalMemoryHandleTypeFlagBits>(in_external_handle_type),
+                                                                                                 in_host_ptr,
+                                                                                                &result_props) != VK_SUCCESS)
+    {
+        goto end;
+    }
+
+    *out_supported_memory_type_bits_ptr = result_props.memoryTypeBits;
+
+    /* All done */
+    result = true;
+end:
+    return result;
+}
+
 /** Please see header for specification */
 uint32_t Anvil::BaseDevice::get_n_queues(uint32_t in_n_queue_family) const
 {
@@ -487,6 +708,182 @@ uint32_t Anvil::BaseDevice::get_n_queues(uint32_t in_n_queue_family) const
     return result;
 }
 
+/* Please see header for specification */
+Anvil::EventUniquePtr Anvil::BaseDevice::acquire_event() const
+{
+    {
+        std::unique_lock<std::mutex> lock(m_sync_object_pools_mutex);
+
+        if (m_event_pool_ptr == nullptr)
+        {
+            m_event_pool_ptr = Anvil::EventPool::create(this,
+                                                        0, /* in_n_preallocated_items */
+                                                        is_mt_safe() );
+        }
+    }
+
+    return m_event_pool_ptr->get_item();
+}
+
+/* Please see header for specification */
+Anvil::FenceUniquePtr Anvil::BaseDevice::acquire_fence() const
+{
+    {
+        std::unique_lock<std::mutex> lock(m_sync_object_pools_mutex);
+
+        if (m_fence_pool_ptr == nullptr)
+        {
+            m_fence_pool_ptr = Anvil::FencePool::create(this,
+                                                        0, /* in_n_preallocated_items */
+                                                        is_mt_safe() );
+        }
+    }
+
+    return m_fence_pool_ptr->get_item();
+}
+
+/* Please see header for specification */
+Anvil::SemaphoreUniquePtr Anvil::BaseDevice::acquire_semaphore() const
+{
+    {
+        std::unique_lock<std::mutex> lock(m_sync_object_pools_mutex);
+
+        if (m_semaphore_pool_ptr == nullptr)
+        {
+            m_semaphore_pool_ptr = Anvil::SemaphorePool::create(this,
+                                                                0, /* in_n_preallocated_items */
+                                                                is_mt_safe() );
+        }
+    }
+
+    return m_semaphore_pool_ptr->get_item();
+}
+
+/** Please see header for specification */
+bool Anvil::BaseDevice::get_calibrateable_time_domains(std::vector<Anvil::TimeDomainEXT>* out_time_domains_ptr) const
+{
+    uint32_t                     n_time_domains = 0;
+    bool                         result         = false;
+    VkResult                     result_vk;
+    std::vector<VkTimeDomainEXT> time_domains_vk;
+
+    anvil_assert(out_time_domains_ptr != nullptr);
+
+    if (!m_extension_enabled_info_ptr->get_device_extension_info()->ext_calibrated_timestamps() )
+    {
+        anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->ext_calibrated_timestamps() );
+
+        goto end;
+    }
+
+    {
+        const auto&            entrypoints        = get_extension_ext_calibrated_timestamps_entrypoints();
+        const VkPhysicalDevice physical_device_vk = m_create_info_ptr->get_physical_device_ptrs().at(0)->get_physical_device();
+
+        result_vk = entrypoints.vkGetPhysicalDeviceCalibrateableTimeDomainsEXT(physical_device_vk,
+                                                                               &n_time_domains,
+                                                                               nullptr); /* pTimeDomains */
+
+        if (!is_vk_call_successful(result_vk) )
+        {
+            anvil_assert_vk_call_succeeded(result_vk);
+
+            goto end;
+        }
+
+        time_domains_vk.resize(n_time_domains);
+
+        if (n_time_domains > 0)
+        {
+            result_vk = entrypoints.vkGetPhysicalDeviceCalibrateableTimeDomainsEXT(physical_device_vk,
+                                                                                   &n_time_domains,
+                                                                                   &time_domains_vk.at(0) );
+
+            if (!is_vk_call_successful(result_vk) )
+            {
+                anvil_assert_vk_call_succeeded(result_vk);
+
+                goto end;
+            }
+        }
+    }
+
+    out_time_domains_ptr->clear();
+
+    for (uint32_t n_time_domain = 0;
+                  n_time_domain < n_time_domains;
+                ++n_time_domain)
+    {
+        out_time_domains_ptr->push_back(static_cast<Anvil::TimeDomainEXT>(time_domains_vk.at(n_time_domain) ));
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::BaseDevice::get_calibrated_timestamps(const std::vector<Anvil::TimeDomainEXT>& in_time_domains,
+                                                  std::vector<uint64_t>*                out_timestamps_ptr,
+                                                  uint64_t*                             out_opt_max_deviation_ptr) const
+{
+    std::vector<VkCalibratedTimestampInfoEXT> info_items_vk;
+    uint64_t                                  max_deviation = 0;
+    bool                                      result        = false;
+    VkResult                                  result_vk;
+
+    anvil_assert(out_timestamps_ptr != nullptr);
+
+    if (!m_extension_enabled_info_ptr->get_device_extension_info()->ext_calibrated_timestamps() )
+    {
+        anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->ext_calibrated_timestamps() );
+
+        goto end;
+    }
+
+    if (in_time_domains.size() == 0)
+    {
+        anvil_assert(in_time_domains.size() != 0);
+
+        goto end;
+    }
+
+    for (const auto& current_time_domain : in_time_domains)
+    {
+        VkCalibratedTimestampInfoEXT info_vk;
+
+        info_vk.pNext      = nullptr;
+        info_vk.sType      = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+        info_vk.timeDomain = static_cast<VkTimeDomainEXT>(current_time_domain);
+
+        info_items_vk.push_back(info_vk);
+    }
+
+    out_timestamps_ptr->resize(in_time_domains.size() );
+
+    result_vk = get_extension_ext_calibrated_timestamps_entrypoints().vkGetCalibratedTimestampsEXT(m_device,
+                                                                                                   static_cast<uint32_t>(info_items_vk.size() ),
+                                                                                                  &info_items_vk.at(0),
+                                                                                                  &out_timestamps_ptr->at(0),
+                                                                                                  &max_deviation);
+
+    if (!is_vk_call_successful(result_vk) )
+    {
+        anvil_assert_vk_call_succeeded(result_vk);
+
+        goto end;
+    }
+
+    if (out_opt_max_deviation_ptr != nullptr)
+    {
+        *out_opt_max_deviation_ptr = max_deviation;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
 /* Please see header for specification */
 void Anvil::BaseDevice::add_physical_device_features_to_chainer(Anvil::StructChainer<VkDeviceCreateInfo>* in_struct_chainer_ptr) const
 {
@@ -506,6 +903,11 @@ void Anvil::BaseDevice::add_physical_device_features_to_chainer(Anvil::StructCha
         in_struct_chainer_ptr->append_struct(features_khr);
     }
 
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->ext_conditional_rendering() )
+    {
+        in_struct_chainer_ptr->append_struct(features.ext_conditional_rendering_features_ptr->get_vk_physical_device_conditional_rendering_features() );
+    }
+
     if (m_extension_enabled_info_ptr->get_device_extension_info()->ext_depth_clip_enable() )
     {
         in_struct_chainer_ptr->append_struct(features.ext_depth_clip_enable_features_ptr->get_vk_physical_device_depth_clip_enable_features() );
@@ -516,6 +918,16 @@ void Anvil::BaseDevice::add_physical_device_features_to_chainer(Anvil::StructCha
         in_struct_chainer_ptr->append_struct(features.ext_descriptor_indexing_features_ptr->get_vk_physical_device_descriptor_indexing_features() );
     }
 
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->ext_host_image_copy() )
+    {
+        in_struct_chainer_ptr->append_struct(features.ext_host_image_copy_features_ptr->get_vk_physical_device_host_image_copy_features() );
+    }
+
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->ext_host_query_reset() )
+    {
+        in_struct_chainer_ptr->append_struct(features.ext_host_query_reset_features_ptr->get_vk_physical_device_host_query_reset_features() );
+    }
+
     if (m_extension_enabled_info_ptr->get_device_extension_info()->ext_inline_uniform_block() )
     {
         in_struct_chainer_ptr->append_struct(features.ext_inline_uniform_block_features_ptr->get_vk_physical_device_inline_uniform_block_features() );
@@ -526,11 +938,31 @@ void Anvil::BaseDevice::add_physical_device_features_to_chainer(Anvil::StructCha
         in_struct_chainer_ptr->append_struct(features.ext_memory_priority_features_ptr->get_vk_physical_device_memory_priority_features() );
     }
 
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_acceleration_structure() )
+    {
+        in_struct_chainer_ptr->append_struct(features.khr_acceleration_structure_features_ptr->get_vk_physical_device_acceleration_structure_features() );
+    }
+
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_buffer_device_address() )
+    {
+        in_struct_chainer_ptr->append_struct(features.khr_buffer_device_address_features_ptr->get_vk_physical_device_buffer_device_address_features() );
+    }
+
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->ext_pageable_device_local_memory() )
+    {
+        in_struct_chainer_ptr->append_struct(features.ext_pageable_device_local_memory_features_ptr->get_vk_physical_device_pageable_device_local_memory_features() );
+    }
+
     if (m_extension_enabled_info_ptr->get_device_extension_info()->ext_scalar_block_layout() )
     {
         in_struct_chainer_ptr->append_struct(features.ext_scalar_block_layout_features_ptr->get_vk_physical_device_scalar_block_layout_features_ext() );
     }
 
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->ext_subgroup_size_control() )
+    {
+        in_struct_chainer_ptr->append_struct(features.ext_subgroup_size_control_features_ptr->get_vk_physical_device_subgroup_size_control_features() );
+    }
+
     if (m_extension_enabled_info_ptr->get_device_extension_info()->ext_transform_feedback() )
     {
         in_struct_chainer_ptr->append_struct(features.ext_transform_feedback_features_ptr->get_vk_physical_device_transform_feedback_features() );
@@ -546,11 +978,26 @@ void Anvil::BaseDevice::add_physical_device_features_to_chainer(Anvil::StructCha
         in_struct_chainer_ptr->append_struct(features.khr_8bit_storage_features_ptr->get_vk_physical_device_8_bit_storage_features() );
     }
 
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_dynamic_rendering() )
+    {
+        in_struct_chainer_ptr->append_struct(features.khr_dynamic_rendering_features_ptr->get_vk_physical_device_dynamic_rendering_features() );
+    }
+
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_imageless_framebuffer() )
+    {
+        in_struct_chainer_ptr->append_struct(features.khr_imageless_framebuffer_features_ptr->get_vk_physical_device_imageless_framebuffer_features() );
+    }
+
     if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_multiview() )
     {
         in_struct_chainer_ptr->append_struct(features.khr_multiview_features_ptr->get_vk_physical_device_multiview_features() );
     }
 
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_pipeline_executable_properties() )
+    {
+        in_struct_chainer_ptr->append_struct(features.khr_pipeline_executable_properties_features_ptr->get_vk_physical_device_pipeline_executable_properties_features() );
+    }
+
     if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_sampler_ycbcr_conversion() )
     {
         in_struct_chainer_ptr->append_struct(features.khr_sampler_ycbcr_conversion_features_ptr->get_vk_physical_device_sampler_ycbcr_conversion_features() );
@@ -566,6 +1013,11 @@ void Anvil::BaseDevice::add_physical_device_features_to_chainer(Anvil::StructCha
         in_struct_chainer_ptr->append_struct(features.khr_float16_int8_features_ptr->get_vk_physical_device_float16_int8_features() );
     }
 
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_timeline_semaphore() )
+    {
+        in_struct_chainer_ptr->append_struct(features.khr_timeline_semaphore_features_ptr->get_vk_physical_device_timeline_semaphore_features() );
+    }
+
     if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_variable_pointers() )
     {
         in_struct_chainer_ptr->append_struct(features.khr_variable_pointer_features_ptr->get_vk_physical_device_variable_pointer_features() );
@@ -575,6 +1027,16 @@ void Anvil::BaseDevice::add_physical_device_features_to_chainer(Anvil::StructCha
     {
         in_struct_chainer_ptr->append_struct(features.khr_vulkan_memory_model_features_ptr->get_vk_physical_device_vulkan_memory_model_features() );
     }
+
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->nv_mesh_shader() )
+    {
+        in_struct_chainer_ptr->append_struct(features.nv_mesh_shader_features_ptr->get_vk_physical_device_mesh_shader_features() );
+    }
+
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->nv_shading_rate_image() )
+    {
+        in_struct_chainer_ptr->append_struct(features.nv_shading_rate_image_features_ptr->get_vk_physical_device_shading_rate_image_features() );
+    }
 }
 
 /* Please see header for specification */
@@ -584,7 +1046,47 @@ const Anvil::Instance* Anvil::BaseDevice::get_parent_instance() const
 }
 
 /* Please see header for specification */
+Anvil::Queue* Anvil::BaseDevice::get_high_priority_queue(const Anvil::QueueFamilyType& in_queue_family_type) const
+{
+    const std::vector<Anvil::Queue*>* queues_ptr      = nullptr;
+    float                             result_priority = 0.0f;
+    Anvil::Queue*                     result_ptr      = nullptr;
 
+    switch (in_queue_family_type)
+    {
+        case Anvil::QueueFamilyType::COMPUTE:   queues_ptr = &m_compute_queues;   break;
+        case Anvil::QueueFamilyType::TRANSFER:  queues_ptr = &m_transfer_queues;  break;
+        case Anvil::QueueFamilyType::UNIVERSAL: queues_ptr = &m_universal_queues; break;
+
+        default:
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    for (const auto& current_queue_ptr : *queues_ptr)
+    {
+        const float current_priority = m_create_info_ptr->get_queue_priority(current_queue_ptr->get_queue_family_index(),
+                                                                             current_queue_ptr->get_queue_index       () );
+
+        /* NOTE: VK_QUEUE_GLOBAL_PRIORITY_*_EXT values grow with priority */
+        if ( result_ptr == nullptr                                                                                                                    ||
+             static_cast<uint32_t>(current_queue_ptr->get_queue_global_priority() ) >  static_cast<uint32_t>(result_ptr->get_queue_global_priority() ) ||
+            (static_cast<uint32_t>(current_queue_ptr->get_queue_global_priority() ) == static_cast<uint32_t>(result_ptr->get_queue_global_priority() ) &&
+             current_priority                                                       >  result_priority) )
+        {
+            result_priority = current_priority;
+            result_ptr      = current_queue_ptr;
+        }
+    }
+
+end:
+    return result_ptr;
+}
+
+/* Please see header for specification */
 Anvil::Queue* Anvil::BaseDevice::get_queue(const Anvil::QueueFamilyType& in_queue_family_type,
                                            uint32_t                      in_n_queue) const
 {
@@ -870,47 +1372,270 @@ bool Anvil::BaseDevice::get_sample_locations(Anvil::SampleCountFlagBits   in_sam
             out_result_ptr->push_back(SampleLocation(0.875f,   0.9375f) );
             out_result_ptr->push_back(SampleLocation(0.0625f,  0.0f)    );
 
-            break;
-        }
+            break;
+        }
+
+        default:
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::FramebufferCache* Anvil::BaseDevice::get_framebuffer_cache() const
+{
+    std::unique_lock<std::mutex> lock(m_framebuffer_cache_mutex);
+
+    if (m_framebuffer_cache_ptr == nullptr)
+    {
+        m_framebuffer_cache_ptr = Anvil::FramebufferCache::create(this);
+
+        anvil_assert(m_framebuffer_cache_ptr != nullptr);
+    }
+
+    return m_framebuffer_cache_ptr.get();
+}
+
+/** Please see header for specification */
+Anvil::RenderPassCache* Anvil::BaseDevice::get_render_pass_cache() const
+{
+    std::unique_lock<std::mutex> lock(m_render_pass_cache_mutex);
+
+    if (m_render_pass_cache_ptr == nullptr)
+    {
+        m_render_pass_cache_ptr = Anvil::RenderPassCache::create(this);
+
+        anvil_assert(m_render_pass_cache_ptr != nullptr);
+    }
+
+    return m_render_pass_cache_ptr.get();
+}
+
+/** Please see header for specification */
+Anvil::SamplerCache* Anvil::BaseDevice::get_sampler_cache() const
+{
+    std::unique_lock<std::mutex> lock(m_sampler_cache_mutex);
+
+    if (m_sampler_cache_ptr == nullptr)
+    {
+        m_sampler_cache_ptr = Anvil::SamplerCache::create(this);
+
+        anvil_assert(m_sampler_cache_ptr != nullptr);
+    }
+
+    return m_sampler_cache_ptr.get();
+}
+
+/* Please see header for specification */
+Anvil::Queue* Anvil::BaseDevice::get_sparse_binding_queue(uint32_t          in_n_queue,
+                                                          Anvil::QueueFlags in_opt_required_queue_flags) const
+{
+    uint32_t      n_queues_found = 0;
+    Anvil::Queue* result_ptr     = nullptr;
+
+    for (auto queue_ptr : m_sparse_binding_queues)
+    {
+        const uint32_t queue_family_index    = queue_ptr->get_queue_family_index();
+        const auto&    queue_family_info_ptr = get_queue_family_info            (queue_family_index);
+
+        if ((queue_family_info_ptr->flags & in_opt_required_queue_flags) == in_opt_required_queue_flags)
+        {
+            if (n_queues_found == in_n_queue)
+            {
+                result_ptr = queue_ptr;
+                break;
+            }
+            else
+            {
+                ++n_queues_found;
+            }
+        }
+    }
+
+    return result_ptr;
+}
+
+/* Please see header for specification */
+Anvil::StagingRing* Anvil::BaseDevice::get_staging_ring() const
+{
+    std::unique_lock<std::mutex> lock(m_staging_ring_mutex);
+
+    if (m_staging_ring_ptr                        == nullptr &&
+        m_create_info_ptr->get_staging_ring_size() >  0)
+    {
+        m_staging_ring_ptr = Anvil::StagingRing::create(this,
+                                                        m_create_info_ptr->get_staging_ring_size() );
+
+        anvil_assert(m_staging_ring_ptr != nullptr);
+    }
+
+    return m_staging_ring_ptr.get();
+}
+
+/** Please see header for specification */
+Anvil::TaskScheduler* Anvil::BaseDevice::get_task_scheduler() const
+{
+    Anvil::TaskScheduler*        result_ptr = m_create_info_ptr->get_task_scheduler();
+    std::unique_lock<std::mutex> lock;
+
+    if (result_ptr != nullptr)
+    {
+        goto end;
+    }
+
+    lock = std::unique_lock<std::mutex>(m_task_scheduler_mutex);
+
+    if (m_task_scheduler_ptr == nullptr)
+    {
+        m_task_scheduler_ptr = Anvil::WorkStealingTaskScheduler::create();
+
+        anvil_assert(m_task_scheduler_ptr != nullptr);
+    }
+
+    result_ptr = m_task_scheduler_ptr.get();
+
+end:
+    return result_ptr;
+}
+
+/** Please see header for specification */
+bool Anvil::BaseDevice::get_timestamp_calibration(Anvil::TimestampCalibration* out_calibration_ptr) const
+{
+    #ifdef _WIN32
+        const Anvil::TimeDomainEXT host_time_domain = Anvil::TimeDomainEXT::QUERY_PERFORMANCE_COUNTER_EXT;
+    #else
+        const Anvil::TimeDomainEXT host_time_domain = Anvil::TimeDomainEXT::CLOCK_MONOTONIC_EXT;
+    #endif
 
-        default:
-        {
-            anvil_assert_fail();
+    const auto&                       limits        = get_physical_device_properties().core_vk1_0_properties_ptr->limits;
+    uint64_t                          max_deviation = 0;
+    bool                              result        = false;
+    std::vector<uint64_t>             timestamps;
+    std::vector<Anvil::TimeDomainEXT> time_domains;
 
-            goto end;
-        }
+    anvil_assert(out_calibration_ptr != nullptr);
+
+    time_domains.push_back(Anvil::TimeDomainEXT::DEVICE_EXT);
+    time_domains.push_back(host_time_domain);
+
+    if (!get_calibrated_timestamps(time_domains,
+                                  &timestamps,
+                                  &max_deviation) )
+    {
+        goto end;
     }
 
+    out_calibration_ptr->device_time_nsec   = static_cast<uint64_t>(static_cast<double>(timestamps.at(0) ) * static_cast<double>(limits.timestamp_period) );
+    out_calibration_ptr->host_timestamp     = timestamps.at(1);
+    out_calibration_ptr->max_deviation_nsec = max_deviation;
+
+    result = true;
 end:
     return result;
 }
 
 /* Please see header for specification */
-Anvil::Queue* Anvil::BaseDevice::get_sparse_binding_queue(uint32_t          in_n_queue,
-                                                          Anvil::QueueFlags in_opt_required_queue_flags) const
+void Anvil::BaseDevice::get_thread_command_pool_stats(std::map<std::thread::id, std::vector<Anvil::CommandPoolStats> >* out_stats_ptr) const
 {
-    uint32_t      n_queues_found = 0;
-    Anvil::Queue* result_ptr     = nullptr;
+    std::unique_lock<std::mutex> lock(m_thread_command_pools_mutex);
 
-    for (auto queue_ptr : m_sparse_binding_queues)
+    anvil_assert(out_stats_ptr != nullptr);
+
+    out_stats_ptr->clear();
+
+    for (const auto& current_thread_pools : m_thread_command_pools)
     {
-        const uint32_t queue_family_index    = queue_ptr->get_queue_family_index();
-        const auto&    queue_family_info_ptr = get_queue_family_info            (queue_family_index);
+        auto& thread_stats = (*out_stats_ptr)[current_thread_pools.first];
 
-        if ((queue_family_info_ptr->flags & in_opt_required_queue_flags) == in_opt_required_queue_flags)
+        for (const auto& current_pool_ptr : current_thread_pools.second)
         {
-            if (n_queues_found == in_n_queue)
+            if (current_pool_ptr != nullptr)
             {
-                result_ptr = queue_ptr;
-                break;
+                thread_stats.push_back(current_pool_ptr->get_stats() );
             }
-            else
+        }
+    }
+}
+
+/* Please see header for specification */
+Anvil::CommandPool* Anvil::BaseDevice::get_thread_command_pool_for_queue_family_index(uint32_t in_vk_queue_family_index) const
+{
+    Anvil::CommandPool* result_ptr = nullptr;
+
+    for (const auto& current_cache_item : t_thread_command_pool_cache)
+    {
+        if (current_cache_item.registry_id        == m_thread_command_pools_registry_id &&
+            current_cache_item.queue_family_index == in_vk_queue_family_index)
+        {
+            result_ptr = current_cache_item.command_pool_ptr;
+
+            goto end;
+        }
+    }
+
+    if (in_vk_queue_family_index                                              >= m_command_pool_ptr_per_vk_queue_fam.size() ||
+        m_command_pool_ptr_per_vk_queue_fam.at(in_vk_queue_family_index) == nullptr)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    /* First request for this queue family from the calling thread. */
+    {
+        std::unique_lock<std::mutex> lock            (m_thread_command_pools_mutex);
+        auto&                        thread_pool_ptrs(m_thread_command_pools[std::this_thread::get_id()]);
+
+        if (thread_pool_ptrs.size() <= in_vk_queue_family_index)
+        {
+            thread_pool_ptrs.resize(in_vk_queue_family_index + 1);
+        }
+
+        if (thread_pool_ptrs.at(in_vk_queue_family_index) == nullptr)
+        {
+            thread_pool_ptrs.at(in_vk_queue_family_index) = Anvil::CommandPool::create(const_cast<Anvil::BaseDevice*>(this),
+                                                                                       m_create_info_ptr->get_helper_command_pool_create_flags(),
+                                                                                       in_vk_queue_family_index,
+                                                                                       Anvil::MTSafety::DISABLED);
+
+            if (thread_pool_ptrs.at(in_vk_queue_family_index) == nullptr)
             {
-                ++n_queues_found;
+                anvil_assert(thread_pool_ptrs.at(in_vk_queue_family_index) != nullptr);
+
+                goto end;
             }
+
+            thread_pool_ptrs.at(in_vk_queue_family_index)->set_trim_policy(m_thread_command_pools_trim_n_window_frames,
+                                                                           m_thread_command_pools_trim_usage_ratio);
         }
+
+        result_ptr = thread_pool_ptrs.at(in_vk_queue_family_index).get();
+    }
+
+    /* Drop items cached for devices which have since been released */
+    {
+        std::unique_lock<std::mutex> lock(g_live_thread_command_pool_registry_ids_mutex);
+
+        t_thread_command_pool_cache.erase(std::remove_if(t_thread_command_pool_cache.begin(),
+                                                         t_thread_command_pool_cache.end  (),
+                                                         [](const ThreadCommandPoolCacheItem& in_item)
+                                                         {
+                                                             return g_live_thread_command_pool_registry_ids.find(in_item.registry_id) == g_live_thread_command_pool_registry_ids.end();
+                                                         }),
+                                          t_thread_command_pool_cache.end() );
     }
 
+    t_thread_command_pool_cache.push_back(ThreadCommandPoolCacheItem(m_thread_command_pools_registry_id,
+                                                                     in_vk_queue_family_index,
+                                                                     result_ptr) );
+
+end:
     return result_ptr;
 }
 
@@ -922,8 +1647,22 @@ bool Anvil::BaseDevice::init()
     std::map<std::string, bool> extensions_final_enabled_status;
     const bool                  is_validation_enabled(parent_instance_ptr->is_validation_enabled() );
     std::vector<const char*>    layers_final;
+    uint64_t                    last_phase_end_time_nsec(0);
     const auto                  mt_safety            (Anvil::Utils::convert_boolean_to_mt_safety_enum(is_mt_safe()) );
     bool                        result               (false);
+    Anvil::Time                 timer;
+
+    auto end_startup_phase = [&](const char* in_phase_name)
+    {
+        const uint64_t current_time_nsec = timer.get_time_in_nsec();
+
+        m_startup_phase_timings.push_back(
+            Anvil::StartupPhaseTiming(in_phase_name,
+                                      current_time_nsec - last_phase_end_time_nsec)
+        );
+
+        last_phase_end_time_nsec = current_time_nsec;
+    };
 
     /* If validation is enabled, retrieve names of all suported validation layers and
      * append them to the list of layers the user has alreaedy specified. **/
@@ -1074,14 +1813,32 @@ bool Anvil::BaseDevice::init()
         }
     }
 
-    /* Retrieve device-specific func pointers */
-    if (!init_extension_func_ptrs() )
+    end_startup_phase("Device creation");
+
+    /* Retrieve device-level core func pointers. All core Vulkan calls Anvil issues against this device go through
+     * this table from now on. */
+    if (!init_dispatch_table() )
     {
         anvil_assert_fail();
 
         goto end;
     }
 
+    end_startup_phase("Core entry-point initialization");
+
+    /* Retrieve device-specific func pointers, unless the app has asked for this to be done on first use. */
+    if (!m_create_info_ptr->should_defer_extension_entrypoint_resolution() )
+    {
+        if (!resolve_extension_func_ptrs() )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        end_startup_phase("Extension entry-point initialization");
+    }
+
     /* Spawn queue wrappers */
     for (Anvil::QueueFamilyType queue_family_type = Anvil::QueueFamilyType::FIRST;
                                 queue_family_type < Anvil::QueueFamilyType::COUNT;
@@ -1122,8 +1879,7 @@ bool Anvil::BaseDevice::init()
                           n_queue < current_queue_fam.n_queues;
                         ++n_queue)
             {
-                const auto                    new_queue_global_priority = m_create_info_ptr->get_queue_global_priority(current_queue_fam.family_index,
-                                                                                                                       n_queue);
+                const auto                    new_queue_global_priority = m_queue_family_global_priorities.at         (current_queue_fam.family_index);
                 std::unique_ptr<Anvil::Queue> new_queue_ptr             = Anvil::Queue::create                        (this,
                                                                                                                        current_queue_fam.family_index,
                                                                                                                        n_queue,
@@ -1182,12 +1938,101 @@ bool Anvil::BaseDevice::init()
         }
     }
 
+    end_startup_phase("Queue and command pool initialization");
+
+    /* Fill format capability memo tables of the physical devices, if requested. */
+    if (m_create_info_ptr->should_prewarm_format_capability_cache() )
+    {
+        for (const auto& current_physical_device_ptr : m_create_info_ptr->get_physical_device_ptrs() )
+        {
+            current_physical_device_ptr->prewarm_format_capability_cache(m_create_info_ptr->get_format_capability_cache_prewarm_queries() );
+        }
+
+        end_startup_phase("Format capability cache prewarm");
+    }
+
     /* Set up shader module cache, if one was requested. */
     if (m_create_info_ptr->should_enable_shader_module_cache() )
     {
         m_shader_module_cache_ptr = Anvil::ShaderModuleCache::create();
     }
 
+    /* Cache shader definitions for enabled storage features, if requested. Anvil enables all features supported
+     * by an enabled extension, so it suffices to check the extension status & reported feature support. */
+    if (m_create_info_ptr->should_probe_storage_features() )
+    {
+        const auto& extension_info_ptr = m_extension_enabled_info_ptr->get_device_extension_info();
+        const auto& features           = get_physical_device_features();
+
+        if (extension_info_ptr->khr_16bit_storage()                &&
+            features.khr_16bit_storage_features_ptr != nullptr)
+        {
+            const auto& storage_16bit_features = *features.khr_16bit_storage_features_ptr;
+
+            if (storage_16bit_features.is_storage_buffer_16_bit_access_supported)
+            {
+                m_storage_feature_shader_definitions.push_back(std::make_pair("ANVIL_STORAGE_BUFFER_16BIT_ACCESS", "1") );
+            }
+
+            if (storage_16bit_features.is_uniform_and_storage_buffer_16_bit_access_supported)
+            {
+                m_storage_feature_shader_definitions.push_back(std::make_pair("ANVIL_UNIFORM_AND_STORAGE_BUFFER_16BIT_ACCESS", "1") );
+            }
+
+            if (storage_16bit_features.is_push_constant_16_bit_storage_supported)
+            {
+                m_storage_feature_shader_definitions.push_back(std::make_pair("ANVIL_STORAGE_PUSH_CONSTANT_16", "1") );
+            }
+
+            if (storage_16bit_features.is_input_output_storage_supported)
+            {
+                m_storage_feature_shader_definitions.push_back(std::make_pair("ANVIL_STORAGE_INPUT_OUTPUT_16", "1") );
+            }
+        }
+
+        if (extension_info_ptr->khr_8bit_storage()                &&
+            features.khr_8bit_storage_features_ptr != nullptr)
+        {
+            const auto& storage_8bit_features = *features.khr_8bit_storage_features_ptr;
+
+            if (storage_8bit_features.storage_buffer_8_bit_access)
+            {
+                m_storage_feature_shader_definitions.push_back(std::make_pair("ANVIL_STORAGE_BUFFER_8BIT_ACCESS", "1") );
+            }
+
+            if (storage_8bit_features.uniform_and_storage_buffer_8_bit_access)
+            {
+                m_storage_feature_shader_definitions.push_back(std::make_pair("ANVIL_UNIFORM_AND_STORAGE_BUFFER_8BIT_ACCESS", "1") );
+            }
+
+            if (storage_8bit_features.storage_push_constant_8)
+            {
+                m_storage_feature_shader_definitions.push_back(std::make_pair("ANVIL_STORAGE_PUSH_CONSTANT_8", "1") );
+            }
+        }
+
+        if (extension_info_ptr->khr_shader_float16_int8()         &&
+            features.khr_float16_int8_features_ptr != nullptr)
+        {
+            if (features.khr_float16_int8_features_ptr->shader_float16)
+            {
+                m_storage_feature_shader_definitions.push_back(std::make_pair("ANVIL_SHADER_FLOAT16", "1") );
+            }
+
+            if (features.khr_float16_int8_features_ptr->shader_int8)
+            {
+                m_storage_feature_shader_definitions.push_back(std::make_pair("ANVIL_SHADER_INT8", "1") );
+            }
+        }
+
+        if (extension_info_ptr->ext_scalar_block_layout()                 &&
+            features.ext_scalar_block_layout_features_ptr != nullptr      &&
+            features.ext_scalar_block_layout_features_ptr->scalar_block_layout)
+        {
+            m_storage_feature_shader_definitions.push_back(std::make_pair("ANVIL_SCALAR_BLOCK_LAYOUT", "1") );
+        }
+    }
+
     /* Set up the pipeline cache */
     {
         auto pipeline_cache_ptr = m_create_info_ptr->get_pipeline_cache_ptr();
@@ -1222,9 +2067,13 @@ bool Anvil::BaseDevice::init()
                                                                              true /* use_pipeline_cache */,
                                                                              m_pipeline_cache_ptr.get() );
 
+    end_startup_phase("Helper object initialization");
+
     /* Continue with specialized initialization */
     init_device();
 
+    end_startup_phase("Specialized device initialization");
+
     result = true;
 end:
     return result;
@@ -1269,6 +2118,208 @@ end:
     return result;
 }
 
+/** Please see header for specification */
+bool Anvil::BaseDevice::init_dispatch_table()
+{
+    const bool is_core_vk11_device(m_create_info_ptr->get_physical_device_ptrs().at(0)->supports_core_vk1_1() );
+    bool       result             (false);
+
+    typedef struct
+    {
+        const char* func_name;
+        void**      result_func_ptr;
+    } FunctionData;
+
+    const FunctionData functions_vk10[] =
+    {
+        {"vkDestroyDevice",                     reinterpret_cast<void**>(&m_dispatch_table.vkDestroyDevice)},
+        {"vkGetDeviceQueue",                    reinterpret_cast<void**>(&m_dispatch_table.vkGetDeviceQueue)},
+        {"vkQueueSubmit",                       reinterpret_cast<void**>(&m_dispatch_table.vkQueueSubmit)},
+        {"vkQueueWaitIdle",                     reinterpret_cast<void**>(&m_dispatch_table.vkQueueWaitIdle)},
+        {"vkDeviceWaitIdle",                    reinterpret_cast<void**>(&m_dispatch_table.vkDeviceWaitIdle)},
+        {"vkAllocateMemory",                    reinterpret_cast<void**>(&m_dispatch_table.vkAllocateMemory)},
+        {"vkFreeMemory",                        reinterpret_cast<void**>(&m_dispatch_table.vkFreeMemory)},
+        {"vkMapMemory",                         reinterpret_cast<void**>(&m_dispatch_table.vkMapMemory)},
+        {"vkUnmapMemory",                       reinterpret_cast<void**>(&m_dispatch_table.vkUnmapMemory)},
+        {"vkFlushMappedMemoryRanges",           reinterpret_cast<void**>(&m_dispatch_table.vkFlushMappedMemoryRanges)},
+        {"vkInvalidateMappedMemoryRanges",      reinterpret_cast<void**>(&m_dispatch_table.vkInvalidateMappedMemoryRanges)},
+        {"vkGetDeviceMemoryCommitment",         reinterpret_cast<void**>(&m_dispatch_table.vkGetDeviceMemoryCommitment)},
+        {"vkBindBufferMemory",                  reinterpret_cast<void**>(&m_dispatch_table.vkBindBufferMemory)},
+        {"vkBindImageMemory",                   reinterpret_cast<void**>(&m_dispatch_table.vkBindImageMemory)},
+        {"vkGetBufferMemoryRequirements",       reinterpret_cast<void**>(&m_dispatch_table.vkGetBufferMemoryRequirements)},
+        {"vkGetImageMemoryRequirements",        reinterpret_cast<void**>(&m_dispatch_table.vkGetImageMemoryRequirements)},
+        {"vkGetImageSparseMemoryRequirements",  reinterpret_cast<void**>(&m_dispatch_table.vkGetImageSparseMemoryRequirements)},
+        {"vkQueueBindSparse",                   reinterpret_cast<void**>(&m_dispatch_table.vkQueueBindSparse)},
+        {"vkCreateFence",                       reinterpret_cast<void**>(&m_dispatch_table.vkCreateFence)},
+        {"vkDestroyFence",                      reinterpret_cast<void**>(&m_dispatch_table.vkDestroyFence)},
+        {"vkResetFences",                       reinterpret_cast<void**>(&m_dispatch_table.vkResetFences)},
+        {"vkGetFenceStatus",                    reinterpret_cast<void**>(&m_dispatch_table.vkGetFenceStatus)},
+        {"vkWaitForFences",                     reinterpret_cast<void**>(&m_dispatch_table.vkWaitForFences)},
+        {"vkCreateSemaphore",                   reinterpret_cast<void**>(&m_dispatch_table.vkCreateSemaphore)},
+        {"vkDestroySemaphore",                  reinterpret_cast<void**>(&m_dispatch_table.vkDestroySemaphore)},
+        {"vkCreateEvent",                       reinterpret_cast<void**>(&m_dispatch_table.vkCreateEvent)},
+        {"vkDestroyEvent",                      reinterpret_cast<void**>(&m_dispatch_table.vkDestroyEvent)},
+        {"vkGetEventStatus",                    reinterpret_cast<void**>(&m_dispatch_table.vkGetEventStatus)},
+        {"vkSetEvent",                          reinterpret_cast<void**>(&m_dispatch_table.vkSetEvent)},
+        {"vkResetEvent",                        reinterpret_cast<void**>(&m_dispatch_table.vkResetEvent)},
+        {"vkCreateQueryPool",                   reinterpret_cast<void**>(&m_dispatch_table.vkCreateQueryPool)},
+        {"vkDestroyQueryPool",                  reinterpret_cast<void**>(&m_dispatch_table.vkDestroyQueryPool)},
+        {"vkGetQueryPoolResults",               reinterpret_cast<void**>(&m_dispatch_table.vkGetQueryPoolResults)},
+        {"vkCreateBuffer",                      reinterpret_cast<void**>(&m_dispatch_table.vkCreateBuffer)},
+        {"vkDestroyBuffer",                     reinterpret_cast<void**>(&m_dispatch_table.vkDestroyBuffer)},
+        {"vkCreateBufferView",                  reinterpret_cast<void**>(&m_dispatch_table.vkCreateBufferView)},
+        {"vkDestroyBufferView",                 reinterpret_cast<void**>(&m_dispatch_table.vkDestroyBufferView)},
+        {"vkCreateImage",                       reinterpret_cast<void**>(&m_dispatch_table.vkCreateImage)},
+        {"vkDestroyImage",                      reinterpret_cast<void**>(&m_dispatch_table.vkDestroyImage)},
+        {"vkGetImageSubresourceLayout",         reinterpret_cast<void**>(&m_dispatch_table.vkGetImageSubresourceLayout)},
+        {"vkCreateImageView",                   reinterpret_cast<void**>(&m_dispatch_table.vkCreateImageView)},
+        {"vkDestroyImageView",                  reinterpret_cast<void**>(&m_dispatch_table.vkDestroyImageView)},
+        {"vkCreateShaderModule",                reinterpret_cast<void**>(&m_dispatch_table.vkCreateShaderModule)},
+        {"vkDestroyShaderModule",               reinterpret_cast<void**>(&m_dispatch_table.vkDestroyShaderModule)},
+        {"vkCreatePipelineCache",               reinterpret_cast<void**>(&m_dispatch_table.vkCreatePipelineCache)},
+        {"vkDestroyPipelineCache",              reinterpret_cast<void**>(&m_dispatch_table.vkDestroyPipelineCache)},
+        {"vkGetPipelineCacheData",              reinterpret_cast<void**>(&m_dispatch_table.vkGetPipelineCacheData)},
+        {"vkMergePipelineCaches",               reinterpret_cast<void**>(&m_dispatch_table.vkMergePipelineCaches)},
+        {"vkCreateGraphicsPipelines",           reinterpret_cast<void**>(&m_dispatch_table.vkCreateGraphicsPipelines)},
+        {"vkCreateComputePipelines",            reinterpret_cast<void**>(&m_dispatch_table.vkCreateComputePipelines)},
+        {"vkDestroyPipeline",                   reinterpret_cast<void**>(&m_dispatch_table.vkDestroyPipeline)},
+        {"vkCreatePipelineLayout",              reinterpret_cast<void**>(&m_dispatch_table.vkCreatePipelineLayout)},
+        {"vkDestroyPipelineLayout",             reinterpret_cast<void**>(&m_dispatch_table.vkDestroyPipelineLayout)},
+        {"vkCreateSampler",                     reinterpret_cast<void**>(&m_dispatch_table.vkCreateSampler)},
+        {"vkDestroySampler",                    reinterpret_cast<void**>(&m_dispatch_table.vkDestroySampler)},
+        {"vkCreateDescriptorSetLayout",         reinterpret_cast<void**>(&m_dispatch_table.vkCreateDescriptorSetLayout)},
+        {"vkDestroyDescriptorSetLayout",        reinterpret_cast<void**>(&m_dispatch_table.vkDestroyDescriptorSetLayout)},
+        {"vkCreateDescriptorPool",              reinterpret_cast<void**>(&m_dispatch_table.vkCreateDescriptorPool)},
+        {"vkDestroyDescriptorPool",             reinterpret_cast<void**>(&m_dispatch_table.vkDestroyDescriptorPool)},
+        {"vkResetDescriptorPool",               reinterpret_cast<void**>(&m_dispatch_table.vkResetDescriptorPool)},
+        {"vkAllocateDescriptorSets",            reinterpret_cast<void**>(&m_dispatch_table.vkAllocateDescriptorSets)},
+        {"vkFreeDescriptorSets",                reinterpret_cast<void**>(&m_dispatch_table.vkFreeDescriptorSets)},
+        {"vkUpdateDescriptorSets",              reinterpret_cast<void**>(&m_dispatch_table.vkUpdateDescriptorSets)},
+        {"vkCreateFramebuffer",                 reinterpret_cast<void**>(&m_dispatch_table.vkCreateFramebuffer)},
+        {"vkDestroyFramebuffer",                reinterpret_cast<void**>(&m_dispatch_table.vkDestroyFramebuffer)},
+        {"vkCreateRenderPass",                  reinterpret_cast<void**>(&m_dispatch_table.vkCreateRenderPass)},
+        {"vkDestroyRenderPass",                 reinterpret_cast<void**>(&m_dispatch_table.vkDestroyRenderPass)},
+        {"vkGetRenderAreaGranularity",          reinterpret_cast<void**>(&m_dispatch_table.vkGetRenderAreaGranularity)},
+        {"vkCreateCommandPool",                 reinterpret_cast<void**>(&m_dispatch_table.vkCreateCommandPool)},
+        {"vkDestroyCommandPool",                reinterpret_cast<void**>(&m_dispatch_table.vkDestroyCommandPool)},
+        {"vkResetCommandPool",                  reinterpret_cast<void**>(&m_dispatch_table.vkResetCommandPool)},
+        {"vkAllocateCommandBuffers",            reinterpret_cast<void**>(&m_dispatch_table.vkAllocateCommandBuffers)},
+        {"vkFreeCommandBuffers",                reinterpret_cast<void**>(&m_dispatch_table.vkFreeCommandBuffers)},
+        {"vkBeginCommandBuffer",                reinterpret_cast<void**>(&m_dispatch_table.vkBeginCommandBuffer)},
+        {"vkEndCommandBuffer",                  reinterpret_cast<void**>(&m_dispatch_table.vkEndCommandBuffer)},
+        {"vkResetCommandBuffer",                reinterpret_cast<void**>(&m_dispatch_table.vkResetCommandBuffer)},
+        {"vkCmdBindPipeline",                   reinterpret_cast<void**>(&m_dispatch_table.vkCmdBindPipeline)},
+        {"vkCmdSetViewport",                    reinterpret_cast<void**>(&m_dispatch_table.vkCmdSetViewport)},
+        {"vkCmdSetScissor",                     reinterpret_cast<void**>(&m_dispatch_table.vkCmdSetScissor)},
+        {"vkCmdSetLineWidth",                   reinterpret_cast<void**>(&m_dispatch_table.vkCmdSetLineWidth)},
+        {"vkCmdSetDepthBias",                   reinterpret_cast<void**>(&m_dispatch_table.vkCmdSetDepthBias)},
+        {"vkCmdSetBlendConstants",              reinterpret_cast<void**>(&m_dispatch_table.vkCmdSetBlendConstants)},
+        {"vkCmdSetDepthBounds",                 reinterpret_cast<void**>(&m_dispatch_table.vkCmdSetDepthBounds)},
+        {"vkCmdSetStencilCompareMask",          reinterpret_cast<void**>(&m_dispatch_table.vkCmdSetStencilCompareMask)},
+        {"vkCmdSetStencilWriteMask",            reinterpret_cast<void**>(&m_dispatch_table.vkCmdSetStencilWriteMask)},
+        {"vkCmdSetStencilReference",            reinterpret_cast<void**>(&m_dispatch_table.vkCmdSetStencilReference)},
+        {"vkCmdBindDescriptorSets",             reinterpret_cast<void**>(&m_dispatch_table.vkCmdBindDescriptorSets)},
+        {"vkCmdBindIndexBuffer",                reinterpret_cast<void**>(&m_dispatch_table.vkCmdBindIndexBuffer)},
+        {"vkCmdBindVertexBuffers",              reinterpret_cast<void**>(&m_dispatch_table.vkCmdBindVertexBuffers)},
+        {"vkCmdDraw",                           reinterpret_cast<void**>(&m_dispatch_table.vkCmdDraw)},
+        {"vkCmdDrawIndexed",                    reinterpret_cast<void**>(&m_dispatch_table.vkCmdDrawIndexed)},
+        {"vkCmdDrawIndirect",                   reinterpret_cast<void**>(&m_dispatch_table.vkCmdDrawIndirect)},
+        {"vkCmdDrawIndexedIndirect",            reinterpret_cast<void**>(&m_dispatch_table.vkCmdDrawIndexedIndirect)},
+        {"vkCmdDispatch",                       reinterpret_cast<void**>(&m_dispatch_table.vkCmdDispatch)},
+        {"vkCmdDispatchIndirect",               reinterpret_cast<void**>(&m_dispatch_table.vkCmdDispatchIndirect)},
+        {"vkCmdCopyBuffer",                     reinterpret_cast<void**>(&m_dispatch_table.vkCmdCopyBuffer)},
+        {"vkCmdCopyImage",                      reinterpret_cast<void**>(&m_dispatch_table.vkCmdCopyImage)},
+        {"vkCmdBlitImage",                      reinterpret_cast<void**>(&m_dispatch_table.vkCmdBlitImage)},
+        {"vkCmdCopyBufferToImage",              reinterpret_cast<void**>(&m_dispatch_table.vkCmdCopyBufferToImage)},
+        {"vkCmdCopyImageToBuffer",              reinterpret_cast<void**>(&m_dispatch_table.vkCmdCopyImageToBuffer)},
+        {"vkCmdUpdateBuffer",                   reinterpret_cast<void**>(&m_dispatch_table.vkCmdUpdateBuffer)},
+        {"vkCmdFillBuffer",                     reinterpret_cast<void**>(&m_dispatch_table.vkCmdFillBuffer)},
+        {"vkCmdClearColorImage",                reinterpret_cast<void**>(&m_dispatch_table.vkCmdClearColorImage)},
+        {"vkCmdClearDepthStencilImage",         reinterpret_cast<void**>(&m_dispatch_table.vkCmdClearDepthStencilImage)},
+        {"vkCmdClearAttachments",               reinterpret_cast<void**>(&m_dispatch_table.vkCmdClearAttachments)},
+        {"vkCmdResolveImage",                   reinterpret_cast<void**>(&m_dispatch_table.vkCmdResolveImage)},
+        {"vkCmdSetEvent",                       reinterpret_cast<void**>(&m_dispatch_table.vkCmdSetEvent)},
+        {"vkCmdResetEvent",                     reinterpret_cast<void**>(&m_dispatch_table.vkCmdResetEvent)},
+        {"vkCmdWaitEvents",                     reinterpret_cast<void**>(&m_dispatch_table.vkCmdWaitEvents)},
+        {"vkCmdPipelineBarrier",                reinterpret_cast<void**>(&m_dispatch_table.vkCmdPipelineBarrier)},
+        {"vkCmdBeginQuery",                     reinterpret_cast<void**>(&m_dispatch_table.vkCmdBeginQuery)},
+        {"vkCmdEndQuery",                       reinterpret_cast<void**>(&m_dispatch_table.vkCmdEndQuery)},
+        {"vkCmdResetQueryPool",                 reinterpret_cast<void**>(&m_dispatch_table.vkCmdResetQueryPool)},
+        {"vkCmdWriteTimestamp",                 reinterpret_cast<void**>(&m_dispatch_table.vkCmdWriteTimestamp)},
+        {"vkCmdCopyQueryPoolResults",           reinterpret_cast<void**>(&m_dispatch_table.vkCmdCopyQueryPoolResults)},
+        {"vkCmdPushConstants",                  reinterpret_cast<void**>(&m_dispatch_table.vkCmdPushConstants)},
+        {"vkCmdBeginRenderPass",                reinterpret_cast<void**>(&m_dispatch_table.vkCmdBeginRenderPass)},
+        {"vkCmdNextSubpass",                    reinterpret_cast<void**>(&m_dispatch_table.vkCmdNextSubpass)},
+        {"vkCmdEndRenderPass",                  reinterpret_cast<void**>(&m_dispatch_table.vkCmdEndRenderPass)},
+        {"vkCmdExecuteCommands",                reinterpret_cast<void**>(&m_dispatch_table.vkCmdExecuteCommands)},
+    };
+
+    const FunctionData functions_vk11[] =
+    {
+        {"vkBindBufferMemory2",                 reinterpret_cast<void**>(&m_dispatch_table.vkBindBufferMemory2)},
+        {"vkBindImageMemory2",                  reinterpret_cast<void**>(&m_dispatch_table.vkBindImageMemory2)},
+        {"vkCmdDispatchBase",                   reinterpret_cast<void**>(&m_dispatch_table.vkCmdDispatchBase)},
+        {"vkCmdSetDeviceMask",                  reinterpret_cast<void**>(&m_dispatch_table.vkCmdSetDeviceMask)},
+        {"vkCreateDescriptorUpdateTemplate",    reinterpret_cast<void**>(&m_dispatch_table.vkCreateDescriptorUpdateTemplate)},
+        {"vkCreateSamplerYcbcrConversion",      reinterpret_cast<void**>(&m_dispatch_table.vkCreateSamplerYcbcrConversion)},
+        {"vkDestroyDescriptorUpdateTemplate",   reinterpret_cast<void**>(&m_dispatch_table.vkDestroyDescriptorUpdateTemplate)},
+        {"vkDestroySamplerYcbcrConversion",     reinterpret_cast<void**>(&m_dispatch_table.vkDestroySamplerYcbcrConversion)},
+        {"vkGetBufferMemoryRequirements2",      reinterpret_cast<void**>(&m_dispatch_table.vkGetBufferMemoryRequirements2)},
+        {"vkGetDescriptorSetLayoutSupport",     reinterpret_cast<void**>(&m_dispatch_table.vkGetDescriptorSetLayoutSupport)},
+        {"vkGetDeviceGroupPeerMemoryFeatures",  reinterpret_cast<void**>(&m_dispatch_table.vkGetDeviceGroupPeerMemoryFeatures)},
+        {"vkGetDeviceQueue2",                   reinterpret_cast<void**>(&m_dispatch_table.vkGetDeviceQueue2)},
+        {"vkGetImageMemoryRequirements2",       reinterpret_cast<void**>(&m_dispatch_table.vkGetImageMemoryRequirements2)},
+        {"vkGetImageSparseMemoryRequirements2", reinterpret_cast<void**>(&m_dispatch_table.vkGetImageSparseMemoryRequirements2)},
+        {"vkTrimCommandPool",                   reinterpret_cast<void**>(&m_dispatch_table.vkTrimCommandPool)},
+        {"vkUpdateDescriptorSetWithTemplate",   reinterpret_cast<void**>(&m_dispatch_table.vkUpdateDescriptorSetWithTemplate)},
+    };
+
+    anvil_assert(m_device != VK_NULL_HANDLE);
+
+    /* VK 1.0 entrypoints - all must be present */
+    for (const auto& current_func_data : functions_vk10)
+    {
+        *current_func_data.result_func_ptr = reinterpret_cast<void*>(get_proc_address(current_func_data.func_name) );
+
+        if (*current_func_data.result_func_ptr == nullptr)
+        {
+            anvil_assert(*current_func_data.result_func_ptr != nullptr);
+
+            goto end;
+        }
+    }
+
+    /* VK 1.1 entrypoints - only exposed by devices which support the API */
+    if (is_core_vk11_device)
+    {
+        for (const auto& current_func_data : functions_vk11)
+        {
+            *current_func_data.result_func_ptr = reinterpret_cast<void*>(get_proc_address(current_func_data.func_name) );
+
+            anvil_assert(*current_func_data.result_func_ptr != nullptr);
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::BaseDevice::resolve_extension_func_ptrs() const
+{
+    std::call_once(m_extension_func_ptrs_once_flag,
+                   [this]()
+                   {
+                       /* Entry-point containers are only ever written to once, under the once flag. */
+                       m_extension_func_ptrs_resolved = const_cast<Anvil::BaseDevice*>(this)->init_extension_func_ptrs();
+                   });
+
+    anvil_assert(m_extension_func_ptrs_resolved);
+
+    return m_extension_func_ptrs_resolved;
+}
+
 /** Please see header for specification */
 bool Anvil::BaseDevice::init_extension_func_ptrs()
 {
@@ -1297,6 +2348,27 @@ bool Anvil::BaseDevice::init_extension_func_ptrs()
         anvil_assert(m_amd_shader_info_extension_entrypoints.vkGetShaderInfoAMD != nullptr);
     }
 
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->ext_calibrated_timestamps() )
+    {
+        /* vkGetPhysicalDeviceCalibrateableTimeDomainsEXT() is a physical device-level func, so it must be retrieved
+         * from the instance. */
+        m_ext_calibrated_timestamps_extension_entrypoints.vkGetCalibratedTimestampsEXT                   = reinterpret_cast<PFN_vkGetCalibratedTimestampsEXT>                  (get_proc_address("vkGetCalibratedTimestampsEXT") );
+        m_ext_calibrated_timestamps_extension_entrypoints.vkGetPhysicalDeviceCalibrateableTimeDomainsEXT = reinterpret_cast<PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT>(Anvil::Vulkan::vkGetInstanceProcAddr(get_parent_instance()->get_instance_vk(),
+                                                                                                                                                                                                          "vkGetPhysicalDeviceCalibrateableTimeDomainsEXT") );
+
+        anvil_assert(m_ext_calibrated_timestamps_extension_entrypoints.vkGetCalibratedTimestampsEXT                   != nullptr);
+        anvil_assert(m_ext_calibrated_timestamps_extension_entrypoints.vkGetPhysicalDeviceCalibrateableTimeDomainsEXT != nullptr);
+    }
+
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->ext_conditional_rendering() )
+    {
+        m_ext_conditional_rendering_extension_entrypoints.vkCmdBeginConditionalRenderingEXT = reinterpret_cast<PFN_vkCmdBeginConditionalRenderingEXT>(get_proc_address("vkCmdBeginConditionalRenderingEXT") );
+        m_ext_conditional_rendering_extension_entrypoints.vkCmdEndConditionalRenderingEXT   = reinterpret_cast<PFN_vkCmdEndConditionalRenderingEXT>  (get_proc_address("vkCmdEndConditionalRenderingEXT") );
+
+        anvil_assert(m_ext_conditional_rendering_extension_entrypoints.vkCmdBeginConditionalRenderingEXT != nullptr);
+        anvil_assert(m_ext_conditional_rendering_extension_entrypoints.vkCmdEndConditionalRenderingEXT   != nullptr);
+    }
+
     if (m_extension_enabled_info_ptr->get_device_extension_info()->ext_debug_marker() )
     {
         m_ext_debug_marker_extension_entrypoints.vkCmdDebugMarkerBeginEXT      = reinterpret_cast<PFN_vkCmdDebugMarkerBeginEXT>     (get_proc_address("vkCmdDebugMarkerBeginEXT") );
@@ -1326,6 +2398,29 @@ bool Anvil::BaseDevice::init_extension_func_ptrs()
         anvil_assert(m_ext_hdr_metadata_extension_entrypoints.vkSetHdrMetadataEXT != nullptr);
     }
 
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->ext_host_image_copy() )
+    {
+        m_ext_host_image_copy_extension_entrypoints.vkCopyMemoryToImageEXT     = reinterpret_cast<PFN_vkCopyMemoryToImageEXT>    (get_proc_address("vkCopyMemoryToImageEXT") );
+        m_ext_host_image_copy_extension_entrypoints.vkTransitionImageLayoutEXT = reinterpret_cast<PFN_vkTransitionImageLayoutEXT>(get_proc_address("vkTransitionImageLayoutEXT") );
+
+        anvil_assert(m_ext_host_image_copy_extension_entrypoints.vkCopyMemoryToImageEXT     != nullptr);
+        anvil_assert(m_ext_host_image_copy_extension_entrypoints.vkTransitionImageLayoutEXT != nullptr);
+    }
+
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->ext_host_query_reset() )
+    {
+        m_ext_host_query_reset_extension_entrypoints.vkResetQueryPoolEXT = reinterpret_cast<PFN_vkResetQueryPoolEXT>(get_proc_address("vkResetQueryPoolEXT") );
+
+        anvil_assert(m_ext_host_query_reset_extension_entrypoints.vkResetQueryPoolEXT != nullptr);
+    }
+
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->ext_pageable_device_local_memory() )
+    {
+        m_ext_pageable_device_local_memory_extension_entrypoints.vkSetDeviceMemoryPriorityEXT = reinterpret_cast<PFN_vkSetDeviceMemoryPriorityEXT>(get_proc_address("vkSetDeviceMemoryPriorityEXT") );
+
+        anvil_assert(m_ext_pageable_device_local_memory_extension_entrypoints.vkSetDeviceMemoryPriorityEXT != nullptr);
+    }
+
     if (m_extension_enabled_info_ptr->get_device_extension_info()->ext_sample_locations() )
     {
         m_ext_sample_locations_extension_entrypoints.vkCmdSetSampleLocationsEXT                  = reinterpret_cast<PFN_vkCmdSetSampleLocationsEXT>                 (get_proc_address("vkCmdSetSampleLocationsEXT") );
@@ -1352,6 +2447,15 @@ bool Anvil::BaseDevice::init_extension_func_ptrs()
         anvil_assert(m_ext_transform_feedback_extension_entrypoints.vkCmdEndTransformFeedbackEXT         != nullptr);
     }
 
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->google_display_timing() )
+    {
+        m_google_display_timing_extension_entrypoints.vkGetPastPresentationTimingGOOGLE = reinterpret_cast<PFN_vkGetPastPresentationTimingGOOGLE>(get_proc_address("vkGetPastPresentationTimingGOOGLE") );
+        m_google_display_timing_extension_entrypoints.vkGetRefreshCycleDurationGOOGLE   = reinterpret_cast<PFN_vkGetRefreshCycleDurationGOOGLE>  (get_proc_address("vkGetRefreshCycleDurationGOOGLE") );
+
+        anvil_assert(m_google_display_timing_extension_entrypoints.vkGetPastPresentationTimingGOOGLE != nullptr);
+        anvil_assert(m_google_display_timing_extension_entrypoints.vkGetRefreshCycleDurationGOOGLE   != nullptr);
+    }
+
     if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_descriptor_update_template() ||
         is_core_vk11_device)
     {
@@ -1406,6 +2510,25 @@ bool Anvil::BaseDevice::init_extension_func_ptrs()
         }
     }
 
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_acceleration_structure() )
+    {
+        m_khr_acceleration_structure_extension_entrypoints.vkCmdBuildAccelerationStructuresKHR           = reinterpret_cast<PFN_vkCmdBuildAccelerationStructuresKHR>          (get_proc_address("vkCmdBuildAccelerationStructuresKHR") );
+        m_khr_acceleration_structure_extension_entrypoints.vkCmdCopyAccelerationStructureKHR             = reinterpret_cast<PFN_vkCmdCopyAccelerationStructureKHR>            (get_proc_address("vkCmdCopyAccelerationStructureKHR") );
+        m_khr_acceleration_structure_extension_entrypoints.vkCmdWriteAccelerationStructuresPropertiesKHR = reinterpret_cast<PFN_vkCmdWriteAccelerationStructuresPropertiesKHR>(get_proc_address("vkCmdWriteAccelerationStructuresPropertiesKHR") );
+        m_khr_acceleration_structure_extension_entrypoints.vkCreateAccelerationStructureKHR              = reinterpret_cast<PFN_vkCreateAccelerationStructureKHR>             (get_proc_address("vkCreateAccelerationStructureKHR") );
+        m_khr_acceleration_structure_extension_entrypoints.vkDestroyAccelerationStructureKHR             = reinterpret_cast<PFN_vkDestroyAccelerationStructureKHR>            (get_proc_address("vkDestroyAccelerationStructureKHR") );
+        m_khr_acceleration_structure_extension_entrypoints.vkGetAccelerationStructureBuildSizesKHR       = reinterpret_cast<PFN_vkGetAccelerationStructureBuildSizesKHR>      (get_proc_address("vkGetAccelerationStructureBuildSizesKHR") );
+        m_khr_acceleration_structure_extension_entrypoints.vkGetAccelerationStructureDeviceAddressKHR    = reinterpret_cast<PFN_vkGetAccelerationStructureDeviceAddressKHR>   (get_proc_address("vkGetAccelerationStructureDeviceAddressKHR") );
+
+        anvil_assert(m_khr_acceleration_structure_extension_entrypoints.vkCmdBuildAccelerationStructuresKHR           != nullptr);
+        anvil_assert(m_khr_acceleration_structure_extension_entrypoints.vkCmdCopyAccelerationStructureKHR             != nullptr);
+        anvil_assert(m_khr_acceleration_structure_extension_entrypoints.vkCmdWriteAccelerationStructuresPropertiesKHR != nullptr);
+        anvil_assert(m_khr_acceleration_structure_extension_entrypoints.vkCreateAccelerationStructureKHR              != nullptr);
+        anvil_assert(m_khr_acceleration_structure_extension_entrypoints.vkDestroyAccelerationStructureKHR             != nullptr);
+        anvil_assert(m_khr_acceleration_structure_extension_entrypoints.vkGetAccelerationStructureBuildSizesKHR       != nullptr);
+        anvil_assert(m_khr_acceleration_structure_extension_entrypoints.vkGetAccelerationStructureDeviceAddressKHR    != nullptr);
+    }
+
     if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_bind_memory2() ||
         is_core_vk11_device)
     {
@@ -1421,6 +2544,13 @@ bool Anvil::BaseDevice::init_extension_func_ptrs()
         anvil_assert(m_khr_bind_memory2_extension_entrypoints.vkBindImageMemory2KHR  != nullptr);
     }
 
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_buffer_device_address() )
+    {
+        m_khr_buffer_device_address_extension_entrypoints.vkGetBufferDeviceAddressKHR = reinterpret_cast<PFN_vkGetBufferDeviceAddressKHR>(get_proc_address("vkGetBufferDeviceAddressKHR") );
+
+        anvil_assert(m_khr_buffer_device_address_extension_entrypoints.vkGetBufferDeviceAddressKHR != nullptr);
+    }
+
     if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_create_renderpass2() )
     {
         m_khr_create_renderpass2_extension_entrypoints.vkCmdBeginRenderPass2KHR = reinterpret_cast<PFN_vkCmdBeginRenderPass2KHR>(get_proc_address("vkCmdBeginRenderPass2KHR"));
@@ -1443,6 +2573,15 @@ bool Anvil::BaseDevice::init_extension_func_ptrs()
         anvil_assert(m_khr_draw_indirect_count_extension_entrypoints.vkCmdDrawIndirectCountKHR        != nullptr);
     }
 
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_dynamic_rendering() )
+    {
+        m_khr_dynamic_rendering_extension_entrypoints.vkCmdBeginRenderingKHR = reinterpret_cast<PFN_vkCmdBeginRenderingKHR>(get_proc_address("vkCmdBeginRenderingKHR") );
+        m_khr_dynamic_rendering_extension_entrypoints.vkCmdEndRenderingKHR   = reinterpret_cast<PFN_vkCmdEndRenderingKHR>  (get_proc_address("vkCmdEndRenderingKHR") );
+
+        anvil_assert(m_khr_dynamic_rendering_extension_entrypoints.vkCmdBeginRenderingKHR != nullptr);
+        anvil_assert(m_khr_dynamic_rendering_extension_entrypoints.vkCmdEndRenderingKHR   != nullptr);
+    }
+
     #if defined(_WIN32)
     {
         if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_external_fence_win32() )
@@ -1544,6 +2683,30 @@ bool Anvil::BaseDevice::init_extension_func_ptrs()
         anvil_assert(m_khr_maintenance3_extension_entrypoints.vkGetDescriptorSetLayoutSupportKHR != nullptr);
     }
 
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_pipeline_executable_properties() )
+    {
+        m_khr_pipeline_executable_properties_extension_entrypoints.vkGetPipelineExecutablePropertiesKHR = reinterpret_cast<PFN_vkGetPipelineExecutablePropertiesKHR>(get_proc_address("vkGetPipelineExecutablePropertiesKHR") );
+        m_khr_pipeline_executable_properties_extension_entrypoints.vkGetPipelineExecutableStatisticsKHR = reinterpret_cast<PFN_vkGetPipelineExecutableStatisticsKHR>(get_proc_address("vkGetPipelineExecutableStatisticsKHR") );
+
+        anvil_assert(m_khr_pipeline_executable_properties_extension_entrypoints.vkGetPipelineExecutablePropertiesKHR != nullptr);
+        anvil_assert(m_khr_pipeline_executable_properties_extension_entrypoints.vkGetPipelineExecutableStatisticsKHR != nullptr);
+    }
+
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_push_descriptor() )
+    {
+        m_khr_push_descriptor_extension_entrypoints.vkCmdPushDescriptorSetKHR = reinterpret_cast<PFN_vkCmdPushDescriptorSetKHR>(get_proc_address("vkCmdPushDescriptorSetKHR") );
+
+        anvil_assert(m_khr_push_descriptor_extension_entrypoints.vkCmdPushDescriptorSetKHR != nullptr);
+
+        if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_descriptor_update_template() ||
+            is_core_vk11_device)
+        {
+            m_khr_push_descriptor_extension_entrypoints.vkCmdPushDescriptorSetWithTemplateKHR = reinterpret_cast<PFN_vkCmdPushDescriptorSetWithTemplateKHR>(get_proc_address("vkCmdPushDescriptorSetWithTemplateKHR") );
+
+            anvil_assert(m_khr_push_descriptor_extension_entrypoints.vkCmdPushDescriptorSetWithTemplateKHR != nullptr);
+        }
+    }
+
     if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_sampler_ycbcr_conversion() ||
         is_core_vk11_device)
     {
@@ -1574,6 +2737,39 @@ bool Anvil::BaseDevice::init_extension_func_ptrs()
         anvil_assert(m_khr_swapchain_extension_entrypoints.vkQueuePresentKHR       != nullptr);
     }
 
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_timeline_semaphore() )
+    {
+        m_khr_timeline_semaphore_extension_entrypoints.vkGetSemaphoreCounterValueKHR = reinterpret_cast<PFN_vkGetSemaphoreCounterValueKHR>(get_proc_address("vkGetSemaphoreCounterValueKHR") );
+        m_khr_timeline_semaphore_extension_entrypoints.vkSignalSemaphoreKHR          = reinterpret_cast<PFN_vkSignalSemaphoreKHR>         (get_proc_address("vkSignalSemaphoreKHR") );
+        m_khr_timeline_semaphore_extension_entrypoints.vkWaitSemaphoresKHR           = reinterpret_cast<PFN_vkWaitSemaphoresKHR>          (get_proc_address("vkWaitSemaphoresKHR") );
+
+        anvil_assert(m_khr_timeline_semaphore_extension_entrypoints.vkGetSemaphoreCounterValueKHR != nullptr);
+        anvil_assert(m_khr_timeline_semaphore_extension_entrypoints.vkSignalSemaphoreKHR          != nullptr);
+        anvil_assert(m_khr_timeline_semaphore_extension_entrypoints.vkWaitSemaphoresKHR           != nullptr);
+    }
+
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->nv_mesh_shader() )
+    {
+        m_nv_mesh_shader_extension_entrypoints.vkCmdDrawMeshTasksIndirectCountNV = reinterpret_cast<PFN_vkCmdDrawMeshTasksIndirectCountNV>(get_proc_address("vkCmdDrawMeshTasksIndirectCountNV") );
+        m_nv_mesh_shader_extension_entrypoints.vkCmdDrawMeshTasksIndirectNV      = reinterpret_cast<PFN_vkCmdDrawMeshTasksIndirectNV>     (get_proc_address("vkCmdDrawMeshTasksIndirectNV") );
+        m_nv_mesh_shader_extension_entrypoints.vkCmdDrawMeshTasksNV              = reinterpret_cast<PFN_vkCmdDrawMeshTasksNV>             (get_proc_address("vkCmdDrawMeshTasksNV") );
+
+        anvil_assert(m_nv_mesh_shader_extension_entrypoints.vkCmdDrawMeshTasksIndirectCountNV != nullptr);
+        anvil_assert(m_nv_mesh_shader_extension_entrypoints.vkCmdDrawMeshTasksIndirectNV      != nullptr);
+        anvil_assert(m_nv_mesh_shader_extension_entrypoints.vkCmdDrawMeshTasksNV              != nullptr);
+    }
+
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->nv_shading_rate_image() )
+    {
+        m_nv_shading_rate_image_extension_entrypoints.vkCmdBindShadingRateImageNV          = reinterpret_cast<PFN_vkCmdBindShadingRateImageNV>         (get_proc_address("vkCmdBindShadingRateImageNV") );
+        m_nv_shading_rate_image_extension_entrypoints.vkCmdSetCoarseSampleOrderNV          = reinterpret_cast<PFN_vkCmdSetCoarseSampleOrderNV>         (get_proc_address("vkCmdSetCoarseSampleOrderNV") );
+        m_nv_shading_rate_image_extension_entrypoints.vkCmdSetViewportShadingRatePaletteNV = reinterpret_cast<PFN_vkCmdSetViewportShadingRatePaletteNV>(get_proc_address("vkCmdSetViewportShadingRatePaletteNV") );
+
+        anvil_assert(m_nv_shading_rate_image_extension_entrypoints.vkCmdBindShadingRateImageNV          != nullptr);
+        anvil_assert(m_nv_shading_rate_image_extension_entrypoints.vkCmdSetCoarseSampleOrderNV          != nullptr);
+        anvil_assert(m_nv_shading_rate_image_extension_entrypoints.vkCmdSetViewportShadingRatePaletteNV != nullptr);
+    }
+
     return true;
 }
 
@@ -1598,6 +2794,58 @@ bool Anvil::BaseDevice::is_universal_queue_family_index(const uint32_t& in_queue
            (m_queue_family_index_to_types.at  (in_queue_family_index).at(0) == Anvil::QueueFamilyType::UNIVERSAL);
 }
 
+/* Please see header for specification */
+bool Anvil::BaseDevice::reset_thread_command_pools(bool in_release_resources) const
+{
+    std::unique_lock<std::mutex> lock  (m_thread_command_pools_mutex);
+    bool                         result(true);
+
+    for (auto& current_thread_pools : m_thread_command_pools)
+    {
+        for (auto& current_pool_ptr : current_thread_pools.second)
+        {
+            if (current_pool_ptr != nullptr)
+            {
+                result &= current_pool_ptr->reset(in_release_resources);
+
+                current_pool_ptr->on_frame_end();
+            }
+        }
+    }
+
+    return result;
+}
+
+/* Please see header for specification */
+void Anvil::BaseDevice::run_background_work(const uint64_t&              in_budget_usec,
+                                            Anvil::BackgroundWorkReport* out_opt_report_ptr) const
+{
+    get_background_work_scheduler()->run(in_budget_usec,
+                                         out_opt_report_ptr);
+}
+
+/* Please see header for specification */
+void Anvil::BaseDevice::set_thread_command_pool_trim_policy(uint32_t in_n_window_frames,
+                                                            float    in_usage_ratio) const
+{
+    std::unique_lock<std::mutex> lock(m_thread_command_pools_mutex);
+
+    m_thread_command_pools_trim_n_window_frames = in_n_window_frames;
+    m_thread_command_pools_trim_usage_ratio     = in_usage_ratio;
+
+    for (auto& current_thread_pools : m_thread_command_pools)
+    {
+        for (auto& current_pool_ptr : current_thread_pools.second)
+        {
+            if (current_pool_ptr != nullptr)
+            {
+                current_pool_ptr->set_trim_policy(in_n_window_frames,
+                                                  in_usage_ratio);
+            }
+        }
+    }
+}
+
 /* Please see header for specification */
 bool Anvil::BaseDevice::wait_idle() const
 {
@@ -1616,7 +2864,7 @@ bool Anvil::BaseDevice::wait_idle() const
         }
     }
 
-    result_vk = Anvil::Vulkan::vkDeviceWaitIdle(m_device);
+    result_vk = m_dispatch_table.vkDeviceWaitIdle(m_device);
 
     if (mt_safe)
     {
@@ -1903,9 +3151,9 @@ Anvil::MultisamplePropertiesEXT Anvil::MGPUDevice::get_physical_device_multisamp
     result_vk.pNext                            = nullptr;
     result_vk.sType                            = VK_STRUCTURE_TYPE_MULTISAMPLE_PROPERTIES_EXT;
 
-    m_ext_sample_locations_extension_entrypoints.vkGetPhysicalDeviceMultisamplePropertiesEXT(m_parent_physical_devices.at(0).physical_device_ptr->get_physical_device(),
-                                                                                             static_cast<VkSampleCountFlagBits>(in_samples),
-                                                                                            &result_vk);
+    get_extension_ext_sample_locations_entrypoints().vkGetPhysicalDeviceMultisamplePropertiesEXT(m_parent_physical_devices.at(0).physical_device_ptr->get_physical_device(),
+                                                                                                 static_cast<VkSampleCountFlagBits>(in_samples),
+                                                                                                &result_vk);
 
     return Anvil::MultisamplePropertiesEXT(result_vk);
 }
@@ -2028,19 +3276,19 @@ bool Anvil::MGPUDevice::get_present_rectangles(uint32_t                       in
 
     in_rendering_surface_ptr->lock();
     {
-        result_vk = m_khr_device_group_extension_entrypoints.vkGetPhysicalDevicePresentRectanglesKHR(physical_device_ptr->get_physical_device(),
-                                                                                                     in_rendering_surface_ptr->get_surface(),
-                                                                                                    &n_rectangles,
-                                                                                                     nullptr); /* pRects */
+        result_vk = get_extension_khr_device_group_entrypoints().vkGetPhysicalDevicePresentRectanglesKHR(physical_device_ptr->get_physical_device(),
+                                                                                                         in_rendering_surface_ptr->get_surface(),
+                                                                                                        &n_rectangles,
+                                                                                                         nullptr); /* pRects */
 
         if (is_vk_call_successful(result_vk) )
         {
             out_result_ptr->resize(n_rectangles);
 
-            result_vk = m_khr_device_group_extension_entrypoints.vkGetPhysicalDevicePresentRectanglesKHR(physical_device_ptr->get_physical_device(),
-                                                                                                         in_rendering_surface_ptr->get_surface(),
-                                                                                                        &n_rectangles,
-                                                                                                        &((*out_result_ptr)[0])); /* pRects */
+            result_vk = get_extension_khr_device_group_entrypoints().vkGetPhysicalDevicePresentRectanglesKHR(physical_device_ptr->get_physical_device(),
+                                                                                                             in_rendering_surface_ptr->get_surface(),
+                                                                                                            &n_rectangles,
+                                                                                                            &((*out_result_ptr)[0])); /* pRects */
         }
     }
     in_rendering_surface_ptr->unlock();
@@ -2093,9 +3341,9 @@ Anvil::DeviceGroupPresentModeFlags Anvil::MGPUDevice::get_supported_present_mode
 
     ANVIL_REDUNDANT_VARIABLE(result_vk);
 
-    result_vk = m_khr_device_group_extension_entrypoints.vkGetDeviceGroupSurfacePresentModesKHR(m_device,
-                                                                                                in_surface_ptr->get_surface(),
-                                                                                               &result_flags);
+    result_vk = get_extension_khr_device_group_entrypoints().vkGetDeviceGroupSurfacePresentModesKHR(m_device,
+                                                                                                    in_surface_ptr->get_surface(),
+                                                                                                   &result_flags);
     anvil_assert_vk_call_succeeded(result_vk);
 
     return Anvil::DeviceGroupPresentModeFlags(static_cast<Anvil::DeviceGroupPresentModeFlagBits>(result_flags) );
@@ -2114,8 +3362,8 @@ void Anvil::MGPUDevice::init_device()
     present_caps.pNext = nullptr;
     present_caps.sType = VK_STRUCTURE_TYPE_DEVICE_GROUP_PRESENT_CAPABILITIES_KHR;
 
-    result = m_khr_device_group_extension_entrypoints.vkGetDeviceGroupPresentCapabilitiesKHR(m_device,
-                                                                                            &present_caps);
+    result = get_extension_khr_device_group_entrypoints().vkGetDeviceGroupPresentCapabilitiesKHR(m_device,
+                                                                                                &present_caps);
 
     anvil_assert_vk_call_succeeded(result);
     anvil_assert                  ((present_caps.modes & static_cast<uint32_t>(Anvil::DeviceGroupPresentModeFlagBits::LOCAL_BIT_KHR) ));
@@ -2177,11 +3425,11 @@ void Anvil::MGPUDevice::init_device()
                 VkPeerMemoryFeatureFlagsKHR memory_features           = 0;
                 const uint32_t              src_physical_device_index = src_physical_device_ptr->get_device_group_device_index();
 
-                m_khr_device_group_extension_entrypoints.vkGetDeviceGroupPeerMemoryFeaturesKHR(m_device,
-                                                                                               n_heap,
-                                                                                               src_physical_device_index,
-                                                                                               dst_physical_device_index,
-                                                                                              &memory_features);
+                get_extension_khr_device_group_entrypoints().vkGetDeviceGroupPeerMemoryFeaturesKHR(m_device,
+                                                                                                   n_heap,
+                                                                                                   src_physical_device_index,
+                                                                                                   dst_physical_device_index,
+                                                                                                  &memory_features);
 
                 anvil_assert( (memory_features & VK_PEER_MEMORY_FEATURE_COPY_DST_BIT_KHR) != 0); /* As per spec */
 
@@ -2319,9 +3567,9 @@ Anvil::MultisamplePropertiesEXT Anvil::SGPUDevice::get_physical_device_multisamp
     result_vk.pNext                            = nullptr;
     result_vk.sType                            = VK_STRUCTURE_TYPE_MULTISAMPLE_PROPERTIES_EXT;
 
-    m_ext_sample_locations_extension_entrypoints.vkGetPhysicalDeviceMultisamplePropertiesEXT(m_create_info_ptr->get_physical_device_ptrs().at(0)->get_physical_device(),
-                                                                                             static_cast<VkSampleCountFlagBits>(in_samples),
-                                                                                            &result_vk);
+    get_extension_ext_sample_locations_entrypoints().vkGetPhysicalDeviceMultisamplePropertiesEXT(m_create_info_ptr->get_physical_device_ptrs().at(0)->get_physical_device(),
+                                                                                                 static_cast<VkSampleCountFlagBits>(in_samples),
+                                                                                                &result_vk);
 
     return Anvil::MultisamplePropertiesEXT(result_vk);
 }
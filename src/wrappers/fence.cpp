@@ -335,10 +335,10 @@ bool Anvil::Fence::init()
         goto end;
     }
 
-    result = Anvil::Vulkan::vkCreateFence(m_device_ptr->get_device_vk(),
-                                          struct_chain_ptr->get_root_struct(),
-                                          nullptr, /* pAllocator */
-                                         &m_fence);
+    result = m_device_ptr->get_dispatch_table().vkCreateFence(m_device_ptr->get_device_vk(),
+                                                              struct_chain_ptr->get_root_struct(),
+                                                              m_device_ptr->get_allocation_callbacks_vk(),
+                                                             &m_fence);
 
     anvil_assert_vk_call_succeeded(result);
     if (is_vk_call_successful(result) )
@@ -355,8 +355,8 @@ bool Anvil::Fence::is_set() const
 {
     VkResult result;
 
-    result = Anvil::Vulkan::vkGetFenceStatus(m_device_ptr->get_device_vk(),
-                                             m_fence);
+    result = m_device_ptr->get_dispatch_table().vkGetFenceStatus(m_device_ptr->get_device_vk(),
+                                                                 m_fence);
 
     anvil_assert(result == VK_SUCCESS  ||
                  result == VK_NOT_READY);
@@ -364,6 +364,36 @@ bool Anvil::Fence::is_set() const
     return (result == VK_SUCCESS);
 }
 
+/* Please see header for specification */
+uint32_t Anvil::Fence::poll_fences(uint32_t      in_n_fences,
+                                   Fence* const* in_fence_ptrs,
+                                   uint32_t*     out_signalled_indices_ptr)
+{
+    uint32_t n_signalled_fences = 0;
+
+    /* Most polls find none of the fences signalled, in which case a single zero-timeout wait suffices */
+    if (!wait_fences(in_n_fences,
+                     in_fence_ptrs,
+                     false, /* in_wait_all */
+                     0) )   /* in_timeout  */
+    {
+        goto end;
+    }
+
+    for (uint32_t n_fence = 0;
+                  n_fence < in_n_fences;
+                ++n_fence)
+    {
+        if (in_fence_ptrs[n_fence]->is_set() )
+        {
+            out_signalled_indices_ptr[n_signalled_fences++] = n_fence;
+        }
+    }
+
+end:
+    return n_signalled_fences;
+}
+
 /** Destroys the underlying Vulkan Fence instance. */
 void Anvil::Fence::release_fence()
 {
@@ -371,9 +401,9 @@ void Anvil::Fence::release_fence()
     {
         lock();
         {
-            Anvil::Vulkan::vkDestroyFence(m_device_ptr->get_device_vk(),
-                                          m_fence,
-                                          nullptr /* pAllocator */);
+            m_device_ptr->get_dispatch_table().vkDestroyFence(m_device_ptr->get_device_vk(),
+                                                              m_fence,
+                                                              m_device_ptr->get_allocation_callbacks_vk() );
         }
         unlock();
 
@@ -388,9 +418,9 @@ bool Anvil::Fence::reset()
 
     lock();
     {
-        result = Anvil::Vulkan::vkResetFences(m_device_ptr->get_device_vk(),
-                                              1, /* fenceCount */
-                                             &m_fence);
+        result = m_device_ptr->get_dispatch_table().vkResetFences(m_device_ptr->get_device_vk(),
+                                                                  1, /* fenceCount */
+                                                                 &m_fence);
     }
     unlock();
 
@@ -433,9 +463,9 @@ bool Anvil::Fence::reset_fences(const uint32_t in_n_fences,
             current_fence.lock();
         }
         {
-            result_vk = Anvil::Vulkan::vkResetFences(device_ptr->get_device_vk(),
-                                                     n_fences_remaining,
-                                                     (n_fences_remaining > 0) ? &fence_cache.at(0) : nullptr);
+            result_vk = device_ptr->get_dispatch_table().vkResetFences(device_ptr->get_device_vk(),
+                                                                       n_fences_remaining,
+                                                                       (n_fences_remaining > 0) ? &fence_cache.at(0) : nullptr);
         }
         for (uint32_t n_fence = 0;
                       n_fence < n_fences_remaining;
@@ -457,3 +487,109 @@ bool Anvil::Fence::reset_fences(const uint32_t in_n_fences,
 end:
     return result;
 }
+
+/* Please see header for specification */
+bool Anvil::Fence::reset_fences(const uint32_t in_n_fences,
+                                Fence* const*  in_fence_ptrs)
+{
+    const Anvil::BaseDevice* device_ptr = nullptr;
+    std::vector<VkFence>     fences_vk  (in_n_fences);
+    bool                     result     = true;
+    VkResult                 result_vk;
+
+    if (in_n_fences == 0)
+    {
+        goto end;
+    }
+
+    device_ptr = in_fence_ptrs[0]->m_device_ptr;
+
+    for (uint32_t n_fence = 0;
+                  n_fence < in_n_fences;
+                ++n_fence)
+    {
+        anvil_assert(in_fence_ptrs[n_fence]->m_device_ptr == device_ptr);
+
+        fences_vk.at(n_fence) = in_fence_ptrs[n_fence]->m_fence;
+
+        in_fence_ptrs[n_fence]->lock();
+    }
+    {
+        result_vk = device_ptr->get_dispatch_table().vkResetFences(device_ptr->get_device_vk(),
+                                                                   in_n_fences,
+                                                                  &fences_vk.at(0) );
+    }
+    for (uint32_t n_fence = 0;
+                  n_fence < in_n_fences;
+                ++n_fence)
+    {
+        in_fence_ptrs[n_fence]->unlock();
+    }
+
+    anvil_assert_vk_call_succeeded(result_vk);
+
+    result = is_vk_call_successful(result_vk);
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::Fence::wait_fences(uint32_t      in_n_fences,
+                               Fence* const* in_fence_ptrs,
+                               bool          in_wait_all,
+                               uint64_t      in_timeout,
+                               VkResult*     out_opt_result_ptr)
+{
+    const Anvil::BaseDevice* device_ptr = nullptr;
+    VkFence                  fences_stack_vk[N_MAX_STACK_FENCES];
+    std::vector<VkFence>     fences_heap_vk;
+    VkFence*                 fences_vk_ptr  = fences_stack_vk;
+    bool                     result         = false;
+    VkResult                 result_vk      = VK_SUCCESS;
+
+    if (in_n_fences == 0)
+    {
+        result = true;
+
+        goto end;
+    }
+
+    if (in_n_fences > N_MAX_STACK_FENCES)
+    {
+        fences_heap_vk.resize(in_n_fences);
+
+        fences_vk_ptr = &fences_heap_vk.at(0);
+    }
+
+    device_ptr = in_fence_ptrs[0]->m_device_ptr;
+
+    for (uint32_t n_fence = 0;
+                  n_fence < in_n_fences;
+                ++n_fence)
+    {
+        anvil_assert(in_fence_ptrs[n_fence]->m_device_ptr == device_ptr);
+
+        fences_vk_ptr[n_fence] = in_fence_ptrs[n_fence]->m_fence;
+    }
+
+    /* NOTE: Host waits do not require external synchronization of the fences, so no locks are taken here. */
+    result_vk = device_ptr->get_dispatch_table().vkWaitForFences(device_ptr->get_device_vk(),
+                                                                 in_n_fences,
+                                                                 fences_vk_ptr,
+                                                                 (in_wait_all) ? VK_TRUE : VK_FALSE,
+                                                                 in_timeout);
+
+    if (result_vk != VK_TIMEOUT)
+    {
+        anvil_assert_vk_call_succeeded(result_vk);
+    }
+
+    result = (result_vk == VK_SUCCESS);
+end:
+    if (out_opt_result_ptr != nullptr)
+    {
+        *out_opt_result_ptr = result_vk;
+    }
+
+    return result;
+}
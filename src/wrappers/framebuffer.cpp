@@ -74,9 +74,9 @@ Anvil::Framebuffer::~Framebuffer()
         /* Destroy the Vulkan framebuffer object */
         lock();
         {
-            Anvil::Vulkan::vkDestroyFramebuffer(m_device_ptr->get_device_vk(),
-                                                fb_iterator->second.framebuffer,
-                                                nullptr /* pAllocator */);
+            m_device_ptr->get_dispatch_table().vkDestroyFramebuffer(m_device_ptr->get_device_vk(),
+                                                                    fb_iterator->second.framebuffer,
+                                                                    m_device_ptr->get_allocation_callbacks_vk() );
         }
         unlock();
     }
@@ -87,13 +87,17 @@ Anvil::Framebuffer::~Framebuffer()
 /* Please see header for specification */
 bool Anvil::Framebuffer::bake(Anvil::RenderPass* in_render_pass_ptr)
 {
-    BakedFramebufferMap::iterator baked_fb_iterator;
-    VkFramebufferCreateInfo       fb_create_info;
-    std::vector<VkImageView>      image_view_attachments;
-    const auto                    n_attachments          = m_create_info_ptr->get_n_attachments();
-    bool                          result                 = false;
-    VkFramebuffer                 result_fb              = VK_NULL_HANDLE;
-    VkResult                      result_vk              = VK_ERROR_INITIALIZATION_FAILED;
+    std::vector<VkFramebufferAttachmentImageInfoKHR> attachment_image_infos;
+    std::vector<std::vector<VkFormat> >              attachment_view_formats;
+    BakedFramebufferMap::iterator                    baked_fb_iterator;
+    VkFramebufferAttachmentsCreateInfoKHR            fb_attachments_create_info;
+    VkFramebufferCreateInfo                          fb_create_info;
+    std::vector<VkImageView>                         image_view_attachments;
+    const bool                                       is_imageless             = m_create_info_ptr->is_imageless     ();
+    const auto                                       n_attachments            = m_create_info_ptr->get_n_attachments();
+    bool                                             result                   = false;
+    VkFramebuffer                                    result_fb                = VK_NULL_HANDLE;
+    VkResult                                         result_vk                = VK_ERROR_INITIALIZATION_FAILED;
 
     ANVIL_REDUNDANT_VARIABLE(result_vk);
 
@@ -115,9 +119,9 @@ bool Anvil::Framebuffer::bake(Anvil::RenderPass* in_render_pass_ptr)
     {
         lock();
         {
-            Anvil::Vulkan::vkDestroyFramebuffer(m_device_ptr->get_device_vk(),
-                                                baked_fb_iterator->second.framebuffer,
-                                                nullptr /* pAllocator */);
+            m_device_ptr->get_dispatch_table().vkDestroyFramebuffer(m_device_ptr->get_device_vk(),
+                                                                    baked_fb_iterator->second.framebuffer,
+                                                                    m_device_ptr->get_allocation_callbacks_vk() );
         }
         unlock();
 
@@ -126,47 +130,101 @@ bool Anvil::Framebuffer::bake(Anvil::RenderPass* in_render_pass_ptr)
         m_baked_framebuffers.erase(baked_fb_iterator);
     }
 
-    /* Prepare the image view array we will use as input for the create info descriptor */
-    image_view_attachments.reserve(n_attachments);
+    /* Prepare the image view array we will use as input for the create info descriptor. Imageless framebuffers
+     * describe their attachments instead. */
+    if (is_imageless)
+    {
+        attachment_image_infos.resize (n_attachments);
+        attachment_view_formats.resize(n_attachments);
 
-    for (uint32_t n_attachment = 0;
-                  n_attachment < n_attachments;
-                ++n_attachment)
+        for (uint32_t n_attachment = 0;
+                      n_attachment < n_attachments;
+                    ++n_attachment)
+        {
+            auto&                             image_info        = attachment_image_infos.at(n_attachment);
+            Anvil::ImageCreateFlags           image_create_flags;
+            Anvil::ImageUsageFlags            image_usage_flags;
+            auto&                             view_formats_vk   = attachment_view_formats.at(n_attachment);
+            const std::vector<Anvil::Format>* view_formats_ptr  = nullptr;
+
+            if (!m_create_info_ptr->get_imageless_attachment_properties(n_attachment,
+                                                                       &image_create_flags,
+                                                                       &image_usage_flags,
+                                                                       &image_info.width,
+                                                                       &image_info.height,
+                                                                       &image_info.layerCount,
+                                                                       &view_formats_ptr) )
+            {
+                anvil_assert_fail();
+
+                goto end;
+            }
+
+            for (const auto& current_format : *view_formats_ptr)
+            {
+                view_formats_vk.push_back(static_cast<VkFormat>(current_format) );
+            }
+
+            image_info.flags           = image_create_flags.get_vk();
+            image_info.pNext           = nullptr;
+            image_info.pViewFormats    = (view_formats_vk.size() > 0) ? &view_formats_vk.at(0)
+                                                                      : nullptr;
+            image_info.sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_ATTACHMENT_IMAGE_INFO_KHR;
+            image_info.usage           = image_usage_flags.get_vk();
+            image_info.viewFormatCount = static_cast<uint32_t>(view_formats_vk.size() );
+        }
+
+        fb_attachments_create_info.attachmentImageInfoCount = n_attachments;
+        fb_attachments_create_info.pAttachmentImageInfos    = (n_attachments > 0) ? &attachment_image_infos.at(0)
+                                                                                  : nullptr;
+        fb_attachments_create_info.pNext                    = nullptr;
+        fb_attachments_create_info.sType                    = VK_STRUCTURE_TYPE_FRAMEBUFFER_ATTACHMENTS_CREATE_INFO_KHR;
+    }
+    else
     {
-        Anvil::ImageView* image_view_ptr = nullptr;
+        image_view_attachments.reserve(n_attachments);
 
-        if (!m_create_info_ptr->get_attachment_at_index(n_attachment,
-                                                       &image_view_ptr) )
+        for (uint32_t n_attachment = 0;
+                      n_attachment < n_attachments;
+                    ++n_attachment)
         {
-            anvil_assert_fail();
+            Anvil::ImageView* image_view_ptr = nullptr;
 
-            goto end;
-        }
+            if (!m_create_info_ptr->get_attachment_at_index(n_attachment,
+                                                           &image_view_ptr) )
+            {
+                anvil_assert_fail();
 
-        anvil_assert(image_view_ptr != nullptr);
+                goto end;
+            }
 
-        image_view_attachments.push_back(image_view_ptr->get_image_view() );
+            anvil_assert(image_view_ptr != nullptr);
+
+            image_view_attachments.push_back(image_view_ptr->get_image_view() );
+        }
     }
 
     /* Prepare the create info descriptor */
-    anvil_assert(in_render_pass_ptr->get_render_pass_create_info()->get_n_attachments() == image_view_attachments.size() );
+    anvil_assert(in_render_pass_ptr->get_render_pass_create_info()->get_n_attachments() == n_attachments);
 
-    fb_create_info.attachmentCount = static_cast<uint32_t>(image_view_attachments.size() );
-    fb_create_info.flags           = 0;
+    fb_create_info.attachmentCount = n_attachments;
+    fb_create_info.flags           = (is_imageless) ? VK_FRAMEBUFFER_CREATE_IMAGELESS_BIT_KHR
+                                                    : 0;
     fb_create_info.height          = m_create_info_ptr->get_height  ();
     fb_create_info.layers          = m_create_info_ptr->get_n_layers();
-    fb_create_info.pAttachments    = (fb_create_info.attachmentCount > 0) ? &image_view_attachments[0]
+    fb_create_info.pAttachments    = (!is_imageless && n_attachments > 0) ? &image_view_attachments[0]
                                                                           : nullptr;
-    fb_create_info.pNext           = nullptr;
+    fb_create_info.pNext           = (is_imageless) ? &fb_attachments_create_info
+                                                    : nullptr;
     fb_create_info.renderPass      = in_render_pass_ptr->get_render_pass();
     fb_create_info.sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
     fb_create_info.width           = m_create_info_ptr->get_width();
 
     /* Create the framebuffer instance and store it */
-    result_vk = Anvil::Vulkan::vkCreateFramebuffer(m_device_ptr->get_device_vk(),
-                                                  &fb_create_info,
-                                                   nullptr, /* pAllocator */
-                                                  &result_fb);
+    result_vk = m_device_ptr->get_dispatch_table().vkCreateFramebuffer(m_device_ptr->get_device_vk(),
+                                                                      &fb_create_info,
+                                                                       m_device_ptr->get_allocation_callbacks_vk(),
+                                                                      &result_fb);
 
     anvil_assert_vk_call_succeeded(result_vk);
     if (is_vk_call_successful(result_vk) )
@@ -23,9 +23,11 @@
 #include <algorithm>
 #include "misc/base_pipeline_create_info.h"
 #include "misc/base_pipeline_manager.h"
+#include "misc/command_arena.h"
 #include "misc/debug.h"
 #include "misc/object_tracker.h"
 #include "misc/render_pass_create_info.h"
+#include "misc/tracing.h"
 #include "wrappers/device.h"
 #include "wrappers/graphics_pipeline_manager.h"
 #include "wrappers/pipeline_cache.h"
@@ -38,6 +40,9 @@
     #undef max
 #endif
 
+/* Size of a single chunk of the arena backing the Vulkan descriptors formed by bake_pipelines(). Large enough to hold
+ * a handful of typical pipelines without spilling over to another chunk. */
+static const size_t g_bake_arena_chunk_size = 65536;
 
 /* Please see header for specification */
 Anvil::GraphicsPipelineManager::GraphicsPipelineManager(const Anvil::BaseDevice* in_device_ptr,
@@ -47,7 +52,9 @@ Anvil::GraphicsPipelineManager::GraphicsPipelineManager(const Anvil::BaseDevice*
     :BasePipelineManager(in_device_ptr,
                          in_mt_safe,
                          in_use_pipeline_cache,
-                         in_pipeline_cache_to_reuse_ptr)
+                         in_pipeline_cache_to_reuse_ptr),
+     m_automatic_derivatives_enabled (false),
+     m_pipeline_deduplication_enabled(false)
 {
     /* Register the object */
     Anvil::ObjectTracker::get()->register_object(Anvil::ObjectType::ANVIL_GRAPHICS_PIPELINE_MANAGER,
@@ -57,8 +64,13 @@ Anvil::GraphicsPipelineManager::GraphicsPipelineManager(const Anvil::BaseDevice*
 /* Please see header for specification */
 Anvil::GraphicsPipelineManager::~GraphicsPipelineManager()
 {
-    m_baked_pipelines.clear      ();
-    m_outstanding_pipelines.clear();
+    set_async_compilation_enabled(false);
+
+    m_baked_pipelines.clear                  ();
+    m_deduplicated_pipeline_ids_by_hash.clear();
+    m_deduplicated_pipelines.clear           ();
+    m_derivative_base_pipeline_ids.clear     ();
+    m_outstanding_pipelines.clear            ();
 
     /* Unregister the object */
     Anvil::ObjectTracker::get()->unregister_object(Anvil::ObjectType::ANVIL_GRAPHICS_PIPELINE_MANAGER,
@@ -66,8 +78,72 @@ Anvil::GraphicsPipelineManager::~GraphicsPipelineManager()
 }
 
 /* Please see header for specification */
-bool Anvil::GraphicsPipelineManager::bake()
+bool Anvil::GraphicsPipelineManager::add_pipeline(Anvil::BasePipelineCreateInfoUniquePtr in_pipeline_create_info_ptr,
+                                                  PipelineID*                            out_pipeline_id_ptr,
+                                                  PipelineID                             in_opt_fallback_pipeline_id)
+{
+    bool     is_deduplicated = false;
+    uint64_t hash            = 0;
+    bool     result          = false;
+
+    lock();
+    {
+        if (m_pipeline_deduplication_enabled        &&
+            in_pipeline_create_info_ptr != nullptr  &&
+           !in_pipeline_create_info_ptr->is_proxy() )
+        {
+            const auto gfx_pipeline_create_info_ptr = dynamic_cast<const Anvil::GraphicsPipelineCreateInfo*>(in_pipeline_create_info_ptr.get() );
+
+            anvil_assert(gfx_pipeline_create_info_ptr != nullptr);
+
+            hash            = gfx_pipeline_create_info_ptr->get_hash();
+            is_deduplicated = true;
+
+            auto bucket_iterator = m_deduplicated_pipeline_ids_by_hash.find(hash);
+
+            if (bucket_iterator != m_deduplicated_pipeline_ids_by_hash.end() )
+            {
+                for (const auto& current_pipeline_id : bucket_iterator->second)
+                {
+                    /* NOTE: Pipelines which failed to compile asynchronously are dropped by the manager, so the create info may
+                     *       be unavailable. */
+                    const auto current_pipeline_create_info_ptr = dynamic_cast<const Anvil::GraphicsPipelineCreateInfo*>(get_pipeline_create_info(current_pipeline_id) );
+
+                    if (current_pipeline_create_info_ptr != nullptr                         &&
+                       *current_pipeline_create_info_ptr == *gfx_pipeline_create_info_ptr)
+                    {
+                        m_deduplicated_pipelines.at(current_pipeline_id).n_references++;
+
+                        *out_pipeline_id_ptr = current_pipeline_id;
+                        result               = true;
+
+                        goto end;
+                    }
+                }
+            }
+        }
+
+        result = BasePipelineManager::add_pipeline(std::move(in_pipeline_create_info_ptr),
+                                                   out_pipeline_id_ptr,
+                                                   in_opt_fallback_pipeline_id);
+
+        if (result && is_deduplicated)
+        {
+            m_deduplicated_pipeline_ids_by_hash[hash].push_back(*out_pipeline_id_ptr);
+            m_deduplicated_pipelines[*out_pipeline_id_ptr] = DeduplicatedPipeline(hash);
+        }
+    }
+end:
+    unlock();
+
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::GraphicsPipelineManager::bake_pipelines(Pipelines* inout_pipelines_ptr)
 {
+    ANVIL_TRACE_SPAN("GraphicsPipelineManager::bake");
+
     typedef struct BakeItem
     {
         PipelineID pipeline_id;
@@ -86,35 +162,30 @@ bool Anvil::GraphicsPipelineManager::bake()
         }
     } BakeItem;
 
-    std::vector<BakeItem>                  bake_items;
-    auto                                   color_blend_state_create_info_chain_cache          = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineColorBlendStateCreateInfo> > >   ();
-    auto                                   depth_stencil_state_create_info_chain_cache        = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineDepthStencilStateCreateInfo> > > ();
-    auto                                   dynamic_state_create_info_chain_cache              = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineDynamicStateCreateInfo> > >      ();
-    auto                                   graphics_pipeline_create_info_chains               = Anvil::StructChainVector<VkGraphicsPipelineCreateInfo>                                    ();
-    auto                                   input_assembly_state_create_info_chain_cache       = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineInputAssemblyStateCreateInfo> > >();
-    auto                                   multisample_state_create_info_chain_cache          = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineMultisampleStateCreateInfo> > >  ();
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr                                          = get_mutex();
-    uint32_t                               n_consumed_graphics_pipelines                      = 0;
-    auto                                   raster_state_create_info_chain_cache               = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineRasterizationStateCreateInfo> > >();
-    bool                                   result                                             = false;
-    std::vector<VkPipeline>                result_graphics_pipelines;
-    VkResult                               result_vk;
-    auto                                   shader_stage_create_info_chain_ptrs                = std::vector<std::unique_ptr<Anvil::StructChainVector<VkPipelineShaderStageCreateInfo> > >();
-    auto                                   tessellation_state_create_info_chain_cache         = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineTessellationStateCreateInfo> > >();
-    auto                                   vertex_input_state_create_info_chain_cache         = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineVertexInputStateCreateInfo> > > ();
-    auto                                   viewport_state_create_info_chain_cache             = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineViewportStateCreateInfo> > >    ();
-
+    /* All Vulkan descriptors formed below only need to live until vkCreateGraphicsPipelines() returns, so they are
+     * carved out of a single arena, instead of being allocated one by one. The arena is local to the call, since
+     * create_pipelines() may release the manager lock for the duration of the driver call. */
+    Anvil::CommandArena                        bake_arena                        (g_bake_arena_chunk_size);
+    std::vector<BakeItem>                      bake_items;
+    bool                                       can_be_split                       = true;
+    auto                                       creation_feedback_storages         = std::vector<std::unique_ptr<CreationFeedbackStorage> >();
+    VkGraphicsPipelineCreateInfo*              graphics_pipeline_create_infos_ptr = nullptr;
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr                          = get_mutex();
+    uint32_t                                   n_consumed_graphics_pipelines      = 0;
+    uint32_t                                   n_graphics_pipeline_create_infos   = 0;
+    bool                                       result                             = false;
+    std::vector<VkPipeline>                    result_graphics_pipelines;
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
         );
     }
 
-    for (auto pipeline_iterator  = m_outstanding_pipelines.begin();
-              pipeline_iterator != m_outstanding_pipelines.end();
+    for (auto pipeline_iterator  = inout_pipelines_ptr->begin();
+              pipeline_iterator != inout_pipelines_ptr->end();
             ++pipeline_iterator)
     {
         if (pipeline_iterator->second->layout_ptr == nullptr)
@@ -137,24 +208,31 @@ bool Anvil::GraphicsPipelineManager::bake()
         goto end;
     }
 
+    graphics_pipeline_create_infos_ptr = static_cast<VkGraphicsPipelineCreateInfo*>(bake_arena.allocate(sizeof(VkGraphicsPipelineCreateInfo) * bake_items.size(),
+                                                                                                        alignof(VkGraphicsPipelineCreateInfo) ));
+
     for (auto bake_item_iterator  = bake_items.begin();
               bake_item_iterator != bake_items.end();
             ++bake_item_iterator)
     {
-        bool                                               color_blend_state_used                = false;
-        auto                                               current_pipeline_create_info_ptr      = dynamic_cast<GraphicsPipelineCreateInfo*>(bake_item_iterator->pipeline_ptr->pipeline_create_info_ptr.get() );
-        Pipeline*                                          current_pipeline_ptr                  = bake_item_iterator->pipeline_ptr;
-        const Anvil::RenderPass*                           current_pipeline_renderpass_ptr       = nullptr;
-        Anvil::SubPassID                                   current_pipeline_subpass_id;
-        bool                                               depth_stencil_state_used              = false;
-        bool                                               dynamic_state_used                    = false;
-        Anvil::StructChainer<VkGraphicsPipelineCreateInfo> graphics_pipeline_create_info_chainer;
-        bool                                               is_dynamic_scissor_state_enabled      = false;
-        bool                                               is_dynamic_viewport_state_enabled     = false;
-        bool                                               multisample_state_used                = false;
-        uint32_t                                           n_shader_stages_used                  = 0;
-        bool                                               tessellation_state_used               = false;
-        bool                                               viewport_state_used                   = false;
+        const VkPipelineColorBlendStateCreateInfo*    color_blend_state_create_info_ptr    = nullptr;
+        auto                                          current_pipeline_create_info_ptr     = dynamic_cast<GraphicsPipelineCreateInfo*>(bake_item_iterator->pipeline_ptr->pipeline_create_info_ptr.get() );
+        Pipeline*                                     current_pipeline_ptr                 = bake_item_iterator->pipeline_ptr;
+        const Anvil::RenderPass*                      current_pipeline_renderpass_ptr      = nullptr;
+        Anvil::SubPassID                              current_pipeline_subpass_id;
+        const VkPipelineDepthStencilStateCreateInfo*  depth_stencil_state_create_info_ptr  = nullptr;
+        const VkPipelineDynamicStateCreateInfo*       dynamic_state_create_info_ptr        = nullptr;
+        const VkPipelineInputAssemblyStateCreateInfo* input_assembly_state_create_info_ptr = nullptr;
+        bool                                          is_dynamic_scissor_state_enabled     = false;
+        bool                                          is_dynamic_viewport_state_enabled    = false;
+        const VkPipelineMultisampleStateCreateInfo*   multisample_state_create_info_ptr    = nullptr;
+        uint32_t                                      n_shader_stages_used                 = 0;
+        const VkPipelineRasterizationStateCreateInfo* raster_state_create_info_ptr         = nullptr;
+        const VkPipelineShaderStageCreateInfo*        shader_stage_create_info_items_ptr   = nullptr;
+        const VkPipelineTessellationStateCreateInfo*  tessellation_state_create_info_ptr   = nullptr;
+        bool                                          uses_mesh_shading                    = false;
+        const VkPipelineVertexInputStateCreateInfo*   vertex_input_state_create_info_ptr   = nullptr;
+        const VkPipelineViewportStateCreateInfo*      viewport_state_create_info_ptr       = nullptr;
 
         if (current_pipeline_create_info_ptr == nullptr)
         {
@@ -171,19 +249,16 @@ bool Anvil::GraphicsPipelineManager::bake()
             continue;
         }
 
+        uses_mesh_shading = current_pipeline_create_info_ptr->uses_mesh_shading();
+
         /* Form the color blend state create info descriptor, if needed */
         {
-            auto color_blend_state_create_info_chain_ptr = bake_pipeline_color_blend_state_create_info(current_pipeline_create_info_ptr,
-                                                                                                       current_pipeline_renderpass_ptr,
-                                                                                                       current_pipeline_subpass_id);
-
-            if (color_blend_state_create_info_chain_ptr != nullptr)
-            {
-                color_blend_state_create_info_chain_cache.push_back(std::move(color_blend_state_create_info_chain_ptr) );
+            color_blend_state_create_info_ptr = bake_pipeline_color_blend_state_create_info(&bake_arena,
+                                                                                             current_pipeline_create_info_ptr,
+                                                                                             current_pipeline_renderpass_ptr,
+                                                                                             current_pipeline_subpass_id);
 
-                color_blend_state_used = true;
-            }
-            else
+            if (color_blend_state_create_info_ptr == nullptr)
             {
                 /* No color attachments available. Make sure none of the dependent modes are enabled. */
                 bool logic_op_enabled = false;
@@ -192,33 +267,19 @@ bool Anvil::GraphicsPipelineManager::bake()
                                                                      nullptr); /* out_opt_logic_op_ptr */
 
                 anvil_assert(!logic_op_enabled);
-
-                color_blend_state_used = false;
             }
         }
 
         /* Form the depth stencil state create info descriptor, if needed */
-        {
-            auto depth_stencil_state_create_info_chain_ptr = bake_pipeline_depth_stencil_state_create_info(current_pipeline_create_info_ptr,
-                                                                                                           current_pipeline_renderpass_ptr);
-
-            if (depth_stencil_state_create_info_chain_ptr != nullptr)
-            {
-                depth_stencil_state_create_info_chain_cache.push_back(std::move(depth_stencil_state_create_info_chain_ptr) );
-
-                depth_stencil_state_used = true;
-            }
-            else
-            {
-                depth_stencil_state_used = false;
-            }
-        }
+        depth_stencil_state_create_info_ptr = bake_pipeline_depth_stencil_state_create_info(&bake_arena,
+                                                                                             current_pipeline_create_info_ptr,
+                                                                                             current_pipeline_renderpass_ptr);
 
         /* Form the dynamic state create info descriptor, if needed */
         {
-            auto dynamic_state_create_info_ptr = bake_pipeline_dynamic_state_create_info(current_pipeline_create_info_ptr);
+            dynamic_state_create_info_ptr = bake_pipeline_dynamic_state_create_info(&bake_arena,
+                                                                                     current_pipeline_create_info_ptr);
 
-            dynamic_state_used                = false;
             is_dynamic_scissor_state_enabled  = false;
             is_dynamic_viewport_state_enabled = false;
 
@@ -244,105 +305,104 @@ bool Anvil::GraphicsPipelineManager::bake()
                         is_dynamic_viewport_state_enabled = true;
                     }
                 }
-
-                dynamic_state_used = true;
-
-                dynamic_state_create_info_chain_cache.push_back(std::move(dynamic_state_create_info_ptr) );
             }
         }
 
-        /* Form the input assembly create info descriptor */
+        /* Form the input assembly create info descriptor. Mesh shading pipelines ignore this state. */
+        if (!uses_mesh_shading)
         {
-            auto input_assembly_create_info_ptr = bake_pipeline_input_assembly_state_create_info(current_pipeline_create_info_ptr);
-
-            anvil_assert(input_assembly_create_info_ptr != nullptr);
+            input_assembly_state_create_info_ptr = bake_pipeline_input_assembly_state_create_info(&bake_arena,
+                                                                                                   current_pipeline_create_info_ptr);
 
-            input_assembly_state_create_info_chain_cache.push_back(std::move(input_assembly_create_info_ptr) );
+            anvil_assert(input_assembly_state_create_info_ptr != nullptr);
         }
 
         /* Form the multisample state create info descriptor, if needed */
-        {
-            auto multisample_state_create_info_ptr = bake_pipeline_multisample_state_create_info(current_pipeline_create_info_ptr);
-
-            if (multisample_state_create_info_ptr != nullptr)
-            {
-                multisample_state_used = true;
-            }
-            else
-            {
-                multisample_state_used = false;
-            }
-
-            multisample_state_create_info_chain_cache.push_back(std::move(multisample_state_create_info_ptr) );
-        }
+        multisample_state_create_info_ptr = bake_pipeline_multisample_state_create_info(&bake_arena,
+                                                                                         current_pipeline_create_info_ptr);
 
         /* Form the raster state create info chain */
-        {
-            auto raster_state_create_info_ptr = bake_pipeline_rasterization_state_create_info(current_pipeline_create_info_ptr);
-
-            anvil_assert(raster_state_create_info_ptr != nullptr);
+        raster_state_create_info_ptr = bake_pipeline_rasterization_state_create_info(&bake_arena,
+                                                                                      current_pipeline_create_info_ptr);
 
-            raster_state_create_info_chain_cache.push_back(std::move(raster_state_create_info_ptr) );
-        }
+        anvil_assert(raster_state_create_info_ptr != nullptr);
 
         /* Form stage descriptors */
-        {
-            auto shader_stage_create_info_chain_vec_ptr = bake_pipeline_shader_stage_create_info_chain_vector(current_pipeline_create_info_ptr);
-            anvil_assert(shader_stage_create_info_chain_vec_ptr != nullptr);
-
-            n_shader_stages_used = shader_stage_create_info_chain_vec_ptr->get_n_structs();
-
-            shader_stage_create_info_chain_ptrs.push_back(std::move(shader_stage_create_info_chain_vec_ptr) );
-        }
+        shader_stage_create_info_items_ptr = bake_pipeline_shader_stage_create_info_items(&bake_arena,
+                                                                                           current_pipeline_create_info_ptr,
+                                                                                          &n_shader_stages_used);
 
         /* Form the tessellation state create info descriptor if needed */
-        {
-            auto tessellation_state_create_info_ptr = bake_pipeline_tessellation_state_create_info(current_pipeline_create_info_ptr);
-
-            if (tessellation_state_create_info_ptr != nullptr)
-            {
-                tessellation_state_create_info_chain_cache.push_back(std::move(tessellation_state_create_info_ptr) );
-
-                tessellation_state_used = true;
-            }
-            else
-            {
-                tessellation_state_used = false;
-            }
-        }
+        tessellation_state_create_info_ptr = bake_pipeline_tessellation_state_create_info(&bake_arena,
+                                                                                           current_pipeline_create_info_ptr);
 
-        /* Form the vertex input state create info descriptor */
+        /* Form the vertex input state create info descriptor. Mesh shading pipelines ignore this state. */
+        if (!uses_mesh_shading)
         {
-            auto vertex_input_state_create_info_ptr = bake_pipeline_vertex_input_state_create_info(current_pipeline_create_info_ptr);
+            vertex_input_state_create_info_ptr = bake_pipeline_vertex_input_state_create_info(&bake_arena,
+                                                                                               current_pipeline_create_info_ptr);
 
             anvil_assert(vertex_input_state_create_info_ptr != nullptr);
-
-            vertex_input_state_create_info_chain_cache.push_back(std::move(vertex_input_state_create_info_ptr) );
         }
 
         /* Form the viewport state create info descriptor, if needed */
-        {
-            auto viewport_state_create_info_ptr = bake_pipeline_viewport_state_create_info(current_pipeline_create_info_ptr,
-                                                                                           is_dynamic_scissor_state_enabled,
-                                                                                           is_dynamic_viewport_state_enabled);
-
-            if (viewport_state_create_info_ptr != nullptr)
-            {
-                viewport_state_create_info_chain_cache.push_back(std::move(viewport_state_create_info_ptr) );
-
-                viewport_state_used = true;
-            }
-            else
-            {
-                viewport_state_used = false;
-            }
-        }
+        viewport_state_create_info_ptr = bake_pipeline_viewport_state_create_info(&bake_arena,
+                                                                                   current_pipeline_create_info_ptr,
+                                                                                   is_dynamic_scissor_state_enabled,
+                                                                                   is_dynamic_viewport_state_enabled);
 
         /* Bake the GFX pipeline info struct chain */
         {
             VkPipeline base_pipeline_handle              = VK_NULL_HANDLE;
             int32_t    base_pipeline_index               = UINT32_MAX;
-            const auto current_pipeline_base_pipeline_id = current_pipeline_create_info_ptr->get_base_pipeline_id();
+            auto       current_pipeline_base_pipeline_id = current_pipeline_create_info_ptr->get_base_pipeline_id();
+            bool       is_derivative_group_base          = false;
+
+            if (current_pipeline_base_pipeline_id == UINT32_MAX &&
+                m_automatic_derivatives_enabled)
+            {
+                /* Derive from the first pipeline baked for the same layout, subpass and shader combination, as long as
+                 * it is still available. Pipelines baked in this call can only be used if they precede the current one.
+                 * Otherwise, the current pipeline becomes the new base for the group. */
+                std::vector<uint64_t> derivative_key;
+
+                get_derivative_key(current_pipeline_create_info_ptr,
+                                   current_pipeline_ptr->layout_ptr.get(),
+                                  &derivative_key);
+
+                auto group_iterator = m_derivative_base_pipeline_ids.find(derivative_key);
+
+                if (group_iterator != m_derivative_base_pipeline_ids.end() )
+                {
+                    auto base_bake_item_iterator = std::find(bake_items.begin(),
+                                                             bake_item_iterator,
+                                                             group_iterator->second);
+
+                    if (base_bake_item_iterator != bake_item_iterator)
+                    {
+                        current_pipeline_base_pipeline_id = group_iterator->second;
+                    }
+                    else
+                    {
+                        auto baked_pipeline_iterator = m_baked_pipelines.find(group_iterator->second);
+
+                        if (baked_pipeline_iterator                         != m_baked_pipelines.end() &&
+                            baked_pipeline_iterator->second->baked_pipeline != VK_NULL_HANDLE          &&
+                            std::find(bake_item_iterator,
+                                      bake_items.end(),
+                                      group_iterator->second) == bake_items.end() )
+                        {
+                            current_pipeline_base_pipeline_id = group_iterator->second;
+                        }
+                    }
+                }
+
+                if (current_pipeline_base_pipeline_id == UINT32_MAX)
+                {
+                    m_derivative_base_pipeline_ids[derivative_key] = bake_item_iterator->pipeline_id;
+                    is_derivative_group_base                       = true;
+                }
+            }
 
             if (current_pipeline_base_pipeline_id != UINT32_MAX)
             {
@@ -354,7 +414,7 @@ bool Anvil::GraphicsPipelineManager::bake()
                  * 3. The pipeline under specified index uses a different layout. This indicates
                  *    a bug in the app or the manager.
                  *
-                 * NOTE: A slightly adjusted version of this code is re-used in ComputePipelineManager::bake()
+                 * NOTE: A slightly adjusted version of this code is re-used in ComputePipelineManager::bake_pipelines()
                  */
                 auto base_bake_item_iterator = std::find(bake_items.begin(),
                                                          bake_items.end(),
@@ -362,8 +422,10 @@ bool Anvil::GraphicsPipelineManager::bake()
 
                 if (base_bake_item_iterator != bake_items.end() )
                 {
-                    /* Case 1 */
+                    /* Case 1. Index-based references must be resolved within a single vkCreateGraphicsPipelines() call,
+                     *         so the batch cannot be distributed across bake threads. */
                     base_pipeline_index = static_cast<int32_t>(base_bake_item_iterator - bake_items.begin() );
+                    can_be_split        = false;
                 }
                 else
                 {
@@ -387,72 +449,86 @@ bool Anvil::GraphicsPipelineManager::bake()
                 /* No base pipeline requested */
             }
 
-            auto result_ptr = bake_graphics_pipeline_create_info(current_pipeline_create_info_ptr,
-                                                                 current_pipeline_ptr->layout_ptr.get(),
-                                                                 base_pipeline_handle,
-                                                                 base_pipeline_index,
-                                                                 (color_blend_state_used)    ? color_blend_state_create_info_chain_cache.back()->get_root_struct()
-                                                                                             : nullptr,
-                                                                 (depth_stencil_state_used)  ? depth_stencil_state_create_info_chain_cache.back()->get_root_struct()
-                                                                                             : nullptr,
-                                                                 (dynamic_state_used)        ? dynamic_state_create_info_chain_cache.back()->get_root_struct()
-                                                                                             : nullptr,
-                                                                 input_assembly_state_create_info_chain_cache.back()->get_root_struct(),
-                                                                 (multisample_state_used)    ? multisample_state_create_info_chain_cache.back()->get_root_struct()
-                                                                                             : nullptr,
-                                                                 raster_state_create_info_chain_cache.back()->root_struct_ptr,
-                                                                 n_shader_stages_used,
-                                                                 (n_shader_stages_used > 0)  ? shader_stage_create_info_chain_ptrs.back()->get_root_structs()
-                                                                                             : nullptr,
-                                                                 (tessellation_state_used)   ? tessellation_state_create_info_chain_cache.back()->get_root_struct()
-                                                                                             : nullptr,
-                                                                 vertex_input_state_create_info_chain_cache.back()->get_root_struct(),
-                                                                 (viewport_state_used)       ? viewport_state_create_info_chain_cache.back()->get_root_struct()
-                                                                                             : nullptr);
+            auto root_struct_ptr = bake_graphics_pipeline_create_info(&bake_arena,
+                                                                      current_pipeline_create_info_ptr,
+                                                                      current_pipeline_ptr->layout_ptr.get(),
+                                                                      base_pipeline_handle,
+                                                                      base_pipeline_index,
+                                                                      color_blend_state_create_info_ptr,
+                                                                      depth_stencil_state_create_info_ptr,
+                                                                      dynamic_state_create_info_ptr,
+                                                                      input_assembly_state_create_info_ptr,
+                                                                      multisample_state_create_info_ptr,
+                                                                      raster_state_create_info_ptr,
+                                                                      n_shader_stages_used,
+                                                                      shader_stage_create_info_items_ptr,
+                                                                      tessellation_state_create_info_ptr,
+                                                                      vertex_input_state_create_info_ptr,
+                                                                      viewport_state_create_info_ptr);
+
+            if (is_derivative_group_base)
+            {
+                root_struct_ptr->flags |= VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT;
+            }
+
+            /* Ask the driver to report how long it took to create the pipeline, and whether the pipeline cache has been hit */
+            creation_feedback_storages.push_back(
+                chain_creation_feedback(root_struct_ptr->stageCount,
+                                        root_struct_ptr->pStages,
+                                       &root_struct_ptr->pNext)
+            );
 
             /* Stash the descriptor for now. We will issue one expensive vkCreateGraphicsPipelines() call after all pipeline objects
-             * are iterated over. */
-            graphics_pipeline_create_info_chains.append_struct_chain(std::move(result_ptr) );
+             * are iterated over. The pNext chain stays in the arena, so a shallow copy is sufficient. */
+            graphics_pipeline_create_infos_ptr[n_graphics_pipeline_create_infos++] = *root_struct_ptr;
         }
     }
 
-    /* All right. Try to bake all pipeline objects at once */
+    /* All right. Try to bake all pipeline objects at once, distributing the work across bake threads if allowed */
     result_graphics_pipelines.resize(bake_items.size() );
 
-    m_pipeline_cache_ptr->lock();
+    if (!create_pipelines(n_graphics_pipeline_create_infos,
+                          can_be_split,
+                          [this, graphics_pipeline_create_infos_ptr](VkPipelineCache in_pipeline_cache,
+                                                                     uint32_t        in_n_first_pipeline,
+                                                                     uint32_t        in_n_pipelines,
+                                                                     VkPipeline*     out_pipelines_ptr)
+                          {
+                              return m_device_ptr->get_dispatch_table().vkCreateGraphicsPipelines(m_device_ptr->get_device_vk(),
+                                                                                                  in_pipeline_cache,
+                                                                                                  in_n_pipelines,
+                                                                                                  graphics_pipeline_create_infos_ptr + in_n_first_pipeline,
+                                                                                                  m_device_ptr->get_allocation_callbacks_vk(),
+                                                                                                  out_pipelines_ptr);
+                          },
+                          (result_graphics_pipelines.size() > 0) ? &result_graphics_pipelines.at(0)
+                                                                 : nullptr))
     {
-        result_vk = Anvil::Vulkan::vkCreateGraphicsPipelines(m_device_ptr->get_device_vk(),
-                                                             m_pipeline_cache_ptr->get_pipeline_cache(),
-                                                             graphics_pipeline_create_info_chains.get_n_structs   (),
-                                                             graphics_pipeline_create_info_chains.get_root_structs(),
-                                                             nullptr, /* pAllocator */
-                                                            &result_graphics_pipelines[0]);
-    }
-    m_pipeline_cache_ptr->unlock();
-
-    if (!is_vk_call_successful(result_vk) )
-    {
-        anvil_assert_vk_call_succeeded(result_vk);
-
         goto end;
     }
 
     /* Distribute the result pipeline objects to pipeline configuration descriptors */
-    for (auto pipeline_iterator  = m_outstanding_pipelines.begin();
-              pipeline_iterator != m_outstanding_pipelines.end();
+    for (auto pipeline_iterator  = inout_pipelines_ptr->begin();
+              pipeline_iterator != inout_pipelines_ptr->end();
             ++pipeline_iterator)
     {
         const PipelineID& current_pipeline_id = pipeline_iterator->first;
 
         anvil_assert(m_baked_pipelines.find(current_pipeline_id) == m_baked_pipelines.end() );
 
+        if (n_consumed_graphics_pipelines < static_cast<uint32_t>(creation_feedback_storages.size() ))
+        {
+            store_creation_feedback(creation_feedback_storages.at(n_consumed_graphics_pipelines).get(),
+                                    pipeline_iterator->second.get() );
+        }
+
         pipeline_iterator->second->baked_pipeline = result_graphics_pipelines[n_consumed_graphics_pipelines++];
         m_baked_pipelines[current_pipeline_id]    = std::move(pipeline_iterator->second);
     }
 
     anvil_assert(n_consumed_graphics_pipelines == static_cast<uint32_t>(result_graphics_pipelines.size() ));
 
-    m_outstanding_pipelines.clear();
+    inout_pipelines_ptr->clear();
 
     /* All done */
     result = true;
@@ -461,23 +537,25 @@ end:
 }
 
 /* Please see header for specification */
-Anvil::StructChainUniquePtr<VkGraphicsPipelineCreateInfo> Anvil::GraphicsPipelineManager::bake_graphics_pipeline_create_info(const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr,
-                                                                                                                             const Anvil::PipelineLayout*                  in_pipeline_layout_ptr,
-                                                                                                                             const VkPipeline&                             in_opt_base_pipeline_handle,
-                                                                                                                             const int32_t&                                in_opt_base_pipeline_index,
-                                                                                                                             const VkPipelineColorBlendStateCreateInfo*    in_opt_color_blend_state_create_info_ptr,
-                                                                                                                             const VkPipelineDepthStencilStateCreateInfo*  in_opt_depth_stencil_state_create_info_ptr,
-                                                                                                                             const VkPipelineDynamicStateCreateInfo*       in_opt_dynamic_state_create_info_ptr,
-                                                                                                                             const VkPipelineInputAssemblyStateCreateInfo* in_input_assembly_state_create_info_ptr,
-                                                                                                                             const VkPipelineMultisampleStateCreateInfo*   in_opt_multisample_state_create_info_ptr,
-                                                                                                                             const VkPipelineRasterizationStateCreateInfo* in_rasterization_state_create_info_ptr,
-                                                                                                                             const uint32_t&                               in_n_shader_stage_create_info_items,
-                                                                                                                             const VkPipelineShaderStageCreateInfo*        in_shader_stage_create_info_items_ptr,
-                                                                                                                             const VkPipelineTessellationStateCreateInfo*  in_opt_tessellation_state_create_info_ptr,
-                                                                                                                             const VkPipelineVertexInputStateCreateInfo*   in_vertex_input_state_create_info_ptr,
-                                                                                                                             const VkPipelineViewportStateCreateInfo*      in_opt_viewport_state_create_info_ptr) const
+VkGraphicsPipelineCreateInfo* Anvil::GraphicsPipelineManager::bake_graphics_pipeline_create_info(Anvil::CommandArena*                          in_arena_ptr,
+                                                                                                 const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr,
+                                                                                                 const Anvil::PipelineLayout*                  in_pipeline_layout_ptr,
+                                                                                                 const VkPipeline&                             in_opt_base_pipeline_handle,
+                                                                                                 const int32_t&                                in_opt_base_pipeline_index,
+                                                                                                 const VkPipelineColorBlendStateCreateInfo*    in_opt_color_blend_state_create_info_ptr,
+                                                                                                 const VkPipelineDepthStencilStateCreateInfo*  in_opt_depth_stencil_state_create_info_ptr,
+                                                                                                 const VkPipelineDynamicStateCreateInfo*       in_opt_dynamic_state_create_info_ptr,
+                                                                                                 const VkPipelineInputAssemblyStateCreateInfo* in_input_assembly_state_create_info_ptr,
+                                                                                                 const VkPipelineMultisampleStateCreateInfo*   in_opt_multisample_state_create_info_ptr,
+                                                                                                 const VkPipelineRasterizationStateCreateInfo* in_rasterization_state_create_info_ptr,
+                                                                                                 const uint32_t&                               in_n_shader_stage_create_info_items,
+                                                                                                 const VkPipelineShaderStageCreateInfo*        in_shader_stage_create_info_items_ptr,
+                                                                                                 const VkPipelineTessellationStateCreateInfo*  in_opt_tessellation_state_create_info_ptr,
+                                                                                                 const VkPipelineVertexInputStateCreateInfo*   in_vertex_input_state_create_info_ptr,
+                                                                                                 const VkPipelineViewportStateCreateInfo*      in_opt_viewport_state_create_info_ptr) const
 {
     Anvil::StructChainer<VkGraphicsPipelineCreateInfo> chainer;
+    const Anvil::RenderPass*                           renderpass_ptr = in_gfx_pipeline_create_info_ptr->get_renderpass();
 
     {
         VkGraphicsPipelineCreateInfo create_info;
@@ -497,48 +575,113 @@ Anvil::StructChainUniquePtr<VkGraphicsPipelineCreateInfo> Anvil::GraphicsPipelin
         create_info.pTessellationState  = in_opt_tessellation_state_create_info_ptr;
         create_info.pVertexInputState   = in_vertex_input_state_create_info_ptr;
         create_info.pViewportState      = in_opt_viewport_state_create_info_ptr;
-        create_info.renderPass          = in_gfx_pipeline_create_info_ptr->get_renderpass()->get_render_pass();
+        create_info.renderPass          = (renderpass_ptr != nullptr) ? renderpass_ptr->get_render_pass()
+                                                                      : VK_NULL_HANDLE;
         create_info.stageCount          = in_n_shader_stage_create_info_items;
         create_info.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
         create_info.subpass             = in_gfx_pipeline_create_info_ptr->get_subpass_id();
 
-        if (create_info.basePipelineIndex != static_cast<int32_t>(UINT32_MAX) )
+        if (create_info.basePipelineHandle != VK_NULL_HANDLE                     ||
+            create_info.basePipelineIndex  != static_cast<int32_t>(UINT32_MAX) )
         {
             create_info.flags |= VK_PIPELINE_CREATE_DERIVATIVE_BIT;
         }
 
-        create_info.flags |= ((in_gfx_pipeline_create_info_ptr->allows_derivatives        () ) ? VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT    : 0) |
-                             ((in_gfx_pipeline_create_info_ptr->has_optimizations_disabled() ) ? VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT : 0);
+        create_info.flags |= ((in_gfx_pipeline_create_info_ptr->allows_derivatives        () ) ? VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT      : 0) |
+                             ((in_gfx_pipeline_create_info_ptr->captures_statistics       () ) ? VK_PIPELINE_CREATE_CAPTURE_STATISTICS_BIT_KHR : 0) |
+                             ((in_gfx_pipeline_create_info_ptr->has_optimizations_disabled() ) ? VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT   : 0);
 
         chainer.append_struct(create_info);
     }
 
-    return chainer.create_chain();
+    if (in_gfx_pipeline_create_info_ptr->uses_dynamic_rendering() )
+    {
+        const Anvil::Format*             color_attachment_formats_ptr = nullptr;
+        std::vector<VkFormat>            color_attachment_formats_vk;
+        Anvil::Format                    depth_attachment_format      = Anvil::Format::UNKNOWN;
+        uint32_t                         n_color_attachment_formats   = 0;
+        VkPipelineRenderingCreateInfoKHR rendering_create_info;
+        Anvil::StructID                  rendering_create_info_struct_id;
+        Anvil::Format                    stencil_attachment_format    = Anvil::Format::UNKNOWN;
+        uint32_t                         view_mask                    = 0;
+
+        anvil_assert(renderpass_ptr == nullptr);
+        anvil_assert(m_device_ptr->get_extension_info()->khr_dynamic_rendering() );
+
+        in_gfx_pipeline_create_info_ptr->get_rendering_properties(&view_mask,
+                                                                  &n_color_attachment_formats,
+                                                                  &color_attachment_formats_ptr,
+                                                                  &depth_attachment_format,
+                                                                  &stencil_attachment_format);
+
+        for (uint32_t n_color_attachment_format = 0;
+                      n_color_attachment_format < n_color_attachment_formats;
+                    ++n_color_attachment_format)
+        {
+            color_attachment_formats_vk.push_back(static_cast<VkFormat>(color_attachment_formats_ptr[n_color_attachment_format]) );
+        }
+
+        rendering_create_info.colorAttachmentCount    = n_color_attachment_formats;
+        rendering_create_info.depthAttachmentFormat   = static_cast<VkFormat>(depth_attachment_format);
+        rendering_create_info.pColorAttachmentFormats = nullptr; /* will be patched by the chainer */
+        rendering_create_info.pNext                   = nullptr;
+        rendering_create_info.stencilAttachmentFormat = static_cast<VkFormat>(stencil_attachment_format);
+        rendering_create_info.sType                   = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+        rendering_create_info.viewMask                = view_mask;
+
+        rendering_create_info_struct_id = chainer.append_struct(rendering_create_info);
+
+        if (n_color_attachment_formats > 0)
+        {
+            chainer.store_helper_structure_vector(color_attachment_formats_vk,
+                                                  rendering_create_info_struct_id,
+                                                  offsetof(VkPipelineRenderingCreateInfoKHR, pColorAttachmentFormats) );
+        }
+    }
+    else
+    {
+        anvil_assert(renderpass_ptr != nullptr);
+    }
+
+    return chainer.create_chain(in_arena_ptr);
 }
 
 /* Please see header for specification */
-Anvil::StructChainUniquePtr<VkPipelineColorBlendStateCreateInfo> Anvil::GraphicsPipelineManager::bake_pipeline_color_blend_state_create_info(const Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr,
-                                                                                                                                             const Anvil::RenderPass*                 in_current_renderpass_ptr,
-                                                                                                                                             const Anvil::SubPassID&                  in_subpass_id) const
+const VkPipelineColorBlendStateCreateInfo* Anvil::GraphicsPipelineManager::bake_pipeline_color_blend_state_create_info(Anvil::CommandArena*                     in_arena_ptr,
+                                                                                                                      const Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr,
+                                                                                                                      const Anvil::RenderPass*                 in_current_renderpass_ptr,
+                                                                                                                      const Anvil::SubPassID&                  in_subpass_id) const
 {
-    Anvil::StructChainUniquePtr<VkPipelineColorBlendStateCreateInfo> result_chain_ptr;
-    uint32_t                                                         subpass_n_color_attachments = 0;
+    VkPipelineColorBlendStateCreateInfo* result_ptr                  = nullptr;
+    uint32_t                             subpass_n_color_attachments = 0;
 
-    in_current_renderpass_ptr->get_render_pass_create_info()->get_subpass_n_attachments(in_subpass_id,
-                                                                                        Anvil::AttachmentType::COLOR,
-                                                                                       &subpass_n_color_attachments);
+    if (in_current_renderpass_ptr != nullptr)
+    {
+        in_current_renderpass_ptr->get_render_pass_create_info()->get_subpass_n_attachments(in_subpass_id,
+                                                                                            Anvil::AttachmentType::COLOR,
+                                                                                           &subpass_n_color_attachments);
+    }
+    else
+    {
+        /* Dynamic rendering pipelines: color attachments are indexed by location */
+        in_gfx_pipeline_create_info_ptr->get_rendering_properties(nullptr, /* out_opt_view_mask_ptr                    */
+                                                                 &subpass_n_color_attachments,
+                                                                  nullptr, /* out_opt_color_attachment_formats_ptr_ptr */
+                                                                  nullptr, /* out_opt_depth_attachment_format_ptr      */
+                                                                  nullptr);/* out_opt_stencil_attachment_format_ptr    */
+    }
 
     if (!in_gfx_pipeline_create_info_ptr->is_rasterizer_discard_enabled()     &&
          subpass_n_color_attachments                                       > 0)
     {
-        const float*                                              blend_constant_ptr                      = nullptr;
-        Anvil::StructChainer<VkPipelineColorBlendStateCreateInfo> color_blend_state_create_info_chainer;
-        Anvil::StructID                                           color_blend_state_create_info_struct_id;
-        Anvil::LogicOp                                            logic_op                                = Anvil::LogicOp::UNKNOWN;
-        bool                                                      logic_op_enabled                        = false;
-        uint32_t                                                  max_location_index                      = UINT32_MAX;
+        const float*                         blend_constant_ptr                = nullptr;
+        VkPipelineColorBlendAttachmentState* color_blend_attachment_states_ptr = nullptr;
+        Anvil::LogicOp                       logic_op                          = Anvil::LogicOp::UNKNOWN;
+        bool                                 logic_op_enabled                  = false;
+        uint32_t                             max_location_index                = UINT32_MAX;
 
-        max_location_index = in_current_renderpass_ptr->get_render_pass_create_info()->get_max_color_location_used_by_subpass(in_subpass_id);
+        max_location_index = (in_current_renderpass_ptr != nullptr) ? in_current_renderpass_ptr->get_render_pass_create_info()->get_max_color_location_used_by_subpass(in_subpass_id)
+                                                                    : subpass_n_color_attachments - 1;
 
         in_gfx_pipeline_create_info_ptr->get_blending_properties(&blend_constant_ptr,
                                                                  nullptr); /* out_opt_n_blend_attachments_ptr */
@@ -546,34 +689,18 @@ Anvil::StructChainUniquePtr<VkPipelineColorBlendStateCreateInfo> Anvil::Graphics
         in_gfx_pipeline_create_info_ptr->get_logic_op_state(&logic_op_enabled,
                                                             &logic_op);
 
-        {
-            VkPipelineColorBlendStateCreateInfo color_blend_state_create_info;
-
-            color_blend_state_create_info.attachmentCount = max_location_index + 1;
-            color_blend_state_create_info.flags           = 0;
-            color_blend_state_create_info.logicOp         = static_cast<VkLogicOp>(logic_op);
-            color_blend_state_create_info.logicOpEnable   = (logic_op_enabled) ? VK_TRUE : VK_FALSE;
-            color_blend_state_create_info.pAttachments    = nullptr; /* will be patched by the chainer */
-            color_blend_state_create_info.pNext           = nullptr;
-            color_blend_state_create_info.sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-
-            memcpy(color_blend_state_create_info.blendConstants,
-                   blend_constant_ptr,
-                   sizeof(color_blend_state_create_info.blendConstants) );
-
-            color_blend_state_create_info_struct_id = color_blend_state_create_info_chainer.append_struct(color_blend_state_create_info);
-        }
-
-        anvil_assert(subpass_n_color_attachments <= in_current_renderpass_ptr->get_render_pass_create_info()->get_n_attachments() );
+        anvil_assert(in_current_renderpass_ptr   == nullptr                                                                     ||
+                     subpass_n_color_attachments <= in_current_renderpass_ptr->get_render_pass_create_info()->get_n_attachments() );
 
         {
-            std::vector<VkPipelineColorBlendAttachmentState> color_blend_attachment_state_vec(max_location_index + 1);
+            color_blend_attachment_states_ptr = static_cast<VkPipelineColorBlendAttachmentState*>(in_arena_ptr->allocate(sizeof(VkPipelineColorBlendAttachmentState) * (max_location_index + 1),
+                                                                                                                         alignof(VkPipelineColorBlendAttachmentState) ));
 
             for (uint32_t n_subpass_color_attachment = 0;
                           n_subpass_color_attachment <= max_location_index;
                         ++n_subpass_color_attachment)
             {
-                VkPipelineColorBlendAttachmentState* blend_state_ptr                    = &color_blend_attachment_state_vec.at(n_subpass_color_attachment);
+                VkPipelineColorBlendAttachmentState* blend_state_ptr                    = color_blend_attachment_states_ptr + n_subpass_color_attachment;
                 Anvil::ImageLayout                   dummy                              = Anvil::ImageLayout::UNKNOWN;
                 bool                                 is_blending_enabled_for_attachment = false;
                 Anvil::RenderPassAttachmentID        rp_attachment_id                   = UINT32_MAX;
@@ -586,11 +713,17 @@ Anvil::StructChainUniquePtr<VkPipelineColorBlendStateCreateInfo> Anvil::Graphics
                 Anvil::BlendFactor         src_alpha_blend_factor = Anvil::BlendFactor::UNKNOWN;
                 Anvil::BlendFactor         src_color_blend_factor = Anvil::BlendFactor::UNKNOWN;
 
-                if (!in_current_renderpass_ptr->get_render_pass_create_info()->get_subpass_attachment_properties(in_subpass_id,
-                                                                                                                 Anvil::AttachmentType::COLOR,
-                                                                                                                 n_subpass_color_attachment,
-                                                                                                                &rp_attachment_id,
-                                                                                                                &dummy) || /* out_layout_ptr */
+                if (in_current_renderpass_ptr == nullptr)
+                {
+                    rp_attachment_id = n_subpass_color_attachment;
+                }
+
+                if ((in_current_renderpass_ptr != nullptr                                                                                             &&
+                     !in_current_renderpass_ptr->get_render_pass_create_info()->get_subpass_attachment_properties(in_subpass_id,
+                                                                                                                  Anvil::AttachmentType::COLOR,
+                                                                                                                  n_subpass_color_attachment,
+                                                                                                                 &rp_attachment_id,
+                                                                                                                 &dummy) ) || /* out_layout_ptr */
                     !in_gfx_pipeline_create_info_ptr->get_color_blend_attachment_properties                      (rp_attachment_id,
                                                                                                                 &is_blending_enabled_for_attachment,
                                                                                                                 &color_blend_op,
@@ -626,31 +759,40 @@ Anvil::StructChainUniquePtr<VkPipelineColorBlendStateCreateInfo> Anvil::Graphics
                     blend_state_ptr->srcColorBlendFactor = static_cast<VkBlendFactor>(src_color_blend_factor);
                 }
             }
-
-            color_blend_state_create_info_chainer.store_helper_structure_vector(color_blend_attachment_state_vec,
-                                                                                color_blend_state_create_info_struct_id,
-                                                                                offsetof(VkPipelineColorBlendStateCreateInfo, pAttachments) );
         }
 
-        result_chain_ptr = color_blend_state_create_info_chainer.create_chain();
+        result_ptr = in_arena_ptr->create<VkPipelineColorBlendStateCreateInfo>();
+
+        result_ptr->attachmentCount = max_location_index + 1;
+        result_ptr->flags           = 0;
+        result_ptr->logicOp         = static_cast<VkLogicOp>(logic_op);
+        result_ptr->logicOpEnable   = (logic_op_enabled) ? VK_TRUE : VK_FALSE;
+        result_ptr->pAttachments    = color_blend_attachment_states_ptr;
+        result_ptr->pNext           = nullptr;
+        result_ptr->sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+
+        memcpy(result_ptr->blendConstants,
+               blend_constant_ptr,
+               sizeof(result_ptr->blendConstants) );
     }
 
-    return result_chain_ptr;
+    return result_ptr;
 }
 
 /* Please see header for specification */
-Anvil::StructChainUniquePtr<VkPipelineDepthStencilStateCreateInfo> Anvil::GraphicsPipelineManager::bake_pipeline_depth_stencil_state_create_info(const Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr,
-                                                                                                                                                 const Anvil::RenderPass*                 in_current_renderpass_ptr) const
+const VkPipelineDepthStencilStateCreateInfo* Anvil::GraphicsPipelineManager::bake_pipeline_depth_stencil_state_create_info(Anvil::CommandArena*                     in_arena_ptr,
+                                                                                                                          const Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr,
+                                                                                                                          const Anvil::RenderPass*                 in_current_renderpass_ptr) const
 {
-    VkPipelineDepthStencilStateCreateInfo                              depth_stencil_state_create_info;
-    auto                                                               depth_test_compare_op            = Anvil::CompareOp::UNKNOWN;
-    bool                                                               is_depth_bounds_test_enabled     = false;
-    bool                                                               is_depth_test_enabled            = false;
-    bool                                                               is_stencil_test_enabled          = false;
-    float                                                              max_depth_bounds                 = std::numeric_limits<float>::max();
-    float                                                              min_depth_bounds                 = std::numeric_limits<float>::max();
-    uint32_t                                                           n_depth_stencil_attachments      = 0;
-    Anvil::StructChainUniquePtr<VkPipelineDepthStencilStateCreateInfo> result_ptr;
+    VkPipelineDepthStencilStateCreateInfo  depth_stencil_state_create_info;
+    auto                                   depth_test_compare_op            = Anvil::CompareOp::UNKNOWN;
+    bool                                   is_depth_bounds_test_enabled     = false;
+    bool                                   is_depth_test_enabled            = false;
+    bool                                   is_stencil_test_enabled          = false;
+    float                                  max_depth_bounds                 = std::numeric_limits<float>::max();
+    float                                  min_depth_bounds                 = std::numeric_limits<float>::max();
+    uint32_t                               n_depth_stencil_attachments      = 0;
+    VkPipelineDepthStencilStateCreateInfo* result_ptr                       = nullptr;
 
     in_gfx_pipeline_create_info_ptr->get_depth_bounds_state(&is_depth_bounds_test_enabled,
                                                             &min_depth_bounds,
@@ -695,14 +837,29 @@ Anvil::StructChainUniquePtr<VkPipelineDepthStencilStateCreateInfo> Anvil::Graphi
         depth_stencil_state_create_info.front.passOp      = static_cast<VkStencilOp>(front_pass_op);
     }
 
-    in_current_renderpass_ptr->get_render_pass_create_info()->get_subpass_n_attachments(in_gfx_pipeline_create_info_ptr->get_subpass_id(),
-                                                                                        Anvil::AttachmentType::DEPTH_STENCIL,
-                                                                                       &n_depth_stencil_attachments);
+    if (in_current_renderpass_ptr != nullptr)
+    {
+        in_current_renderpass_ptr->get_render_pass_create_info()->get_subpass_n_attachments(in_gfx_pipeline_create_info_ptr->get_subpass_id(),
+                                                                                            Anvil::AttachmentType::DEPTH_STENCIL,
+                                                                                           &n_depth_stencil_attachments);
+    }
+    else
+    {
+        Anvil::Format depth_attachment_format   = Anvil::Format::UNKNOWN;
+        Anvil::Format stencil_attachment_format = Anvil::Format::UNKNOWN;
+
+        in_gfx_pipeline_create_info_ptr->get_rendering_properties(nullptr, /* out_opt_view_mask_ptr                    */
+                                                                  nullptr, /* out_opt_n_color_attachment_formats_ptr   */
+                                                                  nullptr, /* out_opt_color_attachment_formats_ptr_ptr */
+                                                                 &depth_attachment_format,
+                                                                 &stencil_attachment_format);
+
+        n_depth_stencil_attachments = (depth_attachment_format   != Anvil::Format::UNKNOWN ||
+                                       stencil_attachment_format != Anvil::Format::UNKNOWN) ? 1 : 0;
+    }
 
     if (n_depth_stencil_attachments)
     {
-        Anvil::StructChainer<VkPipelineDepthStencilStateCreateInfo> depth_stencil_state_create_info_chainer;
-
         depth_stencil_state_create_info.depthBoundsTestEnable = is_depth_bounds_test_enabled ? VK_TRUE : VK_FALSE;
         depth_stencil_state_create_info.depthCompareOp        = static_cast<VkCompareOp>(depth_test_compare_op);
         depth_stencil_state_create_info.depthTestEnable       = is_depth_test_enabled                                       ? VK_TRUE : VK_FALSE;
@@ -714,9 +871,7 @@ Anvil::StructChainUniquePtr<VkPipelineDepthStencilStateCreateInfo> Anvil::Graphi
         depth_stencil_state_create_info.stencilTestEnable     = is_stencil_test_enabled ? VK_TRUE : VK_FALSE;
         depth_stencil_state_create_info.sType                 = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
 
-        depth_stencil_state_create_info_chainer.append_struct(depth_stencil_state_create_info);
-
-        result_ptr = depth_stencil_state_create_info_chainer.create_chain();
+        result_ptr = in_arena_ptr->create<VkPipelineDepthStencilStateCreateInfo>(depth_stencil_state_create_info);
     }
     else
     {
@@ -731,58 +886,52 @@ Anvil::StructChainUniquePtr<VkPipelineDepthStencilStateCreateInfo> Anvil::Graphi
 }
 
 /* Please see header for specification */
-Anvil::StructChainUniquePtr<VkPipelineDynamicStateCreateInfo> Anvil::GraphicsPipelineManager::bake_pipeline_dynamic_state_create_info(const Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr) const
+const VkPipelineDynamicStateCreateInfo* Anvil::GraphicsPipelineManager::bake_pipeline_dynamic_state_create_info(Anvil::CommandArena*                     in_arena_ptr,
+                                                                                                                const Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr) const
 {
-    const Anvil::DynamicState*                                    enabled_dynamic_states_ptr = nullptr;
-    uint32_t                                                      n_enabled_dynamic_states   = 0;
-    Anvil::StructChainUniquePtr<VkPipelineDynamicStateCreateInfo> result_ptr;
+    const Anvil::DynamicState*        enabled_dynamic_states_ptr = nullptr;
+    uint32_t                          n_enabled_dynamic_states   = 0;
+    VkPipelineDynamicStateCreateInfo* result_ptr                 = nullptr;
 
     in_gfx_pipeline_create_info_ptr->get_enabled_dynamic_states(&enabled_dynamic_states_ptr,
                                                                 &n_enabled_dynamic_states);
 
     if (n_enabled_dynamic_states != 0)
     {
-        Anvil::StructChainer<VkPipelineDynamicStateCreateInfo> dynamic_state_create_info_chainer;
-        VkPipelineDynamicStateCreateInfo                       dynamic_state_create_info;
+        result_ptr = in_arena_ptr->create<VkPipelineDynamicStateCreateInfo>();
 
-        dynamic_state_create_info.dynamicStateCount = n_enabled_dynamic_states;
-        dynamic_state_create_info.flags             = 0;
-        dynamic_state_create_info.pDynamicStates    = (dynamic_state_create_info.dynamicStateCount > 0) ? reinterpret_cast<const VkDynamicState*>(enabled_dynamic_states_ptr)
-                                                                                                        : VK_NULL_HANDLE;
-        dynamic_state_create_info.pNext             = nullptr;
-        dynamic_state_create_info.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-
-        dynamic_state_create_info_chainer.append_struct(dynamic_state_create_info);
-
-        result_ptr = dynamic_state_create_info_chainer.create_chain();
+        result_ptr->dynamicStateCount = n_enabled_dynamic_states;
+        result_ptr->flags             = 0;
+        result_ptr->pDynamicStates    = reinterpret_cast<const VkDynamicState*>(enabled_dynamic_states_ptr);
+        result_ptr->pNext             = nullptr;
+        result_ptr->sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
     }
 
     return result_ptr;
 }
 
 /* Please see header for specification */
-Anvil::StructChainUniquePtr<VkPipelineInputAssemblyStateCreateInfo> Anvil::GraphicsPipelineManager::bake_pipeline_input_assembly_state_create_info(const Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr) const
+const VkPipelineInputAssemblyStateCreateInfo* Anvil::GraphicsPipelineManager::bake_pipeline_input_assembly_state_create_info(Anvil::CommandArena*                     in_arena_ptr,
+                                                                                                                            const Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr) const
 {
-    Anvil::StructChainer<VkPipelineInputAssemblyStateCreateInfo> input_assembly_state_create_info_chainer;
-    VkPipelineInputAssemblyStateCreateInfo                       input_assembly_state_create_info;
+    auto input_assembly_state_create_info_ptr = in_arena_ptr->create<VkPipelineInputAssemblyStateCreateInfo>();
 
-    input_assembly_state_create_info.flags                  = 0;
-    input_assembly_state_create_info.pNext                  = nullptr;
-    input_assembly_state_create_info.primitiveRestartEnable = in_gfx_pipeline_create_info_ptr->is_primitive_restart_enabled() ? VK_TRUE : VK_FALSE;
-    input_assembly_state_create_info.sType                  = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-    input_assembly_state_create_info.topology               = static_cast<VkPrimitiveTopology>(in_gfx_pipeline_create_info_ptr->get_primitive_topology() );
+    input_assembly_state_create_info_ptr->flags                  = 0;
+    input_assembly_state_create_info_ptr->pNext                  = nullptr;
+    input_assembly_state_create_info_ptr->primitiveRestartEnable = in_gfx_pipeline_create_info_ptr->is_primitive_restart_enabled() ? VK_TRUE : VK_FALSE;
+    input_assembly_state_create_info_ptr->sType                  = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    input_assembly_state_create_info_ptr->topology               = static_cast<VkPrimitiveTopology>(in_gfx_pipeline_create_info_ptr->get_primitive_topology() );
 
-    input_assembly_state_create_info_chainer.append_struct(input_assembly_state_create_info);
-
-    return input_assembly_state_create_info_chainer.create_chain();
+    return input_assembly_state_create_info_ptr;
 }
 
 /* Please see header for specification */
-Anvil::StructChainUniquePtr<VkPipelineMultisampleStateCreateInfo> Anvil::GraphicsPipelineManager::bake_pipeline_multisample_state_create_info(const Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr) const
+const VkPipelineMultisampleStateCreateInfo* Anvil::GraphicsPipelineManager::bake_pipeline_multisample_state_create_info(Anvil::CommandArena*                     in_arena_ptr,
+                                                                                                                        const Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr) const
 {
-    bool                                                              is_sample_shading_enabled = false;
-    float                                                             min_sample_shading        = std::numeric_limits<float>::max();
-    Anvil::StructChainUniquePtr<VkPipelineMultisampleStateCreateInfo> result_ptr;
+    bool                                  is_sample_shading_enabled = false;
+    float                                 min_sample_shading        = std::numeric_limits<float>::max();
+    VkPipelineMultisampleStateCreateInfo* result_ptr                = nullptr;
 
     in_gfx_pipeline_create_info_ptr->get_sample_shading_state(&is_sample_shading_enabled,
                                                               &min_sample_shading);
@@ -854,7 +1003,7 @@ Anvil::StructChainUniquePtr<VkPipelineMultisampleStateCreateInfo> Anvil::Graphic
             chainer.append_struct(psl_state_create_info);
         }
 
-        result_ptr = chainer.create_chain();
+        result_ptr = chainer.create_chain(in_arena_ptr);
     }
     else
     {
@@ -867,7 +1016,8 @@ Anvil::StructChainUniquePtr<VkPipelineMultisampleStateCreateInfo> Anvil::Graphic
     return result_ptr;
 }
 
-Anvil::StructChainUniquePtr<VkPipelineRasterizationStateCreateInfo> Anvil::GraphicsPipelineManager::bake_pipeline_rasterization_state_create_info(const Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr) const
+const VkPipelineRasterizationStateCreateInfo* Anvil::GraphicsPipelineManager::bake_pipeline_rasterization_state_create_info(Anvil::CommandArena*                     in_arena_ptr,
+                                                                                                                            const Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr) const
 {
     Anvil::CullModeFlags                                         cull_mode                  = Anvil::CullModeFlagBits::NONE;
     float                                                        depth_bias_clamp           = std::numeric_limits<float>::max();
@@ -1003,23 +1153,28 @@ Anvil::StructChainUniquePtr<VkPipelineRasterizationStateCreateInfo> Anvil::Graph
         anvil_assert(in_gfx_pipeline_create_info_ptr->get_rasterization_stream_index() == 0);
     }
 
-    return raster_state_create_info_chainer.create_chain();
+    return raster_state_create_info_chainer.create_chain(in_arena_ptr);
 }
 
 /* Please see header for specification */
-std::unique_ptr<Anvil::StructChainVector<VkPipelineShaderStageCreateInfo> > Anvil::GraphicsPipelineManager::bake_pipeline_shader_stage_create_info_chain_vector(const Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr) const
+const VkPipelineShaderStageCreateInfo* Anvil::GraphicsPipelineManager::bake_pipeline_shader_stage_create_info_items(Anvil::CommandArena*                     in_arena_ptr,
+                                                                                                                    const Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr,
+                                                                                                                    uint32_t*                                out_n_items_ptr) const
 {
     static const Anvil::ShaderStage graphics_shader_stages[] =
     {
         Anvil::ShaderStage::FRAGMENT,
         Anvil::ShaderStage::GEOMETRY,
+        Anvil::ShaderStage::MESH,
+        Anvil::ShaderStage::TASK,
         Anvil::ShaderStage::TESSELLATION_CONTROL,
         Anvil::ShaderStage::TESSELLATION_EVALUATION,
         Anvil::ShaderStage::VERTEX
     };
 
-    std::unique_ptr<Anvil::StructChainVector<VkPipelineShaderStageCreateInfo> > shader_stage_create_info_chainer_ptr(new Anvil::StructChainVector<VkPipelineShaderStageCreateInfo>() );
-
+    uint32_t                         n_shader_stage_create_info_items = 0;
+    VkPipelineShaderStageCreateInfo* shader_stage_create_info_items_ptr = static_cast<VkPipelineShaderStageCreateInfo*>(in_arena_ptr->allocate(sizeof(VkPipelineShaderStageCreateInfo) * sizeof(graphics_shader_stages) / sizeof(graphics_shader_stages[0]),
+                                                                                                                                                alignof(VkPipelineShaderStageCreateInfo) ));
 
     for (const auto& current_graphics_shader_stage : graphics_shader_stages)
     {
@@ -1039,66 +1194,40 @@ std::unique_ptr<Anvil::StructChainVector<VkPipelineShaderStageCreateInfo> > Anvi
                                                                          &current_shader_stage_specialization_constants_data_buffer_ptr);
 
             {
-                Anvil::StructID                                       root_struct_id;
-                Anvil::StructChainer<VkPipelineShaderStageCreateInfo> shader_stage_create_info_chainer;
-
-                {
-                    VkPipelineShaderStageCreateInfo shader_stage_create_info;
-
-                    shader_stage_create_info.module = shader_module_ptr->get_module();
-                    shader_stage_create_info.pName  = (shader_stage_entry_point_ptr->stage == Anvil::ShaderStage::FRAGMENT)                ? shader_module_ptr->get_fs_entrypoint_name().c_str()
-                                                    : (shader_stage_entry_point_ptr->stage == Anvil::ShaderStage::GEOMETRY)                ? shader_module_ptr->get_gs_entrypoint_name().c_str()
-                                                    : (shader_stage_entry_point_ptr->stage == Anvil::ShaderStage::TESSELLATION_CONTROL)    ? shader_module_ptr->get_tc_entrypoint_name().c_str()
-                                                    : (shader_stage_entry_point_ptr->stage == Anvil::ShaderStage::TESSELLATION_EVALUATION) ? shader_module_ptr->get_te_entrypoint_name().c_str()
-                                                    : (shader_stage_entry_point_ptr->stage == Anvil::ShaderStage::VERTEX)                  ? shader_module_ptr->get_vs_entrypoint_name().c_str()
-                                                    : nullptr;
-
-                    shader_stage_create_info.flags               = 0;
-                    shader_stage_create_info.pNext               = nullptr;
-                    shader_stage_create_info.pSpecializationInfo = nullptr; /* patched by the chainer below */
-                    shader_stage_create_info.stage               = static_cast<VkShaderStageFlagBits>(Anvil::Utils::get_shader_stage_flag_bits_from_shader_stage(shader_stage_entry_point_ptr->stage) );
-                    shader_stage_create_info.sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-
-                    root_struct_id = shader_stage_create_info_chainer.append_struct(shader_stage_create_info);
-                }
-
-                if (current_shader_stage_specialization_constants_ptr->size() > 0)
-                {
-                    Anvil::StructID                       helper_struct_id;
-                    VkSpecializationInfo                  specialization_info;
-                    std::vector<VkSpecializationMapEntry> specialization_map_entries;
-
-                    if (current_shader_stage_specialization_constants_ptr->size() > 0)
-                    {
-                        bake_specialization_info_vk(*current_shader_stage_specialization_constants_ptr,
-                                                     current_shader_stage_specialization_constants_data_buffer_ptr,
-                                                    &specialization_map_entries,
-                                                    &specialization_info);
-                    }
-
-                    helper_struct_id = shader_stage_create_info_chainer.store_helper_structure(specialization_info,
-                                                                                               root_struct_id,
-                                                                                               offsetof(VkPipelineShaderStageCreateInfo, pSpecializationInfo) );
-
-                    shader_stage_create_info_chainer.store_helper_structure_vector(specialization_map_entries,
-                                                                                   helper_struct_id,
-                                                                                   offsetof(VkSpecializationInfo, pMapEntries) );
-                }
-
-                shader_stage_create_info_chainer_ptr->append_struct_chain(shader_stage_create_info_chainer.create_chain() );
+                VkPipelineShaderStageCreateInfo* shader_stage_create_info_ptr = shader_stage_create_info_items_ptr + (n_shader_stage_create_info_items++);
+
+                shader_stage_create_info_ptr->module = shader_module_ptr->get_module();
+                shader_stage_create_info_ptr->pName  = (shader_stage_entry_point_ptr->stage == Anvil::ShaderStage::FRAGMENT)                ? shader_module_ptr->get_fs_entrypoint_name().c_str()
+                                                     : (shader_stage_entry_point_ptr->stage == Anvil::ShaderStage::GEOMETRY)                ? shader_module_ptr->get_gs_entrypoint_name().c_str()
+                                                     : (shader_stage_entry_point_ptr->stage == Anvil::ShaderStage::TESSELLATION_CONTROL)    ? shader_module_ptr->get_tc_entrypoint_name().c_str()
+                                                     : (shader_stage_entry_point_ptr->stage == Anvil::ShaderStage::TESSELLATION_EVALUATION) ? shader_module_ptr->get_te_entrypoint_name().c_str()
+                                                     : (shader_stage_entry_point_ptr->stage == Anvil::ShaderStage::VERTEX)                  ? shader_module_ptr->get_vs_entrypoint_name().c_str()
+                                                     : shader_stage_entry_point_ptr->name.c_str();
+
+                shader_stage_create_info_ptr->flags               = 0;
+                shader_stage_create_info_ptr->pNext               = nullptr;
+                shader_stage_create_info_ptr->pSpecializationInfo = (current_shader_stage_specialization_constants_ptr->size() > 0) ? bake_specialization_info_vk(*current_shader_stage_specialization_constants_ptr,
+                                                                                                                                                                   current_shader_stage_specialization_constants_data_buffer_ptr)
+                                                                                                                                      : nullptr;
+                shader_stage_create_info_ptr->stage               = static_cast<VkShaderStageFlagBits>(Anvil::Utils::get_shader_stage_flag_bits_from_shader_stage(shader_stage_entry_point_ptr->stage) );
+                shader_stage_create_info_ptr->sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
             }
         }
     }
 
-    return shader_stage_create_info_chainer_ptr;
+    *out_n_items_ptr = n_shader_stage_create_info_items;
+
+    return (n_shader_stage_create_info_items > 0) ? shader_stage_create_info_items_ptr
+                                                  : nullptr;
 }
 
 /* Please see header for specification */
-Anvil::StructChainUniquePtr<VkPipelineTessellationStateCreateInfo> Anvil::GraphicsPipelineManager::bake_pipeline_tessellation_state_create_info(const Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr) const
+const VkPipelineTessellationStateCreateInfo* Anvil::GraphicsPipelineManager::bake_pipeline_tessellation_state_create_info(Anvil::CommandArena*                     in_arena_ptr,
+                                                                                                                          const Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr) const
 {
-    Anvil::StructChainUniquePtr<VkPipelineTessellationStateCreateInfo> result_ptr;
-    const Anvil::ShaderModuleStageEntryPoint*                          tc_shader_stage_entry_point_ptr = nullptr;
-    const Anvil::ShaderModuleStageEntryPoint*                          te_shader_stage_entry_point_ptr = nullptr;
+    VkPipelineTessellationStateCreateInfo*    result_ptr                      = nullptr;
+    const Anvil::ShaderModuleStageEntryPoint* tc_shader_stage_entry_point_ptr = nullptr;
+    const Anvil::ShaderModuleStageEntryPoint* te_shader_stage_entry_point_ptr = nullptr;
 
     in_gfx_pipeline_create_info_ptr->get_shader_stage_properties(Anvil::ShaderStage::TESSELLATION_CONTROL,
                                                                  &tc_shader_stage_entry_point_ptr);
@@ -1137,14 +1266,15 @@ Anvil::StructChainUniquePtr<VkPipelineTessellationStateCreateInfo> Anvil::Graphi
             anvil_assert(in_gfx_pipeline_create_info_ptr->get_tessellation_domain_origin() == Anvil::TessellationDomainOrigin::UPPER_LEFT);
         }
 
-        result_ptr = tessellation_state_create_info_chainer.create_chain();
+        result_ptr = tessellation_state_create_info_chainer.create_chain(in_arena_ptr);
     }
 
     return result_ptr;
 }
 
 /* Please see header for specification */
-Anvil::StructChainUniquePtr<VkPipelineVertexInputStateCreateInfo> Anvil::GraphicsPipelineManager::bake_pipeline_vertex_input_state_create_info(const Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr) const
+const VkPipelineVertexInputStateCreateInfo* Anvil::GraphicsPipelineManager::bake_pipeline_vertex_input_state_create_info(Anvil::CommandArena*                     in_arena_ptr,
+                                                                                                                        const Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr) const
 {
     GraphicsPipelineData                                       current_pipeline_gfx_data             (in_gfx_pipeline_create_info_ptr);
     Anvil::StructChainer<VkPipelineVertexInputStateCreateInfo> vertex_input_state_create_info_chainer;
@@ -1217,35 +1347,38 @@ Anvil::StructChainUniquePtr<VkPipelineVertexInputStateCreateInfo> Anvil::Graphic
         }
     }
 
-    return vertex_input_state_create_info_chainer.create_chain();
+    return vertex_input_state_create_info_chainer.create_chain(in_arena_ptr);
 }
 
 /* Please see header for specification */
-Anvil::StructChainUniquePtr<VkPipelineViewportStateCreateInfo> Anvil::GraphicsPipelineManager::bake_pipeline_viewport_state_create_info(Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr,
-                                                                                                                                        const bool&                        in_is_dynamic_scissor_state_enabled,
-                                                                                                                                        const bool&                        in_is_dynamic_viewport_state_enabled) const
+const VkPipelineViewportStateCreateInfo* Anvil::GraphicsPipelineManager::bake_pipeline_viewport_state_create_info(Anvil::CommandArena*               in_arena_ptr,
+                                                                                                                  Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr,
+                                                                                                                  const bool&                        in_is_dynamic_scissor_state_enabled,
+                                                                                                                  const bool&                        in_is_dynamic_viewport_state_enabled) const
 {
-    Anvil::StructChainUniquePtr<VkPipelineViewportStateCreateInfo> result_ptr;
+    VkPipelineViewportStateCreateInfo* result_ptr = nullptr;
 
     if (!in_gfx_pipeline_create_info_ptr->is_rasterizer_discard_enabled() )
     {
-        uint32_t                n_scissor_boxes = (in_is_dynamic_scissor_state_enabled)  ? in_gfx_pipeline_create_info_ptr->get_n_dynamic_scissor_boxes()
-                                                                                         : in_gfx_pipeline_create_info_ptr->get_n_scissor_boxes        ();
-        uint32_t                n_viewports     = (in_is_dynamic_viewport_state_enabled) ? in_gfx_pipeline_create_info_ptr->get_n_dynamic_viewports    ()
-                                                                                         : in_gfx_pipeline_create_info_ptr->get_n_viewports            ();
-        std::vector<VkRect2D>   scissor_boxes;
-        std::vector<VkViewport> viewports;
+        uint32_t    n_scissor_boxes   = (in_is_dynamic_scissor_state_enabled)  ? in_gfx_pipeline_create_info_ptr->get_n_dynamic_scissor_boxes()
+                                                                               : in_gfx_pipeline_create_info_ptr->get_n_scissor_boxes        ();
+        uint32_t    n_viewports       = (in_is_dynamic_viewport_state_enabled) ? in_gfx_pipeline_create_info_ptr->get_n_dynamic_viewports    ()
+                                                                               : in_gfx_pipeline_create_info_ptr->get_n_viewports            ();
+        VkRect2D*   scissor_boxes_ptr = nullptr;
+        VkViewport* viewports_ptr     = nullptr;
 
         anvil_assert(n_scissor_boxes == n_viewports);
 
         if (n_scissor_boxes == 0)
         {
             /* No scissor boxes / viewport defined. Use default settings.. */
-            auto     swapchain_ptr  = in_gfx_pipeline_create_info_ptr->get_renderpass()->get_swapchain();
+            auto     renderpass_ptr = in_gfx_pipeline_create_info_ptr->get_renderpass();
+            auto     swapchain_ptr  = (renderpass_ptr != nullptr) ? renderpass_ptr->get_swapchain() : nullptr;
             uint32_t window_size[2] = {0};
 
             /* NOTE: If you hit this assertion, you either need to pass a Swapchain instance when this renderpass is being created,
-             *       *or* specify scissor & viewport information for the GFX pipeline.
+             *       *or* specify scissor & viewport information for the GFX pipeline. The latter is always required for pipelines
+             *       used with dynamic rendering.
              */
             anvil_assert(swapchain_ptr != nullptr);
             anvil_assert(n_viewports   == 0);
@@ -1278,15 +1411,18 @@ Anvil::StructChainUniquePtr<VkPipelineViewportStateCreateInfo> Anvil::GraphicsPi
         /* Convert internal scissor box & viewport representations to Vulkan descriptors */
         if (!in_is_dynamic_scissor_state_enabled)
         {
+            scissor_boxes_ptr = static_cast<VkRect2D*>(in_arena_ptr->allocate(sizeof(VkRect2D) * n_scissor_boxes,
+                                                                              alignof(VkRect2D) ));
+
             for (uint32_t n_scissor_box = 0;
                           n_scissor_box < n_scissor_boxes;
                         ++n_scissor_box)
             {
-                uint32_t current_scissor_box_height = UINT32_MAX;
-                uint32_t current_scissor_box_width  = UINT32_MAX;
-                int32_t  current_scissor_box_x      = INT32_MAX;
-                int32_t  current_scissor_box_y      = INT32_MAX;
-                VkRect2D current_scissor_box_vk;
+                uint32_t  current_scissor_box_height = UINT32_MAX;
+                uint32_t  current_scissor_box_width  = UINT32_MAX;
+                int32_t   current_scissor_box_x      = INT32_MAX;
+                int32_t   current_scissor_box_y      = INT32_MAX;
+                VkRect2D& current_scissor_box_vk     = scissor_boxes_ptr[n_scissor_box];
 
                 in_gfx_pipeline_create_info_ptr->get_scissor_box_properties(n_scissor_box,
                                                                             &current_scissor_box_x,
@@ -1297,24 +1433,25 @@ Anvil::StructChainUniquePtr<VkPipelineViewportStateCreateInfo> Anvil::GraphicsPi
                 current_scissor_box_vk.extent.width  = current_scissor_box_width;
                 current_scissor_box_vk.offset.x      = current_scissor_box_x;
                 current_scissor_box_vk.offset.y      = current_scissor_box_y;
-
-                scissor_boxes.push_back(current_scissor_box_vk);
             }
         }
 
         if (!in_is_dynamic_viewport_state_enabled)
         {
+            viewports_ptr = static_cast<VkViewport*>(in_arena_ptr->allocate(sizeof(VkViewport) * n_viewports,
+                                                                            alignof(VkViewport) ));
+
             for (uint32_t n_viewport = 0;
                           n_viewport < n_viewports;
                         ++n_viewport)
             {
-                float      current_viewport_height    = std::numeric_limits<float>::max();
-                float      current_viewport_max_depth = std::numeric_limits<float>::max();
-                float      current_viewport_min_depth = std::numeric_limits<float>::max();
-                float      current_viewport_origin_x  = std::numeric_limits<float>::max();
-                float      current_viewport_origin_y  = std::numeric_limits<float>::max();
-                float      current_viewport_width     = std::numeric_limits<float>::max();
-                VkViewport current_viewport_vk;
+                float       current_viewport_height    = std::numeric_limits<float>::max();
+                float       current_viewport_max_depth = std::numeric_limits<float>::max();
+                float       current_viewport_min_depth = std::numeric_limits<float>::max();
+                float       current_viewport_origin_x  = std::numeric_limits<float>::max();
+                float       current_viewport_origin_y  = std::numeric_limits<float>::max();
+                float       current_viewport_width     = std::numeric_limits<float>::max();
+                VkViewport& current_viewport_vk        = viewports_ptr[n_viewport];
 
                 in_gfx_pipeline_create_info_ptr->get_viewport_properties(n_viewport,
                                                                         &current_viewport_origin_x,
@@ -1330,49 +1467,74 @@ Anvil::StructChainUniquePtr<VkPipelineViewportStateCreateInfo> Anvil::GraphicsPi
                 current_viewport_vk.x        = current_viewport_origin_x;
                 current_viewport_vk.y        = current_viewport_origin_y;
                 current_viewport_vk.width    = current_viewport_width;
-
-                viewports.push_back(current_viewport_vk);
             }
         }
 
         /* Bake the descriptor */
+        anvil_assert(n_scissor_boxes == n_viewports);
+        anvil_assert(n_scissor_boxes != 0);
+
+        result_ptr = in_arena_ptr->create<VkPipelineViewportStateCreateInfo>();
+
+        result_ptr->flags         = 0;
+        result_ptr->pNext         = nullptr;
+        result_ptr->pScissors     = scissor_boxes_ptr;
+        result_ptr->pViewports    = viewports_ptr;
+        result_ptr->scissorCount  = n_scissor_boxes;
+        result_ptr->sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+        result_ptr->viewportCount = n_viewports;
+
+        if (in_gfx_pipeline_create_info_ptr->is_shading_rate_image_enabled() )
         {
-            Anvil::StructID                                         root_struct_id;
-            Anvil::StructChainer<VkPipelineViewportStateCreateInfo> viewport_state_create_info_chainer;
+            const Anvil::DynamicState*                           enabled_dynamic_states_ptr         = nullptr;
+            bool                                                 is_dynamic_palette_state_enabled   = false;
+            uint32_t                                             n_enabled_dynamic_states           = 0;
+            VkShadingRatePaletteNV*                              palettes_ptr                       = nullptr;
+            VkPipelineViewportShadingRateImageStateCreateInfoNV* shading_rate_image_create_info_ptr = nullptr;
+
+            anvil_assert(m_device_ptr->get_extension_info()->nv_shading_rate_image() );
+
+            in_gfx_pipeline_create_info_ptr->get_enabled_dynamic_states(&enabled_dynamic_states_ptr,
+                                                                        &n_enabled_dynamic_states);
+
+            is_dynamic_palette_state_enabled = (std::find(enabled_dynamic_states_ptr,
+                                                          enabled_dynamic_states_ptr + n_enabled_dynamic_states,
+                                                          Anvil::DynamicState::VIEWPORT_SHADING_RATE_PALETTE_NV) != enabled_dynamic_states_ptr + n_enabled_dynamic_states);
 
+            if (!is_dynamic_palette_state_enabled)
             {
-                VkPipelineViewportStateCreateInfo viewport_state_create_info;
+                palettes_ptr = static_cast<VkShadingRatePaletteNV*>(in_arena_ptr->allocate(sizeof(VkShadingRatePaletteNV) * n_viewports,
+                                                                                           alignof(VkShadingRatePaletteNV) ));
 
-                viewport_state_create_info.flags         = 0;
-                viewport_state_create_info.pNext         = nullptr; /* will be patched by the chainer below */
-                viewport_state_create_info.pScissors     = nullptr; /* will be patched by the chainer below */
-                viewport_state_create_info.pViewports    = nullptr; /* will be patched by the chainer below */
-                viewport_state_create_info.scissorCount  = n_scissor_boxes;
-                viewport_state_create_info.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-                viewport_state_create_info.viewportCount = n_viewports;
+                for (uint32_t n_viewport = 0;
+                              n_viewport < n_viewports;
+                            ++n_viewport)
+                {
+                    const Anvil::ShadingRatePaletteEntryNV* entries_ptr = nullptr;
+                    uint32_t                                n_entries   = 0;
 
-                anvil_assert(viewport_state_create_info.scissorCount == viewport_state_create_info.viewportCount);
-                anvil_assert(viewport_state_create_info.scissorCount != 0);
+                    if (!in_gfx_pipeline_create_info_ptr->get_shading_rate_palette(n_viewport,
+                                                                                   &n_entries,
+                                                                                   &entries_ptr) )
+                    {
+                        /* No palette has been assigned to the viewport. */
+                        anvil_assert_fail();
+                    }
 
-                root_struct_id = viewport_state_create_info_chainer.append_struct(viewport_state_create_info);
+                    palettes_ptr[n_viewport].pShadingRatePaletteEntries   = reinterpret_cast<const VkShadingRatePaletteEntryNV*>(entries_ptr);
+                    palettes_ptr[n_viewport].shadingRatePaletteEntryCount = n_entries;
+                }
             }
 
-            if (!in_is_dynamic_scissor_state_enabled)
-            {
-                viewport_state_create_info_chainer.store_helper_structure_vector(scissor_boxes,
-                                                                                 root_struct_id,
-                                                                                 offsetof(VkPipelineViewportStateCreateInfo, pScissors) );
-            }
+            shading_rate_image_create_info_ptr = in_arena_ptr->create<VkPipelineViewportShadingRateImageStateCreateInfoNV>();
 
-            if (!in_is_dynamic_viewport_state_enabled)
-            {
-                viewport_state_create_info_chainer.store_helper_structure_vector(viewports,
-                                                                                 root_struct_id,
-                                                                                 offsetof(VkPipelineViewportStateCreateInfo, pViewports) );
-            }
+            shading_rate_image_create_info_ptr->pNext                  = nullptr;
+            shading_rate_image_create_info_ptr->pShadingRatePalettes   = palettes_ptr;
+            shading_rate_image_create_info_ptr->sType                  = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_SHADING_RATE_IMAGE_STATE_CREATE_INFO_NV;
+            shading_rate_image_create_info_ptr->shadingRateImageEnable = VK_TRUE;
+            shading_rate_image_create_info_ptr->viewportCount          = n_viewports;
 
-            result_ptr = viewport_state_create_info_chainer.create_chain();
-            anvil_assert(result_ptr != nullptr);
+            result_ptr->pNext = shading_rate_image_create_info_ptr;
         }
     }
 
@@ -1386,6 +1548,33 @@ bool Anvil::GraphicsPipelineManager::delete_pipeline(PipelineID in_pipeline_id)
 
     lock();
     {
+        auto deduplicated_pipeline_iterator = m_deduplicated_pipelines.find(in_pipeline_id);
+
+        if (deduplicated_pipeline_iterator != m_deduplicated_pipelines.end() )
+        {
+            if (deduplicated_pipeline_iterator->second.n_references > 1)
+            {
+                /* The pipeline is still referred to by other add_pipeline() callers */
+                deduplicated_pipeline_iterator->second.n_references--;
+
+                result = true;
+                goto end;
+            }
+
+            auto& bucket = m_deduplicated_pipeline_ids_by_hash.at(deduplicated_pipeline_iterator->second.hash);
+
+            bucket.erase(std::find(bucket.begin(),
+                                   bucket.end  (),
+                                   in_pipeline_id) );
+
+            if (bucket.size() == 0)
+            {
+                m_deduplicated_pipeline_ids_by_hash.erase(deduplicated_pipeline_iterator->second.hash);
+            }
+
+            m_deduplicated_pipelines.erase(deduplicated_pipeline_iterator);
+        }
+
         result = BasePipelineManager::delete_pipeline(in_pipeline_id);
 
         if (result)
@@ -1396,13 +1585,108 @@ bool Anvil::GraphicsPipelineManager::delete_pipeline(PipelineID in_pipeline_id)
             {
                 m_baked_pipelines.erase(baked_pipelines_iterator);
             }
+
+            /* If the pipeline was a base for automatically derived pipelines, the next permutation which is baked
+             * for the group is going to take over. */
+            for (auto group_iterator  = m_derivative_base_pipeline_ids.begin();
+                      group_iterator != m_derivative_base_pipeline_ids.end();
+                )
+            {
+                if (group_iterator->second == in_pipeline_id)
+                {
+                    group_iterator = m_derivative_base_pipeline_ids.erase(group_iterator);
+                }
+                else
+                {
+                    ++group_iterator;
+                }
+            }
         }
     }
+end:
     unlock();
 
     return result;
 }
 
+/** Forms a key which identifies the group of pipelines a pipeline can share a base pipeline with, when automatic
+ *  derivatives are enabled. Pipelines which use the same layout, subpass and shader stage entry-points, as well as
+ *  compatible renderpasses, are assigned the same key.
+ *
+ *  @param in_gfx_pipeline_create_info_ptr Create info of the pipeline. Must not be null.
+ *  @param in_pipeline_layout_ptr          Layout the pipeline is going to be baked with.
+ *  @param out_key_ptr                     Deref will be set to the key. Must not be null.
+ */
+void Anvil::GraphicsPipelineManager::get_derivative_key(const Anvil::GraphicsPipelineCreateInfo* in_gfx_pipeline_create_info_ptr,
+                                                        const Anvil::PipelineLayout*             in_pipeline_layout_ptr,
+                                                        std::vector<uint64_t>*                   out_key_ptr) const
+{
+    static const Anvil::ShaderStage shader_stages[] =
+    {
+        Anvil::ShaderStage::FRAGMENT,
+        Anvil::ShaderStage::GEOMETRY,
+        Anvil::ShaderStage::MESH,
+        Anvil::ShaderStage::TASK,
+        Anvil::ShaderStage::TESSELLATION_CONTROL,
+        Anvil::ShaderStage::TESSELLATION_EVALUATION,
+        Anvil::ShaderStage::VERTEX
+    };
+
+    out_key_ptr->clear();
+
+    out_key_ptr->push_back(reinterpret_cast<uintptr_t>(in_pipeline_layout_ptr) );
+    if (in_gfx_pipeline_create_info_ptr->uses_dynamic_rendering() )
+    {
+        const Anvil::Format* color_attachment_formats_ptr = nullptr;
+        Anvil::Format        depth_attachment_format      = Anvil::Format::UNKNOWN;
+        uint32_t             n_color_attachment_formats   = 0;
+        Anvil::Format        stencil_attachment_format    = Anvil::Format::UNKNOWN;
+        uint32_t             view_mask                    = 0;
+
+        in_gfx_pipeline_create_info_ptr->get_rendering_properties(&view_mask,
+                                                                  &n_color_attachment_formats,
+                                                                  &color_attachment_formats_ptr,
+                                                                  &depth_attachment_format,
+                                                                  &stencil_attachment_format);
+
+        out_key_ptr->push_back(view_mask);
+        out_key_ptr->push_back(static_cast<uint64_t>(depth_attachment_format) );
+        out_key_ptr->push_back(static_cast<uint64_t>(stencil_attachment_format) );
+        out_key_ptr->push_back(n_color_attachment_formats);
+
+        for (uint32_t n_color_attachment_format = 0;
+                      n_color_attachment_format < n_color_attachment_formats;
+                    ++n_color_attachment_format)
+        {
+            out_key_ptr->push_back(static_cast<uint64_t>(color_attachment_formats_ptr[n_color_attachment_format]) );
+        }
+    }
+    else
+    {
+        out_key_ptr->push_back(in_gfx_pipeline_create_info_ptr->get_renderpass()->get_render_pass_create_info()->get_compatibility_hash() );
+        out_key_ptr->push_back(in_gfx_pipeline_create_info_ptr->get_subpass_id() );
+    }
+
+    for (const auto& current_shader_stage : shader_stages)
+    {
+        const Anvil::ShaderModuleStageEntryPoint* shader_stage_entry_point_ptr = nullptr;
+
+        if (in_gfx_pipeline_create_info_ptr->get_shader_stage_properties(current_shader_stage,
+                                                                        &shader_stage_entry_point_ptr) &&
+            shader_stage_entry_point_ptr                    != nullptr                                 &&
+            shader_stage_entry_point_ptr->shader_module_ptr != nullptr)
+        {
+            out_key_ptr->push_back(reinterpret_cast<uintptr_t>(shader_stage_entry_point_ptr->shader_module_ptr) );
+            out_key_ptr->push_back(std::hash<std::string>()   (shader_stage_entry_point_ptr->name) );
+        }
+        else
+        {
+            out_key_ptr->push_back(0);
+            out_key_ptr->push_back(0);
+        }
+    }
+}
+
 /** Converts the internal vertex attribute descriptors to one or more VkVertexInputAttributeDescription & VkVertexInputBindingDescription
  *  structures.
  *
@@ -24,8 +24,11 @@
 #include "misc/debug.h"
 #include "misc/formats.h"
 #include "misc/image_create_info.h"
+#include "misc/image_view_create_info.h"
 #include "misc/memory_block_create_info.h"
 #include "misc/object_tracker.h"
+#include "misc/perf_counters.h"
+#include "misc/staging_ring.h"
 #include "misc/struct_chainer.h"
 #include "misc/swapchain_create_info.h"
 #include "wrappers/buffer.h"
@@ -33,6 +36,7 @@
 #include "wrappers/command_pool.h"
 #include "wrappers/device.h"
 #include "wrappers/image.h"
+#include "wrappers/image_view.h"
 #include "wrappers/memory_block.h"
 #include "wrappers/physical_device.h"
 #include "wrappers/queue.h"
@@ -71,14 +75,17 @@ Anvil::Image::Image(Anvil::ImageCreateInfoUniquePtr in_create_info_ptr)
 /** Releases the Vulkan image object, as well as the memory object associated with the Image instance. */
 Anvil::Image::~Image()
 {
+    /* Cached views must go away before the image they have been created for */
+    m_cached_views.clear();
+
     if (m_image                                != VK_NULL_HANDLE                              &&
         m_create_info_ptr->get_internal_type() != Anvil::ImageInternalType::SWAPCHAIN_WRAPPER)
     {
         lock();
         {
-            Anvil::Vulkan::vkDestroyImage(m_device_ptr->get_device_vk(),
-                                          m_image,
-                                          nullptr /* pAllocator */);
+            m_device_ptr->get_dispatch_table().vkDestroyImage(m_device_ptr->get_device_vk(),
+                                                              m_image,
+                                                              m_device_ptr->get_allocation_callbacks_vk() );
         }
         unlock();
 
@@ -90,6 +97,73 @@ Anvil::Image::~Image()
                                                    this);
 }
 
+/** Appends bind info chains (one per plane) needed to bind @param in_memory_block_ptr to the image
+ *  to @param inout_bind_info_chains_ptr.
+ */
+void Anvil::Image::append_memory_bind_infos(Anvil::MemoryBlock*                                 in_memory_block_ptr,
+                                            uint32_t                                            in_n_device_group_indices,
+                                            const uint32_t*                                     in_device_group_indices_ptr,
+                                            uint32_t                                            in_n_SFR_rects,
+                                            const VkRect2D*                                     in_SFRs_ptr,
+                                            Anvil::StructChainVector<VkBindImageMemoryInfoKHR>* inout_bind_info_chains_ptr) const
+{
+    const bool     is_disjoint_yuv_image((m_create_info_ptr->get_create_flags() & Anvil::ImageCreateFlagBits::CREATE_DISJOINT_BIT) != 0);
+    const uint32_t n_planes             (is_disjoint_yuv_image ? Anvil::Formats::get_format_n_planes(m_create_info_ptr->get_format() )
+                                                               : 1);
+
+    for (uint32_t n_current_plane = 0;
+                  n_current_plane < n_planes;
+                ++n_current_plane)
+    {
+        Anvil::StructChainer<VkBindImageMemoryInfoKHR> struct_chainer;
+
+        {
+            VkBindImageMemoryInfoKHR bind_info;
+
+            bind_info.image            = m_image;
+            bind_info.memory           = in_memory_block_ptr->get_memory      ();
+            bind_info.memoryOffset     = in_memory_block_ptr->get_start_offset();
+            bind_info.pNext            = nullptr;
+            bind_info.sType            = VK_STRUCTURE_TYPE_BIND_IMAGE_MEMORY_INFO_KHR;
+
+            struct_chainer.append_struct(bind_info);
+        }
+
+        if (in_n_device_group_indices > 0 ||
+            in_n_SFR_rects            > 0)
+        {
+            VkBindImageMemoryDeviceGroupInfoKHR bind_info_dg;
+
+            bind_info_dg.deviceIndexCount             = in_n_device_group_indices;
+            bind_info_dg.pDeviceIndices               = in_device_group_indices_ptr;
+            bind_info_dg.pSplitInstanceBindRegions    = in_SFRs_ptr;
+            bind_info_dg.splitInstanceBindRegionCount = in_n_SFR_rects;
+            bind_info_dg.pNext                        = nullptr;
+            bind_info_dg.sType                        = VK_STRUCTURE_TYPE_BIND_IMAGE_MEMORY_DEVICE_GROUP_INFO_KHR;
+
+            struct_chainer.append_struct(bind_info_dg);
+        }
+
+        if (is_disjoint_yuv_image)
+        {
+            VkBindImagePlaneMemoryInfoKHR plane_info;
+
+            plane_info.planeAspect = (n_current_plane == 0) ? VK_IMAGE_ASPECT_PLANE_0_BIT
+                                   : (n_current_plane == 1) ? VK_IMAGE_ASPECT_PLANE_1_BIT
+                                                            : VK_IMAGE_ASPECT_PLANE_2_BIT;
+            plane_info.pNext       = nullptr;
+            plane_info.sType       = VK_STRUCTURE_TYPE_BIND_IMAGE_PLANE_MEMORY_INFO_KHR;
+
+            struct_chainer.append_struct(plane_info);
+
+            anvil_assert(n_current_plane >= 0 &&
+                         n_current_plane <= 2);
+        }
+
+        inout_bind_info_chains_ptr->append_struct_chain(struct_chainer.create_chain() );
+    }
+}
+
 /** Please see header for specification */
 void Anvil::Image::change_image_layout(Anvil::Queue*                       in_queue_ptr,
                                        Anvil::AccessFlags                  in_src_access_mask,
@@ -113,7 +187,9 @@ void Anvil::Image::change_image_layout(Anvil::Queue*                       in_qu
      */
     ANVIL_REDUNDANT_VARIABLE(mem_block_ptr);
 
-    transition_command_buffer_ptr = m_device_ptr->get_command_pool_for_queue_family_index(in_queue_ptr->get_queue_family_index())->alloc_primary_level_command_buffer();
+    /* The command buffer is submitted in a blocking manner and released before the function leaves, so it can be
+     * allocated from the calling thread's pool. */
+    transition_command_buffer_ptr = m_device_ptr->get_thread_command_pool_for_queue_family_index(in_queue_ptr->get_queue_family_index())->alloc_primary_level_command_buffer();
 
     transition_command_buffer_ptr->start_recording(true,   /* one_time_submit          */
                                                    false); /* simultaneous_use_allowed */
@@ -252,6 +328,13 @@ Anvil::ImageUniquePtr Anvil::Image::create(Anvil::ImageCreateInfoUniquePtr in_cr
     return result_ptr;
 }
 
+/** Please see header for specification */
+void Anvil::Image::disable_state_tracking()
+{
+    m_tracked_states.clear        ();
+    m_tracked_states.shrink_to_fit();
+}
+
 /** TODO */
 bool Anvil::Image::do_sanity_checks_for_physical_device_binding(const Anvil::MemoryBlock* in_memory_block_ptr,
                                                                 uint32_t                  in_n_physical_devices) const
@@ -376,6 +459,250 @@ end:
     return result;
 }
 
+/** Please see header for specification */
+void Anvil::Image::enable_state_tracking(Anvil::ImageLayout        in_current_layout,
+                                         Anvil::PipelineStageFlags in_last_stage_mask,
+                                         Anvil::AccessFlags        in_last_access_mask)
+{
+    m_tracked_states.assign(m_create_info_ptr->get_n_layers() * m_n_mipmaps,
+                            Anvil::ResourceAccessState(in_current_layout,
+                                                       in_last_stage_mask,
+                                                       in_last_access_mask) );
+}
+
+/* Please see header for specification */
+bool Anvil::Image::generate_mipmaps(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                    Anvil::Filter             in_filter,
+                                    Anvil::AccessFlags        in_src_access_mask,
+                                    Anvil::ImageLayout        in_current_image_layout,
+                                    Anvil::AccessFlags        in_dst_access_mask,
+                                    Anvil::ImageLayout        in_new_image_layout)
+{
+    Anvil::ImageAspectFlags       aspects;
+    Anvil::Filter                 filter            = in_filter;
+    const Anvil::Format           format            = m_create_info_ptr->get_format();
+    const Anvil::FormatProperties format_props      = m_device_ptr->get_physical_device_format_properties(format);
+    const uint32_t                n_layers          = (m_create_info_ptr->get_type() == Anvil::ImageType::_3D) ? 1u
+                                                                                                                 : m_create_info_ptr->get_n_layers();
+    bool                          result            = false;
+    Anvil::ImageSubresourceRange  subresource_range;
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    if (m_create_info_ptr->get_tiling() != Anvil::ImageTiling::OPTIMAL ||
+        Anvil::Formats::is_format_multiplanar(format) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if ((m_create_info_ptr->get_usage_flags() & Anvil::ImageUsageFlagBits::TRANSFER_SRC_BIT) == 0 ||
+        (m_create_info_ptr->get_usage_flags() & Anvil::ImageUsageFlagBits::TRANSFER_DST_BIT) == 0)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if ((format_props.optimal_tiling_capabilities & Anvil::FormatFeatureFlagBits::BLIT_SRC_BIT) == 0 ||
+        (format_props.optimal_tiling_capabilities & Anvil::FormatFeatureFlagBits::BLIT_DST_BIT) == 0)
+    {
+        /* The format cannot be blitted from or to. */
+        goto end;
+    }
+
+    if (in_new_image_layout == Anvil::ImageLayout::UNDEFINED    ||
+        in_new_image_layout == Anvil::ImageLayout::PREINITIALIZED)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (Anvil::Formats::has_depth_aspect  (format) ||
+        Anvil::Formats::has_stencil_aspect(format) )
+    {
+        if (Anvil::Formats::has_depth_aspect(format) )
+        {
+            aspects |= Anvil::ImageAspectFlagBits::DEPTH_BIT;
+        }
+
+        if (Anvil::Formats::has_stencil_aspect(format) )
+        {
+            aspects |= Anvil::ImageAspectFlagBits::STENCIL_BIT;
+        }
+
+        /* Blits of depth/stencil images must use NEAREST filtering */
+        filter = Anvil::Filter::NEAREST;
+    }
+    else
+    {
+        aspects = Anvil::ImageAspectFlagBits::COLOR_BIT;
+
+        if ((format_props.optimal_tiling_capabilities & Anvil::FormatFeatureFlagBits::SAMPLED_IMAGE_FILTER_LINEAR_BIT) == 0)
+        {
+            filter = Anvil::Filter::NEAREST;
+        }
+    }
+
+    subresource_range.aspect_mask      = aspects;
+    subresource_range.base_array_layer = 0;
+    subresource_range.base_mip_level   = 0;
+    subresource_range.layer_count      = n_layers;
+    subresource_range.level_count      = 1;
+
+    /* Move the base mip to TRANSFER_SRC_OPTIMAL layout and all other mips to TRANSFER_DST_OPTIMAL layout */
+    {
+        std::vector<Anvil::ImageBarrier> barriers;
+
+        barriers.push_back(
+            Anvil::ImageBarrier(in_src_access_mask,
+                                Anvil::AccessFlagBits::TRANSFER_READ_BIT,
+                                in_current_image_layout,
+                                Anvil::ImageLayout::TRANSFER_SRC_OPTIMAL,
+                                VK_QUEUE_FAMILY_IGNORED,
+                                VK_QUEUE_FAMILY_IGNORED,
+                                this,
+                                subresource_range)
+        );
+
+        if (m_n_mipmaps > 1)
+        {
+            Anvil::ImageSubresourceRange dst_mips_subresource_range = subresource_range;
+
+            dst_mips_subresource_range.base_mip_level = 1;
+            dst_mips_subresource_range.level_count    = m_n_mipmaps - 1;
+
+            barriers.push_back(
+                Anvil::ImageBarrier(Anvil::AccessFlagBits::NONE,
+                                    Anvil::AccessFlagBits::TRANSFER_WRITE_BIT,
+                                    Anvil::ImageLayout::UNDEFINED,
+                                    Anvil::ImageLayout::TRANSFER_DST_OPTIMAL,
+                                    VK_QUEUE_FAMILY_IGNORED,
+                                    VK_QUEUE_FAMILY_IGNORED,
+                                    this,
+                                    dst_mips_subresource_range)
+            );
+        }
+
+        in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT,
+                                                   Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                   Anvil::DependencyFlagBits::NONE,
+                                                   0,       /* in_memory_barrier_count        */
+                                                   nullptr, /* in_memory_barrier_ptrs         */
+                                                   0,       /* in_buffer_memory_barrier_count */
+                                                   nullptr, /* in_buffer_memory_barrier_ptrs  */
+                                                   static_cast<uint32_t>(barriers.size() ),
+                                                  &barriers.at(0) );
+    }
+
+    /* Produce the mips, one at a time. Each mip becomes the source of the next blit. */
+    for (uint32_t n_mip = 1;
+                  n_mip < m_n_mipmaps;
+                ++n_mip)
+    {
+        uint32_t         dst_size[3];
+        Anvil::ImageBlit region;
+        uint32_t         src_size[3];
+
+        if (!get_image_mipmap_size(n_mip - 1,
+                                   src_size + 0,
+                                   src_size + 1,
+                                   src_size + 2) ||
+            !get_image_mipmap_size(n_mip,
+                                   dst_size + 0,
+                                   dst_size + 1,
+                                   dst_size + 2) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        region.dst_offsets[0].x                 = 0;
+        region.dst_offsets[0].y                 = 0;
+        region.dst_offsets[0].z                 = 0;
+        region.dst_offsets[1].x                 = static_cast<int32_t>(dst_size[0]);
+        region.dst_offsets[1].y                 = static_cast<int32_t>(dst_size[1]);
+        region.dst_offsets[1].z                 = static_cast<int32_t>(dst_size[2]);
+        region.dst_subresource.aspect_mask      = aspects;
+        region.dst_subresource.base_array_layer = 0;
+        region.dst_subresource.layer_count      = n_layers;
+        region.dst_subresource.mip_level        = n_mip;
+        region.src_offsets[0]                   = region.dst_offsets[0];
+        region.src_offsets[1].x                 = static_cast<int32_t>(src_size[0]);
+        region.src_offsets[1].y                 = static_cast<int32_t>(src_size[1]);
+        region.src_offsets[1].z                 = static_cast<int32_t>(src_size[2]);
+        region.src_subresource                  = region.dst_subresource;
+        region.src_subresource.mip_level        = n_mip - 1;
+
+        in_cmd_buffer_ptr->record_blit_image(this,
+                                             Anvil::ImageLayout::TRANSFER_SRC_OPTIMAL,
+                                             this,
+                                             Anvil::ImageLayout::TRANSFER_DST_OPTIMAL,
+                                             1, /* in_region_count */
+                                            &region,
+                                             filter);
+
+        /* The mip is the source of the next blit */
+        {
+            Anvil::ImageSubresourceRange mip_subresource_range = subresource_range;
+
+            mip_subresource_range.base_mip_level = n_mip;
+
+            Anvil::ImageBarrier barrier(Anvil::AccessFlagBits::TRANSFER_WRITE_BIT,
+                                        Anvil::AccessFlagBits::TRANSFER_READ_BIT,
+                                        Anvil::ImageLayout::TRANSFER_DST_OPTIMAL,
+                                        Anvil::ImageLayout::TRANSFER_SRC_OPTIMAL,
+                                        VK_QUEUE_FAMILY_IGNORED,
+                                        VK_QUEUE_FAMILY_IGNORED,
+                                        this,
+                                        mip_subresource_range);
+
+            in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                       Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                       Anvil::DependencyFlagBits::NONE,
+                                                       0,       /* in_memory_barrier_count        */
+                                                       nullptr, /* in_memory_barrier_ptrs         */
+                                                       0,       /* in_buffer_memory_barrier_count */
+                                                       nullptr, /* in_buffer_memory_barrier_ptrs  */
+                                                       1,       /* in_image_memory_barrier_count  */
+                                                      &barrier);
+        }
+    }
+
+    /* All mips are now in TRANSFER_SRC_OPTIMAL layout. Move them to the requested one. */
+    {
+        Anvil::ImageSubresourceRange all_mips_subresource_range = subresource_range;
+
+        all_mips_subresource_range.level_count = m_n_mipmaps;
+
+        Anvil::ImageBarrier barrier(Anvil::AccessFlagBits::TRANSFER_READ_BIT | Anvil::AccessFlagBits::TRANSFER_WRITE_BIT,
+                                    in_dst_access_mask,
+                                    Anvil::ImageLayout::TRANSFER_SRC_OPTIMAL,
+                                    in_new_image_layout,
+                                    VK_QUEUE_FAMILY_IGNORED,
+                                    VK_QUEUE_FAMILY_IGNORED,
+                                    this,
+                                    all_mips_subresource_range);
+
+        in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                   Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT,
+                                                   Anvil::DependencyFlagBits::NONE,
+                                                   0,       /* in_memory_barrier_count        */
+                                                   nullptr, /* in_memory_barrier_ptrs         */
+                                                   0,       /* in_buffer_memory_barrier_count */
+                                                   nullptr, /* in_buffer_memory_barrier_ptrs  */
+                                                   1,       /* in_image_memory_barrier_count  */
+                                                  &barrier);
+    }
+
+    result = true;
+end:
+    return result;
+}
+
 /** Please see header for specification */
 bool Anvil::Image::get_aspect_subresource_layout(Anvil::ImageAspectFlagBits in_aspect,
                                                  uint32_t                   in_n_layer,
@@ -401,6 +728,59 @@ bool Anvil::Image::get_aspect_subresource_layout(Anvil::ImageAspectFlagBits in_a
     return result;
 }
 
+/** Please see header for specification */
+Anvil::ImageView* Anvil::Image::get_cached_view(Anvil::ImageViewCreateInfoUniquePtr in_create_info_ptr)
+{
+    uint64_t          hash;
+    Anvil::ImageView* result_ptr = nullptr;
+
+    if (in_create_info_ptr == nullptr)
+    {
+        anvil_assert(in_create_info_ptr != nullptr);
+
+        goto end;
+    }
+
+    anvil_assert(in_create_info_ptr->get_parent_image() == this);
+
+    hash = in_create_info_ptr->get_hash();
+
+    lock();
+    {
+        auto& bucket = m_cached_views[hash];
+
+        for (const auto& current_view_ptr : bucket)
+        {
+            if (*current_view_ptr->get_create_info_ptr() == *in_create_info_ptr)
+            {
+                result_ptr = current_view_ptr.get();
+
+                break;
+            }
+        }
+
+        if (result_ptr == nullptr)
+        {
+            auto new_view_ptr = Anvil::ImageView::create(std::move(in_create_info_ptr) );
+
+            if (new_view_ptr != nullptr)
+            {
+                result_ptr = new_view_ptr.get();
+
+                bucket.push_back(std::move(new_view_ptr) );
+            }
+            else
+            {
+                anvil_assert(new_view_ptr != nullptr);
+            }
+        }
+    }
+    unlock();
+
+end:
+    return result_ptr;
+}
+
 /** Please see header for specification */
 Anvil::MemoryBlock* Anvil::Image::get_memory_block(const uint32_t& in_n_plane)
 {
@@ -457,6 +837,23 @@ Anvil::MemoryBlock* Anvil::Image::get_memory_block(const uint32_t& in_n_plane)
     }
 }
 
+/** Please see header for specification */
+uint32_t Anvil::Image::get_n_cached_views() const
+{
+    uint32_t result = 0;
+
+    lock();
+    {
+        for (const auto& current_bucket : m_cached_views)
+        {
+            result += static_cast<uint32_t>(current_bucket.second.size() );
+        }
+    }
+    unlock();
+
+    return result;
+}
+
 /** Private function which initializes the Image instance.
  *
  *  For argument discussion, please see documentation of the constructors.
@@ -513,6 +910,38 @@ bool Anvil::Image::init()
         m_create_info_ptr->set_usage_flags(m_create_info_ptr->get_usage_flags() | Anvil::ImageUsageFlagBits::TRANSFER_DST_BIT);
     }
 
+    /* If VK_EXT_host_image_copy is available, let transfer/sample-only optimal images be uploaded to from the host, without
+     * going through a staging buffer and a command buffer. Other usages are left alone, since host transfer usage may
+     * make the driver pick a less efficient internal layout for render targets and storage images. */
+    if ( m_device_ptr->get_extension_info()->ext_host_image_copy()                                                             &&
+         m_device_ptr->get_physical_device_features().ext_host_image_copy_features_ptr != nullptr                           &&
+         m_device_ptr->get_physical_device_features().ext_host_image_copy_features_ptr->host_image_copy                     &&
+        (m_create_info_ptr->get_internal_type()                                        == Anvil::ImageInternalType::ALLOC      ||
+         m_create_info_ptr->get_internal_type()                                        == Anvil::ImageInternalType::NO_ALLOC)  &&
+         m_create_info_ptr->get_tiling()                                               == Anvil::ImageTiling::OPTIMAL          &&
+        (m_create_info_ptr->get_create_flags() & Anvil::ImageCreateFlagBits::SPARSE_BINDING_BIT) == 0)
+    {
+        const auto host_compatible_usage = Anvil::ImageUsageFlagBits::SAMPLED_BIT      |
+                                           Anvil::ImageUsageFlagBits::TRANSFER_DST_BIT |
+                                           Anvil::ImageUsageFlagBits::TRANSFER_SRC_BIT;
+        const auto usage                 = m_create_info_ptr->get_usage_flags();
+
+        if ((usage & Anvil::ImageUsageFlagBits::TRANSFER_DST_BIT) != 0 &&
+            (usage & ~host_compatible_usage)                      == 0)
+        {
+            const Anvil::ImageFormatPropertiesQuery query(m_create_info_ptr->get_format      (),
+                                                          m_create_info_ptr->get_type        (),
+                                                          m_create_info_ptr->get_tiling      (),
+                                                          usage | Anvil::ImageUsageFlagBits::HOST_TRANSFER_BIT_EXT,
+                                                          m_create_info_ptr->get_create_flags() );
+
+            if (m_device_ptr->get_physical_device_image_format_properties(query) )
+            {
+                m_create_info_ptr->set_usage_flags(usage | Anvil::ImageUsageFlagBits::HOST_TRANSFER_BIT_EXT);
+            }
+        }
+    }
+
     /* Cache the number of mips we want the image to use. */
     {
         const auto max_dimension = std::max(std::max(m_create_info_ptr->get_base_mip_depth(),
@@ -614,10 +1043,10 @@ bool Anvil::Image::init()
         {
             auto struct_chain_ptr = struct_chainer.create_chain();
 
-            result = Anvil::Vulkan::vkCreateImage(m_device_ptr->get_device_vk      (),
-                                                  struct_chain_ptr->get_root_struct(),
-                                                  nullptr, /* pAllocator */
-                                                 &m_image);
+            result = m_device_ptr->get_dispatch_table().vkCreateImage(m_device_ptr->get_device_vk      (),
+                                                                      struct_chain_ptr->get_root_struct(),
+                                                                      m_device_ptr->get_allocation_callbacks_vk(),
+                                                                     &m_image);
         }
 
         if (!is_vk_call_successful(result) )
@@ -627,6 +1056,8 @@ bool Anvil::Image::init()
             result_bool = false;
             goto end;
         }
+
+        Anvil::PerfCounters::increment(Anvil::PerfCounters::Counter::IMAGES_CREATED);
     }
 
     /* Cache the handle .. */
@@ -752,9 +1183,9 @@ bool Anvil::Image::init()
 
                 anvil_assert(!is_yuv_format);
 
-                Anvil::Vulkan::vkGetImageMemoryRequirements(m_device_ptr->get_device_vk(),
-                                                            m_image,
-                                                           &memory_reqs);
+                m_device_ptr->get_dispatch_table().vkGetImageMemoryRequirements(m_device_ptr->get_device_vk(),
+                                                                                m_image,
+                                                                               &memory_reqs);
 
                 current_plane_properties.alignment    = memory_reqs.alignment;
                 current_plane_properties.memory_types = memory_reqs.memoryTypeBits;
@@ -790,10 +1221,10 @@ bool Anvil::Image::init()
 
                         subresource.mip_level = n_mip;
 
-                        Anvil::Vulkan::vkGetImageSubresourceLayout(m_device_ptr->get_device_vk(),
-                                                                   m_image,
-                                                                   reinterpret_cast<const VkImageSubresource*>(&subresource),
-                                                                   reinterpret_cast<VkSubresourceLayout*>     (&subresource_layout) );
+                        m_device_ptr->get_dispatch_table().vkGetImageSubresourceLayout(m_device_ptr->get_device_vk(),
+                                                                                       m_image,
+                                                                                       reinterpret_cast<const VkImageSubresource*>(&subresource),
+                                                                                       reinterpret_cast<VkSubresourceLayout*>     (&subresource_layout) );
 
                         m_linear_image_aspect_data[static_cast<Anvil::ImageAspectFlagBits>(current_aspect.get_vk() )][LayerMipKey(n_layer, n_mip)] = subresource_layout;
                     }
@@ -852,18 +1283,18 @@ bool Anvil::Image::init()
             }
             else
             {
-                Anvil::Vulkan::vkGetImageSparseMemoryRequirements(m_device_ptr->get_device_vk(),
-                                                                  m_image,
-                                                                 &n_reqs,
-                                                                  nullptr);
+                m_device_ptr->get_dispatch_table().vkGetImageSparseMemoryRequirements(m_device_ptr->get_device_vk(),
+                                                                                      m_image,
+                                                                                     &n_reqs,
+                                                                                      nullptr);
 
                 anvil_assert(n_reqs >= 1);
                 sparse_image_memory_reqs.resize(n_reqs);
 
-                Anvil::Vulkan::vkGetImageSparseMemoryRequirements(m_device_ptr->get_device_vk(),
-                                                                  m_image,
-                                                                 &n_reqs,
-                                                                  reinterpret_cast<VkSparseImageMemoryRequirements*>(&sparse_image_memory_reqs[0]) );
+                m_device_ptr->get_dispatch_table().vkGetImageSparseMemoryRequirements(m_device_ptr->get_device_vk(),
+                                                                                      m_image,
+                                                                                     &n_reqs,
+                                                                                      reinterpret_cast<VkSparseImageMemoryRequirements*>(&sparse_image_memory_reqs[0]) );
             }
 
             for (const auto& image_memory_req : sparse_image_memory_reqs)
@@ -1393,6 +1824,28 @@ Anvil::ImageSubresourceRange Anvil::Image::get_subresource_range() const
     return result;
 }
 
+/** Please see header for specification */
+bool Anvil::Image::get_tracked_state(uint32_t                    in_n_layer,
+                                     uint32_t                    in_n_mip,
+                                     Anvil::ResourceAccessState* out_state_ptr) const
+{
+    bool result = false;
+
+    anvil_assert(is_state_tracking_enabled() );
+
+    if (in_n_layer >= m_create_info_ptr->get_n_layers() ||
+        in_n_mip   >= m_n_mipmaps                       ||
+        m_tracked_states.empty() )
+    {
+        goto end;
+    }
+
+    *out_state_ptr = m_tracked_states.at(in_n_layer * m_n_mipmaps + in_n_mip);
+    result         = true;
+end:
+    return result;
+}
+
 /** Please see header for specification */
 bool Anvil::Image::has_aspects(const Anvil::ImageAspectFlags& in_aspects) const
 {
@@ -1639,7 +2092,7 @@ void Anvil::Image::on_memory_backing_opaque_update(uint32_t            in_n_plan
 
     if (in_memory_block_ptr != nullptr)
     {
-        anvil_assert(in_memory_block_ptr->get_create_info_ptr()->get_size() <= in_memory_block_start_offset + in_size);
+        anvil_assert(in_memory_block_start_offset + in_size <= in_memory_block_ptr->get_create_info_ptr()->get_size() );
     }
 
     if ((m_create_info_ptr->get_create_flags() & Anvil::ImageCreateFlagBits::SPARSE_RESIDENCY_BIT) == 0)
@@ -1871,6 +2324,59 @@ void Anvil::Image::on_memory_backing_update(const Anvil::ImageSubresource& in_su
     }
 }
 
+/** Takes ownership of @param in_memory_block_ptr if requested, uploads mipmap data specified at creation time
+ *  and transitions the image to the post-alloc layout. Called once non-sparse memory has been bound to the image.
+ */
+void Anvil::Image::on_nonsparse_memory_bound(Anvil::MemoryBlock* in_memory_block_ptr,
+                                             bool                in_owned_by_image)
+{
+    if (in_owned_by_image)
+    {
+        m_memory_blocks_owned.push_back(
+            MemoryBlockUniquePtr(in_memory_block_ptr,
+                                 std::default_delete<MemoryBlock>() )
+        );
+    }
+
+    {
+        const auto&        mips_to_upload   = m_create_info_ptr->get_mipmaps_to_upload();
+        const auto         tiling           = m_create_info_ptr->get_tiling           ();
+        Anvil::ImageLayout src_image_layout = (tiling == Anvil::ImageTiling::LINEAR && mips_to_upload.size() > 0) ? Anvil::ImageLayout::PREINITIALIZED
+                                                                                                                  : Anvil::ImageLayout::UNDEFINED;
+
+        /* Fill the storage with mipmap contents, if mipmap data was specified at input */
+        if (mips_to_upload.size() > 0)
+        {
+            upload_mipmaps(&mips_to_upload,
+                           src_image_layout,
+                          &src_image_layout);
+        }
+
+        if (m_create_info_ptr->get_post_alloc_image_layout() != m_create_info_ptr->get_post_create_image_layout() )
+        {
+            const uint32_t     n_mipmaps_to_upload = static_cast<uint32_t>(mips_to_upload.size());
+            Anvil::AccessFlags src_access_mask;
+
+            if (n_mipmaps_to_upload > 0)
+            {
+                if (tiling == Anvil::ImageTiling::LINEAR)
+                {
+                    src_access_mask = Anvil::AccessFlagBits::HOST_WRITE_BIT;
+                }
+                else
+                {
+                    src_access_mask = Anvil::AccessFlagBits::TRANSFER_WRITE_BIT;
+                }
+            }
+
+            transition_to_post_alloc_image_layout(src_access_mask,
+                                                  src_image_layout);
+        }
+
+        m_create_info_ptr->clear_mipmaps_to_upload();
+    }
+}
+
 /* Please see header for specification */
 bool Anvil::Image::set_memory(MemoryBlockUniquePtr in_memory_block_ptr)
 {
@@ -1949,12 +2455,8 @@ bool Anvil::Image::set_memory_internal(Anvil::MemoryBlock*  in_memory_block_ptr,
                                        uint32_t             in_n_SFR_rects,
                                        const VkRect2D*      in_SFRs_ptr)
 {
-    const auto& entrypoints          (m_device_ptr->get_extension_khr_bind_memory2_entrypoints() );
-    const bool  is_disjoint_yuv_image((m_create_info_ptr->get_create_flags() & Anvil::ImageCreateFlagBits::CREATE_DISJOINT_BIT) != 0);
-    VkResult    result               (VK_ERROR_INITIALIZATION_FAILED);
-
-    const uint32_t n_planes = (is_disjoint_yuv_image ? Anvil::Formats::get_format_n_planes(m_create_info_ptr->get_format() )
-                                                     : 1);
+    const auto& entrypoints(m_device_ptr->get_extension_khr_bind_memory2_entrypoints() );
+    VkResult    result     (VK_ERROR_INITIALIZATION_FAILED);
 
     /* Sanity checks */
     anvil_assert(in_memory_block_ptr                                                                      != nullptr);
@@ -1976,123 +2478,115 @@ bool Anvil::Image::set_memory_internal(Anvil::MemoryBlock*  in_memory_block_ptr,
     }
 
     {
-        std::vector<VkBindImageMemoryInfoKHR>                               bind_info_vec;
-        std::vector<Anvil::StructChainUniquePtr<VkBindImageMemoryInfoKHR> > struct_chain_ptrs;
-
-        bind_info_vec.resize    (n_planes);
-        struct_chain_ptrs.resize(n_planes);
+        Anvil::StructChainVector<VkBindImageMemoryInfoKHR> bind_info_chains;
 
-        for (uint32_t n_current_plane = 0;
-                      n_current_plane < n_planes;
-                    ++n_current_plane)
-        {
-            Anvil::StructChainUniquePtr<VkBindImageMemoryInfoKHR> struct_chain_ptr;
-            Anvil::StructChainer<VkBindImageMemoryInfoKHR>        struct_chainer;
+        append_memory_bind_infos(in_memory_block_ptr,
+                                 in_n_device_group_indices,
+                                 in_device_group_indices_ptr,
+                                 in_n_SFR_rects,
+                                 in_SFRs_ptr,
+                                &bind_info_chains);
 
-            {
-                VkBindImageMemoryInfoKHR bind_info;
+        anvil_assert(bind_info_chains.get_n_structs() > 0);
 
-                bind_info.image            = m_image;
-                bind_info.memory           = in_memory_block_ptr->get_memory      ();
-                bind_info.memoryOffset     = in_memory_block_ptr->get_start_offset();
-                bind_info.pNext            = nullptr;
-                bind_info.sType            = VK_STRUCTURE_TYPE_BIND_IMAGE_MEMORY_INFO_KHR;
+        result = entrypoints.vkBindImageMemory2KHR(m_device_ptr->get_device_vk(),
+                                                   bind_info_chains.get_n_structs  (),
+                                                   bind_info_chains.get_root_structs() );
+    }
 
-                struct_chainer.append_struct(bind_info);
-            }
+    anvil_assert_vk_call_succeeded(result);
+    if (is_vk_call_successful(result) )
+    {
+        on_nonsparse_memory_bound(in_memory_block_ptr,
+                                  in_owned_by_image);
+    }
 
-            if (in_n_device_group_indices > 0)
-            {
-                VkBindImageMemoryDeviceGroupInfoKHR bind_info_dg;
+end:
+    return is_vk_call_successful(result);
+}
 
-                bind_info_dg.deviceIndexCount             = in_n_device_group_indices;
-                bind_info_dg.pDeviceIndices               = in_device_group_indices_ptr;
-                bind_info_dg.pSplitInstanceBindRegions    = in_SFRs_ptr;
-                bind_info_dg.splitInstanceBindRegionCount = in_n_SFR_rects;
-                bind_info_dg.pNext                        = nullptr;
-                bind_info_dg.sType                        = VK_STRUCTURE_TYPE_BIND_IMAGE_MEMORY_DEVICE_GROUP_INFO_KHR;
+/* Please see header for specification */
+bool Anvil::Image::set_memory_multi(uint32_t                  in_n_image_memory_binding_updates,
+                                    ImageMemoryBindingUpdate* in_updates_ptr)
+{
+    Anvil::StructChainVector<VkBindImageMemoryInfoKHR> bind_info_chains;
+    const Anvil::BaseDevice*                           device_ptr      (nullptr);
+    VkResult                                           result          (VK_ERROR_INITIALIZATION_FAILED);
 
-                struct_chainer.append_struct(bind_info_dg);
-            }
+    /* Sanity checks */
+    if (in_n_image_memory_binding_updates == 0)
+    {
+        anvil_assert(in_n_image_memory_binding_updates != 0);
 
-            if (is_disjoint_yuv_image)
-            {
-                VkBindImagePlaneMemoryInfoKHR plane_info;
+        goto end;
+    }
 
-                plane_info.planeAspect = (n_current_plane == 0) ? VK_IMAGE_ASPECT_PLANE_0_BIT
-                                       : (n_current_plane == 1) ? VK_IMAGE_ASPECT_PLANE_1_BIT
-                                                                : VK_IMAGE_ASPECT_PLANE_2_BIT;
-                plane_info.pNext       = nullptr;
-                plane_info.sType       = VK_STRUCTURE_TYPE_BIND_IMAGE_PLANE_MEMORY_INFO_KHR;
+    for (uint32_t n_update = 0;
+                  n_update < in_n_image_memory_binding_updates;
+                ++n_update)
+    {
+        const auto& current_update(in_updates_ptr[n_update]);
+        auto        image_ptr     (current_update.image_ptr);
 
-                struct_chainer.append_struct(plane_info);
+        anvil_assert(current_update.memory_block_ptr                                                                     != nullptr);
+        anvil_assert((image_ptr->m_create_info_ptr->get_create_flags() & Anvil::ImageCreateFlagBits::SPARSE_BINDING_BIT) == 0);
+        anvil_assert(image_ptr->m_mipmap_props.size()                                                                    >  0);
+        anvil_assert(image_ptr->m_memory_blocks_owned.size()                                                             == 0);
+        anvil_assert(image_ptr->m_create_info_ptr->get_internal_type()                                                   != Anvil::ImageInternalType::SWAPCHAIN_WRAPPER);
 
-                anvil_assert(n_current_plane >= 0 &&
-                             n_current_plane <= 2);
-            }
+        if (n_update == 0)
+        {
+            device_ptr = image_ptr->m_device_ptr;
+        }
+        else
+        {
+            anvil_assert(device_ptr == image_ptr->m_device_ptr);
+        }
 
-            struct_chain_ptr = struct_chainer.create_chain();
+        if (current_update.device_indices.size() > 0)
+        {
+            if (!image_ptr->do_sanity_checks_for_physical_device_binding(current_update.memory_block_ptr,
+                                                                         static_cast<uint32_t>(current_update.device_indices.size() )) )
+            {
+                anvil_assert_fail();
 
-            bind_info_vec.at    (n_current_plane) = *struct_chain_ptr->get_root_struct();
-            struct_chain_ptrs.at(n_current_plane) = std::move                         (struct_chain_ptr);
+                goto end;
+            }
         }
+    }
 
-        anvil_assert(bind_info_vec.size() > 0);
+    /* Bind all images with a single call */
+    for (uint32_t n_update = 0;
+                  n_update < in_n_image_memory_binding_updates;
+                ++n_update)
+    {
+        const auto& current_update = in_updates_ptr[n_update];
 
-        result = entrypoints.vkBindImageMemory2KHR(m_device_ptr->get_device_vk                   (),
-                                                   static_cast<uint32_t>                         (bind_info_vec.size() ),
-                                                   reinterpret_cast<const VkBindImageMemoryInfo*>(&bind_info_vec.at(0) ));
+        current_update.image_ptr->append_memory_bind_infos(current_update.memory_block_ptr,
+                                                           static_cast<uint32_t>(current_update.device_indices.size() ),
+                                                           (current_update.device_indices.size() > 0) ? &current_update.device_indices.at(0)
+                                                                                                      : nullptr,
+                                                           0,       /* in_n_SFR_rects */
+                                                           nullptr, /* in_SFRs_ptr    */
+                                                          &bind_info_chains);
     }
 
+    result = device_ptr->get_extension_khr_bind_memory2_entrypoints().vkBindImageMemory2KHR(device_ptr->get_device_vk(),
+                                                                                            bind_info_chains.get_n_structs  (),
+                                                                                            bind_info_chains.get_root_structs() );
+
     anvil_assert_vk_call_succeeded(result);
     if (is_vk_call_successful(result) )
     {
-        if (in_owned_by_image)
-        {
-            m_memory_blocks_owned.push_back(
-                MemoryBlockUniquePtr(in_memory_block_ptr,
-                                     std::default_delete<MemoryBlock>() )
-            );
-        }
-
+        for (uint32_t n_update = 0;
+                      n_update < in_n_image_memory_binding_updates;
+                    ++n_update)
         {
-            const auto&        mips_to_upload   = m_create_info_ptr->get_mipmaps_to_upload();
-            const auto         tiling           = m_create_info_ptr->get_tiling           ();
-            Anvil::ImageLayout src_image_layout = (tiling == Anvil::ImageTiling::LINEAR && mips_to_upload.size() > 0) ? Anvil::ImageLayout::PREINITIALIZED
-                                                                                                                      : Anvil::ImageLayout::UNDEFINED;
+            const auto& current_update = in_updates_ptr[n_update];
 
-            /* Fill the storage with mipmap contents, if mipmap data was specified at input */
-            if (mips_to_upload.size() > 0)
-            {
-                upload_mipmaps(&mips_to_upload,
-                               src_image_layout,
-                              &src_image_layout);
-            }
-
-            if (m_create_info_ptr->get_post_alloc_image_layout() != m_create_info_ptr->get_post_create_image_layout() )
-            {
-                const uint32_t     n_mipmaps_to_upload = static_cast<uint32_t>(mips_to_upload.size());
-                Anvil::AccessFlags src_access_mask;
-
-                if (n_mipmaps_to_upload > 0)
-                {
-                    if (tiling == Anvil::ImageTiling::LINEAR)
-                    {
-                        src_access_mask = Anvil::AccessFlagBits::HOST_WRITE_BIT;
-                    }
-                    else
-                    {
-                        src_access_mask = Anvil::AccessFlagBits::TRANSFER_WRITE_BIT;
-                    }
-                }
-
-                transition_to_post_alloc_image_layout(src_access_mask,
-                                                      src_image_layout);
-            }
-
-            m_create_info_ptr->clear_mipmaps_to_upload();
+            current_update.image_ptr->on_nonsparse_memory_bound(current_update.memory_block_ptr,
+                                                                current_update.memory_block_owned_by_image);
         }
-
     }
 
 end:
@@ -2253,6 +2747,86 @@ void Anvil::Image::transition_to_post_alloc_image_layout(Anvil::AccessFlags in_s
     m_has_transitioned_to_post_alloc_layout = true;
 }
 
+/** Updates the tracked state of all subresources in the specified range. Does nothing if state tracking is disabled.
+ *
+ *  @param in_subresource_range Subresources to update. VK_REMAINING_MIP_LEVELS and VK_REMAINING_ARRAY_LAYERS are accepted.
+ *  @param in_new_layout        Layout the subresources are in after the command executes.
+ *  @param in_stage_mask        Stages the command accesses the subresources at. For barriers, the destination stage mask.
+ *  @param in_access_mask       Access types used by the command. For barriers, the destination access mask.
+ *  @param in_is_barrier        true if the command synchronizes the subresources, in which case the masks replace the
+ *                              tracked ones. Otherwise, they are added to the tracked masks.
+ **/
+void Anvil::Image::update_tracked_state(const Anvil::ImageSubresourceRange& in_subresource_range,
+                                        Anvil::ImageLayout                  in_new_layout,
+                                        Anvil::PipelineStageFlags           in_stage_mask,
+                                        Anvil::AccessFlags                  in_access_mask,
+                                        bool                                in_is_barrier)
+{
+    const uint32_t n_layers    = m_create_info_ptr->get_n_layers();
+    const uint32_t layer_count = (in_subresource_range.layer_count == VK_REMAINING_ARRAY_LAYERS) ? (n_layers - in_subresource_range.base_array_layer)
+                                                                                                 : in_subresource_range.layer_count;
+    const uint32_t level_count = (in_subresource_range.level_count == VK_REMAINING_MIP_LEVELS)   ? (m_n_mipmaps - in_subresource_range.base_mip_level)
+                                                                                                 : in_subresource_range.level_count;
+
+    if (m_tracked_states.empty() )
+    {
+        goto end;
+    }
+
+    anvil_assert(in_subresource_range.base_array_layer + layer_count <= n_layers);
+    anvil_assert(in_subresource_range.base_mip_level   + level_count <= m_n_mipmaps);
+
+    for (uint32_t n_layer = in_subresource_range.base_array_layer;
+                  n_layer < in_subresource_range.base_array_layer + layer_count && n_layer < n_layers;
+                ++n_layer)
+    {
+        for (uint32_t n_mip = in_subresource_range.base_mip_level;
+                      n_mip < in_subresource_range.base_mip_level + level_count && n_mip < m_n_mipmaps;
+                    ++n_mip)
+        {
+            auto& current_state = m_tracked_states.at(n_layer * m_n_mipmaps + n_mip);
+
+            current_state.layout = in_new_layout;
+
+            if (in_is_barrier)
+            {
+                current_state.access_mask = in_access_mask;
+                current_state.stage_mask  = in_stage_mask;
+            }
+            else
+            {
+                current_state.access_mask |= in_access_mask;
+                current_state.stage_mask  |= in_stage_mask;
+            }
+        }
+    }
+
+end:
+    ;
+}
+
+/** Tells whether an optimally-tiled image can be filled directly from the host with VK_EXT_host_image_copy.
+ *
+ *  Only UNDEFINED, PREINITIALIZED and GENERAL source layouts are accepted, as these are always valid for host layout
+ *  transitions and copies, regardless of the layouts reported in VkPhysicalDeviceHostImageCopyPropertiesEXT.
+ *
+ *  @param in_current_image_layout Image layout, that the image is in right now.
+ *
+ *  @return true if upload_mipmaps_host() can be used, false otherwise.
+ **/
+bool Anvil::Image::can_upload_mipmaps_from_host(Anvil::ImageLayout in_current_image_layout) const
+{
+    const auto features_ptr = m_device_ptr->get_physical_device_features().ext_host_image_copy_features_ptr;
+
+    return (m_create_info_ptr->get_usage_flags() & Anvil::ImageUsageFlagBits::HOST_TRANSFER_BIT_EXT) != 0       &&
+            m_device_ptr->get_extension_info()->ext_host_image_copy()                                            &&
+            features_ptr                                                                         != nullptr      &&
+            features_ptr->host_image_copy                                                                        &&
+           (in_current_image_layout == Anvil::ImageLayout::UNDEFINED      ||
+            in_current_image_layout == Anvil::ImageLayout::PREINITIALIZED ||
+            in_current_image_layout == Anvil::ImageLayout::GENERAL);
+}
+
 /** Please see header for specification */
 void Anvil::Image::upload_mipmaps(const std::vector<MipmapRawData>* in_mipmaps_ptr,
                                   Anvil::ImageLayout                in_current_image_layout,
@@ -2335,10 +2909,10 @@ void Anvil::Image::upload_mipmaps(const std::vector<MipmapRawData>* in_mipmaps_p
                 image_subresource.aspect_mask = current_aspect;
                 image_subresource.mip_level   = current_mipmap_raw_data_item_ptr->n_mipmap;
 
-                Anvil::Vulkan::vkGetImageSubresourceLayout(m_device_ptr->get_device_vk(),
-                                                           m_image,
-                                                           reinterpret_cast<const VkImageSubresource*>(&image_subresource),
-                                                           reinterpret_cast<VkSubresourceLayout*>     (&image_subresource_layout) );
+                m_device_ptr->get_dispatch_table().vkGetImageSubresourceLayout(m_device_ptr->get_device_vk(),
+                                                                               m_image,
+                                                                               reinterpret_cast<const VkImageSubresource*>(&image_subresource),
+                                                                               reinterpret_cast<VkSubresourceLayout*>     (&image_subresource_layout) );
 
                 /* Determine row size for the mipmap.
                  *
@@ -2434,208 +3008,562 @@ void Anvil::Image::upload_mipmaps(const std::vector<MipmapRawData>* in_mipmaps_p
         *out_new_image_layout_ptr = in_current_image_layout;
     }
     else
+    if (can_upload_mipmaps_from_host(in_current_image_layout) )
+    {
+        upload_mipmaps_host(in_mipmaps_ptr,
+                            image_subresource_range,
+                            in_current_image_layout,
+                            out_new_image_layout_ptr);
+    }
+    else
+    {
+        upload_mipmaps_optimal(in_mipmaps_ptr,
+                               image_subresource_range,
+                               in_current_image_layout,
+                               universal_queue_ptr,
+                               Anvil::ImageLayout::UNDEFINED, /* in_final_image_layout          */
+                               VK_QUEUE_FAMILY_IGNORED,       /* in_dst_queue_family_index      */
+                               Anvil::AccessFlagBits::NONE,   /* in_dst_access_mask             */
+                               nullptr,                       /* in_opt_semaphore_to_signal_ptr */
+                               nullptr,                       /* out_opt_acquire_barriers_ptr   */
+                               out_new_image_layout_ptr);
+    }
+}
+
+/** Updates an optimally-tiled image with specified mip-map data by copying it straight from host memory with
+ *  VK_EXT_host_image_copy. No staging buffer, command buffer or queue submission is involved. The image is
+ *  transitioned to GENERAL layout on the host, if necessary.
+ *
+ *  Caller must ensure can_upload_mipmaps_from_host() returns true for @param in_current_image_layout.
+ *
+ *  @param in_mipmaps_ptr           Mip data to upload. Must not be null.
+ *  @param in_subresource_range     Subresource range covering all mips to upload.
+ *  @param in_current_image_layout  Image layout, that the image is in right now.
+ *  @param out_new_image_layout_ptr Deref will be set to the image layout the image is in after the copy ops.
+ *                                  Must not be null.
+ */
+void Anvil::Image::upload_mipmaps_host(const std::vector<MipmapRawData>*   in_mipmaps_ptr,
+                                       const Anvil::ImageSubresourceRange& in_subresource_range,
+                                       Anvil::ImageLayout                  in_current_image_layout,
+                                       Anvil::ImageLayout*                 out_new_image_layout_ptr)
+{
+    const auto&                         base_mip_height = m_create_info_ptr->get_base_mip_height();
+    const auto&                         base_mip_width  = m_create_info_ptr->get_base_mip_width ();
+    VkCopyMemoryToImageInfoEXT          copy_info;
+    std::vector<VkMemoryToImageCopyEXT> copy_regions;
+    const auto&                         entrypoints     = m_device_ptr->get_extension_ext_host_image_copy_entrypoints();
+    VkResult                            result          = VK_ERROR_INITIALIZATION_FAILED;
+
+    ANVIL_REDUNDANT_VARIABLE(result);
+
+    anvil_assert(m_create_info_ptr->get_tiling() == Anvil::ImageTiling::OPTIMAL);
+    anvil_assert(can_upload_mipmaps_from_host(in_current_image_layout) );
+
+    /* Transition the image to the general layout on the host. No synchronization is needed, as UNDEFINED and
+     * PREINITIALIZED images cannot be in use by the device. */
+    if (in_current_image_layout != Anvil::ImageLayout::GENERAL)
+    {
+        VkHostImageLayoutTransitionInfoEXT transition_info;
+
+        transition_info.image            = m_image;
+        transition_info.newLayout        = VK_IMAGE_LAYOUT_GENERAL;
+        transition_info.oldLayout        = static_cast<VkImageLayout>(in_current_image_layout);
+        transition_info.pNext            = nullptr;
+        transition_info.sType            = VK_STRUCTURE_TYPE_HOST_IMAGE_LAYOUT_TRANSITION_INFO_EXT;
+        transition_info.subresourceRange = in_subresource_range.get_vk();
+
+        result = entrypoints.vkTransitionImageLayoutEXT(m_device_ptr->get_device_vk(),
+                                                        1, /* transitionCount */
+                                                       &transition_info);
+        anvil_assert_vk_call_succeeded(result);
+    }
+
+    /* Issue the memory->image copy ops. Mip data is tightly packed, so row length and image height are left at 0. */
+    copy_regions.reserve(in_mipmaps_ptr->size() );
+
+    for (auto mipmap_iterator  = in_mipmaps_ptr->cbegin();
+              mipmap_iterator != in_mipmaps_ptr->cend();
+            ++mipmap_iterator)
+    {
+        VkMemoryToImageCopyEXT current_copy_region;
+        const auto&            current_mipmap = *mipmap_iterator;
+
+        current_copy_region.imageExtent.depth               = std::max(current_mipmap.n_slices,                             1u);
+        current_copy_region.imageExtent.height              = std::max(base_mip_height / (1 << current_mipmap.n_mipmap), 1u);
+        current_copy_region.imageExtent.width               = std::max(base_mip_width  / (1 << current_mipmap.n_mipmap), 1u);
+        current_copy_region.imageOffset.x                   = 0;
+        current_copy_region.imageOffset.y                   = 0;
+        current_copy_region.imageOffset.z                   = 0;
+        current_copy_region.imageSubresource.aspectMask     = static_cast<VkImageAspectFlags>(current_mipmap.aspect);
+        current_copy_region.imageSubresource.baseArrayLayer = current_mipmap.n_layer;
+        current_copy_region.imageSubresource.layerCount     = current_mipmap.n_layers;
+        current_copy_region.imageSubresource.mipLevel       = current_mipmap.n_mipmap;
+        current_copy_region.memoryImageHeight               = 0;
+        current_copy_region.memoryRowLength                 = 0;
+        current_copy_region.pHostPointer                    = (current_mipmap.linear_tightly_packed_data_uchar_ptr     != nullptr) ? current_mipmap.linear_tightly_packed_data_uchar_ptr.get()
+                                                            : (current_mipmap.linear_tightly_packed_data_uchar_raw_ptr != nullptr) ? current_mipmap.linear_tightly_packed_data_uchar_raw_ptr
+                                                                                                                                   : &(*current_mipmap.linear_tightly_packed_data_uchar_vec_ptr)[0];
+        current_copy_region.pNext                           = nullptr;
+        current_copy_region.sType                           = VK_STRUCTURE_TYPE_MEMORY_TO_IMAGE_COPY_EXT;
+
+        copy_regions.push_back(current_copy_region);
+    }
+
+    copy_info.dstImage       = m_image;
+    copy_info.dstImageLayout = VK_IMAGE_LAYOUT_GENERAL;
+    copy_info.flags          = 0;
+    copy_info.pNext          = nullptr;
+    copy_info.pRegions       = (copy_regions.size() > 0) ? &copy_regions.at(0) : nullptr;
+    copy_info.regionCount    = static_cast<uint32_t>(copy_regions.size() );
+    copy_info.sType          = VK_STRUCTURE_TYPE_COPY_MEMORY_TO_IMAGE_INFO_EXT;
+
+    result = entrypoints.vkCopyMemoryToImageEXT(m_device_ptr->get_device_vk(),
+                                                &copy_info);
+    anvil_assert_vk_call_succeeded(result);
+
+    for (const auto& current_mipmap : *in_mipmaps_ptr)
+    {
+        Anvil::PerfCounters::increment(Anvil::PerfCounters::Counter::UPLOADED_BYTES,
+                                       current_mipmap.n_slices * current_mipmap.data_size);
+    }
+
+    update_tracked_state(in_subresource_range,
+                         Anvil::ImageLayout::GENERAL,
+                         Anvil::PipelineStageFlagBits::HOST_BIT,
+                         Anvil::AccessFlagBits::HOST_WRITE_BIT,
+                         true); /* in_is_barrier */
+
+    *out_new_image_layout_ptr = Anvil::ImageLayout::GENERAL;
+}
+
+/* Please see header for specification */
+bool Anvil::Image::upload_mipmaps_async(const std::vector<MipmapRawData>* in_mipmaps_ptr,
+                                        Anvil::ImageLayout                in_current_image_layout,
+                                        Anvil::ImageLayout                in_new_image_layout,
+                                        Anvil::Queue*                     in_dst_queue_ptr,
+                                        Anvil::AccessFlags                in_dst_access_mask,
+                                        Anvil::Semaphore*                 in_opt_semaphore_to_signal_ptr,
+                                        std::vector<Anvil::ImageBarrier>* out_opt_acquire_barriers_ptr,
+                                        Anvil::Queue*                     in_opt_transfer_queue_ptr)
+{
+    Anvil::ImageAspectFlags      image_aspects_touched;
+    Anvil::ImageSubresourceRange image_subresource_range;
+    Anvil::ImageLayout           new_image_layout        = Anvil::ImageLayout::UNKNOWN;
+    bool                         result                  = false;
+    Anvil::Queue*                transfer_queue_ptr      = in_opt_transfer_queue_ptr;
+
+    anvil_assert(in_mipmaps_ptr   != nullptr);
+    anvil_assert(in_dst_queue_ptr != nullptr);
+
+    if (m_create_info_ptr->get_tiling() != Anvil::ImageTiling::OPTIMAL)
     {
         anvil_assert(m_create_info_ptr->get_tiling() == Anvil::ImageTiling::OPTIMAL);
 
-        Anvil::BufferUniquePtr               temp_buffer_ptr;
-        Anvil::PrimaryCommandBufferUniquePtr temp_cmdbuf_ptr;
-        VkDeviceSize                         total_raw_mips_size = 0;
+        goto end;
+    }
 
-        /* Count how much space all specified mipmaps take in raw format. */
-        for (auto mipmap_iterator  = in_mipmaps_ptr->cbegin();
-                  mipmap_iterator != in_mipmaps_ptr->cend();
-                ++mipmap_iterator)
+    if (in_new_image_layout == Anvil::ImageLayout::UNDEFINED    ||
+        in_new_image_layout == Anvil::ImageLayout::PREINITIALIZED)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (transfer_queue_ptr == nullptr)
+    {
+        transfer_queue_ptr = (m_device_ptr->get_n_transfer_queues() > 0) ? m_device_ptr->get_transfer_queue (0)
+                                                                         : m_device_ptr->get_universal_queue(0);
+
+        if (transfer_queue_ptr == nullptr)
         {
-            total_raw_mips_size += mipmap_iterator->n_slices * mipmap_iterator->data_size;
+            anvil_assert(transfer_queue_ptr != nullptr);
 
-            /* Mip offsets must be rounded up to 4 due to the following "Valid Usage" requirement of VkBufferImageCopy struct:
-             *
-             * "bufferOffset must be a multiple of 4"
-             */
-            if ((total_raw_mips_size % 4) != 0)
-            {
-                total_raw_mips_size = Anvil::Utils::round_up(total_raw_mips_size,
-                                                             static_cast<VkDeviceSize>(4) );
-            }
+            goto end;
         }
+    }
+
+    /* Make sure image has been assigned at least one memory block before we go ahead with the upload process */
+    get_memory_block();
+
+    for (const auto& current_mipmap : *in_mipmaps_ptr)
+    {
+        image_aspects_touched |= current_mipmap.aspect;
+    }
 
-        /* Merge data of all mips into one buffer, cache the offsets and push the merged data
-         * to the buffer memory. */
-        std::vector<VkDeviceSize> mip_data_offsets;
+    image_subresource_range.aspect_mask      = image_aspects_touched;
+    image_subresource_range.base_array_layer = 0;
+    image_subresource_range.base_mip_level   = 0;
+    image_subresource_range.layer_count      = m_create_info_ptr->get_n_layers();
+    image_subresource_range.level_count      = m_n_mipmaps;
+
+    upload_mipmaps_optimal(in_mipmaps_ptr,
+                           image_subresource_range,
+                           in_current_image_layout,
+                           transfer_queue_ptr,
+                           in_new_image_layout,
+                           in_dst_queue_ptr->get_queue_family_index(),
+                           in_dst_access_mask,
+                           in_opt_semaphore_to_signal_ptr,
+                           out_opt_acquire_barriers_ptr,
+                          &new_image_layout);
 
-        VkDeviceSize          current_mip_offset = 0;
-        std::unique_ptr<char> merged_mip_storage(new char[static_cast<uint32_t>(total_raw_mips_size)]);
+    anvil_assert(new_image_layout == in_new_image_layout);
 
-        /* NOTE: The memcpy() call, as well as the way we implement copy op calls below, assume
-         *       POT resolution of the base mipmap
+    result = true;
+end:
+    return result;
+}
+
+/** Copies the specified mip data to an optimally-tiled image, using a staging buffer.
+ *
+ *  The staging storage is sub-allocated from the device-wide staging ring, if one is available and can accommodate
+ *  the data. In that case, the function does not block. Otherwise, a temporary staging buffer is created and the
+ *  function blocks until the copy finishes executing.
+ *
+ *  @param in_mipmaps_ptr                 Mip data to upload. Must not be null.
+ *  @param in_subresource_range           Subresource range covering all mips to upload.
+ *  @param in_current_image_layout        Image layout, that the image is in right now.
+ *  @param in_queue_ptr                   Queue to submit the copy ops to. Must not be null.
+ *  @param in_final_image_layout          If not UNDEFINED, the image is transitioned to this layout once the copy ops finish.
+ *  @param in_dst_queue_family_index      If not VK_QUEUE_FAMILY_IGNORED and different from @param in_queue_ptr's family, ownership
+ *                                        of exclusively-owned images is released to this queue family once the copy ops finish.
+ *  @param in_dst_access_mask             Access mask to use for the acquire barrier. Ignored if no ownership transfer takes place.
+ *  @param in_opt_semaphore_to_signal_ptr If not null, the semaphore is signalled once the copy ops finish.
+ *  @param out_opt_acquire_barriers_ptr   If not null and ownership of the image is released to another queue family, the acquire
+ *                                        barrier that family must execute is appended to the vector.
+ *  @param out_new_image_layout_ptr       Deref will be set to the image layout the image is going to be in once the copy ops
+ *                                        finish. Must not be null.
+ */
+void Anvil::Image::upload_mipmaps_optimal(const std::vector<MipmapRawData>*   in_mipmaps_ptr,
+                                          const Anvil::ImageSubresourceRange& in_subresource_range,
+                                          Anvil::ImageLayout                  in_current_image_layout,
+                                          Anvil::Queue*                       in_queue_ptr,
+                                          Anvil::ImageLayout                  in_final_image_layout,
+                                          uint32_t                            in_dst_queue_family_index,
+                                          Anvil::AccessFlags                  in_dst_access_mask,
+                                          Anvil::Semaphore*                   in_opt_semaphore_to_signal_ptr,
+                                          std::vector<Anvil::ImageBarrier>*   out_opt_acquire_barriers_ptr,
+                                          Anvil::ImageLayout*                 out_new_image_layout_ptr)
+{
+    anvil_assert(m_create_info_ptr->get_tiling() == Anvil::ImageTiling::OPTIMAL);
+
+    Anvil::StagingRing::Allocation       staging_allocation;
+    Anvil::Buffer*                       staging_buffer_ptr    = nullptr;
+    VkDeviceSize                         staging_buffer_offset = 0;
+    Anvil::StagingRing*                  staging_ring_ptr      = (m_device_ptr->get_type() == Anvil::DeviceType::SINGLE_GPU) ? m_device_ptr->get_staging_ring()
+                                                                                                                             : nullptr;
+    Anvil::BufferUniquePtr               temp_buffer_ptr;
+    Anvil::PrimaryCommandBufferUniquePtr temp_cmdbuf_ptr;
+    VkDeviceSize                         total_raw_mips_size   = 0;
+    bool                                 uses_staging_ring     = false;
+
+    /* Count how much space all specified mipmaps take in raw format. */
+    for (auto mipmap_iterator  = in_mipmaps_ptr->cbegin();
+              mipmap_iterator != in_mipmaps_ptr->cend();
+            ++mipmap_iterator)
+    {
+        total_raw_mips_size += mipmap_iterator->n_slices * mipmap_iterator->data_size;
+
+        /* Mip offsets must be rounded up to 4 due to the following "Valid Usage" requirement of VkBufferImageCopy struct:
+         *
+         * "bufferOffset must be a multiple of 4"
          */
-        const auto base_mip_height = m_create_info_ptr->get_base_mip_height();
+        if ((total_raw_mips_size % 4) != 0)
+        {
+            total_raw_mips_size = Anvil::Utils::round_up(total_raw_mips_size,
+                                                         static_cast<VkDeviceSize>(4) );
+        }
+    }
 
-        anvil_assert(base_mip_height < 2 || (base_mip_height % 2) == 0);
+    /* If the device-wide staging ring is available, try to sub-allocate the staging storage from it.
+     *
+     * bufferOffset of each copy region must be a multiple of 4 and of the format's texel block size. Texel blocks
+     * are at most 32 bytes large and may use a multiple of 3 bytes, so region start offsets are aligned to 96 bytes
+     * in addition to the optimal copy offset alignment reported by the implementation.
+     */
+    if (staging_ring_ptr != nullptr)
+    {
+        const VkDeviceSize optimal_copy_offset_alignment = m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits.optimal_buffer_copy_offset_alignment;
 
-        for (auto mipmap_iterator  = in_mipmaps_ptr->cbegin();
-                  mipmap_iterator != in_mipmaps_ptr->cend();
-                ++mipmap_iterator)
+        uses_staging_ring = staging_ring_ptr->allocate(total_raw_mips_size,
+                                                       3 * std::max(static_cast<VkDeviceSize>(32),
+                                                                    optimal_copy_offset_alignment),
+                                                      &staging_allocation);
+
+        if (uses_staging_ring)
         {
-            const auto&          current_mipmap           = *mipmap_iterator;
-            const unsigned char* current_mipmap_data_ptr;
-            const auto           current_mipmap_data_size = current_mipmap.n_slices * current_mipmap.data_size;
+            staging_buffer_offset = staging_allocation.offset;
+            staging_buffer_ptr    = staging_allocation.buffer_ptr;
+        }
+    }
+
+    /* Merge data of all mips into one buffer, cache the offsets and push the merged data
+     * to the buffer memory. If the staging ring is used, the data goes directly to the ring. */
+    std::vector<VkDeviceSize> mip_data_offsets;
+
+    VkDeviceSize          current_mip_offset = 0;
+    std::unique_ptr<char> merged_mip_storage((uses_staging_ring) ? nullptr
+                                                                 : new char[static_cast<uint32_t>(total_raw_mips_size)]);
+
+    /* NOTE: The memcpy() call, as well as the way we implement copy op calls below, assume
+     *       POT resolution of the base mipmap
+     */
+    const auto base_mip_height = m_create_info_ptr->get_base_mip_height();
+
+    anvil_assert(base_mip_height < 2 || (base_mip_height % 2) == 0);
 
-            current_mipmap_data_ptr = (mipmap_iterator->linear_tightly_packed_data_uchar_ptr     != nullptr) ? mipmap_iterator->linear_tightly_packed_data_uchar_ptr.get()
-                                    : (mipmap_iterator->linear_tightly_packed_data_uchar_raw_ptr != nullptr) ? mipmap_iterator->linear_tightly_packed_data_uchar_raw_ptr
-                                                                                                             : &(*mipmap_iterator->linear_tightly_packed_data_uchar_vec_ptr)[0];
+    for (auto mipmap_iterator  = in_mipmaps_ptr->cbegin();
+              mipmap_iterator != in_mipmaps_ptr->cend();
+            ++mipmap_iterator)
+    {
+        const auto&          current_mipmap           = *mipmap_iterator;
+        const unsigned char* current_mipmap_data_ptr;
+        const auto           current_mipmap_data_size = current_mipmap.n_slices * current_mipmap.data_size;
+
+        current_mipmap_data_ptr = (mipmap_iterator->linear_tightly_packed_data_uchar_ptr     != nullptr) ? mipmap_iterator->linear_tightly_packed_data_uchar_ptr.get()
+                                : (mipmap_iterator->linear_tightly_packed_data_uchar_raw_ptr != nullptr) ? mipmap_iterator->linear_tightly_packed_data_uchar_raw_ptr
+                                                                                                         : &(*mipmap_iterator->linear_tightly_packed_data_uchar_vec_ptr)[0];
 
-            mip_data_offsets.push_back(current_mip_offset);
+        mip_data_offsets.push_back(staging_buffer_offset + current_mip_offset);
 
-            anvil_assert(current_mip_offset + current_mipmap_data_size <= total_raw_mips_size);
+        anvil_assert(current_mip_offset + current_mipmap_data_size <= total_raw_mips_size);
 
+        if (uses_staging_ring)
+        {
+            staging_buffer_ptr->write(staging_buffer_offset + current_mip_offset,
+                                      current_mipmap_data_size,
+                                      current_mipmap_data_ptr);
+        }
+        else
+        {
             memcpy(merged_mip_storage.get() + current_mip_offset,
                    current_mipmap_data_ptr,
                    current_mipmap_data_size);
+        }
 
-            current_mip_offset += current_mipmap.n_slices * current_mipmap.data_size;
+        current_mip_offset += current_mipmap.n_slices * current_mipmap.data_size;
 
-            /* Mip offset must be rounded up to 4 due to the following "Valid Usage" requirement of VkBufferImageCopy struct:
-             *
-             * "bufferOffset must be a multiple of 4"
-             */
-            if ((current_mip_offset % 4) != 0)
-            {
-                current_mip_offset = Anvil::Utils::round_up(current_mip_offset, static_cast<VkDeviceSize>(4) );
-            }
+        /* Mip offset must be rounded up to 4 due to the following "Valid Usage" requirement of VkBufferImageCopy struct:
+         *
+         * "bufferOffset must be a multiple of 4"
+         */
+        if ((current_mip_offset % 4) != 0)
+        {
+            current_mip_offset = Anvil::Utils::round_up(current_mip_offset, static_cast<VkDeviceSize>(4) );
+        }
+    }
+
+    if (!uses_staging_ring)
+    {
+        auto create_info_ptr = Anvil::BufferCreateInfo::create_alloc(m_device_ptr,
+                                                                     total_raw_mips_size,
+                                                                     Anvil::QueueFamilyFlagBits::GRAPHICS_BIT,
+                                                                     Anvil::SharingMode::EXCLUSIVE,
+                                                                     Anvil::BufferCreateFlagBits::NONE,
+                                                                     Anvil::BufferUsageFlagBits::TRANSFER_SRC_BIT,
+                                                                     Anvil::MemoryFeatureFlagBits::NONE);
+
+        create_info_ptr->set_client_data(merged_mip_storage.get() );
+        create_info_ptr->set_mt_safety  (Anvil::Utils::convert_boolean_to_mt_safety_enum(is_mt_safe() ));
+
+        temp_buffer_ptr    = Anvil::Buffer::create(std::move(create_info_ptr) );
+        staging_buffer_ptr = temp_buffer_ptr.get();
+    }
+
+    merged_mip_storage.reset();
+
+    /* Set up a command buffer we will use to copy the data to the image */
+    temp_cmdbuf_ptr = m_device_ptr->get_command_pool_for_queue_family_index(in_queue_ptr->get_queue_family_index() )->alloc_primary_level_command_buffer();
+    anvil_assert(temp_cmdbuf_ptr != nullptr);
+
+    temp_cmdbuf_ptr->start_recording(true, /* one_time_submit          */
+                                     false /* simultaneous_use_allowed */);
+    {
+        std::vector<Anvil::BufferImageCopy> copy_regions;
+
+        /* Transfer the image to the transfer_destination layout if not already in this or general layout */
+        if (in_current_image_layout != Anvil::ImageLayout::GENERAL              &&
+            in_current_image_layout != Anvil::ImageLayout::TRANSFER_DST_OPTIMAL)
+        {
+            const auto          sharing_mode   (m_create_info_ptr->get_sharing_mode() );
+            const auto          queue_fam_index((sharing_mode == Anvil::SharingMode::EXCLUSIVE) ? in_queue_ptr->get_queue_family_index() : VK_QUEUE_FAMILY_IGNORED);
+
+            Anvil::ImageBarrier image_barrier  (Anvil::AccessFlagBits::NONE, /* source_access_mask */
+                                                Anvil::AccessFlagBits::TRANSFER_WRITE_BIT,
+                                                in_current_image_layout,
+                                                Anvil::ImageLayout::TRANSFER_DST_OPTIMAL,
+                                                queue_fam_index,
+                                                queue_fam_index,
+                                                this,
+                                                in_subresource_range);
+
+            temp_cmdbuf_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TOP_OF_PIPE_BIT,
+                                                     Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                     Anvil::DependencyFlagBits::NONE,
+                                                     0,              /* in_memory_barrier_count        */
+                                                     nullptr,        /* in_memory_barrier_ptrs         */
+                                                     0,              /* in_buffer_memory_barrier_count */
+                                                     nullptr,        /* in_buffer_memory_barrier_ptrs  */
+                                                     1,              /* in_image_memory_barrier_count  */
+                                                    &image_barrier);
+
+            *out_new_image_layout_ptr = Anvil::ImageLayout::TRANSFER_DST_OPTIMAL;
         }
+        else
+        {
+            *out_new_image_layout_ptr = in_current_image_layout;
+        }
+
+        /* Issue the buffer->image copy op */
+        copy_regions.reserve(in_mipmaps_ptr->size() );
 
+        for (auto mipmap_iterator  = in_mipmaps_ptr->cbegin();
+                  mipmap_iterator != in_mipmaps_ptr->cend();
+                ++mipmap_iterator)
         {
-            auto create_info_ptr = Anvil::BufferCreateInfo::create_alloc(m_device_ptr,
-                                                                         total_raw_mips_size,
-                                                                         Anvil::QueueFamilyFlagBits::GRAPHICS_BIT,
-                                                                         Anvil::SharingMode::EXCLUSIVE,
-                                                                         Anvil::BufferCreateFlagBits::NONE,
-                                                                         Anvil::BufferUsageFlagBits::TRANSFER_SRC_BIT,
-                                                                         Anvil::MemoryFeatureFlagBits::NONE);
+            const auto             base_mip_width      = m_create_info_ptr->get_base_mip_width ();
+            Anvil::BufferImageCopy current_copy_region;
+            const auto&            current_mipmap      = *mipmap_iterator;
+
+            /* Mip data is tightly packed. Leave the image height at 0, so that block-compressed mips smaller than
+             * a single block are also handled correctly. */
+            current_copy_region.buffer_image_height                = 0;
+            current_copy_region.buffer_offset                      = mip_data_offsets[static_cast<uint32_t>(mipmap_iterator - in_mipmaps_ptr->cbegin()) ];
+            current_copy_region.buffer_row_length                  = 0;
+            current_copy_region.image_offset.x                     = 0;
+            current_copy_region.image_offset.y                     = 0;
+            current_copy_region.image_offset.z                     = 0;
+            current_copy_region.image_subresource.base_array_layer = current_mipmap.n_layer;
+            current_copy_region.image_subresource.layer_count      = current_mipmap.n_layers;
+            current_copy_region.image_subresource.aspect_mask      = current_mipmap.aspect;
+            current_copy_region.image_subresource.mip_level        = current_mipmap.n_mipmap;
+            current_copy_region.image_extent.depth                 = current_mipmap.n_slices;
+            current_copy_region.image_extent.height                = std::max(base_mip_height / (1 << current_mipmap.n_mipmap), 1u);
+            current_copy_region.image_extent.width                 = std::max(base_mip_width  / (1 << current_mipmap.n_mipmap), 1u);
+
+            if (current_copy_region.image_extent.depth < 1)
+            {
+                current_copy_region.image_extent.depth = 1;
+            }
+
+            if (current_copy_region.image_extent.height < 1)
+            {
+                current_copy_region.image_extent.height = 1;
+            }
 
-            create_info_ptr->set_client_data(merged_mip_storage.get() );
-            create_info_ptr->set_mt_safety  (Anvil::Utils::convert_boolean_to_mt_safety_enum(is_mt_safe() ));
+            if (current_copy_region.image_extent.width < 1)
+            {
+                current_copy_region.image_extent.width = 1;
+            }
 
-            temp_buffer_ptr = Anvil::Buffer::create(std::move(create_info_ptr) );
+            copy_regions.push_back(current_copy_region);
         }
 
-        merged_mip_storage.reset();
+        /* Issue the copy ops. */
+        const uint32_t        n_copy_regions                   = static_cast<uint32_t>(copy_regions.size() );
+        static const uint32_t n_max_copy_regions_per_copy_call = 1024;
 
-        /* Set up a command buffer we will use to copy the data to the image */
-        temp_cmdbuf_ptr = m_device_ptr->get_command_pool_for_queue_family_index(universal_queue_ptr->get_queue_family_index() )->alloc_primary_level_command_buffer();
-        anvil_assert(temp_cmdbuf_ptr != nullptr);
+        for (uint32_t n_copy_region = 0;
+                      n_copy_region < n_copy_regions;
+                      n_copy_region += n_max_copy_regions_per_copy_call)
+        {
+            const uint32_t n_copy_regions_to_use = std::min(n_max_copy_regions_per_copy_call,
+                                                            n_copy_regions - n_copy_region);
 
-        temp_cmdbuf_ptr->start_recording(true, /* one_time_submit          */
-                                         false /* simultaneous_use_allowed */);
+            temp_cmdbuf_ptr->record_copy_buffer_to_image(staging_buffer_ptr,
+                                                         this,
+                                                         *out_new_image_layout_ptr,
+                                                         n_copy_regions_to_use,
+                                                        &copy_regions.at(n_copy_region) );
+        }
+
+        /* If requested, transition the image to the final layout and release it to the consumer's queue family. Exclusively-owned
+         * images require a matching acquire barrier to be executed on the consumer side. */
         {
-            std::vector<Anvil::BufferImageCopy> copy_regions;
+            const uint32_t src_queue_fam_index  = in_queue_ptr->get_queue_family_index();
+            const bool     needs_ownership_xfer = (m_create_info_ptr->get_sharing_mode() == Anvil::SharingMode::EXCLUSIVE &&
+                                                   in_dst_queue_family_index            != VK_QUEUE_FAMILY_IGNORED         &&
+                                                   in_dst_queue_family_index            != src_queue_fam_index);
+            const auto     new_layout           = (in_final_image_layout != Anvil::ImageLayout::UNDEFINED) ? in_final_image_layout
+                                                                                                          : *out_new_image_layout_ptr;
 
-            /* Transfer the image to the transfer_destination layout if not already in this or general layout */
-            if (in_current_image_layout != Anvil::ImageLayout::GENERAL              &&
-                in_current_image_layout != Anvil::ImageLayout::TRANSFER_DST_OPTIMAL)
+            if (needs_ownership_xfer                            ||
+                new_layout           != *out_new_image_layout_ptr)
             {
-                const auto          sharing_mode   (m_create_info_ptr->get_sharing_mode() );
-                const auto          queue_fam_index((sharing_mode == Anvil::SharingMode::EXCLUSIVE) ? universal_queue_ptr->get_queue_family_index() : VK_QUEUE_FAMILY_IGNORED);
-
-                Anvil::ImageBarrier image_barrier  (Anvil::AccessFlagBits::NONE, /* source_access_mask */
-                                                    Anvil::AccessFlagBits::TRANSFER_WRITE_BIT,
-                                                    in_current_image_layout,
-                                                    Anvil::ImageLayout::TRANSFER_DST_OPTIMAL,
-                                                    queue_fam_index,
-                                                    queue_fam_index,
-                                                    this,
-                                                    image_subresource_range);
-
-                temp_cmdbuf_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TOP_OF_PIPE_BIT,
-                                                         Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                const uint32_t      barrier_src_queue_fam_index((needs_ownership_xfer) ? src_queue_fam_index       : VK_QUEUE_FAMILY_IGNORED);
+                const uint32_t      barrier_dst_queue_fam_index((needs_ownership_xfer) ? in_dst_queue_family_index : VK_QUEUE_FAMILY_IGNORED);
+                Anvil::ImageBarrier release_barrier            (Anvil::AccessFlagBits::TRANSFER_WRITE_BIT,
+                                                                Anvil::AccessFlagBits::NONE, /* destination_access_mask */
+                                                               *out_new_image_layout_ptr,
+                                                                new_layout,
+                                                                barrier_src_queue_fam_index,
+                                                                barrier_dst_queue_fam_index,
+                                                                this,
+                                                                in_subresource_range);
+
+                temp_cmdbuf_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                         Anvil::PipelineStageFlagBits::BOTTOM_OF_PIPE_BIT,
                                                          Anvil::DependencyFlagBits::NONE,
                                                          0,              /* in_memory_barrier_count        */
                                                          nullptr,        /* in_memory_barrier_ptrs         */
                                                          0,              /* in_buffer_memory_barrier_count */
                                                          nullptr,        /* in_buffer_memory_barrier_ptrs  */
                                                          1,              /* in_image_memory_barrier_count  */
-                                                        &image_barrier);
+                                                        &release_barrier);
 
-                *out_new_image_layout_ptr = Anvil::ImageLayout::TRANSFER_DST_OPTIMAL;
-            }
-            else
-            {
-                *out_new_image_layout_ptr = in_current_image_layout;
-            }
-
-            /* Issue the buffer->image copy op */
-            copy_regions.reserve(in_mipmaps_ptr->size() );
-
-            for (auto mipmap_iterator  = in_mipmaps_ptr->cbegin();
-                      mipmap_iterator != in_mipmaps_ptr->cend();
-                    ++mipmap_iterator)
-            {
-                const auto             base_mip_width      = m_create_info_ptr->get_base_mip_width ();
-                Anvil::BufferImageCopy current_copy_region;
-                const auto&            current_mipmap      = *mipmap_iterator;
-
-                current_copy_region.buffer_image_height                = std::max(base_mip_height / (1 << current_mipmap.n_mipmap), 1u);
-                current_copy_region.buffer_offset                      = mip_data_offsets[static_cast<uint32_t>(mipmap_iterator - in_mipmaps_ptr->cbegin()) ];
-                current_copy_region.buffer_row_length                  = 0;
-                current_copy_region.image_offset.x                     = 0;
-                current_copy_region.image_offset.y                     = 0;
-                current_copy_region.image_offset.z                     = 0;
-                current_copy_region.image_subresource.base_array_layer = current_mipmap.n_layer;
-                current_copy_region.image_subresource.layer_count      = current_mipmap.n_layers;
-                current_copy_region.image_subresource.aspect_mask      = current_mipmap.aspect;
-                current_copy_region.image_subresource.mip_level        = current_mipmap.n_mipmap;
-                current_copy_region.image_extent.depth                 = current_mipmap.n_slices;
-                current_copy_region.image_extent.height                = std::max(base_mip_height / (1 << current_mipmap.n_mipmap), 1u);
-                current_copy_region.image_extent.width                 = std::max(base_mip_width  / (1 << current_mipmap.n_mipmap), 1u);
-
-                if (current_copy_region.image_extent.depth < 1)
-                {
-                    current_copy_region.image_extent.depth = 1;
-                }
-
-                if (current_copy_region.image_extent.height < 1)
+                if (needs_ownership_xfer                   &&
+                    out_opt_acquire_barriers_ptr != nullptr)
                 {
-                    current_copy_region.image_extent.height = 1;
-                }
-
-                if (current_copy_region.image_extent.width < 1)
-                {
-                    current_copy_region.image_extent.width = 1;
+                    out_opt_acquire_barriers_ptr->push_back(
+                        Anvil::ImageBarrier(Anvil::AccessFlagBits::NONE, /* source_access_mask */
+                                            in_dst_access_mask,
+                                           *out_new_image_layout_ptr,
+                                            new_layout,
+                                            barrier_src_queue_fam_index,
+                                            barrier_dst_queue_fam_index,
+                                            this,
+                                            in_subresource_range)
+                    );
                 }
 
-                copy_regions.push_back(current_copy_region);
+                *out_new_image_layout_ptr = new_layout;
             }
+        }
+    }
+    temp_cmdbuf_ptr->stop_recording();
 
-            /* Issue the copy ops. */
-            const uint32_t        n_copy_regions                   = static_cast<uint32_t>(copy_regions.size() );
-            static const uint32_t n_max_copy_regions_per_copy_call = 1024;
+    /* Execute the command buffer */
+    {
+        Anvil::CommandBufferBase* cmd_buffer_raw_ptr = temp_cmdbuf_ptr.get();
 
-            for (uint32_t n_copy_region = 0;
-                          n_copy_region < n_copy_regions;
-                          n_copy_region += n_max_copy_regions_per_copy_call)
-            {
-                const uint32_t n_copy_regions_to_use = std::min(n_max_copy_regions_per_copy_call,
-                                                                n_copy_regions - n_copy_region);
-
-                temp_cmdbuf_ptr->record_copy_buffer_to_image(temp_buffer_ptr.get(),
-                                                             this,
-                                                             *out_new_image_layout_ptr,
-                                                             n_copy_regions_to_use,
-                                                            &copy_regions.at(n_copy_region) );
-            }
+        if (in_opt_semaphore_to_signal_ptr != nullptr)
+        {
+            in_queue_ptr->submit(
+                Anvil::SubmitInfo::create_execute_signal(&cmd_buffer_raw_ptr,
+                                                         1,                  /* in_n_cmd_buffers          */
+                                                         1,                  /* in_n_semaphores_to_signal */
+                                                        &in_opt_semaphore_to_signal_ptr,
+                                                         !uses_staging_ring, /* should_block              */
+                                                         staging_allocation.fence_ptr)
+            );
         }
-        temp_cmdbuf_ptr->stop_recording();
-
-        /* Execute the command buffer */
+        else
         {
-            Anvil::CommandBufferBase* cmd_buffer_raw_ptr = temp_cmdbuf_ptr.get();
-
-            universal_queue_ptr->submit(
+            in_queue_ptr->submit(
                 Anvil::SubmitInfo::create_execute(&cmd_buffer_raw_ptr,
-                                                  1,    /* in_n_cmd_buffers */
-                                                  true) /* should_block     */
+                                                  1,                  /* in_n_cmd_buffers */
+                                                  !uses_staging_ring, /* should_block     */
+                                                  staging_allocation.fence_ptr)
             );
         }
     }
-}
+
+    if (uses_staging_ring)
+    {
+        /* The command buffer must outlive the copy op, so hand it over to the ring. */
+        staging_ring_ptr->release(staging_allocation,
+                                  true, /* in_submitted */
+                                  std::move(temp_cmdbuf_ptr) );
+    }
+}
\ No newline at end of file
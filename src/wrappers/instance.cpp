@@ -21,7 +21,9 @@
 //
 #include "misc/debug.h"
 #include "misc/debug_messenger_create_info.h"
+#include "misc/host_allocator.h"
 #include "misc/object_tracker.h"
+#include "misc/time.h"
 #include "wrappers/instance.h"
 #include "wrappers/physical_device.h"
 
@@ -33,12 +35,19 @@ static Anvil::LibraryUniquePtr g_vk_library_ptr;
 
 /** Please see header for specification */
 Anvil::Instance::Instance(Anvil::InstanceCreateInfoUniquePtr in_create_info_ptr)
-    :MTSafetySupportProvider(in_create_info_ptr->is_mt_safe() ),
-     m_api_version          (APIVersion::UNKNOWN),
-     m_debug_messenger_ptr  (Anvil::DebugMessengerUniquePtr(nullptr, std::default_delete<Anvil::DebugMessenger>() )),
-     m_global_layer         (""),
-     m_instance             (VK_NULL_HANDLE)
+    :MTSafetySupportProvider      (in_create_info_ptr->is_mt_safe() ),
+     m_allocation_callbacks_vk_ptr(nullptr),
+     m_api_version                (APIVersion::UNKNOWN),
+     m_debug_messenger_ptr        (Anvil::DebugMessengerUniquePtr(nullptr, std::default_delete<Anvil::DebugMessenger>() )),
+     m_global_layer               (""),
+     m_instance                   (VK_NULL_HANDLE),
+     m_n_active_debug_messengers  (0)
 {
+    if (in_create_info_ptr->get_host_allocator() != nullptr)
+    {
+        m_allocation_callbacks_vk_ptr = in_create_info_ptr->get_host_allocator()->get_allocation_callbacks_vk();
+    }
+
     m_create_info_ptr = std::move(in_create_info_ptr);
 
     Anvil::ObjectTracker::get()->register_object(Anvil::ObjectType::INSTANCE,
@@ -58,7 +67,7 @@ Anvil::Instance::~Instance()
         lock();
         {
             Anvil::Vulkan::vkDestroyInstance(m_instance,
-                                             nullptr /* pAllocator */);
+                                             m_allocation_callbacks_vk_ptr);
         }
         unlock();
 
@@ -150,6 +159,13 @@ void Anvil::Instance::enumerate_instance_layers()
             m_supported_layers.push_back(Anvil::Layer(layer_props[n_layer]) );
 
             layer_ptr = &m_supported_layers[n_layer];
+
+            /* Extensions exposed by individual layers are only of interest if validation has been requested. Each query
+             * loads the layer's library, so skip them otherwise. */
+            if (!is_validation_enabled() )
+            {
+                continue;
+            }
         }
 
         enumerate_layer_extensions(layer_ptr);
@@ -417,9 +433,23 @@ bool Anvil::Instance::init()
     std::vector<const char*>    enabled_layers;
     std::map<std::string, bool> extension_enabled_status;
     bool                        is_device_group_creation_supported = true;
+    uint64_t                    last_phase_end_time_nsec           = 0;
     size_t                      n_instance_layers                  = 0;
     bool                        result                             = false;
     VkResult                    result_vk                          = VK_ERROR_INITIALIZATION_FAILED;
+    Anvil::Time                 timer;
+
+    auto end_startup_phase = [&](const char* in_phase_name)
+    {
+        const uint64_t current_time_nsec = timer.get_time_in_nsec();
+
+        m_startup_phase_timings.push_back(
+            Anvil::StartupPhaseTiming(in_phase_name,
+                                      current_time_nsec - last_phase_end_time_nsec)
+        );
+
+        last_phase_end_time_nsec = current_time_nsec;
+    };
 
     ANVIL_REDUNDANT_VARIABLE(result_vk);
 
@@ -430,9 +460,13 @@ bool Anvil::Instance::init()
         goto end;
     }
 
+    end_startup_phase("Global entry-point initialization");
+
     /* Enumerate available layers */
     enumerate_instance_layers();
 
+    end_startup_phase("Layer enumeration");
+
     /* Determine what extensions we need to request at instance creation time */
     static const char* desired_extensions_with_validation[] =
     {
@@ -660,12 +694,14 @@ bool Anvil::Instance::init()
         create_info.sType                   = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
 
         result_vk = Anvil::Vulkan::vkCreateInstance(&create_info,
-                                                    nullptr, /* pAllocator */
+                                                    m_allocation_callbacks_vk_ptr,
                                                     &m_instance);
 
         anvil_assert_vk_call_succeeded(result_vk);
     }
 
+    end_startup_phase("Instance creation");
+
     /* If this is a VK 1.1 instance, explicitly mark VK1.1 specific extensions as enabled. This is to provide backwards compatibility
      * with VK 1.0 applications which may not be aware that VK 1.0 extensions that were folded into VK 1.1 do not necessarily have to
      * be reported as supported.
@@ -691,9 +727,13 @@ bool Anvil::Instance::init()
 
     init_func_pointers();
 
+    end_startup_phase("Instance entry-point initialization");
+
     if (m_create_info_ptr->get_validation_callback() != nullptr)
     {
         init_debug_callbacks();
+
+        end_startup_phase("Debug callback initialization");
     }
 
     enumerate_physical_devices();
@@ -703,6 +743,8 @@ bool Anvil::Instance::init()
         enumerate_physical_device_groups();
     }
 
+    end_startup_phase("Physical device enumeration");
+
     result = true;
 end:
     return result;
@@ -711,9 +753,12 @@ end:
 /** Initializes debug callback support. */
 void Anvil::Instance::init_debug_callbacks()
 {
+    uint32_t rate_limit_max_messages_per_id = 0;
+    uint32_t rate_limit_period_msec         = 0;
+
     auto create_info_ptr = Anvil::DebugMessengerCreateInfo::create(this,
-                                                                   Anvil::DebugMessageSeverityFlagBits::ERROR_BIT | Anvil::DebugMessageSeverityFlagBits::INFO_BIT | Anvil::DebugMessageSeverityFlagBits::WARNING_BIT,
-                                                                   Anvil::DebugMessageTypeFlagBits::VALIDATION_BIT,
+                                                                   m_create_info_ptr->get_validation_message_severity(),
+                                                                   m_create_info_ptr->get_validation_message_types   (),
                                                                    std::bind(&Anvil::Instance::debug_callback_handler,
                                                                              this,
                                                                              std::placeholders::_1,    /* severity */
@@ -721,6 +766,14 @@ void Anvil::Instance::init_debug_callbacks()
 
     anvil_assert(create_info_ptr != nullptr);
 
+    m_create_info_ptr->get_validation_rate_limit(&rate_limit_max_messages_per_id,
+                                                 &rate_limit_period_msec);
+
+    create_info_ptr->set_async_delivery      (m_create_info_ptr->is_validation_async_delivery_enabled() );
+    create_info_ptr->set_filtered_message_ids(m_create_info_ptr->get_validation_filtered_message_ids () );
+    create_info_ptr->set_rate_limit          (rate_limit_max_messages_per_id,
+                                              rate_limit_period_msec);
+
     m_debug_messenger_ptr = Anvil::DebugMessenger::create(std::move(create_info_ptr) );
     anvil_assert(m_debug_messenger_ptr != nullptr);
 }
@@ -25,6 +25,7 @@
 #include "misc/memory_allocator.h"
 #include "misc/memory_block_create_info.h"
 #include "misc/object_tracker.h"
+#include "misc/perf_counters.h"
 #include "misc/struct_chainer.h"
 #include "wrappers/buffer.h"
 #include "wrappers/device.h"
@@ -39,6 +40,7 @@ Anvil::MemoryBlock::MemoryBlock(Anvil::MemoryBlockCreateInfoUniquePtr in_create_
      m_backend_object                     (nullptr),
      m_gpu_data_map_count                 (0),
      m_gpu_data_ptr                       (nullptr),
+     m_holds_persistent_mapping           (false),
      m_memory                             (VK_NULL_HANDLE),
      m_parent_memory_allocator_backend_ptr(nullptr)
 {
@@ -63,6 +65,12 @@ Anvil::MemoryBlock::~MemoryBlock()
 {
     auto on_release_callback_function = m_create_info_ptr->get_on_release_callback_function();
 
+    /* Drop the persistent mapping, if any, before the memory goes away. */
+    if (m_holds_persistent_mapping.exchange(false) )
+    {
+        close_gpu_memory_access();
+    }
+
     #ifdef _DEBUG
     {
         auto parent_memory_block_ptr = m_create_info_ptr->get_parent_memory_block();
@@ -89,9 +97,9 @@ Anvil::MemoryBlock::~MemoryBlock()
         {
             lock();
             {
-                Anvil::Vulkan::vkFreeMemory(m_create_info_ptr->get_device()->get_device_vk(),
-                                            m_memory,
-                                            nullptr /* pAllocator */);
+                m_create_info_ptr->get_device()->get_dispatch_table().vkFreeMemory(m_create_info_ptr->get_device()->get_device_vk(),
+                                                                                   m_memory,
+                                                                                   m_create_info_ptr->get_device()->get_allocation_callbacks_vk() );
             }
             unlock();
         }
@@ -124,8 +132,8 @@ void Anvil::MemoryBlock::close_gpu_memory_access()
                 else
                 {
                     /* This block will be entered for memory blocks instantiated without a memory allocator */
-                    Anvil::Vulkan::vkUnmapMemory(m_create_info_ptr->get_device()->get_device_vk(),
-                                                 m_memory);
+                    m_create_info_ptr->get_device()->get_dispatch_table().vkUnmapMemory(m_create_info_ptr->get_device()->get_device_vk(),
+                                                                                        m_memory);
                 }
             }
             unlock();
@@ -406,7 +414,8 @@ bool Anvil::MemoryBlock::init(VkResult* out_opt_result)
     {
         const float& memory_priority = m_create_info_ptr->get_memory_priority();
 
-        if (memory_priority != FLT_MAX)
+        if (memory_priority != FLT_MAX                                                       &&
+            m_create_info_ptr->get_device()->get_extension_info()->ext_memory_priority() )
         {
             anvil_assert(memory_priority >= 0.0f && memory_priority <= 1.0f);
 
@@ -464,7 +473,7 @@ bool Anvil::MemoryBlock::init(VkResult* out_opt_result)
                 VkImportMemoryHostPointerInfoEXT handle_info_khr;
 
                 anvil_assert(handle_import_info_ptr->host_ptr != nullptr);
-                anvil_assert(handle_import_info_ptr->handle   == 0);
+                anvil_assert(handle_import_info_ptr->handle   == Anvil::ExternalMemoryHandleImportInfo().handle);
 
                 handle_info_khr.handleType   = static_cast<VkExternalMemoryHandleTypeFlagBitsKHR>(imported_external_memory_handle_type);
                 handle_info_khr.pHostPointer = handle_import_info_ptr->host_ptr;
@@ -512,37 +521,53 @@ bool Anvil::MemoryBlock::init(VkResult* out_opt_result)
         }
     }
 
-    if (m_create_info_ptr->get_device_mask()        != 0                             &&
-        m_create_info_ptr->get_device()->get_type() == Anvil::DeviceType::MULTI_GPU)
     {
-        VkMemoryAllocateFlagsInfoKHR alloc_info_khr;
-
-        alloc_info_khr.deviceMask = m_create_info_ptr->get_device_mask();
+        /* Buffers created with SHADER_DEVICE_ADDRESS usage (eg. acceleration structure storage & scratch buffers) can only
+         * be bound to memory allocated with the DEVICE_ADDRESS flag. Since the block may later be sub-allocated to any
+         * buffer, set the flag for all allocations, as long as VK_KHR_buffer_device_address is enabled. */
+        const bool needs_device_address_flag = m_create_info_ptr->get_device()->get_extension_info()->khr_buffer_device_address();
+        const bool needs_device_mask         = (m_create_info_ptr->get_device_mask()        != 0                             &&
+                                                m_create_info_ptr->get_device()->get_type() == Anvil::DeviceType::MULTI_GPU);
 
-        /* NOTE: Host-mappable memory must not be multi-instance heap and must exist on only one device. */
-        if (((m_create_info_ptr->get_memory_features()                          & Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT) != 0) &&
-             (Utils::count_set_bits                 (alloc_info_khr.deviceMask)                                               >  1) )
+        if (needs_device_address_flag ||
+            needs_device_mask)
         {
-            alloc_info_khr.flags = 0;
-        }
-        else
-        {
-            alloc_info_khr.flags = VK_MEMORY_ALLOCATE_DEVICE_MASK_BIT;
-        }
+            VkMemoryAllocateFlagsInfoKHR alloc_info_khr;
 
-        alloc_info_khr.pNext      = nullptr;
-        alloc_info_khr.sType      = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO_KHR;
+            alloc_info_khr.deviceMask = 0;
+            alloc_info_khr.flags      = 0;
 
-        struct_chainer.append_struct(alloc_info_khr);
+            if (needs_device_mask)
+            {
+                alloc_info_khr.deviceMask = m_create_info_ptr->get_device_mask();
+
+                /* NOTE: Host-mappable memory must not be multi-instance heap and must exist on only one device. */
+                if (!(((m_create_info_ptr->get_memory_features()                          & Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT) != 0) &&
+                       (Utils::count_set_bits                 (alloc_info_khr.deviceMask)                                               >  1) ))
+                {
+                    alloc_info_khr.flags |= VK_MEMORY_ALLOCATE_DEVICE_MASK_BIT;
+                }
+            }
+
+            if (needs_device_address_flag)
+            {
+                alloc_info_khr.flags |= VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR;
+            }
+
+            alloc_info_khr.pNext = nullptr;
+            alloc_info_khr.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO_KHR;
+
+            struct_chainer.append_struct(alloc_info_khr);
+        }
     }
 
     {
         auto chain_ptr = struct_chainer.create_chain();
 
-        result = Anvil::Vulkan::vkAllocateMemory(m_create_info_ptr->get_device()->get_device_vk(),
-                                                 chain_ptr->get_root_struct(),
-                                                 nullptr, /* pAllocator */
-                                                &m_memory);
+        result = m_create_info_ptr->get_device()->get_dispatch_table().vkAllocateMemory(m_create_info_ptr->get_device()->get_device_vk(),
+                                                                                        chain_ptr->get_root_struct(),
+                                                                                        m_create_info_ptr->get_device()->get_allocation_callbacks_vk(),
+                                                                                       &m_memory);
     }
 
     if (out_opt_result != nullptr)
@@ -561,26 +586,39 @@ end:
     return result_bool;
 }
 
+/* Please see header for specification */
+VkDeviceSize Anvil::MemoryBlock::get_committed_size() const
+{
+    const auto   device_ptr        = m_create_info_ptr->get_device();
+    const auto&  memory_type       = device_ptr->get_physical_device_memory_properties().types.at(m_create_info_ptr->get_memory_type_index() );
+    const bool   is_lazily_alloced = ((memory_type.features & Anvil::MemoryFeatureFlagBits::LAZILY_ALLOCATED_BIT) != 0);
+    VkDeviceSize result            = 0;
+
+    anvil_assert(is_lazily_alloced);
+
+    if (is_lazily_alloced)
+    {
+        device_ptr->get_dispatch_table().vkGetDeviceMemoryCommitment(device_ptr->get_device_vk(),
+                                                                     get_memory(),
+                                                                    &result);
+    }
+
+    return result;
+}
+
 /* Please see header for specification */
 bool Anvil::MemoryBlock::intersects(const Anvil::MemoryBlock* in_memory_block_ptr) const
 {
-    bool result = (m_memory == in_memory_block_ptr->m_memory);
+    bool result = false;
 
-    if (result)
+    /* NOTE: Start offsets of derived memory blocks are relative to the start of the underlying memory object. */
+    if (get_memory() == in_memory_block_ptr->get_memory() )
     {
-        const auto size = m_create_info_ptr->get_size();
+        const VkDeviceSize end_offset    = m_start_offset                      + m_create_info_ptr->get_size();
+        const VkDeviceSize in_end_offset = in_memory_block_ptr->m_start_offset + in_memory_block_ptr->m_create_info_ptr->get_size();
 
-        if (!(m_start_offset                             < in_memory_block_ptr->m_start_offset &&
-              m_start_offset + size                      < in_memory_block_ptr->m_start_offset &&
-              in_memory_block_ptr->m_start_offset        < m_start_offset                      &&
-              in_memory_block_ptr->m_start_offset + size < m_start_offset) )
-        {
-            result = true;
-        }
-        else
-        {
-            result = false;
-        }
+        result = (m_start_offset                      < in_end_offset &&
+                  in_memory_block_ptr->m_start_offset < end_offset);
     }
 
     return result;
@@ -632,9 +670,9 @@ bool Anvil::MemoryBlock::map(VkDeviceSize in_start_offset,
                 mapped_memory_range.size = VK_WHOLE_SIZE;
             }
 
-            result_vk = Anvil::Vulkan::vkInvalidateMappedMemoryRanges(m_create_info_ptr->get_device()->get_device_vk(),
-                                                                      1, /* memRangeCount */
-                                                                     &mapped_memory_range);
+            result_vk = m_create_info_ptr->get_device()->get_dispatch_table().vkInvalidateMappedMemoryRanges(m_create_info_ptr->get_device()->get_device_vk(),
+                                                                                                             1, /* memRangeCount */
+                                                                                                            &mapped_memory_range);
             anvil_assert_vk_call_succeeded(result_vk);
         }
 
@@ -649,6 +687,30 @@ end:
     return result;
 }
 
+/** Updates the memory block after the backend has moved the region it covers to a new location.
+ *
+ *  Only supported for root memory blocks which are not mapped at call time.
+ *
+ *  @param in_new_memory       Memory object the region now lives in.
+ *  @param in_new_start_offset Start offset of the region within @param in_new_memory.
+ **/
+void Anvil::MemoryBlock::on_memory_moved(VkDeviceMemory in_new_memory,
+                                         VkDeviceSize   in_new_start_offset)
+{
+    anvil_assert(m_create_info_ptr->get_parent_memory_block() == nullptr);
+    anvil_assert(m_gpu_data_map_count                          == 0);
+
+    lock();
+    {
+        m_create_info_ptr->set_memory_location(in_new_memory,
+                                               in_new_start_offset);
+
+        m_memory       = in_new_memory;
+        m_start_offset = in_new_start_offset;
+    }
+    unlock();
+}
+
 /** Maps the specified region of the underlying memory object into process space and stores the
  *  pointer in m_gpu_data_ptr.
  *
@@ -701,18 +763,26 @@ bool Anvil::MemoryBlock::open_gpu_memory_access()
                  *       less readable. Might want to consider doing this nevertheless one day.
                  *
                  */
-                result_vk = Anvil::Vulkan::vkMapMemory(m_create_info_ptr->get_device()->get_device_vk(),
-                                                       m_memory,
-                                                       0, /* offset */
-                                                       m_create_info_ptr->get_size(),
-                                                       0, /* flags */
-                                                       static_cast<void**>(&m_gpu_data_ptr) );
+                result_vk = m_create_info_ptr->get_device()->get_dispatch_table().vkMapMemory(m_create_info_ptr->get_device()->get_device_vk(),
+                                                                                              m_memory,
+                                                                                              0, /* offset */
+                                                                                              m_create_info_ptr->get_size(),
+                                                                                              0, /* flags */
+                                                                                              static_cast<void**>(&m_gpu_data_ptr) );
             }
         }
         unlock();
 
         anvil_assert_vk_call_succeeded(result_vk);
         result = is_vk_call_successful(result_vk);
+
+        /* Keep one reference for the block's lifetime, so that the memory never gets unmapped by close_gpu_memory_access(). */
+        if ( result                                      &&
+             m_create_info_ptr->is_persistently_mapped() &&
+            !m_holds_persistent_mapping.exchange(true) )
+        {
+            m_gpu_data_map_count.fetch_add(1);
+        }
     }
     else
     {
@@ -772,9 +842,9 @@ bool Anvil::MemoryBlock::read(VkDeviceSize in_start_offset,
                 mapped_memory_range.size = mem_block_size - mapped_memory_range.offset;
             }
 
-            result_vk = Anvil::Vulkan::vkInvalidateMappedMemoryRanges(m_create_info_ptr->get_device()->get_device_vk(),
-                                                                      1, /* memRangeCount */
-                                                                     &mapped_memory_range);
+            result_vk = m_create_info_ptr->get_device()->get_dispatch_table().vkInvalidateMappedMemoryRanges(m_create_info_ptr->get_device()->get_device_vk(),
+                                                                                                             1, /* memRangeCount */
+                                                                                                            &mapped_memory_range);
             anvil_assert_vk_call_succeeded(result_vk);
         }
 
@@ -791,6 +861,32 @@ end:
     return result;
 }
 
+/* Please see header for specification */
+bool Anvil::MemoryBlock::set_priority(float in_priority)
+{
+    const auto device_ptr = m_create_info_ptr->get_device();
+    bool       result     = false;
+
+    anvil_assert(in_priority >= 0.0f && in_priority <= 1.0f);
+
+    if (!device_ptr->get_extension_info()->ext_pageable_device_local_memory() )
+    {
+        anvil_assert(device_ptr->get_extension_info()->ext_pageable_device_local_memory() );
+
+        goto end;
+    }
+
+    device_ptr->get_extension_ext_pageable_device_local_memory_entrypoints().vkSetDeviceMemoryPriorityEXT(device_ptr->get_device_vk(),
+                                                                                                          get_memory(),
+                                                                                                          in_priority);
+
+    m_create_info_ptr->set_memory_priority(in_priority);
+
+    result = true;
+end:
+    return result;
+}
+
 /* Please see header for specification */
 bool Anvil::MemoryBlock::unmap()
 {
@@ -848,6 +944,9 @@ bool Anvil::MemoryBlock::write(VkDeviceSize in_start_offset,
                in_data,
                static_cast<size_t>(in_size));
 
+        Anvil::PerfCounters::increment(Anvil::PerfCounters::Counter::UPLOADED_BYTES,
+                                       in_size);
+
         if ((m_create_info_ptr->get_memory_features() & Anvil::MemoryFeatureFlagBits::HOST_COHERENT_BIT) == 0)
         {
             VkMappedMemoryRange mapped_memory_range;
@@ -870,9 +969,9 @@ bool Anvil::MemoryBlock::write(VkDeviceSize in_start_offset,
                 mapped_memory_range.size = mem_block_size - mapped_memory_range.offset;
             }
 
-            result_vk = Anvil::Vulkan::vkFlushMappedMemoryRanges(m_create_info_ptr->get_device()->get_device_vk(),
-                                                                 1, /* memRangeCount */
-                                                                &mapped_memory_range);
+            result_vk = m_create_info_ptr->get_device()->get_dispatch_table().vkFlushMappedMemoryRanges(m_create_info_ptr->get_device()->get_device_vk(),
+                                                                                                        1, /* memRangeCount */
+                                                                                                       &mapped_memory_range);
             anvil_assert_vk_call_succeeded(result_vk);
         }
 
@@ -136,21 +136,34 @@ bool Anvil::PhysicalDevice::init()
 
         if (m_instance_ptr->get_enabled_extensions_info()->khr_get_physical_device_properties2() )
         {
+            Anvil::StructID                                           acceleration_structure_features_struct_id;
+            Anvil::StructID                                           buffer_device_address_features_struct_id;
+            Anvil::StructID                                           conditional_rendering_features_struct_id;
             Anvil::StructID                                           depth_clip_enable_features_struct_id;
             Anvil::StructID                                           descriptor_indexing_features_struct_id;
+            Anvil::StructID                                           dynamic_rendering_features_struct_id;
+            Anvil::StructID                                           host_image_copy_features_struct_id;
+            Anvil::StructID                                           host_query_reset_features_struct_id;
+            Anvil::StructID                                           imageless_framebuffer_features_struct_id;
             Anvil::StructID                                           inline_uniform_block_features_struct_id;
             Anvil::StructID                                           memory_priority_features_struct_id;
+            Anvil::StructID                                           mesh_shader_features_struct_id;
             const auto&                                               gpdp2_entrypoints                           = m_instance_ptr->get_extension_khr_get_physical_device_properties2_entrypoints();
             Anvil::StructID                                           multiview_features_struct_id;
+            Anvil::StructID                                           pageable_device_local_memory_features_struct_id;
+            Anvil::StructID                                           pipeline_executable_properties_features_struct_id;
             Anvil::StructID                                           protected_memory_features_struct_id;
             Anvil::StructID                                           sampler_ycbcr_conversion_features_struct_id;
             Anvil::StructID                                           scalar_block_layout_features_struct_id;
+            Anvil::StructID                                           shading_rate_image_features_struct_id;
             Anvil::StructID                                           shader_atomic_int64_features_struct_id;
             Anvil::StructID                                           shader_float16_int8_struct_id;
             Anvil::StructID                                           storage_features16_struct_id;
             Anvil::StructID                                           storage_features8_struct_id;
             Anvil::StructChainUniquePtr<VkPhysicalDeviceFeatures2KHR> struct_chain_ptr;
             Anvil::StructChainer<VkPhysicalDeviceFeatures2KHR>        struct_chainer;
+            Anvil::StructID                                           subgroup_size_control_features_struct_id;
+            Anvil::StructID                                           timeline_semaphore_features_struct_id;
             Anvil::StructID                                           transform_feedback_features_struct_id;
             Anvil::StructID                                           variable_pointer_features_struct_id;
             Anvil::StructID                                           vulkan_memory_model_features_struct_id;
@@ -165,6 +178,16 @@ bool Anvil::PhysicalDevice::init()
                 struct_chainer.append_struct(features);
             }
 
+            if (m_extension_info_ptr->get_device_extension_info()->ext_conditional_rendering() )
+            {
+                VkPhysicalDeviceConditionalRenderingFeaturesEXT conditional_rendering_features;
+
+                conditional_rendering_features.pNext = nullptr;
+                conditional_rendering_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_CONDITIONAL_RENDERING_FEATURES_EXT;
+
+                conditional_rendering_features_struct_id = struct_chainer.append_struct(conditional_rendering_features);
+            }
+
             if (m_extension_info_ptr->get_device_extension_info()->ext_depth_clip_enable() )
             {
                 VkPhysicalDeviceDepthClipEnableFeaturesEXT depth_clip_enable_features;
@@ -185,6 +208,26 @@ bool Anvil::PhysicalDevice::init()
                 descriptor_indexing_features_struct_id = struct_chainer.append_struct(descriptor_indexing_features);
             }
 
+            if (m_extension_info_ptr->get_device_extension_info()->ext_host_image_copy() )
+            {
+                VkPhysicalDeviceHostImageCopyFeaturesEXT host_image_copy_features;
+
+                host_image_copy_features.pNext = nullptr;
+                host_image_copy_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_FEATURES_EXT;
+
+                host_image_copy_features_struct_id = struct_chainer.append_struct(host_image_copy_features);
+            }
+
+            if (m_extension_info_ptr->get_device_extension_info()->ext_host_query_reset() )
+            {
+                VkPhysicalDeviceHostQueryResetFeaturesEXT host_query_reset_features;
+
+                host_query_reset_features.pNext = nullptr;
+                host_query_reset_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_QUERY_RESET_FEATURES_EXT;
+
+                host_query_reset_features_struct_id = struct_chainer.append_struct(host_query_reset_features);
+            }
+
             if (m_extension_info_ptr->get_device_extension_info()->ext_inline_uniform_block() )
             {
                 VkPhysicalDeviceInlineUniformBlockFeaturesEXT inline_uniform_block_features;
@@ -205,6 +248,36 @@ bool Anvil::PhysicalDevice::init()
                 memory_priority_features_struct_id = struct_chainer.append_struct(memory_priority_features);
             }
 
+            if (m_extension_info_ptr->get_device_extension_info()->khr_acceleration_structure() )
+            {
+                VkPhysicalDeviceAccelerationStructureFeaturesKHR acceleration_structure_features;
+
+                acceleration_structure_features.pNext = nullptr;
+                acceleration_structure_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR;
+
+                acceleration_structure_features_struct_id = struct_chainer.append_struct(acceleration_structure_features);
+            }
+
+            if (m_extension_info_ptr->get_device_extension_info()->khr_buffer_device_address() )
+            {
+                VkPhysicalDeviceBufferDeviceAddressFeaturesKHR buffer_device_address_features;
+
+                buffer_device_address_features.pNext = nullptr;
+                buffer_device_address_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES_KHR;
+
+                buffer_device_address_features_struct_id = struct_chainer.append_struct(buffer_device_address_features);
+            }
+
+            if (m_extension_info_ptr->get_device_extension_info()->ext_pageable_device_local_memory() )
+            {
+                VkPhysicalDevicePageableDeviceLocalMemoryFeaturesEXT pageable_device_local_memory_features;
+
+                pageable_device_local_memory_features.pNext = nullptr;
+                pageable_device_local_memory_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PAGEABLE_DEVICE_LOCAL_MEMORY_FEATURES_EXT;
+
+                pageable_device_local_memory_features_struct_id = struct_chainer.append_struct(pageable_device_local_memory_features);
+            }
+
             if (m_extension_info_ptr->get_device_extension_info()->ext_scalar_block_layout() )
             {
                 VkPhysicalDeviceScalarBlockLayoutFeaturesEXT scalar_block_layout_features;
@@ -215,6 +288,16 @@ bool Anvil::PhysicalDevice::init()
                 scalar_block_layout_features_struct_id = struct_chainer.append_struct(scalar_block_layout_features);
             }
 
+            if (m_extension_info_ptr->get_device_extension_info()->ext_subgroup_size_control() )
+            {
+                VkPhysicalDeviceSubgroupSizeControlFeaturesEXT subgroup_size_control_features;
+
+                subgroup_size_control_features.pNext = nullptr;
+                subgroup_size_control_features.sType = static_cast<VkStructureType>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_SIZE_CONTROL_FEATURES_EXT);
+
+                subgroup_size_control_features_struct_id = struct_chainer.append_struct(subgroup_size_control_features);
+            }
+
             if (m_extension_info_ptr->get_device_extension_info()->ext_transform_feedback() )
             {
                 VkPhysicalDeviceTransformFeedbackFeaturesEXT transform_feedback_features;
@@ -246,6 +329,26 @@ bool Anvil::PhysicalDevice::init()
                 storage_features8_struct_id = struct_chainer.append_struct(storage_features);
             }
 
+            if (m_extension_info_ptr->get_device_extension_info()->khr_dynamic_rendering() )
+            {
+                VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamic_rendering_features;
+
+                dynamic_rendering_features.pNext = nullptr;
+                dynamic_rendering_features.sType = static_cast<VkStructureType>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR);
+
+                dynamic_rendering_features_struct_id = struct_chainer.append_struct(dynamic_rendering_features);
+            }
+
+            if (m_extension_info_ptr->get_device_extension_info()->khr_imageless_framebuffer() )
+            {
+                VkPhysicalDeviceImagelessFramebufferFeaturesKHR imageless_framebuffer_features;
+
+                imageless_framebuffer_features.pNext = nullptr;
+                imageless_framebuffer_features.sType = static_cast<VkStructureType>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGELESS_FRAMEBUFFER_FEATURES_KHR);
+
+                imageless_framebuffer_features_struct_id = struct_chainer.append_struct(imageless_framebuffer_features);
+            }
+
             if (m_extension_info_ptr->get_device_extension_info()->khr_multiview() ||
                 supports_vk1_1)
             {
@@ -257,6 +360,16 @@ bool Anvil::PhysicalDevice::init()
                 multiview_features_struct_id = struct_chainer.append_struct(multiview_features);
             }
 
+            if (m_extension_info_ptr->get_device_extension_info()->khr_pipeline_executable_properties() )
+            {
+                VkPhysicalDevicePipelineExecutablePropertiesFeaturesKHR pipeline_executable_properties_features;
+
+                pipeline_executable_properties_features.pNext = nullptr;
+                pipeline_executable_properties_features.sType = static_cast<VkStructureType>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PIPELINE_EXECUTABLE_PROPERTIES_FEATURES_KHR);
+
+                pipeline_executable_properties_features_struct_id = struct_chainer.append_struct(pipeline_executable_properties_features);
+            }
+
             if (m_extension_info_ptr->get_device_extension_info()->khr_sampler_ycbcr_conversion() ||
                 supports_vk1_1)
             {
@@ -288,6 +401,16 @@ bool Anvil::PhysicalDevice::init()
                 shader_float16_int8_struct_id = struct_chainer.append_struct(shader_float16_int8_features);
             }
 
+            if (m_extension_info_ptr->get_device_extension_info()->khr_timeline_semaphore() )
+            {
+                VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timeline_semaphore_features;
+
+                timeline_semaphore_features.pNext = nullptr;
+                timeline_semaphore_features.sType = static_cast<VkStructureType>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR);
+
+                timeline_semaphore_features_struct_id = struct_chainer.append_struct(timeline_semaphore_features);
+            }
+
             if (m_extension_info_ptr->get_device_extension_info()->khr_variable_pointers() ||
                 supports_vk1_1)
             {
@@ -309,6 +432,26 @@ bool Anvil::PhysicalDevice::init()
                 vulkan_memory_model_features_struct_id = struct_chainer.append_struct(vmm_features);
             }
 
+            if (m_extension_info_ptr->get_device_extension_info()->nv_mesh_shader() )
+            {
+                VkPhysicalDeviceMeshShaderFeaturesNV mesh_shader_features;
+
+                mesh_shader_features.pNext = nullptr;
+                mesh_shader_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_NV;
+
+                mesh_shader_features_struct_id = struct_chainer.append_struct(mesh_shader_features);
+            }
+
+            if (m_extension_info_ptr->get_device_extension_info()->nv_shading_rate_image() )
+            {
+                VkPhysicalDeviceShadingRateImageFeaturesNV shading_rate_image_features;
+
+                shading_rate_image_features.pNext = nullptr;
+                shading_rate_image_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADING_RATE_IMAGE_FEATURES_NV;
+
+                shading_rate_image_features_struct_id = struct_chainer.append_struct(shading_rate_image_features);
+            }
+
             if (supports_vk1_1)
             {
                 VkPhysicalDeviceProtectedMemoryFeatures protected_mem_features;
@@ -327,6 +470,21 @@ bool Anvil::PhysicalDevice::init()
 
             /* Cache the results */
 
+            if (conditional_rendering_features_struct_id.is_valid() )
+            {
+                m_ext_conditional_rendering_features_ptr.reset(
+                    new EXTConditionalRenderingFeatures(*struct_chain_ptr->get_struct_with_id<VkPhysicalDeviceConditionalRenderingFeaturesEXT>(conditional_rendering_features_struct_id) )
+                );
+
+                if (m_ext_conditional_rendering_features_ptr == nullptr)
+                {
+                    anvil_assert(m_ext_conditional_rendering_features_ptr != nullptr);
+
+                    result = false;
+                    goto end;
+                }
+            }
+
             if (depth_clip_enable_features_struct_id.is_valid() )
             {
                 m_ext_depth_clip_enable_features_ptr.reset(
@@ -357,6 +515,36 @@ bool Anvil::PhysicalDevice::init()
                 }
             }
 
+            if (host_image_copy_features_struct_id.is_valid() )
+            {
+                m_ext_host_image_copy_features_ptr.reset(
+                    new EXTHostImageCopyFeatures(*struct_chain_ptr->get_struct_with_id<VkPhysicalDeviceHostImageCopyFeaturesEXT>(host_image_copy_features_struct_id) )
+                );
+
+                if (m_ext_host_image_copy_features_ptr == nullptr)
+                {
+                    anvil_assert(m_ext_host_image_copy_features_ptr != nullptr);
+
+                    result = false;
+                    goto end;
+                }
+            }
+
+            if (host_query_reset_features_struct_id.is_valid() )
+            {
+                m_ext_host_query_reset_features_ptr.reset(
+                    new EXTHostQueryResetFeatures(*struct_chain_ptr->get_struct_with_id<VkPhysicalDeviceHostQueryResetFeaturesEXT>(host_query_reset_features_struct_id) )
+                );
+
+                if (m_ext_host_query_reset_features_ptr == nullptr)
+                {
+                    anvil_assert(m_ext_host_query_reset_features_ptr != nullptr);
+
+                    result = false;
+                    goto end;
+                }
+            }
+
             if (inline_uniform_block_features_struct_id.is_valid() )
             {
                 m_ext_inline_uniform_block_features_ptr.reset(
@@ -372,6 +560,36 @@ bool Anvil::PhysicalDevice::init()
                 }
             }
 
+            if (dynamic_rendering_features_struct_id.is_valid() )
+            {
+                m_khr_dynamic_rendering_features_ptr.reset(
+                    new KHRDynamicRenderingFeatures(*struct_chain_ptr->get_struct_with_id<VkPhysicalDeviceDynamicRenderingFeaturesKHR>(dynamic_rendering_features_struct_id) )
+                );
+
+                if (m_khr_dynamic_rendering_features_ptr == nullptr)
+                {
+                    anvil_assert(m_khr_dynamic_rendering_features_ptr != nullptr);
+
+                    result = false;
+                    goto end;
+                }
+            }
+
+            if (imageless_framebuffer_features_struct_id.is_valid() )
+            {
+                m_khr_imageless_framebuffer_features_ptr.reset(
+                    new KHRImagelessFramebufferFeatures(*struct_chain_ptr->get_struct_with_id<VkPhysicalDeviceImagelessFramebufferFeaturesKHR>(imageless_framebuffer_features_struct_id) )
+                );
+
+                if (m_khr_imageless_framebuffer_features_ptr == nullptr)
+                {
+                    anvil_assert(m_khr_imageless_framebuffer_features_ptr != nullptr);
+
+                    result = false;
+                    goto end;
+                }
+            }
+
             if (multiview_features_struct_id.is_valid() )
             {
                 m_khr_multiview_features_ptr.reset(
@@ -387,6 +605,21 @@ bool Anvil::PhysicalDevice::init()
                 }
             }
 
+            if (pipeline_executable_properties_features_struct_id.is_valid() )
+            {
+                m_khr_pipeline_executable_properties_features_ptr.reset(
+                    new KHRPipelineExecutablePropertiesFeatures(*struct_chain_ptr->get_struct_with_id<VkPhysicalDevicePipelineExecutablePropertiesFeaturesKHR>(pipeline_executable_properties_features_struct_id) )
+                );
+
+                if (m_khr_pipeline_executable_properties_features_ptr == nullptr)
+                {
+                    anvil_assert(m_khr_pipeline_executable_properties_features_ptr != nullptr);
+
+                    result = false;
+                    goto end;
+                }
+            }
+
             if (sampler_ycbcr_conversion_features_struct_id.is_valid() )
             {
                 m_khr_sampler_ycbcr_conversion_features_ptr.reset(
@@ -432,6 +665,36 @@ bool Anvil::PhysicalDevice::init()
                 }
             }
 
+            if (timeline_semaphore_features_struct_id.is_valid() )
+            {
+                m_khr_timeline_semaphore_features_ptr.reset(
+                    new KHRTimelineSemaphoreFeatures(*struct_chain_ptr->get_struct_with_id<VkPhysicalDeviceTimelineSemaphoreFeaturesKHR>(timeline_semaphore_features_struct_id) )
+                );
+
+                if (m_khr_timeline_semaphore_features_ptr == nullptr)
+                {
+                    anvil_assert(m_khr_timeline_semaphore_features_ptr != nullptr);
+
+                    result = false;
+                    goto end;
+                }
+            }
+
+            if (subgroup_size_control_features_struct_id.is_valid() )
+            {
+                m_ext_subgroup_size_control_features_ptr.reset(
+                    new EXTSubgroupSizeControlFeatures(*struct_chain_ptr->get_struct_with_id<VkPhysicalDeviceSubgroupSizeControlFeaturesEXT>(subgroup_size_control_features_struct_id) )
+                );
+
+                if (m_ext_subgroup_size_control_features_ptr == nullptr)
+                {
+                    anvil_assert(m_ext_subgroup_size_control_features_ptr != nullptr);
+
+                    result = false;
+                    goto end;
+                }
+            }
+
             if (transform_feedback_features_struct_id.is_valid() )
             {
                 m_ext_transform_feedback_features_ptr.reset(
@@ -492,6 +755,51 @@ bool Anvil::PhysicalDevice::init()
                 }
             }
 
+            if (pageable_device_local_memory_features_struct_id.is_valid() )
+            {
+                m_ext_pageable_device_local_memory_features_ptr.reset(
+                    new EXTPageableDeviceLocalMemoryFeatures(*struct_chain_ptr->get_struct_with_id<VkPhysicalDevicePageableDeviceLocalMemoryFeaturesEXT>(pageable_device_local_memory_features_struct_id) )
+                );
+
+                if (m_ext_pageable_device_local_memory_features_ptr == nullptr)
+                {
+                    anvil_assert(m_ext_pageable_device_local_memory_features_ptr != nullptr);
+
+                    result = false;
+                    goto end;
+                }
+            }
+
+            if (acceleration_structure_features_struct_id.is_valid() )
+            {
+                m_khr_acceleration_structure_features_ptr.reset(
+                    new KHRAccelerationStructureFeatures(*struct_chain_ptr->get_struct_with_id<VkPhysicalDeviceAccelerationStructureFeaturesKHR>(acceleration_structure_features_struct_id) )
+                );
+
+                if (m_khr_acceleration_structure_features_ptr == nullptr)
+                {
+                    anvil_assert(m_khr_acceleration_structure_features_ptr != nullptr);
+
+                    result = false;
+                    goto end;
+                }
+            }
+
+            if (buffer_device_address_features_struct_id.is_valid() )
+            {
+                m_khr_buffer_device_address_features_ptr.reset(
+                    new KHRBufferDeviceAddressFeatures(*struct_chain_ptr->get_struct_with_id<VkPhysicalDeviceBufferDeviceAddressFeaturesKHR>(buffer_device_address_features_struct_id) )
+                );
+
+                if (m_khr_buffer_device_address_features_ptr == nullptr)
+                {
+                    anvil_assert(m_khr_buffer_device_address_features_ptr != nullptr);
+
+                    result = false;
+                    goto end;
+                }
+            }
+
             if (shader_float16_int8_struct_id.is_valid() )
             {
                 m_khr_float16_int8_features_ptr.reset(
@@ -537,6 +845,36 @@ bool Anvil::PhysicalDevice::init()
                 }
             }
 
+            if (mesh_shader_features_struct_id.is_valid() )
+            {
+                m_nv_mesh_shader_features_ptr.reset(
+                    new NVMeshShaderFeatures(*struct_chain_ptr->get_struct_with_id<VkPhysicalDeviceMeshShaderFeaturesNV>(mesh_shader_features_struct_id) )
+                );
+
+                if (m_nv_mesh_shader_features_ptr == nullptr)
+                {
+                    anvil_assert(m_nv_mesh_shader_features_ptr != nullptr);
+
+                    result = false;
+                    goto end;
+                }
+            }
+
+            if (shading_rate_image_features_struct_id.is_valid() )
+            {
+                m_nv_shading_rate_image_features_ptr.reset(
+                    new NVShadingRateImageFeatures(*struct_chain_ptr->get_struct_with_id<VkPhysicalDeviceShadingRateImageFeaturesNV>(shading_rate_image_features_struct_id) )
+                );
+
+                if (m_nv_shading_rate_image_features_ptr == nullptr)
+                {
+                    anvil_assert(m_nv_shading_rate_image_features_ptr != nullptr);
+
+                    result = false;
+                    goto end;
+                }
+            }
+
             if (supports_vk1_1)
             {
                 const auto protected_memory_features = *struct_chain_ptr->get_struct_with_id<VkPhysicalDeviceProtectedMemoryFeatures>(protected_memory_features_struct_id);
@@ -569,20 +907,33 @@ bool Anvil::PhysicalDevice::init()
 
         m_features = Anvil::PhysicalDeviceFeatures(m_core_features_vk10_ptr.get                   (),
                                                    m_core_features_vk11_ptr.get                   (),
+                                                   m_ext_conditional_rendering_features_ptr.get   (),
                                                    m_ext_depth_clip_enable_features_ptr.get       (),
                                                    m_ext_descriptor_indexing_features_ptr.get     (),
+                                                   m_ext_host_image_copy_features_ptr.get         (),
+                                                   m_ext_host_query_reset_features_ptr.get        (),
                                                    m_ext_inline_uniform_block_features_ptr.get    (),
                                                    m_ext_scalar_block_layout_features_ptr.get     (),
+                                                   m_ext_subgroup_size_control_features_ptr.get   (),
                                                    m_ext_transform_feedback_features_ptr.get      (),
                                                    m_ext_memory_priority_features_ptr.get         (),
+                                                   m_ext_pageable_device_local_memory_features_ptr.get(),
                                                    m_khr_16_bit_storage_features_ptr.get          (),
                                                    m_khr_8_bit_storage_features_ptr.get           (),
+                                                   m_khr_acceleration_structure_features_ptr.get  (),
+                                                   m_khr_buffer_device_address_features_ptr.get   (),
+                                                   m_khr_dynamic_rendering_features_ptr.get       (),
                                                    m_khr_float16_int8_features_ptr.get            (),
+                                                   m_khr_imageless_framebuffer_features_ptr.get   (),
                                                    m_khr_multiview_features_ptr.get               (),
+                                                   m_khr_pipeline_executable_properties_features_ptr.get(),
                                                    m_khr_sampler_ycbcr_conversion_features_ptr.get(),
                                                    m_khr_shader_atomic_int64_features_ptr.get     (),
+                                                   m_khr_timeline_semaphore_features_ptr.get      (),
                                                    m_khr_variable_pointer_features_ptr.get        (),
-                                                   m_khr_vulkan_memory_model_features_ptr.get     () );
+                                                   m_khr_vulkan_memory_model_features_ptr.get     (),
+                                                   m_nv_mesh_shader_features_ptr.get              (),
+                                                   m_nv_shading_rate_image_features_ptr.get       () );
     }
 
     /* Retrieve device layers */
@@ -667,6 +1018,7 @@ bool Anvil::PhysicalDevice::init()
         Anvil::StructChainUniquePtr<VkPhysicalDeviceProperties2KHR> struct_chain_ptr;
         Anvil::StructChainer<VkPhysicalDeviceProperties2KHR>        struct_chainer;
         Anvil::StructID                                             subgroup_props_struct_id;
+        Anvil::StructID                                             subgroup_size_control_props_struct_id;
         Anvil::StructID                                             transform_feedback_props_struct_id;
         Anvil::StructID                                             vertex_attribute_divisor_props_struct_id;
 
@@ -775,6 +1127,16 @@ bool Anvil::PhysicalDevice::init()
             sampler_filter_minmax_props_struct_id = struct_chainer.append_struct(sampler_filter_minmax_properties);
         }
 
+        if (m_extension_info_ptr->get_device_extension_info()->ext_subgroup_size_control() )
+        {
+            VkPhysicalDeviceSubgroupSizeControlPropertiesEXT subgroup_size_control_properties;
+
+            subgroup_size_control_properties.pNext = nullptr;
+            subgroup_size_control_properties.sType = static_cast<VkStructureType>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_SIZE_CONTROL_PROPERTIES_EXT);
+
+            subgroup_size_control_props_struct_id = struct_chainer.append_struct(subgroup_size_control_properties);
+        }
+
         if (m_extension_info_ptr->get_device_extension_info()->ext_transform_feedback() )
         {
             VkPhysicalDeviceTransformFeedbackPropertiesEXT transform_feedback_properties;
@@ -1116,6 +1478,21 @@ bool Anvil::PhysicalDevice::init()
             }
         }
 
+        if (subgroup_size_control_props_struct_id.is_valid() )
+        {
+            m_ext_subgroup_size_control_properties_ptr.reset(
+                new EXTSubgroupSizeControlProperties(*struct_chain_ptr->get_struct_with_id<VkPhysicalDeviceSubgroupSizeControlPropertiesEXT>(subgroup_size_control_props_struct_id) )
+            );
+
+            if (m_ext_subgroup_size_control_properties_ptr == nullptr)
+            {
+                anvil_assert(m_ext_subgroup_size_control_properties_ptr != nullptr);
+
+                result = false;
+                goto end;
+            }
+        }
+
         if (transform_feedback_props_struct_id.is_valid() )
         {
             m_ext_transform_feedback_properties_ptr.reset(
@@ -1157,6 +1534,7 @@ bool Anvil::PhysicalDevice::init()
                                                    m_ext_pci_bus_info_ptr.get                                              (),
                                                    m_ext_sample_locations_properties_ptr.get                               (),
                                                    m_ext_sampler_filter_minmax_properties_ptr.get                          (),
+                                                   m_ext_subgroup_size_control_properties_ptr.get                          (),
                                                    m_ext_transform_feedback_properties_ptr.get                             (),
                                                    m_ext_vertex_attribute_divisor_properties_ptr.get                       (),
                                                    m_khr_depth_stencil_resolve_properties_ptr.get                          (),
@@ -1210,14 +1588,15 @@ Anvil::MemoryBudget Anvil::PhysicalDevice::get_available_memory_budget() const
         !m_extension_info_ptr->get_device_extension_info()->ext_memory_budget              ())
     {
         anvil_assert_fail();
+
+        return Anvil::MemoryBudget();
     }
 
-    const auto&                                                       gpdp2_entrypoints                  = m_instance_ptr->get_extension_khr_get_physical_device_properties2_entrypoints();
-    Anvil::StructID                                                   memory_budget_properties_struct_id;
-    VkPhysicalDeviceMemoryBudgetPropertiesEXT                         memory_budget_properties;
-    VkPhysicalDeviceMemoryProperties2KHR                              memory_properties2;
-    Anvil::StructChainer<VkPhysicalDeviceMemoryProperties2KHR>        struct_chainer;
-    Anvil::StructChainUniquePtr<VkPhysicalDeviceMemoryProperties2KHR> struct_chain_ptr;
+    const auto&                                                            gpdp2_entrypoints                  = m_instance_ptr->get_extension_khr_get_physical_device_properties2_entrypoints();
+    Anvil::StructID                                                        memory_budget_properties_struct_id;
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT                              memory_budget_properties;
+    VkPhysicalDeviceMemoryProperties2KHR                                   memory_properties2;
+    Anvil::InlineStructChainer<VkPhysicalDeviceMemoryProperties2KHR, 1024> struct_chainer;
 
     memory_properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
     memory_properties2.pNext = nullptr;
@@ -1228,12 +1607,10 @@ Anvil::MemoryBudget Anvil::PhysicalDevice::get_available_memory_budget() const
     struct_chainer.append_struct(memory_properties2);
     memory_budget_properties_struct_id = struct_chainer.append_struct(memory_budget_properties);
 
-    struct_chain_ptr = struct_chainer.create_chain();
-
     gpdp2_entrypoints.vkGetPhysicalDeviceMemoryProperties2KHR(m_physical_device,
-                                                              struct_chain_ptr->get_root_struct());
+                                                              struct_chainer.get_root_struct());
 
-    return MemoryBudget(*struct_chain_ptr->get_struct_with_id<VkPhysicalDeviceMemoryBudgetPropertiesEXT>(memory_budget_properties_struct_id));
+    return MemoryBudget(*struct_chainer.get_struct_with_id<VkPhysicalDeviceMemoryBudgetPropertiesEXT>(memory_budget_properties_struct_id));
 }
 
 bool Anvil::PhysicalDevice::get_buffer_properties(const Anvil::BufferPropertiesQuery& in_query,
@@ -1323,6 +1700,213 @@ end:
 }
 
 Anvil::FormatProperties Anvil::PhysicalDevice::get_format_properties(Anvil::Format in_format) const
+{
+    Anvil::FormatProperties result;
+
+    {
+        std::unique_lock<std::mutex> lock    (m_format_properties_cache_mutex);
+        auto                         cache_it(m_format_properties_cache.find(in_format) );
+
+        if (cache_it != m_format_properties_cache.end() )
+        {
+            return cache_it->second;
+        }
+    }
+
+    /* Do not hold the lock while the driver is being queried. Threads racing for the same format
+     * are going to retrieve identical data, so whichever insertion wins is fine. */
+    result = query_format_properties(in_format);
+
+    {
+        std::unique_lock<std::mutex> lock(m_format_properties_cache_mutex);
+
+        m_format_properties_cache.emplace(in_format,
+                                          result);
+    }
+
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::PhysicalDevice::get_image_format_properties(const ImageFormatPropertiesQuery& in_query,
+                                                        Anvil::ImageFormatProperties*     out_opt_result_ptr) const
+{
+    Anvil::ImageFormatProperties properties;
+    bool                         result     = false;
+
+    {
+        std::unique_lock<std::mutex> lock    (m_image_format_properties_cache_mutex);
+        auto                         cache_it(m_image_format_properties_cache.find(in_query) );
+
+        if (cache_it != m_image_format_properties_cache.end() )
+        {
+            if (cache_it->second.is_supported &&
+                out_opt_result_ptr != nullptr)
+            {
+                *out_opt_result_ptr = cache_it->second.properties;
+            }
+
+            return cache_it->second.is_supported;
+        }
+    }
+
+    /* Same as in get_format_properties(), the driver is queried without holding the lock. */
+    result = query_image_format_properties(in_query,
+                                          &properties);
+
+    {
+        std::unique_lock<std::mutex> lock(m_image_format_properties_cache_mutex);
+
+        m_image_format_properties_cache.emplace(in_query,
+                                                ImageFormatPropertiesCacheEntry(result,
+                                                                                properties) );
+    }
+
+    if (result                      &&
+        out_opt_result_ptr != nullptr)
+    {
+        *out_opt_result_ptr = properties;
+    }
+
+    return result;
+}
+
+/* Please see header for specification */
+std::size_t Anvil::PhysicalDevice::ImageFormatPropertiesQueryHasher::operator()(const ImageFormatPropertiesQuery& in_query) const
+{
+    std::size_t result = static_cast<std::size_t>(in_query.format);
+
+    result = result * 31 + static_cast<std::size_t>(in_query.image_type);
+    result = result * 31 + static_cast<std::size_t>(in_query.tiling);
+    result = result * 31 + static_cast<std::size_t>(in_query.usage_flags.get_vk () );
+    result = result * 31 + static_cast<std::size_t>(in_query.create_flags.get_vk() );
+    result = result * 31 + static_cast<std::size_t>(in_query.external_memory_handle_type);
+
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::PhysicalDevice::get_semaphore_properties(const Anvil::SemaphorePropertiesQuery& in_query,
+                                                     Anvil::SemaphoreProperties*            out_opt_result_ptr) const
+{
+    const Anvil::ExtensionKHRExternalSemaphoreCapabilitiesEntrypoints* entrypoints_ptr = nullptr;
+    Anvil::StructChainer<VkPhysicalDeviceExternalSemaphoreInfoKHR>     struct_chainer;
+    VkExternalSemaphorePropertiesKHR                                   result_struct;
+    bool                                                               result          = false;
+
+    if (!m_instance_ptr->get_enabled_extensions_info()->khr_external_semaphore_capabilities() )
+    {
+        anvil_assert(m_instance_ptr->get_enabled_extensions_info()->khr_external_semaphore_capabilities() );
+
+        goto end;
+    }
+    else
+    {
+        entrypoints_ptr = &m_instance_ptr->get_extension_khr_external_semaphore_capabilities_entrypoints();
+    }
+
+    {
+        VkPhysicalDeviceExternalSemaphoreInfoKHR root_struct;
+
+        root_struct.handleType = static_cast<VkExternalSemaphoreHandleTypeFlagBitsKHR>(in_query.external_semaphore_handle_type);
+        root_struct.pNext      = nullptr;
+        root_struct.sType      = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_SEMAPHORE_INFO_KHR;
+
+        struct_chainer.append_struct(root_struct);
+    }
+
+    result_struct.pNext = nullptr;
+    result_struct.sType = VK_STRUCTURE_TYPE_EXTERNAL_SEMAPHORE_PROPERTIES_KHR;
+
+    entrypoints_ptr->vkGetPhysicalDeviceExternalSemaphorePropertiesKHR(m_physical_device,
+                                                                       struct_chainer.create_chain()->get_root_struct(),
+                                                                      &result_struct);
+
+    if (out_opt_result_ptr != nullptr)
+    {
+        *out_opt_result_ptr = std::move(Anvil::SemaphoreProperties(ExternalSemaphoreProperties(result_struct) ));
+    }
+
+    /* All done */
+    result = true;
+
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::PhysicalDevice::get_sparse_image_format_properties(Anvil::Format                                   in_format,
+                                                               Anvil::ImageType                                in_type,
+                                                               Anvil::SampleCountFlagBits                      in_sample_count,
+                                                               Anvil::ImageUsageFlags                          in_usage,
+                                                               Anvil::ImageTiling                              in_tiling,
+                                                               std::vector<Anvil::SparseImageFormatProperties>& out_result) const
+{
+    /* TODO: It might be a good idea to cache the retrieved properties */
+    uint32_t n_properties = 0;
+
+    out_result.clear();
+
+    Anvil::Vulkan::vkGetPhysicalDeviceSparseImageFormatProperties(m_physical_device,
+                                                                  static_cast<VkFormat>   (in_format),
+                                                                  static_cast<VkImageType>(in_type),
+                                                                  static_cast<VkSampleCountFlagBits>(in_sample_count),
+                                                                  in_usage.get_vk(),
+                                                                  static_cast<VkImageTiling>(in_tiling),
+                                                                 &n_properties,
+                                                                  nullptr); /* pProperties */
+
+    if (n_properties > 0)
+    {
+        out_result.resize(n_properties);
+
+        Anvil::Vulkan::vkGetPhysicalDeviceSparseImageFormatProperties(m_physical_device,
+                                                                      static_cast<VkFormat>             (in_format),
+                                                                      static_cast<VkImageType>          (in_type),
+                                                                      static_cast<VkSampleCountFlagBits>(in_sample_count),
+                                                                      in_usage.get_vk(),
+                                                                      static_cast<VkImageTiling>(in_tiling),
+                                                                     &n_properties,
+                                                                      reinterpret_cast<VkSparseImageFormatProperties*>(&out_result[0]) );
+    }
+
+    return true;
+}
+
+/* Please see header for specification */
+bool Anvil::PhysicalDevice::is_device_extension_supported(const std::string& in_extension_name) const
+{
+    anvil_assert(m_extension_info_ptr != nullptr);
+
+    return m_extension_info_ptr->get_device_extension_info()->by_name(in_extension_name);
+}
+
+/* Please see header for specification */
+bool Anvil::PhysicalDevice::is_layer_supported(const std::string& in_layer_name) const
+{
+    return std::find(m_layers .begin(),
+                     m_layers.end(),
+                     in_layer_name) != m_layers.end();
+}
+
+/* Please see header for specification */
+void Anvil::PhysicalDevice::prewarm_format_capability_cache(const std::vector<ImageFormatPropertiesQuery>& in_image_format_queries) const
+{
+    for (uint32_t n_format = static_cast<uint32_t>(VK_FORMAT_R4G4_UNORM_PACK8);
+                  n_format <= static_cast<uint32_t>(VK_FORMAT_ASTC_12x12_SRGB_BLOCK);
+                ++n_format)
+    {
+        get_format_properties(static_cast<Anvil::Format>(n_format) );
+    }
+
+    for (const auto& current_query : in_image_format_queries)
+    {
+        get_image_format_properties(current_query);
+    }
+}
+
+/* Please see header for specification */
+Anvil::FormatProperties Anvil::PhysicalDevice::query_format_properties(Anvil::Format in_format) const
 {
     VkFormatProperties core_vk10_format_props;
 
@@ -1334,10 +1918,9 @@ Anvil::FormatProperties Anvil::PhysicalDevice::get_format_properties(Anvil::Form
 }
 
 /* Please see header for specification */
-bool Anvil::PhysicalDevice::get_image_format_properties(const ImageFormatPropertiesQuery& in_query,
-                                                        Anvil::ImageFormatProperties*     out_opt_result_ptr) const
+bool Anvil::PhysicalDevice::query_image_format_properties(const ImageFormatPropertiesQuery& in_query,
+                                                          Anvil::ImageFormatProperties*     out_result_ptr) const
 {
-    VkFormatProperties                                     core_vk10_format_props;
     VkImageFormatProperties                                core_vk10_image_format_properties;
     Anvil::ExternalMemoryProperties                        external_handle_props;
     const Anvil::ExtensionKHRGetPhysicalDeviceProperties2* gpdp2_entrypoints_ptr                     = nullptr;
@@ -1352,10 +1935,6 @@ bool Anvil::PhysicalDevice::get_image_format_properties(const ImageFormatPropert
     }
 
     /* Retrieve core VK1.0 information first. */
-    Anvil::Vulkan::vkGetPhysicalDeviceFormatProperties(m_physical_device,
-                                                       static_cast<VkFormat>(in_query.format),
-                                                      &core_vk10_format_props);
-
     if (Anvil::Vulkan::vkGetPhysicalDeviceImageFormatProperties(m_physical_device,
                                                                 static_cast<VkFormat>     (in_query.format),
                                                                 static_cast<VkImageType>  (in_query.image_type),
@@ -1496,9 +2075,9 @@ bool Anvil::PhysicalDevice::get_image_format_properties(const ImageFormatPropert
         }
     }
 
-    if (out_opt_result_ptr != nullptr)
+    if (out_result_ptr != nullptr)
     {
-        *out_opt_result_ptr = Anvil::ImageFormatProperties(core_vk10_image_format_properties,
+        *out_result_ptr = Anvil::ImageFormatProperties(core_vk10_image_format_properties,
                                                            supports_amd_texture_gather_bias_lod,
                                                            external_handle_props,
                                                            valid_stencil_image_usage_aspect_flags,
@@ -1510,110 +2089,6 @@ end:
     return result;
 }
 
-/* Please see header for specification */
-bool Anvil::PhysicalDevice::get_semaphore_properties(const Anvil::SemaphorePropertiesQuery& in_query,
-                                                     Anvil::SemaphoreProperties*            out_opt_result_ptr) const
-{
-    const Anvil::ExtensionKHRExternalSemaphoreCapabilitiesEntrypoints* entrypoints_ptr = nullptr;
-    Anvil::StructChainer<VkPhysicalDeviceExternalSemaphoreInfoKHR>     struct_chainer;
-    VkExternalSemaphorePropertiesKHR                                   result_struct;
-    bool                                                               result          = false;
-
-    if (!m_instance_ptr->get_enabled_extensions_info()->khr_external_semaphore_capabilities() )
-    {
-        anvil_assert(m_instance_ptr->get_enabled_extensions_info()->khr_external_semaphore_capabilities() );
-
-        goto end;
-    }
-    else
-    {
-        entrypoints_ptr = &m_instance_ptr->get_extension_khr_external_semaphore_capabilities_entrypoints();
-    }
-
-    {
-        VkPhysicalDeviceExternalSemaphoreInfoKHR root_struct;
-
-        root_struct.handleType = static_cast<VkExternalSemaphoreHandleTypeFlagBitsKHR>(in_query.external_semaphore_handle_type);
-        root_struct.pNext      = nullptr;
-        root_struct.sType      = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_SEMAPHORE_INFO_KHR;
-
-        struct_chainer.append_struct(root_struct);
-    }
-
-    result_struct.pNext = nullptr;
-    result_struct.sType = VK_STRUCTURE_TYPE_EXTERNAL_SEMAPHORE_PROPERTIES_KHR;
-
-    entrypoints_ptr->vkGetPhysicalDeviceExternalSemaphorePropertiesKHR(m_physical_device,
-                                                                       struct_chainer.create_chain()->get_root_struct(),
-                                                                      &result_struct);
-
-    if (out_opt_result_ptr != nullptr)
-    {
-        *out_opt_result_ptr = std::move(Anvil::SemaphoreProperties(ExternalSemaphoreProperties(result_struct) ));
-    }
-
-    /* All done */
-    result = true;
-
-end:
-    return result;
-}
-
-/* Please see header for specification */
-bool Anvil::PhysicalDevice::get_sparse_image_format_properties(Anvil::Format                                   in_format,
-                                                               Anvil::ImageType                                in_type,
-                                                               Anvil::SampleCountFlagBits                      in_sample_count,
-                                                               Anvil::ImageUsageFlags                          in_usage,
-                                                               Anvil::ImageTiling                              in_tiling,
-                                                               std::vector<Anvil::SparseImageFormatProperties>& out_result) const
-{
-    /* TODO: It might be a good idea to cache the retrieved properties */
-    uint32_t n_properties = 0;
-
-    out_result.clear();
-
-    Anvil::Vulkan::vkGetPhysicalDeviceSparseImageFormatProperties(m_physical_device,
-                                                                  static_cast<VkFormat>   (in_format),
-                                                                  static_cast<VkImageType>(in_type),
-                                                                  static_cast<VkSampleCountFlagBits>(in_sample_count),
-                                                                  in_usage.get_vk(),
-                                                                  static_cast<VkImageTiling>(in_tiling),
-                                                                 &n_properties,
-                                                                  nullptr); /* pProperties */
-
-    if (n_properties > 0)
-    {
-        out_result.resize(n_properties);
-
-        Anvil::Vulkan::vkGetPhysicalDeviceSparseImageFormatProperties(m_physical_device,
-                                                                      static_cast<VkFormat>             (in_format),
-                                                                      static_cast<VkImageType>          (in_type),
-                                                                      static_cast<VkSampleCountFlagBits>(in_sample_count),
-                                                                      in_usage.get_vk(),
-                                                                      static_cast<VkImageTiling>(in_tiling),
-                                                                     &n_properties,
-                                                                      reinterpret_cast<VkSparseImageFormatProperties*>(&out_result[0]) );
-    }
-
-    return true;
-}
-
-/* Please see header for specification */
-bool Anvil::PhysicalDevice::is_device_extension_supported(const std::string& in_extension_name) const
-{
-    anvil_assert(m_extension_info_ptr != nullptr);
-
-    return m_extension_info_ptr->get_device_extension_info()->by_name(in_extension_name);
-}
-
-/* Please see header for specification */
-bool Anvil::PhysicalDevice::is_layer_supported(const std::string& in_layer_name) const
-{
-    return std::find(m_layers .begin(),
-                     m_layers.end(),
-                     in_layer_name) != m_layers.end();
-}
-
 /* Adjusts the device group index for this physical device.
  *
  * @param new_device_group_index New device group index to assign. Must not be 0.
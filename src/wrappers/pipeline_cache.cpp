@@ -21,9 +21,28 @@
 //
 
 #include "misc/debug.h"
+#include "misc/io.h"
 #include "misc/object_tracker.h"
 #include "wrappers/device.h"
 #include "wrappers/pipeline_cache.h"
+#include <cstdio>
+#include <cstring>
+
+/* miniz is compiled into dummy_window.cpp. Only pull in the declarations here. */
+#define MINIZ_HEADER_FILE_ONLY
+#define MINIZ_NO_ZLIB_COMPATIBLE_NAMES
+
+#include "miniz/miniz.c"
+
+/* "ANPC" */
+#define ANVIL_PIPELINE_CACHE_FILE_MAGIC   (0x43504E41u)
+#define ANVIL_PIPELINE_CACHE_FILE_VERSION (2)
+
+/* FileHeader::flags bits */
+#define ANVIL_PIPELINE_CACHE_FILE_FLAG_DEFLATE (1u << 0)
+
+/* Size of VkPipelineCacheHeaderVersionOne: headerSize, headerVersion, vendorID, deviceID & pipelineCacheUUID */
+#define VK_PIPELINE_CACHE_HEADER_VERSION_ONE_SIZE (4 * sizeof(uint32_t) + VK_UUID_SIZE)
 
 
 /** Please see header for specification */
@@ -48,10 +67,10 @@ Anvil::PipelineCache::PipelineCache(const Anvil::BaseDevice* in_device_ptr,
     cache_create_info.pNext           = nullptr;
     cache_create_info.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
 
-    result_vk = Anvil::Vulkan::vkCreatePipelineCache(m_device_ptr->get_device_vk(),
-                                                    &cache_create_info,
-                                                     nullptr, /* pAllocator */
-                                                    &m_pipeline_cache);
+    result_vk = m_device_ptr->get_dispatch_table().vkCreatePipelineCache(m_device_ptr->get_device_vk(),
+                                                                        &cache_create_info,
+                                                                         m_device_ptr->get_allocation_callbacks_vk(),
+                                                                        &m_pipeline_cache);
 
     anvil_assert_vk_call_succeeded(result_vk);
     if (is_vk_call_successful(result_vk) )
@@ -77,9 +96,9 @@ Anvil::PipelineCache::~PipelineCache()
     {
         lock();
         {
-            Anvil::Vulkan::vkDestroyPipelineCache(m_device_ptr->get_device_vk(),
-                                                  m_pipeline_cache,
-                                                  nullptr /* pAllocator */);
+            m_device_ptr->get_dispatch_table().vkDestroyPipelineCache(m_device_ptr->get_device_vk(),
+                                                                      m_pipeline_cache,
+                                                                      m_device_ptr->get_allocation_callbacks_vk() );
         }
         unlock();
 
@@ -106,20 +125,255 @@ Anvil::PipelineCacheUniquePtr Anvil::PipelineCache::create(const Anvil::BaseDevi
     return result_ptr;
 }
 
+/** Please see header for specification */
+Anvil::PipelineCacheUniquePtr Anvil::PipelineCache::create_from_file(const Anvil::BaseDevice* in_device_ptr,
+                                                                     bool                     in_mt_safe,
+                                                                     const std::string&       in_filename)
+{
+    std::vector<unsigned char> data;
+    PipelineCacheUniquePtr     result_ptr(nullptr,
+                                          std::default_delete<PipelineCache>() );
+
+    read_file_data(in_device_ptr,
+                   in_filename,
+                  &data);
+
+    result_ptr = Anvil::PipelineCache::create(in_device_ptr,
+                                              in_mt_safe,
+                                              data.size(),
+                                              (data.size() > 0) ? &data.at(0) : nullptr);
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+Anvil::PipelineCacheUniquePtr Anvil::PipelineCache::create_merged_from_files(const Anvil::BaseDevice*        in_device_ptr,
+                                                                             bool                            in_mt_safe,
+                                                                             const std::vector<std::string>& in_filenames,
+                                                                             uint32_t*                       out_opt_n_files_merged_ptr)
+{
+    uint32_t                            n_files_merged = 0;
+    PipelineCacheUniquePtr              result_ptr      (nullptr,
+                                                         std::default_delete<PipelineCache>() );
+    std::vector<PipelineCacheUniquePtr> src_cache_ptrs;
+    std::vector<const PipelineCache*>   src_cache_raw_ptrs;
+
+    result_ptr = Anvil::PipelineCache::create(in_device_ptr,
+                                              in_mt_safe);
+
+    if (result_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    /* Incompatible files are filtered out here, so that the driver only ever sees blobs it has produced. */
+    for (const auto& current_filename : in_filenames)
+    {
+        std::vector<unsigned char> data;
+
+        if (!read_file_data(in_device_ptr,
+                            current_filename,
+                           &data) )
+        {
+            continue;
+        }
+
+        src_cache_ptrs.push_back(
+            Anvil::PipelineCache::create(in_device_ptr,
+                                         false, /* in_mt_safe */
+                                         data.size(),
+                                        &data.at(0) )
+        );
+
+        if (src_cache_ptrs.back() == nullptr)
+        {
+            src_cache_ptrs.pop_back();
+
+            continue;
+        }
+
+        src_cache_raw_ptrs.push_back(src_cache_ptrs.back().get() );
+    }
+
+    if (src_cache_raw_ptrs.size() > 0)
+    {
+        if (!result_ptr->merge(static_cast<uint32_t>(src_cache_raw_ptrs.size() ),
+                              &src_cache_raw_ptrs.at(0) ))
+        {
+            result_ptr.reset();
+
+            goto end;
+        }
+
+        n_files_merged = static_cast<uint32_t>(src_cache_raw_ptrs.size() );
+    }
+
+end:
+    if (out_opt_n_files_merged_ptr != nullptr)
+    {
+        *out_opt_n_files_merged_ptr = n_files_merged;
+    }
+
+    return result_ptr;
+}
+
 /** Please see header for specification */
 bool Anvil::PipelineCache::get_data(size_t* out_n_data_bytes_ptr,
                                     void*   out_data_ptr)
 {
     VkResult result_vk;
 
-    result_vk = Anvil::Vulkan::vkGetPipelineCacheData(m_device_ptr->get_device_vk(),
-                                                      m_pipeline_cache,
-                                                      out_n_data_bytes_ptr,
-                                                      out_data_ptr);
+    result_vk = m_device_ptr->get_dispatch_table().vkGetPipelineCacheData(m_device_ptr->get_device_vk(),
+                                                                          m_pipeline_cache,
+                                                                          out_n_data_bytes_ptr,
+                                                                          out_data_ptr);
 
     return is_vk_call_successful(result_vk);
 }
 
+/** Tells whether the specified pipeline cache blob has been produced for the physical device(s) @param in_device_ptr
+ *  has been created for. This is determined by checking vendor ID, device ID and pipeline cache UUID fields of
+ *  the VkPipelineCacheHeaderVersionOne header the blob starts with.
+ *
+ *  @param in_device_ptr   Device to use.
+ *  @param in_n_data_bytes Number of bytes available under @param in_data_ptr.
+ *  @param in_data_ptr     Pipeline cache blob to check.
+ *
+ *  @return true if the blob can be used to initialize a pipeline cache for the device, false otherwise.
+ **/
+bool Anvil::PipelineCache::is_data_compatible(const Anvil::BaseDevice* in_device_ptr,
+                                              size_t                   in_n_data_bytes,
+                                              const void*              in_data_ptr)
+{
+    const auto&    device_props = *in_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr;
+    const uint8_t* data_u8_ptr  = static_cast<const uint8_t*>(in_data_ptr);
+    uint32_t       header_fields[4];
+    bool           result       = false;
+
+    if (in_n_data_bytes < VK_PIPELINE_CACHE_HEADER_VERSION_ONE_SIZE)
+    {
+        goto end;
+    }
+
+    memcpy(header_fields,
+           data_u8_ptr,
+           sizeof(header_fields) );
+
+    if (header_fields[0] <  VK_PIPELINE_CACHE_HEADER_VERSION_ONE_SIZE ||
+        header_fields[0] >  in_n_data_bytes                           ||
+        header_fields[1] != VK_PIPELINE_CACHE_HEADER_VERSION_ONE      ||
+        header_fields[2] != device_props.vendor_id                    ||
+        header_fields[3] != device_props.device_id)
+    {
+        goto end;
+    }
+
+    if (memcmp(data_u8_ptr + sizeof(header_fields),
+               device_props.pipeline_cache_uuid,
+               VK_UUID_SIZE) != 0)
+    {
+        goto end;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Reads a file written by store_to_file() and decompresses its contents, if needed.
+ *
+ *  @param in_device_ptr Device the pipeline cache data is going to be used with.
+ *  @param in_filename   Name of the file to read.
+ *  @param out_data_ptr  Deref will be set to the pipeline cache data stored in the file. Must not be null.
+ *
+ *  @return true if the file holds valid pipeline cache data compatible with @param in_device_ptr, false otherwise.
+ *          Deref of @param out_data_ptr is cleared in the latter case.
+ **/
+bool Anvil::PipelineCache::read_file_data(const Anvil::BaseDevice*    in_device_ptr,
+                                          const std::string&          in_filename,
+                                          std::vector<unsigned char>* out_data_ptr)
+{
+    const auto& device_props  = *in_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr;
+    char*       file_data_ptr = nullptr;
+    FileHeader  header;
+    size_t      n_file_bytes  = 0;
+    bool        result        = false;
+
+    out_data_ptr->clear();
+
+    if (!Anvil::IO::read_file(in_filename,
+                              false, /* in_is_text_file */
+                             &file_data_ptr,
+                             &n_file_bytes) )
+    {
+        goto end;
+    }
+
+    if (n_file_bytes < sizeof(header) )
+    {
+        goto end;
+    }
+
+    memcpy(&header,
+            file_data_ptr,
+            sizeof(header) );
+
+    /* Discard the file if it's been written by a different version of Anvil or the driver, or if it's been truncated. */
+    if (header.magic          != ANVIL_PIPELINE_CACHE_FILE_MAGIC                             ||
+        header.file_version   != ANVIL_PIPELINE_CACHE_FILE_VERSION                           ||
+        header.driver_version != device_props.driver_version                                 ||
+        header.n_stored_bytes != n_file_bytes - sizeof(header)                               ||
+        header.n_data_bytes   == 0                                                           ||
+        (header.flags & ~ANVIL_PIPELINE_CACHE_FILE_FLAG_DEFLATE) != 0)
+    {
+        goto end;
+    }
+
+    if ((header.flags & ANVIL_PIPELINE_CACHE_FILE_FLAG_DEFLATE) != 0)
+    {
+        mz_ulong n_data_bytes = header.n_data_bytes;
+
+        out_data_ptr->resize(header.n_data_bytes);
+
+        if (mz_uncompress(&out_data_ptr->at(0),
+                          &n_data_bytes,
+                           reinterpret_cast<const unsigned char*>(file_data_ptr + sizeof(header) ),
+                           header.n_stored_bytes) != MZ_OK ||
+            n_data_bytes                           != header.n_data_bytes)
+        {
+            out_data_ptr->clear();
+
+            goto end;
+        }
+    }
+    else
+    {
+        if (header.n_data_bytes != header.n_stored_bytes)
+        {
+            goto end;
+        }
+
+        out_data_ptr->assign(file_data_ptr + sizeof(header),
+                             file_data_ptr + n_file_bytes);
+    }
+
+    /* Discard the blob if it was produced for a different physical device. */
+    if (!is_data_compatible(in_device_ptr,
+                            out_data_ptr->size(),
+                           &out_data_ptr->at(0) ))
+    {
+        out_data_ptr->clear();
+
+        goto end;
+    }
+
+    result = true;
+end:
+    delete [] file_data_ptr;
+
+    return result;
+}
+
 /** Please see header for specification */
 bool Anvil::PipelineCache::merge(uint32_t                           in_n_pipeline_caches,
                                  const Anvil::PipelineCache* const* in_src_cache_ptrs)
@@ -127,8 +381,7 @@ bool Anvil::PipelineCache::merge(uint32_t                           in_n_pipelin
     VkResult                     result_vk;
     std::vector<VkPipelineCache> src_pipeline_caches(in_n_pipeline_caches);
 
-    anvil_assert(in_n_pipeline_caches < sizeof(src_pipeline_caches) / sizeof(src_pipeline_caches[0]) );
-
+    anvil_assert(in_n_pipeline_caches > 0);
 
     for (uint32_t n_pipeline_cache = 0;
                   n_pipeline_cache < in_n_pipeline_caches;
@@ -139,14 +392,110 @@ bool Anvil::PipelineCache::merge(uint32_t                           in_n_pipelin
 
     lock();
     {
-        result_vk = Anvil::Vulkan::vkMergePipelineCaches(m_device_ptr->get_device_vk(),
-                                                         m_pipeline_cache,
-                                                         in_n_pipeline_caches,
-                                                        &src_pipeline_caches.at(0) );
+        result_vk = m_device_ptr->get_dispatch_table().vkMergePipelineCaches(m_device_ptr->get_device_vk(),
+                                                                             m_pipeline_cache,
+                                                                             in_n_pipeline_caches,
+                                                                            &src_pipeline_caches.at(0) );
     }
     unlock();
 
-    anvil_assert(result_vk);
+    anvil_assert_vk_call_succeeded(result_vk);
 
     return is_vk_call_successful(result_vk);
 }
+
+/** Please see header for specification */
+bool Anvil::PipelineCache::store_to_file(const std::string& in_filename,
+                                         bool               in_compress)
+{
+    const auto&                device_props   = *m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr;
+    std::vector<unsigned char> data;
+    std::vector<unsigned char> file_data;
+    FileHeader                 header;
+    size_t                     n_data_bytes   = 0;
+    mz_ulong                   n_stored_bytes = 0;
+    bool                       result         = false;
+    const std::string          temp_filename  = in_filename + ".tmp";
+
+    if (!get_data(&n_data_bytes,
+                   nullptr) ||
+        n_data_bytes == 0)
+    {
+        goto end;
+    }
+
+    data.resize(n_data_bytes);
+
+    if (!get_data(&n_data_bytes,
+                  &data.at(0) ))
+    {
+        goto end;
+    }
+
+    header.driver_version = device_props.driver_version;
+    header.file_version   = ANVIL_PIPELINE_CACHE_FILE_VERSION;
+    header.flags          = 0;
+    header.magic          = ANVIL_PIPELINE_CACHE_FILE_MAGIC;
+    header.n_data_bytes   = static_cast<uint32_t>(n_data_bytes);
+
+    if (in_compress)
+    {
+        n_stored_bytes = mz_compressBound(static_cast<mz_ulong>(n_data_bytes) );
+
+        file_data.resize(sizeof(header) + n_stored_bytes);
+
+        if (mz_compress2(&file_data.at(sizeof(header) ),
+                         &n_stored_bytes,
+                         &data.at(0),
+                          static_cast<mz_ulong>(n_data_bytes),
+                          MZ_DEFAULT_LEVEL) != MZ_OK)
+        {
+            goto end;
+        }
+
+        header.flags |= ANVIL_PIPELINE_CACHE_FILE_FLAG_DEFLATE;
+
+        file_data.resize(sizeof(header) + n_stored_bytes);
+    }
+    else
+    {
+        n_stored_bytes = static_cast<mz_ulong>(n_data_bytes);
+
+        file_data.resize(sizeof(header) );
+        file_data.insert(file_data.end(),
+                         data.begin(),
+                         data.end  () );
+    }
+
+    header.n_stored_bytes = static_cast<uint32_t>(n_stored_bytes);
+
+    memcpy(&file_data.at(0),
+           &header,
+            sizeof(header) );
+
+    if (!Anvil::IO::write_binary_file(temp_filename,
+                                     &file_data.at(0),
+                                      static_cast<unsigned int>(file_data.size() )))
+    {
+        goto end;
+    }
+
+    if (std::rename(temp_filename.c_str(),
+                    in_filename.c_str() ) != 0)
+    {
+        /* rename() does not replace existing files on some platforms. */
+        Anvil::IO::delete_file(in_filename);
+
+        if (std::rename(temp_filename.c_str(),
+                        in_filename.c_str() ) != 0)
+        {
+            Anvil::IO::delete_file(temp_filename);
+
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
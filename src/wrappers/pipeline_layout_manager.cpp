@@ -21,6 +21,7 @@
 //
 
 #include "misc/debug.h"
+#include "misc/descriptor_set_create_info.h"
 #include "misc/object_tracker.h"
 #include "wrappers/descriptor_set_group.h"
 #include "wrappers/pipeline_layout.h"
@@ -31,7 +32,8 @@
 /** Constructor. */
 Anvil::PipelineLayoutManager::PipelineLayoutManager(const Anvil::BaseDevice* in_device_ptr,
                                                     bool                     in_mt_safe)
-    :MTSafetySupportProvider(in_mt_safe),
+    :MTSafetySupportProvider(in_mt_safe,
+                             false), /* in_is_lock_recursive */
      m_device_ptr           (in_device_ptr)
 {
     /* Register the object */
@@ -66,26 +68,65 @@ Anvil::PipelineLayoutManagerUniquePtr Anvil::PipelineLayoutManager::create(const
     return result_ptr;
 }
 
+/** Returns a structural hash of a pipeline layout configuration. Configurations which would be considered
+ *  equal by get_layout() return the same hash.
+ *
+ *  @param in_ds_create_info_items_ptr DS create info items of the layout. May contain null items.
+ *  @param in_push_constant_ranges     Push constant ranges of the layout.
+ *
+ *  @return Hash value.
+ */
+uint64_t Anvil::PipelineLayoutManager::get_hash(const std::vector<DescriptorSetCreateInfoUniquePtr>* in_ds_create_info_items_ptr,
+                                                const PushConstantRanges&                            in_push_constant_ranges)
+{
+    std::vector<uint64_t> words;
+
+    words.reserve(2 + in_ds_create_info_items_ptr->size() + in_push_constant_ranges.size() * 3);
+
+    words.push_back(in_ds_create_info_items_ptr->size() );
+
+    for (const auto& current_ds_create_info_ptr : *in_ds_create_info_items_ptr)
+    {
+        words.push_back( (current_ds_create_info_ptr != nullptr) ? current_ds_create_info_ptr->get_hash()
+                                                                 : 0);
+    }
+
+    words.push_back(in_push_constant_ranges.size() );
+
+    for (const auto& current_push_constant_range : in_push_constant_ranges)
+    {
+        words.push_back(current_push_constant_range.offset);
+        words.push_back(current_push_constant_range.size);
+        words.push_back(current_push_constant_range.stages.get_vk() );
+    }
+
+    return Anvil::Utils::hash64(&words.at(0),
+                                words.size() * sizeof(words.at(0) ));
+}
+
 /* Please see header for specification */
 bool Anvil::PipelineLayoutManager::get_layout(const std::vector<DescriptorSetCreateInfoUniquePtr>* in_ds_create_info_items_ptr,
                                               const PushConstantRanges&                            in_push_constant_ranges,
                                               Anvil::PipelineLayoutUniquePtr*                      out_pipeline_layout_ptr_ptr)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr                   = get_mutex();
-    const uint32_t                         n_descriptor_sets_in_in_dsg = static_cast<uint32_t>(in_ds_create_info_items_ptr->size() );
-    bool                                   result                      = false;
-    Anvil::PipelineLayout*                 result_pipeline_layout_ptr  = nullptr;
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr                   = get_mutex();
+    const uint32_t                             n_descriptor_sets_in_in_dsg = static_cast<uint32_t>(in_ds_create_info_items_ptr->size() );
+    bool                                       result                      = false;
+    Anvil::PipelineLayout*                     result_pipeline_layout_ptr  = nullptr;
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
         );
     }
 
-    for (auto layout_iterator  = m_pipeline_layouts.begin();
-              layout_iterator != m_pipeline_layouts.end();
+    auto& layouts = m_pipeline_layouts[get_hash(in_ds_create_info_items_ptr,
+                                                in_push_constant_ranges)];
+
+    for (auto layout_iterator  = layouts.begin();
+              layout_iterator != layouts.end();
             ++layout_iterator)
     {
         auto&      current_pipeline_layout_container_ptr     = *layout_iterator;
@@ -158,7 +199,7 @@ bool Anvil::PipelineLayoutManager::get_layout(const std::vector<DescriptorSetCre
         result_pipeline_layout_ptr                    = new_layout_ptr.get();
         new_layout_container_ptr->pipeline_layout_ptr = std::move(new_layout_ptr);
 
-        m_pipeline_layouts.push_back(
+        layouts.push_back(
             std::move(new_layout_container_ptr)
         );
     }
@@ -179,34 +220,47 @@ bool Anvil::PipelineLayoutManager::get_layout(const std::vector<DescriptorSetCre
 
 void Anvil::PipelineLayoutManager::on_pipeline_layout_dereferenced(Anvil::PipelineLayout* in_layout_ptr)
 {
-    bool                                   has_found  = false;
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr  = get_mutex();
+    bool                                       has_found  = false;
+    std::unique_lock<Anvil::RecursiveSpinLock> mutex_lock;
+    auto                                       mutex_ptr  = get_mutex();
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::RecursiveSpinLock>(*mutex_ptr)
         );
     }
 
-    for (auto layout_iterator  = m_pipeline_layouts.begin();
-              layout_iterator != m_pipeline_layouts.end()    && !has_found;
-            ++layout_iterator)
+    auto bucket_iterator = m_pipeline_layouts.find(get_hash(in_layout_ptr->get_ds_create_info_ptrs(),
+                                                            in_layout_ptr->get_attached_push_constant_ranges() ));
+
+    if (bucket_iterator != m_pipeline_layouts.end() )
     {
-        auto& current_pipeline_layout_container_ptr = *layout_iterator;
-        auto& current_pipeline_layout_ptr           = current_pipeline_layout_container_ptr->pipeline_layout_ptr;
+        auto& layouts = bucket_iterator->second;
 
-        if (current_pipeline_layout_ptr.get() == in_layout_ptr)
+        for (auto layout_iterator  = layouts.begin();
+                  layout_iterator != layouts.end()    && !has_found;
+                ++layout_iterator)
         {
-            has_found = true;
+            auto& current_pipeline_layout_container_ptr = *layout_iterator;
+            auto& current_pipeline_layout_ptr           = current_pipeline_layout_container_ptr->pipeline_layout_ptr;
 
-            if (current_pipeline_layout_container_ptr->n_references.fetch_sub(1) == 1)
+            if (current_pipeline_layout_ptr.get() == in_layout_ptr)
             {
-                m_pipeline_layouts.erase(layout_iterator);
-            }
+                has_found = true;
 
-            break;
+                if (current_pipeline_layout_container_ptr->n_references.fetch_sub(1) == 1)
+                {
+                    layouts.erase(layout_iterator);
+
+                    if (layouts.size() == 0)
+                    {
+                        m_pipeline_layouts.erase(bucket_iterator);
+                    }
+                }
+
+                break;
+            }
         }
     }
 
@@ -37,10 +37,12 @@ Anvil::QueryPool::QueryPool(const Anvil::BaseDevice* in_device_ptr,
      MTSafetySupportProvider   (in_mt_safe),
      m_device_ptr              (in_device_ptr),
      m_n_max_indices           (in_n_max_concurrent_queries),
+     m_n_values_per_query      (1),
      m_query_type              (in_query_type)
 {
-    anvil_assert(in_query_type == VK_QUERY_TYPE_OCCLUSION                     ||
-                 in_query_type == VK_QUERY_TYPE_TIMESTAMP                     ||
+    anvil_assert(in_query_type == VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR ||
+                 in_query_type == VK_QUERY_TYPE_OCCLUSION                                   ||
+                 in_query_type == VK_QUERY_TYPE_TIMESTAMP                                   ||
                  in_query_type == VK_QUERY_TYPE_TRANSFORM_FEEDBACK_STREAM_EXT);
 
     init(in_query_type,
@@ -63,6 +65,8 @@ Anvil::QueryPool::QueryPool(const Anvil::BaseDevice*           in_device_ptr,
      MTSafetySupportProvider   (in_mt_safe),
      m_device_ptr              (in_device_ptr),
      m_n_max_indices           (in_n_max_concurrent_queries),
+     m_n_values_per_query      ((in_query_type == VK_QUERY_TYPE_PIPELINE_STATISTICS) ? Anvil::Utils::count_set_bits(in_pipeline_statistics.get_vk() )
+                                                                                     : 1),
      m_query_type              (in_query_type)
 {
     init(in_query_type,
@@ -86,9 +90,9 @@ Anvil::QueryPool::~QueryPool()
     {
         lock();
         {
-            Anvil::Vulkan::vkDestroyQueryPool(m_device_ptr->get_device_vk(),
-                                              m_query_pool_vk,
-                                              nullptr /* pAllocator */);
+            m_device_ptr->get_dispatch_table().vkDestroyQueryPool(m_device_ptr->get_device_vk(),
+                                                                  m_query_pool_vk,
+                                                                  m_device_ptr->get_allocation_callbacks_vk() );
         }
         unlock();
 
@@ -188,19 +192,31 @@ bool Anvil::QueryPool::get_query_pool_results_internal(const uint32_t&
     if ((in_query_props & Anvil::QueryResultFlagBits::WITH_AVAILABILITY_BIT) != 0)
     {
         flags             |= VK_QUERY_RESULT_WITH_AVAILABILITY_BIT;
-        result_query_size *= 2;
+        result_query_size *= m_n_values_per_query + 1;
+    }
+    else
+    {
+        result_query_size *= m_n_values_per_query;
     }
 
     /* Execute the request */
-    result_vk = Anvil::Vulkan::vkGetQueryPoolResults(m_device_ptr->get_device_vk(),
-                                                     m_query_pool_vk,
-                                                     in_first_query_index,
-                                                     in_n_queries,
-                                                     result_query_size * in_n_queries,
-                                                     out_results_ptr,
-                                                     (in_should_return_uint64) ? sizeof(uint64_t) : sizeof(uint32_t),
-                                                     flags);
-
+    result_vk = m_device_ptr->get_dispatch_table().vkGetQueryPoolResults(m_device_ptr->get_device_vk(),
+                                                                         m_query_pool_vk,
+                                                                         in_first_query_index,
+                                                                         in_n_queries,
+                                                                         result_query_size * in_n_queries,
+                                                                         out_results_ptr,
+                                                                         result_query_size,
+                                                                         flags);
+
+    if ((in_query_props & Anvil::QueryResultFlagBits::PARTIAL_BIT)           != 0 ||
+        (in_query_props & Anvil::QueryResultFlagBits::WITH_AVAILABILITY_BIT) != 0)
+    {
+        /* Results of available queries are written even if some queries are not ready yet */
+        result                               = is_vk_call_successful(result_vk) || (result_vk == VK_NOT_READY);
+        *out_all_query_results_retrieved_ptr = (result_vk == VK_SUCCESS);
+    }
+    else
     if ((in_query_props & Anvil::QueryResultFlagBits::PARTIAL_BIT) != 0)
     {
         result                               = is_vk_call_successful(result_vk);
@@ -235,10 +251,10 @@ void Anvil::QueryPool::init(VkQueryType                        in_query_type,
     create_info.queryType          = in_query_type;
     create_info.sType              = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
 
-    result_vk = Anvil::Vulkan::vkCreateQueryPool(m_device_ptr->get_device_vk(),
-                                                &create_info,
-                                                 nullptr, /* pAllocator */
-                                                &m_query_pool_vk);
+    result_vk = m_device_ptr->get_dispatch_table().vkCreateQueryPool(m_device_ptr->get_device_vk(),
+                                                                    &create_info,
+                                                                     m_device_ptr->get_allocation_callbacks_vk(),
+                                                                    &m_query_pool_vk);
 
     anvil_assert_vk_call_succeeded(result_vk);
     if (is_vk_call_successful(result_vk) )
@@ -248,3 +264,37 @@ void Anvil::QueryPool::init(VkQueryType                        in_query_type,
         set_vk_handle(m_query_pool_vk);
     }
 }
+
+/* Please see header for specification */
+bool Anvil::QueryPool::reset_host(uint32_t in_first_query_index,
+                                  uint32_t in_n_queries)
+{
+    bool result = false;
+
+    if (!m_device_ptr->get_extension_info()->ext_host_query_reset() )
+    {
+        anvil_assert(m_device_ptr->get_extension_info()->ext_host_query_reset() );
+
+        goto end;
+    }
+
+    if (in_first_query_index + in_n_queries > m_n_max_indices)
+    {
+        anvil_assert(in_first_query_index + in_n_queries <= m_n_max_indices);
+
+        goto end;
+    }
+
+    lock();
+    {
+        m_device_ptr->get_extension_ext_host_query_reset_entrypoints().vkResetQueryPoolEXT(m_device_ptr->get_device_vk(),
+                                                                                           m_query_pool_vk,
+                                                                                           in_first_query_index,
+                                                                                           in_n_queries);
+    }
+    unlock();
+
+    result = true;
+end:
+    return result;
+}
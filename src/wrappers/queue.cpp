@@ -22,9 +22,13 @@
 
 #include "misc/debug.h"
 #include "misc/fence_create_info.h"
+#include "misc/frame_timing_recorder.h"
 #include "misc/object_tracker.h"
+#include "misc/perf_counters.h"
+#include "misc/queue_utilization_tracker.h"
 #include "misc/struct_chainer.h"
 #include "misc/swapchain_create_info.h"
+#include "misc/tracing.h"
 #include "misc/window.h"
 #include "wrappers/buffer.h"
 #include "wrappers/command_buffer.h"
@@ -52,17 +56,19 @@ Anvil::Queue::Queue(const Anvil::BaseDevice*          in_device_ptr,
                                      Anvil::ObjectType::QUEUE),
      MTSafetySupportProvider        (in_mt_safe),
      m_device_ptr                   (in_device_ptr),
+     m_frame_timing_recorder_ptr    (nullptr),
      m_n_debug_label_regions_started(0),
      m_queue                        (VK_NULL_HANDLE),
      m_queue_family_index           (in_queue_family_index),
      m_queue_global_priority        (in_global_priority),
-     m_queue_index                  (in_queue_index)
+     m_queue_index                  (in_queue_index),
+     m_utilization_tracker_ptr      (nullptr)
 {
     /* Retrieve the Vulkan handle */
-    Anvil::Vulkan::vkGetDeviceQueue(m_device_ptr->get_device_vk(),
-                                    in_queue_family_index,
-                                    in_queue_index,
-                                   &m_queue);
+    m_device_ptr->get_dispatch_table().vkGetDeviceQueue(m_device_ptr->get_device_vk(),
+                                                        in_queue_family_index,
+                                                        in_queue_index,
+                                                       &m_queue);
 
     anvil_assert(m_queue != VK_NULL_HANDLE);
 
@@ -127,56 +133,140 @@ end:
 /** Please see header for specification */
 bool Anvil::Queue::bind_sparse_memory(Anvil::SparseMemoryBindingUpdateInfo& in_update)
 {
-    const VkBindSparseInfo* bind_info_items   = nullptr;
-    Anvil::Fence*           fence_ptr         = nullptr;
-    const bool              mt_safe           = is_mt_safe();
-    uint32_t                n_bind_info_items = 0;
-    VkResult                result            = VK_ERROR_INITIALIZATION_FAILED;
+    Anvil::SparseMemoryBindingUpdateInfo* update_ptr = &in_update;
 
-    in_update.get_bind_sparse_call_args(&n_bind_info_items,
-                                        &bind_info_items,
-                                        &fence_ptr);
+    return bind_sparse_memory(1, /* in_n_updates */
+                             &update_ptr);
+}
 
-    /* If any of the bindings we are about to request requires non-zero memory or resource device indices,
-     * make sure we're using a mGPU device */
-    if (in_update.is_device_group_support_required() )
+/** Please see header for specification */
+bool Anvil::Queue::bind_sparse_memory(uint32_t                                     in_n_updates,
+                                      Anvil::SparseMemoryBindingUpdateInfo* const* in_updates_ptr)
+{
+    std::vector<VkBindSparseInfo> bind_info_items_vk;
+    const VkBindSparseInfo*       bind_info_items_ptr = nullptr;
+    Anvil::Fence*                 fence_ptr           = nullptr;
+    const bool                    mt_safe             = is_mt_safe();
+    uint32_t                      n_bind_info_items   = 0;
+    VkResult                      result              = VK_ERROR_INITIALIZATION_FAILED;
+
+    anvil_assert(in_n_updates   >  0);
+    anvil_assert(in_updates_ptr != nullptr);
+
+    for (uint32_t n_update = 0;
+                  n_update < in_n_updates;
+                ++n_update)
     {
-        const Anvil::MGPUDevice* mgpu_device_ptr(dynamic_cast<const Anvil::MGPUDevice*>(m_device_ptr));
+        const VkBindSparseInfo* update_bind_info_items   = nullptr;
+        Anvil::Fence*           update_fence_ptr         = nullptr;
+        uint32_t                update_n_bind_info_items = 0;
+
+        in_updates_ptr[n_update]->get_bind_sparse_call_args(&update_n_bind_info_items,
+                                                            &update_bind_info_items,
+                                                            &update_fence_ptr);
 
-        if (mgpu_device_ptr == nullptr)
+        /* If any of the bindings we are about to request requires non-zero memory or resource device indices,
+         * make sure we're using a mGPU device */
+        if (in_updates_ptr[n_update]->is_device_group_support_required() )
         {
-            anvil_assert(mgpu_device_ptr != nullptr);
+            const Anvil::MGPUDevice* mgpu_device_ptr(dynamic_cast<const Anvil::MGPUDevice*>(m_device_ptr));
+
+            if (mgpu_device_ptr == nullptr)
+            {
+                anvil_assert(mgpu_device_ptr != nullptr);
+
+                goto end;
+            }
 
-            goto end;
+            if (!mgpu_device_ptr->is_extension_enabled(VK_KHR_DEVICE_GROUP_EXTENSION_NAME) )
+            {
+                anvil_assert(mgpu_device_ptr->is_extension_enabled(VK_KHR_DEVICE_GROUP_EXTENSION_NAME));
+
+                goto end;
+            }
         }
 
-        if (!mgpu_device_ptr->is_extension_enabled(VK_KHR_DEVICE_GROUP_EXTENSION_NAME) )
+        /* vkQueueBindSparse() takes a single fence, so at most one of the aggregated updates may specify one. */
+        if (update_fence_ptr != nullptr)
         {
-            anvil_assert(mgpu_device_ptr->is_extension_enabled(VK_KHR_DEVICE_GROUP_EXTENSION_NAME));
+            if (fence_ptr != nullptr)
+            {
+                anvil_assert(fence_ptr == nullptr);
+
+                goto end;
+            }
+
+            fence_ptr = update_fence_ptr;
+        }
 
-            goto end;
+        if (in_n_updates == 1)
+        {
+            bind_info_items_ptr = update_bind_info_items;
+            n_bind_info_items   = update_n_bind_info_items;
+        }
+        else
+        {
+            bind_info_items_vk.insert(bind_info_items_vk.end(),
+                                      update_bind_info_items,
+                                      update_bind_info_items + update_n_bind_info_items);
         }
     }
 
+    if (in_n_updates > 1)
+    {
+        bind_info_items_ptr = (bind_info_items_vk.size() > 0) ? &bind_info_items_vk.at(0) : nullptr;
+        n_bind_info_items   = static_cast<uint32_t>(bind_info_items_vk.size() );
+    }
+
     if (mt_safe)
     {
-        bind_sparse_memory_lock_unlock(in_update,
-                                       true); /* in_should_lock */
+        for (uint32_t n_update = 0;
+                      n_update < in_n_updates;
+                    ++n_update)
+        {
+            bind_sparse_memory_lock_unlock(*in_updates_ptr[n_update],
+                                           true); /* in_should_lock */
+        }
     }
     {
-        result = Anvil::Vulkan::vkQueueBindSparse(m_queue,
-                                                  n_bind_info_items,
-                                                  bind_info_items,
-                                                  (fence_ptr != nullptr) ? fence_ptr->get_fence() : VK_NULL_HANDLE);
+        result = m_device_ptr->get_dispatch_table().vkQueueBindSparse(m_queue,
+                                                                      n_bind_info_items,
+                                                                      bind_info_items_ptr,
+                                                                      (fence_ptr != nullptr) ? fence_ptr->get_fence() : VK_NULL_HANDLE);
     }
     if (mt_safe)
     {
-        bind_sparse_memory_lock_unlock(in_update,
-                                       false); /* in_should_lock */
+        for (uint32_t n_update = 0;
+                      n_update < in_n_updates;
+                    ++n_update)
+        {
+            bind_sparse_memory_lock_unlock(*in_updates_ptr[n_update],
+                                           false); /* in_should_lock */
+        }
     }
 
     anvil_assert(result == VK_SUCCESS);
 
+    for (uint32_t n_update = 0;
+                  n_update < in_n_updates;
+                ++n_update)
+    {
+        bind_sparse_memory_update_resources(*in_updates_ptr[n_update]);
+    }
+
+end:
+    return (result == VK_SUCCESS);
+}
+
+/** Updates memory backing bookkeeping of all buffers and images referenced by the specified sparse binding update.
+ *  Must be called after the update has been submitted.
+ *
+ *  @param in_update Update which has been submitted.
+ */
+void Anvil::Queue::bind_sparse_memory_update_resources(Anvil::SparseMemoryBindingUpdateInfo& in_update)
+{
+    const uint32_t n_bind_info_items = in_update.get_n_bind_info_items();
+
     for (uint32_t n_bind_info = 0;
                   n_bind_info < n_bind_info_items;
                 ++n_bind_info)
@@ -286,8 +376,6 @@ bool Anvil::Queue::bind_sparse_memory(Anvil::SparseMemoryBindingUpdateInfo& in_u
         }
     }
 
-end:
-    return (result == VK_SUCCESS);
 }
 
 void Anvil::Queue::bind_sparse_memory_lock_unlock(Anvil::SparseMemoryBindingUpdateInfo& in_update,
@@ -826,19 +914,43 @@ bool Anvil::Queue::present_internal(DeviceGroupPresentModeFlagBits      in_prese
                                     Anvil::Semaphore* const*            in_wait_semaphore_ptrs,
                                     Anvil::SwapchainOperationErrorCode* out_present_results_ptr)
 {
-    const Anvil::DeviceType                 device_type              (m_device_ptr->get_type() );
-    VkResult                                presentation_results     [MAX_SWAPCHAINS];
-    bool                                    result                   (false);
-    VkResult                                result_vk;
-    Anvil::StructChainer<VkPresentInfoKHR>  struct_chainer;
-    const ExtensionKHRSwapchainEntrypoints* swapchain_entrypoints_ptr(nullptr);
-    VkSwapchainKHR                          swapchains_vk          [MAX_SWAPCHAINS];
-    std::vector<VkSemaphore>                wait_semaphores_vk     (in_n_wait_semaphores);
+    const Anvil::DeviceType                           device_type              (m_device_ptr->get_type() );
+    bool                                              needs_present_times      (false);
+    VkPresentTimeGOOGLE                               present_times            [MAX_SWAPCHAINS];
+    VkResult                                          presentation_results     [MAX_SWAPCHAINS];
+    bool                                              result                   (false);
+    VkResult                                          result_vk;
+    Anvil::InlineStructChainer<VkPresentInfoKHR, 256> struct_chainer;
+    const ExtensionKHRSwapchainEntrypoints*           swapchain_entrypoints_ptr(nullptr);
+    VkSwapchainKHR                                    swapchains_vk          [MAX_SWAPCHAINS];
+    std::vector<VkSemaphore>                          wait_semaphores_vk     (in_n_wait_semaphores);
 
     /* Sanity checks */
     anvil_assert(in_n_swapchains      <  MAX_SWAPCHAINS);
     anvil_assert(in_swapchains        != nullptr);
 
+    /* Close the frames recorded for swapchains which have a frame timing recorder attached. */
+    for (uint32_t n_swapchain = 0;
+                  n_swapchain < in_n_swapchains;
+                ++n_swapchain)
+    {
+        Anvil::FrameTimingRecorder* recorder_ptr = (in_swapchains[n_swapchain] != nullptr) ? in_swapchains[n_swapchain]->get_frame_timing_recorder()
+                                                                                           : nullptr;
+
+        present_times[n_swapchain].desiredPresentTime = 0;
+        present_times[n_swapchain].presentID          = 0;
+
+        if (recorder_ptr != nullptr)
+        {
+            present_times[n_swapchain].presentID = recorder_ptr->on_present_started();
+
+            if (recorder_ptr->is_display_timing_enabled() )
+            {
+                needs_present_times = true;
+            }
+        }
+    }
+
     if (device_type == Anvil::DeviceType::SINGLE_GPU)
     {
         anvil_assert(*in_device_masks     == 1);
@@ -862,19 +974,70 @@ bool Anvil::Queue::present_internal(DeviceGroupPresentModeFlagBits      in_prese
             if (window_platform == WINDOW_PLATFORM_DUMMY                    ||
                 window_platform == WINDOW_PLATFORM_DUMMY_WITH_PNG_SNAPSHOTS)
             {
-                static const Anvil::PipelineStageFlags dst_stage_mask(Anvil::PipelineStageFlagBits::TOP_OF_PIPE_BIT);
+                std::vector<Anvil::PipelineStageFlags> dst_stage_masks        (in_n_wait_semaphores,
+                                                                               Anvil::PipelineStageFlagBits::TOP_OF_PIPE_BIT);
+                std::vector<Anvil::Semaphore*>         signal_semaphore_ptrs;
+                std::vector<uint64_t>                  signal_semaphore_values;
+
+                /* Off-screen swapchains may track image availability with a timeline semaphore, in which case
+                 * the "present" needs to signal it, so that the image can be reacquired. */
+                for (uint32_t n_swapchain = 0;
+                              n_swapchain < in_n_swapchains;
+                            ++n_swapchain)
+                {
+                    uint64_t          signal_value  = 0;
+                    Anvil::Semaphore* semaphore_ptr = in_swapchains[n_swapchain]->get_headless_present_semaphore(in_swapchain_image_indices[n_swapchain],
+                                                                                                                &signal_value);
+
+                    if (semaphore_ptr != nullptr)
+                    {
+                        signal_semaphore_ptrs.push_back  (semaphore_ptr);
+                        signal_semaphore_values.push_back(signal_value);
+                    }
+                }
 
-                m_device_ptr->get_universal_queue(0)->submit(
-                    SubmitInfo::create_wait(in_n_wait_semaphores,
-                                            in_wait_semaphore_ptrs,
-                                           &dst_stage_mask)
-                );
+                if (signal_semaphore_ptrs.size() == 0)
+                {
+                    static const Anvil::PipelineStageFlags dst_stage_mask(Anvil::PipelineStageFlagBits::TOP_OF_PIPE_BIT);
+
+                    m_device_ptr->get_universal_queue(0)->submit(
+                        SubmitInfo::create_wait(in_n_wait_semaphores,
+                                                in_wait_semaphore_ptrs,
+                                               &dst_stage_mask)
+                    );
+                }
+                else
+                {
+                    const std::vector<uint64_t> wait_semaphore_values(in_n_wait_semaphores,
+                                                                      0); /* ignored for binary semaphores */
+                    auto                        submit_info          (SubmitInfo::create(0,       /* in_n_cmd_buffers           */
+                                                                                         nullptr, /* in_opt_cmd_buffer_ptrs_ptr */
+                                                                                         static_cast<uint32_t>(signal_semaphore_ptrs.size() ),
+                                                                                         &signal_semaphore_ptrs.at(0),
+                                                                                         in_n_wait_semaphores,
+                                                                                         in_wait_semaphore_ptrs,
+                                                                                         (in_n_wait_semaphores > 0) ? &dst_stage_masks.at(0) : nullptr,
+                                                                                         false) ); /* in_should_block */
+
+                    submit_info.set_timeline_semaphore_values(&signal_semaphore_values.at(0),
+                                                              static_cast<uint32_t>(signal_semaphore_values.size() ),
+                                                              (in_n_wait_semaphores > 0) ? &wait_semaphore_values.at(0) : nullptr,
+                                                              in_n_wait_semaphores);
+
+                    m_device_ptr->get_universal_queue(0)->submit(submit_info);
+                }
 
                 for (uint32_t n_presentation = 0;
                               n_presentation < in_n_swapchains;
                             ++n_presentation)
                 {
                     OnPresentRequestIssuedCallbackArgument callback_argument(in_swapchains[n_presentation]);
+                    Anvil::FrameTimingRecorder*            recorder_ptr     (in_swapchains[n_presentation]->get_frame_timing_recorder() );
+
+                    if (recorder_ptr != nullptr)
+                    {
+                        recorder_ptr->on_present_finished(Anvil::SwapchainOperationErrorCode::SUCCESS);
+                    }
 
                     CallbacksSupportProvider::callback(QUEUE_CALLBACK_ID_PRESENT_REQUEST_ISSUED,
                                                       &callback_argument);
@@ -932,6 +1095,20 @@ bool Anvil::Queue::present_internal(DeviceGroupPresentModeFlagBits      in_prese
         struct_chainer.append_struct(device_group_present_info);
     }
 
+    /* Tag the present request with present IDs, so that frame timing recorders can match the display timing data
+     * reported by the presentation engine to the frames they have recorded. */
+    if (needs_present_times)
+    {
+        VkPresentTimesInfoGOOGLE present_times_info;
+
+        present_times_info.pNext          = nullptr;
+        present_times_info.pTimes         = present_times;
+        present_times_info.sType          = VK_STRUCTURE_TYPE_PRESENT_TIMES_INFO_GOOGLE;
+        present_times_info.swapchainCount = in_n_swapchains;
+
+        struct_chainer.append_struct(present_times_info);
+    }
+
     swapchain_entrypoints_ptr = &m_device_ptr->get_extension_khr_swapchain_entrypoints();
 
     present_lock_unlock(in_n_swapchains,
@@ -940,10 +1117,8 @@ bool Anvil::Queue::present_internal(DeviceGroupPresentModeFlagBits      in_prese
                         in_wait_semaphore_ptrs,
                         true);
     {
-        auto chain_ptr = struct_chainer.create_chain();
-
         result_vk = swapchain_entrypoints_ptr->vkQueuePresentKHR(m_queue,
-                                                                 chain_ptr->get_root_struct() );
+                                                                 struct_chainer.get_root_struct() );
     }
     present_lock_unlock(in_n_swapchains,
                         in_swapchains,
@@ -957,8 +1132,15 @@ bool Anvil::Queue::present_internal(DeviceGroupPresentModeFlagBits      in_prese
                   n_presentation < in_n_swapchains;
                 ++n_presentation)
     {
+        Anvil::FrameTimingRecorder* recorder_ptr = in_swapchains[n_presentation]->get_frame_timing_recorder();
+
         out_present_results_ptr[n_presentation] = static_cast<Anvil::SwapchainOperationErrorCode>(presentation_results[n_presentation]);
 
+        if (recorder_ptr != nullptr)
+        {
+            recorder_ptr->on_present_finished(out_present_results_ptr[n_presentation]);
+        }
+
         {
             OnPresentRequestIssuedCallbackArgument callback_argument(in_swapchains[n_presentation]);
 
@@ -1019,359 +1201,431 @@ void Anvil::Queue::present_lock_unlock(uint32_t                       in_n_swapc
 /** Please see header for specification */
 bool Anvil::Queue::submit(const Anvil::SubmitInfo& in_submit_info)
 {
-    Anvil::Fence*                      fence_ptr        (in_submit_info.get_fence() );
-    bool                               needs_fence_reset(false);
-    VkResult                           result           (VK_ERROR_INITIALIZATION_FAILED);
-    Anvil::StructChainer<VkSubmitInfo> struct_chainer;
-
-    std::vector<VkCommandBuffer> cmd_buffers_vk         (in_submit_info.get_n_command_buffers  () );
-    std::vector<VkDeviceMemory>  device_memory_block_vec(0);
-    std::vector<VkSemaphore>     signal_semaphores_vk   (in_submit_info.get_n_signal_semaphores() );
-    std::vector<VkSemaphore>     wait_semaphores_vk     (in_submit_info.get_n_wait_semaphores  () );
+    const Anvil::SubmitInfo* submit_info_ptr = &in_submit_info;
 
-    std::vector<uint32_t> cmd_buffer_device_masks         = std::vector<uint32_t>(in_submit_info.get_n_command_buffers() );
-    std::vector<uint32_t> signal_semaphore_device_indices = std::vector<uint32_t>(in_submit_info.get_n_signal_semaphores() );
-    std::vector<uint32_t> wait_semaphore_device_indices   = std::vector<uint32_t>(in_submit_info.get_n_wait_semaphores  () );
+    return submit(1, /* in_n_submit_infos */
+                 &submit_info_ptr);
+}
 
+/** Please see header for specification */
+bool Anvil::Queue::submit(uint32_t                         in_n_submit_infos,
+                          const Anvil::SubmitInfo* const*  in_submit_info_ptrs)
+{
+    ANVIL_TRACE_SPAN("Queue::submit");
+
+    Anvil::Fence*                   fence_ptr                   (nullptr);
+    bool                            has_bracketed_submissions   (false);
+    uint32_t                        n_cmd_buffers_total         (0);
+    uint32_t                        n_device_memory_blocks_total(0);
+    uint32_t                        n_semaphores_total          (0);
+    bool                            needs_fence_reset           (false);
+    VkResult                        result                      (VK_ERROR_INITIALIZATION_FAILED);
+    bool                            should_block                (false);
+    uint64_t                        timeout                     (UINT64_MAX);
+    Anvil::QueueUtilizationTracker* utilization_tracker_ptr     (m_utilization_tracker_ptr);
+
+    ANVIL_REDUNDANT_VARIABLE(n_device_memory_blocks_total);
+
+    if (in_n_submit_infos == 0)
+    {
+        result = VK_SUCCESS;
 
-    ANVIL_REDUNDANT_VARIABLE(result);
+        goto end;
+    }
 
-    /* Prepare for the submission */
-    switch (in_submit_info.get_type() )
+    /* Determine how much scratch storage the batch needs, and which fence (if any) it is going to signal.
+     * vkQueueSubmit() takes a single fence, so only the last submission may specify one. */
+    for (uint32_t n_submit_info = 0;
+                  n_submit_info < in_n_submit_infos;
+                ++n_submit_info)
     {
-        case SubmissionType::MGPU:
+        const auto& current_submit_info = *in_submit_info_ptrs[n_submit_info];
+
+        n_cmd_buffers_total += current_submit_info.get_n_command_buffers  ();
+        n_semaphores_total  += current_submit_info.get_n_signal_semaphores() + current_submit_info.get_n_wait_semaphores();
+
+        if (current_submit_info.get_fence() != nullptr ||
+            current_submit_info.get_should_block() )
         {
-            uint32_t n_cmd_buffers = 0;
+            anvil_assert(n_submit_info == in_n_submit_infos - 1);
+
+            fence_ptr    = current_submit_info.get_fence       ();
+            should_block = current_submit_info.get_should_block();
+            timeout      = current_submit_info.get_timeout     ();
+        }
 
-            if (in_submit_info.is_protected_submission() )
+        #if defined(_WIN32)
+        {
+            const Anvil::MemoryBlock** acquire_d3d11_memory_block_ptrs = nullptr;
+            const uint64_t*            acquire_mutex_key_value_ptrs    = nullptr;
+            const uint32_t*            acquire_timeout_ptrs            = nullptr;
+            uint32_t                   n_acquire_keys                  = 0;
+            uint32_t                   n_release_keys                  = 0;
+            const Anvil::MemoryBlock** release_d3d11_memory_block_ptrs = nullptr;
+            const uint64_t*            release_mutex_key_value_ptrs    = nullptr;
+
+            if (current_submit_info.get_keyed_mutex_acquire_release_info(&n_acquire_keys,
+                                                                         &acquire_d3d11_memory_block_ptrs,
+                                                                         &acquire_mutex_key_value_ptrs,
+                                                                         &acquire_timeout_ptrs,
+                                                                         &n_release_keys,
+                                                                         &release_d3d11_memory_block_ptrs,
+                                                                         &release_mutex_key_value_ptrs) )
             {
-                anvil_assert(reinterpret_cast<const MGPUDevice*>(m_device_ptr)->get_physical_device(0)->supports_core_vk1_1() );
+                n_device_memory_blocks_total += n_acquire_keys + n_release_keys;
             }
+        }
+        #endif
+    }
 
-            for (uint32_t n_command_buffer_submission = 0;
-                          n_command_buffer_submission < in_submit_info.get_n_command_buffers();
-                        ++n_command_buffer_submission)
-            {
-                const auto& current_submission = in_submit_info.get_command_buffers_mgpu()[n_command_buffer_submission];
+    if (utilization_tracker_ptr != nullptr)
+    {
+        /* Reserve space for the command buffers which bracket each submission with timestamp writes. */
+        n_cmd_buffers_total += in_n_submit_infos * 2;
+    }
 
-                if (current_submission.cmd_buffer_ptr != nullptr)
-                {
-                    cmd_buffers_vk.at         (n_cmd_buffers) = current_submission.cmd_buffer_ptr->get_command_buffer();
-                    cmd_buffer_device_masks.at(n_cmd_buffers) = current_submission.device_mask;
+    if (fence_ptr == nullptr &&
+        should_block)
+    {
+        fence_ptr         = m_submit_fence_ptr.get();
+        needs_fence_reset = true;
+    }
 
-                    ++n_cmd_buffers;
-                }
-            }
+    /* The scratch storage is owned by the queue, so lock all objects involved before touching it. */
+    submit_lock_unlock(in_n_submit_infos,
+                       in_submit_info_ptrs,
+                       fence_ptr,
+                       true); /* in_should_lock */
+    {
+        uint32_t cmd_buffer_offset          = 0;
+        uint32_t device_memory_block_offset = 0;
+        uint32_t semaphore_offset           = 0;
+
+        ANVIL_REDUNDANT_VARIABLE(device_memory_block_offset);
+
+        /* NOTE: The vectors are only ever resized, so once the queue has seen its largest batch, no more allocations
+         *       take place. Each extension struct vector is sized to the number of submissions, so that pointers to
+         *       its items remain valid throughout the call.
+         */
+        m_submit_scratch.cmd_buffer_device_masks.resize  (n_cmd_buffers_total);
+        m_submit_scratch.cmd_buffers_vk.resize           (n_cmd_buffers_total);
+        m_submit_scratch.device_group_submit_infos.resize(in_n_submit_infos);
+        m_submit_scratch.protected_submit_infos.resize   (in_n_submit_infos);
+        m_submit_scratch.semaphore_device_indices.resize (n_semaphores_total);
+        m_submit_scratch.semaphores_vk.resize            (n_semaphores_total);
+        m_submit_scratch.submit_infos.resize             (in_n_submit_infos);
+        m_submit_scratch.timeline_submit_infos.resize    (in_n_submit_infos);
+
+        #if defined(_WIN32)
+        {
+            m_submit_scratch.d3d12_fence_submit_infos.resize(in_n_submit_infos);
+            m_submit_scratch.device_memory_blocks.resize    (n_device_memory_blocks_total);
+            m_submit_scratch.keyed_mutex_infos.resize       (in_n_submit_infos);
+        }
+        #endif
 
-            for (uint32_t n_signal_semaphore_submission = 0;
-                          n_signal_semaphore_submission < in_submit_info.get_n_signal_semaphores();
-                        ++n_signal_semaphore_submission)
+        for (uint32_t n_submit_info = 0;
+                      n_submit_info < in_n_submit_infos;
+                    ++n_submit_info)
+        {
+            const auto&      current_submit_info          = *in_submit_info_ptrs[n_submit_info];
+            VkCommandBuffer* cmd_buffers_vk_ptr           = (n_cmd_buffers_total > 0) ? &m_submit_scratch.cmd_buffers_vk.at         (0) + cmd_buffer_offset : nullptr;
+            uint32_t*        cmd_buffer_device_masks_ptr  = (n_cmd_buffers_total > 0) ? &m_submit_scratch.cmd_buffer_device_masks.at(0) + cmd_buffer_offset : nullptr;
+            const uint32_t   n_signal_semaphores          = current_submit_info.get_n_signal_semaphores();
+            const uint32_t   n_wait_semaphores            = current_submit_info.get_n_wait_semaphores  ();
+            uint32_t         n_cmd_buffers                = 0;
+            bool             is_bracketed                 = false;
+            VkSemaphore*     signal_semaphores_vk_ptr     = (n_semaphores_total > 0) ? &m_submit_scratch.semaphores_vk.at           (0) + semaphore_offset : nullptr;
+            uint32_t*        signal_semaphore_indices_ptr = (n_semaphores_total > 0) ? &m_submit_scratch.semaphore_device_indices.at(0) + semaphore_offset : nullptr;
+            VkSubmitInfo&    submit_info                  = m_submit_scratch.submit_infos.at(n_submit_info);
+            VkSemaphore*     wait_semaphores_vk_ptr       = signal_semaphores_vk_ptr     + n_signal_semaphores;
+            uint32_t*        wait_semaphore_indices_ptr   = signal_semaphore_indices_ptr + n_signal_semaphores;
+
+            switch (current_submit_info.get_type() )
             {
-                const auto& current_submission = in_submit_info.get_signal_semaphores_mgpu()[n_signal_semaphore_submission];
+                case SubmissionType::MGPU:
+                {
+                    if (current_submit_info.is_protected_submission() )
+                    {
+                        anvil_assert(reinterpret_cast<const MGPUDevice*>(m_device_ptr)->get_physical_device(0)->supports_core_vk1_1() );
+                    }
 
-                anvil_assert(current_submission.device_index < reinterpret_cast<const Anvil::MGPUDevice*>(m_device_ptr)->get_n_physical_devices() );
+                    for (uint32_t n_command_buffer_submission = 0;
+                                  n_command_buffer_submission < current_submit_info.get_n_command_buffers();
+                                ++n_command_buffer_submission)
+                    {
+                        const auto& current_submission = current_submit_info.get_command_buffers_mgpu()[n_command_buffer_submission];
 
-                signal_semaphore_device_indices.at(n_signal_semaphore_submission) = current_submission.device_index;
-                signal_semaphores_vk.at           (n_signal_semaphore_submission) = current_submission.semaphore_ptr->get_semaphore();
-            }
+                        if (current_submission.cmd_buffer_ptr != nullptr)
+                        {
+                            cmd_buffers_vk_ptr         [n_cmd_buffers] = current_submission.cmd_buffer_ptr->get_command_buffer();
+                            cmd_buffer_device_masks_ptr[n_cmd_buffers] = current_submission.device_mask;
 
-            for (uint32_t n_wait_semaphore_submission = 0;
-                          n_wait_semaphore_submission < in_submit_info.get_n_wait_semaphores();
-                        ++n_wait_semaphore_submission)
-            {
-                const auto& current_submission = in_submit_info.get_wait_semaphores_mgpu()[n_wait_semaphore_submission];
+                            ++n_cmd_buffers;
+                        }
+                    }
 
-                anvil_assert(current_submission.device_index < reinterpret_cast<const Anvil::MGPUDevice*>(m_device_ptr)->get_n_physical_devices() );
+                    for (uint32_t n_signal_semaphore_submission = 0;
+                                  n_signal_semaphore_submission < n_signal_semaphores;
+                                ++n_signal_semaphore_submission)
+                    {
+                        const auto& current_submission = current_submit_info.get_signal_semaphores_mgpu()[n_signal_semaphore_submission];
 
-                wait_semaphore_device_indices.at(n_wait_semaphore_submission) = current_submission.device_index;
-                wait_semaphores_vk.at           (n_wait_semaphore_submission) = current_submission.semaphore_ptr->get_semaphore();
-            }
+                        anvil_assert(current_submission.device_index < reinterpret_cast<const Anvil::MGPUDevice*>(m_device_ptr)->get_n_physical_devices() );
 
-            {
-                VkSubmitInfo submit_info;
-
-                submit_info.commandBufferCount   = in_submit_info.get_n_command_buffers();
-                submit_info.pCommandBuffers      = (submit_info.commandBufferCount           != 0) ? &cmd_buffers_vk.at(0)       : nullptr;
-                submit_info.pNext                = nullptr;
-                submit_info.pSignalSemaphores    = (in_submit_info.get_n_signal_semaphores() != 0) ? &signal_semaphores_vk.at(0) : nullptr;
-                submit_info.pWaitDstStageMask    = in_submit_info.get_destination_stage_wait_masks();
-                submit_info.pWaitSemaphores      = (in_submit_info.get_n_wait_semaphores()   != 0) ? &wait_semaphores_vk.at(0)   : nullptr;
-                submit_info.signalSemaphoreCount = in_submit_info.get_n_signal_semaphores();
-                submit_info.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-                submit_info.waitSemaphoreCount   = in_submit_info.get_n_wait_semaphores();
-
-                struct_chainer.append_struct(submit_info);
-            }
+                        signal_semaphore_indices_ptr[n_signal_semaphore_submission] = current_submission.device_index;
+                        signal_semaphores_vk_ptr    [n_signal_semaphore_submission] = current_submission.semaphore_ptr->get_semaphore();
+                    }
 
-            {
-                VkDeviceGroupSubmitInfoKHR submit_info_device_group;
+                    for (uint32_t n_wait_semaphore_submission = 0;
+                                  n_wait_semaphore_submission < n_wait_semaphores;
+                                ++n_wait_semaphore_submission)
+                    {
+                        const auto& current_submission = current_submit_info.get_wait_semaphores_mgpu()[n_wait_semaphore_submission];
 
-                submit_info_device_group.commandBufferCount            = n_cmd_buffers;
-                submit_info_device_group.pCommandBufferDeviceMasks     = (n_cmd_buffers != 0) ? &cmd_buffer_device_masks.at(0) : nullptr;
-                submit_info_device_group.pNext                         = nullptr;
-                submit_info_device_group.pSignalSemaphoreDeviceIndices = (in_submit_info.get_n_signal_semaphores() != 0) ? &signal_semaphore_device_indices.at(0) : nullptr;
-                submit_info_device_group.pWaitSemaphoreDeviceIndices   = (in_submit_info.get_n_wait_semaphores  () != 0) ? &wait_semaphore_device_indices.at  (0) : nullptr;
-                submit_info_device_group.signalSemaphoreCount          = in_submit_info.get_n_signal_semaphores();
-                submit_info_device_group.sType                         = VK_STRUCTURE_TYPE_DEVICE_GROUP_SUBMIT_INFO_KHR;
-                submit_info_device_group.waitSemaphoreCount            = in_submit_info.get_n_wait_semaphores();
+                        anvil_assert(current_submission.device_index < reinterpret_cast<const Anvil::MGPUDevice*>(m_device_ptr)->get_n_physical_devices() );
 
-                struct_chainer.append_struct(submit_info_device_group);
-            }
+                        wait_semaphore_indices_ptr[n_wait_semaphore_submission] = current_submission.device_index;
+                        wait_semaphores_vk_ptr    [n_wait_semaphore_submission] = current_submission.semaphore_ptr->get_semaphore();
+                    }
 
-            break;
-        }
+                    break;
+                }
 
-        case SubmissionType::SGPU:
-        {
-            VkSubmitInfo submit_info;
+                case SubmissionType::SGPU:
+                {
+                    if (current_submit_info.is_protected_submission() )
+                    {
+                        anvil_assert(reinterpret_cast<const SGPUDevice*>(m_device_ptr)->get_physical_device()->supports_core_vk1_1() );
+                    }
 
-            if (in_submit_info.is_protected_submission() )
-            {
-                anvil_assert(reinterpret_cast<const SGPUDevice*>(m_device_ptr)->get_physical_device()->supports_core_vk1_1() );
-            }
+                    /* Protected submissions cannot write timestamps, so they are never bracketed. */
+                    if (utilization_tracker_ptr                         != nullptr &&
+                        current_submit_info.get_n_command_buffers()     >  0       &&
+                       !current_submit_info.is_protected_submission() )
+                    {
+                        is_bracketed = utilization_tracker_ptr->begin_submission(this,
+                                                                                 cmd_buffers_vk_ptr,
+                                                                                 cmd_buffers_vk_ptr + current_submit_info.get_n_command_buffers() + 1);
+                    }
 
-            for (uint32_t n_command_buffer = 0;
-                          n_command_buffer < in_submit_info.get_n_command_buffers();
-                        ++n_command_buffer)
-            {
-                cmd_buffers_vk.at(n_command_buffer) = in_submit_info.get_command_buffers_sgpu()[n_command_buffer]->get_command_buffer();
-            }
+                    for (uint32_t n_command_buffer = 0;
+                                  n_command_buffer < current_submit_info.get_n_command_buffers();
+                                ++n_command_buffer)
+                    {
+                        cmd_buffers_vk_ptr[n_command_buffer + (is_bracketed ? 1 : 0)] = current_submit_info.get_command_buffers_sgpu()[n_command_buffer]->get_command_buffer();
+                    }
 
-            for (uint32_t n_signal_semaphore = 0;
-                          n_signal_semaphore < in_submit_info.get_n_signal_semaphores();
-                        ++n_signal_semaphore)
-            {
-                auto sem_ptr = in_submit_info.get_signal_semaphores_sgpu()[n_signal_semaphore];
+                    for (uint32_t n_signal_semaphore = 0;
+                                  n_signal_semaphore < n_signal_semaphores;
+                                ++n_signal_semaphore)
+                    {
+                        signal_semaphores_vk_ptr[n_signal_semaphore] = current_submit_info.get_signal_semaphores_sgpu()[n_signal_semaphore]->get_semaphore();
+                    }
 
-                signal_semaphores_vk.at(n_signal_semaphore) = sem_ptr->get_semaphore();
-            }
+                    for (uint32_t n_wait_semaphore = 0;
+                                  n_wait_semaphore < n_wait_semaphores;
+                                ++n_wait_semaphore)
+                    {
+                        wait_semaphores_vk_ptr[n_wait_semaphore] = current_submit_info.get_wait_semaphores_sgpu()[n_wait_semaphore]->get_semaphore();
+                    }
 
-            for (uint32_t n_wait_semaphore = 0;
-                          n_wait_semaphore < in_submit_info.get_n_wait_semaphores();
-                        ++n_wait_semaphore)
-            {
-                wait_semaphores_vk.at(n_wait_semaphore) = in_submit_info.get_wait_semaphores_sgpu()[n_wait_semaphore]->get_semaphore();
+                    n_cmd_buffers = current_submit_info.get_n_command_buffers() + (is_bracketed ? 2 : 0);
+
+                    break;
+                }
+
+                default:
+                {
+                    anvil_assert_fail();
+                }
             }
 
-            submit_info.commandBufferCount   = in_submit_info.get_n_command_buffers ();
-            submit_info.pCommandBuffers      = (in_submit_info.get_n_command_buffers()   != 0) ? &cmd_buffers_vk.at(0)       : nullptr;
+            submit_info.commandBufferCount   = n_cmd_buffers;
+            submit_info.pCommandBuffers      = (n_cmd_buffers       != 0) ? cmd_buffers_vk_ptr       : nullptr;
             submit_info.pNext                = nullptr;
-            submit_info.pSignalSemaphores    = (in_submit_info.get_n_signal_semaphores() != 0) ? &signal_semaphores_vk.at(0) : nullptr;
-            submit_info.pWaitDstStageMask    = in_submit_info.get_destination_stage_wait_masks();
-            submit_info.pWaitSemaphores      = (in_submit_info.get_n_wait_semaphores()   != 0) ? &wait_semaphores_vk.at(0)   : nullptr;
-            submit_info.signalSemaphoreCount = in_submit_info.get_n_signal_semaphores();
+            submit_info.pSignalSemaphores    = (n_signal_semaphores != 0) ? signal_semaphores_vk_ptr : nullptr;
+            submit_info.pWaitDstStageMask    = current_submit_info.get_destination_stage_wait_masks();
+            submit_info.pWaitSemaphores      = (n_wait_semaphores   != 0) ? wait_semaphores_vk_ptr   : nullptr;
+            submit_info.signalSemaphoreCount = n_signal_semaphores;
             submit_info.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-            submit_info.waitSemaphoreCount   = in_submit_info.get_n_wait_semaphores();
+            submit_info.waitSemaphoreCount   = n_wait_semaphores;
 
-            struct_chainer.append_struct(submit_info);
+            /* Any additional structs to chain? */
+            if (current_submit_info.get_type() == SubmissionType::MGPU)
+            {
+                VkDeviceGroupSubmitInfoKHR& submit_info_device_group = m_submit_scratch.device_group_submit_infos.at(n_submit_info);
 
-            break;
-        }
+                submit_info_device_group.commandBufferCount            = n_cmd_buffers;
+                submit_info_device_group.pCommandBufferDeviceMasks     = (n_cmd_buffers       != 0) ? cmd_buffer_device_masks_ptr  : nullptr;
+                submit_info_device_group.pNext                         = submit_info.pNext;
+                submit_info_device_group.pSignalSemaphoreDeviceIndices = (n_signal_semaphores != 0) ? signal_semaphore_indices_ptr : nullptr;
+                submit_info_device_group.pWaitSemaphoreDeviceIndices   = (n_wait_semaphores   != 0) ? wait_semaphore_indices_ptr   : nullptr;
+                submit_info_device_group.signalSemaphoreCount          = n_signal_semaphores;
+                submit_info_device_group.sType                         = VK_STRUCTURE_TYPE_DEVICE_GROUP_SUBMIT_INFO_KHR;
+                submit_info_device_group.waitSemaphoreCount            = n_wait_semaphores;
 
-        default:
-        {
-            anvil_assert_fail();
-        }
-    }
+                submit_info.pNext = &submit_info_device_group;
+            }
 
-    /* Any additional structs to chain? */
-    #if defined(_WIN32)
-    {
-        const uint64_t* d3d12_fence_signal_semaphore_values_ptr = nullptr;
-        const uint64_t* d3d12_fence_wait_semaphore_values_ptr   = nullptr;
+            {
+                const uint64_t* timeline_signal_semaphore_values_ptr = nullptr;
+                const uint64_t* timeline_wait_semaphore_values_ptr   = nullptr;
 
-        if (in_submit_info.get_d3d12_fence_semaphore_values(&d3d12_fence_signal_semaphore_values_ptr,
-                                                            &d3d12_fence_wait_semaphore_values_ptr) )
-        {
-            VkD3D12FenceSubmitInfoKHR fence_info;
+                if (current_submit_info.get_timeline_semaphore_values(&timeline_signal_semaphore_values_ptr,
+                                                                      &timeline_wait_semaphore_values_ptr) )
+                {
+                    VkTimelineSemaphoreSubmitInfoKHR& timeline_info = m_submit_scratch.timeline_submit_infos.at(n_submit_info);
 
-            fence_info.pNext                      = nullptr;
-            fence_info.pSignalSemaphoreValues     = d3d12_fence_signal_semaphore_values_ptr;
-            fence_info.pWaitSemaphoreValues       = d3d12_fence_wait_semaphore_values_ptr;
-            fence_info.signalSemaphoreValuesCount = in_submit_info.get_n_signal_semaphores();
-            fence_info.sType                      = VK_STRUCTURE_TYPE_D3D12_FENCE_SUBMIT_INFO_KHR;
-            fence_info.waitSemaphoreValuesCount   = in_submit_info.get_n_wait_semaphores();
+                    anvil_assert(m_device_ptr->get_extension_info()->khr_timeline_semaphore() );
 
-            struct_chainer.append_struct(fence_info);
-        }
-    }
-    #endif
+                    timeline_info.pNext                     = submit_info.pNext;
+                    timeline_info.pSignalSemaphoreValues    = timeline_signal_semaphore_values_ptr;
+                    timeline_info.pWaitSemaphoreValues      = timeline_wait_semaphore_values_ptr;
+                    timeline_info.signalSemaphoreValueCount = (timeline_signal_semaphore_values_ptr != nullptr) ? n_signal_semaphores : 0;
+                    timeline_info.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+                    timeline_info.waitSemaphoreValueCount   = (timeline_wait_semaphore_values_ptr   != nullptr) ? n_wait_semaphores   : 0;
 
-    #if defined(_WIN32)
-    {
-        const Anvil::MemoryBlock** acquire_d3d11_memory_block_ptrs = nullptr;
-        const uint64_t*            acquire_mutex_key_value_ptrs    = nullptr;
-        const uint32_t*            acquire_timeout_ptrs            = nullptr;
-        uint32_t                   n_acquire_keys                  = 0;
-        uint32_t                   n_release_keys                  = 0;
-        const Anvil::MemoryBlock** release_d3d11_memory_block_ptrs = nullptr;
-        const uint64_t*            release_mutex_key_value_ptrs    = nullptr;
-
-        if (in_submit_info.get_keyed_mutex_acquire_release_info(&n_acquire_keys,
-                                                                &acquire_d3d11_memory_block_ptrs,
-                                                                &acquire_mutex_key_value_ptrs,
-                                                                &acquire_timeout_ptrs,
-                                                                &n_release_keys,
-                                                                &release_d3d11_memory_block_ptrs,
-                                                                &release_mutex_key_value_ptrs) )
-        {
-            VkWin32KeyedMutexAcquireReleaseInfoKHR info;
+                    submit_info.pNext = &timeline_info;
+                }
+            }
 
-            anvil_assert(n_acquire_keys + n_release_keys > 0);
+            #if defined(_WIN32)
+            {
+                const uint64_t* d3d12_fence_signal_semaphore_values_ptr = nullptr;
+                const uint64_t* d3d12_fence_wait_semaphore_values_ptr   = nullptr;
 
-            device_memory_block_vec.resize(n_acquire_keys + n_release_keys);
+                if (current_submit_info.get_d3d12_fence_semaphore_values(&d3d12_fence_signal_semaphore_values_ptr,
+                                                                         &d3d12_fence_wait_semaphore_values_ptr) )
+                {
+                    VkD3D12FenceSubmitInfoKHR& fence_info = m_submit_scratch.d3d12_fence_submit_infos.at(n_submit_info);
 
-            VkDeviceMemory* acquire_sync_ptr = (n_acquire_keys > 0) ? &device_memory_block_vec.at(0)
-                                                                    : nullptr;
-            VkDeviceMemory* release_sync_ptr = (n_release_keys > 0) ? &device_memory_block_vec.at(n_acquire_keys)
-                                                                    : nullptr;
+                    fence_info.pNext                      = submit_info.pNext;
+                    fence_info.pSignalSemaphoreValues     = d3d12_fence_signal_semaphore_values_ptr;
+                    fence_info.pWaitSemaphoreValues       = d3d12_fence_wait_semaphore_values_ptr;
+                    fence_info.signalSemaphoreValuesCount = n_signal_semaphores;
+                    fence_info.sType                      = VK_STRUCTURE_TYPE_D3D12_FENCE_SUBMIT_INFO_KHR;
+                    fence_info.waitSemaphoreValuesCount   = n_wait_semaphores;
 
-            for (uint32_t n_acquire_sync = 0;
-                          n_acquire_sync < n_acquire_keys;
-                        ++n_acquire_sync)
-            {
-                acquire_sync_ptr[n_acquire_sync] = acquire_d3d11_memory_block_ptrs[n_acquire_sync]->get_memory();
+                    submit_info.pNext = &fence_info;
+                }
             }
 
-            for (uint32_t n_release_sync = 0;
-                          n_release_sync < n_release_keys;
-                        ++n_release_sync)
             {
-                release_sync_ptr[n_release_sync] = release_d3d11_memory_block_ptrs[n_release_sync]->get_memory();
-            }
+                const Anvil::MemoryBlock** acquire_d3d11_memory_block_ptrs = nullptr;
+                const uint64_t*            acquire_mutex_key_value_ptrs    = nullptr;
+                const uint32_t*            acquire_timeout_ptrs            = nullptr;
+                uint32_t                   n_acquire_keys                  = 0;
+                uint32_t                   n_release_keys                  = 0;
+                const Anvil::MemoryBlock** release_d3d11_memory_block_ptrs = nullptr;
+                const uint64_t*            release_mutex_key_value_ptrs    = nullptr;
+
+                if (current_submit_info.get_keyed_mutex_acquire_release_info(&n_acquire_keys,
+                                                                             &acquire_d3d11_memory_block_ptrs,
+                                                                             &acquire_mutex_key_value_ptrs,
+                                                                             &acquire_timeout_ptrs,
+                                                                             &n_release_keys,
+                                                                             &release_d3d11_memory_block_ptrs,
+                                                                             &release_mutex_key_value_ptrs) )
+                {
+                    VkWin32KeyedMutexAcquireReleaseInfoKHR& info = m_submit_scratch.keyed_mutex_infos.at(n_submit_info);
 
-            info.acquireCount     = n_acquire_keys;
-            info.pAcquireKeys     = acquire_mutex_key_value_ptrs;
-            info.pAcquireSyncs    = acquire_sync_ptr;
-            info.pAcquireTimeouts = acquire_timeout_ptrs;
-            info.pNext            = nullptr;
-            info.pReleaseKeys     = release_mutex_key_value_ptrs;
-            info.pReleaseSyncs    = release_sync_ptr;
-            info.releaseCount     = n_release_keys;
-            info.sType            = VK_STRUCTURE_TYPE_WIN32_KEYED_MUTEX_ACQUIRE_RELEASE_INFO_KHR;
-
-            struct_chainer.append_struct(info);
-        }
-    }
-    #endif
+                    anvil_assert(n_acquire_keys + n_release_keys > 0);
 
-    if (in_submit_info.is_protected_submission() )
-    {
-        VkProtectedSubmitInfo submit_info;
+                    VkDeviceMemory* acquire_sync_ptr = (n_acquire_keys > 0) ? &m_submit_scratch.device_memory_blocks.at(device_memory_block_offset)
+                                                                            : nullptr;
+                    VkDeviceMemory* release_sync_ptr = (n_release_keys > 0) ? &m_submit_scratch.device_memory_blocks.at(device_memory_block_offset + n_acquire_keys)
+                                                                            : nullptr;
 
-        submit_info.pNext           = nullptr;
-        submit_info.protectedSubmit = VK_TRUE;
-        submit_info.sType           = VK_STRUCTURE_TYPE_PROTECTED_SUBMIT_INFO;
+                    for (uint32_t n_acquire_sync = 0;
+                                  n_acquire_sync < n_acquire_keys;
+                                ++n_acquire_sync)
+                    {
+                        acquire_sync_ptr[n_acquire_sync] = acquire_d3d11_memory_block_ptrs[n_acquire_sync]->get_memory();
+                    }
 
-        struct_chainer.append_struct(submit_info);
-    }
+                    for (uint32_t n_release_sync = 0;
+                                  n_release_sync < n_release_keys;
+                                ++n_release_sync)
+                    {
+                        release_sync_ptr[n_release_sync] = release_d3d11_memory_block_ptrs[n_release_sync]->get_memory();
+                    }
 
-    /* Go for it */
-    if (fence_ptr                         == nullptr &&
-        in_submit_info.get_should_block() )
-    {
-        fence_ptr         = m_submit_fence_ptr.get();
-        needs_fence_reset = true;
-    }
+                    info.acquireCount     = n_acquire_keys;
+                    info.pAcquireKeys     = acquire_mutex_key_value_ptrs;
+                    info.pAcquireSyncs    = acquire_sync_ptr;
+                    info.pAcquireTimeouts = acquire_timeout_ptrs;
+                    info.pNext            = submit_info.pNext;
+                    info.pReleaseKeys     = release_mutex_key_value_ptrs;
+                    info.pReleaseSyncs    = release_sync_ptr;
+                    info.releaseCount     = n_release_keys;
+                    info.sType            = VK_STRUCTURE_TYPE_WIN32_KEYED_MUTEX_ACQUIRE_RELEASE_INFO_KHR;
+
+                    submit_info.pNext           = &info;
+                    device_memory_block_offset += n_acquire_keys + n_release_keys;
+                }
+            }
+            #endif
 
-    switch (in_submit_info.get_type() )
-    {
-        case SubmissionType::MGPU:
-        {
-            submit_command_buffers_lock_unlock(in_submit_info.get_n_command_buffers     (),
-                                               in_submit_info.get_command_buffers_mgpu  (),
-                                               in_submit_info.get_n_signal_semaphores   (),
-                                               in_submit_info.get_signal_semaphores_mgpu(),
-                                               in_submit_info.get_n_wait_semaphores     (),
-                                               in_submit_info.get_wait_semaphores_mgpu  (),
-                                               fence_ptr,
-                                               true);
-
-            break;
+            if (current_submit_info.is_protected_submission() )
+            {
+                VkProtectedSubmitInfo& protected_submit_info = m_submit_scratch.protected_submit_infos.at(n_submit_info);
+
+                protected_submit_info.pNext           = submit_info.pNext;
+                protected_submit_info.protectedSubmit = VK_TRUE;
+                protected_submit_info.sType           = VK_STRUCTURE_TYPE_PROTECTED_SUBMIT_INFO;
+
+                submit_info.pNext = &protected_submit_info;
+            }
+
+            cmd_buffer_offset         += current_submit_info.get_n_command_buffers() + (is_bracketed ? 2 : 0);
+            has_bracketed_submissions |= is_bracketed;
+            semaphore_offset          += n_signal_semaphores + n_wait_semaphores;
         }
 
-        case SubmissionType::SGPU:
+        /* Go for it */
+        if (needs_fence_reset)
         {
-             submit_command_buffers_lock_unlock(in_submit_info.get_n_command_buffers     (),
-                                                in_submit_info.get_command_buffers_sgpu  (),
-                                                in_submit_info.get_n_signal_semaphores   (),
-                                                in_submit_info.get_signal_semaphores_sgpu(),
-                                                in_submit_info.get_n_wait_semaphores     (),
-                                                in_submit_info.get_wait_semaphores_sgpu  (),
-                                                fence_ptr,
-                                                true); /* in_should_lock */
-
-             break;
+            m_submit_fence_ptr->reset();
         }
 
-        default:
+        result = m_device_ptr->get_dispatch_table().vkQueueSubmit(m_queue,
+                                                                  in_n_submit_infos,
+                                                                 &m_submit_scratch.submit_infos.at(0),
+                                                                  (fence_ptr != nullptr) ? fence_ptr->get_fence()
+                                                                                         : VK_NULL_HANDLE);
+
+        if (m_frame_timing_recorder_ptr != nullptr &&
+            is_vk_call_successful(result) )
         {
-            anvil_assert_fail();
+            m_frame_timing_recorder_ptr->on_submission_issued();
         }
-     }
-
-     {
-        auto chain_ptr = struct_chainer.create_chain();
 
-        if (needs_fence_reset)
+        if (has_bracketed_submissions)
         {
-            m_submit_fence_ptr->reset();
+            utilization_tracker_ptr->end_submissions(is_vk_call_successful(result) );
         }
 
-         result = Anvil::Vulkan::vkQueueSubmit(m_queue,
-                                               1, /* submitCount */
-                                               chain_ptr->get_root_struct(),
-                                              (fence_ptr != nullptr) ? fence_ptr->get_fence()
-                                                                     : VK_NULL_HANDLE);
+        Anvil::PerfCounters::increment(Anvil::PerfCounters::Counter::QUEUE_SUBMISSIONS);
 
-        if (in_submit_info.get_should_block() )
+        if (should_block                        &&
+            is_vk_call_successful(result) )
         {
             /* Wait till initialization finishes GPU-side */
-            result = Anvil::Vulkan::vkWaitForFences(m_device_ptr->get_device_vk(),
-                                                    1, /* fenceCount */
-                                                    fence_ptr->get_fence_ptr(),
-                                                    VK_TRUE,     /* waitAll */
-                                                    in_submit_info.get_timeout() );
+            result = m_device_ptr->get_dispatch_table().vkWaitForFences(m_device_ptr->get_device_vk(),
+                                                                        1, /* fenceCount */
+                                                                        fence_ptr->get_fence_ptr(),
+                                                                        VK_TRUE, /* waitAll */
+                                                                        timeout);
         }
-     }
-
-     switch (in_submit_info.get_type() )
-     {
-         case SubmissionType::MGPU:
-         {
-             submit_command_buffers_lock_unlock(in_submit_info.get_n_command_buffers     (),
-                                                in_submit_info.get_command_buffers_mgpu  (),
-                                                in_submit_info.get_n_signal_semaphores   (),
-                                                in_submit_info.get_signal_semaphores_mgpu(),
-                                                in_submit_info.get_n_wait_semaphores     (),
-                                                in_submit_info.get_wait_semaphores_mgpu  (),
-                                                fence_ptr,
-                                                false); /* in_should_lock */
-
-             break;
-         }
-
-         case SubmissionType::SGPU:
-         {
-             submit_command_buffers_lock_unlock(in_submit_info.get_n_command_buffers     (),
-                                                in_submit_info.get_command_buffers_sgpu  (),
-                                                in_submit_info.get_n_signal_semaphores   (),
-                                                in_submit_info.get_signal_semaphores_sgpu(),
-                                                in_submit_info.get_n_wait_semaphores     (),
-                                                in_submit_info.get_wait_semaphores_sgpu  (),
-                                                fence_ptr,
-                                                false); /* in_should_lock */
-
-             break;
-         }
-
-         default:
-         {
-             anvil_assert_fail();
-         }
-     }
-
-     return (result == VK_SUCCESS);
+    }
+    submit_lock_unlock(in_n_submit_infos,
+                       in_submit_info_ptrs,
+                       fence_ptr,
+                       false); /* in_should_lock */
+
+end:
+    return (result == VK_SUCCESS);
 }
 
 void Anvil::Queue::submit_command_buffers_lock_unlock(uint32_t                         in_n_command_buffers,
@@ -1525,11 +1779,61 @@ void Anvil::Queue::submit_command_buffers_lock_unlock(uint32_t
     }
 }
 
+void Anvil::Queue::submit_lock_unlock(uint32_t                        in_n_submit_infos,
+                                      const Anvil::SubmitInfo* const* in_submit_info_ptrs,
+                                      Anvil::Fence*                   in_opt_fence_ptr,
+                                      bool                            in_should_lock)
+{
+    for (uint32_t n_submit_info = 0;
+                  n_submit_info < in_n_submit_infos;
+                ++n_submit_info)
+    {
+        const auto&   current_submit_info = *in_submit_info_ptrs[n_submit_info];
+        Anvil::Fence* fence_ptr           = (n_submit_info == in_n_submit_infos - 1) ? in_opt_fence_ptr : nullptr;
+
+        switch (current_submit_info.get_type() )
+        {
+            case SubmissionType::MGPU:
+            {
+                submit_command_buffers_lock_unlock(current_submit_info.get_n_command_buffers     (),
+                                                   current_submit_info.get_command_buffers_mgpu  (),
+                                                   current_submit_info.get_n_signal_semaphores   (),
+                                                   current_submit_info.get_signal_semaphores_mgpu(),
+                                                   current_submit_info.get_n_wait_semaphores     (),
+                                                   current_submit_info.get_wait_semaphores_mgpu  (),
+                                                   fence_ptr,
+                                                   in_should_lock);
+
+                break;
+            }
+
+            case SubmissionType::SGPU:
+            {
+                submit_command_buffers_lock_unlock(current_submit_info.get_n_command_buffers     (),
+                                                   current_submit_info.get_command_buffers_sgpu  (),
+                                                   current_submit_info.get_n_signal_semaphores   (),
+                                                   current_submit_info.get_signal_semaphores_sgpu(),
+                                                   current_submit_info.get_n_wait_semaphores     (),
+                                                   current_submit_info.get_wait_semaphores_sgpu  (),
+                                                   fence_ptr,
+                                                   in_should_lock);
+
+                break;
+            }
+
+            default:
+            {
+                anvil_assert_fail();
+            }
+        }
+    }
+}
+
 void Anvil::Queue::wait_idle()
 {
     lock();
     {
-        Anvil::Vulkan::vkQueueWaitIdle(m_queue);
+        m_device_ptr->get_dispatch_table().vkQueueWaitIdle(m_queue);
     }
     unlock();
 }
\ No newline at end of file
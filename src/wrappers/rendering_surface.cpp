@@ -62,7 +62,7 @@ Anvil::RenderingSurface::~RenderingSurface()
 
             instance_ptr->get_extension_khr_surface_entrypoints().vkDestroySurfaceKHR(instance_ptr->get_instance_vk(),
                                                                                       m_surface,
-                                                                                      nullptr /* pAllocator */);
+                                                                                      instance_ptr->get_allocation_callbacks_vk() );
         }
         unlock();
 
@@ -400,7 +400,7 @@ bool Anvil::RenderingSurface::init()
 
             result = instance_ptr->get_extension_khr_win32_surface_entrypoints().vkCreateWin32SurfaceKHR(instance_ptr->get_instance_vk(),
                                                                                                         &surface_create_info,
-                                                                                                         nullptr, /* pAllocator */
+                                                                                                         instance_ptr->get_allocation_callbacks_vk(),
                                                                                                         &m_surface);
         }
         #endif
@@ -416,7 +416,7 @@ bool Anvil::RenderingSurface::init()
 
             result = instance_ptr->get_extension_khr_xcb_surface_entrypoints().vkCreateXcbSurfaceKHR(instance_ptr->get_instance_vk(),
                                                                                                     &surface_create_info,
-                                                                                                     nullptr, /* pAllocator */
+                                                                                                     instance_ptr->get_allocation_callbacks_vk(),
                                                                                                     &m_surface);
             }
         #endif
@@ -45,7 +45,7 @@ Anvil::SamplerYCbCrConversion::~SamplerYCbCrConversion()
         {
             entrypoints.vkDestroySamplerYcbcrConversionKHR(device_ptr->get_device_vk(),
                                                            m_sampler_ycbcr_conversion_vk,
-                                                           nullptr); /* pAllocator */
+                                                           device_ptr->get_allocation_callbacks_vk() );
         }
         unlock();
 
@@ -93,7 +93,7 @@ bool Anvil::SamplerYCbCrConversion::init()
 
     if (is_vk_call_successful(entrypoints.vkCreateSamplerYcbcrConversionKHR(m_device_ptr->get_device_vk(),
                                                                            &create_info,
-                                                                            nullptr, /* pAllocator */
+                                                                            m_device_ptr->get_allocation_callbacks_vk(),
                                                                            &m_sampler_ycbcr_conversion_vk) ))
     {
         result = true;
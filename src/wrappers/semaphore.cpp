@@ -73,6 +73,36 @@ Anvil::SemaphoreUniquePtr Anvil::Semaphore::create(Anvil::SemaphoreCreateInfoUni
     return result_ptr;
 }
 
+/* Please see header for specification */
+bool Anvil::Semaphore::get_counter_value(uint64_t* out_value_ptr) const
+{
+    bool     result    = false;
+    VkResult result_vk = VK_ERROR_INITIALIZATION_FAILED;
+
+    anvil_assert(out_value_ptr != nullptr);
+
+    if (!is_timeline() )
+    {
+        anvil_assert(is_timeline() );
+
+        goto end;
+    }
+
+    lock();
+    {
+        result_vk = m_device_ptr->get_extension_khr_timeline_semaphore_entrypoints().vkGetSemaphoreCounterValueKHR(m_device_ptr->get_device_vk(),
+                                                                                                                  m_semaphore,
+                                                                                                                  out_value_ptr);
+    }
+    unlock();
+
+    anvil_assert_vk_call_succeeded(result_vk);
+
+    result = is_vk_call_successful(result_vk);
+end:
+    return result;
+}
+
 /* Please see header for specification */
 Anvil::ExternalHandleUniquePtr Anvil::Semaphore::export_to_external_handle(const Anvil::ExternalSemaphoreHandleTypeFlagBits& in_semaphore_handle_type)
 {
@@ -266,6 +296,12 @@ end:
     return result;
 }
 
+/* Please see header for specification */
+bool Anvil::Semaphore::is_timeline() const
+{
+    return (m_create_info_ptr->get_semaphore_type() == Anvil::SemaphoreType::TIMELINE);
+}
+
 /** Destroys the underlying Vulkan Semaphore instance. */
 void Anvil::Semaphore::release_semaphore()
 {
@@ -273,9 +309,9 @@ void Anvil::Semaphore::release_semaphore()
     {
         lock();
         {
-            Anvil::Vulkan::vkDestroySemaphore(m_device_ptr->get_device_vk(),
-                                              m_semaphore,
-                                              nullptr /* pAllocator */);
+            m_device_ptr->get_dispatch_table().vkDestroySemaphore(m_device_ptr->get_device_vk(),
+                                                                  m_semaphore,
+                                                                  m_device_ptr->get_allocation_callbacks_vk() );
         }
         unlock();
 
@@ -304,6 +340,16 @@ bool Anvil::Semaphore::reset()
         }
     }
 
+    if (is_timeline() )
+    {
+        if (!m_device_ptr->get_extension_info()->khr_timeline_semaphore() )
+        {
+            anvil_assert(m_device_ptr->get_extension_info()->khr_timeline_semaphore() );
+
+            goto end;
+        }
+    }
+
     /* Spawn a new semaphore */
     {
         VkSemaphoreCreateInfo semaphore_create_info;
@@ -326,6 +372,18 @@ bool Anvil::Semaphore::reset()
         struct_chainer.append_struct(create_info);
     }
 
+    if (is_timeline() )
+    {
+        VkSemaphoreTypeCreateInfoKHR type_create_info;
+
+        type_create_info.initialValue  = m_create_info_ptr->get_initial_value();
+        type_create_info.pNext         = nullptr;
+        type_create_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+        type_create_info.sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+
+        struct_chainer.append_struct(type_create_info);
+    }
+
     #if defined(_WIN32)
     {
         const Anvil::ExternalNTHandleInfo* nt_handle_info_ptr = nullptr;
@@ -358,10 +416,10 @@ bool Anvil::Semaphore::reset()
         goto end;
     }
 
-    result = Anvil::Vulkan::vkCreateSemaphore(m_device_ptr->get_device_vk(),
-                                              struct_chain_ptr->get_root_struct(),
-                                              nullptr, /* pAllocator */
-                                             &m_semaphore);
+    result = m_device_ptr->get_dispatch_table().vkCreateSemaphore(m_device_ptr->get_device_vk(),
+                                                                  struct_chain_ptr->get_root_struct(),
+                                                                  m_device_ptr->get_allocation_callbacks_vk(),
+                                                                 &m_semaphore);
 
     anvil_assert_vk_call_succeeded(result);
     if (is_vk_call_successful(result) )
@@ -372,3 +430,109 @@ bool Anvil::Semaphore::reset()
 end:
     return is_vk_call_successful(result);
 }
+
+/* Please see header for specification */
+bool Anvil::Semaphore::signal(uint64_t in_value)
+{
+    bool                     result    = false;
+    VkResult                 result_vk = VK_ERROR_INITIALIZATION_FAILED;
+    VkSemaphoreSignalInfoKHR signal_info;
+
+    if (!is_timeline() )
+    {
+        anvil_assert(is_timeline() );
+
+        goto end;
+    }
+
+    signal_info.pNext     = nullptr;
+    signal_info.semaphore = m_semaphore;
+    signal_info.sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO_KHR;
+    signal_info.value     = in_value;
+
+    lock();
+    {
+        result_vk = m_device_ptr->get_extension_khr_timeline_semaphore_entrypoints().vkSignalSemaphoreKHR(m_device_ptr->get_device_vk(),
+                                                                                                         &signal_info);
+    }
+    unlock();
+
+    anvil_assert_vk_call_succeeded(result_vk);
+
+    result = is_vk_call_successful(result_vk);
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::Semaphore::wait(uint64_t in_value,
+                            uint64_t in_timeout)
+{
+    Anvil::Semaphore* this_ptr = this;
+
+    return wait_semaphores(1, /* in_n_semaphores */
+                          &this_ptr,
+                          &in_value,
+                           true, /* in_wait_all */
+                           in_timeout);
+}
+
+/* Please see header for specification */
+bool Anvil::Semaphore::wait_semaphores(uint32_t                 in_n_semaphores,
+                                       Anvil::Semaphore* const* in_semaphore_ptrs,
+                                       const uint64_t*          in_values,
+                                       bool                     in_wait_all,
+                                       uint64_t                 in_timeout,
+                                       VkResult*                out_opt_result_ptr)
+{
+    const Anvil::BaseDevice* device_ptr = nullptr;
+    bool                     result     = true;
+    VkResult                 result_vk  = VK_SUCCESS;
+    std::vector<VkSemaphore> semaphores_vk(in_n_semaphores);
+    VkSemaphoreWaitInfoKHR   wait_info;
+
+    if (in_n_semaphores == 0)
+    {
+        goto end;
+    }
+
+    for (uint32_t n_semaphore = 0;
+                  n_semaphore < in_n_semaphores;
+                ++n_semaphore)
+    {
+        Anvil::Semaphore* current_semaphore_ptr = in_semaphore_ptrs[n_semaphore];
+
+        anvil_assert(current_semaphore_ptr->is_timeline() );
+        anvil_assert(device_ptr == nullptr                         ||
+                     device_ptr == current_semaphore_ptr->m_device_ptr);
+
+        device_ptr                 = current_semaphore_ptr->m_device_ptr;
+        semaphores_vk[n_semaphore] = current_semaphore_ptr->m_semaphore;
+    }
+
+    wait_info.flags          = (in_wait_all) ? 0u : static_cast<VkSemaphoreWaitFlagsKHR>(VK_SEMAPHORE_WAIT_ANY_BIT_KHR);
+    wait_info.pNext          = nullptr;
+    wait_info.pSemaphores    = &semaphores_vk.at(0);
+    wait_info.pValues        = in_values;
+    wait_info.semaphoreCount = in_n_semaphores;
+    wait_info.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+
+    /* NOTE: Host waits do not require external synchronization of the semaphores, so no locks are taken here. */
+    result_vk = device_ptr->get_extension_khr_timeline_semaphore_entrypoints().vkWaitSemaphoresKHR(device_ptr->get_device_vk(),
+                                                                                                   &wait_info,
+                                                                                                   in_timeout);
+
+    if (result_vk != VK_TIMEOUT)
+    {
+        anvil_assert_vk_call_succeeded(result_vk);
+    }
+
+    result = (result_vk == VK_SUCCESS);
+end:
+    if (out_opt_result_ptr != nullptr)
+    {
+        *out_opt_result_ptr = result_vk;
+    }
+
+    return result;
+}
@@ -40,7 +40,8 @@ Anvil::ShaderModule::ShaderModule(const Anvil::BaseDevice*    in_device_ptr,
     :DebugMarkerSupportProvider(in_device_ptr,
                                 Anvil::ObjectType::SHADER_MODULE),
      MTSafetySupportProvider   (in_mt_safe),
-     m_device_ptr              (in_device_ptr)
+     m_device_ptr              (in_device_ptr),
+     m_spirv_blob_hash         (0)
 {
     bool              result                 = false;
     const char*       shader_spirv_blob      = in_spirv_generator_ptr->get_spirv_blob();
@@ -84,6 +85,7 @@ Anvil::ShaderModule::ShaderModule(const Anvil::BaseDevice* in_device_ptr,
      m_device_ptr              (in_device_ptr),
      m_fs_entrypoint_name      (in_fs_entrypoint_name),
      m_gs_entrypoint_name      (in_gs_entrypoint_name),
+     m_spirv_blob_hash         (0),
      m_tc_entrypoint_name      (in_tc_entrypoint_name),
      m_te_entrypoint_name      (in_te_entrypoint_name),
      m_vs_entrypoint_name      (in_vs_entrypoint_name)
@@ -277,9 +279,9 @@ void Anvil::ShaderModule::destroy()
     {
         lock();
         {
-            Anvil::Vulkan::vkDestroyShaderModule(m_device_ptr->get_device_vk(),
-                                                 m_module,
-                                                 nullptr /* pAllocator */);
+            m_device_ptr->get_dispatch_table().vkDestroyShaderModule(m_device_ptr->get_device_vk(),
+                                                                     m_module,
+                                                                     m_device_ptr->get_allocation_callbacks_vk() );
         }
         unlock();
 
@@ -324,10 +326,10 @@ bool Anvil::ShaderModule::init_from_spirv_blob(const char* in_spirv_blob,
     shader_module_create_info.pNext    = nullptr;
     shader_module_create_info.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
 
-    result_vk = Anvil::Vulkan::vkCreateShaderModule(m_device_ptr->get_device_vk(),
-                                                   &shader_module_create_info,
-                                                    nullptr, /* pAllocator */
-                                                   &m_module);
+    result_vk = m_device_ptr->get_dispatch_table().vkCreateShaderModule(m_device_ptr->get_device_vk(),
+                                                                       &shader_module_create_info,
+                                                                        m_device_ptr->get_allocation_callbacks_vk(),
+                                                                       &m_module);
 
     anvil_assert_vk_call_succeeded(result_vk);
     if (is_vk_call_successful(result_vk) )
@@ -339,6 +341,9 @@ bool Anvil::ShaderModule::init_from_spirv_blob(const char* in_spirv_blob,
         memcpy(&m_spirv_blob.at(0),
                in_spirv_blob,
                in_n_spirv_blob_bytes);
+
+        m_spirv_blob_hash = Anvil::Utils::hash64(in_spirv_blob,
+                                                 in_n_spirv_blob_bytes);
     }
 
     /* Sign for device destruction notification, in which case we need to destroy the shader module. */
@@ -21,16 +21,21 @@
 //
 
 #include "misc/debug.h"
+#include "misc/deferred_deletion_queue.h"
 #include "misc/dummy_window.h"
 #include "misc/fence_create_info.h"
+#include "misc/frame_timing_recorder.h"
 #include "misc/image_create_info.h"
 #include "misc/image_view_create_info.h"
 #include "misc/object_tracker.h"
+#include "misc/semaphore_create_info.h"
 #include "misc/struct_chainer.h"
 #include "misc/swapchain_create_info.h"
+#include "misc/tracing.h"
 #include "misc/window.h"
 #include "wrappers/command_buffer.h"
 #include "wrappers/command_pool.h"
+#include "wrappers/descriptor_set.h"
 #include "wrappers/instance.h"
 #include "wrappers/semaphore.h"
 #include "wrappers/swapchain.h"
@@ -42,6 +47,9 @@ Anvil::Swapchain::Swapchain(Anvil::SwapchainCreateInfoUniquePtr in_create_info_p
      MTSafetySupportProvider                        (Anvil::Utils::convert_mt_safety_enum_to_boolean(in_create_info_ptr->get_mt_safety(),
                                                                                                      in_create_info_ptr->get_device   () )),
      m_destroy_swapchain_before_parent_window_closes(true),
+     m_frame_timing_recorder_ptr                    (nullptr),
+     m_headless_timeline_value                      (0),
+     m_is_retired                                   (false),
      m_last_acquired_image_index                    (UINT32_MAX),
      m_n_acquire_counter                            (0),
      m_n_acquire_counter_rounded                    (0),
@@ -71,6 +79,13 @@ Anvil::Swapchain::~Swapchain()
 
     destroy_swapchain();
 
+    if (m_headless_timeline_semaphore_ptr != nullptr)
+    {
+        /* Make sure the GPU is done with all headless present ops before the semaphore goes away */
+        m_headless_timeline_semaphore_ptr->wait(m_headless_timeline_value);
+        m_headless_timeline_semaphore_ptr.reset();
+    }
+
     m_image_ptrs.clear               ();
     m_image_available_fence_ptr.reset();
     m_image_view_ptrs.clear          ();
@@ -98,6 +113,45 @@ Anvil::Swapchain::~Swapchain()
 Anvil::SwapchainOperationErrorCode Anvil::Swapchain::acquire_image(Anvil::Semaphore* in_opt_semaphore_ptr,
                                                                    uint32_t*         out_result_index_ptr,
                                                                    bool              in_should_block)
+{
+    ANVIL_TRACE_SPAN("Swapchain::acquire_image");
+
+    return acquire_image_for_all_devices(in_opt_semaphore_ptr,
+                                         out_result_index_ptr,
+                                         in_should_block,
+                                         UINT64_MAX); /* in_timeout */
+}
+
+/** Please see header for specification */
+Anvil::SwapchainOperationErrorCode Anvil::Swapchain::acquire_image(Anvil::Semaphore*                   in_opt_semaphore_ptr,
+                                                                   uint32_t                            in_n_mgpu_physical_devices,
+                                                                   const Anvil::PhysicalDevice* const* in_mgpu_physical_device_ptrs,
+                                                                   uint32_t*                           out_result_index_ptr,
+                                                                   bool                                in_should_block)
+{
+    ANVIL_TRACE_SPAN("Swapchain::acquire_image");
+
+    return acquire_image_internal(in_opt_semaphore_ptr,
+                                  in_n_mgpu_physical_devices,
+                                  in_mgpu_physical_device_ptrs,
+                                  out_result_index_ptr,
+                                  in_should_block,
+                                  UINT64_MAX); /* in_timeout */
+}
+
+/** Acquires a new swapchain image, using all physical devices the swapchain's device has been created for.
+ *
+ *  @param in_opt_semaphore_ptr Please see acquire_image() for specification.
+ *  @param out_result_index_ptr Please see acquire_image() for specification.
+ *  @param in_should_block      Please see acquire_image() for specification.
+ *  @param in_timeout           Timeout to pass to vkAcquireNextImage*KHR(), expressed in nanoseconds.
+ *
+ *  @return As per acquire_image().
+ */
+Anvil::SwapchainOperationErrorCode Anvil::Swapchain::acquire_image_for_all_devices(Anvil::Semaphore* in_opt_semaphore_ptr,
+                                                                                   uint32_t*         out_result_index_ptr,
+                                                                                   bool              in_should_block,
+                                                                                   uint64_t          in_timeout)
 {
     uint32_t                           result        = UINT32_MAX;
     Anvil::SwapchainOperationErrorCode result_status = Anvil::SwapchainOperationErrorCode::SUCCESS;
@@ -119,11 +173,12 @@ Anvil::SwapchainOperationErrorCode Anvil::Swapchain::acquire_image(Anvil::Semaph
                 physical_devices[n_physical_device] = mgpu_device_ptr->get_physical_device(n_physical_device);
             }
 
-            result_status = acquire_image(in_opt_semaphore_ptr,
-                                          n_physical_devices,
-                                          physical_devices,
-                                         &result,
-                                          in_should_block);
+            result_status = acquire_image_internal(in_opt_semaphore_ptr,
+                                                   n_physical_devices,
+                                                   physical_devices,
+                                                  &result,
+                                                   in_should_block,
+                                                   in_timeout);
 
             break;
         }
@@ -135,11 +190,12 @@ Anvil::SwapchainOperationErrorCode Anvil::Swapchain::acquire_image(Anvil::Semaph
 
             physical_device_ptr = sgpu_device_ptr->get_physical_device();
 
-            result_status = acquire_image(in_opt_semaphore_ptr,
-                                          1, /* n_mgpu_physical_devices */
-                                         &physical_device_ptr,
-                                         &result,
-                                          in_should_block);
+            result_status = acquire_image_internal(in_opt_semaphore_ptr,
+                                                   1, /* n_mgpu_physical_devices */
+                                                  &physical_device_ptr,
+                                                  &result,
+                                                   in_should_block,
+                                                   in_timeout);
 
             break;
         }
@@ -155,21 +211,43 @@ Anvil::SwapchainOperationErrorCode Anvil::Swapchain::acquire_image(Anvil::Semaph
     return result_status;
 }
 
-/** Please see header for specification */
-Anvil::SwapchainOperationErrorCode Anvil::Swapchain::acquire_image(Anvil::Semaphore*                   in_opt_semaphore_ptr,
-                                                                   uint32_t                            in_n_mgpu_physical_devices,
-                                                                   const Anvil::PhysicalDevice* const* in_mgpu_physical_device_ptrs,
-                                                                   uint32_t*                           out_result_index_ptr,
-                                                                   bool                                in_should_block)
+/** Acquires a new swapchain image.
+ *
+ *  @param in_opt_semaphore_ptr         Please see acquire_image() for specification.
+ *  @param in_n_mgpu_physical_devices   Please see acquire_image() for specification.
+ *  @param in_mgpu_physical_device_ptrs Please see acquire_image() for specification.
+ *  @param out_result_index_ptr         Please see acquire_image() for specification.
+ *  @param in_should_block              Please see acquire_image() for specification.
+ *  @param in_timeout                   Timeout to pass to vkAcquireNextImage*KHR(), expressed in nanoseconds.
+ *                                      Ignored for off-screen swapchains.
+ *
+ *  @return As per acquire_image(). If no image could be acquired within @param in_timeout, NOT_READY or TIMEOUT
+ *          is returned, in which case *out_result_index_ptr is set to UINT32_MAX.
+ */
+Anvil::SwapchainOperationErrorCode Anvil::Swapchain::acquire_image_internal(Anvil::Semaphore*                   in_opt_semaphore_ptr,
+                                                                            uint32_t                            in_n_mgpu_physical_devices,
+                                                                            const Anvil::PhysicalDevice* const* in_mgpu_physical_device_ptrs,
+                                                                            uint32_t*                           out_result_index_ptr,
+                                                                            bool                                in_should_block,
+                                                                            uint64_t                            in_timeout)
 {
     const Anvil::DeviceType device_type                    = m_device_ptr->get_type();
 
+    const uint64_t                     acquire_start_time             = (m_frame_timing_recorder_ptr != nullptr) ? m_frame_timing_recorder_ptr->get_time() : 0;
     uint32_t                           result                         = UINT32_MAX;
     Anvil::SwapchainOperationErrorCode result_status                  = Anvil::SwapchainOperationErrorCode::SUCCESS;
     const WindowPlatform               window_platform                = m_create_info_ptr->get_window()->get_platform();
     const bool                         is_offscreen_rendering_enabled = (window_platform   == WINDOW_PLATFORM_DUMMY                     ||
                                                                          window_platform   == WINDOW_PLATFORM_DUMMY_WITH_PNG_SNAPSHOTS);
 
+    if (m_is_retired)
+    {
+        /* Retired swapchains must not hand out any more images. Please see recreate() */
+        result_status = Anvil::SwapchainOperationErrorCode::OUT_OF_DATE;
+
+        goto end;
+    }
+
     if (!is_offscreen_rendering_enabled)
     {
         VkFence fence_handle = VK_NULL_HANDLE;
@@ -195,7 +273,7 @@ Anvil::SwapchainOperationErrorCode Anvil::Swapchain::acquire_image(Anvil::Semaph
 
                 result_status = static_cast<Anvil::SwapchainOperationErrorCode>(khr_swapchain_entrypoints.vkAcquireNextImageKHR(m_device_ptr->get_device_vk(),
                                                                                                                                 m_swapchain,
-                                                                                                                                UINT64_MAX,
+                                                                                                                                in_timeout,
                                                                                                                                 (in_opt_semaphore_ptr != nullptr) ? in_opt_semaphore_ptr->get_semaphore() : VK_NULL_HANDLE,
                                                                                                                                 fence_handle,
                                                                                                                                &result) );
@@ -214,7 +292,7 @@ Anvil::SwapchainOperationErrorCode Anvil::Swapchain::acquire_image(Anvil::Semaph
                 info.semaphore  = (in_opt_semaphore_ptr != nullptr) ? in_opt_semaphore_ptr->get_semaphore() : VK_NULL_HANDLE;
                 info.sType      = VK_STRUCTURE_TYPE_ACQUIRE_NEXT_IMAGE_INFO_KHR;
                 info.swapchain  = m_swapchain;
-                info.timeout    = UINT64_MAX;
+                info.timeout    = in_timeout;
 
                 for (uint32_t n_physical_device = 0;
                               n_physical_device < in_n_mgpu_physical_devices;
@@ -233,13 +311,20 @@ Anvil::SwapchainOperationErrorCode Anvil::Swapchain::acquire_image(Anvil::Semaph
                                                                                                                                    &result) );
             }
 
+            if (result_status == Anvil::SwapchainOperationErrorCode::NOT_READY ||
+                result_status == Anvil::SwapchainOperationErrorCode::TIMEOUT)
+            {
+                /* No image has been acquired, so the fence is never going to be signalled */
+                fence_handle = VK_NULL_HANDLE;
+            }
+
             if (fence_handle != VK_NULL_HANDLE)
             {
-                result_status = static_cast<Anvil::SwapchainOperationErrorCode>(Anvil::Vulkan::vkWaitForFences(m_device_ptr->get_device_vk(),
-                                                                                1, /* fenceCount */
-                                                                               &fence_handle,
-                                                                                VK_TRUE, /* waitAll */
-                                                                                UINT64_MAX) );
+                result_status = static_cast<Anvil::SwapchainOperationErrorCode>(m_device_ptr->get_dispatch_table().vkWaitForFences(m_device_ptr->get_device_vk(),
+                                                                                                    1, /* fenceCount */
+                                                                                                   &fence_handle,
+                                                                                                    VK_TRUE, /* waitAll */
+                                                                                                    UINT64_MAX) );
             }
         }
         unlock();
@@ -251,6 +336,62 @@ Anvil::SwapchainOperationErrorCode Anvil::Swapchain::acquire_image(Anvil::Semaph
         }
     }
     else
+    if (m_headless_timeline_semaphore_ptr != nullptr)
+    {
+        uint64_t image_available_value = 0;
+
+        lock();
+        {
+            result                = m_n_acquire_counter_rounded;
+            image_available_value = m_headless_image_available_values.at(result);
+        }
+        unlock();
+
+        /* The image becomes available once the GPU executes the present op which last used it. Only wait
+         * for that op, instead of for the whole device to idle. */
+        if (in_should_block)
+        {
+            if (image_available_value != 0)
+            {
+                m_headless_timeline_semaphore_ptr->wait(image_available_value);
+            }
+        }
+
+        if (in_opt_semaphore_ptr != nullptr)
+        {
+            auto semaphore_to_wait_on_ptr = m_headless_timeline_semaphore_ptr.get();
+
+            /* We need to set the semaphore manually in this scenario. If the image may still be in use, make the
+             * GPU wait for it, so that the CPU can run ahead. */
+            if (!in_should_block            &&
+                image_available_value != 0)
+            {
+                static const Anvil::PipelineStageFlags dst_stage_mask        (Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT);
+                const uint64_t                         signal_semaphore_value(0); /* ignored for binary semaphores */
+                auto                                   submit_info           (Anvil::SubmitInfo::create_signal_wait(1, /* in_n_semaphores_to_signal  */
+                                                                                                               &in_opt_semaphore_ptr,
+                                                                                                                1, /* in_n_semaphores_to_wait_on */
+                                                                                                               &semaphore_to_wait_on_ptr,
+                                                                                                               &dst_stage_mask,
+                                                                                                                false) ); /* in_should_block */
+
+                submit_info.set_timeline_semaphore_values(&signal_semaphore_value,
+                                                          1, /* in_n_signal_semaphore_values */
+                                                         &image_available_value,
+                                                          1); /* in_n_wait_semaphore_values */
+
+                m_device_ptr->get_universal_queue(0)->submit(submit_info);
+            }
+            else
+            {
+                m_device_ptr->get_universal_queue(0)->submit(
+                    Anvil::SubmitInfo::create_signal(1,       /* n_semaphores_to_signal */
+                                                    &in_opt_semaphore_ptr)
+                );
+            }
+        }
+    }
+    else
     {
         if (in_should_block)
         {
@@ -269,15 +410,112 @@ Anvil::SwapchainOperationErrorCode Anvil::Swapchain::acquire_image(Anvil::Semaph
         result = m_n_acquire_counter_rounded;
     }
 
+    if (result_status == Anvil::SwapchainOperationErrorCode::NOT_READY ||
+        result_status == Anvil::SwapchainOperationErrorCode::TIMEOUT)
+    {
+        *out_result_index_ptr = UINT32_MAX;
+
+        goto end;
+    }
+
     m_n_acquire_counter++;
     m_n_acquire_counter_rounded = (m_n_acquire_counter_rounded + 1) % m_create_info_ptr->get_n_images();
 
     m_last_acquired_image_index = result;
     *out_result_index_ptr       = result;
 
+    if (m_frame_timing_recorder_ptr != nullptr)
+    {
+        m_frame_timing_recorder_ptr->on_image_acquired(acquire_start_time,
+                                                       result);
+    }
+
+end:
     return result_status;
 }
 
+/** Please see header for specification */
+Anvil::SwapchainOperationErrorCode Anvil::Swapchain::acquire_image_nonblocking(Anvil::Semaphore* in_semaphore_ptr,
+                                                                               uint32_t*         out_result_index_ptr,
+                                                                               uint64_t          in_timeout)
+{
+    anvil_assert(in_semaphore_ptr != nullptr);
+
+    return acquire_image_for_all_devices(in_semaphore_ptr,
+                                         out_result_index_ptr,
+                                         false, /* in_should_block */
+                                         in_timeout);
+}
+
+/** Please see header for specification */
+bool Anvil::Swapchain::bind_storage_image(uint32_t                   in_n_swapchain_image,
+                                          Anvil::DescriptorSet*      in_descriptor_set_ptr,
+                                          Anvil::BindingIndex        in_binding_index,
+                                          Anvil::BindingElementIndex in_binding_element_index) const
+{
+    bool result = false;
+
+    anvil_assert(in_descriptor_set_ptr != nullptr);
+    anvil_assert(in_n_swapchain_image  <  m_n_images);
+
+    if (!supports_storage_usage() )
+    {
+        anvil_assert(supports_storage_usage() );
+
+        goto end;
+    }
+
+    {
+        const Anvil::DescriptorSet::StorageImageBindingElement element(Anvil::ImageLayout::GENERAL,
+                                                                       m_image_view_ptrs.at(in_n_swapchain_image).get() );
+
+        result = in_descriptor_set_ptr->set_binding_array_items(in_binding_index,
+                                                                Anvil::BindingElementArrayRange(in_binding_element_index,
+                                                                                                1), /* NumberOfBindingElements */
+                                                               &element);
+    }
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::Swapchain::bind_storage_images(Anvil::DescriptorSet* in_descriptor_set_ptr,
+                                           Anvil::BindingIndex   in_binding_index) const
+{
+    std::vector<Anvil::DescriptorSet::StorageImageBindingElement> elements;
+    bool                                                          result = false;
+
+    anvil_assert(in_descriptor_set_ptr != nullptr);
+
+    if (!supports_storage_usage() )
+    {
+        anvil_assert(supports_storage_usage() );
+
+        goto end;
+    }
+
+    elements.reserve(m_n_images);
+
+    for (uint32_t n_image = 0;
+                  n_image < m_n_images;
+                ++n_image)
+    {
+        elements.push_back(
+            Anvil::DescriptorSet::StorageImageBindingElement(Anvil::ImageLayout::GENERAL,
+                                                             m_image_view_ptrs.at(n_image).get() )
+        );
+    }
+
+    result = in_descriptor_set_ptr->set_binding_array_items(in_binding_index,
+                                                            Anvil::BindingElementArrayRange(0, /* StartBindingElementIndex */
+                                                                                            m_n_images),
+                                                           &elements.at(0) );
+
+end:
+    return result;
+}
+
 /** Please see header for specification */
 Anvil::SwapchainUniquePtr Anvil::Swapchain::create(Anvil::SwapchainCreateInfoUniquePtr in_create_info_ptr)
 {
@@ -327,7 +565,7 @@ void Anvil::Swapchain::destroy_swapchain()
 
             khr_swapchain_entrypoints.vkDestroySwapchainKHR(m_device_ptr->get_device_vk(),
                                                             m_swapchain,
-                                                            nullptr /* pAllocator */);
+                                                            m_device_ptr->get_allocation_callbacks_vk() );
         }
 
         m_swapchain = VK_NULL_HANDLE;
@@ -335,6 +573,27 @@ void Anvil::Swapchain::destroy_swapchain()
     unlock();
 }
 
+/** Please see header for specification */
+Anvil::Semaphore* Anvil::Swapchain::get_headless_present_semaphore(uint32_t  in_n_swapchain_image,
+                                                                   uint64_t* out_signal_value_ptr)
+{
+    Anvil::Semaphore* result_ptr = m_headless_timeline_semaphore_ptr.get();
+
+    if (result_ptr != nullptr)
+    {
+        anvil_assert(in_n_swapchain_image < m_n_images);
+
+        lock();
+        {
+            *out_signal_value_ptr                                   = ++m_headless_timeline_value;
+            m_headless_image_available_values[in_n_swapchain_image] = m_headless_timeline_value;
+        }
+        unlock();
+    }
+
+    return result_ptr;
+}
+
 /** Please see header for specification */
 Anvil::Image* Anvil::Swapchain::get_image(uint32_t in_n_swapchain_image) const
 {
@@ -536,7 +795,7 @@ bool Anvil::Swapchain::init()
         {
             result = khr_swapchain_entrypoints.vkCreateSwapchainKHR(m_device_ptr->get_device_vk(),
                                                                     struct_chain_ptr->get_root_struct(),
-                                                                    nullptr, /* pAllocator */
+                                                                    m_device_ptr->get_allocation_callbacks_vk(),
                                                                    &m_swapchain);
         }
         parent_surface_ptr->unlock();
@@ -570,6 +829,23 @@ bool Anvil::Swapchain::init()
         m_create_info_ptr->set_usage_flags(m_create_info_ptr->get_usage_flags() | Anvil::ImageUsageFlagBits::TRANSFER_SRC_BIT);
 
         m_n_images = m_create_info_ptr->get_n_images();
+
+        /* If timeline semaphores are available, track image availability with a timeline semaphore, which is signalled
+         * by present ops. This lets acquire_image() make the GPU wait for the image to retire, rather than idle the device. */
+        if (m_device_ptr->get_extension_info()->khr_timeline_semaphore() )
+        {
+            auto create_info_ptr = Anvil::SemaphoreCreateInfo::create(m_device_ptr);
+
+            create_info_ptr->set_mt_safety(Anvil::Utils::convert_boolean_to_mt_safety_enum(is_mt_safe() ) );
+            create_info_ptr->set_timeline (0); /* in_initial_value */
+
+            m_headless_timeline_semaphore_ptr = Anvil::Semaphore::create(std::move(create_info_ptr) );
+
+            anvil_assert(m_headless_timeline_semaphore_ptr != nullptr);
+
+            m_headless_image_available_values.resize(m_n_images,
+                                                      0);
+        }
     }
 
     /* Adjust capacity of m_image_ptrs and m_image_view_ptrs to the number of swapchain images actually created. */
@@ -794,6 +1070,134 @@ void Anvil::Swapchain::on_present_request_issued(Anvil::CallbackArgument* in_cal
     }
 }
 
+/** Please see header for specification */
+bool Anvil::Swapchain::record_storage_image_barrier(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                                    uint32_t                  in_n_swapchain_image,
+                                                    bool                      in_before_compute_pass) const
+{
+    const Anvil::WindowPlatform        window_platform = m_create_info_ptr->get_window()->get_platform();
+    const bool                         is_offscreen    = (window_platform == WINDOW_PLATFORM_DUMMY                     ||
+                                                          window_platform == WINDOW_PLATFORM_DUMMY_WITH_PNG_SNAPSHOTS);
+    const Anvil::ImageLayout           present_layout  = (is_offscreen) ? Anvil::ImageLayout::GENERAL
+                                                                        : Anvil::ImageLayout::PRESENT_SRC_KHR;
+    const Anvil::ImageSubresourceRange image_range     =
+    {
+        Anvil::ImageAspectFlagBits::COLOR_BIT,
+        0, /* base_mip_level   */
+        1, /* level_count      */
+        0, /* base_array_layer */
+        1  /* layer_count      */
+    };
+
+    anvil_assert(in_cmd_buffer_ptr    != nullptr);
+    anvil_assert(in_n_swapchain_image <  m_n_images);
+
+    if (in_before_compute_pass)
+    {
+        /* Previous contents are discarded. */
+        const Anvil::ImageBarrier image_barrier(Anvil::AccessFlagBits::NONE,
+                                                Anvil::AccessFlagBits::SHADER_WRITE_BIT,
+                                                Anvil::ImageLayout::UNDEFINED,
+                                                Anvil::ImageLayout::GENERAL,
+                                                VK_QUEUE_FAMILY_IGNORED,
+                                                VK_QUEUE_FAMILY_IGNORED,
+                                                m_image_ptrs.at(in_n_swapchain_image).get(),
+                                                image_range);
+
+        return in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::COMPUTE_SHADER_BIT,
+                                                          Anvil::PipelineStageFlagBits::COMPUTE_SHADER_BIT,
+                                                          Anvil::DependencyFlagBits::NONE,
+                                                          0,       /* in_memory_barrier_count        */
+                                                          nullptr, /* in_memory_barrier_ptrs         */
+                                                          0,       /* in_buffer_memory_barrier_count */
+                                                          nullptr, /* in_buffer_memory_barrier_ptrs  */
+                                                          1,       /* in_image_memory_barrier_count  */
+                                                         &image_barrier);
+    }
+    else
+    {
+        /* Presentation engine accesses are made visible by the present semaphore, so no destination access is needed. */
+        const Anvil::ImageBarrier image_barrier(Anvil::AccessFlagBits::SHADER_WRITE_BIT,
+                                                Anvil::AccessFlagBits::NONE,
+                                                Anvil::ImageLayout::GENERAL,
+                                                present_layout,
+                                                VK_QUEUE_FAMILY_IGNORED,
+                                                VK_QUEUE_FAMILY_IGNORED,
+                                                m_image_ptrs.at(in_n_swapchain_image).get(),
+                                                image_range);
+
+        return in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::COMPUTE_SHADER_BIT,
+                                                          Anvil::PipelineStageFlagBits::BOTTOM_OF_PIPE_BIT,
+                                                          Anvil::DependencyFlagBits::NONE,
+                                                          0,       /* in_memory_barrier_count        */
+                                                          nullptr, /* in_memory_barrier_ptrs         */
+                                                          0,       /* in_buffer_memory_barrier_count */
+                                                          nullptr, /* in_buffer_memory_barrier_ptrs  */
+                                                          1,       /* in_image_memory_barrier_count  */
+                                                         &image_barrier);
+    }
+}
+
+/** Please see header for specification */
+Anvil::SwapchainUniquePtr Anvil::Swapchain::recreate(Anvil::SwapchainUniquePtr in_old_swapchain_ptr)
+{
+    const Anvil::Format*                old_create_info_view_formats_ptr = nullptr;
+    uint32_t                            n_old_create_info_view_formats   = 0;
+    const Anvil::SwapchainCreateInfo*   old_create_info_ptr              = nullptr;
+    Anvil::SwapchainCreateInfoUniquePtr new_create_info_ptr;
+    Anvil::SwapchainUniquePtr           result_ptr;
+
+    anvil_assert(in_old_swapchain_ptr != nullptr);
+
+    old_create_info_ptr = in_old_swapchain_ptr->get_create_info_ptr();
+    new_create_info_ptr = Anvil::SwapchainCreateInfo::create(const_cast<Anvil::BaseDevice*>      (old_create_info_ptr->get_device           () ),
+                                                             const_cast<Anvil::RenderingSurface*>(old_create_info_ptr->get_rendering_surface() ),
+                                                             old_create_info_ptr->get_window      (),
+                                                             old_create_info_ptr->get_format      (),
+                                                             old_create_info_ptr->get_color_space (),
+                                                             old_create_info_ptr->get_present_mode(),
+                                                             old_create_info_ptr->get_usage_flags (),
+                                                             old_create_info_ptr->get_n_images    (),
+                                                             old_create_info_ptr->get_clipped     (),
+                                                             in_old_swapchain_ptr.get() );
+
+    new_create_info_ptr->set_flags                  (old_create_info_ptr->get_flags                  () );
+    new_create_info_ptr->set_mgpu_present_mode_flags(old_create_info_ptr->get_mgpu_present_mode_flags() );
+    new_create_info_ptr->set_mt_safety              (old_create_info_ptr->get_mt_safety              () );
+    new_create_info_ptr->set_n_frames_in_flight     (old_create_info_ptr->get_n_frames_in_flight     () );
+
+    if ((old_create_info_ptr->get_flags() & Anvil::SwapchainCreateFlagBits::CREATE_MUTABLE_FORMAT_BIT) != 0)
+    {
+        old_create_info_ptr->get_view_format_list(&old_create_info_view_formats_ptr,
+                                                  &n_old_create_info_view_formats);
+
+        new_create_info_ptr->set_view_format_list(old_create_info_view_formats_ptr,
+                                                  n_old_create_info_view_formats);
+    }
+
+    result_ptr = Anvil::Swapchain::create(std::move(new_create_info_ptr) );
+
+    if (result_ptr != nullptr)
+    {
+        /* The old swapchain is only needed at creation time. Do not keep a pointer which is about to go stale. */
+        result_ptr->m_create_info_ptr->set_old_swapchain(nullptr);
+    }
+
+    /* Per spec, the old swapchain is retired even if the new one could not be created. Images which have already
+     * been acquired from it can still be presented, and frames in flight may still be using them, so the old
+     * wrapper is handed over to the deferred deletion queue rather than released here.
+     */
+    in_old_swapchain_ptr->lock();
+    {
+        in_old_swapchain_ptr->m_is_retired = true;
+    }
+    in_old_swapchain_ptr->unlock();
+
+    old_create_info_ptr->get_device()->get_deferred_deletion_queue()->enqueue(std::move(in_old_swapchain_ptr) );
+
+    return result_ptr;
+}
+
 /** Please see header for specification */
 void Anvil::Swapchain::set_hdr_metadata(const uint32_t&              in_n_swapchains,
                                         Anvil::Swapchain**           in_swapchains_ptr_ptr,
@@ -824,4 +1228,10 @@ void Anvil::Swapchain::set_hdr_metadata(const uint32_t&              in_n_swapch
                                     in_n_swapchains,
                                    &swapchain_vk_vec.at(0),
                                    &metadata_vk_vec.at (0) );
-}
\ No newline at end of file
+}
+
+/** Please see header for specification */
+bool Anvil::Swapchain::supports_storage_usage() const
+{
+    return (m_create_info_ptr->get_usage_flags() & Anvil::ImageUsageFlagBits::STORAGE_BIT) != 0;
+}
@@ -0,0 +1,185 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/* anvil_pipeline_cache_merge
+ *
+ * Combines pipeline cache files written by PipelineCache::store_to_file() in multiple processes into
+ * a single, optionally compressed, file. vkMergePipelineCaches() needs a device, so the tool must run
+ * on a GPU & driver the input files have been produced with. Incompatible input files are skipped.
+ *
+ * Usage: anvil_pipeline_cache_merge [--compress] [--device <index>] <output file> <input file> [<input file> ...]
+ *
+ * The output file may also be one of the input files.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "misc/instance_create_info.h"
+#include "wrappers/device.h"
+#include "wrappers/instance.h"
+#include "wrappers/pipeline_cache.h"
+
+
+int main(int argc, char *argv[])
+{
+    Anvil::BaseDeviceUniquePtr    device_ptr;
+    std::vector<std::string>      input_filenames;
+    Anvil::InstanceUniquePtr      instance_ptr;
+    uint32_t                      n_files_merged    = 0;
+    uint32_t                      n_physical_device = 0;
+    std::string                   output_filename;
+    Anvil::PipelineCacheUniquePtr pipeline_cache_ptr;
+    int                           result            = EXIT_FAILURE;
+    bool                          should_compress   = false;
+
+    for (int n_arg = 1;
+             n_arg < argc;
+           ++n_arg)
+    {
+        if (strcmp(argv[n_arg], "--compress") == 0)
+        {
+            should_compress = true;
+        }
+        else
+        if (strcmp(argv[n_arg], "--device") == 0 &&
+            n_arg + 1 < argc)
+        {
+            n_physical_device = static_cast<uint32_t>(strtoul(argv[++n_arg],
+                                                              nullptr, /* endptr */
+                                                              10) );   /* base   */
+        }
+        else
+        if (output_filename.empty() )
+        {
+            output_filename = argv[n_arg];
+        }
+        else
+        {
+            input_filenames.push_back(argv[n_arg]);
+        }
+    }
+
+    if (output_filename.empty() ||
+        input_filenames.empty() )
+    {
+        fprintf(stderr,
+                "Usage: %s [--compress] [--device <index>] <output file> <input file> [<input file> ...]\n",
+                argv[0]);
+
+        goto end;
+    }
+
+    /* Create a Vulkan instance */
+    {
+        auto create_info_ptr = Anvil::InstanceCreateInfo::create("anvil_pipeline_cache_merge", /* in_app_name    */
+                                                                 "anvil_pipeline_cache_merge", /* in_engine_name */
+                                                                 Anvil::DebugCallbackFunction(),
+                                                                 false);                       /* in_mt_safe     */
+
+        instance_ptr = Anvil::Instance::create(std::move(create_info_ptr) );
+    }
+
+    if (instance_ptr == nullptr)
+    {
+        fprintf(stderr,
+                "Could not create a Vulkan instance\n");
+
+        goto end;
+    }
+
+    if (n_physical_device >= instance_ptr->get_n_physical_devices() )
+    {
+        fprintf(stderr,
+                "Physical device index %u is out of range. %u physical device(s) are available.\n",
+                n_physical_device,
+                instance_ptr->get_n_physical_devices() );
+
+        goto end;
+    }
+
+    /* Create a Vulkan device. No extensions are needed to merge pipeline caches. */
+    {
+        auto create_info_ptr = Anvil::DeviceCreateInfo::create_sgpu(instance_ptr->get_physical_device(n_physical_device),
+                                                                    false,                      /* in_enable_shader_module_cache */
+                                                                    Anvil::DeviceExtensionConfiguration(),
+                                                                    std::vector<std::string>(), /* in_layers */
+                                                                    Anvil::CommandPoolCreateFlagBits::NONE,
+                                                                    false);                     /* in_mt_safe */
+
+        device_ptr = Anvil::SGPUDevice::create(std::move(create_info_ptr) );
+    }
+
+    if (device_ptr == nullptr)
+    {
+        fprintf(stderr,
+                "Could not create a Vulkan device\n");
+
+        goto end;
+    }
+
+    pipeline_cache_ptr = Anvil::PipelineCache::create_merged_from_files(device_ptr.get(),
+                                                                        false, /* in_mt_safe */
+                                                                        input_filenames,
+                                                                       &n_files_merged);
+
+    if (pipeline_cache_ptr == nullptr)
+    {
+        fprintf(stderr,
+                "Could not merge pipeline caches\n");
+
+        goto end;
+    }
+
+    if (n_files_merged != input_filenames.size() )
+    {
+        fprintf(stderr,
+                "Warning: %u out of %u input file(s) were missing or incompatible with the device, and have been skipped\n",
+                static_cast<uint32_t>(input_filenames.size() ) - n_files_merged,
+                static_cast<uint32_t>(input_filenames.size() ));
+    }
+
+    if (!pipeline_cache_ptr->store_to_file(output_filename,
+                                           should_compress) )
+    {
+        fprintf(stderr,
+                "Could not write pipeline cache to [%s]\n",
+                output_filename.c_str() );
+
+        goto end;
+    }
+
+    printf("Merged %u pipeline cache file(s) into [%s]\n",
+           n_files_merged,
+           output_filename.c_str() );
+
+    result = EXIT_SUCCESS;
+end:
+    pipeline_cache_ptr.reset();
+    device_ptr.reset        ();
+    instance_ptr.reset      ();
+
+    return result;
+}
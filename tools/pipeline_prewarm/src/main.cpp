@@ -0,0 +1,182 @@
+//
+// Copyright (c) 2017-2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/* anvil_pipeline_prewarm
+ *
+ * Replays a pipeline manifest (see misc/pipeline_manifest.h) on the target GPU and writes the resulting
+ * pipeline cache to disk. Ship the cache file with the application, or generate it at install time, so
+ * that PipelineCache::create_from_file() finds all pipelines already compiled on first launch.
+ *
+ * Usage: anvil_pipeline_prewarm <manifest file> <pipeline cache file> [physical device index]
+ *
+ * If the pipeline cache file already exists and is compatible with the device, newly baked pipelines
+ * are appended to it.
+ *
+ * If the manifest carries a usage profile, pipelines are baked in the order the application first used
+ * them, most frequently bound ones first.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "misc/instance_create_info.h"
+#include "misc/object_tracker.h"
+#include "misc/pipeline_manifest.h"
+#include "wrappers/device.h"
+#include "wrappers/instance.h"
+#include "wrappers/pipeline_cache.h"
+
+
+int main(int argc, char *argv[])
+{
+    Anvil::BaseDeviceUniquePtr       device_ptr;
+    uint32_t                         n_physical_device = 0;
+    uint32_t                         n_pipelines_baked = 0;
+    Anvil::InstanceUniquePtr         instance_ptr;
+    Anvil::PipelineCacheUniquePtr    pipeline_cache_ptr;
+    Anvil::PipelineManifestUniquePtr pipeline_manifest_ptr;
+    int                              result            = EXIT_FAILURE;
+
+    if (argc < 3 ||
+        argc > 4)
+    {
+        fprintf(stderr,
+                "Usage: %s <manifest file> <pipeline cache file> [physical device index]\n",
+                argv[0]);
+
+        goto end;
+    }
+
+    if (argc == 4)
+    {
+        n_physical_device = static_cast<uint32_t>(strtoul(argv[3],
+                                                          nullptr, /* endptr */
+                                                          10) );   /* base   */
+    }
+
+    pipeline_manifest_ptr = Anvil::PipelineManifest::create_from_file(argv[1]);
+
+    if (pipeline_manifest_ptr == nullptr)
+    {
+        fprintf(stderr,
+                "Could not load pipeline manifest from [%s]\n",
+                argv[1]);
+
+        goto end;
+    }
+
+    /* Create a Vulkan instance */
+    {
+        auto create_info_ptr = Anvil::InstanceCreateInfo::create("anvil_pipeline_prewarm", /* in_app_name    */
+                                                                 "anvil_pipeline_prewarm", /* in_engine_name */
+                                                                 Anvil::DebugCallbackFunction(),
+                                                                 false);                   /* in_mt_safe     */
+
+        instance_ptr = Anvil::Instance::create(std::move(create_info_ptr) );
+    }
+
+    if (instance_ptr == nullptr)
+    {
+        fprintf(stderr,
+                "Could not create a Vulkan instance\n");
+
+        goto end;
+    }
+
+    if (n_physical_device >= instance_ptr->get_n_physical_devices() )
+    {
+        fprintf(stderr,
+                "Physical device index %u is out of range. %u physical device(s) are available.\n",
+                n_physical_device,
+                instance_ptr->get_n_physical_devices() );
+
+        goto end;
+    }
+
+    /* Create a Vulkan device. All extensions the device supports are enabled, so that pipelines which depend on them can be baked. */
+    {
+        auto create_info_ptr = Anvil::DeviceCreateInfo::create_sgpu(instance_ptr->get_physical_device(n_physical_device),
+                                                                    false,                      /* in_enable_shader_module_cache */
+                                                                    Anvil::DeviceExtensionConfiguration(),
+                                                                    std::vector<std::string>(), /* in_layers */
+                                                                    Anvil::CommandPoolCreateFlagBits::NONE,
+                                                                    false);                     /* in_mt_safe */
+
+        device_ptr = Anvil::SGPUDevice::create(std::move(create_info_ptr) );
+    }
+
+    if (device_ptr == nullptr)
+    {
+        fprintf(stderr,
+                "Could not create a Vulkan device\n");
+
+        goto end;
+    }
+
+    pipeline_cache_ptr = Anvil::PipelineCache::create_from_file(device_ptr.get(),
+                                                                false, /* in_mt_safe */
+                                                                argv[2]);
+
+    if (pipeline_cache_ptr == nullptr)
+    {
+        fprintf(stderr,
+                "Could not create a pipeline cache\n");
+
+        goto end;
+    }
+
+    if (!pipeline_manifest_ptr->replay(device_ptr.get(),
+                                       pipeline_cache_ptr.get(),
+                                      &n_pipelines_baked) )
+    {
+        fprintf(stderr,
+                "Warning: %u out of %u pipelines could not be baked\n",
+                pipeline_manifest_ptr->get_n_pipelines() - n_pipelines_baked,
+                pipeline_manifest_ptr->get_n_pipelines() );
+    }
+
+    if (!pipeline_cache_ptr->store_to_file(argv[2]) )
+    {
+        fprintf(stderr,
+                "Could not write pipeline cache to [%s]\n",
+                argv[2]);
+
+        goto end;
+    }
+
+    printf("Baked %u pipeline(s) (%u profiled) from %u SPIR-V blob(s) and %u render pass(es) into [%s]\n",
+           n_pipelines_baked,
+           pipeline_manifest_ptr->get_n_profiled_pipelines(),
+           pipeline_manifest_ptr->get_n_spirv_blobs       (),
+           pipeline_manifest_ptr->get_n_render_passes     (),
+           argv[2]);
+
+    result = EXIT_SUCCESS;
+end:
+    pipeline_cache_ptr.reset();
+    device_ptr.reset        ();
+    instance_ptr.reset      ();
+
+    return result;
+}